@@ -17,6 +17,8 @@ SET(VCPKG_MANIFEST_DIR "${CMAKE_SOURCE_DIR}/vcpkg")
 option(USE_LOCAL_MLIR "Does not build llvm and mlir via vcpkg, rather uses a locally installed version" OFF)
 option(USE_LIBCXX_IF_AVAILABLE "Use Libc++ if supported by the system" ON)
 option(NES_USE_SYSTEM_DEPS "Rely on externally provided dependencies instead of bootstrapping vcpkg" OFF)
+option(NES_ENABLE_KAFKA_SOURCE "Builds the Kafka source plugin, which requires librdkafka" OFF)
+option(NES_ENABLE_KAFKA_SINK "Builds the Kafka sink plugin, which requires librdkafka" OFF)
 
 set(NES_SKIP_VCPKG OFF)
 if (NOT DEFINED CMAKE_TOOLCHAIN_FILE
@@ -117,6 +119,16 @@ else ()
     list(APPEND VCPKG_ENV_PASSTHROUGH "MLIR_DIR")
 endif ()
 
+if (${NES_ENABLE_KAFKA_SOURCE} OR ${NES_ENABLE_KAFKA_SINK})
+    message(STATUS "Enabling Kafka feature for the VPCKG install")
+    list(APPEND VCPKG_MANIFEST_FEATURES "kafka")
+endif ()
+
+if (${NES_ENABLE_BENCHMARKS})
+    message(STATUS "Enabling Benchmarks feature for the VPCKG install")
+    list(APPEND VCPKG_MANIFEST_FEATURES "benchmarks")
+endif ()
+
 if (NOT NES_SKIP_VCPKG)
     SET(VCPKG_STDLIB "libcxx")
     if (NOT USE_LIBCXX_IF_AVAILABLE)
@@ -69,6 +69,9 @@
           openssl.dev
           zstd.dev
           zlib.dev
+          lz4.dev
+          xxHash
+          rdkafka
           libdwarf.dev
           libffi
           libxml2
@@ -76,6 +79,7 @@
           gflags
           glog
           gtest
+          gbenchmark
           tbb
           python3
           openjdk21
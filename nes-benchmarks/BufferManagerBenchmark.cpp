@@ -0,0 +1,90 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+#include <Runtime/BufferManager.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <benchmark/benchmark.h>
+
+namespace NES
+{
+namespace
+{
+constexpr uint32_t BUFFER_SIZE = 4096;
+constexpr uint32_t NUMBER_OF_BUFFERS = 1024;
+constexpr uint64_t UNPOOLED_BUFFER_SIZE = 64 * 1024;
+
+/// All threads of a benchmark share the buffer manager, so that the threads contend on its pool(s)
+template <bool NumaAware>
+BufferManager& getSharedBufferManager()
+{
+    static const auto bufferManager = NumaAware ? BufferManager::createNumaAware(BUFFER_SIZE, NUMBER_OF_BUFFERS)
+                                                : BufferManager::create(BUFFER_SIZE, NUMBER_OF_BUFFERS);
+    return *bufferManager;
+}
+
+/// Gets a pooled buffer and recycles it right away, as a source or an emitting operator does for every buffer
+template <bool NumaAware>
+void BM_BufferManagerGetAndRecycle(benchmark::State& state)
+{
+    auto& bufferManager = getSharedBufferManager<NumaAware>();
+    for (auto _ : state)
+    {
+        auto buffer = bufferManager.getBufferBlocking();
+        benchmark::DoNotOptimize(buffer.getAvailableMemoryArea().data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// Keeps a batch of buffers, before it recycles them, which uses the pool in a different order than recycling buffers right away
+void BM_BufferManagerGetAndRecycleBatch(benchmark::State& state)
+{
+    auto& bufferManager = getSharedBufferManager<false>();
+    const auto batchSize = static_cast<size_t>(state.range(0));
+    std::vector<TupleBuffer> batch;
+    batch.reserve(batchSize);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < batchSize; ++i)
+        {
+            batch.push_back(bufferManager.getBufferBlocking());
+        }
+        batch.clear();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * batchSize));
+}
+
+void BM_BufferManagerGetAndRecycleUnpooled(benchmark::State& state)
+{
+    auto& bufferManager = getSharedBufferManager<false>();
+    for (auto _ : state)
+    {
+        auto buffer = bufferManager.getUnpooledBuffer(UNPOOLED_BUFFER_SIZE);
+        benchmark::DoNotOptimize(buffer);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+}
+
+BENCHMARK_TEMPLATE(BM_BufferManagerGetAndRecycle, false)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_BufferManagerGetAndRecycle, true)->ThreadRange(1, 16)->UseRealTime();
+/// Each thread keeps at most 64 buffers, so that 16 threads do not exhaust the pool
+BENCHMARK(BM_BufferManagerGetAndRecycleBatch)->Arg(64)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_BufferManagerGetAndRecycleUnpooled)->ThreadRange(1, 16)->UseRealTime();
+
+}
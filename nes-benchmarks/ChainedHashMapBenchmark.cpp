@@ -0,0 +1,209 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/BufferRef/LowerSchemaProvider.hpp>
+#include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
+#include <Nautilus/Interface/Hash/MurMur3HashFunction.hpp>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedEntryMemoryProvider.hpp>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMap.hpp>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMapRef.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Nautilus/Interface/RecordBuffer.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/BufferManager.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <benchmark/benchmark.h>
+#include <Engine.hpp>
+#include <options.hpp>
+#include <val.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+namespace
+{
+constexpr uint64_t BUFFER_SIZE = 4096;
+constexpr uint64_t PAGE_SIZE = 4096;
+constexpr uint64_t NUMBER_OF_BUCKETS = 1024;
+
+/// Compiles the functions that insert and probe the (key, value) records of a buffer into a ChainedHashMap with uint64 keys and values.
+/// Keys are consecutive numbers modulo the number of distinct keys, so that the number of distinct keys determines the size of the map.
+class ChainedHashMapBenchmarkContext
+{
+public:
+    explicit ChainedHashMapBenchmarkContext(const uint64_t numberOfDistinctKeys)
+        : schema(Schema{}.addField("key", DataType::Type::UINT64).addField("value", DataType::Type::UINT64))
+        , inputBufferRef(LowerSchemaProvider::lowerSchema(BUFFER_SIZE, schema, MemoryLayoutType::ROW_LAYOUT))
+        , entrySize(sizeof(ChainedHashMapEntry) + schema.getSizeOfSchemaInBytes())
+        , entriesPerPage(PAGE_SIZE / entrySize)
+    {
+        /// The buffer manager holds the input buffers and the pages of (at most) one hash map at a time
+        const auto numberOfInputBuffers = (numberOfDistinctKeys / inputBufferRef->getCapacity()) + 1;
+        const auto numberOfPages = (numberOfDistinctKeys / entriesPerPage) + 1;
+        bufferManager = BufferManager::create(BUFFER_SIZE, numberOfInputBuffers + numberOfPages);
+        std::tie(fieldKeys, fieldValues) = ChainedEntryMemoryProvider::createFieldOffsets(schema, {"key"}, {"value"});
+        const auto tuplesPerBuffer = inputBufferRef->getCapacity();
+        for (uint64_t firstKey = 0; firstKey < numberOfDistinctKeys; firstKey += tuplesPerBuffer)
+        {
+            auto buffer = bufferManager->getBufferBlocking();
+            const auto numberOfTuples = std::min(tuplesPerBuffer, numberOfDistinctKeys - firstKey);
+            const auto rows = buffer.getAvailableMemoryArea<uint64_t>();
+            for (uint64_t tuple = 0; tuple < numberOfTuples; ++tuple)
+            {
+                rows[2 * tuple] = firstKey + tuple;
+                rows[(2 * tuple) + 1] = tuple;
+            }
+            buffer.setNumberOfTuples(numberOfTuples);
+            inputBuffers.push_back(buffer);
+        }
+
+        nautilus::engine::Options options;
+        options.setOption("engine.Compilation", true);
+        engine = std::make_unique<nautilus::engine::NautilusEngine>(options);
+    }
+
+    [[nodiscard]] std::unique_ptr<ChainedHashMap> createHashMap() const
+    {
+        return std::make_unique<ChainedHashMap>(entrySize, NUMBER_OF_BUCKETS, PAGE_SIZE);
+    }
+
+    /// We are not allowed to use const or const references for the lambda function params, as nautilus does not support this in the
+    /// registerFunction method.
+    /// NOLINTBEGIN(performance-unnecessary-value-param)
+    [[nodiscard]] auto compileInsert() const
+    {
+        return engine->registerFunction(std::function(
+            [this](
+                nautilus::val<TupleBuffer*> inputBuffer,
+                nautilus::val<AbstractBufferProvider*> bufferProvider,
+                nautilus::val<HashMap*> hashMap)
+            {
+                ChainedHashMapRef hashMapRef(hashMap, fieldKeys, fieldValues, entriesPerPage, entrySize);
+                const RecordBuffer recordBuffer(inputBuffer);
+                for (nautilus::val<uint64_t> i = 0; i < recordBuffer.getNumRecords(); i = i + 1)
+                {
+                    const auto recordKey = inputBufferRef->readRecord({"key"}, recordBuffer, i);
+                    const auto recordValue = inputBufferRef->readRecord({"value"}, recordBuffer, i);
+                    hashMapRef.findOrCreateEntry(
+                        recordKey,
+                        MurMur3HashFunction{},
+                        [&](const nautilus::val<AbstractHashMapEntry*>& entry)
+                        {
+                            const ChainedHashMapRef::ChainedEntryRef entryRef(
+                                static_cast<nautilus::val<ChainedHashMapEntry*>>(entry), hashMap, fieldKeys, fieldValues);
+                            entryRef.copyValuesToEntry(recordValue, bufferProvider);
+                        },
+                        bufferProvider);
+                }
+            }));
+    }
+
+    /// Returns the sum of the values of all probed keys, so that the probe can not be optimized away
+    [[nodiscard]] auto compileProbe() const
+    {
+        return engine->registerFunction(std::function(
+            [this](
+                nautilus::val<TupleBuffer*> inputBuffer,
+                nautilus::val<AbstractBufferProvider*> bufferProvider,
+                nautilus::val<HashMap*> hashMap)
+            {
+                ChainedHashMapRef hashMapRef(hashMap, fieldKeys, fieldValues, entriesPerPage, entrySize);
+                const RecordBuffer recordBuffer(inputBuffer);
+                nautilus::val<uint64_t> sum = 0;
+                for (nautilus::val<uint64_t> i = 0; i < recordBuffer.getNumRecords(); i = i + 1)
+                {
+                    const auto recordKey = inputBufferRef->readRecord({"key"}, recordBuffer, i);
+                    const auto entry = hashMapRef.findOrCreateEntry(
+                        recordKey, MurMur3HashFunction{}, [](const nautilus::val<AbstractHashMapEntry*>&) { }, bufferProvider);
+                    const ChainedHashMapRef::ChainedEntryRef entryRef(
+                        static_cast<nautilus::val<ChainedHashMapEntry*>>(entry), hashMap, fieldKeys, fieldValues);
+                    sum = sum + entryRef.getValue().read("value").getRawValueAs<nautilus::val<uint64_t>>();
+                }
+                return sum;
+            }));
+    }
+
+    /// NOLINTEND(performance-unnecessary-value-param)
+
+    Schema schema;
+    std::shared_ptr<TupleBufferRef> inputBufferRef;
+    uint64_t entrySize;
+    uint64_t entriesPerPage;
+    std::vector<FieldOffsets> fieldKeys;
+    std::vector<FieldOffsets> fieldValues;
+    std::shared_ptr<BufferManager> bufferManager;
+    std::vector<TupleBuffer> inputBuffers;
+    std::unique_ptr<nautilus::engine::NautilusEngine> engine;
+};
+
+/// Inserts all distinct keys into an empty hash map, which includes growing the hash map and allocating its pages
+void BM_ChainedHashMapInsert(benchmark::State& state)
+{
+    const auto numberOfDistinctKeys = static_cast<uint64_t>(state.range(0));
+    const ChainedHashMapBenchmarkContext context(numberOfDistinctKeys);
+    auto insert = context.compileInsert();
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto hashMap = context.createHashMap();
+        state.ResumeTiming();
+        for (auto buffer : context.inputBuffers)
+        {
+            insert(std::addressof(buffer), context.bufferManager.get(), hashMap.get());
+        }
+        benchmark::DoNotOptimize(hashMap->getNumberOfTuples());
+        state.PauseTiming();
+        hashMap.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * numberOfDistinctKeys));
+}
+
+/// Probes all keys of a hash map that contains exactly these keys
+void BM_ChainedHashMapProbe(benchmark::State& state)
+{
+    const auto numberOfDistinctKeys = static_cast<uint64_t>(state.range(0));
+    const ChainedHashMapBenchmarkContext context(numberOfDistinctKeys);
+    auto insert = context.compileInsert();
+    auto probe = context.compileProbe();
+    const auto hashMap = context.createHashMap();
+    for (auto buffer : context.inputBuffers)
+    {
+        insert(std::addressof(buffer), context.bufferManager.get(), hashMap.get());
+    }
+    for (auto _ : state)
+    {
+        for (auto buffer : context.inputBuffers)
+        {
+            benchmark::DoNotOptimize(probe(std::addressof(buffer), context.bufferManager.get(), hashMap.get()));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * numberOfDistinctKeys));
+}
+}
+
+BENCHMARK(BM_ChainedHashMapInsert)->RangeMultiplier(16)->Range(1 << 10, 1 << 22)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ChainedHashMapProbe)->RangeMultiplier(16)->Range(1 << 10, 1 << 22)->Unit(benchmark::kMillisecond);
+
+}
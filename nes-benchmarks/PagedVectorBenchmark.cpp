@@ -0,0 +1,177 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Nautilus/Interface/BufferRef/LowerSchemaProvider.hpp>
+#include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
+#include <Nautilus/Interface/PagedVector/PagedVector.hpp>
+#include <Nautilus/Interface/PagedVector/PagedVectorRef.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Nautilus/Interface/RecordBuffer.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/BufferManager.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <benchmark/benchmark.h>
+#include <Engine.hpp>
+#include <options.hpp>
+#include <val.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+namespace
+{
+constexpr uint64_t BUFFER_SIZE = 4096;
+constexpr uint64_t PAGE_SIZE = 4096;
+
+/// Compiles the functions that append the records of a buffer to a PagedVector and that scan all records of a PagedVector.
+/// Records consist of four uint64 fields, i.e., roughly the size of the records of a join build side.
+class PagedVectorBenchmarkContext
+{
+public:
+    explicit PagedVectorBenchmarkContext(const uint64_t numberOfRecords)
+        : schema(Schema{}
+                     .addField("id", DataType::Type::UINT64)
+                     .addField("value", DataType::Type::UINT64)
+                     .addField("timestamp", DataType::Type::UINT64)
+                     .addField("payload", DataType::Type::UINT64))
+        , inputBufferRef(LowerSchemaProvider::lowerSchema(BUFFER_SIZE, schema, MemoryLayoutType::ROW_LAYOUT))
+        , pageRef(LowerSchemaProvider::lowerSchema(PAGE_SIZE, schema, MemoryLayoutType::ROW_LAYOUT))
+        , projections(schema.getFieldNames())
+    {
+        /// The buffer manager holds the input buffers and the pages of (at most) one paged vector at a time
+        const auto numberOfInputBuffers = (numberOfRecords / inputBufferRef->getCapacity()) + 1;
+        const auto numberOfPages = (numberOfRecords / pageRef->getCapacity()) + 1;
+        bufferManager = BufferManager::create(BUFFER_SIZE, numberOfInputBuffers + numberOfPages);
+
+        const auto tuplesPerBuffer = inputBufferRef->getCapacity();
+        const auto numberOfFields = schema.getNumberOfFields();
+        for (uint64_t firstRecord = 0; firstRecord < numberOfRecords; firstRecord += tuplesPerBuffer)
+        {
+            auto buffer = bufferManager->getBufferBlocking();
+            const auto numberOfTuples = std::min(tuplesPerBuffer, numberOfRecords - firstRecord);
+            const auto rows = buffer.getAvailableMemoryArea<uint64_t>();
+            for (uint64_t field = 0; field < numberOfTuples * numberOfFields; ++field)
+            {
+                rows[field] = (firstRecord * numberOfFields) + field;
+            }
+            buffer.setNumberOfTuples(numberOfTuples);
+            inputBuffers.push_back(buffer);
+        }
+
+        nautilus::engine::Options options;
+        options.setOption("engine.Compilation", true);
+        engine = std::make_unique<nautilus::engine::NautilusEngine>(options);
+    }
+
+    /// We are not allowed to use const or const references for the lambda function params, as nautilus does not support this in the
+    /// registerFunction method.
+    /// NOLINTBEGIN(performance-unnecessary-value-param)
+    [[nodiscard]] auto compileAppend() const
+    {
+        return engine->registerFunction(std::function(
+            [this](
+                nautilus::val<TupleBuffer*> inputBuffer,
+                nautilus::val<AbstractBufferProvider*> bufferProvider,
+                nautilus::val<PagedVector*> pagedVector)
+            {
+                const RecordBuffer recordBuffer(inputBuffer);
+                const PagedVectorRef pagedVectorRef(pagedVector, pageRef);
+                for (nautilus::val<uint64_t> i = 0; i < recordBuffer.getNumRecords(); i = i + 1)
+                {
+                    pagedVectorRef.writeRecord(inputBufferRef->readRecord(projections, recordBuffer, i), bufferProvider);
+                }
+            }));
+    }
+
+    /// Returns the sum of a field of all records, so that the scan can not be optimized away
+    [[nodiscard]] auto compileScan() const
+    {
+        return engine->registerFunction(std::function(
+            [this](nautilus::val<PagedVector*> pagedVector)
+            {
+                const PagedVectorRef pagedVectorRef(pagedVector, pageRef);
+                nautilus::val<uint64_t> sum = 0;
+                for (auto it = pagedVectorRef.begin(projections); it != pagedVectorRef.end(projections); ++it)
+                {
+                    sum = sum + (*it).read("value").getRawValueAs<nautilus::val<uint64_t>>();
+                }
+                return sum;
+            }));
+    }
+
+    /// NOLINTEND(performance-unnecessary-value-param)
+
+    Schema schema;
+    std::shared_ptr<TupleBufferRef> inputBufferRef;
+    std::shared_ptr<TupleBufferRef> pageRef;
+    std::vector<Record::RecordFieldIdentifier> projections;
+    std::shared_ptr<BufferManager> bufferManager;
+    std::vector<TupleBuffer> inputBuffers;
+    std::unique_ptr<nautilus::engine::NautilusEngine> engine;
+};
+
+void BM_PagedVectorAppend(benchmark::State& state)
+{
+    const auto numberOfRecords = static_cast<uint64_t>(state.range(0));
+    const PagedVectorBenchmarkContext context(numberOfRecords);
+    auto append = context.compileAppend();
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto pagedVector = std::make_unique<PagedVector>();
+        state.ResumeTiming();
+        for (auto buffer : context.inputBuffers)
+        {
+            append(std::addressof(buffer), context.bufferManager.get(), pagedVector.get());
+        }
+        benchmark::DoNotOptimize(pagedVector->getTotalNumberOfEntries());
+        state.PauseTiming();
+        pagedVector.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * numberOfRecords));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * numberOfRecords * context.schema.getSizeOfSchemaInBytes()));
+}
+
+void BM_PagedVectorScan(benchmark::State& state)
+{
+    const auto numberOfRecords = static_cast<uint64_t>(state.range(0));
+    const PagedVectorBenchmarkContext context(numberOfRecords);
+    auto append = context.compileAppend();
+    auto scan = context.compileScan();
+    PagedVector pagedVector;
+    for (auto buffer : context.inputBuffers)
+    {
+        append(std::addressof(buffer), context.bufferManager.get(), std::addressof(pagedVector));
+    }
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(scan(std::addressof(pagedVector)));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * numberOfRecords));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * numberOfRecords * context.schema.getSizeOfSchemaInBytes()));
+}
+}
+
+BENCHMARK(BM_PagedVectorAppend)->RangeMultiplier(16)->Range(1 << 10, 1 << 22)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PagedVectorScan)->RangeMultiplier(16)->Range(1 << 10, 1 << 22)->Unit(benchmark::kMillisecond);
+
+}
@@ -0,0 +1,93 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <Identifiers/Identifiers.hpp>
+#include <Runtime/BufferManager.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <benchmark/benchmark.h>
+#include <RawTupleBuffer.hpp>
+#include <SequenceShredder.hpp>
+
+namespace NES
+{
+namespace
+{
+constexpr uint32_t SIZE_OF_RAW_BUFFER = 64;
+constexpr uint32_t NUMBER_OF_RAW_BUFFERS = 4096;
+constexpr uint32_t OFFSET_OF_TUPLE_DELIMITER = SIZE_OF_RAW_BUFFER / 2;
+
+/// All threads of a benchmark share the SequenceShredder and take the sequence numbers of their raw buffers from a shared counter,
+/// like the worker threads that execute the tasks of a source
+std::shared_ptr<BufferManager> bufferManager;
+std::unique_ptr<SequenceShredder> sequenceShredder;
+std::atomic<SequenceNumber::Underlying> nextSequenceNumber;
+
+/// Repeats the search (as the InputFormatter repeats the task), until the sequence number is in range of the SequenceShredder
+template <typename SearchFunction>
+SequenceShredderResult searchUntilInRange(const SearchFunction& search)
+{
+    auto result = search();
+    while (not result.isInRange)
+    {
+        result = search();
+    }
+    return result;
+}
+
+/// Only every n-th raw buffer (state.range(0)) contains a tuple delimiter, thus tuples span n raw buffers
+void BM_SequenceShredder(benchmark::State& state)
+{
+    if (state.thread_index() == 0)
+    {
+        bufferManager = BufferManager::create(SIZE_OF_RAW_BUFFER, NUMBER_OF_RAW_BUFFERS);
+        sequenceShredder = std::make_unique<SequenceShredder>(1);
+        nextSequenceNumber = SequenceNumber::INITIAL;
+    }
+    const auto buffersPerTuple = static_cast<SequenceNumber::Underlying>(state.range(0));
+    for (auto _ : state)
+    {
+        const auto sequenceNumber = SequenceNumber(nextSequenceNumber.fetch_add(1));
+        auto rawBuffer = bufferManager->getBufferBlocking();
+        rawBuffer.setSequenceNumber(sequenceNumber);
+        rawBuffer.setNumberOfTuples(SIZE_OF_RAW_BUFFER);
+        if (sequenceNumber.getRawValue() % buffersPerTuple == 0)
+        {
+            const StagedBuffer stagedBuffer{RawTupleBuffer{rawBuffer}, OFFSET_OF_TUPLE_DELIMITER, OFFSET_OF_TUPLE_DELIMITER};
+            benchmark::DoNotOptimize(
+                searchUntilInRange([&] { return sequenceShredder->findLeadingSpanningTupleWithDelimiter(stagedBuffer); }));
+            benchmark::DoNotOptimize(sequenceShredder->findTrailingSpanningTupleWithDelimiter(sequenceNumber));
+        }
+        else
+        {
+            const StagedBuffer stagedBuffer{RawTupleBuffer{rawBuffer}, SIZE_OF_RAW_BUFFER, SIZE_OF_RAW_BUFFER};
+            benchmark::DoNotOptimize(searchUntilInRange([&] { return sequenceShredder->findSpanningTupleWithoutDelimiter(stagedBuffer); }));
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0)
+    {
+        state.counters["outOfRangeRequests"] = static_cast<double>(sequenceShredder->getStatistics().numberOfOutOfRangeRequests);
+        sequenceShredder.reset();
+        bufferManager.reset();
+    }
+}
+}
+
+BENCHMARK(BM_SequenceShredder)->Arg(1)->Arg(8)->ThreadRange(1, 16)->UseRealTime();
+
+}
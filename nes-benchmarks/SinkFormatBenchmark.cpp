@@ -0,0 +1,100 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Runtime/BufferManager.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <SinksParsing/CSVFormat.hpp>
+#include <SinksParsing/JSONFormat.hpp>
+#include <benchmark/benchmark.h>
+
+namespace NES
+{
+namespace
+{
+constexpr uint32_t BUFFER_SIZE = 4096;
+
+/// A schema of fixed-size fields, which covers the integer, floating point and boolean formatting
+Schema createSchema()
+{
+    return Schema{}
+        .addField("id", DataType::Type::UINT64)
+        .addField("count", DataType::Type::INT32)
+        .addField("price", DataType::Type::FLOAT64)
+        .addField("ratio", DataType::Type::FLOAT32)
+        .addField("valid", DataType::Type::BOOLEAN);
+}
+
+/// Fills a full buffer with random values in realistic ranges, e.g., prices with two decimals
+TupleBuffer createInputBuffer(BufferManager& bufferManager, const Schema& schema)
+{
+    std::mt19937_64 random(42);
+    std::uniform_int_distribution<int32_t> counts(-1000, 1000);
+    std::uniform_int_distribution<uint64_t> cents(0, 1000000);
+    std::uniform_real_distribution<float> ratios(0, 1);
+
+    auto buffer = bufferManager.getBufferBlocking();
+    const auto tupleSize = schema.getSizeOfSchemaInBytes();
+    const auto numberOfTuples = buffer.getBufferSize() / tupleSize;
+    auto* tuple = buffer.getAvailableMemoryArea().data();
+    for (uint64_t i = 0; i < numberOfTuples; ++i, tuple += tupleSize)
+    {
+        size_t offset = 0;
+        const auto writeField = [&](const auto value)
+        {
+            std::memcpy(tuple + offset, &value, sizeof(value));
+            offset += sizeof(value);
+        };
+        writeField(static_cast<uint64_t>(random()));
+        writeField(counts(random));
+        writeField(static_cast<double>(cents(random)) / 100);
+        writeField(ratios(random));
+        writeField((i % 2) == 0);
+    }
+    buffer.setNumberOfTuples(numberOfTuples);
+    return buffer;
+}
+
+/// Formats the same buffer repeatedly into a reused string, as the sinks do with their thread-local output
+template <typename FormatType>
+void BM_SinkFormat(benchmark::State& state)
+{
+    const auto bufferManager = BufferManager::create(BUFFER_SIZE, 1);
+    const auto schema = createSchema();
+    const auto inputBuffer = createInputBuffer(*bufferManager, schema);
+    const FormatType format(schema);
+    std::string output;
+    for (auto _ : state)
+    {
+        output.clear();
+        format.formatBuffer(inputBuffer, output);
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * inputBuffer.getNumberOfTuples()));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * inputBuffer.getNumberOfTuples() * schema.getSizeOfSchemaInBytes()));
+    state.counters["outputBytesPerBuffer"] = static_cast<double>(output.size());
+}
+}
+
+BENCHMARK_TEMPLATE(BM_SinkFormat, CSVFormat);
+BENCHMARK_TEMPLATE(BM_SinkFormat, JSONFormat);
+
+}
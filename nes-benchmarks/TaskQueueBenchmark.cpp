@@ -0,0 +1,86 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <array>
+#include <cstddef>
+#include <stop_token>
+#include <tuple>
+#include <benchmark/benchmark.h>
+#include <TaskQueue.hpp>
+
+namespace NES
+{
+namespace
+{
+/// NOLINTNEXTLINE(readability-magic-numbers) 142 is roughly the current task size, as in the TaskQueueTest
+using Task = std::tuple<int, int, std::array<std::byte, 142>>;
+constexpr size_t ADMISSION_QUEUE_SIZE = 1024;
+constexpr size_t MAX_THREADS = 16;
+
+/// All threads of a benchmark share the queue. Every thread alternates between writing and reading a task, thus there are never more
+/// tasks in the queue than threads and reading never fails.
+TaskQueue<Task>& getSharedTaskQueue()
+{
+    static TaskQueue<Task> queue{ADMISSION_QUEUE_SIZE, MAX_THREADS};
+    return queue;
+}
+
+/// Follow-up tasks of worker threads, which bypass the admission queue
+void BM_TaskQueueInternal(benchmark::State& state)
+{
+    auto& queue = getSharedTaskQueue();
+    const Task task{state.thread_index(), 0, {}};
+    for (auto _ : state)
+    {
+        queue.addInternalTaskNonBlocking(task);
+        benchmark::DoNotOptimize(queue.getNextTaskNonBlocking());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// Tasks of sources, which go through the bounded admission queue
+void BM_TaskQueueAdmission(benchmark::State& state)
+{
+    auto& queue = getSharedTaskQueue();
+    const std::stop_source stopSource;
+    const Task task{state.thread_index(), 0, {}};
+    for (auto _ : state)
+    {
+        queue.addAdmissionTaskBlocking(stopSource.get_token(), task);
+        benchmark::DoNotOptimize(queue.getNextTaskNonBlocking());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// Follow-up tasks in the local queue of each worker thread (work-stealing mode)
+void BM_TaskQueueLocal(benchmark::State& state)
+{
+    auto& queue = getSharedTaskQueue();
+    const std::stop_source stopSource;
+    const auto worker = static_cast<size_t>(state.thread_index());
+    const Task task{state.thread_index(), 0, {}};
+    for (auto _ : state)
+    {
+        queue.addLocalTaskNonBlocking(worker, task);
+        benchmark::DoNotOptimize(queue.getNextTaskBlocking(worker, stopSource.get_token()));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+}
+
+BENCHMARK(BM_TaskQueueInternal)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+BENCHMARK(BM_TaskQueueAdmission)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+BENCHMARK(BM_TaskQueueLocal)->ThreadRange(1, MAX_THREADS)->UseRealTime();
+
+}
@@ -0,0 +1,268 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <utility>
+#include <Identifiers/Identifiers.hpp>
+#include <folly/Synchronized.h>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+/// The ChunkNumberTracker assigns chunk numbers to the buffers that an operator produces for the (chunks of the) sequence numbers of
+/// a single origin. It assigns unique chunk numbers per sequence number and flags exactly one buffer per sequence number as the last chunk,
+/// once it has seen all incoming chunks. The last chunk receives the highest chunk number of its sequence.
+/// In contrast to keeping the state of every sequence number in a locked map, worker threads assign chunk numbers without locking.
+/// @tparam RingSize The number of sequence numbers that can be in flight, i.e., between the smallest sequence number that is not yet
+/// complete and the largest sequence number, without falling back to a locked map.
+template <size_t RingSize = 1024>
+class ChunkNumberTracker
+{
+    static_assert(std::has_single_bit(RingSize), "RingSize must be a power of two");
+
+public:
+    struct Assignment
+    {
+        ChunkNumber chunkNumber = INVALID<ChunkNumber>;
+        bool isLastChunk = false;
+    };
+
+    /// Assigns the chunk number of a buffer that the operator produces for the given sequence number.
+    /// The buffers that an operator produces for an incoming chunk must be assigned (by the same thread) before the buffer that ends the
+    /// incoming chunk. This guarantees that the buffer that completes the sequence number receives the highest chunk number.
+    Assignment
+    assign(SequenceNumber sequenceNumber, bool isEndOfIncomingChunk, ChunkNumber incomingChunkNumber, bool isIncomingBufferTheLastChunk);
+
+private:
+    /// The state of a sequence number packs two counters into a single word, which allows to update both with a single atomic fetch_add.
+    /// The lower 32 bits count the assigned chunk numbers. The upper 32 bits are a signed balance of the incoming chunks: every incoming
+    /// chunk but the last decrements it and the last incoming chunk increments it by the number of prior chunks (like the ChunkCollector).
+    /// Thus, the balance is zero after the buffer that ends the final incoming chunk.
+    using State = uint64_t;
+    static constexpr size_t BALANCE_SHIFT = 32;
+
+    /// A slot holds the state of a sequence number that lies within the window of [windowStart, windowStart + RingSize).
+    /// A slot is reset by the thread that completes its sequence number, before it records the completion and the window moves past it.
+    struct Slot
+    {
+        std::atomic<State> state = 0;
+        std::atomic<SequenceNumber::Underlying> completedSequenceNumber = SequenceNumber::INVALID;
+#ifndef NO_ASSERT
+        std::atomic<bool> seenLastChunk = false;
+#endif
+    };
+
+    /// A sequence number that arrives before the window covers it, keeps its state in the (locked) fallback map
+    struct FallbackState
+    {
+        State state = 0;
+        bool completed = false;
+#ifndef NO_ASSERT
+        bool seenLastChunk = false;
+#endif
+    };
+
+    static State getIncrement(bool isEndOfIncomingChunk, ChunkNumber incomingChunkNumber, bool isIncomingBufferTheLastChunk);
+    static Assignment toAssignment(State previous, State increment, bool isEndOfIncomingChunk);
+
+    [[nodiscard]] bool isInWindow(SequenceNumber::Underlying sequenceNumber) const;
+    Assignment
+    assignInSlot(SequenceNumber::Underlying sequenceNumber, State increment, bool isEndOfIncomingChunk, bool isLastIncomingChunk);
+    /// Returns true if the sequence number keeps its state in a slot, otherwise it assigns the chunk number in 'assignment'
+    bool tryAssignInFallback(
+        SequenceNumber::Underlying sequenceNumber,
+        State increment,
+        bool isEndOfIncomingChunk,
+        bool isLastIncomingChunk,
+        Assignment& assignment);
+    [[nodiscard]] bool eraseIfCompletedInFallback(SequenceNumber::Underlying sequenceNumber);
+    /// Moves the window past all completed sequence numbers at its start
+    void advanceWindow();
+
+    std::array<Slot, RingSize> slots{};
+    /// The smallest sequence number that is not yet complete
+    std::atomic<SequenceNumber::Underlying> windowStart = SequenceNumber::INITIAL;
+    /// Threads only lock the fallback map if it contains sequence numbers that are not yet complete
+    std::atomic<size_t> numberOfPendingFallbackStates = 0;
+    /// The window only locks the fallback map if it contains (completed) sequence numbers
+    std::atomic<size_t> numberOfFallbackStates = 0;
+    folly::Synchronized<std::map<SequenceNumber::Underlying, FallbackState>> fallbackStates;
+};
+
+template <size_t RingSize>
+typename ChunkNumberTracker<RingSize>::State ChunkNumberTracker<RingSize>::getIncrement(
+    const bool isEndOfIncomingChunk, const ChunkNumber incomingChunkNumber, const bool isIncomingBufferTheLastChunk)
+{
+    if (not isEndOfIncomingChunk)
+    {
+        return 1;
+    }
+    const auto balance = isIncomingBufferTheLastChunk ? static_cast<int64_t>(incomingChunkNumber.getRawValue() - ChunkNumber::INITIAL) : -1;
+    /// The unsigned overflow of a negative balance carries into the bits above the balance, which are discarded
+    return (static_cast<State>(balance) << BALANCE_SHIFT) + 1;
+}
+
+template <size_t RingSize>
+typename ChunkNumberTracker<RingSize>::Assignment
+ChunkNumberTracker<RingSize>::toAssignment(const State previous, const State increment, const bool isEndOfIncomingChunk)
+{
+    const auto assignedChunks = static_cast<uint32_t>(previous);
+    INVARIANT(assignedChunks < std::numeric_limits<uint32_t>::max(), "Exceeded the number of chunks per sequence number");
+    const auto balance = static_cast<uint32_t>((previous + increment) >> BALANCE_SHIFT);
+    return {.chunkNumber = ChunkNumber(ChunkNumber::INITIAL + assignedChunks), .isLastChunk = isEndOfIncomingChunk and balance == 0};
+}
+
+template <size_t RingSize>
+bool ChunkNumberTracker<RingSize>::isInWindow(const SequenceNumber::Underlying sequenceNumber) const
+{
+    const auto start = windowStart.load();
+    INVARIANT(sequenceNumber >= start, "Received chunk for sequence {} that was already completed", sequenceNumber);
+    return sequenceNumber - start < RingSize;
+}
+
+template <size_t RingSize>
+typename ChunkNumberTracker<RingSize>::Assignment ChunkNumberTracker<RingSize>::assign(
+    const SequenceNumber sequenceNumber,
+    const bool isEndOfIncomingChunk,
+    const ChunkNumber incomingChunkNumber,
+    const bool isIncomingBufferTheLastChunk)
+{
+    PRECONDITION(sequenceNumber != INVALID<SequenceNumber>, "SequenceNumber is invalid");
+    const auto sequence = sequenceNumber.getRawValue();
+    const auto increment = getIncrement(isEndOfIncomingChunk, incomingChunkNumber, isIncomingBufferTheLastChunk);
+    const auto isLastIncomingChunk = isEndOfIncomingChunk and isIncomingBufferTheLastChunk;
+
+    /// Reading the window before the number of pending fallback states pairs with tryAssignInFallback, which increments the number before
+    /// it reads the window. Thus, either this thread sees the fallback sequence, or the fallback sees (at least) the window of this thread.
+    if (isInWindow(sequence) and numberOfPendingFallbackStates.load() == 0)
+    {
+        return assignInSlot(sequence, increment, isEndOfIncomingChunk, isLastIncomingChunk);
+    }
+    if (Assignment assignment{}; not tryAssignInFallback(sequence, increment, isEndOfIncomingChunk, isLastIncomingChunk, assignment))
+    {
+        return assignment;
+    }
+    return assignInSlot(sequence, increment, isEndOfIncomingChunk, isLastIncomingChunk);
+}
+
+template <size_t RingSize>
+typename ChunkNumberTracker<RingSize>::Assignment ChunkNumberTracker<RingSize>::assignInSlot(
+    const SequenceNumber::Underlying sequenceNumber, const State increment, const bool isEndOfIncomingChunk, const bool isLastIncomingChunk)
+{
+    auto& slot = slots[sequenceNumber % RingSize];
+#ifndef NO_ASSERT
+    if (isLastIncomingChunk)
+    {
+        INVARIANT(not slot.seenLastChunk.exchange(true), "Received multiple last chunks for sequence {}", sequenceNumber);
+    }
+#endif
+    const auto assignment = toAssignment(slot.state.fetch_add(increment), increment, isEndOfIncomingChunk);
+    if (assignment.isLastChunk)
+    {
+        /// No other thread accesses the slot until the window moved past the sequence number
+        slot.state.store(0);
+#ifndef NO_ASSERT
+        slot.seenLastChunk.store(false);
+#endif
+        slot.completedSequenceNumber.store(sequenceNumber);
+        advanceWindow();
+    }
+    return assignment;
+}
+
+template <size_t RingSize>
+bool ChunkNumberTracker<RingSize>::tryAssignInFallback(
+    const SequenceNumber::Underlying sequenceNumber,
+    const State increment,
+    const bool isEndOfIncomingChunk,
+    const bool isLastIncomingChunk,
+    Assignment& assignment)
+{
+    {
+        const auto lockedFallbackStates = fallbackStates.wlock();
+        auto fallbackState = lockedFallbackStates->find(sequenceNumber);
+        if (fallbackState == lockedFallbackStates->end())
+        {
+            numberOfPendingFallbackStates.fetch_add(1);
+            if (isInWindow(sequenceNumber))
+            {
+                numberOfPendingFallbackStates.fetch_sub(1);
+                return true;
+            }
+            fallbackState = lockedFallbackStates->emplace(sequenceNumber, FallbackState{}).first;
+            numberOfFallbackStates.fetch_add(1);
+        }
+
+        auto& state = fallbackState->second;
+        INVARIANT(not state.completed, "Received chunk for sequence {} that was already completed", sequenceNumber);
+#ifndef NO_ASSERT
+        if (isLastIncomingChunk)
+        {
+            INVARIANT(not std::exchange(state.seenLastChunk, true), "Received multiple last chunks for sequence {}", sequenceNumber);
+        }
+#endif
+        assignment = toAssignment(state.state, increment, isEndOfIncomingChunk);
+        state.state += increment;
+        if (not assignment.isLastChunk)
+        {
+            return false;
+        }
+        /// The window erases the completed sequence number, once it reaches it
+        state.completed = true;
+        numberOfPendingFallbackStates.fetch_sub(1);
+    }
+    advanceWindow();
+    return false;
+}
+
+template <size_t RingSize>
+bool ChunkNumberTracker<RingSize>::eraseIfCompletedInFallback(const SequenceNumber::Underlying sequenceNumber)
+{
+    const auto lockedFallbackStates = fallbackStates.wlock();
+    const auto fallbackState = lockedFallbackStates->find(sequenceNumber);
+    if (fallbackState == lockedFallbackStates->end() or not fallbackState->second.completed)
+    {
+        return false;
+    }
+    lockedFallbackStates->erase(fallbackState);
+    numberOfFallbackStates.fetch_sub(1);
+    return true;
+}
+
+template <size_t RingSize>
+void ChunkNumberTracker<RingSize>::advanceWindow()
+{
+    /// A thread that completes a sequence number records the completion before it moves the window. Thus, if two threads complete
+    /// consecutive sequence numbers concurrently, at least one of them sees the completion of the other one.
+    auto start = windowStart.load();
+    while (slots[start % RingSize].completedSequenceNumber.load() == start
+           or (numberOfFallbackStates.load() > 0 and eraseIfCompletedInFallback(start)))
+    {
+        /// Only the thread that saw the completion (in the slot or by erasing it from the fallback map) may move the window past it
+        if (windowStart.compare_exchange_strong(start, start + 1))
+        {
+            ++start;
+        }
+    }
+}
+
+}
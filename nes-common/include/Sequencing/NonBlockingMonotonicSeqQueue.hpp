@@ -21,6 +21,8 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <mutex>
+#include <vector>
 #include <Identifiers/Identifiers.hpp>
 #include <Sequencing/ChunkCollector.hpp>
 #include <Sequencing/SequenceData.hpp>
@@ -48,6 +50,9 @@ namespace NES::Sequencing
 ///
 /// GetCurrentValue will return the following sequence of current values:
 /// [<1,T1>,<2,T2>,<2,T2>,<2,T2>,<2,T2>,<4,T6>,<7,T7>]
+///
+/// Once the current sequence number leaves a block, the queue retires the block and reuses it for a later block, as soon as no thread
+/// references it anymore. Thus, the queue only allocates blocks until the number of blocks in flight is reached.
 template <class T, uint64_t BlockSize = 8192>
 class NonBlockingMonotonicSeqQueue
 {
@@ -66,13 +71,20 @@ private:
     public:
         explicit Block(size_t blockIndex) : blockIndex(blockIndex) { };
         ~Block() = default;
-        const size_t blockIndex;
+        /// Only called on blocks that no other thread references.
+        /// The sequence numbers of the previous use are smaller than those of the block index, thus we do not have to clear them.
+        void reuse(size_t newBlockIndex)
+        {
+            blockIndex = newBlockIndex;
+            next.reset();
+        }
+        size_t blockIndex;
         std::array<Container, BlockSize> log = {};
         std::shared_ptr<Block> next = std::shared_ptr<Block>();
     };
 
 public:
-    NonBlockingMonotonicSeqQueue() : head(std::make_shared<Block>(0)), currentSeq(0) { }
+    NonBlockingMonotonicSeqQueue() : head(std::make_shared<Block>(0)), currentSeq(0) { retiredBlocks.reserve(MAX_RETIRED_BLOCKS); }
 
     ~NonBlockingMonotonicSeqQueue() = default;
 
@@ -117,7 +129,43 @@ public:
         return value.value.load(std::memory_order_relaxed);
     }
 
+    /// Number of blocks that the queue allocated on the heap, instead of reusing a retired block
+    [[nodiscard]] uint64_t getNumberOfAllocatedBlocks() const { return numberOfAllocatedBlocks.load(std::memory_order::relaxed); }
+
 private:
+    /// Bounds the memory of the retired blocks, if readers keep many of them alive
+    static constexpr size_t MAX_RETIRED_BLOCKS = 4;
+
+    /// Reuses the oldest retired block, if no thread references it anymore. A retired block references its successor, thus the
+    /// successors only become reusable after their predecessor was reused.
+    /// The lock is only taken once per BlockSize sequence numbers and keeps emplace and getCurrentValue lock free otherwise.
+    std::shared_ptr<Block> allocateBlock(size_t blockIndex)
+    {
+        {
+            const std::scoped_lock lock(retiredBlocksMutex);
+            if (const auto reusable = std::ranges::find_if(retiredBlocks, [](const auto& block) { return block.use_count() == 1; });
+                reusable != retiredBlocks.end())
+            {
+                auto block = std::move(*reusable);
+                retiredBlocks.erase(reusable);
+                block->reuse(blockIndex);
+                return block;
+            }
+        }
+        numberOfAllocatedBlocks.fetch_add(1, std::memory_order::relaxed);
+        return std::make_shared<Block>(blockIndex);
+    }
+
+    void retireBlock(std::shared_ptr<Block> block)
+    {
+        const std::scoped_lock lock(retiredBlocksMutex);
+        if (retiredBlocks.size() == MAX_RETIRED_BLOCKS)
+        {
+            retiredBlocks.erase(retiredBlocks.begin());
+        }
+        retiredBlocks.push_back(std::move(block));
+    }
+
     /// @brief Emplace a value T to the specific location of the passed sequence number
     ///
     /// The method is split in two phased:
@@ -141,10 +189,13 @@ private:
             auto nextBlock = std::atomic_load(&currentBlock->next);
             if (nextBlock == nullptr)
             {
-                auto newBlock = std::make_shared<Block>(currentBlock->blockIndex + 1);
-                std::atomic_compare_exchange_weak(&currentBlock->next, &nextBlock, newBlock);
+                auto newBlock = allocateBlock(currentBlock->blockIndex + 1);
                 /// we don't care if this or another thread succeeds, as we just start over again in the loop
                 /// and use what ever is now stored in currentBlock.next
+                if (not std::atomic_compare_exchange_weak(&currentBlock->next, &nextBlock, newBlock))
+                {
+                    retireBlock(std::move(newBlock));
+                }
             }
             else
             {
@@ -205,7 +256,11 @@ private:
                         /// Modify currentSeq and head
                         if (std::atomic_compare_exchange_weak(&currentSeq, &currentSequenceNumber, nextSeqNumber))
                         {
-                            std::atomic_compare_exchange_weak(&head, &currentBlock, nextBlock);
+                            /// Only the thread that moved the current sequence number moves the head, thus it must not fail spuriously
+                            if (std::atomic_compare_exchange_strong(&head, &currentBlock, nextBlock))
+                            {
+                                retireBlock(std::move(currentBlock));
+                            }
                         }
                         continue;
                     }
@@ -249,6 +304,10 @@ private:
     /// Stores the current sequence number
     std::atomic<SequenceNumber::Underlying> currentSeq;
     ChunkCollector<BlockSize> chunks;
+    /// Blocks behind the head, oldest first
+    std::mutex retiredBlocksMutex;
+    std::vector<std::shared_ptr<Block>> retiredBlocks;
+    std::atomic<uint64_t> numberOfAllocatedBlocks{1};
 };
 
 }
@@ -13,10 +13,12 @@
 */
 
 #pragma once
+#include <cstddef>
 #include <string>
 #include <thread>
 
 #include <utility>
+#include <vector>
 #include <Identifiers/Identifiers.hpp>
 #include <spdlog/spdlog.h>
 #include <ErrorHandling.hpp>
@@ -117,6 +119,11 @@ public:
         setThreadName(ThreadName);
     }
 
+    /// Restricts the current thread to the given cpus. An empty list leaves the thread on the cpus it currently may run on.
+    /// Threads inherit the cpus of the thread that created them. Thus, a thread that must not share the cpus of its creator has to be
+    /// pinned itself. Returns false if the cpus were rejected, e.g., because none of them is online.
+    static bool pinThisThread(const std::vector<size_t>& cpus);
+
     ///Sets the currents thread's name.
     ///threadName has to be non-empty and will be truncated to PTHREAD_NAME_LENGTH character
     static void setThreadName(const std::string_view threadName)
@@ -27,6 +27,8 @@ public:
     using Underlying = uint64_t;
     static constexpr Underlying INITIAL_VALUE = 0;
     static constexpr Underlying INVALID_VALUE = UINT64_MAX;
+    /// The watermark of a heartbeat buffer without records, which an idle source emits, c.f., MultiOriginWatermarkProcessor
+    static constexpr Underlying IDLE_SOURCE_VALUE = UINT64_MAX - 1;
 
     explicit constexpr Timestamp(const Underlying value) : value(value) { }
 
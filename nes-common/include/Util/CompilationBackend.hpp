@@ -0,0 +1,31 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+
+namespace NES
+{
+/// Backend of the nautilus engine that compiles the traced pipelines.
+enum class CompilationBackend : uint8_t
+{
+    /// Lowers the pipelines via MLIR to LLVM and compiles them just in time for the host CPU.
+    MLIR,
+    /// Generates C++ code and compiles it with the system compiler.
+    CPP,
+    /// Compiles the pipelines to byte code, which compiles fast but runs slower than native code.
+    BYTECODE
+};
+}
@@ -23,6 +23,14 @@ enum class ExecutionMode : uint8_t
     /// Uses the interpretation based execution mode.
     INTERPRETER,
     /// Uses the compilation based execution mode.
-    COMPILER
+    COMPILER,
+    /// Uses the compilation based execution mode and evaluates selections batch-at-a-time over columnar buffers.
+    VECTORIZED,
+    /// Starts with the interpretation based execution mode and switches to the compiled pipelines once their compilation in the
+    /// background finished.
+    TIERED,
+    /// Lowers the traced pipelines once to the register-based byte code of nautilus and runs them by its dispatch loop. Starts almost as
+    /// fast as the interpreter, which replays the operators for every tuple, but runs several times faster, e.g., for ad-hoc queries.
+    BYTECODE
 };
 }
@@ -0,0 +1,34 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+
+namespace NES
+{
+/// Hash function that the hash based operators, i.e., aggregations and hash joins, use to hash their keys.
+enum class HashFunctionType : uint8_t
+{
+    /// Chooses the hash function based on the data types of the keys.
+    AUTO,
+    /// MurMur3, which reuses the hashes that dictionaries cache for interned variable sized values.
+    MURMUR3,
+    /// XXH3, which mixes fixed size keys with fewer instructions and hashes long variable sized keys faster.
+    XXH3,
+    /// Perfect hash function for keys from a small range of integers, e.g., hours, region ids or enums, which turns the hash maps into
+    /// direct arrays. Falls back to MurMur3 for variable sized keys.
+    DIRECT
+};
+}
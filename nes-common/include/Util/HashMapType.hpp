@@ -0,0 +1,29 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+
+namespace NES
+{
+/// Hash map implementation that is used by the hash based operators, i.e., aggregations and hash joins.
+enum class HashMapType : uint8_t
+{
+    /// Fixed number of buckets, whose collisions are resolved via a chain of entries.
+    CHAINED,
+    /// Open addressing with SIMD probed control bytes in the style of a swiss table, which grows with the number of keys.
+    SWISS
+};
+}
@@ -118,22 +118,29 @@ struct LogCaller<LogLevel::LOG_WARNING>
     }
 };
 
-/// Macro to suppress unused warnings
+/// Macro to suppress unused warnings. The arguments are not evaluated, i.e., an eliminated log message does not cost anything.
 #define SUPPRESS_UNUSED_WARNING(...) \
     do \
     { \
-        [](auto&&... args) { ((void)args, ...); }(__VA_ARGS__); \
+        if (false) \
+        { \
+            [](auto&&... args) { ((void)args, ...); }(__VA_ARGS__); \
+        } \
     } while (0)
 
 
 /// @brief this is the new logging macro that is the entry point for logging calls
+/// Levels above the compile-time level are eliminated. Levels above the runtime level skip the arguments after a single relaxed load.
 #define NES_LOG(LEVEL, ...) \
     do \
     { \
         auto constexpr __level = getLogLevel(LEVEL); \
         if constexpr (NES_COMPILE_TIME_LOG_LEVEL >= __level) \
         { \
-            NES::LogCaller<LEVEL>::do_call(spdlog::source_loc{__FILE__, __LINE__, SPDLOG_FUNCTION}, __VA_ARGS__); \
+            if (NES::Logger::isEnabled(LEVEL)) \
+            { \
+                NES::LogCaller<LEVEL>::do_call(spdlog::source_loc{__FILE__, __LINE__, SPDLOG_FUNCTION}, __VA_ARGS__); \
+            } \
         } \
         else \
         { \
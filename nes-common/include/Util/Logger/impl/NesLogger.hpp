@@ -14,8 +14,14 @@
 
 #pragma once
 
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
 #include <Util/Logger/LogLevel.hpp>
 #include <fmt/core.h>
+#include <fmt/format.h>
 #include <spdlog/fwd.h>
 #include <spdlog/logger.h>
 #include <spdlog/mdc.h>
@@ -23,6 +29,7 @@
 namespace spdlog::details
 {
 class periodic_worker;
+class thread_pool;
 }
 
 namespace NES
@@ -32,6 +39,9 @@ namespace detail
 {
 /// Creates an empty logger that writes to /dev/null
 std::shared_ptr<spdlog::logger> createEmptyLogger();
+
+/// The most verbose level that the global logger writes. The log macros check it before they evaluate their arguments.
+inline std::atomic<LogLevel> enabledLogLevel{LogLevel::LOG_NONE}; /// NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 }
 
 namespace detail
@@ -52,35 +62,35 @@ public:
     template <typename... arguments>
     constexpr inline void trace(spdlog::source_loc&& loc, fmt::format_string<arguments...>&& format, arguments&&... args)
     {
-        impl->log(std::move(loc), spdlog::level::trace, std::move(format), std::forward<arguments>(args)...);
+        log(std::move(loc), spdlog::level::trace, std::move(format), std::forward<arguments>(args)...);
     }
 
     /// Logs a warning message using a format, a source location, and a set of arguments to display
     template <typename... arguments>
     constexpr inline void warn(spdlog::source_loc&& loc, fmt::format_string<arguments...> format, arguments&&... args)
     {
-        impl->log(std::move(loc), spdlog::level::warn, std::move(format), std::forward<arguments>(args)...);
+        log(std::move(loc), spdlog::level::warn, std::move(format), std::forward<arguments>(args)...);
     }
 
     /// Logs an info message using a format, a source location, and a set of arguments to display
     template <typename... arguments>
     constexpr inline void info(spdlog::source_loc&& loc, fmt::format_string<arguments...> format, arguments&&... args)
     {
-        impl->log(std::move(loc), spdlog::level::info, std::move(format), std::forward<arguments>(args)...);
+        log(std::move(loc), spdlog::level::info, std::move(format), std::forward<arguments>(args)...);
     }
 
     /// Logs a debug message using a format, a source location, and a set of arguments to display
     template <typename... arguments>
     constexpr inline void debug(spdlog::source_loc&& loc, fmt::format_string<arguments...> format, arguments&&... args)
     {
-        impl->log(std::move(loc), spdlog::level::debug, std::move(format), std::forward<arguments>(args)...);
+        log(std::move(loc), spdlog::level::debug, std::move(format), std::forward<arguments>(args)...);
     }
 
     /// Logs an error message using a format, a source location, and a set of arguments to display
     template <typename... arguments>
     constexpr inline void error(spdlog::source_loc&& loc, fmt::format_string<arguments...> format, arguments&&... args)
     {
-        impl->log(std::move(loc), spdlog::level::err, std::move(format), std::forward<arguments>(args)...);
+        log(std::move(loc), spdlog::level::err, std::move(format), std::forward<arguments>(args)...);
     }
 
     /// flushes the current log to filesystem
@@ -94,6 +104,23 @@ public:
     void changeLogLevel(LogLevel newLevel);
 
 private:
+    /// Formats the message on the calling thread, so that the async logger only copies the formatted message into its queue
+    template <typename... arguments>
+    void log(spdlog::source_loc&& loc, spdlog::level::level_enum level, fmt::format_string<arguments...> format, arguments&&... args)
+    {
+        if (impl->should_log(level))
+        {
+            spdlog::memory_buf_t message;
+            fmt::format_to(std::back_inserter(message), format, std::forward<arguments>(args)...);
+            logFormatted(std::move(loc), level, std::string_view{message.data(), message.size()});
+        }
+    }
+
+    /// Prepends the context of the calling thread, e.g., the worker, thread name and log contexts, and enqueues the message
+    void logFormatted(spdlog::source_loc&& loc, spdlog::level::level_enum level, std::string_view message);
+
+    /// Owns the thread that runs the sinks. Declared before impl, so that it outlives the logger and drains the queue on destruction.
+    std::shared_ptr<spdlog::details::thread_pool> threadPool{nullptr};
     std::shared_ptr<spdlog::logger> impl{nullptr};
     LogLevel currentLogLevel = LogLevel::LOG_INFO;
     std::atomic<bool> isShutdown{false};
@@ -106,6 +133,12 @@ namespace Logger
 void setupLogging(const std::string& logFileName, LogLevel level, bool useStdout = true);
 
 std::shared_ptr<detail::Logger> getInstance();
+
+/// Returns true if the global logger writes messages of the level. This is a single relaxed load, i.e., disabled levels are cheap.
+inline bool isEnabled(const LogLevel level) noexcept
+{
+    return getLogLevel(level) <= getLogLevel(detail::enabledLogLevel.load(std::memory_order_relaxed));
+}
 }
 
 struct LogContext
@@ -40,6 +40,7 @@ class RollingAverage
         if (rollingCount == 0)
         {
             average = 0;
+            return;
         }
 
         const double sum = std::accumulate(buffer.begin(), buffer.end(), 0.0);
@@ -47,7 +48,7 @@ class RollingAverage
     }
 
 public:
-    explicit RollingAverage(size_t windowSize) : buffer(windowSize, 0), windowSize(windowSize), index(0), rollingCount(0)
+    explicit RollingAverage(size_t windowSize) : buffer(windowSize, 0), windowSize(windowSize), index(0), rollingCount(0), average(0)
     {
         PRECONDITION(windowSize > 0, "Window size {} must be greater than 0", windowSize);
     }
@@ -72,6 +73,9 @@ public:
     }
 
     [[nodiscard]] T getAverage() const { return average; }
+
+    /// True, if no item has been added so far. Then, the average is 0.
+    [[nodiscard]] bool empty() const { return rollingCount == 0; }
 };
 
 }
@@ -15,6 +15,7 @@
 
 #include <charconv>
 #include <concepts>
+#include <cstddef>
 #include <optional>
 #include <ranges>
 #include <string>
@@ -150,4 +151,8 @@ std::vector<T> splitWithStringDelimiter(std::string_view inputString, std::strin
 /// Splits the given input string_view on all characters of the delimiters string_view.
 std::vector<std::string_view> splitOnMultipleDelimiters(std::string_view input, const std::vector<char>& delimiters);
 
+/// Parses a list of ids in the format of the linux cpu and node lists, e.g., `0-3,8,10-11`, into the contained ids.
+/// Returns nullopt if an entry is not a (non-decreasing) range of non-negative integers. An empty list contains no ids.
+[[nodiscard]] std::optional<std::vector<size_t>> parseIdList(std::string_view list);
+
 }
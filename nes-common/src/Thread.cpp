@@ -14,7 +14,12 @@
 
 #include <Thread.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <memory>
 #include <string>
+#include <vector>
+#include <sched.h>
 #include <Identifiers/Identifiers.hpp>
 
 namespace NES
@@ -22,4 +27,27 @@ namespace NES
 thread_local WorkerId Thread::WorkerNodeId = WorkerId("Not A Worker");
 thread_local std::string Thread::ThreadName = "unnamed";
 
+bool Thread::pinThisThread(const std::vector<size_t>& cpus)
+{
+    if (cpus.empty())
+    {
+        return true;
+    }
+    /// The dynamically sized cpu set supports cpu ids beyond the fixed CPU_SETSIZE of cpu_set_t
+    const auto numberOfCpus = *std::ranges::max_element(cpus) + 1;
+    constexpr auto freeCpuSet = [](cpu_set_t* cpuSet) { CPU_FREE(cpuSet); };
+    const std::unique_ptr<cpu_set_t, decltype(freeCpuSet)> cpuSet{CPU_ALLOC(numberOfCpus)};
+    if (!cpuSet)
+    {
+        return false;
+    }
+    const auto cpuSetSize = CPU_ALLOC_SIZE(numberOfCpus);
+    CPU_ZERO_S(cpuSetSize, cpuSet.get());
+    for (const auto cpu : cpus)
+    {
+        CPU_SET_S(cpu, cpuSetSize, cpuSet.get());
+    }
+    return sched_setaffinity(0, cpuSetSize, cpuSet.get()) == 0;
+}
+
 }
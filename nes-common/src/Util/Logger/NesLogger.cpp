@@ -14,8 +14,12 @@
 #include <Util/Logger/impl/NesLogger.hpp>
 
 #include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 #include <Identifiers/NESStrongTypeFormat.hpp>
@@ -23,37 +27,14 @@
 #include <spdlog/async.h>
 #include <spdlog/common.h>
 #include <spdlog/details/periodic_worker.h>
+#include <spdlog/details/thread_pool.h>
 #include <spdlog/logger.h>
+#include <spdlog/mdc.h>
 #include <spdlog/pattern_formatter.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <Thread.hpp>
 
-/// Custom formatter flags that render the worker and thread id
-class WorkerIdFlag final : public spdlog::custom_flag_formatter
-{
-public:
-    void format(const spdlog::details::log_msg&, const std::tm&, spdlog::memory_buf_t& dest) override
-    {
-        const auto id = NES::Thread::getThisWorkerNodeId().view();
-        dest.append(id.data(), id.data() + id.size());
-    }
-
-    std::unique_ptr<custom_flag_formatter> clone() const override { return spdlog::details::make_unique<WorkerIdFlag>(); }
-};
-
-class ThreadNameFlag final : public spdlog::custom_flag_formatter
-{
-public:
-    void format(const spdlog::details::log_msg&, const std::tm&, spdlog::memory_buf_t& dest) override
-    {
-        const auto id = NES::Thread::getThisThreadName();
-        dest.append(id.data(), id.data() + id.size());
-    }
-
-    std::unique_ptr<custom_flag_formatter> clone() const override { return spdlog::details::make_unique<ThreadNameFlag>(); }
-};
-
 namespace NES
 {
 
@@ -62,7 +43,26 @@ namespace detail
 
 static constexpr auto SPDLOG_NES_LOGGER_NAME = "nes_logger";
 static constexpr auto DEV_NULL = "/dev/null";
-static constexpr auto SPDLOG_PATTERN = "%^[%H:%M:%S.%f] [%L] [%*] [%G] [%&] [%s:%#] [%!] %v%$";
+/// The worker, thread name, log contexts and source location are part of the message, as the sinks run on the thread of the async logger
+static constexpr auto SPDLOG_PATTERN = "%^[%H:%M:%S.%f] [%L] %v%$";
+/// The number of messages that the async logger queues before a logging thread blocks until the sinks catch up
+static constexpr size_t ASYNC_QUEUE_SIZE = 8192;
+
+struct LoggerHolder
+{
+    static std::shared_ptr<Logger> singleton;
+
+    ~LoggerHolder()
+    {
+        singleton.reset();
+        /// Not sure why, but we have to disable the call to spdlog::shutdown() here. Otherwise, the system tests will not shutdown properly.
+        /// The actual error happens in std::__hash_table::__deallocate_node() line 1109.
+        /// TODO #348: Investigate why the call to spdlog::shutdown() causes the system tests to fail.
+        /// spdlog::shutdown();
+    }
+};
+
+std::shared_ptr<Logger> LoggerHolder::singleton = nullptr;
 
 auto toSpdlogLevel(const LogLevel level)
 {
@@ -116,24 +116,19 @@ Logger::Logger(const std::string& logFileName, const LogLevel level, const bool
         consoleSink->set_level(spdlogLevel);
         consoleSink->set_color_mode(spdlog::color_mode::always);
 
-        auto formatter = std::make_unique<spdlog::pattern_formatter>();
-        formatter->add_flag<WorkerIdFlag>('*');
-        formatter->add_flag<ThreadNameFlag>('G');
-        formatter->set_pattern(SPDLOG_PATTERN);
-        consoleSink->set_formatter(std::move(formatter));
+        consoleSink->set_formatter(std::make_unique<spdlog::pattern_formatter>(SPDLOG_PATTERN));
         sinks.push_back(consoleSink);
     }
 
     auto fileSink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(logFileName, true);
     fileSink->set_level(spdlogLevel);
-    auto formatter = std::make_unique<spdlog::pattern_formatter>();
-    formatter->add_flag<WorkerIdFlag>('*');
-    formatter->add_flag<ThreadNameFlag>('G');
-    formatter->set_pattern(SPDLOG_PATTERN);
-    fileSink->set_formatter(std::move(formatter));
+    fileSink->set_formatter(std::make_unique<spdlog::pattern_formatter>(SPDLOG_PATTERN));
     sinks.push_back(fileSink);
 
-    impl = std::make_shared<spdlog::logger>(SPDLOG_NES_LOGGER_NAME, sinks.begin(), sinks.end());
+    /// Writing to the console and the log file happens on a single thread, so that logging threads neither wait on io nor on the sinks
+    threadPool = std::make_shared<spdlog::details::thread_pool>(ASYNC_QUEUE_SIZE, 1, [] { Thread::setThreadName("logger"); });
+    impl = std::make_shared<spdlog::async_logger>(
+        SPDLOG_NES_LOGGER_NAME, sinks.begin(), sinks.end(), threadPool, spdlog::async_overflow_policy::block);
 
     impl->flush_on(spdlog::level::err);
 
@@ -170,11 +165,39 @@ void Logger::shutdown()
     bool expected = false;
     if (isShutdown.compare_exchange_strong(expected, true))
     {
+        if (this == LoggerHolder::singleton.get())
+        {
+            enabledLogLevel.store(LogLevel::LOG_NONE, std::memory_order_relaxed);
+        }
         flusher.reset();
         impl.reset();
+        /// Joins the thread of the async logger after it wrote all queued messages
+        threadPool.reset();
     }
 }
 
+void Logger::logFormatted(spdlog::source_loc&& loc, const spdlog::level::level_enum level, const std::string_view message)
+{
+    spdlog::memory_buf_t line;
+    fmt::format_to(std::back_inserter(line), "[{}] [{}] [", Thread::getThisWorkerNodeId().view(), Thread::getThisThreadName());
+    bool first = true;
+    for (const auto& [key, value] : spdlog::mdc::get_context())
+    {
+        fmt::format_to(std::back_inserter(line), "{}{}:{}", first ? "" : " ", key, value);
+        first = false;
+    }
+    const auto* const slash = loc.filename != nullptr ? std::strrchr(loc.filename, '/') : nullptr;
+    const auto* const filename = slash != nullptr ? slash + 1 : (loc.filename != nullptr ? loc.filename : "");
+    fmt::format_to(
+        std::back_inserter(line),
+        "] [{}:{}] [{}] {}",
+        filename,
+        loc.line,
+        loc.funcname != nullptr ? loc.funcname : "",
+        message);
+    impl->log(loc, level, spdlog::string_view_t{line.data(), line.size()});
+}
+
 void Logger::changeLogLevel(LogLevel newLevel)
 {
     auto spdNewLogLevel = detail::toSpdlogLevel(newLevel);
@@ -184,23 +207,11 @@ void Logger::changeLogLevel(LogLevel newLevel)
     }
     impl->set_level(spdNewLogLevel);
     std::swap(newLevel, currentLogLevel);
-}
-
-struct LoggerHolder
-{
-    static std::shared_ptr<Logger> singleton;
-
-    ~LoggerHolder()
+    if (this == LoggerHolder::singleton.get())
     {
-        singleton.reset();
-        /// Not sure why, but we have to disable the call to spdlog::shutdown() here. Otherwise, the system tests will not shutdown properly.
-        /// The actual error happens in std::__hash_table::__deallocate_node() line 1109.
-        /// TODO #348: Investigate why the call to spdlog::shutdown() causes the system tests to fail.
-        /// spdlog::shutdown();
+        enabledLogLevel.store(currentLogLevel, std::memory_order_relaxed);
     }
-};
-
-std::shared_ptr<Logger> LoggerHolder::singleton = nullptr;
+}
 
 }
 
@@ -214,6 +225,7 @@ void setupLogging(const std::string& logFileName, LogLevel level, bool useStdout
 {
     auto newLogger = std::make_shared<detail::Logger>(logFileName, level, useStdout);
     std::swap(detail::LoggerHolder::singleton, newLogger);
+    detail::enabledLogLevel.store(level, std::memory_order_relaxed);
 }
 
 std::shared_ptr<detail::Logger> getInstance()
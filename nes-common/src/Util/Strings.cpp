@@ -346,4 +346,24 @@ std::vector<std::string_view> splitOnMultipleDelimiters(std::string_view input,
     return result;
 }
 
+std::optional<std::vector<size_t>> parseIdList(const std::string_view list)
+{
+    std::vector<size_t> ids;
+    for (const auto range : splitOnMultipleDelimiters(list, {',', '\n'}))
+    {
+        const auto dash = range.find('-');
+        const auto first = from_chars<size_t>(trimWhiteSpaces(range.substr(0, dash)));
+        const auto last = dash == std::string_view::npos ? first : from_chars<size_t>(trimWhiteSpaces(range.substr(dash + 1)));
+        if (!first || !last || *first > *last)
+        {
+            return std::nullopt;
+        }
+        for (size_t id = *first; id <= *last; ++id)
+        {
+            ids.push_back(id);
+        }
+    }
+    return ids;
+}
+
 }
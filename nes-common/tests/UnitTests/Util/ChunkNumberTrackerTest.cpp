@@ -0,0 +1,198 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+#include <Sequencing/ChunkNumberTracker.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <tuple>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+#include <Identifiers/NESStrongType.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+namespace NES
+{
+
+namespace
+{
+/// An incoming chunk of a sequence number, for which the operator produces 'numberOfBuffers' buffers
+struct IncomingChunk
+{
+    SequenceNumber sequenceNumber;
+    ChunkNumber chunkNumber;
+    bool lastChunk;
+    size_t numberOfBuffers;
+};
+
+template <size_t RingSize>
+std::vector<ChunkNumberTracker<>::Assignment> assignBuffers(ChunkNumberTracker<RingSize>& tracker, const IncomingChunk& incomingChunk)
+{
+    std::vector<ChunkNumberTracker<>::Assignment> assignments;
+    for (size_t buffer = 1; buffer <= incomingChunk.numberOfBuffers; ++buffer)
+    {
+        const auto [chunkNumber, isLastChunk] = tracker.assign(
+            incomingChunk.sequenceNumber, buffer == incomingChunk.numberOfBuffers, incomingChunk.chunkNumber, incomingChunk.lastChunk);
+        assignments.push_back({chunkNumber, isLastChunk});
+    }
+    return assignments;
+}
+
+ChunkNumber chunk(const ChunkNumber::Underlying offset)
+{
+    return ChunkNumber(ChunkNumber::INITIAL + offset);
+}
+}
+
+TEST(ChunkNumberTrackerTest, SingleChunk)
+{
+    ChunkNumberTracker tracker;
+    const auto [chunkNumber, isLastChunk] = tracker.assign(INITIAL<SequenceNumber>, true, INITIAL<ChunkNumber>, true);
+    EXPECT_EQ(chunkNumber, INITIAL<ChunkNumber>);
+    EXPECT_TRUE(isLastChunk);
+}
+
+TEST(ChunkNumberTrackerTest, MultipleBuffersForSingleChunk)
+{
+    ChunkNumberTracker tracker;
+    const auto assignments = assignBuffers(tracker, {INITIAL<SequenceNumber>, INITIAL<ChunkNumber>, true, 3});
+    ASSERT_EQ(assignments.size(), 3);
+    for (size_t i = 0; i < assignments.size(); ++i)
+    {
+        EXPECT_EQ(assignments[i].chunkNumber, chunk(i));
+        EXPECT_EQ(assignments[i].isLastChunk, i == assignments.size() - 1);
+    }
+}
+
+TEST(ChunkNumberTrackerTest, IncomingChunksOutOfOrder)
+{
+    ChunkNumberTracker tracker;
+    const auto lastIncomingChunk = tracker.assign(INITIAL<SequenceNumber>, true, chunk(1), true);
+    EXPECT_EQ(lastIncomingChunk.chunkNumber, chunk(0));
+    EXPECT_FALSE(lastIncomingChunk.isLastChunk);
+
+    const auto firstIncomingChunk = tracker.assign(INITIAL<SequenceNumber>, true, chunk(0), false);
+    EXPECT_EQ(firstIncomingChunk.chunkNumber, chunk(1));
+    EXPECT_TRUE(firstIncomingChunk.isLastChunk);
+}
+
+TEST(ChunkNumberTrackerTest, SequenceNumbersBeyondTheWindow)
+{
+    /// With a window of four sequence numbers, sequence number 10 arrives before the window covers it
+    ChunkNumberTracker<4> tracker;
+    const SequenceNumber beyondWindow(10);
+    EXPECT_FALSE(tracker.assign(beyondWindow, true, chunk(0), false).isLastChunk);
+
+    for (SequenceNumber::Underlying sequenceNumber = SequenceNumber::INITIAL; sequenceNumber < beyondWindow.getRawValue(); ++sequenceNumber)
+    {
+        const auto assignments = assignBuffers(tracker, {SequenceNumber(sequenceNumber), INITIAL<ChunkNumber>, true, 2});
+        EXPECT_TRUE(assignments.back().isLastChunk) << sequenceNumber;
+    }
+
+    /// The sequence number keeps its state, although the window covers it now
+    const auto completing = tracker.assign(beyondWindow, true, chunk(1), true);
+    EXPECT_EQ(completing.chunkNumber, chunk(1));
+    EXPECT_TRUE(completing.isLastChunk);
+
+    /// The window moved past the sequence number
+    for (SequenceNumber::Underlying sequenceNumber = beyondWindow.getRawValue() + 1; sequenceNumber < 20; ++sequenceNumber)
+    {
+        const auto [chunkNumber, isLastChunk] = tracker.assign(SequenceNumber(sequenceNumber), true, INITIAL<ChunkNumber>, true);
+        EXPECT_EQ(chunkNumber, INITIAL<ChunkNumber>);
+        EXPECT_TRUE(isLastChunk) << sequenceNumber;
+    }
+}
+
+class ConcurrentChunkNumberTrackerTest : public ::testing::TestWithParam<std::tuple<SequenceNumber::Underlying, size_t, size_t>>
+{
+};
+
+/// Every thread produces the buffers of random incoming chunks. Per sequence number, the chunk numbers must be the numbers of 1 to n
+/// and exactly the buffer with the chunk number n must be flagged as the last chunk.
+TEST_P(ConcurrentChunkNumberTrackerTest, RandomIncomingChunks)
+{
+    const auto [numberOfSequenceNumbers, maxIncomingChunks, numberOfThreads] = GetParam();
+    std::mt19937 rd(numberOfSequenceNumbers + maxIncomingChunks + numberOfThreads);
+    std::uniform_int_distribution<size_t> numbers(1, maxIncomingChunks);
+
+    std::vector<IncomingChunk> incomingChunks;
+    std::vector<size_t> expectedBuffers(numberOfSequenceNumbers + SequenceNumber::INITIAL);
+    for (SequenceNumber::Underlying sequenceNumber = SequenceNumber::INITIAL;
+         sequenceNumber < numberOfSequenceNumbers + SequenceNumber::INITIAL;
+         ++sequenceNumber)
+    {
+        const auto numberOfChunks = numbers(rd);
+        for (size_t i = 0; i < numberOfChunks; ++i)
+        {
+            const auto numberOfBuffers = numbers(rd);
+            incomingChunks.push_back({SequenceNumber(sequenceNumber), chunk(i), i == numberOfChunks - 1, numberOfBuffers});
+            expectedBuffers[sequenceNumber] += numberOfBuffers;
+        }
+    }
+    /// Shuffling locally keeps the number of sequence numbers in flight around the window, so that sequence numbers use both the ring and
+    /// the fallback map
+    constexpr size_t ShuffleDistance = 64;
+    for (size_t i = 0; i < incomingChunks.size(); i += ShuffleDistance)
+    {
+        std::shuffle(
+            incomingChunks.begin() + static_cast<std::ptrdiff_t>(i),
+            incomingChunks.begin() + static_cast<std::ptrdiff_t>(std::min(i + ShuffleDistance, incomingChunks.size())),
+            rd);
+    }
+
+    ChunkNumberTracker<16> tracker;
+    std::mutex assignmentsMutex;
+    std::vector<std::vector<ChunkNumberTracker<>::Assignment>> assignments(numberOfSequenceNumbers + SequenceNumber::INITIAL);
+    {
+        std::vector<std::jthread> threads;
+        for (size_t thread = 0; thread < numberOfThreads; ++thread)
+        {
+            threads.emplace_back(
+                [&, thread]
+                {
+                    for (size_t i = thread; i < incomingChunks.size(); i += numberOfThreads)
+                    {
+                        const auto assigned = assignBuffers(tracker, incomingChunks[i]);
+                        const std::scoped_lock lock(assignmentsMutex);
+                        auto& assignmentsOfSequence = assignments[incomingChunks[i].sequenceNumber.getRawValue()];
+                        assignmentsOfSequence.insert(assignmentsOfSequence.end(), assigned.begin(), assigned.end());
+                    }
+                });
+        }
+    }
+
+    for (SequenceNumber::Underlying sequenceNumber = SequenceNumber::INITIAL;
+         sequenceNumber < numberOfSequenceNumbers + SequenceNumber::INITIAL;
+         ++sequenceNumber)
+    {
+        auto& assignmentsOfSequence = assignments[sequenceNumber];
+        ASSERT_EQ(assignmentsOfSequence.size(), expectedBuffers[sequenceNumber]);
+        std::ranges::sort(assignmentsOfSequence, {}, &ChunkNumberTracker<>::Assignment::chunkNumber);
+        for (size_t i = 0; i < assignmentsOfSequence.size(); ++i)
+        {
+            EXPECT_EQ(assignmentsOfSequence[i].chunkNumber, chunk(i)) << sequenceNumber;
+            EXPECT_EQ(assignmentsOfSequence[i].isLastChunk, i == assignmentsOfSequence.size() - 1) << sequenceNumber;
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+    ChunkNumberTrackerTest,
+    ConcurrentChunkNumberTrackerTest,
+    ::testing::Combine(::testing::Values(10, 1000, 20000), ::testing::Values(1, 4), ::testing::Values(1, 4, 16)));
+
+}
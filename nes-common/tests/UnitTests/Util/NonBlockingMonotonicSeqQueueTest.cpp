@@ -443,4 +443,49 @@ TEST_F(NonBlockingMonotonicSeqQueueTest, simpleInsertionsWithSingleChunks)
     EXPECT_EQ(watermarkProcessor.getCurrentValue(), sequenceData[3].timestamp.getRawValue());
 }
 
+/// In the steady state, the queue reuses the blocks that the current sequence number left, instead of allocating new ones
+TEST_F(NonBlockingMonotonicSeqQueueTest, sequentialUpdatesReuseRetiredBlocks)
+{
+    constexpr uint64_t blockSize = 100;
+    constexpr uint64_t updates = 100 * blockSize;
+    auto watermarkProcessor = Sequencing::NonBlockingMonotonicSeqQueue<uint64_t, blockSize>();
+    for (auto i = SequenceNumber::INITIAL; i <= updates; i++)
+    {
+        watermarkProcessor.emplace({SequenceNumber(i), INITIAL<ChunkNumber>, true}, i);
+        ASSERT_EQ(watermarkProcessor.getCurrentValue(), i);
+    }
+    EXPECT_LE(watermarkProcessor.getNumberOfAllocatedBlocks(), 3);
+}
+
+/// Concurrent readers keep blocks alive for a while, but must never observe a block that was reused for later sequence numbers
+TEST_F(NonBlockingMonotonicSeqQueueTest, concurrentUpdatesReuseRetiredBlocks)
+{
+    constexpr uint64_t blockSize = 100;
+    constexpr auto updates = 10000;
+    constexpr auto threadsCount = 8;
+    auto watermarkProcessor = Sequencing::NonBlockingMonotonicSeqQueue<uint64_t, blockSize>();
+    std::atomic<uint64_t> nextSequenceNumber = SequenceNumber::INITIAL;
+    std::vector<std::thread> threads;
+    threads.reserve(threadsCount);
+    for (int threadId = 0; threadId < threadsCount; threadId++)
+    {
+        threads.emplace_back(
+            [&watermarkProcessor, &nextSequenceNumber]()
+            {
+                for (auto i = 0; i < updates; i++)
+                {
+                    const auto sequenceNumber = nextSequenceNumber++;
+                    watermarkProcessor.emplace({SequenceNumber(sequenceNumber), INITIAL<ChunkNumber>, true}, sequenceNumber);
+                    ASSERT_LT(watermarkProcessor.getCurrentValue(), nextSequenceNumber.load());
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(watermarkProcessor.getCurrentValue(), uint64_t{updates} * threadsCount);
+    EXPECT_LT(watermarkProcessor.getNumberOfAllocatedBlocks(), uint64_t{updates} * threadsCount / blockSize);
+}
+
 }
@@ -40,6 +40,16 @@ protected:
     }
 };
 
+TEST_F(RollingAverageTest, EmptyAverageIsZero)
+{
+    RollingAverage<uint64_t> rollingAvg(3);
+    EXPECT_TRUE(rollingAvg.empty());
+    EXPECT_EQ(rollingAvg.getAverage(), 0);
+    rollingAvg.add(4);
+    EXPECT_FALSE(rollingAvg.empty());
+    EXPECT_EQ(rollingAvg.getAverage(), 4);
+}
+
 TEST_F(RollingAverageTest, BasicTest)
 {
     const std::vector inputs = {1, 2, 3, 4, 5};
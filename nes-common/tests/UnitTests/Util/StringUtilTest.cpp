@@ -12,6 +12,7 @@
     limitations under the License.
 */
 #include <cmath>
+#include <cstddef>
 #include <limits>
 #include <optional>
 #include <string>
@@ -627,4 +628,20 @@ TEST(SplitStringViewTest, MultipleSplitsIncludingLineBreak)
     EXPECT_EQ(result[6], "string");
 }
 
+TEST(ParseIdListTest, SingleIdsAndRanges)
+{
+    EXPECT_EQ(parseIdList("0-3,8,10-11"), (std::vector<size_t>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(parseIdList("5"), (std::vector<size_t>{5}));
+    EXPECT_EQ(parseIdList("2-2\n"), (std::vector<size_t>{2}));
+    EXPECT_EQ(parseIdList(""), (std::vector<size_t>{}));
+}
+
+TEST(ParseIdListTest, MalformedLists)
+{
+    EXPECT_EQ(parseIdList("a"), std::nullopt);
+    EXPECT_EQ(parseIdList("1,-3"), std::nullopt);
+    EXPECT_EQ(parseIdList("4-2"), std::nullopt);
+    EXPECT_EQ(parseIdList("1-"), std::nullopt);
+}
+
 }
@@ -14,6 +14,9 @@
 
 #include <Thread.hpp>
 
+#include <cstddef>
+#include <vector>
+#include <sched.h>
 #include <gtest/gtest.h>
 
 namespace NES
@@ -45,4 +48,28 @@ TEST(ThreadTest, BasicNaming)
                 });
         });
 }
+
+TEST(ThreadTest, PinThisThread)
+{
+    Thread t(
+        "TestThread",
+        []()
+        {
+            const auto cpu = sched_getcpu();
+            ASSERT_GE(cpu, 0);
+            ASSERT_TRUE(Thread::pinThisThread({static_cast<size_t>(cpu)}));
+            EXPECT_EQ(sched_getcpu(), cpu);
+
+            cpu_set_t cpuSet;
+            ASSERT_EQ(sched_getaffinity(0, sizeof(cpuSet), &cpuSet), 0);
+            EXPECT_EQ(CPU_COUNT(&cpuSet), 1);
+
+            Thread inner("Test-Inner-Thread", [cpu]() { EXPECT_EQ(sched_getcpu(), cpu); });
+        });
+}
+
+TEST(ThreadTest, PinThisThreadToNoCpus)
+{
+    Thread t("TestThread", []() { EXPECT_TRUE(Thread::pinThisThread({})); });
+}
 }
@@ -45,6 +45,12 @@ struct DataType final
         CHAR,
         UNDEFINED,
         VARSIZED,
+        /// Milliseconds since the unix epoch (UTC), stored like a UINT64
+        TIMESTAMP,
+        /// Signed duration in milliseconds, stored like an INT64
+        INTERVAL,
+        /// Fixed-point number with a precision and a scale, stored as an INT64 of the value multiplied by 10^scale
+        DECIMAL,
     };
 
     enum class NULLABLE : uint8_t
@@ -53,7 +59,9 @@ struct DataType final
         NOT_NULLABLE
     };
 
+    /// A DECIMAL without precision and scale is a DECIMAL(18, 0)
     DataType(Type type, NULLABLE nullable);
+    DataType(Type type, NULLABLE nullable, uint8_t precision, uint8_t scale);
     DataType();
 
     template <class T>
@@ -131,9 +139,14 @@ struct DataType final
     [[nodiscard]] bool isSignedInteger() const;
     [[nodiscard]] bool isFloat() const;
     [[nodiscard]] bool isNumeric() const;
+    [[nodiscard]] bool isTemporal() const;
+    [[nodiscard]] bool isDecimal() const;
 
     Type type;
     bool nullable;
+    /// The number of (fractional) digits of a DECIMAL. Both are zero for all other types.
+    uint8_t precision = 0;
+    uint8_t scale = 0;
 };
 
 template <>
@@ -155,7 +168,8 @@ struct std::hash<NES::DataType>
 {
     size_t operator()(const NES::DataType& dataType) const noexcept
     {
-        return (static_cast<uint16_t>(dataType.type) << 8) | static_cast<uint8_t>(dataType.nullable);
+        return (static_cast<size_t>(dataType.scale) << 24) | (static_cast<size_t>(dataType.precision) << 16)
+            | (static_cast<uint16_t>(dataType.type) << 8) | static_cast<uint8_t>(dataType.nullable);
     }
 };
 
@@ -13,6 +13,7 @@
 */
 #pragma once
 
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <DataTypes/DataType.hpp>
@@ -30,5 +31,7 @@ DataType provideDataType(const std::string& type);
 DataType provideDataType(const std::string& type, DataType::NULLABLE isNullable);
 DataType provideDataType(DataType::Type type);
 DataType provideDataType(DataType::Type type, DataType::NULLABLE isNullable);
+/// Throws an UnknownDataType, if the precision exceeds Decimal::MAX_PRECISION or the scale exceeds the precision
+DataType provideDecimalDataType(uint8_t precision, uint8_t scale, DataType::NULLABLE isNullable);
 
 }
@@ -0,0 +1,56 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/// A DECIMAL(precision, scale) stores the value multiplied by 10^scale as an int64, e.g., 12.34 in a DECIMAL(10, 2) is stored as 1234.
+/// Thus, sums and comparisons of decimals with the same scale are plain integer operations.
+namespace NES::Decimal
+{
+
+/// The largest precision, whose values all fit into an int64
+static constexpr uint8_t MAX_PRECISION = 18;
+
+static constexpr auto POWERS_OF_TEN = []
+{
+    std::array<int64_t, MAX_PRECISION + 1> powers{1};
+    for (size_t exponent = 1; exponent < powers.size(); ++exponent)
+    {
+        powers[exponent] = powers[exponent - 1] * 10;
+    }
+    return powers;
+}();
+
+/// Returns 10^exponent for exponents up to MAX_PRECISION
+constexpr int64_t powerOfTen(const uint8_t exponent)
+{
+    return POWERS_OF_TEN.at(exponent);
+}
+
+/// Parses a decimal number, e.g., -12.345, into its unscaled value. Additional fractional digits are rounded half away from zero.
+/// Returns nullopt if the text is not a number or if the number does not fit into the precision.
+std::optional<int64_t> parse(std::string_view text, uint8_t precision, uint8_t scale);
+
+/// Appends the unscaled value with exactly 'scale' fractional digits to 'output' without allocating (besides growing 'output')
+void appendFormatted(std::string& output, int64_t unscaledValue, uint8_t scale);
+std::string format(int64_t unscaledValue, uint8_t scale);
+
+}
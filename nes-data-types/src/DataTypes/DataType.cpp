@@ -13,13 +13,16 @@
 */
 #include <DataTypes/DataType.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <optional>
 #include <ostream>
 #include <string>
+#include <tuple>
 #include <utility>
 
 #include <DataTypes/DataTypeProvider.hpp>
+#include <DataTypes/Decimal.hpp>
 #include <Util/Logger/Logger.hpp>
 #include <Util/Reflection.hpp>
 #include <Util/Strings.hpp>
@@ -118,15 +121,54 @@ std::optional<NES::DataType> inferNumericDataType(const NES::DataType& left, con
 
     return {};
 }
+
+/// Combining a timestamp with an interval or an integer (in milliseconds) yields a timestamp, while combining an interval with an
+/// interval or an integer yields an interval. The difference of two timestamps stays a timestamp, as its physical value is unsigned.
+std::optional<NES::DataType> inferTemporalDataType(const NES::DataType& left, const NES::DataType& right)
+{
+    const auto isNullable = left.nullable or right.nullable ? NES::DataType::NULLABLE::IS_NULLABLE : NES::DataType::NULLABLE::NOT_NULLABLE;
+    if (not(left.isTemporal() or left.isInteger()) or not(right.isTemporal() or right.isInteger()))
+    {
+        return {};
+    }
+    if (left.isType(NES::DataType::Type::TIMESTAMP) or right.isType(NES::DataType::Type::TIMESTAMP))
+    {
+        return NES::DataTypeProvider::provideDataType(NES::DataType::Type::TIMESTAMP, isNullable);
+    }
+    return NES::DataTypeProvider::provideDataType(NES::DataType::Type::INTERVAL, isNullable);
+}
+
+/// Combining a decimal with a decimal or an integer yields a decimal with the larger scale, while combining it with a float yields a
+/// FLOAT64. Results use the maximal precision, as sums and products of decimals quickly exceed the precision of their operands.
+std::optional<NES::DataType> inferDecimalDataType(const NES::DataType& left, const NES::DataType& right)
+{
+    const auto isNullable = left.nullable or right.nullable ? NES::DataType::NULLABLE::IS_NULLABLE : NES::DataType::NULLABLE::NOT_NULLABLE;
+    if (not(left.isDecimal() or left.isNumeric()) or not(right.isDecimal() or right.isNumeric()))
+    {
+        return {};
+    }
+    if (left.isFloat() or right.isFloat())
+    {
+        return NES::DataTypeProvider::provideDataType(NES::DataType::Type::FLOAT64, isNullable);
+    }
+    return NES::DataTypeProvider::provideDecimalDataType(NES::Decimal::MAX_PRECISION, std::max(left.scale, right.scale), isNullable);
+}
 }
 
 namespace NES
 {
 
-DataType::DataType(const Type type, const NULLABLE nullable) : type(type), nullable(nullable == NULLABLE::IS_NULLABLE)
+DataType::DataType(const Type type, const NULLABLE nullable)
+    : type(type), nullable(nullable == NULLABLE::IS_NULLABLE), precision(type == Type::DECIMAL ? Decimal::MAX_PRECISION : 0)
 {
 }
 
+DataType::DataType(const Type type, const NULLABLE nullable, const uint8_t precision, const uint8_t scale)
+    : type(type), nullable(nullable == NULLABLE::IS_NULLABLE), precision(precision), scale(scale)
+{
+    PRECONDITION(type == Type::DECIMAL or (precision == 0 and scale == 0), "Only a DECIMAL has a precision and a scale");
+}
+
 DataType::DataType() : type(Type::UNDEFINED), nullable(true)
 {
 }
@@ -149,12 +191,15 @@ uint32_t DataType::getSizeInBytesWithoutNull() const
         case Type::FLOAT32:
             return 4;
         case Type::VARSIZED:
-            /// Returning '16' for VARSIZED, because we store 'uint64_t' 8-byte data that represent how to access the data, c.f., @class VariableSizedAccess
-            /// and 8 bytes for the size of the VARSIZED
+            /// Returning '16' for VARSIZED, because we store the size, the prefix, the child index and the offset of the data
+            /// (or the inlined data), c.f., @class VariableSizedAccess
             return 16;
         case Type::INT64:
         case Type::UINT64:
         case Type::FLOAT64:
+        case Type::TIMESTAMP:
+        case Type::INTERVAL:
+        case Type::DECIMAL:
             return 8;
         case Type::UNDEFINED:
             return 0;
@@ -189,7 +234,12 @@ std::string DataType::formattedBytesToString(const void* data) const
         case Type::INT64:
             return std::to_string(*static_cast<const int64_t*>(data));
         case Type::UINT64:
+        case Type::TIMESTAMP:
             return std::to_string(*static_cast<const uint64_t*>(data));
+        case Type::INTERVAL:
+            return std::to_string(*static_cast<const int64_t*>(data));
+        case Type::DECIMAL:
+            return Decimal::format(*static_cast<const int64_t*>(data), scale);
         case Type::FLOAT32:
             return formatFloat(*static_cast<const float*>(data));
         case Type::FLOAT64:
@@ -278,6 +328,21 @@ DataTypeRegistryReturnType DataTypeGeneratedRegistrar::RegisterUINT64DataType(co
     return DataType{DataType::Type::UINT64, args.nullable};
 }
 
+DataTypeRegistryReturnType DataTypeGeneratedRegistrar::RegisterTIMESTAMPDataType(const DataTypeRegistryArguments args)
+{
+    return DataType{DataType::Type::TIMESTAMP, args.nullable};
+}
+
+DataTypeRegistryReturnType DataTypeGeneratedRegistrar::RegisterINTERVALDataType(const DataTypeRegistryArguments args)
+{
+    return DataType{DataType::Type::INTERVAL, args.nullable};
+}
+
+DataTypeRegistryReturnType DataTypeGeneratedRegistrar::RegisterDECIMALDataType(const DataTypeRegistryArguments args)
+{
+    return DataType{DataType::Type::DECIMAL, args.nullable};
+}
+
 DataTypeRegistryReturnType DataTypeGeneratedRegistrar::RegisterUNDEFINEDDataType(const DataTypeRegistryArguments args)
 {
     return DataType{DataType::Type::UNDEFINED, args.nullable};
@@ -309,6 +374,16 @@ bool DataType::isNumeric() const
     return isInteger() or isFloat();
 }
 
+bool DataType::isTemporal() const
+{
+    return this->type == Type::TIMESTAMP or this->type == Type::INTERVAL;
+}
+
+bool DataType::isDecimal() const
+{
+    return this->type == Type::DECIMAL;
+}
+
 DataType::NULLABLE DataType::joinNullable(const DataType& otherDataType) const
 {
     const auto isNullableResult
@@ -329,6 +404,34 @@ std::optional<DataType> DataType::join(const DataType& otherDataType) const
                                                       : std::nullopt;
     }
 
+    if (this->isDecimal() or (this->isNumeric() and otherDataType.isDecimal()))
+    {
+        if (otherDataType.type == Type::UNDEFINED)
+        {
+            return {DataType{}};
+        }
+        if (const auto newDataType = inferDecimalDataType(*this, otherDataType); newDataType.has_value())
+        {
+            return newDataType;
+        }
+        NES_WARNING("Cannot join {} and {}", *this, otherDataType);
+        return std::nullopt;
+    }
+
+    if (this->isTemporal() or (this->isNumeric() and otherDataType.isTemporal()))
+    {
+        if (otherDataType.type == Type::UNDEFINED)
+        {
+            return {DataType{}};
+        }
+        if (const auto newDataType = inferTemporalDataType(*this, otherDataType); newDataType.has_value())
+        {
+            return newDataType;
+        }
+        NES_WARNING("Cannot join {} and {}", *this, otherDataType);
+        return std::nullopt;
+    }
+
     if (this->isNumeric())
     {
         if (otherDataType.type == Type::UNDEFINED)
@@ -371,17 +474,26 @@ std::optional<DataType> DataType::join(const DataType& otherDataType) const
 
 Reflected Reflector<DataType>::operator()(const DataType& field) const
 {
-    return reflect(std::make_pair(field.type, field.nullable));
+    return reflect(std::make_tuple(field.type, field.nullable, field.precision, field.scale));
 }
 
 DataType Unreflector<DataType>::operator()(const Reflected& rfl) const
 {
-    const auto [type, nullable] = unreflect<std::pair<DataType::Type, bool>>(rfl);
-    return DataTypeProvider::provideDataType(type, nullable ? DataType::NULLABLE::IS_NULLABLE : DataType::NULLABLE::NOT_NULLABLE);
+    const auto [type, nullable, precision, scale] = unreflect<std::tuple<DataType::Type, bool, uint8_t, uint8_t>>(rfl);
+    const auto isNullable = nullable ? DataType::NULLABLE::IS_NULLABLE : DataType::NULLABLE::NOT_NULLABLE;
+    if (type == DataType::Type::DECIMAL)
+    {
+        return DataTypeProvider::provideDecimalDataType(precision, scale, isNullable);
+    }
+    return DataTypeProvider::provideDataType(type, isNullable);
 }
 
 std::ostream& operator<<(std::ostream& os, const DataType& dataType)
 {
+    if (dataType.isDecimal())
+    {
+        return os << fmt::format("DataType(type: DECIMAL({}, {}) nullable: {})", dataType.precision, dataType.scale, dataType.nullable);
+    }
     return os << fmt::format("DataType(type: {} nullable: {})", magic_enum::enum_name(dataType.type), dataType.nullable);
 }
 
@@ -14,9 +14,11 @@
 
 #include <DataTypes/DataTypeProvider.hpp>
 
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <DataTypes/DataType.hpp>
+#include <DataTypes/Decimal.hpp>
 #include <magic_enum/magic_enum.hpp>
 #include <DataTypeRegistry.hpp>
 #include <ErrorHandling.hpp>
@@ -66,4 +68,17 @@ DataType provideDataType(const DataType::Type type, const DataType::NULLABLE isN
     return provideDataType(typeAsString, isNullable);
 }
 
+DataType provideDecimalDataType(const uint8_t precision, const uint8_t scale, const DataType::NULLABLE isNullable)
+{
+    if (precision == 0 or precision > Decimal::MAX_PRECISION or scale > precision)
+    {
+        throw UnknownDataType(
+            "DECIMAL({}, {}) requires a precision between 1 and {} and a scale of at most the precision",
+            precision,
+            scale,
+            Decimal::MAX_PRECISION);
+    }
+    return DataType{DataType::Type::DECIMAL, isNullable, precision, scale};
+}
+
 }
@@ -0,0 +1,123 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <DataTypes/Decimal.hpp>
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <ErrorHandling.hpp>
+
+namespace NES::Decimal
+{
+
+std::optional<int64_t> parse(std::string_view text, const uint8_t precision, const uint8_t scale)
+{
+    PRECONDITION(scale <= precision and precision <= MAX_PRECISION, "Invalid decimal precision {} and scale {}", precision, scale);
+    const bool isNegative = text.starts_with('-');
+    if (isNegative or text.starts_with('+'))
+    {
+        text.remove_prefix(1);
+    }
+    const auto decimalPoint = text.find('.');
+    const auto integerDigits = text.substr(0, decimalPoint);
+    const auto fractionalDigits = decimalPoint == std::string_view::npos ? std::string_view{} : text.substr(decimalPoint + 1);
+    if (integerDigits.empty() and fractionalDigits.empty())
+    {
+        return std::nullopt;
+    }
+
+    /// Accumulating at most 'precision' (<= 18) digits cannot overflow, thus we only need to check the number of significant digits
+    uint64_t unscaledValue = 0;
+    size_t significantDigits = 0;
+    const auto appendDigit = [&](const char digit)
+    {
+        unscaledValue = (unscaledValue * 10) + static_cast<uint64_t>(digit - '0');
+        significantDigits += static_cast<size_t>(unscaledValue != 0);
+        return significantDigits <= precision;
+    };
+    for (const char digit : integerDigits)
+    {
+        if (digit < '0' or digit > '9' or not appendDigit(digit))
+        {
+            return std::nullopt;
+        }
+    }
+    for (size_t position = 0; position < fractionalDigits.size(); ++position)
+    {
+        const char digit = fractionalDigits[position];
+        if (digit < '0' or digit > '9')
+        {
+            return std::nullopt;
+        }
+        if (position == scale)
+        {
+            unscaledValue += static_cast<uint64_t>(digit >= '5');
+        }
+        else if (position < scale and not appendDigit(digit))
+        {
+            return std::nullopt;
+        }
+    }
+    for (size_t position = fractionalDigits.size(); position < scale; ++position)
+    {
+        if (not appendDigit('0'))
+        {
+            return std::nullopt;
+        }
+    }
+    /// Rounding up may carry into an additional digit, e.g., 9.996 in a DECIMAL(3, 2)
+    if (unscaledValue >= static_cast<uint64_t>(powerOfTen(precision)))
+    {
+        return std::nullopt;
+    }
+    const auto value = static_cast<int64_t>(unscaledValue);
+    return isNegative ? -value : value;
+}
+
+void appendFormatted(std::string& output, const int64_t unscaledValue, const uint8_t scale)
+{
+    PRECONDITION(scale <= MAX_PRECISION, "Invalid decimal scale {}", scale);
+    /// The magnitude of the smallest int64 does not fit into an int64, thus we compute the digits on the unsigned magnitude
+    const uint64_t magnitude = unscaledValue < 0 ? 0 - static_cast<uint64_t>(unscaledValue) : static_cast<uint64_t>(unscaledValue);
+    const auto divisor = static_cast<uint64_t>(powerOfTen(scale));
+    std::array<char, std::numeric_limits<uint64_t>::digits10 + 1> digits{};
+    if (unscaledValue < 0)
+    {
+        output += '-';
+    }
+    const auto integerEnd = std::to_chars(digits.data(), digits.data() + digits.size(), magnitude / divisor).ptr;
+    output.append(digits.data(), integerEnd);
+    if (scale > 0)
+    {
+        const auto fractionEnd = std::to_chars(digits.data(), digits.data() + digits.size(), magnitude % divisor).ptr;
+        output += '.';
+        output.append(scale - static_cast<size_t>(fractionEnd - digits.data()), '0');
+        output.append(digits.data(), fractionEnd);
+    }
+}
+
+std::string format(const int64_t unscaledValue, const uint8_t scale)
+{
+    std::string formatted;
+    appendFormatted(formatted, unscaledValue, scale);
+    return formatted;
+}
+
+}
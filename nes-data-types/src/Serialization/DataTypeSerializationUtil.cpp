@@ -14,8 +14,11 @@
 
 #include <Serialization/DataTypeSerializationUtil.hpp>
 
+#include <cstdint>
 #include <type_traits>
 #include <DataTypes/DataType.hpp>
+#include <DataTypes/DataTypeProvider.hpp>
+#include <DataTypes/Decimal.hpp>
 #include <magic_enum/magic_enum.hpp>
 #include <ErrorHandling.hpp>
 #include <SerializableDataType.pb.h>
@@ -29,6 +32,8 @@ SerializableDataType* DataTypeSerializationUtil::serializeDataType(const DataTyp
     SerializableDataType_Type_Parse(magic_enum::enum_name(dataType.type), &serializedPhysicalTypeEnum);
     serializedDataType->set_type(serializedPhysicalTypeEnum);
     serializedDataType->set_nullable(dataType.nullable);
+    serializedDataType->set_precision(dataType.precision);
+    serializedDataType->set_scale(dataType.scale);
     return serializedDataType;
 }
 
@@ -47,8 +52,17 @@ DataType DataTypeSerializationUtil::deserializeDataType(const SerializableDataTy
             static_cast<std::underlying_type_t<DataType::Type>>(serializedDataType.type()),
             magic_enum::enum_values<DataType::Type>().size());
     }
-    const DataType deserializedDataType
-        = DataType{*type, serializedDataType.nullable() ? DataType::NULLABLE::IS_NULLABLE : DataType::NULLABLE::NOT_NULLABLE};
+    const auto isNullable = serializedDataType.nullable() ? DataType::NULLABLE::IS_NULLABLE : DataType::NULLABLE::NOT_NULLABLE;
+    if (*type == DataType::Type::DECIMAL)
+    {
+        if (serializedDataType.precision() > Decimal::MAX_PRECISION or serializedDataType.scale() > serializedDataType.precision())
+        {
+            throw CannotDeserialize("Invalid DECIMAL({}, {})", serializedDataType.precision(), serializedDataType.scale());
+        }
+        return DataTypeProvider::provideDecimalDataType(
+            static_cast<uint8_t>(serializedDataType.precision()), static_cast<uint8_t>(serializedDataType.scale()), isNullable);
+    }
+    const DataType deserializedDataType = DataType{*type, isNullable};
     return deserializedDataType;
 }
 
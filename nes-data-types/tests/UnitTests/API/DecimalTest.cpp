@@ -0,0 +1,116 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <DataTypes/Decimal.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/DataTypeProvider.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+namespace NES
+{
+
+class DecimalTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite() { Logger::setupLogging("DecimalTest.log", LogLevel::LOG_DEBUG); }
+};
+
+TEST_F(DecimalTest, Parse)
+{
+    EXPECT_EQ(Decimal::parse("12.34", 10, 2), 1234);
+    EXPECT_EQ(Decimal::parse("-12.34", 10, 2), -1234);
+    EXPECT_EQ(Decimal::parse("+12", 10, 2), 1200);
+    EXPECT_EQ(Decimal::parse("12.3", 10, 2), 1230);
+    EXPECT_EQ(Decimal::parse(".5", 10, 2), 50);
+    EXPECT_EQ(Decimal::parse("0", 1, 0), 0);
+    EXPECT_EQ(Decimal::parse("999999999999999999", 18, 0), 999999999999999999);
+    EXPECT_EQ(Decimal::parse("-0.000000000000000001", 18, 18), -1);
+
+    EXPECT_EQ(Decimal::parse("", 10, 2), std::nullopt);
+    EXPECT_EQ(Decimal::parse("-", 10, 2), std::nullopt);
+    EXPECT_EQ(Decimal::parse("1.2.3", 10, 2), std::nullopt);
+    EXPECT_EQ(Decimal::parse("1e3", 10, 2), std::nullopt);
+    EXPECT_EQ(Decimal::parse(" 1", 10, 2), std::nullopt);
+}
+
+TEST_F(DecimalTest, ParseRoundsHalfAwayFromZero)
+{
+    EXPECT_EQ(Decimal::parse("1.005", 10, 2), 101);
+    EXPECT_EQ(Decimal::parse("1.00499", 10, 2), 100);
+    EXPECT_EQ(Decimal::parse("-1.005", 10, 2), -101);
+    EXPECT_EQ(Decimal::parse("0.5", 10, 0), 1);
+}
+
+TEST_F(DecimalTest, ParseChecksPrecision)
+{
+    EXPECT_EQ(Decimal::parse("99999999.99", 10, 2), 9999999999);
+    EXPECT_EQ(Decimal::parse("100000000", 10, 2), std::nullopt);
+    EXPECT_EQ(Decimal::parse("0001.50", 3, 2), 150);
+    /// Rounding carries into an additional digit
+    EXPECT_EQ(Decimal::parse("9.996", 3, 2), std::nullopt);
+    EXPECT_EQ(Decimal::parse("1000000000000000000", 18, 0), std::nullopt);
+}
+
+TEST_F(DecimalTest, Format)
+{
+    EXPECT_EQ(Decimal::format(1234, 2), "12.34");
+    EXPECT_EQ(Decimal::format(-1234, 2), "-12.34");
+    EXPECT_EQ(Decimal::format(5, 3), "0.005");
+    EXPECT_EQ(Decimal::format(-5, 3), "-0.005");
+    EXPECT_EQ(Decimal::format(42, 0), "42");
+    EXPECT_EQ(Decimal::format(std::numeric_limits<int64_t>::min(), 18), "-9.223372036854775808");
+    for (const int64_t value : {0, 1, -1, 100, 123456789, -987654321})
+    {
+        EXPECT_EQ(Decimal::parse(Decimal::format(value, 4), 18, 4), value);
+    }
+}
+
+TEST_F(DecimalTest, DataType)
+{
+    const auto decimal = DataTypeProvider::provideDecimalDataType(10, 2, DataType::NULLABLE::NOT_NULLABLE);
+    EXPECT_EQ(decimal.getSizeInBytesWithoutNull(), sizeof(int64_t));
+    EXPECT_NE(decimal, DataTypeProvider::provideDecimalDataType(10, 3, DataType::NULLABLE::NOT_NULLABLE));
+    /// A DECIMAL without precision and scale is a DECIMAL(18, 0)
+    const auto defaultDecimal = DataTypeProvider::provideDecimalDataType(18, 0, DataType::NULLABLE::NOT_NULLABLE);
+    EXPECT_EQ(DataTypeProvider::provideDataType("DECIMAL"), defaultDecimal);
+    EXPECT_ANY_THROW(DataTypeProvider::provideDecimalDataType(19, 2, DataType::NULLABLE::NOT_NULLABLE));
+    EXPECT_ANY_THROW(DataTypeProvider::provideDecimalDataType(2, 3, DataType::NULLABLE::NOT_NULLABLE));
+
+    const int64_t value = -1234;
+    EXPECT_EQ(decimal.formattedBytesToString(&value), "-12.34");
+}
+
+TEST_F(DecimalTest, Join)
+{
+    const auto decimal = DataTypeProvider::provideDecimalDataType(10, 2, DataType::NULLABLE::NOT_NULLABLE);
+    const auto otherDecimal = DataTypeProvider::provideDecimalDataType(6, 4, DataType::NULLABLE::IS_NULLABLE);
+    const auto integer = DataTypeProvider::provideDataType(DataType::Type::INT32);
+    const auto floatingPoint = DataTypeProvider::provideDataType(DataType::Type::FLOAT32);
+
+    constexpr auto precision = Decimal::MAX_PRECISION;
+    EXPECT_EQ(decimal.join(otherDecimal), DataTypeProvider::provideDecimalDataType(precision, 4, DataType::NULLABLE::IS_NULLABLE));
+    EXPECT_EQ(decimal.join(integer), DataTypeProvider::provideDecimalDataType(precision, 2, DataType::NULLABLE::NOT_NULLABLE));
+    EXPECT_EQ(integer.join(decimal), decimal.join(integer));
+    EXPECT_EQ(decimal.join(floatingPoint), DataTypeProvider::provideDataType(DataType::Type::FLOAT64));
+    EXPECT_EQ(decimal.join(DataTypeProvider::provideDataType(DataType::Type::VARSIZED)), std::nullopt);
+}
+
+}
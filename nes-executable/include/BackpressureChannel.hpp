@@ -14,9 +14,11 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <stop_token>
 #include <utility>
+#include <vector>
 
 struct Channel;
 class BackpressureListener;
@@ -29,6 +31,10 @@ class BackpressureController;
 /// connected BackpressureListeners that are still alive and in use will report an assertion failure.
 std::pair<BackpressureController, BackpressureListener> createBackpressureChannel();
 
+/// Time during which the backpressure channels of this process had backpressure applied, summed up over all channels.
+/// Channels that currently have backpressure applied only contribute once their pressure is released.
+std::chrono::nanoseconds getTotalBackpressureTime();
+
 /// A Backpressure Controller is the exclusive controller of a backpressure channel. It allows the user to apply and release backpressure, which blocks
 /// or unblocks all connected Ingestions.
 class BackpressureController
@@ -59,11 +65,20 @@ public:
 /// the thread will be notified via the condition_variable in the channel.
 class BackpressureListener
 {
-    explicit BackpressureListener(std::shared_ptr<Channel> channel) : channel(std::move(channel)) { }
+    explicit BackpressureListener(std::shared_ptr<Channel> channel) : channels{std::move(channel)} { }
+    explicit BackpressureListener(std::vector<std::shared_ptr<Channel>> channels) : channels(std::move(channels)) { }
 
     friend std::pair<BackpressureController, BackpressureListener> createBackpressureChannel();
-    std::shared_ptr<Channel> channel;
+    std::vector<std::shared_ptr<Channel>> channels;
 
 public:
     void wait(const std::stop_token& stopToken) const;
+
+    /// Non-blocking alternative to `wait` for sources that share a thread with other sources (see SourceRunner).
+    /// Returns true, if any of the channels has backpressure applied.
+    [[nodiscard]] bool hasBackpressure() const;
+
+    /// Returns a listener, which only allows further progress if none of the channels of both listeners has backpressure applied.
+    /// This allows throttling the sources of a query by multiple controllers, e.g., by the sink and by the memory quota of the query.
+    [[nodiscard]] BackpressureListener combine(const BackpressureListener& other) const;
 };
@@ -14,7 +14,10 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <variant>
 #include <vector>
 #include <Identifiers/Identifiers.hpp>
@@ -35,6 +38,14 @@ struct ExecutablePipeline
     std::vector<std::weak_ptr<ExecutablePipeline>> successors;
 };
 
+/// The QueryEngine admits the tasks of concurrent queries in proportion to the weights of their priorities (see TaskQueue)
+enum class QueryPriority : uint8_t
+{
+    Low,
+    Normal,
+    High
+};
+
 struct CompiledQueryPlan
 {
     struct Source
@@ -47,6 +58,8 @@ struct CompiledQueryPlan
 
         /// Sources do not have any predecessors
         std::vector<std::weak_ptr<ExecutablePipeline>> successors;
+        /// The fields that the successors read, or empty, if they read all fields (see SourceRegistryArguments::projections)
+        std::vector<std::string> projections;
     };
 
     struct Sink
@@ -67,5 +80,8 @@ struct CompiledQueryPlan
     std::vector<std::shared_ptr<ExecutablePipeline>> pipelines;
     std::vector<Sink> sinks;
     std::vector<Source> sources;
+    /// Maximum number of bytes of buffers that the query should hold, before its sources are throttled. 0 disables the quota.
+    size_t memoryQuotaInBytes = 0;
+    QueryPriority priority = QueryPriority::Normal;
 };
 }
@@ -17,6 +17,7 @@
 #include <cstdint>
 #include <memory>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 #include <Identifiers/Identifiers.hpp>
 #include <Runtime/AbstractBufferProvider.hpp>
@@ -39,13 +40,14 @@ public:
     virtual ~PipelineExecutionContext() = default;
 
     /// Returns success, if the buffer was emitted successfully.
-    bool emitBuffer(const TupleBuffer& buffer) { return emitBuffer(buffer, ContinuationPolicy::POSSIBLE); };
+    bool emitBuffer(TupleBuffer buffer) { return emitBuffer(std::move(buffer), ContinuationPolicy::POSSIBLE); };
 
     /// Please be aware of how you are setting the continuation policy, as this will/can lead to deadlocks and no progress in our system.
     /// We advise to use ContinuationPolicy::POSSIBLE, as this will ensure no deadlock arising.
     /// Returns success, if the buffer was emitted successfully.
-
-    virtual bool emitBuffer(const TupleBuffer&, ContinuationPolicy) = 0;
+    /// Moving the buffer into the call passes its ownership on, which spares the reference counting of a copy, unless the pipeline
+    /// has several successors that share the buffer.
+    virtual bool emitBuffer(TupleBuffer, ContinuationPolicy) = 0;
 
     /// This method can only be called once per pipeline execution! The Pipeline should immediately finish its execution as the exact same task could be executed
     /// immediately.
@@ -58,6 +60,11 @@ public:
     [[nodiscard]] virtual uint64_t getNumberOfWorkerThreads() const = 0;
     [[nodiscard]] virtual std::shared_ptr<AbstractBufferProvider> getBufferManager() const = 0;
     [[nodiscard]] virtual PipelineId getPipelineId() const = 0;
+    /// Approximate number of tasks that wait for a worker thread, which indicates whether the successors of the pipeline fall behind.
+    /// Returns 0 if the context does not know the task queue.
+    [[nodiscard]] virtual uint64_t getNumberOfQueuedTasks() const { return 0; }
+    /// Number of tasks that were submitted to the pipeline so far, including the current task. Returns 0 if the context does not know it.
+    [[nodiscard]] virtual uint64_t getNumberOfSubmittedTasks() const { return 0; }
 
     /// TODO #30 Remove OperatorHandler from the pipeline execution context
     virtual std::unordered_map<OperatorHandlerId, std::shared_ptr<OperatorHandler>>& getOperatorHandlers() = 0;
@@ -14,6 +14,8 @@
 
 #include <BackpressureChannel.hpp>
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstddef>
 #include <cstdint>
@@ -21,6 +23,7 @@
 #include <mutex>
 #include <stop_token>
 #include <utility>
+#include <vector>
 
 #include <folly/Synchronized.h>
 
@@ -39,8 +42,22 @@ struct Channel
 
     folly::Synchronized<State, std::mutex> stateMtx{OPEN};
     std::condition_variable_any change;
+    /// Guarded by stateMtx, only valid while the channel is closed
+    std::chrono::steady_clock::time_point closedSince;
 };
 
+namespace
+{
+/// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) process-wide statistic, which outlives all channels
+std::atomic<int64_t> totalBackpressureTimeInNs{0};
+
+void recordBackpressure(const Channel& channel)
+{
+    const auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - channel.closedSince);
+    totalBackpressureTimeInNs.fetch_add(duration.count(), std::memory_order_relaxed);
+}
+}
+
 BackpressureController::BackpressureController(std::shared_ptr<Channel> channel) : channel{std::move(channel)}
 {
 }
@@ -49,21 +66,41 @@ BackpressureController::~BackpressureController()
 {
     if (channel)
     {
-        *channel->stateMtx.lock() = Channel::DESTROYED;
+        {
+            auto state = channel->stateMtx.lock();
+            if (std::exchange(*state, Channel::DESTROYED) == Channel::CLOSED)
+            {
+                recordBackpressure(*channel);
+            }
+        }
         channel->change.notify_all();
     }
 }
 
 bool BackpressureController::applyPressure()
 {
-    const auto old = std::exchange(*channel->stateMtx.lock(), Channel::CLOSED);
+    auto state = channel->stateMtx.lock();
+    const auto old = std::exchange(*state, Channel::CLOSED);
     INVARIANT(old != Channel::DESTROYED, "The backpressureController is still alive thus the channel should not have been destroyed");
+    if (old == Channel::OPEN)
+    {
+        channel->closedSince = std::chrono::steady_clock::now();
+    }
     return old == Channel::OPEN;
 }
 
 bool BackpressureController::releasePressure()
 {
-    const auto old = std::exchange(*channel->stateMtx.lock(), Channel::OPEN);
+    const auto old = [this]
+    {
+        auto state = channel->stateMtx.lock();
+        const auto previous = std::exchange(*state, Channel::OPEN);
+        if (previous == Channel::CLOSED)
+        {
+            recordBackpressure(*channel);
+        }
+        return previous;
+    }();
     INVARIANT(old != Channel::DESTROYED, "The Backpressure Controller is still alive thus the channel should not have been destroyed");
     if (old == Channel::CLOSED)
     {
@@ -74,18 +111,21 @@ bool BackpressureController::releasePressure()
     return false;
 }
 
-void BackpressureListener::wait(const std::stop_token& stopToken) const
+namespace
 {
-    auto state = channel->stateMtx.lock();
+/// Blocks until the channel is open. Returns true, if the channel was closed when we started waiting.
+bool waitForChannel(Channel& channel, const std::stop_token& stopToken)
+{
+    auto state = channel.stateMtx.lock();
     /// If the channel is open, backpressureListener can proceed
     if (*state == Channel::State::OPEN)
     {
-        return;
+        return false;
     }
 
     bool destroyed = false;
     /// Wait for the channel state to change
-    channel->change.wait(
+    channel.change.wait(
         state.as_lock(),
         stopToken,
         [&destroyed, &state] -> bool
@@ -95,6 +135,44 @@ void BackpressureListener::wait(const std::stop_token& stopToken) const
         });
 
     INVARIANT(!destroyed, "Backpressure Controller was destroyed before the BackpressureListener");
+    return true;
+}
+}
+
+void BackpressureListener::wait(const std::stop_token& stopToken) const
+{
+    /// While we waited for one channel, another channel might have been closed. Thus, we only proceed once we observed all channels open.
+    bool waited = true;
+    while (waited && !stopToken.stop_requested())
+    {
+        waited = false;
+        for (const auto& channel : channels)
+        {
+            waited |= waitForChannel(*channel, stopToken);
+        }
+        waited &= channels.size() > 1;
+    }
+}
+
+bool BackpressureListener::hasBackpressure() const
+{
+    for (const auto& channel : channels)
+    {
+        const auto state = *channel->stateMtx.lock();
+        INVARIANT(state != Channel::DESTROYED, "Backpressure Controller was destroyed before the BackpressureListener");
+        if (state != Channel::OPEN)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+BackpressureListener BackpressureListener::combine(const BackpressureListener& other) const
+{
+    auto combinedChannels = channels;
+    combinedChannels.insert(combinedChannels.end(), other.channels.begin(), other.channels.end());
+    return BackpressureListener{std::move(combinedChannels)};
 }
 
 std::pair<BackpressureController, BackpressureListener> createBackpressureChannel()
@@ -102,3 +180,8 @@ std::pair<BackpressureController, BackpressureListener> createBackpressureChanne
     const auto channel = std::make_shared<Channel>();
     return {BackpressureController{channel}, BackpressureListener{channel}};
 }
+
+std::chrono::nanoseconds getTotalBackpressureTime()
+{
+    return std::chrono::nanoseconds(totalBackpressureTimeInNs.load(std::memory_order_relaxed));
+}
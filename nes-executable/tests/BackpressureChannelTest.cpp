@@ -70,6 +70,23 @@ TEST_F(BackpressureChannelTest, BasicFunctionality)
     EXPECT_FALSE(backpressureController.releasePressure());
 }
 
+/// The backpressure time only grows while the channel is closed
+TEST_F(BackpressureChannelTest, BackpressureTime)
+{
+    auto [backpressureController, backpressureListener] = createBackpressureChannel();
+    const auto before = getTotalBackpressureTime();
+
+    constexpr std::chrono::milliseconds pressureDuration{20};
+    backpressureController.applyPressure();
+    std::this_thread::sleep_for(pressureDuration);
+    backpressureController.releasePressure();
+    const auto afterPressure = getTotalBackpressureTime();
+    EXPECT_GE(afterPressure - before, pressureDuration);
+
+    std::this_thread::sleep_for(pressureDuration);
+    EXPECT_EQ(getTotalBackpressureTime(), afterPressure);
+}
+
 /// Test that backpressureListener proceeds immediately when no pressure is applied
 TEST_F(BackpressureChannelTest, BackpressureListenerProceedsWhenNoPressure)
 {
@@ -333,4 +350,54 @@ TEST_F(BackpressureChannelTest, StopTokenFunctionality)
     EXPECT_TRUE(backpressureController.releasePressure());
 }
 
+/// Test that a combined listener only proceeds if none of its channels has backpressure applied
+TEST_F(BackpressureChannelTest, CombinedListenerWaitsForAllChannels)
+{
+    auto [sinkController, sinkListener] = createBackpressureChannel();
+    auto [quotaController, quotaListener] = createBackpressureChannel();
+    const auto combinedListener = sinkListener.combine(quotaListener);
+
+    EXPECT_TRUE(sinkController.applyPressure());
+    EXPECT_TRUE(quotaController.applyPressure());
+
+    std::atomic ingestionProceeded{false};
+    std::jthread ingestionThread(
+        [&](const std::stop_token& stopToken)
+        {
+            combinedListener.wait(stopToken);
+            ingestionProceeded = true;
+        });
+
+    /// Releasing only one of the channels keeps the ingestion blocked
+    EXPECT_TRUE(sinkController.releasePressure());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_FALSE(ingestionProceeded);
+
+    EXPECT_TRUE(quotaController.releasePressure());
+    ingestionThread.join();
+    EXPECT_TRUE(ingestionProceeded);
+
+    /// The original listeners are not affected by the combination
+    EXPECT_TRUE(quotaController.applyPressure());
+    sinkListener.wait({});
+    EXPECT_TRUE(quotaController.releasePressure());
+}
+
+/// Test that the non-blocking check reports the backpressure of every combined channel
+TEST_F(BackpressureChannelTest, HasBackpressureReportsAllChannels)
+{
+    auto [sinkController, sinkListener] = createBackpressureChannel();
+    auto [quotaController, quotaListener] = createBackpressureChannel();
+    const auto combinedListener = sinkListener.combine(quotaListener);
+    EXPECT_FALSE(combinedListener.hasBackpressure());
+
+    EXPECT_TRUE(quotaController.applyPressure());
+    EXPECT_TRUE(combinedListener.hasBackpressure());
+    EXPECT_TRUE(quotaListener.hasBackpressure());
+    EXPECT_FALSE(sinkListener.hasBackpressure());
+
+    EXPECT_TRUE(quotaController.releasePressure());
+    EXPECT_FALSE(combinedListener.hasBackpressure());
+}
+
 }
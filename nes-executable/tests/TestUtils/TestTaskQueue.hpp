@@ -87,7 +87,7 @@ public:
     }
 
     /// if buffer contains data, writes it into the result buffer vector, otherwise, calls the 'repeatTaskCallback'
-    bool emitBuffer(const TupleBuffer& resultBuffer, ContinuationPolicy continuationPolicy) override;
+    bool emitBuffer(TupleBuffer resultBuffer, ContinuationPolicy continuationPolicy) override;
 
     TupleBuffer allocateTupleBuffer() override;
 
@@ -97,7 +97,7 @@ public:
 
     [[nodiscard]] WorkerThreadId getId() const override { return workerThreadId; };
 
-    [[nodiscard]] uint64_t getNumberOfWorkerThreads() const override { return 0; }; /// dummy implementation for  pure virtual function
+    [[nodiscard]] uint64_t getNumberOfWorkerThreads() const override { return numberOfWorkerThreads; };
 
     [[nodiscard]] std::shared_ptr<AbstractBufferProvider> getBufferManager() const override { return bufferManager; }
 
@@ -114,6 +114,8 @@ public:
 
     WorkerThreadId workerThreadId;
     PipelineId pipelineId;
+    /// Zero by default, tests of per-worker state set it to the number of contexts that they execute with
+    uint64_t numberOfWorkerThreads = 0;
 
 private:
     /// We want to ensure that the address of the TupleBuffer is always the same. If we would simply store the object directly in the vector,
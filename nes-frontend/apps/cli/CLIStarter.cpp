@@ -35,6 +35,7 @@
 #include <DataTypes/Schema.hpp>
 #include <Identifiers/Identifiers.hpp>
 #include <Identifiers/NESStrongTypeJson.hpp> ///NOLINT(misc-include-cleaner)
+#include <Plans/LogicalPlan.hpp>
 #include <QueryManager/GRPCQuerySubmissionBackend.hpp>
 #include <QueryManager/QueryManager.hpp>
 #include <SQLQueryParser/AntlrSQLQueryParser.hpp>
@@ -512,9 +513,9 @@ void doQuerySubmission(const argparse::ArgumentParser& program, const argparse::
     {
         NES::CLI::QueryStateBackend stateBackend;
         NES::QueryStatementHandler queryStatementHandler{queryManager, optimizer};
-        for (const auto& query : queries)
+        for (auto& plan : NES::AntlrSQLQueryParser::createLogicalQueryPlansFromSQLStrings(queries))
         {
-            auto result = queryStatementHandler(NES::QueryStatement(NES::AntlrSQLQueryParser::createLogicalQueryPlanFromSQLString(query)));
+            auto result = queryStatementHandler(NES::QueryStatement(std::move(plan)));
             if (result)
             {
                 auto queryDescriptor = queryManager->getQuery(result->id);
@@ -531,10 +532,9 @@ void doQuerySubmission(const argparse::ArgumentParser& program, const argparse::
     else
     {
         NES::QueryStatementHandler queryStatementHandler{queryManager, optimizer};
-        for (const auto& query : queries)
+        for (auto& plan : NES::AntlrSQLQueryParser::createLogicalQueryPlansFromSQLStrings(queries))
         {
-            auto result
-                = queryStatementHandler(NES::ExplainQueryStatement(NES::AntlrSQLQueryParser::createLogicalQueryPlanFromSQLString(query)));
+            auto result = queryStatementHandler(NES::ExplainQueryStatement(std::move(plan)));
             if (result)
             {
                 std::cout << result->explainString << "\n";
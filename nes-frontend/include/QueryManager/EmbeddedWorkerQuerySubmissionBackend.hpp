@@ -38,6 +38,9 @@ public:
     [[nodiscard]] std::expected<LocalQueryStatus, Exception> status(QueryId) const override;
     [[nodiscard]] std::expected<WorkerStatus, Exception> workerStatus(std::chrono::system_clock::time_point after) const override;
 
+    /// Allows to observe the metrics of the embedded worker, e.g., while benchmarking a query
+    [[nodiscard]] const SingleNodeWorker& getWorker() const { return worker; }
+
 private:
     SingleNodeWorker worker;
 };
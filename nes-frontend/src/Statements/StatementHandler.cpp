@@ -33,6 +33,8 @@
 #include <fmt/ranges.h>
 #include <ErrorHandling.hpp>
 #include <LegacyOptimizer.hpp>
+#include <QueryOptimizer.hpp>
+#include <QueryOptimizerConfiguration.hpp>
 #include <WorkerStatus.hpp>
 
 namespace NES
@@ -213,6 +215,11 @@ std::expected<ExplainQueryStatementResult, Exception> QueryStatementHandler::ope
 
         fmt::println(explainMessage, "Optimized Global Plan:\n{}", optimizedPlan);
 
+        /// The workers decide the join implementations of their plans. Without a worker, we show the decisions of the default
+        /// configuration, which lacks the observed source rates of the workers.
+        const auto workerPlan = QueryOptimizer::optimize(optimizedPlan, QueryOptimizerConfiguration{});
+        fmt::println(explainMessage, "Worker Plan:\n{}", workerPlan.getPlan());
+
         return ExplainQueryStatementResult{explainMessage.str()};
     }
     CPPTRACE_CATCH(...)
@@ -0,0 +1,89 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <Sources/ColumnStatistics.hpp>
+#include <folly/Synchronized.h>
+
+namespace NES
+{
+
+class HyperLogLog;
+
+/// Collects the ColumnStatistics of the fields of all logical sources, which the input formatters of the sources sample while formatting.
+/// The input formatters sample every samplingInterval-th record of each buffer. Thus, concurrent worker threads rarely contend on a
+/// column and the statistics are cheap to maintain. The query optimizer reads the statistics via the SourceStatistics interface.
+/// Fields are identified by their (qualified) names, i.e., the fields of different logical sources never share a column.
+class ColumnStatisticsCollector
+{
+public:
+    /// Number of sampled values that a numeric column keeps to derive its histogram from (reservoir sampling)
+    static constexpr size_t RESERVOIR_SIZE = 1024;
+    static constexpr size_t NUMBER_OF_HISTOGRAM_BUCKETS = 16;
+
+    /// The sampled values of a single field
+    class Column
+    {
+    public:
+        explicit Column(bool isNumeric);
+        ~Column();
+
+        Column(const Column&) = delete;
+        Column(Column&&) = delete;
+        Column& operator=(const Column&) = delete;
+        Column& operator=(Column&&) = delete;
+
+        /// The value is only meaningful for numeric columns, the hash only for var sized columns
+        void sample(bool isNull, double value, uint64_t hash);
+        [[nodiscard]] ColumnStatistics getStatistics() const;
+
+    private:
+        bool isNumeric;
+        mutable std::mutex mutex;
+        uint64_t numberOfSampledValues = 0;
+        uint64_t numberOfNullValues = 0;
+        uint64_t numberOfNonNullValues = 0;
+        double min;
+        double max;
+        std::unique_ptr<HyperLogLog> distinctValues;
+        std::vector<double> reservoir;
+        std::minstd_rand random;
+    };
+
+    explicit ColumnStatisticsCollector(uint64_t samplingInterval);
+
+    /// Returns the column of the field and creates it on first use. Only numeric and var sized fields are sampled.
+    [[nodiscard]] std::shared_ptr<Column> getColumn(const std::string& fieldName, const DataType& dataType);
+    [[nodiscard]] std::optional<ColumnStatistics> getColumnStatistics(const std::string& fieldName) const;
+    [[nodiscard]] uint64_t getSamplingInterval() const { return samplingInterval; }
+
+    [[nodiscard]] static bool isSampled(const DataType& dataType);
+
+private:
+    uint64_t samplingInterval;
+    folly::Synchronized<std::unordered_map<std::string, std::shared_ptr<Column>>> columns;
+};
+
+}
@@ -29,6 +29,7 @@
 #include <Runtime/AbstractBufferProvider.hpp>
 #include <Util/Logger/Formatter.hpp>
 #include <Arena.hpp>
+#include <ColumnStatisticsCollector.hpp>
 #include <ErrorHandling.hpp>
 #include <ExecutionContext.hpp>
 #include <PhysicalOperator.hpp>
@@ -44,12 +45,18 @@ class RawTupleBuffer;
 class InputFormatterTupleBufferRef final : public TupleBufferRef
 {
     using ExecuteChildFn = std::function<void(ExecutionContext& executionCtx, Record& record)>;
+    using ReadFieldsFn = std::function<Record(const std::vector<Record::RecordFieldIdentifier>& fields)>;
+    using ProcessRecordFn = std::function<void(ExecutionContext& executionCtx, const ReadFieldsFn& readFields)>;
 
 public:
+    using PredicateFn = std::function<nautilus::val<bool>(ExecutionContext& executionCtx, Record& record)>;
+
     template <typename T>
     requires(not std::same_as<std::decay_t<T>, InputFormatterTupleBufferRef>)
-    explicit InputFormatterTupleBufferRef(T&& inputFormatter)
-        : TupleBufferRef(0, 0, 0), inputFormatter(std::make_unique<InputFormatterModel<T>>(std::forward<T>(inputFormatter)))
+    explicit InputFormatterTupleBufferRef(T&& inputFormatter, const bool orderedOutput)
+        : TupleBufferRef(0, 0, 0)
+        , inputFormatter(std::make_unique<InputFormatterModel<T>>(std::forward<T>(inputFormatter)))
+        , orderedOutput(orderedOutput)
     {
     }
 
@@ -75,6 +82,17 @@ public:
 
     void readBuffer(ExecutionContext& executionCtx, const RecordBuffer& recordBuffer, const ExecuteChildFn& executeChild) const;
 
+    /// True, if the formatter can parse the fields of a record in two steps (see readBufferWithPredicate)
+    [[nodiscard]] bool supportsLateMaterialization() const;
+    /// Parses only the predicate fields of each record and evaluates the predicate on them. Parses the remaining projected fields only for
+    /// records that satisfy the predicate, before passing the record to executeChild. Thus, rejected records never parse these fields.
+    void readBufferWithPredicate(
+        ExecutionContext& executionCtx,
+        const RecordBuffer& recordBuffer,
+        const std::vector<Record::RecordFieldIdentifier>& predicateFields,
+        const PredicateFn& predicate,
+        const ExecuteChildFn& executeChild) const;
+
     void
     writeRecord(nautilus::val<uint64_t>&, const RecordBuffer&, const Record&, const nautilus::val<AbstractBufferProvider*>&) const override
     {
@@ -84,6 +102,23 @@ public:
 
     nautilus::val<bool> indexBuffer(RecordBuffer& recordBuffer, ArenaRef& arenaRef) const;
 
+    /// Whether the pipeline that formats the source must emit its buffers in the order of their sequence numbers (see ParserConfig)
+    [[nodiscard]] bool requiresOrderedOutput() const { return orderedOutput; }
+
+    /// A field that the formatter samples into its column of the ColumnStatisticsCollector
+    struct SampledField
+    {
+        Record::RecordFieldIdentifier fieldName;
+        DataType dataType;
+        std::shared_ptr<ColumnStatisticsCollector::Column> column;
+    };
+
+    /// The fields that the formatter reads (see provideInputFormatterTupleBufferRef)
+    void setProjectedFields(std::vector<std::pair<Record::RecordFieldIdentifier, DataType>> projectedFields);
+    /// Samples the numeric and var sized projected fields of every n-th record of each buffer into the columns of the collector, before
+    /// the record is passed on to the child. Must be called before the pipeline of the formatter is traced.
+    void sampleColumnStatistics(ColumnStatisticsCollector& columnStatistics);
+
     friend std::ostream& operator<<(std::ostream& os, const InputFormatterTupleBufferRef& inputFormatterTupleBufferRef);
 
     /// Describes what a InputFormatter that is in the InputFormatterTupleBufferRef does (interface).
@@ -92,6 +127,10 @@ public:
         virtual ~InputFormatterConcept() = default;
         virtual void readBuffer(ExecutionContext& executionCtx, const RecordBuffer& recordBuffer, const ExecuteChildFn& executeChild) const
             = 0;
+        virtual void
+        readBufferLazily(ExecutionContext& executionCtx, const RecordBuffer& recordBuffer, const ProcessRecordFn& processRecord) const
+            = 0;
+        [[nodiscard]] virtual bool supportsLazyReads() const = 0;
         virtual nautilus::val<bool> indexBuffer(RecordBuffer&, ArenaRef&) const = 0;
         virtual std::ostream& toString(std::ostream& os) const = 0;
     };
@@ -114,11 +153,36 @@ public:
             return InputFormatter.readBuffer(executionCtx, recordBuffer, executeChild);
         }
 
+        void readBufferLazily(
+            ExecutionContext& executionCtx, const RecordBuffer& recordBuffer, const ProcessRecordFn& processRecord) const override
+        {
+            if constexpr (isLazilyReadable)
+            {
+                InputFormatter.readBufferLazily(executionCtx, recordBuffer, processRecord);
+                return;
+            }
+            INVARIANT(false, "The input formatter cannot parse the fields of a record in several steps");
+        }
+
+        [[nodiscard]] bool supportsLazyReads() const override { return isLazilyReadable; }
+
     private:
+        static constexpr bool isLazilyReadable = requires(const T& formatter, ExecutionContext& executionCtx, const RecordBuffer& buffer) {
+            formatter.readBufferLazily(executionCtx, buffer, ProcessRecordFn{});
+        };
+
         T InputFormatter;
     };
 
     std::unique_ptr<InputFormatterConcept> inputFormatter;
+
+private:
+    void sampleRecord(const Record& record) const;
+
+    bool orderedOutput;
+    std::vector<std::pair<Record::RecordFieldIdentifier, DataType>> projectedFields;
+    std::vector<SampledField> sampledFields;
+    uint64_t samplingInterval = 0;
 };
 
 }
@@ -15,18 +15,23 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include <DataTypes/Schema.hpp>
 #include <Identifiers/Identifiers.hpp>
 #include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
+#include <Nautilus/Interface/Record.hpp>
 #include <Sources/SourceDescriptor.hpp>
 #include <InputFormatterTupleBufferRef.hpp>
 
 namespace NES
 {
 
-std::shared_ptr<InputFormatterTupleBufferRef>
-provideInputFormatterTupleBufferRef(ParserConfig formatScanConfig, std::shared_ptr<TupleBufferRef> memoryProvider);
+/// The input formatter only reads the fields of the memory provider (which describes all fields of the source) that are in 'projections'
+std::shared_ptr<InputFormatterTupleBufferRef> provideInputFormatterTupleBufferRef(
+    ParserConfig formatScanConfig,
+    std::shared_ptr<TupleBufferRef> memoryProvider,
+    std::vector<Record::RecordFieldIdentifier> projections);
 
 bool contains(const std::string& parserType);
 }
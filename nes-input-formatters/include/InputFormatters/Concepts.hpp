@@ -23,6 +23,7 @@
 #include <utility>
 #include <vector>
 #include <DataTypes/DataType.hpp>
+#include <Nautilus/DataTypes/VarSizedDictionary.hpp>
 #include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
 #include <Nautilus/Interface/Record.hpp>
 #include <Sources/SourceDescriptor.hpp>
@@ -35,8 +36,14 @@ namespace NES
 /// Restricts the IndexerMetaData that an InputFormatIndexer receives from the InputFormatter
 template <typename T>
 concept IndexerMetaDataType
-    = requires(ParserConfig config, const TupleBufferRef& tupleBufferRef, T indexerMetaData, std::ostream& spanningTuple) {
-          T(config, tupleBufferRef);
+    = requires(
+        ParserConfig config,
+        const TupleBufferRef& tupleBufferRef,
+        const std::vector<Record::RecordFieldIdentifier>& projections,
+        T indexerMetaData,
+        std::ostream& spanningTuple) {
+          /// The projections are the fields of the tuple buffer ref that the InputFormatter reads
+          T(config, tupleBufferRef, projections);
           /// Assumes a fixed set of symbols that separate tuples
           /// InputFormatIndexers without tuple delimiters should return an empty string
           { indexerMetaData.getTupleDelimitingBytes() } -> std::same_as<std::string_view>;
@@ -45,6 +52,8 @@ concept IndexerMetaDataType
           { indexerMetaData.getFieldNameAt(nautilus::static_val<uint64_t>{0}) } -> std::same_as<const Record::RecordFieldIdentifier&>;
           { indexerMetaData.getNumberOfFields() } -> std::same_as<uint64_t>;
           { indexerMetaData.getNullValues() } -> std::same_as<const std::vector<std::string>&>;
+          /// Returns nullptr, if the InputFormatIndexer does not dictionary-encode VARSIZED values
+          { indexerMetaData.getDictionary() } -> std::same_as<VarSizedDictionary*>;
       };
 
 template <typename T>
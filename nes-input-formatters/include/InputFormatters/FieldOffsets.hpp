@@ -15,6 +15,7 @@
 #pragma once
 
 #include <algorithm>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
@@ -23,12 +24,15 @@
 #include <utility>
 #include <vector>
 
+#include <DataTypes/DataType.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
 #include <Nautilus/Interface/Record.hpp>
 #include <Arena.hpp>
 #include <Concepts.hpp>
 #include <ErrorHandling.hpp>
 #include <FieldIndexFunction.hpp>
 #include <InputFormatter.hpp>
+#include <RawValueParser.hpp>
 #include <static.hpp>
 #include <val.hpp>
 #include <val_concepts.hpp>
@@ -67,6 +71,42 @@ class FieldOffsets final : public FieldIndexFunction<FieldOffsets<NumOffsetsPerF
         return fieldOffsets->indexValues.data();
     }
 
+    static int8_t* getParsedColumnsProxy(FieldOffsets* const fieldOffsets)
+    {
+        return std::bit_cast<int8_t*>(fieldOffsets->parsedColumns.data());
+    }
+
+    /// The columns of the batch-parsed fields lie consecutively. A column holds the values of 'alignedNumberOfTuples' tuples, followed by
+    /// as many null flags, if the field is nullable. Aligning the number of tuples to eight aligns every column to eight bytes.
+    static constexpr size_t getAlignedNumberOfTuples(const size_t numberOfTuples) { return (numberOfTuples + 7) / 8 * 8; }
+
+    [[nodiscard]] static size_t getSizeOfParsedColumnPerTuple(const DataType& dataType)
+    {
+        return dataType.getSizeInBytesWithoutNull() + static_cast<size_t>(dataType.nullable);
+    }
+
+    /// Fields that the InputFormatter does not read are neither batch-parsed nor allocate a column
+    template <typename IndexerMetaData>
+    [[nodiscard]] static bool isParsedColumn(const IndexerMetaData& metaData, const size_t fieldIndex)
+    {
+        return metaData.isProjectedFieldAt(fieldIndex) and isBatchParsed(metaData.getFieldDataTypeAt(fieldIndex));
+    }
+
+    /// Returns the size of the columns of all batch-parsed fields prior to fieldIndex per (aligned) tuple
+    template <typename IndexerMetaData>
+    [[nodiscard]] static size_t getSizeOfPriorParsedColumnsPerTuple(const IndexerMetaData& metaData, const size_t fieldIndex)
+    {
+        size_t sizeOfPriorColumns = 0;
+        for (size_t priorFieldIndex = 0; priorFieldIndex < fieldIndex; ++priorFieldIndex)
+        {
+            if (isParsedColumn(metaData, priorFieldIndex))
+            {
+                sizeOfPriorColumns += getSizeOfParsedColumnPerTuple(metaData.getFieldDataTypeAt(priorFieldIndex));
+            }
+        }
+        return sizeOfPriorColumns;
+    }
+
     [[nodiscard]] nautilus::val<bool>
     applyHasNext(const nautilus::val<uint64_t>& recordIdx, nautilus::val<FieldOffsets*> fieldOffsetsPtr) const
     {
@@ -88,6 +128,16 @@ class FieldOffsets final : public FieldIndexFunction<FieldOffsets<NumOffsetsPerF
         /// skips fields that are not part of projection and only traces invoke functions for fields that we need
         Record record;
         const auto indexBufferPtr = invoke(getTupleBufferForEntryProxy, fieldOffsetsPtr);
+        nautilus::val<int8_t*> parsedColumnsPtr{nullptr};
+        nautilus::val<uint64_t> alignedNumberOfTuples{0};
+        if (getSizeOfPriorParsedColumnsPerTuple(metaData, metaData.getNumberOfFields()) > 0)
+        {
+            parsedColumnsPtr = invoke(getParsedColumnsProxy, fieldOffsetsPtr);
+            const nautilus::val<uint64_t> totalNumberOfTuples
+                = *getMemberWithOffset<size_t>(fieldOffsetsPtr, offsetof(FieldOffsets, totalNumberOfTuples));
+            alignedNumberOfTuples
+                = (totalNumberOfTuples + nautilus::val<uint64_t>(7)) / nautilus::val<uint64_t>(8) * nautilus::val<uint64_t>(8);
+        }
         for (nautilus::static_val<uint64_t> i = 0; i < metaData.getNumberOfFields(); ++i)
         {
             const auto& fieldName = metaData.getFieldNameAt(i);
@@ -97,6 +147,23 @@ class FieldOffsets final : public FieldIndexFunction<FieldOffsets<NumOffsetsPerF
                 continue;
             }
 
+            /// The batch parsers already parsed the field during indexing, thus we only load the value from its column
+            if (isBatchParsed(fieldDataType))
+            {
+                const auto columnPtr = parsedColumnsPtr
+                    + (alignedNumberOfTuples * nautilus::val<uint64_t>(getSizeOfPriorParsedColumnsPerTuple(metaData, i)));
+                const auto sizeOfValue = nautilus::val<uint64_t>(fieldDataType.getSizeInBytesWithoutNull());
+                const auto valuePtr = columnPtr + (recordIndex * sizeOfValue);
+                if (fieldDataType.nullable)
+                {
+                    const auto isNull = readValueFromMemRef<bool>(columnPtr + (alignedNumberOfTuples * sizeOfValue) + recordIndex);
+                    record.write(fieldName, VarVal::readVarValFromMemory(valuePtr, fieldDataType, isNull));
+                    continue;
+                }
+                record.write(fieldName, VarVal::readNonNullableVarValFromMemory(valuePtr, fieldDataType));
+                continue;
+            }
+
             const auto numPriorFields = recordIndex * nautilus::static_val(metaData.getNumberOfFields() + 1);
             const auto recordOffsetAddress = indexBufferPtr + (numPriorFields + i);
             const auto recordOffsetEndAddress = indexBufferPtr + (numPriorFields + i + nautilus::static_val<uint64_t>(1));
@@ -107,7 +174,14 @@ class FieldOffsets final : public FieldIndexFunction<FieldOffsets<NumOffsetsPerF
             const auto fieldSize = fieldOffsetEnd - fieldOffsetStart - sizeOfDelimiter;
             const auto fieldAddress = recordBufferPtr + fieldOffsetStart;
             parseRawValueIntoRecord(
-                fieldDataType, record, fieldAddress, fieldSize, fieldName, metaData.getNullValues(), metaData.getQuotationType());
+                fieldDataType,
+                record,
+                fieldAddress,
+                fieldSize,
+                fieldName,
+                metaData.getNullValues(),
+                metaData.getQuotationType(),
+                metaData.getDictionary());
         }
         return record;
     }
@@ -144,12 +218,22 @@ class FieldOffsets final : public FieldIndexFunction<FieldOffsets<NumOffsetsPerF
             auto fieldSize = fieldOffsetEnd - fieldOffsetStart;
             const auto fieldAddress = recordBufferPtr + fieldOffsetStart;
             parseRawValueIntoRecord(
-                fieldDataType, record, fieldAddress, fieldSize, fieldName, metaData.getNullValues(), metaData.getQuotationType());
+                fieldDataType,
+                record,
+                fieldAddress,
+                fieldSize,
+                fieldName,
+                metaData.getNullValues(),
+                metaData.getQuotationType(),
+                metaData.getDictionary());
         }
         return record;
     }
 
 public:
+    /// Reading a record does not advance the field offsets, thus a formatter may read the fields of a record in several steps
+    static constexpr bool SUPPORTS_PARTIAL_RECORD_READS = true;
+
     FieldOffsets() = default;
     ~FieldOffsets() = default;
 
@@ -175,6 +259,60 @@ public:
         this->indexValues.emplace_back(offset);
     }
 
+    /// Parses all projected batch-parsed fields of the indexed tuples column by column (see 'isBatchParsed()'). Afterward, reading a record
+    /// only loads the values of these fields, instead of calling a parse proxy for every field of every record.
+    template <typename IndexerMetaData>
+    void parseColumns(const std::string_view buffer, const IndexerMetaData& metaData)
+    requires(NumOffsetsPerField == NumRequiredOffsetsPerField::ONE)
+    {
+        const auto alignedNumberOfTuples = getAlignedNumberOfTuples(totalNumberOfTuples);
+        const auto sizeOfColumnsPerTuple = getSizeOfPriorParsedColumnsPerTuple(metaData, metaData.getNumberOfFields());
+        if (totalNumberOfTuples == 0 or sizeOfColumnsPerTuple == 0)
+        {
+            return;
+        }
+        this->parsedColumns.resize(alignedNumberOfTuples * sizeOfColumnsPerTuple / sizeof(uint64_t));
+        const auto parsedColumnBytes = std::as_writable_bytes(std::span(parsedColumns));
+
+        size_t offsetOfColumn = 0;
+        for (size_t fieldIndex = 0; fieldIndex < metaData.getNumberOfFields(); ++fieldIndex)
+        {
+            if (not isParsedColumn(metaData, fieldIndex))
+            {
+                continue;
+            }
+            const auto& dataType = metaData.getFieldDataTypeAt(fieldIndex);
+            const auto sizeOfValues = alignedNumberOfTuples * dataType.getSizeInBytesWithoutNull();
+            const auto values = parsedColumnBytes.subspan(offsetOfColumn, sizeOfValues);
+            const auto nulls = parsedColumnBytes.subspan(offsetOfColumn + sizeOfValues, dataType.nullable ? alignedNumberOfTuples : 0);
+            parseColumn(
+                dataType,
+                std::span(std::bit_cast<int8_t*>(values.data()), values.size()),
+                std::span(std::bit_cast<bool*>(nulls.data()), nulls.size()),
+                buffer,
+                indexValues,
+                numberOfFieldsInSchema,
+                fieldIndex,
+                metaData.getFieldDelimitingBytes().size(),
+                metaData.getNullValues());
+            offsetOfColumn += alignedNumberOfTuples * getSizeOfParsedColumnPerTuple(dataType);
+        }
+    }
+
+    /// Drops all but the first 'numberOfFieldOffsets' offsets, e.g., the offsets of a tuple that is not terminated by a tuple delimiter
+    void truncateFieldOffsets(const size_t numberOfFieldOffsets)
+    requires(NumOffsetsPerField == NumRequiredOffsetsPerField::ONE)
+    {
+        PRECONDITION(
+            numberOfFieldOffsets <= indexValues.size(),
+            "Cannot truncate {} field offsets to {} field offsets",
+            indexValues.size(),
+            numberOfFieldOffsets);
+        this->indexValues.resize(numberOfFieldOffsets);
+    }
+
+    [[nodiscard]] std::span<const FieldIndex> getFieldOffsets() const { return indexValues; }
+
     /// Ensures (vs std::pair) that values lie consecutively in memory
     struct __attribute__((packed)) IndexPairs
     {
@@ -231,6 +369,8 @@ private:
     FieldIndex offsetOfFirstTuple{};
     FieldIndex offsetOfLastTuple{};
     std::vector<FieldIndex> indexValues;
+    /// uint64_t aligns the columns of all data types
+    std::vector<uint64_t> parsedColumns;
 };
 
 }
@@ -99,11 +99,19 @@ template <InputFormatIndexerType FormatterType>
 class InputFormatter
 {
 public:
+    /// Parses the given fields of the current record
+    using ReadFieldsFn = std::function<Record(const std::vector<Record::RecordFieldIdentifier>& fields)>;
+    using ProcessRecordFn = std::function<void(ExecutionContext& executionCtx, const ReadFieldsFn& readFields)>;
+
+    /// The memory provider describes all fields of the raw tuples, of which the formatter only reads the fields in 'projections'
     explicit InputFormatter(
-        FormatterType inputFormatIndexer, std::shared_ptr<TupleBufferRef> memoryProvider, const ParserConfig& parserConfig)
+        FormatterType inputFormatIndexer,
+        std::shared_ptr<TupleBufferRef> memoryProvider,
+        const ParserConfig& parserConfig,
+        std::vector<Record::RecordFieldIdentifier> projections)
         : inputFormatIndexer(std::move(inputFormatIndexer))
-        , indexerMetaData(typename FormatterType::IndexerMetaData{parserConfig, *memoryProvider})
-        , projections(memoryProvider->getAllFieldNames())
+        , indexerMetaData(typename FormatterType::IndexerMetaData{parserConfig, *memoryProvider, projections})
+        , projections(std::move(projections))
         , memoryProvider(std::move(memoryProvider))
         , sequenceShredder(std::make_unique<SequenceShredder>(parserConfig.tupleDelimiter.size()))
     {
@@ -142,6 +150,35 @@ public:
         ExecutionContext& executionCtx,
         const RecordBuffer& recordBuffer,
         const std::function<void(ExecutionContext& executionCtx, Record& record)>& executeChild) const
+    {
+        parseBuffer(
+            executionCtx,
+            recordBuffer,
+            [&](ExecutionContext& childExecutionCtx, const ReadFieldsFn& readFields)
+            {
+                auto record = readFields(projections);
+                executeChild(childExecutionCtx, record);
+            });
+    }
+
+    /// Like readBuffer(), but passes a function that parses the given (projected) fields of the current record to 'processRecord',
+    /// instead of a record with all projected fields. Thus, the caller may parse some fields of a record only if it needs them,
+    /// e.g., the fields that a selection does not read only if the record satisfies the selection.
+    void readBufferLazily(ExecutionContext& executionCtx, const RecordBuffer& recordBuffer, const ProcessRecordFn& processRecord) const
+    requires(FormatterType::FieldIndexFunctionType::SUPPORTS_PARTIAL_RECORD_READS)
+    {
+        parseBuffer(executionCtx, recordBuffer, processRecord);
+    }
+
+    std::ostream& toString(std::ostream& os) const
+    {
+        /// Not using fmt::format, because it fails during build, trying to pass sequenceShredder as a const value
+        os << "InputFormatter(" << ", inputFormatIndexer: " << inputFormatIndexer << ", sequenceShredder: " << *sequenceShredder << ")\n";
+        return os;
+    }
+
+private:
+    void parseBuffer(ExecutionContext& executionCtx, const RecordBuffer& recordBuffer, const ProcessRecordFn& processRecord) const
     {
         /// @Note: the order below is important
         const nautilus::val<IndexPhaseResult*> indexPhaseResult = nautilus::invoke(getIndexPhaseResultProxy);
@@ -149,7 +186,7 @@ public:
         /// a buffer that only contains data from a single tuple may connect two buffers that delimit tuples
         /// we count such a spanning tuple as a leading spanning tuple
         /// a buffer that delimits tuples may form a leading (and a trailing) spanning tuple
-        parseLeadingRecord(executionCtx, executeChild, indexPhaseResult);
+        parseLeadingRecord(executionCtx, processRecord, indexPhaseResult);
 
         /// check if the buffer only contains data from a single tuple (does not delimit two tuples)
         /// such a buffer can only form one (leading) spanning tuple, so returning is safe
@@ -160,21 +197,13 @@ public:
 
         /// a buffer that delimits tuples may contain multiple complete tuples
         /// determining the offset of a tuple may require parsing the prior tuple
-        parseRecordsInRawBuffer(executionCtx, recordBuffer, executeChild, indexPhaseResult);
+        parseRecordsInRawBuffer(executionCtx, recordBuffer, processRecord, indexPhaseResult);
 
         /// a buffer that delimits tuples usually forms a spanning tuple that continues in the next buffer
         /// determining the offset of the start of that tuple may require parsing all prior records in the raw buffer
-        parseTrailingRecord(executionCtx, recordBuffer, executeChild, indexPhaseResult);
-    }
-
-    std::ostream& toString(std::ostream& os) const
-    {
-        /// Not using fmt::format, because it fails during build, trying to pass sequenceShredder as a const value
-        os << "InputFormatter(" << ", inputFormatIndexer: " << inputFormatIndexer << ", sequenceShredder: " << *sequenceShredder << ")\n";
-        return os;
+        parseTrailingRecord(executionCtx, recordBuffer, processRecord, indexPhaseResult);
     }
 
-private:
     FormatterType inputFormatIndexer;
     typename FormatterType::IndexerMetaData indexerMetaData;
     std::vector<Record::RecordFieldIdentifier> projections;
@@ -231,7 +260,8 @@ private:
             const auto offsetOfLastTupleDelimiter = tlIndexPhaseResult.rawBufferFIF.getByteOffsetOfLastTuple();
             tlIndexPhaseResult.hasValidOffsetOfTrailingSpanningTuple = offsetOfLastTupleDelimiter != std::numeric_limits<FieldIndex>::max();
 
-            tlIndexPhaseResult.hasTupleDelimiter = offsetOfFirstTupleDelimiter < tupleBuffer.getBufferSize();
+            /// Sources may fill buffers of different sizes, thus only the filled bytes of the buffer bound the offset of a delimiter
+            tlIndexPhaseResult.hasTupleDelimiter = offsetOfFirstTupleDelimiter < tupleBuffer.getNumberOfTuples();
             return {
                 .offsetOfFirstTupleDelimiter = offsetOfFirstTupleDelimiter,
                 .offsetOfLastTupleDelimiter = offsetOfLastTupleDelimiter,
@@ -385,7 +415,7 @@ private:
     template <typename IndexPhaseResult>
     void parseLeadingRecord(
         ExecutionContext& executionCtx,
-        const std::function<void(ExecutionContext& executionCtx, Record& record)>& executeChild,
+        const ProcessRecordFn& processRecord,
         const nautilus::val<IndexPhaseResult*>& indexPhaseResult) const
     {
         if (*getMemberWithOffset<bool>(indexPhaseResult, offsetof(IndexPhaseResult, hasLeadingSpanningTupleBool)))
@@ -396,9 +426,13 @@ private:
             /// Get leading field index function and a pointer to the spanning tuple 'record'
             auto spanningRecordPtr = *getMemberPtrWithOffset<int8_t>(indexPhaseResult, offsetof(IndexPhaseResult, leadingSpanningTuple));
 
-            auto record = typename FormatterType::FieldIndexFunctionType{}.readSpanningRecord(
-                projections, spanningRecordPtr, nautilus::val<uint64_t>(0), indexerMetaData, leadingFIF);
-            executeChild(executionCtx, record);
+            processRecord(
+                executionCtx,
+                [&](const std::vector<Record::RecordFieldIdentifier>& fields)
+                {
+                    return typename FormatterType::FieldIndexFunctionType{}.readSpanningRecord(
+                        fields, spanningRecordPtr, nautilus::val<uint64_t>(0), indexerMetaData, leadingFIF);
+                });
         }
     }
 
@@ -406,7 +440,7 @@ private:
     void parseRecordsInRawBuffer(
         ExecutionContext& executionCtx,
         const RecordBuffer& recordBuffer,
-        const std::function<void(ExecutionContext& executionCtx, Record& record)>& executeChild,
+        const ProcessRecordFn& processRecord,
         const nautilus::val<IndexPhaseResult*>& indexPhaseResult) const
     {
         nautilus::val<uint64_t> bufferRecordIdx = 0;
@@ -414,9 +448,13 @@ private:
             indexPhaseResult, offsetof(IndexPhaseResult, rawBufferFIF));
         while (typename FormatterType::FieldIndexFunctionType{}.hasNext(bufferRecordIdx, rawFieldAccessFunction))
         {
-            auto record = typename FormatterType::FieldIndexFunctionType{}.readSpanningRecord(
-                projections, recordBuffer.getMemArea(), bufferRecordIdx, indexerMetaData, rawFieldAccessFunction);
-            executeChild(executionCtx, record);
+            processRecord(
+                executionCtx,
+                [&](const std::vector<Record::RecordFieldIdentifier>& fields)
+                {
+                    return typename FormatterType::FieldIndexFunctionType{}.readSpanningRecord(
+                        fields, recordBuffer.getMemArea(), bufferRecordIdx, indexerMetaData, rawFieldAccessFunction);
+                });
             bufferRecordIdx += 1;
         }
     }
@@ -425,7 +463,7 @@ private:
     void parseTrailingRecord(
         ExecutionContext& executionCtx,
         const RecordBuffer& recordBuffer,
-        const std::function<void(ExecutionContext& executionCtx, Record& record)>& executeChild,
+        const ProcessRecordFn& processRecord,
         const nautilus::val<IndexPhaseResult*>& indexPhaseResult) const
     {
         const nautilus::val<bool> hasTrailingSpanningTuple = invoke(
@@ -441,9 +479,13 @@ private:
 
             auto spanningRecordPtr = *getMemberPtrWithOffset<int8_t>(indexPhaseResult, offsetof(IndexPhaseResult, trailingSpanningTuple));
 
-            auto record = typename FormatterType::FieldIndexFunctionType{}.readSpanningRecord(
-                projections, spanningRecordPtr, nautilus::val<uint64_t>(0), indexerMetaData, trailingFIF);
-            executeChild(executionCtx, record);
+            processRecord(
+                executionCtx,
+                [&](const std::vector<Record::RecordFieldIdentifier>& fields)
+                {
+                    return typename FormatterType::FieldIndexFunctionType{}.readSpanningRecord(
+                        fields, spanningRecordPtr, nautilus::val<uint64_t>(0), indexerMetaData, trailingFIF);
+                });
         }
     }
 };
@@ -16,18 +16,23 @@
 
 
 #include <cstddef>
+#include <cstdint>
+#include <span>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
 #include <DataTypes/DataType.hpp>
 #include <Nautilus/DataTypes/DataTypesUtil.hpp>
+#include <Nautilus/DataTypes/VarSizedDictionary.hpp>
 #include <Nautilus/DataTypes/VarVal.hpp>
 #include <Nautilus/DataTypes/VariableSizedData.hpp>
 #include <Nautilus/Interface/Record.hpp>
 #include <Util/Strings.hpp>
 #include <Arena.hpp>
 #include <ErrorHandling.hpp>
+#include <RawTupleBuffer.hpp>
 #include <val.hpp>
 #include <val_arith.hpp>
 #include <val_bool.hpp>
@@ -57,7 +62,36 @@ void parseRawValueIntoRecord(
     const nautilus::val<uint64_t>& fieldSize,
     const std::string& fieldName,
     const std::vector<std::string>& nullValues,
-    QuotationType quotationType);
+    QuotationType quotationType,
+    VarSizedDictionary* dictionary = nullptr);
+
+/// Returns true, if the batch parsers parse the fields of the data type, i.e., for all numeric data types.
+/// Formats that index all tuples of a buffer up front parse such fields column by column, instead of once per record via a proxy.
+[[nodiscard]] bool isBatchParsed(const DataType& dataType);
+
+/// Parses the field at 'fieldIndex' of all tuples into 'values' and marks the null values in 'nulls' (only if the field is nullable).
+/// Expects the layout of the FieldOffsets (with one offset per field), i.e., 'numberOfFields + 1' offsets per tuple: the start of every
+/// field, followed by the offset of the tuple delimiter.
+void parseColumn(
+    const DataType& dataType,
+    std::span<int8_t> values,
+    std::span<bool> nulls,
+    std::string_view buffer,
+    std::span<const FieldIndex> fieldOffsets,
+    size_t numberOfFields,
+    size_t fieldIndex,
+    size_t sizeOfFieldDelimiter,
+    const std::vector<std::string>& nullValues);
+
+/// Parses plain decimal integers eight digits at a time (SWAR) and plain decimal floats via Clinger's fast path.
+/// Falls back to from_chars_with_exception for all other values, thus yields the same values and errors as from_chars_with_exception.
+template <typename T>
+requires(std::is_arithmetic_v<T> and not std::is_same_v<T, bool> and not std::is_same_v<T, char>)
+T parseNumericValue(std::string_view value);
+
+/// Parses a decimal number into the unscaled value of a DECIMAL(precision, scale), i.e., the value multiplied by 10^scale.
+/// Throws a CannotFormatMalformedStringValue, if the value is not a decimal number or does not fit into the precision.
+int64_t parseDecimalValue(std::string_view value, uint8_t precision, uint8_t scale);
 
 /// We expect a pointer and the size so that we can use this method from the nautilus runtime
 bool checkIsNullProxy(const int8_t* fieldAddress, uint64_t fieldSize, const std::vector<std::string>* nullValues) noexcept;
@@ -14,10 +14,12 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <ostream>
+#include <shared_mutex>
 #include <utility>
 #include <vector>
 #include <Identifiers/Identifiers.hpp>
@@ -61,13 +63,24 @@ struct SequenceShredderResult
     SpanningBuffers spanningBuffers;
 };
 
+struct SequenceShredderStatistics
+{
+    /// The number of requests with sequence numbers that were not in range of the SpanningTupleBuffer (and that the caller must repeat)
+    uint64_t numberOfOutOfRangeRequests = 0;
+    uint64_t numberOfResizes = 0;
+    size_t sizeOfSpanningTupleBuffer = 0;
+};
+
 /// The SequenceShredder concurrently takes StagedBuffers and uses a (thread-safe) spanning tuple buffer (SpanningTupleBuffer) to determine whether
 /// the provided buffer completes spanning tuples with buffers that (usually) other threads processed
-/// (Planned) The SequenceShredder keeps track of sequence numbers that were not in range of the SpanningTupleBuffer
-/// (Planned) Given enough out-of-range requests, the SequenceShredder doubles the size of the SpanningTupleBuffer
+/// The SequenceShredder counts the requests with sequence numbers that were not in range of the SpanningTupleBuffer
+/// Given enough out-of-range requests, the SequenceShredder doubles the size of the SpanningTupleBuffer (up to a maximum size) and repeats
+/// the request. Threads share access to the SpanningTupleBuffer, except for the thread that resizes it, which requires exclusive access.
 class SequenceShredder
 {
     static constexpr size_t INITIAL_SIZE_OF_SPANNING_TUPLE_BUFFER = 1024;
+    static constexpr size_t MAXIMUM_SIZE_OF_SPANNING_TUPLE_BUFFER = 64 * INITIAL_SIZE_OF_SPANNING_TUPLE_BUFFER;
+    static constexpr uint64_t OUT_OF_RANGE_REQUESTS_BEFORE_RESIZE = 64;
 
 public:
     explicit SequenceShredder(size_t sizeOfTupleDelimiterInBytes);
@@ -76,8 +89,8 @@ public:
 
     SequenceShredder(const SequenceShredder&) = delete;
     SequenceShredder& operator=(const SequenceShredder&) = delete;
-    SequenceShredder(SequenceShredder&&) = default;
-    SequenceShredder& operator=(SequenceShredder&&) = default;
+    SequenceShredder(SequenceShredder&&) = delete;
+    SequenceShredder& operator=(SequenceShredder&&) = delete;
 
     /// Uses the SpanningTupleBuffer to thread-safely determine whether the 'indexedRawBuffer' with the given 'sequenceNumber'
     /// completes spanning tuples and whether the calling thread is the first to claim the individual spanning tuples
@@ -91,10 +104,23 @@ public:
     /// if the offset was not already known when 'findLeadingSpanningTupleWithDelimiter' was called
     SpanningBuffers findTrailingSpanningTupleWithDelimiter(SequenceNumber sequenceNumber, FieldIndex offsetOfLastTuple);
 
+    [[nodiscard]] SequenceShredderStatistics getStatistics() const;
+
     friend std::ostream& operator<<(std::ostream& os, const SequenceShredder& sequenceShredder);
 
 private:
     std::unique_ptr<SpanningTupleBuffer> spanningTupleBuffer;
+    /// Threads share the mutex to access the SpanningTupleBuffer and only lock it exclusively to resize the SpanningTupleBuffer
+    mutable std::shared_mutex spanningTupleBufferMutex;
+    std::atomic<uint64_t> numberOfOutOfRangeRequests{0};
+    std::atomic<uint64_t> numberOfOutOfRangeRequestsSinceResize{0};
+    /// Guarded by the 'spanningTupleBufferMutex'
+    uint64_t numberOfResizes = 0;
+
+    /// Searches for spanning tuples using 'search' and, if the sequence number is not in range of the SpanningTupleBuffer, counts the
+    /// out-of-range request. Doubles the size of the SpanningTupleBuffer and repeats the search, if the count reaches the threshold.
+    template <typename SearchFunction>
+    SequenceShredderResult searchAndResizeIfOutOfRange(SequenceNumber sequenceNumber, const SearchFunction& search);
 
     /// Enable 'ConcurrentSynchronizationTest' to used mocked buffer and provide 'sequenceNumber' as additional argument
     friend ConcurrentSynchronizationTest;
@@ -0,0 +1,88 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <DataTypes/DataType.hpp>
+
+namespace NES
+{
+
+/// The buffers of one column of a decoded Arrow record batch, laid out like a column of a columnar tuple buffer.
+/// Fixed-size values (and the offsets of VARSIZED values) point directly into the raw buffer that contains the record batch, if they are
+/// aligned. Otherwise, and for values that Arrow bit-packs (booleans and validity bitmaps), they point to memory owned by the batch.
+struct ArrowColumn
+{
+    /// The values of a fixed-size column, one value of 'getSizeInBytesWithoutNull()' bytes per row
+    const int8_t* values = nullptr;
+    /// One bool per row that is true, if the value of the row is null
+    const bool* nulls = nullptr;
+    /// The 'numberOfRows + 1' offsets of the values of a VARSIZED column into 'data'
+    const int32_t* offsets = nullptr;
+    const int8_t* data = nullptr;
+};
+
+static_assert(std::is_standard_layout_v<ArrowColumn>, "ArrowColumn must have a standard layout for safe usage of offsetof");
+
+struct ArrowRecordBatch
+{
+    uint64_t numberOfRows = 0;
+    std::vector<ArrowColumn> columns;
+    /// Memory that the columns point to, if they don't point into the raw buffer
+    std::vector<std::shared_ptr<const void>> storage;
+};
+
+/// Incrementally decodes an Arrow IPC stream (https://arrow.apache.org/docs/format/Columnar.html#ipc-streaming-format) that a source
+/// splits into raw buffers at arbitrary byte offsets. The decoder must see the raw buffers in the order of the stream.
+/// Supports uncompressed record batches of flat columns, i.e., Int, FloatingPoint (single & double), Bool, Utf8 & Binary columns.
+/// Validates the Arrow schema against the schema of the source by position and throws CannotFormatSourceData for mismatching or
+/// malformed messages. Skips the magic bytes of the Arrow file format and stops decoding at the end-of-stream marker.
+class ArrowIPCStreamDecoder
+{
+public:
+    explicit ArrowIPCStreamDecoder(std::vector<DataType> schema);
+
+    /// Decodes all messages that end in 'bytes' and appends their record batches to 'batches'.
+    /// The batches may point into 'bytes', so 'bytes' must outlive them. Copies the bytes of a message that continues in the next raw
+    /// buffer, completing the message, when the decoder sees the next raw buffer.
+    void decode(std::span<const int8_t> bytes, std::vector<ArrowRecordBatch>& batches);
+
+    [[nodiscard]] bool hasReachedEndOfStream() const { return reachedEndOfStream; }
+
+    [[nodiscard]] bool hasSchema() const { return receivedSchema; }
+
+private:
+    /// Returns the number of bytes that the next message requires at least, given the first bytes of the message
+    [[nodiscard]] size_t getRequiredBytesOfMessage(std::span<const int8_t> bytes) const;
+
+    /// Decodes one complete message. 'storage' owns 'bytes', if 'bytes' does not point into the raw buffer.
+    void decodeMessage(
+        std::span<const int8_t> bytes, const std::shared_ptr<const void>& storage, std::vector<ArrowRecordBatch>& batches);
+
+    std::vector<DataType> schema;
+    /// The bytes of a message that started in a prior raw buffer, but did not end in it
+    std::vector<int8_t> pendingMessage;
+    bool atStartOfStream = true;
+    bool receivedSchema = false;
+    bool reachedEndOfStream = false;
+};
+
+}
@@ -0,0 +1,95 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include <DataTypes/DataType.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Nautilus/Interface/RecordBuffer.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sources/SourceDescriptor.hpp>
+#include <Arena.hpp>
+#include <ArrowIPCDecoder.hpp>
+#include <ExecutionContext.hpp>
+#include <val.hpp>
+
+namespace NES
+{
+
+/// Formats a source that emits an Arrow IPC stream (or file). Unlike text formats, the Arrow IPC format is not delimited by tuple
+/// delimiters, so the formatter does not use the SequenceShredder. Instead, it decodes the raw buffers of the stream in the order of
+/// their sequence numbers, copying only the bytes of messages that span raw buffers.
+/// The indexing phase (indexBuffer) decodes the record batches that end in a raw buffer. It returns false (repeating the task), if it
+/// did not yet decode the raw buffer with the prior sequence number.
+/// The parsing phase (readBuffer) reads the values of a record directly from the (columnar) Arrow buffers, without parsing them.
+class ArrowIPCInputFormatter
+{
+public:
+    ArrowIPCInputFormatter(
+        const ParserConfig& parserConfig,
+        std::shared_ptr<TupleBufferRef> memoryProvider,
+        const std::vector<Record::RecordFieldIdentifier>& projections);
+    ~ArrowIPCInputFormatter() = default;
+
+    ArrowIPCInputFormatter(const ArrowIPCInputFormatter&) = delete;
+    ArrowIPCInputFormatter& operator=(const ArrowIPCInputFormatter&) = delete;
+    ArrowIPCInputFormatter(ArrowIPCInputFormatter&&) = default;
+    ArrowIPCInputFormatter& operator=(ArrowIPCInputFormatter&&) = delete;
+
+    [[nodiscard]] nautilus::val<bool> indexBuffer(const RecordBuffer& recordBuffer, const ArenaRef& arenaRef) const;
+
+    void readBuffer(
+        ExecutionContext& executionCtx,
+        const RecordBuffer& recordBuffer,
+        const std::function<void(ExecutionContext& executionCtx, Record& record)>& executeChild) const;
+
+    std::ostream& toString(std::ostream& os) const;
+
+private:
+    /// The decoder is stateful, since messages may span raw buffers. Thus, only one thread decodes at a time.
+    struct StreamState
+    {
+        explicit StreamState(std::vector<DataType> schema) : decoder(std::move(schema)) { }
+
+        std::mutex mutex;
+        ArrowIPCStreamDecoder decoder;
+        SequenceNumber::Underlying nextSequenceNumber = SequenceNumber::INITIAL;
+    };
+
+    std::vector<Record::RecordFieldIdentifier> fieldNames;
+    std::vector<DataType> fieldDataTypes;
+    /// Whether the formatter reads the field at the same index into records
+    std::vector<bool> projectedFields;
+    std::unique_ptr<StreamState> streamState;
+
+    /// Bridges the decoded record batches from the indexing phase to the parsing phase (see InputFormatter)
+    static thread_local std::vector<ArrowRecordBatch> tlDecodedBatches;
+
+    static bool decodeBufferProxy(const TupleBuffer* tupleBuffer, const ArrowIPCInputFormatter* inputFormatter);
+    static uint64_t getNumberOfBatchesProxy();
+    static uint64_t getNumberOfRowsProxy(uint64_t batchIndex);
+    static ArrowColumn* getColumnsProxy(uint64_t batchIndex);
+};
+
+}
@@ -16,12 +16,16 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <algorithm>
 #include <ostream>
+#include <ranges>
 #include <string_view>
 #include <vector>
 
 #include <DataTypes/DataType.hpp>
 #include <DataTypes/Schema.hpp>
+#include <Nautilus/DataTypes/VarSizedDictionary.hpp>
 #include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
 #include <Nautilus/Interface/Record.hpp>
 #include <Sources/SourceDescriptor.hpp>
@@ -42,12 +46,17 @@ struct CSVMetaData
     static constexpr size_t SIZE_OF_TUPLE_DELIMITER = 1;
     static constexpr size_t SIZE_OF_FIELD_DELIMITER = 1;
 
-    explicit CSVMetaData(const ParserConfig& config, const TupleBufferRef& tupleBufferRef)
+    explicit CSVMetaData(
+        const ParserConfig& config, const TupleBufferRef& tupleBufferRef, const std::vector<Record::RecordFieldIdentifier>& projections)
         : tupleDelimiter(config.tupleDelimiter.front())
         , fieldDelimiter(config.fieldDelimiter.front())
         , fieldNames(tupleBufferRef.getAllFieldNames())
         , fieldDataTypes(tupleBufferRef.getAllDataTypes())
+        , projectedFields(
+              fieldNames | std::views::transform([&](const auto& fieldName) { return std::ranges::contains(projections, fieldName); })
+              | std::ranges::to<std::vector>())
         , nullValues({""})
+        , dictionary(config.dictionaryEncoding ? std::make_shared<VarSizedDictionary>() : nullptr)
     {
         PRECONDITION(
             config.tupleDelimiter.size() == SIZE_OF_TUPLE_DELIMITER,
@@ -73,6 +82,8 @@ struct CSVMetaData
 
     [[nodiscard]] const std::vector<std::string>& getNullValues() const { return nullValues; }
 
+    [[nodiscard]] VarSizedDictionary* getDictionary() const { return dictionary.get(); }
+
     [[nodiscard]] const Record::RecordFieldIdentifier& getFieldNameAt(const nautilus::static_val<uint64_t>& i) const
     {
         PRECONDITION(i < fieldNames.size(), "Trying to access position, larger than the size of fieldNames {}", fieldNames.size());
@@ -86,6 +97,14 @@ struct CSVMetaData
         return fieldDataTypes[i];
     }
 
+    /// The indexer only batch-parses the columns of the fields that the InputFormatter reads
+    [[nodiscard]] bool isProjectedFieldAt(const nautilus::static_val<uint64_t>& i) const
+    {
+        PRECONDITION(
+            i < projectedFields.size(), "Trying to access position, larger than the size of projectedFields {}", projectedFields.size());
+        return projectedFields[i];
+    }
+
     [[nodiscard]] uint64_t getNumberOfFields() const
     {
         INVARIANT(fieldNames.size() == fieldDataTypes.size(), "No. fields must be equal to no. data types");
@@ -97,7 +116,10 @@ private:
     char fieldDelimiter;
     std::vector<Record::RecordFieldIdentifier> fieldNames;
     std::vector<DataType> fieldDataTypes;
+    std::vector<bool> projectedFields;
     std::vector<std::string> nullValues;
+    /// Shared, as the InputFormatter of a source (and thus its meta data) may be moved
+    std::shared_ptr<VarSizedDictionary> dictionary;
 };
 
 class CSVInputFormatIndexer : public InputFormatIndexer<CSVInputFormatIndexer>
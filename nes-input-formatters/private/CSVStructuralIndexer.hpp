@@ -0,0 +1,64 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include <FieldOffsets.hpp>
+
+namespace NES
+{
+
+/// Kernels that classify the bytes of a 64-byte block of a CSV buffer into bitmasks of tuple delimiters, field delimiters and quotes
+enum class CSVClassificationKernel : uint8_t
+{
+    SCALAR,
+    SSE2,
+    /// Requires AVX2 and PCLMULQDQ (carry-less multiply for the quote masks)
+    AVX2,
+    NEON
+};
+
+/// Returns the fastest kernel that the cpu supports. The kernel is detected once at runtime.
+CSVClassificationKernel getCSVClassificationKernel();
+
+/// Returns all kernels that the cpu supports, e.g., to test them against each other
+std::vector<CSVClassificationKernel> getSupportedCSVClassificationKernels();
+
+struct CSVStructure
+{
+    char tupleDelimiter;
+    char fieldDelimiter;
+    /// Ignores field delimiters between double quotes. As the byte-wise indexer did, every tuple starts outside of quotes.
+    bool allowCommasInStrings;
+    size_t numberOfFields;
+};
+
+/// Indexes the fields of all tuples of the buffer that are enclosed by two tuple delimiters, i.e., the bytes before the first and
+/// after the last tuple delimiter belong to spanning tuples. Emplaces the offset of every field of a tuple, followed by the offset of
+/// the tuple delimiter that ends the tuple, and finally marks the offsets of the first and the last tuple delimiter.
+/// Instead of scanning the buffer byte by byte, it classifies blocks of 64 bytes at once, computes the quoted regions of a block via
+/// a prefix-xor over the quote mask, and extracts the delimiter positions from the bitmasks, one count-trailing-zeros per delimiter.
+/// Throws a CannotFormatSourceData, if the number of fields of a tuple does not match numberOfFields.
+void indexCSVStructure(
+    FieldOffsets<NumRequiredOffsetsPerField::ONE>& fieldOffsets,
+    std::string_view buffer,
+    const CSVStructure& structure,
+    CSVClassificationKernel kernel = getCSVClassificationKernel());
+
+}
@@ -0,0 +1,76 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <DataTypes/DataType.hpp>
+
+namespace NES
+{
+
+/// A decoded frame of the native format (see NativeFrameHeader). The tuples and the child buffers point directly into the raw buffer that
+/// contains the frame, or, if the frame spans raw buffers, into memory owned by the frame.
+struct NativeFrame
+{
+    uint64_t numberOfTuples = 0;
+    /// The tuples in the row layout of the schema
+    const int8_t* tuples = nullptr;
+    /// The start of every child buffer, indexed by the VariableSizedAccess::Index of the VARSIZED values of the tuples
+    std::vector<const int8_t*> childBuffers;
+    std::shared_ptr<const void> storage;
+};
+
+/// Incrementally decodes a stream of native frames that a source splits into raw buffers at arbitrary byte offsets. The decoder must see
+/// the raw buffers in the order of the stream. Throws CannotFormatSourceData for frames that do not match the schema of the source, and
+/// for VARSIZED values that do not lie in a child buffer of their frame, since the parser reads values without checking them.
+class NativeFrameDecoder
+{
+public:
+    explicit NativeFrameDecoder(const std::vector<DataType>& schema);
+
+    /// Decodes all frames that end in 'bytes' and appends them to 'frames'.
+    /// The frames may point into 'bytes', so 'bytes' must outlive them. Copies the bytes of a frame that continues in the next raw buffer,
+    /// completing the frame, when the decoder sees the next raw buffer.
+    void decode(std::span<const int8_t> bytes, std::vector<NativeFrame>& frames);
+
+    [[nodiscard]] size_t getSizeOfTuple() const { return sizeOfTuple; }
+
+private:
+    /// A field that the decoder checks for every tuple of a frame
+    struct CheckedField
+    {
+        size_t offset;
+        bool nullable;
+        bool varSized;
+    };
+
+    /// Returns the number of bytes that the next frame requires at least, given the first bytes of the frame
+    [[nodiscard]] size_t getRequiredBytesOfFrame(std::span<const int8_t> bytes) const;
+
+    /// Decodes one complete frame. 'storage' owns 'bytes', if 'bytes' does not point into the raw buffer.
+    void decodeFrame(std::span<const int8_t> bytes, const std::shared_ptr<const void>& storage, std::vector<NativeFrame>& frames) const;
+
+    size_t sizeOfTuple = 0;
+    std::vector<CheckedField> checkedFields;
+    /// The bytes of a frame that started in a prior raw buffer, but did not end in it
+    std::vector<int8_t> pendingFrame;
+};
+
+}
@@ -0,0 +1,99 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include <DataTypes/DataType.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Nautilus/Interface/RecordBuffer.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sources/SourceDescriptor.hpp>
+#include <Arena.hpp>
+#include <ExecutionContext.hpp>
+#include <NativeFrameDecoder.hpp>
+#include <val.hpp>
+
+namespace NES
+{
+
+/// Formats a source that emits the native format (see NativeFrameHeader), e.g., the output of a sink with the native format.
+/// The tuples of the native format are already laid out like the tuples of a RowTupleBufferRef, so the formatter does not parse values.
+/// Like the ArrowIPCInputFormatter, it decodes the frames of the raw buffers in the order of their sequence numbers, copying only the
+/// bytes of frames that span raw buffers, and returns false in the indexing phase (indexBuffer) to repeat the task otherwise.
+/// The parsing phase (readBuffer) reads the values of a record directly from the tuples and the child buffers of the frames.
+class NativeInputFormatter
+{
+public:
+    NativeInputFormatter(
+        const ParserConfig& parserConfig,
+        std::shared_ptr<TupleBufferRef> memoryProvider,
+        const std::vector<Record::RecordFieldIdentifier>& projections);
+    ~NativeInputFormatter() = default;
+
+    NativeInputFormatter(const NativeInputFormatter&) = delete;
+    NativeInputFormatter& operator=(const NativeInputFormatter&) = delete;
+    NativeInputFormatter(NativeInputFormatter&&) = default;
+    NativeInputFormatter& operator=(NativeInputFormatter&&) = delete;
+
+    [[nodiscard]] nautilus::val<bool> indexBuffer(const RecordBuffer& recordBuffer, const ArenaRef& arenaRef) const;
+
+    void readBuffer(
+        ExecutionContext& executionCtx,
+        const RecordBuffer& recordBuffer,
+        const std::function<void(ExecutionContext& executionCtx, Record& record)>& executeChild) const;
+
+    std::ostream& toString(std::ostream& os) const;
+
+private:
+    /// The decoder is stateful, since frames may span raw buffers. Thus, only one thread decodes at a time.
+    struct StreamState
+    {
+        explicit StreamState(const std::vector<DataType>& schema) : decoder(schema) { }
+
+        std::mutex mutex;
+        NativeFrameDecoder decoder;
+        SequenceNumber::Underlying nextSequenceNumber = SequenceNumber::INITIAL;
+    };
+
+    std::vector<Record::RecordFieldIdentifier> fieldNames;
+    std::vector<DataType> fieldDataTypes;
+    /// Whether the formatter reads the field at the same index into records
+    std::vector<bool> projectedFields;
+    /// The offsets of the fields in a tuple of the row layout
+    std::vector<size_t> fieldOffsets;
+    std::unique_ptr<StreamState> streamState;
+
+    /// Bridges the decoded frames from the indexing phase to the parsing phase (see InputFormatter)
+    static thread_local std::vector<NativeFrame> tlDecodedFrames;
+
+    static bool decodeBufferProxy(const TupleBuffer* tupleBuffer, const NativeInputFormatter* inputFormatter);
+    static uint64_t getNumberOfFramesProxy();
+    static uint64_t getNumberOfTuplesProxy(uint64_t frameIndex);
+    static int8_t* getTuplesProxy(uint64_t frameIndex);
+    /// Returns the address of the array of the starts of the child buffers of the frame
+    static int8_t* getChildBuffersProxy(uint64_t frameIndex);
+};
+
+}
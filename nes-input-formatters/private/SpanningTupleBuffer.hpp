@@ -93,6 +93,12 @@ public:
     [[nodiscard]] SequenceShredderResult
     tryFindSpanningTupleForBufferWithoutDelimiter(SequenceNumber sequenceNumber, const StagedBuffer& indexedRawBuffer);
 
+    /// Doubles the number of entries, moving the entry of each sequence number to the index of the sequence number in the larger buffer
+    /// Not thread-safe, the caller must guarantee that no other thread accesses the SpanningTupleBuffer (see SequenceShredder)
+    void doubleSize();
+
+    [[nodiscard]] size_t getSize() const { return buffer.size(); }
+
     [[nodiscard]] bool validate() const;
 
     friend std::ostream& operator<<(std::ostream& os, const SpanningTupleBuffer& sequenceRingBuffer);
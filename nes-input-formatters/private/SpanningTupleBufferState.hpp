@@ -17,6 +17,7 @@
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <new>
 #include <optional>
 #include <ostream>
@@ -64,6 +65,8 @@ class AtomicState
     static constexpr uint64_t hasValidLastDelimiterOffsetBit = (1ULL << 36ULL); /// NOLINT(readability-magic-numbers)
     ///       000000000000000000000000000110000000000000000000000000000000000
     static constexpr uint64_t usedLeadingAndTrailingBufferBits = (usedLeadingBufferBit | usedTrailingBufferBit);
+    /// 1-32: 000000000000000000000000000000011111111111111111111111111111111
+    static constexpr uint64_t abaItNoBits = std::numeric_limits<uint32_t>::max();
 
     /// The SpanningTupleBuffer initializes all SpanningTupleBufferEntries, except for the very first entry, with the 'defaultState'
     /// Tag: 0, HasTupleDelimiter: True, ClaimedSpanningTuple: True, UsedLeading: True, UsedTrailing: True
@@ -71,6 +74,10 @@ class AtomicState
     /// The SpanningTupleBuffer initializes the very first entry with a dummy buffer and a matching dummy state to trigger the first leading SpanningTuple
     /// Tag: 1, HasTupleDelimiter: True, ClaimedSpanningTuple: False, UsedLeading: True, UsedTrailing: False, HasValidLastDelimiterOffset: True
     static constexpr uint64_t firstEntryDummy = (1ULL | hasTupleDelimiterBit | usedLeadingBufferBit | hasValidLastDelimiterOffsetBit);
+    /// Resizing the SpanningTupleBuffer replaces the entries of overwritten (used up) buffers with the 'usedUpState'
+    /// In contrast to the 'defaultState', the entry has a tuple delimiter, so that searches stop at the entry (and fail to claim it)
+    /// Tag: (set on resize), HasTupleDelimiter: True, ClaimedSpanningTuple: True, UsedLeading: True, UsedTrailing: True
+    static constexpr uint64_t usedUpState = (defaultState | hasTupleDelimiterBit | hasValidLastDelimiterOffsetBit);
 
     /// [1-32] : Iteration Tag:        protects against ABA and tells threads whether buffer is from the same iteration during SpanningTuple search
     /// [33]   : HasTupleDelimiter:    when set, threads stop spanning tuple (SpanningTuple) search, since the buffer represents a possible start/end
@@ -139,6 +146,15 @@ class AtomicState
 
     void setHasValidLastDelimiterOffset() { this->state |= hasValidLastDelimiterOffsetBit; }
 
+    /// Keeps the bits of the 'bitmapState', but replaces its ABA iteration number
+    void setStateWithABAItNo(const BitmapState bitmapState, const ABAItNo abaItNumber)
+    {
+        this->state = (bitmapState.getBitmapState() & ~abaItNoBits) | abaItNumber.getRawValue();
+    }
+
+    /// Like the 'defaultState', but with the given ABA iteration number and a tuple delimiter (see 'usedUpState')
+    void setUsedUpState(const ABAItNo abaItNumber) { this->state = (usedUpState | abaItNumber.getRawValue()); }
+
     friend std::ostream& operator<<(std::ostream& os, const AtomicState& atomicBitmapState);
 
     std::atomic<uint64_t> state;
@@ -184,6 +200,15 @@ public:
     bool trySetWithDelimiter(ABAItNo abaItNumber, const StagedBuffer& indexedBuffer);
     bool trySetWithoutDelimiter(ABAItNo abaItNumber, const StagedBuffer& indexedBuffer);
 
+    /// Moves the buffers, the offsets and the state of the 'priorEntry' into this entry, replacing the ABA iteration number of the state
+    /// Not thread-safe, requires exclusive access to both entries (see SpanningTupleBuffer::doubleSize)
+    void takeOverEntry(SpanningTupleBufferEntry& priorEntry, ABAItNo abaItNumber);
+
+    /// Sets the state of an entry with an (already overwritten) prior buffer that was used up and had the given ABA iteration number
+    void setUsedUpState(ABAItNo abaItNumber);
+
+    [[nodiscard]] ABAItNo getABAItNo() const { return atomicState.getABAItNo(); }
+
     /// Claim a buffer without a delimiter (that connects two buffers with delimiters), taking both buffers and atomically setting both uses at once
     void claimNoDelimiterBuffer(std::span<StagedBuffer> spanningTupleVector, size_t spanningTupleIdx);
 
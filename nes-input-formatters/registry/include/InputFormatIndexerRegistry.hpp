@@ -18,10 +18,12 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <DataTypes/Schema.hpp>
 #include <Identifiers/Identifiers.hpp>
 #include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
+#include <Nautilus/Interface/Record.hpp>
 #include <Sources/SourceDescriptor.hpp>
 #include <Util/Registry.hpp>
 #include <Concepts.hpp>
@@ -38,8 +40,9 @@ using InputFormatIndexerRegistryReturnType = std::unique_ptr<InputFormatterTuple
 /// Calls constructor of specific InputFormatter and exposes public members to it.
 struct InputFormatIndexerRegistryArguments
 {
-    InputFormatIndexerRegistryArguments(ParserConfig config, std::shared_ptr<TupleBufferRef> memoryProvider)
-        : inputFormatIndexerConfig(std::move(config)), memoryProvider(std::move(memoryProvider))
+    InputFormatIndexerRegistryArguments(
+        ParserConfig config, std::shared_ptr<TupleBufferRef> memoryProvider, std::vector<Record::RecordFieldIdentifier> projections)
+        : inputFormatIndexerConfig(std::move(config)), memoryProvider(std::move(memoryProvider)), projections(std::move(projections))
     {
     }
 
@@ -49,9 +52,19 @@ struct InputFormatIndexerRegistryArguments
     template <InputFormatIndexerType IndexerType>
     InputFormatIndexerRegistryReturnType createInputFormatterWithIndexer(IndexerType inputFormatIndexer)
     {
-        auto inputFormatter
-            = InputFormatter<IndexerType>(std::move(inputFormatIndexer), std::move(memoryProvider), inputFormatIndexerConfig);
-        return std::make_unique<InputFormatterTupleBufferRef>(std::move(inputFormatter));
+        auto inputFormatter = InputFormatter<IndexerType>(
+            std::move(inputFormatIndexer), std::move(memoryProvider), inputFormatIndexerConfig, std::move(projections));
+        return std::make_unique<InputFormatterTupleBufferRef>(std::move(inputFormatter), inputFormatIndexerConfig.orderedOutput);
+    }
+
+    /// Instantiates an input formatter that does not index raw buffers for the InputFormatter, e.g., since its format is not delimited by
+    /// tuple delimiters. The formatter receives the config, the memory provider and the projections in its constructor.
+    template <typename FormatterType>
+    InputFormatIndexerRegistryReturnType createInputFormatter()
+    {
+        return std::make_unique<InputFormatterTupleBufferRef>(
+            FormatterType{inputFormatIndexerConfig, std::move(memoryProvider), std::move(projections)},
+            inputFormatIndexerConfig.orderedOutput);
     }
 
 private:
@@ -61,6 +74,8 @@ private:
     /// While this does not prevent an indexer implementation from accessing the state of the meta-data object it helps to discourage it
     ParserConfig inputFormatIndexerConfig;
     std::shared_ptr<TupleBufferRef> memoryProvider;
+    /// The fields of the memory provider that the formatter reads, e.g., since the query only accesses these fields of the source
+    std::vector<Record::RecordFieldIdentifier> projections;
 };
 
 class InputFormatIndexerRegistry : public BaseRegistry<
@@ -0,0 +1,662 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <ArrowIPCDecoder.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <DataTypes/DataType.hpp>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+namespace
+{
+
+/// The Arrow IPC format encodes its metadata as flatbuffers (https://github.com/apache/arrow/blob/main/format/Message.fbs).
+/// Since we only read a handful of fields, we read the flatbuffers directly, instead of depending on the flatbuffers library.
+/// The readers check all offsets against the bounds of the metadata, since the metadata stems from an (untrusted) source.
+template <typename T>
+T readLittleEndian(const std::span<const uint8_t> bytes, const size_t position)
+{
+    if (position > bytes.size() or bytes.size() - position < sizeof(T))
+    {
+        throw CannotFormatSourceData(
+            "Arrow metadata is malformed: reading {} bytes at offset {} exceeds its size {}", sizeof(T), position, bytes.size());
+    }
+    T value;
+    std::memcpy(&value, bytes.data() + position, sizeof(T));
+    return value;
+}
+
+class FlatbufferVector;
+
+class FlatbufferTable
+{
+public:
+    FlatbufferTable(const std::span<const uint8_t> buffer, const size_t position) : buffer(buffer), position(position)
+    {
+        const auto vtablePosition = static_cast<int64_t>(position) - readLittleEndian<int32_t>(buffer, position);
+        if (vtablePosition < 0)
+        {
+            throw CannotFormatSourceData("Arrow metadata is malformed: table at offset {} has an invalid vtable", position);
+        }
+        vtable = static_cast<size_t>(vtablePosition);
+        vtableSize = readLittleEndian<uint16_t>(buffer, vtable);
+        if (vtableSize < 2 * sizeof(uint16_t) or vtable + vtableSize > buffer.size())
+        {
+            throw CannotFormatSourceData("Arrow metadata is malformed: table at offset {} has an invalid vtable", position);
+        }
+    }
+
+    template <typename T>
+    [[nodiscard]] T getScalar(const size_t slot, const T defaultValue) const
+    {
+        const auto fieldPosition = getFieldPosition(slot);
+        return fieldPosition.has_value() ? readLittleEndian<T>(buffer, *fieldPosition) : defaultValue;
+    }
+
+    [[nodiscard]] std::optional<FlatbufferTable> getTable(const size_t slot) const
+    {
+        const auto fieldPosition = getFieldPosition(slot);
+        if (not fieldPosition.has_value())
+        {
+            return std::nullopt;
+        }
+        return FlatbufferTable{buffer, *fieldPosition + readLittleEndian<uint32_t>(buffer, *fieldPosition)};
+    }
+
+    [[nodiscard]] std::optional<FlatbufferVector> getVector(size_t slot, size_t sizeOfElement) const;
+
+private:
+    [[nodiscard]] std::optional<size_t> getFieldPosition(const size_t slot) const
+    {
+        const auto entry = (2 + slot) * sizeof(uint16_t);
+        if (entry + sizeof(uint16_t) > vtableSize)
+        {
+            return std::nullopt;
+        }
+        const auto offsetInTable = readLittleEndian<uint16_t>(buffer, vtable + entry);
+        return (offsetInTable == 0) ? std::nullopt : std::optional{position + offsetInTable};
+    }
+
+    std::span<const uint8_t> buffer;
+    size_t position;
+    size_t vtable;
+    uint16_t vtableSize;
+};
+
+/// A vector of tables, or of structs of a fixed size
+class FlatbufferVector
+{
+public:
+    FlatbufferVector(const std::span<const uint8_t> buffer, const size_t position, const size_t sizeOfElement)
+        : buffer(buffer), position(position + sizeof(uint32_t)), length(readLittleEndian<uint32_t>(buffer, position))
+    {
+        if (this->position > buffer.size() or (buffer.size() - this->position) / sizeOfElement < length)
+        {
+            throw CannotFormatSourceData("Arrow metadata is malformed: vector at offset {} exceeds the metadata", position);
+        }
+    }
+
+    [[nodiscard]] size_t size() const { return length; }
+
+    [[nodiscard]] FlatbufferTable getTable(const size_t index) const
+    {
+        const auto elementPosition = position + (index * sizeof(uint32_t));
+        return FlatbufferTable{buffer, elementPosition + readLittleEndian<uint32_t>(buffer, elementPosition)};
+    }
+
+    /// Returns the member at 'offsetInStruct' of the struct at 'index'
+    template <typename T>
+    [[nodiscard]] T getStructMember(const size_t index, const size_t sizeOfStruct, const size_t offsetInStruct) const
+    {
+        return readLittleEndian<T>(buffer, position + (index * sizeOfStruct) + offsetInStruct);
+    }
+
+private:
+    std::span<const uint8_t> buffer;
+    size_t position;
+    size_t length;
+};
+
+std::optional<FlatbufferVector> FlatbufferTable::getVector(const size_t slot, const size_t sizeOfElement) const
+{
+    const auto fieldPosition = getFieldPosition(slot);
+    if (not fieldPosition.has_value())
+    {
+        return std::nullopt;
+    }
+    return FlatbufferVector{buffer, *fieldPosition + readLittleEndian<uint32_t>(buffer, *fieldPosition), sizeOfElement};
+}
+
+/// Slots and enum values of the Arrow flatbuffer schemas (Message.fbs, Schema.fbs)
+namespace MessageSlot
+{
+constexpr size_t HEADER_TYPE = 1;
+constexpr size_t HEADER = 2;
+constexpr size_t BODY_LENGTH = 3;
+}
+
+namespace SchemaSlot
+{
+constexpr size_t ENDIANNESS = 0;
+constexpr size_t FIELDS = 1;
+}
+
+namespace FieldSlot
+{
+constexpr size_t TYPE_TYPE = 2;
+constexpr size_t TYPE = 3;
+constexpr size_t DICTIONARY = 4;
+}
+
+namespace RecordBatchSlot
+{
+constexpr size_t LENGTH = 0;
+constexpr size_t NODES = 1;
+constexpr size_t BUFFERS = 2;
+constexpr size_t COMPRESSION = 3;
+}
+
+enum class MessageHeader : uint8_t
+{
+    SCHEMA = 1,
+    DICTIONARY_BATCH = 2,
+    RECORD_BATCH = 3,
+};
+
+enum class ArrowType : uint8_t
+{
+    INT = 2,
+    FLOATING_POINT = 3,
+    BINARY = 4,
+    UTF8 = 5,
+    BOOL = 6,
+};
+
+constexpr int16_t ARROW_LITTLE_ENDIAN = 0;
+constexpr int16_t ARROW_PRECISION_SINGLE = 1;
+constexpr int16_t ARROW_PRECISION_DOUBLE = 2;
+/// Both FieldNode {length, null_count} and Buffer {offset, length} consist of two int64 values
+constexpr size_t SIZE_OF_NODE_AND_BUFFER = 2 * sizeof(int64_t);
+constexpr uint32_t CONTINUATION_MARKER = 0xFFFFFFFF;
+constexpr std::string_view ARROW_FILE_MAGIC = "ARROW1";
+constexpr size_t SIZE_OF_PADDED_ARROW_FILE_MAGIC = 8;
+
+std::span<const uint8_t> asBytes(const std::span<const int8_t> bytes)
+{
+    return {std::bit_cast<const uint8_t*>(bytes.data()), bytes.size()};
+}
+
+bool startsWithFileMagic(const std::span<const uint8_t> bytes)
+{
+    return bytes.size() >= ARROW_FILE_MAGIC.size()
+        and std::memcmp(bytes.data(), ARROW_FILE_MAGIC.data(), ARROW_FILE_MAGIC.size()) == 0;
+}
+
+/// The encapsulated message format: [<continuation: 0xFFFFFFFF>]<metadata size: int32><metadata: flatbuffer><body>
+/// Streams written before Arrow 0.15 omit the continuation marker.
+struct MessagePrefix
+{
+    size_t sizeOfPrefix;
+    size_t sizeOfMetadata;
+};
+
+/// Returns nullopt, if 'bytes' does not contain the full prefix
+std::optional<MessagePrefix> readMessagePrefix(const std::span<const uint8_t> bytes)
+{
+    if (bytes.size() < sizeof(uint32_t))
+    {
+        return std::nullopt;
+    }
+    size_t sizeOfPrefix = sizeof(uint32_t);
+    if (readLittleEndian<uint32_t>(bytes, 0) == CONTINUATION_MARKER)
+    {
+        if (bytes.size() < 2 * sizeof(uint32_t))
+        {
+            return std::nullopt;
+        }
+        sizeOfPrefix = 2 * sizeof(uint32_t);
+    }
+    const auto sizeOfMetadata = readLittleEndian<int32_t>(bytes, sizeOfPrefix - sizeof(int32_t));
+    if (sizeOfMetadata < 0)
+    {
+        throw CannotFormatSourceData("Arrow message is malformed: negative metadata size {}", sizeOfMetadata);
+    }
+    return MessagePrefix{.sizeOfPrefix = sizeOfPrefix, .sizeOfMetadata = static_cast<size_t>(sizeOfMetadata)};
+}
+
+FlatbufferTable getMessageTable(const std::span<const uint8_t> metadata)
+{
+    return FlatbufferTable{metadata, readLittleEndian<uint32_t>(metadata, 0)};
+}
+
+size_t getBodyLength(const FlatbufferTable& message)
+{
+    const auto bodyLength = message.getScalar<int64_t>(MessageSlot::BODY_LENGTH, 0);
+    if (bodyLength < 0)
+    {
+        throw CannotFormatSourceData("Arrow message is malformed: negative body length {}", bodyLength);
+    }
+    return static_cast<size_t>(bodyLength);
+}
+
+bool matchesIntType(const FlatbufferTable& type, const DataType& dataType)
+{
+    const auto bitWidth = type.getScalar<int32_t>(0, 0);
+    const auto isSigned = type.getScalar<uint8_t>(1, 0) != 0;
+    switch (dataType.type)
+    {
+        case DataType::Type::INT8:
+            return isSigned and bitWidth == 8;
+        case DataType::Type::INT16:
+            return isSigned and bitWidth == 16;
+        case DataType::Type::INT32:
+            return isSigned and bitWidth == 32;
+        case DataType::Type::INT64:
+            return isSigned and bitWidth == 64;
+        case DataType::Type::UINT8:
+            return not isSigned and bitWidth == 8;
+        case DataType::Type::UINT16:
+            return not isSigned and bitWidth == 16;
+        case DataType::Type::UINT32:
+            return not isSigned and bitWidth == 32;
+        case DataType::Type::UINT64:
+            return not isSigned and bitWidth == 64;
+        default:
+            return false;
+    }
+}
+
+bool matchesType(const uint8_t typeType, const std::optional<FlatbufferTable>& type, const DataType& dataType)
+{
+    switch (static_cast<ArrowType>(typeType))
+    {
+        case ArrowType::INT:
+            return type.has_value() and matchesIntType(*type, dataType);
+        case ArrowType::FLOATING_POINT: {
+            const auto precision = type.has_value() ? type->getScalar<int16_t>(0, 0) : 0;
+            return (precision == ARROW_PRECISION_SINGLE and dataType.type == DataType::Type::FLOAT32)
+                or (precision == ARROW_PRECISION_DOUBLE and dataType.type == DataType::Type::FLOAT64);
+        }
+        case ArrowType::BOOL:
+            return dataType.type == DataType::Type::BOOLEAN;
+        case ArrowType::BINARY:
+        case ArrowType::UTF8:
+            return dataType.type == DataType::Type::VARSIZED;
+    }
+    return false;
+}
+
+/// Builds the columns of one record batch, pointing into the body of the message wherever the layouts of Arrow and NES agree
+class RecordBatchBuilder
+{
+public:
+    RecordBatchBuilder(
+        const FlatbufferTable& recordBatch,
+        const std::span<const uint8_t> body,
+        const std::shared_ptr<const void>& storage,
+        const size_t numberOfFields)
+        : body(body)
+        , nodes(recordBatch.getVector(RecordBatchSlot::NODES, SIZE_OF_NODE_AND_BUFFER))
+        , buffers(recordBatch.getVector(RecordBatchSlot::BUFFERS, SIZE_OF_NODE_AND_BUFFER))
+    {
+        const auto length = recordBatch.getScalar<int64_t>(RecordBatchSlot::LENGTH, 0);
+        if (length < 0 or static_cast<uint64_t>(length) > std::numeric_limits<int32_t>::max())
+        {
+            throw CannotFormatSourceData("Arrow record batch has an invalid length: {}", length);
+        }
+        if (recordBatch.getTable(RecordBatchSlot::COMPRESSION).has_value())
+        {
+            throw CannotFormatSourceData("Compressed Arrow record batches are not supported");
+        }
+        if (not nodes.has_value() or nodes->size() != numberOfFields)
+        {
+            throw CannotFormatSourceData(
+                "Arrow record batch has {} field nodes, but the schema has {} fields",
+                nodes.has_value() ? nodes->size() : 0,
+                numberOfFields);
+        }
+        if (not buffers.has_value())
+        {
+            throw CannotFormatSourceData("Arrow record batch has no buffers");
+        }
+        batch.numberOfRows = static_cast<uint64_t>(length);
+        batch.columns.reserve(numberOfFields);
+        if (storage != nullptr)
+        {
+            batch.storage.emplace_back(storage);
+        }
+    }
+
+    void addColumn(const size_t fieldIndex, const DataType& dataType)
+    {
+        const auto numberOfRows = nodes->getStructMember<int64_t>(fieldIndex, SIZE_OF_NODE_AND_BUFFER, 0);
+        const auto nullCount = nodes->getStructMember<int64_t>(fieldIndex, SIZE_OF_NODE_AND_BUFFER, sizeof(int64_t));
+        if (numberOfRows < 0 or static_cast<uint64_t>(numberOfRows) != batch.numberOfRows)
+        {
+            throw CannotFormatSourceData(
+                "Arrow field {} has {} rows, but its record batch has {} rows", fieldIndex, numberOfRows, batch.numberOfRows);
+        }
+        if (nullCount > 0 and not dataType.nullable)
+        {
+            throw CannotFormatSourceData(
+                "Arrow field {} contains {} nulls, but the schema declares it as not nullable", fieldIndex, nullCount);
+        }
+
+        ArrowColumn column;
+        const auto validity = getNextBuffer();
+        if (batch.numberOfRows == 0)
+        {
+            /// Writers may omit the buffers of empty batches, e.g., the offsets of VARSIZED fields
+            nextBuffer += (dataType.type == DataType::Type::VARSIZED) ? 2 : 1;
+            batch.columns.emplace_back(column);
+            return;
+        }
+        column.nulls = (nullCount > 0) ? unpackBits(validity, true) : getAllValidColumn();
+        if (dataType.type == DataType::Type::VARSIZED)
+        {
+            const auto offsets = getNextBuffer();
+            const auto data = getNextBuffer();
+            column.offsets = getAlignedValues<int32_t>(offsets, batch.numberOfRows + 1);
+            validateOffsets(fieldIndex, column.offsets, data.size());
+            column.data = std::bit_cast<const int8_t*>(data.data());
+        }
+        else if (dataType.type == DataType::Type::BOOLEAN)
+        {
+            column.values = std::bit_cast<const int8_t*>(unpackBits(getNextBuffer(), false));
+        }
+        else
+        {
+            column.values = getAlignedValues(getNextBuffer(), batch.numberOfRows, dataType.getSizeInBytesWithoutNull());
+        }
+        batch.columns.emplace_back(column);
+    }
+
+    ArrowRecordBatch finalize()
+    {
+        if (nextBuffer != buffers->size())
+        {
+            throw CannotFormatSourceData("Arrow record batch has {} buffers, but its fields require {}", buffers->size(), nextBuffer);
+        }
+        return std::move(batch);
+    }
+
+private:
+    std::span<const uint8_t> getNextBuffer()
+    {
+        if (nextBuffer >= buffers->size())
+        {
+            throw CannotFormatSourceData("Arrow record batch has {} buffers, but its fields require more", buffers->size());
+        }
+        const auto offset = buffers->getStructMember<int64_t>(nextBuffer, SIZE_OF_NODE_AND_BUFFER, 0);
+        const auto length = buffers->getStructMember<int64_t>(nextBuffer, SIZE_OF_NODE_AND_BUFFER, sizeof(int64_t));
+        ++nextBuffer;
+        if (offset < 0 or length < 0 or static_cast<uint64_t>(offset) > body.size()
+            or static_cast<uint64_t>(length) > body.size() - static_cast<uint64_t>(offset))
+        {
+            throw CannotFormatSourceData(
+                "Arrow buffer (offset: {}, length: {}) exceeds the body of its record batch ({} bytes)", offset, length, body.size());
+        }
+        return body.subspan(static_cast<size_t>(offset), static_cast<size_t>(length));
+    }
+
+    template <typename T>
+    std::span<T> allocate(const size_t count)
+    {
+        auto memory = std::make_shared<T[]>(std::max<size_t>(count, 1)); /// NOLINT(modernize-avoid-c-arrays)
+        const std::span<T> values{memory.get(), count};
+        batch.storage.emplace_back(std::move(memory));
+        return values;
+    }
+
+    /// Unpacks the LSB-first bitmap of Arrow into one bool per row
+    /// Inverts the bits of validity bitmaps, since Arrow sets the bits of valid rows, whereas we flag null rows
+    const bool* unpackBits(const std::span<const uint8_t> bitmap, const bool invert)
+    {
+        if (bitmap.size() < (batch.numberOfRows + 7) / 8)
+        {
+            throw CannotFormatSourceData("Arrow bitmap of {} bytes is too small for {} rows", bitmap.size(), batch.numberOfRows);
+        }
+        auto unpacked = allocate<bool>(batch.numberOfRows);
+        for (size_t row = 0; row < batch.numberOfRows; ++row)
+        {
+            unpacked[row] = (((bitmap[row / 8] >> (row % 8)) & 1U) != 0) != invert;
+        }
+        return unpacked.data();
+    }
+
+    const bool* getAllValidColumn()
+    {
+        if (allValidColumn == nullptr)
+        {
+            allValidColumn = allocate<bool>(batch.numberOfRows).data();
+        }
+        return allValidColumn;
+    }
+
+    /// Points to the values in the body, if they are aligned. Otherwise, copies them into aligned memory owned by the batch.
+    const int8_t* getAlignedValues(const std::span<const uint8_t> values, const size_t numberOfValues, const size_t sizeOfValue)
+    {
+        if (values.size() / sizeOfValue < numberOfValues)
+        {
+            throw CannotFormatSourceData(
+                "Arrow buffer of {} bytes is too small for {} values of {} bytes", values.size(), numberOfValues, sizeOfValue);
+        }
+        if (std::bit_cast<uintptr_t>(values.data()) % sizeOfValue == 0)
+        {
+            return std::bit_cast<const int8_t*>(values.data());
+        }
+        auto aligned = allocate<uint64_t>(((numberOfValues * sizeOfValue) + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+        std::memcpy(aligned.data(), values.data(), numberOfValues * sizeOfValue);
+        return std::bit_cast<const int8_t*>(aligned.data());
+    }
+
+    template <typename T>
+    const T* getAlignedValues(const std::span<const uint8_t> values, const size_t numberOfValues)
+    {
+        return std::bit_cast<const T*>(getAlignedValues(values, numberOfValues, sizeof(T)));
+    }
+
+    void validateOffsets(const size_t fieldIndex, const int32_t* offsets, const size_t sizeOfData) const
+    {
+        for (size_t row = 0; row < batch.numberOfRows; ++row)
+        {
+            if (offsets[row] < 0 or offsets[row] > offsets[row + 1])
+            {
+                throw CannotFormatSourceData("Arrow field {} has invalid offsets at row {}", fieldIndex, row);
+            }
+        }
+        if (static_cast<size_t>(offsets[batch.numberOfRows]) > sizeOfData)
+        {
+            throw CannotFormatSourceData(
+                "Arrow field {} has offsets up to {}, but only {} bytes of data", fieldIndex, offsets[batch.numberOfRows], sizeOfData);
+        }
+    }
+
+    std::span<const uint8_t> body;
+    std::optional<FlatbufferVector> nodes;
+    std::optional<FlatbufferVector> buffers;
+    size_t nextBuffer = 0;
+    const bool* allValidColumn = nullptr;
+    ArrowRecordBatch batch;
+};
+
+}
+
+ArrowIPCStreamDecoder::ArrowIPCStreamDecoder(std::vector<DataType> schema) : schema(std::move(schema))
+{
+}
+
+size_t ArrowIPCStreamDecoder::getRequiredBytesOfMessage(const std::span<const int8_t> bytes) const
+{
+    const auto metadata = asBytes(bytes);
+    if (atStartOfStream and (metadata.size() < SIZE_OF_PADDED_ARROW_FILE_MAGIC or startsWithFileMagic(metadata)))
+    {
+        return SIZE_OF_PADDED_ARROW_FILE_MAGIC;
+    }
+    const auto prefix = readMessagePrefix(metadata);
+    if (not prefix.has_value())
+    {
+        return 2 * sizeof(uint32_t);
+    }
+    const auto sizeOfPrefixAndMetadata = prefix->sizeOfPrefix + prefix->sizeOfMetadata;
+    if (prefix->sizeOfMetadata == 0 or metadata.size() < sizeOfPrefixAndMetadata)
+    {
+        return sizeOfPrefixAndMetadata;
+    }
+    const auto bodyLength = getBodyLength(getMessageTable(metadata.subspan(prefix->sizeOfPrefix, prefix->sizeOfMetadata)));
+    if (bodyLength > std::numeric_limits<size_t>::max() - sizeOfPrefixAndMetadata)
+    {
+        throw CannotFormatSourceData("Arrow message is malformed: body length {} is too large", bodyLength);
+    }
+    return sizeOfPrefixAndMetadata + bodyLength;
+}
+
+void ArrowIPCStreamDecoder::decode(const std::span<const int8_t> bytes, std::vector<ArrowRecordBatch>& batches)
+{
+    size_t position = 0;
+    if (not pendingMessage.empty())
+    {
+        /// Only take the bytes that the pending message requires, since we can read the remaining bytes of the raw buffer in place
+        for (auto requiredBytes = getRequiredBytesOfMessage(pendingMessage); pendingMessage.size() < requiredBytes;
+             requiredBytes = getRequiredBytesOfMessage(pendingMessage))
+        {
+            const auto numberOfBytesToTake = std::min(requiredBytes - pendingMessage.size(), bytes.size() - position);
+            if (numberOfBytesToTake == 0)
+            {
+                return;
+            }
+            pendingMessage.insert(pendingMessage.end(), bytes.begin() + position, bytes.begin() + position + numberOfBytesToTake);
+            position += numberOfBytesToTake;
+        }
+        const auto completedMessage = std::make_shared<const std::vector<int8_t>>(std::exchange(pendingMessage, {}));
+        decodeMessage(*completedMessage, completedMessage, batches);
+    }
+
+    while (position < bytes.size() and not reachedEndOfStream)
+    {
+        const auto remainingBytes = bytes.subspan(position);
+        const auto requiredBytes = getRequiredBytesOfMessage(remainingBytes);
+        if (remainingBytes.size() < requiredBytes)
+        {
+            pendingMessage.assign(remainingBytes.begin(), remainingBytes.end());
+            return;
+        }
+        decodeMessage(remainingBytes.first(requiredBytes), nullptr, batches);
+        position += requiredBytes;
+    }
+}
+
+void ArrowIPCStreamDecoder::decodeMessage(
+    const std::span<const int8_t> bytes, const std::shared_ptr<const void>& storage, std::vector<ArrowRecordBatch>& batches)
+{
+    if (reachedEndOfStream)
+    {
+        return;
+    }
+    const auto messageBytes = asBytes(bytes);
+    if (std::exchange(atStartOfStream, false) and startsWithFileMagic(messageBytes))
+    {
+        return;
+    }
+
+    const auto prefix = readMessagePrefix(messageBytes);
+    INVARIANT(prefix.has_value(), "The decoder must only decode complete messages");
+    if (prefix->sizeOfMetadata == 0)
+    {
+        reachedEndOfStream = true;
+        return;
+    }
+    const auto metadata = messageBytes.subspan(prefix->sizeOfPrefix, prefix->sizeOfMetadata);
+    const auto message = getMessageTable(metadata);
+    const auto body = messageBytes.subspan(prefix->sizeOfPrefix + prefix->sizeOfMetadata);
+    const auto header = message.getTable(MessageSlot::HEADER);
+    if (not header.has_value())
+    {
+        throw CannotFormatSourceData("Arrow message has no header");
+    }
+
+    switch (const auto headerType = message.getScalar<uint8_t>(MessageSlot::HEADER_TYPE, 0); static_cast<MessageHeader>(headerType))
+    {
+        case MessageHeader::SCHEMA: {
+            if (std::exchange(receivedSchema, true))
+            {
+                throw CannotFormatSourceData("Arrow stream contains more than one schema");
+            }
+            if (header->getScalar<int16_t>(SchemaSlot::ENDIANNESS, ARROW_LITTLE_ENDIAN) != ARROW_LITTLE_ENDIAN)
+            {
+                throw CannotFormatSourceData("Big-endian Arrow streams are not supported");
+            }
+            const auto fields = header->getVector(SchemaSlot::FIELDS, sizeof(uint32_t));
+            if (not fields.has_value() or fields->size() != schema.size())
+            {
+                throw CannotFormatSourceData(
+                    "Arrow schema has {} fields, but the schema of the source has {} fields",
+                    fields.has_value() ? fields->size() : 0,
+                    schema.size());
+            }
+            for (size_t fieldIndex = 0; fieldIndex < schema.size(); ++fieldIndex)
+            {
+                const auto field = fields->getTable(fieldIndex);
+                if (field.getTable(FieldSlot::DICTIONARY).has_value())
+                {
+                    throw CannotFormatSourceData("Dictionary-encoded Arrow field {} is not supported", fieldIndex);
+                }
+                const auto typeType = field.getScalar<uint8_t>(FieldSlot::TYPE_TYPE, 0);
+                if (not matchesType(typeType, field.getTable(FieldSlot::TYPE), schema[fieldIndex]))
+                {
+                    throw CannotFormatSourceData(
+                        "Arrow field {} (type id: {}) does not match the type {} of the schema", fieldIndex, typeType, schema[fieldIndex]);
+                }
+            }
+            return;
+        }
+        case MessageHeader::RECORD_BATCH: {
+            if (not receivedSchema)
+            {
+                throw CannotFormatSourceData("Arrow stream contains a record batch before its schema");
+            }
+            RecordBatchBuilder builder{*header, body, storage, schema.size()};
+            for (size_t fieldIndex = 0; fieldIndex < schema.size(); ++fieldIndex)
+            {
+                builder.addColumn(fieldIndex, schema[fieldIndex]);
+            }
+            if (auto batch = builder.finalize(); batch.numberOfRows > 0)
+            {
+                batches.emplace_back(std::move(batch));
+            }
+            return;
+        }
+        case MessageHeader::DICTIONARY_BATCH:
+            throw CannotFormatSourceData("Arrow dictionary batches are not supported");
+        default:
+            throw CannotFormatSourceData("Arrow message has an unsupported header type {}", headerType);
+    }
+}
+
+}
@@ -0,0 +1,173 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <ArrowIPCInputFormatter.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <ranges>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <DataTypes/DataType.hpp>
+#include <Nautilus/DataTypes/DataTypesUtil.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/DataTypes/VariableSizedData.hpp>
+#include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Nautilus/Interface/RecordBuffer.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sources/SourceDescriptor.hpp>
+#include <fmt/format.h>
+#include <Arena.hpp>
+#include <ArrowIPCDecoder.hpp>
+#include <ErrorHandling.hpp>
+#include <ExecutionContext.hpp>
+#include <InputFormatIndexerRegistry.hpp>
+#include <RawTupleBuffer.hpp>
+#include <function.hpp>
+#include <val.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+thread_local std::vector<ArrowRecordBatch> ArrowIPCInputFormatter::tlDecodedBatches{};
+
+ArrowIPCInputFormatter::ArrowIPCInputFormatter(
+    const ParserConfig&, std::shared_ptr<TupleBufferRef> memoryProvider, const std::vector<Record::RecordFieldIdentifier>& projections)
+    : fieldNames(memoryProvider->getAllFieldNames())
+    , fieldDataTypes(memoryProvider->getAllDataTypes())
+    , projectedFields(
+          fieldNames | std::views::transform([&](const auto& fieldName) { return std::ranges::contains(projections, fieldName); })
+          | std::ranges::to<std::vector>())
+    , streamState(std::make_unique<StreamState>(fieldDataTypes))
+{
+    INVARIANT(fieldNames.size() == fieldDataTypes.size(), "No. fields must be equal to no. data types");
+}
+
+bool ArrowIPCInputFormatter::decodeBufferProxy(const TupleBuffer* tupleBuffer, const ArrowIPCInputFormatter* inputFormatter)
+{
+    tlDecodedBatches.clear();
+    auto& streamState = *inputFormatter->streamState;
+    const std::scoped_lock lock(streamState.mutex);
+    if (tupleBuffer->getSequenceNumber().getRawValue() != streamState.nextSequenceNumber)
+    {
+        return false;
+    }
+    const auto bufferView = RawTupleBuffer{*tupleBuffer}.getBufferView();
+    streamState.decoder.decode(std::span{std::bit_cast<const int8_t*>(bufferView.data()), bufferView.size()}, tlDecodedBatches);
+    ++streamState.nextSequenceNumber;
+    return true;
+}
+
+uint64_t ArrowIPCInputFormatter::getNumberOfBatchesProxy()
+{
+    return tlDecodedBatches.size();
+}
+
+uint64_t ArrowIPCInputFormatter::getNumberOfRowsProxy(const uint64_t batchIndex)
+{
+    return tlDecodedBatches[batchIndex].numberOfRows;
+}
+
+ArrowColumn* ArrowIPCInputFormatter::getColumnsProxy(const uint64_t batchIndex)
+{
+    return tlDecodedBatches[batchIndex].columns.data();
+}
+
+nautilus::val<bool> ArrowIPCInputFormatter::indexBuffer(const RecordBuffer& recordBuffer, const ArenaRef&) const
+{
+    return nautilus::invoke(decodeBufferProxy, recordBuffer.getReference(), nautilus::val<const ArrowIPCInputFormatter*>(this));
+}
+
+void ArrowIPCInputFormatter::readBuffer(
+    ExecutionContext& executionCtx,
+    const RecordBuffer&,
+    const std::function<void(ExecutionContext& executionCtx, Record& record)>& executeChild) const
+{
+    const nautilus::val<uint64_t> numberOfBatches = nautilus::invoke(getNumberOfBatchesProxy);
+    for (nautilus::val<uint64_t> batchIndex = 0; batchIndex < numberOfBatches; ++batchIndex)
+    {
+        const nautilus::val<uint64_t> numberOfRows = nautilus::invoke(getNumberOfRowsProxy, batchIndex);
+        const nautilus::val<int8_t*> columns = nautilus::invoke(getColumnsProxy, batchIndex);
+
+        /// Load the buffers of all columns once per batch, so that reading a record only reads its values
+        std::vector<nautilus::val<int8_t*>> values;
+        std::vector<nautilus::val<int8_t*>> nulls;
+        std::vector<nautilus::val<int8_t*>> offsets;
+        std::vector<nautilus::val<int8_t*>> data;
+        for (size_t i = 0; i < fieldDataTypes.size(); ++i)
+        {
+            const auto column = columns + nautilus::val<uint64_t>(i * sizeof(ArrowColumn));
+            values.emplace_back(*getMemberWithOffset<int8_t*>(column, offsetof(ArrowColumn, values)));
+            nulls.emplace_back(*getMemberWithOffset<int8_t*>(column, offsetof(ArrowColumn, nulls)));
+            offsets.emplace_back(*getMemberWithOffset<int8_t*>(column, offsetof(ArrowColumn, offsets)));
+            data.emplace_back(*getMemberWithOffset<int8_t*>(column, offsetof(ArrowColumn, data)));
+        }
+
+        for (nautilus::val<uint64_t> row = 0; row < numberOfRows; ++row)
+        {
+            Record record;
+            for (size_t i = 0; i < fieldDataTypes.size(); ++i)
+            {
+                if (not projectedFields[i])
+                {
+                    continue;
+                }
+                const auto& fieldDataType = fieldDataTypes[i];
+                const nautilus::val<bool> isNull
+                    = fieldDataType.nullable ? readValueFromMemRef<bool>(nulls[i] + row) : nautilus::val<bool>(false);
+                if (fieldDataType.type == DataType::Type::VARSIZED)
+                {
+                    const auto offsetOfValue = offsets[i] + (row * nautilus::val<uint64_t>(sizeof(int32_t)));
+                    const auto start = readValueFromMemRef<uint32_t>(offsetOfValue);
+                    const auto end = readValueFromMemRef<uint32_t>(offsetOfValue + nautilus::val<uint64_t>(sizeof(int32_t)));
+                    const auto sizeOfValue = static_cast<nautilus::val<uint64_t>>(end - start);
+                    record.write(fieldNames[i], VarVal{VariableSizedData{data[i] + start, sizeOfValue}, fieldDataType.nullable, isNull});
+                    continue;
+                }
+
+                const auto valuePtr = values[i] + (row * nautilus::val<uint64_t>(fieldDataType.getSizeInBytesWithoutNull()));
+                if (fieldDataType.nullable)
+                {
+                    record.write(fieldNames[i], VarVal::readVarValFromMemory(valuePtr, fieldDataType, isNull));
+                    continue;
+                }
+                record.write(fieldNames[i], VarVal::readNonNullableVarValFromMemory(valuePtr, fieldDataType));
+            }
+            executeChild(executionCtx, record);
+        }
+    }
+}
+
+std::ostream& ArrowIPCInputFormatter::toString(std::ostream& os) const
+{
+    return os << fmt::format("ArrowIPCInputFormatter(numberOfFields: {})", fieldDataTypes.size());
+}
+
+InputFormatIndexerRegistryReturnType
+RegisterArrowInputFormatIndexer(InputFormatIndexerRegistryArguments arguments) ///NOLINT(performance-unnecessary-value-param)
+{
+    return arguments.createInputFormatter<ArrowIPCInputFormatter>();
+}
+
+}
@@ -0,0 +1,400 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <CSVStructuralIndexer.hpp>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+#include <Util/Logger/Logger.hpp>
+#include <magic_enum/magic_enum.hpp>
+#include <ErrorHandling.hpp>
+#include <FieldIndexFunction.hpp>
+#include <FieldOffsets.hpp>
+
+#if defined(__x86_64__)
+    #include <immintrin.h>
+#elif defined(__aarch64__)
+    #include <arm_neon.h>
+#endif
+
+namespace NES
+{
+
+namespace
+{
+/// Every kernel classifies 64 bytes at once, which yields one 64-bit mask per class of structural characters
+constexpr size_t BLOCK_SIZE = 64;
+constexpr size_t SIZE_OF_TUPLE_DELIMITER = 1;
+constexpr size_t SIZE_OF_FIELD_DELIMITER = 1;
+constexpr char QUOTE = '"';
+
+struct BlockMasks
+{
+    uint64_t tupleDelimiters;
+    uint64_t fieldDelimiters;
+    uint64_t quotes;
+};
+
+/// Bit i of the result is the xor of the bits 0 to i of the input, i.e., a set quote bit toggles all following bits
+constexpr uint64_t prefixXorWithShifts(uint64_t bits)
+{
+    bits ^= bits << 1U;
+    bits ^= bits << 2U;
+    bits ^= bits << 4U;
+    bits ^= bits << 8U;
+    bits ^= bits << 16U;
+    bits ^= bits << 32U;
+    return bits;
+}
+
+class ScalarKernel
+{
+public:
+    ScalarKernel(const char tupleDelimiter, const char fieldDelimiter) : tupleDelimiter(tupleDelimiter), fieldDelimiter(fieldDelimiter) { }
+
+    [[nodiscard]] BlockMasks classify(const char* block) const
+    {
+        BlockMasks masks{};
+        for (size_t i = 0; i < BLOCK_SIZE; ++i)
+        {
+            masks.tupleDelimiters |= static_cast<uint64_t>(block[i] == tupleDelimiter) << i;
+            masks.fieldDelimiters |= static_cast<uint64_t>(block[i] == fieldDelimiter) << i;
+            masks.quotes |= static_cast<uint64_t>(block[i] == QUOTE) << i;
+        }
+        return masks;
+    }
+
+    static uint64_t prefixXor(const uint64_t quotes) { return prefixXorWithShifts(quotes); }
+
+private:
+    char tupleDelimiter;
+    char fieldDelimiter;
+};
+
+#if defined(__x86_64__)
+/// SSE2 is part of the x86-64 baseline
+class Sse2Kernel
+{
+public:
+    Sse2Kernel(const char tupleDelimiter, const char fieldDelimiter)
+        : tupleDelimiter(_mm_set1_epi8(tupleDelimiter)), fieldDelimiter(_mm_set1_epi8(fieldDelimiter)), quote(_mm_set1_epi8(QUOTE))
+    {
+    }
+
+    [[nodiscard]] BlockMasks classify(const char* block) const
+    {
+        BlockMasks masks{};
+        for (size_t chunk = 0; chunk < BLOCK_SIZE / sizeof(__m128i); ++chunk)
+        {
+            const auto bytes = _mm_loadu_si128(std::bit_cast<const __m128i*>(block + (chunk * sizeof(__m128i))));
+            const auto shift = chunk * sizeof(__m128i);
+            masks.tupleDelimiters |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, tupleDelimiter))))
+                << shift;
+            masks.fieldDelimiters |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, fieldDelimiter))))
+                << shift;
+            masks.quotes |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, quote)))) << shift;
+        }
+        return masks;
+    }
+
+    static uint64_t prefixXor(const uint64_t quotes) { return prefixXorWithShifts(quotes); }
+
+private:
+    __m128i tupleDelimiter;
+    __m128i fieldDelimiter;
+    __m128i quote;
+};
+
+class Avx2Kernel
+{
+public:
+    __attribute__((target("avx2"))) Avx2Kernel(const char tupleDelimiter, const char fieldDelimiter)
+        : tupleDelimiter(_mm256_set1_epi8(tupleDelimiter)), fieldDelimiter(_mm256_set1_epi8(fieldDelimiter)), quote(_mm256_set1_epi8(QUOTE))
+    {
+    }
+
+    [[nodiscard]] __attribute__((target("avx2"))) BlockMasks classify(const char* block) const
+    {
+        const auto lower = _mm256_loadu_si256(std::bit_cast<const __m256i*>(block));
+        const auto upper = _mm256_loadu_si256(std::bit_cast<const __m256i*>(block + sizeof(__m256i)));
+        return {
+            .tupleDelimiters = combine(_mm256_cmpeq_epi8(lower, tupleDelimiter), _mm256_cmpeq_epi8(upper, tupleDelimiter)),
+            .fieldDelimiters = combine(_mm256_cmpeq_epi8(lower, fieldDelimiter), _mm256_cmpeq_epi8(upper, fieldDelimiter)),
+            .quotes = combine(_mm256_cmpeq_epi8(lower, quote), _mm256_cmpeq_epi8(upper, quote))};
+    }
+
+    /// Multiplying the quote mask carry-less with a mask of all ones computes the prefix-xor in a single instruction
+    __attribute__((target("pclmul"))) static uint64_t prefixXor(const uint64_t quotes)
+    {
+        const auto product
+            = _mm_clmulepi64_si128(_mm_set_epi64x(0, static_cast<int64_t>(quotes)), _mm_set1_epi8(static_cast<char>(0xFF)), 0);
+        return static_cast<uint64_t>(_mm_cvtsi128_si64(product));
+    }
+
+private:
+    __attribute__((target("avx2"))) static uint64_t combine(const __m256i lower, const __m256i upper)
+    {
+        return static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(lower)))
+            | (static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(upper))) << 32U);
+    }
+
+    __m256i tupleDelimiter;
+    __m256i fieldDelimiter;
+    __m256i quote;
+};
+#endif
+
+#if defined(__aarch64__)
+/// NEON is part of the armv8-a baseline. NEON has no movemask, thus we weight the bytes of a comparison with their bit and add them up.
+class NeonKernel
+{
+public:
+    NeonKernel(const char tupleDelimiter, const char fieldDelimiter)
+        : tupleDelimiter(vdupq_n_u8(static_cast<uint8_t>(tupleDelimiter)))
+        , fieldDelimiter(vdupq_n_u8(static_cast<uint8_t>(fieldDelimiter)))
+        , quote(vdupq_n_u8(static_cast<uint8_t>(QUOTE)))
+    {
+    }
+
+    [[nodiscard]] BlockMasks classify(const char* block) const
+    {
+        const auto bytes = vld1q_u8_x4(std::bit_cast<const uint8_t*>(block));
+        return {
+            .tupleDelimiters = toBitmask(bytes, tupleDelimiter),
+            .fieldDelimiters = toBitmask(bytes, fieldDelimiter),
+            .quotes = toBitmask(bytes, quote)};
+    }
+
+    /// The carry-less multiply (vmull_p64) requires the optional crypto extension, thus we stay with the shifts
+    static uint64_t prefixXor(const uint64_t quotes) { return prefixXorWithShifts(quotes); }
+
+private:
+    static uint64_t toBitmask(const uint8x16x4_t& bytes, const uint8x16_t character)
+    {
+        constexpr std::array<uint8_t, 16> bitWeights{1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+        const auto weights = vld1q_u8(bitWeights.data());
+        const auto first = vandq_u8(vceqq_u8(bytes.val[0], character), weights);
+        const auto second = vandq_u8(vceqq_u8(bytes.val[1], character), weights);
+        const auto third = vandq_u8(vceqq_u8(bytes.val[2], character), weights);
+        const auto fourth = vandq_u8(vceqq_u8(bytes.val[3], character), weights);
+        auto sum = vpaddq_u8(vpaddq_u8(first, second), vpaddq_u8(third, fourth));
+        sum = vpaddq_u8(sum, sum);
+        return vgetq_lane_u64(vreinterpretq_u64_u8(sum), 0);
+    }
+
+    uint8x16_t tupleDelimiter;
+    uint8x16_t fieldDelimiter;
+    uint8x16_t quote;
+};
+#endif
+
+template <typename Kernel>
+[[gnu::always_inline]] inline void indexBlocks(
+    FieldOffsets<NumRequiredOffsetsPerField::ONE>& fieldOffsets,
+    const std::string_view buffer,
+    const CSVStructure& structure,
+    const Kernel& kernel)
+{
+    constexpr auto noTupleDelimiter = std::numeric_limits<FieldIndex>::max();
+    FieldIndex offsetOfFirstTupleDelimiter = noTupleDelimiter;
+    FieldIndex offsetOfLastTupleDelimiter = noTupleDelimiter;
+    size_t numberOfFieldsOfTuple = 0;
+    /// The offsets that belong to tuples that are terminated by a tuple delimiter
+    size_t numberOfOffsetsOfCompleteTuples = 0;
+    /// All ones, if the previous block ended between quotes
+    uint64_t quoteCarry = 0;
+
+    for (size_t blockStart = 0; blockStart < buffer.size(); blockStart += BLOCK_SIZE)
+    {
+        BlockMasks masks{};
+        if (const auto remainingBytes = buffer.size() - blockStart; remainingBytes >= BLOCK_SIZE)
+        {
+            masks = kernel.classify(buffer.data() + blockStart);
+        }
+        else
+        {
+            std::array<char, BLOCK_SIZE> lastBlock{};
+            std::memcpy(lastBlock.data(), buffer.data() + blockStart, remainingBytes);
+            masks = kernel.classify(lastBlock.data());
+            const uint64_t bytesOfBuffer = (uint64_t{1} << remainingBytes) - 1;
+            masks.tupleDelimiters &= bytesOfBuffer;
+            masks.fieldDelimiters &= bytesOfBuffer;
+            masks.quotes &= bytesOfBuffer;
+        }
+
+        uint64_t fieldDelimiters = masks.fieldDelimiters;
+        if (structure.allowCommasInStrings)
+        {
+            uint64_t quoted = Kernel::prefixXor(masks.quotes) ^ quoteCarry;
+            /// A tuple with an odd number of quotes must not affect the next tuple. Thus, every tuple delimiter between quotes resets the
+            /// quote state, by toggling all following bits
+            for (uint64_t quotedTupleDelimiters = masks.tupleDelimiters & quoted; quotedTupleDelimiters != 0;
+                 quotedTupleDelimiters = masks.tupleDelimiters & quoted)
+            {
+                quoted ^= ~uint64_t{0} << std::countr_zero(quotedTupleDelimiters);
+            }
+            fieldDelimiters &= ~quoted;
+            quoteCarry = uint64_t{0} - (quoted >> 63U);
+        }
+
+        for (uint64_t delimiters = fieldDelimiters | masks.tupleDelimiters; delimiters != 0; delimiters &= delimiters - 1)
+        {
+            const auto positionInBlock = std::countr_zero(delimiters);
+            const auto offset = static_cast<FieldIndex>(blockStart + positionInBlock);
+            if (((masks.tupleDelimiters >> positionInBlock) & 1U) == 0)
+            {
+                /// The position of the field delimiter (+ size of field delimiter) is the beginning of the next field.
+                /// We skip the fields of the leading spanning tuple, i.e., before the first tuple delimiter.
+                if (offsetOfFirstTupleDelimiter != noTupleDelimiter)
+                {
+                    fieldOffsets.emplaceFieldOffset(offset + SIZE_OF_FIELD_DELIMITER);
+                    ++numberOfFieldsOfTuple;
+                }
+                continue;
+            }
+
+            if (offsetOfFirstTupleDelimiter == noTupleDelimiter)
+            {
+                offsetOfFirstTupleDelimiter = offset;
+            }
+            else
+            {
+                /// The last offset of a tuple is the offset of its tuple delimiter, which allows the next phase to determine the last
+                /// field without any extra calculations
+                fieldOffsets.emplaceFieldOffset(offset);
+                if (numberOfFieldsOfTuple != structure.numberOfFields)
+                {
+                    throw CannotFormatSourceData(
+                        "Number of parsed fields does not match number of fields in schema (parsed {} vs {} schema",
+                        numberOfFieldsOfTuple,
+                        structure.numberOfFields);
+                }
+                numberOfOffsetsOfCompleteTuples += numberOfFieldsOfTuple + 1;
+            }
+            /// The start of the next tuple is the offset of its first field
+            offsetOfLastTupleDelimiter = offset;
+            fieldOffsets.emplaceFieldOffset(offset + SIZE_OF_TUPLE_DELIMITER);
+            numberOfFieldsOfTuple = 1;
+        }
+    }
+
+    /// If the buffer does not contain a delimiter, set the 'offsetOfFirstTupleDelimiter' to a value larger than the buffer size to tell
+    /// the InputFormatIndexerTask that there was no tuple delimiter in the buffer
+    if (offsetOfFirstTupleDelimiter == noTupleDelimiter)
+    {
+        fieldOffsets.markNoTupleDelimiters();
+        return;
+    }
+    /// The fields after the last tuple delimiter belong to the trailing spanning tuple
+    fieldOffsets.truncateFieldOffsets(numberOfOffsetsOfCompleteTuples);
+    fieldOffsets.markWithTupleDelimiters(offsetOfFirstTupleDelimiter, offsetOfLastTupleDelimiter);
+}
+
+void indexWithScalarKernel(
+    FieldOffsets<NumRequiredOffsetsPerField::ONE>& fieldOffsets, const std::string_view buffer, const CSVStructure& structure)
+{
+    indexBlocks(fieldOffsets, buffer, structure, ScalarKernel{structure.tupleDelimiter, structure.fieldDelimiter});
+}
+
+#if defined(__x86_64__)
+void indexWithSse2Kernel(
+    FieldOffsets<NumRequiredOffsetsPerField::ONE>& fieldOffsets, const std::string_view buffer, const CSVStructure& structure)
+{
+    indexBlocks(fieldOffsets, buffer, structure, Sse2Kernel{structure.tupleDelimiter, structure.fieldDelimiter});
+}
+
+__attribute__((target("avx2,pclmul"))) void indexWithAvx2Kernel(
+    FieldOffsets<NumRequiredOffsetsPerField::ONE>& fieldOffsets, const std::string_view buffer, const CSVStructure& structure)
+{
+    indexBlocks(fieldOffsets, buffer, structure, Avx2Kernel{structure.tupleDelimiter, structure.fieldDelimiter});
+}
+#endif
+
+#if defined(__aarch64__)
+void indexWithNeonKernel(
+    FieldOffsets<NumRequiredOffsetsPerField::ONE>& fieldOffsets, const std::string_view buffer, const CSVStructure& structure)
+{
+    indexBlocks(fieldOffsets, buffer, structure, NeonKernel{structure.tupleDelimiter, structure.fieldDelimiter});
+}
+#endif
+}
+
+std::vector<CSVClassificationKernel> getSupportedCSVClassificationKernels()
+{
+    std::vector supportedKernels{CSVClassificationKernel::SCALAR};
+#if defined(__x86_64__)
+    supportedKernels.emplace_back(CSVClassificationKernel::SSE2);
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") and __builtin_cpu_supports("pclmul"))
+    {
+        supportedKernels.emplace_back(CSVClassificationKernel::AVX2);
+    }
+#elif defined(__aarch64__)
+    supportedKernels.emplace_back(CSVClassificationKernel::NEON);
+#endif
+    return supportedKernels;
+}
+
+CSVClassificationKernel getCSVClassificationKernel()
+{
+    /// The supported kernels are ordered by their speed
+    static const CSVClassificationKernel kernel = []
+    {
+        const auto detected = getSupportedCSVClassificationKernels().back();
+        NES_DEBUG("Using the {} kernel to index CSV buffers", magic_enum::enum_name(detected));
+        return detected;
+    }();
+    return kernel;
+}
+
+void indexCSVStructure(
+    FieldOffsets<NumRequiredOffsetsPerField::ONE>& fieldOffsets,
+    const std::string_view buffer,
+    const CSVStructure& structure,
+    const CSVClassificationKernel kernel)
+{
+    PRECONDITION(
+        buffer.size() < std::numeric_limits<FieldIndex>::max(),
+        "The buffer of size {} exceeds the range of the field index",
+        buffer.size());
+    switch (kernel)
+    {
+        case CSVClassificationKernel::SCALAR:
+            indexWithScalarKernel(fieldOffsets, buffer, structure);
+            return;
+#if defined(__x86_64__)
+        case CSVClassificationKernel::SSE2:
+            indexWithSse2Kernel(fieldOffsets, buffer, structure);
+            return;
+        case CSVClassificationKernel::AVX2:
+            indexWithAvx2Kernel(fieldOffsets, buffer, structure);
+            return;
+#elif defined(__aarch64__)
+        case CSVClassificationKernel::NEON:
+            indexWithNeonKernel(fieldOffsets, buffer, structure);
+            return;
+#endif
+        default:
+            throw UnknownOperation("The CSV classification kernel {} is not available on this cpu", magic_enum::enum_name(kernel));
+    }
+}
+
+}
@@ -0,0 +1,146 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <ColumnStatisticsCollector.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+#include <Aggregation/Function/HyperLogLog.hpp>
+#include <DataTypes/DataType.hpp>
+#include <Sources/ColumnStatistics.hpp>
+#include <folly/hash/Hash.h>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+ColumnStatisticsCollector::Column::Column(const bool isNumeric)
+    : isNumeric(isNumeric), min(0), max(0), distinctValues(std::make_unique<HyperLogLog>())
+{
+}
+
+ColumnStatisticsCollector::Column::~Column() = default;
+
+void ColumnStatisticsCollector::Column::sample(const bool isNull, const double value, const uint64_t hash)
+{
+    const std::scoped_lock lock(mutex);
+    ++numberOfSampledValues;
+    if (isNull)
+    {
+        ++numberOfNullValues;
+        return;
+    }
+    ++numberOfNonNullValues;
+    if (not isNumeric)
+    {
+        distinctValues->add(hash);
+        return;
+    }
+
+    /// 0.0 and -0.0 are the same value
+    distinctValues->add(folly::hash::twang_mix64(std::bit_cast<uint64_t>(value == 0 ? 0.0 : value)));
+    min = numberOfNonNullValues == 1 ? value : std::min(min, value);
+    max = numberOfNonNullValues == 1 ? value : std::max(max, value);
+    /// Reservoir sampling (Algorithm R): the i-th value replaces a random value of the reservoir with a probability of RESERVOIR_SIZE / i
+    if (reservoir.size() < RESERVOIR_SIZE)
+    {
+        reservoir.push_back(value);
+        return;
+    }
+    if (const auto position = std::uniform_int_distribution<uint64_t>(0, numberOfNonNullValues - 1)(random); position < RESERVOIR_SIZE)
+    {
+        reservoir[position] = value;
+    }
+}
+
+ColumnStatistics ColumnStatisticsCollector::Column::getStatistics() const
+{
+    std::vector<double> sortedValues;
+    ColumnStatistics statistics;
+    {
+        const std::scoped_lock lock(mutex);
+        statistics.numberOfSampledValues = numberOfSampledValues;
+        statistics.numberOfNullValues = numberOfNullValues;
+        statistics.approximateNumberOfDistinctValues = distinctValues->estimate();
+        if (not isNumeric or numberOfNonNullValues == 0)
+        {
+            return statistics;
+        }
+        statistics.min = min;
+        statistics.max = max;
+        sortedValues = reservoir;
+    }
+
+    /// The reservoir is a uniform sample of all values, thus, its quantiles approximate the quantiles of all values
+    std::ranges::sort(sortedValues);
+    statistics.histogramBounds.reserve(NUMBER_OF_HISTOGRAM_BUCKETS + 1);
+    for (size_t bucket = 0; bucket <= NUMBER_OF_HISTOGRAM_BUCKETS; ++bucket)
+    {
+        const auto position = bucket * (sortedValues.size() - 1) / NUMBER_OF_HISTOGRAM_BUCKETS;
+        statistics.histogramBounds.push_back(sortedValues[position]);
+    }
+    /// The reservoir might have dropped the extreme values
+    statistics.histogramBounds.front() = *statistics.min;
+    statistics.histogramBounds.back() = *statistics.max;
+    return statistics;
+}
+
+ColumnStatisticsCollector::ColumnStatisticsCollector(const uint64_t samplingInterval) : samplingInterval(samplingInterval)
+{
+    PRECONDITION(samplingInterval > 0, "The sampling interval of the column statistics must be positive");
+}
+
+std::shared_ptr<ColumnStatisticsCollector::Column>
+ColumnStatisticsCollector::getColumn(const std::string& fieldName, const DataType& dataType)
+{
+    PRECONDITION(isSampled(dataType), "Can not sample the values of field {} of type {}", fieldName, dataType);
+    auto lockedColumns = columns.wlock();
+    auto& column = (*lockedColumns)[fieldName];
+    if (not column)
+    {
+        column = std::make_shared<Column>(dataType.isNumeric());
+    }
+    return column;
+}
+
+std::optional<ColumnStatistics> ColumnStatisticsCollector::getColumnStatistics(const std::string& fieldName) const
+{
+    /// Copying the pointer allows to compute the statistics without holding the lock of all columns
+    const auto column = [&]() -> std::shared_ptr<Column>
+    {
+        const auto lockedColumns = columns.rlock();
+        const auto found = lockedColumns->find(fieldName);
+        return found == lockedColumns->end() ? nullptr : found->second;
+    }();
+    if (not column)
+    {
+        return std::nullopt;
+    }
+    return column->getStatistics();
+}
+
+bool ColumnStatisticsCollector::isSampled(const DataType& dataType)
+{
+    return dataType.isNumeric() or dataType.isType(DataType::Type::VARSIZED);
+}
+
+}
@@ -14,20 +14,134 @@
 
 #include <InputFormatterTupleBufferRef.hpp>
 
+#include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <ostream>
+#include <ranges>
+#include <utility>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/Hash/MurMur3HashFunction.hpp>
+#include <Nautilus/Interface/Record.hpp>
 #include <Nautilus/Interface/RecordBuffer.hpp>
+#include <nautilus/function.hpp>
 #include <Arena.hpp>
+#include <ColumnStatisticsCollector.hpp>
+#include <ErrorHandling.hpp>
 #include <ExecutionContext.hpp>
 #include <val.hpp>
+#include <val_ptr.hpp>
 
 namespace NES
 {
 
+namespace
+{
+void sampleValueProxy(ColumnStatisticsCollector::Column* column, const bool isNull, const double value, const uint64_t hash)
+{
+    column->sample(isNull, value, hash);
+}
+}
+
 void InputFormatterTupleBufferRef::readBuffer(
     ExecutionContext& executionCtx, const RecordBuffer& recordBuffer, const ExecuteChildFn& executeChild) const
 {
-    this->inputFormatter->readBuffer(executionCtx, recordBuffer, executeChild);
+    if (sampledFields.empty())
+    {
+        this->inputFormatter->readBuffer(executionCtx, recordBuffer, executeChild);
+        return;
+    }
+
+    /// Wrapping the child samples the records of all formatters alike, regardless of where in a buffer they find the records
+    nautilus::val<uint64_t> recordIndex = 0;
+    this->inputFormatter->readBuffer(
+        executionCtx,
+        recordBuffer,
+        [&](ExecutionContext& childExecutionCtx, Record& record)
+        {
+            if (recordIndex % nautilus::val<uint64_t>(samplingInterval) == 0)
+            {
+                sampleRecord(record);
+            }
+            recordIndex += 1;
+            executeChild(childExecutionCtx, record);
+        });
+}
+
+bool InputFormatterTupleBufferRef::supportsLateMaterialization() const
+{
+    /// Sampling requires all projected fields of every sampled record, regardless of the predicate
+    return sampledFields.empty() and this->inputFormatter->supportsLazyReads();
+}
+
+void InputFormatterTupleBufferRef::readBufferWithPredicate(
+    ExecutionContext& executionCtx,
+    const RecordBuffer& recordBuffer,
+    const std::vector<Record::RecordFieldIdentifier>& predicateFields,
+    const PredicateFn& predicate,
+    const ExecuteChildFn& executeChild) const
+{
+    PRECONDITION(supportsLateMaterialization(), "The input formatter does not support late materialization");
+    const auto remainingFields = projectedFields | std::views::keys
+        | std::views::filter([&](const auto& fieldName) { return not std::ranges::contains(predicateFields, fieldName); })
+        | std::ranges::to<std::vector<Record::RecordFieldIdentifier>>();
+    this->inputFormatter->readBufferLazily(
+        executionCtx,
+        recordBuffer,
+        [&](ExecutionContext& childExecutionCtx, const ReadFieldsFn& readFields)
+        {
+            auto record = readFields(predicateFields);
+            if (predicate(childExecutionCtx, record))
+            {
+                record.reassignFields(readFields(remainingFields));
+                executeChild(childExecutionCtx, record);
+            }
+        });
+}
+
+void InputFormatterTupleBufferRef::setProjectedFields(std::vector<std::pair<Record::RecordFieldIdentifier, DataType>> projectedFields)
+{
+    this->projectedFields = std::move(projectedFields);
+}
+
+void InputFormatterTupleBufferRef::sampleColumnStatistics(ColumnStatisticsCollector& columnStatistics)
+{
+    sampledFields.clear();
+    for (const auto& [fieldName, dataType] : projectedFields)
+    {
+        if (ColumnStatisticsCollector::isSampled(dataType))
+        {
+            sampledFields.push_back({fieldName, dataType, columnStatistics.getColumn(fieldName, dataType)});
+        }
+    }
+    samplingInterval = columnStatistics.getSamplingInterval();
+}
+
+void InputFormatterTupleBufferRef::sampleRecord(const Record& record) const
+{
+    for (const auto& [fieldName, dataType, column] : sampledFields)
+    {
+        const auto& value = record.read(fieldName);
+        const auto isNull = dataType.nullable ? value.isNull() : nautilus::val<bool>(false);
+        auto numericValue = nautilus::val<double>(0);
+        auto hash = nautilus::val<uint64_t>(0);
+        if (dataType.isNumeric())
+        {
+            numericValue = value.castToType(DataType::Type::FLOAT64).getRawValueAs<nautilus::val<double>>();
+        }
+        else
+        {
+            hash = MurMur3HashFunction().calculate(value);
+        }
+        nautilus::invoke(
+            sampleValueProxy,
+            nautilus::val<ColumnStatisticsCollector::Column*>(column.get()),
+            isNull,
+            numericValue,
+            hash);
+    }
 }
 
 nautilus::val<bool> InputFormatterTupleBufferRef::indexBuffer(RecordBuffer& recordBuffer, ArenaRef& arenaRef) const
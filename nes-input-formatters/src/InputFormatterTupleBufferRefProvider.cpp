@@ -14,11 +14,16 @@
 
 #include <InputFormatterTupleBufferRefProvider.hpp>
 
+#include <algorithm>
 #include <memory>
+#include <ranges>
 #include <utility>
+#include <vector>
 
+#include <DataTypes/DataType.hpp>
 #include <DataTypes/Schema.hpp>
 #include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
+#include <Nautilus/Interface/Record.hpp>
 #include <Sources/SourceDescriptor.hpp>
 #include <ErrorHandling.hpp>
 #include <InputFormatIndexerRegistry.hpp>
@@ -27,12 +32,24 @@
 namespace NES
 {
 
-std::shared_ptr<InputFormatterTupleBufferRef>
-provideInputFormatterTupleBufferRef(ParserConfig formatScanConfig, std::shared_ptr<TupleBufferRef> memoryProvider)
+std::shared_ptr<InputFormatterTupleBufferRef> provideInputFormatterTupleBufferRef(
+    ParserConfig formatScanConfig,
+    std::shared_ptr<TupleBufferRef> memoryProvider,
+    std::vector<Record::RecordFieldIdentifier> projections)
 {
+    std::vector<std::pair<Record::RecordFieldIdentifier, DataType>> projectedFields;
+    for (const auto& [fieldName, dataType] : std::views::zip(memoryProvider->getAllFieldNames(), memoryProvider->getAllDataTypes()))
+    {
+        if (std::ranges::contains(projections, fieldName))
+        {
+            projectedFields.emplace_back(fieldName, dataType);
+        }
+    }
     if (auto inputFormatter = InputFormatIndexerRegistry::instance().create(
-            formatScanConfig.parserType, InputFormatIndexerRegistryArguments(formatScanConfig, std::move(memoryProvider))))
+            formatScanConfig.parserType,
+            InputFormatIndexerRegistryArguments(formatScanConfig, std::move(memoryProvider), std::move(projections))))
     {
+        inputFormatter.value()->setProjectedFields(std::move(projectedFields));
         return std::move(inputFormatter.value());
     }
     throw UnknownParserType("unknown type of input formatter: {}", formatScanConfig.parserType);
@@ -0,0 +1,210 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <NativeFrameDecoder.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <DataTypes/DataType.hpp>
+#include <Runtime/NativeFrameHeader.hpp>
+#include <Runtime/VariableSizedAccess.hpp>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+namespace
+{
+template <typename T>
+T readFromBytes(const std::span<const int8_t> bytes, const size_t position)
+{
+    INVARIANT(position + sizeof(T) <= bytes.size(), "Cannot read {} bytes at position {} of {} bytes", sizeof(T), position, bytes.size());
+    T value;
+    std::memcpy(static_cast<void*>(&value), bytes.data() + position, sizeof(T));
+    return value;
+}
+
+size_t addWithoutOverflow(const size_t lhs, const size_t rhs)
+{
+    if (lhs > std::numeric_limits<size_t>::max() - rhs)
+    {
+        throw CannotFormatSourceData("Native frame is malformed: its size exceeds the address space");
+    }
+    return lhs + rhs;
+}
+}
+
+NativeFrameDecoder::NativeFrameDecoder(const std::vector<DataType>& schema)
+{
+    for (const auto& dataType : schema)
+    {
+        if (dataType.nullable or dataType.type == DataType::Type::VARSIZED)
+        {
+            checkedFields.emplace_back(sizeOfTuple, dataType.nullable, dataType.type == DataType::Type::VARSIZED);
+        }
+        sizeOfTuple += dataType.getSizeInBytesWithNull();
+    }
+    PRECONDITION(sizeOfTuple > 0, "The native format requires a schema with at least one field");
+}
+
+size_t NativeFrameDecoder::getRequiredBytesOfFrame(const std::span<const int8_t> bytes) const
+{
+    if (bytes.size() < sizeof(NativeFrameHeader))
+    {
+        return sizeof(NativeFrameHeader);
+    }
+    const auto header = readFromBytes<NativeFrameHeader>(bytes, 0);
+    if (header.magic != NativeFrameHeader::MAGIC)
+    {
+        throw CannotFormatSourceData(
+            "Native frame is malformed: expected magic {:#x}, but got {:#x}", NativeFrameHeader::MAGIC, header.magic);
+    }
+    if (header.sizeOfTuple != sizeOfTuple)
+    {
+        throw CannotFormatSourceData(
+            "Native frame contains tuples of {} bytes, but the schema of the source requires tuples of {} bytes",
+            header.sizeOfTuple,
+            sizeOfTuple);
+    }
+    if (header.numberOfTuples > (std::numeric_limits<size_t>::max() - sizeof(NativeFrameHeader)) / sizeOfTuple)
+    {
+        throw CannotFormatSourceData("Native frame is malformed: {} tuples exceed the address space", header.numberOfTuples);
+    }
+
+    /// The size of a frame depends on the sizes of its child buffers, which we only know after reading the prior child buffers
+    auto requiredBytes = sizeof(NativeFrameHeader) + (header.numberOfTuples * sizeOfTuple);
+    for (uint64_t childIndex = 0; childIndex < header.numberOfChildBuffers; ++childIndex)
+    {
+        requiredBytes = addWithoutOverflow(requiredBytes, sizeof(uint64_t));
+        if (bytes.size() < requiredBytes)
+        {
+            return requiredBytes;
+        }
+        requiredBytes = addWithoutOverflow(requiredBytes, readFromBytes<uint64_t>(bytes, requiredBytes - sizeof(uint64_t)));
+    }
+    return requiredBytes;
+}
+
+void NativeFrameDecoder::decode(const std::span<const int8_t> bytes, std::vector<NativeFrame>& frames)
+{
+    size_t position = 0;
+    if (not pendingFrame.empty())
+    {
+        /// Only take the bytes that the pending frame requires, since we can read the remaining bytes of the raw buffer in place
+        for (auto requiredBytes = getRequiredBytesOfFrame(pendingFrame); pendingFrame.size() < requiredBytes;
+             requiredBytes = getRequiredBytesOfFrame(pendingFrame))
+        {
+            const auto numberOfBytesToTake = std::min(requiredBytes - pendingFrame.size(), bytes.size() - position);
+            if (numberOfBytesToTake == 0)
+            {
+                return;
+            }
+            pendingFrame.insert(pendingFrame.end(), bytes.begin() + position, bytes.begin() + position + numberOfBytesToTake);
+            position += numberOfBytesToTake;
+        }
+        const auto completedFrame = std::make_shared<const std::vector<int8_t>>(std::exchange(pendingFrame, {}));
+        decodeFrame(*completedFrame, completedFrame, frames);
+    }
+
+    while (position < bytes.size())
+    {
+        const auto remainingBytes = bytes.subspan(position);
+        const auto requiredBytes = getRequiredBytesOfFrame(remainingBytes);
+        if (remainingBytes.size() < requiredBytes)
+        {
+            pendingFrame.assign(remainingBytes.begin(), remainingBytes.end());
+            return;
+        }
+        decodeFrame(remainingBytes.first(requiredBytes), nullptr, frames);
+        position += requiredBytes;
+    }
+}
+
+void NativeFrameDecoder::decodeFrame(
+    const std::span<const int8_t> bytes, const std::shared_ptr<const void>& storage, std::vector<NativeFrame>& frames) const
+{
+    const auto header = readFromBytes<NativeFrameHeader>(bytes, 0);
+    const auto tuples = bytes.subspan(sizeof(NativeFrameHeader), header.numberOfTuples * sizeOfTuple);
+    std::vector<std::span<const int8_t>> childBuffers;
+    childBuffers.reserve(header.numberOfChildBuffers);
+    for (auto position = sizeof(NativeFrameHeader) + tuples.size(); position < bytes.size();)
+    {
+        const auto sizeOfChildBuffer = readFromBytes<uint64_t>(bytes, position);
+        childBuffers.emplace_back(bytes.subspan(position + sizeof(uint64_t), sizeOfChildBuffer));
+        position += sizeof(uint64_t) + sizeOfChildBuffer;
+    }
+    INVARIANT(childBuffers.size() == header.numberOfChildBuffers, "The decoder must only decode complete frames");
+
+    /// The parser reads the null flags as booleans and the VARSIZED values without bounds checks, thus, we check them once per frame
+    for (uint64_t tupleIndex = 0; tupleIndex < header.numberOfTuples; ++tupleIndex)
+    {
+        const auto tuple = tuples.subspan(tupleIndex * sizeOfTuple, sizeOfTuple);
+        for (const auto& [offset, nullable, varSized] : checkedFields)
+        {
+            if (nullable)
+            {
+                const auto nullFlag = readFromBytes<uint8_t>(tuple, offset);
+                if (nullFlag > 1)
+                {
+                    throw CannotFormatSourceData("Native frame contains an invalid null flag {} in tuple {}", nullFlag, tupleIndex);
+                }
+                if (nullFlag == 1 or not varSized)
+                {
+                    continue;
+                }
+            }
+            const auto access = readFromBytes<VariableSizedAccess>(tuple, offset + static_cast<size_t>(nullable));
+            if (access.isInlined())
+            {
+                continue;
+            }
+            const auto childIndex = access.getIndex().getRawIndex();
+            const auto offsetInChild = access.getOffset().getRawOffset();
+            const auto sizeOfValue = access.getSize().getRawSize();
+            if (childIndex >= childBuffers.size() or offsetInChild > childBuffers[childIndex].size()
+                or sizeOfValue > childBuffers[childIndex].size() - offsetInChild)
+            {
+                throw CannotFormatSourceData(
+                    "Native frame contains a VARSIZED value of tuple {} that does not lie in one of its {} child buffers",
+                    tupleIndex,
+                    childBuffers.size());
+            }
+        }
+    }
+
+    if (header.numberOfTuples == 0)
+    {
+        return;
+    }
+    NativeFrame frame;
+    frame.numberOfTuples = header.numberOfTuples;
+    frame.tuples = tuples.data();
+    frame.childBuffers.reserve(childBuffers.size());
+    for (const auto& childBuffer : childBuffers)
+    {
+        frame.childBuffers.emplace_back(childBuffer.data());
+    }
+    frame.storage = storage;
+    frames.emplace_back(std::move(frame));
+}
+
+}
@@ -0,0 +1,189 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <NativeInputFormatter.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <ranges>
+#include <span>
+#include <vector>
+
+#include <DataTypes/DataType.hpp>
+#include <Nautilus/DataTypes/DataTypesUtil.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/DataTypes/VariableSizedData.hpp>
+#include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Nautilus/Interface/RecordBuffer.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Runtime/VariableSizedAccess.hpp>
+#include <Sources/SourceDescriptor.hpp>
+#include <fmt/format.h>
+#include <Arena.hpp>
+#include <ErrorHandling.hpp>
+#include <ExecutionContext.hpp>
+#include <InputFormatIndexerRegistry.hpp>
+#include <NativeFrameDecoder.hpp>
+#include <RawTupleBuffer.hpp>
+#include <function.hpp>
+#include <val.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+thread_local std::vector<NativeFrame> NativeInputFormatter::tlDecodedFrames{};
+
+NativeInputFormatter::NativeInputFormatter(
+    const ParserConfig&, std::shared_ptr<TupleBufferRef> memoryProvider, const std::vector<Record::RecordFieldIdentifier>& projections)
+    : fieldNames(memoryProvider->getAllFieldNames())
+    , fieldDataTypes(memoryProvider->getAllDataTypes())
+    , projectedFields(
+          fieldNames | std::views::transform([&](const auto& fieldName) { return std::ranges::contains(projections, fieldName); })
+          | std::ranges::to<std::vector>())
+    , streamState(std::make_unique<StreamState>(fieldDataTypes))
+{
+    INVARIANT(fieldNames.size() == fieldDataTypes.size(), "No. fields must be equal to no. data types");
+    size_t fieldOffset = 0;
+    for (const auto& fieldDataType : fieldDataTypes)
+    {
+        fieldOffsets.emplace_back(fieldOffset);
+        fieldOffset += fieldDataType.getSizeInBytesWithNull();
+    }
+}
+
+bool NativeInputFormatter::decodeBufferProxy(const TupleBuffer* tupleBuffer, const NativeInputFormatter* inputFormatter)
+{
+    tlDecodedFrames.clear();
+    auto& streamState = *inputFormatter->streamState;
+    const std::scoped_lock lock(streamState.mutex);
+    if (tupleBuffer->getSequenceNumber().getRawValue() != streamState.nextSequenceNumber)
+    {
+        return false;
+    }
+    const auto bufferView = RawTupleBuffer{*tupleBuffer}.getBufferView();
+    streamState.decoder.decode(std::span{std::bit_cast<const int8_t*>(bufferView.data()), bufferView.size()}, tlDecodedFrames);
+    ++streamState.nextSequenceNumber;
+    return true;
+}
+
+uint64_t NativeInputFormatter::getNumberOfFramesProxy()
+{
+    return tlDecodedFrames.size();
+}
+
+uint64_t NativeInputFormatter::getNumberOfTuplesProxy(const uint64_t frameIndex)
+{
+    return tlDecodedFrames[frameIndex].numberOfTuples;
+}
+
+int8_t* NativeInputFormatter::getTuplesProxy(const uint64_t frameIndex)
+{
+    /// The parser only reads the tuples
+    return const_cast<int8_t*>(tlDecodedFrames[frameIndex].tuples); ///NOLINT(cppcoreguidelines-pro-type-const-cast)
+}
+
+int8_t* NativeInputFormatter::getChildBuffersProxy(const uint64_t frameIndex)
+{
+    return std::bit_cast<int8_t*>(tlDecodedFrames[frameIndex].childBuffers.data());
+}
+
+nautilus::val<bool> NativeInputFormatter::indexBuffer(const RecordBuffer& recordBuffer, const ArenaRef&) const
+{
+    return nautilus::invoke(decodeBufferProxy, recordBuffer.getReference(), nautilus::val<const NativeInputFormatter*>(this));
+}
+
+void NativeInputFormatter::readBuffer(
+    ExecutionContext& executionCtx,
+    const RecordBuffer&,
+    const std::function<void(ExecutionContext& executionCtx, Record& record)>& executeChild) const
+{
+    const nautilus::val<uint64_t> sizeOfTuple = streamState->decoder.getSizeOfTuple();
+    const nautilus::val<uint64_t> numberOfFrames = nautilus::invoke(getNumberOfFramesProxy);
+    for (nautilus::val<uint64_t> frameIndex = 0; frameIndex < numberOfFrames; ++frameIndex)
+    {
+        const nautilus::val<uint64_t> numberOfTuples = nautilus::invoke(getNumberOfTuplesProxy, frameIndex);
+        const nautilus::val<int8_t*> tuples = nautilus::invoke(getTuplesProxy, frameIndex);
+        const nautilus::val<int8_t*> childBuffers = nautilus::invoke(getChildBuffersProxy, frameIndex);
+        for (nautilus::val<uint64_t> tupleIndex = 0; tupleIndex < numberOfTuples; ++tupleIndex)
+        {
+            const auto tuple = tuples + (tupleIndex * sizeOfTuple);
+            Record record;
+            for (size_t i = 0; i < fieldDataTypes.size(); ++i)
+            {
+                if (not projectedFields[i])
+                {
+                    continue;
+                }
+                const auto& fieldDataType = fieldDataTypes[i];
+                const auto fieldAddress = tuple + nautilus::val<uint64_t>(fieldOffsets[i]);
+                const nautilus::val<bool> isNull
+                    = fieldDataType.nullable ? readValueFromMemRef<bool>(fieldAddress) : nautilus::val<bool>(false);
+                const auto valuePtr = fieldAddress + nautilus::val<uint64_t>(fieldDataType.nullable ? 1 : 0);
+                if (fieldDataType.type == DataType::Type::VARSIZED)
+                {
+                    /// The decoder only checked the VariableSizedAccess of non-null values, thus, we must not resolve it for null values
+                    nautilus::val<int8_t*> valueStart = valuePtr;
+                    nautilus::val<uint64_t> sizeOfValue = 0;
+                    if (not isNull)
+                    {
+                        sizeOfValue = static_cast<nautilus::val<uint64_t>>(
+                            *getMemberWithOffset<uint32_t>(valuePtr, offsetof(VariableSizedAccess, size)));
+                        valueStart = valuePtr + nautilus::val<uint64_t>(offsetof(VariableSizedAccess, prefix));
+                        if (sizeOfValue > nautilus::val<uint64_t>(VariableSizedAccess::INLINE_SIZE))
+                        {
+                            const auto childIndex = static_cast<nautilus::val<uint64_t>>(
+                                *getMemberWithOffset<uint32_t>(valuePtr, offsetof(VariableSizedAccess, index)));
+                            const auto offsetInChild = static_cast<nautilus::val<uint64_t>>(
+                                *getMemberWithOffset<uint32_t>(valuePtr, offsetof(VariableSizedAccess, offset)));
+                            const auto childBuffer = childBuffers + (childIndex * nautilus::val<uint64_t>(sizeof(int8_t*)));
+                            const nautilus::val<int8_t*> childBufferStart = *getMemberWithOffset<int8_t*>(childBuffer, 0);
+                            valueStart = childBufferStart + offsetInChild;
+                        }
+                    }
+                    record.write(fieldNames[i], VarVal{VariableSizedData{valueStart, sizeOfValue}, fieldDataType.nullable, isNull});
+                    continue;
+                }
+
+                if (fieldDataType.nullable)
+                {
+                    record.write(fieldNames[i], VarVal::readVarValFromMemory(valuePtr, fieldDataType, isNull));
+                    continue;
+                }
+                record.write(fieldNames[i], VarVal::readNonNullableVarValFromMemory(valuePtr, fieldDataType));
+            }
+            executeChild(executionCtx, record);
+        }
+    }
+}
+
+std::ostream& NativeInputFormatter::toString(std::ostream& os) const
+{
+    return os << fmt::format("NativeInputFormatter(numberOfFields: {})", fieldDataTypes.size());
+}
+
+InputFormatIndexerRegistryReturnType
+RegisterNativeInputFormatIndexer(InputFormatIndexerRegistryArguments arguments) ///NOLINT(performance-unnecessary-value-param)
+{
+    return arguments.createInputFormatter<NativeInputFormatter>();
+}
+
+}
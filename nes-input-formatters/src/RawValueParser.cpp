@@ -15,21 +15,32 @@
 #include <RawValueParser.hpp>
 
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <limits>
+#include <optional>
 #include <span>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include <DataTypes/DataType.hpp>
+#include <DataTypes/Decimal.hpp>
+#include <Nautilus/DataTypes/VarSizedDictionary.hpp>
 #include <Nautilus/DataTypes/VarVal.hpp>
 #include <Nautilus/DataTypes/VariableSizedData.hpp>
 #include <Nautilus/Interface/Record.hpp>
+#include <Util/Strings.hpp>
+#include <magic_enum/magic_enum.hpp>
 #include <std/cstring.h>
 #include <Arena.hpp>
 #include <ErrorHandling.hpp>
+#include <RawTupleBuffer.hpp>
 #include <function.hpp>
 #include <select.hpp>
 #include <val.hpp>
@@ -47,6 +58,374 @@ bool checkIsNullProxy(const int8_t* fieldAddress, const uint64_t fieldSize, cons
     return std::ranges::any_of(*nullValues, [fieldAsString](const std::string& nullValue) { return nullValue == fieldAsString; });
 }
 
+namespace
+{
+/// Points the VariableSizedData to the interned copy of the value, if the source dictionary-encodes its VARSIZED values
+/// NULL values point to the interned empty value, as the hash function reads the hash behind every value tagged with the dictionary
+VariableSizedData
+createVariableSizedData(const nautilus::val<int8_t*>& ptr, const nautilus::val<uint64_t>& size, VarSizedDictionary* dictionary)
+{
+    /// As the dictionary is a C++ variable, this branch does not impact our tracing or the execution.
+    if (dictionary == nullptr)
+    {
+        return VariableSizedData{ptr, size};
+    }
+    const auto internedPtr = nautilus::invoke(internVarSizedProxy, nautilus::val<VarSizedDictionary*>{dictionary}, ptr, size);
+    return VariableSizedData{internedPtr, size, dictionary->getId()};
+}
+
+ParseResult<int64_t>* parseDecimalProxy(
+    const int8_t* fieldAddress,
+    const uint64_t fieldSize,
+    const std::vector<std::string>* nullValues,
+    const bool nullable,
+    const uint8_t precision,
+    const uint8_t scale)
+{
+    /// We use the thread local to return multiple values, like parseIntoVarValProxy
+    thread_local static ParseResult<int64_t> result;
+    result.isNull = nullable and checkIsNullProxy(fieldAddress, fieldSize, nullValues);
+    result.value = result.isNull ? 0 : parseDecimalValue({std::bit_cast<const char*>(fieldAddress), fieldSize}, precision, scale);
+    return &result;
+}
+
+VarVal parseDecimalIntoVarVal(
+    const DataType& dataType,
+    const nautilus::val<int8_t*>& fieldAddress,
+    const nautilus::val<uint64_t>& fieldSize,
+    const std::vector<std::string>& nullValues)
+{
+    const auto parseResult = nautilus::invoke(
+        parseDecimalProxy,
+        fieldAddress,
+        fieldSize,
+        nautilus::val<const std::vector<std::string>*>{&nullValues},
+        nautilus::val<bool>{dataType.nullable},
+        nautilus::val<uint8_t>{dataType.precision},
+        nautilus::val<uint8_t>{dataType.scale});
+    const nautilus::val<int64_t> value = *getMemberWithOffset<int64_t>(parseResult, offsetof(ParseResult<int64_t>, value));
+    const nautilus::val<bool> isNull = *getMemberWithOffset<bool>(parseResult, offsetof(ParseResult<int64_t>, isNull));
+    return VarVal{value, dataType.nullable, isNull};
+}
+
+/// An uint64_t holds any number with 19 decimal digits
+constexpr size_t MAX_NUMBER_OF_FAST_PATH_DIGITS = 19;
+
+constexpr bool isDigit(const char character)
+{
+    return character >= '0' and character <= '9';
+}
+
+/// Checks if all bytes of the chunk are ASCII digits, i.e., have the upper nibble '3' and a lower nibble that does not overflow when
+/// adding six
+constexpr bool isEightDigits(const uint64_t chunk)
+{
+    constexpr uint64_t upperNibbles = 0xF0F0F0F0F0F0F0F0ULL;
+    constexpr uint64_t sixes = 0x0606060606060606ULL;
+    constexpr uint64_t threes = 0x3333333333333333ULL;
+    return ((chunk & upperNibbles) | (((chunk + sixes) & upperNibbles) >> 4U)) == threes;
+}
+
+/// Converts the eight ASCII digits of a little-endian chunk with three multiplications (SWAR), by first combining neighbouring digits
+/// into two-digit numbers and then combining the two-digit numbers into one eight-digit number
+constexpr uint32_t parseEightDigits(uint64_t chunk)
+{
+    constexpr uint64_t zeros = 0x3030303030303030ULL;
+    constexpr uint64_t mask = 0x000000FF000000FFULL;
+    constexpr uint64_t firstMultiplier = 100 + (1000000ULL << 32U);
+    constexpr uint64_t secondMultiplier = 1 + (10000ULL << 32U);
+    chunk -= zeros;
+    chunk = (chunk * 10) + (chunk >> 8U);
+    chunk = (((chunk & mask) * firstMultiplier) + (((chunk >> 16U) & mask) * secondMultiplier)) >> 32U;
+    return static_cast<uint32_t>(chunk);
+}
+
+/// Returns nullopt, if the digits are empty, contain any other character, or have more digits than an uint64_t holds safely
+std::optional<uint64_t> parseDigits(std::string_view digits)
+{
+    if (digits.empty() or digits.size() > MAX_NUMBER_OF_FAST_PATH_DIGITS)
+    {
+        return {};
+    }
+    uint64_t value = 0;
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        for (; digits.size() >= sizeof(uint64_t); digits.remove_prefix(sizeof(uint64_t)))
+        {
+            uint64_t chunk = 0;
+            std::memcpy(&chunk, digits.data(), sizeof(chunk));
+            if (not isEightDigits(chunk))
+            {
+                return {};
+            }
+            constexpr uint64_t eightDigits = 100000000ULL;
+            value = (value * eightDigits) + parseEightDigits(chunk);
+        }
+    }
+    for (const char digit : digits)
+    {
+        if (not isDigit(digit))
+        {
+            return {};
+        }
+        value = (value * 10) + static_cast<uint64_t>(digit - '0');
+    }
+    return value;
+}
+
+template <typename T>
+std::optional<T> parseIntegerFastPath(std::string_view value)
+{
+    const bool isNegative = std::is_signed_v<T> and value.starts_with('-');
+    if (isNegative)
+    {
+        value.remove_prefix(1);
+    }
+    const auto magnitude = parseDigits(value);
+    constexpr auto maxMagnitude = static_cast<uint64_t>(std::numeric_limits<T>::max());
+    if (not magnitude.has_value() or magnitude.value() > maxMagnitude + static_cast<uint64_t>(isNegative))
+    {
+        return {};
+    }
+    /// Negating in the unsigned domain is well-defined for the smallest value of T, too
+    using UnsignedT = std::make_unsigned_t<T>;
+    const auto unsignedMagnitude = static_cast<UnsignedT>(magnitude.value());
+    return static_cast<T>(isNegative ? static_cast<UnsignedT>(UnsignedT{0} - unsignedMagnitude) : unsignedMagnitude);
+}
+
+/// Clinger's fast path: if the decimal mantissa and the power of ten are both exactly representable, a single (correctly rounded)
+/// multiplication or division yields the correctly rounded value
+template <typename T>
+std::optional<T> parseFloatFastPath(std::string_view value)
+{
+    constexpr uint64_t maxExactMantissa = uint64_t{1} << static_cast<uint64_t>(std::numeric_limits<T>::digits);
+    constexpr int64_t maxExactPowerOfTen = std::is_same_v<T, float> ? 10 : 22;
+    constexpr auto powersOfTen = []
+    {
+        std::array<T, maxExactPowerOfTen + 1> powers{};
+        T power = 1;
+        for (auto& entry : powers)
+        {
+            entry = power;
+            power *= 10;
+        }
+        return powers;
+    }();
+
+    const bool isNegative = value.starts_with('-');
+    if (isNegative)
+    {
+        value.remove_prefix(1);
+    }
+
+    uint64_t mantissa = 0;
+    size_t numberOfDigits = 0;
+    int64_t exponent = 0;
+    size_t position = 0;
+    for (; position < value.size() and isDigit(value[position]); ++position, ++numberOfDigits)
+    {
+        mantissa = (mantissa * 10) + static_cast<uint64_t>(value[position] - '0');
+    }
+    if (position < value.size() and value[position] == '.')
+    {
+        for (++position; position < value.size() and isDigit(value[position]); ++position, ++numberOfDigits, --exponent)
+        {
+            mantissa = (mantissa * 10) + static_cast<uint64_t>(value[position] - '0');
+        }
+    }
+    if (numberOfDigits == 0 or numberOfDigits > MAX_NUMBER_OF_FAST_PATH_DIGITS)
+    {
+        return {};
+    }
+    if (position < value.size() and (value[position] == 'e' or value[position] == 'E'))
+    {
+        auto exponentDigits = value.substr(position + 1);
+        const bool isNegativeExponent = exponentDigits.starts_with('-');
+        if (isNegativeExponent or exponentDigits.starts_with('+'))
+        {
+            exponentDigits.remove_prefix(1);
+        }
+        constexpr size_t maxNumberOfExponentDigits = 3;
+        if (exponentDigits.size() > maxNumberOfExponentDigits)
+        {
+            return {};
+        }
+        const auto explicitExponent = parseDigits(exponentDigits);
+        if (not explicitExponent.has_value())
+        {
+            return {};
+        }
+        exponent += isNegativeExponent ? -static_cast<int64_t>(explicitExponent.value()) : static_cast<int64_t>(explicitExponent.value());
+        position = value.size();
+    }
+    if (position != value.size() or mantissa > maxExactMantissa or exponent < -maxExactPowerOfTen or exponent > maxExactPowerOfTen)
+    {
+        return {};
+    }
+
+    auto result = static_cast<T>(mantissa);
+    result = (exponent < 0) ? result / powersOfTen[static_cast<size_t>(-exponent)] : result * powersOfTen[static_cast<size_t>(exponent)];
+    return isNegative ? -result : result;
+}
+
+template <typename T, typename ParseValue>
+void parseColumnOfType(
+    const ParseValue& parseValue,
+    const bool nullable,
+    const std::span<int8_t> values,
+    const std::span<bool> nulls,
+    const std::string_view buffer,
+    const std::span<const FieldIndex> fieldOffsets,
+    const size_t numberOfFields,
+    const size_t fieldIndex,
+    const size_t sizeOfFieldDelimiter,
+    const std::vector<std::string>& nullValues)
+{
+    const auto numberOfOffsetsPerTuple = numberOfFields + 1;
+    const auto numberOfTuples = fieldOffsets.size() / numberOfOffsetsPerTuple;
+    PRECONDITION(
+        values.size() >= numberOfTuples * sizeof(T) and (not nullable or nulls.size() >= numberOfTuples),
+        "The column cannot hold the values of {} tuples",
+        numberOfTuples);
+
+    /// The last field of a tuple ends at the tuple delimiter, all other fields end at a field delimiter
+    const auto sizeOfDelimiter = (fieldIndex + 1 == numberOfFields) ? 0 : sizeOfFieldDelimiter;
+    for (size_t tuple = 0; tuple < numberOfTuples; ++tuple)
+    {
+        const auto fieldStart = fieldOffsets[(tuple * numberOfOffsetsPerTuple) + fieldIndex];
+        const auto fieldEnd = fieldOffsets[(tuple * numberOfOffsetsPerTuple) + fieldIndex + 1];
+        const auto field = buffer.substr(fieldStart, fieldEnd - fieldStart - sizeOfDelimiter);
+
+        T value{0};
+        const bool isNull = nullable and std::ranges::find(nullValues, field) != nullValues.end();
+        if (not isNull)
+        {
+            value = parseValue(field);
+        }
+        if (nullable)
+        {
+            nulls[tuple] = isNull;
+        }
+        std::memcpy(values.subspan(tuple * sizeof(T), sizeof(T)).data(), &value, sizeof(T));
+    }
+}
+}
+
+template <typename T>
+requires(std::is_arithmetic_v<T> and not std::is_same_v<T, bool> and not std::is_same_v<T, char>)
+T parseNumericValue(const std::string_view value)
+{
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        if (const auto parsedValue = parseFloatFastPath<T>(value); parsedValue.has_value())
+        {
+            return parsedValue.value();
+        }
+    }
+    else
+    {
+        if (const auto parsedValue = parseIntegerFastPath<T>(value); parsedValue.has_value())
+        {
+            return parsedValue.value();
+        }
+    }
+    return from_chars_with_exception<T>(value);
+}
+
+template int8_t parseNumericValue<int8_t>(std::string_view);
+template int16_t parseNumericValue<int16_t>(std::string_view);
+template int32_t parseNumericValue<int32_t>(std::string_view);
+template int64_t parseNumericValue<int64_t>(std::string_view);
+template uint8_t parseNumericValue<uint8_t>(std::string_view);
+template uint16_t parseNumericValue<uint16_t>(std::string_view);
+template uint32_t parseNumericValue<uint32_t>(std::string_view);
+template uint64_t parseNumericValue<uint64_t>(std::string_view);
+template float parseNumericValue<float>(std::string_view);
+template double parseNumericValue<double>(std::string_view);
+
+int64_t parseDecimalValue(const std::string_view value, const uint8_t precision, const uint8_t scale)
+{
+    if (const auto unscaledValue = Decimal::parse(value, precision, scale))
+    {
+        return *unscaledValue;
+    }
+    throw CannotFormatMalformedStringValue("Value '{}', is not a valid value of type: DECIMAL({}, {}).", value, precision, scale);
+}
+
+bool isBatchParsed(const DataType& dataType)
+{
+    return dataType.isNumeric() or dataType.isTemporal() or dataType.isDecimal();
+}
+
+void parseColumn(
+    const DataType& dataType,
+    const std::span<int8_t> values,
+    const std::span<bool> nulls,
+    const std::string_view buffer,
+    const std::span<const FieldIndex> fieldOffsets,
+    const size_t numberOfFields,
+    const size_t fieldIndex,
+    const size_t sizeOfFieldDelimiter,
+    const std::vector<std::string>& nullValues)
+{
+    const auto parseWith = [&]<typename T>(const auto& parseValue)
+    {
+        parseColumnOfType<T>(
+            parseValue,
+            dataType.nullable,
+            values,
+            nulls,
+            buffer,
+            fieldOffsets,
+            numberOfFields,
+            fieldIndex,
+            sizeOfFieldDelimiter,
+            nullValues);
+    };
+    const auto parse = [&]<typename T>() { parseWith.template operator()<T>(parseNumericValue<T>); };
+    switch (dataType.type)
+    {
+        case DataType::Type::INT8:
+            parse.operator()<int8_t>();
+            return;
+        case DataType::Type::INT16:
+            parse.operator()<int16_t>();
+            return;
+        case DataType::Type::INT32:
+            parse.operator()<int32_t>();
+            return;
+        case DataType::Type::INT64:
+        case DataType::Type::INTERVAL:
+            parse.operator()<int64_t>();
+            return;
+        case DataType::Type::UINT8:
+            parse.operator()<uint8_t>();
+            return;
+        case DataType::Type::UINT16:
+            parse.operator()<uint16_t>();
+            return;
+        case DataType::Type::UINT32:
+            parse.operator()<uint32_t>();
+            return;
+        case DataType::Type::UINT64:
+        case DataType::Type::TIMESTAMP:
+            parse.operator()<uint64_t>();
+            return;
+        case DataType::Type::FLOAT32:
+            parse.operator()<float>();
+            return;
+        case DataType::Type::FLOAT64:
+            parse.operator()<double>();
+            return;
+        case DataType::Type::DECIMAL:
+            parseWith.operator()<int64_t>([&](const std::string_view value)
+                                          { return parseDecimalValue(value, dataType.precision, dataType.scale); });
+            return;
+        default:
+            throw UnknownDataType("The batch parsers do not support the data type {}", magic_enum::enum_name(dataType.type));
+    }
+}
+
 void parseRawValueIntoRecord(
     const DataType dataType,
     Record& record,
@@ -54,7 +433,8 @@ void parseRawValueIntoRecord(
     const nautilus::val<uint64_t>& fieldSize,
     const std::string& fieldName,
     const std::vector<std::string>& nullValues,
-    const QuotationType quotationType)
+    const QuotationType quotationType,
+    VarSizedDictionary* dictionary)
 {
     switch (dataType.type)
     {
@@ -78,7 +458,8 @@ void parseRawValueIntoRecord(
             record.write(fieldName, varVal);
             return;
         }
-        case DataType::Type::INT64: {
+        case DataType::Type::INT64:
+        case DataType::Type::INTERVAL: {
             const auto varVal = parseFixedSizeIntoVarVal<int64_t>(dataType.nullable, fieldAddress, fieldSize, nullValues);
             record.write(fieldName, varVal);
             return;
@@ -98,7 +479,8 @@ void parseRawValueIntoRecord(
             record.write(fieldName, varVal);
             return;
         }
-        case DataType::Type::UINT64: {
+        case DataType::Type::UINT64:
+        case DataType::Type::TIMESTAMP: {
             const auto varVal = parseFixedSizeIntoVarVal<uint64_t>(dataType.nullable, fieldAddress, fieldSize, nullValues);
             record.write(fieldName, varVal);
             return;
@@ -113,6 +495,10 @@ void parseRawValueIntoRecord(
             record.write(fieldName, varVal);
             return;
         }
+        case DataType::Type::DECIMAL: {
+            record.write(fieldName, parseDecimalIntoVarVal(dataType, fieldAddress, fieldSize, nullValues));
+            return;
+        }
         case DataType::Type::CHAR: {
             switch (quotationType)
             {
@@ -147,16 +533,14 @@ void parseRawValueIntoRecord(
                 case QuotationType::NONE: {
                     const auto ptr = nautilus::select(isNull, nautilus::val<int8_t*>{nullptr}, fieldAddress);
                     const auto size = nautilus::select(isNull, nautilus::val<uint64_t>{0}, fieldSize);
-                    const VariableSizedData varSized{ptr, size};
-                    const VarVal varVal{varSized, dataType.nullable, isNull};
+                    const VarVal varVal{createVariableSizedData(ptr, size, dictionary), dataType.nullable, isNull};
                     record.write(fieldName, varVal);
                     return;
                 }
                 case QuotationType::DOUBLE_QUOTE: {
                     const auto ptr = nautilus::select(isNull, nautilus::val<int8_t*>{nullptr}, fieldAddress + nautilus::val<uint32_t>(1));
                     const auto size = nautilus::select(isNull, nautilus::val<uint64_t>{0}, fieldSize - nautilus::val<uint64_t>(2));
-                    const VariableSizedData varSized{ptr, size};
-                    const VarVal varVal{varSized, dataType.nullable, isNull};
+                    const VarVal varVal{createVariableSizedData(ptr, size, dictionary), dataType.nullable, isNull};
                     record.write(fieldName, varVal);
                     return;
                 }
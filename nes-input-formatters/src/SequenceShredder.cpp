@@ -21,6 +21,7 @@
 #include <mutex>
 #include <ostream>
 #include <ranges>
+#include <shared_mutex>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -50,6 +51,14 @@ SequenceShredder::~SequenceShredder()
 {
     CPPTRACE_TRY
     {
+        if (const auto statistics = getStatistics(); statistics.numberOfOutOfRangeRequests > 0)
+        {
+            NES_INFO(
+                "SequenceShredder received {} out-of-range requests and resized its SpanningTupleBuffer {} times to {} entries",
+                statistics.numberOfOutOfRangeRequests,
+                statistics.numberOfResizes,
+                statistics.sizeOfSpanningTupleBuffer);
+        }
         if (spanningTupleBuffer->validate())
         {
             NES_INFO("Successfully validated SequenceShredder");
@@ -72,12 +81,14 @@ SequenceShredderResult SequenceShredder::findLeadingSpanningTupleWithDelimiter(c
 
 SpanningBuffers SequenceShredder::findTrailingSpanningTupleWithDelimiter(const SequenceNumber sequenceNumber)
 {
+    const std::shared_lock lock(spanningTupleBufferMutex);
     return spanningTupleBuffer->tryFindTrailingSpanningTupleForBufferWithDelimiter(sequenceNumber);
 }
 
 SpanningBuffers
 SequenceShredder::findTrailingSpanningTupleWithDelimiter(const SequenceNumber sequenceNumber, const FieldIndex offsetOfLastTuple)
 {
+    const std::shared_lock lock(spanningTupleBufferMutex);
     return spanningTupleBuffer->tryFindTrailingSpanningTupleForBufferWithDelimiter(sequenceNumber, offsetOfLastTuple);
 }
 
@@ -86,33 +97,83 @@ SequenceShredderResult SequenceShredder::findSpanningTupleWithoutDelimiter(const
     return findSpanningTupleWithoutDelimiter(indexedRawBuffer, indexedRawBuffer.getRawTupleBuffer().getSequenceNumber());
 }
 
+template <typename SearchFunction>
+SequenceShredderResult SequenceShredder::searchAndResizeIfOutOfRange(const SequenceNumber sequenceNumber, const SearchFunction& search)
+{
+    size_t sizeOfSearchedSpanningTupleBuffer = 0;
+    {
+        const std::shared_lock lock(spanningTupleBufferMutex);
+        if (auto result = search(*spanningTupleBuffer); result.isInRange) [[likely]]
+        {
+            return result;
+        }
+        sizeOfSearchedSpanningTupleBuffer = spanningTupleBuffer->getSize();
+    }
+
+    numberOfOutOfRangeRequests.fetch_add(1, std::memory_order_relaxed);
+    if (numberOfOutOfRangeRequestsSinceResize.fetch_add(1, std::memory_order_relaxed) + 1 < OUT_OF_RANGE_REQUESTS_BEFORE_RESIZE
+        or sizeOfSearchedSpanningTupleBuffer >= MAXIMUM_SIZE_OF_SPANNING_TUPLE_BUFFER)
+    {
+        NES_DEBUG("Sequence number: {} was out of range of SpanningTupleBuffer", sequenceNumber);
+        return SequenceShredderResult{.isInRange = false, .spanningBuffers = {}};
+    }
+
+    {
+        const std::unique_lock lock(spanningTupleBufferMutex);
+        /// Another thread may have resized the SpanningTupleBuffer, while the calling thread waited for exclusive access
+        if (spanningTupleBuffer->getSize() == sizeOfSearchedSpanningTupleBuffer)
+        {
+            spanningTupleBuffer->doubleSize();
+            numberOfOutOfRangeRequestsSinceResize.store(0, std::memory_order_relaxed);
+            ++numberOfResizes;
+            NES_INFO("Doubled the size of the SpanningTupleBuffer to {} entries", spanningTupleBuffer->getSize());
+        }
+    }
+
+    const std::shared_lock lock(spanningTupleBufferMutex);
+    auto result = search(*spanningTupleBuffer);
+    if (not result.isInRange)
+    {
+        numberOfOutOfRangeRequests.fetch_add(1, std::memory_order_relaxed);
+        numberOfOutOfRangeRequestsSinceResize.fetch_add(1, std::memory_order_relaxed);
+    }
+    return result;
+}
+
 SequenceShredderResult
 SequenceShredder::findLeadingSpanningTupleWithDelimiter(const StagedBuffer& indexedRawBuffer, const SequenceNumber sequenceNumber)
 {
-    /// (Planned) Atomically count the number of out of range attempts
-    /// (Planned) Thread that increases atomic counter to threshold blocks access to the current SpanningTupleBUffer, allocates new SpanningTupleBuffer
-    /// (Planned) with double the size, copies over the current state, swaps out the pointer to the SpanningTupleBuffer, and then enables other
-    /// (Planned) threads to access the new SpanningTupleBuffer
-    return spanningTupleBuffer->tryFindLeadingSpanningTupleForBufferWithDelimiter(sequenceNumber, indexedRawBuffer);
+    return searchAndResizeIfOutOfRange(
+        sequenceNumber,
+        [&](SpanningTupleBuffer& buffer)
+        { return buffer.tryFindLeadingSpanningTupleForBufferWithDelimiter(sequenceNumber, indexedRawBuffer); });
 }
 
 SequenceShredderResult
 SequenceShredder::findSpanningTupleWithoutDelimiter(const StagedBuffer& indexedRawBuffer, const SequenceNumber sequenceNumber)
 {
-    if (const auto stSearchResult = spanningTupleBuffer->tryFindSpanningTupleForBufferWithoutDelimiter(sequenceNumber, indexedRawBuffer);
-        stSearchResult.isInRange) [[likely]]
-    {
-        return stSearchResult;
-    }
-    else
-    {
-        NES_WARNING("Sequence number: {} was out of range of SpanningTupleBuffer", sequenceNumber);
-        return stSearchResult;
-    }
+    return searchAndResizeIfOutOfRange(
+        sequenceNumber,
+        [&](SpanningTupleBuffer& buffer)
+        { return buffer.tryFindSpanningTupleForBufferWithoutDelimiter(sequenceNumber, indexedRawBuffer); });
+}
+
+SequenceShredderStatistics SequenceShredder::getStatistics() const
+{
+    const std::shared_lock lock(spanningTupleBufferMutex);
+    return SequenceShredderStatistics{
+        .numberOfOutOfRangeRequests = numberOfOutOfRangeRequests.load(std::memory_order_relaxed),
+        .numberOfResizes = numberOfResizes,
+        .sizeOfSpanningTupleBuffer = spanningTupleBuffer->getSize()};
 }
 
 std::ostream& operator<<(std::ostream& os, const SequenceShredder& sequenceShredder)
 {
-    return os << fmt::format("SequenceShredder({})", *sequenceShredder.spanningTupleBuffer);
+    const auto statistics = sequenceShredder.getStatistics();
+    return os << fmt::format(
+               "SequenceShredder(RingBuffer({}), numberOfOutOfRangeRequests: {}, numberOfResizes: {})",
+               statistics.sizeOfSpanningTupleBuffer,
+               statistics.numberOfOutOfRangeRequests,
+               statistics.numberOfResizes);
 }
 }
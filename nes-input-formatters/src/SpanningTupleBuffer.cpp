@@ -151,6 +151,35 @@ SequenceShredderResult SpanningTupleBuffer::tryFindSpanningTupleForBufferWithout
     return SequenceShredderResult{.isInRange = true, .spanningBuffers = SpanningBuffers({indexedRawBuffer})};
 }
 
+void SpanningTupleBuffer::doubleSize()
+{
+    /// An entry with the ABA iteration number 'abaItNo' at index 'idx' holds the sequence number '(abaItNo - 1) * priorSize + idx'
+    /// The buffer processed all smaller sequence numbers of the index already, which alternate between the indexes 'idx' and
+    /// 'idx + priorSize' of the resized buffer. Thus, the ABA iteration number of an entry of the resized buffer is the number of
+    /// sequence numbers of its index that the buffer processed already. Only the entry that holds the largest sequence number may still
+    /// own buffers, all other (overwritten) entries were used up.
+    const auto priorSize = buffer.size();
+    std::vector<SpanningTupleBufferEntry> resizedBuffer(2 * priorSize);
+    for (size_t priorIdx = 0; priorIdx < priorSize; ++priorIdx)
+    {
+        const auto priorABAItNo = buffer[priorIdx].getABAItNo().getRawValue();
+        for (const uint32_t half : {0U, 1U})
+        {
+            const auto resizedABAItNo = ABAItNo{(priorABAItNo > half) ? (priorABAItNo - half + 1) / 2 : 0};
+            auto& resizedEntry = resizedBuffer[priorIdx + (half * priorSize)];
+            if (priorABAItNo > 0 and (priorABAItNo - 1) % 2 == half)
+            {
+                resizedEntry.takeOverEntry(buffer[priorIdx], resizedABAItNo);
+            }
+            else
+            {
+                resizedEntry.setUsedUpState(resizedABAItNo);
+            }
+        }
+    }
+    buffer = std::move(resizedBuffer);
+}
+
 bool SpanningTupleBuffer::validate() const
 {
     bool isValid = true;
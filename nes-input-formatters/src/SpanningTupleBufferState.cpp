@@ -143,6 +143,20 @@ void SpanningTupleBufferEntry::setOffsetOfTrailingSpanningTuple(const FieldIndex
     this->atomicState.setHasValidLastDelimiterOffset();
 }
 
+void SpanningTupleBufferEntry::takeOverEntry(SpanningTupleBufferEntry& priorEntry, const ABAItNo abaItNumber)
+{
+    this->leadingBufferRef = std::move(priorEntry.leadingBufferRef);
+    this->trailingBufferRef = std::move(priorEntry.trailingBufferRef);
+    this->firstDelimiterOffset = priorEntry.firstDelimiterOffset;
+    this->lastDelimiterOffset = priorEntry.lastDelimiterOffset;
+    this->atomicState.setStateWithABAItNo(priorEntry.atomicState.getState(), abaItNumber);
+}
+
+void SpanningTupleBufferEntry::setUsedUpState(const ABAItNo abaItNumber)
+{
+    this->atomicState.setUsedUpState(abaItNumber);
+}
+
 void SpanningTupleBufferEntry::claimNoDelimiterBuffer(std::span<StagedBuffer> spanningTupleVector, const size_t spanningTupleIdx)
 {
     INVARIANT(this->leadingBufferRef.getReferenceCounter() != 0, "Tried to claim a leading buffer with a nullptr");
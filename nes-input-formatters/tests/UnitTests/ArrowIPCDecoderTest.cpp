@@ -0,0 +1,549 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/DataTypeProvider.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <ArrowIPCDecoder.hpp>
+#include <BaseUnitTest.hpp>
+#include <ErrorHandling.hpp>
+
+/// NOLINTBEGIN(readability-magic-numbers)
+namespace NES
+{
+
+namespace
+{
+
+/// A flatbuffer object that the FlatbufferWriter encodes: a scalar, a table, a vector of tables or a vector of structs
+struct FlatbufferObject
+{
+    enum class Kind : uint8_t
+    {
+        SCALAR,
+        TABLE,
+        TABLE_VECTOR,
+        STRUCT_VECTOR
+    };
+
+    Kind kind = Kind::SCALAR;
+    /// the bytes of a scalar, or of all structs of a struct vector
+    std::vector<uint8_t> bytes;
+    uint32_t numberOfStructs = 0;
+    std::vector<std::optional<FlatbufferObject>> slots;
+    std::vector<FlatbufferObject> elements;
+};
+
+template <typename T>
+FlatbufferObject scalar(const T value)
+{
+    FlatbufferObject object;
+    object.bytes.resize(sizeof(T));
+    std::memcpy(object.bytes.data(), &value, sizeof(T));
+    return object;
+}
+
+FlatbufferObject table(std::vector<std::optional<FlatbufferObject>> slots)
+{
+    FlatbufferObject object;
+    object.kind = FlatbufferObject::Kind::TABLE;
+    object.slots = std::move(slots);
+    return object;
+}
+
+FlatbufferObject tableVector(std::vector<FlatbufferObject> elements)
+{
+    FlatbufferObject object;
+    object.kind = FlatbufferObject::Kind::TABLE_VECTOR;
+    object.elements = std::move(elements);
+    return object;
+}
+
+/// A vector of structs that consist of two int64 values, i.e., the FieldNodes and Buffers of a record batch
+FlatbufferObject structVector(const std::vector<int64_t>& values)
+{
+    FlatbufferObject object;
+    object.kind = FlatbufferObject::Kind::STRUCT_VECTOR;
+    object.bytes.resize(values.size() * sizeof(int64_t));
+    object.numberOfStructs = static_cast<uint32_t>(values.size() / 2);
+    std::memcpy(object.bytes.data(), values.data(), object.bytes.size());
+    return object;
+}
+
+/// Minimal flatbuffer encoder that lays out the children of an object after the object, so that all offsets are positive
+class FlatbufferWriter
+{
+public:
+    std::vector<uint8_t> finish(const FlatbufferObject& root)
+    {
+        bytes.assign(sizeof(uint32_t), 0);
+        put<uint32_t>(0, static_cast<uint32_t>(write(root)));
+        return std::move(bytes);
+    }
+
+private:
+    template <typename T>
+    void put(const size_t position, const T value)
+    {
+        std::memcpy(bytes.data() + position, &value, sizeof(T));
+    }
+
+    template <typename T>
+    void append(const T value)
+    {
+        bytes.resize(bytes.size() + sizeof(T));
+        put<T>(bytes.size() - sizeof(T), value);
+    }
+
+    size_t write(const FlatbufferObject& object)
+    {
+        std::vector<std::pair<size_t, const FlatbufferObject*>> children;
+        size_t position = 0;
+        switch (object.kind)
+        {
+            case FlatbufferObject::Kind::SCALAR:
+                ADD_FAILURE() << "Scalars must be part of a table";
+                return 0;
+            case FlatbufferObject::Kind::TABLE: {
+                const auto vtable = bytes.size();
+                append<uint16_t>(static_cast<uint16_t>((2 + object.slots.size()) * sizeof(uint16_t)));
+                for (size_t i = 0; i <= object.slots.size(); ++i)
+                {
+                    append<uint16_t>(0);
+                }
+                position = bytes.size();
+                append<int32_t>(static_cast<int32_t>(position - vtable));
+                for (size_t slot = 0; slot < object.slots.size(); ++slot)
+                {
+                    if (not object.slots[slot].has_value())
+                    {
+                        continue;
+                    }
+                    put<uint16_t>(vtable + ((2 + slot) * sizeof(uint16_t)), static_cast<uint16_t>(bytes.size() - position));
+                    if (object.slots[slot]->kind == FlatbufferObject::Kind::SCALAR)
+                    {
+                        bytes.insert(bytes.end(), object.slots[slot]->bytes.begin(), object.slots[slot]->bytes.end());
+                        continue;
+                    }
+                    children.emplace_back(bytes.size(), &*object.slots[slot]);
+                    append<uint32_t>(0);
+                }
+                put<uint16_t>(vtable + sizeof(uint16_t), static_cast<uint16_t>(bytes.size() - position));
+                break;
+            }
+            case FlatbufferObject::Kind::TABLE_VECTOR:
+                position = bytes.size();
+                append<uint32_t>(static_cast<uint32_t>(object.elements.size()));
+                for (const auto& element : object.elements)
+                {
+                    children.emplace_back(bytes.size(), &element);
+                    append<uint32_t>(0);
+                }
+                break;
+            case FlatbufferObject::Kind::STRUCT_VECTOR:
+                position = bytes.size();
+                append<uint32_t>(object.numberOfStructs);
+                bytes.insert(bytes.end(), object.bytes.begin(), object.bytes.end());
+                break;
+        }
+        for (const auto& [reference, child] : children)
+        {
+            put<uint32_t>(reference, static_cast<uint32_t>(write(*child) - reference));
+        }
+        return position;
+    }
+
+    std::vector<uint8_t> bytes;
+};
+
+constexpr uint8_t ARROW_INT = 2;
+constexpr uint8_t ARROW_FLOATING_POINT = 3;
+constexpr uint8_t ARROW_UTF8 = 5;
+constexpr uint8_t ARROW_BOOL = 6;
+
+FlatbufferObject arrowField(const uint8_t typeType, FlatbufferObject type, const bool nullable)
+{
+    return table({std::nullopt, scalar<uint8_t>(nullable), scalar<uint8_t>(typeType), std::move(type)});
+}
+
+FlatbufferObject arrowIntField(const int32_t bitWidth, const bool isSigned, const bool nullable)
+{
+    return arrowField(ARROW_INT, table({scalar<int32_t>(bitWidth), scalar<uint8_t>(isSigned)}), nullable);
+}
+
+/// Encapsulates the metadata and the body into a message: <continuation><metadata size><metadata><body>
+std::vector<uint8_t> encapsulate(const FlatbufferObject& header, const uint8_t headerType, const std::vector<uint8_t>& body)
+{
+    auto metadata = FlatbufferWriter{}.finish(
+        table({scalar<int16_t>(4), scalar<uint8_t>(headerType), header, scalar<int64_t>(static_cast<int64_t>(body.size()))}));
+    metadata.resize((metadata.size() + 7) / 8 * 8);
+    std::vector<uint8_t> message(2 * sizeof(uint32_t));
+    const auto continuation = std::numeric_limits<uint32_t>::max();
+    const auto sizeOfMetadata = static_cast<int32_t>(metadata.size());
+    std::memcpy(message.data(), &continuation, sizeof(uint32_t));
+    std::memcpy(message.data() + sizeof(uint32_t), &sizeOfMetadata, sizeof(int32_t));
+    message.insert(message.end(), metadata.begin(), metadata.end());
+    message.insert(message.end(), body.begin(), body.end());
+    return message;
+}
+
+std::vector<uint8_t> schemaMessage(std::vector<FlatbufferObject> fields)
+{
+    return encapsulate(table({scalar<int16_t>(0), tableVector(std::move(fields))}), 1, {});
+}
+
+std::vector<uint8_t> endOfStream()
+{
+    return {0xFF, 0xFF, 0xFF, 0xFF, 0, 0, 0, 0};
+}
+
+/// Encodes a record batch, padding every buffer of its body to a multiple of eight bytes
+class RecordBatchWriter
+{
+public:
+    explicit RecordBatchWriter(const int64_t numberOfRows) : numberOfRows(numberOfRows) { }
+
+    template <typename T>
+    RecordBatchWriter& addColumn(const std::vector<T>& values, const std::vector<bool>& isValid = {})
+    {
+        addValidity(isValid);
+        addBuffer(values.data(), values.size() * sizeof(T));
+        return *this;
+    }
+
+    RecordBatchWriter& addBoolColumn(const std::vector<bool>& values)
+    {
+        addValidity({});
+        const auto bitmap = packBits(values);
+        addBuffer(bitmap.data(), bitmap.size());
+        return *this;
+    }
+
+    RecordBatchWriter& addStringColumn(const std::vector<std::optional<std::string>>& values)
+    {
+        std::vector<bool> isValid;
+        std::vector<int32_t> offsets{0};
+        std::string data;
+        for (const auto& value : values)
+        {
+            isValid.emplace_back(value.has_value());
+            data += value.value_or("");
+            offsets.emplace_back(static_cast<int32_t>(data.size()));
+        }
+        addValidity(isValid);
+        addBuffer(offsets.data(), offsets.size() * sizeof(int32_t));
+        addBuffer(data.data(), data.size());
+        return *this;
+    }
+
+    /// Overwrites the offset of the buffer at 'index', e.g., to create malformed record batches
+    RecordBatchWriter& setBufferOffset(const size_t index, const int64_t offset)
+    {
+        buffers.at(2 * index) = offset;
+        return *this;
+    }
+
+    [[nodiscard]] std::vector<uint8_t> encode() const
+    {
+        return encapsulate(table({scalar<int64_t>(numberOfRows), structVector(nodes), structVector(buffers)}), 3, body);
+    }
+
+private:
+    static std::vector<uint8_t> packBits(const std::vector<bool>& bits)
+    {
+        std::vector<uint8_t> bitmap((bits.size() + 7) / 8);
+        for (size_t i = 0; i < bits.size(); ++i)
+        {
+            bitmap[i / 8] |= static_cast<uint8_t>(static_cast<uint8_t>(bits[i]) << (i % 8));
+        }
+        return bitmap;
+    }
+
+    void addValidity(const std::vector<bool>& isValid)
+    {
+        const auto nullCount = std::ranges::count(isValid, false);
+        nodes.emplace_back(numberOfRows);
+        nodes.emplace_back(nullCount);
+        const auto bitmap = (nullCount > 0) ? packBits(isValid) : std::vector<uint8_t>{};
+        addBuffer(bitmap.data(), bitmap.size());
+    }
+
+    void addBuffer(const void* data, const size_t size)
+    {
+        buffers.emplace_back(static_cast<int64_t>(body.size()));
+        buffers.emplace_back(static_cast<int64_t>(size));
+        const auto* const bytes = static_cast<const uint8_t*>(data);
+        body.insert(body.end(), bytes, bytes + size);
+        body.resize((body.size() + 7) / 8 * 8);
+    }
+
+    int64_t numberOfRows;
+    std::vector<int64_t> nodes;
+    std::vector<int64_t> buffers;
+    std::vector<uint8_t> body;
+};
+
+std::vector<uint8_t> concat(const std::vector<std::vector<uint8_t>>& parts)
+{
+    std::vector<uint8_t> stream;
+    for (const auto& part : parts)
+    {
+        stream.insert(stream.end(), part.begin(), part.end());
+    }
+    return stream;
+}
+
+}
+
+class ArrowIPCDecoderTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestCase()
+    {
+        Logger::setupLogging("ArrowIPCDecoderTest.log", LogLevel::LOG_DEBUG);
+        NES_INFO("Setup ArrowIPCDecoderTest test class.");
+    }
+
+    void SetUp() override
+    {
+        BaseUnitTest::SetUp();
+        schema = {
+            DataTypeProvider::provideDataType(DataType::Type::INT32),
+            DataTypeProvider::provideDataType(DataType::Type::FLOAT64, DataType::NULLABLE::IS_NULLABLE),
+            DataTypeProvider::provideDataType(DataType::Type::BOOLEAN),
+            DataTypeProvider::provideDataType(DataType::Type::VARSIZED, DataType::NULLABLE::IS_NULLABLE),
+            DataTypeProvider::provideDataType(DataType::Type::UINT8)};
+        arrowSchema = schemaMessage(
+            {arrowIntField(32, true, false),
+             arrowField(ARROW_FLOATING_POINT, table({scalar<int16_t>(2)}), true),
+             arrowField(ARROW_BOOL, table({}), false),
+             arrowField(ARROW_UTF8, table({}), true),
+             arrowIntField(8, false, false)});
+    }
+
+    static std::vector<uint8_t> recordBatch(const int32_t firstValue, const size_t numberOfRows)
+    {
+        std::vector<int32_t> ints;
+        std::vector<double> doubles;
+        std::vector<bool> doublesAreValid;
+        std::vector<bool> bools;
+        std::vector<std::optional<std::string>> strings;
+        std::vector<uint8_t> bytes;
+        for (size_t row = 0; row < numberOfRows; ++row)
+        {
+            const auto value = firstValue + static_cast<int32_t>(row);
+            ints.emplace_back(value);
+            doubles.emplace_back(value * 0.5);
+            doublesAreValid.emplace_back(value % 3 != 0);
+            bools.emplace_back(value % 2 == 0);
+            strings.emplace_back((value % 4 == 0) ? std::nullopt : std::optional{std::string(static_cast<size_t>(value % 7), 'a')});
+            bytes.emplace_back(static_cast<uint8_t>(value));
+        }
+        return RecordBatchWriter{static_cast<int64_t>(numberOfRows)}
+            .addColumn(ints)
+            .addColumn(doubles, doublesAreValid)
+            .addBoolColumn(bools)
+            .addStringColumn(strings)
+            .addColumn(bytes)
+            .encode();
+    }
+
+    /// Copies the stream into 8-byte aligned memory, like the memory of a tuple buffer
+    static std::vector<uint64_t> toAlignedMemory(const std::vector<uint8_t>& stream)
+    {
+        std::vector<uint64_t> memory((stream.size() + 7) / 8);
+        std::memcpy(memory.data(), stream.data(), stream.size());
+        return memory;
+    }
+
+    /// Decodes the stream, feeding the decoder chunks of the given size, and renders the decoded rows
+    std::vector<std::string> decode(const std::span<const int8_t> stream, const size_t sizeOfChunk) const
+    {
+        ArrowIPCStreamDecoder decoder{schema};
+        std::vector<ArrowRecordBatch> batches;
+        for (size_t offset = 0; offset < stream.size(); offset += sizeOfChunk)
+        {
+            decoder.decode(stream.subspan(offset, std::min(sizeOfChunk, stream.size() - offset)), batches);
+        }
+        std::vector<std::string> rows;
+        for (const auto& batch : batches)
+        {
+            for (size_t row = 0; row < batch.numberOfRows; ++row)
+            {
+                rows.emplace_back(renderRow(batch, row));
+            }
+        }
+        return rows;
+    }
+
+    [[nodiscard]] std::string renderRow(const ArrowRecordBatch& batch, const size_t row) const
+    {
+        std::string rendered;
+        for (size_t field = 0; field < schema.size(); ++field)
+        {
+            const auto& column = batch.columns[field];
+            if (column.nulls[row])
+            {
+                rendered += "null|";
+                continue;
+            }
+            switch (schema[field].type)
+            {
+                case DataType::Type::INT32:
+                    rendered += fmt::format("{}|", std::bit_cast<const int32_t*>(column.values)[row]);
+                    break;
+                case DataType::Type::FLOAT64:
+                    rendered += fmt::format("{}|", std::bit_cast<const double*>(column.values)[row]);
+                    break;
+                case DataType::Type::BOOLEAN:
+                    rendered += fmt::format("{}|", std::bit_cast<const bool*>(column.values)[row]);
+                    break;
+                case DataType::Type::UINT8:
+                    rendered += fmt::format("{}|", std::bit_cast<const uint8_t*>(column.values)[row]);
+                    break;
+                case DataType::Type::VARSIZED: {
+                    const auto size = static_cast<size_t>(column.offsets[row + 1] - column.offsets[row]);
+                    rendered += fmt::format("'{}'|", std::string_view{std::bit_cast<const char*>(column.data + column.offsets[row]), size});
+                    break;
+                }
+                default:
+                    ADD_FAILURE() << "unexpected type";
+            }
+        }
+        return rendered;
+    }
+
+    std::vector<DataType> schema;
+    std::vector<uint8_t> arrowSchema;
+};
+
+TEST_F(ArrowIPCDecoderTest, DecodesFlatColumnsWithoutCopyingAlignedValues)
+{
+    const auto memory = toAlignedMemory(concat({arrowSchema, recordBatch(1, 4), endOfStream()}));
+    const std::span stream{std::bit_cast<const int8_t*>(memory.data()), memory.size() * sizeof(uint64_t)};
+
+    ArrowIPCStreamDecoder decoder{schema};
+    std::vector<ArrowRecordBatch> batches;
+    decoder.decode(stream, batches);
+    ASSERT_EQ(batches.size(), 1);
+    EXPECT_TRUE(decoder.hasReachedEndOfStream());
+    EXPECT_EQ(batches.front().numberOfRows, 4);
+
+    std::vector<std::string> rows;
+    for (size_t row = 0; row < 4; ++row)
+    {
+        rows.emplace_back(renderRow(batches.front(), row));
+    }
+    EXPECT_EQ(
+        rows, (std::vector<std::string>{"1|0.5|false|'a'|1|", "2|1|true|'aa'|2|", "3|null|false|'aaa'|3|", "4|2|true|null|4|"}));
+
+    /// The fixed-size values and the offsets are aligned, thus, the columns point into the stream
+    const auto isInStream = [&stream](const void* pointer)
+    { return pointer >= stream.data() and pointer < stream.data() + stream.size(); };
+    EXPECT_TRUE(isInStream(batches.front().columns[0].values));
+    EXPECT_TRUE(isInStream(batches.front().columns[1].values));
+    EXPECT_TRUE(isInStream(batches.front().columns[3].offsets));
+    EXPECT_TRUE(isInStream(batches.front().columns[3].data));
+    EXPECT_FALSE(isInStream(batches.front().columns[2].values));
+}
+
+TEST_F(ArrowIPCDecoderTest, DecodesStreamsSplitAtArbitraryOffsets)
+{
+    const auto memory
+        = toAlignedMemory(concat({arrowSchema, recordBatch(1, 100), recordBatch(101, 1), recordBatch(102, 37), endOfStream()}));
+    const std::span stream{std::bit_cast<const int8_t*>(memory.data()), memory.size() * sizeof(uint64_t)};
+
+    const auto expectedRows = decode(stream, stream.size());
+    ASSERT_EQ(expectedRows.size(), 138);
+    for (const size_t sizeOfChunk : {1, 3, 7, 8, 13, 64, 100, 1000})
+    {
+        EXPECT_EQ(decode(stream, sizeOfChunk), expectedRows) << "size of chunk: " << sizeOfChunk;
+    }
+}
+
+TEST_F(ArrowIPCDecoderTest, SkipsFileMagicAndStopsAtEndOfStream)
+{
+    const std::vector<uint8_t> magic{'A', 'R', 'R', 'O', 'W', '1', 0, 0};
+    /// The footer of the file format follows the end-of-stream marker
+    const std::vector<uint8_t> footer{1, 2, 3, 4, 5, 6, 7, 8, 'A', 'R', 'R', 'O', 'W', '1'};
+    const auto memory = toAlignedMemory(concat({magic, arrowSchema, recordBatch(1, 10), endOfStream(), footer}));
+    const std::span stream{std::bit_cast<const int8_t*>(memory.data()), memory.size() * sizeof(uint64_t)};
+
+    for (const size_t sizeOfChunk : std::array<size_t, 2>{5, stream.size()})
+    {
+        EXPECT_EQ(decode(stream, sizeOfChunk).size(), 10);
+    }
+}
+
+TEST_F(ArrowIPCDecoderTest, RejectsMismatchingSchemas)
+{
+    const auto decodeSchema = [this](const std::vector<uint8_t>& message)
+    {
+        ArrowIPCStreamDecoder decoder{schema};
+        std::vector<ArrowRecordBatch> batches;
+        decoder.decode(std::span{std::bit_cast<const int8_t*>(message.data()), message.size()}, batches);
+    };
+    /// the bit width of the first field does not match
+    ASSERT_EXCEPTION_ERRORCODE(
+        decodeSchema(schemaMessage(
+            {arrowIntField(64, true, false),
+             arrowField(ARROW_FLOATING_POINT, table({scalar<int16_t>(2)}), true),
+             arrowField(ARROW_BOOL, table({}), false),
+             arrowField(ARROW_UTF8, table({}), true),
+             arrowIntField(8, false, false)})),
+        ErrorCode::CannotFormatSourceData);
+    /// the number of fields does not match
+    ASSERT_EXCEPTION_ERRORCODE(decodeSchema(schemaMessage({arrowIntField(32, true, false)})), ErrorCode::CannotFormatSourceData);
+}
+
+TEST_F(ArrowIPCDecoderTest, RejectsNullsInNonNullableFields)
+{
+    schema = {DataTypeProvider::provideDataType(DataType::Type::INT32)};
+    const auto stream = concat(
+        {schemaMessage({arrowIntField(32, true, true)}),
+         RecordBatchWriter{2}.addColumn(std::vector<int32_t>{1, 2}, std::vector<bool>{true, false}).encode()});
+    ASSERT_EXCEPTION_ERRORCODE(
+        decode(std::span{std::bit_cast<const int8_t*>(stream.data()), stream.size()}, stream.size()), ErrorCode::CannotFormatSourceData);
+}
+
+TEST_F(ArrowIPCDecoderTest, RejectsBuffersOutsideOfTheBody)
+{
+    schema = {DataTypeProvider::provideDataType(DataType::Type::INT32)};
+    const auto stream = concat(
+        {schemaMessage({arrowIntField(32, true, false)}),
+         RecordBatchWriter{2}.addColumn(std::vector<int32_t>{1, 2}).setBufferOffset(1, 1024).encode()});
+    ASSERT_EXCEPTION_ERRORCODE(
+        decode(std::span{std::bit_cast<const int8_t*>(stream.data()), stream.size()}, stream.size()), ErrorCode::CannotFormatSourceData);
+}
+
+}
+/// NOLINTEND(readability-magic-numbers)
@@ -0,0 +1,205 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <magic_enum/magic_enum.hpp>
+#include <BaseUnitTest.hpp>
+#include <CSVStructuralIndexer.hpp>
+#include <ErrorHandling.hpp>
+#include <FieldOffsets.hpp>
+#include <InputFormatter.hpp>
+
+/// NOLINTBEGIN(readability-magic-numbers)
+namespace NES
+{
+
+class CSVStructuralIndexerTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestCase()
+    {
+        Logger::setupLogging("CSVStructuralIndexerTest.log", LogLevel::LOG_DEBUG);
+        NES_INFO("Setup CSVStructuralIndexerTest test class.");
+    }
+
+    struct IndexedBuffer
+    {
+        std::vector<FieldIndex> fieldOffsets;
+        FieldIndex offsetOfFirstTuple;
+        FieldIndex offsetOfLastTuple;
+        size_t numberOfTuples;
+
+        bool operator==(const IndexedBuffer& other) const = default;
+    };
+
+    static IndexedBuffer index(const std::string_view buffer, const CSVStructure& structure, const CSVClassificationKernel kernel)
+    {
+        FieldOffsets<NumRequiredOffsetsPerField::ONE> fieldOffsets;
+        fieldOffsets.startSetup(structure.numberOfFields, 1);
+        indexCSVStructure(fieldOffsets, buffer, structure, kernel);
+        const auto offsets = fieldOffsets.getFieldOffsets();
+        return {
+            .fieldOffsets = {offsets.begin(), offsets.end()},
+            .offsetOfFirstTuple = fieldOffsets.getByteOffsetOfFirstTuple(),
+            .offsetOfLastTuple = fieldOffsets.getByteOffsetOfLastTuple(),
+            .numberOfTuples = fieldOffsets.getTotalNumberOfTuples()};
+    }
+
+    /// Indexes the buffer byte by byte, following the tuple delimiters with std::string_view::find
+    static std::vector<FieldIndex> referenceFieldOffsets(const std::string_view buffer, const CSVStructure& structure)
+    {
+        std::vector<FieldIndex> offsets;
+        size_t startOfTuple = buffer.find(structure.tupleDelimiter);
+        if (startOfTuple == std::string_view::npos)
+        {
+            return offsets;
+        }
+        ++startOfTuple;
+        for (size_t endOfTuple = buffer.find(structure.tupleDelimiter, startOfTuple); endOfTuple != std::string_view::npos;
+             endOfTuple = buffer.find(structure.tupleDelimiter, startOfTuple))
+        {
+            offsets.emplace_back(startOfTuple);
+            bool isQuoted = false;
+            for (size_t i = startOfTuple; i < endOfTuple; ++i)
+            {
+                if (buffer[i] == structure.fieldDelimiter and not(structure.allowCommasInStrings and isQuoted))
+                {
+                    offsets.emplace_back(i + 1);
+                }
+                isQuoted = isQuoted xor (buffer[i] == '"');
+            }
+            offsets.emplace_back(endOfTuple);
+            startOfTuple = endOfTuple + 1;
+        }
+        return offsets;
+    }
+};
+
+TEST_F(CSVStructuralIndexerTest, indexesTheTuplesBetweenTheFirstAndTheLastTupleDelimiter)
+{
+    const std::string buffer = "3,4\n1,22,333\n4444,5,6\n7,8";
+    const CSVStructure structure{.tupleDelimiter = '\n', .fieldDelimiter = ',', .allowCommasInStrings = false, .numberOfFields = 3};
+    for (const auto kernel : getSupportedCSVClassificationKernels())
+    {
+        const auto indexed = index(buffer, structure, kernel);
+        EXPECT_EQ(indexed.fieldOffsets, (std::vector<FieldIndex>{4, 6, 9, 12, 13, 18, 20, 21})) << magic_enum::enum_name(kernel);
+        EXPECT_EQ(indexed.offsetOfFirstTuple, 3);
+        EXPECT_EQ(indexed.offsetOfLastTuple, 21);
+        EXPECT_EQ(indexed.numberOfTuples, 2);
+    }
+}
+
+TEST_F(CSVStructuralIndexerTest, bufferWithoutTupleDelimiterHasNoTuples)
+{
+    const std::string buffer(200, ',');
+    const CSVStructure structure{.tupleDelimiter = '\n', .fieldDelimiter = ',', .allowCommasInStrings = false, .numberOfFields = 3};
+    for (const auto kernel : getSupportedCSVClassificationKernels())
+    {
+        const auto indexed = index(buffer, structure, kernel);
+        EXPECT_TRUE(indexed.fieldOffsets.empty()) << magic_enum::enum_name(kernel);
+        EXPECT_EQ(indexed.offsetOfFirstTuple, std::numeric_limits<FieldIndex>::max());
+        EXPECT_EQ(indexed.offsetOfLastTuple, std::numeric_limits<FieldIndex>::max());
+    }
+}
+
+TEST_F(CSVStructuralIndexerTest, quotedFieldDelimitersDoNotSeparateFields)
+{
+    /// The second tuple has an odd number of quotes, which must not affect the third tuple
+    const std::string buffer = "x\n\"a,b\",c\nd,e\"\n\"f,h\",g\n";
+    const CSVStructure structure{.tupleDelimiter = '\n', .fieldDelimiter = ',', .allowCommasInStrings = true, .numberOfFields = 2};
+    for (const auto kernel : getSupportedCSVClassificationKernels())
+    {
+        const auto indexed = index(buffer, structure, kernel);
+        EXPECT_EQ(indexed.fieldOffsets, referenceFieldOffsets(buffer, structure)) << magic_enum::enum_name(kernel);
+        EXPECT_EQ(indexed.fieldOffsets, (std::vector<FieldIndex>{2, 8, 9, 10, 12, 14, 15, 21, 22})) << magic_enum::enum_name(kernel);
+        EXPECT_EQ(indexed.numberOfTuples, 3);
+    }
+}
+
+TEST_F(CSVStructuralIndexerTest, wrongNumberOfFieldsThrows)
+{
+    const std::string buffer = "\n1,2\n1,2,3\n";
+    const CSVStructure structure{.tupleDelimiter = '\n', .fieldDelimiter = ',', .allowCommasInStrings = false, .numberOfFields = 2};
+    for (const auto kernel : getSupportedCSVClassificationKernels())
+    {
+        ASSERT_EXCEPTION_ERRORCODE(index(buffer, structure, kernel), ErrorCode::CannotFormatSourceData);
+    }
+}
+
+/// Compares all kernels with the byte-wise reference on random buffers, whose structural characters span several blocks and tails
+TEST_F(CSVStructuralIndexerTest, allKernelsMatchTheReferenceOnRandomBuffers)
+{
+    std::mt19937 generator{42}; /// NOLINT(cert-msc51-cpp)
+    constexpr std::string_view alphabet = "ab1\"";
+    for (const bool allowCommasInStrings : {false, true})
+    {
+        for (size_t iteration = 0; iteration < 200; ++iteration)
+        {
+            constexpr size_t numberOfFields = 3;
+            std::string buffer = "a,b";
+            const auto numberOfTuples = std::uniform_int_distribution<size_t>{0, 20}(generator);
+            for (size_t tuple = 0; tuple < numberOfTuples; ++tuple)
+            {
+                buffer += '\n';
+                for (size_t field = 0; field < numberOfFields; ++field)
+                {
+                    buffer += field == 0 ? "" : ",";
+                    if (allowCommasInStrings and std::uniform_int_distribution<size_t>{0, 3}(generator) == 0)
+                    {
+                        buffer += "\"x,y\"";
+                    }
+                    const auto sizeOfField = std::uniform_int_distribution<size_t>{0, 30}(generator);
+                    for (size_t i = 0; i < sizeOfField; ++i)
+                    {
+                        const char character = alphabet[std::uniform_int_distribution<size_t>{0, alphabet.size() - 1}(generator)];
+                        /// Unbalanced quotes in the last field leave the number of fields intact, but must not leak into the next tuple
+                        const bool isLastField = field + 1 == numberOfFields;
+                        buffer += (character == '"' and not(allowCommasInStrings and isLastField)) ? 'q' : character;
+                    }
+                }
+            }
+            buffer += allowCommasInStrings ? "\n\"trailing,tuple" : "\ntrailing,tuple";
+
+            const CSVStructure structure{
+                .tupleDelimiter = '\n',
+                .fieldDelimiter = ',',
+                .allowCommasInStrings = allowCommasInStrings,
+                .numberOfFields = numberOfFields};
+            const auto expectedOffsets = referenceFieldOffsets(buffer, structure);
+            ASSERT_EQ(expectedOffsets.size(), numberOfTuples * (numberOfFields + 1));
+            for (const auto kernel : getSupportedCSVClassificationKernels())
+            {
+                const auto indexed = index(buffer, structure, kernel);
+                ASSERT_EQ(indexed.fieldOffsets, expectedOffsets) << magic_enum::enum_name(kernel) << " on " << buffer;
+                ASSERT_EQ(indexed.numberOfTuples, numberOfTuples);
+                ASSERT_EQ(indexed.offsetOfFirstTuple, 3);
+                ASSERT_EQ(indexed.offsetOfLastTuple, buffer.rfind('\n'));
+            }
+        }
+    }
+}
+
+}
+/// NOLINTEND(readability-magic-numbers)
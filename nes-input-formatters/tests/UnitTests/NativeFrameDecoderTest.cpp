@@ -0,0 +1,308 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/DataTypeProvider.hpp>
+#include <Runtime/NativeFrameHeader.hpp>
+#include <Runtime/VariableSizedAccess.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+#include <ErrorHandling.hpp>
+#include <NativeFrameDecoder.hpp>
+
+/// NOLINTBEGIN(readability-magic-numbers)
+namespace NES
+{
+
+namespace
+{
+
+struct TestTuple
+{
+    int32_t id;
+    std::optional<std::string> name;
+    int64_t value;
+};
+
+/// Writes tuples of the schema (INT32, nullable VARSIZED, INT64) in the native format, like the NativeFormat of the sinks
+class FrameWriter
+{
+public:
+    static constexpr size_t SIZE_OF_TUPLE = sizeof(int32_t) + 1 + sizeof(VariableSizedAccess) + sizeof(int64_t);
+
+    /// Starts a new child buffer once a child buffer would exceed 'sizeOfChildBuffers' bytes
+    explicit FrameWriter(const size_t sizeOfChildBuffers) : sizeOfChildBuffers(sizeOfChildBuffers) { }
+
+    FrameWriter& addTuple(const TestTuple& tuple)
+    {
+        VariableSizedAccess access;
+        if (tuple.name.has_value() and tuple.name->size() <= VariableSizedAccess::INLINE_SIZE)
+        {
+            access = VariableSizedAccess{std::as_bytes(std::span{*tuple.name})};
+        }
+        else if (tuple.name.has_value())
+        {
+            if (childBuffers.empty() or childBuffers.back().size() + tuple.name->size() > sizeOfChildBuffers)
+            {
+                childBuffers.emplace_back();
+            }
+            auto& childBuffer = childBuffers.back();
+            access = VariableSizedAccess{
+                VariableSizedAccess::Index{childBuffers.size() - 1},
+                VariableSizedAccess::Offset{childBuffer.size()},
+                std::as_bytes(std::span{*tuple.name})};
+            childBuffer.insert(childBuffer.end(), tuple.name->begin(), tuple.name->end());
+        }
+        append(tuples, tuple.id);
+        append(tuples, static_cast<uint8_t>(not tuple.name.has_value()));
+        append(tuples, access);
+        append(tuples, tuple.value);
+        ++numberOfTuples;
+        return *this;
+    }
+
+    /// Overwrites the byte at the given offset of the tuples, e.g., to corrupt a tuple
+    FrameWriter& setTupleByte(const size_t offset, const uint8_t byte)
+    {
+        tuples.at(offset) = static_cast<char>(byte);
+        return *this;
+    }
+
+    [[nodiscard]] std::string encode(const uint32_t sizeOfTuple = SIZE_OF_TUPLE) const
+    {
+        std::string frame;
+        NativeFrameHeader header;
+        header.sizeOfTuple = sizeOfTuple;
+        header.numberOfTuples = numberOfTuples;
+        header.numberOfChildBuffers = childBuffers.size();
+        append(frame, header);
+        frame += tuples;
+        for (const auto& childBuffer : childBuffers)
+        {
+            append(frame, static_cast<uint64_t>(childBuffer.size()));
+            frame += childBuffer;
+        }
+        return frame;
+    }
+
+private:
+    template <typename T>
+    static void append(std::string& bytes, const T& value)
+    {
+        bytes.append(std::bit_cast<const char*>(&value), sizeof(T));
+    }
+
+    size_t sizeOfChildBuffers;
+    uint64_t numberOfTuples = 0;
+    std::string tuples;
+    std::vector<std::string> childBuffers;
+};
+
+std::vector<TestTuple> createTuples(const int32_t firstId, const size_t numberOfTuples)
+{
+    std::vector<TestTuple> tuples;
+    for (size_t i = 0; i < numberOfTuples; ++i)
+    {
+        const auto id = firstId + static_cast<int32_t>(i);
+        /// Every third name is too long to be inlined in its VariableSizedAccess
+        const auto lengthOfName
+            = (id % 3 == 1) ? VariableSizedAccess::INLINE_SIZE + 1 + static_cast<size_t>(id % 5) : static_cast<size_t>(id % 11);
+        auto name = std::string(lengthOfName, static_cast<char>('a' + (id % 26)));
+        tuples.emplace_back(id, (id % 3 == 0) ? std::nullopt : std::optional{std::move(name)}, id * 7L);
+    }
+    return tuples;
+}
+
+std::string encodeFrame(const std::vector<TestTuple>& tuples)
+{
+    FrameWriter writer{16};
+    for (const auto& tuple : tuples)
+    {
+        writer.addTuple(tuple);
+    }
+    return writer.encode();
+}
+
+std::string renderTuple(const TestTuple& tuple)
+{
+    return fmt::format("{}|{}|{}", tuple.id, tuple.name.has_value() ? fmt::format("'{}'", *tuple.name) : "null", tuple.value);
+}
+
+}
+
+class NativeFrameDecoderTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestCase()
+    {
+        Logger::setupLogging("NativeFrameDecoderTest.log", LogLevel::LOG_DEBUG);
+        NES_INFO("Setup NativeFrameDecoderTest test class.");
+    }
+
+    void SetUp() override
+    {
+        BaseUnitTest::SetUp();
+        schema = {
+            DataTypeProvider::provideDataType(DataType::Type::INT32),
+            DataTypeProvider::provideDataType(DataType::Type::VARSIZED, DataType::NULLABLE::IS_NULLABLE),
+            DataTypeProvider::provideDataType(DataType::Type::INT64)};
+    }
+
+    /// Decodes the stream, feeding the decoder chunks of the given size, and renders the decoded tuples like 'renderTuple'
+    [[nodiscard]] std::vector<std::string> decode(const std::string_view stream, const size_t sizeOfChunk) const
+    {
+        NativeFrameDecoder decoder{schema};
+        std::vector<NativeFrame> frames;
+        const std::span bytes{std::bit_cast<const int8_t*>(stream.data()), stream.size()};
+        for (size_t offset = 0; offset < bytes.size(); offset += sizeOfChunk)
+        {
+            decoder.decode(bytes.subspan(offset, std::min(sizeOfChunk, bytes.size() - offset)), frames);
+        }
+        std::vector<std::string> tuples;
+        for (const auto& frame : frames)
+        {
+            for (size_t tupleIndex = 0; tupleIndex < frame.numberOfTuples; ++tupleIndex)
+            {
+                tuples.emplace_back(renderTuple(frame, frame.tuples + (tupleIndex * FrameWriter::SIZE_OF_TUPLE)));
+            }
+        }
+        return tuples;
+    }
+
+    /// Reads the fields of the tuple at their offsets in the row layout
+    static std::string renderTuple(const NativeFrame& frame, const int8_t* tuple)
+    {
+        TestTuple decoded{};
+        std::memcpy(&decoded.id, tuple, sizeof(int32_t));
+        if (tuple[sizeof(int32_t)] == 0)
+        {
+            VariableSizedAccess access;
+            std::memcpy(static_cast<void*>(&access), tuple + sizeof(int32_t) + 1, sizeof(VariableSizedAccess));
+            if (access.isInlined())
+            {
+                const auto inlinedValue = access.getInlinedValue();
+                decoded.name = std::string{std::bit_cast<const char*>(inlinedValue.data()), inlinedValue.size()};
+            }
+            else
+            {
+                const auto* childBuffer = frame.childBuffers.at(access.getIndex().getRawIndex());
+                decoded.name = std::string{
+                    std::bit_cast<const char*>(childBuffer + access.getOffset().getRawOffset()), access.getSize().getRawSize()};
+            }
+        }
+        std::memcpy(&decoded.value, tuple + sizeof(int32_t) + 1 + sizeof(VariableSizedAccess), sizeof(int64_t));
+        return NES::renderTuple(decoded);
+    }
+
+    static std::vector<std::string> renderTuples(const std::vector<TestTuple>& tuples)
+    {
+        std::vector<std::string> rendered;
+        for (const auto& tuple : tuples)
+        {
+            rendered.emplace_back(NES::renderTuple(tuple));
+        }
+        return rendered;
+    }
+
+    std::vector<DataType> schema;
+};
+
+TEST_F(NativeFrameDecoderTest, DecodesFramesInPlace)
+{
+    const auto tuples = createTuples(1, 10);
+    const auto stream = encodeFrame(tuples);
+    const std::span bytes{std::bit_cast<const int8_t*>(stream.data()), stream.size()};
+
+    NativeFrameDecoder decoder{schema};
+    std::vector<NativeFrame> frames;
+    decoder.decode(bytes, frames);
+    ASSERT_EQ(frames.size(), 1);
+    EXPECT_EQ(frames.front().numberOfTuples, tuples.size());
+    EXPECT_EQ(frames.front().storage, nullptr);
+    EXPECT_EQ(frames.front().tuples, bytes.data() + sizeof(NativeFrameHeader));
+    EXPECT_GT(frames.front().childBuffers.size(), 1);
+    EXPECT_EQ(decode(stream, stream.size()), renderTuples(tuples));
+}
+
+TEST_F(NativeFrameDecoderTest, DecodesStreamsSplitAtArbitraryOffsets)
+{
+    const auto firstTuples = createTuples(1, 7);
+    const auto secondTuples = createTuples(100, 5);
+    const auto stream = encodeFrame(firstTuples) + encodeFrame({}) + encodeFrame(secondTuples);
+    auto expectedTuples = renderTuples(firstTuples);
+    std::ranges::move(renderTuples(secondTuples), std::back_inserter(expectedTuples));
+
+    for (size_t sizeOfChunk = 1; sizeOfChunk <= stream.size(); ++sizeOfChunk)
+    {
+        EXPECT_EQ(decode(stream, sizeOfChunk), expectedTuples) << "size of chunk: " << sizeOfChunk;
+    }
+}
+
+TEST_F(NativeFrameDecoderTest, RejectsMismatchingFrames)
+{
+    const auto frame = FrameWriter{16}.addTuple({1, "a", 2});
+    /// the size of the tuples does not match the schema
+    ASSERT_EXCEPTION_ERRORCODE(
+        static_cast<void>(decode(frame.encode(FrameWriter::SIZE_OF_TUPLE + 1), 1024)), ErrorCode::CannotFormatSourceData);
+    /// the frame does not start with the magic bytes (e.g., a CSV file)
+    ASSERT_EXCEPTION_ERRORCODE(
+        static_cast<void>(decode("id:INT32:NOT_NULLABLE,name:VARSIZED:NULLABLE\n", 1024)), ErrorCode::CannotFormatSourceData);
+}
+
+TEST_F(NativeFrameDecoderTest, RejectsVarSizedValuesOutsideOfChildBuffers)
+{
+    constexpr size_t offsetOfAccess = sizeof(int32_t) + 1;
+    /// The name is too long to be inlined
+    const TestTuple tuple{1, "abcdefghijklmn", 2};
+    /// the index of the child buffer is out of bounds
+    ASSERT_EXCEPTION_ERRORCODE(
+        static_cast<void>(decode(
+            FrameWriter{16}.addTuple(tuple).setTupleByte(offsetOfAccess + offsetof(VariableSizedAccess, index), 1).encode(), 1024)),
+        ErrorCode::CannotFormatSourceData);
+    /// the value exceeds its child buffer
+    ASSERT_EXCEPTION_ERRORCODE(
+        static_cast<void>(decode(
+            FrameWriter{16}.addTuple(tuple).setTupleByte(offsetOfAccess + offsetof(VariableSizedAccess, size), 17).encode(), 1024)),
+        ErrorCode::CannotFormatSourceData);
+    /// the null flag is neither true nor false
+    ASSERT_EXCEPTION_ERRORCODE(
+        static_cast<void>(decode(FrameWriter{16}.addTuple(tuple).setTupleByte(sizeof(int32_t), 2).encode(), 1024)),
+        ErrorCode::CannotFormatSourceData);
+    /// an inlined value does not reference a child buffer
+    EXPECT_EQ(decode(FrameWriter{16}.addTuple({1, "abc", 2}).encode(), 1024), renderTuples({{1, "abc", 2}}));
+
+    /// The decoder ignores the VariableSizedAccess of null values
+    const auto nullWithInvalidAccess
+        = FrameWriter{16}.addTuple({1, std::nullopt, 2}).setTupleByte(offsetOfAccess + offsetof(VariableSizedAccess, index), 7).encode();
+    EXPECT_EQ(decode(nullWithInvalidAccess, 1024), renderTuples({{1, std::nullopt, 2}}));
+}
+
+}
+/// NOLINTEND(readability-magic-numbers)
@@ -0,0 +1,210 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/DataTypeProvider.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <Util/Strings.hpp>
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+#include <ErrorHandling.hpp>
+#include <RawTupleBuffer.hpp>
+#include <RawValueParser.hpp>
+
+/// NOLINTBEGIN(readability-magic-numbers)
+namespace NES
+{
+
+class RawValueParserTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestCase()
+    {
+        Logger::setupLogging("RawValueParserTest.log", LogLevel::LOG_DEBUG);
+        NES_INFO("Setup RawValueParserTest test class.");
+    }
+
+    /// The batch parsers must yield exactly the values of from_chars_with_exception
+    template <typename T>
+    static void expectSameAsFromChars(const std::string_view value)
+    {
+        const auto expected = from_chars_with_exception<T>(value);
+        const auto parsed = parseNumericValue<T>(value);
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            EXPECT_EQ(std::memcmp(&expected, &parsed, sizeof(T)), 0) << value << ": " << expected << " vs " << parsed;
+        }
+        else
+        {
+            EXPECT_EQ(expected, parsed) << value;
+        }
+    }
+
+    template <typename T>
+    static void expectSameAsFromCharsForRandomIntegers()
+    {
+        std::mt19937_64 generator{42}; /// NOLINT(cert-msc51-cpp)
+        /// The distribution does not support char-sized types, thus we draw 64-bit values within the range of T
+        using Wide = std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>;
+        std::uniform_int_distribution<Wide> values{std::numeric_limits<T>::min(), std::numeric_limits<T>::max()};
+        for (size_t i = 0; i < 10000; ++i)
+        {
+            expectSameAsFromChars<T>(std::to_string(values(generator)));
+        }
+        expectSameAsFromChars<T>(std::to_string(std::numeric_limits<T>::min()));
+        expectSameAsFromChars<T>(std::to_string(std::numeric_limits<T>::max()));
+    }
+};
+
+TEST_F(RawValueParserTest, integersMatchFromChars)
+{
+    expectSameAsFromCharsForRandomIntegers<int8_t>();
+    expectSameAsFromCharsForRandomIntegers<int16_t>();
+    expectSameAsFromCharsForRandomIntegers<int32_t>();
+    expectSameAsFromCharsForRandomIntegers<int64_t>();
+    expectSameAsFromCharsForRandomIntegers<uint8_t>();
+    expectSameAsFromCharsForRandomIntegers<uint16_t>();
+    expectSameAsFromCharsForRandomIntegers<uint32_t>();
+    expectSameAsFromCharsForRandomIntegers<uint64_t>();
+
+    /// Values outside of the fast path fall back to from_chars
+    expectSameAsFromChars<int64_t>("-0");
+    expectSameAsFromChars<int64_t>("0000000000000000000000042");
+    expectSameAsFromChars<uint32_t>("12345678abc");
+    expectSameAsFromChars<int16_t>("-00001");
+}
+
+TEST_F(RawValueParserTest, malformedIntegersThrow)
+{
+    for (const std::string_view value : {"", "-", "abc", "+", "-1"})
+    {
+        ASSERT_EXCEPTION_ERRORCODE(parseNumericValue<uint64_t>(value), ErrorCode::CannotFormatMalformedStringValue);
+    }
+    ASSERT_EXCEPTION_ERRORCODE(parseNumericValue<uint8_t>("256"), ErrorCode::CannotFormatMalformedStringValue);
+    ASSERT_EXCEPTION_ERRORCODE(parseNumericValue<int8_t>("-129"), ErrorCode::CannotFormatMalformedStringValue);
+    ASSERT_EXCEPTION_ERRORCODE(parseNumericValue<uint64_t>("18446744073709551616"), ErrorCode::CannotFormatMalformedStringValue);
+}
+
+TEST_F(RawValueParserTest, floatsMatchFromChars)
+{
+    std::mt19937_64 generator{42}; /// NOLINT(cert-msc51-cpp)
+    std::uniform_real_distribution values{-1e6, 1e6};
+    std::uniform_int_distribution<size_t> precisions{0, 17};
+    for (size_t i = 0; i < 10000; ++i)
+    {
+        const auto value = values(generator);
+        const auto precision = precisions(generator);
+        expectSameAsFromChars<double>(fmt::format("{:.{}f}", value, precision));
+        expectSameAsFromChars<float>(fmt::format("{:.{}f}", value, precision));
+        expectSameAsFromChars<double>(fmt::format("{:.{}e}", value, precision));
+        expectSameAsFromChars<float>(fmt::format("{:.{}e}", value, precision));
+    }
+    for (const std::string_view value :
+         {"0", "-0", "-0.0", ".5", "-.5", "5.", "1e22", "1e23", "1e-22", "1E+5", "1e", "9007199254740993", "3.14159265358979323846",
+          "  42.5", "+1.5", "inf", "-nan", "0x1p3", "1.5abc", "123456789012345678901234567890"})
+    {
+        expectSameAsFromChars<double>(value);
+    }
+    for (const std::string_view value : {"16777217", "1e10", "1e11", "0.1", "3.4028235e38", "1e-5"})
+    {
+        expectSameAsFromChars<float>(value);
+    }
+}
+
+TEST_F(RawValueParserTest, malformedFloatsThrow)
+{
+    for (const std::string_view value : {"", "-", ".", "e5", "abc", "1e400"})
+    {
+        ASSERT_EXCEPTION_ERRORCODE(parseNumericValue<double>(value), ErrorCode::CannotFormatMalformedStringValue);
+    }
+}
+
+TEST_F(RawValueParserTest, parseColumnParsesOneFieldOfAllTuples)
+{
+    /// Two tuples of the schema (INT32, FLOAT64 NULLABLE), indexed like the FieldOffsets index them
+    const std::string buffer = "\n-42,1.5\n7,\n";
+    const std::vector<FieldIndex> fieldOffsets{1, 5, 8, 9, 11, 11};
+    constexpr size_t numberOfFields = 2;
+    constexpr size_t sizeOfFieldDelimiter = 1;
+    const std::vector<std::string> nullValues{""};
+
+    std::vector<int32_t> integers(2);
+    parseColumn(
+        DataTypeProvider::provideDataType(DataType::Type::INT32),
+        std::span(std::bit_cast<int8_t*>(integers.data()), integers.size() * sizeof(int32_t)),
+        {},
+        buffer,
+        fieldOffsets,
+        numberOfFields,
+        0,
+        sizeOfFieldDelimiter,
+        nullValues);
+    EXPECT_EQ(integers, (std::vector<int32_t>{-42, 7}));
+
+    std::vector<double> doubles(2);
+    std::vector<char> nulls(2);
+    parseColumn(
+        DataTypeProvider::provideDataType(DataType::Type::FLOAT64, DataType::NULLABLE::IS_NULLABLE),
+        std::span(std::bit_cast<int8_t*>(doubles.data()), doubles.size() * sizeof(double)),
+        std::span(std::bit_cast<bool*>(nulls.data()), nulls.size()),
+        buffer,
+        fieldOffsets,
+        numberOfFields,
+        1,
+        sizeOfFieldDelimiter,
+        nullValues);
+    EXPECT_EQ(doubles, (std::vector<double>{1.5, 0}));
+    EXPECT_EQ(nulls, (std::vector<char>{false, true}));
+
+    std::vector<int64_t> decimals(2);
+    parseColumn(
+        DataTypeProvider::provideDecimalDataType(10, 2, DataType::NULLABLE::NOT_NULLABLE),
+        std::span(std::bit_cast<int8_t*>(decimals.data()), decimals.size() * sizeof(int64_t)),
+        {},
+        buffer,
+        fieldOffsets,
+        numberOfFields,
+        0,
+        sizeOfFieldDelimiter,
+        nullValues);
+    EXPECT_EQ(decimals, (std::vector<int64_t>{-4200, 700}));
+}
+
+TEST_F(RawValueParserTest, parseDecimals)
+{
+    EXPECT_EQ(parseDecimalValue("19.99", 10, 2), 1999);
+    EXPECT_EQ(parseDecimalValue("-0.5", 10, 2), -50);
+    for (const std::string_view value : {"", "abc", "1,5", "123456789"})
+    {
+        ASSERT_EXCEPTION_ERRORCODE(parseDecimalValue(value, 8, 2), ErrorCode::CannotFormatMalformedStringValue);
+    }
+}
+
+}
+/// NOLINTEND(readability-magic-numbers)
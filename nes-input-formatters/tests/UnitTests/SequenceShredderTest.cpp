@@ -0,0 +1,127 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include <Identifiers/Identifiers.hpp>
+#include <Runtime/BufferManager.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+#include <RawTupleBuffer.hpp>
+#include <SequenceShredder.hpp>
+
+namespace NES
+{
+
+class SequenceShredderTest : public Testing::BaseUnitTest
+{
+public:
+    static constexpr size_t SIZE_OF_RAW_BUFFER = 8;
+    static constexpr uint32_t OFFSET_OF_TUPLE_DELIMITER = 4;
+
+    static void SetUpTestCase()
+    {
+        Logger::setupLogging("SequenceShredderTest.log", LogLevel::LOG_DEBUG);
+        NES_INFO("Setup SequenceShredderTest test class.");
+    }
+
+    void SetUp() override
+    {
+        BaseUnitTest::SetUp();
+        bufferManager = BufferManager::create(SIZE_OF_RAW_BUFFER, 64);
+    }
+
+    /// Searches for the leading and the trailing spanning tuple of a raw buffer with a tuple delimiter
+    /// Records the sequence number of the last buffer of each spanning tuple that the SequenceShredder found
+    /// Returns false, if the sequence number was not in range of the SequenceShredder
+    bool processBufferWithDelimiter(SequenceShredder& sequenceShredder, const SequenceNumber::Underlying sequenceNumber)
+    {
+        auto rawBuffer = bufferManager->getBufferBlocking();
+        rawBuffer.setSequenceNumber(SequenceNumber{sequenceNumber});
+        rawBuffer.setNumberOfTuples(SIZE_OF_RAW_BUFFER);
+        const auto stagedBuffer = StagedBuffer{RawTupleBuffer{rawBuffer}, OFFSET_OF_TUPLE_DELIMITER, OFFSET_OF_TUPLE_DELIMITER};
+
+        const auto leadingResult = sequenceShredder.findLeadingSpanningTupleWithDelimiter(stagedBuffer);
+        if (not leadingResult.isInRange)
+        {
+            return false;
+        }
+        recordSpanningTuple(leadingResult.spanningBuffers);
+        recordSpanningTuple(sequenceShredder.findTrailingSpanningTupleWithDelimiter(SequenceNumber{sequenceNumber}));
+        return true;
+    }
+
+    void recordSpanningTuple(const SpanningBuffers& spanningBuffers)
+    {
+        if (spanningBuffers.hasSpanningTuple())
+        {
+            lastSequenceNumbersOfSpanningTuples.push_back(
+                spanningBuffers.getSpanningBuffers().back().getRawTupleBuffer().getSequenceNumber().getRawValue());
+        }
+    }
+
+    std::shared_ptr<BufferManager> bufferManager;
+    std::vector<SequenceNumber::Underlying> lastSequenceNumbersOfSpanningTuples;
+};
+
+TEST_F(SequenceShredderTest, GrowsSpanningTupleBufferOnOutOfRangeRequests)
+{
+    SequenceShredder sequenceShredder{1};
+    const auto initialSize = sequenceShredder.getStatistics().sizeOfSpanningTupleBuffer;
+
+    /// Withholding the first sequence number prevents the SequenceShredder from using up the first iteration of the SpanningTupleBuffer
+    for (SequenceNumber::Underlying sequenceNumber = 2; sequenceNumber < initialSize; ++sequenceNumber)
+    {
+        ASSERT_TRUE(processBufferWithDelimiter(sequenceShredder, sequenceNumber));
+    }
+    ASSERT_EQ(sequenceShredder.getStatistics().numberOfOutOfRangeRequests, 0);
+
+    /// The first sequence number of the second iteration is out of range, until enough repeated requests trigger a resize
+    uint64_t numberOfRequests = 1;
+    while (not processBufferWithDelimiter(sequenceShredder, initialSize))
+    {
+        ++numberOfRequests;
+    }
+    const auto statistics = sequenceShredder.getStatistics();
+    EXPECT_GT(numberOfRequests, 1);
+    EXPECT_EQ(statistics.numberOfOutOfRangeRequests, numberOfRequests);
+    EXPECT_EQ(statistics.numberOfResizes, 1);
+    EXPECT_EQ(statistics.sizeOfSpanningTupleBuffer, 2 * initialSize);
+
+    /// The resized SpanningTupleBuffer keeps the state of all prior sequence numbers
+    const auto lastSequenceNumber = (2 * initialSize) - 1;
+    for (SequenceNumber::Underlying sequenceNumber = initialSize + 1; sequenceNumber <= lastSequenceNumber; ++sequenceNumber)
+    {
+        ASSERT_TRUE(processBufferWithDelimiter(sequenceShredder, sequenceNumber));
+    }
+    ASSERT_TRUE(processBufferWithDelimiter(sequenceShredder, SequenceNumber::INITIAL));
+    EXPECT_EQ(sequenceShredder.getStatistics().numberOfResizes, 1);
+
+    /// Each pair of consecutive sequence numbers (and the dummy buffer with sequence number 0) forms exactly one spanning tuple
+    std::ranges::sort(lastSequenceNumbersOfSpanningTuples);
+    std::vector<SequenceNumber::Underlying> expectedSequenceNumbers(lastSequenceNumber);
+    std::iota(expectedSequenceNumbers.begin(), expectedSequenceNumbers.end(), SequenceNumber::INITIAL);
+    EXPECT_EQ(lastSequenceNumbersOfSpanningTuples, expectedSequenceNumbers);
+}
+
+}
@@ -161,6 +161,8 @@ public:
         size_t numberOfThreads;
         size_t sizeOfRawBuffers;
         bool isCompiled;
+        bool dictionaryEncoding{};
+        bool memoryMappedFileSource{};
     };
 
     struct SetupResult
@@ -213,7 +215,12 @@ public:
 
         /// TODO #774: Sources sometimes need an extra buffer (reason currently unknown)
         const auto [backpressureController, fileSource] = InputFormatterTestUtil::createFileSource(
-            sourceCatalog, testFilePath, schema, std::move(sourceBufferPool), numberOfRequiredSourceBuffers);
+            sourceCatalog,
+            testFilePath,
+            schema,
+            std::move(sourceBufferPool),
+            numberOfRequiredSourceBuffers,
+            testConfig.memoryMappedFileSource);
         fileSource->start(InputFormatterTestUtil::getEmitFunction(rawBuffers));
         rawBuffers.waitForSize(numberOfExpectedRawBuffers);
         INVARIANT(
@@ -289,7 +296,10 @@ public:
 
             /// Create compiled pipeline stage containing InputFormatter and EmitOperator(emits formatted buffers into 'resultBuffers')
             const std::unordered_map<std::string, std::string> parserConfiguration{
-                {"type", testConfig.formatterType}, {"tuple_delimiter", "\n"}, {"field_delimiter", "|"}};
+                {"type", testConfig.formatterType},
+                {"tuple_delimiter", "\n"},
+                {"field_delimiter", "|"},
+                {"dictionary_encoding", testConfig.dictionaryEncoding ? "true" : "false"}};
             auto testStage = InputFormatterTestUtil::createInputFormatter(
                 parserConfiguration,
                 setupResult.schema,
@@ -416,6 +426,36 @@ TEST_F(SmallFilesTest, testFoodData)
         .isCompiled = true});
 }
 
+/// Dictionary-encoding the VARSIZED fields must not change the formatted values
+TEST_F(SmallFilesTest, testFoodDataWithDictionaryEncoding)
+{
+    runTest(TestConfig{
+        .testFileName = "Food",
+        .formatterType = "CSV",
+        .fileEnding = "CSV",
+        .hasSpanningTuples = true,
+        .numberOfIterations = 10,
+        .numberOfThreads = 8,
+        .sizeOfRawBuffers = 2,
+        .isCompiled = true,
+        .dictionaryEncoding = true});
+}
+
+/// The memory-mapped file source must produce the same raw buffers as the stream-based file source
+TEST_F(SmallFilesTest, testFoodDataWithMemoryMappedFileSource)
+{
+    runTest(TestConfig{
+        .testFileName = "Food",
+        .formatterType = "CSV",
+        .fileEnding = "CSV",
+        .hasSpanningTuples = true,
+        .numberOfIterations = 1,
+        .numberOfThreads = 8,
+        .sizeOfRawBuffers = 16,
+        .isCompiled = true,
+        .memoryMappedFileSource = true});
+}
+
 TEST_F(SmallFilesTest, testSpaceCraftTelemetryData)
 {
     runTest(
@@ -161,6 +161,11 @@ inline void writePagedSizeTupleBufferChunkToFile(
                     const auto currentTupleVarSizedFieldOffset = currentTupleOffset + varSizedFieldOffset;
                     const VariableSizedAccess varSizedAccess{
                         *reinterpret_cast<VariableSizedAccess*>(buffer.getAvailableMemoryArea().data() + currentTupleVarSizedFieldOffset)};
+                    /// Inlined values are already part of the written tuples
+                    if (varSizedAccess.isInlined())
+                    {
+                        continue;
+                    }
                     const auto variableSizedData = Format::readVarSizedDataAsString(buffer, varSizedAccess);
                     appendFile.write(variableSizedData.data(), static_cast<std::streamsize>(variableSizedData.size()));
                 }
@@ -292,12 +297,16 @@ inline std::vector<TupleBuffer> loadTupleBuffersFromFile(
                     const auto childBufferOffset = (tupleIdx * sizeOfSchemaInBytes) + varSizedOffset;
                     const auto varSizedAccess
                         = reinterpret_cast<VariableSizedAccess*>(parentBuffer.getAvailableMemoryArea().data() + childBufferOffset);
+                    if (varSizedAccess->isInlined())
+                    {
+                        continue;
+                    }
                     if (auto nextChildBuffer = bufferProvider.getUnpooledBuffer(varSizedAccess->getSize().getRawSize()))
                     {
                         file.read(nextChildBuffer.value().getAvailableMemoryArea<char>().data(), varSizedAccess->getSize().getRawSize());
 
                         const auto newChildBufferIdx = parentBuffer.storeChildBuffer(nextChildBuffer.value());
-                        *varSizedAccess = VariableSizedAccess{newChildBufferIdx, VariableSizedAccess::Offset(0), varSizedAccess->getSize()};
+                        *varSizedAccess = varSizedAccess->relocate(newChildBufferIdx, VariableSizedAccess::Offset(0));
                         continue;
                     }
                     throw BufferAllocationFailure("Failed to get unpooled buffer");
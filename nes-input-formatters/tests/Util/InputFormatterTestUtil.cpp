@@ -168,6 +168,10 @@ ParserConfig validateAndFormatParserConfig(const std::unordered_map<std::string,
         NES_DEBUG("Parser configuration did not contain: fieldDelimiter, using default: ,");
         validParserConfig.fieldDelimiter = ",";
     }
+    if (const auto dictionaryEncoding = parserConfig.find("dictionary_encoding"); dictionaryEncoding != parserConfig.end())
+    {
+        validParserConfig.dictionaryEncoding = dictionaryEncoding->second == "true";
+    }
     return validParserConfig;
 }
 
@@ -176,10 +180,13 @@ std::pair<BackpressureController, std::unique_ptr<SourceHandle>> createFileSourc
     const std::string& filePath,
     const Schema& schema,
     std::shared_ptr<BufferManager> sourceBufferPool,
-    const size_t numberOfRequiredSourceBuffers)
+    const size_t numberOfRequiredSourceBuffers,
+    const bool memoryMapped)
 {
     std::unordered_map<std::string, std::string> fileSourceConfiguration{
-        {"file_path", filePath}, {"max_inflight_buffers", std::to_string(numberOfRequiredSourceBuffers)}};
+        {"file_path", filePath},
+        {"max_inflight_buffers", std::to_string(numberOfRequiredSourceBuffers)},
+        {"memory_mapped", memoryMapped ? "true" : "false"}};
     const auto logicalSource = sourceCatalog.addLogicalSource("TestSource", schema);
     INVARIANT(logicalSource.has_value(), "TestSource already existed");
     const auto sourceDescriptor
@@ -222,7 +229,8 @@ std::shared_ptr<CompiledExecutablePipelineStage> createInputFormatter(
     constexpr OperatorHandlerId emitOperatorHandlerId = INITIAL<OperatorHandlerId>;
 
     auto memoryProvider = LowerSchemaProvider::lowerSchema(sizeOfFormattedBuffers, schema, memoryLayoutType);
-    auto scanOp = ScanPhysicalOperator(provideInputFormatterTupleBufferRef(parserConfiguration, memoryProvider), schema.getFieldNames());
+    auto scanOp = ScanPhysicalOperator(
+        provideInputFormatterTupleBufferRef(parserConfiguration, memoryProvider, schema.getFieldNames()), schema.getFieldNames());
     scanOp.setChild(EmitPhysicalOperator(emitOperatorHandlerId, std::move(memoryProvider)));
 
     auto physicalScanPipeline = std::make_shared<Pipeline>(std::move(scanOp));
@@ -158,7 +158,8 @@ std::pair<BackpressureController, std::unique_ptr<SourceHandle>> createFileSourc
     const std::string& filePath,
     const Schema& schema,
     std::shared_ptr<BufferManager> sourceBufferPool,
-    size_t numberOfRequiredSourceBuffers);
+    size_t numberOfRequiredSourceBuffers,
+    bool memoryMapped = false);
 
 /// Waits until source reached EoS
 void waitForSource(const std::vector<TupleBuffer>& resultBuffers, size_t numExpectedBuffers);
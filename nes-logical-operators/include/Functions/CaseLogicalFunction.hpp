@@ -0,0 +1,84 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Util/Logger/Formatter.hpp>
+#include <Util/PlanRenderer.hpp>
+#include <Util/Reflection.hpp>
+#include <SerializableVariantDescriptor.pb.h>
+
+namespace NES
+{
+
+/// Evaluates `CASE WHEN c1 THEN v1 [WHEN c2 THEN v2 ...] [ELSE e] END`, i.e., returns the value of the first branch whose condition is
+/// true, or else the ELSE value. A null condition counts as false. Without an ELSE value, the result is null if no condition is true.
+/// `IF(c, v, e)` is a CASE with a single branch.
+/// The children are the conditions and values of all branches in order, followed by the optional ELSE value.
+class CaseLogicalFunction final
+{
+public:
+    static constexpr std::string_view NAME = "Case";
+
+    CaseLogicalFunction(const std::vector<std::pair<LogicalFunction, LogicalFunction>>& branches, std::optional<LogicalFunction> elseValue);
+
+    [[nodiscard]] bool operator==(const CaseLogicalFunction& rhs) const;
+
+    [[nodiscard]] size_t getNumberOfBranches() const;
+    [[nodiscard]] std::optional<LogicalFunction> getElseValue() const;
+    [[nodiscard]] DataType getDataType() const;
+    [[nodiscard]] CaseLogicalFunction withDataType(const DataType& dataType) const;
+    [[nodiscard]] LogicalFunction withInferredDataType(const Schema& schema) const;
+
+    [[nodiscard]] std::vector<LogicalFunction> getChildren() const;
+    [[nodiscard]] CaseLogicalFunction withChildren(const std::vector<LogicalFunction>& children) const;
+
+    [[nodiscard]] std::string_view getType() const;
+    [[nodiscard]] std::string explain(ExplainVerbosity verbosity) const;
+
+private:
+    DataType dataType;
+    std::vector<LogicalFunction> children;
+
+    friend Reflector<CaseLogicalFunction>;
+};
+
+static_assert(LogicalFunctionConcept<CaseLogicalFunction>);
+
+template <>
+struct Reflector<CaseLogicalFunction>
+{
+    Reflected operator()(const CaseLogicalFunction& function) const;
+};
+
+}
+
+namespace NES::detail
+{
+struct ReflectedCaseLogicalFunction
+{
+    std::vector<LogicalFunction> children;
+};
+}
+
+FMT_OSTREAM(NES::CaseLogicalFunction);
@@ -0,0 +1,111 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Util/Logger/Formatter.hpp>
+#include <Util/PlanRenderer.hpp>
+#include <Util/Reflection.hpp>
+#include <SerializableVariantDescriptor.pb.h>
+
+namespace NES
+{
+
+/// DATE_TRUNC rounds a timestamp down to the start of its unit, EXTRACT returns a field of the calendar date or the time of day
+enum class DateTimeFunctionKind : uint8_t
+{
+    DATE_TRUNC,
+    EXTRACT
+};
+
+/// Weeks start on mondays. DAY_OF_WEEK counts from sunday (0) to saturday (6) and DAY_OF_YEAR counts from 1.
+enum class DateTimeUnit : uint8_t
+{
+    MILLISECOND,
+    SECOND,
+    MINUTE,
+    HOUR,
+    DAY,
+    WEEK,
+    MONTH,
+    YEAR,
+    DAY_OF_WEEK,
+    DAY_OF_YEAR
+};
+
+/// Evaluates DATE_TRUNC or EXTRACT on a TIMESTAMP (or a UINT64 in milliseconds since the epoch) in the local time of a fixed utc offset,
+/// e.g., `DATE_TRUNC(DAY, ts, '+05:30')` or `EXTRACT(HOUR FROM ts)`. DATE_TRUNC returns a TIMESTAMP and EXTRACT returns a UINT64.
+/// Every kind is registered as its own function, i.e., DateTrunc and Extract.
+class DateTimeLogicalFunction final
+{
+public:
+    DateTimeLogicalFunction(DateTimeFunctionKind kind, DateTimeUnit unit, int64_t utcOffsetInMs, const LogicalFunction& value);
+
+    /// Returns false for the units that the kind does not support, e.g., truncating to DAY_OF_WEEK or extracting the WEEK
+    [[nodiscard]] static bool supportsUnit(DateTimeFunctionKind kind, DateTimeUnit unit);
+
+    [[nodiscard]] bool operator==(const DateTimeLogicalFunction& rhs) const;
+
+    [[nodiscard]] DateTimeFunctionKind getKind() const;
+    [[nodiscard]] DateTimeUnit getUnit() const;
+    [[nodiscard]] int64_t getUtcOffsetInMs() const;
+    [[nodiscard]] DataType getDataType() const;
+    [[nodiscard]] DateTimeLogicalFunction withDataType(const DataType& dataType) const;
+    [[nodiscard]] LogicalFunction withInferredDataType(const Schema& schema) const;
+
+    [[nodiscard]] std::vector<LogicalFunction> getChildren() const;
+    [[nodiscard]] DateTimeLogicalFunction withChildren(const std::vector<LogicalFunction>& children) const;
+
+    [[nodiscard]] std::string_view getType() const;
+    [[nodiscard]] std::string explain(ExplainVerbosity verbosity) const;
+
+private:
+    DateTimeFunctionKind kind;
+    DateTimeUnit unit;
+    int64_t utcOffsetInMs;
+    DataType dataType;
+    LogicalFunction value;
+
+    friend Reflector<DateTimeLogicalFunction>;
+};
+
+static_assert(LogicalFunctionConcept<DateTimeLogicalFunction>);
+
+template <>
+struct Reflector<DateTimeLogicalFunction>
+{
+    Reflected operator()(const DateTimeLogicalFunction& function) const;
+};
+
+}
+
+namespace NES::detail
+{
+struct ReflectedDateTimeLogicalFunction
+{
+    DateTimeUnit unit;
+    int64_t utcOffsetInMs;
+    std::optional<LogicalFunction> value;
+};
+}
+
+FMT_OSTREAM(NES::DateTimeLogicalFunction);
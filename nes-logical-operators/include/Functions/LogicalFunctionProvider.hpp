@@ -13,13 +13,21 @@
 */
 
 #pragma once
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
+#include <Functions/FieldAccessLogicalFunction.hpp>
 #include <Functions/LogicalFunction.hpp>
+#include <Operators/Windows/Aggregations/WindowAggregationLogicalFunction.hpp>
 
 namespace NES::LogicalFunctionProvider
 {
 LogicalFunction provide(const std::string& functionName, std::vector<LogicalFunction> arguments);
 std::optional<LogicalFunction> tryProvide(const std::string& functionName, std::vector<LogicalFunction> arguments);
+
+/// Aggregations that are not keywords of the parser, e.g., user-defined aggregations, are provided by their registered name
+bool isRegisteredAggregation(const std::string& functionName);
+std::shared_ptr<WindowAggregationLogicalFunction>
+provideAggregation(const std::string& functionName, const FieldAccessLogicalFunction& onField);
 }
@@ -0,0 +1,85 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Util/Logger/Formatter.hpp>
+#include <Util/PlanRenderer.hpp>
+#include <Util/Reflection.hpp>
+#include <SerializableVariantDescriptor.pb.h>
+
+namespace NES
+{
+
+/// A constant of a query template, whose value the compiled code reads at runtime instead of embedding it. The query compiler replaces
+/// the constants of a plan with parameters, so that plans that only differ in their constants, e.g., `device_id = 17` and
+/// `device_id = 42`, are equal and share their compiled code. Thus, equality and the short explanation ignore the value.
+class ParameterLogicalFunction final
+{
+public:
+    static constexpr std::string_view NAME = "Parameter";
+
+    ParameterLogicalFunction(uint64_t index, DataType dataType, std::string value);
+
+    /// The index of the parameter in the plan and the value that the query binds to it
+    [[nodiscard]] uint64_t getIndex() const;
+    [[nodiscard]] std::string getValue() const;
+    /// The name of the record field that holds the bound value in the compiled code
+    [[nodiscard]] std::string getFieldName() const;
+
+    [[nodiscard]] bool operator==(const ParameterLogicalFunction& rhs) const;
+
+    [[nodiscard]] DataType getDataType() const;
+    [[nodiscard]] ParameterLogicalFunction withDataType(const DataType& dataType) const;
+    [[nodiscard]] LogicalFunction withInferredDataType(const Schema& schema) const;
+
+    [[nodiscard]] std::vector<LogicalFunction> getChildren() const;
+    [[nodiscard]] ParameterLogicalFunction withChildren(const std::vector<LogicalFunction>& children) const;
+
+    [[nodiscard]] std::string_view getType() const;
+    [[nodiscard]] std::string explain(ExplainVerbosity verbosity) const;
+
+private:
+    uint64_t index;
+    DataType dataType;
+    std::string value;
+};
+
+template <>
+struct Reflector<ParameterLogicalFunction>
+{
+    Reflected operator()(const ParameterLogicalFunction& function) const;
+};
+
+static_assert(LogicalFunctionConcept<ParameterLogicalFunction>);
+}
+
+namespace NES::detail
+{
+struct ReflectedParameterLogicalFunction
+{
+    uint64_t index;
+    DataType dataType;
+    std::string value;
+};
+}
+
+FMT_OSTREAM(NES::ParameterLogicalFunction);
@@ -0,0 +1,93 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Util/Logger/Formatter.hpp>
+#include <Util/PlanRenderer.hpp>
+#include <Util/Reflection.hpp>
+#include <SerializableVariantDescriptor.pb.h>
+
+namespace NES
+{
+
+/// The string predicates that a StringMatchLogicalFunction evaluates. LIKE matches the whole value against a pattern, in which `%` matches
+/// any sequence of bytes, `_` matches a single byte and `\` escapes the following byte.
+/// REGEXP_MATCH matches if a regular expression matches any substring of the value.
+enum class StringMatchKind : uint8_t
+{
+    LIKE,
+    STARTS_WITH,
+    ENDS_WITH,
+    CONTAINS,
+    REGEXP_MATCH
+};
+
+/// Evaluates a string predicate of a VARSIZED value and a VARSIZED pattern, e.g., `STARTS_WITH(message, VARSIZED("ERROR"))`.
+/// Every kind is registered as its own function, i.e., Like, StartsWith, EndsWith, Contains and RegexpMatch.
+class StringMatchLogicalFunction final
+{
+public:
+    StringMatchLogicalFunction(StringMatchKind kind, const LogicalFunction& value, const LogicalFunction& pattern);
+
+    [[nodiscard]] bool operator==(const StringMatchLogicalFunction& rhs) const;
+
+    [[nodiscard]] StringMatchKind getKind() const;
+    [[nodiscard]] DataType getDataType() const;
+    [[nodiscard]] StringMatchLogicalFunction withDataType(const DataType& dataType) const;
+    [[nodiscard]] LogicalFunction withInferredDataType(const Schema& schema) const;
+
+    [[nodiscard]] std::vector<LogicalFunction> getChildren() const;
+    [[nodiscard]] StringMatchLogicalFunction withChildren(const std::vector<LogicalFunction>& children) const;
+
+    [[nodiscard]] std::string_view getType() const;
+    [[nodiscard]] std::string explain(ExplainVerbosity verbosity) const;
+
+private:
+    StringMatchKind kind;
+    DataType dataType;
+    LogicalFunction value;
+    LogicalFunction pattern;
+
+    friend Reflector<StringMatchLogicalFunction>;
+};
+
+static_assert(LogicalFunctionConcept<StringMatchLogicalFunction>);
+
+template <>
+struct Reflector<StringMatchLogicalFunction>
+{
+    Reflected operator()(const StringMatchLogicalFunction& function) const;
+};
+
+}
+
+namespace NES::detail
+{
+struct ReflectedStringMatchLogicalFunction
+{
+    std::optional<LogicalFunction> value;
+    std::optional<LogicalFunction> pattern;
+};
+}
+
+FMT_OSTREAM(NES::StringMatchLogicalFunction);
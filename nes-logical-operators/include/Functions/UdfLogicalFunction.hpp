@@ -0,0 +1,86 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Util/Logger/Formatter.hpp>
+#include <Util/PlanRenderer.hpp>
+#include <Util/Reflection.hpp>
+#include <SerializableVariantDescriptor.pb.h>
+
+namespace NES
+{
+
+/// Calls a user-defined function with declared argument and result types. UDF authors register the function of their UDF, e.g.,
+/// FRAUD_SCORE, in the LogicalFunctionRegistry via create() and its physical function in the PhysicalFunctionRegistry.
+/// Type inference casts every argument to its declared type, thus, the physical function receives the declared types.
+class UdfLogicalFunction final
+{
+public:
+    UdfLogicalFunction(std::string name, std::vector<DataType> argumentTypes, DataType resultType, std::vector<LogicalFunction> children);
+
+    /// Creates the function from the children of the parser or from its reflected children
+    [[nodiscard]] static LogicalFunction create(
+        std::string_view name,
+        std::vector<DataType> argumentTypes,
+        DataType resultType,
+        const std::vector<LogicalFunction>& children,
+        const Reflected& reflected);
+
+    [[nodiscard]] bool operator==(const UdfLogicalFunction& rhs) const;
+
+    [[nodiscard]] DataType getDataType() const;
+    [[nodiscard]] UdfLogicalFunction withDataType(const DataType& dataType) const;
+    [[nodiscard]] LogicalFunction withInferredDataType(const Schema& schema) const;
+
+    [[nodiscard]] std::vector<LogicalFunction> getChildren() const;
+    [[nodiscard]] UdfLogicalFunction withChildren(const std::vector<LogicalFunction>& children) const;
+
+    [[nodiscard]] std::string_view getType() const;
+    [[nodiscard]] std::string explain(ExplainVerbosity verbosity) const;
+
+private:
+    std::string name;
+    std::vector<DataType> argumentTypes;
+    DataType resultType;
+    DataType dataType;
+    std::vector<LogicalFunction> children;
+
+    friend Reflector<UdfLogicalFunction>;
+};
+
+static_assert(LogicalFunctionConcept<UdfLogicalFunction>);
+
+template <>
+struct Reflector<UdfLogicalFunction>
+{
+    Reflected operator()(const UdfLogicalFunction& function) const;
+};
+}
+
+namespace NES::detail
+{
+struct ReflectedUdfLogicalFunction
+{
+    std::vector<LogicalFunction> children;
+};
+}
+
+FMT_OSTREAM(NES::UdfLogicalFunction);
@@ -0,0 +1,87 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <DataTypes/Schema.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Traits/Trait.hpp>
+#include <Traits/TraitSet.hpp>
+#include <Util/PlanRenderer.hpp>
+#include <Util/Reflection.hpp>
+
+namespace NES
+{
+
+/// Forwards each record independently with the probability of the sampling fraction, e.g., for FROM stream TABLESAMPLE BERNOULLI(10).
+/// The records keep their schema, thus all downstream operators process solely the sample.
+class BernoulliSampleLogicalOperator
+{
+public:
+    explicit BernoulliSampleLogicalOperator(double fraction);
+
+    [[nodiscard]] double getFraction() const;
+
+    [[nodiscard]] bool operator==(const BernoulliSampleLogicalOperator& rhs) const;
+
+    [[nodiscard]] BernoulliSampleLogicalOperator withTraitSet(TraitSet traitSet) const;
+    [[nodiscard]] TraitSet getTraitSet() const;
+
+    [[nodiscard]] BernoulliSampleLogicalOperator withChildren(std::vector<LogicalOperator> children) const;
+    [[nodiscard]] std::vector<LogicalOperator> getChildren() const;
+
+    [[nodiscard]] std::vector<Schema> getInputSchemas() const;
+    [[nodiscard]] Schema getOutputSchema() const;
+
+    [[nodiscard]] std::string explain(ExplainVerbosity verbosity, OperatorId) const;
+    [[nodiscard]] std::string_view getName() const noexcept;
+
+    [[nodiscard]] BernoulliSampleLogicalOperator withInferredSchema(std::vector<Schema> inputSchemas) const;
+
+private:
+    static constexpr std::string_view NAME = "BernoulliSample";
+    double fraction;
+
+    std::vector<LogicalOperator> children;
+    TraitSet traitSet;
+    Schema inputSchema, outputSchema;
+};
+
+template <>
+struct Reflector<BernoulliSampleLogicalOperator>
+{
+    Reflected operator()(const BernoulliSampleLogicalOperator& op) const;
+};
+
+template <>
+struct Unreflector<BernoulliSampleLogicalOperator>
+{
+    BernoulliSampleLogicalOperator operator()(const Reflected& rfl) const;
+};
+
+static_assert(LogicalOperatorConcept<BernoulliSampleLogicalOperator>);
+}
+
+namespace NES::detail
+{
+struct ReflectedBernoulliSampleLogicalOperator
+{
+    double fraction;
+};
+}
@@ -38,10 +38,18 @@ namespace NES
 class EventTimeWatermarkAssignerLogicalOperator
 {
 public:
-    EventTimeWatermarkAssignerLogicalOperator(LogicalFunction onField, const Windowing::TimeUnit& unit);
+    EventTimeWatermarkAssignerLogicalOperator(
+        LogicalFunction onField,
+        const Windowing::TimeUnit& unit,
+        uint64_t outOfOrdernessBoundInMs = 0,
+        bool adaptiveOutOfOrderness = false);
 
     LogicalFunction onField;
     Windowing::TimeUnit unit;
+    /// The watermark lags behind the largest timestamp by the bound. An adaptive bound is learned per origin from the observed disorder,
+    /// up to the bound.
+    uint64_t outOfOrdernessBoundInMs;
+    bool adaptiveOutOfOrderness;
 
     [[nodiscard]] bool operator==(const EventTimeWatermarkAssignerLogicalOperator& rhs) const;
 
@@ -88,5 +96,7 @@ struct ReflectedEventTimeWatermarkAssignerLogicalOperator
 {
     std::optional<LogicalFunction> onField;
     Windowing::TimeUnit timeUnit;
+    uint64_t outOfOrdernessBoundInMs = 0;
+    bool adaptiveOutOfOrderness = false;
 };
 }
@@ -0,0 +1,90 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <DataTypes/Schema.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Traits/TraitSet.hpp>
+#include <Util/PlanRenderer.hpp>
+#include <Util/Reflection.hpp>
+
+namespace NES
+{
+
+/// Joins each record of a stream (left child) with the records of a static table (right child), e.g., of a file, whose keys are equal.
+/// The table is loaded once into a hash index, which every record of the stream probes. Thus, the join neither slices its inputs nor
+/// waits for watermarks, and its output carries the origins and the sequence numbers of the stream only.
+class LookupJoinLogicalOperator
+{
+public:
+    explicit LookupJoinLogicalOperator(LogicalFunction joinFunction);
+
+    [[nodiscard]] LogicalFunction getJoinFunction() const;
+    [[nodiscard]] Schema getLeftSchema() const;
+    [[nodiscard]] Schema getRightSchema() const;
+
+    [[nodiscard]] bool operator==(const LookupJoinLogicalOperator& rhs) const;
+
+    [[nodiscard]] LookupJoinLogicalOperator withTraitSet(TraitSet traitSet) const;
+    [[nodiscard]] TraitSet getTraitSet() const;
+
+    [[nodiscard]] LookupJoinLogicalOperator withChildren(std::vector<LogicalOperator> children) const;
+    [[nodiscard]] std::vector<LogicalOperator> getChildren() const;
+
+    [[nodiscard]] std::vector<Schema> getInputSchemas() const;
+    [[nodiscard]] Schema getOutputSchema() const;
+
+    [[nodiscard]] std::string explain(ExplainVerbosity verbosity, OperatorId) const;
+    [[nodiscard]] std::string_view getName() const noexcept;
+
+    [[nodiscard]] LookupJoinLogicalOperator withInferredSchema(std::vector<Schema> inputSchemas) const;
+
+private:
+    static constexpr std::string_view NAME = "LookupJoin";
+    LogicalFunction joinFunction;
+
+    std::vector<LogicalOperator> children;
+    TraitSet traitSet;
+    Schema leftInputSchema, rightInputSchema, outputSchema;
+};
+
+template <>
+struct Reflector<LookupJoinLogicalOperator>
+{
+    Reflected operator()(const LookupJoinLogicalOperator& op) const;
+};
+
+template <>
+struct Unreflector<LookupJoinLogicalOperator>
+{
+    LookupJoinLogicalOperator operator()(const Reflected& reflected) const;
+};
+
+static_assert(LogicalOperatorConcept<LookupJoinLogicalOperator>);
+}
+
+namespace NES::detail
+{
+struct ReflectedLookupJoinLogicalOperator
+{
+    std::optional<LogicalFunction> joinFunction;
+};
+}
@@ -51,6 +51,8 @@ public:
     ProjectionLogicalOperator(std::vector<Projection> projections, Asterisk asterisk);
 
     [[nodiscard]] const std::vector<Projection>& getProjections() const;
+    /// Returns true if the projection forwards all fields of its input in addition to its projections
+    [[nodiscard]] bool hasAsterisk() const;
 
     [[nodiscard]] bool operator==(const ProjectionLogicalOperator& rhs) const;
 
@@ -0,0 +1,95 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+
+#include <Functions/FieldAccessLogicalFunction.hpp>
+#include <Operators/Windows/Aggregations/WindowAggregationLogicalFunction.hpp>
+#include <Util/Reflection.hpp>
+#include <SerializableVariantDescriptor.pb.h>
+
+namespace NES
+{
+
+/// Estimates the number of distinct values of the field, i.e., COUNT(DISTINCT field), with a fixed-size HyperLogLog sketch per group.
+/// The estimate has a standard error of about 1.6%. Null values are not counted.
+class ApproxCountDistinctAggregationLogicalFunction
+{
+public:
+    ApproxCountDistinctAggregationLogicalFunction(FieldAccessLogicalFunction onField, FieldAccessLogicalFunction asField);
+    explicit ApproxCountDistinctAggregationLogicalFunction(const FieldAccessLogicalFunction& onField);
+    ~ApproxCountDistinctAggregationLogicalFunction() = default;
+
+    [[nodiscard]] std::string_view getName() const noexcept;
+    [[nodiscard]] std::string toString() const;
+    [[nodiscard]] DataType getInputStamp() const;
+    [[nodiscard]] DataType getPartialAggregateStamp() const;
+    [[nodiscard]] DataType getFinalAggregateStamp() const;
+    [[nodiscard]] FieldAccessLogicalFunction getOnField() const;
+    [[nodiscard]] FieldAccessLogicalFunction getAsField() const;
+
+    [[nodiscard]] Reflected reflect() const;
+    [[nodiscard]] ApproxCountDistinctAggregationLogicalFunction withInferredStamp(const Schema& schema) const;
+    [[nodiscard]] ApproxCountDistinctAggregationLogicalFunction withInputStamp(DataType inputStamp) const;
+    [[nodiscard]] ApproxCountDistinctAggregationLogicalFunction withPartialAggregateStamp(DataType partialAggregateStamp) const;
+    [[nodiscard]] ApproxCountDistinctAggregationLogicalFunction withFinalAggregateStamp(DataType finalAggregateStamp) const;
+    [[nodiscard]] ApproxCountDistinctAggregationLogicalFunction withOnField(FieldAccessLogicalFunction onField) const;
+    [[nodiscard]] ApproxCountDistinctAggregationLogicalFunction withAsField(FieldAccessLogicalFunction asField) const;
+    [[nodiscard]] static bool shallIncludeNullValues() noexcept;
+
+    [[nodiscard]] bool operator==(const ApproxCountDistinctAggregationLogicalFunction& other) const;
+
+
+private:
+    static constexpr std::string_view NAME = "ApproxCountDistinct";
+
+    DataType inputStamp;
+    DataType partialAggregateStamp;
+    DataType finalAggregateStamp;
+    FieldAccessLogicalFunction onField;
+    FieldAccessLogicalFunction asField;
+};
+
+static_assert(WindowAggregationFunctionConcept<ApproxCountDistinctAggregationLogicalFunction>);
+
+template <>
+struct Reflector<ApproxCountDistinctAggregationLogicalFunction>
+{
+    Reflected operator()(const ApproxCountDistinctAggregationLogicalFunction& function) const;
+};
+
+template <>
+struct Unreflector<ApproxCountDistinctAggregationLogicalFunction>
+{
+    ApproxCountDistinctAggregationLogicalFunction operator()(const Reflected& reflected) const;
+};
+
+}
+
+namespace NES::detail
+{
+struct ReflectedApproxCountDistinctAggregationLogicalFunction
+{
+    std::optional<FieldAccessLogicalFunction> onField;
+    std::optional<FieldAccessLogicalFunction> asField;
+};
+
+}
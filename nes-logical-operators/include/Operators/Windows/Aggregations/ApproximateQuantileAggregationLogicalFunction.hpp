@@ -0,0 +1,113 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/FieldAccessLogicalFunction.hpp>
+#include <Operators/Windows/Aggregations/WindowAggregationLogicalFunction.hpp>
+#include <Util/Reflection.hpp>
+#include <SerializableVariantDescriptor.pb.h>
+
+namespace NES
+{
+
+/// Approximates a quantile of the field, e.g., the 99th percentile, with a fixed-size sketch per group.
+/// In contrast to the exact median, the size of the aggregation state does not depend on the number of values in a window.
+/// The sketch decides about the physical aggregation function and is part of the name, e.g., TDigestQuantile.
+class ApproximateQuantileAggregationLogicalFunction
+{
+public:
+    enum class Sketch : uint8_t
+    {
+        /// Accurate for extreme quantiles
+        TDIGEST,
+        /// Uniform rank error across all quantiles
+        KLL
+    };
+
+    /// Creates a new ApproximateQuantileAggregationLogicalFunction
+    /// @param sketch sketch that approximates the quantile
+    /// @param onField field on which the aggregation should be performed
+    /// @param asField function describing how the aggregated field should be called
+    /// @param quantile quantile in [0, 1] that should be approximated, e.g., 0.5 for the median
+    ApproximateQuantileAggregationLogicalFunction(
+        Sketch sketch, const FieldAccessLogicalFunction& onField, FieldAccessLogicalFunction asField, double quantile);
+    ApproximateQuantileAggregationLogicalFunction(Sketch sketch, const FieldAccessLogicalFunction& onField, double quantile);
+    ~ApproximateQuantileAggregationLogicalFunction() = default;
+
+    [[nodiscard]] std::string_view getName() const noexcept;
+    [[nodiscard]] std::string toString() const;
+    [[nodiscard]] Reflected reflect() const;
+    [[nodiscard]] DataType getInputStamp() const;
+    [[nodiscard]] DataType getPartialAggregateStamp() const;
+    [[nodiscard]] DataType getFinalAggregateStamp() const;
+    [[nodiscard]] FieldAccessLogicalFunction getOnField() const;
+    [[nodiscard]] FieldAccessLogicalFunction getAsField() const;
+    [[nodiscard]] Sketch getSketch() const;
+    [[nodiscard]] double getQuantile() const;
+
+    [[nodiscard]] ApproximateQuantileAggregationLogicalFunction withInferredStamp(const Schema& schema) const;
+    [[nodiscard]] ApproximateQuantileAggregationLogicalFunction withInputStamp(DataType inputStamp) const;
+    [[nodiscard]] ApproximateQuantileAggregationLogicalFunction withPartialAggregateStamp(DataType partialAggregateStamp) const;
+    [[nodiscard]] ApproximateQuantileAggregationLogicalFunction withFinalAggregateStamp(DataType finalAggregateStamp) const;
+    [[nodiscard]] ApproximateQuantileAggregationLogicalFunction withOnField(FieldAccessLogicalFunction onField) const;
+    [[nodiscard]] ApproximateQuantileAggregationLogicalFunction withAsField(FieldAccessLogicalFunction asField) const;
+    [[nodiscard]] static bool shallIncludeNullValues() noexcept;
+    [[nodiscard]] bool operator==(const ApproximateQuantileAggregationLogicalFunction& other) const;
+
+    static constexpr std::string_view TDIGEST_NAME = "TDigestQuantile";
+    static constexpr std::string_view KLL_NAME = "KllQuantile";
+
+private:
+    Sketch sketch;
+    double quantile;
+    DataType inputStamp;
+    DataType partialAggregateStamp;
+    DataType finalAggregateStamp;
+    FieldAccessLogicalFunction onField;
+    FieldAccessLogicalFunction asField;
+};
+
+static_assert(WindowAggregationFunctionConcept<ApproximateQuantileAggregationLogicalFunction>);
+
+template <>
+struct Reflector<ApproximateQuantileAggregationLogicalFunction>
+{
+    Reflected operator()(const ApproximateQuantileAggregationLogicalFunction& function) const;
+};
+
+template <>
+struct Unreflector<ApproximateQuantileAggregationLogicalFunction>
+{
+    ApproximateQuantileAggregationLogicalFunction operator()(const Reflected& reflected) const;
+};
+}
+
+namespace NES::detail
+{
+struct ReflectedApproximateQuantileAggregationLogicalFunction
+{
+    ApproximateQuantileAggregationLogicalFunction::Sketch sketch;
+    FieldAccessLogicalFunction onField;
+    FieldAccessLogicalFunction asField;
+    double quantile;
+};
+
+}
@@ -0,0 +1,88 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/FieldAccessLogicalFunction.hpp>
+#include <Operators/Windows/Aggregations/WindowAggregationLogicalFunction.hpp>
+#include <Util/Reflection.hpp>
+#include <SerializableVariantDescriptor.pb.h>
+
+namespace NES
+{
+
+/// A user-defined aggregation with a declared result type. UDF authors register the aggregation of their UDF in the
+/// AggregationLogicalFunctionRegistry via create() and its physical function, a BatchUdfAggregationPhysicalFunction, in the
+/// AggregationPhysicalFunctionRegistry. Null values of the field are not passed to the UDF.
+class UdfAggregationLogicalFunction
+{
+public:
+    UdfAggregationLogicalFunction(
+        std::string name, DataType resultType, const FieldAccessLogicalFunction& onField, FieldAccessLogicalFunction asField);
+
+    /// Creates the aggregation from the fields of the parser or from its reflected fields
+    [[nodiscard]] static std::shared_ptr<WindowAggregationLogicalFunction>
+    create(std::string_view name, DataType resultType, const std::vector<FieldAccessLogicalFunction>& fields, const Reflected& reflected);
+
+    [[nodiscard]] std::string_view getName() const noexcept;
+    [[nodiscard]] std::string toString() const;
+    [[nodiscard]] Reflected reflect() const;
+    [[nodiscard]] DataType getInputStamp() const;
+    [[nodiscard]] DataType getPartialAggregateStamp() const;
+    [[nodiscard]] DataType getFinalAggregateStamp() const;
+    [[nodiscard]] FieldAccessLogicalFunction getOnField() const;
+    [[nodiscard]] FieldAccessLogicalFunction getAsField() const;
+
+    [[nodiscard]] UdfAggregationLogicalFunction withInferredStamp(const Schema& schema) const;
+    [[nodiscard]] UdfAggregationLogicalFunction withInputStamp(DataType inputStamp) const;
+    [[nodiscard]] UdfAggregationLogicalFunction withPartialAggregateStamp(DataType partialAggregateStamp) const;
+    [[nodiscard]] UdfAggregationLogicalFunction withFinalAggregateStamp(DataType finalAggregateStamp) const;
+    [[nodiscard]] UdfAggregationLogicalFunction withOnField(FieldAccessLogicalFunction onField) const;
+    [[nodiscard]] UdfAggregationLogicalFunction withAsField(FieldAccessLogicalFunction asField) const;
+    [[nodiscard]] static bool shallIncludeNullValues() noexcept;
+    [[nodiscard]] bool operator==(const UdfAggregationLogicalFunction& other) const;
+
+private:
+    std::string name;
+    DataType resultType;
+    DataType inputStamp;
+    DataType partialAggregateStamp;
+    DataType finalAggregateStamp;
+    FieldAccessLogicalFunction onField;
+    FieldAccessLogicalFunction asField;
+};
+
+static_assert(WindowAggregationFunctionConcept<UdfAggregationLogicalFunction>);
+
+template <>
+struct Reflector<UdfAggregationLogicalFunction>
+{
+    Reflected operator()(const UdfAggregationLogicalFunction& function) const;
+};
+}
+
+namespace NES::detail
+{
+struct ReflectedUdfAggregationLogicalFunction
+{
+    FieldAccessLogicalFunction onField;
+    FieldAccessLogicalFunction asField;
+};
+}
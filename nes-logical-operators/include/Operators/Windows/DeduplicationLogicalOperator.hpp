@@ -0,0 +1,95 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <DataTypes/Schema.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Traits/Trait.hpp>
+#include <Traits/TraitSet.hpp>
+#include <Util/PlanRenderer.hpp>
+#include <Util/Reflection.hpp>
+#include <WindowTypes/Types/WindowType.hpp>
+
+namespace NES
+{
+
+/// Forwards the first record of each key per tumbling window and drops all later records with the same key, e.g., for SELECT DISTINCT.
+/// The records keep their schema, as they are forwarded right away instead of once the window is triggered.
+/// Without keys, the whole record is the key.
+class DeduplicationLogicalOperator
+{
+public:
+    DeduplicationLogicalOperator(std::vector<LogicalFunction> keys, std::shared_ptr<Windowing::WindowType> windowType);
+
+    [[nodiscard]] const std::vector<LogicalFunction>& getKeys() const;
+    [[nodiscard]] std::shared_ptr<Windowing::WindowType> getWindowType() const;
+
+    [[nodiscard]] bool operator==(const DeduplicationLogicalOperator& rhs) const;
+
+    [[nodiscard]] DeduplicationLogicalOperator withTraitSet(TraitSet traitSet) const;
+    [[nodiscard]] TraitSet getTraitSet() const;
+
+    [[nodiscard]] DeduplicationLogicalOperator withChildren(std::vector<LogicalOperator> children) const;
+    [[nodiscard]] std::vector<LogicalOperator> getChildren() const;
+
+    [[nodiscard]] std::vector<Schema> getInputSchemas() const;
+    [[nodiscard]] Schema getOutputSchema() const;
+
+    [[nodiscard]] std::string explain(ExplainVerbosity verbosity, OperatorId) const;
+    [[nodiscard]] std::string_view getName() const noexcept;
+
+    [[nodiscard]] DeduplicationLogicalOperator withInferredSchema(std::vector<Schema> inputSchemas) const;
+
+private:
+    static constexpr std::string_view NAME = "Deduplication";
+    std::vector<LogicalFunction> keys;
+    std::shared_ptr<Windowing::WindowType> windowType;
+
+    std::vector<LogicalOperator> children;
+    TraitSet traitSet;
+    Schema inputSchema, outputSchema;
+};
+
+template <>
+struct Reflector<DeduplicationLogicalOperator>
+{
+    Reflected operator()(const DeduplicationLogicalOperator& op) const;
+};
+
+template <>
+struct Unreflector<DeduplicationLogicalOperator>
+{
+    DeduplicationLogicalOperator operator()(const Reflected& reflected) const;
+};
+
+static_assert(LogicalOperatorConcept<DeduplicationLogicalOperator>);
+
+}
+
+namespace NES::detail
+{
+struct ReflectedDeduplicationLogicalOperator
+{
+    std::vector<std::optional<LogicalFunction>> keys;
+    Reflected windowType;
+};
+}
@@ -51,6 +51,7 @@ public:
     explicit JoinLogicalOperator(LogicalFunction joinFunction, std::shared_ptr<Windowing::WindowType> windowType, JoinType joinType);
 
     [[nodiscard]] LogicalFunction getJoinFunction() const;
+    [[nodiscard]] JoinType getJoinType() const;
     [[nodiscard]] Schema getLeftSchema() const;
     [[nodiscard]] Schema getRightSchema() const;
     [[nodiscard]] std::shared_ptr<Windowing::WindowType> getWindowType() const;
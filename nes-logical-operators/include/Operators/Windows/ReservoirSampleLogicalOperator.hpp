@@ -0,0 +1,94 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <DataTypes/Schema.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Operators/OriginIdAssigner.hpp>
+#include <Traits/Trait.hpp>
+#include <Traits/TraitSet.hpp>
+#include <Util/PlanRenderer.hpp>
+#include <Util/Reflection.hpp>
+#include <WindowTypes/Types/WindowType.hpp>
+
+namespace NES
+{
+
+/// Emits a uniform sample of at most sampleSize records of each tumbling or sliding window, once the window ends,
+/// e.g., for FROM stream TABLESAMPLE RESERVOIR(100) ... WINDOW TUMBLING(...). The records keep their schema.
+class ReservoirSampleLogicalOperator final : public OriginIdAssigner
+{
+public:
+    ReservoirSampleLogicalOperator(uint64_t sampleSize, std::shared_ptr<Windowing::WindowType> windowType);
+
+    [[nodiscard]] uint64_t getSampleSize() const;
+    [[nodiscard]] std::shared_ptr<Windowing::WindowType> getWindowType() const;
+
+    [[nodiscard]] bool operator==(const ReservoirSampleLogicalOperator& rhs) const;
+
+    [[nodiscard]] ReservoirSampleLogicalOperator withTraitSet(TraitSet traitSet) const;
+    [[nodiscard]] TraitSet getTraitSet() const;
+
+    [[nodiscard]] ReservoirSampleLogicalOperator withChildren(std::vector<LogicalOperator> children) const;
+    [[nodiscard]] std::vector<LogicalOperator> getChildren() const;
+
+    [[nodiscard]] std::vector<Schema> getInputSchemas() const;
+    [[nodiscard]] Schema getOutputSchema() const;
+
+    [[nodiscard]] std::string explain(ExplainVerbosity verbosity, OperatorId) const;
+    [[nodiscard]] std::string_view getName() const noexcept;
+
+    [[nodiscard]] ReservoirSampleLogicalOperator withInferredSchema(std::vector<Schema> inputSchemas) const;
+
+private:
+    static constexpr std::string_view NAME = "ReservoirSample";
+    uint64_t sampleSize;
+    std::shared_ptr<Windowing::WindowType> windowType;
+
+    std::vector<LogicalOperator> children;
+    TraitSet traitSet;
+    Schema inputSchema, outputSchema;
+};
+
+template <>
+struct Reflector<ReservoirSampleLogicalOperator>
+{
+    Reflected operator()(const ReservoirSampleLogicalOperator& op) const;
+};
+
+template <>
+struct Unreflector<ReservoirSampleLogicalOperator>
+{
+    ReservoirSampleLogicalOperator operator()(const Reflected& reflected) const;
+};
+
+static_assert(LogicalOperatorConcept<ReservoirSampleLogicalOperator>);
+
+}
+
+namespace NES::detail
+{
+struct ReflectedReservoirSampleLogicalOperator
+{
+    uint64_t sampleSize;
+    Reflected windowType;
+};
+}
@@ -40,14 +40,27 @@
 namespace NES
 {
 
+/// Restricts the output of each window to the records with the `limit` largest values of the order field (or the smallest ones, if
+/// ascending), e.g., for ORDER BY revenue DESC LIMIT 10. Records with a null value come last.
+struct WindowTopK
+{
+    FieldAccessLogicalFunction orderField;
+    bool ascending;
+    uint64_t limit;
+
+    bool operator==(const WindowTopK& other) const = default;
+};
+
 class WindowedAggregationLogicalOperator final : public OriginIdAssigner
 {
 public:
     WindowedAggregationLogicalOperator(
         std::vector<FieldAccessLogicalFunction> groupingKey,
         std::vector<std::shared_ptr<WindowAggregationLogicalFunction>> aggregationFunctions,
-        std::shared_ptr<Windowing::WindowType> windowType);
-
+        std::shared_ptr<Windowing::WindowType> windowType,
+        std::optional<WindowTopK> topK = std::nullopt,
+        std::optional<uint64_t> earlyResultIntervalInMs = std::nullopt,
+        std::optional<uint64_t> allowedLatenessInMs = std::nullopt);
 
     [[nodiscard]] std::vector<std::string> getGroupByKeyNames() const;
     [[nodiscard]] bool isKeyed() const;
@@ -60,6 +73,17 @@ public:
 
     [[nodiscard]] std::vector<FieldAccessLogicalFunction> getGroupingKeys() const;
 
+    /// Returns the top-k records that each window emits, or nullopt if each window emits the records of all its keys
+    [[nodiscard]] const std::optional<WindowTopK>& getTopK() const;
+
+    /// Returns the interval of processing time, after which each window that is still filling emits the records of the keys that changed
+    /// since its previous early result, or nullopt if each window emits its records solely once it gets triggered
+    [[nodiscard]] std::optional<uint64_t> getEarlyResultIntervalInMs() const;
+
+    /// Returns the event time after the end of a triggered window, during which late records update the window and let it emit the keys
+    /// that changed since its previous emission. Records that arrive afterwards are discarded. Nullopt, if the windows drop late records.
+    [[nodiscard]] std::optional<uint64_t> getAllowedLatenessInMs() const;
+
     [[nodiscard]] std::string getWindowStartFieldName() const;
     [[nodiscard]] std::string getWindowEndFieldName() const;
     [[nodiscard]] const WindowMetaData& getWindowMetaData() const;
@@ -86,6 +110,9 @@ private:
     std::vector<std::shared_ptr<WindowAggregationLogicalFunction>> aggregationFunctions;
     std::shared_ptr<Windowing::WindowType> windowType;
     std::vector<FieldAccessLogicalFunction> groupingKey;
+    std::optional<WindowTopK> topK;
+    std::optional<uint64_t> earlyResultIntervalInMs;
+    std::optional<uint64_t> allowedLatenessInMs;
     WindowMetaData windowMetaData;
 
     std::vector<LogicalOperator> children;
@@ -116,5 +143,8 @@ struct ReflectedWindowAggregationLogicalOperator
     std::vector<std::pair<std::string, Reflected>> aggregations;
     std::vector<FieldAccessLogicalFunction> keys;
     Reflected windowType;
+    std::optional<WindowTopK> topK;
+    std::optional<uint64_t> earlyResultIntervalInMs;
+    std::optional<uint64_t> allowedLatenessInMs;
 };
 }
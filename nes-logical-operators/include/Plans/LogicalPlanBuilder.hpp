@@ -14,7 +14,9 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -25,6 +27,7 @@
 #include <Operators/ProjectionLogicalOperator.hpp>
 #include <Operators/Windows/Aggregations/WindowAggregationLogicalFunction.hpp>
 #include <Operators/Windows/JoinLogicalOperator.hpp>
+#include <Operators/Windows/WindowedAggregationLogicalOperator.hpp>
 #include <Plans/LogicalPlan.hpp>
 #include <WindowTypes/Types/WindowType.hpp>
 
@@ -59,11 +62,36 @@ public:
     /// @return the updated queryPlan
     static LogicalPlan addSelection(LogicalFunction selectionFunction, const LogicalPlan& queryPlan);
 
+    /// Adds a Bernoulli sample that forwards each record with the probability of the fraction
+    static LogicalPlan addBernoulliSample(double fraction, const LogicalPlan& queryPlan);
+
     static LogicalPlan addWindowAggregation(
         LogicalPlan queryPlan,
         const std::shared_ptr<Windowing::WindowType>& windowType,
         std::vector<std::shared_ptr<WindowAggregationLogicalFunction>> windowAggs,
-        std::vector<FieldAccessLogicalFunction> onKeys);
+        std::vector<FieldAccessLogicalFunction> onKeys,
+        std::optional<WindowTopK> topK = std::nullopt,
+        std::optional<uint64_t> earlyResultIntervalInMs = std::nullopt,
+        std::optional<uint64_t> allowedLatenessInMs = std::nullopt,
+        uint64_t outOfOrdernessBoundInMs = 0,
+        bool adaptiveOutOfOrderness = false);
+
+    /// Adds a deduplication that forwards the first record of each key per window, e.g., for SELECT DISTINCT. Without keys, the whole
+    /// record is the key.
+    static LogicalPlan addDeduplication(
+        LogicalPlan queryPlan,
+        const std::shared_ptr<Windowing::WindowType>& windowType,
+        std::vector<LogicalFunction> keys,
+        uint64_t outOfOrdernessBoundInMs = 0,
+        bool adaptiveOutOfOrderness = false);
+
+    /// Adds a reservoir sample that emits a uniform sample of at most sampleSize records per window
+    static LogicalPlan addReservoirSample(
+        LogicalPlan queryPlan,
+        const std::shared_ptr<Windowing::WindowType>& windowType,
+        uint64_t sampleSize,
+        uint64_t outOfOrdernessBoundInMs = 0,
+        bool adaptiveOutOfOrderness = false);
 
     /// @brief UnionOperator to combine two query plans
     /// @param leftLogicalPlan the left query plan to combine by the union
@@ -84,6 +112,13 @@ public:
         std::shared_ptr<Windowing::WindowType> windowType,
         JoinLogicalOperator::JoinType joinType);
 
+    /// @brief This methods adds the lookup join operator, which looks up the records of a static table for each record of a stream
+    /// @param streamLogicalPlan the query plan of the stream, i.e., the left side of the join
+    /// @param tableLogicalPlan the query plan of the table, i.e., the right side of the join
+    /// @param joinFunction conjunction of equalities between the fields of the stream and the table
+    /// @return the updated queryPlan
+    static LogicalPlan addLookupJoin(LogicalPlan streamLogicalPlan, LogicalPlan tableLogicalPlan, const LogicalFunction& joinFunction);
+
     static LogicalPlan addSink(std::string sinkName, const LogicalPlan& queryPlan);
     static LogicalPlan addInlineSink(
         std::string type, const Schema& schema, std::unordered_map<std::string, std::string> sinkConfig, const LogicalPlan& queryPlan);
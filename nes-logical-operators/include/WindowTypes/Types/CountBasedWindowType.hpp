@@ -0,0 +1,72 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <DataTypes/Schema.hpp>
+#include <Util/Reflection.hpp>
+#include <WindowTypes/Types/WindowType.hpp>
+
+namespace NES::Windowing
+{
+/// A CountBasedWindowType groups records by their position in the stream instead of their timestamp, e.g., a tumbling count window
+/// of size 100 contains the records 0-99, 100-199, and so on. Sliding count windows overlap by (size - slide) records.
+/// The positions are assigned in the order in which the records are processed by the window operator. Thus, the contents of the windows
+/// are only deterministic, if the records arrive in a deterministic order, e.g., a single source and a single worker thread.
+/// The start and end of an emitted window are the position of its first record and the position after its last record.
+/// The positions count the records of all keys. Thus, count-based windows are only supported for aggregations without keys.
+class CountBasedWindowType final : public WindowType
+{
+public:
+    CountBasedWindowType(uint64_t size, uint64_t slide);
+    [[nodiscard]] uint64_t getSize() const;
+    [[nodiscard]] uint64_t getSlide() const;
+    [[nodiscard]] std::string toString() const override;
+    bool operator==(const WindowType& otherWindowType) const override;
+
+    /// Count-based windows do not access any field of the input schema
+    bool inferStamp(const Schema& schema) override;
+
+private:
+    uint64_t size;
+    uint64_t slide;
+};
+
+}
+
+namespace NES
+{
+template <>
+struct Reflector<Windowing::CountBasedWindowType>
+{
+    Reflected operator()(const Windowing::CountBasedWindowType& countBasedWindow) const;
+};
+
+template <>
+struct Unreflector<Windowing::CountBasedWindowType>
+{
+    Windowing::CountBasedWindowType operator()(const Reflected& reflected) const;
+};
+}
+
+namespace NES::detail
+{
+struct ReflectedCountBasedWindowType
+{
+    uint64_t size{0};
+    uint64_t slide{0};
+};
+}
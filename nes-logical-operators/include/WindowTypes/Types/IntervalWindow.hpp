@@ -0,0 +1,75 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <Util/Reflection.hpp>
+#include <WindowTypes/Measures/TimeCharacteristic.hpp>
+#include <WindowTypes/Measures/TimeMeasure.hpp>
+#include <WindowTypes/Types/TimeBasedWindowType.hpp>
+#include <WindowTypes/Types/WindowType.hpp>
+
+namespace NES::Windowing
+{
+/// An IntervalWindow joins every left record with the right records whose timestamps lie within
+/// [left timestamp + lower bound, left timestamp + upper bound]. The bounds are in milliseconds and may be negative.
+/// We evaluate it as a sliding window, whose slide is the length of the interval. Each window owns the left records of one slide-long
+/// slice and its size covers the intervals of these records. Thus, the join keeps only the slices up to one window size behind the
+/// watermark and joins every pair of records in exactly one window. The window that starts at zero also owns all earlier left records.
+class IntervalWindow final : public TimeBasedWindowType
+{
+public:
+    IntervalWindow(TimeCharacteristic timeCharacteristic, int64_t lowerBound, int64_t upperBound);
+    [[nodiscard]] int64_t getLowerBound() const;
+    [[nodiscard]] int64_t getUpperBound() const;
+    /// Returns the distance of the slice, whose left records a window owns, to the start of the window
+    [[nodiscard]] uint64_t getOffsetOfOwnedSlice() const;
+    [[nodiscard]] TimeMeasure getSize() const override;
+    [[nodiscard]] TimeMeasure getSlide() const override;
+    [[nodiscard]] std::string toString() const override;
+    bool operator==(const WindowType& otherWindowType) const override;
+
+private:
+    const int64_t lowerBound;
+    const int64_t upperBound;
+};
+
+}
+
+namespace NES
+{
+template <>
+struct Reflector<Windowing::IntervalWindow>
+{
+    Reflected operator()(const Windowing::IntervalWindow& intervalWindow) const;
+};
+
+template <>
+struct Unreflector<Windowing::IntervalWindow>
+{
+    Windowing::IntervalWindow operator()(const Reflected& reflected) const;
+};
+}
+
+namespace NES::detail
+{
+struct ReflectedIntervalWindow
+{
+    int64_t lowerBound{0};
+    int64_t upperBound{0};
+    Windowing::TimeCharacteristic timeCharacteristic;
+};
+}
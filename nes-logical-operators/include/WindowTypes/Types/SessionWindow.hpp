@@ -0,0 +1,69 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <string>
+#include <Util/Reflection.hpp>
+#include <WindowTypes/Measures/TimeCharacteristic.hpp>
+#include <WindowTypes/Measures/TimeMeasure.hpp>
+#include <WindowTypes/Types/TimeBasedWindowType.hpp>
+#include <WindowTypes/Types/WindowType.hpp>
+
+namespace NES::Windowing
+{
+/// A SessionWindow groups records into sessions of activity. A session ends, if no record arrives for at least the gap, i.e.,
+/// two records belong to the same session, if they are connected via records whose timestamps are less than the gap apart.
+/// A session [start, end) starts at the timestamp of its first record and ends one gap after the timestamp of its last record.
+/// Sessions are formed over all records of the window operator, i.e., the same sessions are used for all keys.
+class SessionWindow final : public TimeBasedWindowType
+{
+public:
+    SessionWindow(TimeCharacteristic timeCharacteristic, TimeMeasure gap);
+    [[nodiscard]] TimeMeasure getGap() const;
+    /// A session has no fixed size or slide. We return the gap for both, as it is the minimal extent of a session.
+    [[nodiscard]] TimeMeasure getSize() const override;
+    [[nodiscard]] TimeMeasure getSlide() const override;
+    [[nodiscard]] std::string toString() const override;
+    bool operator==(const WindowType& otherWindowType) const override;
+
+private:
+    const TimeMeasure gap;
+};
+
+}
+
+namespace NES
+{
+template <>
+struct Reflector<Windowing::SessionWindow>
+{
+    Reflected operator()(const Windowing::SessionWindow& sessionWindow) const;
+};
+
+template <>
+struct Unreflector<Windowing::SessionWindow>
+{
+    Windowing::SessionWindow operator()(const Reflected& reflected) const;
+};
+}
+
+namespace NES::detail
+{
+struct ReflectedSessionWindow
+{
+    Windowing::TimeMeasure gap{0};
+    Windowing::TimeCharacteristic timeCharacteristic;
+};
+}
@@ -0,0 +1,187 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Functions/CaseLogicalFunction.hpp>
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Serialization/LogicalFunctionReflection.hpp>
+#include <Util/PlanRenderer.hpp>
+#include <Util/Reflection.hpp>
+#include <fmt/format.h>
+#include <ErrorHandling.hpp>
+#include <LogicalFunctionRegistry.hpp>
+
+namespace NES
+{
+
+CaseLogicalFunction::CaseLogicalFunction(
+    const std::vector<std::pair<LogicalFunction, LogicalFunction>>& branches, std::optional<LogicalFunction> elseValue)
+{
+    PRECONDITION(not branches.empty(), "A CASE requires at least one branch");
+    children.reserve((branches.size() * 2) + 1);
+    for (const auto& [condition, value] : branches)
+    {
+        children.push_back(condition);
+        children.push_back(value);
+    }
+    if (elseValue.has_value())
+    {
+        children.push_back(std::move(elseValue.value()));
+    }
+    dataType = children[1].getDataType();
+}
+
+bool CaseLogicalFunction::operator==(const CaseLogicalFunction& rhs) const
+{
+    return children == rhs.children;
+}
+
+std::string CaseLogicalFunction::explain(ExplainVerbosity verbosity) const
+{
+    std::string explained = "CASE";
+    for (size_t branch = 0; branch < getNumberOfBranches(); ++branch)
+    {
+        explained += fmt::format(
+            " WHEN {} THEN {}", children[branch * 2].explain(verbosity), children[(branch * 2) + 1].explain(verbosity));
+    }
+    if (const auto elseValue = getElseValue())
+    {
+        explained += fmt::format(" ELSE {}", elseValue->explain(verbosity));
+    }
+    return explained + " END";
+}
+
+size_t CaseLogicalFunction::getNumberOfBranches() const
+{
+    return children.size() / 2;
+}
+
+std::optional<LogicalFunction> CaseLogicalFunction::getElseValue() const
+{
+    if (children.size() % 2 == 0)
+    {
+        return std::nullopt;
+    }
+    return children.back();
+}
+
+DataType CaseLogicalFunction::getDataType() const
+{
+    return dataType;
+};
+
+CaseLogicalFunction CaseLogicalFunction::withDataType(const DataType& dataType) const
+{
+    auto copy = *this;
+    copy.dataType = dataType;
+    return copy;
+};
+
+LogicalFunction CaseLogicalFunction::withInferredDataType(const Schema& schema) const
+{
+    std::vector<LogicalFunction> newChildren;
+    newChildren.reserve(children.size());
+    for (const auto& child : children)
+    {
+        newChildren.push_back(child.withInferredDataType(schema));
+    }
+
+    /// The result has the common type of all values, i.e., the THEN values and the ELSE value
+    std::optional<DataType> newDataType;
+    for (size_t child = 0; child < newChildren.size(); ++child)
+    {
+        const auto childDataType = newChildren[child].getDataType();
+        if (child % 2 == 0 and child + 1 < newChildren.size())
+        {
+            if (not childDataType.isType(DataType::Type::BOOLEAN))
+            {
+                throw DifferentFieldTypeExpected("The conditions of a CASE must be BOOLEAN, but got {}", childDataType);
+            }
+            continue;
+        }
+        auto commonDataType = newDataType.has_value() ? newDataType->join(childDataType) : std::optional{childDataType};
+        if (not commonDataType.has_value())
+        {
+            throw DifferentFieldTypeExpected("The values of a CASE have no common type, got {} and {}", newDataType.value(), childDataType);
+        }
+        newDataType = std::move(commonDataType);
+    }
+    newDataType->nullable = newDataType->nullable or not getElseValue().has_value();
+    return withDataType(newDataType.value()).withChildren(newChildren);
+};
+
+std::vector<LogicalFunction> CaseLogicalFunction::getChildren() const
+{
+    return children;
+};
+
+CaseLogicalFunction CaseLogicalFunction::withChildren(const std::vector<LogicalFunction>& children) const
+{
+    PRECONDITION(children.size() >= 2, "{} requires at least a condition and a value, but got {} children", getType(), children.size());
+    auto copy = *this;
+    copy.children = children;
+    return copy;
+};
+
+std::string_view CaseLogicalFunction::getType() const
+{
+    return NAME;
+}
+
+Reflected Reflector<CaseLogicalFunction>::operator()(const CaseLogicalFunction& function) const
+{
+    return reflect(detail::ReflectedCaseLogicalFunction{.children = function.children});
+}
+
+namespace
+{
+CaseLogicalFunction createCaseFunction(const std::vector<LogicalFunction>& children)
+{
+    if (children.size() < 2)
+    {
+        throw CannotDeserialize("CaseLogicalFunction requires at least two children, but got {}", children.size());
+    }
+    std::vector<std::pair<LogicalFunction, LogicalFunction>> branches;
+    for (size_t child = 0; child + 1 < children.size(); child += 2)
+    {
+        branches.emplace_back(children[child], children[child + 1]);
+    }
+    std::optional<LogicalFunction> elseValue;
+    if (children.size() % 2 == 1)
+    {
+        elseValue = children.back();
+    }
+    return CaseLogicalFunction{branches, elseValue};
+}
+}
+
+LogicalFunctionRegistryReturnType LogicalFunctionGeneratedRegistrar::RegisterCaseLogicalFunction(LogicalFunctionRegistryArguments arguments)
+{
+    if (!arguments.reflected.isEmpty())
+    {
+        auto [children] = unreflect<detail::ReflectedCaseLogicalFunction>(arguments.reflected);
+        return createCaseFunction(children);
+    }
+    return createCaseFunction(arguments.children);
+}
+
+}
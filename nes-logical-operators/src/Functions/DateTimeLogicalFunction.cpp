@@ -0,0 +1,189 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Functions/DateTimeLogicalFunction.hpp>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/DataTypeProvider.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Serialization/LogicalFunctionReflection.hpp>
+#include <Util/PlanRenderer.hpp>
+#include <Util/Reflection.hpp>
+#include <fmt/format.h>
+#include <magic_enum/magic_enum.hpp>
+#include <ErrorHandling.hpp>
+#include <LogicalFunctionRegistry.hpp>
+
+namespace NES
+{
+
+DateTimeLogicalFunction::DateTimeLogicalFunction(
+    const DateTimeFunctionKind kind, const DateTimeUnit unit, const int64_t utcOffsetInMs, const LogicalFunction& value)
+    : kind(kind)
+    , unit(unit)
+    , utcOffsetInMs(utcOffsetInMs)
+    , dataType(DataTypeProvider::provideDataType(
+          kind == DateTimeFunctionKind::DATE_TRUNC ? DataType::Type::TIMESTAMP : DataType::Type::UINT64, DataType::NULLABLE::NOT_NULLABLE))
+    , value(value)
+{
+    PRECONDITION(supportsUnit(kind, unit), "{} does not support the unit {}", magic_enum::enum_name(kind), magic_enum::enum_name(unit));
+}
+
+bool DateTimeLogicalFunction::supportsUnit(const DateTimeFunctionKind kind, const DateTimeUnit unit)
+{
+    switch (unit)
+    {
+        case DateTimeUnit::MILLISECOND:
+        case DateTimeUnit::SECOND:
+        case DateTimeUnit::MINUTE:
+        case DateTimeUnit::HOUR:
+        case DateTimeUnit::DAY:
+        case DateTimeUnit::MONTH:
+        case DateTimeUnit::YEAR:
+            return true;
+        case DateTimeUnit::WEEK:
+            return kind == DateTimeFunctionKind::DATE_TRUNC;
+        case DateTimeUnit::DAY_OF_WEEK:
+        case DateTimeUnit::DAY_OF_YEAR:
+            return kind == DateTimeFunctionKind::EXTRACT;
+    }
+    std::unreachable();
+}
+
+bool DateTimeLogicalFunction::operator==(const DateTimeLogicalFunction& rhs) const
+{
+    return kind == rhs.kind and unit == rhs.unit and utcOffsetInMs == rhs.utcOffsetInMs and value == rhs.value;
+}
+
+std::string DateTimeLogicalFunction::explain(ExplainVerbosity verbosity) const
+{
+    const auto offset = utcOffsetInMs == 0 ? std::string{} : fmt::format(", {}ms", utcOffsetInMs);
+    if (kind == DateTimeFunctionKind::EXTRACT)
+    {
+        return fmt::format("EXTRACT({} FROM {}{})", magic_enum::enum_name(unit), value.explain(verbosity), offset);
+    }
+    return fmt::format("DATE_TRUNC({}, {}{})", magic_enum::enum_name(unit), value.explain(verbosity), offset);
+}
+
+DateTimeFunctionKind DateTimeLogicalFunction::getKind() const
+{
+    return kind;
+}
+
+DateTimeUnit DateTimeLogicalFunction::getUnit() const
+{
+    return unit;
+}
+
+int64_t DateTimeLogicalFunction::getUtcOffsetInMs() const
+{
+    return utcOffsetInMs;
+}
+
+DataType DateTimeLogicalFunction::getDataType() const
+{
+    return dataType;
+};
+
+DateTimeLogicalFunction DateTimeLogicalFunction::withDataType(const DataType& dataType) const
+{
+    auto copy = *this;
+    copy.dataType = dataType;
+    return copy;
+};
+
+LogicalFunction DateTimeLogicalFunction::withInferredDataType(const Schema& schema) const
+{
+    const auto newValue = value.withInferredDataType(schema);
+    if (not newValue.getDataType().isType(DataType::Type::TIMESTAMP) and not newValue.getDataType().isType(DataType::Type::UINT64))
+    {
+        throw DifferentFieldTypeExpected("{} expects a TIMESTAMP or UINT64 argument, but got {}", getType(), newValue.getDataType());
+    }
+    auto newDataType = dataType;
+    newDataType.nullable = newValue.getDataType().nullable;
+    return withDataType(newDataType).withChildren({newValue});
+};
+
+std::vector<LogicalFunction> DateTimeLogicalFunction::getChildren() const
+{
+    return {value};
+};
+
+DateTimeLogicalFunction DateTimeLogicalFunction::withChildren(const std::vector<LogicalFunction>& children) const
+{
+    PRECONDITION(children.size() == 1, "{} requires exactly one child, but got {}", getType(), children.size());
+    auto copy = *this;
+    copy.value = children[0];
+    return copy;
+};
+
+std::string_view DateTimeLogicalFunction::getType() const
+{
+    switch (kind)
+    {
+        case DateTimeFunctionKind::DATE_TRUNC:
+            return "DateTrunc";
+        case DateTimeFunctionKind::EXTRACT:
+            return "Extract";
+    }
+    std::unreachable();
+}
+
+Reflected Reflector<DateTimeLogicalFunction>::operator()(const DateTimeLogicalFunction& function) const
+{
+    return reflect(
+        detail::ReflectedDateTimeLogicalFunction{.unit = function.unit, .utcOffsetInMs = function.utcOffsetInMs, .value = function.value});
+}
+
+namespace
+{
+/// As for the string predicates, the kind is encoded in the function type of the registry
+DateTimeLogicalFunction createDateTimeFunction(const DateTimeFunctionKind kind, const LogicalFunctionRegistryArguments& arguments)
+{
+    if (arguments.reflected.isEmpty())
+    {
+        throw CannotDeserialize("DateTimeLogicalFunction requires a unit, which is only part of the reflected function");
+    }
+    auto [unit, utcOffsetInMs, value] = unreflect<detail::ReflectedDateTimeLogicalFunction>(arguments.reflected);
+    if (not value.has_value())
+    {
+        throw CannotDeserialize("DateTimeLogicalFunction is missing its child");
+    }
+    if (not DateTimeLogicalFunction::supportsUnit(kind, unit))
+    {
+        throw CannotDeserialize("{} does not support the unit {}", magic_enum::enum_name(kind), magic_enum::enum_name(unit));
+    }
+    return DateTimeLogicalFunction{kind, unit, utcOffsetInMs, value.value()};
+}
+}
+
+LogicalFunctionRegistryReturnType
+LogicalFunctionGeneratedRegistrar::RegisterDateTruncLogicalFunction(LogicalFunctionRegistryArguments arguments)
+{
+    return createDateTimeFunction(DateTimeFunctionKind::DATE_TRUNC, arguments);
+}
+
+LogicalFunctionRegistryReturnType
+LogicalFunctionGeneratedRegistrar::RegisterExtractLogicalFunction(LogicalFunctionRegistryArguments arguments)
+{
+    return createDateTimeFunction(DateTimeFunctionKind::EXTRACT, arguments);
+}
+
+}
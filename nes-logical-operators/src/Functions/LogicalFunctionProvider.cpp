@@ -14,11 +14,16 @@
 
 #include <Functions/LogicalFunctionProvider.hpp>
 
+#include <memory>
 #include <optional>
 #include <string>
 #include <utility>
 #include <vector>
+#include <Functions/FieldAccessLogicalFunction.hpp>
 #include <Functions/LogicalFunction.hpp>
+#include <Operators/Windows/Aggregations/WindowAggregationLogicalFunction.hpp>
+#include <Util/Reflection.hpp>
+#include <AggregationLogicalFunctionRegistry.hpp>
 #include <ErrorHandling.hpp>
 #include <LogicalFunctionRegistry.hpp>
 
@@ -38,4 +43,20 @@ std::optional<LogicalFunction> tryProvide(const std::string& functionName, std::
     return LogicalFunctionRegistry::instance().create(
         functionName, LogicalFunctionRegistryArguments{.children = std::move(arguments), .reflected = Reflected{}});
 }
+
+bool isRegisteredAggregation(const std::string& functionName)
+{
+    return AggregationLogicalFunctionRegistry::instance().contains(functionName);
+}
+
+std::shared_ptr<WindowAggregationLogicalFunction>
+provideAggregation(const std::string& functionName, const FieldAccessLogicalFunction& onField)
+{
+    if (auto aggregation = AggregationLogicalFunctionRegistry::instance().create(
+            functionName, AggregationLogicalFunctionRegistryArguments{.fields = {onField, onField}, .reflected = Reflected{}}))
+    {
+        return *aggregation;
+    }
+    throw FunctionNotImplemented("{} is not a registered aggregation", functionName);
+}
 }
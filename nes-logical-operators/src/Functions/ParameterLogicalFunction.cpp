@@ -0,0 +1,106 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Functions/ParameterLogicalFunction.hpp>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Util/PlanRenderer.hpp>
+#include <Util/Reflection.hpp>
+#include <fmt/format.h>
+#include <SerializableVariantDescriptor.pb.h>
+
+namespace NES
+{
+
+ParameterLogicalFunction::ParameterLogicalFunction(const uint64_t index, DataType dataType, std::string value)
+    : index(index), dataType(std::move(dataType)), value(std::move(value))
+{
+}
+
+uint64_t ParameterLogicalFunction::getIndex() const
+{
+    return index;
+}
+
+std::string ParameterLogicalFunction::getValue() const
+{
+    return value;
+}
+
+std::string ParameterLogicalFunction::getFieldName() const
+{
+    return fmt::format("$parameter{}", index);
+}
+
+bool ParameterLogicalFunction::operator==(const ParameterLogicalFunction& rhs) const
+{
+    return index == rhs.index and dataType == rhs.dataType;
+}
+
+DataType ParameterLogicalFunction::getDataType() const
+{
+    return dataType;
+}
+
+ParameterLogicalFunction ParameterLogicalFunction::withDataType(const DataType& dataType) const
+{
+    auto copy = *this;
+    copy.dataType = dataType;
+    return copy;
+}
+
+LogicalFunction ParameterLogicalFunction::withInferredDataType(const Schema&) const
+{
+    /// The parameter keeps the data type of the constant that it replaces
+    return *this;
+}
+
+std::vector<LogicalFunction> ParameterLogicalFunction::getChildren() const
+{
+    return {};
+}
+
+ParameterLogicalFunction ParameterLogicalFunction::withChildren(const std::vector<LogicalFunction>&) const
+{
+    return *this;
+}
+
+std::string_view ParameterLogicalFunction::getType() const
+{
+    return NAME;
+}
+
+std::string ParameterLogicalFunction::explain(const ExplainVerbosity verbosity) const
+{
+    if (verbosity == ExplainVerbosity::Debug)
+    {
+        return fmt::format("ParameterLogicalFunction(${} = {} : {})", index, value, dataType);
+    }
+    return fmt::format("${}", index);
+}
+
+Reflected Reflector<ParameterLogicalFunction>::operator()(const ParameterLogicalFunction& function) const
+{
+    return reflect(detail::ReflectedParameterLogicalFunction{
+        .index = function.getIndex(), .dataType = function.getDataType(), .value = function.getValue()});
+}
+
+}
@@ -0,0 +1,177 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Functions/StringMatchLogicalFunction.hpp>
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/DataTypeProvider.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Serialization/LogicalFunctionReflection.hpp>
+#include <Util/PlanRenderer.hpp>
+#include <Util/Reflection.hpp>
+#include <fmt/format.h>
+#include <ErrorHandling.hpp>
+#include <LogicalFunctionRegistry.hpp>
+
+namespace NES
+{
+
+StringMatchLogicalFunction::StringMatchLogicalFunction(
+    const StringMatchKind kind, const LogicalFunction& value, const LogicalFunction& pattern)
+    : kind(kind)
+    , dataType(DataTypeProvider::provideDataType(DataType::Type::BOOLEAN, DataType::NULLABLE::NOT_NULLABLE))
+    , value(value)
+    , pattern(pattern)
+{
+}
+
+bool StringMatchLogicalFunction::operator==(const StringMatchLogicalFunction& rhs) const
+{
+    return kind == rhs.kind and value == rhs.value and pattern == rhs.pattern;
+}
+
+std::string StringMatchLogicalFunction::explain(ExplainVerbosity verbosity) const
+{
+    if (kind == StringMatchKind::LIKE)
+    {
+        return fmt::format("{} LIKE {}", value.explain(verbosity), pattern.explain(verbosity));
+    }
+    return fmt::format("{}({}, {})", getType(), value.explain(verbosity), pattern.explain(verbosity));
+}
+
+StringMatchKind StringMatchLogicalFunction::getKind() const
+{
+    return kind;
+}
+
+DataType StringMatchLogicalFunction::getDataType() const
+{
+    return dataType;
+};
+
+StringMatchLogicalFunction StringMatchLogicalFunction::withDataType(const DataType& dataType) const
+{
+    auto copy = *this;
+    copy.dataType = dataType;
+    return copy;
+};
+
+LogicalFunction StringMatchLogicalFunction::withInferredDataType(const Schema& schema) const
+{
+    const auto newValue = value.withInferredDataType(schema);
+    const auto newPattern = pattern.withInferredDataType(schema);
+    if (not newValue.getDataType().isType(DataType::Type::VARSIZED) or not newPattern.getDataType().isType(DataType::Type::VARSIZED))
+    {
+        throw DifferentFieldTypeExpected(
+            "{} expects VARSIZED arguments, but got {} and {}", getType(), newValue.getDataType(), newPattern.getDataType());
+    }
+    auto newDataType = DataTypeProvider::provideDataType(DataType::Type::BOOLEAN, DataType::NULLABLE::NOT_NULLABLE);
+    newDataType.nullable = newValue.getDataType().nullable or newPattern.getDataType().nullable;
+    return withDataType(newDataType).withChildren({newValue, newPattern});
+};
+
+std::vector<LogicalFunction> StringMatchLogicalFunction::getChildren() const
+{
+    return {value, pattern};
+};
+
+StringMatchLogicalFunction StringMatchLogicalFunction::withChildren(const std::vector<LogicalFunction>& children) const
+{
+    PRECONDITION(children.size() == 2, "{} requires exactly two children, but got {}", getType(), children.size());
+    auto copy = *this;
+    copy.value = children[0];
+    copy.pattern = children[1];
+    return copy;
+};
+
+std::string_view StringMatchLogicalFunction::getType() const
+{
+    switch (kind)
+    {
+        case StringMatchKind::LIKE:
+            return "Like";
+        case StringMatchKind::STARTS_WITH:
+            return "StartsWith";
+        case StringMatchKind::ENDS_WITH:
+            return "EndsWith";
+        case StringMatchKind::CONTAINS:
+            return "Contains";
+        case StringMatchKind::REGEXP_MATCH:
+            return "RegexpMatch";
+    }
+    std::unreachable();
+}
+
+Reflected Reflector<StringMatchLogicalFunction>::operator()(const StringMatchLogicalFunction& function) const
+{
+    return reflect(detail::ReflectedStringMatchLogicalFunction{.value = function.value, .pattern = function.pattern});
+}
+
+namespace
+{
+/// The kind is not part of the reflected function, as it is encoded in the function type of the registry
+StringMatchLogicalFunction createStringMatchFunction(const StringMatchKind kind, const LogicalFunctionRegistryArguments& arguments)
+{
+    if (!arguments.reflected.isEmpty())
+    {
+        auto [value, pattern] = unreflect<detail::ReflectedStringMatchLogicalFunction>(arguments.reflected);
+        if (!value.has_value() || !pattern.has_value())
+        {
+            throw CannotDeserialize("StringMatchLogicalFunction is missing a child");
+        }
+        return StringMatchLogicalFunction{kind, value.value(), pattern.value()};
+    }
+    if (arguments.children.size() != 2)
+    {
+        throw CannotDeserialize("StringMatchLogicalFunction requires exactly two children, but got {}", arguments.children.size());
+    }
+    return StringMatchLogicalFunction{kind, arguments.children[0], arguments.children[1]};
+}
+}
+
+LogicalFunctionRegistryReturnType LogicalFunctionGeneratedRegistrar::RegisterLikeLogicalFunction(LogicalFunctionRegistryArguments arguments)
+{
+    return createStringMatchFunction(StringMatchKind::LIKE, arguments);
+}
+
+LogicalFunctionRegistryReturnType
+LogicalFunctionGeneratedRegistrar::RegisterStartsWithLogicalFunction(LogicalFunctionRegistryArguments arguments)
+{
+    return createStringMatchFunction(StringMatchKind::STARTS_WITH, arguments);
+}
+
+LogicalFunctionRegistryReturnType
+LogicalFunctionGeneratedRegistrar::RegisterEndsWithLogicalFunction(LogicalFunctionRegistryArguments arguments)
+{
+    return createStringMatchFunction(StringMatchKind::ENDS_WITH, arguments);
+}
+
+LogicalFunctionRegistryReturnType
+LogicalFunctionGeneratedRegistrar::RegisterContainsLogicalFunction(LogicalFunctionRegistryArguments arguments)
+{
+    return createStringMatchFunction(StringMatchKind::CONTAINS, arguments);
+}
+
+LogicalFunctionRegistryReturnType
+LogicalFunctionGeneratedRegistrar::RegisterRegexpMatchLogicalFunction(LogicalFunctionRegistryArguments arguments)
+{
+    return createStringMatchFunction(StringMatchKind::REGEXP_MATCH, arguments);
+}
+
+}
@@ -0,0 +1,145 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Functions/UdfLogicalFunction.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/CastToTypeLogicalFunction.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Serialization/LogicalFunctionReflection.hpp>
+#include <Util/PlanRenderer.hpp>
+#include <Util/Reflection.hpp>
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <ErrorHandling.hpp>
+#include <SerializableVariantDescriptor.pb.h>
+
+namespace NES
+{
+
+UdfLogicalFunction::UdfLogicalFunction(
+    std::string name, std::vector<DataType> argumentTypes, DataType resultType, std::vector<LogicalFunction> children)
+    : name(std::move(name))
+    , argumentTypes(std::move(argumentTypes))
+    , resultType(resultType)
+    , dataType(std::move(resultType))
+    , children(std::move(children))
+{
+}
+
+LogicalFunction UdfLogicalFunction::create(
+    const std::string_view name,
+    std::vector<DataType> argumentTypes,
+    DataType resultType,
+    const std::vector<LogicalFunction>& children,
+    const Reflected& reflected)
+{
+    auto udfChildren = children;
+    if (!reflected.isEmpty())
+    {
+        udfChildren = unreflect<detail::ReflectedUdfLogicalFunction>(reflected).children;
+    }
+    if (udfChildren.size() != argumentTypes.size())
+    {
+        throw CannotDeserialize("{} requires {} arguments, but got {}", name, argumentTypes.size(), udfChildren.size());
+    }
+    return UdfLogicalFunction{std::string(name), std::move(argumentTypes), std::move(resultType), std::move(udfChildren)};
+}
+
+bool UdfLogicalFunction::operator==(const UdfLogicalFunction& rhs) const
+{
+    return name == rhs.name and children == rhs.children;
+}
+
+std::string UdfLogicalFunction::explain(ExplainVerbosity verbosity) const
+{
+    return fmt::format(
+        "{}({})",
+        name,
+        fmt::join(children | std::views::transform([verbosity](const auto& child) { return child.explain(verbosity); }), ", "));
+}
+
+DataType UdfLogicalFunction::getDataType() const
+{
+    return dataType;
+};
+
+UdfLogicalFunction UdfLogicalFunction::withDataType(const DataType& dataType) const
+{
+    auto copy = *this;
+    copy.dataType = dataType;
+    return copy;
+};
+
+LogicalFunction UdfLogicalFunction::withInferredDataType(const Schema& schema) const
+{
+    std::vector<LogicalFunction> newChildren;
+    newChildren.reserve(children.size());
+    for (size_t argument = 0; argument < children.size(); ++argument)
+    {
+        const auto child = children[argument].withInferredDataType(schema);
+        auto argumentType = argumentTypes[argument];
+        argumentType.nullable = child.getDataType().nullable;
+        const auto joinedType = child.getDataType().join(argumentType);
+        if (not joinedType.has_value() or not joinedType->isType(argumentType.type)
+            or (argumentType.isDecimal() and child.getDataType().scale != argumentType.scale))
+        {
+            throw DifferentFieldTypeExpected("Argument {} of {} must be {}, but got {}", argument, name, argumentType, child.getDataType());
+        }
+        if (child.getDataType() == argumentType)
+        {
+            newChildren.emplace_back(child);
+        }
+        else
+        {
+            newChildren.emplace_back(CastToTypeLogicalFunction(argumentType, child));
+        }
+    }
+    auto newDataType = resultType;
+    newDataType.nullable
+        = resultType.nullable or std::ranges::any_of(newChildren, [](const auto& child) { return child.getDataType().nullable; });
+    return withDataType(newDataType).withChildren(newChildren);
+};
+
+std::vector<LogicalFunction> UdfLogicalFunction::getChildren() const
+{
+    return children;
+};
+
+UdfLogicalFunction UdfLogicalFunction::withChildren(const std::vector<LogicalFunction>& children) const
+{
+    auto copy = *this;
+    copy.children = children;
+    return copy;
+};
+
+std::string_view UdfLogicalFunction::getType() const
+{
+    return name;
+}
+
+Reflected Reflector<UdfLogicalFunction>::operator()(const UdfLogicalFunction& function) const
+{
+    return reflect(detail::ReflectedUdfLogicalFunction{.children = function.children});
+}
+
+}
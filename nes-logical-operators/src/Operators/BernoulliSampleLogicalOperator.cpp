@@ -0,0 +1,144 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Operators/BernoulliSampleLogicalOperator.hpp>
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <Identifiers/Identifiers.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Traits/Trait.hpp>
+#include <Util/PlanRenderer.hpp>
+#include <Util/Reflection.hpp>
+#include <ErrorHandling.hpp>
+#include <LogicalOperatorRegistry.hpp>
+
+namespace NES
+{
+
+BernoulliSampleLogicalOperator::BernoulliSampleLogicalOperator(const double fraction) : fraction(fraction)
+{
+}
+
+std::string_view BernoulliSampleLogicalOperator::getName() const noexcept
+{
+    return NAME;
+}
+
+double BernoulliSampleLogicalOperator::getFraction() const
+{
+    return fraction;
+}
+
+bool BernoulliSampleLogicalOperator::operator==(const BernoulliSampleLogicalOperator& rhs) const
+{
+    return fraction == rhs.fraction && getOutputSchema() == rhs.getOutputSchema() && getInputSchemas() == rhs.getInputSchemas()
+        && getTraitSet() == rhs.getTraitSet();
+}
+
+std::string BernoulliSampleLogicalOperator::explain(ExplainVerbosity verbosity, OperatorId opId) const
+{
+    if (verbosity == ExplainVerbosity::Debug)
+    {
+        return fmt::format("BERNOULLI_SAMPLE(opId: {}, fraction: {}, traitSet: {})", opId, fraction, traitSet.explain(verbosity));
+    }
+    return fmt::format("BERNOULLI_SAMPLE({})", fraction);
+}
+
+BernoulliSampleLogicalOperator BernoulliSampleLogicalOperator::withInferredSchema(std::vector<Schema> inputSchemas) const
+{
+    auto copy = *this;
+    if (inputSchemas.empty())
+    {
+        throw CannotInferSchema("BernoulliSample should have at least one input");
+    }
+
+    const auto& firstSchema = inputSchemas.at(0);
+    for (const auto& schema : inputSchemas)
+    {
+        if (schema != firstSchema)
+        {
+            throw CannotInferSchema("All input schemas must be equal for BernoulliSample operator");
+        }
+    }
+    if (not(fraction > 0.0 and fraction <= 1.0))
+    {
+        throw CannotInferSchema("The fraction of a Bernoulli sample must be in (0, 1], but got {}", fraction);
+    }
+    copy.inputSchema = firstSchema;
+    copy.outputSchema = firstSchema;
+    return copy;
+}
+
+TraitSet BernoulliSampleLogicalOperator::getTraitSet() const
+{
+    return traitSet;
+}
+
+BernoulliSampleLogicalOperator BernoulliSampleLogicalOperator::withTraitSet(TraitSet traitSet) const
+{
+    auto copy = *this;
+    copy.traitSet = std::move(traitSet);
+    return copy;
+}
+
+BernoulliSampleLogicalOperator BernoulliSampleLogicalOperator::withChildren(std::vector<LogicalOperator> children) const
+{
+    auto copy = *this;
+    copy.children = std::move(children);
+    return copy;
+}
+
+std::vector<Schema> BernoulliSampleLogicalOperator::getInputSchemas() const
+{
+    return {inputSchema};
+};
+
+Schema BernoulliSampleLogicalOperator::getOutputSchema() const
+{
+    return outputSchema;
+}
+
+std::vector<LogicalOperator> BernoulliSampleLogicalOperator::getChildren() const
+{
+    return children;
+}
+
+Reflected Reflector<BernoulliSampleLogicalOperator>::operator()(const BernoulliSampleLogicalOperator& op) const
+{
+    return reflect(detail::ReflectedBernoulliSampleLogicalOperator{op.getFraction()});
+}
+
+BernoulliSampleLogicalOperator Unreflector<BernoulliSampleLogicalOperator>::operator()(const Reflected& rfl) const
+{
+    auto [fraction] = unreflect<detail::ReflectedBernoulliSampleLogicalOperator>(rfl);
+    return BernoulliSampleLogicalOperator(fraction);
+}
+
+LogicalOperatorRegistryReturnType
+LogicalOperatorGeneratedRegistrar::RegisterBernoulliSampleLogicalOperator(LogicalOperatorRegistryArguments arguments)
+{
+    if (!arguments.reflected.isEmpty())
+    {
+        return unreflect<BernoulliSampleLogicalOperator>(arguments.reflected);
+    }
+    PRECONDITION(false, "Operator is only build directly via parser or via reflection, not using the registry");
+    std::unreachable();
+}
+}
@@ -43,9 +43,16 @@ namespace NES
 {
 
 EventTimeWatermarkAssignerLogicalOperator::EventTimeWatermarkAssignerLogicalOperator(
-    LogicalFunction onField, const Windowing::TimeUnit& unit)
-    : onField(std::move(onField)), unit(unit)
+    LogicalFunction onField,
+    const Windowing::TimeUnit& unit,
+    const uint64_t outOfOrdernessBoundInMs,
+    const bool adaptiveOutOfOrderness)
+    : onField(std::move(onField))
+    , unit(unit)
+    , outOfOrdernessBoundInMs(outOfOrdernessBoundInMs)
+    , adaptiveOutOfOrderness(adaptiveOutOfOrderness)
 {
+    PRECONDITION(not adaptiveOutOfOrderness or outOfOrdernessBoundInMs > 0, "An adaptive out-of-orderness bound requires a maximum bound");
 }
 
 std::string_view EventTimeWatermarkAssignerLogicalOperator::getName() const noexcept
@@ -58,10 +65,13 @@ std::string EventTimeWatermarkAssignerLogicalOperator::explain(ExplainVerbosity
     if (verbosity == ExplainVerbosity::Debug)
     {
         return fmt::format(
-            "EVENT_TIME_WATERMARK_ASSIGNER(opId: {}, onField: {}, unit: {}, inputSchema: {}, traitSet: {})",
+            "EVENT_TIME_WATERMARK_ASSIGNER(opId: {}, onField: {}, unit: {}, outOfOrdernessBoundInMs: {}, adaptive: {}, inputSchema: {}, "
+            "traitSet: {})",
             id,
             onField.explain(verbosity),
             unit.getMillisecondsConversionMultiplier(),
+            outOfOrdernessBoundInMs,
+            adaptiveOutOfOrderness,
             inputSchema,
             traitSet.explain(verbosity));
     }
@@ -70,7 +80,8 @@ std::string EventTimeWatermarkAssignerLogicalOperator::explain(ExplainVerbosity
 
 bool EventTimeWatermarkAssignerLogicalOperator::operator==(const EventTimeWatermarkAssignerLogicalOperator& rhs) const
 {
-    return onField == rhs.onField && unit == rhs.unit && getOutputSchema() == rhs.getOutputSchema()
+    return onField == rhs.onField && unit == rhs.unit && outOfOrdernessBoundInMs == rhs.outOfOrdernessBoundInMs
+        && adaptiveOutOfOrderness == rhs.adaptiveOutOfOrderness && getOutputSchema() == rhs.getOutputSchema()
         && getInputSchemas() == rhs.getInputSchemas() && getTraitSet() == rhs.getTraitSet();
 }
 
@@ -126,20 +137,25 @@ std::vector<LogicalOperator> EventTimeWatermarkAssignerLogicalOperator::getChild
 
 Reflected Reflector<EventTimeWatermarkAssignerLogicalOperator>::operator()(const EventTimeWatermarkAssignerLogicalOperator& op) const
 {
-    return reflect(detail::ReflectedEventTimeWatermarkAssignerLogicalOperator{.onField = op.onField, .timeUnit = op.unit});
+    return reflect(detail::ReflectedEventTimeWatermarkAssignerLogicalOperator{
+        .onField = op.onField,
+        .timeUnit = op.unit,
+        .outOfOrdernessBoundInMs = op.outOfOrdernessBoundInMs,
+        .adaptiveOutOfOrderness = op.adaptiveOutOfOrderness});
 }
 
 EventTimeWatermarkAssignerLogicalOperator
 Unreflector<EventTimeWatermarkAssignerLogicalOperator>::operator()(const Reflected& reflected) const
 {
-    auto [onField, timeUnit] = unreflect<detail::ReflectedEventTimeWatermarkAssignerLogicalOperator>(reflected);
+    auto [onField, timeUnit, outOfOrdernessBoundInMs, adaptiveOutOfOrderness]
+        = unreflect<detail::ReflectedEventTimeWatermarkAssignerLogicalOperator>(reflected);
 
     if (!onField.has_value())
     {
         throw CannotDeserialize("EventTimeWatermarkAssignerLogicalOperator is missing onField function");
     }
 
-    return EventTimeWatermarkAssignerLogicalOperator{onField.value(), timeUnit};
+    return EventTimeWatermarkAssignerLogicalOperator{onField.value(), timeUnit, outOfOrdernessBoundInMs, adaptiveOutOfOrderness};
 }
 
 LogicalOperatorRegistryReturnType
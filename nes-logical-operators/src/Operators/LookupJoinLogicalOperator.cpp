@@ -0,0 +1,164 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Operators/LookupJoinLogicalOperator.hpp>
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <DataTypes/Schema.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Serialization/LogicalFunctionReflection.hpp>
+#include <Traits/Trait.hpp>
+#include <Traits/TraitSet.hpp>
+#include <Util/PlanRenderer.hpp>
+#include <Util/Reflection.hpp>
+#include <ErrorHandling.hpp>
+#include <LogicalOperatorRegistry.hpp>
+
+namespace NES
+{
+
+LookupJoinLogicalOperator::LookupJoinLogicalOperator(LogicalFunction joinFunction) : joinFunction(std::move(joinFunction))
+{
+}
+
+std::string_view LookupJoinLogicalOperator::getName() const noexcept
+{
+    return NAME;
+}
+
+bool LookupJoinLogicalOperator::operator==(const LookupJoinLogicalOperator& rhs) const
+{
+    return getJoinFunction() == rhs.getJoinFunction() and getOutputSchema() == rhs.getOutputSchema()
+        and getRightSchema() == rhs.getRightSchema() and getLeftSchema() == rhs.getLeftSchema() and getTraitSet() == rhs.getTraitSet();
+}
+
+std::string LookupJoinLogicalOperator::explain(ExplainVerbosity verbosity, OperatorId id) const
+{
+    if (verbosity == ExplainVerbosity::Debug)
+    {
+        return fmt::format(
+            "LookupJoin(opId: {}, joinFunction: {}, traitSet: {})", id, getJoinFunction().explain(verbosity), traitSet.explain(verbosity));
+    }
+    return fmt::format("LookupJoin({})", getJoinFunction().explain(verbosity));
+}
+
+LookupJoinLogicalOperator LookupJoinLogicalOperator::withInferredSchema(std::vector<Schema> inputSchemas) const
+{
+    PRECONDITION(inputSchemas.size() == 2, "Lookup join expects a stream and a table, but got {} inputs", inputSchemas.size());
+    auto copy = *this;
+    copy.leftInputSchema = inputSchemas[0];
+    copy.rightInputSchema = inputSchemas[1];
+
+    /// The output contains the fields of the stream followed by the fields of the matching record of the table
+    copy.outputSchema = Schema{};
+    for (const auto& field : copy.leftInputSchema.getFields())
+    {
+        copy.outputSchema.addField(field.name, field.dataType);
+    }
+    for (const auto& field : copy.rightInputSchema.getFields())
+    {
+        copy.outputSchema.addField(field.name, field.dataType);
+    }
+
+    auto inputSchema = copy.leftInputSchema;
+    inputSchema.appendFieldsFromOtherSchema(copy.rightInputSchema);
+    copy.joinFunction = joinFunction.withInferredDataType(inputSchema);
+    return copy;
+}
+
+LookupJoinLogicalOperator LookupJoinLogicalOperator::withTraitSet(TraitSet traitSet) const
+{
+    auto copy = *this;
+    copy.traitSet = std::move(traitSet);
+    return copy;
+}
+
+TraitSet LookupJoinLogicalOperator::getTraitSet() const
+{
+    return traitSet;
+}
+
+LookupJoinLogicalOperator LookupJoinLogicalOperator::withChildren(std::vector<LogicalOperator> children) const
+{
+    auto copy = *this;
+    copy.children = std::move(children);
+    return copy;
+}
+
+std::vector<LogicalOperator> LookupJoinLogicalOperator::getChildren() const
+{
+    return children;
+}
+
+std::vector<Schema> LookupJoinLogicalOperator::getInputSchemas() const
+{
+    return {leftInputSchema, rightInputSchema};
+}
+
+Schema LookupJoinLogicalOperator::getOutputSchema() const
+{
+    return outputSchema;
+}
+
+Schema LookupJoinLogicalOperator::getLeftSchema() const
+{
+    return leftInputSchema;
+}
+
+Schema LookupJoinLogicalOperator::getRightSchema() const
+{
+    return rightInputSchema;
+}
+
+LogicalFunction LookupJoinLogicalOperator::getJoinFunction() const
+{
+    return joinFunction;
+}
+
+Reflected Reflector<LookupJoinLogicalOperator>::operator()(const LookupJoinLogicalOperator& op) const
+{
+    return reflect(detail::ReflectedLookupJoinLogicalOperator{.joinFunction = op.getJoinFunction()});
+}
+
+LookupJoinLogicalOperator Unreflector<LookupJoinLogicalOperator>::operator()(const Reflected& reflected) const
+{
+    auto [joinFunction] = unreflect<detail::ReflectedLookupJoinLogicalOperator>(reflected);
+    if (not joinFunction.has_value())
+    {
+        throw CannotDeserialize("Missing Join Function");
+    }
+    return LookupJoinLogicalOperator(joinFunction.value());
+}
+
+LogicalOperatorRegistryReturnType
+LogicalOperatorGeneratedRegistrar::RegisterLookupJoinLogicalOperator(LogicalOperatorRegistryArguments arguments)
+{
+    if (!arguments.reflected.isEmpty())
+    {
+        return unreflect<LookupJoinLogicalOperator>(arguments.reflected);
+    }
+
+    PRECONDITION(false, "Operator is only build directly via parser or via reflection, not using the registry");
+    std::unreachable();
+}
+
+}
@@ -95,6 +95,11 @@ const std::vector<ProjectionLogicalOperator::Projection>& ProjectionLogicalOpera
     return projections;
 }
 
+bool ProjectionLogicalOperator::hasAsterisk() const
+{
+    return asterisk;
+}
+
 bool ProjectionLogicalOperator::operator==(const ProjectionLogicalOperator& rhs) const
 {
     return projections == rhs.projections && getOutputSchema() == rhs.getOutputSchema() && getInputSchemas() == rhs.getInputSchemas()
@@ -0,0 +1,210 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Operators/Windows/Aggregations/ApproxCountDistinctAggregationLogicalFunction.hpp>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/DataTypeProvider.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/FieldAccessLogicalFunction.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Operators/Windows/Aggregations/WindowAggregationLogicalFunction.hpp>
+#include <Util/Reflection.hpp>
+#include <fmt/format.h>
+#include <AggregationLogicalFunctionRegistry.hpp>
+#include <ErrorHandling.hpp>
+#include <SerializableVariantDescriptor.pb.h>
+
+namespace NES
+{
+ApproxCountDistinctAggregationLogicalFunction::ApproxCountDistinctAggregationLogicalFunction(const FieldAccessLogicalFunction& field)
+    : onField(field), asField(field)
+{
+}
+
+ApproxCountDistinctAggregationLogicalFunction::ApproxCountDistinctAggregationLogicalFunction(
+    FieldAccessLogicalFunction field, FieldAccessLogicalFunction asField)
+    : onField(std::move(field)), asField(std::move(asField))
+{
+}
+
+bool ApproxCountDistinctAggregationLogicalFunction::shallIncludeNullValues() noexcept
+{
+    /// As COUNT(DISTINCT field), we do not count null values
+    return false;
+}
+
+std::string_view ApproxCountDistinctAggregationLogicalFunction::getName() const noexcept
+{
+    return NAME;
+}
+
+Reflected ApproxCountDistinctAggregationLogicalFunction::reflect() const
+{
+    return NES::reflect(this);
+}
+
+ApproxCountDistinctAggregationLogicalFunction ApproxCountDistinctAggregationLogicalFunction::withInferredStamp(const Schema& schema) const
+{
+    if (const auto sourceNameQualifier = schema.getSourceNameQualifier())
+    {
+        /// We infer the data type from the schema for the on field
+        auto newOnField = this->getOnField().withInferredDataType(schema).getAs<FieldAccessLogicalFunction>().get();
+        const auto attributeNameResolver = sourceNameQualifier.value() + std::string(Schema::ATTRIBUTE_NAME_SEPARATOR);
+        const auto asFieldName = this->getAsField().getFieldName();
+
+        std::string newAsFieldName;
+        ///If on and as field name are different then append the attribute name resolver from on field to the as field
+        if (asFieldName.find(Schema::ATTRIBUTE_NAME_SEPARATOR) == std::string::npos)
+        {
+            newAsFieldName = attributeNameResolver + asFieldName;
+        }
+        else
+        {
+            const auto fieldName = asFieldName.substr(asFieldName.find_last_of(Schema::ATTRIBUTE_NAME_SEPARATOR) + 1);
+            newAsFieldName = attributeNameResolver + fieldName;
+        }
+
+        /// In contrast to a count, we hash the values of the on field and thus, keep its data type.
+        /// As a count, the estimated number of distinct values is an uint 64 and never a NULL value.
+        auto newFinalAggregateStamp = DataTypeProvider::provideDataType(DataType::Type::UINT64, DataType::NULLABLE::NOT_NULLABLE);
+        auto newAsField = this->getAsField().withFieldName(newAsFieldName);
+
+        return this->withInputStamp(newOnField.getDataType())
+            .withOnField(newOnField)
+            .withFinalAggregateStamp(newFinalAggregateStamp)
+            .withAsField(newAsField.withDataType(newFinalAggregateStamp));
+    }
+    throw CannotInferSchema("Schema lacked source name qualifier: {}", schema);
+}
+
+Reflected Reflector<ApproxCountDistinctAggregationLogicalFunction>::operator()(
+    const ApproxCountDistinctAggregationLogicalFunction& function) const
+{
+    return reflect(
+        detail::ReflectedApproxCountDistinctAggregationLogicalFunction{.onField = function.getOnField(), .asField = function.getAsField()});
+}
+
+ApproxCountDistinctAggregationLogicalFunction
+Unreflector<ApproxCountDistinctAggregationLogicalFunction>::operator()(const Reflected& reflected) const
+{
+    auto [onField, asField] = unreflect<detail::ReflectedApproxCountDistinctAggregationLogicalFunction>(reflected);
+
+    if (!onField.has_value() || !asField.has_value())
+    {
+        throw CannotDeserialize("ApproxCountDistinctAggregationLogicalFunction is missing onField/asField function");
+    }
+
+    return {onField.value(), asField.value()};
+}
+
+AggregationLogicalFunctionRegistryReturnType
+AggregationLogicalFunctionGeneratedRegistrar::RegisterApproxCountDistinctAggregationLogicalFunction(
+    AggregationLogicalFunctionRegistryArguments arguments)
+{
+    if (!arguments.reflected.isEmpty())
+    {
+        return std::make_shared<WindowAggregationLogicalFunction>(
+            unreflect<ApproxCountDistinctAggregationLogicalFunction>(arguments.reflected));
+    }
+
+    if (arguments.fields.size() != 2)
+    {
+        throw CannotDeserialize(
+            "ApproxCountDistinctAggregationLogicalFunction requires exactly two fields, but got {}", arguments.fields.size());
+    }
+    return std::make_shared<WindowAggregationLogicalFunction>(
+        ApproxCountDistinctAggregationLogicalFunction(arguments.fields[0], arguments.fields[1]));
+}
+
+std::string ApproxCountDistinctAggregationLogicalFunction::toString() const
+{
+    return fmt::format("WindowAggregation: onField={} asField={}", onField, asField);
+}
+
+DataType ApproxCountDistinctAggregationLogicalFunction::getInputStamp() const
+{
+    return inputStamp;
+}
+
+DataType ApproxCountDistinctAggregationLogicalFunction::getPartialAggregateStamp() const
+{
+    return partialAggregateStamp;
+}
+
+DataType ApproxCountDistinctAggregationLogicalFunction::getFinalAggregateStamp() const
+{
+    return finalAggregateStamp;
+}
+
+FieldAccessLogicalFunction ApproxCountDistinctAggregationLogicalFunction::getOnField() const
+{
+    return onField;
+}
+
+FieldAccessLogicalFunction ApproxCountDistinctAggregationLogicalFunction::getAsField() const
+{
+    return asField;
+}
+
+ApproxCountDistinctAggregationLogicalFunction ApproxCountDistinctAggregationLogicalFunction::withInputStamp(DataType inputStamp) const
+{
+    auto copy = *this;
+    copy.inputStamp = std::move(inputStamp);
+    return copy;
+}
+
+ApproxCountDistinctAggregationLogicalFunction
+ApproxCountDistinctAggregationLogicalFunction::withPartialAggregateStamp(DataType partialAggregateStamp) const
+{
+    auto copy = *this;
+    copy.partialAggregateStamp = std::move(partialAggregateStamp);
+    return copy;
+}
+
+ApproxCountDistinctAggregationLogicalFunction
+ApproxCountDistinctAggregationLogicalFunction::withFinalAggregateStamp(DataType finalAggregateStamp) const
+{
+    auto copy = *this;
+    copy.finalAggregateStamp = std::move(finalAggregateStamp);
+    return copy;
+}
+
+ApproxCountDistinctAggregationLogicalFunction
+ApproxCountDistinctAggregationLogicalFunction::withOnField(FieldAccessLogicalFunction onField) const
+{
+    auto copy = *this;
+    copy.onField = std::move(onField);
+    return copy;
+}
+
+ApproxCountDistinctAggregationLogicalFunction
+ApproxCountDistinctAggregationLogicalFunction::withAsField(FieldAccessLogicalFunction asField) const
+{
+    auto copy = *this;
+    copy.asField = std::move(asField);
+    return copy;
+}
+
+bool ApproxCountDistinctAggregationLogicalFunction::operator==(const ApproxCountDistinctAggregationLogicalFunction& other) const
+{
+    return this->getName() == other.getName()
+        && this->onField.getFieldName() == other.onField.getFieldName()
+        && this->asField.getFieldName() == other.asField.getFieldName();
+}
+}
@@ -0,0 +1,244 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Operators/Windows/Aggregations/ApproximateQuantileAggregationLogicalFunction.hpp>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/DataTypeProvider.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/FieldAccessLogicalFunction.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Operators/Windows/Aggregations/WindowAggregationLogicalFunction.hpp>
+#include <Util/Reflection.hpp>
+#include <fmt/format.h>
+#include <magic_enum/magic_enum.hpp>
+#include <AggregationLogicalFunctionRegistry.hpp>
+#include <ErrorHandling.hpp>
+#include <SerializableVariantDescriptor.pb.h>
+
+namespace NES
+{
+ApproximateQuantileAggregationLogicalFunction::ApproximateQuantileAggregationLogicalFunction(
+    const Sketch sketch, const FieldAccessLogicalFunction& onField, FieldAccessLogicalFunction asField, const double quantile)
+    : sketch(sketch), quantile(quantile), onField(onField), asField(std::move(asField))
+{
+    PRECONDITION(quantile >= 0 and quantile <= 1, "The quantile must be in [0, 1], but got {}", quantile);
+}
+
+ApproximateQuantileAggregationLogicalFunction::ApproximateQuantileAggregationLogicalFunction(
+    const Sketch sketch, const FieldAccessLogicalFunction& onField, const double quantile)
+    : ApproximateQuantileAggregationLogicalFunction(sketch, onField, onField, quantile)
+{
+}
+
+std::string_view ApproximateQuantileAggregationLogicalFunction::getName() const noexcept
+{
+    switch (sketch)
+    {
+        case Sketch::TDIGEST:
+            return TDIGEST_NAME;
+        case Sketch::KLL:
+            return KLL_NAME;
+    }
+    std::unreachable();
+}
+
+bool ApproximateQuantileAggregationLogicalFunction::shallIncludeNullValues() noexcept
+{
+    return true;
+}
+
+ApproximateQuantileAggregationLogicalFunction ApproximateQuantileAggregationLogicalFunction::withInferredStamp(const Schema& schema) const
+{
+    /// We first infer the dataType of the input field. The approximated quantile is always a FLOAT64.
+    auto newOnField = this->getOnField().withInferredDataType(schema).getAs<FieldAccessLogicalFunction>().get();
+    if (not newOnField.getDataType().isNumeric())
+    {
+        throw CannotDeserialize("aggregations on non numeric fields is not supported, but got {}", newOnField.getDataType());
+    }
+
+    ///Set fully qualified name for the as Field
+    const auto onFieldName = newOnField.getFieldName();
+    const auto asFieldName = this->getAsField().getFieldName();
+
+    const auto attributeNameResolver = onFieldName.substr(0, onFieldName.find(Schema::ATTRIBUTE_NAME_SEPARATOR) + 1);
+
+    std::string newAsFieldName;
+    ///If on and as field name are different then append the attribute name resolver from on field to the as field
+    if (asFieldName.find(Schema::ATTRIBUTE_NAME_SEPARATOR) == std::string::npos)
+    {
+        newAsFieldName = attributeNameResolver + asFieldName;
+    }
+    else
+    {
+        const auto fieldName = asFieldName.substr(asFieldName.find_last_of(Schema::ATTRIBUTE_NAME_SEPARATOR) + 1);
+        newAsFieldName = attributeNameResolver + fieldName;
+    }
+    const auto newFinalAggregateStamp = DataTypeProvider::provideDataType(
+        DataType::Type::FLOAT64, newOnField.getDataType().nullable ? DataType::NULLABLE::IS_NULLABLE : DataType::NULLABLE::NOT_NULLABLE);
+    return this->withInputStamp(newOnField.getDataType())
+        .withOnField(newOnField)
+        .withFinalAggregateStamp(newFinalAggregateStamp)
+        .withAsField(this->getAsField().withFieldName(newAsFieldName).withDataType(newFinalAggregateStamp));
+}
+
+Reflected ApproximateQuantileAggregationLogicalFunction::reflect() const
+{
+    return NES::reflect(this);
+}
+
+Reflected
+Reflector<ApproximateQuantileAggregationLogicalFunction>::operator()(const ApproximateQuantileAggregationLogicalFunction& function) const
+{
+    return reflect(detail::ReflectedApproximateQuantileAggregationLogicalFunction{
+        .sketch = function.getSketch(),
+        .onField = function.getOnField(),
+        .asField = function.getAsField(),
+        .quantile = function.getQuantile()});
+}
+
+ApproximateQuantileAggregationLogicalFunction
+Unreflector<ApproximateQuantileAggregationLogicalFunction>::operator()(const Reflected& reflected) const
+{
+    auto [sketch, onField, asField, quantile] = unreflect<detail::ReflectedApproximateQuantileAggregationLogicalFunction>(reflected);
+    if (quantile < 0 or quantile > 1)
+    {
+        throw CannotDeserialize("The quantile of a quantile aggregation must be in [0, 1], but got {}", quantile);
+    }
+    return ApproximateQuantileAggregationLogicalFunction{sketch, onField, asField, quantile};
+}
+
+namespace
+{
+AggregationLogicalFunctionRegistryReturnType
+createApproximateQuantileAggregation(const ApproximateQuantileAggregationLogicalFunction::Sketch sketch, const Reflected& reflected)
+{
+    /// The quantile is not part of the fields. Thus, we can only create quantile aggregations from their reflected form.
+    if (reflected.isEmpty())
+    {
+        throw CannotDeserialize("A {} quantile aggregation requires a quantile", magic_enum::enum_name(sketch));
+    }
+    const auto function = unreflect<ApproximateQuantileAggregationLogicalFunction>(reflected);
+    if (function.getSketch() != sketch)
+    {
+        throw CannotDeserialize(
+            "Expected a {} quantile aggregation, but got {}", magic_enum::enum_name(sketch), magic_enum::enum_name(function.getSketch()));
+    }
+    return std::make_shared<WindowAggregationLogicalFunction>(function);
+}
+}
+
+/// Both sketches share this translation unit. Thus, the KllQuantile plugin is registered without its own source file.
+AggregationLogicalFunctionRegistryReturnType
+AggregationLogicalFunctionGeneratedRegistrar::RegisterTDigestQuantileAggregationLogicalFunction(
+    AggregationLogicalFunctionRegistryArguments arguments)
+{
+    return createApproximateQuantileAggregation(ApproximateQuantileAggregationLogicalFunction::Sketch::TDIGEST, arguments.reflected);
+}
+
+AggregationLogicalFunctionRegistryReturnType AggregationLogicalFunctionGeneratedRegistrar::RegisterKllQuantileAggregationLogicalFunction(
+    AggregationLogicalFunctionRegistryArguments arguments)
+{
+    return createApproximateQuantileAggregation(ApproximateQuantileAggregationLogicalFunction::Sketch::KLL, arguments.reflected);
+}
+
+std::string ApproximateQuantileAggregationLogicalFunction::toString() const
+{
+    return fmt::format("WindowAggregation: onField={} asField={} quantile={}", onField, asField, quantile);
+}
+
+DataType ApproximateQuantileAggregationLogicalFunction::getInputStamp() const
+{
+    return inputStamp;
+}
+
+DataType ApproximateQuantileAggregationLogicalFunction::getPartialAggregateStamp() const
+{
+    return partialAggregateStamp;
+}
+
+DataType ApproximateQuantileAggregationLogicalFunction::getFinalAggregateStamp() const
+{
+    return finalAggregateStamp;
+}
+
+FieldAccessLogicalFunction ApproximateQuantileAggregationLogicalFunction::getOnField() const
+{
+    return onField;
+}
+
+FieldAccessLogicalFunction ApproximateQuantileAggregationLogicalFunction::getAsField() const
+{
+    return asField;
+}
+
+ApproximateQuantileAggregationLogicalFunction::Sketch ApproximateQuantileAggregationLogicalFunction::getSketch() const
+{
+    return sketch;
+}
+
+double ApproximateQuantileAggregationLogicalFunction::getQuantile() const
+{
+    return quantile;
+}
+
+ApproximateQuantileAggregationLogicalFunction ApproximateQuantileAggregationLogicalFunction::withInputStamp(DataType inputStamp) const
+{
+    auto copy = *this;
+    copy.inputStamp = std::move(inputStamp);
+    return copy;
+}
+
+ApproximateQuantileAggregationLogicalFunction
+ApproximateQuantileAggregationLogicalFunction::withPartialAggregateStamp(DataType partialAggregateStamp) const
+{
+    auto copy = *this;
+    copy.partialAggregateStamp = std::move(partialAggregateStamp);
+    return copy;
+}
+
+ApproximateQuantileAggregationLogicalFunction
+ApproximateQuantileAggregationLogicalFunction::withFinalAggregateStamp(DataType finalAggregateStamp) const
+{
+    auto copy = *this;
+    copy.finalAggregateStamp = std::move(finalAggregateStamp);
+    return copy;
+}
+
+ApproximateQuantileAggregationLogicalFunction
+ApproximateQuantileAggregationLogicalFunction::withOnField(FieldAccessLogicalFunction onField) const
+{
+    auto copy = *this;
+    copy.onField = std::move(onField);
+    return copy;
+}
+
+ApproximateQuantileAggregationLogicalFunction
+ApproximateQuantileAggregationLogicalFunction::withAsField(FieldAccessLogicalFunction asField) const
+{
+    auto copy = *this;
+    copy.asField = std::move(asField);
+    return copy;
+}
+
+bool ApproximateQuantileAggregationLogicalFunction::operator==(const ApproximateQuantileAggregationLogicalFunction& other) const
+{
+    return this->sketch == other.sketch && this->quantile == other.quantile && this->onField == other.onField
+        && this->asField == other.asField;
+}
+}
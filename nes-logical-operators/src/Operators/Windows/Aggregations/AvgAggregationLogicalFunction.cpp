@@ -20,6 +20,7 @@
 #include <utility>
 #include <DataTypes/DataType.hpp>
 #include <DataTypes/DataTypeProvider.hpp>
+#include <DataTypes/Decimal.hpp>
 #include <DataTypes/Schema.hpp>
 #include <Functions/FieldAccessLogicalFunction.hpp>
 #include <Functions/LogicalFunction.hpp>
@@ -55,13 +56,22 @@ AvgAggregationLogicalFunction AvgAggregationLogicalFunction::withInferredStamp(c
 {
     /// We first infer the dataType of the input field and set the output dataType as the same.
     auto newOnField = this->getOnField().withInferredDataType(schema);
-    if (not newOnField.getDataType().isNumeric())
+    const auto onFieldType = newOnField.getDataType();
+    if (not onFieldType.isNumeric() and not onFieldType.isDecimal())
     {
         throw CannotDeserialize("aggregations on non numeric fields is not supported.");
     }
 
-    /// As we are performing essentially a sum and a count, we need to cast the sum to either uint64_t, int64_t or double to avoid overflow
-    if (this->getOnField().getDataType().isInteger())
+    /// As we are performing essentially a sum and a count, we need to cast the sum to either uint64_t, int64_t or double to avoid overflow.
+    /// The sum and the average of decimals keep their scale, i.e., the average is exact up to the rounding of its last digit.
+    if (onFieldType.isDecimal())
+    {
+        newOnField = newOnField.withDataType(DataTypeProvider::provideDecimalDataType(
+            Decimal::MAX_PRECISION,
+            onFieldType.scale,
+            onFieldType.nullable ? DataType::NULLABLE::IS_NULLABLE : DataType::NULLABLE::NOT_NULLABLE));
+    }
+    else if (this->getOnField().getDataType().isInteger())
     {
         if (this->getOnField().getDataType().isSignedInteger())
         {
@@ -100,8 +110,11 @@ AvgAggregationLogicalFunction AvgAggregationLogicalFunction::withInferredStamp(c
         newAsFieldName = attributeNameResolver + fieldName;
     }
 
-    const auto newFinalAggregateStamp = DataTypeProvider::provideDataType(
-        DataType::Type::FLOAT64, newOnField.getDataType().nullable ? DataType::NULLABLE::IS_NULLABLE : DataType::NULLABLE::NOT_NULLABLE);
+    const auto newFinalAggregateStamp = onFieldType.isDecimal()
+        ? newOnField.getDataType()
+        : DataTypeProvider::provideDataType(
+              DataType::Type::FLOAT64,
+              newOnField.getDataType().nullable ? DataType::NULLABLE::IS_NULLABLE : DataType::NULLABLE::NOT_NULLABLE);
     return this->withOnField(newOnField.getAs<FieldAccessLogicalFunction>().get())
         .withFinalAggregateStamp(newFinalAggregateStamp)
         .withAsField(this->getAsField().withFieldName(newAsFieldName).withDataType(newFinalAggregateStamp))
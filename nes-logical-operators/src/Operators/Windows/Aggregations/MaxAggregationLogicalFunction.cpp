@@ -60,7 +60,7 @@ MaxAggregationLogicalFunction MaxAggregationLogicalFunction::withInferredStamp(c
 {
     /// We first infer the dataType of the input field and set the output dataType as the same.
     auto newOnField = this->getOnField().withInferredDataType(schema).getAs<FieldAccessLogicalFunction>().get();
-    if (not newOnField.getDataType().isNumeric())
+    if (not newOnField.getDataType().isNumeric() and not newOnField.getDataType().isDecimal())
     {
         throw CannotDeserialize("aggregations on non numeric fields is not supported, but got {}", newOnField.getDataType());
     }
@@ -19,6 +19,7 @@
 #include <string_view>
 #include <DataTypes/DataType.hpp>
 #include <DataTypes/DataTypeProvider.hpp>
+#include <DataTypes/Decimal.hpp>
 #include <DataTypes/Schema.hpp>
 #include <Functions/FieldAccessLogicalFunction.hpp>
 #include <Functions/LogicalFunction.hpp>
@@ -54,7 +55,7 @@ SumAggregationLogicalFunction SumAggregationLogicalFunction::withInferredStamp(c
 {
     /// We first infer the dataType of the input field and set the output dataType as the same.
     auto newOnField = this->getOnField().withInferredDataType(schema).getAs<FieldAccessLogicalFunction>().get();
-    if (not newOnField.getDataType().isNumeric())
+    if (not newOnField.getDataType().isNumeric() and not newOnField.getDataType().isDecimal())
     {
         throw CannotDeserialize("aggregations on non numeric fields is not supported, but got {}", newOnField.getDataType());
     }
@@ -77,6 +78,14 @@ SumAggregationLogicalFunction SumAggregationLogicalFunction::withInferredStamp(c
         newAsFieldName = attributeNameResolver + fieldName;
     }
     auto newFinalAggregationStamp = newOnField.getDataType();
+    if (newFinalAggregationStamp.isDecimal())
+    {
+        /// The sum of decimals keeps their scale, but may need all digits of an int64
+        newFinalAggregationStamp = DataTypeProvider::provideDecimalDataType(
+            Decimal::MAX_PRECISION,
+            newFinalAggregationStamp.scale,
+            newFinalAggregationStamp.nullable ? DataType::NULLABLE::IS_NULLABLE : DataType::NULLABLE::NOT_NULLABLE);
+    }
     return this->withInputStamp(newOnField.getDataType())
         .withOnField(newOnField)
         .withFinalAggregateStamp(newFinalAggregationStamp)
@@ -0,0 +1,173 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Operators/Windows/Aggregations/UdfAggregationLogicalFunction.hpp>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/FieldAccessLogicalFunction.hpp>
+#include <Operators/Windows/Aggregations/WindowAggregationLogicalFunction.hpp>
+#include <Util/Reflection.hpp>
+#include <fmt/format.h>
+#include <ErrorHandling.hpp>
+#include <SerializableVariantDescriptor.pb.h>
+
+namespace NES
+{
+UdfAggregationLogicalFunction::UdfAggregationLogicalFunction(
+    std::string name, DataType resultType, const FieldAccessLogicalFunction& onField, FieldAccessLogicalFunction asField)
+    : name(std::move(name)), resultType(std::move(resultType)), onField(onField), asField(std::move(asField))
+{
+}
+
+std::shared_ptr<WindowAggregationLogicalFunction> UdfAggregationLogicalFunction::create(
+    const std::string_view name, DataType resultType, const std::vector<FieldAccessLogicalFunction>& fields, const Reflected& reflected)
+{
+    if (!reflected.isEmpty())
+    {
+        auto [onField, asField] = unreflect<detail::ReflectedUdfAggregationLogicalFunction>(reflected);
+        return std::make_shared<WindowAggregationLogicalFunction>(
+            UdfAggregationLogicalFunction(std::string(name), std::move(resultType), onField, asField));
+    }
+    if (fields.size() != 2)
+    {
+        throw CannotDeserialize("{} requires exactly two fields, but got {}", name, fields.size());
+    }
+    return std::make_shared<WindowAggregationLogicalFunction>(
+        UdfAggregationLogicalFunction(std::string(name), std::move(resultType), fields[0], fields[1]));
+}
+
+bool UdfAggregationLogicalFunction::shallIncludeNullValues() noexcept
+{
+    return false;
+}
+
+std::string_view UdfAggregationLogicalFunction::getName() const noexcept
+{
+    return name;
+}
+
+UdfAggregationLogicalFunction UdfAggregationLogicalFunction::withInferredStamp(const Schema& schema) const
+{
+    auto newOnField = this->getOnField().withInferredDataType(schema).getAs<FieldAccessLogicalFunction>().get();
+    if (newOnField.getDataType().isType(DataType::Type::VARSIZED) or newOnField.getDataType().isType(DataType::Type::UNDEFINED))
+    {
+        throw CannotDeserialize("{} does not support fields of type {}", name, newOnField.getDataType());
+    }
+
+    ///Set fully qualified name for the as Field
+    const auto onFieldName = newOnField.getFieldName();
+    const auto asFieldName = this->getAsField().getFieldName();
+    const auto attributeNameResolver = onFieldName.substr(0, onFieldName.find(Schema::ATTRIBUTE_NAME_SEPARATOR) + 1);
+    std::string newAsFieldName;
+    if (asFieldName.find(Schema::ATTRIBUTE_NAME_SEPARATOR) == std::string::npos)
+    {
+        newAsFieldName = attributeNameResolver + asFieldName;
+    }
+    else
+    {
+        const auto fieldName = asFieldName.substr(asFieldName.find_last_of(Schema::ATTRIBUTE_NAME_SEPARATOR) + 1);
+        newAsFieldName = attributeNameResolver + fieldName;
+    }
+    return this->withInputStamp(newOnField.getDataType())
+        .withOnField(newOnField)
+        .withFinalAggregateStamp(resultType)
+        .withAsField(this->getAsField().withFieldName(newAsFieldName).withDataType(resultType));
+}
+
+Reflected UdfAggregationLogicalFunction::reflect() const
+{
+    return NES::reflect(this);
+}
+
+Reflected Reflector<UdfAggregationLogicalFunction>::operator()(const UdfAggregationLogicalFunction& function) const
+{
+    return reflect(detail::ReflectedUdfAggregationLogicalFunction{.onField = function.getOnField(), .asField = function.getAsField()});
+}
+
+std::string UdfAggregationLogicalFunction::toString() const
+{
+    return fmt::format("WindowAggregation: {} onField={} asField={}", name, onField, asField);
+}
+
+DataType UdfAggregationLogicalFunction::getInputStamp() const
+{
+    return inputStamp;
+}
+
+DataType UdfAggregationLogicalFunction::getPartialAggregateStamp() const
+{
+    return partialAggregateStamp;
+}
+
+DataType UdfAggregationLogicalFunction::getFinalAggregateStamp() const
+{
+    return finalAggregateStamp;
+}
+
+FieldAccessLogicalFunction UdfAggregationLogicalFunction::getOnField() const
+{
+    return onField;
+}
+
+FieldAccessLogicalFunction UdfAggregationLogicalFunction::getAsField() const
+{
+    return asField;
+}
+
+UdfAggregationLogicalFunction UdfAggregationLogicalFunction::withInputStamp(DataType inputStamp) const
+{
+    auto copy = *this;
+    copy.inputStamp = std::move(inputStamp);
+    return copy;
+}
+
+UdfAggregationLogicalFunction UdfAggregationLogicalFunction::withPartialAggregateStamp(DataType partialAggregateStamp) const
+{
+    auto copy = *this;
+    copy.partialAggregateStamp = std::move(partialAggregateStamp);
+    return copy;
+}
+
+UdfAggregationLogicalFunction UdfAggregationLogicalFunction::withFinalAggregateStamp(DataType finalAggregateStamp) const
+{
+    auto copy = *this;
+    copy.finalAggregateStamp = std::move(finalAggregateStamp);
+    return copy;
+}
+
+UdfAggregationLogicalFunction UdfAggregationLogicalFunction::withOnField(FieldAccessLogicalFunction onField) const
+{
+    auto copy = *this;
+    copy.onField = std::move(onField);
+    return copy;
+}
+
+UdfAggregationLogicalFunction UdfAggregationLogicalFunction::withAsField(FieldAccessLogicalFunction asField) const
+{
+    auto copy = *this;
+    copy.asField = std::move(asField);
+    return copy;
+}
+
+bool UdfAggregationLogicalFunction::operator==(const UdfAggregationLogicalFunction& other) const
+{
+    return name == other.name and onField == other.onField and asField == other.asField;
+}
+}
@@ -0,0 +1,183 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Operators/Windows/DeduplicationLogicalOperator.hpp>
+
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <DataTypes/Schema.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Serialization/LogicalFunctionReflection.hpp>
+#include <Serialization/WindowTypeReflection.hpp>
+#include <Traits/Trait.hpp>
+#include <Util/PlanRenderer.hpp>
+#include <Util/Reflection.hpp>
+#include <WindowTypes/Types/TumblingWindow.hpp>
+#include <WindowTypes/Types/WindowType.hpp>
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <ErrorHandling.hpp>
+#include <LogicalOperatorRegistry.hpp>
+
+namespace NES
+{
+
+DeduplicationLogicalOperator::DeduplicationLogicalOperator(
+    std::vector<LogicalFunction> keys, std::shared_ptr<Windowing::WindowType> windowType)
+    : keys(std::move(keys)), windowType(std::move(windowType))
+{
+}
+
+std::string_view DeduplicationLogicalOperator::getName() const noexcept
+{
+    return NAME;
+}
+
+const std::vector<LogicalFunction>& DeduplicationLogicalOperator::getKeys() const
+{
+    return keys;
+}
+
+std::shared_ptr<Windowing::WindowType> DeduplicationLogicalOperator::getWindowType() const
+{
+    return windowType;
+}
+
+bool DeduplicationLogicalOperator::operator==(const DeduplicationLogicalOperator& rhs) const
+{
+    return keys == rhs.keys && *windowType == *rhs.windowType && getOutputSchema() == rhs.getOutputSchema()
+        && getInputSchemas() == rhs.getInputSchemas() && getTraitSet() == rhs.getTraitSet();
+}
+
+std::string DeduplicationLogicalOperator::explain(ExplainVerbosity verbosity, OperatorId opId) const
+{
+    const auto explainedKeys = keys.empty()
+        ? std::string("*")
+        : fmt::format("{}", fmt::join(keys | std::views::transform([verbosity](const auto& key) { return key.explain(verbosity); }), ", "));
+    if (verbosity == ExplainVerbosity::Debug)
+    {
+        return fmt::format(
+            "DEDUPLICATION(opId: {}, keys: {}, window type: {}, traitSet: {})",
+            opId,
+            explainedKeys,
+            windowType->toString(),
+            traitSet.explain(verbosity));
+    }
+    return fmt::format("DEDUPLICATION({})", explainedKeys);
+}
+
+DeduplicationLogicalOperator DeduplicationLogicalOperator::withInferredSchema(std::vector<Schema> inputSchemas) const
+{
+    auto copy = *this;
+    INVARIANT(!inputSchemas.empty(), "Deduplication should have at least one input");
+
+    const auto& firstSchema = inputSchemas[0];
+    for (const auto& schema : inputSchemas)
+    {
+        if (schema != firstSchema)
+        {
+            throw CannotInferSchema("All input schemas must be equal for Deduplication operator");
+        }
+    }
+
+    /// The keys of a tumbling window can be discarded once it ends, while a record would be the first of its key in several sliding windows
+    if (std::dynamic_pointer_cast<Windowing::TumblingWindow>(windowType) == nullptr)
+    {
+        throw CannotInferSchema("Deduplication only supports tumbling windows, but got {}", windowType->toString());
+    }
+    copy.windowType->inferStamp(firstSchema);
+    copy.keys = keys | std::views::transform([&](const auto& key) { return key.withInferredDataType(firstSchema); })
+        | std::ranges::to<std::vector>();
+    copy.inputSchema = firstSchema;
+    copy.outputSchema = firstSchema;
+    return copy;
+}
+
+TraitSet DeduplicationLogicalOperator::getTraitSet() const
+{
+    return traitSet;
+}
+
+DeduplicationLogicalOperator DeduplicationLogicalOperator::withTraitSet(TraitSet traitSet) const
+{
+    auto copy = *this;
+    copy.traitSet = std::move(traitSet);
+    return copy;
+}
+
+DeduplicationLogicalOperator DeduplicationLogicalOperator::withChildren(std::vector<LogicalOperator> children) const
+{
+    auto copy = *this;
+    copy.children = std::move(children);
+    return copy;
+}
+
+std::vector<Schema> DeduplicationLogicalOperator::getInputSchemas() const
+{
+    return {inputSchema};
+}
+
+Schema DeduplicationLogicalOperator::getOutputSchema() const
+{
+    return outputSchema;
+}
+
+std::vector<LogicalOperator> DeduplicationLogicalOperator::getChildren() const
+{
+    return children;
+}
+
+Reflected Reflector<DeduplicationLogicalOperator>::operator()(const DeduplicationLogicalOperator& op) const
+{
+    return reflect(detail::ReflectedDeduplicationLogicalOperator{
+        .keys = op.getKeys() | std::views::transform([](const auto& key) { return std::make_optional(key); })
+            | std::ranges::to<std::vector>(),
+        .windowType = reflectWindowType(*op.getWindowType())});
+}
+
+DeduplicationLogicalOperator Unreflector<DeduplicationLogicalOperator>::operator()(const Reflected& reflected) const
+{
+    auto [reflectedKeys, windowType] = unreflect<detail::ReflectedDeduplicationLogicalOperator>(reflected);
+    std::vector<LogicalFunction> keys;
+    for (const auto& key : reflectedKeys)
+    {
+        if (not key.has_value())
+        {
+            throw CannotDeserialize("Failed to deserialize the keys of a deduplication logical operator");
+        }
+        keys.emplace_back(key.value());
+    }
+    return {std::move(keys), unreflectWindowType(windowType)};
+}
+
+LogicalOperatorRegistryReturnType
+LogicalOperatorGeneratedRegistrar::RegisterDeduplicationLogicalOperator(LogicalOperatorRegistryArguments arguments)
+{
+    if (!arguments.reflected.isEmpty())
+    {
+        return unreflect<DeduplicationLogicalOperator>(arguments.reflected);
+    }
+    PRECONDITION(false, "Operator is only build directly via parser or via reflection, not using the registry");
+    std::unreachable();
+}
+
+}
@@ -23,6 +23,7 @@
 
 #include <fmt/format.h>
 #include <fmt/ranges.h>
+#include <magic_enum/magic_enum.hpp>
 
 #include <Configurations/Descriptor.hpp>
 #include <Configurations/Enums/EnumWrapper.hpp>
@@ -37,6 +38,7 @@
 #include <Serialization/LogicalFunctionReflection.hpp>
 #include <Serialization/WindowTypeReflection.hpp>
 #include <Traits/ImplementationTypeTrait.hpp>
+#include <Traits/JoinStateEstimateTrait.hpp>
 #include <Traits/Trait.hpp>
 #include <Traits/TraitSet.hpp>
 #include <Util/PlanRenderer.hpp>
@@ -81,7 +83,22 @@ std::string JoinLogicalOperator::explain(ExplainVerbosity verbosity, OperatorId
             windowMetaData.windowEndFieldName,
             traitSet.explain(verbosity));
     }
-    return fmt::format("Join({})", getJoinFunction().explain(verbosity));
+    /// The optimizer chooses the join implementation and estimates the state per join. Thus, we show them once they are known.
+    auto explanation = fmt::format("Join({}", getJoinFunction().explain(verbosity));
+    if (const auto implementation = traitSet.tryGet<JoinImplementationTypeTrait>();
+        implementation.has_value() and implementation.value()->implementationType != JoinImplementation::CHOICELESS)
+    {
+        explanation += fmt::format(", implementation: {}", magic_enum::enum_name(implementation.value()->implementationType));
+        if (implementation.value()->hashJoinBuildSide != HashJoinBuildSide::BOTH)
+        {
+            explanation += fmt::format(", hashed side: {}", magic_enum::enum_name(implementation.value()->hashJoinBuildSide));
+        }
+    }
+    if (const auto stateEstimate = traitSet.tryGet<JoinStateEstimateTrait>(); stateEstimate.has_value())
+    {
+        explanation += fmt::format(", estimated state per slice: {} bytes", stateEstimate.value()->bytesPerSlice);
+    }
+    return explanation + ")";
 }
 
 JoinLogicalOperator JoinLogicalOperator::withInferredSchema(std::vector<Schema> inputSchemas) const
@@ -195,6 +212,11 @@ LogicalFunction JoinLogicalOperator::getJoinFunction() const
     return joinFunction;
 }
 
+JoinLogicalOperator::JoinType JoinLogicalOperator::getJoinType() const
+{
+    return joinType;
+}
+
 Reflected Reflector<JoinLogicalOperator>::operator()(const JoinLogicalOperator& op) const
 {
     return reflect(detail::ReflectedJoinLogicalOperator{
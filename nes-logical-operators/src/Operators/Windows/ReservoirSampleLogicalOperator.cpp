@@ -0,0 +1,169 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Operators/Windows/ReservoirSampleLogicalOperator.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <DataTypes/Schema.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Serialization/WindowTypeReflection.hpp>
+#include <Traits/Trait.hpp>
+#include <Util/PlanRenderer.hpp>
+#include <Util/Reflection.hpp>
+#include <WindowTypes/Types/SlidingWindow.hpp>
+#include <WindowTypes/Types/TumblingWindow.hpp>
+#include <WindowTypes/Types/WindowType.hpp>
+#include <fmt/format.h>
+#include <ErrorHandling.hpp>
+#include <LogicalOperatorRegistry.hpp>
+
+namespace NES
+{
+
+ReservoirSampleLogicalOperator::ReservoirSampleLogicalOperator(
+    const uint64_t sampleSize, std::shared_ptr<Windowing::WindowType> windowType)
+    : sampleSize(sampleSize), windowType(std::move(windowType))
+{
+}
+
+std::string_view ReservoirSampleLogicalOperator::getName() const noexcept
+{
+    return NAME;
+}
+
+uint64_t ReservoirSampleLogicalOperator::getSampleSize() const
+{
+    return sampleSize;
+}
+
+std::shared_ptr<Windowing::WindowType> ReservoirSampleLogicalOperator::getWindowType() const
+{
+    return windowType;
+}
+
+bool ReservoirSampleLogicalOperator::operator==(const ReservoirSampleLogicalOperator& rhs) const
+{
+    return sampleSize == rhs.sampleSize && *windowType == *rhs.windowType && getOutputSchema() == rhs.getOutputSchema()
+        && getInputSchemas() == rhs.getInputSchemas() && getTraitSet() == rhs.getTraitSet();
+}
+
+std::string ReservoirSampleLogicalOperator::explain(ExplainVerbosity verbosity, OperatorId opId) const
+{
+    if (verbosity == ExplainVerbosity::Debug)
+    {
+        return fmt::format(
+            "RESERVOIR_SAMPLE(opId: {}, sample size: {}, window type: {}, traitSet: {})",
+            opId,
+            sampleSize,
+            windowType->toString(),
+            traitSet.explain(verbosity));
+    }
+    return fmt::format("RESERVOIR_SAMPLE({})", sampleSize);
+}
+
+ReservoirSampleLogicalOperator ReservoirSampleLogicalOperator::withInferredSchema(std::vector<Schema> inputSchemas) const
+{
+    auto copy = *this;
+    INVARIANT(!inputSchemas.empty(), "ReservoirSample should have at least one input");
+
+    const auto& firstSchema = inputSchemas[0];
+    for (const auto& schema : inputSchemas)
+    {
+        if (schema != firstSchema)
+        {
+            throw CannotInferSchema("All input schemas must be equal for ReservoirSample operator");
+        }
+    }
+
+    /// The slices of session windows get merged, which would combine reservoirs that sampled from streams of different lengths
+    if (std::dynamic_pointer_cast<Windowing::TumblingWindow>(windowType) == nullptr
+        and std::dynamic_pointer_cast<Windowing::SlidingWindow>(windowType) == nullptr)
+    {
+        throw CannotInferSchema("ReservoirSample only supports tumbling and sliding windows, but got {}", windowType->toString());
+    }
+    if (sampleSize == 0)
+    {
+        throw CannotInferSchema("The sample size of a reservoir sample must be positive");
+    }
+    copy.windowType->inferStamp(firstSchema);
+    copy.inputSchema = firstSchema;
+    copy.outputSchema = firstSchema;
+    return copy;
+}
+
+TraitSet ReservoirSampleLogicalOperator::getTraitSet() const
+{
+    return traitSet;
+}
+
+ReservoirSampleLogicalOperator ReservoirSampleLogicalOperator::withTraitSet(TraitSet traitSet) const
+{
+    auto copy = *this;
+    copy.traitSet = std::move(traitSet);
+    return copy;
+}
+
+ReservoirSampleLogicalOperator ReservoirSampleLogicalOperator::withChildren(std::vector<LogicalOperator> children) const
+{
+    auto copy = *this;
+    copy.children = std::move(children);
+    return copy;
+}
+
+std::vector<Schema> ReservoirSampleLogicalOperator::getInputSchemas() const
+{
+    return {inputSchema};
+}
+
+Schema ReservoirSampleLogicalOperator::getOutputSchema() const
+{
+    return outputSchema;
+}
+
+std::vector<LogicalOperator> ReservoirSampleLogicalOperator::getChildren() const
+{
+    return children;
+}
+
+Reflected Reflector<ReservoirSampleLogicalOperator>::operator()(const ReservoirSampleLogicalOperator& op) const
+{
+    return reflect(detail::ReflectedReservoirSampleLogicalOperator{
+        .sampleSize = op.getSampleSize(), .windowType = reflectWindowType(*op.getWindowType())});
+}
+
+ReservoirSampleLogicalOperator Unreflector<ReservoirSampleLogicalOperator>::operator()(const Reflected& reflected) const
+{
+    auto [sampleSize, windowType] = unreflect<detail::ReflectedReservoirSampleLogicalOperator>(reflected);
+    return {sampleSize, unreflectWindowType(windowType)};
+}
+
+LogicalOperatorRegistryReturnType
+LogicalOperatorGeneratedRegistrar::RegisterReservoirSampleLogicalOperator(LogicalOperatorRegistryArguments arguments)
+{
+    if (!arguments.reflected.isEmpty())
+    {
+        return unreflect<ReservoirSampleLogicalOperator>(arguments.reflected);
+    }
+    PRECONDITION(false, "Operator is only build directly via parser or via reflection, not using the registry");
+    std::unreachable();
+}
+
+}
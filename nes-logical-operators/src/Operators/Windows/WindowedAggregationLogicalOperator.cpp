@@ -17,6 +17,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <ranges>
 #include <string>
 #include <string_view>
@@ -36,6 +37,7 @@
 #include <Traits/Trait.hpp>
 #include <Util/PlanRenderer.hpp>
 #include <Util/Reflection.hpp>
+#include <WindowTypes/Types/CountBasedWindowType.hpp>
 #include <WindowTypes/Types/SlidingWindow.hpp>
 #include <WindowTypes/Types/TimeBasedWindowType.hpp>
 #include <WindowTypes/Types/TumblingWindow.hpp>
@@ -53,9 +55,19 @@ namespace NES
 WindowedAggregationLogicalOperator::WindowedAggregationLogicalOperator(
     std::vector<FieldAccessLogicalFunction> groupingKey,
     std::vector<std::shared_ptr<WindowAggregationLogicalFunction>> aggregationFunctions,
-    std::shared_ptr<Windowing::WindowType> windowType)
-    : aggregationFunctions(std::move(aggregationFunctions)), windowType(std::move(windowType)), groupingKey(std::move(groupingKey))
+    std::shared_ptr<Windowing::WindowType> windowType,
+    std::optional<WindowTopK> topK,
+    const std::optional<uint64_t> earlyResultIntervalInMs,
+    const std::optional<uint64_t> allowedLatenessInMs)
+    : aggregationFunctions(std::move(aggregationFunctions))
+    , windowType(std::move(windowType))
+    , groupingKey(std::move(groupingKey))
+    , topK(std::move(topK))
+    , earlyResultIntervalInMs(earlyResultIntervalInMs)
+    , allowedLatenessInMs(allowedLatenessInMs)
 {
+    PRECONDITION(not this->topK.has_value() or this->topK->limit > 0, "The limit of a top-k window must be larger than zero");
+    PRECONDITION(earlyResultIntervalInMs.value_or(1) > 0, "The interval of the early results of a window must be larger than zero");
 }
 
 std::string_view WindowedAggregationLogicalOperator::getName() const noexcept
@@ -69,11 +81,21 @@ std::string WindowedAggregationLogicalOperator::explain(ExplainVerbosity verbosi
     {
         auto windowType = getWindowType();
         auto windowAggregation = getWindowAggregation();
+        const auto topKDescription = topK.has_value()
+            ? fmt::format(", order by: {} {} limit {}", topK->orderField.getFieldName(), topK->ascending ? "ASC" : "DESC", topK->limit)
+            : std::string{};
+        const auto earlyResultDescription
+            = earlyResultIntervalInMs.has_value() ? fmt::format(", emit every: {}ms", *earlyResultIntervalInMs) : std::string{};
+        const auto allowedLatenessDescription
+            = allowedLatenessInMs.has_value() ? fmt::format(", allowed lateness: {}ms", *allowedLatenessInMs) : std::string{};
         return fmt::format(
-            "WINDOW AGGREGATION(opId: {}, {}, window type: {})",
+            "WINDOW AGGREGATION(opId: {}, {}, window type: {}{}{}{})",
             id,
             fmt::join(std::views::transform(windowAggregation, [](const auto& agg) { return agg->toString(); }), ", "),
-            windowType->toString());
+            windowType->toString(),
+            topKDescription,
+            earlyResultDescription,
+            allowedLatenessDescription);
     }
     auto windowAggregation = getWindowAggregation();
     return fmt::format(
@@ -115,8 +137,10 @@ bool WindowedAggregationLogicalOperator::operator==(const WindowedAggregationLog
         }
     }
 
-    return *windowType == *rhs.getWindowType() && getOutputSchema() == rhs.getOutputSchema() && getInputSchemas() == rhs.getInputSchemas()
-        && getTraitSet() == rhs.getTraitSet();
+    return *windowType == *rhs.getWindowType() && topK == rhs.getTopK()
+        && earlyResultIntervalInMs == rhs.getEarlyResultIntervalInMs() && allowedLatenessInMs == rhs.getAllowedLatenessInMs()
+        && getOutputSchema() == rhs.getOutputSchema()
+        && getInputSchemas() == rhs.getInputSchemas() && getTraitSet() == rhs.getTraitSet();
 }
 
 WindowedAggregationLogicalOperator WindowedAggregationLogicalOperator::withInferredSchema(std::vector<Schema> inputSchemas) const
@@ -145,7 +169,9 @@ WindowedAggregationLogicalOperator WindowedAggregationLogicalOperator::withInfer
     copy.inputSchema = firstSchema;
     copy.outputSchema = Schema{};
 
-    if (dynamic_cast<Windowing::TimeBasedWindowType*>(getWindowType().get()) != nullptr)
+    /// For count-based windows, the start and end of a window are the positions of the records instead of timestamps
+    if (dynamic_cast<Windowing::TimeBasedWindowType*>(getWindowType().get()) != nullptr
+        or dynamic_cast<Windowing::CountBasedWindowType*>(getWindowType().get()) != nullptr)
     {
         const auto& newQualifierForSystemField = firstSchema.getQualifierNameForSystemGeneratedFieldsWithSeparator();
 
@@ -161,6 +187,12 @@ WindowedAggregationLogicalOperator WindowedAggregationLogicalOperator::withInfer
 
     if (isKeyed())
     {
+        /// The positions of count-based windows count the records of all keys. Thus, a keyed count window would not contain the given
+        /// number of records per key, but of all keys.
+        if (dynamic_cast<Windowing::CountBasedWindowType*>(getWindowType().get()) != nullptr)
+        {
+            throw NotImplemented("Count-based windows do not support keys, as they count the records of all keys");
+        }
         auto keys = getGroupingKeys();
         auto newKeys = std::vector<FieldAccessLogicalFunction>();
         for (auto& key : keys)
@@ -175,6 +207,26 @@ WindowedAggregationLogicalOperator WindowedAggregationLogicalOperator::withInfer
     {
         copy.outputSchema.addField(agg->getAsField().getFieldName(), agg->getAsField().getDataType());
     }
+
+    if (copy.topK.has_value())
+    {
+        if (not copy.outputSchema.getFieldByName(copy.topK->orderField.getFieldName()).has_value())
+        {
+            throw CannotInferSchema(
+                "The order field {} of the window is neither a key nor an aggregation of {}",
+                copy.topK->orderField.getFieldName(),
+                copy.outputSchema);
+        }
+        copy.topK->orderField
+            = copy.topK->orderField.withInferredDataType(copy.outputSchema).getAs<FieldAccessLogicalFunction>().get();
+        if (not copy.topK->orderField.getDataType().isNumeric())
+        {
+            throw CannotInferSchema(
+                "The order field {} of the window must be numeric, but is {}",
+                copy.topK->orderField.getFieldName(),
+                copy.topK->orderField.getDataType());
+        }
+    }
     return copy;
 }
 
@@ -242,6 +294,21 @@ std::vector<FieldAccessLogicalFunction> WindowedAggregationLogicalOperator::getG
     return groupingKey;
 }
 
+const std::optional<WindowTopK>& WindowedAggregationLogicalOperator::getTopK() const
+{
+    return topK;
+}
+
+std::optional<uint64_t> WindowedAggregationLogicalOperator::getEarlyResultIntervalInMs() const
+{
+    return earlyResultIntervalInMs;
+}
+
+std::optional<uint64_t> WindowedAggregationLogicalOperator::getAllowedLatenessInMs() const
+{
+    return allowedLatenessInMs;
+}
+
 std::string WindowedAggregationLogicalOperator::getWindowStartFieldName() const
 {
     return windowMetaData.windowStartFieldName;
@@ -267,12 +334,18 @@ Reflected Reflector<WindowedAggregationLogicalOperator>::operator()(const Window
     }
 
     return reflect(detail::ReflectedWindowAggregationLogicalOperator{
-        .aggregations = windowAggregations, .keys = op.getGroupingKeys(), .windowType = reflectWindowType(*op.getWindowType())});
+        .aggregations = windowAggregations,
+        .keys = op.getGroupingKeys(),
+        .windowType = reflectWindowType(*op.getWindowType()),
+        .topK = op.getTopK(),
+        .earlyResultIntervalInMs = op.getEarlyResultIntervalInMs(),
+        .allowedLatenessInMs = op.getAllowedLatenessInMs()});
 }
 
 WindowedAggregationLogicalOperator Unreflector<WindowedAggregationLogicalOperator>::operator()(const Reflected& reflected) const
 {
-    auto [aggregations, keys, windowTypeReflected] = unreflect<detail::ReflectedWindowAggregationLogicalOperator>(reflected);
+    auto [aggregations, keys, windowTypeReflected, topK, earlyResultIntervalInMs, allowedLatenessInMs]
+        = unreflect<detail::ReflectedWindowAggregationLogicalOperator>(reflected);
 
     auto windowType = unreflectWindowType(windowTypeReflected);
 
@@ -290,7 +363,7 @@ WindowedAggregationLogicalOperator Unreflector<WindowedAggregationLogicalOperato
     }
 
 
-    return {keys, aggregationFunctions, windowType};
+    return {keys, aggregationFunctions, windowType, topK, earlyResultIntervalInMs, allowedLatenessInMs};
 }
 
 LogicalOperatorRegistryReturnType
@@ -14,8 +14,11 @@
 
 #include <Plans/LogicalPlanBuilder.hpp>
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <ranges>
 #include <string>
 #include <unordered_map>
@@ -25,12 +28,16 @@
 
 #include <Configurations/Descriptor.hpp>
 #include <DataTypes/Schema.hpp>
+#include <Functions/BooleanFunctions/AndLogicalFunction.hpp>
+#include <Functions/BooleanFunctions/EqualsLogicalFunction.hpp>
 #include <Functions/ConstantValueLogicalFunction.hpp>
 #include <Functions/FieldAccessLogicalFunction.hpp>
 #include <Functions/LogicalFunction.hpp>
 #include <Iterators/BFSIterator.hpp>
+#include <Operators/BernoulliSampleLogicalOperator.hpp>
 #include <Operators/EventTimeWatermarkAssignerLogicalOperator.hpp>
 #include <Operators/IngestionTimeWatermarkAssignerLogicalOperator.hpp>
+#include <Operators/LookupJoinLogicalOperator.hpp>
 #include <Operators/ProjectionLogicalOperator.hpp>
 #include <Operators/SelectionLogicalOperator.hpp>
 #include <Operators/Sinks/InlineSinkLogicalOperator.hpp>
@@ -39,18 +46,49 @@
 #include <Operators/Sources/SourceNameLogicalOperator.hpp>
 #include <Operators/UnionLogicalOperator.hpp>
 #include <Operators/Windows/Aggregations/WindowAggregationLogicalFunction.hpp>
+#include <Operators/Windows/DeduplicationLogicalOperator.hpp>
 #include <Operators/Windows/JoinLogicalOperator.hpp>
+#include <Operators/Windows/ReservoirSampleLogicalOperator.hpp>
 #include <Operators/Windows/WindowedAggregationLogicalOperator.hpp>
 #include <Plans/LogicalPlan.hpp>
 #include <Util/Common.hpp>
 #include <Util/Logger/Logger.hpp>
+#include <Util/PlanRenderer.hpp>
 #include <WindowTypes/Measures/TimeCharacteristic.hpp>
+#include <WindowTypes/Types/CountBasedWindowType.hpp>
 #include <WindowTypes/Types/TimeBasedWindowType.hpp>
 #include <WindowTypes/Types/WindowType.hpp>
 #include <ErrorHandling.hpp>
 
 namespace NES
 {
+
+namespace
+{
+/// Assigns the watermarks of the time characteristic of the window to the records of the plan
+LogicalPlan addWatermarkAssigner(
+    const LogicalPlan& queryPlan,
+    const Windowing::TimeBasedWindowType& timeBasedWindowType,
+    const uint64_t outOfOrdernessBoundInMs,
+    const bool adaptiveOutOfOrderness)
+{
+    switch (timeBasedWindowType.getTimeCharacteristic().getType())
+    {
+        case Windowing::TimeCharacteristic::Type::IngestionTime:
+            return promoteOperatorToRoot(queryPlan, IngestionTimeWatermarkAssignerLogicalOperator());
+        case Windowing::TimeCharacteristic::Type::EventTime:
+            return promoteOperatorToRoot(
+                queryPlan,
+                EventTimeWatermarkAssignerLogicalOperator(
+                    FieldAccessLogicalFunction(timeBasedWindowType.getTimeCharacteristic().field.name),
+                    timeBasedWindowType.getTimeCharacteristic().getTimeUnit(),
+                    outOfOrdernessBoundInMs,
+                    adaptiveOutOfOrderness));
+    }
+    std::unreachable();
+}
+}
+
 LogicalPlan LogicalPlanBuilder::createLogicalPlan(std::string logicalSourceName)
 {
     NES_TRACE("LogicalPlanBuilder: create query plan for input source  {}", logicalSourceName);
@@ -81,37 +119,74 @@ LogicalPlan LogicalPlanBuilder::addSelection(LogicalFunction selectionFunction,
     return promoteOperatorToRoot(queryPlan, SelectionLogicalOperator(std::move(selectionFunction)));
 }
 
+LogicalPlan LogicalPlanBuilder::addBernoulliSample(const double fraction, const LogicalPlan& queryPlan)
+{
+    NES_TRACE("LogicalPlanBuilder: add bernoulli sample operator to query plan");
+    return promoteOperatorToRoot(queryPlan, BernoulliSampleLogicalOperator(fraction));
+}
+
 LogicalPlan LogicalPlanBuilder::addWindowAggregation(
     LogicalPlan queryPlan,
     const std::shared_ptr<Windowing::WindowType>& windowType,
     std::vector<std::shared_ptr<WindowAggregationLogicalFunction>> windowAggs,
-    std::vector<FieldAccessLogicalFunction> onKeys)
+    std::vector<FieldAccessLogicalFunction> onKeys,
+    std::optional<WindowTopK> topK,
+    std::optional<uint64_t> earlyResultIntervalInMs,
+    std::optional<uint64_t> allowedLatenessInMs,
+    const uint64_t outOfOrdernessBoundInMs,
+    const bool adaptiveOutOfOrderness)
 {
     PRECONDITION(not queryPlan.getRootOperators().empty(), "invalid query plan, as the root operator is empty");
 
-    if (auto* timeBasedWindowType = dynamic_cast<Windowing::TimeBasedWindowType*>(windowType.get()))
+    if (const auto* timeBasedWindowType = dynamic_cast<Windowing::TimeBasedWindowType*>(windowType.get()))
     {
-        switch (timeBasedWindowType->getTimeCharacteristic().getType())
-        {
-            case Windowing::TimeCharacteristic::Type::IngestionTime:
-                queryPlan = promoteOperatorToRoot(queryPlan, IngestionTimeWatermarkAssignerLogicalOperator());
-                break;
-            case Windowing::TimeCharacteristic::Type::EventTime:
-                queryPlan = promoteOperatorToRoot(
-                    queryPlan,
-                    EventTimeWatermarkAssignerLogicalOperator(
-                        FieldAccessLogicalFunction(timeBasedWindowType->getTimeCharacteristic().field.name),
-                        timeBasedWindowType->getTimeCharacteristic().getTimeUnit()));
-                break;
-        }
+        queryPlan = addWatermarkAssigner(queryPlan, *timeBasedWindowType, outOfOrdernessBoundInMs, adaptiveOutOfOrderness);
     }
-    else
+    /// Count-based windows need no watermark assigner, as their watermarks are the positions of the records and not timestamps
+    else if (dynamic_cast<Windowing::CountBasedWindowType*>(windowType.get()) == nullptr)
     {
-        throw NotImplemented("Only TimeBasedWindowType is supported for now");
+        throw NotImplemented("Only TimeBasedWindowType and CountBasedWindowType are supported for now");
     }
 
     auto inputSchema = queryPlan.getRootOperators().front().getOutputSchema();
-    return promoteOperatorToRoot(queryPlan, WindowedAggregationLogicalOperator(std::move(onKeys), std::move(windowAggs), windowType));
+    return promoteOperatorToRoot(
+        queryPlan,
+        WindowedAggregationLogicalOperator(
+            std::move(onKeys), std::move(windowAggs), windowType, std::move(topK), earlyResultIntervalInMs, allowedLatenessInMs));
+}
+
+LogicalPlan LogicalPlanBuilder::addDeduplication(
+    LogicalPlan queryPlan,
+    const std::shared_ptr<Windowing::WindowType>& windowType,
+    std::vector<LogicalFunction> keys,
+    const uint64_t outOfOrdernessBoundInMs,
+    const bool adaptiveOutOfOrderness)
+{
+    PRECONDITION(not queryPlan.getRootOperators().empty(), "invalid query plan, as the root operator is empty");
+    const auto* timeBasedWindowType = dynamic_cast<Windowing::TimeBasedWindowType*>(windowType.get());
+    if (timeBasedWindowType == nullptr)
+    {
+        throw NotImplemented("Only TimeBasedWindowType is supported for deduplication");
+    }
+    queryPlan = addWatermarkAssigner(queryPlan, *timeBasedWindowType, outOfOrdernessBoundInMs, adaptiveOutOfOrderness);
+    return promoteOperatorToRoot(queryPlan, DeduplicationLogicalOperator(std::move(keys), windowType));
+}
+
+LogicalPlan LogicalPlanBuilder::addReservoirSample(
+    LogicalPlan queryPlan,
+    const std::shared_ptr<Windowing::WindowType>& windowType,
+    const uint64_t sampleSize,
+    const uint64_t outOfOrdernessBoundInMs,
+    const bool adaptiveOutOfOrderness)
+{
+    PRECONDITION(not queryPlan.getRootOperators().empty(), "invalid query plan, as the root operator is empty");
+    const auto* timeBasedWindowType = dynamic_cast<Windowing::TimeBasedWindowType*>(windowType.get());
+    if (timeBasedWindowType == nullptr)
+    {
+        throw NotImplemented("Only TimeBasedWindowType is supported for reservoir samples");
+    }
+    queryPlan = addWatermarkAssigner(queryPlan, *timeBasedWindowType, outOfOrdernessBoundInMs, adaptiveOutOfOrderness);
+    return promoteOperatorToRoot(queryPlan, ReservoirSampleLogicalOperator(sampleSize, windowType));
 }
 
 LogicalPlan LogicalPlanBuilder::addUnion(LogicalPlan leftLogicalPlan, LogicalPlan rightLogicalPlan)
@@ -176,6 +251,36 @@ LogicalPlan LogicalPlanBuilder::addJoin(
     return leftLogicalPlan;
 }
 
+LogicalPlan
+LogicalPlanBuilder::addLookupJoin(LogicalPlan streamLogicalPlan, LogicalPlan tableLogicalPlan, const LogicalFunction& joinFunction)
+{
+    /// The lookup join probes a hash index over the keys of the table, thus every conjunct must compare two fields for equality
+    std::vector conjuncts{joinFunction};
+    while (not conjuncts.empty())
+    {
+        const auto conjunct = conjuncts.back();
+        conjuncts.pop_back();
+        const auto children = conjunct.getChildren();
+        if (conjunct.tryGetAs<AndLogicalFunction>().has_value())
+        {
+            conjuncts.insert(conjuncts.end(), children.begin(), children.end());
+            continue;
+        }
+        const auto isFieldAccess = [](const LogicalFunction& child) { return child.tryGetAs<FieldAccessLogicalFunction>().has_value(); };
+        const auto comparesFields = conjunct.tryGetAs<EqualsLogicalFunction>().has_value() and std::ranges::all_of(children, isFieldAccess);
+        if (not comparesFields)
+        {
+            throw InvalidQuerySyntax(
+                "A lookup join only supports equalities between the fields of the stream and the table, but got {}",
+                conjunct.explain(ExplainVerbosity::Short));
+        }
+    }
+
+    INVARIANT(!tableLogicalPlan.getRootOperators().empty(), "RootOperators of tableLogicalPlan are empty");
+    /// The table is static, thus neither input requires a watermark assigner
+    return addBinaryOperatorAndUpdateSource(LookupJoinLogicalOperator(joinFunction), streamLogicalPlan, tableLogicalPlan);
+}
+
 LogicalPlan LogicalPlanBuilder::addSink(std::string sinkName, const LogicalPlan& queryPlan)
 {
     return promoteOperatorToRoot(queryPlan, SinkLogicalOperator(std::move(sinkName)));
@@ -191,6 +296,10 @@ LogicalPlan
 LogicalPlanBuilder::checkAndAddWatermarkAssigner(LogicalPlan queryPlan, const std::shared_ptr<Windowing::WindowType>& windowType)
 {
     NES_TRACE("LogicalPlanBuilder: checkAndAddWatermarkAssigner for a (sub)query plan");
+    if (dynamic_cast<Windowing::CountBasedWindowType*>(windowType.get()) != nullptr)
+    {
+        throw NotImplemented("Count-based windows are only supported for window aggregations");
+    }
     auto timeBasedWindowType = as<Windowing::TimeBasedWindowType>(windowType);
 
     if (getOperatorByType<IngestionTimeWatermarkAssignerLogicalOperator>(queryPlan).empty()
@@ -18,6 +18,9 @@
 #include <utility>
 
 #include <Util/Reflection.hpp>
+#include <WindowTypes/Types/CountBasedWindowType.hpp>
+#include <WindowTypes/Types/IntervalWindow.hpp>
+#include <WindowTypes/Types/SessionWindow.hpp>
 #include <WindowTypes/Types/SlidingWindow.hpp>
 #include <WindowTypes/Types/TumblingWindow.hpp>
 #include <WindowTypes/Types/WindowType.hpp>
@@ -40,6 +43,21 @@ Reflected reflectWindowType(const Windowing::WindowType& windowType)
             const auto slidingWindow = dynamic_cast<const Windowing::SlidingWindow&>(windowType);
             return std::make_pair("SlidingWindow", reflect(slidingWindow));
         }
+        if (typeid(windowType) == typeid(Windowing::SessionWindow))
+        {
+            const auto sessionWindow = dynamic_cast<const Windowing::SessionWindow&>(windowType);
+            return std::make_pair("SessionWindow", reflect(sessionWindow));
+        }
+        if (typeid(windowType) == typeid(Windowing::IntervalWindow))
+        {
+            const auto intervalWindow = dynamic_cast<const Windowing::IntervalWindow&>(windowType);
+            return std::make_pair("IntervalWindow", reflect(intervalWindow));
+        }
+        if (typeid(windowType) == typeid(Windowing::CountBasedWindowType))
+        {
+            const auto countBasedWindow = dynamic_cast<const Windowing::CountBasedWindowType&>(windowType);
+            return std::make_pair("CountBasedWindow", reflect(countBasedWindow));
+        }
         throw CannotSerialize("Cannot serialize unknown window type");
     }();
 
@@ -60,6 +78,18 @@ std::shared_ptr<Windowing::WindowType> unreflectWindowType(const Reflected& refl
         {
             return std::make_shared<Windowing::SlidingWindow>(unreflect<Windowing::SlidingWindow>(config));
         }
+        if (type == "SessionWindow")
+        {
+            return std::make_shared<Windowing::SessionWindow>(unreflect<Windowing::SessionWindow>(config));
+        }
+        if (type == "IntervalWindow")
+        {
+            return std::make_shared<Windowing::IntervalWindow>(unreflect<Windowing::IntervalWindow>(config));
+        }
+        if (type == "CountBasedWindow")
+        {
+            return std::make_shared<Windowing::CountBasedWindowType>(unreflect<Windowing::CountBasedWindowType>(config));
+        }
         throw CannotDeserialize("Cannot deserialize unknown window type {}", type);
     }();
 
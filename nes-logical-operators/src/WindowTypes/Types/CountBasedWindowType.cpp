@@ -0,0 +1,78 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <WindowTypes/Types/CountBasedWindowType.hpp>
+
+#include <cstdint>
+#include <string>
+#include <DataTypes/Schema.hpp>
+#include <Util/Reflection.hpp>
+#include <WindowTypes/Types/WindowType.hpp>
+#include <fmt/format.h>
+#include <ErrorHandling.hpp>
+
+namespace NES::Windowing
+{
+
+CountBasedWindowType::CountBasedWindowType(const uint64_t size, const uint64_t slide) : size(size), slide(slide)
+{
+    PRECONDITION(size > 0, "The size of a count-based window must be greater than zero");
+    PRECONDITION(slide > 0, "The slide of a count-based window must be greater than zero");
+}
+
+uint64_t CountBasedWindowType::getSize() const
+{
+    return size;
+}
+
+uint64_t CountBasedWindowType::getSlide() const
+{
+    return slide;
+}
+
+std::string CountBasedWindowType::toString() const
+{
+    return fmt::format("CountBasedWindow: size={} slide={}", size, slide);
+}
+
+bool CountBasedWindowType::operator==(const WindowType& otherWindowType) const
+{
+    if (const auto* other = dynamic_cast<const CountBasedWindowType*>(&otherWindowType))
+    {
+        return (this->size == other->size) && (this->slide == other->slide);
+    }
+    return false;
+}
+
+bool CountBasedWindowType::inferStamp(const Schema&)
+{
+    return true;
+}
+
+}
+
+namespace NES
+{
+
+Reflected Reflector<Windowing::CountBasedWindowType>::operator()(const Windowing::CountBasedWindowType& countBasedWindow) const
+{
+    return reflect(detail::ReflectedCountBasedWindowType{.size = countBasedWindow.getSize(), .slide = countBasedWindow.getSlide()});
+}
+
+Windowing::CountBasedWindowType Unreflector<Windowing::CountBasedWindowType>::operator()(const Reflected& reflected) const
+{
+    auto [size, slide] = unreflect<detail::ReflectedCountBasedWindowType>(reflected);
+    return {size, slide};
+}
+}
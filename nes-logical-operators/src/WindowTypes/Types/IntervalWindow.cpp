@@ -0,0 +1,103 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <WindowTypes/Types/IntervalWindow.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <Util/Reflection.hpp>
+#include <WindowTypes/Measures/TimeCharacteristic.hpp>
+#include <WindowTypes/Measures/TimeMeasure.hpp>
+#include <WindowTypes/Types/TimeBasedWindowType.hpp>
+#include <WindowTypes/Types/WindowType.hpp>
+#include <fmt/format.h>
+#include <ErrorHandling.hpp>
+
+namespace NES::Windowing
+{
+
+IntervalWindow::IntervalWindow(TimeCharacteristic timeCharacteristic, const int64_t lowerBound, const int64_t upperBound)
+    : TimeBasedWindowType(std::move(timeCharacteristic)), lowerBound(lowerBound), upperBound(upperBound)
+{
+    PRECONDITION(lowerBound <= upperBound, "The lower bound {} of an interval must not exceed its upper bound {}", lowerBound, upperBound);
+}
+
+int64_t IntervalWindow::getLowerBound() const
+{
+    return lowerBound;
+}
+
+int64_t IntervalWindow::getUpperBound() const
+{
+    return upperBound;
+}
+
+uint64_t IntervalWindow::getOffsetOfOwnedSlice() const
+{
+    /// The right records of the owned slice may precede it by the negated lower bound
+    const auto slide = getSlide().getTime();
+    const auto precedingRange = static_cast<uint64_t>(std::max<int64_t>(-lowerBound, 0));
+    return (precedingRange + slide - 1) / slide * slide;
+}
+
+TimeMeasure IntervalWindow::getSize() const
+{
+    /// The right records of the owned slice may follow it by the upper bound
+    const auto slide = getSlide().getTime();
+    const auto followingRange = static_cast<uint64_t>(std::max<int64_t>(upperBound, 0));
+    return TimeMeasure(getOffsetOfOwnedSlice() + slide + ((followingRange + slide - 1) / slide * slide));
+}
+
+TimeMeasure IntervalWindow::getSlide() const
+{
+    return TimeMeasure(static_cast<uint64_t>(std::max<int64_t>(upperBound - lowerBound, 1)));
+}
+
+std::string IntervalWindow::toString() const
+{
+    return fmt::format(
+        "IntervalWindow: lowerBound={} upperBound={} timeCharacteristic={}", lowerBound, upperBound, timeCharacteristic);
+}
+
+bool IntervalWindow::operator==(const WindowType& otherWindowType) const
+{
+    if (const auto* other = dynamic_cast<const IntervalWindow*>(&otherWindowType))
+    {
+        return (this->lowerBound == other->lowerBound) && (this->upperBound == other->upperBound)
+            && (this->timeCharacteristic == (other->timeCharacteristic));
+    }
+    return false;
+}
+
+}
+
+namespace NES
+{
+
+Reflected Reflector<Windowing::IntervalWindow>::operator()(const Windowing::IntervalWindow& intervalWindow) const
+{
+    return reflect(detail::ReflectedIntervalWindow{
+        .lowerBound = intervalWindow.getLowerBound(),
+        .upperBound = intervalWindow.getUpperBound(),
+        .timeCharacteristic = intervalWindow.getTimeCharacteristic()});
+}
+
+Windowing::IntervalWindow Unreflector<Windowing::IntervalWindow>::operator()(const Reflected& reflected) const
+{
+    auto [lowerBound, upperBound, timeCharacteristics] = unreflect<detail::ReflectedIntervalWindow>(reflected);
+    return {timeCharacteristics, lowerBound, upperBound};
+}
+}
@@ -0,0 +1,81 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <WindowTypes/Types/SessionWindow.hpp>
+
+#include <string>
+#include <utility>
+#include <Util/Reflection.hpp>
+#include <WindowTypes/Measures/TimeCharacteristic.hpp>
+#include <WindowTypes/Measures/TimeMeasure.hpp>
+#include <WindowTypes/Types/TimeBasedWindowType.hpp>
+#include <WindowTypes/Types/WindowType.hpp>
+#include <fmt/format.h>
+#include <ErrorHandling.hpp>
+
+namespace NES::Windowing
+{
+
+SessionWindow::SessionWindow(TimeCharacteristic timeCharacteristic, TimeMeasure gap)
+    : TimeBasedWindowType(std::move(timeCharacteristic)), gap(std::move(gap))
+{
+    PRECONDITION(this->gap.getTime() > 0, "The gap of a session window must be greater than zero");
+}
+
+TimeMeasure SessionWindow::getGap() const
+{
+    return gap;
+}
+
+TimeMeasure SessionWindow::getSize() const
+{
+    return gap;
+}
+
+TimeMeasure SessionWindow::getSlide() const
+{
+    return gap;
+}
+
+std::string SessionWindow::toString() const
+{
+    return fmt::format("SessionWindow: gap={} timeCharacteristic={}", gap.getTime(), timeCharacteristic);
+}
+
+bool SessionWindow::operator==(const WindowType& otherWindowType) const
+{
+    if (const auto* other = dynamic_cast<const SessionWindow*>(&otherWindowType))
+    {
+        return (this->gap == other->gap) && (this->timeCharacteristic == (other->timeCharacteristic));
+    }
+    return false;
+}
+
+}
+
+namespace NES
+{
+
+Reflected Reflector<Windowing::SessionWindow>::operator()(const Windowing::SessionWindow& sessionWindow) const
+{
+    return reflect(
+        detail::ReflectedSessionWindow{.gap = sessionWindow.getGap(), .timeCharacteristic = sessionWindow.getTimeCharacteristic()});
+}
+
+Windowing::SessionWindow Unreflector<Windowing::SessionWindow>::operator()(const Reflected& reflected) const
+{
+    auto [gap, timeCharacteristics] = unreflect<detail::ReflectedSessionWindow>(reflected);
+    return {timeCharacteristics, gap};
+}
+}
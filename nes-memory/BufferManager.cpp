@@ -16,17 +16,29 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cerrno>
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <deque>
+#include <functional>
 #include <memory>
 #include <memory_resource>
 #include <mutex>
 #include <optional>
+#include <ranges>
+#include <span>
+#include <stop_token>
+#include <thread>
 #include <utility>
+#include <vector>
+#include <sys/mman.h>
 #include <unistd.h>
 #include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/Allocator/HugePageMemoryResource.hpp>
+#include <Runtime/Allocator/NesDefaultMemoryAllocator.hpp>
+#include <Runtime/Allocator/NumaMemoryResource.hpp>
 #include <Runtime/BufferRecycler.hpp>
 #include <Runtime/TupleBuffer.hpp>
 #include <Util/Logger/Logger.hpp>
@@ -37,19 +49,108 @@
 namespace NES
 {
 
+namespace
+{
+/// If the local pool of a NUMA-aware BufferManager is exhausted, a blocked thread re-checks the remote pools in this interval.
+constexpr auto REMOTE_POOL_POLL_INTERVAL = std::chrono::milliseconds(1);
+std::atomic<uint64_t> nextInstanceId{1};
+
+/// Value of the linux kernel (since 5.14) to fault in writable pages without modifying them, see `man 2 madvise`. We define it here,
+/// as not all libc versions expose it.
+constexpr int MADVISE_POPULATE_WRITE = 23;
+/// Below this number of buffers per thread, initializing a pool with multiple threads does not pay off
+constexpr size_t MIN_BUFFERS_PER_INITIALIZATION_THREAD = 16 * 1024;
+/// The background threads fault in the memory in chunks of this size, which bounds the time until they observe a stop request
+constexpr size_t PREFAULT_CHUNK_SIZE = 64 * 1024 * 1024;
+
+size_t getNumberOfHelperThreads(const size_t numberOfWorkUnits)
+{
+    return std::clamp<size_t>(numberOfWorkUnits, 1, std::max(std::thread::hardware_concurrency(), 1U));
+}
+
+/// Calls work(begin, end) for disjoint ranges that cover [0, size) on up to numberOfThreads threads, including the calling thread
+void parallelFor(const size_t size, const size_t numberOfThreads, const std::function<void(size_t, size_t)>& work)
+{
+    const auto rangeSize = (size + numberOfThreads - 1) / numberOfThreads;
+    std::vector<std::jthread> helpers;
+    for (size_t begin = rangeSize; begin < size; begin += rangeSize)
+    {
+        helpers.emplace_back(work, begin, std::min(begin + rangeSize, size));
+    }
+    work(0, std::min(rangeSize, size));
+}
+
+/// Faults in (and locks) the whole pages of the memory area in chunks, until the stop token is triggered
+void prefaultMemory(const std::stop_token& stopToken, uint8_t* area, const size_t areaSize, const bool lockMemory)
+{
+    const auto pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGE_SIZE));
+    const auto areaBegin = (reinterpret_cast<uintptr_t>(area) + pageSize - 1) / pageSize * pageSize;
+    const auto areaEnd = (reinterpret_cast<uintptr_t>(area) + areaSize) / pageSize * pageSize;
+    if (areaBegin >= areaEnd)
+    {
+        return;
+    }
+    const auto numberOfChunks = (areaEnd - areaBegin + PREFAULT_CHUNK_SIZE - 1) / PREFAULT_CHUNK_SIZE;
+    std::atomic_bool failed = false;
+    parallelFor(
+        numberOfChunks,
+        getNumberOfHelperThreads(numberOfChunks),
+        [&](const size_t beginChunk, const size_t endChunk)
+        {
+            for (size_t chunk = beginChunk; chunk < endChunk && !stopToken.stop_requested() && !failed.load(); ++chunk)
+            {
+                const auto chunkBegin = areaBegin + (chunk * PREFAULT_CHUNK_SIZE);
+                auto* address = reinterpret_cast<void*>(chunkBegin); /// NOLINT(performance-no-int-to-ptr)
+                const auto length = std::min(PREFAULT_CHUNK_SIZE, areaEnd - chunkBegin);
+                const auto result = lockMemory ? mlock(address, length) : madvise(address, length, MADVISE_POPULATE_WRITE);
+                if (result != 0 && !failed.exchange(true))
+                {
+                    NES_WARNING("Could not {} the pooled buffers: {}", lockMemory ? "lock" : "fault in", std::strerror(errno));
+                }
+            }
+        });
+}
+}
+
+BufferManager::BufferManager(
+    Private,
+    const uint32_t bufferSize,
+    const uint32_t numOfBuffers,
+    std::shared_ptr<std::pmr::memory_resource> memoryResource,
+    const uint32_t withAlignment)
+    : BufferManager(Private{}, bufferSize, numOfBuffers, memoryResource, {memoryResource}, withAlignment)
+{
+}
+
 BufferManager::BufferManager(
     Private,
     const uint32_t bufferSize,
     const uint32_t numOfBuffers,
     std::shared_ptr<std::pmr::memory_resource> memoryResource,
+    std::vector<std::shared_ptr<std::pmr::memory_resource>> poolMemoryResources,
     const uint32_t withAlignment)
-    : availableBuffers(numOfBuffers)
+    : buffersPerPool(poolMemoryResources.empty() ? numOfBuffers : numOfBuffers / poolMemoryResources.size())
     , unpooledChunksManager(std::make_shared<UnpooledChunksManager>(memoryResource))
+    , instanceId(nextInstanceId++)
     , bufferSize(bufferSize)
     , numOfBuffers(numOfBuffers)
     , memoryResource(std::move(memoryResource))
 {
     ((void)withAlignment);
+    PRECONDITION(!poolMemoryResources.empty(), "BufferManager requires at least one pool");
+    PRECONDITION(
+        numOfBuffers >= poolMemoryResources.size(),
+        "BufferManager requires at least one buffer per pool, but got {} buffers for {} pools",
+        numOfBuffers,
+        poolMemoryResources.size());
+
+    pools.reserve(poolMemoryResources.size());
+    for (size_t poolIndex = 0; poolIndex < poolMemoryResources.size(); ++poolIndex)
+    {
+        const auto isLastPool = poolIndex == poolMemoryResources.size() - 1;
+        const auto numberOfBuffersInPool = isLastPool ? numOfBuffers - (buffersPerPool * poolIndex) : buffersPerPool;
+        pools.emplace_back(numberOfBuffersInPool, std::move(poolMemoryResources[poolIndex]));
+    }
     initialize(DEFAULT_ALIGNMENT);
 }
 
@@ -59,12 +160,35 @@ std::shared_ptr<BufferManager> BufferManager::create(
     return std::make_shared<BufferManager>(Private{}, bufferSize, numOfBuffers, memoryResource, withAlignment);
 }
 
+std::shared_ptr<BufferManager>
+BufferManager::createNumaAware(uint32_t bufferSize, uint32_t numOfBuffers, const HugePageMode hugePageMode, uint32_t withAlignment)
+{
+    const auto numberOfNodes = std::min<size_t>(NumaMemoryResource::getNumberOfNumaNodes(), numOfBuffers);
+    std::vector<std::shared_ptr<std::pmr::memory_resource>> poolMemoryResources;
+    poolMemoryResources.reserve(numberOfNodes);
+    for (size_t node = 0; node < numberOfNodes; ++node)
+    {
+        poolMemoryResources.emplace_back(std::make_shared<NumaMemoryResource>(node, hugePageMode));
+    }
+    NES_DEBUG("Creating NUMA-aware BufferManager with {} pools", numberOfNodes);
+    std::shared_ptr<std::pmr::memory_resource> unpooledMemoryResource = hugePageMode == HugePageMode::NONE
+        ? std::static_pointer_cast<std::pmr::memory_resource>(std::make_shared<NesDefaultMemoryAllocator>())
+        : std::make_shared<HugePageMemoryResource>(hugePageMode);
+    return std::make_shared<BufferManager>(
+        Private{}, bufferSize, numOfBuffers, std::move(unpooledMemoryResource), std::move(poolMemoryResources), withAlignment);
+}
+
 BufferManager::~BufferManager()
 {
     bool expected = false;
     NES_DEBUG("Calling BufferManager::destroy()");
     if (isDestroyed.compare_exchange_strong(expected, true))
     {
+        if (prefaultThread.joinable())
+        {
+            prefaultThread.request_stop();
+            prefaultThread.join();
+        }
         bool success = true;
         if (allBuffers.size() != getNumberOfAvailableBuffers())
         {
@@ -86,13 +210,35 @@ BufferManager::~BufferManager()
             "Requested buffer manager shutdown but a buffer is still used allBuffers={} available={}",
             allBuffers.size(),
             getNumberOfAvailableBuffers());
+        for (auto& sizeClass : sizeClasses)
+        {
+            const auto numberOfAvailableBuffers = static_cast<size_t>(std::max(sizeClass.availableBuffers.size(), static_cast<ssize_t>(0)));
+            INVARIANT(
+                numberOfAvailableBuffers == sizeClass.segments.size(),
+                "Requested buffer manager shutdown but a buffer of size class {} is still used total={} available={}",
+                sizeClass.bufferSize,
+                sizeClass.segments.size(),
+                numberOfAvailableBuffers);
+        }
         /// RAII takes care of deallocating memory here
         allBuffers.clear();
+        for (auto& sizeClass : sizeClasses)
+        {
+            sizeClass.segments.clear();
+            sizeClass.availableBuffers = decltype(sizeClass.availableBuffers)();
+            memoryResource->deallocate(sizeClass.basePointer, sizeClass.allocatedAreaSize, DEFAULT_ALIGNMENT);
+        }
+        sizeClasses.clear();
 
-        availableBuffers = decltype(availableBuffers)();
         NES_DEBUG("Shutting down Buffer Manager completed");
-        memoryResource->deallocate(basePointer, allocatedAreaSize, DEFAULT_ALIGNMENT);
-        allocatedAreaSize = 0;
+        for (auto& pool : pools)
+        {
+            pool.availableBuffers = decltype(pool.availableBuffers)();
+            pool.memoryResource->deallocate(pool.basePointer, pool.allocatedAreaSize, DEFAULT_ALIGNMENT);
+            pool.allocatedAreaSize = 0;
+        }
+        pools.clear();
+        threadLocalCaches.clear();
 
         /// Destroying the unpooled chunks
         unpooledChunksManager.reset();
@@ -129,35 +275,326 @@ void BufferManager::initialize(uint32_t withAlignment)
     allBuffers.reserve(numOfBuffers);
     auto controlBlockSize = alignBufferSize(sizeof(detail::BufferControlBlock), withAlignment);
     auto alignedBufferSize = alignBufferSize(bufferSize, withAlignment);
-    allocatedAreaSize = alignBufferSize(controlBlockSize + alignedBufferSize, withAlignment);
-    const size_t offsetBetweenBuffers = allocatedAreaSize;
-    allocatedAreaSize *= numOfBuffers;
-    basePointer = static_cast<uint8_t*>(memoryResource->allocate(allocatedAreaSize, withAlignment));
-    NES_TRACE(
-        "Allocated {} bytes with alignment {} buffer size {} num buffer {} controlBlockSize {} {}",
-        allocatedAreaSize,
-        withAlignment,
-        alignedBufferSize,
-        numOfBuffers,
-        controlBlockSize,
-        alignof(detail::BufferControlBlock));
+    const size_t offsetBetweenBuffers = alignBufferSize(controlBlockSize + alignedBufferSize, withAlignment);
+    for (size_t poolIndex = 0; poolIndex < pools.size(); ++poolIndex)
+    {
+        auto& pool = pools[poolIndex];
+        const auto isLastPool = poolIndex == pools.size() - 1;
+        const auto numberOfBuffersInPool = isLastPool ? numOfBuffers - (buffersPerPool * poolIndex) : buffersPerPool;
+        pool.allocatedAreaSize = offsetBetweenBuffers * numberOfBuffersInPool;
+        pool.basePointer = static_cast<uint8_t*>(pool.memoryResource->allocate(pool.allocatedAreaSize, withAlignment));
+        NES_TRACE(
+            "Allocated {} bytes with alignment {} buffer size {} num buffer {} controlBlockSize {} {} for pool {}",
+            pool.allocatedAreaSize,
+            withAlignment,
+            alignedBufferSize,
+            numberOfBuffersInPool,
+            controlBlockSize,
+            alignof(detail::BufferControlBlock),
+            poolIndex);
+
+        INVARIANT(pool.basePointer, "memory allocation failed, because 'basePointer' was a nullptr");
+
+        /// Constructing the control blocks faults in at least one page per buffer, which takes seconds for large pools on a single thread.
+        /// Thus, multiple threads fault in the pages of the control blocks upfront.
+        const auto numberOfThreads = getNumberOfHelperThreads(numberOfBuffersInPool / MIN_BUFFERS_PER_INITIALIZATION_THREAD);
+        if (numberOfThreads > 1)
+        {
+            parallelFor(
+                numberOfBuffersInPool,
+                numberOfThreads,
+                [&pool, offsetBetweenBuffers, controlBlockSize](const size_t begin, const size_t end)
+                {
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        std::memset(pool.basePointer + (i * offsetBetweenBuffers), 0, controlBlockSize);
+                    }
+                });
+        }
+
+        uint8_t* ptr = pool.basePointer;
+        for (size_t i = 0; i < numberOfBuffersInPool; ++i)
+        {
+            uint8_t* controlBlock = ptr;
+            uint8_t* payload = ptr + controlBlockSize;
+            allBuffers.emplace_back(
+                payload,
+                bufferSize,
+                [](detail::MemorySegment* segment, BufferRecycler* recycler) { recycler->recyclePooledBuffer(segment); },
+                controlBlock);
+
+            pool.availableBuffers.write(&allBuffers.back());
+            ptr += offsetBetweenBuffers;
+        }
+    }
+    NES_DEBUG("BufferManager configuration bufferSize={} numOfBuffers={} pools={}", this->bufferSize, this->numOfBuffers, pools.size());
+}
+
+void BufferManager::prefaultInBackground(const bool lockMemory)
+{
+    PRECONDITION(!prefaultThread.joinable(), "The pooled buffers are already faulted in");
+    prefaultThread = std::jthread(
+        [this, lockMemory](const std::stop_token& stopToken)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            for (const auto& pool : pools)
+            {
+                prefaultMemory(stopToken, pool.basePointer, pool.allocatedAreaSize, lockMemory);
+            }
+            NES_DEBUG(
+                "Faulted in the pooled buffers in {}ms",
+                std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+        });
+}
+
+size_t BufferManager::getLocalPoolIndex() const
+{
+    if (pools.size() == 1)
+    {
+        return 0;
+    }
+    return NumaMemoryResource::getNumaNodeOfCurrentThread() % pools.size();
+}
+
+size_t BufferManager::getHomePoolIndex(const detail::MemorySegment* segment) const
+{
+    if (pools.size() == 1)
+    {
+        return 0;
+    }
+    const auto segmentIndex = static_cast<size_t>(segment - allBuffers.data());
+    return std::min(segmentIndex / buffersPerPool, pools.size() - 1);
+}
+
+detail::MemorySegment* BufferManager::tryReadAnyPool(const size_t localPool)
+{
+    detail::MemorySegment* memSegment = nullptr;
+    for (size_t offset = 0; offset < pools.size(); ++offset)
+    {
+        if (pools[(localPool + offset) % pools.size()].availableBuffers.read(memSegment))
+        {
+            return memSegment;
+        }
+    }
+    return nullptr;
+}
+
+void BufferManager::enableThreadLocalCaches(const size_t capacity)
+{
+    const std::scoped_lock lock(threadLocalCachesMutex);
+    PRECONDITION(threadLocalCacheCapacity == 0, "Thread-local caches were already enabled");
+    PRECONDITION(
+        capacity < numOfBuffers,
+        "Thread-local cache capacity {} must be smaller than the number of pooled buffers {}",
+        capacity,
+        numOfBuffers);
+    threadLocalCacheCapacity = capacity;
+    NES_DEBUG("Enabled thread-local buffer caches with capacity {}", capacity);
+}
+
+BufferManager::ThreadLocalCache* BufferManager::getThreadLocalCache()
+{
+    if (threadLocalCacheCapacity == 0)
+    {
+        return nullptr;
+    }
+
+    /// Threads usually only interact with a single BufferManager, thus we remember the last used cache to avoid the locked lookup.
+    struct LastUsedCache
+    {
+        uint64_t ownerId = 0;
+        ThreadLocalCache* cache = nullptr;
+    };
+    thread_local LastUsedCache lastUsed;
+    if (lastUsed.ownerId == instanceId) [[likely]]
+    {
+        return lastUsed.cache;
+    }
+    /// Buffers that are released after the caches of the exiting thread have been released return to the pools directly
+    thread_local bool threadExited = false;
+    if (threadExited)
+    {
+        return nullptr;
+    }
+
+    /// Releases the caches of the calling thread in all BufferManagers that are still alive, once the thread exits. Otherwise, the
+    /// buffers of the cache would never be available again.
+    struct ThreadExitReleaser
+    {
+        ThreadExitReleaser() = default;
+        ThreadExitReleaser(const ThreadExitReleaser&) = delete;
+        ThreadExitReleaser& operator=(const ThreadExitReleaser&) = delete;
+
+        ~ThreadExitReleaser()
+        {
+            threadExited = true;
+            lastUsed = LastUsedCache{};
+            for (const auto& weakBufferManager : bufferManagers)
+            {
+                if (const auto bufferManager = weakBufferManager.lock())
+                {
+                    bufferManager->releaseThreadLocalCache(std::this_thread::get_id());
+                }
+            }
+        }
+
+        std::vector<std::weak_ptr<BufferManager>> bufferManagers;
+    };
+    thread_local ThreadExitReleaser threadExitReleaser;
+
+    const std::scoped_lock lock(threadLocalCachesMutex);
+    auto& cache = threadLocalCaches[std::this_thread::get_id()];
+    if (!cache)
+    {
+        cache = std::make_unique<ThreadLocalCache>(threadLocalCacheCapacity);
+        std::erase_if(threadExitReleaser.bufferManagers, [](const auto& bufferManager) { return bufferManager.expired(); });
+        threadExitReleaser.bufferManagers.emplace_back(weak_from_this());
+    }
+    lastUsed = LastUsedCache{.ownerId = instanceId, .cache = cache.get()};
+    return cache.get();
+}
+
+detail::MemorySegment* BufferManager::tryReadThreadLocalCache()
+{
+    auto* cache = getThreadLocalCache();
+    if (cache == nullptr)
+    {
+        return nullptr;
+    }
+
+    auto size = cache->size.load(std::memory_order_relaxed);
+    if (size > 0) [[likely]]
+    {
+        cache->hits.store(cache->hits.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+    else
+    {
+        /// Refill half of the cache, the other half is left for buffers released by this thread.
+        cache->misses.store(cache->misses.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        const auto localPool = getLocalPoolIndex();
+        const auto refillSize = std::max<size_t>(threadLocalCacheCapacity / 2, 1);
+        detail::MemorySegment* memSegment = nullptr;
+        while (size < refillSize && (memSegment = tryReadAnyPool(localPool)) != nullptr)
+        {
+            cache->segments[size++] = memSegment;
+        }
+        if (size == 0)
+        {
+            return nullptr;
+        }
+    }
+
+    auto* memSegment = cache->segments[--size];
+    cache->size.store(size, std::memory_order_relaxed);
+    return memSegment;
+}
+
+void BufferManager::drainThreadLocalCache(ThreadLocalCache& cache)
+{
+    const auto size = cache.size.load(std::memory_order_relaxed);
+    const auto remaining = size / 2;
+    for (size_t i = remaining; i < size; ++i)
+    {
+        USED_IN_DEBUG const auto couldRecycleBuffer
+            = pools[getHomePoolIndex(cache.segments[i])].availableBuffers.writeIfNotFull(cache.segments[i]);
+        INVARIANT(couldRecycleBuffer, "should always succeed");
+    }
+    cache.size.store(remaining, std::memory_order_relaxed);
+}
 
-    INVARIANT(basePointer, "memory allocation failed, because 'basePointer' was a nullptr");
-    uint8_t* ptr = basePointer;
-    for (size_t i = 0; i < numOfBuffers; ++i)
+void BufferManager::releaseThreadLocalCache(const std::thread::id threadId)
+{
+    const std::scoped_lock lock(threadLocalCachesMutex);
+    const auto cache = threadLocalCaches.find(threadId);
+    if (cache == threadLocalCaches.end())
+    {
+        return;
+    }
+    for (size_t i = 0; i < cache->second->size.load(std::memory_order_relaxed); ++i)
+    {
+        USED_IN_DEBUG const auto couldRecycleBuffer
+            = pools[getHomePoolIndex(cache->second->segments[i])].availableBuffers.writeIfNotFull(cache->second->segments[i]);
+        INVARIANT(couldRecycleBuffer, "should always succeed");
+    }
+    threadLocalCaches.erase(cache);
+}
+
+void BufferManager::enableSizeClasses(const std::span<const size_t> sizeClasses, const size_t numberOfBuffersPerSizeClass)
+{
+    PRECONDITION(this->sizeClasses.empty(), "Size classes were already enabled");
+    PRECONDITION(!sizeClasses.empty(), "Requires at least one size class");
+    PRECONDITION(numberOfBuffersPerSizeClass > 0, "Requires at least one buffer per size class");
+    PRECONDITION(
+        std::ranges::adjacent_find(sizeClasses, std::ranges::greater_equal{}) == sizeClasses.end(),
+        "Size classes must be strictly ascending");
+
+    const auto controlBlockSize = alignBufferSize(sizeof(detail::BufferControlBlock), DEFAULT_ALIGNMENT);
+    this->sizeClasses.reserve(sizeClasses.size());
+    for (const auto bufferSize : sizeClasses)
+    {
+        auto& sizeClass = this->sizeClasses.emplace_back(alignBufferSize(bufferSize, DEFAULT_ALIGNMENT), numberOfBuffersPerSizeClass);
+        const size_t offsetBetweenBuffers = controlBlockSize + sizeClass.bufferSize;
+        sizeClass.allocatedAreaSize = offsetBetweenBuffers * numberOfBuffersPerSizeClass;
+        sizeClass.basePointer = static_cast<uint8_t*>(memoryResource->allocate(sizeClass.allocatedAreaSize, DEFAULT_ALIGNMENT));
+        INVARIANT(sizeClass.basePointer, "memory allocation failed, because 'basePointer' was a nullptr");
+
+        /// The buffers return via recyclePooledBuffer(), which finds their size class by their address
+        sizeClass.segments.reserve(numberOfBuffersPerSizeClass);
+        uint8_t* ptr = sizeClass.basePointer;
+        for (size_t i = 0; i < numberOfBuffersPerSizeClass; ++i)
+        {
+            sizeClass.segments.emplace_back(
+                ptr + controlBlockSize,
+                sizeClass.bufferSize,
+                [](detail::MemorySegment* segment, BufferRecycler* recycler) { recycler->recyclePooledBuffer(segment); },
+                ptr);
+            sizeClass.availableBuffers.write(&sizeClass.segments.back());
+            ptr += offsetBetweenBuffers;
+        }
+    }
+    NES_DEBUG("Enabled {} size classes with {} buffers each", sizeClasses.size(), numberOfBuffersPerSizeClass);
+}
+
+size_t BufferManager::getNumberOfAvailableSizeClassBuffers(const size_t sizeClass) const
+{
+    const auto found = std::ranges::find(sizeClasses, alignBufferSize(sizeClass, DEFAULT_ALIGNMENT), &SizeClass::bufferSize);
+    if (found == sizeClasses.end())
     {
-        uint8_t* controlBlock = ptr;
-        uint8_t* payload = ptr + controlBlockSize;
-        allBuffers.emplace_back(
-            payload,
-            bufferSize,
-            [](detail::MemorySegment* segment, BufferRecycler* recycler) { recycler->recyclePooledBuffer(segment); },
-            controlBlock);
+        return 0;
+    }
+    return static_cast<size_t>(std::max(found->availableBuffers.size(), static_cast<ssize_t>(0)));
+}
+
+BufferManager::SizeClass* BufferManager::getSizeClass(const detail::MemorySegment* segment)
+{
+    if (sizeClasses.empty() || (segment >= allBuffers.data() && segment < allBuffers.data() + allBuffers.size()))
+    {
+        return nullptr;
+    }
+    for (auto& sizeClass : sizeClasses)
+    {
+        if (segment >= sizeClass.segments.data() && segment < sizeClass.segments.data() + sizeClass.segments.size())
+        {
+            return &sizeClass;
+        }
+    }
+    return nullptr;
+}
 
-        availableBuffers.write(&allBuffers.back());
-        ptr += offsetBetweenBuffers;
+size_t BufferManager::getMemorySegmentSize(const TupleBuffer& buffer)
+{
+    return buffer.getControlBlock()->getOwner()->getSize();
+}
+
+std::optional<BufferManager::ThreadLocalCacheStatistics> BufferManager::getThreadLocalCacheStatistics()
+{
+    const auto* cache = getThreadLocalCache();
+    if (cache == nullptr)
+    {
+        return std::nullopt;
     }
-    NES_DEBUG("BufferManager configuration bufferSize={} numOfBuffers={}", this->bufferSize, this->numOfBuffers);
+    return ThreadLocalCacheStatistics{
+        .hits = cache->hits.load(std::memory_order_relaxed), .misses = cache->misses.load(std::memory_order_relaxed)};
 }
 
 TupleBuffer BufferManager::getBufferBlocking()
@@ -173,12 +610,21 @@ TupleBuffer BufferManager::getBufferBlocking()
 
 std::optional<TupleBuffer> BufferManager::getBufferNoBlocking()
 {
-    detail::MemorySegment* memSegment = nullptr;
-    if (!availableBuffers.read(memSegment))
+    return getBufferNoBlocking(shared_from_this());
+}
+
+std::optional<TupleBuffer> BufferManager::getBufferNoBlocking(const std::shared_ptr<BufferRecycler>& recycler)
+{
+    detail::MemorySegment* memSegment = tryReadThreadLocalCache();
+    if (memSegment == nullptr)
+    {
+        memSegment = tryReadAnyPool(getLocalPoolIndex());
+    }
+    if (memSegment == nullptr)
     {
         return std::nullopt;
     }
-    if (memSegment->controlBlock->prepare(shared_from_this()))
+    if (memSegment->controlBlock->prepare(recycler))
     {
         return TupleBuffer(memSegment->controlBlock.get(), memSegment->ptr, memSegment->size);
     }
@@ -187,13 +633,39 @@ std::optional<TupleBuffer> BufferManager::getBufferNoBlocking()
 
 std::optional<TupleBuffer> BufferManager::getBufferWithTimeout(const std::chrono::milliseconds timeoutMs)
 {
-    detail::MemorySegment* memSegment = nullptr;
+    return getBufferWithTimeout(timeoutMs, shared_from_this());
+}
+
+std::optional<TupleBuffer>
+BufferManager::getBufferWithTimeout(const std::chrono::milliseconds timeoutMs, const std::shared_ptr<BufferRecycler>& recycler)
+{
+    detail::MemorySegment* memSegment = tryReadThreadLocalCache();
     const auto deadline = std::chrono::steady_clock::now() + timeoutMs;
-    if (!availableBuffers.tryReadUntil(deadline, memSegment))
+    const auto localPool = getLocalPoolIndex();
+    if (memSegment == nullptr && pools.size() == 1)
     {
-        return std::nullopt;
+        if (!pools[localPool].availableBuffers.tryReadUntil(deadline, memSegment))
+        {
+            return std::nullopt;
+        }
+    }
+    else if (memSegment == nullptr)
+    {
+        /// Wait on the local pool, but periodically check if a remote pool has available buffers.
+        while ((memSegment = tryReadAnyPool(localPool)) == nullptr)
+        {
+            const auto now = std::chrono::steady_clock::now();
+            if (now >= deadline)
+            {
+                return std::nullopt;
+            }
+            if (pools[localPool].availableBuffers.tryReadUntil(std::min(deadline, now + REMOTE_POOL_POLL_INTERVAL), memSegment))
+            {
+                break;
+            }
+        }
     }
-    if (memSegment->controlBlock->prepare(shared_from_this()))
+    if (memSegment->controlBlock->prepare(recycler))
     {
         return TupleBuffer(memSegment->controlBlock.get(), memSegment->ptr, memSegment->size);
     }
@@ -202,7 +674,25 @@ std::optional<TupleBuffer> BufferManager::getBufferWithTimeout(const std::chrono
 
 std::optional<TupleBuffer> BufferManager::getUnpooledBuffer(const size_t bufferSize)
 {
-    return unpooledChunksManager->getUnpooledBuffer(bufferSize, DEFAULT_ALIGNMENT, shared_from_this());
+    return getUnpooledBuffer(bufferSize, shared_from_this());
+}
+
+std::optional<TupleBuffer> BufferManager::getUnpooledBuffer(const size_t bufferSize, const std::shared_ptr<BufferRecycler>& recycler)
+{
+    /// Only the smallest fitting size class serves the request, as larger ones would waste their memory on a small buffer
+    if (const auto sizeClass = std::ranges::lower_bound(sizeClasses, bufferSize, {}, &SizeClass::bufferSize);
+        sizeClass != sizeClasses.end())
+    {
+        if (detail::MemorySegment* memSegment = nullptr; sizeClass->availableBuffers.read(memSegment))
+        {
+            if (memSegment->controlBlock->prepare(recycler))
+            {
+                return TupleBuffer(memSegment->controlBlock.get(), memSegment->ptr, bufferSize);
+            }
+            throw InvalidRefCountForBuffer("[BufferManager] got buffer with invalid reference counter");
+        }
+    }
+    return unpooledChunksManager->getUnpooledBuffer(bufferSize, DEFAULT_ALIGNMENT, recycler);
 }
 
 void BufferManager::recyclePooledBuffer(detail::MemorySegment* segment)
@@ -210,13 +700,30 @@ void BufferManager::recyclePooledBuffer(detail::MemorySegment* segment)
     INVARIANT(segment->isAvailable(), "Recycling buffer callback invoked on used memory segment");
     INVARIANT(
         segment->controlBlock->owningBufferRecycler == nullptr, "Buffer should not retain a reference to its parent while not in use");
-    USED_IN_DEBUG const auto couldRecycleBuffer = availableBuffers.writeIfNotFull(segment);
+    if (auto* sizeClass = getSizeClass(segment))
+    {
+        USED_IN_DEBUG const auto couldRecycleBuffer = sizeClass->availableBuffers.writeIfNotFull(segment);
+        INVARIANT(couldRecycleBuffer, "should always succeed");
+        return;
+    }
+    if (auto* cache = getThreadLocalCache())
+    {
+        if (cache->size.load(std::memory_order_relaxed) == threadLocalCacheCapacity)
+        {
+            drainThreadLocalCache(*cache);
+        }
+        const auto size = cache->size.load(std::memory_order_relaxed);
+        cache->segments[size] = segment;
+        cache->size.store(size + 1, std::memory_order_relaxed);
+        return;
+    }
+    USED_IN_DEBUG const auto couldRecycleBuffer = pools[getHomePoolIndex(segment)].availableBuffers.writeIfNotFull(segment);
     INVARIANT(couldRecycleBuffer, "should always succeed");
 }
 
 void BufferManager::recycleUnpooledBuffer(detail::MemorySegment*, const AllocationThreadInfo&)
 {
-    INVARIANT(false, "This method should not be called!");
+    /// Nothing to do, the UnpooledChunksManager deallocates the memory of the unpooled buffer
 }
 
 size_t BufferManager::getBufferSize() const
@@ -234,10 +741,25 @@ size_t BufferManager::getNumOfUnpooledBuffers() const
     return unpooledChunksManager->getNumberOfUnpooledBuffers();
 }
 
+size_t BufferManager::getNumberOfUnpooledBytes() const
+{
+    return unpooledChunksManager->getNumberOfAllocatedBytes();
+}
+
 size_t BufferManager::getNumberOfAvailableBuffers() const
 {
     /// If there are pending reads the queue may report negative values. This effectivly means its empty.
-    return static_cast<size_t>(std::max(availableBuffers.size(), static_cast<ssize_t>(0)));
+    size_t numberOfAvailableBuffers = 0;
+    for (const auto& pool : pools)
+    {
+        numberOfAvailableBuffers += static_cast<size_t>(std::max(pool.availableBuffers.size(), static_cast<ssize_t>(0)));
+    }
+    const std::scoped_lock lock(threadLocalCachesMutex);
+    for (const auto& [threadId, cache] : threadLocalCaches)
+    {
+        numberOfAvailableBuffers += cache->size.load(std::memory_order_relaxed);
+    }
+    return numberOfAvailableBuffers;
 }
 
 BufferManagerType BufferManager::getBufferManagerType() const
@@ -0,0 +1,93 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Runtime/BufferOwnership.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <vector>
+#include <folly/Synchronized.h>
+
+namespace NES
+{
+
+namespace
+{
+thread_local BufferOwner currentOwner;
+thread_local BufferOwner cachedOwner;
+thread_local BufferOwnership::Counters* cachedCounters = nullptr;
+
+folly::Synchronized<std::map<BufferOwner, std::unique_ptr<BufferOwnership::Counters>>>& getCountersOfAllOwners()
+{
+    static folly::Synchronized<std::map<BufferOwner, std::unique_ptr<BufferOwnership::Counters>>> countersOfAllOwners;
+    return countersOfAllOwners;
+}
+}
+
+std::atomic<bool> BufferOwnership::enabled{false};
+
+BufferOwnership::Scope::Scope(const BufferOwner owner) : previousOwner(currentOwner)
+{
+    currentOwner = owner;
+}
+
+BufferOwnership::Scope::~Scope()
+{
+    currentOwner = previousOwner;
+}
+
+void BufferOwnership::enable()
+{
+    enabled.store(true, std::memory_order_relaxed);
+}
+
+BufferOwnership::Counters* BufferOwnership::getCountersOfCurrentOwner()
+{
+    /// A worker thread acquires most buffers of a task on behalf of the same owner, so that the lookup rarely locks the registry
+    if (cachedCounters == nullptr or cachedOwner != currentOwner)
+    {
+        auto countersOfAllOwners = getCountersOfAllOwners().wlock();
+        auto& counters = (*countersOfAllOwners)[currentOwner];
+        if (not counters)
+        {
+            counters = std::make_unique<Counters>();
+        }
+        cachedOwner = currentOwner;
+        cachedCounters = counters.get();
+    }
+    return cachedCounters;
+}
+
+std::vector<BufferOwnership::Usage> BufferOwnership::getUsage()
+{
+    std::vector<Usage> usage;
+    const auto countersOfAllOwners = getCountersOfAllOwners().rlock();
+    for (const auto& [owner, counters] : *countersOfAllOwners)
+    {
+        const auto numberOfBuffers = counters->numberOfBuffers.load(std::memory_order_relaxed);
+        const auto numberOfBytes = counters->numberOfBytes.load(std::memory_order_relaxed);
+        if (numberOfBuffers > 0)
+        {
+            usage.push_back(
+                {.owner = owner,
+                 .numberOfBuffers = static_cast<size_t>(numberOfBuffers),
+                 .numberOfBytes = static_cast<size_t>(numberOfBytes)});
+        }
+    }
+    return usage;
+}
+
+}
@@ -0,0 +1,93 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Runtime/ColumnarLayout.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <vector>
+#include <DataTypes/Schema.hpp>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+namespace
+{
+constexpr uint64_t VALIDITY_WORD_SIZE = sizeof(uint64_t);
+
+uint64_t getValidityBitmapSize(const uint64_t capacity)
+{
+    return ((capacity + ColumnarLayout::BITS_PER_VALIDITY_WORD - 1) / ColumnarLayout::BITS_PER_VALIDITY_WORD) * VALIDITY_WORD_SIZE;
+}
+
+/// The bitmaps follow the values and start at a word boundary
+uint64_t getValidityBitmapsOffset(const uint64_t capacity, const uint64_t valuesSize)
+{
+    return ((capacity * valuesSize + VALIDITY_WORD_SIZE - 1) / VALIDITY_WORD_SIZE) * VALIDITY_WORD_SIZE;
+}
+
+uint64_t getRequiredSize(const uint64_t capacity, const uint64_t valuesSize, const uint64_t numberOfNullableColumns)
+{
+    return getValidityBitmapsOffset(capacity, valuesSize) + (numberOfNullableColumns * getValidityBitmapSize(capacity));
+}
+}
+
+ColumnarLayout ColumnarLayout::create(const Schema& schema, const uint64_t bufferSize)
+{
+    PRECONDITION(schema.hasFields(), "A columnar layout requires a non-empty schema");
+    uint64_t valuesSize = 0;
+    uint64_t numberOfNullableColumns = 0;
+    for (const auto& field : schema)
+    {
+        valuesSize += field.dataType.getSizeInBytesWithoutNull();
+        numberOfNullableColumns += field.dataType.nullable ? 1 : 0;
+    }
+    INVARIANT(valuesSize > 0, "Tuplesize must be larger than 0B");
+
+    /// Every tuple requires its values and one bit per nullable column. The padding of the bitmaps only costs a few tuples.
+    auto capacity = (bufferSize * 8) / ((valuesSize * 8) + numberOfNullableColumns);
+    while (capacity > 0 and getRequiredSize(capacity, valuesSize, numberOfNullableColumns) > bufferSize)
+    {
+        --capacity;
+    }
+
+    ColumnarLayout layout{.capacity = capacity, .columns = {}};
+    layout.columns.reserve(schema.getNumberOfFields());
+    uint64_t valueOffset = 0;
+    auto validityOffset = getValidityBitmapsOffset(capacity, valuesSize);
+    for (const auto& field : schema)
+    {
+        Column column{.valueOffset = valueOffset, .valueSize = field.dataType.getSizeInBytesWithoutNull(), .validityOffset = std::nullopt};
+        valueOffset += column.valueSize * capacity;
+        if (field.dataType.nullable)
+        {
+            column.validityOffset = validityOffset;
+            validityOffset += getValidityBitmapSize(capacity);
+        }
+        layout.columns.push_back(column);
+    }
+    return layout;
+}
+
+bool ColumnarLayout::isValid(const std::byte* validityBitmap, const uint64_t tupleIndex)
+{
+    uint64_t word = 0;
+    std::memcpy(&word, validityBitmap + ((tupleIndex / BITS_PER_VALIDITY_WORD) * VALIDITY_WORD_SIZE), sizeof(word));
+    return ((word >> (tupleIndex % BITS_PER_VALIDITY_WORD)) & 1U) != 0;
+}
+
+}
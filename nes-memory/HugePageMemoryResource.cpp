@@ -0,0 +1,144 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+#include <Runtime/Allocator/HugePageMemoryResource.hpp>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <utility>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <Util/Logger/Logger.hpp>
+#include <magic_enum/magic_enum.hpp>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+namespace
+{
+/// Values of the linux kernel to select the size of explicit huge pages, see `man 2 mmap`. We define them here, as not all libc
+/// versions expose them.
+constexpr int HUGE_PAGE_SIZE_SHIFT = 26;
+constexpr int MAP_HUGE_2MB_FLAG = 21 << HUGE_PAGE_SIZE_SHIFT;
+constexpr int MAP_HUGE_1GB_FLAG = 30 << HUGE_PAGE_SIZE_SHIFT;
+constexpr size_t HUGE_PAGE_SIZE_2MB = 2UL * 1024 * 1024;
+constexpr size_t HUGE_PAGE_SIZE_1GB = 1024UL * 1024 * 1024;
+}
+
+HugePageMemoryResource::HugePageMemoryResource(const HugePageMode mode) : mode(mode)
+{
+}
+
+size_t HugePageMemoryResource::getPageSize(const HugePageMode mode)
+{
+    switch (mode)
+    {
+        case HugePageMode::NONE:
+            return static_cast<size_t>(sysconf(_SC_PAGE_SIZE));
+        case HugePageMode::TRANSPARENT:
+        case HugePageMode::EXPLICIT_2MB:
+            return HUGE_PAGE_SIZE_2MB;
+        case HugePageMode::EXPLICIT_1GB:
+            return HUGE_PAGE_SIZE_1GB;
+    }
+    std::unreachable();
+}
+
+HugePageMode HugePageMemoryResource::getModeForAllocation(const size_t bytes, const HugePageMode mode)
+{
+    if (bytes < HUGE_PAGE_SIZE_2MB)
+    {
+        return HugePageMode::NONE;
+    }
+    if (mode == HugePageMode::EXPLICIT_1GB && bytes < HUGE_PAGE_SIZE_1GB)
+    {
+        return HugePageMode::EXPLICIT_2MB;
+    }
+    return mode;
+}
+
+size_t HugePageMemoryResource::getMappedSize(const size_t bytes, const HugePageMode mode)
+{
+    const auto pageSize = getPageSize(getModeForAllocation(bytes, mode));
+    return (bytes + pageSize - 1) / pageSize * pageSize;
+}
+
+void* HugePageMemoryResource::mapMemory(const size_t bytes, const HugePageMode mode)
+{
+    if (mode == HugePageMode::EXPLICIT_2MB || mode == HugePageMode::EXPLICIT_1GB)
+    {
+        const int pageSizeFlag = mode == HugePageMode::EXPLICIT_2MB ? MAP_HUGE_2MB_FLAG : MAP_HUGE_1GB_FLAG;
+        void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | pageSizeFlag, -1, 0);
+        if (memory != MAP_FAILED)
+        {
+            return memory;
+        }
+        static std::once_flag explicitHugePagesUnavailable;
+        std::call_once(
+            explicitHugePagesUnavailable,
+            [&]
+            {
+                NES_WARNING(
+                    "Could not map {} bytes of {} huge pages: {}. Falling back to transparent huge pages. Reserve huge pages via "
+                    "/proc/sys/vm/nr_hugepages to use explicit huge pages.",
+                    bytes,
+                    magic_enum::enum_name(mode),
+                    std::strerror(errno));
+            });
+    }
+
+    void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    INVARIANT(memory != MAP_FAILED, "memory allocation of {} bytes failed: {}", bytes, std::strerror(errno));
+    if (mode != HugePageMode::NONE && madvise(memory, bytes, MADV_HUGEPAGE) != 0)
+    {
+        static std::once_flag transparentHugePagesUnavailable;
+        std::call_once(
+            transparentHugePagesUnavailable,
+            [&] { NES_WARNING("Transparent huge pages are not available: {}. Using regular pages.", std::strerror(errno)); });
+    }
+    return memory;
+}
+
+void* HugePageMemoryResource::do_allocate(const size_t bytes, const size_t alignment)
+{
+    const auto allocationMode = getModeForAllocation(bytes, mode);
+    if (allocationMode == HugePageMode::NONE)
+    {
+        void* tmp = nullptr;
+        auto ret = posix_memalign(&tmp, alignment, bytes);
+        INVARIANT(ret == 0, "memory allocation failed with alignment");
+        return tmp;
+    }
+
+    PRECONDITION(
+        alignment <= static_cast<size_t>(sysconf(_SC_PAGE_SIZE)),
+        "HugePageMemoryResource only supports alignments up to the page size, but got {}",
+        alignment);
+    return mapMemory(getMappedSize(bytes, mode), allocationMode);
+}
+
+void HugePageMemoryResource::do_deallocate(void* p, const size_t bytes, size_t)
+{
+    if (getModeForAllocation(bytes, mode) == HugePageMode::NONE)
+    {
+        std::free(p); /// NOLINT(cppcoreguidelines-no-malloc,cppcoreguidelines-owning-memory) - matching posix_memalign allocation
+        return;
+    }
+    munmap(p, getMappedSize(bytes, mode));
+}
+
+}
@@ -0,0 +1,128 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+#include <Runtime/Allocator/NumaMemoryResource.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <Runtime/Allocator/HugePageMemoryResource.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Strings.hpp>
+#include <fmt/format.h>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+namespace
+{
+/// Values of the linux kernel memory policies. We issue the mbind syscall directly to not depend on libnuma.
+/// MPOL_PREFERRED places pages on the requested node, but falls back to other nodes if the requested node is out of memory.
+constexpr int MPOL_PREFERRED_POLICY = 1;
+constexpr auto NUMA_NODE_SYSFS_PATH = "/sys/devices/system/node";
+
+std::string readFile(const std::string& path)
+{
+    std::ifstream file(path);
+    std::string content;
+    std::getline(file, content);
+    return content;
+}
+
+/// Reads a linux cpu/node list from sysfs. Lists that can not be read or parsed contain no ids.
+std::vector<size_t> readIdList(const std::string& path)
+{
+    return parseIdList(readFile(path)).value_or(std::vector<size_t>{});
+}
+
+/// Maps every cpu to the NUMA node it belongs to. Cpus which are not listed by the kernel are mapped to node 0.
+std::vector<size_t> createCpuToNumaNodeMapping()
+{
+    std::vector<size_t> cpuToNode(std::max<long>(sysconf(_SC_NPROCESSORS_CONF), 1), 0);
+    for (const auto node : readIdList(fmt::format("{}/online", NUMA_NODE_SYSFS_PATH)))
+    {
+        for (const auto cpu : readIdList(fmt::format("{}/node{}/cpulist", NUMA_NODE_SYSFS_PATH, node)))
+        {
+            if (cpu >= cpuToNode.size())
+            {
+                cpuToNode.resize(cpu + 1, 0);
+            }
+            cpuToNode[cpu] = node;
+        }
+    }
+    return cpuToNode;
+}
+}
+
+NumaMemoryResource::NumaMemoryResource(const size_t numaNode, const HugePageMode hugePageMode)
+    : numaNode(numaNode), hugePageMode(hugePageMode)
+{
+}
+
+size_t NumaMemoryResource::getNumberOfNumaNodes()
+{
+    static const size_t numberOfNodes = []
+    {
+        const auto nodes = readIdList(fmt::format("{}/online", NUMA_NODE_SYSFS_PATH));
+        return nodes.empty() ? 1 : *std::ranges::max_element(nodes) + 1;
+    }();
+    return numberOfNodes;
+}
+
+size_t NumaMemoryResource::getNumaNodeOfCurrentThread()
+{
+    static const std::vector<size_t> cpuToNode = createCpuToNumaNodeMapping();
+    const auto cpu = sched_getcpu();
+    if (cpu < 0 || static_cast<size_t>(cpu) >= cpuToNode.size())
+    {
+        return 0;
+    }
+    return cpuToNode[cpu];
+}
+
+void* NumaMemoryResource::do_allocate(const size_t bytes, const size_t alignment)
+{
+    const auto pageSize = static_cast<size_t>(sysconf(_SC_PAGE_SIZE));
+    PRECONDITION(alignment <= pageSize, "NumaMemoryResource only supports alignments up to the page size, but got {}", alignment);
+
+    const auto mappedBytes = HugePageMemoryResource::getMappedSize(bytes, hugePageMode);
+    void* memory = HugePageMemoryResource::mapMemory(mappedBytes, HugePageMemoryResource::getModeForAllocation(bytes, hugePageMode));
+
+    /// The memory is not touched yet, thus binding it before first use ensures that all pages are faulted in on the requested node.
+    constexpr size_t bitsPerMaskEntry = sizeof(unsigned long) * 8;
+    std::vector<unsigned long> nodeMask((numaNode / bitsPerMaskEntry) + 1, 0);
+    nodeMask[numaNode / bitsPerMaskEntry] = 1UL << (numaNode % bitsPerMaskEntry);
+    /// NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg) syscall is the only way to issue mbind without libnuma
+    if (syscall(SYS_mbind, memory, mappedBytes, MPOL_PREFERRED_POLICY, nodeMask.data(), (nodeMask.size() * bitsPerMaskEntry) + 1, 0) != 0)
+    {
+        NES_WARNING(
+            "Could not bind {} bytes to NUMA node {}: {}. Memory placement is left to the OS.", bytes, numaNode, std::strerror(errno));
+    }
+    return memory;
+}
+
+void NumaMemoryResource::do_deallocate(void* p, const size_t bytes, size_t)
+{
+    munmap(p, HugePageMemoryResource::getMappedSize(bytes, hugePageMode));
+}
+
+}
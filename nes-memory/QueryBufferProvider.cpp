@@ -0,0 +1,158 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Runtime/QueryBufferProvider.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/BufferManager.hpp>
+#include <Runtime/BufferRecycler.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <ErrorHandling.hpp>
+#include <TupleBufferImpl.hpp>
+
+namespace NES
+{
+
+QueryBufferProvider::QueryBufferProvider(
+    Private, std::shared_ptr<BufferManager> bufferManager, const size_t quotaInBytes, QuotaListener quotaListener)
+    : bufferManager(std::move(bufferManager)), quotaInBytes(quotaInBytes), quotaListener(std::move(quotaListener))
+{
+    PRECONDITION(this->bufferManager != nullptr, "The QueryBufferProvider requires a BufferManager");
+    PRECONDITION(quotaInBytes > 0, "The memory quota of a query must be larger than 0");
+}
+
+std::shared_ptr<QueryBufferProvider>
+QueryBufferProvider::create(std::shared_ptr<BufferManager> bufferManager, const size_t quotaInBytes, QuotaListener quotaListener)
+{
+    return std::make_shared<QueryBufferProvider>(Private{}, std::move(bufferManager), quotaInBytes, std::move(quotaListener));
+}
+
+BufferManagerType QueryBufferProvider::getBufferManagerType() const
+{
+    return bufferManager->getBufferManagerType();
+}
+
+size_t QueryBufferProvider::getBufferSize() const
+{
+    return bufferManager->getBufferSize();
+}
+
+size_t QueryBufferProvider::getNumOfPooledBuffers() const
+{
+    return bufferManager->getNumOfPooledBuffers();
+}
+
+size_t QueryBufferProvider::getNumOfUnpooledBuffers() const
+{
+    return bufferManager->getNumOfUnpooledBuffers();
+}
+
+TupleBuffer QueryBufferProvider::getBufferBlocking()
+{
+    auto buffer = getBufferWithTimeout(GET_BUFFER_TIMEOUT);
+    if (buffer.has_value())
+    {
+        return buffer.value();
+    }
+    throw BufferAllocationFailure("Global buffer pool could not allocate buffer before timeout({})", GET_BUFFER_TIMEOUT);
+}
+
+std::optional<TupleBuffer> QueryBufferProvider::getBufferNoBlocking()
+{
+    return account(bufferManager->getBufferNoBlocking(shared_from_this()), bufferManager->getBufferSize());
+}
+
+std::optional<TupleBuffer> QueryBufferProvider::getBufferWithTimeout(const std::chrono::milliseconds timeoutMs)
+{
+    return account(bufferManager->getBufferWithTimeout(timeoutMs, shared_from_this()), bufferManager->getBufferSize());
+}
+
+std::optional<TupleBuffer> QueryBufferProvider::getUnpooledBuffer(const size_t bufferSize)
+{
+    /// The memory segment of an unpooled buffer is rounded up to the alignment or its size class, which is the size we see once it is
+    /// recycled
+    auto buffer = bufferManager->getUnpooledBuffer(bufferSize, shared_from_this());
+    const auto bytes = buffer.has_value() ? BufferManager::getMemorySegmentSize(*buffer) : 0;
+    return account(std::move(buffer), bytes);
+}
+
+AbstractBufferProvider* QueryBufferProvider::getStateBufferProvider()
+{
+    return bufferManager.get();
+}
+
+void QueryBufferProvider::recyclePooledBuffer(detail::MemorySegment* segment)
+{
+    release(segment->getSize());
+    bufferManager->recyclePooledBuffer(segment);
+}
+
+void QueryBufferProvider::recycleUnpooledBuffer(detail::MemorySegment* segment, const AllocationThreadInfo&)
+{
+    release(segment->getSize());
+}
+
+size_t QueryBufferProvider::getNumberOfUsedBytes() const
+{
+    return usedBytes.load(std::memory_order_relaxed);
+}
+
+size_t QueryBufferProvider::getQuotaInBytes() const
+{
+    return quotaInBytes;
+}
+
+std::optional<TupleBuffer> QueryBufferProvider::account(std::optional<TupleBuffer> buffer, const size_t bytes)
+{
+    if (buffer.has_value())
+    {
+        const auto previouslyUsedBytes = usedBytes.fetch_add(bytes, std::memory_order_relaxed);
+        if (previouslyUsedBytes <= quotaInBytes && previouslyUsedBytes + bytes > quotaInBytes)
+        {
+            updateQuotaState();
+        }
+    }
+    return buffer;
+}
+
+void QueryBufferProvider::release(const size_t bytes)
+{
+    const auto previouslyUsedBytes = usedBytes.fetch_sub(bytes, std::memory_order_relaxed);
+    INVARIANT(previouslyUsedBytes >= bytes, "Released {} bytes, but the query only holds {} bytes", bytes, previouslyUsedBytes);
+    if (previouslyUsedBytes > quotaInBytes && previouslyUsedBytes - bytes <= quotaInBytes)
+    {
+        updateQuotaState();
+    }
+}
+
+void QueryBufferProvider::updateQuotaState()
+{
+    /// Only requests and releases that cross the quota update the state. Concurrent crossings may observe the usage in any order, but
+    /// the last one to acquire the lock observes the final usage. Thus, the state converges to the actual usage.
+    const std::scoped_lock lock(quotaStateMutex);
+    const bool exceeded = usedBytes.load(std::memory_order_relaxed) > quotaInBytes;
+    if (exceeded != quotaExceeded)
+    {
+        quotaExceeded = exceeded;
+        quotaListener(exceeded);
+    }
+}
+
+}
@@ -0,0 +1,173 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Runtime/Allocator/SpillFileMemoryResource.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <Util/Logger/Logger.hpp>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+namespace
+{
+/// Value of the linux kernel (since 5.4) to reclaim pages, see `man 2 madvise`. We define it here, as not all libc versions expose it.
+constexpr int MADVISE_PAGEOUT = 21;
+
+size_t getPageSize()
+{
+    return static_cast<size_t>(sysconf(_SC_PAGE_SIZE));
+}
+
+/// Creates a file of the given size in the directory that gets deleted once the last mapping of it is unmapped
+int createUnlinkedFile(const std::filesystem::path& directory, const size_t size)
+{
+    auto pathTemplate = (directory / "nes-spill-XXXXXX").string();
+    const int fileDescriptor = mkstemp(pathTemplate.data());
+    if (fileDescriptor == -1)
+    {
+        throw CannotAllocateBuffer("Could not create a spill file in {}: {}", directory.string(), std::strerror(errno));
+    }
+    unlink(pathTemplate.c_str());
+    if (ftruncate(fileDescriptor, static_cast<off_t>(size)) != 0)
+    {
+        const auto error = errno;
+        close(fileDescriptor);
+        throw CannotAllocateBuffer("Could not resize the spill file in {} to {} bytes: {}", directory.string(), size, std::strerror(error));
+    }
+    return fileDescriptor;
+}
+
+void spillMapping(void* address, const size_t mappedSize)
+{
+    if (madvise(address, mappedSize, MADVISE_PAGEOUT) == 0)
+    {
+        return;
+    }
+    /// Older kernels do not support MADV_PAGEOUT. Writing the pages to the file makes them clean, so that the kernel can drop them from
+    /// the page cache without any I/O, once they are no longer mapped into our address space.
+    static std::once_flag pageOutUnavailable;
+    std::call_once(
+        pageOutUnavailable, [] { NES_WARNING("MADV_PAGEOUT is not available: {}. Spilling via msync().", std::strerror(errno)); });
+    msync(address, mappedSize, MS_SYNC);
+    madvise(address, mappedSize, MADV_DONTNEED);
+}
+}
+
+SpillFileMemoryResource::SpillFileMemoryResource(std::filesystem::path spillDirectory, const size_t memoryBudgetInBytes)
+    : spillDirectory(std::move(spillDirectory)), memoryBudgetInBytes(memoryBudgetInBytes)
+{
+    PRECONDITION(memoryBudgetInBytes > 0, "The memory budget of a SpillFileMemoryResource must be greater than zero");
+    if (not std::filesystem::is_directory(this->spillDirectory))
+    {
+        throw InvalidConfigParameter("The spill directory {} does not exist", this->spillDirectory.string());
+    }
+}
+
+void* SpillFileMemoryResource::do_allocate(const size_t bytes, const size_t alignment)
+{
+    PRECONDITION(
+        alignment <= getPageSize(), "SpillFileMemoryResource only supports alignments up to the page size, but got {}", alignment);
+    const auto mappedSize = std::max((bytes + getPageSize() - 1) / getPageSize() * getPageSize(), getPageSize());
+
+    const int fileDescriptor = createUnlinkedFile(spillDirectory, mappedSize);
+    void* memory = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+    const auto error = errno;
+    /// The mapping keeps the file alive
+    close(fileDescriptor);
+    if (memory == MAP_FAILED)
+    {
+        throw CannotAllocateBuffer("Could not map a spill file of {} bytes: {}", mappedSize, std::strerror(error));
+    }
+
+    const std::scoped_lock lock(mutex);
+    mappings.emplace_back(Mapping{.address = memory, .mappedSize = mappedSize, .spilled = false});
+    allocatedBytes += mappedSize;
+    unspilledBytes += mappedSize;
+    if (unspilledBytes > memoryBudgetInBytes)
+    {
+        spillOldestMappings();
+    }
+    return memory;
+}
+
+void SpillFileMemoryResource::do_deallocate(void* p, const size_t, const size_t)
+{
+    const std::scoped_lock lock(mutex);
+    const auto mapping = std::ranges::find(mappings, p, &Mapping::address);
+    INVARIANT(mapping != mappings.end(), "Deallocating memory that has not been allocated by this SpillFileMemoryResource");
+    munmap(mapping->address, mapping->mappedSize);
+    allocatedBytes -= mapping->mappedSize;
+    if (not mapping->spilled)
+    {
+        unspilledBytes -= mapping->mappedSize;
+    }
+    mappings.erase(mapping);
+}
+
+void SpillFileMemoryResource::spillOldestMappings()
+{
+    for (auto& mapping : mappings)
+    {
+        if (unspilledBytes <= memoryBudgetInBytes / 2)
+        {
+            return;
+        }
+        if (mapping.spilled)
+        {
+            continue;
+        }
+        spillMapping(mapping.address, mapping.mappedSize);
+        mapping.spilled = true;
+        unspilledBytes -= mapping.mappedSize;
+        spilledBytes += mapping.mappedSize;
+        NES_DEBUG(
+            "Spilled {} bytes to {}, {} of {} bytes are not spilled",
+            mapping.mappedSize,
+            spillDirectory.string(),
+            unspilledBytes,
+            allocatedBytes);
+    }
+}
+
+size_t SpillFileMemoryResource::getAllocatedBytes() const
+{
+    const std::scoped_lock lock(mutex);
+    return allocatedBytes;
+}
+
+size_t SpillFileMemoryResource::getUnspilledBytes() const
+{
+    const std::scoped_lock lock(mutex);
+    return unspilledBytes;
+}
+
+size_t SpillFileMemoryResource::getSpilledBytes() const
+{
+    const std::scoped_lock lock(mutex);
+    return spilledBytes;
+}
+
+}
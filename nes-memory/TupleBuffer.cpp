@@ -169,6 +169,21 @@ void TupleBuffer::setCreationTimestampInMS(const Timestamp value) noexcept
     controlBlock->setCreationTimestamp(value);
 }
 
+Timestamp TupleBuffer::getMinIngestionTimestampInNS() const noexcept
+{
+    return controlBlock->getMinIngestionTimestamp();
+}
+
+Timestamp TupleBuffer::getMaxIngestionTimestampInNS() const noexcept
+{
+    return controlBlock->getMaxIngestionTimestamp();
+}
+
+void TupleBuffer::setIngestionTimestampsInNS(const Timestamp minIngestionTimestamp, const Timestamp maxIngestionTimestamp) noexcept
+{
+    controlBlock->setIngestionTimestamps(minIngestionTimestamp, maxIngestionTimestamp);
+}
+
 void TupleBuffer::setOriginId(const OriginId id) noexcept
 {
     controlBlock->setOriginId(id);
@@ -184,6 +199,15 @@ VariableSizedAccess::Index TupleBuffer::storeChildBuffer(TupleBuffer& buffer) no
     return index;
 }
 
+void TupleBuffer::replaceChildBuffer(const VariableSizedAccess::Index bufferIndex, TupleBuffer& buffer) noexcept
+{
+    TupleBuffer empty;
+    auto* control = buffer.controlBlock;
+    INVARIANT(controlBlock != control, "Cannot attach buffer to self");
+    controlBlock->replaceChildBuffer(bufferIndex, control);
+    std::swap(empty, buffer);
+}
+
 TupleBuffer TupleBuffer::loadChildBuffer(VariableSizedAccess::Index bufferIndex) const noexcept
 {
     TupleBuffer childBuffer;
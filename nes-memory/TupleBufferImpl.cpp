@@ -14,11 +14,13 @@
 
 #include <TupleBufferImpl.hpp>
 
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <utility>
 #include <Identifiers/Identifiers.hpp>
+#include <Runtime/BufferOwnership.hpp>
 #include <Runtime/TupleBuffer.hpp>
 #include <Time/Timestamp.hpp>
 #include <Util/Logger/Logger.hpp>
@@ -134,6 +136,12 @@ bool BufferControlBlock::prepare(const std::shared_ptr<BufferRecycler>& recycler
     {
         const auto previousOwner = std::exchange(this->owningBufferRecycler, recycler);
         INVARIANT(previousOwner == nullptr, "Buffer should not retain a reference to its owner while unused");
+        if (BufferOwnership::isEnabled())
+        {
+            ownerCounters = BufferOwnership::getCountersOfCurrentOwner();
+            ownerCounters->numberOfBuffers.fetch_add(1, std::memory_order_relaxed);
+            ownerCounters->numberOfBytes.fetch_add(owner->getSize(), std::memory_order_relaxed);
+        }
         return true;
     }
     NES_ERROR("Invalid reference counter: {}", expected);
@@ -189,7 +197,17 @@ bool BufferControlBlock::release()
         }
     }
 #endif
-    const uint32_t prevRefCnt = referenceCounter.fetch_sub(1);
+    /// The sole owner of a buffer does not race with other threads on the counter, since they would need a reference to retain it.
+    /// Thus, releasing the last reference skips the atomic read-modify-write, which saves it for every buffer that is not shared.
+    int32_t prevRefCnt = 1;
+    if (referenceCounter.load(std::memory_order::acquire) == 1)
+    {
+        referenceCounter.store(0, std::memory_order::relaxed);
+    }
+    else
+    {
+        prevRefCnt = referenceCounter.fetch_sub(1);
+    }
     if (prevRefCnt == 1)
     {
         for (auto&& child : children)
@@ -203,8 +221,17 @@ bool BufferControlBlock::release()
             owningThreads.clear();
         }
 #endif
+        if (auto* const counters = std::exchange(ownerCounters, nullptr))
+        {
+            counters->numberOfBuffers.fetch_sub(1, std::memory_order_relaxed);
+            counters->numberOfBytes.fetch_sub(owner->getSize(), std::memory_order_relaxed);
+        }
         const auto recycler = std::move(owningBufferRecycler);
         numberOfTuples = 0;
+        /// Unlike the other metadata, not every producer of a buffer sets the ingestion timestamps. Thus, a recycled buffer must not
+        /// report the ingestion timestamps of its previous use.
+        minIngestionTimestamp = Timestamp(Timestamp::INITIAL_VALUE);
+        maxIngestionTimestamp = Timestamp(Timestamp::INITIAL_VALUE);
         recycleCallback(owner, recycler.get());
         return true;
     }
@@ -289,6 +316,22 @@ Timestamp BufferControlBlock::getCreationTimestamp() const noexcept
     return creationTimestamp;
 }
 
+void BufferControlBlock::setIngestionTimestamps(const Timestamp minIngestionTimestamp, const Timestamp maxIngestionTimestamp)
+{
+    this->minIngestionTimestamp = minIngestionTimestamp;
+    this->maxIngestionTimestamp = maxIngestionTimestamp;
+}
+
+Timestamp BufferControlBlock::getMinIngestionTimestamp() const noexcept
+{
+    return minIngestionTimestamp;
+}
+
+Timestamp BufferControlBlock::getMaxIngestionTimestamp() const noexcept
+{
+    return maxIngestionTimestamp;
+}
+
 OriginId BufferControlBlock::getOriginId() const noexcept
 {
     return originId;
@@ -310,6 +353,13 @@ VariableSizedAccess::Index BufferControlBlock::storeChildBuffer(BufferControlBlo
     return VariableSizedAccess::Index{children.size() - 1};
 }
 
+void BufferControlBlock::replaceChildBuffer(const VariableSizedAccess::Index index, BufferControlBlock* control)
+{
+    PRECONDITION(index.index < children.size(), "Index={} is out of range={}", index, children.size());
+    control->retain();
+    std::exchange(children[index.index], control->owner)->controlBlock->release();
+}
+
 bool BufferControlBlock::loadChildBuffer(
     const VariableSizedAccess::Index index, BufferControlBlock*& control, uint8_t*& ptr, uint32_t& size) const
 {
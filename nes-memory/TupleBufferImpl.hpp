@@ -22,6 +22,7 @@
 #include <memory>
 #include <vector>
 #include <Identifiers/Identifiers.hpp>
+#include <Runtime/BufferOwnership.hpp>
 #include <Time/Timestamp.hpp>
 #include <include/Runtime/VariableSizedAccess.hpp>
 #include <TaggedPointer.hpp>
@@ -45,6 +46,7 @@ class LocalBufferPool;
 class TupleBuffer;
 class FixedSizeBufferPool;
 class BufferRecycler;
+class QueryBufferProvider;
 
 static constexpr auto GET_BUFFER_TIMEOUT = std::chrono::milliseconds(1000);
 
@@ -111,7 +113,11 @@ public:
     void setOriginId(OriginId originId);
     void setCreationTimestamp(Timestamp timestamp);
     [[nodiscard]] Timestamp getCreationTimestamp() const noexcept;
+    void setIngestionTimestamps(Timestamp minIngestionTimestamp, Timestamp maxIngestionTimestamp);
+    [[nodiscard]] Timestamp getMinIngestionTimestamp() const noexcept;
+    [[nodiscard]] Timestamp getMaxIngestionTimestamp() const noexcept;
     [[nodiscard]] VariableSizedAccess::Index storeChildBuffer(BufferControlBlock* control);
+    void replaceChildBuffer(VariableSizedAccess::Index index, BufferControlBlock* control);
     [[nodiscard]] bool loadChildBuffer(VariableSizedAccess::Index index, BufferControlBlock*& control, uint8_t*& ptr, uint32_t& size) const;
 
     [[nodiscard]] uint32_t getNumberOfChildBuffers() const noexcept { return children.size(); }
@@ -127,8 +133,12 @@ private:
     ChunkNumber chunkNumber = INVALID_CHUNK_NUMBER;
     bool lastChunk = true;
     Timestamp creationTimestamp = Timestamp(Timestamp::INITIAL_VALUE);
+    Timestamp minIngestionTimestamp = Timestamp(Timestamp::INITIAL_VALUE);
+    Timestamp maxIngestionTimestamp = Timestamp(Timestamp::INITIAL_VALUE);
     OriginId originId = INVALID_ORIGIN_ID;
     std::vector<MemorySegment*> children;
+    /// The owner that acquired the buffer, if the BufferOwnership is tracked
+    BufferOwnership::Counters* ownerCounters = nullptr;
 
 public:
     MemorySegment* owner;
@@ -186,6 +196,7 @@ class MemorySegment
     friend class NES::FixedSizeBufferPool;
     friend class NES::BufferManager;
     friend class NES::UnpooledChunksManager;
+    friend class NES::QueryBufferProvider;
     friend class BufferControlBlock;
 
     enum class MemorySegmentType : uint8_t
@@ -16,6 +16,7 @@
 #include <Runtime/UnpooledChunksManager.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -79,6 +80,11 @@ size_t UnpooledChunksManager::getNumberOfUnpooledBuffers() const
     return numOfUnpooledBuffers;
 }
 
+size_t UnpooledChunksManager::getNumberOfAllocatedBytes() const
+{
+    return numberOfAllocatedBytes->load(std::memory_order_relaxed);
+}
+
 std::pair<uint8_t*, uint8_t*>
 UnpooledChunksManager::allocateSpace(const std::thread::id threadId, const size_t neededSize, const size_t alignment)
 {
@@ -119,6 +125,7 @@ UnpooledChunksManager::allocateSpace(const std::thread::id threadId, const size_
         NES_WARNING("Could not allocate {} bytes for unpooled chunk!", newAllocationSize);
         return {};
     }
+    numberOfAllocatedBytes->fetch_add(newAllocationSize, std::memory_order_relaxed);
 
     /// Updating the local last allocate chunk key and adding the new chunk to the local chunk storage
     localLastAllocatedChunkKey = newlyAllocatedMemory;
@@ -155,8 +162,14 @@ UnpooledChunksManager::getUnpooledBuffer(const size_t neededSize, size_t alignme
         [copyOfMemoryResource = this->memoryResource,
          copyOLastChunkPtr = localKeyForUnpooledBufferChunk,
          copyOfChunk = chunk,
-         copyOfAlignment = alignment](detail::MemorySegment* memorySegment, BufferRecycler*)
+         copyOfAlignment = alignment,
+         copyOfNumberOfAllocatedBytes = numberOfAllocatedBytes,
+         threadId](detail::MemorySegment* memorySegment, BufferRecycler* recycler)
         {
+            if (recycler != nullptr)
+            {
+                recycler->recycleUnpooledBuffer(memorySegment, AllocationThreadInfo{threadId, copyOLastChunkPtr});
+            }
             auto lockedLocalUnpooledBufferData = copyOfChunk->wlock();
             auto& curUnpooledChunk = lockedLocalUnpooledBufferData->chunks[copyOLastChunkPtr];
             INVARIANT(
@@ -174,6 +187,7 @@ UnpooledChunksManager::getUnpooledBuffer(const size_t neededSize, size_t alignme
                 lockedLocalUnpooledBufferData.unlock();
                 copyOfMemoryResource->deallocate(
                     extractedChunkControlBlock.startOfChunk, extractedChunkControlBlock.totalSize, copyOfAlignment);
+                copyOfNumberOfAllocatedBytes->fetch_sub(extractedChunkControlBlock.totalSize, std::memory_order_relaxed);
             }
         });
 
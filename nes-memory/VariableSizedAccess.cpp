@@ -13,8 +13,12 @@
 */
 #include <Runtime/VariableSizedAccess.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <ostream>
+#include <span>
 #include <ErrorHandling.hpp>
 
 namespace NES
@@ -59,8 +63,9 @@ std::ostream& operator<<(std::ostream& os, const VariableSizedAccess::Offset& of
     return os << offset.offset;
 }
 
-VariableSizedAccess::Size::Size(uint64_t size) : size(size)
+VariableSizedAccess::Size::Size(const uint64_t size) : size(size)
 {
+    PRECONDITION(size <= std::numeric_limits<Underlying>::max(), "Variable sized data of {} bytes exceeds the maximum size", size);
 }
 
 VariableSizedAccess::Size::Underlying VariableSizedAccess::Size::getRawSize() const
@@ -68,5 +73,41 @@ VariableSizedAccess::Size::Underlying VariableSizedAccess::Size::getRawSize() co
     return size;
 }
 
+std::ostream& operator<<(std::ostream& os, const VariableSizedAccess::Size& size)
+{
+    return os << size.size;
+}
+
+VariableSizedAccess::VariableSizedAccess(const std::span<const std::byte> value) : VariableSizedAccess()
+{
+    PRECONDITION(value.size() <= INLINE_SIZE, "Cannot inline variable sized data of {} bytes", value.size());
+    size = Size{value.size()};
+    /// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast) the inlined value spans the prefix, the index and the offset
+    std::ranges::copy(value, reinterpret_cast<std::byte*>(this) + offsetof(VariableSizedAccess, prefix));
+}
+
+VariableSizedAccess::VariableSizedAccess(const Index index, const Offset offset, const std::span<const std::byte> value)
+    : size(value.size()), prefix{}, index(index), offset(offset)
+{
+    PRECONDITION(value.size() > INLINE_SIZE, "Variable sized data of {} bytes must be inlined", value.size());
+    std::ranges::copy(value.first<PREFIX_SIZE>(), prefix.begin());
+}
+
+std::span<const std::byte> VariableSizedAccess::getInlinedValue() const
+{
+    PRECONDITION(isInlined(), "Variable sized data of {} bytes is not inlined", size);
+    /// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast) the inlined value spans the prefix, the index and the offset
+    return {reinterpret_cast<const std::byte*>(this) + offsetof(VariableSizedAccess, prefix), size.getRawSize()};
+}
+
+VariableSizedAccess VariableSizedAccess::relocate(const Index newIndex, const Offset newOffset) const
+{
+    PRECONDITION(not isInlined(), "An inlined value is not stored in a child buffer");
+    auto relocated = *this;
+    relocated.index = newIndex;
+    relocated.offset = newOffset;
+    return relocated;
+}
+
 
 }
@@ -52,6 +52,10 @@ public:
 
     /// Returns an unpooled buffer of size bufferSize wrapped in an optional or an invalid option if an error
     virtual std::optional<TupleBuffer> getUnpooledBuffer(size_t bufferSize) = 0;
+
+    /// Returns the buffer provider for the state that operators pin until their windows or the query end, e.g., the slices of a window.
+    /// The state is only released once the query makes progress. Thus, providers that throttle the query must not account the state.
+    virtual AbstractBufferProvider* getStateBufferProvider() { return this; }
 };
 
 }
@@ -0,0 +1,75 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+
+namespace NES
+{
+
+/// Kind of pages that back the memory of the buffer pools.
+/// TRANSPARENT asks the kernel to back the memory with transparent huge pages (madvise(MADV_HUGEPAGE)).
+/// EXPLICIT_2MB and EXPLICIT_1GB map memory from the hugetlbfs pool, which needs to be reserved by the administrator beforehand.
+enum class HugePageMode : uint8_t
+{
+    NONE,
+    TRANSPARENT,
+    EXPLICIT_2MB,
+    EXPLICIT_1GB,
+};
+
+/**
+ * @brief Memory resource that backs large allocations with huge pages to reduce TLB misses, e.g., when probing hash maps that live
+ * in pooled buffers.
+ * Allocations smaller than a huge page would waste most of the huge page and are served via posix_memalign instead (see
+ * getModeForAllocation()).
+ * If explicit huge pages are not available (e.g. no huge pages are reserved), the resource falls back to transparent huge pages.
+ * If the kernel does not support transparent huge pages, the memory is backed by regular pages.
+ */
+class HugePageMemoryResource : public std::pmr::memory_resource
+{
+public:
+    explicit HugePageMemoryResource(HugePageMode mode);
+    ~HugePageMemoryResource() override = default;
+
+    [[nodiscard]] HugePageMode getMode() const { return mode; }
+
+    /// Returns the size of a single huge page of the given mode. For NONE this is the regular page size.
+    static size_t getPageSize(HugePageMode mode);
+
+    /// Returns the kind of pages that back an allocation of `bytes` in the given mode.
+    /// Allocations smaller than a huge page use the next smaller page size, as most of the huge page would be wasted otherwise.
+    static HugePageMode getModeForAllocation(size_t bytes, HugePageMode mode);
+
+    /// Returns the size of the mapping of an allocation of `bytes` in the given mode, i.e., `bytes` rounded up to whole pages.
+    static size_t getMappedSize(size_t bytes, HugePageMode mode);
+
+    /// Maps `bytes` of anonymous memory backed by huge pages of the given mode. `bytes` must be a multiple of getPageSize(mode).
+    /// Falls back to smaller pages if the requested kind of huge pages is not available.
+    static void* mapMemory(size_t bytes, HugePageMode mode);
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+
+    bool do_is_equal(const memory_resource& other) const noexcept override { return this == &other; }
+
+    HugePageMode mode;
+};
+}
@@ -0,0 +1,55 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <Runtime/Allocator/HugePageMemoryResource.hpp>
+
+namespace NES
+{
+/**
+ * @brief Memory resource that places all of its allocations on a single NUMA node.
+ * Memory is mapped via mmap and bound to the node via mbind. If the system does not support binding memory (e.g. it is not a NUMA
+ * system or the kernel was compiled without NUMA support), the memory is allocated without any placement policy.
+ * Allocations are page-granular, thus this resource should only be used for large allocations, e.g. buffer pools.
+ * Optionally, the memory is backed by huge pages (see HugePageMemoryResource).
+ */
+class NumaMemoryResource : public std::pmr::memory_resource
+{
+public:
+    explicit NumaMemoryResource(size_t numaNode, HugePageMode hugePageMode = HugePageMode::NONE);
+    ~NumaMemoryResource() override = default;
+
+    [[nodiscard]] size_t getNumaNode() const { return numaNode; }
+
+    /// Returns the number of NUMA nodes of the system. Returns 1 if the topology can not be determined.
+    static size_t getNumberOfNumaNodes();
+
+    /// Returns the NUMA node of the cpu the calling thread is currently running on. Returns 0 if the node can not be determined.
+    static size_t getNumaNodeOfCurrentThread();
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+
+    bool do_is_equal(const memory_resource& other) const noexcept override { return this == &other; }
+
+    size_t numaNode;
+    HugePageMode hugePageMode;
+};
+}
@@ -0,0 +1,81 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+namespace NES
+{
+
+/// Memory resource that backs every allocation with a shared memory mapping of an unlinked file in the spill directory, e.g., on a local
+/// SSD. As long as the memory budget suffices, the allocations behave like regular memory. Once the allocations that have not been
+/// spilled exceed the budget, the oldest allocations are spilled, i.e., their pages are written to their files and released via
+/// madvise(MADV_PAGEOUT). Spilled pages stay accessible under the same address and are paged back in by the kernel once they get
+/// accessed. Thus, data structures with pointers into their own memory, e.g., the chains of a hash map, can be spilled as a whole.
+/// Pages that got paged back in are backed by the files as well. Thus, the kernel can reclaim them at any time without swapping.
+/// We spill the oldest allocations first, as they approximate the coldest state, e.g., the slices of windows that are not triggered yet,
+/// while the youngest allocations usually serve the data structures that are currently being filled.
+class SpillFileMemoryResource : public std::pmr::memory_resource
+{
+public:
+    SpillFileMemoryResource(std::filesystem::path spillDirectory, size_t memoryBudgetInBytes);
+    ~SpillFileMemoryResource() override = default;
+
+    SpillFileMemoryResource(const SpillFileMemoryResource&) = delete;
+    SpillFileMemoryResource(SpillFileMemoryResource&&) = delete;
+    SpillFileMemoryResource& operator=(const SpillFileMemoryResource&) = delete;
+    SpillFileMemoryResource& operator=(SpillFileMemoryResource&&) = delete;
+
+    /// Returns the number of bytes of all allocations, i.e., of the spilled and not spilled ones
+    [[nodiscard]] size_t getAllocatedBytes() const;
+    /// Returns the number of bytes of all allocations that have not been spilled yet
+    [[nodiscard]] size_t getUnspilledBytes() const;
+    /// Returns the number of bytes that have been spilled so far, including allocations that have been deallocated since
+    [[nodiscard]] size_t getSpilledBytes() const;
+
+private:
+    struct Mapping
+    {
+        void* address;
+        size_t mappedSize;
+        bool spilled;
+    };
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+
+    bool do_is_equal(const memory_resource& other) const noexcept override { return this == &other; }
+
+    /// Spills the oldest not spilled mappings until the not spilled mappings require at most half of the budget.
+    /// Spilling down to half of the budget avoids that every subsequent allocation spills a mapping. Expects that the mutex is locked.
+    void spillOldestMappings();
+
+    std::filesystem::path spillDirectory;
+    size_t memoryBudgetInBytes;
+    mutable std::mutex mutex;
+    /// Mappings in the order of their allocation
+    std::vector<Mapping> mappings;
+    size_t allocatedBytes{0};
+    size_t unspilledBytes{0};
+    size_t spilledBytes{0};
+};
+
+}
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <deque>
@@ -21,8 +22,12 @@
 #include <memory_resource>
 #include <mutex>
 #include <optional>
+#include <span>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 #include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/Allocator/HugePageMemoryResource.hpp>
 #include <Runtime/Allocator/NesDefaultMemoryAllocator.hpp>
 #include <Runtime/BufferRecycler.hpp>
 #include <Runtime/UnpooledChunksManager.hpp>
@@ -50,6 +55,23 @@ namespace NES
  * Unpooled buffers are either allocated on the spot or served via a previously allocated, unpooled buffer that has
  * been returned to the BufferManager by some component.
  *
+ * A NUMA-aware BufferManager (see BufferManager::createNumaAware()) splits the pooled buffers into one pool per NUMA node.
+ * Each pool is allocated on its node. A requesting thread is served from the pool of the node it is currently running on and
+ * only borrows a buffer from a remote pool if its local pool is exhausted. Recycled buffers always return to their home pool.
+ *
+ * Optionally (see BufferManager::enableThreadLocalCaches()), every thread keeps a small cache of available pooled buffers in front
+ * of the pools. The cache is refilled from and drained to the pools in batches. Buffers released by a thread are returned to the
+ * cache of that thread, thus most requests and releases do not touch the shared pools.
+ * Note that buffers cached by a thread are not available to other threads, i.e., up to (number of threads * cache size) buffers
+ * are not visible to other threads. Once a thread exits, its caches are returned to the pools.
+ *
+ * Optionally (see BufferManager::enableSizeClasses()), unpooled buffers of up to the largest size class are served from preallocated
+ * pools of a few fixed sizes, e.g., 4KiB, 64KiB and 1MiB. A request receives a buffer of the smallest size class that fits it.
+ * Only if the pool of the size class is exhausted, or the request is larger than all size classes, the buffer is allocated on the spot.
+ *
+ * Optionally (see BufferManager::prefaultInBackground()), a background thread faults in the memory of the pooled buffers, while the
+ * BufferManager already hands out buffers. Otherwise, the memory of a buffer is faulted in once it is first written.
+ *
  */
 class BufferManager final : public std::enable_shared_from_this<BufferManager>, public BufferRecycler, public AbstractBufferProvider
 {
@@ -65,14 +87,25 @@ class BufferManager final : public std::enable_shared_from_this<BufferManager>,
 
     static constexpr auto DEFAULT_BUFFER_SIZE = 8 * 1024;
     static constexpr auto DEFAULT_NUMBER_OF_BUFFERS = 1024;
-    static constexpr auto DEFAULT_ALIGNMENT = 64;
 
 public:
+    /// Pooled and unpooled buffers are aligned to this many bytes, i.e., the memory of an unpooled buffer is rounded up accordingly.
+    static constexpr auto DEFAULT_ALIGNMENT = 64;
+
+    explicit BufferManager(
+        Private,
+        uint32_t bufferSize,
+        uint32_t numOfBuffers,
+        std::shared_ptr<std::pmr::memory_resource> memoryResource,
+        uint32_t withAlignment);
+
+    /// Creates one pool per memory resource in poolMemoryResources. The pooled buffers are distributed evenly among all pools.
     explicit BufferManager(
         Private,
         uint32_t bufferSize,
         uint32_t numOfBuffers,
         std::shared_ptr<std::pmr::memory_resource> memoryResource,
+        std::vector<std::shared_ptr<std::pmr::memory_resource>> poolMemoryResources,
         uint32_t withAlignment);
 
     /// Creates a new global buffer manager
@@ -86,12 +119,56 @@ public:
         const std::shared_ptr<std::pmr::memory_resource>& memoryResource = std::make_shared<NesDefaultMemoryAllocator>(),
         uint32_t withAlignment = DEFAULT_ALIGNMENT);
 
+    /// Creates a new global buffer manager, which keeps one pool of pooled buffers per NUMA node of the system.
+    /// On a system with a single NUMA node, this is equivalent to create() with a NumaMemoryResource.
+    /// @param bufferSize the size of each buffer in bytes
+    /// @param numOfBuffers the total number of buffers across all pools
+    /// @param hugePageMode the kind of pages that back the pools and the unpooled buffers
+    /// @param withAlignment the alignment of each buffer
+    static std::shared_ptr<BufferManager> createNumaAware(
+        uint32_t bufferSize = DEFAULT_BUFFER_SIZE,
+        uint32_t numOfBuffers = DEFAULT_NUMBER_OF_BUFFERS,
+        HugePageMode hugePageMode = HugePageMode::NONE,
+        uint32_t withAlignment = DEFAULT_ALIGNMENT);
+
     BufferManager(const BufferManager&) = delete;
     BufferManager& operator=(const BufferManager&) = delete;
     ~BufferManager() override;
 
     BufferManagerType getBufferManagerType() const override;
 
+    /// Enables a cache of up to `capacity` available pooled buffers for every thread that requests or releases pooled buffers.
+    /// This is a one shot call, which must happen before the BufferManager hands out its first buffer.
+    void enableThreadLocalCaches(size_t capacity);
+
+    /// Counters of the thread-local buffer cache of a single thread.
+    /// A hit is a request that was served from the cache, a miss is a request that had to access the shared pools.
+    struct ThreadLocalCacheStatistics
+    {
+        size_t hits;
+        size_t misses;
+    };
+
+    /// Returns the counters of the buffer cache of the calling thread, or an empty optional if thread-local caches are disabled.
+    [[nodiscard]] std::optional<ThreadLocalCacheStatistics> getThreadLocalCacheStatistics();
+
+    static constexpr std::array<size_t, 3> DEFAULT_SIZE_CLASSES = {4 * 1024, 64 * 1024, 1024 * 1024};
+
+    /// Preallocates `numberOfBuffersPerSizeClass` buffers for each of the (strictly ascending) sizes, which serve unpooled buffers.
+    /// This is a one shot call, which must happen before the BufferManager hands out its first buffer.
+    void enableSizeClasses(std::span<const size_t> sizeClasses, size_t numberOfBuffersPerSizeClass);
+
+    /// Number of available buffers of the size class with the given size, or 0 if there is no such size class
+    [[nodiscard]] size_t getNumberOfAvailableSizeClassBuffers(size_t sizeClass) const;
+
+    /// Bytes of the memory segment backing the buffer, i.e., the size of the buffer rounded up to the alignment or to its size class
+    [[nodiscard]] static size_t getMemorySegmentSize(const TupleBuffer& buffer);
+
+    /// Faults in the memory of all pooled buffers with multiple threads in the background, so that the first queries do not pay for the
+    /// page faults. If lockMemory is set, the memory is additionally locked into RAM (see `man 2 mlock`). Faulting in does not modify
+    /// the content of the buffers, thus they remain usable meanwhile. This is a one shot call.
+    void prefaultInBackground(bool lockMemory);
+
 private:
     /**
      * @brief Configure the BufferManager to use numOfBuffers buffers of size bufferSize bytes.
@@ -100,6 +177,63 @@ private:
      */
     void initialize(uint32_t withAlignment);
 
+    /// A pool of pooled buffers which resides in the memory of a single memory resource, e.g., a NUMA node.
+    struct alignas(64) Pool
+    {
+        explicit Pool(size_t numOfBuffers, std::shared_ptr<std::pmr::memory_resource> memoryResource)
+            : availableBuffers(numOfBuffers), memoryResource(std::move(memoryResource))
+        {
+        }
+
+        folly::MPMCQueue<NES::detail::MemorySegment*> availableBuffers;
+        std::shared_ptr<std::pmr::memory_resource> memoryResource;
+        uint8_t* basePointer{nullptr};
+        size_t allocatedAreaSize{0};
+    };
+
+    /// Returns the index of the pool the calling thread should preferably get its buffers from.
+    [[nodiscard]] size_t getLocalPoolIndex() const;
+    /// Returns the index of the pool the memory segment belongs to.
+    [[nodiscard]] size_t getHomePoolIndex(const NES::detail::MemorySegment* segment) const;
+    /// Reads an available memory segment from the local pool, or a remote pool if the local pool is empty.
+    NES::detail::MemorySegment* tryReadAnyPool(size_t localPool);
+
+    /// Stash of available memory segments owned by a single thread. Only the owning thread modifies the cache. The counters are atomic
+    /// only to allow other threads to read them, the owning thread updates them via relaxed loads and stores.
+    struct ThreadLocalCache
+    {
+        explicit ThreadLocalCache(size_t capacity) : segments(capacity) { }
+
+        std::vector<NES::detail::MemorySegment*> segments;
+        std::atomic<size_t> size{0};
+        std::atomic<size_t> hits{0};
+        std::atomic<size_t> misses{0};
+    };
+
+    /// Returns the cache of the calling thread, or nullptr if thread-local caches are disabled.
+    ThreadLocalCache* getThreadLocalCache();
+    /// Takes a memory segment from the cache of the calling thread. If the cache is empty, it is refilled from the pools.
+    NES::detail::MemorySegment* tryReadThreadLocalCache();
+    /// Returns the segments of the upper half of the cache to their home pools.
+    void drainThreadLocalCache(ThreadLocalCache& cache);
+    /// Returns all segments of the cache of the thread to their home pools and deletes the cache. Called, when the thread exits.
+    void releaseThreadLocalCache(std::thread::id threadId);
+
+    /// A pool of preallocated buffers of a single size, which serves unpooled buffers of at most this size.
+    struct alignas(64) SizeClass
+    {
+        explicit SizeClass(size_t bufferSize, size_t numOfBuffers) : bufferSize(bufferSize), availableBuffers(numOfBuffers) { }
+
+        size_t bufferSize;
+        std::vector<NES::detail::MemorySegment> segments;
+        folly::MPMCQueue<NES::detail::MemorySegment*> availableBuffers;
+        uint8_t* basePointer{nullptr};
+        size_t allocatedAreaSize{0};
+    };
+
+    /// Returns the size class the memory segment belongs to, or nullptr if it is a regular pooled buffer.
+    [[nodiscard]] SizeClass* getSizeClass(const NES::detail::MemorySegment* segment);
+
 public:
     /// This blocks until a buffer is available.
     TupleBuffer getBufferBlocking() override;
@@ -117,10 +251,18 @@ public:
 
     std::optional<TupleBuffer> getUnpooledBuffer(size_t bufferSize) override;
 
+    /// Variants of the above, which hand out buffers that are returned to `recycler` instead of this BufferManager once they are
+    /// released. The recycler has to return pooled buffers to this BufferManager via recyclePooledBuffer(). Unpooled buffers are
+    /// deallocated by the BufferManager after they have been passed to recycler->recycleUnpooledBuffer().
+    std::optional<TupleBuffer> getBufferNoBlocking(const std::shared_ptr<BufferRecycler>& recycler);
+    std::optional<TupleBuffer> getBufferWithTimeout(std::chrono::milliseconds timeoutMs, const std::shared_ptr<BufferRecycler>& recycler);
+    std::optional<TupleBuffer> getUnpooledBuffer(size_t bufferSize, const std::shared_ptr<BufferRecycler>& recycler);
 
     size_t getBufferSize() const override;
     size_t getNumOfPooledBuffers() const override;
     size_t getNumOfUnpooledBuffers() const override;
+    /// Bytes of the memory chunks that currently back unpooled buffers
+    size_t getNumberOfUnpooledBytes() const;
     size_t getNumberOfAvailableBuffers() const;
 
     /**
@@ -129,27 +271,33 @@ public:
      */
     void recyclePooledBuffer(NES::detail::MemorySegment* segment) override;
 
-    /**
-    * @brief Recycle an unpooled buffer by making it available to others
-    * @param buffer
-    */
+    /// Unpooled buffers are deallocated by the UnpooledChunksManager, thus there is nothing to recycle.
     void recycleUnpooledBuffer(NES::detail::MemorySegment* segment, const AllocationThreadInfo&) override;
 
 private:
     std::vector<NES::detail::MemorySegment> allBuffers;
 
-    folly::MPMCQueue<NES::detail::MemorySegment*> availableBuffers;
+    /// Pool i owns the memory segments allBuffers[i * buffersPerPool, (i + 1) * buffersPerPool). The last pool owns all remaining ones.
+    std::vector<Pool> pools;
+    size_t buffersPerPool;
 
     std::shared_ptr<NES::UnpooledChunksManager> unpooledChunksManager;
+    /// Ascending by buffer size
+    std::vector<SizeClass> sizeClasses;
+
+    /// Identifies this BufferManager in the thread-local lookup of the caches. Unlike the address, the id is never reused.
+    uint64_t instanceId;
+    size_t threadLocalCacheCapacity{0};
+    mutable std::mutex threadLocalCachesMutex;
+    std::unordered_map<std::thread::id, std::unique_ptr<ThreadLocalCache>> threadLocalCaches;
 
     size_t bufferSize;
     size_t numOfBuffers;
 
-    uint8_t* basePointer{nullptr};
-    size_t allocatedAreaSize;
-
     std::shared_ptr<std::pmr::memory_resource> memoryResource;
     std::atomic<bool> isDestroyed{false};
+    /// Stopped and joined before the memory of the pools is deallocated
+    std::jthread prefaultThread;
 };
 
 
@@ -0,0 +1,87 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+
+namespace NES
+{
+
+/// The query and pipeline on whose behalf a thread acquires buffers. Threads outside of any BufferOwnership::Scope acquire buffers on
+/// behalf of the invalid owner, e.g., the threads of the sources.
+struct BufferOwner
+{
+    QueryId queryId = INVALID<QueryId>;
+    PipelineId pipelineId = INVALID<PipelineId>;
+
+    auto operator<=>(const BufferOwner&) const = default;
+};
+
+/// Optionally tracks how many buffers every owner currently holds, e.g., to find the query whose join slices or sinks retain the
+/// buffers that the pool lacks. A buffer is accounted to the owner of the thread that acquired it until its last reference is
+/// released, regardless of the threads that hold it meanwhile. The accounting covers pooled and unpooled buffers of all buffer
+/// providers. While the tracking is disabled, acquiring and releasing a buffer only pays for a relaxed load.
+class BufferOwnership
+{
+public:
+    /// The counters of an owner are never deallocated, thus buffers may refer to them without keeping them alive
+    struct Counters
+    {
+        std::atomic<int64_t> numberOfBuffers{0};
+        std::atomic<int64_t> numberOfBytes{0};
+    };
+
+    struct Usage
+    {
+        BufferOwner owner;
+        size_t numberOfBuffers;
+        size_t numberOfBytes;
+    };
+
+    /// Accounts the buffers that the calling thread acquires to the owner until the scope ends. Scopes nest.
+    class Scope
+    {
+    public:
+        explicit Scope(BufferOwner owner);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope(Scope&&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        Scope& operator=(Scope&&) = delete;
+
+    private:
+        BufferOwner previousOwner;
+    };
+
+    /// Buffers that were acquired before the tracking was enabled are not accounted to any owner. This is a one shot call.
+    static void enable();
+    [[nodiscard]] static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+    /// Returns the counters of the owner of the calling thread. Threads cache the counters of their last owner.
+    [[nodiscard]] static Counters* getCountersOfCurrentOwner();
+
+    /// Returns the usage of all owners that currently hold buffers, ordered by owner
+    [[nodiscard]] static std::vector<Usage> getUsage();
+
+private:
+    static std::atomic<bool> enabled;
+};
+
+}
@@ -45,7 +45,7 @@ public:
     /// @param buffer the buffer to recycle
     virtual void recyclePooledBuffer(detail::MemorySegment* buffer) = 0;
 
-    /// @brief Interface method for unpooled buffer recycling
+    /// @brief Interface method for unpooled buffer recycling, which is invoked right before the memory of the buffer is deallocated
     /// @param buffer the buffer to recycle
     /// @param threadCopyLastChunkPtr stores the thread id and last chunk ptr
     virtual void recycleUnpooledBuffer(detail::MemorySegment* buffer, const AllocationThreadInfo& threadCopyLastChunkPtr) = 0;
@@ -0,0 +1,52 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include <DataTypes/Schema.hpp>
+
+namespace NES
+{
+
+/// Describes how a tuple buffer stores the tuples of a schema column by column. The values of a column are stored densely, i.e., the value
+/// of the i-th tuple is at `valueOffset + (i * valueSize)`. Instead of a null byte per value, every nullable column has a validity bitmap
+/// of 64-bit words after the values of all columns, in which the i-th bit is set if the value of the i-th tuple is not null.
+/// Thus, checking the nulls of 64 tuples reads a single word and the values of a column stay contiguous.
+struct ColumnarLayout
+{
+    static constexpr uint64_t BITS_PER_VALIDITY_WORD = 64;
+
+    struct Column
+    {
+        uint64_t valueOffset;
+        uint64_t valueSize;
+        /// Offset of the validity bitmap, if the column is nullable
+        std::optional<uint64_t> validityOffset;
+    };
+
+    /// Places the columns in the order of the schema, so that the buffer fits the largest number of tuples
+    static ColumnarLayout create(const Schema& schema, uint64_t bufferSize);
+
+    /// Returns true if the value of the tuple is not null, given the validity bitmap of its column
+    static bool isValid(const std::byte* validityBitmap, uint64_t tupleIndex);
+
+    uint64_t capacity;
+    std::vector<Column> columns;
+};
+
+}
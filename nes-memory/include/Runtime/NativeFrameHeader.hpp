@@ -0,0 +1,44 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace NES
+{
+
+/// The native format serializes tuple buffers of the row layout (see RowTupleBufferRef) as a stream of frames, one frame per tuple buffer.
+/// A frame starts with a NativeFrameHeader, followed by the 'numberOfTuples * sizeOfTuple' bytes of the tuples, exactly as they are laid
+/// out in the tuple buffer. The header is followed by the 'numberOfChildBuffers' child buffers of the tuple buffer, in the order of their
+/// indexes. Each child buffer is its (uint64_t) number of bytes, followed by its bytes. Since the child buffers keep their indexes, the
+/// VariableSizedAccess of a VARSIZED value stays valid in the frame. Inlined VARSIZED values are part of the bytes of their tuple.
+/// All values are stored in the byte order of the host.
+struct NativeFrameHeader
+{
+    /// 'NESN' in the little-endian byte order
+    static constexpr uint32_t MAGIC = 0x4E53454E;
+
+    uint32_t magic = MAGIC;
+    /// Allows detecting a schema that does not match the format of the tuples
+    uint32_t sizeOfTuple = 0;
+    uint64_t numberOfTuples = 0;
+    uint64_t numberOfChildBuffers = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<NativeFrameHeader>, "NativeFrameHeader must be trivially copyable for (de)serialization");
+static_assert(sizeof(NativeFrameHeader) == 24, "NativeFrameHeader must not contain padding");
+
+}
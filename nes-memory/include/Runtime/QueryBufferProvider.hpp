@@ -0,0 +1,98 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/BufferManager.hpp>
+#include <Runtime/BufferRecycler.hpp>
+#include <Runtime/TupleBuffer.hpp>
+
+namespace NES
+{
+
+/// Hands out the buffers of a single query from the global BufferManager and accounts the bytes of all pooled and unpooled buffers,
+/// which are currently held by the query. Released buffers pass through the QueryBufferProvider on their way back to the
+/// BufferManager, thus the accounting also covers buffers that outlive the task that requested them, e.g., the state of a join.
+///
+/// The quota does not cover the state of the operators (see getStateBufferProvider()).
+/// Exceeding the quota does not fail any request, as the query needs buffers to make progress and release its in-flight buffers.
+/// Instead, the quota listener is notified whenever the query exceeds its quota and whenever it is back within its quota, which
+/// allows the caller to throttle the ingestion of the query without affecting other queries.
+class QueryBufferProvider final : public std::enable_shared_from_this<QueryBufferProvider>,
+                                  public BufferRecycler,
+                                  public AbstractBufferProvider
+{
+    /// Buffers keep their QueryBufferProvider alive, thus we only allow creation via QueryBufferProvider::create().
+    struct Private
+    {
+        explicit Private() = default;
+    };
+
+public:
+    /// Invoked with true once the query exceeds its quota and with false once the query is back within its quota.
+    /// The listener is never invoked concurrently and the notifications alternate, starting with true.
+    using QuotaListener = std::function<void(bool quotaExceeded)>;
+
+    QueryBufferProvider(Private, std::shared_ptr<BufferManager> bufferManager, size_t quotaInBytes, QuotaListener quotaListener);
+
+    /// @param quotaInBytes the number of bytes the query may hold before the quota listener is notified, must be larger than 0
+    static std::shared_ptr<QueryBufferProvider>
+    create(std::shared_ptr<BufferManager> bufferManager, size_t quotaInBytes, QuotaListener quotaListener);
+
+    BufferManagerType getBufferManagerType() const override;
+    size_t getBufferSize() const override;
+    size_t getNumOfPooledBuffers() const override;
+    size_t getNumOfUnpooledBuffers() const override;
+
+    TupleBuffer getBufferBlocking() override;
+    std::optional<TupleBuffer> getBufferNoBlocking() override;
+    std::optional<TupleBuffer> getBufferWithTimeout(std::chrono::milliseconds timeoutMs) override;
+    std::optional<TupleBuffer> getUnpooledBuffer(size_t bufferSize) override;
+
+    /// The state of the operators is requested from the BufferManager directly. Accounting it would let a query, whose state exceeds the
+    /// quota, throttle its sources forever, as only the progress of the sources triggers the windows that release the state.
+    /// The window_state_memory_budget bounds the state instead.
+    AbstractBufferProvider* getStateBufferProvider() override;
+
+    void recyclePooledBuffer(detail::MemorySegment* segment) override;
+    void recycleUnpooledBuffer(detail::MemorySegment* segment, const AllocationThreadInfo& threadCopyLastChunkPtr) override;
+
+    /// Number of bytes of all pooled and unpooled buffers that are currently held by the query
+    [[nodiscard]] size_t getNumberOfUsedBytes() const;
+    [[nodiscard]] size_t getQuotaInBytes() const;
+
+private:
+    std::optional<TupleBuffer> account(std::optional<TupleBuffer> buffer, size_t bytes);
+    void release(size_t bytes);
+    /// Notifies the quota listener, if the last notification does not reflect the current usage anymore
+    void updateQuotaState();
+
+    std::shared_ptr<BufferManager> bufferManager;
+    size_t quotaInBytes;
+    QuotaListener quotaListener;
+    std::atomic<size_t> usedBytes{0};
+
+    std::mutex quotaStateMutex;
+    bool quotaExceeded{false};
+};
+
+}
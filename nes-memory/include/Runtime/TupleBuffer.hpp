@@ -167,12 +167,22 @@ public:
 
     void setCreationTimestampInMS(Timestamp value) noexcept;
 
+    /// The earliest and latest time (in nanoseconds since the epoch of the system clock) at which a source ingested one of the tuples that
+    /// this buffer derives from. Operators propagate both to their output buffers, so that sinks can measure the end-to-end latency.
+    /// Buffers that have no ingestion timestamps, e.g., freshly allocated buffers, return Timestamp::INITIAL_VALUE.
+    [[nodiscard]] Timestamp getMinIngestionTimestampInNS() const noexcept;
+    [[nodiscard]] Timestamp getMaxIngestionTimestampInNS() const noexcept;
+    void setIngestionTimestampsInNS(Timestamp minIngestionTimestamp, Timestamp maxIngestionTimestamp) noexcept;
+
     [[nodiscard]] OriginId getOriginId() const noexcept;
     void setOriginId(OriginId id) noexcept;
 
     ///@brief attach a child tuple buffer to the parent. the child tuple buffer is then identified via NestedTupleBufferKey
     [[nodiscard]] VariableSizedAccess::Index storeChildBuffer(TupleBuffer& buffer) noexcept;
 
+    ///@brief replaces the child tuple buffer at the NestedTupleBufferKey and releases the previous child tuple buffer
+    void replaceChildBuffer(VariableSizedAccess::Index bufferIndex, TupleBuffer& buffer) noexcept;
+
     ///@brief retrieve a child tuple buffer via its NestedTupleBufferKey
     [[nodiscard]] TupleBuffer loadChildBuffer(VariableSizedAccess::Index bufferIndex) const noexcept;
 
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <iosfwd>
@@ -77,6 +78,9 @@ class UnpooledChunksManager
     /// UnpooledBufferData is a shared_ptr, as we pass a shared_ptr to anyone that requires access to an unpooled buffer chunk
     folly::Synchronized<std::unordered_map<std::thread::id, std::shared_ptr<folly::Synchronized<UnpooledChunk>>>> allLocalUnpooledBuffers;
 
+    /// Bytes of all currently allocated chunks. Shared with the memory segments, as they deallocate their chunk after the manager is gone
+    std::shared_ptr<std::atomic<size_t>> numberOfAllocatedBytes = std::make_shared<std::atomic<size_t>>(0);
+
     /// Returns two pointers wrapped in a pair
     /// std::get<0>: the key that is being used in the unordered_map of a ChunkControlBlock
     /// std::get<1>: pointer to the memory address that is large enough for neededSize
@@ -87,6 +91,8 @@ class UnpooledChunksManager
 public:
     explicit UnpooledChunksManager(std::shared_ptr<std::pmr::memory_resource> memoryResource);
     size_t getNumberOfUnpooledBuffers() const;
+    /// Unlike the number of unpooled buffers, the number of allocated bytes is read without locking any chunk
+    size_t getNumberOfAllocatedBytes() const;
     TupleBuffer getUnpooledBuffer(size_t neededSize, size_t alignment, const std::shared_ptr<BufferRecycler>& bufferRecycler);
 };
 
@@ -14,9 +14,12 @@
 
 #pragma once
 
+#include <array>
 #include <compare>
+#include <cstddef>
 #include <cstdint>
 #include <ostream>
+#include <span>
 #include <Util/Logger/Formatter.hpp>
 #include <ErrorHandling.hpp>
 
@@ -31,8 +34,10 @@ class BufferControlBlock;
 /// We store variable sized data as child buffer. To reference one variable sized data object, we require an index to the child buffer and
 /// an offset in the child buffer locating the start of the variable sized data object.
 ///
-/// We use 64 bits to store the child index and offset for accessing the correct variable sized data.
-/// We use the upper 32 bits for the childIndex and the lower 32 bits for the childBufferOffset
+/// Similar to the strings of Umbra, values of up to INLINE_SIZE bytes are stored inline in the access instead, i.e., in the bytes of the
+/// prefix, the index and the offset. Unused inline bytes are zero. Longer values keep their first PREFIX_SIZE bytes in the prefix.
+/// Thus, comparing the size and the prefix of two accesses rejects most unequal values without reading their child buffers.
+/// We use 32 bits for the size, the childIndex and the childBufferOffset.
 /// This allows us to have 4 billion child buffer (unless we have only one var sized object per child)
 struct VariableSizedAccess
 {
@@ -84,7 +89,7 @@ struct VariableSizedAccess
     class Size
     {
     public:
-        using Underlying = size_t;
+        using Underlying = uint32_t;
         static constexpr auto UnderlyingBits = sizeof(Underlying) * 8;
 
         explicit Size(uint64_t size);
@@ -97,38 +102,69 @@ struct VariableSizedAccess
         Underlying size;
     };
 
+    static constexpr size_t INLINE_SIZE = 12;
+    static constexpr size_t PREFIX_SIZE = 4;
+
     /// The order of the variables are of utmost importance, as we are providing a nautilus::val<> wrapper.
     /// By calling the C++-runtime (via nautilus::invoke()), we do not call any conversion but rather "bit_cast" the CombinedIndex.
     /// Thus, we initialize the values of the offset and index indirectly and not via the constructor call.
-    Offset offset;
-    Index index;
+    /// Inlined values start at the prefix and span the index and the offset.
     Size size;
+    std::array<std::byte, PREFIX_SIZE> prefix;
+    Index index;
+    Offset offset;
 
 public:
-    VariableSizedAccess() : offset(0), index(0), size(0) { }
+    VariableSizedAccess() : size(0), prefix{}, index(0), offset(0) { }
 
-    explicit VariableSizedAccess(const Index index, const Size size) : offset(0), index(index), size(size) { }
+    /// Creates an access that stores the value inline
+    explicit VariableSizedAccess(std::span<const std::byte> value);
 
-    explicit VariableSizedAccess(const Index index, const Offset offset, const Size size) : offset(offset), index(index), size(size) { }
-
-    explicit VariableSizedAccess(const Offset offset, const Size size) : offset(offset), index(0), size(size) { }
+    /// Creates an access to a value of more than INLINE_SIZE bytes that is stored in the child buffer at the index and offset
+    explicit VariableSizedAccess(Index index, Offset offset, std::span<const std::byte> value);
 
     ~VariableSizedAccess() = default;
 
-    [[nodiscard]] Index getIndex() const { return index; }
+    [[nodiscard]] bool isInlined() const { return size.getRawSize() <= INLINE_SIZE; }
 
-    [[nodiscard]] Offset getOffset() const { return offset; };
+    [[nodiscard]] Index getIndex() const
+    {
+        PRECONDITION(not isInlined(), "An inlined value is not stored in a child buffer");
+        return index;
+    }
+
+    [[nodiscard]] Offset getOffset() const
+    {
+        PRECONDITION(not isInlined(), "An inlined value is not stored in a child buffer");
+        return offset;
+    };
 
     [[nodiscard]] Size getSize() const { return size; };
 
+    /// The first PREFIX_SIZE bytes of the value, padded with zeros
+    [[nodiscard]] std::span<const std::byte, PREFIX_SIZE> getPrefix() const { return prefix; }
+
+    /// Returns the inlined value, which lives as long as this access
+    [[nodiscard]] std::span<const std::byte> getInlinedValue() const;
+
+    /// Returns an access to the same value in the child buffer at the given index and offset
+    [[nodiscard]] VariableSizedAccess relocate(Index newIndex, Offset newOffset) const;
+
     friend std::ostream& operator<<(std::ostream& os, const VariableSizedAccess& obj)
     {
+        if (obj.isInlined())
+        {
+            return os << "VariableSizedAccess(inlined size: " << obj.size << ")";
+        }
         return os << "VariableSizedAccess(index: " << obj.index << " offset: " << obj.offset << ")";
     }
 };
 
 static_assert(sizeof(VariableSizedAccess) == 16, "VariableSizedAccess must be 16 bytes");
-static_assert(sizeof(VariableSizedAccess::Size) == 8, "VariableSizedAccess::Size must be 8 bytes");
+static_assert(sizeof(VariableSizedAccess::Size) == 4, "VariableSizedAccess::Size must be 4 bytes");
+static_assert(
+    offsetof(VariableSizedAccess, prefix) + VariableSizedAccess::INLINE_SIZE == sizeof(VariableSizedAccess),
+    "Inlined values must span the prefix, the index and the offset");
 static_assert(sizeof(VariableSizedAccess::Offset) == 4, "VariableSizedAccess::Offset must be 4 bytes");
 static_assert(sizeof(VariableSizedAccess::Index) == 4, "VariableSizedAccess::Index must be 4 bytes");
 }
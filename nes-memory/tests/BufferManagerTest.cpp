@@ -0,0 +1,340 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+#include <Runtime/Allocator/HugePageMemoryResource.hpp>
+#include <Runtime/Allocator/NumaMemoryResource.hpp>
+#include <Runtime/BufferManager.hpp>
+#include <Runtime/BufferOwnership.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Time/Timestamp.hpp>
+#include <gtest/gtest.h>
+
+namespace NES
+{
+
+namespace
+{
+constexpr size_t BUFFER_SIZE = 4096;
+constexpr size_t NUMBER_OF_BUFFERS = 128;
+
+/// Takes all buffers out of the buffer manager and returns them, to check that every buffer is handed out exactly once.
+void exhaustAndRecycle(BufferManager& bufferManager)
+{
+    std::vector<TupleBuffer> buffers;
+    while (auto buffer = bufferManager.getBufferNoBlocking())
+    {
+        buffers.emplace_back(std::move(*buffer));
+    }
+    EXPECT_EQ(buffers.size(), NUMBER_OF_BUFFERS);
+    EXPECT_EQ(bufferManager.getNumberOfAvailableBuffers(), 0);
+    EXPECT_FALSE(bufferManager.getBufferWithTimeout(std::chrono::milliseconds(10)).has_value());
+
+    buffers.clear();
+    EXPECT_EQ(bufferManager.getNumberOfAvailableBuffers(), NUMBER_OF_BUFFERS);
+}
+}
+
+TEST(BufferManagerTest, DefaultBufferManagerHandsOutAllBuffers)
+{
+    const auto bufferManager = BufferManager::create(BUFFER_SIZE, NUMBER_OF_BUFFERS);
+    exhaustAndRecycle(*bufferManager);
+}
+
+/// Faulting in or locking the pool may fail for lack of privileges, but the buffers stay usable and keep their content either way
+TEST(BufferManagerTest, PrefaultedBufferManagerHandsOutAllBuffers)
+{
+    for (const auto lockMemory : {false, true})
+    {
+        const auto bufferManager = BufferManager::create(BUFFER_SIZE, NUMBER_OF_BUFFERS);
+        {
+            auto buffer = bufferManager->getBufferBlocking();
+            std::memset(buffer.getAvailableMemoryArea().data(), 42, BUFFER_SIZE);
+            bufferManager->prefaultInBackground(lockMemory);
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            EXPECT_TRUE(std::ranges::all_of(buffer.getAvailableMemoryArea(), [](const auto byte) { return byte == std::byte{42}; }));
+        }
+        exhaustAndRecycle(*bufferManager);
+    }
+}
+
+TEST(BufferManagerTest, NumaAwareBufferManagerHandsOutAllBuffers)
+{
+    EXPECT_GE(NumaMemoryResource::getNumberOfNumaNodes(), 1);
+    EXPECT_LT(NumaMemoryResource::getNumaNodeOfCurrentThread(), NumaMemoryResource::getNumberOfNumaNodes());
+
+    const auto bufferManager = BufferManager::createNumaAware(BUFFER_SIZE, NUMBER_OF_BUFFERS);
+    EXPECT_EQ(bufferManager->getNumOfPooledBuffers(), NUMBER_OF_BUFFERS);
+    EXPECT_EQ(bufferManager->getNumberOfAvailableBuffers(), NUMBER_OF_BUFFERS);
+
+    /// Repeating the cycle ensures that all buffers returned to their home pools and can be handed out again
+    exhaustAndRecycle(*bufferManager);
+    exhaustAndRecycle(*bufferManager);
+}
+
+TEST(BufferManagerTest, NumaAwareBufferManagerConcurrentAccess)
+{
+    constexpr size_t numberOfThreads = 8;
+    constexpr size_t iterations = 1000;
+    const auto bufferManager = BufferManager::createNumaAware(BUFFER_SIZE, NUMBER_OF_BUFFERS);
+
+    std::vector<std::jthread> threads;
+    threads.reserve(numberOfThreads);
+    for (size_t threadIdx = 0; threadIdx < numberOfThreads; ++threadIdx)
+    {
+        threads.emplace_back(
+            [&]
+            {
+                for (size_t i = 0; i < iterations; ++i)
+                {
+                    auto buffer = bufferManager->getBufferBlocking();
+                    buffer.getAvailableMemoryArea<size_t>()[0] = i;
+                    EXPECT_EQ(buffer.getAvailableMemoryArea<size_t>()[0], i);
+                }
+            });
+    }
+    threads.clear();
+
+    EXPECT_EQ(bufferManager->getNumberOfAvailableBuffers(), NUMBER_OF_BUFFERS);
+}
+
+TEST(BufferManagerTest, ThreadLocalCacheCountsHitsAndMisses)
+{
+    constexpr size_t cacheSize = 8;
+    const auto bufferManager = BufferManager::create(BUFFER_SIZE, NUMBER_OF_BUFFERS);
+    EXPECT_FALSE(bufferManager->getThreadLocalCacheStatistics().has_value());
+    bufferManager->enableThreadLocalCaches(cacheSize);
+
+    /// The first request refills half of the cache, thus the next requests are served from the cache
+    std::vector<TupleBuffer> buffers;
+    for (size_t i = 0; i < cacheSize / 2; ++i)
+    {
+        buffers.emplace_back(bufferManager->getBufferBlocking());
+    }
+    auto statistics = bufferManager->getThreadLocalCacheStatistics();
+    ASSERT_TRUE(statistics.has_value());
+    EXPECT_EQ(statistics->misses, 1);
+    EXPECT_EQ(statistics->hits, (cacheSize / 2) - 1);
+
+    /// Released buffers return to the cache of the releasing thread and are still accounted as available
+    buffers.clear();
+    EXPECT_EQ(bufferManager->getNumberOfAvailableBuffers(), NUMBER_OF_BUFFERS);
+    buffers.emplace_back(bufferManager->getBufferBlocking());
+    statistics = bufferManager->getThreadLocalCacheStatistics();
+    EXPECT_EQ(statistics->misses, 1);
+    EXPECT_EQ(statistics->hits, cacheSize / 2);
+    buffers.clear();
+
+    exhaustAndRecycle(*bufferManager);
+}
+
+TEST(BufferManagerTest, ThreadLocalCacheConcurrentAccess)
+{
+    constexpr size_t numberOfThreads = 8;
+    constexpr size_t iterations = 1000;
+    constexpr size_t buffersPerIteration = 4;
+    const auto bufferManager = BufferManager::create(BUFFER_SIZE, NUMBER_OF_BUFFERS);
+    bufferManager->enableThreadLocalCaches(buffersPerIteration);
+
+    std::vector<std::jthread> threads;
+    threads.reserve(numberOfThreads);
+    for (size_t threadIdx = 0; threadIdx < numberOfThreads; ++threadIdx)
+    {
+        threads.emplace_back(
+            [&]
+            {
+                for (size_t i = 0; i < iterations; ++i)
+                {
+                    std::vector<TupleBuffer> buffers;
+                    for (size_t j = 0; j < buffersPerIteration; ++j)
+                    {
+                        buffers.emplace_back(bufferManager->getBufferBlocking());
+                        buffers.back().getAvailableMemoryArea<size_t>()[0] = i;
+                    }
+                    for (const auto& buffer : buffers)
+                    {
+                        EXPECT_EQ(buffer.getAvailableMemoryArea<size_t>()[0], i);
+                    }
+                }
+                const auto statistics = bufferManager->getThreadLocalCacheStatistics();
+                ASSERT_TRUE(statistics.has_value());
+                EXPECT_EQ(statistics->hits + statistics->misses, iterations * buffersPerIteration);
+            });
+    }
+    threads.clear();
+
+    /// The terminated threads returned their cached buffers to the pools, thus this thread can get all of them
+    EXPECT_EQ(bufferManager->getNumberOfAvailableBuffers(), NUMBER_OF_BUFFERS);
+    exhaustAndRecycle(*bufferManager);
+}
+
+TEST(BufferManagerTest, HugePageMemoryResourceFallsBackToSmallerPages)
+{
+    constexpr size_t twoMegaBytes = 2UL * 1024 * 1024;
+    EXPECT_EQ(HugePageMemoryResource::getModeForAllocation(4096, HugePageMode::TRANSPARENT), HugePageMode::NONE);
+    EXPECT_EQ(HugePageMemoryResource::getModeForAllocation(twoMegaBytes, HugePageMode::EXPLICIT_1GB), HugePageMode::EXPLICIT_2MB);
+    EXPECT_EQ(HugePageMemoryResource::getMappedSize(twoMegaBytes + 1, HugePageMode::EXPLICIT_2MB), 2 * twoMegaBytes);
+
+    /// Explicit huge pages are usually not reserved on test machines. Allocations must succeed regardless.
+    for (const auto mode : {HugePageMode::NONE, HugePageMode::TRANSPARENT, HugePageMode::EXPLICIT_2MB, HugePageMode::EXPLICIT_1GB})
+    {
+        HugePageMemoryResource memoryResource(mode);
+        for (const size_t size : {size_t{64}, twoMegaBytes + 1})
+        {
+            auto* memory = static_cast<std::byte*>(memoryResource.allocate(size, 64));
+            ASSERT_NE(memory, nullptr);
+            std::memset(memory, 1, size);
+            memoryResource.deallocate(memory, size, 64);
+        }
+    }
+}
+
+TEST(BufferManagerTest, HugePageBufferManagerHandsOutAllBuffers)
+{
+    constexpr size_t bufferSize = 64 * 1024;
+    for (const auto mode : {HugePageMode::TRANSPARENT, HugePageMode::EXPLICIT_2MB})
+    {
+        const auto bufferManager = BufferManager::create(bufferSize, NUMBER_OF_BUFFERS, std::make_shared<HugePageMemoryResource>(mode));
+        exhaustAndRecycle(*bufferManager);
+        EXPECT_TRUE(bufferManager->getUnpooledBuffer(4 * bufferSize).has_value());
+
+        const auto numaAwareBufferManager = BufferManager::createNumaAware(bufferSize, NUMBER_OF_BUFFERS, mode);
+        exhaustAndRecycle(*numaAwareBufferManager);
+    }
+}
+
+/// Not every producer of a buffer sets the ingestion timestamps, thus a recycled buffer must not carry those of its previous use
+TEST(BufferManagerTest, RecycledBufferHasNoIngestionTimestamps)
+{
+    const auto bufferManager = BufferManager::create(BUFFER_SIZE, 1);
+    {
+        auto buffer = bufferManager->getBufferBlocking();
+        buffer.setIngestionTimestampsInNS(Timestamp(42), Timestamp(43));
+        EXPECT_EQ(buffer.getMinIngestionTimestampInNS(), Timestamp(42));
+        EXPECT_EQ(buffer.getMaxIngestionTimestampInNS(), Timestamp(43));
+    }
+    const auto recycledBuffer = bufferManager->getBufferBlocking();
+    EXPECT_EQ(recycledBuffer.getMinIngestionTimestampInNS(), Timestamp(Timestamp::INITIAL_VALUE));
+    EXPECT_EQ(recycledBuffer.getMaxIngestionTimestampInNS(), Timestamp(Timestamp::INITIAL_VALUE));
+}
+
+/// Copies of a buffer are released concurrently, while its last owner releases it without other threads touching the reference counter
+TEST(BufferManagerTest, SharedBufferIsRecycledOnceByItsLastOwner)
+{
+    constexpr size_t numberOfThreads = 8;
+    constexpr size_t numberOfIterations = 1000;
+    const auto bufferManager = BufferManager::create(BUFFER_SIZE, NUMBER_OF_BUFFERS);
+    for (size_t iteration = 0; iteration < numberOfIterations; ++iteration)
+    {
+        auto buffer = bufferManager->getBufferBlocking();
+        {
+            std::vector<std::jthread> threads;
+            for (size_t thread = 0; thread < numberOfThreads; ++thread)
+            {
+                threads.emplace_back([copy = buffer]() mutable { copy.release(); });
+            }
+            buffer.release();
+        }
+        ASSERT_EQ(bufferManager->getNumberOfAvailableBuffers(), NUMBER_OF_BUFFERS);
+    }
+
+    /// A buffer that is never shared is released by its only owner
+    auto buffer = bufferManager->getBufferBlocking();
+    EXPECT_EQ(buffer.getReferenceCounter(), 1);
+    buffer.release();
+    EXPECT_EQ(bufferManager->getNumberOfAvailableBuffers(), NUMBER_OF_BUFFERS);
+}
+
+TEST(BufferManagerTest, SizeClassesServeUnpooledBuffers)
+{
+    constexpr size_t buffersPerSizeClass = 2;
+    const std::array<size_t, 2> sizeClasses = {4096, 65536};
+    const auto bufferManager = BufferManager::create(BUFFER_SIZE, NUMBER_OF_BUFFERS);
+    bufferManager->enableSizeClasses(sizeClasses, buffersPerSizeClass);
+
+    /// A request is served from the smallest size class that fits it, but keeps its requested size
+    std::vector<TupleBuffer> buffers;
+    buffers.emplace_back(*bufferManager->getUnpooledBuffer(100));
+    buffers.emplace_back(*bufferManager->getUnpooledBuffer(4096));
+    EXPECT_EQ(buffers[0].getBufferSize(), 100);
+    EXPECT_EQ(BufferManager::getMemorySegmentSize(buffers[0]), 4096);
+    EXPECT_EQ(bufferManager->getNumberOfAvailableSizeClassBuffers(4096), 0);
+    EXPECT_EQ(bufferManager->getNumberOfAvailableSizeClassBuffers(65536), buffersPerSizeClass);
+    EXPECT_EQ(bufferManager->getNumberOfUnpooledBytes(), 0);
+
+    /// An exhausted size class and requests larger than all size classes fall back to allocating the buffer on the spot
+    buffers.emplace_back(*bufferManager->getUnpooledBuffer(1000));
+    buffers.emplace_back(*bufferManager->getUnpooledBuffer(100000));
+    EXPECT_EQ(buffers[2].getBufferSize(), 1000);
+    EXPECT_EQ(buffers[3].getBufferSize(), 100000);
+    EXPECT_EQ(bufferManager->getNumberOfAvailableSizeClassBuffers(65536), buffersPerSizeClass);
+    EXPECT_GT(bufferManager->getNumberOfUnpooledBytes(), 0);
+
+    /// Released buffers return to their size class and not to the pooled buffers
+    const std::array memoryOfSizeClass = {buffers[0].getAvailableMemoryArea().data(), buffers[1].getAvailableMemoryArea().data()};
+    buffers.clear();
+    EXPECT_EQ(bufferManager->getNumberOfAvailableSizeClassBuffers(4096), buffersPerSizeClass);
+    EXPECT_EQ(bufferManager->getNumberOfAvailableBuffers(), NUMBER_OF_BUFFERS);
+    EXPECT_EQ(bufferManager->getNumberOfUnpooledBytes(), 0);
+    const auto recycledBuffer = bufferManager->getUnpooledBuffer(4000);
+    ASSERT_TRUE(recycledBuffer.has_value());
+    EXPECT_TRUE(std::ranges::contains(memoryOfSizeClass, recycledBuffer->getAvailableMemoryArea().data()));
+}
+
+/// A buffer counts for the owner that acquired it until its last reference is released
+TEST(BufferManagerTest, BufferOwnershipAccountsBuffersToTheAcquiringOwner)
+{
+    BufferOwnership::enable();
+    const auto bufferManager = BufferManager::create(BUFFER_SIZE, NUMBER_OF_BUFFERS);
+    const BufferOwner owner{.queryId = QueryId(7), .pipelineId = PipelineId(3)};
+    const auto getUsageOf = [](const BufferOwner& owner) -> std::optional<BufferOwnership::Usage>
+    {
+        const auto usage = BufferOwnership::getUsage();
+        const auto ownerUsage = std::ranges::find(usage, owner, &BufferOwnership::Usage::owner);
+        return ownerUsage == usage.end() ? std::nullopt : std::optional(*ownerUsage);
+    };
+
+    std::vector<TupleBuffer> buffers;
+    {
+        const BufferOwnership::Scope scope(owner);
+        buffers.emplace_back(bufferManager->getBufferBlocking());
+        buffers.emplace_back(bufferManager->getBufferBlocking());
+        buffers.emplace_back(*bufferManager->getUnpooledBuffer(100));
+    }
+    const auto unownedBuffer = bufferManager->getBufferBlocking();
+    auto ownerUsage = getUsageOf(owner);
+    ASSERT_TRUE(ownerUsage.has_value());
+    EXPECT_EQ(ownerUsage->numberOfBuffers, 3);
+    EXPECT_GE(ownerUsage->numberOfBytes, 2 * BUFFER_SIZE + 100);
+
+    {
+        const auto retainedBuffer = buffers.front();
+        buffers.clear();
+        ownerUsage = getUsageOf(owner);
+        ASSERT_TRUE(ownerUsage.has_value());
+        EXPECT_EQ(ownerUsage->numberOfBuffers, 1);
+    }
+    EXPECT_FALSE(getUsageOf(owner).has_value());
+}
+
+}
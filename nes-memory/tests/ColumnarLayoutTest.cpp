@@ -0,0 +1,78 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Runtime/ColumnarLayout.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <gtest/gtest.h>
+
+namespace NES
+{
+
+TEST(ColumnarLayoutTest, NonNullableColumnsAreDense)
+{
+    const auto schema = Schema{}.addField("a", DataType::Type::UINT64).addField("b", DataType::Type::INT32);
+    const auto layout = ColumnarLayout::create(schema, 4096);
+    EXPECT_EQ(layout.capacity, 4096 / 12);
+    ASSERT_EQ(layout.columns.size(), 2);
+    EXPECT_EQ(layout.columns[0].valueOffset, 0);
+    EXPECT_EQ(layout.columns[0].valueSize, 8);
+    EXPECT_FALSE(layout.columns[0].validityOffset.has_value());
+    EXPECT_EQ(layout.columns[1].valueOffset, 8 * layout.capacity);
+    EXPECT_EQ(layout.columns[1].valueSize, 4);
+    EXPECT_FALSE(layout.columns[1].validityOffset.has_value());
+}
+
+TEST(ColumnarLayoutTest, NullableColumnsHaveWordAlignedValidityBitmaps)
+{
+    for (const uint64_t bufferSize : {64UL, 100UL, 1000UL, 4096UL, 8192UL, 100000UL})
+    {
+        const auto schema = Schema{}
+                                .addField("a", DataType::Type::UINT8, DataType::NULLABLE::IS_NULLABLE)
+                                .addField("b", DataType::Type::UINT64)
+                                .addField("c", DataType::Type::INT16, DataType::NULLABLE::IS_NULLABLE);
+        const auto layout = ColumnarLayout::create(schema, bufferSize);
+        const auto bitmapSize = ((layout.capacity + 63) / 64) * 8;
+        const auto valuesEnd = layout.columns[2].valueOffset + (2 * layout.capacity);
+
+        ASSERT_TRUE(layout.columns[0].validityOffset.has_value());
+        ASSERT_TRUE(layout.columns[2].validityOffset.has_value());
+        EXPECT_FALSE(layout.columns[1].validityOffset.has_value());
+        EXPECT_EQ(layout.columns[1].valueOffset, layout.capacity);
+        EXPECT_EQ(layout.columns[0].validityOffset.value() % 8, 0) << bufferSize;
+        EXPECT_GE(layout.columns[0].validityOffset.value(), valuesEnd) << bufferSize;
+        EXPECT_EQ(layout.columns[2].validityOffset.value(), layout.columns[0].validityOffset.value() + bitmapSize) << bufferSize;
+        EXPECT_LE(layout.columns[2].validityOffset.value() + bitmapSize, bufferSize) << bufferSize;
+
+        /// A null byte per value would fit fewer tuples
+        EXPECT_GE(layout.capacity, bufferSize / 14) << bufferSize;
+    }
+}
+
+TEST(ColumnarLayoutTest, IsValidReadsTheBitOfTheTuple)
+{
+    std::array<uint64_t, 2> bitmap{0b101, uint64_t{1} << 63};
+    const auto* validityBitmap = reinterpret_cast<const std::byte*>(bitmap.data());
+    EXPECT_TRUE(ColumnarLayout::isValid(validityBitmap, 0));
+    EXPECT_FALSE(ColumnarLayout::isValid(validityBitmap, 1));
+    EXPECT_TRUE(ColumnarLayout::isValid(validityBitmap, 2));
+    EXPECT_FALSE(ColumnarLayout::isValid(validityBitmap, 64));
+    EXPECT_TRUE(ColumnarLayout::isValid(validityBitmap, 127));
+}
+
+}
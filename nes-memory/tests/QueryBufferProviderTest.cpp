@@ -0,0 +1,160 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+#include <Runtime/BufferManager.hpp>
+#include <Runtime/QueryBufferProvider.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <gtest/gtest.h>
+
+namespace NES
+{
+
+namespace
+{
+constexpr size_t BUFFER_SIZE = 4096;
+constexpr size_t NUMBER_OF_BUFFERS = 64;
+}
+
+TEST(QueryBufferProviderTest, AccountsPooledAndUnpooledBuffers)
+{
+    const auto bufferManager = BufferManager::create(BUFFER_SIZE, NUMBER_OF_BUFFERS);
+    const auto queryBufferProvider = QueryBufferProvider::create(bufferManager, 1024 * BUFFER_SIZE, [](bool) { FAIL(); });
+
+    std::vector<TupleBuffer> buffers;
+    buffers.emplace_back(queryBufferProvider->getBufferBlocking());
+    buffers.emplace_back(*queryBufferProvider->getBufferNoBlocking());
+    EXPECT_EQ(queryBufferProvider->getNumberOfUsedBytes(), 2 * BUFFER_SIZE);
+    EXPECT_EQ(bufferManager->getNumberOfAvailableBuffers(), NUMBER_OF_BUFFERS - 2);
+
+    /// Unpooled buffers are accounted with their aligned size
+    auto unpooledBuffer = queryBufferProvider->getUnpooledBuffer(100);
+    ASSERT_TRUE(unpooledBuffer.has_value());
+    EXPECT_EQ(queryBufferProvider->getNumberOfUsedBytes(), (2 * BUFFER_SIZE) + 128);
+
+    /// Child buffers stay accounted until their parent is released
+    [[maybe_unused]] const auto childIndex = buffers.front().storeChildBuffer(*unpooledBuffer);
+    unpooledBuffer.reset();
+    EXPECT_EQ(buffers.front().getNumberOfChildBuffers(), 1);
+    EXPECT_EQ(queryBufferProvider->getNumberOfUsedBytes(), (2 * BUFFER_SIZE) + 128);
+
+    buffers.clear();
+    EXPECT_EQ(queryBufferProvider->getNumberOfUsedBytes(), 0);
+    EXPECT_EQ(bufferManager->getNumberOfAvailableBuffers(), NUMBER_OF_BUFFERS);
+
+    /// Buffers requested directly from the BufferManager are not accounted
+    const auto buffer = bufferManager->getBufferBlocking();
+    EXPECT_EQ(queryBufferProvider->getNumberOfUsedBytes(), 0);
+}
+
+TEST(QueryBufferProviderTest, AccountsUnpooledBuffersWithTheirSizeClass)
+{
+    const auto bufferManager = BufferManager::create(BUFFER_SIZE, NUMBER_OF_BUFFERS);
+    bufferManager->enableSizeClasses(BufferManager::DEFAULT_SIZE_CLASSES, 1);
+    const auto queryBufferProvider = QueryBufferProvider::create(bufferManager, 1024 * BUFFER_SIZE, [](bool) { FAIL(); });
+
+    auto sizeClassBuffer = queryBufferProvider->getUnpooledBuffer(100);
+    EXPECT_EQ(queryBufferProvider->getNumberOfUsedBytes(), BufferManager::DEFAULT_SIZE_CLASSES.front());
+    /// The size class is exhausted, thus the buffer is allocated on the spot
+    auto unpooledBuffer = queryBufferProvider->getUnpooledBuffer(100);
+    EXPECT_EQ(queryBufferProvider->getNumberOfUsedBytes(), BufferManager::DEFAULT_SIZE_CLASSES.front() + 128);
+
+    sizeClassBuffer.reset();
+    unpooledBuffer.reset();
+    EXPECT_EQ(queryBufferProvider->getNumberOfUsedBytes(), 0);
+    EXPECT_EQ(bufferManager->getNumberOfAvailableSizeClassBuffers(BufferManager::DEFAULT_SIZE_CLASSES.front()), 1);
+}
+
+TEST(QueryBufferProviderTest, NotifiesWhenQuotaIsExceededAndReleased)
+{
+    const auto bufferManager = BufferManager::create(BUFFER_SIZE, NUMBER_OF_BUFFERS);
+    std::vector<bool> notifications;
+    const auto queryBufferProvider
+        = QueryBufferProvider::create(bufferManager, 2 * BUFFER_SIZE, [&](const bool exceeded) { notifications.push_back(exceeded); });
+
+    std::vector<TupleBuffer> buffers;
+    buffers.emplace_back(queryBufferProvider->getBufferBlocking());
+    buffers.emplace_back(queryBufferProvider->getBufferBlocking());
+    EXPECT_TRUE(notifications.empty());
+
+    buffers.emplace_back(queryBufferProvider->getBufferBlocking());
+    buffers.emplace_back(queryBufferProvider->getBufferBlocking());
+    EXPECT_EQ(notifications, std::vector<bool>{true});
+
+    /// The query is back within its quota once it holds at most quota many bytes
+    buffers.pop_back();
+    EXPECT_EQ(notifications, std::vector<bool>{true});
+    buffers.pop_back();
+    EXPECT_EQ(notifications, (std::vector<bool>{true, false}));
+
+    auto unpooledBuffer = queryBufferProvider->getUnpooledBuffer(1);
+    EXPECT_EQ(notifications, (std::vector<bool>{true, false, true}));
+    unpooledBuffer.reset();
+    EXPECT_EQ(notifications, (std::vector<bool>{true, false, true, false}));
+}
+
+TEST(QueryBufferProviderTest, BuffersOutliveTheProvider)
+{
+    const auto bufferManager = BufferManager::create(BUFFER_SIZE, NUMBER_OF_BUFFERS);
+    std::optional<TupleBuffer> pooledBuffer;
+    std::optional<TupleBuffer> unpooledBuffer;
+    {
+        const auto queryBufferProvider = QueryBufferProvider::create(bufferManager, BUFFER_SIZE, [](bool) { });
+        pooledBuffer = queryBufferProvider->getBufferBlocking();
+        unpooledBuffer = queryBufferProvider->getUnpooledBuffer(2 * BUFFER_SIZE);
+    }
+    pooledBuffer.reset();
+    unpooledBuffer.reset();
+    EXPECT_EQ(bufferManager->getNumberOfAvailableBuffers(), NUMBER_OF_BUFFERS);
+}
+
+TEST(QueryBufferProviderTest, ConcurrentAccessConvergesToTheActualUsage)
+{
+    constexpr size_t numberOfThreads = 8;
+    constexpr size_t iterations = 1000;
+    const auto bufferManager = BufferManager::create(BUFFER_SIZE, NUMBER_OF_BUFFERS);
+    std::vector<bool> notifications;
+    const auto queryBufferProvider
+        = QueryBufferProvider::create(bufferManager, 4 * BUFFER_SIZE, [&](const bool exceeded) { notifications.push_back(exceeded); });
+
+    std::vector<std::jthread> threads;
+    threads.reserve(numberOfThreads);
+    for (size_t threadIdx = 0; threadIdx < numberOfThreads; ++threadIdx)
+    {
+        threads.emplace_back(
+            [&]
+            {
+                for (size_t i = 0; i < iterations; ++i)
+                {
+                    const auto pooledBuffer = queryBufferProvider->getBufferBlocking();
+                    const auto unpooledBuffer = queryBufferProvider->getUnpooledBuffer(i + 1);
+                }
+            });
+    }
+    threads.clear();
+
+    EXPECT_EQ(queryBufferProvider->getNumberOfUsedBytes(), 0);
+    /// Notifications alternate and end with the query being back within its quota
+    for (size_t i = 0; i < notifications.size(); ++i)
+    {
+        EXPECT_EQ(notifications[i], i % 2 == 0);
+    }
+    EXPECT_EQ(notifications.size() % 2, 0);
+}
+
+}
@@ -0,0 +1,111 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+#include <Runtime/Allocator/SpillFileMemoryResource.hpp>
+#include <gtest/gtest.h>
+
+namespace NES
+{
+
+namespace
+{
+constexpr size_t MEGABYTE = 1024 * 1024;
+
+void fill(void* memory, const size_t bytes, const uint8_t seed)
+{
+    auto* data = static_cast<uint8_t*>(memory);
+    for (size_t i = 0; i < bytes; ++i)
+    {
+        data[i] = static_cast<uint8_t>(i + seed); /// NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+}
+
+bool hasContent(const void* memory, const size_t bytes, const uint8_t seed)
+{
+    const auto* data = static_cast<const uint8_t*>(memory);
+    for (size_t i = 0; i < bytes; ++i)
+    {
+        if (data[i] != static_cast<uint8_t>(i + seed)) /// NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+TEST(SpillFileMemoryResourceTest, AllocationsWithinBudgetAreNotSpilled)
+{
+    SpillFileMemoryResource resource(std::filesystem::temp_directory_path(), 4 * MEGABYTE);
+    void* first = resource.allocate(MEGABYTE, 64);
+    void* second = resource.allocate(MEGABYTE, 64);
+    EXPECT_EQ(resource.getAllocatedBytes(), 2 * MEGABYTE);
+    EXPECT_EQ(resource.getUnspilledBytes(), 2 * MEGABYTE);
+    EXPECT_EQ(resource.getSpilledBytes(), 0);
+
+    resource.deallocate(first, MEGABYTE, 64);
+    resource.deallocate(second, MEGABYTE, 64);
+    EXPECT_EQ(resource.getAllocatedBytes(), 0);
+    EXPECT_EQ(resource.getUnspilledBytes(), 0);
+}
+
+/// Exceeding the budget spills the oldest allocations down to half of the budget. Spilled memory keeps its content and address.
+TEST(SpillFileMemoryResourceTest, SpilledAllocationsKeepTheirContent)
+{
+    constexpr size_t numberOfAllocations = 8;
+    SpillFileMemoryResource resource(std::filesystem::temp_directory_path(), 2 * MEGABYTE);
+    std::vector<void*> allocations;
+    for (size_t i = 0; i < numberOfAllocations; ++i)
+    {
+        allocations.emplace_back(resource.allocate(MEGABYTE, 64));
+        fill(allocations.back(), MEGABYTE, static_cast<uint8_t>(i));
+        EXPECT_LE(resource.getUnspilledBytes(), 2 * MEGABYTE);
+    }
+    EXPECT_EQ(resource.getAllocatedBytes(), numberOfAllocations * MEGABYTE);
+    EXPECT_EQ(resource.getSpilledBytes() + resource.getUnspilledBytes(), numberOfAllocations * MEGABYTE);
+    EXPECT_GT(resource.getSpilledBytes(), 0);
+
+    for (size_t i = 0; i < numberOfAllocations; ++i)
+    {
+        EXPECT_TRUE(hasContent(allocations[i], MEGABYTE, static_cast<uint8_t>(i))) << "Allocation " << i;
+    }
+
+    /// Spilled allocations can be written again after they got paged back in
+    fill(allocations.front(), MEGABYTE, 42);
+    EXPECT_TRUE(hasContent(allocations.front(), MEGABYTE, 42));
+
+    for (auto* allocation : allocations)
+    {
+        resource.deallocate(allocation, MEGABYTE, 64);
+    }
+    EXPECT_EQ(resource.getAllocatedBytes(), 0);
+    EXPECT_EQ(resource.getUnspilledBytes(), 0);
+}
+
+/// Allocations are rounded up to whole pages, as each allocation is a separate mapping
+TEST(SpillFileMemoryResourceTest, SmallAllocationsUseWholePages)
+{
+    SpillFileMemoryResource resource(std::filesystem::temp_directory_path(), MEGABYTE);
+    void* memory = resource.allocate(10, 8);
+    EXPECT_GE(resource.getAllocatedBytes(), 10);
+    fill(memory, 10, 3);
+    EXPECT_TRUE(hasContent(memory, 10, 3));
+    resource.deallocate(memory, 10, 8);
+}
+
+}
@@ -149,4 +149,23 @@ TEST(UnpooledBufferTests, MultipleUnpooledBufferMultithreaded)
     runAllocations(numberOfRandomAllocationSizes, minAllocationSize, maxAllocationSize, numberOfThreads);
 }
 
+/// The chunks that back unpooled buffers are deallocated once their last buffer is released
+TEST(UnpooledBufferTests, UnpooledBytesFollowAllocations)
+{
+    const auto bufferManager = BufferManager::create(1, 1);
+    EXPECT_EQ(bufferManager->getNumberOfUnpooledBytes(), 0);
+
+    auto allocations = createRandomSizeAllocations(100, 10, 100 * 1024);
+    size_t neededBytes = 0;
+    for (auto& allocation : allocations)
+    {
+        allocation.buffer = bufferManager->getUnpooledBuffer(allocation.neededSize);
+        neededBytes += allocation.neededSize;
+    }
+    EXPECT_GE(bufferManager->getNumberOfUnpooledBytes(), neededBytes);
+
+    allocations.clear();
+    EXPECT_EQ(bufferManager->getNumberOfUnpooledBytes(), 0);
+}
+
 }
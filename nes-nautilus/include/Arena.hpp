@@ -32,20 +32,30 @@ namespace NES
 /// The arena is a memory management system that provides memory to the operators during a pipeline invocation.
 /// As the memory is destroyed / returned to the arena after the pipeline invocation, the memory is not persistent and thus, it is not
 /// suitable for storing state across pipeline invocations. For storing state across pipeline invocations, the operator handler should be used.
+/// An arena can be reused across pipeline invocations by resetting it in between, which keeps some of its fixed size buffers.
 struct Arena
 {
+    /// The number of fixed size buffers that a reset keeps for the next pipeline invocation
+    static constexpr size_t NUMBER_OF_RETAINED_BUFFERS = 2;
+
     explicit Arena(std::shared_ptr<AbstractBufferProvider> bufferProvider) : bufferProvider(std::move(bufferProvider)) { }
 
     /// Allocating memory by the buffer provider. There are three cases:
     /// 1. The required size is larger than the buffer provider's buffer size. In this case, we allocate an unpooled buffer.
-    /// 2. The required size is larger than the last buffer size. In this case, we allocate a new buffer of fixed size.
-    /// 3. The required size is smaller than the last buffer size. In this case, we return the pointer to the address in the last buffer.
+    /// 2. The required size does not fit into the current buffer. In this case, we move on to the next retained buffer or allocate a new
+    ///    buffer of fixed size.
+    /// 3. The required size fits into the current buffer. In this case, we return the pointer to the address in the current buffer.
     std::span<std::byte> allocateMemory(size_t sizeInBytes);
 
+    /// Invalidates all allocated memory. Releases the unpooled buffers and all but numberOfRetainedBuffers fixed size buffers, which
+    /// later allocations reuse without requesting buffers from the buffer provider.
+    void reset(size_t numberOfRetainedBuffers = NUMBER_OF_RETAINED_BUFFERS);
+
     std::shared_ptr<AbstractBufferProvider> bufferProvider;
     std::vector<TupleBuffer> fixedSizeBuffers;
     std::vector<TupleBuffer> unpooledBuffers;
-    size_t lastAllocationSize{0};
+    /// The number of fixed size buffers that hold allocated memory. The last of them is the current buffer.
+    size_t numberOfUsedBuffers{0};
     size_t currentOffset{0};
 };
 
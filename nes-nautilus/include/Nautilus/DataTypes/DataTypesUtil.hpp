@@ -145,6 +145,27 @@ inline const std::unordered_map<DataType::Type, std::function<VarVal(const VarVa
              doubleValue.writeToMemory(memoryReference);
              return value;
          }},
+        {DataType::Type::TIMESTAMP,
+         [](const VarVal& value, const nautilus::val<int8_t*>& memoryReference)
+         {
+             const VarVal timestampValue{value.getRawValueAs<nautilus::val<uint64_t>>()};
+             timestampValue.writeToMemory(memoryReference);
+             return value;
+         }},
+        {DataType::Type::INTERVAL,
+         [](const VarVal& value, const nautilus::val<int8_t*>& memoryReference)
+         {
+             const VarVal intervalValue{value.getRawValueAs<nautilus::val<int64_t>>()};
+             intervalValue.writeToMemory(memoryReference);
+             return value;
+         }},
+        {DataType::Type::DECIMAL,
+         [](const VarVal& value, const nautilus::val<int8_t*>& memoryReference)
+         {
+             const VarVal decimalValue{value.getRawValueAs<nautilus::val<int64_t>>()};
+             decimalValue.writeToMemory(memoryReference);
+             return value;
+         }},
         {DataType::Type::UNDEFINED, nullptr},
 };
 
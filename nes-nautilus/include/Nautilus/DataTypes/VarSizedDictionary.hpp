@@ -0,0 +1,94 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace NES
+{
+
+/// Interns the distinct values of VARSIZED fields, i.e., it stores every distinct value exactly once, so that the VariableSizedData of
+/// equal values point to the same bytes. The address of an interned value thus acts as its dictionary code: equal values have equal
+/// addresses and the hash of a value is computed once, when interning it.
+/// Sources intern the values of their VARSIZED fields within the pipeline that formats them (see SourceDescriptor::dictionaryEncoding).
+/// Their pipeline breakers and sinks copy the bytes of the values (decode them), so these codes never leave the pipeline.
+/// Hash maps intern their VARSIZED keys in a dictionary of the query and store only the addresses (see FieldOffsets::varSizedDictionary).
+/// An entry stores the bytes of the value, padded to a multiple of eight bytes, followed by the MurMur3 hash of the value.
+/// Interning is thread-safe. All interned values stay valid until the dictionary is destroyed.
+class VarSizedDictionary
+{
+    static constexpr size_t NUMBER_OF_SHARDS = 16;
+
+public:
+    static constexpr uint64_t DEFAULT_MAX_NUMBER_OF_ENTRIES = 1UL << 20U;
+    static constexpr uint64_t UNBOUNDED_NUMBER_OF_ENTRIES = std::numeric_limits<uint64_t>::max();
+
+    explicit VarSizedDictionary(uint64_t maxNumberOfEntries = DEFAULT_MAX_NUMBER_OF_ENTRIES);
+
+    /// Returns the address of the interned copy of the value
+    /// Throws a FormattingError, if interning the value exceeds the maximum number of entries, i.e., if the field is not low-cardinality
+    [[nodiscard]] int8_t* intern(std::string_view value);
+
+    /// Returns the offset of the cached hash relative to the address of an interned value of the given size
+    /// Takes a uint64_t or a nautilus::val<uint64_t>, so that compiled pipelines compute the same offset
+    template <typename Size>
+    [[nodiscard]] static constexpr Size getOffsetOfHash(const Size& size)
+    {
+        return (size + Size{sizeof(uint64_t) - 1}) & Size{~(sizeof(uint64_t) - 1)};
+    }
+
+    /// Distinguishes the values of this dictionary from the values of other dictionaries during tracing
+    [[nodiscard]] uint64_t getId() const { return id; }
+
+    [[nodiscard]] uint64_t getNumberOfEntries() const;
+
+private:
+    struct Key
+    {
+        std::string_view value;
+        uint64_t hash;
+        bool operator==(const Key& other) const { return value == other.value; }
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const { return key.hash; }
+    };
+
+    struct Shard
+    {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<Key, int8_t*, KeyHash> entries;
+        std::vector<std::unique_ptr<uint64_t[]>> storage; /// NOLINT(modernize-avoid-c-arrays)
+    };
+
+    uint64_t id;
+    uint64_t maxNumberOfEntriesPerShard;
+    std::array<Shard, NUMBER_OF_SHARDS> shards;
+};
+
+/// Proxy function that interns values during the execution of the compiled pipeline
+/// NULL values (nullptr) share the interned empty value, so that every value tagged with the dictionary is followed by its hash
+int8_t* internVarSizedProxy(VarSizedDictionary* dictionary, const int8_t* fieldAddress, uint64_t fieldSize);
+
+}
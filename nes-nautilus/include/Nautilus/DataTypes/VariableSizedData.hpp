@@ -15,7 +15,10 @@
 #pragma once
 
 #include <cstdint>
+#include <optional>
 #include <Nautilus/Interface/NESStrongTypeRef.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Runtime/VariableSizedAccess.hpp>
 #include <nautilus/std/sstream.h>
 #include <nautilus/val.hpp>
 
@@ -31,8 +34,30 @@ nautilus::val<bool> operator==(const nautilus::val<bool>& other, const VariableS
 class VariableSizedData
 {
 public:
+    /// The buffer and the access of a value that was loaded from a child buffer. It allows buffer refs that share variable sized data to
+    /// reference the value in the child buffer instead of copying it (see TupleBufferRef::enableVarSizedSharing).
+    struct Origin
+    {
+        nautilus::val<TupleBuffer*> buffer;
+        nautilus::val<VariableSizedAccess*> access;
+    };
+
     explicit VariableSizedData(const nautilus::val<int8_t*>& reference, const nautilus::val<uint64_t>& size);
+    /// Creates a VariableSizedData whose prefix is known, e.g., as it was stored next to the size (see VariableSizedAccess::prefix)
+    explicit VariableSizedData(
+        const nautilus::val<int8_t*>& reference, const nautilus::val<uint64_t>& size, const nautilus::val<uint32_t>& prefix);
+    explicit VariableSizedData(
+        const nautilus::val<int8_t*>& reference, const nautilus::val<uint64_t>& size, const nautilus::val<uint32_t>& prefix, Origin origin);
+    /// Creates a VariableSizedData that points to a value that the dictionary with the given id has interned (see VarSizedDictionary)
+    explicit VariableSizedData(const nautilus::val<int8_t*>& reference, const nautilus::val<uint64_t>& size, uint64_t dictionaryId);
+    explicit VariableSizedData(
+        const nautilus::val<int8_t*>& reference,
+        const nautilus::val<uint64_t>& size,
+        const nautilus::val<uint32_t>& prefix,
+        uint64_t dictionaryId);
     VariableSizedData(const VariableSizedData& other) = default;
+    /// Assigning a value drops its prefix and its origin, as the assignment might merge the values of two branches during tracing, e.g.,
+    /// of a conditional, whereas they are only known for the traced branch.
     VariableSizedData& operator=(const VariableSizedData& other) noexcept;
     VariableSizedData(VariableSizedData&& other) noexcept;
     VariableSizedData& operator=(VariableSizedData&& other) noexcept;
@@ -40,6 +65,19 @@ public:
     [[nodiscard]] nautilus::val<uint64_t> getSize() const;
     /// Returns the content of the variable sized data, this means the pointer to the actual variable sized data.
     [[nodiscard]] nautilus::val<int8_t*> getContent() const;
+    /// Interned values are stored exactly once by their dictionary and are followed by their hash.
+    /// As this is known during tracing, it does not cost anything during execution.
+    [[nodiscard]] bool isInterned() const;
+    /// Returns the id of the dictionary that has interned the value or zero, if the value is not interned. Known during tracing.
+    [[nodiscard]] uint64_t getDictionaryId() const;
+    /// Returns the origin of a value that is unchanged since it was loaded from a child buffer. Known during tracing.
+    [[nodiscard]] const std::optional<Origin>& getOrigin() const;
+    /// Returns the first VariableSizedAccess::PREFIX_SIZE bytes of the value, padded with zeros.
+    /// Reads them from the content, if the prefix is not known.
+    [[nodiscard]] nautilus::val<uint32_t> getPrefix() const;
+    [[nodiscard]] bool hasPrefix() const;
+    /// Computes the prefix of the value with the given size
+    static uint32_t computePrefix(const int8_t* content, uint64_t size);
 
     /// Declaring friend for it, so that we can access the members in it and do not have to declare getters for it
     friend nautilus::val<std::ostream>& operator<<(nautilus::val<std::ostream>& oss, const VariableSizedData& variableSizedData);
@@ -48,6 +86,9 @@ public:
 
     /// Performing an equality check between two VariableSizedData objects. Two VariableSizedData objects are equal if their size and
     /// content are byte-wise equal. To check the equality of the content, we compare the content byte-wise via a memcmp.
+    /// Values that the same dictionary has interned are equal, if they point to the same bytes.
+    /// If the prefixes of both values are known, unequal prefixes reject the values before, and equal prefixes of values that are not
+    /// longer than the prefix accept them without comparing the content.
     nautilus::val<bool> operator==(const VariableSizedData&) const;
     nautilus::val<bool> operator!=(const VariableSizedData&) const;
     nautilus::val<bool> operator!() const;
@@ -56,6 +97,10 @@ public:
 private:
     nautilus::val<uint64_t> size;
     nautilus::val<int8_t*> ptrToVarSized;
+    /// Zero, if the value is not interned
+    uint64_t dictionaryId{0};
+    std::optional<nautilus::val<uint32_t>> prefix;
+    std::optional<Origin> origin;
 };
 
 
@@ -0,0 +1,74 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <Nautilus/Interface/Hash/HashFunction.hpp>
+
+namespace NES
+{
+
+/// Counts how well a bloom filter avoided the lookups of keys that have no join partner
+struct BloomFilterStatistics
+{
+    /// Number of keys that the bloom filter proved to be absent
+    uint64_t numberOfRejectedKeys{0};
+    /// Number of keys that passed the bloom filter but are absent
+    uint64_t numberOfFalsePositives{0};
+
+    BloomFilterStatistics& operator+=(const BloomFilterStatistics& other);
+
+    /// Returns the share of absent keys that passed the bloom filter or 0, if no absent key has been looked up
+    [[nodiscard]] double getFalsePositiveRate() const;
+};
+
+/// Forward declaration of the BlockedBloomFilterRef, to avoid cyclic dependencies between BlockedBloomFilter and BlockedBloomFilterRef
+class BlockedBloomFilterRef;
+
+/// Register-blocked bloom filter over hash values, i.e., each hash sets NUMBER_OF_BITS_PER_HASH bits in a single 64 bit word.
+/// Thus, an insert or a lookup touches exactly one word, so that a lookup is a single load and compare.
+/// The lower bits of the hash select the word. The bits within the word are selected by the bits 40 to 63 of the hash, as the hash join
+/// selects its radix partitions by the bits above 32. Otherwise, all keys of a partition would set the same bits in their words.
+/// To lookup hash values from nautilus, {@refitem BlockedBloomFilterRef.hpp} provides a Nautilus wrapper.
+///
+/// IMPORTANT: Inserts are thread-safe, as they set the bits atomically. Lookups must not run concurrently to inserts.
+class BlockedBloomFilter
+{
+public:
+    static constexpr uint64_t NUMBER_OF_BITS_PER_HASH = 4;
+    static constexpr uint64_t FIRST_HASH_BIT = 40;
+    /// Number of hash bits that select one of the 64 bits of a word
+    static constexpr uint64_t BITS_PER_POSITION = 6;
+    static constexpr uint64_t POSITION_MASK = 63;
+
+    /// Creates a bloom filter with at least expectedNumberOfKeys * bitsPerKey bits, rounded up to a power of two number of words
+    BlockedBloomFilter(uint64_t expectedNumberOfKeys, uint64_t bitsPerKey);
+
+    void insert(HashFunction::HashValue::raw_type hash);
+    [[nodiscard]] bool mayContain(HashFunction::HashValue::raw_type hash) const;
+    [[nodiscard]] uint64_t getNumberOfWords() const;
+
+    /// Returns the bits that the hash sets in its word
+    [[nodiscard]] static uint64_t getBitsOfHash(HashFunction::HashValue::raw_type hash);
+
+private:
+    friend class BlockedBloomFilterRef;
+    std::unique_ptr<uint64_t[]> wordSpace; /// NOLINT(cppcoreguidelines-avoid-c-arrays)
+    uint64_t* words; /// Raw pointer to the words, so that the BlockedBloomFilterRef can read them
+    uint64_t mask; /// Mask to calculate the word position from the hash value. Always a (power of 2)-1
+};
+
+}
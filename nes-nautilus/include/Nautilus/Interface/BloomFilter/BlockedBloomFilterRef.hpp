@@ -0,0 +1,39 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <Nautilus/Interface/BloomFilter/BlockedBloomFilter.hpp>
+#include <Nautilus/Interface/Hash/HashFunction.hpp>
+#include <val.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+/// A nautilus wrapper to lookup hash values in a BlockedBloomFilter. The lookup is traced, so that it gets inlined into the pipeline.
+/// Inserts have to set the bits atomically and, thus, are done via BlockedBloomFilter::insert().
+class BlockedBloomFilterRef
+{
+public:
+    explicit BlockedBloomFilterRef(const nautilus::val<BlockedBloomFilter*>& bloomFilterRef);
+
+    /// Returns false, if the hash has definitely not been inserted into the bloom filter
+    [[nodiscard]] nautilus::val<bool> mayContain(const HashFunction::HashValue& hash) const;
+
+private:
+    nautilus::val<BlockedBloomFilter*> bloomFilterRef;
+};
+
+}
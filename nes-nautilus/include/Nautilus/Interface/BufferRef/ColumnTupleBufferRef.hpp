@@ -16,6 +16,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <optional>
 #include <vector>
 #include <DataTypes/DataType.hpp>
 #include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
@@ -30,7 +31,8 @@ class LowerSchemaProvider;
 namespace NES
 {
 
-/// Implements BufferRef. Provides columnar memory access.
+/// Implements BufferRef. Provides columnar memory access in the ColumnarLayout, i.e., nullable fields keep their null flags in a
+/// validity bitmap instead of a null byte before every value.
 class ColumnTupleBufferRef final : public TupleBufferRef
 {
     struct Field
@@ -39,12 +41,16 @@ class ColumnTupleBufferRef final : public TupleBufferRef
         DataType type;
         size_t dataTypeSize;
         uint64_t columnOffset;
+        /// Offset of the validity bitmap of a nullable field
+        std::optional<uint64_t> validityOffset;
     };
 
     std::vector<Field> fields;
+    /// The record slots of the fields, which are resolved once, so that reading and writing records does not hash the field names
+    std::vector<Record::FieldSlot> fieldSlots;
 
     /// Private constructor to prevent direct instantiation
-    explicit ColumnTupleBufferRef(std::vector<Field> fields, uint64_t tupleSize, uint64_t bufferSize);
+    explicit ColumnTupleBufferRef(std::vector<Field> fields, uint64_t capacity, uint64_t tupleSize, uint64_t bufferSize);
 
     /// Allow LowerSchemaProvider::lowerSchema() access to private constructor and Field
     friend class NES::LowerSchemaProvider;
@@ -57,6 +63,9 @@ public:
     [[nodiscard]] std::vector<Record::RecordFieldIdentifier> getAllFieldNames() const override;
     [[nodiscard]] std::vector<DataType> getAllDataTypes() const override;
 
+    /// Returns nullopt for nullable fields, as their null flags are not stored at fixed offsets in the buffer
+    [[nodiscard]] std::optional<FieldLocation> getFieldLocation(const Record::RecordFieldIdentifier& fieldName) const override;
+
     Record readRecord(
         const std::vector<Record::RecordFieldIdentifier>& projections,
         const RecordBuffer& recordBuffer,
@@ -16,6 +16,7 @@
 
 
 #include <cstdint>
+#include <optional>
 #include <vector>
 #include <DataTypes/DataType.hpp>
 #include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
@@ -40,6 +41,8 @@ class RowTupleBufferRef final : public TupleBufferRef
     };
 
     std::vector<Field> fields;
+    /// The record slots of the fields, which are resolved once, so that reading and writing records does not hash the field names
+    std::vector<Record::FieldSlot> fieldSlots;
 
     /// Private constructor to prevent direct instantiation
     explicit RowTupleBufferRef(std::vector<Field> fields, uint64_t tupleSize, uint64_t bufferSize);
@@ -57,6 +60,8 @@ public:
 
     [[nodiscard]] std::vector<DataType> getAllDataTypes() const override;
 
+    [[nodiscard]] std::optional<FieldLocation> getFieldLocation(const Record::RecordFieldIdentifier& fieldName) const override;
+
     Record readRecord(
         const std::vector<Record::RecordFieldIdentifier>& projections,
         const RecordBuffer& recordBuffer,
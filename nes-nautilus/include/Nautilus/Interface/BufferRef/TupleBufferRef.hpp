@@ -17,6 +17,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <span>
 
 #include <DataTypes/DataType.hpp>
@@ -43,19 +44,28 @@ protected:
     uint64_t capacity;
     uint64_t bufferSize;
     uint64_t tupleSize;
+    bool sharesVarSized = false;
 
 public:
     TupleBufferRef(uint64_t capacity, uint64_t bufferSize, uint64_t tupleSize);
     virtual ~TupleBufferRef();
 
     /// @brief Writes the variable sized data to the buffer
+    /// Values of up to VariableSizedAccess::INLINE_SIZE bytes are inlined in the returned access and do not require a child buffer.
+    /// Only appends to the last child buffer, if the buffer owns it exclusively, as it could be shared (see referenceVarSized).
     static VariableSizedAccess
     writeVarSized(TupleBuffer& tupleBuffer, AbstractBufferProvider& bufferProvider, std::span<const std::byte> varSizedValue);
 
+    /// @brief References the variable sized data of the source buffer in the buffer, without copying it
+    /// The buffer shares the child buffer of the value with the source. If the value lies in the same child buffer as the previously
+    /// referenced value, the buffer reuses its last child buffer.
+    static VariableSizedAccess
+    referenceVarSized(TupleBuffer& tupleBuffer, const TupleBuffer& sourceBuffer, VariableSizedAccess sourceAccess);
+
     /// @brief Reads the variable sized data and returns the pointer to the var sized data
-    /// @return Pointer to variable sized data
-    static std::span<std::byte>
-    loadAssociatedVarSizedValue(const TupleBuffer& tupleBuffer, VariableSizedAccess variableSizedAccess) noexcept;
+    /// @return Pointer to variable sized data, which points into the access for inlined values
+    static std::span<const std::byte>
+    loadAssociatedVarSizedValue(const TupleBuffer& tupleBuffer, const VariableSizedAccess& variableSizedAccess) noexcept;
 
     /// Reads a record from the given bufferAddress and recordIndex.
     /// @param projections: Stores what fields, the Record should contain. If {}, then Record contains all fields available
@@ -78,12 +88,29 @@ public:
         const nautilus::val<AbstractBufferProvider*>& bufferProvider) const
         = 0;
 
+    /// Stores variable sized values, which are unchanged since they were loaded from a child buffer, by referencing the child buffer
+    /// instead of copying the value, e.g., for the output of a projection or selection over strings. The written buffers keep the child
+    /// buffers of their input alive, thus only buffer refs whose buffers are short-lived, like the buffers of an emit, should share.
+    void enableVarSizedSharing();
+
     [[nodiscard]] uint64_t getCapacity() const;
     [[nodiscard]] uint64_t getBufferSize() const;
     [[nodiscard]] uint64_t getTupleSize() const;
     [[nodiscard]] virtual std::vector<Record::RecordFieldIdentifier> getAllFieldNames() const = 0;
     [[nodiscard]] virtual std::vector<DataType> getAllDataTypes() const = 0;
 
+    /// Describes where the values of a field are stored in a buffer, i.e., the value of the i-th record is at `offset + (i * stride)`
+    struct FieldLocation
+    {
+        DataType type;
+        uint64_t offset;
+        uint64_t stride;
+    };
+
+    /// Returns the location of the field, if all values of the field are stored at fixed offsets in the buffer.
+    /// Returns nullopt, if the field is not part of this layout or if the layout does not store fields at fixed offsets.
+    [[nodiscard]] virtual std::optional<FieldLocation> getFieldLocation(const Record::RecordFieldIdentifier& fieldName) const;
+
 protected:
     /// Currently, this method does not support Null handling. It loads an VarVal of type from the fieldReference
     /// We require the recordBuffer, as we store variable sized data in a childbuffer and therefore, we need access
@@ -93,12 +120,27 @@ protected:
     /// Currently, this method does not support Null handling. It stores an VarVal of type to the fieldReference
     /// We require the recordBuffer, as we store variable sized data in a childbuffer and therefore, we need access
     /// to the buffer if the type is of variable sized
-    static VarVal storeValue(
+    VarVal storeValue(
         const DataType& type,
         const RecordBuffer& recordBuffer,
         const nautilus::val<int8_t*>& fieldReference,
         VarVal value,
-        const nautilus::val<AbstractBufferProvider*>& bufferProvider);
+        const nautilus::val<AbstractBufferProvider*>& bufferProvider) const;
+
+    /// Loads the value at the valueReference, whose null flag the layout stores elsewhere, e.g., in a validity bitmap
+    static VarVal loadValueWithoutNullByte(
+        const DataType& type,
+        const RecordBuffer& recordBuffer,
+        const nautilus::val<int8_t*>& valueReference,
+        const nautilus::val<bool>& null);
+
+    /// Stores the value at the valueReference, without storing its null flag
+    VarVal storeValueWithoutNullByte(
+        const DataType& type,
+        const RecordBuffer& recordBuffer,
+        const nautilus::val<int8_t*>& valueReference,
+        VarVal value,
+        const nautilus::val<AbstractBufferProvider*>& bufferProvider) const;
 
     [[nodiscard]] static bool
     includesField(const std::vector<Record::RecordFieldIdentifier>& projections, const Record::RecordFieldIdentifier& fieldIndex);
@@ -0,0 +1,43 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/Hash/HashFunction.hpp>
+
+namespace NES
+{
+
+/// Perfect hash function for a single key of one byte, e.g., INT8 or BOOLEAN, or for wider keys from a small, dense range, e.g., an hour or
+/// a region id. It replicates the lowest two bytes of the key into all 16 bit groups of the hash. Thus, keys whose lowest two bytes
+/// differ in their lowest n bits have their own bucket in hash maps with at least 2^n buckets, which turns the hash map into a direct
+/// array. As every 16 bit group of the hash depends on the key, the partitions (upper bits) and the bloom filters of the hash joins still
+/// distinguish the keys.
+/// Wider values only contribute their lowest two bytes, and multiple values are combined via xor. Both are correct, but collide more often.
+/// Sparse keys collide even within two bytes, e.g., all multiples of 1024 share a bucket in a hash map with 1024 buckets. Thus, only
+/// HashFunctionType::DIRECT chooses it for keys wider than one byte.
+class DirectHashFunction : public HashFunction
+{
+public:
+    [[nodiscard]] HashValue init() const override;
+
+    [[nodiscard]] std::unique_ptr<HashFunction> clone() const override;
+
+protected:
+    /// Calculates the hash of value and xor-es it with hash
+    [[nodiscard]] HashValue calculate(HashValue& hash, const VarVal& value) const override;
+};
+}
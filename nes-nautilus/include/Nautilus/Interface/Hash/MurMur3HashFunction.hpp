@@ -12,6 +12,7 @@
     limitations under the License.
 */
 #pragma once
+#include <cstdint>
 #include <memory>
 #include <Nautilus/DataTypes/VarVal.hpp>
 #include <Nautilus/Interface/Hash/HashFunction.hpp>
@@ -19,6 +20,9 @@
 namespace NES
 {
 
+/// Hashes the bytes [data, data + length). Exposed, so that dictionaries can cache the hash of the VARSIZED values that they intern.
+uint64_t hashBytes(void* data, uint64_t length);
+
 /// Implementation of the MurMur3 hash function for nautilus types.
 /// This implementation is based on the hash functions of https://github.com/martinus/robin-hood-hashing/ and duckdb.
 class MurMur3HashFunction : public HashFunction
@@ -0,0 +1,47 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/Hash/HashFunction.hpp>
+
+namespace NES
+{
+
+/// Hash function in the style of XXH3 for nautilus types.
+/// Fixed size values are mixed with the multiply and xor-shift avalanche of XXH3 in the traced code, i.e., without a function call and
+/// with a single multiplication less than the MurMur3HashFunction. Variable sized values are hashed via XXH3 of the xxHash library,
+/// which is considerably faster than MurMur3 for longer values.
+/// In contrast to the MurMur3HashFunction, the hash of a value depends on its position among the hashed values. However, we do not read
+/// the hashes that dictionaries cache for interned values, as the dictionaries cache MurMur3 hashes.
+class XXH3HashFunction : public HashFunction
+{
+public:
+    static constexpr uint64_t SEED = UINT64_C(0x9e3779b185ebca87);
+    [[nodiscard]] HashValue init() const override;
+
+    [[nodiscard]] std::unique_ptr<HashFunction> clone() const override;
+
+    /// Batch entry point for the vectorized execution mode: hashes numberOfValues single-key values, that are already widened to uint64_t
+    /// like the nautilus values in calculate, into hashes. The loop has no control flow, so that the host compiler can auto-vectorize it.
+    /// The results equal calculate(VarVal(value)) of each value.
+    static void calculateBatch(const uint64_t* values, uint64_t numberOfValues, uint64_t* hashes);
+
+protected:
+    /// Calculates the hash of value based on hash
+    [[nodiscard]] HashValue calculate(HashValue& hash, const VarVal& value) const override;
+};
+}
@@ -15,12 +15,15 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <utility>
 #include <vector>
 #include <DataTypes/DataType.hpp>
 #include <DataTypes/Schema.hpp>
+#include <Nautilus/DataTypes/VarSizedDictionary.hpp>
 #include <Nautilus/DataTypes/VarVal.hpp>
 #include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMap.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
 #include <Nautilus/Interface/Record.hpp>
 #include <Runtime/AbstractBufferProvider.hpp>
 #include <val_concepts.hpp>
@@ -34,6 +37,9 @@ struct FieldOffsets
     Record::RecordFieldIdentifier fieldIdentifier;
     DataType type;
     uint64_t fieldOffset;
+    /// If set, the entry stores the address of the value that this dictionary has interned instead of a copy of a VARSIZED value.
+    /// Thus, equal values are stored once per query and comparing the values of entries compares their addresses.
+    std::shared_ptr<VarSizedDictionary> varSizedDictionary;
 };
 
 /// ChainedHashMapEntry uses for reading and writing either the keys or values.
@@ -45,10 +51,12 @@ public:
 
     /// We need to create the fields for the keys and values here, as we know here how the fields and the values are stored in the ChainedHashMapEntry.
     /// We can use here "normal" C++ values, as only the C++ runtime MUST call this method
+    /// If a dictionary is given, the VARSIZED keys get interned in it.
     static std::pair<std::vector<FieldOffsets>, std::vector<FieldOffsets>> createFieldOffsets(
         const Schema& schema,
         const std::vector<Record::RecordFieldIdentifier>& fieldNameKeys,
-        const std::vector<Record::RecordFieldIdentifier>& fieldNameValues);
+        const std::vector<Record::RecordFieldIdentifier>& fieldNameValues,
+        const std::shared_ptr<VarSizedDictionary>& keyDictionary = nullptr);
 
 
     [[nodiscard]] VarVal
@@ -56,12 +64,12 @@ public:
     [[nodiscard]] Record readRecord(const nautilus::val<ChainedHashMapEntry*>& entryRef) const;
     void writeRecord(
         const nautilus::val<ChainedHashMapEntry*>& entryRef,
-        const nautilus::val<ChainedHashMap*>& hashMapRef,
+        const nautilus::val<HashMap*>& hashMapRef,
         const nautilus::val<AbstractBufferProvider*>& bufferProvider,
         const Record& record) const;
     void writeEntryRef(
         const nautilus::val<ChainedHashMapEntry*>& entryRef,
-        const nautilus::val<ChainedHashMap*>& hashMapRef,
+        const nautilus::val<HashMap*>& hashMapRef,
         const nautilus::val<AbstractBufferProvider*>& bufferProvider,
         const nautilus::val<ChainedHashMapEntry*>& otherEntryRef) const;
 
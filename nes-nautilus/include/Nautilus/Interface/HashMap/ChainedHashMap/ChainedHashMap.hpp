@@ -51,8 +51,14 @@ public:
 /// The HashMap is distinguishing two memory areas:
 ///
 /// Entry Space:
-/// The entry space is fixed size and contains pointers into the storage space. The entry space operates as a starting point for each chain.
+/// The entry space contains pointers into the storage space. The entry space operates as a starting point for each chain.
 /// This means that the entry space can be thought of buckets in a hash table.
+/// Once the hash map contains more entries than chains, we double the number of chains. To not stall a single insert with rehashing all
+/// entries, we rehash incrementally: the old entry space is kept and every following insert moves a few of its chains into the new entry
+/// space. Until all chains are moved, a lookup uses the old chain, if the old chain has not been moved yet.
+/// The start of each chain carries a tag in the 16 most significant bits of its pointer, which pointers on x64, arm64 and ppc64 do not
+/// use. Every entry of the chain sets one bit of the tag, which depends on its hash. Thus, a lookup skips a chain that cannot contain the
+/// hash without dereferencing any entry of it, e.g., for most right entries of a join probe.
 ///
 /// Storage Space:
 /// The storage space contains individual key-value pairs. It does not support variable length keys or values for now.
@@ -78,30 +84,76 @@ public:
     ChainedHashMap(uint64_t keySize, uint64_t valueSize, uint64_t numberOfBuckets, uint64_t pageSize);
     ~ChainedHashMap() override;
     [[nodiscard]] ChainedHashMapEntry* findChain(HashFunction::HashValue::raw_type hash) const;
-    std::span<std::byte> allocateSpaceForVarSized(AbstractBufferProvider* bufferProvider, size_t neededSize);
+    std::span<std::byte> allocateSpaceForVarSized(AbstractBufferProvider* bufferProvider, size_t neededSize) override;
     AbstractHashMapEntry* insertEntry(HashFunction::HashValue::raw_type hash, AbstractBufferProvider* bufferProvider) override;
     [[nodiscard]] uint64_t getNumberOfTuples() const override;
     [[nodiscard]] const TupleBuffer& getPage(uint64_t pageIndex) const;
     [[nodiscard]] uint64_t getNumberOfPages() const;
+    [[nodiscard]] uint64_t getEntrySize() const;
+    /// Returns true, if entries point to variable sized data, which is stored outside of the pages of the storage space
+    [[nodiscard]] bool hasVarSizedData() const;
+    /// Inserts copies of the entries, e.g., of the entries of a page of another hash map with the same entry size. The copies keep the
+    /// hash, the keys and the values of the entries, but get linked into the chains of this hash map.
+    void insertCopiesOfEntries(std::span<const std::byte> entries, AbstractBufferProvider* bufferProvider);
+    /// Prefetches the chain starts and the first entries of the chains for the hashes of the consecutive entries of another hash map,
+    /// e.g., for a group of entries of a page, before looking them up one after the other.
+    void prefetchChains(std::span<const std::byte> otherEntries, uint64_t otherEntrySize) const;
+    /// Returns the start of the chain in the current entry space. While growing, chains that have not been moved yet are not part of it.
     [[nodiscard]] ChainedHashMapEntry* getStartOfChain(uint64_t entryIdx) const;
     [[nodiscard]] uint64_t getNumberOfChains() const;
+    /// Returns true, if the hash map has grown and not all chains have been moved to the new entry space
+    [[nodiscard]] bool isMigrating() const;
+    [[nodiscard]] HashMapGrowthStatistics getGrowthStatistics() const override;
 
     /// Clears and deletes all entries in the hash map. It also releases the memory of any allocated buffers or other memory.
-    void clear() noexcept;
+    void clear() noexcept override;
+    /// Clears all entries like clear(), but keeps the current chains, so that the hash map can be reused without allocating and growing
+    /// its chains again, e.g., for the next slice of a window.
+    void reset() noexcept;
 
     /// The passed method is being executed, once the destructor is called. This is necessary as the value type of this hash map
     /// might allocate its own memory. Thus, the destructor of the value type should be called to release the memory.
     void setDestructorCallback(const std::function<void(ChainedHashMapEntry*)>& callback);
 
     /// Creates a new chained hash map with the same configuration, i.e., pageSize, entrySize, entriesPerPage and numberOfChains
-    static std::unique_ptr<ChainedHashMap> createNewMapWithSameConfiguration(const ChainedHashMap& other);
+    [[nodiscard]] std::unique_ptr<HashMap> createNewMapWithSameConfiguration() const override;
 
 private:
     friend class ChainedHashMapRef;
 
     /// Specifies the number of pre-allocated var sized
     static constexpr auto NUMBER_OF_PRE_ALLOCATED_VAR_SIZED_ITEMS = 100;
+    /// We double the number of chains, once the hash map contains more than MAX_LOAD_FACTOR entries per chain
+    static constexpr uint64_t MAX_LOAD_FACTOR = 1;
+    /// Number of old chains that every insert moves to the new entry space. As doubling the chains of a hash map with n entries requires
+    /// n more inserts until the next doubling, moving at least one chain per insert finishes the migration before the next doubling.
+    static constexpr uint64_t CHAINS_MIGRATED_PER_INSERT = 2;
+    /// The tag of a chain start is stored in its bits [CHAIN_TAG_SHIFT, 64). The 4 most significant bits of a hash select its tag bit.
+    static constexpr uint64_t CHAIN_TAG_SHIFT = 48;
+    static constexpr uint64_t CHAIN_POINTER_MASK = (uint64_t{1} << CHAIN_TAG_SHIFT) - 1;
+    static constexpr uint64_t HASH_SHIFT_FOR_CHAIN_TAG = 60;
+
+    /// Returns the bit of the tag that an entry with the hash sets in the start of its chain
+    static constexpr uint64_t getChainTag(const HashFunction::HashValue::raw_type hash)
+    {
+        return uint64_t{1} << (CHAIN_TAG_SHIFT + (hash >> HASH_SHIFT_FOR_CHAIN_TAG));
+    }
+    /// Returns the pointer to the first entry of the tagged chain start
+    static ChainedHashMapEntry* untagChainStart(ChainedHashMapEntry* taggedChainStart);
+    /// Prepends the entry to the chain, whose tagged start is at chainStart, and adds the tag of the hash of the entry
+    static void prependToChain(ChainedHashMapEntry** chainStart, ChainedHashMapEntry* entry);
+
+    /// Allocates a zeroed entry space for numberOfChains chains
+    static TupleBuffer allocateEntrySpace(uint64_t numberOfChains, AbstractBufferProvider* bufferProvider);
+    /// Returns the address of the tagged start of the chain that the hash belongs to, i.e., either in the old or in the current entry space
+    [[nodiscard]] ChainedHashMapEntry** getChainStart(HashFunction::HashValue::raw_type hash) const;
+    /// Doubles the number of chains and keeps the current entry space as the old entry space
+    void grow(AbstractBufferProvider* bufferProvider);
+    /// Moves up to numberOfChainsToMigrate chains from the old entry space to the current entry space
+    void migrateChains(uint64_t numberOfChainsToMigrate);
+
     TupleBuffer entrySpace;
+    TupleBuffer oldEntrySpace;
     std::vector<TupleBuffer> storageSpace;
     std::vector<TupleBuffer> varSizedSpace;
     uint64_t numberOfTuples; /// Number of entries in the hash map
@@ -111,6 +163,10 @@ private:
     uint64_t numberOfChains; /// Number of buckets in the hash map
     ChainedHashMapEntry** entries; /// Stores the pointers to the first entry in each chain
     HashFunction::HashValue::raw_type mask; /// Mask to calculate the bucket position from the hash value. Always a (power of 2)-1
+    ChainedHashMapEntry** oldEntries; /// Stores the pointers to the first entry in each chain of the entry space before the last growth
+    uint64_t numberOfOldChains; /// Number of buckets before the last growth. Zero, if all chains have been moved to the current entries
+    uint64_t numberOfMigratedChains; /// The old chains [0, numberOfMigratedChains) have been moved to the current entries
+    HashMapGrowthStatistics growthStatistics;
     std::function<void(ChainedHashMapEntry*)> destructorCallBack; /// Callback function to be executed, once the destructor is called
 };
 }
@@ -52,15 +52,17 @@ public:
         [[nodiscard]] nautilus::val<int8_t*> getValueMemArea() const;
         [[nodiscard]] HashFunction::HashValue getHash() const;
         [[nodiscard]] nautilus::val<ChainedHashMapEntry*> getNext() const;
+        /// Returns true, if the keys of this entry are equal to the keys. Null values are equal to each other.
+        [[nodiscard]] nautilus::val<bool> compareKeys(const Record& keys) const;
         ChainedEntryRef(
             const nautilus::val<ChainedHashMapEntry*>& entryRef,
-            const nautilus::val<ChainedHashMap*>& hashMapRef,
+            const nautilus::val<HashMap*>& hashMapRef,
             std::vector<FieldOffsets> fieldsKey,
             std::vector<FieldOffsets> fieldsValue);
 
         ChainedEntryRef(
             const nautilus::val<ChainedHashMapEntry*>& entryRef,
-            const nautilus::val<ChainedHashMap*>& hashMapRef,
+            const nautilus::val<HashMap*>& hashMapRef,
             ChainedEntryMemoryProvider memoryProviderKeys,
             ChainedEntryMemoryProvider memoryProviderValues);
 
@@ -71,7 +73,7 @@ public:
 
 
         nautilus::val<ChainedHashMapEntry*> entryRef;
-        nautilus::val<ChainedHashMap*> hashMapRef;
+        nautilus::val<HashMap*> hashMapRef;
         ChainedEntryMemoryProvider memoryProviderKeys;
         ChainedEntryMemoryProvider memoryProviderValues;
     };
@@ -97,6 +99,7 @@ public:
         nautilus::val<ChainedHashMapEntry*> operator*() const;
 
     private:
+        friend class ChainedHashMapRef;
         nautilus::val<HashMap*> hashMapRef;
         nautilus::val<ChainedHashMapEntry*> currentEntry;
         nautilus::val<uint64_t> entrySize;
@@ -128,16 +131,27 @@ public:
         const std::function<void(nautilus::val<AbstractHashMapEntry*>&)>& onInsert,
         const nautilus::val<AbstractBufferProvider*>& bufferProvider) override;
     nautilus::val<AbstractHashMapEntry*> findEntry(const nautilus::val<AbstractHashMapEntry*>& otherEntry) override;
+    /// Looks up the keys of the record without inserting them, e.g., to probe a hash map that is read-only after it has been built.
+    /// Returns nullptr, if the hash map does not contain the keys.
+    [[nodiscard]] nautilus::val<ChainedHashMapEntry*> findEntry(const Record& recordKey, const HashFunction& hashFunction) const;
+    /// Looks up the keys of the record with their already calculated hash, e.g., to look up the same keys in multiple hash maps
+    [[nodiscard]] nautilus::val<ChainedHashMapEntry*> findEntry(const Record& recordKey, const HashFunction::HashValue& hash) const;
     [[nodiscard]] EntryIterator begin() const;
     [[nodiscard]] EntryIterator end() const;
+    /// Prefetches the chains of the next PREFETCH_GROUP_SIZE entries, if the iterator over the entries of another hash map is
+    /// at the start of a group. Calling this before looking up each entry of the other hash map overlaps the cache misses of a group.
+    void prefetchForEntries(const EntryIterator& otherEntries) const;
 
 
 private:
     /// Finds the chain for the given hash value. If no chain exists, it returns nullptr.
     [[nodiscard]] nautilus::val<ChainedHashMapEntry*> findChain(const HashFunction::HashValue& hash) const;
+    /// Reads the tagged chain start at entryStartPos of the entry space at entriesRef. Returns nullptr, if the tag of the chain start
+    /// shows that the chain contains no entry with the hash.
+    [[nodiscard]] static nautilus::val<ChainedHashMapEntry*> readChainStart(
+        const nautilus::val<int8_t*>& entriesRef, const nautilus::val<uint64_t>& entryStartPos, const HashFunction::HashValue& hash);
     nautilus::val<ChainedHashMapEntry*>
     insert(const HashFunction::HashValue& hash, const nautilus::val<AbstractBufferProvider*>& bufferProvider);
-    [[nodiscard]] nautilus::val<bool> compareKeys(const ChainedEntryRef& entryRef, const Record& keys) const;
     [[nodiscard]] nautilus::val<ChainedHashMapEntry*> findKey(const Record& recordKey, const HashFunction::HashValue& hash) const;
     [[nodiscard]] nautilus::val<ChainedHashMapEntry*> findEntry(const ChainedEntryRef& otherEntryRef) const;
 
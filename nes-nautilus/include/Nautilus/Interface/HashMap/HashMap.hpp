@@ -13,7 +13,10 @@
 */
 
 #pragma once
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <span>
 #include <Nautilus/Interface/Hash/HashFunction.hpp>
 #include <Runtime/AbstractBufferProvider.hpp>
 
@@ -26,11 +29,36 @@ public:
     virtual ~AbstractHashMapEntry() = default;
 };
 
+/// Describes how much work a hash map spent on growing, as it received more keys than expected when it was created
+struct HashMapGrowthStatistics
+{
+    uint64_t numberOfResizes{0}; /// Number of times the buckets of the hash map were doubled
+    uint64_t numberOfRehashedEntries{0}; /// Number of entries that were moved into the grown buckets
+
+    HashMapGrowthStatistics& operator+=(const HashMapGrowthStatistics& other)
+    {
+        numberOfResizes += other.numberOfResizes;
+        numberOfRehashedEntries += other.numberOfRehashedEntries;
+        return *this;
+    }
+};
+
 class HashMap
 {
 public:
+    /// Number of entries of another hash map, for which a probe prefetches the memory of this hash map at once. The cache misses of a
+    /// group overlap, while the prefetched lines stay in the cache until the probe of the group reaches them.
+    static constexpr uint64_t PREFETCH_GROUP_SIZE = 16;
+
     virtual ~HashMap() = default;
     virtual AbstractHashMapEntry* insertEntry(HashFunction::HashValue::raw_type hash, AbstractBufferProvider* bufferProvider) = 0;
     [[nodiscard]] virtual uint64_t getNumberOfTuples() const = 0;
+    /// Returns memory for variable sized keys or values that lives as long as the hash map
+    virtual std::span<std::byte> allocateSpaceForVarSized(AbstractBufferProvider* bufferProvider, size_t neededSize) = 0;
+    /// Creates a new empty hash map of the same type with the same configuration, e.g., entry size and page size
+    [[nodiscard]] virtual std::unique_ptr<HashMap> createNewMapWithSameConfiguration() const = 0;
+    [[nodiscard]] virtual HashMapGrowthStatistics getGrowthStatistics() const = 0;
+    /// Deletes all entries and releases their memory, so that the hash map can be reused
+    virtual void clear() noexcept = 0;
 };
 }
@@ -0,0 +1,131 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <span>
+#include <vector>
+#include <Nautilus/Interface/Hash/HashFunction.hpp>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMap.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/TupleBuffer.hpp>
+
+namespace NES
+{
+/// Forward declaration of the SwissHashMapRef, to avoid cyclic dependencies between SwissHashMap and SwissHashMapRef
+class SwissHashMapRef;
+
+/// Implementation of a single thread open-addressing HashMap in the style of the Swiss table of abseil
+/// (https://abseil.io/about/design/swisstables).
+/// To operate on the hash-map, {@refitem SwissHashMapRef.hpp} provides a Nautilus wrapper.
+///
+/// The HashMap is distinguishing three memory areas:
+///
+/// Control Bytes:
+/// One byte per slot. An empty slot is marked by EMPTY_SLOT, an occupied slot stores the lower 7 bits of the hash (h2).
+/// We probe linearly in groups of GROUP_SIZE control bytes, starting at the slot given by the remaining bits of the hash (h1).
+/// A whole group is compared against h2 with one SSE2 / NEON instruction, so that we only have to look at the entries, whose h2 matches.
+/// The first GROUP_SIZE control bytes are mirrored after the last slot, so that a group never has to wrap around.
+///
+/// Slots:
+/// Pointers into the storage space. In contrast to storing the entries in the slots, this keeps the references to the entries stable
+/// while the hash map grows, as the operators keep the references to the entries during the tracing of one record.
+///
+/// Storage Space:
+/// The storage space contains the individual key-value pairs. We reuse the layout of the ChainedHashMapEntry (without using the next pointer),
+/// so that the ChainedEntryMemoryProvider can read and write the keys and values of both hash maps.
+///
+/// In contrast to the ChainedHashMap, the number of slots is not fixed. Once the load factor would exceed MAX_LOAD_FACTOR, we double the
+/// number of slots and reinsert all entries. As we never delete single entries, we do not need any tombstones.
+///
+/// IMPORTANT:
+/// 1. This hash map is *NOT* thread save and allows for no concurrent accesses, as it does not use any locking, atomics or synchronization primitives.
+/// 2. This hash map does not clear the content of the entry. So it is up to the user to initialize values correctly.
+class SwissHashMap final : public HashMap
+{
+public:
+    /// Number of control bytes that are compared at once
+    static constexpr uint64_t GROUP_SIZE = 16;
+    /// Control byte of an empty slot. As the highest bit is set, it can never be equal to a h2 value
+    static constexpr uint8_t EMPTY_SLOT = 0x80;
+    /// Returned by findNextCandidateSlot, if there are no more candidates in the probe sequence
+    static constexpr uint64_t NO_SLOT = std::numeric_limits<uint64_t>::max();
+
+    SwissHashMap(uint64_t entrySize, uint64_t numberOfBuckets, uint64_t pageSize);
+    SwissHashMap(uint64_t keySize, uint64_t valueSize, uint64_t numberOfBuckets, uint64_t pageSize);
+    ~SwissHashMap() override;
+
+    /// Inserts a new entry for the hash. It expects that the caller has checked that the key of the new entry is not part of the hash map.
+    AbstractHashMapEntry* insertEntry(HashFunction::HashValue::raw_type hash, AbstractBufferProvider* bufferProvider) override;
+    [[nodiscard]] uint64_t getNumberOfTuples() const override;
+    std::span<std::byte> allocateSpaceForVarSized(AbstractBufferProvider* bufferProvider, size_t neededSize) override;
+
+    /// Returns the next slot in the probe sequence of the hash after previousSlot, whose entry has the same hash.
+    /// If previousSlot is NO_SLOT, we start at the first slot of the probe sequence. Returns NO_SLOT, once we reach an empty slot.
+    [[nodiscard]] uint64_t findNextCandidateSlot(HashFunction::HashValue::raw_type hash, uint64_t previousSlot) const;
+    [[nodiscard]] ChainedHashMapEntry* getEntryInSlot(uint64_t slot) const;
+    /// Prefetches the first group of control bytes and slots of the probe sequences for the hashes of the consecutive entries of another
+    /// hash map, e.g., for a group of entries of a page, before looking them up one after the other.
+    void prefetchProbeSequences(std::span<const std::byte> otherEntries, uint64_t otherEntrySize) const;
+    [[nodiscard]] const TupleBuffer& getPage(uint64_t pageIndex) const;
+    [[nodiscard]] uint64_t getNumberOfPages() const;
+    [[nodiscard]] uint64_t getNumberOfSlots() const;
+    [[nodiscard]] HashMapGrowthStatistics getGrowthStatistics() const override;
+
+    /// Clears and deletes all entries in the hash map. It also releases the memory of any allocated buffers or other memory.
+    void clear() noexcept override;
+
+    /// The passed method is being executed, once the destructor is called. This is necessary as the value type of this hash map
+    /// might allocate its own memory. Thus, the destructor of the value type should be called to release the memory.
+    void setDestructorCallback(const std::function<void(ChainedHashMapEntry*)>& callback);
+
+    /// Creates a new swiss hash map with the same configuration, i.e., pageSize, entrySize, entriesPerPage and initial number of slots
+    [[nodiscard]] std::unique_ptr<HashMap> createNewMapWithSameConfiguration() const override;
+
+private:
+    friend class SwissHashMapRef;
+
+    /// We grow the hash map, if more than 7/8 of the slots are occupied
+    static constexpr uint64_t MAX_LOAD_FACTOR_NUMERATOR = 7;
+    static constexpr uint64_t MAX_LOAD_FACTOR_DENOMINATOR = 8;
+    /// Specifies the number of pre-allocated var sized
+    static constexpr auto NUMBER_OF_PRE_ALLOCATED_VAR_SIZED_ITEMS = 100;
+
+    /// Allocates the control bytes and slots for newNumberOfSlots and reinserts all existing entries
+    void resize(uint64_t newNumberOfSlots, AbstractBufferProvider* bufferProvider);
+    void insertIntoEmptySlot(ChainedHashMapEntry* entry);
+    void setControlByte(uint64_t slot, uint8_t controlByte);
+
+    TupleBuffer slotSpace;
+    std::vector<TupleBuffer> storageSpace;
+    std::vector<TupleBuffer> varSizedSpace;
+    uint64_t numberOfTuples; /// Number of entries in the hash map
+    uint64_t pageSize; /// Size of one storage page in bytes
+    uint64_t entrySize; /// Size of one entry: sizeof(ChainedHashMapEntry) + keySize + valueSize
+    uint64_t entriesPerPage; /// Number of entries per page
+    uint64_t initialNumberOfSlots; /// Number of slots that get allocated for the first entry
+    uint64_t numberOfSlots; /// Current number of slots, zero until the first entry gets inserted. Always a power of 2
+    uint64_t mask; /// Mask to calculate the slot from the hash value. Always a (power of 2)-1
+    uint8_t* controlBytes; /// numberOfSlots + GROUP_SIZE control bytes
+    ChainedHashMapEntry** slots; /// Stores the pointers to the entries
+    HashMapGrowthStatistics growthStatistics;
+    std::function<void(ChainedHashMapEntry*)> destructorCallBack; /// Callback function to be executed, once the destructor is called
+};
+}
@@ -0,0 +1,114 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <Nautilus/Interface/Hash/HashFunction.hpp>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedEntryMemoryProvider.hpp>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMap.hpp>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMapRef.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Nautilus/Interface/HashMap/HashMapRef.hpp>
+#include <Nautilus/Interface/HashMap/SwissHashMap/SwissHashMap.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
+#include <val.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+/// A nautilus wrapper to operate on the swiss hash map.
+/// As the SwissHashMap stores its entries in the layout of the ChainedHashMapEntry, the entries can be accessed via a
+/// ChainedHashMapRef::ChainedEntryRef. The probing of the control bytes happens in the C++ runtime, as it uses SIMD instructions.
+class SwissHashMapRef final : public HashMapRef
+{
+public:
+    /// Iterator for iterating over all entries in the hash map.
+    /// The entries are stored consecutively in the pages of the storage space, thus, we iterate over all pages and not over the slots.
+    class EntryIterator
+    {
+    public:
+        EntryIterator(
+            const nautilus::val<HashMap*>& hashMapRef,
+            const nautilus::val<ChainedHashMapEntry*>& currentEntry,
+            const nautilus::val<uint64_t>& entrySize,
+            const nautilus::val<uint64_t>& tupleIndex,
+            const nautilus::val<uint64_t>& indexOnPage,
+            const nautilus::val<uint64_t>& numberOfTuplesInCurrentPage,
+            const nautilus::val<uint64_t>& pageIndex,
+            const nautilus::val<uint64_t>& numberOfPages);
+        EntryIterator& operator++();
+        nautilus::val<bool> operator==(const EntryIterator& other) const;
+        nautilus::val<bool> operator!=(const EntryIterator& other) const;
+        nautilus::val<ChainedHashMapEntry*> operator*() const;
+
+    private:
+        friend class SwissHashMapRef;
+        nautilus::val<HashMap*> hashMapRef;
+        nautilus::val<ChainedHashMapEntry*> currentEntry;
+        nautilus::val<uint64_t> entrySize;
+        nautilus::val<uint64_t> tupleIndex;
+        nautilus::val<uint64_t> indexOnPage;
+        nautilus::val<uint64_t> numberOfTuplesInCurrentPage;
+        nautilus::val<uint64_t> pageIndex;
+        nautilus::val<uint64_t> numberOfPages;
+    };
+
+    SwissHashMapRef(
+        const nautilus::val<HashMap*>& hashMapRef,
+        std::vector<FieldOffsets> fieldsKey,
+        std::vector<FieldOffsets> fieldsValue,
+        const nautilus::val<uint64_t>& entriesPerPage,
+        const nautilus::val<uint64_t>& entrySize);
+    SwissHashMapRef(const SwissHashMapRef& other);
+    SwissHashMapRef& operator=(const SwissHashMapRef& other);
+    ~SwissHashMapRef() override = default;
+
+    nautilus::val<AbstractHashMapEntry*> findOrCreateEntry(
+        const Record& recordKey,
+        const HashFunction& hashFunction,
+        const std::function<void(nautilus::val<AbstractHashMapEntry*>&)>& onInsert,
+        const nautilus::val<AbstractBufferProvider*>& bufferProvider) override;
+    void insertOrUpdateEntry(
+        const nautilus::val<AbstractHashMapEntry*>& otherEntry,
+        const std::function<void(nautilus::val<AbstractHashMapEntry*>&)>& onUpdate,
+        const std::function<void(nautilus::val<AbstractHashMapEntry*>&)>& onInsert,
+        const nautilus::val<AbstractBufferProvider*>& bufferProvider) override;
+    nautilus::val<AbstractHashMapEntry*> findEntry(const nautilus::val<AbstractHashMapEntry*>& otherEntry) override;
+    /// Looks up the keys of the record with their already calculated hash without inserting them. Returns nullptr, if the hash map
+    /// does not contain the keys.
+    [[nodiscard]] nautilus::val<ChainedHashMapEntry*> findEntry(const Record& recordKey, const HashFunction::HashValue& hash) const;
+    [[nodiscard]] EntryIterator begin() const;
+    [[nodiscard]] EntryIterator end() const;
+    /// Prefetches the probe sequences of the next PREFETCH_GROUP_SIZE entries, if the iterator over the entries of another hash map is
+    /// at the start of a group. Calling this before looking up each entry of the other hash map overlaps the cache misses of a group.
+    void prefetchForEntries(const EntryIterator& otherEntries) const;
+
+private:
+    using ChainedEntryRef = ChainedHashMapRef::ChainedEntryRef;
+
+    nautilus::val<ChainedHashMapEntry*>
+    insert(const HashFunction::HashValue& hash, const nautilus::val<AbstractBufferProvider*>& bufferProvider);
+    [[nodiscard]] nautilus::val<ChainedHashMapEntry*> findKey(const Record& recordKey, const HashFunction::HashValue& hash) const;
+
+    std::vector<FieldOffsets> fieldKeys;
+    std::vector<FieldOffsets> fieldValues;
+    nautilus::val<uint64_t> entriesPerPage;
+    nautilus::val<uint64_t> entrySize;
+};
+}
@@ -14,8 +14,12 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
 #include <vector>
 #include <Runtime/AbstractBufferProvider.hpp>
 #include <Runtime/BufferManager.hpp>
@@ -27,6 +31,9 @@ namespace NES
 /// Entries consume a fixed size, which has to be smaller than the page size. Each page can contain page_size/entry_size entries.
 /// Additionally to the fixed data types, this PagedVector also supports variable sized data by attaching child buffers to the pages.
 /// To read and write records to the PagedVector, the PagedVectorRef class should ONLY be used.
+///
+/// Full pages can be compressed column by column (see compressLastPage()). A compressed page is decompressed into a new page
+/// on its first access via getTupleBufferForEntry() or getFirstPage(), e.g., when a window gets probed, and stays decompressed afterward.
 class PagedVector
 {
 public:
@@ -36,6 +43,15 @@ public:
 
         size_t cumulativeSum{0};
         TupleBuffer buffer;
+        bool compressed{false};
+    };
+
+    /// Location of the values of one field on a page, i.e., the value of the i-th entry is stored at `offset + (i * stride)`
+    struct Column
+    {
+        uint64_t offset;
+        uint64_t stride;
+        uint64_t width;
     };
 
     PagedVector() = default;
@@ -43,6 +59,17 @@ public:
     /// Appends a new page to the pages vector if the last page is full.
     void appendPageIfFull(AbstractBufferProvider* bufferProvider, uint64_t capacity, uint64_t bufferSize);
 
+    [[nodiscard]] bool isLastPageFull(uint64_t capacity) const;
+
+    /// Replaces the last page with a compressed copy, if the compressed copy is smaller than the page. The columns must cover all fields
+    /// of the entries. Each column is stored with the smallest of the following encodings:
+    /// - constant: all entries of the page share the same value, which is stored once
+    /// - frame of reference: the values of 2, 4 or 8 byte columns are stored as 1, 2 or 4 byte offsets to the minimum of the page
+    /// - raw: the values are stored as they are
+    /// The child buffers of the page are moved to the compressed copy.
+    /// The bufferProvider is also used for decompressing the pages later on, thus, it must outlive the pages of this PagedVector.
+    void compressLastPage(AbstractBufferProvider* bufferProvider, std::span<const Column> columns);
+
     /// Appends the pages of the given PagedVector with the pages of this PagedVector.
     void moveAllPages(PagedVector& other);
 
@@ -53,16 +80,30 @@ public:
     [[nodiscard]] const TupleBuffer* getTupleBufferForEntry(uint64_t entryPos) const;
     /// Returns the position of the buffer in the buffer provider that contains the entry at the given position.
     [[nodiscard]] std::optional<uint64_t> getBufferPosForEntry(uint64_t entryPos) const;
+    /// Returns the index of the page that contains the entry at the given position.
+    [[nodiscard]] std::optional<uint64_t> getPageIndexForEntry(uint64_t entryPos) const { return pages.findIdx(entryPos); }
+    /// Returns a pointer to the page at the index or a nullptr, if there is no such page, e.g., to walk over the pages one after the other
+    /// without searching for the page of each entry.
+    [[nodiscard]] const TupleBuffer* getPage(uint64_t pageIndex) const;
+
+    /// Copies the values of the column of the entries [beginEntry, beginEntry + numberOfEntries) one after the other to the destination,
+    /// e.g., so that the keys of a block of entries can be compared with SIMD instructions.
+    void copyColumn(uint64_t beginEntry, uint64_t numberOfEntries, const Column& column, int8_t* destination) const;
 
     [[nodiscard]] uint64_t getTotalNumberOfEntries() const { return pages.getTotalNumberOfEntries(); }
 
     [[nodiscard]] const TupleBuffer& getLastPage() const { return pages.getLastPage(); }
 
-    [[nodiscard]] const TupleBuffer& getFirstPage() const { return pages.getFirstPage(); }
+    [[nodiscard]] const TupleBuffer& getFirstPage() const;
 
     [[nodiscard]] uint64_t getNumberOfPages() const { return pages.getNumberOfPages(); }
 
+    [[nodiscard]] uint64_t getNumberOfCompressedPages() const { return numberOfCompressedPages.load(std::memory_order::acquire); }
+
 private:
+    /// Decompresses the page at the index, if it is compressed. Safe to call concurrently, e.g., by the probes of overlapping windows.
+    void decompressPage(size_t index) const;
+
     /// Wrapper around a vector of TupleBufferWithCumulativeSum to take care of updating the cumulative sums
     struct PagesWrapper
     {
@@ -71,9 +112,11 @@ private:
         [[nodiscard]] const TupleBuffer& getFirstPage() const;
         [[nodiscard]] uint64_t getNumberOfPages() const;
         const TupleBufferWithCumulativeSum& operator[](size_t index) const;
+        TupleBufferWithCumulativeSum& operator[](size_t index);
         [[nodiscard]] uint64_t getNumberOfTuplesLastPage() const;
 
-        /// Finds the index in the vector<TupleBufferWithCumulativeSum> for an entry position
+        /// Finds the index in the vector<TupleBufferWithCumulativeSum> for an entry position.
+        /// If all pages but the last one store the same number of entries, the index is computed in O(1) instead of searching for it.
         [[nodiscard]] std::optional<size_t> findIdx(uint64_t entryPos) const;
         void addPage(const TupleBuffer& newPage);
         void addPages(const PagesWrapper& other);
@@ -83,11 +126,20 @@ private:
         /// We use a cumulative sum to increase the speed of findIdx for an entry pos
         void updateCumulativeSumLastItem();
         void updateCumulativeSumAllPages();
+        /// Checks if the page at the index, which is not the last page, stores as many entries as all pages before it
+        void updateEntriesPerPage(size_t pageIndex);
 
         std::vector<TupleBufferWithCumulativeSum> pages;
+        /// Number of entries of each page but the last one, if all of them store the same number of entries, e.g., appending fixed size
+        /// entries fills each page to its capacity. Otherwise, zero.
+        uint64_t entriesPerPage{0};
     };
 
-    PagesWrapper pages;
+    /// Decompressing a page replaces its buffer but not its entries. Thus, the const accessors may decompress the pages.
+    mutable PagesWrapper pages;
+    mutable std::mutex decompressionMutex;
+    mutable std::atomic<uint64_t> numberOfCompressedPages{0};
+    AbstractBufferProvider* decompressionBufferProvider{nullptr};
 };
 
 }
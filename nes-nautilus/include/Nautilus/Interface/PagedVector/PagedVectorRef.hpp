@@ -36,7 +36,13 @@ class PagedVectorRef
 public:
     /// Declaring PagedVectorRefIter a friend class such that we can access the private members
     friend class PagedVectorRefIter;
-    PagedVectorRef(const nautilus::val<PagedVector*>& pagedVectorRef, const std::shared_ptr<TupleBufferRef>& bufferRef);
+    /// If compressFullPages is set, writeRecord() compresses each page once it is full (see PagedVector::compressLastPage()).
+    /// The compressed pages are decompressed transparently when they are read. Pages can only be compressed, if the bufferRef
+    /// stores all fields at fixed offsets, and the bufferRef must outlive the compiled writeRecord().
+    PagedVectorRef(
+        const nautilus::val<PagedVector*>& pagedVectorRef,
+        const std::shared_ptr<TupleBufferRef>& bufferRef,
+        bool compressFullPages = false);
 
     /// Writes a new record to the pagedVectorRef
     /// @param record the new record to be written
@@ -49,7 +55,20 @@ public:
     [[nodiscard]] Record
     readRecord(const nautilus::val<uint64_t>& pos, const std::vector<Record::RecordFieldIdentifier>& projections) const;
 
+    /// Copies the values of the field of the records [begin, begin + size) one after the other to the destination.
+    /// Requires that the bufferRef stores the field at fixed offsets (see TupleBufferRef::getFieldLocation()).
+    void copyColumn(
+        const nautilus::val<uint64_t>& begin,
+        const nautilus::val<uint64_t>& size,
+        const Record::RecordFieldIdentifier& fieldName,
+        const nautilus::val<int8_t*>& destination) const;
+
+    /// The iterators walk over the pages one after the other. Thus, they only search for the page of their first record and then advance
+    /// within a page by incrementing the position on the page and to the next page by its index.
     [[nodiscard]] PagedVectorRefIter begin(const std::vector<Record::RecordFieldIdentifier>& projections) const;
+    /// Returns an iterator that starts at the record at pos, which must be less than the number of tuples
+    [[nodiscard]] PagedVectorRefIter
+    at(const nautilus::val<uint64_t>& pos, const std::vector<Record::RecordFieldIdentifier>& projections) const;
     [[nodiscard]] PagedVectorRefIter end(const std::vector<Record::RecordFieldIdentifier>& projections) const;
     nautilus::val<bool> operator==(const PagedVectorRef& other) const;
     [[nodiscard]] nautilus::val<uint64_t> getNumberOfTuples() const;
@@ -57,6 +76,7 @@ public:
 private:
     nautilus::val<PagedVector*> pagedVectorRef;
     std::shared_ptr<TupleBufferRef> bufferRef;
+    bool compressFullPages;
 };
 
 class PagedVectorRefIter
@@ -67,6 +87,7 @@ public:
         const std::shared_ptr<TupleBufferRef>& bufferRef,
         const std::vector<Record::RecordFieldIdentifier>& projections,
         const nautilus::val<TupleBuffer*>& curPage,
+        const nautilus::val<uint64_t>& pageIndex,
         const nautilus::val<uint64_t>& posOnPage,
         const nautilus::val<uint64_t>& pos,
         const nautilus::val<uint64_t>& numberOfTuplesInPagedVector);
@@ -84,6 +105,8 @@ private:
     nautilus::val<uint64_t> numberOfTuplesInPagedVector;
     nautilus::val<uint64_t> posOnPage;
     nautilus::val<TupleBuffer*> curPage;
+    nautilus::val<uint64_t> pageIndex;
+    nautilus::val<uint64_t> numberOfTuplesOnPage;
     std::shared_ptr<TupleBufferRef> bufferRef;
 };
 
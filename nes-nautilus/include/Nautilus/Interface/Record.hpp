@@ -14,7 +14,11 @@
 
 #pragma once
 
+#include <cstdint>
+#include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 #include <Nautilus/DataTypes/VarVal.hpp>
 
 namespace NES
@@ -22,10 +26,19 @@ namespace NES
 
 /// A record is the primitive abstraction of a single entry/tuple in a data set.
 /// Operators receiving records can read and write fields of the record.
+/// The record keeps its fields in a flat vector that is sorted by the slots of the fields. Operators resolve the slots of the fields that
+/// they access once, when they are created, so that reading and writing a field neither hashes nor compares its name.
 class Record
 {
 public:
     using RecordFieldIdentifier = std::string;
+    /// Dense index of a field name. All records of the process share the slots, thus a slot does not depend on the schema.
+    using FieldSlot = uint32_t;
+
+    /// Returns the slot of the field name and assigns the next free slot to an unseen name
+    static FieldSlot resolveSlot(const RecordFieldIdentifier& recordFieldIdentifier);
+    static RecordFieldIdentifier getFieldName(FieldSlot slot);
+
     explicit Record() = default;
     explicit Record(std::unordered_map<RecordFieldIdentifier, VarVal>&& recordFields);
     ~Record() = default;
@@ -33,9 +46,12 @@ public:
     /// Adds all fields from the other record to this record. This will overwrite existing fields.
     void reassignFields(const Record& other);
     const VarVal& read(const RecordFieldIdentifier& recordFieldIdentifier) const;
+    const VarVal& read(FieldSlot slot) const;
     void write(const RecordFieldIdentifier& recordFieldIdentifier, const VarVal& varVal);
+    void write(FieldSlot slot, const VarVal& varVal);
     nautilus::val<uint64_t> getNumberOfFields() const;
     [[nodiscard]] bool hasField(const RecordFieldIdentifier& fieldName) const;
+    [[nodiscard]] bool hasField(FieldSlot slot) const;
 
     friend nautilus::val<std::ostream>& operator<<(nautilus::val<std::ostream>& os, const Record& record);
     friend nautilus::val<bool> operator==(const Record& lhs, const Record& rhs);
@@ -43,7 +59,9 @@ public:
     friend nautilus::val<bool> operator!=(const Record& lhs, const Record& rhs) { return !(lhs == rhs); }
 
 private:
-    std::unordered_map<RecordFieldIdentifier, VarVal> recordFields;
+    [[nodiscard]] std::vector<std::pair<FieldSlot, VarVal>>::const_iterator find(FieldSlot slot) const;
+
+    std::vector<std::pair<FieldSlot, VarVal>> recordFields;
 };
 
 }
@@ -68,6 +68,11 @@ public:
     nautilus::val<Timestamp> getCreatingTs();
     void setCreationTs(const nautilus::val<Timestamp>& creationTs);
 
+    /// Get the range of the times at which the sources ingested the tuples that the underlying tuple buffer derives from
+    nautilus::val<Timestamp> getMinIngestionTs();
+    nautilus::val<Timestamp> getMaxIngestionTs();
+    void setIngestionTs(const nautilus::val<Timestamp>& minIngestionTs, const nautilus::val<Timestamp>& maxIngestionTs);
+
     ~RecordBuffer() = default;
 
 private:
@@ -81,6 +81,21 @@ inline void NES_Memory_TupleBuffer_setCreationTimestampInMS(TupleBuffer* tupleBu
     tupleBuffer->setCreationTimestampInMS(Timestamp(value));
 }
 
+inline Timestamp NES_Memory_TupleBuffer_getMinIngestionTimestampInNS(const TupleBuffer* tupleBuffer)
+{
+    return tupleBuffer->getMinIngestionTimestampInNS();
+}
+
+inline Timestamp NES_Memory_TupleBuffer_getMaxIngestionTimestampInNS(const TupleBuffer* tupleBuffer)
+{
+    return tupleBuffer->getMaxIngestionTimestampInNS();
+}
+
+inline void NES_Memory_TupleBuffer_setIngestionTimestampsInNS(TupleBuffer* tupleBuffer, const Timestamp minValue, const Timestamp maxValue)
+{
+    tupleBuffer->setIngestionTimestampsInNS(Timestamp(minValue), Timestamp(maxValue));
+}
+
 inline void NES_Memory_TupleBuffer_setChunkNumber(TupleBuffer* tupleBuffer, const ChunkNumber chunkNumber)
 {
     tupleBuffer->setChunkNumber(ChunkNumber(chunkNumber));
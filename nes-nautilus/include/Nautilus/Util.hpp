@@ -92,6 +92,8 @@ static VarVal createNautilusConstValue(T value, DataType::Type physicalType)
         case DataType::Type::INT32:
             return VarVal(nautilus::val<int32_t>(value));
         case DataType::Type::INT64:
+        case DataType::Type::INTERVAL:
+        case DataType::Type::DECIMAL:
             return VarVal(nautilus::val<int64_t>(value));
         case DataType::Type::UINT8:
             return VarVal(nautilus::val<uint8_t>(value));
@@ -100,6 +102,7 @@ static VarVal createNautilusConstValue(T value, DataType::Type physicalType)
         case DataType::Type::UINT32:
             return VarVal(nautilus::val<uint32_t>(value));
         case DataType::Type::UINT64:
+        case DataType::Type::TIMESTAMP:
             return VarVal(nautilus::val<uint64_t>(value));
         case DataType::Type::FLOAT32:
             return VarVal(nautilus::val<float>(value));
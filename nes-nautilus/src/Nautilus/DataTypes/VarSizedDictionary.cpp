@@ -0,0 +1,99 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Nautilus/DataTypes/VarSizedDictionary.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <Nautilus/Interface/Hash/MurMur3HashFunction.hpp>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+namespace
+{
+std::atomic<uint64_t> nextDictionaryId{1};
+}
+
+VarSizedDictionary::VarSizedDictionary(const uint64_t maxNumberOfEntries)
+    : id(nextDictionaryId.fetch_add(1, std::memory_order_relaxed))
+    , maxNumberOfEntriesPerShard((maxNumberOfEntries / NUMBER_OF_SHARDS) + (maxNumberOfEntries % NUMBER_OF_SHARDS == 0 ? 0 : 1))
+{
+    PRECONDITION(maxNumberOfEntries > 0, "A dictionary must be able to hold at least one entry");
+}
+
+int8_t* VarSizedDictionary::intern(const std::string_view value)
+{
+    /// hashBytes does not modify the bytes
+    const auto hash = hashBytes(const_cast<char*>(value.data()), value.size()); /// NOLINT(cppcoreguidelines-pro-type-const-cast)
+    auto& shard = shards[hash % NUMBER_OF_SHARDS];
+    {
+        const std::shared_lock lock(shard.mutex);
+        if (const auto entry = shard.entries.find(Key{.value = value, .hash = hash}); entry != shard.entries.end())
+        {
+            return entry->second;
+        }
+    }
+
+    const std::unique_lock lock(shard.mutex);
+    if (const auto entry = shard.entries.find(Key{.value = value, .hash = hash}); entry != shard.entries.end())
+    {
+        return entry->second;
+    }
+    if (shard.entries.size() >= maxNumberOfEntriesPerShard)
+    {
+        throw FormattingError(
+            "Cannot dictionary-encode more than {} distinct VARSIZED values of a source. Disable dictionary_encoding for sources with "
+            "high-cardinality VARSIZED fields.",
+            maxNumberOfEntriesPerShard * NUMBER_OF_SHARDS);
+    }
+
+    const auto offsetOfHash = getOffsetOfHash(value.size());
+    auto& entryStorage = shard.storage.emplace_back(
+        std::make_unique<uint64_t[]>((offsetOfHash / sizeof(uint64_t)) + 1)); /// NOLINT(modernize-avoid-c-arrays)
+    auto* entry = reinterpret_cast<int8_t*>(entryStorage.get()); /// NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    std::memcpy(entry, value.data(), value.size());
+    std::memcpy(entry + offsetOfHash, &hash, sizeof(hash));
+    shard.entries.emplace(Key{.value = std::string_view{reinterpret_cast<const char*>(entry), value.size()}, .hash = hash}, entry);
+    return entry;
+}
+
+uint64_t VarSizedDictionary::getNumberOfEntries() const
+{
+    uint64_t numberOfEntries = 0;
+    for (const auto& shard : shards)
+    {
+        const std::shared_lock lock(shard.mutex);
+        numberOfEntries += shard.entries.size();
+    }
+    return numberOfEntries;
+}
+
+int8_t* internVarSizedProxy(VarSizedDictionary* dictionary, const int8_t* fieldAddress, const uint64_t fieldSize)
+{
+    PRECONDITION(dictionary != nullptr, "Dictionary is expected to be not null!");
+    if (fieldAddress == nullptr)
+    {
+        return dictionary->intern(std::string_view{});
+    }
+    return dictionary->intern(std::string_view{reinterpret_cast<const char*>(fieldAddress), fieldSize});
+}
+
+}
@@ -134,7 +134,9 @@ VarVal VarVal::castToType(const DataType::Type type) const
         case DataType::Type::INT32: {
             return {getRawValueAs<nautilus::val<int32_t>>(), nullable, null};
         }
-        case DataType::Type::INT64: {
+        case DataType::Type::INT64:
+        case DataType::Type::INTERVAL:
+        case DataType::Type::DECIMAL: {
             return {getRawValueAs<nautilus::val<int64_t>>(), nullable, null};
         }
         case DataType::Type::UINT8: {
@@ -146,7 +148,8 @@ VarVal VarVal::castToType(const DataType::Type type) const
         case DataType::Type::UINT32: {
             return {getRawValueAs<nautilus::val<uint32_t>>(), nullable, null};
         }
-        case DataType::Type::UINT64: {
+        case DataType::Type::UINT64:
+        case DataType::Type::TIMESTAMP: {
             return {getRawValueAs<nautilus::val<uint64_t>>(), nullable, null};
         }
         case DataType::Type::FLOAT32: {
@@ -189,7 +192,9 @@ VarVal VarVal::readVarValFromMemory(const nautilus::val<int8_t*>& memRef, const
         case DataType::Type::INT32: {
             return {readValueFromMemRef<int32_t>(memRef), type.nullable, null};
         }
-        case DataType::Type::INT64: {
+        case DataType::Type::INT64:
+        case DataType::Type::INTERVAL:
+        case DataType::Type::DECIMAL: {
             return {readValueFromMemRef<int64_t>(memRef), type.nullable, null};
         }
         case DataType::Type::CHAR: {
@@ -204,7 +209,8 @@ VarVal VarVal::readVarValFromMemory(const nautilus::val<int8_t*>& memRef, const
         case DataType::Type::UINT32: {
             return {readValueFromMemRef<uint32_t>(memRef), type.nullable, null};
         }
-        case DataType::Type::UINT64: {
+        case DataType::Type::UINT64:
+        case DataType::Type::TIMESTAMP: {
             return {readValueFromMemRef<uint64_t>(memRef), type.nullable, null};
         }
         case DataType::Type::FLOAT32: {
@@ -235,6 +241,16 @@ VarVal VarVal::select(const nautilus::val<bool>& condition, const VarVal& trueVa
 
             if constexpr (std::same_as<LHS, RHS> && std::same_as<LHS, VariableSizedData>)
             {
+                if (trueUnderlying.hasPrefix() and falseUnderlying.hasPrefix())
+                {
+                    return VarVal{
+                        VariableSizedData{
+                            nautilus::select(condition, trueUnderlying.getContent(), falseUnderlying.getContent()),
+                            nautilus::select(condition, trueUnderlying.getSize(), falseUnderlying.getSize()),
+                            nautilus::select(condition, trueUnderlying.getPrefix(), falseUnderlying.getPrefix())},
+                        trueValue.nullable or falseValue.nullable,
+                        nautilus::select(condition, trueValue.null, falseValue.null)};
+                }
                 return VarVal{
                     VariableSizedData{
                         nautilus::select(condition, trueUnderlying.getContent(), falseUnderlying.getContent()),
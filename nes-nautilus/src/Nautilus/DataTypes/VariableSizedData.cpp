@@ -14,10 +14,15 @@
 
 #include <Nautilus/DataTypes/VariableSizedData.hpp>
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <optional>
 #include <ostream>
 #include <utility>
 #include <Nautilus/DataTypes/DataTypesUtil.hpp>
+#include <Runtime/VariableSizedAccess.hpp>
+#include <nautilus/function.hpp>
 #include <nautilus/std/cstring.h>
 #include <nautilus/std/ostream.h>
 #include <nautilus/val.hpp>
@@ -32,6 +37,33 @@ VariableSizedData::VariableSizedData(const nautilus::val<int8_t*>& reference, co
 {
 }
 
+VariableSizedData::VariableSizedData(
+    const nautilus::val<int8_t*>& reference, const nautilus::val<uint64_t>& size, const nautilus::val<uint32_t>& prefix)
+    : size(size), ptrToVarSized(reference), prefix(prefix)
+{
+}
+
+VariableSizedData::VariableSizedData(
+    const nautilus::val<int8_t*>& reference, const nautilus::val<uint64_t>& size, const nautilus::val<uint32_t>& prefix, Origin origin)
+    : size(size), ptrToVarSized(reference), prefix(prefix), origin(std::move(origin))
+{
+}
+
+VariableSizedData::VariableSizedData(
+    const nautilus::val<int8_t*>& reference, const nautilus::val<uint64_t>& size, const uint64_t dictionaryId)
+    : size(size), ptrToVarSized(reference), dictionaryId(dictionaryId)
+{
+}
+
+VariableSizedData::VariableSizedData(
+    const nautilus::val<int8_t*>& reference,
+    const nautilus::val<uint64_t>& size,
+    const nautilus::val<uint32_t>& prefix,
+    const uint64_t dictionaryId)
+    : size(size), ptrToVarSized(reference), dictionaryId(dictionaryId), prefix(prefix)
+{
+}
+
 VariableSizedData& VariableSizedData::operator=(const VariableSizedData& other) noexcept
 {
     if (this == &other)
@@ -41,11 +73,18 @@ VariableSizedData& VariableSizedData::operator=(const VariableSizedData& other)
 
     size = other.size;
     ptrToVarSized = other.ptrToVarSized;
+    dictionaryId = other.dictionaryId;
+    prefix.reset();
+    origin.reset();
     return *this;
 }
 
 VariableSizedData::VariableSizedData(VariableSizedData&& other) noexcept
-    : size(std::move(other.size)), ptrToVarSized(std::move(other.ptrToVarSized))
+    : size(std::move(other.size))
+    , ptrToVarSized(std::move(other.ptrToVarSized))
+    , dictionaryId(other.dictionaryId)
+    , prefix(std::move(other.prefix))
+    , origin(std::move(other.origin))
 {
 }
 
@@ -58,6 +97,9 @@ VariableSizedData& VariableSizedData::operator=(VariableSizedData&& other) noexc
 
     size = std::move(other.size);
     ptrToVarSized = std::move(other.ptrToVarSized);
+    dictionaryId = other.dictionaryId;
+    prefix.reset();
+    origin.reset();
     return *this;
 }
 
@@ -80,10 +122,25 @@ nautilus::val<bool> VariableSizedData::isValid() const
 
 nautilus::val<bool> VariableSizedData::operator==(const VariableSizedData& rhs) const
 {
+    if (dictionaryId != 0 && dictionaryId == rhs.dictionaryId)
+    {
+        return ptrToVarSized == rhs.ptrToVarSized;
+    }
     if (size != rhs.size)
     {
         return {false};
     }
+    if (prefix.has_value() and rhs.prefix.has_value())
+    {
+        if (*prefix != *rhs.prefix)
+        {
+            return {false};
+        }
+        if (size <= nautilus::val<uint64_t>(VariableSizedAccess::PREFIX_SIZE))
+        {
+            return {true};
+        }
+    }
     const auto varSizedData = getContent();
     const auto rhsVarSizedData = rhs.getContent();
     const auto compareResult = (nautilus::memcmp(varSizedData, rhsVarSizedData, size) == 0);
@@ -110,6 +167,42 @@ nautilus::val<bool> VariableSizedData::operator!() const
     return ptrToVarSized;
 }
 
+[[nodiscard]] bool VariableSizedData::isInterned() const
+{
+    return dictionaryId != 0;
+}
+
+[[nodiscard]] uint64_t VariableSizedData::getDictionaryId() const
+{
+    return dictionaryId;
+}
+
+[[nodiscard]] const std::optional<VariableSizedData::Origin>& VariableSizedData::getOrigin() const
+{
+    return origin;
+}
+
+nautilus::val<uint32_t> VariableSizedData::getPrefix() const
+{
+    if (prefix.has_value())
+    {
+        return *prefix;
+    }
+    return nautilus::invoke(computePrefix, ptrToVarSized, size);
+}
+
+bool VariableSizedData::hasPrefix() const
+{
+    return prefix.has_value();
+}
+
+uint32_t VariableSizedData::computePrefix(const int8_t* content, const uint64_t size)
+{
+    uint32_t contentPrefix = 0;
+    std::memcpy(&contentPrefix, content, std::min<uint64_t>(size, VariableSizedAccess::PREFIX_SIZE));
+    return contentPrefix;
+}
+
 [[nodiscard]] nautilus::val<std::ostream>& operator<<(nautilus::val<std::ostream>& oss, const VariableSizedData& variableSizedData)
 {
     oss << "Size(" << variableSizedData.size << "): ";
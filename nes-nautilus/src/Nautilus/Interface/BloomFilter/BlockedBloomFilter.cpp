@@ -0,0 +1,79 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Nautilus/Interface/BloomFilter/BlockedBloomFilter.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <Nautilus/Interface/Hash/HashFunction.hpp>
+
+namespace NES
+{
+
+BloomFilterStatistics& BloomFilterStatistics::operator+=(const BloomFilterStatistics& other)
+{
+    numberOfRejectedKeys += other.numberOfRejectedKeys;
+    numberOfFalsePositives += other.numberOfFalsePositives;
+    return *this;
+}
+
+double BloomFilterStatistics::getFalsePositiveRate() const
+{
+    const auto numberOfAbsentKeys = numberOfRejectedKeys + numberOfFalsePositives;
+    if (numberOfAbsentKeys == 0)
+    {
+        return 0;
+    }
+    return static_cast<double>(numberOfFalsePositives) / static_cast<double>(numberOfAbsentKeys);
+}
+
+BlockedBloomFilter::BlockedBloomFilter(const uint64_t expectedNumberOfKeys, const uint64_t bitsPerKey)
+{
+    constexpr uint64_t bitsPerWord = 64;
+    const auto numberOfWords = std::bit_ceil(std::max<uint64_t>(((expectedNumberOfKeys * bitsPerKey) + bitsPerWord - 1) / bitsPerWord, 1));
+    wordSpace = std::make_unique<uint64_t[]>(numberOfWords); /// NOLINT(cppcoreguidelines-avoid-c-arrays)
+    words = wordSpace.get();
+    mask = numberOfWords - 1;
+}
+
+void BlockedBloomFilter::insert(const HashFunction::HashValue::raw_type hash)
+{
+    std::atomic_ref(words[hash & mask]).fetch_or(getBitsOfHash(hash), std::memory_order_relaxed);
+}
+
+bool BlockedBloomFilter::mayContain(const HashFunction::HashValue::raw_type hash) const
+{
+    const auto bitsOfHash = getBitsOfHash(hash);
+    return (words[hash & mask] & bitsOfHash) == bitsOfHash;
+}
+
+uint64_t BlockedBloomFilter::getNumberOfWords() const
+{
+    return mask + 1;
+}
+
+uint64_t BlockedBloomFilter::getBitsOfHash(const HashFunction::HashValue::raw_type hash)
+{
+    uint64_t bitsOfHash = 0;
+    for (uint64_t i = 0; i < NUMBER_OF_BITS_PER_HASH; ++i)
+    {
+        bitsOfHash |= uint64_t{1} << ((hash >> (FIRST_HASH_BIT + (i * BITS_PER_POSITION))) & POSITION_MASK);
+    }
+    return bitsOfHash;
+}
+
+}
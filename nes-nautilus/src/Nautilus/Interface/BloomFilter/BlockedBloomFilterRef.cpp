@@ -0,0 +1,48 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Nautilus/Interface/BloomFilter/BlockedBloomFilterRef.hpp>
+
+#include <cstdint>
+#include <Nautilus/DataTypes/DataTypesUtil.hpp>
+#include <Nautilus/Interface/BloomFilter/BlockedBloomFilter.hpp>
+#include <Nautilus/Interface/Hash/HashFunction.hpp>
+#include <val.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+BlockedBloomFilterRef::BlockedBloomFilterRef(const nautilus::val<BlockedBloomFilter*>& bloomFilterRef) : bloomFilterRef(bloomFilterRef)
+{
+}
+
+nautilus::val<bool> BlockedBloomFilterRef::mayContain(const HashFunction::HashValue& hash) const
+{
+    /// Calculating the same bits as BlockedBloomFilter::getBitsOfHash(). The loop gets unrolled during tracing.
+    nautilus::val<uint64_t> bitsOfHash{0};
+    for (uint64_t i = 0; i < BlockedBloomFilter::NUMBER_OF_BITS_PER_HASH; ++i)
+    {
+        const nautilus::val<uint64_t> shift{BlockedBloomFilter::FIRST_HASH_BIT + (i * BlockedBloomFilter::BITS_PER_POSITION)};
+        const nautilus::val<uint64_t> positionMask{BlockedBloomFilter::POSITION_MASK};
+        bitsOfHash = bitsOfHash | (nautilus::val<uint64_t>{1} << ((hash >> shift) & positionMask));
+    }
+
+    const auto mask = readValueFromMemRef<uint64_t>(getMemberRef(bloomFilterRef, &BlockedBloomFilter::mask));
+    auto words = readValueFromMemRef<uint64_t*>(getMemberRef(bloomFilterRef, &BlockedBloomFilter::words));
+    const nautilus::val<uint64_t> word = words[hash & mask];
+    return (word & bitsOfHash) == bitsOfHash;
+}
+
+}
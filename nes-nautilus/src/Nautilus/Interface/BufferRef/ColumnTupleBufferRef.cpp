@@ -13,17 +13,21 @@
 */
 #include <Nautilus/Interface/BufferRef/ColumnTupleBufferRef.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <ranges>
 #include <utility>
 #include <vector>
 #include <DataTypes/DataType.hpp>
+#include <Nautilus/DataTypes/DataTypesUtil.hpp>
 #include <Nautilus/DataTypes/VarVal.hpp>
 #include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
 #include <Nautilus/Interface/Record.hpp>
 #include <Nautilus/Interface/RecordBuffer.hpp>
 #include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/ColumnarLayout.hpp>
 #include <nautilus/static.hpp>
 #include <nautilus/val_ptr.hpp>
 #include <val.hpp>
@@ -31,8 +35,12 @@
 namespace NES
 {
 
-ColumnTupleBufferRef::ColumnTupleBufferRef(std::vector<Field> fields, const uint64_t tupleSize, const uint64_t bufferSize)
-    : TupleBufferRef(bufferSize / tupleSize, bufferSize, tupleSize), fields(std::move(fields))
+ColumnTupleBufferRef::ColumnTupleBufferRef(
+    std::vector<Field> fields, const uint64_t capacity, const uint64_t tupleSize, const uint64_t bufferSize)
+    : TupleBufferRef(capacity, bufferSize, tupleSize)
+    , fields(std::move(fields))
+    , fieldSlots(this->fields | std::views::transform([](const Field& field) { return Record::resolveSlot(field.name); })
+                 | std::ranges::to<std::vector>())
 {
 }
 
@@ -48,6 +56,20 @@ nautilus::val<int8_t*> calculateFieldAddress(
     auto fieldAddress = bufferAddress + fieldOffset;
     return fieldAddress;
 }
+
+/// Returns the address of the word of the validity bitmap that contains the bit of the record
+nautilus::val<int8_t*> calculateValidityWordAddress(
+    const nautilus::val<int8_t*>& bufferAddress, nautilus::val<uint64_t>& recordIndex, const uint64_t validityOffset)
+{
+    const nautilus::val<uint64_t> bitsPerWord{ColumnarLayout::BITS_PER_VALIDITY_WORD};
+    const auto wordOffset = ((recordIndex / bitsPerWord) * nautilus::val<uint64_t>{sizeof(uint64_t)}) + validityOffset;
+    return bufferAddress + wordOffset;
+}
+
+nautilus::val<uint64_t> calculateValidityMask(nautilus::val<uint64_t>& recordIndex)
+{
+    return nautilus::val<uint64_t>{1} << (recordIndex & nautilus::val<uint64_t>{ColumnarLayout::BITS_PER_VALIDITY_WORD - 1});
+}
 }
 
 Record ColumnTupleBufferRef::readRecord(
@@ -59,14 +81,21 @@ Record ColumnTupleBufferRef::readRecord(
     const auto bufferAddress = recordBuffer.getMemArea();
     for (nautilus::static_val<uint64_t> i = 0; i < fields.size(); ++i)
     {
-        const auto& [name, type, dataTypeSize, columnOffset] = fields.at(i);
+        const auto& [name, type, dataTypeSize, columnOffset, validityOffset] = fields.at(i);
         if (not includesField(projections, name))
         {
             continue;
         }
         auto fieldAddress = calculateFieldAddress(bufferAddress, recordIndex, dataTypeSize, columnOffset);
-        const auto& value = loadValue(type, recordBuffer, fieldAddress);
-        record.write(name, value);
+        nautilus::val<bool> null = false;
+        if (validityOffset.has_value())
+        {
+            const auto validityWord
+                = readValueFromMemRef<uint64_t>(calculateValidityWordAddress(bufferAddress, recordIndex, validityOffset.value()));
+            null = (validityWord & calculateValidityMask(recordIndex)) == nautilus::val<uint64_t>{0};
+        }
+        const auto& value = loadValueWithoutNullByte(type, recordBuffer, fieldAddress, null);
+        record.write(fieldSlots.at(i), value);
     }
     return record;
 }
@@ -80,15 +109,27 @@ void ColumnTupleBufferRef::writeRecord(
     const auto bufferAddress = recordBuffer.getMemArea();
     for (nautilus::static_val<uint64_t> i = 0; i < fields.size(); ++i)
     {
-        const auto& [name, type, dataTypeSize, columnOffset] = fields.at(i);
-        if (not rec.hasField(name))
+        const auto& [name, type, dataTypeSize, columnOffset, validityOffset] = fields.at(i);
+        if (not rec.hasField(fieldSlots.at(i)))
         {
             /// Skipping any fields that are not part of the record
             continue;
         }
         auto fieldAddress = calculateFieldAddress(bufferAddress, recordIndex, dataTypeSize, columnOffset);
-        const auto& value = rec.read(name);
-        storeValue(type, recordBuffer, fieldAddress, value, bufferProvider);
+        const auto& value = rec.read(fieldSlots.at(i));
+        if (validityOffset.has_value())
+        {
+            /// Setting the bit first and flipping it for nulls clears the bit without requiring a negated mask
+            const auto validityWordAddress = calculateValidityWordAddress(bufferAddress, recordIndex, validityOffset.value());
+            const auto validityMask = calculateValidityMask(recordIndex);
+            nautilus::val<uint64_t> validityWord = readValueFromMemRef<uint64_t>(validityWordAddress) | validityMask;
+            if (value.isNull())
+            {
+                validityWord = validityWord ^ validityMask;
+            }
+            VarVal{validityWord}.writeToMemory(validityWordAddress);
+        }
+        storeValueWithoutNullByte(type, recordBuffer, fieldAddress, value, bufferProvider);
     }
 }
 
@@ -102,4 +143,14 @@ std::vector<DataType> ColumnTupleBufferRef::getAllDataTypes() const
     return fields | std::views::transform([](const Field& field) { return field.type; }) | std::ranges::to<std::vector>();
 }
 
+std::optional<TupleBufferRef::FieldLocation> ColumnTupleBufferRef::getFieldLocation(const Record::RecordFieldIdentifier& fieldName) const
+{
+    const auto field = std::ranges::find(fields, fieldName, &Field::name);
+    if (field == fields.end() or field->validityOffset.has_value())
+    {
+        return std::nullopt;
+    }
+    return FieldLocation{.type = field->type, .offset = field->columnOffset, .stride = field->dataTypeSize};
+}
+
 }
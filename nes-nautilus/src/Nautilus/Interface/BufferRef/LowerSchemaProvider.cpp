@@ -17,12 +17,14 @@
 #include <cstdint>
 #include <memory>
 #include <numeric>
+#include <ranges>
 #include <utility>
 #include <vector>
 #include <DataTypes/Schema.hpp>
 #include <Nautilus/Interface/BufferRef/ColumnTupleBufferRef.hpp>
 #include <Nautilus/Interface/BufferRef/RowTupleBufferRef.hpp>
 #include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
+#include <Runtime/ColumnarLayout.hpp>
 #include <ErrorHandling.hpp>
 
 namespace NES
@@ -55,24 +57,17 @@ LowerSchemaProvider::lowerSchema(const uint64_t bufferSize, const Schema& schema
         }
 
         case MemoryLayoutType::COLUMNAR_LAYOUT: {
-            const auto tupleSize = std::accumulate(
-                schema.begin(),
-                schema.end(),
-                0UL,
-                [](auto size, const Schema::Field& field) { return size + field.dataType.getSizeInBytesWithNull(); });
-            INVARIANT(tupleSize > 0, "Tuplesize must be larger than 0B");
-
-            const uint64_t capacity = bufferSize / tupleSize;
+            const auto layout = ColumnarLayout::create(schema, bufferSize);
             std::vector<ColumnTupleBufferRef::Field> fields;
             fields.reserve(schema.getNumberOfFields());
-            uint64_t columnOffset = 0;
-            for (const auto& field : schema)
+            uint64_t tupleSize = 0;
+            for (const auto& [field, column] : std::views::zip(schema, layout.columns))
             {
-                fields.emplace_back(field.name, field.dataType, field.dataType.getSizeInBytesWithNull(), columnOffset);
-                columnOffset += (field.dataType.getSizeInBytesWithNull() * capacity);
+                fields.emplace_back(field.name, field.dataType, column.valueSize, column.valueOffset, column.validityOffset);
+                tupleSize += column.valueSize;
             }
-
-            return std::make_shared<ColumnTupleBufferRef>(ColumnTupleBufferRef{std::move(fields), tupleSize, bufferSize});
+            return std::make_shared<ColumnTupleBufferRef>(
+                ColumnTupleBufferRef{std::move(fields), layout.capacity, tupleSize, bufferSize});
         }
     }
     std::unreachable();
@@ -13,8 +13,10 @@
 */
 #include <Nautilus/Interface/BufferRef/RowTupleBufferRef.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <ranges>
 #include <utility>
 #include <vector>
@@ -31,7 +33,10 @@ namespace NES
 {
 
 RowTupleBufferRef::RowTupleBufferRef(std::vector<Field> fields, const uint64_t tupleSize, const uint64_t bufferSize)
-    : TupleBufferRef(bufferSize / tupleSize, bufferSize, tupleSize), fields(std::move(fields))
+    : TupleBufferRef(bufferSize / tupleSize, bufferSize, tupleSize)
+    , fields(std::move(fields))
+    , fieldSlots(this->fields | std::views::transform([](const Field& field) { return Record::resolveSlot(field.name); })
+                 | std::ranges::to<std::vector>())
 {
 }
 
@@ -61,7 +66,7 @@ Record RowTupleBufferRef::readRecord(
         }
         auto fieldAddress = calculateFieldAddress(recordOffset, fieldOffset);
         auto value = loadValue(type, recordBuffer, fieldAddress);
-        record.write(name, value);
+        record.write(fieldSlots.at(i), value);
     }
     return record;
 }
@@ -77,13 +82,13 @@ void RowTupleBufferRef::writeRecord(
     for (nautilus::static_val<uint64_t> i = 0; i < fields.size(); ++i)
     {
         const auto& [name, type, fieldOffset] = fields.at(i);
-        if (not rec.hasField(name))
+        if (not rec.hasField(fieldSlots.at(i)))
         {
             /// Skipping any fields that are not part of the record
             continue;
         }
         auto fieldAddress = calculateFieldAddress(recordOffset, fieldOffset);
-        const auto& value = rec.read(name);
+        const auto& value = rec.read(fieldSlots.at(i));
         storeValue(type, recordBuffer, fieldAddress, value, bufferProvider);
     }
 }
@@ -98,4 +103,14 @@ std::vector<DataType> RowTupleBufferRef::getAllDataTypes() const
     return fields | std::views::transform([](const Field& field) { return field.type; }) | std::ranges::to<std::vector>();
 }
 
+std::optional<TupleBufferRef::FieldLocation> RowTupleBufferRef::getFieldLocation(const Record::RecordFieldIdentifier& fieldName) const
+{
+    const auto field = std::ranges::find(fields, fieldName, &Field::name);
+    if (field == fields.end())
+    {
+        return std::nullopt;
+    }
+    return FieldLocation{.type = field->type, .offset = field->fieldOffset, .stride = tupleSize};
+}
+
 }
@@ -21,6 +21,7 @@
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <optional>
 #include <span>
 #include <string>
 #include <utility>
@@ -88,7 +89,10 @@ VariableSizedAccess TupleBufferRef::writeVarSized(
     TupleBuffer& tupleBuffer, AbstractBufferProvider& bufferProvider, const std::span<const std::byte> varSizedValue)
 {
     const auto totalVarSizedLength = varSizedValue.size();
-
+    if (totalVarSizedLength <= VariableSizedAccess::INLINE_SIZE)
+    {
+        return VariableSizedAccess{varSizedValue};
+    }
 
     /// If there are no child buffers, we get a new buffer and copy the var sized into the newly acquired
     const auto numberOfChildBuffers = tupleBuffer.getNumberOfChildBuffers();
@@ -97,31 +101,59 @@ VariableSizedAccess TupleBufferRef::writeVarSized(
         auto newChildBuffer = getNewBufferForVarSized(bufferProvider, totalVarSizedLength);
         copyVarSizedAndIncrementMetaData(newChildBuffer, VariableSizedAccess::Offset{0}, varSizedValue);
         const auto childBufferIndex = tupleBuffer.storeChildBuffer(newChildBuffer);
-        return VariableSizedAccess{childBufferIndex, VariableSizedAccess::Size{totalVarSizedLength}};
+        return VariableSizedAccess{childBufferIndex, VariableSizedAccess::Offset{0}, varSizedValue};
     }
 
     /// If there is no space in the lastChildBuffer, we get a new buffer and copy the var sized into the newly acquired
     /// We store the number of used bytes in the no. tuples field.  We plan on getting rid of this "mis"-use in the near future.
+    /// A last child buffer that is referenced elsewhere, e.g., by the input buffer that it is shared with, must not be appended to.
+    /// Besides the buffer, the loaded child buffer holds the only other reference to an exclusively owned child buffer.
     const VariableSizedAccess::Index childIndex{numberOfChildBuffers - 1};
     auto lastChildBuffer = tupleBuffer.loadChildBuffer(childIndex);
     const auto usedMemorySize = lastChildBuffer.getNumberOfTuples();
-    if (usedMemorySize + totalVarSizedLength >= lastChildBuffer.getBufferSize())
+    if (usedMemorySize + totalVarSizedLength >= lastChildBuffer.getBufferSize() or lastChildBuffer.getReferenceCounter() > 2)
     {
         auto newChildBuffer = getNewBufferForVarSized(bufferProvider, totalVarSizedLength);
         copyVarSizedAndIncrementMetaData(newChildBuffer, VariableSizedAccess::Offset{0}, varSizedValue);
         const VariableSizedAccess::Index childBufferIndex{tupleBuffer.storeChildBuffer(newChildBuffer)};
-        return VariableSizedAccess{childBufferIndex, VariableSizedAccess::Size{totalVarSizedLength}};
+        return VariableSizedAccess{childBufferIndex, VariableSizedAccess::Offset{0}, varSizedValue};
     }
 
     /// There is enough space in the lastChildBuffer, thus, we copy the var sized into it
     const VariableSizedAccess::Offset childOffset{usedMemorySize};
     copyVarSizedAndIncrementMetaData(lastChildBuffer, childOffset, varSizedValue);
-    return VariableSizedAccess{childIndex, childOffset, VariableSizedAccess::Size{totalVarSizedLength}};
+    return VariableSizedAccess{childIndex, childOffset, varSizedValue};
+}
+
+VariableSizedAccess
+TupleBufferRef::referenceVarSized(TupleBuffer& tupleBuffer, const TupleBuffer& sourceBuffer, const VariableSizedAccess sourceAccess)
+{
+    if (sourceAccess.isInlined())
+    {
+        return sourceAccess;
+    }
+    auto sourceChildBuffer = sourceBuffer.loadChildBuffer(sourceAccess.getIndex());
+    if (const auto numberOfChildBuffers = tupleBuffer.getNumberOfChildBuffers(); numberOfChildBuffers > 0)
+    {
+        const VariableSizedAccess::Index lastChildIndex{numberOfChildBuffers - 1};
+        if (tupleBuffer.loadChildBuffer(lastChildIndex).getAvailableMemoryArea().data()
+            == sourceChildBuffer.getAvailableMemoryArea().data())
+        {
+            return sourceAccess.relocate(lastChildIndex, sourceAccess.getOffset());
+        }
+    }
+    const auto childIndex = tupleBuffer.storeChildBuffer(sourceChildBuffer);
+    return sourceAccess.relocate(childIndex, sourceAccess.getOffset());
 }
 
-std::span<std::byte>
-TupleBufferRef::loadAssociatedVarSizedValue(const TupleBuffer& tupleBuffer, const VariableSizedAccess variableSizedAccess) noexcept
+std::span<const std::byte>
+TupleBufferRef::loadAssociatedVarSizedValue(const TupleBuffer& tupleBuffer, const VariableSizedAccess& variableSizedAccess) noexcept
 {
+    if (variableSizedAccess.isInlined())
+    {
+        return variableSizedAccess.getInlinedValue();
+    }
+
     /// Loading the childbuffer containing the variable sized data.
     auto childBuffer = tupleBuffer.loadChildBuffer(variableSizedAccess.getIndex());
 
@@ -144,26 +176,45 @@ TupleBufferRef::loadValue(const DataType& physicalType, const RecordBuffer& reco
         null = readValueFromMemRef<bool>(fieldReference);
         varValRef += 1;
     }
+    return loadValueWithoutNullByte(physicalType, recordBuffer, varValRef, null);
+}
 
+VarVal TupleBufferRef::loadValueWithoutNullByte(
+    const DataType& physicalType,
+    const RecordBuffer& recordBuffer,
+    const nautilus::val<int8_t*>& valueReference,
+    const nautilus::val<bool>& null)
+{
     if (physicalType.type != DataType::Type::VARSIZED)
     {
-        return VarVal::readVarValFromMemory(varValRef, physicalType, null);
+        return VarVal::readVarValFromMemory(valueReference, physicalType, null);
     }
 
-    auto variableSizedAccess = static_cast<nautilus::val<VariableSizedAccess*>>(varValRef);
-    const auto varSizedPtr = invoke(
-        {.modRefInfo = nautilus::ModRefInfo::Ref, .willReturn = true, .noUnwind = true},
-        +[](const TupleBuffer* tupleBuffer, const VariableSizedAccess* variableSizedAccessPtr)
-        {
-            INVARIANT(tupleBuffer != nullptr, "Tuplebuffer MUST NOT be null at this point");
-            INVARIANT(variableSizedAccessPtr != nullptr, "VariableSizedAccess MUST NOT be null at this point");
-            return loadAssociatedVarSizedValue(*tupleBuffer, *variableSizedAccessPtr).data();
-        },
-        recordBuffer.getReference(),
-        variableSizedAccess);
+    /// The size and the prefix are read from the access. Only values that are not inlined require a lookup of their child buffer.
+    auto variableSizedAccess = static_cast<nautilus::val<VariableSizedAccess*>>(valueReference);
+    const auto size
+        = static_cast<nautilus::val<uint64_t>>(*getMemberWithOffset<uint32_t>(variableSizedAccess, offsetof(VariableSizedAccess, size)));
+    const nautilus::val<uint32_t> prefix = *getMemberWithOffset<uint32_t>(variableSizedAccess, offsetof(VariableSizedAccess, prefix));
+    nautilus::val<int8_t*> varSizedPtr = valueReference + nautilus::val<uint64_t>(offsetof(VariableSizedAccess, prefix));
+    if (size > nautilus::val<uint64_t>(VariableSizedAccess::INLINE_SIZE))
+    {
+        varSizedPtr = invoke(
+            {.modRefInfo = nautilus::ModRefInfo::Ref, .willReturn = true, .noUnwind = true},
+            +[](const TupleBuffer* tupleBuffer, const VariableSizedAccess* variableSizedAccessPtr)
+            {
+                INVARIANT(tupleBuffer != nullptr, "Tuplebuffer MUST NOT be null at this point");
+                INVARIANT(variableSizedAccessPtr != nullptr, "VariableSizedAccess MUST NOT be null at this point");
+                return tupleBuffer->loadChildBuffer(variableSizedAccessPtr->getIndex())
+                    .getAvailableMemoryArea()
+                    .subspan(variableSizedAccessPtr->getOffset().getRawOffset())
+                    .data();
+            },
+            recordBuffer.getReference(),
+            variableSizedAccess);
+    }
 
-    const nautilus::val<uint64_t> size = *getMemberWithOffset<uint64_t>(variableSizedAccess, offsetof(VariableSizedAccess, size));
-    return VarVal{VariableSizedData(varSizedPtr, size), physicalType.nullable, null};
+    const VariableSizedData::Origin origin{.buffer = recordBuffer.getReference(), .access = variableSizedAccess};
+    return VarVal{VariableSizedData(varSizedPtr, size, prefix, origin), physicalType.nullable, null};
 }
 
 VarVal TupleBufferRef::storeValue(
@@ -171,7 +222,7 @@ VarVal TupleBufferRef::storeValue(
     const RecordBuffer& recordBuffer,
     const nautilus::val<int8_t*>& fieldReference,
     VarVal value,
-    const nautilus::val<AbstractBufferProvider*>& bufferProvider)
+    const nautilus::val<AbstractBufferProvider*>& bufferProvider) const
 {
     /// For now, we store the null byte before the actual VarVal
     nautilus::val<int8_t*> varValRef = fieldReference;
@@ -181,19 +232,48 @@ VarVal TupleBufferRef::storeValue(
         VarVal{value.isNull()}.writeToMemory(varValRef);
         varValRef += 1;
     }
+    return storeValueWithoutNullByte(physicalType, recordBuffer, varValRef, std::move(value), bufferProvider);
+}
+
+VarVal TupleBufferRef::storeValueWithoutNullByte(
+    const DataType& physicalType,
+    const RecordBuffer& recordBuffer,
+    const nautilus::val<int8_t*>& valueReference,
+    VarVal value,
+    const nautilus::val<AbstractBufferProvider*>& bufferProvider) const
+{
     if (physicalType.type != DataType::Type::VARSIZED)
     {
         /// We might have to cast the value to the correct type, e.g. VarVal could be a INT8 but the type we have to write is of type INT16
         /// We get the correct function to call via a unordered_map
         if (const auto storeFunction = storeValueFunctionMap.find(physicalType.type); storeFunction != storeValueFunctionMap.end())
         {
-            return storeFunction->second(value, varValRef);
+            return storeFunction->second(value, valueReference);
         }
         throw UnknownDataType("Physical Type: {} is currently not supported", physicalType);
     }
 
     const auto varSizedValue = value.getRawValueAs<VariableSizedData>();
-    auto refToIndex = static_cast<nautilus::val<VariableSizedAccess*>>(varValRef);
+    auto refToIndex = static_cast<nautilus::val<VariableSizedAccess*>>(valueReference);
+
+    if (const auto& origin = varSizedValue.getOrigin(); sharesVarSized and origin.has_value())
+    {
+        invoke(
+            +[](TupleBuffer* tupleBuffer,
+                const TupleBuffer* sourceBuffer,
+                const VariableSizedAccess* sourceAccess,
+                VariableSizedAccess* refToIndex)
+            {
+                INVARIANT(tupleBuffer != nullptr, "Tuplebuffer MUST NOT be null at this point");
+                INVARIANT(sourceBuffer != nullptr, "Source tuplebuffer MUST NOT be null at this point");
+                *refToIndex = referenceVarSized(*tupleBuffer, *sourceBuffer, *sourceAccess);
+            },
+            recordBuffer.getReference(),
+            origin->buffer,
+            origin->access,
+            refToIndex);
+        return value;
+    }
 
     invoke(
         +[](TupleBuffer* tupleBuffer,
@@ -223,6 +303,11 @@ bool TupleBufferRef::includesField(
     return std::ranges::find(projections, fieldIndex) != projections.end();
 }
 
+void TupleBufferRef::enableVarSizedSharing()
+{
+    sharesVarSized = true;
+}
+
 uint64_t TupleBufferRef::getCapacity() const
 {
     return capacity;
@@ -238,6 +323,11 @@ uint64_t TupleBufferRef::getTupleSize() const
     return tupleSize;
 }
 
+std::optional<TupleBufferRef::FieldLocation> TupleBufferRef::getFieldLocation(const Record::RecordFieldIdentifier&) const
+{
+    return std::nullopt;
+}
+
 TupleBufferRef::TupleBufferRef(const uint64_t capacity, const uint64_t bufferSize, const uint64_t tupleSize)
     : capacity(capacity), bufferSize(bufferSize), tupleSize(tupleSize)
 {
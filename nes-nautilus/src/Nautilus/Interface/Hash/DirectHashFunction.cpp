@@ -0,0 +1,65 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Nautilus/Interface/Hash/DirectHashFunction.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/DataTypes/VariableSizedData.hpp>
+#include <Nautilus/Interface/Hash/HashFunction.hpp>
+#include <ErrorHandling.hpp>
+#include <val.hpp>
+
+namespace NES
+{
+
+namespace
+{
+constexpr uint64_t LOWEST_BYTES = 0xFFFF;
+/// Multiplying two bytes with this constant copies them into all four 16 bit groups
+constexpr uint64_t BYTES_REPLICATION = UINT64_C(0x0001000100010001);
+}
+
+HashFunction::HashValue DirectHashFunction::init() const
+{
+    return 0;
+}
+
+std::unique_ptr<HashFunction> DirectHashFunction::clone() const
+{
+    return std::make_unique<DirectHashFunction>(*this);
+}
+
+HashFunction::HashValue DirectHashFunction::calculate(HashValue& hash, const VarVal& value) const
+{
+    return value
+        .customVisit(
+            [&]<typename T>(const T& val) -> VarVal
+            {
+                if constexpr (std::is_same_v<T, VariableSizedData>)
+                {
+                    PRECONDITION(false, "The DirectHashFunction only hashes fixed size values");
+                    return hash;
+                }
+                else
+                {
+                    const auto lowestBytes = static_cast<nautilus::val<uint64_t>>(val) & HashValue(LOWEST_BYTES);
+                    return hash ^ (lowestBytes * HashValue(BYTES_REPLICATION));
+                }
+            })
+        .getRawValueAs<HashValue>();
+}
+}
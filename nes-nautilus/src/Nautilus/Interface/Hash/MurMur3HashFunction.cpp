@@ -15,6 +15,8 @@
 
 #include <cstdint>
 #include <memory>
+#include <Nautilus/DataTypes/DataTypesUtil.hpp>
+#include <Nautilus/DataTypes/VarSizedDictionary.hpp>
 #include <Nautilus/DataTypes/VarVal.hpp>
 #include <Nautilus/DataTypes/VariableSizedData.hpp>
 #include <Nautilus/Interface/Hash/HashFunction.hpp>
@@ -126,6 +128,12 @@ HashFunction::HashValue MurMur3HashFunction::calculate(HashValue& hash, const Va
                 if constexpr (std::is_same_v<T, VariableSizedData>)
                 {
                     const auto& varSizedContent = val;
+                    if (varSizedContent.isInterned())
+                    {
+                        /// Interned values are followed by their hash, which the dictionary computed via hashBytes
+                        const auto offsetOfHash = VarSizedDictionary::getOffsetOfHash(varSizedContent.getSize());
+                        return hash ^ readValueFromMemRef<uint64_t>(varSizedContent.getContent() + offsetOfHash);
+                    }
                     return hash ^ nautilus::invoke(hashBytes, varSizedContent.getContent(), varSizedContent.getSize());
                 }
                 else
@@ -0,0 +1,90 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Nautilus/Interface/Hash/XXH3HashFunction.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/DataTypes/VariableSizedData.hpp>
+#include <Nautilus/Interface/Hash/HashFunction.hpp>
+#include <function.hpp>
+#include <val.hpp>
+#include <xxhash.h>
+
+namespace NES
+{
+
+namespace
+{
+/// Constant of the avalanche of XXH3, see XXH3_avalanche in xxhash.h
+constexpr uint64_t PRIME_MX1 = UINT64_C(0x165667919e3779f9);
+constexpr uint64_t AVALANCHE_SHIFT_1 = 37;
+constexpr uint64_t AVALANCHE_SHIFT_2 = 32;
+
+/// Shared by the traced code (T = nautilus::val<uint64_t>) and the batch kernel (T = uint64_t), so that both compute the same hashes.
+/// Mixing the previous hash into the value before the avalanche makes the hash depend on the order of the values.
+template <typename T>
+T mixFixedSize(const T& hash, const T& value)
+{
+    T mixed = hash ^ value;
+    mixed = mixed ^ (mixed >> T(AVALANCHE_SHIFT_1));
+    mixed = mixed * T(PRIME_MX1);
+    return mixed ^ (mixed >> T(AVALANCHE_SHIFT_2));
+}
+
+uint64_t hashBytesWithSeed(int8_t* data, const uint64_t length, const uint64_t seed)
+{
+    return XXH3_64bits_withSeed(data, length, seed);
+}
+}
+
+HashFunction::HashValue XXH3HashFunction::init() const
+{
+    return SEED;
+}
+
+std::unique_ptr<HashFunction> XXH3HashFunction::clone() const
+{
+    return std::make_unique<XXH3HashFunction>(*this);
+}
+
+void XXH3HashFunction::calculateBatch(const uint64_t* values, const uint64_t numberOfValues, uint64_t* hashes)
+{
+    for (uint64_t i = 0; i < numberOfValues; ++i)
+    {
+        hashes[i] = mixFixedSize<uint64_t>(SEED, values[i]);
+    }
+}
+
+HashFunction::HashValue XXH3HashFunction::calculate(HashValue& hash, const VarVal& value) const
+{
+    return value
+        .customVisit(
+            [&]<typename T>(const T& val) -> VarVal
+            {
+                if constexpr (std::is_same_v<T, VariableSizedData>)
+                {
+                    /// The running hash seeds XXH3, which makes the hash of a variable sized value depend on the preceding values
+                    return nautilus::invoke(hashBytesWithSeed, val.getContent(), val.getSize(), hash);
+                }
+                else
+                {
+                    return mixFixedSize<HashValue>(hash, static_cast<nautilus::val<uint64_t>>(val));
+                }
+            })
+        .getRawValueAs<HashValue>();
+}
+}
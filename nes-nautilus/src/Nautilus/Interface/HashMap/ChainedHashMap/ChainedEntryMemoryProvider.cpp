@@ -16,17 +16,21 @@
 #include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <memory>
 #include <span>
 #include <utility>
 #include <vector>
 
 #include <DataTypes/Schema.hpp>
 #include <Nautilus/DataTypes/DataTypesUtil.hpp>
+#include <Nautilus/DataTypes/VarSizedDictionary.hpp>
 #include <Nautilus/DataTypes/VarVal.hpp>
 #include <Nautilus/DataTypes/VariableSizedData.hpp>
 #include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMap.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
 #include <Nautilus/Interface/Record.hpp>
 #include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/VariableSizedAccess.hpp>
 #include <nautilus/val_ptr.hpp>
 #include <ErrorHandling.hpp>
 #include <function.hpp>
@@ -38,10 +42,20 @@
 namespace NES
 {
 
+namespace
+{
+/// The entry stores the pointer to the copy of a variable sized value, followed by its size and prefix. Thus, comparing keys only reads
+/// the copy, if the sizes and prefixes are equal. The copy starts with the size, whereas an interned value starts with its bytes.
+constexpr uint64_t VAR_SIZED_SIZE_OFFSET = sizeof(int8_t*);
+constexpr uint64_t VAR_SIZED_PREFIX_OFFSET = VAR_SIZED_SIZE_OFFSET + sizeof(uint32_t);
+static_assert(VAR_SIZED_PREFIX_OFFSET + sizeof(uint32_t) <= sizeof(VariableSizedAccess), "The size of a VARSIZED field is too small");
+}
+
 std::pair<std::vector<FieldOffsets>, std::vector<FieldOffsets>> ChainedEntryMemoryProvider::createFieldOffsets(
     const Schema& schema,
     const std::vector<Record::RecordFieldIdentifier>& fieldNameKeys,
-    const std::vector<Record::RecordFieldIdentifier>& fieldNameValues)
+    const std::vector<Record::RecordFieldIdentifier>& fieldNameValues,
+    const std::shared_ptr<VarSizedDictionary>& keyDictionary)
 {
     /// For now, we assume that we the fields lie consecutively in the memory like in a row layout.
     /// First, the key fields and then the value fields.
@@ -54,7 +68,11 @@ std::pair<std::vector<FieldOffsets>, std::vector<FieldOffsets>> ChainedEntryMemo
         const auto field = schema.getFieldByName(fieldName);
         INVARIANT(field.has_value(), "Field {} not found in schema", fieldName);
         const auto& fieldValue = field.value();
-        fieldsKey.emplace_back(FieldOffsets{.fieldIdentifier = fieldValue.name, .type = fieldValue.dataType, .fieldOffset = offset});
+        fieldsKey.emplace_back(FieldOffsets{
+            .fieldIdentifier = fieldValue.name,
+            .type = fieldValue.dataType,
+            .fieldOffset = offset,
+            .varSizedDictionary = fieldValue.dataType.isType(DataType::Type::VARSIZED) ? keyDictionary : nullptr});
         offset += fieldValue.dataType.getSizeInBytesWithNull();
     }
 
@@ -72,7 +90,7 @@ std::pair<std::vector<FieldOffsets>, std::vector<FieldOffsets>> ChainedEntryMemo
 VarVal ChainedEntryMemoryProvider::readVarVal(
     const nautilus::val<ChainedHashMapEntry*>& entryRef, const Record::RecordFieldIdentifier& fieldName) const
 {
-    for (const auto& [fieldIdentifier, type, fieldOffset] : nautilus::static_iterable(fields))
+    for (const auto& [fieldIdentifier, type, fieldOffset, varSizedDictionary] : nautilus::static_iterable(fields))
     {
         if (fieldIdentifier == fieldName)
         {
@@ -92,10 +110,16 @@ VarVal ChainedEntryMemoryProvider::readVarVal(
             {
                 const auto varSizedDataPtr
                     = nautilus::invoke(+[](const int8_t** memoryAddressInEntry) { return *memoryAddressInEntry; }, memoryAddress);
-                const auto sizeOfVarSized = readValueFromMemRef<uint32_t>(varSizedDataPtr);
+                const auto sizeOfVarSized = static_cast<nautilus::val<uint64_t>>(
+                    readValueFromMemRef<uint32_t>(memoryAddress + nautilus::val<uint64_t>(VAR_SIZED_SIZE_OFFSET)));
+                const auto prefix = readValueFromMemRef<uint32_t>(memoryAddress + nautilus::val<uint64_t>(VAR_SIZED_PREFIX_OFFSET));
+                if (varSizedDictionary != nullptr)
+                {
+                    return VariableSizedData(varSizedDataPtr, sizeOfVarSized, prefix, varSizedDictionary->getId());
+                }
                 const auto payloadOffset = nautilus::val<uint32_t>(sizeof(uint32_t));
                 const auto varSizedPayloadPtr = varSizedDataPtr + payloadOffset;
-                VariableSizedData varSizedData(varSizedPayloadPtr, sizeOfVarSized);
+                VariableSizedData varSizedData(varSizedPayloadPtr, sizeOfVarSized, prefix);
                 return varSizedData;
             }
 
@@ -109,7 +133,7 @@ VarVal ChainedEntryMemoryProvider::readVarVal(
 Record ChainedEntryMemoryProvider::readRecord(const nautilus::val<ChainedHashMapEntry*>& entryRef) const
 {
     Record record;
-    for (const auto& [fieldIdentifier, type, fieldOffset] : nautilus::static_iterable(fields))
+    for (const auto& [fieldIdentifier, type, fieldOffset, varSizedDictionary] : nautilus::static_iterable(fields))
     {
         const auto value = readVarVal(entryRef, fieldIdentifier);
         record.write(fieldIdentifier, value);
@@ -121,17 +145,18 @@ Record ChainedEntryMemoryProvider::readRecord(const nautilus::val<ChainedHashMap
 namespace
 {
 void storeVarSized(
-    const nautilus::val<ChainedHashMap*>& hashMapRef,
+    const nautilus::val<HashMap*>& hashMapRef,
     const nautilus::val<AbstractBufferProvider*>& bufferProviderRef,
     const nautilus::val<int8_t*>& memoryAddress,
     const VariableSizedData& variableSizedData)
 {
     nautilus::invoke(
-        +[](ChainedHashMap* hashMap,
+        +[](HashMap* hashMap,
             AbstractBufferProvider* bufferProvider,
             const int8_t** memoryAddressInEntry,
             const int8_t* varSizedData,
-            const uint64_t varSizedDataSize)
+            const uint64_t varSizedDataSize,
+            const uint32_t prefix)
         {
             constexpr size_t sizeOfIndex = sizeof(uint32_t);
             auto spaceForVarSizedData = hashMap->allocateSpaceForVarSized(bufferProvider, varSizedDataSize + sizeOfIndex);
@@ -139,19 +164,63 @@ void storeVarSized(
             *reinterpret_cast<uint32_t*>(spaceForVarSizedData.data()) = varSizedDataSize;
             std::ranges::copy(std::as_bytes(varSizedSpan), spaceForVarSizedData.begin() + sizeOfIndex);
             *memoryAddressInEntry = reinterpret_cast<const signed char*>(spaceForVarSizedData.data());
+            const auto sizeInEntry = static_cast<uint32_t>(varSizedDataSize);
+            std::memcpy(reinterpret_cast<int8_t*>(memoryAddressInEntry) + VAR_SIZED_SIZE_OFFSET, &sizeInEntry, sizeof(sizeInEntry));
+            std::memcpy(reinterpret_cast<int8_t*>(memoryAddressInEntry) + VAR_SIZED_PREFIX_OFFSET, &prefix, sizeof(prefix));
         },
         hashMapRef,
         bufferProviderRef,
         memoryAddress,
         variableSizedData.getContent(),
-        variableSizedData.getSize());
+        variableSizedData.getSize(),
+        variableSizedData.getPrefix());
+}
+
+void writeInternedVarSizedToEntry(int8_t* memoryAddressInEntry, const int8_t* internedValue, const uint64_t size, const uint32_t prefix)
+{
+    const auto sizeInEntry = static_cast<uint32_t>(size);
+    std::memcpy(memoryAddressInEntry, &internedValue, sizeof(internedValue));
+    std::memcpy(memoryAddressInEntry + VAR_SIZED_SIZE_OFFSET, &sizeInEntry, sizeof(sizeInEntry));
+    std::memcpy(memoryAddressInEntry + VAR_SIZED_PREFIX_OFFSET, &prefix, sizeof(prefix));
+}
+
+/// Values that the dictionary has already interned, e.g., the keys of other entries, are stored without looking them up again
+void storeInternedVarSized(
+    VarSizedDictionary* dictionary, const nautilus::val<int8_t*>& memoryAddress, const VariableSizedData& variableSizedData)
+{
+    if (variableSizedData.getDictionaryId() == dictionary->getId())
+    {
+        nautilus::invoke(
+            writeInternedVarSizedToEntry,
+            memoryAddress,
+            variableSizedData.getContent(),
+            variableSizedData.getSize(),
+            variableSizedData.getPrefix());
+        return;
+    }
+    nautilus::invoke(
+        +[](VarSizedDictionary* keyDictionary,
+            int8_t* memoryAddressInEntry,
+            const int8_t* varSizedData,
+            const uint64_t varSizedDataSize,
+            const uint32_t prefix)
+        {
+            const auto* const internedValue = internVarSizedProxy(keyDictionary, varSizedData, varSizedDataSize);
+            writeInternedVarSizedToEntry(memoryAddressInEntry, internedValue, varSizedDataSize, prefix);
+        },
+        nautilus::val<VarSizedDictionary*>(dictionary),
+        memoryAddress,
+        variableSizedData.getContent(),
+        variableSizedData.getSize(),
+        variableSizedData.getPrefix());
 }
 
 void writeVarVal(
     const VarVal& value,
     const nautilus::val<int8_t*>& fieldAddress,
     const DataType& type,
-    const nautilus::val<ChainedHashMap*>& hashMapRef,
+    VarSizedDictionary* dictionary,
+    const nautilus::val<HashMap*>& hashMapRef,
     const nautilus::val<AbstractBufferProvider*>& bufferProvider)
 {
     /// For now, we store the null byte before the actual VarVal
@@ -166,7 +235,15 @@ void writeVarVal(
     if (type.isType(DataType::Type::VARSIZED))
     {
         const auto varSizedValue = value.getRawValueAs<VariableSizedData>();
-        storeVarSized(hashMapRef, bufferProvider, memoryAddress, varSizedValue);
+        /// As the dictionary is a C++ variable, this branch does not impact our tracing or the execution.
+        if (dictionary != nullptr)
+        {
+            storeInternedVarSized(dictionary, memoryAddress, varSizedValue);
+        }
+        else
+        {
+            storeVarSized(hashMapRef, bufferProvider, memoryAddress, varSizedValue);
+        }
     }
     else
     {
@@ -177,36 +254,36 @@ void writeVarVal(
 
 void ChainedEntryMemoryProvider::writeRecord(
     const nautilus::val<ChainedHashMapEntry*>& entryRef,
-    const nautilus::val<ChainedHashMap*>& hashMapRef,
+    const nautilus::val<HashMap*>& hashMapRef,
     const nautilus::val<AbstractBufferProvider*>& bufferProvider,
     const Record& record) const
 {
-    for (const auto& [fieldIdentifier, type, fieldOffset] : nautilus::static_iterable(fields))
+    for (const auto& [fieldIdentifier, type, fieldOffset, varSizedDictionary] : nautilus::static_iterable(fields))
     {
         const auto& value = record.read(fieldIdentifier);
         auto castedEntryAddress = static_cast<nautilus::val<int8_t*>>(entryRef);
-        writeVarVal(value, castedEntryAddress + fieldOffset, type, hashMapRef, bufferProvider);
+        writeVarVal(value, castedEntryAddress + fieldOffset, type, varSizedDictionary.get(), hashMapRef, bufferProvider);
     }
 }
 
 void ChainedEntryMemoryProvider::writeEntryRef(
     const nautilus::val<ChainedHashMapEntry*>& entryRef,
-    const nautilus::val<ChainedHashMap*>& hashMapRef,
+    const nautilus::val<HashMap*>& hashMapRef,
     const nautilus::val<AbstractBufferProvider*>& bufferProvider,
     const nautilus::val<ChainedHashMapEntry*>& otherEntryRef) const
 {
-    for (const auto& [fieldIdentifier, type, fieldOffset] : nautilus::static_iterable(fields))
+    for (const auto& [fieldIdentifier, type, fieldOffset, varSizedDictionary] : nautilus::static_iterable(fields))
     {
         const auto value = readVarVal(otherEntryRef, fieldIdentifier);
         auto castedEntryAddress = static_cast<nautilus::val<int8_t*>>(entryRef);
-        writeVarVal(value, castedEntryAddress + fieldOffset, type, hashMapRef, bufferProvider);
+        writeVarVal(value, castedEntryAddress + fieldOffset, type, varSizedDictionary.get(), hashMapRef, bufferProvider);
     }
 }
 
 std::vector<Record::RecordFieldIdentifier> ChainedEntryMemoryProvider::getAllFieldIdentifiers() const
 {
     std::vector<Record::RecordFieldIdentifier> fieldIdentifiers;
-    for (const auto& [fieldIdentifier, type, fieldOffset] : nautilus::static_iterable(fields))
+    for (const auto& [fieldIdentifier, type, fieldOffset, varSizedDictionary] : nautilus::static_iterable(fields))
     {
         fieldIdentifiers.push_back(fieldIdentifier);
     }
@@ -22,9 +22,11 @@
 #include <memory>
 #include <span>
 #include <string>
+#include <utility>
 #include <Nautilus/Interface/Hash/HashFunction.hpp>
 #include <Nautilus/Interface/HashMap/HashMap.hpp>
 #include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/TupleBuffer.hpp>
 #include <ErrorHandling.hpp>
 
 namespace NES
@@ -64,6 +66,9 @@ ChainedHashMap::ChainedHashMap(uint64_t entrySize, const uint64_t numberOfBucket
     , numberOfChains(calcCapacity(numberOfBuckets, assumedLoadFactor))
     , entries(nullptr)
     , mask(numberOfChains - 1)
+    , oldEntries(nullptr)
+    , numberOfOldChains(0)
+    , numberOfMigratedChains(0)
     , destructorCallBack(nullptr)
 {
     PRECONDITION(entrySize > 0, "Entry size has to be greater than 0. Entry size is set to small for entry size {}", entrySize);
@@ -90,6 +95,9 @@ ChainedHashMap::ChainedHashMap(const uint64_t keySize, const uint64_t valueSize,
     , numberOfChains(calcCapacity(numberOfBuckets, assumedLoadFactor))
     , entries(nullptr)
     , mask(numberOfChains - 1)
+    , oldEntries(nullptr)
+    , numberOfOldChains(0)
+    , numberOfMigratedChains(0)
     , destructorCallBack({})
 {
     PRECONDITION(entrySize > 0, "Entry size has to be greater than 0. Entry size is set to small for entry size {}", entrySize);
@@ -118,15 +126,119 @@ void ChainedHashMap::setDestructorCallback(const std::function<void(ChainedHashM
     destructorCallBack = callback;
 }
 
-std::unique_ptr<ChainedHashMap> ChainedHashMap::createNewMapWithSameConfiguration(const ChainedHashMap& other)
+std::unique_ptr<HashMap> ChainedHashMap::createNewMapWithSameConfiguration() const
 {
-    return std::make_unique<ChainedHashMap>(other.entrySize, other.numberOfChains, other.pageSize);
+    return std::make_unique<ChainedHashMap>(entrySize, numberOfChains, pageSize);
 }
 
 ChainedHashMapEntry* ChainedHashMap::findChain(const HashFunction::HashValue::raw_type hash) const
 {
-    const auto entryStartPos = hash & mask;
-    return entries[entryStartPos];
+    auto* const taggedChainStart = *getChainStart(hash);
+    /// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    if ((reinterpret_cast<uintptr_t>(taggedChainStart) & getChainTag(hash)) == 0)
+    {
+        return nullptr;
+    }
+    return untagChainStart(taggedChainStart);
+}
+
+ChainedHashMapEntry* ChainedHashMap::untagChainStart(ChainedHashMapEntry* taggedChainStart)
+{
+    /// NOLINTNEXTLINE(performance-no-int-to-ptr, cppcoreguidelines-pro-type-reinterpret-cast)
+    return reinterpret_cast<ChainedHashMapEntry*>(reinterpret_cast<uintptr_t>(taggedChainStart) & CHAIN_POINTER_MASK);
+}
+
+void ChainedHashMap::prependToChain(ChainedHashMapEntry** chainStart, ChainedHashMapEntry* entry)
+{
+    /// NOLINTBEGIN(performance-no-int-to-ptr, cppcoreguidelines-pro-type-reinterpret-cast)
+    const auto entryAddress = reinterpret_cast<uintptr_t>(entry);
+    INVARIANT((entryAddress & ~CHAIN_POINTER_MASK) == 0, "Entry address {} uses the bits of the chain tag", entryAddress);
+    const auto tag = (reinterpret_cast<uintptr_t>(*chainStart) & ~CHAIN_POINTER_MASK) | getChainTag(entry->hash);
+    entry->next = untagChainStart(*chainStart);
+    *chainStart = reinterpret_cast<ChainedHashMapEntry*>(entryAddress | tag);
+    /// NOLINTEND(performance-no-int-to-ptr, cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+ChainedHashMapEntry** ChainedHashMap::getChainStart(const HashFunction::HashValue::raw_type hash) const
+{
+    if (isMigrating())
+    {
+        /// The number of old chains is a power of 2, as we always double the number of chains
+        if (const auto oldEntryPos = hash & (numberOfOldChains - 1); oldEntryPos >= numberOfMigratedChains)
+        {
+            return &oldEntries[oldEntryPos];
+        }
+    }
+    const auto entryPos = hash & mask;
+    INVARIANT(entryPos < numberOfChains, "Invalid entry position as pos {} is greater than capacity {}", entryPos, numberOfChains);
+    return &entries[entryPos];
+}
+
+TupleBuffer ChainedHashMap::allocateEntrySpace(const uint64_t numberOfChains, AbstractBufferProvider* bufferProvider)
+{
+    /// We add one more entry to the capacity, as we need to have a valid entry for the last entry in the entries array
+    /// We will be using this entry for checking, if we are at the end of our hash map in our EntryIterator
+    const auto totalSpace = (numberOfChains + 1) * sizeof(ChainedHashMapEntry*);
+    auto entryBuffer = bufferProvider->getUnpooledBuffer(totalSpace);
+    if (not entryBuffer)
+    {
+        throw CannotAllocateBuffer("Could not allocate memory for ChainedHashMap of size {}", std::to_string(totalSpace));
+    }
+    auto* const newEntries = reinterpret_cast<ChainedHashMapEntry**>(entryBuffer->getAvailableMemoryArea().data()); /// NOLINT
+    std::memset(static_cast<void*>(newEntries), 0, entryBuffer->getBufferSize());
+
+    /// Pointing the end of the entries to itself
+    newEntries[numberOfChains] = reinterpret_cast<ChainedHashMapEntry*>(&newEntries[numberOfChains]); /// NOLINT
+    return entryBuffer.value();
+}
+
+void ChainedHashMap::grow(AbstractBufferProvider* bufferProvider)
+{
+    /// The previous migration has always finished at this point (see CHAINS_MIGRATED_PER_INSERT). We still make sure that no old chain is
+    /// left behind, as we overwrite the old entry space.
+    migrateChains(numberOfOldChains);
+
+    auto newEntrySpace = allocateEntrySpace(numberOfChains * 2, bufferProvider);
+    oldEntrySpace = std::move(entrySpace);
+    oldEntries = entries;
+    numberOfOldChains = numberOfChains;
+    numberOfMigratedChains = 0;
+
+    entrySpace = std::move(newEntrySpace);
+    entries = reinterpret_cast<ChainedHashMapEntry**>(entrySpace.getAvailableMemoryArea().data()); /// NOLINT
+    numberOfChains *= 2;
+    mask = numberOfChains - 1;
+    ++growthStatistics.numberOfResizes;
+}
+
+void ChainedHashMap::migrateChains(const uint64_t numberOfChainsToMigrate)
+{
+    if (not isMigrating())
+    {
+        return;
+    }
+
+    const auto lastChainToMigrate = std::min(numberOfOldChains, numberOfMigratedChains + numberOfChainsToMigrate);
+    for (; numberOfMigratedChains < lastChainToMigrate; ++numberOfMigratedChains)
+    {
+        /// The entries do not move in the storage space, we only relink them into the chains of the current entry space
+        auto* entry = untagChainStart(oldEntries[numberOfMigratedChains]);
+        while (entry != nullptr)
+        {
+            auto* const next = entry->next;
+            prependToChain(&entries[entry->hash & mask], entry);
+            ++growthStatistics.numberOfRehashedEntries;
+            entry = next;
+        }
+    }
+
+    if (numberOfMigratedChains == numberOfOldChains)
+    {
+        oldEntrySpace = TupleBuffer{};
+        oldEntries = nullptr;
+        numberOfOldChains = 0;
+        numberOfMigratedChains = 0;
+    }
 }
 
 std::span<std::byte> ChainedHashMap::allocateSpaceForVarSized(AbstractBufferProvider* bufferProvider, const size_t neededSize)
@@ -158,21 +270,14 @@ AbstractHashMapEntry* ChainedHashMap::insertEntry(const HashFunction::HashValue:
     /// 0. Checking, if we have to set fill the entry space. This should be only done once, i.e., when the entries are still null
     if (entries == nullptr) [[unlikely]]
     {
-        /// We add one more entry to the capacity, as we need to have a valid entry for the last entry in the entries array
-        /// We will be using this entry for checking, if we are at the end of our hash map in our EntryIterator
-        const auto totalSpace = (numberOfChains + 1) * sizeof(ChainedHashMapEntry*);
-        const auto entryBuffer = bufferProvider->getUnpooledBuffer(totalSpace);
-        if (not entryBuffer)
-        {
-            throw CannotAllocateBuffer("Could not allocate memory for ChainedHashMap of size {}", std::to_string(totalSpace));
-        }
-        entrySpace = entryBuffer.value();
-        entries = reinterpret_cast<ChainedHashMapEntry**>(entrySpace.getAvailableMemoryArea().data());
-        std::memset(static_cast<void*>(entries), 0, entryBuffer->getBufferSize());
-
-        /// Pointing the end of the entries to itself
-        entries[numberOfChains] = reinterpret_cast<ChainedHashMapEntry*>(&entries[numberOfChains]);
+        entrySpace = allocateEntrySpace(numberOfChains, bufferProvider);
+        entries = reinterpret_cast<ChainedHashMapEntry**>(entrySpace.getAvailableMemoryArea().data()); /// NOLINT
+    }
+    else if (numberOfTuples >= numberOfChains * MAX_LOAD_FACTOR) [[unlikely]]
+    {
+        grow(bufferProvider);
     }
+    migrateChains(CHAINS_MIGRATED_PER_INSERT);
 
     /// 1. Check if we need to allocate a new page
     if (numberOfTuples % entriesPerPage == 0)
@@ -198,15 +303,10 @@ AbstractHashMapEntry* ChainedHashMap::insertEntry(const HashFunction::HashValue:
     const auto entryOffsetInBuffer = (numberOfTuples - (pageIndex * entriesPerPage)) * entrySize;
 
     /// 3. Inserting the new entry
-    const auto entryPos = hash & mask;
-    INVARIANT(entryPos <= mask, "Invalid entry position, as pos {} is greater than mask {}", entryPos, mask);
-    INVARIANT(entryPos < numberOfChains, "Invalid entry position as pos {} is greater than capacity {}", entryPos, numberOfChains);
     auto* const newEntry = new (bufferStorage.getAvailableMemoryArea().subspan(entryOffsetInBuffer).data()) ChainedHashMapEntry(hash);
 
-    /// 4. Updating the chain and the current size
-    auto* const oldValue = entries[entryPos];
-    newEntry->next = oldValue;
-    entries[entryPos] = newEntry;
+    /// 4. Updating the chain and the current size. While migrating, the chain might still be in the old entry space.
+    prependToChain(getChainStart(hash), newEntry);
     this->numberOfTuples++;
     return newEntry;
 }
@@ -222,10 +322,59 @@ uint64_t ChainedHashMap::getNumberOfPages() const
     return storageSpace.size();
 }
 
+uint64_t ChainedHashMap::getEntrySize() const
+{
+    return entrySize;
+}
+
+bool ChainedHashMap::hasVarSizedData() const
+{
+    return not varSizedSpace.empty();
+}
+
+void ChainedHashMap::insertCopiesOfEntries(const std::span<const std::byte> entries, AbstractBufferProvider* bufferProvider)
+{
+    PRECONDITION(
+        entries.size() % entrySize == 0, "The size of the entries {}B is not a multiple of the entry size {}B", entries.size(), entrySize);
+    for (size_t entryOffset = 0; entryOffset < entries.size(); entryOffset += entrySize)
+    {
+        /// The copied entries might not be aligned, thus we do not access them as ChainedHashMapEntry. Their next pointers get replaced.
+        HashFunction::HashValue::raw_type hash{};
+        std::memcpy(&hash, entries.subspan(entryOffset + offsetof(ChainedHashMapEntry, hash)).data(), sizeof(hash));
+        auto* const newEntry = reinterpret_cast<std::byte*>(insertEntry(hash, bufferProvider)); /// NOLINT
+        std::memcpy(
+            newEntry + sizeof(ChainedHashMapEntry),
+            entries.subspan(entryOffset + sizeof(ChainedHashMapEntry)).data(),
+            entrySize - sizeof(ChainedHashMapEntry));
+    }
+}
+
 ChainedHashMapEntry* ChainedHashMap::getStartOfChain(const uint64_t entryIdx) const
 {
     PRECONDITION(entryIdx <= numberOfChains, "Entry index {} is greater than the capacity {}", entryIdx, numberOfChains);
-    return entries[entryIdx];
+    return untagChainStart(entries[entryIdx]);
+}
+
+void ChainedHashMap::prefetchChains(const std::span<const std::byte> otherEntries, const uint64_t otherEntrySize) const
+{
+    if (entries == nullptr)
+    {
+        return;
+    }
+    /// NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+    /// We first prefetch all chain starts, so that their cache misses overlap, and then the first entries of the loaded chain starts
+    for (uint64_t offset = 0; offset + sizeof(ChainedHashMapEntry) <= otherEntries.size(); offset += otherEntrySize)
+    {
+        __builtin_prefetch(getChainStart(reinterpret_cast<const ChainedHashMapEntry*>(otherEntries.data() + offset)->hash));
+    }
+    for (uint64_t offset = 0; offset + sizeof(ChainedHashMapEntry) <= otherEntries.size(); offset += otherEntrySize)
+    {
+        if (const auto* chainStart = findChain(reinterpret_cast<const ChainedHashMapEntry*>(otherEntries.data() + offset)->hash))
+        {
+            __builtin_prefetch(chainStart);
+        }
+    }
+    /// NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
 }
 
 uint64_t ChainedHashMap::getNumberOfChains() const
@@ -233,29 +382,58 @@ uint64_t ChainedHashMap::getNumberOfChains() const
     return numberOfChains;
 }
 
+bool ChainedHashMap::isMigrating() const
+{
+    return numberOfMigratedChains < numberOfOldChains;
+}
+
+HashMapGrowthStatistics ChainedHashMap::getGrowthStatistics() const
+{
+    return growthStatistics;
+}
+
 void ChainedHashMap::clear() noexcept
 {
     /// Deleting all entries in the hash map
-    if (entries != nullptr and destructorCallBack != nullptr)
+    if (destructorCallBack != nullptr)
     {
         /// Calling for every value in the hash map the destructor callback
-        /// We start here by iterating over all entries while starting in the entry space
-        for (uint64_t entryIdx = 0; entryIdx < numberOfChains; ++entryIdx)
+        /// We iterate over the storage space, as the chains might be distributed over the old and the current entry space
+        for (auto& page : storageSpace)
         {
-            auto* entry = entries[entryIdx];
-            while (entry != nullptr)
+            for (uint64_t indexOnPage = 0; indexOnPage < page.getNumberOfTuples(); ++indexOnPage)
             {
-                auto* next = entry->next;
-                destructorCallBack(entry);
-                entry = next;
+                auto* const entryMemory = page.getAvailableMemoryArea().subspan(indexOnPage * entrySize).data();
+                destructorCallBack(reinterpret_cast<ChainedHashMapEntry*>(entryMemory)); /// NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
             }
         }
     }
     entries = nullptr;
+    oldEntries = nullptr;
+    numberOfOldChains = 0;
+    numberOfMigratedChains = 0;
     numberOfTuples = 0;
 
     /// Releasing all memory
+    entrySpace = TupleBuffer{};
+    oldEntrySpace = TupleBuffer{};
     storageSpace.clear();
+    varSizedSpace.clear();
+}
+
+void ChainedHashMap::reset() noexcept
+{
+    const auto hasEntrySpace = entries != nullptr;
+    auto currentEntrySpace = std::move(entrySpace);
+    clear();
+    growthStatistics = HashMapGrowthStatistics{};
+    if (hasEntrySpace)
+    {
+        /// The end of the entries still points to itself, as we keep the same entry space
+        entrySpace = std::move(currentEntrySpace);
+        entries = reinterpret_cast<ChainedHashMapEntry**>(entrySpace.getAvailableMemoryArea().data()); /// NOLINT
+        std::memset(static_cast<void*>(entries), 0, numberOfChains * sizeof(ChainedHashMapEntry*));
+    }
 }
 
 }
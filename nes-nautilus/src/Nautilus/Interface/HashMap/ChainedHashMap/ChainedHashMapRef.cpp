@@ -13,11 +13,13 @@
 */
 #include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMapRef.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <exception>
 #include <functional>
 #include <limits>
+#include <span>
 #include <utility>
 #include <vector>
 #include <DataTypes/DataType.hpp>
@@ -135,9 +137,51 @@ nautilus::val<ChainedHashMapEntry*> ChainedHashMapRef::ChainedEntryRef::getNext(
     return next;
 }
 
+nautilus::val<bool> ChainedHashMapRef::ChainedEntryRef::compareKeys(const Record& keys) const
+{
+    /// Most hash maps have a single fixed size key, which we compare with a single comparison of the value in the entry, as neither
+    /// null values nor multiple fields have to be taken into account
+    if (const auto& fields = memoryProviderKeys.getAllFields();
+        fields.size() == 1 and not fields.front().type.nullable and not fields.front().type.isType(DataType::Type::VARSIZED))
+    {
+        const auto& [fieldIdentifier, type, fieldOffset, varSizedDictionary] = fields.front();
+        const auto fieldAddress = static_cast<nautilus::val<int8_t*>>(entryRef) + fieldOffset;
+        const auto entryValue = VarVal::readVarValFromMemory(fieldAddress, type, false);
+        return (keys.read(fieldIdentifier).castToType(type.type) == entryValue).getRawValueAs<nautilus::val<bool>>();
+    }
+
+    nautilus::val<bool> result{true};
+    for (const auto& [fieldIdentifier, type, fieldOffset, varSizedDictionary] :
+         nautilus::static_iterable(memoryProviderKeys.getAllFields()))
+    {
+        /// We need to take the null values into account as they are a separate group.
+        /// Thus, a simple if (keys.read(fieldIdentifier) != getKey(fieldIdentifier)) is not enough
+        const auto& keyValue = keys.read(fieldIdentifier);
+        const auto entryValue = getKey(fieldIdentifier);
+        const auto nullsMatch = keyValue.isNull() == entryValue.isNull();
+        result = result and nullsMatch;
+
+        if (type.isType(DataType::Type::VARSIZED))
+        {
+            result = nautilus::select(
+                keyValue.getRawValueAs<VariableSizedData>() != entryValue.getRawValueAs<VariableSizedData>(),
+                nautilus::val<bool>{false},
+                result);
+        }
+        else
+        {
+            result = nautilus::select(
+                (keyValue.castToType(type.type) != entryValue.castToType(type.type)).getRawValueAs<nautilus::val<bool>>(),
+                nautilus::val<bool>{false},
+                result);
+        }
+    }
+    return result;
+}
+
 ChainedHashMapRef::ChainedEntryRef::ChainedEntryRef(
     const nautilus::val<ChainedHashMapEntry*>& entryRef,
-    const nautilus::val<ChainedHashMap*>& hashMapRef,
+    const nautilus::val<HashMap*>& hashMapRef,
     std::vector<FieldOffsets> fieldsKey,
     std::vector<FieldOffsets> fieldsValue)
     : entryRef(entryRef), hashMapRef(hashMapRef), memoryProviderKeys(std::move(fieldsKey)), memoryProviderValues(std::move(fieldsValue))
@@ -146,7 +190,7 @@ ChainedHashMapRef::ChainedEntryRef::ChainedEntryRef(
 
 ChainedHashMapRef::ChainedEntryRef::ChainedEntryRef(
     const nautilus::val<ChainedHashMapEntry*>& entryRef,
-    const nautilus::val<ChainedHashMap*>& hashMapRef,
+    const nautilus::val<HashMap*>& hashMapRef,
     ChainedEntryMemoryProvider memoryProviderKeys,
     ChainedEntryMemoryProvider memoryProviderValues)
     : entryRef(entryRef)
@@ -172,7 +216,7 @@ nautilus::val<ChainedHashMapEntry*> ChainedHashMapRef::findKey(const Record& rec
     while (entry)
     {
         const ChainedEntryRef entryRef(entry, hashMapRef, fieldKeys, fieldValues);
-        if (compareKeys(entryRef, recordKey))
+        if (entryRef.compareKeys(recordKey))
         {
             return entry;
         }
@@ -195,6 +239,21 @@ nautilus::val<AbstractHashMapEntry*> ChainedHashMapRef::findEntry(const nautilus
     return entryRef;
 }
 
+nautilus::val<ChainedHashMapEntry*> ChainedHashMapRef::findEntry(const Record& recordKey, const HashFunction& hashFunction) const
+{
+    std::vector<VarVal> keyValues;
+    for (const auto& [fieldIdentifier, type, fieldOffset, varSizedDictionary] : nautilus::static_iterable(fieldKeys))
+    {
+        keyValues.emplace_back(recordKey.read(fieldIdentifier));
+    }
+    return findKey(recordKey, hashFunction.calculate(keyValues));
+}
+
+nautilus::val<ChainedHashMapEntry*> ChainedHashMapRef::findEntry(const Record& recordKey, const HashFunction::HashValue& hash) const
+{
+    return findKey(recordKey, hash);
+}
+
 nautilus::val<AbstractHashMapEntry*> ChainedHashMapRef::findOrCreateEntry(
     const Record& recordKey,
     const HashFunction& hashFunction,
@@ -205,7 +264,7 @@ nautilus::val<AbstractHashMapEntry*> ChainedHashMapRef::findOrCreateEntry(
     /// We can use here a std::vector to store the read VarValues of the keyFunction, as the number of keys does not change between
     /// tracing and run time of the compiled query
     std::vector<VarVal> keyValues;
-    for (const auto& [fieldIdentifier, type, fieldOffset] : nautilus::static_iterable(fieldKeys))
+    for (const auto& [fieldIdentifier, type, fieldOffset, varSizedDictionary] : nautilus::static_iterable(fieldKeys))
     {
         const auto& keyValue = recordKey.read(fieldIdentifier);
         keyValues.emplace_back(keyValue);
@@ -295,6 +354,30 @@ ChainedHashMapRef::EntryIterator ChainedHashMapRef::end() const
     return {hashMapRef, nullptr, entrySize, numberOfTuples, -1, -1, -1, -1};
 }
 
+void ChainedHashMapRef::prefetchForEntries(const EntryIterator& otherEntries) const
+{
+    if (otherEntries.indexOnPage % HashMap::PREFETCH_GROUP_SIZE == 0)
+    {
+        nautilus::invoke(
+            +[](const HashMap* hashMap,
+                const ChainedHashMapEntry* firstEntry,
+                const uint64_t otherEntrySize,
+                const uint64_t indexOnPage,
+                const uint64_t numberOfTuplesOnPage)
+            {
+                const auto numberOfEntries = std::min(HashMap::PREFETCH_GROUP_SIZE, numberOfTuplesOnPage - indexOnPage);
+                /// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+                const std::span otherEntriesOfGroup{reinterpret_cast<const std::byte*>(firstEntry), numberOfEntries * otherEntrySize};
+                dynamic_cast<const ChainedHashMap*>(hashMap)->prefetchChains(otherEntriesOfGroup, otherEntrySize);
+            },
+            hashMapRef,
+            otherEntries.currentEntry,
+            otherEntries.entrySize,
+            otherEntries.indexOnPage,
+            otherEntries.numberOfTuplesInCurrentPage);
+    }
+}
+
 nautilus::val<ChainedHashMapEntry*> ChainedHashMapRef::findChain(const HashFunction::HashValue& hash) const
 {
     const auto numberOfTuplesRef = getMemberRef(hashMapRef, &ChainedHashMap::numberOfTuples);
@@ -304,13 +387,45 @@ nautilus::val<ChainedHashMapEntry*> ChainedHashMapRef::findChain(const HashFunct
         return nullptr;
     }
 
+    /// While the hash map grows, the chains that have not been moved yet are still in the old entry space
+    const auto numberOfOldChainsRef = getMemberRef(hashMapRef, &ChainedHashMap::numberOfOldChains);
+    const auto numberOfOldChains = readValueFromMemRef<uint64_t>(numberOfOldChainsRef);
+    const auto numberOfMigratedChainsRef = getMemberRef(hashMapRef, &ChainedHashMap::numberOfMigratedChains);
+    const auto numberOfMigratedChains = readValueFromMemRef<uint64_t>(numberOfMigratedChainsRef);
+    if (numberOfMigratedChains < numberOfOldChains)
+    {
+        const auto oldEntryStartPos = hash & (numberOfOldChains - 1);
+        if (oldEntryStartPos >= numberOfMigratedChains)
+        {
+            return readChainStart(getMemberRef(hashMapRef, &ChainedHashMap::oldEntries), oldEntryStartPos, hash);
+        }
+    }
+
     const auto maskRef = getMemberRef(hashMapRef, &ChainedHashMap::mask);
     auto mask = readValueFromMemRef<uint64_t>(maskRef);
     const auto entryStartPos = hash & mask;
-    const auto entriesRef = getMemberRef(hashMapRef, &ChainedHashMap::entries);
-    auto entries = readValueFromMemRef<ChainedHashMapEntry**>(entriesRef);
-    const nautilus::val<ChainedHashMapEntry*> chainStart = entries[entryStartPos];
-    return chainStart;
+    return readChainStart(getMemberRef(hashMapRef, &ChainedHashMap::entries), entryStartPos, hash);
+}
+
+nautilus::val<ChainedHashMapEntry*> ChainedHashMapRef::readChainStart(
+    const nautilus::val<int8_t*>& entriesRef, const nautilus::val<uint64_t>& entryStartPos, const HashFunction::HashValue& hash)
+{
+    /// We check the tag of the chain start first, so that we do not have to dereference any entry of a chain without the hash
+    auto taggedChainStarts = readValueFromMemRef<uint64_t*>(entriesRef);
+    const nautilus::val<uint64_t> taggedChainStart = taggedChainStarts[entryStartPos];
+    const nautilus::val<uint64_t> tagShift{ChainedHashMap::CHAIN_TAG_SHIFT};
+    const nautilus::val<uint64_t> hashShift{ChainedHashMap::HASH_SHIFT_FOR_CHAIN_TAG};
+    const auto chainTag = nautilus::val<uint64_t>{1} << (tagShift + (hash >> hashShift));
+    if ((taggedChainStart & chainTag) == 0)
+    {
+        return nullptr;
+    }
+
+    /// Removing the tag by subtracting its bits from the tagged pointer
+    auto chainStarts = readValueFromMemRef<int8_t**>(entriesRef);
+    const nautilus::val<int8_t*> chainStart = chainStarts[entryStartPos];
+    const nautilus::val<uint64_t> tagMask{~ChainedHashMap::CHAIN_POINTER_MASK};
+    return static_cast<nautilus::val<ChainedHashMapEntry*>>(chainStart - (taggedChainStart & tagMask));
 }
 
 nautilus::val<ChainedHashMapEntry*>
@@ -325,36 +440,6 @@ ChainedHashMapRef::insert(const HashFunction::HashValue& hash, const nautilus::v
     return static_cast<nautilus::val<ChainedHashMapEntry*>>(newEntry);
 }
 
-nautilus::val<bool> ChainedHashMapRef::compareKeys(const ChainedEntryRef& entryRef, const Record& keys) const
-{
-    nautilus::val<bool> result{true};
-    for (const auto& [fieldIdentifier, type, fieldOffset] : nautilus::static_iterable(fieldKeys))
-    {
-        /// We need to take the null values into account as they are a separate group.
-        /// Thus, a simple if (keys.read(fieldIdentifier) != entryRef.getKey(fieldIdentifier)) is not enough
-        const auto& keyValue = keys.read(fieldIdentifier);
-        const auto entryValue = entryRef.getKey(fieldIdentifier);
-        const auto nullsMatch = keyValue.isNull() == entryValue.isNull();
-        result = result and nullsMatch;
-
-        if (type.isType(DataType::Type::VARSIZED))
-        {
-            result = nautilus::select(
-                keyValue.getRawValueAs<VariableSizedData>() != entryValue.getRawValueAs<VariableSizedData>(),
-                nautilus::val<bool>{false},
-                result);
-        }
-        else
-        {
-            result = nautilus::select(
-                (keyValue.castToType(type.type) != entryValue.castToType(type.type)).getRawValueAs<nautilus::val<bool>>(),
-                nautilus::val<bool>{false},
-                result);
-        }
-    }
-    return result;
-}
-
 ChainedHashMapRef::ChainedHashMapRef(
     const nautilus::val<HashMap*>& hashMapRef,
     std::vector<FieldOffsets> fieldsKey,
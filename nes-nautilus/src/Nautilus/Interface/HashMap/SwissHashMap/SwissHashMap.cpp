@@ -0,0 +1,354 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Nautilus/Interface/HashMap/SwissHashMap/SwissHashMap.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <Nautilus/Interface/Hash/HashFunction.hpp>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMap.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <ErrorHandling.hpp>
+
+#if defined(__x86_64__)
+    #include <emmintrin.h>
+#elif defined(__aarch64__)
+    #include <arm_neon.h>
+#endif
+
+namespace NES
+{
+namespace
+{
+static_assert(SwissHashMap::GROUP_SIZE == 16, "The group matching expects 16 control bytes per group");
+
+/// The lower 7 bits of the hash are stored in the control byte of the slot, the remaining bits determine the start of the probe sequence
+constexpr HashFunction::HashValue::raw_type H2_MASK = 0x7F;
+constexpr uint64_t H1_SHIFT = 7;
+
+/// Returns a bit mask, in which the i-th bit is set, if the i-th control byte of the group is equal to the control byte.
+/// SSE2 and NEON are part of the baseline of x86-64 and aarch64, thus, we do not need any runtime dispatching.
+uint32_t matchGroup(const uint8_t* group, const uint8_t controlByte)
+{
+#if defined(__x86_64__)
+    const auto groupBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group)); /// NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    const auto equal = _mm_cmpeq_epi8(groupBytes, _mm_set1_epi8(static_cast<char>(controlByte)));
+    return static_cast<uint32_t>(_mm_movemask_epi8(equal));
+#elif defined(__aarch64__)
+    /// NEON has no movemask, thus, we select one bit per byte and add up the bits of each half of the group
+    static constexpr uint8_t bitOfByte[SwissHashMap::GROUP_SIZE] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    const auto equal = vceqq_u8(vld1q_u8(group), vdupq_n_u8(controlByte));
+    const auto bits = vandq_u8(equal, vld1q_u8(bitOfByte));
+    return static_cast<uint32_t>(vaddv_u8(vget_low_u8(bits))) | (static_cast<uint32_t>(vaddv_u8(vget_high_u8(bits))) << 8U);
+#else
+    uint32_t matches = 0;
+    for (uint64_t i = 0; i < SwissHashMap::GROUP_SIZE; ++i)
+    {
+        matches |= static_cast<uint32_t>(group[i] == controlByte) << i;
+    }
+    return matches;
+#endif
+}
+}
+
+SwissHashMap::SwissHashMap(const uint64_t entrySize, const uint64_t numberOfBuckets, const uint64_t pageSize)
+    : numberOfTuples(0)
+    , pageSize(pageSize)
+    , entrySize(entrySize)
+    , entriesPerPage(pageSize / entrySize)
+    , initialNumberOfSlots(std::max(GROUP_SIZE, std::bit_ceil(numberOfBuckets)))
+    , numberOfSlots(0)
+    , mask(0)
+    , controlBytes(nullptr)
+    , slots(nullptr)
+    , destructorCallBack(nullptr)
+{
+    PRECONDITION(entrySize > 0, "Entry size has to be greater than 0. Entry size is set to small for entry size {}", entrySize);
+    PRECONDITION(
+        entriesPerPage > 0,
+        "At least one entry has to fit on a page. Pagesize is set to small for pageSize {} and entry size {}",
+        pageSize,
+        entrySize);
+    PRECONDITION(numberOfBuckets > 0, "Number of buckets {} has to be greater than 0", numberOfBuckets);
+}
+
+SwissHashMap::SwissHashMap(const uint64_t keySize, const uint64_t valueSize, const uint64_t numberOfBuckets, const uint64_t pageSize)
+    : SwissHashMap(sizeof(ChainedHashMapEntry) + keySize + valueSize, numberOfBuckets, pageSize)
+{
+}
+
+SwissHashMap::~SwissHashMap()
+{
+    clear();
+}
+
+void SwissHashMap::setDestructorCallback(const std::function<void(ChainedHashMapEntry*)>& callback)
+{
+    destructorCallBack = callback;
+}
+
+std::unique_ptr<HashMap> SwissHashMap::createNewMapWithSameConfiguration() const
+{
+    return std::make_unique<SwissHashMap>(entrySize, initialNumberOfSlots, pageSize);
+}
+
+std::span<std::byte> SwissHashMap::allocateSpaceForVarSized(AbstractBufferProvider* bufferProvider, const size_t neededSize)
+{
+    if (varSizedSpace.empty() or varSizedSpace.back().getNumberOfTuples() + neededSize >= varSizedSpace.back().getBufferSize())
+    {
+        /// We allocate more space than currently necessary for the variable sized data to reduce the allocation overhead
+        auto varSizedBuffer = bufferProvider->getUnpooledBuffer(neededSize * NUMBER_OF_PRE_ALLOCATED_VAR_SIZED_ITEMS);
+        if (not varSizedBuffer)
+        {
+            throw CannotAllocateBuffer(
+                "Could not allocate memory for SwissHashMap of size {}", std::to_string(neededSize * NUMBER_OF_PRE_ALLOCATED_VAR_SIZED_ITEMS));
+        }
+        varSizedSpace.emplace_back(varSizedBuffer.value());
+    }
+
+    varSizedSpace.back().setNumberOfTuples(varSizedSpace.back().getNumberOfTuples() + neededSize);
+    return varSizedSpace.back().getAvailableMemoryArea().subspan(varSizedSpace.back().getNumberOfTuples() - neededSize);
+}
+
+uint64_t SwissHashMap::getNumberOfTuples() const
+{
+    return numberOfTuples;
+}
+
+AbstractHashMapEntry* SwissHashMap::insertEntry(const HashFunction::HashValue::raw_type hash, AbstractBufferProvider* bufferProvider)
+{
+    /// 1. Growing the slots, if the new entry would exceed the maximum load factor. This also allocates the slots for the first entry.
+    if ((numberOfTuples + 1) * MAX_LOAD_FACTOR_DENOMINATOR > numberOfSlots * MAX_LOAD_FACTOR_NUMERATOR) [[unlikely]]
+    {
+        resize(numberOfSlots == 0 ? initialNumberOfSlots : numberOfSlots * 2, bufferProvider);
+    }
+
+    /// 2. Check if we need to allocate a new page
+    if (numberOfTuples % entriesPerPage == 0)
+    {
+        auto newPage = bufferProvider->getUnpooledBuffer(pageSize);
+        if (not newPage)
+        {
+            throw CannotAllocateBuffer("Could not allocate memory for new page in SwissHashMap of size {}", std::to_string(pageSize));
+        }
+        std::ranges::fill(newPage.value().getAvailableMemoryArea(), std::byte{0});
+        storageSpace.emplace_back(newPage.value());
+    }
+
+    /// 3. Creating the new entry at the end of the last page
+    const auto pageIndex = numberOfTuples / entriesPerPage;
+    INVARIANT(
+        storageSpace.size() > pageIndex,
+        "Invalid page index {} as it is greater than the number of pages {}",
+        pageIndex,
+        storageSpace.size());
+    auto& bufferStorage = storageSpace[pageIndex];
+    bufferStorage.setNumberOfTuples(bufferStorage.getNumberOfTuples() + 1);
+    const auto entryOffsetInBuffer = (numberOfTuples - (pageIndex * entriesPerPage)) * entrySize;
+    auto* const newEntry = new (bufferStorage.getAvailableMemoryArea().subspan(entryOffsetInBuffer).data()) ChainedHashMapEntry(hash);
+
+    /// 4. Inserting the new entry into the first empty slot of its probe sequence
+    insertIntoEmptySlot(newEntry);
+    ++numberOfTuples;
+    return newEntry;
+}
+
+void SwissHashMap::prefetchProbeSequences(const std::span<const std::byte> otherEntries, const uint64_t otherEntrySize) const
+{
+    if (numberOfSlots == 0)
+    {
+        return;
+    }
+    for (uint64_t offset = 0; offset + sizeof(ChainedHashMapEntry) <= otherEntries.size(); offset += otherEntrySize)
+    {
+        /// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        const auto hash = reinterpret_cast<const ChainedHashMapEntry*>(otherEntries.data() + offset)->hash;
+        const auto slot = (hash >> H1_SHIFT) & mask;
+        __builtin_prefetch(controlBytes + slot);
+        __builtin_prefetch(slots + slot);
+    }
+}
+
+uint64_t SwissHashMap::findNextCandidateSlot(const HashFunction::HashValue::raw_type hash, const uint64_t previousSlot) const
+{
+    if (numberOfSlots == 0)
+    {
+        return NO_SLOT;
+    }
+
+    /// As we never delete entries, there is no empty slot between the start of the probe sequence and the previous slot.
+    /// Thus, we can continue the probe sequence directly after the previous slot.
+    const auto h2 = static_cast<uint8_t>(hash & H2_MASK);
+    auto slot = previousSlot == NO_SLOT ? (hash >> H1_SHIFT) & mask : (previousSlot + 1) & mask;
+    for (uint64_t probedSlots = 0; probedSlots < numberOfSlots; probedSlots += GROUP_SIZE)
+    {
+        const auto* group = controlBytes + slot;
+        auto matches = matchGroup(group, h2);
+        const auto emptySlots = matchGroup(group, EMPTY_SLOT);
+        if (emptySlots != 0)
+        {
+            /// Slots after the first empty slot do not belong to the probe sequence
+            matches &= (1U << std::countr_zero(emptySlots)) - 1;
+        }
+
+        while (matches != 0)
+        {
+            /// The h2 has only 7 bits, thus, we compare the full hash before the caller has to compare the keys
+            const auto candidateSlot = (slot + std::countr_zero(matches)) & mask;
+            if (slots[candidateSlot]->hash == hash)
+            {
+                return candidateSlot;
+            }
+            matches &= matches - 1;
+        }
+
+        if (emptySlots != 0)
+        {
+            return NO_SLOT;
+        }
+        slot = (slot + GROUP_SIZE) & mask;
+    }
+    return NO_SLOT;
+}
+
+ChainedHashMapEntry* SwissHashMap::getEntryInSlot(const uint64_t slot) const
+{
+    PRECONDITION(slot < numberOfSlots, "Slot {} is greater than the number of slots {}", slot, numberOfSlots);
+    return slots[slot];
+}
+
+const TupleBuffer& SwissHashMap::getPage(const uint64_t pageIndex) const
+{
+    PRECONDITION(pageIndex < storageSpace.size(), "Page index {} is greater than the number of pages {}", pageIndex, storageSpace.size());
+    return storageSpace[pageIndex];
+}
+
+uint64_t SwissHashMap::getNumberOfPages() const
+{
+    return storageSpace.size();
+}
+
+uint64_t SwissHashMap::getNumberOfSlots() const
+{
+    return numberOfSlots;
+}
+
+HashMapGrowthStatistics SwissHashMap::getGrowthStatistics() const
+{
+    return growthStatistics;
+}
+
+void SwissHashMap::resize(const uint64_t newNumberOfSlots, AbstractBufferProvider* bufferProvider)
+{
+    INVARIANT(
+        newNumberOfSlots >= GROUP_SIZE and std::has_single_bit(newNumberOfSlots),
+        "Number of slots {} has to be a power of 2 of at least {}",
+        newNumberOfSlots,
+        GROUP_SIZE);
+
+    /// The slots are stored before the control bytes to keep the slots aligned
+    const auto totalSpace = (newNumberOfSlots * sizeof(ChainedHashMapEntry*)) + newNumberOfSlots + GROUP_SIZE;
+    auto newSlotBuffer = bufferProvider->getUnpooledBuffer(totalSpace);
+    if (not newSlotBuffer)
+    {
+        throw CannotAllocateBuffer("Could not allocate memory for the slots of the SwissHashMap of size {}", std::to_string(totalSpace));
+    }
+    slotSpace = newSlotBuffer.value();
+    auto* const slotMemory = slotSpace.getAvailableMemoryArea().data();
+    slots = reinterpret_cast<ChainedHashMapEntry**>(slotMemory); /// NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    controlBytes = reinterpret_cast<uint8_t*>(slotMemory + (newNumberOfSlots * sizeof(ChainedHashMapEntry*))); /// NOLINT
+    std::memset(controlBytes, EMPTY_SLOT, newNumberOfSlots + GROUP_SIZE);
+    numberOfSlots = newNumberOfSlots;
+    mask = newNumberOfSlots - 1;
+
+    /// Allocating the slots for the first entry is not a growth of the hash map
+    if (numberOfTuples > 0)
+    {
+        ++growthStatistics.numberOfResizes;
+        growthStatistics.numberOfRehashedEntries += numberOfTuples;
+    }
+
+    /// Reinserting all entries. The entries stay at the same position in the storage space, we only rebuild the slots.
+    for (auto& page : storageSpace)
+    {
+        for (uint64_t indexOnPage = 0; indexOnPage < page.getNumberOfTuples(); ++indexOnPage)
+        {
+            auto* entry = reinterpret_cast<ChainedHashMapEntry*>(page.getAvailableMemoryArea().subspan(indexOnPage * entrySize).data()); /// NOLINT
+            insertIntoEmptySlot(entry);
+        }
+    }
+}
+
+void SwissHashMap::insertIntoEmptySlot(ChainedHashMapEntry* entry)
+{
+    auto slot = (entry->hash >> H1_SHIFT) & mask;
+    while (true)
+    {
+        if (const auto emptySlots = matchGroup(controlBytes + slot, EMPTY_SLOT); emptySlots != 0)
+        {
+            slot = (slot + std::countr_zero(emptySlots)) & mask;
+            setControlByte(slot, static_cast<uint8_t>(entry->hash & H2_MASK));
+            slots[slot] = entry;
+            return;
+        }
+        slot = (slot + GROUP_SIZE) & mask;
+    }
+}
+
+void SwissHashMap::setControlByte(const uint64_t slot, const uint8_t controlByte)
+{
+    controlBytes[slot] = controlByte;
+    if (slot < GROUP_SIZE)
+    {
+        /// Mirroring the first group after the last slot
+        controlBytes[numberOfSlots + slot] = controlByte;
+    }
+}
+
+void SwissHashMap::clear() noexcept
+{
+    /// Calling for every entry in the hash map the destructor callback
+    if (destructorCallBack != nullptr)
+    {
+        for (auto& page : storageSpace)
+        {
+            for (uint64_t indexOnPage = 0; indexOnPage < page.getNumberOfTuples(); ++indexOnPage)
+            {
+                destructorCallBack(
+                    reinterpret_cast<ChainedHashMapEntry*>(page.getAvailableMemoryArea().subspan(indexOnPage * entrySize).data())); /// NOLINT
+            }
+        }
+    }
+    numberOfTuples = 0;
+    numberOfSlots = 0;
+    mask = 0;
+    controlBytes = nullptr;
+    slots = nullptr;
+
+    /// Releasing all memory
+    slotSpace = TupleBuffer{};
+    storageSpace.clear();
+    varSizedSpace.clear();
+}
+
+}
@@ -0,0 +1,310 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+#include <Nautilus/Interface/HashMap/SwissHashMap/SwissHashMapRef.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <utility>
+#include <vector>
+#include <Nautilus/DataTypes/DataTypesUtil.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/Hash/HashFunction.hpp>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMap.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Nautilus/Interface/HashMap/HashMapRef.hpp>
+#include <Nautilus/Interface/HashMap/SwissHashMap/SwissHashMap.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
+#include <nautilus/function.hpp>
+#include <nautilus/static.hpp>
+#include <nautilus/val.hpp>
+#include <nautilus/val_ptr.hpp>
+
+namespace NES
+{
+namespace
+{
+uint64_t findNextCandidateSlotProxy(const HashMap* hashMap, const HashFunction::HashValue::raw_type hash, const uint64_t previousSlot)
+{
+    return dynamic_cast<const SwissHashMap*>(hashMap)->findNextCandidateSlot(hash, previousSlot);
+}
+
+const std::byte* getFirstEntryOfPageProxy(const HashMap* hashMap, const uint64_t pageIndex)
+{
+    const auto* swissHashMap = dynamic_cast<const SwissHashMap*>(hashMap);
+    if (pageIndex >= swissHashMap->getNumberOfPages())
+    {
+        return nullptr;
+    }
+    return swissHashMap->getPage(pageIndex).getAvailableMemoryArea().data();
+}
+
+void prefetchProbeSequencesProxy(
+    const HashMap* hashMap,
+    const ChainedHashMapEntry* firstEntry,
+    const uint64_t otherEntrySize,
+    const uint64_t indexOnPage,
+    const uint64_t numberOfTuplesOnPage)
+{
+    const auto numberOfEntries = std::min(HashMap::PREFETCH_GROUP_SIZE, numberOfTuplesOnPage - indexOnPage);
+    /// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    const std::span otherEntriesOfGroup{reinterpret_cast<const std::byte*>(firstEntry), numberOfEntries * otherEntrySize};
+    dynamic_cast<const SwissHashMap*>(hashMap)->prefetchProbeSequences(otherEntriesOfGroup, otherEntrySize);
+}
+
+uint64_t getNumberOfTuplesOnPageProxy(const HashMap* hashMap, const uint64_t pageIndex)
+{
+    const auto* swissHashMap = dynamic_cast<const SwissHashMap*>(hashMap);
+    if (pageIndex >= swissHashMap->getNumberOfPages())
+    {
+        return 0;
+    }
+    return swissHashMap->getPage(pageIndex).getNumberOfTuples();
+}
+}
+
+nautilus::val<ChainedHashMapEntry*> SwissHashMapRef::findKey(const Record& recordKey, const HashFunction::HashValue& hash) const
+{
+    /// The C++ runtime returns all slots in the probe sequence, whose entry has the same hash. Thus, we only have to compare the keys.
+    const auto slots = readValueFromMemRef<ChainedHashMapEntry**>(getMemberRef(hashMapRef, &SwissHashMap::slots));
+    const nautilus::val<uint64_t> noSlot{SwissHashMap::NO_SLOT};
+    auto slot = nautilus::invoke(findNextCandidateSlotProxy, hashMapRef, hash, noSlot);
+    while (slot != noSlot)
+    {
+        const nautilus::val<ChainedHashMapEntry*> entry = slots[slot];
+        const ChainedEntryRef entryRef(entry, hashMapRef, fieldKeys, fieldValues);
+        if (entryRef.compareKeys(recordKey))
+        {
+            return entry;
+        }
+        slot = nautilus::invoke(findNextCandidateSlotProxy, hashMapRef, hash, slot);
+    }
+    return nullptr;
+}
+
+nautilus::val<AbstractHashMapEntry*> SwissHashMapRef::findEntry(const nautilus::val<AbstractHashMapEntry*>& otherEntry)
+{
+    const auto otherChainedEntry = static_cast<nautilus::val<ChainedHashMapEntry*>>(otherEntry);
+    const ChainedEntryRef otherEntryRef{otherChainedEntry, hashMapRef, fieldKeys, fieldValues};
+    const auto entryRef = findKey(otherEntryRef.getKey(), otherEntryRef.getHash());
+    return entryRef;
+}
+
+nautilus::val<ChainedHashMapEntry*> SwissHashMapRef::findEntry(const Record& recordKey, const HashFunction::HashValue& hash) const
+{
+    return findKey(recordKey, hash);
+}
+
+nautilus::val<AbstractHashMapEntry*> SwissHashMapRef::findOrCreateEntry(
+    const Record& recordKey,
+    const HashFunction& hashFunction,
+    const std::function<void(nautilus::val<AbstractHashMapEntry*>&)>& onInsert,
+    const nautilus::val<AbstractBufferProvider*>& bufferProvider)
+{
+    /// Calculating the hash value of the keys and finding the entry.
+    std::vector<VarVal> keyValues;
+    for (const auto& [fieldIdentifier, type, fieldOffset, varSizedDictionary] : nautilus::static_iterable(fieldKeys))
+    {
+        const auto& keyValue = recordKey.read(fieldIdentifier);
+        keyValues.emplace_back(keyValue);
+    }
+
+    const auto hashValue = hashFunction.calculate(keyValues);
+    if (const auto entryRef = findKey(recordKey, hashValue))
+    {
+        return static_cast<nautilus::val<AbstractHashMapEntry*>>(entryRef);
+    }
+
+    /// We have not found the entry, so we need to insert a new one and copy the keys into the entry.
+    const auto newEntryRef = ChainedEntryRef{insert(hashValue, bufferProvider), hashMapRef, fieldKeys, fieldValues};
+    newEntryRef.copyKeysToEntry(recordKey, bufferProvider);
+
+    /// Calling the onInsert lambda function to insert values or anything else that the user wants.
+    auto castedEntryRef = static_cast<nautilus::val<AbstractHashMapEntry*>>(newEntryRef.entryRef);
+    if (onInsert)
+    {
+        onInsert(castedEntryRef);
+    }
+    return castedEntryRef;
+}
+
+void SwissHashMapRef::insertOrUpdateEntry(
+    const nautilus::val<AbstractHashMapEntry*>& otherEntry,
+    const std::function<void(nautilus::val<AbstractHashMapEntry*>&)>& onUpdate,
+    const std::function<void(nautilus::val<AbstractHashMapEntry*>&)>& onInsert,
+    const nautilus::val<AbstractBufferProvider*>& bufferProvider)
+{
+    const auto otherChainedEntry = static_cast<nautilus::val<ChainedHashMapEntry*>>(otherEntry);
+    const ChainedEntryRef otherEntryRef(otherChainedEntry, hashMapRef, fieldKeys, fieldValues);
+    if (const auto entryRef = findKey(otherEntryRef.getKey(), otherEntryRef.getHash()))
+    {
+        auto castedEntry = static_cast<nautilus::val<AbstractHashMapEntry*>>(entryRef);
+        if (onUpdate)
+        {
+            onUpdate(castedEntry);
+        }
+        return;
+    }
+
+    /// We have not found the entry, so we need to insert a new one and copy the keys into the entry.
+    const ChainedEntryRef newEntryRef(insert(otherEntryRef.getHash(), bufferProvider), hashMapRef, fieldKeys, fieldValues);
+    newEntryRef.copyKeysToEntry(otherEntryRef, bufferProvider);
+    if (onInsert)
+    {
+        auto castedEntryRef = static_cast<nautilus::val<AbstractHashMapEntry*>>(newEntryRef.entryRef);
+        onInsert(castedEntryRef);
+    }
+}
+
+nautilus::val<ChainedHashMapEntry*>
+SwissHashMapRef::insert(const HashFunction::HashValue& hash, const nautilus::val<AbstractBufferProvider*>& bufferProvider)
+{
+    const auto newEntry = nautilus::invoke(
+        +[](HashMap* hashMap, const HashFunction::HashValue::raw_type hashValue, AbstractBufferProvider* bufferProviderVal)
+        { return dynamic_cast<SwissHashMap*>(hashMap)->insertEntry(hashValue, bufferProviderVal); },
+        hashMapRef,
+        hash,
+        bufferProvider);
+    return static_cast<nautilus::val<ChainedHashMapEntry*>>(newEntry);
+}
+
+void SwissHashMapRef::prefetchForEntries(const EntryIterator& otherEntries) const
+{
+    if (otherEntries.indexOnPage % HashMap::PREFETCH_GROUP_SIZE == 0)
+    {
+        nautilus::invoke(
+            prefetchProbeSequencesProxy,
+            hashMapRef,
+            otherEntries.currentEntry,
+            otherEntries.entrySize,
+            otherEntries.indexOnPage,
+            otherEntries.numberOfTuplesInCurrentPage);
+    }
+}
+
+SwissHashMapRef::EntryIterator SwissHashMapRef::begin() const
+{
+    const nautilus::val<uint64_t> tupleIndex = 0;
+    const nautilus::val<uint64_t> indexOnPage = 0;
+    const nautilus::val<uint64_t> pageIndex = 0;
+    const auto currentEntry = nautilus::invoke(getFirstEntryOfPageProxy, hashMapRef, pageIndex);
+    const auto numberOfTuplesInCurrentPage = nautilus::invoke(getNumberOfTuplesOnPageProxy, hashMapRef, pageIndex);
+    const auto numberOfPages = nautilus::invoke(
+        +[](const HashMap* hashMap) { return dynamic_cast<const SwissHashMap*>(hashMap)->getNumberOfPages(); }, hashMapRef);
+    return {
+        hashMapRef,
+        static_cast<nautilus::val<ChainedHashMapEntry*>>(currentEntry),
+        entrySize,
+        tupleIndex,
+        indexOnPage,
+        numberOfTuplesInCurrentPage,
+        pageIndex,
+        numberOfPages};
+}
+
+SwissHashMapRef::EntryIterator SwissHashMapRef::end() const
+{
+    /// The iterator pointing to the end() should NEVER be advanced. Therefore, we do not need to set a lot of its members
+    const auto numberOfTuples = readValueFromMemRef<uint64_t>(getMemberRef(hashMapRef, &SwissHashMap::numberOfTuples));
+    return {hashMapRef, nullptr, entrySize, numberOfTuples, -1, -1, -1, -1};
+}
+
+SwissHashMapRef::SwissHashMapRef(
+    const nautilus::val<HashMap*>& hashMapRef,
+    std::vector<FieldOffsets> fieldsKey,
+    std::vector<FieldOffsets> fieldsValue,
+    const nautilus::val<uint64_t>& entriesPerPage,
+    const nautilus::val<uint64_t>& entrySize)
+    : HashMapRef(hashMapRef)
+    , fieldKeys(std::move(fieldsKey))
+    , fieldValues(std::move(fieldsValue))
+    , entriesPerPage(entriesPerPage)
+    , entrySize(entrySize)
+{
+}
+
+SwissHashMapRef::SwissHashMapRef(const SwissHashMapRef& other)
+    : SwissHashMapRef(other.hashMapRef, other.fieldKeys, other.fieldValues, other.entriesPerPage, other.entrySize)
+{
+}
+
+SwissHashMapRef& SwissHashMapRef::operator=(const SwissHashMapRef& other)
+{
+    hashMapRef = other.hashMapRef;
+    fieldKeys = other.fieldKeys;
+    fieldValues = other.fieldValues;
+    entriesPerPage = other.entriesPerPage;
+    entrySize = other.entrySize;
+    return *this;
+}
+
+SwissHashMapRef::EntryIterator::EntryIterator(
+    const nautilus::val<HashMap*>& hashMapRef,
+    const nautilus::val<ChainedHashMapEntry*>& currentEntry,
+    const nautilus::val<uint64_t>& entrySize,
+    const nautilus::val<uint64_t>& tupleIndex,
+    const nautilus::val<uint64_t>& indexOnPage,
+    const nautilus::val<uint64_t>& numberOfTuplesInCurrentPage,
+    const nautilus::val<uint64_t>& pageIndex,
+    const nautilus::val<uint64_t>& numberOfPages)
+    : hashMapRef(hashMapRef)
+    , currentEntry(currentEntry)
+    , entrySize(entrySize)
+    , tupleIndex(tupleIndex)
+    , indexOnPage(indexOnPage)
+    , numberOfTuplesInCurrentPage(numberOfTuplesInCurrentPage)
+    , pageIndex(pageIndex)
+    , numberOfPages(numberOfPages)
+{
+}
+
+SwissHashMapRef::EntryIterator& SwissHashMapRef::EntryIterator::operator++()
+{
+    ++tupleIndex;
+    ++indexOnPage;
+    if (indexOnPage >= numberOfTuplesInCurrentPage)
+    {
+        indexOnPage = 0;
+        if (pageIndex + 1 >= numberOfPages)
+        {
+            return *this;
+        }
+        ++pageIndex;
+        currentEntry = static_cast<nautilus::val<ChainedHashMapEntry*>>(nautilus::invoke(getFirstEntryOfPageProxy, hashMapRef, pageIndex));
+        numberOfTuplesInCurrentPage = nautilus::invoke(getNumberOfTuplesOnPageProxy, hashMapRef, pageIndex);
+        return *this;
+    }
+    currentEntry = static_cast<nautilus::val<int8_t*>>(currentEntry) + entrySize;
+    return *this;
+}
+
+nautilus::val<bool> SwissHashMapRef::EntryIterator::operator==(const EntryIterator& other) const
+{
+    return tupleIndex == other.tupleIndex;
+}
+
+nautilus::val<bool> SwissHashMapRef::EntryIterator::operator!=(const EntryIterator& other) const
+{
+    return not(*this == other);
+}
+
+nautilus::val<ChainedHashMapEntry*> SwissHashMapRef::EntryIterator::operator*() const
+{
+    return currentEntry;
+}
+
+}
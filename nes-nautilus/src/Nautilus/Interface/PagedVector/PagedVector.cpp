@@ -14,27 +14,191 @@
 #include <Nautilus/Interface/PagedVector/PagedVector.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <iterator>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <ranges>
+#include <span>
+#include <utility>
 #include <vector>
 #include <Runtime/AbstractBufferProvider.hpp>
 #include <Runtime/TupleBuffer.hpp>
+#include <Runtime/VariableSizedAccess.hpp>
 #include <ErrorHandling.hpp>
 
 namespace NES
 {
 
+namespace
+{
+/// A compressed page starts with a PageHeader, followed by one ColumnHeader per column and the encoded values of all columns.
+struct PageHeader
+{
+    uint64_t bufferSize;
+    uint64_t numberOfColumns;
+};
+
+enum class ColumnEncoding : uint8_t
+{
+    RAW,
+    CONSTANT,
+    FRAME_OF_REFERENCE
+};
+
+struct ColumnHeader
+{
+    PagedVector::Column column;
+    ColumnEncoding encoding;
+    /// Width of the offsets to the reference for the frame of reference encoding
+    uint64_t encodedWidth;
+    uint64_t reference;
+    /// Position of the encoded values in the compressed page
+    uint64_t dataOffset;
+};
+
+uint64_t loadUnsigned(const std::byte* value, const uint64_t width)
+{
+    uint64_t result = 0;
+    std::memcpy(&result, value, width);
+    return result;
+}
+
+void storeUnsigned(std::byte* value, const uint64_t result, const uint64_t width)
+{
+    std::memcpy(value, &result, width);
+}
+
+/// Chooses the smallest encoding for the values of the column on the page. Does not set the dataOffset.
+ColumnHeader chooseEncoding(const std::byte* page, const PagedVector::Column& column, const uint64_t numberOfEntries)
+{
+    const std::byte* firstValue = page + column.offset;
+    bool isConstant = true;
+    for (uint64_t i = 1; i < numberOfEntries and isConstant; ++i)
+    {
+        isConstant = std::memcmp(firstValue, page + column.offset + (i * column.stride), column.width) == 0;
+    }
+    if (isConstant)
+    {
+        return {.column = column, .encoding = ColumnEncoding::CONSTANT, .encodedWidth = 0, .reference = 0, .dataOffset = 0};
+    }
+
+    if (column.width == 2 or column.width == 4 or column.width == 8)
+    {
+        uint64_t minimum = std::numeric_limits<uint64_t>::max();
+        uint64_t maximum = 0;
+        for (uint64_t i = 0; i < numberOfEntries; ++i)
+        {
+            const auto value = loadUnsigned(page + column.offset + (i * column.stride), column.width);
+            minimum = std::min(minimum, value);
+            maximum = std::max(maximum, value);
+        }
+        for (const uint64_t encodedWidth : {1UL, 2UL, 4UL})
+        {
+            if (encodedWidth < column.width and maximum - minimum <= (std::numeric_limits<uint64_t>::max() >> (64 - (8 * encodedWidth))))
+            {
+                return {
+                    .column = column,
+                    .encoding = ColumnEncoding::FRAME_OF_REFERENCE,
+                    .encodedWidth = encodedWidth,
+                    .reference = minimum,
+                    .dataOffset = 0};
+            }
+        }
+    }
+    return {.column = column, .encoding = ColumnEncoding::RAW, .encodedWidth = column.width, .reference = 0, .dataOffset = 0};
+}
+
+uint64_t getEncodedSize(const ColumnHeader& header, const uint64_t numberOfEntries)
+{
+    switch (header.encoding)
+    {
+        case ColumnEncoding::CONSTANT:
+            return header.column.width;
+        case ColumnEncoding::FRAME_OF_REFERENCE:
+        case ColumnEncoding::RAW:
+            return header.encodedWidth * numberOfEntries;
+    }
+    std::unreachable();
+}
+
+void encodeColumn(const std::byte* page, std::byte* compressedPage, const ColumnHeader& header, const uint64_t numberOfEntries)
+{
+    const auto& [offset, stride, width] = header.column;
+    std::byte* data = compressedPage + header.dataOffset;
+    switch (header.encoding)
+    {
+        case ColumnEncoding::CONSTANT:
+            std::memcpy(data, page + offset, width);
+            return;
+        case ColumnEncoding::FRAME_OF_REFERENCE:
+            for (uint64_t i = 0; i < numberOfEntries; ++i)
+            {
+                const auto value = loadUnsigned(page + offset + (i * stride), width);
+                storeUnsigned(data + (i * header.encodedWidth), value - header.reference, header.encodedWidth);
+            }
+            return;
+        case ColumnEncoding::RAW:
+            for (uint64_t i = 0; i < numberOfEntries; ++i)
+            {
+                std::memcpy(data + (i * width), page + offset + (i * stride), width);
+            }
+            return;
+    }
+}
+
+void decodeColumn(const std::byte* compressedPage, std::byte* page, const ColumnHeader& header, const uint64_t numberOfEntries)
+{
+    const auto& [offset, stride, width] = header.column;
+    const std::byte* data = compressedPage + header.dataOffset;
+    switch (header.encoding)
+    {
+        case ColumnEncoding::CONSTANT:
+            for (uint64_t i = 0; i < numberOfEntries; ++i)
+            {
+                std::memcpy(page + offset + (i * stride), data, width);
+            }
+            return;
+        case ColumnEncoding::FRAME_OF_REFERENCE:
+            for (uint64_t i = 0; i < numberOfEntries; ++i)
+            {
+                const auto value = loadUnsigned(data + (i * header.encodedWidth), header.encodedWidth);
+                storeUnsigned(page + offset + (i * stride), value + header.reference, width);
+            }
+            return;
+        case ColumnEncoding::RAW:
+            for (uint64_t i = 0; i < numberOfEntries; ++i)
+            {
+                std::memcpy(page + offset + (i * stride), data + (i * width), width);
+            }
+            return;
+    }
+}
+
+/// Var sized values reference the child buffers by their index. Thus, the child buffers have to keep their order.
+void moveChildBuffers(const TupleBuffer& source, TupleBuffer& destination)
+{
+    for (uint32_t childIndex = 0; childIndex < source.getNumberOfChildBuffers(); ++childIndex)
+    {
+        auto childBuffer = source.loadChildBuffer(VariableSizedAccess::Index{childIndex});
+        const auto newChildIndex = destination.storeChildBuffer(childBuffer);
+        INVARIANT(newChildIndex == VariableSizedAccess::Index{childIndex}, "Child buffer {} changed its index", childIndex);
+    }
+}
+}
+
 void PagedVector::appendPageIfFull(AbstractBufferProvider* bufferProvider, const uint64_t capacity, const uint64_t bufferSize)
 {
     PRECONDITION(bufferProvider != nullptr, "EntrySize for a pagedVector has to be larger than 0!");
     PRECONDITION(capacity > 0, "At least one tuple has to fit on a page!");
 
-    if (pages.getNumberOfPages() == 0 || pages.getNumberOfTuplesLastPage() >= capacity)
+    if (pages.getNumberOfPages() == 0 || isLastPageFull(capacity))
     {
         if (const auto page = bufferProvider->getUnpooledBuffer(bufferSize); page.has_value())
         {
@@ -47,6 +211,98 @@ void PagedVector::appendPageIfFull(AbstractBufferProvider* bufferProvider, const
     }
 }
 
+bool PagedVector::isLastPageFull(const uint64_t capacity) const
+{
+    return pages.getNumberOfPages() > 0 && pages.getNumberOfTuplesLastPage() >= capacity;
+}
+
+void PagedVector::compressLastPage(AbstractBufferProvider* bufferProvider, const std::span<const Column> columns)
+{
+    PRECONDITION(bufferProvider != nullptr, "The buffer provider for compressing a page must not be null!");
+    PRECONDITION(pages.getNumberOfPages() > 0, "compressLastPage() should be called after a page has been inserted!");
+    const auto pageIndex = pages.getNumberOfPages() - 1;
+    auto& lastPage = pages[pageIndex];
+    const auto numberOfEntries = lastPage.buffer.getNumberOfTuples();
+    if (lastPage.compressed or columns.empty() or numberOfEntries == 0)
+    {
+        return;
+    }
+
+    const auto* page = lastPage.buffer.getAvailableMemoryArea().data();
+    std::vector<ColumnHeader> columnHeaders;
+    columnHeaders.reserve(columns.size());
+    uint64_t compressedSize = sizeof(PageHeader) + (columns.size() * sizeof(ColumnHeader));
+    for (const auto& column : columns)
+    {
+        auto& columnHeader = columnHeaders.emplace_back(chooseEncoding(page, column, numberOfEntries));
+        columnHeader.dataOffset = compressedSize;
+        compressedSize += getEncodedSize(columnHeader, numberOfEntries);
+    }
+    if (compressedSize >= lastPage.buffer.getBufferSize())
+    {
+        return;
+    }
+
+    auto compressedPage = bufferProvider->getUnpooledBuffer(compressedSize);
+    if (not compressedPage.has_value())
+    {
+        throw BufferAllocationFailure("No unpooled TupleBuffer available!");
+    }
+    auto* compressed = compressedPage->getAvailableMemoryArea().data();
+    const PageHeader pageHeader{.bufferSize = lastPage.buffer.getBufferSize(), .numberOfColumns = columns.size()};
+    std::memcpy(compressed, &pageHeader, sizeof(PageHeader));
+    std::memcpy(compressed + sizeof(PageHeader), columnHeaders.data(), columnHeaders.size() * sizeof(ColumnHeader));
+    for (const auto& columnHeader : columnHeaders)
+    {
+        encodeColumn(page, compressed, columnHeader, numberOfEntries);
+    }
+    compressedPage->setNumberOfTuples(numberOfEntries);
+    moveChildBuffers(lastPage.buffer, compressedPage.value());
+
+    lastPage.buffer = std::move(compressedPage.value());
+    lastPage.compressed = true;
+    decompressionBufferProvider = bufferProvider;
+    numberOfCompressedPages.fetch_add(1, std::memory_order::release);
+}
+
+void PagedVector::decompressPage(const size_t index) const
+{
+    if (numberOfCompressedPages.load(std::memory_order::acquire) == 0)
+    {
+        return;
+    }
+
+    const std::scoped_lock lock(decompressionMutex);
+    auto& compressedPage = pages[index];
+    if (not compressedPage.compressed)
+    {
+        return;
+    }
+    INVARIANT(decompressionBufferProvider != nullptr, "A PagedVector with compressed pages requires a buffer provider");
+
+    const auto* compressed = compressedPage.buffer.getAvailableMemoryArea().data();
+    PageHeader pageHeader{};
+    std::memcpy(&pageHeader, compressed, sizeof(PageHeader));
+    auto page = decompressionBufferProvider->getUnpooledBuffer(pageHeader.bufferSize);
+    if (not page.has_value())
+    {
+        throw BufferAllocationFailure("No unpooled TupleBuffer available!");
+    }
+    const auto numberOfEntries = compressedPage.buffer.getNumberOfTuples();
+    for (uint64_t columnIndex = 0; columnIndex < pageHeader.numberOfColumns; ++columnIndex)
+    {
+        ColumnHeader columnHeader{};
+        std::memcpy(&columnHeader, compressed + sizeof(PageHeader) + (columnIndex * sizeof(ColumnHeader)), sizeof(ColumnHeader));
+        decodeColumn(compressed, page->getAvailableMemoryArea().data(), columnHeader, numberOfEntries);
+    }
+    page->setNumberOfTuples(numberOfEntries);
+    moveChildBuffers(compressedPage.buffer, page.value());
+
+    compressedPage.buffer = std::move(page.value());
+    compressedPage.compressed = false;
+    numberOfCompressedPages.fetch_sub(1, std::memory_order::release);
+}
+
 void PagedVector::PagesWrapper::updateCumulativeSumLastItem()
 {
     if (pages.empty())
@@ -61,10 +317,28 @@ void PagedVector::PagesWrapper::updateCumulativeSumLastItem()
 void PagedVector::PagesWrapper::updateCumulativeSumAllPages()
 {
     size_t curCumulativeSum = 0;
-    for (auto& page : pages)
+    for (size_t pageIndex = 0; pageIndex < pages.size(); ++pageIndex)
     {
+        auto& page = pages[pageIndex];
         page.cumulativeSum = page.buffer.getNumberOfTuples() + curCumulativeSum;
         curCumulativeSum = page.cumulativeSum;
+        if (pageIndex + 1 < pages.size())
+        {
+            updateEntriesPerPage(pageIndex);
+        }
+    }
+}
+
+void PagedVector::PagesWrapper::updateEntriesPerPage(const size_t pageIndex)
+{
+    const auto entriesOnPage = pages[pageIndex].cumulativeSum - ((pageIndex == 0) ? 0 : pages[pageIndex - 1].cumulativeSum);
+    if (pageIndex == 0)
+    {
+        entriesPerPage = entriesOnPage;
+    }
+    else if (entriesPerPage != entriesOnPage)
+    {
+        entriesPerPage = 0;
     }
 }
 
@@ -72,11 +346,21 @@ void PagedVector::moveAllPages(PagedVector& other)
 {
     copyFrom(other);
     other.pages.clearPages();
+    other.numberOfCompressedPages.store(0, std::memory_order::release);
 }
 
 void PagedVector::copyFrom(const PagedVector& other)
 {
+    const std::scoped_lock lock(other.decompressionMutex);
     pages.addPages(other.pages);
+    if (const auto otherCompressedPages = other.numberOfCompressedPages.load(std::memory_order::acquire); otherCompressedPages > 0)
+    {
+        INVARIANT(
+            decompressionBufferProvider == nullptr or decompressionBufferProvider == other.decompressionBufferProvider,
+            "Compressed pages of PagedVectors with different buffer providers can not be combined");
+        decompressionBufferProvider = other.decompressionBufferProvider;
+        numberOfCompressedPages.fetch_add(otherCompressedPages, std::memory_order::release);
+    }
 }
 
 const TupleBuffer* PagedVector::getTupleBufferForEntry(const uint64_t entryPos) const
@@ -86,6 +370,7 @@ const TupleBuffer* PagedVector::getTupleBufferForEntry(const uint64_t entryPos)
     if (const auto index = pages.findIdx(entryPos); index.has_value())
     {
         const auto indexVal = index.value();
+        decompressPage(indexVal);
         return std::addressof(pages[indexVal].buffer);
     }
     return nullptr;
@@ -103,6 +388,54 @@ std::optional<uint64_t> PagedVector::getBufferPosForEntry(const uint64_t entryPo
         });
 }
 
+const TupleBuffer* PagedVector::getPage(const uint64_t pageIndex) const
+{
+    if (pageIndex >= pages.getNumberOfPages())
+    {
+        return nullptr;
+    }
+    decompressPage(pageIndex);
+    return std::addressof(pages[pageIndex].buffer);
+}
+
+void PagedVector::copyColumn(const uint64_t beginEntry, const uint64_t numberOfEntries, const Column& column, int8_t* destination) const
+{
+    PRECONDITION(
+        beginEntry + numberOfEntries <= getTotalNumberOfEntries(),
+        "Can not copy the entries [{}, {}) of {} entries",
+        beginEntry,
+        beginEntry + numberOfEntries,
+        getTotalNumberOfEntries());
+    if (numberOfEntries == 0)
+    {
+        return;
+    }
+    /// We copy all entries of a page at once and only search for the first page, as the entries continue on the next page
+    auto pageIndex = pages.findIdx(beginEntry).value();
+    uint64_t posOnPage = getBufferPosForEntry(beginEntry).value();
+    uint64_t entryPos = beginEntry;
+    while (entryPos < beginEntry + numberOfEntries)
+    {
+        const auto* page = getPage(pageIndex++);
+        const auto numberOfEntriesOnPage = std::min(page->getNumberOfTuples() - posOnPage, beginEntry + numberOfEntries - entryPos);
+        const auto* values = page->getAvailableMemoryArea().data() + column.offset + (posOnPage * column.stride);
+        for (uint64_t i = 0; i < numberOfEntriesOnPage; ++i)
+        {
+            std::memcpy(destination, values + (i * column.stride), column.width);
+            destination += column.width;
+        }
+        entryPos += numberOfEntriesOnPage;
+        posOnPage = 0;
+    }
+}
+
+const TupleBuffer& PagedVector::getFirstPage() const
+{
+    PRECONDITION(pages.getNumberOfPages() > 0, "getFirstPage() should be called after a page has been inserted!");
+    decompressPage(0);
+    return pages.getFirstPage();
+}
+
 uint64_t PagedVector::PagesWrapper::getNumberOfTuplesLastPage() const
 {
     return getLastPage().getNumberOfTuples();
@@ -113,9 +446,18 @@ const PagedVector::TupleBufferWithCumulativeSum& PagedVector::PagesWrapper::oper
     return pages.at(index);
 }
 
+PagedVector::TupleBufferWithCumulativeSum& PagedVector::PagesWrapper::operator[](const size_t index)
+{
+    return pages.at(index);
+}
+
 void PagedVector::PagesWrapper::addPage(const TupleBuffer& newPage)
 {
     updateCumulativeSumLastItem();
+    if (not pages.empty())
+    {
+        updateEntriesPerPage(pages.size() - 1);
+    }
     pages.emplace_back(newPage);
 }
 
@@ -128,6 +470,7 @@ void PagedVector::PagesWrapper::addPages(const PagesWrapper& other)
 void PagedVector::PagesWrapper::clearPages()
 {
     pages.clear();
+    entriesPerPage = 0;
 }
 
 std::optional<size_t> PagedVector::PagesWrapper::findIdx(const uint64_t entryPos) const
@@ -138,6 +481,16 @@ std::optional<size_t> PagedVector::PagesWrapper::findIdx(const uint64_t entryPos
         return {};
     }
 
+    if (pages.size() == 1)
+    {
+        return 0;
+    }
+    if (entriesPerPage > 0)
+    {
+        /// As the entryPos is less than the number of entries, the last page stores all entries after the uniform pages
+        return std::min<size_t>(entryPos / entriesPerPage, pages.size() - 1);
+    }
+
     /// Use std::lower_bound to find the first cumulative sum greater than entryPos
     auto projection = [&](const TupleBufferWithCumulativeSum& bufferWithSum) -> size_t
     {
@@ -13,7 +13,9 @@
 */
 #include <Nautilus/Interface/PagedVector/PagedVectorRef.hpp>
 
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 #include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
@@ -23,6 +25,7 @@
 #include <Runtime/TupleBuffer.hpp>
 #include <nautilus/function.hpp>
 #include <nautilus/val.hpp>
+#include <ErrorHandling.hpp>
 #include <val_ptr.hpp>
 
 namespace NES
@@ -33,9 +36,37 @@ uint64_t getTotalNumberOfEntriesProxy(const PagedVector* pagedVector)
     return pagedVector->getTotalNumberOfEntries();
 }
 
-const static TupleBuffer*
-createNewEntryProxy(PagedVector* pagedVector, AbstractBufferProvider* bufferProvider, const uint64_t capacity, const uint64_t bufferSize)
+namespace
 {
+std::vector<PagedVector::Column> getColumns(const TupleBufferRef& bufferRef)
+{
+    std::vector<PagedVector::Column> columns;
+    for (const auto& fieldName : bufferRef.getAllFieldNames())
+    {
+        const auto location = bufferRef.getFieldLocation(fieldName);
+        if (not location.has_value())
+        {
+            return {};
+        }
+        columns.push_back({.offset = location->offset, .stride = location->stride, .width = location->type.getSizeInBytesWithNull()});
+    }
+    return columns;
+}
+}
+
+/// If the compressionBufferRef is set, we compress the last page before appending a new page
+const static TupleBuffer* createNewEntryProxy(
+    PagedVector* pagedVector,
+    AbstractBufferProvider* bufferProvider,
+    const uint64_t capacity,
+    const uint64_t bufferSize,
+    const TupleBufferRef* compressionBufferRef)
+{
+    if (compressionBufferRef != nullptr and pagedVector->isLastPageFull(capacity))
+    {
+        /// As this happens only once per page, collecting the columns is cheap compared to compressing the page
+        pagedVector->compressLastPage(bufferProvider, getColumns(*compressionBufferRef));
+    }
     pagedVector->appendPageIfFull(bufferProvider, capacity, bufferSize);
     return std::addressof(pagedVector->getLastPage());
 }
@@ -50,18 +81,41 @@ const TupleBuffer* getTupleBufferForEntryProxy(const PagedVector* pagedVector, c
     return pagedVector->getTupleBufferForEntry(entryPos);
 }
 
+const TupleBuffer* getPageProxy(const PagedVector* pagedVector, const uint64_t pageIndex)
+{
+    return pagedVector->getPage(pageIndex);
+}
+
+uint64_t getPageIndexForEntryProxy(const PagedVector* pagedVector, const uint64_t entryPos)
+{
+    return pagedVector->getPageIndexForEntry(entryPos).value_or(0);
+}
+
 uint64_t getBufferPosForEntryProxy(const PagedVector* pagedVector, const uint64_t entryPos)
 {
     return pagedVector->getBufferPosForEntry(entryPos).value_or(0);
 }
 
+void copyColumnProxy(
+    const PagedVector* pagedVector,
+    const uint64_t beginEntry,
+    const uint64_t numberOfEntries,
+    const uint64_t offset,
+    const uint64_t stride,
+    const uint64_t width,
+    int8_t* destination)
+{
+    pagedVector->copyColumn(beginEntry, numberOfEntries, {.offset = offset, .stride = stride, .width = width}, destination);
+}
+
 nautilus::val<uint64_t> PagedVectorRef::getNumberOfTuples() const
 {
     return nautilus::invoke(getTotalNumberOfEntriesProxy, pagedVectorRef);
 }
 
-PagedVectorRef::PagedVectorRef(const nautilus::val<PagedVector*>& pagedVectorRef, const std::shared_ptr<TupleBufferRef>& bufferRef)
-    : pagedVectorRef(pagedVectorRef), bufferRef(bufferRef)
+PagedVectorRef::PagedVectorRef(
+    const nautilus::val<PagedVector*>& pagedVectorRef, const std::shared_ptr<TupleBufferRef>& bufferRef, const bool compressFullPages)
+    : pagedVectorRef(pagedVectorRef), bufferRef(bufferRef), compressFullPages(compressFullPages)
 {
 }
 
@@ -72,7 +126,8 @@ void PagedVectorRef::writeRecord(const Record& record, const nautilus::val<Abstr
         pagedVectorRef,
         bufferProvider,
         nautilus::val<uint64_t>{bufferRef->getCapacity()},
-        nautilus::val<uint64_t>{bufferRef->getBufferSize()}));
+        nautilus::val<uint64_t>{bufferRef->getBufferSize()},
+        nautilus::val<const TupleBufferRef*>(compressFullPages ? bufferRef.get() : nullptr)));
     auto numTuplesOnPage = recordBuffer.getNumRecords();
     bufferRef->writeRecord(numTuplesOnPage, recordBuffer, record, bufferProvider);
     recordBuffer.setNumRecords(numTuplesOnPage + 1);
@@ -89,13 +144,39 @@ Record PagedVectorRef::readRecord(const nautilus::val<uint64_t>& pos, const std:
     return record;
 }
 
+void PagedVectorRef::copyColumn(
+    const nautilus::val<uint64_t>& begin,
+    const nautilus::val<uint64_t>& size,
+    const Record::RecordFieldIdentifier& fieldName,
+    const nautilus::val<int8_t*>& destination) const
+{
+    const auto location = bufferRef->getFieldLocation(fieldName);
+    INVARIANT(location.has_value(), "The field {} is not stored at fixed offsets", fieldName);
+    nautilus::invoke(
+        copyColumnProxy,
+        pagedVectorRef,
+        begin,
+        size,
+        nautilus::val<uint64_t>(location->offset),
+        nautilus::val<uint64_t>(location->stride),
+        nautilus::val<uint64_t>(location->type.getSizeInBytesWithNull()),
+        destination);
+}
+
 PagedVectorRefIter PagedVectorRef::begin(const std::vector<Record::RecordFieldIdentifier>& projections) const
 {
-    const nautilus::val<uint64_t> pos(0);
+    return at(nautilus::val<uint64_t>(0), projections);
+}
+
+PagedVectorRefIter
+PagedVectorRef::at(const nautilus::val<uint64_t>& pos, const std::vector<Record::RecordFieldIdentifier>& projections) const
+{
     const auto numberOfTuplesInPagedVector = invoke(getTotalNumberOfEntriesProxy, pagedVectorRef);
-    const auto curPage = nautilus::invoke(getTupleBufferForEntryProxy, pagedVectorRef, pos);
+    const auto pageIndex = nautilus::invoke(getPageIndexForEntryProxy, pagedVectorRef, pos);
+    const auto curPage = nautilus::invoke(getPageProxy, pagedVectorRef, pageIndex);
     const auto posOnPage = nautilus::invoke(getBufferPosForEntryProxy, pagedVectorRef, pos);
-    PagedVectorRefIter pagedVectorRefIter(*this, bufferRef, projections, curPage, posOnPage, pos, numberOfTuplesInPagedVector);
+    PagedVectorRefIter pagedVectorRefIter(
+        *this, bufferRef, projections, curPage, pageIndex, posOnPage, pos, numberOfTuplesInPagedVector);
     return pagedVectorRefIter;
 }
 
@@ -104,8 +185,9 @@ PagedVectorRefIter PagedVectorRef::end(const std::vector<Record::RecordFieldIden
     /// End does not point to any existing page. Therefore, we only set the pos
     const auto pos = invoke(getTotalNumberOfEntriesProxy, pagedVectorRef);
     const nautilus::val<TupleBuffer*> curPage(nullptr);
+    const nautilus::val<uint64_t> pageIndex(0);
     const nautilus::val<uint64_t> posOnPage(0);
-    PagedVectorRefIter pagedVectorRefIter(*this, bufferRef, projections, curPage, posOnPage, pos, pos);
+    PagedVectorRefIter pagedVectorRefIter(*this, bufferRef, projections, curPage, pageIndex, posOnPage, pos, pos);
     return pagedVectorRefIter;
 }
 
@@ -119,6 +201,7 @@ PagedVectorRefIter::PagedVectorRefIter(
     const std::shared_ptr<TupleBufferRef>& bufferRef,
     const std::vector<Record::RecordFieldIdentifier>& projections,
     const nautilus::val<TupleBuffer*>& curPage,
+    const nautilus::val<uint64_t>& pageIndex,
     const nautilus::val<uint64_t>& posOnPage,
     const nautilus::val<uint64_t>& pos,
     const nautilus::val<uint64_t>& numberOfTuplesInPagedVector)
@@ -128,8 +211,15 @@ PagedVectorRefIter::PagedVectorRefIter(
     , numberOfTuplesInPagedVector(numberOfTuplesInPagedVector)
     , posOnPage(posOnPage)
     , curPage(curPage)
+    , pageIndex(pageIndex)
+    , numberOfTuplesOnPage(0)
     , bufferRef(bufferRef)
 {
+    /// We read the number of tuples once per page and not for each record
+    if (pos < numberOfTuplesInPagedVector)
+    {
+        numberOfTuplesOnPage = RecordBuffer(curPage).getNumRecords();
+    }
 }
 
 Record PagedVectorRefIter::operator*() const
@@ -143,15 +233,15 @@ PagedVectorRefIter& PagedVectorRefIter::operator++()
 {
     pos = pos + 1;
     posOnPage = posOnPage + 1;
-    const auto tuplesOnPage = RecordBuffer(curPage).getNumRecords();
-    if (posOnPage >= tuplesOnPage)
+    if (posOnPage >= numberOfTuplesOnPage)
     {
-        /// Go to the next page
+        /// Go to the next page, which stores the next record, as the pages are filled one after the other
         posOnPage = 0;
         if (pos < numberOfTuplesInPagedVector)
         {
-            curPage = nautilus::invoke(getTupleBufferForEntryProxy, this->pagedVector.pagedVectorRef, this->pos);
-            posOnPage = nautilus::invoke(getBufferPosForEntryProxy, this->pagedVector.pagedVectorRef, this->pos);
+            pageIndex = pageIndex + 1;
+            curPage = nautilus::invoke(getPageProxy, this->pagedVector.pagedVectorRef, pageIndex);
+            numberOfTuplesOnPage = RecordBuffer(curPage).getNumRecords();
         }
     }
     return *this;
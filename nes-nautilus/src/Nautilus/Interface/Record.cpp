@@ -13,12 +13,20 @@
 */
 #include <Nautilus/Interface/Record.hpp>
 
+#include <algorithm>
 #include <cstdint>
-#include <numeric>
+#include <mutex>
+#include <optional>
 #include <ostream>
+#include <ranges>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 #include <Nautilus/DataTypes/VarVal.hpp>
+#include <fmt/format.h>
+#include <fmt/ranges.h>
 #include <std/ostream.h>
 #include <ErrorHandling.hpp>
 #include <static.hpp>
@@ -26,41 +34,157 @@
 
 namespace NES
 {
-Record::Record(std::unordered_map<RecordFieldIdentifier, VarVal>&& fields) : recordFields(fields)
+
+namespace
+{
+/// Assigns the slots of the records of all queries, which are compiled concurrently.
+/// It keeps one entry per distinct field name, which the fields of all queries over the same sources share.
+/// As a slot never changes once assigned, each thread caches the slots that it has seen and looks up names without locking.
+class FieldSlotRegistry
+{
+public:
+    std::optional<Record::FieldSlot> find(const Record::RecordFieldIdentifier& recordFieldIdentifier) const
+    {
+        if (const auto cachedSlot = cachedSlots.find(recordFieldIdentifier); cachedSlot != cachedSlots.end())
+        {
+            return cachedSlot->second;
+        }
+        const std::shared_lock lock(mutex);
+        if (const auto slot = slots.find(recordFieldIdentifier); slot != slots.end())
+        {
+            cachedSlots.emplace(recordFieldIdentifier, slot->second);
+            return slot->second;
+        }
+        return std::nullopt;
+    }
+
+    Record::FieldSlot resolve(const Record::RecordFieldIdentifier& recordFieldIdentifier)
+    {
+        if (const auto slot = find(recordFieldIdentifier))
+        {
+            return *slot;
+        }
+        const std::unique_lock lock(mutex);
+        const auto [slot, inserted] = slots.try_emplace(recordFieldIdentifier, static_cast<Record::FieldSlot>(names.size()));
+        if (inserted)
+        {
+            names.emplace_back(recordFieldIdentifier);
+        }
+        cachedSlots.emplace(recordFieldIdentifier, slot->second);
+        return slot->second;
+    }
+
+    Record::RecordFieldIdentifier getName(const Record::FieldSlot slot) const
+    {
+        const std::shared_lock lock(mutex);
+        return names.at(slot);
+    }
+
+private:
+    static thread_local std::unordered_map<Record::RecordFieldIdentifier, Record::FieldSlot> cachedSlots;
+    mutable std::shared_mutex mutex;
+    std::unordered_map<Record::RecordFieldIdentifier, Record::FieldSlot> slots;
+    std::vector<Record::RecordFieldIdentifier> names;
+};
+
+thread_local std::unordered_map<Record::RecordFieldIdentifier, Record::FieldSlot> FieldSlotRegistry::cachedSlots;
+
+FieldSlotRegistry& getFieldSlotRegistry()
+{
+    static FieldSlotRegistry registry;
+    return registry;
+}
+}
+
+Record::FieldSlot Record::resolveSlot(const RecordFieldIdentifier& recordFieldIdentifier)
+{
+    return getFieldSlotRegistry().resolve(recordFieldIdentifier);
+}
+
+Record::RecordFieldIdentifier Record::getFieldName(const FieldSlot slot)
+{
+    return getFieldSlotRegistry().getName(slot);
+}
+
+Record::Record(std::unordered_map<RecordFieldIdentifier, VarVal>&& fields)
+{
+    recordFields.reserve(fields.size());
+    for (const auto& [fieldIdentifier, value] : fields)
+    {
+        write(resolveSlot(fieldIdentifier), value);
+    }
+}
+
+std::vector<std::pair<Record::FieldSlot, VarVal>>::const_iterator Record::find(const FieldSlot slot) const
 {
+    const auto field = std::ranges::lower_bound(recordFields, slot, {}, &std::pair<FieldSlot, VarVal>::first);
+    return field != recordFields.end() and field->first == slot ? field : recordFields.end();
 }
 
 const VarVal& Record::read(const RecordFieldIdentifier& recordFieldIdentifier) const
 {
-    if (not recordFields.contains(recordFieldIdentifier))
+    if (const auto slot = getFieldSlotRegistry().find(recordFieldIdentifier))
     {
-        const std::string allFields = std::accumulate(
-            recordFields.begin(),
-            recordFields.end(),
-            std::string{},
-            [](const std::string& acc, const auto& pair) { return acc + pair.first + ", "; });
-        throw FieldNotFound("Field {} not found in record {}.", recordFieldIdentifier, allFields);
+        return read(*slot);
     }
-    return recordFields.at(recordFieldIdentifier);
+    throw FieldNotFound(
+        "Field {} not found in record {}.",
+        recordFieldIdentifier,
+        fmt::join(recordFields | std::views::transform([](const auto& field) { return getFieldName(field.first); }), ", "));
+}
+
+const VarVal& Record::read(const FieldSlot slot) const
+{
+    const auto field = find(slot);
+    if (field == recordFields.end())
+    {
+        throw FieldNotFound(
+            "Field {} not found in record {}.",
+            getFieldName(slot),
+            fmt::join(recordFields | std::views::transform([](const auto& recordField) { return getFieldName(recordField.first); }), ", "));
+    }
+    return field->second;
 }
 
 void Record::write(const RecordFieldIdentifier& recordFieldIdentifier, const VarVal& varVal)
 {
-    /// We can not use the insert_or_assign method, as we otherwise run into a tracing exception, as this might result in incorrect code.
-    if (const auto [hashMapIterator, inserted] = recordFields.insert({recordFieldIdentifier, varVal}); not inserted)
+    write(resolveSlot(recordFieldIdentifier), varVal);
+}
+
+void Record::write(const FieldSlot slot, const VarVal& varVal)
+{
+    /// Scans write the fields of a schema in the order of their slots, thus most writes append
+    if (recordFields.empty() or recordFields.back().first < slot)
     {
-        /// We need to first erase the old value, as we are overwriting an existing field with a potential new data type
-        /// This inefficiency is fine, as this code solely gets executed during tracing.
-        recordFields.erase(recordFieldIdentifier);
-        recordFields.insert_or_assign(recordFieldIdentifier, varVal);
+        recordFields.emplace_back(slot, varVal);
+        return;
     }
+    /// We can not assign values, as we otherwise run into a tracing exception, as this might result in incorrect code.
+    /// Inserting into or erasing from the middle of the vector would move-assign the following values, thus we copy-construct all fields
+    /// into a new vector. This inefficiency is fine, as overwriting a field or writing a field with a lower slot than the others is rare.
+    std::vector<std::pair<FieldSlot, VarVal>> fields;
+    fields.reserve(recordFields.size() + 1);
+    bool written = false;
+    for (const auto& field : recordFields)
+    {
+        if (not written and field.first >= slot)
+        {
+            fields.emplace_back(slot, varVal);
+            written = true;
+        }
+        if (field.first != slot)
+        {
+            fields.emplace_back(field);
+        }
+    }
+    recordFields = std::move(fields);
 }
 
 void Record::reassignFields(const Record& other)
 {
-    for (const auto& [fieldIdentifier, value] : nautilus::static_iterable(other.recordFields))
+    for (const auto& [slot, value] : nautilus::static_iterable(other.recordFields))
     {
-        write(fieldIdentifier, value);
+        write(slot, value);
     }
 }
 
@@ -80,7 +204,13 @@ nautilus::val<uint64_t> Record::getNumberOfFields() const
 
 bool Record::hasField(const RecordFieldIdentifier& fieldName) const
 {
-    return recordFields.contains(fieldName);
+    const auto slot = getFieldSlotRegistry().find(fieldName);
+    return slot.has_value() and hasField(*slot);
+}
+
+bool Record::hasField(const FieldSlot slot) const
+{
+    return find(slot) != recordFields.end();
 }
 
 nautilus::val<bool> operator==(const Record& lhs, const Record& rhs)
@@ -90,9 +220,9 @@ nautilus::val<bool> operator==(const Record& lhs, const Record& rhs)
         return false;
     }
 
-    for (const auto& [fieldName, value] : nautilus::static_iterable(lhs.recordFields))
+    for (const auto& [slot, value] : nautilus::static_iterable(lhs.recordFields))
     {
-        if (not rhs.hasField(fieldName) or value != rhs.read(fieldName))
+        if (not rhs.hasField(slot) or value != rhs.read(slot))
         {
             return false;
         }
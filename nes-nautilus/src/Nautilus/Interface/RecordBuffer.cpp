@@ -111,4 +111,19 @@ void RecordBuffer::setCreationTs(const nautilus::val<Timestamp>& creationTs)
     invoke(ProxyFunctions::NES_Memory_TupleBuffer_setCreationTimestampInMS, tupleBufferRef, creationTs);
 }
 
+nautilus::val<Timestamp> RecordBuffer::getMinIngestionTs()
+{
+    return {invoke(ProxyFunctions::NES_Memory_TupleBuffer_getMinIngestionTimestampInNS, tupleBufferRef)};
+}
+
+nautilus::val<Timestamp> RecordBuffer::getMaxIngestionTs()
+{
+    return {invoke(ProxyFunctions::NES_Memory_TupleBuffer_getMaxIngestionTimestampInNS, tupleBufferRef)};
+}
+
+void RecordBuffer::setIngestionTs(const nautilus::val<Timestamp>& minIngestionTs, const nautilus::val<Timestamp>& maxIngestionTs)
+{
+    invoke(ProxyFunctions::NES_Memory_TupleBuffer_setIngestionTimestampsInNS, tupleBufferRef, minIngestionTs, maxIngestionTs);
+}
+
 }
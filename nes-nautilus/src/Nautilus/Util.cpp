@@ -61,6 +61,8 @@ VarVal createNautilusMinValue(const DataType::Type physicalType)
         case DataType::Type::INT32:
             return createNautilusConstValue(std::numeric_limits<int32_t>::min(), physicalType);
         case DataType::Type::INT64:
+        case DataType::Type::INTERVAL:
+        case DataType::Type::DECIMAL:
             return createNautilusConstValue(std::numeric_limits<int64_t>::min(), physicalType);
         case DataType::Type::UINT8:
             return createNautilusConstValue(std::numeric_limits<uint8_t>::min(), physicalType);
@@ -69,6 +71,7 @@ VarVal createNautilusMinValue(const DataType::Type physicalType)
         case DataType::Type::UINT32:
             return createNautilusConstValue(std::numeric_limits<uint32_t>::min(), physicalType);
         case DataType::Type::UINT64:
+        case DataType::Type::TIMESTAMP:
             return createNautilusConstValue(std::numeric_limits<uint64_t>::min(), physicalType);
         case DataType::Type::FLOAT32:
             return createNautilusConstValue(std::numeric_limits<float>::min(), physicalType);
@@ -92,6 +95,8 @@ VarVal createNautilusMaxValue(const DataType::Type physicalType)
         case DataType::Type::INT32:
             return createNautilusConstValue(std::numeric_limits<int32_t>::max(), physicalType);
         case DataType::Type::INT64:
+        case DataType::Type::INTERVAL:
+        case DataType::Type::DECIMAL:
             return createNautilusConstValue(std::numeric_limits<int64_t>::max(), physicalType);
         case DataType::Type::UINT8:
             return createNautilusConstValue(std::numeric_limits<uint8_t>::max(), physicalType);
@@ -100,6 +105,7 @@ VarVal createNautilusMaxValue(const DataType::Type physicalType)
         case DataType::Type::UINT32:
             return createNautilusConstValue(std::numeric_limits<uint32_t>::max(), physicalType);
         case DataType::Type::UINT64:
+        case DataType::Type::TIMESTAMP:
             return createNautilusConstValue(std::numeric_limits<uint64_t>::max(), physicalType);
         case DataType::Type::FLOAT32:
             return createNautilusConstValue(std::numeric_limits<float>::max(), physicalType);
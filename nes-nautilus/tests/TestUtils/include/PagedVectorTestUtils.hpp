@@ -36,7 +36,8 @@ void runStoreTest(
     const std::vector<Record::RecordFieldIdentifier>& projections,
     const std::vector<TupleBuffer>& allRecords,
     const nautilus::engine::NautilusEngine& nautilusEngine,
-    AbstractBufferProvider& bufferManager);
+    AbstractBufferProvider& bufferManager,
+    bool compressFullPages = false);
 
 void runRetrieveTest(
     PagedVector& pagedVector,
@@ -24,6 +24,7 @@
 #include <numeric>
 #include <random>
 #include <sstream>
+#include <string>
 #include <tuple>
 #include <unordered_map>
 #include <vector>
@@ -75,9 +76,13 @@ void ChainedHashMapTestUtils::setUpChainedHashMapTest(
 {
     /// Setting the correct options for the engine, depending on the enum value from the backend
     nautilus::engine::Options options;
-    const bool compilation = (backend == ExecutionMode::COMPILER);
+    const bool compilation = (backend != ExecutionMode::INTERPRETER);
     NES_INFO("Backend: {} and compilation: {}", magic_enum::enum_name(backend), compilation);
     options.setOption("engine.Compilation", compilation);
+    if (backend == ExecutionMode::BYTECODE)
+    {
+        options.setOption("engine.backend", std::string("bc"));
+    }
     options.setOption("mlir.enableMultithreading", mlirEnableMultithreading);
     nautilusEngine = std::make_unique<nautilus::engine::NautilusEngine>(options);
 
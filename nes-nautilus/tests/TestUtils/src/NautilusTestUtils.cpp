@@ -215,10 +215,13 @@ void NautilusTestUtils::compileFillBufferFunction(
                             std::string randomString(size, 0);
                             std::generate_n(randomString.begin(), size, randchar);
 
-                            /// Adding the random string to the buffer and returning the pointer to the data
-                            const auto varSizedAccess
-                                = TupleBufferRef::writeVarSized(*inputBuffer, *bufferProviderVal, std::as_bytes(std::span{randomString}));
-                            return TupleBufferRef::loadAssociatedVarSizedValue(*inputBuffer, varSizedAccess).data();
+                            /// Adding the random string as a child buffer of the buffer and returning the pointer to the data.
+                            /// Writing it via writeVarSized could inline it in the returned access, which does not outlive this call.
+                            auto childBuffer = bufferProviderVal->getUnpooledBuffer(std::max<uint64_t>(size, 1));
+                            INVARIANT(childBuffer.has_value(), "Cannot allocate a child buffer of size {}", size);
+                            std::ranges::copy(std::as_bytes(std::span{randomString}), childBuffer->getAvailableMemoryArea().begin());
+                            inputBuffer->storeChildBuffer(*childBuffer);
+                            return childBuffer->getAvailableMemoryArea().data();
                         },
                         recordBuffer.getReference(),
                         bufferProvider,
@@ -47,7 +47,8 @@ void runStoreTest(
     const std::vector<Record::RecordFieldIdentifier>& projections,
     const std::vector<TupleBuffer>& allRecords,
     const nautilus::engine::NautilusEngine& nautilusEngine,
-    AbstractBufferProvider& bufferManager)
+    AbstractBufferProvider& bufferManager,
+    const bool compressFullPages)
 {
     /// Creating the memory provider for the paged vector
     const auto bufferRef = LowerSchemaProvider::lowerSchema(pageSize, testSchema, memoryLayout);
@@ -63,7 +64,7 @@ void runStoreTest(
             nautilus::val<PagedVector*> pagedVectorVal)
         {
             const RecordBuffer recordBuffer(inputBufferPtr);
-            const PagedVectorRef pagedVectorRef(pagedVectorVal, bufferRef);
+            const PagedVectorRef pagedVectorRef(pagedVectorVal, bufferRef, compressFullPages);
 
             for (nautilus::val<uint64_t> i = 0; i < recordBuffer.getNumRecords(); i = i + 1)
             {
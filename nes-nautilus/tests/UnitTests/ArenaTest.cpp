@@ -0,0 +1,108 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstddef>
+#include <memory>
+#include <Runtime/BufferManager.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <Arena.hpp>
+#include <BaseUnitTest.hpp>
+
+namespace NES
+{
+class ArenaTest : public Testing::BaseUnitTest
+{
+public:
+    static constexpr size_t BUFFER_SIZE = 4096;
+    static constexpr size_t NUMBER_OF_BUFFERS = 8;
+
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("ArenaTest.log", LogLevel::LOG_DEBUG);
+        NES_INFO("Setup ArenaTest class.");
+    }
+
+    void SetUp() override
+    {
+        BaseUnitTest::SetUp();
+        bufferManager = BufferManager::create(BUFFER_SIZE, NUMBER_OF_BUFFERS);
+    }
+
+    std::shared_ptr<BufferManager> bufferManager;
+};
+
+/// A reset keeps the retained buffers, which the next allocations reuse in the same order without requesting new buffers
+TEST_F(ArenaTest, ResetRetainsBuffersForReuse)
+{
+    Arena arena(bufferManager);
+    const auto* const firstMemory = arena.allocateMemory(BUFFER_SIZE).data();
+    const auto* const secondMemory = arena.allocateMemory(BUFFER_SIZE).data();
+    arena.allocateMemory(BUFFER_SIZE);
+    EXPECT_EQ(arena.numberOfUsedBuffers, 3);
+    EXPECT_EQ(bufferManager->getNumberOfAvailableBuffers(), NUMBER_OF_BUFFERS - 3);
+
+    arena.reset();
+    EXPECT_EQ(arena.numberOfUsedBuffers, 0);
+    EXPECT_EQ(arena.fixedSizeBuffers.size(), Arena::NUMBER_OF_RETAINED_BUFFERS);
+    EXPECT_EQ(bufferManager->getNumberOfAvailableBuffers(), NUMBER_OF_BUFFERS - Arena::NUMBER_OF_RETAINED_BUFFERS);
+
+    EXPECT_EQ(arena.allocateMemory(BUFFER_SIZE / 2).data(), firstMemory);
+    EXPECT_EQ(arena.allocateMemory(BUFFER_SIZE / 2).data(), firstMemory + (BUFFER_SIZE / 2));
+    EXPECT_EQ(arena.allocateMemory(BUFFER_SIZE).data(), secondMemory);
+    EXPECT_EQ(arena.numberOfUsedBuffers, 2);
+    EXPECT_EQ(bufferManager->getNumberOfAvailableBuffers(), NUMBER_OF_BUFFERS - Arena::NUMBER_OF_RETAINED_BUFFERS);
+
+    /// Only allocations beyond the retained buffers request new buffers
+    arena.allocateMemory(1);
+    EXPECT_EQ(arena.numberOfUsedBuffers, 3);
+    EXPECT_EQ(bufferManager->getNumberOfAvailableBuffers(), NUMBER_OF_BUFFERS - 3);
+}
+
+/// A reset releases all unpooled buffers and the fixed size buffers beyond the requested number of retained buffers
+TEST_F(ArenaTest, ResetReleasesUnpooledAndSurplusBuffers)
+{
+    Arena arena(bufferManager);
+    arena.allocateMemory(2 * BUFFER_SIZE);
+    arena.allocateMemory(BUFFER_SIZE);
+    EXPECT_EQ(arena.unpooledBuffers.size(), 1);
+    EXPECT_EQ(arena.numberOfUsedBuffers, 1);
+
+    arena.reset(0);
+    EXPECT_TRUE(arena.unpooledBuffers.empty());
+    EXPECT_TRUE(arena.fixedSizeBuffers.empty());
+    EXPECT_EQ(bufferManager->getNumberOfAvailableBuffers(), NUMBER_OF_BUFFERS);
+}
+
+/// An unpooled allocation must not change the remaining space of the current fixed size buffer
+TEST_F(ArenaTest, UnpooledAllocationKeepsTheCurrentBuffer)
+{
+    Arena arena(bufferManager);
+    const auto* const firstMemory = arena.allocateMemory(16).data();
+    const auto unpooledMemory = arena.allocateMemory(3 * BUFFER_SIZE);
+    EXPECT_EQ(unpooledMemory.size(), 3 * BUFFER_SIZE);
+
+    /// The rest of the first buffer still fits the allocation
+    EXPECT_EQ(arena.allocateMemory(BUFFER_SIZE - 16).data(), firstMemory + 16);
+    EXPECT_EQ(arena.numberOfUsedBuffers, 1);
+    EXPECT_EQ(arena.fixedSizeBuffers.size(), 1);
+
+    /// The first buffer is full, thus the next allocation moves on to a new buffer
+    arena.allocateMemory(1);
+    EXPECT_EQ(arena.numberOfUsedBuffers, 2);
+    EXPECT_EQ(arena.currentOffset, 1);
+}
+}
@@ -0,0 +1,121 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstdint>
+#include <random>
+#include <unordered_set>
+#include <vector>
+#include <Nautilus/Interface/BloomFilter/BlockedBloomFilter.hpp>
+#include <Nautilus/Interface/BloomFilter/BlockedBloomFilterRef.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+#include <val.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+class BlockedBloomFilterTest : public Testing::BaseUnitTest
+{
+public:
+    static constexpr uint64_t NUMBER_OF_KEYS = 10'000;
+    static constexpr uint64_t BITS_PER_KEY = 16;
+
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("BlockedBloomFilterTest.log", LogLevel::LOG_DEBUG);
+        NES_INFO("Setup BlockedBloomFilterTest class.");
+    }
+
+    /// Returns distinct random hashes
+    static std::vector<uint64_t> createHashes(const uint64_t numberOfHashes, const uint64_t seed)
+    {
+        std::mt19937_64 generator{seed};
+        std::unordered_set<uint64_t> hashes;
+        while (hashes.size() < numberOfHashes)
+        {
+            hashes.emplace(generator());
+        }
+        return {hashes.begin(), hashes.end()};
+    }
+};
+
+TEST_F(BlockedBloomFilterTest, NumberOfWordsIsPowerOfTwo)
+{
+    EXPECT_EQ(BlockedBloomFilter(0, BITS_PER_KEY).getNumberOfWords(), 1);
+    EXPECT_EQ(BlockedBloomFilter(4, BITS_PER_KEY).getNumberOfWords(), 1);
+    EXPECT_EQ(BlockedBloomFilter(5, BITS_PER_KEY).getNumberOfWords(), 2);
+    EXPECT_EQ(BlockedBloomFilter(NUMBER_OF_KEYS, BITS_PER_KEY).getNumberOfWords(), 4096);
+}
+
+TEST_F(BlockedBloomFilterTest, NoFalseNegatives)
+{
+    BlockedBloomFilter bloomFilter{NUMBER_OF_KEYS, BITS_PER_KEY};
+    const auto hashes = createHashes(NUMBER_OF_KEYS, 42);
+    for (const auto hash : hashes)
+    {
+        bloomFilter.insert(hash);
+    }
+    for (const auto hash : hashes)
+    {
+        EXPECT_TRUE(bloomFilter.mayContain(hash));
+    }
+}
+
+TEST_F(BlockedBloomFilterTest, FalsePositiveRate)
+{
+    BlockedBloomFilter bloomFilter{NUMBER_OF_KEYS, BITS_PER_KEY};
+    for (const auto hash : createHashes(NUMBER_OF_KEYS, 42))
+    {
+        bloomFilter.insert(hash);
+    }
+
+    /// The probability that two random hashes are equal is negligible. Thus, we can treat all other hashes as absent.
+    BloomFilterStatistics statistics;
+    for (const auto hash : createHashes(NUMBER_OF_KEYS, 7))
+    {
+        if (bloomFilter.mayContain(hash))
+        {
+            ++statistics.numberOfFalsePositives;
+        }
+        else
+        {
+            ++statistics.numberOfRejectedKeys;
+        }
+    }
+    NES_INFO("False positive rate of {} bits per key is {}", BITS_PER_KEY, statistics.getFalsePositiveRate());
+    EXPECT_LT(statistics.getFalsePositiveRate(), 0.05);
+    EXPECT_EQ(BloomFilterStatistics{}.getFalsePositiveRate(), 0);
+}
+
+TEST_F(BlockedBloomFilterTest, RefMatchesBloomFilter)
+{
+    BlockedBloomFilter bloomFilter{NUMBER_OF_KEYS, BITS_PER_KEY};
+    const auto hashes = createHashes(2 * NUMBER_OF_KEYS, 42);
+    for (uint64_t i = 0; i < NUMBER_OF_KEYS; ++i)
+    {
+        bloomFilter.insert(hashes[i]);
+    }
+
+    const BlockedBloomFilterRef bloomFilterRef{nautilus::val<BlockedBloomFilter*>(&bloomFilter)};
+    for (const auto hash : hashes)
+    {
+        const auto mayContain = nautilus::details::RawValueResolver<bool>::getRawValue(bloomFilterRef.mayContain(hash));
+        EXPECT_EQ(mayContain, bloomFilter.mayContain(hash));
+    }
+}
+
+}
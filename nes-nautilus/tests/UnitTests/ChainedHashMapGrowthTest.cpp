@@ -0,0 +1,215 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <unordered_set>
+#include <vector>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMap.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Runtime/BufferManager.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+namespace NES
+{
+class ChainedHashMapGrowthTest : public Testing::BaseUnitTest
+{
+public:
+    static constexpr uint64_t KEY_SIZE = 8;
+    static constexpr uint64_t VALUE_SIZE = 8;
+    static constexpr uint64_t PAGE_SIZE = 1024;
+
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("ChainedHashMapGrowthTest.log", LogLevel::LOG_DEBUG);
+        NES_INFO("Setup ChainedHashMapGrowthTest class.");
+    }
+
+    void SetUp() override
+    {
+        BaseUnitTest::SetUp();
+        bufferManager = BufferManager::create();
+    }
+
+    /// Returns true, if the chain of the hash contains the entry
+    static bool containsEntry(const ChainedHashMap& hashMap, const uint64_t hash, const ChainedHashMapEntry* entry)
+    {
+        for (const auto* chainEntry = hashMap.findChain(hash); chainEntry != nullptr; chainEntry = chainEntry->next)
+        {
+            if (chainEntry == entry)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::shared_ptr<BufferManager> bufferManager;
+};
+
+/// Inserts far more entries than expected, so that the hash map has to grow multiple times.
+/// After every insert, all entries have to be found, regardless if their chain has already been moved to the grown entry space.
+TEST_F(ChainedHashMapGrowthTest, findAllEntriesWhileGrowing)
+{
+    constexpr uint64_t numberOfEntries = 2000;
+    ChainedHashMap hashMap{KEY_SIZE, VALUE_SIZE, 1, PAGE_SIZE};
+    const auto initialNumberOfChains = hashMap.getNumberOfChains();
+    std::mt19937_64 generator{42}; /// NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::vector<uint64_t> hashes;
+    std::vector<ChainedHashMapEntry*> entries;
+    bool wasMigrating = false;
+    for (uint64_t i = 0; i < numberOfEntries; ++i)
+    {
+        hashes.emplace_back(generator());
+        entries.emplace_back(dynamic_cast<ChainedHashMapEntry*>(hashMap.insertEntry(hashes.back(), bufferManager.get())));
+        wasMigrating |= hashMap.isMigrating();
+        for (uint64_t j = 0; j <= i; j += 7)
+        {
+            ASSERT_TRUE(containsEntry(hashMap, hashes[j], entries[j])) << "Entry " << j << " is missing after inserting entry " << i;
+        }
+    }
+
+    EXPECT_TRUE(wasMigrating);
+    EXPECT_EQ(hashMap.getNumberOfTuples(), numberOfEntries);
+    EXPECT_GE(hashMap.getNumberOfChains(), numberOfEntries / 2);
+    for (uint64_t i = 0; i < numberOfEntries; ++i)
+    {
+        /// Growing must not move the entries, as the operators keep pointers to the entries
+        EXPECT_EQ(entries[i]->hash, hashes[i]);
+        EXPECT_TRUE(containsEntry(hashMap, hashes[i], entries[i])) << "Entry " << i << " is not part of its chain";
+    }
+
+    const auto growthStatistics = hashMap.getGrowthStatistics();
+    EXPECT_EQ(initialNumberOfChains << growthStatistics.numberOfResizes, hashMap.getNumberOfChains());
+    EXPECT_GT(growthStatistics.numberOfRehashedEntries, 0);
+    EXPECT_LT(growthStatistics.numberOfRehashedEntries, 2 * numberOfEntries);
+}
+
+/// Each insert only moves a few chains. Thus, the hash map is still migrating directly after it has grown.
+TEST_F(ChainedHashMapGrowthTest, growthIsIncremental)
+{
+    ChainedHashMap hashMap{KEY_SIZE, VALUE_SIZE, 1, PAGE_SIZE};
+    const auto initialNumberOfChains = hashMap.getNumberOfChains();
+    uint64_t hash = 0;
+    while (hashMap.getNumberOfChains() < 64 * initialNumberOfChains)
+    {
+        static_cast<void>(hashMap.insertEntry(++hash, bufferManager.get()));
+    }
+    EXPECT_TRUE(hashMap.isMigrating());
+    EXPECT_LT(hashMap.getGrowthStatistics().numberOfRehashedEntries, hashMap.getNumberOfTuples());
+}
+
+/// Clearing the hash map while it is migrating must call the destructor callback for all entries exactly once
+TEST_F(ChainedHashMapGrowthTest, clearWhileMigrating)
+{
+    /// Declared before the hash map, as the destructor of the hash map calls the destructor callback as well
+    std::unordered_set<const ChainedHashMapEntry*> destroyedEntries;
+    uint64_t numberOfCallbacks = 0;
+    ChainedHashMap hashMap{KEY_SIZE, VALUE_SIZE, 1, PAGE_SIZE};
+    hashMap.setDestructorCallback(
+        [&](const ChainedHashMapEntry* entry)
+        {
+            destroyedEntries.emplace(entry);
+            ++numberOfCallbacks;
+        });
+
+    uint64_t hash = 0;
+    while (hashMap.getGrowthStatistics().numberOfResizes < 3 or not hashMap.isMigrating())
+    {
+        static_cast<void>(hashMap.insertEntry(++hash, bufferManager.get()));
+    }
+    const auto numberOfEntries = hashMap.getNumberOfTuples();
+    hashMap.clear();
+    EXPECT_EQ(numberOfCallbacks, numberOfEntries);
+    EXPECT_EQ(destroyedEntries.size(), numberOfEntries);
+    EXPECT_EQ(hashMap.getNumberOfTuples(), 0);
+    EXPECT_FALSE(hashMap.isMigrating());
+
+    /// The cleared hash map can be reused
+    const auto* const entry = dynamic_cast<ChainedHashMapEntry*>(hashMap.insertEntry(42, bufferManager.get()));
+    EXPECT_TRUE(containsEntry(hashMap, 42, entry));
+}
+
+/// Resetting the hash map keeps its grown chains, but removes all entries
+TEST_F(ChainedHashMapGrowthTest, resetKeepsChains)
+{
+    ChainedHashMap hashMap{KEY_SIZE, VALUE_SIZE, 1, PAGE_SIZE};
+    uint64_t hash = 0;
+    while (hashMap.getGrowthStatistics().numberOfResizes < 3 or not hashMap.isMigrating())
+    {
+        static_cast<void>(hashMap.insertEntry(++hash, bufferManager.get()));
+    }
+    const auto numberOfChains = hashMap.getNumberOfChains();
+    hashMap.reset();
+    EXPECT_EQ(hashMap.getNumberOfTuples(), 0);
+    EXPECT_EQ(hashMap.getNumberOfChains(), numberOfChains);
+    EXPECT_EQ(hashMap.getNumberOfPages(), 0);
+    EXPECT_FALSE(hashMap.isMigrating());
+    EXPECT_EQ(hashMap.getGrowthStatistics().numberOfResizes, 0);
+    for (uint64_t chain = 0; chain < numberOfChains; ++chain)
+    {
+        EXPECT_EQ(hashMap.getStartOfChain(chain), nullptr);
+    }
+
+    const auto* const entry = dynamic_cast<ChainedHashMapEntry*>(hashMap.insertEntry(42, bufferManager.get()));
+    EXPECT_TRUE(containsEntry(hashMap, 42, entry));
+    EXPECT_EQ(hashMap.getNumberOfChains(), numberOfChains);
+}
+
+TEST_F(ChainedHashMapGrowthTest, tagOfChainSkipsChainsWithoutHash)
+{
+    ChainedHashMap hashMap{KEY_SIZE, VALUE_SIZE, 1, PAGE_SIZE};
+    constexpr uint64_t hash = 42;
+    constexpr uint64_t hashWithOtherTag = hash | (uint64_t{1} << 63);
+    const auto* const entry = dynamic_cast<ChainedHashMapEntry*>(hashMap.insertEntry(hash, bufferManager.get()));
+    EXPECT_EQ(hashMap.findChain(hash), entry);
+    EXPECT_EQ(hashMap.getStartOfChain(hash & (hashMap.getNumberOfChains() - 1)), entry);
+
+    /// Both hashes belong to the same chain, but the tag of the chain rules out the second hash until we insert it
+    EXPECT_EQ(hashMap.findChain(hashWithOtherTag), nullptr);
+    const auto* const otherEntry = dynamic_cast<ChainedHashMapEntry*>(hashMap.insertEntry(hashWithOtherTag, bufferManager.get()));
+    EXPECT_EQ(hashMap.findChain(hashWithOtherTag), otherEntry);
+    EXPECT_TRUE(containsEntry(hashMap, hash, entry));
+}
+
+TEST_F(ChainedHashMapGrowthTest, prefetchChainsOfOtherEntries)
+{
+    ChainedHashMap otherHashMap{KEY_SIZE, VALUE_SIZE, 1, PAGE_SIZE};
+    for (uint64_t hash = 1; hash <= HashMap::PREFETCH_GROUP_SIZE; ++hash)
+    {
+        static_cast<void>(otherHashMap.insertEntry(hash, bufferManager.get()));
+    }
+    const auto& page = otherHashMap.getPage(0);
+    const auto otherEntries = page.getAvailableMemoryArea().subspan(0, page.getNumberOfTuples() * otherHashMap.getEntrySize());
+
+    /// Prefetching must neither fail for a hash map without chains nor for one that is migrating its chains, nor change any entries
+    ChainedHashMap hashMap{KEY_SIZE, VALUE_SIZE, 1, PAGE_SIZE};
+    hashMap.prefetchChains(otherEntries, otherHashMap.getEntrySize());
+    uint64_t hash = 0;
+    while (not hashMap.isMigrating())
+    {
+        static_cast<void>(hashMap.insertEntry(++hash, bufferManager.get()));
+    }
+    const auto numberOfTuples = hashMap.getNumberOfTuples();
+    hashMap.prefetchChains(otherEntries, otherHashMap.getEntrySize());
+    EXPECT_EQ(hashMap.getNumberOfTuples(), numberOfTuples);
+    EXPECT_TRUE(hashMap.isMigrating());
+}
+
+}
@@ -12,12 +12,15 @@
     limitations under the License.
 */
 
+#include <algorithm>
 #include <cstring>
 #include <memory>
 #include <sstream>
 #include <tuple>
 #include <vector>
 #include <DataTypes/DataType.hpp>
+#include <Nautilus/DataTypes/VarSizedDictionary.hpp>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedEntryMemoryProvider.hpp>
 #include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMap.hpp>
 
 #include <Nautilus/Interface/BufferRef/LowerSchemaProvider.hpp>
@@ -120,6 +123,38 @@ TEST_P(ChainedHashMapTest, update)
     /// Check if our entry iterator reads all the entries
     checkEntryIterator(hashMap, exactMap);
 }
+
+TEST_P(ChainedHashMapTest, internedVarSizedKeys)
+{
+    /// Interning the VARSIZED keys in a dictionary that both hash maps share
+    const auto dictionary = std::make_shared<VarSizedDictionary>(VarSizedDictionary::UNBOUNDED_NUMBER_OF_ENTRIES);
+    std::tie(fieldKeys, fieldValues)
+        = ChainedEntryMemoryProvider::createFieldOffsets(inputSchema, projectionKeys, projectionValues, dictionary);
+    const auto hasVarSizedKeys
+        = std::ranges::any_of(fieldKeys, [](const FieldOffsets& field) { return field.type.isType(DataType::Type::VARSIZED); });
+
+    ChainedHashMap hashMap{keySize, valueSize, params.numberOfBuckets, params.pageSize};
+    ChainedHashMap otherHashMap{keySize, valueSize, params.numberOfBuckets, params.pageSize};
+    const auto exactMap = createExactMap(ExactMapInsert::INSERT);
+    auto findAndInsert = compileFindAndInsert();
+    for (auto& buffer : inputBuffers)
+    {
+        findAndInsert(std::addressof(buffer), bufferManager.get(), std::addressof(hashMap));
+    }
+    const auto numberOfInternedKeys = dictionary->getNumberOfEntries();
+    EXPECT_EQ(numberOfInternedKeys > 0, hasVarSizedKeys);
+    EXPECT_LE(numberOfInternedKeys, hashMap.getNumberOfTuples());
+
+    /// The entries of the other hash map point to the keys that the first hash map has interned
+    for (auto& buffer : inputBuffers)
+    {
+        findAndInsert(std::addressof(buffer), bufferManager.get(), std::addressof(otherHashMap));
+    }
+    EXPECT_EQ(dictionary->getNumberOfEntries(), numberOfInternedKeys);
+
+    checkIfValuesAreCorrectViaFindEntry(hashMap, exactMap);
+    checkEntryIterator(otherHashMap, exactMap);
+}
 #ifdef ALL_HASHMAP_TESTS
 /// Running the test for 3 times for each key, value schema and backend.
 /// This entails three different random number of items, number of buckets and page size.
@@ -165,7 +200,10 @@ INSTANTIATE_TEST_CASE_P(
     ChainedHashMapTest,
     ChainedHashMapTest,
     ::testing::Combine(
-        ::testing::Range(0, noIterations), keyTypes, valTypes, ::testing::Values(ExecutionMode::COMPILER, ExecutionMode::INTERPRETER)),
+        ::testing::Range(0, noIterations),
+        keyTypes,
+        valTypes,
+        ::testing::Values(ExecutionMode::COMPILER, ExecutionMode::INTERPRETER, ExecutionMode::BYTECODE)),
     [](const testing::TestParamInfo<ChainedHashMapTest::ParamType>& info)
     {
         const auto iteration = std::get<0>(info.param);
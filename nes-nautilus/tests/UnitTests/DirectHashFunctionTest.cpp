@@ -0,0 +1,113 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstdint>
+#include <limits>
+#include <unordered_set>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/Hash/DirectHashFunction.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+#include <val.hpp>
+
+namespace NES
+{
+class DirectHashFunctionTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("DirectHashFunctionTest.log", LogLevel::LOG_DEBUG);
+        NES_INFO("Setup DirectHashFunctionTest class.");
+    }
+};
+
+/// Every key must get its own bucket of a hash map with 256 buckets, while the upper bits still distinguish the keys for the partitions
+TEST_F(DirectHashFunctionTest, OneByteKeysHaveDistinctBucketsAndPartitions)
+{
+    constexpr uint64_t numberOfKeys = 256;
+    const DirectHashFunction hashFunction;
+    std::unordered_set<uint64_t> buckets;
+    std::unordered_set<uint64_t> upperBits;
+    for (int16_t key = std::numeric_limits<int8_t>::min(); key <= std::numeric_limits<int8_t>::max(); ++key)
+    {
+        const auto hash = nautilus::details::RawValueResolver<uint64_t>::getRawValue(
+            hashFunction.calculate(VarVal(nautilus::val<int8_t>(static_cast<int8_t>(key)))));
+        buckets.emplace(hash & (numberOfKeys - 1));
+        upperBits.emplace((hash >> 32) & (numberOfKeys - 1));
+    }
+    EXPECT_EQ(buckets.size(), numberOfKeys);
+    EXPECT_EQ(upperBits.size(), numberOfKeys);
+}
+
+TEST_F(DirectHashFunctionTest, TwoByteKeysHaveDistinctBucketsAndPartitions)
+{
+    constexpr uint64_t numberOfKeys = 65536;
+    const DirectHashFunction hashFunction;
+    std::unordered_set<uint64_t> buckets;
+    std::unordered_set<uint64_t> upperBits;
+    for (uint32_t key = 0; key < numberOfKeys; ++key)
+    {
+        const auto hash = nautilus::details::RawValueResolver<uint64_t>::getRawValue(
+            hashFunction.calculate(VarVal(nautilus::val<uint16_t>(static_cast<uint16_t>(key)))));
+        buckets.emplace(hash & (numberOfKeys - 1));
+        upperBits.emplace((hash >> 32) & (numberOfKeys - 1));
+    }
+    EXPECT_EQ(buckets.size(), numberOfKeys);
+    EXPECT_EQ(upperBits.size(), numberOfKeys);
+}
+
+/// Wider keys from a small range, e.g., the hours of a day, fill the first buckets of a hash map without any collisions
+TEST_F(DirectHashFunctionTest, WideKeysOfASmallRangeHaveDistinctBuckets)
+{
+    constexpr uint64_t numberOfBuckets = 32;
+    const DirectHashFunction hashFunction;
+    std::unordered_set<uint64_t> buckets;
+    for (int64_t hour = 0; hour < 24; ++hour)
+    {
+        const auto hash
+            = nautilus::details::RawValueResolver<uint64_t>::getRawValue(hashFunction.calculate(VarVal(nautilus::val<int64_t>(hour))));
+        EXPECT_EQ(hash & (numberOfBuckets - 1), static_cast<uint64_t>(hour));
+        buckets.emplace(hash & (numberOfBuckets - 1));
+    }
+    EXPECT_EQ(buckets.size(), 24);
+}
+
+/// Sparse keys of two bytes share the buckets of a smaller hash map. Thus, AUTO only chooses the direct hash function for one byte keys
+TEST_F(DirectHashFunctionTest, StridedTwoByteKeysShareABucket)
+{
+    constexpr uint64_t numberOfBuckets = 1024;
+    const DirectHashFunction hashFunction;
+    std::unordered_set<uint64_t> buckets;
+    for (uint32_t key = 0; key <= std::numeric_limits<uint16_t>::max(); key += numberOfBuckets)
+    {
+        const auto hash = nautilus::details::RawValueResolver<uint64_t>::getRawValue(
+            hashFunction.calculate(VarVal(nautilus::val<uint16_t>(static_cast<uint16_t>(key)))));
+        buckets.emplace(hash & (numberOfBuckets - 1));
+    }
+    EXPECT_EQ(buckets.size(), 1);
+}
+
+TEST_F(DirectHashFunctionTest, BooleanKeysHaveDistinctHashes)
+{
+    const DirectHashFunction hashFunction;
+    const auto hashOf = [&](const bool key)
+    { return nautilus::details::RawValueResolver<uint64_t>::getRawValue(hashFunction.calculate(VarVal(nautilus::val<bool>(key)))); };
+    EXPECT_NE(hashOf(true), hashOf(false));
+}
+
+}
@@ -12,12 +12,15 @@
     limitations under the License.
 */
 
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <memory>
+#include <optional>
 #include <random>
 #include <sstream>
+#include <string>
 #include <tuple>
 #include <vector>
 #include <DataTypes/DataType.hpp>
@@ -71,9 +74,13 @@ public:
         layoutType = std::get<1>(GetParam());
         /// Setting the correct options for the engine, depending on the enum value from the backend
         nautilus::engine::Options options;
-        const bool compilation = (backend == ExecutionMode::COMPILER);
+        const bool compilation = (backend != ExecutionMode::INTERPRETER);
         NES_INFO("Backend: {} and compilation: {}", magic_enum::enum_name(backend), compilation);
         options.setOption("engine.Compilation", compilation);
+        if (backend == ExecutionMode::BYTECODE)
+        {
+            options.setOption("engine.backend", std::string("bc"));
+        }
         options.setOption("mlir.enableMultithreading", mlirEnableMultithreading);
         nautilusEngine = std::make_unique<nautilus::engine::NautilusEngine>(options);
 
@@ -171,6 +178,150 @@ TEST_P(PagedVectorTest, storeAndRetrieveFixedValuesNonDefaultPageSize)
     TestUtils::runRetrieveTest(pagedVector, testSchema, layoutType, pageSize, projections, allRecords, *nautilusEngine, *bufferManager);
 }
 
+TEST_P(PagedVectorTest, storeAndRetrieveCompressedPages)
+{
+    bufferManager = BufferManager::create();
+    const auto testSchema = Schema{}
+                                .addField("value1", DataType::Type::UINT64)
+                                .addField("value2", DataTypeProvider::provideDataType(DataType::Type::VARSIZED))
+                                .addField("value3", DataType::Type::FLOAT64)
+                                .addField("value4", DataType::Type::INT32);
+    constexpr auto pageSize = 512UL;
+    const auto projections = testSchema.getFieldNames();
+    const auto allRecords = createMonotonicallyIncreasingValues(testSchema, layoutType, numberOfItems, *bufferManager);
+
+    PagedVector pagedVector;
+    TestUtils::runStoreTest(
+        pagedVector, testSchema, layoutType, pageSize, projections, allRecords, *nautilusEngine, *bufferManager, true);
+    TestUtils::runRetrieveTest(pagedVector, testSchema, layoutType, pageSize, projections, allRecords, *nautilusEngine, *bufferManager);
+
+    /// Reading the records decompresses all pages
+    EXPECT_EQ(pagedVector.getNumberOfCompressedPages(), 0);
+}
+
+TEST_P(PagedVectorTest, compressPageColumnByColumn)
+{
+    bufferManager = BufferManager::create();
+    /// Row layout with a constant, a slowly increasing and an alternating column
+    struct Entry
+    {
+        uint64_t constant;
+        uint64_t timestamp;
+        int32_t alternating;
+    } __attribute__((packed));
+    constexpr uint64_t capacity = PAGE_SIZE / sizeof(Entry);
+    const std::vector<PagedVector::Column> columns{
+        {.offset = offsetof(Entry, constant), .stride = sizeof(Entry), .width = sizeof(uint64_t)},
+        {.offset = offsetof(Entry, timestamp), .stride = sizeof(Entry), .width = sizeof(uint64_t)},
+        {.offset = offsetof(Entry, alternating), .stride = sizeof(Entry), .width = sizeof(int32_t)}};
+    const auto expectedEntry = [](const uint64_t i)
+    { return Entry{.constant = 42, .timestamp = 1'000'000'000 + (i * 10), .alternating = static_cast<int32_t>(i % 2)}; };
+
+    PagedVector pagedVector;
+    for (uint64_t pageIndex = 0; pageIndex < 3; ++pageIndex)
+    {
+        pagedVector.appendPageIfFull(bufferManager.get(), capacity, PAGE_SIZE);
+        const auto& page = pagedVector.getLastPage();
+        /// NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        auto* entries = const_cast<TupleBuffer&>(page).getAvailableMemoryArea<Entry>().data();
+        for (uint64_t i = 0; i < capacity; ++i)
+        {
+            entries[i] = expectedEntry((pageIndex * capacity) + i);
+        }
+        page.setNumberOfTuples(capacity);
+        pagedVector.compressLastPage(bufferManager.get(), columns);
+        ASSERT_EQ(pagedVector.getNumberOfCompressedPages(), pageIndex + 1);
+        /// The timestamps of a page span less than 2^16, the alternating values span 2
+        EXPECT_LT(pagedVector.getLastPage().getBufferSize(), PAGE_SIZE / 4);
+    }
+    ASSERT_EQ(pagedVector.getTotalNumberOfEntries(), 3 * capacity);
+
+    /// Accessing an entry decompresses its page
+    for (uint64_t entryPos = pagedVector.getTotalNumberOfEntries(); entryPos-- > 0;)
+    {
+        const auto* page = pagedVector.getTupleBufferForEntry(entryPos);
+        ASSERT_NE(page, nullptr);
+        const auto entry = page->getAvailableMemoryArea<Entry>()[pagedVector.getBufferPosForEntry(entryPos).value()];
+        const auto expected = expectedEntry(entryPos);
+        EXPECT_EQ(entry.constant, expected.constant);
+        EXPECT_EQ(entry.timestamp, expected.timestamp);
+        EXPECT_EQ(entry.alternating, expected.alternating);
+    }
+    EXPECT_EQ(pagedVector.getNumberOfCompressedPages(), 0);
+    EXPECT_EQ(pagedVector.getFirstPage().getBufferSize(), PAGE_SIZE);
+}
+
+/// Copying a column spans the pages of the entries
+TEST_P(PagedVectorTest, copyColumnOfEntries)
+{
+    bufferManager = BufferManager::create();
+    struct Entry
+    {
+        uint64_t key;
+        int32_t value;
+    } __attribute__((packed));
+    constexpr uint64_t capacity = PAGE_SIZE / sizeof(Entry);
+    constexpr PagedVector::Column keyColumn{.offset = offsetof(Entry, key), .stride = sizeof(Entry), .width = sizeof(uint64_t)};
+
+    PagedVector pagedVector;
+    for (uint64_t pageIndex = 0; pageIndex < 3; ++pageIndex)
+    {
+        pagedVector.appendPageIfFull(bufferManager.get(), capacity, PAGE_SIZE);
+        const auto& page = pagedVector.getLastPage();
+        /// NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        auto* entries = const_cast<TupleBuffer&>(page).getAvailableMemoryArea<Entry>().data();
+        for (uint64_t i = 0; i < capacity; ++i)
+        {
+            entries[i] = Entry{.key = (pageIndex * capacity) + i, .value = -1};
+        }
+        page.setNumberOfTuples(capacity);
+    }
+
+    const uint64_t beginEntry = capacity - 10;
+    const uint64_t numberOfEntries = capacity + 20;
+    std::vector<uint64_t> keys(numberOfEntries);
+    pagedVector.copyColumn(beginEntry, numberOfEntries, keyColumn, reinterpret_cast<int8_t*>(keys.data()));
+    for (uint64_t i = 0; i < numberOfEntries; ++i)
+    {
+        EXPECT_EQ(keys[i], beginEntry + i);
+    }
+}
+
+/// The page of an entry is computed for pages of the same number of entries and searched for after appending partially filled pages
+TEST_P(PagedVectorTest, pageIndexForEntries)
+{
+    bufferManager = BufferManager::create();
+    constexpr uint64_t capacity = PAGE_SIZE / sizeof(uint64_t);
+    const auto fillPages = [&](PagedVector& pagedVector, const uint64_t numberOfPages, const uint64_t entriesOnLastPage)
+    {
+        for (uint64_t pageIndex = 0; pageIndex < numberOfPages; ++pageIndex)
+        {
+            pagedVector.appendPageIfFull(bufferManager.get(), capacity, PAGE_SIZE);
+            pagedVector.getLastPage().setNumberOfTuples((pageIndex + 1 == numberOfPages) ? entriesOnLastPage : capacity);
+        }
+    };
+
+    PagedVector pagedVector;
+    fillPages(pagedVector, 3, 5);
+    EXPECT_EQ(pagedVector.getPageIndexForEntry(0), 0);
+    EXPECT_EQ(pagedVector.getPageIndexForEntry(capacity - 1), 0);
+    EXPECT_EQ(pagedVector.getPageIndexForEntry(capacity), 1);
+    EXPECT_EQ(pagedVector.getPageIndexForEntry((2 * capacity) + 4), 2);
+    EXPECT_EQ(pagedVector.getPageIndexForEntry((2 * capacity) + 5), std::nullopt);
+    EXPECT_EQ(pagedVector.getBufferPosForEntry((2 * capacity) + 4), 4);
+
+    /// Appending the pages of another PagedVector keeps the partially filled page in the middle
+    PagedVector otherPagedVector;
+    fillPages(otherPagedVector, 2, capacity);
+    pagedVector.copyFrom(otherPagedVector);
+    EXPECT_EQ(pagedVector.getPageIndexForEntry((2 * capacity) + 5), 3);
+    EXPECT_EQ(pagedVector.getPageIndexForEntry((3 * capacity) + 4), 3);
+    EXPECT_EQ(pagedVector.getPageIndexForEntry((3 * capacity) + 5), 4);
+    EXPECT_EQ(pagedVector.getBufferPosForEntry((3 * capacity) + 5), 0);
+    EXPECT_EQ(pagedVector.getPage(4), std::addressof(pagedVector.getLastPage()));
+    EXPECT_EQ(pagedVector.getPage(5), nullptr);
+}
+
 TEST_P(PagedVectorTest, appendAllPagesTwoVectors)
 {
     bufferManager = BufferManager::create();
@@ -294,7 +445,7 @@ INSTANTIATE_TEST_CASE_P(
     PagedVectorTest,
     PagedVectorTest,
     ::testing::Combine(
-        ::testing::Values(ExecutionMode::INTERPRETER, ExecutionMode::COMPILER),
+        ::testing::Values(ExecutionMode::INTERPRETER, ExecutionMode::COMPILER, ExecutionMode::BYTECODE),
         ::testing::Values(MemoryLayoutType::ROW_LAYOUT, MemoryLayoutType::COLUMNAR_LAYOUT)),
     [](const testing::TestParamInfo<PagedVectorTest::ParamType>& info)
     {
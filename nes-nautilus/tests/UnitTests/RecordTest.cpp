@@ -0,0 +1,125 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+#include <ErrorHandling.hpp>
+#include <val.hpp>
+
+namespace NES
+{
+class RecordTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestCase()
+    {
+        Logger::setupLogging("RecordTest.log", LogLevel::LOG_DEBUG);
+        NES_INFO("Setup RecordTest class.");
+    }
+
+    static void TearDownTestCase() { NES_INFO("Tear down RecordTest class."); }
+};
+
+TEST_F(RecordTest, SlotsAreStableAndDistinct)
+{
+    const auto first = Record::resolveSlot("RecordTest$first");
+    const auto second = Record::resolveSlot("RecordTest$second");
+    EXPECT_NE(first, second);
+    EXPECT_EQ(Record::resolveSlot("RecordTest$first"), first);
+    EXPECT_EQ(Record::getFieldName(first), "RecordTest$first");
+    EXPECT_EQ(Record::getFieldName(second), "RecordTest$second");
+}
+
+TEST_F(RecordTest, ConcurrentlyResolvedSlotsAgree)
+{
+    constexpr auto numberOfThreads = 8;
+    constexpr auto numberOfFields = 100;
+    std::vector<std::vector<Record::FieldSlot>> slotsPerThread(numberOfThreads);
+    {
+        std::vector<std::jthread> threads;
+        for (auto thread = 0; thread < numberOfThreads; ++thread)
+        {
+            threads.emplace_back(
+                [&slotsPerThread, thread]
+                {
+                    for (auto field = 0; field < numberOfFields; ++field)
+                    {
+                        slotsPerThread[thread].emplace_back(Record::resolveSlot("RecordTest$concurrent" + std::to_string(field)));
+                    }
+                });
+        }
+    }
+    for (const auto& slots : slotsPerThread)
+    {
+        EXPECT_EQ(slots, slotsPerThread.front());
+    }
+}
+
+TEST_F(RecordTest, ReadsFieldsByNameAndBySlot)
+{
+    Record record;
+    record.write("RecordTest$a", VarVal(nautilus::val<int32_t>(1)));
+    record.write(Record::resolveSlot("RecordTest$b"), VarVal(nautilus::val<int64_t>(2)));
+
+    EXPECT_EQ(record.getNumberOfFields(), 2U);
+    EXPECT_EQ(record.read(Record::resolveSlot("RecordTest$a")).getRawValueAs<nautilus::val<int32_t>>(), 1);
+    EXPECT_EQ(record.read("RecordTest$b").getRawValueAs<nautilus::val<int64_t>>(), 2);
+    EXPECT_TRUE(record.hasField("RecordTest$a"));
+    EXPECT_TRUE(record.hasField(Record::resolveSlot("RecordTest$b")));
+    EXPECT_FALSE(record.hasField("RecordTest$neverResolved"));
+    EXPECT_FALSE(record.hasField(Record::resolveSlot("RecordTest$c")));
+    ASSERT_EXCEPTION_ERRORCODE(static_cast<void>(record.read("RecordTest$neverResolved")), ErrorCode::FieldNotFound);
+    ASSERT_EXCEPTION_ERRORCODE(static_cast<void>(record.read(Record::resolveSlot("RecordTest$c"))), ErrorCode::FieldNotFound);
+}
+
+TEST_F(RecordTest, WritesFieldsOutOfSlotOrder)
+{
+    const auto low = Record::resolveSlot("RecordTest$low");
+    const auto middle = Record::resolveSlot("RecordTest$middle");
+    const auto high = Record::resolveSlot("RecordTest$high");
+
+    Record record;
+    record.write(high, VarVal(nautilus::val<int32_t>(3)));
+    record.write(low, VarVal(nautilus::val<int32_t>(1)));
+    record.write(middle, VarVal(nautilus::val<int32_t>(2)));
+    /// Overwriting a field may change its data type
+    record.write(middle, VarVal(nautilus::val<double>(2.5)));
+
+    EXPECT_EQ(record.getNumberOfFields(), 3U);
+    EXPECT_EQ(record.read(low).getRawValueAs<nautilus::val<int32_t>>(), 1);
+    EXPECT_EQ(record.read(middle).getRawValueAs<nautilus::val<double>>(), 2.5);
+    EXPECT_EQ(record.read(high).getRawValueAs<nautilus::val<int32_t>>(), 3);
+
+    Record otherRecord;
+    otherRecord.write(low, VarVal(nautilus::val<int32_t>(1)));
+    otherRecord.write(middle, VarVal(nautilus::val<double>(2.5)));
+    otherRecord.write(high, VarVal(nautilus::val<int32_t>(3)));
+    EXPECT_TRUE(static_cast<bool>(record == otherRecord));
+
+    otherRecord.write(high, VarVal(nautilus::val<int32_t>(4)));
+    EXPECT_FALSE(static_cast<bool>(record == otherRecord));
+    record.reassignFields(otherRecord);
+    EXPECT_EQ(record.read(high).getRawValueAs<nautilus::val<int32_t>>(), 4);
+}
+
+}
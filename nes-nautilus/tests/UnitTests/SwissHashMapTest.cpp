@@ -0,0 +1,152 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <unordered_set>
+#include <vector>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMap.hpp>
+#include <Nautilus/Interface/HashMap/SwissHashMap/SwissHashMap.hpp>
+#include <Runtime/BufferManager.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+namespace NES
+{
+class SwissHashMapTest : public Testing::BaseUnitTest
+{
+public:
+    static constexpr uint64_t KEY_SIZE = 8;
+    static constexpr uint64_t VALUE_SIZE = 8;
+    static constexpr uint64_t PAGE_SIZE = 1024;
+
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("SwissHashMapTest.log", LogLevel::LOG_DEBUG);
+        NES_INFO("Setup SwissHashMapTest class.");
+    }
+
+    void SetUp() override
+    {
+        BaseUnitTest::SetUp();
+        bufferManager = BufferManager::create();
+    }
+
+    /// Returns true, if the probe sequence of the hash contains the entry
+    static bool containsEntry(const SwissHashMap& hashMap, const uint64_t hash, const ChainedHashMapEntry* entry)
+    {
+        for (auto slot = hashMap.findNextCandidateSlot(hash, SwissHashMap::NO_SLOT); slot != SwissHashMap::NO_SLOT;
+             slot = hashMap.findNextCandidateSlot(hash, slot))
+        {
+            EXPECT_EQ(hashMap.getEntryInSlot(slot)->hash, hash);
+            if (hashMap.getEntryInSlot(slot) == entry)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::shared_ptr<BufferManager> bufferManager;
+};
+
+TEST_F(SwissHashMapTest, emptyHashMapHasNoCandidates)
+{
+    const SwissHashMap hashMap{KEY_SIZE, VALUE_SIZE, 10, PAGE_SIZE};
+    EXPECT_EQ(hashMap.getNumberOfTuples(), 0);
+    EXPECT_EQ(hashMap.getNumberOfSlots(), 0);
+    EXPECT_EQ(hashMap.findNextCandidateSlot(42, SwissHashMap::NO_SLOT), SwissHashMap::NO_SLOT);
+}
+
+/// Inserts more entries than the initial number of slots, so that the hash map has to grow multiple times.
+/// A third of the hashes share the same control byte (h2), so that the groups contain candidates with a different hash.
+TEST_F(SwissHashMapTest, insertAndFindWhileGrowing)
+{
+    constexpr uint64_t numberOfEntries = 10000;
+    SwissHashMap hashMap{KEY_SIZE, VALUE_SIZE, 10, PAGE_SIZE};
+    std::mt19937_64 generator{42}; /// NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::vector<uint64_t> hashes;
+    std::vector<ChainedHashMapEntry*> entries;
+    for (uint64_t i = 0; i < numberOfEntries; ++i)
+    {
+        const auto hash = i % 3 == 0 ? (generator() & ~0x7FUL) | 0x05UL : generator();
+        hashes.emplace_back(hash);
+        entries.emplace_back(dynamic_cast<ChainedHashMapEntry*>(hashMap.insertEntry(hash, bufferManager.get())));
+    }
+
+    EXPECT_EQ(hashMap.getNumberOfTuples(), numberOfEntries);
+    EXPECT_GE(hashMap.getNumberOfSlots(), numberOfEntries);
+    constexpr auto entriesPerPage = PAGE_SIZE / (sizeof(ChainedHashMapEntry) + KEY_SIZE + VALUE_SIZE);
+    EXPECT_EQ(hashMap.getNumberOfPages(), (numberOfEntries + entriesPerPage - 1) / entriesPerPage);
+    for (uint64_t i = 0; i < numberOfEntries; ++i)
+    {
+        /// Growing must not move the entries, as the operators keep pointers to the entries
+        EXPECT_EQ(entries[i]->hash, hashes[i]);
+        EXPECT_TRUE(containsEntry(hashMap, hashes[i], entries[i])) << "Entry " << i << " is not part of the probe sequence";
+    }
+}
+
+/// The same hash can be inserted multiple times, e.g., for keys with a hash collision. All of them have to be found.
+TEST_F(SwissHashMapTest, multipleEntriesWithSameHash)
+{
+    constexpr uint64_t numberOfEntries = 100;
+    constexpr uint64_t hash = 0xDEADBEEF;
+    SwissHashMap hashMap{KEY_SIZE, VALUE_SIZE, 10, PAGE_SIZE};
+    std::unordered_set<const ChainedHashMapEntry*> expectedEntries;
+    for (uint64_t i = 0; i < numberOfEntries; ++i)
+    {
+        expectedEntries.emplace(dynamic_cast<ChainedHashMapEntry*>(hashMap.insertEntry(hash, bufferManager.get())));
+    }
+
+    std::unordered_set<const ChainedHashMapEntry*> foundEntries;
+    for (auto slot = hashMap.findNextCandidateSlot(hash, SwissHashMap::NO_SLOT); slot != SwissHashMap::NO_SLOT;
+         slot = hashMap.findNextCandidateSlot(hash, slot))
+    {
+        foundEntries.emplace(hashMap.getEntryInSlot(slot));
+    }
+    EXPECT_EQ(foundEntries, expectedEntries);
+    EXPECT_EQ(hashMap.findNextCandidateSlot(hash + 1, SwissHashMap::NO_SLOT), SwissHashMap::NO_SLOT);
+}
+
+TEST_F(SwissHashMapTest, clearAndCreateNewMapWithSameConfiguration)
+{
+    SwissHashMap hashMap{KEY_SIZE, VALUE_SIZE, 10, PAGE_SIZE};
+    uint64_t numberOfDestroyedEntries = 0;
+    hashMap.setDestructorCallback([&numberOfDestroyedEntries](ChainedHashMapEntry*) { ++numberOfDestroyedEntries; });
+    for (uint64_t hash = 0; hash < 1000; ++hash)
+    {
+        hashMap.insertEntry(hash, bufferManager.get());
+    }
+
+    const auto newHashMap = hashMap.createNewMapWithSameConfiguration();
+    ASSERT_NE(dynamic_cast<SwissHashMap*>(newHashMap.get()), nullptr);
+    EXPECT_EQ(newHashMap->getNumberOfTuples(), 0);
+
+    hashMap.clear();
+    EXPECT_EQ(numberOfDestroyedEntries, 1000);
+    EXPECT_EQ(hashMap.getNumberOfTuples(), 0);
+    EXPECT_EQ(hashMap.getNumberOfPages(), 0);
+    EXPECT_EQ(hashMap.findNextCandidateSlot(7, SwissHashMap::NO_SLOT), SwissHashMap::NO_SLOT);
+
+    /// The hash map can be reused after clearing it
+    auto* entry = dynamic_cast<ChainedHashMapEntry*>(hashMap.insertEntry(7, bufferManager.get()));
+    EXPECT_TRUE(containsEntry(hashMap, 7, entry));
+}
+
+}
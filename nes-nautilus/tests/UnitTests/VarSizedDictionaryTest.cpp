@@ -0,0 +1,152 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <Nautilus/DataTypes/VarSizedDictionary.hpp>
+#include <Nautilus/Interface/Hash/MurMur3HashFunction.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+#include <ErrorHandling.hpp>
+
+/// NOLINTBEGIN(readability-magic-numbers)
+namespace NES
+{
+
+class VarSizedDictionaryTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestCase()
+    {
+        Logger::setupLogging("VarSizedDictionaryTest.log", LogLevel::LOG_DEBUG);
+        NES_INFO("Setup VarSizedDictionaryTest test class.");
+    }
+
+    static uint64_t readCachedHash(const int8_t* internedValue, const uint64_t size)
+    {
+        uint64_t hash = 0;
+        std::memcpy(&hash, internedValue + VarSizedDictionary::getOffsetOfHash(size), sizeof(hash));
+        return hash;
+    }
+};
+
+TEST_F(VarSizedDictionaryTest, equalValuesShareTheirInternedCopy)
+{
+    VarSizedDictionary dictionary;
+    const std::string germany = "Germany";
+    const std::string otherGermany = "Germany";
+    const std::string france = "France";
+
+    const auto* const internedGermany = dictionary.intern(germany);
+    EXPECT_EQ(internedGermany, dictionary.intern(otherGermany));
+    EXPECT_NE(internedGermany, dictionary.intern(france));
+    EXPECT_EQ(std::string_view(reinterpret_cast<const char*>(internedGermany), germany.size()), germany); /// NOLINT
+    EXPECT_EQ(dictionary.getNumberOfEntries(), 2);
+
+    /// The empty string is a regular value
+    EXPECT_EQ(dictionary.intern(""), dictionary.intern(std::string_view{}));
+    EXPECT_EQ(dictionary.getNumberOfEntries(), 3);
+}
+
+TEST_F(VarSizedDictionaryTest, internedValuesAreFollowedByTheirHash)
+{
+    VarSizedDictionary dictionary;
+    for (std::string value : {"", "a", "DE", "exactly8", "longer than eight bytes"})
+    {
+        const auto* const internedValue = dictionary.intern(value);
+        EXPECT_EQ(readCachedHash(internedValue, value.size()), hashBytes(value.data(), value.size())) << value;
+    }
+}
+
+/// NULL values are tagged with the dictionary as well, thus they must point to an interned value that is followed by its hash
+TEST_F(VarSizedDictionaryTest, nullValuesShareTheInternedEmptyValue)
+{
+    VarSizedDictionary dictionary;
+    const auto* const internedNull = internVarSizedProxy(&dictionary, nullptr, 0);
+    ASSERT_NE(internedNull, nullptr);
+    EXPECT_EQ(internedNull, internVarSizedProxy(&dictionary, nullptr, 0));
+    EXPECT_EQ(internedNull, dictionary.intern(""));
+    EXPECT_EQ(readCachedHash(internedNull, 0), hashBytes(nullptr, 0));
+    EXPECT_EQ(dictionary.getNumberOfEntries(), 1);
+}
+
+TEST_F(VarSizedDictionaryTest, concurrentInterning)
+{
+    constexpr size_t numberOfThreads = 8;
+    constexpr size_t numberOfDistinctValues = 100;
+    VarSizedDictionary dictionary;
+    std::vector<std::vector<int8_t*>> internedValuesPerThread(numberOfThreads);
+    {
+        std::vector<std::jthread> threads;
+        for (size_t threadIdx = 0; threadIdx < numberOfThreads; ++threadIdx)
+        {
+            threads.emplace_back(
+                [&dictionary, &internedValues = internedValuesPerThread[threadIdx]]
+                {
+                    for (size_t i = 0; i < numberOfDistinctValues; ++i)
+                    {
+                        internedValues.emplace_back(dictionary.intern(std::to_string(i)));
+                    }
+                });
+        }
+    }
+    EXPECT_EQ(dictionary.getNumberOfEntries(), numberOfDistinctValues);
+    for (const auto& internedValues : internedValuesPerThread)
+    {
+        EXPECT_EQ(internedValues, internedValuesPerThread.front());
+    }
+}
+
+TEST_F(VarSizedDictionaryTest, exceedingTheMaximumNumberOfEntriesThrows)
+{
+    VarSizedDictionary dictionary{1};
+    ASSERT_EXCEPTION_ERRORCODE(
+        {
+            for (size_t i = 0; i < 1000; ++i)
+            {
+                std::ignore = dictionary.intern(std::to_string(i));
+            }
+        },
+        ErrorCode::FormattingError);
+}
+
+TEST_F(VarSizedDictionaryTest, unboundedDictionaryAcceptsAllValues)
+{
+    VarSizedDictionary dictionary{VarSizedDictionary::UNBOUNDED_NUMBER_OF_ENTRIES};
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        std::ignore = dictionary.intern(std::to_string(i));
+    }
+    EXPECT_EQ(dictionary.getNumberOfEntries(), 1000);
+}
+
+TEST_F(VarSizedDictionaryTest, dictionariesHaveDistinctIds)
+{
+    const VarSizedDictionary dictionary;
+    const VarSizedDictionary otherDictionary;
+    EXPECT_NE(dictionary.getId(), 0);
+    EXPECT_NE(dictionary.getId(), otherDictionary.getId());
+}
+
+}
+/// NOLINTEND(readability-magic-numbers)
@@ -18,6 +18,7 @@
 #include <ios>
 #include <iosfwd>
 #include <random>
+#include <string>
 #include <utility>
 #include <vector>
 #include <Nautilus/DataTypes/VarVal.hpp>
@@ -216,6 +217,42 @@ TEST_F(VariableSizedDataTest, binaryOperatorOverloads)
     }
 }
 
+TEST_F(VariableSizedDataTest, prefixComparison)
+{
+    const auto createWithPrefix = [](std::string& value)
+    {
+        auto* content = reinterpret_cast<int8_t*>(value.data());
+        return VariableSizedData(
+            nautilus::val<int8_t*>(content),
+            nautilus::val<uint64_t>(value.size()),
+            nautilus::val<uint32_t>(VariableSizedData::computePrefix(content, value.size())));
+    };
+
+    std::string shortValue = "ab";
+    std::string otherShortValue = "ab";
+    std::string longValue = "abcdefghijklmnopq";
+    std::string longValueWithOtherPrefix = "abcefghijklmnopqr";
+    std::string longValueWithOtherSuffix = "abcdefghijklmnopr";
+    EXPECT_TRUE(createWithPrefix(shortValue) == createWithPrefix(otherShortValue));
+    EXPECT_FALSE(createWithPrefix(longValue) == createWithPrefix(longValueWithOtherPrefix));
+    EXPECT_FALSE(createWithPrefix(longValue) == createWithPrefix(longValueWithOtherSuffix));
+    EXPECT_TRUE(createWithPrefix(longValue) == createWithPrefix(longValue));
+
+    /// The prefix of a short value is padded with zeros, thus it matches the prefix that is read from the content of the value
+    const VariableSizedData withoutPrefix(nautilus::val<int8_t*>(reinterpret_cast<int8_t*>(shortValue.data())), shortValue.size());
+    EXPECT_FALSE(withoutPrefix.hasPrefix());
+    EXPECT_EQ(withoutPrefix.getPrefix(), createWithPrefix(shortValue).getPrefix());
+
+    /// Values with and without a prefix compare their content
+    EXPECT_TRUE(withoutPrefix == createWithPrefix(otherShortValue));
+
+    /// Assigning a value drops its prefix
+    auto assigned = withoutPrefix;
+    assigned = createWithPrefix(longValue);
+    EXPECT_FALSE(assigned.hasPrefix());
+    EXPECT_TRUE(assigned == createWithPrefix(longValue));
+}
+
 void compareStringProxy(const char* actual, const char* expected)
 {
     const std::string actualStr(actual);
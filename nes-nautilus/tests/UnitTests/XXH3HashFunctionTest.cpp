@@ -0,0 +1,92 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/DataTypes/VariableSizedData.hpp>
+#include <Nautilus/Interface/Hash/XXH3HashFunction.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+#include <val.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+class XXH3HashFunctionTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("XXH3HashFunctionTest.log", LogLevel::LOG_DEBUG);
+        NES_INFO("Setup XXH3HashFunctionTest class.");
+    }
+
+    static uint64_t getRawHash(const HashFunction::HashValue& hash)
+    {
+        return nautilus::details::RawValueResolver<uint64_t>::getRawValue(hash);
+    }
+};
+
+TEST_F(XXH3HashFunctionTest, BatchEqualsHashOfSingleValue)
+{
+    std::mt19937_64 generator{42};
+    std::vector<uint64_t> values{0, 1, 2, UINT64_MAX};
+    for (uint64_t i = 0; i < 1000; ++i)
+    {
+        values.emplace_back(generator());
+    }
+    std::vector<uint64_t> hashes(values.size());
+    XXH3HashFunction::calculateBatch(values.data(), values.size(), hashes.data());
+
+    const XXH3HashFunction hashFunction;
+    for (uint64_t i = 0; i < values.size(); ++i)
+    {
+        EXPECT_EQ(hashes[i], getRawHash(hashFunction.calculate(VarVal(nautilus::val<uint64_t>(values[i]))))) << values[i];
+    }
+}
+
+TEST_F(XXH3HashFunctionTest, HashDependsOnOrderOfValues)
+{
+    const XXH3HashFunction hashFunction;
+    const VarVal first{nautilus::val<uint64_t>(1)};
+    const VarVal second{nautilus::val<uint64_t>(2)};
+    const auto hashOf = [&](const std::vector<VarVal>& values) { return getRawHash(hashFunction.calculate(values)); };
+    EXPECT_NE(hashOf({first, second}), hashOf({second, first}));
+    EXPECT_NE(hashOf({first, first}), hashOf({second, second}));
+}
+
+TEST_F(XXH3HashFunctionTest, InternedAndNotInternedValuesHashEqual)
+{
+    const XXH3HashFunction hashFunction;
+    for (const std::string value : {"", "a", "nebulastream", "a value that is longer than the sixteen bytes of the short XXH3 paths"})
+    {
+        /// The copies make sure that the hash depends on the content instead of the address of the value
+        std::string copy = value;
+        std::string internedCopy = value;
+        constexpr uint64_t dictionaryId = 1;
+        const nautilus::val<int8_t*> content(reinterpret_cast<int8_t*>(copy.data()));
+        const nautilus::val<int8_t*> internedContent(reinterpret_cast<int8_t*>(internedCopy.data()));
+        const VariableSizedData notInterned(content, copy.size());
+        const VariableSizedData interned(internedContent, internedCopy.size(), dictionaryId);
+        EXPECT_EQ(getRawHash(hashFunction.calculate(VarVal(notInterned))), getRawHash(hashFunction.calculate(VarVal(interned)))) << value;
+    }
+}
+
+}
@@ -15,15 +15,19 @@
 #pragma once
 
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <Aggregation/AggregationOperatorHandler.hpp>
 #include <Aggregation/Function/AggregationPhysicalFunction.hpp>
 #include <Identifiers/Identifiers.hpp>
 #include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Nautilus/Interface/RecordBuffer.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
 #include <Runtime/Execution/OperatorHandler.hpp>
 #include <Time/Timestamp.hpp>
 #include <Watermark/TimeFunction.hpp>
+#include <Arena.hpp>
 #include <CompilationContext.hpp>
 #include <HashMapOptions.hpp>
 #include <WindowBuildPhysicalOperator.hpp>
@@ -32,32 +36,71 @@ namespace NES
 {
 class AggregationBuildPhysicalOperator;
 HashMap* getAggHashMapProxy(
-    const AggregationOperatorHandler* operatorHandler,
+    AggregationOperatorHandler* operatorHandler,
     Timestamp timestamp,
     WorkerThreadId workerThreadId,
+    uint64_t partition,
+    const AggregationBuildPhysicalOperator* buildOperator);
+HashMap* getPreAggregationHashMapProxy(
+    AggregationOperatorHandler* operatorHandler,
+    Timestamp timestamp,
+    WorkerThreadId workerThreadId,
+    AbstractBufferProvider* bufferProvider,
+    Arena* arena,
     const AggregationBuildPhysicalOperator* buildOperator);
 
 class AggregationBuildPhysicalOperator final : public WindowBuildPhysicalOperator
 {
 public:
     friend HashMap* getAggHashMapProxy(
-        const AggregationOperatorHandler* operatorHandler,
+        AggregationOperatorHandler* operatorHandler,
         Timestamp timestamp,
         WorkerThreadId workerThreadId,
+        uint64_t partition,
+        const AggregationBuildPhysicalOperator* buildOperator);
+    friend HashMap* getPreAggregationHashMapProxy(
+        AggregationOperatorHandler* operatorHandler,
+        Timestamp timestamp,
+        WorkerThreadId workerThreadId,
+        AbstractBufferProvider* bufferProvider,
+        Arena* arena,
         const AggregationBuildPhysicalOperator* buildOperator);
 
     AggregationBuildPhysicalOperator(
         OperatorHandlerId operatorHandlerId,
         std::unique_ptr<TimeFunction> timeFunction,
         std::vector<std::shared_ptr<AggregationPhysicalFunction>> aggregationFunctions,
-        HashMapOptions hashMapOptions);
+        HashMapOptions hashMapOptions,
+        uint64_t numberOfPartitions = 1,
+        bool preAggregation = false,
+        bool lockHashMaps = false,
+        bool acceptsLateRecords = false,
+        bool clusteredKeys = false);
     void setup(ExecutionContext& executionCtx, CompilationContext& compilationContext) const override;
+    void open(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const override;
     void execute(ExecutionContext& ctx, Record& record) const override;
+    void close(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const override;
 
 private:
+    [[nodiscard]] std::unique_ptr<WindowOperatorBuildLocalState>
+    createLocalState(const nautilus::val<OperatorHandler*>& operatorHandler) const override;
+
     /// The aggregation function is a shared_ptr, because it is used in the aggregation build and in the getSliceCleanupFunction()
     std::vector<std::shared_ptr<AggregationPhysicalFunction>> aggregationPhysicalFunctions;
     HashMapOptions hashMapOptions;
+    /// Number of partitions of the hash maps, so that the window trigger can combine the partitions concurrently
+    uint64_t numberOfPartitions;
+    /// Pre-aggregates the records of each worker thread in a small hash map, c.f., PreAggregation. Requires a single partition.
+    bool preAggregation;
+    /// Holds the lock of the hash maps of the worker thread while processing a buffer, as the early results and the checkpoints read them
+    /// concurrently
+    bool lockHashMaps;
+    /// Tracks the slices that the records of a buffer update, so that triggered windows get emitted again, and discards the records beyond
+    /// the allowed lateness, c.f., AggregationOperatorHandler::acceptsLateRecords
+    bool acceptsLateRecords;
+    /// The input arrives in runs of equal keys, e.g., per-device batches. Thus, a record reuses the entry of the previous record of the
+    /// tuple buffer, if their keys and hash maps match, and skips the hashing and the probing of the hash map.
+    bool clusteredKeys;
 };
 
 }
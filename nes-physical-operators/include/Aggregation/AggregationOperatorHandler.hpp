@@ -14,20 +14,40 @@
 
 #pragma once
 #include <algorithm>
+#include <atomic>
 #include <bit>
+#include <chrono>
 #include <cstdint>
+#include <filesystem>
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <stop_token>
 #include <utility>
 #include <vector>
+#include <Aggregation/AggregationSlice.hpp>
+#include <Aggregation/AggregationStateCheckpoint.hpp>
+#include <Aggregation/PreAggregation.hpp>
+#include <Aggregation/SlidingWindowAggregates.hpp>
+#include <Aggregation/TopKEntries.hpp>
 #include <Identifiers/Identifiers.hpp>
 #include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
 #include <Runtime/Execution/OperatorHandler.hpp>
+#include <Runtime/QueryTerminationType.hpp>
 #include <SliceStore/Slice.hpp>
 #include <SliceStore/WindowSlicesStoreInterface.hpp>
+#include <Time/Timestamp.hpp>
 #include <Util/RollingAverage.hpp>
+#include <folly/Synchronized.h>
+#include <Arena.hpp>
+#include <Engine.hpp>
 #include <HashMapSlice.hpp>
+#include <PipelineExecutionContext.hpp>
+#include <Thread.hpp>
 #include <WindowBasedOperatorHandler.hpp>
 
 namespace NES
@@ -38,8 +58,19 @@ namespace NES
 /// is large enough to store all slices of the window to be triggered.
 struct EmittedAggregationWindow
 {
-    EmittedAggregationWindow(const WindowInfo windowInfo, std::unique_ptr<HashMap> finalHashMap, const std::vector<HashMap*>& allHashMaps)
-        : windowInfo(windowInfo), finalHashMap(std::move(finalHashMap)), numberOfHashMaps(allHashMaps.size())
+    EmittedAggregationWindow(
+        const WindowInfo windowInfo,
+        std::unique_ptr<HashMap> finalHashMap,
+        const std::vector<HashMap*>& allHashMaps,
+        WindowPartialAggregates partialAggregates,
+        std::shared_ptr<const PartialAggregate> previousEarlyResult,
+        HashMap* previousHashMapPtr)
+        : windowInfo(windowInfo)
+        , finalHashMap(std::move(finalHashMap))
+        , numberOfHashMaps(allHashMaps.size())
+        , partialAggregates(std::move(partialAggregates))
+        , previousEarlyResult(std::move(previousEarlyResult))
+        , previousHashMapPtr(previousHashMapPtr)
     {
         finalHashMapPtr = this->finalHashMap.get();
         /// Copying the hashmap pointers after this object, hence this + 1
@@ -52,6 +83,12 @@ struct EmittedAggregationWindow
     std::unique_ptr<HashMap> finalHashMap; /// Pointer to the final hash map that the probe should use to combine all hash maps
     uint64_t numberOfHashMaps;
     HashMap** hashMaps; /// Pointer to the stored pointers of all hash maps that the probe should combine
+    WindowPartialAggregates partialAggregates; /// Keeps the shared partial aggregates of the hash maps alive until the probe is done
+    std::unique_ptr<TopKEntries> topKEntries; /// Entries of the final hash map that the probe of a top-k window emits
+    /// Keeps the previous early result (or emission of a window accepting late records) alive, so that the probe solely emits the keys
+    /// that changed
+    std::shared_ptr<const PartialAggregate> previousEarlyResult;
+    HashMap* previousHashMapPtr; /// Hash map of the partition in the previous early result, or nullptr if the probe emits all keys
 };
 
 class AggregationOperatorHandler final : public WindowBasedOperatorHandler
@@ -61,22 +98,160 @@ public:
         const std::vector<OriginId>& inputOrigins,
         OriginId outputOriginId,
         std::unique_ptr<WindowSlicesStoreInterface> sliceAndWindowStore,
-        uint64_t maxNumberOfBuckets);
+        uint64_t maxNumberOfBuckets,
+        uint64_t numberOfPartitions = 1,
+        bool shareSlidingWindowAggregates = true,
+        std::optional<std::chrono::milliseconds> earlyResultInterval = std::nullopt);
+
+    void start(PipelineExecutionContext& pipelineExecutionContext, uint32_t localStateVariableId) override;
+    /// Stops taking checkpoints. After a graceful termination, the handler takes a final checkpoint without any filling windows, so that a
+    /// restarted query does not restore any state.
+    void stop(QueryTerminationType queryTerminationType, PipelineExecutionContext& pipelineExecutionContext) override;
 
     [[nodiscard]] std::function<std::vector<std::shared_ptr<Slice>>(SliceStart, SliceEnd)>
     getCreateNewSlicesFunction(const CreateNewSlicesArguments& newSlicesArguments) const override;
 
+    /// Returns the pre-aggregation of the worker thread, c.f., PreAggregation
+    [[nodiscard]] PreAggregation& getPreAggregation(WorkerThreadId workerThreadId);
+
+    /// Returns how much the hash maps of all destroyed slices had to grow, as they received more keys than expected
+    [[nodiscard]] HashMapGrowthStatistics getHashMapGrowthStatistics() const;
+
+    /// Triggers the windows, c.f., WindowBasedOperatorHandler, and emits the early results of all filling windows, once the interval
+    /// of the early results has passed
+    void checkAndTriggerWindows(const BufferMetaData& bufferMetaData, PipelineExecutionContext* pipelineCtx) override;
+
+    /// Returns true, if the windows emit early results while they are filling
+    [[nodiscard]] bool emitsEarlyResults() const;
+    /// The early results read the hash maps of the slices, while the worker threads fill them. Thus, if the windows emit early results,
+    /// a worker thread holds the lock of its hash maps, while it adds the records of a buffer to them.
+    void lockHashMapsOfWorkerThread(WorkerThreadId workerThreadId);
+    void unlockHashMapsOfWorkerThread(WorkerThreadId workerThreadId);
+
+    /// Takes a checkpoint of the slices of all filling windows in the directory after every interval, c.f., AggregationStateCheckpoint.
+    /// As for the early results, the worker threads hold the lock of their hash maps while they add the records of a buffer to them.
+    void enableCheckpoints(std::filesystem::path directory, std::chrono::milliseconds interval);
+    [[nodiscard]] bool takesCheckpoints() const;
+    /// Restores the slices of the latest checkpoint in the directory and starts taking checkpoints. The build calls it once in its setup,
+    /// i.e., before it adds any records to the slices.
+    void restoreCheckpoint(
+        const CreateNewHashMapSliceArgs& newHashMapSliceArgs, AbstractBufferProvider* bufferProvider, uint64_t numberOfWorkerThreads);
+
+    /// Returns true, if the slice store keeps the windows for an allowed lateness after triggering them. Then, late records that update a
+    /// triggered window let the window get emitted again, solely with the keys that changed since its previous emission.
+    [[nodiscard]] bool acceptsLateRecords() const;
+    /// The build tracks the slices that the records of the current buffer update. At the end of the buffer, it marks the triggered windows
+    /// of these slices for another emission, c.f., WindowSlicesStoreInterface::markWindowsWithLateUpdates.
+    void addUpdatedSlice(WorkerThreadId workerThreadId, const std::shared_ptr<AggregationSlice>& slice);
+    void finishLateRecordsOfBuffer(WorkerThreadId workerThreadId);
+    /// Returns the hash map that receives a record beyond the allowed lateness, which is dropped at the end of the buffer
+    [[nodiscard]] HashMap* getHashMapOfDiscardedLateRecord(
+        WorkerThreadId workerThreadId, uint64_t partition, const CreateNewHashMapSliceArgs& newHashMapSliceArgs);
+
     /// Is required to not perform the setup again and resolving a race condition to the cleanup state function
     std::atomic<bool> setupAlreadyCalled;
     /// shared_ptr as multiple slices need access to it
     std::shared_ptr<CreateNewHashMapSliceArgs::NautilusCleanupExec> cleanupStateNautilusFunction;
 
+    /// Combines the aggregation states of all keys of the source hash map into the destination hash map
+    using NautilusCombineExec = nautilus::engine::CallableFunction<void, HashMap*, HashMap*, AbstractBufferProvider*, Arena*>;
+    /// Returns true, if overlapping sliding windows share partial aggregates of their slices (see SlidingWindowAggregates)
+    [[nodiscard]] bool sharesSlidingWindowAggregates() const;
+    /// Is set by the probe, if the sliding windows share partial aggregates, the windows emit early results or accept late records
+    std::shared_ptr<NautilusCombineExec> combineStateNautilusFunction;
+    /// Is set by the build, if it pre-aggregates the records of each worker thread before combining them into the slices
+    std::shared_ptr<NautilusCombineExec> combinePreAggregationNautilusFunction;
+
 protected:
     void triggerSlices(
         const std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>>& slicesAndWindowInfo,
         PipelineExecutionContext* pipelineCtx) override;
+    /// Emits one buffer per partition of the window to the probe. The probe emits all keys of the partition, unless the previous early
+    /// result of the window is given, in which case it solely emits the keys that changed since then.
+    void emitPartitionToProbe(
+        const WindowInfoAndSequenceNumber& windowInfo,
+        uint64_t partition,
+        const std::vector<HashMap*>& allHashMaps,
+        const WindowPartialAggregates& partialAggregates,
+        const std::shared_ptr<const PartialAggregate>& previousEarlyResult,
+        const IngestionTimestamps& ingestionTimestamps,
+        Timestamp watermark,
+        PipelineExecutionContext* pipelineCtx) const;
+
+    /// Combines the hash maps of all worker threads in the slices into a new partial aggregate, while the worker threads keep on writing
+    [[nodiscard]] std::shared_ptr<PartialAggregate>
+    combineIntoSnapshot(const std::vector<std::shared_ptr<Slice>>& slices, AbstractBufferProvider* bufferProvider, Arena& arena) const;
+    /// Emits all partitions of the snapshot of the window to the probe, c.f., emitPartitionToProbe
+    void emitSnapshotToProbe(
+        const WindowInfoAndSequenceNumber& windowInfo,
+        const std::vector<std::shared_ptr<Slice>>& slices,
+        const std::shared_ptr<const PartialAggregate>& snapshot,
+        const std::shared_ptr<const PartialAggregate>& previousSnapshot,
+        Timestamp watermark,
+        PipelineExecutionContext* pipelineCtx) const;
+
+    /// Combines the hash maps of all worker threads of each filling window into a new partial aggregate and emits it to the probe
+    void emitEarlyResults(PipelineExecutionContext* pipelineCtx);
+    /// Emits the triggered windows as snapshots, as late records might still update their slices
+    void triggerWindowsAcceptingLateRecords(
+        const std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>>& slicesAndWindowInfo,
+        PipelineExecutionContext* pipelineCtx);
+
     folly::Synchronized<RollingAverage<uint64_t>> rollingAverageNumberOfKeys;
     uint64_t maxNumberOfBuckets;
+    /// Each partition of a window gets combined by its own probe task, i.e., a window is emitted in numberOfPartitions chunks
+    uint64_t numberOfPartitions;
+    /// shared_ptr as the slices add the statistics of their hash maps, once they get destroyed
+    std::shared_ptr<folly::Synchronized<HashMapGrowthStatistics>> hashMapGrowthStatistics;
+    /// shared_ptr as the slices release their hash maps to the pool, once they get destroyed
+    std::shared_ptr<HashMapPool> hashMapPool;
+    /// nullptr, if the windows do not overlap enough for sharing partial aggregates or the sharing is disabled
+    std::unique_ptr<SlidingWindowAggregates> slidingWindowAggregates;
+    /// One pre-aggregation per worker thread, which is solely accessed by its worker thread
+    std::vector<PreAggregation> preAggregations;
+
+    struct alignas(std::hardware_destructive_interference_size) HashMapsLock
+    {
+        std::mutex mutex;
+    };
+
+    /// nullopt, if the windows solely emit their results, once they get triggered
+    std::optional<std::chrono::milliseconds> earlyResultInterval;
+    /// One lock per worker thread, which guards the hash maps of the worker thread in all slices
+    std::vector<HashMapsLock> hashMapsLocks;
+    std::atomic<std::chrono::steady_clock::time_point> nextEarlyResults;
+    /// Is held while emitting the early results, which guarantees that the early results of a window are emitted in order.
+    /// Guards the previous early results of the filling windows.
+    std::mutex earlyResultsMutex;
+    std::map<WindowInfo, std::shared_ptr<const PartialAggregate>> previousEarlyResults;
+
+    struct alignas(std::hardware_destructive_interference_size) LateRecords
+    {
+        /// Slices that the records of the current buffer updated, in the order of their first update
+        std::vector<std::shared_ptr<AggregationSlice>> updatedSlices;
+        /// Receives the records of the current buffer that are beyond the allowed lateness
+        std::shared_ptr<AggregationSlice> discardedRecords;
+    };
+
+    /// One entry per worker thread, if the windows accept late records
+    std::vector<LateRecords> lateRecords;
+    std::atomic<uint64_t> numberOfDiscardedLateRecords{0};
+    /// Is held while emitting triggered windows that accept late records. Guards the last emitted snapshot of each of these windows until
+    /// its allowed lateness passed.
+    std::mutex emittedSnapshotsMutex;
+    std::map<WindowInfo, std::shared_ptr<const PartialAggregate>> emittedSnapshots;
+
+private:
+    void takeCheckpoints(const std::stop_token& stopToken);
+    /// Copies the changed pages of one worker thread at a time, so that every worker thread waits for at most one copy
+    void takeCheckpoint();
+
+    /// Empty, if the handler does not take checkpoints
+    std::filesystem::path checkpointDirectory;
+    std::chrono::milliseconds checkpointInterval{0};
+    std::unique_ptr<AggregationStateCheckpoint> checkpoint;
+    /// Is the last member, so that the thread gets joined before any state that it accesses is destroyed
+    Thread checkpointThread;
 };
 
 }
@@ -14,18 +14,48 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <vector>
+#include <Aggregation/AggregationOperatorHandler.hpp>
 #include <Aggregation/Function/AggregationPhysicalFunction.hpp>
+#include <DataTypes/DataType.hpp>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMapRef.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Nautilus/Interface/Record.hpp>
 #include <Nautilus/Interface/RecordBuffer.hpp>
+#include <Time/Timestamp.hpp>
 #include <Runtime/Execution/OperatorHandler.hpp>
 #include <Windowing/WindowMetaData.hpp>
+#include <CompilationContext.hpp>
+#include <ExecutionContext.hpp>
 #include <HashMapOptions.hpp>
 #include <WindowProbePhysicalOperator.hpp>
+#include <val_ptr.hpp>
 
 namespace NES
 {
 
+/// Combines the aggregation states of all keys of the source hash map into the destination hash map.
+/// Keys that do not exist in the destination hash map yet get inserted with a reset aggregation state.
+void combineHashMaps(
+    const nautilus::val<HashMap*>& destinationHashMapPtr,
+    const nautilus::val<HashMap*>& sourceHashMapPtr,
+    const HashMapOptions& hashMapOptions,
+    const std::vector<std::shared_ptr<AggregationPhysicalFunction>>& aggregationPhysicalFunctions,
+    PipelineMemoryProvider& pipelineMemoryProvider);
+
+/// Restricts the records that the probe emits per window to the `limit` keys with the largest (or, if ascending, smallest) values of the
+/// order field, which is either a key or an aggregation of the window
+struct AggregationProbeTopK
+{
+    Record::RecordFieldIdentifier orderFieldName;
+    DataType orderFieldType;
+    bool ascending;
+    uint64_t limit;
+};
+
 class AggregationProbePhysicalOperator final : public WindowProbePhysicalOperator
 {
 public:
@@ -33,12 +63,43 @@ public:
         HashMapOptions hashMapOptions,
         std::vector<std::shared_ptr<AggregationPhysicalFunction>> aggregationPhysicalFunctions,
         OperatorHandlerId operatorHandlerId,
-        WindowMetaData windowMetaData);
+        WindowMetaData windowMetaData,
+        std::optional<AggregationProbeTopK> topK = std::nullopt);
+    void setup(ExecutionContext& executionCtx, CompilationContext& compilationContext) const override;
     void open(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const override;
 
 private:
+    /// Lowers the keys and aggregation states of the entry to the output record of the window
+    Record lowerEntry(
+        const ChainedHashMapRef::ChainedEntryRef& entryRef,
+        const nautilus::val<Timestamp>& windowStart,
+        const nautilus::val<Timestamp>& windowEnd,
+        ExecutionContext& executionCtx) const;
+    void cleanupEntry(const ChainedHashMapRef::ChainedEntryRef& entryRef) const;
+
+    /// Returns true, if the key of the entry does not exist in the previous early result of the window or if any of its aggregation
+    /// results differ from the previous early result. If there is no previous early result, i.e., previousHashMapPtr is nullptr,
+    /// all keys have changed.
+    nautilus::val<bool> hasChangedSincePreviousEarlyResult(
+        const ChainedHashMapRef::ChainedEntryRef& entryRef,
+        const Record& outputRecord,
+        const nautilus::val<HashMap*>& previousHashMapPtr,
+        const nautilus::val<Timestamp>& windowStart,
+        const nautilus::val<Timestamp>& windowEnd,
+        ExecutionContext& executionCtx) const;
+
+    /// Emits the records of the top-k entries of the final hash map, which the probe selects with a bounded heap of k entries
+    void emitTopK(
+        const AggregationProbeTopK& topK,
+        const nautilus::val<EmittedAggregationWindow*>& aggregationWindowRef,
+        const nautilus::val<HashMap*>& finalHashMapPtr,
+        const nautilus::val<Timestamp>& windowStart,
+        const nautilus::val<Timestamp>& windowEnd,
+        ExecutionContext& executionCtx) const;
+
     std::vector<std::shared_ptr<AggregationPhysicalFunction>> aggregationPhysicalFunctions;
     HashMapOptions hashMapOptions;
+    std::optional<AggregationProbeTopK> topK;
 };
 
 }
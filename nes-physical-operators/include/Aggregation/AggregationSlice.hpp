@@ -15,6 +15,7 @@
 #pragma once
 
 #include <cstdint>
+#include <vector>
 #include <Identifiers/Identifiers.hpp>
 #include <Nautilus/Interface/HashMap/HashMap.hpp>
 #include <SliceStore/Slice.hpp>
@@ -25,17 +26,24 @@ namespace NES
 
 /// This class represents a single slice for the (keyed) aggregation. It stores the aggregation state in a hashmap.
 /// If it is a global/non-keyed aggregation, each hashmap contains a single entry for the keyValue = 0.
-/// In our current implementation, we have one hashmap per worker thread.
+/// In our current implementation, we have one hashmap per worker thread and partition (see HashMapSlice), so that the window trigger can
+/// combine each partition independently of the others.
 class AggregationSlice final : public HashMapSlice
 {
 public:
     AggregationSlice(
-        SliceStart sliceStart, SliceEnd sliceEnd, const CreateNewHashMapSliceArgs& createNewHashMapSliceArgs, uint64_t numberOfHashMaps);
+        SliceStart sliceStart,
+        SliceEnd sliceEnd,
+        const CreateNewHashMapSliceArgs& createNewHashMapSliceArgs,
+        uint64_t numberOfHashMaps,
+        uint64_t numberOfPartitions = 1);
 
     /// Returns the pointer to the underlying hashmap.
     /// IMPORTANT: This method should only be used for passing the hashmap to the nautilus executable.
-    [[nodiscard]] HashMap* getHashMapPtr(WorkerThreadId workerThreadId) const;
-    [[nodiscard]] HashMap* getHashMapPtrOrCreate(WorkerThreadId workerThreadId);
+    [[nodiscard]] HashMap* getHashMapPtr(WorkerThreadId workerThreadId, uint64_t partition = 0) const;
+    [[nodiscard]] HashMap* getHashMapPtrOrCreate(WorkerThreadId workerThreadId, uint64_t partition = 0);
+    /// Returns the hash maps of all worker threads for the partition. Hash maps that have not been created yet are nullptr.
+    [[nodiscard]] std::vector<HashMap*> getHashMapPtrsOfPartition(uint64_t partition) const;
 };
 
 }
@@ -0,0 +1,120 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <vector>
+#include <Aggregation/AggregationSlice.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <SliceStore/Slice.hpp>
+#include <Time/Timestamp.hpp>
+
+namespace NES
+{
+
+/// Writes incremental checkpoints of the hash maps of aggregation slices to a directory, so that a restarted query continues its filling
+/// windows from the latest checkpoint instead of losing them. The entries of a chained hash map store their keys and aggregation states in
+/// place, thus a checkpoint consists of copies of the pages of the hash maps.
+///
+/// Each checkpoint writes solely the pages that changed since the previous checkpoint into a new page file. Then, it writes a manifest that
+/// references the latest version of every page of the checkpoint in the page files of this and all previous checkpoints. Replacing the
+/// manifest commits the checkpoint atomically, after which the page files that the manifest does not reference anymore get deleted.
+/// The files store integers in the native byte order, as solely a restart on the same node reads them.
+///
+/// This class is not thread-safe. It gets called by the thread that takes the checkpoints.
+class AggregationStateCheckpoint
+{
+public:
+    /// The query that restores a checkpoint must use the same layout for its hash maps
+    struct Layout
+    {
+        uint64_t entrySize;
+        uint64_t numberOfPartitions;
+
+        bool operator==(const Layout& other) const = default;
+    };
+
+    /// Identifies a page of the hash map at the position hashMapIndex of a slice, c.f., AggregationSlice
+    struct PageKey
+    {
+        SliceStart sliceStart;
+        SliceEnd sliceEnd;
+        uint64_t hashMapIndex;
+        uint64_t pageIndex;
+
+        friend std::strong_ordering operator<=>(const PageKey& lhs, const PageKey& rhs) = default;
+    };
+
+    struct RestoredPage
+    {
+        PageKey key;
+        std::vector<std::byte> entries;
+    };
+
+    struct RestoredState
+    {
+        /// All windows that end before the earliest window end had been triggered, when the checkpoint got taken
+        Timestamp earliestWindowEnd;
+        /// Ordered by their keys, i.e., all pages of a hash map are adjacent
+        std::vector<RestoredPage> pages;
+    };
+
+    AggregationStateCheckpoint(std::filesystem::path directory, Layout layout);
+
+    /// Reads the latest checkpoint in the directory. Returns nullopt, if there is no checkpoint or if its hash maps have another layout.
+    /// The next checkpoint replaces it, regardless of the restored pages.
+    [[nodiscard]] std::optional<RestoredState> restore();
+
+    /// Copies the pages of the hash maps of the worker thread in the slice that changed since the previous checkpoint.
+    /// The caller must hold the lock of the hash maps of the worker thread.
+    void copyChangedPages(const AggregationSlice& slice, WorkerThreadId workerThreadId);
+
+    /// Writes the copied pages and commits the checkpoint, which contains the pages of all slices that have been copied since the
+    /// previous commit. Throws CannotSerialize, if the files cannot be written, in which case the previous checkpoint stays valid.
+    void commit(Timestamp earliestWindowEnd);
+
+    /// Returns the number of bytes of pages that the last commit wrote
+    [[nodiscard]] uint64_t getBytesOfLastCommit() const;
+
+private:
+    struct PageLocation
+    {
+        uint64_t checkpoint; /// The page file of the checkpoint contains the page
+        uint64_t offset;
+        uint64_t size;
+        uint64_t hash; /// Hash of the entries of the page, which tells if the page changed since the checkpoint wrote it
+    };
+
+    [[nodiscard]] std::filesystem::path getPageFilePath(uint64_t checkpoint) const;
+    void writeManifest(const std::map<PageKey, PageLocation>& pages, Timestamp earliestWindowEnd) const;
+    /// Deletes all files in the directory, that the latest manifest does not reference
+    void deleteUnreferencedFiles() const;
+
+    std::filesystem::path directory;
+    Layout layout;
+    uint64_t nextCheckpoint = 0;
+    uint64_t bytesOfLastCommit = 0;
+    std::map<PageKey, PageLocation> committedPages;
+    /// The pages of the next checkpoint. Changed pages refer to the page file of the next checkpoint at their offset in pendingPageData.
+    std::map<PageKey, PageLocation> pendingPages;
+    std::vector<std::byte> pendingPageData;
+};
+
+}
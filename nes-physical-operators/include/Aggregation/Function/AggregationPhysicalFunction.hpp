@@ -18,6 +18,7 @@
 #include <memory>
 #include <DataTypes/DataType.hpp>
 #include <Functions/PhysicalFunction.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
 #include <Nautilus/Interface/Record.hpp>
 #include <Runtime/AbstractBufferProvider.hpp>
 #include <ExecutionContext.hpp>
@@ -69,6 +70,14 @@ public:
     /// Returns the size of the aggregation state in bytes
     [[nodiscard]] virtual size_t getSizeOfStateInBytes() const = 0;
 
+    /// Returns true, if the aggregation state does not point to any other memory. Thus, a copy of the state, e.g., in a checkpoint, is a
+    /// valid state on its own.
+    [[nodiscard]] virtual bool isStateSelfContained() const;
+
+    /// Returns the field, in which lower writes the aggregation result
+    [[nodiscard]] const Record::RecordFieldIdentifier& getResultFieldIdentifier() const;
+    [[nodiscard]] const DataType& getResultType() const;
+
     /// Writes the null value to the first byte of the aggregation state
     static void storeNull(const nautilus::val<AggregationState*>& aggregationState, const nautilus::val<bool>& isNull);
 
@@ -78,6 +87,9 @@ public:
     virtual ~AggregationPhysicalFunction();
 
 protected:
+    /// Adds two values of the input type. Sums of decimals raise an error on an overflow instead of wrapping around.
+    [[nodiscard]] VarVal addInputValues(const VarVal& left, const VarVal& right) const;
+
     DataType inputType;
     DataType resultType;
     const PhysicalFunction inputFunction;
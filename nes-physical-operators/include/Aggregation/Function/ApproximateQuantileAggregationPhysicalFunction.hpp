@@ -0,0 +1,65 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <Aggregation/Function/AggregationPhysicalFunction.hpp>
+#include <Aggregation/Function/QuantileSketches.hpp>
+#include <DataTypes/DataType.hpp>
+#include <Functions/PhysicalFunction.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <val_concepts.hpp>
+
+namespace NES
+{
+
+/// Approximates a quantile with a fixed-size sketch (TDigest or KllSketch) that is stored in place in the aggregation state.
+/// Thus, lifting a value, combining two states, and lowering the quantile neither allocate memory nor depend on the number of values.
+/// As the exact median, the quantile is null, if the window contains a null value.
+template <typename Sketch>
+class ApproximateQuantileAggregationPhysicalFunction : public AggregationPhysicalFunction
+{
+public:
+    ApproximateQuantileAggregationPhysicalFunction(
+        DataType inputType,
+        DataType resultType,
+        PhysicalFunction inputFunction,
+        Record::RecordFieldIdentifier resultFieldIdentifier,
+        double quantile);
+    void lift(
+        const nautilus::val<AggregationState*>& aggregationState,
+        PipelineMemoryProvider& pipelineMemoryProvider,
+        const Record& record) override;
+    void combine(
+        nautilus::val<AggregationState*> aggregationState1,
+        nautilus::val<AggregationState*> aggregationState2,
+        PipelineMemoryProvider& pipelineMemoryProvider) override;
+    Record lower(nautilus::val<AggregationState*> aggregationState, PipelineMemoryProvider& pipelineMemoryProvider) override;
+    void reset(nautilus::val<AggregationState*> aggregationState, PipelineMemoryProvider& pipelineMemoryProvider) override;
+    void cleanup(nautilus::val<AggregationState*> aggregationState) override;
+    [[nodiscard]] size_t getSizeOfStateInBytes() const override;
+    ~ApproximateQuantileAggregationPhysicalFunction() override = default;
+
+private:
+    /// The null flag is padded to keep the sketch aligned
+    [[nodiscard]] nautilus::val<Sketch*> getSketch(const nautilus::val<AggregationState*>& aggregationState) const;
+
+    double quantile;
+};
+
+using TDigestQuantileAggregationPhysicalFunction = ApproximateQuantileAggregationPhysicalFunction<TDigest>;
+using KllQuantileAggregationPhysicalFunction = ApproximateQuantileAggregationPhysicalFunction<KllSketch>;
+
+}
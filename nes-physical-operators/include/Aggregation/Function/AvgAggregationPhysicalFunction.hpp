@@ -19,6 +19,7 @@
 #include <Aggregation/Function/AggregationPhysicalFunction.hpp>
 #include <DataTypes/DataType.hpp>
 #include <Functions/PhysicalFunction.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
 #include <Nautilus/Interface/Record.hpp>
 #include <Runtime/AbstractBufferProvider.hpp>
 #include <val_concepts.hpp>
@@ -50,6 +51,8 @@ public:
     ~AvgAggregationPhysicalFunction() override = default;
 
 private:
+    [[nodiscard]] VarVal average(const VarVal& sum, const VarVal& count) const;
+
     DataType countType{DataType::Type::UINT64, DataType::NULLABLE::NOT_NULLABLE};
     bool includeNullValues;
 };
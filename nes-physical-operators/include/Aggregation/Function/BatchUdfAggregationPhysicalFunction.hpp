@@ -0,0 +1,65 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <Aggregation/Function/AggregationPhysicalFunction.hpp>
+#include <DataTypes/DataType.hpp>
+#include <Functions/BatchUdf.hpp>
+#include <Functions/PhysicalFunction.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <ExecutionContext.hpp>
+#include <val_concepts.hpp>
+
+namespace NES
+{
+
+struct AggregateUdfStateLayout;
+
+/// Aggregates with an AggregateBatchUdf. The aggregation state buffers up to BATCH_CAPACITY non-null input values in front of the state of
+/// the UDF, so that the UDF accumulates whole batches. Combining and lowering a state accumulates its pending values first.
+/// UDF authors register this function for their UdfAggregationLogicalFunction in the AggregationPhysicalFunctionRegistry.
+class BatchUdfAggregationPhysicalFunction : public AggregationPhysicalFunction
+{
+public:
+    static constexpr size_t BATCH_CAPACITY = 64;
+
+    BatchUdfAggregationPhysicalFunction(
+        AggregateBatchUdf udf,
+        DataType inputType,
+        DataType resultType,
+        PhysicalFunction inputFunction,
+        Record::RecordFieldIdentifier resultFieldIdentifier);
+    void lift(
+        const nautilus::val<AggregationState*>& aggregationState,
+        PipelineMemoryProvider& pipelineMemoryProvider,
+        const Record& record) override;
+    void combine(
+        nautilus::val<AggregationState*> aggregationState1,
+        nautilus::val<AggregationState*> aggregationState2,
+        PipelineMemoryProvider& pipelineMemoryProvider) override;
+    Record lower(nautilus::val<AggregationState*> aggregationState, PipelineMemoryProvider& pipelineMemoryProvider) override;
+    void reset(nautilus::val<AggregationState*> aggregationState, PipelineMemoryProvider& pipelineMemoryProvider) override;
+    void cleanup(nautilus::val<AggregationState*> aggregationState) override;
+    [[nodiscard]] size_t getSizeOfStateInBytes() const override;
+    ~BatchUdfAggregationPhysicalFunction() override = default;
+
+private:
+    /// Shared with the traced code, which refers to the layout
+    std::shared_ptr<const AggregateUdfStateLayout> layout;
+};
+
+}
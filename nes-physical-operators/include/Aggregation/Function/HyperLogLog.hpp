@@ -0,0 +1,50 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+namespace NES
+{
+
+/// HyperLogLog sketch by Flajolet et al., "HyperLogLog: the analysis of a near-optimal cardinality estimation algorithm".
+/// Estimates the number of distinct hashes with a fixed-size array of registers. The first PRECISION bits of a hash select a register,
+/// which stores the maximum number of leading zeros (plus one) of the remaining bits.
+/// Two sketches are merged via the register-wise maximum.
+/// With 2^12 registers, the standard error of the estimate is about 1.6%. An empty sketch consists of registers that are all zero.
+class HyperLogLog
+{
+public:
+    static constexpr uint64_t PRECISION = 12;
+    static constexpr uint64_t NUMBER_OF_REGISTERS = uint64_t{1} << PRECISION;
+
+    void add(uint64_t hash);
+    void merge(const HyperLogLog& other);
+    [[nodiscard]] uint64_t estimate() const;
+
+private:
+    /// Helper functions of the estimator by Ertl
+    [[nodiscard]] static double sigma(double x);
+    [[nodiscard]] static double tau(double x);
+
+    std::array<uint8_t, NUMBER_OF_REGISTERS> registers{};
+};
+
+/// The sketch is placed directly into the aggregation state, which is reset via memset
+static_assert(std::is_trivially_copyable_v<HyperLogLog> and sizeof(HyperLogLog) == HyperLogLog::NUMBER_OF_REGISTERS);
+
+}
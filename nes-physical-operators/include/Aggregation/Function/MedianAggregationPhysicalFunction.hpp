@@ -35,7 +35,8 @@ public:
         DataType resultType,
         PhysicalFunction inputFunction,
         Record::RecordFieldIdentifier resultFieldIdentifier,
-        std::shared_ptr<TupleBufferRef> bufferRefPagedVector);
+        std::shared_ptr<TupleBufferRef> bufferRefPagedVector,
+        bool compressPagedVectorPages);
     void lift(
         const nautilus::val<AggregationState*>& aggregationState,
         PipelineMemoryProvider& pipelineMemoryProvider,
@@ -48,10 +49,13 @@ public:
     void reset(nautilus::val<AggregationState*> aggregationState, PipelineMemoryProvider& pipelineMemoryProvider) override;
     void cleanup(nautilus::val<AggregationState*> aggregationState) override;
     [[nodiscard]] size_t getSizeOfStateInBytes() const override;
+    /// The state points to the pages of its PagedVector
+    [[nodiscard]] bool isStateSelfContained() const override;
     ~MedianAggregationPhysicalFunction() override = default;
 
 private:
     std::shared_ptr<TupleBufferRef> bufferRefPagedVector;
+    bool compressPagedVectorPages;
 };
 
 }
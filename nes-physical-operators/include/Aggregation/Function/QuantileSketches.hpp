@@ -0,0 +1,122 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+namespace NES
+{
+
+/// Approximate quantile sketches that are used as the state of the quantile aggregations.
+/// In contrast to the exact median, which stores every value of a window, both sketches have a fixed size that is independent of the
+/// number of aggregated values. Thus, they are allocated in place in the aggregation state and do not own any heap memory.
+/// Both sketches are mergeable, i.e., combining the sketches of two partitions yields a sketch over the union of both partitions.
+
+/// Merging t-digest by Dunning and Ertl, "Computing Extremely Accurate Quantiles Using t-Digests".
+/// The values are clustered into centroids, whose size is bounded by the k1 scale function. Thus, centroids close to the tails are small,
+/// which makes the t-digest very accurate for extreme quantiles, e.g., the 99.9th percentile.
+/// New values are collected in a buffer and merged into the centroids, once the buffer is full.
+class TDigest
+{
+public:
+    /// Controls the trade-off between accuracy and size. The k1 scale function guarantees at most COMPRESSION centroids after merging.
+    static constexpr uint64_t COMPRESSION = 100;
+    static constexpr uint64_t CENTROID_CAPACITY = COMPRESSION + 1;
+    static constexpr uint64_t BUFFER_CAPACITY = 4 * COMPRESSION;
+
+    TDigest() = default;
+
+    void add(double value);
+    void merge(const TDigest& other);
+
+    /// Returns the estimated value at the quantile in [0, 1]. Must not be called on an empty t-digest
+    [[nodiscard]] double quantile(double quantile);
+    [[nodiscard]] double getTotalWeight() const { return totalWeight; }
+
+    [[nodiscard]] bool isEmpty() const { return totalWeight == 0; }
+
+private:
+    struct Centroid
+    {
+        double mean;
+        double weight;
+    };
+
+    /// Merges the buffered values and the given additional centroids into the centroids
+    void compress(const Centroid* additionalCentroids, uint64_t numberOfAdditionalCentroids);
+
+    std::array<Centroid, CENTROID_CAPACITY> centroids{};
+    std::array<double, BUFFER_CAPACITY> buffer{};
+    uint64_t numberOfCentroids = 0;
+    uint64_t numberOfBufferedValues = 0;
+    double totalWeight = 0;
+    double min = 0;
+    double max = 0;
+};
+
+/// KLL sketch by Karnin, Lang, and Liberty, "Optimal Quantile Approximation in Streams".
+/// The sketch consists of a hierarchy of compactors. The items of level l have a weight of 2^l. If a level gets full, it is sorted and
+/// every other item is promoted to the next level. The capacity of the levels decreases geometrically from the top level downwards.
+/// The KLL sketch provides a uniform rank error of about 1.7% for K = 128 across all quantiles.
+/// Similar to the DataSketches implementation, all levels are stored in one array that grows from its end to its beginning, i.e.,
+/// level 0 starts after the free space and the top level ends at the end of the array.
+class KllSketch
+{
+public:
+    static constexpr uint64_t K = 128;
+    static constexpr uint64_t MIN_LEVEL_CAPACITY = 8;
+    /// Allows for more than 2^32 * K items, before the top level overflows
+    static constexpr uint64_t MAX_NUMBER_OF_LEVELS = 32;
+    /// The capacities of all levels sum up to at most 3 * K + MIN_LEVEL_CAPACITY * numberOfLevels
+    static constexpr uint64_t ITEM_CAPACITY = (3 * K) + (MIN_LEVEL_CAPACITY * MAX_NUMBER_OF_LEVELS);
+
+    KllSketch();
+
+    void add(double value);
+    void merge(const KllSketch& other);
+
+    /// Returns the estimated value at the quantile in [0, 1]. Must not be called on an empty sketch
+    [[nodiscard]] double quantile(double quantile) const;
+    [[nodiscard]] uint64_t getNumberOfValues() const { return numberOfValues; }
+
+    [[nodiscard]] bool isEmpty() const { return numberOfValues == 0; }
+
+private:
+    [[nodiscard]] uint64_t getLevelCapacity(uint64_t level) const;
+    [[nodiscard]] uint64_t getLevelSize(uint64_t level) const { return levelStarts[level + 1] - levelStarts[level]; }
+
+    /// Compacts the lowest level that reached its capacity, which frees at least MIN_LEVEL_CAPACITY / 2 items
+    void makeSpace();
+    void compactLevel(uint64_t level);
+    void addLevel();
+    bool flipCoin();
+
+    std::array<double, ITEM_CAPACITY> items{};
+    /// Level l is stored in [levelStarts[l], levelStarts[l + 1]). All levels but level 0 are sorted.
+    std::array<uint64_t, MAX_NUMBER_OF_LEVELS + 1> levelStarts{};
+    uint64_t numberOfLevels = 1;
+    uint64_t numberOfValues = 0;
+    uint64_t randomState = 0x9E3779B97F4A7C15;
+    double min = 0;
+    double max = 0;
+};
+
+/// The sketches are placed directly into the aggregation state and are never destructed
+static_assert(std::is_trivially_copyable_v<TDigest> and std::is_trivially_destructible_v<TDigest>);
+static_assert(std::is_trivially_copyable_v<KllSketch> and std::is_trivially_destructible_v<KllSketch>);
+
+}
@@ -0,0 +1,58 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <Aggregation/Function/AggregationPhysicalFunction.hpp>
+#include <DataTypes/DataType.hpp>
+#include <Functions/PhysicalFunction.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
+#include <val_concepts.hpp>
+
+namespace NES
+{
+
+/// Aggregation that keeps no state of its own, but lowers a part of the state of another aggregation of the same operator, e.g.,
+/// SUM(a) lowers the sum of AVG(a). Thus, lift, combine and reset of the other aggregation update the shared state only once per record.
+/// The aggregation states of an entry are stored one after the other. As this aggregation has an empty state, the state that it gets
+/// passed is followed by the shared state after offsetOfSharedState bytes.
+class SharedStateAggregationPhysicalFunction : public AggregationPhysicalFunction
+{
+public:
+    /// The function must have the same state layout as the shared part of the other state, but it does not own a state on its own
+    SharedStateAggregationPhysicalFunction(
+        std::shared_ptr<AggregationPhysicalFunction> function, DataType inputType, PhysicalFunction inputFunction, size_t offsetOfSharedState);
+    void lift(
+        const nautilus::val<AggregationState*>& aggregationState,
+        PipelineMemoryProvider& pipelineMemoryProvider,
+        const Record& record) override;
+    void combine(
+        nautilus::val<AggregationState*> aggregationState1,
+        nautilus::val<AggregationState*> aggregationState2,
+        PipelineMemoryProvider& pipelineMemoryProvider) override;
+    Record lower(nautilus::val<AggregationState*> aggregationState, PipelineMemoryProvider& pipelineMemoryProvider) override;
+    void reset(nautilus::val<AggregationState*> aggregationState, PipelineMemoryProvider& pipelineMemoryProvider) override;
+    void cleanup(nautilus::val<AggregationState*> aggregationState) override;
+    [[nodiscard]] size_t getSizeOfStateInBytes() const override;
+    ~SharedStateAggregationPhysicalFunction() override = default;
+
+private:
+    std::shared_ptr<AggregationPhysicalFunction> function;
+    size_t offsetOfSharedState;
+};
+
+}
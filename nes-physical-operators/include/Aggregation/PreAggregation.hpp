@@ -0,0 +1,77 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <Aggregation/AggregationSlice.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Time/Timestamp.hpp>
+#include <HashMapSlice.hpp>
+
+namespace NES
+{
+
+/// Pre-aggregates the records of a single worker thread in a small hash map that stays in the cache, before the worker thread combines
+/// them into its hash map of the slice. For skewed keys, the records of a buffer update few keys of the small hash map many times,
+/// instead of probing the large hash map of the slice (and looking up the slice) for every record.
+/// The pre-aggregation covers a single slice at a time. It combines its keys into the slice before it moves on to another slice, once it
+/// holds MAX_NUMBER_OF_KEYS keys, and at the end of every buffer, so that the window trigger of the buffer sees all of its records.
+/// If the records have too few duplicate keys, the pre-aggregation is bypassed for the rest of the buffer.
+class alignas(std::hardware_destructive_interference_size) PreAggregation
+{
+public:
+    static constexpr uint64_t MAX_NUMBER_OF_KEYS = 1024;
+    /// A full pre-aggregation with fewer records per key costs more to combine into the slice than it saves
+    static constexpr uint64_t MIN_NUMBER_OF_RECORDS_PER_KEY = 2;
+
+    /// Combines the aggregation states of all keys of the source hash map into the destination hash map
+    using CombineFunction = std::function<void(HashMap* destination, HashMap* source)>;
+    /// Cleans up the aggregation states of a hash map, c.f., AggregationOperatorHandler::cleanupStateNautilusFunction
+    using CleanupFunction = std::function<void(HashMap*)>;
+
+    /// Returns the hash map for the next record with the timestamp. Returns nullptr, if the timestamp lies outside of the current slice or
+    /// the pre-aggregation is full. Then, the caller has to continue with moveToSlice().
+    [[nodiscard]] HashMap* tryGetHashMap(Timestamp timestamp);
+
+    /// Combines the pre-aggregated keys into the current slice and returns the hash map for the next record of the given slice
+    HashMap* moveToSlice(
+        std::shared_ptr<AggregationSlice> slice,
+        WorkerThreadId workerThreadId,
+        const CreateNewHashMapSliceArgs& createNewHashMapSliceArgs,
+        const CombineFunction& combineFunction,
+        const CleanupFunction& cleanupFunction);
+
+    /// Combines the pre-aggregated keys into the current slice and releases the slice, e.g., at the end of a buffer
+    void combineIntoSlice(const CombineFunction& combineFunction, const CleanupFunction& cleanupFunction);
+
+    [[nodiscard]] bool isBypassed() const;
+
+private:
+    void combineKeys(const CombineFunction& combineFunction, const CleanupFunction& cleanupFunction);
+
+    std::shared_ptr<AggregationSlice> slice;
+    /// The hash map of the worker thread in the slice
+    HashMap* sliceHashMap = nullptr;
+    std::unique_ptr<HashMap> hashMap;
+    /// Number of records that were aggregated into the hash map since the last combine
+    uint64_t numberOfRecords = 0;
+    bool bypassed = false;
+};
+
+}
@@ -0,0 +1,142 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <Aggregation/AggregationSlice.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <SliceStore/Slice.hpp>
+#include <SliceStore/WindowSlicesStoreInterface.hpp>
+#include <Time/Timestamp.hpp>
+
+namespace NES
+{
+
+/// Aggregate of consecutive slices, i.e., one hash map per partition that contains the combined aggregation states of all slices.
+/// Partitions without any key have no hash map. Once created, a partial aggregate is solely read, e.g., by multiple probes concurrently.
+class PartialAggregate
+{
+public:
+    /// Cleans up the aggregation states of a hash map, c.f., AggregationOperatorHandler::cleanupStateNautilusFunction
+    using CleanupFunction = std::function<void(HashMap*)>;
+
+    PartialAggregate(uint64_t numberOfPartitions, CleanupFunction cleanupFunction);
+    ~PartialAggregate();
+
+    PartialAggregate(const PartialAggregate&) = delete;
+    PartialAggregate(PartialAggregate&&) = delete;
+    PartialAggregate& operator=(const PartialAggregate&) = delete;
+    PartialAggregate& operator=(PartialAggregate&&) = delete;
+
+    /// Returns nullptr, if the partition does not contain any key
+    [[nodiscard]] HashMap* getHashMapPtr(uint64_t partition) const;
+    /// Creates the hash map of the partition with the same configuration as the given hash map, if it does not exist yet
+    HashMap* getHashMapPtrOrCreate(uint64_t partition, const HashMap& sameConfigurationAs);
+
+private:
+    std::vector<std::unique_ptr<HashMap>> hashMaps;
+    CleanupFunction cleanupFunction;
+};
+
+/// The partial aggregates that together contain each slice of a window exactly once.
+/// If the window lies within a single block, the suffix is nullptr. Empty partial aggregates are nullptr as well.
+struct WindowPartialAggregates
+{
+    std::shared_ptr<const PartialAggregate> suffix;
+    std::shared_ptr<const PartialAggregate> prefix;
+};
+
+/// Shares the combined slices between overlapping sliding windows. Without sharing, each window combines all of its slices from
+/// scratch, i.e., O(size / slide) slices per window. Instead, we divide the time into blocks of ceil(size / slide) * slide and compute
+/// for each slice of a block the aggregate from the block start up to the slice (prefix) and from the slice up to the block end
+/// (suffix), as proposed by van Herk and Gil & Werman for sliding window maxima.
+/// As windows start at multiples of the slide and are at most as long as a block, every window is either a prefix of a block or the
+/// suffix of one block followed by a prefix of the next block. Thus, the probe combines at most two partial aggregates per window,
+/// whereas building the prefixes and suffixes costs two combines per slice.
+/// In contrast to subtracting the oldest slice from a running aggregate, this works for all aggregation functions, as it solely
+/// requires combining states.
+class SlidingWindowAggregates
+{
+public:
+    /// Combines the aggregation states of all keys of the source hash map into the destination hash map
+    using CombineFunction = std::function<void(HashMap* destination, HashMap* source)>;
+
+    SlidingWindowAggregates(uint64_t windowSize, uint64_t windowSlide, uint64_t numberOfPartitions);
+
+    /// Building the prefixes and suffixes only pays off, if windows consist of enough slides
+    [[nodiscard]] static bool isBeneficial(uint64_t windowSize, uint64_t windowSlide);
+
+    /// Returns the partial aggregates of the window. All slices of the window must be final, i.e., the window must be triggerable.
+    /// We expect the windows in the order of their end and discard the blocks that lie before the current window.
+    /// An older window is still answered correctly, but its partial aggregates get computed again.
+    WindowPartialAggregates getPartialAggregates(
+        const WindowInfo& windowInfo,
+        const std::vector<std::shared_ptr<Slice>>& windowSlices,
+        const CombineFunction& combineFunction,
+        const PartialAggregate::CleanupFunction& cleanupFunction);
+
+    [[nodiscard]] uint64_t getBlockSize() const;
+
+private:
+    struct Block
+    {
+        Block(Timestamp blockStart, Timestamp blockEnd);
+
+        /// Partial aggregates of [blockStart, key) for all slice ends up to prefixEnd
+        std::map<SliceEnd, std::shared_ptr<const PartialAggregate>> prefixes;
+        Timestamp prefixEnd;
+        /// Partial aggregates of [key, blockEnd) for all slice starts from suffixStart onwards
+        std::map<SliceStart, std::shared_ptr<const PartialAggregate>> suffixes;
+        Timestamp suffixStart;
+    };
+
+    Block& getOrCreateBlock(uint64_t blockIndex);
+
+    /// Returns the partial aggregate of all slices of the block before the end, extending the prefixes with the sorted slices if needed
+    std::shared_ptr<const PartialAggregate> getPrefix(
+        Block& block,
+        Timestamp end,
+        const std::vector<std::shared_ptr<AggregationSlice>>& sortedSlices,
+        const CombineFunction& combineFunction,
+        const PartialAggregate::CleanupFunction& cleanupFunction) const;
+
+    /// Returns the partial aggregate of all slices of the block from the start on, extending the suffixes with the sorted slices if needed
+    std::shared_ptr<const PartialAggregate> getSuffix(
+        Block& block,
+        Timestamp start,
+        const std::vector<std::shared_ptr<AggregationSlice>>& sortedSlices,
+        const CombineFunction& combineFunction,
+        const PartialAggregate::CleanupFunction& cleanupFunction) const;
+
+    /// Combines the partial aggregate (if any) and the slice into a new partial aggregate.
+    /// If the slice does not contain any key, we share the given partial aggregate instead of copying it.
+    std::shared_ptr<const PartialAggregate> combine(
+        const std::shared_ptr<const PartialAggregate>& partialAggregate,
+        const AggregationSlice& slice,
+        const CombineFunction& combineFunction,
+        const PartialAggregate::CleanupFunction& cleanupFunction) const;
+
+    uint64_t blockSize;
+    uint64_t numberOfPartitions;
+    std::mutex mutex;
+    std::map<uint64_t, Block> blocks;
+};
+
+}
@@ -0,0 +1,86 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+
+namespace NES
+{
+
+/// Keeps the entries of a window with the k best sort keys in a bounded min-heap, so that the probe of a top-k window never holds more
+/// than k entries, regardless of the number of keys of the window. Entries with a null value are worse than all others.
+class TopKEntries
+{
+public:
+    explicit TopKEntries(uint64_t limit);
+
+    /// Maps a value to a sort key, whose unsigned order matches the order of the value (reversed for an ascending top-k)
+    template <typename T>
+    requires std::integral<T> or std::floating_point<T>
+    static uint64_t toSortKey(T value, bool ascending);
+
+    void offer(AbstractHashMapEntry* entry, uint64_t sortKey, bool isNull);
+
+    /// Sorts the entries from best to worst. Afterward, no more entries can be offered.
+    void sort();
+    [[nodiscard]] uint64_t size() const;
+    [[nodiscard]] AbstractHashMapEntry* getEntry(uint64_t pos) const;
+
+private:
+    struct Candidate
+    {
+        AbstractHashMapEntry* entry;
+        uint64_t sortKey;
+        bool isNull;
+
+        /// Returns true, if this candidate is better than the other one
+        [[nodiscard]] bool isBetterThan(const Candidate& other) const;
+    };
+
+    uint64_t limit;
+    bool sorted = false;
+    /// The front of the heap is the worst of the kept candidates, which the next better candidate replaces
+    std::vector<Candidate> heap;
+};
+
+template <typename T>
+requires std::integral<T> or std::floating_point<T>
+uint64_t TopKEntries::toSortKey(const T value, const bool ascending)
+{
+    constexpr auto signBit = uint64_t{1} << 63;
+    uint64_t sortKey = 0;
+    if constexpr (std::floating_point<T>)
+    {
+        /// Flipping all bits of negative values and the sign bit of positive values orders the bits like the values
+        const auto bits = std::bit_cast<uint64_t>(static_cast<double>(value));
+        sortKey = (bits & signBit) != 0 ? ~bits : bits | signBit;
+    }
+    else if constexpr (std::numeric_limits<T>::is_signed)
+    {
+        sortKey = static_cast<uint64_t>(static_cast<int64_t>(value)) ^ signBit;
+    }
+    else
+    {
+        sortKey = static_cast<uint64_t>(value);
+    }
+    return ascending ? ~sortKey : sortKey;
+}
+
+}
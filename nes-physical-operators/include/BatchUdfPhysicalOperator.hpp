@@ -0,0 +1,67 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <Functions/BatchKernels.hpp>
+#include <Functions/BatchUdfPhysicalFunction.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Nautilus/Interface/RecordBuffer.hpp>
+#include <ExecutionContext.hpp>
+#include <PhysicalOperator.hpp>
+#include <val.hpp>
+
+namespace NES
+{
+
+/// Calls a batch UDF once per batch of records instead of once per record. The operator buffers the records of a tuple buffer until the
+/// batch is full (or the buffer is closed), evaluates the UDF for the whole batch, and passes the buffered records on.
+/// With a result field, the operator maps the result of the UDF to the field. Without a result field, it filters the records for which
+/// the (boolean) UDF holds.
+class BatchUdfPhysicalOperator final : public PhysicalOperatorConcept
+{
+public:
+    static constexpr size_t BATCH_CAPACITY = VECTORIZED_BATCH_SIZE;
+
+    /// The buffered fields must contain all fields of the record that the succeeding operators read. They must not be VARSIZED.
+    BatchUdfPhysicalOperator(
+        BatchUdfPhysicalFunction function,
+        std::optional<Record::RecordFieldIdentifier> resultField,
+        std::vector<std::pair<Record::RecordFieldIdentifier, DataType>> bufferedFields);
+    void open(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const override;
+    void execute(ExecutionContext& executionCtx, Record& record) const override;
+    void close(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const override;
+
+    [[nodiscard]] std::optional<PhysicalOperator> getChild() const override;
+    void setChild(PhysicalOperator child) override;
+
+private:
+    class BatchUdfState;
+
+    void flush(ExecutionContext& executionCtx, BatchUdfState& state) const;
+
+    BatchUdfPhysicalFunction function;
+    std::optional<Record::RecordFieldIdentifier> resultField;
+    std::vector<std::pair<Record::RecordFieldIdentifier, DataType>> bufferedFields;
+    size_t recordSizeInBytes = 0;
+
+    std::optional<PhysicalOperator> child;
+};
+
+}
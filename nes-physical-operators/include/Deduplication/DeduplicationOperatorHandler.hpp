@@ -0,0 +1,99 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+#include <Deduplication/FingerprintSet.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Nautilus/Interface/BloomFilter/BlockedBloomFilter.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
+#include <Runtime/QueryTerminationType.hpp>
+#include <Sequencing/SequenceData.hpp>
+#include <Time/Timestamp.hpp>
+#include <Watermark/MultiOriginWatermarkProcessor.hpp>
+#include <folly/Synchronized.h>
+#include <PipelineExecutionContext.hpp>
+
+namespace NES
+{
+
+/// Remembers the keys that occurred in each tumbling window, so that the deduplication forwards only the first occurrence of a key per
+/// window.
+/// Each window stores the fingerprints of its keys in a FingerprintSet or, if approximate, in a BlockedBloomFilter. A bloom filter takes a
+/// fixed number of bits per expected key, but may mistake a new key for a duplicate.
+/// The keys of a window are discarded once the watermark passes its end. Records of windows that are discarded are late and dropped.
+/// All methods are thread-safe.
+class DeduplicationOperatorHandler final : public OperatorHandler
+{
+public:
+    /// With a bloomFilterBitsPerKey of 0, the deduplication is exact
+    DeduplicationOperatorHandler(
+        const std::vector<OriginId>& inputOrigins,
+        uint64_t windowSizeInMs,
+        uint64_t expectedNumberOfKeysPerWindow,
+        uint64_t bloomFilterBitsPerKey);
+
+    void start(PipelineExecutionContext& pipelineExecutionContext, uint32_t localStateVariableId) override;
+    void stop(QueryTerminationType terminationType, PipelineExecutionContext& pipelineExecutionContext) override;
+
+    /// Inserts the key of the hash into the window of the timestamp and returns true, if the window did not contain the key before
+    [[nodiscard]] bool insertFirstOccurrence(Timestamp timestamp, uint64_t hash);
+
+    /// Updates the watermark of the origin and discards the keys of all windows that end at or before the new global watermark
+    void updateWatermark(Timestamp watermarkTs, SequenceData sequenceData, OriginId originId);
+
+    [[nodiscard]] uint64_t getNumberOfWindows() const;
+
+private:
+    /// The keys of a window are split into shards, so that worker threads insert into different shards concurrently.
+    /// The shard is selected by the bits 32 to 36 of the hash, as the lower bits select the slot of the fingerprint set and the word of the
+    /// bloom filter, while the bits 40 to 63 select the bits within the word of the bloom filter.
+    static constexpr uint64_t FIRST_SHARD_BIT = 32;
+    static constexpr uint64_t NUMBER_OF_SHARDS = 32;
+
+    struct KeyShard
+    {
+        FingerprintSet fingerprints;
+        std::optional<BlockedBloomFilter> bloomFilter;
+
+        bool insert(uint64_t hash);
+    };
+
+    using WindowKeys = std::array<folly::Synchronized<KeyShard, std::mutex>, NUMBER_OF_SHARDS>;
+
+    struct Windows
+    {
+        std::map<Timestamp, std::unique_ptr<WindowKeys>> keysPerWindowStart;
+        /// All windows that end at or before this timestamp are discarded
+        Timestamp discardedUntil{Timestamp::INITIAL_VALUE};
+    };
+
+    [[nodiscard]] std::unique_ptr<WindowKeys> createWindowKeys() const;
+    [[nodiscard]] static bool insert(WindowKeys& windowKeys, uint64_t hash);
+
+    uint64_t windowSizeInMs;
+    uint64_t expectedNumberOfKeysPerShard;
+    uint64_t bloomFilterBitsPerKey;
+    MultiOriginWatermarkProcessor watermarkProcessor;
+    folly::Synchronized<Windows> windows;
+};
+
+}
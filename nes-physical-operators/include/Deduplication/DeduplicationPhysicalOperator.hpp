@@ -0,0 +1,60 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <vector>
+#include <Functions/PhysicalFunction.hpp>
+#include <Nautilus/Interface/Hash/HashFunction.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Nautilus/Interface/RecordBuffer.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
+#include <Watermark/TimeFunction.hpp>
+#include <ExecutionContext.hpp>
+#include <PhysicalOperator.hpp>
+
+namespace NES
+{
+
+/// Forwards each record, whose keys occur for the first time in its tumbling window, right away and drops all other records.
+/// Instead of the records or aggregates of a key, the DeduplicationOperatorHandler only stores the hash of the keys per window.
+class DeduplicationPhysicalOperator final : public PhysicalOperatorConcept
+{
+public:
+    DeduplicationPhysicalOperator(
+        OperatorHandlerId operatorHandlerId,
+        std::unique_ptr<TimeFunction> timeFunction,
+        std::vector<PhysicalFunction> keyFunctions,
+        std::unique_ptr<HashFunction> hashFunction);
+    DeduplicationPhysicalOperator(const DeduplicationPhysicalOperator& other);
+
+    void open(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const override;
+    void execute(ExecutionContext& ctx, Record& record) const override;
+    /// Passes the watermark to the operator handler, which discards the keys of the windows that end before it
+    void close(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const override;
+
+    [[nodiscard]] std::optional<PhysicalOperator> getChild() const override;
+    void setChild(PhysicalOperator child) override;
+
+private:
+    std::optional<PhysicalOperator> child;
+    OperatorHandlerId operatorHandlerId;
+    std::unique_ptr<TimeFunction> timeFunction;
+    std::vector<PhysicalFunction> keyFunctions;
+    std::unique_ptr<HashFunction> hashFunction;
+};
+
+}
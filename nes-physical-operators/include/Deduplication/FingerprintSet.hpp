@@ -0,0 +1,53 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace NES
+{
+
+/// Set of the fingerprints of keys, i.e., their 64 bit hashes, that stores each fingerprint in a single slot of an open addressing table.
+/// Thus, a key takes 8 bytes regardless of its size, but two keys with the same hash are indistinguishable.
+/// The table probes linearly from the slot of the lower bits of the fingerprint and doubles its capacity at a load factor of 1/2.
+/// IMPORTANT: It is not thread-safe.
+class FingerprintSet
+{
+public:
+    /// Creates a set with at least initialCapacity slots, rounded up to a power of two
+    explicit FingerprintSet(uint64_t initialCapacity = DEFAULT_CAPACITY);
+
+    /// Inserts the fingerprint and returns true, if the set did not contain it before
+    bool insert(uint64_t fingerprint);
+    [[nodiscard]] bool contains(uint64_t fingerprint) const;
+    [[nodiscard]] uint64_t size() const;
+    [[nodiscard]] uint64_t capacity() const;
+
+private:
+    static constexpr uint64_t DEFAULT_CAPACITY = 16;
+    /// Marks an empty slot. The fingerprint 0 is stored as 1 instead, which makes both fingerprints equal
+    static constexpr uint64_t EMPTY_SLOT = 0;
+
+    [[nodiscard]] static uint64_t toStoredFingerprint(uint64_t fingerprint);
+    [[nodiscard]] uint64_t findSlot(uint64_t storedFingerprint) const;
+    void grow();
+
+    std::vector<uint64_t> slots;
+    uint64_t mask; /// Mask to calculate the first slot from the fingerprint. Always a (power of 2)-1
+    uint64_t numberOfFingerprints{0};
+};
+
+}
@@ -13,15 +13,25 @@
 */
 
 #pragma once
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <ostream>
+#include <utility>
+#include <vector>
 #include <Identifiers/Identifiers.hpp>
 #include <Identifiers/NESStrongType.hpp>
+#include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
 #include <Runtime/Execution/OperatorHandler.hpp>
 #include <Runtime/QueryTerminationType.hpp>
 #include <Runtime/TupleBuffer.hpp>
+#include <Sequencing/ChunkNumberTracker.hpp>
+#include <Sequencing/NonBlockingMonotonicSeqQueue.hpp>
 #include <Util/Logger/Formatter.hpp>
 #include <folly/Synchronized.h>
 
@@ -46,30 +56,143 @@ struct SequenceNumberForOriginId
     }
 };
 
-/// Container for storing information, related to the state of a sequence number
-/// the SequenceState is only used inside 'folly::Synchronized' so its members do not need to be atomic themselves
-struct SequenceState
+/// Describes how an EmitOperatorHandler coalesces the small buffers of a pipeline (see EmitOperatorHandler::enableCoalescing)
+struct EmitCoalescing
 {
-    ChunkNumber::Underlying nextChunkNumberCounter = ChunkNumber::INITIAL;
-    ChunkNumber lastChunkNumber = INVALID<ChunkNumber>;
-    size_t seenChunks = 0;
+    /// A region of the memory layout that stores a fixed-size part of all records consecutively, i.e., the i-th record of a buffer
+    /// occupies 'recordSize' bytes at 'offset + (i * recordSize)'. The row layout consists of a single region, the columnar layout of
+    /// one region per column.
+    struct Region
+    {
+        uint64_t offset;
+        uint64_t recordSize;
+    };
+
+    /// Derives the regions from the fields of the buffer ref. Returns nullopt, if the buffer ref does not expose its field locations.
+    static std::optional<EmitCoalescing> create(const TupleBufferRef& bufferRef, std::chrono::microseconds latencyBound);
+
+    std::vector<Region> regions;
+    uint64_t capacity = 0;
+    /// Maximum time that the handler holds back the first buffer of a coalesced buffer
+    std::chrono::microseconds latencyBound{0};
+};
+
+/// Describes how an EmitOperatorHandler compacts the variable sized data of buffers that share child buffers with their input (see
+/// EmitOperatorHandler::enableVarSizedCompaction)
+struct VarSizedCompaction
+{
+    /// Derives the variable sized fields from the buffer ref. Returns nullopt, if the buffer ref has no variable sized fields or does not
+    /// expose their locations.
+    static std::optional<VarSizedCompaction> create(const TupleBufferRef& bufferRef, uint64_t minReferencedPercentage);
+
+    std::vector<TupleBufferRef::FieldLocation> fields;
+    /// A buffer copies the values that it references of a child buffer into a new child buffer, if they cover less than this percentage
+    /// of the used bytes of the child buffer
+    uint64_t minReferencedPercentage = 0;
 };
 
 class EmitOperatorHandler final : public OperatorHandler
 {
 public:
+    EmitOperatorHandler() = default;
+    /// If 'emitsInSequenceOrder' is set, the handler re-sequences the buffers that the worker threads emit concurrently (see emitBuffer)
+    explicit EmitOperatorHandler(bool emitsInSequenceOrder);
+    EmitOperatorHandler(const EmitOperatorHandler&) = delete;
+    EmitOperatorHandler(EmitOperatorHandler&&) = delete;
+    EmitOperatorHandler& operator=(const EmitOperatorHandler&) = delete;
+    EmitOperatorHandler& operator=(EmitOperatorHandler&&) = delete;
+    ~EmitOperatorHandler() override;
+
+    /// Assigns a unique chunk number to the buffer and flags the buffer that completes its sequence number as the last chunk.
+    /// Worker threads assign chunk numbers concurrently without locking (see ChunkNumberTracker).
     void setChunkNumber(bool isEndOfIncomingChunk, ChunkNumber incomingChunkNumber, bool isIncomingBufferTheLastChunk, TupleBuffer& buffer);
 
+    /// Coalesces the small buffers of the pipeline, e.g., the output of a selective filter, into fewer full buffers. Implies emitting in
+    /// sequence order, as the coalesced buffers must be renumbered densely per origin. The handler only holds back buffers while the task
+    /// queue holds at least one task per worker thread and further tasks of the pipeline are pending. Otherwise, or once the held back
+    /// buffers reach the latency bound, it emits them right away. Must be called before the pipeline receives its first buffer.
+    void enableCoalescing(EmitCoalescing coalescing);
+
+    /// Compacts the child buffers of the buffers of the pipeline, whose emit references the variable sized data of its input buffers
+    /// (see TupleBufferRef::enableVarSizedSharing). Otherwise, a buffer that references a few short values of a large child buffer would
+    /// keep the whole child buffer alive. Must be called before the pipeline receives its first buffer.
+    void enableVarSizedCompaction(VarSizedCompaction compaction);
+
+    /// Copies the referenced values of each child buffer of the buffer, of which the buffer references too few bytes (see
+    /// VarSizedCompaction), into a new child buffer that replaces it. Does nothing, if the compaction is not enabled.
+    void compactVarSized(PipelineExecutionContext& pipelineExecutionContext, TupleBuffer& buffer) const;
+
+    /// Emits the buffer (with its final chunk number) to the successor pipelines.
+    /// If the handler emits in sequence order, it holds the buffer back until it emitted all chunks of all smaller sequence numbers of
+    /// its origin. Whichever thread completes a sequence number emits the held back buffers that follow it, in the order of (sequence,
+    /// chunk) number. 'endsInput' flags the last buffer that a task emits for its input buffer.
+    void emitBuffer(PipelineExecutionContext& pipelineExecutionContext, const TupleBuffer& buffer, bool endsInput = true);
+
     void start(PipelineExecutionContext& pipelineExecutionContext, uint32_t localStateVariableId) override;
     void stop(QueryTerminationType terminationType, PipelineExecutionContext& pipelineExecutionContext) override;
 
-    folly::Synchronized<std::map<SequenceNumberForOriginId, SequenceState>> sequenceStates;
-
 #ifndef NO_ASSERT
     /// We assume that every tuple of (SequenceNumber, ChunkNumber, OriginId) is unique per query.
     /// In debug mode we track the completed sequence numbers to catch bugs related to bad sequence/chunk numbers
     folly::Synchronized<std::set<SequenceNumberForOriginId>> completedSequences;
 #endif
+
+private:
+    /// State of an origin of a handler that emits in sequence order
+    struct OrderedEmission
+    {
+        /// Buffers that wait for the completion of all prior sequence numbers, ordered by (sequence, chunk) number
+        folly::Synchronized<std::map<std::pair<SequenceNumber::Underlying, ChunkNumber::Underlying>, TupleBuffer>> pendingBuffers;
+        /// Tracks the highest sequence number up to which all sequence numbers (with all of their chunks) were handed to the handler
+        Sequencing::NonBlockingMonotonicSeqQueue<SequenceNumber::Underlying> completedSequenceNumbers;
+        /// Only one thread emits at a time, to preserve the order. Threads that fail to acquire the mutex leave a release request instead
+        /// of waiting, which the emitting thread picks up before it returns.
+        std::mutex emitMutex;
+        std::atomic<uint64_t> releaseRequests{0};
+        /// Requests the emitting thread to emit the coalesced buffer, even if it is not full yet
+        std::atomic<bool> flushRequested{false};
+
+        /// The buffer that the small released buffers are appended to, and the sequence number of the next coalesced buffer. Both are
+        /// guarded by 'emitMutex'.
+        std::optional<TupleBuffer> coalescedBuffer;
+        SequenceNumber::Underlying nextSequenceNumber = SequenceNumber::INITIAL;
+        /// Time at which the first buffer of the coalesced buffer was released, or the epoch if there is no coalesced buffer
+        std::atomic<std::chrono::steady_clock::time_point> coalescedSince{};
+    };
+
+    /// The chunk numbers (and the ordered emission) of a single origin. The handler keeps the origins in a list, to which threads append
+    /// origins without locking. Entries are never removed, as a pipeline receives the buffers of few origins.
+    struct OriginChunkNumbers
+    {
+        OriginChunkNumbers(const OriginId originId, const bool emitsInSequenceOrder)
+            : originId(originId), orderedEmission(emitsInSequenceOrder ? std::make_unique<OrderedEmission>() : nullptr)
+        {
+        }
+
+        const OriginId originId;
+        ChunkNumberTracker<> chunkNumbers;
+        const std::unique_ptr<OrderedEmission> orderedEmission;
+        std::atomic<OriginChunkNumbers*> next = nullptr;
+    };
+
+    OriginChunkNumbers& getOrigin(OriginId originId);
+
+    void emitPendingBuffers(PipelineExecutionContext& pipelineExecutionContext, OrderedEmission& ordered);
+    /// Appends the released buffer to the coalesced buffer of the origin, or emits it right away if it is too large to be coalesced
+    void coalesce(PipelineExecutionContext& pipelineExecutionContext, OrderedEmission& ordered, TupleBuffer buffer) const;
+    void emitCoalescedBuffer(PipelineExecutionContext& pipelineExecutionContext, OrderedEmission& ordered) const;
+    [[nodiscard]] bool holdsBack(const PipelineExecutionContext& pipelineExecutionContext, const OrderedEmission& ordered) const;
+    /// Counts the input buffer as complete. Flushes the coalesced buffers of all origins, if the pipeline has no further pending inputs,
+    /// and the coalesced buffers that exceeded the latency bound otherwise.
+    void completeInput(PipelineExecutionContext& pipelineExecutionContext);
+
+    std::atomic<OriginChunkNumbers*> originChunkNumbers = nullptr;
+    bool emitsInSequenceOrder = false;
+    std::optional<EmitCoalescing> coalescing;
+    std::optional<VarSizedCompaction> varSizedCompaction;
+    /// Number of tasks that completed their input buffer, which the handler compares to the submitted tasks of the pipeline to detect
+    /// that no further input is pending
+    std::atomic<uint64_t> completedInputs{0};
 };
 }
 
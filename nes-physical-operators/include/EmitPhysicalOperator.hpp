@@ -49,6 +49,12 @@ public:
         const nautilus::val<uint64_t>& numRecords,
         const nautilus::val<bool>& potentialLastChunk) const;
 
+    [[nodiscard]] OperatorHandlerId getOperatorHandlerId() const;
+    [[nodiscard]] const TupleBufferRef& getBufferRef() const;
+    /// Lets the emit reference the variable sized data of its input buffers (see TupleBufferRef::enableVarSizedSharing). All copies of
+    /// the operator share the buffer ref, thus this also applies to the operator in its pipeline.
+    void enableVarSizedSharing();
+
     [[nodiscard]] std::optional<PhysicalOperator> getChild() const override;
     void setChild(PhysicalOperator child) override;
 
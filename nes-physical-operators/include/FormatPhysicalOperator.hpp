@@ -0,0 +1,95 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Nautilus/Interface/RecordBuffer.hpp>
+#include <Sinks/SinkDescriptor.hpp>
+#include <nautilus/val.hpp>
+#include <CompilationContext.hpp>
+#include <ExecutionContext.hpp>
+#include <PhysicalOperator.hpp>
+
+namespace NES
+{
+
+/// @brief Emit operator for sinks with the 'compiled_format' option, which formats the records as CSV or JSON rows instead of writing them
+/// to a tuple buffer according to a memory layout. Since the schema is known while tracing, the dispatch on the data type of a field is
+/// specialized away: the compiled code appends each field with the proxy of its type (like the ScanPhysicalOperator reads it).
+/// The operator emits buffers of complete rows, whose number of tuples is the number of bytes (see CompiledFormat). A row that does not
+/// fit into a pooled buffer gets an unpooled buffer of its own. Emitted buffers receive their chunk numbers from an EmitOperatorHandler.
+class FormatPhysicalOperator final : public PhysicalOperatorConcept
+{
+public:
+    /// Literals that surround a value of a field, e.g., the delimiter that precedes it or the JSON key
+    struct FieldFormat
+    {
+        Record::RecordFieldIdentifier name;
+        DataType dataType;
+        std::string prefix;
+        std::string suffix;
+        /// Replaces the prefix, the value and the suffix of a NULL value
+        std::string nullLiteral;
+    };
+
+    struct RowFormat
+    {
+        std::vector<FieldFormat> fields;
+        std::string rowDelimiter;
+    };
+
+    /// The rows that a worker thread formatted during a pipeline invocation, but did not emit yet
+    struct FormattedRows
+    {
+        std::string text;
+        /// End of the rows that fit into a pooled buffer together
+        size_t endOfFittingRows = 0;
+    };
+
+    FormatPhysicalOperator(OperatorHandlerId operatorHandlerId, const Schema& schema, InputFormat format, uint64_t bufferSize);
+
+    void setup(ExecutionContext&, CompilationContext&) const override { /*noop*/ }
+
+    void terminate(ExecutionContext&) const override { /*noop*/ }
+
+    void open(ExecutionContext& ctx, RecordBuffer& recordBuffer) const override;
+    void execute(ExecutionContext& ctx, Record& record) const override;
+    void close(ExecutionContext& ctx, RecordBuffer& recordBuffer) const override;
+
+    [[nodiscard]] std::optional<PhysicalOperator> getChild() const override;
+    void setChild(PhysicalOperator child) override;
+
+private:
+    void appendField(const nautilus::val<FormattedRows*>& rows, const FieldFormat& field, const VarVal& value) const;
+    void emitRows(ExecutionContext& ctx, const nautilus::val<FormattedRows*>& rows, const nautilus::val<bool>& closesChunk) const;
+
+    std::optional<PhysicalOperator> child;
+    /// Shared, since the compiled code refers to the literals of the row format by their address
+    std::shared_ptr<const RowFormat> rowFormat;
+    uint64_t bufferSize;
+    OperatorHandlerId operatorHandlerId;
+};
+
+}
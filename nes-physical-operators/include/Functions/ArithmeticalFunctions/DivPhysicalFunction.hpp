@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <optional>
 #include <Functions/PhysicalFunction.hpp>
 #include <Nautilus/DataTypes/VarVal.hpp>
 #include <Nautilus/Interface/Record.hpp>
@@ -28,11 +29,14 @@ class DivPhysicalFunction final
 {
 public:
     DivPhysicalFunction(PhysicalFunction leftPhysicalFunction, PhysicalFunction rightPhysicalFunction);
+    DivPhysicalFunction(PhysicalFunction leftPhysicalFunction, PhysicalFunction rightPhysicalFunction, PhysicalFunction shiftAmount);
     [[nodiscard]] VarVal execute(const Record& record, ArenaRef& arena) const;
 
 private:
     PhysicalFunction leftPhysicalFunction;
     PhysicalFunction rightPhysicalFunction;
+    /// Divides an unsigned value by a constant power of two by shifting it by this amount
+    std::optional<PhysicalFunction> shiftAmount;
 };
 
 static_assert(PhysicalFunctionConcept<DivPhysicalFunction>);
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <optional>
 #include <Functions/PhysicalFunction.hpp>
 #include <Nautilus/DataTypes/VarVal.hpp>
 #include <Nautilus/Interface/Record.hpp>
@@ -28,11 +29,14 @@ class ModPhysicalFunction
 {
 public:
     ModPhysicalFunction(PhysicalFunction leftPhysicalFunction, PhysicalFunction rightPhysicalFunction);
+    ModPhysicalFunction(PhysicalFunction leftPhysicalFunction, PhysicalFunction rightPhysicalFunction, PhysicalFunction mask);
     VarVal execute(const Record& record, ArenaRef& arena) const;
 
 private:
     PhysicalFunction leftPhysicalFunction;
     PhysicalFunction rightPhysicalFunction;
+    /// Takes an unsigned value modulo a constant power of two by masking it with this mask
+    std::optional<PhysicalFunction> mask;
 };
 
 static_assert(PhysicalFunctionConcept<ModPhysicalFunction>);
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <cstdint>
+#include <optional>
 #include <DataTypes/DataType.hpp>
 #include <Functions/PhysicalFunction.hpp>
 #include <Nautilus/DataTypes/VarVal.hpp>
@@ -27,12 +29,16 @@ class PowPhysicalFunction final
 {
 public:
     explicit PowPhysicalFunction(PhysicalFunction leftPhysicalFunction, PhysicalFunction rightPhysicalFunction, DataType outputType);
+    /// Raises to a constant integer exponent without calling pow, e.g., pow(x, 2) is x * x
+    PowPhysicalFunction(
+        PhysicalFunction leftPhysicalFunction, PhysicalFunction rightPhysicalFunction, DataType outputType, int8_t exponent);
     [[nodiscard]] VarVal execute(const Record& record, ArenaRef& arena) const;
 
 private:
     PhysicalFunction leftPhysicalFunction;
     PhysicalFunction rightPhysicalFunction;
     DataType outputType;
+    std::optional<int8_t> integerExponent;
 };
 
 static_assert(PhysicalFunctionConcept<PowPhysicalFunction>);
@@ -0,0 +1,39 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <optional>
+#include <DataTypes/DataType.hpp>
+#include <Functions/PhysicalFunction.hpp>
+
+/// Helpers to specialize arithmetic functions for constant operands while tracing. Every specialization computes exactly the same values
+/// (and result types) as the generic function.
+namespace NES::StrengthReduction
+{
+
+/// Returns the value of a numeric constant operand, e.g., the exponent of POWER(x, INT32(2))
+std::optional<double> tryGetConstantAsDouble(const PhysicalFunction& function);
+
+/// Returns x * (1 / c), if the divisor is a floating-point constant c that is a power of two, as its reciprocal is exact
+std::optional<PhysicalFunction> tryReplaceDivisionByMultiplication(const PhysicalFunction& dividend, const PhysicalFunction& divisor);
+
+/// Returns the number of bits to shift by as a constant of the dividend's type, if the divisor is a constant power of two of the same
+/// unsigned type as the dividend. Only UINT32 and UINT64 qualify, as smaller types are promoted to int.
+std::optional<PhysicalFunction> tryGetShiftForDivisor(const DataType& dividendType, const PhysicalFunction& divisor);
+
+/// Returns the mask, i.e., the divisor minus one, under the same conditions as tryGetShiftForDivisor
+std::optional<PhysicalFunction> tryGetMaskForDivisor(const DataType& dividendType, const PhysicalFunction& divisor);
+
+}
@@ -0,0 +1,94 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <variant>
+#include <DataTypes/DataType.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <val.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+/// Number of records that are evaluated together in one batch by the vectorized execution mode.
+/// The selection mask and the selection vector of one batch are sized accordingly.
+static constexpr uint64_t VECTORIZED_BATCH_SIZE = 1024;
+
+enum class BatchComparison : uint8_t
+{
+    EQUALS,
+    LESS,
+    LESS_EQUALS,
+    GREATER,
+    GREATER_EQUALS
+};
+
+/// A comparison between a non-nullable numeric field and a constant, i.e., `field <comparison> constant`, that can be evaluated
+/// batch-at-a-time over all values of the field in a buffer. In contrast to the per record PhysicalFunctions, the comparison is
+/// evaluated by precompiled C++ kernels that run over a whole batch without any branches, which allows the host compiler to
+/// auto-vectorize them. Contiguous columns of 32 bit and 64 bit types are evaluated by hand-written AVX2/AVX-512/NEON kernels
+/// (see SimdBatchKernels.hpp).
+/// The constant is widened to int64_t, uint64_t or double. We only create BatchFilters if the field and the constant agree on
+/// signedness, as the widened comparison then yields the same result as the promoted comparison of the PhysicalFunctions.
+struct BatchFilter
+{
+    Record::RecordFieldIdentifier field;
+    DataType::Type fieldType;
+    BatchComparison comparison;
+    std::variant<int64_t, uint64_t, double> constant;
+
+    /// Evaluates the filter for the records [begin, begin + size) and writes one byte (0 or 1) per record into the mask.
+    /// The value of the i-th record is read from `fieldAddress + (i * stride)`, i.e., the stride is the size of the data type for columnar
+    /// layouts and the tuple size for row layouts.
+    /// If isFirstFilter is false, the result is combined with the existing content of the mask via a logical and.
+    void evaluate(
+        const nautilus::val<int8_t*>& fieldAddress,
+        uint64_t stride,
+        const nautilus::val<uint64_t>& begin,
+        const nautilus::val<uint64_t>& size,
+        const nautilus::val<int8_t*>& mask,
+        bool isFirstFilter) const;
+
+    /// Returns true, if we provide a batch kernel for a field of the given type
+    [[nodiscard]] static bool supportsType(DataType::Type type);
+};
+
+/// Returns the comparison with swapped operands, e.g., GREATER for LESS, as `a < b` is the same as `b > a`
+BatchComparison mirrorBatchComparison(BatchComparison comparison);
+
+/// Compares the values of a non-nullable numeric field of `size` records, which are stored one after the other at values, with a key
+/// that is only known at runtime, i.e., `values[i] <comparison> key`, and writes one byte (0 or 1) per record into the mask.
+/// In contrast to a BatchFilter, the traced code calls the kernel with a new key for every invocation, e.g., for every tuple of the outer
+/// side of a nested loop join. The key must be of the same type as the values.
+void evaluateKeyComparison(
+    DataType::Type fieldType,
+    BatchComparison comparison,
+    const nautilus::val<int8_t*>& values,
+    const nautilus::val<uint64_t>& size,
+    const nautilus::val<int8_t*>& mask,
+    const VarVal& key);
+
+/// Converts the mask of a batch into a selection vector, i.e., it writes the record index (begin + i) of all qualifying records as
+/// uint64_t into the selection vector and returns the number of qualifying records.
+nautilus::val<uint64_t> compactSelection(
+    const nautilus::val<int8_t*>& mask,
+    const nautilus::val<uint64_t>& begin,
+    const nautilus::val<uint64_t>& size,
+    const nautilus::val<int8_t*>& selectionVector);
+
+}
@@ -0,0 +1,61 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <DataTypes/DataType.hpp>
+
+namespace NES
+{
+
+/// A column of a batch that the engine passes to a user-defined function. The values are densely packed in the (non-nullable) layout of
+/// the data type, e.g., a DECIMAL column holds int64 values. VARSIZED columns are not supported.
+struct UdfColumn
+{
+    DataType::Type type;
+    std::byte* values;
+    /// One flag per value, or nullptr if the column is not nullable
+    bool* nulls;
+    uint64_t size;
+
+    template <typename T>
+    [[nodiscard]] std::span<T> getValues() const
+    {
+        return {reinterpret_cast<T*>(values), size};
+    }
+
+    [[nodiscard]] std::span<bool> getNulls() const { return nulls == nullptr ? std::span<bool>{} : std::span<bool>{nulls, size}; }
+};
+
+/// A scalar UDF computes the result column for all rows of a batch in a single call. Before the call, the engine sets the null flag of
+/// every result row to whether any argument of the row is null. The UDF may override the flags if the result is nullable.
+using ScalarBatchUdf = void (*)(std::span<const UdfColumn> arguments, const UdfColumn& result);
+
+/// An aggregate UDF keeps its state in stateSize bytes of the aggregation state of the window. The engine buffers the input values and
+/// calls accumulate once per batch of values.
+struct AggregateBatchUdf
+{
+    size_t stateSize;
+    void (*initialize)(std::byte* state);
+    void (*accumulate)(std::byte* state, const UdfColumn& values);
+    /// Merges the second state into the first one
+    void (*combine)(std::byte* state, const std::byte* otherState);
+    /// Writes the result of the aggregation into the single row of the result column
+    void (*finalize)(const std::byte* state, const UdfColumn& result);
+};
+
+}
@@ -0,0 +1,79 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <Functions/BatchUdf.hpp>
+#include <Functions/PhysicalFunction.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Arena.hpp>
+#include <ExecutionContext.hpp>
+#include <val.hpp>
+
+namespace NES
+{
+
+/// The layout of a batch of a scalar UDF. A batch of a given capacity stores one column per argument and the result column, each with
+/// its values followed by one null flag per row.
+struct ScalarUdfBatchLayout
+{
+    ScalarBatchUdf udf;
+    std::vector<DataType> argumentTypes;
+    DataType resultType;
+
+    /// The column after the last argument is the result column
+    [[nodiscard]] size_t getColumnOffset(size_t column, size_t capacity) const;
+    [[nodiscard]] size_t getNullsOffset(size_t column, size_t capacity) const;
+    [[nodiscard]] size_t getValueSize(size_t column) const;
+    [[nodiscard]] size_t getBatchSizeInBytes(size_t capacity) const;
+    /// Calls the UDF once for the first numberOfRows rows of the batch
+    void evaluate(std::byte* batch, uint64_t numberOfRows, uint64_t capacity) const;
+};
+
+/// Evaluates a UDF that computes whole batches. UDF authors register the function for their UDF in the PhysicalFunctionRegistry.
+/// The map and selection operators call the UDF once per batch of records, see BatchUdfPhysicalOperator. Elsewhere, e.g., as the child of
+/// another function, the function evaluates a batch of a single record.
+class BatchUdfPhysicalFunction final
+{
+public:
+    BatchUdfPhysicalFunction(
+        ScalarBatchUdf udf, std::vector<PhysicalFunction> argumentFunctions, std::vector<DataType> argumentTypes, DataType resultType);
+    [[nodiscard]] VarVal execute(const Record& record, ArenaRef& arena) const;
+
+    [[nodiscard]] size_t getBatchSizeInBytes(size_t capacity) const;
+    /// Writes the arguments of the record into the given row of the batch
+    void writeArguments(
+        const Record& record,
+        ArenaRef& arena,
+        const nautilus::val<int8_t*>& batch,
+        const nautilus::val<uint64_t>& row,
+        size_t capacity) const;
+    void evaluate(const nautilus::val<int8_t*>& batch, const nautilus::val<uint64_t>& numberOfRows, size_t capacity) const;
+    [[nodiscard]] VarVal readResult(const nautilus::val<int8_t*>& batch, const nautilus::val<uint64_t>& row, size_t capacity) const;
+
+private:
+    std::vector<PhysicalFunction> argumentFunctions;
+    /// Shared by all copies of the function, as the traced code refers to the layout
+    std::shared_ptr<const ScalarUdfBatchLayout> layout;
+};
+
+static_assert(PhysicalFunctionConcept<BatchUdfPhysicalFunction>);
+
+}
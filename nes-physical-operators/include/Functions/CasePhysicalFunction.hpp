@@ -0,0 +1,56 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <optional>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <Functions/PhysicalFunction.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Arena.hpp>
+#include <ExecutionContext.hpp>
+
+namespace NES
+{
+
+/// Returns the value of the first branch whose condition is true, or else the ELSE value (or null without an ELSE value).
+/// If the branches are branch-free, it evaluates all branches and combines their values with selects, which compile to conditional moves
+/// instead of (mispredicted) jumps. Otherwise, it only evaluates the value of the branch that matches, e.g., if a value may raise an error.
+class CasePhysicalFunction final
+{
+public:
+    CasePhysicalFunction(
+        std::vector<PhysicalFunction> conditions,
+        std::vector<PhysicalFunction> values,
+        std::optional<PhysicalFunction> elseValue,
+        DataType outputType,
+        bool branchFree);
+    [[nodiscard]] VarVal execute(const Record& record, ArenaRef& arena) const;
+
+private:
+    [[nodiscard]] VarVal executeBranchFree(const Record& record, ArenaRef& arena) const;
+    [[nodiscard]] VarVal executeBranched(const Record& record, ArenaRef& arena) const;
+
+    std::vector<PhysicalFunction> conditions;
+    std::vector<PhysicalFunction> values;
+    std::optional<PhysicalFunction> elseValue;
+    DataType outputType;
+    bool branchFree;
+};
+
+static_assert(PhysicalFunctionConcept<CasePhysicalFunction>);
+
+}
@@ -34,6 +34,8 @@ public:
 
     VarVal execute(const Record&, ArenaRef&) const { return VarVal(value); }
 
+    [[nodiscard]] T getValue() const { return value; }
+
 private:
     const T value;
 };
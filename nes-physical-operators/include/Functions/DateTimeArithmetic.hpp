@@ -0,0 +1,103 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+
+/// Calendar arithmetic on milliseconds since the epoch without any branches. The functions are templates, so that they compute plain
+/// integers as well as traced nautilus::val<uint64_t>. As all divisors are constants, the divisions compile to multiplications and shifts.
+/// The arithmetic is unsigned. Thus, callers bias a timestamp by BIAS_IN_MS before they shift it into the local time of a negative utc
+/// offset, so that the local time stays positive.
+namespace NES::DateTimeArithmetic
+{
+
+constexpr uint64_t MS_PER_SECOND = 1000;
+constexpr uint64_t MS_PER_MINUTE = 60 * MS_PER_SECOND;
+constexpr uint64_t MS_PER_HOUR = 60 * MS_PER_MINUTE;
+constexpr uint64_t MS_PER_DAY = 24 * MS_PER_HOUR;
+constexpr uint64_t DAYS_PER_WEEK = 7;
+/// The gregorian calendar repeats itself every 400 years
+constexpr uint64_t DAYS_PER_ERA = 146097;
+
+/// The bias of one era is a multiple of a week as well, i.e., the biased day 0, 1570-01-01, is a thursday like 1970-01-01
+constexpr uint64_t BIAS_IN_DAYS = DAYS_PER_ERA;
+constexpr uint64_t BIAS_IN_MS = BIAS_IN_DAYS * MS_PER_DAY;
+/// The civil date conversions count days from 0000-03-01, so that the leap day is the last day of a (shifted) year
+constexpr uint64_t DAYS_FROM_MARCH_0000_TO_BIASED_EPOCH = 719468 - BIAS_IN_DAYS;
+
+template <typename T>
+struct CivilDate
+{
+    T year;
+    /// From 1 to 12
+    T month;
+    /// From 1 to 31
+    T day;
+};
+
+/// Rounds a biased timestamp down to a multiple of a unit that divides a day, e.g., MS_PER_HOUR
+template <typename T>
+T truncateToMultiple(const T& biasedMs, const uint64_t unitInMs)
+{
+    return biasedMs - (biasedMs % T(unitInMs));
+}
+
+/// The day of the week from sunday (0) to saturday (6)
+template <typename T>
+T dayOfWeek(const T& biasedDays)
+{
+    return (biasedDays + T(4)) % T(DAYS_PER_WEEK);
+}
+
+/// The number of days since the last monday, i.e., 0 for mondays
+template <typename T>
+T daysSinceMonday(const T& biasedDays)
+{
+    return (biasedDays + T(3)) % T(DAYS_PER_WEEK);
+}
+
+/// Converts biased days into a civil date, following civil_from_days of http://howardhinnant.github.io/date_algorithms.html
+template <typename T>
+CivilDate<T> civilFromDays(const T& biasedDays)
+{
+    const T days = biasedDays + T(DAYS_FROM_MARCH_0000_TO_BIASED_EPOCH);
+    const T era = days / T(DAYS_PER_ERA);
+    const T dayOfEra = days - (era * T(DAYS_PER_ERA));
+    const T yearOfEra = (dayOfEra - (dayOfEra / T(1460)) + (dayOfEra / T(36524)) - (dayOfEra / T(146096))) / T(365);
+    const T dayOfShiftedYear = dayOfEra - ((T(365) * yearOfEra) + (yearOfEra / T(4)) - (yearOfEra / T(100)));
+    /// From 0 for march to 11 for february
+    const T shiftedMonth = ((T(5) * dayOfShiftedYear) + T(2)) / T(153);
+    /// January and february belong to the next civil year, i.e., the (integer) division is one for them and zero otherwise
+    const T isJanuaryOrFebruary = shiftedMonth / T(10);
+    return {
+        .year = yearOfEra + (era * T(400)) + isJanuaryOrFebruary,
+        .month = shiftedMonth + T(3) - (T(12) * isJanuaryOrFebruary),
+        .day = dayOfShiftedYear - (((T(153) * shiftedMonth) + T(2)) / T(5)) + T(1)};
+}
+
+/// Returns the biased days of the first of january of a year, which must not be before 1570, following days_from_civil
+template <typename T>
+T daysOfFirstOfJanuary(const T& year)
+{
+    /// The first of january is the 306th day of the shifted year that started in march of the previous year
+    constexpr uint64_t daysFromMarchToJanuary = 306;
+    const T shiftedYear = year - T(1);
+    const T era = shiftedYear / T(400);
+    const T yearOfEra = shiftedYear - (era * T(400));
+    const T dayOfEra = (yearOfEra * T(365)) + (yearOfEra / T(4)) - (yearOfEra / T(100)) + T(daysFromMarchToJanuary);
+    return (era * T(DAYS_PER_ERA)) + dayOfEra - T(DAYS_FROM_MARCH_0000_TO_BIASED_EPOCH);
+}
+
+}
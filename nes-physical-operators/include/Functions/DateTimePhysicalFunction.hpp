@@ -0,0 +1,50 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <Functions/DateTimeLogicalFunction.hpp>
+#include <Functions/PhysicalFunction.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Arena.hpp>
+#include <ExecutionContext.hpp>
+#include <val.hpp>
+
+namespace NES
+{
+
+/// Evaluates DATE_TRUNC or EXTRACT on milliseconds since the epoch with the branch-free arithmetic of DateTimeArithmetic.hpp.
+/// The unit and the utc offset are part of the function, i.e., the traced code only contains the arithmetic of a single unit.
+/// DATE_TRUNC of a timestamp, whose week, month or year in the local time starts before the epoch, wraps around.
+class DateTimePhysicalFunction final
+{
+public:
+    DateTimePhysicalFunction(DateTimeFunctionKind kind, DateTimeUnit unit, int64_t utcOffsetInMs, PhysicalFunction valuePhysicalFunction);
+    [[nodiscard]] VarVal execute(const Record& record, ArenaRef& arena) const;
+
+private:
+    [[nodiscard]] nautilus::val<uint64_t> truncate(const nautilus::val<uint64_t>& biasedLocalMs) const;
+    [[nodiscard]] nautilus::val<uint64_t> extract(const nautilus::val<uint64_t>& biasedLocalMs) const;
+
+    DateTimeFunctionKind kind;
+    DateTimeUnit unit;
+    int64_t utcOffsetInMs;
+    PhysicalFunction valuePhysicalFunction;
+};
+
+static_assert(PhysicalFunctionConcept<DateTimePhysicalFunction>);
+
+}
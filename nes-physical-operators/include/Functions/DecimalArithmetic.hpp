@@ -0,0 +1,54 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+
+/// Overflow-checked arithmetic on the unscaled int64 values of decimals, see DataTypes/Decimal.hpp.
+/// The overflow checks of additions and subtractions are templates, so that they compute plain integers as well as traced
+/// nautilus::val<uint64_t> without branches. Multiplications, divisions and rescaling compute their intermediate results in 128 bit and
+/// round half away from zero. They throw an ArithmeticalError if the result does not fit into an int64.
+namespace NES::DecimalArithmetic
+{
+
+/// Returns one if the wrapping sum of the two's complement integers a and b overflowed, i.e., if the sign of the sum differs from both
+template <typename T>
+T addOverflows(const T& a, const T& b, const T& sum)
+{
+    return ((a ^ sum) & (b ^ sum)) >> T(63);
+}
+
+/// Returns one if the wrapping difference a - b overflowed, i.e., if a and b have different signs and the sign of the difference differs
+/// from the sign of a
+template <typename T>
+T subOverflows(const T& a, const T& b, const T& difference)
+{
+    return ((a ^ b) & (a ^ difference)) >> T(63);
+}
+
+/// Converts the unscaled value of a decimal with the scale 'fromScale' into the unscaled value with the scale 'toScale'
+int64_t rescale(int64_t value, uint8_t fromScale, uint8_t toScale);
+
+/// Returns (a * b) / 10^shift, i.e., the product of two decimals with the scale of the product shifted down by 'shift'
+int64_t multiply(int64_t a, int64_t b, uint8_t shift);
+
+/// Returns (a * 10^shift) / b, i.e., the quotient of two decimals with its scale shifted up by 'shift'
+int64_t divide(int64_t a, int64_t b, uint8_t shift);
+
+int64_t fromUnsigned(uint64_t value, uint8_t scale);
+int64_t fromDouble(double value, uint8_t scale);
+double toDouble(int64_t value, uint8_t scale);
+
+}
@@ -0,0 +1,57 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <Functions/PhysicalFunction.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Arena.hpp>
+#include <ExecutionContext.hpp>
+
+namespace NES
+{
+
+enum class DecimalOperation : uint8_t
+{
+    ADD,
+    SUB,
+    MUL,
+    DIV
+};
+
+/// Computes the overflow-checked arithmetic of two decimals on their unscaled values, see DecimalArithmetic.hpp.
+/// The operands of an addition or subtraction have the scale of the result. A multiplication divides the product of the unscaled values by
+/// 10^shift and a division multiplies the dividend by 10^shift, so that the result has the scale of the result type.
+class DecimalArithmeticPhysicalFunction final
+{
+public:
+    DecimalArithmeticPhysicalFunction(
+        DecimalOperation operation, PhysicalFunction leftPhysicalFunction, PhysicalFunction rightPhysicalFunction, uint8_t shift);
+    [[nodiscard]] VarVal execute(const Record& record, ArenaRef& arena) const;
+
+    /// Computes the operation on two decimal values, e.g., to add up a sum of decimals in an aggregation
+    static VarVal evaluate(DecimalOperation operation, const VarVal& leftValue, const VarVal& rightValue, uint8_t shift);
+
+private:
+    DecimalOperation operation;
+    PhysicalFunction leftPhysicalFunction;
+    PhysicalFunction rightPhysicalFunction;
+    uint8_t shift;
+};
+
+static_assert(PhysicalFunctionConcept<DecimalArithmeticPhysicalFunction>);
+
+}
@@ -0,0 +1,43 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <DataTypes/DataType.hpp>
+#include <Functions/PhysicalFunction.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Arena.hpp>
+#include <ExecutionContext.hpp>
+
+namespace NES
+{
+
+/// Casts a number into a decimal, a decimal into a decimal with a different scale, or a decimal into a number.
+/// Casts round half away from zero and throw an ArithmeticalError if the value does not fit into the target type.
+class DecimalCastPhysicalFunction final
+{
+public:
+    DecimalCastPhysicalFunction(PhysicalFunction childFunction, DataType fromType, DataType toType);
+    [[nodiscard]] VarVal execute(const Record& record, ArenaRef& arena) const;
+
+private:
+    PhysicalFunction childFunction;
+    DataType fromType;
+    DataType toType;
+};
+
+static_assert(PhysicalFunctionConcept<DecimalCastPhysicalFunction>);
+
+}
@@ -30,6 +30,8 @@ public:
 
 private:
     const Record::RecordFieldIdentifier field;
+    /// Resolved once, so that tracing and interpreting the access does not hash the field name
+    const Record::FieldSlot slot;
 };
 
 static_assert(PhysicalFunctionConcept<FieldAccessPhysicalFunction>);
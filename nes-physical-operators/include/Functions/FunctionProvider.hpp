@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <optional>
+#include <Functions/BatchKernels.hpp>
 #include <Functions/ConstantValueLogicalFunction.hpp>
 #include <Functions/LogicalFunction.hpp>
 #include <Functions/PhysicalFunction.hpp>
@@ -27,6 +29,14 @@ public:
     /// NodeFunction a NodeFunctionConstantValue, FieldAccessLogicalFunction or FieldAssignment
     static PhysicalFunction lowerFunction(LogicalFunction logicalFunction);
 
+    /// Lowers a comparison between a field and a constant, e.g., `a < 42` or `42 > a`, to a BatchFilter that is evaluated
+    /// batch-at-a-time in the vectorized execution mode. Returns nullopt, if there is no batch kernel for the function.
+    static std::optional<BatchFilter> lowerBatchFilter(const LogicalFunction& logicalFunction);
+
+    /// Lowers a comparison between two fields of the same non-nullable numeric type, e.g., `a < b`, to the comparison of the first with
+    /// the second field, which the batch kernels evaluate for a runtime key. Returns nullopt, if there is no batch kernel for the function.
+    static std::optional<BatchComparison> lowerBatchComparison(const LogicalFunction& logicalFunction);
+
 private:
     static PhysicalFunction lowerConstantFunction(const ConstantValueLogicalFunction& nodeFunction);
 };
@@ -0,0 +1,49 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <Functions/PhysicalFunction.hpp>
+#include <Functions/RegularExpression.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Arena.hpp>
+#include <ExecutionContext.hpp>
+
+namespace NES
+{
+
+/// Evaluates REGEXP_MATCH on a VARSIZED value, i.e., whether a regular expression matches any substring of the value.
+/// A constant expression is compiled once into a RegularExpression, which the traced code calls directly for every record.
+/// An expression that is not constant is compiled for every record.
+class RegexpMatchPhysicalFunction final
+{
+public:
+    RegexpMatchPhysicalFunction(PhysicalFunction valuePhysicalFunction, std::string_view constantExpression);
+    RegexpMatchPhysicalFunction(PhysicalFunction valuePhysicalFunction, PhysicalFunction expressionPhysicalFunction);
+    [[nodiscard]] VarVal execute(const Record& record, ArenaRef& arena) const;
+
+private:
+    PhysicalFunction valuePhysicalFunction;
+    std::optional<PhysicalFunction> expressionPhysicalFunction;
+    /// Shared by all copies of the function, as the traced code refers to the compiled expression
+    std::shared_ptr<const RegularExpression> constantExpression;
+};
+
+static_assert(PhysicalFunctionConcept<RegexpMatchPhysicalFunction>);
+
+}
@@ -0,0 +1,105 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <Functions/StringSearch.hpp>
+
+namespace NES
+{
+
+/// A regular expression that is compiled once, e.g., per query, and matched against many values in time linear in the size of the value.
+/// The expression matches a value if it matches any substring of the value, like REGEXP_LIKE in most SQL dialects.
+/// Supports literals, `.`, bracket expressions (`[a-z]`, `[^,]`), the classes `\d`, `\w`, `\s` and their negations, groups, alternation,
+/// the quantifiers `*`, `+`, `?`, `{n}`, `{n,}` and `{n,m}`, and the anchors `^` and `$` at the start and end of the expression.
+/// Expressions match bytes, i.e., `.` matches a single byte of a multi-byte UTF-8 character.
+///
+/// The expression is compiled into a Thompson NFA and then into a DFA over classes of equivalent bytes, so that matching performs a single
+/// table lookup per byte. Expressions whose DFA would exceed a size limit are matched by simulating the NFA instead.
+/// A literal that every match contains, e.g., `ERROR` in `ERROR.*timeout`, is searched for before running the automaton, which rejects
+/// most values without running the automaton.
+class RegularExpression
+{
+public:
+    /// Throws InvalidLiteral if the expression is malformed or uses unsupported syntax, e.g., backreferences
+    static RegularExpression compile(std::string_view expression);
+
+    [[nodiscard]] bool matches(std::string_view value) const;
+
+    /// The literal that every match contains, or an empty string if there is none
+    [[nodiscard]] const std::string& getRequiredLiteral() const;
+    [[nodiscard]] bool isCompiledToDfa() const;
+
+private:
+    /// The syntax tree of the expression and its parser, which are only used during compilation
+    struct Node;
+    class Parser;
+
+    /// A state of the NFA either consumes a byte of a byte class, branches to two states without consuming a byte, or accepts
+    struct NfaState
+    {
+        enum class Kind : uint8_t
+        {
+            BYTES,
+            SPLIT,
+            MATCH
+        };
+
+        Kind kind;
+        uint32_t next = 0;
+        uint32_t alternative = 0;
+        /// The byte class that a BYTES state consumes
+        std::array<bool, 256> bytes{};
+    };
+
+    static constexpr uint32_t MAX_DFA_STATES = 4096;
+    /// A state stops the DFA, if its result does not depend on the remaining bytes
+    static constexpr uint8_t ACCEPTS = 1;
+    static constexpr uint8_t STOPS = 2;
+
+    RegularExpression() = default;
+
+    [[nodiscard]] bool matchesWithDfa(std::string_view value) const;
+    [[nodiscard]] bool matchesWithNfa(std::string_view value) const;
+    /// Adds the state and all states that it reaches without consuming a byte to the set, unless they are in the set
+    void addWithClosure(std::vector<uint32_t>& states, std::vector<bool>& contained, uint32_t state) const;
+    /// Returns false, if the DFA exceeds the size limit
+    bool buildDfa();
+
+    bool anchoredAtStart = false;
+    bool anchoredAtEnd = false;
+    std::vector<NfaState> nfa;
+    uint32_t nfaStart = 0;
+
+    /// The DFA has numberOfByteClasses transitions per state, starting at state index * numberOfByteClasses
+    std::array<uint8_t, 256> byteClasses{};
+    size_t numberOfByteClasses = 0;
+    std::vector<uint32_t> dfaTransitions;
+    std::vector<uint8_t> dfaFlags;
+    bool compiledToDfa = false;
+
+    std::string requiredLiteral;
+    std::optional<SubstringSearcher> requiredLiteralSearcher;
+    /// Expressions that consist of a single literal, e.g., `^GET `, are matched without the automaton
+    bool isLiteral = false;
+};
+
+}
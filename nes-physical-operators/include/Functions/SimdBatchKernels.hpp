@@ -0,0 +1,76 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <Functions/BatchKernels.hpp>
+
+namespace NES
+{
+
+/// Instruction sets for which we provide hand-written batch comparison kernels
+enum class SimdInstructionSet : uint8_t
+{
+    NONE,
+    NEON,
+    AVX2,
+    AVX512
+};
+
+/// Returns the most capable instruction set that the cpu supports. The instruction set is detected once at runtime. Thus, binaries that
+/// are compiled for a generic x86-64 target still use the AVX2/AVX-512 kernels on cpus that support them.
+SimdInstructionSet getSimdInstructionSet();
+
+/// Signature of all batch comparison kernels. The value of the i-th record is read from `fieldAddress + (i * stride)`.
+template <typename C>
+using BatchComparisonKernel = void (*)(int8_t* fieldAddress, uint64_t stride, uint64_t begin, uint64_t size, int8_t* mask, C constant);
+
+/// Returns a SIMD kernel that compares a contiguous column of T, i.e., stride == sizeof(T), with a constant.
+/// Returns nullptr, if there is no SIMD kernel for T or the cpu does not support any of our instruction sets.
+/// The kernel compares in the domain of T, thus the caller has to ensure that the constant is exactly representable as T.
+template <typename T, typename C>
+BatchComparisonKernel<C> getSimdComparisonKernel(BatchComparison comparison, bool isFirstFilter);
+
+template <BatchComparison Comparison, typename T>
+constexpr bool evaluateComparison(const T left, const T right)
+{
+    if constexpr (Comparison == BatchComparison::EQUALS)
+    {
+        return left == right;
+    }
+    else if constexpr (Comparison == BatchComparison::LESS)
+    {
+        return left < right;
+    }
+    else if constexpr (Comparison == BatchComparison::LESS_EQUALS)
+    {
+        return left <= right;
+    }
+    else if constexpr (Comparison == BatchComparison::GREATER)
+    {
+        return left > right;
+    }
+    else if constexpr (Comparison == BatchComparison::GREATER_EQUALS)
+    {
+        return left >= right;
+    }
+    else
+    {
+        std::unreachable();
+    }
+}
+
+}
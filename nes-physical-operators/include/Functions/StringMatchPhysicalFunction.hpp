@@ -0,0 +1,55 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <Functions/PhysicalFunction.hpp>
+#include <Functions/StringMatchLogicalFunction.hpp>
+#include <Functions/StringSearch.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/DataTypes/VariableSizedData.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Arena.hpp>
+#include <ExecutionContext.hpp>
+
+namespace NES
+{
+
+/// Evaluates LIKE, STARTS_WITH, ENDS_WITH and CONTAINS on a VARSIZED value.
+/// A constant pattern is compiled once into a LikePattern. During tracing, equality, prefix and suffix patterns become inlined
+/// comparisons with the literal, while all other patterns call the compiled pattern, e.g., its SIMD substring search.
+/// A pattern that is not constant is compiled for every record.
+class StringMatchPhysicalFunction final
+{
+public:
+    StringMatchPhysicalFunction(StringMatchKind kind, PhysicalFunction valuePhysicalFunction, std::string_view constantPattern);
+    StringMatchPhysicalFunction(StringMatchKind kind, PhysicalFunction valuePhysicalFunction, PhysicalFunction patternPhysicalFunction);
+    [[nodiscard]] VarVal execute(const Record& record, ArenaRef& arena) const;
+
+private:
+    [[nodiscard]] nautilus::val<bool> matchConstantPattern(const VariableSizedData& value) const;
+
+    StringMatchKind kind;
+    PhysicalFunction valuePhysicalFunction;
+    std::optional<PhysicalFunction> patternPhysicalFunction;
+    /// Shared by all copies of the function, as the traced code refers to the compiled pattern and its literal
+    std::shared_ptr<const LikePattern> constantPattern;
+};
+
+static_assert(PhysicalFunctionConcept<StringMatchPhysicalFunction>);
+
+}
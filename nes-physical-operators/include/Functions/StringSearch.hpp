@@ -0,0 +1,94 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <Functions/StringMatchLogicalFunction.hpp>
+
+namespace NES
+{
+
+/// Finds a needle in haystacks, like memmem. The searcher compares the first and the last byte of the needle at 16 positions of the
+/// haystack at once (SSE2 or NEON) and only compares the remaining bytes of the needle where both match, which rejects most positions
+/// of natural text with a single vector comparison.
+class SubstringSearcher
+{
+public:
+    explicit SubstringSearcher(std::string needle);
+
+    /// Returns the position of the first occurrence of the needle starting at or after `from`, or std::string_view::npos
+    [[nodiscard]] size_t find(std::string_view haystack, size_t from = 0) const;
+
+private:
+    std::string needle;
+};
+
+/// A LIKE pattern that is compiled once, e.g., during tracing, and matched against many values.
+/// The pattern consists of segments that are separated by `%`. A segment matches a sequence of bytes of the same length, in which its
+/// `_` match any byte. Segments without `_` are found with a SubstringSearcher.
+class LikePattern
+{
+public:
+    /// The trivial shapes of a pattern, which the caller can evaluate without the pattern
+    enum class Shape : uint8_t
+    {
+        /// The pattern matches values that are equal to, start with, end with or contain the literal
+        EQUALS,
+        STARTS_WITH,
+        ENDS_WITH,
+        CONTAINS,
+        GENERAL
+    };
+
+    /// Compiles a LIKE pattern, in which `%` matches any sequence of bytes, `_` matches a single byte and `\` escapes the next byte
+    static LikePattern compile(std::string_view pattern);
+    /// Compiles the pattern of a string predicate. All but LIKE match the pattern literally.
+    static LikePattern compile(StringMatchKind kind, std::string_view pattern);
+
+    [[nodiscard]] bool matches(std::string_view value) const;
+
+    [[nodiscard]] Shape getShape() const;
+    /// The literal of all but the GENERAL shape
+    [[nodiscard]] const std::string& getLiteral() const;
+
+private:
+    struct Segment
+    {
+        [[nodiscard]] bool matchesAt(std::string_view value, size_t position) const;
+        [[nodiscard]] size_t find(std::string_view value, size_t from) const;
+
+        std::string bytes;
+        /// The positions of `_`, if any
+        std::vector<bool> isWildcard;
+        /// Only segments without wildcards have a searcher
+        std::optional<SubstringSearcher> searcher;
+    };
+
+    LikePattern(std::vector<Segment> segments, bool anchoredAtStart, bool anchoredAtEnd);
+
+    std::vector<Segment> segments;
+    /// A pattern is anchored at the start (end), if it does not start (end) with `%`
+    bool anchoredAtStart;
+    bool anchoredAtEnd;
+    Shape shape;
+    std::string literal;
+};
+
+}
@@ -0,0 +1,64 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include <DataTypes/Schema.hpp>
+#include <val.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+/// Describes where the values of a fixed-size field are stored in the row layout and in the columnar layout (see ColumnarLayout) of a
+/// schema. In the row layout, the null byte of a nullable field precedes its value. In the columnar layout, the column has a validity
+/// bitmap instead.
+struct TransposedField
+{
+    uint64_t valueSize;
+    /// Offset of the field in a tuple of the row layout, i.e., of its null byte if the field is nullable
+    uint64_t rowOffset;
+    uint64_t columnOffset;
+    std::optional<uint64_t> validityOffset;
+};
+
+/// Returns the fields of the schema in a row layout and in a columnar layout of the given buffer size.
+/// Returns nullopt, if a field is variable sized, as its values reference the child buffers of their buffer and can not be copied as is.
+std::optional<std::vector<TransposedField>> getTransposedFields(const Schema& schema, uint64_t columnarBufferSize);
+
+/// Copies the tuples [begin, begin + size) of a buffer in the row layout into a buffer in the columnar layout, which then starts with
+/// these tuples. In contrast to reading and writing record by record, the transposition runs field by field over all tuples in
+/// precompiled kernels. 32 bit and 64 bit values are gathered by AVX2 kernels if the cpu supports them.
+void transposeRowsToColumns(
+    const std::vector<TransposedField>& fields,
+    uint64_t rowTupleSize,
+    const nautilus::val<int8_t*>& rows,
+    const nautilus::val<uint64_t>& begin,
+    const nautilus::val<uint64_t>& size,
+    const nautilus::val<int8_t*>& columns);
+
+/// Copies the tuples [begin, begin + size) of a buffer in the columnar layout into a buffer in the row layout, which then starts with
+/// these tuples
+void transposeColumnsToRows(
+    const std::vector<TransposedField>& fields,
+    uint64_t rowTupleSize,
+    const nautilus::val<int8_t*>& columns,
+    const nautilus::val<uint64_t>& begin,
+    const nautilus::val<uint64_t>& size,
+    const nautilus::val<int8_t*>& rows);
+
+}
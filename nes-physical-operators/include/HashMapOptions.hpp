@@ -14,17 +14,28 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <ranges>
 #include <utility>
 #include <vector>
+#include <DataTypes/DataType.hpp>
 #include <Functions/PhysicalFunction.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/Hash/DirectHashFunction.hpp>
 #include <Nautilus/Interface/Hash/HashFunction.hpp>
+#include <Nautilus/Interface/Hash/MurMur3HashFunction.hpp>
+#include <Nautilus/Interface/Hash/XXH3HashFunction.hpp>
 #include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedEntryMemoryProvider.hpp>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMapRef.hpp>
 #include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Nautilus/Interface/HashMap/SwissHashMap/SwissHashMapRef.hpp>
+#include <Util/HashFunctionType.hpp>
+#include <Util/HashMapType.hpp>
 #include <ErrorHandling.hpp>
+#include <val_ptr.hpp>
 
 namespace NES
 {
@@ -42,7 +53,8 @@ struct HashMapOptions
         const uint64_t keySize,
         const uint64_t valueSize,
         const uint64_t pageSize,
-        const uint64_t numberOfBuckets)
+        const uint64_t numberOfBuckets,
+        const HashMapType hashMapType)
         : hashFunction(std::move(hashFunction))
         , keyFunctions(std::move(keyFunctions))
         , fieldKeys(std::move(fieldKeys))
@@ -53,6 +65,7 @@ struct HashMapOptions
         , valueSize(valueSize)
         , pageSize(pageSize)
         , numberOfBuckets(numberOfBuckets)
+        , hashMapType(hashMapType)
     {
         INVARIANT(entriesPerPage > 0, "The number of entries per page must be greater than 0");
         INVARIANT(entrySize > 0, "The entry size must be greater than 0");
@@ -77,6 +90,7 @@ struct HashMapOptions
         , valueSize(std::move(other.valueSize))
         , pageSize(std::move(other.pageSize))
         , numberOfBuckets(std::move(other.numberOfBuckets))
+        , hashMapType(other.hashMapType)
     {
     }
 
@@ -91,6 +105,7 @@ struct HashMapOptions
         , valueSize(other.valueSize)
         , pageSize(other.pageSize)
         , numberOfBuckets(other.numberOfBuckets)
+        , hashMapType(other.hashMapType)
     {
     }
 
@@ -106,6 +121,7 @@ struct HashMapOptions
         valueSize = std::move(other.valueSize);
         pageSize = std::move(other.pageSize);
         numberOfBuckets = std::move(other.numberOfBuckets);
+        hashMapType = other.hashMapType;
         return *this;
     };
 
@@ -121,11 +137,57 @@ struct HashMapOptions
         valueSize = other.valueSize;
         pageSize = other.pageSize;
         numberOfBuckets = other.numberOfBuckets;
+        hashMapType = other.hashMapType;
         return *this;
     }
 
     ~HashMapOptions() = default;
 
+    /// Creates the hash function for keys of the given data types. AUTO chooses the perfect DirectHashFunction for a single key of one
+    /// byte and XXH3 if all keys have a fixed size. Otherwise, it chooses MurMur3, which reads the hashes that dictionaries cache for
+    /// interned variable sized values instead of hashing their bytes.
+    /// AUTO does not choose the DirectHashFunction for wider keys, as keys that only differ in their upper bits, e.g., multiples of 1024,
+    /// share a bucket. DIRECT opts in for keys whose values are known to come from a small, dense range.
+    static std::unique_ptr<HashFunction> createHashFunction(const HashFunctionType hashFunctionType, const std::vector<DataType>& keyTypes)
+    {
+        const bool hasVariableSizedKey
+            = std::ranges::any_of(keyTypes, [](const DataType& keyType) { return keyType.isType(DataType::Type::VARSIZED); });
+        switch (hashFunctionType)
+        {
+            case HashFunctionType::AUTO: {
+                if (keyTypes.size() == 1 and not hasVariableSizedKey
+                    and keyTypes.front().getSizeInBytesWithoutNull() == 1)
+                {
+                    return std::make_unique<DirectHashFunction>();
+                }
+                return createHashFunction(hasVariableSizedKey ? HashFunctionType::MURMUR3 : HashFunctionType::XXH3, keyTypes);
+            }
+            case HashFunctionType::DIRECT:
+                if (hasVariableSizedKey)
+                {
+                    return std::make_unique<MurMur3HashFunction>();
+                }
+                return std::make_unique<DirectHashFunction>();
+            case HashFunctionType::MURMUR3:
+                return std::make_unique<MurMur3HashFunction>();
+            case HashFunctionType::XXH3:
+                return std::make_unique<XXH3HashFunction>();
+        }
+        std::unreachable();
+    }
+
+    /// Returns the partition of the keys (see HashMapSlice). The hash maps use the lower bits of the hash to find the bucket. Thus, the
+    /// partition is derived from the upper bits, as otherwise all keys of a partition would end up in a fraction of the buckets.
+    [[nodiscard]] nautilus::val<uint64_t> getPartition(const std::vector<VarVal>& keyValues, const uint64_t numberOfPartitions) const
+    {
+        if (numberOfPartitions <= 1)
+        {
+            return nautilus::val<uint64_t>{0};
+        }
+        const auto hash = hashFunction->calculate(keyValues);
+        return (hash >> nautilus::val<uint64_t>{32}) % nautilus::val<uint64_t>{numberOfPartitions};
+    }
+
     /// Method that gets called, once a hash map based slice gets destroyed.
     template <typename NautilusCleanupExecFunc>
     std::function<void(const std::vector<std::unique_ptr<HashMap>>&)>
@@ -142,6 +204,25 @@ struct HashMapOptions
         };
     }
 
+    /// Creates the nautilus wrapper of the hash map type and passes it to the function, e.g., [&](auto& hashMapRef) { ... }.
+    /// As the hash map type is known during the tracing, the generated code solely contains the operations of the chosen hash map.
+    template <typename Function>
+    decltype(auto) visitHashMapRef(const nautilus::val<HashMap*>& hashMapRef, Function&& function) const
+    {
+        switch (hashMapType)
+        {
+            case HashMapType::CHAINED: {
+                ChainedHashMapRef chainedHashMapRef{hashMapRef, fieldKeys, fieldValues, entriesPerPage, entrySize};
+                return std::forward<Function>(function)(chainedHashMapRef);
+            }
+            case HashMapType::SWISS: {
+                SwissHashMapRef swissHashMapRef{hashMapRef, fieldKeys, fieldValues, entriesPerPage, entrySize};
+                return std::forward<Function>(function)(swissHashMapRef);
+            }
+        }
+        std::unreachable();
+    }
+
     /// It is fine that these are not nautilus types, because they are only used in the tracing and not in the actual execution
     std::unique_ptr<HashFunction> hashFunction;
     std::vector<PhysicalFunction> keyFunctions;
@@ -153,6 +234,7 @@ struct HashMapOptions
     uint64_t valueSize;
     uint64_t pageSize;
     uint64_t numberOfBuckets;
+    HashMapType hashMapType;
 };
 
 }
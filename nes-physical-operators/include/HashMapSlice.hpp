@@ -21,13 +21,38 @@
 #include <utility>
 #include <vector>
 #include <Identifiers/Identifiers.hpp>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMap.hpp>
 #include <Nautilus/Interface/HashMap/HashMap.hpp>
 #include <SliceStore/Slice.hpp>
+#include <Util/HashMapType.hpp>
+#include <Util/RollingAverage.hpp>
+#include <folly/Synchronized.h>
 #include <Engine.hpp>
 
 namespace NES
 {
 
+/// Keeps the chained hash maps of destroyed slices, so that the hash maps of new slices reuse their chains instead of allocating them
+/// again, e.g., as a window operator creates and garbage collects a slice per slide. The pages of the entries are not kept, as the buffer
+/// provider already pools them.
+class HashMapPool
+{
+public:
+    static constexpr uint64_t DEFAULT_MAX_NUMBER_OF_HASH_MAPS = 256;
+
+    explicit HashMapPool(uint64_t maxNumberOfHashMaps = DEFAULT_MAX_NUMBER_OF_HASH_MAPS);
+
+    /// Returns an empty chained hash map with the entry size and the number of chains or a nullptr, if the pool has no such hash map
+    [[nodiscard]] std::unique_ptr<ChainedHashMap> acquire(uint64_t entrySize, uint64_t numberOfChains);
+    /// Resets and keeps a chained hash map, if the pool is not full. All other hash maps get destroyed.
+    void release(std::unique_ptr<HashMap> hashMap);
+    [[nodiscard]] uint64_t getNumberOfHashMaps() const;
+
+private:
+    uint64_t maxNumberOfHashMaps;
+    folly::Synchronized<std::vector<std::unique_ptr<ChainedHashMap>>> hashMaps;
+};
+
 struct CreateNewHashMapSliceArgs final : CreateNewSlicesArguments
 {
     using NautilusCleanupExec = nautilus::engine::CallableFunction<void, HashMap*>;
@@ -37,12 +62,14 @@ struct CreateNewHashMapSliceArgs final : CreateNewSlicesArguments
         const uint64_t keySize,
         const uint64_t valueSize,
         const uint64_t pageSize,
-        const uint64_t numberOfBuckets)
+        const uint64_t numberOfBuckets,
+        const HashMapType hashMapType)
         : nautilusCleanup(std::move(nautilusCleanup))
         , keySize(keySize)
         , valueSize(valueSize)
         , pageSize(pageSize)
         , numberOfBuckets(numberOfBuckets)
+        , hashMapType(hashMapType)
     {
     }
 
@@ -52,14 +79,41 @@ struct CreateNewHashMapSliceArgs final : CreateNewSlicesArguments
     uint64_t valueSize;
     uint64_t pageSize;
     uint64_t numberOfBuckets;
+    /// Number of buckets of the hash maps of each input stream, e.g., as the build sides of a join have a different number of keys.
+    /// If empty, the hash maps of all input streams have numberOfBuckets.
+    std::vector<uint64_t> numberOfBucketsPerInputStream;
+    HashMapType hashMapType;
+    /// If set, the slice adds the growth statistics of all of its hash maps, once the slice gets destroyed
+    std::shared_ptr<folly::Synchronized<HashMapGrowthStatistics>> growthStatistics;
+    /// If set, the slice releases its hash maps to the pool, once the slice gets destroyed, and new hash maps are taken from the pool
+    std::shared_ptr<HashMapPool> hashMapPool;
+
+    [[nodiscard]] uint64_t getNumberOfBuckets(uint64_t inputStream) const;
 };
 
+/// Creates a new empty hash map of the type and with the configuration of the arguments or takes a matching one from the hash map pool
+std::unique_ptr<HashMap> createHashMap(const CreateNewHashMapSliceArgs& createNewHashMapSliceArgs);
+std::unique_ptr<HashMap> createHashMap(const CreateNewHashMapSliceArgs& createNewHashMapSliceArgs, uint64_t numberOfBuckets);
+
+/// Sizes the hash maps of new slices after the number of keys of the hash maps of recent slices, so that the hash maps of the next
+/// window neither have long chains nor over-allocated buckets. Until we observed a slice, we keep the configured number of buckets.
+uint64_t getNumberOfBucketsOfObservedKeys(
+    const RollingAverage<uint64_t>& observedNumberOfKeys, uint64_t configuredNumberOfBuckets, uint64_t maxNumberOfBuckets);
+
+/// Logs how much the hash maps of the destroyed slices of a window operator had to grow, if they grew at all. Frequent resizes hint at a
+/// max_number_of_buckets that is too small for the keys of a window.
+void logHashMapGrowthStatistics(const HashMapGrowthStatistics& growthStatistics, OriginId outputOriginId);
+
 /// A HashMapSlice stores a number of hashmaps per input stream. We assume that each input stream has the same number of hashmaps
 /// We store first all hashmaps of each stream followed by the hashmaps of the next stream, c.f.,
 /// +---------------------+---------------------+---------------------+---------------------+---------------------+
 /// | Stream 1: [HashMap1][HashMap2][HashMap3]... | Stream 2: [HashMap1][HashMap2][HashMap3]... | ... | Stream N: [HashMap1][HashMap2][HashMap3]... |
 /// +---------------------+---------------------+---------------------+---------------------+---------------------+
 ///
+/// Within a stream, each worker thread has one hashmap per partition. The partition of a key is derived from its hash (see
+/// HashMapOptions::getPartition), so that the hashmaps of a partition can be combined independently of the other partitions:
+/// | Worker 0: [Partition 0][Partition 1]... | Worker 1: [Partition 0][Partition 1]... | ...
+///
 /// As the hashmap might need to clean up its state, we expect multiple clean up functions as part of the @struct CreateNewHashMapSliceArgs
 /// For each stream, we expect one cleanup function and once this HashMapSlice gets destroyed they are being called.
 class HashMapSlice : public Slice
@@ -69,21 +123,37 @@ public:
         SliceStart sliceStart,
         SliceEnd sliceEnd,
         const CreateNewHashMapSliceArgs& createNewHashMapSliceArgs,
-        uint64_t numberOfHashMaps,
-        uint64_t numberOfInputStreams);
+        uint64_t numberOfWorkerThreads,
+        uint64_t numberOfInputStreams,
+        uint64_t numberOfPartitions = 1);
 
     ~HashMapSlice() override;
 
-    /// In our current implementation, we expect one hashmap per worker thread. Thus, we return the number of hashmaps == number of worker threads.
+    /// Returns the number of hashmaps of all input streams, worker threads, and partitions
     [[nodiscard]] uint64_t getNumberOfHashMaps() const;
 
     [[nodiscard]] uint64_t getNumberOfTuples() const;
+    [[nodiscard]] uint64_t getNumberOfPartitions() const;
 
 protected:
+    /// Creates a new empty hash map of the type and with the configuration of the createNewHashMapSliceArgs
+    [[nodiscard]] std::unique_ptr<HashMap> createHashMap() const;
+    [[nodiscard]] std::unique_ptr<HashMap> createHashMap(uint64_t inputStream) const;
+
+    /// Returns the position of the hashmap of the worker thread for the partition of the input stream. Worker threads whose ids exceed
+    /// the number of worker threads of the slice share the hashmaps of the smaller ids.
+    [[nodiscard]] uint64_t getHashMapPos(WorkerThreadId workerThreadId, uint64_t inputStream, uint64_t partition) const;
+    /// Returns the hash maps of all worker threads for the partition of the input stream. Hash maps that have not been created yet are
+    /// nullptr.
+    [[nodiscard]] std::vector<HashMap*> getHashMapPtrsOfPartition(uint64_t inputStream, uint64_t partition) const;
+    [[nodiscard]] uint64_t getNumberOfWorkerThreads() const;
+
     std::vector<std::unique_ptr<HashMap>> hashMaps;
     CreateNewHashMapSliceArgs createNewHashMapSliceArgs;
+    /// The number of worker threads times the number of partitions
     uint64_t numberOfHashMapsPerInputStream;
     uint64_t numberOfInputStreams;
+    uint64_t numberOfPartitions;
 };
 
 }
@@ -13,13 +13,16 @@
 */
 
 #pragma once
+#include <cstdint>
 #include <memory>
 #include <Identifiers/Identifiers.hpp>
 #include <Join/HashJoin/HJOperatorHandler.hpp>
+#include <Join/HashJoin/HJSlice.hpp>
 #include <Join/StreamJoinBuildPhysicalOperator.hpp>
 #include <Join/StreamJoinUtil.hpp>
 #include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
 #include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Nautilus/Interface/PagedVector/PagedVector.hpp>
 #include <Nautilus/Interface/Record.hpp>
 #include <Runtime/Execution/OperatorHandler.hpp>
 #include <Time/Timestamp.hpp>
@@ -27,40 +30,64 @@
 #include <CompilationContext.hpp>
 #include <ExecutionContext.hpp>
 #include <HashMapOptions.hpp>
+#include <HashMapSlice.hpp>
 
 namespace NES
 {
 class HJBuildPhysicalOperator;
-HashMap* getHashJoinHashMapProxy(
+HJSlice* getHashJoinSliceProxy(
     const HJOperatorHandler* operatorHandler,
     Timestamp timestamp,
     WorkerThreadId workerThreadId,
-    JoinBuildSideType buildSide,
     const HJBuildPhysicalOperator* buildOperator);
+HashMap* getHashJoinHashMapProxy(HJSlice* hjSlice, WorkerThreadId workerThreadId, JoinBuildSideType buildSide, uint64_t partition);
+PagedVector* getHashJoinRowsProxy(HJSlice* hjSlice, WorkerThreadId workerThreadId, JoinBuildSideType buildSide, uint64_t partition);
+void insertIntoLeftBloomFilterProxy(HJSlice* hjSlice, uint64_t hash);
+
+/// Compiles the function that destroys the paged vectors of all entries of a hash map of a hash join, once its slice gets destroyed.
+/// With late materialization, the entries own no paged vectors, as the slice owns the rows of the hash map.
+std::shared_ptr<CreateNewHashMapSliceArgs::NautilusCleanupExec> compileHashJoinCleanupFunction(
+    CompilationContext& compilationContext, const HashMapOptions& hashMapOptions, bool lateMaterialization = false);
 
 /// This class is the first phase of the join. For both streams (left and right), the tuples are stored in a hash map of a
 /// corresponding slice one after the other. Afterward, the second phase (HJProbe) will start joining the tuples by comparing the join keys
 /// via a hash function.
+/// For a radix-partitioned hash join, the tuples are scattered by the hash of their keys into one hash map per partition and worker thread.
+/// Thus, each hash map contains only the keys of one partition and stays small enough to be cache-resident.
+/// The left side additionally inserts the hash of each new key into the bloom filter of its slice, if the slice has one.
+/// With late materialization, i.e., if a rowBufferRef is given, the entries of the hash maps do not store the tuples of their key in a
+/// paged vector of their own. Instead, the tuples are appended to the rows of the hash map and each entry references its latest row
+/// (see HJRowChain).
+/// For the streamed side of an asymmetric hash join, the build creates no hash map. Instead, it appends the tuples to the rows of its
+/// worker thread, which the probe streams through the hash maps of the hashed side.
 class HJBuildPhysicalOperator : public StreamJoinBuildPhysicalOperator
 {
 public:
-    friend HashMap* getHashJoinHashMapProxy(
+    friend HJSlice* getHashJoinSliceProxy(
         const HJOperatorHandler* operatorHandler,
         Timestamp timestamp,
         WorkerThreadId workerThreadId,
-        JoinBuildSideType buildSide,
         const HJBuildPhysicalOperator* buildOperator);
     HJBuildPhysicalOperator(
         OperatorHandlerId operatorHandlerId,
         JoinBuildSideType joinBuildSide,
         std::unique_ptr<TimeFunction> timeFunction,
         const std::shared_ptr<TupleBufferRef>& bufferRef,
-        HashMapOptions hashMapOptions);
+        HashMapOptions hashMapOptions,
+        uint64_t numberOfPartitions = 0,
+        std::shared_ptr<TupleBufferRef> rowBufferRef = nullptr,
+        bool isStreamedSide = false);
     void setup(ExecutionContext& executionCtx, CompilationContext& compilationContext) const override;
     void execute(ExecutionContext& ctx, Record& record) const override;
 
 private:
     HashMapOptions hashMapOptions;
+    /// Number of radix partitions of the hash join. 0, if the hash join is not partitioned.
+    uint64_t numberOfPartitions;
+    /// Layout of the rows of a hash join with late materialization, i.e., the tuples and the HJ_PREVIOUS_ROW_FIELD. nullptr otherwise.
+    std::shared_ptr<TupleBufferRef> rowBufferRef;
+    /// True, if this is the streamed side of an asymmetric hash join
+    bool isStreamedSide;
 };
 
 }
@@ -17,38 +17,61 @@
 #include <bit>
 #include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 #include <Identifiers/Identifiers.hpp>
 #include <Join/StreamJoinOperatorHandler.hpp>
 #include <Join/StreamJoinUtil.hpp>
+#include <Nautilus/Interface/BloomFilter/BlockedBloomFilter.hpp>
 #include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Nautilus/Interface/PagedVector/PagedVector.hpp>
 #include <Runtime/Execution/OperatorHandler.hpp>
+#include <Runtime/QueryTerminationType.hpp>
 #include <Sequencing/SequenceData.hpp>
 #include <SliceStore/Slice.hpp>
 #include <SliceStore/WindowSlicesStoreInterface.hpp>
 #include <Util/RollingAverage.hpp>
+#include <folly/Synchronized.h>
 #include <HashMapSlice.hpp>
+#include <PipelineExecutionContext.hpp>
 
 namespace NES
 {
 
 /// This task models the information for a hash join based window trigger
+/// For an asymmetric hash join, the hash maps of the streamed side are empty and the trigger stores the rows of the streamed side instead.
 struct EmittedHJWindowTrigger
 {
     EmittedHJWindowTrigger(
-        const WindowInfo windowInfo, const std::vector<HashMap*>& leftHashMaps, const std::vector<HashMap*>& rightHashMaps)
-        : windowInfo(windowInfo), leftNumberOfHashMaps(leftHashMaps.size()), rightNumberOfHashMaps(rightHashMaps.size())
+        const WindowInfo windowInfo,
+        const std::vector<HashMap*>& leftHashMaps,
+        const std::vector<HashMap*>& rightHashMaps,
+        BlockedBloomFilter* leftBloomFilter = nullptr,
+        std::unique_ptr<HashMap> mergedLeftHashMap = nullptr,
+        const std::vector<PagedVector*>& streamedRows = {})
+        : windowInfo(windowInfo)
+        , leftNumberOfHashMaps(leftHashMaps.size())
+        , rightNumberOfHashMaps(rightHashMaps.size())
+        , numberOfStreamedRows(streamedRows.size())
+        , leftBloomFilter(leftBloomFilter)
+        , mergedLeftHashMapPtr(mergedLeftHashMap.get())
+        , mergedLeftHashMap(std::move(mergedLeftHashMap))
     {
-        /// Copying the left and right hashmap pointer pointers after this object, hence this + 1
+        /// Copying the left and right hashmap pointer pointers and the pointers to the streamed rows after this object, hence this + 1
         const auto leftHashMapPtrSizeInByte = leftHashMaps.size() * sizeof(HashMap*);
+        const auto rightHashMapPtrSizeInByte = rightHashMaps.size() * sizeof(HashMap*);
         auto* addressFirstLeftHashMapPtr = std::bit_cast<int8_t*>(this + 1);
         auto* addressFirstRightHashMapPtr = std::bit_cast<int8_t*>(this + 1) + leftHashMapPtrSizeInByte;
+        auto* addressFirstStreamedRowsPtr = addressFirstRightHashMapPtr + rightHashMapPtrSizeInByte;
         this->leftHashMaps = std::bit_cast<HashMap**>(addressFirstLeftHashMapPtr);
         this->rightHashMaps = std::bit_cast<HashMap**>(addressFirstRightHashMapPtr);
+        this->streamedRows = std::bit_cast<PagedVector**>(addressFirstStreamedRowsPtr);
         std::ranges::copy(leftHashMaps, std::bit_cast<HashMap**>(addressFirstLeftHashMapPtr));
         std::ranges::copy(rightHashMaps, std::bit_cast<HashMap**>(addressFirstRightHashMapPtr));
+        std::ranges::copy(streamedRows, std::bit_cast<PagedVector**>(addressFirstStreamedRowsPtr));
     }
 
     WindowInfo windowInfo;
@@ -57,6 +80,13 @@ struct EmittedHJWindowTrigger
     HashMap** leftHashMaps; /// Pointer to the stored pointers of all hash maps of the left input stream that the probe should iterate over
     HashMap**
         rightHashMaps; /// Pointer to the stored pointers of all hash maps of the right input stream that the probe should iterate over
+    uint64_t numberOfStreamedRows;
+    PagedVector** streamedRows; /// Pointer to the stored pointers of all rows of the streamed side of an asymmetric hash join
+    /// Bloom filter over the keys of the left slice, so that the probe can skip the lookups of right keys without a join partner
+    BlockedBloomFilter* leftBloomFilter;
+    HashMap* mergedLeftHashMapPtr;
+    /// Empty hash map for a radix-partitioned hash join, into which the probe merges all left hash maps before probing the right entries
+    std::unique_ptr<HashMap> mergedLeftHashMap;
 };
 
 class HJOperatorHandler final : public StreamJoinOperatorHandler
@@ -66,11 +96,25 @@ public:
         const std::vector<OriginId>& inputOrigins,
         OriginId outputOriginId,
         std::unique_ptr<WindowSlicesStoreInterface> sliceAndWindowStore,
-        uint64_t maxNumberOfBuckets);
+        uint64_t maxNumberOfBuckets,
+        uint64_t numberOfPartitions = 0,
+        uint64_t bloomFilterBitsPerKey = 0,
+        bool lateMaterialization = false,
+        std::optional<JoinBuildSideType> streamedSide = std::nullopt);
+
+    /// Logs the statistics of the hash maps of the destroyed slices and of the bloom filters
+    void stop(QueryTerminationType queryTerminationType, PipelineExecutionContext& pipelineExecutionContext) override;
 
     [[nodiscard]] std::function<std::vector<std::shared_ptr<Slice>>(SliceStart, SliceEnd)>
     getCreateNewSlicesFunction(const CreateNewSlicesArguments& newSlicesArguments) const override;
 
+    /// Returns how much the hash maps of all destroyed slices had to grow, as they received more keys than expected
+    [[nodiscard]] HashMapGrowthStatistics getHashMapGrowthStatistics() const;
+
+    /// Returns how many lookups of right keys the bloom filters of the left slices avoided and how many they failed to avoid
+    [[nodiscard]] BloomFilterStatistics getBloomFilterStatistics() const;
+    void addBloomFilterStatistics(const BloomFilterStatistics& statistics);
+
     bool wasSetupCalled(const JoinBuildSideType& buildSide);
     void setNautilusCleanupExec(
         std::shared_ptr<CreateNewHashMapSliceArgs::NautilusCleanupExec> nautilusCleanupExec, const JoinBuildSideType& buildSide);
@@ -85,6 +129,17 @@ private:
     std::shared_ptr<CreateNewHashMapSliceArgs::NautilusCleanupExec> rightCleanupStateNautilusFunction;
 
 
+    /// A partition is skewed, if it received more than this factor times the average number of records per partition of the slices
+    static constexpr uint64_t SKEWED_PARTITION_FACTOR = 2;
+
+    /// For a radix-partitioned hash join, we emit one probe task per partition and combination of slices. The probe task of a skewed
+    /// partition, e.g., due to a hot key, would take much longer than the others. Thus, we split it into multiple probe tasks, each of
+    /// which probes all left hash maps of the partition with a subset of its right hash maps.
+    /// Otherwise, we emit one probe task per combination of slices.
+    void triggerSlices(
+        const std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>>& slicesAndWindowInfo,
+        PipelineExecutionContext* pipelineCtx) override;
+
     void emitSlicesToProbe(
         Slice& sliceLeft,
         Slice& sliceRight,
@@ -92,8 +147,42 @@ private:
         const SequenceData& sequenceData,
         PipelineExecutionContext* pipelineCtx) override;
 
-    folly::Synchronized<RollingAverage<uint64_t>> rollingAverageNumberOfKeys;
+    /// Returns the hash maps of the partition of the slice that contain tuples
+    [[nodiscard]] std::vector<HashMap*> getHashMapsOfPartition(const Slice& slice, const JoinBuildSideType& buildSide, uint64_t partition);
+
+    /// Returns the rows of the streamed side of the slice that contain tuples
+    [[nodiscard]] std::vector<PagedVector*> getStreamedRows(const Slice& slice) const;
+
+    /// Emits the hash maps of the partition of the left and right slice to the probe
+    void emitPartitionToProbe(
+        const Slice& sliceLeft,
+        const Slice& sliceRight,
+        uint64_t partition,
+        const std::vector<HashMap*>& leftHashMaps,
+        const std::vector<HashMap*>& rightHashMaps,
+        const WindowInfo& windowInfo,
+        const SequenceData& sequenceData,
+        PipelineExecutionContext* pipelineCtx,
+        const std::vector<PagedVector*>& streamedRows = {});
+
+    /// The build sides have different keys, thus, we size the hash maps of each side after the same side of recent slices
+    folly::Synchronized<RollingAverage<uint64_t>> rollingAverageNumberOfLeftKeys;
+    folly::Synchronized<RollingAverage<uint64_t>> rollingAverageNumberOfRightKeys;
     uint64_t maxNumberOfBuckets;
+    /// Number of radix partitions of the hash join. 0, if the hash join is not partitioned.
+    uint64_t numberOfPartitions;
+    /// Size of the bloom filter over the left keys of each slice. 0, if the slices have no bloom filter.
+    uint64_t bloomFilterBitsPerKey;
+    /// With late materialization, the probe does not merge the left hash maps of a partition (see HJProbePhysicalOperator)
+    bool lateMaterialization;
+    /// Side of an asymmetric hash join, whose tuples are not hashed but streamed through the hash maps of the other side. nullopt, if
+    /// both sides are hashed.
+    std::optional<JoinBuildSideType> streamedSide;
+    folly::Synchronized<BloomFilterStatistics> bloomFilterStatistics;
+    /// shared_ptr as the slices add the statistics of their hash maps, once they get destroyed
+    std::shared_ptr<folly::Synchronized<HashMapGrowthStatistics>> hashMapGrowthStatistics;
+    /// shared_ptr as the slices release their hash maps to the pool, once they get destroyed
+    std::shared_ptr<HashMapPool> hashMapPool;
 };
 
 }
@@ -14,21 +14,38 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <Functions/PhysicalFunction.hpp>
+#include <Join/HashJoin/HJOperatorHandler.hpp>
 #include <Join/StreamJoinProbePhysicalOperator.hpp>
 #include <Join/StreamJoinUtil.hpp>
+#include <Nautilus/Interface/BloomFilter/BlockedBloomFilter.hpp>
+#include <Nautilus/Interface/Hash/HashFunction.hpp>
 #include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
+#include <Nautilus/Interface/Record.hpp>
 #include <Nautilus/Interface/RecordBuffer.hpp>
 #include <Runtime/Execution/OperatorHandler.hpp>
+#include <Time/Timestamp.hpp>
 #include <Windowing/WindowMetaData.hpp>
 #include <ExecutionContext.hpp>
 #include <HashMapOptions.hpp>
+#include <val.hpp>
+#include <val_ptr.hpp>
 
 namespace NES
 {
 
 /// Performs the second phase of the join. The tuples are joined via probing the previously built hash tables
+/// For a radix-partitioned hash join, each probe task joins one partition. It first merges the left hash maps of all worker threads into
+/// one hash map and then probes it once per right entry. Thus, the cost of a probe task does not depend on the number of worker threads.
+/// Before looking up a right entry, the probe checks the bloom filter over the keys of the left slice, if the slice has one.
+/// With late materialization, the buffer refs describe the rows of the hash maps (see HJRowChain) and the probe reads the rows of a key
+/// only once it found a join partner. As the entries can not be merged without their paged vectors, the probe of a radix-partitioned
+/// hash join then probes the left hash maps of all worker threads pairwise as well.
+/// For an asymmetric hash join, only one side has hash maps. The probe streams the rows of the other side through these hash maps and
+/// joins every streamed tuple with the tuples of its key.
 class HJProbePhysicalOperator final : public StreamJoinProbePhysicalOperator
 {
 public:
@@ -40,15 +57,71 @@ public:
         std::shared_ptr<TupleBufferRef> leftBufferRef,
         std::shared_ptr<TupleBufferRef> rightBufferRef,
         HashMapOptions leftHashMapBasedOptions,
-        HashMapOptions rightHashMapBasedOptions);
+        HashMapOptions rightHashMapBasedOptions,
+        uint64_t numberOfPartitions = 0,
+        bool lateMaterialization = false,
+        std::optional<JoinBuildSideType> streamedSide = std::nullopt);
 
     /// As the second phase gets triggered by the first phase, we receive a tuple buffer containing all information for performing the probe.
     /// Thus, we start a new pipeline and therefore, we create new Records from the built-up state.
     void open(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const override;
 
 private:
+    /// Merges all left hash maps of the emitted partition and probes the merged hash map with the entries of all right hash maps
+    void probeMergedLeftHashMap(
+        ExecutionContext& executionCtx,
+        const nautilus::val<EmittedHJWindowTrigger*>& hashJoinWindowRef,
+        const nautilus::val<Timestamp>& windowStart,
+        const nautilus::val<Timestamp>& windowEnd) const;
+
+    /// Looks up the keys of every streamed tuple in all hash maps of the hashed side of an asymmetric hash join
+    void probeStreamedRows(
+        ExecutionContext& executionCtx,
+        const nautilus::val<EmittedHJWindowTrigger*>& hashJoinWindowRef,
+        const nautilus::val<Timestamp>& windowStart,
+        const nautilus::val<Timestamp>& windowEnd) const;
+
+    /// Joins the streamed record with all records of the paged vector of the hashed side, i.e., all records with the same key
+    void joinStreamedRecord(
+        ExecutionContext& executionCtx,
+        const Record& streamedRecord,
+        const nautilus::val<int8_t*>& hashedPagedVectorMem,
+        const nautilus::val<Timestamp>& windowStart,
+        const nautilus::val<Timestamp>& windowEnd) const;
+
+    /// Returns false, if the bloom filter proves that the key of the hash has no join partner. Without a bloom filter, all keys pass.
+    [[nodiscard]] static nautilus::val<bool>
+    passesBloomFilter(const nautilus::val<BlockedBloomFilter*>& bloomFilterPtr, const HashFunction::HashValue& hash);
+
+    /// Adds the number of right keys that the bloom filter rejected or falsely passed to the statistics of the operator handler
+    void addBloomFilterStatistics(
+        ExecutionContext& executionCtx,
+        const nautilus::val<uint64_t>& numberOfRejectedKeys,
+        const nautilus::val<uint64_t>& numberOfFalsePositives) const;
+
+    /// Joins all records of the left paged vector with all records of the right paged vector, i.e., all records with the same key
+    void joinPagedVectors(
+        ExecutionContext& executionCtx,
+        const nautilus::val<int8_t*>& leftPagedVectorMem,
+        const nautilus::val<int8_t*>& rightPagedVectorMem,
+        const nautilus::val<Timestamp>& windowStart,
+        const nautilus::val<Timestamp>& windowEnd) const;
+
+    /// Joins all rows of the left chain with all rows of the right chain, i.e., all records with the same key (see HJRowChain)
+    void joinRowChains(
+        ExecutionContext& executionCtx,
+        const nautilus::val<int8_t*>& leftRowChainMem,
+        const nautilus::val<int8_t*>& rightRowChainMem,
+        const nautilus::val<Timestamp>& windowStart,
+        const nautilus::val<Timestamp>& windowEnd) const;
+
     std::shared_ptr<TupleBufferRef> leftBufferRef, rightBufferRef;
     HashMapOptions leftHashMapOptions, rightHashMapOptions;
+    /// Number of radix partitions of the hash join. 0, if the hash join is not partitioned.
+    uint64_t numberOfPartitions;
+    bool lateMaterialization;
+    /// Side of an asymmetric hash join that has no hash maps. nullopt, if both sides are hashed.
+    std::optional<JoinBuildSideType> streamedSide;
 };
 
 }
@@ -14,26 +14,89 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
 #include <Identifiers/Identifiers.hpp>
 #include <Join/StreamJoinUtil.hpp>
+#include <Nautilus/Interface/BloomFilter/BlockedBloomFilter.hpp>
 #include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Nautilus/Interface/PagedVector/PagedVector.hpp>
 #include <SliceStore/Slice.hpp>
 #include <HashMapSlice.hpp>
 
 namespace NES
 {
 
+/// Value of a hash map entry of a hash join with late materialization. The tuples of all keys of a hash map are stored densely in the
+/// rows of the hash map. Each row stores the position + 1 of the previous row of its key in the field HJ_PREVIOUS_ROW_FIELD, 0 ends the
+/// chain. Thus, a key occupies no page of its own and the probe only reads the rows of keys that have a join partner.
+struct HJRowChain
+{
+    PagedVector* rows;
+    /// Position + 1 of the latest row of the key
+    uint64_t lastRow;
+};
+inline const std::string HJ_PREVIOUS_ROW_FIELD = "HJ$previousRow";
+
 /// As a hash join has left and right side, we need to handle the left and right side of the join with one slice
 /// Thus, we use a HashMapSlice and set the number of input streams to 2 in its constructor
+/// For a radix-partitioned hash join, each worker thread has one hash map per partition and side (see HashMapSlice).
+/// Additionally, a slice can store a bloom filter over the keys of its left side. As the probe looks up the keys of the right side in the
+/// left hash maps, the bloom filter allows the probe to skip the lookups of right keys that have no join partner.
+/// As a hash map stores one entry per key, its number of tuples does not reveal hot keys. Thus, the slice counts the records that each
+/// worker thread builds into each of its hash maps, which allows to detect partitions that received a large share of the records.
+/// For an asymmetric hash join, only one side builds hash maps. Each worker thread appends the tuples of the other, i.e., streamed, side
+/// to its rows, which the probe streams through the hash maps of the hashed side.
 class HJSlice final : public HashMapSlice
 {
 public:
     HJSlice(
-        SliceStart sliceStart, SliceEnd sliceEnd, const CreateNewHashMapSliceArgs& createNewHashMapSliceArgs, uint64_t numberOfHashMaps);
-    [[nodiscard]] HashMap* getHashMapPtr(WorkerThreadId workerThreadId, const JoinBuildSideType& buildSide) const;
-    [[nodiscard]] HashMap* getHashMapPtrOrCreate(WorkerThreadId workerThreadId, const JoinBuildSideType& buildSide);
+        SliceStart sliceStart,
+        SliceEnd sliceEnd,
+        const CreateNewHashMapSliceArgs& createNewHashMapSliceArgs,
+        uint64_t numberOfHashMaps,
+        uint64_t numberOfPartitions = 1,
+        uint64_t bloomFilterBitsPerKey = 0);
+    [[nodiscard]] HashMap* getHashMapPtr(WorkerThreadId workerThreadId, const JoinBuildSideType& buildSide, uint64_t partition = 0) const;
+    [[nodiscard]] HashMap* getHashMapPtrOrCreate(WorkerThreadId workerThreadId, const JoinBuildSideType& buildSide, uint64_t partition = 0);
+    /// Returns the hash maps of all worker threads for the partition. Hash maps that have not been created yet are nullptr.
+    [[nodiscard]] std::vector<HashMap*> getHashMapPtrsOfPartition(const JoinBuildSideType& buildSide, uint64_t partition) const;
+    /// Counts a record that the worker thread builds into its hash map of the partition. Only the worker thread itself calls this.
+    void addRecord(WorkerThreadId workerThreadId, const JoinBuildSideType& buildSide, uint64_t partition);
+    [[nodiscard]] uint64_t getNumberOfRecords(WorkerThreadId workerThreadId, const JoinBuildSideType& buildSide, uint64_t partition) const;
+    /// Returns the number of records that all worker threads built into their hash maps of the partition
+    [[nodiscard]] uint64_t getNumberOfRecordsOfPartition(const JoinBuildSideType& buildSide, uint64_t partition) const;
     [[nodiscard]] uint64_t getNumberOfHashMapsForSide() const;
-};
+    /// Returns the bloom filter over the keys of the left side or nullptr, if the slice has been created without a bloom filter
+    [[nodiscard]] BlockedBloomFilter* getLeftBloomFilter() const;
+    /// Returns the rows of the hash map for a hash join with late materialization (see HJRowChain) or the rows of the streamed side
+    [[nodiscard]] PagedVector*
+    getRowsPtrOrCreate(WorkerThreadId workerThreadId, const JoinBuildSideType& buildSide, uint64_t partition = 0);
+    /// Returns the rows of all worker threads for the partition. Rows that have not been created yet are nullptr.
+    [[nodiscard]] std::vector<PagedVector*> getRowsPtrsOfPartition(const JoinBuildSideType& buildSide, uint64_t partition) const;
 
+private:
+    /// The left build side is the first input stream
+    [[nodiscard]] static uint64_t getInputStream(const JoinBuildSideType& buildSide);
+
+    [[nodiscard]] uint64_t getRecordCounterPos(WorkerThreadId workerThreadId, const JoinBuildSideType& buildSide, uint64_t partition) const;
+
+    /// The counters of one worker thread occupy their own cache lines, as every worker thread increments its counters for every record
+    static constexpr size_t COUNTERS_PER_CACHE_LINE = std::hardware_destructive_interference_size / sizeof(uint64_t);
+    struct alignas(std::hardware_destructive_interference_size) RecordCounters
+    {
+        std::array<uint64_t, COUNTERS_PER_CACHE_LINE> numberOfRecords{};
+    };
+
+    uint64_t numberOfCacheLinesPerWorkerThread;
+    std::vector<RecordCounters> recordCounters;
+    std::unique_ptr<BlockedBloomFilter> leftBloomFilter;
+    /// Stored at the same positions as the hash maps. Only created for a hash join with late materialization or a streamed side.
+    std::vector<std::unique_ptr<PagedVector>> rows;
+};
 }
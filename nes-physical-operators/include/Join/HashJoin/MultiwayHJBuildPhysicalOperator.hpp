@@ -0,0 +1,68 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <Identifiers/Identifiers.hpp>
+#include <Join/HashJoin/MultiwayHJOperatorHandler.hpp>
+#include <Join/HashJoin/MultiwayHJSlice.hpp>
+#include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
+#include <Time/Timestamp.hpp>
+#include <Watermark/TimeFunction.hpp>
+#include <CompilationContext.hpp>
+#include <ExecutionContext.hpp>
+#include <HashMapOptions.hpp>
+#include <WindowBuildPhysicalOperator.hpp>
+
+namespace NES
+{
+class MultiwayHJBuildPhysicalOperator;
+MultiwayHJSlice* getMultiwayHashJoinSliceProxy(
+    const MultiwayHJOperatorHandler* operatorHandler,
+    Timestamp timestamp,
+    WorkerThreadId workerThreadId,
+    const MultiwayHJBuildPhysicalOperator* buildOperator);
+HashMap* getMultiwayHashJoinHashMapProxy(MultiwayHJSlice* slice, WorkerThreadId workerThreadId, uint64_t input);
+
+/// This class is the first phase of the multiway hash join. Every input stream of the join has its own build operator, which stores the
+/// tuples of its input in the hash maps of the input in the slice of the tuple, like the build of a binary hash join.
+class MultiwayHJBuildPhysicalOperator final : public WindowBuildPhysicalOperator
+{
+public:
+    friend MultiwayHJSlice* getMultiwayHashJoinSliceProxy(
+        const MultiwayHJOperatorHandler* operatorHandler,
+        Timestamp timestamp,
+        WorkerThreadId workerThreadId,
+        const MultiwayHJBuildPhysicalOperator* buildOperator);
+    MultiwayHJBuildPhysicalOperator(
+        OperatorHandlerId operatorHandlerId,
+        uint64_t input,
+        std::unique_ptr<TimeFunction> timeFunction,
+        std::shared_ptr<TupleBufferRef> bufferRef,
+        HashMapOptions hashMapOptions);
+    void setup(ExecutionContext& executionCtx, CompilationContext& compilationContext) const override;
+    void execute(ExecutionContext& ctx, Record& record) const override;
+
+private:
+    /// Index of the input stream of the join, whose tuples this operator builds
+    uint64_t input;
+    std::shared_ptr<TupleBufferRef> bufferRef;
+    HashMapOptions hashMapOptions;
+};
+
+}
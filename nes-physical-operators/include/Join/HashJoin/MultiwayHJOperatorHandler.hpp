@@ -0,0 +1,117 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
+#include <Runtime/QueryTerminationType.hpp>
+#include <Sequencing/SequenceData.hpp>
+#include <SliceStore/Slice.hpp>
+#include <SliceStore/WindowSlicesStoreInterface.hpp>
+#include <Util/RollingAverage.hpp>
+#include <folly/Synchronized.h>
+#include <HashMapSlice.hpp>
+#include <PipelineExecutionContext.hpp>
+#include <WindowBasedOperatorHandler.hpp>
+
+namespace NES
+{
+
+/// This task models the information for a multiway hash join based window trigger.
+/// The buffer stores after this object the number of hash maps of every input, the pointers to the first hash map pointer of every input
+/// and then the hash map pointers of all inputs, one input after the other.
+struct EmittedMultiwayHJWindowTrigger
+{
+    EmittedMultiwayHJWindowTrigger(const WindowInfo windowInfo, const std::vector<std::vector<HashMap*>>& hashMapsOfInputs)
+        : windowInfo(windowInfo), numberOfInputs(hashMapsOfInputs.size())
+    {
+        numberOfHashMaps = std::bit_cast<uint64_t*>(this + 1);
+        hashMaps = std::bit_cast<HashMap***>(numberOfHashMaps + numberOfInputs);
+        auto** nextHashMapPtr = std::bit_cast<HashMap**>(hashMaps + numberOfInputs);
+        for (uint64_t input = 0; input < numberOfInputs; ++input)
+        {
+            numberOfHashMaps[input] = hashMapsOfInputs[input].size();
+            hashMaps[input] = nextHashMapPtr;
+            nextHashMapPtr = std::ranges::copy(hashMapsOfInputs[input], nextHashMapPtr).out;
+        }
+    }
+
+    WindowInfo windowInfo;
+    uint64_t numberOfInputs;
+    uint64_t* numberOfHashMaps;
+    /// Pointer to the stored pointers of the hash maps of every input stream that the probe should iterate over
+    HashMap*** hashMaps;
+};
+
+/// Operator handler of a multiway hash join, which joins more than two input streams over the same tumbling windows on a common key.
+/// All inputs insert their tuples into the same slice and a window trigger probes the hash maps of all inputs at once.
+class MultiwayHJOperatorHandler final : public WindowBasedOperatorHandler
+{
+public:
+    MultiwayHJOperatorHandler(
+        const std::vector<OriginId>& inputOrigins,
+        OriginId outputOriginId,
+        std::unique_ptr<WindowSlicesStoreInterface> sliceAndWindowStore,
+        uint64_t numberOfInputs,
+        uint64_t maxNumberOfBuckets);
+
+    /// Logs the statistics of the hash maps of the destroyed slices
+    void stop(QueryTerminationType queryTerminationType, PipelineExecutionContext& pipelineExecutionContext) override;
+
+    [[nodiscard]] std::function<std::vector<std::shared_ptr<Slice>>(SliceStart, SliceEnd)>
+    getCreateNewSlicesFunction(const CreateNewSlicesArguments& newSlicesArguments) const override;
+
+    /// Returns how much the hash maps of all destroyed slices had to grow, as they received more keys than expected
+    [[nodiscard]] HashMapGrowthStatistics getHashMapGrowthStatistics() const;
+
+    bool wasSetupCalled(uint64_t input);
+    void setNautilusCleanupExec(std::shared_ptr<CreateNewHashMapSliceArgs::NautilusCleanupExec> nautilusCleanupExec, uint64_t input);
+    [[nodiscard]] std::vector<std::shared_ptr<CreateNewHashMapSliceArgs::NautilusCleanupExec>> getNautilusCleanupExec() const;
+
+private:
+    /// Emits one probe task per combination of one slice of the window for every input
+    void triggerSlices(
+        const std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>>& slicesAndWindowInfo,
+        PipelineExecutionContext* pipelineCtx) override;
+
+    void emitSlicesToProbe(
+        const std::vector<const Slice*>& slicesOfInputs,
+        const WindowInfo& windowInfo,
+        const SequenceData& sequenceData,
+        PipelineExecutionContext* pipelineCtx);
+
+    uint64_t numberOfInputs;
+    /// Is required to not perform the setup again and resolving a race condition to the cleanup state function
+    std::vector<std::atomic<bool>> setupAlreadyCalled;
+    /// shared_ptr as multiple slices need access to it
+    std::vector<std::shared_ptr<CreateNewHashMapSliceArgs::NautilusCleanupExec>> cleanupStateNautilusFunctions;
+    folly::Synchronized<RollingAverage<uint64_t>> rollingAverageNumberOfKeys;
+    uint64_t maxNumberOfBuckets;
+    /// shared_ptr as the slices add the statistics of their hash maps, once they get destroyed
+    std::shared_ptr<folly::Synchronized<HashMapGrowthStatistics>> hashMapGrowthStatistics;
+    /// shared_ptr as the slices release their hash maps to the pool, once they get destroyed
+    std::shared_ptr<HashMapPool> hashMapPool;
+};
+
+}
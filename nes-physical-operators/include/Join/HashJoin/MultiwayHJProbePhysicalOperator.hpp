@@ -0,0 +1,82 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <Join/HashJoin/MultiwayHJOperatorHandler.hpp>
+#include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMap.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Nautilus/Interface/RecordBuffer.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
+#include <Time/Timestamp.hpp>
+#include <Windowing/WindowMetaData.hpp>
+#include <ExecutionContext.hpp>
+#include <HashMapOptions.hpp>
+#include <WindowProbePhysicalOperator.hpp>
+#include <val.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+/// Performs the second phase of the multiway hash join. As all inputs join on the same key, the probe iterates over the entries of the
+/// hash maps of the first input and looks up their key in the hash maps of all other inputs. For every key that all inputs contain, it
+/// emits the cross product of the tuples of all inputs with this key.
+/// The joined records contain the window start and end of all joins of the nest that the multiway hash join replaces, as they are part of
+/// the output schema of the topmost join.
+class MultiwayHJProbePhysicalOperator final : public WindowProbePhysicalOperator
+{
+public:
+    /// @param windowMetaDataOfJoins contains the window fields of all replaced joins, the first one belongs to the topmost join
+    MultiwayHJProbePhysicalOperator(
+        OperatorHandlerId operatorHandlerId,
+        std::vector<WindowMetaData> windowMetaDataOfJoins,
+        std::vector<std::shared_ptr<TupleBufferRef>> bufferRefs,
+        std::vector<HashMapOptions> hashMapOptions);
+
+    /// As the second phase gets triggered by the first phase, we receive a tuple buffer containing all information for performing the probe.
+    /// Thus, we start a new pipeline and therefore, we create new Records from the built-up state.
+    void open(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const override;
+
+private:
+    /// Looks up the key of the entry in all hash maps of the input. For every found entry, continues with the next input.
+    void probeInput(
+        ExecutionContext& executionCtx,
+        const nautilus::val<EmittedMultiwayHJWindowTrigger*>& hashJoinWindowRef,
+        const nautilus::val<ChainedHashMapEntry*>& keyEntry,
+        uint64_t input,
+        std::vector<nautilus::val<int8_t*>>& pagedVectorMems,
+        const nautilus::val<Timestamp>& windowStart,
+        const nautilus::val<Timestamp>& windowEnd) const;
+
+    /// Joins all records of the paged vectors of the inputs, starting at the input, i.e., all records with the same key
+    void joinPagedVectors(
+        ExecutionContext& executionCtx,
+        const std::vector<nautilus::val<int8_t*>>& pagedVectorMems,
+        uint64_t input,
+        const Record& joinedRecord,
+        const nautilus::val<Timestamp>& windowStart,
+        const nautilus::val<Timestamp>& windowEnd) const;
+
+    std::vector<WindowMetaData> windowMetaDataOfJoins;
+    std::vector<std::shared_ptr<TupleBufferRef>> bufferRefs;
+    std::vector<HashMapOptions> hashMapOptions;
+};
+
+}
@@ -0,0 +1,44 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <SliceStore/Slice.hpp>
+#include <HashMapSlice.hpp>
+
+namespace NES
+{
+
+/// A slice of a multiway hash join stores one hash map per worker thread for each of the joined input streams.
+/// Thus, a window of a nest of joins keeps the tuples of all of its inputs in one slice and no intermediate join results.
+class MultiwayHJSlice final : public HashMapSlice
+{
+public:
+    MultiwayHJSlice(
+        SliceStart sliceStart,
+        SliceEnd sliceEnd,
+        const CreateNewHashMapSliceArgs& createNewHashMapSliceArgs,
+        uint64_t numberOfHashMaps,
+        uint64_t numberOfInputs);
+    [[nodiscard]] HashMap* getHashMapPtr(WorkerThreadId workerThreadId, uint64_t input) const;
+    [[nodiscard]] HashMap* getHashMapPtrOrCreate(WorkerThreadId workerThreadId, uint64_t input);
+    /// Returns the hash maps of all worker threads for the input. Hash maps that have not been created yet are nullptr.
+    [[nodiscard]] std::vector<HashMap*> getHashMapPtrsOfInput(uint64_t input) const;
+    [[nodiscard]] uint64_t getNumberOfInputs() const;
+};
+}
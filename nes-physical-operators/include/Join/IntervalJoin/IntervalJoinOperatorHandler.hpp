@@ -0,0 +1,66 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+#include <Join/NestedLoopJoin/NLJOperatorHandler.hpp>
+#include <SliceStore/Slice.hpp>
+#include <SliceStore/WindowSlicesStoreInterface.hpp>
+#include <PipelineExecutionContext.hpp>
+
+namespace NES
+{
+/// The bounds of an interval join in milliseconds and the slices of the sliding window whose left records a window owns.
+/// A window owns the left records of the slice that starts offsetOfOwnedSlice after the window start. The window that starts at zero also
+/// owns all earlier left records.
+struct IntervalJoinBounds
+{
+    /// Returns the start of the window that owns the left records with the timestamp
+    [[nodiscard]] uint64_t getOwningWindowStart(uint64_t leftTimestamp) const;
+
+    /// Returns true, if the right slice may contain records within the interval of a record of the left slice
+    [[nodiscard]] bool mayJoin(const Slice& leftSlice, const Slice& rightSlice) const;
+
+    int64_t lowerBound;
+    int64_t upperBound;
+    uint64_t sliceLength;
+    uint64_t offsetOfOwnedSlice;
+};
+
+/// Joins the left records with the right records whose timestamps lie within [left timestamp + lower bound, left timestamp + upper bound].
+/// It builds the slices of a sliding window like the nested loop join, but only emits the pairs of a left slice that the window owns and
+/// the right slices that overlap the intervals of its records. Thus, the probe compares each pair of records in at most one window.
+class IntervalJoinOperatorHandler final : public NLJOperatorHandler
+{
+public:
+    IntervalJoinOperatorHandler(
+        const std::vector<OriginId>& inputOrigins,
+        OriginId outputOriginId,
+        std::unique_ptr<WindowSlicesStoreInterface> sliceAndWindowStore,
+        IntervalJoinBounds bounds);
+
+private:
+    void triggerSlices(
+        const std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>>& slicesAndWindowInfo,
+        PipelineExecutionContext* pipelineCtx) override;
+
+    IntervalJoinBounds bounds;
+};
+
+}
@@ -0,0 +1,50 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <Functions/PhysicalFunction.hpp>
+#include <Join/IntervalJoin/IntervalJoinOperatorHandler.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Arena.hpp>
+
+namespace NES
+{
+
+/// Evaluates to true for a joined record, if the window that it was joined in owns the left record and the right timestamp lies within
+/// the interval of the left timestamp. The probe evaluates it together with the join function, as windows overlap by multiple slices.
+class IntervalJoinPhysicalFunction final
+{
+public:
+    IntervalJoinPhysicalFunction(
+        Record::RecordFieldIdentifier leftTimestampField,
+        Record::RecordFieldIdentifier rightTimestampField,
+        Record::RecordFieldIdentifier windowStartField,
+        uint64_t millisecondsConversionMultiplier,
+        IntervalJoinBounds bounds);
+    [[nodiscard]] VarVal execute(const Record& record, ArenaRef& arena) const;
+
+private:
+    Record::RecordFieldIdentifier leftTimestampField;
+    Record::RecordFieldIdentifier rightTimestampField;
+    Record::RecordFieldIdentifier windowStartField;
+    uint64_t millisecondsConversionMultiplier;
+    IntervalJoinBounds bounds;
+};
+
+static_assert(PhysicalFunctionConcept<IntervalJoinPhysicalFunction>);
+
+}
@@ -0,0 +1,59 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Nautilus/Interface/RecordBuffer.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
+#include <CompilationContext.hpp>
+#include <ExecutionContext.hpp>
+#include <HashMapOptions.hpp>
+#include <PhysicalOperator.hpp>
+
+namespace NES
+{
+
+/// Loads the records of the table of a lookup join into the hash index of the LookupJoinOperatorHandler. It is the last operator of the
+/// pipeline of the table and stores each record in the paged vector of the entry of its keys, like the build of the hash join.
+/// The key functions cast the key fields of the table to the types that the probe compares the keys of the stream with.
+class LookupJoinBuildPhysicalOperator final : public PhysicalOperatorConcept
+{
+public:
+    LookupJoinBuildPhysicalOperator(
+        OperatorHandlerId operatorHandlerId, std::shared_ptr<TupleBufferRef> bufferRef, HashMapOptions hashMapOptions);
+
+    /// Registers the pipeline as one of the pipelines that load the table
+    void setup(ExecutionContext& executionCtx, CompilationContext& compilationContext) const override;
+    /// Acquires the hash index for the records of the buffer, as all build pipelines insert into the same hash index
+    void open(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const override;
+    void execute(ExecutionContext& ctx, Record& record) const override;
+    void close(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const override;
+    /// The table is loaded completely, once all of its build pipelines have terminated
+    void terminate(ExecutionContext& executionCtx) const override;
+
+    [[nodiscard]] std::optional<PhysicalOperator> getChild() const override;
+    void setChild(PhysicalOperator child) override;
+
+private:
+    std::optional<PhysicalOperator> child;
+    OperatorHandlerId operatorHandlerId;
+    std::shared_ptr<TupleBufferRef> bufferRef;
+    HashMapOptions hashMapOptions;
+};
+
+}
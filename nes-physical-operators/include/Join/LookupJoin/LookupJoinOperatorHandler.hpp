@@ -0,0 +1,57 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMap.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
+#include <Runtime/QueryTerminationType.hpp>
+
+namespace NES
+{
+
+/// Stores the hash index of the table of a lookup join, which all worker threads share.
+/// The build pipelines of the table insert into the index one after the other, as loading the table happens once.
+/// Once all of them have terminated, the index is read-only and the probe looks up the records of the stream without any synchronization.
+class LookupJoinOperatorHandler final : public OperatorHandler
+{
+public:
+    /// The value of each entry of the index is a PagedVector that stores all records of the table with the keys of the entry
+    LookupJoinOperatorHandler(uint64_t keySize, uint64_t numberOfBuckets, uint64_t pageSize);
+
+    void start(PipelineExecutionContext& pipelineExecutionContext, uint32_t localStateVariableId) override;
+    void stop(QueryTerminationType queryTerminationType, PipelineExecutionContext& pipelineExecutionContext) override;
+
+    [[nodiscard]] HashMap* getHashMap() const;
+    void lockForBuild();
+    void unlockAfterBuild();
+
+    /// Every build pipeline registers itself during its setup and reports its termination, after which the table is loaded completely
+    void registerBuildPipeline();
+    void terminateBuildPipeline();
+    [[nodiscard]] bool isTableLoaded() const;
+
+private:
+    std::unique_ptr<ChainedHashMap> hashMap;
+    std::mutex buildMutex;
+    std::atomic<uint64_t> numberOfActiveBuildPipelines{0};
+    std::atomic<bool> tableLoaded{false};
+};
+
+}
@@ -0,0 +1,61 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <vector>
+#include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Nautilus/Interface/RecordBuffer.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
+#include <ExecutionContext.hpp>
+#include <HashMapOptions.hpp>
+#include <PhysicalOperator.hpp>
+
+namespace NES
+{
+
+/// Scans the buffers of the stream of a lookup join and looks up the keys of each record in the hash index of the table. It emits the
+/// record joined with every record of the table with equal keys, without slicing the stream or waiting for any watermark.
+/// Until the table is loaded completely, it repeats the task of each buffer, as it would miss the matches of the records otherwise.
+class LookupJoinProbePhysicalOperator final : public PhysicalOperatorConcept
+{
+public:
+    LookupJoinProbePhysicalOperator(
+        OperatorHandlerId operatorHandlerId,
+        std::shared_ptr<TupleBufferRef> streamBufferRef,
+        std::shared_ptr<TupleBufferRef> tableBufferRef,
+        HashMapOptions hashMapOptions);
+
+    void open(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const override;
+
+    [[nodiscard]] std::optional<PhysicalOperator> getChild() const override;
+    void setChild(PhysicalOperator child) override;
+
+private:
+    void probe(ExecutionContext& executionCtx, const Record& streamRecord, const nautilus::val<HashMap*>& hashMapPtr) const;
+
+    std::optional<PhysicalOperator> child;
+    OperatorHandlerId operatorHandlerId;
+    std::shared_ptr<TupleBufferRef> streamBufferRef;
+    std::shared_ptr<TupleBufferRef> tableBufferRef;
+    std::vector<Record::RecordFieldIdentifier> streamFields;
+    std::vector<Record::RecordFieldIdentifier> tableFields;
+    /// The key functions cast the key fields of the stream to the types of the keys of the hash index
+    HashMapOptions hashMapOptions;
+};
+
+}
@@ -36,8 +36,13 @@ public:
         OperatorHandlerId operatorHandlerId,
         JoinBuildSideType joinBuildSide,
         std::unique_ptr<TimeFunction> timeFunction,
-        std::shared_ptr<TupleBufferRef> bufferRef);
+        std::shared_ptr<TupleBufferRef> bufferRef,
+        bool compressFullPages);
 
     void execute(ExecutionContext& executionCtx, Record& record) const override;
+
+private:
+    /// Compresses the full pages of the PagedVectors of the slices (see PagedVectorRef)
+    bool compressFullPages;
 };
 }
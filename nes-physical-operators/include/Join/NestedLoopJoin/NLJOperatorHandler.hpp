@@ -39,7 +39,7 @@ struct EmittedNLJWindowTrigger
     WindowInfo windowInfo;
 };
 
-class NLJOperatorHandler final : public StreamJoinOperatorHandler
+class NLJOperatorHandler : public StreamJoinOperatorHandler
 {
 public:
     NLJOperatorHandler(
@@ -50,7 +50,7 @@ public:
     [[nodiscard]] std::function<std::vector<std::shared_ptr<Slice>>(SliceStart, SliceEnd)>
     getCreateNewSlicesFunction(const CreateNewSlicesArguments&) const override;
 
-private:
+protected:
     void emitSlicesToProbe(
         Slice& sliceLeft,
         Slice& sliceRight,
@@ -16,7 +16,10 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <vector>
+#include <DataTypes/DataType.hpp>
+#include <Functions/BatchKernels.hpp>
 #include <Functions/PhysicalFunction.hpp>
 #include <Join/StreamJoinProbePhysicalOperator.hpp>
 #include <Join/StreamJoinUtil.hpp>
@@ -30,10 +33,37 @@
 namespace NES
 {
 
-/// Performs the second phase of the join. The tuples are joined via two nested loops.
-class NLJProbePhysicalOperator final : public StreamJoinProbePhysicalOperator
+/// A conjunct of the join function that compares two non-nullable fields of the same numeric type, i.e.,
+/// `leftFieldName <comparison> rightFieldName`. The probe evaluates it for a block of inner tuples at once via the batch kernels.
+struct NLJKeyComparison
+{
+    Record::RecordFieldIdentifier leftFieldName;
+    Record::RecordFieldIdentifier rightFieldName;
+    DataType::Type fieldType;
+    BatchComparison comparison;
+
+    /// Returns the same comparison with swapped operands, i.e., `rightFieldName <mirrored comparison> leftFieldName`
+    [[nodiscard]] NLJKeyComparison mirror() const
+    {
+        return {
+            .leftFieldName = rightFieldName,
+            .rightFieldName = leftFieldName,
+            .fieldType = fieldType,
+            .comparison = mirrorBatchComparison(comparison)};
+    }
+};
+
+/// Performs the second phase of the join. The tuples are joined via two nested loops, which tile the inner side into blocks that stay in
+/// the cache while all outer tuples are compared with a block. If the join function has a key comparison, the probe compares the keys of
+/// a block with one outer key at a time via SIMD kernels and only evaluates the join function for the qualifying pairs.
+class NLJProbePhysicalOperator : public StreamJoinProbePhysicalOperator
 {
 public:
+    /// Number of inner keys that are compared with an outer key at once. The keys, the mask and the selection vector stay in the L1 cache.
+    static constexpr uint64_t NLJ_KEY_BLOCK_SIZE = VECTORIZED_BATCH_SIZE;
+    /// Size of a block of inner tuples without a key comparison, so that the block stays in the L2 cache
+    static constexpr uint64_t NLJ_INNER_BLOCK_SIZE_IN_BYTES = 256 * 1024;
+
     NLJProbePhysicalOperator(
         OperatorHandlerId operatorHandlerId,
         PhysicalFunction joinFunction,
@@ -42,11 +72,22 @@ public:
         std::shared_ptr<TupleBufferRef> leftMemoryProvider,
         std::shared_ptr<TupleBufferRef> rightMemoryProvider,
         std::vector<Record::RecordFieldIdentifier> leftKeyFieldNames,
-        std::vector<Record::RecordFieldIdentifier> rightKeyFieldNames);
+        std::vector<Record::RecordFieldIdentifier> rightKeyFieldNames,
+        std::optional<NLJKeyComparison> keyComparison = std::nullopt);
 
     void open(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const override;
 
 protected:
+    /// Joins all tuples of the left and right PagedVector of a window. Subclasses that reuse the NLJ slices override this to join the
+    /// tuples differently, e.g., the SortMergeJoinProbePhysicalOperator.
+    virtual void performJoin(
+        const PagedVectorRef& leftPagedVector,
+        const PagedVectorRef& rightPagedVector,
+        ExecutionContext& executionCtx,
+        const nautilus::val<Timestamp>& windowStart,
+        const nautilus::val<Timestamp>& windowEnd) const;
+
+    /// The innerKeyComparison is `innerField <comparison> outerField`, i.e., its left field belongs to the inner side
     void performNLJ(
         const PagedVectorRef& outerPagedVector,
         const PagedVectorRef& innerPagedVector,
@@ -54,6 +95,7 @@ protected:
         TupleBufferRef& innerMemoryProvider,
         const std::vector<Record::RecordFieldIdentifier>& outerKeyFieldNames,
         const std::vector<Record::RecordFieldIdentifier>& innerKeyFieldNames,
+        const std::optional<NLJKeyComparison>& innerKeyComparison,
         ExecutionContext& executionCtx,
         const nautilus::val<Timestamp>& windowStart,
         const nautilus::val<Timestamp>& windowEnd) const;
@@ -61,5 +103,6 @@ protected:
     std::shared_ptr<TupleBufferRef> rightMemoryProvider;
     std::vector<Record::RecordFieldIdentifier> leftKeyFieldNames;
     std::vector<Record::RecordFieldIdentifier> rightKeyFieldNames;
+    std::optional<NLJKeyComparison> keyComparison;
 };
 }
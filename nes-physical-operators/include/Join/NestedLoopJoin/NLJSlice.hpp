@@ -16,6 +16,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <Identifiers/Identifiers.hpp>
 #include <Join/StreamJoinUtil.hpp>
@@ -41,12 +42,14 @@ public:
     [[nodiscard]] PagedVector* getPagedVectorRefRight(WorkerThreadId workerThreadId) const;
     [[nodiscard]] PagedVector* getPagedVectorRef(WorkerThreadId workerThreadId, JoinBuildSideType joinBuildSide) const;
 
-    /// Moves all tuples in this slice to the PagedVector at 0th index on both sides.
+    /// Moves all tuples in this slice to the PagedVector at 0th index on both sides. Only the first call moves the tuples.
     void combinePagedVectors();
 
 private:
+    void combineAllPagedVectors();
+
     std::vector<std::unique_ptr<PagedVector>> leftPagedVectors;
     std::vector<std::unique_ptr<PagedVector>> rightPagedVectors;
-    std::mutex combinePagedVectorsMutex;
+    std::once_flag pagedVectorsCombined;
 };
 }
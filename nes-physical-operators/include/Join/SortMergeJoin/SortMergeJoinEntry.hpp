@@ -0,0 +1,57 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+namespace NES
+{
+
+/// The sort-merge join sorts the tuples of both join sides of a window by their join attribute. Instead of moving the tuples in their
+/// PagedVectors, we sort one entry per tuple that stores the join attribute and the position of the tuple in its PagedVector.
+/// The join attribute is converted to a double, as this conversion preserves the order of all numeric types. Different values might be
+/// converted to the same double, e.g., large 64-bit integers. This is fine, as the candidate ranges contain all entries with the same key
+/// and the probe evaluates the exact join function for all candidates.
+struct SortMergeJoinEntry
+{
+    double key;
+    uint64_t position;
+};
+
+/// The right entries [begin, end) that are join candidates of one left entry
+struct SortMergeJoinRange
+{
+    uint64_t begin;
+    uint64_t end;
+};
+
+/// Sorts the entries by their key and moves all entries with a NaN key to the end, as a NaN satisfies none of the band predicates.
+/// Entries with the same key are sorted by their position, so that the probe accesses their PagedVector in order.
+/// Returns the number of entries without a NaN key.
+uint64_t sortSortMergeJoinEntries(std::span<SortMergeJoinEntry> entries);
+
+/// Computes the range of join candidates in the sorted right entries for each of the sorted left entries, i.e., all right entries
+/// whose key is >= (if rightIsLowerBoundedByLeft) and / or <= (if rightIsUpperBoundedByLeft) than the key of the left entry.
+/// As the keys of the left entries are ascending, the bounds of the ranges are ascending too. Thus, we compute all ranges by merging
+/// both sides in O(#left + #right) instead of searching the right entries for each left entry.
+void computeSortMergeJoinRanges(
+    std::span<const SortMergeJoinEntry> leftEntries,
+    std::span<const SortMergeJoinEntry> rightEntries,
+    bool rightIsLowerBoundedByLeft,
+    bool rightIsUpperBoundedByLeft,
+    std::span<SortMergeJoinRange> ranges);
+
+}
@@ -0,0 +1,80 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <Functions/PhysicalFunction.hpp>
+#include <Join/NestedLoopJoin/NLJProbePhysicalOperator.hpp>
+#include <Join/StreamJoinUtil.hpp>
+#include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
+#include <Nautilus/Interface/PagedVector/PagedVectorRef.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
+#include <Time/Timestamp.hpp>
+#include <Windowing/WindowMetaData.hpp>
+#include <ExecutionContext.hpp>
+#include <val.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+/// The left and right join attribute of a band predicate, e.g., `left.ts <= right.ts`, and on which sides the right attribute is bounded
+/// by the left attribute. For `left.ts <= right.ts`, the right attribute is lower bounded, for `left.a = right.b` on both sides.
+struct SortMergeJoinBand
+{
+    Record::RecordFieldIdentifier leftFieldName;
+    Record::RecordFieldIdentifier rightFieldName;
+    bool rightIsLowerBoundedByLeft;
+    bool rightIsUpperBoundedByLeft;
+};
+
+/// Performs the second phase of the sort-merge join for joins with inequality or range predicates.
+/// The first phase as well as the slices are the same as for the NLJ. Instead of comparing all pairs of tuples, we sort the tuples of
+/// both sides by their join attribute and merge both sides to find the range of right tuples that lie within the band of each left tuple.
+/// Only for these candidates, we evaluate the join function. Thus, the probe performs O(n log n + #candidates) instead of O(n^2)
+/// comparisons.
+class SortMergeJoinProbePhysicalOperator final : public NLJProbePhysicalOperator
+{
+public:
+    SortMergeJoinProbePhysicalOperator(
+        OperatorHandlerId operatorHandlerId,
+        PhysicalFunction joinFunction,
+        WindowMetaData windowMetaData,
+        const JoinSchema& joinSchema,
+        std::shared_ptr<TupleBufferRef> leftMemoryProvider,
+        std::shared_ptr<TupleBufferRef> rightMemoryProvider,
+        std::vector<Record::RecordFieldIdentifier> leftKeyFieldNames,
+        std::vector<Record::RecordFieldIdentifier> rightKeyFieldNames,
+        SortMergeJoinBand band);
+
+private:
+    void performJoin(
+        const PagedVectorRef& leftPagedVector,
+        const PagedVectorRef& rightPagedVector,
+        ExecutionContext& executionCtx,
+        const nautilus::val<Timestamp>& windowStart,
+        const nautilus::val<Timestamp>& windowEnd) const override;
+
+    /// Writes one SortMergeJoinEntry for each tuple of the PagedVector to the entries and sorts them.
+    /// Returns the number of entries whose key is not NaN.
+    static nautilus::val<uint64_t> writeSortedEntries(
+        const PagedVectorRef& pagedVector, const Record::RecordFieldIdentifier& sortFieldName, const nautilus::val<int8_t*>& entries);
+
+    SortMergeJoinBand band;
+};
+}
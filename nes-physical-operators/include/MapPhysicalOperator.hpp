@@ -35,6 +35,7 @@ public:
 
 private:
     Record::RecordFieldIdentifier fieldToWriteTo;
+    Record::FieldSlot slotToWriteTo;
     PhysicalFunction mapFunction;
 
     std::optional<PhysicalOperator> child;
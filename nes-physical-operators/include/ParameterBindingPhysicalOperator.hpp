@@ -0,0 +1,56 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <optional>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Nautilus/Interface/RecordBuffer.hpp>
+#include <ExecutionContext.hpp>
+#include <PhysicalOperator.hpp>
+
+namespace NES
+{
+
+/// Binds the values of the parameters of a query template to record fields, from which the functions of the following operators read
+/// the parameters. The operator loads the values from its ParameterOperatorHandler once per tuple buffer. Thus, the compiled code does
+/// not embed the values and is shared by all queries of the template.
+class ParameterBindingPhysicalOperator final : public PhysicalOperatorConcept
+{
+public:
+    struct Parameter
+    {
+        Record::RecordFieldIdentifier fieldName;
+        DataType dataType;
+    };
+
+    /// The i-th parameter reads the i-th value of the handler
+    ParameterBindingPhysicalOperator(OperatorHandlerId operatorHandlerId, std::vector<Parameter> parameters);
+
+    void open(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const override;
+    void execute(ExecutionContext& executionCtx, Record& record) const override;
+
+    [[nodiscard]] std::optional<PhysicalOperator> getChild() const override;
+    void setChild(PhysicalOperator child) override;
+
+private:
+    OperatorHandlerId operatorHandlerId;
+    std::vector<Parameter> parameters;
+    std::optional<PhysicalOperator> child;
+};
+
+}
@@ -0,0 +1,58 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
+#include <Runtime/QueryTerminationType.hpp>
+#include <PipelineExecutionContext.hpp>
+
+namespace NES
+{
+
+/// Holds the values that a query binds to the parameters of a query template (see ParameterBindingPhysicalOperator). The pipelines of all
+/// instances of the template share their compiled code, which reads the values of its query from the handler.
+class ParameterOperatorHandler final : public OperatorHandler
+{
+public:
+    /// Every value occupies a slot of this size, in which it is stored like in a row of a tuple buffer
+    static constexpr size_t SLOT_SIZE = sizeof(uint64_t);
+
+    struct Parameter
+    {
+        DataType dataType;
+        std::string value;
+    };
+
+    /// Throws a QueryCompilerError, if a value can not be parsed into the data type of its parameter
+    explicit ParameterOperatorHandler(const std::vector<Parameter>& parameters);
+
+    void start(PipelineExecutionContext&, uint32_t) override { }
+    void stop(QueryTerminationType, PipelineExecutionContext&) override { }
+
+    [[nodiscard]] int8_t* getValues() { return values.data(); }
+
+    /// Returns true, if the value of a constant of the data type can be bound to a parameter
+    [[nodiscard]] static bool supportsType(const DataType& dataType);
+
+private:
+    std::vector<int8_t> values;
+};
+
+}
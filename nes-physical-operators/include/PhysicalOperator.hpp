@@ -269,6 +269,8 @@ public:
 
 
     void addChild(const std::shared_ptr<PhysicalOperatorWrapper>& child);
+    /// The operator reads its input in the memory layout that the operator producing the input writes
+    void setInputMemoryLayoutType(MemoryLayoutType memoryLayoutType);
     void setChildren(const std::vector<std::shared_ptr<PhysicalOperatorWrapper>>& newChildren);
 
     [[nodiscard]] const std::optional<std::shared_ptr<OperatorHandler>>& getHandler() const;
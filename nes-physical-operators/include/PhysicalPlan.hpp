@@ -13,6 +13,7 @@
 */
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <ostream>
@@ -40,17 +41,29 @@ public:
     [[nodiscard]] const Roots& getRootOperators() const;
     [[nodiscard]] ExecutionMode getExecutionMode() const;
     [[nodiscard]] uint64_t getOperatorBufferSize() const;
+    /// Zero if the emits of the plan do not coalesce their buffers (see EmitOperatorHandler::enableCoalescing)
+    [[nodiscard]] std::chrono::microseconds getEmitCoalescingLatencyBound() const;
+    /// Zero if the emits of the plan copy the variable sized data of their input (see EmitOperatorHandler::enableVarSizedCompaction)
+    [[nodiscard]] uint64_t getVarSizedSharingCompactionThreshold() const;
 
 private:
     QueryId queryId;
     Roots rootOperators;
     ExecutionMode executionMode;
     uint64_t operatorBufferSize;
+    std::chrono::microseconds emitCoalescingLatencyBound;
+    uint64_t varSizedSharingCompactionThreshold;
 
     [[nodiscard]] std::string toString() const;
 
     friend class PhysicalPlanBuilder;
-    PhysicalPlan(QueryId id, Roots rootOperators, ExecutionMode executionMode, uint64_t operatorBufferSize);
+    PhysicalPlan(
+        QueryId id,
+        Roots rootOperators,
+        ExecutionMode executionMode,
+        uint64_t operatorBufferSize,
+        std::chrono::microseconds emitCoalescingLatencyBound,
+        uint64_t varSizedSharingCompactionThreshold);
 };
 }
 
@@ -0,0 +1,46 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <PhysicalOperator.hpp>
+
+namespace NES
+{
+
+/// Returns the number of records to skip until the next record of a Bernoulli sample with the given fraction, i.e., a geometric variate
+uint64_t drawBernoulliSampleGap(double fraction);
+
+/// Forwards each record independently with the probability of the fraction.
+/// Instead of drawing a random number per record, the operator draws the gaps between the sampled records from a geometric distribution.
+/// Thus, a skipped record solely costs a decrement and a comparison, and the random number generator runs once per sampled record.
+class BernoulliSamplePhysicalOperator final : public PhysicalOperatorConcept
+{
+public:
+    explicit BernoulliSamplePhysicalOperator(double fraction);
+
+    void open(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const override;
+    void execute(ExecutionContext& executionCtx, Record& record) const override;
+
+    [[nodiscard]] std::optional<PhysicalOperator> getChild() const override;
+    void setChild(PhysicalOperator child) override;
+
+private:
+    double fraction;
+    std::optional<PhysicalOperator> child;
+};
+
+}
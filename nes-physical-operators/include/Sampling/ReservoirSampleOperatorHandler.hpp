@@ -0,0 +1,78 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+#include <Nautilus/Interface/PagedVector/PagedVector.hpp>
+#include <Sampling/ReservoirSampleSlice.hpp>
+#include <SliceStore/Slice.hpp>
+#include <SliceStore/WindowSlicesStoreInterface.hpp>
+#include <PipelineExecutionContext.hpp>
+#include <WindowBasedOperatorHandler.hpp>
+
+namespace NES
+{
+
+/// A record of the sample of a window, i.e., its position in the paged vector of a reservoir
+struct SampledRecord
+{
+    const PagedVector* pagedVector;
+    uint64_t position;
+};
+
+/// The trigger of the probe for a chunk of the sample of a window, which the sampled records follow in the tuple buffer
+struct EmittedReservoirSample
+{
+    WindowInfo windowInfo;
+    uint64_t numberOfSampledRecords;
+};
+
+/// Merges the reservoirs of all worker threads and slices of a window into a uniform sample of the window.
+/// Each reservoir is a uniform sample of the records that it has seen. Thus, the operator handler draws the records of the window
+/// without replacement by picking a reservoir with the probability of its share of the unpicked records and then a random record of it.
+class ReservoirSampleOperatorHandler final : public WindowBasedOperatorHandler
+{
+public:
+    ReservoirSampleOperatorHandler(
+        const std::vector<OriginId>& inputOrigins,
+        OriginId outputOriginId,
+        std::unique_ptr<WindowSlicesStoreInterface> sliceAndWindowStore,
+        uint64_t sampleSize);
+
+    [[nodiscard]] std::function<std::vector<std::shared_ptr<Slice>>(SliceStart, SliceEnd)>
+    getCreateNewSlicesFunction(const CreateNewSlicesArguments&) const override;
+
+    /// Draws a uniform sample of at most sampleSize records from the union of the records that the reservoirs have seen
+    [[nodiscard]] static std::vector<SampledRecord>
+    mergeReservoirs(const std::vector<const WorkerReservoir*>& reservoirs, uint64_t sampleSize, std::mt19937_64& generator);
+
+private:
+    void triggerSlices(
+        const std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>>& slicesAndWindowInfo,
+        PipelineExecutionContext* pipelineCtx) override;
+
+    uint64_t sampleSize;
+    std::mutex generatorMutex;
+    std::mt19937_64 generator{std::random_device{}()};
+};
+
+}
@@ -0,0 +1,39 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <memory>
+#include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
+#include <Nautilus/Interface/RecordBuffer.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
+#include <WindowProbePhysicalOperator.hpp>
+
+namespace NES
+{
+
+/// This class is the second phase of the reservoir sample. It reads the sampled records of a window from the paged vectors of the
+/// reservoirs and passes them to its child. The sampled records keep their schema, thus the probe adds no window start and end fields.
+class ReservoirSampleProbePhysicalOperator final : public WindowProbePhysicalOperator
+{
+public:
+    ReservoirSampleProbePhysicalOperator(OperatorHandlerId operatorHandlerId, std::shared_ptr<TupleBufferRef> bufferRef);
+
+    void open(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const override;
+
+private:
+    std::shared_ptr<TupleBufferRef> bufferRef;
+};
+
+}
@@ -0,0 +1,55 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+#include <Nautilus/Interface/PagedVector/PagedVector.hpp>
+#include <SliceStore/Slice.hpp>
+
+namespace NES
+{
+
+/// The reservoir of the records that a single worker thread wrote to a slice (Algorithm R).
+/// The paged vector only grows, as a record that replaces a sampled record gets appended. The slots store the positions of the sampled
+/// records in the paged vector. Thus, the paged vector stores about sampleSize * (1 + ln(numberOfSeenRecords / sampleSize)) records.
+struct WorkerReservoir
+{
+    std::unique_ptr<PagedVector> records = std::make_unique<PagedVector>();
+    std::vector<uint64_t> slots;
+    uint64_t numberOfSeenRecords = 0;
+};
+
+/// This class represents a single slice of a reservoir sample. Each worker thread samples the records that it processes into its own
+/// reservoir, which the operator handler merges into a uniform sample of the window once the window ends.
+class ReservoirSampleSlice final : public Slice
+{
+public:
+    ReservoirSampleSlice(SliceStart sliceStart, SliceEnd sliceEnd, uint64_t numberOfWorkerThreads, uint64_t sampleSize);
+
+    /// Decides, if the next record of the worker thread enters its reservoir. If so, the worker thread has to append the record to the
+    /// paged vector of its reservoir right away, as the reservoir already refers to the position of the record.
+    [[nodiscard]] bool admitRecord(WorkerThreadId workerThreadId);
+    [[nodiscard]] PagedVector* getPagedVector(WorkerThreadId workerThreadId) const;
+    [[nodiscard]] const std::vector<WorkerReservoir>& getReservoirs() const;
+
+private:
+    uint64_t sampleSize;
+    std::vector<WorkerReservoir> reservoirs;
+};
+
+}
@@ -20,22 +20,40 @@
 #include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
 #include <Nautilus/Interface/Record.hpp>
 #include <Nautilus/Interface/RecordBuffer.hpp>
+#include <EmitPhysicalOperator.hpp>
 #include <PhysicalOperator.hpp>
+#include <SelectionPhysicalOperator.hpp>
 
 namespace NES
 {
 
+class InputFormatterTupleBufferRef;
+
 /// @brief This basic scan operator extracts records from a base tuple buffer according to a memory layout.
-/// Furthermore, it supports projection push down to eliminate unneeded reads
+/// Furthermore, it supports projection push down to eliminate unneeded reads.
+/// If the child is a selection with batch filters (vectorized execution mode), the scan evaluates the batch filters batch-at-a-time
+/// directly on the fields of the buffer and only materializes records that satisfy them.
+/// If the scan formats raw buffers and the child is a selection, the scan only parses the fields of the predicate of each record and
+/// parses the remaining fields only for records that satisfy the predicate (late materialization).
+/// If the child is an emit that only changes the layout between row and columnar, e.g., before a sink that requires columnar input,
+/// the scan transposes the buffers field by field instead of reading and writing record by record.
 class ScanPhysicalOperator final : public PhysicalOperatorConcept
 {
 public:
     explicit ScanPhysicalOperator(std::shared_ptr<TupleBufferRef> bufferRef, std::vector<Record::RecordFieldIdentifier> projections);
 
     void open(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const override;
+    void close(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const override;
     [[nodiscard]] std::optional<PhysicalOperator> getChild() const override;
     void setChild(PhysicalOperator child) override;
 
+    /// True, if the scan formats the raw buffers of a source that requires its formatted buffers in sequence order (see ParserConfig)
+    [[nodiscard]] bool requiresOrderedOutput() const;
+    /// Returns the input formatter, if the scan formats the raw buffers of a source
+    [[nodiscard]] std::shared_ptr<InputFormatterTupleBufferRef> getInputFormatter() const;
+    /// Returns the fields that the scan reads from the buffers
+    [[nodiscard]] const std::vector<Record::RecordFieldIdentifier>& getProjections() const;
+
 private:
     std::shared_ptr<TupleBufferRef> bufferRef;
     std::vector<Record::RecordFieldIdentifier> projections;
@@ -43,6 +61,17 @@ private:
     bool isRawScan = false;
 
     void rawScan(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const;
+
+    /// Returns the child selection, if the input formatter can parse the fields of its predicate before all other fields
+    [[nodiscard]] std::optional<SelectionPhysicalOperator> getLateMaterializedSelection() const;
+
+    /// Returns the child selection, if its batch filters can be evaluated directly on the fields of the buffer
+    [[nodiscard]] std::optional<SelectionPhysicalOperator> getBatchSelection() const;
+    void vectorizedScan(ExecutionContext& executionCtx, RecordBuffer& recordBuffer, const SelectionPhysicalOperator& selection) const;
+
+    /// Returns the child emit, if it writes the same fixed-size fields as the scan reads in the other of the row and the columnar layout
+    [[nodiscard]] std::optional<EmitPhysicalOperator> getTransposingEmit() const;
+    void transposingScan(ExecutionContext& executionCtx, RecordBuffer& recordBuffer, const EmitPhysicalOperator& emit) const;
 };
 
 }
@@ -13,27 +13,84 @@
 */
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <utility>
+#include <vector>
+#include <Functions/BatchKernels.hpp>
 #include <Functions/PhysicalFunction.hpp>
 #include <Nautilus/Interface/Record.hpp>
 #include <PhysicalOperator.hpp>
+#include <val.hpp>
 
 namespace NES
 {
 
+/// Counts how many records pass each conjunct of a selection, while tiered execution interprets the pipeline
+class ConjunctProfile
+{
+public:
+    static constexpr size_t MAX_NUMBER_OF_CONJUNCTS = 64;
+
+    explicit ConjunctProfile(size_t numberOfConjuncts);
+
+    /// Bit i of passedConjuncts is set, if the record passed conjunct i
+    void record(uint64_t passedConjuncts);
+
+    /// Orders the conjuncts by ascending pass rate, so that the conjuncts that reject the most records are evaluated first.
+    /// Conjuncts with equal pass rates (or without any recorded records) keep their order in the predicate.
+    /// The first call fixes the order, as the tracer evaluates the operator once per path through the pipeline, while the interpreter may
+    /// still record records. Thus, all paths of the compiled code agree on the order.
+    [[nodiscard]] const std::vector<size_t>& getEvaluationOrder() const;
+
+private:
+    size_t numberOfConjuncts;
+    std::unique_ptr<std::atomic<uint64_t>[]> passedRecords;
+    mutable std::once_flag evaluationOrderFixed;
+    mutable std::vector<size_t> evaluationOrder;
+};
+
 /// @brief Selection operator that evaluates a boolean function on each record.
+/// In the vectorized execution mode, the predicate is additionally split into batch filters and a residual function.
+/// The batch filters are conjuncts that a preceding scan can evaluate batch-at-a-time over columnar buffers. If the scan did so,
+/// it calls executeResidual for the qualifying records, which only has to evaluate the remaining conjuncts.
+/// With profiled conjuncts, the interpreter evaluates all conjuncts of each record and profiles their pass rates. The compiled code
+/// evaluates the conjuncts one after the other in the order of the profile and skips the remaining conjuncts of a rejected record.
 class SelectionPhysicalOperator final : public PhysicalOperatorConcept
 {
 public:
     explicit SelectionPhysicalOperator(PhysicalFunction function) : function(std::move(function)) { };
+    SelectionPhysicalOperator(PhysicalFunction function, std::vector<PhysicalFunction> profiledConjuncts);
+    SelectionPhysicalOperator(PhysicalFunction function, std::vector<BatchFilter> batchFilters, std::optional<PhysicalFunction> residual)
+        : function(std::move(function)), batchFilters(std::move(batchFilters)), residualFunction(std::move(residual)) { };
     void execute(ExecutionContext& ctx, Record& record) const override;
 
+    /// Evaluates only the residual function on a record that already satisfies all batch filters
+    void executeResidual(ExecutionContext& ctx, Record& record) const;
+    [[nodiscard]] const std::vector<BatchFilter>& getBatchFilters() const { return batchFilters; }
+
+    /// Returns true, if the record satisfies the predicate. Does not call the child.
+    [[nodiscard]] nautilus::val<bool> evaluate(ExecutionContext& ctx, Record& record) const;
+    /// The fields that the predicate reads. An empty list means that they are unknown.
+    void setPredicateFields(std::vector<Record::RecordFieldIdentifier> predicateFields);
+    [[nodiscard]] const std::vector<Record::RecordFieldIdentifier>& getPredicateFields() const { return predicateFields; }
+
     [[nodiscard]] std::optional<PhysicalOperator> getChild() const override;
     void setChild(PhysicalOperator child) override;
 
 private:
+    nautilus::val<bool> evaluateAndProfileConjuncts(ExecutionContext& ctx, Record& record) const;
+
     const PhysicalFunction function;
+    std::vector<BatchFilter> batchFilters;
+    std::optional<PhysicalFunction> residualFunction;
+    std::vector<PhysicalFunction> profiledConjuncts;
+    std::shared_ptr<ConjunctProfile> conjunctProfile;
+    std::vector<Record::RecordFieldIdentifier> predicateFields;
     std::optional<PhysicalOperator> child;
 };
 }
@@ -13,11 +13,13 @@
 */
 
 #pragma once
+#include <array>
 #include <atomic>
 #include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
+#include <new>
 #include <optional>
 #include <vector>
 #include <SliceStore/WindowSlicesStoreInterface.hpp>
@@ -47,26 +49,96 @@ struct SlicesAndState
 class DefaultTimeBasedSliceStore final : public WindowSlicesStoreInterface
 {
 public:
-    DefaultTimeBasedSliceStore(uint64_t windowSize, uint64_t windowSlide);
+    /// Without an allowed lateness, records behind the watermark update the slices without emitting their windows again
+    DefaultTimeBasedSliceStore(uint64_t windowSize, uint64_t windowSlide, std::optional<uint64_t> allowedLateness = std::nullopt);
+    /// Creates a slice store, whose slices are shared by the windows of all window definitions. A slice belongs to the windows of every
+    /// definition that cover it. Thus, the store triggers the windows of all definitions, ordered by their window end.
+    explicit DefaultTimeBasedSliceStore(
+        std::vector<SliceAssigner> windowDefinitions, std::optional<uint64_t> allowedLateness = std::nullopt);
 
     ~DefaultTimeBasedSliceStore() override;
     std::vector<std::shared_ptr<Slice>> getSlicesOrCreate(
-        Timestamp timestamp, const std::function<std::vector<std::shared_ptr<Slice>>(SliceStart, SliceEnd)>& createNewSlice) override;
+        Timestamp timestamp,
+        WorkerThreadId workerThreadId,
+        const std::function<std::vector<std::shared_ptr<Slice>>(SliceStart, SliceEnd)>& createNewSlice) override;
     std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>>
     getTriggerableWindowSlices(Timestamp globalWatermark) override;
     std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>> getAllNonTriggeredSlices() override;
+    std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>> getFillingWindowSlices() override;
+    FillingSlices getSlicesOfFillingWindows() override;
+    void skipWindowsEndingBefore(Timestamp windowEnd) override;
+    [[nodiscard]] std::optional<uint64_t> getAllowedLateness() const override;
+    [[nodiscard]] bool isBeyondAllowedLateness(Timestamp timestamp) const override;
+    void markWindowsWithLateUpdates(const std::vector<std::shared_ptr<Slice>>& updatedSlices) override;
+    void addIngestionTimestamps(Timestamp globalWatermark, const IngestionTimestamps& ingestionTimestamps) override;
     std::optional<std::shared_ptr<Slice>> getSliceBySliceEnd(SliceEnd sliceEnd) override;
     void garbageCollectSlicesAndWindows(Timestamp newGlobalWaterMark) override;
+    /// Requires no concurrent build, as it clears the slice caches of all worker threads
     void deleteState() override;
     void incrementNumberOfInputPipelines() override;
+    /// Creates a slice cache per worker thread. Requires no concurrent build, as it replaces the slice caches.
+    void setWorkerThreads(uint64_t numberOfWorkerThreads) override;
+    /// With multiple window definitions, the window size is the largest size and the slide is the length of the shared slices
     uint64_t getWindowSize() const override;
+    uint64_t getWindowSlide() const override;
 
 private:
+    /// Number of slots of the slice cache of a worker thread. As a worker thread writes into the few slices around the current
+    /// watermark, the slots only need to cover a small multiple of the number of slices that are filled concurrently.
+    static constexpr uint64_t SLICE_CACHE_SIZE = 16;
+
+    /// Ring of the slices that a worker thread has looked up recently, indexed by the slice number (slice start / sliceGranularity).
+    /// Solely its worker thread reads and writes the cache. Thus, a lookup needs no lock and no shared counter.
+    struct alignas(std::hardware_destructive_interference_size) SliceCache
+    {
+        std::array<std::shared_ptr<Slice>, SLICE_CACHE_SIZE> slices;
+        /// The epoch of the slice store, when the worker thread has last cleared its cache
+        uint64_t epoch = 0;
+    };
+
+    /// Returns the slice cache of the worker thread, after clearing it, if slices have been removed since its last lookup. Returns
+    /// nullptr, if the worker thread has no slice cache, e.g., for a lookup outside of a worker thread.
+    [[nodiscard]] SliceCache* getSliceCache(WorkerThreadId workerThreadId);
+
+    /// Returns the slot of the slice cache for the slice with the given slice start. All slice starts are multiples of sliceGranularity.
+    [[nodiscard]] std::shared_ptr<Slice>& getSliceCacheSlot(SliceCache& sliceCache, SliceStart sliceStart) const;
+
+    /// Returns the windows of all window definitions that contain the slice
+    [[nodiscard]] std::vector<WindowInfo> getAllWindowsForSlice(const Slice& slice) const;
+
+    /// Returns true, if the allowed lateness of the window has passed for the latest triggering watermark
+    [[nodiscard]] bool hasAllowedLatenessPassed(const WindowInfo& windowInfo) const;
+
+    /// Moves the first window to trigger to the window, if the window comes first. Requires the write lock of the windows.
+    void addWindowToTrigger(const WindowInfo& windowInfo);
+
     /// We need to store the windows and slices in two separate maps. This is necessary as we need to access the slices during the join build phase,
     /// while we need to access windows during the triggering of windows.
     folly::Synchronized<std::map<WindowInfo, SlicesAndState>> windows;
     folly::Synchronized<std::map<SliceEnd, std::shared_ptr<Slice>>> slices;
+    /// All windows before this window have been emitted to the probe. Thus, triggering starts at this window instead of iterating over the
+    /// emitted windows that wait for their garbage collection. std::nullopt, if all windows have been emitted. Guarded by the windows lock.
+    std::optional<WindowInfo> firstWindowToTrigger;
+    /// Window end of the first window to trigger, or INVALID_VALUE, if all windows have been emitted. Is read without the windows lock,
+    /// so that watermarks that do not pass the end of the next window skip the trigger right away.
+    std::atomic<Timestamp::Underlying> firstWindowToTriggerEnd;
+    std::vector<SliceAssigner> windowDefinitions;
+    /// Assigns the slices of a single window definition, or the slices of the shared slice length of multiple window definitions
     SliceAssigner sliceAssigner;
+    /// Slices are garbage collected once the largest window that may contain them has been triggered
+    uint64_t largestWindowSize;
+    std::optional<uint64_t> allowedLateness;
+    /// The largest global watermark that the windows have been triggered for, which decides whether the allowed lateness has passed
+    std::atomic<Timestamp::Underlying> triggerWatermark;
+
+    /// One slice cache per worker thread. It allows the build pipelines to find their current slice without acquiring the lock of the
+    /// slices, which is only needed for creating a new slice.
+    std::vector<SliceCache> sliceCaches;
+    /// Incremented by the garbage collection, after it removed slices. A worker thread clears its slice cache, once its epoch is behind.
+    /// Thus, a removed slice is never found in a cache, and a cache releases removed slices with the next lookup of its worker thread.
+    std::atomic<uint64_t> sliceCacheEpoch;
+    /// Greatest common divisor of all window sizes and slides, as slices start at multiples of the slide or at a window end
+    uint64_t sliceGranularity;
 
     /// We need to store the sequence number for the triggerable window infos. This is necessary, as we have to ensure that the sequence number is unique
     /// and increases for each window info.
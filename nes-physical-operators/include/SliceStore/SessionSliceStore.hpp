@@ -0,0 +1,107 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+#include <SliceStore/Slice.hpp>
+#include <SliceStore/WindowSlicesStoreInterface.hpp>
+#include <Time/Timestamp.hpp>
+#include <folly/Synchronized.h>
+
+namespace NES
+{
+
+/// Slice store for session windows. A session ends, if no record arrives for at least the gap.
+/// In contrast to tumbling and sliding windows, the boundaries of a session depend on the records. Thus, we can not assign records to
+/// the final windows while building. Instead, we slice the time into non-overlapping slices of the length of the gap. The records of a
+/// session are spread over a sequence of neighbouring slices and we keep track of the first and last timestamp of every slice.
+/// As no two records of a slice are a gap or more apart, a slice is never split between sessions. Two neighbouring non-empty slices
+/// belong to the same session, if the first timestamp of the later slice is less than a gap after the last timestamp of the earlier slice.
+/// Slices without records are never created. Thus, the sessions are formed by merging neighbouring slices when triggering, without
+/// combining or copying the state of the slices, and the existing build and probe operators can be reused as for any other window.
+/// A session [first timestamp, last timestamp + gap) can be triggered, once the watermark has passed its end and the end of its slices.
+class SessionSliceStore final : public WindowSlicesStoreInterface
+{
+public:
+    explicit SessionSliceStore(uint64_t gap);
+
+    ~SessionSliceStore() override;
+    std::vector<std::shared_ptr<Slice>> getSlicesOrCreate(
+        Timestamp timestamp,
+        WorkerThreadId workerThreadId,
+        const std::function<std::vector<std::shared_ptr<Slice>>(SliceStart, SliceEnd)>& createNewSlice) override;
+    std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>>
+    getTriggerableWindowSlices(Timestamp globalWatermark) override;
+    std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>> getAllNonTriggeredSlices() override;
+    /// Sessions do not emit early results, as records extend the bounds of a session until it gets triggered
+    std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>> getFillingWindowSlices() override;
+    /// Sessions do not get checkpointed either, as their bounds are not part of their slices
+    FillingSlices getSlicesOfFillingWindows() override;
+    void skipWindowsEndingBefore(Timestamp windowEnd) override;
+    /// Late records extend or merge sessions that have been emitted already, thus sessions do not accept late records
+    [[nodiscard]] std::optional<uint64_t> getAllowedLateness() const override;
+    [[nodiscard]] bool isBeyondAllowedLateness(Timestamp timestamp) const override;
+    void markWindowsWithLateUpdates(const std::vector<std::shared_ptr<Slice>>& updatedSlices) override;
+    void addIngestionTimestamps(Timestamp globalWatermark, const IngestionTimestamps& ingestionTimestamps) override;
+    std::optional<std::shared_ptr<Slice>> getSliceBySliceEnd(SliceEnd sliceEnd) override;
+    void garbageCollectSlicesAndWindows(Timestamp newGlobalWaterMark) override;
+    void deleteState() override;
+    void incrementNumberOfInputPipelines() override;
+    /// The session slices keep no state per worker thread
+    void setWorkerThreads(uint64_t numberOfWorkerThreads) override;
+    /// A session has no fixed size or slide. We return the gap for both, as it is the minimal extent of a session.
+    uint64_t getWindowSize() const override;
+    uint64_t getWindowSlide() const override;
+
+private:
+    /// A slice and the first and last timestamp of its records
+    struct SessionSlice
+    {
+        SessionSlice(std::shared_ptr<Slice> slice, Timestamp firstRecordTimestamp);
+
+        /// The timestamps are updated by the build pipelines, while holding the read lock of the slices
+        void addRecordTimestamp(Timestamp timestamp) const;
+
+        std::shared_ptr<Slice> slice;
+        mutable std::atomic<Timestamp::Underlying> firstTimestamp;
+        mutable std::atomic<Timestamp::Underlying> lastTimestamp;
+        /// End of the session that the slice has been emitted with. It is only accessed while holding the write lock of the slices.
+        std::optional<Timestamp> emittedSessionEnd;
+    };
+
+    /// Merges the neighbouring slices, which have not been emitted yet, into sessions and emits all sessions that can be triggered by
+    /// the global watermark. If no global watermark is given, all sessions are emitted.
+    std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>>
+    emitSessions(std::map<SliceEnd, SessionSlice>& sessionSlices, std::optional<Timestamp> globalWatermark);
+
+    uint64_t gap;
+    folly::Synchronized<std::map<SliceEnd, SessionSlice>> slices;
+
+    /// We need to store the sequence number for the triggered sessions. This is necessary, as we have to ensure that the sequence number
+    /// is unique and increases for each session.
+    std::atomic<SequenceNumber::Underlying> sequenceNumber;
+
+    /// If a window build operator appears in multiple pipelines, it may get terminated multiple times
+    /// We need to track how many input pipelines have not terminated yet, to only release pending slices after the last termination
+    std::atomic<uint64_t> numberOfActiveInputPipelines;
+};
+
+}
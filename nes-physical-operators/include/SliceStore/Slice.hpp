@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <Time/Timestamp.hpp>
 
@@ -36,11 +37,24 @@ struct CreateNewSlicesArguments
 /// WINDOW_FILLING               | Left or Right Pipeline Terminated | WAITING_ON_TERMINATION
 /// WAITING_ON_TERMINATION       | Query/Pipeline Terminated         | EMITTED_TO_PROBE
 /// EMITTED_TO_PROBE             | Tuples join in Probe              | CAN_BE_DELETED
+/// EMITTED_TO_PROBE             | Late Tuples within Lateness       | UPDATED_AFTER_EMISSION
+/// UPDATED_AFTER_EMISSION       | Global Watermark Ts > WindowEnd   | EMITTED_TO_PROBE
 enum class WindowInfoState : uint8_t
 {
     WINDOW_FILLING,
     WAITING_ON_TERMINATION,
-    EMITTED_TO_PROBE
+    EMITTED_TO_PROBE,
+    UPDATED_AFTER_EMISSION
+};
+
+/// Range of the times at which the sources ingested the tuples that some state derives from (see TupleBuffer::setIngestionTimestampsInNS)
+struct IngestionTimestamps
+{
+    /// Widens the range to include the other range. Unknown ingestion timestamps, i.e., Timestamp::INITIAL_VALUE, are ignored.
+    void merge(const IngestionTimestamps& other);
+
+    Timestamp min = Timestamp(Timestamp::INITIAL_VALUE);
+    Timestamp max = Timestamp(Timestamp::INITIAL_VALUE);
 };
 
 /// This class represents a single slice
@@ -60,8 +74,17 @@ public:
     bool operator==(const Slice& rhs) const;
     bool operator!=(const Slice& rhs) const;
 
+    /// Widens the range of the ingestion timestamps of the buffers that were processed while this slice was filled.
+    /// Build pipelines call this concurrently.
+    void addIngestionTimestamps(const IngestionTimestamps& ingestionTimestamps);
+    [[nodiscard]] IngestionTimestamps getIngestionTimestamps() const;
+
 protected:
     SliceStart sliceStart;
     SliceEnd sliceEnd;
+
+private:
+    std::atomic<Timestamp::Underlying> minIngestionTimestamp = Timestamp::INVALID_VALUE;
+    std::atomic<Timestamp::Underlying> maxIngestionTimestamp = Timestamp::INITIAL_VALUE;
 };
 }
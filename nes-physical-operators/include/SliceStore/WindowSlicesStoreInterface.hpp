@@ -37,7 +37,11 @@ struct WindowInfo
         PRECONDITION(windowEnd >= windowStart, "Window end {} must be greater or equal to window start {}", windowEnd, windowStart);
     }
 
-    bool operator<(const WindowInfo& other) const { return windowEnd < other.windowEnd; }
+    /// Windows of different sizes may end at the same timestamp, thus the window start breaks ties
+    bool operator<(const WindowInfo& other) const
+    {
+        return windowEnd < other.windowEnd or (windowEnd == other.windowEnd and windowStart < other.windowStart);
+    }
 
     Timestamp windowStart;
     Timestamp windowEnd;
@@ -58,6 +62,14 @@ struct WindowInfoAndSequenceNumber
     bool operator<(const WindowInfoAndSequenceNumber& other) const { return windowInfo < other.windowInfo; }
 };
 
+/// The slices of all windows that are still filling. As the windows get triggered in the order of their window end, all windows that end
+/// before the earliest end of the filling windows have been triggered.
+struct FillingSlices
+{
+    std::vector<std::shared_ptr<Slice>> slices;
+    Timestamp earliestWindowEnd{Timestamp::INVALID_VALUE};
+};
+
 /// This is the interface for storing windows and slices in a window-based operator
 /// It provides an interface to operate on slices and windows for a time-based window operator, e.g., join or aggregation
 class WindowSlicesStoreInterface
@@ -65,8 +77,11 @@ class WindowSlicesStoreInterface
 public:
     virtual ~WindowSlicesStoreInterface() = default;
     /// Retrieves the slices that corresponds to the timestamp. If no slices exist for the timestamp, they are created by calling the method createNewSlice
-    virtual std::vector<std::shared_ptr<Slice>>
-    getSlicesOrCreate(Timestamp timestamp, const std::function<std::vector<std::shared_ptr<Slice>>(SliceStart, SliceEnd)>& createNewSlice)
+    /// The worker thread id allows the store to keep state per worker thread. Lookups outside of a worker thread pass an invalid id.
+    virtual std::vector<std::shared_ptr<Slice>> getSlicesOrCreate(
+        Timestamp timestamp,
+        WorkerThreadId workerThreadId,
+        const std::function<std::vector<std::shared_ptr<Slice>>(SliceStart, SliceEnd)>& createNewSlice)
         = 0;
 
     /// Retrieves all slices that can be triggered by the given global watermark
@@ -75,6 +90,10 @@ public:
     virtual std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>> getTriggerableWindowSlices(Timestamp globalWatermark)
         = 0;
 
+    /// Adds the ingestion timestamps of a processed buffer to all slices that the buffer may have written to, i.e., to all slices that the
+    /// global watermark (before the buffer) does not trigger yet
+    virtual void addIngestionTimestamps(Timestamp globalWatermark, const IngestionTimestamps& ingestionTimestamps) = 0;
+
     /// Retrieves the slice by its end timestamp. If no slice exists for the given slice end, the optional return value is nullopt
     virtual std::optional<std::shared_ptr<Slice>> getSliceBySliceEnd(SliceEnd sliceEnd) = 0;
 
@@ -83,6 +102,29 @@ public:
     /// Additionally, it returns a sequence number per window that is incremented for each window and thus, it can be used to set it in the emitted tuple buffer for the probe operator.
     virtual std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>> getAllNonTriggeredSlices() = 0;
 
+    /// Retrieves the slices of all windows that are still filling, i.e., that have not been triggered yet, for emitting early results.
+    /// In contrast to triggering, the windows keep their state. Each window receives a new sequence number, as for triggering.
+    virtual std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>> getFillingWindowSlices() = 0;
+
+    /// Retrieves each slice of the windows that are still filling once, e.g., for checkpointing them. The windows keep their state and
+    /// sequence numbers.
+    virtual FillingSlices getSlicesOfFillingWindows() = 0;
+
+    /// Marks all windows that end before the window end as triggered, without emitting them. A query that restores the slices of a
+    /// checkpoint skips the windows that have been emitted before the checkpoint.
+    virtual void skipWindowsEndingBefore(Timestamp windowEnd) = 0;
+
+    /// Returns how long after the global watermark passed their end the windows accept late records, or nullopt if the windows do not
+    /// distinguish late records. A window keeps its slices during the allowed lateness and gets emitted again, if late records update it.
+    [[nodiscard]] virtual std::optional<uint64_t> getAllowedLateness() const = 0;
+
+    /// Returns true, if the allowed lateness of all windows that contain the timestamp has passed. Such records must not update any slice.
+    [[nodiscard]] virtual bool isBeyondAllowedLateness(Timestamp timestamp) const = 0;
+
+    /// Marks the triggered windows of the slices, whose allowed lateness has not passed yet, to be emitted again with the next trigger.
+    /// A build calls it, after it added the records of a buffer to the slices.
+    virtual void markWindowsWithLateUpdates(const std::vector<std::shared_ptr<Slice>>& updatedSlices) = 0;
+
     /// Garbage collect all slices and windows that are not valid anymore
     /// It is open for the implementation to delete the slices in this call or to mark them for deletion
     /// There is no guarantee that the slices are deleted after this call
@@ -96,7 +138,13 @@ public:
     /// Note: This should not be inferred when the store is created during the lowering stage, as the same build operator may appear in multiple pipelines.
     virtual void incrementNumberOfInputPipelines() = 0;
 
+    /// Sets the number of worker threads that may look up slices. It is called, when an operator handler using this store is started.
+    virtual void setWorkerThreads(uint64_t numberOfWorkerThreads) = 0;
+
     /// Returns the window size
     [[nodiscard]] virtual uint64_t getWindowSize() const = 0;
+
+    /// Returns the window slide
+    [[nodiscard]] virtual uint64_t getWindowSlide() const = 0;
 };
 }
@@ -34,6 +34,8 @@ public:
 private:
     std::vector<std::string> inputFields;
     std::vector<std::string> outputFields;
+    std::vector<Record::FieldSlot> inputSlots;
+    std::vector<Record::FieldSlot> outputSlots;
     std::optional<PhysicalOperator> child;
 };
 }
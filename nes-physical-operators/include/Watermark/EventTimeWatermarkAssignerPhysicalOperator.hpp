@@ -12,8 +12,10 @@
     limitations under the License.
 */
 #pragma once
+#include <cstdint>
 #include <memory>
 #include <optional>
+#include <Identifiers/Identifiers.hpp>
 #include <Watermark/TimeFunction.hpp>
 #include <PhysicalOperator.hpp>
 
@@ -23,10 +25,15 @@ class TimeFunction;
 
 /// @brief Watermark assignment operator.
 /// Determines the watermark ts according to a WatermarkStrategyDescriptor an places it in the current buffer.
+/// The watermark lags behind the largest timestamp of the buffer by the out-of-orderness bound. If an OutOfOrdernessOperatorHandler is
+/// given, it learns the bound per origin, up to the given bound.
 class EventTimeWatermarkAssignerPhysicalOperator : public PhysicalOperatorConcept
 {
 public:
-    explicit EventTimeWatermarkAssignerPhysicalOperator(EventTimeFunction timeFunction);
+    explicit EventTimeWatermarkAssignerPhysicalOperator(
+        EventTimeFunction timeFunction,
+        uint64_t outOfOrdernessBoundInMs = 0,
+        std::optional<OperatorHandlerId> adaptiveOutOfOrdernessHandlerId = std::nullopt);
     void open(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const override;
     void execute(ExecutionContext& ctx, Record& record) const override;
     void close(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const override;
@@ -35,6 +42,8 @@ public:
 
 private:
     EventTimeFunction timeFunction;
+    uint64_t outOfOrdernessBoundInMs;
+    std::optional<OperatorHandlerId> adaptiveOutOfOrdernessHandlerId;
     std::optional<PhysicalOperator> child;
 };
 
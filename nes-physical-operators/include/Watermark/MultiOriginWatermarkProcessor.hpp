@@ -13,8 +13,12 @@
 */
 
 #pragma once
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 #include <Identifiers/Identifiers.hpp>
 #include <Sequencing/NonBlockingMonotonicSeqQueue.hpp>
@@ -25,6 +29,9 @@ namespace NES
 {
 
 /// @brief A multi origin version of the lock free watermark processor.
+/// The watermarks of the origins are the leaves of a tournament tree, whose inner nodes hold the minimum of their children. Thus, an update
+/// only recomputes the ancestors of its origin, instead of the minimum over all origins. The update stops at the first ancestor that does
+/// not change, which is the common case if the watermarks of many origins progress concurrently.
 class MultiOriginWatermarkProcessor
 {
 public:
@@ -32,6 +39,8 @@ public:
     static std::shared_ptr<MultiOriginWatermarkProcessor> create(const std::vector<OriginId>& origins);
 
     /// @brief Updates the watermark timestamp and origin and emits the current watermark.
+    /// The watermark of the heartbeat of an idle source (Timestamp::IDLE_SOURCE_VALUE) raises the watermark of the origin to the minimum
+    /// watermark of the other origins. Thus, records of the origin that arrive after it resumed may be late.
     [[nodiscard]] Timestamp updateWatermark(Timestamp ts, SequenceData sequenceData, OriginId origin) const;
 
     /// @brief Returns the current watermark across all origins
@@ -40,8 +49,33 @@ public:
     std::string getCurrentStatus();
 
 private:
+    /// Origins are assigned consecutively per query, thus their ids usually fall into a small range, which is indexed by a table
+    static constexpr size_t MAX_TABLE_SIZE_PER_ORIGIN = 4;
+    static constexpr uint32_t NO_ORIGIN_INDEX = UINT32_MAX;
+
+    [[nodiscard]] size_t getOriginIndex(OriginId origin) const;
+
+    /// Raises the watermark of the leaf and afterward the minima of its ancestors.
+    /// Every thread that raises a node afterward recomputes its parent. As the watermarks only increase, either of two threads that raise
+    /// sibling nodes concurrently sees the watermarks of both.
+    void raiseWatermark(size_t originIndex, uint64_t watermark) const;
+
+    /// Returns the minimum watermark of all origins but the given one, i.e., of the siblings on the path to the root
+    [[nodiscard]] uint64_t getWatermarkOfOtherOrigins(size_t originIndex) const;
+
     const std::vector<OriginId> origins;
     std::vector<std::shared_ptr<Sequencing::NonBlockingMonotonicSeqQueue<uint64_t>>> watermarkProcessors;
+
+    /// Maps the raw origin id minus the smallest origin id to the index of the origin. Empty if the origin ids are too sparse, in which
+    /// case sortedOrigins maps them via binary search.
+    OriginId::Underlying smallestOrigin = 0;
+    std::vector<uint32_t> originIndexTable;
+    std::vector<std::pair<OriginId, size_t>> sortedOrigins;
+
+    /// Node 1 is the root and node i has the children 2i and 2i+1. The leaves start at numberOfLeaves. Leaves without an origin hold the
+    /// largest watermark, so that they never determine the minimum.
+    size_t numberOfLeaves;
+    std::unique_ptr<std::atomic<uint64_t>[]> tournamentTree;
 };
 
 }
@@ -0,0 +1,57 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <Identifiers/Identifiers.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
+#include <Runtime/QueryTerminationType.hpp>
+#include <Time/Timestamp.hpp>
+#include <folly/Synchronized.h>
+
+namespace NES
+{
+
+/// Learns the out-of-orderness bound of an event-time watermark assigner per origin from the disorder of its buffers.
+/// The disorder of a buffer is the largest distance of a timestamp to a larger timestamp that precedes it in the buffer or in the buffers
+/// of the origin that finished before. A bound that is exceeded rises to the disorder right away, while a bound that is larger than the
+/// disorder decays toward it. As worker threads finish the buffers of an origin out of order, the disorder includes their reordering.
+/// The bound of an origin starts at and never exceeds the configured maximum bound.
+class OutOfOrdernessOperatorHandler final : public OperatorHandler
+{
+public:
+    explicit OutOfOrdernessOperatorHandler(uint64_t maxBoundInMs);
+
+    void start(PipelineExecutionContext& pipelineExecutionContext, uint32_t localStateVariableId) override;
+    void stop(QueryTerminationType terminationType, PipelineExecutionContext& pipelineExecutionContext) override;
+
+    /// Records the disorder of a buffer of the origin with at least one record and returns the bound of the origin afterward
+    [[nodiscard]] uint64_t updateBound(OriginId originId, Timestamp minTimestamp, Timestamp maxTimestamp, uint64_t disorderOfBuffer);
+
+private:
+    /// A bound that is larger than the disorder of a buffer moves by 1/DECAY of the difference toward it
+    static constexpr uint64_t DECAY = 16;
+
+    struct OriginState
+    {
+        Timestamp maxTimestamp = Timestamp(Timestamp::INITIAL_VALUE);
+        uint64_t boundInMs;
+    };
+
+    uint64_t maxBoundInMs;
+    folly::Synchronized<std::unordered_map<OriginId, OriginState>> origins;
+};
+
+}
@@ -15,6 +15,7 @@
 
 #include <memory>
 #include <DataTypes/TimeUnit.hpp>
+#include <Identifiers/Identifiers.hpp>
 #include <Functions/PhysicalFunction.hpp>
 #include <Nautilus/DataTypes/VarVal.hpp>
 #include <Nautilus/Interface/Record.hpp>
@@ -33,11 +34,14 @@ namespace NES
 /// @brief A time function, infers the timestamp of an record.
 /// For ingestion time, this is determined by the creation ts in the buffer.
 /// For event time, this is inferred by a field in the record.
+/// For count-based windows, this is the position of the record in the stream.
 class TimeFunction
 {
 public:
     virtual void open(ExecutionContext& ctx, RecordBuffer& buffer) const = 0;
     virtual nautilus::val<Timestamp> getTs(ExecutionContext& ctx, Record& record) const = 0;
+    /// Gets called after all records of the buffer have been processed, but before the windows get triggered
+    virtual void close(ExecutionContext& ctx, RecordBuffer& buffer) const = 0;
     virtual ~TimeFunction() = default;
 
     [[nodiscard]] virtual std::unique_ptr<TimeFunction> clone() const = 0;
@@ -49,6 +53,7 @@ public:
     explicit EventTimeFunction(PhysicalFunction timestampFunction, const Windowing::TimeUnit& unit);
     void open(ExecutionContext& ctx, RecordBuffer& buffer) const override;
     nautilus::val<Timestamp> getTs(ExecutionContext& ctx, Record& record) const override;
+    void close(ExecutionContext& ctx, RecordBuffer& buffer) const override;
 
     [[nodiscard]] std::unique_ptr<TimeFunction> clone() const override
     {
@@ -65,8 +70,25 @@ class IngestionTimeFunction final : public TimeFunction
 public:
     void open(ExecutionContext& ctx, RecordBuffer& buffer) const override;
     nautilus::val<Timestamp> getTs(ExecutionContext& ctx, Record& record) const override;
+    void close(ExecutionContext& ctx, RecordBuffer& buffer) const override;
 
     [[nodiscard]] std::unique_ptr<TimeFunction> clone() const override { return std::make_unique<IngestionTimeFunction>(); }
 };
 
+/// Assigns consecutive positions to the records via the TuplePositionTracker of the window operator handler.
+/// As the slices are built over the positions, the watermark of a buffer is replaced by the watermark over the positions.
+class CountTimeFunction final : public TimeFunction
+{
+public:
+    explicit CountTimeFunction(OperatorHandlerId operatorHandlerId);
+    void open(ExecutionContext& ctx, RecordBuffer& buffer) const override;
+    nautilus::val<Timestamp> getTs(ExecutionContext& ctx, Record& record) const override;
+    void close(ExecutionContext& ctx, RecordBuffer& buffer) const override;
+
+    [[nodiscard]] std::unique_ptr<TimeFunction> clone() const override { return std::make_unique<CountTimeFunction>(operatorHandlerId); }
+
+private:
+    OperatorHandlerId operatorHandlerId;
+};
+
 }
@@ -0,0 +1,50 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <Time/Timestamp.hpp>
+
+namespace NES
+{
+
+/// Assigns consecutive positions to the records of a count-based window operator, i.e., the n-th record gets the position n - 1.
+/// Count-based windows are sliced and triggered by these positions instead of timestamps. Thus, we need a watermark over the positions:
+/// all records with a smaller position than the watermark must have been inserted into their slices.
+/// As multiple worker threads insert records concurrently, the positions are not inserted in order. Therefore, every buffer registers
+/// itself, before its records get positions, with a lower bound of the positions that it will assign. The watermark is the smallest
+/// lower bound of all buffers that are still being processed, or the next position, if no buffer is being processed.
+/// The lock is only acquired twice per buffer, while the positions of the records are assigned without any lock.
+class TuplePositionTracker
+{
+public:
+    /// Registers a buffer, whose records will get positions, and returns a lower bound of these positions
+    [[nodiscard]] uint64_t beginBuffer();
+
+    /// Returns the position of the next record
+    [[nodiscard]] uint64_t getNextPosition();
+
+    /// Unregisters the buffer with the given lower bound and returns the watermark over the positions
+    [[nodiscard]] Timestamp finishBuffer(uint64_t lowerBound);
+
+private:
+    std::atomic<uint64_t> nextPosition{0};
+    std::mutex mutex;
+    std::multiset<uint64_t> lowerBoundsOfActiveBuffers;
+};
+
+}
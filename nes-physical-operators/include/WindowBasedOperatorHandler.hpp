@@ -20,6 +20,7 @@
 #include <memory>
 #include <vector>
 #include <Identifiers/Identifiers.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
 #include <Runtime/Execution/OperatorHandler.hpp>
 #include <Runtime/QueryTerminationType.hpp>
 #include <Sequencing/SequenceData.hpp>
@@ -27,6 +28,7 @@
 #include <SliceStore/WindowSlicesStoreInterface.hpp>
 #include <Time/Timestamp.hpp>
 #include <Watermark/MultiOriginWatermarkProcessor.hpp>
+#include <Watermark/TuplePositionTracker.hpp>
 #include <PipelineExecutionContext.hpp>
 
 namespace NES
@@ -48,6 +50,7 @@ struct BufferMetaData
     Timestamp watermarkTs;
     SequenceData seqNumber;
     OriginId originId;
+    IngestionTimestamps ingestionTimestamps;
 };
 
 /// This is the base class for all window-based operator handlers, e.g., join and aggregation.
@@ -71,6 +74,18 @@ public:
 
     WindowSlicesStoreInterface& getSliceAndWindowStore() const;
 
+    /// Assigns the positions of the records for count-based windows
+    TuplePositionTracker& getTuplePositionTracker();
+
+    /// Triggers the windows by the watermark over the positions of the TuplePositionTracker, which covers the buffers of all input
+    /// origins. Thus, origins that do not send any buffers, e.g., idle sources, do not hold back the windows.
+    void setCountBasedWindows();
+
+    /// Sets the buffer provider that allocates the state of the slices, e.g., a buffer manager that spills to local files.
+    /// If no buffer provider is set, the slices allocate their state from the buffer provider of the pipeline.
+    void setStateBufferProvider(std::shared_ptr<AbstractBufferProvider> stateBufferProvider);
+    [[nodiscard]] AbstractBufferProvider* getStateBufferProvider() const;
+
     /// Updates the corresponding watermark processor, and then garbage collects all slices and windows that are not valid anymore
     void garbageCollectSlicesAndWindows(const BufferMetaData& bufferMetaData) const;
 
@@ -97,6 +112,9 @@ protected:
     std::unique_ptr<WindowSlicesStoreInterface> sliceAndWindowStore;
     std::unique_ptr<MultiOriginWatermarkProcessor> watermarkProcessorBuild;
     std::unique_ptr<MultiOriginWatermarkProcessor> watermarkProcessorProbe;
+    TuplePositionTracker tuplePositionTracker;
+    bool countBasedWindows{false};
+    std::shared_ptr<AbstractBufferProvider> stateBufferProvider;
     uint64_t numberOfWorkerThreads;
     const OriginId outputOriginId;
     const std::vector<OriginId> inputOrigins;
@@ -65,6 +65,10 @@ public:
     void setChild(PhysicalOperator child) override;
 
 protected:
+    /// Creates the local state in open(), so that the derived builds can keep further intermediates of the current tuple buffer
+    [[nodiscard]] virtual std::unique_ptr<WindowOperatorBuildLocalState>
+    createLocalState(const nautilus::val<OperatorHandler*>& operatorHandler) const;
+
     std::optional<PhysicalOperator> child;
     const OperatorHandlerId operatorHandlerId;
     const std::unique_ptr<TimeFunction> timeFunction;
@@ -37,6 +37,10 @@ struct AggregationPhysicalFunctionRegistryArguments
     Record::RecordFieldIdentifier resultFieldIdentifier;
     std::optional<std::shared_ptr<TupleBufferRef>> bufferRefPagedVector;
     bool includeNullValues;
+    /// Only set for quantile aggregations
+    std::optional<double> quantile;
+    /// Only used by aggregations that store their records in a PagedVector, e.g., median
+    bool compressPagedVectorPages = false;
 };
 
 class AggregationPhysicalFunctionRegistry : public BaseRegistry<
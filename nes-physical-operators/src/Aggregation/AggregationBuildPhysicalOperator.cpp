@@ -20,18 +20,26 @@
 #include <utility>
 #include <vector>
 #include <Aggregation/AggregationOperatorHandler.hpp>
+#include <Aggregation/AggregationProbePhysicalOperator.hpp>
 #include <Aggregation/AggregationSlice.hpp>
 #include <Aggregation/Function/AggregationPhysicalFunction.hpp>
+#include <Aggregation/PreAggregation.hpp>
 #include <Identifiers/Identifiers.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
 #include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMapRef.hpp>
 #include <Nautilus/Interface/HashMap/HashMap.hpp>
 #include <Nautilus/Interface/Record.hpp>
+#include <Nautilus/Interface/RecordBuffer.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
 #include <SliceStore/Slice.hpp>
 #include <Time/Timestamp.hpp>
+#include <Arena.hpp>
 #include <CompilationContext.hpp>
 #include <ErrorHandling.hpp>
 #include <ExecutionContext.hpp>
+#include <HashMapOptions.hpp>
 #include <HashMapSlice.hpp>
+#include <PipelineExecutionContext.hpp>
 #include <WindowBuildPhysicalOperator.hpp>
 #include <function.hpp>
 #include <options.hpp>
@@ -40,41 +48,153 @@
 
 namespace NES
 {
+namespace
+{
+/// Remembers the entry of the previous record of the current tuple buffer, so that a run of equal keys probes the hash map only once
+class AggregationBuildLocalState final : public WindowOperatorBuildLocalState
+{
+public:
+    explicit AggregationBuildLocalState(const nautilus::val<OperatorHandler*>& operatorHandler)
+        : WindowOperatorBuildLocalState(operatorHandler), previousHashMap(nullptr), previousEntry(nullptr)
+    {
+    }
+
+    nautilus::val<HashMap*> previousHashMap;
+    nautilus::val<AbstractHashMapEntry*> previousEntry;
+};
+
+std::shared_ptr<AggregationSlice> getAggregationSlice(
+    const AggregationOperatorHandler& operatorHandler,
+    const Timestamp timestamp,
+    const WorkerThreadId workerThreadId,
+    const CreateNewHashMapSliceArgs& hashMapSliceArgs)
+{
+    const auto createFunction = operatorHandler.getCreateNewSlicesFunction(hashMapSliceArgs);
+    const auto slices = operatorHandler.getSliceAndWindowStore().getSlicesOrCreate(timestamp, workerThreadId, createFunction);
+    INVARIANT(
+        slices.size() == 1,
+        "We expect exactly one slice for the given timestamp during the AggregationBuild, as we currently solely support "
+        "slicing, but got {}",
+        slices.size());
+
+    /// Converting the slice to an AggregationSlice
+    auto aggregationSlice = std::dynamic_pointer_cast<AggregationSlice>(slices[0]);
+    INVARIANT(aggregationSlice != nullptr, "The slice should be an AggregationSlice in an AggregationBuild");
+    return aggregationSlice;
+}
+
+/// Returns nullptr, if the record is beyond the allowed lateness of the windows. Otherwise, it tracks the slice for late updates.
+std::shared_ptr<AggregationSlice> getAggregationSliceOfRecord(
+    AggregationOperatorHandler& operatorHandler,
+    const Timestamp timestamp,
+    const WorkerThreadId workerThreadId,
+    const CreateNewHashMapSliceArgs& hashMapSliceArgs)
+{
+    if (not operatorHandler.acceptsLateRecords())
+    {
+        return getAggregationSlice(operatorHandler, timestamp, workerThreadId, hashMapSliceArgs);
+    }
+    if (operatorHandler.getSliceAndWindowStore().isBeyondAllowedLateness(timestamp))
+    {
+        return nullptr;
+    }
+    auto aggregationSlice = getAggregationSlice(operatorHandler, timestamp, workerThreadId, hashMapSliceArgs);
+    operatorHandler.addUpdatedSlice(workerThreadId, aggregationSlice);
+    return aggregationSlice;
+}
+
+CreateNewHashMapSliceArgs createHashMapSliceArgs(const AggregationOperatorHandler& operatorHandler, const HashMapOptions& hashMapOptions)
+{
+    /// If a new hashmap slice is created, we need to set the cleanup function for the aggregation states
+    return CreateNewHashMapSliceArgs{
+        {operatorHandler.cleanupStateNautilusFunction},
+        hashMapOptions.keySize,
+        hashMapOptions.valueSize,
+        hashMapOptions.pageSize,
+        hashMapOptions.numberOfBuckets,
+        hashMapOptions.hashMapType};
+}
+}
+
+/// Combines the pre-aggregated keys of the worker thread into its hash map of the slice
+void combinePreAggregationProxy(
+    AggregationOperatorHandler* operatorHandler, const WorkerThreadId workerThreadId, AbstractBufferProvider* bufferProvider, Arena* arena)
+{
+    PRECONDITION(operatorHandler != nullptr, "The operator handler should not be null");
+    operatorHandler->getPreAggregation(workerThreadId)
+        .combineIntoSlice(
+            [&](HashMap* destination, HashMap* source)
+            { (*operatorHandler->combinePreAggregationNautilusFunction)(destination, source, bufferProvider, arena); },
+            [&](HashMap* hashMap) { (*operatorHandler->cleanupStateNautilusFunction)(hashMap); });
+}
+
+void finishLateRecordsOfBufferProxy(AggregationOperatorHandler* operatorHandler, const WorkerThreadId workerThreadId)
+{
+    PRECONDITION(operatorHandler != nullptr, "The operator handler should not be null");
+    operatorHandler->finishLateRecordsOfBuffer(workerThreadId);
+}
+
+void lockHashMapsOfWorkerThreadProxy(AggregationOperatorHandler* operatorHandler, const WorkerThreadId workerThreadId)
+{
+    PRECONDITION(operatorHandler != nullptr, "The operator handler should not be null");
+    operatorHandler->lockHashMapsOfWorkerThread(workerThreadId);
+}
+
+void unlockHashMapsOfWorkerThreadProxy(AggregationOperatorHandler* operatorHandler, const WorkerThreadId workerThreadId)
+{
+    PRECONDITION(operatorHandler != nullptr, "The operator handler should not be null");
+    operatorHandler->unlockHashMapsOfWorkerThread(workerThreadId);
+}
+
 HashMap* getAggHashMapProxy(
-    const AggregationOperatorHandler* operatorHandler,
+    AggregationOperatorHandler* operatorHandler,
     const Timestamp timestamp,
     const WorkerThreadId workerThreadId,
+    const uint64_t partition,
     const AggregationBuildPhysicalOperator* buildOperator)
 {
     PRECONDITION(operatorHandler != nullptr, "The operator handler should not be null");
     PRECONDITION(buildOperator != nullptr, "The build operator should not be null");
 
-    /// If a new hashmap slice is created, we need to set the cleanup function for the aggregation states
-    const CreateNewHashMapSliceArgs hashMapSliceArgs{
-        {operatorHandler->cleanupStateNautilusFunction},
-        buildOperator->hashMapOptions.keySize,
-        buildOperator->hashMapOptions.valueSize,
-        buildOperator->hashMapOptions.pageSize,
-        buildOperator->hashMapOptions.numberOfBuckets};
-    auto wrappedCreateFunction(
-        [createFunction = operatorHandler->getCreateNewSlicesFunction(hashMapSliceArgs),
-         cleanupStateNautilusFunction = operatorHandler->cleanupStateNautilusFunction](const SliceStart sliceStart, const SliceEnd sliceEnd)
-        {
-            const auto createdSlices = createFunction(sliceStart, sliceEnd);
-            return createdSlices;
-        });
+    const auto hashMapSliceArgs = createHashMapSliceArgs(*operatorHandler, buildOperator->hashMapOptions);
+    const auto aggregationSlice = getAggregationSliceOfRecord(*operatorHandler, timestamp, workerThreadId, hashMapSliceArgs);
+    if (aggregationSlice == nullptr)
+    {
+        return operatorHandler->getHashMapOfDiscardedLateRecord(workerThreadId, partition, hashMapSliceArgs);
+    }
+    return aggregationSlice->getHashMapPtrOrCreate(workerThreadId, partition);
+}
 
-    const auto hashMap = operatorHandler->getSliceAndWindowStore().getSlicesOrCreate(timestamp, wrappedCreateFunction);
-    INVARIANT(
-        hashMap.size() == 1,
-        "We expect exactly one slice for the given timestamp during the AggregationBuild, as we currently solely support "
-        "slicing, but got {}",
-        hashMap.size());
+HashMap* getPreAggregationHashMapProxy(
+    AggregationOperatorHandler* operatorHandler,
+    const Timestamp timestamp,
+    const WorkerThreadId workerThreadId,
+    AbstractBufferProvider* bufferProvider,
+    Arena* arena,
+    const AggregationBuildPhysicalOperator* buildOperator)
+{
+    PRECONDITION(operatorHandler != nullptr, "The operator handler should not be null");
+    PRECONDITION(buildOperator != nullptr, "The build operator should not be null");
 
-    /// Converting the slice to an AggregationSlice and returning the pointer to the hashmap
-    const auto aggregationSlice = std::dynamic_pointer_cast<AggregationSlice>(hashMap[0]);
-    INVARIANT(aggregationSlice != nullptr, "The slice should be an AggregationSlice in an AggregationBuild");
-    return aggregationSlice->getHashMapPtrOrCreate(workerThreadId);
+    auto& preAggregation = operatorHandler->getPreAggregation(workerThreadId);
+    if (auto* const hashMap = preAggregation.tryGetHashMap(timestamp))
+    {
+        return hashMap;
+    }
+
+    const auto hashMapSliceArgs = createHashMapSliceArgs(*operatorHandler, buildOperator->hashMapOptions);
+    auto aggregationSlice = getAggregationSliceOfRecord(*operatorHandler, timestamp, workerThreadId, hashMapSliceArgs);
+    if (aggregationSlice == nullptr)
+    {
+        return operatorHandler->getHashMapOfDiscardedLateRecord(workerThreadId, 0, hashMapSliceArgs);
+    }
+    return preAggregation.moveToSlice(
+        std::move(aggregationSlice),
+        workerThreadId,
+        hashMapSliceArgs,
+        [&](HashMap* destination, HashMap* source)
+        { (*operatorHandler->combinePreAggregationNautilusFunction)(destination, source, bufferProvider, arena); },
+        [&](HashMap* hashMap) { (*operatorHandler->cleanupStateNautilusFunction)(hashMap); });
 }
 
 void AggregationBuildPhysicalOperator::setup(ExecutionContext& executionCtx, CompilationContext& compilationContext) const
@@ -95,69 +215,158 @@ void AggregationBuildPhysicalOperator::setup(ExecutionContext& executionCtx, Com
                 [copyOfHashMapOptions = hashMapOptions,
                  copyOfAggregationFunctions = aggregationPhysicalFunctions](nautilus::val<HashMap*> hashMap)
                 {
-                    const ChainedHashMapRef hashMapRef(
+                    copyOfHashMapOptions.visitHashMapRef(
                         hashMap,
-                        copyOfHashMapOptions.fieldKeys,
-                        copyOfHashMapOptions.fieldValues,
-                        copyOfHashMapOptions.entriesPerPage,
-                        copyOfHashMapOptions.entrySize);
-                    for (const auto entry : hashMapRef)
-                    {
-                        const ChainedHashMapRef::ChainedEntryRef entryRefReset(
-                            entry, hashMap, copyOfHashMapOptions.fieldKeys, copyOfHashMapOptions.fieldValues);
-                        auto state = static_cast<nautilus::val<AggregationState*>>(entryRefReset.getValueMemArea());
-                        for (const auto& aggFunction : nautilus::static_iterable(copyOfAggregationFunctions))
+                        [&](const auto& hashMapRef)
                         {
-                            aggFunction->cleanup(state);
-                            state = state + aggFunction->getSizeOfStateInBytes();
-                        }
-                    }
+                            for (const auto entry : hashMapRef)
+                            {
+                                const ChainedHashMapRef::ChainedEntryRef entryRefReset(
+                                    entry, hashMap, copyOfHashMapOptions.fieldKeys, copyOfHashMapOptions.fieldValues);
+                                auto state = static_cast<nautilus::val<AggregationState*>>(entryRefReset.getValueMemArea());
+                                for (const auto& aggFunction : nautilus::static_iterable(copyOfAggregationFunctions))
+                                {
+                                    aggFunction->cleanup(state);
+                                    state = state + aggFunction->getSizeOfStateInBytes();
+                                }
+                            }
+                        });
                 })));
+        if (preAggregation)
+        {
+            operatorHandler->combinePreAggregationNautilusFunction
+                = std::make_shared<AggregationOperatorHandler::NautilusCombineExec>(compilationContext.registerFunction(std::function(
+                    [copyOfHashMapOptions = hashMapOptions, copyOfAggregationFunctions = aggregationPhysicalFunctions](
+                        nautilus::val<HashMap*> destinationHashMap,
+                        nautilus::val<HashMap*> sourceHashMap,
+                        nautilus::val<AbstractBufferProvider*> bufferProvider,
+                        nautilus::val<Arena*> arena)
+                    {
+                        PipelineMemoryProvider pipelineMemoryProvider(arena, bufferProvider);
+                        combineHashMaps(
+                            destinationHashMap, sourceHashMap, copyOfHashMapOptions, copyOfAggregationFunctions, pipelineMemoryProvider);
+                    })));
+        }
+        if (operatorHandler->takesCheckpoints())
+        {
+            /// The restored slices require the cleanup function, thus we restore them after registering it
+            auto* const pipelineContext
+                = nautilus::details::RawValueResolver<PipelineExecutionContext*>::getRawValue(executionCtx.pipelineContext);
+            auto* const bufferProvider = operatorHandler->getStateBufferProvider() != nullptr
+                ? operatorHandler->getStateBufferProvider()
+                : pipelineContext->getBufferManager()->getStateBufferProvider();
+            operatorHandler->restoreCheckpoint(
+                createHashMapSliceArgs(*operatorHandler, hashMapOptions), bufferProvider, pipelineContext->getNumberOfWorkerThreads());
+        }
     }
-
-
     /// NOLINTEND(performance-unnecessary-value-param)
 }
 
+void AggregationBuildPhysicalOperator::open(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const
+{
+    WindowBuildPhysicalOperator::open(executionCtx, recordBuffer);
+    if (lockHashMaps)
+    {
+        auto* const localState = dynamic_cast<WindowOperatorBuildLocalState*>(executionCtx.getLocalState(id));
+        invoke(lockHashMapsOfWorkerThreadProxy, localState->getOperatorHandler(), executionCtx.workerThreadId);
+    }
+}
+
 void AggregationBuildPhysicalOperator::execute(ExecutionContext& ctx, Record& record) const
 {
     /// Getting the operator handler from the local state
     auto* const localState = dynamic_cast<WindowOperatorBuildLocalState*>(ctx.getLocalState(id));
     auto operatorHandler = localState->getOperatorHandler();
 
-    /// Getting the correspinding slice so that we can update the aggregation states
-    const auto timestamp = timeFunction->getTs(ctx, record);
-    const auto hashMapPtr = invoke(
-        getAggHashMapProxy, operatorHandler, timestamp, ctx.workerThreadId, nautilus::val<const AggregationBuildPhysicalOperator*>(this));
-    ChainedHashMapRef hashMap(
-        hashMapPtr, hashMapOptions.fieldKeys, hashMapOptions.fieldValues, hashMapOptions.entriesPerPage, hashMapOptions.entrySize);
-
     /// Calling the key functions to add/update the keys to the record
+    std::vector<VarVal> keyValues;
     for (nautilus::static_val<uint64_t> i = 0; i < hashMapOptions.fieldKeys.size(); ++i)
     {
-        const auto& [fieldIdentifier, type, fieldOffset] = hashMapOptions.fieldKeys[i];
+        const auto& [fieldIdentifier, type, fieldOffset, varSizedDictionary] = hashMapOptions.fieldKeys[i];
         const auto& function = hashMapOptions.keyFunctions[i];
         const auto value = function.execute(record, ctx.pipelineMemoryProvider.arena);
         record.write(fieldIdentifier, value);
+        keyValues.emplace_back(value);
     }
 
-    /// Finding or creating the entry for the provided record
-    const auto hashMapEntry = hashMap.findOrCreateEntry(
-        record,
-        *hashMapOptions.hashFunction,
-        [&](const nautilus::val<AbstractHashMapEntry*>& entry)
+    const auto partition = hashMapOptions.getPartition(keyValues, numberOfPartitions);
+
+    /// Getting the correspinding slice (or the pre-aggregation of this worker thread) so that we can update the aggregation states
+    const auto timestamp = timeFunction->getTs(ctx, record);
+    nautilus::val<HashMap*> hashMapPtr{nullptr};
+    if (preAggregation)
+    {
+        hashMapPtr = invoke(
+            getPreAggregationHashMapProxy,
+            operatorHandler,
+            timestamp,
+            ctx.workerThreadId,
+            ctx.pipelineMemoryProvider.bufferProvider,
+            ctx.pipelineMemoryProvider.arena.getArena(),
+            nautilus::val<const AggregationBuildPhysicalOperator*>(this));
+    }
+    else
+    {
+        hashMapPtr = invoke(
+            getAggHashMapProxy,
+            operatorHandler,
+            timestamp,
+            ctx.workerThreadId,
+            partition,
+            nautilus::val<const AggregationBuildPhysicalOperator*>(this));
+    }
+
+    /// Reusing the entry of the previous record, if the record continues its run of equal keys. The entries do not move, while the hash
+    /// maps grow, and the slices outlive the tuple buffer, thus the previous entry stays valid.
+    nautilus::val<AbstractHashMapEntry*> hashMapEntry{nullptr};
+    nautilus::val<bool> continuesRun{false};
+    if (clusteredKeys)
+    {
+        const auto* const runState = dynamic_cast<AggregationBuildLocalState*>(localState);
+        if (runState->previousHashMap == hashMapPtr)
         {
-            /// If the entry for the provided keys does not exist, we need to create a new one and initialize the aggregation states
-            const ChainedHashMapRef::ChainedEntryRef entryRefReset(entry, hashMapPtr, hashMapOptions.fieldKeys, hashMapOptions.fieldValues);
-            auto state = static_cast<nautilus::val<AggregationState*>>(entryRefReset.getValueMemArea());
-            for (const auto& aggFunction : nautilus::static_iterable(aggregationPhysicalFunctions))
+            const ChainedHashMapRef::ChainedEntryRef previousEntryRef(
+                runState->previousEntry, hashMapPtr, hashMapOptions.fieldKeys, hashMapOptions.fieldValues);
+            if (previousEntryRef.compareKeys(record))
             {
-                aggFunction->reset(state, ctx.pipelineMemoryProvider);
-                state = state + aggFunction->getSizeOfStateInBytes();
+                hashMapEntry = runState->previousEntry;
+                continuesRun = true;
             }
-        },
-        ctx.pipelineMemoryProvider.bufferProvider);
+        }
+    }
 
+    /// Finding or creating the entry for the provided record
+    if (not continuesRun)
+    {
+        hashMapEntry = hashMapOptions.visitHashMapRef(
+            hashMapPtr,
+            [&](auto& hashMap)
+            {
+                return hashMap.findOrCreateEntry(
+                    record,
+                    *hashMapOptions.hashFunction,
+                    [&](const nautilus::val<AbstractHashMapEntry*>& entry)
+                    {
+                        /// If the entry for the provided keys does not exist, we need to create a new one and initialize the aggregation
+                        /// states
+                        const ChainedHashMapRef::ChainedEntryRef entryRefReset(
+                            entry, hashMapPtr, hashMapOptions.fieldKeys, hashMapOptions.fieldValues);
+                        auto state = static_cast<nautilus::val<AggregationState*>>(entryRefReset.getValueMemArea());
+                        for (const auto& aggFunction : nautilus::static_iterable(aggregationPhysicalFunctions))
+                        {
+                            aggFunction->reset(state, ctx.pipelineMemoryProvider);
+                            state = state + aggFunction->getSizeOfStateInBytes();
+                        }
+                    },
+                    ctx.pipelineMemoryProvider.bufferProvider);
+            });
+    }
+    if (clusteredKeys)
+    {
+        auto* const runState = dynamic_cast<AggregationBuildLocalState*>(localState);
+        runState->previousHashMap = hashMapPtr;
+        runState->previousEntry = hashMapEntry;
+    }
 
     /// Updating the aggregation states
     const ChainedHashMapRef::ChainedEntryRef entryRef(hashMapEntry, hashMapPtr, hashMapOptions.fieldKeys, hashMapOptions.fieldValues);
@@ -169,15 +378,67 @@ void AggregationBuildPhysicalOperator::execute(ExecutionContext& ctx, Record& re
     }
 }
 
+void AggregationBuildPhysicalOperator::close(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const
+{
+    auto* const localState = dynamic_cast<WindowOperatorBuildLocalState*>(executionCtx.getLocalState(id));
+    if (preAggregation)
+    {
+        /// The window trigger of this buffer must see all of its records in the slices
+        invoke(
+            combinePreAggregationProxy,
+            localState->getOperatorHandler(),
+            executionCtx.workerThreadId,
+            executionCtx.pipelineMemoryProvider.bufferProvider,
+            executionCtx.pipelineMemoryProvider.arena.getArena());
+    }
+    if (acceptsLateRecords)
+    {
+        /// Marks the triggered windows, which the records of this buffer updated, before the trigger of this buffer
+        invoke(finishLateRecordsOfBufferProxy, localState->getOperatorHandler(), executionCtx.workerThreadId);
+    }
+    if (lockHashMaps)
+    {
+        /// The early results, the checkpoints, and the snapshots of windows accepting late records read the hash maps of all worker
+        /// threads, which requires the locks of the hash maps
+        invoke(unlockHashMapsOfWorkerThreadProxy, localState->getOperatorHandler(), executionCtx.workerThreadId);
+    }
+    WindowBuildPhysicalOperator::close(executionCtx, recordBuffer);
+}
+
 AggregationBuildPhysicalOperator::AggregationBuildPhysicalOperator(
     const OperatorHandlerId operatorHandlerId,
     std::unique_ptr<TimeFunction> timeFunction,
     std::vector<std::shared_ptr<AggregationPhysicalFunction>> aggregationFunctions,
-    HashMapOptions hashMapOptions)
+    HashMapOptions hashMapOptions,
+    const uint64_t numberOfPartitions,
+    const bool preAggregation,
+    const bool lockHashMaps,
+    const bool acceptsLateRecords,
+    const bool clusteredKeys)
     : WindowBuildPhysicalOperator(operatorHandlerId, std::move(timeFunction))
     , aggregationPhysicalFunctions(std::move(aggregationFunctions))
     , hashMapOptions(std::move(hashMapOptions))
+    , numberOfPartitions(numberOfPartitions)
+    , preAggregation(preAggregation)
+    , lockHashMaps(lockHashMaps)
+    , acceptsLateRecords(acceptsLateRecords)
+    , clusteredKeys(clusteredKeys)
 {
+    PRECONDITION(numberOfPartitions > 0, "The aggregation build requires at least one partition");
+    PRECONDITION(not preAggregation or numberOfPartitions == 1, "The pre-aggregation does not support partitioned hash maps");
+    PRECONDITION(not acceptsLateRecords or lockHashMaps, "Late records require the locks of the hash maps");
+    /// The pre-aggregation clears its hash map, when it moves to the next slice, which would invalidate the entry of the previous record
+    PRECONDITION(not clusteredKeys or not preAggregation, "The pre-aggregation does not support clustered keys");
+}
+
+std::unique_ptr<WindowOperatorBuildLocalState>
+AggregationBuildPhysicalOperator::createLocalState(const nautilus::val<OperatorHandler*>& operatorHandler) const
+{
+    if (clusteredKeys)
+    {
+        return std::make_unique<AggregationBuildLocalState>(operatorHandler);
+    }
+    return WindowBuildPhysicalOperator::createLocalState(operatorHandler);
 }
 
 }
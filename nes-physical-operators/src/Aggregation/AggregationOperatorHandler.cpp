@@ -16,24 +16,39 @@
 #include <algorithm>
 #include <bit>
 #include <chrono>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <filesystem>
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
 #include <utility>
 #include <vector>
 #include <Aggregation/AggregationSlice.hpp>
+#include <Aggregation/AggregationStateCheckpoint.hpp>
+#include <Aggregation/PreAggregation.hpp>
+#include <Aggregation/SlidingWindowAggregates.hpp>
 #include <Identifiers/Identifiers.hpp>
 #include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMap.hpp>
 #include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/QueryTerminationType.hpp>
 #include <Runtime/TupleBuffer.hpp>
 #include <SliceStore/Slice.hpp>
 #include <SliceStore/WindowSlicesStoreInterface.hpp>
+#include <Time/Timestamp.hpp>
 #include <Util/Logger/Logger.hpp>
+#include <folly/Synchronized.h>
+#include <Arena.hpp>
 #include <ErrorHandling.hpp>
+#include <HashMapSlice.hpp>
 #include <PipelineExecutionContext.hpp>
+#include <Thread.hpp>
 #include <WindowBasedOperatorHandler.hpp>
 
 namespace NES
@@ -43,12 +58,371 @@ AggregationOperatorHandler::AggregationOperatorHandler(
     const std::vector<OriginId>& inputOrigins,
     const OriginId outputOriginId,
     std::unique_ptr<WindowSlicesStoreInterface> sliceAndWindowStore,
-    const uint64_t maxNumberOfBuckets)
+    const uint64_t maxNumberOfBuckets,
+    const uint64_t numberOfPartitions,
+    const bool shareSlidingWindowAggregates,
+    const std::optional<std::chrono::milliseconds> earlyResultInterval)
     : WindowBasedOperatorHandler(inputOrigins, outputOriginId, std::move(sliceAndWindowStore))
     , setupAlreadyCalled(false)
     , rollingAverageNumberOfKeys(RollingAverage<uint64_t>{100})
     , maxNumberOfBuckets(maxNumberOfBuckets)
+    , numberOfPartitions(numberOfPartitions)
+    , hashMapGrowthStatistics(std::make_shared<folly::Synchronized<HashMapGrowthStatistics>>())
+    , hashMapPool(std::make_shared<HashMapPool>())
+    , earlyResultInterval(earlyResultInterval)
 {
+    PRECONDITION(numberOfPartitions > 0, "The aggregation requires at least one partition");
+    PRECONDITION(earlyResultInterval.value_or(std::chrono::milliseconds(1)).count() > 0, "The interval of early results must be positive");
+    const auto windowSize = getSliceAndWindowStore().getWindowSize();
+    const auto windowSlide = getSliceAndWindowStore().getWindowSlide();
+    if (shareSlidingWindowAggregates and SlidingWindowAggregates::isBeneficial(windowSize, windowSlide))
+    {
+        slidingWindowAggregates = std::make_unique<SlidingWindowAggregates>(windowSize, windowSlide, numberOfPartitions);
+    }
+}
+
+bool AggregationOperatorHandler::sharesSlidingWindowAggregates() const
+{
+    return slidingWindowAggregates != nullptr;
+}
+
+void AggregationOperatorHandler::start(PipelineExecutionContext& pipelineExecutionContext, const uint32_t localStateVariableId)
+{
+    WindowBasedOperatorHandler::start(pipelineExecutionContext, localStateVariableId);
+    /// The handler gets started by each of its pipelines
+    if (preAggregations.size() != numberOfWorkerThreads)
+    {
+        preAggregations = std::vector<PreAggregation>(numberOfWorkerThreads);
+    }
+    if ((earlyResultInterval.has_value() or takesCheckpoints() or acceptsLateRecords()) and hashMapsLocks.size() != numberOfWorkerThreads)
+    {
+        hashMapsLocks = std::vector<HashMapsLock>(numberOfWorkerThreads);
+    }
+    if (acceptsLateRecords() and lateRecords.size() != numberOfWorkerThreads)
+    {
+        lateRecords = std::vector<LateRecords>(numberOfWorkerThreads);
+    }
+    if (earlyResultInterval.has_value())
+    {
+        nextEarlyResults = std::chrono::steady_clock::now() + earlyResultInterval.value();
+    }
+}
+
+void AggregationOperatorHandler::stop(const QueryTerminationType queryTerminationType, PipelineExecutionContext& pipelineExecutionContext)
+{
+    WindowBasedOperatorHandler::stop(queryTerminationType, pipelineExecutionContext);
+    if (const auto numberOfDiscarded = numberOfDiscardedLateRecords.load(); numberOfDiscarded > 0)
+    {
+        NES_WARNING(
+            "Discarded {} records beyond the allowed lateness of {}ms for output origin {}",
+            numberOfDiscarded,
+            getSliceAndWindowStore().getAllowedLateness().value_or(0),
+            outputOriginId);
+    }
+    logHashMapGrowthStatistics(getHashMapGrowthStatistics(), outputOriginId);
+    if (checkpoint == nullptr)
+    {
+        return;
+    }
+    /// Joins the thread that takes the checkpoints
+    checkpointThread = Thread();
+    if (queryTerminationType == QueryTerminationType::Graceful)
+    {
+        takeCheckpoint();
+    }
+}
+
+void AggregationOperatorHandler::enableCheckpoints(std::filesystem::path directory, const std::chrono::milliseconds interval)
+{
+    PRECONDITION(not directory.empty(), "The checkpoints require a directory");
+    PRECONDITION(interval.count() > 0, "The interval of the checkpoints must be positive");
+    checkpointDirectory = std::move(directory);
+    checkpointInterval = interval;
+}
+
+bool AggregationOperatorHandler::takesCheckpoints() const
+{
+    return not checkpointDirectory.empty();
+}
+
+void AggregationOperatorHandler::restoreCheckpoint(
+    const CreateNewHashMapSliceArgs& newHashMapSliceArgs, AbstractBufferProvider* bufferProvider, const uint64_t numberOfWorkerThreads)
+{
+    PRECONDITION(takesCheckpoints(), "Restoring a checkpoint requires the checkpoints to be enabled");
+    PRECONDITION(checkpoint == nullptr, "The checkpoint has been restored already");
+    /// The setup of the build might run before the probe starts the handler
+    if (this->numberOfWorkerThreads == 0)
+    {
+        setWorkerThreads(numberOfWorkerThreads);
+    }
+    if (hashMapsLocks.size() != this->numberOfWorkerThreads)
+    {
+        hashMapsLocks = std::vector<HashMapsLock>(this->numberOfWorkerThreads);
+    }
+
+    const AggregationStateCheckpoint::Layout layout{
+        .entrySize = sizeof(ChainedHashMapEntry) + newHashMapSliceArgs.keySize + newHashMapSliceArgs.valueSize,
+        .numberOfPartitions = numberOfPartitions};
+    checkpoint = std::make_unique<AggregationStateCheckpoint>(checkpointDirectory, layout);
+    if (const auto restoredState = checkpoint->restore())
+    {
+        const auto createNewSlices = getCreateNewSlicesFunction(newHashMapSliceArgs);
+        uint64_t numberOfRestoredPages = 0;
+        for (const auto& [key, entries] : restoredState->pages)
+        {
+            const auto slice = std::dynamic_pointer_cast<AggregationSlice>(
+                getSliceAndWindowStore().getSlicesOrCreate(key.sliceStart, INVALID<WorkerThreadId>, createNewSlices).at(0));
+            if (slice->getSliceStart() != key.sliceStart or slice->getSliceEnd() != key.sliceEnd)
+            {
+                /// The windows of the query changed since the checkpoint
+                continue;
+            }
+            /// With fewer worker threads than before, a hash map receives the entries of multiple hash maps of the checkpoint. This does
+            /// not change the results, as all consumers of the hash maps combine every entry on its own.
+            const WorkerThreadId workerThreadId((key.hashMapIndex / numberOfPartitions) % this->numberOfWorkerThreads);
+            auto* const hashMap
+                = dynamic_cast<ChainedHashMap*>(slice->getHashMapPtrOrCreate(workerThreadId, key.hashMapIndex % numberOfPartitions));
+            INVARIANT(hashMap != nullptr, "The checkpoints require chained hash maps");
+            hashMap->insertCopiesOfEntries(entries, bufferProvider);
+            ++numberOfRestoredPages;
+        }
+        /// The windows that had been triggered before the checkpoint contain some of the restored slices
+        getSliceAndWindowStore().skipWindowsEndingBefore(restoredState->earliestWindowEnd);
+        NES_INFO(
+            "Restored {} of {} pages of the checkpoint in {} for output origin {}",
+            numberOfRestoredPages,
+            restoredState->pages.size(),
+            checkpointDirectory.string(),
+            outputOriginId);
+    }
+    checkpointThread = Thread("agg-checkpoint", [this](const std::stop_token& stopToken) { takeCheckpoints(stopToken); });
+}
+
+void AggregationOperatorHandler::takeCheckpoints(const std::stop_token& stopToken)
+{
+    std::mutex waitMutex;
+    std::condition_variable_any wakeUp;
+    while (not stopToken.stop_requested())
+    {
+        std::unique_lock lock(waitMutex);
+        wakeUp.wait_for(lock, stopToken, checkpointInterval, [] { return false; });
+        lock.unlock();
+        if (not stopToken.stop_requested())
+        {
+            takeCheckpoint();
+        }
+    }
+}
+
+void AggregationOperatorHandler::takeCheckpoint()
+{
+    const auto start = std::chrono::steady_clock::now();
+    const auto [slices, earliestWindowEnd] = getSliceAndWindowStore().getSlicesOfFillingWindows();
+    for (uint64_t worker = 0; worker < hashMapsLocks.size(); ++worker)
+    {
+        const std::scoped_lock hashMapsLock(hashMapsLocks[worker].mutex);
+        for (const auto& slice : slices)
+        {
+            checkpoint->copyChangedPages(dynamic_cast<const AggregationSlice&>(*slice), WorkerThreadId(worker));
+        }
+    }
+    try
+    {
+        checkpoint->commit(earliestWindowEnd);
+        NES_DEBUG(
+            "Checkpointed {} slices with {}B of changed pages in {}ms for output origin {}",
+            slices.size(),
+            checkpoint->getBytesOfLastCommit(),
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count(),
+            outputOriginId);
+    }
+    catch (...)
+    {
+        /// The query keeps on running with the previous checkpoint
+        tryLogCurrentException();
+    }
+}
+
+bool AggregationOperatorHandler::emitsEarlyResults() const
+{
+    return earlyResultInterval.has_value();
+}
+
+bool AggregationOperatorHandler::acceptsLateRecords() const
+{
+    return getSliceAndWindowStore().getAllowedLateness().has_value();
+}
+
+void AggregationOperatorHandler::addUpdatedSlice(const WorkerThreadId workerThreadId, const std::shared_ptr<AggregationSlice>& slice)
+{
+    auto& updatedSlices = lateRecords[workerThreadId % lateRecords.size()].updatedSlices;
+    /// The records of a buffer mostly update the same slice one after another
+    if (updatedSlices.empty() or updatedSlices.back() != slice)
+    {
+        updatedSlices.emplace_back(slice);
+    }
+}
+
+void AggregationOperatorHandler::finishLateRecordsOfBuffer(const WorkerThreadId workerThreadId)
+{
+    auto& [updatedSlices, discardedRecords] = lateRecords[workerThreadId % lateRecords.size()];
+    getSliceAndWindowStore().markWindowsWithLateUpdates(std::vector<std::shared_ptr<Slice>>(updatedSlices.begin(), updatedSlices.end()));
+    updatedSlices.clear();
+    /// Destroying the slice cleans up the aggregation states of the discarded records
+    discardedRecords.reset();
+}
+
+HashMap* AggregationOperatorHandler::getHashMapOfDiscardedLateRecord(
+    const WorkerThreadId workerThreadId, const uint64_t partition, const CreateNewHashMapSliceArgs& newHashMapSliceArgs)
+{
+    numberOfDiscardedLateRecords.fetch_add(1, std::memory_order_relaxed);
+    auto& discardedRecords = lateRecords[workerThreadId % lateRecords.size()].discardedRecords;
+    if (discardedRecords == nullptr)
+    {
+        const auto createNewSlices = getCreateNewSlicesFunction(newHashMapSliceArgs);
+        discardedRecords = std::dynamic_pointer_cast<AggregationSlice>(
+            createNewSlices(SliceStart(Timestamp::INITIAL_VALUE), SliceEnd(Timestamp::INITIAL_VALUE)).at(0));
+    }
+    return discardedRecords->getHashMapPtrOrCreate(workerThreadId, partition);
+}
+
+void AggregationOperatorHandler::lockHashMapsOfWorkerThread(const WorkerThreadId workerThreadId)
+{
+    INVARIANT(not hashMapsLocks.empty(), "The locks are created, once the operator handler is started");
+    hashMapsLocks[workerThreadId % hashMapsLocks.size()].mutex.lock();
+}
+
+void AggregationOperatorHandler::unlockHashMapsOfWorkerThread(const WorkerThreadId workerThreadId)
+{
+    hashMapsLocks[workerThreadId % hashMapsLocks.size()].mutex.unlock();
+}
+
+void AggregationOperatorHandler::checkAndTriggerWindows(const BufferMetaData& bufferMetaData, PipelineExecutionContext* pipelineCtx)
+{
+    WindowBasedOperatorHandler::checkAndTriggerWindows(bufferMetaData, pipelineCtx);
+    if (not earlyResultInterval.has_value())
+    {
+        return;
+    }
+
+    /// Solely the worker thread that moves the next point in time forward emits the early results of this interval.
+    /// We check the interval on the arrival of buffers, as the early results of a window only change, if it receives records.
+    const auto now = std::chrono::steady_clock::now();
+    auto nextEarlyResultsExpected = nextEarlyResults.load();
+    if (now < nextEarlyResultsExpected
+        or not nextEarlyResults.compare_exchange_strong(nextEarlyResultsExpected, now + earlyResultInterval.value()))
+    {
+        return;
+    }
+    emitEarlyResults(pipelineCtx);
+}
+
+void AggregationOperatorHandler::emitEarlyResults(PipelineExecutionContext* pipelineCtx)
+{
+    /// A previous emission that has not finished yet will emit the current state anyway
+    const std::unique_lock earlyResultsLock(earlyResultsMutex, std::try_to_lock);
+    if (not earlyResultsLock.owns_lock() or combineStateNautilusFunction == nullptr)
+    {
+        return;
+    }
+
+    const auto bufferProvider = pipelineCtx->getBufferManager();
+    Arena arena(bufferProvider);
+
+    /// Windows that get triggered later end at or after the current watermark, i.e., they start at or after the watermark minus the
+    /// window size. Thus, the early results do not move the watermark past any of them.
+    const auto currentWatermark = watermarkProcessorBuild->getCurrentWatermark().getRawValue();
+    const auto windowSize = getSliceAndWindowStore().getWindowSize();
+    const Timestamp watermark(currentWatermark - std::min(currentWatermark, windowSize));
+
+    std::map<WindowInfo, std::shared_ptr<const PartialAggregate>> earlyResults;
+    for (const auto& [windowInfo, allSlices] : getSliceAndWindowStore().getFillingWindowSlices())
+    {
+        auto snapshot = combineIntoSnapshot(allSlices, bufferProvider.get(), arena);
+        const auto previousEarlyResult = previousEarlyResults.find(windowInfo.windowInfo);
+        const auto previousSnapshot = previousEarlyResult == previousEarlyResults.end() ? nullptr : previousEarlyResult->second;
+        emitSnapshotToProbe(windowInfo, allSlices, snapshot, previousSnapshot, watermark, pipelineCtx);
+        earlyResults.emplace(windowInfo.windowInfo, std::move(snapshot));
+    }
+    /// Drops the early results of all windows that got triggered in the meantime
+    previousEarlyResults = std::move(earlyResults);
+}
+
+std::shared_ptr<PartialAggregate> AggregationOperatorHandler::combineIntoSnapshot(
+    const std::vector<std::shared_ptr<Slice>>& slices, AbstractBufferProvider* bufferProvider, Arena& arena) const
+{
+    auto snapshot = std::make_shared<PartialAggregate>(
+        numberOfPartitions,
+        [cleanupStateNautilusFunction = cleanupStateNautilusFunction](HashMap* hashMap) { (*cleanupStateNautilusFunction)(hashMap); });
+    for (uint64_t worker = 0; worker < hashMapsLocks.size(); ++worker)
+    {
+        const std::scoped_lock hashMapsLock(hashMapsLocks[worker].mutex);
+        for (const auto& slice : slices)
+        {
+            const auto aggregationSlice = std::dynamic_pointer_cast<AggregationSlice>(slice);
+            for (uint64_t partition = 0; partition < numberOfPartitions; ++partition)
+            {
+                auto* hashMap = aggregationSlice->getHashMapPtr(WorkerThreadId(worker), partition);
+                if (hashMap != nullptr and hashMap->getNumberOfTuples() > 0)
+                {
+                    (*combineStateNautilusFunction)(snapshot->getHashMapPtrOrCreate(partition, *hashMap), hashMap, bufferProvider, &arena);
+                }
+            }
+        }
+    }
+    return snapshot;
+}
+
+void AggregationOperatorHandler::emitSnapshotToProbe(
+    const WindowInfoAndSequenceNumber& windowInfo,
+    const std::vector<std::shared_ptr<Slice>>& slices,
+    const std::shared_ptr<const PartialAggregate>& snapshot,
+    const std::shared_ptr<const PartialAggregate>& previousSnapshot,
+    const Timestamp watermark,
+    PipelineExecutionContext* pipelineCtx) const
+{
+    IngestionTimestamps ingestionTimestamps;
+    for (const auto& slice : slices)
+    {
+        ingestionTimestamps.merge(slice->getIngestionTimestamps());
+    }
+    const WindowPartialAggregates partialAggregates{.suffix = nullptr, .prefix = snapshot};
+    for (uint64_t partition = 0; partition < numberOfPartitions; ++partition)
+    {
+        std::vector<HashMap*> allHashMaps;
+        if (snapshot->getHashMapPtr(partition) != nullptr)
+        {
+            allHashMaps.emplace_back(snapshot->getHashMapPtr(partition));
+        }
+        emitPartitionToProbe(
+            windowInfo, partition, allHashMaps, partialAggregates, previousSnapshot, ingestionTimestamps, watermark, pipelineCtx);
+    }
+}
+
+void AggregationOperatorHandler::triggerWindowsAcceptingLateRecords(
+    const std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>>& slicesAndWindowInfo,
+    PipelineExecutionContext* pipelineCtx)
+{
+    INVARIANT(combineStateNautilusFunction != nullptr, "The probe registers the combine function for windows that accept late records");
+    const auto bufferProvider = pipelineCtx->getBufferManager();
+    Arena arena(bufferProvider);
+
+    /// Holding the lock while emitting guarantees that every emission of a window solely contains the changes to the previous one
+    const std::scoped_lock emittedSnapshotsLock(emittedSnapshotsMutex);
+    for (const auto& [windowInfo, allSlices] : slicesAndWindowInfo)
+    {
+        auto snapshot = combineIntoSnapshot(allSlices, bufferProvider.get(), arena);
+        auto& emittedSnapshot = emittedSnapshots[windowInfo.windowInfo];
+        emitSnapshotToProbe(windowInfo, allSlices, snapshot, emittedSnapshot, windowInfo.windowInfo.windowStart, pipelineCtx);
+        emittedSnapshot = std::move(snapshot);
+    }
+
+    /// Late records do not update windows after their allowed lateness passed, c.f, WindowSlicesStoreInterface::markWindowsWithLateUpdates
+    const auto allowedLateness = getSliceAndWindowStore().getAllowedLateness().value_or(0);
+    const auto currentWatermark = watermarkProcessorBuild->getCurrentWatermark();
+    std::erase_if(
+        emittedSnapshots,
+        [&](const auto& emittedSnapshot) { return emittedSnapshot.first.windowEnd + allowedLateness < currentWatermark; });
 }
 
 std::function<std::vector<std::shared_ptr<Slice>>(SliceStart, SliceEnd)>
@@ -57,89 +431,176 @@ AggregationOperatorHandler::getCreateNewSlicesFunction(const CreateNewSlicesArgu
     PRECONDITION(
         numberOfWorkerThreads > 0, "Number of worker threads not set for window based operator. Was setWorkerThreads() being called?");
     auto newHashMapArgs = dynamic_cast<const CreateNewHashMapSliceArgs&>(newSlicesArguments);
-    newHashMapArgs.numberOfBuckets = std::clamp(rollingAverageNumberOfKeys.rlock()->getAverage(), 1UL, maxNumberOfBuckets);
+    newHashMapArgs.numberOfBuckets
+        = getNumberOfBucketsOfObservedKeys(*rollingAverageNumberOfKeys.rlock(), newHashMapArgs.numberOfBuckets, maxNumberOfBuckets);
+    newHashMapArgs.growthStatistics = hashMapGrowthStatistics;
+    newHashMapArgs.hashMapPool = hashMapPool;
     return std::function(
-        [outputOriginId = outputOriginId, numberOfWorkerThreads = numberOfWorkerThreads, copyOfNewHashMapArgs = newHashMapArgs](
-            SliceStart sliceStart, SliceEnd sliceEnd) -> std::vector<std::shared_ptr<Slice>>
+        [outputOriginId = outputOriginId,
+         numberOfWorkerThreads = numberOfWorkerThreads,
+         numberOfPartitions = numberOfPartitions,
+         copyOfNewHashMapArgs = newHashMapArgs](SliceStart sliceStart, SliceEnd sliceEnd) -> std::vector<std::shared_ptr<Slice>>
         {
             NES_TRACE("Creating new aggregation slice with for slice {}-{} for output origin {}", sliceStart, sliceEnd, outputOriginId);
-            return {std::make_shared<AggregationSlice>(sliceStart, sliceEnd, copyOfNewHashMapArgs, numberOfWorkerThreads)};
+            return {std::make_shared<AggregationSlice>(
+                sliceStart, sliceEnd, copyOfNewHashMapArgs, numberOfWorkerThreads, numberOfPartitions)};
         });
 }
 
+PreAggregation& AggregationOperatorHandler::getPreAggregation(const WorkerThreadId workerThreadId)
+{
+    INVARIANT(not preAggregations.empty(), "The pre-aggregations are created, once the operator handler is started");
+    return preAggregations[workerThreadId % preAggregations.size()];
+}
+
+HashMapGrowthStatistics AggregationOperatorHandler::getHashMapGrowthStatistics() const
+{
+    return *hashMapGrowthStatistics->rlock();
+}
+
+void AggregationOperatorHandler::emitPartitionToProbe(
+    const WindowInfoAndSequenceNumber& windowInfo,
+    const uint64_t partition,
+    const std::vector<HashMap*>& allHashMaps,
+    const WindowPartialAggregates& partialAggregates,
+    const std::shared_ptr<const PartialAggregate>& previousEarlyResult,
+    const IngestionTimestamps& ingestionTimestamps,
+    const Timestamp watermark,
+    PipelineExecutionContext* pipelineCtx) const
+{
+    std::unique_ptr<HashMap> finalHashMap;
+    uint64_t totalNumberOfTuples = 0;
+    for (const auto* hashMap : allHashMaps)
+    {
+        totalNumberOfTuples += hashMap->getNumberOfTuples();
+        if (not finalHashMap)
+        {
+            finalHashMap = hashMap->createNewMapWithSameConfiguration();
+        }
+    }
+    HashMap* previousHashMapPtr = previousEarlyResult == nullptr ? nullptr : previousEarlyResult->getHashMapPtr(partition);
+
+    /// We need a buffer that is large enough to store:
+    /// - all pointers to all hashmaps of the partition of the window to be triggered
+    /// - a new hashmap for the probe operator, so that we are not overwriting the thread local hashmaps
+    /// - size of EmittedAggregationWindow
+    const auto neededBufferSize = sizeof(EmittedAggregationWindow) + (allHashMaps.size() * sizeof(HashMap*));
+    const auto tupleBufferVal = pipelineCtx->getBufferManager()->getUnpooledBuffer(neededBufferSize);
+    if (not tupleBufferVal.has_value())
+    {
+        throw CannotAllocateBuffer("{}B for the aggregation window trigger were requested", neededBufferSize);
+    }
+    auto tupleBuffer = tupleBufferVal.value();
+
+    /// It might be that the buffer is not zeroed out.
+    std::ranges::fill(tupleBuffer.getAvailableMemoryArea(), std::byte{0});
+
+    /// As we are here "emitting" a buffer, we have to set the originId, the seq number, the watermark and the "number of tuples".
+    /// The watermark cannot be the slice end as some buffers might be still waiting to get processed.
+    tupleBuffer.setOriginId(outputOriginId);
+    tupleBuffer.setSequenceNumber(windowInfo.sequenceNumber);
+    tupleBuffer.setChunkNumber(ChunkNumber(ChunkNumber::INITIAL + partition));
+    tupleBuffer.setLastChunk(partition + 1 == numberOfPartitions);
+    tupleBuffer.setWatermark(watermark);
+    tupleBuffer.setNumberOfTuples(totalNumberOfTuples);
+    tupleBuffer.setCreationTimestampInMS(Timestamp(
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count()));
+    tupleBuffer.setIngestionTimestampsInNS(ingestionTimestamps.min, ingestionTimestamps.max);
+
+
+    /// Writing all necessary information for the aggregation probe to the buffer via the placement new constructor
+    auto tmp = tupleBuffer.getAvailableMemoryArea();
+    new (tmp.data()) EmittedAggregationWindow{
+        windowInfo.windowInfo, std::move(finalHashMap), allHashMaps, partialAggregates, previousEarlyResult, previousHashMapPtr};
+
+
+    /// Dispatching the buffer to the probe operator via the task queue.
+    pipelineCtx->emitBuffer(tupleBuffer);
+    NES_TRACE(
+        "Emitted partition {} of window {}-{} with watermarkTs {} sequenceNumber {} originId {}",
+        partition,
+        windowInfo.windowInfo.windowStart,
+        windowInfo.windowInfo.windowEnd,
+        tupleBuffer.getWatermark(),
+        tupleBuffer.getSequenceNumber(),
+        tupleBuffer.getOriginId());
+}
+
 void AggregationOperatorHandler::triggerSlices(
     const std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>>& slicesAndWindowInfo,
     PipelineExecutionContext* pipelineCtx)
 {
+    if (acceptsLateRecords())
+    {
+        triggerWindowsAcceptingLateRecords(slicesAndWindowInfo, pipelineCtx);
+        return;
+    }
+
+    /// The arena solely provides scratch memory to the combine function, as the partial aggregates outlive this call
+    const auto bufferProvider = pipelineCtx->getBufferManager();
+    Arena arena(bufferProvider);
+    const bool shareAggregates = slidingWindowAggregates != nullptr and combineStateNautilusFunction != nullptr;
+    const SlidingWindowAggregates::CombineFunction combineFunction = [&](HashMap* destination, HashMap* source)
+    { (*combineStateNautilusFunction)(destination, source, bufferProvider.get(), &arena); };
+    const PartialAggregate::CleanupFunction cleanupFunction
+        = [cleanupStateNautilusFunction = cleanupStateNautilusFunction](HashMap* hashMap) { (*cleanupStateNautilusFunction)(hashMap); };
+
     for (const auto& [windowInfo, allSlices] : slicesAndWindowInfo)
     {
-        /// Getting all hashmaps for each slice that has at least one tuple
-        std::unique_ptr<ChainedHashMap> finalHashMap;
-        std::vector<HashMap*> allHashMaps;
-        uint64_t totalNumberOfTuples = 0;
+        /// Overlapping sliding windows combine at most two shared partial aggregates instead of all of their slices
+        WindowPartialAggregates partialAggregates;
+        if (shareAggregates)
+        {
+            partialAggregates
+                = slidingWindowAggregates->getPartialAggregates(windowInfo.windowInfo, allSlices, combineFunction, cleanupFunction);
+        }
+
+        IngestionTimestamps ingestionTimestamps;
         for (const auto& slice : allSlices)
         {
-            const auto aggregationSlice = std::dynamic_pointer_cast<AggregationSlice>(slice);
-            for (uint64_t hashMapIdx = 0; hashMapIdx < aggregationSlice->getNumberOfHashMaps(); ++hashMapIdx)
+            ingestionTimestamps.merge(slice->getIngestionTimestamps());
+        }
+
+        /// Each partition contains disjoint keys. Thus, we emit one buffer per partition, so that different worker threads combine the
+        /// partitions of a window concurrently. All buffers of a window share the sequence number and differ in their chunk number.
+        for (uint64_t partition = 0; partition < numberOfPartitions; ++partition)
+        {
+            /// Getting all hashmaps of the partition for each slice (or partial aggregate) that has at least one tuple
+            std::vector<HashMap*> allHashMaps;
+            for (const auto& slice : allSlices)
             {
-                if (auto* hashMap = aggregationSlice->getHashMapPtr(WorkerThreadId(hashMapIdx));
-                    (hashMap != nullptr) and hashMap->getNumberOfTuples() > 0)
+                const auto aggregationSlice = std::dynamic_pointer_cast<AggregationSlice>(slice);
+                for (auto* hashMap : aggregationSlice->getHashMapPtrsOfPartition(partition))
                 {
-                    /// As the hashmap has one value per key, we can use the number of tuples for the number of keys
-                    rollingAverageNumberOfKeys.wlock()->add(hashMap->getNumberOfTuples());
-
-                    allHashMaps.emplace_back(hashMap);
-                    totalNumberOfTuples += hashMap->getNumberOfTuples();
-                    if (not finalHashMap)
+                    if ((hashMap != nullptr) and hashMap->getNumberOfTuples() > 0)
                     {
-                        finalHashMap = ChainedHashMap::createNewMapWithSameConfiguration(*dynamic_cast<ChainedHashMap*>(hashMap));
+                        /// As the hashmap has one value per key, we can use the number of tuples for the number of keys
+                        rollingAverageNumberOfKeys.wlock()->add(hashMap->getNumberOfTuples());
+                        if (not shareAggregates)
+                        {
+                            allHashMaps.emplace_back(hashMap);
+                        }
                     }
                 }
             }
-        }
-
+            for (const auto& partialAggregate : {partialAggregates.suffix, partialAggregates.prefix})
+            {
+                if (partialAggregate != nullptr and partialAggregate->getHashMapPtr(partition) != nullptr)
+                {
+                    allHashMaps.emplace_back(partialAggregate->getHashMapPtr(partition));
+                }
+            }
 
-        /// We need a buffer that is large enough to store:
-        /// - all pointers to all hashmaps of the window to be triggered
-        /// - a new hashmap for the probe operator, so that we are not overwriting the thread local hashmaps
-        /// - size of EmittedAggregationWindow
-        const auto neededBufferSize = sizeof(EmittedAggregationWindow) + (allHashMaps.size() * sizeof(HashMap*));
-        const auto tupleBufferVal = pipelineCtx->getBufferManager()->getUnpooledBuffer(neededBufferSize);
-        if (not tupleBufferVal.has_value())
-        {
-            throw CannotAllocateBuffer("{}B for the hash join window trigger were requested", neededBufferSize);
+            emitPartitionToProbe(
+                windowInfo,
+                partition,
+                allHashMaps,
+                partialAggregates,
+                nullptr,
+                ingestionTimestamps,
+                windowInfo.windowInfo.windowStart,
+                pipelineCtx);
         }
-        auto tupleBuffer = tupleBufferVal.value();
-
-        /// It might be that the buffer is not zeroed out.
-        std::ranges::fill(tupleBuffer.getAvailableMemoryArea(), std::byte{0});
-
-        /// As we are here "emitting" a buffer, we have to set the originId, the seq number, the watermark and the "number of tuples".
-        /// The watermark cannot be the slice end as some buffers might be still waiting to get processed.
-        tupleBuffer.setOriginId(outputOriginId);
-        tupleBuffer.setSequenceNumber(windowInfo.sequenceNumber);
-        tupleBuffer.setChunkNumber(ChunkNumber(ChunkNumber::INITIAL));
-        tupleBuffer.setLastChunk(true);
-        tupleBuffer.setWatermark(windowInfo.windowInfo.windowStart);
-        tupleBuffer.setNumberOfTuples(totalNumberOfTuples);
-        tupleBuffer.setCreationTimestampInMS(Timestamp(
-            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count()));
-
-
-        /// Writing all necessary information for the aggregation probe to the buffer via the placement new constructor
-        auto tmp = tupleBuffer.getAvailableMemoryArea();
-        new (tmp.data()) EmittedAggregationWindow{windowInfo.windowInfo, std::move(finalHashMap), allHashMaps};
-
-
-        /// Dispatching the buffer to the probe operator via the task queue.
-        pipelineCtx->emitBuffer(tupleBuffer);
-        NES_TRACE(
-            "Emitted window {}-{} with watermarkTs {} sequenceNumber {} originId {}",
-            windowInfo.windowInfo.windowStart,
-            windowInfo.windowInfo.windowEnd,
-            tupleBuffer.getWatermark(),
-            tupleBuffer.getSequenceNumber(),
-            tupleBuffer.getOriginId());
     }
 }
 
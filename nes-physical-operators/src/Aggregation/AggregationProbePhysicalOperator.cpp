@@ -14,23 +14,35 @@
 #include <Aggregation/AggregationProbePhysicalOperator.hpp>
 
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <optional>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include <Aggregation/AggregationOperatorHandler.hpp>
 #include <Aggregation/Function/AggregationPhysicalFunction.hpp>
+#include <Aggregation/SlidingWindowAggregates.hpp>
+#include <Aggregation/TopKEntries.hpp>
+#include <DataTypes/DataType.hpp>
 #include <Nautilus/DataTypes/DataTypesUtil.hpp>
+#include <Nautilus/DataTypes/VariableSizedData.hpp>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMap.hpp>
 #include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMapRef.hpp>
 #include <Nautilus/Interface/HashMap/HashMap.hpp>
 #include <Nautilus/Interface/Record.hpp>
 #include <Nautilus/Interface/RecordBuffer.hpp>
 #include <Nautilus/Interface/TimestampRef.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
 #include <Runtime/Execution/OperatorHandler.hpp>
 #include <SliceStore/WindowSlicesStoreInterface.hpp>
 #include <Time/Timestamp.hpp>
 #include <Util/Logger/Logger.hpp>
+#include <Arena.hpp>
+#include <CompilationContext.hpp>
 #include <ErrorHandling.hpp>
 #include <ExecutionContext.hpp>
+#include <HashMapOptions.hpp>
 #include <WindowProbePhysicalOperator.hpp>
 #include <function.hpp>
 #include <static.hpp>
@@ -48,6 +60,123 @@ HashMap* getHashMapPtrProxy(const EmittedAggregationWindow* emittedAggregationWi
     return emittedAggregationWindow->hashMaps[currentHashMapVal];
 }
 
+void createTopKEntriesProxy(EmittedAggregationWindow* emittedAggregationWindow, const uint64_t limit)
+{
+    PRECONDITION(emittedAggregationWindow != nullptr, "EmittedAggregationWindow must not be nullptr");
+    emittedAggregationWindow->topKEntries = std::make_unique<TopKEntries>(limit);
+}
+
+template <typename T>
+void offerTopKEntryProxy(
+    EmittedAggregationWindow* emittedAggregationWindow, ChainedHashMapEntry* entry, const T value, const bool isNull, const bool ascending)
+{
+    PRECONDITION(emittedAggregationWindow != nullptr, "EmittedAggregationWindow must not be nullptr");
+    emittedAggregationWindow->topKEntries->offer(entry, TopKEntries::toSortKey(value, ascending), isNull);
+}
+
+uint64_t sortTopKEntriesProxy(EmittedAggregationWindow* emittedAggregationWindow)
+{
+    PRECONDITION(emittedAggregationWindow != nullptr, "EmittedAggregationWindow must not be nullptr");
+    emittedAggregationWindow->topKEntries->sort();
+    return emittedAggregationWindow->topKEntries->size();
+}
+
+ChainedHashMapEntry* getTopKEntryProxy(const EmittedAggregationWindow* emittedAggregationWindow, const uint64_t pos)
+{
+    PRECONDITION(emittedAggregationWindow != nullptr, "EmittedAggregationWindow must not be nullptr");
+    /// The top-k only holds entries of the final hash map, which are chained hash map entries
+    return static_cast<ChainedHashMapEntry*>(emittedAggregationWindow->topKEntries->getEntry(pos));
+}
+
+void combineHashMaps(
+    const nautilus::val<HashMap*>& destinationHashMapPtr,
+    const nautilus::val<HashMap*>& sourceHashMapPtr,
+    const HashMapOptions& hashMapOptions,
+    const std::vector<std::shared_ptr<AggregationPhysicalFunction>>& aggregationPhysicalFunctions,
+    PipelineMemoryProvider& pipelineMemoryProvider)
+{
+    hashMapOptions.visitHashMapRef(
+        destinationHashMapPtr,
+        [&](auto& destinationHashMap)
+        {
+            const std::remove_cvref_t<decltype(destinationHashMap)> sourceHashMap(
+                sourceHashMapPtr,
+                hashMapOptions.fieldKeys,
+                hashMapOptions.fieldValues,
+                hashMapOptions.entriesPerPage,
+                hashMapOptions.entrySize);
+            /// Prefetching the destination entries of a group of source entries, before combining them one after the other
+            const auto sourceEntriesEnd = sourceHashMap.end();
+            for (auto sourceEntries = sourceHashMap.begin(); sourceEntries != sourceEntriesEnd; ++sourceEntries)
+            {
+                destinationHashMap.prefetchForEntries(sourceEntries);
+                const auto entry = *sourceEntries;
+                const ChainedHashMapRef::ChainedEntryRef entryRef(
+                    entry, sourceHashMapPtr, hashMapOptions.fieldKeys, hashMapOptions.fieldValues);
+                destinationHashMap.insertOrUpdateEntry(
+                    entryRef.entryRef,
+                    [&](const nautilus::val<AbstractHashMapEntry*>& entryOnUpdate)
+                    {
+                        const ChainedHashMapRef::ChainedEntryRef entryRefOnUpdate(
+                            entryOnUpdate, sourceHashMapPtr, hashMapOptions.fieldKeys, hashMapOptions.fieldValues);
+                        auto destinationState = static_cast<nautilus::val<AggregationState*>>(entryRefOnUpdate.getValueMemArea());
+                        auto sourceState = static_cast<nautilus::val<AggregationState*>>(entryRef.getValueMemArea());
+                        for (const auto& aggFunction : nautilus::static_iterable(aggregationPhysicalFunctions))
+                        {
+                            aggFunction->combine(destinationState, sourceState, pipelineMemoryProvider);
+                            destinationState = destinationState + aggFunction->getSizeOfStateInBytes();
+                            sourceState = sourceState + aggFunction->getSizeOfStateInBytes();
+                        }
+                    },
+                    [&](const nautilus::val<AbstractHashMapEntry*>& entryOnInsert)
+                    {
+                        const ChainedHashMapRef::ChainedEntryRef entryRefOnInsert(
+                            entryOnInsert, sourceHashMapPtr, hashMapOptions.fieldKeys, hashMapOptions.fieldValues);
+                        auto destinationState = static_cast<nautilus::val<AggregationState*>>(entryRefOnInsert.getValueMemArea());
+                        auto sourceState = static_cast<nautilus::val<AggregationState*>>(entryRef.getValueMemArea());
+                        for (const auto& aggFunction : nautilus::static_iterable(aggregationPhysicalFunctions))
+                        {
+                            aggFunction->reset(destinationState, pipelineMemoryProvider);
+                            aggFunction->combine(destinationState, sourceState, pipelineMemoryProvider);
+                            destinationState = destinationState + aggFunction->getSizeOfStateInBytes();
+                            sourceState = sourceState + aggFunction->getSizeOfStateInBytes();
+                        }
+                    },
+                    pipelineMemoryProvider.bufferProvider);
+            }
+        });
+}
+
+void AggregationProbePhysicalOperator::setup(ExecutionContext& executionCtx, CompilationContext& compilationContext) const
+{
+    WindowProbePhysicalOperator::setup(executionCtx, compilationContext);
+
+    /// Creating the function that builds the shared partial aggregates of overlapping sliding windows, the early results of the
+    /// filling windows, and the snapshots of windows that accept late records during the window trigger
+    /// As the setup function does not get traced, we do not need to have any nautilus::invoke calls to jump to the C++ runtime
+    /// We are not allowed to use const or const references for the lambda function params, as nautilus does not support this in the registerFunction method.
+    /// ReSharper disable once CppPassValueParameterByConstReference
+    /// NOLINTBEGIN(performance-unnecessary-value-param)
+    auto* const operatorHandler = dynamic_cast<AggregationOperatorHandler*>(
+        nautilus::details::RawValueResolver<OperatorHandler*>::getRawValue(executionCtx.getGlobalOperatorHandler(operatorHandlerId)));
+    if (operatorHandler->sharesSlidingWindowAggregates() or operatorHandler->emitsEarlyResults() or operatorHandler->acceptsLateRecords())
+    {
+        operatorHandler->combineStateNautilusFunction
+            = std::make_shared<AggregationOperatorHandler::NautilusCombineExec>(compilationContext.registerFunction(std::function(
+                [copyOfHashMapOptions = hashMapOptions, copyOfAggregationFunctions = aggregationPhysicalFunctions](
+                    nautilus::val<HashMap*> destinationHashMap,
+                    nautilus::val<HashMap*> sourceHashMap,
+                    nautilus::val<AbstractBufferProvider*> bufferProvider,
+                    nautilus::val<Arena*> arena)
+                {
+                    PipelineMemoryProvider pipelineMemoryProvider(arena, bufferProvider);
+                    combineHashMaps(
+                        destinationHashMap, sourceHashMap, copyOfHashMapOptions, copyOfAggregationFunctions, pipelineMemoryProvider);
+                })));
+    }
+    /// NOLINTEND(performance-unnecessary-value-param)
+}
+
 void AggregationProbePhysicalOperator::open(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const
 {
     /// As this operator functions as a scan, we have to set the execution context for this pipeline
@@ -57,6 +186,8 @@ void AggregationProbePhysicalOperator::open(ExecutionContext& executionCtx, Reco
     executionCtx.chunkNumber = recordBuffer.getChunkNumber();
     executionCtx.lastChunk = recordBuffer.isLastChunk();
     executionCtx.originId = recordBuffer.getOriginId();
+    executionCtx.minIngestionTs = recordBuffer.getMinIngestionTs();
+    executionCtx.maxIngestionTs = recordBuffer.getMaxIngestionTs();
     openChild(executionCtx, recordBuffer);
 
     /// Getting necessary values from the record buffer
@@ -68,92 +199,40 @@ void AggregationProbePhysicalOperator::open(ExecutionContext& executionCtx, Reco
     const nautilus::val<Timestamp> windowEnd{readValueFromMemRef<uint64_t>(getMemberRef(windowInfoRef, &WindowInfo::windowEnd))};
     auto hashMapRefs = readValueFromMemRef<HashMap**>(getMemberRef(aggregationWindowRef, &EmittedAggregationWindow::hashMaps));
     auto finalHashMapPtr = readValueFromMemRef<HashMap*>(getMemberRef(aggregationWindowRef, &EmittedAggregationWindow::finalHashMapPtr));
+    const auto previousHashMapPtr
+        = readValueFromMemRef<HashMap*>(getMemberRef(aggregationWindowRef, &EmittedAggregationWindow::previousHashMapPtr));
 
     /// Combining all keys from all hash maps in the final hash map, and then iterating over the final hash map once to lower the aggregation states
-    ChainedHashMapRef finalHashMap(
-        finalHashMapPtr, hashMapOptions.fieldKeys, hashMapOptions.fieldValues, hashMapOptions.entriesPerPage, hashMapOptions.entrySize);
     for (nautilus::val<uint64_t> curHashMap = 0; curHashMap < numberOfHashMaps; ++curHashMap)
     {
         const nautilus::val<HashMap*> hashMapPtr = hashMapRefs[curHashMap];
-        const ChainedHashMapRef currentMap(
-            hashMapPtr, hashMapOptions.fieldKeys, hashMapOptions.fieldValues, hashMapOptions.entriesPerPage, hashMapOptions.entrySize);
-        for (const auto entry : currentMap)
-        {
-            const ChainedHashMapRef::ChainedEntryRef entryRef(entry, hashMapPtr, hashMapOptions.fieldKeys, hashMapOptions.fieldValues);
-            const auto tmpRecordKey = entryRef.getKey();
-
-            /// Inserting the record key into the final/global hash map. If an entry for the key already exists, we have to combine the aggregation states
-            /// We do this by iterating over the aggregation functions and combining all aggregation states into a global state.
-            finalHashMap.insertOrUpdateEntry(
-                entryRef.entryRef,
-                [fieldKeys = hashMapOptions.fieldKeys,
-                 fieldValues = hashMapOptions.fieldValues,
-                 &executionCtx,
-                 &entryRef,
-                 &aggregationPhysicalFunctions = aggregationPhysicalFunctions,
-                 hashMapPtr = hashMapPtr](const nautilus::val<AbstractHashMapEntry*>& entryOnUpdate)
-                {
-                    /// Combining the aggregation states of the current entry with the aggregation states of the final hash map
-                    const ChainedHashMapRef::ChainedEntryRef entryRefOnInsert(entryOnUpdate, hashMapPtr, fieldKeys, fieldValues);
-                    auto globalState = static_cast<nautilus::val<AggregationState*>>(entryRefOnInsert.getValueMemArea());
-                    auto entryRefState = static_cast<nautilus::val<AggregationState*>>(entryRef.getValueMemArea());
-                    for (const auto& aggFunction : nautilus::static_iterable(aggregationPhysicalFunctions))
-                    {
-                        aggFunction->combine(globalState, entryRefState, executionCtx.pipelineMemoryProvider);
-                        globalState = globalState + aggFunction->getSizeOfStateInBytes();
-                        entryRefState = entryRefState + aggFunction->getSizeOfStateInBytes();
-                    }
-                },
-                [fieldKeys = hashMapOptions.fieldKeys,
-                 fieldValues = hashMapOptions.fieldValues,
-                 &executionCtx,
-                 &entryRef,
-                 &aggregationPhysicalFunctions = aggregationPhysicalFunctions,
-                 hashMapPtr = hashMapPtr](const nautilus::val<AbstractHashMapEntry*>& entryOnInsert)
-                {
-                    /// If the entry for the provided key has not been seen by this hash map / worker thread, we need
-                    /// to create a new one and initialize the aggregation states. After that, we can combine the aggregation states.
-                    const ChainedHashMapRef::ChainedEntryRef entryRefOnInsert(entryOnInsert, hashMapPtr, fieldKeys, fieldValues);
-                    auto globalState = static_cast<nautilus::val<AggregationState*>>(entryRefOnInsert.getValueMemArea());
-                    auto entryRefStatePtr = static_cast<nautilus::val<AggregationState*>>(entryRef.getValueMemArea());
-                    for (const auto& aggFunction : nautilus::static_iterable(aggregationPhysicalFunctions))
-                    {
-                        /// In contrast to the lambda method above, we have to reset the aggregation state before combining it with the other state
-                        aggFunction->reset(globalState, executionCtx.pipelineMemoryProvider);
-                        aggFunction->combine(globalState, entryRefStatePtr, executionCtx.pipelineMemoryProvider);
-                        globalState = globalState + aggFunction->getSizeOfStateInBytes();
-                        entryRefStatePtr = entryRefStatePtr + aggFunction->getSizeOfStateInBytes();
-                    }
-                },
-                executionCtx.pipelineMemoryProvider.bufferProvider);
-        }
+        combineHashMaps(finalHashMapPtr, hashMapPtr, hashMapOptions, aggregationPhysicalFunctions, executionCtx.pipelineMemoryProvider);
     }
 
-    /// Lowering, each aggregation state in the final hash map and passing the record to the child
-    for (const auto entry : finalHashMap)
+    if (topK.has_value())
     {
-        const ChainedHashMapRef::ChainedEntryRef entryRef(entry, finalHashMapPtr, hashMapOptions.fieldKeys, hashMapOptions.fieldValues);
-        const auto recordKey = entryRef.getKey();
-        Record outputRecord;
-        for (auto finalStatePtr = static_cast<nautilus::val<AggregationState*>>(entryRef.getValueMemArea());
-             const auto& aggFunction : nautilus::static_iterable(aggregationPhysicalFunctions))
-        {
-            outputRecord.reassignFields(aggFunction->lower(finalStatePtr, executionCtx.pipelineMemoryProvider));
-            finalStatePtr = finalStatePtr + aggFunction->getSizeOfStateInBytes();
-        }
-
-        /// Adding the window start and end to the output record and then passing the record to the child
-        outputRecord.reassignFields(recordKey);
-        outputRecord.write(windowMetaData.windowStartFieldName, windowStart.convertToValue());
-        outputRecord.write(windowMetaData.windowEndFieldName, windowEnd.convertToValue());
-        executeChild(executionCtx, outputRecord);
-
-        for (auto finalStatePtr = static_cast<nautilus::val<AggregationState*>>(entryRef.getValueMemArea());
-             const auto& aggFunction : nautilus::static_iterable(aggregationPhysicalFunctions))
-        {
-            aggFunction->cleanup(finalStatePtr);
-            finalStatePtr = finalStatePtr + aggFunction->getSizeOfStateInBytes();
-        }
+        emitTopK(*topK, aggregationWindowRef, finalHashMapPtr, windowStart, windowEnd, executionCtx);
+    }
+    else
+    {
+        hashMapOptions.visitHashMapRef(
+            finalHashMapPtr,
+            [&](auto& finalHashMap)
+            {
+                for (const auto entry : finalHashMap)
+                {
+                    const ChainedHashMapRef::ChainedEntryRef entryRef(
+                        entry, finalHashMapPtr, hashMapOptions.fieldKeys, hashMapOptions.fieldValues);
+                    auto outputRecord = lowerEntry(entryRef, windowStart, windowEnd, executionCtx);
+                    /// Early results solely emit the keys that changed since the previous early result of the window
+                    if (hasChangedSincePreviousEarlyResult(
+                            entryRef, outputRecord, previousHashMapPtr, windowStart, windowEnd, executionCtx))
+                    {
+                        executeChild(executionCtx, outputRecord);
+                    }
+                    cleanupEntry(entryRef);
+                }
+            });
     }
 
     /// As we are creating a new hash map for the probe operator, we have to reset/destroy the final hash map of the emitted aggregation window
@@ -165,18 +244,185 @@ void AggregationProbePhysicalOperator::open(ExecutionContext& executionCtx, Reco
                 emittedAggregationWindow->windowInfo.windowStart,
                 emittedAggregationWindow->windowInfo.windowEnd);
             emittedAggregationWindow->finalHashMap.reset();
+            /// Releasing the shared partial aggregates, as the probe does not access their hash maps anymore
+            emittedAggregationWindow->partialAggregates = {};
+            emittedAggregationWindow->topKEntries.reset();
+            emittedAggregationWindow->previousEarlyResult.reset();
         },
         aggregationWindowRef);
 }
 
+Record AggregationProbePhysicalOperator::lowerEntry(
+    const ChainedHashMapRef::ChainedEntryRef& entryRef,
+    const nautilus::val<Timestamp>& windowStart,
+    const nautilus::val<Timestamp>& windowEnd,
+    ExecutionContext& executionCtx) const
+{
+    const auto recordKey = entryRef.getKey();
+    Record outputRecord;
+    for (auto finalStatePtr = static_cast<nautilus::val<AggregationState*>>(entryRef.getValueMemArea());
+         const auto& aggFunction : nautilus::static_iterable(aggregationPhysicalFunctions))
+    {
+        outputRecord.reassignFields(aggFunction->lower(finalStatePtr, executionCtx.pipelineMemoryProvider));
+        finalStatePtr = finalStatePtr + aggFunction->getSizeOfStateInBytes();
+    }
+
+    /// Adding the window start and end to the output record
+    outputRecord.reassignFields(recordKey);
+    outputRecord.write(windowMetaData.windowStartFieldName, windowStart.convertToValue());
+    outputRecord.write(windowMetaData.windowEndFieldName, windowEnd.convertToValue());
+    return outputRecord;
+}
+
+void AggregationProbePhysicalOperator::cleanupEntry(const ChainedHashMapRef::ChainedEntryRef& entryRef) const
+{
+    for (auto finalStatePtr = static_cast<nautilus::val<AggregationState*>>(entryRef.getValueMemArea());
+         const auto& aggFunction : nautilus::static_iterable(aggregationPhysicalFunctions))
+    {
+        aggFunction->cleanup(finalStatePtr);
+        finalStatePtr = finalStatePtr + aggFunction->getSizeOfStateInBytes();
+    }
+}
+
+nautilus::val<bool> AggregationProbePhysicalOperator::hasChangedSincePreviousEarlyResult(
+    const ChainedHashMapRef::ChainedEntryRef& entryRef,
+    const Record& outputRecord,
+    const nautilus::val<HashMap*>& previousHashMapPtr,
+    const nautilus::val<Timestamp>& windowStart,
+    const nautilus::val<Timestamp>& windowEnd,
+    ExecutionContext& executionCtx) const
+{
+    nautilus::val<bool> changed{true};
+    if (previousHashMapPtr == nullptr)
+    {
+        return changed;
+    }
+    hashMapOptions.visitHashMapRef(
+        previousHashMapPtr,
+        [&](auto& previousHashMap)
+        {
+            if (const auto previousEntry = previousHashMap.findEntry(entryRef.entryRef))
+            {
+                const ChainedHashMapRef::ChainedEntryRef previousEntryRef(
+                    previousEntry, previousHashMapPtr, hashMapOptions.fieldKeys, hashMapOptions.fieldValues);
+                const auto previousRecord = lowerEntry(previousEntryRef, windowStart, windowEnd, executionCtx);
+                changed = false;
+                for (const auto& aggFunction : nautilus::static_iterable(aggregationPhysicalFunctions))
+                {
+                    /// Like the keys, null values are equal to each other and differ from all other values
+                    const auto& value = outputRecord.read(aggFunction->getResultFieldIdentifier());
+                    const auto& previousValue = previousRecord.read(aggFunction->getResultFieldIdentifier());
+                    changed = changed or value.isNull() != previousValue.isNull();
+                    const auto& resultType = aggFunction->getResultType();
+                    if (resultType.isType(DataType::Type::VARSIZED))
+                    {
+                        changed = changed
+                            or (not previousValue.isNull()
+                                and value.getRawValueAs<VariableSizedData>() != previousValue.getRawValueAs<VariableSizedData>());
+                    }
+                    else
+                    {
+                        changed = changed
+                            or (not previousValue.isNull()
+                                and (value.castToType(resultType.type) != previousValue.castToType(resultType.type))
+                                        .getRawValueAs<nautilus::val<bool>>());
+                    }
+                }
+            }
+        });
+    return changed;
+}
+
+void AggregationProbePhysicalOperator::emitTopK(
+    const AggregationProbeTopK& topK,
+    const nautilus::val<EmittedAggregationWindow*>& aggregationWindowRef,
+    const nautilus::val<HashMap*>& finalHashMapPtr,
+    const nautilus::val<Timestamp>& windowStart,
+    const nautilus::val<Timestamp>& windowEnd,
+    ExecutionContext& executionCtx) const
+{
+    /// Lowering all entries to select the top-k, lowering the top-k entries again to emit them, and cleaning up all entries afterward
+    nautilus::invoke(createTopKEntriesProxy, aggregationWindowRef, nautilus::val<uint64_t>(topK.limit));
+    const nautilus::val<bool> ascending(topK.ascending);
+    hashMapOptions.visitHashMapRef(
+        finalHashMapPtr,
+        [&](auto& finalHashMap)
+        {
+            for (const auto entry : finalHashMap)
+            {
+                const ChainedHashMapRef::ChainedEntryRef entryRef(
+                    entry, finalHashMapPtr, hashMapOptions.fieldKeys, hashMapOptions.fieldValues);
+                const auto outputRecord = lowerEntry(entryRef, windowStart, windowEnd, executionCtx);
+                const auto& orderValue = outputRecord.read(topK.orderFieldName);
+                if (topK.orderFieldType.isFloat())
+                {
+                    nautilus::invoke(
+                        offerTopKEntryProxy<double>,
+                        aggregationWindowRef,
+                        entry,
+                        orderValue.getRawValueAs<nautilus::val<double>>(),
+                        orderValue.isNull(),
+                        ascending);
+                }
+                else if (topK.orderFieldType.isSignedInteger())
+                {
+                    nautilus::invoke(
+                        offerTopKEntryProxy<int64_t>,
+                        aggregationWindowRef,
+                        entry,
+                        orderValue.getRawValueAs<nautilus::val<int64_t>>(),
+                        orderValue.isNull(),
+                        ascending);
+                }
+                else
+                {
+                    nautilus::invoke(
+                        offerTopKEntryProxy<uint64_t>,
+                        aggregationWindowRef,
+                        entry,
+                        orderValue.getRawValueAs<nautilus::val<uint64_t>>(),
+                        orderValue.isNull(),
+                        ascending);
+                }
+            }
+        });
+
+    const auto numberOfTopKEntries = nautilus::invoke(sortTopKEntriesProxy, aggregationWindowRef);
+    for (nautilus::val<uint64_t> pos = 0; pos < numberOfTopKEntries; ++pos)
+    {
+        const auto entry = nautilus::invoke(getTopKEntryProxy, aggregationWindowRef, pos);
+        const ChainedHashMapRef::ChainedEntryRef entryRef(entry, finalHashMapPtr, hashMapOptions.fieldKeys, hashMapOptions.fieldValues);
+        auto outputRecord = lowerEntry(entryRef, windowStart, windowEnd, executionCtx);
+        executeChild(executionCtx, outputRecord);
+    }
+
+    hashMapOptions.visitHashMapRef(
+        finalHashMapPtr,
+        [&](auto& finalHashMap)
+        {
+            for (const auto entry : finalHashMap)
+            {
+                const ChainedHashMapRef::ChainedEntryRef entryRef(
+                    entry, finalHashMapPtr, hashMapOptions.fieldKeys, hashMapOptions.fieldValues);
+                cleanupEntry(entryRef);
+            }
+        });
+}
+
 AggregationProbePhysicalOperator::AggregationProbePhysicalOperator(
     HashMapOptions hashMapOptions,
     std::vector<std::shared_ptr<AggregationPhysicalFunction>> aggregationPhysicalFunctions,
     const OperatorHandlerId operatorHandlerId,
-    WindowMetaData windowMetaData)
+    WindowMetaData windowMetaData,
+    std::optional<AggregationProbeTopK> topK)
     : WindowProbePhysicalOperator(operatorHandlerId, std::move(windowMetaData))
     , aggregationPhysicalFunctions(std::move(aggregationPhysicalFunctions))
     , hashMapOptions(std::move(hashMapOptions))
+    , topK(std::move(topK))
 {
+    PRECONDITION(
+        not this->topK.has_value() or this->topK->orderFieldType.isNumeric(),
+        "The order field of a top-k window must be numeric, but is {}",
+        this->topK->orderFieldType);
 }
 }
@@ -16,11 +16,10 @@
 #include <cstdint>
 #include <memory>
 #include <utility>
+#include <vector>
 #include <Identifiers/Identifiers.hpp>
-#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMap.hpp>
 #include <Nautilus/Interface/HashMap/HashMap.hpp>
 #include <SliceStore/Slice.hpp>
-#include <ErrorHandling.hpp>
 #include <HashMapSlice.hpp>
 
 namespace NES
@@ -29,32 +28,30 @@ AggregationSlice::AggregationSlice(
     const SliceStart sliceStart,
     const SliceEnd sliceEnd,
     const CreateNewHashMapSliceArgs& createNewHashMapSliceArgs,
-    const uint64_t numberOfHashMaps)
-    : HashMapSlice(sliceStart, sliceEnd, createNewHashMapSliceArgs, numberOfHashMaps, 1)
+    const uint64_t numberOfHashMaps,
+    const uint64_t numberOfPartitions)
+    : HashMapSlice(sliceStart, sliceEnd, createNewHashMapSliceArgs, numberOfHashMaps, 1, numberOfPartitions)
 {
 }
 
-HashMap* AggregationSlice::getHashMapPtr(const WorkerThreadId workerThreadId) const
+HashMap* AggregationSlice::getHashMapPtr(const WorkerThreadId workerThreadId, const uint64_t partition) const
 {
-    const auto pos = workerThreadId % hashMaps.size();
-    INVARIANT(pos < hashMaps.size(), "The worker thread id should be smaller than the number of hashmaps");
-    return hashMaps[pos].get();
+    return hashMaps[getHashMapPos(workerThreadId, 0, partition)].get();
 }
 
-HashMap* AggregationSlice::getHashMapPtrOrCreate(const WorkerThreadId workerThreadId)
+HashMap* AggregationSlice::getHashMapPtrOrCreate(const WorkerThreadId workerThreadId, const uint64_t partition)
 {
-    const auto pos = workerThreadId % hashMaps.size();
-    INVARIANT(pos < hashMaps.size(), "The worker thread id should be smaller than the number of hashmaps");
-
+    const auto pos = getHashMapPos(workerThreadId, 0, partition);
     if (hashMaps.at(pos) == nullptr)
     {
-        hashMaps.at(pos) = std::make_unique<ChainedHashMap>(
-            createNewHashMapSliceArgs.keySize,
-            createNewHashMapSliceArgs.valueSize,
-            createNewHashMapSliceArgs.numberOfBuckets,
-            createNewHashMapSliceArgs.pageSize);
+        hashMaps.at(pos) = createHashMap();
     }
     return hashMaps[pos].get();
 }
 
+std::vector<HashMap*> AggregationSlice::getHashMapPtrsOfPartition(const uint64_t partition) const
+{
+    return HashMapSlice::getHashMapPtrsOfPartition(0, partition);
+}
+
 }
@@ -0,0 +1,307 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Aggregation/AggregationStateCheckpoint.hpp>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <ranges>
+#include <set>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <Aggregation/AggregationSlice.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMap.hpp>
+#include <Time/Timestamp.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <ErrorHandling.hpp>
+#include <xxhash.h>
+
+namespace NES
+{
+
+namespace
+{
+constexpr uint64_t MANIFEST_MAGIC = 0x4E45534147434B50; /// "NESAGCKP"
+constexpr uint64_t MANIFEST_VERSION = 1;
+constexpr auto MANIFEST_FILE_NAME = "MANIFEST";
+constexpr auto PAGE_FILE_PREFIX = "pages-";
+
+/// magic, version, checkpoint, entry size, number of partitions, earliest window end, number of pages
+constexpr size_t MANIFEST_HEADER_WORDS = 7;
+/// slice start, slice end, hash map index, page index, checkpoint, offset, size, hash
+constexpr size_t MANIFEST_WORDS_PER_PAGE = 8;
+
+/// Writes the bytes to a new file and flushes it to the disk, before the file replaces the file at the path (if any)
+void writeFileAtomically(const std::filesystem::path& path, const std::span<const std::byte> bytes)
+{
+    const auto temporaryPath = std::filesystem::path(path).concat(".tmp");
+    ///NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+    const int fileDescriptor = ::open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fileDescriptor < 0)
+    {
+        throw CannotSerialize("Could not create the checkpoint file {}: {}", temporaryPath.string(), std::strerror(errno));
+    }
+    for (size_t written = 0; written < bytes.size();)
+    {
+        const auto result = ::write(fileDescriptor, bytes.data() + written, bytes.size() - written);
+        if (result < 0 and errno == EINTR)
+        {
+            continue;
+        }
+        if (result < 0)
+        {
+            const auto error = errno;
+            ::close(fileDescriptor);
+            throw CannotSerialize("Could not write the checkpoint file {}: {}", temporaryPath.string(), std::strerror(error));
+        }
+        written += static_cast<size_t>(result);
+    }
+    if (::fsync(fileDescriptor) != 0)
+    {
+        const auto error = errno;
+        ::close(fileDescriptor);
+        throw CannotSerialize("Could not flush the checkpoint file {}: {}", temporaryPath.string(), std::strerror(error));
+    }
+    ::close(fileDescriptor);
+
+    std::error_code errorCode;
+    std::filesystem::rename(temporaryPath, path, errorCode);
+    if (errorCode)
+    {
+        throw CannotSerialize("Could not rename the checkpoint file {}: {}", temporaryPath.string(), errorCode.message());
+    }
+    /// The rename is durable, once the directory is flushed
+    if (const int directoryDescriptor = ::open(path.parent_path().c_str(), O_RDONLY | O_DIRECTORY); directoryDescriptor >= 0) ///NOLINT
+    {
+        ::fsync(directoryDescriptor);
+        ::close(directoryDescriptor);
+    }
+}
+
+std::vector<std::byte> readFile(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (not file)
+    {
+        throw CannotDeserialize("Could not open the checkpoint file {}", path.string());
+    }
+    std::vector<std::byte> bytes(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (not file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()))) /// NOLINT
+    {
+        throw CannotDeserialize("Could not read the checkpoint file {}", path.string());
+    }
+    return bytes;
+}
+}
+
+AggregationStateCheckpoint::AggregationStateCheckpoint(std::filesystem::path directory, const Layout layout)
+    : directory(std::move(directory)), layout(layout)
+{
+    std::error_code errorCode;
+    std::filesystem::create_directories(this->directory, errorCode);
+    if (errorCode)
+    {
+        throw CannotSerialize("Could not create the checkpoint directory {}: {}", this->directory.string(), errorCode.message());
+    }
+}
+
+std::filesystem::path AggregationStateCheckpoint::getPageFilePath(const uint64_t checkpoint) const
+{
+    return directory / (PAGE_FILE_PREFIX + std::to_string(checkpoint));
+}
+
+std::optional<AggregationStateCheckpoint::RestoredState> AggregationStateCheckpoint::restore()
+{
+    const auto manifestPath = directory / MANIFEST_FILE_NAME;
+    if (not std::filesystem::exists(manifestPath))
+    {
+        return std::nullopt;
+    }
+
+    const auto manifestBytes = readFile(manifestPath);
+    const auto numberOfWords = manifestBytes.size() / sizeof(uint64_t);
+    std::vector<uint64_t> manifest(numberOfWords);
+    std::memcpy(manifest.data(), manifestBytes.data(), numberOfWords * sizeof(uint64_t));
+    if (manifestBytes.size() % sizeof(uint64_t) != 0 or numberOfWords < MANIFEST_HEADER_WORDS + 1 or manifest[0] != MANIFEST_MAGIC
+        or manifest[1] != MANIFEST_VERSION
+        or numberOfWords != MANIFEST_HEADER_WORDS + (manifest[6] * MANIFEST_WORDS_PER_PAGE) + 1
+        or XXH3_64bits(manifestBytes.data(), manifestBytes.size() - sizeof(uint64_t)) != manifest.back())
+    {
+        throw CannotDeserialize("The checkpoint manifest {} is corrupted", manifestPath.string());
+    }
+
+    /// The next checkpoint must not overwrite the page files of the restored checkpoint, before it replaces its manifest
+    nextCheckpoint = manifest[2] + 1;
+    const Layout restoredLayout{.entrySize = manifest[3], .numberOfPartitions = manifest[4]};
+    if (restoredLayout != layout)
+    {
+        NES_WARNING(
+            "Ignoring the checkpoint in {}, as its hash maps have entries of {}B in {} partitions instead of {}B in {} partitions",
+            directory.string(),
+            restoredLayout.entrySize,
+            restoredLayout.numberOfPartitions,
+            layout.entrySize,
+            layout.numberOfPartitions);
+        return std::nullopt;
+    }
+
+    RestoredState restoredState{.earliestWindowEnd = Timestamp(manifest[5]), .pages = {}};
+    std::map<uint64_t, std::vector<std::byte>> pageFiles;
+    for (uint64_t page = 0; page < manifest[6]; ++page)
+    {
+        const auto* const words = &manifest[MANIFEST_HEADER_WORDS + (page * MANIFEST_WORDS_PER_PAGE)];
+        const PageKey key{
+            .sliceStart = SliceStart(words[0]), .sliceEnd = SliceEnd(words[1]), .hashMapIndex = words[2], .pageIndex = words[3]};
+        const PageLocation location{.checkpoint = words[4], .offset = words[5], .size = words[6], .hash = words[7]};
+
+        auto pageFile = pageFiles.find(location.checkpoint);
+        if (pageFile == pageFiles.end())
+        {
+            pageFile = pageFiles.emplace(location.checkpoint, readFile(getPageFilePath(location.checkpoint))).first;
+        }
+        if (location.offset + location.size > pageFile->second.size()
+            or XXH3_64bits(pageFile->second.data() + location.offset, location.size) != location.hash)
+        {
+            throw CannotDeserialize("The page file {} of the checkpoint is corrupted", getPageFilePath(location.checkpoint).string());
+        }
+        const auto entries = std::span(pageFile->second).subspan(location.offset, location.size);
+        restoredState.pages.emplace_back(key, std::vector(entries.begin(), entries.end()));
+    }
+    NES_INFO("Restored {} pages of the checkpoint {} in {}", restoredState.pages.size(), manifest[2], directory.string());
+    return restoredState;
+}
+
+void AggregationStateCheckpoint::copyChangedPages(const AggregationSlice& slice, const WorkerThreadId workerThreadId)
+{
+    const auto numberOfPartitions = slice.getNumberOfPartitions();
+    const auto numberOfWorkerThreads = slice.getNumberOfHashMaps() / numberOfPartitions;
+    for (uint64_t partition = 0; partition < numberOfPartitions; ++partition)
+    {
+        const auto* const hashMap = dynamic_cast<const ChainedHashMap*>(slice.getHashMapPtr(workerThreadId, partition));
+        if (hashMap == nullptr or hashMap->getNumberOfTuples() == 0)
+        {
+            continue;
+        }
+        INVARIANT(
+            hashMap->getEntrySize() == layout.entrySize and not hashMap->hasVarSizedData(),
+            "The checkpoint requires hash maps with entries of {}B that do not point to variable sized data",
+            layout.entrySize);
+
+        const auto hashMapIndex = ((workerThreadId % numberOfWorkerThreads) * numberOfPartitions) + partition;
+        for (uint64_t pageIndex = 0; pageIndex < hashMap->getNumberOfPages(); ++pageIndex)
+        {
+            const auto& page = hashMap->getPage(pageIndex);
+            const auto entries = page.getAvailableMemoryArea().subspan(0, page.getNumberOfTuples() * layout.entrySize);
+            const auto hash = XXH3_64bits(entries.data(), entries.size());
+            const PageKey key{
+                .sliceStart = slice.getSliceStart(), .sliceEnd = slice.getSliceEnd(), .hashMapIndex = hashMapIndex, .pageIndex = pageIndex};
+
+            /// Most pages of the slices that are not filled anymore do not change between two checkpoints
+            const auto committedPage = committedPages.find(key);
+            if (committedPage != committedPages.end() and committedPage->second.hash == hash
+                and committedPage->second.size == entries.size())
+            {
+                pendingPages.emplace(key, committedPage->second);
+                continue;
+            }
+            pendingPages.emplace(
+                key, PageLocation{.checkpoint = nextCheckpoint, .offset = pendingPageData.size(), .size = entries.size(), .hash = hash});
+            pendingPageData.insert(pendingPageData.end(), entries.begin(), entries.end());
+        }
+    }
+}
+
+void AggregationStateCheckpoint::writeManifest(const std::map<PageKey, PageLocation>& pages, const Timestamp earliestWindowEnd) const
+{
+    std::vector<uint64_t> manifest{
+        MANIFEST_MAGIC,
+        MANIFEST_VERSION,
+        nextCheckpoint,
+        layout.entrySize,
+        layout.numberOfPartitions,
+        earliestWindowEnd.getRawValue(),
+        pages.size()};
+    manifest.reserve(MANIFEST_HEADER_WORDS + (pages.size() * MANIFEST_WORDS_PER_PAGE) + 1);
+    for (const auto& [key, location] : pages)
+    {
+        manifest.insert(
+            manifest.end(),
+            {key.sliceStart.getRawValue(),
+             key.sliceEnd.getRawValue(),
+             key.hashMapIndex,
+             key.pageIndex,
+             location.checkpoint,
+             location.offset,
+             location.size,
+             location.hash});
+    }
+    manifest.emplace_back(XXH3_64bits(manifest.data(), manifest.size() * sizeof(uint64_t)));
+    writeFileAtomically(directory / MANIFEST_FILE_NAME, std::as_bytes(std::span(manifest)));
+}
+
+void AggregationStateCheckpoint::commit(const Timestamp earliestWindowEnd)
+{
+    /// A failed commit keeps the previous checkpoint. Thus, the next checkpoint compares the pages against the previous checkpoint again.
+    const auto pages = std::exchange(pendingPages, {});
+    const auto pageData = std::exchange(pendingPageData, {});
+    if (not pageData.empty())
+    {
+        writeFileAtomically(getPageFilePath(nextCheckpoint), pageData);
+    }
+    writeManifest(pages, earliestWindowEnd);
+
+    committedPages = pages;
+    bytesOfLastCommit = pageData.size();
+    ++nextCheckpoint;
+    deleteUnreferencedFiles();
+}
+
+uint64_t AggregationStateCheckpoint::getBytesOfLastCommit() const
+{
+    return bytesOfLastCommit;
+}
+
+void AggregationStateCheckpoint::deleteUnreferencedFiles() const
+{
+    std::set<std::string> referencedFiles{MANIFEST_FILE_NAME};
+    for (const auto& location : committedPages | std::views::values)
+    {
+        referencedFiles.emplace(getPageFilePath(location.checkpoint).filename().string());
+    }
+    /// Solely deletes page files, so that the directory might be shared with other files
+    std::error_code errorCode;
+    for (const auto& file : std::filesystem::directory_iterator(directory, errorCode))
+    {
+        const auto fileName = file.path().filename().string();
+        if (fileName.starts_with(PAGE_FILE_PREFIX) and not referencedFiles.contains(fileName))
+        {
+            std::filesystem::remove(file.path(), errorCode);
+        }
+    }
+}
+
+}
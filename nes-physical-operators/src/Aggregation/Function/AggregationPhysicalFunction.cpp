@@ -17,8 +17,10 @@
 #include <cstdint>
 #include <utility>
 #include <DataTypes/DataType.hpp>
+#include <Functions/DecimalArithmeticPhysicalFunction.hpp>
 #include <Functions/PhysicalFunction.hpp>
 #include <Nautilus/DataTypes/DataTypesUtil.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
 #include <Nautilus/Interface/Record.hpp>
 #include <val_bool.hpp>
 #include <val_ptr.hpp>
@@ -48,5 +50,29 @@ nautilus::val<bool> AggregationPhysicalFunction::readNull(const nautilus::val<Ag
     return isNull;
 }
 
+VarVal AggregationPhysicalFunction::addInputValues(const VarVal& left, const VarVal& right) const
+{
+    if (inputType.isDecimal())
+    {
+        return DecimalArithmeticPhysicalFunction::evaluate(DecimalOperation::ADD, left, right, 0);
+    }
+    return (left + right).castToType(inputType.type);
+}
+
+const Record::RecordFieldIdentifier& AggregationPhysicalFunction::getResultFieldIdentifier() const
+{
+    return resultFieldIdentifier;
+}
+
+const DataType& AggregationPhysicalFunction::getResultType() const
+{
+    return resultType;
+}
+
+bool AggregationPhysicalFunction::isStateSelfContained() const
+{
+    return true;
+}
+
 AggregationPhysicalFunction::~AggregationPhysicalFunction() = default;
 }
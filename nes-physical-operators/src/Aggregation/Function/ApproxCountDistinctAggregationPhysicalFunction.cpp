@@ -0,0 +1,151 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Aggregation/Function/ApproxCountDistinctAggregationPhysicalFunction.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <Aggregation/Function/AggregationPhysicalFunction.hpp>
+#include <Aggregation/Function/HyperLogLog.hpp>
+#include <DataTypes/DataType.hpp>
+#include <Functions/PhysicalFunction.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/Hash/MurMur3HashFunction.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <nautilus/function.hpp>
+#include <nautilus/std/cstring.h>
+#include <AggregationPhysicalFunctionRegistry.hpp>
+#include <ExecutionContext.hpp>
+#include <val.hpp>
+#include <val_bool.hpp>
+#include <val_concepts.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+namespace
+{
+/// The MurMur3HashFunction hashes numeric values after casting them to uint64_t, which would map all values in [1, 2) to the same hash.
+/// Thus, we hash the bits of floating point values.
+uint64_t hashFloatingPoint(const double value)
+{
+    /// 0.0 and -0.0 are the same value
+    auto bits = std::bit_cast<uint64_t>(value == 0 ? 0.0 : value);
+    bits ^= bits >> 33U;
+    bits *= UINT64_C(0xff51afd7ed558ccd);
+    bits ^= bits >> 33U;
+    bits *= UINT64_C(0xc4ceb9fe1a85ec53);
+    bits ^= bits >> 33U;
+    return bits;
+}
+}
+
+ApproxCountDistinctAggregationPhysicalFunction::ApproxCountDistinctAggregationPhysicalFunction(
+    DataType inputType,
+    DataType resultType,
+    PhysicalFunction inputFunction,
+    Record::RecordFieldIdentifier resultFieldIdentifier,
+    const bool includeNullValues)
+    : AggregationPhysicalFunction(std::move(inputType), std::move(resultType), std::move(inputFunction), std::move(resultFieldIdentifier))
+    , includeNullValues(includeNullValues)
+{
+}
+
+void ApproxCountDistinctAggregationPhysicalFunction::lift(
+    const nautilus::val<AggregationState*>& aggregationState, PipelineMemoryProvider& pipelineMemoryProvider, const Record& record)
+{
+    const auto value = inputFunction.execute(record, pipelineMemoryProvider.arena);
+    const auto addToSketch = [&]
+    {
+        const auto hash = inputType.isFloat()
+            ? nautilus::invoke(hashFloatingPoint, value.castToType(DataType::Type::FLOAT64).getRawValueAs<nautilus::val<double>>())
+            : MurMur3HashFunction().calculate(value);
+        nautilus::invoke(
+            +[](HyperLogLog* sketch, const uint64_t hash) -> void { sketch->add(hash); },
+            static_cast<nautilus::val<HyperLogLog*>>(aggregationState),
+            hash);
+    };
+
+    /// If value is null and we do not include null values, we do not add it to the sketch
+    if (inputType.nullable and not includeNullValues)
+    {
+        if (not value.isNull())
+        {
+            addToSketch();
+        }
+    }
+    else
+    {
+        addToSketch();
+    }
+}
+
+void ApproxCountDistinctAggregationPhysicalFunction::combine(
+    const nautilus::val<AggregationState*> aggregationState1,
+    const nautilus::val<AggregationState*> aggregationState2,
+    PipelineMemoryProvider&)
+{
+    /// Merging the registers of the second sketch into the first sketch
+    nautilus::invoke(
+        +[](HyperLogLog* sketch1, const HyperLogLog* sketch2) -> void { sketch1->merge(*sketch2); },
+        static_cast<nautilus::val<HyperLogLog*>>(aggregationState1),
+        static_cast<nautilus::val<HyperLogLog*>>(aggregationState2));
+}
+
+Record
+ApproxCountDistinctAggregationPhysicalFunction::lower(const nautilus::val<AggregationState*> aggregationState, PipelineMemoryProvider&)
+{
+    const auto estimate = nautilus::invoke(
+        +[](const HyperLogLog* sketch) -> uint64_t { return sketch->estimate(); },
+        static_cast<nautilus::val<HyperLogLog*>>(aggregationState));
+
+    Record record;
+    record.write(resultFieldIdentifier, VarVal(estimate).castToType(resultType.type));
+    return record;
+}
+
+void ApproxCountDistinctAggregationPhysicalFunction::reset(
+    const nautilus::val<AggregationState*> aggregationState, PipelineMemoryProvider&)
+{
+    /// An empty sketch consists of registers that are all zero
+    const auto memArea = static_cast<nautilus::val<int8_t*>>(aggregationState);
+    nautilus::memset(memArea, 0, getSizeOfStateInBytes());
+}
+
+void ApproxCountDistinctAggregationPhysicalFunction::cleanup(nautilus::val<AggregationState*>)
+{
+}
+
+size_t ApproxCountDistinctAggregationPhysicalFunction::getSizeOfStateInBytes() const
+{
+    return sizeof(HyperLogLog);
+}
+
+AggregationPhysicalFunctionRegistryReturnType
+AggregationPhysicalFunctionGeneratedRegistrar::RegisterApproxCountDistinctAggregationPhysicalFunction(
+    AggregationPhysicalFunctionRegistryArguments arguments)
+{
+    return std::make_shared<ApproxCountDistinctAggregationPhysicalFunction>(
+        std::move(arguments.inputType),
+        std::move(arguments.resultType),
+        arguments.inputFunction,
+        arguments.resultFieldIdentifier,
+        arguments.includeNullValues);
+}
+
+}
@@ -0,0 +1,197 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Aggregation/Function/ApproximateQuantileAggregationPhysicalFunction.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <Aggregation/Function/AggregationPhysicalFunction.hpp>
+#include <Aggregation/Function/QuantileSketches.hpp>
+#include <DataTypes/DataType.hpp>
+#include <Functions/PhysicalFunction.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <nautilus/function.hpp>
+#include <nautilus/std/cstring.h>
+#include <AggregationPhysicalFunctionRegistry.hpp>
+#include <ErrorHandling.hpp>
+#include <ExecutionContext.hpp>
+#include <val.hpp>
+#include <val_arith.hpp>
+#include <val_bool.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+template <typename Sketch>
+ApproximateQuantileAggregationPhysicalFunction<Sketch>::ApproximateQuantileAggregationPhysicalFunction(
+    DataType inputType,
+    DataType resultType,
+    PhysicalFunction inputFunction,
+    Record::RecordFieldIdentifier resultFieldIdentifier,
+    const double quantile)
+    : AggregationPhysicalFunction(std::move(inputType), std::move(resultType), std::move(inputFunction), std::move(resultFieldIdentifier))
+    , quantile(quantile)
+{
+    PRECONDITION(quantile >= 0 and quantile <= 1, "The quantile must be in [0, 1], but got {}", quantile);
+}
+
+template <typename Sketch>
+nautilus::val<Sketch*>
+ApproximateQuantileAggregationPhysicalFunction<Sketch>::getSketch(const nautilus::val<AggregationState*>& aggregationState) const
+{
+    const auto sketchOffset = inputType.nullable ? alignof(Sketch) : 0;
+    return static_cast<nautilus::val<Sketch*>>(aggregationState + nautilus::val<uint64_t>{sketchOffset});
+}
+
+template <typename Sketch>
+void ApproximateQuantileAggregationPhysicalFunction<Sketch>::lift(
+    const nautilus::val<AggregationState*>& aggregationState, PipelineMemoryProvider& pipelineMemoryProvider, const Record& record)
+{
+    const auto value = inputFunction.execute(record, pipelineMemoryProvider.arena);
+    const auto addToSketch = [&]
+    {
+        const auto valueAsDouble = value.castToType(DataType::Type::FLOAT64).getRawValueAs<nautilus::val<double>>();
+        nautilus::invoke(
+            +[](Sketch* sketch, const double value) -> void { sketch->add(value); }, getSketch(aggregationState), valueAsDouble);
+    };
+
+    if (inputType.nullable)
+    {
+        /// Reading the current null value and combining it with the one of the record
+        const auto oldContainsNull = readNull(aggregationState);
+        storeNull(aggregationState, value.isNull() or oldContainsNull);
+        if (not value.isNull())
+        {
+            addToSketch();
+        }
+    }
+    else
+    {
+        addToSketch();
+    }
+}
+
+template <typename Sketch>
+void ApproximateQuantileAggregationPhysicalFunction<Sketch>::combine(
+    const nautilus::val<AggregationState*> aggregationState1,
+    const nautilus::val<AggregationState*> aggregationState2,
+    PipelineMemoryProvider&)
+{
+    if (inputType.nullable)
+    {
+        /// Combining the null values
+        const auto containsNull1 = readNull(aggregationState1);
+        const auto containsNull2 = readNull(aggregationState2);
+        storeNull(aggregationState1, containsNull1 or containsNull2);
+    }
+
+    /// Merging the second sketch into the first sketch
+    nautilus::invoke(
+        +[](Sketch* sketch1, const Sketch* sketch2) -> void { sketch1->merge(*sketch2); },
+        getSketch(aggregationState1),
+        getSketch(aggregationState2));
+}
+
+template <typename Sketch>
+Record ApproximateQuantileAggregationPhysicalFunction<Sketch>::lower(
+    const nautilus::val<AggregationState*> aggregationState, PipelineMemoryProvider&)
+{
+    /// If it contains null values, we simply return a null value
+    const auto containsNull = inputType.nullable ? readNull(aggregationState) : nautilus::val<bool>{false};
+    if (containsNull)
+    {
+        const VarVal zero{nautilus::val<uint64_t>(0), true, true};
+        Record resultRecord;
+        resultRecord.write(resultFieldIdentifier, zero.castToType(resultType.type));
+        return resultRecord;
+    }
+
+    /// An empty sketch can only occur for windows that only contained NaN values. We return 0 as the exact median does for no values.
+    const auto estimatedQuantile = nautilus::invoke(
+        +[](Sketch* sketch, const double quantile) -> double { return sketch->isEmpty() ? 0 : sketch->quantile(quantile); },
+        getSketch(aggregationState),
+        nautilus::val<double>(quantile));
+    Record resultRecord;
+    resultRecord.write(resultFieldIdentifier, VarVal(estimatedQuantile).castToType(resultType.type));
+    return resultRecord;
+}
+
+template <typename Sketch>
+void ApproximateQuantileAggregationPhysicalFunction<Sketch>::reset(
+    const nautilus::val<AggregationState*> aggregationState, PipelineMemoryProvider&)
+{
+    nautilus::invoke(
+        +[](Sketch* sketchMemArea) -> void
+        {
+            /// Creates an empty sketch in the memory area of the aggregation state
+            new (sketchMemArea) Sketch();
+        },
+        getSketch(aggregationState));
+
+    if (inputType.nullable)
+    {
+        const auto memArea = static_cast<nautilus::val<int8_t*>>(aggregationState);
+        nautilus::memset(memArea, 0, 1);
+    }
+}
+
+template <typename Sketch>
+void ApproximateQuantileAggregationPhysicalFunction<Sketch>::cleanup(nautilus::val<AggregationState*>)
+{
+    /// The sketches are trivially destructible and do not own any memory
+}
+
+template <typename Sketch>
+size_t ApproximateQuantileAggregationPhysicalFunction<Sketch>::getSizeOfStateInBytes() const
+{
+    /// ContainsNullValues (padded to the alignment of the sketch) + sketch
+    return (inputType.nullable ? alignof(Sketch) : 0) + sizeof(Sketch);
+}
+
+template class ApproximateQuantileAggregationPhysicalFunction<TDigest>;
+template class ApproximateQuantileAggregationPhysicalFunction<KllSketch>;
+
+/// Both sketches share this translation unit. Thus, the KllQuantile plugin is registered without its own source file.
+AggregationPhysicalFunctionRegistryReturnType
+AggregationPhysicalFunctionGeneratedRegistrar::RegisterTDigestQuantileAggregationPhysicalFunction(
+    AggregationPhysicalFunctionRegistryArguments arguments)
+{
+    INVARIANT(arguments.quantile.has_value(), "Quantile not set");
+    return std::make_shared<TDigestQuantileAggregationPhysicalFunction>(
+        std::move(arguments.inputType),
+        std::move(arguments.resultType),
+        arguments.inputFunction,
+        arguments.resultFieldIdentifier,
+        arguments.quantile.value());
+}
+
+AggregationPhysicalFunctionRegistryReturnType
+AggregationPhysicalFunctionGeneratedRegistrar::RegisterKllQuantileAggregationPhysicalFunction(
+    AggregationPhysicalFunctionRegistryArguments arguments)
+{
+    INVARIANT(arguments.quantile.has_value(), "Quantile not set");
+    return std::make_shared<KllQuantileAggregationPhysicalFunction>(
+        std::move(arguments.inputType),
+        std::move(arguments.resultType),
+        arguments.inputFunction,
+        arguments.resultFieldIdentifier,
+        arguments.quantile.value());
+}
+
+}
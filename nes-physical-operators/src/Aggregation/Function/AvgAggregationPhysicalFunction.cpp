@@ -20,6 +20,7 @@
 #include <utility>
 #include <Aggregation/Function/AggregationPhysicalFunction.hpp>
 #include <DataTypes/DataType.hpp>
+#include <Functions/DecimalArithmeticPhysicalFunction.hpp>
 #include <Functions/PhysicalFunction.hpp>
 #include <Nautilus/DataTypes/VarVal.hpp>
 #include <Nautilus/Interface/Record.hpp>
@@ -65,7 +66,7 @@ void AvgAggregationPhysicalFunction::lift(
         const auto count = VarVal::readNonNullableVarValFromMemory(memAreaCount, countType);
 
         /// Updating the sum and count with the new value
-        const auto newSum = (sum + (value * multiplicationFactor)).castToType(inputType.type);
+        const auto newSum = addInputValues(sum, (value * multiplicationFactor).castToType(inputType.type));
         const auto newCount = count + multiplicationFactor;
 
         /// Writing the new isNull, sum, and count back to the aggregation state
@@ -82,7 +83,7 @@ void AvgAggregationPhysicalFunction::lift(
         const auto count = VarVal::readNonNullableVarValFromMemory(memAreaCount, countType);
 
         /// Updating the sum and count with the new value
-        const auto newSum = (sum + value).castToType(inputType.type);
+        const auto newSum = addInputValues(sum, value);
         const auto newCount = count + nautilus::val<uint64_t>{1};
 
         /// Writing the new sum, and count back to the aggregation state
@@ -113,7 +114,7 @@ void AvgAggregationPhysicalFunction::combine(
         const auto count2 = VarVal::readNonNullableVarValFromMemory(memAreaCount2, countType);
 
         /// Combining the sum and count
-        const auto newSum = (sum1 + sum2).castToType(inputType.type);
+        const auto newSum = addInputValues(sum1, sum2);
         const auto newCount = count1 + count2;
 
         /// Writing the new sum, count and null back to the first aggregation state
@@ -136,7 +137,7 @@ void AvgAggregationPhysicalFunction::combine(
         const auto count2 = VarVal::readNonNullableVarValFromMemory(memAreaCount2, countType);
 
         /// Combining the sum and count
-        const auto newSum = (sum1 + sum2).castToType(inputType.type);
+        const auto newSum = addInputValues(sum1, sum2);
         const auto newCount = count1 + count2;
 
         /// Writing the new sum and count back to the first aggregation state
@@ -145,6 +146,16 @@ void AvgAggregationPhysicalFunction::combine(
     }
 }
 
+VarVal AvgAggregationPhysicalFunction::average(const VarVal& sum, const VarVal& count) const
+{
+    if (resultType.isDecimal())
+    {
+        /// The average of decimals rounds the last digit of the scale half away from zero
+        return DecimalArithmeticPhysicalFunction::evaluate(DecimalOperation::DIV, sum, count.castToType(DataType::Type::INT64), 0);
+    }
+    return sum.castToType(resultType.type) / count.castToType(resultType.type);
+}
+
 Record AvgAggregationPhysicalFunction::lower(const nautilus::val<AggregationState*> aggregationState, PipelineMemoryProvider&)
 {
     if (inputType.nullable)
@@ -157,8 +168,7 @@ Record AvgAggregationPhysicalFunction::lower(const nautilus::val<AggregationStat
         const auto count = VarVal::readNonNullableVarValFromMemory(memAreaCount, countType);
 
         /// Calculating the average and returning a record with the result
-        const auto avg = sum.castToType(resultType.type) / count.castToType(resultType.type);
-        return Record({{resultFieldIdentifier, avg}});
+        return Record({{resultFieldIdentifier, average(sum, count)}});
     }
 
     /// Reading the sum and count from the aggregation state
@@ -168,8 +178,7 @@ Record AvgAggregationPhysicalFunction::lower(const nautilus::val<AggregationStat
     const auto count = VarVal::readNonNullableVarValFromMemory(memAreaCount, countType);
 
     /// Calculating the average and returning a record with the result
-    const auto avg = sum.castToType(resultType.type) / count.castToType(resultType.type);
-    return Record({{resultFieldIdentifier, avg}});
+    return Record({{resultFieldIdentifier, average(sum, count)}});
 }
 
 void AvgAggregationPhysicalFunction::reset(const nautilus::val<AggregationState*> aggregationState, PipelineMemoryProvider&)
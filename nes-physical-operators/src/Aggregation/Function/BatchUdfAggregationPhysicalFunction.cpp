@@ -0,0 +1,196 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Aggregation/Function/BatchUdfAggregationPhysicalFunction.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <Aggregation/Function/AggregationPhysicalFunction.hpp>
+#include <DataTypes/DataType.hpp>
+#include <Functions/BatchUdf.hpp>
+#include <Functions/PhysicalFunction.hpp>
+#include <Nautilus/DataTypes/DataTypesUtil.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <nautilus/function.hpp>
+#include <ErrorHandling.hpp>
+#include <ExecutionContext.hpp>
+#include <val.hpp>
+#include <val_concepts.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+/// The state consists of the number of pending values, the pending values, and the state of the UDF
+struct AggregateUdfStateLayout
+{
+    AggregateBatchUdf udf;
+    DataType inputType;
+    DataType resultType;
+
+    [[nodiscard]] size_t getValuesOffset() const { return sizeof(uint64_t); }
+
+    [[nodiscard]] size_t getUdfStateOffset() const
+    {
+        const auto valuesSize = BatchUdfAggregationPhysicalFunction::BATCH_CAPACITY * inputType.getSizeInBytesWithoutNull();
+        return getValuesOffset() + (valuesSize + sizeof(uint64_t) - 1) / sizeof(uint64_t) * sizeof(uint64_t);
+    }
+
+    void accumulatePendingValues(std::byte* state) const
+    {
+        uint64_t numberOfValues = 0;
+        std::memcpy(&numberOfValues, state, sizeof(numberOfValues));
+        if (numberOfValues == 0)
+        {
+            return;
+        }
+        udf.accumulate(
+            state + getUdfStateOffset(),
+            UdfColumn{.type = inputType.type, .values = state + getValuesOffset(), .nulls = nullptr, .size = numberOfValues});
+        numberOfValues = 0;
+        std::memcpy(state, &numberOfValues, sizeof(numberOfValues));
+    }
+};
+
+namespace
+{
+std::byte* toState(AggregationState* state)
+{
+    return reinterpret_cast<std::byte*>(state);
+}
+
+void accumulateProxy(const AggregateUdfStateLayout* layout, AggregationState* state)
+{
+    INVARIANT(layout != nullptr, "AggregateUdfStateLayout MUST NOT be null at this point");
+    layout->accumulatePendingValues(toState(state));
+}
+
+void combineProxy(const AggregateUdfStateLayout* layout, AggregationState* state, AggregationState* otherState)
+{
+    INVARIANT(layout != nullptr, "AggregateUdfStateLayout MUST NOT be null at this point");
+    layout->accumulatePendingValues(toState(state));
+    layout->accumulatePendingValues(toState(otherState));
+    layout->udf.combine(toState(state) + layout->getUdfStateOffset(), toState(otherState) + layout->getUdfStateOffset());
+}
+
+void finalizeProxy(const AggregateUdfStateLayout* layout, AggregationState* state, int8_t* result)
+{
+    INVARIANT(layout != nullptr, "AggregateUdfStateLayout MUST NOT be null at this point");
+    layout->accumulatePendingValues(toState(state));
+    /// The result holds the value followed by its null flag
+    auto* const resultValue = reinterpret_cast<std::byte*>(result);
+    auto* const resultNull = layout->resultType.nullable
+        ? reinterpret_cast<bool*>(resultValue + layout->resultType.getSizeInBytesWithoutNull())
+        : nullptr;
+    if (resultNull != nullptr)
+    {
+        *resultNull = false;
+    }
+    layout->udf.finalize(
+        toState(state) + layout->getUdfStateOffset(),
+        UdfColumn{.type = layout->resultType.type, .values = resultValue, .nulls = resultNull, .size = 1});
+}
+
+void initializeProxy(const AggregateUdfStateLayout* layout, AggregationState* state)
+{
+    INVARIANT(layout != nullptr, "AggregateUdfStateLayout MUST NOT be null at this point");
+    std::memset(state, 0, layout->getUdfStateOffset());
+    layout->udf.initialize(toState(state) + layout->getUdfStateOffset());
+}
+}
+
+BatchUdfAggregationPhysicalFunction::BatchUdfAggregationPhysicalFunction(
+    const AggregateBatchUdf udf,
+    DataType inputType,
+    DataType resultType,
+    PhysicalFunction inputFunction,
+    Record::RecordFieldIdentifier resultFieldIdentifier)
+    : AggregationPhysicalFunction(inputType, resultType, std::move(inputFunction), std::move(resultFieldIdentifier))
+    , layout(std::make_shared<const AggregateUdfStateLayout>(udf, std::move(inputType), std::move(resultType)))
+{
+    PRECONDITION(
+        udf.initialize != nullptr and udf.accumulate != nullptr and udf.combine != nullptr and udf.finalize != nullptr,
+        "An aggregate batch UDF requires all of its functions");
+    if (this->inputType.isType(DataType::Type::VARSIZED) or this->resultType.isType(DataType::Type::VARSIZED))
+    {
+        throw NotImplemented("Aggregate batch UDFs do not support VARSIZED values");
+    }
+}
+
+void BatchUdfAggregationPhysicalFunction::lift(
+    const nautilus::val<AggregationState*>& aggregationState, PipelineMemoryProvider& pipelineMemoryProvider, const Record& record)
+{
+    const auto value = inputFunction.execute(record, pipelineMemoryProvider.arena);
+    if (not value.isNull())
+    {
+        const auto stateRef = static_cast<nautilus::val<int8_t*>>(aggregationState);
+        const auto numberOfValues = readValueFromMemRef<uint64_t>(stateRef);
+        const auto valueRef = stateRef + nautilus::val<uint64_t>(layout->getValuesOffset())
+            + numberOfValues * nautilus::val<uint64_t>(inputType.getSizeInBytesWithoutNull());
+        value.castToType(inputType.type).writeToMemory(valueRef);
+        VarVal{numberOfValues + 1}.writeToMemory(stateRef);
+        if (numberOfValues + 1 == nautilus::val<uint64_t>(BATCH_CAPACITY))
+        {
+            nautilus::invoke(accumulateProxy, nautilus::val<const AggregateUdfStateLayout*>(layout.get()), aggregationState);
+        }
+    }
+}
+
+void BatchUdfAggregationPhysicalFunction::combine(
+    const nautilus::val<AggregationState*> aggregationState1,
+    const nautilus::val<AggregationState*> aggregationState2,
+    PipelineMemoryProvider&)
+{
+    nautilus::invoke(
+        combineProxy, nautilus::val<const AggregateUdfStateLayout*>(layout.get()), aggregationState1, aggregationState2);
+}
+
+Record BatchUdfAggregationPhysicalFunction::lower(
+    const nautilus::val<AggregationState*> aggregationState, PipelineMemoryProvider& pipelineMemoryProvider)
+{
+    const auto resultRef = pipelineMemoryProvider.arena.allocateMemory(nautilus::val<size_t>(resultType.getSizeInBytesWithNull()));
+    nautilus::invoke(finalizeProxy, nautilus::val<const AggregateUdfStateLayout*>(layout.get()), aggregationState, resultRef);
+
+    Record record;
+    if (resultType.nullable)
+    {
+        const auto null = readValueFromMemRef<bool>(resultRef + nautilus::val<uint64_t>(resultType.getSizeInBytesWithoutNull()));
+        record.write(resultFieldIdentifier, VarVal::readVarValFromMemory(resultRef, resultType, null));
+    }
+    else
+    {
+        record.write(resultFieldIdentifier, VarVal::readNonNullableVarValFromMemory(resultRef, resultType));
+    }
+    return record;
+}
+
+void BatchUdfAggregationPhysicalFunction::reset(const nautilus::val<AggregationState*> aggregationState, PipelineMemoryProvider&)
+{
+    nautilus::invoke(initializeProxy, nautilus::val<const AggregateUdfStateLayout*>(layout.get()), aggregationState);
+}
+
+void BatchUdfAggregationPhysicalFunction::cleanup(nautilus::val<AggregationState*>)
+{
+}
+
+size_t BatchUdfAggregationPhysicalFunction::getSizeOfStateInBytes() const
+{
+    return layout->getUdfStateOffset() + layout->udf.stateSize;
+}
+
+}
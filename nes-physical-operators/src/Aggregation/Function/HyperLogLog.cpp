@@ -0,0 +1,108 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Aggregation/Function/HyperLogLog.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+
+namespace NES
+{
+
+void HyperLogLog::add(const uint64_t hash)
+{
+    const auto index = hash >> (64 - PRECISION);
+    /// The guard bit bounds the number of leading zeros of the remaining bits by 64 - PRECISION
+    const auto remainingBits = (hash << PRECISION) | (uint64_t{1} << (PRECISION - 1));
+    const auto rank = static_cast<uint8_t>(std::countl_zero(remainingBits) + 1);
+    registers[index] = std::max(registers[index], rank);
+}
+
+void HyperLogLog::merge(const HyperLogLog& other)
+{
+    std::ranges::transform(
+        registers, other.registers, registers.begin(), [](const uint8_t left, const uint8_t right) { return std::max(left, right); });
+}
+
+uint64_t HyperLogLog::estimate() const
+{
+    /// We use the improved estimator of Ertl, "New cardinality estimation algorithms for HyperLogLog sketches", which is unbiased for
+    /// small and large cardinalities without the empirical bias correction of HyperLogLog++.
+    constexpr uint64_t maxRank = 64 - PRECISION + 1;
+    std::array<uint64_t, maxRank + 1> histogram{};
+    for (const auto value : registers)
+    {
+        ++histogram[value];
+    }
+
+    constexpr auto numberOfRegisters = static_cast<double>(NUMBER_OF_REGISTERS);
+    auto denominator = numberOfRegisters * tau(1 - (static_cast<double>(histogram[maxRank]) / numberOfRegisters));
+    for (auto rank = maxRank - 1; rank >= 1; --rank)
+    {
+        denominator = 0.5 * (denominator + static_cast<double>(histogram[rank]));
+    }
+    denominator += numberOfRegisters * sigma(static_cast<double>(histogram[0]) / numberOfRegisters);
+    if (std::isinf(denominator))
+    {
+        /// All registers are zero
+        return 0;
+    }
+    constexpr auto alpha = 1 / (2 * std::numbers::ln2);
+    return static_cast<uint64_t>(std::round(alpha * numberOfRegisters * numberOfRegisters / denominator));
+}
+
+double HyperLogLog::sigma(double x)
+{
+    if (x == 1)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    double y = 1;
+    double result = x;
+    double previousResult = 0;
+    do
+    {
+        previousResult = result;
+        x *= x;
+        result += x * y;
+        y += y;
+    } while (result != previousResult);
+    return result;
+}
+
+double HyperLogLog::tau(double x)
+{
+    if (x == 0 or x == 1)
+    {
+        return 0;
+    }
+    double y = 1;
+    double result = 1 - x;
+    double previousResult = 0;
+    do
+    {
+        previousResult = result;
+        x = std::sqrt(x);
+        y *= 0.5;
+        result -= (1 - x) * (1 - x) * y;
+    } while (result != previousResult);
+    return result / 3;
+}
+
+}
@@ -14,13 +14,16 @@
 
 #include <Aggregation/Function/MedianAggregationPhysicalFunction.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <utility>
 #include <Aggregation/Function/AggregationPhysicalFunction.hpp>
 #include <DataTypes/DataType.hpp>
 #include <Functions/PhysicalFunction.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
 #include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
 #include <Nautilus/Interface/PagedVector/PagedVector.hpp>
 #include <Nautilus/Interface/PagedVector/PagedVectorRef.hpp>
@@ -43,9 +46,11 @@ MedianAggregationPhysicalFunction::MedianAggregationPhysicalFunction(
     DataType resultType,
     PhysicalFunction inputFunction,
     Record::RecordFieldIdentifier resultFieldIdentifier,
-    std::shared_ptr<TupleBufferRef> bufferRefPagedVector)
+    std::shared_ptr<TupleBufferRef> bufferRefPagedVector,
+    const bool compressPagedVectorPages)
     : AggregationPhysicalFunction(std::move(inputType), std::move(resultType), std::move(inputFunction), std::move(resultFieldIdentifier))
     , bufferRefPagedVector(std::move(bufferRefPagedVector))
+    , compressPagedVectorPages(compressPagedVectorPages)
 {
 }
 
@@ -65,7 +70,7 @@ void MedianAggregationPhysicalFunction::lift(
     }
 
     /// Adding the record to the paged vector. We are storing the full record in the paged vector for now.
-    const PagedVectorRef pagedVectorRef(memArea, bufferRefPagedVector);
+    const PagedVectorRef pagedVectorRef(memArea, bufferRefPagedVector, compressPagedVectorPages);
     pagedVectorRef.writeRecord(record, pipelineMemoryProvider.bufferProvider);
 }
 
@@ -98,9 +103,17 @@ void MedianAggregationPhysicalFunction::combine(
 Record MedianAggregationPhysicalFunction::lower(
     const nautilus::val<AggregationState*> aggregationState, PipelineMemoryProvider& pipelineMemoryProvider)
 {
-    /// If it contains null values, we simply return a null value
+    /// Getting the paged vector from the aggregation state
+    const auto pagedVectorPtr
+        = static_cast<nautilus::val<PagedVector*>>(aggregationState + nautilus::val<uint64_t>{static_cast<uint64_t>(inputType.nullable)});
+    const PagedVectorRef pagedVectorRef(pagedVectorPtr, bufferRefPagedVector);
+    const auto allFieldNames = bufferRefPagedVector->getAllFieldNames();
+    const auto numberOfEntries
+        = invoke(+[](const PagedVector* pagedVector) { return pagedVector->getTotalNumberOfEntries(); }, pagedVectorPtr);
+
+    /// If it contains null values or no values at all, e.g., for a state that was reset but never lifted, we return a null value
     const auto containsNull = inputType.nullable ? readNull(aggregationState) : nautilus::val<bool>{false};
-    if (containsNull)
+    if (containsNull or numberOfEntries == nautilus::val<uint64_t>(0))
     {
         const VarVal zero{nautilus::val<uint64_t>(0), true, true};
         const VarVal medianValue = zero.castToType(resultType.type);
@@ -109,85 +122,35 @@ Record MedianAggregationPhysicalFunction::lower(
         return resultRecord;
     }
 
-    /// Getting the paged vector from the aggregation state
-    const auto pagedVectorPtr
-        = static_cast<nautilus::val<PagedVector*>>(aggregationState + nautilus::val<uint64_t>{static_cast<uint64_t>(inputType.nullable)});
-    const PagedVectorRef pagedVectorRef(pagedVectorPtr, bufferRefPagedVector);
-    const auto allFieldNames = bufferRefPagedVector->getAllFieldNames();
-    const auto numberOfEntries = invoke(
-        +[](const PagedVector* pagedVector)
-        {
-            const auto numberOfEntriesVal = pagedVector->getTotalNumberOfEntries();
-            INVARIANT(numberOfEntriesVal > 0, "The number of entries in the paged vector must be greater than 0");
-            return numberOfEntriesVal;
-        },
-        pagedVectorPtr);
-
-    /// Iterating in two nested loops over all the records in the paged vector to get the median.
-    /// We pick a candidate and then count for each item, if the candidate is smaller and also if the candidate is less than the item.
-    const nautilus::val<int64_t> medianPos1 = (numberOfEntries - 1) / 2;
-    const nautilus::val<int64_t> medianPos2 = numberOfEntries / 2;
-    nautilus::val<uint64_t> medianItemPos1 = 0;
-    nautilus::val<uint64_t> medianItemPos2 = 0;
-    nautilus::val<bool> medianFound1(false);
-    nautilus::val<bool> medianFound2(false);
-
-
-    /// Picking a candidate and counting how many items are smaller or equal to the candidate
+    /// Copying the values into a contiguous array, as selecting the median via nth_element requires random access to the values.
+    /// In contrast to sorting, nth_element finds the median in linear time.
+    const auto values = pipelineMemoryProvider.arena.allocateMemory(numberOfEntries * nautilus::val<size_t>(sizeof(double)));
+    nautilus::val<uint64_t> valuePos = 0;
     const auto endIt = pagedVectorRef.end(allFieldNames);
-    for (auto candidateIt = pagedVectorRef.begin(allFieldNames); candidateIt != endIt; ++candidateIt)
+    for (auto it = pagedVectorRef.begin(allFieldNames); it != endIt; ++it)
     {
-        nautilus::val<int64_t> countLessThan = 0;
-        nautilus::val<int64_t> countEqual = 0;
-        const auto candidateRecord = *candidateIt;
-        const auto candidateValue = inputFunction.execute(candidateRecord, pipelineMemoryProvider.arena);
-
-        /// Counting how many items are smaller or equal for the current candidate
-        for (auto itemIt = pagedVectorRef.begin(allFieldNames); itemIt != endIt; ++itemIt)
-        {
-            const auto itemRecord = *itemIt;
-            const auto itemValue = inputFunction.execute(itemRecord, pipelineMemoryProvider.arena);
-            if (itemValue < candidateValue)
-            {
-                countLessThan = countLessThan + 1;
-            }
-            if (itemValue == candidateValue)
-            {
-                countEqual = countEqual + 1;
-            }
-        }
-
-        /// Checking if the current candidate is the median, and if so, storing the position of the median
-        /// The current candidate is the median if the number of items that are smaller or equal to the candidate is larger than the median position
-        if (not medianFound1 && countLessThan <= medianPos1 && medianPos1 < countLessThan + countEqual)
-        {
-            medianItemPos1 = candidateIt - pagedVectorRef.begin(allFieldNames);
-            medianFound1 = true;
-        }
-        if (not medianFound2 && countLessThan <= medianPos2 && medianPos2 < countLessThan + countEqual)
-        {
-            medianItemPos2 = candidateIt - pagedVectorRef.begin(allFieldNames);
-            medianFound2 = true;
-        }
+        const auto value = inputFunction.execute(*it, pipelineMemoryProvider.arena);
+        value.castToType(DataType::Type::FLOAT64).writeToMemory(values + (valuePos * nautilus::val<uint64_t>(sizeof(double))));
+        valuePos = valuePos + 1;
     }
 
-    /// Setting the default median value. If a median was found, the value will be overwritten
-    const VarVal zero(nautilus::val<uint64_t>(0));
-    VarVal medianValue = zero.castToType(resultType.type);
-    if (medianFound1 and medianFound2)
-    {
-        /// Calculating the median value. Regardless if the number of entries is odd or even, we calculate the median as the average of the two middle values.
-        /// For even numbers of entries, this is its natural definition.
-        /// For odd numbers of entries, both positions are pointing to the same item and thus, we are calculating the average of the same item, which is the item itself.
-        const auto medianRecord1 = pagedVectorRef.readRecord(medianItemPos1, allFieldNames);
-        const auto medianRecord2 = pagedVectorRef.readRecord(medianItemPos2, allFieldNames);
-
-        const auto medianValue1 = inputFunction.execute(medianRecord1, pipelineMemoryProvider.arena);
-        const auto medianValue2 = inputFunction.execute(medianRecord2, pipelineMemoryProvider.arena);
-        const VarVal two = nautilus::val<uint64_t>(2);
-        medianValue
-            = (medianValue1.castToType(resultType.type) + medianValue2.castToType(resultType.type)) / two.castToType(resultType.type);
-    }
+    /// Regardless if the number of entries is odd or even, we calculate the median as the average of the two middle values.
+    /// For even numbers of entries, this is its natural definition.
+    /// For odd numbers of entries, both positions are pointing to the same item and thus, we are calculating the average of the same item, which is the item itself.
+    const auto median = nautilus::invoke(
+        +[](int8_t* valuesMemArea, const uint64_t numberOfValues) -> double
+        {
+            /// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            const std::span values{reinterpret_cast<double*>(valuesMemArea), numberOfValues};
+            const auto upperMedian = values.begin() + static_cast<std::ptrdiff_t>(numberOfValues / 2);
+            std::nth_element(values.begin(), upperMedian, values.end());
+            /// After nth_element, all values before the upper median are smaller or equal. Thus, the lower median is their maximum.
+            const auto lowerMedian = numberOfValues % 2 == 0 ? std::max_element(values.begin(), upperMedian) : upperMedian;
+            return (*lowerMedian + *upperMedian) / 2;
+        },
+        values,
+        numberOfEntries);
+    const VarVal medianValue = VarVal(median).castToType(resultType.type);
 
     /// Adding the median to the result record
     Record resultRecord;
@@ -232,6 +195,11 @@ size_t MedianAggregationPhysicalFunction::getSizeOfStateInBytes() const
     return static_cast<uint64_t>(inputType.nullable) + sizeof(PagedVector);
 }
 
+bool MedianAggregationPhysicalFunction::isStateSelfContained() const
+{
+    return false;
+}
+
 AggregationPhysicalFunctionRegistryReturnType AggregationPhysicalFunctionGeneratedRegistrar::RegisterMedianAggregationPhysicalFunction(
     AggregationPhysicalFunctionRegistryArguments arguments)
 {
@@ -241,7 +209,8 @@ AggregationPhysicalFunctionRegistryReturnType AggregationPhysicalFunctionGenerat
         std::move(arguments.resultType),
         arguments.inputFunction,
         arguments.resultFieldIdentifier,
-        arguments.bufferRefPagedVector.value());
+        arguments.bufferRefPagedVector.value(),
+        arguments.compressPagedVectorPages);
 }
 
 }
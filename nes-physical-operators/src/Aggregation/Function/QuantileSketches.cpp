@@ -0,0 +1,331 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Aggregation/Function/QuantileSketches.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <utility>
+#include <vector>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+namespace
+{
+/// k1 scale function of the t-digest, which maps a quantile to the index of a centroid
+double scaleFunction(const double quantile)
+{
+    return (static_cast<double>(TDigest::COMPRESSION) / (2 * std::numbers::pi)) * std::asin((2 * quantile) - 1);
+}
+}
+
+void TDigest::add(const double value)
+{
+    /// NaN values do not have a rank
+    if (std::isnan(value))
+    {
+        return;
+    }
+    min = isEmpty() ? value : std::min(min, value);
+    max = isEmpty() ? value : std::max(max, value);
+    totalWeight += 1;
+    buffer[numberOfBufferedValues++] = value;
+    if (numberOfBufferedValues == BUFFER_CAPACITY)
+    {
+        compress(nullptr, 0);
+    }
+}
+
+void TDigest::merge(const TDigest& other)
+{
+    if (other.isEmpty())
+    {
+        return;
+    }
+    min = isEmpty() ? other.min : std::min(min, other.min);
+    max = isEmpty() ? other.max : std::max(max, other.max);
+    totalWeight += other.totalWeight;
+    for (uint64_t i = 0; i < other.numberOfBufferedValues; ++i)
+    {
+        buffer[numberOfBufferedValues++] = other.buffer[i];
+        if (numberOfBufferedValues == BUFFER_CAPACITY)
+        {
+            compress(nullptr, 0);
+        }
+    }
+    compress(other.centroids.data(), other.numberOfCentroids);
+}
+
+void TDigest::compress(const Centroid* additionalCentroids, const uint64_t numberOfAdditionalCentroids)
+{
+    std::array<Centroid, (2 * CENTROID_CAPACITY) + BUFFER_CAPACITY> mergeInput{};
+    auto* end = std::copy_n(centroids.begin(), numberOfCentroids, mergeInput.begin());
+    end = std::copy_n(additionalCentroids, numberOfAdditionalCentroids, end);
+    end = std::transform(
+        buffer.begin(), buffer.begin() + numberOfBufferedValues, end, [](const double value) { return Centroid{value, 1}; });
+    numberOfBufferedValues = 0;
+    std::sort(mergeInput.begin(), end, [](const Centroid& left, const Centroid& right) { return left.mean < right.mean; });
+
+    /// We greedily merge neighbouring centroids, as long as the merged centroid spans at most one unit of the scale function.
+    /// Thus, two neighbouring centroids always span more than one unit, which bounds the number of centroids by COMPRESSION + 1.
+    const auto mergedWeight = totalWeight;
+    numberOfCentroids = 0;
+    auto current = mergeInput.front();
+    double weightBeforeCurrent = 0;
+    auto scaleBeforeCurrent = scaleFunction(0);
+    for (const auto* next = mergeInput.begin() + 1; next < end; ++next)
+    {
+        const auto quantileAfterNext = std::min(1.0, (weightBeforeCurrent + current.weight + next->weight) / mergedWeight);
+        if (scaleFunction(quantileAfterNext) - scaleBeforeCurrent <= 1)
+        {
+            current.weight += next->weight;
+            current.mean += (next->mean - current.mean) * next->weight / current.weight;
+        }
+        else
+        {
+            INVARIANT(numberOfCentroids < CENTROID_CAPACITY, "The t-digest exceeds its capacity of {} centroids", CENTROID_CAPACITY);
+            centroids[numberOfCentroids++] = current;
+            weightBeforeCurrent += current.weight;
+            scaleBeforeCurrent = scaleFunction(std::min(1.0, weightBeforeCurrent / mergedWeight));
+            current = *next;
+        }
+    }
+    INVARIANT(numberOfCentroids < CENTROID_CAPACITY, "The t-digest exceeds its capacity of {} centroids", CENTROID_CAPACITY);
+    centroids[numberOfCentroids++] = current;
+}
+
+double TDigest::quantile(const double quantile)
+{
+    PRECONDITION(not isEmpty(), "Cannot estimate a quantile of an empty t-digest");
+    if (numberOfBufferedValues > 0)
+    {
+        compress(nullptr, 0);
+    }
+    if (numberOfCentroids == 1)
+    {
+        return centroids.front().mean;
+    }
+
+    /// We interpolate linearly between the centers of the centroids and between the outermost centers and the minimum/maximum value
+    const auto index = std::clamp(quantile, 0.0, 1.0) * totalWeight;
+    const auto& first = centroids.front();
+    if (index < first.weight / 2)
+    {
+        return min + ((first.mean - min) * index / (first.weight / 2));
+    }
+    double weightBefore = 0;
+    for (uint64_t i = 0; i + 1 < numberOfCentroids; ++i)
+    {
+        const auto& left = centroids[i];
+        const auto& right = centroids[i + 1];
+        const auto leftCenter = weightBefore + (left.weight / 2);
+        const auto rightCenter = weightBefore + left.weight + (right.weight / 2);
+        if (index < rightCenter)
+        {
+            return left.mean + ((right.mean - left.mean) * (index - leftCenter) / (rightCenter - leftCenter));
+        }
+        weightBefore += left.weight;
+    }
+    const auto& last = centroids[numberOfCentroids - 1];
+    const auto lastCenter = totalWeight - (last.weight / 2);
+    return std::min(max, last.mean + ((max - last.mean) * (index - lastCenter) / (last.weight / 2)));
+}
+
+KllSketch::KllSketch()
+{
+    levelStarts.fill(ITEM_CAPACITY);
+}
+
+void KllSketch::add(const double value)
+{
+    /// NaN values do not have a rank
+    if (std::isnan(value))
+    {
+        return;
+    }
+    min = isEmpty() ? value : std::min(min, value);
+    max = isEmpty() ? value : std::max(max, value);
+    if (levelStarts[0] == 0)
+    {
+        makeSpace();
+    }
+    items[--levelStarts[0]] = value;
+    ++numberOfValues;
+}
+
+void KllSketch::merge(const KllSketch& other)
+{
+    if (other.isEmpty())
+    {
+        return;
+    }
+    min = isEmpty() ? other.min : std::min(min, other.min);
+    max = isEmpty() ? other.max : std::max(max, other.max);
+    numberOfValues += other.numberOfValues;
+    while (numberOfLevels < other.numberOfLevels)
+    {
+        addLevel();
+    }
+
+    /// Inserts the items of each level of the other sketch into the same level of this sketch, as they have the same weight
+    for (uint64_t level = 0; level < other.numberOfLevels; ++level)
+    {
+        const auto* otherItems = other.items.begin() + other.levelStarts[level];
+        auto remainingItems = other.getLevelSize(level);
+        while (remainingItems > 0)
+        {
+            if (levelStarts[0] == 0)
+            {
+                makeSpace();
+            }
+            const auto numberOfInsertedItems = std::min(remainingItems, levelStarts[0]);
+            std::move(items.begin() + levelStarts[0], items.begin() + levelStarts[level], items.begin() + levelStarts[0] - numberOfInsertedItems);
+            for (uint64_t lowerLevel = 0; lowerLevel <= level; ++lowerLevel)
+            {
+                levelStarts[lowerLevel] -= numberOfInsertedItems;
+            }
+            std::copy_n(otherItems, numberOfInsertedItems, items.begin() + levelStarts[level]);
+            if (level > 0)
+            {
+                std::sort(items.begin() + levelStarts[level], items.begin() + levelStarts[level + 1]);
+            }
+            otherItems += numberOfInsertedItems;
+            remainingItems -= numberOfInsertedItems;
+        }
+    }
+}
+
+double KllSketch::quantile(const double quantile) const
+{
+    PRECONDITION(not isEmpty(), "Cannot estimate a quantile of an empty KLL sketch");
+    if (quantile <= 0)
+    {
+        return min;
+    }
+    if (quantile >= 1)
+    {
+        return max;
+    }
+
+    std::vector<std::pair<double, uint64_t>> weightedItems;
+    weightedItems.reserve(ITEM_CAPACITY - levelStarts[0]);
+    for (uint64_t level = 0; level < numberOfLevels; ++level)
+    {
+        for (auto i = levelStarts[level]; i < levelStarts[level + 1]; ++i)
+        {
+            weightedItems.emplace_back(items[i], uint64_t{1} << level);
+        }
+    }
+    std::ranges::sort(weightedItems);
+
+    /// Compacting a level keeps the total weight of all items, i.e., it is still the number of values seen
+    const auto rank = quantile * static_cast<double>(numberOfValues);
+    uint64_t cumulativeWeight = 0;
+    for (const auto& [item, weight] : weightedItems)
+    {
+        cumulativeWeight += weight;
+        if (static_cast<double>(cumulativeWeight) >= rank)
+        {
+            return item;
+        }
+    }
+    return max;
+}
+
+uint64_t KllSketch::getLevelCapacity(const uint64_t level) const
+{
+    const auto depth = numberOfLevels - 1 - level;
+    const auto capacity = static_cast<double>(K) * std::pow(2.0 / 3.0, static_cast<double>(depth));
+    return std::max(MIN_LEVEL_CAPACITY, static_cast<uint64_t>(capacity));
+}
+
+void KllSketch::makeSpace()
+{
+    /// The capacities of all levels sum up to at most ITEM_CAPACITY. Thus, if the sketch is full, at least one level reached its capacity.
+    for (uint64_t level = 0; level < numberOfLevels; ++level)
+    {
+        if (getLevelSize(level) >= getLevelCapacity(level))
+        {
+            compactLevel(level);
+            return;
+        }
+    }
+    INVARIANT(false, "A full KLL sketch must contain a level that reached its capacity");
+}
+
+void KllSketch::compactLevel(const uint64_t level)
+{
+    if (level == numberOfLevels - 1)
+    {
+        addLevel();
+    }
+    const auto start = levelStarts[level];
+    const auto end = levelStarts[level + 1];
+    const auto nextEnd = levelStarts[level + 2];
+    if (level == 0)
+    {
+        std::sort(items.begin() + start, items.begin() + end);
+    }
+
+    /// If the level contains an odd number of items, the smallest item stays in the level.
+    /// Of every pair of the remaining items, a coin flip decides whether the even or the odd item is promoted with twice the weight.
+    const auto numberOfKeptItems = (end - start) % 2;
+    const auto numberOfPromotedItems = (end - start) / 2;
+    const auto offset = static_cast<uint64_t>(flipCoin());
+    std::array<double, ITEM_CAPACITY> promotedItems{};
+    for (uint64_t i = 0; i < numberOfPromotedItems; ++i)
+    {
+        promotedItems[i] = items[start + numberOfKeptItems + (2 * i) + offset];
+    }
+    std::array<double, ITEM_CAPACITY> mergedItems{};
+    const auto* mergedEnd = std::merge(
+        promotedItems.begin(),
+        promotedItems.begin() + numberOfPromotedItems,
+        items.begin() + end,
+        items.begin() + nextEnd,
+        mergedItems.begin());
+
+    /// The compaction frees numberOfPromotedItems items. Thus, the kept item and all lower levels move up by that many items.
+    std::move_backward(
+        items.begin() + levelStarts[0], items.begin() + start + numberOfKeptItems, items.begin() + start + numberOfKeptItems + numberOfPromotedItems);
+    for (uint64_t lowerLevel = 0; lowerLevel <= level; ++lowerLevel)
+    {
+        levelStarts[lowerLevel] += numberOfPromotedItems;
+    }
+    levelStarts[level + 1] = end - numberOfPromotedItems;
+    std::copy(mergedItems.cbegin(), mergedEnd, items.begin() + levelStarts[level + 1]);
+}
+
+void KllSketch::addLevel()
+{
+    INVARIANT(numberOfLevels < MAX_NUMBER_OF_LEVELS, "The KLL sketch exceeds its maximum number of {} levels", MAX_NUMBER_OF_LEVELS);
+    ++numberOfLevels;
+    levelStarts[numberOfLevels] = ITEM_CAPACITY;
+}
+
+bool KllSketch::flipCoin()
+{
+    /// xorshift64, as the sketch must be trivially copyable and only needs unbiased coin flips
+    randomState ^= randomState << 13U;
+    randomState ^= randomState >> 7U;
+    randomState ^= randomState << 17U;
+    return (randomState & 1U) != 0;
+}
+
+}
@@ -0,0 +1,75 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Aggregation/Function/SharedStateAggregationPhysicalFunction.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <Aggregation/Function/AggregationPhysicalFunction.hpp>
+#include <DataTypes/DataType.hpp>
+#include <Functions/PhysicalFunction.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <ExecutionContext.hpp>
+#include <val.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+SharedStateAggregationPhysicalFunction::SharedStateAggregationPhysicalFunction(
+    std::shared_ptr<AggregationPhysicalFunction> function,
+    DataType inputType,
+    PhysicalFunction inputFunction,
+    const size_t offsetOfSharedState)
+    : AggregationPhysicalFunction(
+          std::move(inputType), function->getResultType(), std::move(inputFunction), function->getResultFieldIdentifier())
+    , function(std::move(function))
+    , offsetOfSharedState(offsetOfSharedState)
+{
+}
+
+void SharedStateAggregationPhysicalFunction::lift(const nautilus::val<AggregationState*>&, PipelineMemoryProvider&, const Record&)
+{
+    /// The other aggregation lifts the record into the shared state
+}
+
+void SharedStateAggregationPhysicalFunction::combine(
+    nautilus::val<AggregationState*>, nautilus::val<AggregationState*>, PipelineMemoryProvider&)
+{
+    /// The other aggregation combines the shared states
+}
+
+Record SharedStateAggregationPhysicalFunction::lower(
+    const nautilus::val<AggregationState*> aggregationState, PipelineMemoryProvider& pipelineMemoryProvider)
+{
+    return function->lower(aggregationState + nautilus::val<uint64_t>(offsetOfSharedState), pipelineMemoryProvider);
+}
+
+void SharedStateAggregationPhysicalFunction::reset(nautilus::val<AggregationState*>, PipelineMemoryProvider&)
+{
+    /// The other aggregation resets the shared state
+}
+
+void SharedStateAggregationPhysicalFunction::cleanup(nautilus::val<AggregationState*>)
+{
+}
+
+size_t SharedStateAggregationPhysicalFunction::getSizeOfStateInBytes() const
+{
+    return 0;
+}
+
+}
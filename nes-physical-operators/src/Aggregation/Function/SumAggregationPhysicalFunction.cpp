@@ -51,7 +51,7 @@ void SumAggregationPhysicalFunction::lift(
         const auto sum = VarVal::readVarValFromMemory(memAreaSum, inputType, isNull);
 
         /// If value is null, we keep the old value. Otherwise, we add the value to the sum.
-        const auto newSum = VarVal::select(isNull, sum, (sum + value).castToType(inputType.type));
+        const auto newSum = VarVal::select(isNull, sum, addInputValues(sum, value));
         newSum.writeToMemory(memAreaSum);
         storeNull(aggregationState, isNull);
     }
@@ -62,7 +62,7 @@ void SumAggregationPhysicalFunction::lift(
         const auto sum = VarVal::readNonNullableVarValFromMemory(memAreaSum, inputType);
 
         /// Updating the sum and write it back to the aggregation state
-        const auto newSum = (sum + value).castToType(inputType.type);
+        const auto newSum = addInputValues(sum, value);
         newSum.writeToMemory(memAreaSum);
     }
 }
@@ -85,7 +85,7 @@ void SumAggregationPhysicalFunction::combine(
         const auto sum2 = VarVal::readVarValFromMemory(memAreaSum2, inputType, isNull2);
 
         /// Combining the sum
-        const auto newSum = (sum1 + sum2).castToType(inputType.type);
+        const auto newSum = addInputValues(sum1, sum2);
 
         /// Writing the new sum and null back to the first aggregation state
         newSum.writeToMemory(memAreaSum1);
@@ -102,7 +102,7 @@ void SumAggregationPhysicalFunction::combine(
         const auto sum2 = VarVal::readNonNullableVarValFromMemory(memAreaSum2, inputType);
 
         /// Combining the sum and writing it back to the first aggregation state
-        const auto newSum = (sum1 + sum2).castToType(inputType.type);
+        const auto newSum = addInputValues(sum1, sum2);
         newSum.writeToMemory(memAreaSum1);
     }
 }
@@ -0,0 +1,103 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Aggregation/PreAggregation.hpp>
+
+#include <memory>
+#include <utility>
+#include <Aggregation/AggregationSlice.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Time/Timestamp.hpp>
+#include <ErrorHandling.hpp>
+#include <HashMapSlice.hpp>
+
+namespace NES
+{
+
+HashMap* PreAggregation::tryGetHashMap(const Timestamp timestamp)
+{
+    if (slice == nullptr or timestamp < slice->getSliceStart() or timestamp >= slice->getSliceEnd())
+    {
+        return nullptr;
+    }
+    if (bypassed)
+    {
+        return sliceHashMap;
+    }
+    if (hashMap->getNumberOfTuples() >= MAX_NUMBER_OF_KEYS)
+    {
+        return nullptr;
+    }
+    ++numberOfRecords;
+    return hashMap.get();
+}
+
+HashMap* PreAggregation::moveToSlice(
+    std::shared_ptr<AggregationSlice> slice,
+    const WorkerThreadId workerThreadId,
+    const CreateNewHashMapSliceArgs& createNewHashMapSliceArgs,
+    const CombineFunction& combineFunction,
+    const CleanupFunction& cleanupFunction)
+{
+    PRECONDITION(slice != nullptr, "The pre-aggregation requires a slice");
+    if (slice == this->slice and not bypassed)
+    {
+        /// The pre-aggregation is full
+        bypassed = numberOfRecords < MIN_NUMBER_OF_RECORDS_PER_KEY * hashMap->getNumberOfTuples();
+    }
+    combineKeys(combineFunction, cleanupFunction);
+    sliceHashMap = slice->getHashMapPtrOrCreate(workerThreadId);
+    this->slice = std::move(slice);
+    if (bypassed)
+    {
+        return sliceHashMap;
+    }
+
+    if (hashMap == nullptr)
+    {
+        /// The hash map never grows, as it holds at most as many keys as it has buckets
+        auto preAggregationArgs = createNewHashMapSliceArgs;
+        preAggregationArgs.numberOfBuckets = MAX_NUMBER_OF_KEYS;
+        hashMap = createHashMap(preAggregationArgs);
+    }
+    ++numberOfRecords;
+    return hashMap.get();
+}
+
+void PreAggregation::combineIntoSlice(const CombineFunction& combineFunction, const CleanupFunction& cleanupFunction)
+{
+    combineKeys(combineFunction, cleanupFunction);
+    slice.reset();
+    sliceHashMap = nullptr;
+    bypassed = false;
+}
+
+bool PreAggregation::isBypassed() const
+{
+    return bypassed;
+}
+
+void PreAggregation::combineKeys(const CombineFunction& combineFunction, const CleanupFunction& cleanupFunction)
+{
+    if (hashMap != nullptr and hashMap->getNumberOfTuples() > 0)
+    {
+        combineFunction(sliceHashMap, hashMap.get());
+        cleanupFunction(hashMap.get());
+        hashMap->clear();
+    }
+    numberOfRecords = 0;
+}
+
+}
@@ -0,0 +1,232 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Aggregation/SlidingWindowAggregates.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <utility>
+#include <vector>
+#include <Aggregation/AggregationSlice.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <SliceStore/Slice.hpp>
+#include <SliceStore/WindowSlicesStoreInterface.hpp>
+#include <Time/Timestamp.hpp>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+namespace
+{
+/// For fewer slides per window, building the prefixes and suffixes costs about as many combines as combining each window from scratch
+constexpr uint64_t MIN_NUMBER_OF_SLIDES_PER_WINDOW = 4;
+
+bool containsKeys(const HashMap* hashMap)
+{
+    return hashMap != nullptr and hashMap->getNumberOfTuples() > 0;
+}
+}
+
+PartialAggregate::PartialAggregate(const uint64_t numberOfPartitions, CleanupFunction cleanupFunction)
+    : hashMaps(numberOfPartitions), cleanupFunction(std::move(cleanupFunction))
+{
+}
+
+PartialAggregate::~PartialAggregate()
+{
+    for (const auto& hashMap : hashMaps | std::views::filter([](const auto& hashMap) { return containsKeys(hashMap.get()); }))
+    {
+        cleanupFunction(hashMap.get());
+    }
+}
+
+HashMap* PartialAggregate::getHashMapPtr(const uint64_t partition) const
+{
+    return hashMaps.at(partition).get();
+}
+
+HashMap* PartialAggregate::getHashMapPtrOrCreate(const uint64_t partition, const HashMap& sameConfigurationAs)
+{
+    if (hashMaps.at(partition) == nullptr)
+    {
+        hashMaps.at(partition) = sameConfigurationAs.createNewMapWithSameConfiguration();
+    }
+    return hashMaps[partition].get();
+}
+
+SlidingWindowAggregates::Block::Block(const Timestamp blockStart, const Timestamp blockEnd) : prefixEnd(blockStart), suffixStart(blockEnd)
+{
+}
+
+SlidingWindowAggregates::SlidingWindowAggregates(const uint64_t windowSize, const uint64_t windowSlide, const uint64_t numberOfPartitions)
+    : blockSize(((windowSize + windowSlide - 1) / windowSlide) * windowSlide), numberOfPartitions(numberOfPartitions)
+{
+    PRECONDITION(windowSize > 0 and windowSlide > 0, "Window size {} and slide {} must be larger than 0", windowSize, windowSlide);
+    PRECONDITION(numberOfPartitions > 0, "The aggregation requires at least one partition");
+}
+
+bool SlidingWindowAggregates::isBeneficial(const uint64_t windowSize, const uint64_t windowSlide)
+{
+    return windowSlide > 0 and windowSize >= MIN_NUMBER_OF_SLIDES_PER_WINDOW * windowSlide;
+}
+
+uint64_t SlidingWindowAggregates::getBlockSize() const
+{
+    return blockSize;
+}
+
+WindowPartialAggregates SlidingWindowAggregates::getPartialAggregates(
+    const WindowInfo& windowInfo,
+    const std::vector<std::shared_ptr<Slice>>& windowSlices,
+    const CombineFunction& combineFunction,
+    const PartialAggregate::CleanupFunction& cleanupFunction)
+{
+    std::vector<std::shared_ptr<AggregationSlice>> sortedSlices;
+    sortedSlices.reserve(windowSlices.size());
+    for (const auto& slice : windowSlices)
+    {
+        auto aggregationSlice = std::dynamic_pointer_cast<AggregationSlice>(slice);
+        INVARIANT(aggregationSlice != nullptr, "The slices of an aggregation window should be AggregationSlices");
+        INVARIANT(
+            aggregationSlice->getNumberOfPartitions() == numberOfPartitions,
+            "Expected {} partitions but the slice has {}",
+            numberOfPartitions,
+            aggregationSlice->getNumberOfPartitions());
+        sortedSlices.emplace_back(std::move(aggregationSlice));
+    }
+    std::ranges::sort(sortedSlices, {}, [](const auto& slice) { return slice->getSliceStart(); });
+
+    const auto blockIndex = windowInfo.windowStart.getRawValue() / blockSize;
+    const Timestamp blockEnd((blockIndex + 1) * blockSize);
+
+    const std::scoped_lock lock(mutex);
+    std::erase_if(blocks, [blockIndex](const auto& indexAndBlock) { return indexAndBlock.first < blockIndex; });
+    if (windowInfo.windowEnd <= blockEnd)
+    {
+        /// As windows start at multiples of the slide, a window that ends within its block starts at the block start
+        INVARIANT(windowInfo.windowStart.getRawValue() % blockSize == 0, "Window {} should start at a block start", windowInfo.windowStart);
+        auto prefix = getPrefix(getOrCreateBlock(blockIndex), windowInfo.windowEnd, sortedSlices, combineFunction, cleanupFunction);
+        return {.suffix = nullptr, .prefix = std::move(prefix)};
+    }
+    INVARIANT(
+        windowInfo.windowEnd <= blockEnd + blockSize,
+        "Window {}-{} should not span more than two blocks",
+        windowInfo.windowStart,
+        windowInfo.windowEnd);
+    auto suffix = getSuffix(getOrCreateBlock(blockIndex), windowInfo.windowStart, sortedSlices, combineFunction, cleanupFunction);
+    auto prefix = getPrefix(getOrCreateBlock(blockIndex + 1), windowInfo.windowEnd, sortedSlices, combineFunction, cleanupFunction);
+    return {.suffix = std::move(suffix), .prefix = std::move(prefix)};
+}
+
+SlidingWindowAggregates::Block& SlidingWindowAggregates::getOrCreateBlock(const uint64_t blockIndex)
+{
+    return blocks.try_emplace(blockIndex, Timestamp(blockIndex * blockSize), Timestamp((blockIndex + 1) * blockSize)).first->second;
+}
+
+std::shared_ptr<const PartialAggregate> SlidingWindowAggregates::getPrefix(
+    Block& block,
+    const Timestamp end,
+    const std::vector<std::shared_ptr<AggregationSlice>>& sortedSlices,
+    const CombineFunction& combineFunction,
+    const PartialAggregate::CleanupFunction& cleanupFunction) const
+{
+    if (block.prefixEnd < end)
+    {
+        /// The window contains all slices between the already computed prefixes and its end
+        auto prefix = block.prefixes.empty() ? nullptr : block.prefixes.rbegin()->second;
+        for (const auto& slice : sortedSlices)
+        {
+            if (slice->getSliceStart() >= block.prefixEnd and slice->getSliceEnd() <= end)
+            {
+                prefix = combine(prefix, *slice, combineFunction, cleanupFunction);
+                block.prefixes.emplace(slice->getSliceEnd(), prefix);
+            }
+        }
+        block.prefixEnd = end;
+    }
+
+    /// The prefix up to the end is the prefix of the last slice that ends before or at the end
+    const auto nextPrefix = block.prefixes.upper_bound(end);
+    return nextPrefix == block.prefixes.begin() ? nullptr : std::prev(nextPrefix)->second;
+}
+
+std::shared_ptr<const PartialAggregate> SlidingWindowAggregates::getSuffix(
+    Block& block,
+    const Timestamp start,
+    const std::vector<std::shared_ptr<AggregationSlice>>& sortedSlices,
+    const CombineFunction& combineFunction,
+    const PartialAggregate::CleanupFunction& cleanupFunction) const
+{
+    if (start < block.suffixStart)
+    {
+        /// The window contains all slices between its start and the already computed suffixes
+        auto suffix = block.suffixes.empty() ? nullptr : block.suffixes.begin()->second;
+        for (const auto& slice : sortedSlices | std::views::reverse)
+        {
+            if (slice->getSliceStart() >= start and slice->getSliceEnd() <= block.suffixStart)
+            {
+                suffix = combine(suffix, *slice, combineFunction, cleanupFunction);
+                block.suffixes.emplace(slice->getSliceStart(), suffix);
+            }
+        }
+        block.suffixStart = start;
+    }
+
+    /// The suffix from the start on is the suffix of the first slice that starts at or after the start
+    const auto suffix = block.suffixes.lower_bound(start);
+    return suffix == block.suffixes.end() ? nullptr : suffix->second;
+}
+
+std::shared_ptr<const PartialAggregate> SlidingWindowAggregates::combine(
+    const std::shared_ptr<const PartialAggregate>& partialAggregate,
+    const AggregationSlice& slice,
+    const CombineFunction& combineFunction,
+    const PartialAggregate::CleanupFunction& cleanupFunction) const
+{
+    std::vector<std::vector<HashMap*>> hashMapsPerPartition(numberOfPartitions);
+    bool sliceContainsKeys = false;
+    for (uint64_t partition = 0; partition < numberOfPartitions; ++partition)
+    {
+        if (partialAggregate != nullptr)
+        {
+            hashMapsPerPartition[partition].emplace_back(partialAggregate->getHashMapPtr(partition));
+        }
+        for (auto* hashMap : slice.getHashMapPtrsOfPartition(partition))
+        {
+            sliceContainsKeys |= containsKeys(hashMap);
+            hashMapsPerPartition[partition].emplace_back(hashMap);
+        }
+    }
+    if (not sliceContainsKeys)
+    {
+        return partialAggregate;
+    }
+
+    auto combinedAggregate = std::make_shared<PartialAggregate>(numberOfPartitions, cleanupFunction);
+    for (uint64_t partition = 0; partition < numberOfPartitions; ++partition)
+    {
+        for (auto* hashMap : hashMapsPerPartition[partition] | std::views::filter(containsKeys))
+        {
+            combineFunction(combinedAggregate->getHashMapPtrOrCreate(partition, *hashMap), hashMap);
+        }
+    }
+    return combinedAggregate;
+}
+
+}
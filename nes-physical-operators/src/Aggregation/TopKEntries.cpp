@@ -0,0 +1,77 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Aggregation/TopKEntries.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+TopKEntries::TopKEntries(const uint64_t limit) : limit(limit)
+{
+    PRECONDITION(limit > 0, "The limit of a top-k must be larger than zero");
+}
+
+bool TopKEntries::Candidate::isBetterThan(const Candidate& other) const
+{
+    if (isNull != other.isNull)
+    {
+        return other.isNull;
+    }
+    return sortKey > other.sortKey;
+}
+
+void TopKEntries::offer(AbstractHashMapEntry* entry, const uint64_t sortKey, const bool isNull)
+{
+    PRECONDITION(not sorted, "Cannot offer entries after sorting the top-k");
+    /// The heap comparator orders better candidates first, which makes the front of the heap its worst candidate
+    const auto isBetter = [](const Candidate& lhs, const Candidate& rhs) { return lhs.isBetterThan(rhs); };
+    const Candidate candidate{entry, sortKey, isNull};
+    if (heap.size() < limit)
+    {
+        heap.push_back(candidate);
+        std::ranges::push_heap(heap, isBetter);
+        return;
+    }
+    if (candidate.isBetterThan(heap.front()))
+    {
+        std::ranges::pop_heap(heap, isBetter);
+        heap.back() = candidate;
+        std::ranges::push_heap(heap, isBetter);
+    }
+}
+
+void TopKEntries::sort()
+{
+    std::ranges::sort(heap, [](const Candidate& lhs, const Candidate& rhs) { return lhs.isBetterThan(rhs); });
+    sorted = true;
+}
+
+uint64_t TopKEntries::size() const
+{
+    return heap.size();
+}
+
+AbstractHashMapEntry* TopKEntries::getEntry(const uint64_t pos) const
+{
+    PRECONDITION(sorted, "The top-k must be sorted before reading its entries");
+    PRECONDITION(pos < heap.size(), "Position {} exceeds the {} entries of the top-k", pos, heap.size());
+    return heap[pos].entry;
+}
+
+}
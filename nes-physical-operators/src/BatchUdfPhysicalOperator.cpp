@@ -0,0 +1,148 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <BatchUdfPhysicalOperator.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <Functions/BatchUdfPhysicalFunction.hpp>
+#include <Nautilus/DataTypes/DataTypesUtil.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Nautilus/Interface/RecordBuffer.hpp>
+#include <ErrorHandling.hpp>
+#include <ExecutionContext.hpp>
+#include <OperatorState.hpp>
+#include <PhysicalOperator.hpp>
+#include <val.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+/// The buffered records are stored row-wise, each field with its value followed by its null flag if the field is nullable
+class BatchUdfPhysicalOperator::BatchUdfState : public OperatorState
+{
+public:
+    BatchUdfState(const nautilus::val<int8_t*>& records, const nautilus::val<int8_t*>& batch) : records(records), batch(batch) { }
+
+    nautilus::val<int8_t*> records;
+    nautilus::val<int8_t*> batch;
+    nautilus::val<uint64_t> numberOfRecords = 0;
+};
+
+BatchUdfPhysicalOperator::BatchUdfPhysicalOperator(
+    BatchUdfPhysicalFunction function,
+    std::optional<Record::RecordFieldIdentifier> resultField,
+    std::vector<std::pair<Record::RecordFieldIdentifier, DataType>> bufferedFields)
+    : function(std::move(function)), resultField(std::move(resultField)), bufferedFields(std::move(bufferedFields))
+{
+    for (const auto& [fieldName, type] : this->bufferedFields)
+    {
+        PRECONDITION(not type.isType(DataType::Type::VARSIZED), "Cannot buffer the VARSIZED field {} for a batch UDF", fieldName);
+        recordSizeInBytes += type.getSizeInBytesWithNull();
+    }
+}
+
+void BatchUdfPhysicalOperator::open(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const
+{
+    openChild(executionCtx, recordBuffer);
+    const auto records = executionCtx.allocateMemory(nautilus::val<size_t>(BATCH_CAPACITY * recordSizeInBytes));
+    const auto batch = executionCtx.allocateMemory(nautilus::val<size_t>(function.getBatchSizeInBytes(BATCH_CAPACITY)));
+    executionCtx.setLocalOperatorState(id, std::make_unique<BatchUdfState>(records, batch));
+}
+
+void BatchUdfPhysicalOperator::execute(ExecutionContext& executionCtx, Record& record) const
+{
+    auto* const state = dynamic_cast<BatchUdfState*>(executionCtx.getLocalState(id));
+    nautilus::val<int8_t*> fieldRef = state->records + state->numberOfRecords * nautilus::val<uint64_t>(recordSizeInBytes);
+    for (const auto& [fieldName, type] : bufferedFields)
+    {
+        const auto value = record.read(fieldName);
+        value.writeToMemory(fieldRef);
+        if (type.nullable)
+        {
+            VarVal{value.isNull()}.writeToMemory(fieldRef + nautilus::val<uint64_t>(type.getSizeInBytesWithoutNull()));
+        }
+        fieldRef = fieldRef + nautilus::val<uint64_t>(type.getSizeInBytesWithNull());
+    }
+    function.writeArguments(record, executionCtx.pipelineMemoryProvider.arena, state->batch, state->numberOfRecords, BATCH_CAPACITY);
+    state->numberOfRecords = state->numberOfRecords + 1;
+    if (state->numberOfRecords == nautilus::val<uint64_t>(BATCH_CAPACITY))
+    {
+        flush(executionCtx, *state);
+    }
+}
+
+void BatchUdfPhysicalOperator::flush(ExecutionContext& executionCtx, BatchUdfState& state) const
+{
+    function.evaluate(state.batch, state.numberOfRecords, BATCH_CAPACITY);
+    for (nautilus::val<uint64_t> row = 0; row < state.numberOfRecords; row = row + 1)
+    {
+        Record record;
+        nautilus::val<int8_t*> fieldRef = state.records + row * nautilus::val<uint64_t>(recordSizeInBytes);
+        for (const auto& [fieldName, type] : bufferedFields)
+        {
+            if (type.nullable)
+            {
+                const auto null = readValueFromMemRef<bool>(fieldRef + nautilus::val<uint64_t>(type.getSizeInBytesWithoutNull()));
+                record.write(fieldName, VarVal::readVarValFromMemory(fieldRef, type, null));
+            }
+            else
+            {
+                record.write(fieldName, VarVal::readNonNullableVarValFromMemory(fieldRef, type));
+            }
+            fieldRef = fieldRef + nautilus::val<uint64_t>(type.getSizeInBytesWithNull());
+        }
+
+        const auto result = function.readResult(state.batch, row, BATCH_CAPACITY);
+        if (resultField.has_value())
+        {
+            record.write(*resultField, result);
+            executeChild(executionCtx, record);
+        }
+        else if (result)
+        {
+            executeChild(executionCtx, record);
+        }
+    }
+    state.numberOfRecords = 0;
+}
+
+void BatchUdfPhysicalOperator::close(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const
+{
+    auto* const state = dynamic_cast<BatchUdfState*>(executionCtx.getLocalState(id));
+    if (state->numberOfRecords > nautilus::val<uint64_t>(0))
+    {
+        flush(executionCtx, *state);
+    }
+    closeChild(executionCtx, recordBuffer);
+}
+
+std::optional<PhysicalOperator> BatchUdfPhysicalOperator::getChild() const
+{
+    return child;
+}
+
+void BatchUdfPhysicalOperator::setChild(PhysicalOperator child)
+{
+    this->child = std::move(child);
+}
+
+}
@@ -0,0 +1,136 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Deduplication/DeduplicationOperatorHandler.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+#include <Runtime/QueryTerminationType.hpp>
+#include <Sequencing/SequenceData.hpp>
+#include <Time/Timestamp.hpp>
+#include <ErrorHandling.hpp>
+#include <PipelineExecutionContext.hpp>
+
+namespace NES
+{
+
+DeduplicationOperatorHandler::DeduplicationOperatorHandler(
+    const std::vector<OriginId>& inputOrigins,
+    const uint64_t windowSizeInMs,
+    const uint64_t expectedNumberOfKeysPerWindow,
+    const uint64_t bloomFilterBitsPerKey)
+    : windowSizeInMs(windowSizeInMs)
+    , expectedNumberOfKeysPerShard((expectedNumberOfKeysPerWindow + NUMBER_OF_SHARDS - 1) / NUMBER_OF_SHARDS)
+    , bloomFilterBitsPerKey(bloomFilterBitsPerKey)
+    , watermarkProcessor(inputOrigins)
+{
+    PRECONDITION(windowSizeInMs > 0, "The window of a deduplication must be larger than zero");
+}
+
+void DeduplicationOperatorHandler::start(PipelineExecutionContext&, uint32_t)
+{
+}
+
+void DeduplicationOperatorHandler::stop(QueryTerminationType, PipelineExecutionContext&)
+{
+}
+
+bool DeduplicationOperatorHandler::KeyShard::insert(const uint64_t hash)
+{
+    if (bloomFilter.has_value())
+    {
+        if (bloomFilter->mayContain(hash))
+        {
+            return false;
+        }
+        bloomFilter->insert(hash);
+        return true;
+    }
+    return fingerprints.insert(hash);
+}
+
+std::unique_ptr<DeduplicationOperatorHandler::WindowKeys> DeduplicationOperatorHandler::createWindowKeys() const
+{
+    auto windowKeys = std::make_unique<WindowKeys>();
+    if (bloomFilterBitsPerKey > 0)
+    {
+        for (auto& shard : *windowKeys)
+        {
+            shard.wlock()->bloomFilter.emplace(expectedNumberOfKeysPerShard, bloomFilterBitsPerKey);
+        }
+    }
+    return windowKeys;
+}
+
+bool DeduplicationOperatorHandler::insert(WindowKeys& windowKeys, const uint64_t hash)
+{
+    return windowKeys[(hash >> FIRST_SHARD_BIT) & (NUMBER_OF_SHARDS - 1)].wlock()->insert(hash);
+}
+
+bool DeduplicationOperatorHandler::insertFirstOccurrence(const Timestamp timestamp, const uint64_t hash)
+{
+    const auto windowStart = Timestamp(timestamp.getRawValue() - (timestamp.getRawValue() % windowSizeInMs));
+    const auto windowEnd = windowStart + windowSizeInMs;
+    {
+        /// Holding the read lock prevents the window from being discarded while inserting into it
+        const auto lockedWindows = windows.rlock();
+        if (windowEnd <= lockedWindows->discardedUntil)
+        {
+            return false;
+        }
+        if (const auto window = lockedWindows->keysPerWindowStart.find(windowStart); window != lockedWindows->keysPerWindowStart.end())
+        {
+            return insert(*window->second, hash);
+        }
+    }
+
+    const auto lockedWindows = windows.wlock();
+    if (windowEnd <= lockedWindows->discardedUntil)
+    {
+        return false;
+    }
+    auto& windowKeys = lockedWindows->keysPerWindowStart[windowStart];
+    if (windowKeys == nullptr)
+    {
+        windowKeys = createWindowKeys();
+    }
+    return insert(*windowKeys, hash);
+}
+
+void DeduplicationOperatorHandler::updateWatermark(const Timestamp watermarkTs, const SequenceData sequenceData, const OriginId originId)
+{
+    const auto globalWatermark = watermarkProcessor.updateWatermark(watermarkTs, sequenceData, originId);
+    if (const auto lockedWindows = windows.rlock(); globalWatermark <= lockedWindows->discardedUntil)
+    {
+        return;
+    }
+
+    const auto lockedWindows = windows.wlock();
+    auto& keysPerWindowStart = lockedWindows->keysPerWindowStart;
+    while (not keysPerWindowStart.empty() and keysPerWindowStart.begin()->first + windowSizeInMs <= globalWatermark)
+    {
+        keysPerWindowStart.erase(keysPerWindowStart.begin());
+    }
+    lockedWindows->discardedUntil = std::max(lockedWindows->discardedUntil, globalWatermark);
+}
+
+uint64_t DeduplicationOperatorHandler::getNumberOfWindows() const
+{
+    return windows.rlock()->keysPerWindowStart.size();
+}
+
+}
@@ -0,0 +1,169 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Deduplication/DeduplicationPhysicalOperator.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+#include <Deduplication/DeduplicationOperatorHandler.hpp>
+#include <Functions/PhysicalFunction.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/Hash/HashFunction.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Nautilus/Interface/RecordBuffer.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
+#include <Sequencing/SequenceData.hpp>
+#include <Time/Timestamp.hpp>
+#include <Watermark/TimeFunction.hpp>
+#include <ErrorHandling.hpp>
+#include <ExecutionContext.hpp>
+#include <OperatorState.hpp>
+#include <PhysicalOperator.hpp>
+#include <function.hpp>
+#include <val.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+namespace
+{
+DeduplicationOperatorHandler* getDeduplicationOperatorHandler(OperatorHandler* ptrOpHandler)
+{
+    PRECONDITION(ptrOpHandler != nullptr, "opHandler context should not be null!");
+    auto* opHandler = dynamic_cast<DeduplicationOperatorHandler*>(ptrOpHandler);
+    INVARIANT(opHandler != nullptr, "The operator handler of a deduplication should be a DeduplicationOperatorHandler");
+    return opHandler;
+}
+
+bool insertFirstOccurrenceProxy(OperatorHandler* ptrOpHandler, const Timestamp timestamp, const uint64_t hash)
+{
+    return getDeduplicationOperatorHandler(ptrOpHandler)->insertFirstOccurrence(timestamp, hash);
+}
+
+void updateWatermarkProxy(
+    OperatorHandler* ptrOpHandler,
+    const Timestamp watermarkTs,
+    const SequenceNumber sequenceNumber,
+    const ChunkNumber chunkNumber,
+    const bool lastChunk,
+    const OriginId originId)
+{
+    getDeduplicationOperatorHandler(ptrOpHandler)
+        ->updateWatermark(watermarkTs, SequenceData(sequenceNumber, chunkNumber, lastChunk), originId);
+}
+
+/// Stores the operator handler for the records of the current buffer
+class DeduplicationLocalState : public OperatorState
+{
+public:
+    explicit DeduplicationLocalState(const nautilus::val<OperatorHandler*>& operatorHandler) : operatorHandler(operatorHandler) { }
+
+    nautilus::val<OperatorHandler*> operatorHandler;
+};
+
+/// The value of a null is undefined, thus all nulls of a key hash to the same value, i.e., they are equal like for DISTINCT in SQL
+constexpr uint64_t NULL_KEY_HASH = 0x9E3779B97F4A7C15ULL;
+}
+
+DeduplicationPhysicalOperator::DeduplicationPhysicalOperator(
+    const OperatorHandlerId operatorHandlerId,
+    std::unique_ptr<TimeFunction> timeFunction,
+    std::vector<PhysicalFunction> keyFunctions,
+    std::unique_ptr<HashFunction> hashFunction)
+    : operatorHandlerId(operatorHandlerId)
+    , timeFunction(std::move(timeFunction))
+    , keyFunctions(std::move(keyFunctions))
+    , hashFunction(std::move(hashFunction))
+{
+}
+
+DeduplicationPhysicalOperator::DeduplicationPhysicalOperator(const DeduplicationPhysicalOperator& other)
+    : PhysicalOperatorConcept(other.id)
+    , child(other.child)
+    , operatorHandlerId(other.operatorHandlerId)
+    , timeFunction(other.timeFunction->clone())
+    , keyFunctions(other.keyFunctions)
+    , hashFunction(other.hashFunction->clone())
+{
+}
+
+void DeduplicationPhysicalOperator::open(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const
+{
+    timeFunction->open(executionCtx, recordBuffer);
+    const auto operatorHandler = executionCtx.getGlobalOperatorHandler(operatorHandlerId);
+    executionCtx.setLocalOperatorState(id, std::make_unique<DeduplicationLocalState>(operatorHandler));
+    openChild(executionCtx, recordBuffer);
+}
+
+void DeduplicationPhysicalOperator::execute(ExecutionContext& ctx, Record& record) const
+{
+    std::vector<VarVal> keyValues;
+    for (const auto& keyFunction : keyFunctions)
+    {
+        const auto value = keyFunction.execute(record, ctx.pipelineMemoryProvider.arena);
+        if (value.isNullable())
+        {
+            nautilus::val<uint64_t> valueHash = NULL_KEY_HASH;
+            if (not value.isNull())
+            {
+                valueHash = hashFunction->calculate(value);
+            }
+            keyValues.emplace_back(valueHash);
+        }
+        else
+        {
+            keyValues.emplace_back(value);
+        }
+    }
+    const auto hash = hashFunction->calculate(keyValues);
+    const auto timestamp = timeFunction->getTs(ctx, record);
+
+    const auto operatorHandler = dynamic_cast<DeduplicationLocalState*>(ctx.getLocalState(id))->operatorHandler;
+    if (invoke(insertFirstOccurrenceProxy, operatorHandler, timestamp, hash))
+    {
+        executeChild(ctx, record);
+    }
+}
+
+void DeduplicationPhysicalOperator::close(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const
+{
+    timeFunction->close(executionCtx, recordBuffer);
+    closeChild(executionCtx, recordBuffer);
+    const auto operatorHandler = dynamic_cast<DeduplicationLocalState*>(executionCtx.getLocalState(id))->operatorHandler;
+    invoke(
+        updateWatermarkProxy,
+        operatorHandler,
+        executionCtx.watermarkTs,
+        executionCtx.sequenceNumber,
+        executionCtx.chunkNumber,
+        executionCtx.lastChunk,
+        executionCtx.originId);
+}
+
+std::optional<PhysicalOperator> DeduplicationPhysicalOperator::getChild() const
+{
+    return child;
+}
+
+void DeduplicationPhysicalOperator::setChild(PhysicalOperator child)
+{
+    this->child = std::move(child);
+}
+
+}
@@ -0,0 +1,94 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Deduplication/FingerprintSet.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace NES
+{
+
+FingerprintSet::FingerprintSet(const uint64_t initialCapacity)
+    : slots(std::bit_ceil(std::max<uint64_t>(initialCapacity, 2)), EMPTY_SLOT), mask(slots.size() - 1)
+{
+}
+
+bool FingerprintSet::insert(const uint64_t fingerprint)
+{
+    const auto storedFingerprint = toStoredFingerprint(fingerprint);
+    auto slot = findSlot(storedFingerprint);
+    if (slots[slot] == storedFingerprint)
+    {
+        return false;
+    }
+    if (2 * (numberOfFingerprints + 1) > slots.size())
+    {
+        grow();
+        slot = findSlot(storedFingerprint);
+    }
+    slots[slot] = storedFingerprint;
+    ++numberOfFingerprints;
+    return true;
+}
+
+bool FingerprintSet::contains(const uint64_t fingerprint) const
+{
+    const auto storedFingerprint = toStoredFingerprint(fingerprint);
+    return slots[findSlot(storedFingerprint)] == storedFingerprint;
+}
+
+uint64_t FingerprintSet::size() const
+{
+    return numberOfFingerprints;
+}
+
+uint64_t FingerprintSet::capacity() const
+{
+    return slots.size();
+}
+
+uint64_t FingerprintSet::toStoredFingerprint(const uint64_t fingerprint)
+{
+    return fingerprint == EMPTY_SLOT ? 1 : fingerprint;
+}
+
+uint64_t FingerprintSet::findSlot(const uint64_t storedFingerprint) const
+{
+    /// The load factor stays below 1, thus the probing always reaches an empty slot
+    auto slot = storedFingerprint & mask;
+    while (slots[slot] != EMPTY_SLOT and slots[slot] != storedFingerprint)
+    {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+void FingerprintSet::grow()
+{
+    auto oldSlots = std::exchange(slots, std::vector<uint64_t>(slots.size() * 2, EMPTY_SLOT));
+    mask = slots.size() - 1;
+    for (const auto storedFingerprint : oldSlots)
+    {
+        if (storedFingerprint != EMPTY_SLOT)
+        {
+            slots[findSlot(storedFingerprint)] = storedFingerprint;
+        }
+    }
+}
+
+}
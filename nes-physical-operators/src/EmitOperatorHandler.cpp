@@ -14,11 +14,26 @@
 
 #include <EmitOperatorHandler.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+#include <DataTypes/DataType.hpp>
 #include <Identifiers/Identifiers.hpp>
 #include <Identifiers/NESStrongType.hpp>
+#include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
 #include <Runtime/QueryTerminationType.hpp>
 #include <Runtime/TupleBuffer.hpp>
+#include <Runtime/VariableSizedAccess.hpp>
+#include <Sequencing/ChunkNumberTracker.hpp>
+#include <Sequencing/SequenceData.hpp>
+#include <SliceStore/Slice.hpp>
+#include <Time/Timestamp.hpp>
 #include <Util/Logger/Logger.hpp>
 #include <ErrorHandling.hpp>
 #include <PipelineExecutionContext.hpp>
@@ -26,59 +41,382 @@
 namespace NES
 {
 
-void EmitOperatorHandler::setChunkNumber(
-    bool isEndOfIncomingChunk, ChunkNumber incomingChunkNumber, bool isIncomingBufferTheLastChunk, TupleBuffer& buffer)
+namespace
+{
+/// A coalesced buffer replaces several sequence numbers of its origin, thus the handler numbers the buffers that it emits densely
+void assignNextSequenceNumber(TupleBuffer& buffer, SequenceNumber::Underlying& nextSequenceNumber)
 {
-    /// The SequenceState tracks how many chunks have been seen per Sequence/OriginId pair.
-    /// This allows to reason about completeness of a SequenceNumber and assign unique ChunkNumbers to every produced buffer aswell
-    /// as assigning exactly one LastChunk flag once we have seen all chunks.
+    buffer.setSequenceNumber(SequenceNumber(nextSequenceNumber++));
+    buffer.setChunkNumber(INITIAL<ChunkNumber>);
+    buffer.setLastChunk(true);
+}
+}
+
+std::optional<EmitCoalescing> EmitCoalescing::create(const TupleBufferRef& bufferRef, const std::chrono::microseconds latencyBound)
+{
+    EmitCoalescing coalescing{.regions = {}, .capacity = bufferRef.getCapacity(), .latencyBound = latencyBound};
+    bool storesRows = true;
+    for (const auto& fieldName : bufferRef.getAllFieldNames())
+    {
+        const auto location = bufferRef.getFieldLocation(fieldName);
+        if (not location.has_value())
+        {
+            return std::nullopt;
+        }
+        storesRows = storesRows and location->stride == bufferRef.getTupleSize();
+        coalescing.regions.push_back({.offset = location->offset, .recordSize = location->stride});
+    }
+    if (storesRows)
+    {
+        coalescing.regions = {{.offset = 0, .recordSize = bufferRef.getTupleSize()}};
+    }
+    return coalescing;
+}
+
+std::optional<VarSizedCompaction> VarSizedCompaction::create(const TupleBufferRef& bufferRef, const uint64_t minReferencedPercentage)
+{
+    VarSizedCompaction compaction{.fields = {}, .minReferencedPercentage = minReferencedPercentage};
+    for (const auto& fieldName : bufferRef.getAllFieldNames())
+    {
+        const auto location = bufferRef.getFieldLocation(fieldName);
+        if (not location.has_value())
+        {
+            return std::nullopt;
+        }
+        if (location->type.type == DataType::Type::VARSIZED)
+        {
+            compaction.fields.push_back(*location);
+        }
+    }
+    if (compaction.fields.empty())
+    {
+        return std::nullopt;
+    }
+    return compaction;
+}
 
-    SequenceNumberForOriginId seqNumberOriginId(buffer.getSequenceNumber(), buffer.getOriginId());
-    const auto lock = sequenceStates.wlock();
+EmitOperatorHandler::EmitOperatorHandler(const bool emitsInSequenceOrder) : emitsInSequenceOrder(emitsInSequenceOrder)
+{
+}
 
-    /// Assign a unique chunk number to the buffer and increment the internal counter
-    auto& [nextChunkNumberCounter, lastChunkNumber, seenChunks] = (*lock)[seqNumberOriginId];
+EmitOperatorHandler::~EmitOperatorHandler()
+{
+    auto* origin = originChunkNumbers.load();
+    while (origin != nullptr)
+    {
+        const std::unique_ptr<OriginChunkNumbers> owned(origin);
+        origin = origin->next.load();
+    }
+}
 
+EmitOperatorHandler::OriginChunkNumbers& EmitOperatorHandler::getOrigin(const OriginId originId)
+{
+    /// Threads append an unknown origin to the end of the list. Since all threads traverse the list in the same order, a thread that fails
+    /// to append its origin continues with the entry that another thread appended, which could be the same origin.
+    std::unique_ptr<OriginChunkNumbers> appended;
+    auto* link = &originChunkNumbers;
+    while (true)
+    {
+        auto* origin = link->load();
+        if (origin == nullptr)
+        {
+            if (appended == nullptr)
+            {
+                appended = std::make_unique<OriginChunkNumbers>(originId, emitsInSequenceOrder);
+            }
+            if (link->compare_exchange_strong(origin, appended.get()))
+            {
+                return *appended.release();
+            }
+        }
+        if (origin->originId == originId)
+        {
+            return *origin;
+        }
+        link = &origin->next;
+    }
+}
+
+void EmitOperatorHandler::setChunkNumber(
+    const bool isEndOfIncomingChunk, const ChunkNumber incomingChunkNumber, const bool isIncomingBufferTheLastChunk, TupleBuffer& buffer)
+{
 #ifndef NO_ASSERT
-    const auto completedSequencesLock = completedSequences.wlock();
+    /// We assume that every tuple of (SequenceNumber, ChunkNumber, OriginId) is unique per query (see completedSequences)
+    const SequenceNumberForOriginId seqNumberOriginId(buffer.getSequenceNumber(), buffer.getOriginId());
     INVARIANT(
-        !completedSequencesLock->contains(seqNumberOriginId),
+        !completedSequences.rlock()->contains(seqNumberOriginId),
         "Received chunk for sequence {} that was already completed",
         seqNumberOriginId);
 #endif
 
+    auto& chunkNumbers = getOrigin(buffer.getOriginId()).chunkNumbers;
+    const auto [chunkNumber, isLastChunk]
+        = chunkNumbers.assign(buffer.getSequenceNumber(), isEndOfIncomingChunk, incomingChunkNumber, isIncomingBufferTheLastChunk);
+    buffer.setChunkNumber(chunkNumber);
+    buffer.setLastChunk(isLastChunk);
 
-    const auto nextChunkNumber = ChunkNumber(nextChunkNumberCounter);
-    nextChunkNumberCounter += 1;
+#ifndef NO_ASSERT
+    if (isLastChunk)
+    {
+        completedSequences.wlock()->emplace(seqNumberOriginId);
+    }
+#endif
+}
+
+void EmitOperatorHandler::enableCoalescing(EmitCoalescing coalescing)
+{
+    PRECONDITION(originChunkNumbers.load() == nullptr, "Coalescing must be enabled before the handler receives its first buffer");
+    emitsInSequenceOrder = true;
+    this->coalescing = std::move(coalescing);
+}
 
-    buffer.setChunkNumber(nextChunkNumber);
-    buffer.setLastChunk(false);
+void EmitOperatorHandler::enableVarSizedCompaction(VarSizedCompaction compaction)
+{
+    PRECONDITION(originChunkNumbers.load() == nullptr, "Compaction must be enabled before the handler receives its first buffer");
+    varSizedCompaction = std::move(compaction);
+}
 
-    /// Check for completeness of the sequence number. This is only relevant if this buffer is actually completing an incoming chunk.
-    if (isEndOfIncomingChunk)
+void EmitOperatorHandler::compactVarSized(PipelineExecutionContext& pipelineExecutionContext, TupleBuffer& buffer) const
+{
+    const auto numberOfChildBuffers = buffer.getNumberOfChildBuffers();
+    if (not varSizedCompaction.has_value() or numberOfChildBuffers == 0)
+    {
+        return;
+    }
+
+    /// The accesses of the row layout are not aligned, thus they are read and written via memcpy. A nullable field stores its null byte
+    /// in front of the access.
+    std::vector<std::byte*> accessAddresses;
+    accessAddresses.reserve(buffer.getNumberOfTuples() * varSizedCompaction->fields.size());
+    for (uint64_t record = 0; record < buffer.getNumberOfTuples(); ++record)
     {
-        /// As soon as the incomingBufferLastChunk is received we know how many incoming chunks to expect.
-        if (isIncomingBufferTheLastChunk)
+        for (const auto& [type, offset, stride] : varSizedCompaction->fields)
         {
-            INVARIANT(
-                lastChunkNumber == INVALID<ChunkNumber>,
-                "Received multiple last chunks for {}. Previous last chunk was {}",
-                seqNumberOriginId,
-                lastChunkNumber);
-            lastChunkNumber = incomingChunkNumber;
+            accessAddresses.push_back(buffer.getAvailableMemoryArea().data() + offset + (record * stride) + (type.nullable ? 1 : 0));
         }
-        seenChunks++;
+    }
+    const auto loadAccess = [](const std::byte* address)
+    {
+        VariableSizedAccess access;
+        std::memcpy(&access, address, sizeof(VariableSizedAccess));
+        return access;
+    };
+
+    /// Inlined values do not reference a child buffer
+    std::erase_if(accessAddresses, [&](const std::byte* accessAddress) { return loadAccess(accessAddress).isInlined(); });
+    std::vector<uint64_t> referencedBytes(numberOfChildBuffers, 0);
+    for (const auto* accessAddress : accessAddresses)
+    {
+        const auto access = loadAccess(accessAddress);
+        referencedBytes[access.getIndex().getRawIndex()] += access.getSize().getRawSize();
+    }
 
-        /// We have processed the expected number of chunks and this buffer is closing the input tuple buffer, so we assign the last flag
-        /// and erase the sequenceState.
-        if (lastChunkNumber != INVALID<ChunkNumber> && seenChunks - 1 == lastChunkNumber.getRawValue() - ChunkNumber::INITIAL)
+    /// The used bytes of a child buffer include the values that the input buffer references, which it was shared with
+    std::vector<std::optional<TupleBuffer>> compactedChildBuffers(numberOfChildBuffers);
+    bool compactsAnyChildBuffer = false;
+    const auto bufferProvider = pipelineExecutionContext.getBufferManager();
+    for (uint32_t childIndex = 0; childIndex < numberOfChildBuffers; ++childIndex)
+    {
+        const auto usedBytes = buffer.loadChildBuffer(VariableSizedAccess::Index{childIndex}).getNumberOfTuples();
+        if (referencedBytes[childIndex] * 100 >= usedBytes * varSizedCompaction->minReferencedPercentage)
         {
-            lock->erase(seqNumberOriginId);
-#ifndef NO_ASSERT
-            completedSequencesLock->emplace(seqNumberOriginId);
-#endif
-            buffer.setLastChunk(true);
+            continue;
+        }
+        auto& compactedChildBuffer = compactedChildBuffers[childIndex];
+        if (referencedBytes[childIndex] < bufferProvider->getBufferSize())
+        {
+            compactedChildBuffer = bufferProvider->getBufferNoBlocking();
+        }
+        if (not compactedChildBuffer.has_value())
+        {
+            compactedChildBuffer = bufferProvider->getUnpooledBuffer(std::max<uint64_t>(referencedBytes[childIndex], 1));
         }
+        if (not compactedChildBuffer.has_value())
+        {
+            throw CannotAllocateBuffer("Cannot allocate buffer of size {} to compact variable sized data", referencedBytes[childIndex]);
+        }
+        compactedChildBuffer->setNumberOfTuples(0);
+        compactsAnyChildBuffer = true;
+    }
+    if (not compactsAnyChildBuffer)
+    {
+        return;
+    }
+
+    for (auto* accessAddress : accessAddresses)
+    {
+        const auto access = loadAccess(accessAddress);
+        auto& compactedChildBuffer = compactedChildBuffers[access.getIndex().getRawIndex()];
+        if (not compactedChildBuffer.has_value())
+        {
+            continue;
+        }
+        const VariableSizedAccess::Offset compactedOffset{compactedChildBuffer->getNumberOfTuples()};
+        const auto value = TupleBufferRef::loadAssociatedVarSizedValue(buffer, access);
+        std::ranges::copy(value, compactedChildBuffer->getAvailableMemoryArea().subspan(compactedOffset.getRawOffset()).begin());
+        compactedChildBuffer->setNumberOfTuples(compactedOffset.getRawOffset() + value.size());
+        const auto compactedAccess = access.relocate(access.getIndex(), compactedOffset);
+        std::memcpy(accessAddress, &compactedAccess, sizeof(VariableSizedAccess));
+    }
+    for (uint32_t childIndex = 0; childIndex < numberOfChildBuffers; ++childIndex)
+    {
+        if (auto& compactedChildBuffer = compactedChildBuffers[childIndex]; compactedChildBuffer.has_value())
+        {
+            buffer.replaceChildBuffer(VariableSizedAccess::Index{childIndex}, *compactedChildBuffer);
+        }
+    }
+}
+
+void EmitOperatorHandler::emitBuffer(PipelineExecutionContext& pipelineExecutionContext, const TupleBuffer& buffer, const bool endsInput)
+{
+    if (not emitsInSequenceOrder)
+    {
+        pipelineExecutionContext.emitBuffer(buffer, PipelineExecutionContext::ContinuationPolicy::POSSIBLE);
+        return;
+    }
+
+    /// The buffer must be pending before its sequence number can complete. Otherwise, the thread that emits the pending buffers could
+    /// skip it, before this thread inserts it.
+    auto& ordered = *getOrigin(buffer.getOriginId()).orderedEmission;
+    ordered.pendingBuffers.wlock()->emplace(
+        std::make_pair(buffer.getSequenceNumber().getRawValue(), buffer.getChunkNumber().getRawValue()), buffer);
+    ordered.completedSequenceNumbers.emplace(
+        SequenceData(buffer.getSequenceNumber(), buffer.getChunkNumber(), buffer.isLastChunk()), buffer.getSequenceNumber().getRawValue());
+    emitPendingBuffers(pipelineExecutionContext, ordered);
+
+    if (coalescing.has_value() and endsInput)
+    {
+        completeInput(pipelineExecutionContext);
+    }
+}
+
+void EmitOperatorHandler::emitPendingBuffers(PipelineExecutionContext& pipelineExecutionContext, OrderedEmission& ordered)
+{
+    /// A thread that fails to acquire the mutex relies on the emitting thread to see its request. The emitting thread only returns once it
+    /// handled all requests, or if another thread acquired the mutex after it (which then handles the remaining requests).
+    ordered.releaseRequests.fetch_add(1);
+    while (ordered.releaseRequests.load() > 0)
+    {
+        const std::unique_lock emitLock(ordered.emitMutex, std::try_to_lock);
+        if (not emitLock.owns_lock())
+        {
+            return;
+        }
+        ordered.releaseRequests.store(0);
+        /// A flush request precedes its release request, thus it is seen in the same or the next iteration
+        const bool flushRequested = ordered.flushRequested.exchange(false);
+
+        const auto completedSequenceNumber = ordered.completedSequenceNumbers.getCurrentValue();
+        std::vector<TupleBuffer> releasedBuffers;
+        {
+            const auto pendingBuffersLock = ordered.pendingBuffers.wlock();
+            const auto releasedEnd = pendingBuffersLock->lower_bound({completedSequenceNumber + 1, INVALID_CHUNK_NUMBER.getRawValue()});
+            for (auto pendingBuffer = pendingBuffersLock->begin(); pendingBuffer != releasedEnd; ++pendingBuffer)
+            {
+                releasedBuffers.emplace_back(std::move(pendingBuffer->second));
+            }
+            pendingBuffersLock->erase(pendingBuffersLock->begin(), releasedEnd);
+        }
+        /// Emits while still holding the mutex, so that the successor receives the buffers in order. If the successor is executed
+        /// immediately (ContinuationPolicy::POSSIBLE), it also processes the buffers in order.
+        for (auto& releasedBuffer : releasedBuffers)
+        {
+            if (coalescing.has_value())
+            {
+                coalesce(pipelineExecutionContext, ordered, std::move(releasedBuffer));
+            }
+            else
+            {
+                pipelineExecutionContext.emitBuffer(std::move(releasedBuffer), PipelineExecutionContext::ContinuationPolicy::POSSIBLE);
+            }
+        }
+        if (ordered.coalescedBuffer.has_value() and (flushRequested or not holdsBack(pipelineExecutionContext, ordered)))
+        {
+            emitCoalescedBuffer(pipelineExecutionContext, ordered);
+        }
+    }
+}
+
+void EmitOperatorHandler::coalesce(PipelineExecutionContext& pipelineExecutionContext, OrderedEmission& ordered, TupleBuffer buffer) const
+{
+    /// Child buffers would have to be re-indexed in the coalesced buffer, thus buffers with variable sized data are emitted as they are
+    const bool isSmall = buffer.getNumberOfTuples() < coalescing->capacity and buffer.getNumberOfChildBuffers() == 0;
+    if (ordered.coalescedBuffer.has_value()
+        and (not isSmall or ordered.coalescedBuffer->getNumberOfTuples() + buffer.getNumberOfTuples() > coalescing->capacity))
+    {
+        emitCoalescedBuffer(pipelineExecutionContext, ordered);
+    }
+    if (not isSmall)
+    {
+        assignNextSequenceNumber(buffer, ordered.nextSequenceNumber);
+        pipelineExecutionContext.emitBuffer(std::move(buffer), PipelineExecutionContext::ContinuationPolicy::POSSIBLE);
+        return;
+    }
+    if (not ordered.coalescedBuffer.has_value())
+    {
+        ordered.coalescedBuffer = std::move(buffer);
+        ordered.coalescedSince.store(std::chrono::steady_clock::now());
+        return;
+    }
+
+    auto& coalesced = *ordered.coalescedBuffer;
+    const auto numberOfCoalescedTuples = coalesced.getNumberOfTuples();
+    for (const auto& [offset, recordSize] : coalescing->regions)
+    {
+        std::memcpy(
+            coalesced.getAvailableMemoryArea().data() + offset + (numberOfCoalescedTuples * recordSize),
+            buffer.getAvailableMemoryArea().data() + offset,
+            buffer.getNumberOfTuples() * recordSize);
+    }
+    coalesced.setNumberOfTuples(numberOfCoalescedTuples + buffer.getNumberOfTuples());
+    /// The watermark of the heartbeat of an idle source only remains if all coalesced buffers are heartbeats
+    if (constexpr Timestamp idleSourceWatermark(Timestamp::IDLE_SOURCE_VALUE); coalesced.getWatermark() == idleSourceWatermark
+        or (buffer.getWatermark() != idleSourceWatermark and buffer.getWatermark() > coalesced.getWatermark()))
+    {
+        coalesced.setWatermark(buffer.getWatermark());
+    }
+    coalesced.setCreationTimestampInMS(std::max(coalesced.getCreationTimestampInMS(), buffer.getCreationTimestampInMS()));
+    IngestionTimestamps ingestionTimestamps{
+        .min = coalesced.getMinIngestionTimestampInNS(), .max = coalesced.getMaxIngestionTimestampInNS()};
+    ingestionTimestamps.merge({.min = buffer.getMinIngestionTimestampInNS(), .max = buffer.getMaxIngestionTimestampInNS()});
+    coalesced.setIngestionTimestampsInNS(ingestionTimestamps.min, ingestionTimestamps.max);
+}
+
+void EmitOperatorHandler::emitCoalescedBuffer(PipelineExecutionContext& pipelineExecutionContext, OrderedEmission& ordered) const
+{
+    auto coalesced = std::move(ordered.coalescedBuffer).value();
+    ordered.coalescedBuffer.reset();
+    ordered.coalescedSince.store({});
+    assignNextSequenceNumber(coalesced, ordered.nextSequenceNumber);
+    pipelineExecutionContext.emitBuffer(std::move(coalesced), PipelineExecutionContext::ContinuationPolicy::POSSIBLE);
+}
+
+bool EmitOperatorHandler::holdsBack(const PipelineExecutionContext& pipelineExecutionContext, const OrderedEmission& ordered) const
+{
+    /// Coalescing trades latency for fewer tasks, which only pays off if the successors cannot keep up with the tasks anyway
+    return ordered.coalescedBuffer->getNumberOfTuples() < coalescing->capacity
+        and std::chrono::steady_clock::now() - ordered.coalescedSince.load() < coalescing->latencyBound
+        and pipelineExecutionContext.getNumberOfQueuedTasks() >= pipelineExecutionContext.getNumberOfWorkerThreads();
+}
+
+void EmitOperatorHandler::completeInput(PipelineExecutionContext& pipelineExecutionContext)
+{
+    /// A task completes its input only after it emitted its buffers. Thus, the task that completes the last pending input sees the
+    /// coalesced buffers of all other tasks and flushes them, so that no buffer waits for an input that never arrives.
+    const auto numberOfCompletedInputs = completedInputs.fetch_add(1) + 1;
+    const bool isInputPending = numberOfCompletedInputs < pipelineExecutionContext.getNumberOfSubmittedTasks();
+    const auto now = std::chrono::steady_clock::now();
+    for (auto* origin = originChunkNumbers.load(); origin != nullptr; origin = origin->next.load())
+    {
+        auto& ordered = *origin->orderedEmission;
+        const auto coalescedSince = ordered.coalescedSince.load();
+        if (coalescedSince == std::chrono::steady_clock::time_point{}
+            or (isInputPending and now - coalescedSince < coalescing->latencyBound))
+        {
+            continue;
+        }
+        ordered.flushRequested.store(true);
+        emitPendingBuffers(pipelineExecutionContext, ordered);
     }
 }
 
@@ -86,8 +424,17 @@ void EmitOperatorHandler::start(PipelineExecutionContext&, uint32_t)
 {
 }
 
-void EmitOperatorHandler::stop(QueryTerminationType, PipelineExecutionContext&)
+void EmitOperatorHandler::stop(QueryTerminationType, PipelineExecutionContext& pipelineExecutionContext)
 {
+    if (not coalescing.has_value())
+    {
+        return;
+    }
+    for (auto* origin = originChunkNumbers.load(); origin != nullptr; origin = origin->next.load())
+    {
+        origin->orderedEmission->flushRequested.store(true);
+        emitPendingBuffers(pipelineExecutionContext, *origin->orderedEmission);
+    }
 }
 
 }
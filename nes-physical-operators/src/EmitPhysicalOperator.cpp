@@ -32,6 +32,7 @@
 #include <ExecutionContext.hpp>
 #include <OperatorState.hpp>
 #include <PhysicalOperator.hpp>
+#include <PipelineExecutionContext.hpp>
 #include <function.hpp>
 #include <val_ptr.hpp>
 
@@ -114,6 +115,29 @@ void setChunkNumber(
         isCurrentBufferTheLastChunk,
         newBuffer);
 }
+
+void emitBuffer(
+    const ExecutionContext& context,
+    OperatorHandlerId operatorHandlerId,
+    const nautilus::val<TupleBuffer*>& buffer,
+    const nautilus::val<bool>& endsInput)
+{
+    nautilus::invoke(
+        +[](OperatorHandler* handler, PipelineExecutionContext* pipelineExecutionContext, TupleBuffer* buffer, bool endsInput)
+        {
+            PRECONDITION(handler != nullptr, "Expects a valid handler");
+            PRECONDITION(pipelineExecutionContext != nullptr, "Expects a valid pipeline execution context");
+            PRECONDITION(buffer != nullptr, "Expects a valid buffer");
+
+            auto& emitHandler = dynamic_cast<EmitOperatorHandler&>(*handler);
+            emitHandler.compactVarSized(*pipelineExecutionContext, *buffer);
+            emitHandler.emitBuffer(*pipelineExecutionContext, *buffer, endsInput);
+        },
+        context.getGlobalOperatorHandler(operatorHandlerId),
+        context.pipelineContext,
+        buffer,
+        endsInput);
+}
 }
 
 void EmitPhysicalOperator::emitRecordBuffer(
@@ -127,10 +151,12 @@ void EmitPhysicalOperator::emitRecordBuffer(
     recordBuffer.setOriginId(ctx.originId);
     recordBuffer.setSequenceNumber(ctx.sequenceNumber);
     recordBuffer.setCreationTs(ctx.currentTs);
+    recordBuffer.setIngestionTs(ctx.minIngestionTs, ctx.maxIngestionTs);
 
     setChunkNumber(ctx, operatorHandlerId, potentialLastChunk, ctx.chunkNumber, ctx.lastChunk, recordBuffer.getReference());
 
-    ctx.emitBuffer(recordBuffer);
+    /// The handler emits the buffer, since it may have to hold it back to emit the buffers in sequence order
+    emitBuffer(ctx, operatorHandlerId, recordBuffer.getReference(), potentialLastChunk);
 }
 
 EmitPhysicalOperator::EmitPhysicalOperator(OperatorHandlerId operatorHandlerId, std::shared_ptr<TupleBufferRef> memoryProvider)
@@ -138,6 +164,21 @@ EmitPhysicalOperator::EmitPhysicalOperator(OperatorHandlerId operatorHandlerId,
 {
 }
 
+OperatorHandlerId EmitPhysicalOperator::getOperatorHandlerId() const
+{
+    return operatorHandlerId;
+}
+
+const TupleBufferRef& EmitPhysicalOperator::getBufferRef() const
+{
+    return *bufferRef;
+}
+
+void EmitPhysicalOperator::enableVarSizedSharing()
+{
+    bufferRef->enableVarSizedSharing();
+}
+
 [[nodiscard]] uint64_t EmitPhysicalOperator::getMaxRecordsPerBuffer() const
 {
     return bufferRef->getCapacity();
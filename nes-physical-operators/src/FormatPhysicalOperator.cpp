@@ -0,0 +1,359 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <FormatPhysicalOperator.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/DataTypes/VariableSizedData.hpp>
+#include <Nautilus/Interface/NESStrongTypeRef.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Nautilus/Interface/RecordBuffer.hpp>
+#include <Nautilus/Interface/TimestampRef.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sinks/SinkDescriptor.hpp>
+#include <SinksParsing/Format.hpp>
+#include <Time/Timestamp.hpp>
+#include <magic_enum/magic_enum.hpp>
+#include <nautilus/val.hpp>
+#include <EmitOperatorHandler.hpp>
+#include <ErrorHandling.hpp>
+#include <ExecutionContext.hpp>
+#include <OperatorState.hpp>
+#include <PhysicalOperator.hpp>
+#include <PipelineExecutionContext.hpp>
+#include <function.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+namespace
+{
+using FieldFormat = FormatPhysicalOperator::FieldFormat;
+using RowFormat = FormatPhysicalOperator::RowFormat;
+using FormattedRows = FormatPhysicalOperator::FormattedRows;
+
+/// A pipeline invocation formats its rows on a single worker thread. Since the successor of the operator is a sink, emitting a buffer
+/// does not re-enter the operator on the same thread, before the invocation closes.
+thread_local FormattedRows tlFormattedRows;
+
+class FormatState : public OperatorState
+{
+public:
+    explicit FormatState(const nautilus::val<FormattedRows*>& rows) : rows(rows) { }
+
+    nautilus::val<FormattedRows*> rows;
+};
+
+FormattedRows* beginRowsProxy()
+{
+    /// Keeps the capacity of the text, so that formatting does not allocate once it fits the rows of an invocation
+    tlFormattedRows.text.clear();
+    tlFormattedRows.endOfFittingRows = 0;
+    return &tlFormattedRows;
+}
+
+template <typename T>
+void appendValueProxy(FormattedRows* rows, const FieldFormat* field, const T value)
+{
+    rows->text.append(field->prefix);
+    Format::appendValue(rows->text, value);
+    rows->text.append(field->suffix);
+}
+
+void appendDecimalProxy(FormattedRows* rows, const FieldFormat* field, const int64_t unscaledValue)
+{
+    rows->text.append(field->prefix);
+    Format::appendDecimal(rows->text, unscaledValue, field->dataType.scale);
+    rows->text.append(field->suffix);
+}
+
+void appendVarSizedProxy(FormattedRows* rows, const FieldFormat* field, const int8_t* content, const uint64_t size)
+{
+    rows->text.append(field->prefix);
+    rows->text.append(reinterpret_cast<const char*>(content), size); ///NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    rows->text.append(field->suffix);
+}
+
+void appendNullProxy(FormattedRows* rows, const FieldFormat* field)
+{
+    rows->text.append(field->nullLiteral);
+}
+
+/// Returns true, if the row does not fit into a pooled buffer together with the previous rows
+bool finishRowProxy(FormattedRows* rows, const RowFormat* rowFormat, const uint64_t bufferSize)
+{
+    rows->text.append(rowFormat->rowDelimiter);
+    if (rows->text.size() <= bufferSize)
+    {
+        rows->endOfFittingRows = rows->text.size();
+        return false;
+    }
+    return true;
+}
+
+TupleBuffer allocateBuffer(PipelineExecutionContext& pipelineExecutionContext, const size_t sizeInBytes)
+{
+    const auto bufferProvider = pipelineExecutionContext.getBufferManager();
+    if (sizeInBytes <= bufferProvider->getBufferSize())
+    {
+        return pipelineExecutionContext.allocateTupleBuffer();
+    }
+    auto buffer = bufferProvider->getUnpooledBuffer(sizeInBytes);
+    if (not buffer.has_value())
+    {
+        throw CannotAllocateBuffer("{}B for a formatted row were requested", sizeInBytes);
+    }
+    return std::move(buffer.value());
+}
+
+void emitRowsProxy(
+    OperatorHandler* handler,
+    PipelineExecutionContext* pipelineExecutionContext,
+    FormattedRows* rows,
+    const uint64_t bufferSize,
+    const OriginId originId,
+    const SequenceNumber sequenceNumber,
+    const ChunkNumber chunkNumber,
+    const bool lastChunk,
+    const Timestamp watermarkTs,
+    const Timestamp creationTs,
+    const Timestamp minIngestionTs,
+    const Timestamp maxIngestionTs,
+    const bool closesChunk)
+{
+    PRECONDITION(handler != nullptr, "Expects a valid handler");
+    PRECONDITION(pipelineExecutionContext != nullptr, "Expects a valid pipeline execution context");
+    PRECONDITION(chunkNumber != INVALID<ChunkNumber>, "Expects a valid chunkNumber");
+
+    auto& emitHandler = dynamic_cast<EmitOperatorHandler&>(*handler);
+    const auto emit = [&](const std::string_view formattedRows, const bool closes)
+    {
+        auto buffer = allocateBuffer(*pipelineExecutionContext, formattedRows.size());
+        std::ranges::copy(formattedRows, buffer.getAvailableMemoryArea<char>().begin());
+        buffer.setNumberOfTuples(formattedRows.size());
+        buffer.setWatermark(watermarkTs);
+        buffer.setOriginId(originId);
+        buffer.setSequenceNumber(sequenceNumber);
+        buffer.setCreationTimestampInMS(creationTs);
+        buffer.setIngestionTimestampsInNS(minIngestionTs, maxIngestionTs);
+        emitHandler.setChunkNumber(closes, chunkNumber, lastChunk, buffer);
+        emitHandler.emitBuffer(*pipelineExecutionContext, buffer);
+    };
+
+    auto& text = rows->text;
+    if (closesChunk)
+    {
+        INVARIANT(text.size() <= bufferSize, "Expected the remaining rows to fit into a buffer, but they take {}B", text.size());
+        emit(text, true);
+        text.clear();
+        rows->endOfFittingRows = 0;
+        return;
+    }
+
+    /// The last row overflowed the buffer. We emit the rows before it and keep it for the next buffer, unless it does not fit either.
+    const std::string_view formattedRows{text};
+    if (rows->endOfFittingRows > 0)
+    {
+        emit(formattedRows.substr(0, rows->endOfFittingRows), false);
+    }
+    if (text.size() - rows->endOfFittingRows > bufferSize)
+    {
+        emit(formattedRows.substr(rows->endOfFittingRows), false);
+        text.clear();
+    }
+    else
+    {
+        text.erase(0, rows->endOfFittingRows);
+    }
+    rows->endOfFittingRows = text.size();
+}
+
+template <typename T>
+void appendValue(const nautilus::val<FormattedRows*>& rows, const FieldFormat& field, const VarVal& value)
+{
+    nautilus::invoke(
+        appendValueProxy<T>, rows, nautilus::val<const FieldFormat*>(&field), value.getRawValueAs<nautilus::val<T>>());
+}
+
+std::shared_ptr<const RowFormat> createRowFormat(const Schema& schema, const InputFormat format)
+{
+    PRECONDITION(schema.getNumberOfFields() != 0, "Formatter expected a non-empty schema");
+    /// Produces the same rows as the CSVFormat (without escaping strings) and JSONFormat of the sinks
+    const std::string rowStart = format == InputFormat::JSON ? "{" : "";
+    auto rowFormat = std::make_shared<RowFormat>();
+    rowFormat->rowDelimiter = format == InputFormat::JSON ? "}\n" : "\n";
+    for (const auto& field : schema.getFields())
+    {
+        const auto delimiter = rowFormat->fields.empty() ? rowStart : std::string{","};
+        const auto quote = format == InputFormat::JSON and field.dataType.type == DataType::Type::VARSIZED ? std::string{"\""} : "";
+        switch (format)
+        {
+            case InputFormat::CSV:
+                rowFormat->fields.emplace_back(field.name, field.dataType, delimiter, "", delimiter + "NULL");
+                break;
+            case InputFormat::JSON:
+                rowFormat->fields.emplace_back(
+                    field.name, field.dataType, delimiter + "\"" + field.name + "\":" + quote, quote, delimiter + "NULL");
+                break;
+            default:
+                throw UnknownSinkFormat("The compiled pipeline can not format rows in {}", magic_enum::enum_name(format));
+        }
+    }
+    return rowFormat;
+}
+}
+
+FormatPhysicalOperator::FormatPhysicalOperator(
+    const OperatorHandlerId operatorHandlerId, const Schema& schema, const InputFormat format, const uint64_t bufferSize)
+    : rowFormat(createRowFormat(schema, format)), bufferSize(bufferSize), operatorHandlerId(operatorHandlerId)
+{
+}
+
+void FormatPhysicalOperator::open(ExecutionContext& ctx, RecordBuffer&) const
+{
+    const nautilus::val<FormattedRows*> rows = nautilus::invoke(beginRowsProxy);
+    ctx.setLocalOperatorState(id, std::make_unique<FormatState>(rows));
+}
+
+void FormatPhysicalOperator::execute(ExecutionContext& ctx, Record& record) const
+{
+    const auto rows = dynamic_cast<FormatState*>(ctx.getLocalState(id))->rows;
+    /// Iterates over the fields while tracing, so that the compiled code only contains the appends of the data types of the schema
+    for (const auto& field : rowFormat->fields)
+    {
+        const auto& value = record.read(field.name);
+        if (not field.dataType.nullable)
+        {
+            appendField(rows, field, value);
+        }
+        else if (value.isNull())
+        {
+            nautilus::invoke(appendNullProxy, rows, nautilus::val<const FieldFormat*>(&field));
+        }
+        else
+        {
+            appendField(rows, field, value);
+        }
+    }
+
+    const nautilus::val<bool> rowOverflows = nautilus::invoke(
+        finishRowProxy, rows, nautilus::val<const RowFormat*>(rowFormat.get()), nautilus::val<uint64_t>(bufferSize));
+    if (rowOverflows)
+    {
+        emitRows(ctx, rows, false);
+    }
+}
+
+void FormatPhysicalOperator::close(ExecutionContext& ctx, RecordBuffer&) const
+{
+    /// Emits the remaining rows, even if there are none, so that the handler sees every chunk of the incoming sequence number
+    const auto rows = dynamic_cast<FormatState*>(ctx.getLocalState(id))->rows;
+    emitRows(ctx, rows, true);
+}
+
+void FormatPhysicalOperator::appendField(const nautilus::val<FormattedRows*>& rows, const FieldFormat& field, const VarVal& value) const
+{
+    switch (field.dataType.type)
+    {
+        case DataType::Type::INT8:
+            return appendValue<int8_t>(rows, field, value);
+        case DataType::Type::UINT8:
+            return appendValue<uint8_t>(rows, field, value);
+        case DataType::Type::INT16:
+            return appendValue<int16_t>(rows, field, value);
+        case DataType::Type::UINT16:
+            return appendValue<uint16_t>(rows, field, value);
+        case DataType::Type::INT32:
+            return appendValue<int32_t>(rows, field, value);
+        case DataType::Type::UINT32:
+            return appendValue<uint32_t>(rows, field, value);
+        case DataType::Type::INT64:
+        case DataType::Type::INTERVAL:
+            return appendValue<int64_t>(rows, field, value);
+        case DataType::Type::UINT64:
+        case DataType::Type::TIMESTAMP:
+            return appendValue<uint64_t>(rows, field, value);
+        case DataType::Type::DECIMAL:
+            nautilus::invoke(
+                appendDecimalProxy, rows, nautilus::val<const FieldFormat*>(&field), value.getRawValueAs<nautilus::val<int64_t>>());
+            return;
+        case DataType::Type::FLOAT32:
+            return appendValue<float>(rows, field, value);
+        case DataType::Type::FLOAT64:
+            return appendValue<double>(rows, field, value);
+        case DataType::Type::BOOLEAN:
+            return appendValue<bool>(rows, field, value);
+        case DataType::Type::CHAR:
+            return appendValue<char>(rows, field, value);
+        case DataType::Type::VARSIZED: {
+            const auto varSizedValue = value.getRawValueAs<VariableSizedData>();
+            nautilus::invoke(
+                appendVarSizedProxy,
+                rows,
+                nautilus::val<const FieldFormat*>(&field),
+                varSizedValue.getContent(),
+                varSizedValue.getSize());
+            return;
+        }
+        case DataType::Type::UNDEFINED:
+            throw UnknownDataType("Not supporting formatting {} data type.", magic_enum::enum_name(field.dataType.type));
+    }
+}
+
+void FormatPhysicalOperator::emitRows(
+    ExecutionContext& ctx, const nautilus::val<FormattedRows*>& rows, const nautilus::val<bool>& closesChunk) const
+{
+    nautilus::invoke(
+        emitRowsProxy,
+        ctx.getGlobalOperatorHandler(operatorHandlerId),
+        ctx.pipelineContext,
+        rows,
+        nautilus::val<uint64_t>(bufferSize),
+        ctx.originId,
+        ctx.sequenceNumber,
+        ctx.chunkNumber,
+        ctx.lastChunk,
+        ctx.watermarkTs,
+        ctx.currentTs,
+        ctx.minIngestionTs,
+        ctx.maxIngestionTs,
+        closesChunk);
+}
+
+std::optional<PhysicalOperator> FormatPhysicalOperator::getChild() const
+{
+    return child;
+}
+
+void FormatPhysicalOperator::setChild(PhysicalOperator child)
+{
+    this->child = std::move(child);
+}
+
+}
@@ -14,6 +14,8 @@
 #include <Functions/ArithmeticalFunctions/DivPhysicalFunction.hpp>
 
 #include <utility>
+#include <Functions/ArithmeticalFunctions/StrengthReduction.hpp>
+#include <Functions/PhysicalFunction.hpp>
 #include <Nautilus/DataTypes/VarVal.hpp>
 #include <Nautilus/Interface/Record.hpp>
 #include <ErrorHandling.hpp>
@@ -26,6 +28,10 @@ namespace NES
 VarVal DivPhysicalFunction::execute(const Record& record, ArenaRef& arena) const
 {
     const auto leftValue = leftPhysicalFunction.execute(record, arena);
+    if (shiftAmount.has_value())
+    {
+        return leftValue >> shiftAmount->execute(record, arena);
+    }
     const auto rightValue = rightPhysicalFunction.execute(record, arena);
     return leftValue / rightValue;
 }
@@ -35,11 +41,30 @@ DivPhysicalFunction::DivPhysicalFunction(PhysicalFunction leftPhysicalFunction,
 {
 }
 
+DivPhysicalFunction::DivPhysicalFunction(
+    PhysicalFunction leftPhysicalFunction, PhysicalFunction rightPhysicalFunction, PhysicalFunction shiftAmount)
+    : leftPhysicalFunction(std::move(leftPhysicalFunction))
+    , rightPhysicalFunction(std::move(rightPhysicalFunction))
+    , shiftAmount(std::move(shiftAmount))
+{
+}
+
 PhysicalFunctionRegistryReturnType
 PhysicalFunctionGeneratedRegistrar::RegisterDivPhysicalFunction(PhysicalFunctionRegistryArguments physicalFunctionRegistryArguments)
 {
     PRECONDITION(physicalFunctionRegistryArguments.childFunctions.size() == 2, "Div function must have exactly two child functions");
-    return DivPhysicalFunction(physicalFunctionRegistryArguments.childFunctions[0], physicalFunctionRegistryArguments.childFunctions[1]);
+    PRECONDITION(physicalFunctionRegistryArguments.inputTypes.size() == 2, "Div function must have exactly two input types");
+    const auto& dividend = physicalFunctionRegistryArguments.childFunctions[0];
+    const auto& divisor = physicalFunctionRegistryArguments.childFunctions[1];
+    if (auto multiplication = StrengthReduction::tryReplaceDivisionByMultiplication(dividend, divisor))
+    {
+        return *multiplication;
+    }
+    if (auto shiftAmount = StrengthReduction::tryGetShiftForDivisor(physicalFunctionRegistryArguments.inputTypes[0], divisor))
+    {
+        return DivPhysicalFunction(dividend, divisor, *shiftAmount);
+    }
+    return DivPhysicalFunction(dividend, divisor);
 }
 
 }
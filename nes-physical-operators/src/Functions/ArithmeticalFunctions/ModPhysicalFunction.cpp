@@ -15,6 +15,7 @@
 
 #include <utility>
 #include <vector>
+#include <Functions/ArithmeticalFunctions/StrengthReduction.hpp>
 #include <Functions/PhysicalFunction.hpp>
 #include <Nautilus/DataTypes/VarVal.hpp>
 #include <Nautilus/Interface/Record.hpp>
@@ -28,6 +29,10 @@ namespace NES
 VarVal ModPhysicalFunction::execute(const Record& record, ArenaRef& arena) const
 {
     const auto leftValue = leftPhysicalFunction.execute(record, arena);
+    if (mask.has_value())
+    {
+        return leftValue & mask->execute(record, arena);
+    }
     const auto rightValue = rightPhysicalFunction.execute(record, arena);
     return leftValue % rightValue;
 }
@@ -37,11 +42,26 @@ ModPhysicalFunction::ModPhysicalFunction(PhysicalFunction leftPhysicalFunction,
 {
 }
 
+ModPhysicalFunction::ModPhysicalFunction(
+    PhysicalFunction leftPhysicalFunction, PhysicalFunction rightPhysicalFunction, PhysicalFunction mask)
+    : leftPhysicalFunction(std::move(leftPhysicalFunction))
+    , rightPhysicalFunction(std::move(rightPhysicalFunction))
+    , mask(std::move(mask))
+{
+}
+
 PhysicalFunctionRegistryReturnType
 PhysicalFunctionGeneratedRegistrar::RegisterModPhysicalFunction(PhysicalFunctionRegistryArguments physicalFunctionRegistryArguments)
 {
     PRECONDITION(physicalFunctionRegistryArguments.childFunctions.size() == 2, "Mod function must have exactly two child functions");
-    return ModPhysicalFunction(physicalFunctionRegistryArguments.childFunctions[0], physicalFunctionRegistryArguments.childFunctions[1]);
+    PRECONDITION(physicalFunctionRegistryArguments.inputTypes.size() == 2, "Mod function must have exactly two input types");
+    const auto& dividend = physicalFunctionRegistryArguments.childFunctions[0];
+    const auto& divisor = physicalFunctionRegistryArguments.childFunctions[1];
+    if (auto mask = StrengthReduction::tryGetMaskForDivisor(physicalFunctionRegistryArguments.inputTypes[0], divisor))
+    {
+        return ModPhysicalFunction(dividend, divisor, *mask);
+    }
+    return ModPhysicalFunction(dividend, divisor);
 }
 
 }
@@ -14,8 +14,10 @@
 
 #include <Functions/ArithmeticalFunctions/PowPhysicalFunction.hpp>
 
+#include <cstdint>
 #include <utility>
 #include <DataTypes/DataType.hpp>
+#include <Functions/ArithmeticalFunctions/StrengthReduction.hpp>
 #include <Functions/PhysicalFunction.hpp>
 #include <Nautilus/DataTypes/VarVal.hpp>
 #include <Nautilus/Interface/Record.hpp>
@@ -34,9 +36,37 @@ PowPhysicalFunction::PowPhysicalFunction(PhysicalFunction leftPhysicalFunction,
 {
 }
 
+PowPhysicalFunction::PowPhysicalFunction(
+    PhysicalFunction leftPhysicalFunction, PhysicalFunction rightPhysicalFunction, DataType outputType, const int8_t exponent)
+    : leftPhysicalFunction(std::move(leftPhysicalFunction))
+    , rightPhysicalFunction(std::move(rightPhysicalFunction))
+    , outputType(std::move(outputType))
+    , integerExponent(exponent)
+{
+}
+
 VarVal PowPhysicalFunction::execute(const Record& record, ArenaRef& arena) const
 {
     const auto leftValue = leftPhysicalFunction.execute(record, arena);
+    if (integerExponent.has_value())
+    {
+        const auto base = leftValue.getRawValueAs<nautilus::val<double>>();
+        const auto result = [&]() -> nautilus::val<double>
+        {
+            switch (*integerExponent)
+            {
+                case -1:
+                    return nautilus::val<double>(1.0) / base;
+                case 0:
+                    return nautilus::val<double>(1.0);
+                case 1:
+                    return base;
+                default:
+                    return base * base;
+            }
+        }();
+        return VarVal{result}.castToType(outputType.type);
+    }
     const auto rightValue = rightPhysicalFunction.execute(record, arena);
     return VarVal{nautilus::pow(leftValue.getRawValueAs<nautilus::val<double>>(), rightValue.getRawValueAs<nautilus::val<double>>())}
         .castToType(outputType.type);
@@ -46,6 +76,16 @@ PhysicalFunctionRegistryReturnType
 PhysicalFunctionGeneratedRegistrar::RegisterPowPhysicalFunction(PhysicalFunctionRegistryArguments physicalFunctionRegistryArguments)
 {
     PRECONDITION(physicalFunctionRegistryArguments.childFunctions.size() == 2, "Pow function must have exactly two child functions");
+    /// Larger exponents would need more than one rounding step, e.g., x * x * x, and thus could deviate from pow
+    if (const auto exponent = StrengthReduction::tryGetConstantAsDouble(physicalFunctionRegistryArguments.childFunctions[1]);
+        exponent == -1.0 or exponent == 0.0 or exponent == 1.0 or exponent == 2.0)
+    {
+        return PowPhysicalFunction(
+            physicalFunctionRegistryArguments.childFunctions[0],
+            physicalFunctionRegistryArguments.childFunctions[1],
+            physicalFunctionRegistryArguments.outputType,
+            static_cast<int8_t>(*exponent));
+    }
     return PowPhysicalFunction(
         physicalFunctionRegistryArguments.childFunctions[0],
         physicalFunctionRegistryArguments.childFunctions[1],
@@ -14,8 +14,11 @@
 
 #include <Functions/ArithmeticalFunctions/SqrtPhysicalFunction.hpp>
 
+#include <cmath>
 #include <utility>
 #include <DataTypes/DataType.hpp>
+#include <Functions/ArithmeticalFunctions/StrengthReduction.hpp>
+#include <Functions/ConstantValuePhysicalFunction.hpp>
 #include <Functions/PhysicalFunction.hpp>
 #include <Nautilus/DataTypes/VarVal.hpp>
 #include <Nautilus/Interface/Record.hpp>
@@ -42,6 +45,12 @@ PhysicalFunctionRegistryReturnType
 PhysicalFunctionGeneratedRegistrar::RegisterSqrtPhysicalFunction(PhysicalFunctionRegistryArguments physicalFunctionRegistryArguments)
 {
     PRECONDITION(physicalFunctionRegistryArguments.childFunctions.size() == 1, "Sqrt function must have exactly one child function");
+    /// The square root of a constant is a constant
+    if (const auto value = StrengthReduction::tryGetConstantAsDouble(physicalFunctionRegistryArguments.childFunctions[0]);
+        value.has_value() and physicalFunctionRegistryArguments.outputType.isType(DataType::Type::FLOAT64))
+    {
+        return ConstantValuePhysicalFunction<double>(std::sqrt(*value));
+    }
     return SqrtPhysicalFunction(physicalFunctionRegistryArguments.childFunctions[0], physicalFunctionRegistryArguments.outputType);
 }
 
@@ -0,0 +1,123 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Functions/ArithmeticalFunctions/StrengthReduction.hpp>
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <DataTypes/DataType.hpp>
+#include <Functions/ArithmeticalFunctions/MulPhysicalFunction.hpp>
+#include <Functions/ConstantValuePhysicalFunction.hpp>
+#include <Functions/PhysicalFunction.hpp>
+
+namespace NES::StrengthReduction
+{
+
+namespace
+{
+template <typename T>
+std::optional<T> tryGetConstant(const PhysicalFunction& function)
+{
+    if (const auto constant = function.tryGetAs<ConstantValuePhysicalFunction<T>>())
+    {
+        return constant->get().getValue();
+    }
+    return std::nullopt;
+}
+
+template <typename... T>
+std::optional<double> tryGetAnyConstantAsDouble(const PhysicalFunction& function)
+{
+    std::optional<double> value;
+    ((value = value ? value : tryGetConstant<T>(function).transform([](const T constant) { return static_cast<double>(constant); })), ...);
+    return value;
+}
+
+template <typename T>
+bool isPowerOfTwo(const T value)
+{
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        int exponent = 0;
+        return std::isfinite(value) and std::abs(std::frexp(value, &exponent)) == 0.5 and std::isnormal(T{1} / value);
+    }
+    else
+    {
+        return std::has_single_bit(value);
+    }
+}
+
+template <typename T>
+std::optional<PhysicalFunction> tryGetReciprocal(const PhysicalFunction& divisor)
+{
+    return tryGetConstant<T>(divisor)
+        .and_then([](const T value) { return isPowerOfTwo(value) ? std::optional{value} : std::nullopt; })
+        .transform([](const T value) { return PhysicalFunction(ConstantValuePhysicalFunction<T>(T{1} / value)); });
+}
+
+/// Calls the function with the constant divisor, if it is a power of two of the dividend's unsigned type
+template <typename Function>
+std::optional<PhysicalFunction>
+tryReducePowerOfTwoDivisor(const DataType& dividendType, const PhysicalFunction& divisor, const Function& reduce)
+{
+    const auto reduceWith = [&]<typename T>(std::optional<T> value) -> std::optional<PhysicalFunction>
+    {
+        if (not value.has_value() or not isPowerOfTwo(*value))
+        {
+            return std::nullopt;
+        }
+        return PhysicalFunction(ConstantValuePhysicalFunction<T>(reduce(*value)));
+    };
+    if (dividendType.isType(DataType::Type::UINT32))
+    {
+        return reduceWith(tryGetConstant<uint32_t>(divisor));
+    }
+    if (dividendType.isType(DataType::Type::UINT64))
+    {
+        return reduceWith(tryGetConstant<uint64_t>(divisor));
+    }
+    return std::nullopt;
+}
+}
+
+std::optional<double> tryGetConstantAsDouble(const PhysicalFunction& function)
+{
+    return tryGetAnyConstantAsDouble<int8_t, int16_t, int32_t, int64_t, uint8_t, uint16_t, uint32_t, uint64_t, float, double>(function);
+}
+
+std::optional<PhysicalFunction> tryReplaceDivisionByMultiplication(const PhysicalFunction& dividend, const PhysicalFunction& divisor)
+{
+    auto reciprocal = tryGetReciprocal<double>(divisor);
+    if (not reciprocal.has_value())
+    {
+        reciprocal = tryGetReciprocal<float>(divisor);
+    }
+    return reciprocal.transform([&](const PhysicalFunction& factor) { return PhysicalFunction(MulPhysicalFunction(dividend, factor)); });
+}
+
+std::optional<PhysicalFunction> tryGetShiftForDivisor(const DataType& dividendType, const PhysicalFunction& divisor)
+{
+    return tryReducePowerOfTwoDivisor(
+        dividendType, divisor, []<typename T>(const T value) { return static_cast<T>(std::countr_zero(value)); });
+}
+
+std::optional<PhysicalFunction> tryGetMaskForDivisor(const DataType& dividendType, const PhysicalFunction& divisor)
+{
+    return tryReducePowerOfTwoDivisor(dividendType, divisor, []<typename T>(const T value) { return static_cast<T>(value - 1); });
+}
+
+}
@@ -0,0 +1,355 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Functions/BatchKernels.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <DataTypes/DataType.hpp>
+#include <Functions/SimdBatchKernels.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <magic_enum/magic_enum.hpp>
+#include <ErrorHandling.hpp>
+#include <function.hpp>
+#include <val.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+namespace
+{
+/// The kernels are plain C++ loops without any control flow in the loop body. Thus, the host compiler can auto-vectorize them.
+/// We load values via memcpy, as fields are not guaranteed to be aligned to the size of their data type.
+template <typename T, typename C, BatchComparison Comparison, bool IsFirstFilter>
+void comparisonKernel(
+    int8_t* fieldAddress, const uint64_t stride, const uint64_t begin, const uint64_t size, int8_t* mask, const C constant)
+{
+    const auto evaluate = [&](const uint64_t valueStride)
+    {
+        const int8_t* values = fieldAddress + (begin * valueStride);
+        for (uint64_t i = 0; i < size; ++i)
+        {
+            T value;
+            std::memcpy(&value, values + (i * valueStride), sizeof(T));
+            const auto qualifies = static_cast<int8_t>(evaluateComparison<Comparison>(static_cast<C>(value), constant));
+            if constexpr (IsFirstFilter)
+            {
+                mask[i] = qualifies;
+            }
+            else
+            {
+                mask[i] = static_cast<int8_t>(mask[i] & qualifies);
+            }
+        }
+    };
+    /// Columns store their values contiguously. With a constant stride, the compiler uses plain vector loads for the inlined loop.
+    if (stride == sizeof(T))
+    {
+        evaluate(sizeof(T));
+    }
+    else
+    {
+        evaluate(stride);
+    }
+}
+
+uint64_t compactSelectionKernel(int8_t* mask, const uint64_t begin, const uint64_t size, int8_t* selectionVector)
+{
+    /// Branch-free compaction: we always write the index, but only advance the output position for qualifying records
+    uint64_t numberOfSelected = 0;
+    for (uint64_t i = 0; i < size; ++i)
+    {
+        const uint64_t recordIndex = begin + i;
+        std::memcpy(selectionVector + (numberOfSelected * sizeof(uint64_t)), &recordIndex, sizeof(uint64_t));
+        numberOfSelected += static_cast<uint64_t>(mask[i] != 0);
+    }
+    return numberOfSelected;
+}
+
+/// Returns true, if converting the constant to T and back yields the constant again
+template <typename T, typename C>
+bool isExactlyRepresentable(const C constant)
+{
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        if (std::isinf(constant))
+        {
+            return true;
+        }
+        /// Also rejects NaN, as all comparisons with NaN are false
+        if (not(constant >= std::numeric_limits<T>::lowest() and constant <= std::numeric_limits<T>::max()))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        if (not std::in_range<T>(constant))
+        {
+            return false;
+        }
+    }
+    return static_cast<C>(static_cast<T>(constant)) == constant;
+}
+
+template <typename T, typename C, BatchComparison Comparison>
+void invokeComparisonKernel(
+    const nautilus::val<int8_t*>& fieldAddress,
+    const uint64_t stride,
+    const nautilus::val<uint64_t>& begin,
+    const nautilus::val<uint64_t>& size,
+    const nautilus::val<int8_t*>& mask,
+    const C constant,
+    const bool isFirstFilter)
+{
+    /// The kernel is chosen while tracing, thus the traced code contains a single call to the matching kernel.
+    /// The SIMD kernels compare in the domain of T, which is only equivalent if the constant is exactly representable as T.
+    BatchComparisonKernel<C> kernel = nullptr;
+    if (stride == sizeof(T) and isExactlyRepresentable<T>(constant))
+    {
+        kernel = getSimdComparisonKernel<T, C>(Comparison, isFirstFilter);
+    }
+    if (kernel == nullptr)
+    {
+        kernel = isFirstFilter ? &comparisonKernel<T, C, Comparison, true> : &comparisonKernel<T, C, Comparison, false>;
+    }
+    nautilus::invoke(kernel, fieldAddress, nautilus::val<uint64_t>(stride), begin, size, mask, nautilus::val<C>(constant));
+}
+
+template <typename T, typename C>
+void evaluateTyped(
+    const BatchFilter& filter,
+    const nautilus::val<int8_t*>& fieldAddress,
+    const uint64_t stride,
+    const nautilus::val<uint64_t>& begin,
+    const nautilus::val<uint64_t>& size,
+    const nautilus::val<int8_t*>& mask,
+    const bool isFirstFilter)
+{
+    INVARIANT(std::holds_alternative<C>(filter.constant), "The constant of the batch filter on {} has an unexpected type", filter.field);
+    const auto constant = std::get<C>(filter.constant);
+    switch (filter.comparison)
+    {
+        case BatchComparison::EQUALS:
+            invokeComparisonKernel<T, C, BatchComparison::EQUALS>(fieldAddress, stride, begin, size, mask, constant, isFirstFilter);
+            return;
+        case BatchComparison::LESS:
+            invokeComparisonKernel<T, C, BatchComparison::LESS>(fieldAddress, stride, begin, size, mask, constant, isFirstFilter);
+            return;
+        case BatchComparison::LESS_EQUALS:
+            invokeComparisonKernel<T, C, BatchComparison::LESS_EQUALS>(fieldAddress, stride, begin, size, mask, constant, isFirstFilter);
+            return;
+        case BatchComparison::GREATER:
+            invokeComparisonKernel<T, C, BatchComparison::GREATER>(fieldAddress, stride, begin, size, mask, constant, isFirstFilter);
+            return;
+        case BatchComparison::GREATER_EQUALS:
+            invokeComparisonKernel<T, C, BatchComparison::GREATER_EQUALS>(fieldAddress, stride, begin, size, mask, constant, isFirstFilter);
+            return;
+    }
+    std::unreachable();
+}
+
+template <typename T, typename C, BatchComparison Comparison>
+void invokeKeyComparisonKernel(
+    const nautilus::val<int8_t*>& values,
+    const nautilus::val<uint64_t>& size,
+    const nautilus::val<int8_t*>& mask,
+    const nautilus::val<C>& key)
+{
+    /// The key has the type of the values, thus, it is always exactly representable as T
+    BatchComparisonKernel<C> kernel = getSimdComparisonKernel<T, C>(Comparison, true);
+    if (kernel == nullptr)
+    {
+        kernel = &comparisonKernel<T, C, Comparison, true>;
+    }
+    nautilus::invoke(kernel, values, nautilus::val<uint64_t>(sizeof(T)), nautilus::val<uint64_t>(0), size, mask, key);
+}
+
+template <typename T, typename C>
+void evaluateKeyComparisonTyped(
+    const BatchComparison comparison,
+    const nautilus::val<int8_t*>& values,
+    const nautilus::val<uint64_t>& size,
+    const nautilus::val<int8_t*>& mask,
+    const VarVal& key,
+    const DataType::Type widenedType)
+{
+    const auto widenedKey = key.castToType(widenedType).getRawValueAs<nautilus::val<C>>();
+    switch (comparison)
+    {
+        case BatchComparison::EQUALS:
+            invokeKeyComparisonKernel<T, C, BatchComparison::EQUALS>(values, size, mask, widenedKey);
+            return;
+        case BatchComparison::LESS:
+            invokeKeyComparisonKernel<T, C, BatchComparison::LESS>(values, size, mask, widenedKey);
+            return;
+        case BatchComparison::LESS_EQUALS:
+            invokeKeyComparisonKernel<T, C, BatchComparison::LESS_EQUALS>(values, size, mask, widenedKey);
+            return;
+        case BatchComparison::GREATER:
+            invokeKeyComparisonKernel<T, C, BatchComparison::GREATER>(values, size, mask, widenedKey);
+            return;
+        case BatchComparison::GREATER_EQUALS:
+            invokeKeyComparisonKernel<T, C, BatchComparison::GREATER_EQUALS>(values, size, mask, widenedKey);
+            return;
+    }
+    std::unreachable();
+}
+}
+
+BatchComparison mirrorBatchComparison(const BatchComparison comparison)
+{
+    switch (comparison)
+    {
+        case BatchComparison::EQUALS:
+            return BatchComparison::EQUALS;
+        case BatchComparison::LESS:
+            return BatchComparison::GREATER;
+        case BatchComparison::LESS_EQUALS:
+            return BatchComparison::GREATER_EQUALS;
+        case BatchComparison::GREATER:
+            return BatchComparison::LESS;
+        case BatchComparison::GREATER_EQUALS:
+            return BatchComparison::LESS_EQUALS;
+    }
+    std::unreachable();
+}
+
+void evaluateKeyComparison(
+    const DataType::Type fieldType,
+    const BatchComparison comparison,
+    const nautilus::val<int8_t*>& values,
+    const nautilus::val<uint64_t>& size,
+    const nautilus::val<int8_t*>& mask,
+    const VarVal& key)
+{
+    switch (fieldType)
+    {
+        case DataType::Type::INT8:
+            return evaluateKeyComparisonTyped<int8_t, int64_t>(comparison, values, size, mask, key, DataType::Type::INT64);
+        case DataType::Type::INT16:
+            return evaluateKeyComparisonTyped<int16_t, int64_t>(comparison, values, size, mask, key, DataType::Type::INT64);
+        case DataType::Type::INT32:
+            return evaluateKeyComparisonTyped<int32_t, int64_t>(comparison, values, size, mask, key, DataType::Type::INT64);
+        case DataType::Type::INT64:
+            return evaluateKeyComparisonTyped<int64_t, int64_t>(comparison, values, size, mask, key, DataType::Type::INT64);
+        case DataType::Type::UINT8:
+            return evaluateKeyComparisonTyped<uint8_t, uint64_t>(comparison, values, size, mask, key, DataType::Type::UINT64);
+        case DataType::Type::UINT16:
+            return evaluateKeyComparisonTyped<uint16_t, uint64_t>(comparison, values, size, mask, key, DataType::Type::UINT64);
+        case DataType::Type::UINT32:
+            return evaluateKeyComparisonTyped<uint32_t, uint64_t>(comparison, values, size, mask, key, DataType::Type::UINT64);
+        case DataType::Type::UINT64:
+            return evaluateKeyComparisonTyped<uint64_t, uint64_t>(comparison, values, size, mask, key, DataType::Type::UINT64);
+        case DataType::Type::FLOAT32:
+            return evaluateKeyComparisonTyped<float, double>(comparison, values, size, mask, key, DataType::Type::FLOAT64);
+        case DataType::Type::FLOAT64:
+            return evaluateKeyComparisonTyped<double, double>(comparison, values, size, mask, key, DataType::Type::FLOAT64);
+        case DataType::Type::BOOLEAN:
+        case DataType::Type::CHAR:
+        case DataType::Type::VARSIZED:
+        case DataType::Type::UNDEFINED:
+        case DataType::Type::TIMESTAMP:
+        case DataType::Type::INTERVAL:
+        case DataType::Type::DECIMAL:
+            INVARIANT(false, "There is no batch kernel for a field of type {}", magic_enum::enum_name(fieldType));
+    }
+    std::unreachable();
+}
+
+void BatchFilter::evaluate(
+    const nautilus::val<int8_t*>& fieldAddress,
+    const uint64_t stride,
+    const nautilus::val<uint64_t>& begin,
+    const nautilus::val<uint64_t>& size,
+    const nautilus::val<int8_t*>& mask,
+    const bool isFirstFilter) const
+{
+    switch (fieldType)
+    {
+        case DataType::Type::INT8:
+            return evaluateTyped<int8_t, int64_t>(*this, fieldAddress, stride, begin, size, mask, isFirstFilter);
+        case DataType::Type::INT16:
+            return evaluateTyped<int16_t, int64_t>(*this, fieldAddress, stride, begin, size, mask, isFirstFilter);
+        case DataType::Type::INT32:
+            return evaluateTyped<int32_t, int64_t>(*this, fieldAddress, stride, begin, size, mask, isFirstFilter);
+        case DataType::Type::INT64:
+            return evaluateTyped<int64_t, int64_t>(*this, fieldAddress, stride, begin, size, mask, isFirstFilter);
+        case DataType::Type::UINT8:
+            return evaluateTyped<uint8_t, uint64_t>(*this, fieldAddress, stride, begin, size, mask, isFirstFilter);
+        case DataType::Type::UINT16:
+            return evaluateTyped<uint16_t, uint64_t>(*this, fieldAddress, stride, begin, size, mask, isFirstFilter);
+        case DataType::Type::UINT32:
+            return evaluateTyped<uint32_t, uint64_t>(*this, fieldAddress, stride, begin, size, mask, isFirstFilter);
+        case DataType::Type::UINT64:
+            return evaluateTyped<uint64_t, uint64_t>(*this, fieldAddress, stride, begin, size, mask, isFirstFilter);
+        case DataType::Type::FLOAT32:
+            return evaluateTyped<float, double>(*this, fieldAddress, stride, begin, size, mask, isFirstFilter);
+        case DataType::Type::FLOAT64:
+            return evaluateTyped<double, double>(*this, fieldAddress, stride, begin, size, mask, isFirstFilter);
+        case DataType::Type::BOOLEAN:
+        case DataType::Type::CHAR:
+        case DataType::Type::VARSIZED:
+        case DataType::Type::UNDEFINED:
+        case DataType::Type::TIMESTAMP:
+        case DataType::Type::INTERVAL:
+        case DataType::Type::DECIMAL:
+            INVARIANT(false, "There is no batch kernel for a field of type {}", magic_enum::enum_name(fieldType));
+    }
+    std::unreachable();
+}
+
+bool BatchFilter::supportsType(const DataType::Type type)
+{
+    switch (type)
+    {
+        case DataType::Type::INT8:
+        case DataType::Type::INT16:
+        case DataType::Type::INT32:
+        case DataType::Type::INT64:
+        case DataType::Type::UINT8:
+        case DataType::Type::UINT16:
+        case DataType::Type::UINT32:
+        case DataType::Type::UINT64:
+        case DataType::Type::FLOAT32:
+        case DataType::Type::FLOAT64:
+            return true;
+        case DataType::Type::BOOLEAN:
+        case DataType::Type::CHAR:
+        case DataType::Type::VARSIZED:
+        case DataType::Type::UNDEFINED:
+        case DataType::Type::TIMESTAMP:
+        case DataType::Type::INTERVAL:
+        case DataType::Type::DECIMAL:
+            return false;
+    }
+    std::unreachable();
+}
+
+nautilus::val<uint64_t> compactSelection(
+    const nautilus::val<int8_t*>& mask,
+    const nautilus::val<uint64_t>& begin,
+    const nautilus::val<uint64_t>& size,
+    const nautilus::val<int8_t*>& selectionVector)
+{
+    return nautilus::invoke(compactSelectionKernel, mask, begin, size, selectionVector);
+}
+
+}
@@ -0,0 +1,187 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Functions/BatchUdfPhysicalFunction.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ranges>
+#include <utility>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <Functions/BatchUdf.hpp>
+#include <Functions/PhysicalFunction.hpp>
+#include <Nautilus/DataTypes/DataTypesUtil.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <nautilus/function.hpp>
+#include <Arena.hpp>
+#include <ErrorHandling.hpp>
+#include <ExecutionContext.hpp>
+#include <val.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+namespace
+{
+constexpr size_t alignToWord(const size_t sizeInBytes)
+{
+    return (sizeInBytes + sizeof(uint64_t) - 1) / sizeof(uint64_t) * sizeof(uint64_t);
+}
+
+void evaluateBatchProxy(const ScalarUdfBatchLayout* layout, int8_t* batch, const uint64_t numberOfRows, const uint64_t capacity)
+{
+    INVARIANT(layout != nullptr, "ScalarUdfBatchLayout MUST NOT be null at this point");
+    layout->evaluate(reinterpret_cast<std::byte*>(batch), numberOfRows, capacity);
+}
+}
+
+size_t ScalarUdfBatchLayout::getValueSize(const size_t column) const
+{
+    const auto& type = column < argumentTypes.size() ? argumentTypes[column] : resultType;
+    return type.getSizeInBytesWithoutNull();
+}
+
+size_t ScalarUdfBatchLayout::getColumnOffset(const size_t column, const size_t capacity) const
+{
+    size_t offset = 0;
+    for (size_t precedingColumn = 0; precedingColumn < column; ++precedingColumn)
+    {
+        offset += alignToWord(capacity * getValueSize(precedingColumn)) + alignToWord(capacity);
+    }
+    return offset;
+}
+
+size_t ScalarUdfBatchLayout::getNullsOffset(const size_t column, const size_t capacity) const
+{
+    return getColumnOffset(column, capacity) + alignToWord(capacity * getValueSize(column));
+}
+
+size_t ScalarUdfBatchLayout::getBatchSizeInBytes(const size_t capacity) const
+{
+    return getColumnOffset(argumentTypes.size() + 1, capacity);
+}
+
+void ScalarUdfBatchLayout::evaluate(std::byte* batch, const uint64_t numberOfRows, const uint64_t capacity) const
+{
+    const auto toColumn = [&](const size_t column, const DataType& type)
+    {
+        auto* const nulls = type.nullable ? reinterpret_cast<bool*>(batch + getNullsOffset(column, capacity)) : nullptr;
+        return UdfColumn{.type = type.type, .values = batch + getColumnOffset(column, capacity), .nulls = nulls, .size = numberOfRows};
+    };
+
+    std::vector<UdfColumn> arguments;
+    arguments.reserve(argumentTypes.size());
+    for (size_t argument = 0; argument < argumentTypes.size(); ++argument)
+    {
+        arguments.emplace_back(toColumn(argument, argumentTypes[argument]));
+    }
+    const auto result = toColumn(argumentTypes.size(), resultType);
+    if (result.nulls != nullptr)
+    {
+        std::fill_n(result.nulls, numberOfRows, false);
+        for (const auto& argument : arguments | std::views::filter([](const auto& column) { return column.nulls != nullptr; }))
+        {
+            std::transform(argument.nulls, argument.nulls + numberOfRows, result.nulls, result.nulls, std::logical_or{});
+        }
+    }
+    udf(arguments, result);
+}
+
+BatchUdfPhysicalFunction::BatchUdfPhysicalFunction(
+    const ScalarBatchUdf udf, std::vector<PhysicalFunction> argumentFunctions, std::vector<DataType> argumentTypes, DataType resultType)
+    : argumentFunctions(std::move(argumentFunctions))
+    , layout(std::make_shared<const ScalarUdfBatchLayout>(udf, std::move(argumentTypes), std::move(resultType)))
+{
+    PRECONDITION(udf != nullptr, "A batch UDF requires a function");
+    PRECONDITION(
+        this->argumentFunctions.size() == layout->argumentTypes.size(),
+        "Expected {} argument types, but got {}",
+        this->argumentFunctions.size(),
+        layout->argumentTypes.size());
+    if (std::ranges::any_of(layout->argumentTypes, [](const DataType& type) { return type.isType(DataType::Type::VARSIZED); })
+        or layout->resultType.isType(DataType::Type::VARSIZED))
+    {
+        throw NotImplemented("Batch UDFs do not support VARSIZED arguments or results");
+    }
+}
+
+VarVal BatchUdfPhysicalFunction::execute(const Record& record, ArenaRef& arena) const
+{
+    const auto batch = arena.allocateMemory(nautilus::val<size_t>(getBatchSizeInBytes(1)));
+    writeArguments(record, arena, batch, nautilus::val<uint64_t>(0), 1);
+    evaluate(batch, nautilus::val<uint64_t>(1), 1);
+    return readResult(batch, nautilus::val<uint64_t>(0), 1);
+}
+
+size_t BatchUdfPhysicalFunction::getBatchSizeInBytes(const size_t capacity) const
+{
+    return layout->getBatchSizeInBytes(capacity);
+}
+
+void BatchUdfPhysicalFunction::writeArguments(
+    const Record& record,
+    ArenaRef& arena,
+    const nautilus::val<int8_t*>& batch,
+    const nautilus::val<uint64_t>& row,
+    const size_t capacity) const
+{
+    for (size_t argument = 0; argument < argumentFunctions.size(); ++argument)
+    {
+        const auto value = argumentFunctions[argument].execute(record, arena);
+        const auto& type = layout->argumentTypes[argument];
+        const auto offset = layout->getColumnOffset(argument, capacity);
+        const auto valueSize = layout->getValueSize(argument);
+        const nautilus::val<int8_t*> valueRef = batch + nautilus::val<uint64_t>(offset) + row * nautilus::val<uint64_t>(valueSize);
+        value.castToType(type.type).writeToMemory(valueRef);
+        if (type.nullable)
+        {
+            const nautilus::val<int8_t*> nullRef = batch + nautilus::val<uint64_t>(layout->getNullsOffset(argument, capacity)) + row;
+            VarVal{value.isNull()}.writeToMemory(nullRef);
+        }
+    }
+}
+
+void BatchUdfPhysicalFunction::evaluate(
+    const nautilus::val<int8_t*>& batch, const nautilus::val<uint64_t>& numberOfRows, const size_t capacity) const
+{
+    nautilus::invoke(
+        evaluateBatchProxy,
+        nautilus::val<const ScalarUdfBatchLayout*>(layout.get()),
+        batch,
+        numberOfRows,
+        nautilus::val<uint64_t>(capacity));
+}
+
+VarVal
+BatchUdfPhysicalFunction::readResult(const nautilus::val<int8_t*>& batch, const nautilus::val<uint64_t>& row, const size_t capacity) const
+{
+    const auto column = layout->argumentTypes.size();
+    const auto offset = layout->getColumnOffset(column, capacity);
+    const auto valueSize = layout->getValueSize(column);
+    const nautilus::val<int8_t*> valueRef = batch + nautilus::val<uint64_t>(offset) + row * nautilus::val<uint64_t>(valueSize);
+    if (not layout->resultType.nullable)
+    {
+        return VarVal::readNonNullableVarValFromMemory(valueRef, layout->resultType);
+    }
+    const nautilus::val<int8_t*> nullRef = batch + nautilus::val<uint64_t>(layout->getNullsOffset(column, capacity)) + row;
+    return VarVal::readVarValFromMemory(valueRef, layout->resultType, readValueFromMemRef<bool>(nullRef));
+}
+
+}
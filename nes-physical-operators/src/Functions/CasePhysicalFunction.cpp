@@ -0,0 +1,135 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Functions/CasePhysicalFunction.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <Functions/PhysicalFunction.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/DataTypes/VariableSizedData.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Arena.hpp>
+#include <ErrorHandling.hpp>
+#include <ExecutionContext.hpp>
+#include <val.hpp>
+#include <val_bool.hpp>
+
+namespace NES
+{
+
+namespace
+{
+/// A null condition counts as false
+nautilus::val<bool> holds(const VarVal& condition)
+{
+    return condition.getRawValueAs<nautilus::val<bool>>() and not condition.isNull();
+}
+
+/// All branches return the same underlying type and nullability, so that their values can be selected or assigned to each other
+VarVal toOutputType(const VarVal& value, const DataType& outputType)
+{
+    const auto null = value.isNull();
+    return value.castToType(outputType.type)
+        .customVisit([&](const auto& underlying) { return VarVal{underlying, outputType.nullable, null}; });
+}
+
+/// The result if no branch matches and there is no ELSE value
+VarVal createNullValue(const DataType& outputType)
+{
+    const nautilus::val<bool> null = true;
+    if (outputType.isType(DataType::Type::VARSIZED))
+    {
+        return VarVal{VariableSizedData{nautilus::val<int8_t*>(nullptr), nautilus::val<uint64_t>(0)}, outputType.nullable, null};
+    }
+    if (outputType.isType(DataType::Type::BOOLEAN))
+    {
+        return VarVal{nautilus::val<bool>(false), outputType.nullable, null};
+    }
+    return toOutputType(VarVal{nautilus::val<uint64_t>(0), outputType.nullable, null}, outputType);
+}
+}
+
+CasePhysicalFunction::CasePhysicalFunction(
+    std::vector<PhysicalFunction> conditions,
+    std::vector<PhysicalFunction> values,
+    std::optional<PhysicalFunction> elseValue,
+    DataType outputType,
+    const bool branchFree)
+    : conditions(std::move(conditions))
+    , values(std::move(values))
+    , elseValue(std::move(elseValue))
+    , outputType(std::move(outputType))
+    , branchFree(branchFree)
+{
+    PRECONDITION(not this->conditions.empty(), "A CASE requires at least one branch");
+    PRECONDITION(
+        this->conditions.size() == this->values.size(),
+        "A CASE requires a value per condition, but got {} conditions and {} values",
+        this->conditions.size(),
+        this->values.size());
+}
+
+VarVal CasePhysicalFunction::execute(const Record& record, ArenaRef& arena) const
+{
+    /// Assigning variable sized data in traced branches would require the same prefix in all branches, thus we always select them
+    if (branchFree or outputType.isType(DataType::Type::VARSIZED))
+    {
+        return executeBranchFree(record, arena);
+    }
+    return executeBranched(record, arena);
+}
+
+VarVal CasePhysicalFunction::executeBranchFree(const Record& record, ArenaRef& arena) const
+{
+    /// Folding from the last branch to the first one gives precedence to the first branch that matches
+    auto result = elseValue.has_value() ? toOutputType(elseValue->execute(record, arena), outputType) : createNullValue(outputType);
+    for (size_t branch = conditions.size(); branch-- > 0;)
+    {
+        const auto condition = holds(conditions[branch].execute(record, arena));
+        result = VarVal::select(condition, toOutputType(values[branch].execute(record, arena), outputType), result);
+    }
+    return result;
+}
+
+VarVal CasePhysicalFunction::executeBranched(const Record& record, ArenaRef& arena) const
+{
+    auto result = createNullValue(outputType);
+    nautilus::val<bool> matched = false;
+    for (size_t branch = 0; branch < conditions.size(); ++branch)
+    {
+        if (not matched)
+        {
+            if (holds(conditions[branch].execute(record, arena)))
+            {
+                result = toOutputType(values[branch].execute(record, arena), outputType);
+                matched = true;
+            }
+        }
+    }
+    if (elseValue.has_value())
+    {
+        if (not matched)
+        {
+            result = toOutputType(elseValue->execute(record, arena), outputType);
+        }
+    }
+    return result;
+}
+
+}
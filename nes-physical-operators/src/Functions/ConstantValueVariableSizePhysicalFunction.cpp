@@ -21,6 +21,7 @@
 #include <Nautilus/DataTypes/VarVal.hpp>
 #include <Nautilus/DataTypes/VariableSizedData.hpp>
 #include <Nautilus/Interface/Record.hpp>
+#include <nautilus/val.hpp>
 #include <ExecutionContext.hpp>
 
 namespace NES
@@ -36,7 +37,9 @@ ConstantValueVariableSizePhysicalFunction::ConstantValueVariableSizePhysicalFunc
 VarVal ConstantValueVariableSizePhysicalFunction::execute(const Record&, ArenaRef&) const
 {
     /// NOLINTBEGIN(cppcoreguidelines-pro-type-const-cast) - VariableSizedData requires non-const pointer but data is not modified
-    VariableSizedData result(const_cast<int8_t*>(data.data()), data.size());
+    /// The prefix of the constant is known during tracing, thus comparisons with it can reject most values without comparing the content
+    const nautilus::val<uint32_t> prefix{VariableSizedData::computePrefix(data.data(), data.size())};
+    VariableSizedData result(const_cast<int8_t*>(data.data()), data.size(), prefix);
     /// NOLINTEND(cppcoreguidelines-pro-type-const-cast) - VariableSizedData requires non-const pointer but data is not modified
     return result;
 }
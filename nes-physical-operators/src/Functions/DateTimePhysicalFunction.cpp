@@ -0,0 +1,122 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Functions/DateTimePhysicalFunction.hpp>
+
+#include <cstdint>
+#include <utility>
+#include <Functions/DateTimeArithmetic.hpp>
+#include <Functions/DateTimeLogicalFunction.hpp>
+#include <Functions/PhysicalFunction.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <magic_enum/magic_enum.hpp>
+#include <Arena.hpp>
+#include <ErrorHandling.hpp>
+#include <ExecutionContext.hpp>
+#include <val.hpp>
+
+namespace NES
+{
+
+using namespace DateTimeArithmetic;
+
+DateTimePhysicalFunction::DateTimePhysicalFunction(
+    const DateTimeFunctionKind kind, const DateTimeUnit unit, const int64_t utcOffsetInMs, PhysicalFunction valuePhysicalFunction)
+    : kind(kind), unit(unit), utcOffsetInMs(utcOffsetInMs), valuePhysicalFunction(std::move(valuePhysicalFunction))
+{
+    PRECONDITION(
+        DateTimeLogicalFunction::supportsUnit(kind, unit),
+        "{} does not support the unit {}",
+        magic_enum::enum_name(kind),
+        magic_enum::enum_name(unit));
+}
+
+VarVal DateTimePhysicalFunction::execute(const Record& record, ArenaRef& arena) const
+{
+    const auto value = valuePhysicalFunction.execute(record, arena);
+    /// The unsigned addition of a negative offset wraps around, which subtracts it from the biased timestamp
+    const auto localBias = BIAS_IN_MS + static_cast<uint64_t>(utcOffsetInMs);
+    const auto biasedLocalMs = value.getRawValueAs<nautilus::val<uint64_t>>() + nautilus::val<uint64_t>(localBias);
+    if (kind == DateTimeFunctionKind::DATE_TRUNC)
+    {
+        return {truncate(biasedLocalMs) - nautilus::val<uint64_t>(localBias), value.isNullable(), value.isNull()};
+    }
+    return {extract(biasedLocalMs), value.isNullable(), value.isNull()};
+}
+
+nautilus::val<uint64_t> DateTimePhysicalFunction::truncate(const nautilus::val<uint64_t>& biasedLocalMs) const
+{
+    const auto biasedDays = biasedLocalMs / nautilus::val<uint64_t>(MS_PER_DAY);
+    switch (unit)
+    {
+        case DateTimeUnit::MILLISECOND:
+            return biasedLocalMs;
+        case DateTimeUnit::SECOND:
+            return truncateToMultiple(biasedLocalMs, MS_PER_SECOND);
+        case DateTimeUnit::MINUTE:
+            return truncateToMultiple(biasedLocalMs, MS_PER_MINUTE);
+        case DateTimeUnit::HOUR:
+            return truncateToMultiple(biasedLocalMs, MS_PER_HOUR);
+        case DateTimeUnit::DAY:
+            return truncateToMultiple(biasedLocalMs, MS_PER_DAY);
+        case DateTimeUnit::WEEK:
+            return (biasedDays - daysSinceMonday(biasedDays)) * nautilus::val<uint64_t>(MS_PER_DAY);
+        case DateTimeUnit::MONTH: {
+            const auto date = civilFromDays(biasedDays);
+            return (biasedDays - date.day + nautilus::val<uint64_t>(1)) * nautilus::val<uint64_t>(MS_PER_DAY);
+        }
+        case DateTimeUnit::YEAR: {
+            const auto date = civilFromDays(biasedDays);
+            return daysOfFirstOfJanuary(date.year) * nautilus::val<uint64_t>(MS_PER_DAY);
+        }
+        case DateTimeUnit::DAY_OF_WEEK:
+        case DateTimeUnit::DAY_OF_YEAR:
+            break;
+    }
+    INVARIANT(false, "DATE_TRUNC does not support the unit {}", magic_enum::enum_name(unit));
+    std::unreachable();
+}
+
+nautilus::val<uint64_t> DateTimePhysicalFunction::extract(const nautilus::val<uint64_t>& biasedLocalMs) const
+{
+    const auto biasedDays = biasedLocalMs / nautilus::val<uint64_t>(MS_PER_DAY);
+    switch (unit)
+    {
+        case DateTimeUnit::MILLISECOND:
+            return biasedLocalMs % nautilus::val<uint64_t>(MS_PER_SECOND);
+        case DateTimeUnit::SECOND:
+            return (biasedLocalMs / nautilus::val<uint64_t>(MS_PER_SECOND)) % nautilus::val<uint64_t>(60);
+        case DateTimeUnit::MINUTE:
+            return (biasedLocalMs / nautilus::val<uint64_t>(MS_PER_MINUTE)) % nautilus::val<uint64_t>(60);
+        case DateTimeUnit::HOUR:
+            return (biasedLocalMs / nautilus::val<uint64_t>(MS_PER_HOUR)) % nautilus::val<uint64_t>(24);
+        case DateTimeUnit::DAY:
+            return civilFromDays(biasedDays).day;
+        case DateTimeUnit::MONTH:
+            return civilFromDays(biasedDays).month;
+        case DateTimeUnit::YEAR:
+            return civilFromDays(biasedDays).year;
+        case DateTimeUnit::DAY_OF_WEEK:
+            return dayOfWeek(biasedDays);
+        case DateTimeUnit::DAY_OF_YEAR:
+            return biasedDays - daysOfFirstOfJanuary(civilFromDays(biasedDays).year) + nautilus::val<uint64_t>(1);
+        case DateTimeUnit::WEEK:
+            break;
+    }
+    INVARIANT(false, "EXTRACT does not support the unit {}", magic_enum::enum_name(unit));
+    std::unreachable();
+}
+
+}
@@ -0,0 +1,129 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Functions/DecimalArithmetic.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <DataTypes/Decimal.hpp>
+#include <ErrorHandling.hpp>
+
+namespace NES::DecimalArithmetic
+{
+
+namespace
+{
+using WideInteger = __int128;
+
+/// Products of two decimals have up to twice the maximal scale
+constexpr uint8_t MAX_WIDE_EXPONENT = 2 * Decimal::MAX_PRECISION;
+
+WideInteger widePowerOfTen(const uint8_t exponent)
+{
+    INVARIANT(exponent <= MAX_WIDE_EXPONENT, "10^{} does not fit into 128 bit", exponent);
+    if (exponent <= Decimal::MAX_PRECISION)
+    {
+        return Decimal::powerOfTen(exponent);
+    }
+    const auto remainingExponent = static_cast<uint8_t>(exponent - Decimal::MAX_PRECISION);
+    return static_cast<WideInteger>(Decimal::powerOfTen(Decimal::MAX_PRECISION)) * Decimal::powerOfTen(remainingExponent);
+}
+
+int64_t narrow(const WideInteger value)
+{
+    if (value > std::numeric_limits<int64_t>::max() or value < std::numeric_limits<int64_t>::min())
+    {
+        throw ArithmeticalError("Decimal overflow: the result does not fit into 64 bit");
+    }
+    return static_cast<int64_t>(value);
+}
+
+/// Rounds the truncated quotient half away from zero. The remainder has the sign of the dividend.
+WideInteger roundQuotient(const WideInteger quotient, const WideInteger remainder, const WideInteger divisor, const bool isNegative)
+{
+    const auto absoluteRemainder = remainder < 0 ? -remainder : remainder;
+    const auto absoluteDivisor = divisor < 0 ? -divisor : divisor;
+    if (2 * absoluteRemainder < absoluteDivisor)
+    {
+        return quotient;
+    }
+    return isNegative ? quotient - 1 : quotient + 1;
+}
+
+WideInteger divideRounded(const WideInteger dividend, const WideInteger divisor)
+{
+    return roundQuotient(dividend / divisor, dividend % divisor, divisor, (dividend < 0) != (divisor < 0));
+}
+}
+
+int64_t rescale(const int64_t value, const uint8_t fromScale, const uint8_t toScale)
+{
+    if (toScale >= fromScale)
+    {
+        return narrow(static_cast<WideInteger>(value) * Decimal::powerOfTen(static_cast<uint8_t>(toScale - fromScale)));
+    }
+    return narrow(divideRounded(value, Decimal::powerOfTen(static_cast<uint8_t>(fromScale - toScale))));
+}
+
+int64_t multiply(const int64_t a, const int64_t b, const uint8_t shift)
+{
+    return narrow(divideRounded(static_cast<WideInteger>(a) * b, widePowerOfTen(shift)));
+}
+
+int64_t divide(const int64_t a, const int64_t b, const uint8_t shift)
+{
+    if (b == 0)
+    {
+        throw ArithmeticalError("Can not divide by zero!");
+    }
+    const bool isNegative = (a < 0) != (b < 0);
+    /// The dividend fits into 128 bit for shifts up to the maximal precision. Larger shifts continue with a long division by single digits.
+    const auto firstShift = std::min(shift, Decimal::MAX_PRECISION);
+    const auto dividend = static_cast<WideInteger>(a) * Decimal::powerOfTen(firstShift);
+    auto quotient = dividend / b;
+    auto remainder = dividend % b;
+    for (auto digit = firstShift; digit < shift; ++digit)
+    {
+        remainder *= 10;
+        quotient = (quotient * 10) + (remainder / b);
+        remainder %= b;
+        narrow(quotient);
+    }
+    return narrow(roundQuotient(quotient, remainder, b, isNegative));
+}
+
+int64_t fromUnsigned(const uint64_t value, const uint8_t scale)
+{
+    return narrow(static_cast<WideInteger>(value) * Decimal::powerOfTen(scale));
+}
+
+int64_t fromDouble(const double value, const uint8_t scale)
+{
+    const auto scaled = std::round(value * static_cast<double>(Decimal::powerOfTen(scale)));
+    /// -2^63 is the smallest and 2^63 the first double outside of the int64 range
+    if (not(scaled >= -0x1p63 and scaled < 0x1p63))
+    {
+        throw ArithmeticalError("Can not convert {} into a decimal with scale {}", value, scale);
+    }
+    return static_cast<int64_t>(scaled);
+}
+
+double toDouble(const int64_t value, const uint8_t scale)
+{
+    return static_cast<double>(value) / static_cast<double>(Decimal::powerOfTen(scale));
+}
+
+}
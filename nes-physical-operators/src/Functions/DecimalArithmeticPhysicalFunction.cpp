@@ -0,0 +1,95 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Functions/DecimalArithmeticPhysicalFunction.hpp>
+
+#include <cstdint>
+#include <utility>
+#include <Functions/DecimalArithmetic.hpp>
+#include <Functions/PhysicalFunction.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Arena.hpp>
+#include <ErrorHandling.hpp>
+#include <ExecutionContext.hpp>
+#include <function.hpp>
+#include <select.hpp>
+#include <val.hpp>
+
+namespace NES
+{
+
+DecimalArithmeticPhysicalFunction::DecimalArithmeticPhysicalFunction(
+    const DecimalOperation operation, PhysicalFunction leftPhysicalFunction, PhysicalFunction rightPhysicalFunction, const uint8_t shift)
+    : operation(operation)
+    , leftPhysicalFunction(std::move(leftPhysicalFunction))
+    , rightPhysicalFunction(std::move(rightPhysicalFunction))
+    , shift(shift)
+{
+    PRECONDITION(
+        shift == 0 or operation == DecimalOperation::MUL or operation == DecimalOperation::DIV,
+        "Only multiplications and divisions shift the scale of their result");
+}
+
+VarVal DecimalArithmeticPhysicalFunction::execute(const Record& record, ArenaRef& arena) const
+{
+    return evaluate(operation, leftPhysicalFunction.execute(record, arena), rightPhysicalFunction.execute(record, arena), shift);
+}
+
+VarVal DecimalArithmeticPhysicalFunction::evaluate(
+    const DecimalOperation operation, const VarVal& leftValue, const VarVal& rightValue, const uint8_t shift)
+{
+    const auto nullable = leftValue.isNullable() or rightValue.isNullable();
+    const auto isNull = leftValue.isNull() or rightValue.isNull();
+
+    auto left = leftValue.getRawValueAs<nautilus::val<int64_t>>();
+    auto right = rightValue.getRawValueAs<nautilus::val<int64_t>>();
+    if (nullable)
+    {
+        /// Null values may hold arbitrary values, thus we compute on a zero (and divide by one) to not raise an error
+        left = nautilus::select(isNull, nautilus::val<int64_t>(0), left);
+        right = nautilus::select(isNull, nautilus::val<int64_t>(operation == DecimalOperation::DIV ? 1 : 0), right);
+    }
+
+    const auto checkOverflow = [](const nautilus::val<uint64_t>& overflows)
+    {
+        if (overflows != nautilus::val<uint64_t>(0))
+        {
+            nautilus::invoke(+[] { throw ArithmeticalError("Decimal overflow: the result does not fit into 64 bit"); });
+        }
+    };
+    /// Additions and subtractions wrap around on the unsigned representation, which is well-defined, and check the signs for an overflow
+    const auto unsignedLeft = static_cast<nautilus::val<uint64_t>>(left);
+    const auto unsignedRight = static_cast<nautilus::val<uint64_t>>(right);
+    switch (operation)
+    {
+        case DecimalOperation::ADD: {
+            const auto sum = unsignedLeft + unsignedRight;
+            checkOverflow(DecimalArithmetic::addOverflows(unsignedLeft, unsignedRight, sum));
+            return {static_cast<nautilus::val<int64_t>>(sum), nullable, isNull};
+        }
+        case DecimalOperation::SUB: {
+            const auto difference = unsignedLeft - unsignedRight;
+            checkOverflow(DecimalArithmetic::subOverflows(unsignedLeft, unsignedRight, difference));
+            return {static_cast<nautilus::val<int64_t>>(difference), nullable, isNull};
+        }
+        case DecimalOperation::MUL:
+            return {nautilus::invoke(DecimalArithmetic::multiply, left, right, nautilus::val<uint8_t>(shift)), nullable, isNull};
+        case DecimalOperation::DIV:
+            return {nautilus::invoke(DecimalArithmetic::divide, left, right, nautilus::val<uint8_t>(shift)), nullable, isNull};
+    }
+    std::unreachable();
+}
+
+}
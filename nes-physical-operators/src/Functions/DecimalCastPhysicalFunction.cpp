@@ -0,0 +1,104 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Functions/DecimalCastPhysicalFunction.hpp>
+
+#include <cstdint>
+#include <utility>
+#include <DataTypes/DataType.hpp>
+#include <Functions/DecimalArithmetic.hpp>
+#include <Functions/PhysicalFunction.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Arena.hpp>
+#include <ErrorHandling.hpp>
+#include <ExecutionContext.hpp>
+#include <function.hpp>
+#include <select.hpp>
+#include <val.hpp>
+
+namespace NES
+{
+
+namespace
+{
+/// Null values may hold arbitrary values, thus we convert a zero instead to not raise an error
+template <typename T>
+nautilus::val<T> getValueOrZero(const VarVal& value)
+{
+    const auto rawValue = value.getRawValueAs<nautilus::val<T>>();
+    if (not value.isNullable())
+    {
+        return rawValue;
+    }
+    return nautilus::select(value.isNull(), nautilus::val<T>(0), rawValue);
+}
+}
+
+DecimalCastPhysicalFunction::DecimalCastPhysicalFunction(PhysicalFunction childFunction, DataType fromType, DataType toType)
+    : childFunction(std::move(childFunction)), fromType(std::move(fromType)), toType(std::move(toType))
+{
+    PRECONDITION(
+        (this->fromType.isDecimal() and (this->toType.isNumeric() or this->toType.isDecimal()))
+            or (this->toType.isDecimal() and this->fromType.isNumeric()),
+        "Can not cast {} to {}",
+        this->fromType,
+        this->toType);
+}
+
+VarVal DecimalCastPhysicalFunction::execute(const Record& record, ArenaRef& arena) const
+{
+    const auto value = childFunction.execute(record, arena);
+    const auto toScale = nautilus::val<uint8_t>(toType.scale);
+    if (toType.isDecimal())
+    {
+        if (fromType.isDecimal())
+        {
+            if (fromType.scale == toType.scale)
+            {
+                return value;
+            }
+            const auto unscaled = nautilus::invoke(
+                DecimalArithmetic::rescale, getValueOrZero<int64_t>(value), nautilus::val<uint8_t>(fromType.scale), toScale);
+            return {unscaled, value.isNullable(), value.isNull()};
+        }
+        if (fromType.isFloat())
+        {
+            const auto floatValue = getValueOrZero<double>(value.castToType(DataType::Type::FLOAT64));
+            return {nautilus::invoke(DecimalArithmetic::fromDouble, floatValue, toScale), value.isNullable(), value.isNull()};
+        }
+        if (fromType.isSignedInteger())
+        {
+            const auto integerValue = getValueOrZero<int64_t>(value.castToType(DataType::Type::INT64));
+            const auto unscaled = nautilus::invoke(DecimalArithmetic::rescale, integerValue, nautilus::val<uint8_t>(0), toScale);
+            return {unscaled, value.isNullable(), value.isNull()};
+        }
+        const auto unsignedValue = getValueOrZero<uint64_t>(value.castToType(DataType::Type::UINT64));
+        return {nautilus::invoke(DecimalArithmetic::fromUnsigned, unsignedValue, toScale), value.isNullable(), value.isNull()};
+    }
+
+    const auto unscaled = getValueOrZero<int64_t>(value);
+    const auto fromScale = nautilus::val<uint8_t>(fromType.scale);
+    if (toType.isFloat())
+    {
+        const VarVal floatValue{nautilus::invoke(DecimalArithmetic::toDouble, unscaled, fromScale), value.isNullable(), value.isNull()};
+        return floatValue.castToType(toType.type);
+    }
+    /// Casting a decimal into an integer rounds it with a scale of zero, and wraps around if the integer type is smaller than int64
+    const VarVal integerValue{
+        nautilus::invoke(DecimalArithmetic::rescale, unscaled, fromScale, nautilus::val<uint8_t>(0)), value.isNullable(), value.isNull()};
+    return integerValue.castToType(toType.type);
+}
+
+}
@@ -21,13 +21,14 @@
 namespace NES
 {
 
-FieldAccessPhysicalFunction::FieldAccessPhysicalFunction(Record::RecordFieldIdentifier field) : field(std::move(field))
+FieldAccessPhysicalFunction::FieldAccessPhysicalFunction(Record::RecordFieldIdentifier field)
+    : field(std::move(field)), slot(Record::resolveSlot(this->field))
 {
 }
 
 VarVal FieldAccessPhysicalFunction::execute(const Record& record, ArenaRef&) const
 {
-    return record.read(field);
+    return record.read(slot);
 }
 
 }
@@ -13,27 +13,227 @@
 */
 #include <Functions/FunctionProvider.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
 #include <DataTypes/DataType.hpp>
+#include <DataTypes/DataTypeProvider.hpp>
+#include <DataTypes/Decimal.hpp>
+#include <Functions/ArithmeticalFunctions/AbsoluteLogicalFunction.hpp>
+#include <Functions/ArithmeticalFunctions/AddLogicalFunction.hpp>
+#include <Functions/ArithmeticalFunctions/DivLogicalFunction.hpp>
+#include <Functions/ArithmeticalFunctions/MulLogicalFunction.hpp>
+#include <Functions/ArithmeticalFunctions/SubLogicalFunction.hpp>
+#include <Functions/BatchKernels.hpp>
+#include <Functions/CaseLogicalFunction.hpp>
+#include <Functions/CasePhysicalFunction.hpp>
 #include <Functions/CastFieldPhysicalFunction.hpp>
 #include <Functions/CastToTypeLogicalFunction.hpp>
 #include <Functions/ConstantValueLogicalFunction.hpp>
 #include <Functions/ConstantValuePhysicalFunction.hpp>
 #include <Functions/ConstantValueVariableSizePhysicalFunction.hpp>
+#include <Functions/DateTimeLogicalFunction.hpp>
+#include <Functions/DateTimePhysicalFunction.hpp>
+#include <Functions/DecimalArithmeticPhysicalFunction.hpp>
+#include <Functions/DecimalCastPhysicalFunction.hpp>
 #include <Functions/FieldAccessLogicalFunction.hpp>
 #include <Functions/FieldAccessPhysicalFunction.hpp>
 #include <Functions/LogicalFunction.hpp>
+#include <Functions/ParameterLogicalFunction.hpp>
 #include <Functions/PhysicalFunction.hpp>
+#include <Functions/RegexpMatchPhysicalFunction.hpp>
+#include <Functions/StringMatchLogicalFunction.hpp>
+#include <Functions/StringMatchPhysicalFunction.hpp>
 #include <Util/Strings.hpp>
 #include <ErrorHandling.hpp>
 #include <PhysicalFunctionRegistry.hpp>
 
 namespace NES::QueryCompilation
 {
+namespace
+{
+PhysicalFunction castIfDifferent(PhysicalFunction childFunction, const DataType& childType, const DataType& targetType)
+{
+    if (childType.type == targetType.type and childType.scale == targetType.scale)
+    {
+        return childFunction;
+    }
+    return DecimalCastPhysicalFunction(std::move(childFunction), childType, targetType);
+}
+
+std::optional<DecimalOperation> getDecimalOperation(const std::string_view functionType)
+{
+    if (functionType == AddLogicalFunction::NAME)
+    {
+        return DecimalOperation::ADD;
+    }
+    if (functionType == SubLogicalFunction::NAME)
+    {
+        return DecimalOperation::SUB;
+    }
+    if (functionType == MulLogicalFunction::NAME)
+    {
+        return DecimalOperation::MUL;
+    }
+    if (functionType == DivLogicalFunction::NAME)
+    {
+        return DecimalOperation::DIV;
+    }
+    return std::nullopt;
+}
+
+/// Lowers the arithmetic on decimals and the casts from or into decimals. For all other functions on decimals, it casts the children into
+/// the common type of the children, so that the registry functions, e.g., comparisons, compute on unscaled values of the same scale or
+/// on floating points. Returns nullopt if the registry lowers the function.
+std::optional<PhysicalFunction> lowerDecimalFunction(
+    const LogicalFunction& logicalFunction, std::vector<PhysicalFunction>& childFunctions, const std::vector<DataType>& inputTypes)
+{
+    const auto outputType = logicalFunction.getDataType();
+    if (not outputType.isDecimal() and std::ranges::none_of(inputTypes, &DataType::isDecimal))
+    {
+        return std::nullopt;
+    }
+    const auto functionType = logicalFunction.getType();
+    if (functionType == CastToTypeLogicalFunction::NAME)
+    {
+        return castIfDifferent(childFunctions[0], inputTypes[0], outputType);
+    }
+
+    if (outputType.isDecimal())
+    {
+        /// The absolute of the unscaled value is the unscaled absolute value
+        if (functionType == AbsoluteLogicalFunction::NAME)
+        {
+            return std::nullopt;
+        }
+        const auto operation = getDecimalOperation(functionType);
+        if (not operation.has_value())
+        {
+            throw UnknownFunctionType("{} does not support DECIMAL operands", functionType);
+        }
+        if (operation == DecimalOperation::ADD or operation == DecimalOperation::SUB)
+        {
+            return DecimalArithmeticPhysicalFunction(
+                *operation,
+                castIfDifferent(childFunctions[0], inputTypes[0], outputType),
+                castIfDifferent(childFunctions[1], inputTypes[1], outputType),
+                0);
+        }
+        /// Integer operands of a multiplication or division are decimals with a scale of zero
+        const auto integerDecimal = DataTypeProvider::provideDecimalDataType(Decimal::MAX_PRECISION, 0, DataType::NULLABLE::NOT_NULLABLE);
+        std::array<DataType, 2> operandTypes{inputTypes[0], inputTypes[1]};
+        for (size_t operand = 0; operand < operandTypes.size(); ++operand)
+        {
+            if (not operandTypes[operand].isDecimal())
+            {
+                operandTypes[operand] = integerDecimal;
+                childFunctions[operand] = castIfDifferent(childFunctions[operand], inputTypes[operand], operandTypes[operand]);
+            }
+        }
+        const auto leftScale = operandTypes[0].scale;
+        const auto rightScale = operandTypes[1].scale;
+        const auto shift = operation == DecimalOperation::MUL ? leftScale + rightScale - outputType.scale
+                                                              : outputType.scale - leftScale + rightScale;
+        return DecimalArithmeticPhysicalFunction(*operation, childFunctions[0], childFunctions[1], static_cast<uint8_t>(shift));
+    }
+
+    if (outputType.isFloat())
+    {
+        const auto float64 = DataTypeProvider::provideDataType(DataType::Type::FLOAT64);
+        for (size_t child = 0; child < childFunctions.size(); ++child)
+        {
+            if (inputTypes[child].isDecimal())
+            {
+                childFunctions[child] = DecimalCastPhysicalFunction(childFunctions[child], inputTypes[child], float64);
+            }
+        }
+    }
+    else if (childFunctions.size() == 2)
+    {
+        const auto commonType = inputTypes[0].join(inputTypes[1]);
+        if (commonType.has_value() and (commonType->isDecimal() or commonType->isFloat()))
+        {
+            for (size_t child = 0; child < childFunctions.size(); ++child)
+            {
+                if (inputTypes[child].isDecimal() or commonType->isDecimal())
+                {
+                    childFunctions[child] = castIfDifferent(childFunctions[child], inputTypes[child], *commonType);
+                }
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+/// Returns true if evaluating the function is cheap and can not raise an error, so that a CASE may evaluate it even if its branch does not
+/// match. The arithmetic on decimals raises an error on overflows, thus it is never considered safe.
+bool isCheapAndSafe(const LogicalFunction& function)
+{
+    static constexpr std::array<std::string_view, 12> CheapFunctions{
+        CaseLogicalFunction::NAME,
+        AddLogicalFunction::NAME,
+        SubLogicalFunction::NAME,
+        MulLogicalFunction::NAME,
+        "Equals",
+        "Less",
+        "LessEquals",
+        "Greater",
+        "GreaterEquals",
+        "And",
+        "Or",
+        "Negate"};
+    const auto type = function.getType();
+    if (type == FieldAccessLogicalFunction::NAME or type == ConstantValueLogicalFunction::NAME or type == ParameterLogicalFunction::NAME)
+    {
+        return true;
+    }
+    const auto children = function.getChildren();
+    const auto computesOnDecimals = function.getDataType().isDecimal()
+        or std::ranges::any_of(children, [](const LogicalFunction& child) { return child.getDataType().isDecimal(); });
+    return not computesOnDecimals and std::ranges::find(CheapFunctions, type) != CheapFunctions.end()
+        and std::ranges::all_of(children, isCheapAndSafe);
+}
+
+/// Lowers a CASE to selects if all of its conditions and values are cheap and safe to evaluate, otherwise to branches that only evaluate
+/// the value of the matching branch
+PhysicalFunction lowerCaseFunction(
+    const CaseLogicalFunction& caseFunction, const std::vector<PhysicalFunction>& childFunctions, const std::vector<DataType>& inputTypes)
+{
+    const auto outputType = caseFunction.getDataType();
+    auto branchFree = std::ranges::all_of(caseFunction.getChildren(), isCheapAndSafe);
+    const auto lowerValue = [&](const size_t child)
+    {
+        if (not outputType.isDecimal() and not inputTypes[child].isDecimal())
+        {
+            return childFunctions[child];
+        }
+        /// Rescaling a decimal value may overflow
+        branchFree = branchFree and inputTypes[child].type == outputType.type and inputTypes[child].scale == outputType.scale;
+        return castIfDifferent(childFunctions[child], inputTypes[child], outputType);
+    };
+
+    std::vector<PhysicalFunction> conditions;
+    std::vector<PhysicalFunction> values;
+    for (size_t branch = 0; branch < caseFunction.getNumberOfBranches(); ++branch)
+    {
+        conditions.push_back(childFunctions[branch * 2]);
+        values.push_back(lowerValue((branch * 2) + 1));
+    }
+    std::optional<PhysicalFunction> elseValue;
+    if (caseFunction.getElseValue().has_value())
+    {
+        elseValue = lowerValue(childFunctions.size() - 1);
+    }
+    return CasePhysicalFunction(std::move(conditions), std::move(values), std::move(elseValue), outputType, branchFree);
+}
+}
+
 PhysicalFunction FunctionProvider::lowerFunction(LogicalFunction logicalFunction)
 {
     /// 1. Recursively lower the children of the function node.
@@ -55,6 +255,41 @@ PhysicalFunction FunctionProvider::lowerFunction(LogicalFunction logicalFunction
     {
         return lowerConstantFunction(constantValueFunction->get());
     }
+    /// A preceding ParameterBindingPhysicalOperator binds the value of the parameter to a field
+    if (const auto parameterFunction = logicalFunction.tryGetAs<ParameterLogicalFunction>())
+    {
+        return FieldAccessPhysicalFunction(parameterFunction->get().getFieldName());
+    }
+    /// The unit and the utc offset of a date-time function are not part of the registry arguments
+    if (const auto dateTimeFunction = logicalFunction.tryGetAs<DateTimeLogicalFunction>())
+    {
+        const auto& function = dateTimeFunction->get();
+        return DateTimePhysicalFunction(function.getKind(), function.getUnit(), function.getUtcOffsetInMs(), childFunctions[0]);
+    }
+    /// String predicates compile a constant pattern once, instead of matching against the pattern of every record
+    if (const auto stringMatchFunction = logicalFunction.tryGetAs<StringMatchLogicalFunction>())
+    {
+        if (const auto constantPattern = logicalFunction.getChildren()[1].tryGetAs<ConstantValueLogicalFunction>())
+        {
+            if (stringMatchFunction->get().getKind() == StringMatchKind::REGEXP_MATCH)
+            {
+                return RegexpMatchPhysicalFunction(childFunctions[0], constantPattern->get().getConstantValue());
+            }
+            return StringMatchPhysicalFunction(
+                stringMatchFunction->get().getKind(), childFunctions[0], constantPattern->get().getConstantValue());
+        }
+    }
+
+    /// The lowering of a CASE depends on the cost of its branches, which the registry arguments do not contain
+    if (const auto caseFunction = logicalFunction.tryGetAs<CaseLogicalFunction>())
+    {
+        return lowerCaseFunction(caseFunction->get(), childFunctions, inputTypes);
+    }
+
+    if (auto decimalFunction = lowerDecimalFunction(logicalFunction, childFunctions, inputTypes))
+    {
+        return std::move(decimalFunction.value());
+    }
 
     /// 3. Calling the registry to create an executable function.
     PhysicalFunctionRegistryArguments executableFunctionArguments{
@@ -79,6 +314,96 @@ T parseConstantValue(std::string_view input)
     }
     throw QueryCompilerError("Can not parse constant value \"{}\" into {}", input, NAMEOF_TYPE(T));
 }
+
+std::optional<BatchComparison> getBatchComparison(std::string_view functionType, const bool constantIsLeft)
+{
+    /// If the constant is the left operand, we mirror the comparison to always evaluate `field <comparison> constant`
+    if (functionType == "Equals")
+    {
+        return BatchComparison::EQUALS;
+    }
+    if (functionType == "Less")
+    {
+        return constantIsLeft ? BatchComparison::GREATER : BatchComparison::LESS;
+    }
+    if (functionType == "LessEquals")
+    {
+        return constantIsLeft ? BatchComparison::GREATER_EQUALS : BatchComparison::LESS_EQUALS;
+    }
+    if (functionType == "Greater")
+    {
+        return constantIsLeft ? BatchComparison::LESS : BatchComparison::GREATER;
+    }
+    if (functionType == "GreaterEquals")
+    {
+        return constantIsLeft ? BatchComparison::LESS_EQUALS : BatchComparison::GREATER_EQUALS;
+    }
+    return std::nullopt;
+}
+}
+
+std::optional<BatchFilter> FunctionProvider::lowerBatchFilter(const LogicalFunction& logicalFunction)
+{
+    const auto children = logicalFunction.getChildren();
+    if (children.size() != 2)
+    {
+        return std::nullopt;
+    }
+    const bool constantIsLeft = children[0].tryGetAs<ConstantValueLogicalFunction>().has_value();
+    const auto& fieldChild = constantIsLeft ? children[1] : children[0];
+    const auto& constantChild = constantIsLeft ? children[0] : children[1];
+    const auto fieldAccess = fieldChild.tryGetAs<FieldAccessLogicalFunction>();
+    const auto constantValue = constantChild.tryGetAs<ConstantValueLogicalFunction>();
+    const auto comparison = getBatchComparison(logicalFunction.getType(), constantIsLeft);
+    if (not fieldAccess or not constantValue or not comparison)
+    {
+        return std::nullopt;
+    }
+
+    /// The batch kernels do not support null values. Furthermore, we require field and constant to agree on signedness,
+    /// as otherwise the widened comparison of the kernels could differ from the promoted comparison of the PhysicalFunctions.
+    const auto fieldType = fieldChild.getDataType();
+    const auto constantType = constantChild.getDataType();
+    if (fieldType.nullable or not BatchFilter::supportsType(fieldType.type) or not BatchFilter::supportsType(constantType.type))
+    {
+        return std::nullopt;
+    }
+    const auto stringValue = constantValue->get().getConstantValue();
+    BatchFilter filter{.field = fieldAccess->get().getFieldName(), .fieldType = fieldType.type, .comparison = *comparison, .constant = {}};
+    if (fieldType.isFloat() and constantType.isFloat())
+    {
+        filter.constant = parseConstantValue<double>(stringValue);
+    }
+    else if (fieldType.isSignedInteger() and constantType.isSignedInteger())
+    {
+        filter.constant = parseConstantValue<int64_t>(stringValue);
+    }
+    else if (fieldType.isInteger() and not fieldType.isSignedInteger() and constantType.isInteger() and not constantType.isSignedInteger())
+    {
+        filter.constant = parseConstantValue<uint64_t>(stringValue);
+    }
+    else
+    {
+        return std::nullopt;
+    }
+    return filter;
+}
+
+std::optional<BatchComparison> FunctionProvider::lowerBatchComparison(const LogicalFunction& logicalFunction)
+{
+    const auto children = logicalFunction.getChildren();
+    if (children.size() != 2 or not children[0].tryGetAs<FieldAccessLogicalFunction>()
+        or not children[1].tryGetAs<FieldAccessLogicalFunction>())
+    {
+        return std::nullopt;
+    }
+    const auto leftType = children[0].getDataType();
+    const auto rightType = children[1].getDataType();
+    if (leftType.nullable or rightType.nullable or leftType.type != rightType.type or not BatchFilter::supportsType(leftType.type))
+    {
+        return std::nullopt;
+    }
+    return getBatchComparison(logicalFunction.getType(), false);
 }
 
 PhysicalFunction FunctionProvider::lowerConstantFunction(const ConstantValueLogicalFunction& constantFunction)
@@ -93,6 +418,7 @@ PhysicalFunction FunctionProvider::lowerConstantFunction(const ConstantValueLogi
         case DataType::Type::UINT32:
             return ConstantUInt32ValueFunction(parseConstantValue<uint32_t>(stringValue));
         case DataType::Type::UINT64:
+        case DataType::Type::TIMESTAMP:
             return ConstantUInt64ValueFunction(parseConstantValue<uint64_t>(stringValue));
         case DataType::Type::INT8:
             return ConstantInt8ValueFunction(parseConstantValue<int8_t>(stringValue));
@@ -101,7 +427,16 @@ PhysicalFunction FunctionProvider::lowerConstantFunction(const ConstantValueLogi
         case DataType::Type::INT32:
             return ConstantInt32ValueFunction(parseConstantValue<int32_t>(stringValue));
         case DataType::Type::INT64:
+        case DataType::Type::INTERVAL:
             return ConstantInt64ValueFunction(parseConstantValue<int64_t>(stringValue));
+        case DataType::Type::DECIMAL: {
+            const auto dataType = constantFunction.getDataType();
+            if (const auto unscaledValue = Decimal::parse(stringValue, dataType.precision, dataType.scale))
+            {
+                return ConstantInt64ValueFunction(*unscaledValue);
+            }
+            throw QueryCompilerError("Can not parse constant value \"{}\" into {}", stringValue, dataType);
+        }
         case DataType::Type::FLOAT32:
             return ConstantFloatValueFunction(parseConstantValue<float>(stringValue));
         case DataType::Type::FLOAT64:
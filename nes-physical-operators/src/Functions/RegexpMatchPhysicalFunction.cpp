@@ -0,0 +1,102 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Functions/RegexpMatchPhysicalFunction.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <Functions/PhysicalFunction.hpp>
+#include <Functions/RegularExpression.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/DataTypes/VariableSizedData.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <nautilus/function.hpp>
+#include <Arena.hpp>
+#include <ErrorHandling.hpp>
+#include <ExecutionContext.hpp>
+#include <PhysicalFunctionRegistry.hpp>
+#include <val.hpp>
+#include <val_bool.hpp>
+
+namespace NES
+{
+
+namespace
+{
+bool matchCompiledExpressionProxy(const RegularExpression* expression, const int8_t* content, const uint64_t size)
+{
+    INVARIANT(expression != nullptr, "RegularExpression MUST NOT be null at this point");
+    return expression->matches(std::string_view{reinterpret_cast<const char*>(content), size});
+}
+
+bool matchExpressionProxy(const int8_t* content, const uint64_t size, const int8_t* expressionContent, const uint64_t expressionSize)
+{
+    const auto expression = RegularExpression::compile(std::string_view{reinterpret_cast<const char*>(expressionContent), expressionSize});
+    return expression.matches(std::string_view{reinterpret_cast<const char*>(content), size});
+}
+}
+
+RegexpMatchPhysicalFunction::RegexpMatchPhysicalFunction(PhysicalFunction valuePhysicalFunction, const std::string_view constantExpression)
+    : valuePhysicalFunction(std::move(valuePhysicalFunction))
+    , constantExpression(std::make_shared<const RegularExpression>(RegularExpression::compile(constantExpression)))
+{
+}
+
+RegexpMatchPhysicalFunction::RegexpMatchPhysicalFunction(
+    PhysicalFunction valuePhysicalFunction, PhysicalFunction expressionPhysicalFunction)
+    : valuePhysicalFunction(std::move(valuePhysicalFunction)), expressionPhysicalFunction(std::move(expressionPhysicalFunction))
+{
+}
+
+VarVal RegexpMatchPhysicalFunction::execute(const Record& record, ArenaRef& arena) const
+{
+    const auto value = valuePhysicalFunction.execute(record, arena);
+    const auto valueData = value.getRawValueAs<VariableSizedData>();
+    if (not expressionPhysicalFunction.has_value())
+    {
+        if (value.isNullable() and value.isNull())
+        {
+            return VarVal{nautilus::val<bool>{false}, true, nautilus::val<bool>{true}};
+        }
+        const auto matches = nautilus::invoke(
+            matchCompiledExpressionProxy,
+            nautilus::val<const RegularExpression*>(constantExpression.get()),
+            valueData.getContent(),
+            valueData.getSize());
+        return VarVal{matches, value.isNullable(), nautilus::val<bool>{false}};
+    }
+
+    const auto expression = expressionPhysicalFunction->execute(record, arena);
+    const auto nullable = value.isNullable() or expression.isNullable();
+    const auto null = nullable and (value.isNull() or expression.isNull());
+    if (null)
+    {
+        return VarVal{nautilus::val<bool>{false}, nullable, null};
+    }
+    const auto expressionData = expression.getRawValueAs<VariableSizedData>();
+    const auto matches = nautilus::invoke(
+        matchExpressionProxy, valueData.getContent(), valueData.getSize(), expressionData.getContent(), expressionData.getSize());
+    return VarVal{matches, nullable, null};
+}
+
+PhysicalFunctionRegistryReturnType
+PhysicalFunctionGeneratedRegistrar::RegisterRegexpMatchPhysicalFunction(PhysicalFunctionRegistryArguments arguments)
+{
+    PRECONDITION(arguments.childFunctions.size() == 2, "RegexpMatch function must have exactly two child functions");
+    return RegexpMatchPhysicalFunction(arguments.childFunctions[0], arguments.childFunctions[1]);
+}
+
+}
@@ -0,0 +1,817 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Functions/RegularExpression.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <Functions/StringSearch.hpp>
+#include <fmt/format.h>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+namespace
+{
+using ByteSet = std::array<bool, 256>;
+
+constexpr size_t UNBOUNDED = std::numeric_limits<size_t>::max();
+/// Bounded repetitions copy their expression, thus the size of the NFA is bounded
+constexpr size_t MAX_NFA_STATES = 10000;
+constexpr size_t MAX_REPETITIONS = 1000;
+/// Bounds the number of NFA states that building the DFA visits, before it falls back to simulating the NFA
+constexpr size_t MAX_DFA_CONSTRUCTION_WORK = size_t{1} << 24;
+constexpr size_t MAX_LITERAL_SIZE = 256;
+
+ByteSet byteRange(const uint8_t first, const uint8_t last)
+{
+    ByteSet bytes{};
+    std::fill(bytes.begin() + first, bytes.begin() + last + 1, true);
+    return bytes;
+}
+
+ByteSet singleByte(const char byte)
+{
+    return byteRange(static_cast<uint8_t>(byte), static_cast<uint8_t>(byte));
+}
+
+void addBytes(ByteSet& bytes, const ByteSet& other)
+{
+    for (size_t byte = 0; byte < bytes.size(); ++byte)
+    {
+        bytes[byte] = bytes[byte] or other[byte];
+    }
+}
+
+ByteSet negated(ByteSet bytes)
+{
+    std::ranges::transform(bytes, bytes.begin(), [](const bool contained) { return not contained; });
+    return bytes;
+}
+
+bool isDigit(const char character)
+{
+    return character >= '0' and character <= '9';
+}
+}
+
+struct RegularExpression::Node
+{
+    enum class Kind : uint8_t
+    {
+        EMPTY,
+        BYTES,
+        CONCATENATION,
+        ALTERNATION,
+        REPETITION
+    };
+
+    /// The literal that the node matches exactly, if any, and the longest literal that all its matches contain
+    struct Literals
+    {
+        std::optional<std::string> exact;
+        std::string required;
+    };
+
+    static uint32_t addState(std::vector<NfaState>& nfa, const NfaState& state);
+    /// Adds the states of the node, which continue with the state `next`, and returns the start state of the node
+    uint32_t addNfaStates(std::vector<NfaState>& nfa, uint32_t next) const;
+    [[nodiscard]] Literals analyzeLiterals() const;
+
+    Kind kind = Kind::EMPTY;
+    ByteSet bytes{};
+    std::vector<Node> children;
+    size_t minRepetitions = 0;
+    size_t maxRepetitions = 0;
+};
+
+uint32_t RegularExpression::Node::addState(std::vector<NfaState>& nfa, const NfaState& state)
+{
+    if (nfa.size() >= MAX_NFA_STATES)
+    {
+        throw InvalidLiteral("The regular expression exceeds the maximum size of {} states", MAX_NFA_STATES);
+    }
+    nfa.push_back(state);
+    return static_cast<uint32_t>(nfa.size() - 1);
+}
+
+uint32_t RegularExpression::Node::addNfaStates(std::vector<NfaState>& nfa, const uint32_t next) const
+{
+    switch (kind)
+    {
+        case Kind::EMPTY:
+            return next;
+        case Kind::BYTES:
+            return addState(nfa, {.kind = NfaState::Kind::BYTES, .next = next, .bytes = bytes});
+        case Kind::CONCATENATION: {
+            auto start = next;
+            for (const auto& child : children | std::views::reverse)
+            {
+                start = child.addNfaStates(nfa, start);
+            }
+            return start;
+        }
+        case Kind::ALTERNATION: {
+            auto start = children.back().addNfaStates(nfa, next);
+            for (auto child = children.rbegin() + 1; child != children.rend(); ++child)
+            {
+                const auto childStart = child->addNfaStates(nfa, next);
+                start = addState(nfa, {.kind = NfaState::Kind::SPLIT, .next = childStart, .alternative = start});
+            }
+            return start;
+        }
+        case Kind::REPETITION: {
+            const auto& child = children.front();
+            auto start = next;
+            if (maxRepetitions == UNBOUNDED)
+            {
+                /// The loop branches to the child, which continues with the loop, or leaves the repetition
+                const auto loop = addState(nfa, {.kind = NfaState::Kind::SPLIT, .alternative = next});
+                const auto childStart = child.addNfaStates(nfa, loop);
+                nfa[loop].next = childStart;
+                start = loop;
+            }
+            else
+            {
+                /// Every optional repetition either matches the child, which continues with the next optional repetition, or leaves
+                for (size_t repetition = minRepetitions; repetition < maxRepetitions; ++repetition)
+                {
+                    const auto childStart = child.addNfaStates(nfa, start);
+                    start = addState(nfa, {.kind = NfaState::Kind::SPLIT, .next = childStart, .alternative = next});
+                }
+            }
+            for (size_t repetition = 0; repetition < minRepetitions; ++repetition)
+            {
+                start = child.addNfaStates(nfa, start);
+            }
+            return start;
+        }
+    }
+    std::unreachable();
+}
+
+RegularExpression::Node::Literals RegularExpression::Node::analyzeLiterals() const
+{
+    switch (kind)
+    {
+        case Kind::EMPTY:
+            return {.exact = std::string{}, .required = {}};
+        case Kind::BYTES: {
+            if (std::ranges::count(bytes, true) != 1)
+            {
+                return {};
+            }
+            const std::string byte(1, static_cast<char>(std::ranges::find(bytes, true) - bytes.begin()));
+            return {.exact = byte, .required = byte};
+        }
+        case Kind::CONCATENATION: {
+            /// A run of children with exact literals is a literal of the concatenation
+            Literals literals{.exact = std::string{}, .required = {}};
+            std::string run;
+            const auto keepLongest = [&literals](const std::string& candidate)
+            {
+                if (candidate.size() > literals.required.size())
+                {
+                    literals.required = candidate;
+                }
+            };
+            for (const auto& child : children)
+            {
+                const auto childLiterals = child.analyzeLiterals();
+                if (childLiterals.exact.has_value() and run.size() + childLiterals.exact->size() <= MAX_LITERAL_SIZE)
+                {
+                    run += *childLiterals.exact;
+                    continue;
+                }
+                keepLongest(run);
+                keepLongest(childLiterals.required);
+                run.clear();
+                literals.exact.reset();
+            }
+            keepLongest(run);
+            if (literals.exact.has_value())
+            {
+                literals.exact = run;
+            }
+            return literals;
+        }
+        case Kind::ALTERNATION:
+            return {};
+        case Kind::REPETITION: {
+            if (maxRepetitions == 0)
+            {
+                return {.exact = std::string{}, .required = {}};
+            }
+            if (minRepetitions == 0)
+            {
+                return {};
+            }
+            auto childLiterals = children.front().analyzeLiterals();
+            if (childLiterals.exact.has_value() and minRepetitions == maxRepetitions
+                and childLiterals.exact->size() * minRepetitions <= MAX_LITERAL_SIZE)
+            {
+                std::string repeated;
+                for (size_t repetition = 0; repetition < minRepetitions; ++repetition)
+                {
+                    repeated += *childLiterals.exact;
+                }
+                return {.exact = repeated, .required = repeated};
+            }
+            return {.exact = std::nullopt, .required = std::move(childLiterals.required)};
+        }
+    }
+    std::unreachable();
+}
+
+/// Parses an expression into its syntax tree with a recursive descent over alternations, concatenations, repetitions and atoms
+class RegularExpression::Parser
+{
+public:
+    explicit Parser(const std::string_view expression) : expression(expression) { }
+
+    Node parse(bool& anchoredAtStart, bool& anchoredAtEnd)
+    {
+        anchoredAtStart = consume('^');
+        auto root = parseAlternation();
+        if (not atEnd())
+        {
+            fail("unbalanced parenthesis");
+        }
+        anchoredAtEnd = this->anchoredAtEnd;
+        if (hasTopLevelAlternatives and (anchoredAtStart or anchoredAtEnd))
+        {
+            fail("anchors apply to the whole expression, alternatives with anchors must be grouped, e.g., ^(a|b)$");
+        }
+        return root;
+    }
+
+private:
+    [[noreturn]] void fail(const std::string_view reason) const
+    {
+        throw InvalidLiteral("Invalid regular expression '{}' at position {}: {}", expression, position, reason);
+    }
+
+    [[nodiscard]] bool atEnd() const { return position == expression.size(); }
+
+    [[nodiscard]] char peek() const { return expression[position]; }
+
+    bool consume(const char character)
+    {
+        if (not atEnd() and peek() == character)
+        {
+            ++position;
+            return true;
+        }
+        return false;
+    }
+
+    char next()
+    {
+        if (atEnd())
+        {
+            fail("unexpected end of the expression");
+        }
+        return expression[position++];
+    }
+
+    Node parseAlternation()
+    {
+        Node alternation{.kind = Node::Kind::ALTERNATION};
+        alternation.children.push_back(parseConcatenation());
+        while (consume('|'))
+        {
+            hasTopLevelAlternatives = hasTopLevelAlternatives or depth == 0;
+            alternation.children.push_back(parseConcatenation());
+        }
+        if (alternation.children.size() == 1)
+        {
+            return std::move(alternation.children.front());
+        }
+        return alternation;
+    }
+
+    Node parseConcatenation()
+    {
+        Node concatenation{.kind = Node::Kind::CONCATENATION};
+        while (not atEnd() and peek() != '|' and peek() != ')')
+        {
+            concatenation.children.push_back(parseRepetition());
+        }
+        if (concatenation.children.empty())
+        {
+            return Node{};
+        }
+        if (concatenation.children.size() == 1)
+        {
+            return std::move(concatenation.children.front());
+        }
+        return concatenation;
+    }
+
+    size_t parseNumber()
+    {
+        if (atEnd() or not isDigit(peek()))
+        {
+            fail("expected a repetition count");
+        }
+        size_t number = 0;
+        while (not atEnd() and isDigit(peek()))
+        {
+            number = (number * 10) + static_cast<size_t>(next() - '0');
+            if (number > MAX_REPETITIONS)
+            {
+                fail(fmt::format("repetition counts must not exceed {}", MAX_REPETITIONS));
+            }
+        }
+        return number;
+    }
+
+    Node parseRepetition()
+    {
+        auto atom = parseAtom();
+        if (atEnd())
+        {
+            return atom;
+        }
+        size_t minRepetitions = 0;
+        size_t maxRepetitions = UNBOUNDED;
+        switch (peek())
+        {
+            case '*':
+                break;
+            case '+':
+                minRepetitions = 1;
+                break;
+            case '?':
+                maxRepetitions = 1;
+                break;
+            case '{':
+                ++position;
+                minRepetitions = parseNumber();
+                maxRepetitions = minRepetitions;
+                if (consume(','))
+                {
+                    maxRepetitions = not atEnd() and peek() == '}' ? UNBOUNDED : parseNumber();
+                }
+                if (atEnd() or peek() != '}')
+                {
+                    fail("expected } after the repetition count");
+                }
+                if (minRepetitions > maxRepetitions)
+                {
+                    fail("the minimum repetition count exceeds the maximum");
+                }
+                break;
+            default:
+                return atom;
+        }
+        ++position;
+        /// Lazy quantifiers change which match is found, but not whether there is one
+        consume('?');
+        if (not atEnd() and (peek() == '*' or peek() == '+' or peek() == '?' or peek() == '{'))
+        {
+            fail("nested quantifiers, e.g., possessive quantifiers, are not supported");
+        }
+        Node repetition{.kind = Node::Kind::REPETITION, .minRepetitions = minRepetitions, .maxRepetitions = maxRepetitions};
+        repetition.children.push_back(std::move(atom));
+        return repetition;
+    }
+
+    Node parseAtom()
+    {
+        const auto character = next();
+        switch (character)
+        {
+            case '(': {
+                if (consume('?') and not consume(':'))
+                {
+                    fail("only non-capturing groups (?:...) are supported");
+                }
+                ++depth;
+                auto group = parseAlternation();
+                --depth;
+                if (not consume(')'))
+                {
+                    fail("unbalanced parenthesis");
+                }
+                return group;
+            }
+            case '[':
+                return Node{.kind = Node::Kind::BYTES, .bytes = parseBracketExpression()};
+            case '.':
+                return Node{.kind = Node::Kind::BYTES, .bytes = negated(singleByte('\n'))};
+            case '\\':
+                return Node{.kind = Node::Kind::BYTES, .bytes = parseEscape()};
+            case '$':
+                if (not atEnd() or depth > 0)
+                {
+                    fail("$ is only supported at the end of the expression");
+                }
+                anchoredAtEnd = true;
+                return Node{};
+            case '^':
+                fail("^ is only supported at the start of the expression");
+            case '*':
+            case '+':
+            case '?':
+            case '{':
+                fail("repetition without an expression");
+            default:
+                return Node{.kind = Node::Kind::BYTES, .bytes = singleByte(character)};
+        }
+    }
+
+    /// Parses the escape after a backslash, which is either a class of bytes or a single (escaped) byte
+    ByteSet parseEscape()
+    {
+        const auto character = next();
+        switch (character)
+        {
+            case 'd':
+                return byteRange('0', '9');
+            case 'D':
+                return negated(byteRange('0', '9'));
+            case 'w':
+            case 'W': {
+                auto word = byteRange('a', 'z');
+                addBytes(word, byteRange('A', 'Z'));
+                addBytes(word, byteRange('0', '9'));
+                addBytes(word, singleByte('_'));
+                return character == 'w' ? word : negated(word);
+            }
+            case 's':
+            case 'S': {
+                auto space = byteRange('\t', '\r');
+                addBytes(space, singleByte(' '));
+                return character == 's' ? space : negated(space);
+            }
+            case 'n':
+                return singleByte('\n');
+            case 't':
+                return singleByte('\t');
+            case 'r':
+                return singleByte('\r');
+            case 'f':
+                return singleByte('\f');
+            case 'v':
+                return singleByte('\v');
+            case 'x': {
+                const auto hexDigit = [this]
+                {
+                    const auto digit = next();
+                    if (isDigit(digit))
+                    {
+                        return digit - '0';
+                    }
+                    if ((digit >= 'a' and digit <= 'f') or (digit >= 'A' and digit <= 'F'))
+                    {
+                        return (digit | 0x20) - 'a' + 10;
+                    }
+                    fail("expected a hexadecimal digit");
+                };
+                const auto high = hexDigit();
+                return singleByte(static_cast<char>((high * 16) + hexDigit()));
+            }
+            default:
+                if (isDigit(character))
+                {
+                    fail("backreferences are not supported");
+                }
+                if ((character >= 'a' and character <= 'z') or (character >= 'A' and character <= 'Z'))
+                {
+                    fail("unsupported escape sequence, e.g., a word boundary");
+                }
+                return singleByte(character);
+        }
+    }
+
+    /// Parses a bracket expression after its `[`, e.g., `[^a-z_]`. A `]` right after the `[` (or `[^`) is a literal.
+    ByteSet parseBracketExpression()
+    {
+        const bool negate = consume('^');
+        ByteSet bytes{};
+        bool first = true;
+        while (first or not consume(']'))
+        {
+            first = false;
+            if (expression.substr(position).starts_with("[:"))
+            {
+                fail("character class names, e.g., [:alpha:], are not supported");
+            }
+            const auto start = parseBracketElement(bytes);
+            if (not start.has_value())
+            {
+                continue;
+            }
+            if (position + 1 < expression.size() and peek() == '-' and expression[position + 1] != ']')
+            {
+                ++position;
+                const auto end = parseBracketElement(bytes);
+                if (not end.has_value() or static_cast<uint8_t>(*end) < static_cast<uint8_t>(*start))
+                {
+                    fail("invalid range in bracket expression");
+                }
+                addBytes(bytes, byteRange(static_cast<uint8_t>(*start), static_cast<uint8_t>(*end)));
+                continue;
+            }
+            bytes[static_cast<uint8_t>(*start)] = true;
+        }
+        return negate ? negated(bytes) : bytes;
+    }
+
+    /// Returns the byte of a single element of a bracket expression, or adds the bytes of a class, e.g., `\d`, and returns nullopt
+    std::optional<char> parseBracketElement(ByteSet& bytes)
+    {
+        const auto character = next();
+        if (character != '\\')
+        {
+            return character;
+        }
+        const auto escaped = parseEscape();
+        if (std::ranges::count(escaped, true) == 1)
+        {
+            return static_cast<char>(std::ranges::find(escaped, true) - escaped.begin());
+        }
+        addBytes(bytes, escaped);
+        return std::nullopt;
+    }
+
+    std::string_view expression;
+    size_t position = 0;
+    /// The number of groups that enclose the current position
+    size_t depth = 0;
+    bool hasTopLevelAlternatives = false;
+    bool anchoredAtEnd = false;
+};
+
+RegularExpression RegularExpression::compile(const std::string_view expression)
+{
+    RegularExpression regularExpression;
+    Parser parser(expression);
+    const auto root = parser.parse(regularExpression.anchoredAtStart, regularExpression.anchoredAtEnd);
+
+    auto literals = root.analyzeLiterals();
+    regularExpression.isLiteral = literals.exact.has_value();
+    regularExpression.requiredLiteral = regularExpression.isLiteral ? std::move(*literals.exact) : std::move(literals.required);
+    const bool anchored = regularExpression.anchoredAtStart or regularExpression.anchoredAtEnd;
+    if (not regularExpression.requiredLiteral.empty() or (regularExpression.isLiteral and not anchored))
+    {
+        regularExpression.requiredLiteralSearcher.emplace(regularExpression.requiredLiteral);
+    }
+    if (regularExpression.isLiteral)
+    {
+        return regularExpression;
+    }
+
+    const auto match = Node::addState(regularExpression.nfa, {.kind = NfaState::Kind::MATCH});
+    regularExpression.nfaStart = root.addNfaStates(regularExpression.nfa, match);
+    regularExpression.compiledToDfa = regularExpression.buildDfa();
+    if (not regularExpression.compiledToDfa)
+    {
+        regularExpression.dfaTransitions.clear();
+        regularExpression.dfaFlags.clear();
+    }
+    return regularExpression;
+}
+
+void RegularExpression::addWithClosure(std::vector<uint32_t>& states, std::vector<bool>& contained, const uint32_t state) const
+{
+    if (contained[state])
+    {
+        return;
+    }
+    /// The added states are the worklist of the closure
+    const auto firstAdded = states.size();
+    contained[state] = true;
+    states.push_back(state);
+    for (auto added = firstAdded; added < states.size(); ++added)
+    {
+        const auto& nfaState = nfa[states[added]];
+        if (nfaState.kind != NfaState::Kind::SPLIT)
+        {
+            continue;
+        }
+        for (const auto target : {nfaState.next, nfaState.alternative})
+        {
+            if (not contained[target])
+            {
+                contained[target] = true;
+                states.push_back(target);
+            }
+        }
+    }
+}
+
+bool RegularExpression::buildDfa()
+{
+    /// Bytes that every BYTES state either consumes or rejects share a class, which refines the classes by the bytes of every state
+    std::array<size_t, 256> classes{};
+    numberOfByteClasses = 1;
+    for (const auto& state : nfa)
+    {
+        if (state.kind != NfaState::Kind::BYTES)
+        {
+            continue;
+        }
+        std::vector<size_t> refinedClasses(numberOfByteClasses * 2, UNBOUNDED);
+        size_t numberOfRefinedClasses = 0;
+        for (size_t byte = 0; byte < classes.size(); ++byte)
+        {
+            auto& refinedClass = refinedClasses[(classes[byte] * 2) + (state.bytes[byte] ? 1 : 0)];
+            if (refinedClass == UNBOUNDED)
+            {
+                refinedClass = numberOfRefinedClasses++;
+            }
+            classes[byte] = refinedClass;
+        }
+        numberOfByteClasses = numberOfRefinedClasses;
+    }
+    std::vector<uint8_t> representatives(numberOfByteClasses);
+    for (size_t byte = 0; byte < classes.size(); ++byte)
+    {
+        byteClasses[byte] = static_cast<uint8_t>(classes[byte]);
+        representatives[classes[byte]] = static_cast<uint8_t>(byte);
+    }
+
+    /// A state of the DFA is the set of NFA states that consume a byte or accept. Without an anchor at the start, every set contains the
+    /// start of the NFA, so that the DFA finds matches that start at any position.
+    std::map<std::vector<uint32_t>, uint32_t> dfaStateIds;
+    std::vector<std::vector<uint32_t>> dfaStates;
+    const auto addDfaState = [&](std::vector<uint32_t> states) -> std::optional<uint32_t>
+    {
+        std::erase_if(states, [this](const uint32_t state) { return nfa[state].kind == NfaState::Kind::SPLIT; });
+        std::ranges::sort(states);
+        if (const auto existing = dfaStateIds.find(states); existing != dfaStateIds.end())
+        {
+            return existing->second;
+        }
+        if (dfaStates.size() == MAX_DFA_STATES)
+        {
+            return std::nullopt;
+        }
+        const bool accepts = std::ranges::any_of(states, [this](const uint32_t state) { return nfa[state].kind == NfaState::Kind::MATCH; });
+        /// Without an anchor at the end, the first match decides the result. A state without NFA states can not match anymore.
+        const bool stops = (accepts and not anchoredAtEnd) or states.empty();
+        const auto id = static_cast<uint32_t>(dfaStates.size());
+        dfaFlags.push_back((accepts ? ACCEPTS : 0) | (stops ? STOPS : 0));
+        dfaStateIds.emplace(states, id);
+        dfaStates.push_back(std::move(states));
+        return id;
+    };
+
+    std::vector<bool> contained(nfa.size(), false);
+    std::vector<uint32_t> states;
+    addWithClosure(states, contained, nfaStart);
+    addDfaState(states);
+    for (const auto state : states)
+    {
+        contained[state] = false;
+    }
+
+    size_t work = 0;
+    for (uint32_t id = 0; id < dfaStates.size(); ++id)
+    {
+        dfaTransitions.resize(dfaTransitions.size() + numberOfByteClasses, id);
+        if ((dfaFlags[id] & STOPS) != 0)
+        {
+            continue;
+        }
+        const auto current = dfaStates[id];
+        for (size_t byteClass = 0; byteClass < numberOfByteClasses; ++byteClass)
+        {
+            states.clear();
+            for (const auto state : current)
+            {
+                if (nfa[state].kind == NfaState::Kind::BYTES and nfa[state].bytes[representatives[byteClass]])
+                {
+                    addWithClosure(states, contained, nfa[state].next);
+                }
+            }
+            if (not anchoredAtStart)
+            {
+                addWithClosure(states, contained, nfaStart);
+            }
+            work += current.size() + states.size();
+            const auto target = addDfaState(states);
+            for (const auto state : states)
+            {
+                contained[state] = false;
+            }
+            if (work > MAX_DFA_CONSTRUCTION_WORK or not target.has_value())
+            {
+                return false;
+            }
+            dfaTransitions[(id * numberOfByteClasses) + byteClass] = *target;
+        }
+    }
+    return true;
+}
+
+bool RegularExpression::matchesWithDfa(const std::string_view value) const
+{
+    uint32_t state = 0;
+    for (const auto byte : value)
+    {
+        if ((dfaFlags[state] & STOPS) != 0)
+        {
+            break;
+        }
+        state = dfaTransitions[(state * numberOfByteClasses) + byteClasses[static_cast<uint8_t>(byte)]];
+    }
+    return (dfaFlags[state] & ACCEPTS) != 0;
+}
+
+bool RegularExpression::matchesWithNfa(const std::string_view value) const
+{
+    const auto accepts = [this](const std::vector<uint32_t>& states)
+    { return std::ranges::any_of(states, [this](const uint32_t state) { return nfa[state].kind == NfaState::Kind::MATCH; }); };
+
+    std::vector<bool> contained(nfa.size(), false);
+    std::vector<uint32_t> current;
+    std::vector<uint32_t> next;
+    addWithClosure(current, contained, nfaStart);
+    for (const auto byte : value)
+    {
+        if (not anchoredAtEnd and accepts(current))
+        {
+            return true;
+        }
+        for (const auto state : current)
+        {
+            contained[state] = false;
+        }
+        next.clear();
+        for (const auto state : current)
+        {
+            if (nfa[state].kind == NfaState::Kind::BYTES and nfa[state].bytes[static_cast<uint8_t>(byte)])
+            {
+                addWithClosure(next, contained, nfa[state].next);
+            }
+        }
+        if (not anchoredAtStart)
+        {
+            addWithClosure(next, contained, nfaStart);
+        }
+        if (next.empty())
+        {
+            return false;
+        }
+        std::swap(current, next);
+    }
+    return accepts(current);
+}
+
+bool RegularExpression::matches(const std::string_view value) const
+{
+    if (isLiteral)
+    {
+        if (anchoredAtStart)
+        {
+            return anchoredAtEnd ? value == requiredLiteral : value.starts_with(requiredLiteral);
+        }
+        if (anchoredAtEnd)
+        {
+            return value.ends_with(requiredLiteral);
+        }
+        return requiredLiteralSearcher->find(value) != std::string_view::npos;
+    }
+    if (requiredLiteralSearcher.has_value() and requiredLiteralSearcher->find(value) == std::string_view::npos)
+    {
+        return false;
+    }
+    return compiledToDfa ? matchesWithDfa(value) : matchesWithNfa(value);
+}
+
+const std::string& RegularExpression::getRequiredLiteral() const
+{
+    return requiredLiteral;
+}
+
+bool RegularExpression::isCompiledToDfa() const
+{
+    return compiledToDfa;
+}
+
+}
@@ -0,0 +1,491 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Functions/SimdBatchKernels.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <Functions/BatchKernels.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <magic_enum/magic_enum.hpp>
+
+#if defined(__x86_64__)
+    #include <immintrin.h>
+#elif defined(__aarch64__)
+    #include <arm_neon.h>
+#endif
+
+namespace NES
+{
+
+namespace
+{
+/// All kernels evaluate the comparison for blocks of 16 records and produce one bit per record
+constexpr size_t SIMD_BLOCK_SIZE = 16;
+
+template <typename T>
+constexpr bool HAS_SIMD_KERNEL = std::is_same_v<T, int32_t> || std::is_same_v<T, uint32_t> || std::is_same_v<T, int64_t>
+    || std::is_same_v<T, uint64_t> || std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+/// Maps 8 bits of a bitmask to 8 mask bytes, e.g., 0b101 to 0x010001
+constexpr std::array<uint64_t, 256> BITS_TO_BYTES = []
+{
+    std::array<uint64_t, 256> bytes{};
+    for (size_t bits = 0; bits < bytes.size(); ++bits)
+    {
+        for (size_t bit = 0; bit < 8; ++bit)
+        {
+            bytes[bits] |= ((bits >> bit) & 1U) << (bit * 8);
+        }
+    }
+    return bytes;
+}();
+
+/// Writes the 16 bits of a block as 16 mask bytes
+template <bool IsFirstFilter>
+inline void storeBlockMask(int8_t* mask, const uint32_t bits)
+{
+    std::array<uint64_t, 2> bytes{BITS_TO_BYTES[bits & 0xFFU], BITS_TO_BYTES[(bits >> 8) & 0xFFU]};
+    if constexpr (not IsFirstFilter)
+    {
+        std::array<uint64_t, 2> existing{};
+        std::memcpy(existing.data(), mask, sizeof(existing));
+        bytes[0] &= existing[0];
+        bytes[1] &= existing[1];
+    }
+    std::memcpy(mask, bytes.data(), sizeof(bytes));
+}
+
+/// Evaluates the records that do not fill a whole block
+template <typename T, BatchComparison Comparison, bool IsFirstFilter>
+inline void evaluateTail(const int8_t* values, uint64_t index, const uint64_t size, int8_t* mask, const T constant)
+{
+    for (; index < size; ++index)
+    {
+        T value;
+        std::memcpy(&value, values + (index * sizeof(T)), sizeof(T));
+        const auto qualifies = static_cast<int8_t>(evaluateComparison<Comparison>(value, constant));
+        mask[index] = IsFirstFilter ? qualifies : static_cast<int8_t>(mask[index] & qualifies);
+    }
+}
+
+#if defined(__x86_64__)
+template <BatchComparison Comparison>
+constexpr int FLOAT_PREDICATE = Comparison == BatchComparison::EQUALS ? _CMP_EQ_OQ
+    : Comparison == BatchComparison::LESS                           ? _CMP_LT_OQ
+    : Comparison == BatchComparison::LESS_EQUALS                    ? _CMP_LE_OQ
+    : Comparison == BatchComparison::GREATER                        ? _CMP_GT_OQ
+                                                                    : _CMP_GE_OQ;
+
+template <BatchComparison Comparison>
+constexpr int INTEGER_PREDICATE = Comparison == BatchComparison::EQUALS ? _MM_CMPINT_EQ
+    : Comparison == BatchComparison::LESS                             ? _MM_CMPINT_LT
+    : Comparison == BatchComparison::LESS_EQUALS                      ? _MM_CMPINT_LE
+    : Comparison == BatchComparison::GREATER                          ? _MM_CMPINT_NLE
+                                                                      : _MM_CMPINT_NLT;
+
+/// Integer intrinsics of AVX2 for 32 bit and 64 bit lanes
+template <typename T>
+struct Avx2Integer;
+
+template <typename T>
+requires(sizeof(T) == 4)
+struct Avx2Integer<T>
+{
+    __attribute__((target("avx2"))) static __m256i broadcast(T value) { return _mm256_set1_epi32(static_cast<int32_t>(value)); }
+    __attribute__((target("avx2"))) static __m256i signBit() { return _mm256_set1_epi32(INT32_MIN); }
+    __attribute__((target("avx2"))) static __m256i equals(__m256i left, __m256i right) { return _mm256_cmpeq_epi32(left, right); }
+    __attribute__((target("avx2"))) static __m256i greater(__m256i left, __m256i right) { return _mm256_cmpgt_epi32(left, right); }
+    __attribute__((target("avx2"))) static uint32_t movemask(__m256i result)
+    {
+        return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(result)));
+    }
+};
+
+template <typename T>
+requires(sizeof(T) == 8)
+struct Avx2Integer<T>
+{
+    __attribute__((target("avx2"))) static __m256i broadcast(T value) { return _mm256_set1_epi64x(static_cast<int64_t>(value)); }
+    __attribute__((target("avx2"))) static __m256i signBit() { return _mm256_set1_epi64x(INT64_MIN); }
+    __attribute__((target("avx2"))) static __m256i equals(__m256i left, __m256i right) { return _mm256_cmpeq_epi64(left, right); }
+    __attribute__((target("avx2"))) static __m256i greater(__m256i left, __m256i right) { return _mm256_cmpgt_epi64(left, right); }
+    __attribute__((target("avx2"))) static uint32_t movemask(__m256i result)
+    {
+        return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(result)));
+    }
+};
+
+template <typename T, BatchComparison Comparison>
+__attribute__((target("avx2"))) inline uint32_t compareBlockAvx2(const int8_t* values, const T constant)
+{
+    constexpr size_t lanes = sizeof(__m256i) / sizeof(T);
+    uint32_t bits = 0;
+    for (size_t block = 0; block < SIMD_BLOCK_SIZE / lanes; ++block)
+    {
+        const auto* address = values + (block * sizeof(__m256i));
+        uint32_t blockBits = 0;
+        if constexpr (std::is_same_v<T, float>)
+        {
+            const auto result = _mm256_cmp_ps(_mm256_loadu_ps(reinterpret_cast<const float*>(address)), /// NOLINT
+                                              _mm256_set1_ps(constant),
+                                              FLOAT_PREDICATE<Comparison>);
+            blockBits = static_cast<uint32_t>(_mm256_movemask_ps(result));
+        }
+        else if constexpr (std::is_same_v<T, double>)
+        {
+            const auto result = _mm256_cmp_pd(_mm256_loadu_pd(reinterpret_cast<const double*>(address)), /// NOLINT
+                                              _mm256_set1_pd(constant),
+                                              FLOAT_PREDICATE<Comparison>);
+            blockBits = static_cast<uint32_t>(_mm256_movemask_pd(result));
+        }
+        else
+        {
+            /// AVX2 only provides signed integer comparisons. Flipping the sign bit maps the unsigned order onto the signed order.
+            auto value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(address)); /// NOLINT
+            auto broadcast = Avx2Integer<T>::broadcast(constant);
+            if constexpr (std::is_unsigned_v<T>)
+            {
+                value = _mm256_xor_si256(value, Avx2Integer<T>::signBit());
+                broadcast = _mm256_xor_si256(broadcast, Avx2Integer<T>::signBit());
+            }
+            constexpr uint32_t allLanes = (1U << lanes) - 1;
+            if constexpr (Comparison == BatchComparison::EQUALS)
+            {
+                blockBits = Avx2Integer<T>::movemask(Avx2Integer<T>::equals(value, broadcast));
+            }
+            else if constexpr (Comparison == BatchComparison::LESS)
+            {
+                blockBits = Avx2Integer<T>::movemask(Avx2Integer<T>::greater(broadcast, value));
+            }
+            else if constexpr (Comparison == BatchComparison::LESS_EQUALS)
+            {
+                blockBits = ~Avx2Integer<T>::movemask(Avx2Integer<T>::greater(value, broadcast)) & allLanes;
+            }
+            else if constexpr (Comparison == BatchComparison::GREATER)
+            {
+                blockBits = Avx2Integer<T>::movemask(Avx2Integer<T>::greater(value, broadcast));
+            }
+            else
+            {
+                blockBits = ~Avx2Integer<T>::movemask(Avx2Integer<T>::greater(broadcast, value)) & allLanes;
+            }
+        }
+        bits |= blockBits << (block * lanes);
+    }
+    return bits;
+}
+
+template <typename T, BatchComparison Comparison>
+__attribute__((target("avx512f"))) inline uint32_t compareBlockAvx512(const int8_t* values, const T constant)
+{
+    constexpr size_t lanes = sizeof(__m512i) / sizeof(T);
+    uint32_t bits = 0;
+    for (size_t block = 0; block < SIMD_BLOCK_SIZE / lanes; ++block)
+    {
+        const auto* address = values + (block * sizeof(__m512i));
+        uint32_t blockBits = 0;
+        if constexpr (std::is_same_v<T, float>)
+        {
+            blockBits = _mm512_cmp_ps_mask(_mm512_loadu_ps(address), _mm512_set1_ps(constant), FLOAT_PREDICATE<Comparison>);
+        }
+        else if constexpr (std::is_same_v<T, double>)
+        {
+            blockBits = _mm512_cmp_pd_mask(_mm512_loadu_pd(address), _mm512_set1_pd(constant), FLOAT_PREDICATE<Comparison>);
+        }
+        else if constexpr (std::is_same_v<T, int32_t>)
+        {
+            blockBits = _mm512_cmp_epi32_mask(_mm512_loadu_si512(address), _mm512_set1_epi32(constant), INTEGER_PREDICATE<Comparison>);
+        }
+        else if constexpr (std::is_same_v<T, uint32_t>)
+        {
+            blockBits = _mm512_cmp_epu32_mask(
+                _mm512_loadu_si512(address), _mm512_set1_epi32(static_cast<int32_t>(constant)), INTEGER_PREDICATE<Comparison>);
+        }
+        else if constexpr (std::is_same_v<T, int64_t>)
+        {
+            blockBits = _mm512_cmp_epi64_mask(_mm512_loadu_si512(address), _mm512_set1_epi64(constant), INTEGER_PREDICATE<Comparison>);
+        }
+        else
+        {
+            blockBits = _mm512_cmp_epu64_mask(
+                _mm512_loadu_si512(address), _mm512_set1_epi64(static_cast<int64_t>(constant)), INTEGER_PREDICATE<Comparison>);
+        }
+        bits |= blockBits << (block * lanes);
+    }
+    return bits;
+}
+
+template <typename T, typename C, BatchComparison Comparison, bool IsFirstFilter>
+__attribute__((target("avx2"))) void
+avx2ComparisonKernel(int8_t* fieldAddress, uint64_t, const uint64_t begin, const uint64_t size, int8_t* mask, const C constant)
+{
+    const int8_t* values = fieldAddress + (begin * sizeof(T));
+    const auto typedConstant = static_cast<T>(constant);
+    uint64_t index = 0;
+    for (; index + SIMD_BLOCK_SIZE <= size; index += SIMD_BLOCK_SIZE)
+    {
+        storeBlockMask<IsFirstFilter>(mask + index, compareBlockAvx2<T, Comparison>(values + (index * sizeof(T)), typedConstant));
+    }
+    evaluateTail<T, Comparison, IsFirstFilter>(values, index, size, mask, typedConstant);
+}
+
+template <typename T, typename C, BatchComparison Comparison, bool IsFirstFilter>
+__attribute__((target("avx512f"))) void
+avx512ComparisonKernel(int8_t* fieldAddress, uint64_t, const uint64_t begin, const uint64_t size, int8_t* mask, const C constant)
+{
+    const int8_t* values = fieldAddress + (begin * sizeof(T));
+    const auto typedConstant = static_cast<T>(constant);
+    uint64_t index = 0;
+    for (; index + SIMD_BLOCK_SIZE <= size; index += SIMD_BLOCK_SIZE)
+    {
+        storeBlockMask<IsFirstFilter>(mask + index, compareBlockAvx512<T, Comparison>(values + (index * sizeof(T)), typedConstant));
+    }
+    evaluateTail<T, Comparison, IsFirstFilter>(values, index, size, mask, typedConstant);
+}
+#endif
+
+#if defined(__aarch64__)
+/// NEON provides type specific intrinsics only, thus we wrap the ones we need for each type
+template <typename T>
+struct Neon;
+
+template <>
+struct Neon<int32_t>
+{
+    static int32x4_t load(const int8_t* address) { return vld1q_s32(reinterpret_cast<const int32_t*>(address)); } /// NOLINT
+    static int32x4_t broadcast(int32_t value) { return vdupq_n_s32(value); }
+    static uint32x4_t equals(int32x4_t left, int32x4_t right) { return vceqq_s32(left, right); }
+    static uint32x4_t less(int32x4_t left, int32x4_t right) { return vcltq_s32(left, right); }
+    static uint32x4_t lessEquals(int32x4_t left, int32x4_t right) { return vcleq_s32(left, right); }
+};
+
+template <>
+struct Neon<uint32_t>
+{
+    static uint32x4_t load(const int8_t* address) { return vld1q_u32(reinterpret_cast<const uint32_t*>(address)); } /// NOLINT
+    static uint32x4_t broadcast(uint32_t value) { return vdupq_n_u32(value); }
+    static uint32x4_t equals(uint32x4_t left, uint32x4_t right) { return vceqq_u32(left, right); }
+    static uint32x4_t less(uint32x4_t left, uint32x4_t right) { return vcltq_u32(left, right); }
+    static uint32x4_t lessEquals(uint32x4_t left, uint32x4_t right) { return vcleq_u32(left, right); }
+};
+
+template <>
+struct Neon<float>
+{
+    static float32x4_t load(const int8_t* address) { return vld1q_f32(reinterpret_cast<const float*>(address)); } /// NOLINT
+    static float32x4_t broadcast(float value) { return vdupq_n_f32(value); }
+    static uint32x4_t equals(float32x4_t left, float32x4_t right) { return vceqq_f32(left, right); }
+    static uint32x4_t less(float32x4_t left, float32x4_t right) { return vcltq_f32(left, right); }
+    static uint32x4_t lessEquals(float32x4_t left, float32x4_t right) { return vcleq_f32(left, right); }
+};
+
+template <>
+struct Neon<int64_t>
+{
+    static int64x2_t load(const int8_t* address) { return vld1q_s64(reinterpret_cast<const int64_t*>(address)); } /// NOLINT
+    static int64x2_t broadcast(int64_t value) { return vdupq_n_s64(value); }
+    static uint64x2_t equals(int64x2_t left, int64x2_t right) { return vceqq_s64(left, right); }
+    static uint64x2_t less(int64x2_t left, int64x2_t right) { return vcltq_s64(left, right); }
+    static uint64x2_t lessEquals(int64x2_t left, int64x2_t right) { return vcleq_s64(left, right); }
+};
+
+template <>
+struct Neon<uint64_t>
+{
+    static uint64x2_t load(const int8_t* address) { return vld1q_u64(reinterpret_cast<const uint64_t*>(address)); } /// NOLINT
+    static uint64x2_t broadcast(uint64_t value) { return vdupq_n_u64(value); }
+    static uint64x2_t equals(uint64x2_t left, uint64x2_t right) { return vceqq_u64(left, right); }
+    static uint64x2_t less(uint64x2_t left, uint64x2_t right) { return vcltq_u64(left, right); }
+    static uint64x2_t lessEquals(uint64x2_t left, uint64x2_t right) { return vcleq_u64(left, right); }
+};
+
+template <>
+struct Neon<double>
+{
+    static float64x2_t load(const int8_t* address) { return vld1q_f64(reinterpret_cast<const double*>(address)); } /// NOLINT
+    static float64x2_t broadcast(double value) { return vdupq_n_f64(value); }
+    static uint64x2_t equals(float64x2_t left, float64x2_t right) { return vceqq_f64(left, right); }
+    static uint64x2_t less(float64x2_t left, float64x2_t right) { return vcltq_f64(left, right); }
+    static uint64x2_t lessEquals(float64x2_t left, float64x2_t right) { return vcleq_f64(left, right); }
+};
+
+template <typename T, BatchComparison Comparison, typename Vector>
+inline auto compareNeon(const Vector value, const Vector constant)
+{
+    if constexpr (Comparison == BatchComparison::EQUALS)
+    {
+        return Neon<T>::equals(value, constant);
+    }
+    else if constexpr (Comparison == BatchComparison::LESS)
+    {
+        return Neon<T>::less(value, constant);
+    }
+    else if constexpr (Comparison == BatchComparison::LESS_EQUALS)
+    {
+        return Neon<T>::lessEquals(value, constant);
+    }
+    else if constexpr (Comparison == BatchComparison::GREATER)
+    {
+        return Neon<T>::less(constant, value);
+    }
+    else
+    {
+        return Neon<T>::lessEquals(constant, value);
+    }
+}
+
+template <typename T, BatchComparison Comparison>
+inline uint32_t compareBlockNeon(const int8_t* values, const T constant)
+{
+    constexpr size_t lanes = 16 / sizeof(T);
+    const auto broadcast = Neon<T>::broadcast(constant);
+    uint32_t bits = 0;
+    for (size_t block = 0; block < SIMD_BLOCK_SIZE / lanes; ++block)
+    {
+        const auto result = compareNeon<T, Comparison>(Neon<T>::load(values + (block * 16)), broadcast);
+        uint32_t blockBits = 0;
+        /// Every lane of the result is either all zeros or all ones, thus masking each lane with its bit and adding them yields the bitmask
+        if constexpr (lanes == 4)
+        {
+            constexpr std::array<uint32_t, 4> laneBits{1, 2, 4, 8};
+            blockBits = vaddvq_u32(vandq_u32(result, vld1q_u32(laneBits.data())));
+        }
+        else
+        {
+            constexpr std::array<uint64_t, 2> laneBits{1, 2};
+            blockBits = static_cast<uint32_t>(vaddvq_u64(vandq_u64(result, vld1q_u64(laneBits.data()))));
+        }
+        bits |= blockBits << (block * lanes);
+    }
+    return bits;
+}
+
+template <typename T, typename C, BatchComparison Comparison, bool IsFirstFilter>
+void neonComparisonKernel(int8_t* fieldAddress, uint64_t, const uint64_t begin, const uint64_t size, int8_t* mask, const C constant)
+{
+    const int8_t* values = fieldAddress + (begin * sizeof(T));
+    const auto typedConstant = static_cast<T>(constant);
+    uint64_t index = 0;
+    for (; index + SIMD_BLOCK_SIZE <= size; index += SIMD_BLOCK_SIZE)
+    {
+        storeBlockMask<IsFirstFilter>(mask + index, compareBlockNeon<T, Comparison>(values + (index * sizeof(T)), typedConstant));
+    }
+    evaluateTail<T, Comparison, IsFirstFilter>(values, index, size, mask, typedConstant);
+}
+#endif
+
+SimdInstructionSet detectSimdInstructionSet()
+{
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return SimdInstructionSet::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return SimdInstructionSet::AVX2;
+    }
+    return SimdInstructionSet::NONE;
+#elif defined(__aarch64__)
+    /// NEON is part of the armv8-a baseline
+    return SimdInstructionSet::NEON;
+#else
+    return SimdInstructionSet::NONE;
+#endif
+}
+
+template <typename T, typename C, BatchComparison Comparison, bool IsFirstFilter>
+BatchComparisonKernel<C> getKernelForInstructionSet(const SimdInstructionSet instructionSet)
+{
+#if defined(__x86_64__)
+    if (instructionSet == SimdInstructionSet::AVX512)
+    {
+        return &avx512ComparisonKernel<T, C, Comparison, IsFirstFilter>;
+    }
+    if (instructionSet == SimdInstructionSet::AVX2)
+    {
+        return &avx2ComparisonKernel<T, C, Comparison, IsFirstFilter>;
+    }
+#elif defined(__aarch64__)
+    if (instructionSet == SimdInstructionSet::NEON)
+    {
+        return &neonComparisonKernel<T, C, Comparison, IsFirstFilter>;
+    }
+#endif
+    return nullptr;
+}
+
+template <typename T, typename C, BatchComparison Comparison>
+BatchComparisonKernel<C> getKernelForComparison(const bool isFirstFilter, const SimdInstructionSet instructionSet)
+{
+    return isFirstFilter ? getKernelForInstructionSet<T, C, Comparison, true>(instructionSet)
+                         : getKernelForInstructionSet<T, C, Comparison, false>(instructionSet);
+}
+}
+
+SimdInstructionSet getSimdInstructionSet()
+{
+    static const SimdInstructionSet instructionSet = []
+    {
+        const auto detected = detectSimdInstructionSet();
+        NES_DEBUG("Using {} batch comparison kernels", magic_enum::enum_name(detected));
+        return detected;
+    }();
+    return instructionSet;
+}
+
+template <typename T, typename C>
+BatchComparisonKernel<C> getSimdComparisonKernel(const BatchComparison comparison, const bool isFirstFilter)
+{
+    if constexpr (not HAS_SIMD_KERNEL<T>)
+    {
+        return nullptr;
+    }
+    else
+    {
+        const auto instructionSet = getSimdInstructionSet();
+        switch (comparison)
+        {
+            case BatchComparison::EQUALS:
+                return getKernelForComparison<T, C, BatchComparison::EQUALS>(isFirstFilter, instructionSet);
+            case BatchComparison::LESS:
+                return getKernelForComparison<T, C, BatchComparison::LESS>(isFirstFilter, instructionSet);
+            case BatchComparison::LESS_EQUALS:
+                return getKernelForComparison<T, C, BatchComparison::LESS_EQUALS>(isFirstFilter, instructionSet);
+            case BatchComparison::GREATER:
+                return getKernelForComparison<T, C, BatchComparison::GREATER>(isFirstFilter, instructionSet);
+            case BatchComparison::GREATER_EQUALS:
+                return getKernelForComparison<T, C, BatchComparison::GREATER_EQUALS>(isFirstFilter, instructionSet);
+        }
+        std::unreachable();
+    }
+}
+
+template BatchComparisonKernel<int64_t> getSimdComparisonKernel<int8_t, int64_t>(BatchComparison, bool);
+template BatchComparisonKernel<int64_t> getSimdComparisonKernel<int16_t, int64_t>(BatchComparison, bool);
+template BatchComparisonKernel<int64_t> getSimdComparisonKernel<int32_t, int64_t>(BatchComparison, bool);
+template BatchComparisonKernel<int64_t> getSimdComparisonKernel<int64_t, int64_t>(BatchComparison, bool);
+template BatchComparisonKernel<uint64_t> getSimdComparisonKernel<uint8_t, uint64_t>(BatchComparison, bool);
+template BatchComparisonKernel<uint64_t> getSimdComparisonKernel<uint16_t, uint64_t>(BatchComparison, bool);
+template BatchComparisonKernel<uint64_t> getSimdComparisonKernel<uint32_t, uint64_t>(BatchComparison, bool);
+template BatchComparisonKernel<uint64_t> getSimdComparisonKernel<uint64_t, uint64_t>(BatchComparison, bool);
+template BatchComparisonKernel<double> getSimdComparisonKernel<float, double>(BatchComparison, bool);
+template BatchComparisonKernel<double> getSimdComparisonKernel<double, double>(BatchComparison, bool);
+
+}
@@ -0,0 +1,178 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Functions/StringMatchPhysicalFunction.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <Functions/PhysicalFunction.hpp>
+#include <Functions/StringMatchLogicalFunction.hpp>
+#include <Functions/StringSearch.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/DataTypes/VariableSizedData.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <nautilus/function.hpp>
+#include <nautilus/std/cstring.h>
+#include <Arena.hpp>
+#include <ErrorHandling.hpp>
+#include <ExecutionContext.hpp>
+#include <PhysicalFunctionRegistry.hpp>
+#include <val.hpp>
+#include <val_bool.hpp>
+
+namespace NES
+{
+
+namespace
+{
+bool matchCompiledPatternProxy(const LikePattern* pattern, const int8_t* content, const uint64_t size)
+{
+    INVARIANT(pattern != nullptr, "LikePattern MUST NOT be null at this point");
+    return pattern->matches(std::string_view{reinterpret_cast<const char*>(content), size});
+}
+
+bool matchPatternProxy(
+    const uint8_t kind, const int8_t* content, const uint64_t size, const int8_t* patternContent, const uint64_t patternSize)
+{
+    const std::string_view patternBytes{reinterpret_cast<const char*>(patternContent), patternSize};
+    const auto pattern = LikePattern::compile(static_cast<StringMatchKind>(kind), patternBytes);
+    return pattern.matches(std::string_view{reinterpret_cast<const char*>(content), size});
+}
+}
+
+StringMatchPhysicalFunction::StringMatchPhysicalFunction(
+    const StringMatchKind kind, PhysicalFunction valuePhysicalFunction, const std::string_view constantPattern)
+    : kind(kind)
+    , valuePhysicalFunction(std::move(valuePhysicalFunction))
+    , constantPattern(std::make_shared<const LikePattern>(LikePattern::compile(kind, constantPattern)))
+{
+}
+
+StringMatchPhysicalFunction::StringMatchPhysicalFunction(
+    const StringMatchKind kind, PhysicalFunction valuePhysicalFunction, PhysicalFunction patternPhysicalFunction)
+    : kind(kind), valuePhysicalFunction(std::move(valuePhysicalFunction)), patternPhysicalFunction(std::move(patternPhysicalFunction))
+{
+}
+
+nautilus::val<bool> StringMatchPhysicalFunction::matchConstantPattern(const VariableSizedData& value) const
+{
+    /// NOLINTBEGIN(cppcoreguidelines-pro-type-const-cast) - VariableSizedData requires non-const pointer but data is not modified
+    const auto& literal = constantPattern->getLiteral();
+    const auto* literalBytes = reinterpret_cast<const int8_t*>(literal.data());
+    const nautilus::val<uint64_t> literalSize{literal.size()};
+    const nautilus::val<int8_t*> literalContent{const_cast<int8_t*>(literalBytes)};
+    /// NOLINTEND(cppcoreguidelines-pro-type-const-cast)
+
+    const auto shape = constantPattern->getShape();
+    switch (shape)
+    {
+        case LikePattern::Shape::EQUALS: {
+            const nautilus::val<uint32_t> prefix{VariableSizedData::computePrefix(literalBytes, literal.size())};
+            return value == VariableSizedData(literalContent, literalSize, prefix);
+        }
+        case LikePattern::Shape::STARTS_WITH:
+        case LikePattern::Shape::ENDS_WITH: {
+            if (literal.empty())
+            {
+                return {true};
+            }
+            nautilus::val<bool> matches{false};
+            if (value.getSize() >= literalSize)
+            {
+                const auto start
+                    = shape == LikePattern::Shape::STARTS_WITH ? value.getContent() : value.getContent() + (value.getSize() - literalSize);
+                matches = nautilus::memcmp(start, literalContent, literalSize) == 0;
+            }
+            return matches;
+        }
+        case LikePattern::Shape::CONTAINS:
+        case LikePattern::Shape::GENERAL: {
+            if (shape == LikePattern::Shape::CONTAINS and literal.empty())
+            {
+                return {true};
+            }
+            return nautilus::invoke(
+                matchCompiledPatternProxy, nautilus::val<const LikePattern*>(constantPattern.get()), value.getContent(), value.getSize());
+        }
+    }
+    std::unreachable();
+}
+
+VarVal StringMatchPhysicalFunction::execute(const Record& record, ArenaRef& arena) const
+{
+    const auto value = valuePhysicalFunction.execute(record, arena);
+    const auto valueData = value.getRawValueAs<VariableSizedData>();
+    if (not patternPhysicalFunction.has_value())
+    {
+        if (value.isNullable() and value.isNull())
+        {
+            return VarVal{nautilus::val<bool>{false}, true, nautilus::val<bool>{true}};
+        }
+        return VarVal{matchConstantPattern(valueData), value.isNullable(), nautilus::val<bool>{false}};
+    }
+
+    const auto pattern = patternPhysicalFunction->execute(record, arena);
+    const auto nullable = value.isNullable() or pattern.isNullable();
+    const auto null = nullable and (value.isNull() or pattern.isNull());
+    if (null)
+    {
+        return VarVal{nautilus::val<bool>{false}, nullable, null};
+    }
+    const auto patternData = pattern.getRawValueAs<VariableSizedData>();
+    const auto matches = nautilus::invoke(
+        matchPatternProxy,
+        nautilus::val<uint8_t>{static_cast<uint8_t>(kind)},
+        valueData.getContent(),
+        valueData.getSize(),
+        patternData.getContent(),
+        patternData.getSize());
+    return VarVal{matches, nullable, null};
+}
+
+namespace
+{
+StringMatchPhysicalFunction createStringMatchFunction(const StringMatchKind kind, const PhysicalFunctionRegistryArguments& arguments)
+{
+    PRECONDITION(arguments.childFunctions.size() == 2, "String match function must have exactly two child functions");
+    return {kind, arguments.childFunctions[0], arguments.childFunctions[1]};
+}
+}
+
+PhysicalFunctionRegistryReturnType
+PhysicalFunctionGeneratedRegistrar::RegisterLikePhysicalFunction(PhysicalFunctionRegistryArguments arguments)
+{
+    return createStringMatchFunction(StringMatchKind::LIKE, arguments);
+}
+
+PhysicalFunctionRegistryReturnType
+PhysicalFunctionGeneratedRegistrar::RegisterStartsWithPhysicalFunction(PhysicalFunctionRegistryArguments arguments)
+{
+    return createStringMatchFunction(StringMatchKind::STARTS_WITH, arguments);
+}
+
+PhysicalFunctionRegistryReturnType
+PhysicalFunctionGeneratedRegistrar::RegisterEndsWithPhysicalFunction(PhysicalFunctionRegistryArguments arguments)
+{
+    return createStringMatchFunction(StringMatchKind::ENDS_WITH, arguments);
+}
+
+PhysicalFunctionRegistryReturnType
+PhysicalFunctionGeneratedRegistrar::RegisterContainsPhysicalFunction(PhysicalFunctionRegistryArguments arguments)
+{
+    return createStringMatchFunction(StringMatchKind::CONTAINS, arguments);
+}
+
+}
@@ -0,0 +1,298 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Functions/StringSearch.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <Functions/StringMatchLogicalFunction.hpp>
+#include <ErrorHandling.hpp>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#elif defined(__aarch64__)
+    #include <arm_neon.h>
+#endif
+
+namespace NES
+{
+
+namespace
+{
+constexpr size_t SEARCH_BLOCK_SIZE = 16;
+
+/// Returns one bit per position of the block at which the first byte of the needle matches at `block` and the last byte matches at
+/// `block + needleSize - 1`. On NEON, every position occupies four bits.
+#if defined(__SSE2__)
+constexpr size_t BITS_PER_POSITION = 1;
+
+inline uint64_t matchFirstAndLastByte(const char* block, const size_t needleSize, const char first, const char last)
+{
+    const auto firstBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+    const auto lastBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + needleSize - 1));
+    const auto matches = _mm_and_si128(_mm_cmpeq_epi8(firstBytes, _mm_set1_epi8(first)), _mm_cmpeq_epi8(lastBytes, _mm_set1_epi8(last)));
+    return static_cast<uint32_t>(_mm_movemask_epi8(matches));
+}
+#elif defined(__aarch64__)
+constexpr size_t BITS_PER_POSITION = 4;
+
+inline uint64_t matchFirstAndLastByte(const char* block, const size_t needleSize, const char first, const char last)
+{
+    const auto firstBytes = vld1q_u8(reinterpret_cast<const uint8_t*>(block));
+    const auto lastBytes = vld1q_u8(reinterpret_cast<const uint8_t*>(block + needleSize - 1));
+    const auto matches = vandq_u8(
+        vceqq_u8(firstBytes, vdupq_n_u8(static_cast<uint8_t>(first))), vceqq_u8(lastBytes, vdupq_n_u8(static_cast<uint8_t>(last))));
+    /// Narrowing every 16-bit lane by four bits keeps four bits of every byte, as NEON has no movemask
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)), 0);
+}
+#endif
+}
+
+SubstringSearcher::SubstringSearcher(std::string needle) : needle(std::move(needle))
+{
+}
+
+size_t SubstringSearcher::find(const std::string_view haystack, size_t from) const
+{
+    const auto needleSize = needle.size();
+    if (from > haystack.size() or haystack.size() - from < needleSize)
+    {
+        return std::string_view::npos;
+    }
+    if (needleSize == 0)
+    {
+        return from;
+    }
+    if (needleSize == 1)
+    {
+        const auto* match = static_cast<const char*>(std::memchr(haystack.data() + from, needle[0], haystack.size() - from));
+        return match == nullptr ? std::string_view::npos : static_cast<size_t>(match - haystack.data());
+    }
+
+    const char first = needle.front();
+    const char last = needle.back();
+    /// The first and the last byte are already compared
+    const auto compareMiddle = [&](const size_t position)
+    { return std::memcmp(haystack.data() + position + 1, needle.data() + 1, needleSize - 2) == 0; };
+#if defined(__SSE2__) || defined(__aarch64__)
+    for (; from + needleSize - 1 + SEARCH_BLOCK_SIZE <= haystack.size(); from += SEARCH_BLOCK_SIZE)
+    {
+        auto matches = matchFirstAndLastByte(haystack.data() + from, needleSize, first, last);
+        while (matches != 0)
+        {
+            const auto position = from + (std::countr_zero(matches) / BITS_PER_POSITION);
+            if (compareMiddle(position))
+            {
+                return position;
+            }
+            /// Clearing all bits of the position
+            matches &= ~(((uint64_t{1} << BITS_PER_POSITION) - 1) << ((position - from) * BITS_PER_POSITION));
+        }
+    }
+#endif
+    for (; from + needleSize <= haystack.size(); ++from)
+    {
+        if (haystack[from] == first and haystack[from + needleSize - 1] == last and compareMiddle(from))
+        {
+            return from;
+        }
+    }
+    return std::string_view::npos;
+}
+
+bool LikePattern::Segment::matchesAt(const std::string_view value, const size_t position) const
+{
+    if (position > value.size() or value.size() - position < bytes.size())
+    {
+        return false;
+    }
+    if (isWildcard.empty())
+    {
+        return std::memcmp(value.data() + position, bytes.data(), bytes.size()) == 0;
+    }
+    for (size_t i = 0; i < bytes.size(); ++i)
+    {
+        if (not isWildcard[i] and value[position + i] != bytes[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t LikePattern::Segment::find(const std::string_view value, const size_t from) const
+{
+    if (searcher.has_value())
+    {
+        return searcher->find(value, from);
+    }
+    for (size_t position = from; position + bytes.size() <= value.size(); ++position)
+    {
+        if (matchesAt(value, position))
+        {
+            return position;
+        }
+    }
+    return std::string_view::npos;
+}
+
+LikePattern::LikePattern(std::vector<Segment> segments, const bool anchoredAtStart, const bool anchoredAtEnd)
+    : segments(std::move(segments)), anchoredAtStart(anchoredAtStart), anchoredAtEnd(anchoredAtEnd), shape(Shape::GENERAL)
+{
+    if (this->segments.size() > 1 or (this->segments.size() == 1 and not this->segments.front().isWildcard.empty()))
+    {
+        return;
+    }
+    if (not this->segments.empty())
+    {
+        literal = this->segments.front().bytes;
+    }
+    if (anchoredAtStart)
+    {
+        shape = anchoredAtEnd ? Shape::EQUALS : Shape::STARTS_WITH;
+    }
+    else
+    {
+        shape = anchoredAtEnd ? Shape::ENDS_WITH : Shape::CONTAINS;
+    }
+}
+
+LikePattern LikePattern::compile(const std::string_view pattern)
+{
+    std::vector<Segment> segments;
+    Segment segment;
+    const auto finishSegment = [&]
+    {
+        /// Consecutive `%` create empty segments, which match everywhere
+        if (not segment.bytes.empty())
+        {
+            if (segment.isWildcard.empty())
+            {
+                segment.searcher.emplace(segment.bytes);
+            }
+            segments.push_back(std::move(segment));
+        }
+        segment = Segment{};
+    };
+    const auto appendByte = [&](const char byte, const bool isWildcard)
+    {
+        /// Segments only track the wildcard positions once they contain a wildcard
+        if (isWildcard or not segment.isWildcard.empty())
+        {
+            segment.isWildcard.resize(segment.bytes.size(), false);
+            segment.isWildcard.push_back(isWildcard);
+        }
+        segment.bytes.push_back(byte);
+    };
+
+    bool endsWithPercent = false;
+    for (size_t i = 0; i < pattern.size(); ++i)
+    {
+        endsWithPercent = false;
+        if (pattern[i] == '\\' and i + 1 < pattern.size())
+        {
+            appendByte(pattern[++i], false);
+        }
+        else if (pattern[i] == '%')
+        {
+            finishSegment();
+            endsWithPercent = true;
+        }
+        else
+        {
+            appendByte(pattern[i], pattern[i] == '_');
+        }
+    }
+    finishSegment();
+    return LikePattern{std::move(segments), not pattern.starts_with('%'), not endsWithPercent};
+}
+
+LikePattern LikePattern::compile(const StringMatchKind kind, const std::string_view pattern)
+{
+    PRECONDITION(kind != StringMatchKind::REGEXP_MATCH, "Regular expressions are compiled into a RegularExpression");
+    if (kind == StringMatchKind::LIKE)
+    {
+        return compile(pattern);
+    }
+    std::vector<Segment> segments;
+    if (not pattern.empty())
+    {
+        segments.push_back(Segment{.bytes = std::string(pattern), .isWildcard = {}, .searcher = SubstringSearcher(std::string(pattern))});
+    }
+    return LikePattern{
+        std::move(segments),
+        kind == StringMatchKind::STARTS_WITH,
+        kind == StringMatchKind::ENDS_WITH,
+    };
+}
+
+bool LikePattern::matches(const std::string_view value) const
+{
+    if (segments.empty())
+    {
+        /// Only the empty pattern is anchored at both ends without a segment
+        return not(anchoredAtStart and anchoredAtEnd) or value.empty();
+    }
+
+    /// Matching every segment at its leftmost position leaves the most bytes for the following segments
+    size_t position = 0;
+    for (size_t i = 0; i < segments.size(); ++i)
+    {
+        const auto& segment = segments[i];
+        const bool isLast = i == segments.size() - 1;
+        if (isLast and anchoredAtEnd)
+        {
+            if (value.size() < position + segment.bytes.size() or (i == 0 and anchoredAtStart and value.size() != segment.bytes.size()))
+            {
+                return false;
+            }
+            return segment.matchesAt(value, value.size() - segment.bytes.size());
+        }
+        if (i == 0 and anchoredAtStart)
+        {
+            if (not segment.matchesAt(value, 0))
+            {
+                return false;
+            }
+            position = segment.bytes.size();
+            continue;
+        }
+        const auto match = segment.find(value, position);
+        if (match == std::string_view::npos)
+        {
+            return false;
+        }
+        position = match + segment.bytes.size();
+    }
+    return true;
+}
+
+LikePattern::Shape LikePattern::getShape() const
+{
+    return shape;
+}
+
+const std::string& LikePattern::getLiteral() const
+{
+    return literal;
+}
+
+}
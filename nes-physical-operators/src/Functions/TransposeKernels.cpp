@@ -0,0 +1,237 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Functions/TransposeKernels.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <ranges>
+#include <utility>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/SimdBatchKernels.hpp>
+#include <Runtime/ColumnarLayout.hpp>
+#include <ErrorHandling.hpp>
+#include <function.hpp>
+#include <val.hpp>
+#include <val_ptr.hpp>
+
+#if defined(__x86_64__)
+    #include <immintrin.h>
+#endif
+
+namespace NES
+{
+
+namespace
+{
+/// Signature of all value kernels. The i-th value is copied from `source + (i * sourceStride)` to `destination + (i * destinationStride)`.
+using TransposeKernel = void (*)(int8_t* source, uint64_t sourceStride, uint64_t size, int8_t* destination, uint64_t destinationStride);
+
+/// The copy has a constant size, thus the host compiler turns the memcpy into a single load and store
+template <size_t Size>
+void copyValues(int8_t* source, const uint64_t sourceStride, const uint64_t size, int8_t* destination, const uint64_t destinationStride)
+{
+    for (uint64_t i = 0; i < size; ++i)
+    {
+        std::memcpy(destination + (i * destinationStride), source + (i * sourceStride), Size);
+    }
+}
+
+#if defined(__x86_64__)
+/// Gathers the strided values of a row layout into a contiguous column, i.e., the destination stride is the size of the value.
+/// Every gather loads the values of 8 (32 bit) or 4 (64 bit) tuples.
+template <size_t Size>
+__attribute__((target("avx2"))) void
+gatherValuesAvx2(int8_t* source, const uint64_t sourceStride, const uint64_t size, int8_t* destination, const uint64_t destinationStride)
+{
+    constexpr size_t lanes = sizeof(__m256i) / Size;
+    const auto stride = static_cast<int32_t>(sourceStride);
+    uint64_t index = 0;
+    for (; index + lanes <= size; index += lanes)
+    {
+        const auto* base = source + (index * sourceStride);
+        if constexpr (Size == 4)
+        {
+            const auto offsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(stride));
+            const auto values = _mm256_i32gather_epi32(reinterpret_cast<const int*>(base), offsets, 1); /// NOLINT
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + (index * Size)), values); /// NOLINT
+        }
+        else
+        {
+            const auto offsets = _mm_mullo_epi32(_mm_setr_epi32(0, 1, 2, 3), _mm_set1_epi32(stride));
+            const auto values = _mm256_i32gather_epi64(reinterpret_cast<const long long*>(base), offsets, 1); /// NOLINT
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + (index * Size)), values); /// NOLINT
+        }
+    }
+    copyValues<Size>(
+        source + (index * sourceStride), sourceStride, size - index, destination + (index * destinationStride), destinationStride);
+}
+#endif
+
+/// Returns the kernel for values of the given size. Gathering kernels require a contiguous destination.
+TransposeKernel getTransposeKernel(const uint64_t valueSize, [[maybe_unused]] const bool isGather)
+{
+    [[maybe_unused]] const auto instructionSet = getSimdInstructionSet();
+    [[maybe_unused]] const bool useAvx2 = instructionSet == SimdInstructionSet::AVX2 or instructionSet == SimdInstructionSet::AVX512;
+    switch (valueSize)
+    {
+        case 1:
+            return &copyValues<1>;
+        case 2:
+            return &copyValues<2>;
+        case 4:
+#if defined(__x86_64__)
+            if (isGather and useAvx2)
+            {
+                return &gatherValuesAvx2<4>;
+            }
+#endif
+            return &copyValues<4>;
+        case 8:
+#if defined(__x86_64__)
+            if (isGather and useAvx2)
+            {
+                return &gatherValuesAvx2<8>;
+            }
+#endif
+            return &copyValues<8>;
+        default:
+            break;
+    }
+    INVARIANT(false, "There is no transpose kernel for values of {}B", valueSize);
+    std::unreachable();
+}
+
+/// Writes the validity words of the tuples [0, size) of a column from the null bytes of the rows
+void nullBytesToValidity(int8_t* nullBytes, const uint64_t stride, const uint64_t size, int8_t* validity)
+{
+    for (uint64_t first = 0; first < size; first += ColumnarLayout::BITS_PER_VALIDITY_WORD)
+    {
+        const auto tuples = std::min(ColumnarLayout::BITS_PER_VALIDITY_WORD, size - first);
+        uint64_t word = 0;
+        for (uint64_t bit = 0; bit < tuples; ++bit)
+        {
+            word |= static_cast<uint64_t>(nullBytes[(first + bit) * stride] == 0) << bit;
+        }
+        std::memcpy(validity + (first / ColumnarLayout::BITS_PER_VALIDITY_WORD * sizeof(word)), &word, sizeof(word));
+    }
+}
+
+/// Writes the null bytes of the rows from the validity bits of the tuples [begin, begin + size) of a column
+void validityToNullBytes(int8_t* validity, const uint64_t begin, const uint64_t size, int8_t* nullBytes, const uint64_t stride)
+{
+    const auto* validityBitmap = reinterpret_cast<const std::byte*>(validity); /// NOLINT
+    for (uint64_t i = 0; i < size; ++i)
+    {
+        nullBytes[i * stride] = static_cast<int8_t>(not ColumnarLayout::isValid(validityBitmap, begin + i));
+    }
+}
+}
+
+std::optional<std::vector<TransposedField>> getTransposedFields(const Schema& schema, const uint64_t columnarBufferSize)
+{
+    const auto layout = ColumnarLayout::create(schema, columnarBufferSize);
+    std::vector<TransposedField> fields;
+    fields.reserve(layout.columns.size());
+    uint64_t rowOffset = 0;
+    for (const auto& [field, column] : std::views::zip(schema, layout.columns))
+    {
+        if (field.dataType.isType(DataType::Type::VARSIZED) or not std::has_single_bit(column.valueSize)
+            or column.valueSize > sizeof(uint64_t))
+        {
+            return std::nullopt;
+        }
+        fields.push_back(
+            {.valueSize = column.valueSize,
+             .rowOffset = rowOffset,
+             .columnOffset = column.valueOffset,
+             .validityOffset = column.validityOffset});
+        rowOffset += field.dataType.getSizeInBytesWithNull();
+    }
+    return fields;
+}
+
+void transposeRowsToColumns(
+    const std::vector<TransposedField>& fields,
+    const uint64_t rowTupleSize,
+    const nautilus::val<int8_t*>& rows,
+    const nautilus::val<uint64_t>& begin,
+    const nautilus::val<uint64_t>& size,
+    const nautilus::val<int8_t*>& columns)
+{
+    /// The kernels are chosen while tracing, thus the traced code contains one call per field
+    const auto firstRow = rows + (begin * nautilus::val<uint64_t>(rowTupleSize));
+    for (const auto& field : fields)
+    {
+        auto valueOffset = field.rowOffset;
+        if (field.validityOffset.has_value())
+        {
+            nautilus::invoke(
+                &nullBytesToValidity,
+                firstRow + nautilus::val<uint64_t>(field.rowOffset),
+                nautilus::val<uint64_t>(rowTupleSize),
+                size,
+                columns + nautilus::val<uint64_t>(field.validityOffset.value()));
+            ++valueOffset;
+        }
+        nautilus::invoke(
+            getTransposeKernel(field.valueSize, true),
+            firstRow + nautilus::val<uint64_t>(valueOffset),
+            nautilus::val<uint64_t>(rowTupleSize),
+            size,
+            columns + nautilus::val<uint64_t>(field.columnOffset),
+            nautilus::val<uint64_t>(field.valueSize));
+    }
+}
+
+void transposeColumnsToRows(
+    const std::vector<TransposedField>& fields,
+    const uint64_t rowTupleSize,
+    const nautilus::val<int8_t*>& columns,
+    const nautilus::val<uint64_t>& begin,
+    const nautilus::val<uint64_t>& size,
+    const nautilus::val<int8_t*>& rows)
+{
+    for (const auto& field : fields)
+    {
+        auto valueOffset = field.rowOffset;
+        if (field.validityOffset.has_value())
+        {
+            nautilus::invoke(
+                &validityToNullBytes,
+                columns + nautilus::val<uint64_t>(field.validityOffset.value()),
+                begin,
+                size,
+                rows + nautilus::val<uint64_t>(field.rowOffset),
+                nautilus::val<uint64_t>(rowTupleSize));
+            ++valueOffset;
+        }
+        const auto firstValue = columns + nautilus::val<uint64_t>(field.columnOffset) + (begin * nautilus::val<uint64_t>(field.valueSize));
+        nautilus::invoke(
+            getTransposeKernel(field.valueSize, false),
+            firstValue,
+            nautilus::val<uint64_t>(field.valueSize),
+            size,
+            rows + nautilus::val<uint64_t>(valueOffset),
+            nautilus::val<uint64_t>(rowTupleSize));
+    }
+}
+
+}
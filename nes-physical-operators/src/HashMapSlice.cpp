@@ -24,7 +24,11 @@
 #include <Identifiers/Identifiers.hpp>
 #include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMap.hpp>
 #include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Nautilus/Interface/HashMap/SwissHashMap/SwissHashMap.hpp>
 #include <SliceStore/Slice.hpp>
+#include <Util/HashMapType.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/RollingAverage.hpp>
 #include <ErrorHandling.hpp>
 
 namespace NES
@@ -34,14 +38,17 @@ HashMapSlice::HashMapSlice(
     const SliceStart sliceStart,
     const SliceEnd sliceEnd,
     const CreateNewHashMapSliceArgs& createNewHashMapSliceArgs,
-    const uint64_t numberOfHashMaps,
-    const uint64_t numberOfInputStreams)
+    const uint64_t numberOfWorkerThreads,
+    const uint64_t numberOfInputStreams,
+    const uint64_t numberOfPartitions)
     : Slice(sliceStart, sliceEnd)
     , createNewHashMapSliceArgs(createNewHashMapSliceArgs)
-    , numberOfHashMapsPerInputStream(numberOfHashMaps)
+    , numberOfHashMapsPerInputStream(numberOfWorkerThreads * numberOfPartitions)
     , numberOfInputStreams(numberOfInputStreams)
+    , numberOfPartitions(numberOfPartitions)
 {
-    for (uint64_t i = 0; i < numberOfHashMaps * numberOfInputStreams; i++)
+    PRECONDITION(numberOfPartitions > 0, "A hash map slice requires at least one partition");
+    for (uint64_t i = 0; i < numberOfHashMapsPerInputStream * numberOfInputStreams; i++)
     {
         hashMaps.emplace_back(nullptr);
     }
@@ -53,16 +60,26 @@ HashMapSlice::~HashMapSlice()
 
     /// As we assume that each hashmap of an input stream lie one after the other.
     /// Thus, we need to call #numbnumberOfHashMaps times the same nautilusCleanup function and then move to the next one.
+    HashMapGrowthStatistics growthStatistics;
     for (size_t i = 0; i < hashMaps.size(); i++)
     {
         if (hashMaps[i] and hashMaps[i]->getNumberOfTuples() > 0)
         {
+            growthStatistics += hashMaps[i]->getGrowthStatistics();
             /// Calling the compiled nautilus function
             createNewHashMapSliceArgs.nautilusCleanup[i / numberOfHashMapsPerInputStream]->operator()(hashMaps[i].get());
         }
+        if (hashMaps[i] and createNewHashMapSliceArgs.hashMapPool)
+        {
+            createNewHashMapSliceArgs.hashMapPool->release(std::move(hashMaps[i]));
+        }
     }
 
     hashMaps.clear();
+    if (createNewHashMapSliceArgs.growthStatistics)
+    {
+        *createNewHashMapSliceArgs.growthStatistics->wlock() += growthStatistics;
+    }
 }
 
 uint64_t HashMapSlice::getNumberOfHashMaps() const
@@ -70,6 +87,41 @@ uint64_t HashMapSlice::getNumberOfHashMaps() const
     return hashMaps.size();
 }
 
+uint64_t HashMapSlice::getNumberOfPartitions() const
+{
+    return numberOfPartitions;
+}
+
+uint64_t HashMapSlice::getNumberOfWorkerThreads() const
+{
+    return numberOfHashMapsPerInputStream / numberOfPartitions;
+}
+
+uint64_t HashMapSlice::getHashMapPos(const WorkerThreadId workerThreadId, const uint64_t inputStream, const uint64_t partition) const
+{
+    INVARIANT(inputStream < numberOfInputStreams, "Invalid input stream {} for {} input streams", inputStream, numberOfInputStreams);
+    INVARIANT(partition < numberOfPartitions, "Invalid partition {} for {} partitions", partition, numberOfPartitions);
+    const auto pos = (inputStream * numberOfHashMapsPerInputStream)
+        + ((workerThreadId % getNumberOfWorkerThreads()) * numberOfPartitions) + partition;
+    INVARIANT(
+        pos < hashMaps.size(),
+        "No hashmap found for workerThreadId {} at pos {} for {} hashmaps",
+        workerThreadId,
+        pos,
+        hashMaps.size());
+    return pos;
+}
+
+std::vector<HashMap*> HashMapSlice::getHashMapPtrsOfPartition(const uint64_t inputStream, const uint64_t partition) const
+{
+    std::vector<HashMap*> hashMapsOfPartition;
+    for (uint64_t workerThread = 0; workerThread < getNumberOfWorkerThreads(); ++workerThread)
+    {
+        hashMapsOfPartition.emplace_back(hashMaps[getHashMapPos(WorkerThreadId(workerThread), inputStream, partition)].get());
+    }
+    return hashMapsOfPartition;
+}
+
 uint64_t HashMapSlice::getNumberOfTuples() const
 {
     return std::accumulate(
@@ -78,4 +130,118 @@ uint64_t HashMapSlice::getNumberOfTuples() const
         0,
         [](uint64_t runningSum, const auto& hashMap) { return runningSum + hashMap->getNumberOfTuples(); });
 }
+
+HashMapPool::HashMapPool(const uint64_t maxNumberOfHashMaps) : maxNumberOfHashMaps(maxNumberOfHashMaps)
+{
+}
+
+std::unique_ptr<ChainedHashMap> HashMapPool::acquire(const uint64_t entrySize, const uint64_t numberOfChains)
+{
+    const auto lockedHashMaps = hashMaps.wlock();
+    const auto matchingHashMap = std::ranges::find_if(
+        *lockedHashMaps,
+        [&](const auto& hashMap) { return hashMap->getEntrySize() == entrySize and hashMap->getNumberOfChains() == numberOfChains; });
+    if (matchingHashMap == lockedHashMaps->end())
+    {
+        return nullptr;
+    }
+    auto hashMap = std::move(*matchingHashMap);
+    lockedHashMaps->erase(matchingHashMap);
+    return hashMap;
+}
+
+void HashMapPool::release(std::unique_ptr<HashMap> hashMap)
+{
+    if (dynamic_cast<ChainedHashMap*>(hashMap.get()) == nullptr or hashMaps.rlock()->size() >= maxNumberOfHashMaps)
+    {
+        return;
+    }
+    std::unique_ptr<ChainedHashMap> chainedHashMap(dynamic_cast<ChainedHashMap*>(hashMap.release()));
+    /// Resetting releases the entries of the hash map, thus, we do it before locking the pool
+    chainedHashMap->reset();
+    if (const auto lockedHashMaps = hashMaps.wlock(); lockedHashMaps->size() < maxNumberOfHashMaps)
+    {
+        lockedHashMaps->emplace_back(std::move(chainedHashMap));
+    }
+}
+
+uint64_t HashMapPool::getNumberOfHashMaps() const
+{
+    return hashMaps.rlock()->size();
+}
+
+uint64_t CreateNewHashMapSliceArgs::getNumberOfBuckets(const uint64_t inputStream) const
+{
+    return inputStream < numberOfBucketsPerInputStream.size() ? numberOfBucketsPerInputStream[inputStream] : numberOfBuckets;
+}
+
+uint64_t getNumberOfBucketsOfObservedKeys(
+    const RollingAverage<uint64_t>& observedNumberOfKeys, const uint64_t configuredNumberOfBuckets, const uint64_t maxNumberOfBuckets)
+{
+    if (observedNumberOfKeys.empty())
+    {
+        return configuredNumberOfBuckets;
+    }
+    return std::clamp(observedNumberOfKeys.getAverage(), 1UL, maxNumberOfBuckets);
+}
+
+void logHashMapGrowthStatistics(const HashMapGrowthStatistics& growthStatistics, const OriginId outputOriginId)
+{
+    if (growthStatistics.numberOfResizes == 0)
+    {
+        return;
+    }
+    NES_INFO(
+        "The hash maps of output origin {} were resized {} times and rehashed {} entries",
+        outputOriginId,
+        growthStatistics.numberOfResizes,
+        growthStatistics.numberOfRehashedEntries);
+}
+
+std::unique_ptr<HashMap> createHashMap(const CreateNewHashMapSliceArgs& createNewHashMapSliceArgs)
+{
+    return createHashMap(createNewHashMapSliceArgs, createNewHashMapSliceArgs.numberOfBuckets);
+}
+
+std::unique_ptr<HashMap> createHashMap(const CreateNewHashMapSliceArgs& createNewHashMapSliceArgs, const uint64_t numberOfBuckets)
+{
+    switch (createNewHashMapSliceArgs.hashMapType)
+    {
+        case HashMapType::CHAINED: {
+            auto hashMap = std::make_unique<ChainedHashMap>(
+                createNewHashMapSliceArgs.keySize,
+                createNewHashMapSliceArgs.valueSize,
+                numberOfBuckets,
+                createNewHashMapSliceArgs.pageSize);
+            if (createNewHashMapSliceArgs.hashMapPool)
+            {
+                /// The new hash map has not allocated its chains yet, but tells us which pooled hash maps have the same configuration
+                auto pooledHashMap = createNewHashMapSliceArgs.hashMapPool->acquire(hashMap->getEntrySize(), hashMap->getNumberOfChains());
+                if (pooledHashMap)
+                {
+                    return pooledHashMap;
+                }
+            }
+            return hashMap;
+        }
+        case HashMapType::SWISS:
+            return std::make_unique<SwissHashMap>(
+                createNewHashMapSliceArgs.keySize,
+                createNewHashMapSliceArgs.valueSize,
+                numberOfBuckets,
+                createNewHashMapSliceArgs.pageSize);
+    }
+    std::unreachable();
+}
+
+std::unique_ptr<HashMap> HashMapSlice::createHashMap() const
+{
+    return NES::createHashMap(createNewHashMapSliceArgs);
+}
+
+std::unique_ptr<HashMap> HashMapSlice::createHashMap(const uint64_t inputStream) const
+{
+    return NES::createHashMap(createNewHashMapSliceArgs, createNewHashMapSliceArgs.getNumberOfBuckets(inputStream));
+}
+
 }
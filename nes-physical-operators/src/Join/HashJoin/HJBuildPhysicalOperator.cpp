@@ -18,11 +18,14 @@
 #include <functional>
 #include <memory>
 #include <utility>
+#include <vector>
 #include <Identifiers/Identifiers.hpp>
 #include <Join/HashJoin/HJOperatorHandler.hpp>
 #include <Join/HashJoin/HJSlice.hpp>
 #include <Join/StreamJoinBuildPhysicalOperator.hpp>
 #include <Join/StreamJoinUtil.hpp>
+#include <Nautilus/DataTypes/DataTypesUtil.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
 #include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
 #include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMapRef.hpp>
 #include <Nautilus/Interface/HashMap/HashMap.hpp>
@@ -44,11 +47,10 @@
 
 namespace NES
 {
-HashMap* getHashJoinHashMapProxy(
+HJSlice* getHashJoinSliceProxy(
     const HJOperatorHandler* operatorHandler,
     const Timestamp timestamp,
     const WorkerThreadId workerThreadId,
-    const JoinBuildSideType buildSide,
     const HJBuildPhysicalOperator* buildOperator)
 {
     PRECONDITION(operatorHandler != nullptr, "The operator handler should not be null");
@@ -59,30 +61,89 @@ HashMap* getHashJoinHashMapProxy(
         buildOperator->hashMapOptions.keySize,
         buildOperator->hashMapOptions.valueSize,
         buildOperator->hashMapOptions.pageSize,
-        buildOperator->hashMapOptions.numberOfBuckets};
+        buildOperator->hashMapOptions.numberOfBuckets,
+        buildOperator->hashMapOptions.hashMapType};
     const auto hashMap = operatorHandler->getSliceAndWindowStore().getSlicesOrCreate(
-        timestamp, operatorHandler->getCreateNewSlicesFunction(hashMapSliceArgs));
+        timestamp, workerThreadId, operatorHandler->getCreateNewSlicesFunction(hashMapSliceArgs));
     INVARIANT(
         hashMap.size() == 1,
         "We expect exactly one slice for the given timestamp during the HashJoinBuild, as we currently solely support "
         "slicing, but got {}",
         hashMap.size());
 
-    /// Converting the slice to an HJSlice and returning the pointer to the hashmap
-    const auto hjSlice = std::dynamic_pointer_cast<HJSlice>(hashMap[0]);
+    /// Converting the slice to an HJSlice. The slice store keeps the slice alive until the window of the slice has been triggered.
+    auto* const hjSlice = dynamic_cast<HJSlice*>(hashMap[0].get());
     INVARIANT(hjSlice != nullptr, "The slice should be an HJSlice in an HJBuildPhysicalOperator");
-    return hjSlice->getHashMapPtrOrCreate(workerThreadId, buildSide);
+    return hjSlice;
 }
 
-void HJBuildPhysicalOperator::setup(ExecutionContext& executionCtx, CompilationContext& compilationContext) const
+HashMap* getHashJoinHashMapProxy(
+    HJSlice* hjSlice, const WorkerThreadId workerThreadId, const JoinBuildSideType buildSide, const uint64_t partition)
 {
-    StreamJoinBuildPhysicalOperator::setup(executionCtx, compilationContext);
+    PRECONDITION(hjSlice != nullptr, "The slice should not be null");
+    /// The build looks up the hash map once per record, which lets the trigger detect the partitions of hot keys
+    hjSlice->addRecord(workerThreadId, buildSide, partition);
+    return hjSlice->getHashMapPtrOrCreate(workerThreadId, buildSide, partition);
+}
 
-    /// Creating the cleanup function for the slice of current stream
+PagedVector* getHashJoinRowsProxy(
+    HJSlice* hjSlice, const WorkerThreadId workerThreadId, const JoinBuildSideType buildSide, const uint64_t partition)
+{
+    PRECONDITION(hjSlice != nullptr, "The slice should not be null");
+    return hjSlice->getRowsPtrOrCreate(workerThreadId, buildSide, partition);
+}
+
+void insertIntoLeftBloomFilterProxy(HJSlice* hjSlice, const uint64_t hash)
+{
+    PRECONDITION(hjSlice != nullptr, "The slice should not be null");
+    if (auto* const bloomFilter = hjSlice->getLeftBloomFilter())
+    {
+        bloomFilter->insert(hash);
+    }
+}
+
+std::shared_ptr<CreateNewHashMapSliceArgs::NautilusCleanupExec>
+compileHashJoinCleanupFunction(CompilationContext& compilationContext, const HashMapOptions& hashMapOptions, const bool lateMaterialization)
+{
     /// As the setup function does not get traced, we do not need to have any nautilus::invoke calls to jump to the C++ runtime
     /// We are not allowed to use const or const references for the lambda function params, as nautilus does not support this in the registerFunction method.
     /// ReSharper disable once CppPassValueParameterByConstReference
     /// NOLINTBEGIN(performance-unnecessary-value-param)
+    return std::make_shared<CreateNewHashMapSliceArgs::NautilusCleanupExec>(compilationContext.registerFunction(std::function(
+        [copyOfHashMapOptions = hashMapOptions, lateMaterialization](nautilus::val<HashMap*> hashMap)
+        {
+            if (lateMaterialization)
+            {
+                return;
+            }
+            copyOfHashMapOptions.visitHashMapRef(
+                hashMap,
+                [&](const auto& hashMapRef)
+                {
+                    for (const auto entry : hashMapRef)
+                    {
+                        const ChainedHashMapRef::ChainedEntryRef entryRefReset{
+                            entry, hashMap, copyOfHashMapOptions.fieldKeys, copyOfHashMapOptions.fieldValues};
+                        const auto state = entryRefReset.getValueMemArea();
+                        nautilus::invoke(
+                            +[](int8_t* pagedVectorMemArea) -> void
+                            {
+                                /// Calls the destructor of the PagedVector
+                                /// NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                                auto* pagedVector = reinterpret_cast<PagedVector*>(pagedVectorMemArea);
+                                pagedVector->~PagedVector();
+                            },
+                            state);
+                    }
+                });
+        })));
+    /// NOLINTEND(performance-unnecessary-value-param)
+}
+
+void HJBuildPhysicalOperator::setup(ExecutionContext& executionCtx, CompilationContext& compilationContext) const
+{
+    StreamJoinBuildPhysicalOperator::setup(executionCtx, compilationContext);
+
     auto* const operatorHandler = dynamic_cast<HJOperatorHandler*>(
         nautilus::details::RawValueResolver<OperatorHandler*>::getRawValue(executionCtx.getGlobalOperatorHandler(operatorHandlerId)));
     if (operatorHandler->wasSetupCalled(joinBuildSide))
@@ -90,34 +151,9 @@ void HJBuildPhysicalOperator::setup(ExecutionContext& executionCtx, CompilationC
         return;
     }
 
-    const auto cleanupStateNautilusFunction
-        = std::make_shared<CreateNewHashMapSliceArgs::NautilusCleanupExec>(compilationContext.registerFunction(std::function(
-            [copyOfHashMapOptions = hashMapOptions](nautilus::val<HashMap*> hashMap)
-            {
-                const ChainedHashMapRef hashMapRef{
-                    hashMap,
-                    copyOfHashMapOptions.fieldKeys,
-                    copyOfHashMapOptions.fieldValues,
-                    copyOfHashMapOptions.entriesPerPage,
-                    copyOfHashMapOptions.entrySize};
-                for (const auto entry : hashMapRef)
-                {
-                    const ChainedHashMapRef::ChainedEntryRef entryRefReset{
-                        entry, hashMap, copyOfHashMapOptions.fieldKeys, copyOfHashMapOptions.fieldValues};
-                    const auto state = entryRefReset.getValueMemArea();
-                    nautilus::invoke(
-                        +[](int8_t* pagedVectorMemArea) -> void
-                        {
-                            /// Calls the destructor of the PagedVector
-                            /// NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
-                            auto* pagedVector = reinterpret_cast<PagedVector*>(pagedVectorMemArea);
-                            pagedVector->~PagedVector();
-                        },
-                        state);
-                }
-            })));
-    /// NOLINTEND(performance-unnecessary-value-param)
-    operatorHandler->setNautilusCleanupExec(cleanupStateNautilusFunction, joinBuildSide);
+    /// Creating the cleanup function for the slice of current stream
+    operatorHandler->setNautilusCleanupExec(
+        compileHashJoinCleanupFunction(compilationContext, hashMapOptions, rowBufferRef != nullptr), joinBuildSide);
 }
 
 void HJBuildPhysicalOperator::execute(ExecutionContext& ctx, Record& record) const
@@ -126,27 +162,44 @@ void HJBuildPhysicalOperator::execute(ExecutionContext& ctx, Record& record) con
     auto* localState = dynamic_cast<WindowOperatorBuildLocalState*>(ctx.getLocalState(id));
     auto operatorHandler = localState->getOperatorHandler();
 
-    /// Get the current slice / hash map that we have to insert the tuple into
-    const auto timestamp = timeFunction->getTs(ctx, record);
-    const auto hashMapPtr = invoke(
-        getHashJoinHashMapProxy,
-        operatorHandler,
-        timestamp,
-        ctx.workerThreadId,
-        nautilus::val<JoinBuildSideType>(joinBuildSide),
-        nautilus::val<const HJBuildPhysicalOperator*>(this));
-    ChainedHashMapRef hashMap{
-        hashMapPtr, hashMapOptions.fieldKeys, hashMapOptions.fieldValues, hashMapOptions.entriesPerPage, hashMapOptions.entrySize};
-
     /// Calling the key functions to add/update the keys to the record
     nautilus::val<bool> containsNullInKey{false};
+    std::vector<VarVal> keyValues;
     for (nautilus::static_val<uint64_t> i = 0; i < hashMapOptions.fieldKeys.size(); ++i)
     {
-        const auto& [fieldIdentifier, type, fieldOffset] = hashMapOptions.fieldKeys[i];
+        const auto& [fieldIdentifier, type, fieldOffset, varSizedDictionary] = hashMapOptions.fieldKeys[i];
         const auto& function = hashMapOptions.keyFunctions[i];
         const auto value = function.execute(record, ctx.pipelineMemoryProvider.arena);
         containsNullInKey = containsNullInKey or (value.isNullable() and value.isNull());
         record.write(fieldIdentifier, value);
+        keyValues.emplace_back(value);
+    }
+
+    const auto partition = hashMapOptions.getPartition(keyValues, numberOfPartitions);
+
+    /// Get the current slice / hash map that we have to insert the tuple into
+    const auto timestamp = timeFunction->getTs(ctx, record);
+    const auto hjSlicePtr = invoke(
+        getHashJoinSliceProxy, operatorHandler, timestamp, ctx.workerThreadId, nautilus::val<const HJBuildPhysicalOperator*>(this));
+    if (isStreamedSide)
+    {
+        /// The streamed side skips the hash map and appends the tuple to the rows of the worker thread. As for the hashed side, tuples
+        /// with a null key can never be part of the result set.
+        const auto streamedRowsPtr
+            = invoke(getHashJoinRowsProxy, hjSlicePtr, ctx.workerThreadId, nautilus::val<JoinBuildSideType>(joinBuildSide), partition);
+        if (not containsNullInKey)
+        {
+            const PagedVectorRef streamedRowsRef(streamedRowsPtr, bufferRef);
+            streamedRowsRef.writeRecord(record, ctx.pipelineMemoryProvider.bufferProvider);
+        }
+        return;
+    }
+    const auto hashMapPtr = invoke(
+        getHashJoinHashMapProxy, hjSlicePtr, ctx.workerThreadId, nautilus::val<JoinBuildSideType>(joinBuildSide), partition);
+    nautilus::val<PagedVector*> rowsPtr{nullptr};
+    if (rowBufferRef != nullptr)
+    {
+        rowsPtr = invoke(getHashJoinRowsProxy, hjSlicePtr, ctx.workerThreadId, nautilus::val<JoinBuildSideType>(joinBuildSide), partition);
     }
 
     /// If any key field is null, we need to skip it from inserting the tuple in the hash table, as the tuple will never be included
@@ -154,32 +207,71 @@ void HJBuildPhysicalOperator::execute(ExecutionContext& ctx, Record& record) con
     if (not containsNullInKey)
     {
         /// Finding or creating the entry for the provided record
-        const auto hashMapEntry = hashMap.findOrCreateEntry(
-            record,
-            *hashMapOptions.hashFunction,
-            [&](const nautilus::val<AbstractHashMapEntry*>& entry)
+        const auto hashMapEntry = hashMapOptions.visitHashMapRef(
+            hashMapPtr,
+            [&](auto& hashMap)
             {
-                /// If the entry for the provided keys does not exist, we need to create a new one and initialize the underyling paged vector
-                const ChainedHashMapRef::ChainedEntryRef entryRefReset{
-                    entry, hashMapPtr, hashMapOptions.fieldKeys, hashMapOptions.fieldValues};
-                const auto state = entryRefReset.getValueMemArea();
-                nautilus::invoke(
-                    +[](int8_t* pagedVectorMemArea) -> void
+                return hashMap.findOrCreateEntry(
+                    record,
+                    *hashMapOptions.hashFunction,
+                    [&](const nautilus::val<AbstractHashMapEntry*>& entry)
                     {
-                        /// Allocates a new PagedVector in the memory area provided by the pointer to the pagedvector
-                        /// NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
-                        auto* pagedVector = reinterpret_cast<PagedVector*>(pagedVectorMemArea);
-                        new (pagedVector) PagedVector();
+                        /// If the entry for the provided keys does not exist, we need to create a new one and initialize the underyling
+                        /// paged vector or, with late materialization, the empty chain of its rows
+                        const ChainedHashMapRef::ChainedEntryRef entryRefReset{
+                            entry, hashMapPtr, hashMapOptions.fieldKeys, hashMapOptions.fieldValues};
+                        const auto state = entryRefReset.getValueMemArea();
+                        if (rowBufferRef != nullptr)
+                        {
+                            nautilus::invoke(
+                                +[](int8_t* rowChainMemArea, PagedVector* rows) -> void
+                                {
+                                    /// NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                                    new (reinterpret_cast<HJRowChain*>(rowChainMemArea)) HJRowChain{.rows = rows, .lastRow = 0};
+                                },
+                                state,
+                                rowsPtr);
+                        }
+                        else
+                        {
+                            nautilus::invoke(
+                                +[](int8_t* pagedVectorMemArea) -> void
+                                {
+                                    /// Allocates a new PagedVector in the memory area provided by the pointer to the pagedvector
+                                    /// NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                                    auto* pagedVector = reinterpret_cast<PagedVector*>(pagedVectorMemArea);
+                                    new (pagedVector) PagedVector();
+                                },
+                                state);
+                        }
+
+                        /// The probe looks up the right keys in the left hash maps. Thus, only the left keys have to be inserted into the
+                        /// bloom filter.
+                        if (joinBuildSide == JoinBuildSideType::Left)
+                        {
+                            nautilus::invoke(insertIntoLeftBloomFilterProxy, hjSlicePtr, entryRefReset.getHash());
+                        }
                     },
-                    state);
-            },
-            ctx.pipelineMemoryProvider.bufferProvider);
+                    ctx.pipelineMemoryProvider.bufferProvider);
+            });
 
         /// Inserting the tuple into the corresponding hash entry
         const ChainedHashMapRef::ChainedEntryRef entryRef{hashMapEntry, hashMapPtr, hashMapOptions.fieldKeys, hashMapOptions.fieldValues};
         auto entryMemArea = entryRef.getValueMemArea();
-        const PagedVectorRef pagedVectorRef(entryMemArea, bufferRef);
-        pagedVectorRef.writeRecord(record, ctx.pipelineMemoryProvider.bufferProvider);
+        if (rowBufferRef != nullptr)
+        {
+            /// Appending the tuple to the rows of the hash map and making it the latest row of the key
+            const auto lastRowRef = getMemberRef(entryMemArea, &HJRowChain::lastRow);
+            record.write(HJ_PREVIOUS_ROW_FIELD, VarVal{readValueFromMemRef<uint64_t>(lastRowRef)});
+            const PagedVectorRef rowsRef(rowsPtr, rowBufferRef);
+            rowsRef.writeRecord(record, ctx.pipelineMemoryProvider.bufferProvider);
+            VarVal{rowsRef.getNumberOfTuples()}.writeToMemory(lastRowRef);
+        }
+        else
+        {
+            const PagedVectorRef pagedVectorRef(entryMemArea, bufferRef);
+            pagedVectorRef.writeRecord(record, ctx.pipelineMemoryProvider.bufferProvider);
+        }
     }
 }
 
@@ -188,10 +280,19 @@ HJBuildPhysicalOperator::HJBuildPhysicalOperator(
     const JoinBuildSideType joinBuildSide,
     std::unique_ptr<TimeFunction> timeFunction,
     const std::shared_ptr<TupleBufferRef>& bufferRef,
-    HashMapOptions hashMapOptions)
+    HashMapOptions hashMapOptions,
+    const uint64_t numberOfPartitions,
+    std::shared_ptr<TupleBufferRef> rowBufferRef,
+    const bool isStreamedSide)
     : StreamJoinBuildPhysicalOperator(operatorHandlerId, joinBuildSide, std::move(timeFunction), bufferRef)
     , hashMapOptions(std::move(hashMapOptions))
+    , numberOfPartitions(numberOfPartitions)
+    , rowBufferRef(std::move(rowBufferRef))
+    , isStreamedSide(isStreamedSide)
 {
+    PRECONDITION(
+        not isStreamedSide or (numberOfPartitions == 0 and this->rowBufferRef == nullptr),
+        "The streamed side of an asymmetric hash join supports neither radix partitions nor late materialization");
 }
 
 }
@@ -20,19 +20,27 @@
 #include <cstdint>
 #include <cstring>
 #include <functional>
+#include <map>
 #include <memory>
+#include <numeric>
+#include <optional>
 #include <utility>
 #include <vector>
 #include <Identifiers/Identifiers.hpp>
 #include <Join/HashJoin/HJSlice.hpp>
 #include <Join/StreamJoinOperatorHandler.hpp>
 #include <Join/StreamJoinUtil.hpp>
+#include <Nautilus/Interface/BloomFilter/BlockedBloomFilter.hpp>
 #include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Nautilus/Interface/PagedVector/PagedVector.hpp>
+#include <Runtime/QueryTerminationType.hpp>
 #include <Sequencing/SequenceData.hpp>
 #include <SliceStore/Slice.hpp>
 #include <SliceStore/WindowSlicesStoreInterface.hpp>
 #include <Util/Logger/Logger.hpp>
+#include <folly/Synchronized.h>
 #include <ErrorHandling.hpp>
+#include <HashMapSlice.hpp>
 #include <PipelineExecutionContext.hpp>
 
 namespace NES
@@ -41,13 +49,42 @@ HJOperatorHandler::HJOperatorHandler(
     const std::vector<OriginId>& inputOrigins,
     const OriginId outputOriginId,
     std::unique_ptr<WindowSlicesStoreInterface> sliceAndWindowStore,
-    const uint64_t maxNumberOfBuckets)
+    const uint64_t maxNumberOfBuckets,
+    const uint64_t numberOfPartitions,
+    const uint64_t bloomFilterBitsPerKey,
+    const bool lateMaterialization,
+    const std::optional<JoinBuildSideType> streamedSide)
     : StreamJoinOperatorHandler(inputOrigins, outputOriginId, std::move(sliceAndWindowStore))
     , setupAlreadyCalledLeft(false)
     , setupAlreadyCalledRight(false)
-    , rollingAverageNumberOfKeys(RollingAverage<uint64_t>{100})
+    , rollingAverageNumberOfLeftKeys(RollingAverage<uint64_t>{100})
+    , rollingAverageNumberOfRightKeys(RollingAverage<uint64_t>{100})
     , maxNumberOfBuckets(maxNumberOfBuckets)
+    , numberOfPartitions(numberOfPartitions)
+    , bloomFilterBitsPerKey(bloomFilterBitsPerKey)
+    , lateMaterialization(lateMaterialization)
+    , streamedSide(streamedSide)
+    , hashMapGrowthStatistics(std::make_shared<folly::Synchronized<HashMapGrowthStatistics>>())
+    , hashMapPool(std::make_shared<HashMapPool>())
 {
+    PRECONDITION(
+        not streamedSide.has_value() or (numberOfPartitions == 0 and not lateMaterialization),
+        "An asymmetric hash join supports neither radix partitions nor late materialization");
+}
+
+void HJOperatorHandler::stop(const QueryTerminationType queryTerminationType, PipelineExecutionContext& pipelineExecutionContext)
+{
+    StreamJoinOperatorHandler::stop(queryTerminationType, pipelineExecutionContext);
+    logHashMapGrowthStatistics(getHashMapGrowthStatistics(), outputOriginId);
+    if (const auto statistics = getBloomFilterStatistics(); statistics.numberOfRejectedKeys + statistics.numberOfFalsePositives > 0)
+    {
+        NES_INFO(
+            "The bloom filters of output origin {} rejected {} keys and passed {} absent keys, i.e., a false positive rate of {}",
+            outputOriginId,
+            statistics.numberOfRejectedKeys,
+            statistics.numberOfFalsePositives,
+            statistics.getFalsePositiveRate());
+    }
 }
 
 std::function<std::vector<std::shared_ptr<Slice>>(SliceStart, SliceEnd)>
@@ -57,16 +94,39 @@ HJOperatorHandler::getCreateNewSlicesFunction(const CreateNewSlicesArguments& ne
         numberOfWorkerThreads > 0, "Number of worker threads not set for window based operator. Has setWorkerThreads() being called?");
 
     auto newHashMapArgs = dynamic_cast<const CreateNewHashMapSliceArgs&>(newSlicesArguments);
-    newHashMapArgs.numberOfBuckets = std::clamp(rollingAverageNumberOfKeys.rlock()->getAverage(), 1UL, maxNumberOfBuckets);
+    newHashMapArgs.numberOfBucketsPerInputStream = {
+        getNumberOfBucketsOfObservedKeys(*rollingAverageNumberOfLeftKeys.rlock(), newHashMapArgs.numberOfBuckets, maxNumberOfBuckets),
+        getNumberOfBucketsOfObservedKeys(*rollingAverageNumberOfRightKeys.rlock(), newHashMapArgs.numberOfBuckets, maxNumberOfBuckets)};
+    newHashMapArgs.growthStatistics = hashMapGrowthStatistics;
+    newHashMapArgs.hashMapPool = hashMapPool;
     return std::function(
-        [outputOriginId = outputOriginId, numberOfWorkerThreads = numberOfWorkerThreads, copyOfNewHashMapArgs = newHashMapArgs](
-            SliceStart sliceStart, SliceEnd sliceEnd) -> std::vector<std::shared_ptr<Slice>>
+        [outputOriginId = outputOriginId,
+         numberOfWorkerThreads = numberOfWorkerThreads,
+         numberOfSlicePartitions = std::max<uint64_t>(numberOfPartitions, 1),
+         bloomFilterBitsPerKey = bloomFilterBitsPerKey,
+         copyOfNewHashMapArgs = newHashMapArgs](SliceStart sliceStart, SliceEnd sliceEnd) -> std::vector<std::shared_ptr<Slice>>
         {
             NES_TRACE("Creating new hash-join slice for slice {}-{} for output origin {}", sliceStart, sliceEnd, outputOriginId);
-            return {std::make_shared<HJSlice>(sliceStart, sliceEnd, copyOfNewHashMapArgs, numberOfWorkerThreads)};
+            return {std::make_shared<HJSlice>(
+                sliceStart, sliceEnd, copyOfNewHashMapArgs, numberOfWorkerThreads, numberOfSlicePartitions, bloomFilterBitsPerKey)};
         });
 }
 
+HashMapGrowthStatistics HJOperatorHandler::getHashMapGrowthStatistics() const
+{
+    return *hashMapGrowthStatistics->rlock();
+}
+
+BloomFilterStatistics HJOperatorHandler::getBloomFilterStatistics() const
+{
+    return *bloomFilterStatistics.rlock();
+}
+
+void HJOperatorHandler::addBloomFilterStatistics(const BloomFilterStatistics& statistics)
+{
+    *bloomFilterStatistics.wlock() += statistics;
+}
+
 bool HJOperatorHandler::wasSetupCalled(const JoinBuildSideType& buildSide)
 {
     switch (buildSide)
@@ -104,6 +164,116 @@ std::vector<std::shared_ptr<CreateNewHashMapSliceArgs::NautilusCleanupExec>> HJO
     return {leftCleanupStateNautilusFunction, rightCleanupStateNautilusFunction};
 }
 
+namespace
+{
+/// Splits the right hash maps of the partition into the given number of groups with a similar number of records. We assign the hash
+/// maps with the most records first, each to the group with the fewest records so far.
+std::vector<std::vector<HashMap*>> splitRightHashMaps(const HJSlice& sliceRight, const uint64_t partition, const uint64_t numberOfSplits)
+{
+    std::vector<std::pair<uint64_t, HashMap*>> recordsAndHashMaps;
+    const auto hashMapsOfPartition = sliceRight.getHashMapPtrsOfPartition(JoinBuildSideType::Right, partition);
+    for (uint64_t workerThread = 0; workerThread < hashMapsOfPartition.size(); ++workerThread)
+    {
+        if (auto* hashMap = hashMapsOfPartition[workerThread]; hashMap and hashMap->getNumberOfTuples() > 0)
+        {
+            recordsAndHashMaps.emplace_back(
+                sliceRight.getNumberOfRecords(WorkerThreadId(workerThread), JoinBuildSideType::Right, partition), hashMap);
+        }
+    }
+    std::ranges::stable_sort(recordsAndHashMaps, std::ranges::greater{}, &std::pair<uint64_t, HashMap*>::first);
+
+    std::vector<std::vector<HashMap*>> splits(numberOfSplits);
+    std::vector<uint64_t> numberOfRecordsPerSplit(numberOfSplits, 0);
+    for (const auto& [numberOfRecords, hashMap] : recordsAndHashMaps)
+    {
+        const auto split = std::ranges::min_element(numberOfRecordsPerSplit) - numberOfRecordsPerSplit.begin();
+        splits[split].emplace_back(hashMap);
+        numberOfRecordsPerSplit[split] += numberOfRecords;
+    }
+    return splits;
+}
+}
+
+void HJOperatorHandler::triggerSlices(
+    const std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>>& slicesAndWindowInfo,
+    PipelineExecutionContext* pipelineCtx)
+{
+    if (numberOfPartitions == 0)
+    {
+        StreamJoinOperatorHandler::triggerSlices(slicesAndWindowInfo, pipelineCtx);
+        return;
+    }
+
+    struct ProbeTask
+    {
+        const Slice& sliceLeft;
+        const Slice& sliceRight;
+        uint64_t partition;
+        std::vector<HashMap*> leftHashMaps;
+        std::vector<HashMap*> rightHashMaps;
+    };
+
+    /// The probe tasks of different partitions are independent of each other. Thus, the worker threads can join them in parallel.
+    /// As the last probe task of a window must know the number of probe tasks, we collect all probe tasks before emitting them.
+    for (const auto& [windowInfo, allSlices] : slicesAndWindowInfo)
+    {
+        std::vector<ProbeTask> probeTasks;
+        for (const auto& sliceLeft : allSlices)
+        {
+            for (const auto& sliceRight : allSlices)
+            {
+                const auto& hashJoinSliceLeft = dynamic_cast<const HJSlice&>(*sliceLeft);
+                const auto& hashJoinSliceRight = dynamic_cast<const HJSlice&>(*sliceRight);
+                std::vector<uint64_t> numberOfRecordsPerPartition(numberOfPartitions);
+                for (uint64_t partition = 0; partition < numberOfPartitions; ++partition)
+                {
+                    numberOfRecordsPerPartition[partition]
+                        = hashJoinSliceLeft.getNumberOfRecordsOfPartition(JoinBuildSideType::Left, partition)
+                        + hashJoinSliceRight.getNumberOfRecordsOfPartition(JoinBuildSideType::Right, partition);
+                }
+                const auto totalNumberOfRecords
+                    = std::accumulate(numberOfRecordsPerPartition.begin(), numberOfRecordsPerPartition.end(), uint64_t{0});
+                const auto averageNumberOfRecords = std::max<uint64_t>(totalNumberOfRecords / numberOfPartitions, 1);
+
+                for (uint64_t partition = 0; partition < numberOfPartitions; ++partition)
+                {
+                    auto leftHashMaps = getHashMapsOfPartition(*sliceLeft, JoinBuildSideType::Left, partition);
+                    auto rightHashMaps = getHashMapsOfPartition(*sliceRight, JoinBuildSideType::Right, partition);
+                    const auto numberOfRecords = numberOfRecordsPerPartition[partition];
+                    const auto numberOfSplits
+                        = std::min<uint64_t>(rightHashMaps.size(), (numberOfRecords + averageNumberOfRecords - 1) / averageNumberOfRecords);
+                    if (numberOfRecords <= SKEWED_PARTITION_FACTOR * averageNumberOfRecords or numberOfSplits < 2)
+                    {
+                        probeTasks.emplace_back(*sliceLeft, *sliceRight, partition, std::move(leftHashMaps), std::move(rightHashMaps));
+                        continue;
+                    }
+
+                    NES_DEBUG(
+                        "Splitting the probe of partition {} with {} records into {} probe tasks, as the average partition has {} records",
+                        partition,
+                        numberOfRecords,
+                        numberOfSplits,
+                        averageNumberOfRecords);
+                    for (auto& rightHashMapsOfSplit : splitRightHashMaps(hashJoinSliceRight, partition, numberOfSplits))
+                    {
+                        probeTasks.emplace_back(*sliceLeft, *sliceRight, partition, leftHashMaps, std::move(rightHashMapsOfSplit));
+                    }
+                }
+            }
+        }
+
+        ChunkNumber::Underlying chunkNumber = ChunkNumber::INITIAL;
+        for (const auto& [sliceLeft, sliceRight, partition, leftHashMaps, rightHashMaps] : probeTasks)
+        {
+            const bool isLastChunk = chunkNumber == probeTasks.size();
+            const SequenceData sequenceData{windowInfo.sequenceNumber, ChunkNumber(chunkNumber), isLastChunk};
+            emitPartitionToProbe(
+                sliceLeft, sliceRight, partition, leftHashMaps, rightHashMaps, windowInfo.windowInfo, sequenceData, pipelineCtx);
+            ++chunkNumber;
+        }
+    }
+}
+
 void HJOperatorHandler::emitSlicesToProbe(
     Slice& sliceLeft,
     Slice& sliceRight,
@@ -111,36 +281,106 @@ void HJOperatorHandler::emitSlicesToProbe(
     const SequenceData& sequenceData,
     PipelineExecutionContext* pipelineCtx)
 {
-    /// Counting how many tuples the probe has to check for this probe task
-    uint64_t totalNumberOfTuples = 0;
+    if (streamedSide.has_value())
+    {
+        /// The streamed side has no hash maps, thus, we only emit the hash maps of the hashed side
+        const auto streamedLeft = streamedSide == JoinBuildSideType::Left;
+        const auto hashMaps = getHashMapsOfPartition(
+            streamedLeft ? sliceRight : sliceLeft, streamedLeft ? JoinBuildSideType::Right : JoinBuildSideType::Left, 0);
+        const auto streamedRows = getStreamedRows(streamedLeft ? sliceLeft : sliceRight);
+        emitPartitionToProbe(
+            sliceLeft,
+            sliceRight,
+            0,
+            streamedLeft ? std::vector<HashMap*>{} : hashMaps,
+            streamedLeft ? hashMaps : std::vector<HashMap*>{},
+            windowInfo,
+            sequenceData,
+            pipelineCtx,
+            streamedRows);
+        return;
+    }
+    const auto leftHashMaps = getHashMapsOfPartition(sliceLeft, JoinBuildSideType::Left, 0);
+    const auto rightHashMaps = getHashMapsOfPartition(sliceRight, JoinBuildSideType::Right, 0);
+    emitPartitionToProbe(sliceLeft, sliceRight, 0, leftHashMaps, rightHashMaps, windowInfo, sequenceData, pipelineCtx);
+}
 
-    /// Getting all hash maps for the left and right slice
-    auto getHashMapsForSlice = [&](const Slice& slice, const JoinBuildSideType& buildSide)
+std::vector<PagedVector*> HJOperatorHandler::getStreamedRows(const Slice& slice) const
+{
+    const auto* const hashJoinSlice = dynamic_cast<const HJSlice*>(&slice);
+    INVARIANT(hashJoinSlice != nullptr, "Slice must be of type HJSlice!");
+    INVARIANT(streamedSide.has_value(), "Only an asymmetric hash join has a streamed side");
+    std::vector<PagedVector*> streamedRows;
+    for (auto* rows : hashJoinSlice->getRowsPtrsOfPartition(*streamedSide, 0))
     {
-        std::vector<HashMap*> allHashMaps;
-        const auto* const hashJoinSlice = dynamic_cast<const HJSlice*>(&slice);
-        INVARIANT(hashJoinSlice != nullptr, "Slice must be of type HashMapSlice!");
-        for (uint64_t hashMapIdx = 0; hashMapIdx < hashJoinSlice->getNumberOfHashMapsForSide(); ++hashMapIdx)
+        if (rows and rows->getTotalNumberOfEntries() > 0)
         {
-            if (auto* hashMap = hashJoinSlice->getHashMapPtr(WorkerThreadId(hashMapIdx), buildSide);
-                hashMap and hashMap->getNumberOfTuples() > 0)
-            {
-                /// As the hashmap has one value per key, we can use the number of tuples for the number of keys
-                rollingAverageNumberOfKeys.wlock()->add(hashMap->getNumberOfTuples());
+            streamedRows.emplace_back(rows);
+        }
+    }
+    return streamedRows;
+}
 
-                allHashMaps.emplace_back(hashMap);
-                totalNumberOfTuples += hashMap->getNumberOfTuples();
-            }
+std::vector<HashMap*>
+HJOperatorHandler::getHashMapsOfPartition(const Slice& slice, const JoinBuildSideType& buildSide, const uint64_t partition)
+{
+    std::vector<HashMap*> allHashMaps;
+    const auto* const hashJoinSlice = dynamic_cast<const HJSlice*>(&slice);
+    INVARIANT(hashJoinSlice != nullptr, "Slice must be of type HashMapSlice!");
+    for (auto* hashMap : hashJoinSlice->getHashMapPtrsOfPartition(buildSide, partition))
+    {
+        if (hashMap and hashMap->getNumberOfTuples() > 0)
+        {
+            /// As the hashmap has one value per key, we can use the number of tuples for the number of keys
+            auto& rollingAverageNumberOfKeys
+                = buildSide == JoinBuildSideType::Left ? rollingAverageNumberOfLeftKeys : rollingAverageNumberOfRightKeys;
+            rollingAverageNumberOfKeys.wlock()->add(hashMap->getNumberOfTuples());
+            allHashMaps.emplace_back(hashMap);
         }
-        return allHashMaps;
-    };
-    const auto leftHashMaps = getHashMapsForSlice(sliceLeft, JoinBuildSideType::Left);
-    const auto rightHashMaps = getHashMapsForSlice(sliceRight, JoinBuildSideType::Right);
+    }
+    return allHashMaps;
+}
+
+void HJOperatorHandler::emitPartitionToProbe(
+    const Slice& sliceLeft,
+    const Slice& sliceRight,
+    const uint64_t partition,
+    const std::vector<HashMap*>& leftHashMaps,
+    const std::vector<HashMap*>& rightHashMaps,
+    const WindowInfo& windowInfo,
+    const SequenceData& sequenceData,
+    PipelineExecutionContext* pipelineCtx,
+    const std::vector<PagedVector*>& streamedRows)
+{
+    /// Counting how many tuples the probe has to check for this probe task
+    uint64_t totalNumberOfTuples = 0;
+    for (const auto* hashMap : leftHashMaps)
+    {
+        totalNumberOfTuples += hashMap->getNumberOfTuples();
+    }
+    for (const auto* hashMap : rightHashMaps)
+    {
+        totalNumberOfTuples += hashMap->getNumberOfTuples();
+    }
+    for (const auto* rows : streamedRows)
+    {
+        totalNumberOfTuples += rows->getTotalNumberOfEntries();
+    }
+    auto* const leftBloomFilter = dynamic_cast<const HJSlice&>(sliceLeft).getLeftBloomFilter();
+
+    /// For a radix-partitioned hash join, the probe merges all left hash maps of the partition, so that it has to probe only one hash map
+    std::unique_ptr<HashMap> mergedLeftHashMap;
+    if (numberOfPartitions > 0 and not lateMaterialization and not leftHashMaps.empty() and not rightHashMaps.empty())
+    {
+        mergedLeftHashMap = leftHashMaps.front()->createNewMapWithSameConfiguration();
+    }
 
     /// We need a buffer that is large enough to store:
     /// - all pointers to (left + right) hashmaps of the window to be triggered
+    /// - all pointers to the streamed rows of the window to be triggered
     /// - size of EmittedHJWindowTrigger
-    const auto neededBufferSize = sizeof(EmittedHJWindowTrigger) + ((leftHashMaps.size() + rightHashMaps.size()) * sizeof(HashMap*));
+    const auto neededBufferSize = sizeof(EmittedHJWindowTrigger) + ((leftHashMaps.size() + rightHashMaps.size()) * sizeof(HashMap*))
+        + (streamedRows.size() * sizeof(PagedVector*));
     const auto tupleBufferVal = pipelineCtx->getBufferManager()->getUnpooledBuffer(neededBufferSize);
     if (not tupleBufferVal.has_value())
     {
@@ -158,21 +398,26 @@ void HJOperatorHandler::emitSlicesToProbe(
     tupleBuffer.setNumberOfTuples(totalNumberOfTuples);
     tupleBuffer.setCreationTimestampInMS(Timestamp(
         std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count()));
+    auto ingestionTimestamps = sliceLeft.getIngestionTimestamps();
+    ingestionTimestamps.merge(sliceRight.getIngestionTimestamps());
+    tupleBuffer.setIngestionTimestampsInNS(ingestionTimestamps.min, ingestionTimestamps.max);
 
     /// Writing all necessary information for the probe to the buffer via the placement constructor
-    new (tupleBuffer.getAvailableMemoryArea().data()) EmittedHJWindowTrigger{windowInfo, leftHashMaps, rightHashMaps};
+    new (tupleBuffer.getAvailableMemoryArea().data())
+        EmittedHJWindowTrigger{windowInfo, leftHashMaps, rightHashMaps, leftBloomFilter, std::move(mergedLeftHashMap), streamedRows};
 
     /// Dispatching the buffer to the probe operator via the task queue.
     pipelineCtx->emitBuffer(tupleBuffer);
     NES_TRACE(
-        "Triggered window {}-{} with watermarkTs {} sequenceNumber {} originId {} and {}-{} hashmaps",
+        "Triggered window {}-{} with watermarkTs {} sequenceNumber {} originId {} and {}-{} hashmaps of partition {}",
         windowInfo.windowStart,
         windowInfo.windowEnd,
         tupleBuffer.getWatermark(),
         tupleBuffer.getSequenceNumber(),
         tupleBuffer.getOriginId(),
         leftHashMaps.size(),
-        rightHashMaps.size());
+        rightHashMaps.size(),
+        partition);
 }
 
 }
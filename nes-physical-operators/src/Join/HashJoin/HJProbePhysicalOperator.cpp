@@ -15,26 +15,38 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <type_traits>
 #include <utility>
+#include <vector>
 #include <Functions/PhysicalFunction.hpp>
 #include <Join/HashJoin/HJOperatorHandler.hpp>
+#include <Join/HashJoin/HJSlice.hpp>
 #include <Join/StreamJoinProbePhysicalOperator.hpp>
 #include <Join/StreamJoinUtil.hpp>
 #include <Nautilus/DataTypes/DataTypesUtil.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/BloomFilter/BlockedBloomFilter.hpp>
+#include <Nautilus/Interface/BloomFilter/BlockedBloomFilterRef.hpp>
+#include <Nautilus/Interface/Hash/HashFunction.hpp>
 #include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
 #include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMapRef.hpp>
 #include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Nautilus/Interface/PagedVector/PagedVector.hpp>
 #include <Nautilus/Interface/PagedVector/PagedVectorRef.hpp>
+#include <Nautilus/Interface/Record.hpp>
 #include <Nautilus/Interface/RecordBuffer.hpp>
 #include <Nautilus/Interface/TimestampRef.hpp>
 #include <Runtime/Execution/OperatorHandler.hpp>
 #include <SliceStore/WindowSlicesStoreInterface.hpp>
 #include <Time/Timestamp.hpp>
+#include <Util/Logger/Logger.hpp>
 #include <Windowing/WindowMetaData.hpp>
 #include <ErrorHandling.hpp>
 #include <ExecutionContext.hpp>
 #include <HashMapOptions.hpp>
 #include <function.hpp>
+#include <static.hpp>
 #include <val.hpp>
 #include <val_ptr.hpp>
 
@@ -49,13 +61,25 @@ HJProbePhysicalOperator::HJProbePhysicalOperator(
     std::shared_ptr<TupleBufferRef> leftBufferRef,
     std::shared_ptr<TupleBufferRef> rightBufferRef,
     HashMapOptions leftHashMapBasedOptions,
-    HashMapOptions rightHashMapBasedOptions)
+    HashMapOptions rightHashMapBasedOptions,
+    const uint64_t numberOfPartitions,
+    const bool lateMaterialization,
+    const std::optional<JoinBuildSideType> streamedSide)
     : StreamJoinProbePhysicalOperator(operatorHandlerId, std::move(joinFunction), std::move(windowMetaData), std::move(joinSchema))
     , leftBufferRef(std::move(leftBufferRef))
     , rightBufferRef(std::move(rightBufferRef))
     , leftHashMapOptions(std::move(leftHashMapBasedOptions))
     , rightHashMapOptions(std::move(rightHashMapBasedOptions))
+    , numberOfPartitions(numberOfPartitions)
+    , lateMaterialization(lateMaterialization)
+    , streamedSide(streamedSide)
 {
+    PRECONDITION(
+        leftHashMapOptions.hashMapType == rightHashMapOptions.hashMapType,
+        "Both sides of the hash join have to use the same hash map type");
+    PRECONDITION(
+        not this->streamedSide.has_value() or (numberOfPartitions == 0 and not lateMaterialization),
+        "An asymmetric hash join supports neither radix partitions nor late materialization");
 }
 
 void HJProbePhysicalOperator::open(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const
@@ -67,10 +91,22 @@ void HJProbePhysicalOperator::open(ExecutionContext& executionCtx, RecordBuffer&
     executionCtx.chunkNumber = recordBuffer.getChunkNumber();
     executionCtx.lastChunk = recordBuffer.isLastChunk();
     executionCtx.originId = recordBuffer.getOriginId();
+    executionCtx.minIngestionTs = recordBuffer.getMinIngestionTs();
+    executionCtx.maxIngestionTs = recordBuffer.getMaxIngestionTs();
     StreamJoinProbePhysicalOperator::open(executionCtx, recordBuffer);
 
-    /// Getting number of hash maps and return if there are no hashmaps
+    /// Getting necessary values from the record buffer
     const auto hashJoinWindowRef = static_cast<nautilus::val<EmittedHJWindowTrigger*>>(recordBuffer.getMemArea());
+    const auto windowInfoRef = getMemberRef(hashJoinWindowRef, &EmittedHJWindowTrigger::windowInfo);
+    const nautilus::val<Timestamp> windowStart{readValueFromMemRef<uint64_t>(getMemberRef(windowInfoRef, &WindowInfo::windowStart))};
+    const nautilus::val<Timestamp> windowEnd{readValueFromMemRef<uint64_t>(getMemberRef(windowInfoRef, &WindowInfo::windowEnd))};
+    if (streamedSide.has_value())
+    {
+        probeStreamedRows(executionCtx, hashJoinWindowRef, windowStart, windowEnd);
+        return;
+    }
+
+    /// Getting number of hash maps and return if there are no hashmaps
     const auto leftNumberOfHashMaps
         = readValueFromMemRef<uint64_t>(getMemberRef(hashJoinWindowRef, &EmittedHJWindowTrigger::leftNumberOfHashMaps));
     const auto rightNumberOfHashMaps
@@ -80,67 +116,431 @@ void HJProbePhysicalOperator::open(ExecutionContext& executionCtx, RecordBuffer&
         return;
     }
 
-    /// Getting necessary values from the record buffer
-    const auto windowInfoRef = getMemberRef(hashJoinWindowRef, &EmittedHJWindowTrigger::windowInfo);
-    const nautilus::val<Timestamp> windowStart{readValueFromMemRef<uint64_t>(getMemberRef(windowInfoRef, &WindowInfo::windowStart))};
-    const nautilus::val<Timestamp> windowEnd{readValueFromMemRef<uint64_t>(getMemberRef(windowInfoRef, &WindowInfo::windowEnd))};
+    if (numberOfPartitions > 0 and not lateMaterialization)
+    {
+        probeMergedLeftHashMap(executionCtx, hashJoinWindowRef, windowStart, windowEnd);
+        return;
+    }
     auto leftHashMapRefs = readValueFromMemRef<HashMap**>(getMemberRef(hashJoinWindowRef, &EmittedHJWindowTrigger::leftHashMaps));
     auto rightHashMapRefs = readValueFromMemRef<HashMap**>(getMemberRef(hashJoinWindowRef, &EmittedHJWindowTrigger::rightHashMaps));
+    const auto leftBloomFilterPtr
+        = readValueFromMemRef<BlockedBloomFilter*>(getMemberRef(hashJoinWindowRef, &EmittedHJWindowTrigger::leftBloomFilter));
+    nautilus::val<uint64_t> numberOfRejectedKeys{0};
+    nautilus::val<uint64_t> numberOfFalsePositives{0};
 
-
-    /// We iterate over all "left" hash maps and check if we find a tuple with the same key in the "right" hash maps
-    for (nautilus::val<uint64_t> leftHashMapIndex = 0; leftHashMapIndex < leftNumberOfHashMaps; ++leftHashMapIndex)
+    /// We iterate over all "right" hash maps and check if we find a tuple with the same key in the "left" hash maps.
+    /// The bloom filter of the left slice lets us skip the lookups in all left hash maps for right keys without a join partner.
+    for (nautilus::val<uint64_t> rightHashMapIndex = 0; rightHashMapIndex < rightNumberOfHashMaps; ++rightHashMapIndex)
     {
-        const nautilus::val<HashMap*> leftHashMapPtr = leftHashMapRefs[leftHashMapIndex];
-        ChainedHashMapRef leftHashMap{
-            leftHashMapPtr,
-            leftHashMapOptions.fieldKeys,
-            leftHashMapOptions.fieldValues,
-            leftHashMapOptions.entriesPerPage,
-            leftHashMapOptions.entrySize};
-        for (nautilus::val<uint64_t> rightHashMapIndex = 0; rightHashMapIndex < rightNumberOfHashMaps; ++rightHashMapIndex)
+        const nautilus::val<HashMap*> rightHashMapPtr = rightHashMapRefs[rightHashMapIndex];
+        rightHashMapOptions.visitHashMapRef(
+            rightHashMapPtr,
+            [&](auto& rightHashMap)
+            {
+                for (const auto rightEntry : rightHashMap)
+                {
+                    const ChainedHashMapRef::ChainedEntryRef rightEntryRef{
+                        rightEntry, rightHashMapPtr, rightHashMapOptions.fieldKeys, rightHashMapOptions.fieldValues};
+                    if (not passesBloomFilter(leftBloomFilterPtr, rightEntryRef.getHash()))
+                    {
+                        numberOfRejectedKeys = numberOfRejectedKeys + 1;
+                    }
+                    else
+                    {
+                        nautilus::val<bool> hasJoinPartner{false};
+                        for (nautilus::val<uint64_t> leftHashMapIndex = 0; leftHashMapIndex < leftNumberOfHashMaps; ++leftHashMapIndex)
+                        {
+                            const nautilus::val<HashMap*> leftHashMapPtr = leftHashMapRefs[leftHashMapIndex];
+                            const std::remove_cvref_t<decltype(rightHashMap)> leftHashMap{
+                                leftHashMapPtr,
+                                leftHashMapOptions.fieldKeys,
+                                leftHashMapOptions.fieldValues,
+                                leftHashMapOptions.entriesPerPage,
+                                leftHashMapOptions.entrySize};
+
+                            /// We use here findEntry as the other methods would insert a new entry, which is unnecessary
+                            if (auto leftEntry = leftHashMap.findEntry(rightEntryRef.entryRef))
+                            {
+                                /// At this moment, we can be sure that both paged vector contain only records that satisfy the join
+                                /// condition
+                                const ChainedHashMapRef::ChainedEntryRef leftEntryRef{
+                                    leftEntry, leftHashMapPtr, leftHashMapOptions.fieldKeys, leftHashMapOptions.fieldValues};
+                                if (lateMaterialization)
+                                {
+                                    joinRowChains(
+                                        executionCtx,
+                                        leftEntryRef.getValueMemArea(),
+                                        rightEntryRef.getValueMemArea(),
+                                        windowStart,
+                                        windowEnd);
+                                }
+                                else
+                                {
+                                    joinPagedVectors(
+                                        executionCtx,
+                                        leftEntryRef.getValueMemArea(),
+                                        rightEntryRef.getValueMemArea(),
+                                        windowStart,
+                                        windowEnd);
+                                }
+                                hasJoinPartner = true;
+                            }
+                        }
+                        if (not hasJoinPartner and leftBloomFilterPtr != nullptr)
+                        {
+                            numberOfFalsePositives = numberOfFalsePositives + 1;
+                        }
+                    }
+                }
+            });
+    }
+    addBloomFilterStatistics(executionCtx, numberOfRejectedKeys, numberOfFalsePositives);
+}
+
+void HJProbePhysicalOperator::probeMergedLeftHashMap(
+    ExecutionContext& executionCtx,
+    const nautilus::val<EmittedHJWindowTrigger*>& hashJoinWindowRef,
+    const nautilus::val<Timestamp>& windowStart,
+    const nautilus::val<Timestamp>& windowEnd) const
+{
+    const auto leftNumberOfHashMaps
+        = readValueFromMemRef<uint64_t>(getMemberRef(hashJoinWindowRef, &EmittedHJWindowTrigger::leftNumberOfHashMaps));
+    const auto rightNumberOfHashMaps
+        = readValueFromMemRef<uint64_t>(getMemberRef(hashJoinWindowRef, &EmittedHJWindowTrigger::rightNumberOfHashMaps));
+    auto leftHashMapRefs = readValueFromMemRef<HashMap**>(getMemberRef(hashJoinWindowRef, &EmittedHJWindowTrigger::leftHashMaps));
+    auto rightHashMapRefs = readValueFromMemRef<HashMap**>(getMemberRef(hashJoinWindowRef, &EmittedHJWindowTrigger::rightHashMaps));
+    const auto mergedLeftHashMapPtr
+        = readValueFromMemRef<HashMap*>(getMemberRef(hashJoinWindowRef, &EmittedHJWindowTrigger::mergedLeftHashMapPtr));
+
+    leftHashMapOptions.visitHashMapRef(
+        mergedLeftHashMapPtr,
+        [&](auto& mergedLeftHashMap)
         {
-            const nautilus::val<HashMap*> rightHashMapPtr = rightHashMapRefs[rightHashMapIndex];
-            const ChainedHashMapRef rightHashMap{
-                rightHashMapPtr,
-                rightHashMapOptions.fieldKeys,
-                rightHashMapOptions.fieldValues,
-                rightHashMapOptions.entriesPerPage,
-                rightHashMapOptions.entrySize};
-            for (const auto rightEntry : rightHashMap)
+            /// Merging the left hash maps of all worker threads, so that we probe every right entry only once, regardless of the number of
+            /// worker threads. The merged entries share the pages of the paged vectors with the entries of the left hash maps.
+            /// For both the merge and the probe, we prefetch the merged entries of a group of entries before looking them up.
+            for (nautilus::val<uint64_t> leftHashMapIndex = 0; leftHashMapIndex < leftNumberOfHashMaps; ++leftHashMapIndex)
             {
-                const ChainedHashMapRef::ChainedEntryRef rightEntryRef{
-                    rightEntry, rightHashMapPtr, rightHashMapOptions.fieldKeys, rightHashMapOptions.fieldValues};
-                auto rightPagedVectorMem = rightEntryRef.getValueMemArea();
-                const PagedVectorRef rightPagedVector{rightPagedVectorMem, rightBufferRef};
-                const auto rightFields = rightBufferRef->getAllFieldNames();
-                auto rightItStart = rightPagedVector.begin(rightFields);
-                auto rightItEnd = rightPagedVector.end(rightFields);
-
-                /// We use here findEntry as the other methods would insert a new entry, which is unnecessary
-                if (auto leftEntry = leftHashMap.findEntry(rightEntryRef.entryRef))
+                const nautilus::val<HashMap*> leftHashMapPtr = leftHashMapRefs[leftHashMapIndex];
+                const std::remove_cvref_t<decltype(mergedLeftHashMap)> leftHashMap{
+                    leftHashMapPtr,
+                    leftHashMapOptions.fieldKeys,
+                    leftHashMapOptions.fieldValues,
+                    leftHashMapOptions.entriesPerPage,
+                    leftHashMapOptions.entrySize};
+                const auto leftEntriesEnd = leftHashMap.end();
+                for (auto leftEntries = leftHashMap.begin(); leftEntries != leftEntriesEnd; ++leftEntries)
                 {
-                    /// At this moment, we can be sure that both paged vector contain only records that satisfy the join condition
+                    mergedLeftHashMap.prefetchForEntries(leftEntries);
+                    const auto leftEntry = *leftEntries;
                     const ChainedHashMapRef::ChainedEntryRef leftEntryRef{
                         leftEntry, leftHashMapPtr, leftHashMapOptions.fieldKeys, leftHashMapOptions.fieldValues};
-                    auto leftPagedVectorMem = leftEntryRef.getValueMemArea();
-                    const PagedVectorRef leftPagedVector{leftPagedVectorMem, leftBufferRef};
-                    const auto leftFields = leftBufferRef->getAllFieldNames();
+                    const auto leftPagedVectorMem = leftEntryRef.getValueMemArea();
+                    auto copyPagedVector = [&](const nautilus::val<AbstractHashMapEntry*>& mergedEntry, const bool isNewEntry)
+                    {
+                        const ChainedHashMapRef::ChainedEntryRef mergedEntryRef{
+                            mergedEntry, mergedLeftHashMapPtr, leftHashMapOptions.fieldKeys, leftHashMapOptions.fieldValues};
+                        nautilus::invoke(
+                            +[](int8_t* mergedPagedVectorMemArea, const int8_t* pagedVectorMemArea, const bool createPagedVector)
+                            {
+                                /// NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+                                auto* mergedPagedVector = reinterpret_cast<PagedVector*>(mergedPagedVectorMemArea);
+                                if (createPagedVector)
+                                {
+                                    new (mergedPagedVector) PagedVector();
+                                }
+                                mergedPagedVector->copyFrom(*reinterpret_cast<const PagedVector*>(pagedVectorMemArea));
+                                /// NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+                            },
+                            mergedEntryRef.getValueMemArea(),
+                            leftPagedVectorMem,
+                            nautilus::val<bool>(isNewEntry));
+                    };
+                    mergedLeftHashMap.insertOrUpdateEntry(
+                        leftEntryRef.entryRef,
+                        [&](const nautilus::val<AbstractHashMapEntry*>& mergedEntry) { copyPagedVector(mergedEntry, false); },
+                        [&](const nautilus::val<AbstractHashMapEntry*>& mergedEntry) { copyPagedVector(mergedEntry, true); },
+                        executionCtx.pipelineMemoryProvider.bufferProvider);
+                }
+            }
+
+            /// Probing the merged hash map with all right entries of the partition that pass the bloom filter of the left slice
+            const auto leftBloomFilterPtr
+                = readValueFromMemRef<BlockedBloomFilter*>(getMemberRef(hashJoinWindowRef, &EmittedHJWindowTrigger::leftBloomFilter));
+            nautilus::val<uint64_t> numberOfRejectedKeys{0};
+            nautilus::val<uint64_t> numberOfFalsePositives{0};
+            for (nautilus::val<uint64_t> rightHashMapIndex = 0; rightHashMapIndex < rightNumberOfHashMaps; ++rightHashMapIndex)
+            {
+                const nautilus::val<HashMap*> rightHashMapPtr = rightHashMapRefs[rightHashMapIndex];
+                const std::remove_cvref_t<decltype(mergedLeftHashMap)> rightHashMap{
+                    rightHashMapPtr,
+                    rightHashMapOptions.fieldKeys,
+                    rightHashMapOptions.fieldValues,
+                    rightHashMapOptions.entriesPerPage,
+                    rightHashMapOptions.entrySize};
+                const auto rightEntriesEnd = rightHashMap.end();
+                for (auto rightEntries = rightHashMap.begin(); rightEntries != rightEntriesEnd; ++rightEntries)
+                {
+                    mergedLeftHashMap.prefetchForEntries(rightEntries);
+                    const auto rightEntry = *rightEntries;
+                    const ChainedHashMapRef::ChainedEntryRef rightEntryRef{
+                        rightEntry, rightHashMapPtr, rightHashMapOptions.fieldKeys, rightHashMapOptions.fieldValues};
+                    if (not passesBloomFilter(leftBloomFilterPtr, rightEntryRef.getHash()))
+                    {
+                        numberOfRejectedKeys = numberOfRejectedKeys + 1;
+                    }
+                    else if (auto leftEntry = mergedLeftHashMap.findEntry(rightEntryRef.entryRef))
+                    {
+                        const ChainedHashMapRef::ChainedEntryRef leftEntryRef{
+                            leftEntry, mergedLeftHashMapPtr, leftHashMapOptions.fieldKeys, leftHashMapOptions.fieldValues};
+                        joinPagedVectors(
+                            executionCtx, leftEntryRef.getValueMemArea(), rightEntryRef.getValueMemArea(), windowStart, windowEnd);
+                    }
+                    else if (leftBloomFilterPtr != nullptr)
+                    {
+                        numberOfFalsePositives = numberOfFalsePositives + 1;
+                    }
+                }
+            }
+            addBloomFilterStatistics(executionCtx, numberOfRejectedKeys, numberOfFalsePositives);
 
-                    for (auto leftIt = leftPagedVector.begin(leftFields); leftIt != leftPagedVector.end(leftFields); ++leftIt)
+            /// Releasing the pages of the merged paged vectors, as the merged hash map does not call their destructors
+            for (const auto mergedEntry : mergedLeftHashMap)
+            {
+                const ChainedHashMapRef::ChainedEntryRef mergedEntryRef{
+                    mergedEntry, mergedLeftHashMapPtr, leftHashMapOptions.fieldKeys, leftHashMapOptions.fieldValues};
+                nautilus::invoke(
+                    +[](int8_t* pagedVectorMemArea) -> void
+                    {
+                        /// NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                        auto* pagedVector = reinterpret_cast<PagedVector*>(pagedVectorMemArea);
+                        pagedVector->~PagedVector();
+                    },
+                    mergedEntryRef.getValueMemArea());
+            }
+        });
+
+    nautilus::invoke(
+        +[](EmittedHJWindowTrigger* emittedHJWindowTrigger)
+        {
+            NES_TRACE(
+                "Resetting merged left hash map of hash join window start at {} and end at {}",
+                emittedHJWindowTrigger->windowInfo.windowStart,
+                emittedHJWindowTrigger->windowInfo.windowEnd);
+            emittedHJWindowTrigger->mergedLeftHashMap.reset();
+        },
+        hashJoinWindowRef);
+}
+
+void HJProbePhysicalOperator::probeStreamedRows(
+    ExecutionContext& executionCtx,
+    const nautilus::val<EmittedHJWindowTrigger*>& hashJoinWindowRef,
+    const nautilus::val<Timestamp>& windowStart,
+    const nautilus::val<Timestamp>& windowEnd) const
+{
+    const auto streamedLeft = streamedSide == JoinBuildSideType::Left;
+    const auto& hashedOptions = streamedLeft ? rightHashMapOptions : leftHashMapOptions;
+    const auto& streamedOptions = streamedLeft ? leftHashMapOptions : rightHashMapOptions;
+    const auto& streamedBufferRef = streamedLeft ? leftBufferRef : rightBufferRef;
+    const auto hashedNumberOfHashMaps = readValueFromMemRef<uint64_t>(getMemberRef(
+        hashJoinWindowRef, streamedLeft ? &EmittedHJWindowTrigger::rightNumberOfHashMaps : &EmittedHJWindowTrigger::leftNumberOfHashMaps));
+    const auto numberOfStreamedRows
+        = readValueFromMemRef<uint64_t>(getMemberRef(hashJoinWindowRef, &EmittedHJWindowTrigger::numberOfStreamedRows));
+    if (hashedNumberOfHashMaps == 0 or numberOfStreamedRows == 0)
+    {
+        return;
+    }
+    auto hashedHashMapRefs = readValueFromMemRef<HashMap**>(
+        getMemberRef(hashJoinWindowRef, streamedLeft ? &EmittedHJWindowTrigger::rightHashMaps : &EmittedHJWindowTrigger::leftHashMaps));
+    auto streamedRowsRefs = readValueFromMemRef<PagedVector**>(getMemberRef(hashJoinWindowRef, &EmittedHJWindowTrigger::streamedRows));
+
+    /// The bloom filter only contains the keys of the left side. Thus, only the tuples of a streamed right side can skip their lookups.
+    nautilus::val<BlockedBloomFilter*> leftBloomFilterPtr{nullptr};
+    if (not streamedLeft)
+    {
+        leftBloomFilterPtr
+            = readValueFromMemRef<BlockedBloomFilter*>(getMemberRef(hashJoinWindowRef, &EmittedHJWindowTrigger::leftBloomFilter));
+    }
+    nautilus::val<uint64_t> numberOfRejectedKeys{0};
+    nautilus::val<uint64_t> numberOfFalsePositives{0};
+
+    const auto streamedFields = streamedBufferRef->getAllFieldNames();
+    const nautilus::val<HashMap*> firstHashedHashMapPtr = hashedHashMapRefs[0];
+    hashedOptions.visitHashMapRef(
+        firstHashedHashMapPtr,
+        [&](auto& firstHashedHashMap)
+        {
+            for (nautilus::val<uint64_t> streamedRowsIndex = 0; streamedRowsIndex < numberOfStreamedRows; ++streamedRowsIndex)
+            {
+                const nautilus::val<PagedVector*> streamedRowsPtr = streamedRowsRefs[streamedRowsIndex];
+                const PagedVectorRef streamedRows{streamedRowsPtr, streamedBufferRef};
+                const auto streamedRowsEnd = streamedRows.end(streamedFields);
+                for (auto streamedRowsIt = streamedRows.begin(streamedFields); streamedRowsIt != streamedRowsEnd; ++streamedRowsIt)
+                {
+                    /// The build has cast the keys of both sides to the same data types. Thus, we hash the keys of the streamed tuple
+                    /// once and look them up under the key fields of the hashed side.
+                    const auto streamedRecord = *streamedRowsIt;
+                    Record keyRecord;
+                    std::vector<VarVal> keyValues;
+                    for (nautilus::static_val<uint64_t> i = 0; i < hashedOptions.fieldKeys.size(); ++i)
+                    {
+                        const auto value = streamedRecord.read(streamedOptions.fieldKeys[i].fieldIdentifier);
+                        keyRecord.write(hashedOptions.fieldKeys[i].fieldIdentifier, value);
+                        keyValues.emplace_back(value);
+                    }
+                    const auto hash = hashedOptions.hashFunction->calculate(keyValues);
+                    if (not passesBloomFilter(leftBloomFilterPtr, hash))
+                    {
+                        numberOfRejectedKeys = numberOfRejectedKeys + 1;
+                    }
+                    else
                     {
-                        for (auto rightIt = rightItStart; rightIt != rightItEnd; ++rightIt)
+                        nautilus::val<bool> hasJoinPartner{false};
+                        for (nautilus::val<uint64_t> hashMapIndex = 0; hashMapIndex < hashedNumberOfHashMaps; ++hashMapIndex)
+                        {
+                            const nautilus::val<HashMap*> hashedHashMapPtr = hashedHashMapRefs[hashMapIndex];
+                            const std::remove_cvref_t<decltype(firstHashedHashMap)> hashedHashMap{
+                                hashedHashMapPtr,
+                                hashedOptions.fieldKeys,
+                                hashedOptions.fieldValues,
+                                hashedOptions.entriesPerPage,
+                                hashedOptions.entrySize};
+                            if (const auto hashedEntry = hashedHashMap.findEntry(keyRecord, hash))
+                            {
+                                const ChainedHashMapRef::ChainedEntryRef hashedEntryRef{
+                                    hashedEntry, hashedHashMapPtr, hashedOptions.fieldKeys, hashedOptions.fieldValues};
+                                joinStreamedRecord(executionCtx, streamedRecord, hashedEntryRef.getValueMemArea(), windowStart, windowEnd);
+                                hasJoinPartner = true;
+                            }
+                        }
+                        if (not hasJoinPartner and leftBloomFilterPtr != nullptr)
                         {
-                            const auto leftRecord = *leftIt;
-                            const auto rightRecord = *rightIt;
-                            auto joinedRecord
-                                = createJoinedRecord(leftRecord, rightRecord, windowStart, windowEnd, leftFields, rightFields);
-                            executeChild(executionCtx, joinedRecord);
+                            numberOfFalsePositives = numberOfFalsePositives + 1;
                         }
                     }
                 }
             }
+        });
+    addBloomFilterStatistics(executionCtx, numberOfRejectedKeys, numberOfFalsePositives);
+}
+
+void HJProbePhysicalOperator::joinStreamedRecord(
+    ExecutionContext& executionCtx,
+    const Record& streamedRecord,
+    const nautilus::val<int8_t*>& hashedPagedVectorMem,
+    const nautilus::val<Timestamp>& windowStart,
+    const nautilus::val<Timestamp>& windowEnd) const
+{
+    const auto streamedLeft = streamedSide == JoinBuildSideType::Left;
+    const PagedVectorRef hashedPagedVector{
+        static_cast<nautilus::val<PagedVector*>>(hashedPagedVectorMem), streamedLeft ? rightBufferRef : leftBufferRef};
+    const auto leftFields = leftBufferRef->getAllFieldNames();
+    const auto rightFields = rightBufferRef->getAllFieldNames();
+    const auto& hashedFields = streamedLeft ? rightFields : leftFields;
+    const auto hashedEnd = hashedPagedVector.end(hashedFields);
+    for (auto hashedIt = hashedPagedVector.begin(hashedFields); hashedIt != hashedEnd; ++hashedIt)
+    {
+        const auto hashedRecord = *hashedIt;
+        auto joinedRecord = streamedLeft
+            ? createJoinedRecord(streamedRecord, hashedRecord, windowStart, windowEnd, leftFields, rightFields)
+            : createJoinedRecord(hashedRecord, streamedRecord, windowStart, windowEnd, leftFields, rightFields);
+        executeChild(executionCtx, joinedRecord);
+    }
+}
+
+nautilus::val<bool>
+HJProbePhysicalOperator::passesBloomFilter(const nautilus::val<BlockedBloomFilter*>& bloomFilterPtr, const HashFunction::HashValue& hash)
+{
+    /// Slices without a bloom filter let all keys pass
+    nautilus::val<bool> mayContain{true};
+    if (bloomFilterPtr != nullptr)
+    {
+        const BlockedBloomFilterRef bloomFilter{bloomFilterPtr};
+        mayContain = bloomFilter.mayContain(hash);
+    }
+    return mayContain;
+}
+
+void HJProbePhysicalOperator::addBloomFilterStatistics(
+    ExecutionContext& executionCtx,
+    const nautilus::val<uint64_t>& numberOfRejectedKeys,
+    const nautilus::val<uint64_t>& numberOfFalsePositives) const
+{
+    if (numberOfRejectedKeys > 0 or numberOfFalsePositives > 0)
+    {
+        nautilus::invoke(
+            +[](OperatorHandler* operatorHandler, const uint64_t numberOfRejectedKeysVal, const uint64_t numberOfFalsePositivesVal)
+            {
+                auto* const hjOperatorHandler = dynamic_cast<HJOperatorHandler*>(operatorHandler);
+                INVARIANT(hjOperatorHandler != nullptr, "The operator handler of a HJProbePhysicalOperator should be a HJOperatorHandler");
+                hjOperatorHandler->addBloomFilterStatistics(
+                    {.numberOfRejectedKeys = numberOfRejectedKeysVal, .numberOfFalsePositives = numberOfFalsePositivesVal});
+            },
+            executionCtx.getGlobalOperatorHandler(operatorHandlerId),
+            numberOfRejectedKeys,
+            numberOfFalsePositives);
+    }
+}
+
+void HJProbePhysicalOperator::joinPagedVectors(
+    ExecutionContext& executionCtx,
+    const nautilus::val<int8_t*>& leftPagedVectorMem,
+    const nautilus::val<int8_t*>& rightPagedVectorMem,
+    const nautilus::val<Timestamp>& windowStart,
+    const nautilus::val<Timestamp>& windowEnd) const
+{
+    const PagedVectorRef leftPagedVector{static_cast<nautilus::val<PagedVector*>>(leftPagedVectorMem), leftBufferRef};
+    const PagedVectorRef rightPagedVector{static_cast<nautilus::val<PagedVector*>>(rightPagedVectorMem), rightBufferRef};
+    const auto leftFields = leftBufferRef->getAllFieldNames();
+    const auto rightFields = rightBufferRef->getAllFieldNames();
+    auto rightItStart = rightPagedVector.begin(rightFields);
+    auto rightItEnd = rightPagedVector.end(rightFields);
+    for (auto leftIt = leftPagedVector.begin(leftFields); leftIt != leftPagedVector.end(leftFields); ++leftIt)
+    {
+        for (auto rightIt = rightItStart; rightIt != rightItEnd; ++rightIt)
+        {
+            const auto leftRecord = *leftIt;
+            const auto rightRecord = *rightIt;
+            auto joinedRecord = createJoinedRecord(leftRecord, rightRecord, windowStart, windowEnd, leftFields, rightFields);
+            executeChild(executionCtx, joinedRecord);
+        }
+    }
+}
+
+void HJProbePhysicalOperator::joinRowChains(
+    ExecutionContext& executionCtx,
+    const nautilus::val<int8_t*>& leftRowChainMem,
+    const nautilus::val<int8_t*>& rightRowChainMem,
+    const nautilus::val<Timestamp>& windowStart,
+    const nautilus::val<Timestamp>& windowEnd) const
+{
+    const PagedVectorRef leftRows{readValueFromMemRef<PagedVector*>(getMemberRef(leftRowChainMem, &HJRowChain::rows)), leftBufferRef};
+    const PagedVectorRef rightRows{readValueFromMemRef<PagedVector*>(getMemberRef(rightRowChainMem, &HJRowChain::rows)), rightBufferRef};
+    const auto rightLastRow = readValueFromMemRef<uint64_t>(getMemberRef(rightRowChainMem, &HJRowChain::lastRow));
+
+    /// The rows store the previous row of their key in addition to the fields of the tuple, which the joined record must not contain
+    const auto withoutPreviousRow = [](std::vector<Record::RecordFieldIdentifier> fields)
+    {
+        std::erase(fields, HJ_PREVIOUS_ROW_FIELD);
+        return fields;
+    };
+    const auto leftRowFields = leftBufferRef->getAllFieldNames();
+    const auto rightRowFields = rightBufferRef->getAllFieldNames();
+    const auto leftFields = withoutPreviousRow(leftRowFields);
+    const auto rightFields = withoutPreviousRow(rightRowFields);
+
+    /// Positions are stored + 1, as 0 ends the chain of rows
+    for (auto leftRow = readValueFromMemRef<uint64_t>(getMemberRef(leftRowChainMem, &HJRowChain::lastRow)); leftRow != 0;)
+    {
+        const auto leftRecord = leftRows.readRecord(leftRow - 1, leftRowFields);
+        for (auto rightRow = rightLastRow; rightRow != 0;)
+        {
+            const auto rightRecord = rightRows.readRecord(rightRow - 1, rightRowFields);
+            auto joinedRecord = createJoinedRecord(leftRecord, rightRecord, windowStart, windowEnd, leftFields, rightFields);
+            executeChild(executionCtx, joinedRecord);
+            rightRow = rightRecord.read(HJ_PREVIOUS_ROW_FIELD).getRawValueAs<nautilus::val<uint64_t>>();
         }
+        leftRow = leftRecord.read(HJ_PREVIOUS_ROW_FIELD).getRawValueAs<nautilus::val<uint64_t>>();
     }
 }
 }
@@ -19,8 +19,9 @@
 #include <vector>
 #include <Identifiers/Identifiers.hpp>
 #include <Join/StreamJoinUtil.hpp>
-#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMap.hpp>
+#include <Nautilus/Interface/BloomFilter/BlockedBloomFilter.hpp>
 #include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Nautilus/Interface/PagedVector/PagedVector.hpp>
 #include <SliceStore/Slice.hpp>
 #include <ErrorHandling.hpp>
 #include <HashMapSlice.hpp>
@@ -28,54 +29,111 @@
 namespace NES
 {
 HJSlice::HJSlice(
-    SliceStart sliceStart, SliceEnd sliceEnd, const CreateNewHashMapSliceArgs& createNewHashMapSliceArgs, const uint64_t numberOfHashMaps)
-    : HashMapSlice(std::move(sliceStart), std::move(sliceEnd), createNewHashMapSliceArgs, numberOfHashMaps, 2)
+    SliceStart sliceStart,
+    SliceEnd sliceEnd,
+    const CreateNewHashMapSliceArgs& createNewHashMapSliceArgs,
+    const uint64_t numberOfHashMaps,
+    const uint64_t numberOfPartitions,
+    const uint64_t bloomFilterBitsPerKey)
+    : HashMapSlice(std::move(sliceStart), std::move(sliceEnd), createNewHashMapSliceArgs, numberOfHashMaps, 2, numberOfPartitions)
+    , numberOfCacheLinesPerWorkerThread((2 * numberOfPartitions + COUNTERS_PER_CACHE_LINE - 1) / COUNTERS_PER_CACHE_LINE)
+    , recordCounters(numberOfHashMaps * numberOfCacheLinesPerWorkerThread)
+    , rows(hashMaps.size())
 {
+    if (bloomFilterBitsPerKey > 0)
+    {
+        /// The number of buckets is the expected number of keys per hash map
+        const auto expectedNumberOfKeys = createNewHashMapSliceArgs.getNumberOfBuckets(0) * numberOfHashMapsPerInputStream;
+        leftBloomFilter = std::make_unique<BlockedBloomFilter>(expectedNumberOfKeys, bloomFilterBitsPerKey);
+    }
 }
 
-HashMap* HJSlice::getHashMapPtr(const WorkerThreadId workerThreadId, const JoinBuildSideType& buildSide) const
+uint64_t HJSlice::getInputStream(const JoinBuildSideType& buildSide)
 {
-    /// Hashmaps of the left build side come before right
-    auto pos = (workerThreadId % numberOfHashMapsPerInputStream)
-        + ((static_cast<uint64_t>(buildSide == JoinBuildSideType::Right) * numberOfHashMapsPerInputStream));
-
-    INVARIANT(
-        not hashMaps.empty() and pos < hashMaps.size(),
-        "No hashmap found for workerThreadId {} at pos {} for {} hashmaps",
-        workerThreadId,
-        pos,
-        hashMaps.size());
-    return hashMaps[pos].get();
+    return static_cast<uint64_t>(buildSide == JoinBuildSideType::Right);
 }
 
-HashMap* HJSlice::getHashMapPtrOrCreate(const WorkerThreadId workerThreadId, const JoinBuildSideType& buildSide)
+HashMap* HJSlice::getHashMapPtr(const WorkerThreadId workerThreadId, const JoinBuildSideType& buildSide, const uint64_t partition) const
 {
-    /// Hashmaps of the left build side come before right
-    auto pos = (workerThreadId % numberOfHashMapsPerInputStream)
-        + ((static_cast<uint64_t>(buildSide == JoinBuildSideType::Right) * numberOfHashMapsPerInputStream));
-
-    INVARIANT(
-        not hashMaps.empty() and pos < hashMaps.size(),
-        "No hashmap found for workerThreadId {} at pos {} for {} hashmaps",
-        workerThreadId,
-        pos,
-        hashMaps.size());
+    return hashMaps[getHashMapPos(workerThreadId, getInputStream(buildSide), partition)].get();
+}
 
+HashMap* HJSlice::getHashMapPtrOrCreate(const WorkerThreadId workerThreadId, const JoinBuildSideType& buildSide, const uint64_t partition)
+{
+    const auto pos = getHashMapPos(workerThreadId, getInputStream(buildSide), partition);
     if (hashMaps.at(pos) == nullptr)
     {
         /// Hashmap at pos has not been initialized
-        hashMaps.at(pos) = std::make_unique<ChainedHashMap>(
-            createNewHashMapSliceArgs.keySize,
-            createNewHashMapSliceArgs.valueSize,
-            createNewHashMapSliceArgs.numberOfBuckets,
-            createNewHashMapSliceArgs.pageSize);
+        hashMaps.at(pos) = createHashMap(getInputStream(buildSide));
     }
     return hashMaps.at(pos).get();
 }
 
+std::vector<HashMap*> HJSlice::getHashMapPtrsOfPartition(const JoinBuildSideType& buildSide, const uint64_t partition) const
+{
+    return HashMapSlice::getHashMapPtrsOfPartition(getInputStream(buildSide), partition);
+}
+
+uint64_t
+HJSlice::getRecordCounterPos(const WorkerThreadId workerThreadId, const JoinBuildSideType& buildSide, const uint64_t partition) const
+{
+    /// The counters of a worker thread are stored as [Left: Partition 0, Partition 1, ...][Right: Partition 0, Partition 1, ...]
+    INVARIANT(partition < numberOfPartitions, "Invalid partition {} for {} partitions", partition, numberOfPartitions);
+    return ((workerThreadId % getNumberOfWorkerThreads()) * numberOfCacheLinesPerWorkerThread * COUNTERS_PER_CACHE_LINE)
+        + (static_cast<uint64_t>(buildSide == JoinBuildSideType::Right) * numberOfPartitions) + partition;
+}
+
+void HJSlice::addRecord(const WorkerThreadId workerThreadId, const JoinBuildSideType& buildSide, const uint64_t partition)
+{
+    const auto pos = getRecordCounterPos(workerThreadId, buildSide, partition);
+    ++recordCounters[pos / COUNTERS_PER_CACHE_LINE].numberOfRecords[pos % COUNTERS_PER_CACHE_LINE];
+}
+
+uint64_t
+HJSlice::getNumberOfRecords(const WorkerThreadId workerThreadId, const JoinBuildSideType& buildSide, const uint64_t partition) const
+{
+    const auto pos = getRecordCounterPos(workerThreadId, buildSide, partition);
+    return recordCounters[pos / COUNTERS_PER_CACHE_LINE].numberOfRecords[pos % COUNTERS_PER_CACHE_LINE];
+}
+
+uint64_t HJSlice::getNumberOfRecordsOfPartition(const JoinBuildSideType& buildSide, const uint64_t partition) const
+{
+    uint64_t numberOfRecords = 0;
+    for (uint64_t workerThread = 0; workerThread < getNumberOfWorkerThreads(); ++workerThread)
+    {
+        numberOfRecords += getNumberOfRecords(WorkerThreadId(workerThread), buildSide, partition);
+    }
+    return numberOfRecords;
+}
+
 uint64_t HJSlice::getNumberOfHashMapsForSide() const
 {
     return numberOfHashMapsPerInputStream;
 }
 
+BlockedBloomFilter* HJSlice::getLeftBloomFilter() const
+{
+    return leftBloomFilter.get();
+}
+
+PagedVector* HJSlice::getRowsPtrOrCreate(const WorkerThreadId workerThreadId, const JoinBuildSideType& buildSide, const uint64_t partition)
+{
+    const auto pos = getHashMapPos(workerThreadId, getInputStream(buildSide), partition);
+    if (rows.at(pos) == nullptr)
+    {
+        rows.at(pos) = std::make_unique<PagedVector>();
+    }
+    return rows.at(pos).get();
+}
+
+std::vector<PagedVector*> HJSlice::getRowsPtrsOfPartition(const JoinBuildSideType& buildSide, const uint64_t partition) const
+{
+    std::vector<PagedVector*> rowsOfPartition;
+    for (uint64_t workerThread = 0; workerThread < getNumberOfWorkerThreads(); ++workerThread)
+    {
+        rowsOfPartition.emplace_back(rows[getHashMapPos(WorkerThreadId(workerThread), getInputStream(buildSide), partition)].get());
+    }
+    return rowsOfPartition;
+}
+
 }
@@ -0,0 +1,165 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Join/HashJoin/MultiwayHJBuildPhysicalOperator.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <Identifiers/Identifiers.hpp>
+#include <Join/HashJoin/HJBuildPhysicalOperator.hpp>
+#include <Join/HashJoin/MultiwayHJOperatorHandler.hpp>
+#include <Join/HashJoin/MultiwayHJSlice.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMapRef.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Nautilus/Interface/PagedVector/PagedVector.hpp>
+#include <Nautilus/Interface/PagedVector/PagedVectorRef.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Time/Timestamp.hpp>
+#include <CompilationContext.hpp>
+#include <ErrorHandling.hpp>
+#include <ExecutionContext.hpp>
+#include <HashMapSlice.hpp>
+#include <WindowBuildPhysicalOperator.hpp>
+#include <function.hpp>
+#include <static.hpp>
+#include <val_bool.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+MultiwayHJSlice* getMultiwayHashJoinSliceProxy(
+    const MultiwayHJOperatorHandler* operatorHandler,
+    const Timestamp timestamp,
+    const WorkerThreadId workerThreadId,
+    const MultiwayHJBuildPhysicalOperator* buildOperator)
+{
+    PRECONDITION(operatorHandler != nullptr, "The operator handler should not be null");
+    PRECONDITION(buildOperator != nullptr, "The build operator should not be null");
+
+    const CreateNewHashMapSliceArgs hashMapSliceArgs{
+        operatorHandler->getNautilusCleanupExec(),
+        buildOperator->hashMapOptions.keySize,
+        buildOperator->hashMapOptions.valueSize,
+        buildOperator->hashMapOptions.pageSize,
+        buildOperator->hashMapOptions.numberOfBuckets,
+        buildOperator->hashMapOptions.hashMapType};
+    const auto slices = operatorHandler->getSliceAndWindowStore().getSlicesOrCreate(
+        timestamp, workerThreadId, operatorHandler->getCreateNewSlicesFunction(hashMapSliceArgs));
+    INVARIANT(
+        slices.size() == 1,
+        "We expect exactly one slice for the given timestamp during the MultiwayHashJoinBuild, as we currently solely support "
+        "slicing, but got {}",
+        slices.size());
+
+    /// The slice store keeps the slice alive until the window of the slice has been triggered
+    auto* const slice = dynamic_cast<MultiwayHJSlice*>(slices[0].get());
+    INVARIANT(slice != nullptr, "The slice should be a MultiwayHJSlice in a MultiwayHJBuildPhysicalOperator");
+    return slice;
+}
+
+HashMap* getMultiwayHashJoinHashMapProxy(MultiwayHJSlice* slice, const WorkerThreadId workerThreadId, const uint64_t input)
+{
+    PRECONDITION(slice != nullptr, "The slice should not be null");
+    return slice->getHashMapPtrOrCreate(workerThreadId, input);
+}
+
+void MultiwayHJBuildPhysicalOperator::setup(ExecutionContext& executionCtx, CompilationContext& compilationContext) const
+{
+    WindowBuildPhysicalOperator::setup(executionCtx, compilationContext);
+
+    auto* const operatorHandler = dynamic_cast<MultiwayHJOperatorHandler*>(
+        nautilus::details::RawValueResolver<OperatorHandler*>::getRawValue(executionCtx.getGlobalOperatorHandler(operatorHandlerId)));
+    if (operatorHandler->wasSetupCalled(input))
+    {
+        return;
+    }
+    operatorHandler->setNautilusCleanupExec(compileHashJoinCleanupFunction(compilationContext, hashMapOptions), input);
+}
+
+void MultiwayHJBuildPhysicalOperator::execute(ExecutionContext& ctx, Record& record) const
+{
+    auto* localState = dynamic_cast<WindowOperatorBuildLocalState*>(ctx.getLocalState(id));
+    auto operatorHandler = localState->getOperatorHandler();
+
+    /// Calling the key functions to add/update the keys to the record
+    nautilus::val<bool> containsNullInKey{false};
+    for (nautilus::static_val<uint64_t> i = 0; i < hashMapOptions.fieldKeys.size(); ++i)
+    {
+        const auto& [fieldIdentifier, type, fieldOffset, varSizedDictionary] = hashMapOptions.fieldKeys[i];
+        const auto value = hashMapOptions.keyFunctions[i].execute(record, ctx.pipelineMemoryProvider.arena);
+        containsNullInKey = containsNullInKey or (value.isNullable() and value.isNull());
+        record.write(fieldIdentifier, value);
+    }
+
+    /// Get the current slice / hash map that we have to insert the tuple into
+    const auto timestamp = timeFunction->getTs(ctx, record);
+    const auto slicePtr = invoke(
+        getMultiwayHashJoinSliceProxy,
+        operatorHandler,
+        timestamp,
+        ctx.workerThreadId,
+        nautilus::val<const MultiwayHJBuildPhysicalOperator*>(this));
+    const auto hashMapPtr = invoke(getMultiwayHashJoinHashMapProxy, slicePtr, ctx.workerThreadId, nautilus::val<uint64_t>(input));
+
+    /// As an inner join requires all join conditions to be TRUE, tuples with a null key never join
+    if (not containsNullInKey)
+    {
+        /// Finding or creating the entry for the provided record, whose value is the paged vector of all tuples with the key
+        const auto hashMapEntry = hashMapOptions.visitHashMapRef(
+            hashMapPtr,
+            [&](auto& hashMap)
+            {
+                return hashMap.findOrCreateEntry(
+                    record,
+                    *hashMapOptions.hashFunction,
+                    [&](const nautilus::val<AbstractHashMapEntry*>& entry)
+                    {
+                        const ChainedHashMapRef::ChainedEntryRef entryRefReset{
+                            entry, hashMapPtr, hashMapOptions.fieldKeys, hashMapOptions.fieldValues};
+                        nautilus::invoke(
+                            +[](int8_t* pagedVectorMemArea) -> void
+                            {
+                                /// NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                                auto* pagedVector = reinterpret_cast<PagedVector*>(pagedVectorMemArea);
+                                new (pagedVector) PagedVector();
+                            },
+                            entryRefReset.getValueMemArea());
+                    },
+                    ctx.pipelineMemoryProvider.bufferProvider);
+            });
+
+        const ChainedHashMapRef::ChainedEntryRef entryRef{hashMapEntry, hashMapPtr, hashMapOptions.fieldKeys, hashMapOptions.fieldValues};
+        auto entryMemArea = entryRef.getValueMemArea();
+        const PagedVectorRef pagedVectorRef(entryMemArea, bufferRef);
+        pagedVectorRef.writeRecord(record, ctx.pipelineMemoryProvider.bufferProvider);
+    }
+}
+
+MultiwayHJBuildPhysicalOperator::MultiwayHJBuildPhysicalOperator(
+    const OperatorHandlerId operatorHandlerId,
+    const uint64_t input,
+    std::unique_ptr<TimeFunction> timeFunction,
+    std::shared_ptr<TupleBufferRef> bufferRef,
+    HashMapOptions hashMapOptions)
+    : WindowBuildPhysicalOperator(operatorHandlerId, std::move(timeFunction))
+    , input(input)
+    , bufferRef(std::move(bufferRef))
+    , hashMapOptions(std::move(hashMapOptions))
+{
+}
+
+}
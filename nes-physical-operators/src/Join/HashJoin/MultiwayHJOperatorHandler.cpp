@@ -0,0 +1,215 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Join/HashJoin/MultiwayHJOperatorHandler.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+#include <Join/HashJoin/MultiwayHJSlice.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Runtime/QueryTerminationType.hpp>
+#include <Sequencing/SequenceData.hpp>
+#include <SliceStore/Slice.hpp>
+#include <SliceStore/WindowSlicesStoreInterface.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <folly/Synchronized.h>
+#include <ErrorHandling.hpp>
+#include <HashMapSlice.hpp>
+#include <PipelineExecutionContext.hpp>
+#include <WindowBasedOperatorHandler.hpp>
+
+namespace NES
+{
+MultiwayHJOperatorHandler::MultiwayHJOperatorHandler(
+    const std::vector<OriginId>& inputOrigins,
+    const OriginId outputOriginId,
+    std::unique_ptr<WindowSlicesStoreInterface> sliceAndWindowStore,
+    const uint64_t numberOfInputs,
+    const uint64_t maxNumberOfBuckets)
+    : WindowBasedOperatorHandler(inputOrigins, outputOriginId, std::move(sliceAndWindowStore))
+    , numberOfInputs(numberOfInputs)
+    , setupAlreadyCalled(numberOfInputs)
+    , cleanupStateNautilusFunctions(numberOfInputs)
+    , rollingAverageNumberOfKeys(RollingAverage<uint64_t>{100})
+    , maxNumberOfBuckets(maxNumberOfBuckets)
+    , hashMapGrowthStatistics(std::make_shared<folly::Synchronized<HashMapGrowthStatistics>>())
+    , hashMapPool(std::make_shared<HashMapPool>())
+{
+    PRECONDITION(numberOfInputs > 2, "A multiway hash join requires more than two inputs, but got {}", numberOfInputs);
+}
+
+void MultiwayHJOperatorHandler::stop(const QueryTerminationType queryTerminationType, PipelineExecutionContext& pipelineExecutionContext)
+{
+    WindowBasedOperatorHandler::stop(queryTerminationType, pipelineExecutionContext);
+    logHashMapGrowthStatistics(getHashMapGrowthStatistics(), outputOriginId);
+}
+
+std::function<std::vector<std::shared_ptr<Slice>>(SliceStart, SliceEnd)>
+MultiwayHJOperatorHandler::getCreateNewSlicesFunction(const CreateNewSlicesArguments& newSlicesArguments) const
+{
+    PRECONDITION(
+        numberOfWorkerThreads > 0, "Number of worker threads not set for window based operator. Has setWorkerThreads() being called?");
+
+    auto newHashMapArgs = dynamic_cast<const CreateNewHashMapSliceArgs&>(newSlicesArguments);
+    newHashMapArgs.numberOfBuckets
+        = getNumberOfBucketsOfObservedKeys(*rollingAverageNumberOfKeys.rlock(), newHashMapArgs.numberOfBuckets, maxNumberOfBuckets);
+    newHashMapArgs.growthStatistics = hashMapGrowthStatistics;
+    newHashMapArgs.hashMapPool = hashMapPool;
+    return std::function(
+        [outputOriginId = outputOriginId,
+         numberOfWorkerThreads = numberOfWorkerThreads,
+         numberOfInputs = numberOfInputs,
+         copyOfNewHashMapArgs = newHashMapArgs](SliceStart sliceStart, SliceEnd sliceEnd) -> std::vector<std::shared_ptr<Slice>>
+        {
+            NES_TRACE("Creating new multiway hash-join slice for slice {}-{} for output origin {}", sliceStart, sliceEnd, outputOriginId);
+            return {std::make_shared<MultiwayHJSlice>(sliceStart, sliceEnd, copyOfNewHashMapArgs, numberOfWorkerThreads, numberOfInputs)};
+        });
+}
+
+HashMapGrowthStatistics MultiwayHJOperatorHandler::getHashMapGrowthStatistics() const
+{
+    return *hashMapGrowthStatistics->rlock();
+}
+
+bool MultiwayHJOperatorHandler::wasSetupCalled(const uint64_t input)
+{
+    bool expectedValue = false;
+    return not setupAlreadyCalled.at(input).compare_exchange_strong(expectedValue, true);
+}
+
+void MultiwayHJOperatorHandler::setNautilusCleanupExec(
+    std::shared_ptr<CreateNewHashMapSliceArgs::NautilusCleanupExec> nautilusCleanupExec, const uint64_t input)
+{
+    cleanupStateNautilusFunctions.at(input) = std::move(nautilusCleanupExec);
+}
+
+std::vector<std::shared_ptr<CreateNewHashMapSliceArgs::NautilusCleanupExec>> MultiwayHJOperatorHandler::getNautilusCleanupExec() const
+{
+    return cleanupStateNautilusFunctions;
+}
+
+void MultiwayHJOperatorHandler::triggerSlices(
+    const std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>>& slicesAndWindowInfo,
+    PipelineExecutionContext* pipelineCtx)
+{
+    /// As for a binary join, the probe has to see all combinations of slices of a window. Windows of tumbling windows consist of a single
+    /// slice, thus, they emit a single probe task.
+    for (const auto& [windowInfo, allSlices] : slicesAndWindowInfo)
+    {
+        uint64_t numberOfProbeTasks = 1;
+        for (uint64_t input = 0; input < numberOfInputs; ++input)
+        {
+            numberOfProbeTasks *= allSlices.size();
+        }
+
+        /// Enumerating the combinations by counting in the base of the number of slices, one digit per input
+        std::vector<uint64_t> sliceOfInput(numberOfInputs, 0);
+        std::vector<const Slice*> slicesOfInputs(numberOfInputs, allSlices.front().get());
+        for (ChunkNumber::Underlying chunkNumber = ChunkNumber::INITIAL; chunkNumber <= numberOfProbeTasks; ++chunkNumber)
+        {
+            const bool isLastChunk = chunkNumber == numberOfProbeTasks;
+            const SequenceData sequenceData{windowInfo.sequenceNumber, ChunkNumber(chunkNumber), isLastChunk};
+            emitSlicesToProbe(slicesOfInputs, windowInfo.windowInfo, sequenceData, pipelineCtx);
+            for (uint64_t input = 0; input < numberOfInputs; ++input)
+            {
+                sliceOfInput[input] = (sliceOfInput[input] + 1) % allSlices.size();
+                slicesOfInputs[input] = allSlices[sliceOfInput[input]].get();
+                if (sliceOfInput[input] != 0)
+                {
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void MultiwayHJOperatorHandler::emitSlicesToProbe(
+    const std::vector<const Slice*>& slicesOfInputs,
+    const WindowInfo& windowInfo,
+    const SequenceData& sequenceData,
+    PipelineExecutionContext* pipelineCtx)
+{
+    /// Counting how many tuples the probe has to check for this probe task
+    uint64_t totalNumberOfTuples = 0;
+    uint64_t totalNumberOfHashMaps = 0;
+    std::vector<std::vector<HashMap*>> hashMapsOfInputs(numberOfInputs);
+    IngestionTimestamps ingestionTimestamps;
+    for (uint64_t input = 0; input < numberOfInputs; ++input)
+    {
+        const auto* const hashJoinSlice = dynamic_cast<const MultiwayHJSlice*>(slicesOfInputs[input]);
+        INVARIANT(hashJoinSlice != nullptr, "Slice must be of type MultiwayHJSlice!");
+        for (auto* hashMap : hashJoinSlice->getHashMapPtrsOfInput(input))
+        {
+            if (hashMap and hashMap->getNumberOfTuples() > 0)
+            {
+                /// As the hashmap has one value per key, we can use the number of tuples for the number of keys
+                rollingAverageNumberOfKeys.wlock()->add(hashMap->getNumberOfTuples());
+                hashMapsOfInputs[input].emplace_back(hashMap);
+                totalNumberOfTuples += hashMap->getNumberOfTuples();
+            }
+        }
+        totalNumberOfHashMaps += hashMapsOfInputs[input].size();
+        ingestionTimestamps.merge(hashJoinSlice->getIngestionTimestamps());
+    }
+
+    /// We need a buffer that is large enough to store:
+    /// - size of EmittedMultiwayHJWindowTrigger
+    /// - the number of hash maps and the pointer to the first hash map pointer of every input
+    /// - all pointers to the hashmaps of all inputs of the window to be triggered
+    const auto neededBufferSize = sizeof(EmittedMultiwayHJWindowTrigger) + (numberOfInputs * (sizeof(uint64_t) + sizeof(HashMap**)))
+        + (totalNumberOfHashMaps * sizeof(HashMap*));
+    const auto tupleBufferVal = pipelineCtx->getBufferManager()->getUnpooledBuffer(neededBufferSize);
+    if (not tupleBufferVal.has_value())
+    {
+        throw CannotAllocateBuffer("{}B for the multiway hash join window trigger were requested", neededBufferSize);
+    }
+
+    /// As we are here "emitting" a buffer, we have to set the originId, the seq number, the watermark and the "number of tuples".
+    /// The watermark cannot be the slice end as some buffers might be still waiting to get processed.
+    auto tupleBuffer = tupleBufferVal.value();
+    tupleBuffer.setOriginId(outputOriginId);
+    tupleBuffer.setSequenceNumber(SequenceNumber(sequenceData.sequenceNumber));
+    tupleBuffer.setChunkNumber(ChunkNumber(sequenceData.chunkNumber));
+    tupleBuffer.setLastChunk(sequenceData.lastChunk);
+    tupleBuffer.setWatermark(windowInfo.windowStart);
+    tupleBuffer.setNumberOfTuples(totalNumberOfTuples);
+    tupleBuffer.setCreationTimestampInMS(Timestamp(
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count()));
+    tupleBuffer.setIngestionTimestampsInNS(ingestionTimestamps.min, ingestionTimestamps.max);
+
+    /// Writing all necessary information for the probe to the buffer via the placement constructor
+    new (tupleBuffer.getAvailableMemoryArea().data()) EmittedMultiwayHJWindowTrigger{windowInfo, hashMapsOfInputs};
+
+    /// Dispatching the buffer to the probe operator via the task queue.
+    pipelineCtx->emitBuffer(tupleBuffer);
+    NES_TRACE(
+        "Triggered window {}-{} with watermarkTs {} sequenceNumber {} originId {} and {} hashmaps of {} inputs",
+        windowInfo.windowStart,
+        windowInfo.windowEnd,
+        tupleBuffer.getWatermark(),
+        tupleBuffer.getSequenceNumber(),
+        tupleBuffer.getOriginId(),
+        totalNumberOfHashMaps,
+        numberOfInputs);
+}
+
+}
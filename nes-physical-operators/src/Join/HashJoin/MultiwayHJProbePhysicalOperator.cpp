@@ -0,0 +1,195 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Join/HashJoin/MultiwayHJProbePhysicalOperator.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <Join/HashJoin/MultiwayHJOperatorHandler.hpp>
+#include <Nautilus/DataTypes/DataTypesUtil.hpp>
+#include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMap.hpp>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMapRef.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Nautilus/Interface/PagedVector/PagedVector.hpp>
+#include <Nautilus/Interface/PagedVector/PagedVectorRef.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Nautilus/Interface/RecordBuffer.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
+#include <SliceStore/WindowSlicesStoreInterface.hpp>
+#include <Time/Timestamp.hpp>
+#include <Windowing/WindowMetaData.hpp>
+#include <ErrorHandling.hpp>
+#include <ExecutionContext.hpp>
+#include <HashMapOptions.hpp>
+#include <WindowProbePhysicalOperator.hpp>
+#include <static.hpp>
+#include <val.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+MultiwayHJProbePhysicalOperator::MultiwayHJProbePhysicalOperator(
+    const OperatorHandlerId operatorHandlerId,
+    std::vector<WindowMetaData> windowMetaDataOfJoins,
+    std::vector<std::shared_ptr<TupleBufferRef>> bufferRefs,
+    std::vector<HashMapOptions> hashMapOptions)
+    : WindowProbePhysicalOperator(operatorHandlerId, windowMetaDataOfJoins.front())
+    , windowMetaDataOfJoins(std::move(windowMetaDataOfJoins))
+    , bufferRefs(std::move(bufferRefs))
+    , hashMapOptions(std::move(hashMapOptions))
+{
+    PRECONDITION(
+        this->bufferRefs.size() > 2 and this->bufferRefs.size() == this->hashMapOptions.size(),
+        "A multiway hash join requires the buffer refs and hash map options of more than two inputs");
+    PRECONDITION(
+        std::ranges::all_of(
+            this->hashMapOptions, [&](const auto& options) { return options.hashMapType == this->hashMapOptions.front().hashMapType; }),
+        "All inputs of the multiway hash join have to use the same hash map type");
+}
+
+void MultiwayHJProbePhysicalOperator::open(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const
+{
+    /// As this operator functions as a scan, we have to set the execution context for this pipeline
+    executionCtx.watermarkTs = recordBuffer.getWatermarkTs();
+    executionCtx.currentTs = recordBuffer.getCreatingTs();
+    executionCtx.sequenceNumber = recordBuffer.getSequenceNumber();
+    executionCtx.chunkNumber = recordBuffer.getChunkNumber();
+    executionCtx.lastChunk = recordBuffer.isLastChunk();
+    executionCtx.originId = recordBuffer.getOriginId();
+    executionCtx.minIngestionTs = recordBuffer.getMinIngestionTs();
+    executionCtx.maxIngestionTs = recordBuffer.getMaxIngestionTs();
+    WindowProbePhysicalOperator::open(executionCtx, recordBuffer);
+
+    /// An inner join has no results for a window, for which an input has no tuples
+    const auto hashJoinWindowRef = static_cast<nautilus::val<EmittedMultiwayHJWindowTrigger*>>(recordBuffer.getMemArea());
+    const auto numberOfHashMapsRef
+        = readValueFromMemRef<uint64_t*>(getMemberRef(hashJoinWindowRef, &EmittedMultiwayHJWindowTrigger::numberOfHashMaps));
+    for (uint64_t input = 0; input < hashMapOptions.size(); ++input)
+    {
+        const nautilus::val<uint64_t> numberOfHashMaps = numberOfHashMapsRef[nautilus::val<uint64_t>(input)];
+        if (numberOfHashMaps == 0)
+        {
+            return;
+        }
+    }
+
+    /// Getting necessary values from the record buffer
+    const auto windowInfoRef = getMemberRef(hashJoinWindowRef, &EmittedMultiwayHJWindowTrigger::windowInfo);
+    const nautilus::val<Timestamp> windowStart{readValueFromMemRef<uint64_t>(getMemberRef(windowInfoRef, &WindowInfo::windowStart))};
+    const nautilus::val<Timestamp> windowEnd{readValueFromMemRef<uint64_t>(getMemberRef(windowInfoRef, &WindowInfo::windowEnd))};
+    const auto hashMapsRef = readValueFromMemRef<HashMap***>(getMemberRef(hashJoinWindowRef, &EmittedMultiwayHJWindowTrigger::hashMaps));
+
+    /// We iterate over all entries of the hash maps of the first input and look up their keys in the hash maps of the other inputs
+    const auto& firstHashMapOptions = hashMapOptions.front();
+    const nautilus::val<HashMap**> firstHashMapRefs = hashMapsRef[nautilus::val<uint64_t>(0)];
+    const nautilus::val<uint64_t> firstNumberOfHashMaps = numberOfHashMapsRef[nautilus::val<uint64_t>(0)];
+    for (nautilus::val<uint64_t> hashMapIndex = 0; hashMapIndex < firstNumberOfHashMaps; ++hashMapIndex)
+    {
+        const nautilus::val<HashMap*> hashMapPtr = firstHashMapRefs[hashMapIndex];
+        firstHashMapOptions.visitHashMapRef(
+            hashMapPtr,
+            [&](auto& hashMap)
+            {
+                for (const auto entry : hashMap)
+                {
+                    const ChainedHashMapRef::ChainedEntryRef entryRef{
+                        entry, hashMapPtr, firstHashMapOptions.fieldKeys, firstHashMapOptions.fieldValues};
+                    std::vector pagedVectorMems{entryRef.getValueMemArea()};
+                    probeInput(executionCtx, hashJoinWindowRef, entryRef.entryRef, 1, pagedVectorMems, windowStart, windowEnd);
+                }
+            });
+    }
+}
+
+void MultiwayHJProbePhysicalOperator::probeInput(
+    ExecutionContext& executionCtx,
+    const nautilus::val<EmittedMultiwayHJWindowTrigger*>& hashJoinWindowRef,
+    const nautilus::val<ChainedHashMapEntry*>& keyEntry,
+    const uint64_t input,
+    std::vector<nautilus::val<int8_t*>>& pagedVectorMems,
+    const nautilus::val<Timestamp>& windowStart,
+    const nautilus::val<Timestamp>& windowEnd) const
+{
+    if (input == hashMapOptions.size())
+    {
+        joinPagedVectors(executionCtx, pagedVectorMems, 0, Record{}, windowStart, windowEnd);
+        return;
+    }
+
+    const auto& inputHashMapOptions = hashMapOptions[input];
+    const auto numberOfHashMapsRef
+        = readValueFromMemRef<uint64_t*>(getMemberRef(hashJoinWindowRef, &EmittedMultiwayHJWindowTrigger::numberOfHashMaps));
+    const auto hashMapsRef = readValueFromMemRef<HashMap***>(getMemberRef(hashJoinWindowRef, &EmittedMultiwayHJWindowTrigger::hashMaps));
+    const nautilus::val<uint64_t> numberOfHashMaps = numberOfHashMapsRef[nautilus::val<uint64_t>(input)];
+    const nautilus::val<HashMap**> hashMapRefs = hashMapsRef[nautilus::val<uint64_t>(input)];
+    for (nautilus::val<uint64_t> hashMapIndex = 0; hashMapIndex < numberOfHashMaps; ++hashMapIndex)
+    {
+        const nautilus::val<HashMap*> hashMapPtr = hashMapRefs[hashMapIndex];
+        inputHashMapOptions.visitHashMapRef(
+            hashMapPtr,
+            [&](auto& hashMap)
+            {
+                /// We use here findEntry as the other methods would insert a new entry, which is unnecessary
+                if (auto entry = hashMap.findEntry(keyEntry))
+                {
+                    const ChainedHashMapRef::ChainedEntryRef entryRef{
+                        entry, hashMapPtr, inputHashMapOptions.fieldKeys, inputHashMapOptions.fieldValues};
+                    pagedVectorMems.emplace_back(entryRef.getValueMemArea());
+                    probeInput(executionCtx, hashJoinWindowRef, keyEntry, input + 1, pagedVectorMems, windowStart, windowEnd);
+                    pagedVectorMems.pop_back();
+                }
+            });
+    }
+}
+
+void MultiwayHJProbePhysicalOperator::joinPagedVectors(
+    ExecutionContext& executionCtx,
+    const std::vector<nautilus::val<int8_t*>>& pagedVectorMems,
+    const uint64_t input,
+    const Record& joinedRecord,
+    const nautilus::val<Timestamp>& windowStart,
+    const nautilus::val<Timestamp>& windowEnd) const
+{
+    if (input == bufferRefs.size())
+    {
+        /// All joins of the nest join the tuples of the same tumbling window
+        Record outputRecord = joinedRecord;
+        for (const auto& [windowStartFieldName, windowEndFieldName] : windowMetaDataOfJoins)
+        {
+            outputRecord.write(windowStartFieldName, windowStart.convertToValue());
+            outputRecord.write(windowEndFieldName, windowEnd.convertToValue());
+        }
+        executeChild(executionCtx, outputRecord);
+        return;
+    }
+
+    const PagedVectorRef pagedVector{static_cast<nautilus::val<PagedVector*>>(pagedVectorMems[input]), bufferRefs[input]};
+    const auto fields = bufferRefs[input]->getAllFieldNames();
+    for (auto it = pagedVector.begin(fields); it != pagedVector.end(fields); ++it)
+    {
+        const auto inputRecord = *it;
+        Record record = joinedRecord;
+        for (const auto& fieldName : nautilus::static_iterable(fields))
+        {
+            record.write(fieldName, inputRecord.read(fieldName));
+        }
+        joinPagedVectors(executionCtx, pagedVectorMems, input + 1, record, windowStart, windowEnd);
+    }
+}
+}
@@ -0,0 +1,64 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Join/HashJoin/MultiwayHJSlice.hpp>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <SliceStore/Slice.hpp>
+#include <ErrorHandling.hpp>
+#include <HashMapSlice.hpp>
+
+namespace NES
+{
+MultiwayHJSlice::MultiwayHJSlice(
+    SliceStart sliceStart,
+    SliceEnd sliceEnd,
+    const CreateNewHashMapSliceArgs& createNewHashMapSliceArgs,
+    const uint64_t numberOfHashMaps,
+    const uint64_t numberOfInputs)
+    : HashMapSlice(std::move(sliceStart), std::move(sliceEnd), createNewHashMapSliceArgs, numberOfHashMaps, numberOfInputs)
+{
+    PRECONDITION(numberOfInputs > 2, "A multiway hash join slice requires more than two inputs, but got {}", numberOfInputs);
+}
+
+HashMap* MultiwayHJSlice::getHashMapPtr(const WorkerThreadId workerThreadId, const uint64_t input) const
+{
+    return hashMaps[getHashMapPos(workerThreadId, input, 0)].get();
+}
+
+HashMap* MultiwayHJSlice::getHashMapPtrOrCreate(const WorkerThreadId workerThreadId, const uint64_t input)
+{
+    const auto pos = getHashMapPos(workerThreadId, input, 0);
+    if (hashMaps.at(pos) == nullptr)
+    {
+        hashMaps.at(pos) = createHashMap();
+    }
+    return hashMaps.at(pos).get();
+}
+
+std::vector<HashMap*> MultiwayHJSlice::getHashMapPtrsOfInput(const uint64_t input) const
+{
+    return getHashMapPtrsOfPartition(input, 0);
+}
+
+uint64_t MultiwayHJSlice::getNumberOfInputs() const
+{
+    return numberOfInputStreams;
+}
+
+}
@@ -0,0 +1,99 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Join/IntervalJoin/IntervalJoinOperatorHandler.hpp>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+#include <Join/NestedLoopJoin/NLJOperatorHandler.hpp>
+#include <Sequencing/SequenceData.hpp>
+#include <SliceStore/Slice.hpp>
+#include <SliceStore/WindowSlicesStoreInterface.hpp>
+#include <PipelineExecutionContext.hpp>
+
+namespace NES
+{
+
+uint64_t IntervalJoinBounds::getOwningWindowStart(const uint64_t leftTimestamp) const
+{
+    if (leftTimestamp < offsetOfOwnedSlice)
+    {
+        return 0;
+    }
+    return (leftTimestamp - offsetOfOwnedSlice) / sliceLength * sliceLength;
+}
+
+bool IntervalJoinBounds::mayJoin(const Slice& leftSlice, const Slice& rightSlice) const
+{
+    const auto leftStart = static_cast<int64_t>(leftSlice.getSliceStart().getRawValue());
+    const auto leftEnd = static_cast<int64_t>(leftSlice.getSliceEnd().getRawValue());
+    const auto rightStart = static_cast<int64_t>(rightSlice.getSliceStart().getRawValue());
+    const auto rightEnd = static_cast<int64_t>(rightSlice.getSliceEnd().getRawValue());
+    return rightStart <= leftEnd - 1 + upperBound and rightEnd - 1 >= leftStart + lowerBound;
+}
+
+IntervalJoinOperatorHandler::IntervalJoinOperatorHandler(
+    const std::vector<OriginId>& inputOrigins,
+    const OriginId outputOriginId,
+    std::unique_ptr<WindowSlicesStoreInterface> sliceAndWindowStore,
+    const IntervalJoinBounds bounds)
+    : NLJOperatorHandler(inputOrigins, outputOriginId, std::move(sliceAndWindowStore)), bounds(bounds)
+{
+}
+
+void IntervalJoinOperatorHandler::triggerSlices(
+    const std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>>& slicesAndWindowInfo,
+    PipelineExecutionContext* pipelineCtx)
+{
+    for (const auto& [windowInfo, allSlices] : slicesAndWindowInfo)
+    {
+        std::vector<std::pair<Slice*, Slice*>> slicePairs;
+        for (const auto& sliceLeft : allSlices)
+        {
+            if (bounds.getOwningWindowStart(sliceLeft->getSliceStart().getRawValue()) != windowInfo.windowInfo.windowStart.getRawValue())
+            {
+                continue;
+            }
+            for (const auto& sliceRight : allSlices)
+            {
+                if (bounds.mayJoin(*sliceLeft, *sliceRight))
+                {
+                    slicePairs.emplace_back(sliceLeft.get(), sliceRight.get());
+                }
+            }
+        }
+
+        /// Every window must emit at least one chunk for its sequence number. As the probe only joins the left records that the window
+        /// owns, the pair of any slice of a window without owned left records does not join any records.
+        if (slicePairs.empty() and not allSlices.empty())
+        {
+            slicePairs.emplace_back(allSlices.front().get(), allSlices.front().get());
+        }
+
+        ChunkNumber::Underlying chunkNumber = ChunkNumber::INITIAL;
+        for (const auto& [sliceLeft, sliceRight] : slicePairs)
+        {
+            const bool isLastChunk = chunkNumber == slicePairs.size();
+            const SequenceData sequenceData{windowInfo.sequenceNumber, ChunkNumber(chunkNumber), isLastChunk};
+            emitSlicesToProbe(*sliceLeft, *sliceRight, windowInfo.windowInfo, sequenceData, pipelineCtx);
+            ++chunkNumber;
+        }
+    }
+}
+
+}
@@ -0,0 +1,66 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Join/IntervalJoin/IntervalJoinPhysicalFunction.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <Join/IntervalJoin/IntervalJoinOperatorHandler.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Arena.hpp>
+#include <val.hpp>
+#include <val_bool.hpp>
+
+namespace NES
+{
+
+IntervalJoinPhysicalFunction::IntervalJoinPhysicalFunction(
+    Record::RecordFieldIdentifier leftTimestampField,
+    Record::RecordFieldIdentifier rightTimestampField,
+    Record::RecordFieldIdentifier windowStartField,
+    const uint64_t millisecondsConversionMultiplier,
+    const IntervalJoinBounds bounds)
+    : leftTimestampField(std::move(leftTimestampField))
+    , rightTimestampField(std::move(rightTimestampField))
+    , windowStartField(std::move(windowStartField))
+    , millisecondsConversionMultiplier(millisecondsConversionMultiplier)
+    , bounds(bounds)
+{
+}
+
+VarVal IntervalJoinPhysicalFunction::execute(const Record& record, ArenaRef&) const
+{
+    const auto multiplier = nautilus::val<uint64_t>(millisecondsConversionMultiplier);
+    const auto leftTimestamp = record.read(leftTimestampField).getRawValueAs<nautilus::val<uint64_t>>() * multiplier;
+    const auto rightTimestamp = record.read(rightTimestampField).getRawValueAs<nautilus::val<uint64_t>>() * multiplier;
+    const auto windowStart = record.read(windowStartField).getRawValueAs<nautilus::val<uint64_t>>();
+
+    const auto ownedSliceStart = windowStart + nautilus::val<uint64_t>(bounds.offsetOfOwnedSlice);
+    const auto ownedSliceEnd = ownedSliceStart + nautilus::val<uint64_t>(bounds.sliceLength);
+    const auto isOwned = (leftTimestamp >= ownedSliceStart and leftTimestamp < ownedSliceEnd)
+        or (windowStart == nautilus::val<uint64_t>(0) and leftTimestamp < ownedSliceStart);
+
+    /// We add the negated negative bounds to the other side of the comparisons, as the timestamps are unsigned
+    const auto lowerBound = nautilus::val<uint64_t>(static_cast<uint64_t>(std::max<int64_t>(bounds.lowerBound, 0)));
+    const auto negatedLowerBound = nautilus::val<uint64_t>(static_cast<uint64_t>(std::max<int64_t>(-bounds.lowerBound, 0)));
+    const auto upperBound = nautilus::val<uint64_t>(static_cast<uint64_t>(std::max<int64_t>(bounds.upperBound, 0)));
+    const auto negatedUpperBound = nautilus::val<uint64_t>(static_cast<uint64_t>(std::max<int64_t>(-bounds.upperBound, 0)));
+    const auto isWithinInterval = rightTimestamp + negatedLowerBound >= leftTimestamp + lowerBound
+        and rightTimestamp + negatedUpperBound <= leftTimestamp + upperBound;
+    return VarVal(isOwned and isWithinInterval);
+}
+
+}
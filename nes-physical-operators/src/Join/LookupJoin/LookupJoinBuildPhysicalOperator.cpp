@@ -0,0 +1,175 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Join/LookupJoin/LookupJoinBuildPhysicalOperator.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <Join/LookupJoin/LookupJoinOperatorHandler.hpp>
+#include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMapRef.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Nautilus/Interface/PagedVector/PagedVector.hpp>
+#include <Nautilus/Interface/PagedVector/PagedVectorRef.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Nautilus/Interface/RecordBuffer.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
+#include <CompilationContext.hpp>
+#include <ErrorHandling.hpp>
+#include <ExecutionContext.hpp>
+#include <HashMapOptions.hpp>
+#include <OperatorState.hpp>
+#include <PhysicalOperator.hpp>
+#include <function.hpp>
+#include <static.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+namespace
+{
+LookupJoinOperatorHandler* getLookupJoinOperatorHandler(OperatorHandler* ptrOpHandler)
+{
+    PRECONDITION(ptrOpHandler != nullptr, "opHandler context should not be null!");
+    auto* opHandler = dynamic_cast<LookupJoinOperatorHandler*>(ptrOpHandler);
+    INVARIANT(opHandler != nullptr, "The operator handler of a lookup join build should be a LookupJoinOperatorHandler");
+    return opHandler;
+}
+
+void registerBuildPipelineProxy(OperatorHandler* ptrOpHandler)
+{
+    getLookupJoinOperatorHandler(ptrOpHandler)->registerBuildPipeline();
+}
+
+HashMap* lockForBuildProxy(OperatorHandler* ptrOpHandler)
+{
+    auto* opHandler = getLookupJoinOperatorHandler(ptrOpHandler);
+    opHandler->lockForBuild();
+    return opHandler->getHashMap();
+}
+
+void unlockAfterBuildProxy(OperatorHandler* ptrOpHandler)
+{
+    getLookupJoinOperatorHandler(ptrOpHandler)->unlockAfterBuild();
+}
+
+void terminateBuildPipelineProxy(OperatorHandler* ptrOpHandler)
+{
+    getLookupJoinOperatorHandler(ptrOpHandler)->terminateBuildPipeline();
+}
+
+/// The hash index keeps its records until the query ends. Thus, it allocates them as state (see AbstractBufferProvider)
+AbstractBufferProvider* getStateBufferProviderProxy(AbstractBufferProvider* pipelineBufferProvider)
+{
+    return pipelineBufferProvider->getStateBufferProvider();
+}
+
+/// Stores the hash index for the records of the current buffer, which the build acquired in open
+class LookupJoinBuildLocalState : public OperatorState
+{
+public:
+    explicit LookupJoinBuildLocalState(const nautilus::val<HashMap*>& hashMap) : hashMap(hashMap) { }
+
+    nautilus::val<HashMap*> hashMap;
+};
+}
+
+LookupJoinBuildPhysicalOperator::LookupJoinBuildPhysicalOperator(
+    const OperatorHandlerId operatorHandlerId, std::shared_ptr<TupleBufferRef> bufferRef, HashMapOptions hashMapOptions)
+    : operatorHandlerId(operatorHandlerId), bufferRef(std::move(bufferRef)), hashMapOptions(std::move(hashMapOptions))
+{
+}
+
+void LookupJoinBuildPhysicalOperator::setup(ExecutionContext& executionCtx, CompilationContext&) const
+{
+    invoke(registerBuildPipelineProxy, executionCtx.getGlobalOperatorHandler(operatorHandlerId));
+}
+
+void LookupJoinBuildPhysicalOperator::open(ExecutionContext& executionCtx, RecordBuffer&) const
+{
+    const auto hashMap = invoke(lockForBuildProxy, executionCtx.getGlobalOperatorHandler(operatorHandlerId));
+    /// The build is the last operator of its pipeline. Thus, all allocations via the buffer provider from now on belong to the index.
+    executionCtx.pipelineMemoryProvider.bufferProvider
+        = invoke(getStateBufferProviderProxy, executionCtx.pipelineMemoryProvider.bufferProvider);
+    executionCtx.setLocalOperatorState(id, std::make_unique<LookupJoinBuildLocalState>(hashMap));
+}
+
+void LookupJoinBuildPhysicalOperator::execute(ExecutionContext& ctx, Record& record) const
+{
+    const auto hashMapPtr = dynamic_cast<LookupJoinBuildLocalState*>(ctx.getLocalState(id))->hashMap;
+
+    /// The keys of the index may have other types than the key fields of the table, thus we write them into a record of their own
+    Record keyRecord;
+    nautilus::val<bool> containsNullInKey{false};
+    for (nautilus::static_val<uint64_t> i = 0; i < hashMapOptions.fieldKeys.size(); ++i)
+    {
+        const auto value = hashMapOptions.keyFunctions[i].execute(record, ctx.pipelineMemoryProvider.arena);
+        containsNullInKey = containsNullInKey or (value.isNullable() and value.isNull());
+        keyRecord.write(hashMapOptions.fieldKeys[i].fieldIdentifier, value);
+    }
+
+    /// A record with a null key never matches any record of the stream, as an inner join requires all equalities to be TRUE
+    if (not containsNullInKey)
+    {
+        ChainedHashMapRef hashMap{
+            hashMapPtr, hashMapOptions.fieldKeys, hashMapOptions.fieldValues, hashMapOptions.entriesPerPage, hashMapOptions.entrySize};
+        const auto hashMapEntry = hashMap.findOrCreateEntry(
+            keyRecord,
+            *hashMapOptions.hashFunction,
+            [&](const nautilus::val<AbstractHashMapEntry*>& entry)
+            {
+                /// Initializes the paged vector of the records with the new keys
+                const ChainedHashMapRef::ChainedEntryRef entryRef{entry, hashMapPtr, hashMapOptions.fieldKeys, hashMapOptions.fieldValues};
+                nautilus::invoke(
+                    +[](int8_t* pagedVectorMemArea) -> void
+                    {
+                        /// NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                        auto* pagedVector = reinterpret_cast<PagedVector*>(pagedVectorMemArea);
+                        new (pagedVector) PagedVector();
+                    },
+                    entryRef.getValueMemArea());
+            },
+            ctx.pipelineMemoryProvider.bufferProvider);
+
+        const ChainedHashMapRef::ChainedEntryRef entryRef{hashMapEntry, hashMapPtr, hashMapOptions.fieldKeys, hashMapOptions.fieldValues};
+        const PagedVectorRef pagedVectorRef(entryRef.getValueMemArea(), bufferRef);
+        pagedVectorRef.writeRecord(record, ctx.pipelineMemoryProvider.bufferProvider);
+    }
+}
+
+void LookupJoinBuildPhysicalOperator::close(ExecutionContext& executionCtx, RecordBuffer&) const
+{
+    invoke(unlockAfterBuildProxy, executionCtx.getGlobalOperatorHandler(operatorHandlerId));
+}
+
+void LookupJoinBuildPhysicalOperator::terminate(ExecutionContext& executionCtx) const
+{
+    invoke(terminateBuildPipelineProxy, executionCtx.getGlobalOperatorHandler(operatorHandlerId));
+}
+
+std::optional<PhysicalOperator> LookupJoinBuildPhysicalOperator::getChild() const
+{
+    return child;
+}
+
+void LookupJoinBuildPhysicalOperator::setChild(PhysicalOperator child)
+{
+    this->child = std::move(child);
+}
+
+}
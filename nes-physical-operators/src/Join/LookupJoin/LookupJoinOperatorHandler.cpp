@@ -0,0 +1,83 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Join/LookupJoin/LookupJoinOperatorHandler.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMap.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Nautilus/Interface/PagedVector/PagedVector.hpp>
+#include <Runtime/QueryTerminationType.hpp>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+LookupJoinOperatorHandler::LookupJoinOperatorHandler(const uint64_t keySize, const uint64_t numberOfBuckets, const uint64_t pageSize)
+    : hashMap(std::make_unique<ChainedHashMap>(keySize, sizeof(PagedVector), numberOfBuckets, pageSize))
+{
+    /// Destroys the paged vectors of all entries, once the index gets destroyed
+    hashMap->setDestructorCallback(
+        [keySize](ChainedHashMapEntry* entry)
+        {
+            /// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            auto* pagedVector = reinterpret_cast<PagedVector*>(reinterpret_cast<int8_t*>(entry) + sizeof(ChainedHashMapEntry) + keySize);
+            pagedVector->~PagedVector();
+        });
+}
+
+void LookupJoinOperatorHandler::start(PipelineExecutionContext&, uint32_t)
+{
+}
+
+void LookupJoinOperatorHandler::stop(QueryTerminationType, PipelineExecutionContext&)
+{
+}
+
+HashMap* LookupJoinOperatorHandler::getHashMap() const
+{
+    return hashMap.get();
+}
+
+void LookupJoinOperatorHandler::lockForBuild()
+{
+    buildMutex.lock();
+}
+
+void LookupJoinOperatorHandler::unlockAfterBuild()
+{
+    buildMutex.unlock();
+}
+
+void LookupJoinOperatorHandler::registerBuildPipeline()
+{
+    ++numberOfActiveBuildPipelines;
+}
+
+void LookupJoinOperatorHandler::terminateBuildPipeline()
+{
+    PRECONDITION(numberOfActiveBuildPipelines > 0, "Expected a build pipeline of the lookup join to be active");
+    if (--numberOfActiveBuildPipelines == 0)
+    {
+        tableLoaded.store(true, std::memory_order_release);
+    }
+}
+
+bool LookupJoinOperatorHandler::isTableLoaded() const
+{
+    return tableLoaded.load(std::memory_order_acquire);
+}
+
+}
@@ -0,0 +1,146 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Join/LookupJoin/LookupJoinProbePhysicalOperator.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <Join/LookupJoin/LookupJoinOperatorHandler.hpp>
+#include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMapRef.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Nautilus/Interface/PagedVector/PagedVectorRef.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Nautilus/Interface/RecordBuffer.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
+#include <Util/StdInt.hpp>
+#include <ErrorHandling.hpp>
+#include <ExecutionContext.hpp>
+#include <HashMapOptions.hpp>
+#include <PhysicalOperator.hpp>
+#include <function.hpp>
+#include <static.hpp>
+#include <val.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+namespace
+{
+/// Returns the hash index, once the table is loaded completely, and nullptr otherwise
+HashMap* getLoadedHashMapProxy(OperatorHandler* ptrOpHandler)
+{
+    PRECONDITION(ptrOpHandler != nullptr, "opHandler context should not be null!");
+    const auto* opHandler = dynamic_cast<LookupJoinOperatorHandler*>(ptrOpHandler);
+    INVARIANT(opHandler != nullptr, "The operator handler of a lookup join probe should be a LookupJoinOperatorHandler");
+    return opHandler->isTableLoaded() ? opHandler->getHashMap() : nullptr;
+}
+}
+
+LookupJoinProbePhysicalOperator::LookupJoinProbePhysicalOperator(
+    const OperatorHandlerId operatorHandlerId,
+    std::shared_ptr<TupleBufferRef> streamBufferRef,
+    std::shared_ptr<TupleBufferRef> tableBufferRef,
+    HashMapOptions hashMapOptions)
+    : operatorHandlerId(operatorHandlerId)
+    , streamBufferRef(std::move(streamBufferRef))
+    , tableBufferRef(std::move(tableBufferRef))
+    , streamFields(this->streamBufferRef->getAllFieldNames())
+    , tableFields(this->tableBufferRef->getAllFieldNames())
+    , hashMapOptions(std::move(hashMapOptions))
+{
+}
+
+void LookupJoinProbePhysicalOperator::open(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const
+{
+    /// Like the scan, the probe forwards the metadata of the buffer of the stream to the operators that follow it
+    executionCtx.watermarkTs = recordBuffer.getWatermarkTs();
+    executionCtx.originId = recordBuffer.getOriginId();
+    executionCtx.currentTs = recordBuffer.getCreatingTs();
+    executionCtx.sequenceNumber = recordBuffer.getSequenceNumber();
+    executionCtx.chunkNumber = recordBuffer.getChunkNumber();
+    executionCtx.lastChunk = recordBuffer.isLastChunk();
+    executionCtx.minIngestionTs = recordBuffer.getMinIngestionTs();
+    executionCtx.maxIngestionTs = recordBuffer.getMaxIngestionTs();
+
+    const auto hashMapPtr = invoke(getLoadedHashMapProxy, executionCtx.getGlobalOperatorHandler(operatorHandlerId));
+    if (hashMapPtr == nullptr)
+    {
+        executionCtx.setOpenReturnState(OpenReturnState::REPEAT);
+        return;
+    }
+
+    openChild(executionCtx, recordBuffer);
+    const auto numberOfRecords = recordBuffer.getNumRecords();
+    for (nautilus::val<uint64_t> i = 0_u64; i < numberOfRecords; i = i + 1_u64)
+    {
+        const auto streamRecord = streamBufferRef->readRecord(streamFields, recordBuffer, i);
+        probe(executionCtx, streamRecord, hashMapPtr);
+    }
+}
+
+void LookupJoinProbePhysicalOperator::probe(
+    ExecutionContext& executionCtx, const Record& streamRecord, const nautilus::val<HashMap*>& hashMapPtr) const
+{
+    Record keyRecord;
+    nautilus::val<bool> containsNullInKey{false};
+    for (nautilus::static_val<uint64_t> i = 0; i < hashMapOptions.fieldKeys.size(); ++i)
+    {
+        const auto value = hashMapOptions.keyFunctions[i].execute(streamRecord, executionCtx.pipelineMemoryProvider.arena);
+        containsNullInKey = containsNullInKey or (value.isNullable() and value.isNull());
+        keyRecord.write(hashMapOptions.fieldKeys[i].fieldIdentifier, value);
+    }
+    if (containsNullInKey)
+    {
+        return;
+    }
+
+    const ChainedHashMapRef hashMap{
+        hashMapPtr, hashMapOptions.fieldKeys, hashMapOptions.fieldValues, hashMapOptions.entriesPerPage, hashMapOptions.entrySize};
+    if (const auto entry = hashMap.findEntry(keyRecord, *hashMapOptions.hashFunction))
+    {
+        const ChainedHashMapRef::ChainedEntryRef entryRef{entry, hashMapPtr, hashMapOptions.fieldKeys, hashMapOptions.fieldValues};
+        const PagedVectorRef tableRecords(entryRef.getValueMemArea(), tableBufferRef);
+        const auto tableEnd = tableRecords.end(tableFields);
+        for (auto tableIt = tableRecords.begin(tableFields); tableIt != tableEnd; ++tableIt)
+        {
+            const auto tableRecord = *tableIt;
+            Record joinedRecord;
+            for (const auto& fieldName : nautilus::static_iterable(streamFields))
+            {
+                joinedRecord.write(fieldName, streamRecord.read(fieldName));
+            }
+            for (const auto& fieldName : nautilus::static_iterable(tableFields))
+            {
+                joinedRecord.write(fieldName, tableRecord.read(fieldName));
+            }
+            executeChild(executionCtx, joinedRecord);
+        }
+    }
+}
+
+std::optional<PhysicalOperator> LookupJoinProbePhysicalOperator::getChild() const
+{
+    return child;
+}
+
+void LookupJoinProbePhysicalOperator::setChild(PhysicalOperator child)
+{
+    this->child = std::move(child);
+}
+
+}
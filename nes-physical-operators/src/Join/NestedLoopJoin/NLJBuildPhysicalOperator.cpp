@@ -50,8 +50,10 @@ NLJBuildPhysicalOperator::NLJBuildPhysicalOperator(
     const OperatorHandlerId operatorHandlerId,
     const JoinBuildSideType joinBuildSide,
     std::unique_ptr<TimeFunction> timeFunction,
-    std::shared_ptr<TupleBufferRef> bufferRef)
+    std::shared_ptr<TupleBufferRef> bufferRef,
+    const bool compressFullPages)
     : StreamJoinBuildPhysicalOperator(operatorHandlerId, joinBuildSide, std::move(timeFunction), std::move(bufferRef))
+    , compressFullPages(compressFullPages)
 {
 }
 
@@ -64,15 +66,17 @@ void NLJBuildPhysicalOperator::execute(ExecutionContext& executionCtx, Record& r
     /// Get the current slice / pagedVector that we have to insert the tuple into
     const auto timestamp = timeFunction->getTs(executionCtx, record);
     const auto sliceReference = invoke(
-        +[](OperatorHandler* ptrOpHandler, const Timestamp timestampVal)
+        +[](OperatorHandler* ptrOpHandler, const Timestamp timestampVal, const WorkerThreadId workerThreadId)
         {
             PRECONDITION(ptrOpHandler != nullptr, "opHandler context should not be null!");
             const auto* opHandler = dynamic_cast<NLJOperatorHandler*>(ptrOpHandler);
             const auto createFunction = opHandler->getCreateNewSlicesFunction({});
-            return dynamic_cast<NLJSlice*>(opHandler->getSliceAndWindowStore().getSlicesOrCreate(timestampVal, createFunction)[0].get());
+            return dynamic_cast<NLJSlice*>(
+                opHandler->getSliceAndWindowStore().getSlicesOrCreate(timestampVal, workerThreadId, createFunction)[0].get());
         },
         operatorHandler,
-        timestamp);
+        timestamp,
+        executionCtx.workerThreadId);
     const auto nljPagedVectorMemRef = invoke(
         +[](const NLJSlice* nljSlice, const WorkerThreadId workerThreadId, const JoinBuildSideType joinBuildSide)
         {
@@ -85,7 +89,7 @@ void NLJBuildPhysicalOperator::execute(ExecutionContext& executionCtx, Record& r
 
 
     /// Write record to the pagedVector
-    const PagedVectorRef pagedVectorRef(nljPagedVectorMemRef, bufferRef);
+    const PagedVectorRef pagedVectorRef(nljPagedVectorMemRef, bufferRef, compressFullPages);
     pagedVectorRef.writeRecord(record, executionCtx.pipelineMemoryProvider.bufferProvider);
 }
 }
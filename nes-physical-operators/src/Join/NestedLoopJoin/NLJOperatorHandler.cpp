@@ -84,6 +84,9 @@ void NLJOperatorHandler::emitSlicesToProbe(
     tupleBuffer.setNumberOfTuples(totalNumberOfTuples);
     tupleBuffer.setCreationTimestampInMS(Timestamp(
         std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count()));
+    auto ingestionTimestamps = sliceLeft.getIngestionTimestamps();
+    ingestionTimestamps.merge(sliceRight.getIngestionTimestamps());
+    tupleBuffer.setIngestionTimestampsInNS(ingestionTimestamps.min, ingestionTimestamps.max);
     new (tupleBuffer.getAvailableMemoryArea().data())
         EmittedNLJWindowTrigger{windowInfo, sliceLeft.getSliceEnd(), sliceRight.getSliceEnd()};
 
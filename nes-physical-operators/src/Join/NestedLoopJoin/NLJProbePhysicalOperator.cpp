@@ -14,16 +14,21 @@
 
 #include <Join/NestedLoopJoin/NLJProbePhysicalOperator.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
+#include <Functions/BatchKernels.hpp>
 #include <Functions/PhysicalFunction.hpp>
 #include <Identifiers/Identifiers.hpp>
 #include <Join/NestedLoopJoin/NLJOperatorHandler.hpp>
 #include <Join/NestedLoopJoin/NLJSlice.hpp>
 #include <Join/StreamJoinProbePhysicalOperator.hpp>
 #include <Join/StreamJoinUtil.hpp>
+#include <Nautilus/DataTypes/DataTypesUtil.hpp>
 #include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
 #include <Nautilus/Interface/NESStrongTypeRef.hpp>
 #include <Nautilus/Interface/PagedVector/PagedVectorRef.hpp>
@@ -93,12 +98,14 @@ NLJProbePhysicalOperator::NLJProbePhysicalOperator(
     std::shared_ptr<TupleBufferRef> leftMemoryProvider,
     std::shared_ptr<TupleBufferRef> rightMemoryProvider,
     std::vector<Record::RecordFieldIdentifier> leftKeyFieldNames,
-    std::vector<Record::RecordFieldIdentifier> rightKeyFieldNames)
+    std::vector<Record::RecordFieldIdentifier> rightKeyFieldNames,
+    std::optional<NLJKeyComparison> keyComparison)
     : StreamJoinProbePhysicalOperator(operatorHandlerId, std::move(joinFunction), WindowMetaData(std::move(windowMetaData)), joinSchema)
     , leftMemoryProvider(std::move(leftMemoryProvider))
     , rightMemoryProvider(std::move(rightMemoryProvider))
     , leftKeyFieldNames(std::move(leftKeyFieldNames))
     , rightKeyFieldNames(std::move(rightKeyFieldNames))
+    , keyComparison(std::move(keyComparison))
 {
 }
 
@@ -109,32 +116,140 @@ void NLJProbePhysicalOperator::performNLJ(
     TupleBufferRef& innerMemoryProvider,
     const std::vector<Record::RecordFieldIdentifier>& outerKeyFieldNames,
     const std::vector<Record::RecordFieldIdentifier>& innerKeyFieldNames,
+    const std::optional<NLJKeyComparison>& innerKeyComparison,
     ExecutionContext& executionCtx,
     const nautilus::val<Timestamp>& windowStart,
     const nautilus::val<Timestamp>& windowEnd) const
 {
     const auto outerFields = outerMemoryProvider.getAllFieldNames();
     const auto innerFields = innerMemoryProvider.getAllFieldNames();
+    const auto numberOfInnerTuples = innerPagedVector.getNumberOfTuples();
 
-    nautilus::val<uint64_t> outerItemPos(0);
-    for (auto outerIt = outerPagedVector.begin(outerKeyFieldNames); outerIt != outerPagedVector.end(outerKeyFieldNames); ++outerIt)
+    /// Evaluates the join function for a pair of tuples and passes the joined tuple to the child, if the pair qualifies
+    const auto joinPair = [&](const Record& outerKeyFields,
+                              const Record& innerKeyFields,
+                              const nautilus::val<uint64_t>& outerItemPos,
+                              const nautilus::val<uint64_t>& innerItemPos)
     {
-        nautilus::val<uint64_t> innerItemPos(0);
-        for (auto innerIt = innerPagedVector.begin(innerKeyFieldNames); innerIt != innerPagedVector.end(innerKeyFieldNames); ++innerIt)
+        const auto joinedKeyFields
+            = createJoinedRecord(outerKeyFields, innerKeyFields, windowStart, windowEnd, outerKeyFieldNames, innerKeyFieldNames);
+        if (joinFunction.execute(joinedKeyFields, executionCtx.pipelineMemoryProvider.arena))
         {
-            const auto joinedKeyFields
-                = createJoinedRecord(*outerIt, *innerIt, windowStart, windowEnd, outerKeyFieldNames, innerKeyFieldNames);
-            if (joinFunction.execute(joinedKeyFields, executionCtx.pipelineMemoryProvider.arena))
+            auto outerRecord = outerPagedVector.readRecord(outerItemPos, outerFields);
+            auto innerRecord = innerPagedVector.readRecord(innerItemPos, innerFields);
+            auto joinedRecord = createJoinedRecord(outerRecord, innerRecord, windowStart, windowEnd, outerFields, innerFields);
+            executeChild(executionCtx, joinedRecord);
+        }
+    };
+
+    const auto innerKeyLocation = innerKeyComparison.and_then(
+        [&](const NLJKeyComparison& comparison) { return innerMemoryProvider.getFieldLocation(comparison.leftFieldName); });
+    if (innerKeyComparison.has_value() and innerKeyLocation.has_value() and not innerKeyLocation->type.nullable)
+    {
+        /// We copy the keys of a block of inner tuples next to each other, so that the batch kernels compare all keys of the block with
+        /// the key of an outer tuple via SIMD instructions. Only for the qualifying inner tuples, we evaluate the whole join function.
+        const auto keySize = innerKeyLocation->type.getSizeInBytesWithoutNull();
+        const auto innerKeys = executionCtx.allocateMemory(nautilus::val<size_t>(NLJ_KEY_BLOCK_SIZE * keySize));
+        const auto mask = executionCtx.allocateMemory(nautilus::val<size_t>(NLJ_KEY_BLOCK_SIZE));
+        const auto selectionVector = executionCtx.allocateMemory(nautilus::val<size_t>(NLJ_KEY_BLOCK_SIZE * sizeof(uint64_t)));
+        for (nautilus::val<uint64_t> blockBegin(0); blockBegin < numberOfInnerTuples; blockBegin = blockBegin + NLJ_KEY_BLOCK_SIZE)
+        {
+            nautilus::val<uint64_t> blockSize = numberOfInnerTuples - blockBegin;
+            if (blockSize > NLJ_KEY_BLOCK_SIZE)
             {
-                auto outerRecord = outerPagedVector.readRecord(outerItemPos, outerFields);
-                auto innerRecord = innerPagedVector.readRecord(innerItemPos, innerFields);
-                auto joinedRecord = createJoinedRecord(outerRecord, innerRecord, windowStart, windowEnd, outerFields, innerFields);
-                executeChild(executionCtx, joinedRecord);
+                blockSize = NLJ_KEY_BLOCK_SIZE;
             }
+            innerPagedVector.copyColumn(blockBegin, blockSize, innerKeyComparison->leftFieldName, innerKeys);
 
-            innerItemPos = innerItemPos + nautilus::val<uint64_t>{1};
+            nautilus::val<uint64_t> outerItemPos(0);
+            for (auto outerIt = outerPagedVector.begin(outerKeyFieldNames); outerIt != outerPagedVector.end(outerKeyFieldNames); ++outerIt)
+            {
+                const auto outerKeyFields = *outerIt;
+                evaluateKeyComparison(
+                    innerKeyComparison->fieldType,
+                    innerKeyComparison->comparison,
+                    innerKeys,
+                    blockSize,
+                    mask,
+                    outerKeyFields.read(innerKeyComparison->rightFieldName));
+                const auto numberOfSelected = compactSelection(mask, blockBegin, blockSize, selectionVector);
+                for (nautilus::val<uint64_t> i(0); i < numberOfSelected; i = i + nautilus::val<uint64_t>{1})
+                {
+                    const auto innerItemPos = readValueFromMemRef<uint64_t>(selectionVector + (i * sizeof(uint64_t)));
+                    joinPair(outerKeyFields, innerPagedVector.readRecord(innerItemPos, innerKeyFieldNames), outerItemPos, innerItemPos);
+                }
+                outerItemPos = outerItemPos + nautilus::val<uint64_t>{1};
+            }
+        }
+        return;
+    }
+
+    /// Without a key comparison, we still tile the inner side into blocks that stay in the cache while all outer tuples are compared
+    /// with the block. Thus, we read the outer side once per block instead of reading the whole inner side once per outer tuple.
+    const auto innerBlockSize
+        = std::max<uint64_t>(1, NLJ_INNER_BLOCK_SIZE_IN_BYTES / std::max<uint64_t>(1, innerMemoryProvider.getTupleSize()));
+    for (nautilus::val<uint64_t> blockBegin(0); blockBegin < numberOfInnerTuples; blockBegin = blockBegin + innerBlockSize)
+    {
+        nautilus::val<uint64_t> blockEnd = blockBegin + innerBlockSize;
+        if (blockEnd > numberOfInnerTuples)
+        {
+            blockEnd = numberOfInnerTuples;
         }
-        outerItemPos = outerItemPos + nautilus::val<uint64_t>{1};
+
+        nautilus::val<uint64_t> outerItemPos(0);
+        for (auto outerIt = outerPagedVector.begin(outerKeyFieldNames); outerIt != outerPagedVector.end(outerKeyFieldNames); ++outerIt)
+        {
+            const auto outerKeyFields = *outerIt;
+            nautilus::val<uint64_t> innerItemPos = blockBegin;
+            for (auto innerIt = innerPagedVector.at(blockBegin, innerKeyFieldNames); innerItemPos < blockEnd; ++innerIt)
+            {
+                joinPair(outerKeyFields, *innerIt, outerItemPos, innerItemPos);
+                innerItemPos = innerItemPos + nautilus::val<uint64_t>{1};
+            }
+            outerItemPos = outerItemPos + nautilus::val<uint64_t>{1};
+        }
+    }
+}
+
+void NLJProbePhysicalOperator::performJoin(
+    const PagedVectorRef& leftPagedVector,
+    const PagedVectorRef& rightPagedVector,
+    ExecutionContext& executionCtx,
+    const nautilus::val<Timestamp>& windowStart,
+    const nautilus::val<Timestamp>& windowEnd) const
+{
+    const auto numberOfTuplesLeft = leftPagedVector.getNumberOfTuples();
+    const auto numberOfTuplesRight = rightPagedVector.getNumberOfTuples();
+
+    /// Outer loop should have more no. tuples
+    /// performNLJ expects the key comparison as `innerField <comparison> outerField`
+    if (numberOfTuplesLeft < numberOfTuplesRight)
+    {
+        performNLJ(
+            leftPagedVector,
+            rightPagedVector,
+            *leftMemoryProvider,
+            *rightMemoryProvider,
+            leftKeyFieldNames,
+            rightKeyFieldNames,
+            keyComparison.transform([](const NLJKeyComparison& comparison) { return comparison.mirror(); }),
+            executionCtx,
+            windowStart,
+            windowEnd);
+    }
+    else
+    {
+        performNLJ(
+            rightPagedVector,
+            leftPagedVector,
+            *rightMemoryProvider,
+            *leftMemoryProvider,
+            rightKeyFieldNames,
+            leftKeyFieldNames,
+            keyComparison,
+            executionCtx,
+            windowStart,
+            windowEnd);
     }
 }
 
@@ -147,6 +262,8 @@ void NLJProbePhysicalOperator::open(ExecutionContext& executionCtx, RecordBuffer
     executionCtx.chunkNumber = recordBuffer.getChunkNumber();
     executionCtx.lastChunk = recordBuffer.isLastChunk();
     executionCtx.originId = recordBuffer.getOriginId();
+    executionCtx.minIngestionTs = recordBuffer.getMinIngestionTs();
+    executionCtx.maxIngestionTs = recordBuffer.getMaxIngestionTs();
     openChild(executionCtx, recordBuffer);
 
     /// Getting all needed info from the recordBuffer
@@ -187,36 +304,7 @@ void NLJProbePhysicalOperator::open(ExecutionContext& executionCtx, RecordBuffer
 
     const PagedVectorRef leftPagedVector(leftPagedVectorRef, leftMemoryProvider);
     const PagedVectorRef rightPagedVector(rightPagedVectorRef, rightMemoryProvider);
-    const auto numberOfTuplesLeft = leftPagedVector.getNumberOfTuples();
-    const auto numberOfTuplesRight = rightPagedVector.getNumberOfTuples();
-
-    /// Outer loop should have more no. tuples
-    if (numberOfTuplesLeft < numberOfTuplesRight)
-    {
-        performNLJ(
-            leftPagedVector,
-            rightPagedVector,
-            *leftMemoryProvider,
-            *rightMemoryProvider,
-            leftKeyFieldNames,
-            rightKeyFieldNames,
-            executionCtx,
-            windowStart,
-            windowEnd);
-    }
-    else
-    {
-        performNLJ(
-            rightPagedVector,
-            leftPagedVector,
-            *rightMemoryProvider,
-            *leftMemoryProvider,
-            rightKeyFieldNames,
-            leftKeyFieldNames,
-            executionCtx,
-            windowStart,
-            windowEnd);
-    }
+    performJoin(leftPagedVector, rightPagedVector, executionCtx, windowStart, windowEnd);
 }
 
 }
@@ -85,10 +85,14 @@ PagedVector* NLJSlice::getPagedVectorRef(const WorkerThreadId workerThreadId, co
 void NLJSlice::combinePagedVectors()
 {
     /// Due to the out-of-order nature of our execution engine, it might happen that we call this code here from multiple worker threads.
-    /// For example, if different worker threads are emitting the same slice for different windows.
-    /// To ensure correctness, we use a lock here
-    const std::scoped_lock lock(combinePagedVectorsMutex);
+    /// For example, if different worker threads are emitting the same slice for different windows of a sliding window.
+    /// As the slice does not receive any tuples after its first emission, we combine its PagedVectors exactly once.
+    /// Concurrent first calls wait for the combination to finish, while all later calls return without taking a lock.
+    std::call_once(pagedVectorsCombined, [this] { combineAllPagedVectors(); });
+}
 
+void NLJSlice::combineAllPagedVectors()
+{
     /// Append all PagedVectors on the left join side and erase all items except for the first one
     /// We do this to ensure that we have only one PagedVector for each side during the probing phase
     if (leftPagedVectors.size() > 1)
@@ -0,0 +1,70 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Join/SortMergeJoin/SortMergeJoinEntry.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+uint64_t sortSortMergeJoinEntries(const std::span<SortMergeJoinEntry> entries)
+{
+    const auto firstNaN = std::ranges::partition(entries, [](const SortMergeJoinEntry& entry) { return not std::isnan(entry.key); });
+    const auto numberOfEntries = static_cast<uint64_t>(std::distance(entries.begin(), firstNaN.begin()));
+    std::ranges::sort(
+        entries.first(numberOfEntries),
+        [](const SortMergeJoinEntry& lhs, const SortMergeJoinEntry& rhs)
+        { return lhs.key < rhs.key or (lhs.key == rhs.key and lhs.position < rhs.position); });
+    return numberOfEntries;
+}
+
+void computeSortMergeJoinRanges(
+    const std::span<const SortMergeJoinEntry> leftEntries,
+    const std::span<const SortMergeJoinEntry> rightEntries,
+    const bool rightIsLowerBoundedByLeft,
+    const bool rightIsUpperBoundedByLeft,
+    const std::span<SortMergeJoinRange> ranges)
+{
+    PRECONDITION(ranges.size() == leftEntries.size(), "Expected one range per left entry but got {} ranges", ranges.size());
+    PRECONDITION(rightIsLowerBoundedByLeft or rightIsUpperBoundedByLeft, "Expected the right entries to be bounded on at least one side");
+
+    uint64_t begin = 0;
+    uint64_t end = rightIsUpperBoundedByLeft ? 0 : rightEntries.size();
+    for (uint64_t i = 0; i < leftEntries.size(); ++i)
+    {
+        const auto key = leftEntries[i].key;
+        if (rightIsLowerBoundedByLeft)
+        {
+            while (begin < rightEntries.size() and rightEntries[begin].key < key)
+            {
+                ++begin;
+            }
+        }
+        if (rightIsUpperBoundedByLeft)
+        {
+            while (end < rightEntries.size() and rightEntries[end].key <= key)
+            {
+                ++end;
+            }
+        }
+        ranges[i] = {.begin = begin, .end = std::max(begin, end)};
+    }
+}
+
+}
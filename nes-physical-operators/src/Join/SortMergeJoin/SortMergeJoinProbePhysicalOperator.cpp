@@ -0,0 +1,168 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Join/SortMergeJoin/SortMergeJoinProbePhysicalOperator.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+#include <Functions/PhysicalFunction.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Join/NestedLoopJoin/NLJProbePhysicalOperator.hpp>
+#include <Join/SortMergeJoin/SortMergeJoinEntry.hpp>
+#include <Join/StreamJoinUtil.hpp>
+#include <Nautilus/DataTypes/DataTypesUtil.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
+#include <Nautilus/Interface/PagedVector/PagedVectorRef.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Time/Timestamp.hpp>
+#include <Util/StdInt.hpp>
+#include <Windowing/WindowMetaData.hpp>
+#include <ErrorHandling.hpp>
+#include <ExecutionContext.hpp>
+#include <function.hpp>
+#include <val.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+namespace
+{
+uint64_t sortSortMergeJoinEntriesProxy(int8_t* entries, const uint64_t numberOfEntries)
+{
+    PRECONDITION(entries != nullptr or numberOfEntries == 0, "entries should not be null");
+    return sortSortMergeJoinEntries({reinterpret_cast<SortMergeJoinEntry*>(entries), numberOfEntries}); /// NOLINT
+}
+
+void computeSortMergeJoinRangesProxy(
+    const int8_t* leftEntries,
+    const uint64_t numberOfLeftEntries,
+    const int8_t* rightEntries,
+    const uint64_t numberOfRightEntries,
+    const bool rightIsLowerBoundedByLeft,
+    const bool rightIsUpperBoundedByLeft,
+    int8_t* ranges)
+{
+    PRECONDITION(ranges != nullptr or numberOfLeftEntries == 0, "ranges should not be null");
+    computeSortMergeJoinRanges(
+        {reinterpret_cast<const SortMergeJoinEntry*>(leftEntries), numberOfLeftEntries}, /// NOLINT
+        {reinterpret_cast<const SortMergeJoinEntry*>(rightEntries), numberOfRightEntries}, /// NOLINT
+        rightIsLowerBoundedByLeft,
+        rightIsUpperBoundedByLeft,
+        {reinterpret_cast<SortMergeJoinRange*>(ranges), numberOfLeftEntries}); /// NOLINT
+}
+}
+
+SortMergeJoinProbePhysicalOperator::SortMergeJoinProbePhysicalOperator(
+    OperatorHandlerId operatorHandlerId,
+    PhysicalFunction joinFunction,
+    WindowMetaData windowMetaData,
+    const JoinSchema& joinSchema,
+    std::shared_ptr<TupleBufferRef> leftMemoryProvider,
+    std::shared_ptr<TupleBufferRef> rightMemoryProvider,
+    std::vector<Record::RecordFieldIdentifier> leftKeyFieldNames,
+    std::vector<Record::RecordFieldIdentifier> rightKeyFieldNames,
+    SortMergeJoinBand band)
+    : NLJProbePhysicalOperator(
+          operatorHandlerId,
+          std::move(joinFunction),
+          std::move(windowMetaData),
+          joinSchema,
+          std::move(leftMemoryProvider),
+          std::move(rightMemoryProvider),
+          std::move(leftKeyFieldNames),
+          std::move(rightKeyFieldNames))
+    , band(std::move(band))
+{
+    PRECONDITION(
+        this->band.rightIsLowerBoundedByLeft or this->band.rightIsUpperBoundedByLeft,
+        "The band of a sort-merge join must be bounded on at least one side");
+}
+
+nautilus::val<uint64_t> SortMergeJoinProbePhysicalOperator::writeSortedEntries(
+    const PagedVectorRef& pagedVector, const Record::RecordFieldIdentifier& sortFieldName, const nautilus::val<int8_t*>& entries)
+{
+    const std::vector projection{sortFieldName};
+    nautilus::val<uint64_t> position = 0_u64;
+    for (auto it = pagedVector.begin(projection); it != pagedVector.end(projection); ++it)
+    {
+        const auto key = (*it).read(sortFieldName).getRawValueAs<nautilus::val<double>>();
+        const auto entry = entries + (position * sizeof(SortMergeJoinEntry));
+        VarVal{key}.writeToMemory(entry + offsetof(SortMergeJoinEntry, key));
+        VarVal{position}.writeToMemory(entry + offsetof(SortMergeJoinEntry, position));
+        position = position + 1_u64;
+    }
+    return invoke(sortSortMergeJoinEntriesProxy, entries, position);
+}
+
+void SortMergeJoinProbePhysicalOperator::performJoin(
+    const PagedVectorRef& leftPagedVector,
+    const PagedVectorRef& rightPagedVector,
+    ExecutionContext& executionCtx,
+    const nautilus::val<Timestamp>& windowStart,
+    const nautilus::val<Timestamp>& windowEnd) const
+{
+    /// The entries and ranges are only needed during this probe. Thus, we allocate them from the arena of this pipeline invocation.
+    const auto leftEntries = executionCtx.allocateMemory(leftPagedVector.getNumberOfTuples() * sizeof(SortMergeJoinEntry));
+    const auto rightEntries = executionCtx.allocateMemory(rightPagedVector.getNumberOfTuples() * sizeof(SortMergeJoinEntry));
+    const auto numberOfLeftEntries = writeSortedEntries(leftPagedVector, band.leftFieldName, leftEntries);
+    const auto numberOfRightEntries = writeSortedEntries(rightPagedVector, band.rightFieldName, rightEntries);
+
+    const auto ranges = executionCtx.allocateMemory(numberOfLeftEntries * sizeof(SortMergeJoinRange));
+    invoke(
+        computeSortMergeJoinRangesProxy,
+        leftEntries,
+        numberOfLeftEntries,
+        rightEntries,
+        numberOfRightEntries,
+        nautilus::val<bool>(band.rightIsLowerBoundedByLeft),
+        nautilus::val<bool>(band.rightIsUpperBoundedByLeft),
+        ranges);
+
+    const auto leftFields = leftMemoryProvider->getAllFieldNames();
+    const auto rightFields = rightMemoryProvider->getAllFieldNames();
+    for (nautilus::val<uint64_t> leftEntry = 0_u64; leftEntry < numberOfLeftEntries; leftEntry = leftEntry + 1_u64)
+    {
+        const auto leftPosition = readValueFromMemRef<uint64_t>(
+            leftEntries + (leftEntry * sizeof(SortMergeJoinEntry)) + offsetof(SortMergeJoinEntry, position));
+        const auto range = ranges + (leftEntry * sizeof(SortMergeJoinRange));
+        const auto rangeEnd = readValueFromMemRef<uint64_t>(range + offsetof(SortMergeJoinRange, end));
+        const auto leftKeyRecord = leftPagedVector.readRecord(leftPosition, leftKeyFieldNames);
+
+        /// The band predicate holds for all candidates but the join function might contain further predicates
+        for (auto rightEntry = readValueFromMemRef<uint64_t>(range + offsetof(SortMergeJoinRange, begin)); rightEntry < rangeEnd;
+             rightEntry = rightEntry + 1_u64)
+        {
+            const auto rightPosition = readValueFromMemRef<uint64_t>(
+                rightEntries + (rightEntry * sizeof(SortMergeJoinEntry)) + offsetof(SortMergeJoinEntry, position));
+            const auto rightKeyRecord = rightPagedVector.readRecord(rightPosition, rightKeyFieldNames);
+            const auto joinedKeyFields
+                = createJoinedRecord(leftKeyRecord, rightKeyRecord, windowStart, windowEnd, leftKeyFieldNames, rightKeyFieldNames);
+            if (joinFunction.execute(joinedKeyFields, executionCtx.pipelineMemoryProvider.arena))
+            {
+                auto leftRecord = leftPagedVector.readRecord(leftPosition, leftFields);
+                auto rightRecord = rightPagedVector.readRecord(rightPosition, rightFields);
+                auto joinedRecord = createJoinedRecord(leftRecord, rightRecord, windowStart, windowEnd, leftFields, rightFields);
+                executeChild(executionCtx, joinedRecord);
+            }
+        }
+    }
+}
+
+}
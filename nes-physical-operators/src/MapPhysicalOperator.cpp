@@ -23,7 +23,9 @@
 namespace NES
 {
 MapPhysicalOperator::MapPhysicalOperator(Record::RecordFieldIdentifier fieldToWriteTo, PhysicalFunction mapFunction)
-    : fieldToWriteTo(std::move(fieldToWriteTo)), mapFunction(std::move(mapFunction))
+    : fieldToWriteTo(std::move(fieldToWriteTo))
+    , slotToWriteTo(Record::resolveSlot(this->fieldToWriteTo))
+    , mapFunction(std::move(mapFunction))
 {
 }
 
@@ -32,7 +34,7 @@ void MapPhysicalOperator::execute(ExecutionContext& ctx, Record& record) const
     /// execute map function
     const auto value = mapFunction.execute(record, ctx.pipelineMemoryProvider.arena);
     /// write the result to the record
-    record.write(fieldToWriteTo, value);
+    record.write(slotToWriteTo, value);
     /// call next operator
     executeChild(ctx, record);
 }
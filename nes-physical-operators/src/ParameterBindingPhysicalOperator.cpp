@@ -0,0 +1,97 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <ParameterBindingPhysicalOperator.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Nautilus/Interface/RecordBuffer.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
+#include <ErrorHandling.hpp>
+#include <ExecutionContext.hpp>
+#include <OperatorState.hpp>
+#include <ParameterOperatorHandler.hpp>
+#include <PhysicalOperator.hpp>
+#include <function.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+namespace
+{
+/// The values of the parameters for the current tuple buffer
+class ParameterBindingState : public OperatorState
+{
+public:
+    explicit ParameterBindingState(std::vector<VarVal> values) : values(std::move(values)) { }
+
+    std::vector<VarVal> values;
+};
+
+int8_t* getParameterValuesProxy(OperatorHandler* ptrOpHandler)
+{
+    PRECONDITION(ptrOpHandler != nullptr, "opHandler context should not be null!");
+    return dynamic_cast<ParameterOperatorHandler*>(ptrOpHandler)->getValues();
+}
+}
+
+ParameterBindingPhysicalOperator::ParameterBindingPhysicalOperator(
+    const OperatorHandlerId operatorHandlerId, std::vector<Parameter> parameters)
+    : operatorHandlerId(operatorHandlerId), parameters(std::move(parameters))
+{
+}
+
+void ParameterBindingPhysicalOperator::open(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const
+{
+    const auto operatorHandler = executionCtx.getGlobalOperatorHandler(operatorHandlerId);
+    const nautilus::val<int8_t*> valuesRef = nautilus::invoke(getParameterValuesProxy, operatorHandler);
+    std::vector<VarVal> values;
+    values.reserve(parameters.size());
+    for (uint64_t index = 0; index < parameters.size(); ++index)
+    {
+        values.emplace_back(VarVal::readNonNullableVarValFromMemory(
+            valuesRef + nautilus::val<uint64_t>(index * ParameterOperatorHandler::SLOT_SIZE), parameters[index].dataType));
+    }
+    executionCtx.setLocalOperatorState(id, std::make_unique<ParameterBindingState>(std::move(values)));
+    openChild(executionCtx, recordBuffer);
+}
+
+void ParameterBindingPhysicalOperator::execute(ExecutionContext& executionCtx, Record& record) const
+{
+    const auto* const state = dynamic_cast<ParameterBindingState*>(executionCtx.getLocalState(id));
+    for (uint64_t index = 0; index < parameters.size(); ++index)
+    {
+        record.write(parameters[index].fieldName, state->values[index]);
+    }
+    executeChild(executionCtx, record);
+}
+
+std::optional<PhysicalOperator> ParameterBindingPhysicalOperator::getChild() const
+{
+    return child;
+}
+
+void ParameterBindingPhysicalOperator::setChild(PhysicalOperator child)
+{
+    this->child = std::move(child);
+}
+
+}
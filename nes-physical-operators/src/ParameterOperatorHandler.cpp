@@ -0,0 +1,123 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <ParameterOperatorHandler.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <Util/Strings.hpp>
+#include <ErrorHandling.hpp>
+#include <nameof.hpp>
+
+namespace NES
+{
+
+namespace
+{
+template <typename T>
+void writeValue(int8_t* slot, const std::string_view value)
+{
+    static_assert(sizeof(T) <= ParameterOperatorHandler::SLOT_SIZE);
+    const auto parsed = from_chars<T>(value);
+    if (not parsed)
+    {
+        throw QueryCompilerError("Can not parse parameter value \"{}\" into {}", value, NAMEOF_TYPE(T));
+    }
+    std::memcpy(slot, &parsed.value(), sizeof(T));
+}
+}
+
+ParameterOperatorHandler::ParameterOperatorHandler(const std::vector<Parameter>& parameters) : values(parameters.size() * SLOT_SIZE)
+{
+    for (size_t index = 0; index < parameters.size(); ++index)
+    {
+        const auto& [dataType, value] = parameters[index];
+        PRECONDITION(supportsType(dataType), "Can not bind a value of type {} to a parameter", dataType);
+        auto* slot = values.data() + (index * SLOT_SIZE);
+        switch (dataType.type)
+        {
+            case DataType::Type::INT8:
+                writeValue<int8_t>(slot, value);
+                break;
+            case DataType::Type::INT16:
+                writeValue<int16_t>(slot, value);
+                break;
+            case DataType::Type::INT32:
+                writeValue<int32_t>(slot, value);
+                break;
+            case DataType::Type::INT64:
+                writeValue<int64_t>(slot, value);
+                break;
+            case DataType::Type::UINT8:
+                writeValue<uint8_t>(slot, value);
+                break;
+            case DataType::Type::UINT16:
+                writeValue<uint16_t>(slot, value);
+                break;
+            case DataType::Type::UINT32:
+                writeValue<uint32_t>(slot, value);
+                break;
+            case DataType::Type::UINT64:
+                writeValue<uint64_t>(slot, value);
+                break;
+            case DataType::Type::FLOAT32:
+                writeValue<float>(slot, value);
+                break;
+            case DataType::Type::FLOAT64:
+                writeValue<double>(slot, value);
+                break;
+            case DataType::Type::BOOLEAN:
+                writeValue<bool>(slot, value);
+                break;
+            case DataType::Type::CHAR:
+                writeValue<char>(slot, value);
+                break;
+            default:
+                std::unreachable();
+        }
+    }
+}
+
+bool ParameterOperatorHandler::supportsType(const DataType& dataType)
+{
+    if (dataType.nullable)
+    {
+        return false;
+    }
+    switch (dataType.type)
+    {
+        case DataType::Type::INT8:
+        case DataType::Type::INT16:
+        case DataType::Type::INT32:
+        case DataType::Type::INT64:
+        case DataType::Type::UINT8:
+        case DataType::Type::UINT16:
+        case DataType::Type::UINT32:
+        case DataType::Type::UINT64:
+        case DataType::Type::FLOAT32:
+        case DataType::Type::FLOAT64:
+        case DataType::Type::BOOLEAN:
+        case DataType::Type::CHAR:
+            return true;
+        default:
+            return false;
+    }
+}
+
+}
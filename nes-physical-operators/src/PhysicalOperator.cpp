@@ -282,6 +282,11 @@ void PhysicalOperatorWrapper::addChild(const std::shared_ptr<PhysicalOperatorWra
     children.push_back(child);
 }
 
+void PhysicalOperatorWrapper::setInputMemoryLayoutType(const MemoryLayoutType memoryLayoutType)
+{
+    inputMemoryLayoutType = memoryLayoutType;
+}
+
 void PhysicalOperatorWrapper::setChildren(const std::vector<std::shared_ptr<PhysicalOperatorWrapper>>& newChildren)
 {
     children = newChildren;
@@ -13,6 +13,7 @@
 */
 #include <PhysicalPlan.hpp>
 
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <ostream>
@@ -33,8 +34,15 @@ PhysicalPlan::PhysicalPlan(
     QueryId id,
     std::vector<std::shared_ptr<PhysicalOperatorWrapper>> rootOperators,
     ExecutionMode executionMode,
-    uint64_t operatorBufferSize)
-    : queryId(id), rootOperators(std::move(rootOperators)), executionMode(executionMode), operatorBufferSize(operatorBufferSize)
+    uint64_t operatorBufferSize,
+    std::chrono::microseconds emitCoalescingLatencyBound,
+    uint64_t varSizedSharingCompactionThreshold)
+    : queryId(id)
+    , rootOperators(std::move(rootOperators))
+    , executionMode(executionMode)
+    , operatorBufferSize(operatorBufferSize)
+    , emitCoalescingLatencyBound(emitCoalescingLatencyBound)
+    , varSizedSharingCompactionThreshold(varSizedSharingCompactionThreshold)
 {
     for (const auto& rootOperator : this->rootOperators)
     {
@@ -73,6 +81,16 @@ uint64_t PhysicalPlan::getOperatorBufferSize() const
     return operatorBufferSize;
 }
 
+std::chrono::microseconds PhysicalPlan::getEmitCoalescingLatencyBound() const
+{
+    return emitCoalescingLatencyBound;
+}
+
+uint64_t PhysicalPlan::getVarSizedSharingCompactionThreshold() const
+{
+    return varSizedSharingCompactionThreshold;
+}
+
 std::ostream& operator<<(std::ostream& os, const PhysicalPlan& plan)
 {
     os << plan.toString();
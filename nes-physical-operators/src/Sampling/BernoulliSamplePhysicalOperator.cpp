@@ -0,0 +1,108 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Sampling/BernoulliSamplePhysicalOperator.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <random>
+#include <utility>
+#include <Nautilus/Interface/Record.hpp>
+#include <Nautilus/Interface/RecordBuffer.hpp>
+#include <ErrorHandling.hpp>
+#include <ExecutionContext.hpp>
+#include <OperatorState.hpp>
+#include <PhysicalOperator.hpp>
+#include <function.hpp>
+#include <val.hpp>
+
+namespace NES
+{
+
+namespace
+{
+/// Counts down the records to skip until the next sampled record of the current tuple buffer
+class BernoulliSampleState : public OperatorState
+{
+public:
+    explicit BernoulliSampleState(nautilus::val<uint64_t> remainingGap) : remainingGap(std::move(remainingGap)) { }
+
+    nautilus::val<uint64_t> remainingGap;
+};
+
+uint64_t drawBernoulliSampleGapProxy(const double fraction)
+{
+    return drawBernoulliSampleGap(fraction);
+}
+}
+
+uint64_t drawBernoulliSampleGap(const double fraction)
+{
+    PRECONDITION(fraction > 0.0 and fraction <= 1.0, "The fraction of a Bernoulli sample must be in (0, 1], but got {}", fraction);
+    if (fraction >= 1.0)
+    {
+        return 0;
+    }
+    thread_local std::mt19937_64 generator{std::random_device{}()};
+    /// Draws from (0, 1], as the logarithm of zero is undefined
+    const auto uniform = 1.0 - std::uniform_real_distribution<double>(0.0, 1.0)(generator);
+    const auto gap = std::floor(std::log(uniform) / std::log1p(-fraction));
+    if (gap >= static_cast<double>(std::numeric_limits<uint64_t>::max()))
+    {
+        return std::numeric_limits<uint64_t>::max();
+    }
+    return static_cast<uint64_t>(gap);
+}
+
+BernoulliSamplePhysicalOperator::BernoulliSamplePhysicalOperator(const double fraction) : fraction(fraction)
+{
+    PRECONDITION(fraction > 0.0 and fraction <= 1.0, "The fraction of a Bernoulli sample must be in (0, 1], but got {}", fraction);
+}
+
+void BernoulliSamplePhysicalOperator::open(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const
+{
+    openChild(executionCtx, recordBuffer);
+    /// The geometric distribution is memoryless, thus each tuple buffer may start with a freshly drawn gap
+    executionCtx.setLocalOperatorState(
+        id, std::make_unique<BernoulliSampleState>(nautilus::invoke(drawBernoulliSampleGapProxy, nautilus::val<double>(fraction))));
+}
+
+void BernoulliSamplePhysicalOperator::execute(ExecutionContext& executionCtx, Record& record) const
+{
+    auto* const state = dynamic_cast<BernoulliSampleState*>(executionCtx.getLocalState(id));
+    if (state->remainingGap == nautilus::val<uint64_t>(0))
+    {
+        state->remainingGap = nautilus::invoke(drawBernoulliSampleGapProxy, nautilus::val<double>(fraction));
+        executeChild(executionCtx, record);
+    }
+    else
+    {
+        state->remainingGap = state->remainingGap - nautilus::val<uint64_t>(1);
+    }
+}
+
+std::optional<PhysicalOperator> BernoulliSamplePhysicalOperator::getChild() const
+{
+    return child;
+}
+
+void BernoulliSamplePhysicalOperator::setChild(PhysicalOperator child)
+{
+    this->child = std::move(child);
+}
+
+}
@@ -0,0 +1,73 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Sampling/ReservoirSampleBuildPhysicalOperator.hpp>
+
+#include <memory>
+#include <utility>
+#include <Identifiers/Identifiers.hpp>
+#include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
+#include <Nautilus/Interface/PagedVector/PagedVector.hpp>
+#include <Nautilus/Interface/PagedVector/PagedVectorRef.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
+#include <Sampling/ReservoirSampleOperatorHandler.hpp>
+#include <Sampling/ReservoirSampleSlice.hpp>
+#include <Time/Timestamp.hpp>
+#include <Watermark/TimeFunction.hpp>
+#include <ErrorHandling.hpp>
+#include <ExecutionContext.hpp>
+#include <WindowBuildPhysicalOperator.hpp>
+#include <function.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+namespace
+{
+/// Returns the paged vector to append the record to, or nullptr, if the reservoir of the worker thread rejects the record
+PagedVector* admitRecordProxy(OperatorHandler* ptrOpHandler, const Timestamp timestamp, const WorkerThreadId workerThreadId)
+{
+    PRECONDITION(ptrOpHandler != nullptr, "opHandler context should not be null!");
+    const auto* opHandler = dynamic_cast<ReservoirSampleOperatorHandler*>(ptrOpHandler);
+    const auto createFunction = opHandler->getCreateNewSlicesFunction({});
+    auto* slice = dynamic_cast<ReservoirSampleSlice*>(
+        opHandler->getSliceAndWindowStore().getSlicesOrCreate(timestamp, workerThreadId, createFunction)[0].get());
+    INVARIANT(slice != nullptr, "Expected a reservoir sample slice for timestamp {}", timestamp);
+    return slice->admitRecord(workerThreadId) ? slice->getPagedVector(workerThreadId) : nullptr;
+}
+}
+
+ReservoirSampleBuildPhysicalOperator::ReservoirSampleBuildPhysicalOperator(
+    const OperatorHandlerId operatorHandlerId, std::unique_ptr<TimeFunction> timeFunction, std::shared_ptr<TupleBufferRef> bufferRef)
+    : WindowBuildPhysicalOperator(operatorHandlerId, std::move(timeFunction)), bufferRef(std::move(bufferRef))
+{
+}
+
+void ReservoirSampleBuildPhysicalOperator::execute(ExecutionContext& executionCtx, Record& record) const
+{
+    auto* const localState = dynamic_cast<WindowOperatorBuildLocalState*>(executionCtx.getLocalState(id));
+    const auto operatorHandler = localState->getOperatorHandler();
+
+    const auto timestamp = timeFunction->getTs(executionCtx, record);
+    const auto pagedVector = invoke(admitRecordProxy, operatorHandler, timestamp, executionCtx.workerThreadId);
+    if (pagedVector != nullptr)
+    {
+        const PagedVectorRef pagedVectorRef(pagedVector, bufferRef);
+        pagedVectorRef.writeRecord(record, executionCtx.pipelineMemoryProvider.bufferProvider);
+    }
+}
+
+}
@@ -0,0 +1,168 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Sampling/ReservoirSampleOperatorHandler.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <utility>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+#include <Sampling/ReservoirSampleSlice.hpp>
+#include <Sequencing/SequenceData.hpp>
+#include <SliceStore/Slice.hpp>
+#include <SliceStore/WindowSlicesStoreInterface.hpp>
+#include <Time/Timestamp.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <ErrorHandling.hpp>
+#include <PipelineExecutionContext.hpp>
+#include <WindowBasedOperatorHandler.hpp>
+
+namespace NES
+{
+
+ReservoirSampleOperatorHandler::ReservoirSampleOperatorHandler(
+    const std::vector<OriginId>& inputOrigins,
+    const OriginId outputOriginId,
+    std::unique_ptr<WindowSlicesStoreInterface> sliceAndWindowStore,
+    const uint64_t sampleSize)
+    : WindowBasedOperatorHandler(inputOrigins, outputOriginId, std::move(sliceAndWindowStore)), sampleSize(sampleSize)
+{
+    PRECONDITION(sampleSize > 0, "The sample size of a reservoir sample must be positive");
+}
+
+std::function<std::vector<std::shared_ptr<Slice>>(SliceStart, SliceEnd)>
+ReservoirSampleOperatorHandler::getCreateNewSlicesFunction(const CreateNewSlicesArguments&) const
+{
+    PRECONDITION(
+        numberOfWorkerThreads > 0, "Number of worker threads not set for window based operator. Was setWorkerThreads() being called?");
+    return std::function(
+        [numberOfWorkerThreads = numberOfWorkerThreads, sampleSize = sampleSize](
+            SliceStart sliceStart, SliceEnd sliceEnd) -> std::vector<std::shared_ptr<Slice>>
+        { return {std::make_shared<ReservoirSampleSlice>(sliceStart, sliceEnd, numberOfWorkerThreads, sampleSize)}; });
+}
+
+std::vector<SampledRecord> ReservoirSampleOperatorHandler::mergeReservoirs(
+    const std::vector<const WorkerReservoir*>& reservoirs, const uint64_t sampleSize, std::mt19937_64& generator)
+{
+    /// The unpicked records that each reservoir has seen and the slots that it has not handed out, yet
+    std::vector<uint64_t> unpickedRecords;
+    std::vector<std::vector<uint64_t>> unpickedSlots;
+    uint64_t numberOfUnpickedRecords = 0;
+    for (const auto* reservoir : reservoirs)
+    {
+        unpickedRecords.push_back(reservoir->numberOfSeenRecords);
+        unpickedSlots.push_back(reservoir->slots);
+        numberOfUnpickedRecords += reservoir->numberOfSeenRecords;
+    }
+
+    std::vector<SampledRecord> sample;
+    sample.reserve(std::min(sampleSize, numberOfUnpickedRecords));
+    while (sample.size() < sampleSize and numberOfUnpickedRecords > 0)
+    {
+        auto pick = std::uniform_int_distribution<uint64_t>(0, numberOfUnpickedRecords - 1)(generator);
+        size_t reservoir = 0;
+        while (pick >= unpickedRecords[reservoir])
+        {
+            pick -= unpickedRecords[reservoir];
+            ++reservoir;
+        }
+        /// A reservoir hands out at most as many records as it has seen or slots, thus it holds a slot as long as it has unpicked records
+        auto& slots = unpickedSlots[reservoir];
+        INVARIANT(not slots.empty(), "Reservoir {} has unpicked records but no slots", reservoir);
+        const auto slot = std::uniform_int_distribution<size_t>(0, slots.size() - 1)(generator);
+        sample.push_back({.pagedVector = reservoirs[reservoir]->records.get(), .position = slots[slot]});
+        std::swap(slots[slot], slots.back());
+        slots.pop_back();
+        --unpickedRecords[reservoir];
+        --numberOfUnpickedRecords;
+    }
+    return sample;
+}
+
+void ReservoirSampleOperatorHandler::triggerSlices(
+    const std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>>& slicesAndWindowInfo,
+    PipelineExecutionContext* pipelineCtx)
+{
+    for (const auto& [windowInfo, allSlices] : slicesAndWindowInfo)
+    {
+        std::vector<const WorkerReservoir*> reservoirs;
+        IngestionTimestamps ingestionTimestamps;
+        for (const auto& slice : allSlices)
+        {
+            const auto& reservoirSlice = dynamic_cast<const ReservoirSampleSlice&>(*slice);
+            for (const auto& reservoir : reservoirSlice.getReservoirs())
+            {
+                reservoirs.push_back(&reservoir);
+            }
+            ingestionTimestamps.merge(slice->getIngestionTimestamps());
+        }
+
+        /// Windows may be triggered concurrently, while they share the random number generator
+        const auto sample = [&]
+        {
+            const std::scoped_lock lock(generatorMutex);
+            return mergeReservoirs(reservoirs, sampleSize, generator);
+        }();
+
+        /// Emits the sample in chunks of as many sampled records as fit into a tuple buffer besides the trigger
+        ChunkNumber::Underlying chunkNumber = ChunkNumber::INITIAL;
+        size_t emittedRecords = 0;
+        do
+        {
+            auto tupleBuffer = pipelineCtx->getBufferManager()->getBufferBlocking();
+            const auto recordsPerBuffer = (tupleBuffer.getBufferSize() - sizeof(EmittedReservoirSample)) / sizeof(SampledRecord);
+            INVARIANT(recordsPerBuffer > 0, "The tuple buffers are too small for the trigger of a reservoir sample");
+            const auto numberOfRecords = std::min(recordsPerBuffer, sample.size() - emittedRecords);
+            const auto isLastChunk = emittedRecords + numberOfRecords == sample.size();
+
+            /// The watermark cannot be the window end as some buffers might be still waiting to get processed.
+            tupleBuffer.setOriginId(outputOriginId);
+            tupleBuffer.setSequenceNumber(windowInfo.sequenceNumber);
+            tupleBuffer.setChunkNumber(ChunkNumber(chunkNumber));
+            tupleBuffer.setLastChunk(isLastChunk);
+            tupleBuffer.setWatermark(windowInfo.windowInfo.windowStart);
+            tupleBuffer.setNumberOfTuples(numberOfRecords);
+            tupleBuffer.setCreationTimestampInMS(Timestamp(
+                std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now().time_since_epoch())
+                    .count()));
+            tupleBuffer.setIngestionTimestampsInNS(ingestionTimestamps.min, ingestionTimestamps.max);
+            auto* trigger
+                = new (tupleBuffer.getAvailableMemoryArea().data()) EmittedReservoirSample{windowInfo.windowInfo, numberOfRecords};
+            std::ranges::copy(
+                sample.begin() + static_cast<std::ptrdiff_t>(emittedRecords),
+                sample.begin() + static_cast<std::ptrdiff_t>(emittedRecords + numberOfRecords),
+                reinterpret_cast<SampledRecord*>(trigger + 1)); /// NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            emittedRecords += numberOfRecords;
+            ++chunkNumber;
+
+            NES_TRACE(
+                "Emitted {} sampled records of window {}-{} with sequence data {}",
+                numberOfRecords,
+                windowInfo.windowInfo.windowStart,
+                windowInfo.windowInfo.windowEnd,
+                tupleBuffer.getSequenceDataAsString());
+            pipelineCtx->emitBuffer(tupleBuffer);
+        } while (emittedRecords < sample.size());
+    }
+}
+
+}
@@ -0,0 +1,97 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Sampling/ReservoirSampleProbePhysicalOperator.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
+#include <Nautilus/Interface/PagedVector/PagedVector.hpp>
+#include <Nautilus/Interface/PagedVector/PagedVectorRef.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Nautilus/Interface/RecordBuffer.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
+#include <Sampling/ReservoirSampleOperatorHandler.hpp>
+#include <Windowing/WindowMetaData.hpp>
+#include <ErrorHandling.hpp>
+#include <ExecutionContext.hpp>
+#include <WindowProbePhysicalOperator.hpp>
+#include <function.hpp>
+#include <val.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+namespace
+{
+uint64_t getNumberOfSampledRecordsProxy(const EmittedReservoirSample* trigger)
+{
+    PRECONDITION(trigger != nullptr, "The trigger of a reservoir sample should not be null");
+    return trigger->numberOfSampledRecords;
+}
+
+const SampledRecord* getSampledRecordProxy(const EmittedReservoirSample* trigger, const uint64_t index)
+{
+    PRECONDITION(trigger != nullptr, "The trigger of a reservoir sample should not be null");
+    PRECONDITION(index < trigger->numberOfSampledRecords, "Sampled record {} is out of bounds", index);
+    /// The sampled records follow the trigger in the tuple buffer
+    return reinterpret_cast<const SampledRecord*>(trigger + 1) + index; /// NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+PagedVector* getSampledPagedVectorProxy(const SampledRecord* sampledRecord)
+{
+    /// The probe solely reads the records, while the paged vector lives as long as its slice
+    return const_cast<PagedVector*>(sampledRecord->pagedVector); /// NOLINT(cppcoreguidelines-pro-type-const-cast)
+}
+
+uint64_t getSampledPositionProxy(const SampledRecord* sampledRecord)
+{
+    return sampledRecord->position;
+}
+}
+
+ReservoirSampleProbePhysicalOperator::ReservoirSampleProbePhysicalOperator(
+    const OperatorHandlerId operatorHandlerId, std::shared_ptr<TupleBufferRef> bufferRef)
+    : WindowProbePhysicalOperator(operatorHandlerId, WindowMetaData{}), bufferRef(std::move(bufferRef))
+{
+}
+
+void ReservoirSampleProbePhysicalOperator::open(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const
+{
+    /// As this operator functions as a scan, we have to set the execution context for this pipeline
+    executionCtx.watermarkTs = recordBuffer.getWatermarkTs();
+    executionCtx.currentTs = recordBuffer.getCreatingTs();
+    executionCtx.sequenceNumber = recordBuffer.getSequenceNumber();
+    executionCtx.chunkNumber = recordBuffer.getChunkNumber();
+    executionCtx.lastChunk = recordBuffer.isLastChunk();
+    executionCtx.originId = recordBuffer.getOriginId();
+    executionCtx.minIngestionTs = recordBuffer.getMinIngestionTs();
+    executionCtx.maxIngestionTs = recordBuffer.getMaxIngestionTs();
+    openChild(executionCtx, recordBuffer);
+
+    const auto trigger = static_cast<nautilus::val<EmittedReservoirSample*>>(recordBuffer.getMemArea());
+    const auto numberOfSampledRecords = invoke(getNumberOfSampledRecordsProxy, trigger);
+    const auto fieldNames = bufferRef->getAllFieldNames();
+    for (nautilus::val<uint64_t> index = 0; index < numberOfSampledRecords; index = index + nautilus::val<uint64_t>(1))
+    {
+        const auto sampledRecord = invoke(getSampledRecordProxy, trigger, index);
+        const PagedVectorRef pagedVectorRef(invoke(getSampledPagedVectorProxy, sampledRecord), bufferRef);
+        auto record = pagedVectorRef.readRecord(invoke(getSampledPositionProxy, sampledRecord), fieldNames);
+        executeChild(executionCtx, record);
+    }
+}
+
+}
@@ -0,0 +1,63 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Sampling/ReservoirSampleSlice.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+#include <Nautilus/Interface/PagedVector/PagedVector.hpp>
+#include <SliceStore/Slice.hpp>
+
+namespace NES
+{
+
+ReservoirSampleSlice::ReservoirSampleSlice(
+    const SliceStart sliceStart, const SliceEnd sliceEnd, const uint64_t numberOfWorkerThreads, const uint64_t sampleSize)
+    : Slice(sliceStart, sliceEnd), sampleSize(sampleSize), reservoirs(numberOfWorkerThreads)
+{
+}
+
+bool ReservoirSampleSlice::admitRecord(const WorkerThreadId workerThreadId)
+{
+    auto& reservoir = reservoirs[workerThreadId % reservoirs.size()];
+    const auto position = reservoir.records->getTotalNumberOfEntries();
+    const auto seenRecords = reservoir.numberOfSeenRecords++;
+    if (seenRecords < sampleSize)
+    {
+        reservoir.slots.push_back(position);
+        return true;
+    }
+    /// The record replaces a random sampled record with the probability sampleSize / (seenRecords + 1)
+    thread_local std::mt19937_64 generator{std::random_device{}()};
+    if (const auto slot = std::uniform_int_distribution<uint64_t>(0, seenRecords)(generator); slot < sampleSize)
+    {
+        reservoir.slots[slot] = position;
+        return true;
+    }
+    return false;
+}
+
+PagedVector* ReservoirSampleSlice::getPagedVector(const WorkerThreadId workerThreadId) const
+{
+    return reservoirs[workerThreadId % reservoirs.size()].records.get();
+}
+
+const std::vector<WorkerReservoir>& ReservoirSampleSlice::getReservoirs() const
+{
+    return reservoirs;
+}
+
+}
@@ -15,19 +15,30 @@
 
 #include <ScanPhysicalOperator.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <ranges>
 #include <utility>
 #include <vector>
 
+#include <DataTypes/Schema.hpp>
+#include <Functions/BatchKernels.hpp>
+#include <Functions/TransposeKernels.hpp>
+#include <Nautilus/DataTypes/DataTypesUtil.hpp>
+#include <Nautilus/Interface/BufferRef/ColumnTupleBufferRef.hpp>
+#include <Nautilus/Interface/BufferRef/RowTupleBufferRef.hpp>
 #include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
 #include <Nautilus/Interface/Record.hpp>
 #include <Nautilus/Interface/RecordBuffer.hpp>
 #include <Util/StdInt.hpp>
+#include <EmitPhysicalOperator.hpp>
 #include <ExecutionContext.hpp>
 #include <InputFormatterTupleBufferRef.hpp>
 #include <PhysicalOperator.hpp>
+#include <SelectionPhysicalOperator.hpp>
 #include <val.hpp>
 
 namespace NES
@@ -55,10 +66,204 @@ void ScanPhysicalOperator::rawScan(ExecutionContext& executionCtx, RecordBuffer&
     openChild(executionCtx, recordBuffer);
 
     /// process buffer
+    if (const auto selection = getLateMaterializedSelection())
+    {
+        const auto selectionChild = selection->getChild().value();
+        inputFormatterBufferRef->readBufferWithPredicate(
+            executionCtx,
+            recordBuffer,
+            selection->getPredicateFields(),
+            [&](ExecutionContext& childExecutionCtx, Record& record) { return selection->evaluate(childExecutionCtx, record); },
+            [&](ExecutionContext& childExecutionCtx, Record& record) { selectionChild.execute(childExecutionCtx, record); });
+        return;
+    }
     const auto executeChildLambda = [this](ExecutionContext& executionCtx, Record& record) { executeChild(executionCtx, record); };
     inputFormatterBufferRef->readBuffer(executionCtx, recordBuffer, executeChildLambda);
 }
 
+std::optional<SelectionPhysicalOperator> ScanPhysicalOperator::getLateMaterializedSelection() const
+{
+    if (not isRawScan or not child.has_value())
+    {
+        return std::nullopt;
+    }
+    const auto selection = child->tryGet<SelectionPhysicalOperator>();
+    if (not selection.has_value() or not selection->getChild().has_value() or not getInputFormatter()->supportsLateMaterialization())
+    {
+        return std::nullopt;
+    }
+    /// Parsing the fields in two steps only pays off, if the predicate does not read all projected fields
+    const auto& predicateFields = selection->getPredicateFields();
+    if (predicateFields.empty() or predicateFields.size() >= projections.size()
+        or not std::ranges::all_of(predicateFields, [this](const auto& field) { return std::ranges::contains(projections, field); }))
+    {
+        return std::nullopt;
+    }
+    return selection;
+}
+
+bool ScanPhysicalOperator::requiresOrderedOutput() const
+{
+    const auto inputFormatterBufferRef = getInputFormatter();
+    return inputFormatterBufferRef != nullptr and inputFormatterBufferRef->requiresOrderedOutput();
+}
+
+std::shared_ptr<InputFormatterTupleBufferRef> ScanPhysicalOperator::getInputFormatter() const
+{
+    return std::dynamic_pointer_cast<InputFormatterTupleBufferRef>(this->bufferRef);
+}
+
+const std::vector<Record::RecordFieldIdentifier>& ScanPhysicalOperator::getProjections() const
+{
+    return projections;
+}
+
+std::optional<SelectionPhysicalOperator> ScanPhysicalOperator::getBatchSelection() const
+{
+    if (isRawScan or not child.has_value())
+    {
+        return std::nullopt;
+    }
+    const auto selection = child->tryGet<SelectionPhysicalOperator>();
+    if (not selection.has_value() or selection->getBatchFilters().empty())
+    {
+        return std::nullopt;
+    }
+    for (const auto& filter : selection->getBatchFilters())
+    {
+        const auto location = bufferRef->getFieldLocation(filter.field);
+        if (not location.has_value() or location->type.nullable or location->type.type != filter.fieldType)
+        {
+            return std::nullopt;
+        }
+    }
+    return selection;
+}
+
+void ScanPhysicalOperator::vectorizedScan(
+    ExecutionContext& executionCtx, RecordBuffer& recordBuffer, const SelectionPhysicalOperator& selection) const
+{
+    const auto& batchFilters = selection.getBatchFilters();
+    const auto bufferAddress = recordBuffer.getMemArea();
+
+    /// The mask and the selection vector are reused for all batches of this buffer
+    const auto mask = executionCtx.allocateMemory(VECTORIZED_BATCH_SIZE);
+    const auto selectionVector = executionCtx.allocateMemory(VECTORIZED_BATCH_SIZE * sizeof(uint64_t));
+
+    const auto numberOfRecords = recordBuffer.getNumRecords();
+    for (nautilus::val<uint64_t> begin = 0_u64; begin < numberOfRecords; begin = begin + VECTORIZED_BATCH_SIZE)
+    {
+        nautilus::val<uint64_t> batchSize = numberOfRecords - begin;
+        if (batchSize > VECTORIZED_BATCH_SIZE)
+        {
+            batchSize = VECTORIZED_BATCH_SIZE;
+        }
+
+        /// Evaluate all batch filters field by field and collect the indices of the qualifying records
+        for (size_t filterIndex = 0; filterIndex < batchFilters.size(); ++filterIndex)
+        {
+            const auto& filter = batchFilters[filterIndex];
+            const auto location = bufferRef->getFieldLocation(filter.field).value();
+            filter.evaluate(bufferAddress + location.offset, location.stride, begin, batchSize, mask, filterIndex == 0);
+        }
+        const auto numberOfSelected = compactSelection(mask, begin, batchSize, selectionVector);
+
+        /// Only the qualifying records are materialized and passed to the residual part of the selection
+        for (nautilus::val<uint64_t> i = 0_u64; i < numberOfSelected; i = i + 1_u64)
+        {
+            auto recordIndex = readValueFromMemRef<uint64_t>(selectionVector + (i * sizeof(uint64_t)));
+            auto record = bufferRef->readRecord(projections, recordBuffer, recordIndex);
+            selection.executeResidual(executionCtx, record);
+        }
+    }
+}
+
+namespace
+{
+Schema getSchema(const TupleBufferRef& bufferRef)
+{
+    Schema schema;
+    for (const auto& [name, type] : std::views::zip(bufferRef.getAllFieldNames(), bufferRef.getAllDataTypes()))
+    {
+        schema.addField(name, type);
+    }
+    return schema;
+}
+
+bool isRowLayout(const TupleBufferRef& bufferRef)
+{
+    return dynamic_cast<const RowTupleBufferRef*>(&bufferRef) != nullptr;
+}
+
+bool isColumnarLayout(const TupleBufferRef& bufferRef)
+{
+    return dynamic_cast<const ColumnTupleBufferRef*>(&bufferRef) != nullptr;
+}
+}
+
+std::optional<EmitPhysicalOperator> ScanPhysicalOperator::getTransposingEmit() const
+{
+    if (isRawScan or not child.has_value())
+    {
+        return std::nullopt;
+    }
+    const auto emit = child->tryGet<EmitPhysicalOperator>();
+    if (not emit.has_value() or emit->getChild().has_value())
+    {
+        return std::nullopt;
+    }
+    const auto& emitBufferRef = emit->getBufferRef();
+    const bool isRowToColumnar = isRowLayout(*bufferRef) and isColumnarLayout(emitBufferRef);
+    const bool isColumnarToRow = isColumnarLayout(*bufferRef) and isRowLayout(emitBufferRef);
+    const auto fieldNames = bufferRef->getAllFieldNames();
+    if ((not isRowToColumnar and not isColumnarToRow) or (not projections.empty() and projections != fieldNames)
+        or emitBufferRef.getAllFieldNames() != fieldNames or emitBufferRef.getAllDataTypes() != bufferRef->getAllDataTypes())
+    {
+        return std::nullopt;
+    }
+    const auto columnarBufferSize = isRowToColumnar ? emitBufferRef.getBufferSize() : bufferRef->getBufferSize();
+    if (not getTransposedFields(getSchema(*bufferRef), columnarBufferSize).has_value())
+    {
+        return std::nullopt;
+    }
+    return emit;
+}
+
+void ScanPhysicalOperator::transposingScan(
+    ExecutionContext& executionCtx, RecordBuffer& recordBuffer, const EmitPhysicalOperator& emit) const
+{
+    const auto& emitBufferRef = emit.getBufferRef();
+    const bool isRowToColumnar = isRowLayout(*bufferRef);
+    const auto& rowBufferRef = isRowToColumnar ? *bufferRef : emitBufferRef;
+    const auto& columnarBufferRef = isRowToColumnar ? emitBufferRef : *bufferRef;
+    const auto fields = getTransposedFields(getSchema(*bufferRef), columnarBufferRef.getBufferSize()).value();
+    const auto rowTupleSize = rowBufferRef.getTupleSize();
+
+    /// The emit is neither opened nor closed, as the scan fills and emits the result buffers itself. Like the emit, the scan emits
+    /// an empty buffer for an empty input buffer, as the last result buffer of an input buffer closes its chunk.
+    const auto numberOfRecords = recordBuffer.getNumRecords();
+    const nautilus::val<uint64_t> capacity = emitBufferRef.getCapacity();
+    nautilus::val<uint64_t> begin = 0_u64;
+    const auto emitTransposed = [&](const nautilus::val<uint64_t>& size, const nautilus::val<bool>& isLastResult)
+    {
+        auto resultBuffer = RecordBuffer(executionCtx.allocateBuffer());
+        if (isRowToColumnar)
+        {
+            transposeRowsToColumns(fields, rowTupleSize, recordBuffer.getMemArea(), begin, size, resultBuffer.getMemArea());
+        }
+        else
+        {
+            transposeColumnsToRows(fields, rowTupleSize, recordBuffer.getMemArea(), begin, size, resultBuffer.getMemArea());
+        }
+        emit.emitRecordBuffer(executionCtx, resultBuffer, size, isLastResult);
+    };
+    for (; numberOfRecords - begin > capacity; begin = begin + capacity)
+    {
+        emitTransposed(capacity, false);
+    }
+    emitTransposed(numberOfRecords - begin, true);
+}
+
 void ScanPhysicalOperator::open(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const
 {
     /// initialize global state variables to keep track of the watermark ts and the origin id
@@ -68,14 +273,26 @@ void ScanPhysicalOperator::open(ExecutionContext& executionCtx, RecordBuffer& re
     executionCtx.sequenceNumber = recordBuffer.getSequenceNumber();
     executionCtx.chunkNumber = recordBuffer.getChunkNumber();
     executionCtx.lastChunk = recordBuffer.isLastChunk();
+    executionCtx.minIngestionTs = recordBuffer.getMinIngestionTs();
+    executionCtx.maxIngestionTs = recordBuffer.getMaxIngestionTs();
 
     if (isRawScan)
     {
         rawScan(executionCtx, recordBuffer);
         return;
     }
+    if (const auto emit = getTransposingEmit())
+    {
+        transposingScan(executionCtx, recordBuffer, *emit);
+        return;
+    }
     /// call open on all child operators
     openChild(executionCtx, recordBuffer);
+    if (const auto selection = getBatchSelection())
+    {
+        vectorizedScan(executionCtx, recordBuffer, *selection);
+        return;
+    }
     /// iterate over records in buffer
     auto numberOfRecords = recordBuffer.getNumRecords();
     for (nautilus::val<uint64_t> i = 0_u64; i < numberOfRecords; i = i + 1_u64)
@@ -85,6 +302,16 @@ void ScanPhysicalOperator::open(ExecutionContext& executionCtx, RecordBuffer& re
     }
 }
 
+void ScanPhysicalOperator::close(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const
+{
+    /// The transposing scan has already emitted all result buffers of the emit, which it never opened
+    if (getTransposingEmit().has_value())
+    {
+        return;
+    }
+    closeChild(executionCtx, recordBuffer);
+}
+
 std::optional<PhysicalOperator> ScanPhysicalOperator::getChild() const
 {
     return child;
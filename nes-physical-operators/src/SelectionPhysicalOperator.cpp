@@ -12,20 +12,144 @@
     limitations under the License.
 */
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <numeric>
 #include <optional>
 #include <utility>
+#include <vector>
+#include <Functions/PhysicalFunction.hpp>
 #include <Nautilus/Interface/Record.hpp>
+#include <ErrorHandling.hpp>
 #include <ExecutionContext.hpp>
 #include <PhysicalOperator.hpp>
 #include <SelectionPhysicalOperator.hpp>
+#include <function.hpp>
+#include <val.hpp>
+#include <val_ptr.hpp>
 
 namespace NES
 {
 
+ConjunctProfile::ConjunctProfile(const size_t numberOfConjuncts)
+    : numberOfConjuncts(numberOfConjuncts), passedRecords(std::make_unique<std::atomic<uint64_t>[]>(numberOfConjuncts))
+{
+    PRECONDITION(
+        numberOfConjuncts <= MAX_NUMBER_OF_CONJUNCTS,
+        "Can profile at most {} conjuncts, got {}",
+        MAX_NUMBER_OF_CONJUNCTS,
+        numberOfConjuncts);
+}
+
+void ConjunctProfile::record(const uint64_t passedConjuncts)
+{
+    /// The profile only steers the evaluation order, thus the counters do not have to be consistent with each other
+    for (size_t conjunct = 0; conjunct < numberOfConjuncts; ++conjunct)
+    {
+        if ((passedConjuncts >> conjunct) & 1U)
+        {
+            passedRecords[conjunct].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+const std::vector<size_t>& ConjunctProfile::getEvaluationOrder() const
+{
+    std::call_once(
+        evaluationOrderFixed,
+        [this]
+        {
+            std::vector<uint64_t> passed(numberOfConjuncts);
+            for (size_t conjunct = 0; conjunct < numberOfConjuncts; ++conjunct)
+            {
+                passed[conjunct] = passedRecords[conjunct].load(std::memory_order_relaxed);
+            }
+            /// All conjuncts were evaluated on the same records, thus the number of passed records orders them like their pass rates
+            evaluationOrder.resize(numberOfConjuncts);
+            std::iota(evaluationOrder.begin(), evaluationOrder.end(), 0);
+            std::ranges::stable_sort(evaluationOrder, {}, [&](const size_t conjunct) { return passed[conjunct]; });
+        });
+    return evaluationOrder;
+}
+
+SelectionPhysicalOperator::SelectionPhysicalOperator(PhysicalFunction function, std::vector<PhysicalFunction> profiledConjuncts)
+    : function(std::move(function))
+    , profiledConjuncts(std::move(profiledConjuncts))
+    , conjunctProfile(std::make_shared<ConjunctProfile>(this->profiledConjuncts.size()))
+{
+}
+
 void SelectionPhysicalOperator::execute(ExecutionContext& ctx, Record& record) const
 {
     /// evaluate function and call child operator if function is valid
+    if (evaluate(ctx, record))
+    {
+        executeChild(ctx, record);
+    }
+}
+
+nautilus::val<bool> SelectionPhysicalOperator::evaluate(ExecutionContext& ctx, Record& record) const
+{
+    if (conjunctProfile)
+    {
+        if (ctx.recordProfiles)
+        {
+            return evaluateAndProfileConjuncts(ctx, record);
+        }
+        /// The conjuncts are side effect free, thus, we may skip the remaining conjuncts once a conjunct rejects the record
+        for (const auto conjunct : conjunctProfile->getEvaluationOrder())
+        {
+            if (not profiledConjuncts[conjunct].execute(record, ctx.pipelineMemoryProvider.arena))
+            {
+                return {false};
+            }
+        }
+        return {true};
+    }
     if (function.execute(record, ctx.pipelineMemoryProvider.arena))
+    {
+        return {true};
+    }
+    return {false};
+}
+
+nautilus::val<bool> SelectionPhysicalOperator::evaluateAndProfileConjuncts(ExecutionContext& ctx, Record& record) const
+{
+    nautilus::val<uint64_t> passedConjuncts = 0;
+    for (size_t conjunct = 0; conjunct < profiledConjuncts.size(); ++conjunct)
+    {
+        if (profiledConjuncts[conjunct].execute(record, ctx.pipelineMemoryProvider.arena))
+        {
+            passedConjuncts = passedConjuncts | nautilus::val<uint64_t>(uint64_t{1} << conjunct);
+        }
+    }
+    nautilus::invoke(
+        +[](ConjunctProfile* profile, const uint64_t passed) { profile->record(passed); },
+        nautilus::val<ConjunctProfile*>(conjunctProfile.get()),
+        passedConjuncts);
+    const auto allConjuncts = profiledConjuncts.size() == ConjunctProfile::MAX_NUMBER_OF_CONJUNCTS
+        ? ~uint64_t{0}
+        : (uint64_t{1} << profiledConjuncts.size()) - 1;
+    return passedConjuncts == nautilus::val<uint64_t>(allConjuncts);
+}
+
+void SelectionPhysicalOperator::setPredicateFields(std::vector<Record::RecordFieldIdentifier> predicateFields)
+{
+    this->predicateFields = std::move(predicateFields);
+}
+
+void SelectionPhysicalOperator::executeResidual(ExecutionContext& ctx, Record& record) const
+{
+    if (not residualFunction.has_value())
+    {
+        executeChild(ctx, record);
+        return;
+    }
+    if (residualFunction->execute(record, ctx.pipelineMemoryProvider.arena))
     {
         executeChild(ctx, record);
     }
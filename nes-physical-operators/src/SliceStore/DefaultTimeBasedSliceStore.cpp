@@ -15,10 +15,14 @@
 #include <SliceStore/DefaultTimeBasedSliceStore.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
+#include <numeric>
 #include <optional>
+#include <ranges>
 #include <utility>
 #include <vector>
 #include <Identifiers/Identifiers.hpp>
@@ -33,9 +37,51 @@
 
 namespace NES
 {
-DefaultTimeBasedSliceStore::DefaultTimeBasedSliceStore(const uint64_t windowSize, const uint64_t windowSlide)
-    : sliceAssigner(windowSize, windowSlide), sequenceNumber(SequenceNumber::INITIAL), numberOfActiveInputPipelines(0)
+namespace
 {
+uint64_t getSliceGranularity(const std::vector<SliceAssigner>& windowDefinitions)
+{
+    uint64_t sliceGranularity = 0;
+    for (const auto& windowDefinition : windowDefinitions)
+    {
+        sliceGranularity = std::gcd(sliceGranularity, std::gcd(windowDefinition.getWindowSize(), windowDefinition.getWindowSlide()));
+    }
+    return sliceGranularity;
+}
+
+/// A single window definition cuts its slices at the window starts and ends. Multiple definitions share slices of the same length,
+/// which, as the length divides all sizes and slides, lie either completely within or completely outside of every window.
+SliceAssigner getSliceAssigner(const std::vector<SliceAssigner>& windowDefinitions, const uint64_t sliceGranularity)
+{
+    PRECONDITION(not windowDefinitions.empty(), "Expects at least one window definition");
+    if (windowDefinitions.size() == 1)
+    {
+        return windowDefinitions.front();
+    }
+    return SliceAssigner(sliceGranularity, sliceGranularity);
+}
+}
+
+DefaultTimeBasedSliceStore::DefaultTimeBasedSliceStore(
+    const uint64_t windowSize, const uint64_t windowSlide, const std::optional<uint64_t> allowedLateness)
+    : DefaultTimeBasedSliceStore(std::vector{SliceAssigner(windowSize, windowSlide)}, allowedLateness)
+{
+}
+
+DefaultTimeBasedSliceStore::DefaultTimeBasedSliceStore(
+    std::vector<SliceAssigner> windowDefinitions, const std::optional<uint64_t> allowedLateness)
+    : firstWindowToTriggerEnd(Timestamp::INVALID_VALUE)
+    , windowDefinitions(std::move(windowDefinitions))
+    , sliceAssigner(getSliceAssigner(this->windowDefinitions, getSliceGranularity(this->windowDefinitions)))
+    , largestWindowSize(std::ranges::max(this->windowDefinitions | std::views::transform(&SliceAssigner::getWindowSize)))
+    , allowedLateness(allowedLateness)
+    , triggerWatermark(Timestamp::INITIAL_VALUE)
+    , sliceGranularity(getSliceGranularity(this->windowDefinitions))
+    , sliceCacheEpoch(0)
+    , sequenceNumber(SequenceNumber::INITIAL)
+    , numberOfActiveInputPipelines(0)
+{
+    PRECONDITION(sliceGranularity > 0, "The window size and slide must not both be zero");
 }
 
 DefaultTimeBasedSliceStore::~DefaultTimeBasedSliceStore()
@@ -44,15 +90,33 @@ DefaultTimeBasedSliceStore::~DefaultTimeBasedSliceStore()
 }
 
 std::vector<std::shared_ptr<Slice>> DefaultTimeBasedSliceStore::getSlicesOrCreate(
-    const Timestamp timestamp, const std::function<std::vector<std::shared_ptr<Slice>>(SliceStart, SliceEnd)>& createNewSlice)
+    const Timestamp timestamp,
+    const WorkerThreadId workerThreadId,
+    const std::function<std::vector<std::shared_ptr<Slice>>(SliceStart, SliceEnd)>& createNewSlice)
 {
     /// We first check, if the slice already exist in the slice store
     const auto sliceStart = sliceAssigner.getSliceStartTs(timestamp);
     const auto sliceEnd = sliceAssigner.getSliceEndTs(timestamp);
+
+    /// Almost all records belong to a slice that the worker thread has looked up recently. We look up these slices in the slice cache of
+    /// the worker thread, as acquiring even the read lock for every record lets all build threads contend on the same cache line.
+    auto* const sliceCache = getSliceCache(workerThreadId);
+    if (sliceCache != nullptr)
+    {
+        if (const auto& cachedSlice = getSliceCacheSlot(*sliceCache, sliceStart); cachedSlice and cachedSlice->getSliceEnd() == sliceEnd)
+        {
+            return {cachedSlice};
+        }
+    }
+
     {
         const auto slicesWriteLocked = slices.rlock();
         if (const auto existingSlice = slicesWriteLocked->find(sliceEnd); existingSlice != slicesWriteLocked->end())
         {
+            if (sliceCache != nullptr)
+            {
+                getSliceCacheSlot(*sliceCache, sliceStart) = existingSlice->second;
+            }
             return {existingSlice->second};
         }
     }
@@ -64,25 +128,45 @@ std::vector<std::shared_ptr<Slice>> DefaultTimeBasedSliceStore::getSlicesOrCreat
     const auto newSlices = createNewSlice(sliceStart, sliceEnd);
     INVARIANT(newSlices.size() == 1, "We assume that only one slice is created per timestamp for our default time-based slice store.");
     auto [slicesWriteLocked, windowsWriteLocked] = acquireLocked(slices, windows);
-    if (slicesWriteLocked->contains(sliceEnd))
+    if (const auto existingSlice = slicesWriteLocked->find(sliceEnd); existingSlice != slicesWriteLocked->end())
     {
-        return {slicesWriteLocked->find(sliceEnd)->second};
+        if (sliceCache != nullptr)
+        {
+            getSliceCacheSlot(*sliceCache, sliceStart) = existingSlice->second;
+        }
+        return {existingSlice->second};
     }
 
     /// At this moment, we can be sure that no slice exists and we can insert the newly created slice into the slice store
     auto newSlice = newSlices[0];
     slicesWriteLocked->emplace(sliceEnd, newSlice);
+    if (sliceCache != nullptr)
+    {
+        getSliceCacheSlot(*sliceCache, sliceStart) = newSlice;
+    }
     slicesWriteLocked.unlock();
 
     /// Update the state of all windows that contain this slice as we have to expect new tuples
-    for (auto windowInfo : sliceAssigner.getAllWindowsForSlice(*newSlice))
+    for (auto windowInfo : getAllWindowsForSlice(*newSlice))
     {
+        /// A late record must not create a window again, which got garbage collected after its allowed lateness passed
+        if (allowedLateness.has_value() and hasAllowedLatenessPassed(windowInfo) and not windowsWriteLocked->contains(windowInfo))
+        {
+            continue;
+        }
         const auto numberOfExpectedSlices = sliceAssigner.getWindowSize() / sliceAssigner.getWindowSlide();
         const auto [it, success] = windowsWriteLocked->try_emplace(windowInfo, numberOfExpectedSlices);
-        INVARIANT(
-            it->second.windowState != WindowInfoState::EMITTED_TO_PROBE,
-            "We should not add slices to a window that has already been triggered.");
-        it->second.windowState = WindowInfoState::WINDOW_FILLING;
+        /// With an allowed lateness, the build marks the window to be emitted again, once it added the late records, c.f.,
+        /// markWindowsWithLateUpdates. Otherwise, the window drops the late records, e.g., of a source that resumed after it was idle.
+        if (const auto windowState = it->second.windowState;
+            windowState != WindowInfoState::EMITTED_TO_PROBE and windowState != WindowInfoState::UPDATED_AFTER_EMISSION)
+        {
+            it->second.windowState = WindowInfoState::WINDOW_FILLING;
+        }
+        if (it->second.windowState != WindowInfoState::EMITTED_TO_PROBE)
+        {
+            addWindowToTrigger(windowInfo);
+        }
         it->second.windowSlices.emplace_back(newSlice);
     }
 
@@ -92,6 +176,22 @@ std::vector<std::shared_ptr<Slice>> DefaultTimeBasedSliceStore::getSlicesOrCreat
 std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>>
 DefaultTimeBasedSliceStore::getTriggerableWindowSlices(const Timestamp globalWatermark)
 {
+    if (allowedLateness.has_value())
+    {
+        auto previousWatermark = triggerWatermark.load();
+        while (previousWatermark < globalWatermark.getRawValue()
+               and not triggerWatermark.compare_exchange_weak(previousWatermark, globalWatermark.getRawValue()))
+        {
+        }
+    }
+
+    /// Most watermarks of high-rate streams advance within the same slice. They can not trigger a window, as a window gets triggered
+    /// once the watermark passed its end.
+    if (globalWatermark.getRawValue() <= firstWindowToTriggerEnd.load())
+    {
+        return {};
+    }
+
     /// For performance reasons, we check if we can acquire a lock and if not we then simply skip checking if we can trigger anything
     const auto windowsWriteLocked = windows.tryWLock();
     if (windowsWriteLocked.isNull())
@@ -99,19 +199,31 @@ DefaultTimeBasedSliceStore::getTriggerableWindowSlices(const Timestamp globalWat
         return {};
     }
 
-    /// We are iterating over all windows and check if they can be triggered
+    /// We are iterating over all windows from the first window that may be triggered on and check if they can be triggered.
+    /// Thus, we do not iterate over the emitted windows, which wait for their garbage collection, e.g., for their allowed lateness.
     /// A window can be triggered if all sides have been filled and the window end is smaller than the new global watermark
     std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>> windowsToSlices;
-    for (auto& [windowInfo, windowSlicesAndState] : *windowsWriteLocked)
+    if (not firstWindowToTrigger.has_value())
+    {
+        return windowsToSlices;
+    }
+    auto window = windowsWriteLocked->lower_bound(firstWindowToTrigger.value());
+    firstWindowToTrigger.reset();
+    firstWindowToTriggerEnd = Timestamp::INVALID_VALUE;
+    for (; window != windowsWriteLocked->end(); ++window)
     {
+        auto& [windowInfo, windowSlicesAndState] = *window;
         if (windowInfo.windowEnd >= globalWatermark)
         {
-            /// As the windows are sorted (due to std::map), we can break here as we will not find any windows with a smaller window end
+            /// As the windows are sorted (due to std::map), we can break here as we will not find any windows with a smaller window end.
+            /// All windows before this window have been emitted, thus, the next trigger starts at this window.
+            firstWindowToTrigger = windowInfo;
+            firstWindowToTriggerEnd = windowInfo.windowEnd.getRawValue();
             break;
         }
         if (windowSlicesAndState.windowState == WindowInfoState::EMITTED_TO_PROBE)
         {
-            /// This window has already been triggered
+            /// This window has already been triggered and late records have not updated it since
             continue;
         }
 
@@ -126,6 +238,16 @@ DefaultTimeBasedSliceStore::getTriggerableWindowSlices(const Timestamp globalWat
     return windowsToSlices;
 }
 
+void DefaultTimeBasedSliceStore::addIngestionTimestamps(const Timestamp globalWatermark, const IngestionTimestamps& ingestionTimestamps)
+{
+    /// A window is triggered once the global watermark passed its end. Thus, slices that end at or after the watermark are still filled.
+    const auto slicesReadLocked = slices.rlock();
+    for (auto slice = slicesReadLocked->lower_bound(globalWatermark); slice != slicesReadLocked->end(); ++slice)
+    {
+        slice->second->addIngestionTimestamps(ingestionTimestamps);
+    }
+}
+
 std::optional<std::shared_ptr<Slice>> DefaultTimeBasedSliceStore::getSliceBySliceEnd(const SliceEnd sliceEnd)
 {
     if (const auto slicesReadLocked = slices.rlock(); slicesReadLocked->contains(sliceEnd))
@@ -191,12 +313,139 @@ std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>> Defau
                 addAllSlicesToReturnMap(windowInfo, windowSlicesAndState);
                 break;
             }
+            case WindowInfoState::UPDATED_AFTER_EMISSION: {
+                /// The other input pipelines may still add late records to the window
+                if (numberOfActiveInputPipelines > 0)
+                {
+                    continue;
+                }
+                addAllSlicesToReturnMap(windowInfo, windowSlicesAndState);
+                break;
+            }
         }
     }
 
     return windowsToSlices;
 }
 
+std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>> DefaultTimeBasedSliceStore::getFillingWindowSlices()
+{
+    /// Acquiring the write lock, so that the sequence numbers increase in the same order as for the triggered windows
+    const auto windowsWriteLocked = windows.wlock();
+    std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>> windowsToSlices;
+    for (const auto& [windowInfo, windowSlicesAndState] : *windowsWriteLocked)
+    {
+        if (windowSlicesAndState.windowState == WindowInfoState::EMITTED_TO_PROBE
+            or windowSlicesAndState.windowState == WindowInfoState::UPDATED_AFTER_EMISSION)
+        {
+            continue;
+        }
+        const auto newSequenceNumber = SequenceNumber(sequenceNumber++);
+        windowsToSlices.emplace(WindowInfoAndSequenceNumber{windowInfo, newSequenceNumber}, windowSlicesAndState.windowSlices);
+    }
+    return windowsToSlices;
+}
+
+FillingSlices DefaultTimeBasedSliceStore::getSlicesOfFillingWindows()
+{
+    /// Overlapping windows share their slices, thus we collect the slices by their end
+    std::map<SliceEnd, std::shared_ptr<Slice>> slicesOfFillingWindows;
+    FillingSlices fillingSlices;
+    {
+        const auto windowsReadLocked = windows.rlock();
+        /// All windows before the first window to trigger have been emitted
+        auto window = firstWindowToTrigger.has_value() ? windowsReadLocked->lower_bound(firstWindowToTrigger.value())
+                                                       : windowsReadLocked->end();
+        for (; window != windowsReadLocked->end(); ++window)
+        {
+            const auto& [windowInfo, windowSlicesAndState] = *window;
+            if (windowSlicesAndState.windowState == WindowInfoState::EMITTED_TO_PROBE)
+            {
+                continue;
+            }
+            fillingSlices.earliestWindowEnd = std::min(fillingSlices.earliestWindowEnd, windowInfo.windowEnd);
+            for (const auto& slice : windowSlicesAndState.windowSlices)
+            {
+                slicesOfFillingWindows.try_emplace(slice->getSliceEnd(), slice);
+            }
+        }
+    }
+    fillingSlices.slices.reserve(slicesOfFillingWindows.size());
+    for (auto& slice : slicesOfFillingWindows | std::views::values)
+    {
+        fillingSlices.slices.emplace_back(std::move(slice));
+    }
+    return fillingSlices;
+}
+
+void DefaultTimeBasedSliceStore::skipWindowsEndingBefore(const Timestamp windowEnd)
+{
+    const auto windowsWriteLocked = windows.wlock();
+    for (auto& [windowInfo, windowSlicesAndState] : *windowsWriteLocked)
+    {
+        if (windowInfo.windowEnd >= windowEnd)
+        {
+            break;
+        }
+        /// The garbage collection deletes the skipped windows, as if the probe had processed them
+        windowSlicesAndState.windowState = WindowInfoState::EMITTED_TO_PROBE;
+    }
+}
+
+std::optional<uint64_t> DefaultTimeBasedSliceStore::getAllowedLateness() const
+{
+    return allowedLateness;
+}
+
+bool DefaultTimeBasedSliceStore::isBeyondAllowedLateness(const Timestamp timestamp) const
+{
+    if (not allowedLateness.has_value())
+    {
+        return false;
+    }
+    /// All windows that contain the timestamp end after it. Thus, (almost) all records pass the first check.
+    const auto watermark = triggerWatermark.load();
+    if (timestamp.getRawValue() + allowedLateness.value() >= watermark)
+    {
+        return false;
+    }
+    /// The latest window of a window definition that contains the timestamp starts at the largest multiple of the slide before it
+    uint64_t latestWindowEnd = 0;
+    for (const auto& windowDefinition : windowDefinitions)
+    {
+        const auto windowSlide = windowDefinition.getWindowSlide();
+        const auto latestWindowStart = timestamp.getRawValue() / windowSlide * windowSlide;
+        latestWindowEnd = std::max(latestWindowEnd, latestWindowStart + windowDefinition.getWindowSize());
+    }
+    return latestWindowEnd + allowedLateness.value() < watermark;
+}
+
+void DefaultTimeBasedSliceStore::markWindowsWithLateUpdates(const std::vector<std::shared_ptr<Slice>>& updatedSlices)
+{
+    /// A window gets triggered, once the watermark passed its end. Thus, only slices that end before the watermark belong to triggered
+    /// windows.
+    const Timestamp watermark(triggerWatermark.load());
+    if (not allowedLateness.has_value()
+        or std::ranges::none_of(updatedSlices, [&](const auto& slice) { return slice->getSliceEnd() <= watermark; }))
+    {
+        return;
+    }
+
+    const auto windowsWriteLocked = windows.wlock();
+    for (const auto& slice : updatedSlices)
+    {
+        for (const auto& windowInfo : getAllWindowsForSlice(*slice))
+        {
+            if (const auto window = windowsWriteLocked->find(windowInfo); window != windowsWriteLocked->end()
+                and window->second.windowState == WindowInfoState::EMITTED_TO_PROBE and not hasAllowedLatenessPassed(windowInfo))
+            {
+                window->second.windowState = WindowInfoState::UPDATED_AFTER_EMISSION;
+                addWindowToTrigger(windowInfo);
+            }
+        }
+    }
+}
+
 void DefaultTimeBasedSliceStore::garbageCollectSlicesAndWindows(const Timestamp newGlobalWaterMark)
 {
     std::vector<std::shared_ptr<Slice>> slicesToDelete;
@@ -212,11 +461,13 @@ void DefaultTimeBasedSliceStore::garbageCollectSlicesAndWindows(const Timestamp
                 for (auto windowsLockedIt = windowsWriteLocked->cbegin(); windowsLockedIt != windowsWriteLocked->cend();)
                 {
                     const auto& [windowInfo, windowSlicesAndState] = *windowsLockedIt;
-                    if (windowInfo.windowEnd < newGlobalWaterMark and windowSlicesAndState.windowState == WindowInfoState::EMITTED_TO_PROBE)
+                    const auto windowEndWithLateness = windowInfo.windowEnd + allowedLateness.value_or(0);
+                    if (windowEndWithLateness < newGlobalWaterMark
+                        and windowSlicesAndState.windowState == WindowInfoState::EMITTED_TO_PROBE)
                     {
                         windowsLockedIt = windowsWriteLocked->erase(windowsLockedIt);
                     }
-                    else if (windowInfo.windowEnd > newGlobalWaterMark)
+                    else if (windowEndWithLateness > newGlobalWaterMark)
                     {
                         /// As the windows are sorted (due to std::map), we can break here as we will not find any windows with a smaller window end
                         break;
@@ -237,7 +488,7 @@ void DefaultTimeBasedSliceStore::garbageCollectSlicesAndWindows(const Timestamp
                 for (auto slicesLockedIt = slicesWriteLocked->begin(); slicesLockedIt != slicesWriteLocked->end();)
                 {
                     const auto& [sliceEnd, slicePtr] = *slicesLockedIt;
-                    if (sliceEnd + sliceAssigner.getWindowSize() < newGlobalWaterMark)
+                    if (sliceEnd + largestWindowSize + allowedLateness.value_or(0) < newGlobalWaterMark)
                     {
                         NES_TRACE("Deleting slice with sliceEnd {} as it is not used anymore", sliceEnd);
                         /// As we are first copying the shared_ptr the destructor of Slice will not be called.
@@ -255,6 +506,12 @@ void DefaultTimeBasedSliceStore::garbageCollectSlicesAndWindows(const Timestamp
         }
     }
 
+    /// The worker threads clear their slice caches with their next lookup. Thus, a cached slice gets destroyed by its worker thread.
+    if (not slicesToDelete.empty())
+    {
+        ++sliceCacheEpoch;
+    }
+
     /// Now we can remove/call destructor on every slice without still holding the lock
     slicesToDelete.clear();
 }
@@ -262,8 +519,14 @@ void DefaultTimeBasedSliceStore::garbageCollectSlicesAndWindows(const Timestamp
 void DefaultTimeBasedSliceStore::deleteState()
 {
     auto [slicesWriteLocked, windowsWriteLocked] = acquireLocked(slices, windows);
+    for (auto& sliceCache : sliceCaches)
+    {
+        sliceCache.slices.fill(nullptr);
+    }
     slicesWriteLocked->clear();
     windowsWriteLocked->clear();
+    firstWindowToTrigger.reset();
+    firstWindowToTriggerEnd = Timestamp::INVALID_VALUE;
 }
 
 void DefaultTimeBasedSliceStore::incrementNumberOfInputPipelines()
@@ -273,6 +536,79 @@ void DefaultTimeBasedSliceStore::incrementNumberOfInputPipelines()
 
 uint64_t DefaultTimeBasedSliceStore::getWindowSize() const
 {
-    return sliceAssigner.getWindowSize();
+    return largestWindowSize;
+}
+
+uint64_t DefaultTimeBasedSliceStore::getWindowSlide() const
+{
+    return windowDefinitions.size() == 1 ? sliceAssigner.getWindowSlide() : sliceGranularity;
+}
+
+bool DefaultTimeBasedSliceStore::hasAllowedLatenessPassed(const WindowInfo& windowInfo) const
+{
+    return windowInfo.windowEnd.getRawValue() + allowedLateness.value_or(0) < triggerWatermark.load();
+}
+
+void DefaultTimeBasedSliceStore::addWindowToTrigger(const WindowInfo& windowInfo)
+{
+    if (not firstWindowToTrigger.has_value() or windowInfo < firstWindowToTrigger.value())
+    {
+        firstWindowToTrigger = windowInfo;
+        firstWindowToTriggerEnd = windowInfo.windowEnd.getRawValue();
+    }
+}
+
+void DefaultTimeBasedSliceStore::setWorkerThreads(const uint64_t numberOfWorkerThreads)
+{
+    if (sliceCaches.size() != numberOfWorkerThreads)
+    {
+        sliceCaches = std::vector<SliceCache>(numberOfWorkerThreads);
+    }
+}
+
+DefaultTimeBasedSliceStore::SliceCache* DefaultTimeBasedSliceStore::getSliceCache(const WorkerThreadId workerThreadId)
+{
+    if (workerThreadId.getRawValue() >= sliceCaches.size())
+    {
+        return nullptr;
+    }
+    /// A slice that is removed after we read the epoch may still be returned by this lookup, as for a lookup in the slices. It gets
+    /// cleared from the cache with the next lookup.
+    auto& sliceCache = sliceCaches[workerThreadId.getRawValue()];
+    if (const auto epoch = sliceCacheEpoch.load(); sliceCache.epoch != epoch)
+    {
+        sliceCache.slices.fill(nullptr);
+        sliceCache.epoch = epoch;
+    }
+    return &sliceCache;
+}
+
+std::shared_ptr<Slice>& DefaultTimeBasedSliceStore::getSliceCacheSlot(SliceCache& sliceCache, const SliceStart sliceStart) const
+{
+    return sliceCache.slices[(sliceStart.getRawValue() / sliceGranularity) % SLICE_CACHE_SIZE];
+}
+
+std::vector<WindowInfo> DefaultTimeBasedSliceStore::getAllWindowsForSlice(const Slice& slice) const
+{
+    if (windowDefinitions.size() == 1)
+    {
+        return sliceAssigner.getAllWindowsForSlice(slice);
+    }
+
+    const auto sliceStart = slice.getSliceStart().getRawValue();
+    const auto sliceEnd = slice.getSliceEnd().getRawValue();
+    std::vector<WindowInfo> allWindows;
+    for (const auto& windowDefinition : windowDefinitions)
+    {
+        const auto windowSize = windowDefinition.getWindowSize();
+        const auto windowSlide = windowDefinition.getWindowSlide();
+        /// The first window that contains the slice is the first window (starting at a multiple of the slide) that ends after the slice
+        auto windowStart = sliceEnd > windowSize ? (sliceEnd - windowSize + windowSlide - 1) / windowSlide * windowSlide : 0;
+        for (; windowStart <= sliceStart; windowStart += windowSlide)
+        {
+            allWindows.emplace_back(windowStart, windowStart + windowSize);
+        }
+    }
+    return allWindows;
 }
 }
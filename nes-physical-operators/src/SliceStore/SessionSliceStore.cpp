@@ -0,0 +1,285 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <SliceStore/SessionSliceStore.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <utility>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+#include <SliceStore/Slice.hpp>
+#include <SliceStore/WindowSlicesStoreInterface.hpp>
+#include <Time/Timestamp.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <folly/Synchronized.h>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+SessionSliceStore::SessionSlice::SessionSlice(std::shared_ptr<Slice> slice, const Timestamp firstRecordTimestamp)
+    : slice(std::move(slice)), firstTimestamp(firstRecordTimestamp.getRawValue()), lastTimestamp(firstRecordTimestamp.getRawValue())
+{
+}
+
+void SessionSliceStore::SessionSlice::addRecordTimestamp(const Timestamp timestamp) const
+{
+    const auto rawTimestamp = timestamp.getRawValue();
+    auto currentFirstTimestamp = firstTimestamp.load(std::memory_order_relaxed);
+    while (rawTimestamp < currentFirstTimestamp
+           and not firstTimestamp.compare_exchange_weak(currentFirstTimestamp, rawTimestamp, std::memory_order_relaxed))
+    {
+    }
+    auto currentLastTimestamp = lastTimestamp.load(std::memory_order_relaxed);
+    while (rawTimestamp > currentLastTimestamp
+           and not lastTimestamp.compare_exchange_weak(currentLastTimestamp, rawTimestamp, std::memory_order_relaxed))
+    {
+    }
+}
+
+SessionSliceStore::SessionSliceStore(const uint64_t gap)
+    : gap(gap), sequenceNumber(SequenceNumber::INITIAL), numberOfActiveInputPipelines(0)
+{
+    PRECONDITION(gap > 0, "The gap of a session window must be greater than zero");
+}
+
+SessionSliceStore::~SessionSliceStore()
+{
+    deleteState();
+}
+
+std::vector<std::shared_ptr<Slice>> SessionSliceStore::getSlicesOrCreate(
+    const Timestamp timestamp,
+    WorkerThreadId,
+    const std::function<std::vector<std::shared_ptr<Slice>>(SliceStart, SliceEnd)>& createNewSlice)
+{
+    const auto sliceStart = SliceStart(timestamp.getRawValue() - (timestamp.getRawValue() % gap));
+    const auto sliceEnd = SliceEnd(sliceStart.getRawValue() + gap);
+    {
+        const auto slicesReadLocked = slices.rlock();
+        if (const auto existingSlice = slicesReadLocked->find(sliceEnd); existingSlice != slicesReadLocked->end())
+        {
+            existingSlice->second.addRecordTimestamp(timestamp);
+            return {existingSlice->second.slice};
+        }
+    }
+
+    /// As in the DefaultTimeBasedSliceStore, we create the slice without holding the lock and check afterward, if another thread has
+    /// created the slice in the meantime.
+    const auto newSlices = createNewSlice(sliceStart, sliceEnd);
+    INVARIANT(newSlices.size() == 1, "We assume that only one slice is created per timestamp for our session slice store.");
+    const auto slicesWriteLocked = slices.wlock();
+    const auto [sessionSlice, inserted] = slicesWriteLocked->try_emplace(sliceEnd, newSlices[0], timestamp);
+    if (not inserted)
+    {
+        sessionSlice->second.addRecordTimestamp(timestamp);
+    }
+    return {sessionSlice->second.slice};
+}
+
+std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>>
+SessionSliceStore::emitSessions(std::map<SliceEnd, SessionSlice>& sessionSlices, const std::optional<Timestamp> globalWatermark)
+{
+    std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>> sessionsToSlices;
+    std::vector<SessionSlice*> currentSession;
+    Timestamp::Underlying currentSessionStart = 0;
+    Timestamp::Underlying currentSessionLastTimestamp = 0;
+    SliceEnd currentSessionLastSliceEnd{0};
+
+    auto emitCurrentSession = [&]
+    {
+        if (currentSession.empty())
+        {
+            return;
+        }
+        const auto sessionEnd = Timestamp(currentSessionLastTimestamp + gap);
+        /// Records with a timestamp smaller than the watermark can not arrive anymore. Thus, the session is complete, if the watermark has
+        /// passed its end. Additionally, no record with a timestamp larger than the watermark may be added to its slices.
+        if (globalWatermark.has_value() and (sessionEnd >= *globalWatermark or currentSessionLastSliceEnd >= *globalWatermark))
+        {
+            currentSession.clear();
+            return;
+        }
+
+        const auto newSequenceNumber = SequenceNumber(sequenceNumber++);
+        auto& slicesOfSession = sessionsToSlices[{WindowInfo(currentSessionStart, sessionEnd.getRawValue()), newSequenceNumber}];
+        for (auto* sessionSlice : currentSession)
+        {
+            slicesOfSession.emplace_back(sessionSlice->slice);
+            sessionSlice->emittedSessionEnd = sessionEnd;
+        }
+        NES_TRACE("Emitting session [{}, {}) with {} slices", currentSessionStart, sessionEnd, currentSession.size());
+        currentSession.clear();
+    };
+
+    /// The slices are sorted by their end (due to std::map) and do not overlap. Thus, we can merge the slices in a single pass.
+    for (auto& [sliceEnd, sessionSlice] : sessionSlices)
+    {
+        if (sessionSlice.emittedSessionEnd.has_value())
+        {
+            /// Records that arrive after their session has been emitted must not extend the emitted session
+            emitCurrentSession();
+            continue;
+        }
+
+        const auto firstTimestamp = sessionSlice.firstTimestamp.load(std::memory_order_relaxed);
+        const auto lastTimestamp = sessionSlice.lastTimestamp.load(std::memory_order_relaxed);
+        if (currentSession.empty() or firstTimestamp - currentSessionLastTimestamp >= gap)
+        {
+            emitCurrentSession();
+            currentSessionStart = firstTimestamp;
+        }
+        currentSession.emplace_back(&sessionSlice);
+        currentSessionLastTimestamp = lastTimestamp;
+        currentSessionLastSliceEnd = sliceEnd;
+    }
+    emitCurrentSession();
+    return sessionsToSlices;
+}
+
+std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>>
+SessionSliceStore::getTriggerableWindowSlices(const Timestamp globalWatermark)
+{
+    /// For performance reasons, we check if we can acquire a lock and if not we then simply skip checking if we can trigger anything
+    const auto slicesWriteLocked = slices.tryWLock();
+    if (slicesWriteLocked.isNull())
+    {
+        return {};
+    }
+    return emitSessions(*slicesWriteLocked, globalWatermark);
+}
+
+void SessionSliceStore::addIngestionTimestamps(const Timestamp, const IngestionTimestamps& ingestionTimestamps)
+{
+    /// A record may extend any session that has not been emitted yet, regardless of the watermark. As the store only keeps the slices of
+    /// pending and recently emitted sessions, we add the ingestion timestamps to all of them.
+    const auto slicesReadLocked = slices.rlock();
+    for (const auto& sessionSlice : *slicesReadLocked | std::views::values)
+    {
+        sessionSlice.slice->addIngestionTimestamps(ingestionTimestamps);
+    }
+}
+
+std::optional<std::shared_ptr<Slice>> SessionSliceStore::getSliceBySliceEnd(const SliceEnd sliceEnd)
+{
+    if (const auto slicesReadLocked = slices.rlock(); slicesReadLocked->contains(sliceEnd))
+    {
+        return slicesReadLocked->find(sliceEnd)->second.slice;
+    }
+    return {};
+}
+
+std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>> SessionSliceStore::getAllNonTriggeredSlices()
+{
+    const auto slicesWriteLocked = slices.wlock();
+
+    /// numberOfActiveInputPipelines is guarded by the slices lock.
+    /// If this method gets called, we know that an input pipeline has terminated.
+    INVARIANT(numberOfActiveInputPipelines > 0, "Method should not be called if all input pipelines have terminated.");
+    numberOfActiveInputPipelines -= 1;
+
+    /// If we are waiting on another pipeline to terminate, records may still be added to the current sessions
+    if (numberOfActiveInputPipelines > 0)
+    {
+        NES_TRACE("Waiting on termination of {} input pipelines before emitting all sessions", numberOfActiveInputPipelines);
+        return {};
+    }
+    return emitSessions(*slicesWriteLocked, std::nullopt);
+}
+
+std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>> SessionSliceStore::getFillingWindowSlices()
+{
+    return {};
+}
+
+FillingSlices SessionSliceStore::getSlicesOfFillingWindows()
+{
+    return {};
+}
+
+void SessionSliceStore::skipWindowsEndingBefore(Timestamp)
+{
+}
+
+std::optional<uint64_t> SessionSliceStore::getAllowedLateness() const
+{
+    return std::nullopt;
+}
+
+bool SessionSliceStore::isBeyondAllowedLateness(Timestamp) const
+{
+    return false;
+}
+
+void SessionSliceStore::markWindowsWithLateUpdates(const std::vector<std::shared_ptr<Slice>>&)
+{
+}
+
+void SessionSliceStore::garbageCollectSlicesAndWindows(const Timestamp newGlobalWaterMark)
+{
+    NES_TRACE("Performing garbage collection for new global watermark {}", newGlobalWaterMark);
+    std::vector<std::shared_ptr<Slice>> slicesToDelete;
+    if (const auto slicesWriteLocked = slices.tryWLock())
+    {
+        /// A slice can be deleted, if the probe has passed the end of the session it has been emitted with. As the probe sets the
+        /// watermark to the start of the processed sessions and the sessions do not overlap, the probe has finished all sessions that end
+        /// before or at the watermark.
+        std::erase_if(
+            *slicesWriteLocked,
+            [&](const auto& sliceEndAndSessionSlice)
+            {
+                const auto& [sliceEnd, sessionSlice] = sliceEndAndSessionSlice;
+                if (sessionSlice.emittedSessionEnd.has_value() and *sessionSlice.emittedSessionEnd <= newGlobalWaterMark)
+                {
+                    NES_TRACE("Deleting slice with sliceEnd {} as it is not used anymore", sliceEnd);
+                    /// As in the DefaultTimeBasedSliceStore, we call the time-consuming destructor of the slices without holding the lock
+                    slicesToDelete.emplace_back(sessionSlice.slice);
+                    return true;
+                }
+                return false;
+            });
+    }
+    slicesToDelete.clear();
+}
+
+void SessionSliceStore::deleteState()
+{
+    slices.wlock()->clear();
+}
+
+void SessionSliceStore::incrementNumberOfInputPipelines()
+{
+    numberOfActiveInputPipelines += 1;
+}
+
+void SessionSliceStore::setWorkerThreads(uint64_t)
+{
+}
+
+uint64_t SessionSliceStore::getWindowSize() const
+{
+    return gap;
+}
+
+uint64_t SessionSliceStore::getWindowSlide() const
+{
+    return gap;
+}
+}
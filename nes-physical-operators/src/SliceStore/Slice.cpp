@@ -14,17 +14,52 @@
 
 #include <SliceStore/Slice.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <Time/Timestamp.hpp>
+
 namespace NES
 {
 
+void IngestionTimestamps::merge(const IngestionTimestamps& other)
+{
+    if (other.min == Timestamp(Timestamp::INITIAL_VALUE))
+    {
+        return;
+    }
+    min = min == Timestamp(Timestamp::INITIAL_VALUE) ? other.min : std::min(min, other.min);
+    max = std::max(max, other.max);
+}
+
 Slice::Slice(const SliceStart sliceStart, const SliceEnd sliceEnd) : sliceStart(sliceStart), sliceEnd(sliceEnd)
 {
 }
 
-Slice::Slice(const Slice& other) = default;
-Slice::Slice(Slice&& other) noexcept = default;
-Slice& Slice::operator=(const Slice& other) = default;
-Slice& Slice::operator=(Slice&& other) noexcept = default;
+Slice::Slice(const Slice& other)
+    : sliceStart(other.sliceStart)
+    , sliceEnd(other.sliceEnd)
+    , minIngestionTimestamp(other.minIngestionTimestamp.load())
+    , maxIngestionTimestamp(other.maxIngestionTimestamp.load())
+{
+}
+
+Slice::Slice(Slice&& other) noexcept : Slice(static_cast<const Slice&>(other))
+{
+}
+
+Slice& Slice::operator=(const Slice& other)
+{
+    sliceStart = other.sliceStart;
+    sliceEnd = other.sliceEnd;
+    minIngestionTimestamp = other.minIngestionTimestamp.load();
+    maxIngestionTimestamp = other.maxIngestionTimestamp.load();
+    return *this;
+}
+
+Slice& Slice::operator=(Slice&& other) noexcept
+{
+    return *this = static_cast<const Slice&>(other);
+}
 
 SliceStart Slice::getSliceStart() const
 {
@@ -45,4 +80,33 @@ bool Slice::operator!=(const Slice& rhs) const
 {
     return !(rhs == *this);
 }
+
+void Slice::addIngestionTimestamps(const IngestionTimestamps& ingestionTimestamps)
+{
+    if (ingestionTimestamps.min == Timestamp(Timestamp::INITIAL_VALUE))
+    {
+        return;
+    }
+    /// The maximum is widened before the minimum. Thus, a reader that sees a valid minimum also sees a valid maximum.
+    const auto newMax = ingestionTimestamps.max.getRawValue();
+    auto currentMax = maxIngestionTimestamp.load();
+    while (newMax > currentMax and not maxIngestionTimestamp.compare_exchange_weak(currentMax, newMax))
+    {
+    }
+    const auto newMin = ingestionTimestamps.min.getRawValue();
+    auto currentMin = minIngestionTimestamp.load();
+    while (newMin < currentMin and not minIngestionTimestamp.compare_exchange_weak(currentMin, newMin))
+    {
+    }
+}
+
+IngestionTimestamps Slice::getIngestionTimestamps() const
+{
+    const auto min = minIngestionTimestamp.load();
+    if (min == Timestamp::INVALID_VALUE)
+    {
+        return {};
+    }
+    return {.min = Timestamp(min), .max = Timestamp(maxIngestionTimestamp.load())};
+}
 }
@@ -16,6 +16,7 @@
 
 #include <cstddef>
 #include <optional>
+#include <ranges>
 #include <string>
 #include <utility>
 #include <vector>
@@ -32,13 +33,16 @@ void UnionRenamePhysicalOperator::execute(ExecutionContext& ctx, Record& record)
     Record outputRecord;
     for (nautilus::static_val<size_t> i = 0; i < inputFields.size(); ++i)
     {
-        outputRecord.write(outputFields[i], record.read(inputFields[i]));
+        outputRecord.write(outputSlots[i], record.read(inputSlots[i]));
     }
     executeChild(ctx, outputRecord);
 }
 
 UnionRenamePhysicalOperator::UnionRenamePhysicalOperator(std::vector<std::string> inputFields, std::vector<std::string> outputFields)
-    : inputFields(std::move(inputFields)), outputFields(std::move(outputFields))
+    : inputFields(std::move(inputFields))
+    , outputFields(std::move(outputFields))
+    , inputSlots(this->inputFields | std::views::transform(Record::resolveSlot) | std::ranges::to<std::vector>())
+    , outputSlots(this->outputFields | std::views::transform(Record::resolveSlot) | std::ranges::to<std::vector>())
 {
     PRECONDITION(this->inputFields.size() == this->outputFields.size(), "Input and output fields must have the same size");
 }
@@ -13,33 +13,97 @@
 */
 #include <Watermark/EventTimeWatermarkAssignerPhysicalOperator.hpp>
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <utility>
+#include <Identifiers/Identifiers.hpp>
 #include <Nautilus/Interface/Record.hpp>
 #include <Nautilus/Interface/RecordBuffer.hpp>
 #include <Nautilus/Interface/TimestampRef.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
 #include <Time/Timestamp.hpp>
+#include <Watermark/OutOfOrdernessOperatorHandler.hpp>
 #include <Watermark/TimeFunction.hpp>
+#include <ErrorHandling.hpp>
 #include <ExecutionContext.hpp>
+#include <OperatorState.hpp>
 #include <PhysicalOperator.hpp>
+#include <function.hpp>
+#include <val.hpp>
 
 namespace NES
 {
 
-EventTimeWatermarkAssignerPhysicalOperator::EventTimeWatermarkAssignerPhysicalOperator(EventTimeFunction timeFunction)
-    : timeFunction(std::move(timeFunction)) { };
+namespace
+{
+/// Tracks the disorder of the records of a buffer for the adaptive out-of-orderness bound
+class AdaptiveOutOfOrdernessState : public OperatorState
+{
+public:
+    AdaptiveOutOfOrdernessState() : minTimestamp(Timestamp(Timestamp::INVALID_VALUE)), disorder(0) { }
+
+    nautilus::val<Timestamp> minTimestamp;
+    nautilus::val<uint64_t> disorder;
+};
+
+uint64_t updateOutOfOrdernessBoundProxy(
+    OperatorHandler* ptrOpHandler,
+    const OriginId originId,
+    const Timestamp minTimestamp,
+    const Timestamp maxTimestamp,
+    const uint64_t disorder)
+{
+    PRECONDITION(ptrOpHandler != nullptr, "opHandler context should not be null!");
+    auto* opHandler = dynamic_cast<OutOfOrdernessOperatorHandler*>(ptrOpHandler);
+    PRECONDITION(opHandler != nullptr, "The adaptive out-of-orderness bound requires an OutOfOrdernessOperatorHandler");
+    return opHandler->updateBound(originId, minTimestamp, maxTimestamp, disorder);
+}
+}
+
+EventTimeWatermarkAssignerPhysicalOperator::EventTimeWatermarkAssignerPhysicalOperator(
+    EventTimeFunction timeFunction,
+    const uint64_t outOfOrdernessBoundInMs,
+    const std::optional<OperatorHandlerId> adaptiveOutOfOrdernessHandlerId)
+    : timeFunction(std::move(timeFunction))
+    , outOfOrdernessBoundInMs(outOfOrdernessBoundInMs)
+    , adaptiveOutOfOrdernessHandlerId(adaptiveOutOfOrdernessHandlerId) { };
 
 void EventTimeWatermarkAssignerPhysicalOperator::open(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const
 {
     openChild(executionCtx, recordBuffer);
     executionCtx.watermarkTs = nautilus::val<Timestamp>(Timestamp(Timestamp::INITIAL_VALUE));
+    /// The heartbeat of an idle source has no records, thus it forwards the watermark of the heartbeat
+    if (const auto idleSourceWatermark = nautilus::val<Timestamp>(Timestamp(Timestamp::IDLE_SOURCE_VALUE));
+        recordBuffer.getWatermarkTs() == idleSourceWatermark)
+    {
+        executionCtx.watermarkTs = idleSourceWatermark;
+    }
     timeFunction.open(executionCtx, recordBuffer);
+    if (adaptiveOutOfOrdernessHandlerId.has_value())
+    {
+        executionCtx.setLocalOperatorState(id, std::make_unique<AdaptiveOutOfOrdernessState>());
+    }
 }
 
 void EventTimeWatermarkAssignerPhysicalOperator::execute(ExecutionContext& ctx, Record& record) const
 {
     const auto tsField = timeFunction.getTs(ctx, record);
+    if (adaptiveOutOfOrdernessHandlerId.has_value())
+    {
+        auto* const state = dynamic_cast<AdaptiveOutOfOrdernessState*>(ctx.getLocalState(id));
+        if (tsField < ctx.watermarkTs)
+        {
+            if (const auto disorder = ctx.watermarkTs.convertToValue() - tsField.convertToValue(); disorder > state->disorder)
+            {
+                state->disorder = disorder;
+            }
+        }
+        if (tsField < state->minTimestamp)
+        {
+            state->minTimestamp = tsField;
+        }
+    }
     if (tsField > ctx.watermarkTs)
     {
         ctx.watermarkTs = tsField;
@@ -50,6 +114,33 @@ void EventTimeWatermarkAssignerPhysicalOperator::execute(ExecutionContext& ctx,
 
 void EventTimeWatermarkAssignerPhysicalOperator::close(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const
 {
+    if (outOfOrdernessBoundInMs > 0)
+    {
+        /// Without records (and for heartbeats of idle sources), the watermark does not carry a timestamp that the bound applies to
+        const auto initialWatermark = nautilus::val<Timestamp>(Timestamp(Timestamp::INITIAL_VALUE));
+        const auto idleSourceWatermark = nautilus::val<Timestamp>(Timestamp(Timestamp::IDLE_SOURCE_VALUE));
+        if (executionCtx.watermarkTs > initialWatermark and executionCtx.watermarkTs < idleSourceWatermark)
+        {
+            const auto maxTimestamp = executionCtx.watermarkTs.convertToValue();
+            nautilus::val<uint64_t> bound(outOfOrdernessBoundInMs);
+            if (adaptiveOutOfOrdernessHandlerId.has_value())
+            {
+                const auto* const state = dynamic_cast<AdaptiveOutOfOrdernessState*>(executionCtx.getLocalState(id));
+                bound = nautilus::invoke(
+                    updateOutOfOrdernessBoundProxy,
+                    executionCtx.getGlobalOperatorHandler(adaptiveOutOfOrdernessHandlerId.value()),
+                    executionCtx.originId,
+                    state->minTimestamp,
+                    executionCtx.watermarkTs,
+                    state->disorder);
+            }
+            executionCtx.watermarkTs = initialWatermark;
+            if (maxTimestamp > bound)
+            {
+                executionCtx.watermarkTs = nautilus::val<Timestamp>(maxTimestamp - bound);
+            }
+        }
+    }
     PhysicalOperatorConcept::close(executionCtx, recordBuffer);
 }
 
@@ -37,7 +37,9 @@ void IngestionTimeWatermarkAssignerPhysicalOperator::open(ExecutionContext& exec
         auto emptyRecord = Record();
         return timeFunction.getTs(executionCtx, emptyRecord);
     }(executionCtx);
-    if (const auto currentWatermark = executionCtx.watermarkTs; tsField > currentWatermark)
+    /// The ingestion time of the heartbeat of an idle source advances the watermark just like a buffer with records
+    if (const auto currentWatermark = executionCtx.watermarkTs;
+        tsField > currentWatermark or currentWatermark == nautilus::val<Timestamp>(Timestamp(Timestamp::IDLE_SOURCE_VALUE)))
     {
         executionCtx.watermarkTs = tsField;
     }
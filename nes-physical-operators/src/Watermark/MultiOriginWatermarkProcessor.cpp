@@ -12,11 +12,14 @@
     limitations under the License.
 */
 #include <algorithm>
+#include <atomic>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 #include <Identifiers/Identifiers.hpp>
 #include <Sequencing/NonBlockingMonotonicSeqQueue.hpp>
@@ -29,12 +32,53 @@
 namespace NES
 {
 
-MultiOriginWatermarkProcessor::MultiOriginWatermarkProcessor(const std::vector<OriginId>& origins) : origins(origins)
+MultiOriginWatermarkProcessor::MultiOriginWatermarkProcessor(const std::vector<OriginId>& origins)
+    : origins(origins)
+    , numberOfLeaves(std::bit_ceil(std::max<size_t>(origins.size(), 1)))
+    , tournamentTree(std::make_unique<std::atomic<uint64_t>[]>(2 * numberOfLeaves))
 {
     for (const auto& _ : origins)
     {
         watermarkProcessors.emplace_back(std::make_shared<Sequencing::NonBlockingMonotonicSeqQueue<uint64_t>>());
     }
+
+    for (size_t originIndex = 0; originIndex < origins.size(); ++originIndex)
+    {
+        sortedOrigins.emplace_back(origins[originIndex], originIndex);
+    }
+    std::ranges::sort(sortedOrigins);
+    PRECONDITION(
+        std::ranges::adjacent_find(sortedOrigins, {}, &std::pair<OriginId, size_t>::first) == sortedOrigins.end(),
+        "origins must be unique, ids={}",
+        fmt::join(origins, ","));
+    if (not sortedOrigins.empty())
+    {
+        smallestOrigin = sortedOrigins.front().first.getRawValue();
+        const auto rangeOfOrigins = sortedOrigins.back().first.getRawValue() - smallestOrigin + 1;
+        if (rangeOfOrigins <= MAX_TABLE_SIZE_PER_ORIGIN * origins.size())
+        {
+            originIndexTable.resize(rangeOfOrigins, NO_ORIGIN_INDEX);
+            for (const auto& [origin, originIndex] : sortedOrigins)
+            {
+                originIndexTable[origin.getRawValue() - smallestOrigin] = static_cast<uint32_t>(originIndex);
+            }
+            sortedOrigins.clear();
+        }
+    }
+
+    /// The queues start with a watermark of zero, so does every subtree that contains an origin
+    for (size_t node = 1; node < 2 * numberOfLeaves; ++node)
+    {
+        tournamentTree[node].store(0);
+    }
+    for (size_t leaf = numberOfLeaves + origins.size(); leaf < 2 * numberOfLeaves; ++leaf)
+    {
+        tournamentTree[leaf].store(UINT64_MAX);
+    }
+    for (size_t node = numberOfLeaves - 1; node >= 1; --node)
+    {
+        tournamentTree[node].store(std::min(tournamentTree[2 * node].load(), tournamentTree[(2 * node) + 1].load()));
+    }
 };
 
 std::shared_ptr<MultiOriginWatermarkProcessor> MultiOriginWatermarkProcessor::create(const std::vector<OriginId>& origins)
@@ -42,23 +86,77 @@ std::shared_ptr<MultiOriginWatermarkProcessor> MultiOriginWatermarkProcessor::cr
     return std::make_shared<MultiOriginWatermarkProcessor>(origins);
 }
 
-Timestamp MultiOriginWatermarkProcessor::updateWatermark(Timestamp ts, SequenceData sequenceData, OriginId origin) const
+size_t MultiOriginWatermarkProcessor::getOriginIndex(const OriginId origin) const
 {
-    bool found = false;
-    for (size_t originIndex = 0; originIndex < origins.size(); ++originIndex)
+    size_t originIndex = NO_ORIGIN_INDEX;
+    if (not originIndexTable.empty())
     {
-        if (origins[originIndex] == origin)
+        if (origin.getRawValue() >= smallestOrigin and origin.getRawValue() - smallestOrigin < originIndexTable.size())
         {
-            watermarkProcessors[originIndex]->emplace(sequenceData, ts.getRawValue());
-            found = true;
+            originIndex = originIndexTable[origin.getRawValue() - smallestOrigin];
         }
     }
+    else if (const auto it = std::ranges::lower_bound(sortedOrigins, origin, {}, &std::pair<OriginId, size_t>::first);
+             it != sortedOrigins.end() and it->first == origin)
+    {
+        originIndex = it->second;
+    }
     INVARIANT(
-        found,
+        originIndex != NO_ORIGIN_INDEX,
         "update watermark for non existing origin={} number of origins size={} ids={}",
         origin,
         origins.size(),
         fmt::join(origins, ","));
+    return originIndex;
+}
+
+void MultiOriginWatermarkProcessor::raiseWatermark(const size_t originIndex, const uint64_t watermark) const
+{
+    auto node = numberOfLeaves + originIndex;
+    auto minimum = watermark;
+    while (true)
+    {
+        auto current = tournamentTree[node].load();
+        while (current < minimum and not tournamentTree[node].compare_exchange_weak(current, minimum))
+        {
+        }
+        /// Another thread already raised the node (at least) to the minimum and recomputes its parent afterward
+        if (current >= minimum or node == 1)
+        {
+            return;
+        }
+        node /= 2;
+        minimum = std::min(tournamentTree[2 * node].load(), tournamentTree[(2 * node) + 1].load());
+    }
+}
+
+uint64_t MultiOriginWatermarkProcessor::getWatermarkOfOtherOrigins(const size_t originIndex) const
+{
+    auto minimum = UINT64_MAX;
+    for (auto node = numberOfLeaves + originIndex; node > 1; node /= 2)
+    {
+        minimum = std::min(minimum, tournamentTree[node ^ 1].load());
+    }
+    return minimum;
+}
+
+Timestamp MultiOriginWatermarkProcessor::updateWatermark(Timestamp ts, SequenceData sequenceData, OriginId origin) const
+{
+    const auto originIndex = getOriginIndex(origin);
+    const auto& watermarkProcessor = watermarkProcessors[originIndex];
+    auto watermark = ts.getRawValue();
+    if (watermark == Timestamp::IDLE_SOURCE_VALUE)
+    {
+        /// An idle origin follows the other origins, so that it does not hold back their minimum. Without other origins, it keeps its own
+        const auto watermarkOfOtherOrigins = getWatermarkOfOtherOrigins(originIndex);
+        watermark = watermarkProcessor->getCurrentValue();
+        if (watermarkOfOtherOrigins != UINT64_MAX)
+        {
+            watermark = std::max(watermark, watermarkOfOtherOrigins);
+        }
+    }
+    watermarkProcessor->emplace(sequenceData, watermark);
+    raiseWatermark(originIndex, watermarkProcessor->getCurrentValue());
     return getCurrentWatermark();
 }
 
@@ -74,12 +172,7 @@ std::string MultiOriginWatermarkProcessor::getCurrentStatus()
 
 Timestamp MultiOriginWatermarkProcessor::getCurrentWatermark() const
 {
-    auto minimalWatermark = UINT64_MAX;
-    for (const auto& wt : watermarkProcessors)
-    {
-        minimalWatermark = std::min(minimalWatermark, wt->getCurrentValue());
-    }
-    return Timestamp(minimalWatermark);
+    return Timestamp(tournamentTree[1].load());
 }
 
 }
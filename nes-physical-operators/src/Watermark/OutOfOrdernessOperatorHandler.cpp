@@ -0,0 +1,59 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Watermark/OutOfOrdernessOperatorHandler.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <Identifiers/Identifiers.hpp>
+#include <Runtime/QueryTerminationType.hpp>
+#include <Time/Timestamp.hpp>
+#include <PipelineExecutionContext.hpp>
+
+namespace NES
+{
+
+OutOfOrdernessOperatorHandler::OutOfOrdernessOperatorHandler(const uint64_t maxBoundInMs) : maxBoundInMs(maxBoundInMs)
+{
+}
+
+void OutOfOrdernessOperatorHandler::start(PipelineExecutionContext&, uint32_t)
+{
+}
+
+void OutOfOrdernessOperatorHandler::stop(QueryTerminationType, PipelineExecutionContext&)
+{
+}
+
+uint64_t OutOfOrdernessOperatorHandler::updateBound(
+    const OriginId originId, const Timestamp minTimestamp, const Timestamp maxTimestamp, const uint64_t disorderOfBuffer)
+{
+    const auto lockedOrigins = origins.wlock();
+    auto& origin = lockedOrigins->try_emplace(originId, OriginState{.boundInMs = maxBoundInMs}).first->second;
+    const auto disorderToPrecedingBuffers
+        = origin.maxTimestamp > minTimestamp ? (origin.maxTimestamp - minTimestamp).getRawValue() : uint64_t{0};
+    const auto disorder = std::min(std::max(disorderOfBuffer, disorderToPrecedingBuffers), maxBoundInMs);
+    origin.maxTimestamp = std::max(origin.maxTimestamp, maxTimestamp);
+    if (disorder >= origin.boundInMs)
+    {
+        origin.boundInMs = disorder;
+    }
+    else
+    {
+        origin.boundInMs -= (origin.boundInMs - disorder + DECAY - 1) / DECAY;
+    }
+    return origin.boundInMs;
+}
+
+}
@@ -18,11 +18,17 @@
 #include <utility>
 #include <DataTypes/TimeUnit.hpp>
 #include <Functions/PhysicalFunction.hpp>
+#include <Identifiers/Identifiers.hpp>
 #include <Nautilus/Interface/Record.hpp>
 #include <Nautilus/Interface/RecordBuffer.hpp>
 #include <Nautilus/Interface/TimestampRef.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
 #include <Time/Timestamp.hpp>
+#include <Watermark/TuplePositionTracker.hpp>
+#include <ErrorHandling.hpp>
 #include <ExecutionContext.hpp>
+#include <WindowBasedOperatorHandler.hpp>
+#include <function.hpp>
 #include <val.hpp>
 
 namespace NES
@@ -33,6 +39,11 @@ void EventTimeFunction::open(ExecutionContext&, RecordBuffer&) const
     /// nop
 }
 
+void EventTimeFunction::close(ExecutionContext&, RecordBuffer&) const
+{
+    /// nop
+}
+
 EventTimeFunction::EventTimeFunction(PhysicalFunction timestampFunction, const Windowing::TimeUnit& unit)
     : unit(unit), timestampFunction(std::move(timestampFunction))
 {
@@ -57,4 +68,59 @@ nautilus::val<Timestamp> IngestionTimeFunction::getTs(ExecutionContext& ctx, Rec
     return ctx.currentTs;
 }
 
+void IngestionTimeFunction::close(ExecutionContext&, RecordBuffer&) const
+{
+    /// nop
+}
+
+namespace
+{
+TuplePositionTracker& getTuplePositionTracker(OperatorHandler* ptrOpHandler)
+{
+    PRECONDITION(ptrOpHandler != nullptr, "opHandler context should not be null!");
+    auto* opHandler = dynamic_cast<WindowBasedOperatorHandler*>(ptrOpHandler);
+    PRECONDITION(opHandler != nullptr, "Count-based windows require a window based operator handler");
+    return opHandler->getTuplePositionTracker();
+}
+
+uint64_t beginBufferProxy(OperatorHandler* ptrOpHandler)
+{
+    return getTuplePositionTracker(ptrOpHandler).beginBuffer();
+}
+
+uint64_t getNextPositionProxy(OperatorHandler* ptrOpHandler)
+{
+    return getTuplePositionTracker(ptrOpHandler).getNextPosition();
+}
+
+uint64_t finishBufferProxy(OperatorHandler* ptrOpHandler, const Timestamp lowerBound)
+{
+    return getTuplePositionTracker(ptrOpHandler).finishBuffer(lowerBound.getRawValue()).getRawValue();
+}
+}
+
+CountTimeFunction::CountTimeFunction(const OperatorHandlerId operatorHandlerId) : operatorHandlerId(operatorHandlerId)
+{
+}
+
+void CountTimeFunction::open(ExecutionContext& ctx, RecordBuffer&) const
+{
+    /// Until close() replaces it with the watermark over the positions, the watermark holds the lower bound of the positions of this buffer
+    const auto operatorHandler = ctx.getGlobalOperatorHandler(operatorHandlerId);
+    ctx.watermarkTs = nautilus::val<Timestamp>(invoke(beginBufferProxy, operatorHandler));
+}
+
+nautilus::val<Timestamp> CountTimeFunction::getTs(ExecutionContext& ctx, Record&) const
+{
+    const auto operatorHandler = ctx.getGlobalOperatorHandler(operatorHandlerId);
+    ctx.currentTs = nautilus::val<Timestamp>(invoke(getNextPositionProxy, operatorHandler));
+    return ctx.currentTs;
+}
+
+void CountTimeFunction::close(ExecutionContext& ctx, RecordBuffer&) const
+{
+    const auto operatorHandler = ctx.getGlobalOperatorHandler(operatorHandlerId);
+    ctx.watermarkTs = nautilus::val<Timestamp>(invoke(finishBufferProxy, operatorHandler, ctx.watermarkTs));
+}
+
 }
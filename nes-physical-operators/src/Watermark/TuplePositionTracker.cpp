@@ -0,0 +1,54 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Watermark/TuplePositionTracker.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <Time/Timestamp.hpp>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+uint64_t TuplePositionTracker::beginBuffer()
+{
+    /// Loading the next position while holding the lock guarantees that a concurrent finishBuffer() either sees the lower bound of this
+    /// buffer or returns a watermark that is not larger than the lower bound.
+    const std::scoped_lock lock(mutex);
+    const auto lowerBound = nextPosition.load();
+    lowerBoundsOfActiveBuffers.insert(lowerBound);
+    return lowerBound;
+}
+
+uint64_t TuplePositionTracker::getNextPosition()
+{
+    return nextPosition.fetch_add(1, std::memory_order_relaxed);
+}
+
+Timestamp TuplePositionTracker::finishBuffer(const uint64_t lowerBound)
+{
+    const std::scoped_lock lock(mutex);
+    const auto activeBuffer = lowerBoundsOfActiveBuffers.find(lowerBound);
+    INVARIANT(activeBuffer != lowerBoundsOfActiveBuffers.end(), "No active buffer with the lower bound {} has been registered", lowerBound);
+    lowerBoundsOfActiveBuffers.erase(activeBuffer);
+    if (lowerBoundsOfActiveBuffers.empty())
+    {
+        return Timestamp(nextPosition.load());
+    }
+    return Timestamp(*lowerBoundsOfActiveBuffers.begin());
+}
+
+}
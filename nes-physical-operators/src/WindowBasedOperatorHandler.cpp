@@ -14,16 +14,21 @@
 
 #include <WindowBasedOperatorHandler.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <utility>
 #include <vector>
 #include <Identifiers/Identifiers.hpp>
 #include <Join/StreamJoinUtil.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
 #include <Runtime/QueryTerminationType.hpp>
+#include <SliceStore/Slice.hpp>
 #include <SliceStore/WindowSlicesStoreInterface.hpp>
+#include <Time/Timestamp.hpp>
 #include <Util/Logger/Logger.hpp>
 #include <Watermark/MultiOriginWatermarkProcessor.hpp>
+#include <Watermark/TuplePositionTracker.hpp>
 #include <PipelineExecutionContext.hpp>
 
 namespace NES
@@ -48,6 +53,7 @@ void WindowBasedOperatorHandler::setWorkerThreads(const uint64_t numberOfWorkerT
 void WindowBasedOperatorHandler::start(PipelineExecutionContext& pipelineExecutionContext, uint32_t)
 {
     numberOfWorkerThreads = pipelineExecutionContext.getNumberOfWorkerThreads();
+    sliceAndWindowStore->setWorkerThreads(numberOfWorkerThreads);
     watermarkProcessorBuild = std::make_unique<MultiOriginWatermarkProcessor>(inputOrigins);
     watermarkProcessorProbe = std::make_unique<MultiOriginWatermarkProcessor>(std::vector{outputOriginId});
 }
@@ -61,6 +67,26 @@ WindowSlicesStoreInterface& WindowBasedOperatorHandler::getSliceAndWindowStore()
     return *sliceAndWindowStore;
 }
 
+TuplePositionTracker& WindowBasedOperatorHandler::getTuplePositionTracker()
+{
+    return tuplePositionTracker;
+}
+
+void WindowBasedOperatorHandler::setCountBasedWindows()
+{
+    countBasedWindows = true;
+}
+
+void WindowBasedOperatorHandler::setStateBufferProvider(std::shared_ptr<AbstractBufferProvider> stateBufferProvider)
+{
+    this->stateBufferProvider = std::move(stateBufferProvider);
+}
+
+AbstractBufferProvider* WindowBasedOperatorHandler::getStateBufferProvider() const
+{
+    return stateBufferProvider.get();
+}
+
 void WindowBasedOperatorHandler::garbageCollectSlicesAndWindows(const BufferMetaData& bufferMetaData) const
 {
     const auto newGlobalWaterMarkProbe
@@ -77,10 +103,23 @@ void WindowBasedOperatorHandler::garbageCollectSlicesAndWindows(const BufferMeta
 
 void WindowBasedOperatorHandler::checkAndTriggerWindows(const BufferMetaData& bufferMetaData, PipelineExecutionContext* pipelineCtx)
 {
+    /// The slices that the buffer wrote to must know its ingestion timestamps, before the new watermark may trigger them
+    if (bufferMetaData.ingestionTimestamps.min != Timestamp(Timestamp::INITIAL_VALUE))
+    {
+        sliceAndWindowStore->addIngestionTimestamps(watermarkProcessorBuild->getCurrentWatermark(), bufferMetaData.ingestionTimestamps);
+    }
+
     /// The watermark processor handles the minimal watermark across both streams
-    const auto newGlobalWatermark
+    auto newGlobalWatermark
         = watermarkProcessorBuild->updateWatermark(bufferMetaData.watermarkTs, bufferMetaData.seqNumber, bufferMetaData.originId);
 
+    /// The watermark of a buffer of count-based windows is the watermark over the positions of all origins. Thus, the minimum across the
+    /// origins would only wait for the origins that stopped sending buffers.
+    if (countBasedWindows)
+    {
+        newGlobalWatermark = std::max(newGlobalWatermark, bufferMetaData.watermarkTs);
+    }
+
     NES_TRACE(
         "New global watermark: {} for origin: {} and sequence data: {} and watermarkTs of buffer {}",
         newGlobalWatermark,
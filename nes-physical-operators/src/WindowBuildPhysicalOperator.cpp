@@ -19,6 +19,7 @@
 #include <Identifiers/Identifiers.hpp>
 #include <Join/StreamJoinUtil.hpp>
 #include <Nautilus/Interface/RecordBuffer.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
 #include <Runtime/Execution/OperatorHandler.hpp>
 #include <Time/Timestamp.hpp>
 #include <Watermark/TimeFunction.hpp>
@@ -40,13 +41,16 @@ void checkWindowsTriggerProxy(
     const SequenceNumber sequenceNumber,
     const ChunkNumber chunkNumber,
     const bool lastChunk,
-    const OriginId originId)
+    const OriginId originId,
+    const Timestamp minIngestionTs,
+    const Timestamp maxIngestionTs)
 {
     PRECONDITION(ptrOpHandler != nullptr, "opHandler context should not be null!");
     PRECONDITION(pipelineCtx != nullptr, "pipeline context should not be null");
 
     auto* opHandler = dynamic_cast<WindowBasedOperatorHandler*>(ptrOpHandler);
-    const BufferMetaData bufferMetaData(watermarkTs, SequenceData(sequenceNumber, chunkNumber, lastChunk), originId);
+    BufferMetaData bufferMetaData(watermarkTs, SequenceData(sequenceNumber, chunkNumber, lastChunk), originId);
+    bufferMetaData.ingestionTimestamps = {.min = minIngestionTs, .max = maxIngestionTs};
     opHandler->checkAndTriggerWindows(bufferMetaData, pipelineCtx);
 }
 
@@ -67,13 +71,24 @@ void registerActivePipeline(OperatorHandler* ptrOpHandler)
     opHandler->getSliceAndWindowStore().incrementNumberOfInputPipelines();
 }
 
+/// Returns the buffer provider that allocates the state of the slices
+AbstractBufferProvider* getStateBufferProviderProxy(OperatorHandler* ptrOpHandler, AbstractBufferProvider* pipelineBufferProvider)
+{
+    PRECONDITION(ptrOpHandler != nullptr, "opHandler context should not be null!");
+    const auto* opHandler = dynamic_cast<WindowBasedOperatorHandler*>(ptrOpHandler);
+    auto* stateBufferProvider = opHandler->getStateBufferProvider();
+    return stateBufferProvider != nullptr ? stateBufferProvider : pipelineBufferProvider->getStateBufferProvider();
+}
+
 WindowBuildPhysicalOperator::WindowBuildPhysicalOperator(OperatorHandlerId operatorHandlerId, std::unique_ptr<TimeFunction> timeFunction)
     : operatorHandlerId(operatorHandlerId), timeFunction(std::move(timeFunction))
 {
 }
 
-void WindowBuildPhysicalOperator::close(ExecutionContext& executionCtx, RecordBuffer&) const
+void WindowBuildPhysicalOperator::close(ExecutionContext& executionCtx, RecordBuffer& recordBuffer) const
 {
+    timeFunction->close(executionCtx, recordBuffer);
+
     /// Update the watermark for the nlj operator and trigger slices
     auto operatorHandlerMemRef = executionCtx.getGlobalOperatorHandler(operatorHandlerId);
     invoke(
@@ -84,7 +99,9 @@ void WindowBuildPhysicalOperator::close(ExecutionContext& executionCtx, RecordBu
         executionCtx.sequenceNumber,
         executionCtx.chunkNumber,
         executionCtx.lastChunk,
-        executionCtx.originId);
+        executionCtx.originId,
+        executionCtx.minIngestionTs,
+        executionCtx.maxIngestionTs);
 }
 
 void WindowBuildPhysicalOperator::setup(ExecutionContext& executionCtx, CompilationContext&) const
@@ -100,7 +117,17 @@ void WindowBuildPhysicalOperator::open(ExecutionContext& executionCtx, RecordBuf
 
     /// Creating the local state for the window operator build.
     const auto operatorHandler = executionCtx.getGlobalOperatorHandler(operatorHandlerId);
-    executionCtx.setLocalOperatorState(id, std::make_unique<WindowOperatorBuildLocalState>(operatorHandler));
+
+    /// The build is the last operator of its pipeline. Thus, all allocations via the buffer provider from now on belong to the slices.
+    executionCtx.pipelineMemoryProvider.bufferProvider
+        = invoke(getStateBufferProviderProxy, operatorHandler, executionCtx.pipelineMemoryProvider.bufferProvider);
+    executionCtx.setLocalOperatorState(id, createLocalState(operatorHandler));
+}
+
+std::unique_ptr<WindowOperatorBuildLocalState>
+WindowBuildPhysicalOperator::createLocalState(const nautilus::val<OperatorHandler*>& operatorHandler) const
+{
+    return std::make_unique<WindowOperatorBuildLocalState>(operatorHandler);
 }
 
 void WindowBuildPhysicalOperator::terminate(ExecutionContext& executionCtx) const
@@ -0,0 +1,83 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstdint>
+#include <set>
+#include <vector>
+#include <Aggregation/AggregationSlice.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <HashMapSlice.hpp>
+#include <HashMapSliceTestUtil.hpp>
+
+namespace NES
+{
+
+class AggregationSliceTest : public Testing::HashMapSliceTest
+{
+public:
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("AggregationSliceTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup AggregationSliceTest test class.");
+    }
+
+    static CreateNewHashMapSliceArgs createArgs() { return Testing::createHashMapSliceArgs(); }
+};
+
+TEST_F(AggregationSliceTest, OneHashMapPerWorkerThreadAndPartition)
+{
+    AggregationSlice slice{SliceStart(0), SliceEnd(10), createArgs(), NUMBER_OF_WORKER_THREADS, NUMBER_OF_PARTITIONS};
+    EXPECT_EQ(slice.getNumberOfPartitions(), NUMBER_OF_PARTITIONS);
+    EXPECT_EQ(slice.getNumberOfHashMaps(), NUMBER_OF_WORKER_THREADS * NUMBER_OF_PARTITIONS);
+
+    std::set<HashMap*> allHashMaps;
+    for (uint64_t workerThread = 0; workerThread < NUMBER_OF_WORKER_THREADS; ++workerThread)
+    {
+        for (uint64_t partition = 0; partition < NUMBER_OF_PARTITIONS; ++partition)
+        {
+            auto* hashMap = slice.getHashMapPtrOrCreate(WorkerThreadId(workerThread), partition);
+            ASSERT_NE(hashMap, nullptr);
+            EXPECT_EQ(slice.getHashMapPtr(WorkerThreadId(workerThread), partition), hashMap);
+            allHashMaps.emplace(hashMap);
+        }
+    }
+    EXPECT_EQ(allHashMaps.size(), NUMBER_OF_WORKER_THREADS * NUMBER_OF_PARTITIONS);
+}
+
+TEST_F(AggregationSliceTest, HashMapsOfPartition)
+{
+    AggregationSlice slice{SliceStart(0), SliceEnd(10), createArgs(), NUMBER_OF_WORKER_THREADS, NUMBER_OF_PARTITIONS};
+    auto* firstWorkerHashMap = slice.getHashMapPtrOrCreate(WorkerThreadId(0), 3);
+    auto* lastWorkerHashMap = slice.getHashMapPtrOrCreate(WorkerThreadId(NUMBER_OF_WORKER_THREADS - 1), 3);
+
+    EXPECT_EQ(slice.getHashMapPtrsOfPartition(3), (std::vector<HashMap*>{firstWorkerHashMap, nullptr, lastWorkerHashMap}));
+    EXPECT_EQ(slice.getHashMapPtrsOfPartition(0), (std::vector<HashMap*>(NUMBER_OF_WORKER_THREADS, nullptr)));
+}
+
+/// Without partitioning, a slice has one hash map per worker thread
+TEST_F(AggregationSliceTest, SinglePartition)
+{
+    AggregationSlice slice{SliceStart(0), SliceEnd(10), createArgs(), NUMBER_OF_WORKER_THREADS};
+    EXPECT_EQ(slice.getNumberOfPartitions(), 1);
+    EXPECT_EQ(slice.getNumberOfHashMaps(), NUMBER_OF_WORKER_THREADS);
+    auto* hashMap = slice.getHashMapPtrOrCreate(WorkerThreadId(NUMBER_OF_WORKER_THREADS + 1));
+    EXPECT_EQ(slice.getHashMapPtr(WorkerThreadId(1)), hashMap);
+}
+
+}
@@ -0,0 +1,254 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+#include <Aggregation/AggregationSlice.hpp>
+#include <Aggregation/AggregationStateCheckpoint.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMap.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Runtime/BufferManager.hpp>
+#include <SliceStore/Slice.hpp>
+#include <Time/Timestamp.hpp>
+#include <Util/HashMapType.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+#include <Engine.hpp>
+#include <HashMapSlice.hpp>
+#include <options.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+/// The entries of the test store their hash as the key and ten times their hash as the value
+class AggregationStateCheckpointTest : public Testing::BaseUnitTest
+{
+public:
+    static constexpr uint64_t NUMBER_OF_WORKER_THREADS = 2;
+    static constexpr uint64_t NUMBER_OF_PARTITIONS = 2;
+    static constexpr uint64_t KEY_SIZE = 8;
+    static constexpr uint64_t VALUE_SIZE = 8;
+    static constexpr uint64_t PAGE_SIZE = 1024;
+    static constexpr AggregationStateCheckpoint::Layout LAYOUT{
+        .entrySize = sizeof(ChainedHashMapEntry) + KEY_SIZE + VALUE_SIZE, .numberOfPartitions = NUMBER_OF_PARTITIONS};
+
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("AggregationStateCheckpointTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup AggregationStateCheckpointTest test class.");
+    }
+
+    void SetUp() override
+    {
+        Testing::BaseUnitTest::SetUp();
+        bufferManager = BufferManager::create();
+        nautilus::engine::Options options;
+        options.setOption("engine.Compilation", false);
+        engine = std::make_unique<nautilus::engine::NautilusEngine>(options);
+        cleanupFunction = std::make_shared<CreateNewHashMapSliceArgs::NautilusCleanupExec>(
+            engine->registerFunction(std::function([](nautilus::val<HashMap*>) { })));
+        directory = std::filesystem::temp_directory_path()
+            / (std::string("AggregationStateCheckpointTest-") + ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(directory);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(directory);
+        Testing::BaseUnitTest::TearDown();
+    }
+
+    std::shared_ptr<AggregationSlice> createSlice(const uint64_t sliceStart, const uint64_t sliceEnd) const
+    {
+        const CreateNewHashMapSliceArgs args{{cleanupFunction}, KEY_SIZE, VALUE_SIZE, PAGE_SIZE, 16, HashMapType::CHAINED};
+        return std::make_shared<AggregationSlice>(
+            SliceStart(sliceStart), SliceEnd(sliceEnd), args, NUMBER_OF_WORKER_THREADS, NUMBER_OF_PARTITIONS);
+    }
+
+    void insert(HashMap& hashMap, const uint64_t hash) const
+    {
+        auto* const entry = reinterpret_cast<std::byte*>(hashMap.insertEntry(hash, bufferManager.get())); /// NOLINT
+        const uint64_t value = hash * 10;
+        std::memcpy(entry + sizeof(ChainedHashMapEntry), &hash, sizeof(hash));
+        std::memcpy(entry + sizeof(ChainedHashMapEntry) + KEY_SIZE, &value, sizeof(value));
+    }
+
+    /// Returns the value of the entry with the hash, or nullopt if the chain of the hash does not contain it
+    static std::optional<uint64_t> lookup(const ChainedHashMap& hashMap, const uint64_t hash)
+    {
+        for (const auto* entry = hashMap.findChain(hash); entry != nullptr; entry = entry->next)
+        {
+            if (entry->hash == hash)
+            {
+                uint64_t value = 0;
+                std::memcpy(&value, reinterpret_cast<const std::byte*>(entry) + sizeof(ChainedHashMapEntry) + KEY_SIZE, sizeof(value));
+                return value;
+            }
+        }
+        return std::nullopt;
+    }
+
+    void copyAllWorkerThreads(AggregationStateCheckpoint& checkpoint, const AggregationSlice& slice) const
+    {
+        for (uint64_t workerThread = 0; workerThread < NUMBER_OF_WORKER_THREADS; ++workerThread)
+        {
+            checkpoint.copyChangedPages(slice, WorkerThreadId(workerThread));
+        }
+    }
+
+    uint64_t countPageFiles() const
+    {
+        uint64_t numberOfPageFiles = 0;
+        for (const auto& file : std::filesystem::directory_iterator(directory))
+        {
+            numberOfPageFiles += file.path().filename().string().starts_with("pages-") ? 1 : 0;
+        }
+        return numberOfPageFiles;
+    }
+
+    std::shared_ptr<BufferManager> bufferManager;
+    std::unique_ptr<nautilus::engine::NautilusEngine> engine;
+    std::shared_ptr<CreateNewHashMapSliceArgs::NautilusCleanupExec> cleanupFunction;
+    std::filesystem::path directory;
+};
+
+TEST_F(AggregationStateCheckpointTest, RestoresAllEntries)
+{
+    constexpr uint64_t NUMBER_OF_ENTRIES = 100;
+    const auto slice = createSlice(0, 10);
+    for (uint64_t hash = 0; hash < NUMBER_OF_ENTRIES; ++hash)
+    {
+        insert(*slice->getHashMapPtrOrCreate(WorkerThreadId(hash % NUMBER_OF_WORKER_THREADS), hash % NUMBER_OF_PARTITIONS), hash);
+    }
+    {
+        AggregationStateCheckpoint checkpoint(directory, LAYOUT);
+        EXPECT_FALSE(checkpoint.restore().has_value());
+        copyAllWorkerThreads(checkpoint, *slice);
+        checkpoint.commit(Timestamp(5));
+    }
+
+    AggregationStateCheckpoint checkpoint(directory, LAYOUT);
+    const auto restoredState = checkpoint.restore();
+    ASSERT_TRUE(restoredState.has_value());
+    EXPECT_EQ(restoredState->earliestWindowEnd, Timestamp(5));
+
+    /// Restores the entries of all hash maps into a single hash map, whose chains must contain all of them
+    ChainedHashMap restoredHashMap(KEY_SIZE, VALUE_SIZE, 16, PAGE_SIZE);
+    for (const auto& [key, entries] : restoredState->pages)
+    {
+        EXPECT_EQ(key.sliceStart, SliceStart(0));
+        EXPECT_EQ(key.sliceEnd, SliceEnd(10));
+        EXPECT_LT(key.hashMapIndex, NUMBER_OF_WORKER_THREADS * NUMBER_OF_PARTITIONS);
+        restoredHashMap.insertCopiesOfEntries(entries, bufferManager.get());
+    }
+    ASSERT_EQ(restoredHashMap.getNumberOfTuples(), NUMBER_OF_ENTRIES);
+    for (uint64_t hash = 0; hash < NUMBER_OF_ENTRIES; ++hash)
+    {
+        EXPECT_EQ(lookup(restoredHashMap, hash), hash * 10) << hash;
+    }
+}
+
+TEST_F(AggregationStateCheckpointTest, WritesSolelyChangedPages)
+{
+    /// Fills three pages of a single hash map
+    const auto entriesPerPage = PAGE_SIZE / LAYOUT.entrySize;
+    const auto slice = createSlice(0, 10);
+    auto* const hashMap = slice->getHashMapPtrOrCreate(WorkerThreadId(0), 0);
+    for (uint64_t hash = 0; hash < 3 * entriesPerPage; ++hash)
+    {
+        insert(*hashMap, hash);
+    }
+    const auto pageBytes = entriesPerPage * LAYOUT.entrySize;
+
+    AggregationStateCheckpoint checkpoint(directory, LAYOUT);
+    copyAllWorkerThreads(checkpoint, *slice);
+    checkpoint.commit(Timestamp(0));
+    EXPECT_EQ(checkpoint.getBytesOfLastCommit(), 3 * pageBytes);
+
+    copyAllWorkerThreads(checkpoint, *slice);
+    checkpoint.commit(Timestamp(0));
+    EXPECT_EQ(checkpoint.getBytesOfLastCommit(), 0);
+
+    /// Changing the value of the first entry solely rewrites the first page
+    auto* const firstEntry = reinterpret_cast<std::byte*>(dynamic_cast<ChainedHashMap*>(hashMap)->findChain(0)); /// NOLINT
+    const uint64_t newValue = 42;
+    std::memcpy(firstEntry + sizeof(ChainedHashMapEntry) + KEY_SIZE, &newValue, sizeof(newValue));
+    copyAllWorkerThreads(checkpoint, *slice);
+    checkpoint.commit(Timestamp(0));
+    EXPECT_EQ(checkpoint.getBytesOfLastCommit(), pageBytes);
+    EXPECT_EQ(countPageFiles(), 2);
+
+    /// A slice that is not part of the checkpoint anymore releases its pages
+    checkpoint.commit(Timestamp(20));
+    EXPECT_EQ(countPageFiles(), 0);
+    AggregationStateCheckpoint restoredCheckpoint(directory, LAYOUT);
+    const auto restoredState = restoredCheckpoint.restore();
+    ASSERT_TRUE(restoredState.has_value());
+    EXPECT_TRUE(restoredState->pages.empty());
+}
+
+TEST_F(AggregationStateCheckpointTest, RestoresLatestVersionOfChangedPages)
+{
+    const auto slice = createSlice(10, 20);
+    auto* const hashMap = dynamic_cast<ChainedHashMap*>(slice->getHashMapPtrOrCreate(WorkerThreadId(1), 1));
+    insert(*hashMap, 7);
+    AggregationStateCheckpoint checkpoint(directory, LAYOUT);
+    copyAllWorkerThreads(checkpoint, *slice);
+    checkpoint.commit(Timestamp(0));
+
+    insert(*hashMap, 9);
+    copyAllWorkerThreads(checkpoint, *slice);
+    checkpoint.commit(Timestamp(0));
+    /// Copies that are not committed are not part of the checkpoint
+    insert(*hashMap, 11);
+    copyAllWorkerThreads(checkpoint, *slice);
+
+    AggregationStateCheckpoint restoredCheckpoint(directory, LAYOUT);
+    const auto restoredState = restoredCheckpoint.restore();
+    ASSERT_TRUE(restoredState.has_value());
+    ASSERT_EQ(restoredState->pages.size(), 1);
+    EXPECT_EQ(restoredState->pages[0].key.hashMapIndex, (1 * NUMBER_OF_PARTITIONS) + 1);
+    ChainedHashMap restoredHashMap(KEY_SIZE, VALUE_SIZE, 16, PAGE_SIZE);
+    restoredHashMap.insertCopiesOfEntries(restoredState->pages[0].entries, bufferManager.get());
+    EXPECT_EQ(restoredHashMap.getNumberOfTuples(), 2);
+    EXPECT_EQ(lookup(restoredHashMap, 7), 70);
+    EXPECT_EQ(lookup(restoredHashMap, 9), 90);
+    EXPECT_EQ(lookup(restoredHashMap, 11), std::nullopt);
+}
+
+TEST_F(AggregationStateCheckpointTest, IgnoresCheckpointOfOtherLayout)
+{
+    const auto slice = createSlice(0, 10);
+    insert(*slice->getHashMapPtrOrCreate(WorkerThreadId(0), 0), 0);
+    {
+        AggregationStateCheckpoint checkpoint(directory, LAYOUT);
+        copyAllWorkerThreads(checkpoint, *slice);
+        checkpoint.commit(Timestamp(0));
+    }
+    AggregationStateCheckpoint checkpoint(directory, {.entrySize = LAYOUT.entrySize, .numberOfPartitions = NUMBER_OF_PARTITIONS + 1});
+    EXPECT_FALSE(checkpoint.restore().has_value());
+}
+
+}
@@ -0,0 +1,234 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <Functions/BatchKernels.hpp>
+#include <Functions/SimdBatchKernels.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <magic_enum/magic_enum.hpp>
+#include <BaseUnitTest.hpp>
+#include <val.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+class BatchKernelsTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("BatchKernelsTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup BatchKernelsTest test class.");
+    }
+
+    static uint64_t dataTypeSize(const DataType::Type type)
+    {
+        return DataType{type, DataType::NULLABLE::NOT_NULLABLE}.getSizeInBytesWithoutNull();
+    }
+
+    /// Evaluates the filters over the given range of contiguous columns and returns the selected record indices
+    static std::vector<uint64_t> select(
+        const std::vector<std::pair<BatchFilter, int8_t*>>& filters, const uint64_t begin, const uint64_t size)
+    {
+        std::vector<int8_t> mask(size);
+        std::vector<uint64_t> selectionVector(size);
+        for (size_t i = 0; i < filters.size(); ++i)
+        {
+            const auto& [filter, column] = filters[i];
+            filter.evaluate(column, dataTypeSize(filter.fieldType), begin, size, mask.data(), i == 0);
+        }
+        const auto numberOfSelected = nautilus::details::RawValueResolver<uint64_t>::getRawValue(
+            compactSelection(mask.data(), begin, size, reinterpret_cast<int8_t*>(selectionVector.data()))); /// NOLINT
+        selectionVector.resize(numberOfSelected);
+        return selectionVector;
+    }
+};
+
+TEST_F(BatchKernelsTest, SignedComparisons)
+{
+    std::vector<int32_t> values(100);
+    std::iota(values.begin(), values.end(), -50);
+    auto* column = reinterpret_cast<int8_t*>(values.data()); /// NOLINT
+
+    const BatchFilter less{.field = "a", .fieldType = DataType::Type::INT32, .comparison = BatchComparison::LESS, .constant = int64_t{-48}};
+    EXPECT_EQ(select({{less, column}}, 0, values.size()), (std::vector<uint64_t>{0, 1}));
+
+    const BatchFilter equals{
+        .field = "a", .fieldType = DataType::Type::INT32, .comparison = BatchComparison::EQUALS, .constant = int64_t{0}};
+    EXPECT_EQ(select({{equals, column}}, 0, values.size()), (std::vector<uint64_t>{50}));
+
+    /// Evaluating a batch in the middle of the column returns the absolute record indices
+    const BatchFilter greaterEquals{
+        .field = "a", .fieldType = DataType::Type::INT32, .comparison = BatchComparison::GREATER_EQUALS, .constant = int64_t{47}};
+    EXPECT_EQ(select({{greaterEquals, column}}, 90, 10), (std::vector<uint64_t>{97, 98, 99}));
+}
+
+TEST_F(BatchKernelsTest, ConjunctionOfFiltersOnDifferentColumns)
+{
+    std::vector<uint64_t> ids(2048);
+    std::iota(ids.begin(), ids.end(), 0);
+    std::vector<double> values(ids.size());
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = static_cast<double>(i % 10) / 2.0;
+    }
+
+    const BatchFilter idFilter{
+        .field = "id", .fieldType = DataType::Type::UINT64, .comparison = BatchComparison::LESS_EQUALS, .constant = uint64_t{30}};
+    const BatchFilter valueFilter{
+        .field = "value", .fieldType = DataType::Type::FLOAT64, .comparison = BatchComparison::GREATER, .constant = 4.0};
+    const auto selected = select(
+        {{idFilter, reinterpret_cast<int8_t*>(ids.data())}, {valueFilter, reinterpret_cast<int8_t*>(values.data())}}, /// NOLINT
+        0,
+        ids.size());
+    EXPECT_EQ(selected, (std::vector<uint64_t>{9, 19, 29}));
+}
+
+/// In a row layout, the values of a field are interleaved with the other fields of the tuple
+TEST_F(BatchKernelsTest, StridedFieldAccess)
+{
+    struct Tuple
+    {
+        int64_t id;
+        float value;
+        int32_t padding;
+    };
+    std::vector<Tuple> tuples(100);
+    for (size_t i = 0; i < tuples.size(); ++i)
+    {
+        tuples[i] = {.id = static_cast<int64_t>(i), .value = i % 2 == 0 ? 1.5F : -1.5F, .padding = -1};
+    }
+    auto* buffer = reinterpret_cast<int8_t*>(tuples.data()); /// NOLINT
+
+    const BatchFilter valueFilter{
+        .field = "value", .fieldType = DataType::Type::FLOAT32, .comparison = BatchComparison::LESS, .constant = 0.0};
+    const BatchFilter idFilter{
+        .field = "id", .fieldType = DataType::Type::INT64, .comparison = BatchComparison::GREATER, .constant = int64_t{94}};
+    std::vector<int8_t> mask(tuples.size());
+    std::vector<uint64_t> selectionVector(tuples.size());
+    valueFilter.evaluate(buffer + offsetof(Tuple, value), sizeof(Tuple), 0, tuples.size(), mask.data(), true);
+    idFilter.evaluate(buffer + offsetof(Tuple, id), sizeof(Tuple), 0, tuples.size(), mask.data(), false);
+    const auto numberOfSelected = nautilus::details::RawValueResolver<uint64_t>::getRawValue(
+        compactSelection(mask.data(), 0, tuples.size(), reinterpret_cast<int8_t*>(selectionVector.data()))); /// NOLINT
+    selectionVector.resize(numberOfSelected);
+    EXPECT_EQ(selectionVector, (std::vector<uint64_t>{95, 97, 99}));
+}
+
+/// Contiguous columns are evaluated by the SIMD kernels of the cpu (if any), strided fields always by the scalar kernels.
+/// Thus, evaluating the same values in both layouts checks the SIMD kernels against the scalar kernels.
+template <typename T, typename C>
+void checkSimdMatchesScalar(const DataType::Type type, std::vector<T> values, const C constant)
+{
+    std::vector<T> strided(values.size() * 2);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        strided[i * 2] = values[i];
+    }
+    constexpr uint64_t begin = 3;
+    const uint64_t size = values.size() - begin;
+    for (const auto comparison : magic_enum::enum_values<BatchComparison>())
+    {
+        const BatchFilter filter{.field = "a", .fieldType = type, .comparison = comparison, .constant = constant};
+        for (const bool isFirstFilter : {true, false})
+        {
+            std::vector<int8_t> contiguousMask(size, 1);
+            std::vector<int8_t> stridedMask(size, 1);
+            for (size_t i = 0; i < size; i += 3)
+            {
+                contiguousMask[i] = stridedMask[i] = 0;
+            }
+            auto* contiguousColumn = reinterpret_cast<int8_t*>(values.data()); /// NOLINT
+            auto* stridedField = reinterpret_cast<int8_t*>(strided.data()); /// NOLINT
+            filter.evaluate(contiguousColumn, sizeof(T), begin, size, contiguousMask.data(), isFirstFilter);
+            filter.evaluate(stridedField, 2 * sizeof(T), begin, size, stridedMask.data(), isFirstFilter);
+            EXPECT_EQ(contiguousMask, stridedMask) << magic_enum::enum_name(type) << " " << magic_enum::enum_name(comparison);
+        }
+    }
+}
+
+TEST_F(BatchKernelsTest, SimdKernelsMatchScalarKernels)
+{
+    NES_INFO("Batch comparison kernels use {}", magic_enum::enum_name(getSimdInstructionSet()));
+    constexpr size_t numberOfValues = 1000;
+    std::vector<int32_t> signedValues(numberOfValues);
+    std::vector<uint64_t> unsignedValues(numberOfValues);
+    std::vector<double> floatingPointValues(numberOfValues);
+    for (size_t i = 0; i < numberOfValues; ++i)
+    {
+        signedValues[i] = static_cast<int32_t>(i % 21) - 10;
+        unsignedValues[i] = i % 3 == 0 ? std::numeric_limits<uint64_t>::max() - (i % 5) : i % 7;
+        floatingPointValues[i] = i % 11 == 0 ? std::numeric_limits<double>::quiet_NaN() : static_cast<double>(i % 9) - 4.5;
+    }
+
+    checkSimdMatchesScalar(DataType::Type::INT32, signedValues, int64_t{-3});
+    const std::vector<int64_t> signedValues64(signedValues.begin(), signedValues.end());
+    checkSimdMatchesScalar(DataType::Type::INT64, signedValues64, int64_t{7});
+    checkSimdMatchesScalar(DataType::Type::INT64, signedValues64, std::numeric_limits<int64_t>::min());
+    checkSimdMatchesScalar(DataType::Type::UINT64, unsignedValues, uint64_t{4});
+    checkSimdMatchesScalar(DataType::Type::UINT64, unsignedValues, std::numeric_limits<uint64_t>::max() - 2);
+    std::vector<uint32_t> unsigned32(numberOfValues);
+    for (size_t i = 0; i < numberOfValues; ++i)
+    {
+        unsigned32[i] = static_cast<uint32_t>(unsignedValues[i]);
+    }
+    checkSimdMatchesScalar(DataType::Type::UINT32, unsigned32, uint64_t{std::numeric_limits<uint32_t>::max() - 1});
+    checkSimdMatchesScalar(DataType::Type::FLOAT64, floatingPointValues, 0.5);
+    const std::vector<float> floatValues(floatingPointValues.begin(), floatingPointValues.end());
+    checkSimdMatchesScalar(DataType::Type::FLOAT32, floatValues, -1.5);
+    /// 0.1 is not representable as float, thus the float column falls back to the scalar kernel that compares as double
+    checkSimdMatchesScalar(DataType::Type::FLOAT32, floatValues, 0.1);
+}
+
+TEST_F(BatchKernelsTest, NoQualifyingRecords)
+{
+    std::vector<uint8_t> values(VECTORIZED_BATCH_SIZE, 7);
+    const BatchFilter filter{
+        .field = "a", .fieldType = DataType::Type::UINT8, .comparison = BatchComparison::GREATER, .constant = uint64_t{7}};
+    EXPECT_TRUE(select({{filter, reinterpret_cast<int8_t*>(values.data())}}, 0, values.size()).empty()); /// NOLINT
+}
+
+/// The nested loop join compares a block of inner keys with the key of one outer tuple after the other
+TEST_F(BatchKernelsTest, KeyComparisonWithRuntimeKey)
+{
+    std::vector<int32_t> keys(100);
+    std::iota(keys.begin(), keys.end(), -50);
+    auto* values = reinterpret_cast<int8_t*>(keys.data()); /// NOLINT
+    const auto selectKeys = [&](const BatchComparison comparison, const int32_t key)
+    {
+        std::vector<int8_t> mask(keys.size());
+        std::vector<uint64_t> selectionVector(keys.size());
+        evaluateKeyComparison(DataType::Type::INT32, comparison, values, keys.size(), mask.data(), VarVal(nautilus::val<int32_t>(key)));
+        const auto numberOfSelected = nautilus::details::RawValueResolver<uint64_t>::getRawValue(
+            compactSelection(mask.data(), 0, keys.size(), reinterpret_cast<int8_t*>(selectionVector.data()))); /// NOLINT
+        selectionVector.resize(numberOfSelected);
+        return selectionVector;
+    };
+    EXPECT_EQ(selectKeys(BatchComparison::EQUALS, 3), (std::vector<uint64_t>{53}));
+    EXPECT_EQ(selectKeys(BatchComparison::LESS, -48), (std::vector<uint64_t>{0, 1}));
+    EXPECT_EQ(selectKeys(mirrorBatchComparison(BatchComparison::LESS), 48), (std::vector<uint64_t>{99}));
+    EXPECT_TRUE(selectKeys(BatchComparison::GREATER_EQUALS, 50).empty());
+}
+
+}
@@ -0,0 +1,104 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/DataTypeProvider.hpp>
+#include <Functions/BatchUdf.hpp>
+#include <Functions/BatchUdfPhysicalFunction.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+namespace NES
+{
+
+class BatchUdfTest : public Testing::BaseUnitTest
+{
+};
+
+namespace
+{
+/// Adds both arguments and counts the number of calls
+size_t numberOfCalls = 0;
+
+void addUdf(const std::span<const UdfColumn> arguments, const UdfColumn& result)
+{
+    ++numberOfCalls;
+    const auto left = arguments[0].getValues<int32_t>();
+    const auto right = arguments[1].getValues<int64_t>();
+    const auto sums = result.getValues<int64_t>();
+    for (size_t row = 0; row < result.size; ++row)
+    {
+        sums[row] = left[row] + right[row];
+    }
+}
+}
+
+TEST_F(BatchUdfTest, EvaluatesWholeBatchAndPropagatesNulls)
+{
+    constexpr size_t capacity = 5;
+    const ScalarUdfBatchLayout layout{
+        .udf = addUdf,
+        .argumentTypes
+        = {DataTypeProvider::provideDataType(DataType::Type::INT32, DataType::NULLABLE::IS_NULLABLE),
+           DataTypeProvider::provideDataType(DataType::Type::INT64)},
+        .resultType = DataTypeProvider::provideDataType(DataType::Type::INT64, DataType::NULLABLE::IS_NULLABLE)};
+    std::vector<std::byte> batch(layout.getBatchSizeInBytes(capacity));
+
+    auto* const left = reinterpret_cast<int32_t*>(batch.data() + layout.getColumnOffset(0, capacity));
+    auto* const leftNulls = reinterpret_cast<bool*>(batch.data() + layout.getNullsOffset(0, capacity));
+    auto* const right = reinterpret_cast<int64_t*>(batch.data() + layout.getColumnOffset(1, capacity));
+    for (size_t row = 0; row < capacity; ++row)
+    {
+        left[row] = static_cast<int32_t>(row);
+        leftNulls[row] = row == 1;
+        right[row] = 100;
+    }
+
+    numberOfCalls = 0;
+    constexpr uint64_t numberOfRows = 3;
+    layout.evaluate(batch.data(), numberOfRows, capacity);
+    EXPECT_EQ(numberOfCalls, 1);
+
+    const auto* const sums = reinterpret_cast<const int64_t*>(batch.data() + layout.getColumnOffset(2, capacity));
+    const auto* const sumNulls = reinterpret_cast<const bool*>(batch.data() + layout.getNullsOffset(2, capacity));
+    EXPECT_EQ(sums[0], 100);
+    EXPECT_EQ(sums[2], 102);
+    EXPECT_FALSE(sumNulls[0]);
+    EXPECT_TRUE(sumNulls[1]);
+    EXPECT_FALSE(sumNulls[2]);
+}
+
+TEST_F(BatchUdfTest, ColumnsDoNotOverlap)
+{
+    const ScalarUdfBatchLayout layout{
+        .udf = addUdf,
+        .argumentTypes
+        = {DataTypeProvider::provideDataType(DataType::Type::INT8, DataType::NULLABLE::IS_NULLABLE),
+           DataTypeProvider::provideDataType(DataType::Type::FLOAT64)},
+        .resultType = DataTypeProvider::provideDataType(DataType::Type::BOOLEAN)};
+    for (const size_t capacity : {1, 3, 1024})
+    {
+        EXPECT_GE(layout.getNullsOffset(0, capacity), layout.getColumnOffset(0, capacity) + capacity);
+        EXPECT_GE(layout.getColumnOffset(1, capacity), layout.getNullsOffset(0, capacity) + capacity);
+        EXPECT_EQ(layout.getColumnOffset(1, capacity) % sizeof(double), 0);
+        EXPECT_GE(layout.getColumnOffset(2, capacity), layout.getColumnOffset(1, capacity) + (capacity * sizeof(double)));
+        EXPECT_GE(layout.getBatchSizeInBytes(capacity), layout.getColumnOffset(2, capacity) + capacity);
+    }
+}
+
+}
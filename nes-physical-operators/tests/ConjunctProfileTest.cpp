@@ -0,0 +1,92 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+#include <SelectionPhysicalOperator.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+namespace NES
+{
+
+class ConjunctProfileTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("ConjunctProfileTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup ConjunctProfileTest class.");
+    }
+};
+
+TEST_F(ConjunctProfileTest, WithoutRecordsKeepsOrderOfPredicate)
+{
+    const ConjunctProfile profile(3);
+    EXPECT_EQ(profile.getEvaluationOrder(), (std::vector<size_t>{0, 1, 2}));
+}
+
+TEST_F(ConjunctProfileTest, OrdersByAscendingPassRate)
+{
+    ConjunctProfile profile(4);
+    /// Conjunct 0 passes all records, conjunct 1 one of four, conjunct 2 none, and conjunct 3 half of them
+    for (uint64_t record = 0; record < 100; ++record)
+    {
+        const uint64_t passed = 0b0001U | (record % 4 == 0 ? 0b0010U : 0U) | (record % 2 == 0 ? 0b1000U : 0U);
+        profile.record(passed);
+    }
+    EXPECT_EQ(profile.getEvaluationOrder(), (std::vector<size_t>{2, 1, 3, 0}));
+}
+
+TEST_F(ConjunctProfileTest, FirstCallFixesOrder)
+{
+    ConjunctProfile profile(2);
+    profile.record(0b01U);
+    EXPECT_EQ(profile.getEvaluationOrder(), (std::vector<size_t>{1, 0}));
+    for (size_t record = 0; record < 10; ++record)
+    {
+        profile.record(0b10U);
+    }
+    EXPECT_EQ(profile.getEvaluationOrder(), (std::vector<size_t>{1, 0}));
+}
+
+TEST_F(ConjunctProfileTest, ConcurrentRecords)
+{
+    constexpr size_t numberOfThreads = 8;
+    constexpr size_t recordsPerThread = 10000;
+    ConjunctProfile profile(ConjunctProfile::MAX_NUMBER_OF_CONJUNCTS);
+    {
+        std::vector<std::jthread> threads;
+        for (size_t thread = 0; thread < numberOfThreads; ++thread)
+        {
+            threads.emplace_back(
+                [&profile]
+                {
+                    for (size_t record = 0; record < recordsPerThread; ++record)
+                    {
+                        /// Only the last conjunct rejects records
+                        profile.record(~uint64_t{0} >> (record % 2));
+                    }
+                });
+        }
+    }
+    EXPECT_EQ(profile.getEvaluationOrder().front(), ConjunctProfile::MAX_NUMBER_OF_CONJUNCTS - 1);
+}
+
+}
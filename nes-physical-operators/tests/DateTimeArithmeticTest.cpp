@@ -0,0 +1,70 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <Functions/DateTimeArithmetic.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+namespace NES
+{
+
+using namespace DateTimeArithmetic;
+
+class DateTimeArithmeticTest : public Testing::BaseUnitTest
+{
+};
+
+/// Covers every day of the three eras that follow the biased epoch, i.e., from 1570 to 2770, including all leap year rules
+TEST_F(DateTimeArithmeticTest, CivilDatesMatchChrono)
+{
+    constexpr auto firstDay = -static_cast<int64_t>(BIAS_IN_DAYS);
+    constexpr auto lastDay = 2 * static_cast<int64_t>(DAYS_PER_ERA);
+    for (int64_t daysSinceEpoch = firstDay; daysSinceEpoch < lastDay; ++daysSinceEpoch)
+    {
+        const auto biasedDays = static_cast<uint64_t>(daysSinceEpoch + static_cast<int64_t>(BIAS_IN_DAYS));
+        const std::chrono::sys_days day{std::chrono::days{daysSinceEpoch}};
+        const std::chrono::year_month_day expected{day};
+        const auto [year, month, dayOfMonth] = civilFromDays(biasedDays);
+        ASSERT_EQ(static_cast<int64_t>(year), static_cast<int>(expected.year())) << daysSinceEpoch;
+        ASSERT_EQ(month, static_cast<unsigned>(expected.month())) << daysSinceEpoch;
+        ASSERT_EQ(dayOfMonth, static_cast<unsigned>(expected.day())) << daysSinceEpoch;
+
+        const std::chrono::weekday weekday{day};
+        ASSERT_EQ(dayOfWeek(biasedDays), weekday.c_encoding()) << daysSinceEpoch;
+        ASSERT_EQ(daysSinceMonday(biasedDays), weekday.iso_encoding() - 1) << daysSinceEpoch;
+
+        const std::chrono::sys_days firstOfJanuary{expected.year() / std::chrono::January / 1};
+        ASSERT_EQ(daysOfFirstOfJanuary(year), firstOfJanuary.time_since_epoch().count() + static_cast<int64_t>(BIAS_IN_DAYS))
+            << daysSinceEpoch;
+    }
+}
+
+TEST_F(DateTimeArithmeticTest, TruncateToMultiple)
+{
+    /// 2024-02-29T13:45:30.123Z
+    constexpr uint64_t timestamp = 1709214330123;
+    const auto biasedMs = timestamp + BIAS_IN_MS;
+    EXPECT_EQ(truncateToMultiple(biasedMs, MS_PER_SECOND) - BIAS_IN_MS, 1709214330000);
+    EXPECT_EQ(truncateToMultiple(biasedMs, MS_PER_MINUTE) - BIAS_IN_MS, 1709214300000);
+    EXPECT_EQ(truncateToMultiple(biasedMs, MS_PER_HOUR) - BIAS_IN_MS, 1709211600000);
+    EXPECT_EQ(truncateToMultiple(biasedMs, MS_PER_DAY) - BIAS_IN_MS, 1709164800000);
+
+    /// In the local time of -05:00, the timestamp is 2024-02-29T08:45:30.123, whose day starts at 05:00 in UTC
+    constexpr auto offset = 5 * MS_PER_HOUR;
+    EXPECT_EQ(truncateToMultiple(biasedMs - offset, MS_PER_DAY) - BIAS_IN_MS + offset, 1709182800000);
+}
+
+}
@@ -0,0 +1,88 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstdint>
+#include <limits>
+#include <Functions/DecimalArithmetic.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+using namespace DecimalArithmetic;
+
+class DecimalArithmeticTest : public Testing::BaseUnitTest
+{
+};
+
+TEST_F(DecimalArithmeticTest, AddAndSubOverflows)
+{
+    constexpr auto max = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+    constexpr auto min = static_cast<uint64_t>(std::numeric_limits<int64_t>::min());
+    constexpr auto minusOne = static_cast<uint64_t>(-1);
+    EXPECT_EQ(addOverflows(max, uint64_t{1}, max + 1), 1);
+    EXPECT_EQ(addOverflows(max, minusOne, max - 1), 0);
+    EXPECT_EQ(addOverflows(min, minusOne, min - 1), 1);
+    EXPECT_EQ(subOverflows(min, uint64_t{1}, min - 1), 1);
+    EXPECT_EQ(subOverflows(max, minusOne, max + 1), 1);
+    EXPECT_EQ(subOverflows(minusOne, max, minusOne - max), 0);
+}
+
+TEST_F(DecimalArithmeticTest, RescaleRoundsHalfAwayFromZero)
+{
+    EXPECT_EQ(rescale(1234, 2, 4), 123400);
+    EXPECT_EQ(rescale(1235, 2, 1), 124);
+    EXPECT_EQ(rescale(-1235, 2, 1), -124);
+    EXPECT_EQ(rescale(-1234, 2, 1), -123);
+    EXPECT_THROW(rescale(std::numeric_limits<int64_t>::max() / 5, 0, 1), ArithmeticalError);
+}
+
+TEST_F(DecimalArithmeticTest, Multiply)
+{
+    /// 12.50 * 2.00 = 25.00
+    EXPECT_EQ(multiply(1250, 200, 2), 2500);
+    /// -1.25 * 0.05 = -0.0625, which rounds to -0.06
+    EXPECT_EQ(multiply(-125, 5, 2), -6);
+    /// The product of the unscaled values exceeds 64 bit
+    EXPECT_EQ(multiply(999999999999999999, 999999999999999999, 36), 1);
+    EXPECT_THROW(multiply(std::numeric_limits<int64_t>::max(), 2, 0), ArithmeticalError);
+}
+
+TEST_F(DecimalArithmeticTest, Divide)
+{
+    /// 10.00 / 3.00 = 3.33 and 20.00 / 3.00 = 6.67
+    EXPECT_EQ(divide(1000, 300, 2), 333);
+    EXPECT_EQ(divide(2000, 300, 2), 667);
+    EXPECT_EQ(divide(-2000, 300, 2), -667);
+    /// Shifts beyond the maximal precision continue with a long division
+    EXPECT_EQ(divide(2, 3, 19), 6666666666666666667);
+    EXPECT_EQ(divide(1, 1000000000000000000, 36), 1000000000000000000);
+    EXPECT_THROW(divide(1, 3, 30), ArithmeticalError);
+    EXPECT_THROW(divide(1, 0, 2), ArithmeticalError);
+}
+
+TEST_F(DecimalArithmeticTest, Conversions)
+{
+    EXPECT_EQ(fromUnsigned(42, 3), 42000);
+    EXPECT_THROW(fromUnsigned(std::numeric_limits<uint64_t>::max(), 0), ArithmeticalError);
+    EXPECT_EQ(fromDouble(12.345, 2), 1235);
+    EXPECT_EQ(fromDouble(-0.5, 0), -1);
+    EXPECT_THROW(fromDouble(1e30, 2), ArithmeticalError);
+    EXPECT_THROW(fromDouble(std::numeric_limits<double>::quiet_NaN(), 2), ArithmeticalError);
+    EXPECT_DOUBLE_EQ(toDouble(1250, 2), 12.5);
+}
+
+}
@@ -0,0 +1,122 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstdint>
+#include <vector>
+#include <Deduplication/DeduplicationOperatorHandler.hpp>
+#include <Deduplication/FingerprintSet.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Sequencing/SequenceData.hpp>
+#include <Time/Timestamp.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+namespace NES
+{
+
+class DeduplicationOperatorHandlerTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("DeduplicationOperatorHandlerTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup DeduplicationOperatorHandlerTest class.");
+    }
+
+    static constexpr uint64_t WINDOW_SIZE = 1000;
+    static constexpr uint64_t EXPECTED_NUMBER_OF_KEYS = 1024;
+};
+
+TEST_F(DeduplicationOperatorHandlerTest, FingerprintSetGrows)
+{
+    FingerprintSet fingerprints(4);
+    for (uint64_t fingerprint = 0; fingerprint < 100; ++fingerprint)
+    {
+        EXPECT_TRUE(fingerprints.insert(fingerprint * 0x9E3779B97F4A7C15));
+    }
+    EXPECT_EQ(fingerprints.size(), 100);
+    EXPECT_GE(fingerprints.capacity(), 200);
+    for (uint64_t fingerprint = 0; fingerprint < 100; ++fingerprint)
+    {
+        EXPECT_TRUE(fingerprints.contains(fingerprint * 0x9E3779B97F4A7C15));
+        EXPECT_FALSE(fingerprints.insert(fingerprint * 0x9E3779B97F4A7C15));
+    }
+}
+
+/// The fingerprint 0 marks empty slots, thus it shares its slot with the fingerprint 1
+TEST_F(DeduplicationOperatorHandlerTest, FingerprintSetZero)
+{
+    FingerprintSet fingerprints;
+    EXPECT_FALSE(fingerprints.contains(0));
+    EXPECT_TRUE(fingerprints.insert(0));
+    EXPECT_TRUE(fingerprints.contains(0));
+    EXPECT_FALSE(fingerprints.insert(0));
+}
+
+TEST_F(DeduplicationOperatorHandlerTest, FirstOccurrencePerWindow)
+{
+    DeduplicationOperatorHandler handler({OriginId(1)}, WINDOW_SIZE, EXPECTED_NUMBER_OF_KEYS, 0);
+    EXPECT_TRUE(handler.insertFirstOccurrence(Timestamp(10), 42));
+    EXPECT_FALSE(handler.insertFirstOccurrence(Timestamp(999), 42));
+    EXPECT_TRUE(handler.insertFirstOccurrence(Timestamp(999), 43));
+    /// Each window deduplicates its keys independently of the other windows
+    EXPECT_TRUE(handler.insertFirstOccurrence(Timestamp(1000), 42));
+    EXPECT_EQ(handler.getNumberOfWindows(), 2);
+}
+
+TEST_F(DeduplicationOperatorHandlerTest, WatermarkDiscardsWindows)
+{
+    DeduplicationOperatorHandler handler({OriginId(1)}, WINDOW_SIZE, EXPECTED_NUMBER_OF_KEYS, 0);
+    EXPECT_TRUE(handler.insertFirstOccurrence(Timestamp(10), 42));
+    EXPECT_TRUE(handler.insertFirstOccurrence(Timestamp(1010), 42));
+
+    handler.updateWatermark(Timestamp(1000), SequenceData(SequenceNumber(1), ChunkNumber(1), true), OriginId(1));
+    EXPECT_EQ(handler.getNumberOfWindows(), 1);
+    /// Records of a discarded window are late and dropped instead of being forwarded again
+    EXPECT_FALSE(handler.insertFirstOccurrence(Timestamp(20), 43));
+    EXPECT_FALSE(handler.insertFirstOccurrence(Timestamp(1020), 42));
+    EXPECT_TRUE(handler.insertFirstOccurrence(Timestamp(1020), 43));
+}
+
+/// The global watermark is the minimum of the watermarks of all origins
+TEST_F(DeduplicationOperatorHandlerTest, WatermarkOfAllOrigins)
+{
+    DeduplicationOperatorHandler handler({OriginId(1), OriginId(2)}, WINDOW_SIZE, EXPECTED_NUMBER_OF_KEYS, 0);
+    EXPECT_TRUE(handler.insertFirstOccurrence(Timestamp(10), 42));
+    handler.updateWatermark(Timestamp(5000), SequenceData(SequenceNumber(1), ChunkNumber(1), true), OriginId(1));
+    EXPECT_EQ(handler.getNumberOfWindows(), 1);
+    handler.updateWatermark(Timestamp(5000), SequenceData(SequenceNumber(1), ChunkNumber(1), true), OriginId(2));
+    EXPECT_EQ(handler.getNumberOfWindows(), 0);
+}
+
+/// A bloom filter never mistakes a duplicate for a new key, but may mistake few new keys for duplicates
+TEST_F(DeduplicationOperatorHandlerTest, BloomFilter)
+{
+    DeduplicationOperatorHandler handler({OriginId(1)}, WINDOW_SIZE, EXPECTED_NUMBER_OF_KEYS, 16);
+    uint64_t numberOfFirstOccurrences = 0;
+    for (uint64_t key = 0; key < EXPECTED_NUMBER_OF_KEYS; ++key)
+    {
+        numberOfFirstOccurrences += handler.insertFirstOccurrence(Timestamp(10), key * 0x9E3779B97F4A7C15) ? 1 : 0;
+    }
+    EXPECT_GE(numberOfFirstOccurrences, EXPECTED_NUMBER_OF_KEYS * 95 / 100);
+    for (uint64_t key = 0; key < EXPECTED_NUMBER_OF_KEYS; ++key)
+    {
+        EXPECT_FALSE(handler.insertFirstOccurrence(Timestamp(10), key * 0x9E3779B97F4A7C15));
+    }
+}
+
+}
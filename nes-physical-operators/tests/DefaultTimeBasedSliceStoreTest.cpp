@@ -0,0 +1,303 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+#include <SliceStore/DefaultTimeBasedSliceStore.hpp>
+#include <SliceStore/Slice.hpp>
+#include <Time/Timestamp.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+namespace NES
+{
+
+class DefaultTimeBasedSliceStoreTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("DefaultTimeBasedSliceStoreTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup DefaultTimeBasedSliceStoreTest class.");
+    }
+
+    /// Returns a slice creation function that counts the number of created slices
+    static auto countingSliceCreation(std::atomic<uint64_t>& numberOfCreatedSlices)
+    {
+        return [&numberOfCreatedSlices](const SliceStart sliceStart, const SliceEnd sliceEnd)
+        {
+            ++numberOfCreatedSlices;
+            return std::vector<std::shared_ptr<Slice>>{std::make_shared<Slice>(sliceStart, sliceEnd)};
+        };
+    }
+};
+
+/// All threads that insert into the same slices must get the same slice, regardless if they find it in the slice cache or in the slices
+TEST_F(DefaultTimeBasedSliceStoreTest, ConcurrentLookupsReturnTheSameSlice)
+{
+    constexpr uint64_t numberOfThreads = 8;
+    constexpr uint64_t numberOfTimestamps = 10000;
+    /// Slices start at multiples of the slide and at window ends, i.e., at 0, 10, 30, 40, 60, 70, ...
+    DefaultTimeBasedSliceStore sliceStore(70, 30);
+    sliceStore.setWorkerThreads(numberOfThreads);
+    std::atomic<uint64_t> numberOfCreatedSlices{0};
+    const auto createNewSlice = countingSliceCreation(numberOfCreatedSlices);
+
+    std::vector<std::vector<std::shared_ptr<Slice>>> slicesPerThread(numberOfThreads);
+    {
+        std::vector<std::jthread> threads;
+        for (uint64_t threadIndex = 0; threadIndex < numberOfThreads; ++threadIndex)
+        {
+            threads.emplace_back(
+                [&, threadIndex]
+                {
+                    for (uint64_t timestamp = 0; timestamp < numberOfTimestamps; ++timestamp)
+                    {
+                        const auto slices = sliceStore.getSlicesOrCreate(
+                            Timestamp(timestamp), WorkerThreadId(static_cast<uint32_t>(threadIndex)), createNewSlice);
+                        ASSERT_EQ(slices.size(), 1);
+                        ASSERT_LE(slices[0]->getSliceStart(), Timestamp(timestamp));
+                        ASSERT_GT(slices[0]->getSliceEnd(), Timestamp(timestamp));
+                        slicesPerThread[threadIndex].emplace_back(slices[0]);
+                    }
+                });
+        }
+    }
+
+    for (uint64_t threadIndex = 1; threadIndex < numberOfThreads; ++threadIndex)
+    {
+        ASSERT_EQ(slicesPerThread[threadIndex].size(), numberOfTimestamps);
+        for (size_t i = 0; i < numberOfTimestamps; ++i)
+        {
+            EXPECT_EQ(slicesPerThread[threadIndex][i], slicesPerThread[0][i]);
+        }
+    }
+
+    /// Every slice that has been returned is also stored in the slice store
+    for (const auto& slice : slicesPerThread[0])
+    {
+        const auto storedSlice = sliceStore.getSliceBySliceEnd(slice->getSliceEnd());
+        ASSERT_TRUE(storedSlice.has_value());
+        EXPECT_EQ(storedSlice.value(), slice);
+    }
+    EXPECT_EQ(slicesPerThread[0].back()->getSliceStart(), SliceStart(9990));
+    EXPECT_EQ(slicesPerThread[0].back()->getSliceEnd(), SliceEnd(10000));
+}
+
+/// Garbage collected slices must not be returned from the slice cache
+TEST_F(DefaultTimeBasedSliceStoreTest, GarbageCollectedSlicesAreRecreated)
+{
+    DefaultTimeBasedSliceStore sliceStore(10, 10);
+    sliceStore.setWorkerThreads(1);
+    std::atomic<uint64_t> numberOfCreatedSlices{0};
+    const auto createNewSlice = countingSliceCreation(numberOfCreatedSlices);
+
+    const auto firstSlice = sliceStore.getSlicesOrCreate(Timestamp(5), WorkerThreadId(0), createNewSlice)[0];
+    EXPECT_EQ(sliceStore.getSlicesOrCreate(Timestamp(7), WorkerThreadId(0), createNewSlice)[0], firstSlice);
+    EXPECT_EQ(numberOfCreatedSlices, 1);
+
+    /// The slice [0, 10) can be deleted, as its window [0, 10) ends before the watermark
+    sliceStore.garbageCollectSlicesAndWindows(Timestamp(100));
+    EXPECT_FALSE(sliceStore.getSliceBySliceEnd(SliceEnd(10)).has_value());
+    const auto recreatedSlice = sliceStore.getSlicesOrCreate(Timestamp(5), WorkerThreadId(0), createNewSlice)[0];
+    EXPECT_NE(recreatedSlice, firstSlice);
+    EXPECT_EQ(numberOfCreatedSlices, 2);
+
+    /// A slice, whose slice number maps to the same slot, replaces the cached slice without changing the result of a lookup
+    const auto collidingSlice = sliceStore.getSlicesOrCreate(Timestamp(10 * 16 + 5), WorkerThreadId(0), createNewSlice)[0];
+    EXPECT_EQ(collidingSlice->getSliceStart(), SliceStart(10 * 16));
+    EXPECT_EQ(sliceStore.getSlicesOrCreate(Timestamp(5), WorkerThreadId(0), createNewSlice)[0], recreatedSlice);
+    EXPECT_EQ(numberOfCreatedSlices, 3);
+
+    /// Lookups outside of a worker thread bypass the slice caches
+    EXPECT_EQ(sliceStore.getSlicesOrCreate(Timestamp(5), INVALID<WorkerThreadId>, createNewSlice)[0], recreatedSlice);
+    EXPECT_EQ(numberOfCreatedSlices, 3);
+}
+
+/// A worker thread releases the garbage collected slices of its slice cache with its next lookup, even of another slice
+TEST_F(DefaultTimeBasedSliceStoreTest, SliceCachesReleaseGarbageCollectedSlices)
+{
+    DefaultTimeBasedSliceStore sliceStore(10, 10);
+    sliceStore.setWorkerThreads(2);
+    std::atomic<uint64_t> numberOfCreatedSlices{0};
+    const auto createNewSlice = countingSliceCreation(numberOfCreatedSlices);
+
+    std::weak_ptr<Slice> firstSlice = sliceStore.getSlicesOrCreate(Timestamp(5), WorkerThreadId(0), createNewSlice)[0];
+    EXPECT_EQ(sliceStore.getSlicesOrCreate(Timestamp(5), WorkerThreadId(1), createNewSlice)[0], firstSlice.lock());
+    EXPECT_EQ(numberOfCreatedSlices, 1);
+
+    /// Both slice caches keep the slice alive until the next lookup of their worker thread
+    sliceStore.garbageCollectSlicesAndWindows(Timestamp(100));
+    EXPECT_FALSE(firstSlice.expired());
+    sliceStore.getSlicesOrCreate(Timestamp(105), WorkerThreadId(0), createNewSlice);
+    EXPECT_FALSE(firstSlice.expired());
+    sliceStore.getSlicesOrCreate(Timestamp(105), WorkerThreadId(1), createNewSlice);
+    EXPECT_TRUE(firstSlice.expired());
+    EXPECT_EQ(numberOfCreatedSlices, 2);
+
+    /// Deleting the state clears the slice caches right away
+    std::weak_ptr<Slice> secondSlice = sliceStore.getSliceBySliceEnd(SliceEnd(110)).value();
+    sliceStore.deleteState();
+    EXPECT_TRUE(secondSlice.expired());
+}
+
+/// Lookups in the slice cache must only take over slices that belong to the timestamp, while the garbage collection concurrently
+/// deletes the cached slices and the lookups of older timestamps recreate them
+TEST_F(DefaultTimeBasedSliceStoreTest, ConcurrentLookupsAndGarbageCollection)
+{
+    constexpr uint64_t numberOfThreads = 8;
+    constexpr uint64_t lastWatermark = 100000;
+    /// Covers more slices than the slice cache has slots, so that the lookups also replace the slices of the slots
+    constexpr uint64_t timestampsAfterWatermark = 10 * 300;
+    DefaultTimeBasedSliceStore sliceStore(10, 10);
+    sliceStore.setWorkerThreads(numberOfThreads);
+    std::atomic<uint64_t> numberOfCreatedSlices{0};
+    const auto createNewSlice = countingSliceCreation(numberOfCreatedSlices);
+    std::atomic<uint64_t> watermark{0};
+
+    {
+        std::vector<std::jthread> threads;
+        for (uint64_t threadIndex = 0; threadIndex < numberOfThreads; ++threadIndex)
+        {
+            threads.emplace_back(
+                [&, threadIndex]
+                {
+                    /// Every thread walks with a different stride through the timestamps around the watermark, including timestamps of
+                    /// slices that are being garbage collected
+                    uint64_t offset = threadIndex;
+                    for (auto currentWatermark = watermark.load(); currentWatermark < lastWatermark; currentWatermark = watermark.load())
+                    {
+                        offset = (offset + (2 * threadIndex) + 7) % timestampsAfterWatermark;
+                        const auto timestamp = (currentWatermark < 50 ? 0 : currentWatermark - 50) + offset;
+                        const auto slices = sliceStore.getSlicesOrCreate(
+                            Timestamp(timestamp), WorkerThreadId(static_cast<uint32_t>(threadIndex)), createNewSlice);
+                        ASSERT_EQ(slices.size(), 1);
+                        ASSERT_EQ(slices[0]->getSliceStart(), SliceStart(timestamp - (timestamp % 10)));
+                        ASSERT_EQ(slices[0]->getSliceEnd(), SliceEnd(timestamp - (timestamp % 10) + 10));
+                    }
+                });
+        }
+        threads.emplace_back(
+            [&]
+            {
+                for (uint64_t currentWatermark = 10; currentWatermark <= lastWatermark; currentWatermark += 10)
+                {
+                    watermark = currentWatermark;
+                    sliceStore.garbageCollectSlicesAndWindows(Timestamp(currentWatermark));
+                }
+            });
+    }
+
+    /// The garbage collection has deleted all slices that end long before the last watermark
+    sliceStore.garbageCollectSlicesAndWindows(Timestamp(lastWatermark));
+    EXPECT_FALSE(sliceStore.getSliceBySliceEnd(SliceEnd(lastWatermark - 100)).has_value());
+    EXPECT_GT(numberOfCreatedSlices, 0);
+}
+
+/// Early results read the filling windows, which keep their slices and get triggered afterward with a larger sequence number
+TEST_F(DefaultTimeBasedSliceStoreTest, FillingWindowsRemainTriggerable)
+{
+    DefaultTimeBasedSliceStore sliceStore(10, 10);
+    std::atomic<uint64_t> numberOfCreatedSlices{0};
+    const auto createNewSlice = countingSliceCreation(numberOfCreatedSlices);
+    const auto firstSlice = sliceStore.getSlicesOrCreate(Timestamp(5), WorkerThreadId(0), createNewSlice)[0];
+    const auto secondSlice = sliceStore.getSlicesOrCreate(Timestamp(15), WorkerThreadId(0), createNewSlice)[0];
+
+    const auto fillingWindows = sliceStore.getFillingWindowSlices();
+    ASSERT_EQ(fillingWindows.size(), 2);
+    const auto& [firstWindow, firstWindowSlices] = *fillingWindows.begin();
+    const auto& [secondWindow, secondWindowSlices] = *std::next(fillingWindows.begin());
+    EXPECT_EQ(firstWindow.windowInfo.windowEnd, Timestamp(10));
+    EXPECT_EQ(firstWindowSlices, std::vector{firstSlice});
+    EXPECT_EQ(secondWindow.windowInfo.windowEnd, Timestamp(20));
+    EXPECT_EQ(secondWindowSlices, std::vector{secondSlice});
+    EXPECT_LT(firstWindow.sequenceNumber, secondWindow.sequenceNumber);
+
+    const auto triggeredWindows = sliceStore.getTriggerableWindowSlices(Timestamp(11));
+    ASSERT_EQ(triggeredWindows.size(), 1);
+    EXPECT_EQ(triggeredWindows.begin()->first.windowInfo.windowEnd, Timestamp(10));
+    EXPECT_EQ(triggeredWindows.begin()->second, std::vector{firstSlice});
+    EXPECT_GT(triggeredWindows.begin()->first.sequenceNumber, secondWindow.sequenceNumber);
+
+    /// Triggered windows do not emit early results anymore
+    const auto remainingFillingWindows = sliceStore.getFillingWindowSlices();
+    ASSERT_EQ(remainingFillingWindows.size(), 1);
+    EXPECT_EQ(remainingFillingWindows.begin()->first.windowInfo.windowEnd, Timestamp(20));
+    EXPECT_GT(remainingFillingWindows.begin()->first.sequenceNumber, triggeredWindows.begin()->first.sequenceNumber);
+}
+
+/// Triggering starts after the emitted windows, but late updates and late records trigger windows before them again
+TEST_F(DefaultTimeBasedSliceStoreTest, TriggerWindowsBeforeEmittedWindows)
+{
+    DefaultTimeBasedSliceStore sliceStore(10, 10, 100);
+    std::atomic<uint64_t> numberOfCreatedSlices{0};
+    const auto createNewSlice = countingSliceCreation(numberOfCreatedSlices);
+    const auto firstSlice = sliceStore.getSlicesOrCreate(Timestamp(5), WorkerThreadId(0), createNewSlice)[0];
+    sliceStore.getSlicesOrCreate(Timestamp(15), WorkerThreadId(0), createNewSlice);
+    sliceStore.getSlicesOrCreate(Timestamp(25), WorkerThreadId(0), createNewSlice);
+
+    EXPECT_EQ(sliceStore.getTriggerableWindowSlices(Timestamp(21)).size(), 2);
+    EXPECT_TRUE(sliceStore.getTriggerableWindowSlices(Timestamp(22)).empty());
+
+    sliceStore.markWindowsWithLateUpdates({firstSlice});
+    const auto updatedWindows = sliceStore.getTriggerableWindowSlices(Timestamp(23));
+    ASSERT_EQ(updatedWindows.size(), 1);
+    EXPECT_EQ(updatedWindows.begin()->first.windowInfo.windowEnd, Timestamp(10));
+
+    /// A window that is created after the first window to trigger gets triggered together with it
+    sliceStore.getSlicesOrCreate(Timestamp(45), WorkerThreadId(0), createNewSlice);
+    const auto triggeredWindows = sliceStore.getTriggerableWindowSlices(Timestamp(51));
+    ASSERT_EQ(triggeredWindows.size(), 2);
+    EXPECT_EQ(triggeredWindows.begin()->first.windowInfo.windowEnd, Timestamp(30));
+    EXPECT_EQ(std::next(triggeredWindows.begin())->first.windowInfo.windowEnd, Timestamp(50));
+
+    /// A late record within the allowed lateness creates the missing window [30, 40) before the triggered windows
+    sliceStore.getSlicesOrCreate(Timestamp(35), WorkerThreadId(0), createNewSlice);
+    const auto lateWindows = sliceStore.getTriggerableWindowSlices(Timestamp(52));
+    ASSERT_EQ(lateWindows.size(), 1);
+    EXPECT_EQ(lateWindows.begin()->first.windowInfo.windowEnd, Timestamp(40));
+}
+
+/// Watermarks that do not pass the end of the first window to trigger skip the trigger, until a new window ends before them
+TEST_F(DefaultTimeBasedSliceStoreTest, WatermarksBeforeTheNextWindowEndDoNotTrigger)
+{
+    DefaultTimeBasedSliceStore sliceStore(10, 10);
+    std::atomic<uint64_t> numberOfCreatedSlices{0};
+    const auto createNewSlice = countingSliceCreation(numberOfCreatedSlices);
+    sliceStore.getSlicesOrCreate(Timestamp(25), WorkerThreadId(0), createNewSlice);
+    for (uint64_t watermark = 0; watermark <= 30; ++watermark)
+    {
+        EXPECT_TRUE(sliceStore.getTriggerableWindowSlices(Timestamp(watermark)).empty());
+    }
+
+    /// The window [10, 20) ends before the first window to trigger [20, 30)
+    sliceStore.getSlicesOrCreate(Timestamp(15), WorkerThreadId(0), createNewSlice);
+    const auto triggeredWindows = sliceStore.getTriggerableWindowSlices(Timestamp(21));
+    ASSERT_EQ(triggeredWindows.size(), 1);
+    EXPECT_EQ(triggeredWindows.begin()->first.windowInfo.windowEnd, Timestamp(20));
+    EXPECT_TRUE(sliceStore.getTriggerableWindowSlices(Timestamp(30)).empty());
+    EXPECT_EQ(sliceStore.getTriggerableWindowSlices(Timestamp(31)).size(), 1);
+    EXPECT_TRUE(sliceStore.getTriggerableWindowSlices(Timestamp(1000)).empty());
+}
+
+}
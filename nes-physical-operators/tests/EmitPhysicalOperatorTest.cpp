@@ -19,13 +19,16 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <initializer_list>
 #include <memory>
+#include <numeric>
 #include <random>
 #include <ranges>
 #include <set>
 #include <source_location>
+#include <string>
 #include <thread>
 #include <tuple>
 #include <unordered_map>
@@ -34,13 +37,18 @@
 #include <DataTypes/DataType.hpp>
 #include <Identifiers/Identifiers.hpp>
 #include <Identifiers/NESStrongType.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/DataTypes/VariableSizedData.hpp>
 #include <Nautilus/Interface/BufferRef/LowerSchemaProvider.hpp>
 #include <Nautilus/Interface/BufferRef/RowTupleBufferRef.hpp>
+#include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
+#include <Nautilus/Interface/Record.hpp>
 #include <Nautilus/Interface/RecordBuffer.hpp>
 #include <Runtime/AbstractBufferProvider.hpp>
 #include <Runtime/BufferManager.hpp>
 #include <Runtime/Execution/OperatorHandler.hpp>
 #include <Runtime/TupleBuffer.hpp>
+#include <Runtime/VariableSizedAccess.hpp>
 #include <Sequencing/SequenceData.hpp>
 #include <Util/Logger/LogLevel.hpp>
 #include <Util/Logger/Logger.hpp>
@@ -62,9 +70,9 @@ class EmitPhysicalOperatorTest : public Testing::BaseUnitTest
 {
     struct MockedPipelineContext final : PipelineExecutionContext
     {
-        bool emitBuffer(const TupleBuffer& buffer, ContinuationPolicy) override
+        bool emitBuffer(TupleBuffer buffer, ContinuationPolicy) override
         {
-            buffers.wlock()->emplace_back(buffer);
+            buffers.wlock()->emplace_back(std::move(buffer));
             return true;
         }
 
@@ -84,6 +92,10 @@ class EmitPhysicalOperatorTest : public Testing::BaseUnitTest
 
         [[nodiscard]] PipelineId getPipelineId() const override { return PipelineId(1); }
 
+        [[nodiscard]] uint64_t getNumberOfQueuedTasks() const override { return numberOfQueuedTasks; }
+
+        [[nodiscard]] uint64_t getNumberOfSubmittedTasks() const override { return numberOfSubmittedTasks; }
+
         std::unordered_map<OperatorHandlerId, std::shared_ptr<OperatorHandler>>& getOperatorHandlers() override
         {
             return *operatorHandlers;
@@ -105,6 +117,8 @@ class EmitPhysicalOperatorTest : public Testing::BaseUnitTest
         folly::Synchronized<std::vector<TupleBuffer>>& buffers;
         std::shared_ptr<BufferManager> bufferManager;
         std::unordered_map<OperatorHandlerId, std::shared_ptr<OperatorHandler>>* operatorHandlers = nullptr;
+        uint64_t numberOfQueuedTasks = 0;
+        uint64_t numberOfSubmittedTasks = 0;
         /// We want to ensure that the address of the TupleBuffer is always the same. If we would simply store the object directly in the vector,
         /// the address might change as the vector might be resized and thus, the object have a different address.
         std::vector<std::unique_ptr<TupleBuffer>> pinnedBuffers;
@@ -123,19 +137,140 @@ public:
         reset();
     }
 
-    EmitPhysicalOperator createUUT()
+    EmitPhysicalOperator createUUT(const bool emitsInSequenceOrder = false) ///NOLINT(fuchsia-default-arguments-declarations)
     {
         auto schema = Schema{}.addField("A_FIELD", DataType::Type::UINT32);
         auto bufferRef = LowerSchemaProvider::lowerSchema(512, schema, MemoryLayoutType::ROW_LAYOUT);
         EmitPhysicalOperator emit{OperatorHandlerId(0), std::move(bufferRef)};
-        handlers.insert_or_assign(OperatorHandlerId(0), std::make_shared<EmitOperatorHandler>());
+        handlers.insert_or_assign(OperatorHandlerId(0), std::make_shared<EmitOperatorHandler>(emitsInSequenceOrder));
+        return emit;
+    }
+
+    EmitPhysicalOperator createCoalescingUUT(const MemoryLayoutType memoryLayoutType, const std::chrono::microseconds latencyBound)
+    {
+        auto schema = Schema{}.addField("A_FIELD", DataType::Type::UINT32).addField("B_FIELD", DataType::Type::UINT64);
+        coalescingBufferRef = LowerSchemaProvider::lowerSchema(512, schema, memoryLayoutType);
+        auto handler = std::make_shared<EmitOperatorHandler>();
+        handler->enableCoalescing(EmitCoalescing::create(*coalescingBufferRef, latencyBound).value());
+        handlers.insert_or_assign(OperatorHandlerId(0), std::move(handler));
+        return EmitPhysicalOperator{OperatorHandlerId(0), coalescingBufferRef};
+    }
+
+    EmitPhysicalOperator createVarSizedSharingUUT(const uint64_t compactionThreshold)
+    {
+        varSizedBufferRef = LowerSchemaProvider::lowerSchema(512, varSizedSchema, MemoryLayoutType::ROW_LAYOUT);
+        auto handler = std::make_shared<EmitOperatorHandler>();
+        handler->enableVarSizedCompaction(VarSizedCompaction::create(*varSizedBufferRef, compactionThreshold).value());
+        handlers.insert_or_assign(OperatorHandlerId(0), std::move(handler));
+        EmitPhysicalOperator emit{OperatorHandlerId(0), varSizedBufferRef};
+        emit.enableVarSizedSharing();
         return emit;
     }
 
+    /// Creates an input buffer that stores the values in its TEXT field
+    TupleBuffer createVarSizedInput(const std::vector<std::string>& values)
+    {
+        const auto inputBufferRef = LowerSchemaProvider::lowerSchema(512, varSizedSchema, MemoryLayoutType::ROW_LAYOUT);
+        auto input = createBuffer(SequenceNumber::INITIAL, ChunkNumber::INITIAL, true);
+        run(
+            [&](auto& executionContext, auto& recordBuffer)
+            {
+                nautilus::val<uint64_t> recordIndex = 0;
+                for (const auto& value : values)
+                {
+                    Record record;
+                    record.write(
+                        "TEXT",
+                        VarVal(VariableSizedData(
+                            nautilus::val<int8_t*>(reinterpret_cast<int8_t*>(const_cast<char*>(value.data()))),
+                            nautilus::val<uint64_t>(value.size()))));
+                    inputBufferRef->writeRecord(recordIndex, recordBuffer, record, executionContext.pipelineMemoryProvider.bufferProvider);
+                    recordIndex = recordIndex + 1;
+                }
+                recordBuffer.setNumRecords(recordIndex);
+            },
+            input);
+        return input;
+    }
+
+    /// Emits the first 'numberOfRecords' records of the input buffer, as they were read by a scan
+    void emitVarSizedRecords(const EmitPhysicalOperator& emit, const TupleBuffer& input, const uint64_t numberOfRecords)
+    {
+        run(
+            [&](auto& executionContext, auto& recordBuffer)
+            {
+                emit.open(executionContext, recordBuffer);
+                for (nautilus::val<uint64_t> recordIndex = 0; recordIndex < numberOfRecords; recordIndex = recordIndex + 1)
+                {
+                    auto record = varSizedBufferRef->readRecord({}, recordBuffer, recordIndex);
+                    emit.execute(executionContext, record);
+                }
+                emit.close(executionContext, recordBuffer);
+            },
+            input);
+    }
+
+    /// Reads the TEXT field of all records of the emitted buffer
+    [[nodiscard]] std::vector<std::string> readEmittedText(const TupleBuffer& buffer) const
+    {
+        const auto location = varSizedBufferRef->getFieldLocation("TEXT").value();
+        std::vector<std::string> values;
+        for (uint64_t index = 0; index < buffer.getNumberOfTuples(); ++index)
+        {
+            VariableSizedAccess access;
+            std::memcpy(&access, buffer.getAvailableMemoryArea().data() + location.offset + (index * location.stride), sizeof(access));
+            const auto value = TupleBufferRef::loadAssociatedVarSizedValue(buffer, access);
+            values.emplace_back(reinterpret_cast<const char*>(value.data()), value.size());
+        }
+        return values;
+    }
+
+    /// Emits 'numberOfRecords' records per input buffer, whose fields both store a running counter over all input buffers
+    void emitRecords(const EmitPhysicalOperator& emit, const std::vector<TupleBuffer>& inputBuffers, const uint64_t numberOfRecords)
+    {
+        for (const auto& buffer : inputBuffers)
+        {
+            run(
+                [&](auto& executionContext, auto& recordBuffer)
+                {
+                    emit.open(executionContext, recordBuffer);
+                    const auto firstValue = (buffer.getSequenceNumber().getRawValue() - SequenceNumber::INITIAL) * numberOfRecords;
+                    for (uint64_t value = firstValue; value < firstValue + numberOfRecords; ++value)
+                    {
+                        Record record;
+                        record.write("A_FIELD", VarVal(nautilus::val<uint32_t>(static_cast<uint32_t>(value))));
+                        record.write("B_FIELD", VarVal(nautilus::val<uint64_t>(value)));
+                        emit.execute(executionContext, record);
+                    }
+                    emit.close(executionContext, recordBuffer);
+                },
+                buffer);
+        }
+    }
+
+    /// Reads the B_FIELD of all records of all emitted buffers
+    [[nodiscard]] std::vector<uint64_t> readEmittedValues() const
+    {
+        const auto location = coalescingBufferRef->getFieldLocation("B_FIELD").value();
+        std::vector<uint64_t> values;
+        for (const auto& buffer : *buffers.rlock())
+        {
+            for (uint64_t index = 0; index < buffer.getNumberOfTuples(); ++index)
+            {
+                uint64_t value = 0;
+                std::memcpy(&value, buffer.getAvailableMemoryArea().data() + location.offset + (index * location.stride), sizeof(value));
+                values.push_back(value);
+            }
+        }
+        return values;
+    }
+
     void run(const std::function<void(ExecutionContext&, RecordBuffer&)>& test, TupleBuffer buffer)
     {
         MockedPipelineContext pec{buffers, bm};
         pec.setOperatorHandlers(handlers);
+        pec.numberOfQueuedTasks = numberOfQueuedTasks;
+        pec.numberOfSubmittedTasks = numberOfSubmittedTasks;
         Arena arena(bm);
 
         ExecutionContext executionContext{&pec, &arena};
@@ -215,6 +350,15 @@ public:
         }
     }
 
+    void checkSequenceOrder(std::source_location location = std::source_location::current())
+    {
+        const testing::ScopedTrace scopedTrace(location.file_name(), static_cast<int>(location.line()), "checkSequenceOrder");
+        const auto sequences = (*buffers.rlock())
+            | std::views::transform([](const auto& buffer) { return std::make_pair(buffer.getSequenceNumber(), buffer.getChunkNumber()); })
+            | std::ranges::to<std::vector>();
+        EXPECT_TRUE(std::ranges::is_sorted(sequences)) << "Buffers were not emitted in the order of their sequence and chunk numbers";
+    }
+
     TupleBuffer createBuffer(
         SequenceNumber::Underlying sequence,
         ChunkNumber::Underlying chunkNumber,
@@ -239,6 +383,11 @@ public:
     folly::Synchronized<std::vector<TupleBuffer>> buffers;
     std::shared_ptr<BufferManager> bm = BufferManager::create(512, 100000);
     std::unordered_map<OperatorHandlerId, std::shared_ptr<OperatorHandler>> handlers;
+    std::shared_ptr<TupleBufferRef> coalescingBufferRef;
+    Schema varSizedSchema = Schema{}.addField("TEXT", DataType::Type::VARSIZED);
+    std::shared_ptr<TupleBufferRef> varSizedBufferRef;
+    uint64_t numberOfQueuedTasks = 0;
+    uint64_t numberOfSubmittedTasks = 0;
 
     std::random_device rd;
 };
@@ -394,4 +543,198 @@ TEST_F(EmitPhysicalOperatorTest, ConcurrentSequenceChunkNumberTest)
         checkLastChunks();
     }
 }
+
+/// Tests if a handler that emits in sequence order emits the buffers of all permutations in the order of their sequence numbers
+TEST_F(EmitPhysicalOperatorTest, SequenceOrderTest)
+{
+    std::vector<TupleBuffer> inputBuffers;
+    inputBuffers.emplace_back(createBuffer(SequenceNumber::INITIAL, ChunkNumber::INITIAL, false));
+    inputBuffers.emplace_back(createBuffer(SequenceNumber::INITIAL, ChunkNumber::INITIAL + 1, true));
+
+    inputBuffers.emplace_back(createBuffer(SequenceNumber::INITIAL + 1, ChunkNumber::INITIAL, true));
+
+    inputBuffers.emplace_back(createBuffer(SequenceNumber::INITIAL + 2, ChunkNumber::INITIAL, false));
+    inputBuffers.emplace_back(createBuffer(SequenceNumber::INITIAL + 2, ChunkNumber::INITIAL + 1, true));
+
+    bool hasMorePermutations = true;
+    while (hasMorePermutations)
+    {
+        reset();
+        EmitPhysicalOperator emit = createUUT(true);
+        for (auto& buffer : inputBuffers)
+        {
+            run(
+                [&](auto& executionContext, auto& recordBuffer)
+                {
+                    emit.open(executionContext, recordBuffer);
+                    emit.close(executionContext, recordBuffer);
+                },
+                buffer);
+        }
+        checkNumberOfBuffers(5);
+        checkSequenceOrder();
+        checkForDups();
+        checkLastChunks();
+        hasMorePermutations = std::ranges::next_permutation(
+                                  inputBuffers,
+                                  std::less{},
+                                  [](const TupleBuffer& buffer)
+                                  { return SequenceData(buffer.getSequenceNumber(), buffer.getChunkNumber(), buffer.isLastChunk()); })
+                                  .found;
+    };
+}
+
+TEST_F(EmitPhysicalOperatorTest, ConcurrentSequenceOrderTest)
+{
+    for (auto [numberOfSequences, maxChunksPerSequence, numberOfThreads] :
+         std::initializer_list<std::tuple<size_t, size_t, size_t>>{{2, 10, 2}, {1000, 2, 4}, {10, 100, 4}, {1000, 20, 10}})
+    {
+        reset();
+        std::vector<TupleBuffer> inputBuffers;
+        for (size_t seq = 0; seq < numberOfSequences; seq++)
+        {
+            std::uniform_int_distribution chunkNumbers(ChunkNumber::INITIAL + 1, maxChunksPerSequence);
+            auto maxChunkForThisSequence = chunkNumbers(rd);
+            for (size_t chunk = 0; chunk < maxChunkForThisSequence - 1; chunk++)
+            {
+                inputBuffers.emplace_back(createBuffer(SequenceNumber::INITIAL + seq, ChunkNumber::INITIAL + chunk, false));
+            }
+            inputBuffers.emplace_back(
+                createBuffer(SequenceNumber::INITIAL + seq, ChunkNumber::INITIAL + maxChunkForThisSequence - 1, true));
+        }
+
+        EmitPhysicalOperator emit = createUUT(true);
+        std::ranges::shuffle(inputBuffers, rd);
+        std::barrier<> barrier(static_cast<int>(numberOfThreads) + 1);
+        std::vector<std::jthread> threads;
+        threads.reserve(numberOfThreads);
+        for (size_t threadId = 0; threadId < numberOfThreads; threadId++)
+        {
+            threads.emplace_back(
+                [threadId, &inputBuffers, this, &emit, &barrier, numberOfThreads]()
+                {
+                    barrier.arrive_and_wait();
+                    for (size_t index = threadId; index < inputBuffers.size(); index += numberOfThreads)
+                    {
+                        run(
+                            [&](auto& executionContext, auto& recordBuffer)
+                            {
+                                emit.open(executionContext, recordBuffer);
+                                emit.close(executionContext, recordBuffer);
+                            },
+                            inputBuffers.at(index));
+                    }
+                });
+        }
+        barrier.arrive_and_wait();
+        threads.clear();
+
+        checkNumberOfBuffers(inputBuffers.size());
+        checkSequenceOrder();
+        checkForDups();
+        checkLastChunks();
+    }
+}
+
+/// Tests if a coalescing handler merges the small buffers of all permutations of the inputs into a single buffer while the task queue is
+/// backlogged. Otherwise, it only merges the buffers that it releases at once. In both cases, it numbers its buffers densely and emits
+/// all records in order.
+TEST_F(EmitPhysicalOperatorTest, CoalescingTest)
+{
+    constexpr uint64_t NumberOfInputs = 6;
+    constexpr uint64_t RecordsPerInput = 3;
+    std::vector<TupleBuffer> inputBuffers;
+    for (uint64_t input = 0; input < NumberOfInputs; ++input)
+    {
+        inputBuffers.emplace_back(createBuffer(SequenceNumber::INITIAL + input, ChunkNumber::INITIAL, true));
+    }
+    std::vector<uint64_t> expectedValues(NumberOfInputs * RecordsPerInput);
+    std::ranges::iota(expectedValues, 0);
+    const auto toSequenceData = [](const TupleBuffer& buffer)
+    { return SequenceData(buffer.getSequenceNumber(), buffer.getChunkNumber(), buffer.isLastChunk()); };
+
+    for (const auto memoryLayoutType : {MemoryLayoutType::ROW_LAYOUT, MemoryLayoutType::COLUMNAR_LAYOUT})
+    {
+        std::ranges::sort(inputBuffers, {}, &TupleBuffer::getSequenceNumber);
+        bool isInOrder = true;
+        bool hasMorePermutations = true;
+        while (hasMorePermutations)
+        {
+            for (const bool isBacklogged : {true, false})
+            {
+                reset();
+                numberOfQueuedTasks = isBacklogged ? 1 : 0;
+                numberOfSubmittedTasks = NumberOfInputs;
+                const auto emit = createCoalescingUUT(memoryLayoutType, std::chrono::hours(1));
+                emitRecords(emit, inputBuffers, RecordsPerInput);
+
+                if (isBacklogged)
+                {
+                    checkNumberOfBuffers(1);
+                }
+                else if (isInOrder)
+                {
+                    checkNumberOfBuffers(NumberOfInputs);
+                }
+                const auto sequences = (*buffers.rlock()) | std::views::transform(toSequenceData) | std::ranges::to<std::vector>();
+                for (size_t index = 0; index < sequences.size(); ++index)
+                {
+                    EXPECT_EQ(sequences[index], SequenceData(SequenceNumber(SequenceNumber::INITIAL + index), INITIAL<ChunkNumber>, true));
+                }
+                EXPECT_EQ(readEmittedValues(), expectedValues);
+            }
+            isInOrder = false;
+            hasMorePermutations = std::ranges::next_permutation(inputBuffers, {}, &TupleBuffer::getSequenceNumber).found;
+        }
+    }
+}
+
+/// Tests if a coalescing handler emits the coalesced buffer of an origin once it exceeds the latency bound, although further inputs are
+/// pending. The input of another origin triggers the check.
+TEST_F(EmitPhysicalOperatorTest, CoalescingLatencyBoundTest)
+{
+    numberOfQueuedTasks = 1;
+    numberOfSubmittedTasks = 100;
+    const auto emit = createCoalescingUUT(MemoryLayoutType::ROW_LAYOUT, std::chrono::milliseconds(50));
+    emitRecords(emit, {createBuffer(SequenceNumber::INITIAL, ChunkNumber::INITIAL, true)}, 2);
+    checkNumberOfBuffers(0);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    emitRecords(emit, {createBuffer(SequenceNumber::INITIAL, ChunkNumber::INITIAL, true, OriginId(OriginId::INITIAL + 1))}, 2);
+    checkNumberOfBuffers(1);
+    checkBufferAt(0, SequenceNumber::INITIAL, ChunkNumber::INITIAL, true, INITIAL<OriginId>, 2);
+}
+
+/// Tests if an emit that shares variable sized data references the child buffer of its input instead of copying the values, unless its
+/// buffer references too few bytes of the child buffer, in which case it compacts the referenced values into a new child buffer
+TEST_F(EmitPhysicalOperatorTest, VarSizedSharingTest)
+{
+    /// The last value is short enough to be inlined in its access
+    const std::vector<std::string> values{"the first value", "the second value", "the third value", "the fourth value", "inlined"};
+    const auto input = createVarSizedInput(values);
+    ASSERT_EQ(input.getNumberOfChildBuffers(), 1);
+    const auto* inputChildMemory = input.loadChildBuffer(VariableSizedAccess::Index{0}).getAvailableMemoryArea().data();
+
+    const auto sharingEmit = createVarSizedSharingUUT(50);
+    emitVarSizedRecords(sharingEmit, input, values.size());
+    checkNumberOfBuffers(1);
+    {
+        const auto emitted = buffers.rlock()->front();
+        ASSERT_EQ(emitted.getNumberOfChildBuffers(), 1);
+        EXPECT_EQ(emitted.loadChildBuffer(VariableSizedAccess::Index{0}).getAvailableMemoryArea().data(), inputChildMemory);
+        EXPECT_EQ(readEmittedText(emitted), values);
+    }
+
+    /// The first value covers less than half of the bytes of the child buffer
+    reset();
+    const auto compactingEmit = createVarSizedSharingUUT(50);
+    emitVarSizedRecords(compactingEmit, input, 1);
+    checkNumberOfBuffers(1);
+    const auto emitted = buffers.rlock()->front();
+    ASSERT_EQ(emitted.getNumberOfChildBuffers(), 1);
+    const auto compactedChild = emitted.loadChildBuffer(VariableSizedAccess::Index{0});
+    EXPECT_NE(compactedChild.getAvailableMemoryArea().data(), inputChildMemory);
+    EXPECT_EQ(compactedChild.getNumberOfTuples(), values.front().size());
+    EXPECT_EQ(readEmittedText(emitted), std::vector{values.front()});
+}
 }
@@ -0,0 +1,256 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <FormatPhysicalOperator.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Identifiers/NESStrongType.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/DataTypes/VariableSizedData.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Nautilus/Interface/RecordBuffer.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/BufferManager.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sinks/SinkDescriptor.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <nautilus/val.hpp>
+
+#include <BaseUnitTest.hpp>
+#include <EmitOperatorHandler.hpp>
+#include <ErrorHandling.hpp>
+#include <ExecutionContext.hpp>
+#include <PipelineExecutionContext.hpp>
+
+namespace NES
+{
+
+class FormatPhysicalOperatorTest : public Testing::BaseUnitTest
+{
+    struct MockedPipelineContext final : PipelineExecutionContext
+    {
+        bool emitBuffer(TupleBuffer buffer, ContinuationPolicy) override
+        {
+            buffers.emplace_back(std::move(buffer));
+            return true;
+        }
+
+        TupleBuffer allocateTupleBuffer() override { return bufferManager->getBufferBlocking(); }
+
+        TupleBuffer& pinBuffer(TupleBuffer&& tupleBuffer) override
+        {
+            pinnedBuffers.emplace_back(std::make_unique<TupleBuffer>(tupleBuffer));
+            return *pinnedBuffers.back();
+        }
+
+        [[nodiscard]] WorkerThreadId getId() const override { return INITIAL<WorkerThreadId>; }
+
+        [[nodiscard]] uint64_t getNumberOfWorkerThreads() const override { return 1; }
+
+        [[nodiscard]] std::shared_ptr<AbstractBufferProvider> getBufferManager() const override { return bufferManager; }
+
+        [[nodiscard]] PipelineId getPipelineId() const override { return PipelineId(1); }
+
+        std::unordered_map<OperatorHandlerId, std::shared_ptr<OperatorHandler>>& getOperatorHandlers() override
+        {
+            return *operatorHandlers;
+        }
+
+        void setOperatorHandlers(std::unordered_map<OperatorHandlerId, std::shared_ptr<OperatorHandler>>& opHandlers) override
+        {
+            operatorHandlers = &opHandlers;
+        }
+
+        MockedPipelineContext(std::vector<TupleBuffer>& buffers, std::shared_ptr<BufferManager> bufferManager)
+            : buffers(buffers), bufferManager(std::move(bufferManager))
+        {
+        }
+
+        void repeatTask(const TupleBuffer&, std::chrono::milliseconds) override { INVARIANT(false, "This function should not be called"); }
+
+        ///NOLINTNEXTLINE(cppcoreguidelines-avoid-const-or-ref-data-members) lifetime is ensured by the `run` method.
+        std::vector<TupleBuffer>& buffers;
+        std::shared_ptr<BufferManager> bufferManager;
+        std::unordered_map<OperatorHandlerId, std::shared_ptr<OperatorHandler>>* operatorHandlers = nullptr;
+        std::vector<std::unique_ptr<TupleBuffer>> pinnedBuffers;
+    };
+
+public:
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("FormatPhysicalOperatorTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup FormatPhysicalOperatorTest test class.");
+    }
+
+    FormatPhysicalOperator createUUT(const Schema& schema, const InputFormat format)
+    {
+        handlers.insert_or_assign(OperatorHandlerId(0), std::make_shared<EmitOperatorHandler>());
+        return FormatPhysicalOperator{OperatorHandlerId(0), schema, format, bufferSize};
+    }
+
+    /// Formats the records of a single input buffer that completes its sequence number
+    void run(const FormatPhysicalOperator& format, const std::function<void(const std::function<void(Record&)>&)>& produceRecords)
+    {
+        auto buffer = bm->getBufferBlocking();
+        buffer.setSequenceNumber(INITIAL<SequenceNumber>);
+        buffer.setChunkNumber(INITIAL<ChunkNumber>);
+        buffer.setLastChunk(true);
+        buffer.setOriginId(INITIAL<OriginId>);
+
+        MockedPipelineContext pec{buffers, bm};
+        pec.setOperatorHandlers(handlers);
+        Arena arena(bm);
+        ExecutionContext executionContext{&pec, &arena};
+        executionContext.chunkNumber = buffer.getChunkNumber();
+        executionContext.sequenceNumber = buffer.getSequenceNumber();
+        executionContext.lastChunk = buffer.isLastChunk();
+        executionContext.originId = buffer.getOriginId();
+
+        RecordBuffer recordBuffer(std::addressof(buffer));
+        format.open(executionContext, recordBuffer);
+        produceRecords([&](Record& record) { format.execute(executionContext, record); });
+        format.close(executionContext, recordBuffer);
+    }
+
+    static nautilus::val<int8_t*> toVarSizedReference(std::string& value)
+    {
+        return {reinterpret_cast<int8_t*>(value.data())}; ///NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+
+    [[nodiscard]] std::string formattedRows() const
+    {
+        std::string rows;
+        for (const auto& buffer : buffers)
+        {
+            rows.append(buffer.getAvailableMemoryArea<char>().data(), buffer.getNumberOfTuples());
+        }
+        return rows;
+    }
+
+    static constexpr uint64_t bufferSize = 64;
+    std::vector<TupleBuffer> buffers;
+    std::shared_ptr<BufferManager> bm = BufferManager::create(bufferSize, 1000);
+    std::unordered_map<OperatorHandlerId, std::shared_ptr<OperatorHandler>> handlers;
+};
+
+TEST_F(FormatPhysicalOperatorTest, FormatsCSVRows)
+{
+    const auto schema = Schema{}
+                            .addField("id", DataType::Type::INT32)
+                            .addField("value", DataType::Type::FLOAT64)
+                            .addField("flag", DataType::Type::BOOLEAN)
+                            .addField("optional", DataType::Type::UINT64, DataType::NULLABLE::IS_NULLABLE);
+    const auto format = createUUT(schema, InputFormat::CSV);
+
+    run(format,
+        [](const auto& execute)
+        {
+            Record first;
+            first.write("id", VarVal(nautilus::val<int32_t>(-7)));
+            first.write("value", VarVal(nautilus::val<double>(1.25)));
+            first.write("flag", VarVal(nautilus::val<bool>(true)));
+            first.write("optional", VarVal(nautilus::val<uint64_t>(42), true, nautilus::val<bool>(false)));
+            execute(first);
+
+            Record second;
+            second.write("id", VarVal(nautilus::val<int32_t>(3)));
+            second.write("value", VarVal(nautilus::val<double>(2.0)));
+            second.write("flag", VarVal(nautilus::val<bool>(false)));
+            second.write("optional", VarVal(nautilus::val<uint64_t>(0), true, nautilus::val<bool>(true)));
+            execute(second);
+        });
+
+    ASSERT_EQ(buffers.size(), 1);
+    EXPECT_TRUE(buffers.front().isLastChunk());
+    EXPECT_EQ(formattedRows(), "-7,1.25,1,42\n3,2.0,0,NULL\n");
+}
+
+TEST_F(FormatPhysicalOperatorTest, FormatsJSONRows)
+{
+    const auto schema = Schema{}
+                            .addField("id", DataType::Type::UINT8, DataType::NULLABLE::IS_NULLABLE)
+                            .addField("name", DataType::Type::VARSIZED);
+    const auto format = createUUT(schema, InputFormat::JSON);
+
+    std::string name = "nebula";
+    run(format,
+        [&](const auto& execute)
+        {
+            const VariableSizedData nameValue{toVarSizedReference(name), nautilus::val<uint64_t>(name.size())};
+            Record first;
+            first.write("id", VarVal(nautilus::val<uint8_t>(1), true, nautilus::val<bool>(false)));
+            first.write("name", VarVal(nameValue));
+            execute(first);
+
+            Record second;
+            second.write("id", VarVal(nautilus::val<uint8_t>(0), true, nautilus::val<bool>(true)));
+            second.write("name", VarVal(nameValue));
+            execute(second);
+        });
+
+    /// Like the JSONFormat of the sinks, a NULL value is formatted without its key
+    EXPECT_EQ(formattedRows(), "{\"id\":1,\"name\":\"nebula\"}\n{NULL,\"name\":\"nebula\"}\n");
+}
+
+/// Rows must not span buffers, since the sink may write the buffers of a sequence number in any order
+TEST_F(FormatPhysicalOperatorTest, EmitsCompleteRowsPerBuffer)
+{
+    const auto schema = Schema{}.addField("id", DataType::Type::UINT64).addField("text", DataType::Type::VARSIZED);
+    const auto format = createUUT(schema, InputFormat::CSV);
+
+    std::string shortText(10, 'a');
+    std::string longText(2 * bufferSize, 'b');
+    std::string expectedRows;
+    run(format,
+        [&](const auto& execute)
+        {
+            for (uint64_t id = 0; id < 20; ++id)
+            {
+                auto& text = id == 7 ? longText : shortText;
+                expectedRows += std::to_string(id) + "," + text + "\n";
+                Record record;
+                record.write("id", VarVal(nautilus::val<uint64_t>(id)));
+                record.write("text", VarVal(VariableSizedData{toVarSizedReference(text), nautilus::val<uint64_t>(text.size())}));
+                execute(record);
+            }
+        });
+
+    ASSERT_GT(buffers.size(), 1);
+    EXPECT_EQ(formattedRows(), expectedRows);
+    for (size_t index = 0; index < buffers.size(); ++index)
+    {
+        const auto& buffer = buffers[index];
+        const std::string rows(buffer.getAvailableMemoryArea<char>().data(), buffer.getNumberOfTuples());
+        EXPECT_TRUE(rows.empty() or rows.back() == '\n') << "Buffer " << index << " ends within a row";
+        EXPECT_TRUE(rows.size() <= bufferSize or rows.find('\n') == rows.size() - 1) << "Only a single row may exceed a buffer";
+        EXPECT_EQ(buffer.getChunkNumber(), ChunkNumber(ChunkNumber::INITIAL + index));
+        EXPECT_EQ(buffer.isLastChunk(), index == buffers.size() - 1);
+    }
+}
+
+}
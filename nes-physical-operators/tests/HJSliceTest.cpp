@@ -0,0 +1,214 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+#include <Join/HashJoin/HJSlice.hpp>
+#include <Join/StreamJoinUtil.hpp>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMap.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Nautilus/Interface/PagedVector/PagedVector.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <Util/RollingAverage.hpp>
+#include <gtest/gtest.h>
+#include <HashMapSlice.hpp>
+#include <HashMapSliceTestUtil.hpp>
+
+namespace NES
+{
+
+class HJSliceTest : public Testing::HashMapSliceTest
+{
+public:
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("HJSliceTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup HJSliceTest test class.");
+    }
+
+    /// One input stream per side of the join
+    static CreateNewHashMapSliceArgs createArgs() { return Testing::createHashMapSliceArgs(2); }
+};
+
+TEST_F(HJSliceTest, OneHashMapPerWorkerThreadPartitionAndSide)
+{
+    HJSlice slice{SliceStart(0), SliceEnd(10), createArgs(), NUMBER_OF_WORKER_THREADS, NUMBER_OF_PARTITIONS};
+    EXPECT_EQ(slice.getNumberOfPartitions(), NUMBER_OF_PARTITIONS);
+    EXPECT_EQ(slice.getNumberOfHashMapsForSide(), NUMBER_OF_WORKER_THREADS * NUMBER_OF_PARTITIONS);
+
+    std::set<HashMap*> allHashMaps;
+    for (const auto buildSide : {JoinBuildSideType::Left, JoinBuildSideType::Right})
+    {
+        for (uint64_t workerThread = 0; workerThread < NUMBER_OF_WORKER_THREADS; ++workerThread)
+        {
+            for (uint64_t partition = 0; partition < NUMBER_OF_PARTITIONS; ++partition)
+            {
+                auto* hashMap = slice.getHashMapPtrOrCreate(WorkerThreadId(workerThread), buildSide, partition);
+                ASSERT_NE(hashMap, nullptr);
+                EXPECT_EQ(slice.getHashMapPtr(WorkerThreadId(workerThread), buildSide, partition), hashMap);
+                allHashMaps.emplace(hashMap);
+            }
+        }
+    }
+    EXPECT_EQ(allHashMaps.size(), 2 * NUMBER_OF_WORKER_THREADS * NUMBER_OF_PARTITIONS);
+}
+
+TEST_F(HJSliceTest, HashMapsOfPartition)
+{
+    HJSlice slice{SliceStart(0), SliceEnd(10), createArgs(), NUMBER_OF_WORKER_THREADS, NUMBER_OF_PARTITIONS};
+    auto* firstWorkerHashMap = slice.getHashMapPtrOrCreate(WorkerThreadId(0), JoinBuildSideType::Right, 2);
+    auto* lastWorkerHashMap = slice.getHashMapPtrOrCreate(WorkerThreadId(NUMBER_OF_WORKER_THREADS - 1), JoinBuildSideType::Right, 2);
+
+    EXPECT_EQ(
+        slice.getHashMapPtrsOfPartition(JoinBuildSideType::Right, 2),
+        (std::vector<HashMap*>{firstWorkerHashMap, nullptr, lastWorkerHashMap}));
+    EXPECT_EQ(slice.getHashMapPtrsOfPartition(JoinBuildSideType::Left, 2), (std::vector<HashMap*>(NUMBER_OF_WORKER_THREADS, nullptr)));
+    EXPECT_EQ(
+        slice.getHashMapPtrsOfPartition(JoinBuildSideType::Right, 1), (std::vector<HashMap*>(NUMBER_OF_WORKER_THREADS, nullptr)));
+}
+
+/// Without partitioning, a slice has one hash map per worker thread and side
+TEST_F(HJSliceTest, SinglePartition)
+{
+    HJSlice slice{SliceStart(0), SliceEnd(10), createArgs(), NUMBER_OF_WORKER_THREADS};
+    EXPECT_EQ(slice.getNumberOfPartitions(), 1);
+    EXPECT_EQ(slice.getNumberOfHashMapsForSide(), NUMBER_OF_WORKER_THREADS);
+    auto* hashMap = slice.getHashMapPtrOrCreate(WorkerThreadId(NUMBER_OF_WORKER_THREADS + 1), JoinBuildSideType::Left);
+    EXPECT_EQ(slice.getHashMapPtr(WorkerThreadId(1), JoinBuildSideType::Left), hashMap);
+    EXPECT_EQ(slice.getHashMapPtrsOfPartition(JoinBuildSideType::Left, 0).size(), NUMBER_OF_WORKER_THREADS);
+}
+
+/// Each worker thread counts the records of its own hash maps, while the trigger sums them up per partition
+TEST_F(HJSliceTest, NumberOfRecordsPerPartition)
+{
+    HJSlice slice{SliceStart(0), SliceEnd(10), createArgs(), NUMBER_OF_WORKER_THREADS, NUMBER_OF_PARTITIONS};
+    for (uint64_t workerThread = 0; workerThread < NUMBER_OF_WORKER_THREADS; ++workerThread)
+    {
+        for (uint64_t record = 0; record <= workerThread; ++record)
+        {
+            slice.addRecord(WorkerThreadId(workerThread), JoinBuildSideType::Right, NUMBER_OF_PARTITIONS - 1);
+        }
+    }
+    slice.addRecord(WorkerThreadId(NUMBER_OF_WORKER_THREADS), JoinBuildSideType::Left, 0);
+
+    EXPECT_EQ(slice.getNumberOfRecords(WorkerThreadId(0), JoinBuildSideType::Right, NUMBER_OF_PARTITIONS - 1), 1);
+    EXPECT_EQ(slice.getNumberOfRecords(WorkerThreadId(2), JoinBuildSideType::Right, NUMBER_OF_PARTITIONS - 1), 3);
+    EXPECT_EQ(slice.getNumberOfRecords(WorkerThreadId(0), JoinBuildSideType::Left, 0), 1);
+    EXPECT_EQ(slice.getNumberOfRecordsOfPartition(JoinBuildSideType::Right, NUMBER_OF_PARTITIONS - 1), 6);
+    EXPECT_EQ(slice.getNumberOfRecordsOfPartition(JoinBuildSideType::Left, NUMBER_OF_PARTITIONS - 1), 0);
+    EXPECT_EQ(slice.getNumberOfRecordsOfPartition(JoinBuildSideType::Right, 0), 0);
+    EXPECT_EQ(slice.getNumberOfRecordsOfPartition(JoinBuildSideType::Left, 0), 1);
+}
+
+/// The hash maps of each build side are sized after the number of keys of the same side of recent slices
+TEST_F(HJSliceTest, NumberOfBucketsPerBuildSide)
+{
+    auto args = createArgs();
+    args.numberOfBucketsPerInputStream = {1024, 16};
+    HJSlice slice{SliceStart(0), SliceEnd(10), args, NUMBER_OF_WORKER_THREADS};
+    const auto* leftHashMap = dynamic_cast<ChainedHashMap*>(slice.getHashMapPtrOrCreate(WorkerThreadId(0), JoinBuildSideType::Left));
+    const auto* rightHashMap = dynamic_cast<ChainedHashMap*>(slice.getHashMapPtrOrCreate(WorkerThreadId(0), JoinBuildSideType::Right));
+    ASSERT_NE(leftHashMap, nullptr);
+    ASSERT_NE(rightHashMap, nullptr);
+    EXPECT_GT(leftHashMap->getNumberOfChains(), rightHashMap->getNumberOfChains());
+}
+
+/// Until the handler observed a slice, new hash maps keep the configured number of buckets
+TEST_F(HJSliceTest, NumberOfBucketsOfObservedKeys)
+{
+    RollingAverage<uint64_t> observedNumberOfKeys(10);
+    EXPECT_EQ(getNumberOfBucketsOfObservedKeys(observedNumberOfKeys, 16, 1000), 16);
+    observedNumberOfKeys.add(200);
+    observedNumberOfKeys.add(400);
+    EXPECT_EQ(getNumberOfBucketsOfObservedKeys(observedNumberOfKeys, 16, 1000), 300);
+    EXPECT_EQ(getNumberOfBucketsOfObservedKeys(observedNumberOfKeys, 16, 100), 100);
+}
+
+/// The bloom filter is sized for the expected number of keys of all left hash maps, i.e., the number of buckets per hash map
+TEST_F(HJSliceTest, LeftBloomFilter)
+{
+    const HJSlice sliceWithoutBloomFilter{SliceStart(0), SliceEnd(10), createArgs(), NUMBER_OF_WORKER_THREADS, NUMBER_OF_PARTITIONS};
+    EXPECT_EQ(sliceWithoutBloomFilter.getLeftBloomFilter(), nullptr);
+
+    constexpr uint64_t bitsPerKey = 16;
+    const HJSlice slice{SliceStart(0), SliceEnd(10), createArgs(), NUMBER_OF_WORKER_THREADS, NUMBER_OF_PARTITIONS, bitsPerKey};
+    auto* bloomFilter = slice.getLeftBloomFilter();
+    ASSERT_NE(bloomFilter, nullptr);
+    EXPECT_EQ(bloomFilter->getNumberOfWords(), 64);
+    bloomFilter->insert(42);
+    EXPECT_TRUE(bloomFilter->mayContain(42));
+}
+
+/// With late materialization, every hash map has its own rows, which the slice creates once
+TEST_F(HJSliceTest, OneRowsPerHashMap)
+{
+    HJSlice slice{SliceStart(0), SliceEnd(10), createArgs(), NUMBER_OF_WORKER_THREADS, NUMBER_OF_PARTITIONS};
+    std::set<PagedVector*> allRows;
+    for (const auto buildSide : {JoinBuildSideType::Left, JoinBuildSideType::Right})
+    {
+        for (uint64_t workerThread = 0; workerThread < NUMBER_OF_WORKER_THREADS; ++workerThread)
+        {
+            for (uint64_t partition = 0; partition < NUMBER_OF_PARTITIONS; ++partition)
+            {
+                auto* rows = slice.getRowsPtrOrCreate(WorkerThreadId(workerThread), buildSide, partition);
+                ASSERT_NE(rows, nullptr);
+                EXPECT_EQ(rows->getTotalNumberOfEntries(), 0);
+                EXPECT_EQ(slice.getRowsPtrOrCreate(WorkerThreadId(workerThread), buildSide, partition), rows);
+                allRows.emplace(rows);
+            }
+        }
+    }
+    EXPECT_EQ(allRows.size(), 2 * NUMBER_OF_WORKER_THREADS * NUMBER_OF_PARTITIONS);
+}
+
+/// The streamed side of an asymmetric hash join only creates rows, thus, the slice creates no hash maps for it
+TEST_F(HJSliceTest, StreamedSideHasRowsButNoHashMaps)
+{
+    HJSlice slice{SliceStart(0), SliceEnd(10), createArgs(), NUMBER_OF_WORKER_THREADS};
+    auto* rows = slice.getRowsPtrOrCreate(WorkerThreadId(1), JoinBuildSideType::Right);
+    auto* hashMap = slice.getHashMapPtrOrCreate(WorkerThreadId(1), JoinBuildSideType::Left);
+
+    const auto rightRows = slice.getRowsPtrsOfPartition(JoinBuildSideType::Right, 0);
+    ASSERT_EQ(rightRows.size(), NUMBER_OF_WORKER_THREADS);
+    EXPECT_EQ(rightRows, (std::vector<PagedVector*>{nullptr, rows, nullptr}));
+    EXPECT_EQ(slice.getRowsPtrsOfPartition(JoinBuildSideType::Left, 0), (std::vector<PagedVector*>(NUMBER_OF_WORKER_THREADS, nullptr)));
+    EXPECT_EQ(slice.getHashMapPtrsOfPartition(JoinBuildSideType::Left, 0), (std::vector<HashMap*>{nullptr, hashMap, nullptr}));
+    EXPECT_EQ(slice.getHashMapPtrsOfPartition(JoinBuildSideType::Right, 0), (std::vector<HashMap*>(NUMBER_OF_WORKER_THREADS, nullptr)));
+}
+
+/// The hash maps of a destroyed slice are reused by the next slice, if they have the same number of chains
+TEST_F(HJSliceTest, HashMapsOfDestroyedSlicesAreReused)
+{
+    auto args = createArgs();
+    args.hashMapPool = std::make_shared<HashMapPool>();
+    HashMap* hashMapOfFirstSlice = nullptr;
+    {
+        HJSlice slice{SliceStart(0), SliceEnd(10), args, NUMBER_OF_WORKER_THREADS};
+        hashMapOfFirstSlice = slice.getHashMapPtrOrCreate(WorkerThreadId(0), JoinBuildSideType::Left);
+    }
+    EXPECT_EQ(args.hashMapPool->getNumberOfHashMaps(), 1);
+
+    args.numberOfBucketsPerInputStream = {1024, 16};
+    HJSlice slice{SliceStart(10), SliceEnd(20), args, NUMBER_OF_WORKER_THREADS};
+    EXPECT_NE(slice.getHashMapPtrOrCreate(WorkerThreadId(0), JoinBuildSideType::Left), hashMapOfFirstSlice);
+    EXPECT_EQ(slice.getHashMapPtrOrCreate(WorkerThreadId(0), JoinBuildSideType::Right), hashMapOfFirstSlice);
+    EXPECT_EQ(args.hashMapPool->getNumberOfHashMaps(), 0);
+}
+
+}
@@ -0,0 +1,113 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cmath>
+#include <cstdint>
+#include <Aggregation/Function/HyperLogLog.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+namespace NES
+{
+
+class HyperLogLogTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("HyperLogLogTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup HyperLogLogTest test class.");
+    }
+
+    /// The sketch expects uniformly distributed hashes, thus we mix the values with the finalizer of MurmurHash3
+    static uint64_t hash(uint64_t value)
+    {
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdULL;
+        value ^= value >> 33;
+        value *= 0xc4ceb9fe1a85ec53ULL;
+        value ^= value >> 33;
+        return value;
+    }
+
+    static double relativeError(const uint64_t estimate, const uint64_t expected)
+    {
+        return std::abs(static_cast<double>(estimate) - static_cast<double>(expected)) / static_cast<double>(expected);
+    }
+};
+
+TEST_F(HyperLogLogTest, EmptySketchEstimatesZero)
+{
+    const HyperLogLog sketch;
+    EXPECT_EQ(sketch.estimate(), 0);
+}
+
+TEST_F(HyperLogLogTest, SmallCardinalitiesAreExact)
+{
+    HyperLogLog sketch;
+    for (uint64_t repetition = 0; repetition < 3; ++repetition)
+    {
+        for (uint64_t value = 0; value < 10; ++value)
+        {
+            sketch.add(hash(value));
+        }
+    }
+    EXPECT_EQ(sketch.estimate(), 10);
+}
+
+TEST_F(HyperLogLogTest, LargeCardinalitiesWithinErrorBound)
+{
+    for (const uint64_t numberOfDistinctValues : {1000UL, 100000UL, 1000000UL})
+    {
+        HyperLogLog sketch;
+        for (uint64_t value = 0; value < numberOfDistinctValues; ++value)
+        {
+            sketch.add(hash(value));
+            sketch.add(hash(value / 2));
+        }
+        /// The standard error is about 1.6%, we allow three times the standard error
+        EXPECT_LT(relativeError(sketch.estimate(), numberOfDistinctValues), 0.05) << numberOfDistinctValues;
+    }
+}
+
+TEST_F(HyperLogLogTest, MergeEstimatesUnion)
+{
+    HyperLogLog left;
+    HyperLogLog right;
+    for (uint64_t value = 0; value < 60000; ++value)
+    {
+        left.add(hash(value));
+    }
+    for (uint64_t value = 40000; value < 100000; ++value)
+    {
+        right.add(hash(value));
+    }
+    HyperLogLog merged = left;
+    merged.merge(right);
+    EXPECT_LT(relativeError(merged.estimate(), 100000), 0.05);
+
+    /// Merging is idempotent, i.e., merging the same sketch again does not change the estimate
+    const auto estimate = merged.estimate();
+    merged.merge(right);
+    EXPECT_EQ(merged.estimate(), estimate);
+
+    /// Merging an empty sketch does not change the estimate
+    merged.merge(HyperLogLog{});
+    EXPECT_EQ(merged.estimate(), estimate);
+}
+
+}
@@ -0,0 +1,118 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <Aggregation/Function/AggregationPhysicalFunction.hpp>
+#include <Aggregation/Function/MedianAggregationPhysicalFunction.hpp>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/DataTypeProvider.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/FieldAccessPhysicalFunction.hpp>
+#include <Nautilus/DataTypes/VarVal.hpp>
+#include <Nautilus/Interface/BufferRef/LowerSchemaProvider.hpp>
+#include <Nautilus/Interface/PagedVector/PagedVector.hpp>
+#include <Nautilus/Interface/Record.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/BufferManager.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <Arena.hpp>
+#include <BaseUnitTest.hpp>
+#include <ExecutionContext.hpp>
+#include <val.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+/// The test lifts the records directly into an aggregation state of a non-nullable FLOAT64 field, without a hash map
+class MedianAggregationPhysicalFunctionTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("MedianAggregationPhysicalFunctionTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup MedianAggregationPhysicalFunctionTest test class.");
+    }
+
+    void SetUp() override
+    {
+        BaseUnitTest::SetUp();
+        bufferManager = BufferManager::create();
+    }
+
+    MedianAggregationPhysicalFunction createMedian() const
+    {
+        const auto schema = Schema{}.addField("value", DataType::Type::FLOAT64);
+        return MedianAggregationPhysicalFunction{
+            DataTypeProvider::provideDataType(DataType::Type::FLOAT64),
+            DataTypeProvider::provideDataType(DataType::Type::FLOAT64, DataType::NULLABLE::IS_NULLABLE),
+            FieldAccessPhysicalFunction{"value"},
+            "median",
+            LowerSchemaProvider::lowerSchema(1024, schema, MemoryLayoutType::ROW_LAYOUT),
+            false};
+    }
+
+    /// Returns the median of the values, after resetting the state and lifting one record per value into it
+    VarVal lowerMedianOf(const std::vector<double>& values)
+    {
+        auto median = createMedian();
+        Arena arena{bufferManager};
+        PipelineMemoryProvider pipelineMemoryProvider{ArenaRef{&arena}, nautilus::val<AbstractBufferProvider*>(bufferManager.get())};
+        EXPECT_EQ(median.getSizeOfStateInBytes(), state.size());
+        /// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        const nautilus::val<AggregationState*> aggregationState(reinterpret_cast<AggregationState*>(state.data()));
+
+        median.reset(aggregationState, pipelineMemoryProvider);
+        for (const auto value : values)
+        {
+            median.lift(
+                aggregationState,
+                pipelineMemoryProvider,
+                Record{std::unordered_map<Record::RecordFieldIdentifier, VarVal>{{"value", VarVal{nautilus::val<double>{value}}}}});
+        }
+        const auto resultRecord = median.lower(aggregationState, pipelineMemoryProvider);
+        median.cleanup(aggregationState);
+        return resultRecord.read("median");
+    }
+
+    std::shared_ptr<BufferManager> bufferManager;
+    alignas(PagedVector) std::array<std::byte, sizeof(PagedVector)> state{};
+};
+
+TEST_F(MedianAggregationPhysicalFunctionTest, ReturnsTheMiddleValues)
+{
+    const auto oddMedian = lowerMedianOf({3, 1, 2});
+    EXPECT_EQ(oddMedian.isNull(), false);
+    EXPECT_EQ(oddMedian.getRawValueAs<nautilus::val<double>>(), 2.0);
+
+    const auto evenMedian = lowerMedianOf({4, 1, 3, 2});
+    EXPECT_EQ(evenMedian.isNull(), false);
+    EXPECT_EQ(evenMedian.getRawValueAs<nautilus::val<double>>(), 2.5);
+}
+
+/// A reset state without any lifted record, e.g., of an empty window, has no median
+TEST_F(MedianAggregationPhysicalFunctionTest, ReturnsNullForAnEmptyState)
+{
+    const auto median = lowerMedianOf({});
+    EXPECT_EQ(median.isNull(), true);
+}
+
+}
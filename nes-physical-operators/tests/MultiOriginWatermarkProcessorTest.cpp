@@ -0,0 +1,118 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+#include <Watermark/MultiOriginWatermarkProcessor.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+#include <Sequencing/SequenceData.hpp>
+#include <Time/Timestamp.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+namespace NES
+{
+
+class MultiOriginWatermarkProcessorTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("MultiOriginWatermarkProcessorTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup MultiOriginWatermarkProcessorTest class.");
+    }
+
+    static SequenceData sequence(const SequenceNumber::Underlying sequenceNumber)
+    {
+        return {SequenceNumber(sequenceNumber), INITIAL<ChunkNumber>, true};
+    }
+};
+
+TEST_F(MultiOriginWatermarkProcessorTest, WatermarkIsMinimumOverOrigins)
+{
+    const MultiOriginWatermarkProcessor processor({OriginId(1), OriginId(2), OriginId(3)});
+    EXPECT_EQ(processor.updateWatermark(Timestamp(10), sequence(1), OriginId(1)), Timestamp(0));
+    EXPECT_EQ(processor.updateWatermark(Timestamp(20), sequence(1), OriginId(3)), Timestamp(0));
+    EXPECT_EQ(processor.updateWatermark(Timestamp(5), sequence(1), OriginId(2)), Timestamp(5));
+    EXPECT_EQ(processor.updateWatermark(Timestamp(30), sequence(2), OriginId(2)), Timestamp(10));
+    EXPECT_EQ(processor.updateWatermark(Timestamp(15), sequence(2), OriginId(1)), Timestamp(15));
+    EXPECT_EQ(processor.getCurrentWatermark(), Timestamp(15));
+}
+
+/// Origin ids that spread over a large range are looked up via binary search instead of a table
+TEST_F(MultiOriginWatermarkProcessorTest, SparseOrigins)
+{
+    const MultiOriginWatermarkProcessor processor({OriginId(1000), OriginId(1), OriginId(50)});
+    EXPECT_EQ(processor.updateWatermark(Timestamp(3), sequence(1), OriginId(50)), Timestamp(0));
+    EXPECT_EQ(processor.updateWatermark(Timestamp(2), sequence(1), OriginId(1000)), Timestamp(0));
+    EXPECT_EQ(processor.updateWatermark(Timestamp(1), sequence(1), OriginId(1)), Timestamp(1));
+}
+
+/// The heartbeat of an idle origin raises its watermark to the minimum of the other origins, but never lowers it
+TEST_F(MultiOriginWatermarkProcessorTest, IdleOriginFollowsOtherOrigins)
+{
+    const Timestamp idle(Timestamp::IDLE_SOURCE_VALUE);
+    const MultiOriginWatermarkProcessor processor({OriginId(1), OriginId(2), OriginId(3)});
+    EXPECT_EQ(processor.updateWatermark(Timestamp(10), sequence(1), OriginId(1)), Timestamp(0));
+    EXPECT_EQ(processor.updateWatermark(Timestamp(20), sequence(1), OriginId(2)), Timestamp(0));
+    EXPECT_EQ(processor.updateWatermark(idle, sequence(1), OriginId(3)), Timestamp(10));
+    EXPECT_EQ(processor.updateWatermark(Timestamp(30), sequence(2), OriginId(1)), Timestamp(10));
+    EXPECT_EQ(processor.updateWatermark(idle, sequence(2), OriginId(3)), Timestamp(20));
+    EXPECT_EQ(processor.updateWatermark(Timestamp(40), sequence(2), OriginId(2)), Timestamp(20));
+    EXPECT_EQ(processor.updateWatermark(Timestamp(25), sequence(3), OriginId(3)), Timestamp(25));
+
+    /// Without other origins, the heartbeat keeps the watermark of the origin
+    const MultiOriginWatermarkProcessor singleOrigin({OriginId(1)});
+    EXPECT_EQ(singleOrigin.updateWatermark(Timestamp(10), sequence(1), OriginId(1)), Timestamp(10));
+    EXPECT_EQ(singleOrigin.updateWatermark(idle, sequence(2), OriginId(1)), Timestamp(10));
+}
+
+TEST_F(MultiOriginWatermarkProcessorTest, ConcurrentOrigins)
+{
+    constexpr size_t numberOfOrigins = 100;
+    constexpr size_t numberOfThreads = 8;
+    constexpr uint64_t numberOfBuffers = 1000;
+    std::vector<OriginId> origins;
+    for (size_t origin = 0; origin < numberOfOrigins; ++origin)
+    {
+        origins.emplace_back(INITIAL_ORIGIN_ID.getRawValue() + origin);
+    }
+    const MultiOriginWatermarkProcessor processor(origins);
+    {
+        std::vector<std::jthread> threads;
+        for (size_t thread = 0; thread < numberOfThreads; ++thread)
+        {
+            threads.emplace_back(
+                [&, thread]
+                {
+                    for (size_t origin = thread; origin < numberOfOrigins; origin += numberOfThreads)
+                    {
+                        for (uint64_t buffer = 1; buffer <= numberOfBuffers; ++buffer)
+                        {
+                            const auto watermark = processor.updateWatermark(Timestamp(buffer + origin), sequence(buffer), origins[origin]);
+                            EXPECT_LE(watermark, Timestamp(buffer + origin));
+                        }
+                    }
+                });
+        }
+    }
+    EXPECT_EQ(processor.getCurrentWatermark(), Timestamp(numberOfBuffers));
+}
+
+}
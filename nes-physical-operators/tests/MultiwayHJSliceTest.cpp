@@ -0,0 +1,75 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+#include <cstdint>
+#include <set>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+#include <Join/HashJoin/MultiwayHJSlice.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <HashMapSlice.hpp>
+#include <HashMapSliceTestUtil.hpp>
+
+namespace NES
+{
+
+class MultiwayHJSliceTest : public Testing::HashMapSliceTest
+{
+public:
+    static constexpr uint64_t NUMBER_OF_INPUTS = 4;
+
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("MultiwayHJSliceTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup MultiwayHJSliceTest test class.");
+    }
+
+    static CreateNewHashMapSliceArgs createArgs() { return Testing::createHashMapSliceArgs(NUMBER_OF_INPUTS); }
+};
+
+TEST_F(MultiwayHJSliceTest, OneHashMapPerWorkerThreadAndInput)
+{
+    MultiwayHJSlice slice{SliceStart(0), SliceEnd(10), createArgs(), NUMBER_OF_WORKER_THREADS, NUMBER_OF_INPUTS};
+    EXPECT_EQ(slice.getNumberOfInputs(), NUMBER_OF_INPUTS);
+
+    std::set<HashMap*> allHashMaps;
+    for (uint64_t input = 0; input < NUMBER_OF_INPUTS; ++input)
+    {
+        for (uint64_t workerThread = 0; workerThread < NUMBER_OF_WORKER_THREADS; ++workerThread)
+        {
+            auto* hashMap = slice.getHashMapPtrOrCreate(WorkerThreadId(workerThread), input);
+            ASSERT_NE(hashMap, nullptr);
+            EXPECT_EQ(slice.getHashMapPtr(WorkerThreadId(workerThread), input), hashMap);
+            allHashMaps.emplace(hashMap);
+        }
+    }
+    EXPECT_EQ(allHashMaps.size(), NUMBER_OF_INPUTS * NUMBER_OF_WORKER_THREADS);
+}
+
+TEST_F(MultiwayHJSliceTest, HashMapsOfInput)
+{
+    MultiwayHJSlice slice{SliceStart(0), SliceEnd(10), createArgs(), NUMBER_OF_WORKER_THREADS, NUMBER_OF_INPUTS};
+    auto* firstWorkerHashMap = slice.getHashMapPtrOrCreate(WorkerThreadId(0), 2);
+    /// Worker threads beyond the number of hash maps share the hash maps of the first worker threads
+    auto* sharedHashMap = slice.getHashMapPtrOrCreate(WorkerThreadId(NUMBER_OF_WORKER_THREADS + 2), 2);
+
+    EXPECT_EQ(slice.getHashMapPtrsOfInput(2), (std::vector<HashMap*>{firstWorkerHashMap, nullptr, sharedHashMap}));
+    EXPECT_EQ(slice.getHashMapPtrsOfInput(1), (std::vector<HashMap*>(NUMBER_OF_WORKER_THREADS, nullptr)));
+    EXPECT_EQ(slice.getHashMapPtrsOfInput(3), (std::vector<HashMap*>(NUMBER_OF_WORKER_THREADS, nullptr)));
+}
+
+}
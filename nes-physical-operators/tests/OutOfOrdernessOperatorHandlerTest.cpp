@@ -0,0 +1,80 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstdint>
+#include <Identifiers/Identifiers.hpp>
+#include <Time/Timestamp.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <Watermark/OutOfOrdernessOperatorHandler.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+namespace NES
+{
+
+class OutOfOrdernessOperatorHandlerTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("OutOfOrdernessOperatorHandlerTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup OutOfOrdernessOperatorHandlerTest class.");
+    }
+
+    static constexpr uint64_t MAX_BOUND = 1000;
+};
+
+/// Without disorder, the bound decays from the maximum bound to zero
+TEST_F(OutOfOrdernessOperatorHandlerTest, BoundDecaysWithoutDisorder)
+{
+    OutOfOrdernessOperatorHandler handler(MAX_BOUND);
+    auto previousBound = MAX_BOUND;
+    for (uint64_t buffer = 0; buffer < 200; ++buffer)
+    {
+        const auto bound = handler.updateBound(OriginId(1), Timestamp(buffer * 10), Timestamp((buffer * 10) + 9), 0);
+        EXPECT_LE(bound, previousBound);
+        previousBound = bound;
+    }
+    EXPECT_EQ(previousBound, 0);
+}
+
+TEST_F(OutOfOrdernessOperatorHandlerTest, BoundRisesToDisorder)
+{
+    OutOfOrdernessOperatorHandler handler(MAX_BOUND);
+    for (uint64_t buffer = 0; buffer < 200; ++buffer)
+    {
+        EXPECT_LE(handler.updateBound(OriginId(1), Timestamp(buffer * 10), Timestamp((buffer * 10) + 9), 0), MAX_BOUND);
+    }
+
+    /// The disorder within the buffer raises the bound right away
+    EXPECT_EQ(handler.updateBound(OriginId(1), Timestamp(2000), Timestamp(2500), 300), 300);
+    /// The disorder to the preceding buffers, which reached a timestamp of 2500, is smaller, thus the bound decays toward it
+    EXPECT_EQ(handler.updateBound(OriginId(1), Timestamp(2300), Timestamp(2600), 0), 300 - 7);
+    /// The bound never exceeds the maximum bound
+    EXPECT_EQ(handler.updateBound(OriginId(1), Timestamp(100), Timestamp(2700), 0), MAX_BOUND);
+}
+
+TEST_F(OutOfOrdernessOperatorHandlerTest, BoundPerOrigin)
+{
+    OutOfOrdernessOperatorHandler handler(MAX_BOUND);
+    EXPECT_EQ(handler.updateBound(OriginId(1), Timestamp(0), Timestamp(100), MAX_BOUND), MAX_BOUND);
+    EXPECT_EQ(handler.updateBound(OriginId(1), Timestamp(100), Timestamp(200), MAX_BOUND - 100), MAX_BOUND - 7);
+
+    /// The timestamps of the first origin do not count as disorder of the second one
+    EXPECT_EQ(handler.updateBound(OriginId(2), Timestamp(0), Timestamp(100), 0), MAX_BOUND - 63);
+}
+
+}
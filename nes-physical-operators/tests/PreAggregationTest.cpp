@@ -0,0 +1,174 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <Aggregation/AggregationSlice.hpp>
+#include <Aggregation/PreAggregation.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Runtime/BufferManager.hpp>
+#include <SliceStore/Slice.hpp>
+#include <Time/Timestamp.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+#include <HashMapSlice.hpp>
+#include <HashMapSliceTestUtil.hpp>
+
+namespace NES
+{
+
+/// Instead of aggregation states, the test counts the records that each hash map contains. Every record has its own key, unless the test
+/// aggregates multiple records into the same hash map in a row.
+class PreAggregationTest : public Testing::BaseUnitTest
+{
+public:
+    static constexpr uint64_t NUMBER_OF_WORKER_THREADS = 2;
+    static constexpr WorkerThreadId WORKER_THREAD{1};
+
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("PreAggregationTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup PreAggregationTest test class.");
+    }
+
+    void SetUp() override
+    {
+        Testing::BaseUnitTest::SetUp();
+        bufferManager = BufferManager::create();
+    }
+
+    /// The slices of the test never contain tuples, as the combine function solely counts the records
+    static CreateNewHashMapSliceArgs createArgs() { return Testing::createHashMapSliceArgs(); }
+
+    std::shared_ptr<AggregationSlice> createSlice(const uint64_t sliceStart, const uint64_t sliceEnd) const
+    {
+        return std::make_shared<AggregationSlice>(SliceStart(sliceStart), SliceEnd(sliceEnd), createArgs(), NUMBER_OF_WORKER_THREADS);
+    }
+
+    /// Aggregates a record with a new key into the hash map that the pre-aggregation returns for the slice
+    HashMap* aggregate(PreAggregation& preAggregation, const std::shared_ptr<AggregationSlice>& slice, const uint64_t timestamp)
+    {
+        auto* hashMap = preAggregation.tryGetHashMap(Timestamp(timestamp));
+        if (hashMap == nullptr)
+        {
+            hashMap = preAggregation.moveToSlice(slice, WORKER_THREAD, createArgs(), getCombineFunction(), getCleanupFunction());
+        }
+        if (hashMap != slice->getHashMapPtr(WORKER_THREAD))
+        {
+            static_cast<void>(hashMap->insertEntry(timestamp, bufferManager.get()));
+        }
+        ++recordsOfHashMap[hashMap];
+        return hashMap;
+    }
+
+    PreAggregation::CombineFunction getCombineFunction()
+    {
+        return [this](HashMap* destination, HashMap* source)
+        {
+            ++numberOfCombines;
+            recordsOfHashMap[destination] += recordsOfHashMap[source];
+        };
+    }
+
+    PreAggregation::CleanupFunction getCleanupFunction()
+    {
+        return [this](HashMap* hashMap) { recordsOfHashMap.erase(hashMap); };
+    }
+
+    std::shared_ptr<BufferManager> bufferManager;
+    std::map<HashMap*, uint64_t> recordsOfHashMap;
+    uint64_t numberOfCombines = 0;
+};
+
+TEST_F(PreAggregationTest, CombinesIntoSliceAtEndOfBuffer)
+{
+    PreAggregation preAggregation;
+    const auto slice = createSlice(0, 10);
+    auto* const preAggregationHashMap = aggregate(preAggregation, slice, 1);
+    EXPECT_NE(preAggregationHashMap, slice->getHashMapPtr(WORKER_THREAD));
+    EXPECT_EQ(aggregate(preAggregation, slice, 5), preAggregationHashMap);
+    EXPECT_EQ(numberOfCombines, 0);
+
+    preAggregation.combineIntoSlice(getCombineFunction(), getCleanupFunction());
+    EXPECT_EQ(numberOfCombines, 1);
+    EXPECT_EQ(recordsOfHashMap[slice->getHashMapPtr(WORKER_THREAD)], 2);
+    EXPECT_EQ(preAggregationHashMap->getNumberOfTuples(), 0);
+
+    /// Without any pre-aggregated keys, there is nothing to combine
+    preAggregation.combineIntoSlice(getCombineFunction(), getCleanupFunction());
+    EXPECT_EQ(numberOfCombines, 1);
+    EXPECT_EQ(preAggregation.tryGetHashMap(Timestamp(1)), nullptr);
+}
+
+TEST_F(PreAggregationTest, CombinesIntoSliceBeforeMovingToAnotherSlice)
+{
+    PreAggregation preAggregation;
+    const auto firstSlice = createSlice(0, 10);
+    const auto secondSlice = createSlice(10, 20);
+    aggregate(preAggregation, firstSlice, 9);
+    EXPECT_EQ(preAggregation.tryGetHashMap(Timestamp(10)), nullptr);
+
+    aggregate(preAggregation, secondSlice, 10);
+    EXPECT_EQ(numberOfCombines, 1);
+    EXPECT_EQ(recordsOfHashMap[firstSlice->getHashMapPtr(WORKER_THREAD)], 1);
+    EXPECT_EQ(recordsOfHashMap[secondSlice->getHashMapPtr(WORKER_THREAD)], 0);
+
+    preAggregation.combineIntoSlice(getCombineFunction(), getCleanupFunction());
+    EXPECT_EQ(recordsOfHashMap[secondSlice->getHashMapPtr(WORKER_THREAD)], 1);
+}
+
+/// A full pre-aggregation of distinct keys is bypassed for the rest of the buffer
+TEST_F(PreAggregationTest, BypassedForDistinctKeys)
+{
+    PreAggregation preAggregation;
+    const auto slice = createSlice(0, PreAggregation::MAX_NUMBER_OF_KEYS * 2);
+    for (uint64_t timestamp = 0; timestamp < PreAggregation::MAX_NUMBER_OF_KEYS; ++timestamp)
+    {
+        aggregate(preAggregation, slice, timestamp);
+    }
+    EXPECT_FALSE(preAggregation.isBypassed());
+    EXPECT_EQ(aggregate(preAggregation, slice, PreAggregation::MAX_NUMBER_OF_KEYS), slice->getHashMapPtr(WORKER_THREAD));
+    EXPECT_TRUE(preAggregation.isBypassed());
+    EXPECT_EQ(numberOfCombines, 1);
+    EXPECT_EQ(recordsOfHashMap[slice->getHashMapPtr(WORKER_THREAD)], PreAggregation::MAX_NUMBER_OF_KEYS + 1);
+
+    /// The next buffer pre-aggregates its records again
+    preAggregation.combineIntoSlice(getCombineFunction(), getCleanupFunction());
+    EXPECT_FALSE(preAggregation.isBypassed());
+    EXPECT_NE(aggregate(preAggregation, slice, 0), slice->getHashMapPtr(WORKER_THREAD));
+}
+
+/// A full pre-aggregation that folded enough records into its keys stays in use
+TEST_F(PreAggregationTest, NotBypassedForDuplicateKeys)
+{
+    PreAggregation preAggregation;
+    const auto slice = createSlice(0, PreAggregation::MAX_NUMBER_OF_KEYS * 2);
+    for (uint64_t timestamp = 0; timestamp < PreAggregation::MAX_NUMBER_OF_KEYS; ++timestamp)
+    {
+        aggregate(preAggregation, slice, timestamp);
+        /// Two more records of the key, which do not add a key to the hash map
+        static_cast<void>(preAggregation.tryGetHashMap(Timestamp(timestamp)));
+        static_cast<void>(preAggregation.tryGetHashMap(Timestamp(timestamp)));
+    }
+    EXPECT_NE(aggregate(preAggregation, slice, PreAggregation::MAX_NUMBER_OF_KEYS), slice->getHashMapPtr(WORKER_THREAD));
+    EXPECT_FALSE(preAggregation.isBypassed());
+    EXPECT_EQ(numberOfCombines, 1);
+}
+
+}
@@ -0,0 +1,154 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+#include <Aggregation/Function/QuantileSketches.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+namespace NES
+{
+
+class QuantileSketchesTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("QuantileSketchesTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup QuantileSketchesTest test class.");
+    }
+
+    /// Returns the fraction of values that are smaller than the estimate, i.e., the quantile of the estimate in the sorted values
+    static double getRank(const std::vector<double>& sortedValues, const double estimate)
+    {
+        const auto numberOfSmallerValues = std::ranges::lower_bound(sortedValues, estimate) - sortedValues.begin();
+        return static_cast<double>(numberOfSmallerValues) / static_cast<double>(sortedValues.size());
+    }
+
+    static std::vector<double> createLogNormalValues(const size_t numberOfValues)
+    {
+        std::mt19937_64 generator(42); /// NOLINT(cert-msc51-cpp) deterministic seed for reproducible tests
+        std::lognormal_distribution<double> distribution(0, 1);
+        std::vector<double> values(numberOfValues);
+        std::ranges::generate(values, [&] { return distribution(generator); });
+        return values;
+    }
+};
+
+TEST_F(QuantileSketchesTest, SmallInputsAreExact)
+{
+    TDigest tDigest;
+    KllSketch kllSketch;
+    for (const auto value : {3.0, 1.0, 5.0, 2.0, 4.0})
+    {
+        tDigest.add(value);
+        kllSketch.add(value);
+    }
+    EXPECT_DOUBLE_EQ(tDigest.quantile(0), 1);
+    EXPECT_DOUBLE_EQ(tDigest.quantile(0.5), 3);
+    EXPECT_DOUBLE_EQ(tDigest.quantile(1), 5);
+    EXPECT_DOUBLE_EQ(kllSketch.quantile(0), 1);
+    EXPECT_DOUBLE_EQ(kllSketch.quantile(0.5), 3);
+    EXPECT_DOUBLE_EQ(kllSketch.quantile(1), 5);
+    EXPECT_EQ(kllSketch.getNumberOfValues(), 5);
+    EXPECT_DOUBLE_EQ(tDigest.getTotalWeight(), 5);
+}
+
+/// The sketches are allocated in the aggregation state and must not grow with the number of values
+TEST_F(QuantileSketchesTest, AccuracyWithFixedSizeState)
+{
+    const auto values = createLogNormalValues(1000000);
+    auto sortedValues = values;
+    std::ranges::sort(sortedValues);
+
+    const auto tDigest = std::make_unique<TDigest>();
+    const auto kllSketch = std::make_unique<KllSketch>();
+    for (const auto value : values)
+    {
+        tDigest->add(value);
+        kllSketch->add(value);
+    }
+    EXPECT_EQ(kllSketch->getNumberOfValues(), values.size());
+
+    for (const auto quantile : {0.001, 0.01, 0.25, 0.5, 0.75, 0.99, 0.999})
+    {
+        EXPECT_NEAR(getRank(sortedValues, tDigest->quantile(quantile)), quantile, 0.005) << "t-digest quantile " << quantile;
+        EXPECT_NEAR(getRank(sortedValues, kllSketch->quantile(quantile)), quantile, 0.02) << "KLL quantile " << quantile;
+    }
+    EXPECT_DOUBLE_EQ(tDigest->quantile(0), sortedValues.front());
+    EXPECT_DOUBLE_EQ(tDigest->quantile(1), sortedValues.back());
+    EXPECT_DOUBLE_EQ(kllSketch->quantile(0), sortedValues.front());
+    EXPECT_DOUBLE_EQ(kllSketch->quantile(1), sortedValues.back());
+}
+
+/// Combining the partial aggregates of many slices must yield the same accuracy as a single sketch over all values
+TEST_F(QuantileSketchesTest, MergeOfManySketches)
+{
+    constexpr size_t numberOfSketches = 500;
+    const auto values = createLogNormalValues(numberOfSketches * 1000);
+    auto sortedValues = values;
+    std::ranges::sort(sortedValues);
+
+    const auto mergedTDigest = std::make_unique<TDigest>();
+    const auto mergedKllSketch = std::make_unique<KllSketch>();
+    for (size_t sketch = 0; sketch < numberOfSketches; ++sketch)
+    {
+        const auto tDigest = std::make_unique<TDigest>();
+        const auto kllSketch = std::make_unique<KllSketch>();
+        for (size_t i = sketch; i < values.size(); i += numberOfSketches)
+        {
+            tDigest->add(values[i]);
+            kllSketch->add(values[i]);
+        }
+        mergedTDigest->merge(*tDigest);
+        mergedKllSketch->merge(*kllSketch);
+    }
+    EXPECT_EQ(mergedKllSketch->getNumberOfValues(), values.size());
+    EXPECT_DOUBLE_EQ(mergedTDigest->getTotalWeight(), static_cast<double>(values.size()));
+
+    for (const auto quantile : {0.01, 0.5, 0.99})
+    {
+        EXPECT_NEAR(getRank(sortedValues, mergedTDigest->quantile(quantile)), quantile, 0.005) << "t-digest quantile " << quantile;
+        EXPECT_NEAR(getRank(sortedValues, mergedKllSketch->quantile(quantile)), quantile, 0.02) << "KLL quantile " << quantile;
+    }
+
+    /// Merging an empty sketch does not change the estimates
+    const auto medianBefore = mergedKllSketch->quantile(0.5);
+    mergedKllSketch->merge(KllSketch{});
+    EXPECT_DOUBLE_EQ(mergedKllSketch->quantile(0.5), medianBefore);
+}
+
+TEST_F(QuantileSketchesTest, NaNValuesAreIgnored)
+{
+    TDigest tDigest;
+    KllSketch kllSketch;
+    tDigest.add(std::numeric_limits<double>::quiet_NaN());
+    kllSketch.add(std::numeric_limits<double>::quiet_NaN());
+    EXPECT_TRUE(tDigest.isEmpty());
+    EXPECT_TRUE(kllSketch.isEmpty());
+    tDigest.add(7);
+    kllSketch.add(7);
+    EXPECT_DOUBLE_EQ(tDigest.quantile(0.5), 7);
+    EXPECT_DOUBLE_EQ(kllSketch.quantile(0.5), 7);
+}
+
+}
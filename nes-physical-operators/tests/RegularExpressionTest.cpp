@@ -0,0 +1,168 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstddef>
+#include <random>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <Functions/RegularExpression.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+class RegularExpressionTest : public Testing::BaseUnitTest
+{
+};
+
+namespace
+{
+/// std::regex searches with the same semantics, but in exponential time for some expressions
+void expectMatchesLikeStdRegex(const std::string& expression, const std::vector<std::string>& values)
+{
+    const auto regularExpression = RegularExpression::compile(expression);
+    const std::regex reference(expression);
+    for (const auto& value : values)
+    {
+        EXPECT_EQ(regularExpression.matches(value), std::regex_search(value, reference)) << expression << " on '" << value << "'";
+    }
+}
+
+std::string randomExpression(std::mt19937& random, const size_t depth)
+{
+    const std::vector<std::string> atoms{"a", "b", "c", ".", "[ab]", "[^a]", "\\d", "[a-c1]", "\\s"};
+    const std::vector<std::string> quantifiers{"", "", "", "*", "+", "?", "{2}", "{1,3}", "{2,}"};
+    std::string expression;
+    const auto numberOfAtoms = std::uniform_int_distribution<size_t>(1, 3)(random);
+    for (size_t atom = 0; atom < numberOfAtoms; ++atom)
+    {
+        /// Repeated groups are rare, as they let std::regex backtrack exponentially
+        if (depth > 0 and std::uniform_int_distribution<size_t>(0, 3)(random) == 0)
+        {
+            expression += "(" + randomExpression(random, depth - 1) + "|" + randomExpression(random, depth - 1) + ")";
+            expression += std::uniform_int_distribution<size_t>(0, 1)(random) == 0 ? "" : "?";
+        }
+        else
+        {
+            expression += atoms[std::uniform_int_distribution<size_t>(0, atoms.size() - 1)(random)];
+            expression += quantifiers[std::uniform_int_distribution<size_t>(0, quantifiers.size() - 1)(random)];
+        }
+    }
+    return expression;
+}
+
+std::string randomValue(std::mt19937& random)
+{
+    constexpr std::string_view Alphabet = "abc1 ";
+    std::string value(std::uniform_int_distribution<size_t>(0, 12)(random), ' ');
+    for (auto& character : value)
+    {
+        character = Alphabet[std::uniform_int_distribution<size_t>(0, Alphabet.size() - 1)(random)];
+    }
+    return value;
+}
+}
+
+TEST_F(RegularExpressionTest, MatchesAnySubstring)
+{
+    const std::vector<std::string> values{
+        "", "ERROR: connection timeout", "WARN: timeout", "ERROR: disk full", "GET /index.html", "error", "a\nb", "2024-01-31"};
+    for (const auto* expression :
+         {"ERROR.*timeout",
+          "^GET ",
+          "full$",
+          "^ERROR: (disk|connection)",
+          "\\d{4}-\\d{2}-\\d{2}",
+          "^(WARN|ERROR)$",
+          "a.b",
+          "(?:time)+out",
+          "e(r{2}|x)or",
+          "",
+          "^$",
+          "[^A-Z:]+$",
+          "\\.html",
+          "o{2,}"})
+    {
+        expectMatchesLikeStdRegex(expression, values);
+    }
+}
+
+TEST_F(RegularExpressionTest, RandomExpressionsMatchLikeStdRegex)
+{
+    std::mt19937 random(42);
+    for (size_t iteration = 0; iteration < 500; ++iteration)
+    {
+        auto expression = randomExpression(random, 2);
+        if (iteration % 3 == 1)
+        {
+            expression = "^" + expression;
+        }
+        if (iteration % 4 == 2)
+        {
+            expression += "$";
+        }
+        std::vector<std::string> values;
+        for (size_t value = 0; value < 50; ++value)
+        {
+            values.push_back(randomValue(random));
+        }
+        expectMatchesLikeStdRegex(expression, values);
+    }
+}
+
+TEST_F(RegularExpressionTest, FindsRequiredLiteral)
+{
+    EXPECT_EQ(RegularExpression::compile("ERROR.*timeout").getRequiredLiteral(), "timeout");
+    EXPECT_EQ(RegularExpression::compile("^GET /api/v[0-9]+").getRequiredLiteral(), "GET /api/v");
+    EXPECT_EQ(RegularExpression::compile("(ab){2}").getRequiredLiteral(), "abab");
+    EXPECT_EQ(RegularExpression::compile("(ab)+c").getRequiredLiteral(), "ab");
+    EXPECT_EQ(RegularExpression::compile("a|b").getRequiredLiteral(), "");
+    EXPECT_EQ(RegularExpression::compile("x?yz").getRequiredLiteral(), "yz");
+}
+
+TEST_F(RegularExpressionTest, FallsBackToNfaIfDfaIsTooLarge)
+{
+    /// The DFA has to remember the last 16 bytes, i.e., it has 2^16 states
+    const std::string expression = "a[ab]{15}";
+    EXPECT_FALSE(RegularExpression::compile(expression).isCompiledToDfa());
+    EXPECT_TRUE(RegularExpression::compile("a[ab]{3}").isCompiledToDfa());
+
+    std::mt19937 random(7);
+    std::vector<std::string> values;
+    for (size_t value = 0; value < 100; ++value)
+    {
+        std::string characters(std::uniform_int_distribution<size_t>(10, 40)(random), 'a');
+        for (auto& character : characters)
+        {
+            character = std::uniform_int_distribution<int>(0, 2)(random) == 0 ? 'a' : 'b';
+        }
+        values.push_back(characters);
+    }
+    expectMatchesLikeStdRegex(expression, values);
+}
+
+TEST_F(RegularExpressionTest, RejectsUnsupportedExpressions)
+{
+    for (const auto* expression :
+         {"a(", "a)", "(?=a)", "(a)\\1", "a**", "[a", "x{3,2}", "*a", "a$b", "(a$)", "a^", "^a|b", "\\bword", "[[:alpha:]]", "a{1001}"})
+    {
+        ASSERT_EXCEPTION_ERRORCODE(static_cast<void>(RegularExpression::compile(expression)), ErrorCode::InvalidLiteral);
+    }
+}
+
+}
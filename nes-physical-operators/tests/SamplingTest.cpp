@@ -0,0 +1,139 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+#include <Sampling/BernoulliSamplePhysicalOperator.hpp>
+#include <Sampling/ReservoirSampleOperatorHandler.hpp>
+#include <Sampling/ReservoirSampleSlice.hpp>
+#include <Time/Timestamp.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+namespace NES
+{
+
+class SamplingTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("SamplingTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup SamplingTest class.");
+    }
+
+    static WorkerReservoir createReservoir(const uint64_t numberOfSeenRecords, const uint64_t firstPosition, const uint64_t numberOfSlots)
+    {
+        WorkerReservoir reservoir;
+        reservoir.numberOfSeenRecords = numberOfSeenRecords;
+        for (uint64_t slot = 0; slot < numberOfSlots; ++slot)
+        {
+            reservoir.slots.push_back(firstPosition + slot);
+        }
+        return reservoir;
+    }
+};
+
+TEST_F(SamplingTest, BernoulliGapOfFullSample)
+{
+    for (int draw = 0; draw < 100; ++draw)
+    {
+        EXPECT_EQ(drawBernoulliSampleGap(1.0), 0);
+    }
+}
+
+/// The gaps of a Bernoulli sample with fraction p are geometric with the mean (1 - p) / p
+TEST_F(SamplingTest, BernoulliGapMean)
+{
+    constexpr auto fraction = 0.1;
+    constexpr uint64_t numberOfDraws = 100000;
+    uint64_t sumOfGaps = 0;
+    for (uint64_t draw = 0; draw < numberOfDraws; ++draw)
+    {
+        sumOfGaps += drawBernoulliSampleGap(fraction);
+    }
+    const auto meanGap = static_cast<double>(sumOfGaps) / numberOfDraws;
+    EXPECT_NEAR(meanGap, (1 - fraction) / fraction, 0.5);
+}
+
+/// A reservoir admits its first sampleSize records and afterward replaces a sampled record with a decreasing probability
+TEST_F(SamplingTest, ReservoirAdmitsRecords)
+{
+    constexpr uint64_t sampleSize = 4;
+    constexpr uint64_t numberOfRecords = 1000;
+    ReservoirSampleSlice slice(Timestamp(0), Timestamp(1000), 1, sampleSize);
+    uint64_t admittedRecords = 0;
+    for (uint64_t record = 0; record < numberOfRecords; ++record)
+    {
+        const auto admitted = slice.admitRecord(WorkerThreadId(0));
+        if (record < sampleSize)
+        {
+            EXPECT_TRUE(admitted);
+        }
+        admittedRecords += admitted ? 1 : 0;
+    }
+    const auto& reservoir = slice.getReservoirs().front();
+    EXPECT_EQ(reservoir.numberOfSeenRecords, numberOfRecords);
+    EXPECT_EQ(reservoir.slots.size(), sampleSize);
+    /// About sampleSize * (1 + ln(numberOfRecords / sampleSize)) = 26 records enter the reservoir
+    EXPECT_LT(admittedRecords, 100);
+}
+
+/// A window with fewer records than the sample size emits all of its records
+TEST_F(SamplingTest, MergeSmallReservoirs)
+{
+    const auto first = createReservoir(3, 0, 3);
+    const auto second = createReservoir(2, 10, 2);
+    std::mt19937_64 generator{42};
+    const auto sample = ReservoirSampleOperatorHandler::mergeReservoirs({&first, &second}, 10, generator);
+    ASSERT_EQ(sample.size(), 5);
+    std::set<uint64_t> positions;
+    for (const auto& sampledRecord : sample)
+    {
+        positions.insert(sampledRecord.position);
+    }
+    EXPECT_EQ(positions, (std::set<uint64_t>{0, 1, 2, 10, 11}));
+}
+
+/// The merged sample picks the records of each reservoir proportional to the number of records that the reservoir has seen
+TEST_F(SamplingTest, MergeReservoirsProportionally)
+{
+    constexpr uint64_t sampleSize = 10;
+    constexpr uint64_t numberOfMerges = 2000;
+    const auto large = createReservoir(900, 0, sampleSize);
+    const auto small = createReservoir(100, 100, sampleSize);
+    std::mt19937_64 generator{42};
+    uint64_t picksOfLarge = 0;
+    for (uint64_t merge = 0; merge < numberOfMerges; ++merge)
+    {
+        const auto sample = ReservoirSampleOperatorHandler::mergeReservoirs({&large, &small}, sampleSize, generator);
+        ASSERT_EQ(sample.size(), sampleSize);
+        std::set<uint64_t> positions;
+        for (const auto& sampledRecord : sample)
+        {
+            positions.insert(sampledRecord.position);
+            picksOfLarge += sampledRecord.pagedVector == large.records.get() ? 1 : 0;
+        }
+        EXPECT_EQ(positions.size(), sampleSize);
+    }
+    EXPECT_NEAR(static_cast<double>(picksOfLarge) / (numberOfMerges * sampleSize), 0.9, 0.02);
+}
+
+}
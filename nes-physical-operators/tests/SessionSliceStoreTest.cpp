@@ -0,0 +1,170 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <ranges>
+#include <utility>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+#include <SliceStore/SessionSliceStore.hpp>
+#include <SliceStore/Slice.hpp>
+#include <SliceStore/WindowSlicesStoreInterface.hpp>
+#include <Time/Timestamp.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+namespace NES
+{
+
+class SessionSliceStoreTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("SessionSliceStoreTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup SessionSliceStoreTest class.");
+    }
+
+    static std::shared_ptr<Slice> insert(SessionSliceStore& sliceStore, const uint64_t timestamp)
+    {
+        const auto slices = sliceStore.getSlicesOrCreate(
+            Timestamp(timestamp),
+            WorkerThreadId(0),
+            [](const SliceStart sliceStart, const SliceEnd sliceEnd)
+            { return std::vector<std::shared_ptr<Slice>>{std::make_shared<Slice>(sliceStart, sliceEnd)}; });
+        EXPECT_EQ(slices.size(), 1);
+        return slices[0];
+    }
+
+    using Sessions = std::vector<std::pair<std::pair<uint64_t, uint64_t>, size_t>>;
+
+    /// Returns the start, end and number of slices of the emitted sessions
+    static Sessions toSessions(const std::map<WindowInfoAndSequenceNumber, std::vector<std::shared_ptr<Slice>>>& sessionsToSlices)
+    {
+        Sessions sessions;
+        for (const auto& [windowInfo, slices] : sessionsToSlices)
+        {
+            sessions.push_back(
+                {{windowInfo.windowInfo.windowStart.getRawValue(), windowInfo.windowInfo.windowEnd.getRawValue()}, slices.size()});
+        }
+        return sessions;
+    }
+};
+
+TEST_F(SessionSliceStoreTest, SessionsAreTriggeredOnceTheWatermarkPassedTheirEnd)
+{
+    SessionSliceStore sliceStore(5);
+    /// Records that are less than the gap apart belong to the same session, even if they are in different slices
+    const auto firstSlice = insert(sliceStore, 1);
+    EXPECT_EQ(insert(sliceStore, 3), firstSlice);
+    EXPECT_EQ(firstSlice->getSliceStart(), SliceStart(0));
+    EXPECT_EQ(firstSlice->getSliceEnd(), SliceEnd(5));
+    EXPECT_NE(insert(sliceStore, 7), firstSlice);
+    insert(sliceStore, 20);
+    insert(sliceStore, 22);
+
+    /// The first session [1, 12) ends one gap after its last record
+    EXPECT_TRUE(sliceStore.getTriggerableWindowSlices(Timestamp(12)).empty());
+    EXPECT_EQ(toSessions(sliceStore.getTriggerableWindowSlices(Timestamp(13))), (Sessions{{{1, 12}, 2}}));
+    /// A session is only emitted once
+    EXPECT_TRUE(sliceStore.getTriggerableWindowSlices(Timestamp(13)).empty());
+    EXPECT_EQ(toSessions(sliceStore.getTriggerableWindowSlices(Timestamp(100))), (Sessions{{{20, 27}, 1}}));
+}
+
+TEST_F(SessionSliceStoreTest, RecordsExactlyOneGapApartStartANewSession)
+{
+    SessionSliceStore sliceStore(5);
+    insert(sliceStore, 3);
+    insert(sliceStore, 8);
+    insert(sliceStore, 14);
+    EXPECT_EQ(toSessions(sliceStore.getTriggerableWindowSlices(Timestamp(100))), (Sessions{{{3, 8}, 1}, {{8, 13}, 1}, {{14, 19}, 1}}));
+}
+
+/// A record between two sessions merges them into one session
+TEST_F(SessionSliceStoreTest, RecordsBridgingTwoSessionsMergeThem)
+{
+    SessionSliceStore sliceStore(5);
+    insert(sliceStore, 4);
+    insert(sliceStore, 12);
+    insert(sliceStore, 8);
+    EXPECT_EQ(toSessions(sliceStore.getTriggerableWindowSlices(Timestamp(100))), (Sessions{{{4, 17}, 3}}));
+}
+
+/// The slices of a session know the range of the ingestion timestamps of all buffers that were processed while they were filled
+TEST_F(SessionSliceStoreTest, SlicesTrackTheIngestionTimestampsOfTheirBuffers)
+{
+    SessionSliceStore sliceStore(5);
+    const auto firstSlice = insert(sliceStore, 1);
+    EXPECT_EQ(firstSlice->getIngestionTimestamps().min, Timestamp(Timestamp::INITIAL_VALUE));
+    sliceStore.addIngestionTimestamps(Timestamp(0), {.min = Timestamp(200), .max = Timestamp(300)});
+    const auto secondSlice = insert(sliceStore, 7);
+    sliceStore.addIngestionTimestamps(Timestamp(0), {.min = Timestamp(100), .max = Timestamp(250)});
+    /// Buffers without ingestion timestamps do not change the range
+    sliceStore.addIngestionTimestamps(Timestamp(0), {});
+
+    EXPECT_EQ(firstSlice->getIngestionTimestamps().min, Timestamp(100));
+    EXPECT_EQ(firstSlice->getIngestionTimestamps().max, Timestamp(300));
+    EXPECT_EQ(secondSlice->getIngestionTimestamps().min, Timestamp(100));
+    EXPECT_EQ(secondSlice->getIngestionTimestamps().max, Timestamp(250));
+
+    IngestionTimestamps sessionIngestionTimestamps;
+    for (const auto& slices : sliceStore.getTriggerableWindowSlices(Timestamp(100)) | std::views::values)
+    {
+        for (const auto& slice : slices)
+        {
+            sessionIngestionTimestamps.merge(slice->getIngestionTimestamps());
+        }
+    }
+    EXPECT_EQ(sessionIngestionTimestamps.min, Timestamp(100));
+    EXPECT_EQ(sessionIngestionTimestamps.max, Timestamp(300));
+}
+
+TEST_F(SessionSliceStoreTest, TerminationEmitsAllSessionsAfterTheLastInputPipeline)
+{
+    SessionSliceStore sliceStore(10);
+    sliceStore.incrementNumberOfInputPipelines();
+    sliceStore.incrementNumberOfInputPipelines();
+    insert(sliceStore, 5);
+    insert(sliceStore, 50);
+
+    EXPECT_TRUE(sliceStore.getAllNonTriggeredSlices().empty());
+    EXPECT_EQ(toSessions(sliceStore.getAllNonTriggeredSlices()), (Sessions{{{5, 15}, 1}, {{50, 60}, 1}}));
+}
+
+TEST_F(SessionSliceStoreTest, GarbageCollectionDeletesTheSlicesOfProcessedSessions)
+{
+    SessionSliceStore sliceStore(10);
+    insert(sliceStore, 5);
+    insert(sliceStore, 12);
+    insert(sliceStore, 40);
+
+    /// Slices are only deleted after their session has been emitted
+    sliceStore.garbageCollectSlicesAndWindows(Timestamp(100));
+    EXPECT_TRUE(sliceStore.getSliceBySliceEnd(SliceEnd(10)).has_value());
+
+    EXPECT_EQ(toSessions(sliceStore.getTriggerableWindowSlices(Timestamp(30))), (Sessions{{{5, 22}, 2}}));
+    sliceStore.garbageCollectSlicesAndWindows(Timestamp(21));
+    EXPECT_TRUE(sliceStore.getSliceBySliceEnd(SliceEnd(10)).has_value());
+    sliceStore.garbageCollectSlicesAndWindows(Timestamp(22));
+    EXPECT_FALSE(sliceStore.getSliceBySliceEnd(SliceEnd(10)).has_value());
+    EXPECT_FALSE(sliceStore.getSliceBySliceEnd(SliceEnd(20)).has_value());
+    EXPECT_TRUE(sliceStore.getSliceBySliceEnd(SliceEnd(50)).has_value());
+}
+
+}
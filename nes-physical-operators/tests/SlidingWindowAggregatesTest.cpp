@@ -0,0 +1,253 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+#include <Aggregation/AggregationSlice.hpp>
+#include <Aggregation/SlidingWindowAggregates.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Runtime/BufferManager.hpp>
+#include <SliceStore/DefaultTimeBasedSliceStore.hpp>
+#include <SliceStore/Slice.hpp>
+#include <SliceStore/WindowSlicesStoreInterface.hpp>
+#include <Time/Timestamp.hpp>
+#include <Util/HashMapType.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+#include <Engine.hpp>
+#include <HashMapSlice.hpp>
+#include <options.hpp>
+#include <val_ptr.hpp>
+
+namespace NES
+{
+
+/// Instead of aggregation states, the hash maps of the test keep track of the timestamps of all records that they contain.
+/// Thus, we can check that the partial aggregates of a window contain each record of the window exactly once.
+class SlidingWindowAggregatesTest : public Testing::BaseUnitTest
+{
+public:
+    static constexpr uint64_t NUMBER_OF_WORKER_THREADS = 3;
+    static constexpr uint64_t NUMBER_OF_PARTITIONS = 2;
+
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("SlidingWindowAggregatesTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup SlidingWindowAggregatesTest test class.");
+    }
+
+    void SetUp() override
+    {
+        Testing::BaseUnitTest::SetUp();
+        bufferManager = BufferManager::create();
+        nautilus::engine::Options options;
+        options.setOption("engine.Compilation", false);
+        engine = std::make_unique<nautilus::engine::NautilusEngine>(options);
+        cleanupFunction = std::make_shared<CreateNewHashMapSliceArgs::NautilusCleanupExec>(
+            engine->registerFunction(std::function([](nautilus::val<HashMap*>) { })));
+    }
+
+    /// Inserts one record per timestamp into the slice store, distributed over the worker threads and partitions
+    void insertRecords(DefaultTimeBasedSliceStore& sliceStore, const std::vector<uint64_t>& timestamps)
+    {
+        const CreateNewHashMapSliceArgs args{{cleanupFunction}, 8, 8, 1024, 16, HashMapType::CHAINED};
+        for (const auto timestamp : timestamps)
+        {
+            const auto slices = sliceStore.getSlicesOrCreate(
+                Timestamp(timestamp),
+                WorkerThreadId(0),
+                [&](const SliceStart sliceStart, const SliceEnd sliceEnd) -> std::vector<std::shared_ptr<Slice>>
+                {
+                    return {std::make_shared<AggregationSlice>(
+                        sliceStart, sliceEnd, args, NUMBER_OF_WORKER_THREADS, NUMBER_OF_PARTITIONS)};
+                });
+            const auto aggregationSlice = std::dynamic_pointer_cast<AggregationSlice>(slices[0]);
+            auto* hashMap = aggregationSlice->getHashMapPtrOrCreate(
+                WorkerThreadId(timestamp % NUMBER_OF_WORKER_THREADS), timestamp % NUMBER_OF_PARTITIONS);
+            static_cast<void>(hashMap->insertEntry(timestamp, bufferManager.get()));
+            recordsOfHashMap[hashMap].insert(timestamp);
+        }
+    }
+
+    SlidingWindowAggregates::CombineFunction getCombineFunction()
+    {
+        return [this](HashMap* destination, HashMap* source)
+        {
+            ++numberOfCombines;
+            if (destination->getNumberOfTuples() == 0)
+            {
+                static_cast<void>(destination->insertEntry(0, bufferManager.get()));
+            }
+            recordsOfHashMap[destination].insert(recordsOfHashMap[source].begin(), recordsOfHashMap[source].end());
+        };
+    }
+
+    PartialAggregate::CleanupFunction getCleanupFunction()
+    {
+        return [this](HashMap* hashMap) { recordsOfHashMap.erase(hashMap); };
+    }
+
+    /// Returns the records of the partial aggregates of the window and checks that each record lies in the correct partition
+    std::multiset<uint64_t> getRecords(const WindowPartialAggregates& partialAggregates)
+    {
+        std::multiset<uint64_t> records;
+        for (const auto& partialAggregate : {partialAggregates.suffix, partialAggregates.prefix})
+        {
+            for (uint64_t partition = 0; partition < NUMBER_OF_PARTITIONS and partialAggregate != nullptr; ++partition)
+            {
+                for (const auto record : recordsOfHashMap[partialAggregate->getHashMapPtr(partition)])
+                {
+                    EXPECT_EQ(record % NUMBER_OF_PARTITIONS, partition);
+                    records.insert(record);
+                }
+            }
+        }
+        return records;
+    }
+
+    /// Checks the partial aggregates of all windows and returns the number of combines that triggering the windows from scratch takes
+    uint64_t checkAllWindows(
+        const uint64_t windowSize, const uint64_t windowSlide, const std::vector<uint64_t>& timestamps, const bool reverse)
+    {
+        DefaultTimeBasedSliceStore sliceStore(windowSize, windowSlide);
+        insertRecords(sliceStore, timestamps);
+        SlidingWindowAggregates slidingWindowAggregates(windowSize, windowSlide, NUMBER_OF_PARTITIONS);
+
+        const auto windows = sliceStore.getTriggerableWindowSlices(Timestamp(Timestamp::INVALID_VALUE));
+        EXPECT_FALSE(windows.empty());
+        std::vector<std::pair<WindowInfo, std::vector<std::shared_ptr<Slice>>>> orderedWindows;
+        for (const auto& [windowInfo, slices] : windows)
+        {
+            orderedWindows.emplace_back(windowInfo.windowInfo, slices);
+        }
+        if (reverse)
+        {
+            std::ranges::reverse(orderedWindows);
+        }
+
+        uint64_t numberOfCombinesFromScratch = 0;
+        for (const auto& [windowInfo, slices] : orderedWindows)
+        {
+            const auto partialAggregates
+                = slidingWindowAggregates.getPartialAggregates(windowInfo, slices, getCombineFunction(), getCleanupFunction());
+            std::multiset<uint64_t> expectedRecords;
+            for (const auto timestamp : timestamps)
+            {
+                if (windowInfo.windowStart.getRawValue() <= timestamp and timestamp < windowInfo.windowEnd.getRawValue())
+                {
+                    expectedRecords.insert(timestamp);
+                }
+            }
+            EXPECT_EQ(getRecords(partialAggregates), expectedRecords) << windowInfo.windowStart << "-" << windowInfo.windowEnd;
+            for (const auto& slice : slices)
+            {
+                const auto aggregationSlice = std::dynamic_pointer_cast<AggregationSlice>(slice);
+                for (uint64_t partition = 0; partition < NUMBER_OF_PARTITIONS; ++partition)
+                {
+                    numberOfCombinesFromScratch += std::ranges::count_if(
+                        aggregationSlice->getHashMapPtrsOfPartition(partition),
+                        [](const HashMap* hashMap) { return hashMap != nullptr and hashMap->getNumberOfTuples() > 0; });
+                }
+            }
+        }
+        return numberOfCombinesFromScratch;
+    }
+
+    std::shared_ptr<BufferManager> bufferManager;
+    std::unique_ptr<nautilus::engine::NautilusEngine> engine;
+    std::shared_ptr<CreateNewHashMapSliceArgs::NautilusCleanupExec> cleanupFunction;
+    std::map<HashMap*, std::multiset<uint64_t>> recordsOfHashMap;
+    uint64_t numberOfCombines = 0;
+};
+
+TEST_F(SlidingWindowAggregatesTest, SharingOnlyForLargeWindows)
+{
+    EXPECT_TRUE(SlidingWindowAggregates::isBeneficial(40, 10));
+    EXPECT_TRUE(SlidingWindowAggregates::isBeneficial(1000, 1));
+    EXPECT_FALSE(SlidingWindowAggregates::isBeneficial(30, 10));
+    EXPECT_FALSE(SlidingWindowAggregates::isBeneficial(10, 10));
+    EXPECT_EQ(SlidingWindowAggregates(40, 10, 1).getBlockSize(), 40);
+    EXPECT_EQ(SlidingWindowAggregates(35, 10, 1).getBlockSize(), 40);
+}
+
+TEST_F(SlidingWindowAggregatesTest, WindowsContainEachRecordOnce)
+{
+    std::vector<uint64_t> timestamps;
+    for (uint64_t timestamp = 0; timestamp < 500; timestamp += 3)
+    {
+        timestamps.emplace_back(timestamp);
+    }
+    const auto numberOfCombinesFromScratch = checkAllWindows(100, 10, timestamps, false);
+
+    /// Building the prefixes and suffixes combines each hash map of a slice twice, plus a copy of the previous prefix or suffix
+    EXPECT_LT(numberOfCombines, numberOfCombinesFromScratch / 2);
+}
+
+/// If the slide does not divide the size, the windows are not aligned to the blocks and the slices have different lengths
+TEST_F(SlidingWindowAggregatesTest, SizeIsNoMultipleOfSlide)
+{
+    std::vector<uint64_t> timestamps;
+    for (uint64_t timestamp = 1; timestamp < 400; timestamp += 7)
+    {
+        timestamps.emplace_back(timestamp);
+    }
+    checkAllWindows(45, 10, timestamps, false);
+}
+
+/// Windows without records in a block have no partial aggregate for that block
+TEST_F(SlidingWindowAggregatesTest, SlicesWithoutRecords)
+{
+    checkAllWindows(40, 10, {5, 6, 95, 96, 97, 250}, false);
+}
+
+/// Windows that are requested after younger windows are still correct, although their partial aggregates get computed again
+TEST_F(SlidingWindowAggregatesTest, WindowsInReverseOrder)
+{
+    std::vector<uint64_t> timestamps;
+    for (uint64_t timestamp = 0; timestamp < 300; timestamp += 4)
+    {
+        timestamps.emplace_back(timestamp);
+    }
+    checkAllWindows(60, 15, timestamps, true);
+}
+
+/// Once all partial aggregates are released, the aggregation states of all of their hash maps are cleaned up
+TEST_F(SlidingWindowAggregatesTest, PartialAggregatesCleanUpTheirHashMaps)
+{
+    std::set<HashMap*> cleanedUpHashMaps;
+    {
+        PartialAggregate partialAggregate(NUMBER_OF_PARTITIONS, [&](HashMap* hashMap) { cleanedUpHashMaps.insert(hashMap); });
+        DefaultTimeBasedSliceStore sliceStore(40, 10);
+        insertRecords(sliceStore, {3});
+        auto* sliceHashMap = recordsOfHashMap.begin()->first;
+        auto* hashMap = partialAggregate.getHashMapPtrOrCreate(1, *sliceHashMap);
+        EXPECT_EQ(partialAggregate.getHashMapPtrOrCreate(1, *sliceHashMap), hashMap);
+        EXPECT_EQ(partialAggregate.getHashMapPtr(0), nullptr);
+        getCombineFunction()(hashMap, sliceHashMap);
+        EXPECT_TRUE(cleanedUpHashMaps.empty());
+    }
+    EXPECT_EQ(cleanedUpHashMaps.size(), 1);
+}
+
+}
@@ -0,0 +1,105 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+#include <Join/SortMergeJoin/SortMergeJoinEntry.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+namespace NES
+{
+
+class SortMergeJoinEntryTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("SortMergeJoinEntryTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup SortMergeJoinEntryTest test class.");
+    }
+
+    static std::vector<SortMergeJoinEntry> createSortedEntries(const uint64_t numberOfEntries, std::mt19937_64& generator)
+    {
+        /// Few distinct keys, so that many entries have the same key
+        std::uniform_int_distribution<int64_t> keyDistribution(-20, 20);
+        std::vector<SortMergeJoinEntry> entries;
+        for (uint64_t position = 0; position < numberOfEntries; ++position)
+        {
+            entries.emplace_back(SortMergeJoinEntry{.key = static_cast<double>(keyDistribution(generator)), .position = position});
+        }
+        EXPECT_EQ(sortSortMergeJoinEntries(entries), numberOfEntries);
+        return entries;
+    }
+};
+
+TEST_F(SortMergeJoinEntryTest, SortByKeyAndPositionAndMoveNaNToTheEnd)
+{
+    constexpr auto nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<SortMergeJoinEntry> entries{{3.0, 0}, {nan, 1}, {1.0, 2}, {-1.5, 3}, {1.0, 4}, {nan, 5}};
+    ASSERT_EQ(sortSortMergeJoinEntries(entries), 4);
+
+    const std::vector<uint64_t> expectedPositions{3, 2, 4, 0};
+    for (uint64_t i = 0; i < expectedPositions.size(); ++i)
+    {
+        EXPECT_EQ(entries[i].position, expectedPositions[i]);
+    }
+    EXPECT_TRUE(std::isnan(entries[4].key));
+    EXPECT_TRUE(std::isnan(entries[5].key));
+}
+
+/// Checks the ranges of the merge against comparing all pairs of entries
+TEST_F(SortMergeJoinEntryTest, RangesContainExactlyTheEntriesWithinTheBand)
+{
+    std::mt19937_64 generator(42); /// NOLINT(cert-msc32-c,cert-msc51-cpp)
+    const auto leftEntries = createSortedEntries(500, generator);
+    const auto rightEntries = createSortedEntries(300, generator);
+
+    for (const auto& [lowerBounded, upperBounded] : {std::pair{true, false}, std::pair{false, true}, std::pair{true, true}})
+    {
+        std::vector<SortMergeJoinRange> ranges(leftEntries.size());
+        computeSortMergeJoinRanges(leftEntries, rightEntries, lowerBounded, upperBounded, ranges);
+        for (uint64_t left = 0; left < leftEntries.size(); ++left)
+        {
+            for (uint64_t right = 0; right < rightEntries.size(); ++right)
+            {
+                const auto leftKey = leftEntries[left].key;
+                const auto rightKey = rightEntries[right].key;
+                const bool withinBand = (not lowerBounded or rightKey >= leftKey) and (not upperBounded or rightKey <= leftKey);
+                const bool withinRange = ranges[left].begin <= right and right < ranges[left].end;
+                ASSERT_EQ(withinBand, withinRange) << "left " << leftKey << " right " << rightKey << " lower " << lowerBounded;
+            }
+        }
+    }
+}
+
+TEST_F(SortMergeJoinEntryTest, EmptySides)
+{
+    std::vector<SortMergeJoinEntry> leftEntries{{1.0, 0}, {2.0, 1}};
+    std::vector<SortMergeJoinRange> ranges(leftEntries.size());
+    computeSortMergeJoinRanges(leftEntries, {}, true, true, ranges);
+    for (const auto& range : ranges)
+    {
+        EXPECT_EQ(range.begin, range.end);
+    }
+    computeSortMergeJoinRanges({}, leftEntries, true, false, {});
+}
+
+}
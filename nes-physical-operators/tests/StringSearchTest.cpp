@@ -0,0 +1,97 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <Functions/StringMatchLogicalFunction.hpp>
+#include <Functions/StringSearch.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+namespace NES
+{
+
+class StringSearchTest : public Testing::BaseUnitTest
+{
+};
+
+TEST_F(StringSearchTest, FindsFirstOccurrence)
+{
+    /// The haystack is long enough for the vectorized search and contains a partial match before the match
+    const std::string haystack = std::string(40, 'x') + "needlx" + std::string(20, 'y') + "needle" + "needle";
+    const SubstringSearcher searcher("needle");
+    EXPECT_EQ(searcher.find(haystack), 66);
+    EXPECT_EQ(searcher.find(haystack, 67), 72);
+    EXPECT_EQ(searcher.find(haystack, 73), std::string_view::npos);
+    EXPECT_EQ(SubstringSearcher("e").find(haystack), 41);
+    EXPECT_EQ(SubstringSearcher("").find(haystack, 3), 3);
+    EXPECT_EQ(SubstringSearcher("needles").find("needle"), std::string_view::npos);
+}
+
+TEST_F(StringSearchTest, FindsMatchesAtEveryOffsetOfABlock)
+{
+    for (size_t position = 0; position < 64; ++position)
+    {
+        auto haystack = std::string(80, 'a');
+        haystack.replace(position, 3, "abc");
+        EXPECT_EQ(SubstringSearcher("abc").find(haystack), position) << position;
+    }
+}
+
+TEST_F(StringSearchTest, LikeWildcards)
+{
+    EXPECT_TRUE(LikePattern::compile("%error%").matches("an error occurred"));
+    EXPECT_FALSE(LikePattern::compile("%error%").matches("an err occurred"));
+    EXPECT_TRUE(LikePattern::compile("a_c").matches("abc"));
+    EXPECT_FALSE(LikePattern::compile("a_c").matches("abbc"));
+    EXPECT_TRUE(LikePattern::compile("a%b%c").matches("aXbYbZc"));
+    EXPECT_FALSE(LikePattern::compile("a%b%c").matches("aXcYb"));
+    EXPECT_TRUE(LikePattern::compile("%_b").matches("ab"));
+    EXPECT_FALSE(LikePattern::compile("%_b").matches("b"));
+    EXPECT_TRUE(LikePattern::compile("ab%ab").matches("ab_ab"));
+    EXPECT_FALSE(LikePattern::compile("ab%ab").matches("aba"));
+    EXPECT_TRUE(LikePattern::compile("").matches(""));
+    EXPECT_FALSE(LikePattern::compile("").matches("a"));
+    EXPECT_TRUE(LikePattern::compile("%").matches(""));
+}
+
+TEST_F(StringSearchTest, LikeEscapes)
+{
+    EXPECT_TRUE(LikePattern::compile("100\\%").matches("100%"));
+    EXPECT_FALSE(LikePattern::compile("100\\%").matches("1000"));
+    EXPECT_TRUE(LikePattern::compile("a\\_c").matches("a_c"));
+    EXPECT_FALSE(LikePattern::compile("a\\_c").matches("abc"));
+}
+
+TEST_F(StringSearchTest, TrivialShapes)
+{
+    using enum LikePattern::Shape;
+    EXPECT_EQ(LikePattern::compile("abc").getShape(), EQUALS);
+    EXPECT_EQ(LikePattern::compile("abc%").getShape(), STARTS_WITH);
+    EXPECT_EQ(LikePattern::compile("%abc").getShape(), ENDS_WITH);
+    EXPECT_EQ(LikePattern::compile("%%abc%").getShape(), CONTAINS);
+    EXPECT_EQ(LikePattern::compile("%abc%").getLiteral(), "abc");
+    EXPECT_EQ(LikePattern::compile("a%c").getShape(), GENERAL);
+    EXPECT_EQ(LikePattern::compile("a_c").getShape(), GENERAL);
+
+    /// All but LIKE match the pattern literally
+    EXPECT_EQ(LikePattern::compile(StringMatchKind::STARTS_WITH, "a%").getShape(), STARTS_WITH);
+    EXPECT_EQ(LikePattern::compile(StringMatchKind::STARTS_WITH, "a%").getLiteral(), "a%");
+    EXPECT_TRUE(LikePattern::compile(StringMatchKind::ENDS_WITH, "_b").matches("a_b"));
+    EXPECT_FALSE(LikePattern::compile(StringMatchKind::ENDS_WITH, "_b").matches("ab"));
+    EXPECT_TRUE(LikePattern::compile(StringMatchKind::CONTAINS, "").matches("ab"));
+}
+
+}
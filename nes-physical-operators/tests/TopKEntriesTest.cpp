@@ -0,0 +1,101 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <Aggregation/TopKEntries.hpp>
+#include <Nautilus/Interface/HashMap/HashMap.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+namespace NES
+{
+
+class TopKEntriesTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("TopKEntriesTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup TopKEntriesTest test class.");
+    }
+
+    static std::vector<AbstractHashMapEntry*> getEntries(TopKEntries& topKEntries)
+    {
+        topKEntries.sort();
+        std::vector<AbstractHashMapEntry*> entries;
+        for (uint64_t pos = 0; pos < topKEntries.size(); ++pos)
+        {
+            entries.emplace_back(topKEntries.getEntry(pos));
+        }
+        return entries;
+    }
+
+    std::array<AbstractHashMapEntry, 6> entries;
+};
+
+TEST_F(TopKEntriesTest, SortKeysPreserveTheOrderOfValues)
+{
+    EXPECT_LT(TopKEntries::toSortKey(int64_t{-5}, false), TopKEntries::toSortKey(int64_t{-1}, false));
+    EXPECT_LT(TopKEntries::toSortKey(int64_t{-1}, false), TopKEntries::toSortKey(int64_t{0}, false));
+    EXPECT_LT(
+        TopKEntries::toSortKey(std::numeric_limits<int64_t>::max() - 1, false),
+        TopKEntries::toSortKey(std::numeric_limits<int64_t>::max(), false));
+    EXPECT_LT(TopKEntries::toSortKey(uint64_t{3}, false), TopKEntries::toSortKey(std::numeric_limits<uint64_t>::max(), false));
+    EXPECT_LT(TopKEntries::toSortKey(-2.5, false), TopKEntries::toSortKey(-0.5, false));
+    EXPECT_LT(TopKEntries::toSortKey(-0.5, false), TopKEntries::toSortKey(0.0, false));
+    EXPECT_LT(TopKEntries::toSortKey(0.25F, false), TopKEntries::toSortKey(1.5F, false));
+
+    /// An ascending top-k prefers smaller values
+    EXPECT_GT(TopKEntries::toSortKey(int64_t{-5}, true), TopKEntries::toSortKey(int64_t{3}, true));
+    EXPECT_GT(TopKEntries::toSortKey(-2.5, true), TopKEntries::toSortKey(1.0, true));
+}
+
+TEST_F(TopKEntriesTest, KeepsTheEntriesWithTheLargestSortKeys)
+{
+    TopKEntries topKEntries(3);
+    const std::array<int64_t, 6> values{40, -10, 70, 20, 50, 10};
+    for (uint64_t i = 0; i < entries.size(); ++i)
+    {
+        topKEntries.offer(&entries[i], TopKEntries::toSortKey(values[i], false), false);
+    }
+    EXPECT_EQ(getEntries(topKEntries), (std::vector<AbstractHashMapEntry*>{&entries[2], &entries[4], &entries[0]}));
+}
+
+TEST_F(TopKEntriesTest, KeepsAllEntriesBelowTheLimit)
+{
+    TopKEntries topKEntries(10);
+    topKEntries.offer(&entries[0], TopKEntries::toSortKey(2.0, true), false);
+    topKEntries.offer(&entries[1], TopKEntries::toSortKey(1.0, true), false);
+    EXPECT_EQ(getEntries(topKEntries), (std::vector<AbstractHashMapEntry*>{&entries[1], &entries[0]}));
+}
+
+TEST_F(TopKEntriesTest, NullValuesComeLast)
+{
+    TopKEntries topKEntries(2);
+    topKEntries.offer(&entries[0], TopKEntries::toSortKey(std::numeric_limits<uint64_t>::max(), false), true);
+    topKEntries.offer(&entries[1], TopKEntries::toSortKey(uint64_t{0}, false), false);
+    topKEntries.offer(&entries[2], TopKEntries::toSortKey(uint64_t{1}, false), true);
+    EXPECT_EQ(topKEntries.size(), 2);
+    const auto topEntries = getEntries(topKEntries);
+    EXPECT_EQ(topEntries.front(), &entries[1]);
+    EXPECT_TRUE(topEntries.back() == &entries[0] or topEntries.back() == &entries[2]);
+}
+
+}
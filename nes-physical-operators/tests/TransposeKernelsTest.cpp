@@ -0,0 +1,155 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/TransposeKernels.hpp>
+#include <Runtime/ColumnarLayout.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+namespace NES
+{
+
+class TransposeKernelsTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("TransposeKernelsTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup TransposeKernelsTest test class.");
+    }
+
+    static constexpr uint64_t BUFFER_SIZE = 4096;
+
+    /// id UINT64, value nullable INT32, flag nullable INT8, count INT16, price FLOAT64
+    /// The row of a tuple is [id: 8][null: 1][value: 4][null: 1][flag: 1][count: 2][price: 8]
+    static constexpr uint64_t ROW_TUPLE_SIZE = 25;
+
+    static Schema createSchema()
+    {
+        return Schema{}
+            .addField("id", DataType::Type::UINT64)
+            .addField("value", DataType::Type::INT32, DataType::NULLABLE::IS_NULLABLE)
+            .addField("flag", DataType::Type::INT8, DataType::NULLABLE::IS_NULLABLE)
+            .addField("count", DataType::Type::INT16)
+            .addField("price", DataType::Type::FLOAT64);
+    }
+
+    template <typename T>
+    static void write(std::vector<int8_t>& buffer, const uint64_t offset, const T value)
+    {
+        std::memcpy(buffer.data() + offset, &value, sizeof(T));
+    }
+
+    template <typename T>
+    static T read(const std::vector<int8_t>& buffer, const uint64_t offset)
+    {
+        T value;
+        std::memcpy(&value, buffer.data() + offset, sizeof(T));
+        return value;
+    }
+
+    static std::vector<int8_t> createRows(const uint64_t numberOfTuples)
+    {
+        std::vector<int8_t> rows(numberOfTuples * ROW_TUPLE_SIZE);
+        for (uint64_t i = 0; i < numberOfTuples; ++i)
+        {
+            const auto row = i * ROW_TUPLE_SIZE;
+            write<uint64_t>(rows, row, i);
+            write<bool>(rows, row + 8, i % 3 == 0);
+            write<int32_t>(rows, row + 9, static_cast<int32_t>(i) * -7);
+            write<bool>(rows, row + 13, i % 5 == 0);
+            write<int8_t>(rows, row + 14, static_cast<int8_t>(i % 100));
+            write<int16_t>(rows, row + 15, static_cast<int16_t>(i * 3));
+            write<double>(rows, row + 17, static_cast<double>(i) / 4.0);
+        }
+        return rows;
+    }
+};
+
+TEST_F(TransposeKernelsTest, FieldsOfRowAndColumnarLayout)
+{
+    const auto schema = createSchema();
+    const auto layout = ColumnarLayout::create(schema, BUFFER_SIZE);
+    const auto fields = getTransposedFields(schema, BUFFER_SIZE);
+    ASSERT_TRUE(fields.has_value());
+    ASSERT_EQ(fields->size(), 5);
+    EXPECT_EQ((*fields)[1].rowOffset, 8);
+    EXPECT_EQ((*fields)[1].valueSize, 4);
+    EXPECT_EQ((*fields)[1].columnOffset, layout.columns[1].valueOffset);
+    EXPECT_EQ((*fields)[1].validityOffset, layout.columns[1].validityOffset);
+    EXPECT_EQ((*fields)[4].rowOffset, 17);
+    EXPECT_FALSE((*fields)[4].validityOffset.has_value());
+
+    /// Variable sized values reference the child buffers of their buffer
+    const auto varSizedSchema = Schema{}.addField("id", DataType::Type::UINT64).addField("text", DataType::Type::VARSIZED);
+    EXPECT_FALSE(getTransposedFields(varSizedSchema, BUFFER_SIZE).has_value());
+}
+
+TEST_F(TransposeKernelsTest, RowsToColumns)
+{
+    const auto schema = createSchema();
+    const auto layout = ColumnarLayout::create(schema, BUFFER_SIZE);
+    const auto fields = getTransposedFields(schema, BUFFER_SIZE).value();
+    constexpr uint64_t numberOfTuples = 150;
+    auto rows = createRows(numberOfTuples);
+
+    /// Transposing from the middle of the rows fills the columns from their first tuple on, which covers partial validity words
+    constexpr uint64_t begin = 13;
+    constexpr uint64_t size = numberOfTuples - begin;
+    ASSERT_LE(size, layout.capacity);
+    std::vector<int8_t> columns(BUFFER_SIZE, -1);
+    transposeRowsToColumns(fields, ROW_TUPLE_SIZE, rows.data(), begin, size, columns.data());
+
+    const auto* bitmaps = reinterpret_cast<const std::byte*>(columns.data()); /// NOLINT
+    for (uint64_t i = 0; i < size; ++i)
+    {
+        const auto tuple = begin + i;
+        EXPECT_EQ(read<uint64_t>(columns, layout.columns[0].valueOffset + (i * 8)), tuple);
+        EXPECT_EQ(ColumnarLayout::isValid(bitmaps + layout.columns[1].validityOffset.value(), i), tuple % 3 != 0);
+        EXPECT_EQ(read<int32_t>(columns, layout.columns[1].valueOffset + (i * 4)), static_cast<int32_t>(tuple) * -7);
+        EXPECT_EQ(ColumnarLayout::isValid(bitmaps + layout.columns[2].validityOffset.value(), i), tuple % 5 != 0);
+        EXPECT_EQ(read<int8_t>(columns, layout.columns[2].valueOffset + i), static_cast<int8_t>(tuple % 100));
+        EXPECT_EQ(read<int16_t>(columns, layout.columns[3].valueOffset + (i * 2)), static_cast<int16_t>(tuple * 3));
+        EXPECT_EQ(read<double>(columns, layout.columns[4].valueOffset + (i * 8)), static_cast<double>(tuple) / 4.0);
+    }
+}
+
+TEST_F(TransposeKernelsTest, ColumnsToRowsRestoresTheRows)
+{
+    const auto schema = createSchema();
+    const auto fields = getTransposedFields(schema, BUFFER_SIZE).value();
+    constexpr uint64_t numberOfTuples = 100;
+    const auto rows = createRows(numberOfTuples);
+    std::vector<int8_t> columns(BUFFER_SIZE);
+    transposeRowsToColumns(fields, ROW_TUPLE_SIZE, const_cast<int8_t*>(rows.data()), 0, numberOfTuples, columns.data()); /// NOLINT
+
+    /// Transposing the tuples [70, 100) back yields their original rows
+    constexpr uint64_t begin = 70;
+    constexpr uint64_t size = numberOfTuples - begin;
+    std::vector<int8_t> restored(size * ROW_TUPLE_SIZE);
+    transposeColumnsToRows(fields, ROW_TUPLE_SIZE, columns.data(), begin, size, restored.data());
+    EXPECT_TRUE(std::equal(restored.begin(), restored.end(), rows.begin() + (begin * ROW_TUPLE_SIZE)));
+}
+
+}
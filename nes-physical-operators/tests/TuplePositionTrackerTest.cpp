@@ -0,0 +1,116 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <Time/Timestamp.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <Watermark/TuplePositionTracker.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+namespace NES
+{
+
+class TuplePositionTrackerTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("TuplePositionTrackerTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup TuplePositionTrackerTest class.");
+    }
+};
+
+TEST_F(TuplePositionTrackerTest, PositionsAreConsecutive)
+{
+    TuplePositionTracker tracker;
+    const auto lowerBound = tracker.beginBuffer();
+    EXPECT_EQ(lowerBound, 0);
+    for (uint64_t expectedPosition = 0; expectedPosition < 10; ++expectedPosition)
+    {
+        EXPECT_EQ(tracker.getNextPosition(), expectedPosition);
+    }
+    EXPECT_EQ(tracker.finishBuffer(lowerBound), Timestamp(10));
+    EXPECT_EQ(tracker.beginBuffer(), 10);
+}
+
+/// The watermark must not pass the positions of a buffer that is still being processed
+TEST_F(TuplePositionTrackerTest, WatermarkWaitsForActiveBuffers)
+{
+    TuplePositionTracker tracker;
+    const auto firstBuffer = tracker.beginBuffer();
+    const auto secondBuffer = tracker.beginBuffer();
+    EXPECT_EQ(tracker.getNextPosition(), 0);
+    EXPECT_EQ(tracker.getNextPosition(), 1);
+    EXPECT_EQ(tracker.getNextPosition(), 2);
+
+    /// The first buffer might have assigned position 0 to one of its records, which has not been inserted yet
+    EXPECT_EQ(tracker.finishBuffer(secondBuffer), Timestamp(0));
+    const auto thirdBuffer = tracker.beginBuffer();
+    EXPECT_EQ(thirdBuffer, 3);
+    EXPECT_EQ(tracker.getNextPosition(), 3);
+    EXPECT_EQ(tracker.finishBuffer(firstBuffer), Timestamp(3));
+    EXPECT_EQ(tracker.finishBuffer(thirdBuffer), Timestamp(4));
+}
+
+/// Once a thread has finished its buffer, all of its positions must be smaller than the watermark of any later finished buffer
+TEST_F(TuplePositionTrackerTest, ConcurrentBuffers)
+{
+    constexpr uint64_t numberOfThreads = 8;
+    constexpr uint64_t numberOfBuffers = 1000;
+    constexpr uint64_t recordsPerBuffer = 10;
+    TuplePositionTracker tracker;
+    std::vector<std::atomic<bool>> inserted(numberOfThreads * numberOfBuffers * recordsPerBuffer);
+    std::atomic<bool> watermarkPassedMissingPosition{false};
+    {
+        std::vector<std::jthread> threads;
+        for (uint64_t thread = 0; thread < numberOfThreads; ++thread)
+        {
+            threads.emplace_back(
+                [&]
+                {
+                    uint64_t checkedPositions = 0;
+                    for (uint64_t buffer = 0; buffer < numberOfBuffers; ++buffer)
+                    {
+                        const auto lowerBound = tracker.beginBuffer();
+                        for (uint64_t record = 0; record < recordsPerBuffer; ++record)
+                        {
+                            const auto position = tracker.getNextPosition();
+                            EXPECT_GE(position, lowerBound);
+                            inserted[position] = true;
+                        }
+                        const auto watermark = tracker.finishBuffer(lowerBound).getRawValue();
+                        for (uint64_t position = checkedPositions; position < watermark; ++position)
+                        {
+                            if (not inserted[position])
+                            {
+                                watermarkPassedMissingPosition = true;
+                            }
+                        }
+                        checkedPositions = std::max(checkedPositions, watermark);
+                    }
+                });
+        }
+    }
+    EXPECT_FALSE(watermarkPassedMissingPosition);
+    EXPECT_EQ(tracker.beginBuffer(), numberOfThreads * numberOfBuffers * recordsPerBuffer);
+}
+
+}
@@ -0,0 +1,48 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <Util/HashMapType.hpp>
+#include <BaseUnitTest.hpp>
+#include <HashMapSlice.hpp>
+
+namespace NES::Testing
+{
+
+/// Returns the arguments of hash map slices with one cleanup function per input stream. The slices call the cleanup functions only for
+/// hash maps that contain tuples, which the hash maps of the tests never do, thus the cleanup functions are nullptr.
+inline CreateNewHashMapSliceArgs createHashMapSliceArgs(const uint64_t numberOfInputStreams = 1)
+{
+    return CreateNewHashMapSliceArgs{
+        std::vector<std::shared_ptr<CreateNewHashMapSliceArgs::NautilusCleanupExec>>(numberOfInputStreams, nullptr),
+        8,
+        8,
+        1024,
+        16,
+        HashMapType::CHAINED};
+}
+
+/// Fixture of the tests of the hash map slices, which store one hash map per input stream, worker thread, and partition (see HashMapSlice)
+class HashMapSliceTest : public BaseUnitTest
+{
+public:
+    static constexpr uint64_t NUMBER_OF_WORKER_THREADS = 3;
+    static constexpr uint64_t NUMBER_OF_PARTITIONS = 4;
+};
+
+}
@@ -45,6 +45,56 @@
 
 namespace NES
 {
+
+namespace
+{
+/// Set, once the parser pool of the thread is destroyed. It is trivially destructible, thus, valid until the thread exits.
+thread_local bool isParserPoolDestroyed = false;
+
+/// A new parser allocates its internal buffers for the full batch size. Thus, the field index functions of a thread reuse the parsers of
+/// the field index functions of the prior buffers that the thread formatted.
+struct ParserPool
+{
+    ParserPool() = default;
+    ParserPool(const ParserPool&) = delete;
+    ParserPool(ParserPool&&) = delete;
+    ParserPool& operator=(const ParserPool&) = delete;
+    ParserPool& operator=(ParserPool&&) = delete;
+    ~ParserPool() { isParserPoolDestroyed = true; }
+
+    std::vector<std::unique_ptr<simdjson::ondemand::parser>> parsers;
+};
+
+thread_local ParserPool parserPool;
+
+std::shared_ptr<simdjson::ondemand::parser> acquireParser()
+{
+    std::unique_ptr<simdjson::ondemand::parser> parser;
+    if (parserPool.parsers.empty())
+    {
+        parser = std::make_unique<simdjson::ondemand::parser>();
+        parser->threaded = false;
+    }
+    else
+    {
+        parser = std::move(parserPool.parsers.back());
+        parserPool.parsers.pop_back();
+    }
+    /// The thread releases the parser, when it resets its index phase result for the next buffer
+    return {
+        parser.release(),
+        [](simdjson::ondemand::parser* releasedParser)
+        {
+            if (isParserPoolDestroyed)
+            {
+                delete releasedParser; /// NOLINT(cppcoreguidelines-owning-memory)
+                return;
+            }
+            parserPool.parsers.emplace_back(releasedParser);
+        }};
+}
+}
+
 [[nodiscard]] nautilus::val<bool>
 SIMDJSONFIF::applyHasNext(const nautilus::val<uint64_t>&, const nautilus::val<SIMDJSONFIF*>& fieldIndexFunction)
 {
@@ -77,25 +127,6 @@ VarVal SIMDJSONFIF::parseJsonVarSized(
     return VarVal{VariableSizedData{varSizedString}, nullable, false};
 }
 
-bool checkIsNullJsonProxy(FieldIndex fieldIndex, const SIMDJSONFIF* fieldIndexFunction, const SIMDJSONMetaData* metaData) noexcept
-{
-    const auto& fieldName = metaData->getFieldNameInJsonAt(fieldIndex);
-    auto currentDoc = *fieldIndexFunction->getDocStreamIterator();
-
-    /// First, we check if the key is not in the doc. If this is the case, we can return true, as this counts as null
-    if (not currentDoc[fieldName].has_value())
-    {
-        return true;
-    }
-
-    /// Second, we need to check if the key is equal to one of the null values
-    if (SIMDJSONFIF::accessSIMDJsonFieldOrThrow(currentDoc, fieldName).is_null())
-    {
-        return true;
-    }
-    return false;
-}
-
 void SIMDJSONFIF::writeValueToRecord(
     const DataType dataType,
     Record& record,
@@ -118,7 +149,8 @@ void SIMDJSONFIF::writeValueToRecord(
             record.write(fieldName, parseJsonFixedSizeIntoVarVal<int32_t>(dataType.nullable, fieldIndex, fieldIndexFunction, metaData));
             return;
         }
-        case DataType::Type::INT64: {
+        case DataType::Type::INT64:
+        case DataType::Type::INTERVAL: {
             record.write(fieldName, parseJsonFixedSizeIntoVarVal<int64_t>(dataType.nullable, fieldIndex, fieldIndexFunction, metaData));
             return;
         }
@@ -134,7 +166,8 @@ void SIMDJSONFIF::writeValueToRecord(
             record.write(fieldName, parseJsonFixedSizeIntoVarVal<uint32_t>(dataType.nullable, fieldIndex, fieldIndexFunction, metaData));
             return;
         }
-        case DataType::Type::UINT64: {
+        case DataType::Type::UINT64:
+        case DataType::Type::TIMESTAMP: {
             record.write(fieldName, parseJsonFixedSizeIntoVarVal<uint64_t>(dataType.nullable, fieldIndex, fieldIndexFunction, metaData));
             return;
         }
@@ -158,6 +191,8 @@ void SIMDJSONFIF::writeValueToRecord(
             record.write(fieldName, parseJsonVarSized(fieldIndex, fieldIndexFunction, metaData, dataType.nullable));
             return;
         }
+        case DataType::Type::DECIMAL:
+            throw NotImplemented("The JSON input formatter does not support DECIMAL fields.");
         case DataType::Type::UNDEFINED:
             throw NotImplemented("Cannot parse undefined type.");
     }
@@ -185,8 +220,10 @@ std::pair<bool, FieldIndex> SIMDJSONFIF::indexJSON(const std::string_view jsonSV
 std::pair<bool, FieldIndex> SIMDJSONFIF::indexJSON(const std::string_view jsonSV, size_t batchSize)
 {
     const simdjson::padded_string_view paddedJSONSV{jsonSV.data(), jsonSV.size(), jsonSV.size() + simdjson::SIMDJSON_PADDING};
-    this->parser = std::make_shared<simdjson::ondemand::parser>();
-    this->parser->threaded = false;
+    if (not this->parser)
+    {
+        this->parser = acquireParser();
+    }
     if (jsonSV.size() > batchSize)
     {
         throw CannotFormatSourceData("Size of raw buffer: {} exceeds SIMDJSONs configured batch_size: {}", jsonSV.size(), batchSize);
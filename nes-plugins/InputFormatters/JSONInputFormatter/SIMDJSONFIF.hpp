@@ -28,6 +28,7 @@
 #include <simdjson.h>
 #include <DataTypes/DataType.hpp>
 #include <DataTypes/Schema.hpp>
+#include <Nautilus/DataTypes/VarSizedDictionary.hpp>
 #include <Nautilus/DataTypes/VarVal.hpp>
 #include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
 #include <Nautilus/Interface/Record.hpp>
@@ -71,11 +72,16 @@ requires(
 ParseResultFixed<T>*
 parseJsonFixedSizeIntoVarValProxy(FieldIndex fieldIndex, SIMDJSONFIF* fieldIndexFunction, const SIMDJSONMetaData* metaData);
 
-bool checkIsNullJsonProxy(FieldIndex fieldIndex, const SIMDJSONFIF* fieldIndexFunction, const SIMDJSONMetaData* metaData) noexcept;
+/// Looks up the field in the current document once. Returns nullopt, if the field is nullable and the key is missing or its value is null.
+template <bool Nullable>
+std::optional<simdjson::simdjson_result<simdjson::ondemand::value>>
+findJsonFieldProxy(FieldIndex fieldIndex, const SIMDJSONFIF* fieldIndexFunction, const SIMDJSONMetaData* metaData);
 
 struct SIMDJSONMetaData
 {
-    explicit SIMDJSONMetaData(const ParserConfig& config, const TupleBufferRef& tupleBufferRef)
+    /// The FIF skips the fields that are not in the projections, when it reads a record, thus the meta data does not need them
+    explicit SIMDJSONMetaData(
+        const ParserConfig& config, const TupleBufferRef& tupleBufferRef, const std::vector<Record::RecordFieldIdentifier>&)
         : fieldNamesOutput(tupleBufferRef.getAllFieldNames())
         , fieldDataTypes(tupleBufferRef.getAllDataTypes())
         , tupleDelimiter(config.tupleDelimiter)
@@ -126,6 +132,9 @@ struct SIMDJSONMetaData
         std::unreachable();
     }
 
+    /// The SIMDJSON input formatter does not dictionary-encode VARSIZED values (yet)
+    [[nodiscard]] static VarSizedDictionary* getDictionary() { return nullptr; }
+
     [[nodiscard]] uint64_t getNumberOfFields() const
     {
         INVARIANT(fieldNamesOutput.size() == fieldDataTypes.size(), "No. fields must be equal to no. data types");
@@ -225,6 +234,9 @@ class SIMDJSONFIF final : public FieldIndexFunction<SIMDJSONFIF>
 
 
 public:
+    /// Reading a record advances the document stream iterator, thus a formatter must read all fields of a record at once
+    static constexpr bool SUPPORTS_PARTIAL_RECORD_READS = false;
+
     SIMDJSONFIF() = default;
     ~SIMDJSONFIF() = default;
 
@@ -268,6 +280,23 @@ public:
         return simdJsonResult;
     }
 
+    /// Returns a view of a string value. A string without escape sequences is a view of the raw JSON, i.e., only strings with escape
+    /// sequences are unescaped (copied) into the string buffer of the parser.
+    static std::string_view
+    getStringViewOrThrow(simdjson::simdjson_result<simdjson::ondemand::value>& simdJsonValue, const std::string_view fieldName)
+    {
+        if (const auto rawToken = simdJsonValue.raw_json_token(); rawToken.has_value())
+        {
+            /// The raw token includes the quotes and all whitespace up to the next token
+            const auto token = rawToken.value().substr(0, rawToken.value().find_last_not_of(" \t\n\r") + 1);
+            if (token.size() >= 2 and token.front() == '"' and token.back() == '"' and token.find('\\') == std::string_view::npos)
+            {
+                return token.substr(1, token.size() - 2);
+            }
+        }
+        return parseSIMDJsonValueOrThrow(simdJsonValue.get_string(), simdJsonValue, "string", fieldName);
+    }
+
     [[nodiscard]] simdjson::ondemand::document_stream::iterator getDocStreamIterator() const { return docStreamIterator; }
 
 private:
@@ -282,6 +311,25 @@ private:
 
 static_assert(std::is_standard_layout_v<SIMDJSONFIF>, "SIMDJSONFIF must have a standard layout");
 
+template <bool Nullable>
+std::optional<simdjson::simdjson_result<simdjson::ondemand::value>>
+findJsonFieldProxy(const FieldIndex fieldIndex, const SIMDJSONFIF* fieldIndexFunction, const SIMDJSONMetaData* metaData)
+{
+    const auto& fieldName = metaData->getFieldNameInJsonAt(fieldIndex);
+    auto currentDoc = *fieldIndexFunction->getDocStreamIterator();
+    if constexpr (Nullable)
+    {
+        /// A missing key counts as null. Looking up the key a second time would scan over all other keys of the document again.
+        auto field = currentDoc[fieldName];
+        if (not field.has_value() or field.is_null())
+        {
+            return std::nullopt;
+        }
+        return field;
+    }
+    return SIMDJSONFIF::accessSIMDJsonFieldOrThrow(currentDoc, fieldName);
+}
+
 /// (Proxy) functions being called via nautius::invoke() can not be member functions. Thus, we need to implement them outside of the class
 template <typename T, bool Nullable>
 requires(
@@ -295,20 +343,16 @@ parseJsonFixedSizeIntoVarValProxy(const FieldIndex fieldIndex, SIMDJSONFIF* fiel
     thread_local static ParseResultFixed<T> result;
     result.isNull = false;
 
-    /// Checking if the field is null but only if the field is nullable
-    if constexpr (Nullable)
+    auto field = findJsonFieldProxy<Nullable>(fieldIndex, fieldIndexFunction, metaData);
+    if (not field.has_value())
     {
-        if (checkIsNullJsonProxy(fieldIndex, fieldIndexFunction, metaData))
-        {
-            result.isNull = true;
-            result.value = T{0};
-            return &result;
-        }
+        result.isNull = true;
+        result.value = T{0};
+        return &result;
     }
 
     const auto& fieldName = metaData->getFieldNameInJsonAt(fieldIndex);
-    auto currentDoc = *fieldIndexFunction->getDocStreamIterator();
-    auto simdJsonResult = SIMDJSONFIF::accessSIMDJsonFieldOrThrow(currentDoc, fieldName);
+    auto& simdJsonResult = field.value();
     /// Order is important, since signed_integral<char> is true and unsigned_integral<bool> is true
     if constexpr (std::same_as<T, bool>)
     {
@@ -317,10 +361,9 @@ parseJsonFixedSizeIntoVarValProxy(const FieldIndex fieldIndex, SIMDJSONFIF* fiel
     }
     else if constexpr (std::same_as<T, char>)
     {
-        const std::string_view valueSV = currentDoc[fieldName];
+        const auto valueSV = SIMDJSONFIF::getStringViewOrThrow(simdJsonResult, fieldName);
         PRECONDITION(valueSV.size() == 1, "Cannot take {} as character, because size is not 1", valueSV);
-        result.value
-            = static_cast<T>(SIMDJSONFIF::parseSIMDJsonValueOrThrow(simdJsonResult.get_string(), simdJsonResult, "char", fieldName)[0]);
+        result.value = static_cast<T>(valueSV[0]);
         return &result;
     }
     else if constexpr (std::signed_integral<T>)
@@ -361,27 +404,21 @@ ParsedResultVariableSized* parseJsonVarSizedProxy(FieldIndex fieldIndex, SIMDJSO
     /// the size of the var sized and the pointer to it
     thread_local static ParsedResultVariableSized result{};
 
-    /// Checking if the field is null but only if the field is nullable
-    if constexpr (Nullable)
-    {
-        if (checkIsNullJsonProxy(fieldIndex, fieldIndexFunction, metaData))
-        {
-            constexpr auto sizeOfValue = 0;
-            result = ParsedResultVariableSized{.varSizedPointer = nullptr, .size = sizeOfValue, .isNull = true};
-            return &result;
-        }
-    }
-
     INVARIANT(
         fieldIndex < metaData->getNumberOfFields(),
         "fieldIndex {} is out or bounds for schema keys of size: {}",
         fieldIndex,
         metaData->getNumberOfFields());
-    auto currentDoc = *fieldIndexFunction->getDocStreamIterator();
-    const auto& fieldName = metaData->getFieldNameInJsonAt(fieldIndex);
+    auto field = findJsonFieldProxy<Nullable>(fieldIndex, fieldIndexFunction, metaData);
+    if (not field.has_value())
+    {
+        constexpr auto sizeOfValue = 0;
+        result = ParsedResultVariableSized{.varSizedPointer = nullptr, .size = sizeOfValue, .isNull = true};
+        return &result;
+    }
 
-    /// Get the value from the document and convert it to a span of bytes
-    const std::string_view value = SIMDJSONFIF::accessSIMDJsonFieldOrThrow(currentDoc, fieldName);
+    /// Get the value from the document as a view of its bytes
+    const auto value = SIMDJSONFIF::getStringViewOrThrow(field.value(), metaData->getFieldNameInJsonAt(fieldIndex));
 
     result = ParsedResultVariableSized{.varSizedPointer = value.data(), .size = value.size(), .isNull = false};
     return &result;
@@ -14,6 +14,7 @@
 
 #include <ChecksumSink.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <filesystem>
 #include <iostream>
@@ -22,6 +23,7 @@
 #include <system_error>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 #include <Configurations/Descriptor.hpp>
 #include <DataTypes/DataType.hpp>
 #include <Runtime/TupleBuffer.hpp>
@@ -38,6 +40,11 @@
 namespace NES
 {
 
+namespace
+{
+thread_local std::string tlFormattedBuffer;
+}
+
 ChecksumSink::ChecksumSink(BackpressureController backpressureController, const SinkDescriptor& sinkDescriptor)
     : Sink(std::move(backpressureController))
     , isOpen(false)
@@ -46,9 +53,10 @@ ChecksumSink::ChecksumSink(BackpressureController backpressureController, const
 {
 }
 
-void ChecksumSink::start(PipelineExecutionContext&)
+void ChecksumSink::start(PipelineExecutionContext& pipelineExecutionContext)
 {
     NES_DEBUG("Setting up checksum sink: {}", *this);
+    workerChecksums = std::vector<WorkerChecksum>(std::max<size_t>(pipelineExecutionContext.getNumberOfWorkerThreads(), 1));
     if (std::filesystem::exists(outputFilePath.c_str()))
     {
         std::error_code ec;
@@ -76,6 +84,12 @@ void ChecksumSink::start(PipelineExecutionContext&)
 
 void ChecksumSink::stop(PipelineExecutionContext&)
 {
+    Checksum checksum;
+    for (const auto& workerChecksum : workerChecksums)
+    {
+        checksum.checksum += workerChecksum.checksum.checksum;
+        checksum.numberOfTuples += workerChecksum.checksum.numberOfTuples;
+    }
     NES_INFO("Checksum Sink completed. Checksum: {}", fmt::streamed(checksum));
 
     outputFileStream << "S$Count:UINT64:" << magic_enum::enum_name(DataType::NULLABLE::NOT_NULLABLE)
@@ -85,11 +99,13 @@ void ChecksumSink::stop(PipelineExecutionContext&)
     isOpen = false;
 }
 
-void ChecksumSink::execute(const TupleBuffer& inputBuffer, PipelineExecutionContext&)
+void ChecksumSink::execute(const TupleBuffer& inputBuffer, PipelineExecutionContext& pipelineExecutionContext)
 {
     PRECONDITION(inputBuffer, "Invalid input buffer in ChecksumSink.");
-    const std::string formatted = formatter->getFormattedBuffer(inputBuffer);
-    checksum.add(formatted);
+    tlFormattedBuffer.clear();
+    formatter->formatBuffer(inputBuffer, tlFormattedBuffer);
+    /// The checksum of a worker thread is only contended if there are more worker threads than checksums
+    workerChecksums[pipelineExecutionContext.getId().getRawValue() % workerChecksums.size()].checksum.add(tlFormattedBuffer);
 }
 
 DescriptorConfig::Config ChecksumSink::validateAndFormat(std::unordered_map<std::string, std::string> config)
@@ -17,11 +17,13 @@
 #include <cstddef>
 #include <fstream>
 #include <memory>
+#include <new>
 #include <optional>
 #include <ostream>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 #include <Configurations/Descriptor.hpp>
 #include <Runtime/TupleBuffer.hpp>
 #include <Sinks/Sink.hpp>
@@ -57,7 +59,13 @@ private:
     bool isOpen;
     std::string outputFilePath;
     std::ofstream outputFileStream;
-    Checksum checksum;
+    /// Each worker thread accumulates into its own checksum, which avoids contention on a shared cache line.
+    /// The checksums of all worker threads are merged once the query is stopped.
+    struct alignas(std::hardware_destructive_interference_size) WorkerChecksum
+    {
+        Checksum checksum;
+    };
+    std::vector<WorkerChecksum> workerChecksums;
     std::unique_ptr<Format> formatter;
 };
 
@@ -0,0 +1,166 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Runtime/BufferManager.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sinks/SinkCatalog.hpp>
+#include <SinksParsing/CSVFormat.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <BackpressureChannel.hpp>
+#include <BaseUnitTest.hpp>
+#include <Checksum.hpp>
+#include <ChecksumSink.hpp>
+#include <TestTaskQueue.hpp>
+
+namespace NES
+{
+
+class ChecksumSinkTest : public Testing::BaseUnitTest
+{
+public:
+    static constexpr uint64_t BUFFER_SIZE = 4096;
+    static constexpr uint64_t TUPLES_PER_BUFFER = 16;
+    static constexpr uint64_t BUFFERS_PER_WORKER = 64;
+    static constexpr size_t NUMBER_OF_WORKERS = 4;
+
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("ChecksumSinkTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup ChecksumSinkTest class.");
+    }
+
+    void SetUp() override
+    {
+        Testing::BaseUnitTest::SetUp();
+        bufferManager = BufferManager::create(BUFFER_SIZE, 64);
+        schema = Schema{}.addField("stream$id", DataType::Type::UINT64).addField("stream$value", DataType::Type::UINT64);
+        outputPath = std::filesystem::temp_directory_path()
+            / fmt::format("ChecksumSinkTest_{}.out", ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove(outputPath);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(outputPath);
+        Testing::BaseUnitTest::TearDown();
+    }
+
+    [[nodiscard]] TupleBuffer createInputBuffer(const uint64_t bufferIndex) const
+    {
+        auto buffer = bufferManager->getBufferBlocking();
+        for (uint64_t tupleIndex = 0; tupleIndex < TUPLES_PER_BUFFER; ++tupleIndex)
+        {
+            const std::array<uint64_t, 2> values{(bufferIndex * TUPLES_PER_BUFFER) + tupleIndex, bufferIndex};
+            std::memcpy(buffer.getAvailableMemoryArea().data() + (tupleIndex * sizeof(values)), values.data(), sizeof(values));
+        }
+        buffer.setNumberOfTuples(TUPLES_PER_BUFFER);
+        return buffer;
+    }
+
+    /// The output of a single checksum that accumulated the CSV output of the input buffers [0, numberOfBuffers)
+    [[nodiscard]] std::string getExpectedChecksum(const uint64_t numberOfBuffers) const
+    {
+        const CSVFormat format(schema, true);
+        Checksum checksum;
+        for (uint64_t bufferIndex = 0; bufferIndex < numberOfBuffers; ++bufferIndex)
+        {
+            std::string formattedBuffer;
+            format.formatBuffer(createInputBuffer(bufferIndex), formattedBuffer);
+            checksum.add(formattedBuffer);
+        }
+        return fmt::format("{},{}", checksum.numberOfTuples.load(), checksum.checksum.load());
+    }
+
+    /// Starts the sink with the given number of worker threads and lets NUMBER_OF_WORKERS threads write disjoint input buffers concurrently
+    [[nodiscard]] std::string writeConcurrently(const uint64_t numberOfWorkerThreads) const
+    {
+        auto [backpressureController, backpressureListener] = createBackpressureChannel();
+        const auto sinkDescriptor = SinkCatalog{}.getInlineSink(schema, ChecksumSink::NAME, {{"file_path", outputPath.string()}});
+        EXPECT_TRUE(sinkDescriptor.has_value());
+        /// NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+        ChecksumSink sink(std::move(backpressureController), *sinkDescriptor);
+
+        const auto resultBuffers = std::make_shared<std::vector<std::vector<TupleBuffer>>>(NUMBER_OF_WORKERS);
+        std::vector<TestPipelineExecutionContext> contexts;
+        contexts.reserve(NUMBER_OF_WORKERS);
+        for (size_t worker = 0; worker < NUMBER_OF_WORKERS; ++worker)
+        {
+            auto& context = contexts.emplace_back(
+                bufferManager, WorkerThreadId(static_cast<uint32_t>(worker)), PipelineId(1), resultBuffers);
+            context.numberOfWorkerThreads = numberOfWorkerThreads;
+        }
+
+        sink.start(contexts.front());
+        {
+            std::vector<std::jthread> workers;
+            for (size_t worker = 0; worker < NUMBER_OF_WORKERS; ++worker)
+            {
+                workers.emplace_back(
+                    [&, worker]
+                    {
+                        for (uint64_t bufferIndex = worker; bufferIndex < NUMBER_OF_WORKERS * BUFFERS_PER_WORKER;
+                             bufferIndex += NUMBER_OF_WORKERS)
+                        {
+                            sink.execute(createInputBuffer(bufferIndex), contexts[worker]);
+                        }
+                    });
+            }
+        }
+        sink.stop(contexts.front());
+
+        std::ifstream file(outputPath);
+        std::string schemaLine;
+        std::string checksumLine;
+        std::getline(file, schemaLine);
+        std::getline(file, checksumLine);
+        return checksumLine;
+    }
+
+    std::shared_ptr<BufferManager> bufferManager;
+    Schema schema;
+    std::filesystem::path outputPath;
+};
+
+/// Every worker thread accumulates into its own checksum, which the sink merges on stop
+TEST_F(ChecksumSinkTest, MergesTheChecksumsOfAllWorkerThreads)
+{
+    EXPECT_EQ(writeConcurrently(NUMBER_OF_WORKERS), getExpectedChecksum(NUMBER_OF_WORKERS * BUFFERS_PER_WORKER));
+}
+
+/// Worker threads share the checksums, if there are more worker threads than checksums
+TEST_F(ChecksumSinkTest, MergesTheChecksumsOfWorkerThreadsThatShareAChecksum)
+{
+    EXPECT_EQ(writeConcurrently(2), getExpectedChecksum(NUMBER_OF_WORKERS * BUFFERS_PER_WORKER));
+}
+
+}
@@ -0,0 +1,372 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+#include <KafkaSink.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <Configurations/Descriptor.hpp>
+#include <DataTypes/DataType.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sinks/Sink.hpp>
+#include <Sinks/SinkDescriptor.hpp>
+#include <SinksParsing/CSVFormat.hpp>
+#include <SinksParsing/Format.hpp>
+#include <SinksParsing/JSONFormat.hpp>
+#include <SinksParsing/NativeFormat.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+#include <librdkafka/rdkafka.h>
+#include <magic_enum/magic_enum.hpp>
+#include <BackpressureChannel.hpp>
+#include <ErrorHandling.hpp>
+#include <PipelineExecutionContext.hpp>
+#include <SinkRegistry.hpp>
+#include <SinkValidationRegistry.hpp>
+
+namespace NES
+{
+
+namespace
+{
+/// The key of a record, as a range of the keys that a worker thread collected for its buffer
+struct KeyRange
+{
+    size_t offset = 0;
+    size_t size = 0;
+    bool isNull = true;
+};
+
+/// Reused by the worker threads to collect the records of a buffer without allocating
+thread_local std::string tlFormattedBuffer;
+thread_local std::string tlKeys;
+thread_local std::vector<KeyRange> tlKeyRanges;
+thread_local std::vector<rd_kafka_message_t> tlRecords;
+}
+
+KafkaSink::KafkaSink(BackpressureController backpressureController, const SinkDescriptor& sinkDescriptor)
+    : Sink(std::move(backpressureController))
+    , brokers(sinkDescriptor.getFromConfig(ConfigParametersKafkaSink::BROKERS))
+    , topic(sinkDescriptor.getFromConfig(ConfigParametersKafkaSink::TOPIC))
+    , lingerMs(sinkDescriptor.getFromConfig(ConfigParametersKafkaSink::LINGER_MS))
+    , batchSize(sinkDescriptor.getFromConfig(ConfigParametersKafkaSink::BATCH_SIZE))
+    , maxQueuedRecords(sinkDescriptor.getFromConfig(ConfigParametersKafkaSink::MAX_QUEUED_RECORDS))
+    , isNative(sinkDescriptor.getFromConfig(SinkDescriptor::INPUT_FORMAT) == InputFormat::NATIVE)
+    , sizeOfTuple(sinkDescriptor.getSchema()->getSizeOfSchemaInBytes())
+{
+    if (maxQueuedRecords == 0)
+    {
+        throw InvalidConfigParameter("The Kafka sink requires a kafka_max_queued_records of at least 1");
+    }
+
+    const auto& schema = *sinkDescriptor.getSchema();
+    if (const auto keyFieldName = sinkDescriptor.getFromConfig(ConfigParametersKafkaSink::KEY_FIELD); not keyFieldName.empty())
+    {
+        if (isNative)
+        {
+            throw InvalidConfigParameter("The Kafka sink does not support a kafka_key_field for the NATIVE format");
+        }
+        const auto field = schema.getFieldByName(keyFieldName);
+        if (not field.has_value())
+        {
+            throw InvalidConfigParameter("The key field {} is not a field of the schema {}", keyFieldName, schema);
+        }
+        size_t offset = 0;
+        for (const auto& candidate : schema.getFields())
+        {
+            if (candidate.name == field->name)
+            {
+                keyField = KeyField{.type = candidate.dataType, .offset = offset};
+                break;
+            }
+            offset += candidate.dataType.getSizeInBytesWithNull();
+        }
+    }
+
+    const auto inputFormat = sinkDescriptor.getFromConfig(SinkDescriptor::INPUT_FORMAT);
+    switch (inputFormat)
+    {
+        case InputFormat::CSV:
+            formatter = std::make_unique<CSVFormat>(schema);
+            break;
+        case InputFormat::JSON:
+            formatter = std::make_unique<JSONFormat>(schema);
+            break;
+        case InputFormat::NATIVE:
+            formatter = std::make_unique<NativeFormat>(schema);
+            break;
+        default:
+            throw UnknownSinkFormat(fmt::format("Sink format: {} not supported.", magic_enum::enum_name(inputFormat)));
+    }
+}
+
+KafkaSink::~KafkaSink()
+{
+    /// The poll thread uses the producer
+    pollThread = {};
+    if (topicHandle != nullptr)
+    {
+        rd_kafka_topic_destroy(topicHandle);
+    }
+    if (producer != nullptr)
+    {
+        rd_kafka_destroy(producer);
+    }
+}
+
+std::ostream& KafkaSink::toString(std::ostream& str) const
+{
+    str << fmt::format(
+        "KafkaSink(brokers: {}, topic: {}, keyField: {}, lingerMs: {}, batchSize: {}, maxQueuedRecords: {})",
+        brokers,
+        topic,
+        keyField.has_value(),
+        lingerMs,
+        batchSize,
+        maxQueuedRecords);
+    return str;
+}
+
+void KafkaSink::start(PipelineExecutionContext&)
+{
+    NES_DEBUG("Setting up Kafka sink: {}", *this);
+    std::array<char, 512> errorString{};
+    auto* conf = rd_kafka_conf_new();
+    /// The producer queue holds twice the records at which the sink applies backpressure, so that the records of the buffers that the
+    /// worker threads format until the sources react to the backpressure rarely find the queue full
+    const auto queueCapacity = std::min<uint64_t>(maxQueuedRecords * 2, std::numeric_limits<int32_t>::max());
+    const std::unordered_map<std::string, std::string> properties{
+        {"bootstrap.servers", brokers},
+        {"linger.ms", std::to_string(lingerMs)},
+        {"batch.num.messages", std::to_string(batchSize)},
+        {"queue.buffering.max.messages", std::to_string(queueCapacity)}};
+    for (const auto& [property, value] : properties)
+    {
+        if (rd_kafka_conf_set(conf, property.c_str(), value.c_str(), errorString.data(), errorString.size()) != RD_KAFKA_CONF_OK)
+        {
+            rd_kafka_conf_destroy(conf);
+            throw CannotOpenSink("Could not set the Kafka property {} to {}: {}", property, value, errorString.data());
+        }
+    }
+    rd_kafka_conf_set_dr_msg_cb(conf, &KafkaSink::onDelivery);
+    rd_kafka_conf_set_opaque(conf, this);
+
+    /// On success, the producer takes the ownership of the configuration
+    producer = rd_kafka_new(RD_KAFKA_PRODUCER, conf, errorString.data(), errorString.size());
+    if (producer == nullptr)
+    {
+        rd_kafka_conf_destroy(conf);
+        throw CannotOpenSink("Could not create a Kafka producer for {}: {}", brokers, errorString.data());
+    }
+    topicHandle = rd_kafka_topic_new(producer, topic.c_str(), nullptr);
+    if (topicHandle == nullptr)
+    {
+        throw CannotOpenSink("Could not create the Kafka topic handle {}: {}", topic, rd_kafka_err2str(rd_kafka_last_error()));
+    }
+    pollThread = std::jthread([this](const std::stop_token& stopToken) { poll(stopToken); });
+}
+
+void KafkaSink::onDelivery(rd_kafka_t*, const rd_kafka_message_t* record, void* opaque)
+{
+    if (record->err == RD_KAFKA_RESP_ERR_NO_ERROR)
+    {
+        return;
+    }
+    auto* sink = static_cast<KafkaSink*>(opaque);
+    sink->lastDeliveryError.store(record->err, std::memory_order_relaxed);
+    sink->failedRecords.fetch_add(1, std::memory_order_relaxed);
+}
+
+void KafkaSink::poll(const std::stop_token& stopToken)
+{
+    while (not stopToken.stop_requested())
+    {
+        rd_kafka_poll(producer, static_cast<int>(POLL_INTERVAL.count()));
+        /// The producer counts the records until their delivery report was served, i.e., until the brokers acknowledged them
+        const auto queuedRecords = static_cast<uint64_t>(rd_kafka_outq_len(producer));
+        if (not appliesBackpressure and queuedRecords > maxQueuedRecords)
+        {
+            NES_DEBUG("Kafka sink applies backpressure, as {} records are not acknowledged", queuedRecords);
+            backpressureController.applyPressure();
+            appliesBackpressure = true;
+        }
+        else if (appliesBackpressure and queuedRecords <= maxQueuedRecords / 2)
+        {
+            backpressureController.releasePressure();
+            appliesBackpressure = false;
+        }
+    }
+}
+
+void KafkaSink::checkDeliveries() const
+{
+    if (const auto failed = failedRecords.load(std::memory_order_relaxed); failed > 0)
+    {
+        throw CannotWriteSink(
+            "Kafka failed to deliver {} records to topic {}: {}",
+            failed,
+            topic,
+            rd_kafka_err2str(lastDeliveryError.load(std::memory_order_relaxed)));
+    }
+}
+
+bool KafkaSink::appendKey(const TupleBuffer& inputBuffer, const size_t tupleIndex, std::string& keys) const
+{
+    auto value = inputBuffer.getAvailableMemoryArea().subspan(tupleIndex * sizeOfTuple + keyField->offset);
+    if (keyField->type.nullable)
+    {
+        if (std::to_integer<bool>(value[0]))
+        {
+            return false;
+        }
+        value = value.subspan(1);
+    }
+    if (keyField->type.type == DataType::Type::VARSIZED)
+    {
+        keys.append(Format::readVarSizedData(inputBuffer, Format::readVariableSizedAccess(value.data())));
+        return true;
+    }
+    Format::appendFormattedValue(keys, keyField->type, value.data());
+    return true;
+}
+
+void KafkaSink::execute(const TupleBuffer& inputTupleBuffer, PipelineExecutionContext&)
+{
+    PRECONDITION(inputTupleBuffer, "Invalid input buffer in KafkaSink.");
+    PRECONDITION(producer != nullptr, "Sink was not started");
+    checkDeliveries();
+
+    tlFormattedBuffer.clear();
+    formatter->formatBuffer(inputTupleBuffer, tlFormattedBuffer);
+    tlRecords.clear();
+    if (isNative)
+    {
+        auto& record = tlRecords.emplace_back();
+        record.payload = tlFormattedBuffer.data();
+        record.len = tlFormattedBuffer.size();
+        produce(tlRecords);
+        return;
+    }
+
+    /// The CSV and JSON formats end every tuple with a newline. Thus, the records split a string that contains newlines, which the
+    /// KafkaSource would split into multiple tuples as well.
+    tlKeys.clear();
+    tlKeyRanges.clear();
+    const auto numberOfTuples = inputTupleBuffer.getNumberOfTuples();
+    for (size_t begin = 0; begin < tlFormattedBuffer.size();)
+    {
+        const auto end = std::min(tlFormattedBuffer.find('\n', begin), tlFormattedBuffer.size());
+        auto& record = tlRecords.emplace_back();
+        record.payload = tlFormattedBuffer.data() + begin;
+        record.len = end - begin;
+        if (keyField.has_value() and tlKeyRanges.size() < numberOfTuples)
+        {
+            const auto offset = tlKeys.size();
+            const auto hasKey = appendKey(inputTupleBuffer, tlKeyRanges.size(), tlKeys);
+            tlKeyRanges.push_back({.offset = offset, .size = tlKeys.size() - offset, .isNull = not hasKey});
+        }
+        begin = end + 1;
+    }
+    /// The keys point into the collected keys only once they stopped growing
+    for (size_t i = 0; i < tlKeyRanges.size(); ++i)
+    {
+        if (not tlKeyRanges[i].isNull)
+        {
+            tlRecords[i].key = tlKeys.data() + tlKeyRanges[i].offset;
+            tlRecords[i].key_len = tlKeyRanges[i].size;
+        }
+    }
+    produce(tlRecords);
+}
+
+void KafkaSink::produce(std::span<rd_kafka_message_t> records)
+{
+    while (not records.empty())
+    {
+        /// The producer copies the payloads (and keys), and the partitioner assigns every record to the partition of its key
+        const auto enqueued = rd_kafka_produce_batch(
+            topicHandle, RD_KAFKA_PARTITION_UA, RD_KAFKA_MSG_F_COPY, records.data(), static_cast<int>(records.size()));
+        if (static_cast<size_t>(enqueued) == records.size())
+        {
+            return;
+        }
+
+        /// Retries the records that did not fit into the producer queue (in their order), once the brokers acknowledged some records.
+        /// This only happens if the worker threads outpace the backpressure, e.g., if the brokers are unavailable.
+        size_t remaining = 0;
+        for (const auto& record : records)
+        {
+            if (record.err == RD_KAFKA_RESP_ERR_NO_ERROR)
+            {
+                continue;
+            }
+            if (record.err != RD_KAFKA_RESP_ERR__QUEUE_FULL)
+            {
+                throw CannotWriteSink("Could not produce a record to topic {}: {}", topic, rd_kafka_err2str(record.err));
+            }
+            records[remaining++] = record;
+        }
+        records = records.first(remaining);
+        std::this_thread::sleep_for(POLL_INTERVAL);
+        checkDeliveries();
+    }
+}
+
+void KafkaSink::stop(PipelineExecutionContext&)
+{
+    pollThread = {};
+    if (appliesBackpressure)
+    {
+        backpressureController.releasePressure();
+        appliesBackpressure = false;
+    }
+    if (rd_kafka_flush(producer, static_cast<int>(std::chrono::milliseconds(FLUSH_TIMEOUT).count())) != RD_KAFKA_RESP_ERR_NO_ERROR)
+    {
+        throw CannotWriteSink(
+            "Kafka did not acknowledge {} records to topic {} within {}", rd_kafka_outq_len(producer), topic, FLUSH_TIMEOUT);
+    }
+    checkDeliveries();
+    NES_DEBUG("Closed Kafka sink, topic={}", topic);
+}
+
+DescriptorConfig::Config KafkaSink::validateAndFormat(std::unordered_map<std::string, std::string> config)
+{
+    return DescriptorConfig::validateAndFormat<ConfigParametersKafkaSink>(std::move(config), NAME);
+}
+
+SinkValidationRegistryReturnType RegisterKafkaSinkValidation(SinkValidationRegistryArguments sinkConfig)
+{
+    return KafkaSink::validateAndFormat(std::move(sinkConfig.config));
+}
+
+SinkRegistryReturnType RegisterKafkaSink(SinkRegistryArguments sinkRegistryArguments)
+{
+    return std::make_unique<KafkaSink>(std::move(sinkRegistryArguments.backpressureController), sinkRegistryArguments.sinkDescriptor);
+}
+
+}
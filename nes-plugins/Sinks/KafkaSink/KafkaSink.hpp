@@ -0,0 +1,151 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <Configurations/Descriptor.hpp>
+#include <DataTypes/DataType.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sinks/Sink.hpp>
+#include <Sinks/SinkDescriptor.hpp>
+#include <SinksParsing/Format.hpp>
+#include <Util/Logger/Formatter.hpp>
+#include <librdkafka/rdkafka.h>
+#include <PipelineExecutionContext.hpp>
+
+namespace NES
+{
+
+/// Produces the tuples of a query to a Kafka topic. For the CSV and JSON formats, every tuple becomes a record of its own (without the
+/// trailing newline, which the KafkaSource appends again), for the NATIVE format every tuple buffer becomes a record holding its frame.
+/// Worker threads only enqueue the records of their buffer into the producer of librdkafka, which batches them per partition and sends
+/// the batches asynchronously. A background thread serves the delivery reports and applies backpressure, while the producer queue holds
+/// more than 'kafka_max_queued_records' records, so that the worker threads do not wait for the acknowledgements of the brokers.
+/// Records are keyed by the value of 'kafka_key_field', if set, so that the partitioner of librdkafka assigns all tuples with the same
+/// key to the same partition. A record without a key (or with a null key) goes to a random partition.
+class KafkaSink final : public Sink
+{
+public:
+    static constexpr std::string_view NAME = "Kafka";
+    explicit KafkaSink(BackpressureController backpressureController, const SinkDescriptor& sinkDescriptor);
+    ~KafkaSink() override;
+
+    KafkaSink(const KafkaSink&) = delete;
+    KafkaSink& operator=(const KafkaSink&) = delete;
+    KafkaSink(KafkaSink&&) = delete;
+    KafkaSink& operator=(KafkaSink&&) = delete;
+
+    /// Creates the producer and starts the thread that serves its delivery reports
+    void start(PipelineExecutionContext& pipelineExecutionContext) override;
+    void execute(const TupleBuffer& inputTupleBuffer, PipelineExecutionContext& pipelineExecutionContext) override;
+    /// Waits until the brokers acknowledged all records, or the flush timeout passed
+    void stop(PipelineExecutionContext& pipelineExecutionContext) override;
+
+    static DescriptorConfig::Config validateAndFormat(std::unordered_map<std::string, std::string> config);
+
+protected:
+    std::ostream& toString(std::ostream& str) const override;
+
+private:
+    static constexpr std::chrono::milliseconds POLL_INTERVAL{1};
+    static constexpr std::chrono::seconds FLUSH_TIMEOUT{30};
+
+    struct KeyField
+    {
+        DataType type;
+        size_t offset;
+    };
+
+    static void onDelivery(rd_kafka_t* producer, const rd_kafka_message_t* record, void* opaque);
+
+    /// Serves the delivery reports and applies backpressure while the producer queue is full
+    void poll(const std::stop_token& stopToken);
+    /// Enqueues the records, waiting for the producer queue to drain if it is full
+    void produce(std::span<rd_kafka_message_t> records);
+    /// Throws, if the producer failed to deliver a record
+    void checkDeliveries() const;
+    /// Appends the key of the tuple to 'keys', unless it is null
+    [[nodiscard]] bool appendKey(const TupleBuffer& inputBuffer, size_t tupleIndex, std::string& keys) const;
+
+    std::string brokers;
+    std::string topic;
+    uint32_t lingerMs;
+    uint32_t batchSize;
+    uint64_t maxQueuedRecords;
+    bool isNative;
+    size_t sizeOfTuple;
+    std::optional<KeyField> keyField;
+    std::unique_ptr<Format> formatter;
+
+    rd_kafka_t* producer = nullptr;
+    rd_kafka_topic_t* topicHandle = nullptr;
+    std::atomic<uint64_t> failedRecords{0};
+    std::atomic<rd_kafka_resp_err_t> lastDeliveryError{RD_KAFKA_RESP_ERR_NO_ERROR};
+    /// Only the poll thread changes the backpressure, until stop joined it
+    bool appliesBackpressure = false;
+    std::jthread pollThread;
+};
+
+struct ConfigParametersKafkaSink
+{
+    /// Comma separated list of the bootstrap brokers (bootstrap.servers)
+    static inline const DescriptorConfig::ConfigParameter<std::string> BROKERS{
+        "kafka_brokers",
+        std::nullopt,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(BROKERS, config); }};
+    static inline const DescriptorConfig::ConfigParameter<std::string> TOPIC{
+        "kafka_topic",
+        std::nullopt,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(TOPIC, config); }};
+    /// The output field whose value keys the records, or empty to distribute the records randomly across the partitions
+    static inline const DescriptorConfig::ConfigParameter<std::string> KEY_FIELD{
+        "kafka_key_field",
+        "",
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(KEY_FIELD, config); }};
+    /// How long the producer collects the records of a partition into a batch, before it sends the batch (linger.ms)
+    static inline const DescriptorConfig::ConfigParameter<uint32_t> LINGER_MS{
+        "kafka_linger_ms",
+        5,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(LINGER_MS, config); }};
+    /// Maximum number of records in a batch of a partition (batch.num.messages)
+    static inline const DescriptorConfig::ConfigParameter<uint32_t> BATCH_SIZE{
+        "kafka_batch_size",
+        10000,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(BATCH_SIZE, config); }};
+    /// The sink applies backpressure, while more records than this wait for their acknowledgement, and releases it at half of them
+    static inline const DescriptorConfig::ConfigParameter<uint64_t> MAX_QUEUED_RECORDS{
+        "kafka_max_queued_records",
+        100000,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(MAX_QUEUED_RECORDS, config); }};
+
+    static inline std::unordered_map<std::string, DescriptorConfig::ConfigParameterContainer> parameterMap
+        = DescriptorConfig::createConfigParameterContainerMap(
+            SinkDescriptor::parameterMap, BROKERS, TOPIC, KEY_FIELD, LINGER_MS, BATCH_SIZE, MAX_QUEUED_RECORDS);
+};
+
+}
+
+FMT_OSTREAM(NES::KafkaSink);
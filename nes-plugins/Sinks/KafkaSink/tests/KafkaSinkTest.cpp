@@ -0,0 +1,410 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Runtime/BufferManager.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sinks/SinkCatalog.hpp>
+#include <SinksParsing/CSVFormat.hpp>
+#include <SinksParsing/Format.hpp>
+#include <SinksParsing/JSONFormat.hpp>
+#include <SinksParsing/NativeFormat.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <librdkafka/rdkafka.h>
+#include <librdkafka/rdkafka_mock.h>
+#include <BackpressureChannel.hpp>
+#include <BaseUnitTest.hpp>
+#include <ErrorHandling.hpp>
+#include <KafkaSink.hpp>
+#include <TestTaskQueue.hpp>
+
+namespace NES
+{
+
+/// Produces to the mock cluster of librdkafka, which serves the produce requests in process and injects errors into its responses
+class KafkaSinkTest : public Testing::BaseUnitTest
+{
+public:
+    static constexpr auto TOPIC = "records";
+    static constexpr int32_t PARTITIONS = 4;
+    static constexpr int32_t BROKER_ID = 1;
+    /// The public API of the mock cluster identifies requests by the API key of the Kafka protocol
+    static constexpr int16_t PRODUCE_API_KEY = 0;
+    static constexpr int TIMEOUT_MS = 10000;
+    static constexpr uint64_t BUFFER_SIZE = 4096;
+    static constexpr uint64_t TUPLES_PER_BUFFER = 100;
+    static constexpr uint64_t NUMBER_OF_BUFFERS = 3;
+    /// The row layout of the schema: the null byte and the value of the key, and the value
+    static constexpr size_t KEY_OFFSET = 0;
+    static constexpr size_t VALUE_OFFSET = 1 + sizeof(uint64_t);
+    static constexpr size_t SIZE_OF_TUPLE = VALUE_OFFSET + sizeof(uint64_t);
+
+    struct Record
+    {
+        int32_t partition;
+        std::optional<std::string> key;
+        std::string payload;
+    };
+
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("KafkaSinkTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup KafkaSinkTest class.");
+    }
+
+    void SetUp() override
+    {
+        Testing::BaseUnitTest::SetUp();
+        bufferManager = BufferManager::create(BUFFER_SIZE, 64);
+        schema = Schema{}
+                     .addField("stream$key", DataType::Type::UINT64, DataType::NULLABLE::IS_NULLABLE)
+                     .addField("stream$value", DataType::Type::UINT64);
+        ASSERT_EQ(schema.getSizeOfSchemaInBytes(), SIZE_OF_TUPLE);
+
+        std::array<char, 512> errorString{};
+        auto* conf = rd_kafka_conf_new();
+        ASSERT_EQ(rd_kafka_conf_set(conf, "test.mock.num.brokers", "1", errorString.data(), errorString.size()), RD_KAFKA_CONF_OK);
+        /// The handle only owns the mock cluster, the sink and the consumers of the tests connect to its brokers
+        clusterHandle = rd_kafka_new(RD_KAFKA_PRODUCER, conf, errorString.data(), errorString.size());
+        ASSERT_NE(clusterHandle, nullptr) << errorString.data();
+        cluster = rd_kafka_handle_mock_cluster(clusterHandle);
+        ASSERT_NE(cluster, nullptr);
+        brokers = rd_kafka_mock_cluster_bootstraps(cluster);
+        ASSERT_EQ(rd_kafka_mock_topic_create(cluster, TOPIC, PARTITIONS, 1), RD_KAFKA_RESP_ERR_NO_ERROR);
+    }
+
+    void TearDown() override
+    {
+        if (clusterHandle != nullptr)
+        {
+            rd_kafka_destroy(clusterHandle);
+        }
+        Testing::BaseUnitTest::TearDown();
+    }
+
+    /// Every fifth key is null, and many tuples share their key
+    static std::optional<uint64_t> getKey(const uint64_t value)
+    {
+        return value % 5 == 0 ? std::nullopt : std::optional{value % 7};
+    }
+
+    [[nodiscard]] TupleBuffer createInputBuffer(const uint64_t firstValue) const
+    {
+        auto buffer = bufferManager->getBufferBlocking();
+        for (uint64_t tupleIndex = 0; tupleIndex < TUPLES_PER_BUFFER; ++tupleIndex)
+        {
+            const auto value = firstValue + tupleIndex;
+            const auto key = getKey(value).value_or(0);
+            auto* const tuple = buffer.getAvailableMemoryArea().data() + (tupleIndex * SIZE_OF_TUPLE);
+            tuple[KEY_OFFSET] = std::byte{getKey(value).has_value() ? uint8_t{0} : uint8_t{1}};
+            std::memcpy(tuple + KEY_OFFSET + 1, &key, sizeof(key));
+            std::memcpy(tuple + VALUE_OFFSET, &value, sizeof(value));
+        }
+        buffer.setNumberOfTuples(TUPLES_PER_BUFFER);
+        return buffer;
+    }
+
+    [[nodiscard]] std::unique_ptr<KafkaSink>
+    createSink(BackpressureController backpressureController, std::unordered_map<std::string, std::string> config) const
+    {
+        config.try_emplace("input_format", "CSV");
+        config.try_emplace("kafka_brokers", brokers);
+        config.try_emplace("kafka_topic", TOPIC);
+        config.try_emplace("kafka_linger_ms", "0");
+        const auto sinkDescriptor = SinkCatalog{}.getInlineSink(schema, KafkaSink::NAME, std::move(config));
+        EXPECT_TRUE(sinkDescriptor.has_value());
+        /// NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+        return std::make_unique<KafkaSink>(std::move(backpressureController), *sinkDescriptor);
+    }
+
+    [[nodiscard]] TestPipelineExecutionContext createPipelineExecutionContext() const
+    {
+        return TestPipelineExecutionContext(bufferManager, std::make_shared<std::vector<std::vector<TupleBuffer>>>(1));
+    }
+
+    /// Executes the sink on all input buffers and stops it
+    void produceAll(KafkaSink& sink) const
+    {
+        auto pipelineExecutionContext = createPipelineExecutionContext();
+        sink.start(pipelineExecutionContext);
+        for (uint64_t inputBuffer = 0; inputBuffer < NUMBER_OF_BUFFERS; ++inputBuffer)
+        {
+            sink.execute(createInputBuffer(inputBuffer * TUPLES_PER_BUFFER), pipelineExecutionContext);
+        }
+        sink.stop(pipelineExecutionContext);
+    }
+
+    /// Returns the records that the sink should produce for the input buffers: a record per line of the CSV and JSON formats without its
+    /// newline, or a record per buffer of the NATIVE format
+    [[nodiscard]] std::vector<std::string> getExpectedRecords(const Format& format, const bool isNative) const
+    {
+        std::vector<std::string> records;
+        for (uint64_t inputBuffer = 0; inputBuffer < NUMBER_OF_BUFFERS; ++inputBuffer)
+        {
+            std::string formatted;
+            format.formatBuffer(createInputBuffer(inputBuffer * TUPLES_PER_BUFFER), formatted);
+            if (isNative)
+            {
+                records.push_back(std::move(formatted));
+                continue;
+            }
+            for (size_t begin = 0; begin < formatted.size();)
+            {
+                const auto end = std::min(formatted.find('\n', begin), formatted.size());
+                records.push_back(formatted.substr(begin, end - begin));
+                begin = end + 1;
+            }
+        }
+        return records;
+    }
+
+    /// Consumes every partition of the topic until its end
+    [[nodiscard]] std::vector<Record> consumeAll() const
+    {
+        std::array<char, 512> errorString{};
+        auto* conf = rd_kafka_conf_new();
+        EXPECT_EQ(rd_kafka_conf_set(conf, "bootstrap.servers", brokers.c_str(), errorString.data(), errorString.size()), RD_KAFKA_CONF_OK);
+        EXPECT_EQ(rd_kafka_conf_set(conf, "group.id", "test", errorString.data(), errorString.size()), RD_KAFKA_CONF_OK);
+        EXPECT_EQ(rd_kafka_conf_set(conf, "enable.partition.eof", "true", errorString.data(), errorString.size()), RD_KAFKA_CONF_OK);
+        auto* consumer = rd_kafka_new(RD_KAFKA_CONSUMER, conf, errorString.data(), errorString.size());
+        EXPECT_NE(consumer, nullptr) << errorString.data();
+        auto* assignment = rd_kafka_topic_partition_list_new(PARTITIONS);
+        for (int32_t partition = 0; partition < PARTITIONS; ++partition)
+        {
+            rd_kafka_topic_partition_list_add(assignment, TOPIC, partition)->offset = RD_KAFKA_OFFSET_BEGINNING;
+        }
+        EXPECT_EQ(rd_kafka_assign(consumer, assignment), RD_KAFKA_RESP_ERR_NO_ERROR);
+        rd_kafka_topic_partition_list_destroy(assignment);
+
+        std::vector<Record> records;
+        std::set<int32_t> partitionsAtEnd;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(TIMEOUT_MS);
+        while (partitionsAtEnd.size() < PARTITIONS and std::chrono::steady_clock::now() < deadline)
+        {
+            auto* record = rd_kafka_consumer_poll(consumer, 100);
+            if (record == nullptr)
+            {
+                continue;
+            }
+            if (record->err == RD_KAFKA_RESP_ERR__PARTITION_EOF)
+            {
+                partitionsAtEnd.insert(record->partition);
+            }
+            else if (record->err == RD_KAFKA_RESP_ERR_NO_ERROR)
+            {
+                auto& consumed = records.emplace_back(Record{
+                    .partition = record->partition,
+                    .key = std::nullopt,
+                    .payload = std::string(static_cast<const char*>(record->payload), record->len)});
+                if (record->key != nullptr)
+                {
+                    consumed.key = std::string(static_cast<const char*>(record->key), record->key_len);
+                }
+            }
+            rd_kafka_message_destroy(record);
+        }
+        EXPECT_EQ(partitionsAtEnd.size(), PARTITIONS);
+        rd_kafka_consumer_close(consumer);
+        rd_kafka_destroy(consumer);
+        return records;
+    }
+
+    static std::multiset<std::string> getPayloads(const std::vector<Record>& records)
+    {
+        std::multiset<std::string> payloads;
+        for (const auto& record : records)
+        {
+            payloads.insert(record.payload);
+        }
+        return payloads;
+    }
+
+    static bool waitFor(const BackpressureListener& backpressureListener, const bool hasBackpressure)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(TIMEOUT_MS);
+        while (backpressureListener.hasBackpressure() != hasBackpressure and std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return backpressureListener.hasBackpressure() == hasBackpressure;
+    }
+
+    std::shared_ptr<BufferManager> bufferManager;
+    Schema schema;
+    rd_kafka_t* clusterHandle = nullptr;
+    rd_kafka_mock_cluster_t* cluster = nullptr;
+    std::string brokers;
+};
+
+class KafkaSinkFormatTest : public KafkaSinkTest, public ::testing::WithParamInterface<std::string>
+{
+};
+
+/// Every tuple of the CSV and JSON formats becomes a record without its newline, every buffer of the NATIVE format a record of its frame
+TEST_P(KafkaSinkFormatTest, ProducesARecordPerTupleOrFrame)
+{
+    const auto& inputFormat = GetParam();
+    auto [backpressureController, backpressureListener] = createBackpressureChannel();
+    const auto sink = createSink(std::move(backpressureController), {{"input_format", inputFormat}});
+    produceAll(*sink);
+
+    std::unique_ptr<Format> format;
+    if (inputFormat == "CSV")
+    {
+        format = std::make_unique<CSVFormat>(schema);
+    }
+    else if (inputFormat == "JSON")
+    {
+        format = std::make_unique<JSONFormat>(schema);
+    }
+    else
+    {
+        format = std::make_unique<NativeFormat>(schema);
+    }
+    const auto expectedRecords = getExpectedRecords(*format, inputFormat == "NATIVE");
+    const auto records = consumeAll();
+    EXPECT_EQ(getPayloads(records), std::multiset<std::string>(expectedRecords.begin(), expectedRecords.end()));
+    for (const auto& record : records)
+    {
+        EXPECT_FALSE(record.key.has_value());
+        EXPECT_FALSE(record.payload.ends_with('\n'));
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(KafkaSinkFormats, KafkaSinkFormatTest, ::testing::Values("CSV", "JSON", "NATIVE"));
+
+/// The value of the key field keys a record, so that all records of a key end up in the same partition. Null keys leave records unkeyed.
+TEST_F(KafkaSinkTest, KeysRecordsByTheKeyField)
+{
+    auto [backpressureController, backpressureListener] = createBackpressureChannel();
+    const auto sink = createSink(std::move(backpressureController), {{"kafka_key_field", "stream$key"}});
+    produceAll(*sink);
+
+    /// The lines of the CSV format are unique, as their values are
+    const auto expectedRecords = getExpectedRecords(CSVFormat(schema), false);
+    ASSERT_EQ(expectedRecords.size(), TUPLES_PER_BUFFER * NUMBER_OF_BUFFERS);
+    std::map<std::string, std::optional<std::string>> expectedKeys;
+    for (uint64_t value = 0; value < expectedRecords.size(); ++value)
+    {
+        const auto key = getKey(value);
+        expectedKeys.emplace(expectedRecords[value], key.has_value() ? std::optional{std::to_string(*key)} : std::nullopt);
+    }
+
+    const auto records = consumeAll();
+    EXPECT_EQ(getPayloads(records), std::multiset<std::string>(expectedRecords.begin(), expectedRecords.end()));
+    std::map<std::string, std::set<int32_t>> partitionsOfKeys;
+    for (const auto& record : records)
+    {
+        ASSERT_TRUE(expectedKeys.contains(record.payload));
+        EXPECT_EQ(record.key, expectedKeys.at(record.payload)) << record.payload;
+        if (record.key.has_value())
+        {
+            partitionsOfKeys[*record.key].insert(record.partition);
+        }
+    }
+    EXPECT_EQ(partitionsOfKeys.size(), 7);
+    for (const auto& [key, partitions] : partitionsOfKeys)
+    {
+        EXPECT_EQ(partitions.size(), 1) << "key " << key;
+    }
+}
+
+/// Stop flushes the records that the producer still holds back to batch them, before the sink and its producer are destroyed
+TEST_F(KafkaSinkTest, FlushesLingeringRecordsOnStop)
+{
+    auto [backpressureController, backpressureListener] = createBackpressureChannel();
+    auto sink = createSink(std::move(backpressureController), {{"kafka_linger_ms", "600000"}, {"kafka_batch_size", "1000000"}});
+    const auto start = std::chrono::steady_clock::now();
+    produceAll(*sink);
+    sink.reset();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(TIMEOUT_MS));
+
+    const auto expectedRecords = getExpectedRecords(CSVFormat(schema), false);
+    EXPECT_EQ(getPayloads(consumeAll()), std::multiset<std::string>(expectedRecords.begin(), expectedRecords.end()));
+}
+
+/// The producer retries the records that the broker rejected with a transient error, without reporting them as failed
+TEST_F(KafkaSinkTest, RetriesRecordsAfterTransientProduceErrors)
+{
+    rd_kafka_mock_push_request_errors(
+        cluster,
+        PRODUCE_API_KEY,
+        3,
+        RD_KAFKA_RESP_ERR_NOT_LEADER_FOR_PARTITION,
+        RD_KAFKA_RESP_ERR_REQUEST_TIMED_OUT,
+        RD_KAFKA_RESP_ERR_NOT_ENOUGH_REPLICAS);
+    auto [backpressureController, backpressureListener] = createBackpressureChannel();
+    const auto sink = createSink(std::move(backpressureController), {});
+    produceAll(*sink);
+
+    const auto expectedRecords = getExpectedRecords(CSVFormat(schema), false);
+    EXPECT_EQ(getPayloads(consumeAll()), std::multiset<std::string>(expectedRecords.begin(), expectedRecords.end()));
+}
+
+/// The delivery reports of records that the broker rejected permanently fail the next buffer, or at the latest stop
+TEST_F(KafkaSinkTest, FailsIfTheBrokerRejectsRecords)
+{
+    rd_kafka_mock_push_request_errors(cluster, PRODUCE_API_KEY, 1, RD_KAFKA_RESP_ERR_MSG_SIZE_TOO_LARGE);
+    auto [backpressureController, backpressureListener] = createBackpressureChannel();
+    const auto sink = createSink(std::move(backpressureController), {});
+    auto pipelineExecutionContext = createPipelineExecutionContext();
+    sink->start(pipelineExecutionContext);
+    sink->execute(createInputBuffer(0), pipelineExecutionContext);
+    ASSERT_EXCEPTION_ERRORCODE(sink->stop(pipelineExecutionContext), ErrorCode::CannotWriteSink);
+}
+
+/// While the broker does not acknowledge the records, the sink applies backpressure, and releases it once the broker caught up
+TEST_F(KafkaSinkTest, AppliesBackpressureWhileTheBrokerDoesNotAcknowledgeRecords)
+{
+    ASSERT_EQ(rd_kafka_mock_broker_set_down(cluster, BROKER_ID), RD_KAFKA_RESP_ERR_NO_ERROR);
+    auto [backpressureController, backpressureListener] = createBackpressureChannel();
+    const auto sink = createSink(std::move(backpressureController), {{"kafka_max_queued_records", std::to_string(TUPLES_PER_BUFFER / 2)}});
+    auto pipelineExecutionContext = createPipelineExecutionContext();
+    sink->start(pipelineExecutionContext);
+    sink->execute(createInputBuffer(0), pipelineExecutionContext);
+    EXPECT_TRUE(waitFor(backpressureListener, true));
+
+    ASSERT_EQ(rd_kafka_mock_broker_set_up(cluster, BROKER_ID), RD_KAFKA_RESP_ERR_NO_ERROR);
+    EXPECT_TRUE(waitFor(backpressureListener, false));
+    for (uint64_t inputBuffer = 1; inputBuffer < NUMBER_OF_BUFFERS; ++inputBuffer)
+    {
+        sink->execute(createInputBuffer(inputBuffer * TUPLES_PER_BUFFER), pipelineExecutionContext);
+    }
+    sink->stop(pipelineExecutionContext);
+    EXPECT_FALSE(backpressureListener.hasBackpressure());
+
+    const auto expectedRecords = getExpectedRecords(CSVFormat(schema), false);
+    EXPECT_EQ(getPayloads(consumeAll()), std::multiset<std::string>(expectedRecords.begin(), expectedRecords.end()));
+}
+
+}
@@ -14,9 +14,12 @@
 
 #include <Generator.hpp>
 
+#include <cstddef>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <ranges>
+#include <span>
 #include <string_view>
 #include <utility>
 #include <variant>
@@ -56,6 +59,54 @@ void Generator::generateTuple(std::ostream& ostream)
     ostream << Generator::tupleDelimiter;
 }
 
+void Generator::writeTuple(const std::span<std::byte> tuple)
+{
+    PRECONDITION(not this->fields.empty(), "Cannot generate a row if there are no fields!");
+    size_t offset = 0;
+    const auto writeField = Overloaded{
+        [this, &tuple, &offset](GeneratorFields::SequenceField& field)
+        {
+            const bool fieldAlreadyStopped = field.stop;
+            field.write(tuple.subspan(offset), this->randEng);
+            if (field.stop && !fieldAlreadyStopped)
+            {
+                this->numStoppedFields++;
+            }
+            offset += field.getSizeInBytes();
+        },
+        [this, &tuple, &offset](GeneratorFields::NormalDistributionField& field)
+        {
+            field.write(tuple.subspan(offset), this->randEng);
+            offset += field.getSizeInBytes();
+        },
+        [](GeneratorFields::BaseGeneratorField&) { INVARIANT(false, "Cannot write a field of variable size into a row"); }};
+
+    for (auto& field : this->fields)
+    {
+        std::visit(writeField, *field);
+    }
+}
+
+std::optional<size_t> Generator::getSizeOfTuple() const
+{
+    size_t sizeOfTuple = 0;
+    for (const auto& field : this->fields)
+    {
+        const auto sizeOfField = std::visit(
+            Overloaded{
+                [](const GeneratorFields::SequenceField& sequence) { return std::optional{sequence.getSizeInBytes()}; },
+                [](const GeneratorFields::NormalDistributionField& distribution) { return std::optional{distribution.getSizeInBytes()}; },
+                [](const GeneratorFields::BaseGeneratorField&) { return std::optional<size_t>{}; }},
+            *field);
+        if (not sizeOfField.has_value())
+        {
+            return std::nullopt;
+        }
+        sizeOfTuple += sizeOfField.value();
+    }
+    return sizeOfTuple;
+}
+
 void Generator::addField(std::unique_ptr<GeneratorFields::GeneratorFieldType> field)
 {
     std::visit(
@@ -17,8 +17,10 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <random>
+#include <span>
 #include <string_view>
 #include <utility>
 #include <vector>
@@ -54,6 +56,13 @@ public:
     /// @param ostream output stream
     void generateTuple(std::ostream& ostream);
 
+    /// Generates a single row like generateTuple, but writes the values as the bytes of their types without delimiters, i.e., in the row
+    /// layout of a schema without nullable fields. Requires that all fields generate values of a fixed size (see getSizeOfTuple).
+    void writeTuple(std::span<std::byte> tuple);
+
+    /// Returns the size of a row that writeTuple writes, or nullopt if a field generates values of variable size
+    [[nodiscard]] std::optional<size_t> getSizeOfTuple() const;
+
     void addField(std::unique_ptr<GeneratorFields::GeneratorFieldType> field);
 
     /// Parses the generator schema from the @param rawSchema string
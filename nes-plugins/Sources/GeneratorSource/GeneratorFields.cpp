@@ -16,6 +16,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
@@ -23,6 +24,7 @@
 #include <ostream>
 #include <random>
 #include <ranges>
+#include <span>
 #include <string>
 #include <string_view>
 #include <variant>
@@ -88,7 +90,8 @@ void SequenceField::validate(std::string_view rawSchemaLine)
             validateParameter.operator()<uint32_t>(step, "step");
             break;
         }
-        case DataType::Type::UINT64: {
+        case DataType::Type::UINT64:
+        case DataType::Type::TIMESTAMP: {
             validateParameter.operator()<uint64_t>(start, "start");
             validateParameter.operator()<uint64_t>(end, "end");
             validateParameter.operator()<uint64_t>(step, "step");
@@ -112,7 +115,8 @@ void SequenceField::validate(std::string_view rawSchemaLine)
             validateParameter.operator()<int32_t>(step, "step");
             break;
         }
-        case DataType::Type::INT64: {
+        case DataType::Type::INT64:
+        case DataType::Type::INTERVAL: {
             validateParameter.operator()<int64_t>(start, "start");
             validateParameter.operator()<int64_t>(end, "end");
             validateParameter.operator()<int64_t>(step, "step");
@@ -143,6 +147,7 @@ void SequenceField::validate(std::string_view rawSchemaLine)
             break;
         }
         case DataType::Type::UNDEFINED:
+        case DataType::Type::DECIMAL:
         case DataType::Type::VARSIZED: {
             throw InvalidConfigParameter("Could not parse {} as SequenceField!", type);
         }
@@ -188,7 +193,8 @@ SequenceField::SequenceField(std::string_view rawSchemaLine)
             parse<uint32_t>(start, end, step);
             break;
         }
-        case DataType::Type::UINT64: {
+        case DataType::Type::UINT64:
+        case DataType::Type::TIMESTAMP: {
             parse<uint64_t>(start, end, step);
             break;
         }
@@ -204,7 +210,8 @@ SequenceField::SequenceField(std::string_view rawSchemaLine)
             parse<int32_t>(start, end, step);
             break;
         }
-        case DataType::Type::INT64: {
+        case DataType::Type::INT64:
+        case DataType::Type::INTERVAL: {
             parse<int64_t>(start, end, step);
             break;
         }
@@ -225,6 +232,7 @@ SequenceField::SequenceField(std::string_view rawSchemaLine)
             break;
         }
         case DataType::Type::UNDEFINED:
+        case DataType::Type::DECIMAL:
         case DataType::Type::VARSIZED: {
             INVARIANT(false, "Unknown Type \"{}\" in: {}", type, rawSchemaLine);
         }
@@ -261,6 +269,31 @@ std::ostream& SequenceField::generate(std::ostream& os, std::mt19937& /*re*/)
     return os;
 }
 
+void SequenceField::write(const std::span<std::byte> output, std::mt19937& /*randEng*/)
+{
+    std::visit(
+        [&]<typename T>(T& pos)
+        {
+            INVARIANT(output.size() >= sizeof(T), "Cannot write a value of {} bytes into {} bytes", sizeof(T), output.size());
+            std::memcpy(output.data(), &pos, sizeof(T));
+            if (this->sequencePosition < this->sequenceEnd)
+            {
+                const auto& step = std::get<T>(sequenceStepSize);
+                pos += step;
+            }
+        },
+        sequencePosition);
+    if (sequencePosition >= this->sequenceEnd)
+    {
+        this->stop = true;
+    }
+}
+
+size_t SequenceField::getSizeInBytes() const
+{
+    return std::visit([]<typename T>(const T&) { return sizeof(T); }, sequencePosition);
+}
+
 namespace
 {
 template <typename T, typename U = double>
@@ -303,6 +336,7 @@ NormalDistributionField::NormalDistributionField(const std::string_view rawSchem
             distribution = createDistribution<uint32_t>(mean, stddev);
             break;
         case DataType::Type::UINT64:
+        case DataType::Type::TIMESTAMP:
             distribution = createDistribution<uint64_t>(mean, stddev);
             break;
         case DataType::Type::INT8:
@@ -315,6 +349,7 @@ NormalDistributionField::NormalDistributionField(const std::string_view rawSchem
             distribution = createDistribution<int32_t>(mean, stddev);
             break;
         case DataType::Type::INT64:
+        case DataType::Type::INTERVAL:
             distribution = createDistribution<int64_t>(mean, stddev);
             break;
         case DataType::Type::FLOAT32:
@@ -332,6 +367,7 @@ NormalDistributionField::NormalDistributionField(const std::string_view rawSchem
         /// Getting a var sized from a normal_distribution is possible but we might want to do something different than solely converting
         /// the value to a string
         case DataType::Type::UNDEFINED:
+        case DataType::Type::DECIMAL:
         case DataType::Type::VARSIZED: {
             INVARIANT(false, "Output Type \"{}\" is not supported for normal or binomial distribution.", outputType);
         }
@@ -357,6 +393,24 @@ std::ostream& NormalDistributionField::generate(std::ostream& os, std::mt19937&
     return os;
 }
 
+void NormalDistributionField::write(const std::span<std::byte> output, std::mt19937& randEng)
+{
+    std::visit(
+        [&output, &randEng](auto& distribution)
+        {
+            const auto value = distribution(randEng);
+            INVARIANT(output.size() >= sizeof(value), "Cannot write a value of {} bytes into {} bytes", sizeof(value), output.size());
+            std::memcpy(output.data(), &value, sizeof(value));
+        },
+        distribution);
+}
+
+size_t NormalDistributionField::getSizeInBytes() const
+{
+    return std::visit(
+        []<typename Distribution>(const Distribution&) { return sizeof(typename Distribution::result_type); }, distribution);
+}
+
 void NormalDistributionField::validate(std::string_view rawSchemaLine)
 {
     const auto parameters = splitWithStringDelimiter<std::string_view>(rawSchemaLine, " ");
@@ -20,6 +20,7 @@
 #include <functional>
 #include <ostream>
 #include <random>
+#include <span>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -67,6 +68,9 @@ public:
     explicit SequenceField(std::string_view rawSchemaLine);
 
     std::ostream& generate(std::ostream& os, std::mt19937& randEng) override;
+    /// Writes the next value like generate, but as the bytes of its type instead of text
+    void write(std::span<std::byte> output, std::mt19937& randEng);
+    [[nodiscard]] size_t getSizeInBytes() const;
 
     static void validate(std::string_view rawSchemaLine);
 
@@ -107,6 +111,9 @@ public:
 
     explicit NormalDistributionField(std::string_view rawSchemaLine);
     std::ostream& generate(std::ostream& os, std::mt19937& randEng) override;
+    /// Writes the next value like generate, but as the bytes of its type instead of text
+    void write(std::span<std::byte> output, std::mt19937& randEng);
+    [[nodiscard]] size_t getSizeInBytes() const;
     static void validate(std::string_view rawSchemaLine);
 
 private:
@@ -14,12 +14,16 @@
 
 #include <GeneratorSource.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <exception>
 #include <iostream>
 #include <memory>
+#include <optional>
+#include <span>
 #include <stop_token>
 #include <string>
 #include <thread>
@@ -27,10 +31,13 @@
 #include <utility>
 #include <Configurations/Descriptor.hpp>
 #include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/NativeFrameHeader.hpp>
 #include <Runtime/TupleBuffer.hpp>
 #include <Sources/Source.hpp>
 #include <Sources/SourceDescriptor.hpp>
 #include <Util/Logger/Logger.hpp>
+#include <Util/Strings.hpp>
+#include <ErrorHandling.hpp>
 #include <FixedGeneratorRate.hpp>
 #include <Generator.hpp>
 #include <GeneratorRate.hpp>
@@ -50,8 +57,22 @@ GeneratorSource::GeneratorSource(const SourceDescriptor& sourceDescriptor)
           sourceDescriptor.getFromConfig(ConfigParametersGenerator::SEQUENCE_STOPS_GENERATOR),
           sourceDescriptor.getFromConfig(ConfigParametersGenerator::GENERATOR_SCHEMA))
     , flushInterval(std::chrono::milliseconds{sourceDescriptor.getFromConfig(ConfigParametersGenerator::FLUSH_INTERVAL_MS)})
+    , numberOfPregeneratedBuffers(sourceDescriptor.getFromConfig(ConfigParametersGenerator::PREGENERATED_BUFFERS))
 {
     NES_TRACE("Init GeneratorSource.")
+    if (toUpperCase(sourceDescriptor.getParserConfig().parserType) == NATIVE_PARSER_TYPE)
+    {
+        nativeSizeOfTuple = generator.getSizeOfTuple();
+        if (not nativeSizeOfTuple.has_value())
+        {
+            throw InvalidConfigParameter(
+                "The native parser requires a generator schema without fields of variable size: {}", generatorSchemaRaw);
+        }
+    }
+    else if (numberOfPregeneratedBuffers > 0)
+    {
+        throw InvalidConfigParameter("The generator source only pregenerates buffers for the native parser");
+    }
     switch (sourceDescriptor.getFromConfig(ConfigParametersGenerator::GENERATOR_RATE_TYPE))
     {
         case GeneratorRate::Type::FIXED:
@@ -68,10 +89,16 @@ GeneratorSource::GeneratorSource(const SourceDescriptor& sourceDescriptor)
     }
 }
 
-void GeneratorSource::open(std::shared_ptr<AbstractBufferProvider>)
+void GeneratorSource::open(std::shared_ptr<AbstractBufferProvider> bufferProvider)
 {
+    if (numberOfPregeneratedBuffers > 0)
+    {
+        pregenerateNativeTuples(bufferProvider->getBufferSize());
+    }
     this->generatorStartTime = std::chrono::system_clock::now();
     this->startOfInterval = std::chrono::system_clock::now();
+    this->nextFillTime = this->startOfInterval;
+    this->numberOfIntervals = 1;
     NES_TRACE("Opening GeneratorSource.");
 }
 
@@ -89,31 +116,53 @@ void GeneratorSource::close()
 }
 
 Source::FillTupleBufferResult GeneratorSource::fillTupleBuffer(TupleBuffer& tupleBuffer, const std::stop_token& stopToken)
+{
+    while (true)
+    {
+        if (auto result = tryFillTupleBuffer(tupleBuffer, stopToken))
+        {
+            return result.value();
+        }
+        std::this_thread::sleep_until(nextFillTime);
+    }
+}
+
+std::optional<Source::FillTupleBufferResult> GeneratorSource::tryFillTupleBuffer(TupleBuffer& tupleBuffer, const std::stop_token& stopToken)
 {
     try
     {
-        const auto elapsedTime
-            = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - generatorStartTime).count();
+        const auto now = std::chrono::system_clock::now();
+        if (now < nextFillTime)
+        {
+            return std::nullopt;
+        }
+
+        const auto elapsedTime = std::chrono::duration_cast<std::chrono::milliseconds>(now - generatorStartTime).count();
         if (maxRuntime >= 0 && elapsedTime >= maxRuntime)
         {
             NES_INFO("Reached max runtime! Stopping Source");
             return FillTupleBufferResult::eos();
         }
 
+        if (pendingTuplesOfInterval > 0)
+        {
+            return fillNativeTupleBuffer(tupleBuffer, pendingTuplesOfInterval, stopToken);
+        }
+
         /// Asking the generatorRate how many tuples we should generate for this interval [now, now + flushInterval].
         /// If we receive 0 tuples, we do not return but wait till another interval, as a return value of 0 tuples results in the query being terminated.
-        uint64_t numberOfTuplesToGenerate = 0;
-        uint64_t noIntervals = 1;
-        while (numberOfTuplesToGenerate == 0)
+        const auto endOfInterval = startOfInterval + (flushInterval * numberOfIntervals);
+        const uint64_t numberOfTuplesToGenerate = generatorRate->calcNumberOfTuplesForInterval(startOfInterval, endOfInterval);
+        NES_TRACE("numberOfTuplesToGenerate: {}", numberOfTuplesToGenerate);
+        if (numberOfTuplesToGenerate == 0)
         {
-            const auto endOfInterval = startOfInterval + (flushInterval * noIntervals);
-            numberOfTuplesToGenerate = generatorRate->calcNumberOfTuplesForInterval(startOfInterval, endOfInterval);
-            NES_TRACE("numberOfTuplesToGenerate: {}", numberOfTuplesToGenerate);
-            if (numberOfTuplesToGenerate == 0)
-            {
-                std::this_thread::sleep_for(std::chrono::microseconds{flushInterval});
-                ++noIntervals;
-            }
+            nextFillTime = now + flushInterval;
+            ++numberOfIntervals;
+            return std::nullopt;
+        }
+        if (nativeSizeOfTuple.has_value())
+        {
+            return fillNativeTupleBuffer(tupleBuffer, numberOfTuplesToGenerate, stopToken);
         }
 
         /// Generating the required number of tuples. Any tuples that do not fit into the tuple buffer, we add to the orphanTuples and emit
@@ -156,31 +205,129 @@ Source::FillTupleBufferResult GeneratorSource::fillTupleBuffer(TupleBuffer& tupl
         ++generatedBuffers;
         tuplesStream.str("");
         NES_TRACE("Wrote {} bytes", writtenBytes);
+        finishInterval();
+        return FillTupleBufferResult::withBytes(writtenBytes);
+    }
+    catch (const std::exception& e)
+    {
+        NES_ERROR("Failed to fill the TupleBuffer. Error: {}", e.what());
+        throw e;
+    }
+}
+
+void GeneratorSource::finishInterval()
+{
+    /// The whole interval should take the duration of the flushInterval. Thus, the next fill starts at the end of the interval, and
+    /// not before. If there is no time left, we print a warning.
+    const auto durationGeneratingTuples
+        = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - startOfInterval);
+    if (durationGeneratingTuples > (flushInterval * numberOfIntervals))
+    {
+        NES_WARNING(
+            "Can not produce all required tuples in the flushInterval of {} as it took us {}",
+            (flushInterval * numberOfIntervals),
+            durationGeneratingTuples);
+    }
+    nextFillTime = startOfInterval + (flushInterval * numberOfIntervals);
+    this->startOfInterval = std::max(std::chrono::system_clock::now(), nextFillTime);
+    numberOfIntervals = 1;
+}
+
+Source::FillTupleBufferResult GeneratorSource::fillNativeTupleBuffer(
+    TupleBuffer& tupleBuffer, const uint64_t numberOfTuplesToGenerate, const std::stop_token& stopToken)
+{
+    const auto sizeOfTuple = nativeSizeOfTuple.value();
+    const auto memory = tupleBuffer.getAvailableMemoryArea();
+    PRECONDITION(
+        memory.size() >= sizeof(NativeFrameHeader) + sizeOfTuple,
+        "A buffer of {} bytes cannot hold a native frame with a tuple of {} bytes",
+        memory.size(),
+        sizeOfTuple);
+    const uint64_t tuplesPerFrame = (memory.size() - sizeof(NativeFrameHeader)) / sizeOfTuple;
+    const auto numberOfTuples = std::min(numberOfTuplesToGenerate, tuplesPerFrame);
+
+    const auto writtenTuples = writeNativeTuples(memory.subspan(sizeof(NativeFrameHeader)), numberOfTuples, stopToken);
+    if (writtenTuples == 0 || stopToken.stop_requested())
+    {
+        pendingTuplesOfInterval = 0;
+        return FillTupleBufferResult::eos();
+    }
+    const NativeFrameHeader header{
+        .magic = NativeFrameHeader::MAGIC,
+        .sizeOfTuple = static_cast<uint32_t>(sizeOfTuple),
+        .numberOfTuples = writtenTuples,
+        .numberOfChildBuffers = 0};
+    std::memcpy(memory.data(), &header, sizeof(NativeFrameHeader));
+    ++generatedBuffers;
+
+    /// A full frame leaves the remaining tuples of the interval pending. Otherwise, the generator stopped or the interval is complete.
+    pendingTuplesOfInterval = writtenTuples == tuplesPerFrame ? numberOfTuplesToGenerate - writtenTuples : 0;
+    if (pendingTuplesOfInterval == 0)
+    {
+        finishInterval();
+    }
+    return FillTupleBufferResult::withBytes(sizeof(NativeFrameHeader) + (writtenTuples * sizeOfTuple));
+}
 
-        /// Calculating how long to sleep. The whole method should take the duration of the flushInterval. If we have some time left, we
-        /// sleep for the remaining duration. If there is no time left, we print a warning.
-        const auto durationGeneratingTuples
-            = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - startOfInterval);
-        if (durationGeneratingTuples > (flushInterval * noIntervals))
+uint64_t
+GeneratorSource::writeNativeTuples(const std::span<std::byte> tuples, const uint64_t numberOfTuples, const std::stop_token& stopToken)
+{
+    const auto sizeOfTuple = nativeSizeOfTuple.value();
+    uint64_t writtenTuples = 0;
+    if (pregeneratedTuples.empty())
+    {
+        while (writtenTuples < numberOfTuples && not generator.shouldStop() && not stopToken.stop_requested())
         {
-            NES_WARNING(
-                "Can not produce all required tuples in the flushInterval of {} as it took us {}",
-                (flushInterval * noIntervals),
-                durationGeneratingTuples);
+            generator.writeTuple(tuples.subspan(writtenTuples * sizeOfTuple, sizeOfTuple));
+            ++writtenTuples;
         }
-        else
+        generatedTuplesCounter += writtenTuples;
+        return writtenTuples;
+    }
+
+    const auto numberOfPregeneratedTuples = pregeneratedTuples.size() / sizeOfTuple;
+    while (writtenTuples < numberOfTuples)
+    {
+        if (nextPregeneratedTuple == numberOfPregeneratedTuples)
         {
-            const auto sleepDuration = (flushInterval * noIntervals) - durationGeneratingTuples;
-            std::this_thread::sleep_for(sleepDuration);
+            if (generatorStoppedWhilePregenerating)
+            {
+                break;
+            }
+            nextPregeneratedTuple = 0;
         }
-        this->startOfInterval = std::chrono::system_clock::now();
-        return FillTupleBufferResult::withBytes(writtenBytes);
+        const auto copiedTuples = std::min(numberOfTuples - writtenTuples, numberOfPregeneratedTuples - nextPregeneratedTuple);
+        std::memcpy(
+            tuples.data() + (writtenTuples * sizeOfTuple),
+            pregeneratedTuples.data() + (nextPregeneratedTuple * sizeOfTuple),
+            copiedTuples * sizeOfTuple);
+        writtenTuples += copiedTuples;
+        nextPregeneratedTuple += copiedTuples;
     }
-    catch (const std::exception& e)
+    return writtenTuples;
+}
+
+void GeneratorSource::pregenerateNativeTuples(const size_t bufferSize)
+{
+    const auto sizeOfTuple = nativeSizeOfTuple.value();
+    PRECONDITION(
+        bufferSize >= sizeof(NativeFrameHeader) + sizeOfTuple,
+        "A buffer of {} bytes cannot hold a native frame with a tuple of {} bytes",
+        bufferSize,
+        sizeOfTuple);
+    const auto numberOfTuples = numberOfPregeneratedBuffers * ((bufferSize - sizeof(NativeFrameHeader)) / sizeOfTuple);
+    pregeneratedTuples.resize(numberOfTuples * sizeOfTuple);
+    const auto tuples = std::span(pregeneratedTuples);
+    size_t generatedTuples = 0;
+    while (generatedTuples < numberOfTuples && not generator.shouldStop())
     {
-        NES_ERROR("Failed to fill the TupleBuffer. Error: {}", e.what());
-        throw e;
+        generator.writeTuple(tuples.subspan(generatedTuples * sizeOfTuple, sizeOfTuple));
+        ++generatedTuples;
     }
+    generatorStoppedWhilePregenerating = generator.shouldStop();
+    pregeneratedTuples.resize(generatedTuples * sizeOfTuple);
+    generatedTuplesCounter += generatedTuples;
+    NES_INFO("Pregenerated {} tuples for {} buffers", generatedTuples, numberOfPregeneratedBuffers);
 }
 
 std::ostream& GeneratorSource::toString(std::ostream& str) const
@@ -21,11 +21,13 @@
 #include <optional>
 #include <ostream>
 #include <ranges>
+#include <span>
 #include <sstream>
 #include <stop_token>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include <Configurations/Descriptor.hpp>
 #include <Configurations/Enums/EnumWrapper.hpp>
@@ -60,6 +62,10 @@ public:
 
     FillTupleBufferResult fillTupleBuffer(TupleBuffer& tupleBuffer, const std::stop_token& stopToken) override;
 
+    /// Returns nullopt until the current interval of the generator rate has passed, instead of sleeping
+    [[nodiscard]] bool supportsNonBlockingFill() const override { return true; }
+    std::optional<FillTupleBufferResult> tryFillTupleBuffer(TupleBuffer& tupleBuffer, const std::stop_token& stopToken) override;
+
     [[nodiscard]] std::ostream& toString(std::ostream& str) const override;
 
     void open(std::shared_ptr<AbstractBufferProvider> bufferProvider) override;
@@ -67,7 +73,21 @@ public:
 
     static DescriptorConfig::Config validateAndFormat(std::unordered_map<std::string, std::string> config);
 
+    /// Sources with this parser type receive the tuples as native frames (see NativeFrameHeader) instead of CSV
+    static constexpr std::string_view NATIVE_PARSER_TYPE = "NATIVE";
+
 private:
+    /// Fills the buffer with a single native frame. The tuples of the interval that do not fit into the frame remain pending for the next
+    /// buffer, which the source fills right away.
+    FillTupleBufferResult
+    fillNativeTupleBuffer(TupleBuffer& tupleBuffer, uint64_t numberOfTuplesToGenerate, const std::stop_token& stopToken);
+    /// Writes up to 'numberOfTuples' tuples and returns the number of written tuples, which is smaller if the generator stopped
+    uint64_t writeNativeTuples(std::span<std::byte> tuples, uint64_t numberOfTuples, const std::stop_token& stopToken);
+    /// Generates the tuples that fill 'numberOfPregeneratedBuffers' native frames of the given buffer size
+    void pregenerateNativeTuples(size_t bufferSize);
+    /// Moves to the next interval of the generator rate, after the source emitted all tuples of the current interval
+    void finishInterval();
+
     uint32_t seed;
     int32_t maxRuntime;
     uint64_t generatedTuplesCounter{0};
@@ -77,11 +97,25 @@ private:
     Generator generator;
     std::stringstream tuplesStream;
     std::chrono::time_point<std::chrono::system_clock> startOfInterval;
+    /// The source fills the next buffer not before this point in time, to produce at the generator rate
+    std::chrono::time_point<std::chrono::system_clock> nextFillTime;
+    /// Number of flushIntervals the current interval spans, as we skip intervals without tuples
+    uint64_t numberOfIntervals{1};
     std::chrono::milliseconds flushInterval;
     std::unique_ptr<GeneratorRate> generatorRate;
 
     /// if inserting a set of generated tuples into the buffer would overflow it, this string saves them so it can be inserted into the next buffer
     std::string orphanTuples;
+
+    /// Only set if the source emits native frames, which requires a generator without fields of variable size
+    std::optional<size_t> nativeSizeOfTuple;
+    uint64_t pendingTuplesOfInterval{0};
+    /// The source emits the pregenerated tuples cyclically, instead of generating the tuples of every buffer.
+    /// If the generator stopped while pregenerating, the source emits them only once.
+    uint64_t numberOfPregeneratedBuffers;
+    std::vector<std::byte> pregeneratedTuples;
+    size_t nextPregeneratedTuple{0};
+    bool generatorStoppedWhilePregenerating{false};
 };
 
 struct ConfigParametersGenerator
@@ -214,6 +248,12 @@ struct ConfigParametersGenerator
         -1,
         [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(MAX_RUNTIME_MS, config); }};
 
+    /// @brief number of buffers that the source pregenerates and emits cyclically, which requires the native parser. 0 disables it.
+    static inline const DescriptorConfig::ConfigParameter<uint64_t> PREGENERATED_BUFFERS{
+        "pregenerated_buffers",
+        0,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(PREGENERATED_BUFFERS, config); }};
+
     static inline std::unordered_map<std::string, DescriptorConfig::ConfigParameterContainer> parameterMap
         = DescriptorConfig::createConfigParameterContainerMap(
             SourceDescriptor::parameterMap,
@@ -223,6 +263,7 @@ struct ConfigParametersGenerator
             SEQUENCE_STOPS_GENERATOR,
             GENERATOR_RATE_TYPE,
             GENERATOR_RATE_CONFIG,
-            FLUSH_INTERVAL_MS);
+            FLUSH_INTERVAL_MS,
+            PREGENERATED_BUFFERS);
 };
 }
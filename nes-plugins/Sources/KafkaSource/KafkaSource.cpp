@@ -0,0 +1,284 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <KafkaSource.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <stop_token>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <Configurations/Descriptor.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sources/SourceDescriptor.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <librdkafka/rdkafka.h>
+#include <ErrorHandling.hpp>
+#include <SourceRegistry.hpp>
+#include <SourceValidationRegistry.hpp>
+
+namespace NES
+{
+
+KafkaSource::KafkaSource(const SourceDescriptor& sourceDescriptor)
+    : brokers(sourceDescriptor.getFromConfig(ConfigParametersKafka::BROKERS))
+    , topic(sourceDescriptor.getFromConfig(ConfigParametersKafka::TOPIC))
+    , partition(sourceDescriptor.getFromConfig(ConfigParametersKafka::PARTITION))
+    , groupId(sourceDescriptor.getFromConfig(ConfigParametersKafka::GROUP_ID))
+    , autoOffsetReset(sourceDescriptor.getFromConfig(ConfigParametersKafka::AUTO_OFFSET_RESET))
+    , fetchMinBytes(sourceDescriptor.getFromConfig(ConfigParametersKafka::FETCH_MIN_BYTES))
+    , fetchWaitMaxMs(sourceDescriptor.getFromConfig(ConfigParametersKafka::FETCH_WAIT_MAX_MS))
+    , commitInterval(sourceDescriptor.getFromConfig(ConfigParametersKafka::COMMIT_INTERVAL_MS))
+    , stopAtEnd(sourceDescriptor.getFromConfig(ConfigParametersKafka::STOP_AT_END))
+    , tupleDelimiter(sourceDescriptor.getFromConfig(ConfigParametersKafka::TUPLE_DELIMITER))
+    , appendTupleDelimiter(sourceDescriptor.getFromConfig(ConfigParametersKafka::APPEND_TUPLE_DELIMITER))
+    , batch(sourceDescriptor.getFromConfig(ConfigParametersKafka::BATCH_SIZE))
+{
+    if (batch.empty())
+    {
+        throw InvalidConfigParameter("The KafkaSource requires a kafka_batch_size of at least 1");
+    }
+}
+
+KafkaSource::~KafkaSource()
+{
+    releaseBatch();
+    if (queue != nullptr)
+    {
+        rd_kafka_queue_destroy(queue);
+    }
+    if (consumer != nullptr)
+    {
+        rd_kafka_destroy(consumer);
+    }
+}
+
+void KafkaSource::open(std::shared_ptr<AbstractBufferProvider>)
+{
+    std::array<char, 512> errorString{};
+    auto* conf = rd_kafka_conf_new();
+    /// The source commits the offsets itself, as librdkafka would commit records that the source did not hand on yet
+    const std::unordered_map<std::string, std::string> properties{
+        {"bootstrap.servers", brokers},
+        {"group.id", groupId},
+        {"enable.auto.commit", "false"},
+        {"auto.offset.reset", autoOffsetReset},
+        {"fetch.min.bytes", std::to_string(fetchMinBytes)},
+        {"fetch.wait.max.ms", std::to_string(fetchWaitMaxMs)},
+        {"enable.partition.eof", stopAtEnd ? "true" : "false"}};
+    for (const auto& [property, value] : properties)
+    {
+        if (rd_kafka_conf_set(conf, property.c_str(), value.c_str(), errorString.data(), errorString.size()) != RD_KAFKA_CONF_OK)
+        {
+            rd_kafka_conf_destroy(conf);
+            throw CannotOpenSource("Could not set the Kafka property {} to {}: {}", property, value, errorString.data());
+        }
+    }
+
+    /// On success, the consumer takes the ownership of the configuration
+    consumer = rd_kafka_new(RD_KAFKA_CONSUMER, conf, errorString.data(), errorString.size());
+    if (consumer == nullptr)
+    {
+        rd_kafka_conf_destroy(conf);
+        throw CannotOpenSource("Could not create a Kafka consumer for {}: {}", brokers, errorString.data());
+    }
+
+    /// Assigning the partition directly, instead of subscribing to the topic, keeps the consumer group from rebalancing the partitions
+    /// between the sources
+    auto* assignment = rd_kafka_topic_partition_list_new(1);
+    rd_kafka_topic_partition_list_add(assignment, topic.c_str(), partition)->offset = RD_KAFKA_OFFSET_STORED;
+    const auto assignError = rd_kafka_assign(consumer, assignment);
+    rd_kafka_topic_partition_list_destroy(assignment);
+    if (assignError != RD_KAFKA_RESP_ERR_NO_ERROR)
+    {
+        throw CannotOpenSource("Could not assign partition {} of topic {}: {}", partition, topic, rd_kafka_err2str(assignError));
+    }
+    queue = rd_kafka_queue_get_consumer(consumer);
+    lastCommit = std::chrono::steady_clock::now();
+    NES_DEBUG("KafkaSource: consuming partition {} of topic {} from {}", partition, topic, brokers);
+}
+
+bool KafkaSource::consumeBatch(const std::chrono::milliseconds timeout)
+{
+    releaseBatch();
+    const auto consumed = rd_kafka_consume_batch_queue(queue, static_cast<int>(timeout.count()), batch.data(), batch.size());
+    if (consumed < 0)
+    {
+        throw RunningRoutineFailure(
+            "Could not consume partition {} of topic {}: {}", partition, topic, rd_kafka_err2str(rd_kafka_last_error()));
+    }
+    batchSize = static_cast<size_t>(consumed);
+    return batchSize > 0;
+}
+
+void KafkaSource::releaseBatch()
+{
+    for (size_t record = 0; record < batchSize; ++record)
+    {
+        rd_kafka_message_destroy(batch[record]);
+    }
+    batchSize = 0;
+    nextRecord = 0;
+    copiedBytesOfNextRecord = 0;
+}
+
+void KafkaSource::commit(const bool async)
+{
+    if (not uncommittedOffset.has_value())
+    {
+        return;
+    }
+    /// The committed offset is the offset of the next record that the consumer group reads
+    auto* offsets = rd_kafka_topic_partition_list_new(1);
+    rd_kafka_topic_partition_list_add(offsets, topic.c_str(), partition)->offset = *uncommittedOffset + 1;
+    if (const auto error = rd_kafka_commit(consumer, offsets, async ? 1 : 0); error != RD_KAFKA_RESP_ERR_NO_ERROR)
+    {
+        NES_WARNING(
+            "KafkaSource: could not commit offset {} of partition {}: {}", *uncommittedOffset + 1, partition, rd_kafka_err2str(error));
+    }
+    rd_kafka_topic_partition_list_destroy(offsets);
+    uncommittedOffset.reset();
+    lastCommit = std::chrono::steady_clock::now();
+}
+
+Source::FillTupleBufferResult KafkaSource::fillTupleBuffer(TupleBuffer& tupleBuffer, const std::stop_token& stopToken)
+{
+    /// The source fills the next buffer only after the query accepted the previous one. Thus, the commit includes only records of
+    /// buffers that the query took, which the backpressure of the sink holds back, if the sink falls behind.
+    if (std::chrono::steady_clock::now() - lastCommit >= commitInterval)
+    {
+        commit(true);
+    }
+
+    const auto buffer = tupleBuffer.getAvailableMemoryArea().first(tupleBuffer.getBufferSize());
+    size_t filledBytes = 0;
+    while (filledBytes < buffer.size())
+    {
+        if (nextRecord == batchSize)
+        {
+            /// A partially filled buffer takes the records that are already fetched, but does not wait for the broker
+            if (reachedEnd or not consumeBatch(filledBytes == 0 ? CONSUME_TIMEOUT : std::chrono::milliseconds::zero()))
+            {
+                if (filledBytes > 0)
+                {
+                    break;
+                }
+                if (reachedEnd or stopToken.stop_requested())
+                {
+                    return FillTupleBufferResult::eos();
+                }
+                continue;
+            }
+        }
+
+        const auto* record = batch[nextRecord];
+        if (record->err != RD_KAFKA_RESP_ERR_NO_ERROR)
+        {
+            if (record->err == RD_KAFKA_RESP_ERR__PARTITION_EOF)
+            {
+                reachedEnd = true;
+            }
+            else
+            {
+                /// librdkafka retries transient errors, e.g., of unavailable brokers, and reports them as records
+                NES_WARNING(
+                    "KafkaSource: error while consuming partition {} of topic {}: {}", partition, topic, rd_kafka_message_errstr(record));
+            }
+            ++nextRecord;
+            continue;
+        }
+
+        /// Copies (the rest of) the payload of the record and, if it does not end with the tuple delimiter, the delimiter
+        const auto* payload = static_cast<const std::byte*>(record->payload);
+        const bool delimit = appendTupleDelimiter and (record->len == 0 or static_cast<char>(payload[record->len - 1]) != tupleDelimiter);
+        const size_t recordSize = record->len + (delimit ? 1 : 0);
+        const size_t bytesToCopy = std::min(recordSize - copiedBytesOfNextRecord, buffer.size() - filledBytes);
+        const size_t payloadBytesToCopy = std::min(bytesToCopy, record->len - std::min(copiedBytesOfNextRecord, record->len));
+        std::copy_n(payload + copiedBytesOfNextRecord, payloadBytesToCopy, buffer.begin() + filledBytes);
+        if (payloadBytesToCopy < bytesToCopy)
+        {
+            buffer[filledBytes + payloadBytesToCopy] = static_cast<std::byte>(tupleDelimiter);
+        }
+        filledBytes += bytesToCopy;
+        copiedBytesOfNextRecord += bytesToCopy;
+        if (copiedBytesOfNextRecord == recordSize)
+        {
+            uncommittedOffset = record->offset;
+            ++handedOnRecords;
+            ++nextRecord;
+            copiedBytesOfNextRecord = 0;
+        }
+    }
+    return FillTupleBufferResult::withBytes(filledBytes);
+}
+
+void KafkaSource::close()
+{
+    if (consumer == nullptr)
+    {
+        return;
+    }
+    commit(false);
+    releaseBatch();
+    rd_kafka_queue_destroy(queue);
+    queue = nullptr;
+    if (const auto error = rd_kafka_consumer_close(consumer); error != RD_KAFKA_RESP_ERR_NO_ERROR)
+    {
+        NES_WARNING("KafkaSource: could not close the consumer of partition {} of topic {}: {}", partition, topic, rd_kafka_err2str(error));
+    }
+    rd_kafka_destroy(consumer);
+    consumer = nullptr;
+}
+
+DescriptorConfig::Config KafkaSource::validateAndFormat(std::unordered_map<std::string, std::string> config)
+{
+    return DescriptorConfig::validateAndFormat<ConfigParametersKafka>(std::move(config), name());
+}
+
+std::ostream& KafkaSource::toString(std::ostream& str) const
+{
+    str << "\nKafkaSource(";
+    str << "\n  brokers: " << brokers;
+    str << "\n  topic: " << topic;
+    str << "\n  partition: " << partition;
+    str << "\n  groupId: " << groupId;
+    str << "\n  autoOffsetReset: " << autoOffsetReset;
+    str << "\n  batchSize: " << batch.size();
+    str << "\n  fetchMinBytes: " << fetchMinBytes;
+    str << "\n  fetchWaitMaxMs: " << fetchWaitMaxMs;
+    str << "\n  commitIntervalMs: " << commitInterval.count();
+    str << "\n  stopAtEnd: " << stopAtEnd;
+    str << "\n  handedOnRecords: " << handedOnRecords;
+    str << ")\n";
+    return str;
+}
+
+SourceValidationRegistryReturnType RegisterKafkaSourceValidation(SourceValidationRegistryArguments sourceConfig)
+{
+    return KafkaSource::validateAndFormat(std::move(sourceConfig.config));
+}
+
+SourceRegistryReturnType SourceGeneratedRegistrar::RegisterKafkaSource(SourceRegistryArguments sourceRegistryArguments)
+{
+    return std::make_unique<KafkaSource>(sourceRegistryArguments.sourceDescriptor);
+}
+
+}
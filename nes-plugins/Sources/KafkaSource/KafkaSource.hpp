@@ -0,0 +1,199 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <stop_token>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <Configurations/Descriptor.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sources/Source.hpp>
+#include <Sources/SourceDescriptor.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <librdkafka/rdkafka.h>
+
+namespace NES
+{
+
+struct ConfigParametersKafka
+{
+    /// Comma separated list of the bootstrap brokers (bootstrap.servers)
+    static inline const DescriptorConfig::ConfigParameter<std::string> BROKERS{
+        "kafka_brokers",
+        std::nullopt,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(BROKERS, config); }};
+    static inline const DescriptorConfig::ConfigParameter<std::string> TOPIC{
+        "kafka_topic",
+        std::nullopt,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(TOPIC, config); }};
+    /// The partition that the source consumes. Every partition of a topic is consumed by its own source, so that the partitions of
+    /// a topic become origins of their own and the sources consume them in parallel.
+    static inline const DescriptorConfig::ConfigParameter<int32_t> PARTITION{
+        "kafka_partition",
+        std::nullopt,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(PARTITION, config); }};
+    /// The consumer group, whose committed offset of the partition the source resumes from
+    static inline const DescriptorConfig::ConfigParameter<std::string> GROUP_ID{
+        "kafka_group_id",
+        std::nullopt,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(GROUP_ID, config); }};
+    /// Where the source starts, if the consumer group has no committed offset for the partition (auto.offset.reset)
+    static inline const DescriptorConfig::ConfigParameter<std::string> AUTO_OFFSET_RESET{
+        "kafka_auto_offset_reset",
+        "earliest",
+        [](const std::unordered_map<std::string, std::string>& config) -> std::optional<std::string>
+        {
+            auto autoOffsetReset = DescriptorConfig::tryGet(AUTO_OFFSET_RESET, config);
+            if (autoOffsetReset.has_value() and *autoOffsetReset != "earliest" and *autoOffsetReset != "latest")
+            {
+                NES_ERROR("KafkaSource: kafka_auto_offset_reset must be earliest or latest, but is: {}", *autoOffsetReset);
+                return std::nullopt;
+            }
+            return autoOffsetReset;
+        }};
+    /// Maximum number of records that the source takes from the consumer queue at once
+    static inline const DescriptorConfig::ConfigParameter<uint32_t> BATCH_SIZE{
+        "kafka_batch_size",
+        1024,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(BATCH_SIZE, config); }};
+    /// The broker answers a fetch once it has this many bytes, or the fetch wait time passed (fetch.min.bytes)
+    static inline const DescriptorConfig::ConfigParameter<uint32_t> FETCH_MIN_BYTES{
+        "kafka_fetch_min_bytes",
+        1024 * 1024,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(FETCH_MIN_BYTES, config); }};
+    static inline const DescriptorConfig::ConfigParameter<uint32_t> FETCH_WAIT_MAX_MS{
+        "kafka_fetch_wait_max_ms",
+        100,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(FETCH_WAIT_MAX_MS, config); }};
+    /// How often the source commits the offset of the records that it handed on
+    static inline const DescriptorConfig::ConfigParameter<uint32_t> COMMIT_INTERVAL_MS{
+        "kafka_commit_interval_ms",
+        1000,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(COMMIT_INTERVAL_MS, config); }};
+    /// Ends the stream, once the source reached the end of the partition, e.g., to replay a topic
+    static inline const DescriptorConfig::ConfigParameter<bool> STOP_AT_END{
+        "kafka_stop_at_end",
+        false,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(STOP_AT_END, config); }};
+    /// Appended to every record that does not end with it, so that the input formatter finds the end of the tuple of every record
+    static inline const DescriptorConfig::ConfigParameter<char> TUPLE_DELIMITER{
+        "tuple_delimiter",
+        '\n',
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(TUPLE_DELIMITER, config); }};
+    /// Records of the NATIVE input format contain frames, which must not be delimited
+    static inline const DescriptorConfig::ConfigParameter<bool> APPEND_TUPLE_DELIMITER{
+        "append_tuple_delimiter",
+        true,
+        [](const std::unordered_map<std::string, std::string>& config)
+        { return DescriptorConfig::tryGet(APPEND_TUPLE_DELIMITER, config); }};
+
+    static inline std::unordered_map<std::string, DescriptorConfig::ConfigParameterContainer> parameterMap
+        = DescriptorConfig::createConfigParameterContainerMap(
+            SourceDescriptor::parameterMap,
+            BROKERS,
+            TOPIC,
+            PARTITION,
+            GROUP_ID,
+            AUTO_OFFSET_RESET,
+            BATCH_SIZE,
+            FETCH_MIN_BYTES,
+            FETCH_WAIT_MAX_MS,
+            COMMIT_INTERVAL_MS,
+            STOP_AT_END,
+            TUPLE_DELIMITER,
+            APPEND_TUPLE_DELIMITER);
+};
+
+/// Consumes a single partition of a Kafka topic. The source takes the fetched records from the consumer queue in batches and copies
+/// their payloads straight from the fetch buffers of librdkafka into its tuple buffers, which it hands to the input formatter as is.
+/// A record that does not fit the rest of a tuple buffer continues in the next one, as the input formatter reassembles tuples that span
+/// tuple buffers. The source commits the offset of the last record that it handed on completely (at-least-once), periodically and when
+/// it is closed. The backpressure of the sink of the query blocks the source, thus the commits follow the progress of the sink.
+class KafkaSource : public Source
+{
+public:
+    static const std::string& name()
+    {
+        static const std::string Instance = "Kafka";
+        return Instance;
+    }
+
+    explicit KafkaSource(const SourceDescriptor& sourceDescriptor);
+    ~KafkaSource() override;
+
+    KafkaSource(const KafkaSource&) = delete;
+    KafkaSource& operator=(const KafkaSource&) = delete;
+    KafkaSource(KafkaSource&&) = delete;
+    KafkaSource& operator=(KafkaSource&&) = delete;
+
+    FillTupleBufferResult fillTupleBuffer(TupleBuffer& tupleBuffer, const std::stop_token& stopToken) override;
+
+    /// Creates the consumer and assigns it the partition, starting at the committed offset of the consumer group
+    void open(std::shared_ptr<AbstractBufferProvider> bufferProvider) override;
+    /// Commits the offset of the records that the source handed on and closes the consumer
+    void close() override;
+
+    static DescriptorConfig::Config validateAndFormat(std::unordered_map<std::string, std::string> config);
+
+    [[nodiscard]] std::ostream& toString(std::ostream& str) const override;
+
+private:
+    /// How long the source waits for a batch of records, before it checks whether a stop was requested
+    static constexpr std::chrono::milliseconds CONSUME_TIMEOUT{100};
+
+    /// Takes the next batch of records from the consumer queue. Returns false, if the queue had no records within the timeout.
+    bool consumeBatch(std::chrono::milliseconds timeout);
+    void releaseBatch();
+    /// Commits the offset after the last record that the source handed on completely
+    void commit(bool async);
+
+    std::string brokers;
+    std::string topic;
+    int32_t partition;
+    std::string groupId;
+    std::string autoOffsetReset;
+    uint32_t fetchMinBytes;
+    uint32_t fetchWaitMaxMs;
+    std::chrono::milliseconds commitInterval;
+    bool stopAtEnd;
+    char tupleDelimiter;
+    bool appendTupleDelimiter;
+
+    rd_kafka_t* consumer = nullptr;
+    rd_kafka_queue_t* queue = nullptr;
+
+    /// The records of the current batch. The source hands on the records at [nextRecord, batchSize), of which it already copied the first
+    /// 'copiedBytesOfNextRecord' bytes of the next record.
+    std::vector<rd_kafka_message_t*> batch;
+    size_t batchSize = 0;
+    size_t nextRecord = 0;
+    size_t copiedBytesOfNextRecord = 0;
+    bool reachedEnd = false;
+
+    /// The offset of the last record that the source handed on completely, or nullopt if it did not hand on a record since the last commit
+    std::optional<int64_t> uncommittedOffset;
+    std::chrono::steady_clock::time_point lastCommit;
+    uint64_t handedOnRecords = 0;
+};
+
+}
@@ -0,0 +1,315 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/DataTypeProvider.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Runtime/BufferManager.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sources/SourceCatalog.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <librdkafka/rdkafka.h>
+#include <librdkafka/rdkafka_mock.h>
+#include <BaseUnitTest.hpp>
+#include <KafkaSource.hpp>
+
+namespace NES
+{
+
+/// Consumes partitions of the mock cluster of librdkafka, which serves the fetches, offset commits, and offset fetches of the consumer
+/// groups in process and injects errors into the responses of the broker
+class KafkaSourceTest : public Testing::BaseUnitTest
+{
+public:
+    static constexpr auto TOPIC = "records";
+    static constexpr int32_t PARTITIONS = 2;
+    static constexpr int32_t BROKER_ID = 1;
+    /// The public API of the mock cluster identifies requests by the API key of the Kafka protocol
+    static constexpr int16_t FETCH_API_KEY = 1;
+    static constexpr int NUMBER_OF_RECORDS = 10;
+    static constexpr int TIMEOUT_MS = 10000;
+
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("KafkaSourceTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup KafkaSourceTest class.");
+    }
+
+    void SetUp() override
+    {
+        Testing::BaseUnitTest::SetUp();
+        std::array<char, 512> errorString{};
+        auto* conf = rd_kafka_conf_new();
+        ASSERT_EQ(rd_kafka_conf_set(conf, "test.mock.num.brokers", "1", errorString.data(), errorString.size()), RD_KAFKA_CONF_OK);
+        producer = rd_kafka_new(RD_KAFKA_PRODUCER, conf, errorString.data(), errorString.size());
+        ASSERT_NE(producer, nullptr) << errorString.data();
+        cluster = rd_kafka_handle_mock_cluster(producer);
+        ASSERT_NE(cluster, nullptr);
+        brokers = rd_kafka_mock_cluster_bootstraps(cluster);
+        ASSERT_EQ(rd_kafka_mock_topic_create(cluster, TOPIC, PARTITIONS, 1), RD_KAFKA_RESP_ERR_NO_ERROR);
+    }
+
+    void TearDown() override
+    {
+        if (producer != nullptr)
+        {
+            rd_kafka_destroy(producer);
+        }
+        Testing::BaseUnitTest::TearDown();
+    }
+
+    static std::string getRecord(const int record) { return fmt::format("record-{}", record); }
+
+    /// Returns what the source hands on for the records [first, NUMBER_OF_RECORDS), i.e., every record with an appended tuple delimiter
+    static std::string getExpectedBytes(const int first)
+    {
+        std::string expected;
+        for (int record = first; record < NUMBER_OF_RECORDS; ++record)
+        {
+            expected += getRecord(record) + '\n';
+        }
+        return expected;
+    }
+
+    void produce(const int32_t partition, const std::string& record) const
+    {
+        ASSERT_EQ(
+            rd_kafka_producev(
+                producer,
+                RD_KAFKA_V_TOPIC(TOPIC),
+                RD_KAFKA_V_PARTITION(partition),
+                RD_KAFKA_V_VALUE(const_cast<char*>(record.data()), record.size()), /// NOLINT(cppcoreguidelines-pro-type-const-cast)
+                RD_KAFKA_V_MSGFLAGS(RD_KAFKA_MSG_F_COPY),
+                RD_KAFKA_V_END),
+            RD_KAFKA_RESP_ERR_NO_ERROR);
+        ASSERT_EQ(rd_kafka_flush(producer, TIMEOUT_MS), RD_KAFKA_RESP_ERR_NO_ERROR);
+    }
+
+    void produceRecords(const int32_t partition) const
+    {
+        for (int record = 0; record < NUMBER_OF_RECORDS; ++record)
+        {
+            produce(partition, getRecord(record));
+        }
+    }
+
+    [[nodiscard]] std::unique_ptr<KafkaSource>
+    createSource(const std::string& groupId, std::unordered_map<std::string, std::string> config = {}, const int32_t partition = 0) const
+    {
+        config.try_emplace("kafka_brokers", brokers);
+        config.try_emplace("kafka_topic", TOPIC);
+        config.try_emplace("kafka_partition", std::to_string(partition));
+        config.try_emplace("kafka_group_id", groupId);
+        config.try_emplace("kafka_stop_at_end", "true");
+        Schema schema;
+        schema.addField("record", DataTypeProvider::provideDataType(DataType::Type::VARSIZED));
+        const auto sourceDescriptor = SourceCatalog{}.getInlineSource(KafkaSource::name(), schema, {{"type", "CSV"}}, std::move(config));
+        EXPECT_TRUE(sourceDescriptor.has_value());
+        return std::make_unique<KafkaSource>(sourceDescriptor.value()); /// NOLINT(bugprone-unchecked-optional-access)
+    }
+
+    /// Fills tuple buffers, until the source handed on at least 'minBytes' bytes or ended the stream
+    static std::string read(KafkaSource& source, BufferManager& bufferManager, const size_t minBytes, const std::stop_token& stopToken)
+    {
+        std::string bytes;
+        while (bytes.size() < minBytes)
+        {
+            auto buffer = bufferManager.getBufferBlocking();
+            const auto result = source.fillTupleBuffer(buffer, stopToken);
+            if (result.isEoS())
+            {
+                break;
+            }
+            bytes.append(buffer.getAvailableMemoryArea<char>().data(), result.getNumberOfBytes());
+        }
+        return bytes;
+    }
+
+    static std::string readAll(KafkaSource& source, BufferManager& bufferManager)
+    {
+        return read(source, bufferManager, std::numeric_limits<size_t>::max(), std::stop_source{}.get_token());
+    }
+
+    /// Returns the offset that the consumer group committed for the partition, or RD_KAFKA_OFFSET_INVALID if it committed none
+    [[nodiscard]] int64_t getCommittedOffset(const std::string& groupId, const int32_t partition = 0) const
+    {
+        std::array<char, 512> errorString{};
+        auto* conf = rd_kafka_conf_new();
+        EXPECT_EQ(rd_kafka_conf_set(conf, "bootstrap.servers", brokers.c_str(), errorString.data(), errorString.size()), RD_KAFKA_CONF_OK);
+        EXPECT_EQ(rd_kafka_conf_set(conf, "group.id", groupId.c_str(), errorString.data(), errorString.size()), RD_KAFKA_CONF_OK);
+        auto* consumer = rd_kafka_new(RD_KAFKA_CONSUMER, conf, errorString.data(), errorString.size());
+        EXPECT_NE(consumer, nullptr) << errorString.data();
+        auto* offsets = rd_kafka_topic_partition_list_new(1);
+        auto* offset = rd_kafka_topic_partition_list_add(offsets, TOPIC, partition);
+        EXPECT_EQ(rd_kafka_committed(consumer, offsets, TIMEOUT_MS), RD_KAFKA_RESP_ERR_NO_ERROR);
+        const auto committedOffset = offset->offset;
+        rd_kafka_topic_partition_list_destroy(offsets);
+        rd_kafka_consumer_close(consumer);
+        rd_kafka_destroy(consumer);
+        return committedOffset;
+    }
+
+    rd_kafka_t* producer = nullptr;
+    rd_kafka_mock_cluster_t* cluster = nullptr;
+    std::string brokers;
+};
+
+TEST_F(KafkaSourceTest, HandsOnTheRecordsOfItsPartitionWithTupleDelimiters)
+{
+    produce(0, "first");
+    produce(1, "other partition");
+    produce(0, "second\n");
+    produce(0, "");
+
+    const auto bufferManager = BufferManager::create(4096, 4);
+    const auto source = createSource("group");
+    source->open(bufferManager);
+    EXPECT_EQ(readAll(*source, *bufferManager), "first\nsecond\n\n");
+    source->close();
+    EXPECT_EQ(getCommittedOffset("group"), 3);
+    EXPECT_EQ(getCommittedOffset("group", 1), RD_KAFKA_OFFSET_INVALID);
+}
+
+/// The source commits a record only once it handed it on completely. Thus, a record, which a tuple buffer contains only partially,
+/// follows again after a restart (at-least-once).
+TEST_F(KafkaSourceTest, ResumesAfterTheLastRecordThatItHandedOnCompletely)
+{
+    produceRecords(0);
+    /// Every record takes 9 bytes with its tuple delimiter, thus every buffer ends within a record
+    const auto bufferManager = BufferManager::create(16, 4);
+
+    const auto source = createSource("group");
+    source->open(bufferManager);
+    const auto handedOnBytes = read(*source, *bufferManager, 16, std::stop_source{}.get_token());
+    source->close();
+    ASSERT_GE(handedOnBytes.size(), 16);
+    ASSERT_TRUE(getExpectedBytes(0).starts_with(handedOnBytes));
+    const auto completeRecords = static_cast<int>(std::ranges::count(handedOnBytes, '\n'));
+    EXPECT_EQ(getCommittedOffset("group"), completeRecords);
+
+    const auto restartedSource = createSource("group");
+    restartedSource->open(bufferManager);
+    EXPECT_EQ(readAll(*restartedSource, *bufferManager), getExpectedBytes(completeRecords));
+    restartedSource->close();
+    EXPECT_EQ(getCommittedOffset("group"), NUMBER_OF_RECORDS);
+}
+
+TEST_F(KafkaSourceTest, StartsAtTheAutoOffsetResetWithoutCommittedOffset)
+{
+    produceRecords(0);
+    const auto bufferManager = BufferManager::create(4096, 4);
+
+    const auto earliestSource = createSource("earliest", {{"kafka_auto_offset_reset", "earliest"}});
+    earliestSource->open(bufferManager);
+    EXPECT_EQ(readAll(*earliestSource, *bufferManager), getExpectedBytes(0));
+    earliestSource->close();
+
+    const auto latestSource = createSource("latest", {{"kafka_auto_offset_reset", "latest"}});
+    latestSource->open(bufferManager);
+    EXPECT_EQ(readAll(*latestSource, *bufferManager), "");
+    latestSource->close();
+    EXPECT_EQ(getCommittedOffset("latest"), RD_KAFKA_OFFSET_INVALID);
+
+    /// The committed offset of a consumer group takes precedence over the auto offset reset
+    const auto resumedSource = createSource("earliest", {{"kafka_auto_offset_reset", "earliest"}});
+    resumedSource->open(bufferManager);
+    EXPECT_EQ(readAll(*resumedSource, *bufferManager), "");
+    resumedSource->close();
+}
+
+/// Before it fills a tuple buffer, the source commits the records of the previous tuple buffers, once the commit interval passed
+TEST_F(KafkaSourceTest, CommitsPeriodicallyWhileItIsOpen)
+{
+    produceRecords(0);
+    const auto bufferManager = BufferManager::create(16, 4);
+
+    const auto source = createSource("group", {{"kafka_commit_interval_ms", "0"}});
+    source->open(bufferManager);
+    const auto handedOnBytes = read(*source, *bufferManager, 16, std::stop_source{}.get_token());
+    const auto completeRecords = static_cast<int>(std::ranges::count(handedOnBytes, '\n'));
+    /// The next tuple buffer commits the complete records of the previous ones asynchronously
+    const auto nextBytes = read(*source, *bufferManager, 1, std::stop_source{}.get_token());
+    ASSERT_FALSE(nextBytes.empty());
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(TIMEOUT_MS);
+    while (getCommittedOffset("group") != completeRecords and std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(getCommittedOffset("group"), completeRecords);
+    source->close();
+}
+
+/// librdkafka retries fetches that the broker answers with an error, which must neither end the stream nor lose or repeat records
+TEST_F(KafkaSourceTest, RecoversFromFetchErrors)
+{
+    produceRecords(0);
+    rd_kafka_mock_push_request_errors(
+        cluster,
+        FETCH_API_KEY,
+        3,
+        RD_KAFKA_RESP_ERR_NOT_LEADER_FOR_PARTITION,
+        RD_KAFKA_RESP_ERR_REQUEST_TIMED_OUT,
+        RD_KAFKA_RESP_ERR_NOT_LEADER_FOR_PARTITION);
+    const auto bufferManager = BufferManager::create(4096, 4);
+
+    const auto source = createSource("group");
+    source->open(bufferManager);
+    EXPECT_EQ(readAll(*source, *bufferManager), getExpectedBytes(0));
+    source->close();
+    EXPECT_EQ(getCommittedOffset("group"), NUMBER_OF_RECORDS);
+}
+
+/// While the broker is down, the consumer reports transport errors, which the source logs. The source ends the stream on a stop request
+/// and continues, once the broker is back.
+TEST_F(KafkaSourceTest, WaitsForTheBrokerWhileItIsDown)
+{
+    produceRecords(0);
+    ASSERT_EQ(rd_kafka_mock_broker_set_down(cluster, BROKER_ID), RD_KAFKA_RESP_ERR_NO_ERROR);
+    const auto bufferManager = BufferManager::create(4096, 4);
+
+    const auto source = createSource("group");
+    source->open(bufferManager);
+    std::stop_source stopSource;
+    std::jthread stopper(
+        [&stopSource]
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+            stopSource.request_stop();
+        });
+    EXPECT_EQ(read(*source, *bufferManager, 1, stopSource.get_token()), "");
+    stopper.join();
+
+    ASSERT_EQ(rd_kafka_mock_broker_set_up(cluster, BROKER_ID), RD_KAFKA_RESP_ERR_NO_ERROR);
+    EXPECT_EQ(readAll(*source, *bufferManager), getExpectedBytes(0));
+    source->close();
+    EXPECT_EQ(getCommittedOffset("group"), NUMBER_OF_RECORDS);
+}
+
+}
@@ -0,0 +1,205 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <NetworkSource.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <stop_token>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <Configurations/Descriptor.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sources/Source.hpp>
+#include <Sources/SourceDescriptor.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <sys/socket.h>
+#include <ErrorHandling.hpp>
+#include <SourceRegistry.hpp>
+#include <SourceValidationRegistry.hpp>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace NES
+{
+
+NetworkSource::NetworkSource(const SourceDescriptor& sourceDescriptor)
+    : host(sourceDescriptor.getFromConfig(ConfigParametersNetworkSource::HOST))
+    , port(sourceDescriptor.getFromConfig(ConfigParametersNetworkSource::PORT))
+{
+}
+
+NetworkSource::~NetworkSource()
+{
+    close();
+}
+
+std::ostream& NetworkSource::toString(std::ostream& str) const
+{
+    str << "\nNetworkSource(";
+    str << "\n  host: " << host;
+    str << "\n  port: " << port;
+    str << "\n  received bytes: " << receivedBytes;
+    str << ")\n";
+    return str;
+}
+
+void NetworkSource::open(std::shared_ptr<AbstractBufferProvider>)
+{
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+    addrinfo* result = nullptr;
+    const auto portString = std::to_string(port);
+    if (const auto errorCode = getaddrinfo(host.c_str(), portString.c_str(), &hints, &result); errorCode != 0)
+    {
+        throw CannotOpenSource("Could not resolve {}:{}: {}", host, port, gai_strerror(errorCode));
+    }
+    const std::unique_ptr<addrinfo, decltype(&freeaddrinfo)> resultGuard(result, freeaddrinfo);
+
+    int lastError = 0;
+    for (const auto* address = result; address != nullptr; address = address->ai_next)
+    {
+        const int socket = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (socket < 0)
+        {
+            lastError = errno;
+            continue;
+        }
+        /// A query that restarts on the same port must not wait until the connection of its previous run timed out
+        constexpr int enabled = 1;
+        setsockopt(socket, SOL_SOCKET, SO_REUSEADDR, &enabled, sizeof(enabled));
+        if (::bind(socket, address->ai_addr, address->ai_addrlen) == 0 and ::listen(socket, 1) == 0)
+        {
+            listeningSocket = socket;
+            NES_DEBUG("NetworkSource listens on {}:{}", host, port);
+            return;
+        }
+        lastError = errno;
+        ::close(socket);
+    }
+    throw CannotOpenSource("Could not listen on {}:{}: {}", host, port, std::strerror(lastError));
+}
+
+bool NetworkSource::waitUntilReadable(const int socket, const std::stop_token& stopToken)
+{
+    pollfd pollDescriptor{.fd = socket, .events = POLLIN, .revents = 0};
+    while (not stopToken.stop_requested())
+    {
+        const auto ready = ::poll(&pollDescriptor, 1, static_cast<int>(POLL_INTERVAL.count()));
+        if (ready > 0)
+        {
+            return true;
+        }
+        if (ready < 0 and errno != EINTR)
+        {
+            throw CannotOpenSource("Could not poll the socket: {}", std::strerror(errno));
+        }
+    }
+    return false;
+}
+
+Source::FillTupleBufferResult NetworkSource::fillTupleBuffer(TupleBuffer& tupleBuffer, const std::stop_token& stopToken)
+{
+    if (connection < 0)
+    {
+        if (not waitUntilReadable(listeningSocket, stopToken))
+        {
+            return FillTupleBufferResult::eos();
+        }
+        connection = ::accept(listeningSocket, nullptr, nullptr);
+        if (connection < 0)
+        {
+            throw CannotOpenSource("Could not accept the connection on {}:{}: {}", host, port, std::strerror(errno));
+        }
+        /// The source accepts a single sink, thus it stops listening right away
+        ::close(listeningSocket);
+        listeningSocket = -1;
+    }
+
+    /// Receives all bytes that are available right away, but does not wait for the rest of a frame, as the formatter reassembles frames
+    /// that span multiple tuple buffers
+    const auto buffer = tupleBuffer.getAvailableMemoryArea().first(tupleBuffer.getBufferSize());
+    size_t numberOfReceivedBytes = 0;
+    while (numberOfReceivedBytes < buffer.size())
+    {
+        if (numberOfReceivedBytes == 0 and not waitUntilReadable(connection, stopToken))
+        {
+            return FillTupleBufferResult::eos();
+        }
+        const auto flags = numberOfReceivedBytes == 0 ? 0 : MSG_DONTWAIT;
+        const auto received = ::recv(connection, buffer.data() + numberOfReceivedBytes, buffer.size() - numberOfReceivedBytes, flags);
+        if (received < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno == EAGAIN or errno == EWOULDBLOCK)
+            {
+                break;
+            }
+            throw CannotOpenSource("Could not receive from {}:{}: {}", host, port, std::strerror(errno));
+        }
+        if (received == 0)
+        {
+            break;
+        }
+        numberOfReceivedBytes += static_cast<size_t>(received);
+    }
+    if (numberOfReceivedBytes == 0)
+    {
+        NES_INFO("NetworkSource on {}:{} detected EoS", host, port);
+        return FillTupleBufferResult::eos();
+    }
+    receivedBytes += numberOfReceivedBytes;
+    return FillTupleBufferResult::withBytes(numberOfReceivedBytes);
+}
+
+void NetworkSource::close()
+{
+    if (connection >= 0)
+    {
+        ::close(connection);
+        connection = -1;
+    }
+    if (listeningSocket >= 0)
+    {
+        ::close(listeningSocket);
+        listeningSocket = -1;
+    }
+}
+
+DescriptorConfig::Config NetworkSource::validateAndFormat(std::unordered_map<std::string, std::string> config)
+{
+    return DescriptorConfig::validateAndFormat<ConfigParametersNetworkSource>(std::move(config), name());
+}
+
+SourceValidationRegistryReturnType RegisterNetworkSourceValidation(SourceValidationRegistryArguments sourceConfig)
+{
+    return NetworkSource::validateAndFormat(std::move(sourceConfig.config));
+}
+
+SourceRegistryReturnType SourceGeneratedRegistrar::RegisterNetworkSource(SourceRegistryArguments sourceRegistryArguments)
+{
+    return std::make_unique<NetworkSource>(sourceRegistryArguments.sourceDescriptor);
+}
+
+}
@@ -0,0 +1,95 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <stop_token>
+#include <string>
+#include <unordered_map>
+#include <Configurations/Descriptor.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sources/Source.hpp>
+#include <Sources/SourceDescriptor.hpp>
+
+namespace NES
+{
+
+struct ConfigParametersNetworkSource
+{
+    /// The address that the source listens on for the NetworkSink of the sending worker
+    static inline const DescriptorConfig::ConfigParameter<std::string> HOST{
+        "socket_host",
+        std::nullopt,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(HOST, config); }};
+    static inline const DescriptorConfig::ConfigParameter<uint32_t> PORT{
+        "socket_port",
+        std::nullopt,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(PORT, config); }};
+
+    static inline std::unordered_map<std::string, DescriptorConfig::ConfigParameterContainer> parameterMap
+        = DescriptorConfig::createConfigParameterContainerMap(SourceDescriptor::parameterMap, HOST, PORT);
+};
+
+/// Receives the frames that a NetworkSink of another worker sends. The source accepts a single connection and receives the bytes of the
+/// frames directly into its tuple buffers, which the native input formatter (input_format NATIVE) splits into the tuple buffers of the
+/// sending worker again. The source grants the sink new credits by reading, as the kernel acknowledges the bytes that the source read.
+/// The connection ends the stream, once the sink shut it down.
+class NetworkSource : public Source
+{
+public:
+    static const std::string& name()
+    {
+        static const std::string Instance = "Network";
+        return Instance;
+    }
+
+    explicit NetworkSource(const SourceDescriptor& sourceDescriptor);
+    ~NetworkSource() override;
+
+    NetworkSource(const NetworkSource&) = delete;
+    NetworkSource& operator=(const NetworkSource&) = delete;
+    NetworkSource(NetworkSource&&) = delete;
+    NetworkSource& operator=(NetworkSource&&) = delete;
+
+    FillTupleBufferResult fillTupleBuffer(TupleBuffer& tupleBuffer, const std::stop_token& stopToken) override;
+
+    /// Listens for the connection of the NetworkSink
+    void open(std::shared_ptr<AbstractBufferProvider> bufferProvider) override;
+    void close() override;
+
+    static DescriptorConfig::Config validateAndFormat(std::unordered_map<std::string, std::string> config);
+
+    [[nodiscard]] std::ostream& toString(std::ostream& str) const override;
+
+private:
+    /// How long the source waits for the socket, before it checks whether a stop was requested
+    static constexpr std::chrono::milliseconds POLL_INTERVAL{100};
+
+    /// Waits until the socket is readable. Returns false, if a stop was requested before.
+    static bool waitUntilReadable(int socket, const std::stop_token& stopToken);
+
+    std::string host;
+    uint32_t port;
+    int listeningSocket = -1;
+    int connection = -1;
+    uint64_t receivedBytes = 0;
+};
+
+}
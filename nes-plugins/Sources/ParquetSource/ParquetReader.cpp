@@ -0,0 +1,1341 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <ParquetReader.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <ErrorHandling.hpp>
+#include <zstd.h>
+
+namespace NES
+{
+
+namespace
+{
+constexpr std::string_view MAGIC = "PAR1";
+
+enum PhysicalType : int32_t
+{
+    BOOLEAN = 0,
+    INT32 = 1,
+    INT64 = 2,
+    INT96 = 3,
+    FLOAT = 4,
+    DOUBLE = 5,
+    BYTE_ARRAY = 6,
+    FIXED_LEN_BYTE_ARRAY = 7
+};
+
+enum ConvertedType : int32_t
+{
+    NONE = -1,
+    UINT_8 = 11,
+    UINT_16 = 12,
+    UINT_32 = 13,
+    UINT_64 = 14
+};
+
+enum Encoding : int32_t
+{
+    PLAIN = 0,
+    PLAIN_DICTIONARY = 2,
+    RLE = 3,
+    RLE_DICTIONARY = 8
+};
+
+enum CompressionCodec : int32_t
+{
+    UNCOMPRESSED = 0,
+    ZSTD = 6
+};
+
+enum PageType : int32_t
+{
+    DATA_PAGE = 0,
+    DICTIONARY_PAGE = 2,
+    DATA_PAGE_V2 = 3
+};
+
+constexpr int32_t REPEATED = 2;
+constexpr int32_t OPTIONAL = 1;
+
+bool isSigned(const int32_t convertedType)
+{
+    return convertedType < UINT_8 or convertedType > UINT_64;
+}
+
+/// Reads values of the Thrift compact protocol, which encodes the metadata of Parquet files
+class CompactProtocolReader
+{
+public:
+    enum Type : uint8_t
+    {
+        BOOLEAN_TRUE = 1,
+        BOOLEAN_FALSE = 2,
+        BYTE = 3,
+        I16 = 4,
+        I32 = 5,
+        I64 = 6,
+        DOUBLE = 7,
+        BINARY = 8,
+        LIST = 9,
+        SET = 10,
+        MAP = 11,
+        STRUCT = 12
+    };
+
+    explicit CompactProtocolReader(const std::string_view bytes) : bytes(bytes) { }
+
+    /// Calls 'readField(fieldId, type)' for every field of the struct, which must read or skip the value of the field
+    template <typename Function>
+    void readStruct(Function&& readField)
+    {
+        int16_t fieldId = 0;
+        for (auto header = readByte(); header != 0; header = readByte())
+        {
+            const auto delta = header >> 4;
+            fieldId = delta == 0 ? static_cast<int16_t>(readInteger()) : static_cast<int16_t>(fieldId + delta);
+            readField(fieldId, static_cast<Type>(header & 0x0F));
+        }
+    }
+
+    /// Calls 'readElement(type)' for every element of the list, which must read or skip the element
+    template <typename Function>
+    void readList(Function&& readElement)
+    {
+        const auto header = readByte();
+        const uint64_t size = (header >> 4) == 0x0F ? readVarint() : header >> 4;
+        for (uint64_t element = 0; element < size; ++element)
+        {
+            readElement(static_cast<Type>(header & 0x0F));
+        }
+    }
+
+    int64_t readInteger()
+    {
+        const auto value = readVarint();
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    int32_t readI32()
+    {
+        const auto value = readInteger();
+        if (value < INT32_MIN or value > INT32_MAX)
+        {
+            throw CannotFormatSourceData("Parquet file is malformed: {} is not a 32 bit integer", value);
+        }
+        return static_cast<int32_t>(value);
+    }
+
+    /// Reads an integer that must not be negative, e.g., a size or an offset
+    uint64_t readUnsigned()
+    {
+        const auto value = readInteger();
+        if (value < 0)
+        {
+            throw CannotFormatSourceData("Parquet file is malformed: expected a positive integer, but got {}", value);
+        }
+        return static_cast<uint64_t>(value);
+    }
+
+    std::string_view readBinary()
+    {
+        const auto size = readVarint();
+        ensureRemaining(size);
+        const auto value = bytes.substr(position, size);
+        position += size;
+        return value;
+    }
+
+    /// Booleans of fields are encoded in the type of the field
+    static bool readBoolean(const Type type) { return type == BOOLEAN_TRUE; }
+
+    void skip(const Type type) { skip(type, 0); }
+
+    [[nodiscard]] size_t getPosition() const { return position; }
+
+private:
+    /// Limits the nesting of skipped values, so that malformed metadata does not overflow the stack
+    static constexpr size_t MAX_DEPTH = 64;
+
+    void ensureRemaining(const uint64_t size) const
+    {
+        if (size > bytes.size() - position)
+        {
+            throw CannotFormatSourceData("Parquet file is malformed: metadata ends after {} bytes", bytes.size());
+        }
+    }
+
+    uint8_t readByte()
+    {
+        ensureRemaining(1);
+        return static_cast<uint8_t>(bytes[position++]);
+    }
+
+    uint64_t readVarint()
+    {
+        uint64_t value = 0;
+        for (size_t shift = 0; shift < 64; shift += 7)
+        {
+            const auto byte = readByte();
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return value;
+            }
+        }
+        throw CannotFormatSourceData("Parquet file is malformed: varint exceeds 64 bits");
+    }
+
+    void skip(const Type type, const size_t depth)
+    {
+        if (depth > MAX_DEPTH)
+        {
+            throw CannotFormatSourceData("Parquet file is malformed: metadata is nested more than {} levels", MAX_DEPTH);
+        }
+        switch (type)
+        {
+            case BOOLEAN_TRUE:
+            case BOOLEAN_FALSE:
+                return;
+            case BYTE:
+                readByte();
+                return;
+            case I16:
+            case I32:
+            case I64:
+                readVarint();
+                return;
+            case DOUBLE:
+                ensureRemaining(sizeof(double));
+                position += sizeof(double);
+                return;
+            case BINARY:
+                readBinary();
+                return;
+            case LIST:
+            case SET:
+                readList([&](const Type elementType) { skipElement(elementType, depth + 1); });
+                return;
+            case MAP: {
+                const auto size = readVarint();
+                if (size == 0)
+                {
+                    return;
+                }
+                const auto types = readByte();
+                for (uint64_t entry = 0; entry < size; ++entry)
+                {
+                    skipElement(static_cast<Type>(types >> 4), depth + 1);
+                    skipElement(static_cast<Type>(types & 0x0F), depth + 1);
+                }
+                return;
+            }
+            case STRUCT:
+                readStruct([&](int16_t, const Type fieldType) { skip(fieldType, depth + 1); });
+                return;
+        }
+        throw CannotFormatSourceData("Parquet file is malformed: unknown type {} in metadata", static_cast<int>(type));
+    }
+
+    /// In contrast to fields, the booleans of lists and maps are encoded as bytes
+    void skipElement(const Type type, const size_t depth)
+    {
+        if (type == BOOLEAN_TRUE or type == BOOLEAN_FALSE)
+        {
+            readByte();
+            return;
+        }
+        skip(type, depth);
+    }
+
+    std::string_view bytes;
+    size_t position = 0;
+};
+
+/// Decodes values of the RLE/bit-packing hybrid encoding, which encodes definition levels and dictionary indices
+class HybridDecoder
+{
+public:
+    HybridDecoder(const std::string_view bytes, const uint8_t bitWidth) : bytes(bytes), bitWidth(bitWidth)
+    {
+        if (bitWidth > 32)
+        {
+            throw CannotFormatSourceData("Parquet file is malformed: bit width {} exceeds 32 bits", bitWidth);
+        }
+    }
+
+    void decode(const uint64_t numberOfValues, std::vector<uint32_t>& values)
+    {
+        values.clear();
+        values.reserve(numberOfValues);
+        while (values.size() < numberOfValues)
+        {
+            const auto header = readVarint();
+            const auto remainingValues = numberOfValues - values.size();
+            if ((header & 1) == 0)
+            {
+                const auto runLength = std::min<uint64_t>(header >> 1, remainingValues);
+                const size_t valueBytes = (bitWidth + 7) / 8;
+                ensureRemaining(valueBytes);
+                uint32_t value = 0;
+                for (size_t byte = 0; byte < valueBytes; ++byte)
+                {
+                    value |= static_cast<uint32_t>(static_cast<uint8_t>(bytes[position + byte])) << (8 * byte);
+                }
+                position += valueBytes;
+                values.insert(values.end(), runLength, value);
+                continue;
+            }
+
+            /// A bit-packed run consists of groups of eight values, whose bits are packed from the least significant bit on
+            const auto numberOfGroups = header >> 1;
+            if (numberOfGroups > (bytes.size() - position) / std::max<uint8_t>(bitWidth, 1))
+            {
+                throw CannotFormatSourceData("Parquet file is malformed: bit-packed run exceeds its page");
+            }
+            const auto runBytes = numberOfGroups * bitWidth;
+            const auto run = bytes.substr(position, runBytes);
+            const auto valuesOfRun = std::min<uint64_t>(numberOfGroups * 8, remainingValues);
+            const uint64_t mask = (uint64_t{1} << bitWidth) - 1;
+            for (uint64_t value = 0; value < valuesOfRun; ++value)
+            {
+                const auto firstBit = value * bitWidth;
+                uint64_t window = 0;
+                for (size_t byte = 0; byte * 8 < (firstBit % 8) + bitWidth; ++byte)
+                {
+                    window |= static_cast<uint64_t>(static_cast<uint8_t>(run[(firstBit / 8) + byte])) << (8 * byte);
+                }
+                values.push_back(static_cast<uint32_t>((window >> (firstBit % 8)) & mask));
+            }
+            position += runBytes;
+        }
+    }
+
+private:
+    void ensureRemaining(const uint64_t size) const
+    {
+        if (size > bytes.size() - position)
+        {
+            throw CannotFormatSourceData("Parquet file is malformed: RLE encoded values exceed their page");
+        }
+    }
+
+    uint64_t readVarint()
+    {
+        uint64_t value = 0;
+        for (size_t shift = 0; shift < 64; shift += 7)
+        {
+            ensureRemaining(1);
+            const auto byte = static_cast<uint8_t>(bytes[position++]);
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return value;
+            }
+        }
+        throw CannotFormatSourceData("Parquet file is malformed: varint exceeds 64 bits");
+    }
+
+    std::string_view bytes;
+    uint8_t bitWidth;
+    size_t position = 0;
+};
+
+bool isConvertible(const DataType& dataType, const int32_t physicalType)
+{
+    switch (dataType.type)
+    {
+        case DataType::Type::UINT8:
+        case DataType::Type::UINT16:
+        case DataType::Type::UINT32:
+        case DataType::Type::UINT64:
+        case DataType::Type::INT8:
+        case DataType::Type::INT16:
+        case DataType::Type::INT32:
+        case DataType::Type::INT64:
+        case DataType::Type::TIMESTAMP:
+        case DataType::Type::INTERVAL:
+        /// The reader takes the unscaled integers of a decimal column as is, i.e., the file must use the scale of the schema
+        case DataType::Type::DECIMAL:
+            return physicalType == INT32 or physicalType == INT64;
+        case DataType::Type::FLOAT32:
+        case DataType::Type::FLOAT64:
+            return physicalType == FLOAT or physicalType == DOUBLE;
+        case DataType::Type::BOOLEAN:
+            return physicalType == BOOLEAN;
+        case DataType::Type::CHAR:
+        case DataType::Type::VARSIZED:
+            return physicalType == BYTE_ARRAY or physicalType == FIXED_LEN_BYTE_ARRAY;
+        case DataType::Type::UNDEFINED:
+            return false;
+    }
+    std::unreachable();
+}
+
+template <typename T>
+T readValue(const std::string_view bytes, const size_t position)
+{
+    T value;
+    std::memcpy(&value, bytes.data() + position, sizeof(T));
+    return value;
+}
+
+template <typename Target, typename Physical>
+void appendConverted(
+    const std::string_view encodedValues, const uint64_t numberOfValues, const bool isUnsigned, std::vector<std::byte>& values)
+{
+    const auto firstValue = values.size();
+    values.resize(firstValue + (numberOfValues * sizeof(Target)));
+    if constexpr (sizeof(Target) == sizeof(Physical) and std::is_integral_v<Target> == std::is_integral_v<Physical>)
+    {
+        /// The bits of a value are the same, e.g., for the UINT_32 that an INT32 annotates
+        std::memcpy(values.data() + firstValue, encodedValues.data(), numberOfValues * sizeof(Target));
+    }
+    else
+    {
+        for (uint64_t value = 0; value < numberOfValues; ++value)
+        {
+            const auto physical = readValue<Physical>(encodedValues, value * sizeof(Physical));
+            Target target;
+            if constexpr (std::is_same_v<Physical, int32_t>)
+            {
+                target = isUnsigned ? static_cast<Target>(static_cast<uint32_t>(physical)) : static_cast<Target>(physical);
+            }
+            else
+            {
+                target = static_cast<Target>(physical);
+            }
+            std::memcpy(values.data() + firstValue + (value * sizeof(Target)), &target, sizeof(Target));
+        }
+    }
+}
+
+/// Appends the PLAIN encoded integers or floating point numbers in the representation of the data type
+template <typename Physical>
+void appendPlainNumbers(
+    const DataType& dataType,
+    const std::string_view encodedValues,
+    const uint64_t numberOfValues,
+    const bool isUnsigned,
+    std::vector<std::byte>& values)
+{
+    if (numberOfValues > encodedValues.size() / sizeof(Physical))
+    {
+        throw CannotFormatSourceData("Parquet file is malformed: {} values exceed their page", numberOfValues);
+    }
+    switch (dataType.type)
+    {
+        case DataType::Type::UINT8:
+            return appendConverted<uint8_t, Physical>(encodedValues, numberOfValues, isUnsigned, values);
+        case DataType::Type::UINT16:
+            return appendConverted<uint16_t, Physical>(encodedValues, numberOfValues, isUnsigned, values);
+        case DataType::Type::UINT32:
+            return appendConverted<uint32_t, Physical>(encodedValues, numberOfValues, isUnsigned, values);
+        case DataType::Type::UINT64:
+        case DataType::Type::TIMESTAMP:
+            return appendConverted<uint64_t, Physical>(encodedValues, numberOfValues, isUnsigned, values);
+        case DataType::Type::INT8:
+            return appendConverted<int8_t, Physical>(encodedValues, numberOfValues, isUnsigned, values);
+        case DataType::Type::INT16:
+            return appendConverted<int16_t, Physical>(encodedValues, numberOfValues, isUnsigned, values);
+        case DataType::Type::INT32:
+            return appendConverted<int32_t, Physical>(encodedValues, numberOfValues, isUnsigned, values);
+        case DataType::Type::INT64:
+        case DataType::Type::INTERVAL:
+        case DataType::Type::DECIMAL:
+            return appendConverted<int64_t, Physical>(encodedValues, numberOfValues, isUnsigned, values);
+        case DataType::Type::FLOAT32:
+            return appendConverted<float, Physical>(encodedValues, numberOfValues, isUnsigned, values);
+        case DataType::Type::FLOAT64:
+            return appendConverted<double, Physical>(encodedValues, numberOfValues, isUnsigned, values);
+        default:
+            INVARIANT(false, "The reader only converts numbers to numeric data types");
+    }
+}
+
+void appendByteArray(const DataType& dataType, const std::string_view value, ParquetColumnValues& values)
+{
+    if (dataType.type == DataType::Type::CHAR)
+    {
+        if (value.size() != 1)
+        {
+            throw CannotFormatSourceData("Parquet file contains a value of {} bytes for a CHAR field", value.size());
+        }
+        values.fixedSizeValues.push_back(static_cast<std::byte>(value.front()));
+        return;
+    }
+    values.varSizedBytes.append(value);
+    values.varSizedOffsets.push_back(values.varSizedBytes.size());
+}
+
+/// Appends the 'count' values at 'first' of 'source' to 'target'
+void appendValues(
+    const DataType& dataType, const ParquetColumnValues& source, const uint64_t first, const uint64_t count, ParquetColumnValues& target)
+{
+    if (dataType.type != DataType::Type::VARSIZED)
+    {
+        const auto size = dataType.getSizeInBytesWithoutNull();
+        const auto values = source.fixedSizeValues.begin() + static_cast<std::ptrdiff_t>(first * size);
+        target.fixedSizeValues.insert(target.fixedSizeValues.end(), values, values + static_cast<std::ptrdiff_t>(count * size));
+        return;
+    }
+    const auto begin = source.varSizedOffsets[first];
+    const auto end = source.varSizedOffsets[first + count];
+    const auto offsetInTarget = target.varSizedBytes.size();
+    target.varSizedBytes.append(source.varSizedBytes, begin, end - begin);
+    for (uint64_t value = first + 1; value <= first + count; ++value)
+    {
+        target.varSizedOffsets.push_back(offsetInTarget + source.varSizedOffsets[value] - begin);
+    }
+}
+
+void appendNull(const DataType& dataType, ParquetColumnValues& values)
+{
+    if (dataType.type == DataType::Type::VARSIZED)
+    {
+        values.varSizedOffsets.push_back(values.varSizedBytes.size());
+        return;
+    }
+    values.fixedSizeValues.resize(values.fixedSizeValues.size() + dataType.getSizeInBytesWithoutNull());
+}
+
+ParquetColumnValues createColumnValues()
+{
+    ParquetColumnValues values;
+    values.varSizedOffsets.push_back(0);
+    return values;
+}
+
+std::string_view decompress(const int32_t codec, const std::string_view compressed, const uint64_t uncompressedSize, std::string& storage)
+{
+    if (codec == UNCOMPRESSED)
+    {
+        return compressed;
+    }
+    INVARIANT(codec == ZSTD, "The reader rejects files with codecs other than zstd");
+    storage.resize(uncompressedSize);
+    const auto decompressedSize = ZSTD_decompress(storage.data(), storage.size(), compressed.data(), compressed.size());
+    if (ZSTD_isError(decompressedSize) != 0 or decompressedSize != uncompressedSize)
+    {
+        throw CannotFormatSourceData("Parquet file contains a page that cannot be decompressed: {}", ZSTD_getErrorName(decompressedSize));
+    }
+    return storage;
+}
+
+template <typename T>
+bool mayMatch(const T min, const T max, const ParquetPredicate::Comparison comparison, const T value)
+{
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        if (std::isnan(min) or std::isnan(max))
+        {
+            return true;
+        }
+    }
+    switch (comparison)
+    {
+        case ParquetPredicate::Comparison::LESS:
+            return min < value;
+        case ParquetPredicate::Comparison::LESS_EQUALS:
+            return min <= value;
+        case ParquetPredicate::Comparison::GREATER:
+            return max > value;
+        case ParquetPredicate::Comparison::GREATER_EQUALS:
+            return max >= value;
+        case ParquetPredicate::Comparison::EQUALS:
+            return min <= value and value <= max;
+    }
+    std::unreachable();
+}
+
+template <typename T>
+std::optional<T> parseNumber(const std::string_view value)
+{
+    T number{};
+    const auto [end, errorCode] = std::from_chars(value.data(), value.data() + value.size(), number);
+    if (errorCode != std::errc{} or end != value.data() + value.size())
+    {
+        return std::nullopt;
+    }
+    return number;
+}
+
+std::string_view trim(std::string_view value)
+{
+    const auto first = value.find_first_not_of(' ');
+    if (first == std::string_view::npos)
+    {
+        return {};
+    }
+    return value.substr(first, value.find_last_not_of(' ') - first + 1);
+}
+
+/// Compares the constant with the statistics, if they have the width of the physical type of the column
+template <typename Statistic, typename T>
+bool mayMatchStatistics(const std::string& min, const std::string& max, const ParquetPredicate::Comparison comparison, const T value)
+{
+    if (min.size() != sizeof(Statistic) or max.size() != sizeof(Statistic))
+    {
+        return true;
+    }
+    return mayMatch<T>(static_cast<T>(readValue<Statistic>(min, 0)), static_cast<T>(readValue<Statistic>(max, 0)), comparison, value);
+}
+
+/// Finds the first element whose name equals the name, or else the first element whose name equals the unqualified name
+template <typename Elements, typename Projection>
+std::optional<size_t>
+findByName(const Elements& elements, const std::string_view name, const std::string_view unqualifiedName, const Projection& projection)
+{
+    for (const auto candidate : {name, unqualifiedName})
+    {
+        const auto element = std::ranges::find(elements, candidate, projection);
+        if (element != std::ranges::end(elements))
+        {
+            return static_cast<size_t>(std::ranges::distance(std::ranges::begin(elements), element));
+        }
+    }
+    return std::nullopt;
+}
+
+struct SchemaElement
+{
+    std::string name;
+    int32_t physicalType = -1;
+    int32_t convertedType = NONE;
+    int32_t typeLength = 0;
+    int32_t repetition = 0;
+    int32_t numberOfChildren = 0;
+};
+
+struct ColumnChunkMetadata
+{
+    bool external = false;
+    int32_t codec = UNCOMPRESSED;
+    uint64_t numberOfValues = 0;
+    uint64_t totalCompressedSize = 0;
+    uint64_t dataPageOffset = 0;
+    std::optional<uint64_t> dictionaryPageOffset;
+    std::optional<uint64_t> nullCount;
+    std::optional<std::string> minValue;
+    std::optional<std::string> maxValue;
+    /// The deprecated statistics, which writers ordered by signed comparisons
+    std::optional<std::string> deprecatedMin;
+    std::optional<std::string> deprecatedMax;
+};
+
+struct RowGroupMetadata
+{
+    uint64_t numberOfRows = 0;
+    std::vector<ColumnChunkMetadata> columnChunks;
+};
+
+struct FileMetadata
+{
+    std::vector<SchemaElement> schema;
+    std::vector<RowGroupMetadata> rowGroups;
+};
+
+SchemaElement readSchemaElement(CompactProtocolReader& reader)
+{
+    SchemaElement element;
+    reader.readStruct(
+        [&](const int16_t fieldId, const CompactProtocolReader::Type type)
+        {
+            switch (fieldId)
+            {
+                case 1:
+                    element.physicalType = reader.readI32();
+                    return;
+                case 2:
+                    element.typeLength = reader.readI32();
+                    return;
+                case 3:
+                    element.repetition = reader.readI32();
+                    return;
+                case 4:
+                    element.name = reader.readBinary();
+                    return;
+                case 5:
+                    element.numberOfChildren = reader.readI32();
+                    return;
+                case 6:
+                    element.convertedType = reader.readI32();
+                    return;
+                default:
+                    reader.skip(type);
+            }
+        });
+    return element;
+}
+
+void readStatistics(CompactProtocolReader& reader, ColumnChunkMetadata& columnChunk)
+{
+    reader.readStruct(
+        [&](const int16_t fieldId, const CompactProtocolReader::Type type)
+        {
+            switch (fieldId)
+            {
+                case 1:
+                    columnChunk.deprecatedMax = reader.readBinary();
+                    return;
+                case 2:
+                    columnChunk.deprecatedMin = reader.readBinary();
+                    return;
+                case 3:
+                    columnChunk.nullCount = reader.readUnsigned();
+                    return;
+                case 5:
+                    columnChunk.maxValue = reader.readBinary();
+                    return;
+                case 6:
+                    columnChunk.minValue = reader.readBinary();
+                    return;
+                default:
+                    reader.skip(type);
+            }
+        });
+}
+
+ColumnChunkMetadata readColumnChunk(CompactProtocolReader& reader)
+{
+    ColumnChunkMetadata columnChunk;
+    reader.readStruct(
+        [&](const int16_t fieldId, const CompactProtocolReader::Type type)
+        {
+            if (fieldId == 1)
+            {
+                /// The column chunk is stored in another file
+                reader.skip(type);
+                columnChunk.external = true;
+                return;
+            }
+            if (fieldId != 3)
+            {
+                reader.skip(type);
+                return;
+            }
+            reader.readStruct(
+                [&](const int16_t metadataFieldId, const CompactProtocolReader::Type metadataType)
+                {
+                    switch (metadataFieldId)
+                    {
+                        case 4:
+                            columnChunk.codec = reader.readI32();
+                            return;
+                        case 5:
+                            columnChunk.numberOfValues = reader.readUnsigned();
+                            return;
+                        case 7:
+                            columnChunk.totalCompressedSize = reader.readUnsigned();
+                            return;
+                        case 9:
+                            columnChunk.dataPageOffset = reader.readUnsigned();
+                            return;
+                        case 11:
+                            columnChunk.dictionaryPageOffset = reader.readUnsigned();
+                            return;
+                        case 12:
+                            readStatistics(reader, columnChunk);
+                            return;
+                        default:
+                            reader.skip(metadataType);
+                    }
+                });
+        });
+    return columnChunk;
+}
+
+RowGroupMetadata readRowGroup(CompactProtocolReader& reader)
+{
+    RowGroupMetadata rowGroup;
+    reader.readStruct(
+        [&](const int16_t fieldId, const CompactProtocolReader::Type type)
+        {
+            if (fieldId == 1)
+            {
+                reader.readList([&](CompactProtocolReader::Type) { rowGroup.columnChunks.push_back(readColumnChunk(reader)); });
+                return;
+            }
+            if (fieldId == 3)
+            {
+                rowGroup.numberOfRows = reader.readUnsigned();
+                return;
+            }
+            reader.skip(type);
+        });
+    return rowGroup;
+}
+
+FileMetadata readFileMetadata(const std::string_view footer)
+{
+    FileMetadata metadata;
+    CompactProtocolReader reader(footer);
+    reader.readStruct(
+        [&](const int16_t fieldId, const CompactProtocolReader::Type type)
+        {
+            if (fieldId == 2)
+            {
+                reader.readList([&](CompactProtocolReader::Type) { metadata.schema.push_back(readSchemaElement(reader)); });
+                return;
+            }
+            if (fieldId == 4)
+            {
+                reader.readList([&](CompactProtocolReader::Type) { metadata.rowGroups.push_back(readRowGroup(reader)); });
+                return;
+            }
+            reader.skip(type);
+        });
+    return metadata;
+}
+
+struct PageHeader
+{
+    int32_t type = -1;
+    uint64_t uncompressedSize = 0;
+    uint64_t compressedSize = 0;
+    uint64_t numberOfValues = 0;
+    int32_t encoding = PLAIN;
+    /// Only data pages of version 2 store their levels uncompressed and without a length prefix
+    uint64_t definitionLevelsSize = 0;
+    uint64_t repetitionLevelsSize = 0;
+    bool isCompressed = true;
+};
+
+PageHeader readPageHeader(CompactProtocolReader& reader)
+{
+    PageHeader header;
+    reader.readStruct(
+        [&](const int16_t fieldId, const CompactProtocolReader::Type type)
+        {
+            switch (fieldId)
+            {
+                case 1:
+                    header.type = reader.readI32();
+                    return;
+                case 2:
+                    header.uncompressedSize = reader.readUnsigned();
+                    return;
+                case 3:
+                    header.compressedSize = reader.readUnsigned();
+                    return;
+                case 5:
+                case 7:
+                    /// The headers of data pages (of version 1) and dictionary pages begin with the number of values and their encoding
+                    reader.readStruct(
+                        [&](const int16_t pageFieldId, const CompactProtocolReader::Type pageType)
+                        {
+                            if (pageFieldId == 1)
+                            {
+                                header.numberOfValues = reader.readUnsigned();
+                            }
+                            else if (pageFieldId == 2)
+                            {
+                                header.encoding = reader.readI32();
+                            }
+                            else
+                            {
+                                reader.skip(pageType);
+                            }
+                        });
+                    return;
+                case 8:
+                    reader.readStruct(
+                        [&](const int16_t pageFieldId, const CompactProtocolReader::Type pageType)
+                        {
+                            switch (pageFieldId)
+                            {
+                                case 1:
+                                    header.numberOfValues = reader.readUnsigned();
+                                    return;
+                                case 4:
+                                    header.encoding = reader.readI32();
+                                    return;
+                                case 5:
+                                    header.definitionLevelsSize = reader.readUnsigned();
+                                    return;
+                                case 6:
+                                    header.repetitionLevelsSize = reader.readUnsigned();
+                                    return;
+                                case 7:
+                                    header.isCompressed = CompactProtocolReader::readBoolean(pageType);
+                                    return;
+                                default:
+                                    reader.skip(pageType);
+                            }
+                        });
+                    return;
+                default:
+                    reader.skip(type);
+            }
+        });
+    return header;
+}
+}
+
+std::optional<std::vector<ParquetPredicate>> ParquetPredicate::parse(const std::string_view predicates)
+{
+    std::vector<ParquetPredicate> parsed;
+    for (size_t position = 0; position < predicates.size();)
+    {
+        const auto end = std::min(predicates.find(',', position), predicates.size());
+        const auto predicate = predicates.substr(position, end - position);
+        position = end + 1;
+
+        const auto operatorPosition = predicate.find_first_of("<>=");
+        if (operatorPosition == std::string_view::npos)
+        {
+            return std::nullopt;
+        }
+        const bool withEquals = operatorPosition + 1 < predicate.size() and predicate[operatorPosition + 1] == '=';
+        Comparison comparison{};
+        switch (predicate[operatorPosition])
+        {
+            case '<':
+                comparison = withEquals ? Comparison::LESS_EQUALS : Comparison::LESS;
+                break;
+            case '>':
+                comparison = withEquals ? Comparison::GREATER_EQUALS : Comparison::GREATER;
+                break;
+            default:
+                comparison = Comparison::EQUALS;
+                break;
+        }
+        const auto fieldName = trim(predicate.substr(0, operatorPosition));
+        const auto value = trim(predicate.substr(operatorPosition + (withEquals and comparison != Comparison::EQUALS ? 2 : 1)));
+        if (fieldName.empty() or value.empty())
+        {
+            return std::nullopt;
+        }
+        parsed.emplace_back(std::string(fieldName), comparison, std::string(value));
+    }
+    return parsed;
+}
+
+ParquetFileReader::ParquetFileReader(std::string filePath, const Schema& schema, const std::vector<ParquetPredicate>& predicates)
+    : filePath(std::move(filePath))
+{
+    PRECONDITION(schema.hasFields(), "The Parquet source requires a schema with at least one field");
+    std::ifstream file(this->filePath, std::ios::binary | std::ios::ate);
+    if (not file)
+    {
+        throw CannotOpenSource("Could not open Parquet file {}", this->filePath);
+    }
+    const auto fileSize = static_cast<uint64_t>(file.tellg());
+    std::string trailer(sizeof(uint32_t) + MAGIC.size(), '\0');
+    if (fileSize < MAGIC.size() + trailer.size()
+        or not file.seekg(static_cast<std::streamoff>(fileSize - trailer.size()))
+                   .read(trailer.data(), static_cast<std::streamsize>(trailer.size()))
+        or trailer.substr(sizeof(uint32_t)) != MAGIC)
+    {
+        throw CannotOpenSource("{} is not a Parquet file", this->filePath);
+    }
+    const auto footerSize = readValue<uint32_t>(trailer, 0);
+    if (footerSize > fileSize - MAGIC.size() - trailer.size())
+    {
+        throw CannotOpenSource("Parquet file {} is malformed: its footer of {} bytes exceeds the file", this->filePath, footerSize);
+    }
+    std::string footer(footerSize, '\0');
+    if (not file.seekg(static_cast<std::streamoff>(fileSize - trailer.size() - footerSize)).read(footer.data(), footerSize))
+    {
+        throw CannotOpenSource("Could not read the footer of Parquet file {}", this->filePath);
+    }
+    const auto metadata = readFileMetadata(footer);
+
+    /// The leaves of a flat schema are the children of its root, in the order of the column chunks of the row groups
+    if (metadata.schema.empty() or static_cast<size_t>(metadata.schema.front().numberOfChildren) != metadata.schema.size() - 1
+        or std::ranges::any_of(
+            metadata.schema | std::views::drop(1),
+            [](const SchemaElement& leaf) { return leaf.numberOfChildren > 0 or leaf.repetition == REPEATED; }))
+    {
+        throw CannotOpenSource("The Parquet source only reads files with a flat schema without repeated fields: {}", this->filePath);
+    }
+    const auto leaves = metadata.schema | std::views::drop(1);
+    std::vector<size_t> leafOfField;
+    for (const auto& field : schema.getFields())
+    {
+        const auto leaf = findByName(leaves, field.name, field.getUnqualifiedName(), &SchemaElement::name);
+        if (not leaf.has_value())
+        {
+            throw CannotOpenSource("Parquet file {} does not contain a column for the field {}", this->filePath, field.name);
+        }
+        const auto& element = leaves[*leaf];
+        if (not isConvertible(field.dataType, element.physicalType)
+            or (element.physicalType == FIXED_LEN_BYTE_ARRAY and element.typeLength <= 0))
+        {
+            throw CannotOpenSource(
+                "Column {} of Parquet file {} has the physical type {}, which cannot be read as {}",
+                element.name,
+                this->filePath,
+                element.physicalType,
+                field.dataType);
+        }
+        columns.emplace_back(
+            field.dataType, element.physicalType, element.convertedType, element.typeLength, element.repetition == OPTIONAL);
+        leafOfField.push_back(*leaf);
+    }
+
+    for (const auto& [numberOfRows, columnChunks] : metadata.rowGroups)
+    {
+        if (columnChunks.size() != leaves.size())
+        {
+            throw CannotOpenSource("Parquet file {} is malformed: a row group does not contain a column chunk per column", this->filePath);
+        }
+        auto& rowGroup = rowGroups.emplace_back(numberOfRows, std::vector<ColumnChunk>{});
+        for (size_t field = 0; field < columns.size(); ++field)
+        {
+            const auto& columnChunk = columnChunks[leafOfField[field]];
+            if (columnChunk.external or (columnChunk.codec != UNCOMPRESSED and columnChunk.codec != ZSTD))
+            {
+                throw CannotOpenSource(
+                    "The Parquet source only reads column chunks of the file itself that are uncompressed or compressed with zstd, but "
+                    "the column chunk of {} is stored in {} file with codec {}",
+                    schema.getFieldAt(field).name,
+                    columnChunk.external ? "another" : "the",
+                    columnChunk.codec);
+            }
+            /// The dictionary page precedes the data pages, if the column chunk has one
+            const auto offset = columnChunk.dictionaryPageOffset.value_or(0) > 0
+                    and columnChunk.dictionaryPageOffset.value_or(0) < columnChunk.dataPageOffset
+                ? *columnChunk.dictionaryPageOffset
+                : columnChunk.dataPageOffset;
+            if (columnChunk.numberOfValues != numberOfRows or offset > fileSize or columnChunk.totalCompressedSize > fileSize - offset)
+            {
+                throw CannotOpenSource(
+                    "Parquet file {} is malformed: invalid column chunk of {}", this->filePath, schema.getFieldAt(field).name);
+            }
+            const bool hasStatistics = columnChunk.minValue.has_value() and columnChunk.maxValue.has_value();
+            const bool useDeprecatedStatistics = not hasStatistics and isSigned(columns[field].convertedType);
+            rowGroup.columnChunks.emplace_back(
+                columnChunk.codec,
+                columnChunk.numberOfValues,
+                offset,
+                columnChunk.totalCompressedSize,
+                columnChunk.nullCount,
+                useDeprecatedStatistics ? columnChunk.deprecatedMin : columnChunk.minValue,
+                useDeprecatedStatistics ? columnChunk.deprecatedMax : columnChunk.maxValue);
+        }
+    }
+
+    for (const auto& [fieldName, comparison, value] : predicates)
+    {
+        const auto& fields = schema.getFields();
+        const auto field = std::ranges::find_if(
+            fields,
+            [&](const Schema::Field& candidate) { return candidate.name == fieldName or candidate.getUnqualifiedName() == fieldName; });
+        if (field == fields.end())
+        {
+            throw InvalidConfigParameter("The Parquet predicate on {} references a field that is not part of the schema", fieldName);
+        }
+        const auto fieldIndex = static_cast<size_t>(field - fields.begin());
+        const auto& column = columns[fieldIndex];
+        std::optional<std::variant<int64_t, uint64_t, double>> boundValue;
+        if (column.physicalType == FLOAT or column.physicalType == DOUBLE)
+        {
+            boundValue = parseNumber<double>(value);
+        }
+        else if ((column.physicalType == INT32 or column.physicalType == INT64) and isSigned(column.convertedType))
+        {
+            boundValue = parseNumber<int64_t>(value);
+        }
+        else if (column.physicalType == INT32 or column.physicalType == INT64)
+        {
+            boundValue = parseNumber<uint64_t>(value);
+        }
+        if (not boundValue.has_value())
+        {
+            throw InvalidConfigParameter("The Parquet predicate on {} requires a numeric field and a number, but got {}", fieldName, value);
+        }
+        this->predicates.emplace_back(fieldIndex, comparison, *boundValue);
+    }
+}
+
+bool ParquetFileReader::mayMatch(const size_t rowGroup) const
+{
+    return std::ranges::all_of(predicates, [&](const BoundPredicate& predicate) { return mayMatch(rowGroups.at(rowGroup), predicate); });
+}
+
+bool ParquetFileReader::mayMatch(const RowGroup& rowGroup, const BoundPredicate& predicate) const
+{
+    const auto& columnChunk = rowGroup.columnChunks[predicate.field];
+    /// Comparisons with null are never true
+    if (rowGroup.numberOfRows > 0 and columnChunk.nullCount == rowGroup.numberOfRows)
+    {
+        return false;
+    }
+    if (not columnChunk.minValue.has_value() or not columnChunk.maxValue.has_value())
+    {
+        return true;
+    }
+    const auto& min = *columnChunk.minValue;
+    const auto& max = *columnChunk.maxValue;
+    const auto& column = columns[predicate.field];
+    const bool isUnsigned = not isSigned(column.convertedType);
+    switch (column.physicalType)
+    {
+        case INT32:
+            return isUnsigned ? mayMatchStatistics<uint32_t>(min, max, predicate.comparison, std::get<uint64_t>(predicate.value))
+                              : mayMatchStatistics<int32_t>(min, max, predicate.comparison, std::get<int64_t>(predicate.value));
+        case INT64:
+            return isUnsigned ? mayMatchStatistics<uint64_t>(min, max, predicate.comparison, std::get<uint64_t>(predicate.value))
+                              : mayMatchStatistics<int64_t>(min, max, predicate.comparison, std::get<int64_t>(predicate.value));
+        case FLOAT:
+            return mayMatchStatistics<float>(min, max, predicate.comparison, std::get<double>(predicate.value));
+        case DOUBLE:
+            return mayMatchStatistics<double>(min, max, predicate.comparison, std::get<double>(predicate.value));
+        default:
+            return true;
+    }
+}
+
+void ParquetFileReader::appendPageValues(
+    const Column& column,
+    const int32_t encoding,
+    const std::string_view encodedValues,
+    const uint64_t numberOfValues,
+    const std::optional<ParquetColumnValues>& dictionary,
+    ParquetColumnValues& values)
+{
+    if (encoding == PLAIN_DICTIONARY or encoding == RLE_DICTIONARY)
+    {
+        if (not dictionary.has_value() or encodedValues.empty())
+        {
+            throw CannotFormatSourceData("Parquet file contains a dictionary encoded page without a dictionary");
+        }
+        const auto dictionarySize = column.dataType.type == DataType::Type::VARSIZED
+            ? dictionary->varSizedOffsets.size() - 1
+            : dictionary->fixedSizeValues.size() / column.dataType.getSizeInBytesWithoutNull();
+        std::vector<uint32_t> indices;
+        HybridDecoder(encodedValues.substr(1), static_cast<uint8_t>(encodedValues.front())).decode(numberOfValues, indices);
+        for (const auto index : indices)
+        {
+            if (index >= dictionarySize)
+            {
+                throw CannotFormatSourceData("Parquet file contains the index {} of a dictionary of {} values", index, dictionarySize);
+            }
+            appendValues(column.dataType, *dictionary, index, 1, values);
+        }
+        return;
+    }
+    if (encoding != PLAIN)
+    {
+        throw CannotFormatSourceData("The Parquet source only reads PLAIN and dictionary encoded pages, but got encoding {}", encoding);
+    }
+
+    const bool isUnsigned = not isSigned(column.convertedType);
+    switch (column.physicalType)
+    {
+        case BOOLEAN:
+            if (numberOfValues > encodedValues.size() * 8)
+            {
+                throw CannotFormatSourceData("Parquet file is malformed: {} values exceed their page", numberOfValues);
+            }
+            for (uint64_t value = 0; value < numberOfValues; ++value)
+            {
+                const auto bits = static_cast<uint8_t>(encodedValues[value / 8]);
+                values.fixedSizeValues.push_back(static_cast<std::byte>((bits >> (value % 8)) & 1));
+            }
+            return;
+        case INT32:
+            return appendPlainNumbers<int32_t>(column.dataType, encodedValues, numberOfValues, isUnsigned, values.fixedSizeValues);
+        case INT64:
+            return appendPlainNumbers<int64_t>(column.dataType, encodedValues, numberOfValues, isUnsigned, values.fixedSizeValues);
+        case FLOAT:
+            return appendPlainNumbers<float>(column.dataType, encodedValues, numberOfValues, isUnsigned, values.fixedSizeValues);
+        case DOUBLE:
+            return appendPlainNumbers<double>(column.dataType, encodedValues, numberOfValues, isUnsigned, values.fixedSizeValues);
+        case BYTE_ARRAY:
+        case FIXED_LEN_BYTE_ARRAY: {
+            size_t position = 0;
+            for (uint64_t value = 0; value < numberOfValues; ++value)
+            {
+                uint64_t size = static_cast<uint64_t>(column.typeLength);
+                if (column.physicalType == BYTE_ARRAY)
+                {
+                    if (encodedValues.size() - position < sizeof(uint32_t))
+                    {
+                        throw CannotFormatSourceData("Parquet file is malformed: {} values exceed their page", numberOfValues);
+                    }
+                    size = readValue<uint32_t>(encodedValues, position);
+                    position += sizeof(uint32_t);
+                }
+                if (size > encodedValues.size() - position)
+                {
+                    throw CannotFormatSourceData("Parquet file is malformed: {} values exceed their page", numberOfValues);
+                }
+                appendByteArray(column.dataType, encodedValues.substr(position, size), values);
+                position += size;
+            }
+            return;
+        }
+        default:
+            INVARIANT(false, "The reader rejects columns of the physical type {}", column.physicalType);
+    }
+}
+
+ParquetColumnValues
+ParquetFileReader::readColumnChunk(const Column& column, const ColumnChunk& columnChunk, const uint64_t numberOfRows) const
+{
+    /// Every read opens the file, so that source threads read row groups concurrently
+    std::string bytes(columnChunk.size, '\0');
+    std::ifstream file(filePath, std::ios::binary);
+    if (not file.seekg(static_cast<std::streamoff>(columnChunk.offset)).read(bytes.data(), static_cast<std::streamsize>(bytes.size())))
+    {
+        throw RunningRoutineFailure(
+            "Could not read a column chunk of {} bytes at offset {} of {}", bytes.size(), columnChunk.offset, filePath);
+    }
+    const std::string_view chunk = bytes;
+
+    auto values = createColumnValues();
+    values.isNull.reserve(numberOfRows);
+    std::optional<ParquetColumnValues> dictionary;
+    std::string decompressed;
+    std::vector<uint32_t> definitionLevels;
+    size_t position = 0;
+    while (values.isNull.size() < numberOfRows)
+    {
+        CompactProtocolReader reader(chunk.substr(position));
+        const auto header = readPageHeader(reader);
+        position += reader.getPosition();
+        if (header.compressedSize > chunk.size() - position)
+        {
+            throw CannotFormatSourceData("Parquet file is malformed: a page of {} bytes exceeds its column chunk", header.compressedSize);
+        }
+        const auto page = chunk.substr(position, header.compressedSize);
+        position += header.compressedSize;
+
+        if (header.type == DICTIONARY_PAGE)
+        {
+            const auto encodedValues = decompress(columnChunk.codec, page, header.uncompressedSize, decompressed);
+            dictionary = createColumnValues();
+            appendPageValues(column, PLAIN, encodedValues, header.numberOfValues, std::nullopt, *dictionary);
+            continue;
+        }
+        if (header.type != DATA_PAGE and header.type != DATA_PAGE_V2)
+        {
+            continue;
+        }
+        if (header.numberOfValues > numberOfRows - values.isNull.size())
+        {
+            throw CannotFormatSourceData("Parquet file is malformed: its pages contain more values than the row group has rows");
+        }
+
+        std::string_view definitionLevelBytes;
+        std::string_view encodedValues;
+        if (header.type == DATA_PAGE)
+        {
+            const auto body = decompress(columnChunk.codec, page, header.uncompressedSize, decompressed);
+            encodedValues = body;
+            if (column.optional)
+            {
+                if (body.size() < sizeof(uint32_t) or readValue<uint32_t>(body, 0) > body.size() - sizeof(uint32_t))
+                {
+                    throw CannotFormatSourceData("Parquet file is malformed: the definition levels exceed their page");
+                }
+                const auto size = readValue<uint32_t>(body, 0);
+                definitionLevelBytes = body.substr(sizeof(uint32_t), size);
+                encodedValues = body.substr(sizeof(uint32_t) + size);
+            }
+        }
+        else
+        {
+            const auto levelsSize = header.repetitionLevelsSize + header.definitionLevelsSize;
+            if (header.repetitionLevelsSize > page.size() or header.definitionLevelsSize > page.size() or levelsSize > page.size()
+                or levelsSize > header.uncompressedSize)
+            {
+                throw CannotFormatSourceData("Parquet file is malformed: the levels exceed their page");
+            }
+            definitionLevelBytes = page.substr(header.repetitionLevelsSize, header.definitionLevelsSize);
+            encodedValues = header.isCompressed
+                ? decompress(columnChunk.codec, page.substr(levelsSize), header.uncompressedSize - levelsSize, decompressed)
+                : page.substr(levelsSize);
+        }
+
+        uint64_t numberOfNonNullValues = header.numberOfValues;
+        if (column.optional)
+        {
+            HybridDecoder(definitionLevelBytes, 1).decode(header.numberOfValues, definitionLevels);
+            numberOfNonNullValues = definitionLevels.size() - static_cast<uint64_t>(std::ranges::count(definitionLevels, 0U));
+        }
+        if (numberOfNonNullValues == header.numberOfValues)
+        {
+            appendPageValues(column, header.encoding, encodedValues, header.numberOfValues, dictionary, values);
+            values.isNull.insert(values.isNull.end(), header.numberOfValues, 0);
+            continue;
+        }
+        if (not column.dataType.nullable)
+        {
+            throw CannotFormatSourceData("Parquet file contains nulls in the column of a non-nullable field of type {}", column.dataType);
+        }
+
+        /// Interleaves the runs of non-null values with the nulls
+        auto nonNullValues = createColumnValues();
+        appendPageValues(column, header.encoding, encodedValues, numberOfNonNullValues, dictionary, nonNullValues);
+        uint64_t nextNonNullValue = 0;
+        for (uint64_t value = 0; value < header.numberOfValues;)
+        {
+            if (definitionLevels[value] == 0)
+            {
+                appendNull(column.dataType, values);
+                values.isNull.push_back(1);
+                ++value;
+                continue;
+            }
+            const auto startOfRun = definitionLevels.begin() + static_cast<std::ptrdiff_t>(value);
+            const auto lengthOfRun = static_cast<uint64_t>(std::ranges::find(startOfRun, definitionLevels.end(), 0U) - startOfRun);
+            appendValues(column.dataType, nonNullValues, nextNonNullValue, lengthOfRun, values);
+            values.isNull.insert(values.isNull.end(), lengthOfRun, 0);
+            nextNonNullValue += lengthOfRun;
+            value += lengthOfRun;
+        }
+    }
+    return values;
+}
+
+std::vector<ParquetColumnValues> ParquetFileReader::readRowGroup(const size_t rowGroup) const
+{
+    return readRowGroup(rowGroup, std::views::iota(size_t{0}, columns.size()) | std::ranges::to<std::vector>());
+}
+
+std::vector<ParquetColumnValues> ParquetFileReader::readRowGroup(const size_t rowGroup, const std::span<const size_t> fields) const
+{
+    const auto& [numberOfRows, columnChunks] = rowGroups.at(rowGroup);
+    std::vector<ParquetColumnValues> values(columns.size());
+    for (const auto field : fields)
+    {
+        PRECONDITION(field < columns.size(), "The field {} is not part of the schema of {} fields", field, columns.size());
+        values[field] = readColumnChunk(columns[field], columnChunks[field], numberOfRows);
+    }
+    return values;
+}
+
+}
@@ -0,0 +1,135 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+
+namespace NES
+{
+
+/// A comparison of a field with a constant, e.g., 'price>=100'. The reader skips row groups, whose statistics show that no row of the
+/// row group satisfies the predicate. The predicates do not filter rows, thus the query must still evaluate them.
+struct ParquetPredicate
+{
+    enum class Comparison : uint8_t
+    {
+        LESS,
+        LESS_EQUALS,
+        GREATER,
+        GREATER_EQUALS,
+        EQUALS
+    };
+
+    std::string fieldName;
+    Comparison comparison;
+    std::string value;
+
+    /// Parses a comma separated conjunction of predicates, e.g., 'price>=100,price<200', or returns nullopt if it is malformed
+    static std::optional<std::vector<ParquetPredicate>> parse(std::string_view predicates);
+};
+
+/// The values of the rows of a row group for one field of the schema, in the representation of the field's data type.
+/// VARSIZED values (and CHARs) keep their bytes in 'varSizedBytes', where the value of row i spans [varSizedOffsets[i], [i + 1]).
+struct ParquetColumnValues
+{
+    std::vector<uint8_t> isNull;
+    std::vector<std::byte> fixedSizeValues;
+    std::string varSizedBytes;
+    std::vector<uint64_t> varSizedOffsets;
+};
+
+/// Reads the row groups of a Parquet file that contains a flat schema. The reader only reads the column chunks of the fields of the
+/// schema, which the reader finds by their (unqualified) names. It supports PLAIN and dictionary encoded data pages (of version 1 and 2)
+/// that are uncompressed or compressed with zstd.
+class ParquetFileReader
+{
+public:
+    /// Reads and validates the footer of the file. Throws CannotOpenSource, if the file does not contain a column for every field of the
+    /// schema that can be converted to the field's data type.
+    ParquetFileReader(std::string filePath, const Schema& schema, const std::vector<ParquetPredicate>& predicates);
+
+    [[nodiscard]] size_t getNumberOfRowGroups() const { return rowGroups.size(); }
+
+    /// Returns false, if the statistics of the row group show that none of its rows satisfies all predicates
+    [[nodiscard]] bool mayMatch(size_t rowGroup) const;
+
+    /// Decodes the column chunks of the fields of the schema. The reader may decode different row groups concurrently.
+    [[nodiscard]] std::vector<ParquetColumnValues> readRowGroup(size_t rowGroup) const;
+    /// Decodes the column chunks of the given fields (indexes into the schema) only. The values of all other fields are empty.
+    [[nodiscard]] std::vector<ParquetColumnValues> readRowGroup(size_t rowGroup, std::span<const size_t> fields) const;
+
+private:
+    struct Column
+    {
+        DataType dataType;
+        int32_t physicalType;
+        int32_t convertedType;
+        int32_t typeLength;
+        bool optional;
+    };
+
+    struct ColumnChunk
+    {
+        int32_t codec;
+        uint64_t numberOfValues;
+        uint64_t offset;
+        uint64_t size;
+        std::optional<uint64_t> nullCount;
+        std::optional<std::string> minValue;
+        std::optional<std::string> maxValue;
+    };
+
+    struct RowGroup
+    {
+        uint64_t numberOfRows;
+        /// The column chunks of the fields of the schema only
+        std::vector<ColumnChunk> columnChunks;
+    };
+
+    struct BoundPredicate
+    {
+        size_t field;
+        ParquetPredicate::Comparison comparison;
+        /// The constant in the order of the statistics of the column, i.e., signed or unsigned integers or floating point numbers
+        std::variant<int64_t, uint64_t, double> value;
+    };
+
+    [[nodiscard]] bool mayMatch(const RowGroup& rowGroup, const BoundPredicate& predicate) const;
+    /// Decodes the (non-null) values of a page, which are encoded with the encoding of the page, and appends them to 'values'
+    static void appendPageValues(
+        const Column& column,
+        int32_t encoding,
+        std::string_view encodedValues,
+        uint64_t numberOfValues,
+        const std::optional<ParquetColumnValues>& dictionary,
+        ParquetColumnValues& values);
+    [[nodiscard]] ParquetColumnValues readColumnChunk(const Column& column, const ColumnChunk& columnChunk, uint64_t numberOfRows) const;
+
+    std::string filePath;
+    std::vector<Column> columns;
+    std::vector<RowGroup> rowGroups;
+    std::vector<BoundPredicate> predicates;
+};
+
+}
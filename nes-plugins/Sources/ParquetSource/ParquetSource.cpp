@@ -0,0 +1,305 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <ParquetSource.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <Configurations/Descriptor.hpp>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/NativeFrameHeader.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Runtime/VariableSizedAccess.hpp>
+#include <Sources/SourceDescriptor.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Strings.hpp>
+#include <ErrorHandling.hpp>
+#include <FileDataRegistry.hpp>
+#include <ParquetReader.hpp>
+#include <SourceRegistry.hpp>
+#include <SourceValidationRegistry.hpp>
+
+namespace NES
+{
+
+ParquetSource::ParquetSource(const SourceDescriptor& sourceDescriptor, const std::vector<std::string>& projections)
+    : filePath(sourceDescriptor.getFromConfig(ConfigParametersParquet::FILE_PATH))
+    , predicates(ParquetPredicate::parse(sourceDescriptor.getFromConfig(ConfigParametersParquet::PREDICATES)).value())
+    , parallelism(sourceDescriptor.getFromConfig(ConfigParametersParquet::PARALLELISM))
+    , sourceIndex(sourceDescriptor.getFromConfig(ConfigParametersParquet::SOURCE_INDEX))
+    , schema(*sourceDescriptor.getLogicalSource().getSchema())
+{
+    if (toUpperCase(sourceDescriptor.getParserConfig().parserType) != NATIVE_PARSER_TYPE)
+    {
+        throw InvalidConfigParameter("The Parquet source hands on native frames, thus it requires the NATIVE parser");
+    }
+    if (sourceIndex >= parallelism)
+    {
+        throw InvalidConfigParameter(
+            "The parquet_source_index {} must be smaller than the parquet_parallelism {}", sourceIndex, parallelism);
+    }
+    /// The source decodes all fields, if its successors read none of them, because it counts the rows of a row group via a decoded field
+    const auto isProjected = [&](const Schema::Field& field)
+    { return projections.empty() or std::ranges::find(projections, field.name) != projections.end(); };
+    const bool projectsAnyField = std::ranges::any_of(schema.getFields(), isProjected);
+    for (const auto& field : schema.getFields())
+    {
+        const bool varSized = field.dataType.type == DataType::Type::VARSIZED;
+        const bool decoded = isProjected(field) or not projectsAnyField;
+        fieldLayouts.emplace_back(sizeOfTuple, field.dataType.getSizeInBytesWithoutNull(), field.dataType.nullable, varSized, decoded);
+        if (decoded)
+        {
+            decodedFields.push_back(fieldLayouts.size() - 1);
+            hasVarSizedFields = hasVarSizedFields or varSized;
+        }
+        sizeOfTuple += field.dataType.getSizeInBytesWithNull();
+    }
+}
+
+void ParquetSource::open(std::shared_ptr<AbstractBufferProvider>)
+{
+    reader.emplace(filePath, schema, predicates);
+    nextRowGroup = sourceIndex;
+    decodeNextRowGroup();
+    NES_DEBUG(
+        "ParquetSource: reading the row groups r % {} == {} of the {} row groups of {}",
+        parallelism,
+        sourceIndex,
+        reader->getNumberOfRowGroups(),
+        filePath);
+}
+
+void ParquetSource::decodeNextRowGroup()
+{
+    for (; nextRowGroup < reader->getNumberOfRowGroups(); nextRowGroup += parallelism)
+    {
+        if (reader->mayMatch(nextRowGroup))
+        {
+            nextDecodedRowGroup
+                = std::async(std::launch::async, [this, rowGroup = nextRowGroup] { return reader->readRowGroup(rowGroup, decodedFields); });
+            nextRowGroup += parallelism;
+            return;
+        }
+        ++skippedRowGroups;
+    }
+}
+
+bool ParquetSource::advanceToRowsOfNextRowGroup()
+{
+    while (nextRow == numberOfRowsOfCurrentRowGroup)
+    {
+        if (not nextDecodedRowGroup.valid())
+        {
+            return false;
+        }
+        /// Rethrows the errors of decoding the row group
+        currentRowGroup = nextDecodedRowGroup.get();
+        numberOfRowsOfCurrentRowGroup = currentRowGroup[decodedFields.front()].isNull.size();
+        nextRow = 0;
+        ++readRowGroups;
+        decodeNextRowGroup();
+    }
+    return true;
+}
+
+size_t ParquetSource::FramePlan::getSizeOfFrame(const size_t sizeOfTuple) const
+{
+    const auto sizeOfChildBuffer = numberOfChildBufferBytes > 0 ? sizeof(uint64_t) + numberOfChildBufferBytes : 0;
+    return sizeof(NativeFrameHeader) + (numberOfRows * sizeOfTuple) + sizeOfChildBuffer;
+}
+
+ParquetSource::FramePlan ParquetSource::planFrame(const size_t bufferSize) const
+{
+    const auto remainingRows = numberOfRowsOfCurrentRowGroup - nextRow;
+    if (not hasVarSizedFields)
+    {
+        const auto rowsThatFit = bufferSize > sizeof(NativeFrameHeader) ? (bufferSize - sizeof(NativeFrameHeader)) / sizeOfTuple : 0;
+        return {.numberOfRows = std::clamp<uint64_t>(rowsThatFit, 1, remainingRows), .numberOfChildBufferBytes = 0};
+    }
+
+    FramePlan plan{.numberOfRows = 0, .numberOfChildBufferBytes = 0};
+    auto sizeOfFrame = sizeof(NativeFrameHeader) + sizeof(uint64_t);
+    for (; plan.numberOfRows < remainingRows; ++plan.numberOfRows)
+    {
+        const auto row = nextRow + plan.numberOfRows;
+        size_t childBufferBytesOfRow = 0;
+        for (size_t field = 0; field < fieldLayouts.size(); ++field)
+        {
+            if (fieldLayouts[field].varSized and fieldLayouts[field].decoded)
+            {
+                const auto& offsets = currentRowGroup[field].varSizedOffsets;
+                const auto sizeOfValue = offsets[row + 1] - offsets[row];
+                childBufferBytesOfRow += sizeOfValue > VariableSizedAccess::INLINE_SIZE ? sizeOfValue : 0;
+            }
+        }
+        if (plan.numberOfRows > 0 and sizeOfFrame + sizeOfTuple + childBufferBytesOfRow > bufferSize)
+        {
+            break;
+        }
+        sizeOfFrame += sizeOfTuple + childBufferBytesOfRow;
+        plan.numberOfChildBufferBytes += childBufferBytesOfRow;
+    }
+    return plan;
+}
+
+void ParquetSource::writeFrame(const std::span<std::byte> frame, const FramePlan& plan)
+{
+    const NativeFrameHeader header{
+        .magic = NativeFrameHeader::MAGIC,
+        .sizeOfTuple = static_cast<uint32_t>(sizeOfTuple),
+        .numberOfTuples = plan.numberOfRows,
+        .numberOfChildBuffers = plan.numberOfChildBufferBytes > 0 ? 1U : 0U};
+    std::memcpy(frame.data(), &header, sizeof(NativeFrameHeader));
+    const auto tuples = frame.subspan(sizeof(NativeFrameHeader), plan.numberOfRows * sizeOfTuple);
+    std::span<std::byte> childBuffer;
+    if (plan.numberOfChildBufferBytes > 0)
+    {
+        const uint64_t sizeOfChildBuffer = plan.numberOfChildBufferBytes;
+        std::memcpy(frame.data() + sizeof(NativeFrameHeader) + tuples.size(), &sizeOfChildBuffer, sizeof(uint64_t));
+        childBuffer = frame.subspan(sizeof(NativeFrameHeader) + tuples.size() + sizeof(uint64_t), sizeOfChildBuffer);
+    }
+
+    size_t offsetInChildBuffer = 0;
+    for (uint64_t tuple = 0; tuple < plan.numberOfRows; ++tuple)
+    {
+        const auto row = nextRow + tuple;
+        auto* const tupleStart = tuples.data() + (tuple * sizeOfTuple);
+        for (size_t field = 0; field < fieldLayouts.size(); ++field)
+        {
+            const auto& [offset, size, nullable, varSized, decoded] = fieldLayouts[field];
+            const auto& values = currentRowGroup[field];
+            auto* value = tupleStart + offset;
+            if (not decoded)
+            {
+                std::memset(value, 0, size + (nullable ? 1 : 0));
+                continue;
+            }
+            if (nullable)
+            {
+                *value = static_cast<std::byte>(values.isNull[row]);
+                ++value;
+            }
+            if (not varSized)
+            {
+                std::memcpy(value, values.fixedSizeValues.data() + (row * size), size);
+                continue;
+            }
+            const auto bytes = std::as_bytes(std::span(values.varSizedBytes))
+                                   .subspan(values.varSizedOffsets[row], values.varSizedOffsets[row + 1] - values.varSizedOffsets[row]);
+            if (bytes.size() <= VariableSizedAccess::INLINE_SIZE)
+            {
+                const VariableSizedAccess access(bytes);
+                std::memcpy(value, &access, sizeof(VariableSizedAccess));
+                continue;
+            }
+            const VariableSizedAccess access(VariableSizedAccess::Index(0), VariableSizedAccess::Offset(offsetInChildBuffer), bytes);
+            std::memcpy(value, &access, sizeof(VariableSizedAccess));
+            std::ranges::copy(bytes, childBuffer.begin() + static_cast<std::ptrdiff_t>(offsetInChildBuffer));
+            offsetInChildBuffer += bytes.size();
+        }
+    }
+    nextRow += plan.numberOfRows;
+}
+
+Source::FillTupleBufferResult ParquetSource::fillTupleBuffer(TupleBuffer& tupleBuffer, const std::stop_token& stopToken)
+{
+    const auto buffer = tupleBuffer.getAvailableMemoryArea().first(tupleBuffer.getBufferSize());
+    if (handedOnBytesOfPendingFrame == pendingFrame.size())
+    {
+        if (stopToken.stop_requested() or not advanceToRowsOfNextRowGroup())
+        {
+            return FillTupleBufferResult::eos();
+        }
+        const auto plan = planFrame(buffer.size());
+        const auto sizeOfFrame = plan.getSizeOfFrame(sizeOfTuple);
+        if (sizeOfFrame <= buffer.size())
+        {
+            writeFrame(buffer.first(sizeOfFrame), plan);
+            return FillTupleBufferResult::withBytes(sizeOfFrame);
+        }
+        /// The input formatter reassembles frames that span buffers
+        pendingFrame.resize(sizeOfFrame);
+        handedOnBytesOfPendingFrame = 0;
+        writeFrame(pendingFrame, plan);
+    }
+    const auto bytesToHandOn = std::min(pendingFrame.size() - handedOnBytesOfPendingFrame, buffer.size());
+    std::memcpy(buffer.data(), pendingFrame.data() + handedOnBytesOfPendingFrame, bytesToHandOn);
+    handedOnBytesOfPendingFrame += bytesToHandOn;
+    return FillTupleBufferResult::withBytes(bytesToHandOn);
+}
+
+void ParquetSource::close()
+{
+    /// Waits for the decoding of the next row group, which must not outlive the reader
+    nextDecodedRowGroup = {};
+    reader.reset();
+    currentRowGroup.clear();
+    NES_INFO("ParquetSource: read {} and skipped {} row groups of {}", readRowGroups, skippedRowGroups, filePath);
+}
+
+DescriptorConfig::Config ParquetSource::validateAndFormat(std::unordered_map<std::string, std::string> config)
+{
+    return DescriptorConfig::validateAndFormat<ConfigParametersParquet>(std::move(config), name());
+}
+
+std::ostream& ParquetSource::toString(std::ostream& str) const
+{
+    str << "\nParquetSource(";
+    str << "\n  filePath: " << filePath;
+    str << "\n  predicates: " << predicates.size();
+    str << "\n  decodedFields: " << decodedFields.size() << " of " << fieldLayouts.size();
+    str << "\n  parallelism: " << parallelism;
+    str << "\n  sourceIndex: " << sourceIndex;
+    str << "\n  readRowGroups: " << readRowGroups;
+    str << "\n  skippedRowGroups: " << skippedRowGroups;
+    str << ")\n";
+    return str;
+}
+
+SourceValidationRegistryReturnType RegisterParquetSourceValidation(SourceValidationRegistryArguments sourceConfig)
+{
+    return ParquetSource::validateAndFormat(std::move(sourceConfig.config));
+}
+
+SourceRegistryReturnType SourceGeneratedRegistrar::RegisterParquetSource(SourceRegistryArguments sourceRegistryArguments)
+{
+    return std::make_unique<ParquetSource>(sourceRegistryArguments.sourceDescriptor, sourceRegistryArguments.projections);
+}
+
+/// Parquet files are binary, thus the source reads the attached file itself instead of an inline or streamed copy of its lines
+FileDataRegistryReturnType FileDataGeneratedRegistrar::RegisterParquetFileData(FileDataRegistryArguments systestAdaptorArguments)
+{
+    if (systestAdaptorArguments.physicalSourceConfig.sourceConfig.contains(ConfigParametersParquet::FILE_PATH.name))
+    {
+        throw InvalidConfigParameter("The Parquet file data source cannot be used if the file_path parameter is already set.");
+    }
+    systestAdaptorArguments.physicalSourceConfig.sourceConfig.emplace(
+        ConfigParametersParquet::FILE_PATH.name, systestAdaptorArguments.testFilePath.string());
+    return systestAdaptorArguments.physicalSourceConfig;
+}
+
+}
@@ -0,0 +1,180 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <Configurations/Descriptor.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sources/Source.hpp>
+#include <Sources/SourceDescriptor.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <ParquetReader.hpp>
+
+namespace NES
+{
+
+struct ConfigParametersParquet
+{
+    static inline const DescriptorConfig::ConfigParameter<std::string> FILE_PATH{
+        "file_path",
+        std::nullopt,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(FILE_PATH, config); }};
+    /// Comma separated conjunction of comparisons of numeric fields with constants, e.g., 'price>=100,price<200'. The source skips the
+    /// row groups whose min/max statistics show that none of their rows satisfies the comparisons.
+    static inline const DescriptorConfig::ConfigParameter<std::string> PREDICATES{
+        "parquet_predicates",
+        "",
+        [](const std::unordered_map<std::string, std::string>& config) -> std::optional<std::string>
+        {
+            auto predicates = DescriptorConfig::tryGet(PREDICATES, config);
+            if (predicates.has_value() and not ParquetPredicate::parse(*predicates).has_value())
+            {
+                NES_ERROR("ParquetSource: parquet_predicates must be comparisons separated by commas, but is: {}", *predicates);
+                return std::nullopt;
+            }
+            return predicates;
+        }};
+    /// The number of sources that read the file together. A source reads every row group whose index modulo the parallelism equals the
+    /// index of the source, so that the sources decode the row groups of the file in parallel.
+    static inline const DescriptorConfig::ConfigParameter<uint32_t> PARALLELISM{
+        "parquet_parallelism",
+        1,
+        [](const std::unordered_map<std::string, std::string>& config) -> std::optional<uint32_t>
+        {
+            auto parallelism = DescriptorConfig::tryGet(PARALLELISM, config);
+            if (parallelism.has_value() and *parallelism == 0)
+            {
+                NES_ERROR("ParquetSource: parquet_parallelism must be at least 1");
+                return std::nullopt;
+            }
+            return parallelism;
+        }};
+    static inline const DescriptorConfig::ConfigParameter<uint32_t> SOURCE_INDEX{
+        "parquet_source_index",
+        0,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(SOURCE_INDEX, config); }};
+
+    static inline std::unordered_map<std::string, DescriptorConfig::ConfigParameterContainer> parameterMap
+        = DescriptorConfig::createConfigParameterContainerMap(
+            SourceDescriptor::parameterMap, FILE_PATH, PREDICATES, PARALLELISM, SOURCE_INDEX);
+};
+
+/// Reads the row groups of a Parquet file (see ParquetFileReader) and hands on their rows as native frames (see NativeFrameHeader),
+/// which the NATIVE input formatter reads without parsing. The source only decodes the column chunks of the fields that its successors
+/// read (see SourceRegistryArguments::projections) and skips row groups via their statistics. The frames keep the row layout of the
+/// schema, in which the source zeroes the fields that it does not decode. While the source hands on the rows of a row group, it decodes
+/// the next row group in the background.
+class ParquetSource : public Source
+{
+public:
+    static const std::string& name()
+    {
+        static const std::string Instance = "Parquet";
+        return Instance;
+    }
+
+    /// The source decodes the given fields only, or all fields of the schema if the projections are empty
+    ParquetSource(const SourceDescriptor& sourceDescriptor, const std::vector<std::string>& projections);
+    ~ParquetSource() override = default;
+
+    ParquetSource(const ParquetSource&) = delete;
+    ParquetSource& operator=(const ParquetSource&) = delete;
+    ParquetSource(ParquetSource&&) = delete;
+    ParquetSource& operator=(ParquetSource&&) = delete;
+
+    /// Fills the buffer with one frame. A frame that does not fit the buffer, e.g., because of its VARSIZED values, spans buffers.
+    FillTupleBufferResult fillTupleBuffer(TupleBuffer& tupleBuffer, const std::stop_token& stopToken) override;
+
+    /// Reads the footer of the file and starts decoding the first row group of the source
+    void open(std::shared_ptr<AbstractBufferProvider> bufferProvider) override;
+    void close() override;
+
+    static DescriptorConfig::Config validateAndFormat(std::unordered_map<std::string, std::string> config);
+
+    [[nodiscard]] std::ostream& toString(std::ostream& str) const override;
+
+private:
+    static constexpr std::string_view NATIVE_PARSER_TYPE = "NATIVE";
+
+    /// The position of a field in the row layout of the schema
+    struct FieldLayout
+    {
+        size_t offset;
+        size_t size;
+        bool nullable;
+        bool varSized;
+        /// False, if no successor reads the field, thus the source does not decode it
+        bool decoded;
+    };
+
+    /// Starts decoding the next row group of the source that may contain matching rows, if any
+    void decodeNextRowGroup();
+    /// Returns false, if the source handed on all rows of its row groups
+    bool advanceToRowsOfNextRowGroup();
+    struct FramePlan
+    {
+        uint64_t numberOfRows;
+        /// The bytes of the VARSIZED values that are not inlined, which the frame stores in its only child buffer
+        size_t numberOfChildBufferBytes;
+
+        [[nodiscard]] size_t getSizeOfFrame(size_t sizeOfTuple) const;
+    };
+
+    /// Plans a frame with as many of the remaining rows of the current row group as fit the buffer, but at least one row
+    [[nodiscard]] FramePlan planFrame(size_t bufferSize) const;
+    /// Writes the next rows of the current row group as a frame
+    void writeFrame(std::span<std::byte> frame, const FramePlan& plan);
+
+    std::string filePath;
+    std::vector<ParquetPredicate> predicates;
+    uint32_t parallelism;
+    uint32_t sourceIndex;
+    Schema schema;
+    std::vector<FieldLayout> fieldLayouts;
+    /// The indexes of the fields that the source decodes
+    std::vector<size_t> decodedFields;
+    bool hasVarSizedFields = false;
+    size_t sizeOfTuple = 0;
+
+    std::optional<ParquetFileReader> reader;
+    size_t nextRowGroup = 0;
+    /// Decodes the next row group via the reader, thus it is declared after the reader, so that it is destroyed before the reader
+    std::future<std::vector<ParquetColumnValues>> nextDecodedRowGroup;
+
+    std::vector<ParquetColumnValues> currentRowGroup;
+    uint64_t numberOfRowsOfCurrentRowGroup = 0;
+    uint64_t nextRow = 0;
+    /// A frame that exceeds the buffer size, of which the source handed on the first 'handedOnBytesOfPendingFrame' bytes
+    std::vector<std::byte> pendingFrame;
+    size_t handedOnBytesOfPendingFrame = 0;
+
+    uint64_t readRowGroups = 0;
+    uint64_t skippedRowGroups = 0;
+};
+
+}
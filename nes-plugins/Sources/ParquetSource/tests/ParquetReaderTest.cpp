@@ -0,0 +1,248 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+#include <ErrorHandling.hpp>
+#include <ParquetReader.hpp>
+
+namespace NES
+{
+
+/// The files of the tests are generated by testdata/GenerateParquetTestData.py, which documents the encodings of every file
+class ParquetReaderTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("ParquetReaderTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup ParquetReaderTest class.");
+    }
+
+    static std::string getTestFile(const std::string_view name) { return std::filesystem::path(PARQUET_TEST_DATA) / name; }
+
+    /// Returns the values of a column of a fixed size data type, where nullopt denotes a null
+    template <typename T>
+    static std::vector<std::optional<T>> getValues(const ParquetColumnValues& values)
+    {
+        EXPECT_EQ(values.fixedSizeValues.size(), values.isNull.size() * sizeof(T));
+        std::vector<std::optional<T>> result;
+        for (size_t row = 0; row < values.isNull.size(); ++row)
+        {
+            T value;
+            std::memcpy(&value, values.fixedSizeValues.data() + (row * sizeof(T)), sizeof(T));
+            result.push_back(values.isNull[row] != 0 ? std::nullopt : std::optional{value});
+        }
+        return result;
+    }
+
+    /// Returns the values of a column of a VARSIZED data type, where nullopt denotes a null
+    static std::vector<std::optional<std::string>> getVarSizedValues(const ParquetColumnValues& values)
+    {
+        EXPECT_EQ(values.varSizedOffsets.size(), values.isNull.size() + 1);
+        std::vector<std::optional<std::string>> result;
+        for (size_t row = 0; row < values.isNull.size(); ++row)
+        {
+            const auto begin = values.varSizedOffsets[row];
+            const auto value = values.varSizedBytes.substr(begin, values.varSizedOffsets[row + 1] - begin);
+            result.push_back(values.isNull[row] != 0 ? std::nullopt : std::optional{value});
+        }
+        return result;
+    }
+};
+
+/// The definition levels of the price consist of a bit-packed and an RLE run in the first and of two RLE runs in the second row group
+TEST_F(ParquetReaderTest, ReadsPlainEncodedPages)
+{
+    const auto schema = Schema{}
+                            .addField("orders$id", DataType::Type::INT64)
+                            .addField("orders$price", DataType::Type::FLOAT64, DataType::NULLABLE::IS_NULLABLE)
+                            .addField("orders$name", DataType::Type::VARSIZED)
+                            .addField("orders$quantity", DataType::Type::UINT32);
+    const ParquetFileReader reader(getTestFile("plain.parquet"), schema, {});
+    ASSERT_EQ(reader.getNumberOfRowGroups(), 2);
+
+    const auto firstRowGroup = reader.readRowGroup(0);
+    ASSERT_EQ(firstRowGroup.size(), 4);
+    EXPECT_EQ(getValues<int64_t>(firstRowGroup[0]), (std::vector<std::optional<int64_t>>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    EXPECT_EQ(
+        getValues<double>(firstRowGroup[1]),
+        (std::vector<std::optional<double>>{0.0, 1.5, std::nullopt, std::nullopt, std::nullopt, 7.5, 9.0, 10.5, 12.0, 13.5}));
+    EXPECT_EQ(
+        getVarSizedValues(firstRowGroup[2]),
+        (std::vector<std::optional<std::string>>{
+            "name0", "name1", "name2", "name3", "name4", "name5", "name6", "name7", "name8", "name9"}));
+    /// The quantities exceed the range of the INT32 that stores them, as the column is annotated as UINT_32
+    EXPECT_EQ(getValues<uint32_t>(firstRowGroup[3])[0], 4000000000U);
+    EXPECT_EQ(getValues<uint32_t>(firstRowGroup[3])[9], 3999999991U);
+
+    const auto secondRowGroup = reader.readRowGroup(1);
+    EXPECT_EQ(getValues<int64_t>(secondRowGroup[0]).front(), 10);
+    EXPECT_EQ(
+        getValues<double>(secondRowGroup[1]),
+        (std::vector<std::optional<double>>{15.0, 16.5, 18.0, 19.5, 21.0, 22.5, 24.0, 25.5, 27.0, std::nullopt}));
+    EXPECT_EQ(getVarSizedValues(secondRowGroup[2]).back(), "name19");
+}
+
+TEST_F(ParquetReaderTest, ReadsOnlyTheColumnsOfTheSchemaInTheOrderOfTheSchema)
+{
+    const auto schema = Schema{}.addField("quantity", DataType::Type::UINT64).addField("id", DataType::Type::INT16);
+    const ParquetFileReader reader(getTestFile("plain.parquet"), schema, {});
+    const auto rowGroup = reader.readRowGroup(1);
+    ASSERT_EQ(rowGroup.size(), 2);
+    /// The values are converted to the data types of the fields
+    EXPECT_EQ(getValues<uint64_t>(rowGroup[0]).front(), 3999999990U);
+    EXPECT_EQ(getValues<int16_t>(rowGroup[1]), (std::vector<std::optional<int16_t>>{10, 11, 12, 13, 14, 15, 16, 17, 18, 19}));
+}
+
+TEST_F(ParquetReaderTest, DecodesOnlyTheGivenFields)
+{
+    const auto schema = Schema{}
+                            .addField("id", DataType::Type::INT64)
+                            .addField("price", DataType::Type::FLOAT64, DataType::NULLABLE::IS_NULLABLE)
+                            .addField("name", DataType::Type::VARSIZED);
+    /// The predicate on the id only reads the statistics of its column chunks, which do not require decoding them
+    const ParquetFileReader reader(getTestFile("plain.parquet"), schema, ParquetPredicate::parse("id>=10").value());
+    EXPECT_FALSE(reader.mayMatch(0));
+    const std::vector<size_t> fields{2};
+    const auto rowGroup = reader.readRowGroup(0, fields);
+    ASSERT_EQ(rowGroup.size(), 3);
+    EXPECT_TRUE(rowGroup[0].isNull.empty());
+    EXPECT_TRUE(rowGroup[1].isNull.empty());
+    EXPECT_EQ(getVarSizedValues(rowGroup[2]).front(), "name0");
+    EXPECT_EQ(getVarSizedValues(rowGroup[2]).back(), "name9");
+}
+
+TEST_F(ParquetReaderTest, SkipsRowGroupsViaStatistics)
+{
+    const auto schema = Schema{}
+                            .addField("id", DataType::Type::INT64)
+                            .addField("price", DataType::Type::FLOAT64, DataType::NULLABLE::IS_NULLABLE);
+    const auto mayMatch = [&](const std::string_view predicates)
+    {
+        const ParquetFileReader reader(getTestFile("plain.parquet"), schema, ParquetPredicate::parse(predicates).value());
+        return std::vector{reader.mayMatch(0), reader.mayMatch(1)};
+    };
+    /// The first row group contains the ids 0 to 9 and the second the ids 10 to 19
+    EXPECT_EQ(mayMatch("id>=10"), (std::vector{false, true}));
+    EXPECT_EQ(mayMatch("id<10"), (std::vector{true, false}));
+    EXPECT_EQ(mayMatch("id=9"), (std::vector{true, false}));
+    EXPECT_EQ(mayMatch("id>5,id<15"), (std::vector{true, true}));
+    EXPECT_EQ(mayMatch("id>19"), (std::vector{false, false}));
+    /// The price has a null count, but no min/max statistics
+    EXPECT_EQ(mayMatch("price>1000"), (std::vector{true, true}));
+    ASSERT_EXCEPTION_ERRORCODE(static_cast<void>(mayMatch("unknown>1")), ErrorCode::InvalidConfigParameter);
+}
+
+/// The metadata contains every type of the Thrift compact protocol in fields that the reader does not know, which it must skip
+TEST_F(ParquetReaderTest, SkipsUnknownFieldsOfTheThriftCompactProtocol)
+{
+    const ParquetFileReader reader(getTestFile("thrift_compact.parquet"), Schema{}.addField("x", DataType::Type::INT32), {});
+    ASSERT_EQ(reader.getNumberOfRowGroups(), 1);
+    EXPECT_EQ(getValues<int32_t>(reader.readRowGroup(0)[0]), (std::vector<std::optional<int32_t>>{7, 8, 9}));
+}
+
+/// The dictionary indices of the cities consist of RLE and bit-packed runs with a bit width of 2
+TEST_F(ParquetReaderTest, ReadsDictionaryEncodedPages)
+{
+    const auto schema = Schema{}
+                            .addField("city", DataType::Type::VARSIZED, DataType::NULLABLE::IS_NULLABLE)
+                            .addField("code", DataType::Type::INT64);
+    const ParquetFileReader reader(getTestFile("dictionary.parquet"), schema, {});
+    const auto rowGroup = reader.readRowGroup(0);
+    EXPECT_EQ(
+        getVarSizedValues(rowGroup[0]),
+        (std::vector<std::optional<std::string>>{
+            "Berlin", "Berlin", "Berlin", std::nullopt, "Paris", "Rome", "Rome", "Rome", std::nullopt, std::nullopt, "Berlin", "Paris"}));
+    EXPECT_EQ(
+        getValues<int64_t>(rowGroup[1]), (std::vector<std::optional<int64_t>>{100, 200, 100, 200, 100, 200, 100, 200, 100, 200, 100, 200}));
+}
+
+/// The values are stored in a data page of version 1, which compresses its definition levels, and in a data page of version 2, which
+/// does not compress its definition levels
+TEST_F(ParquetReaderTest, ReadsZstdCompressedPages)
+{
+    const auto schema = Schema{}
+                            .addField("value", DataType::Type::INT32, DataType::NULLABLE::IS_NULLABLE)
+                            .addField("label", DataType::Type::VARSIZED);
+    const ParquetFileReader reader(getTestFile("zstd.parquet"), schema, {});
+    const auto rowGroup = reader.readRowGroup(0);
+    EXPECT_EQ(getValues<int32_t>(rowGroup[0]), (std::vector<std::optional<int32_t>>{1, std::nullopt, 3, 4, 5, 6, std::nullopt, 8}));
+    EXPECT_EQ(getVarSizedValues(rowGroup[1]), (std::vector<std::optional<std::string>>{"a", "bb", "bb", "a", "a", "a", "bb", "bb"}));
+}
+
+TEST_F(ParquetReaderTest, RejectsFilesThatAreNotParquetFiles)
+{
+    const auto schema = Schema{}.addField("id", DataType::Type::INT64);
+    for (const auto* const file : {"does_not_exist.parquet", "not_parquet.parquet", "truncated.parquet", "footer_exceeds_file.parquet"})
+    {
+        SCOPED_TRACE(file);
+        ASSERT_EXCEPTION_ERRORCODE(ParquetFileReader(getTestFile(file), schema, {}), ErrorCode::CannotOpenSource);
+    }
+}
+
+TEST_F(ParquetReaderTest, RejectsMalformedMetadata)
+{
+    ASSERT_EXCEPTION_ERRORCODE(
+        ParquetFileReader(getTestFile("truncated_metadata.parquet"), Schema{}.addField("id", DataType::Type::INT64), {}),
+        ErrorCode::CannotFormatSourceData);
+}
+
+TEST_F(ParquetReaderTest, RejectsColumnsThatDoNotMatchTheSchema)
+{
+    const auto file = getTestFile("plain.parquet");
+    /// The file does not contain the field
+    ASSERT_EXCEPTION_ERRORCODE(
+        ParquetFileReader(file, Schema{}.addField("unknown", DataType::Type::INT64), {}), ErrorCode::CannotOpenSource);
+    /// The BYTE_ARRAY column cannot be read as a number
+    ASSERT_EXCEPTION_ERRORCODE(ParquetFileReader(file, Schema{}.addField("name", DataType::Type::INT64), {}), ErrorCode::CannotOpenSource);
+    /// The price contains nulls, which a field that is not nullable cannot represent
+    const ParquetFileReader reader(file, Schema{}.addField("price", DataType::Type::FLOAT64), {});
+    ASSERT_EXCEPTION_ERRORCODE(static_cast<void>(reader.readRowGroup(0)), ErrorCode::CannotFormatSourceData);
+}
+
+TEST_F(ParquetReaderTest, RejectsMalformedPages)
+{
+    const auto readFirstRowGroup = [](const std::string_view file, const Schema& schema)
+    { return ParquetFileReader(getTestFile(file), schema, {}).readRowGroup(0); };
+    /// The page header claims more bytes than the column chunk has
+    ASSERT_EXCEPTION_ERRORCODE(
+        static_cast<void>(readFirstRowGroup("page_exceeds_column_chunk.parquet", Schema{}.addField("id", DataType::Type::INT64))),
+        ErrorCode::CannotFormatSourceData);
+    /// A dictionary index exceeds the dictionary
+    ASSERT_EXCEPTION_ERRORCODE(
+        static_cast<void>(readFirstRowGroup(
+            "dictionary_index_out_of_range.parquet", Schema{}.addField("city", DataType::Type::VARSIZED, DataType::NULLABLE::IS_NULLABLE))),
+        ErrorCode::CannotFormatSourceData);
+    /// The compressed page is not a valid zstd frame
+    ASSERT_EXCEPTION_ERRORCODE(
+        static_cast<void>(readFirstRowGroup(
+            "corrupt_zstd.parquet", Schema{}.addField("value", DataType::Type::INT32, DataType::NULLABLE::IS_NULLABLE))),
+        ErrorCode::CannotFormatSourceData);
+}
+
+}
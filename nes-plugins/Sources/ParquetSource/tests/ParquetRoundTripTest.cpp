@@ -0,0 +1,360 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Runtime/BufferManager.hpp>
+#include <Runtime/ColumnarLayout.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Runtime/VariableSizedAccess.hpp>
+#include <Sinks/FrameCompressor.hpp>
+#include <Sinks/ParquetWriter.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+#include <ErrorHandling.hpp>
+#include <ParquetReader.hpp>
+
+namespace NES
+{
+
+/// Writes tuple buffers with the ParquetFileWriter of the Parquet sink and reads the file with the ParquetFileReader of the Parquet source
+class ParquetRoundTripTest : public Testing::BaseUnitTest
+{
+public:
+    static constexpr uint64_t BUFFER_SIZE = 4096;
+    static constexpr uint64_t ROWS_PER_BUFFER = 50;
+    static constexpr uint64_t BUFFERS_PER_ROW_GROUP = 2;
+    static constexpr uint64_t NUMBER_OF_ROW_GROUPS = 2;
+    static constexpr uint64_t ROWS_PER_ROW_GROUP = ROWS_PER_BUFFER * BUFFERS_PER_ROW_GROUP;
+
+    /// Returns the value of the field of the row in the representation of its data type (VARSIZED values as their bytes),
+    /// or nullopt for null
+    using ValueGenerator = std::function<std::optional<std::string>(size_t field, uint64_t row)>;
+
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("ParquetRoundTripTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup ParquetRoundTripTest class.");
+    }
+
+    void SetUp() override
+    {
+        Testing::BaseUnitTest::SetUp();
+        bufferManager = BufferManager::create(BUFFER_SIZE, 256);
+        directory = std::filesystem::temp_directory_path()
+            / (std::string("ParquetRoundTripTest-") + ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(directory);
+        Testing::BaseUnitTest::TearDown();
+    }
+
+    template <typename T>
+    static std::string toBytes(const T value)
+    {
+        std::string bytes(sizeof(T), '\0');
+        std::memcpy(bytes.data(), &value, sizeof(T));
+        return bytes;
+    }
+
+    /// Writes the rows [firstRow, firstRow + ROWS_PER_BUFFER) into a buffer of the row or the columnar layout of the schema
+    TupleBuffer createBuffer(const Schema& schema, const bool isColumnar, const uint64_t firstRow, const ValueGenerator& getValue) const
+    {
+        auto buffer = bufferManager->getBufferBlocking();
+        const auto memory = buffer.getAvailableMemoryArea();
+        std::ranges::fill(memory, std::byte{0});
+        const auto columnarLayout = isColumnar ? std::optional{ColumnarLayout::create(schema, buffer.getBufferSize())} : std::nullopt;
+        EXPECT_TRUE(not isColumnar or columnarLayout->capacity >= ROWS_PER_BUFFER);
+        EXPECT_LE(schema.getSizeOfSchemaInBytes() * ROWS_PER_BUFFER, buffer.getBufferSize());
+
+        uint64_t offsetInTuple = 0;
+        for (size_t field = 0; field < schema.getNumberOfFields(); ++field)
+        {
+            const auto& dataType = schema.getFieldAt(field).dataType;
+            for (uint64_t tuple = 0; tuple < ROWS_PER_BUFFER; ++tuple)
+            {
+                const auto value = getValue(field, firstRow + tuple);
+                std::byte* valueMemory = nullptr;
+                if (isColumnar)
+                {
+                    const auto& column = columnarLayout->columns[field];
+                    valueMemory = memory.data() + column.valueOffset + (tuple * column.valueSize);
+                    if (column.validityOffset.has_value() and value.has_value())
+                    {
+                        auto* const word = memory.data() + *column.validityOffset + ((tuple / ColumnarLayout::BITS_PER_VALIDITY_WORD) * 8);
+                        uint64_t bits = 0;
+                        std::memcpy(&bits, word, sizeof(bits));
+                        bits |= uint64_t{1} << (tuple % ColumnarLayout::BITS_PER_VALIDITY_WORD);
+                        std::memcpy(word, &bits, sizeof(bits));
+                    }
+                }
+                else
+                {
+                    /// The null byte precedes the value of a nullable field
+                    valueMemory = memory.data() + (tuple * schema.getSizeOfSchemaInBytes()) + offsetInTuple;
+                    if (dataType.nullable)
+                    {
+                        valueMemory[0] = std::byte{value.has_value() ? uint8_t{0} : uint8_t{1}};
+                        ++valueMemory;
+                    }
+                }
+                if (value.has_value())
+                {
+                    writeValue(buffer, dataType, *value, valueMemory);
+                }
+            }
+            offsetInTuple += dataType.getSizeInBytesWithNull();
+        }
+        buffer.setNumberOfTuples(ROWS_PER_BUFFER);
+        return buffer;
+    }
+
+    /// Writes NUMBER_OF_ROW_GROUPS row groups, each of BUFFERS_PER_ROW_GROUP buffers, and returns the path of the file
+    std::filesystem::path
+    writeFile(const Schema& schema, const bool isColumnar, const SinkCompression compression, const ValueGenerator& getValue) const
+    {
+        const auto filePath = directory / "roundtrip.parquet";
+        ParquetFileWriter writer(filePath.string(), schema, compression);
+        const FrameCompressor compressor(compression, 0);
+        for (uint64_t rowGroup = 0; rowGroup < NUMBER_OF_ROW_GROUPS; ++rowGroup)
+        {
+            ParquetRowGroup encodedRows(schema, isColumnar);
+            for (uint64_t buffer = 0; buffer < BUFFERS_PER_ROW_GROUP; ++buffer)
+            {
+                const auto firstRow = (rowGroup * ROWS_PER_ROW_GROUP) + (buffer * ROWS_PER_BUFFER);
+                encodedRows.append(createBuffer(schema, isColumnar, firstRow, getValue));
+            }
+            writer.write(encodedRows.encode(compressor));
+        }
+        writer.close();
+        return filePath;
+    }
+
+    /// Returns the values that the reader decoded for the rows of a column in the same representation as the ValueGenerator
+    static std::vector<std::optional<std::string>> getValues(const DataType& dataType, const ParquetColumnValues& values)
+    {
+        std::vector<std::optional<std::string>> result;
+        for (size_t row = 0; row < values.isNull.size(); ++row)
+        {
+            if (values.isNull[row] != 0)
+            {
+                result.emplace_back(std::nullopt);
+            }
+            else if (dataType.type == DataType::Type::VARSIZED)
+            {
+                const auto begin = values.varSizedOffsets[row];
+                result.emplace_back(values.varSizedBytes.substr(begin, values.varSizedOffsets[row + 1] - begin));
+            }
+            else
+            {
+                const auto size = dataType.getSizeInBytesWithoutNull();
+                const auto* const value = reinterpret_cast<const char*>(values.fixedSizeValues.data() + (row * size));
+                result.emplace_back(std::string(value, size));
+            }
+        }
+        return result;
+    }
+
+    std::shared_ptr<BufferManager> bufferManager;
+    std::filesystem::path directory;
+
+private:
+    /// VARSIZED values of more than INLINE_SIZE bytes are stored in a child buffer of the buffer
+    void writeValue(TupleBuffer& buffer, const DataType& dataType, const std::string_view value, std::byte* valueMemory) const
+    {
+        if (dataType.type != DataType::Type::VARSIZED)
+        {
+            std::memcpy(valueMemory, value.data(), value.size());
+            return;
+        }
+        const auto bytes = std::as_bytes(std::span{value});
+        if (value.size() <= VariableSizedAccess::INLINE_SIZE)
+        {
+            const VariableSizedAccess access{bytes};
+            std::memcpy(valueMemory, &access, sizeof(access));
+            return;
+        }
+        auto childBuffer = bufferManager->getBufferBlocking();
+        std::ranges::copy(bytes, childBuffer.getAvailableMemoryArea().begin());
+        const auto childIndex = buffer.storeChildBuffer(childBuffer);
+        const VariableSizedAccess access{childIndex, VariableSizedAccess::Offset{0}, bytes};
+        std::memcpy(valueMemory, &access, sizeof(access));
+    }
+};
+
+/// The data type of the field, if the field is nullable, if the buffers are columnar, and the compression of the file
+class ParquetRoundTripDataTypeTest : public ParquetRoundTripTest,
+                                     public ::testing::WithParamInterface<std::tuple<DataType::Type, bool, bool, SinkCompression>>
+{
+public:
+    /// Covers the extreme values of every type, as well as nulls in every seventh row of nullable fields
+    static std::optional<std::string> getValue(const DataType& dataType, const uint64_t row)
+    {
+        if (dataType.nullable and row % 7 == 3)
+        {
+            return std::nullopt;
+        }
+        const auto value = static_cast<int64_t>(row);
+        switch (dataType.type)
+        {
+            case DataType::Type::UINT8:
+                return toBytes(static_cast<uint8_t>(255 - value));
+            case DataType::Type::UINT16:
+                return toBytes(static_cast<uint16_t>(65535 - (value * 300)));
+            case DataType::Type::UINT32:
+                return toBytes(static_cast<uint32_t>(4294967295 - (value * 1000)));
+            case DataType::Type::UINT64:
+            case DataType::Type::TIMESTAMP:
+                return toBytes(UINT64_MAX - static_cast<uint64_t>(value));
+            case DataType::Type::INT8:
+                return toBytes(static_cast<int8_t>(value - 128));
+            case DataType::Type::INT16:
+                return toBytes(static_cast<int16_t>(32767 - (value * 300)));
+            case DataType::Type::INT32:
+                return toBytes(static_cast<int32_t>(INT32_MIN + (value * 1000)));
+            case DataType::Type::INT64:
+            case DataType::Type::INTERVAL:
+            case DataType::Type::DECIMAL:
+                return toBytes(row % 2 == 0 ? INT64_MIN + value : INT64_MAX - value);
+            case DataType::Type::FLOAT32:
+                return toBytes(static_cast<float>(value) * -0.25F);
+            case DataType::Type::FLOAT64:
+                return toBytes((static_cast<double>(value) * 1.5) - 1e300);
+            case DataType::Type::BOOLEAN:
+                return toBytes(row % 3 == 0);
+            case DataType::Type::CHAR:
+                return toBytes(static_cast<char>('a' + (row % 26)));
+            case DataType::Type::VARSIZED:
+                /// Every third value is too long to be inlined
+                return row % 3 == 0 ? fmt::format("a value of row {} that is not inlined", row) : fmt::format("row {}", row);
+            case DataType::Type::UNDEFINED:
+                break;
+        }
+        INVARIANT(false, "The test does not cover fields of type {}", dataType);
+        return std::nullopt;
+    }
+};
+
+TEST_P(ParquetRoundTripDataTypeTest, ReadsTheValuesThatTheWriterWrote)
+{
+    const auto [type, isNullable, isColumnar, compression] = GetParam();
+    const auto schema
+        = Schema{}.addField("stream$value", type, isNullable ? DataType::NULLABLE::IS_NULLABLE : DataType::NULLABLE::NOT_NULLABLE);
+    const auto& dataType = schema.getFieldAt(0).dataType;
+    const auto filePath = writeFile(schema, isColumnar, compression, [&](size_t, const uint64_t row) { return getValue(dataType, row); });
+
+    const ParquetFileReader reader(filePath.string(), schema, {});
+    ASSERT_EQ(reader.getNumberOfRowGroups(), NUMBER_OF_ROW_GROUPS);
+    for (uint64_t rowGroup = 0; rowGroup < NUMBER_OF_ROW_GROUPS; ++rowGroup)
+    {
+        const auto columns = reader.readRowGroup(rowGroup);
+        ASSERT_EQ(columns.size(), 1);
+        const auto values = getValues(dataType, columns[0]);
+        ASSERT_EQ(values.size(), ROWS_PER_ROW_GROUP);
+        for (uint64_t row = 0; row < ROWS_PER_ROW_GROUP; ++row)
+        {
+            EXPECT_EQ(values[row], getValue(dataType, (rowGroup * ROWS_PER_ROW_GROUP) + row))
+                << "row " << row << " of row group " << rowGroup;
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    AllDataTypes,
+    ParquetRoundTripDataTypeTest,
+    ::testing::Combine(
+        ::testing::Values(
+            DataType::Type::UINT8,
+            DataType::Type::UINT16,
+            DataType::Type::UINT32,
+            DataType::Type::UINT64,
+            DataType::Type::INT8,
+            DataType::Type::INT16,
+            DataType::Type::INT32,
+            DataType::Type::INT64,
+            DataType::Type::FLOAT32,
+            DataType::Type::FLOAT64,
+            DataType::Type::BOOLEAN,
+            DataType::Type::CHAR,
+            DataType::Type::VARSIZED,
+            DataType::Type::TIMESTAMP,
+            DataType::Type::INTERVAL,
+            DataType::Type::DECIMAL),
+        ::testing::Bool(),
+        ::testing::Bool(),
+        ::testing::Values(SinkCompression::NONE, SinkCompression::ZSTD)));
+
+/// The statistics that the writer records let the reader skip row groups, in the order of the Parquet type of the field
+TEST_F(ParquetRoundTripTest, StatisticsSkipRowGroups)
+{
+    const auto schema = Schema{}
+                            .addField("stream$id", DataType::Type::INT64)
+                            .addField("stream$amount", DataType::Type::UINT32, DataType::NULLABLE::IS_NULLABLE)
+                            .addField("stream$price", DataType::Type::FLOAT64)
+                            .addField("stream$name", DataType::Type::VARSIZED);
+    /// The first row group contains the ids 0 to 99 and the second the ids 100 to 199. All amounts of the second row group are null.
+    const auto filePath = writeFile(
+        schema,
+        false,
+        SinkCompression::NONE,
+        [](const size_t field, const uint64_t row) -> std::optional<std::string>
+        {
+            switch (field)
+            {
+                case 0:
+                    return toBytes(static_cast<int64_t>(row));
+                case 1:
+                    return row < ROWS_PER_ROW_GROUP ? std::optional{toBytes(static_cast<uint32_t>(4000000000U + row))} : std::nullopt;
+                case 2:
+                    return toBytes(static_cast<double>(row) / 2);
+                default:
+                    return fmt::format("name {}", row);
+            }
+        });
+    const auto mayMatch = [&](const std::string_view predicates)
+    {
+        const ParquetFileReader reader(filePath.string(), schema, ParquetPredicate::parse(predicates).value());
+        return std::vector{reader.mayMatch(0), reader.mayMatch(1)};
+    };
+    EXPECT_EQ(mayMatch("id>=100"), (std::vector{false, true}));
+    EXPECT_EQ(mayMatch("id<100"), (std::vector{true, false}));
+    EXPECT_EQ(mayMatch("id=250"), (std::vector{false, false}));
+    /// The amounts exceed the range of an INT32, thus the reader must compare them as unsigned integers
+    EXPECT_EQ(mayMatch("amount>=4000000050"), (std::vector{true, false}));
+    EXPECT_EQ(mayMatch("amount<4000000000"), (std::vector{false, false}));
+    EXPECT_EQ(mayMatch("price>49.5"), (std::vector{false, true}));
+}
+
+}
@@ -0,0 +1,478 @@
+#!/usr/bin/env python3
+
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+
+#    https://www.apache.org/licenses/LICENSE-2.0
+
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+  Generates the Parquet files of the ParquetReaderTest and of the Parquet systest.
+  The files are written byte by byte, so that every file uses exactly the encodings, page versions and codecs that a test covers,
+  including malformed files that no Parquet library writes. Requires the zstd command line tool.
+  Usage: ./GenerateParquetTestData.py
+"""
+
+import os
+import struct
+import subprocess
+
+TEST_DATA_DIR = os.path.dirname(os.path.abspath(__file__))
+SYSTEST_DATA_DIR = os.path.join(TEST_DATA_DIR, "..", "..", "..", "..", "..", "nes-systests", "testdata", "small")
+
+# Thrift compact protocol types
+BOOL_TRUE, BOOL_FALSE, BYTE, I16, I32, I64, DOUBLE, BINARY, LIST, SET, MAP, STRUCT = range(1, 13)
+
+# Parquet enums
+BOOLEAN, INT32, INT64, INT96, FLOAT, PDOUBLE, BYTE_ARRAY, FIXED_LEN_BYTE_ARRAY = range(8)
+REQUIRED, OPTIONAL = 0, 1
+UTF8, UINT_32, UINT_64 = 0, 13, 14
+PLAIN, PLAIN_DICTIONARY, RLE, RLE_DICTIONARY = 0, 2, 3, 8
+UNCOMPRESSED, ZSTD = 0, 6
+DATA_PAGE, DICTIONARY_PAGE, DATA_PAGE_V2 = 0, 2, 3
+
+
+def varint(value):
+    out = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return bytes(out)
+
+
+def zigzag(value):
+    return varint((value << 1) ^ (value >> 63))
+
+
+class Struct:
+    """A Thrift struct, whose fields must be added in ascending order of their ids"""
+
+    def __init__(self):
+        self.out = bytearray()
+        self.last_id = 0
+
+    def header(self, field_id, type_):
+        delta = field_id - self.last_id
+        if 0 < delta <= 15:
+            self.out.append((delta << 4) | type_)
+        else:
+            self.out.append(type_)
+            self.out += zigzag(field_id)
+        self.last_id = field_id
+        return self
+
+    def i32(self, field_id, value):
+        self.header(field_id, I32).out += zigzag(value)
+        return self
+
+    def i64(self, field_id, value):
+        self.header(field_id, I64).out += zigzag(value)
+        return self
+
+    def i16(self, field_id, value):
+        self.header(field_id, I16).out += zigzag(value)
+        return self
+
+    def byte(self, field_id, value):
+        self.header(field_id, BYTE).out.append(value)
+        return self
+
+    def boolean(self, field_id, value):
+        return self.header(field_id, BOOL_TRUE if value else BOOL_FALSE)
+
+    def double(self, field_id, value):
+        self.header(field_id, DOUBLE).out += struct.pack("<d", value)
+        return self
+
+    def binary(self, field_id, value):
+        value = value.encode() if isinstance(value, str) else value
+        self.header(field_id, BINARY).out += varint(len(value)) + value
+        return self
+
+    def struct(self, field_id, value):
+        self.header(field_id, STRUCT).out += value.end()
+        return self
+
+    def list(self, field_id, element_type, elements, container_type=LIST):
+        self.header(field_id, container_type).out += encode_list(element_type, elements)
+        return self
+
+    def map(self, field_id, key_type, value_type, entries):
+        self.header(field_id, MAP)
+        self.out += varint(len(entries))
+        if entries:
+            self.out.append((key_type << 4) | value_type)
+            for key, value in entries:
+                self.out += encode_element(key_type, key) + encode_element(value_type, value)
+        return self
+
+    def end(self):
+        return bytes(self.out) + b"\x00"
+
+
+def encode_element(type_, value):
+    if type_ in (BOOL_TRUE, BOOL_FALSE):
+        return bytes([1 if value else 2])
+    if type_ in (I16, I32, I64):
+        return zigzag(value)
+    if type_ == BYTE:
+        return bytes([value])
+    if type_ == BINARY:
+        value = value.encode() if isinstance(value, str) else value
+        return varint(len(value)) + value
+    if type_ == STRUCT:
+        return value.end()
+    raise ValueError(type_)
+
+
+def encode_list(element_type, elements):
+    size = len(elements)
+    out = bytearray([(size << 4) | element_type] if size < 15 else [0xF0 | element_type])
+    if size >= 15:
+        out += varint(size)
+    for element in elements:
+        out += encode_element(element_type, element)
+    return bytes(out)
+
+
+def rle_run(count, value, bit_width):
+    return varint(count << 1) + value.to_bytes((bit_width + 7) // 8, "little")
+
+
+def bit_packed_run(values, bit_width):
+    """Packs the values in groups of eight values, padding the last group with zeros"""
+    values = values + [0] * (-len(values) % 8)
+    bits = 0
+    for index, value in enumerate(values):
+        bits |= value << (index * bit_width)
+    return varint(((len(values) // 8) << 1) | 1) + bits.to_bytes(len(values) * bit_width // 8, "little")
+
+
+def plain(physical_type, values):
+    if physical_type == INT32:
+        return b"".join(struct.pack("<I" if value >= 2**31 else "<i", value) for value in values)
+    if physical_type == INT64:
+        return b"".join(struct.pack("<Q" if value >= 2**63 else "<q", value) for value in values)
+    if physical_type == PDOUBLE:
+        return b"".join(struct.pack("<d", value) for value in values)
+    if physical_type == BYTE_ARRAY:
+        return b"".join(struct.pack("<I", len(value.encode())) + value.encode() for value in values)
+    raise ValueError(physical_type)
+
+
+def zstd(data):
+    return subprocess.run(["zstd", "-q", "-c", "-19"], input=data, check=True, capture_output=True).stdout
+
+
+def page_header(page_type, uncompressed_size, compressed_size, page_struct, crc=None):
+    header = Struct().i32(1, page_type).i32(2, uncompressed_size).i32(3, compressed_size)
+    if crc is not None:
+        header.i32(4, crc)
+    field_id = {DATA_PAGE: 5, DICTIONARY_PAGE: 7, DATA_PAGE_V2: 8}[page_type]
+    return header.struct(field_id, page_struct).end()
+
+
+def data_page(number_of_values, encoding, encoded_values, definition_levels=None, codec=UNCOMPRESSED, crc=None):
+    """A data page of version 1, whose body begins with the length prefixed definition levels of an optional column"""
+    body = encoded_values
+    if definition_levels is not None:
+        body = struct.pack("<I", len(definition_levels)) + definition_levels + encoded_values
+    compressed = zstd(body) if codec == ZSTD else body
+    page_struct = Struct().i32(1, number_of_values).i32(2, encoding).i32(3, RLE).i32(4, RLE)
+    return page_header(DATA_PAGE, len(body), len(compressed), page_struct, crc) + compressed
+
+
+def data_page_v2(number_of_values, number_of_nulls, encoding, encoded_values, definition_levels=b"", codec=UNCOMPRESSED):
+    """A data page of version 2, which stores its levels uncompressed and without a length prefix"""
+    compressed = zstd(encoded_values) if codec == ZSTD else encoded_values
+    page_struct = (
+        Struct()
+        .i32(1, number_of_values)
+        .i32(2, number_of_nulls)
+        .i32(3, number_of_values)
+        .i32(4, encoding)
+        .i32(5, len(definition_levels))
+        .i32(6, 0)
+        .boolean(7, codec == ZSTD)
+    )
+    page = definition_levels + compressed
+    return page_header(DATA_PAGE_V2, len(definition_levels) + len(encoded_values), len(page), page_struct) + page
+
+
+def dictionary_page(number_of_values, encoded_values, codec=UNCOMPRESSED):
+    compressed = zstd(encoded_values) if codec == ZSTD else encoded_values
+    page_struct = Struct().i32(1, number_of_values).i32(2, PLAIN).boolean(3, False)
+    return page_header(DICTIONARY_PAGE, len(encoded_values), len(compressed), page_struct) + compressed
+
+
+class Column:
+    def __init__(self, name, physical_type, repetition, converted_type=None):
+        self.name = name
+        self.physical_type = physical_type
+        self.repetition = repetition
+        self.converted_type = converted_type
+
+    def schema_element(self):
+        element = Struct().i32(1, self.physical_type).i32(3, self.repetition).binary(4, self.name)
+        if self.converted_type is not None:
+            element.i32(6, self.converted_type)
+        return element
+
+
+class ColumnChunk:
+    """The pages of a column chunk, where the dictionary page (if any) precedes the data pages"""
+
+    def __init__(self, number_of_values, data_pages, dictionary=None, codec=UNCOMPRESSED, statistics=None, size_adjustment=0):
+        self.number_of_values = number_of_values
+        self.data_pages = data_pages
+        self.dictionary = dictionary
+        self.codec = codec
+        self.statistics = statistics
+        # Lets the metadata claim another size of the column chunk than the size of its pages
+        self.size_adjustment = size_adjustment
+
+
+class ParquetFile:
+    def __init__(self, columns):
+        self.columns = columns
+        self.out = bytearray(b"PAR1")
+        self.row_groups = []
+        self.number_of_rows = 0
+
+    def add_row_group(self, number_of_rows, column_chunks):
+        self.number_of_rows += number_of_rows
+        chunks = []
+        for column, chunk in zip(self.columns, column_chunks):
+            dictionary_offset = None
+            if chunk.dictionary is not None:
+                dictionary_offset = len(self.out)
+                self.out += chunk.dictionary
+            data_offset = len(self.out)
+            for page in chunk.data_pages:
+                self.out += page
+            total_size = len(self.out) - (dictionary_offset if dictionary_offset is not None else data_offset)
+            metadata = (
+                Struct()
+                .i32(1, column.physical_type)
+                .list(2, I32, [PLAIN, RLE] + ([RLE_DICTIONARY] if chunk.dictionary is not None else []))
+                .list(3, BINARY, [column.name])
+                .i32(4, chunk.codec)
+                .i64(5, chunk.number_of_values)
+                .i64(6, total_size)
+                .i64(7, total_size + chunk.size_adjustment)
+                .i64(9, data_offset)
+            )
+            if dictionary_offset is not None:
+                metadata.i64(11, dictionary_offset)
+            if chunk.statistics is not None:
+                metadata.struct(12, chunk.statistics)
+            chunks.append(Struct().i64(2, data_offset).struct(3, metadata))
+        self.row_groups.append(Struct().list(1, STRUCT, chunks).i64(2, 0).i64(3, number_of_rows))
+
+    def metadata(self):
+        """The FileMetaData, to which a test can append further fields before ending it"""
+        root = Struct().binary(4, "schema").i32(5, len(self.columns))
+        return (
+            Struct()
+            .i32(1, 1)
+            .list(2, STRUCT, [root] + [column.schema_element() for column in self.columns])
+            .i64(3, self.number_of_rows)
+            .list(4, STRUCT, self.row_groups)
+        )
+
+    def write(self, path, metadata=None, footer=None):
+        footer = footer if footer is not None else (metadata if metadata is not None else self.metadata()).end()
+        with open(path, "wb") as file:
+            file.write(bytes(self.out) + footer + struct.pack("<I", len(footer)) + b"PAR1")
+
+
+def int64_statistics(values, null_count=0):
+    return Struct().i64(3, null_count).binary(5, struct.pack("<q", max(values))).binary(6, struct.pack("<q", min(values)))
+
+
+def write_plain():
+    """Two row groups of PLAIN encoded data pages of version 1 with statistics, where the definition levels of the optional price
+    contain bit-packed and RLE runs"""
+    columns = [
+        Column("id", INT64, REQUIRED),
+        Column("price", PDOUBLE, OPTIONAL),
+        Column("name", BYTE_ARRAY, REQUIRED, UTF8),
+        Column("quantity", INT32, REQUIRED, UINT_32),
+    ]
+    file = ParquetFile(columns)
+    for first_id, nulls, definition_levels in [
+        (0, {2, 3, 4}, bit_packed_run([1, 1, 0, 0, 0, 1, 1, 1], 1) + rle_run(2, 1, 1)),
+        (10, {19}, rle_run(9, 1, 1) + rle_run(1, 0, 1)),
+    ]:
+        ids = list(range(first_id, first_id + 10))
+        prices = [id_ * 1.5 for id_ in ids if id_ not in nulls]
+        file.add_row_group(
+            10,
+            [
+                ColumnChunk(10, [data_page(10, PLAIN, plain(INT64, ids))], statistics=int64_statistics(ids)),
+                ColumnChunk(
+                    10,
+                    [data_page(10, PLAIN, plain(PDOUBLE, prices), definition_levels)],
+                    statistics=Struct().i64(3, len(nulls)),
+                ),
+                ColumnChunk(10, [data_page(10, PLAIN, plain(BYTE_ARRAY, [f"name{id_}" for id_ in ids]))]),
+                ColumnChunk(10, [data_page(10, PLAIN, plain(INT32, [4000000000 - id_ for id_ in ids]))]),
+            ],
+        )
+    file.write(os.path.join(TEST_DATA_DIR, "plain.parquet"))
+    return file
+
+
+def write_dictionary():
+    """A dictionary encoded VARSIZED column with nulls, whose two data pages share the dictionary, and a dictionary encoded INT64 column
+    with the deprecated PLAIN_DICTIONARY encoding"""
+    columns = [Column("city", BYTE_ARRAY, OPTIONAL, UTF8), Column("code", INT64, REQUIRED)]
+    file = ParquetFile(columns)
+    cities = dictionary_page(3, plain(BYTE_ARRAY, ["Berlin", "Paris", "Rome"]))
+    # Berlin, Berlin, Berlin, null, Paris, Rome
+    first_page = data_page(
+        6, RLE_DICTIONARY, bytes([2]) + rle_run(3, 0, 2) + bit_packed_run([1, 2], 2), bit_packed_run([1, 1, 1, 0, 1, 1], 1)
+    )
+    # Rome, Rome, null, null, Berlin, Paris
+    second_page = data_page(
+        6, RLE_DICTIONARY, bytes([2]) + bit_packed_run([2, 2, 0, 1], 2), rle_run(2, 1, 1) + rle_run(2, 0, 1) + rle_run(2, 1, 1)
+    )
+    codes = dictionary_page(2, plain(INT64, [100, 200]))
+    code_page = data_page(12, PLAIN_DICTIONARY, bytes([1]) + bit_packed_run([0, 1] * 6, 1))
+    file.add_row_group(
+        12, [ColumnChunk(12, [first_page, second_page], dictionary=cities), ColumnChunk(12, [code_page], dictionary=codes)]
+    )
+    file.write(os.path.join(TEST_DATA_DIR, "dictionary.parquet"))
+
+    # The last index of the first page references a value after the end of the dictionary
+    file = ParquetFile(columns)
+    corrupt_page = data_page(
+        6, RLE_DICTIONARY, bytes([2]) + rle_run(3, 0, 2) + bit_packed_run([1, 3], 2), bit_packed_run([1, 1, 1, 0, 1, 1], 1)
+    )
+    file.add_row_group(
+        12, [ColumnChunk(12, [corrupt_page, second_page], dictionary=cities), ColumnChunk(12, [code_page], dictionary=codes)]
+    )
+    file.write(os.path.join(TEST_DATA_DIR, "dictionary_index_out_of_range.parquet"))
+
+
+def write_zstd():
+    """A zstd compressed column chunk with a data page of version 1 and of version 2, and a zstd compressed dictionary"""
+    columns = [Column("value", INT32, OPTIONAL), Column("label", BYTE_ARRAY, REQUIRED, UTF8)]
+    file = ParquetFile(columns)
+    values = ColumnChunk(
+        8,
+        [
+            # 1, null, 3, 4
+            data_page(4, PLAIN, plain(INT32, [1, 3, 4]), rle_run(1, 1, 1) + rle_run(1, 0, 1) + rle_run(2, 1, 1), codec=ZSTD),
+            # 5, 6, null, 8
+            data_page_v2(4, 1, PLAIN, plain(INT32, [5, 6, 8]), bit_packed_run([1, 1, 0, 1], 1), codec=ZSTD),
+        ],
+        codec=ZSTD,
+    )
+    labels = ColumnChunk(
+        8,
+        [data_page_v2(8, 0, RLE_DICTIONARY, bytes([1]) + bit_packed_run([0, 1, 1, 0, 0, 0, 1, 1], 1), codec=ZSTD)],
+        dictionary=dictionary_page(2, plain(BYTE_ARRAY, ["a", "bb"]), codec=ZSTD),
+        codec=ZSTD,
+    )
+    file.add_row_group(8, [values, labels])
+    file.write(os.path.join(TEST_DATA_DIR, "zstd.parquet"))
+
+    # The compressed values of the data page are not a zstd frame
+    file = ParquetFile(columns[:1])
+    body = struct.pack("<I", 2) + rle_run(4, 1, 1) + plain(INT32, [1, 2, 3, 4])
+    garbage = b"\x28\xb5\x2f\xfd" + bytes(range(1, 17))
+    corrupt_page = page_header(DATA_PAGE, len(body), len(garbage), Struct().i32(1, 4).i32(2, PLAIN).i32(3, RLE).i32(4, RLE)) + garbage
+    file.add_row_group(4, [ColumnChunk(4, [corrupt_page], codec=ZSTD)])
+    file.write(os.path.join(TEST_DATA_DIR, "corrupt_zstd.parquet"))
+
+
+def write_thrift_compact():
+    """A file, whose metadata contains every type of the Thrift compact protocol in the fields that the reader skips, including field ids
+    that do not fit the delta of the field header, lists with more than 14 elements and nested structs"""
+    columns = [Column("x", INT32, REQUIRED)]
+    file = ParquetFile(columns)
+    file.add_row_group(3, [ColumnChunk(3, [data_page(3, PLAIN, plain(INT32, [7, 8, 9]), crc=12345)])])
+    key_value = [Struct().binary(1, "writer").binary(2, "GenerateParquetTestData"), Struct().binary(1, "empty")]
+    nested = Struct().struct(1, Struct().list(1, STRUCT, [Struct().i64(1, -1), Struct()]).map(2, I32, STRUCT, [])).boolean(3, True)
+    metadata = (
+        file.metadata()
+        .list(5, STRUCT, key_value)
+        .binary(6, "GenerateParquetTestData")
+        .double(9, 3.25)
+        .map(10, BINARY, I32, [("a", 1), ("b", -2)])
+        .boolean(11, True)
+        .boolean(12, False)
+        .list(13, BOOL_TRUE, [True, False, True])
+        .byte(14, 0x7F)
+        .i16(15, -300)
+        .list(100, I64, list(range(-10, 10)), container_type=SET)
+        .struct(101, nested)
+        .map(200, BINARY, BINARY, [])
+        .list(201, BINARY, [])
+    )
+    file.write(os.path.join(TEST_DATA_DIR, "thrift_compact.parquet"), metadata)
+
+
+def write_malformed(plain_file):
+    with open(os.path.join(TEST_DATA_DIR, "not_parquet.parquet"), "w") as file:
+        file.write("id,price,name,quantity\n0,0.0,name0,4000000000\n")
+
+    with open(os.path.join(TEST_DATA_DIR, "plain.parquet"), "rb") as file:
+        plain_bytes = file.read()
+    # The file ends in the middle of its footer
+    with open(os.path.join(TEST_DATA_DIR, "truncated.parquet"), "wb") as file:
+        file.write(plain_bytes[: len(plain_bytes) - 40])
+
+    # The length of the footer exceeds the file
+    with open(os.path.join(TEST_DATA_DIR, "footer_exceeds_file.parquet"), "wb") as file:
+        file.write(plain_bytes[:-8] + struct.pack("<I", len(plain_bytes)) + b"PAR1")
+
+    # The footer ends in the middle of the list of row groups, but its length and the magic bytes are valid
+    footer = plain_file.metadata().end()
+    truncated_metadata = footer[: len(footer) // 2]
+    plain_file.write(os.path.join(TEST_DATA_DIR, "truncated_metadata.parquet"), footer=truncated_metadata)
+
+    # The column chunk claims to be shorter than its data page
+    file = ParquetFile([Column("id", INT64, REQUIRED)])
+    file.add_row_group(10, [ColumnChunk(10, [data_page(10, PLAIN, plain(INT64, list(range(10))))], size_adjustment=-8)])
+    file.write(os.path.join(TEST_DATA_DIR, "page_exceeds_column_chunk.parquet"))
+
+
+def write_systest_orders():
+    """The orders of the Parquet systest in two row groups, whose statistics let a predicate on the price skip the first row group"""
+    columns = [Column("id", INT64, REQUIRED, UINT_64), Column("price", INT64, REQUIRED), Column("product", BYTE_ARRAY, REQUIRED, UTF8)]
+    file = ParquetFile(columns)
+    rows = [
+        [(1, 10, "apple"), (2, 25, "pear"), (3, 40, "plum")],
+        [(4, 120, "melon"), (5, 150, "mango"), (6, 180, "papaya")],
+    ]
+    for row_group in rows:
+        ids, prices, products = (list(values) for values in zip(*row_group))
+        file.add_row_group(
+            len(row_group),
+            [
+                ColumnChunk(len(ids), [data_page(len(ids), PLAIN, plain(INT64, ids))]),
+                ColumnChunk(len(prices), [data_page(len(prices), PLAIN, plain(INT64, prices))], statistics=int64_statistics(prices)),
+                ColumnChunk(len(products), [data_page(len(products), PLAIN, plain(BYTE_ARRAY, products))]),
+            ],
+        )
+    file.write(os.path.join(SYSTEST_DATA_DIR, "orders.parquet"))
+
+
+if __name__ == "__main__":
+    write_malformed(write_plain())
+    write_dictionary()
+    write_zstd()
+    write_thrift_compact()
+    write_systest_orders()
@@ -0,0 +1,398 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <SharedMemoryRing.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <new>
+#include <span>
+#include <stop_token>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+namespace
+{
+/// Marks the rest of the data area as padding, as the next frame did not fit before its end
+constexpr uint32_t PADDING_FRAME = UINT32_MAX;
+constexpr uint64_t FRAME_HEADER_SIZE = SharedMemoryRing::FRAME_ALIGNMENT;
+constexpr auto CONNECT_RETRY_INTERVAL = std::chrono::milliseconds(10);
+constexpr auto FULL_RING_WAIT_TIMEOUT = std::chrono::milliseconds(100);
+
+constexpr uint64_t getFrameSize(const uint64_t numberOfBytes)
+{
+    return (FRAME_HEADER_SIZE + numberOfBytes + SharedMemoryRing::FRAME_ALIGNMENT - 1) & ~(SharedMemoryRing::FRAME_ALIGNMENT - 1);
+}
+
+constexpr size_t getDataOffset()
+{
+    return (sizeof(SharedMemoryRingHeader) + SharedMemoryRingHeader::CACHE_LINE_SIZE - 1) & ~(SharedMemoryRingHeader::CACHE_LINE_SIZE - 1);
+}
+
+/// The futex words live in memory that other processes map, thus we must not use the process-private futex operations
+void futexWait(std::atomic<uint32_t>& word, const uint32_t expected, const std::chrono::milliseconds timeout)
+{
+    const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+    const timespec relativeTimeout{.tv_sec = seconds.count(), .tv_nsec = std::chrono::nanoseconds(timeout - seconds).count()};
+    /// Spurious wake-ups, timeouts, and a changed futex word all return to the caller, which checks the ring again
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, &relativeTimeout, nullptr, 0); /// NOLINT
+}
+
+void futexWake(std::atomic<uint32_t>& word)
+{
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0); /// NOLINT
+}
+
+/// Wakes the other side, if it announced that it waits. The announcement and the position are both sequentially consistent, thus either
+/// the waiting side sees the new position before it sleeps, or this side sees the announcement.
+void notify(std::atomic<uint32_t>& waiting, std::atomic<uint32_t>& sequence)
+{
+    if (waiting.load(std::memory_order_seq_cst) != 0)
+    {
+        sequence.fetch_add(1, std::memory_order_seq_cst);
+        futexWake(sequence);
+    }
+}
+
+SharedMemoryRing connectAndReceiveRing(
+    const std::filesystem::path& socketPath, const std::chrono::milliseconds connectTimeout, const std::stop_token& stopToken)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    const auto& path = socketPath.native();
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        throw CannotOpenSource("The socket path {} of the shared memory ring is too long", path);
+    }
+    std::ranges::copy(path, address.sun_path);
+
+    const auto deadline = std::chrono::steady_clock::now() + connectTimeout;
+    while (not stopToken.stop_requested())
+    {
+        const int connection = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (connection < 0)
+        {
+            throw CannotOpenSource("Could not create the socket for the shared memory ring: {}", std::strerror(errno));
+        }
+        if (connect(connection, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0) /// NOLINT
+        {
+            const auto fileDescriptor = receiveFileDescriptor(connection);
+            ::close(connection);
+            return SharedMemoryRing::attach(fileDescriptor);
+        }
+        ::close(connection);
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            break;
+        }
+        /// The source creates the socket, once the query starts
+        std::this_thread::sleep_for(CONNECT_RETRY_INTERVAL);
+    }
+    throw CannotOpenSource("Could not connect to the shared memory source at {}", path);
+}
+}
+
+SharedMemoryRing SharedMemoryRing::create(const uint64_t capacity)
+{
+    PRECONDITION(
+        std::has_single_bit(capacity) and capacity >= MIN_CAPACITY,
+        "The capacity of a shared memory ring must be a power of two of at least {}, but got {}",
+        MIN_CAPACITY,
+        capacity);
+    const int fileDescriptor = memfd_create("nes-shared-memory-source", MFD_CLOEXEC);
+    if (fileDescriptor < 0)
+    {
+        throw CannotOpenSource("Could not create the memfd of the shared memory ring: {}", std::strerror(errno));
+    }
+    const auto mappingSize = getDataOffset() + capacity;
+    if (ftruncate(fileDescriptor, static_cast<off_t>(mappingSize)) != 0)
+    {
+        ::close(fileDescriptor);
+        throw CannotOpenSource("Could not resize the memfd of the shared memory ring to {} bytes: {}", mappingSize, std::strerror(errno));
+    }
+    auto* const mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+    if (mapping == MAP_FAILED) /// NOLINT(performance-no-int-to-ptr)
+    {
+        ::close(fileDescriptor);
+        throw CannotOpenSource("Could not map the memfd of the shared memory ring: {}", std::strerror(errno));
+    }
+    auto* const header = new (mapping) SharedMemoryRingHeader{};
+    header->capacity = capacity;
+    /// Producers only attach to rings with the magic, thus it is the last write of the initialization
+    std::atomic_ref(header->magic).store(SharedMemoryRingHeader::MAGIC, std::memory_order_release);
+    return SharedMemoryRing{fileDescriptor, header, mappingSize};
+}
+
+SharedMemoryRing SharedMemoryRing::attach(const int fileDescriptor)
+{
+    auto* const headerMapping = mmap(nullptr, sizeof(SharedMemoryRingHeader), PROT_READ, MAP_SHARED, fileDescriptor, 0);
+    if (headerMapping == MAP_FAILED) /// NOLINT(performance-no-int-to-ptr)
+    {
+        ::close(fileDescriptor);
+        throw CannotOpenSource("Could not map the header of the shared memory ring: {}", std::strerror(errno));
+    }
+    const auto* const mappedHeader = static_cast<const SharedMemoryRingHeader*>(headerMapping);
+    const auto magic = std::atomic_ref(const_cast<uint64_t&>(mappedHeader->magic)).load(std::memory_order_acquire); /// NOLINT
+    const auto capacity = mappedHeader->capacity;
+    munmap(headerMapping, sizeof(SharedMemoryRingHeader));
+    if (magic != SharedMemoryRingHeader::MAGIC or not std::has_single_bit(capacity) or capacity < MIN_CAPACITY)
+    {
+        ::close(fileDescriptor);
+        throw CannotOpenSource("The file descriptor does not contain a shared memory ring");
+    }
+
+    const auto mappingSize = getDataOffset() + capacity;
+    auto* const mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+    if (mapping == MAP_FAILED) /// NOLINT(performance-no-int-to-ptr)
+    {
+        ::close(fileDescriptor);
+        throw CannotOpenSource("Could not map the shared memory ring: {}", std::strerror(errno));
+    }
+    return SharedMemoryRing{fileDescriptor, static_cast<SharedMemoryRingHeader*>(mapping), mappingSize};
+}
+
+SharedMemoryRing::SharedMemoryRing(const int fileDescriptor, SharedMemoryRingHeader* header, const size_t mappingSize)
+    : fileDescriptor(fileDescriptor), header(header), mappingSize(mappingSize)
+{
+}
+
+SharedMemoryRing::SharedMemoryRing(SharedMemoryRing&& other) noexcept
+    : fileDescriptor(std::exchange(other.fileDescriptor, -1))
+    , header(std::exchange(other.header, nullptr))
+    , mappingSize(std::exchange(other.mappingSize, 0))
+{
+}
+
+SharedMemoryRing& SharedMemoryRing::operator=(SharedMemoryRing&& other) noexcept
+{
+    if (this != &other)
+    {
+        std::swap(fileDescriptor, other.fileDescriptor);
+        std::swap(header, other.header);
+        std::swap(mappingSize, other.mappingSize);
+    }
+    return *this;
+}
+
+SharedMemoryRing::~SharedMemoryRing()
+{
+    if (header != nullptr)
+    {
+        munmap(header, mappingSize);
+    }
+    if (fileDescriptor >= 0)
+    {
+        ::close(fileDescriptor);
+    }
+}
+
+uint64_t SharedMemoryRing::getMaxFrameSize() const
+{
+    /// In the worst case, the padding before the frame takes the rest of the data area, thus a frame may take half of it
+    return (header->capacity / 2) - FRAME_HEADER_SIZE;
+}
+
+std::byte* SharedMemoryRing::getData() const
+{
+    return reinterpret_cast<std::byte*>(header) + getDataOffset(); /// NOLINT
+}
+
+size_t SharedMemoryRing::readFrames(const std::span<std::byte> buffer)
+{
+    const auto mask = header->capacity - 1;
+    auto readPosition = header->readPosition.load(std::memory_order_relaxed);
+    const auto writePosition = header->writePosition.load(std::memory_order_acquire);
+    size_t numberOfBytes = 0;
+    while (readPosition != writePosition)
+    {
+        const auto offset = readPosition & mask;
+        uint32_t frameLength = 0;
+        std::memcpy(&frameLength, getData() + offset, sizeof(frameLength));
+        if (frameLength == PADDING_FRAME)
+        {
+            readPosition += header->capacity - offset;
+            continue;
+        }
+        if (frameLength > buffer.size() - numberOfBytes)
+        {
+            if (numberOfBytes == 0)
+            {
+                throw CannotFormatSourceData(
+                    "The frame of {} bytes of the shared memory ring exceeds the tuple buffer of {} bytes", frameLength, buffer.size());
+            }
+            break;
+        }
+        std::memcpy(buffer.data() + numberOfBytes, getData() + offset + FRAME_HEADER_SIZE, frameLength);
+        numberOfBytes += frameLength;
+        readPosition += getFrameSize(frameLength);
+    }
+    header->readPosition.store(readPosition, std::memory_order_seq_cst);
+    notify(header->producerWaiting, header->spaceSequence);
+    return numberOfBytes;
+}
+
+void SharedMemoryRing::waitForFrames(const std::chrono::milliseconds timeout)
+{
+    const auto sequence = header->dataSequence.load(std::memory_order_seq_cst);
+    header->consumerWaiting.store(1, std::memory_order_seq_cst);
+    if (header->writePosition.load(std::memory_order_seq_cst) == header->readPosition.load(std::memory_order_relaxed)
+        and header->producerClosed.load(std::memory_order_seq_cst) == 0)
+    {
+        futexWait(header->dataSequence, sequence, timeout);
+    }
+    header->consumerWaiting.store(0, std::memory_order_relaxed);
+}
+
+bool SharedMemoryRing::isDrained() const
+{
+    return header->producerClosed.load(std::memory_order_seq_cst) != 0
+        and header->writePosition.load(std::memory_order_acquire) == header->readPosition.load(std::memory_order_relaxed);
+}
+
+void SharedMemoryRing::closeConsumer()
+{
+    header->consumerClosed.store(1, std::memory_order_seq_cst);
+    header->spaceSequence.fetch_add(1, std::memory_order_seq_cst);
+    futexWake(header->spaceSequence);
+}
+
+bool SharedMemoryRing::writeFrame(const std::span<const std::byte> records, const std::stop_token& stopToken)
+{
+    PRECONDITION(
+        records.size() <= getMaxFrameSize(),
+        "A frame of the shared memory ring holds at most {} bytes, but got {}",
+        getMaxFrameSize(),
+        records.size());
+    const auto mask = header->capacity - 1;
+    auto writePosition = header->writePosition.load(std::memory_order_relaxed);
+    const auto frameSize = getFrameSize(records.size());
+    const auto bytesUntilEnd = header->capacity - (writePosition & mask);
+    const auto requiredBytes = frameSize <= bytesUntilEnd ? frameSize : bytesUntilEnd + frameSize;
+
+    while (header->capacity - (writePosition - header->readPosition.load(std::memory_order_acquire)) < requiredBytes)
+    {
+        if (header->consumerClosed.load(std::memory_order_acquire) != 0 or stopToken.stop_requested())
+        {
+            return false;
+        }
+        const auto sequence = header->spaceSequence.load(std::memory_order_seq_cst);
+        header->producerWaiting.store(1, std::memory_order_seq_cst);
+        if (header->capacity - (writePosition - header->readPosition.load(std::memory_order_seq_cst)) < requiredBytes)
+        {
+            futexWait(header->spaceSequence, sequence, FULL_RING_WAIT_TIMEOUT);
+        }
+        header->producerWaiting.store(0, std::memory_order_relaxed);
+    }
+
+    if (frameSize > bytesUntilEnd)
+    {
+        std::memcpy(getData() + (writePosition & mask), &PADDING_FRAME, sizeof(PADDING_FRAME));
+        writePosition += bytesUntilEnd;
+    }
+    const auto frameLength = static_cast<uint32_t>(records.size());
+    std::memcpy(getData() + (writePosition & mask), &frameLength, sizeof(frameLength));
+    std::memcpy(getData() + (writePosition & mask) + FRAME_HEADER_SIZE, records.data(), records.size());
+    header->writePosition.store(writePosition + frameSize, std::memory_order_seq_cst);
+    notify(header->consumerWaiting, header->dataSequence);
+    return true;
+}
+
+bool SharedMemoryRing::writeFrame(const std::string_view records, const std::stop_token& stopToken)
+{
+    return writeFrame(std::as_bytes(std::span(records)), stopToken);
+}
+
+void SharedMemoryRing::closeProducer()
+{
+    header->producerClosed.store(1, std::memory_order_seq_cst);
+    header->dataSequence.fetch_add(1, std::memory_order_seq_cst);
+    futexWake(header->dataSequence);
+}
+
+void sendFileDescriptor(const int socket, const int fileDescriptor)
+{
+    char payload = 0;
+    iovec data{.iov_base = &payload, .iov_len = sizeof(payload)};
+    alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(int))> control{};
+    msghdr message{};
+    message.msg_iov = &data;
+    message.msg_iovlen = 1;
+    message.msg_control = control.data();
+    message.msg_controllen = control.size();
+    auto* const controlMessage = CMSG_FIRSTHDR(&message);
+    controlMessage->cmsg_level = SOL_SOCKET;
+    controlMessage->cmsg_type = SCM_RIGHTS;
+    controlMessage->cmsg_len = CMSG_LEN(sizeof(int));
+    std::memcpy(CMSG_DATA(controlMessage), &fileDescriptor, sizeof(int));
+    if (sendmsg(socket, &message, MSG_NOSIGNAL) < 0)
+    {
+        throw CannotOpenSource("Could not pass the shared memory ring to the producer: {}", std::strerror(errno));
+    }
+}
+
+int receiveFileDescriptor(const int socket)
+{
+    char payload = 0;
+    iovec data{.iov_base = &payload, .iov_len = sizeof(payload)};
+    alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(int))> control{};
+    msghdr message{};
+    message.msg_iov = &data;
+    message.msg_iovlen = 1;
+    message.msg_control = control.data();
+    message.msg_controllen = control.size();
+    if (recvmsg(socket, &message, MSG_CMSG_CLOEXEC) <= 0)
+    {
+        throw CannotOpenSource("Could not receive the shared memory ring from the source: {}", std::strerror(errno));
+    }
+    const auto* const controlMessage = CMSG_FIRSTHDR(&message);
+    if (controlMessage == nullptr or controlMessage->cmsg_level != SOL_SOCKET or controlMessage->cmsg_type != SCM_RIGHTS)
+    {
+        throw CannotOpenSource("The source did not pass a shared memory ring");
+    }
+    int fileDescriptor = -1;
+    std::memcpy(&fileDescriptor, CMSG_DATA(controlMessage), sizeof(int));
+    return fileDescriptor;
+}
+
+SharedMemoryRingProducer::SharedMemoryRingProducer(
+    const std::filesystem::path& socketPath, const std::chrono::milliseconds connectTimeout, const std::stop_token& stopToken)
+    : ring(connectAndReceiveRing(socketPath, connectTimeout, stopToken))
+{
+}
+
+SharedMemoryRingProducer::~SharedMemoryRingProducer()
+{
+    ring.closeProducer();
+}
+
+}
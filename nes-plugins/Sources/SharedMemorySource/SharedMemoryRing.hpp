@@ -0,0 +1,139 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <stop_token>
+#include <string_view>
+
+namespace NES
+{
+
+/// Lays out the ring at the start of the shared memory, followed by its data area of `capacity` bytes. The producer and the worker map
+/// the same memory, thus the layout must not depend on the compiler flags of either side.
+struct SharedMemoryRingHeader
+{
+    static constexpr uint64_t MAGIC = 0x31524D485353454E; /// "NESSHMR1"
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+
+    uint64_t magic;
+    uint64_t capacity;
+
+    /// Written by the producer. Counts all bytes that the producer published, thus the offset in the data area is writePosition % capacity.
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> writePosition;
+    /// Futex word that the producer increments, when it publishes frames or closes the ring, while the consumer waits
+    std::atomic<uint32_t> dataSequence;
+    std::atomic<uint32_t> producerWaiting;
+    std::atomic<uint32_t> producerClosed;
+
+    /// Written by the consumer. Counts all bytes that the consumer released.
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> readPosition;
+    /// Futex word that the consumer increments, when it releases frames or closes the ring, while the producer waits
+    std::atomic<uint32_t> spaceSequence;
+    std::atomic<uint32_t> consumerWaiting;
+    std::atomic<uint32_t> consumerClosed;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free and std::atomic<uint32_t>::is_always_lock_free);
+
+/// Single-producer single-consumer ring of framed records in a memfd, which a producer on the same host shares with the worker.
+/// Each frame consists of its length and the records, padded to FRAME_ALIGNMENT. A frame never wraps around the end of the data area.
+/// Instead, the producer marks the rest of the data area as padding. The consumer copies whole frames into its tuple buffers, thus the
+/// records of a frame never span two tuple buffers.
+/// Both sides only wait, if the ring is empty or full. Then, they sleep on a futex, and the other side only issues a wake-up system call,
+/// if its counterpart announced that it waits.
+class SharedMemoryRing
+{
+public:
+    static constexpr uint64_t FRAME_ALIGNMENT = 8;
+    static constexpr uint64_t MIN_CAPACITY = 4096;
+
+    /// Creates a new ring with a data area of the capacity, which must be a power of two of at least MIN_CAPACITY
+    static SharedMemoryRing create(uint64_t capacity);
+    /// Maps the ring of the file descriptor of a memfd, which it takes the ownership of
+    static SharedMemoryRing attach(int fileDescriptor);
+
+    SharedMemoryRing(const SharedMemoryRing&) = delete;
+    SharedMemoryRing& operator=(const SharedMemoryRing&) = delete;
+    SharedMemoryRing(SharedMemoryRing&& other) noexcept;
+    SharedMemoryRing& operator=(SharedMemoryRing&& other) noexcept;
+    ~SharedMemoryRing();
+
+    [[nodiscard]] int getFileDescriptor() const { return fileDescriptor; }
+
+    [[nodiscard]] uint64_t getCapacity() const { return header->capacity; }
+
+    /// Largest number of bytes of records in one frame, so that a frame and the padding before it always fit into the ring
+    [[nodiscard]] uint64_t getMaxFrameSize() const;
+
+    /// Consumer: copies the records of the published frames into the buffer, until the next frame does not fit. Returns the number of
+    /// copied bytes. Throws, if the first frame is larger than the buffer, as it would never fit.
+    size_t readFrames(std::span<std::byte> buffer);
+    /// Consumer: waits up to the timeout for the producer to publish a frame or to close the ring
+    void waitForFrames(std::chrono::milliseconds timeout);
+    /// Consumer: returns true, if the producer closed the ring and the consumer read all frames
+    [[nodiscard]] bool isDrained() const;
+    /// Consumer: tells the producer that no one reads the ring anymore
+    void closeConsumer();
+
+    /// Producer: publishes the records as one frame. Waits while the ring is full. Returns false, if the consumer closed the ring or a stop
+    /// was requested.
+    bool writeFrame(std::span<const std::byte> records, const std::stop_token& stopToken);
+    bool writeFrame(std::string_view records, const std::stop_token& stopToken);
+    /// Producer: ends the stream, once the consumer read the published frames
+    void closeProducer();
+
+private:
+    SharedMemoryRing(int fileDescriptor, SharedMemoryRingHeader* header, size_t mappingSize);
+
+    [[nodiscard]] std::byte* getData() const;
+
+    int fileDescriptor;
+    SharedMemoryRingHeader* header;
+    size_t mappingSize;
+};
+
+/// Passes the file descriptor of the memfd of a ring to the producer via SCM_RIGHTS over a connected Unix domain socket
+void sendFileDescriptor(int socket, int fileDescriptor);
+/// Receives the file descriptor of the memfd of a ring from the worker over a connected Unix domain socket
+[[nodiscard]] int receiveFileDescriptor(int socket);
+
+/// Producer side of a ring, e.g., for a co-located process that ingests into the worker. Connects to the Unix domain socket of a
+/// SharedMemorySource, receives the ring via the socket, and closes the ring (ending the stream) on destruction.
+class SharedMemoryRingProducer
+{
+public:
+    /// Retries the connection until the source listens on the socket, the timeout passes, or a stop is requested
+    SharedMemoryRingProducer(
+        const std::filesystem::path& socketPath, std::chrono::milliseconds connectTimeout, const std::stop_token& stopToken);
+
+    SharedMemoryRingProducer(const SharedMemoryRingProducer&) = delete;
+    SharedMemoryRingProducer& operator=(const SharedMemoryRingProducer&) = delete;
+    SharedMemoryRingProducer(SharedMemoryRingProducer&&) = delete;
+    SharedMemoryRingProducer& operator=(SharedMemoryRingProducer&&) = delete;
+    ~SharedMemoryRingProducer();
+
+    [[nodiscard]] SharedMemoryRing& getRing() { return ring; }
+
+private:
+    SharedMemoryRing ring;
+};
+
+}
@@ -0,0 +1,266 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <SharedMemorySource.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <Configurations/Descriptor.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sources/Source.hpp>
+#include <Sources/SourceDescriptor.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <fmt/format.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <ErrorHandling.hpp>
+#include <FileDataRegistry.hpp>
+#include <InlineDataRegistry.hpp>
+#include <SharedMemoryRing.hpp>
+#include <SourceRegistry.hpp>
+#include <SourceValidationRegistry.hpp>
+#include <poll.h>
+#include <unistd.h>
+
+namespace NES
+{
+
+SharedMemorySource::SharedMemorySource(const SourceDescriptor& sourceDescriptor)
+    : socketPath(sourceDescriptor.getFromConfig(ConfigParametersSharedMemorySource::SOCKET_PATH))
+    , ringSize(sourceDescriptor.getFromConfig(ConfigParametersSharedMemorySource::RING_SIZE))
+{
+}
+
+SharedMemorySource::~SharedMemorySource()
+{
+    close();
+}
+
+std::ostream& SharedMemorySource::toString(std::ostream& str) const
+{
+    str << "\nSharedMemorySource(";
+    str << "\n  socket path: " << socketPath;
+    str << "\n  ring size: " << ringSize;
+    str << "\n  received bytes: " << receivedBytes;
+    str << ")\n";
+    return str;
+}
+
+void SharedMemorySource::open(std::shared_ptr<AbstractBufferProvider>)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path))
+    {
+        throw CannotOpenSource("The socket path {} of the shared memory source is too long", socketPath);
+    }
+    std::ranges::copy(socketPath, address.sun_path);
+
+    ring.emplace(SharedMemoryRing::create(ringSize));
+    const int socket = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (socket < 0)
+    {
+        throw CannotOpenSource("Could not create the socket of the shared memory source: {}", std::strerror(errno));
+    }
+    /// A query that restarts on the same path replaces the socket of its previous run
+    ::unlink(socketPath.c_str());
+    if (::bind(socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 or ::listen(socket, 1) != 0) /// NOLINT
+    {
+        const auto error = errno;
+        ::close(socket);
+        throw CannotOpenSource("Could not listen on {}: {}", socketPath, std::strerror(error));
+    }
+    listeningSocket = socket;
+    NES_DEBUG("SharedMemorySource listens on {}", socketPath);
+}
+
+bool SharedMemorySource::acceptProducer(const std::stop_token& stopToken)
+{
+    pollfd pollDescriptor{.fd = listeningSocket, .events = POLLIN, .revents = 0};
+    while (not stopToken.stop_requested())
+    {
+        const auto ready = ::poll(&pollDescriptor, 1, static_cast<int>(POLL_INTERVAL.count()));
+        if (ready < 0 and errno != EINTR)
+        {
+            throw CannotOpenSource("Could not poll the socket {}: {}", socketPath, std::strerror(errno));
+        }
+        if (ready <= 0)
+        {
+            continue;
+        }
+        const int connection = ::accept4(listeningSocket, nullptr, nullptr, SOCK_CLOEXEC);
+        if (connection < 0)
+        {
+            throw CannotOpenSource("Could not accept the producer on {}: {}", socketPath, std::strerror(errno));
+        }
+        sendFileDescriptor(connection, ring->getFileDescriptor());
+        ::close(connection);
+        /// The ring has a single producer, thus the source stops listening right away
+        ::close(listeningSocket);
+        listeningSocket = -1;
+        ::unlink(socketPath.c_str());
+        producerConnected = true;
+        return true;
+    }
+    return false;
+}
+
+Source::FillTupleBufferResult SharedMemorySource::fillTupleBuffer(TupleBuffer& tupleBuffer, const std::stop_token& stopToken)
+{
+    if (not producerConnected and not acceptProducer(stopToken))
+    {
+        return FillTupleBufferResult::eos();
+    }
+
+    const auto buffer = tupleBuffer.getAvailableMemoryArea().first(tupleBuffer.getBufferSize());
+    while (not stopToken.stop_requested())
+    {
+        if (const auto numberOfBytes = ring->readFrames(buffer); numberOfBytes > 0)
+        {
+            receivedBytes += numberOfBytes;
+            return FillTupleBufferResult::withBytes(numberOfBytes);
+        }
+        if (ring->isDrained())
+        {
+            NES_INFO("SharedMemorySource on {} detected EoS", socketPath);
+            return FillTupleBufferResult::eos();
+        }
+        ring->waitForFrames(POLL_INTERVAL);
+    }
+    return FillTupleBufferResult::eos();
+}
+
+void SharedMemorySource::close()
+{
+    if (listeningSocket >= 0)
+    {
+        ::close(listeningSocket);
+        listeningSocket = -1;
+        ::unlink(socketPath.c_str());
+    }
+    if (ring.has_value())
+    {
+        ring->closeConsumer();
+        ring.reset();
+    }
+}
+
+DescriptorConfig::Config SharedMemorySource::validateAndFormat(std::unordered_map<std::string, std::string> config)
+{
+    return DescriptorConfig::validateAndFormat<ConfigParametersSharedMemorySource>(std::move(config), name());
+}
+
+namespace
+{
+/// Returns a socket path for the source of a system test, which is unique among all sources of the test run
+std::string createTestSocketPath()
+{
+    static std::atomic<uint64_t> nextSocketId{0};
+    return std::filesystem::temp_directory_path() / fmt::format("nes-shm-{}-{}.sock", ::getpid(), nextSocketId.fetch_add(1));
+}
+
+/// Mocks a co-located producer, which writes the tuples into the ring of the source
+PhysicalSourceConfig startTestProducer(
+    PhysicalSourceConfig physicalSourceConfig,
+    const std::shared_ptr<std::vector<std::jthread>>& serverThreads,
+    std::function<void(SharedMemoryRing&, const std::stop_token&)> produce)
+{
+    if (physicalSourceConfig.sourceConfig.contains(ConfigParametersSharedMemorySource::SOCKET_PATH))
+    {
+        throw InvalidConfigParameter("Cannot use mock implementation if config already contains a socket path");
+    }
+    const auto socketPath = createTestSocketPath();
+    physicalSourceConfig.sourceConfig.emplace(ConfigParametersSharedMemorySource::SOCKET_PATH, socketPath);
+
+    constexpr auto connectTimeout = std::chrono::minutes(1);
+    serverThreads->emplace_back(
+        [socketPath, produce = std::move(produce)](const std::stop_token& stopToken)
+        {
+            try
+            {
+                SharedMemoryRingProducer producer(socketPath, connectTimeout, stopToken);
+                produce(producer.getRing(), stopToken);
+            }
+            catch (const Exception& exception)
+            {
+                NES_ERROR("The producer of the shared memory source on {} failed: {}", socketPath, exception.what());
+            }
+        });
+    return physicalSourceConfig;
+}
+}
+
+SourceValidationRegistryReturnType RegisterSharedMemorySourceValidation(SourceValidationRegistryArguments sourceConfig)
+{
+    return SharedMemorySource::validateAndFormat(std::move(sourceConfig.config));
+}
+
+SourceRegistryReturnType SourceGeneratedRegistrar::RegisterSharedMemorySource(SourceRegistryArguments sourceRegistryArguments)
+{
+    return std::make_unique<SharedMemorySource>(sourceRegistryArguments.sourceDescriptor);
+}
+
+InlineDataRegistryReturnType
+InlineDataGeneratedRegistrar::RegisterSharedMemoryInlineData(InlineDataRegistryArguments systestAdaptorArguments)
+{
+    return startTestProducer(
+        std::move(systestAdaptorArguments.physicalSourceConfig),
+        systestAdaptorArguments.serverThreads,
+        [tuples = std::move(systestAdaptorArguments.tuples)](SharedMemoryRing& ring, const std::stop_token& stopToken)
+        {
+            for (const auto& tuple : tuples)
+            {
+                if (not ring.writeFrame(tuple + "\n", stopToken))
+                {
+                    return;
+                }
+            }
+        });
+}
+
+FileDataRegistryReturnType FileDataGeneratedRegistrar::RegisterSharedMemoryFileData(FileDataRegistryArguments systestAdaptorArguments)
+{
+    return startTestProducer(
+        std::move(systestAdaptorArguments.physicalSourceConfig),
+        systestAdaptorArguments.serverThreads,
+        [testFilePath = systestAdaptorArguments.testFilePath](SharedMemoryRing& ring, const std::stop_token& stopToken)
+        {
+            std::ifstream testFile(testFilePath);
+            for (std::string line; std::getline(testFile, line);)
+            {
+                if (not ring.writeFrame(line + "\n", stopToken))
+                {
+                    return;
+                }
+            }
+        });
+}
+
+}
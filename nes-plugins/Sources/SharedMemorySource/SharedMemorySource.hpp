@@ -0,0 +1,109 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <stop_token>
+#include <string>
+#include <unordered_map>
+#include <Configurations/Descriptor.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sources/Source.hpp>
+#include <Sources/SourceDescriptor.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <SharedMemoryRing.hpp>
+
+namespace NES
+{
+
+struct ConfigParametersSharedMemorySource
+{
+    /// The Unix domain socket, via which a producer on the same host receives the memfd of the ring
+    static inline const DescriptorConfig::ConfigParameter<std::string> SOCKET_PATH{
+        "shm_socket_path",
+        std::nullopt,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(SOCKET_PATH, config); }};
+    /// Size of the data area of the ring in bytes. Must be a power of two.
+    static inline const DescriptorConfig::ConfigParameter<uint64_t> RING_SIZE{
+        "shm_ring_size",
+        64 * 1024 * 1024,
+        [](const std::unordered_map<std::string, std::string>& config) -> std::optional<uint64_t>
+        {
+            const auto ringSize = DescriptorConfig::tryGet(RING_SIZE, config);
+            if (ringSize.has_value() and (not std::has_single_bit(ringSize.value()) or ringSize.value() < SharedMemoryRing::MIN_CAPACITY))
+            {
+                NES_ERROR("SharedMemorySource: shm_ring_size must be a power of two of at least {}", SharedMemoryRing::MIN_CAPACITY);
+                return std::nullopt;
+            }
+            return ringSize;
+        }};
+
+    static inline std::unordered_map<std::string, DescriptorConfig::ConfigParameterContainer> parameterMap
+        = DescriptorConfig::createConfigParameterContainerMap(SourceDescriptor::parameterMap, SOCKET_PATH, RING_SIZE);
+};
+
+/// Ingests the records of a producer on the same host via a ring in shared memory (see SharedMemoryRing), instead of a TCP connection over
+/// the loopback device. The source creates the ring and passes it to the first producer that connects to its Unix domain socket. Then, the
+/// source copies the frames of the producer from the ring into its tuple buffers, without any system call, as long as the ring is not
+/// empty. The stream ends, once the producer closes the ring and the source read all of its frames.
+class SharedMemorySource : public Source
+{
+public:
+    static const std::string& name()
+    {
+        static const std::string Instance = "SharedMemory";
+        return Instance;
+    }
+
+    explicit SharedMemorySource(const SourceDescriptor& sourceDescriptor);
+    ~SharedMemorySource() override;
+
+    SharedMemorySource(const SharedMemorySource&) = delete;
+    SharedMemorySource& operator=(const SharedMemorySource&) = delete;
+    SharedMemorySource(SharedMemorySource&&) = delete;
+    SharedMemorySource& operator=(SharedMemorySource&&) = delete;
+
+    FillTupleBufferResult fillTupleBuffer(TupleBuffer& tupleBuffer, const std::stop_token& stopToken) override;
+
+    /// Creates the ring and listens for the connection of the producer
+    void open(std::shared_ptr<AbstractBufferProvider> bufferProvider) override;
+    void close() override;
+
+    static DescriptorConfig::Config validateAndFormat(std::unordered_map<std::string, std::string> config);
+
+    [[nodiscard]] std::ostream& toString(std::ostream& str) const override;
+
+private:
+    /// How long the source waits for the producer, before it checks whether a stop was requested
+    static constexpr std::chrono::milliseconds POLL_INTERVAL{100};
+
+    /// Passes the ring to the producer, once it connected. Returns false, if a stop was requested before.
+    bool acceptProducer(const std::stop_token& stopToken);
+
+    std::string socketPath;
+    uint64_t ringSize;
+    std::optional<SharedMemoryRing> ring;
+    int listeningSocket = -1;
+    bool producerConnected = false;
+    uint64_t receivedBytes = 0;
+};
+
+}
@@ -0,0 +1,149 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <SinkLatencyRecorder.hpp>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <ErrorHandling.hpp>
+#include <TCPLoadGenerator.hpp>
+
+namespace NES
+{
+
+namespace
+{
+constexpr auto POLL_INTERVAL = std::chrono::milliseconds(1);
+}
+
+SinkLatencyRecorder::SinkLatencyRecorder(std::filesystem::path sinkFile, const size_t timestampField)
+    : sinkFile(std::move(sinkFile)), timestampField(timestampField)
+{
+}
+
+void SinkLatencyRecorder::run(
+    const std::stop_token& stopToken, const std::stop_token& idleStopToken, const std::chrono::milliseconds idleTimeout)
+{
+    std::ifstream file;
+    while (not stopToken.stop_requested() and not file.is_open())
+    {
+        file.open(sinkFile, std::ios::binary);
+        if (not file.is_open())
+        {
+            std::this_thread::sleep_for(POLL_INTERVAL);
+        }
+    }
+
+    /// The sink may have written a part of a line, which the recorder keeps until the rest of the line is written
+    std::string pendingLine;
+    std::array<char, 64 * 1024> chunk{};
+    auto lastGrowth = std::chrono::steady_clock::now();
+    while (not stopToken.stop_requested())
+    {
+        file.read(chunk.data(), chunk.size());
+        const auto bytesRead = static_cast<size_t>(file.gcount());
+        if (bytesRead == 0)
+        {
+            file.clear();
+            if (idleStopToken.stop_requested() and std::chrono::steady_clock::now() - lastGrowth > idleTimeout)
+            {
+                return;
+            }
+            std::this_thread::sleep_for(POLL_INTERVAL);
+            continue;
+        }
+        lastGrowth = std::chrono::steady_clock::now();
+        const auto now = TCPLoadGenerator::getTimestamp();
+        std::string_view data(chunk.data(), bytesRead);
+        for (auto lineEnd = data.find('\n'); lineEnd != std::string_view::npos; lineEnd = data.find('\n'))
+        {
+            if (pendingLine.empty())
+            {
+                recordLine(data.substr(0, lineEnd), now);
+            }
+            else
+            {
+                pendingLine.append(data.substr(0, lineEnd));
+                recordLine(pendingLine, now);
+                pendingLine.clear();
+            }
+            data.remove_prefix(lineEnd + 1);
+        }
+        pendingLine.append(data);
+        if (file.eof())
+        {
+            file.clear();
+        }
+    }
+}
+
+void SinkLatencyRecorder::recordLine(std::string_view line, const uint64_t now)
+{
+    for (size_t field = 0; field < timestampField; ++field)
+    {
+        const auto delimiter = line.find(',');
+        if (delimiter == std::string_view::npos)
+        {
+            return;
+        }
+        line.remove_prefix(delimiter + 1);
+    }
+    line = line.substr(0, line.find(','));
+
+    uint64_t timestamp = 0;
+    const auto [end, error] = std::from_chars(line.data(), line.data() + line.size(), timestamp);
+    if (error != std::errc{} or end != line.data() + line.size())
+    {
+        return;
+    }
+    /// Adjustments of the system clock may let the time of reading precede the send timestamp
+    latencies.push_back(now > timestamp ? now - timestamp : 0);
+    isSorted = false;
+}
+
+size_t SinkLatencyRecorder::getNumberOfRecordedTuples() const
+{
+    return latencies.size();
+}
+
+std::chrono::microseconds SinkLatencyRecorder::getPercentile(const double fraction)
+{
+    PRECONDITION(fraction > 0 and fraction <= 1, "The fraction of a percentile must be in (0, 1], but was {}", fraction);
+    if (latencies.empty())
+    {
+        return std::chrono::microseconds(0);
+    }
+    if (not isSorted)
+    {
+        std::ranges::sort(latencies);
+        isSorted = true;
+    }
+    const auto rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(latencies.size())));
+    return std::chrono::microseconds(latencies[std::max<size_t>(rank, 1) - 1]);
+}
+
+}
@@ -0,0 +1,55 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <stop_token>
+#include <string_view>
+#include <vector>
+
+namespace NES
+{
+
+/// Measures the latency of the tuples of a TCPLoadGenerator by following the CSV output of a sink, e.g., of a File sink, as it grows.
+/// The latency of a tuple is the difference between the time at which the recorder reads its line and the send timestamp in the
+/// configured field of the line. Thus, the sink and the load generator have to run on the same host (or on hosts with synchronized
+/// clocks). Lines without a timestamp in the field, e.g., a header, are skipped.
+class SinkLatencyRecorder
+{
+public:
+    SinkLatencyRecorder(std::filesystem::path sinkFile, size_t timestampField);
+
+    /// Follows the sink file until the stop is requested, or until the file did not grow for the idle timeout after the stop of the
+    /// idle stop token has been requested, i.e., after all tuples have been sent. Waits for the sink to create the file.
+    void run(const std::stop_token& stopToken, const std::stop_token& idleStopToken, std::chrono::milliseconds idleTimeout);
+
+    /// Records the line of a sink, which was read at the given time in microseconds since the unix epoch
+    void recordLine(std::string_view line, uint64_t now);
+
+    [[nodiscard]] size_t getNumberOfRecordedTuples() const;
+    /// Returns the latency below which the given fraction of all recorded tuples lie, e.g., 0.99 for the 99th percentile (nearest rank)
+    [[nodiscard]] std::chrono::microseconds getPercentile(double fraction);
+
+private:
+    std::filesystem::path sinkFile;
+    size_t timestampField;
+    std::vector<uint64_t> latencies;
+    bool isSorted = true;
+};
+
+}
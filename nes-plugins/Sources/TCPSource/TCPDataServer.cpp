@@ -14,6 +14,7 @@
 
 #include <TCPDataServer.hpp>
 
+#include <cstdint>
 #include <exception>
 #include <filesystem>
 #include <fstream>
@@ -72,6 +73,13 @@ TCPDataServer::TCPDataServer(std::filesystem::path filePath)
     };
 }
 
+TCPDataServer::TCPDataServer(DataProvider dataProvider, const uint16_t port)
+    : acceptor(io_context, tcp::endpoint(tcp::v4(), port))
+    , dataProvider(std::move(dataProvider))
+    , work_guard(boost::asio::make_work_guard(io_context))
+{
+}
+
 void TCPDataServer::run(const std::stop_token& stopToken)
 {
     const std::stop_callback stopCallback(stopToken, [this]() { stop(); });
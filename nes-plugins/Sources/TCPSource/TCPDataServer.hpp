@@ -28,17 +28,20 @@
 namespace NES
 {
 
-/// Takes either a vector of strings (representing tuples) or a filepath.
+/// Takes either a vector of strings (representing tuples), a filepath, or a data provider that writes the data to a connection.
 /// On calling 'run', waits for connections and asynchronously serves the tuples (from vector or filepath) once.
 /// After serving the data, the TCPDataServer closes the connection (triggering an end of stream (EOS)).
 class TCPDataServer
 {
     using tcp = boost::asio::ip::tcp;
-    using DataProvider = std::function<void(tcp::socket&)>;
 
 public:
+    using DataProvider = std::function<void(tcp::socket&)>;
+
     explicit TCPDataServer(std::vector<std::string> tuples);
     explicit TCPDataServer(std::filesystem::path filePath);
+    /// Serves the data of the data provider on the given port, or on an ephemeral port if the port is 0
+    explicit TCPDataServer(DataProvider dataProvider, uint16_t port);
 
     TCPDataServer(const TCPDataServer&) = delete;
     TCPDataServer operator=(const TCPDataServer&) = delete;
@@ -0,0 +1,205 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <TCPLoadGenerator.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/write.hpp>
+#include <ErrorHandling.hpp>
+#include <TCPDataServer.hpp>
+#include <scope_guard.hpp>
+
+namespace NES
+{
+
+namespace
+{
+/// Limits the number of tuples that share a send timestamp, if the connection sends as fast as possible or has fallen behind its rate
+constexpr uint64_t MAX_TUPLES_PER_WRITE = 1024;
+constexpr auto PACING_INTERVAL = std::chrono::microseconds(100);
+
+int64_t getSteadyTime()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}
+
+TCPLoadGenerator::TCPLoadGenerator(Configuration configuration) : configuration(std::move(configuration))
+{
+    PRECONDITION(not this->configuration.tuples.empty(), "The load generator requires tuples to replay");
+    PRECONDITION(this->configuration.numberOfConnections > 0, "The load generator requires at least one connection");
+    PRECONDITION(
+        this->configuration.firstPort == 0
+            or this->configuration.firstPort + this->configuration.numberOfConnections - 1 <= std::numeric_limits<uint16_t>::max(),
+        "The ports of {} connections starting at {} exceed the port range",
+        this->configuration.numberOfConnections,
+        this->configuration.firstPort);
+
+    const auto numberOfConnections = this->configuration.numberOfConnections;
+    connections.reserve(numberOfConnections);
+    for (size_t connectionIndex = 0; connectionIndex < numberOfConnections; ++connectionIndex)
+    {
+        auto connection = std::make_unique<Connection>();
+        connection->numberOfTuples = (this->configuration.numberOfTuples / numberOfConnections)
+            + (connectionIndex < this->configuration.numberOfTuples % numberOfConnections ? 1 : 0);
+        const auto port
+            = this->configuration.firstPort == 0 ? uint16_t{0} : static_cast<uint16_t>(this->configuration.firstPort + connectionIndex);
+        connection->server = std::make_unique<TCPDataServer>(
+            [this, connectionPtr = connection.get(), connectionIndex](boost::asio::ip::tcp::socket& socket)
+            { send(*connectionPtr, connectionIndex, socket); },
+            port);
+        connections.push_back(std::move(connection));
+    }
+}
+
+TCPLoadGenerator::~TCPLoadGenerator()
+{
+    stop();
+}
+
+std::vector<uint16_t> TCPLoadGenerator::getPorts() const
+{
+    std::vector<uint16_t> ports;
+    ports.reserve(connections.size());
+    for (const auto& connection : connections)
+    {
+        ports.push_back(connection->server->getPort());
+    }
+    return ports;
+}
+
+void TCPLoadGenerator::start()
+{
+    for (const auto& connection : connections)
+    {
+        connection->thread
+            = std::jthread([server = connection->server.get()](const std::stop_token& stopToken) { server->run(stopToken); });
+    }
+}
+
+void TCPLoadGenerator::waitUntilSent(const std::stop_token& stopToken) const
+{
+    while (not stopToken.stop_requested()
+           and not std::ranges::all_of(connections, [](const auto& connection) { return connection->finished.load(); }))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+void TCPLoadGenerator::stop()
+{
+    stopSource.request_stop();
+    for (const auto& connection : connections)
+    {
+        if (connection->thread.joinable())
+        {
+            connection->thread.request_stop();
+            connection->thread.join();
+        }
+    }
+}
+
+uint64_t TCPLoadGenerator::getNumberOfSentTuples() const
+{
+    uint64_t sentTuples = 0;
+    for (const auto& connection : connections)
+    {
+        sentTuples += connection->sentTuples.load();
+    }
+    return sentTuples;
+}
+
+std::chrono::microseconds TCPLoadGenerator::getSendDuration() const
+{
+    auto firstStart = std::numeric_limits<int64_t>::max();
+    int64_t lastEnd = 0;
+    for (const auto& connection : connections)
+    {
+        if (const auto startTime = connection->startTime.load(); startTime != 0)
+        {
+            firstStart = std::min(firstStart, startTime);
+            lastEnd = std::max(lastEnd, connection->finished.load() ? connection->endTime.load() : getSteadyTime());
+        }
+    }
+    return std::chrono::microseconds(lastEnd > firstStart ? lastEnd - firstStart : 0);
+}
+
+uint64_t TCPLoadGenerator::getTimestamp()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+void TCPLoadGenerator::send(Connection& connection, const size_t connectionIndex, boost::asio::ip::tcp::socket& socket) const
+{
+    /// A failed write closes the connection, which also finishes it
+    SCOPE_EXIT
+    {
+        connection.endTime = getSteadyTime();
+        connection.finished = true;
+    };
+    const auto& tuples = configuration.tuples;
+    const auto numberOfConnections = configuration.numberOfConnections;
+    const auto tuplesPerSecond = static_cast<double>(configuration.tuplesPerSecond) / static_cast<double>(numberOfConnections);
+    const auto startTime = getSteadyTime();
+    connection.startTime = startTime;
+
+    std::string batch;
+    uint64_t sentTuples = 0;
+    const auto stopToken = stopSource.get_token();
+    while (sentTuples < connection.numberOfTuples and not stopToken.stop_requested())
+    {
+        /// The connection sends all tuples that are due at its rate, thus it catches up after the worker applied backpressure
+        auto dueTuples = connection.numberOfTuples;
+        if (configuration.tuplesPerSecond != 0)
+        {
+            const auto elapsedSeconds = static_cast<double>(getSteadyTime() - startTime) / 1e6;
+            dueTuples = std::min(connection.numberOfTuples, static_cast<uint64_t>(elapsedSeconds * tuplesPerSecond) + 1);
+        }
+        if (dueTuples == sentTuples)
+        {
+            std::this_thread::sleep_for(PACING_INTERVAL);
+            continue;
+        }
+        dueTuples = std::min(dueTuples, sentTuples + MAX_TUPLES_PER_WRITE);
+
+        batch.clear();
+        const auto timestamp = std::to_string(getTimestamp());
+        for (; sentTuples < dueTuples; ++sentTuples)
+        {
+            if (configuration.embedSendTimestamp)
+            {
+                batch += timestamp;
+                batch += ',';
+            }
+            batch += tuples[(connectionIndex + (sentTuples * numberOfConnections)) % tuples.size()];
+            batch += '\n';
+        }
+        boost::asio::write(socket, boost::asio::buffer(batch));
+        connection.sentTuples = sentTuples;
+    }
+}
+
+}
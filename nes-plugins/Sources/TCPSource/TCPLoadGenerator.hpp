@@ -0,0 +1,97 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/asio/ip/tcp.hpp>
+#include <TCPDataServer.hpp>
+
+namespace NES
+{
+
+/// Replays tuples over many TCP connections at a controlled total rate, e.g., to find the rate at which a worker configuration saturates.
+/// Every connection is served by its own TCPDataServer and thread. The tuples are assigned round-robin to the connections, i.e.,
+/// connection c sends the tuples c, c + n, c + 2n, ... of the replayed tuples, and each connection sends its share of the total rate.
+/// If the send timestamp is embedded, every tuple is prefixed by the time at which it is sent, in microseconds since the unix epoch,
+/// which lets a SinkLatencyRecorder measure the latency of the tuples, if the query forwards the field to its sink.
+/// As TCP applies backpressure, an achieved rate below the target rate indicates that the worker can not keep up.
+class TCPLoadGenerator
+{
+public:
+    struct Configuration
+    {
+        /// Tuples without their line break, which are replayed until numberOfTuples tuples have been sent
+        std::vector<std::string> tuples;
+        uint64_t numberOfTuples = 0;
+        size_t numberOfConnections = 1;
+        /// The connections listen on the ports firstPort, firstPort + 1, ..., or on ephemeral ports if the first port is 0
+        uint16_t firstPort = 0;
+        /// Total rate over all connections, 0 sends the tuples as fast as possible
+        uint64_t tuplesPerSecond = 0;
+        bool embedSendTimestamp = true;
+    };
+
+    explicit TCPLoadGenerator(Configuration configuration);
+    ~TCPLoadGenerator();
+
+    TCPLoadGenerator(const TCPLoadGenerator&) = delete;
+    TCPLoadGenerator& operator=(const TCPLoadGenerator&) = delete;
+    TCPLoadGenerator(TCPLoadGenerator&&) = delete;
+    TCPLoadGenerator& operator=(TCPLoadGenerator&&) = delete;
+
+    [[nodiscard]] std::vector<uint16_t> getPorts() const;
+
+    /// Starts serving all connections. The first tuple of a connection is sent as soon as a source connects to it.
+    void start();
+    /// Waits until all connections have sent their tuples or until the stop is requested
+    void waitUntilSent(const std::stop_token& stopToken) const;
+    void stop();
+
+    [[nodiscard]] uint64_t getNumberOfSentTuples() const;
+    /// Time from the first connection starting to send until the last connection finished sending
+    [[nodiscard]] std::chrono::microseconds getSendDuration() const;
+
+    /// Returns the current time in microseconds since the unix epoch, as embedded into the tuples
+    static uint64_t getTimestamp();
+
+private:
+    struct Connection
+    {
+        std::unique_ptr<TCPDataServer> server;
+        std::jthread thread;
+        uint64_t numberOfTuples = 0;
+        std::atomic<uint64_t> sentTuples{0};
+        std::atomic<bool> finished{false};
+        std::atomic<int64_t> startTime{0};
+        std::atomic<int64_t> endTime{0};
+    };
+
+    void send(Connection& connection, size_t connectionIndex, boost::asio::ip::tcp::socket& socket) const;
+
+    Configuration configuration;
+    std::vector<std::unique_ptr<Connection>> connections;
+    /// Interrupts the connections that are sending
+    std::stop_source stopSource;
+};
+
+}
@@ -0,0 +1,206 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <argparse/argparse.hpp>
+#include <SinkLatencyRecorder.hpp>
+#include <TCPLoadGenerator.hpp>
+#ifdef NES_TCP_LOAD_GENERATOR_WITH_GENERATOR
+    #include <Generator.hpp>
+#endif
+
+namespace
+{
+std::vector<std::string> readTuples(const std::filesystem::path& file)
+{
+    std::ifstream stream(file);
+    if (not stream.is_open())
+    {
+        throw std::runtime_error("Cannot open the file to replay: " + file.string());
+    }
+    std::vector<std::string> tuples;
+    for (std::string line; std::getline(stream, line);)
+    {
+        if (not line.empty())
+        {
+            tuples.push_back(std::move(line));
+        }
+    }
+    return tuples;
+}
+
+std::vector<std::string> generateTuples([[maybe_unused]] const std::string& schema, [[maybe_unused]] const uint64_t numberOfTuples)
+{
+#ifdef NES_TCP_LOAD_GENERATOR_WITH_GENERATOR
+    NES::Generator generator(0, NES::GeneratorStop::NONE, schema);
+    std::vector<std::string> tuples;
+    tuples.reserve(numberOfTuples);
+    for (uint64_t i = 0; i < numberOfTuples; ++i)
+    {
+        std::ostringstream tuple;
+        generator.generateTuple(tuple);
+        auto line = std::move(tuple).str();
+        line.pop_back();
+        tuples.push_back(std::move(line));
+    }
+    return tuples;
+#else
+    throw std::runtime_error("The load generator was built without the generator source plugin");
+#endif
+}
+
+void printReport(const NES::TCPLoadGenerator& loadGenerator, NES::SinkLatencyRecorder* latencyRecorder)
+{
+    const auto sentTuples = loadGenerator.getNumberOfSentTuples();
+    const auto sendDuration = loadGenerator.getSendDuration();
+    const auto seconds = static_cast<double>(sendDuration.count()) / 1e6;
+    std::cout << "sent tuples: " << sentTuples << '\n';
+    std::cout << "send duration: " << seconds << " s\n";
+    std::cout << "achieved rate: " << (seconds > 0 ? static_cast<double>(sentTuples) / seconds : 0.0) << " tuples/s\n";
+    if (latencyRecorder == nullptr)
+    {
+        return;
+    }
+    std::cout << "received tuples: " << latencyRecorder->getNumberOfRecordedTuples() << '\n';
+    for (const auto& [name, fraction] : std::vector<std::pair<std::string, double>>{
+             {"p50", 0.5}, {"p90", 0.9}, {"p99", 0.99}, {"p99.9", 0.999}, {"max", 1.0}})
+    {
+        std::cout << "latency " << name << ": " << latencyRecorder->getPercentile(fraction).count() << " us\n";
+    }
+}
+}
+
+int main(int argc, char* argv[])
+{
+    argparse::ArgumentParser program(
+        R"(TCP Load Generator.
+Replays the lines of a file, or tuples of a generator schema, over many TCP connections at a controlled total rate.
+Every connection listens on its own port and serves one TCP source (socket_host/socket_port). Unless --no-timestamp is given, every tuple
+is prefixed by its send timestamp in microseconds since the unix epoch, i.e., the logical source requires an additional first UINT64 field.
+If the query forwards the timestamp to a File sink, --sink-file reports the percentiles of the latency until the tuples reach the sink.
+An achieved rate below the target rate shows that the worker applies backpressure, i.e., that the configuration is saturated.
+)",
+        "1.0");
+    program.add_argument("--file").help("file whose lines are replayed");
+    program.add_argument("--generator-schema").help("schema of the generator source, whose tuples are replayed");
+    program.add_argument("--generated-tuples")
+        .help("number of tuples to generate for replay")
+        .default_value(uint64_t{100000})
+        .scan<'u', uint64_t>();
+    program.add_argument("--tuples")
+        .help("total number of tuples to send, 0 replays all tuples once")
+        .default_value(uint64_t{0})
+        .scan<'u', uint64_t>();
+    program.add_argument("--connections")
+        .help("number of TCP connections")
+        .default_value(size_t{1})
+        .scan<'u', size_t>();
+    program.add_argument("--first-port")
+        .help("port of the first connection, 0 uses ephemeral ports")
+        .default_value(uint16_t{0})
+        .scan<'u', uint16_t>();
+    program.add_argument("--rate")
+        .help("total tuples per second, 0 sends as fast as possible")
+        .default_value(uint64_t{0})
+        .scan<'u', uint64_t>();
+    program.add_argument("--no-timestamp").help("do not prefix the tuples with their send timestamp").flag();
+    program.add_argument("--sink-file").help("CSV output of the sink whose latency is measured");
+    program.add_argument("--timestamp-field")
+        .help("index of the send timestamp in the lines of the sink")
+        .default_value(size_t{0})
+        .scan<'u', size_t>();
+    program.add_argument("--drain-timeout-ms")
+        .help("time without new output of the sink after which all tuples count as received")
+        .default_value(uint64_t{1000})
+        .scan<'u', uint64_t>();
+
+    try
+    {
+        program.parse_args(argc, argv);
+
+        NES::TCPLoadGenerator::Configuration configuration;
+        if (const auto file = program.present("--file"))
+        {
+            configuration.tuples = readTuples(*file);
+        }
+        else if (const auto schema = program.present("--generator-schema"))
+        {
+            configuration.tuples = generateTuples(*schema, program.get<uint64_t>("--generated-tuples"));
+        }
+        else
+        {
+            throw std::runtime_error("Either --file or --generator-schema is required");
+        }
+        if (configuration.tuples.empty())
+        {
+            throw std::runtime_error("There are no tuples to replay");
+        }
+        const auto numberOfTuples = program.get<uint64_t>("--tuples");
+        configuration.numberOfTuples = numberOfTuples == 0 ? configuration.tuples.size() : numberOfTuples;
+        configuration.numberOfConnections = program.get<size_t>("--connections");
+        configuration.firstPort = program.get<uint16_t>("--first-port");
+        configuration.tuplesPerSecond = program.get<uint64_t>("--rate");
+        configuration.embedSendTimestamp = not program.get<bool>("--no-timestamp");
+
+        NES::TCPLoadGenerator loadGenerator(std::move(configuration));
+        std::cout << "ports:";
+        for (const auto port : loadGenerator.getPorts())
+        {
+            std::cout << ' ' << port;
+        }
+        std::cout << std::endl;
+
+        std::optional<NES::SinkLatencyRecorder> latencyRecorder;
+        std::stop_source sentAllTuples;
+        std::jthread recorderThread;
+        if (const auto sinkFile = program.present("--sink-file"))
+        {
+            latencyRecorder.emplace(*sinkFile, program.get<size_t>("--timestamp-field"));
+            recorderThread = std::jthread(
+                [&latencyRecorder, &sentAllTuples, idleTimeout = std::chrono::milliseconds(program.get<uint64_t>("--drain-timeout-ms"))](
+                    const std::stop_token& stopToken) { latencyRecorder->run(stopToken, sentAllTuples.get_token(), idleTimeout); });
+        }
+
+        loadGenerator.start();
+        loadGenerator.waitUntilSent(std::stop_token{});
+        sentAllTuples.request_stop();
+        if (recorderThread.joinable())
+        {
+            recorderThread.join();
+        }
+        loadGenerator.stop();
+        printReport(loadGenerator, latencyRecorder.has_value() ? &latencyRecorder.value() : nullptr);
+    }
+    catch (const std::exception& err)
+    {
+        std::cerr << err.what() << '\n';
+        std::cerr << program;
+        return 1;
+    }
+    return 0;
+}
@@ -14,8 +14,10 @@
 
 #include <TCPSource.hpp>
 
+#include <algorithm>
 #include <cerrno> /// For socket error
 #include <chrono>
+#include <cstddef>
 #include <cstring>
 #include <exception>
 #include <memory>
@@ -26,6 +28,7 @@
 #include <unordered_map>
 #include <utility>
 #include <vector>
+#include <sys/epoll.h>
 #include <sys/select.h>
 
 #include <cstdio>
@@ -35,6 +38,7 @@
 #include <Configurations/Descriptor.hpp>
 #include <Runtime/AbstractBufferProvider.hpp>
 #include <Runtime/TupleBuffer.hpp>
+#include <Sources/IoUringReactor.hpp>
 #include <Sources/Source.hpp>
 #include <Sources/SourceDescriptor.hpp>
 #include <Util/Logger/Logger.hpp>
@@ -63,8 +67,16 @@ TCPSource::TCPSource(const SourceDescriptor& sourceDescriptor)
     , bytesUsedForSocketBufferSizeTransfer(sourceDescriptor.getFromConfig(ConfigParametersTCP::SOCKET_BUFFER_TRANSFER_SIZE))
     , flushIntervalInMs(sourceDescriptor.getFromConfig(ConfigParametersTCP::FLUSH_INTERVAL_MS))
     , connectionTimeout(sourceDescriptor.getFromConfig(ConfigParametersTCP::CONNECT_TIMEOUT))
+    , useIoUring(sourceDescriptor.getFromConfig(ConfigParametersTCP::IO_URING))
+    , numberOfConnections(sourceDescriptor.getFromConfig(ConfigParametersTCP::CONNECTIONS))
+    , receiveBufferSize(sourceDescriptor.getFromConfig(ConfigParametersTCP::RECEIVE_BUFFER_SIZE))
+    , busyPollMicroseconds(sourceDescriptor.getFromConfig(ConfigParametersTCP::BUSY_POLL_US))
 {
     NES_TRACE("Init TCPSource.");
+    if (numberOfConnections > 1 and useIoUring)
+    {
+        throw InvalidConfigParameter("The TCPSource does not support io_uring with more than one connection");
+    }
 }
 
 std::ostream& TCPSource::toString(std::ostream& str) const
@@ -82,10 +94,28 @@ std::ostream& TCPSource::toString(std::ostream& str) const
     str << "\n  socketBufferSize: " << socketBufferSize;
     str << "\n  bytesUsedForSocketBufferSizeTransfer" << bytesUsedForSocketBufferSizeTransfer;
     str << "\n  flushIntervalInMs" << flushIntervalInMs;
+    str << "\n  io_uring: " << useIoUring;
+    str << "\n  connections: " << numberOfConnections;
+    str << "\n  receiveBufferSize: " << receiveBufferSize;
+    str << "\n  busyPollMicroseconds: " << busyPollMicroseconds;
     str << ")\n";
     return str;
 }
 
+void TCPSource::configureSocket() const
+{
+    /// The receive buffer must be set before connecting, as the kernel negotiates the window scaling during the handshake
+    if (receiveBufferSize > 0 and setsockopt(sockfd, SOL_SOCKET, SO_RCVBUF, &receiveBufferSize, sizeof(receiveBufferSize)) != 0)
+    {
+        NES_WARNING("TCPSource could not set the receive buffer size to {}: {}", receiveBufferSize, strerror(errno));
+    }
+    if (busyPollMicroseconds > 0
+        and setsockopt(sockfd, SOL_SOCKET, SO_BUSY_POLL, &busyPollMicroseconds, sizeof(busyPollMicroseconds)) != 0)
+    {
+        NES_WARNING("TCPSource could not enable busy polling for {}us: {}", busyPollMicroseconds, strerror(errno));
+    }
+}
+
 bool TCPSource::tryToConnect(const addrinfo* result, const int flags)
 {
     const std::chrono::seconds socketConnectDefaultTimeout{connectionTimeout};
@@ -108,6 +138,7 @@ bool TCPSource::tryToConnect(const addrinfo* result, const int flags)
         NES_ERROR("No valid address found to create socket.");
         return false;
     }
+    configureSocket();
 
     /// NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg, hicpp-signed-bitwise) - POSIX API requires varargs
     fcntl(sockfd, F_SETFL, flags | O_NONBLOCK);
@@ -187,6 +218,13 @@ void TCPSource::open(std::shared_ptr<AbstractBufferProvider>)
 
     const int flags = fcntl(sockfd, F_GETFL, 0);
 
+    if (numberOfConnections > 1)
+    {
+        openParallelConnections(result, flags);
+        NES_TRACE("TCPSource::open: Connected to server with {} connections.", numberOfConnections);
+        return;
+    }
+
     CPPTRACE_TRY
     {
         tryToConnect(result, flags);
@@ -200,15 +238,156 @@ void TCPSource::open(std::shared_ptr<AbstractBufferProvider>)
     /// Set connection to non-blocking again to enable a timeout in the 'read()' call
     fcntl(sockfd, F_SETFL, flags); /// NOLINT(cppcoreguidelines-pro-type-vararg) - POSIX API requires varargs
 
+    if (useIoUring)
+    {
+        ioUringReactor = IoUringReactor::getShared();
+    }
     NES_TRACE("TCPSource::open: Connected to server.");
 }
 
-Source::FillTupleBufferResult TCPSource::fillTupleBuffer(TupleBuffer& tupleBuffer, const std::stop_token&)
+void TCPSource::openParallelConnections(const addrinfo* result, const int flags)
+{
+    epollDescriptor = epoll_create1(EPOLL_CLOEXEC);
+    if (epollDescriptor < 0)
+    {
+        const auto strerrorResult = strerror_r(errno, errBuffer.data(), errBuffer.size());
+        throw CannotOpenSource("Could not create an epoll instance for {}:{}. {}", socketHost, socketPort, strerrorResult);
+    }
+    parallelConnections.resize(numberOfConnections);
+    for (size_t index = 0; index < parallelConnections.size(); ++index)
+    {
+        CPPTRACE_TRY
+        {
+            tryToConnect(result, flags);
+        }
+        CPPTRACE_CATCH(...)
+        {
+            close();
+            throw wrapExternalException("Could not establich connection!");
+        }
+        /// Edge-triggered epoll requires non-blocking sockets, which the source reads until they would block
+        fcntl(sockfd, F_SETFL, fcntl(sockfd, F_GETFL, 0) | O_NONBLOCK); /// NOLINT(cppcoreguidelines-pro-type-vararg)
+        parallelConnections[index].socket = sockfd;
+        epoll_event event{.events = EPOLLIN | EPOLLRDHUP | EPOLLET, .data = {.u64 = index}};
+        if (epoll_ctl(epollDescriptor, EPOLL_CTL_ADD, sockfd, &event) != 0)
+        {
+            const auto strerrorResult = strerror_r(errno, errBuffer.data(), errBuffer.size());
+            close();
+            throw CannotOpenSource(
+                "Could not register connection {} to {}:{} with epoll. {}", index, socketHost, socketPort, strerrorResult);
+        }
+    }
+}
+
+size_t TCPSource::fillBufferFromConnection(ParallelConnection& parallelConnection, TupleBuffer& tupleBuffer) const
+{
+    const auto buffer = tupleBuffer.getAvailableMemoryArea().first(tupleBuffer.getBufferSize());
+    auto& partialTuple = parallelConnection.partialTuple;
+    if (partialTuple.size() >= buffer.size())
+    {
+        throw CannotOpenSource("A tuple received from {}:{} exceeds the size of a tuple buffer", socketHost, socketPort);
+    }
+    std::ranges::copy(partialTuple, buffer.begin());
+    size_t numReceivedBytes = partialTuple.size();
+    partialTuple.clear();
+
+    while (numReceivedBytes < buffer.size())
+    {
+        const auto received = ::recv(parallelConnection.socket, buffer.data() + numReceivedBytes, buffer.size() - numReceivedBytes, 0);
+        if (received > 0)
+        {
+            numReceivedBytes += static_cast<size_t>(received);
+            continue;
+        }
+        if (received == EOF_RECEIVED_BUFFER_SIZE)
+        {
+            parallelConnection.reachedEoS = true;
+            break;
+        }
+        if (errno == EINTR)
+        {
+            continue;
+        }
+        if (errno == EAGAIN or errno == EWOULDBLOCK)
+        {
+            parallelConnection.readable = false;
+            break;
+        }
+        throw CannotOpenSource("An error occurred while reading from {}:{}. Error: {}", socketHost, socketPort, strerror(errno));
+    }
+
+    /// The last tuple of a stream does not need to end with a delimiter
+    const auto receivedBytes = buffer.first(numReceivedBytes);
+    if (parallelConnection.reachedEoS)
+    {
+        return numReceivedBytes;
+    }
+    const auto lastDelimiter = std::find(receivedBytes.rbegin(), receivedBytes.rend(), static_cast<std::byte>(tupleDelimiter));
+    const auto numberOfCompleteBytes = static_cast<size_t>(receivedBytes.rend() - lastDelimiter);
+    partialTuple.assign(receivedBytes.begin() + static_cast<std::ptrdiff_t>(numberOfCompleteBytes), receivedBytes.end());
+    return numberOfCompleteBytes;
+}
+
+Source::FillTupleBufferResult TCPSource::fillBufferFromParallelConnections(TupleBuffer& tupleBuffer, const std::stop_token& stopToken)
+{
+    std::vector<epoll_event> events(parallelConnections.size());
+    while (not stopToken.stop_requested())
+    {
+        /// Continues after the connection that filled the previous buffer, so that a busy connection does not starve the others
+        bool anyConnectionIsOpen = false;
+        for (size_t attempt = 0; attempt < parallelConnections.size(); ++attempt)
+        {
+            auto& parallelConnection = parallelConnections[nextParallelConnection];
+            nextParallelConnection = (nextParallelConnection + 1) % parallelConnections.size();
+            if (parallelConnection.reachedEoS)
+            {
+                continue;
+            }
+            anyConnectionIsOpen = true;
+            if (not parallelConnection.readable)
+            {
+                continue;
+            }
+            if (const auto numReceivedBytes = fillBufferFromConnection(parallelConnection, tupleBuffer); numReceivedBytes > 0)
+            {
+                ++generatedBuffers;
+                return FillTupleBufferResult::withBytes(numReceivedBytes);
+            }
+        }
+        if (not anyConnectionIsOpen)
+        {
+            NES_INFO("TCP Source detected EoS on all {} connections", parallelConnections.size());
+            return FillTupleBufferResult::eos();
+        }
+
+        const auto numberOfEvents = epoll_wait(epollDescriptor, events.data(), static_cast<int>(events.size()), EPOLL_TIMEOUT_MS);
+        if (numberOfEvents < 0 and errno != EINTR)
+        {
+            throw CannotOpenSource("Could not wait for the connections to {}:{}. Error: {}", socketHost, socketPort, strerror(errno));
+        }
+        for (int event = 0; event < numberOfEvents; ++event)
+        {
+            parallelConnections[events[event].data.u64].readable = true;
+        }
+    }
+    return FillTupleBufferResult::eos();
+}
+
+Source::FillTupleBufferResult TCPSource::fillTupleBuffer(TupleBuffer& tupleBuffer, const std::stop_token& stopToken)
 {
     try
     {
+        if (not parallelConnections.empty())
+        {
+            return fillBufferFromParallelConnections(tupleBuffer, stopToken);
+        }
         size_t numReceivedBytes = 0;
-        while (fillBuffer(tupleBuffer, numReceivedBytes))
+        const auto fill = [&]
+        {
+            return ioUringReactor ? fillBufferViaIoUring(tupleBuffer, numReceivedBytes, stopToken)
+                                  : fillBuffer(tupleBuffer, numReceivedBytes);
+        };
+        while (fill())
         {
             /// Fill the buffer until EoS reached or the number of tuples in the buffer is not equals to 0.
         };
@@ -271,6 +450,72 @@ bool TCPSource::fillBuffer(TupleBuffer& tupleBuffer, size_t& numReceivedBytes)
     return numReceivedBytes == 0 and readWasValid;
 }
 
+bool TCPSource::fillBufferViaIoUring(TupleBuffer& tupleBuffer, size_t& numReceivedBytes, const std::stop_token& stopToken)
+{
+    const auto flushIntervalTimerStart = std::chrono::steady_clock::now();
+    const auto flushInterval
+        = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::duration<float, std::milli>{flushIntervalInMs});
+    /// Same semantics as the SO_RCVTIMEO of the blocking read: a receive that takes longer than the connection timeout is an error
+    const std::chrono::milliseconds receiveTimeout = std::chrono::seconds{connectionTimeout} + std::chrono::milliseconds{1};
+    bool readWasValid = true;
+
+    const auto buffer = tupleBuffer.getAvailableMemoryArea().first(tupleBuffer.getBufferSize());
+    while (numReceivedBytes < buffer.size())
+    {
+        auto timeout = receiveTimeout;
+        if (flushIntervalInMs > 0)
+        {
+            const auto elapsed
+                = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - flushIntervalTimerStart);
+            if (elapsed >= flushInterval)
+            {
+                NES_DEBUG("Reached TupleBuffer flush interval. Finishing writing to current TupleBuffer.");
+                break;
+            }
+            timeout = std::min(timeout, std::max(flushInterval - elapsed, std::chrono::milliseconds{1}));
+        }
+
+        const auto bufferSizeReceived = ioUringReactor->read(sockfd, buffer.subspan(numReceivedBytes), 0, timeout, stopToken);
+        if (not bufferSizeReceived.has_value())
+        {
+            /// The reactor cancelled the receive, because a stop was requested, the flush interval passed, or the receive timed out
+            if (stopToken.stop_requested())
+            {
+                readWasValid = false;
+                break;
+            }
+            if (flushIntervalInMs > 0 and timeout < receiveTimeout)
+            {
+                continue;
+            }
+            NES_ERROR("An error occurred while reading from socket. Error: {}", strerror(ETIMEDOUT));
+            readWasValid = false;
+            numReceivedBytes = 0;
+            break;
+        }
+        if (bufferSizeReceived.value() < 0)
+        {
+            NES_ERROR("An error occurred while reading from socket. Error: {}", strerror(static_cast<int>(-bufferSizeReceived.value())));
+            readWasValid = false;
+            numReceivedBytes = 0;
+            break;
+        }
+        if (bufferSizeReceived.value() == EOF_RECEIVED_BUFFER_SIZE)
+        {
+            NES_TRACE("No data received from {}:{}.", socketHost, socketPort);
+            if (numReceivedBytes == 0)
+            {
+                NES_INFO("TCP Source detected EoS");
+                readWasValid = false;
+            }
+            break;
+        }
+        numReceivedBytes += static_cast<size_t>(bufferSizeReceived.value());
+    }
+    ++generatedBuffers;
+    return numReceivedBytes == 0 and readWasValid;
+}
+
 DescriptorConfig::Config TCPSource::validateAndFormat(std::unordered_map<std::string, std::string> config)
 {
     return DescriptorConfig::validateAndFormat<ConfigParametersTCP>(std::move(config), name());
@@ -279,11 +524,26 @@ DescriptorConfig::Config TCPSource::validateAndFormat(std::unordered_map<std::st
 void TCPSource::close()
 {
     NES_DEBUG("Trying to close connection.");
+    /// The last parallel connection is the current socket, which the source closes below
+    for (const auto& parallelConnection : parallelConnections)
+    {
+        if (parallelConnection.socket >= 0 and parallelConnection.socket != sockfd)
+        {
+            ::close(parallelConnection.socket);
+        }
+    }
+    parallelConnections.clear();
+    if (epollDescriptor >= 0)
+    {
+        ::close(epollDescriptor);
+        epollDescriptor = -1;
+    }
     if (connection >= 0)
     {
         ::close(sockfd);
         NES_TRACE("Connection closed.");
     }
+    ioUringReactor.reset();
 }
 
 SourceValidationRegistryReturnType RegisterTCPSourceValidation(SourceValidationRegistryArguments sourceConfig)
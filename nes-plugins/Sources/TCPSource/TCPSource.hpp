@@ -25,11 +25,13 @@
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 #include <netdb.h>
 #include <Configurations/Descriptor.hpp>
 #include <Configurations/Enums/EnumWrapper.hpp>
 #include <Runtime/AbstractBufferProvider.hpp>
 #include <Runtime/TupleBuffer.hpp>
+#include <Sources/IoUringReactor.hpp>
 #include <Sources/Source.hpp>
 #include <Sources/SourceDescriptor.hpp>
 #include <Util/Logger/Logger.hpp>
@@ -139,6 +141,40 @@ struct ConfigParametersTCP
         "connect_timeout_seconds",
         10,
         [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(CONNECT_TIMEOUT, config); }};
+    /// Receives via the io_uring reactor that all sources share (see IoUringReactor), instead of blocking in read()
+    static inline const DescriptorConfig::ConfigParameter<bool> IO_URING{
+        "io_uring",
+        false,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(IO_URING, config); }};
+
+    /// Number of parallel connections to the server. With more than one connection, the source waits for all of them via edge-triggered
+    /// epoll and fills every tuple buffer from a single connection, up to the last tuple delimiter. It keeps the partial tuple at the end
+    /// for the next buffer of the connection, so that the buffers of different connections can interleave.
+    static inline const DescriptorConfig::ConfigParameter<uint32_t> CONNECTIONS{
+        "socket_connections",
+        1,
+        [](const std::unordered_map<std::string, std::string>& config) -> std::optional<uint32_t>
+        {
+            const auto connections = DescriptorConfig::tryGet(CONNECTIONS, config);
+            if (connections.has_value() and connections.value() == 0)
+            {
+                NES_ERROR("TCPSource: socket_connections must be at least 1");
+                return std::nullopt;
+            }
+            return connections;
+        }};
+    /// Size of the kernel receive buffer of each connection (SO_RCVBUF). Fast links need a receive buffer of at least their
+    /// bandwidth-delay product. Zero keeps the (auto-tuned) default of the kernel.
+    static inline const DescriptorConfig::ConfigParameter<uint32_t> RECEIVE_BUFFER_SIZE{
+        "socket_receive_buffer_size",
+        0,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(RECEIVE_BUFFER_SIZE, config); }};
+    /// Microseconds that a receive busy polls the device queue for new packets, instead of waiting for the interrupt (SO_BUSY_POLL).
+    /// Zero disables busy polling.
+    static inline const DescriptorConfig::ConfigParameter<uint32_t> BUSY_POLL_US{
+        "socket_busy_poll_us",
+        0,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(BUSY_POLL_US, config); }};
 
     static inline std::unordered_map<std::string, DescriptorConfig::ConfigParameterContainer> parameterMap
         = DescriptorConfig::createConfigParameterContainerMap(
@@ -151,7 +187,11 @@ struct ConfigParametersTCP
             FLUSH_INTERVAL_MS,
             SOCKET_BUFFER_SIZE,
             SOCKET_BUFFER_TRANSFER_SIZE,
-            CONNECT_TIMEOUT);
+            CONNECT_TIMEOUT,
+            IO_URING,
+            CONNECTIONS,
+            RECEIVE_BUFFER_SIZE,
+            BUSY_POLL_US);
 };
 
 class TCPSource : public Source
@@ -163,6 +203,8 @@ class TCPSource : public Source
     /// (https://linux.die.net/man/7/socket)
     constexpr static suseconds_t IMPLICIT_TIMEOUT_USEC = 1;
     constexpr static size_t ERROR_MESSAGE_BUFFER_SIZE = 256;
+    /// How long the source waits for events of its parallel connections, before it checks whether a stop was requested
+    constexpr static int EPOLL_TIMEOUT_MS = 100;
 
 public:
     static const std::string& name()
@@ -193,6 +235,25 @@ public:
 private:
     bool tryToConnect(const addrinfo* result, int flags);
     bool fillBuffer(TupleBuffer& tupleBuffer, size_t& numReceivedBytes);
+    bool fillBufferViaIoUring(TupleBuffer& tupleBuffer, size_t& numReceivedBytes, const std::stop_token& stopToken);
+    /// Applies the kernel buffer and busy polling options to a new socket
+    void configureSocket() const;
+
+    /// A connection of a source with more than one connection (see ConfigParametersTCP::CONNECTIONS)
+    struct ParallelConnection
+    {
+        int socket = -1;
+        /// Edge-triggered epoll only reports new data, thus the source reads a connection until it would block
+        bool readable = true;
+        bool reachedEoS = false;
+        /// The bytes after the last tuple delimiter of the previous buffer of the connection
+        std::vector<std::byte> partialTuple;
+    };
+
+    void openParallelConnections(const addrinfo* result, int flags);
+    FillTupleBufferResult fillBufferFromParallelConnections(TupleBuffer& tupleBuffer, const std::stop_token& stopToken);
+    /// Fills the buffer from the connection, up to (and including) the last tuple delimiter. Returns the number of bytes in the buffer.
+    size_t fillBufferFromConnection(ParallelConnection& parallelConnection, TupleBuffer& tupleBuffer) const;
 
     int connection = -1;
     int sockfd = -1;
@@ -211,6 +272,14 @@ private:
     uint64_t generatedTuples{0};
     uint64_t generatedBuffers{0};
     u_int32_t connectionTimeout;
+    bool useIoUring;
+    std::shared_ptr<IoUringReactor> ioUringReactor;
+    uint32_t numberOfConnections;
+    uint32_t receiveBufferSize;
+    uint32_t busyPollMicroseconds;
+    std::vector<ParallelConnection> parallelConnections;
+    size_t nextParallelConnection = 0;
+    int epollDescriptor = -1;
 };
 
 }
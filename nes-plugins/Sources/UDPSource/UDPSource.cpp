@@ -0,0 +1,296 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <UDPSource.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <Configurations/Descriptor.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sources/Source.hpp>
+#include <Sources/SourceDescriptor.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <ErrorHandling.hpp>
+#include <SourceRegistry.hpp>
+#include <SourceValidationRegistry.hpp>
+#include <net/if.h>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace NES
+{
+
+UDPSource::UDPSource(const SourceDescriptor& sourceDescriptor)
+    : host(sourceDescriptor.getFromConfig(ConfigParametersUDP::HOST))
+    , port(sourceDescriptor.getFromConfig(ConfigParametersUDP::PORT))
+    , multicastGroup(sourceDescriptor.getFromConfig(ConfigParametersUDP::MULTICAST_GROUP))
+    , multicastInterface(sourceDescriptor.getFromConfig(ConfigParametersUDP::MULTICAST_INTERFACE))
+    , reusePort(sourceDescriptor.getFromConfig(ConfigParametersUDP::REUSE_PORT))
+    , maxDatagramSize(sourceDescriptor.getFromConfig(ConfigParametersUDP::MAX_DATAGRAM_SIZE))
+    , batchSize(sourceDescriptor.getFromConfig(ConfigParametersUDP::BATCH_SIZE))
+    , tupleDelimiter(sourceDescriptor.getFromConfig(ConfigParametersUDP::SEPARATOR))
+    , receiveBufferSize(sourceDescriptor.getFromConfig(ConfigParametersUDP::RECEIVE_BUFFER_SIZE))
+    , messages(batchSize)
+    , slots(batchSize)
+{
+}
+
+UDPSource::~UDPSource()
+{
+    close();
+}
+
+std::ostream& UDPSource::toString(std::ostream& str) const
+{
+    str << "\nUDPSource(";
+    str << "\n  host: " << host;
+    str << "\n  port: " << port;
+    str << "\n  multicast group: " << multicastGroup;
+    str << "\n  received datagrams: " << receivedDatagrams;
+    str << "\n  truncated datagrams: " << truncatedDatagrams;
+    str << ")\n";
+    return str;
+}
+
+void UDPSource::open(std::shared_ptr<AbstractBufferProvider>)
+{
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    hints.ai_flags = AI_PASSIVE;
+    addrinfo* result = nullptr;
+    const auto portString = std::to_string(port);
+    if (const auto errorCode = getaddrinfo(host.c_str(), portString.c_str(), &hints, &result); errorCode != 0)
+    {
+        throw CannotOpenSource("Could not resolve {}:{}: {}", host, port, gai_strerror(errorCode));
+    }
+    const std::unique_ptr<addrinfo, decltype(&freeaddrinfo)> resultGuard(result, freeaddrinfo);
+
+    int lastError = 0;
+    for (const auto* address = result; address != nullptr; address = address->ai_next)
+    {
+        const int candidate = ::socket(address->ai_family, address->ai_socktype | SOCK_CLOEXEC, address->ai_protocol);
+        if (candidate < 0)
+        {
+            lastError = errno;
+            continue;
+        }
+        constexpr int enabled = 1;
+        /// Other receivers of the multicast group on this host may bind to the same port
+        if (not multicastGroup.empty())
+        {
+            setsockopt(candidate, SOL_SOCKET, SO_REUSEADDR, &enabled, sizeof(enabled));
+        }
+        if (reusePort)
+        {
+            setsockopt(candidate, SOL_SOCKET, SO_REUSEPORT, &enabled, sizeof(enabled));
+        }
+        if (receiveBufferSize > 0)
+        {
+            setsockopt(candidate, SOL_SOCKET, SO_RCVBUF, &receiveBufferSize, sizeof(receiveBufferSize));
+        }
+        if (::bind(candidate, address->ai_addr, address->ai_addrlen) == 0)
+        {
+            socket = candidate;
+            if (not multicastGroup.empty())
+            {
+                joinMulticastGroup(address->ai_family);
+            }
+            NES_DEBUG("UDPSource receives on {}:{}", host, port);
+            return;
+        }
+        lastError = errno;
+        ::close(candidate);
+    }
+    throw CannotOpenSource("Could not bind to {}:{}: {}", host, port, std::strerror(lastError));
+}
+
+void UDPSource::joinMulticastGroup(const int addressFamily) const
+{
+    addrinfo hints{};
+    hints.ai_family = addressFamily;
+    hints.ai_socktype = SOCK_DGRAM;
+    hints.ai_flags = AI_NUMERICHOST;
+    addrinfo* result = nullptr;
+    if (const auto errorCode = getaddrinfo(multicastGroup.c_str(), nullptr, &hints, &result); errorCode != 0)
+    {
+        throw CannotOpenSource("Could not resolve the multicast group {}: {}", multicastGroup, gai_strerror(errorCode));
+    }
+    const std::unique_ptr<addrinfo, decltype(&freeaddrinfo)> resultGuard(result, freeaddrinfo);
+
+    const auto interfaceIndex = multicastInterface.empty() ? 0 : if_nametoindex(multicastInterface.c_str());
+    if (not multicastInterface.empty() and interfaceIndex == 0)
+    {
+        throw CannotOpenSource("Unknown network interface {}: {}", multicastInterface, std::strerror(errno));
+    }
+
+    int joined = -1;
+    if (addressFamily == AF_INET)
+    {
+        ip_mreqn request{};
+        request.imr_multiaddr = reinterpret_cast<const sockaddr_in*>(result->ai_addr)->sin_addr; /// NOLINT
+        request.imr_address.s_addr = htonl(INADDR_ANY);
+        request.imr_ifindex = static_cast<int>(interfaceIndex);
+        joined = setsockopt(socket, IPPROTO_IP, IP_ADD_MEMBERSHIP, &request, sizeof(request));
+    }
+    else
+    {
+        ipv6_mreq request{};
+        request.ipv6mr_multiaddr = reinterpret_cast<const sockaddr_in6*>(result->ai_addr)->sin6_addr; /// NOLINT
+        request.ipv6mr_interface = interfaceIndex;
+        joined = setsockopt(socket, IPPROTO_IPV6, IPV6_JOIN_GROUP, &request, sizeof(request));
+    }
+    if (joined != 0)
+    {
+        throw CannotOpenSource("Could not join the multicast group {}: {}", multicastGroup, std::strerror(errno));
+    }
+    NES_DEBUG("UDPSource joined the multicast group {}", multicastGroup);
+}
+
+bool UDPSource::waitUntilReadable(const std::stop_token& stopToken) const
+{
+    pollfd pollDescriptor{.fd = socket, .events = POLLIN, .revents = 0};
+    while (not stopToken.stop_requested())
+    {
+        const auto ready = ::poll(&pollDescriptor, 1, static_cast<int>(POLL_INTERVAL.count()));
+        if (ready > 0)
+        {
+            return true;
+        }
+        if (ready < 0 and errno != EINTR)
+        {
+            throw CannotOpenSource("Could not poll the socket: {}", std::strerror(errno));
+        }
+    }
+    return false;
+}
+
+size_t UDPSource::receiveBatch(const std::span<std::byte> buffer, const size_t numberOfBytes)
+{
+    /// Each slot keeps one byte for the tuple delimiter after the datagram
+    const auto slotSize = maxDatagramSize + 1;
+    const auto numberOfSlots = std::min(batchSize, (buffer.size() - numberOfBytes) / slotSize);
+    if (numberOfSlots == 0)
+    {
+        return numberOfBytes;
+    }
+    for (size_t slot = 0; slot < numberOfSlots; ++slot)
+    {
+        slots[slot] = iovec{.iov_base = buffer.data() + numberOfBytes + (slot * slotSize), .iov_len = maxDatagramSize};
+        messages[slot] = mmsghdr{};
+        messages[slot].msg_hdr.msg_iov = &slots[slot];
+        messages[slot].msg_hdr.msg_iovlen = 1;
+    }
+
+    const auto received = ::recvmmsg(socket, messages.data(), static_cast<unsigned int>(numberOfSlots), MSG_DONTWAIT, nullptr);
+    if (received < 0)
+    {
+        if (errno == EAGAIN or errno == EWOULDBLOCK or errno == EINTR)
+        {
+            return numberOfBytes;
+        }
+        throw CannotOpenSource("Could not receive from {}:{}: {}", host, port, std::strerror(errno));
+    }
+
+    /// Moves the datagrams next to each other. A datagram never moves behind its slot, thus it never overwrites the next datagram.
+    auto end = numberOfBytes;
+    for (int message = 0; message < received; ++message)
+    {
+        ++receivedDatagrams;
+        const auto datagramSize = static_cast<size_t>(messages[message].msg_len);
+        if ((messages[message].msg_hdr.msg_flags & MSG_TRUNC) != 0)
+        {
+            ++truncatedDatagrams;
+            NES_WARNING("UDPSource on {}:{} dropped a datagram that exceeds the max_datagram_size of {}", host, port, maxDatagramSize);
+            continue;
+        }
+        if (datagramSize == 0)
+        {
+            continue;
+        }
+        std::memmove(buffer.data() + end, slots[message].iov_base, datagramSize);
+        end += datagramSize;
+        if (std::to_integer<char>(buffer[end - 1]) != tupleDelimiter)
+        {
+            buffer[end++] = static_cast<std::byte>(tupleDelimiter);
+        }
+    }
+    return end;
+}
+
+Source::FillTupleBufferResult UDPSource::fillTupleBuffer(TupleBuffer& tupleBuffer, const std::stop_token& stopToken)
+{
+    const auto buffer = tupleBuffer.getAvailableMemoryArea().first(tupleBuffer.getBufferSize());
+    if (buffer.size() <= maxDatagramSize)
+    {
+        throw CannotOpenSource(
+            "The tuple buffers of {} bytes cannot hold a datagram of the max_datagram_size of {} bytes", buffer.size(), maxDatagramSize);
+    }
+
+    size_t numberOfBytes = 0;
+    while (numberOfBytes == 0)
+    {
+        if (not waitUntilReadable(stopToken))
+        {
+            return FillTupleBufferResult::eos();
+        }
+        numberOfBytes = receiveBatch(buffer, 0);
+    }
+    /// Adds the datagrams that are available right away, but does not wait for more, as a datagram stream may pause at any time
+    for (auto filledBytes = receiveBatch(buffer, numberOfBytes); filledBytes != numberOfBytes;
+         filledBytes = receiveBatch(buffer, numberOfBytes))
+    {
+        numberOfBytes = filledBytes;
+    }
+    return FillTupleBufferResult::withBytes(numberOfBytes);
+}
+
+void UDPSource::close()
+{
+    if (socket >= 0)
+    {
+        ::close(socket);
+        socket = -1;
+    }
+}
+
+DescriptorConfig::Config UDPSource::validateAndFormat(std::unordered_map<std::string, std::string> config)
+{
+    return DescriptorConfig::validateAndFormat<ConfigParametersUDP>(std::move(config), name());
+}
+
+SourceValidationRegistryReturnType RegisterUDPSourceValidation(SourceValidationRegistryArguments sourceConfig)
+{
+    return UDPSource::validateAndFormat(std::move(sourceConfig.config));
+}
+
+SourceRegistryReturnType SourceGeneratedRegistrar::RegisterUDPSource(SourceRegistryArguments sourceRegistryArguments)
+{
+    return std::make_unique<UDPSource>(sourceRegistryArguments.sourceDescriptor);
+}
+
+}
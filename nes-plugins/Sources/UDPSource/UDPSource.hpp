@@ -0,0 +1,192 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <Configurations/Descriptor.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sources/Source.hpp>
+#include <Sources/SourceDescriptor.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <sys/socket.h>
+
+namespace NES
+{
+
+struct ConfigParametersUDP
+{
+    /// The local address that the source binds to
+    static inline const DescriptorConfig::ConfigParameter<std::string> HOST{
+        "socket_host",
+        "0.0.0.0",
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(HOST, config); }};
+    static inline const DescriptorConfig::ConfigParameter<uint32_t> PORT{
+        "socket_port",
+        std::nullopt,
+        [](const std::unordered_map<std::string, std::string>& config) -> std::optional<uint32_t>
+        {
+            constexpr uint32_t PORT_NUMBER_MAX = 65535;
+            const auto portNumber = DescriptorConfig::tryGet(PORT, config);
+            if (portNumber.has_value() and portNumber.value() > PORT_NUMBER_MAX)
+            {
+                NES_ERROR("UDPSource specified port is: {}, but ports must be between 0 and {}", portNumber.value(), PORT_NUMBER_MAX);
+                return std::nullopt;
+            }
+            return portNumber;
+        }};
+    /// The multicast group that the source joins, e.g., 239.1.1.1 or ff02::1:3. Empty receives unicast datagrams only.
+    static inline const DescriptorConfig::ConfigParameter<std::string> MULTICAST_GROUP{
+        "multicast_group",
+        "",
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(MULTICAST_GROUP, config); }};
+    /// The name of the network interface, e.g., eth0, on which the source joins the multicast group. Empty lets the kernel choose.
+    static inline const DescriptorConfig::ConfigParameter<std::string> MULTICAST_INTERFACE{
+        "multicast_interface",
+        "",
+        [](const std::unordered_map<std::string, std::string>& config)
+        { return DescriptorConfig::tryGet(MULTICAST_INTERFACE, config); }};
+    /// Lets several sources bind to the same address (SO_REUSEPORT). The kernel shards the unicast datagrams among them by the address of
+    /// their sender, but delivers every multicast datagram to each of them.
+    static inline const DescriptorConfig::ConfigParameter<bool> REUSE_PORT{
+        "socket_reuse_port",
+        false,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(REUSE_PORT, config); }};
+    /// Datagrams that exceed the size are truncated by the kernel, thus the source drops them
+    static inline const DescriptorConfig::ConfigParameter<uint32_t> MAX_DATAGRAM_SIZE{
+        "max_datagram_size",
+        1472,
+        [](const std::unordered_map<std::string, std::string>& config) -> std::optional<uint32_t>
+        {
+            const auto maxDatagramSize = DescriptorConfig::tryGet(MAX_DATAGRAM_SIZE, config);
+            if (maxDatagramSize.has_value() and maxDatagramSize.value() == 0)
+            {
+                NES_ERROR("UDPSource: max_datagram_size must be at least 1");
+                return std::nullopt;
+            }
+            return maxDatagramSize;
+        }};
+    /// Maximum number of datagrams that one recvmmsg() receives
+    static inline const DescriptorConfig::ConfigParameter<uint32_t> BATCH_SIZE{
+        "batch_size",
+        64,
+        [](const std::unordered_map<std::string, std::string>& config) -> std::optional<uint32_t>
+        {
+            const auto batchSize = DescriptorConfig::tryGet(BATCH_SIZE, config);
+            if (batchSize.has_value() and batchSize.value() == 0)
+            {
+                NES_ERROR("UDPSource: batch_size must be at least 1");
+                return std::nullopt;
+            }
+            return batchSize;
+        }};
+    /// Appended to every datagram that does not end with it, so that the formatter reads each datagram as (at least) one record
+    static inline const DescriptorConfig::ConfigParameter<char> SEPARATOR{
+        "tuple_delimiter",
+        '\n',
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(SEPARATOR, config); }};
+    /// Size of the kernel receive buffer (SO_RCVBUF). The kernel drops datagrams, while the buffer is full. Zero keeps the default.
+    static inline const DescriptorConfig::ConfigParameter<uint32_t> RECEIVE_BUFFER_SIZE{
+        "socket_receive_buffer_size",
+        0,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(RECEIVE_BUFFER_SIZE, config); }};
+
+    static inline std::unordered_map<std::string, DescriptorConfig::ConfigParameterContainer> parameterMap
+        = DescriptorConfig::createConfigParameterContainerMap(
+            SourceDescriptor::parameterMap,
+            HOST,
+            PORT,
+            MULTICAST_GROUP,
+            MULTICAST_INTERFACE,
+            REUSE_PORT,
+            MAX_DATAGRAM_SIZE,
+            BATCH_SIZE,
+            SEPARATOR,
+            RECEIVE_BUFFER_SIZE);
+};
+
+/// Receives UDP datagrams, e.g., of market data or sensor feeds, and optionally joins a multicast group. The source receives a batch of
+/// datagrams per recvmmsg() directly into its tuple buffer, in slots of max_datagram_size bytes, and then moves the datagrams next to
+/// each other. Every datagram ends with the tuple delimiter, thus a record never spans two datagrams or two tuple buffers.
+/// A datagram stream has no end, thus the source only ends on a stop.
+class UDPSource : public Source
+{
+public:
+    static const std::string& name()
+    {
+        static const std::string Instance = "UDP";
+        return Instance;
+    }
+
+    explicit UDPSource(const SourceDescriptor& sourceDescriptor);
+    ~UDPSource() override;
+
+    UDPSource(const UDPSource&) = delete;
+    UDPSource& operator=(const UDPSource&) = delete;
+    UDPSource(UDPSource&&) = delete;
+    UDPSource& operator=(UDPSource&&) = delete;
+
+    FillTupleBufferResult fillTupleBuffer(TupleBuffer& tupleBuffer, const std::stop_token& stopToken) override;
+
+    /// Binds the socket and joins the multicast group
+    void open(std::shared_ptr<AbstractBufferProvider> bufferProvider) override;
+    void close() override;
+
+    static DescriptorConfig::Config validateAndFormat(std::unordered_map<std::string, std::string> config);
+
+    [[nodiscard]] std::ostream& toString(std::ostream& str) const override;
+
+private:
+    /// How long the source waits for datagrams, before it checks whether a stop was requested
+    static constexpr std::chrono::milliseconds POLL_INTERVAL{100};
+
+    /// Waits until the socket is readable. Returns false, if a stop was requested before.
+    bool waitUntilReadable(const std::stop_token& stopToken) const;
+    /// Receives up to one batch of the datagrams that are available right away into the free area of the buffer, behind its first bytes.
+    /// Returns the new number of bytes in the buffer.
+    size_t receiveBatch(std::span<std::byte> buffer, size_t numberOfBytes);
+    /// Joins the multicast group on the socket of the given address family
+    void joinMulticastGroup(int addressFamily) const;
+
+    std::string host;
+    uint32_t port;
+    std::string multicastGroup;
+    std::string multicastInterface;
+    bool reusePort;
+    size_t maxDatagramSize;
+    size_t batchSize;
+    char tupleDelimiter;
+    uint32_t receiveBufferSize;
+    int socket = -1;
+
+    /// The headers of one recvmmsg(), which the source allocates once
+    std::vector<mmsghdr> messages;
+    std::vector<iovec> slots;
+
+    uint64_t receivedDatagrams = 0;
+    uint64_t truncatedDatagrams = 0;
+};
+
+}
@@ -0,0 +1,71 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include <Pipelines/CompiledExecutablePipelineStage.hpp>
+#include <Plans/LogicalPlan.hpp>
+
+namespace NES
+{
+
+/// The compiled pipeline slots of one query plan. The query compiler lowers equal plans deterministically to the same pipelines.
+/// Thus, we identify a pipeline by the position in which it is lowered and additionally check that its operators match.
+class CompiledPlanSlots
+{
+public:
+    /// Returns the slot of the pipelineIndex-th lowered pipeline. Returns nullptr, if the pipeline does not match the description of
+    /// the pipeline that was lowered at this position before.
+    std::shared_ptr<CompiledPipelineSlot> getSlot(size_t pipelineIndex, const std::string& pipelineDescription);
+
+private:
+    std::mutex mutex;
+    std::vector<std::pair<std::string, std::shared_ptr<CompiledPipelineSlot>>> slots;
+};
+
+/// Caches the compiled pipelines of the most recently compiled query plans. Plans are equal if they only differ in their ids, e.g.,
+/// if the same query is submitted again. Pipelines of equal plans share their compiled code, thus, only the first started pipeline
+/// traces and compiles the code.
+/// The compiled code contains the addresses of C++ functions and of operators in this process. Thus, we can not persist it.
+class CompiledPipelineCache
+{
+public:
+    /// A capacity of 0 disables the cache
+    explicit CompiledPipelineCache(size_t capacity) : capacity(capacity) { }
+
+    /// Returns the slots that are shared by all plans that are equal to the plan. Returns nullptr if the cache is disabled.
+    std::shared_ptr<CompiledPlanSlots> getSlots(const LogicalPlan& plan);
+
+private:
+    struct Entry
+    {
+        size_t hash;
+        LogicalPlan plan;
+        std::shared_ptr<CompiledPlanSlots> slots;
+    };
+
+    size_t capacity;
+    std::mutex mutex;
+    /// Ordered from the most to the least recently used plan
+    std::list<Entry> entries;
+};
+
+}
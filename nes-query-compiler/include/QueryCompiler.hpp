@@ -16,7 +16,10 @@
 #include <memory>
 #include <utility>
 
+#include <Pipelines/CompilationThreadPool.hpp>
 #include <Util/DumpMode.hpp>
+#include <ColumnStatisticsCollector.hpp>
+#include <CompiledPipelineCache.hpp>
 #include <CompiledQueryPlan.hpp>
 #include <OptimizedPlan.hpp>
 #include <QueryExecutionConfiguration.hpp>
@@ -36,15 +39,22 @@ struct QueryCompilationRequest
 
 /// The query compiler behaves as a pure function: QueryPlan -> CompiledQueryPlan
 /// This guarantees that identical QueryPlan instances produce identical CompiledQueryPlan results.
+/// The pipelines of identical QueryPlans share their compiled code via the compiled pipeline cache, which does not alter the result.
 class QueryCompiler
 {
 public:
-    explicit QueryCompiler(QueryExecutionConfiguration defaultQueryExecution) : defaultQueryExecution(std::move(defaultQueryExecution)) { };
+    /// If columnStatistics is set, the compiled queries sample the fields of their sources into it, which does not alter their results
+    explicit QueryCompiler(
+        QueryExecutionConfiguration defaultQueryExecution, std::shared_ptr<ColumnStatisticsCollector> columnStatistics = nullptr);
 
     std::unique_ptr<CompiledQueryPlan> compileQuery(std::unique_ptr<QueryCompilationRequest> request);
 
 private:
     QueryExecutionConfiguration defaultQueryExecution;
+    CompiledPipelineCache compiledPipelineCache;
+    /// Compiles the pipelines of a query in parallel, or in the background for the TIERED execution mode. Queries share the threads.
+    std::shared_ptr<CompilationThreadPool> compilationThreadPool;
+    std::shared_ptr<ColumnStatisticsCollector> columnStatistics;
 };
 
 }
@@ -24,16 +24,34 @@
 #include <Configurations/ScalarOption.hpp>
 #include <Configurations/Validation/FloatValidation.hpp>
 #include <Configurations/Validation/NumberValidation.hpp>
+#include <Util/CompilationBackend.hpp>
 #include <Util/ExecutionMode.hpp>
+#include <Util/HashFunctionType.hpp>
+#include <Util/HashMapType.hpp>
 
 namespace NES
 {
 
-static constexpr auto DEFAULT_NUMBER_OF_PARTITIONS_DATASTRUCTURES = 100;
+static constexpr auto DEFAULT_NUMBER_OF_PARTITIONS_DATASTRUCTURES = 1;
 static constexpr auto DEFAULT_PAGED_VECTOR_SIZE = 1024;
 static constexpr auto DEFAULT_OPERATOR_BUFFER_SIZE = 4096;
+static constexpr auto DEFAULT_EMIT_COALESCING_LATENCY_BOUND = 0;
+static constexpr auto DEFAULT_VAR_SIZED_SHARING_COMPACTION_THRESHOLD = 0;
 static constexpr auto DEFAULT_NUMBER_OF_RECORDS_PER_KEY = 10;
 static constexpr auto DEFAULT_MAX_NUMBER_OF_BUCKETS = 10'000.0;
+static constexpr auto DEFAULT_COMPILED_PIPELINE_CACHE_SIZE = 64;
+static constexpr auto DEFAULT_NUMBER_OF_COMPILATION_THREADS = 2;
+static constexpr auto DEFAULT_OPTIMIZATION_LEVEL = 3;
+static constexpr auto MAX_OPTIMIZATION_LEVEL = 3;
+static constexpr auto DEFAULT_NUMBER_OF_PROFILED_BUFFERS = 0;
+static constexpr auto DEFAULT_COLUMN_STATISTICS_SAMPLING_INTERVAL = 64;
+static constexpr auto DEFAULT_NUMBER_OF_HASH_JOIN_PARTITIONS = 0;
+static constexpr auto DEFAULT_HASH_JOIN_BLOOM_FILTER_BITS_PER_KEY = 16;
+static constexpr auto DEFAULT_DEDUPLICATION_BLOOM_FILTER_BITS_PER_KEY = 0;
+static constexpr auto DEFAULT_WINDOW_STATE_MEMORY_BUDGET = 0;
+static constexpr auto DEFAULT_WINDOW_STATE_SPILL_DIRECTORY = "/tmp";
+static constexpr auto DEFAULT_WINDOW_STATE_CHECKPOINT_DIRECTORY = "";
+static constexpr auto DEFAULT_WINDOW_STATE_CHECKPOINT_INTERVAL_MS = 1000;
 
 class QueryExecutionConfiguration : public BaseConfiguration
 {
@@ -45,17 +63,54 @@ public:
         = {"execution_mode",
            ExecutionMode::COMPILER,
            "Execution mode for the query compiler"
-           "[COMPILER|INTERPRETER]."};
+           "[COMPILER|INTERPRETER|VECTORIZED|TIERED|BYTECODE]."};
+    EnumOption<HashMapType> hashMapType
+        = {"hash_map_type",
+           HashMapType::CHAINED,
+           "Hash map implementation of aggregations and hash joins"
+           "[CHAINED|SWISS]."};
+    EnumOption<HashFunctionType> hashFunction
+        = {"hash_function",
+           HashFunctionType::AUTO,
+           "Hash function of the keys of aggregations and hash joins. AUTO uses a perfect hash function for a single key of one byte, "
+           "XXH3 if all keys have a fixed size and MurMur3 otherwise, as MurMur3 reuses the cached hashes of interned variable sized "
+           "values. DIRECT uses the perfect hash function for all fixed size keys. Only choose it for keys from a small, dense range, "
+           "e.g., hours, as it maps keys that only differ in their upper bits, e.g., multiples of 1024, to the same bucket"
+           "[AUTO|MURMUR3|XXH3|DIRECT]."};
     UIntOption numberOfPartitions
         = {"number_of_partitions",
            std::to_string(DEFAULT_NUMBER_OF_PARTITIONS_DATASTRUCTURES),
-           "Partitions in a hash table",
+           "Partitions of the hash tables of aggregations. A window trigger combines each partition in a separate task, so that multiple "
+           "worker threads combine the keys of a window concurrently.",
            {std::make_shared<NumberValidation>()}};
+    BoolOption shareSlidingWindowAggregates
+        = {"share_sliding_window_aggregates",
+           "true",
+           "Shares the combined slices between overlapping sliding windows of aggregations, so that triggering a window combines at most "
+           "two partial aggregates instead of all of its slices. Only applies to windows whose size is at least four times the slide."};
+    BoolOption preAggregation
+        = {"pre_aggregation",
+           "true",
+           "Pre-aggregates the records of each worker thread in a small hash map that fits into the cache, before combining them into "
+           "the hash map of their slice. Reduces the probes into the large hash maps of aggregations over skewed keys and is bypassed for "
+           "buffers with few duplicate keys. Only applies to aggregations over time-based or count-based windows without partitions."};
+    BoolOption internVarSizedKeys
+        = {"intern_var_sized_keys",
+           "false",
+           "Interns the VARSIZED keys of the hash maps of aggregations and joins in a dictionary of the query, so that the entries of all "
+           "slices and worker threads store the address of a single copy of each distinct key and compare keys of entries by their "
+           "address. Pays off for low-cardinality strings, as the dictionary keeps every distinct key until the query stops."};
     UIntOption pageSize
         = {"page_size",
            std::to_string(DEFAULT_PAGED_VECTOR_SIZE),
            "Page size of any other paged data structure",
            {std::make_shared<NumberValidation>()}};
+    BoolOption compressPagedVectorPages
+        = {"compress_paged_vector_pages",
+           "false",
+           "Compresses the full pages of the paged vectors of nested loop joins, sort-merge joins and median aggregations column by "
+           "column, e.g., for windows over low-entropy values. The pages are decompressed when they are read, e.g., when a window gets "
+           "probed."};
     UIntOption numberOfRecordsPerKey
         = {"number_of_records_per_key",
            std::to_string(DEFAULT_NUMBER_OF_RECORDS_PER_KEY),
@@ -64,18 +119,175 @@ public:
     UIntOption maxNumberOfBuckets = {
         "max_number_of_buckets",
         std::to_string(DEFAULT_MAX_NUMBER_OF_BUCKETS),
-        "Maximal number of buckets for a hash table. If set too low or high degrades either the performance or increases the memory usage.",
+        "Maximal initial number of buckets for a hash table. Hash tables grow incrementally, if they receive more keys than expected.",
         {std::make_shared<FloatValidation>()}};
+    UIntOption numberOfHashJoinPartitions
+        = {"number_of_hash_join_partitions",
+           std::to_string(DEFAULT_NUMBER_OF_HASH_JOIN_PARTITIONS),
+           "Number of radix partitions of a hash join. Each window is joined by one probe task per partition, which merges the hash maps "
+           "of all worker threads for its partition. 0 disables the partitioning and probes the hash maps of all worker threads pairwise.",
+           {std::make_shared<NumberValidation>()}};
+    UIntOption hashJoinBloomFilterBitsPerKey
+        = {"hash_join_bloom_filter_bits_per_key",
+           std::to_string(DEFAULT_HASH_JOIN_BLOOM_FILTER_BITS_PER_KEY),
+           "Bits per expected key of the bloom filter over the left keys of each hash join slice. The probe skips the hash map lookups of "
+           "right keys that the bloom filter rejects. 0 disables the bloom filter.",
+           {std::make_shared<NumberValidation>()}};
+    BoolOption hashJoinLateMaterialization
+        = {"hash_join_late_materialization",
+           "false",
+           "Stores the tuples of each hash map of a hash join densely in one paged vector instead of one paged vector per key. The hash "
+           "map entries only store a reference to the latest tuple of their key, which references the previous one. The probe reads the "
+           "tuples of a key only for join partners. Takes much less memory for keys with few tuples, but radix-partitioned hash joins "
+           "then probe the left hash maps of all worker threads pairwise instead of merging them."};
+    UIntOption deduplicationBloomFilterBitsPerKey
+        = {"deduplication_bloom_filter_bits_per_key",
+           std::to_string(DEFAULT_DEDUPLICATION_BLOOM_FILTER_BITS_PER_KEY),
+           "Bits per expected key of the bloom filter, which SELECT DISTINCT keeps per window instead of the exact fingerprints of its "
+           "keys. A bloom filter takes less memory, but may drop the first occurrence of a key. 0 keeps exact fingerprints.",
+           {std::make_shared<NumberValidation>()}};
+    BoolOption multiwayHashJoin
+        = {"multiway_hash_join",
+           "true",
+           "Joins nested hash joins over the same tumbling event-time windows, whose join functions all compare the same key, with a "
+           "single multiway hash join. Its slices store the tuples of all inputs, so that the nested joins materialize no intermediate results. "
+           "Only applies to hash joins without radix partitions."};
+    UIntOption windowStateMemoryBudget
+        = {"window_state_memory_budget",
+           std::to_string(DEFAULT_WINDOW_STATE_MEMORY_BUDGET),
+           "Bytes of the slices of each window operator that are kept in memory. Once the slices grow larger, their oldest pages are "
+           "spilled to files in the window_state_spill_directory and are paged back in when they get accessed, e.g., when their windows "
+           "get triggered. 0 keeps all slices in memory.",
+           {std::make_shared<NumberValidation>()}};
+    StringOption windowStateSpillDirectory
+        = {"window_state_spill_directory",
+           DEFAULT_WINDOW_STATE_SPILL_DIRECTORY,
+           "Directory, e.g., on a local SSD, for the files of the spilled slices of window operators. The files are deleted once the "
+           "slices are released."};
+    StringOption windowStateCheckpointDirectory
+        = {"window_state_checkpoint_directory",
+           DEFAULT_WINDOW_STATE_CHECKPOINT_DIRECTORY,
+           "Directory for incremental checkpoints of the filling windows of the aggregations of the query. A restarted query with the "
+           "same directory continues the windows from the latest checkpoint. Each query requires its own directory. Aggregations of "
+           "session or count-based windows, with variable sized keys, or with a median are not checkpointed. Empty disables the "
+           "checkpoints."};
+    UIntOption windowStateCheckpointInterval
+        = {"window_state_checkpoint_interval",
+           std::to_string(DEFAULT_WINDOW_STATE_CHECKPOINT_INTERVAL_MS),
+           "Milliseconds between two checkpoints of the filling windows, c.f., window_state_checkpoint_directory.",
+           {std::make_shared<NumberValidation>()}};
     UIntOption operatorBufferSize
         = {"operator_buffer_size",
            std::to_string(DEFAULT_OPERATOR_BUFFER_SIZE),
            "Buffer size of a operator e.g. during scan",
            {std::make_shared<NumberValidation>()}};
+    UIntOption emitCoalescingLatencyBound
+        = {"emit_coalescing_latency_bound",
+           std::to_string(DEFAULT_EMIT_COALESCING_LATENCY_BOUND),
+           "Microseconds that pipelines with a selection may hold back their small output buffers, to coalesce them into full buffers "
+           "while the task queue is backlogged. Otherwise, they emit their buffers right away. 0 disables the coalescing.",
+           {std::make_shared<NumberValidation>()}};
+    UIntOption varSizedSharingCompactionThreshold
+        = {"var_sized_sharing_compaction_threshold",
+           std::to_string(DEFAULT_VAR_SIZED_SHARING_COMPACTION_THRESHOLD),
+           "Lets the emits of pipelines reference the unchanged variable sized values of their input buffers instead of copying them, "
+           "e.g., for projections and selections over strings. An emitted buffer copies the values that it references of a shared child "
+           "buffer into a new child buffer, if they cover less than this percentage of the child buffer. 0 disables the sharing.",
+           {std::make_shared<NumberValidation>()}};
+    UIntOption compiledPipelineCacheSize
+        = {"compiled_pipeline_cache_size",
+           std::to_string(DEFAULT_COMPILED_PIPELINE_CACHE_SIZE),
+           "Number of query plans whose compiled pipelines are kept for reuse by identical query plans. 0 disables the cache.",
+           {std::make_shared<NumberValidation>()}};
+    BoolOption parameterizeConstants
+        = {"parameterize_constants",
+           "false",
+           "Replaces the numeric constants of selections and named projections with parameters that the compiled code reads at runtime. "
+           "Queries that only differ in these constants then reuse the compiled pipelines of each other. Selections with parameters "
+           "neither use late materialization nor batch filters."};
+    UIntOption numberOfCompilationThreads
+        = {"number_of_compilation_threads",
+           std::to_string(DEFAULT_NUMBER_OF_COMPILATION_THREADS),
+           "Number of threads that compile the pipelines of a query in parallel, or in the background for the TIERED execution mode. "
+           "0 compiles the pipelines one after the other when the query starts.",
+           {std::make_shared<NumberValidation>()}};
+    EnumOption<CompilationBackend> compilationBackend
+        = {"compilation_backend",
+           CompilationBackend::MLIR,
+           "Backend that compiles the pipelines without window state, e.g., the scans, selections, and maps behind the sources "
+           "[MLIR|CPP|BYTECODE]."};
+    UIntOption optimizationLevel
+        = {"optimization_level",
+           std::to_string(DEFAULT_OPTIMIZATION_LEVEL),
+           "Optimization level [0-3] of the compilation_backend.",
+           {std::make_shared<NumberValidation>()}};
+    EnumOption<CompilationBackend> windowPipelineCompilationBackend
+        = {"window_pipeline_compilation_backend",
+           CompilationBackend::MLIR,
+           "Backend that compiles the pipelines that build or probe the state of window aggregations and joins, which usually run "
+           "longer than they take to compile [MLIR|CPP|BYTECODE]."};
+    UIntOption windowPipelineOptimizationLevel
+        = {"window_pipeline_optimization_level",
+           std::to_string(DEFAULT_OPTIMIZATION_LEVEL),
+           "Optimization level [0-3] of the window_pipeline_compilation_backend.",
+           {std::make_shared<NumberValidation>()}};
+    UIntOption numberOfProfiledBuffers
+        = {"number_of_profiled_buffers",
+           std::to_string(DEFAULT_NUMBER_OF_PROFILED_BUFFERS),
+           "Number of buffers that the TIERED execution mode interprets before it compiles a pipeline. In the meantime, selections "
+           "profile how many records pass each of their conjuncts. The compiled code evaluates the conjuncts in the order of ascending "
+           "pass rates and skips the remaining conjuncts of a rejected record. 0 compiles the pipelines right away without profiling.",
+           {std::make_shared<NumberValidation>()}};
+    BoolOption emitPerfMap
+        = {"emit_perf_map",
+           "false",
+           "Names the compiled code of each pipeline after its query, its pipeline and its operators in /tmp/perf-<pid>.map, so that perf "
+           "attributes the samples in compiled code to the pipelines instead of reporting them as [unknown]."};
+    UIntOption columnStatisticsSamplingInterval
+        = {"column_statistics_sampling_interval",
+           std::to_string(DEFAULT_COLUMN_STATISTICS_SAMPLING_INTERVAL),
+           "The input formatters of the sources sample every n-th record of each buffer into statistics per source field, i.e., the "
+           "minimum, the maximum, the number of nulls, the approximate number of distinct values and a histogram. The query optimizer "
+           "uses them, e.g., to estimate the number of distinct join keys. 0 disables the sampling.",
+           {std::make_shared<NumberValidation>()}};
 
 private:
     std::vector<BaseOption*> getOptions() override
     {
-        return {&executionMode, &pageSize, &numberOfPartitions, &numberOfRecordsPerKey, &maxNumberOfBuckets, &operatorBufferSize};
+        return {
+            &executionMode,
+            &hashMapType,
+            &hashFunction,
+            &pageSize,
+            &compressPagedVectorPages,
+            &numberOfPartitions,
+            &shareSlidingWindowAggregates,
+            &preAggregation,
+            &internVarSizedKeys,
+            &numberOfRecordsPerKey,
+            &maxNumberOfBuckets,
+            &numberOfHashJoinPartitions,
+            &hashJoinBloomFilterBitsPerKey,
+            &hashJoinLateMaterialization,
+            &deduplicationBloomFilterBitsPerKey,
+            &multiwayHashJoin,
+            &windowStateMemoryBudget,
+            &windowStateSpillDirectory,
+            &windowStateCheckpointDirectory,
+            &windowStateCheckpointInterval,
+            &operatorBufferSize,
+            &emitCoalescingLatencyBound,
+            &varSizedSharingCompactionThreshold,
+            &compiledPipelineCacheSize,
+            &parameterizeConstants,
+            &numberOfCompilationThreads,
+            &compilationBackend,
+            &optimizationLevel,
+            &windowPipelineCompilationBackend,
+            &windowPipelineOptimizationLevel,
+            &numberOfProfiledBuffers,
+            &emitPerfMap,
+            &columnStatisticsSamplingInterval};
     }
 };
 
@@ -34,6 +34,9 @@ struct LoweringRuleResultSubgraph
     SubGraphRoot root;
     /// Bottom-level physical operators of subgraph
     SubGraphLeafs leafs;
+    /// Logical operators, whose lowered subgraphs become the children of the leafs, if the rule lowered the operator together with some of
+    /// its descendants. Empty, if the leafs belong to the children of the operator.
+    std::vector<LogicalOperator> inputs{};
 };
 
 /// Interface for lowering rules.
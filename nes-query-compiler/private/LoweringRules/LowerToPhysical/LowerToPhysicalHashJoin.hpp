@@ -14,8 +14,10 @@
 
 #pragma once
 
+#include <memory>
 #include <utility>
 #include <LoweringRules/AbstractLoweringRule.hpp>
+#include <Nautilus/DataTypes/VarSizedDictionary.hpp>
 #include <Operators/LogicalOperator.hpp>
 #include <QueryExecutionConfiguration.hpp>
 
@@ -23,12 +25,16 @@ namespace NES
 {
 struct LowerToPhysicalHashJoin : AbstractLoweringRule
 {
-    explicit LowerToPhysicalHashJoin(QueryExecutionConfiguration conf) : conf(std::move(conf)) { }
+    LowerToPhysicalHashJoin(QueryExecutionConfiguration conf, std::shared_ptr<VarSizedDictionary> varSizedKeyDictionary)
+        : conf(std::move(conf)), varSizedKeyDictionary(std::move(varSizedKeyDictionary))
+    {
+    }
 
     LoweringRuleResultSubgraph apply(LogicalOperator logicalOperator) override;
 
 private:
     QueryExecutionConfiguration conf;
+    std::shared_ptr<VarSizedDictionary> varSizedKeyDictionary;
 };
 
 }
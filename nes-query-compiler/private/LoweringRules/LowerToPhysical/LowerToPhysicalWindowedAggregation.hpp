@@ -14,8 +14,10 @@
 
 #pragma once
 
+#include <memory>
 #include <utility>
 #include <LoweringRules/AbstractLoweringRule.hpp>
+#include <Nautilus/DataTypes/VarSizedDictionary.hpp>
 #include <Operators/LogicalOperator.hpp>
 #include <QueryExecutionConfiguration.hpp>
 
@@ -24,12 +26,16 @@ namespace NES
 
 struct LowerToPhysicalWindowedAggregation : AbstractLoweringRule
 {
-    explicit LowerToPhysicalWindowedAggregation(QueryExecutionConfiguration conf) : conf(std::move(conf)) { }
+    LowerToPhysicalWindowedAggregation(QueryExecutionConfiguration conf, std::shared_ptr<VarSizedDictionary> varSizedKeyDictionary)
+        : conf(std::move(conf)), varSizedKeyDictionary(std::move(varSizedKeyDictionary))
+    {
+    }
 
     LoweringRuleResultSubgraph apply(LogicalOperator logicalOperator) override;
 
 private:
     QueryExecutionConfiguration conf;
+    std::shared_ptr<VarSizedDictionary> varSizedKeyDictionary;
 };
 
 }
@@ -0,0 +1,36 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <DataTypes/Schema.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Functions/ParameterLogicalFunction.hpp>
+#include <Nautilus/Interface/BufferRef/LowerSchemaProvider.hpp>
+#include <PhysicalOperator.hpp>
+
+namespace NES
+{
+
+/// Returns the distinct parameters of the functions in the order of their first occurrence
+std::vector<ParameterLogicalFunction> collectParameters(const std::vector<LogicalFunction>& functions);
+
+/// Creates the wrapper of a ParameterBindingPhysicalOperator, which binds the values of the parameters to record fields before the
+/// operator that evaluates the functions. Returns nullptr, if the functions have no parameters.
+std::shared_ptr<PhysicalOperatorWrapper> createParameterBinding(
+    const std::vector<ParameterLogicalFunction>& parameters, const Schema& inputSchema, MemoryLayoutType memoryLayoutType);
+
+}
@@ -0,0 +1,43 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+#include <Runtime/AbstractBufferProvider.hpp>
+#include <SliceStore/WindowSlicesStoreInterface.hpp>
+#include <WindowTypes/Types/WindowType.hpp>
+#include <QueryExecutionConfiguration.hpp>
+
+namespace NES
+{
+
+/// Creates the slice store for the windowed aggregations and joins. Session windows require a SessionSliceStore, as the boundaries of
+/// their windows depend on the records, while tumbling, sliding, and count-based windows are stored in the DefaultTimeBasedSliceStore.
+/// Solely time-based windows keep their slices for the allowed lateness after the window got triggered.
+std::unique_ptr<WindowSlicesStoreInterface>
+createSliceStore(const Windowing::WindowType& windowType, std::optional<uint64_t> allowedLateness = std::nullopt);
+
+/// Creates the slice store for a windowed aggregation that computes tumbling windows of all the given sizes from the same slices
+std::unique_ptr<WindowSlicesStoreInterface>
+createSharedSliceStore(const std::vector<uint64_t>& windowSizes, std::optional<uint64_t> allowedLateness = std::nullopt);
+
+/// Creates the buffer provider for the state of the slices of a window operator, which spills the oldest state to files in the spill
+/// directory, once the state exceeds the memory budget. Returns nullptr, if no memory budget is configured.
+std::shared_ptr<AbstractBufferProvider> createStateBufferProvider(const QueryExecutionConfiguration& configuration);
+
+}
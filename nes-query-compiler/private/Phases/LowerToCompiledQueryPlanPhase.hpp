@@ -14,23 +14,48 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
+#include <utility>
 #include <variant>
 #include <vector>
 
 #include <Identifiers/Identifiers.hpp>
+#include <Pipelines/CompilationThreadPool.hpp>
+#include <Pipelines/CompiledExecutablePipelineStage.hpp>
+#include <Util/CompilationBackend.hpp>
 #include <Util/DumpMode.hpp>
+#include <CompiledPipelineCache.hpp>
 #include <CompiledQueryPlan.hpp>
 #include <PipelinedQueryPlan.hpp>
+#include <QueryExecutionConfiguration.hpp>
 
 namespace NES
 {
 class LowerToCompiledQueryPlanPhase
 {
 public:
-    explicit LowerToCompiledQueryPlanPhase(DumpMode dumpQueryCompilationIntermediateRepresentations)
+    /// If compiledPlanSlots are given, the compiled code of each pipeline is shared with the pipelines of all equal plans.
+    /// With the TIERED execution mode, the stages compile their pipelines on the compilationThreadPool in the background.
+    /// With the COMPILER and VECTORIZED execution modes, the pipelines are compiled in parallel on the compilationThreadPool (if any).
+    /// Pipelines with window state are compiled by the window pipeline backend of the configuration, all others by its default backend.
+    LowerToCompiledQueryPlanPhase(
+        DumpMode dumpQueryCompilationIntermediateRepresentations,
+        std::shared_ptr<CompiledPlanSlots> compiledPlanSlots,
+        std::shared_ptr<CompilationThreadPool> compilationThreadPool,
+        const QueryExecutionConfiguration& queryExecutionConfiguration)
         : dumpQueryCompilationIR(dumpQueryCompilationIntermediateRepresentations)
+        , compiledPlanSlots(std::move(compiledPlanSlots))
+        , compilationThreadPool(std::move(compilationThreadPool))
+        , pipelineCompilation(
+              {queryExecutionConfiguration.compilationBackend.getValue(), queryExecutionConfiguration.optimizationLevel.getValue()})
+        , windowPipelineCompilation(
+              {queryExecutionConfiguration.windowPipelineCompilationBackend.getValue(),
+               queryExecutionConfiguration.windowPipelineOptimizationLevel.getValue()})
+        , numberOfProfiledBuffers(queryExecutionConfiguration.numberOfProfiledBuffers.getValue())
+        , emitPerfMap(queryExecutionConfiguration.emitPerfMap.getValue())
     {
     }
 
@@ -40,12 +65,19 @@ private:
     using Predecessor = std::variant<OperatorId, std::weak_ptr<ExecutablePipeline>>;
     using Successor = std::optional<std::shared_ptr<ExecutablePipeline>>;
 
+    struct PipelineCompilation
+    {
+        CompilationBackend backend;
+        uint64_t optimizationLevel;
+    };
+
     std::shared_ptr<ExecutablePipeline> processOperatorPipeline(const std::shared_ptr<Pipeline>& pipeline);
     void processSink(const Predecessor& predecessor, const std::shared_ptr<Pipeline>& pipeline);
     Successor processSuccessor(const Predecessor& predecessor, const std::shared_ptr<Pipeline>& pipeline);
     void processSource(const std::shared_ptr<Pipeline>& pipeline);
 
     std::unique_ptr<ExecutablePipelineStage> getStage(const std::shared_ptr<Pipeline>& pipeline);
+    void compileStagesInParallel();
 
     /// Lowering context
     std::vector<CompiledQueryPlan::Sink> sinks;
@@ -53,8 +85,17 @@ private:
     std::unordered_map<PipelineId, std::shared_ptr<ExecutablePipeline>> pipelineToExecutableMap;
 
     std::shared_ptr<PipelinedQueryPlan> pipelineQueryPlan;
+    size_t numberOfLoweredPipelines = 0;
+    /// Stages that are compiled ahead of their start. They are owned by the executable pipelines in the pipelineToExecutableMap.
+    std::vector<CompiledExecutablePipelineStage*> stagesToCompile;
 
     /// Config parameter
     DumpMode dumpQueryCompilationIR;
+    std::shared_ptr<CompiledPlanSlots> compiledPlanSlots;
+    std::shared_ptr<CompilationThreadPool> compilationThreadPool;
+    PipelineCompilation pipelineCompilation;
+    PipelineCompilation windowPipelineCompilation;
+    uint64_t numberOfProfiledBuffers;
+    bool emitPerfMap;
 };
 }
@@ -0,0 +1,26 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <Plans/LogicalPlan.hpp>
+
+namespace NES::QueryCompilation::ParameterizeConstantsPhase
+{
+/// Turns the plan into a query template by replacing the numeric constants of its selections and named projections with parameters.
+/// Plans that only differ in these constants result in equal templates, which share their compiled pipelines. The parameters are
+/// numbered in the order of a depth-first traversal of the plan, thus equal templates number their parameters alike.
+/// Constants of UDF calls stay constants, as the operators that call batch UDFs only buffer the fields of their input.
+LogicalPlan apply(const LogicalPlan& plan);
+}
@@ -15,11 +15,14 @@
 #pragma once
 
 #include <memory>
+#include <ColumnStatisticsCollector.hpp>
 #include <PhysicalPlan.hpp>
 #include <PipelinedQueryPlan.hpp>
 
 namespace NES::QueryCompilation::PipeliningPhase
 {
 /// During this step we create a PipelinedQueryPlan out of the QueryPlan obj
-std::shared_ptr<PipelinedQueryPlan> apply(const PhysicalPlan& queryPlan);
+/// If columnStatistics is set, the pipelines that format the raw buffers of sources sample the source fields into it
+std::shared_ptr<PipelinedQueryPlan>
+apply(const PhysicalPlan& queryPlan, const std::shared_ptr<ColumnStatisticsCollector>& columnStatistics = nullptr);
 }
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -35,6 +36,8 @@ public:
     void addSinkRoot(std::shared_ptr<PhysicalOperatorWrapper> sink);
     void setExecutionMode(ExecutionMode mode);
     void setOperatorBufferSize(uint64_t bufferSize);
+    void setEmitCoalescingLatencyBound(std::chrono::microseconds latencyBound);
+    void setVarSizedSharingCompactionThreshold(uint64_t threshold);
 
     /// R-value as finalize should be called once at the end, with a move() to 'build' the plan.
     [[nodiscard]] PhysicalPlan finalize() &&;
@@ -44,6 +47,8 @@ private:
     Roots sinks;
     ExecutionMode executionMode;
     uint64_t operatorBufferSize{};
+    std::chrono::microseconds emitCoalescingLatencyBound{0};
+    uint64_t varSizedSharingCompactionThreshold{0};
 
     /// Used internally to flip the plan from sink->source tstatic o source->sink
     static Roots flip(const Roots& roots);
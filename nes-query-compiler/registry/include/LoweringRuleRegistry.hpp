@@ -17,6 +17,7 @@
 #include <memory>
 #include <string>
 #include <LoweringRules/AbstractLoweringRule.hpp>
+#include <Nautilus/DataTypes/VarSizedDictionary.hpp>
 #include <Util/Registry.hpp>
 #include <QueryExecutionConfiguration.hpp>
 
@@ -28,6 +29,8 @@ using LoweringRuleRegistryReturnType = std::unique_ptr<AbstractLoweringRule>;
 struct LoweringRuleRegistryArguments
 {
     QueryExecutionConfiguration conf;
+    /// Interns the VARSIZED keys of all hash maps of the query, if set (see QueryExecutionConfiguration::internVarSizedKeys)
+    std::shared_ptr<VarSizedDictionary> varSizedKeyDictionary;
 };
 
 class LoweringRuleRegistry
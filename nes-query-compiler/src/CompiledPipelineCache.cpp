@@ -0,0 +1,79 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <CompiledPipelineCache.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <Pipelines/CompiledExecutablePipelineStage.hpp>
+#include <Plans/LogicalPlan.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/PlanRenderer.hpp>
+
+namespace NES
+{
+
+std::shared_ptr<CompiledPipelineSlot> CompiledPlanSlots::getSlot(const size_t pipelineIndex, const std::string& pipelineDescription)
+{
+    const std::scoped_lock lock(mutex);
+    if (pipelineIndex >= slots.size())
+    {
+        slots.resize(pipelineIndex + 1);
+    }
+    auto& [description, slot] = slots[pipelineIndex];
+    if (not slot)
+    {
+        description = pipelineDescription;
+        slot = std::make_shared<CompiledPipelineSlot>();
+    }
+    if (description != pipelineDescription)
+    {
+        NES_WARNING("Pipeline {} of equal query plans differs: {} vs. {}", pipelineIndex, description, pipelineDescription);
+        return nullptr;
+    }
+    return slot;
+}
+
+std::shared_ptr<CompiledPlanSlots> CompiledPipelineCache::getSlots(const LogicalPlan& plan)
+{
+    if (capacity == 0)
+    {
+        return nullptr;
+    }
+
+    /// The short explanation does not contain any ids. Thus, equal plans have the same hash.
+    const auto hash = std::hash<std::string>{}(explain(plan, ExplainVerbosity::Short));
+    const std::scoped_lock lock(mutex);
+    const auto entry = std::ranges::find_if(entries, [&](const Entry& cached) { return cached.hash == hash and cached.plan == plan; });
+    if (entry != entries.end())
+    {
+        NES_DEBUG("Reusing the compiled pipelines of an equal query plan for query {}", plan.getQueryId());
+        entries.splice(entries.begin(), entries, entry);
+        return entries.front().slots;
+    }
+
+    /// Stages of evicted plans keep their slots alive until they are destroyed
+    if (entries.size() >= capacity)
+    {
+        entries.pop_back();
+    }
+    entries.emplace_front(hash, plan, std::make_shared<CompiledPlanSlots>());
+    return entries.front().slots;
+}
+
+}
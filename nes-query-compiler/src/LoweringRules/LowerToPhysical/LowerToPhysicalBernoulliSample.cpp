@@ -0,0 +1,61 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <LoweringRules/LowerToPhysical/LowerToPhysicalBernoulliSample.hpp>
+
+#include <memory>
+#include <vector>
+
+#include <LoweringRules/AbstractLoweringRule.hpp>
+#include <Operators/BernoulliSampleLogicalOperator.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Sampling/BernoulliSamplePhysicalOperator.hpp>
+#include <Traits/MemoryLayoutTypeTrait.hpp>
+#include <ErrorHandling.hpp>
+#include <LoweringRuleRegistry.hpp>
+#include <PhysicalOperator.hpp>
+
+namespace NES
+{
+
+LoweringRuleResultSubgraph LowerToPhysicalBernoulliSample::apply(LogicalOperator logicalOperator)
+{
+    PRECONDITION(logicalOperator.tryGetAs<BernoulliSampleLogicalOperator>(), "Expected a BernoulliSampleLogicalOperator");
+    const auto sample = logicalOperator.getAs<BernoulliSampleLogicalOperator>();
+    const auto memoryLayoutTypeTrait = logicalOperator.getTraitSet().tryGet<MemoryLayoutTypeTrait>();
+    PRECONDITION(memoryLayoutTypeTrait.has_value(), "Expected a memory layout type trait");
+    const auto memoryLayoutType = memoryLayoutTypeTrait.value()->memoryLayout;
+
+    /// The sample is an intermediate operator, thus it gets fused into the pipeline of its child, e.g., right behind the scan that
+    /// formats the raw buffers of a source. Thus, all downstream operators solely process the sampled records.
+    const auto wrapper = std::make_shared<PhysicalOperatorWrapper>(
+        BernoulliSamplePhysicalOperator(sample->getFraction()),
+        logicalOperator.getInputSchemas()[0],
+        logicalOperator.getOutputSchema(),
+        memoryLayoutType,
+        memoryLayoutType,
+        PhysicalOperatorWrapper::PipelineLocation::INTERMEDIATE);
+
+    /// Creates a physical leaf for each logical leaf. Required, as this operator can have any number of sources.
+    std::vector leafes(logicalOperator.getChildren().size(), wrapper);
+    return {.root = wrapper, .leafs = {leafes}};
+}
+
+std::unique_ptr<AbstractLoweringRule>
+LoweringRuleGeneratedRegistrar::RegisterBernoulliSampleLoweringRule(LoweringRuleRegistryArguments argument) /// NOLINT
+{
+    return std::make_unique<LowerToPhysicalBernoulliSample>(argument.conf);
+}
+
+}
@@ -0,0 +1,136 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <LoweringRules/LowerToPhysical/LowerToPhysicalDeduplication.hpp>
+
+#include <memory>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include <DataTypes/DataType.hpp>
+#include <Deduplication/DeduplicationOperatorHandler.hpp>
+#include <Deduplication/DeduplicationPhysicalOperator.hpp>
+#include <Functions/FieldAccessLogicalFunction.hpp>
+#include <Functions/FieldAccessPhysicalFunction.hpp>
+#include <Functions/FunctionProvider.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Functions/PhysicalFunction.hpp>
+#include <LoweringRules/AbstractLoweringRule.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Operators/Windows/DeduplicationLogicalOperator.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
+#include <Traits/MemoryLayoutTypeTrait.hpp>
+#include <Traits/OutputOriginIdsTrait.hpp>
+#include <Traits/TraitSet.hpp>
+#include <Watermark/TimeFunction.hpp>
+#include <WindowTypes/Measures/TimeCharacteristic.hpp>
+#include <WindowTypes/Types/TumblingWindow.hpp>
+#include <magic_enum/magic_enum.hpp>
+#include <ErrorHandling.hpp>
+#include <HashMapOptions.hpp>
+#include <LoweringRuleRegistry.hpp>
+#include <PhysicalOperator.hpp>
+
+namespace NES
+{
+
+namespace
+{
+std::unique_ptr<TimeFunction> getTimeFunction(const Windowing::TumblingWindow& window)
+{
+    switch (window.getTimeCharacteristic().getType())
+    {
+        case Windowing::TimeCharacteristic::Type::IngestionTime: {
+            if (window.getTimeCharacteristic().field.name == Windowing::TimeCharacteristic::RECORD_CREATION_TS_FIELD_NAME)
+            {
+                return std::make_unique<IngestionTimeFunction>();
+            }
+            throw UnknownWindowType(
+                "The ingestion time field of a window must be: {}", Windowing::TimeCharacteristic::RECORD_CREATION_TS_FIELD_NAME);
+        }
+        case Windowing::TimeCharacteristic::Type::EventTime: {
+            const auto timeStampField = FieldAccessPhysicalFunction(window.getTimeCharacteristic().field.name);
+            return std::make_unique<EventTimeFunction>(timeStampField, window.getTimeCharacteristic().getTimeUnit());
+        }
+        default: {
+            throw UnknownWindowType("Unknown window type: {}", magic_enum::enum_name(window.getTimeCharacteristic().getType()));
+        }
+    }
+}
+}
+
+LoweringRuleResultSubgraph LowerToPhysicalDeduplication::apply(LogicalOperator logicalOperator)
+{
+    PRECONDITION(logicalOperator.tryGetAs<DeduplicationLogicalOperator>(), "Expected a DeduplicationLogicalOperator");
+    PRECONDITION(logicalOperator.getChildren().size() == 1, "Expected one child");
+    const auto deduplication = logicalOperator.getAs<DeduplicationLogicalOperator>();
+    const auto inputOriginIds = getTrait<OutputOriginIdsTrait>(logicalOperator.getChildren().front().getTraitSet());
+    PRECONDITION(inputOriginIds.has_value(), "Expected the inputOriginIds trait to be set");
+    const auto memoryLayoutTypeTrait = logicalOperator.getTraitSet().tryGet<MemoryLayoutTypeTrait>();
+    PRECONDITION(memoryLayoutTypeTrait.has_value(), "Expected a memory layout type trait");
+    const auto memoryLayoutType = memoryLayoutTypeTrait.value()->memoryLayout;
+    const auto* const window = dynamic_cast<const Windowing::TumblingWindow*>(deduplication->getWindowType().get());
+    PRECONDITION(window != nullptr, "Expected the deduplication to use a tumbling window");
+
+    /// Without keys, the deduplication compares all fields of the records
+    const auto inputSchema = logicalOperator.getInputSchemas()[0];
+    auto keys = deduplication->getKeys();
+    if (keys.empty())
+    {
+        keys = inputSchema
+            | std::views::transform([](const auto& field)
+                                    { return LogicalFunction{FieldAccessLogicalFunction(field.dataType, field.name)}; })
+            | std::ranges::to<std::vector>();
+    }
+    std::vector<PhysicalFunction> keyFunctions;
+    std::vector<DataType> keyTypes;
+    for (const auto& key : keys)
+    {
+        keyFunctions.emplace_back(QueryCompilation::FunctionProvider::lowerFunction(key));
+        keyTypes.emplace_back(key.getDataType());
+    }
+
+    const auto handlerId = getNextOperatorHandlerId();
+    const auto handler = std::make_shared<DeduplicationOperatorHandler>(
+        inputOriginIds.value().get() | std::ranges::to<std::vector>(),
+        window->getSize().getTime(),
+        conf.maxNumberOfBuckets.getValue(),
+        conf.deduplicationBloomFilterBitsPerKey.getValue());
+    const auto wrapper = std::make_shared<PhysicalOperatorWrapper>(
+        DeduplicationPhysicalOperator(
+            handlerId,
+            getTimeFunction(*window),
+            std::move(keyFunctions),
+            HashMapOptions::createHashFunction(conf.hashFunction.getValue(), keyTypes)),
+        inputSchema,
+        logicalOperator.getOutputSchema(),
+        memoryLayoutType,
+        memoryLayoutType,
+        handlerId,
+        handler,
+        PhysicalOperatorWrapper::PipelineLocation::INTERMEDIATE);
+
+    /// Creates a physical leaf for each logical leaf. Required, as this operator can have any number of sources.
+    std::vector leafes(logicalOperator.getChildren().size(), wrapper);
+    return {.root = wrapper, .leafs = {leafes}};
+}
+
+std::unique_ptr<AbstractLoweringRule>
+LoweringRuleGeneratedRegistrar::RegisterDeduplicationLoweringRule(LoweringRuleRegistryArguments argument) /// NOLINT
+{
+    return std::make_unique<LowerToPhysicalDeduplication>(argument.conf);
+}
+
+}
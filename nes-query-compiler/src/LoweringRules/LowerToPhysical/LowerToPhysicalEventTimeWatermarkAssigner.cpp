@@ -14,12 +14,15 @@
 #include <LoweringRules/LowerToPhysical/LowerToPhysicalEventTimeWatermarkAssigner.hpp>
 
 #include <memory>
+#include <optional>
 #include <Functions/FunctionProvider.hpp>
 #include <LoweringRules/AbstractLoweringRule.hpp>
 #include <Operators/EventTimeWatermarkAssignerLogicalOperator.hpp>
 #include <Operators/LogicalOperator.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
 #include <Traits/MemoryLayoutTypeTrait.hpp>
 #include <Watermark/EventTimeWatermarkAssignerPhysicalOperator.hpp>
+#include <Watermark/OutOfOrdernessOperatorHandler.hpp>
 #include <Watermark/TimeFunction.hpp>
 #include <ErrorHandling.hpp>
 #include <LoweringRuleRegistry.hpp>
@@ -33,12 +36,27 @@ LoweringRuleResultSubgraph LowerToPhysicalEventTimeWatermarkAssigner::apply(Logi
     PRECONDITION(logicalOperator.tryGetAs<EventTimeWatermarkAssignerLogicalOperator>(), "Expected a EventTimeWatermarkAssigner");
     const auto assigner = logicalOperator.getAs<EventTimeWatermarkAssignerLogicalOperator>();
     const auto physicalFunction = QueryCompilation::FunctionProvider::lowerFunction(assigner->onField);
-    auto physicalOperator = EventTimeWatermarkAssignerPhysicalOperator(EventTimeFunction(physicalFunction, assigner->unit));
+    std::optional<OperatorHandlerId> handlerId;
+    std::optional<std::shared_ptr<OperatorHandler>> handler;
+    if (assigner->adaptiveOutOfOrderness)
+    {
+        handlerId = getNextOperatorHandlerId();
+        handler = std::make_shared<OutOfOrdernessOperatorHandler>(assigner->outOfOrdernessBoundInMs);
+    }
+    auto physicalOperator = EventTimeWatermarkAssignerPhysicalOperator(
+        EventTimeFunction(physicalFunction, assigner->unit), assigner->outOfOrdernessBoundInMs, handlerId);
     const auto memoryLayoutTypeTrait = logicalOperator.getTraitSet().tryGet<MemoryLayoutTypeTrait>();
     PRECONDITION(memoryLayoutTypeTrait.has_value(), "Expected a memory layout type trait");
     const auto memoryLayoutType = memoryLayoutTypeTrait.value()->memoryLayout;
     const auto wrapper = std::make_shared<PhysicalOperatorWrapper>(
-        physicalOperator, logicalOperator.getInputSchemas()[0], logicalOperator.getOutputSchema(), memoryLayoutType, memoryLayoutType);
+        physicalOperator,
+        logicalOperator.getInputSchemas()[0],
+        logicalOperator.getOutputSchema(),
+        memoryLayoutType,
+        memoryLayoutType,
+        handlerId,
+        handler,
+        PhysicalOperatorWrapper::PipelineLocation::INTERMEDIATE);
 
     /// Creates a physical leaf for each logical leaf. Required, as this operator can have any number of sources.
     std::vector leafes(logicalOperator.getChildren().size(), wrapper);
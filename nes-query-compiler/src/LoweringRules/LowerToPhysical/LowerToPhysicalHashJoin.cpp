@@ -15,7 +15,9 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <iterator>
 #include <memory>
+#include <optional>
 #include <ranges>
 #include <string>
 #include <tuple>
@@ -24,8 +26,11 @@
 #include <vector>
 
 #include <DataTypes/DataType.hpp>
+#include <DataTypes/DataTypeProvider.hpp>
 #include <DataTypes/Schema.hpp>
 #include <DataTypes/TimeUnit.hpp>
+#include <Functions/BooleanFunctions/AndLogicalFunction.hpp>
+#include <Functions/BooleanFunctions/EqualsLogicalFunction.hpp>
 #include <Functions/CastToTypeLogicalFunction.hpp>
 #include <Functions/FieldAccessLogicalFunction.hpp>
 #include <Functions/FieldAccessPhysicalFunction.hpp>
@@ -37,18 +42,23 @@
 #include <Join/HashJoin/HJBuildPhysicalOperator.hpp>
 #include <Join/HashJoin/HJOperatorHandler.hpp>
 #include <Join/HashJoin/HJProbePhysicalOperator.hpp>
+#include <Join/HashJoin/HJSlice.hpp>
+#include <Join/HashJoin/MultiwayHJBuildPhysicalOperator.hpp>
+#include <Join/HashJoin/MultiwayHJOperatorHandler.hpp>
+#include <Join/HashJoin/MultiwayHJProbePhysicalOperator.hpp>
 #include <Join/StreamJoinUtil.hpp>
 #include <LoweringRules/AbstractLoweringRule.hpp>
+#include <LoweringRules/SliceStoreProvider.hpp>
+#include <Nautilus/DataTypes/VarSizedDictionary.hpp>
 #include <Nautilus/Interface/BufferRef/LowerSchemaProvider.hpp>
 #include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
-#include <Nautilus/Interface/Hash/MurMur3HashFunction.hpp>
 #include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedEntryMemoryProvider.hpp>
 #include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMap.hpp>
 #include <Nautilus/Interface/PagedVector/PagedVector.hpp>
 #include <Operators/LogicalOperator.hpp>
 #include <Operators/Windows/JoinLogicalOperator.hpp>
 #include <Runtime/Execution/OperatorHandler.hpp>
-#include <SliceStore/DefaultTimeBasedSliceStore.hpp>
+#include <Traits/ImplementationTypeTrait.hpp>
 #include <Traits/MemoryLayoutTypeTrait.hpp>
 #include <Traits/OutputOriginIdsTrait.hpp>
 #include <Traits/TraitSet.hpp>
@@ -58,6 +68,7 @@
 #include <Watermark/TimestampField.hpp>
 #include <WindowTypes/Measures/TimeCharacteristic.hpp>
 #include <WindowTypes/Types/TimeBasedWindowType.hpp>
+#include <WindowTypes/Types/TumblingWindow.hpp>
 #include <ErrorHandling.hpp>
 #include <HashMapOptions.hpp>
 #include <LoweringRuleRegistry.hpp>
@@ -192,13 +203,19 @@ std::pair<Schema, std::vector<std::shared_ptr<PhysicalOperatorWrapper>>> addMapO
     return {inputSchemaOfMap, mapPhysicalOperators};
 }
 
-HashMapOptions
-createHashMapOptions(std::vector<FieldNamesExtension>& joinFieldExtensions, Schema& inputSchema, const QueryExecutionConfiguration& conf)
+/// The value of an entry is the paged vector of the tuples of its key or, with late materialization, the chain of their rows
+HashMapOptions createHashMapOptions(
+    std::vector<FieldNamesExtension>& joinFieldExtensions,
+    Schema& inputSchema,
+    const QueryExecutionConfiguration& conf,
+    const std::shared_ptr<VarSizedDictionary>& varSizedKeyDictionary,
+    const bool lateMaterialization = false)
 {
     uint64_t keySize = 0;
-    constexpr auto valueSize = sizeof(PagedVector);
+    const auto valueSize = lateMaterialization ? sizeof(HJRowChain) : sizeof(PagedVector);
     std::vector<PhysicalFunction> keyFunctions;
     std::vector<std::string> fieldKeyNames;
+    std::vector<DataType> keyTypes;
     for (auto& fieldExtension : joinFieldExtensions)
     {
         const FieldAccessLogicalFunction fieldAccessKey{fieldExtension.newDataType, fieldExtension.newName};
@@ -210,17 +227,19 @@ createHashMapOptions(std::vector<FieldNamesExtension>& joinFieldExtensions, Sche
         keySize += fieldExtension.newDataType.getSizeInBytesWithNull();
         keyFunctions.emplace_back(QueryCompilation::FunctionProvider::lowerFunction(fieldAccessKey));
         fieldKeyNames.emplace_back(fieldExtension.newName);
+        keyTypes.emplace_back(fieldExtension.newDataType);
     }
 
     const auto pageSize = conf.pageSize.getValue();
-    const auto numberOfBuckets = conf.numberOfPartitions.getValue();
+    const auto numberOfBuckets = conf.maxNumberOfBuckets.getValue();
     const auto entrySize = sizeof(ChainedHashMapEntry) + keySize + valueSize;
     const auto entriesPerPage = pageSize / entrySize;
 
     /// As we are using a paged vector for the value, we do not need to set the fieldNameValues for the chained hashmap
-    const auto& [fieldKeys, fieldValues] = ChainedEntryMemoryProvider::createFieldOffsets(inputSchema, fieldKeyNames, {});
+    const auto& [fieldKeys, fieldValues]
+        = ChainedEntryMemoryProvider::createFieldOffsets(inputSchema, fieldKeyNames, {}, varSizedKeyDictionary);
     HashMapOptions hashMapOptions{
-        std::make_unique<MurMur3HashFunction>(),
+        HashMapOptions::createHashFunction(conf.hashFunction.getValue(), keyTypes),
         std::move(keyFunctions),
         fieldKeys,
         fieldValues,
@@ -229,9 +248,247 @@ createHashMapOptions(std::vector<FieldNamesExtension>& joinFieldExtensions, Sche
         keySize,
         valueSize,
         pageSize,
-        numberOfBuckets};
+        numberOfBuckets,
+        conf.hashMapType.getValue()};
     return hashMapOptions;
 }
+
+/// Nested hash joins, whose inputs a single multiway hash join joins at once
+struct MultiwayJoinNest
+{
+    /// The joins in pre-order, i.e., the first join is the topmost join of the nest
+    std::vector<JoinLogicalOperator> joins;
+    std::vector<LogicalOperator> inputs;
+    std::vector<TimestampField> timestampFields;
+    /// The key field of every input, which all join functions compare for equality
+    std::vector<FieldNamesExtension> keyFields;
+};
+
+/// Only nested joins over the same tumbling event-time windows join the tuples of all inputs within the same slices. Ingestion time is
+/// excluded, as the ingestion time of the tuples that a nested join emits is not the ingestion time of its inputs.
+bool isMultiwayJoinCandidate(const JoinLogicalOperator& join)
+{
+    const auto implementationType = getTrait<JoinImplementationTypeTrait>(join.getTraitSet());
+    const auto window = std::dynamic_pointer_cast<Windowing::TumblingWindow>(join.getWindowType());
+    return implementationType.has_value() and implementationType.value()->implementationType == JoinImplementation::HASH_JOIN
+        and join.getJoinType() == JoinLogicalOperator::JoinType::INNER_JOIN and window != nullptr
+        and window->getTimeCharacteristic().getType() == Windowing::TimeCharacteristic::Type::EventTime;
+}
+
+/// The type inference qualifies the timestamp field of each join with the source of its input, thus we compare the unqualified fields
+bool haveSameTumblingWindows(const JoinLogicalOperator& join, const JoinLogicalOperator& other)
+{
+    const auto window = std::dynamic_pointer_cast<Windowing::TumblingWindow>(join.getWindowType());
+    const auto otherWindow = std::dynamic_pointer_cast<Windowing::TumblingWindow>(other.getWindowType());
+    return window->getSize() == otherWindow->getSize()
+        and window->getTimeCharacteristic().field.getUnqualifiedName() == otherWindow->getTimeCharacteristic().field.getUnqualifiedName()
+        and window->getTimeCharacteristic().getTimeUnit() == otherWindow->getTimeCharacteristic().getTimeUnit();
+}
+
+void collectConjuncts(const LogicalFunction& function, std::vector<LogicalFunction>& conjuncts)
+{
+    if (function.tryGetAs<AndLogicalFunction>().has_value())
+    {
+        for (const auto& child : function.getChildren())
+        {
+            collectConjuncts(child, conjuncts);
+        }
+    }
+    else
+    {
+        conjuncts.emplace_back(function);
+    }
+}
+
+/// Adds the operator as an input of the nest, unless it is a join that the multiway hash join of the nest can replace as well
+void collectMultiwayJoinNestInputs(const LogicalOperator& logicalOperator, const TimestampField& timestampField, MultiwayJoinNest& nest)
+{
+    const auto join = logicalOperator.tryGetAs<JoinLogicalOperator>();
+    if (not join.has_value() or not isMultiwayJoinCandidate(*join.value())
+        or not haveSameTumblingWindows(nest.joins.front(), *join.value()))
+    {
+        nest.inputs.push_back(logicalOperator);
+        nest.timestampFields.push_back(timestampField);
+        return;
+    }
+    nest.joins.push_back(*join.value());
+    const auto windowType = NES::as<Windowing::TimeBasedWindowType>(join.value()->getWindowType());
+    const auto [timestampFieldLeft, timestampFieldRight] = TimestampField::getTimestampLeftAndRight(*join.value(), windowType);
+    const auto children = logicalOperator.getChildren();
+    collectMultiwayJoinNestInputs(children.at(0), timestampFieldLeft, nest);
+    collectMultiwayJoinNestInputs(children.at(1), timestampFieldRight, nest);
+}
+
+/// Sets the key fields of the nest, if every conjunct of every join compares a field of two different inputs for equality, every input
+/// contributes exactly one field of the same data type, and every join compares the fields of its left and its right side.
+/// Then, all joins of the nest join on the same key and the multiway hash join does not need to cast any key field.
+bool collectMultiwayJoinKeyFields(MultiwayJoinNest& nest)
+{
+    const auto findInput = [&](const std::string& fieldName) -> std::optional<size_t>
+    {
+        const auto input = std::ranges::find_if(
+            nest.inputs, [&](const LogicalOperator& input) { return input.getOutputSchema().contains(fieldName); });
+        if (input == nest.inputs.end())
+        {
+            return std::nullopt;
+        }
+        return static_cast<size_t>(std::ranges::distance(nest.inputs.begin(), input));
+    };
+
+    std::vector<std::optional<FieldAccessLogicalFunction>> keyFields(nest.inputs.size());
+    for (const auto& join : nest.joins)
+    {
+        std::vector<LogicalFunction> conjuncts;
+        collectConjuncts(join.getJoinFunction(), conjuncts);
+        bool comparesLeftAndRight = false;
+        for (const auto& conjunct : conjuncts)
+        {
+            const auto children = conjunct.getChildren();
+            if (not conjunct.tryGetAs<EqualsLogicalFunction>().has_value() or children.size() != 2)
+            {
+                return false;
+            }
+            const auto firstField = children.at(0).tryGetAs<FieldAccessLogicalFunction>();
+            const auto secondField = children.at(1).tryGetAs<FieldAccessLogicalFunction>();
+            if (not firstField.has_value() or not secondField.has_value())
+            {
+                return false;
+            }
+            const auto firstInput = findInput(firstField.value()->getFieldName());
+            const auto secondInput = findInput(secondField.value()->getFieldName());
+            if (not firstInput.has_value() or not secondInput.has_value() or firstInput == secondInput)
+            {
+                return false;
+            }
+            for (const auto& [field, input] : {std::pair{*firstField.value(), *firstInput}, std::pair{*secondField.value(), *secondInput}})
+            {
+                if (keyFields.at(input).has_value() and keyFields.at(input)->getFieldName() != field.getFieldName())
+                {
+                    return false;
+                }
+                keyFields.at(input) = field;
+            }
+            comparesLeftAndRight = comparesLeftAndRight
+                or join.getLeftSchema().contains(firstField.value()->getFieldName())
+                    != join.getLeftSchema().contains(secondField.value()->getFieldName());
+        }
+        if (not comparesLeftAndRight)
+        {
+            return false;
+        }
+    }
+
+    const auto hasKeyFieldOfSameDataType = [&](const std::optional<FieldAccessLogicalFunction>& keyField)
+    { return keyField.has_value() and keyField->getDataType() == keyFields.front()->getDataType(); };
+    if (not keyFields.front().has_value() or not std::ranges::all_of(keyFields, hasKeyFieldOfSameDataType))
+    {
+        return false;
+    }
+    for (const auto& keyField : keyFields)
+    {
+        nest.keyFields.emplace_back(FieldNamesExtension{
+            .oldName = keyField->getFieldName(),
+            .newName = keyField->getFieldName(),
+            .oldDataType = keyField->getDataType(),
+            .newDataType = keyField->getDataType()});
+    }
+    return true;
+}
+
+/// Returns the nest of the join, if a multiway hash join can replace it together with at least one of its descendants
+std::optional<MultiwayJoinNest> collectMultiwayJoinNest(const LogicalOperator& logicalOperator, const JoinLogicalOperator& join)
+{
+    if (not isMultiwayJoinCandidate(join))
+    {
+        return std::nullopt;
+    }
+    MultiwayJoinNest nest{.joins = {join}, .inputs = {}, .timestampFields = {}, .keyFields = {}};
+    const auto windowType = NES::as<Windowing::TimeBasedWindowType>(join.getWindowType());
+    const auto [timestampFieldLeft, timestampFieldRight] = TimestampField::getTimestampLeftAndRight(join, windowType);
+    const auto children = logicalOperator.getChildren();
+    collectMultiwayJoinNestInputs(children.at(0), timestampFieldLeft, nest);
+    collectMultiwayJoinNestInputs(children.at(1), timestampFieldRight, nest);
+    if (nest.inputs.size() <= 2 or not collectMultiwayJoinKeyFields(nest))
+    {
+        return std::nullopt;
+    }
+    return nest;
+}
+
+/// Lowers all joins of the nest to a single multiway hash join. The build of every input of the nest becomes a leaf of the subgraph.
+LoweringRuleResultSubgraph lowerToMultiwayHashJoin(
+    MultiwayJoinNest& nest,
+    const MemoryLayoutType memoryLayoutType,
+    const OriginId outputOriginId,
+    const QueryExecutionConfiguration& conf,
+    const std::shared_ptr<VarSizedDictionary>& varSizedKeyDictionary)
+{
+    const auto& topJoin = nest.joins.front();
+    const auto outputSchema = topJoin.getOutputSchema();
+    const auto numberOfInputs = nest.inputs.size();
+    NES_DEBUG("Lowering {} nested hash joins to a multiway hash join over {} inputs", nest.joins.size(), numberOfInputs);
+
+    std::vector<OriginId> inputOriginIds;
+    std::vector<Schema> inputSchemas;
+    std::vector<std::shared_ptr<TupleBufferRef>> bufferRefs;
+    std::vector<HashMapOptions> hashMapOptions;
+    for (uint64_t input = 0; input < numberOfInputs; ++input)
+    {
+        const auto inputOutputOriginIds = getTrait<OutputOriginIdsTrait>(nest.inputs.at(input).getTraitSet());
+        PRECONDITION(inputOutputOriginIds.has_value(), "Expected the outputOriginIds trait of the input to be set");
+        std::ranges::copy(inputOutputOriginIds.value().get(), std::back_inserter(inputOriginIds));
+
+        auto inputSchema = nest.inputs.at(input).getOutputSchema();
+        bufferRefs.emplace_back(LowerSchemaProvider::lowerSchema(
+            conf.numberOfRecordsPerKey.getValue() * inputSchema.getSizeOfSchemaInBytes(), inputSchema, memoryLayoutType));
+        std::vector keyFieldOfInput{nest.keyFields.at(input)};
+        hashMapOptions.emplace_back(createHashMapOptions(keyFieldOfInput, inputSchema, conf, varSizedKeyDictionary));
+        inputSchemas.emplace_back(std::move(inputSchema));
+    }
+
+    auto handlerId = getNextOperatorHandlerId();
+    auto handler = std::make_shared<MultiwayHJOperatorHandler>(
+        inputOriginIds,
+        outputOriginId,
+        createSliceStore(*NES::as<Windowing::TimeBasedWindowType>(topJoin.getWindowType())),
+        numberOfInputs,
+        conf.maxNumberOfBuckets.getValue());
+    handler->setStateBufferProvider(createStateBufferProvider(conf));
+
+    std::vector<std::shared_ptr<PhysicalOperatorWrapper>> buildWrappers;
+    for (uint64_t input = 0; input < numberOfInputs; ++input)
+    {
+        const MultiwayHJBuildPhysicalOperator buildOperator{
+            handlerId, input, nest.timestampFields.at(input).toTimeFunction(), bufferRefs.at(input), hashMapOptions.at(input)};
+        buildWrappers.emplace_back(std::make_shared<PhysicalOperatorWrapper>(
+            buildOperator,
+            inputSchemas.at(input),
+            outputSchema,
+            memoryLayoutType,
+            memoryLayoutType,
+            handlerId,
+            handler,
+            PhysicalOperatorWrapper::PipelineLocation::EMIT));
+    }
+
+    auto probeOperator = MultiwayHJProbePhysicalOperator(
+        handlerId,
+        nest.joins | std::views::transform([](const auto& join) { return join.getWindowMetaData(); }) | std::ranges::to<std::vector>(),
+        bufferRefs,
+        std::move(hashMapOptions));
+    auto probeWrapper = std::make_shared<PhysicalOperatorWrapper>(
+        std::move(probeOperator),
+        outputSchema,
+        outputSchema,
+        memoryLayoutType,
+        memoryLayoutType,
+        handlerId,
+        handler,
+        PhysicalOperatorWrapper::PipelineLocation::SCAN,
+        buildWrappers);
+
+    return {.root = {probeWrapper}, .leafs = buildWrappers, .inputs = std::move(nest.inputs)};
+}
 }
 
 LoweringRuleResultSubgraph LowerToPhysicalHashJoin::apply(LogicalOperator logicalOperator)
@@ -251,6 +508,13 @@ LoweringRuleResultSubgraph LowerToPhysicalHashJoin::apply(LogicalOperator logica
 
     auto outputSchema = join.getOutputSchema();
     auto outputOriginId = outputOriginIds.get()[0];
+    if (conf.multiwayHashJoin.getValue() and conf.numberOfHashJoinPartitions.getValue() == 0)
+    {
+        if (auto nest = collectMultiwayJoinNest(logicalOperator, join.get()))
+        {
+            return lowerToMultiwayHashJoin(*nest, memoryLayoutType, outputOriginId, conf, varSizedKeyDictionary);
+        }
+    }
     auto logicalJoinFunction = join->getJoinFunction();
     auto windowType = NES::as<Windowing::TimeBasedWindowType>(join->getWindowType());
     auto [timeStampFieldLeft, timeStampFieldRight] = TimestampField::getTimestampLeftAndRight(join.get(), windowType);
@@ -276,15 +540,62 @@ LoweringRuleResultSubgraph LowerToPhysicalHashJoin::apply(LogicalOperator logica
         conf.numberOfRecordsPerKey.getValue() * newLeftInputSchema.getSizeOfSchemaInBytes(), newLeftInputSchema, memoryLayoutType);
     auto rightBufferRef = LowerSchemaProvider::lowerSchema(
         conf.numberOfRecordsPerKey.getValue() * newRightInputSchema.getSizeOfSchemaInBytes(), newRightInputSchema, memoryLayoutType);
-    auto leftHashMapOptions = createHashMapOptions(leftJoinFields, newLeftInputSchema, conf);
-    auto rightHashMapOptions = createHashMapOptions(rightJoinFields, newRightInputSchema, conf);
+    const auto lateMaterialization = conf.hashJoinLateMaterialization.getValue();
+    auto leftHashMapOptions = createHashMapOptions(leftJoinFields, newLeftInputSchema, conf, varSizedKeyDictionary, lateMaterialization);
+    auto rightHashMapOptions = createHashMapOptions(rightJoinFields, newRightInputSchema, conf, varSizedKeyDictionary, lateMaterialization);
+
+    /// With late materialization, the rows of a hash map store the tuples of all of its keys together with the previous row of their key
+    std::shared_ptr<TupleBufferRef> leftRowBufferRef;
+    std::shared_ptr<TupleBufferRef> rightRowBufferRef;
+    if (lateMaterialization)
+    {
+        const auto lowerRowSchema = [&](Schema rowSchema)
+        {
+            rowSchema.addField(HJ_PREVIOUS_ROW_FIELD, DataTypeProvider::provideDataType(DataType::Type::UINT64));
+            return LowerSchemaProvider::lowerSchema(conf.pageSize.getValue(), rowSchema, memoryLayoutType);
+        };
+        leftRowBufferRef = lowerRowSchema(newLeftInputSchema);
+        rightRowBufferRef = lowerRowSchema(newRightInputSchema);
+    }
+
+    /// If the optimizer decided to hash only one side, the other side is streamed through its hash maps. The streamed side neither gets
+    /// partitioned nor late materialized, thus, we hash both sides, if the hash join is partitioned or late materialized.
+    const auto numberOfPartitions = conf.numberOfHashJoinPartitions.getValue();
+    std::optional<JoinBuildSideType> streamedSide;
+    if (const auto implementationType = getTrait<JoinImplementationTypeTrait>(logicalOperator.getTraitSet());
+        implementationType.has_value() and implementationType.value()->hashJoinBuildSide != HashJoinBuildSide::BOTH)
+    {
+        if (numberOfPartitions > 0 or lateMaterialization)
+        {
+            NES_DEBUG("Hashing both sides of the hash join, as its streamed side supports neither partitions nor late materialization");
+        }
+        else
+        {
+            streamedSide = implementationType.value()->hashJoinBuildSide == HashJoinBuildSide::LEFT ? JoinBuildSideType::Right
+                                                                                                      : JoinBuildSideType::Left;
+        }
+    }
 
     /// Creating the left and right hash join build operator
     auto handlerId = getNextOperatorHandlerId();
     const HJBuildPhysicalOperator leftBuildOperator{
-        handlerId, JoinBuildSideType::Left, timeStampFieldLeft.toTimeFunction(), leftBufferRef, leftHashMapOptions};
+        handlerId,
+        JoinBuildSideType::Left,
+        timeStampFieldLeft.toTimeFunction(),
+        leftBufferRef,
+        leftHashMapOptions,
+        numberOfPartitions,
+        leftRowBufferRef,
+        streamedSide == JoinBuildSideType::Left};
     const HJBuildPhysicalOperator rightBuildOperator{
-        handlerId, JoinBuildSideType::Right, timeStampFieldRight.toTimeFunction(), rightBufferRef, rightHashMapOptions};
+        handlerId,
+        JoinBuildSideType::Right,
+        timeStampFieldRight.toTimeFunction(),
+        rightBufferRef,
+        rightHashMapOptions,
+        numberOfPartitions,
+        rightRowBufferRef,
+        streamedSide == JoinBuildSideType::Right};
 
     /// Creating the hash join probe
     auto joinSchema = JoinSchema(newLeftInputSchema, newRightInputSchema, outputSchema);
@@ -293,17 +604,28 @@ LoweringRuleResultSubgraph LowerToPhysicalHashJoin::apply(LogicalOperator logica
         physicalJoinFunction,
         join->getWindowMetaData(),
         joinSchema,
-        leftBufferRef,
-        rightBufferRef,
+        lateMaterialization ? leftRowBufferRef : leftBufferRef,
+        lateMaterialization ? rightRowBufferRef : rightBufferRef,
         leftHashMapOptions,
-        rightHashMapOptions);
+        rightHashMapOptions,
+        numberOfPartitions,
+        lateMaterialization,
+        streamedSide);
 
 
     /// Creating the hash join operator handler
-    auto sliceAndWindowStore
-        = std::make_unique<DefaultTimeBasedSliceStore>(windowType->getSize().getTime(), windowType->getSlide().getTime());
-    auto handler
-        = std::make_shared<HJOperatorHandler>(inputOriginIds, outputOriginId, std::move(sliceAndWindowStore), conf.maxNumberOfBuckets);
+    auto sliceAndWindowStore = createSliceStore(*windowType);
+    auto handler = std::make_shared<HJOperatorHandler>(
+        inputOriginIds,
+        outputOriginId,
+        std::move(sliceAndWindowStore),
+        conf.maxNumberOfBuckets,
+        numberOfPartitions,
+        /// The bloom filter contains the keys of the left side, which a streamed left side does not hash
+        streamedSide == JoinBuildSideType::Left ? 0 : conf.hashJoinBloomFilterBitsPerKey.getValue(),
+        lateMaterialization,
+        streamedSide);
+    handler->setStateBufferProvider(createStateBufferProvider(conf));
 
 
     /// Building operator wrapper for the two builds and the probe.
@@ -364,7 +686,7 @@ LoweringRuleResultSubgraph LowerToPhysicalHashJoin::apply(LogicalOperator logica
 std::unique_ptr<AbstractLoweringRule>
 LoweringRuleGeneratedRegistrar::RegisterHashJoinLoweringRule(LoweringRuleRegistryArguments argument) /// NOLINT
 {
-    return std::make_unique<LowerToPhysicalHashJoin>(argument.conf);
+    return std::make_unique<LowerToPhysicalHashJoin>(argument.conf, argument.varSizedKeyDictionary);
 }
 
 }
@@ -0,0 +1,212 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+#include <LoweringRules/LowerToPhysical/LowerToPhysicalLookupJoin.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/BooleanFunctions/AndLogicalFunction.hpp>
+#include <Functions/BooleanFunctions/EqualsLogicalFunction.hpp>
+#include <Functions/CastToTypeLogicalFunction.hpp>
+#include <Functions/FieldAccessLogicalFunction.hpp>
+#include <Functions/FunctionProvider.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Functions/PhysicalFunction.hpp>
+#include <Join/LookupJoin/LookupJoinBuildPhysicalOperator.hpp>
+#include <Join/LookupJoin/LookupJoinOperatorHandler.hpp>
+#include <Join/LookupJoin/LookupJoinProbePhysicalOperator.hpp>
+#include <LoweringRules/AbstractLoweringRule.hpp>
+#include <Nautilus/Interface/BufferRef/LowerSchemaProvider.hpp>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedEntryMemoryProvider.hpp>
+#include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMap.hpp>
+#include <Nautilus/Interface/PagedVector/PagedVector.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Operators/LookupJoinLogicalOperator.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
+#include <Traits/MemoryLayoutTypeTrait.hpp>
+#include <Util/HashMapType.hpp>
+#include <Util/PlanRenderer.hpp>
+#include <ErrorHandling.hpp>
+#include <HashMapOptions.hpp>
+#include <LoweringRuleRegistry.hpp>
+#include <PhysicalOperator.hpp>
+
+namespace NES
+{
+
+namespace
+{
+/// The fields of the stream and of the table that an equality of the join function compares
+struct LookupJoinKey
+{
+    FieldAccessLogicalFunction streamField;
+    FieldAccessLogicalFunction tableField;
+};
+
+void collectLookupJoinKeys(
+    const LogicalFunction& joinFunction, const Schema& streamSchema, const Schema& tableSchema, std::vector<LookupJoinKey>& keys)
+{
+    if (joinFunction.tryGetAs<AndLogicalFunction>())
+    {
+        for (const auto& child : joinFunction.getChildren())
+        {
+            collectLookupJoinKeys(child, streamSchema, tableSchema, keys);
+        }
+        return;
+    }
+    const auto children = joinFunction.getChildren();
+    PRECONDITION(
+        joinFunction.tryGetAs<EqualsLogicalFunction>() and children.size() == 2,
+        "Expected the join function of a lookup join to be a conjunction of equalities");
+    const auto firstField = children.at(0).tryGetAs<FieldAccessLogicalFunction>();
+    const auto secondField = children.at(1).tryGetAs<FieldAccessLogicalFunction>();
+    PRECONDITION(firstField and secondField, "Expected the equalities of a lookup join to compare two fields");
+    if (streamSchema.contains(firstField->get().getFieldName()) and tableSchema.contains(secondField->get().getFieldName()))
+    {
+        keys.emplace_back(LookupJoinKey{.streamField = firstField->get(), .tableField = secondField->get()});
+    }
+    else if (streamSchema.contains(secondField->get().getFieldName()) and tableSchema.contains(firstField->get().getFieldName()))
+    {
+        keys.emplace_back(LookupJoinKey{.streamField = secondField->get(), .tableField = firstField->get()});
+    }
+    else
+    {
+        throw UnknownJoinStrategy(
+            "A lookup join can only compare a field of the stream with a field of the table, but got {}",
+            joinFunction.explain(ExplainVerbosity::Short));
+    }
+}
+
+/// Casts the key field to the type of the key of the hash index, if their types differ
+PhysicalFunction lowerKeyFunction(const FieldAccessLogicalFunction& keyField, const DataType& keyType)
+{
+    if (keyField.getDataType() == keyType)
+    {
+        return QueryCompilation::FunctionProvider::lowerFunction(keyField);
+    }
+    return QueryCompilation::FunctionProvider::lowerFunction(CastToTypeLogicalFunction(keyType, keyField));
+}
+}
+
+LoweringRuleResultSubgraph LowerToPhysicalLookupJoin::apply(LogicalOperator logicalOperator)
+{
+    PRECONDITION(logicalOperator.tryGetAs<LookupJoinLogicalOperator>(), "Expected a LookupJoinLogicalOperator");
+    PRECONDITION(logicalOperator.getChildren().size() == 2, "Expected two children");
+    const auto lookupJoin = logicalOperator.getAs<LookupJoinLogicalOperator>();
+    const auto memoryLayoutTypeTrait = logicalOperator.getTraitSet().tryGet<MemoryLayoutTypeTrait>();
+    PRECONDITION(memoryLayoutTypeTrait.has_value(), "Expected a memory layout type trait");
+    const auto memoryLayoutType = memoryLayoutTypeTrait.value()->memoryLayout;
+    const auto streamLayoutTypeTrait = logicalOperator.getChildren().at(0).getTraitSet().tryGet<MemoryLayoutTypeTrait>();
+    const auto tableLayoutTypeTrait = logicalOperator.getChildren().at(1).getTraitSet().tryGet<MemoryLayoutTypeTrait>();
+    PRECONDITION(streamLayoutTypeTrait.has_value() and tableLayoutTypeTrait.has_value(), "Expected the children to have a memory layout");
+    const auto streamLayoutType = streamLayoutTypeTrait.value()->memoryLayout;
+    const auto tableLayoutType = tableLayoutTypeTrait.value()->memoryLayout;
+
+    const auto streamSchema = lookupJoin->getLeftSchema();
+    const auto tableSchema = lookupJoin->getRightSchema();
+    const auto outputSchema = lookupJoin->getOutputSchema();
+    std::vector<LookupJoinKey> keys;
+    collectLookupJoinKeys(lookupJoin->getJoinFunction(), streamSchema, tableSchema, keys);
+
+    /// The hash index stores the keys under the names of the fields of the table in their common type with the fields of the stream
+    Schema keySchema;
+    std::vector<Record::RecordFieldIdentifier> keyNames;
+    std::vector<DataType> keyTypes;
+    std::vector<PhysicalFunction> streamKeyFunctions;
+    std::vector<PhysicalFunction> tableKeyFunctions;
+    uint64_t keySize = 0;
+    for (const auto& [streamField, tableField] : keys)
+    {
+        const auto keyType = streamField.getDataType().join(tableField.getDataType());
+        if (not keyType.has_value())
+        {
+            throw UnknownJoinStrategy(
+                "Cannot compare the key {} of the stream with the key {} of the table",
+                streamField.getFieldName(),
+                tableField.getFieldName());
+        }
+        keySchema.addField(tableField.getFieldName(), *keyType);
+        keyNames.emplace_back(tableField.getFieldName());
+        keyTypes.emplace_back(*keyType);
+        streamKeyFunctions.emplace_back(lowerKeyFunction(streamField, *keyType));
+        tableKeyFunctions.emplace_back(lowerKeyFunction(tableField, *keyType));
+        keySize += keyType->getSizeInBytesWithNull();
+    }
+
+    const auto pageSize = conf.pageSize.getValue();
+    const auto numberOfBuckets = conf.maxNumberOfBuckets.getValue();
+    constexpr auto valueSize = sizeof(PagedVector);
+    const auto entrySize = sizeof(ChainedHashMapEntry) + keySize + valueSize;
+    const auto entriesPerPage = pageSize / entrySize;
+    /// As the value of each entry is a paged vector of the records of the table, the hash index has no value fields
+    const auto& [fieldKeys, fieldValues] = ChainedEntryMemoryProvider::createFieldOffsets(keySchema, keyNames, {}, varSizedKeyDictionary);
+    const auto createHashMapOptions = [&](std::vector<PhysicalFunction> keyFunctions)
+    {
+        return HashMapOptions{
+            HashMapOptions::createHashFunction(conf.hashFunction.getValue(), keyTypes),
+            std::move(keyFunctions),
+            fieldKeys,
+            fieldValues,
+            entriesPerPage,
+            entrySize,
+            keySize,
+            valueSize,
+            pageSize,
+            numberOfBuckets,
+            HashMapType::CHAINED};
+    };
+
+    const auto tableBufferRef = LowerSchemaProvider::lowerSchema(
+        conf.numberOfRecordsPerKey.getValue() * tableSchema.getSizeOfSchemaInBytes(), tableSchema, MemoryLayoutType::ROW_LAYOUT);
+    const auto streamBufferRef = LowerSchemaProvider::lowerSchema(conf.operatorBufferSize.getValue(), streamSchema, streamLayoutType);
+    const auto handlerId = getNextOperatorHandlerId();
+    const auto handler = std::make_shared<LookupJoinOperatorHandler>(keySize, numberOfBuckets, pageSize);
+
+    /// The build ends the pipeline of the table, while the probe starts a pipeline that scans the buffers of the stream
+    auto buildWrapper = std::make_shared<PhysicalOperatorWrapper>(
+        LookupJoinBuildPhysicalOperator(handlerId, tableBufferRef, createHashMapOptions(std::move(tableKeyFunctions))),
+        tableSchema,
+        outputSchema,
+        tableLayoutType,
+        memoryLayoutType,
+        handlerId,
+        handler,
+        PhysicalOperatorWrapper::PipelineLocation::EMIT);
+    auto probeWrapper = std::make_shared<PhysicalOperatorWrapper>(
+        LookupJoinProbePhysicalOperator(handlerId, streamBufferRef, tableBufferRef, createHashMapOptions(std::move(streamKeyFunctions))),
+        streamSchema,
+        outputSchema,
+        streamLayoutType,
+        memoryLayoutType,
+        handlerId,
+        handler,
+        PhysicalOperatorWrapper::PipelineLocation::SCAN,
+        std::vector{buildWrapper});
+
+    return {.root = probeWrapper, .leafs = {probeWrapper, buildWrapper}};
+}
+
+std::unique_ptr<AbstractLoweringRule>
+LoweringRuleGeneratedRegistrar::RegisterLookupJoinLoweringRule(LoweringRuleRegistryArguments argument) /// NOLINT
+{
+    return std::make_unique<LowerToPhysicalLookupJoin>(argument.conf, argument.varSizedKeyDictionary);
+}
+
+}
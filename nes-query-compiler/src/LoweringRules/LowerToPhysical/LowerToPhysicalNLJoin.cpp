@@ -14,7 +14,10 @@
 
 #include <LoweringRules/LowerToPhysical/LowerToPhysicalNLJoin.hpp>
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
+#include <optional>
 #include <ranges>
 #include <string>
 #include <tuple>
@@ -23,23 +26,28 @@
 
 #include <DataTypes/Schema.hpp>
 #include <DataTypes/TimeUnit.hpp>
+#include <Functions/BatchKernels.hpp>
+#include <Functions/BooleanFunctions/AndLogicalFunction.hpp>
+#include <Functions/BooleanFunctions/AndPhysicalFunction.hpp>
 #include <Functions/FieldAccessLogicalFunction.hpp>
 #include <Functions/FieldAccessPhysicalFunction.hpp>
 #include <Functions/FunctionProvider.hpp>
 #include <Functions/LogicalFunction.hpp>
 #include <Identifiers/Identifiers.hpp>
 #include <Iterators/BFSIterator.hpp>
+#include <Join/IntervalJoin/IntervalJoinOperatorHandler.hpp>
+#include <Join/IntervalJoin/IntervalJoinPhysicalFunction.hpp>
 #include <Join/NestedLoopJoin/NLJBuildPhysicalOperator.hpp>
 #include <Join/NestedLoopJoin/NLJOperatorHandler.hpp>
 #include <Join/NestedLoopJoin/NLJProbePhysicalOperator.hpp>
 #include <Join/StreamJoinUtil.hpp>
 #include <LoweringRules/AbstractLoweringRule.hpp>
+#include <LoweringRules/SliceStoreProvider.hpp>
 #include <Nautilus/Interface/BufferRef/LowerSchemaProvider.hpp>
 #include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
 #include <Operators/LogicalOperator.hpp>
 #include <Operators/Windows/JoinLogicalOperator.hpp>
 #include <Runtime/Execution/OperatorHandler.hpp>
-#include <SliceStore/DefaultTimeBasedSliceStore.hpp>
 #include <Traits/MemoryLayoutTypeTrait.hpp>
 #include <Traits/OutputOriginIdsTrait.hpp>
 #include <Traits/TraitSet.hpp>
@@ -48,6 +56,7 @@
 #include <Watermark/TimeFunction.hpp>
 #include <Watermark/TimestampField.hpp>
 #include <WindowTypes/Measures/TimeCharacteristic.hpp>
+#include <WindowTypes/Types/IntervalWindow.hpp>
 #include <WindowTypes/Types/TimeBasedWindowType.hpp>
 #include <ErrorHandling.hpp>
 #include <LoweringRuleRegistry.hpp>
@@ -66,6 +75,51 @@ static auto getJoinFieldNames(const Schema& inputSchema, const LogicalFunction&
         | std::ranges::to<std::vector<std::string>>();
 };
 
+/// Picks a conjunct of the join function that compares a field of the left with a field of the right input. We prefer equalities over
+/// range comparisons, as they qualify fewer pairs for which the probe evaluates the whole join function.
+static std::optional<NLJKeyComparison>
+getKeyComparison(const Schema& leftInputSchema, const Schema& rightInputSchema, const LogicalFunction& joinFunction)
+{
+    std::vector<LogicalFunction> conjuncts{joinFunction};
+    std::optional<NLJKeyComparison> keyComparison;
+    while (not conjuncts.empty())
+    {
+        const auto conjunct = conjuncts.back();
+        conjuncts.pop_back();
+        if (conjunct.tryGetAs<AndLogicalFunction>())
+        {
+            std::ranges::copy(conjunct.getChildren(), std::back_inserter(conjuncts));
+            continue;
+        }
+        const auto comparison = QueryCompilation::FunctionProvider::lowerBatchComparison(conjunct);
+        if (not comparison.has_value())
+        {
+            continue;
+        }
+        const auto children = conjunct.getChildren();
+        const auto firstFieldName = children[0].tryGetAs<FieldAccessLogicalFunction>()->get().getFieldName();
+        const auto secondFieldName = children[1].tryGetAs<FieldAccessLogicalFunction>()->get().getFieldName();
+        NLJKeyComparison candidate{
+            .leftFieldName = firstFieldName,
+            .rightFieldName = secondFieldName,
+            .fieldType = children[0].getDataType().type,
+            .comparison = *comparison};
+        if (rightInputSchema.contains(firstFieldName) and leftInputSchema.contains(secondFieldName))
+        {
+            candidate = candidate.mirror();
+        }
+        else if (not leftInputSchema.contains(firstFieldName) or not rightInputSchema.contains(secondFieldName))
+        {
+            continue;
+        }
+        if (not keyComparison.has_value() or candidate.comparison == BatchComparison::EQUALS)
+        {
+            keyComparison = candidate;
+        }
+    }
+    return keyComparison;
+}
+
 LoweringRuleResultSubgraph LowerToPhysicalNLJoin::apply(LogicalOperator logicalOperator)
 {
     PRECONDITION(logicalOperator.tryGetAs<JoinLogicalOperator>(), "Expected a JoinLogicalOperator");
@@ -102,16 +156,66 @@ LoweringRuleResultSubgraph LowerToPhysicalNLJoin::apply(LogicalOperator logicalO
         | std::views::join | std::ranges::to<std::vector<OriginId>>();
 
     auto joinFunction = QueryCompilation::FunctionProvider::lowerFunction(logicalJoinFunction);
+    auto leftJoinFieldNames = getJoinFieldNames(leftInputSchema, logicalJoinFunction);
+    auto rightJoinFieldNames = getJoinFieldNames(rightInputSchema, logicalJoinFunction);
+    const auto intervalWindow = std::dynamic_pointer_cast<Windowing::IntervalWindow>(windowType);
+    const auto intervalJoinBounds = [&]() -> std::optional<IntervalJoinBounds>
+    {
+        if (not intervalWindow)
+        {
+            return std::nullopt;
+        }
+        return IntervalJoinBounds{
+            .lowerBound = intervalWindow->getLowerBound(),
+            .upperBound = intervalWindow->getUpperBound(),
+            .sliceLength = intervalWindow->getSlide().getTime(),
+            .offsetOfOwnedSlice = intervalWindow->getOffsetOfOwnedSlice()};
+    }();
+    if (intervalJoinBounds.has_value())
+    {
+        /// The probe compares the timestamps of the records, thus, it reads them together with the fields of the join function
+        const auto& timeCharacteristic = windowType->getTimeCharacteristic();
+        INVARIANT(
+            timeCharacteristic.getType() == Windowing::TimeCharacteristic::Type::EventTime, "An interval join requires event timestamps");
+        const auto timestampFieldName = timeCharacteristic.field.getUnqualifiedName();
+        const auto leftTimestampField = leftInputSchema.getFieldByName(timestampFieldName);
+        const auto rightTimestampField = rightInputSchema.getFieldByName(timestampFieldName);
+        INVARIANT(
+            leftTimestampField.has_value() and rightTimestampField.has_value(),
+            "Could not find timestampfieldname {} in both streams!",
+            timestampFieldName);
+        const auto addTimestampField = [](std::vector<std::string>& joinFieldNames, const std::string& timestampField)
+        {
+            if (std::ranges::find(joinFieldNames, timestampField) == joinFieldNames.end())
+            {
+                joinFieldNames.emplace_back(timestampField);
+            }
+        };
+        addTimestampField(leftJoinFieldNames, leftTimestampField->name);
+        addTimestampField(rightJoinFieldNames, rightTimestampField->name);
+        joinFunction = AndPhysicalFunction(
+            joinFunction,
+            IntervalJoinPhysicalFunction(
+                leftTimestampField->name,
+                rightTimestampField->name,
+                join->getWindowMetaData().windowStartFieldName,
+                timeCharacteristic.getTimeUnit().getMillisecondsConversionMultiplier(),
+                *intervalJoinBounds));
+    }
     auto leftBufferRef = LowerSchemaProvider::lowerSchema(pageSize, leftInputSchema, memoryLayoutType);
     auto rightBufferRef = LowerSchemaProvider::lowerSchema(pageSize, rightInputSchema, memoryLayoutType);
 
     auto [timeStampFieldLeft, timeStampFieldRight] = TimestampField::getTimestampLeftAndRight(*join, windowType);
 
-    auto leftBuildOperator
-        = NLJBuildPhysicalOperator(handlerId, JoinBuildSideType::Left, timeStampFieldLeft.toTimeFunction(), leftBufferRef);
+    auto leftBuildOperator = NLJBuildPhysicalOperator(
+        handlerId, JoinBuildSideType::Left, timeStampFieldLeft.toTimeFunction(), leftBufferRef, conf.compressPagedVectorPages.getValue());
 
-    auto rightBuildOperator
-        = NLJBuildPhysicalOperator(handlerId, JoinBuildSideType::Right, timeStampFieldRight.toTimeFunction(), rightBufferRef);
+    auto rightBuildOperator = NLJBuildPhysicalOperator(
+        handlerId,
+        JoinBuildSideType::Right,
+        timeStampFieldRight.toTimeFunction(),
+        rightBufferRef,
+        conf.compressPagedVectorPages.getValue());
 
     auto joinSchema = JoinSchema(leftInputSchema, rightInputSchema, outputSchema);
     auto probeOperator = NLJProbePhysicalOperator(
@@ -121,12 +225,15 @@ LoweringRuleResultSubgraph LowerToPhysicalNLJoin::apply(LogicalOperator logicalO
         joinSchema,
         leftBufferRef,
         rightBufferRef,
-        getJoinFieldNames(leftInputSchema, logicalJoinFunction),
-        getJoinFieldNames(rightInputSchema, logicalJoinFunction));
+        leftJoinFieldNames,
+        rightJoinFieldNames,
+        getKeyComparison(leftInputSchema, rightInputSchema, logicalJoinFunction));
 
-    auto sliceAndWindowStore
-        = std::make_unique<DefaultTimeBasedSliceStore>(windowType->getSize().getTime(), windowType->getSlide().getTime());
-    auto handler = std::make_shared<NLJOperatorHandler>(inputOriginIds, outputOriginId, std::move(sliceAndWindowStore));
+    auto sliceAndWindowStore = createSliceStore(*windowType);
+    const std::shared_ptr<NLJOperatorHandler> handler = intervalJoinBounds.has_value()
+        ? std::make_shared<IntervalJoinOperatorHandler>(inputOriginIds, outputOriginId, std::move(sliceAndWindowStore), *intervalJoinBounds)
+        : std::make_shared<NLJOperatorHandler>(inputOriginIds, outputOriginId, std::move(sliceAndWindowStore));
+    handler->setStateBufferProvider(createStateBufferProvider(conf));
 
     auto leftBuildWrapper = std::make_shared<PhysicalOperatorWrapper>(
         std::move(leftBuildOperator),
@@ -14,22 +14,29 @@
 
 #include <LoweringRules/LowerToPhysical/LowerToPhysicalProjection.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <memory>
 #include <optional>
 #include <ranges>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include <DataTypes/DataType.hpp>
 #include <DataTypes/Schema.hpp>
+#include <Functions/BatchUdfPhysicalFunction.hpp>
 #include <Functions/FunctionProvider.hpp>
 #include <LoweringRules/AbstractLoweringRule.hpp>
+#include <LoweringRules/ParameterBinding.hpp>
 #include <Nautilus/Interface/BufferRef/LowerSchemaProvider.hpp>
+#include <Nautilus/Interface/Record.hpp>
 #include <Operators/LogicalOperator.hpp>
 #include <Operators/ProjectionLogicalOperator.hpp>
 #include <Operators/Sources/SourceDescriptorLogicalOperator.hpp>
 #include <Traits/MemoryLayoutTypeTrait.hpp>
 #include <Util/PlanRenderer.hpp>
-#include <Util/Strings.hpp>
+#include <BatchUdfPhysicalOperator.hpp>
 #include <ErrorHandling.hpp>
 #include <InputFormatterTupleBufferRefProvider.hpp>
 #include <LoweringRuleRegistry.hpp>
@@ -52,20 +59,21 @@ createScanOperator(const NES::LogicalOperator& projectionOp, const size_t buffer
         | std::ranges::to<std::vector>();
     PRECONDITION(sourceOperators.size() < 2, "We expect a projection to have at most one source operator as a child.");
 
-    const auto memoryLayoutTypeTrait = projectionOp.getTraitSet().tryGet<NES::MemoryLayoutTypeTrait>();
+    /// The scan reads the tuple buffers that the child emits in its memory layout
+    PRECONDITION(projectionOp.getChildren().size() == 1, "Expected a projection to have exactly one child");
+    const auto memoryLayoutTypeTrait = projectionOp.getChildren().front().getTraitSet().tryGet<NES::MemoryLayoutTypeTrait>();
     PRECONDITION(memoryLayoutTypeTrait.has_value(), "Expected a memory layout type trait");
     const auto memoryLayoutType = memoryLayoutTypeTrait.value()->memoryLayout;
     const auto memoryProvider = NES::LowerSchemaProvider::lowerSchema(bufferSize, inputSchema, memoryLayoutType);
+    /// The scan only reads the fields that the projection accesses, e.g., the input formatter of a source skips parsing all other fields
+    const auto accessedFields = projectionOp.getAs<NES::ProjectionLogicalOperator>()->getAccessedFields();
     if (sourceOperators.size() == 1)
     {
         const auto inputFormatterConfig = sourceOperators.front().getParserConfig();
-        if (NES::toUpperCase(inputFormatterConfig.parserType) != "NATIVE")
-        {
-            return NES::ScanPhysicalOperator(
-                provideInputFormatterTupleBufferRef(inputFormatterConfig, memoryProvider), inputSchema.getFieldNames());
-        }
+        return NES::ScanPhysicalOperator(
+            provideInputFormatterTupleBufferRef(inputFormatterConfig, memoryProvider, accessedFields), accessedFields);
     }
-    return NES::ScanPhysicalOperator(memoryProvider, inputSchema.getFieldNames());
+    return NES::ScanPhysicalOperator(memoryProvider, accessedFields);
 }
 
 }
@@ -96,13 +104,42 @@ LoweringRuleResultSubgraph LowerToPhysicalProjection::apply(LogicalOperator proj
 
     auto child = scanWrapper;
 
+    /// The fields of the record after each map, which an operator that calls a batch UDF buffers
+    std::vector<std::pair<Record::RecordFieldIdentifier, DataType>> recordFields;
+    for (const auto& accessedField : projection->getAccessedFields())
+    {
+        if (const auto field = inputSchema.getFieldByName(accessedField))
+        {
+            recordFields.emplace_back(accessedField, field->dataType);
+        }
+    }
+
+    /// The parameters of a query template are bound to record fields right after the scan
+    const auto parameters = collectParameters(
+        projection->getProjections() | std::views::transform([](const auto& projected) { return projected.second; })
+        | std::ranges::to<std::vector>());
+    if (const auto binding = createParameterBinding(parameters, outputSchema, memoryLayoutType))
+    {
+        binding->addChild(child);
+        child = binding;
+        for (const auto& parameter : parameters)
+        {
+            recordFields.emplace_back(parameter.getFieldName(), parameter.getDataType());
+        }
+    }
+
     for (const auto& [fieldName, function] : projection->getProjections())
     {
         auto physicalFunction = QueryCompilation::FunctionProvider::lowerFunction(function);
-        auto physicalOperator = MapPhysicalOperator(
-            fieldName.transform([](const auto& identifier) { return identifier.getFieldName(); })
-                .value_or(function.explain(ExplainVerbosity::Short)),
-            physicalFunction);
+        const auto resultField = fieldName.transform([](const auto& identifier) { return identifier.getFieldName(); })
+                                     .value_or(function.explain(ExplainVerbosity::Short));
+        const auto batchUdf = physicalFunction.tryGetAs<BatchUdfPhysicalFunction>();
+        const auto canBufferRecord = std::ranges::none_of(
+            recordFields, [](const auto& recordField) { return recordField.second.isType(DataType::Type::VARSIZED); });
+        auto physicalOperator = batchUdf.has_value() and canBufferRecord
+            ? PhysicalOperator(BatchUdfPhysicalOperator(batchUdf->get(), resultField, recordFields))
+            : PhysicalOperator(MapPhysicalOperator(resultField, physicalFunction));
+        recordFields.emplace_back(resultField, function.getDataType());
         child = std::make_shared<PhysicalOperatorWrapper>(
             physicalOperator,
             outputSchema,
@@ -0,0 +1,130 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <LoweringRules/LowerToPhysical/LowerToPhysicalReservoirSample.hpp>
+
+#include <memory>
+#include <ranges>
+#include <vector>
+
+#include <Functions/FieldAccessPhysicalFunction.hpp>
+#include <LoweringRules/AbstractLoweringRule.hpp>
+#include <LoweringRules/SliceStoreProvider.hpp>
+#include <Nautilus/Interface/BufferRef/LowerSchemaProvider.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Operators/Windows/ReservoirSampleLogicalOperator.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
+#include <Sampling/ReservoirSampleBuildPhysicalOperator.hpp>
+#include <Sampling/ReservoirSampleOperatorHandler.hpp>
+#include <Sampling/ReservoirSampleProbePhysicalOperator.hpp>
+#include <Traits/MemoryLayoutTypeTrait.hpp>
+#include <Traits/OutputOriginIdsTrait.hpp>
+#include <Traits/TraitSet.hpp>
+#include <Watermark/TimeFunction.hpp>
+#include <WindowTypes/Measures/TimeCharacteristic.hpp>
+#include <WindowTypes/Types/TimeBasedWindowType.hpp>
+#include <magic_enum/magic_enum.hpp>
+#include <ErrorHandling.hpp>
+#include <LoweringRuleRegistry.hpp>
+#include <PhysicalOperator.hpp>
+
+namespace NES
+{
+
+namespace
+{
+std::unique_ptr<TimeFunction> getTimeFunction(const Windowing::TimeBasedWindowType& window)
+{
+    switch (window.getTimeCharacteristic().getType())
+    {
+        case Windowing::TimeCharacteristic::Type::IngestionTime: {
+            if (window.getTimeCharacteristic().field.name == Windowing::TimeCharacteristic::RECORD_CREATION_TS_FIELD_NAME)
+            {
+                return std::make_unique<IngestionTimeFunction>();
+            }
+            throw UnknownWindowType(
+                "The ingestion time field of a window must be: {}", Windowing::TimeCharacteristic::RECORD_CREATION_TS_FIELD_NAME);
+        }
+        case Windowing::TimeCharacteristic::Type::EventTime: {
+            const auto timeStampField = FieldAccessPhysicalFunction(window.getTimeCharacteristic().field.name);
+            return std::make_unique<EventTimeFunction>(timeStampField, window.getTimeCharacteristic().getTimeUnit());
+        }
+        default: {
+            throw UnknownWindowType("Unknown window type: {}", magic_enum::enum_name(window.getTimeCharacteristic().getType()));
+        }
+    }
+}
+}
+
+LoweringRuleResultSubgraph LowerToPhysicalReservoirSample::apply(LogicalOperator logicalOperator)
+{
+    PRECONDITION(logicalOperator.tryGetAs<ReservoirSampleLogicalOperator>(), "Expected a ReservoirSampleLogicalOperator");
+    PRECONDITION(logicalOperator.getChildren().size() == 1, "Expected one child");
+    const auto sample = logicalOperator.getAs<ReservoirSampleLogicalOperator>();
+    const auto outputOriginIds = getTrait<OutputOriginIdsTrait>(logicalOperator.getTraitSet());
+    const auto inputOriginIds = getTrait<OutputOriginIdsTrait>(logicalOperator.getChildren().front().getTraitSet());
+    PRECONDITION(outputOriginIds.has_value(), "Expected the outputOriginIds trait to be set");
+    PRECONDITION(inputOriginIds.has_value(), "Expected the inputOriginIds trait to be set");
+    PRECONDITION(std::ranges::size(outputOriginIds.value().get()) == 1, "Expected one output origin id");
+    const auto memoryLayoutTypeTrait = logicalOperator.getTraitSet().tryGet<MemoryLayoutTypeTrait>();
+    PRECONDITION(memoryLayoutTypeTrait.has_value(), "Expected a memory layout type trait");
+    const auto memoryLayoutType = memoryLayoutTypeTrait.value()->memoryLayout;
+    const auto windowType = sample->getWindowType();
+    const auto* const window = dynamic_cast<const Windowing::TimeBasedWindowType*>(windowType.get());
+    PRECONDITION(window != nullptr, "Expected the reservoir sample to use a time-based window");
+
+    const auto inputSchema = logicalOperator.getInputSchemas()[0];
+    const auto outputSchema = logicalOperator.getOutputSchema();
+    const auto bufferRef = LowerSchemaProvider::lowerSchema(conf.pageSize.getValue(), inputSchema, memoryLayoutType);
+    const auto handlerId = getNextOperatorHandlerId();
+    const auto handler = std::make_shared<ReservoirSampleOperatorHandler>(
+        inputOriginIds.value().get() | std::ranges::to<std::vector>(),
+        outputOriginIds.value().get()[0],
+        createSliceStore(*windowType),
+        sample->getSampleSize());
+    handler->setStateBufferProvider(createStateBufferProvider(conf));
+
+    auto buildWrapper = std::make_shared<PhysicalOperatorWrapper>(
+        ReservoirSampleBuildPhysicalOperator(handlerId, getTimeFunction(*window), bufferRef),
+        inputSchema,
+        outputSchema,
+        memoryLayoutType,
+        memoryLayoutType,
+        handlerId,
+        handler,
+        PhysicalOperatorWrapper::PipelineLocation::EMIT);
+
+    auto probeWrapper = std::make_shared<PhysicalOperatorWrapper>(
+        ReservoirSampleProbePhysicalOperator(handlerId, bufferRef),
+        inputSchema,
+        outputSchema,
+        memoryLayoutType,
+        memoryLayoutType,
+        handlerId,
+        handler,
+        PhysicalOperatorWrapper::PipelineLocation::SCAN,
+        std::vector{buildWrapper});
+
+    /// Creates a physical leaf for each logical leaf. Required, as this operator can have any number of sources.
+    std::vector leafes(logicalOperator.getChildren().size(), buildWrapper);
+    return {.root = probeWrapper, .leafs = {leafes}};
+}
+
+std::unique_ptr<AbstractLoweringRule>
+LoweringRuleGeneratedRegistrar::RegisterReservoirSampleLoweringRule(LoweringRuleRegistryArguments argument) /// NOLINT
+{
+    return std::make_unique<LowerToPhysicalReservoirSample>(argument.conf);
+}
+
+}
@@ -14,12 +14,29 @@
 
 #include <LoweringRules/LowerToPhysical/LowerToPhysicalSelection.hpp>
 
+#include <algorithm>
 #include <memory>
+#include <optional>
+#include <ranges>
+#include <utility>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/BatchKernels.hpp>
+#include <Functions/BatchUdfPhysicalFunction.hpp>
+#include <Functions/BooleanFunctions/AndLogicalFunction.hpp>
+#include <Functions/FieldAccessLogicalFunction.hpp>
 #include <Functions/FunctionProvider.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Iterators/BFSIterator.hpp>
 #include <LoweringRules/AbstractLoweringRule.hpp>
+#include <LoweringRules/ParameterBinding.hpp>
+#include <Nautilus/Interface/Record.hpp>
 #include <Operators/LogicalOperator.hpp>
 #include <Operators/SelectionLogicalOperator.hpp>
 #include <Traits/MemoryLayoutTypeTrait.hpp>
+#include <Util/ExecutionMode.hpp>
+#include <BatchUdfPhysicalOperator.hpp>
 #include <ErrorHandling.hpp>
 #include <LoweringRuleRegistry.hpp>
 #include <PhysicalOperator.hpp>
@@ -28,13 +45,118 @@
 namespace NES
 {
 
+namespace
+{
+void collectConjuncts(const LogicalFunction& function, std::vector<LogicalFunction>& conjuncts)
+{
+    if (function.tryGetAs<AndLogicalFunction>())
+    {
+        for (const auto& child : function.getChildren())
+        {
+            collectConjuncts(child, conjuncts);
+        }
+        return;
+    }
+    conjuncts.emplace_back(function);
+}
+
+/// Splits the predicate into conjuncts that can be evaluated batch-at-a-time and a residual function for all other conjuncts
+SelectionPhysicalOperator createVectorizedSelection(const LogicalFunction& predicate)
+{
+    std::vector<LogicalFunction> conjuncts;
+    collectConjuncts(predicate, conjuncts);
+
+    std::vector<BatchFilter> batchFilters;
+    std::optional<LogicalFunction> residual;
+    for (const auto& conjunct : conjuncts)
+    {
+        if (auto batchFilter = QueryCompilation::FunctionProvider::lowerBatchFilter(conjunct))
+        {
+            batchFilters.emplace_back(std::move(*batchFilter));
+            continue;
+        }
+        residual = residual ? LogicalFunction{AndLogicalFunction(*residual, conjunct)} : conjunct;
+    }
+
+    std::optional<PhysicalFunction> residualFunction;
+    if (residual)
+    {
+        residualFunction = QueryCompilation::FunctionProvider::lowerFunction(*residual);
+    }
+    return {QueryCompilation::FunctionProvider::lowerFunction(predicate), std::move(batchFilters), std::move(residualFunction)};
+}
+
+/// A predicate that is a batch UDF is evaluated once per batch of buffered records, unless the records contain VARSIZED fields
+std::optional<BatchUdfPhysicalOperator> createBatchUdfSelection(const LogicalFunction& predicate, const Schema& inputSchema)
+{
+    const auto batchUdf = QueryCompilation::FunctionProvider::lowerFunction(predicate).tryGetAs<BatchUdfPhysicalFunction>();
+    if (not batchUdf.has_value()
+        or std::ranges::any_of(inputSchema, [](const auto& field) { return field.dataType.isType(DataType::Type::VARSIZED); }))
+    {
+        return std::nullopt;
+    }
+    auto bufferedFields = inputSchema | std::views::transform([](const auto& field) { return std::make_pair(field.name, field.dataType); })
+        | std::ranges::to<std::vector>();
+    return BatchUdfPhysicalOperator(batchUdf->get(), std::nullopt, std::move(bufferedFields));
+}
+
+/// The interpreter profiles the conjuncts of the predicate, so that the compiled code evaluates the most selective conjuncts first
+SelectionPhysicalOperator createProfiledSelection(const LogicalFunction& predicate)
+{
+    std::vector<LogicalFunction> conjuncts;
+    collectConjuncts(predicate, conjuncts);
+    if (conjuncts.size() < 2 or conjuncts.size() > ConjunctProfile::MAX_NUMBER_OF_CONJUNCTS)
+    {
+        return SelectionPhysicalOperator(QueryCompilation::FunctionProvider::lowerFunction(predicate));
+    }
+    return {
+        QueryCompilation::FunctionProvider::lowerFunction(predicate),
+        conjuncts | std::views::transform(QueryCompilation::FunctionProvider::lowerFunction) | std::ranges::to<std::vector>()};
+}
+
+/// The distinct fields that the predicate reads, in the order of their first access
+std::vector<Record::RecordFieldIdentifier> getPredicateFields(const LogicalFunction& predicate)
+{
+    std::vector<Record::RecordFieldIdentifier> predicateFields;
+    for (const auto& function : BFSRange<LogicalFunction>(predicate))
+    {
+        if (const auto fieldAccess = function.tryGetAs<FieldAccessLogicalFunction>();
+            fieldAccess.has_value() and not std::ranges::contains(predicateFields, fieldAccess.value()->getFieldName()))
+        {
+            predicateFields.emplace_back(fieldAccess.value()->getFieldName());
+        }
+    }
+    return predicateFields;
+}
+}
+
 LoweringRuleResultSubgraph LowerToPhysicalSelection::apply(LogicalOperator logicalOperator)
 {
     PRECONDITION(logicalOperator.tryGetAs<SelectionLogicalOperator>(), "Expected a SelectionLogicalOperator");
     const auto selection = logicalOperator.getAs<SelectionLogicalOperator>();
     const auto function = selection->getPredicate();
-    const auto func = QueryCompilation::FunctionProvider::lowerFunction(function);
-    auto physicalOperator = SelectionPhysicalOperator(func);
+    auto physicalOperator = [&]() -> PhysicalOperator
+    {
+        if (auto batchUdfSelection = createBatchUdfSelection(function, logicalOperator.getInputSchemas()[0]))
+        {
+            return *batchUdfSelection;
+        }
+        auto selectionOperator = [&]
+        {
+            if (conf.executionMode.getValue() == ExecutionMode::VECTORIZED)
+            {
+                return createVectorizedSelection(function);
+            }
+            if (conf.executionMode.getValue() == ExecutionMode::TIERED and conf.numberOfProfiledBuffers.getValue() > 0)
+            {
+                return createProfiledSelection(function);
+            }
+            return SelectionPhysicalOperator(QueryCompilation::FunctionProvider::lowerFunction(function));
+        }();
+        /// Allows a scan that formats raw buffers to parse the other fields only for records that satisfy the predicate
+        selectionOperator.setPredicateFields(getPredicateFields(function));
+        return selectionOperator;
+    }();
     const auto memoryLayoutTypeTrait = logicalOperator.getTraitSet().tryGet<MemoryLayoutTypeTrait>();
     PRECONDITION(memoryLayoutTypeTrait.has_value(), "Expected a memory layout type trait");
     const auto memoryLayoutType = memoryLayoutTypeTrait.value()->memoryLayout;
@@ -46,6 +168,14 @@ LoweringRuleResultSubgraph LowerToPhysicalSelection::apply(LogicalOperator logic
         memoryLayoutType,
         PhysicalOperatorWrapper::PipelineLocation::INTERMEDIATE);
 
+    /// The parameters of a query template are bound to record fields right before the selection
+    if (const auto binding = createParameterBinding(collectParameters({function}), logicalOperator.getInputSchemas()[0], memoryLayoutType))
+    {
+        wrapper->addChild(binding);
+        std::vector leafes(logicalOperator.getChildren().size(), binding);
+        return {.root = wrapper, .leafs = {leafes}};
+    }
+
     /// Creates a physical leaf for each logical leaf. Required, as this operator can have any number of sources.
     std::vector leafes(logicalOperator.getChildren().size(), wrapper);
     return {.root = wrapper, .leafs = {leafes}};
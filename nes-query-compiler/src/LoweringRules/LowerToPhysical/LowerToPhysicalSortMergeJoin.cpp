@@ -0,0 +1,185 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <LoweringRules/LowerToPhysical/LowerToPhysicalSortMergeJoin.hpp>
+
+#include <memory>
+#include <ranges>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <DataTypes/Schema.hpp>
+#include <DataTypes/TimeUnit.hpp>
+#include <Functions/FieldAccessLogicalFunction.hpp>
+#include <Functions/FieldAccessPhysicalFunction.hpp>
+#include <Functions/FunctionProvider.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Iterators/BFSIterator.hpp>
+#include <Join/NestedLoopJoin/NLJBuildPhysicalOperator.hpp>
+#include <Join/NestedLoopJoin/NLJOperatorHandler.hpp>
+#include <Join/SortMergeJoin/SortMergeJoinProbePhysicalOperator.hpp>
+#include <Join/StreamJoinUtil.hpp>
+#include <LoweringRules/AbstractLoweringRule.hpp>
+#include <LoweringRules/SliceStoreProvider.hpp>
+#include <Nautilus/Interface/BufferRef/LowerSchemaProvider.hpp>
+#include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Operators/Windows/JoinLogicalOperator.hpp>
+#include <Phases/BandJoinPredicate.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
+#include <Traits/MemoryLayoutTypeTrait.hpp>
+#include <Traits/OutputOriginIdsTrait.hpp>
+#include <Traits/TraitSet.hpp>
+#include <Util/Common.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Watermark/TimeFunction.hpp>
+#include <Watermark/TimestampField.hpp>
+#include <WindowTypes/Measures/TimeCharacteristic.hpp>
+#include <WindowTypes/Types/TimeBasedWindowType.hpp>
+#include <ErrorHandling.hpp>
+#include <LoweringRuleRegistry.hpp>
+#include <PhysicalOperator.hpp>
+
+namespace NES
+{
+
+static auto getJoinFieldNames(const Schema& inputSchema, const LogicalFunction& joinFunction)
+{
+    return BFSRange(joinFunction)
+        | std::views::filter([](const auto& child) { return child.template tryGetAs<FieldAccessLogicalFunction>().has_value(); })
+        | std::views::transform([](const auto& child)
+                                { return child.template tryGetAs<FieldAccessLogicalFunction>()->get().getFieldName(); })
+        | std::views::filter([&](const auto& fieldName) { return inputSchema.contains(fieldName); })
+        | std::ranges::to<std::vector<std::string>>();
+};
+
+LoweringRuleResultSubgraph LowerToPhysicalSortMergeJoin::apply(LogicalOperator logicalOperator)
+{
+    PRECONDITION(logicalOperator.tryGetAs<JoinLogicalOperator>(), "Expected a JoinLogicalOperator");
+    PRECONDITION(std::ranges::size(logicalOperator.getChildren()) == 2, "Expected two children");
+    auto outputOriginIdsOpt = getTrait<OutputOriginIdsTrait>(logicalOperator.getTraitSet());
+    PRECONDITION(outputOriginIdsOpt.has_value(), "Expected the outputOriginIds trait to be set");
+    const auto& outputOriginIds = outputOriginIdsOpt.value().get();
+    PRECONDITION(std::ranges::size(outputOriginIdsOpt.value().get()) == 1, "Expected one output origin id");
+    PRECONDITION(logicalOperator.getInputSchemas().size() == 2, "Expected two input schemas");
+    const auto memoryLayoutTypeTrait = logicalOperator.getTraitSet().tryGet<MemoryLayoutTypeTrait>();
+    PRECONDITION(memoryLayoutTypeTrait.has_value(), "Expected a memory layout type trait");
+    const auto memoryLayoutType = memoryLayoutTypeTrait.value()->memoryLayout;
+
+    auto join = logicalOperator.getAs<JoinLogicalOperator>();
+    auto handlerId = getNextOperatorHandlerId();
+
+    auto leftInputSchema = join->getLeftSchema();
+    auto rightInputSchema = join->getRightSchema();
+    auto outputSchema = join.getOutputSchema();
+    auto outputOriginId = outputOriginIds[0];
+    auto logicalJoinFunction = join->getJoinFunction();
+    auto windowType = NES::as<Windowing::TimeBasedWindowType>(join->getWindowType());
+    const auto pageSize = conf.pageSize.getValue();
+
+    const auto inputOriginIds
+        = join.getChildren()
+        | std::views::transform(
+              [](const auto& child)
+              {
+                  auto childOutputOriginIds = getTrait<OutputOriginIdsTrait>(child.getTraitSet());
+                  PRECONDITION(childOutputOriginIds.has_value(), "Expected the outputOriginIds trait of the child to be set");
+                  return childOutputOriginIds.value().get();
+              })
+        | std::views::join | std::ranges::to<std::vector<OriginId>>();
+
+    auto joinFunction = QueryCompilation::FunctionProvider::lowerFunction(logicalJoinFunction);
+    auto leftBufferRef = LowerSchemaProvider::lowerSchema(pageSize, leftInputSchema, memoryLayoutType);
+    auto rightBufferRef = LowerSchemaProvider::lowerSchema(pageSize, rightInputSchema, memoryLayoutType);
+
+    auto [timeStampFieldLeft, timeStampFieldRight] = TimestampField::getTimestampLeftAndRight(*join, windowType);
+
+    auto leftBuildOperator = NLJBuildPhysicalOperator(
+        handlerId, JoinBuildSideType::Left, timeStampFieldLeft.toTimeFunction(), leftBufferRef, conf.compressPagedVectorPages.getValue());
+
+    auto rightBuildOperator = NLJBuildPhysicalOperator(
+        handlerId,
+        JoinBuildSideType::Right,
+        timeStampFieldRight.toTimeFunction(),
+        rightBufferRef,
+        conf.compressPagedVectorPages.getValue());
+
+    /// The sort-merge join reuses the build phase and the slices of the NLJ, only the probe sorts the tuples by the band predicate
+    const auto bandJoinPredicate = BandJoinPredicate::tryCreate(logicalJoinFunction, leftInputSchema, rightInputSchema);
+    PRECONDITION(bandJoinPredicate.has_value(), "Expected the join function {} to contain a band predicate", logicalJoinFunction);
+
+    auto joinSchema = JoinSchema(leftInputSchema, rightInputSchema, outputSchema);
+    auto probeOperator = SortMergeJoinProbePhysicalOperator(
+        handlerId,
+        joinFunction,
+        join->getWindowMetaData(),
+        joinSchema,
+        leftBufferRef,
+        rightBufferRef,
+        getJoinFieldNames(leftInputSchema, logicalJoinFunction),
+        getJoinFieldNames(rightInputSchema, logicalJoinFunction),
+        SortMergeJoinBand{
+            .leftFieldName = bandJoinPredicate->leftFieldName,
+            .rightFieldName = bandJoinPredicate->rightFieldName,
+            .rightIsLowerBoundedByLeft = bandJoinPredicate->rightIsLowerBoundedByLeft,
+            .rightIsUpperBoundedByLeft = bandJoinPredicate->rightIsUpperBoundedByLeft});
+
+    auto sliceAndWindowStore = createSliceStore(*windowType);
+    auto handler = std::make_shared<NLJOperatorHandler>(inputOriginIds, outputOriginId, std::move(sliceAndWindowStore));
+    handler->setStateBufferProvider(createStateBufferProvider(conf));
+
+    auto leftBuildWrapper = std::make_shared<PhysicalOperatorWrapper>(
+        std::move(leftBuildOperator),
+        leftInputSchema,
+        outputSchema,
+        memoryLayoutType,
+        memoryLayoutType,
+        handlerId,
+        handler,
+        PhysicalOperatorWrapper::PipelineLocation::EMIT);
+
+    auto rightBuildWrapper = std::make_shared<PhysicalOperatorWrapper>(
+        std::move(rightBuildOperator),
+        rightInputSchema,
+        outputSchema,
+        memoryLayoutType,
+        memoryLayoutType,
+        handlerId,
+        handler,
+        PhysicalOperatorWrapper::PipelineLocation::EMIT);
+
+    auto probeWrapper = std::make_shared<PhysicalOperatorWrapper>(
+        std::move(probeOperator),
+        outputSchema,
+        outputSchema,
+        memoryLayoutType,
+        memoryLayoutType,
+        handlerId,
+        handler,
+        PhysicalOperatorWrapper::PipelineLocation::SCAN,
+        std::vector{leftBuildWrapper, rightBuildWrapper});
+
+    return {.root = {probeWrapper}, .leafs = {leftBuildWrapper, rightBuildWrapper}};
+};
+
+std::unique_ptr<AbstractLoweringRule>
+LoweringRuleGeneratedRegistrar::RegisterSortMergeJoinLoweringRule(LoweringRuleRegistryArguments argument) /// NOLINT
+{
+    return std::make_unique<LowerToPhysicalSortMergeJoin>(argument.conf);
+}
+
+}
@@ -17,6 +17,7 @@
 #include <memory>
 #include <optional>
 #include <ranges>
+#include <utility>
 #include <vector>
 #include <LoweringRules/AbstractLoweringRule.hpp>
 #include <Operators/LogicalOperator.hpp>
@@ -41,12 +42,19 @@ LoweringRuleResultSubgraph LowerToPhysicalUnion::apply(LogicalOperator logicalOp
     const auto memoryLayoutTypeTrait = logicalOperator.getTraitSet().tryGet<MemoryLayoutTypeTrait>();
     PRECONDITION(memoryLayoutTypeTrait.has_value(), "Expected a memory layout type trait");
     const auto memoryLayoutType = memoryLayoutTypeTrait.value()->memoryLayout;
+    /// Inputs with the field names of the output, e.g., the physical sources of an expanded logical source, pass their records on as they
+    /// are. Thus, the union does not copy their records field by field.
     auto renames = inputSchemas
         | std::views::transform(
                        [&](const auto& schema)
                        {
+                           const auto inputFields = schema.getFieldNames();
+                           const auto outputFields = outputSchema.getFieldNames();
+                           auto rename = inputFields == outputFields
+                               ? PhysicalOperator(UnionPhysicalOperator())
+                               : PhysicalOperator(UnionRenamePhysicalOperator(inputFields, outputFields));
                            return std::make_shared<PhysicalOperatorWrapper>(
-                               UnionRenamePhysicalOperator(schema.getFieldNames(), outputSchema.getFieldNames()),
+                               std::move(rename),
                                schema,
                                outputSchema,
                                memoryLayoutType,
@@ -14,9 +14,16 @@
 
 #include <LoweringRules/LowerToPhysical/LowerToPhysicalWindowedAggregation.hpp>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <filesystem>
 #include <memory>
+#include <string>
 #include <numeric>
+#include <optional>
 #include <ranges>
 #include <utility>
 #include <vector>
@@ -25,25 +32,40 @@
 #include <Aggregation/AggregationOperatorHandler.hpp>
 #include <Aggregation/AggregationProbePhysicalOperator.hpp>
 #include <Aggregation/Function/AggregationPhysicalFunction.hpp>
+#include <Aggregation/Function/SharedStateAggregationPhysicalFunction.hpp>
+#include <DataTypes/DataType.hpp>
 #include <DataTypes/DataTypeProvider.hpp>
 #include <Functions/FieldAccessPhysicalFunction.hpp>
 #include <Functions/FunctionProvider.hpp>
 #include <Functions/PhysicalFunction.hpp>
+#include <Identifiers/Identifiers.hpp>
 #include <LoweringRules/AbstractLoweringRule.hpp>
+#include <LoweringRules/SliceStoreProvider.hpp>
 #include <Nautilus/Interface/BufferRef/LowerSchemaProvider.hpp>
-#include <Nautilus/Interface/Hash/MurMur3HashFunction.hpp>
 #include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedEntryMemoryProvider.hpp>
 #include <Nautilus/Interface/HashMap/ChainedHashMap/ChainedHashMap.hpp>
 #include <Nautilus/Interface/Record.hpp>
 #include <Operators/LogicalOperator.hpp>
+#include <Operators/Windows/Aggregations/ApproximateQuantileAggregationLogicalFunction.hpp>
+#include <Operators/Windows/Aggregations/AvgAggregationLogicalFunction.hpp>
+#include <Operators/Windows/Aggregations/CountAggregationLogicalFunction.hpp>
+#include <Operators/Windows/Aggregations/MaxAggregationLogicalFunction.hpp>
+#include <Operators/Windows/Aggregations/MinAggregationLogicalFunction.hpp>
+#include <Operators/Windows/Aggregations/SumAggregationLogicalFunction.hpp>
+#include <Operators/Windows/Aggregations/WindowAggregationLogicalFunction.hpp>
 #include <Operators/Windows/WindowedAggregationLogicalOperator.hpp>
 #include <Runtime/Execution/OperatorHandler.hpp>
-#include <SliceStore/DefaultTimeBasedSliceStore.hpp>
+#include <Traits/ClusteredFieldsTrait.hpp>
 #include <Traits/MemoryLayoutTypeTrait.hpp>
 #include <Traits/OutputOriginIdsTrait.hpp>
+#include <Traits/SharedWindowSizesTrait.hpp>
 #include <Traits/TraitSet.hpp>
+#include <Util/HashMapType.hpp>
+#include <Util/Logger/Logger.hpp>
 #include <Watermark/TimeFunction.hpp>
 #include <WindowTypes/Measures/TimeCharacteristic.hpp>
+#include <WindowTypes/Types/CountBasedWindowType.hpp>
+#include <WindowTypes/Types/SessionWindow.hpp>
 #include <WindowTypes/Types/TimeBasedWindowType.hpp>
 #include <magic_enum/magic_enum.hpp>
 #include <AggregationPhysicalFunctionRegistry.hpp>
@@ -75,12 +97,18 @@ getKeyAndValueFields(const WindowedAggregationLogicalOperator& logicalOperator)
     return {fieldKeyNames, fieldValueNames};
 }
 
-static std::unique_ptr<TimeFunction> getTimeFunction(const WindowedAggregationLogicalOperator& logicalOperator)
+static std::unique_ptr<TimeFunction> getTimeFunction(const WindowedAggregationLogicalOperator& logicalOperator, OperatorHandlerId handlerId)
 {
+    /// Count-based windows use the positions of the records, which are assigned by the operator handler
+    if (dynamic_cast<Windowing::CountBasedWindowType*>(logicalOperator.getWindowType().get()) != nullptr)
+    {
+        return std::make_unique<CountTimeFunction>(handlerId);
+    }
+
     auto* const timeWindow = dynamic_cast<Windowing::TimeBasedWindowType*>(logicalOperator.getWindowType().get());
     if (timeWindow == nullptr)
     {
-        throw UnknownWindowType("Window type is not a time based window type");
+        throw UnknownWindowType("Window type is neither a time based nor a count based window type");
     }
 
     switch (timeWindow->getTimeCharacteristic().getType())
@@ -107,6 +135,115 @@ static std::unique_ptr<TimeFunction> getTimeFunction(const WindowedAggregationLo
 
 namespace
 {
+/// Returns true, if both aggregations compute the same result from the same input. Thus, one of them can lower the state of the other.
+bool computeSameAggregate(const WindowAggregationLogicalFunction& aggregation, const WindowAggregationLogicalFunction& other)
+{
+    constexpr std::array sharableAggregations{
+        SumAggregationLogicalFunction::NAME,
+        CountAggregationLogicalFunction::NAME,
+        AvgAggregationLogicalFunction::NAME,
+        MinAggregationLogicalFunction::NAME,
+        MaxAggregationLogicalFunction::NAME};
+    return std::ranges::find(sharableAggregations, aggregation.getName()) != sharableAggregations.end()
+        and aggregation.getName() == other.getName() and aggregation.getOnField().getFieldName() == other.getOnField().getFieldName()
+        and aggregation.getOnField().getDataType() == other.getOnField().getDataType()
+        and aggregation.getAsField().getDataType() == other.getAsField().getDataType()
+        and aggregation.shallIncludeNullValues() == other.shallIncludeNullValues();
+}
+
+/// Returns the offset of the part of the state of AVG, which the aggregation would compute in its own state. For a non-nullable input,
+/// SUM(a) computes the sum of AVG(a) and a COUNT that counts every record computes the count of AVG(a).
+std::optional<size_t> getOffsetInAvgState(const WindowAggregationLogicalFunction& aggregation, const WindowAggregationLogicalFunction& avg)
+{
+    const auto avgInputType = avg.getOnField().getDataType();
+    if (avg.getName() != AvgAggregationLogicalFunction::NAME or avgInputType.nullable)
+    {
+        return std::nullopt;
+    }
+    if (aggregation.getName() == SumAggregationLogicalFunction::NAME
+        and aggregation.getOnField().getFieldName() == avg.getOnField().getFieldName()
+        and aggregation.getOnField().getDataType() == avgInputType)
+    {
+        return 0;
+    }
+    const auto countsAllRecords = not aggregation.getOnField().getDataType().nullable or aggregation.shallIncludeNullValues();
+    const auto countType = DataTypeProvider::provideDataType(DataType::Type::UINT64, DataType::NULLABLE::NOT_NULLABLE);
+    if (aggregation.getName() == CountAggregationLogicalFunction::NAME and countsAllRecords
+        and aggregation.getAsField().getDataType() == countType)
+    {
+        return avgInputType.getSizeInBytesWithoutNull();
+    }
+    return std::nullopt;
+}
+
+/// Lets every aggregation, whose state is equal to (a part of) the state of another aggregation, lower the state of the other aggregation.
+/// Thus, lift, combine and reset update every state once per record, e.g., for SUM(a), COUNT(a) and AVG(a). The shared aggregations come
+/// first, so that all of their empty states are at the start of the aggregation states, followed by the owned states one after another.
+std::vector<std::shared_ptr<AggregationPhysicalFunction>> shareAggregationStates(
+    const std::vector<std::shared_ptr<WindowAggregationLogicalFunction>>& aggregationDescriptors,
+    const std::vector<std::shared_ptr<AggregationPhysicalFunction>>& aggregationPhysicalFunctions)
+{
+    /// The aggregation that owns the shared state of an aggregation and the offset of the shared part in the owned state
+    std::vector<std::optional<std::pair<size_t, size_t>>> sharedStates(aggregationDescriptors.size());
+    for (size_t aggregation = 0; aggregation < aggregationDescriptors.size(); ++aggregation)
+    {
+        for (size_t other = 0; other < aggregationDescriptors.size() and not sharedStates[aggregation].has_value(); ++other)
+        {
+            if (const auto offset = getOffsetInAvgState(*aggregationDescriptors[aggregation], *aggregationDescriptors[other]))
+            {
+                sharedStates[aggregation] = {other, offset.value()};
+            }
+        }
+    }
+    for (size_t aggregation = 0; aggregation < aggregationDescriptors.size(); ++aggregation)
+    {
+        for (size_t other = 0; other < aggregation and not sharedStates[aggregation].has_value(); ++other)
+        {
+            if (not sharedStates[other].has_value()
+                and computeSameAggregate(*aggregationDescriptors[aggregation], *aggregationDescriptors[other]))
+            {
+                sharedStates[aggregation] = {other, 0};
+            }
+        }
+    }
+    /// An aggregation might share the state of an AVG, which shares the state of the same AVG before it
+    for (auto& sharedState : sharedStates)
+    {
+        while (sharedState.has_value() and sharedStates[sharedState->first].has_value())
+        {
+            sharedState = {sharedStates[sharedState->first]->first, sharedState->second + sharedStates[sharedState->first]->second};
+        }
+    }
+
+    std::vector<size_t> offsetsOfOwnedStates(aggregationPhysicalFunctions.size());
+    size_t sizeOfOwnedStates = 0;
+    std::vector<std::shared_ptr<AggregationPhysicalFunction>> ownedStateFunctions;
+    for (size_t aggregation = 0; aggregation < aggregationPhysicalFunctions.size(); ++aggregation)
+    {
+        if (not sharedStates[aggregation].has_value())
+        {
+            offsetsOfOwnedStates[aggregation] = sizeOfOwnedStates;
+            sizeOfOwnedStates += aggregationPhysicalFunctions[aggregation]->getSizeOfStateInBytes();
+            ownedStateFunctions.push_back(aggregationPhysicalFunctions[aggregation]);
+        }
+    }
+    std::vector<std::shared_ptr<AggregationPhysicalFunction>> sharedStateFunctions;
+    for (size_t aggregation = 0; aggregation < aggregationPhysicalFunctions.size(); ++aggregation)
+    {
+        if (const auto& sharedState = sharedStates[aggregation])
+        {
+            const auto& onField = aggregationDescriptors[aggregation]->getOnField();
+            sharedStateFunctions.push_back(std::make_shared<SharedStateAggregationPhysicalFunction>(
+                aggregationPhysicalFunctions[aggregation],
+                onField.getDataType(),
+                QueryCompilation::FunctionProvider::lowerFunction(onField),
+                offsetsOfOwnedStates[sharedState->first] + sharedState->second));
+        }
+    }
+    sharedStateFunctions.insert(sharedStateFunctions.end(), ownedStateFunctions.begin(), ownedStateFunctions.end());
+    return sharedStateFunctions;
+}
+
 std::vector<std::shared_ptr<AggregationPhysicalFunction>>
 getAggregationPhysicalFunctions(const WindowedAggregationLogicalOperator& logicalOperator, const QueryExecutionConfiguration& configuration)
 {
@@ -125,6 +262,12 @@ getAggregationPhysicalFunctions(const WindowedAggregationLogicalOperator& logica
         auto bufferRef
             = LowerSchemaProvider::lowerSchema(configuration.pageSize.getValue(), logicalOperator.getInputSchemas()[0], memoryLayoutType);
 
+        std::optional<double> quantile;
+        if (const auto quantileAggregation = descriptor->tryGetAs<ApproximateQuantileAggregationLogicalFunction>())
+        {
+            quantile = quantileAggregation.value()->getQuantile();
+        }
+
         auto name = descriptor->getName();
         auto aggregationArguments = AggregationPhysicalFunctionRegistryArguments(
             std::move(physicalInputType),
@@ -132,7 +275,9 @@ getAggregationPhysicalFunctions(const WindowedAggregationLogicalOperator& logica
             std::move(aggregationInputFunction),
             resultFieldIdentifier,
             bufferRef,
-            descriptor->shallIncludeNullValues());
+            descriptor->shallIncludeNullValues(),
+            quantile,
+            configuration.compressPagedVectorPages.getValue());
         if (auto aggregationPhysicalFunction
             = AggregationPhysicalFunctionRegistry::instance().create(std::string(name), std::move(aggregationArguments)))
         {
@@ -143,7 +288,7 @@ getAggregationPhysicalFunctions(const WindowedAggregationLogicalOperator& logica
             throw UnknownAggregationType("unknown aggregation type: {}", name);
         }
     }
-    return aggregationPhysicalFunctions;
+    return shareAggregationStates(aggregationDescriptors, aggregationPhysicalFunctions);
 }
 }
 
@@ -168,9 +313,8 @@ LoweringRuleResultSubgraph LowerToPhysicalWindowedAggregation::apply(LogicalOper
     auto outputSchema = aggregation.getOutputSchema();
     auto outputOriginId = outputOriginIds[0];
     auto inputOriginIds = inputOriginIdsOpt.value().get();
-    auto timeFunction = getTimeFunction(*aggregation);
-    auto windowType = std::dynamic_pointer_cast<Windowing::TimeBasedWindowType>(aggregation->getWindowType());
-    INVARIANT(windowType != nullptr, "Window type must be a time-based window type");
+    auto timeFunction = getTimeFunction(*aggregation, handlerId);
+    const auto windowType = aggregation->getWindowType();
     auto aggregationPhysicalFunctions = getAggregationPhysicalFunctions(*aggregation, conf);
 
     const auto valueSize = std::accumulate(
@@ -180,31 +324,36 @@ LoweringRuleResultSubgraph LowerToPhysicalWindowedAggregation::apply(LogicalOper
         [](const auto& sum, const auto& function) { return sum + function->getSizeOfStateInBytes(); });
 
     uint64_t keySize = 0;
+    bool hasVarSizedKeys = false;
     std::vector<PhysicalFunction> keyFunctions;
+    std::vector<DataType> keyTypes;
     auto newInputSchema = aggregation.getInputSchemas()[0];
     for (auto& nodeFunctionKey : aggregation->getGroupingKeys())
     {
         auto loweredFunctionType = nodeFunctionKey.getDataType();
         if (loweredFunctionType.isType(DataType::Type::VARSIZED))
         {
+            hasVarSizedKeys = true;
             const bool fieldReplaceSuccess = newInputSchema.replaceTypeOfField(nodeFunctionKey.getFieldName(), loweredFunctionType);
             INVARIANT(fieldReplaceSuccess, "Expect to change the type of {} for {}", nodeFunctionKey.getFieldName(), newInputSchema);
         }
         keyFunctions.emplace_back(QueryCompilation::FunctionProvider::lowerFunction(nodeFunctionKey));
         keySize += loweredFunctionType.getSizeInBytesWithNull();
+        keyTypes.emplace_back(std::move(loweredFunctionType));
     }
     const auto entrySize = sizeof(ChainedHashMapEntry) + keySize + valueSize;
-    const auto numberOfBuckets = conf.numberOfPartitions.getValue();
+    const auto numberOfBuckets = conf.maxNumberOfBuckets.getValue();
     const auto pageSize = conf.pageSize.getValue();
     const auto entriesPerPage = pageSize / entrySize;
 
     const auto& [fieldKeyNames, fieldValueNames] = getKeyAndValueFields(*aggregation);
-    const auto& [fieldKeys, fieldValues] = ChainedEntryMemoryProvider::createFieldOffsets(newInputSchema, fieldKeyNames, fieldValueNames);
+    const auto& [fieldKeys, fieldValues]
+        = ChainedEntryMemoryProvider::createFieldOffsets(newInputSchema, fieldKeyNames, fieldValueNames, varSizedKeyDictionary);
 
     const auto windowMetaData = WindowMetaData{aggregation->getWindowStartFieldName(), aggregation->getWindowEndFieldName()};
 
     const HashMapOptions hashMapOptions(
-        std::make_unique<MurMur3HashFunction>(),
+        HashMapOptions::createHashFunction(conf.hashFunction.getValue(), keyTypes),
         keyFunctions,
         fieldKeys,
         fieldValues,
@@ -213,14 +362,89 @@ LoweringRuleResultSubgraph LowerToPhysicalWindowedAggregation::apply(LogicalOper
         keySize,
         valueSize,
         pageSize,
-        numberOfBuckets);
+        numberOfBuckets,
+        conf.hashMapType.getValue());
 
-    auto sliceAndWindowStore
-        = std::make_unique<DefaultTimeBasedSliceStore>(windowType->getSize().getTime(), windowType->getSlide().getTime());
+    /// The windows of shared window sizes overlap, which the shared sliding window aggregates do not support. Late records would update
+    /// the slices after they have been combined into the shared sliding window aggregates.
+    const auto sharedWindowSizes = logicalOperator.getTraitSet().tryGet<SharedWindowSizesTrait>();
+    const auto allowedLateness = aggregation->getAllowedLatenessInMs();
+    auto sliceAndWindowStore = sharedWindowSizes.has_value()
+        ? createSharedSliceStore(sharedWindowSizes.value()->windowSizes, allowedLateness)
+        : createSliceStore(*windowType, allowedLateness);
+    /// A global aggregation has a single key. Thus, partitioning its hash maps would solely create empty partitions.
+    /// The probe selects the top-k records of a window among all of its keys, which requires a single partition.
+    const auto& topK = aggregation->getTopK();
+    const auto numberOfPartitions
+        = keyFunctions.empty() or topK.has_value() ? uint64_t{1} : std::max<uint64_t>(conf.numberOfPartitions.getValue(), 1);
+    std::optional<std::chrono::milliseconds> earlyResultInterval;
+    if (const auto earlyResultIntervalInMs = aggregation->getEarlyResultIntervalInMs())
+    {
+        earlyResultInterval = std::chrono::milliseconds(earlyResultIntervalInMs.value());
+    }
     auto handler = std::make_shared<AggregationOperatorHandler>(
-        inputOriginIds | std::ranges::to<std::vector>(), outputOriginId, std::move(sliceAndWindowStore), conf.maxNumberOfBuckets);
-    auto build = AggregationBuildPhysicalOperator(handlerId, std::move(timeFunction), aggregationPhysicalFunctions, hashMapOptions);
-    auto probe = AggregationProbePhysicalOperator(hashMapOptions, aggregationPhysicalFunctions, handlerId, windowMetaData);
+        inputOriginIds | std::ranges::to<std::vector>(),
+        outputOriginId,
+        std::move(sliceAndWindowStore),
+        conf.maxNumberOfBuckets,
+        numberOfPartitions,
+        conf.shareSlidingWindowAggregates.getValue() and not sharedWindowSizes.has_value() and not allowedLateness.has_value(),
+        earlyResultInterval);
+    handler->setStateBufferProvider(createStateBufferProvider(conf));
+    /// The checkpoints copy the pages of the chained hash maps. Thus, the keys and the aggregation states must not point to other memory.
+    /// The positions of the records of count-based windows restart with the query, which would not match the restored slices.
+    const auto isCountBasedWindow = dynamic_cast<Windowing::CountBasedWindowType*>(windowType.get()) != nullptr;
+    if (isCountBasedWindow)
+    {
+        handler->setCountBasedWindows();
+    }
+    const auto isSessionWindow = dynamic_cast<Windowing::SessionWindow*>(windowType.get()) != nullptr;
+    if (const auto& checkpointDirectory = conf.windowStateCheckpointDirectory.getValue(); not checkpointDirectory.empty())
+    {
+        const auto checkpointable = conf.hashMapType.getValue() == HashMapType::CHAINED and not isSessionWindow and not isCountBasedWindow
+            and not hasVarSizedKeys
+            and std::ranges::all_of(aggregationPhysicalFunctions, [](const auto& function) { return function->isStateSelfContained(); });
+        if (conf.windowStateCheckpointInterval.getValue() == 0)
+        {
+            throw InvalidConfigParameter("The window_state_checkpoint_interval must be positive");
+        }
+        if (checkpointable)
+        {
+            handler->enableCheckpoints(
+                std::filesystem::path(checkpointDirectory) / ("aggregation-" + std::to_string(outputOriginId.getRawValue())),
+                std::chrono::milliseconds(conf.windowStateCheckpointInterval.getValue()));
+        }
+        else
+        {
+            NES_WARNING("The aggregation with the output origin {} does not support checkpoints of its state", outputOriginId);
+        }
+    }
+    /// If the input arrives in runs of equal keys, the records of a run reuse the entry of their predecessor, which supersedes the
+    /// pre-aggregation. The pre-aggregation would clear this entry when it moves to the next slice.
+    const auto clusteredFields = logicalOperator.getChildren().at(0).getTraitSet().tryGet<ClusteredFieldsTrait>();
+    const auto clusteredKeys = clusteredFields.has_value() and clusteredFields.value()->clusters(aggregation->getGroupByKeyNames());
+    /// The slices of session windows get merged, while a worker thread could still pre-aggregate records for them
+    const auto preAggregation = conf.preAggregation.getValue() and numberOfPartitions == 1 and not isSessionWindow and not clusteredKeys;
+    auto build = AggregationBuildPhysicalOperator(
+        handlerId,
+        std::move(timeFunction),
+        aggregationPhysicalFunctions,
+        hashMapOptions,
+        numberOfPartitions,
+        preAggregation,
+        earlyResultInterval.has_value() or handler->takesCheckpoints() or handler->acceptsLateRecords(),
+        handler->acceptsLateRecords(),
+        clusteredKeys);
+    std::optional<AggregationProbeTopK> probeTopK;
+    if (topK.has_value())
+    {
+        probeTopK = AggregationProbeTopK{
+            .orderFieldName = topK->orderField.getFieldName(),
+            .orderFieldType = topK->orderField.getDataType(),
+            .ascending = topK->ascending,
+            .limit = topK->limit};
+    }
+    auto probe = AggregationProbePhysicalOperator(hashMapOptions, aggregationPhysicalFunctions, handlerId, windowMetaData, probeTopK);
 
     auto buildWrapper = std::make_shared<PhysicalOperatorWrapper>(
         build,
@@ -251,6 +475,6 @@ LoweringRuleResultSubgraph LowerToPhysicalWindowedAggregation::apply(LogicalOper
 std::unique_ptr<AbstractLoweringRule>
 LoweringRuleGeneratedRegistrar::RegisterWindowedAggregationLoweringRule(LoweringRuleRegistryArguments argument) /// NOLINT
 {
-    return std::make_unique<LowerToPhysicalWindowedAggregation>(argument.conf);
+    return std::make_unique<LowerToPhysicalWindowedAggregation>(argument.conf, argument.varSizedKeyDictionary);
 }
 }
@@ -0,0 +1,88 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <LoweringRules/ParameterBinding.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <vector>
+#include <DataTypes/Schema.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Functions/ParameterLogicalFunction.hpp>
+#include <Iterators/BFSIterator.hpp>
+#include <Nautilus/Interface/BufferRef/LowerSchemaProvider.hpp>
+#include <Runtime/Execution/OperatorHandler.hpp>
+#include <ParameterBindingPhysicalOperator.hpp>
+#include <ParameterOperatorHandler.hpp>
+#include <PhysicalOperator.hpp>
+
+namespace NES
+{
+
+std::vector<ParameterLogicalFunction> collectParameters(const std::vector<LogicalFunction>& functions)
+{
+    std::vector<ParameterLogicalFunction> parameters;
+    for (const auto& root : functions)
+    {
+        for (const auto& function : BFSRange<LogicalFunction>(root))
+        {
+            if (const auto parameter = function.tryGetAs<ParameterLogicalFunction>(); parameter.has_value()
+                and std::ranges::none_of(
+                    parameters, [&](const auto& collected) { return collected.getIndex() == parameter.value()->getIndex(); }))
+            {
+                parameters.emplace_back(parameter.value().get());
+            }
+        }
+    }
+    return parameters;
+}
+
+std::shared_ptr<PhysicalOperatorWrapper> createParameterBinding(
+    const std::vector<ParameterLogicalFunction>& parameters, const Schema& inputSchema, const MemoryLayoutType memoryLayoutType)
+{
+    if (parameters.empty())
+    {
+        return nullptr;
+    }
+    const auto handlerId = getNextOperatorHandlerId();
+    const auto handler = std::make_shared<ParameterOperatorHandler>(
+        parameters
+        | std::views::transform(
+            [](const auto& parameter)
+            { return ParameterOperatorHandler::Parameter{.dataType = parameter.getDataType(), .value = parameter.getValue()}; })
+        | std::ranges::to<std::vector>());
+    auto binding = ParameterBindingPhysicalOperator(
+        handlerId,
+        parameters
+            | std::views::transform(
+                [](const auto& parameter)
+                {
+                    return ParameterBindingPhysicalOperator::Parameter{
+                        .fieldName = parameter.getFieldName(), .dataType = parameter.getDataType()};
+                })
+            | std::ranges::to<std::vector>());
+    return std::make_shared<PhysicalOperatorWrapper>(
+        binding,
+        inputSchema,
+        inputSchema,
+        memoryLayoutType,
+        memoryLayoutType,
+        handlerId,
+        handler,
+        PhysicalOperatorWrapper::PipelineLocation::INTERMEDIATE);
+}
+
+}
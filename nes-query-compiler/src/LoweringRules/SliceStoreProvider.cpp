@@ -0,0 +1,82 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <LoweringRules/SliceStoreProvider.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <vector>
+#include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/Allocator/SpillFileMemoryResource.hpp>
+#include <Runtime/BufferManager.hpp>
+#include <SliceStore/DefaultTimeBasedSliceStore.hpp>
+#include <SliceStore/SessionSliceStore.hpp>
+#include <SliceStore/SliceAssigner.hpp>
+#include <SliceStore/WindowSlicesStoreInterface.hpp>
+#include <WindowTypes/Types/CountBasedWindowType.hpp>
+#include <WindowTypes/Types/SessionWindow.hpp>
+#include <WindowTypes/Types/TimeBasedWindowType.hpp>
+#include <WindowTypes/Types/WindowType.hpp>
+#include <ErrorHandling.hpp>
+#include <QueryExecutionConfiguration.hpp>
+
+namespace NES
+{
+
+std::unique_ptr<WindowSlicesStoreInterface>
+createSliceStore(const Windowing::WindowType& windowType, const std::optional<uint64_t> allowedLateness)
+{
+    if (const auto* sessionWindow = dynamic_cast<const Windowing::SessionWindow*>(&windowType))
+    {
+        return std::make_unique<SessionSliceStore>(sessionWindow->getGap().getTime());
+    }
+    if (const auto* timeBasedWindow = dynamic_cast<const Windowing::TimeBasedWindowType*>(&windowType))
+    {
+        return std::make_unique<DefaultTimeBasedSliceStore>(
+            timeBasedWindow->getSize().getTime(), timeBasedWindow->getSlide().getTime(), allowedLateness);
+    }
+    /// The slices of count-based windows are built over the positions of the records. Thus, the slice store works on positions instead of
+    /// timestamps, which requires no change to the slice store.
+    if (const auto* countBasedWindow = dynamic_cast<const Windowing::CountBasedWindowType*>(&windowType))
+    {
+        return std::make_unique<DefaultTimeBasedSliceStore>(countBasedWindow->getSize(), countBasedWindow->getSlide());
+    }
+    throw UnknownWindowType("Cannot create a slice store for the window type {}", windowType.toString());
+}
+
+std::unique_ptr<WindowSlicesStoreInterface>
+createSharedSliceStore(const std::vector<uint64_t>& windowSizes, const std::optional<uint64_t> allowedLateness)
+{
+    return std::make_unique<DefaultTimeBasedSliceStore>(
+        windowSizes | std::views::transform([](const uint64_t windowSize) { return SliceAssigner(windowSize, windowSize); })
+            | std::ranges::to<std::vector>(),
+        allowedLateness);
+}
+
+std::shared_ptr<AbstractBufferProvider> createStateBufferProvider(const QueryExecutionConfiguration& configuration)
+{
+    const auto memoryBudget = configuration.windowStateMemoryBudget.getValue();
+    if (memoryBudget == 0)
+    {
+        return nullptr;
+    }
+    /// The slices solely allocate unpooled buffers. Thus, the buffer manager only has the single pooled buffer that it requires.
+    auto spillFileMemoryResource
+        = std::make_shared<SpillFileMemoryResource>(configuration.windowStateSpillDirectory.getValue(), memoryBudget);
+    return BufferManager::create(static_cast<uint32_t>(configuration.pageSize.getValue()), 1, spillFileMemoryResource);
+}
+
+}
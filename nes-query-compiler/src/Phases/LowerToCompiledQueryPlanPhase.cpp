@@ -15,31 +15,105 @@
 #include <Phases/LowerToCompiledQueryPlanPhase.hpp>
 
 #include <algorithm>
+#include <cstdint>
+#include <future>
 #include <memory>
 #include <optional>
 #include <ranges>
+#include <sstream>
+#include <string>
 #include <unordered_map>
 #include <utility>
 #include <variant>
 #include <vector>
 #include <Configuration/WorkerConfiguration.hpp>
 #include <Identifiers/Identifiers.hpp>
+#include <Pipelines/CompilationThreadPool.hpp>
 #include <Pipelines/CompiledExecutablePipelineStage.hpp>
+#include <Pipelines/PerfMapSymbol.hpp>
 #include <Sources/SourceDescriptor.hpp>
+#include <Util/CompilationBackend.hpp>
 #include <Util/DumpMode.hpp>
 #include <Util/ExecutionMode.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <magic_enum/magic_enum.hpp>
+#include <CompiledPipelineCache.hpp>
 #include <CompiledQueryPlan.hpp>
 #include <ErrorHandling.hpp>
 #include <ExecutablePipelineStage.hpp>
+#include <PhysicalOperator.hpp>
 #include <Pipeline.hpp>
 #include <PipelinedQueryPlan.hpp>
+#include <ScanPhysicalOperator.hpp>
 #include <SinkPhysicalOperator.hpp>
 #include <SourcePhysicalOperator.hpp>
+#include <WindowBasedOperatorHandler.hpp>
 #include <options.hpp>
 
 namespace NES
 {
 
+namespace
+{
+/// Describes the operators of the pipeline, e.g., to check that pipelines of equal plans indeed consist of the same operators
+std::string describeOperators(const Pipeline& pipeline)
+{
+    std::stringstream description;
+    std::optional<PhysicalOperator> physicalOperator = pipeline.getRootOperator();
+    while (physicalOperator)
+    {
+        description << physicalOperator->toString() << ";";
+        physicalOperator = physicalOperator->getChild();
+    }
+    return description.str();
+}
+
+/// Names the compiled code of the pipeline in the perf map, e.g., NES_query1_pipeline3_Scan_Selection_Emit
+std::string getPerfMapSymbolName(const QueryId queryId, const Pipeline& pipeline)
+{
+    std::stringstream name;
+    name << "NES_query" << queryId << "_pipeline" << pipeline.getPipelineId();
+    std::optional<PhysicalOperator> physicalOperator = pipeline.getRootOperator();
+    while (physicalOperator)
+    {
+        /// The operators describe themselves as PhysicalOperator(NES::<Name>PhysicalOperator)
+        std::string operatorName = physicalOperator->toString();
+        operatorName = operatorName.substr(operatorName.rfind(':') + 1);
+        operatorName = operatorName.substr(0, std::min(operatorName.find("PhysicalOperator"), operatorName.find(')')));
+        name << "_" << operatorName;
+        physicalOperator = physicalOperator->getChild();
+    }
+    return name.str();
+}
+
+/// Window aggregations and joins keep their state in window based operator handlers
+bool hasWindowState(const Pipeline& pipeline)
+{
+    return std::ranges::any_of(
+        pipeline.getOperatorHandlers() | std::views::values,
+        [](const auto& operatorHandler) { return dynamic_cast<const WindowBasedOperatorHandler*>(operatorHandler.get()) != nullptr; });
+}
+
+/// See: https://github.com/nebulastream/nautilus/blob/main/docs/options.md
+void setCompilationBackend(nautilus::engine::Options& options, const CompilationBackend backend, const uint64_t optimizationLevel)
+{
+    switch (backend)
+    {
+        case CompilationBackend::MLIR:
+            options.setOption("engine.backend", std::string("mlir"));
+            options.setOption("mlir.optimizationLevel", static_cast<int>(optimizationLevel));
+            break;
+        case CompilationBackend::CPP:
+            options.setOption("engine.backend", std::string("cpp"));
+            options.setOption("cpp.optimizationLevel", static_cast<int>(optimizationLevel));
+            break;
+        case CompilationBackend::BYTECODE:
+            options.setOption("engine.backend", std::string("bc"));
+            break;
+    }
+}
+}
+
 LowerToCompiledQueryPlanPhase::Successor
 LowerToCompiledQueryPlanPhase::processSuccessor(const Predecessor& predecessor, const std::shared_ptr<Pipeline>& pipeline)
 {
@@ -61,16 +135,41 @@ void LowerToCompiledQueryPlanPhase::processSource(const std::shared_ptr<Pipeline
     const auto sourceOperator = pipeline->getRootOperator().get<SourcePhysicalOperator>();
 
     std::vector<std::weak_ptr<ExecutablePipeline>> executableSuccessorPipelines;
+    /// The source may skip the fields that none of the scans of its successors read. Any other successor, e.g., a sink, reads all fields.
+    std::vector<std::string> projections;
+    bool successorsReadAllFields = false;
 
     for (const auto& successor : pipeline->getSuccessors())
     {
+        if (const auto scan = successor->getRootOperator().tryGet<ScanPhysicalOperator>())
+        {
+            for (const auto& field : scan->getProjections())
+            {
+                if (std::ranges::find(projections, field) == projections.end())
+                {
+                    projections.push_back(field);
+                }
+            }
+        }
+        else
+        {
+            successorsReadAllFields = true;
+        }
         if (auto executableSuccessor = processSuccessor(sourceOperator.id, successor))
         {
             executableSuccessorPipelines.emplace_back(*executableSuccessor);
         }
     }
+    if (successorsReadAllFields)
+    {
+        projections.clear();
+    }
     sources.emplace_back(
-        sourceOperator.getOriginId(), sourceOperator.id, sourceOperator.getDescriptor(), std::move(executableSuccessorPipelines));
+        sourceOperator.getOriginId(),
+        sourceOperator.id,
+        sourceOperator.getDescriptor(),
+        std::move(executableSuccessorPipelines),
+        std::move(projections));
 }
 
 void LowerToCompiledQueryPlanPhase::processSink(const Predecessor& predecessor, const std::shared_ptr<Pipeline>& pipeline)
@@ -87,24 +186,39 @@ void LowerToCompiledQueryPlanPhase::processSink(const Predecessor& predecessor,
 
 std::unique_ptr<ExecutablePipelineStage> LowerToCompiledQueryPlanPhase::getStage(const std::shared_ptr<Pipeline>& pipeline)
 {
+    const auto pipelineIndex = numberOfLoweredPipelines++;
     nautilus::engine::Options options;
     /// We disable multithreading in MLIR by default to not interfere with NebulaStream's thread model
     options.setOption("mlir.enableMultithreading", false);
     switch (pipelineQueryPlan->getExecutionMode())
     {
-        case ExecutionMode::COMPILER: {
+        case ExecutionMode::COMPILER:
+        case ExecutionMode::VECTORIZED:
+        case ExecutionMode::TIERED: {
             options.setOption("engine.Compilation", true);
+            const auto& [backend, optimizationLevel] = hasWindowState(*pipeline) ? windowPipelineCompilation : pipelineCompilation;
+            setCompilationBackend(options, backend, optimizationLevel);
+            NES_DEBUG(
+                "Pipeline {} is compiled by the {} backend at optimization level {}",
+                pipeline->getPipelineId(),
+                magic_enum::enum_name(backend),
+                optimizationLevel);
             break;
         }
         case ExecutionMode::INTERPRETER: {
             options.setOption("engine.Compilation", false);
             break;
         }
+        case ExecutionMode::BYTECODE: {
+            /// Ignores the configured backends, as the byte code of all pipelines is ready within milliseconds
+            options.setOption("engine.Compilation", true);
+            setCompilationBackend(options, CompilationBackend::BYTECODE, 0);
+            break;
+        }
         default: {
             INVARIANT(false, "Invalid backend");
         }
     }
-    /// See: https://github.com/nebulastream/nautilus/blob/main/docs/options.md
     switch (dumpQueryCompilationIR.getDumpOption())
     {
         case DumpMode::Options::NONE:
@@ -129,7 +243,69 @@ std::unique_ptr<ExecutablePipelineStage> LowerToCompiledQueryPlanPhase::getStage
             break;
     }
     options.setOption("dump.graph", dumpQueryCompilationIR.isDumpGraphEnabled());
-    return std::make_unique<CompiledExecutablePipelineStage>(pipeline, pipeline->getOperatorHandlers(), options);
+
+    /// The interpreter does not compile any code that we could reuse
+    std::shared_ptr<CompiledPipelineSlot> compiledPipelineSlot;
+    if (compiledPlanSlots and pipelineQueryPlan->getExecutionMode() != ExecutionMode::INTERPRETER)
+    {
+        compiledPipelineSlot = compiledPlanSlots->getSlot(pipelineIndex, describeOperators(*pipeline));
+    }
+    /// With tiered execution, the stage interprets the pipeline until the thread pool compiled it
+    std::shared_ptr<CompilationThreadPool> backgroundCompilation;
+    if (pipelineQueryPlan->getExecutionMode() == ExecutionMode::TIERED)
+    {
+        INVARIANT(compilationThreadPool, "The TIERED execution mode requires a compilation thread pool");
+        backgroundCompilation = compilationThreadPool;
+    }
+    /// Neither the interpreter nor the byte code emit machine code that perf could symbolize
+    std::shared_ptr<PerfMapSymbol> perfMapSymbol;
+    if (emitPerfMap and pipelineQueryPlan->getExecutionMode() != ExecutionMode::INTERPRETER
+        and pipelineQueryPlan->getExecutionMode() != ExecutionMode::BYTECODE)
+    {
+        perfMapSymbol = std::make_shared<PerfMapSymbol>(getPerfMapSymbolName(pipelineQueryPlan->getQueryId(), *pipeline));
+    }
+    auto stage = std::make_unique<CompiledExecutablePipelineStage>(
+        pipeline,
+        pipeline->getOperatorHandlers(),
+        options,
+        std::move(compiledPipelineSlot),
+        std::move(backgroundCompilation),
+        numberOfProfiledBuffers,
+        std::move(perfMapSymbol));
+    if (compilationThreadPool
+        and (pipelineQueryPlan->getExecutionMode() == ExecutionMode::COMPILER
+             or pipelineQueryPlan->getExecutionMode() == ExecutionMode::VECTORIZED
+             or pipelineQueryPlan->getExecutionMode() == ExecutionMode::BYTECODE))
+    {
+        stagesToCompile.emplace_back(stage.get());
+    }
+    return stage;
+}
+
+void LowerToCompiledQueryPlanPhase::compileStagesInParallel()
+{
+    /// The pipelines of a query do not depend on each other's code. Thus, we compile them in parallel instead of one after the other,
+    /// while the query engine starts the pipelines.
+    std::vector<std::future<void>> compilations;
+    compilations.reserve(stagesToCompile.size());
+    for (auto* stage : stagesToCompile)
+    {
+        auto compilation = std::make_shared<std::packaged_task<void()>>([stage] { stage->compile(); });
+        compilations.emplace_back(compilation->get_future());
+        if (not compilationThreadPool->submit([compilation] { (*compilation)(); }))
+        {
+            (*compilation)();
+        }
+    }
+    /// We must wait for all compilations before we rethrow the first error, as the compilations access the stages
+    for (const auto& compilation : compilations)
+    {
+        compilation.wait();
+    }
+    for (auto& compilation : compilations)
+    {
+        compilation.get();
+    }
 }
 
 std::shared_ptr<ExecutablePipeline> LowerToCompiledQueryPlanPhase::processOperatorPipeline(const std::shared_ptr<Pipeline>& pipeline)
@@ -162,6 +338,7 @@ std::unique_ptr<CompiledQueryPlan> LowerToCompiledQueryPlanPhase::apply(const st
     {
         processSource(pipeline);
     }
+    compileStagesInParallel();
 
     auto pipelines = std::move(pipelineToExecutableMap) | std::views::values | std::ranges::to<std::vector>();
 
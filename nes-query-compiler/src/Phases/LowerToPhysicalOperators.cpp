@@ -14,12 +14,16 @@
 #include <Phases/LowerToPhysicalOperators.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <memory>
 #include <ranges>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
+#include <Identifiers/Identifiers.hpp>
 #include <LoweringRules/AbstractLoweringRule.hpp>
+#include <Nautilus/DataTypes/VarSizedDictionary.hpp>
 #include <Operators/LogicalOperator.hpp>
 #include <Plans/LogicalPlan.hpp>
 #include <Traits/ImplementationTypeTrait.hpp>
@@ -61,6 +65,13 @@ resolveLoweringRule(const LogicalOperator& logicalOperator, const LoweringRuleRe
                 }
                 throw UnknownOptimizerRule("Lowering rule for logical operator '{}' can't be resolved", logicalOperator.getName());
             }
+            case JoinImplementation::SORT_MERGE_JOIN: {
+                if (auto ruleOptional = LoweringRuleRegistry::instance().create(std::string("SortMergeJoin"), registryArgument))
+                {
+                    return std::move(ruleOptional.value());
+                }
+                throw UnknownOptimizerRule("Lowering rule for logical operator '{}' can't be resolved", logicalOperator.getName());
+            }
             case JoinImplementation::CHOICELESS: {
                 throw UnknownOptimizerRule("ImplementationTrait cannot be choiceless for join", logicalOperator.getName());
             }
@@ -74,19 +85,29 @@ resolveLoweringRule(const LogicalOperator& logicalOperator, const LoweringRuleRe
 }
 }
 
-LoweringRuleResultSubgraph::SubGraphRoot
-lowerOperatorRecursively(const LogicalOperator& logicalOperator, const LoweringRuleRegistryArguments& registryArgument)
+/// Maps the logical operators to the roots of their lowered subgraphs
+using LoweredOperators = std::unordered_map<OperatorId, LoweringRuleResultSubgraph::SubGraphRoot>;
+
+LoweringRuleResultSubgraph::SubGraphRoot lowerOperatorRecursively(
+    const LogicalOperator& logicalOperator, const LoweringRuleRegistryArguments& registryArgument, LoweredOperators& loweredOperators)
 {
+    /// Merged queries share operators, which we lower once, so that the physical plan shares them as well
+    if (const auto lowered = loweredOperators.find(logicalOperator.getId()); lowered != loweredOperators.end())
+    {
+        return lowered->second;
+    }
+
     /// Try to resolve lowering rule for the current logical operator
     const auto rule = resolveLoweringRule(logicalOperator, registryArgument);
 
     /// We apply the rule and receive a subgraph
-    const auto [root, leafs] = rule->apply(logicalOperator);
+    const auto [root, leafs, loweredInputs] = rule->apply(logicalOperator);
+    const auto inputs = loweredInputs.empty() ? logicalOperator.getChildren() : loweredInputs;
     INVARIANT(
-        leafs.size() == logicalOperator.getChildren().size(),
+        leafs.size() == inputs.size(),
         "Number of children after lowering must remain the same. {}, before:{}, after:{}",
         logicalOperator,
-        logicalOperator.getChildren().size(),
+        inputs.size(),
         leafs.size());
     /// if the lowering result is empty we bypass the operator
     if (not root)
@@ -97,45 +118,60 @@ lowerOperatorRecursively(const LogicalOperator& logicalOperator, const LoweringR
                 logicalOperator.getChildren().size() == 1,
                 "Empty lowering results of operators with multiple keys are not supported for {}",
                 logicalOperator);
-            return lowerOperatorRecursively(logicalOperator.getChildren()[0], registryArgument);
+            return loweredOperators[logicalOperator.getId()]
+                = lowerOperatorRecursively(logicalOperator.getChildren()[0], registryArgument, loweredOperators);
         }
-        return {};
+        return loweredOperators[logicalOperator.getId()] = nullptr;
     }
     /// We embed the subgraph into the resulting plan of physical operator wrappers
-    auto children = logicalOperator.getChildren();
     INVARIANT(
-        children.size() == leafs.size(),
+        inputs.size() == leafs.size(),
         "Leaf node size does not match logical plan {} vs physical plan: {} for {}",
-        children.size(),
+        inputs.size(),
         leafs.size(),
         logicalOperator);
 
     std::ranges::for_each(
-        std::views::zip(children, leafs),
-        [&registryArgument](const auto& zippedPair)
+        std::views::zip(inputs, leafs),
+        [&registryArgument, &loweredOperators](const auto& zippedPair)
         {
-            const auto& [child, leaf] = zippedPair;
-            auto rootNodeOfLoweredChild = lowerOperatorRecursively(child, registryArgument);
-            leaf->addChild(rootNodeOfLoweredChild);
+            const auto& [input, leaf] = zippedPair;
+            auto rootNodeOfLoweredInput = lowerOperatorRecursively(input, registryArgument, loweredOperators);
+            /// Every operator writes its output in its own memory layout, thus a pipeline that starts with the leaf scans this layout
+            if (rootNodeOfLoweredInput and rootNodeOfLoweredInput->getOutputMemoryLayoutType().has_value())
+            {
+                leaf->setInputMemoryLayoutType(rootNodeOfLoweredInput->getOutputMemoryLayoutType().value());
+            }
+            leaf->addChild(rootNodeOfLoweredInput);
         });
-    return root;
+    return loweredOperators[logicalOperator.getId()] = root;
 }
 
 PhysicalPlan apply(const LogicalPlan& queryPlan, const QueryExecutionConfiguration& conf) /// NOLINT
 {
-    const auto registryArgument = LoweringRuleRegistryArguments{conf};
+    const auto registryArgument = LoweringRuleRegistryArguments{
+        .conf = conf,
+        .varSizedKeyDictionary = conf.internVarSizedKeys.getValue()
+            ? std::make_shared<VarSizedDictionary>(VarSizedDictionary::UNBOUNDED_NUMBER_OF_ENTRIES)
+            : nullptr};
+    LoweredOperators loweredOperators;
     std::vector<std::shared_ptr<PhysicalOperatorWrapper>> newRootOperators;
     newRootOperators.reserve(queryPlan.getRootOperators().size());
     for (const auto& logicalRoot : queryPlan.getRootOperators())
     {
-        newRootOperators.push_back(lowerOperatorRecursively(logicalRoot, registryArgument));
+        newRootOperators.push_back(lowerOperatorRecursively(logicalRoot, registryArgument, loweredOperators));
     }
 
     INVARIANT(not newRootOperators.empty(), "Plan must have at least one root operator");
     auto physicalPlanBuilder = PhysicalPlanBuilder(queryPlan.getQueryId());
-    physicalPlanBuilder.addSinkRoot(newRootOperators[0]);
+    for (auto& newRootOperator : newRootOperators)
+    {
+        physicalPlanBuilder.addSinkRoot(std::move(newRootOperator));
+    }
     physicalPlanBuilder.setExecutionMode(conf.executionMode.getValue());
     physicalPlanBuilder.setOperatorBufferSize(conf.operatorBufferSize.getValue());
+    physicalPlanBuilder.setEmitCoalescingLatencyBound(std::chrono::microseconds(conf.emitCoalescingLatencyBound.getValue()));
+    physicalPlanBuilder.setVarSizedSharingCompactionThreshold(conf.varSizedSharingCompactionThreshold.getValue());
     return std::move(physicalPlanBuilder).finalize();
 }
 }
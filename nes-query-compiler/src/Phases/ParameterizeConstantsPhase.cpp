@@ -0,0 +1,121 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Phases/ParameterizeConstantsPhase.hpp>
+
+#include <cstdint>
+#include <ranges>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <Functions/ConstantValueLogicalFunction.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Functions/ParameterLogicalFunction.hpp>
+#include <Functions/UdfLogicalFunction.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Operators/ProjectionLogicalOperator.hpp>
+#include <Operators/SelectionLogicalOperator.hpp>
+#include <Plans/LogicalPlan.hpp>
+#include <ParameterOperatorHandler.hpp>
+
+namespace NES::QueryCompilation::ParameterizeConstantsPhase
+{
+
+namespace
+{
+class Parameterizer
+{
+public:
+    LogicalOperator parameterize(const LogicalOperator& op)
+    {
+        /// Merged plans share operators, which have to remain shared
+        if (const auto parameterized = parameterizedOperators.find(op.getId()); parameterized != parameterizedOperators.end())
+        {
+            return parameterized->second;
+        }
+        auto children = op.getChildren()
+            | std::views::transform([this](const LogicalOperator& child) { return parameterize(child); })
+            | std::ranges::to<std::vector>();
+        auto result = [&]() -> LogicalOperator
+        {
+            if (const auto selection = op.tryGetAs<SelectionLogicalOperator>())
+            {
+                return LogicalOperator{SelectionLogicalOperator(parameterize(selection.value()->getPredicate()))
+                                           .withTraitSet(op.getTraitSet())
+                                           .withChildren(std::move(children))
+                                           .withInferredSchema(op.getInputSchemas())};
+            }
+            if (const auto projection = op.tryGetAs<ProjectionLogicalOperator>())
+            {
+                /// The name of an unnamed projection is the explanation of its function, which would change with its parameters
+                auto projections = projection.value()->getProjections()
+                    | std::views::transform(
+                                       [this](const auto& projected)
+                                       {
+                                           return projected.first.has_value()
+                                               ? ProjectionLogicalOperator::Projection{projected.first, parameterize(projected.second)}
+                                               : projected;
+                                       })
+                    | std::ranges::to<std::vector>();
+                const ProjectionLogicalOperator::Asterisk asterisk(projection.value()->hasAsterisk());
+                return LogicalOperator{
+                    ProjectionLogicalOperator(std::move(projections), asterisk)
+                        .withTraitSet(op.getTraitSet())
+                        .withChildren(std::move(children))
+                        .withInferredSchema(op.getInputSchemas())};
+            }
+            return op.withChildren(std::move(children));
+        }();
+        result = result.withOperatorId(op.getId());
+        parameterizedOperators.emplace(op.getId(), result);
+        return result;
+    }
+
+private:
+    LogicalFunction parameterize(const LogicalFunction& function)
+    {
+        if (function.tryGetAs<UdfLogicalFunction>())
+        {
+            return function;
+        }
+        if (const auto constant = function.tryGetAs<ConstantValueLogicalFunction>())
+        {
+            if (not ParameterOperatorHandler::supportsType(constant->get().getDataType()))
+            {
+                return function;
+            }
+            return ParameterLogicalFunction(nextIndex++, constant->get().getDataType(), constant->get().getConstantValue());
+        }
+        auto children = function.getChildren()
+            | std::views::transform([this](const LogicalFunction& child) { return parameterize(child); })
+            | std::ranges::to<std::vector>();
+        return function.withChildren(children);
+    }
+
+    uint64_t nextIndex = 0;
+    std::unordered_map<OperatorId, LogicalOperator> parameterizedOperators;
+};
+}
+
+LogicalPlan apply(const LogicalPlan& plan)
+{
+    Parameterizer parameterizer;
+    auto roots = plan.getRootOperators()
+        | std::views::transform([&parameterizer](const LogicalOperator& root) { return parameterizer.parameterize(root); })
+        | std::ranges::to<std::vector>();
+    return plan.withRootOperators(roots);
+}
+
+}
@@ -14,12 +14,15 @@
 
 #include <Phases/PipeliningPhase.hpp>
 
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <ranges>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include <DataTypes/Schema.hpp>
@@ -28,17 +31,21 @@
 #include <Nautilus/Interface/BufferRef/RowTupleBufferRef.hpp>
 #include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
 #include <Runtime/Execution/OperatorHandler.hpp>
+#include <Sinks/SinkDescriptor.hpp>
 #include <Util/Logger/Logger.hpp>
-#include <Util/Strings.hpp>
+#include <magic_enum/magic_enum.hpp>
 #include <EmitOperatorHandler.hpp>
 #include <EmitPhysicalOperator.hpp>
 #include <ErrorHandling.hpp>
+#include <FormatPhysicalOperator.hpp>
+#include <ColumnStatisticsCollector.hpp>
 #include <InputFormatterTupleBufferRefProvider.hpp>
 #include <PhysicalOperator.hpp>
 #include <PhysicalPlan.hpp>
 #include <Pipeline.hpp>
 #include <PipelinedQueryPlan.hpp>
 #include <ScanPhysicalOperator.hpp>
+#include <SelectionPhysicalOperator.hpp>
 #include <SinkPhysicalOperator.hpp>
 
 namespace NES::QueryCompilation::PipeliningPhase
@@ -71,15 +78,13 @@ PhysicalOperator createScanOperator(
 
     const auto memoryProvider = LowerSchemaProvider::lowerSchema(configuredBufferSize, inputSchema.value(), memoryLayout.value());
     /// Instantiate the scan with an InputFormatterTupleBufferRef, if the prior operatior is a source operator that contains a source descriptor
-    /// with a parser type other than "NATIVE" (NATIVE data does not require formatting)
+    /// Even 'NATIVE' data requires an input formatter, since sources cut the stream of native frames into raw buffers at arbitrary offsets
     if (prevPipeline.isSourcePipeline())
     {
         const auto inputFormatterConfig = prevPipeline.getRootOperator().get<SourcePhysicalOperator>().getDescriptor().getParserConfig();
-        if (toUpperCase(inputFormatterConfig.parserType) != "NATIVE")
-        {
-            return ScanPhysicalOperator(
-                provideInputFormatterTupleBufferRef(inputFormatterConfig, memoryProvider), inputSchema->getFieldNames());
-        }
+        return ScanPhysicalOperator(
+            provideInputFormatterTupleBufferRef(inputFormatterConfig, memoryProvider, inputSchema->getFieldNames()),
+            inputSchema->getFieldNames());
     }
     return ScanPhysicalOperator(memoryProvider, inputSchema->getFieldNames());
 }
@@ -99,6 +104,17 @@ std::shared_ptr<Pipeline> createNewPipelineWithScan(
     return newPipeline;
 }
 
+/// Creates the operator handler of an emit. If the pipeline formats a source that requires ordered output, the handler re-sequences the
+/// buffers that the (concurrently formatting) worker threads emit
+OperatorHandlerId addEmitOperatorHandler(Pipeline& pipeline)
+{
+    const auto scan = pipeline.getRootOperator().tryGet<ScanPhysicalOperator>();
+    const bool emitsInSequenceOrder = scan.has_value() and scan->requiresOrderedOutput();
+    const OperatorHandlerId operatorHandlerIndex = getNextOperatorHandlerId();
+    pipeline.getOperatorHandlers().emplace(operatorHandlerIndex, std::make_shared<EmitOperatorHandler>(emitsInSequenceOrder));
+    return operatorHandlerIndex;
+}
+
 /// Helper function to add a default emit operator
 /// This is used only when the wrapped operator does not already provide an emit
 /// @note Once we have refactored the memory layout and schema we can get rid of the configured buffer size.
@@ -112,18 +128,79 @@ void addDefaultEmit(const std::shared_ptr<Pipeline>& pipeline, const PhysicalOpe
     INVARIANT(memoryLayoutType.has_value(), "Wrapped operator has no output memory layout type");
 
     const auto bufferRef = LowerSchemaProvider::lowerSchema(configuredBufferSize, schema.value(), memoryLayoutType.value());
-    /// Create an operator handler for the emit
-    const OperatorHandlerId operatorHandlerIndex = getNextOperatorHandlerId();
-    pipeline->getOperatorHandlers().emplace(operatorHandlerIndex, std::make_shared<EmitOperatorHandler>());
+    const auto operatorHandlerIndex = addEmitOperatorHandler(*pipeline);
     pipeline->appendOperator(EmitPhysicalOperator(operatorHandlerIndex, bufferRef));
 }
 
+/// Helper function to add the emit of a pipeline that precedes a sink
+/// If the sink writes rows that the compiled pipeline formatted (see SinkDescriptor::COMPILED_FORMAT), the pipeline formats its records
+/// with a FormatPhysicalOperator. If the sink reads columnar buffers (see SinkDescriptor::COLUMNAR_INPUT), the pipeline emits columnar
+/// buffers. Otherwise, it emits them like any other pipeline.
+void addSinkEmit(
+    const std::shared_ptr<Pipeline>& pipeline,
+    const PhysicalOperatorWrapper& wrappedOp,
+    const SinkDescriptor& sinkDescriptor,
+    uint64_t configuredBufferSize)
+{
+    if (sinkDescriptor.tryGetFromConfig(SinkDescriptor::COLUMNAR_INPUT).value_or(false))
+    {
+        PRECONDITION(pipeline->isOperatorPipeline(), "Only add emit physical operator to operator pipelines");
+        const auto& schema = wrappedOp.getOutputSchema();
+        INVARIANT(schema.has_value(), "Wrapped operator has no output schema");
+        const auto bufferRef = LowerSchemaProvider::lowerSchema(configuredBufferSize, schema.value(), MemoryLayoutType::COLUMNAR_LAYOUT);
+        const auto operatorHandlerIndex = addEmitOperatorHandler(*pipeline);
+        pipeline->appendOperator(EmitPhysicalOperator(operatorHandlerIndex, bufferRef));
+        return;
+    }
+    if (not sinkDescriptor.tryGetFromConfig(SinkDescriptor::COMPILED_FORMAT).value_or(false))
+    {
+        addDefaultEmit(pipeline, wrappedOp, configuredBufferSize);
+        return;
+    }
+    const auto format = sinkDescriptor.getFormatType().and_then([](const auto name) { return magic_enum::enum_cast<InputFormat>(name); });
+    if (not format.has_value() or format.value() == InputFormat::NATIVE)
+    {
+        /// The sink rejects the combination when it is created
+        addDefaultEmit(pipeline, wrappedOp, configuredBufferSize);
+        return;
+    }
+
+    PRECONDITION(pipeline->isOperatorPipeline(), "Only add format physical operator to operator pipelines");
+    const auto& schema = wrappedOp.getOutputSchema();
+    INVARIANT(schema.has_value(), "Wrapped operator has no output schema");
+    const auto operatorHandlerIndex = addEmitOperatorHandler(*pipeline);
+    pipeline->appendOperator(FormatPhysicalOperator(operatorHandlerIndex, schema.value(), format.value(), configuredBufferSize));
+}
+
 enum class PipelinePolicy : uint8_t
 {
     Continue, /// Uses the current pipeline for the next operator
     ForceNew /// Enforces a new pipeline for the next operator
 };
 
+void buildPipelineRecursively(
+    const std::shared_ptr<PhysicalOperatorWrapper>& opWrapper,
+    const std::shared_ptr<PhysicalOperatorWrapper>& prevOpWrapper,
+    const std::shared_ptr<Pipeline>& currentPipeline,
+    OperatorPipelineMap& pipelineMap,
+    PipelinePolicy policy,
+    uint64_t configuredBufferSize);
+
+/// Operators that multiple merged queries share have multiple children. As a pipeline is a chain of operators, the pipeline emits the
+/// output of the shared operator once and every child continues in a pipeline of its own.
+void fanOut(
+    const std::shared_ptr<PhysicalOperatorWrapper>& opWrapper,
+    const std::shared_ptr<Pipeline>& pipeline,
+    OperatorPipelineMap& pipelineMap,
+    uint64_t configuredBufferSize)
+{
+    addDefaultEmit(pipeline, *opWrapper, configuredBufferSize);
+    for (const auto& child : opWrapper->getChildren())
+    {
+        buildPipelineRecursively(child, nullptr, pipeline, pipelineMap, PipelinePolicy::ForceNew, configuredBufferSize);
+    }
+}
+
 void buildPipelineRecursively(
     const std::shared_ptr<PhysicalOperatorWrapper>& opWrapper,
     const std::shared_ptr<PhysicalOperatorWrapper>& prevOpWrapper,
@@ -138,7 +215,14 @@ void buildPipelineRecursively(
     {
         if (prevOpWrapper and prevOpWrapper->getPipelineLocation() != PhysicalOperatorWrapper::PipelineLocation::EMIT)
         {
-            addDefaultEmit(currentPipeline, *prevOpWrapper, configuredBufferSize);
+            if (const auto sink = opWrapper->getPhysicalOperator().tryGet<SinkPhysicalOperator>())
+            {
+                addSinkEmit(currentPipeline, *prevOpWrapper, sink->getDescriptor(), configuredBufferSize);
+            }
+            else
+            {
+                addDefaultEmit(currentPipeline, *prevOpWrapper, configuredBufferSize);
+            }
         }
         currentPipeline->addSuccessor(it->second, currentPipeline);
         return;
@@ -159,6 +243,11 @@ void buildPipelineRecursively(
         pipelineMap.emplace(opId, newPipeline);
         currentPipeline->addSuccessor(newPipeline, currentPipeline);
         const auto newPipelinePtr = currentPipeline->getSuccessors().back();
+        if (opWrapper->getChildren().size() > 1)
+        {
+            fanOut(opWrapper, newPipelinePtr, pipelineMap, configuredBufferSize);
+            return;
+        }
         for (auto& child : opWrapper->getChildren())
         {
             buildPipelineRecursively(child, opWrapper, newPipelinePtr, pipelineMap, PipelinePolicy::Continue, configuredBufferSize);
@@ -206,39 +295,42 @@ void buildPipelineRecursively(
     /// Case 3: Sink Operator – treat sinks as pipeline breakers
     if (auto sink = opWrapper->getPhysicalOperator().tryGet<SinkPhysicalOperator>())
     {
-        if (currentPipeline->isSourcePipeline())
+        /// Add a formatting pipeline, if the sink directly follows the source
+        /// Otherwise, even if both formats are, e.g., 'CSV', the source 'blindly' ingest buffers until they are full, meaning buffers
+        /// may start and end with a cut-off tuples (rows in the CSV case)
+        /// The sink would output these buffers (out of order if the engine uses multiple threads), producing malformed data
+        /// Similarly, a sink that writes the compiled format requires a formatting pipeline, if it follows a shared operator, which
+        /// emitted its output to all of its children already (see fanOut)
+        /// A sink that reads columnar buffers requires a formatting pipeline, if its input is emitted in another layout already, i.e., by
+        /// a shared operator or by an operator that emits its output itself
+        const bool writesCompiledFormat = sink->getDescriptor().tryGetFromConfig(SinkDescriptor::COMPILED_FORMAT).value_or(false);
+        const bool readsColumnarInput = sink->getDescriptor().tryGetFromConfig(SinkDescriptor::COLUMNAR_INPUT).value_or(false);
+        const bool inputIsEmitted
+            = not prevOpWrapper or prevOpWrapper->getPipelineLocation() == PhysicalOperatorWrapper::PipelineLocation::EMIT;
+        const bool requiresColumnarConversion
+            = readsColumnarInput and inputIsEmitted and opWrapper->getInputMemoryLayoutType() != MemoryLayoutType::COLUMNAR_LAYOUT;
+        if (currentPipeline->isSourcePipeline() or (not prevOpWrapper and writesCompiledFormat) or requiresColumnarConversion)
         {
-            const auto sourceFormat = toUpperCase(
-                currentPipeline->getRootOperator().get<SourcePhysicalOperator>().getDescriptor().getParserConfig().parserType);
-
-            const auto sinkFormat = sink->getDescriptor().getFormatType() ? sink->getDescriptor().getFormatType().value() : "";
-            /// Add a formatting pipeline if the source-sink pipelines do not simply forward natively formatted data
-            /// Otherwise, even if both formats are, e.g., 'CSV', the source 'blindly' ingest buffers until they are full, meaning buffers
-            /// may start and end with a cut-off tuples (rows in the CSV case)
-            /// The sink would output these buffers (out of order if the engine uses multiple threads), producing malformed data
-            if (not(sourceFormat == "NATIVE" and sinkFormat == "NATIVE"))
-            {
-                const auto sourcePipeline = std::make_shared<Pipeline>(createScanOperator(
-                    *currentPipeline, opWrapper->getInputSchema(), opWrapper->getInputMemoryLayoutType(), configuredBufferSize));
-                currentPipeline->addSuccessor(sourcePipeline, currentPipeline);
+            const auto sourcePipeline = std::make_shared<Pipeline>(createScanOperator(
+                *currentPipeline, opWrapper->getInputSchema(), opWrapper->getInputMemoryLayoutType(), configuredBufferSize));
+            currentPipeline->addSuccessor(sourcePipeline, currentPipeline);
 
-                addDefaultEmit(sourcePipeline, *opWrapper, configuredBufferSize);
+            addSinkEmit(sourcePipeline, *opWrapper, sink->getDescriptor(), configuredBufferSize);
 
-                INVARIANT(sourcePipeline->getRootOperator().getChild().has_value(), "Scan operator requires at least an emit as child.");
-                const auto emitOperatorId = sourcePipeline->getRootOperator().getChild().value().getId();
-                pipelineMap[emitOperatorId] = sourcePipeline;
+            INVARIANT(sourcePipeline->getRootOperator().getChild().has_value(), "Scan operator requires at least an emit as child.");
+            const auto emitOperatorId = sourcePipeline->getRootOperator().getChild().value().getId();
+            pipelineMap[emitOperatorId] = sourcePipeline;
 
-                const auto sinkPipeline = std::make_shared<Pipeline>(*sink);
-                sourcePipeline->addSuccessor(sinkPipeline, sourcePipeline);
-                auto sinkPipelinePtr = sourcePipeline->getSuccessors().back();
-                pipelineMap.emplace(opId, sinkPipelinePtr);
-                return;
-            }
+            const auto sinkPipeline = std::make_shared<Pipeline>(*sink);
+            sourcePipeline->addSuccessor(sinkPipeline, sourcePipeline);
+            auto sinkPipelinePtr = sourcePipeline->getSuccessors().back();
+            pipelineMap.emplace(opId, sinkPipelinePtr);
+            return;
         }
         /// Add emit first if there is one needed
         if (prevOpWrapper and prevOpWrapper->getPipelineLocation() != PhysicalOperatorWrapper::PipelineLocation::EMIT)
         {
-            addDefaultEmit(currentPipeline, *prevOpWrapper, configuredBufferSize);
+            addSinkEmit(currentPipeline, *prevOpWrapper, sink->getDescriptor(), configuredBufferSize);
         }
         const auto newPipeline = std::make_shared<Pipeline>(*sink);
         currentPipeline->addSuccessor(newPipeline, currentPipeline);
@@ -256,7 +348,7 @@ void buildPipelineRecursively(
     {
         if (prevOpWrapper and prevOpWrapper->getPipelineLocation() != PhysicalOperatorWrapper::PipelineLocation::EMIT)
         {
-            addDefaultEmit(currentPipeline, *opWrapper, configuredBufferSize);
+            addDefaultEmit(currentPipeline, *prevOpWrapper, configuredBufferSize);
         }
         const auto newPipeline = std::make_shared<Pipeline>(opWrapper->getPhysicalOperator());
         if (auto handlerId = opWrapper->getHandlerId())
@@ -269,6 +361,11 @@ void buildPipelineRecursively(
         PRECONDITION(newPipelinePtr->isOperatorPipeline(), "Only add scan physical operator to operator pipelines");
         newPipelinePtr->prependOperator(
             createScanOperator(*currentPipeline, opWrapper->getInputSchema(), opWrapper->getInputMemoryLayoutType(), configuredBufferSize));
+        if (opWrapper->getChildren().size() > 1)
+        {
+            fanOut(opWrapper, newPipelinePtr, pipelineMap, configuredBufferSize);
+            return;
+        }
         for (auto& child : opWrapper->getChildren())
         {
             buildPipelineRecursively(child, opWrapper, newPipelinePtr, pipelineMap, PipelinePolicy::Continue, configuredBufferSize);
@@ -296,6 +393,10 @@ void buildPipelineRecursively(
     {
         addDefaultEmit(currentPipeline, *opWrapper, configuredBufferSize);
     }
+    else if (opWrapper->getChildren().size() > 1)
+    {
+        fanOut(opWrapper, currentPipeline, pipelineMap, configuredBufferSize);
+    }
     else
     {
         for (auto& child : opWrapper->getChildren())
@@ -305,9 +406,65 @@ void buildPipelineRecursively(
     }
 }
 
+/// A selective filter leaves few records per input buffer, thus the emit of a pipeline with a selection coalesces its small buffers
+void enableEmitCoalescing(Pipeline& pipeline, const std::chrono::microseconds latencyBound)
+{
+    bool hasSelection = false;
+    for (std::optional<PhysicalOperator> physicalOperator = pipeline.getRootOperator(); physicalOperator.has_value();
+         physicalOperator = physicalOperator->getChild())
+    {
+        hasSelection = hasSelection or physicalOperator->tryGet<SelectionPhysicalOperator>().has_value();
+        const auto emit = physicalOperator->tryGet<EmitPhysicalOperator>();
+        if (not hasSelection or not emit.has_value())
+        {
+            continue;
+        }
+        if (auto coalescing = EmitCoalescing::create(emit->getBufferRef(), latencyBound))
+        {
+            const auto handler = pipeline.getOperatorHandlers().at(emit->getOperatorHandlerId());
+            dynamic_cast<EmitOperatorHandler&>(*handler).enableCoalescing(std::move(*coalescing));
+        }
+    }
 }
 
-std::shared_ptr<PipelinedQueryPlan> apply(const PhysicalPlan& physicalPlan)
+
+/// The buffers of an emit are short-lived, thus they can reference the variable sized data of their input without holding on to the
+/// child buffers of the input for long
+void enableVarSizedSharing(Pipeline& pipeline, const uint64_t compactionThreshold)
+{
+    for (std::optional<PhysicalOperator> physicalOperator = pipeline.getRootOperator(); physicalOperator.has_value();
+         physicalOperator = physicalOperator->getChild())
+    {
+        auto emit = physicalOperator->tryGet<EmitPhysicalOperator>();
+        if (not emit.has_value())
+        {
+            continue;
+        }
+        if (auto compaction = VarSizedCompaction::create(emit->getBufferRef(), compactionThreshold))
+        {
+            const auto handler = pipeline.getOperatorHandlers().at(emit->getOperatorHandlerId());
+            dynamic_cast<EmitOperatorHandler&>(*handler).enableVarSizedCompaction(std::move(*compaction));
+            emit->enableVarSizedSharing();
+        }
+    }
+}
+
+/// The scan of a pipeline that formats the raw buffers of a source samples the values of the source fields
+void enableColumnStatistics(const Pipeline& pipeline, ColumnStatisticsCollector& columnStatistics)
+{
+    if (const auto scan = pipeline.getRootOperator().tryGet<ScanPhysicalOperator>())
+    {
+        if (const auto inputFormatter = scan->getInputFormatter())
+        {
+            inputFormatter->sampleColumnStatistics(columnStatistics);
+        }
+    }
+}
+
+}
+
+std::shared_ptr<PipelinedQueryPlan>
+apply(const PhysicalPlan& physicalPlan, const std::shared_ptr<ColumnStatisticsCollector>& columnStatistics)
 {
     const uint64_t configuredBufferSize = physicalPlan.getOperatorBufferSize();
     auto pipelinedPlan = std::make_shared<PipelinedQueryPlan>(physicalPlan.getQueryId(), physicalPlan.getExecutionMode());
@@ -327,6 +484,28 @@ std::shared_ptr<PipelinedQueryPlan> apply(const PhysicalPlan& physicalPlan)
         }
     }
 
+    /// Multiple operators map to the same pipeline
+    std::unordered_set<Pipeline*> pipelines;
+    for (const auto& pipeline : pipelineMap | std::views::values)
+    {
+        if (not pipelines.insert(pipeline.get()).second)
+        {
+            continue;
+        }
+        if (const auto latencyBound = physicalPlan.getEmitCoalescingLatencyBound(); latencyBound.count() > 0)
+        {
+            enableEmitCoalescing(*pipeline, latencyBound);
+        }
+        if (const auto compactionThreshold = physicalPlan.getVarSizedSharingCompactionThreshold(); compactionThreshold > 0)
+        {
+            enableVarSizedSharing(*pipeline, compactionThreshold);
+        }
+        if (columnStatistics and pipeline->isOperatorPipeline())
+        {
+            enableColumnStatistics(*pipeline, *columnStatistics);
+        }
+    }
+
     NES_DEBUG("Constructed pipeline plan with {} root pipelines.\n{}", pipelinedPlan->getPipelines().size(), *pipelinedPlan);
     return pipelinedPlan;
 }
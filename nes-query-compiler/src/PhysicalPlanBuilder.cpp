@@ -13,6 +13,7 @@
 */
 #include <PhysicalPlanBuilder.hpp>
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
@@ -53,10 +54,20 @@ void PhysicalPlanBuilder::setOperatorBufferSize(uint64_t bufferSize)
     operatorBufferSize = bufferSize;
 }
 
+void PhysicalPlanBuilder::setEmitCoalescingLatencyBound(const std::chrono::microseconds latencyBound)
+{
+    emitCoalescingLatencyBound = latencyBound;
+}
+
+void PhysicalPlanBuilder::setVarSizedSharingCompactionThreshold(const uint64_t threshold)
+{
+    varSizedSharingCompactionThreshold = threshold;
+}
+
 PhysicalPlan PhysicalPlanBuilder::finalize() &&
 {
     auto sources = flip(sinks);
-    return {queryId, std::move(sources), executionMode, operatorBufferSize};
+    return {queryId, std::move(sources), executionMode, operatorBufferSize, emitCoalescingLatencyBound, varSizedSharingCompactionThreshold};
 }
 
 using PhysicalOpPtr = std::shared_ptr<PhysicalOperatorWrapper>;
@@ -136,7 +147,7 @@ void verifyFlippedGraph(
 
 PhysicalPlanBuilder::Roots PhysicalPlanBuilder::flip(const Roots& rootOperators)
 {
-    PRECONDITION(rootOperators.size() == 1, "For now we can only flip graphs with a single root");
+    PRECONDITION(not rootOperators.empty(), "Expects at least one root to flip");
 
     /// DFS visit states for cycle detection.
     enum class VisitState : uint8_t
@@ -167,7 +178,11 @@ PhysicalPlanBuilder::Roots PhysicalPlanBuilder::flip(const Roots& rootOperators)
         }
         it->second = VisitState::Completed;
     };
-    collectNodes(rootOperators[0], collectNodes);
+    /// The sinks of merged queries share the operators (and sources) below them, thus the graphs of the roots overlap
+    for (const auto& rootOperator : rootOperators)
+    {
+        collectNodes(rootOperator, collectNodes);
+    }
 
     /// Count edges before clearing children.
     size_t edgeCountBefore = 0;
@@ -16,23 +16,60 @@
 #include <QueryCompiler.hpp>
 
 #include <memory>
+#include <utility>
 #include <Configuration/WorkerConfiguration.hpp>
 #include <Phases/LowerToCompiledQueryPlanPhase.hpp>
 #include <Phases/LowerToPhysicalOperators.hpp>
+#include <Phases/ParameterizeConstantsPhase.hpp>
 #include <Phases/PipeliningPhase.hpp>
+#include <Pipelines/CompilationThreadPool.hpp>
 #include <Util/DumpMode.hpp>
+#include <Util/ExecutionMode.hpp>
+#include <ColumnStatisticsCollector.hpp>
+#include <CompiledPipelineCache.hpp>
 #include <CompiledQueryPlan.hpp>
 #include <ErrorHandling.hpp>
+#include <QueryExecutionConfiguration.hpp>
 
 namespace NES::QueryCompilation
 {
 
+QueryCompiler::QueryCompiler(
+    QueryExecutionConfiguration defaultQueryExecution, std::shared_ptr<ColumnStatisticsCollector> columnStatistics)
+    : defaultQueryExecution(std::move(defaultQueryExecution))
+    , compiledPipelineCache(this->defaultQueryExecution.compiledPipelineCacheSize.getValue())
+    , columnStatistics(std::move(columnStatistics))
+{
+    const auto numberOfCompilationThreads = this->defaultQueryExecution.numberOfCompilationThreads.getValue();
+    if (numberOfCompilationThreads == 0 and this->defaultQueryExecution.executionMode.getValue() == ExecutionMode::TIERED)
+    {
+        throw InvalidConfigParameter("The TIERED execution mode requires at least one compilation thread");
+    }
+    if (this->defaultQueryExecution.optimizationLevel.getValue() > MAX_OPTIMIZATION_LEVEL
+        or this->defaultQueryExecution.windowPipelineOptimizationLevel.getValue() > MAX_OPTIMIZATION_LEVEL)
+    {
+        throw InvalidConfigParameter("The optimization levels must not exceed {}", MAX_OPTIMIZATION_LEVEL);
+    }
+    if (numberOfCompilationThreads > 0)
+    {
+        compilationThreadPool = std::make_shared<CompilationThreadPool>(numberOfCompilationThreads);
+    }
+}
+
 /// This phase should be as dumb as possible and not further decisions should be made here.
 std::unique_ptr<CompiledQueryPlan> QueryCompiler::compileQuery(std::unique_ptr<QueryCompilationRequest> request)
 {
-    auto lowerToCompiledQueryPlanPhase = LowerToCompiledQueryPlanPhase(request->dumpCompilationResult);
-    auto queryPlan = LowerToPhysicalOperators::apply(request->queryPlan.getPlan(), defaultQueryExecution);
-    auto pipelinedQueryPlan = PipeliningPhase::apply(queryPlan);
+    /// Queries that only differ in their constants compile to the same template, whose parameters are read at runtime
+    const auto logicalPlan = defaultQueryExecution.parameterizeConstants.getValue()
+        ? ParameterizeConstantsPhase::apply(request->queryPlan.getPlan())
+        : request->queryPlan.getPlan();
+    /// Dumping the compilation result requires tracing and compiling the pipelines, thus we do not reuse compiled pipelines
+    auto compiledPlanSlots
+        = request->dumpCompilationResult.getDumpOption() == DumpMode::Options::NONE ? compiledPipelineCache.getSlots(logicalPlan) : nullptr;
+    auto lowerToCompiledQueryPlanPhase = LowerToCompiledQueryPlanPhase(
+        request->dumpCompilationResult, std::move(compiledPlanSlots), compilationThreadPool, defaultQueryExecution);
+    auto queryPlan = LowerToPhysicalOperators::apply(logicalPlan, defaultQueryExecution);
+    auto pipelinedQueryPlan = PipeliningPhase::apply(queryPlan, columnStatistics);
     return lowerToCompiledQueryPlanPhase.apply(pipelinedQueryPlan);
 }
 }
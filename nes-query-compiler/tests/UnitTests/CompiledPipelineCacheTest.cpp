@@ -0,0 +1,191 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/DataTypeProvider.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/ArithmeticalFunctions/AddLogicalFunction.hpp>
+#include <Functions/BooleanFunctions/EqualsLogicalFunction.hpp>
+#include <Functions/ComparisonFunctions/GreaterLogicalFunction.hpp>
+#include <Functions/ConstantValueLogicalFunction.hpp>
+#include <Functions/FieldAccessLogicalFunction.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Operators/ProjectionLogicalOperator.hpp>
+#include <Operators/SelectionLogicalOperator.hpp>
+#include <Operators/Sources/SourceNameLogicalOperator.hpp>
+#include <Phases/ParameterizeConstantsPhase.hpp>
+#include <Plans/LogicalPlan.hpp>
+#include <CompiledPipelineCache.hpp>
+
+namespace NES
+{
+namespace
+{
+
+class CompiledPipelineCacheTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite() { Logger::setupLogging("CompiledPipelineCacheTest.log", LogLevel::LOG_DEBUG); }
+
+    /// Every call creates new operators with new operator ids
+    static LogicalPlan createPlan(const std::string& sourceName, const QueryId queryId)
+    {
+        const LogicalOperator source{SourceNameLogicalOperator(sourceName)};
+        const LogicalOperator selection{SelectionLogicalOperator(FieldAccessLogicalFunction("value")).withChildren({source})};
+        return LogicalPlan(queryId, {selection});
+    }
+
+    static Schema createSchema() { return Schema{}.addField("device_id", DataType::Type::INT32).addField("value", DataType::Type::INT32); }
+
+    static LogicalFunction createConstant(const std::string& value, const DataType::Type type)
+    {
+        return ConstantValueLogicalFunction(DataTypeProvider::provideDataType(type), value);
+    }
+
+    static LogicalPlan createSelectionPlan(const LogicalFunction& predicate, const QueryId queryId)
+    {
+        const LogicalOperator source{SourceNameLogicalOperator("source")};
+        const LogicalOperator selection{SelectionLogicalOperator(predicate).withChildren({source}).withInferredSchema({createSchema()})};
+        return LogicalPlan(queryId, {selection});
+    }
+
+    /// Selects the records whose value exceeds the threshold
+    static LogicalPlan
+    createThresholdPlan(const std::string& threshold, const QueryId queryId, const DataType::Type thresholdType = DataType::Type::INT32)
+    {
+        return createSelectionPlan(
+            GreaterLogicalFunction(FieldAccessLogicalFunction("value"), createConstant(threshold, thresholdType)), queryId);
+    }
+
+    /// Selects the records of a device, i.e., `WHERE device_id = <deviceId>`
+    static LogicalPlan createDevicePlan(const std::string& deviceId, const QueryId queryId)
+    {
+        return createSelectionPlan(
+            EqualsLogicalFunction(FieldAccessLogicalFunction("device_id"), createConstant(deviceId, DataType::Type::INT32)), queryId);
+    }
+
+    /// Maps the value of every record by adding the offset, i.e., `SELECT value + <offset> AS <name>`, or without name if it is nullopt
+    static LogicalPlan createMapPlan(const std::string& offset, const QueryId queryId, const std::optional<std::string>& name)
+    {
+        const LogicalOperator source{SourceNameLogicalOperator("source")};
+        const AddLogicalFunction function(FieldAccessLogicalFunction("value"), createConstant(offset, DataType::Type::INT32));
+        const LogicalOperator projection{
+            ProjectionLogicalOperator(
+                {{name.has_value() ? std::optional{FieldIdentifier(*name)} : std::nullopt, function}},
+                ProjectionLogicalOperator::Asterisk(false))
+                .withChildren({source})
+                .withInferredSchema({createSchema()})};
+        return LogicalPlan(queryId, {projection});
+    }
+
+    static LogicalPlan createTemplate(const LogicalPlan& plan) { return QueryCompilation::ParameterizeConstantsPhase::apply(plan); }
+};
+
+TEST_F(CompiledPipelineCacheTest, EqualPlansShareSlots)
+{
+    CompiledPipelineCache cache(4);
+    const auto slots = cache.getSlots(createPlan("source", QueryId(1)));
+    ASSERT_NE(slots, nullptr);
+    EXPECT_EQ(cache.getSlots(createPlan("source", QueryId(2))), slots);
+    EXPECT_NE(cache.getSlots(createPlan("otherSource", QueryId(3))), slots);
+
+    const auto slot = slots->getSlot(1, "PhysicalOperator(Scan);PhysicalOperator(Emit);");
+    ASSERT_NE(slot, nullptr);
+    EXPECT_EQ(slots->getSlot(1, "PhysicalOperator(Scan);PhysicalOperator(Emit);"), slot);
+    EXPECT_NE(slots->getSlot(0, "PhysicalOperator(Scan);PhysicalOperator(Emit);"), slot);
+    /// A different pipeline at the same position must not reuse the compiled code
+    EXPECT_EQ(slots->getSlot(1, "PhysicalOperator(Scan);PhysicalOperator(Selection);PhysicalOperator(Emit);"), nullptr);
+}
+
+TEST_F(CompiledPipelineCacheTest, EvictsLeastRecentlyUsedPlan)
+{
+    CompiledPipelineCache cache(2);
+    const auto first = cache.getSlots(createPlan("first", QueryId(1)));
+    const auto second = cache.getSlots(createPlan("second", QueryId(2)));
+    /// Using the first plan again makes the second plan the least recently used plan
+    EXPECT_EQ(cache.getSlots(createPlan("first", QueryId(3))), first);
+    const auto third = cache.getSlots(createPlan("third", QueryId(4)));
+    EXPECT_EQ(cache.getSlots(createPlan("first", QueryId(5))), first);
+    EXPECT_EQ(cache.getSlots(createPlan("third", QueryId(6))), third);
+    EXPECT_NE(cache.getSlots(createPlan("second", QueryId(7))), second);
+}
+
+TEST_F(CompiledPipelineCacheTest, PlansThatOnlyDifferInConstantsShareSlotsAsTemplates)
+{
+    CompiledPipelineCache cache(4);
+    const auto slots = cache.getSlots(createThresholdPlan("5", QueryId(1)));
+    EXPECT_NE(cache.getSlots(createThresholdPlan("7", QueryId(2))), slots);
+
+    const auto templateSlots = cache.getSlots(createTemplate(createThresholdPlan("5", QueryId(3))));
+    ASSERT_NE(templateSlots, nullptr);
+    EXPECT_NE(templateSlots, slots);
+    EXPECT_EQ(cache.getSlots(createTemplate(createThresholdPlan("7", QueryId(4)))), templateSlots);
+}
+
+TEST_F(CompiledPipelineCacheTest, SelectionsThatOnlyDifferInTheirConstantShareTheTemplate)
+{
+    CompiledPipelineCache cache(4);
+    const auto templateSlots = cache.getSlots(createTemplate(createDevicePlan("17", QueryId(1))));
+    ASSERT_NE(templateSlots, nullptr);
+    EXPECT_EQ(cache.getSlots(createTemplate(createDevicePlan("42", QueryId(2)))), templateSlots);
+    /// The same constant in another predicate is another template
+    EXPECT_NE(cache.getSlots(createTemplate(createThresholdPlan("17", QueryId(3)))), templateSlots);
+}
+
+TEST_F(CompiledPipelineCacheTest, NamedMapsThatOnlyDifferInTheirConstantShareTheTemplate)
+{
+    CompiledPipelineCache cache(4);
+    const auto templateSlots = cache.getSlots(createTemplate(createMapPlan("1", QueryId(1), "shifted")));
+    ASSERT_NE(templateSlots, nullptr);
+    EXPECT_EQ(cache.getSlots(createTemplate(createMapPlan("1000", QueryId(2), "shifted"))), templateSlots);
+    EXPECT_NE(cache.getSlots(createTemplate(createMapPlan("1", QueryId(3), "other"))), templateSlots);
+
+    /// The output field of an unnamed map is named after its function, thus its constant stays part of the plan
+    const auto unnamedSlots = cache.getSlots(createTemplate(createMapPlan("1", QueryId(4), std::nullopt)));
+    EXPECT_EQ(cache.getSlots(createTemplate(createMapPlan("1", QueryId(5), std::nullopt))), unnamedSlots);
+    EXPECT_NE(cache.getSlots(createTemplate(createMapPlan("1000", QueryId(6), std::nullopt))), unnamedSlots);
+}
+
+/// The compiled code reads a parameter as a value of its type, thus constants of different types never share a template
+TEST_F(CompiledPipelineCacheTest, ConstantsOfDifferentTypesDoNotShareTheTemplate)
+{
+    CompiledPipelineCache cache(4);
+    const auto int32Slots = cache.getSlots(createTemplate(createThresholdPlan("5", QueryId(1), DataType::Type::INT32)));
+    const auto int64Slots = cache.getSlots(createTemplate(createThresholdPlan("5", QueryId(2), DataType::Type::INT64)));
+    const auto float64Slots = cache.getSlots(createTemplate(createThresholdPlan("5", QueryId(3), DataType::Type::FLOAT64)));
+    EXPECT_NE(int32Slots, int64Slots);
+    EXPECT_NE(int32Slots, float64Slots);
+    EXPECT_NE(int64Slots, float64Slots);
+    EXPECT_EQ(cache.getSlots(createTemplate(createThresholdPlan("6", QueryId(4), DataType::Type::INT64))), int64Slots);
+}
+
+TEST_F(CompiledPipelineCacheTest, DisabledCache)
+{
+    CompiledPipelineCache cache(0);
+    EXPECT_EQ(cache.getSlots(createPlan("source", QueryId(1))), nullptr);
+}
+
+}
+}
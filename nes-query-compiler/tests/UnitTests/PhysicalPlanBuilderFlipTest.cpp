@@ -279,5 +279,38 @@ TEST_F(PhysicalPlanBuilderFlipTest, EdgeCountPreserved)
     EXPECT_EQ(countEdges(plan), expectedEdges);
 }
 
+/// Sink1 -> Union -> Source and Sink2 -> Union (the sinks of merged queries share the union). Verify a single source root, whose union
+/// fans out to both sinks.
+TEST_F(PhysicalPlanBuilderFlipTest, SharedOperatorOfMultipleRootsFlip)
+{
+    auto source = makeSourceWrapper();
+    auto unionOp = makeUnionWrapper();
+    auto sink1 = makeSinkWrapper();
+    auto sink2 = makeSinkWrapper();
+
+    unionOp->addChild(source);
+    sink1->addChild(unionOp);
+    sink2->addChild(unionOp);
+
+    auto builder = PhysicalPlanBuilder(QueryId(5));
+    builder.addSinkRoot(sink1);
+    builder.addSinkRoot(sink2);
+    auto plan = std::move(builder).finalize();
+
+    ASSERT_EQ(plan.getRootOperators().size(), 1U);
+    const auto& root = plan.getRootOperators()[0];
+    EXPECT_TRUE(root->getPhysicalOperator().tryGet<SourcePhysicalOperator>());
+    ASSERT_EQ(root->getChildren().size(), 1U);
+    const auto child = root->getChildren()[0];
+    EXPECT_TRUE(child->getPhysicalOperator().tryGet<UnionPhysicalOperator>());
+    ASSERT_EQ(child->getChildren().size(), 2U);
+    for (const auto& sink : child->getChildren())
+    {
+        EXPECT_TRUE(sink->getPhysicalOperator().tryGet<SinkPhysicalOperator>());
+    }
+    EXPECT_EQ(countNodes(plan), 4U);
+    EXPECT_EQ(countEdges(plan), 3U);
+}
+
 }
 }
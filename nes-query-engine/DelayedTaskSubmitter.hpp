@@ -14,24 +14,32 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <limits>
 #include <mutex>
-#include <queue>
 #include <stop_token>
 #include <utility>
 #include <vector>
 #include <absl/functional/any_invocable.h>
-#include <folly/Synchronized.h>
+#include <folly/concurrency/UnboundedQueue.h>
 #include <ErrorHandling.hpp>
 #include <Task.hpp>
 #include <Thread.hpp>
+#include <TimingWheel.hpp>
 
 namespace NES
 {
 
 /// The DelayedTaskSubmitter enables the query engine to defer submission of Tasks to a future point in time.
 /// This is mostly used to implement retry/repeat logic without spamming the taskqueue.
+///
+/// Writers hand their tasks to the thread of the DelayedTaskSubmitter via a lock-free queue, thus scheduling a task neither takes a
+/// lock nor orders it among the other scheduled tasks. The thread files the tasks into a hierarchical timing wheel with a resolution of
+/// TickDuration and submits all tasks that expired since its last wake-up as one batch. Writers only wake up the thread if their task
+/// expires before the thread would wake up anyway.
 template <typename CT = std::chrono::steady_clock>
 class DelayedTaskSubmitter
 {
@@ -39,26 +47,50 @@ public:
     using SubmitFn = absl::AnyInvocable<void(Task) const noexcept>;
     using ClockType = CT;
 
+    /// Tasks are submitted at most one tick after their deadline
+    using TickDuration = std::chrono::milliseconds;
+
 private:
+    using Tick = typename TimingWheel<Task>::Tick;
+
     struct ScheduledTask
     {
         Task task;
         typename ClockType::time_point deadline;
     };
 
-    /// Comparator for priority queue - earlier deadlines have higher priority
-    struct TaskComparator
+    /// The thread is awake and checks the incoming tasks before it goes to sleep
+    static constexpr Tick Awake = 0;
+    /// The thread sleeps until a writer wakes it up
+    static constexpr Tick Asleep = std::numeric_limits<Tick>::max();
+
+    static Tick toTick(const typename ClockType::time_point timePoint, const bool roundUp)
     {
-        bool operator()(const ScheduledTask& left, const ScheduledTask& right) const { return left.deadline > right.deadline; }
-    };
+        const auto ticks = roundUp ? std::chrono::ceil<TickDuration>(timePoint.time_since_epoch()).count()
+                                   : std::chrono::floor<TickDuration>(timePoint.time_since_epoch()).count();
+        return static_cast<Tick>(std::max<decltype(ticks)>(ticks, 0));
+    }
+
+    static typename ClockType::time_point fromTick(const Tick tick)
+    {
+        return typename ClockType::time_point(
+            std::chrono::duration_cast<typename ClockType::duration>(TickDuration(static_cast<TickDuration::rep>(tick))));
+    }
 
     SubmitFn submitFn;
 
-    std::condition_variable_any cv;
-    folly::Synchronized<std::priority_queue<ScheduledTask, std::vector<ScheduledTask>, TaskComparator>, std::mutex> taskQueueMtx;
+    folly::UMPSCQueue<ScheduledTask, false> incomingTasks;
+    /// Only accessed by the thread of the DelayedTaskSubmitter, or after it has been stopped
+    TimingWheel<Task> timingWheel;
+
+    /// The tick at which the thread wakes up next, or Awake/Asleep
+    std::atomic<Tick> wakeUpTick{Awake};
+    std::mutex wakeUpMutex;
+    std::condition_variable_any wakeUp;
+    bool wakeUpRequested = false;
 
-    /// The DelayedTaskSubmitter is implemented as its own dedicated thread. Most of the time is spent blocking on an empty task queue
-    /// or waiting until the deadline has passed to submit the next task.
+    /// The DelayedTaskSubmitter is implemented as its own dedicated thread. Most of the time is spent blocking until a writer wakes it
+    /// up or the next task expires.
     Thread workerThread;
 
     void workerLoop(const std::stop_token& stop);
@@ -70,18 +102,18 @@ public:
     template <typename Rep, typename Period>
     void submitTaskIn(Task task, std::chrono::duration<Rep, Period> delay)
     {
-        auto deadline = ClockType::now() + delay;
+        const auto deadline = ClockType::now() + delay;
+        incomingTasks.enqueue(ScheduledTask{std::move(task), deadline});
 
-        auto taskQueue = taskQueueMtx.lock();
-        const bool isEarliest = taskQueue->empty() || deadline < taskQueue->top().deadline;
-        taskQueue->emplace(ScheduledTask{std::move(task), deadline});
-
-        /// Wake up the worker thread if this task has an earlier deadline or if the taskqueue was empty.
-        /// This is necessary, as we need to set the cv_wait_until to ensure no task being missed.
-        if (isEarliest)
+        /// Pairs with the fence of the thread before it goes to sleep: either the thread sees the task, or the writer sees the wake-up tick
+        std::atomic_thread_fence(std::memory_order::seq_cst);
+        if (toTick(deadline, true) < wakeUpTick.load(std::memory_order::relaxed))
         {
-            taskQueue.unlock();
-            cv.notify_one();
+            {
+                const std::scoped_lock lock(wakeUpMutex);
+                wakeUpRequested = true;
+            }
+            wakeUp.notify_one();
         }
     }
 
@@ -96,51 +128,59 @@ public:
 
 template <typename CT>
 DelayedTaskSubmitter<CT>::DelayedTaskSubmitter(SubmitFn submitFn)
-    : submitFn(std::move(submitFn)), workerThread("task-delayer", &DelayedTaskSubmitter::workerLoop, this)
+    : submitFn(std::move(submitFn))
+    , timingWheel(toTick(ClockType::now(), false))
+    , workerThread("task-delayer", &DelayedTaskSubmitter::workerLoop, this)
 {
 }
 
 template <typename CT>
 void DelayedTaskSubmitter<CT>::workerLoop(const std::stop_token& stop)
 {
-    auto taskQueue = taskQueueMtx.lock();
+    std::vector<Task> expiredTasks;
     while (!stop.stop_requested())
     {
-        if (taskQueue->empty())
+        const auto now = ClockType::now();
+        ScheduledTask scheduledTask;
+        while (incomingTasks.try_dequeue(scheduledTask))
         {
-            /// Wait for tasks to be added or shutdown signal
-            cv.wait(taskQueue.as_lock(), stop, [&taskQueue] { return !taskQueue->empty(); });
-            continue;
+            if (scheduledTask.deadline <= now)
+            {
+                expiredTasks.emplace_back(std::move(scheduledTask.task));
+            }
+            else
+            {
+                timingWheel.insert(toTick(scheduledTask.deadline, true), std::move(scheduledTask.task), expiredTasks);
+            }
         }
-
-        auto now = ClockType::now();
-        const auto& nextTask = taskQueue->top();
-
-        if (nextTask.deadline <= now)
+        timingWheel.advance(toTick(now, false), expiredTasks);
+        for (auto& task : expiredTasks)
         {
-            /// Task deadline has arrived - execute it
-
-            /// Priority queue's API design has a limitation where top only returns a const reference, however we have to move the task out of the queue.
-            /// Since we have exclusive access to the queue, and we are removing the task from the queue anyways and the underlying memory has to be mutable, stripping away the constness is ok (I think).
-            /// NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
-            auto task = std::move(const_cast<ScheduledTask&>(nextTask).task);
-            taskQueue->pop();
-
-            /// Release lock while calling submit function to avoid blocking other operations
-            taskQueue.unlock();
             submitFn(std::move(task));
-            taskQueue = taskQueueMtx.lock();
         }
-        else
+        expiredTasks.clear();
+
+        const auto nextTick = timingWheel.getNextEventTick();
+        wakeUpTick.store(nextTick.value_or(Asleep), std::memory_order::relaxed);
+        std::atomic_thread_fence(std::memory_order::seq_cst);
+        if (!incomingTasks.empty())
+        {
+            wakeUpTick.store(Awake, std::memory_order::relaxed);
+            continue;
+        }
         {
-            auto nextDeadline = nextTask.deadline;
-            /// Wait until the next task deadline or until notified of new more urgent task
-            cv.wait_until(
-                taskQueue.as_lock(),
-                stop,
-                nextDeadline,
-                [&taskQueue, nextDeadline] { return !taskQueue->empty() && taskQueue->top().deadline < nextDeadline; });
+            std::unique_lock lock(wakeUpMutex);
+            const auto isWokenUp = [this] { return std::exchange(wakeUpRequested, false); };
+            if (nextTick)
+            {
+                wakeUp.wait_until(lock, stop, fromTick(*nextTick), isWokenUp);
+            }
+            else
+            {
+                wakeUp.wait(lock, stop, isWokenUp);
+            }
         }
+        wakeUpTick.store(Awake, std::memory_order::relaxed);
     }
 }
 
@@ -152,11 +192,13 @@ DelayedTaskSubmitter<CT>::~DelayedTaskSubmitter()
 
     /// Throw away all pending tasks, as the engine is about to shutdown and trying to actually execute these tasks is unlikely to
     /// succeed, in addition to potentially creating infinite cycles.
-    auto taskQueue = taskQueueMtx.lock();
-    while (!taskQueue->empty())
+    ScheduledTask scheduledTask;
+    while (incomingTasks.try_dequeue(scheduledTask))
+    {
+        failTask(scheduledTask.task, SkippingDelayedTaskDuringShutdown());
+    }
+    for (auto& task : timingWheel.clear())
     {
-        auto task = std::move(const_cast<ScheduledTask&>(taskQueue->top()).task);
-        taskQueue->pop();
         failTask(task, SkippingDelayedTaskDuringShutdown());
     }
 }
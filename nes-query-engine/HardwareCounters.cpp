@@ -0,0 +1,140 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <HardwareCounters.hpp>
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <utility>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <Util/Logger/Logger.hpp>
+#include <QueryEngineStatisticListener.hpp>
+
+namespace NES
+{
+
+namespace
+{
+struct EventType
+{
+    uint32_t type;
+    uint64_t config;
+};
+
+constexpr std::array<EventType, 4> EVENTS{
+    {{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+     {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+     {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+     {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES}}};
+
+int openEvent(const EventType& event, const int groupLeader)
+{
+    perf_event_attr attributes{};
+    attributes.size = sizeof(attributes);
+    attributes.type = event.type;
+    attributes.config = event.config;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    attributes.read_format = PERF_FORMAT_GROUP;
+    /// The leader starts the whole group once all of its events are opened
+    attributes.disabled = groupLeader == -1 ? 1 : 0;
+    /// pid 0 and cpu -1 count the calling thread on any cpu
+    return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, groupLeader, 0));
+}
+}
+
+std::optional<HardwareCounters> HardwareCounters::openForThisThread()
+{
+    std::array<int, NUMBER_OF_EVENTS> fileDescriptors{};
+    fileDescriptors.fill(-1);
+    /// Owns the events that are opened so far, so that they are closed if a later event fails
+    HardwareCounters counters(fileDescriptors);
+    for (size_t event = 0; event < NUMBER_OF_EVENTS; ++event)
+    {
+        counters.fileDescriptors[event] = openEvent(EVENTS[event], counters.fileDescriptors[0]);
+        if (counters.fileDescriptors[event] == -1)
+        {
+            NES_WARNING("Could not open hardware counter {}: {}", event, std::strerror(errno));
+            return std::nullopt;
+        }
+    }
+    ioctl(counters.fileDescriptors[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(counters.fileDescriptors[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return counters;
+}
+
+HardwareCounters::HardwareCounters(const std::array<int, NUMBER_OF_EVENTS>& fileDescriptors) : fileDescriptors(fileDescriptors)
+{
+}
+
+HardwareCounters::~HardwareCounters()
+{
+    close();
+}
+
+HardwareCounters::HardwareCounters(HardwareCounters&& other) noexcept : fileDescriptors(other.fileDescriptors)
+{
+    other.fileDescriptors.fill(-1);
+}
+
+HardwareCounters& HardwareCounters::operator=(HardwareCounters&& other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        fileDescriptors = std::exchange(other.fileDescriptors, {-1, -1, -1, -1});
+    }
+    return *this;
+}
+
+void HardwareCounters::close()
+{
+    /// Closing the members before the leader keeps the group intact until the end
+    for (auto fileDescriptor = fileDescriptors.rbegin(); fileDescriptor != fileDescriptors.rend(); ++fileDescriptor)
+    {
+        if (*fileDescriptor != -1)
+        {
+            ::close(*fileDescriptor);
+            *fileDescriptor = -1;
+        }
+    }
+}
+
+std::optional<HardwareCounterValues> HardwareCounters::read() const
+{
+    /// With PERF_FORMAT_GROUP, the leader reads the number of events followed by the value of every event in the order of opening
+    struct GroupValues
+    {
+        uint64_t numberOfEvents;
+        std::array<uint64_t, NUMBER_OF_EVENTS> values;
+    } groupValues{};
+    if (::read(fileDescriptors[0], &groupValues, sizeof(groupValues)) != static_cast<ssize_t>(sizeof(groupValues)))
+    {
+        return std::nullopt;
+    }
+    return HardwareCounterValues{
+        .cycles = groupValues.values[0],
+        .instructions = groupValues.values[1],
+        .lastLevelCacheMisses = groupValues.values[2],
+        .branchMisses = groupValues.values[3]};
+}
+
+}
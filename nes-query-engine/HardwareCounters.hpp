@@ -0,0 +1,54 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <QueryEngineStatisticListener.hpp>
+
+namespace NES
+{
+
+/// Counts the cycles, instructions, last level cache misses and branch misses of the calling thread in a group of perf events.
+/// The group is scheduled onto the PMU as a whole, thus, all counters cover the same time and reading them takes a single system call.
+/// The events exclude the kernel, so that they count without privileges under the default perf_event_paranoid setting.
+class HardwareCounters
+{
+public:
+    /// Returns nullopt if the kernel does not permit the perf events or the cpu does not provide all of them, e.g., in a VM
+    static std::optional<HardwareCounters> openForThisThread();
+
+    ~HardwareCounters();
+    HardwareCounters(const HardwareCounters&) = delete;
+    HardwareCounters& operator=(const HardwareCounters&) = delete;
+    HardwareCounters(HardwareCounters&& other) noexcept;
+    HardwareCounters& operator=(HardwareCounters&& other) noexcept;
+
+    /// The values count since the group was opened. Thus, the counts of a task are the difference of two reads.
+    /// Returns nullopt if the group could not be read.
+    [[nodiscard]] std::optional<HardwareCounterValues> read() const;
+
+private:
+    static constexpr size_t NUMBER_OF_EVENTS = 4;
+
+    explicit HardwareCounters(const std::array<int, NUMBER_OF_EVENTS>& fileDescriptors);
+    void close();
+
+    /// The first event is the leader of the group
+    std::array<int, NUMBER_OF_EVENTS> fileDescriptors;
+};
+
+}
@@ -0,0 +1,115 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <InflightBufferLimiter.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stop_token>
+
+namespace NES
+{
+
+InflightBufferLimiter::InflightBufferLimiter(const size_t maxLimit, const bool adaptive)
+    : maxLimit(std::max<size_t>(maxLimit, 1)), adaptive(adaptive), limit(this->maxLimit)
+{
+}
+
+bool InflightBufferLimiter::tryAcquire()
+{
+    auto current = inflight.load(std::memory_order::relaxed);
+    while (current < limit.load(std::memory_order::relaxed))
+    {
+        if (inflight.compare_exchange_weak(current, current + 1, std::memory_order::acquire, std::memory_order::relaxed))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool InflightBufferLimiter::acquire(const std::stop_token& stopToken)
+{
+    if (tryAcquire())
+    {
+        return true;
+    }
+    waitedInWindow.store(true, std::memory_order::relaxed);
+    std::unique_lock lock(waitMutex);
+    /// A release that does not observe the waiter decremented the inflight buffers before, thus the waiter observes the decrement
+    waiters.fetch_add(1);
+    const bool acquired = released.wait(lock, stopToken, [this] { return tryAcquire(); });
+    waiters.fetch_sub(1);
+    return acquired;
+}
+
+void InflightBufferLimiter::release(const std::chrono::nanoseconds turnaround)
+{
+    inflight.fetch_sub(1);
+    if (waiters.load() > 0)
+    {
+        const std::scoped_lock lock(waitMutex);
+        released.notify_one();
+    }
+
+    if (adaptive)
+    {
+        windowTurnaroundInNs.fetch_add(turnaround.count(), std::memory_order::relaxed);
+        if (windowReleases.fetch_add(1, std::memory_order::relaxed) + 1 >= limit.load(std::memory_order::relaxed))
+        {
+            adapt();
+        }
+    }
+}
+
+void InflightBufferLimiter::adapt()
+{
+    /// Another WorkerThread completed the window concurrently
+    const std::unique_lock lock(adaptMutex, std::try_to_lock);
+    if (not lock.owns_lock())
+    {
+        return;
+    }
+    const auto releases = windowReleases.exchange(0, std::memory_order::relaxed);
+    const auto turnaroundInNs = windowTurnaroundInNs.exchange(0, std::memory_order::relaxed);
+    const auto waited = waitedInWindow.exchange(false, std::memory_order::relaxed);
+    if (releases == 0)
+    {
+        return;
+    }
+
+    const auto averageInNs = turnaroundInNs / static_cast<int64_t>(releases);
+    if (baselineTurnaroundInNs == 0 or averageInNs < baselineTurnaroundInNs or ++windowsSinceBaseline > BASELINE_WINDOWS)
+    {
+        baselineTurnaroundInNs = std::max<int64_t>(averageInNs, 1);
+        windowsSinceBaseline = 0;
+    }
+
+    const auto current = limit.load(std::memory_order::relaxed);
+    if (static_cast<double>(averageInNs) > LATENCY_TOLERANCE * static_cast<double>(baselineTurnaroundInNs))
+    {
+        limit.store(std::max<size_t>(current / 2, 1), std::memory_order::relaxed);
+    }
+    else if (waited and current < maxLimit)
+    {
+        limit.store(current + 1, std::memory_order::relaxed);
+        const std::scoped_lock waitLock(waitMutex);
+        released.notify_all();
+    }
+}
+
+}
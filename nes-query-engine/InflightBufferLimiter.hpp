@@ -0,0 +1,76 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stop_token>
+
+namespace NES
+{
+
+/// Bounds the number of buffers that a source has inflight, i.e., emitted to the QueryEngine and not yet released by all successors.
+/// A static limiter always allows maxLimit buffers. An adaptive limiter adapts its limit between 1 and maxLimit to how fast the query
+/// releases the buffers of the source (AIMD):
+/// - Once per window of `limit` released buffers, it compares the average turnaround of the window, i.e., the time from emitting to
+///   releasing a buffer, to the lowest average turnaround of the recent windows.
+/// - If the turnaround exceeds the baseline by LATENCY_TOLERANCE, buffers queue up downstream, and the limit is halved.
+/// - Otherwise, if the source waited for the limit during the window, the limit grows by one buffer.
+/// Thus, a source of a slow query keeps few buffers inflight, while a bursty source grows its limit up to maxLimit.
+/// acquire and tryAcquire are called by the source thread, release is called by the WorkerThreads.
+class InflightBufferLimiter
+{
+public:
+    InflightBufferLimiter(size_t maxLimit, bool adaptive);
+
+    /// Blocks until fewer buffers than the limit are inflight. Returns false if the stop was requested while waiting.
+    bool acquire(const std::stop_token& stopToken);
+    bool tryAcquire();
+    void release(std::chrono::nanoseconds turnaround);
+
+    [[nodiscard]] size_t getLimit() const { return limit.load(std::memory_order::relaxed); }
+    [[nodiscard]] size_t getNumberOfInflightBuffers() const { return inflight.load(std::memory_order::relaxed); }
+    [[nodiscard]] bool isAdaptive() const { return adaptive; }
+
+    static constexpr double LATENCY_TOLERANCE = 2.0;
+    /// The baseline is re-measured after this many windows, so that it follows a query whose buffers become more expensive
+    static constexpr uint64_t BASELINE_WINDOWS = 64;
+
+private:
+    void adapt();
+
+    size_t maxLimit;
+    bool adaptive;
+    std::atomic<size_t> limit;
+    std::atomic<size_t> inflight{0};
+
+    std::mutex waitMutex;
+    std::condition_variable_any released;
+    std::atomic<size_t> waiters{0};
+
+    /// The releases of the current window. Only the thread that holds the adaptMutex evaluates and resets the window.
+    std::atomic<uint64_t> windowReleases{0};
+    std::atomic<int64_t> windowTurnaroundInNs{0};
+    std::atomic<bool> waitedInWindow{false};
+    std::mutex adaptMutex;
+    int64_t baselineTurnaroundInNs = 0;
+    uint64_t windowsSinceBaseline = 0;
+};
+
+}
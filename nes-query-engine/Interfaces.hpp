@@ -13,8 +13,10 @@
 */
 
 #pragma once
+#include <cstddef>
 #include <functional>
 #include <memory>
+#include <span>
 #include <Identifiers/Identifiers.hpp>
 #include <Runtime/TupleBuffer.hpp>
 #include <ErrorHandling.hpp>
@@ -25,6 +27,8 @@ namespace NES
 {
 struct RunningQueryPlanNode;
 class RunningSource;
+class InflightBufferLimiter;
+struct QueryCpuAccount;
 
 class QueryLifetimeController
 {
@@ -49,6 +53,30 @@ public:
         TaskCallback,
         PipelineExecutionContext::ContinuationPolicy continuationPolicy)
         = 0;
+
+    /// Creates and submits one Task per target for the same buffer, each with a callback created by `createCallback`.
+    /// Returns the number of submitted tasks, which target a prefix of the `targets`. By default, the tasks are submitted one by one.
+    virtual size_t emitWorkBatch(
+        QueryId queryId,
+        std::span<const std::shared_ptr<RunningQueryPlanNode>> targets,
+        const TupleBuffer& buffer,
+        const std::function<TaskCallback()>& createCallback,
+        PipelineExecutionContext::ContinuationPolicy continuationPolicy)
+    {
+        size_t emitted = 0;
+        while (emitted < targets.size() && emitWork(queryId, targets[emitted], buffer, createCallback(), continuationPolicy))
+        {
+            ++emitted;
+        }
+        return emitted;
+    }
+    /// Returns true if the source drops the buffer instead of emitting it to the targets, because the QueryEngine is overloaded.
+    /// By default, no buffer is dropped.
+    virtual bool shedWork(QueryId, OriginId, std::span<const std::shared_ptr<RunningQueryPlanNode>>, const TupleBuffer&) { return false; }
+    /// Exposes the inflight buffer limit of a source in the statistics as long as the source is running. By default, it is not exposed.
+    virtual void registerInflightBufferLimiter(QueryId, OriginId, std::weak_ptr<const InflightBufferLimiter>) { }
+    /// Returns the account of the cpu time of the query, which all pipelines of the query share. By default, nothing is accounted.
+    virtual std::shared_ptr<QueryCpuAccount> registerCpuAccount(QueryId) { return nullptr; }
     virtual void emitPipelineStart(QueryId, const std::shared_ptr<RunningQueryPlanNode>&, TaskCallback) = 0;
     virtual void emitPendingPipelineStop(QueryId, std::shared_ptr<RunningQueryPlanNode>, TaskCallback) = 0;
     virtual void emitPipelineStop(QueryId, std::unique_ptr<RunningQueryPlanNode>, TaskCallback) = 0;
@@ -0,0 +1,89 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <LoadShedder.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <CompiledQueryPlan.hpp>
+#include <QueryEngineConfiguration.hpp>
+
+namespace NES
+{
+
+LoadShedder::LoadShedder(const std::chrono::milliseconds queueWaitThreshold, const LoadSheddingPolicy policy)
+    : queueWaitThreshold(queueWaitThreshold), policy(policy)
+{
+}
+
+void LoadShedder::recordQueueWait(const std::chrono::nanoseconds queueWait)
+{
+    if (not isEnabled())
+    {
+        return;
+    }
+    auto smoothed = smoothedQueueWaitInNs.load(std::memory_order::relaxed);
+    while (not smoothedQueueWaitInNs.compare_exchange_weak(
+        smoothed, smoothed + ((queueWait.count() - smoothed) / SMOOTHING_DIVISOR), std::memory_order::relaxed))
+    {
+    }
+}
+
+std::chrono::nanoseconds LoadShedder::getQueueWait() const
+{
+    return std::chrono::nanoseconds(smoothedQueueWaitInNs.load(std::memory_order::relaxed));
+}
+
+double LoadShedder::getSheddingProbability(const QueryPriority priority) const
+{
+    const auto queueWait = getQueueWait();
+    if (not isEnabled() or queueWait <= queueWaitThreshold)
+    {
+        return 0;
+    }
+    const auto probability = 1 - (static_cast<double>(queueWaitThreshold.count()) / static_cast<double>(queueWait.count()));
+    switch (policy)
+    {
+        case LoadSheddingPolicy::RANDOM:
+            return std::min(probability, MAX_SHEDDING_PROBABILITY);
+        case LoadSheddingPolicy::PRIORITY:
+            switch (priority)
+            {
+                case QueryPriority::Low:
+                    return std::min(2 * probability, MAX_SHEDDING_PROBABILITY);
+                case QueryPriority::Normal:
+                    return std::min(probability, MAX_SHEDDING_PROBABILITY);
+                case QueryPriority::High:
+                    return 0;
+            }
+    }
+    std::unreachable();
+}
+
+bool LoadShedder::shouldShed(const QueryPriority priority) const
+{
+    const auto probability = getSheddingProbability(priority);
+    if (probability <= 0)
+    {
+        return false;
+    }
+    thread_local std::minstd_rand generator{std::random_device{}()};
+    return std::uniform_real_distribution<double>(0, 1)(generator) < probability;
+}
+
+}
@@ -0,0 +1,63 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <CompiledQueryPlan.hpp>
+#include <QueryEngineConfiguration.hpp>
+
+namespace NES
+{
+
+/// Detects overload from the time that tasks wait in the task queue, before a WorkerThread starts them, and decides which input buffers
+/// the sources drop before they reach the task queue. Dropping buffers at the sources keeps the admission queue from backpressuring the
+/// sources, thus the latency of the remaining buffers stays bounded during load spikes.
+/// While the smoothed queue wait exceeds the threshold, the sources drop the fraction of their buffers that would bring the queue wait
+/// back to the threshold, i.e., 1 - threshold / queue wait. The fraction never exceeds MAX_SHEDDING_PROBABILITY, as the queue wait
+/// is only updated by the buffers that are not dropped.
+/// All methods are thread-safe.
+class LoadShedder
+{
+public:
+    /// A threshold of zero disables the load shedding
+    LoadShedder(std::chrono::milliseconds queueWaitThreshold, LoadSheddingPolicy policy);
+
+    /// Called by the WorkerThreads with the time that a task waited in the task queue
+    void recordQueueWait(std::chrono::nanoseconds queueWait);
+    /// The exponentially smoothed queue wait of the recent tasks
+    [[nodiscard]] std::chrono::nanoseconds getQueueWait() const;
+
+    /// The fraction of the input buffers that the sources of a query with the priority drop at the current queue wait.
+    /// RANDOM drops the same fraction for all queries, PRIORITY drops twice the fraction for queries of low priority and never drops
+    /// the buffers of queries of high priority.
+    [[nodiscard]] double getSheddingProbability(QueryPriority priority) const;
+    /// Draws whether the source of a query with the priority drops its next buffer
+    [[nodiscard]] bool shouldShed(QueryPriority priority) const;
+
+    [[nodiscard]] bool isEnabled() const { return queueWaitThreshold.count() > 0; }
+
+    static constexpr double MAX_SHEDDING_PROBABILITY = 0.9;
+    /// Weight of a new queue wait in the smoothed queue wait
+    static constexpr int64_t SMOOTHING_DIVISOR = 8;
+
+private:
+    std::chrono::nanoseconds queueWaitThreshold;
+    LoadSheddingPolicy policy;
+    std::atomic<int64_t> smoothedQueueWaitInNs{0};
+};
+
+}
@@ -0,0 +1,138 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <QueryCpuAccounting.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+#include <ErrorHandling.hpp>
+#include <QueryEngine.hpp>
+
+namespace NES
+{
+
+QueryCpuAccounting::QueryCpuAccounting(
+    const size_t numberOfWorkerThreads, const size_t quotaInPercent, const std::chrono::milliseconds period, ThrottleCallback onThrottle)
+    : numberOfWorkerThreads(std::max<size_t>(numberOfWorkerThreads, 1))
+    , quotaInPercent(quotaInPercent)
+    , period(period)
+    , onThrottle(std::move(onThrottle))
+    , cyclesAtStart(readCycleCounter())
+    , timeAtStart(std::chrono::steady_clock::now())
+    , periodStart(timeAtStart)
+{
+    PRECONDITION(period.count() > 0, "The period of the cpu quota must be positive");
+}
+
+std::shared_ptr<QueryCpuAccount> QueryCpuAccounting::registerQuery(const QueryId queryId)
+{
+    auto account = std::make_shared<QueryCpuAccount>(queryId);
+    const std::scoped_lock lock(mutex);
+    /// The pipelines of terminated queries released their accounts
+    std::erase_if(accounts, [](const auto& registered) { return registered.second.expired(); });
+    accounts.insert_or_assign(queryId, account);
+    return account;
+}
+
+void QueryCpuAccounting::record(QueryCpuAccount& account, const uint64_t cycles)
+{
+    account.cycles.fetch_add(cycles, std::memory_order::relaxed);
+    const auto cyclesInPeriod = account.cyclesInPeriod.fetch_add(cycles, std::memory_order::relaxed) + cycles;
+    if (cyclesInPeriod <= cyclesPerPeriod.load(std::memory_order::relaxed) or account.throttled.load(std::memory_order::relaxed))
+    {
+        return;
+    }
+
+    /// The next period may have started in the meantime
+    const std::scoped_lock lock(mutex);
+    if (account.throttled.load(std::memory_order::relaxed)
+        or account.cyclesInPeriod.load(std::memory_order::relaxed) <= cyclesPerPeriod.load(std::memory_order::relaxed))
+    {
+        return;
+    }
+    account.throttled.store(true, std::memory_order::relaxed);
+    account.numberOfThrottledPeriods.fetch_add(1, std::memory_order::relaxed);
+    onThrottle(account.queryId, true);
+}
+
+void QueryCpuAccounting::startNextPeriodIfElapsed()
+{
+    const auto now = std::chrono::steady_clock::now();
+    const std::scoped_lock lock(mutex);
+    if (now - periodStart < period)
+    {
+        return;
+    }
+    periodStart = now;
+
+    if (isQuotaEnabled())
+    {
+        const auto cyclesPerNanosecond = static_cast<double>(readCycleCounter() - cyclesAtStart)
+            / static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - timeAtStart).count());
+        const auto nanosecondsPerPeriod = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(period).count())
+            * static_cast<double>(numberOfWorkerThreads) * static_cast<double>(quotaInPercent) / 100;
+        cyclesPerPeriod.store(static_cast<uint64_t>(nanosecondsPerPeriod * cyclesPerNanosecond), std::memory_order::relaxed);
+    }
+
+    for (const auto& [queryId, registered] : accounts)
+    {
+        if (const auto account = registered.lock())
+        {
+            account->cyclesInPeriod.store(0, std::memory_order::relaxed);
+            if (account->throttled.exchange(false, std::memory_order::relaxed))
+            {
+                onThrottle(queryId, false);
+            }
+        }
+    }
+}
+
+std::chrono::nanoseconds QueryCpuAccounting::toNanoseconds(const uint64_t cycles) const
+{
+    const auto elapsedCycles = readCycleCounter() - cyclesAtStart;
+    if (elapsedCycles == 0)
+    {
+        return std::chrono::nanoseconds(0);
+    }
+    const auto elapsedTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - timeAtStart);
+    return std::chrono::nanoseconds(
+        static_cast<int64_t>(static_cast<double>(cycles) * static_cast<double>(elapsedTime.count()) / static_cast<double>(elapsedCycles)));
+}
+
+std::vector<QueryEngineStatistics::QueryCpuTime> QueryCpuAccounting::getCpuTimes() const
+{
+    std::vector<QueryEngineStatistics::QueryCpuTime> cpuTimes;
+    const std::scoped_lock lock(mutex);
+    for (const auto& [queryId, registered] : accounts)
+    {
+        if (const auto account = registered.lock())
+        {
+            cpuTimes.push_back(
+                {.queryId = queryId,
+                 .cpuTime = toNanoseconds(account->cycles.load(std::memory_order::relaxed)),
+                 .numberOfThrottledPeriods = account->numberOfThrottledPeriods.load(std::memory_order::relaxed)});
+        }
+    }
+    return cpuTimes;
+}
+
+}
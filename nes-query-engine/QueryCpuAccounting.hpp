@@ -0,0 +1,108 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+#include <QueryEngine.hpp>
+
+#if defined(__x86_64__)
+    #include <x86intrin.h>
+#endif
+
+namespace NES
+{
+
+/// Reads the time stamp counter of the cpu, which takes a few cycles instead of reading a clock. Its rate is constant on current cpus,
+/// thus it measures time. Other architectures fall back to the steady clock, whose cycles are nanoseconds.
+inline uint64_t readCycleCounter()
+{
+#if defined(__x86_64__)
+    return __rdtsc();
+#else
+    const auto sinceEpoch = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(sinceEpoch).count());
+#endif
+}
+
+/// The cpu time that the WorkerThreads spent on the tasks of a query, which all pipelines of the query share
+struct QueryCpuAccount
+{
+    explicit QueryCpuAccount(const QueryId queryId) : queryId(queryId) { }
+
+    QueryId queryId;
+    std::atomic<uint64_t> cycles{0};
+    /// Cycles of the current quota period
+    std::atomic<uint64_t> cyclesInPeriod{0};
+    /// Solely changes while holding the mutex of the QueryCpuAccounting
+    std::atomic_bool throttled{false};
+    std::atomic<size_t> numberOfThrottledPeriods{0};
+};
+
+/// Accounts the cpu time of the tasks per query and enforces a cpu share per query. A query that used more than its share of the cpu
+/// time of all WorkerThreads in the current period gets throttled until the period ends, i.e., the WorkerThreads prefer the admission
+/// tasks of all other queries over its own. The throttling is work-conserving: the WorkerThreads still take the admission tasks of a
+/// throttled query if no other query has admission tasks, and they never delay the internal tasks of a query, as its buffers are already
+/// admitted.
+/// All methods are thread-safe.
+class QueryCpuAccounting
+{
+public:
+    /// Called while the throttling of a query starts or ends
+    using ThrottleCallback = std::function<void(QueryId, bool throttled)>;
+
+    /// A quota of zero disables the throttling, but the cpu time is still accounted
+    QueryCpuAccounting(size_t numberOfWorkerThreads, size_t quotaInPercent, std::chrono::milliseconds period, ThrottleCallback onThrottle);
+
+    /// Returns the account of the query, which the statistics report as long as any pipeline of the query holds it
+    std::shared_ptr<QueryCpuAccount> registerQuery(QueryId queryId);
+
+    /// Called by the WorkerThreads with the cycles that they spent on a task of the query. Throttles the query, once it exceeds its share.
+    void record(QueryCpuAccount& account, uint64_t cycles);
+
+    /// Starts the next period once the current period has elapsed, which ends the throttling of all queries. Called periodically.
+    void startNextPeriodIfElapsed();
+
+    [[nodiscard]] std::chrono::nanoseconds toNanoseconds(uint64_t cycles) const;
+    [[nodiscard]] std::vector<QueryEngineStatistics::QueryCpuTime> getCpuTimes() const;
+
+    [[nodiscard]] bool isQuotaEnabled() const { return quotaInPercent > 0; }
+
+private:
+    size_t numberOfWorkerThreads;
+    size_t quotaInPercent;
+    std::chrono::milliseconds period;
+    ThrottleCallback onThrottle;
+
+    /// The rate of the time stamp counter is calibrated against the steady clock over the lifetime of the accounting
+    uint64_t cyclesAtStart;
+    std::chrono::steady_clock::time_point timeAtStart;
+    std::chrono::steady_clock::time_point periodStart;
+    /// Cycles that a query may use per period. Not enforced before the first period is over, which calibrates the rate.
+    std::atomic<uint64_t> cyclesPerPeriod{UINT64_MAX};
+
+    mutable std::mutex mutex;
+    std::unordered_map<QueryId, std::weak_ptr<QueryCpuAccount>> accounts;
+};
+
+}
@@ -23,7 +23,9 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <new>
 #include <optional>
+#include <span>
 #include <stop_token>
 #include <thread>
 #include <unordered_map>
@@ -34,26 +36,38 @@
 #include <Identifiers/NESStrongType.hpp>
 #include <Listeners/AbstractQueryStatusListener.hpp>
 #include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/BufferManager.hpp>
+#include <Runtime/BufferOwnership.hpp>
 #include <Runtime/Execution/OperatorHandler.hpp>
 #include <Runtime/Execution/QueryStatus.hpp>
 #include <Runtime/QueryTerminationType.hpp>
 #include <Runtime/TupleBuffer.hpp>
+#include <Time/Timestamp.hpp>
 #include <Util/AtomicState.hpp>
+#include <Util/Strings.hpp>
 #include <fmt/format.h>
 #include <folly/MPMCQueue.h>
+#include <folly/Synchronized.h>
+#include <scope_guard.hpp>
+#include <CompiledQueryPlan.hpp>
 #include <DelayedTaskSubmitter.hpp>
 #include <EngineLogger.hpp>
 #include <ErrorHandling.hpp>
 #include <ExecutablePipelineStage.hpp>
 #include <ExecutableQueryPlan.hpp>
+#include <HardwareCounters.hpp>
+#include <InflightBufferLimiter.hpp>
 #include <Interfaces.hpp>
+#include <LoadShedder.hpp>
 #include <PipelineExecutionContext.hpp>
+#include <QueryCpuAccounting.hpp>
 #include <QueryEngineConfiguration.hpp>
 #include <QueryEngineStatisticListener.hpp>
 #include <RunningQueryPlan.hpp>
 #include <Task.hpp>
 #include <TaskQueue.hpp>
 #include <Thread.hpp>
+#include <WorkerThreadActivation.hpp>
 
 namespace NES
 {
@@ -69,6 +83,42 @@ namespace
 constexpr auto PIPELINE_STOP_BACKOFF_INTERVAL = std::chrono::milliseconds(25);
 constexpr auto PIPELINE_STOP_BACKOFF_THRESHOLD = 2;
 
+/// In PIPELINE_AFFINITY mode a WorkerThread processes the buffers emitted into a single successor immediately. To bound the stack depth
+/// and the time a WorkerThread does not look at the task queue, at most MAX_INLINED_PIPELINE_DEPTH pipelines are nested.
+constexpr auto MAX_INLINED_PIPELINE_DEPTH = 4;
+
+/// If thread-local buffer caches are enabled, every WorkerThread reports the counters of its cache after this many tasks.
+constexpr size_t BUFFER_CACHE_STATISTIC_INTERVAL = 1024;
+
+/// The ThreadPool samples the task queue every WORKER_SCALING_INTERVAL and activates another WorkerThread while the queued tasks
+/// outnumber the active WorkerThreads or the admission queue is at least half full. It retires a WorkerThread if the active
+/// WorkerThreads were less than half busy during the last WORKER_RETIREMENT_WINDOW, even without the retired WorkerThread.
+constexpr auto WORKER_SCALING_INTERVAL = std::chrono::milliseconds(10);
+constexpr auto WORKER_RETIREMENT_WINDOW = std::chrono::seconds(1);
+
+/// A minimum of zero keeps all WorkerThreads active
+WorkerThreadActivation::Limits getWorkerThreadLimits(const QueryEngineConfiguration& config)
+{
+    const auto numberOfWorkerThreads = config.numberOfWorkerThreads.getValue();
+    const auto minimum = config.minNumberOfWorkerThreads.getValue();
+    return {.minimum = minimum == 0 ? numberOfWorkerThreads : minimum, .maximum = numberOfWorkerThreads};
+}
+
+/// Number of tasks that the admission class of a query may admit per turn of the deficit round-robin across all queries
+constexpr size_t getAdmissionWeight(const QueryPriority priority)
+{
+    switch (priority)
+    {
+        case QueryPriority::Low:
+            return 1;
+        case QueryPriority::Normal:
+            return 4;
+        case QueryPriority::High:
+            return 16;
+    }
+    std::unreachable();
+}
+
 /// This function is unsafe because it requires the lifetime of the RunningQueryPlanNode exceed the lifetime of the callback
 auto injectQueryFailureUnsafe(RunningQueryPlanNode& node, TaskCallback::onFailure failure)
 {
@@ -127,6 +177,7 @@ auto injectReferenceCountReducer(
 }
 
 /// The Query has not been started yet. But a slot in the QueryCatalog has been reserved.
+/// Stopping a reserved query moves it directly into the terminated state, which causes the start to dispose the query plan.
 struct Reserved
 {
 };
@@ -186,14 +237,26 @@ public:
 
     void clear()
     {
-        const std::scoped_lock lock(mutex);
-        queryStates.clear();
+        /// Destroys the states, and thus the query plans, after releasing the lock
+        [[maybe_unused]] const auto states = std::exchange(*queryStates.wlock(), {});
     }
 
 private:
+    /// Returns the state of the query without holding the lock during its transitions
+    State find(QueryId queryId) const
+    {
+        const auto states = queryStates.rlock();
+        if (const auto it = states->find(queryId); it != states->end())
+        {
+            return it->second;
+        }
+        return nullptr;
+    }
+
     std::atomic<QueryId::Underlying> queryIdCounter = QueryId::INITIAL;
-    std::recursive_mutex mutex;
-    std::unordered_map<QueryId, State> queryStates;
+    /// Only guards the map. Each state is its own state machine, so that starting, stopping, and the lifetime callbacks of queries do not
+    /// serialize on the catalog.
+    folly::Synchronized<std::unordered_map<QueryId, State>> queryStates;
 };
 
 namespace detail
@@ -204,12 +267,15 @@ using Queue = folly::MPMCQueue<Task>;
 struct DefaultPEC final : PipelineExecutionContext
 {
     std::unordered_map<OperatorHandlerId, std::shared_ptr<OperatorHandler>>* operatorHandlers = nullptr;
-    std::function<bool(const TupleBuffer& tb, ContinuationPolicy)> handler;
+    std::function<bool(TupleBuffer tb, ContinuationPolicy)> handler;
     std::function<void(const TupleBuffer& tb, std::chrono::milliseconds duration)> repeatHandler;
     std::shared_ptr<AbstractBufferProvider> bm;
     size_t numberOfThreads;
     WorkerThreadId threadId;
     PipelineId pipelineId;
+    /// Only set for the tasks that execute the pipeline, which report the load of the engine (see getNumberOfQueuedTasks)
+    const TaskQueue<Task>* taskQueue = nullptr;
+    const RunningQueryPlanNode* node = nullptr;
     /// We want to ensure that the address of the TupleBuffer is always the same. If we would simply store the object directly in the vector,
     /// the address might change as the vector might be resized and thus, the object have a different address.
     std::vector<std::unique_ptr<TupleBuffer>> pinnedBuffers;
@@ -223,7 +289,7 @@ struct DefaultPEC final : PipelineExecutionContext
         WorkerThreadId threadId,
         PipelineId pipelineId,
         std::shared_ptr<AbstractBufferProvider> bm,
-        std::function<bool(const TupleBuffer& tb, ContinuationPolicy)> handler,
+        std::function<bool(TupleBuffer tb, ContinuationPolicy)> handler,
         std::function<void(const TupleBuffer& tb, std::chrono::milliseconds)> repeatHandler)
         : handler(std::move(handler))
         , repeatHandler(std::move(repeatHandler))
@@ -259,10 +325,10 @@ struct DefaultPEC final : PipelineExecutionContext
         return numberOfThreads;
     }
 
-    bool emitBuffer(const TupleBuffer& buffer, ContinuationPolicy policy) override
+    bool emitBuffer(TupleBuffer buffer, ContinuationPolicy policy) override
     {
         PRECONDITION(!wasRepeated, "A task should terminate after repeating");
-        return handler(buffer, policy);
+        return handler(std::move(buffer), policy);
     }
 
     void repeatTask(const TupleBuffer& buffer, std::chrono::milliseconds duration) override
@@ -281,6 +347,13 @@ struct DefaultPEC final : PipelineExecutionContext
         return bm;
     }
 
+    [[nodiscard]] uint64_t getNumberOfQueuedTasks() const override
+    {
+        return taskQueue == nullptr ? 0 : taskQueue->getNumberOfInternalTasks() + taskQueue->getNumberOfAdmissionTasks();
+    }
+
+    [[nodiscard]] uint64_t getNumberOfSubmittedTasks() const override { return node == nullptr ? 0 : node->submittedTasks.load(); }
+
     [[nodiscard]] PipelineId getPipelineId() const override
     {
         PRECONDITION(!wasRepeated, "A task should terminate after repeating");
@@ -318,21 +391,13 @@ public:
         TaskCallback callback,
         const PipelineExecutionContext::ContinuationPolicy continuationPolicy) override
     {
-        [[maybe_unused]] auto updatedCount = node->pendingTasks.fetch_add(1) + 1;
-        ENGINE_LOG_DEBUG("Increasing number of pending tasks on pipeline {}-{} to {}", qid, node->id, updatedCount);
-        auto [complete, failure, success] = std::move(callback).take();
-        /// Create a new callback that wraps the reference count reducer
-        auto wrappedCallback = TaskCallback{
-            TaskCallback::OnComplete(injectReferenceCountReducer(ENGINE_IF_LOG_DEBUG(qid, ) node, std::move(complete.callback))),
-            std::move(success),
-            TaskCallback::OnFailure(injectQueryFailure(node, std::move(failure.callback))),
-        };
-
-        auto task = WorkTask(qid, node->id, node, std::move(buffer), std::move(wrappedCallback));
+        auto task = createWorkTask(qid, node, std::move(buffer), std::move(callback));
         if (WorkerThread::id == INVALID<WorkerThreadId>)
         {
-            /// Non-WorkerThread
-            taskQueue.addAdmissionTaskBlocking({}, std::move(task));
+            /// Non-WorkerThread. Each query gets its own admission class, which backpressures solely the sources of the query.
+            /// The tasks that control the lifetime of queries and sources share the default admission class.
+            const TaskQueue<Task>::AdmissionClass admissionClass{.key = qid.getRawValue(), .weight = getAdmissionWeight(node->priority)};
+            taskQueue.addAdmissionTaskBlocking({}, admissionClass, std::move(task));
             ENGINE_LOG_DEBUG("Task written to AdmissionQueue");
             return true;
         }
@@ -348,6 +413,60 @@ public:
         std::unreachable();
     }
 
+    /// Non-WorkerThreads write the tasks of all targets into the admission queue at once
+    size_t emitWorkBatch(
+        QueryId qid,
+        std::span<const std::shared_ptr<RunningQueryPlanNode>> targets,
+        const TupleBuffer& buffer,
+        const std::function<TaskCallback()>& createCallback,
+        const PipelineExecutionContext::ContinuationPolicy continuationPolicy) override
+    {
+        if (WorkerThread::id != INVALID<WorkerThreadId> || targets.size() <= 1)
+        {
+            return WorkEmitter::emitWorkBatch(qid, targets, buffer, createCallback, continuationPolicy);
+        }
+
+        std::vector<Task> tasks;
+        tasks.reserve(targets.size());
+        for (const auto& target : targets)
+        {
+            tasks.emplace_back(createWorkTask(qid, target, buffer, createCallback()));
+        }
+        const TaskQueue<Task>::AdmissionClass admissionClass{
+            .key = qid.getRawValue(), .weight = getAdmissionWeight(targets.front()->priority)};
+        taskQueue.addAdmissionTasksBlocking({}, admissionClass, tasks);
+        ENGINE_LOG_DEBUG("{} Tasks written to AdmissionQueue", tasks.size());
+        return tasks.size();
+    }
+
+    bool shedWork(
+        const QueryId qid,
+        const OriginId sourceId,
+        const std::span<const std::shared_ptr<RunningQueryPlanNode>> targets,
+        const TupleBuffer& buffer) override
+    {
+        if (targets.empty() || !loadShedder.shouldShed(targets.front()->priority))
+        {
+            return false;
+        }
+        numberOfShedBuffers.fetch_add(1, std::memory_order::relaxed);
+        numberOfShedTuples.fetch_add(buffer.getNumberOfTuples(), std::memory_order::relaxed);
+        statistic->onEvent(BufferShed{qid, sourceId, buffer.getNumberOfTuples()});
+        ENGINE_LOG_DEBUG("Source {} of query {} shed a buffer of {} tuples", sourceId, qid, buffer.getNumberOfTuples());
+        return true;
+    }
+
+    void registerInflightBufferLimiter(
+        const QueryId qid, const OriginId sourceId, std::weak_ptr<const InflightBufferLimiter> limiter) override
+    {
+        auto limiters = inflightBufferLimiters.wlock();
+        /// Sources of terminated queries released their limiter
+        std::erase_if(*limiters, [](const auto& registered) { return registered.limiter.expired(); });
+        limiters->push_back({.queryId = qid, .sourceId = sourceId, .limiter = std::move(limiter)});
+    }
+
+    std::shared_ptr<QueryCpuAccount> registerCpuAccount(const QueryId qid) override { return cpuAccounting.registerQuery(qid); }
+
     void emitPipelineStart(QueryId qid, const std::shared_ptr<RunningQueryPlanNode>& node, TaskCallback callback) override
     {
         auto [complete, failure, success] = std::move(callback).take();
@@ -409,13 +528,42 @@ public:
     ThreadPool(
         std::shared_ptr<AbstractQueryStatusListener> listener,
         std::shared_ptr<QueryEngineStatisticListener> stats,
-        std::shared_ptr<AbstractBufferProvider> bufferProvider,
-        const size_t admissionQueueSize)
+        std::shared_ptr<BufferManager> bufferManager,
+        const size_t admissionQueueSize,
+        const size_t numberOfWorkerThreads,
+        const TaskSchedulingMode schedulingMode,
+        const WorkerIdleStrategy idleStrategy,
+        const size_t taskBatchSize,
+        std::vector<size_t> workerThreadCpus,
+        const WorkerThreadActivation::Limits workerThreadLimits,
+        const std::chrono::milliseconds loadSheddingQueueWaitThreshold,
+        const LoadSheddingPolicy loadSheddingPolicy,
+        const bool countHardwareEvents,
+        const size_t queryCpuQuotaInPercent,
+        const std::chrono::milliseconds queryCpuQuotaPeriod)
         : listener(std::move(listener))
         , statistic(std::move(stats))
-        , bufferProvider(std::move(bufferProvider))
-        , taskQueue(admissionQueueSize)
+        , bufferProvider(bufferManager)
+        , bufferManager(std::move(bufferManager))
+        , inlineSuccessors(schedulingMode == TaskSchedulingMode::PIPELINE_AFFINITY)
+        , taskBatchSize(std::max<size_t>(taskBatchSize, 1))
+        , workerThreadCpus(std::move(workerThreadCpus))
+        , countHardwareEvents(countHardwareEvents)
+        , taskQueue(
+              admissionQueueSize,
+              schedulingMode == TaskSchedulingMode::GLOBAL_QUEUE ? 0 : numberOfWorkerThreads,
+              idleStrategy == WorkerIdleStrategy::SPIN_THEN_PARK)
         , delayedTaskSubmitter([this](Task&& task) noexcept { taskQueue.addInternalTaskNonBlocking(std::move(task)); })
+        , workerThreadCounters(numberOfWorkerThreads)
+        , workerThreadActivation(numberOfWorkerThreads, workerThreadLimits)
+        , loadShedder(loadSheddingQueueWaitThreshold, loadSheddingPolicy)
+        , cpuAccounting(
+              numberOfWorkerThreads,
+              queryCpuQuotaInPercent,
+              queryCpuQuotaPeriod,
+              [this](const QueryId queryId, const bool throttled)
+              { taskQueue.setAdmissionClassThrottled(queryId.getRawValue(), throttled); })
+        , scalingThread("WorkerScaling", [this](const std::stop_token& stopToken) { scaleWorkerThreads(stopToken); })
     {
     }
 
@@ -426,9 +574,77 @@ public:
 
     [[nodiscard]] size_t numberOfThreads() const { return numberOfThreads_.load(); }
 
+    [[nodiscard]] QueryEngineStatistics getStatistics() const
+    {
+        QueryEngineStatistics statistics{
+            .numberOfInternalTasks = taskQueue.getNumberOfInternalTasks(),
+            .numberOfAdmissionTasks = taskQueue.getNumberOfAdmissionTasks(),
+            .admissionQueueCapacity = taskQueue.getAdmissionCapacity(),
+            .numberOfActiveWorkerThreads = workerThreadActivation.getNumberOfActiveWorkerThreads(),
+            .busyTimePerWorkerThread = {},
+            .numberOfShedBuffers = numberOfShedBuffers.load(std::memory_order::relaxed),
+            .numberOfShedTuples = numberOfShedTuples.load(std::memory_order::relaxed)};
+        statistics.busyTimePerWorkerThread.reserve(workerThreadCounters.size());
+        for (const auto& counters : workerThreadCounters)
+        {
+            statistics.busyTimePerWorkerThread.emplace_back(counters.busyTimeInNs.load(std::memory_order::relaxed));
+        }
+        for (const auto& [queryId, sourceId, weakLimiter] : *inflightBufferLimiters.rlock())
+        {
+            if (const auto limiter = weakLimiter.lock())
+            {
+                statistics.inflightBuffersPerSource.push_back(
+                    {.queryId = queryId,
+                     .sourceId = sourceId,
+                     .limit = limiter->getLimit(),
+                     .numberOfInflightBuffers = limiter->getNumberOfInflightBuffers()});
+            }
+        }
+        statistics.cpuTimePerQuery = cpuAccounting.getCpuTimes();
+        return statistics;
+    }
+
+    /// Pipelines of queries with a memory quota request their buffers from the buffer provider of their query
+    [[nodiscard]] const std::shared_ptr<AbstractBufferProvider>& getBufferProvider(const RunningQueryPlanNode& node) const
+    {
+        return node.bufferProvider ? node.bufferProvider : bufferProvider;
+    }
+
+    /// Emits work from a WorkerThread into the successor of the currently executed pipeline. In PIPELINE_AFFINITY mode the successor
+    /// is executed immediately on the calling WorkerThread if it is the only successor and the continuation policy permits it.
+    /// This keeps the TupleBuffer in the caches of the producing core. Otherwise, this falls back to regular `emitWork`.
+    bool emitSuccessorWork(
+        QueryId qid,
+        const std::shared_ptr<RunningQueryPlanNode>& node,
+        TupleBuffer buffer,
+        const bool hasFanOut,
+        const PipelineExecutionContext::ContinuationPolicy continuationPolicy)
+    {
+        if (!inlineSuccessors || hasFanOut || continuationPolicy != PipelineExecutionContext::ContinuationPolicy::POSSIBLE
+            || WorkerThread::inlinedPipelineDepth >= MAX_INLINED_PIPELINE_DEPTH)
+        {
+            return emitWork(qid, node, std::move(buffer), TaskCallback{}, continuationPolicy);
+        }
+
+        ++WorkerThread::inlinedPipelineDepth;
+        SCOPE_EXIT
+        {
+            --WorkerThread::inlinedPipelineDepth;
+        };
+        ENGINE_LOG_DEBUG("Processing successor pipeline {}-{} in place", qid, node->id);
+        handleTask(WorkerThread{*this, false}, createWorkTask(qid, node, std::move(buffer), TaskCallback{}));
+        return true;
+    }
+
     struct WorkerThread
     {
         static thread_local WorkerThreadId id;
+        /// Number of pipelines which are currently executed in place (see `emitSuccessorWork`) on this WorkerThread.
+        static thread_local size_t inlinedPipelineDepth;
+        /// Tasks that the WorkerThread emitted into the shared internal queue while handling its current task, if it batches them
+        static thread_local std::vector<Task>* emittedTasks;
+        /// The perf events of the WorkerThread, if it counts hardware events around the execution of its tasks
+        static thread_local const HardwareCounters* hardwareCounters;
 
         [[nodiscard]] WorkerThread(ThreadPool& pool, bool terminating) : pool(pool), terminating(terminating) { }
 
@@ -449,32 +665,121 @@ public:
     };
 
 private:
+    /// Creates a new WorkTask and registers it as pending on the target node.
+    WorkTask createWorkTask(QueryId qid, const std::shared_ptr<RunningQueryPlanNode>& node, TupleBuffer buffer, TaskCallback callback)
+    {
+        [[maybe_unused]] auto updatedCount = node->pendingTasks.fetch_add(1) + 1;
+        node->submittedTasks.fetch_add(1, std::memory_order::relaxed);
+        ENGINE_LOG_DEBUG("Increasing number of pending tasks on pipeline {}-{} to {}", qid, node->id, updatedCount);
+        auto [complete, failure, success] = std::move(callback).take();
+        /// Create a new callback that wraps the reference count reducer
+        auto wrappedCallback = TaskCallback{
+            TaskCallback::OnComplete(injectReferenceCountReducer(ENGINE_IF_LOG_DEBUG(qid, ) node, std::move(complete.callback))),
+            std::move(success),
+            TaskCallback::OnFailure(injectQueryFailure(node, std::move(failure.callback))),
+        };
+
+        return WorkTask(qid, node->id, node, std::move(buffer), std::move(wrappedCallback));
+    }
+
+    /// Reports the counters of the thread-local buffer cache of the calling WorkerThread, if thread-local caches are enabled.
+    void emitBufferCacheStatistic() const
+    {
+        if (const auto cacheStatistics = bufferManager->getThreadLocalCacheStatistics())
+        {
+            statistic->onEvent(BufferCacheStatistic{WorkerThread::id, cacheStatistics->hits, cacheStatistics->misses});
+        }
+    }
+
     void addInternalTask(Task&& task)
     {
         PRECONDITION(ThreadPool::WorkerThread::id != INVALID<WorkerThreadId>, "This should only be called from a worker thread");
+        if (taskQueue.hasLocalQueues())
+        {
+            /// In work-stealing mode follow-up tasks stay with the emitting WorkerThread, unless a peer is idle.
+            taskQueue.addLocalTaskNonBlocking(ThreadPool::WorkerThread::id.getRawValue(), std::move(task));
+            return;
+        }
+        if (auto* emittedTasks = WorkerThread::emittedTasks)
+        {
+            emittedTasks->emplace_back(std::move(task));
+            if (emittedTasks->size() >= taskBatchSize)
+            {
+                submitEmittedTasks();
+            }
+            return;
+        }
         taskQueue.addInternalTaskNonBlocking(std::move(task)); /// NOLINT no move will happen if tryWriteUntil has failed
     }
 
+    /// Submits the batch of emitted tasks of the calling WorkerThread with a single release of the task queue
+    void submitEmittedTasks()
+    {
+        if (auto* emittedTasks = WorkerThread::emittedTasks)
+        {
+            taskQueue.addInternalTasksNonBlocking(*emittedTasks);
+            emittedTasks->clear();
+        }
+    }
+
     /// Order of destruction matters: TaskQueue has to outlive the pool
     std::shared_ptr<AbstractQueryStatusListener> listener;
     std::shared_ptr<QueryEngineStatisticListener> statistic;
     std::shared_ptr<AbstractBufferProvider> bufferProvider;
+    std::shared_ptr<BufferManager> bufferManager;
     std::atomic<TaskId::Underlying> taskIdCounter;
 
+    bool inlineSuccessors;
+    size_t taskBatchSize;
+    /// WorkerThread i is pinned to cpu i (modulo the number of cpus), if any cpus are configured
+    std::vector<size_t> workerThreadCpus;
+    bool countHardwareEvents;
     TaskQueue<Task> taskQueue;
     DelayedTaskSubmitter<> delayedTaskSubmitter;
 
+    /// Each WorkerThread is the only writer of its counters, which live on their own cache line to avoid false sharing.
+    struct alignas(std::hardware_destructive_interference_size) WorkerThreadCounters
+    {
+        std::atomic<int64_t> busyTimeInNs{0};
+    };
+
+    std::vector<WorkerThreadCounters> workerThreadCounters;
+    WorkerThreadActivation workerThreadActivation;
+    LoadShedder loadShedder;
+    /// The admission classes of the task queue are the queries, thus the accounting throttles the admission class of a query
+    QueryCpuAccounting cpuAccounting;
+    std::atomic<size_t> numberOfShedBuffers{0};
+    std::atomic<size_t> numberOfShedTuples{0};
+
+    struct RegisteredInflightBufferLimiter
+    {
+        QueryId queryId;
+        OriginId sourceId;
+        std::weak_ptr<const InflightBufferLimiter> limiter;
+    };
+
+    folly::Synchronized<std::vector<RegisteredInflightBufferLimiter>> inflightBufferLimiters;
+
+    [[nodiscard]] std::chrono::nanoseconds getTotalBusyTime() const;
+    /// Activates and retires WorkerThreads with the load, within the limits of the workerThreadActivation
+    void scaleWorkerThreads(const std::stop_token& stopToken);
+
     /// Class Invariant: numberOfThreads == pool.size().
     /// We don't want to expose the vector directly to anyone, as this would introduce a race condition.
     /// The number of threads is only available via the atomic.
     std::vector<Thread> pool;
     std::atomic<int32_t> numberOfThreads_;
+    /// Stops before the WorkerThreads, as it activates them
+    Thread scalingThread;
 
     friend class QueryEngine;
 };
 
 /// Marks every Thread which has not explicitly been created by the ThreadPool as a non-worker thread
 thread_local WorkerThreadId ThreadPool::WorkerThread::id = INVALID<WorkerThreadId>;
+thread_local size_t ThreadPool::WorkerThread::inlinedPipelineDepth = 0;
+thread_local std::vector<Task>* ThreadPool::WorkerThread::emittedTasks = nullptr;
+thread_local const HardwareCounters* ThreadPool::WorkerThread::hardwareCounters = nullptr;
 
 bool ThreadPool::WorkerThread::operator()(WorkTask& task) const
 {
@@ -493,19 +798,27 @@ bool ThreadPool::WorkerThread::operator()(WorkTask& task) const
             pool.numberOfThreads(),
             WorkerThread::id,
             pipeline->id,
-            pool.bufferProvider,
-            [&](const TupleBuffer& tupleBuffer, PipelineExecutionContext::ContinuationPolicy continuationPolicy)
+            pool.getBufferProvider(*pipeline),
+            [&](TupleBuffer tupleBuffer, PipelineExecutionContext::ContinuationPolicy continuationPolicy)
             {
                 ENGINE_LOG_DEBUG(
                     "Task emitted tuple buffer {}-{}. Tuples: {}", task.queryId, task.pipelineId, tupleBuffer.getNumberOfTuples());
-                return std::ranges::all_of(
-                    pipeline->successors,
-                    [&](const auto& successor)
+                /// Only a fan-out shares the buffer between the successors, the last (or only) successor takes over its ownership
+                const auto& successors = pipeline->successors;
+                const bool hasFanOut = successors.size() > 1;
+                for (size_t successorIndex = 0; successorIndex < successors.size(); ++successorIndex)
+                {
+                    const auto& successor = successors[successorIndex];
+                    pool.statistic->onEvent(
+                        TaskEmit{id, task.queryId, pipeline->id, successor->id, taskId, tupleBuffer.getNumberOfTuples()});
+                    const bool isLastSuccessor = successorIndex == successors.size() - 1;
+                    if (!pool.emitSuccessorWork(
+                            task.queryId, successor, isLastSuccessor ? std::move(tupleBuffer) : tupleBuffer, hasFanOut, continuationPolicy))
                     {
-                        pool.statistic->onEvent(
-                            TaskEmit{id, task.queryId, pipeline->id, successor->id, taskId, tupleBuffer.getNumberOfTuples()});
-                        return pool.emitWork(task.queryId, successor, tupleBuffer, TaskCallback{}, continuationPolicy);
-                    });
+                        return false;
+                    }
+                }
+                return true;
             },
             [&](const TupleBuffer& tupleBuffer, std::chrono::milliseconds duration)
             {
@@ -522,9 +835,40 @@ bool ThreadPool::WorkerThread::operator()(WorkTask& task) const
             }
 
         );
-        pool.statistic->onEvent(TaskExecutionStart{WorkerThread::id, task.queryId, pipeline->id, taskId, task.buf.getNumberOfTuples()});
-        pipeline->stage->execute(task.buf, pec);
-        pool.statistic->onEvent(TaskExecutionComplete{WorkerThread::id, task.queryId, pipeline->id, taskId});
+        pec.taskQueue = &pool.taskQueue;
+        pec.node = pipeline.get();
+        const TaskExecutionStart taskStart{
+            WorkerThread::id, task.queryId, pipeline->id, taskId, task.buf.getNumberOfTuples(), task.submissionTimestamp};
+        pool.statistic->onEvent(taskStart);
+        pool.loadShedder.recordQueueWait(taskStart.timestamp - task.submissionTimestamp);
+        const auto countersAtStart = WorkerThread::hardwareCounters ? WorkerThread::hardwareCounters->read() : std::nullopt;
+        const auto cyclesAtStart = readCycleCounter();
+        {
+            const BufferOwnership::Scope bufferOwner({.queryId = task.queryId, .pipelineId = pipeline->id});
+            pipeline->stage->execute(task.buf, pec);
+        }
+        /// The cycles of the outermost task include the successors of the same query that it executed in place
+        if (pipeline->cpuAccount && WorkerThread::inlinedPipelineDepth == 0)
+        {
+            pool.cpuAccounting.record(*pipeline->cpuAccount, readCycleCounter() - cyclesAtStart);
+        }
+        TaskExecutionComplete taskComplete{WorkerThread::id, task.queryId, pipeline->id, taskId, taskStart.timestamp};
+        if (countersAtStart)
+        {
+            if (const auto countersAtEnd = WorkerThread::hardwareCounters->read())
+            {
+                taskComplete.hardwareCounters = *countersAtEnd - *countersAtStart;
+            }
+        }
+        taskComplete.isSink = pipeline->successors.empty();
+        const auto toTimePoint = [](const Timestamp timestampInNs)
+        {
+            return ChronoClock::time_point(
+                std::chrono::duration_cast<ChronoClock::duration>(std::chrono::nanoseconds(timestampInNs.getRawValue())));
+        };
+        taskComplete.minIngestionTimestamp = toTimePoint(task.buf.getMinIngestionTimestampInNS());
+        taskComplete.maxIngestionTimestamp = toTimePoint(task.buf.getMaxIngestionTimestampInNS());
+        pool.statistic->onEvent(taskComplete);
         return true;
     }
 
@@ -550,7 +894,7 @@ bool ThreadPool::WorkerThread::operator()(StartPipelineTask& startPipeline) cons
             pool.numberOfThreads(),
             WorkerThread::id,
             pipeline->id,
-            pool.bufferProvider,
+            pool.getBufferProvider(*pipeline),
             [](const TupleBuffer&, PipelineExecutionContext::ContinuationPolicy)
             {
                 /// Catch Emits, that are currently not supported during pipeline stage initialization.
@@ -567,7 +911,10 @@ bool ThreadPool::WorkerThread::operator()(StartPipelineTask& startPipeline) cons
                     "Repeat pipeline setup is currently not supported. Although there is no inherit reason this wouldn't work, but its not "
                     "tested");
             });
-        pipeline->stage->start(pec);
+        {
+            const BufferOwnership::Scope bufferOwner({.queryId = startPipeline.queryId, .pipelineId = pipeline->id});
+            pipeline->stage->start(pec);
+        }
         pool.statistic->onEvent(PipelineStart{WorkerThread::id, startPipeline.queryId, pipeline->id});
         return true;
     }
@@ -628,7 +975,7 @@ bool ThreadPool::WorkerThread::operator()(StopPipelineTask& stopPipelineTask) co
         pool.numberOfThreads(),
         WorkerThread::id,
         stopPipelineTask.pipeline->id,
-        pool.bufferProvider,
+        pool.getBufferProvider(*stopPipelineTask.pipeline),
         [&](const TupleBuffer& tupleBuffer, PipelineExecutionContext::ContinuationPolicy policy)
         {
             if (terminating)
@@ -663,7 +1010,10 @@ bool ThreadPool::WorkerThread::operator()(StopPipelineTask& stopPipelineTask) co
     ENGINE_LOG_DEBUG("Stopping Pipeline {}-{}", stopPipelineTask.queryId, stopPipelineTask.pipeline->id);
     auto pipelineId = stopPipelineTask.pipeline->id;
     auto queryId = stopPipelineTask.queryId;
-    stopPipelineTask.pipeline->stage->stop(pec);
+    {
+        const BufferOwnership::Scope bufferOwner({.queryId = queryId, .pipelineId = pipelineId});
+        stopPipelineTask.pipeline->stage->stop(pec);
+    }
     pool.statistic->onEvent(PipelineStop{WorkerThread::id, queryId, pipelineId});
     return true;
 }
@@ -748,14 +1098,72 @@ void ThreadPool::addThread(WorkerId workerId)
         [this, id = numberOfThreads_++](const std::stop_token& stopToken)
         {
             WorkerThread::id = WorkerThreadId(WorkerThreadId::INITIAL + id);
+            /// Pinning the thread before it requests its first buffer lets NUMA-aware buffer pools serve it from the node of its cpu
+            if (!workerThreadCpus.empty())
+            {
+                const auto cpu = workerThreadCpus[static_cast<size_t>(id) % workerThreadCpus.size()];
+                if (!Thread::pinThisThread({cpu}))
+                {
+                    ENGINE_LOG_WARNING("Could not pin WorkerThread {} to cpu {}", id, cpu);
+                }
+            }
+            INVARIANT(static_cast<size_t>(id) < workerThreadCounters.size(), "WorkerThread {} has no counters", id);
+            auto& busyTimeInNs = workerThreadCounters[static_cast<size_t>(id)].busyTimeInNs;
             const WorkerThread worker{*this, false};
-            while (!stopToken.stop_requested())
+            size_t numberOfHandledTasks = 0;
+            std::vector<Task> tasks;
+            tasks.reserve(taskBatchSize);
+            std::vector<Task> emittedTasks;
+            if (taskBatchSize > 1)
+            {
+                emittedTasks.reserve(taskBatchSize);
+                WorkerThread::emittedTasks = &emittedTasks;
+            }
+            /// The perf events count the thread that opens them, thus every WorkerThread opens its own
+            std::optional<HardwareCounters> hardwareCounters;
+            if (countHardwareEvents)
+            {
+                hardwareCounters = HardwareCounters::openForThisThread();
+                WorkerThread::hardwareCounters = hardwareCounters ? std::addressof(*hardwareCounters) : nullptr;
+            }
+            while (auto activation = workerThreadActivation.awaitActivation(static_cast<size_t>(id), stopToken))
             {
-                if (auto task = taskQueue.getNextTaskBlocking(stopToken))
+                /// The activation ends once the WorkerThread is retired or the ThreadPool stops
+                const std::stop_callback stopWithThreadPool(stopToken, [&activation] { activation->request_stop(); });
+                const auto activationToken = activation->get_token();
+                while (!activationToken.stop_requested())
+                {
+                    if (taskQueue.getNextTasksBlocking(static_cast<size_t>(id), activationToken, taskBatchSize, tasks) == 0)
+                    {
+                        continue;
+                    }
+                    const auto batchStart = std::chrono::steady_clock::now();
+                    for (auto& task : tasks)
+                    {
+                        handleTask(worker, std::move(task));
+                        submitEmittedTasks();
+                    }
+                    const auto batchDuration = std::chrono::steady_clock::now() - batchStart;
+                    /// As the only writer, the thread does not need an atomic read-modify-write
+                    busyTimeInNs.store(
+                        busyTimeInNs.load(std::memory_order::relaxed) + std::chrono::nanoseconds(batchDuration).count(),
+                        std::memory_order::relaxed);
+                    const auto previouslyHandledTasks = std::exchange(numberOfHandledTasks, numberOfHandledTasks + tasks.size());
+                    if (previouslyHandledTasks / BUFFER_CACHE_STATISTIC_INTERVAL != numberOfHandledTasks / BUFFER_CACHE_STATISTIC_INTERVAL)
+                    {
+                        emitBufferCacheStatistic();
+                    }
+                    tasks.clear();
+                }
+                /// Only the owner pushes into its local queue, thus no task is left behind once the retired WorkerThread drained it
+                while (auto task = taskQueue.getNextLocalTaskNonBlocking(static_cast<size_t>(id)))
                 {
                     handleTask(worker, std::move(*task));
+                    submitEmittedTasks();
                 }
             }
+            WorkerThread::emittedTasks = nullptr;
+            emitBufferCacheStatistic();
 
             ENGINE_LOG_INFO("WorkerThread {} shutting down", id);
             /// Worker in termination mode will not emit further work and eventually clear the task queue and terminate.
@@ -767,6 +1175,59 @@ void ThreadPool::addThread(WorkerId workerId)
         });
 }
 
+std::chrono::nanoseconds ThreadPool::getTotalBusyTime() const
+{
+    std::chrono::nanoseconds totalBusyTime{0};
+    for (const auto& counters : workerThreadCounters)
+    {
+        totalBusyTime += std::chrono::nanoseconds(counters.busyTimeInNs.load(std::memory_order::relaxed));
+    }
+    return totalBusyTime;
+}
+
+void ThreadPool::scaleWorkerThreads(const std::stop_token& stopToken)
+{
+    auto windowStart = std::chrono::steady_clock::now();
+    auto busyTimeAtWindowStart = getTotalBusyTime();
+    const auto restartWindow = [&]
+    {
+        windowStart = std::chrono::steady_clock::now();
+        busyTimeAtWindowStart = getTotalBusyTime();
+    };
+
+    while (!stopToken.stop_requested())
+    {
+        std::this_thread::sleep_for(WORKER_SCALING_INTERVAL);
+        /// The periods of the cpu quota start at the granularity of the scaling interval
+        cpuAccounting.startNextPeriodIfElapsed();
+        const auto active = workerThreadActivation.getNumberOfActiveWorkerThreads();
+        const auto admissionTasks = taskQueue.getNumberOfAdmissionTasks();
+        const auto queuedTasks = taskQueue.getNumberOfInternalTasks() + admissionTasks;
+        if (queuedTasks > active || 2 * admissionTasks >= taskQueue.getAdmissionCapacity())
+        {
+            if (workerThreadActivation.activateOne())
+            {
+                ENGINE_LOG_DEBUG("Activated WorkerThread {} for {} queued tasks", active, queuedTasks);
+                restartWindow();
+            }
+            continue;
+        }
+
+        const auto window = std::chrono::steady_clock::now() - windowStart;
+        if (window < WORKER_RETIREMENT_WINDOW)
+        {
+            continue;
+        }
+        const auto busyTime = getTotalBusyTime() - busyTimeAtWindowStart;
+        const auto fitsIntoOneWorkerThreadLess = 2 * busyTime < static_cast<int64_t>(active - 1) * window;
+        if (queuedTasks == 0 && active > 1 && fitsIntoOneWorkerThreadLess && workerThreadActivation.retireOne())
+        {
+            ENGINE_LOG_DEBUG("Retired WorkerThread {}", active - 1);
+        }
+        restartWindow();
+    }
+}
+
 QueryEngine::QueryEngine(
     const QueryEngineConfiguration& config,
     std::shared_ptr<QueryEngineStatisticListener> statListener,
@@ -777,7 +1238,22 @@ QueryEngine::QueryEngine(
     , statusListener(std::move(listener))
     , statisticListener(std::move(statListener))
     , queryCatalog(std::make_shared<QueryCatalog>())
-    , threadPool(std::make_unique<ThreadPool>(statusListener, statisticListener, bufferManager, config.admissionQueueSize.getValue()))
+    , threadPool(std::make_unique<ThreadPool>(
+          statusListener,
+          statisticListener,
+          bufferManager,
+          config.admissionQueueSize.getValue(),
+          config.numberOfWorkerThreads.getValue(),
+          config.taskSchedulingMode.getValue(),
+          config.workerIdleStrategy.getValue(),
+          config.taskBatchSize.getValue(),
+          parseIdList(config.workerThreadCpus.getValue()).value_or(std::vector<size_t>{}),
+          getWorkerThreadLimits(config),
+          std::chrono::milliseconds(config.loadSheddingQueueWaitThresholdInMs.getValue()),
+          config.loadSheddingPolicy.getValue(),
+          config.hardwareCounters.getValue(),
+          config.queryCpuQuotaInPercent.getValue(),
+          std::chrono::milliseconds(config.queryCpuQuotaPeriodInMs.getValue())))
     , workerId(workerId)
 {
     for (size_t i = 0; i < config.numberOfWorkerThreads.getValue(); ++i)
@@ -800,6 +1276,16 @@ void QueryEngine::start(std::unique_ptr<ExecutableQueryPlan> executableQueryPlan
         {}, StartQueryTask{executableQueryPlan->queryId, std::move(executableQueryPlan), queryCatalog, TaskCallback{}});
 }
 
+void QueryEngine::setWorkerThreadLimits(const size_t minimum, const size_t maximum)
+{
+    threadPool->workerThreadActivation.setLimits({.minimum = minimum, .maximum = maximum});
+}
+
+QueryEngineStatistics QueryEngine::getStatistics() const
+{
+    return threadPool->getStatistics();
+}
+
 QueryEngine::~QueryEngine()
 {
     ThreadPool::WorkerThread::id = ThreadPool::terminatorThreadId;
@@ -814,8 +1300,6 @@ void QueryCatalog::start(
     QueryLifetimeController& controller,
     WorkEmitter& emitter)
 {
-    const std::scoped_lock lock(mutex);
-
     struct RealQueryLifeTimeListener : QueryLifetimeListener
     {
         RealQueryLifeTimeListener(
@@ -938,7 +1422,7 @@ void QueryCatalog::start(
     auto queryListener = std::make_shared<RealQueryLifeTimeListener>(queryId, listener, statistic);
     const auto startTimestamp = std::chrono::system_clock::now();
     auto state = std::make_shared<StateRef>(Reserved{});
-    this->queryStates.emplace(queryId, state);
+    queryStates.wlock()->emplace(queryId, state);
     queryListener->state = state;
 
     auto [runningQueryPlan, callback] = RunningQueryPlan::start(queryId, std::move(plan), controller, emitter, queryListener);
@@ -950,46 +1434,55 @@ void QueryCatalog::start(
     }
     else
     {
-        /// The move did not happen.
+        /// The move did not happen, because the query failed or was stopped while it was reserved.
         INVARIANT(
             state->is<Terminated>(),
             "Bug: There is no other option for the state. The only transition from reserved to Starting happens here. Starting will "
             "not transition into running until the callback is dropped.");
         RunningQueryPlan::dispose(std::move(runningQueryPlan));
+
+        bool stoppedWhileReserved = false;
+        state->transition(
+            [&stoppedWhileReserved](Terminated&& terminated)
+            {
+                stoppedWhileReserved = terminated.reason == Terminated::Stopped;
+                return terminated;
+            });
+        if (stoppedWhileReserved)
+        {
+            listener->logQueryStatusChange(queryId, QueryState::Stopped, std::chrono::system_clock::now());
+            statistic->onEvent(QueryStop(ThreadPool::WorkerThread::id, queryId));
+        }
     }
 }
 
 void QueryCatalog::stopQuery(QueryId id)
 {
-    const std::unique_ptr<RunningQueryPlan> toBeDeleted;
+    const auto state = find(id);
+    if (!state)
     {
-        const std::scoped_lock lock(mutex);
-        if (auto it = queryStates.find(id); it != queryStates.end())
+        ENGINE_LOG_WARNING("Attempting to stop query {} failed. Query was not submitted to the engine.", id);
+        return;
+    }
+
+    absl::AnyInvocable<void()> cleanup;
+    state->transition(
+        [](Reserved&&) { return Terminated{Terminated::Stopped}; },
+        [&cleanup](Starting&& starting) /// NOLINT(cppcoreguidelines-rvalue-reference-param-not-moved)
         {
-            auto& state = *it->second;
-            absl::AnyInvocable<void()> cleanup;
-            bool didTransition = state.transition(
-                [&cleanup](Starting&& starting) /// NOLINT(cppcoreguidelines-rvalue-reference-param-not-moved)
-                {
-                    auto [stoppingQueryPlan, cb] = RunningQueryPlan::stop(std::move(starting.plan));
-                    cleanup = std::move(cb);
-                    return Stopping{std::move(stoppingQueryPlan)};
-                },
-                [&cleanup](Running&& running) /// NOLINT(cppcoreguidelines-rvalue-reference-param-not-moved)
-                {
-                    auto [stoppingQueryPlan, cb] = RunningQueryPlan::stop(std::move(running.plan));
-                    cleanup = std::move(cb);
-                    return Stopping{std::move(stoppingQueryPlan)};
-                });
-            if (didTransition)
-            {
-                cleanup();
-            }
-        }
-        else
+            auto [stoppingQueryPlan, cb] = RunningQueryPlan::stop(std::move(starting.plan));
+            cleanup = std::move(cb);
+            return Stopping{std::move(stoppingQueryPlan)};
+        },
+        [&cleanup](Running&& running) /// NOLINT(cppcoreguidelines-rvalue-reference-param-not-moved)
         {
-            ENGINE_LOG_WARNING("Attempting to stop query {} failed. Query was not submitted to the engine.", id);
-        }
+            auto [stoppingQueryPlan, cb] = RunningQueryPlan::stop(std::move(running.plan));
+            cleanup = std::move(cb);
+            return Stopping{std::move(stoppingQueryPlan)};
+        });
+    if (cleanup)
+    {
+        cleanup();
     }
 }
 }
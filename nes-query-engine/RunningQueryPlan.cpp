@@ -25,15 +25,18 @@
 #include <utility>
 #include <vector>
 #include <Identifiers/Identifiers.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
 #include <Sources/SourceHandle.hpp>
 #include <Sources/SourceReturnType.hpp>
 #include <absl/functional/any_invocable.h>
+#include <BackpressureChannel.hpp>
 #include <CompiledQueryPlan.hpp>
 #include <EngineLogger.hpp>
 #include <ErrorHandling.hpp>
 #include <ExecutablePipelineStage.hpp>
 #include <ExecutableQueryPlan.hpp>
 #include <Interfaces.hpp>
+#include <QueryCpuAccounting.hpp>
 #include <RunningSource.hpp>
 
 namespace NES
@@ -88,10 +91,21 @@ std::shared_ptr<RunningQueryPlanNode> RunningQueryPlanNode::create(
     std::unique_ptr<ExecutablePipelineStage> stage,
     std::function<void(Exception)> unregisterWithError,
     CallbackRef planRef,
-    CallbackRef setupCallback)
+    CallbackRef setupCallback,
+    std::shared_ptr<AbstractBufferProvider> bufferProvider,
+    const QueryPriority priority,
+    std::shared_ptr<QueryCpuAccount> cpuAccount)
 {
     auto node = std::shared_ptr<RunningQueryPlanNode>(
-        new RunningQueryPlanNode(pipelineId, std::move(successors), std::move(stage), std::move(unregisterWithError), std::move(planRef)),
+        new RunningQueryPlanNode(
+            pipelineId,
+            std::move(successors),
+            std::move(stage),
+            std::move(unregisterWithError),
+            std::move(planRef),
+            std::move(bufferProvider),
+            priority,
+            std::move(cpuAccount)),
         RunningQueryPlanNodeDeleter{.emitter = emitter, .queryId = queryId});
     emitter.emitPipelineStart(
         queryId,
@@ -131,6 +145,7 @@ std::
     std::vector<std::pair<std::unique_ptr<SourceHandle>, std::vector<std::shared_ptr<RunningQueryPlanNode>>>> sources;
     std::vector<std::weak_ptr<RunningQueryPlanNode>> pipelines;
     std::unordered_map<ExecutablePipeline*, std::shared_ptr<RunningQueryPlanNode>> cache;
+    const auto cpuAccount = emitter.registerCpuAccount(queryId);
     std::function<std::shared_ptr<RunningQueryPlanNode>(ExecutablePipeline*)> getOrCreate = [&](ExecutablePipeline* pipeline)
     {
         INVARIANT(pipeline, "Pipeline should not be nullptr");
@@ -151,7 +166,10 @@ std::
             std::move(pipeline->stage),
             unregisterWithError,
             terminationCallbackRef,
-            pipelineSetupCallbackRef);
+            pipelineSetupCallbackRef,
+            queryPlan.bufferProvider,
+            queryPlan.priority,
+            cpuAccount);
         pipelines.emplace_back(node);
         cache[pipeline] = std::move(node);
         return cache[pipeline];
@@ -170,6 +188,42 @@ std::
     return {std::move(sources), pipelines};
 }
 
+static void startSources(
+    QueryId queryId,
+    std::vector<std::pair<std::unique_ptr<SourceHandle>, std::vector<std::shared_ptr<RunningQueryPlanNode>>>>& sources,
+    std::unordered_map<OriginId, std::shared_ptr<RunningSource>>& runningSources,
+    const std::shared_ptr<QueryLifetimeListener>& listener,
+    QueryLifetimeController& controller,
+    WorkEmitter& emitter,
+    const std::shared_ptr<BackpressureController>& readinessGate)
+{
+    for (auto& [source, successors] : sources)
+    {
+        auto sourceId = source->getSourceId();
+        runningSources.emplace(
+            sourceId,
+            RunningSource::create(
+                queryId,
+                std::move(source),
+                std::move(successors),
+                [&emitter, queryId](std::vector<std::shared_ptr<RunningQueryPlanNode>>&& successors)
+                {
+                    /// On source unregistration all successor pipelines are soft stopped.
+                    ENGINE_LOG_INFO("Source unregistered, emitting pending pipeline stops");
+                    for (auto& successor : successors)
+                    {
+                        emitter.emitPendingPipelineStop(queryId, std::move(successor), TaskCallback{});
+                    }
+                    return true;
+                },
+                [listener](const Exception& exception) { listener->onFailure(exception); },
+                controller,
+                emitter,
+                readinessGate));
+    }
+    sources.clear();
+}
+
 std::pair<std::unique_ptr<RunningQueryPlan>, CallbackRef> RunningQueryPlan::start(
     QueryId queryId,
     std::unique_ptr<ExecutableQueryPlan> plan,
@@ -209,6 +263,15 @@ std::pair<std::unique_ptr<RunningQueryPlan>, CallbackRef> RunningQueryPlan::star
         emitter);
     internal.pipelines = std::move(pipelines);
 
+    /// If the readiness gate holds back the sources, they open concurrently with the pipeline setup. Thus, the time until the query
+    /// runs is bounded by the slowest pipeline setup or source open, instead of their sum.
+    auto readinessGate = internal.qep->readinessGate;
+    if (readinessGate)
+    {
+        ENGINE_LOG_DEBUG("Opening the sources of query {} while its pipelines start", queryId);
+        startSources(queryId, sources, internal.sources, listener, controller, emitter, readinessGate);
+    }
+
     /// The QueryEngine uses the setup callback to start the sources once all pipelines have been set up, effectively starting the query.
     /// The setup callback tracks the lifetimes of all pipeline setup tasks. Either a task will fail and terminate the query, which will cancel the setup callback.
     /// Or the setup task completes and destroys the callback reference.
@@ -222,6 +285,7 @@ std::pair<std::unique_ptr<RunningQueryPlan>, CallbackRef> RunningQueryPlan::star
                 listener = std::move(listener),
                 &controller,
                 &emitter,
+                readinessGate = std::move(readinessGate),
                 sources = std::move(sources)]() mutable
         {
             {
@@ -229,28 +293,13 @@ std::pair<std::unique_ptr<RunningQueryPlan>, CallbackRef> RunningQueryPlan::star
                 auto& internal = *lock;
 
                 ENGINE_LOG_DEBUG("Pipeline Setup Completed");
-                for (auto& [source, successors] : sources)
+                if (readinessGate)
+                {
+                    readinessGate->releasePressure();
+                }
+                else
                 {
-                    auto sourceId = source->getSourceId();
-                    internal.sources.emplace(
-                        sourceId,
-                        RunningSource::create(
-                            queryId,
-                            std::move(source),
-                            std::move(successors),
-                            [&emitter, queryId](std::vector<std::shared_ptr<RunningQueryPlanNode>>&& successors)
-                            {
-                                /// On source unregistration all successor pipelines are soft stopped.
-                                ENGINE_LOG_INFO("Source unregistered, emitting pending pipeline stops");
-                                for (auto& successor : successors)
-                                {
-                                    emitter.emitPendingPipelineStop(queryId, std::move(successor), TaskCallback{});
-                                }
-                                return true;
-                            },
-                            [listener](const Exception& exception) { listener->onFailure(exception); },
-                            controller,
-                            emitter));
+                    startSources(queryId, sources, internal.sources, listener, controller, emitter, nullptr);
                 }
                 /// release lock
             }
@@ -20,12 +20,15 @@
 #include <utility>
 #include <vector>
 #include <Identifiers/Identifiers.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
 #include <folly/Synchronized.h>
 #include <Callback.hpp>
+#include <CompiledQueryPlan.hpp>
 #include <ErrorHandling.hpp>
 #include <ExecutablePipelineStage.hpp>
 #include <ExecutableQueryPlan.hpp>
 #include <Interfaces.hpp>
+#include <QueryCpuAccounting.hpp>
 #include <RunningSource.hpp>
 
 namespace NES
@@ -60,7 +63,10 @@ struct RunningQueryPlanNode
         std::unique_ptr<ExecutablePipelineStage> stage,
         std::function<void(Exception)> unregisterWithError,
         CallbackRef planRef,
-        CallbackRef setupCallback);
+        CallbackRef setupCallback,
+        std::shared_ptr<AbstractBufferProvider> bufferProvider = nullptr,
+        QueryPriority priority = QueryPriority::Normal,
+        std::shared_ptr<QueryCpuAccount> cpuAccount = nullptr);
 
 
     ~RunningQueryPlanNode();
@@ -70,12 +76,18 @@ struct RunningQueryPlanNode
         std::vector<std::shared_ptr<RunningQueryPlanNode>> successors,
         std::unique_ptr<ExecutablePipelineStage> stage,
         std::function<void(Exception)> unregisterWithError,
-        CallbackRef planRef)
+        CallbackRef planRef,
+        std::shared_ptr<AbstractBufferProvider> bufferProvider,
+        const QueryPriority priority,
+        std::shared_ptr<QueryCpuAccount> cpuAccount)
         : id(id)
         , successors(std::move(successors))
         , stage(std::move(stage))
         , unregisterWithError(std::move(unregisterWithError))
         , planRef(std::move(planRef))
+        , bufferProvider(std::move(bufferProvider))
+        , priority(priority)
+        , cpuAccount(std::move(cpuAccount))
     {
     }
 
@@ -85,11 +97,20 @@ struct RunningQueryPlanNode
 
     std::atomic_bool requiresTermination = false;
     std::atomic<ssize_t> pendingTasks = 0;
+    /// Number of tasks that were ever submitted to the pipeline, which operators compare to the inputs that they completed
+    std::atomic<uint64_t> submittedTasks = 0;
     std::vector<std::shared_ptr<RunningQueryPlanNode>> successors;
     std::unique_ptr<ExecutablePipelineStage> stage;
 
     std::function<void(Exception)> unregisterWithError;
     CallbackRef planRef;
+
+    /// Provides the buffers of the tasks of this pipeline instead of the global BufferManager, if set (see ExecutableQueryPlan).
+    std::shared_ptr<AbstractBufferProvider> bufferProvider;
+    /// Determines the share of the admission queue that the tasks of this pipeline get (see ExecutableQueryPlan).
+    QueryPriority priority;
+    /// Accounts the cpu time of the tasks of this pipeline to its query, if set
+    std::shared_ptr<QueryCpuAccount> cpuAccount;
 };
 
 struct QueryLifetimeListener
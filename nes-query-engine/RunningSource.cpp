@@ -16,12 +16,12 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
-#include <limits>
 #include <memory>
 #include <mutex>
-#include <semaphore>
+#include <span>
 #include <stop_token>
 #include <utility>
 #include <variant>
@@ -29,8 +29,10 @@
 #include <Identifiers/Identifiers.hpp>
 #include <Sources/SourceReturnType.hpp>
 #include <Util/Overloaded.hpp>
+#include <BackpressureChannel.hpp>
 #include <EngineLogger.hpp>
 #include <ErrorHandling.hpp>
+#include <InflightBufferLimiter.hpp>
 #include <Interfaces.hpp>
 #include <PipelineExecutionContext.hpp>
 #include <RunningQueryPlan.hpp>
@@ -42,15 +44,21 @@ namespace
 {
 SourceReturnType::EmitFunction emitFunction(
     QueryId queryId,
-    size_t numberOfInflightBuffers,
+    std::shared_ptr<InflightBufferLimiter> limiter,
     std::weak_ptr<RunningSource> source,
     std::vector<std::shared_ptr<RunningQueryPlanNode>> successors,
     QueryLifetimeController& controller,
-    WorkEmitter& emitter)
+    WorkEmitter& emitter,
+    std::shared_ptr<BackpressureController> readinessGate)
 {
-    auto availableBuffer = std::make_shared<std::counting_semaphore<>>(
-        std::min(numberOfInflightBuffers, static_cast<size_t>(std::numeric_limits<int32_t>::max())));
-    return [&controller, successors = std::move(successors), source, &emitter, queryId, availableBuffer = std::move(availableBuffer)](
+    /// The SourceThread owns the emit function, thus the readiness gate outlives the wait of the SourceThread on it
+    return [&controller,
+            successors = std::move(successors),
+            source,
+            &emitter,
+            queryId,
+            limiter = std::move(limiter),
+            readinessGate = std::move(readinessGate)](
                const OriginId sourceId,
                SourceReturnType::SourceReturnType event,
                const std::stop_token& stopToken) -> SourceReturnType::EmitResult
@@ -59,31 +67,54 @@ SourceReturnType::EmitFunction emitFunction(
             Overloaded{
                 [&](const SourceReturnType::Data& data)
                 {
-                    for (const auto& successor : successors)
+                    /// The turnaround of a buffer, i.e., the time from emitting to releasing it, drives the adaptive inflight buffer limit
+                    const auto emittedAt = std::chrono::steady_clock::now();
+                    const auto createCallback = [&]
                     {
+                        return TaskCallback{TaskCallback::OnComplete(
+                            [limiter, emittedAt] { limiter->release(std::chrono::steady_clock::now() - emittedAt); })};
+                    };
+                    const std::span<const std::shared_ptr<RunningQueryPlanNode>> targets(successors);
+                    /// An overloaded QueryEngine drops the buffer before it waits for an inflight buffer or the admission queue
+                    if (emitter.shedWork(queryId, sourceId, targets, data.buffer))
+                    {
+                        return SourceReturnType::EmitResult::SUCCESS;
+                    }
+                    size_t emitted = 0;
+                    while (emitted < targets.size())
+                    {
+                        /// The limiter stops waiting in case the source wants to terminate
+                        if (not limiter->acquire(stopToken))
                         {
-                            /// release the semaphore in case the source wants to terminate
-                            const std::stop_callback callback(stopToken, [&]() { availableBuffer->release(); });
-                            availableBuffer->acquire();
-                            if (stopToken.stop_requested())
-                            {
-                                return SourceReturnType::EmitResult::STOP_REQUESTED;
-                            }
+                            return SourceReturnType::EmitResult::STOP_REQUESTED;
+                        }
+                        if (stopToken.stop_requested())
+                        {
+                            limiter->release(std::chrono::nanoseconds(0));
+                            return SourceReturnType::EmitResult::STOP_REQUESTED;
+                        }
+                        /// The buffer is emitted to as many successors at once as there are inflight buffers available
+                        size_t batchSize = 1;
+                        while (emitted + batchSize < targets.size() && limiter->tryAcquire())
+                        {
+                            ++batchSize;
                         }
                         /// The admission queue might be full, we have to reattempt
-                        while (not emitter.emitWork(
-                            queryId,
-                            successor,
-                            data.buffer,
-                            TaskCallback{TaskCallback::OnComplete([availableBuffer] { availableBuffer->release(); })},
-                            PipelineExecutionContext::ContinuationPolicy::NEVER))
+                        const auto batchEnd = emitted + batchSize;
+                        while (emitted < batchEnd)
                         {
-                            if (stopToken.stop_requested())
+                            emitted += emitter.emitWorkBatch(
+                                queryId,
+                                targets.subspan(emitted, batchEnd - emitted),
+                                data.buffer,
+                                createCallback,
+                                PipelineExecutionContext::ContinuationPolicy::NEVER);
+                            if (emitted < batchEnd && stopToken.stop_requested())
                             {
                                 return SourceReturnType::EmitResult::STOP_REQUESTED;
                             }
                         }
-                        ENGINE_LOG_DEBUG("Source Emitted Data to successor: {}-{}", queryId, successor->id);
+                        ENGINE_LOG_DEBUG("Source Emitted Data to {} successors of query {}", batchSize, queryId);
                     }
                     return SourceReturnType::EmitResult::SUCCESS;
                 },
@@ -127,15 +158,20 @@ std::shared_ptr<RunningSource> RunningSource::create(
     std::function<bool(std::vector<std::shared_ptr<RunningQueryPlanNode>>&&)> onSourceStopped,
     std::function<void(Exception)> onSourceFailure,
     QueryLifetimeController& controller,
-    WorkEmitter& emitter)
+    WorkEmitter& emitter,
+    std::shared_ptr<BackpressureController> readinessGate)
 {
-    const auto maxInflightBuffers = source->getRuntimeConfiguration().inflightBufferLimit;
+    const auto& runtimeConfiguration = source->getRuntimeConfiguration();
+    auto limiter = std::make_shared<InflightBufferLimiter>(
+        runtimeConfiguration.inflightBufferLimit, runtimeConfiguration.adaptiveInflightBufferLimit);
+    emitter.registerInflightBufferLimiter(queryId, source->getSourceId(), limiter);
     auto runningSource = std::shared_ptr<RunningSource>(
         new RunningSource(successors, std::move(source), std::move(onSourceStopped), std::move(onSourceFailure)));
     ENGINE_LOG_DEBUG("Starting Running Source");
     {
         const std::scoped_lock lock(runningSource->mutex);
-        runningSource->source->start(emitFunction(queryId, maxInflightBuffers, runningSource, std::move(successors), controller, emitter));
+        runningSource->source->start(emitFunction(
+            queryId, std::move(limiter), runningSource, std::move(successors), controller, emitter, std::move(readinessGate)));
     }
     return runningSource;
 }
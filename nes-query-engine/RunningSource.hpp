@@ -19,6 +19,7 @@
 #include <vector>
 #include <Identifiers/Identifiers.hpp>
 #include <Sources/SourceHandle.hpp>
+#include <BackpressureChannel.hpp>
 #include <ErrorHandling.hpp>
 #include <Interfaces.hpp>
 
@@ -40,6 +41,7 @@ public:
     /// Creates and starts the underlying source implementation. As long as the RunningSource is kept alive the source will run,
     /// once the last reference to the RunningSource is destroyed the source is stopped.
     /// The onSourceStopped callback is invoked after the source has been successfully stopped.
+    /// The readiness gate, which may hold back the source, is kept alive until the SourceThread has terminated.
     static std::shared_ptr<RunningSource> create(
         QueryId queryId,
         std::unique_ptr<SourceHandle> source,
@@ -47,7 +49,8 @@ public:
         std::function<bool(std::vector<std::shared_ptr<RunningQueryPlanNode>>&&)> onSourceStopped,
         std::function<void(Exception)> onSourceFailure,
         QueryLifetimeController& controller,
-        WorkEmitter& emitter);
+        WorkEmitter& emitter,
+        std::shared_ptr<BackpressureController> readinessGate = nullptr);
 
     RunningSource(const RunningSource& other) = delete;
     RunningSource& operator=(const RunningSource& other) = delete;
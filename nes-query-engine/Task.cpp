@@ -14,6 +14,7 @@
 
 #include <Task.hpp>
 
+#include <chrono>
 #include <cstddef>
 #include <memory>
 #include <tuple>
@@ -115,7 +116,11 @@ void BaseTask::fail(Exception exception)
 
 WorkTask::WorkTask(
     QueryId queryId, PipelineId pipelineId, std::weak_ptr<RunningQueryPlanNode> pipeline, TupleBuffer buf, TaskCallback callback)
-    : BaseTask(queryId, std::move(callback)), pipeline(std::move(pipeline)), pipelineId(pipelineId), buf(std::move(buf))
+    : BaseTask(queryId, std::move(callback))
+    , pipeline(std::move(pipeline))
+    , pipelineId(pipelineId)
+    , buf(std::move(buf))
+    , submissionTimestamp(std::chrono::system_clock::now())
 {
 }
 
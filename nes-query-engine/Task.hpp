@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstddef>
 #include <memory>
 #include <tuple>
@@ -132,6 +133,8 @@ struct WorkTask : BaseTask
     std::weak_ptr<RunningQueryPlanNode> pipeline;
     PipelineId pipelineId = INVALID<PipelineId>;
     TupleBuffer buf;
+    /// Allows to observe for how long the task waited in the queues before a worker thread executed it
+    std::chrono::system_clock::time_point submissionTimestamp;
 };
 
 struct StartPipelineTask : BaseTask
@@ -14,14 +14,25 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <deque>
+#include <mutex>
+#include <new>
 #include <optional>
 #include <semaphore>
+#include <span>
 #include <stop_token>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
-#include <folly/MPMCQueue.h>
+#include <vector>
 #include <folly/concurrency/UnboundedQueue.h>
+#include <folly/portability/Asm.h>
 
 namespace NES
 {
@@ -29,20 +40,162 @@ namespace NES
 /// The TaskQueue is a central component within the QueryEngine. External components like sources or users of the system can add new tasks
 /// to an admission queue which is bounded and will backpressure sources if necessary. Internally, WorkerThreads communicate via a shared
 /// internal queue, which is unbounded to deal with occasionally bursty loads like a large join. Access to the internal task queue is always
-/// non-blocking. The TaskQueue exposes a blocking `getNextTaskBlocking` method which reads from either queue without spinning and is
-/// supposed to be used by the worker threads.
+/// non-blocking. The TaskQueue exposes a blocking `getNextTaskBlocking` method which reads from either queue without spinning (unless the
+/// TaskQueue spins while idle) and is supposed to be used by the worker threads. Batched variants of the reads and writes announce many
+/// tasks with a single release of the semaphore.
+///
+/// Optionally, the TaskQueue can be created with one local queue per WorkerThread (work-stealing mode). Follow-up tasks emitted by a
+/// WorkerThread are pushed into its local queue, which the owner consumes in LIFO order, while idle WorkerThreads steal the oldest tasks
+/// from their peers. Local queues bypass the shared internal queue and the semaphore, which removes them from the hot path of the
+/// WorkerThreads. Local queues are not visible to the semaphore, thus a WorkerThread only pushes into its local queue if no other
+/// WorkerThread is currently blocked waiting for work; otherwise the task is published via the shared internal queue.
+/// The admission queue is unaffected by local queues and keeps backpressuring sources.
+///
+/// The admission queue consists of one bounded FIFO per admission class, e.g., per query. WorkerThreads take the tasks of the admission
+/// classes via deficit round-robin: once an admission class gets its turn, it admits up to its weight many tasks, before the next
+/// admission class gets its turn. Thus, an admission class that floods the admission queue solely blocks its own writers on its bound
+/// and delays the tasks of every other admission class by at most its weight per round. A throttled admission class passes its turns
+/// to the admission classes that are not throttled, unless solely throttled admission classes have tasks.
 template <typename TaskType>
 class TaskQueue
 {
+public:
+    /// The sub-queue of the admission queue that a task gets written to, and the share of the admission queue that the sub-queue gets
+    struct AdmissionClass
+    {
+        size_t key = 0;
+        size_t weight = 1;
+    };
+
+private:
+    /// Each local queue lives on its own cache line to avoid false sharing between WorkerThreads.
+    struct alignas(std::hardware_destructive_interference_size) LocalQueue
+    {
+        std::mutex mutex;
+        std::deque<TaskType> tasks;
+        /// Allows thieves to skip empty local queues without acquiring the lock.
+        std::atomic<size_t> size{0};
+    };
+
+    struct AdmissionSubQueue
+    {
+        std::deque<TaskType> tasks;
+        size_t weight = 1;
+        /// Number of tasks that the sub-queue may still admit in its current turn
+        size_t deficit = 0;
+    };
+
     folly::UMPMCQueue<TaskType, true> internal;
-    folly::MPMCQueue<TaskType> admission;
+    std::vector<LocalQueue> localQueues;
+
+    std::mutex admissionMutex;
+    /// Solely contains non-empty sub-queues, i.e., the weight of an admission class is set by every write
+    std::unordered_map<size_t, AdmissionSubQueue> admissionSubQueues;
+    /// Keys of the non-empty sub-queues in the order of their turns. The sub-queue at the front has the current turn.
+    std::deque<size_t> admissionTurns;
+    std::unordered_set<size_t> throttledAdmissionClasses;
+    /// Waits on the stop token of the writer as well, thus canceling a blocked write does not wait for a timeout
+    std::condition_variable_any admissionSpaceAvailable;
+    size_t admissionCapacityPerClass;
+    std::atomic<size_t> numberOfAdmissionTasks{0};
 
-    /// INVARIANT: internal.size() + admission.size() >= tasksAvailable
+    /// INVARIANT: internal.size() + numberOfAdmissionTasks >= tasksAvailable
     std::counting_semaphore<> tasksAvailable{0};
 
-    /// To provide cancellation, we only block for StopTokenCheckInterval.
-    /// This parameter could be tuned to allow for more timely cancellation
-    static constexpr std::chrono::milliseconds StopTokenCheckInterval{100};
+    /// Number of WorkerThreads which are currently blocked on the semaphore. WorkerThreads only push into their local queue if no peer
+    /// is waiting, as a waiting peer would not be notified about the new task. Likewise, batched reads stop early if a peer is waiting.
+    std::atomic<size_t> idleWorkers{0};
+
+    /// Idle WorkerThreads park on a condition variable instead of the semaphore, which the stop token of the WorkerThread wakes up once
+    /// it is triggered. Writers only notify the condition variable if any WorkerThread is parked, thus a busy TaskQueue never locks it.
+    std::mutex parkingMutex;
+    std::condition_variable_any tasksAnnounced;
+    std::atomic<size_t> parkedWorkers{0};
+
+    /// Tasks in local queues are not announced via the semaphore, thus parked WorkerThreads periodically retry to steal them
+    static constexpr std::chrono::milliseconds StealRetryInterval{100};
+
+    /// Bounds of the number of pause instructions that an idle WorkerThread spends on the semaphore before it yields and then parks
+    static constexpr size_t MinSpinIterations = 64;
+    static constexpr size_t MaxSpinIterations = 4096;
+    static constexpr size_t YieldIterations = 8;
+
+    bool spinWhileIdle = false;
+    /// Shared by all WorkerThreads, as they observe the same arrivals of tasks
+    std::atomic<size_t> spinBudget{MinSpinIterations};
+
+    /// Spins on the semaphore before a WorkerThread parks on it, which saves the futex wake-up if a task arrives shortly after.
+    /// The spin budget adapts to the inter-arrival time of the tasks: it doubles whenever a task arrives in the second half of the spin
+    /// and halves whenever the WorkerThread parks after spinning in vain. Returns true if the WorkerThread acquired a task.
+    bool spinForTask()
+    {
+        if (!spinWhileIdle)
+        {
+            return false;
+        }
+        const auto budget = spinBudget.load(std::memory_order::relaxed);
+        for (size_t spin = 0; spin < budget; ++spin)
+        {
+            if (tasksAvailable.try_acquire())
+            {
+                if (2 * spin > budget)
+                {
+                    spinBudget.store(std::min(2 * budget, MaxSpinIterations), std::memory_order::relaxed);
+                }
+                return true;
+            }
+            folly::asm_volatile_pause();
+        }
+        for (size_t yield = 0; yield < YieldIterations; ++yield)
+        {
+            std::this_thread::yield();
+            if (tasksAvailable.try_acquire())
+            {
+                return true;
+            }
+        }
+        spinBudget.store(std::max(budget / 2, MinSpinIterations), std::memory_order::relaxed);
+        return false;
+    }
+
+    /// Parks the WorkerThread until it acquires a task, the stop token is triggered or the optional timeout expires.
+    /// Returns true if the WorkerThread acquired a task.
+    bool parkForTask(const std::stop_token& stoken, const std::optional<std::chrono::milliseconds> timeout)
+    {
+        parkedWorkers.fetch_add(1, std::memory_order::relaxed);
+        /// Pairs with the fence in announceTasks: either the WorkerThread acquires the new task, or the writer notices the parked
+        /// WorkerThread and notifies it
+        std::atomic_thread_fence(std::memory_order::seq_cst);
+        std::unique_lock lock(parkingMutex);
+        const auto acquireTask = [this] { return tasksAvailable.try_acquire(); };
+        const auto acquired = timeout ? tasksAnnounced.wait_for(lock, stoken, *timeout, acquireTask)
+                                      : tasksAnnounced.wait(lock, stoken, acquireTask);
+        parkedWorkers.fetch_sub(1, std::memory_order::relaxed);
+        return acquired;
+    }
+
+    /// Releases the semaphore after the tasks have been written and wakes up parked WorkerThreads
+    void announceTasks(const std::ptrdiff_t numberOfTasks)
+    {
+        tasksAvailable.release(numberOfTasks);
+        std::atomic_thread_fence(std::memory_order::seq_cst);
+        if (parkedWorkers.load(std::memory_order::relaxed) == 0)
+        {
+            return;
+        }
+        /// A WorkerThread that checked the semaphore before the release is waiting on the condition variable once the lock is free
+        {
+            const std::scoped_lock lock(parkingMutex);
+        }
+        if (numberOfTasks == 1)
+        {
+            tasksAnnounced.notify_one();
+        }
+        else
+        {
+            tasksAnnounced.notify_all();
+        }
+    }
 
     TaskType readElementAssumingItExists()
     {
@@ -53,35 +206,214 @@ class TaskQueue
             return task;
         }
 
-        /// However, the MPMC `read` can spuriously fail under high contention, the alternative `readIfNotEmpty` does not but is
-        /// significantly slower.
-        while (!admission.read(task)) [[unlikely]]
+        return readAdmissionTask();
+    }
+
+    /// The semaphore guarantees that the admission queue contains at least one task, if the internal queue is empty
+    TaskType readAdmissionTask()
+    {
+        const std::scoped_lock lock(admissionMutex);
+        for (size_t turn = 1; turn < admissionTurns.size() && throttledAdmissionClasses.contains(admissionTurns.front()); ++turn)
+        {
+            /// The throttled admission class starts a new turn, once it gets the next one
+            admissionSubQueues.find(admissionTurns.front())->second.deficit = 0;
+            admissionTurns.push_back(admissionTurns.front());
+            admissionTurns.pop_front();
+        }
+        const auto key = admissionTurns.front();
+        const auto subQueue = admissionSubQueues.find(key);
+        auto& [tasks, weight, deficit] = subQueue->second;
+        if (deficit == 0)
+        {
+            deficit = weight;
+        }
+        TaskType task = std::move(tasks.front());
+        tasks.pop_front();
+        --deficit;
+        numberOfAdmissionTasks.fetch_sub(1, std::memory_order::relaxed);
+
+        if (tasks.size() + 1 == admissionCapacityPerClass)
+        {
+            admissionSpaceAvailable.notify_all();
+        }
+        if (tasks.empty())
+        {
+            admissionSubQueues.erase(subQueue);
+            admissionTurns.pop_front();
+        }
+        else if (deficit == 0)
+        {
+            admissionTurns.pop_front();
+            admissionTurns.push_back(key);
+        }
+        return task;
+    }
+
+    /// Waits until the sub-queue of the admission class has space for another task. Returns nullptr if the write was canceled.
+    AdmissionSubQueue*
+    awaitAdmissionSpace(std::unique_lock<std::mutex>& lock, const std::stop_token& stoken, const AdmissionClass admissionClass)
+    {
+        const auto hasSpace = [&]
+        {
+            const auto subQueue = admissionSubQueues.find(admissionClass.key);
+            return subQueue == admissionSubQueues.end() || subQueue->second.tasks.size() < admissionCapacityPerClass;
+        };
+        /// A canceled write fails, even if the sub-queue has space
+        if (!admissionSpaceAvailable.wait(lock, stoken, hasSpace) || stoken.stop_requested())
+        {
+            return nullptr;
+        }
+        auto subQueue = admissionSubQueues.find(admissionClass.key);
+        if (subQueue == admissionSubQueues.end())
+        {
+            subQueue = admissionSubQueues.try_emplace(admissionClass.key).first;
+            admissionTurns.push_back(admissionClass.key);
+        }
+        subQueue->second.weight = std::max<size_t>(admissionClass.weight, 1);
+        return &subQueue->second;
+    }
+
+    std::optional<TaskType> popLocal(size_t owner)
+    {
+        auto& local = localQueues[owner];
+        if (local.size.load(std::memory_order::relaxed) == 0)
         {
+            return std::nullopt;
         }
 
+        const std::scoped_lock lock(local.mutex);
+        if (local.tasks.empty())
+        {
+            return std::nullopt;
+        }
+        TaskType task = std::move(local.tasks.back());
+        local.tasks.pop_back();
+        local.size.store(local.tasks.size(), std::memory_order::relaxed);
         return task;
     }
 
+    /// Steals the oldest task of any other local queue, starting at the neighbour of the thief to spread the steal attempts.
+    std::optional<TaskType> steal(size_t thief)
+    {
+        for (size_t offset = 1; offset <= localQueues.size(); ++offset)
+        {
+            auto& victim = localQueues[(thief + offset) % localQueues.size()];
+            if (victim.size.load(std::memory_order::relaxed) == 0)
+            {
+                continue;
+            }
+
+            const std::scoped_lock lock(victim.mutex);
+            if (victim.tasks.empty())
+            {
+                continue;
+            }
+            TaskType task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            victim.size.store(victim.tasks.size(), std::memory_order::relaxed);
+            return task;
+        }
+        return std::nullopt;
+    }
+
 public:
-    explicit TaskQueue(size_t admissionTaskQueueSize) : admission(admissionTaskQueueSize) { }
+    /// The admission queue holds up to admissionTaskQueueSize tasks per admission class
+    explicit TaskQueue(size_t admissionTaskQueueSize) : admissionCapacityPerClass(std::max<size_t>(admissionTaskQueueSize, 1)) { }
 
-    /// By design the admission queue is bounded, which could lead to writes being blocked.
-    /// The stop token allows cancellation. In case the writing was canceled, this method returns false.
+    /// Creates a TaskQueue with one local queue per WorkerThread. Passing zero local queues disables work-stealing.
+    /// If spinWhileIdle is set, idle WorkerThreads spin (and yield) for a short, adaptive time before they park.
+    TaskQueue(size_t admissionTaskQueueSize, size_t numberOfLocalQueues, bool spinWhileIdle = false)
+        : localQueues(numberOfLocalQueues)
+        , admissionCapacityPerClass(std::max<size_t>(admissionTaskQueueSize, 1))
+        , spinWhileIdle(spinWhileIdle)
+    {
+    }
+
+    [[nodiscard]] bool hasLocalQueues() const { return !localQueues.empty(); }
+
+    /// Approximate number of tasks in the internal and the local queues, as WorkerThreads concurrently add and take tasks.
+    [[nodiscard]] size_t getNumberOfInternalTasks() const
+    {
+        size_t numberOfTasks = internal.size();
+        for (const auto& local : localQueues)
+        {
+            numberOfTasks += local.size.load(std::memory_order::relaxed);
+        }
+        return numberOfTasks;
+    }
+
+    /// Approximate number of tasks in the admission queue across all admission classes.
+    [[nodiscard]] size_t getNumberOfAdmissionTasks() const { return numberOfAdmissionTasks.load(std::memory_order::relaxed); }
+
+    /// Number of tasks that the admission queue holds per admission class, before it blocks the writers of the admission class
+    [[nodiscard]] size_t getAdmissionCapacity() const { return admissionCapacityPerClass; }
+
+    /// The admission tasks of a throttled admission class wait, while the admission tasks of other admission classes are available
+    void setAdmissionClassThrottled(const size_t key, const bool throttled)
+    {
+        const std::scoped_lock lock(admissionMutex);
+        if (throttled)
+        {
+            throttledAdmissionClasses.insert(key);
+        }
+        else
+        {
+            throttledAdmissionClasses.erase(key);
+        }
+    }
+
+    /// Writes the task to the default admission class, see `addAdmissionTaskBlocking(stoken, admissionClass, task)`.
     template <typename T = TaskType>
     bool addAdmissionTaskBlocking(const std::stop_token& stoken, T&& task)
     {
-        while (!stoken.stop_requested())
+        return addAdmissionTaskBlocking(stoken, AdmissionClass{}, std::forward<T>(task));
+    }
+
+    /// By design the admission queue is bounded per admission class, which could lead to writes being blocked.
+    /// The stop token allows cancellation. In case the writing was canceled, this method returns false.
+    template <typename T = TaskType>
+    bool addAdmissionTaskBlocking(const std::stop_token& stoken, const AdmissionClass admissionClass, T&& task)
+    {
+        std::unique_lock lock(admissionMutex);
+        auto* subQueue = awaitAdmissionSpace(lock, stoken, admissionClass);
+        if (subQueue == nullptr)
+        {
+            return false;
+        }
+        subQueue->tasks.emplace_back(std::forward<T>(task));
+        numberOfAdmissionTasks.fetch_add(1, std::memory_order::relaxed);
+        lock.unlock();
+        /// The order of operation upholds the invariant, i.e., tasksAvailable is only increased after the task has been written.
+        announceTasks(1);
+        return true;
+    }
+
+    /// Batched version of `addAdmissionTaskBlocking`, which moves the tasks into the admission class under a single lock and announces
+    /// them with a single release of the semaphore, as long as they fit into the admission class. Otherwise, it blocks until the
+    /// remaining tasks fit. Returns the number of written tasks, which is less than the number of tasks if the writing was canceled.
+    size_t addAdmissionTasksBlocking(const std::stop_token& stoken, const AdmissionClass admissionClass, std::span<TaskType> tasks)
+    {
+        size_t written = 0;
+        std::unique_lock lock(admissionMutex);
+        while (written < tasks.size())
         {
-            /// The order of operation upholds the invariant
-            /// NOLINTNEXTLINE(bugprone-use-after-move) no move happens if the write does not succeed. If a move happens, we return.
-            if (admission.tryWriteUntil(std::chrono::steady_clock::now() + StopTokenCheckInterval, std::forward<T>(task)))
+            auto* subQueue = awaitAdmissionSpace(lock, stoken, admissionClass);
+            if (subQueue == nullptr)
             {
-                /// tasksAvailable is only increased if write to admission queue was successful.
-                tasksAvailable.release();
-                return true;
+                break;
             }
+            const auto fitting = std::min(tasks.size() - written, admissionCapacityPerClass - subQueue->tasks.size());
+            for (auto& task : tasks.subspan(written, fitting))
+            {
+                subQueue->tasks.emplace_back(std::move(task));
+            }
+            numberOfAdmissionTasks.fetch_add(fitting, std::memory_order::relaxed);
+            written += fitting;
+            lock.unlock();
+            announceTasks(static_cast<std::ptrdiff_t>(fitting));
+            lock.lock();
         }
-        return false;
+        return written;
     }
 
     /// Write a Task to the internal task queue. The internal task queue is unbounded thus this operation will always succeed
@@ -90,35 +422,157 @@ public:
     {
         /// The order of operation upholds the invariant. internal is unbounded which makes this write always succeed (unless oom)
         internal.enqueue(std::forward<T>(task));
-        tasksAvailable.release();
+        announceTasks(1);
+    }
+
+    /// Batched version of `addInternalTaskNonBlocking`, which announces all tasks with a single release of the semaphore
+    void addInternalTasksNonBlocking(std::span<TaskType> tasks)
+    {
+        if (tasks.empty())
+        {
+            return;
+        }
+        for (auto& task : tasks)
+        {
+            internal.enqueue(std::move(task));
+        }
+        announceTasks(static_cast<std::ptrdiff_t>(tasks.size()));
+    }
+
+    /// Write a Task to the local queue of the WorkerThread `owner`. If work-stealing is disabled, or any WorkerThread is currently
+    /// waiting for work, the task is written to the internal task queue instead. This operation always succeeds.
+    template <typename T = TaskType>
+    void addLocalTaskNonBlocking(size_t owner, T&& task)
+    {
+        if (owner >= localQueues.size() || idleWorkers.load(std::memory_order::relaxed) > 0)
+        {
+            addInternalTaskNonBlocking(std::forward<T>(task));
+            return;
+        }
+
+        auto& local = localQueues[owner];
+        const std::scoped_lock lock(local.mutex);
+        local.tasks.emplace_back(std::forward<T>(task));
+        local.size.store(local.tasks.size(), std::memory_order::relaxed);
     }
 
     /// Blocking read to retrieve the next task from the internal queue, or the admission queue if the internal task queue is empty.
     /// This operation can be canceled using a stop token. In case of a cancellation, this method returns an empty optional.
     /// The method prioritizes reading over cancellation. This implies, if a read is non-blocking, it succeeds regardless of the state of
-    /// the stop token.
+    /// the stop token. A triggered stop token wakes up the blocked read immediately.
     std::optional<TaskType> getNextTaskBlocking(const std::stop_token& stoken)
     {
-        while (!tasksAvailable.try_acquire_for(StopTokenCheckInterval))
+        if (tasksAvailable.try_acquire())
         {
-            if (stoken.stop_requested())
+            return readElementAssumingItExists();
+        }
+
+        idleWorkers.fetch_add(1, std::memory_order::relaxed);
+        const bool acquired = spinForTask() || parkForTask(stoken, std::nullopt);
+        idleWorkers.fetch_sub(1, std::memory_order::relaxed);
+        if (!acquired)
+        {
+            return std::nullopt;
+        }
+        return readElementAssumingItExists();
+    }
+
+    /// Blocking read used by WorkerThreads in work-stealing mode. The WorkerThread `worker` prefers its own local queue (newest task
+    /// first), followed by the shared queues and finally the local queues of its peers (oldest task first). While waiting, the
+    /// WorkerThread periodically retries to steal, because tasks in local queues are not announced via the semaphore.
+    std::optional<TaskType> getNextTaskBlocking(size_t worker, const std::stop_token& stoken)
+    {
+        if (worker >= localQueues.size())
+        {
+            return getNextTaskBlocking(stoken);
+        }
+
+        if (auto task = popLocal(worker))
+        {
+            return task;
+        }
+
+        if (tasksAvailable.try_acquire())
+        {
+            return readElementAssumingItExists();
+        }
+
+        if (auto task = steal(worker))
+        {
+            return task;
+        }
+
+        /// A spinning WorkerThread counts as idle, thus its peers publish their follow-up tasks via the semaphore
+        idleWorkers.fetch_add(1, std::memory_order::relaxed);
+        std::optional<TaskType> result;
+        if (spinForTask())
+        {
+            result = readElementAssumingItExists();
+        }
+        while (!result)
+        {
+            if (parkForTask(stoken, StealRetryInterval))
+            {
+                result = readElementAssumingItExists();
+            }
+            else if (auto stolen = steal(worker))
+            {
+                result = std::move(stolen);
+            }
+            else if (stoken.stop_requested())
             {
-                return std::nullopt;
+                break;
             }
         }
+        idleWorkers.fetch_sub(1, std::memory_order::relaxed);
+        return result;
+    }
 
-        return readElementAssumingItExists();
+    /// Batched version of `getNextTaskBlocking(worker, stoken)`, which appends up to maxNumberOfTasks tasks to `tasks`. Only the read
+    /// of the first task blocks. The WorkerThread takes further tasks from the shared queues as long as they are available and none of
+    /// its peers waits for work, which would otherwise idle while the tasks wait in the batch. Returns the number of read tasks, which is
+    /// zero if the read was canceled.
+    size_t getNextTasksBlocking(size_t worker, const std::stop_token& stoken, const size_t maxNumberOfTasks, std::vector<TaskType>& tasks)
+    {
+        auto task = getNextTaskBlocking(worker, stoken);
+        if (!task)
+        {
+            return 0;
+        }
+        tasks.emplace_back(std::move(*task));
+        size_t numberOfTasks = 1;
+        while (numberOfTasks < maxNumberOfTasks && idleWorkers.load(std::memory_order::relaxed) == 0 && tasksAvailable.try_acquire())
+        {
+            tasks.emplace_back(readElementAssumingItExists());
+            ++numberOfTasks;
+        }
+        return numberOfTasks;
     }
 
     /// Non-Blocking version of `getNextTaskBlocking` if the queue is empty, this method returns an empty optional.
+    /// Tasks which remain in any of the local queues are returned as well, which allows terminating WorkerThreads to drain the queue.
     std::optional<TaskType> getNextTaskNonBlocking()
     {
         if (!tasksAvailable.try_acquire())
         {
+            if (!localQueues.empty())
+            {
+                return steal(localQueues.size() - 1);
+            }
             return std::nullopt;
         }
 
         return readElementAssumingItExists();
     }
+
+    /// Non-blocking read of the local queue of the WorkerThread `owner`, which allows a retiring WorkerThread to drain its local queue
+    std::optional<TaskType> getNextLocalTaskNonBlocking(size_t owner)
+    {
+        if (owner >= localQueues.size())
+        {
+            return std::nullopt;
+        }
+        return popLocal(owner);
+    }
 };
 }
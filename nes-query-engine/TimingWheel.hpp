@@ -0,0 +1,183 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace NES
+{
+
+/// A hierarchical timing wheel, which orders entries by the tick at which they expire. Each of the levels consists of 64 slots, a slot
+/// of level L covers 64^L ticks. An entry resides in the lowest level whose current rotation covers its expiry tick and cascades into the
+/// lower levels once the current tick reaches its slot. Thus, inserting an entry and expiring it take constant time, regardless of the
+/// number of entries. Entries beyond the highest level wait in an overflow list, until the highest level completes its rotation.
+/// The TimingWheel is not thread-safe.
+template <typename Entry>
+class TimingWheel
+{
+public:
+    using Tick = uint64_t;
+
+    explicit TimingWheel(const Tick currentTick) : currentTick(currentTick) { }
+
+    /// An entry that expires at or before the current tick is appended to `expired` right away
+    void insert(const Tick expiryTick, Entry entry, std::vector<Entry>& expired) { place(expiryTick, std::move(entry), expired); }
+
+    /// Advances the current tick to `tick` and appends all entries that expire until then to `expired`, ordered by their expiry tick.
+    /// Skips the ticks at which nothing expires or cascades.
+    void advance(const Tick tick, std::vector<Entry>& expired)
+    {
+        while (currentTick < tick)
+        {
+            const auto nextEventTick = getNextEventTick();
+            if (!nextEventTick || *nextEventTick > tick)
+            {
+                currentTick = tick;
+                return;
+            }
+            currentTick = *nextEventTick;
+            if (isAlignedTo(NumberOfLevels))
+            {
+                std::swap(overflow, scratch);
+                reinsertScratch(expired);
+            }
+            for (size_t level = NumberOfLevels - 1; level > 0; --level)
+            {
+                if (isAlignedTo(level))
+                {
+                    std::swap(levels[level][getSlot(currentTick, level)], scratch);
+                    occupied[level] &= ~(uint64_t{1} << getSlot(currentTick, level));
+                    reinsertScratch(expired);
+                }
+            }
+            auto& slot = levels[0][getSlot(currentTick, 0)];
+            for (auto& [expiryTick, entry] : slot)
+            {
+                expired.emplace_back(std::move(entry));
+            }
+            size -= slot.size();
+            slot.clear();
+            occupied[0] &= ~(uint64_t{1} << getSlot(currentTick, 0));
+        }
+    }
+
+    /// Earliest tick at which `advance` expires or cascades an entry, or nullopt if the TimingWheel is empty
+    [[nodiscard]] std::optional<Tick> getNextEventTick() const
+    {
+        if (size == 0)
+        {
+            return std::nullopt;
+        }
+        for (size_t level = 0; level < NumberOfLevels; ++level)
+        {
+            /// The slots at and before the current one are empty in every level, as their entries already cascaded or expired
+            const auto currentSlot = getSlot(currentTick, level);
+            const auto laterSlots = currentSlot + 1 == NumberOfSlots ? 0 : occupied[level] & (~uint64_t{0} << (currentSlot + 1));
+            if (laterSlots != 0)
+            {
+                const auto rotationStart = (currentTick >> (SlotBits * (level + 1))) << (SlotBits * (level + 1));
+                return rotationStart + (static_cast<Tick>(std::countr_zero(laterSlots)) << (SlotBits * level));
+            }
+        }
+        return ((currentTick >> (SlotBits * NumberOfLevels)) + 1) << (SlotBits * NumberOfLevels);
+    }
+
+    [[nodiscard]] bool empty() const { return size == 0; }
+
+    /// Moves all entries out of the TimingWheel
+    std::vector<Entry> clear()
+    {
+        std::vector<Entry> entries;
+        entries.reserve(size);
+        const auto moveOut = [&entries](std::vector<std::pair<Tick, Entry>>& slot)
+        {
+            for (auto& [expiryTick, entry] : slot)
+            {
+                entries.emplace_back(std::move(entry));
+            }
+            slot.clear();
+        };
+        for (auto& level : levels)
+        {
+            for (auto& slot : level)
+            {
+                moveOut(slot);
+            }
+        }
+        moveOut(overflow);
+        occupied = {};
+        size = 0;
+        return entries;
+    }
+
+private:
+    static constexpr size_t SlotBits = 6;
+    static constexpr size_t NumberOfSlots = size_t{1} << SlotBits;
+    static constexpr size_t NumberOfLevels = 4;
+
+    static size_t getSlot(const Tick tick, const size_t level) { return (tick >> (SlotBits * level)) & (NumberOfSlots - 1); }
+
+    /// True if the current tick starts a new slot of the level, i.e., the slot of the level cascades at the current tick
+    [[nodiscard]] bool isAlignedTo(const size_t level) const { return (currentTick & ((Tick{1} << (SlotBits * level)) - 1)) == 0; }
+
+    void place(const Tick expiryTick, Entry&& entry, std::vector<Entry>& expired)
+    {
+        if (expiryTick <= currentTick)
+        {
+            expired.emplace_back(std::move(entry));
+            return;
+        }
+        ++size;
+        for (size_t level = 0; level < NumberOfLevels; ++level)
+        {
+            const auto rotationBits = SlotBits * (level + 1);
+            if ((expiryTick >> rotationBits) == (currentTick >> rotationBits))
+            {
+                const auto slot = getSlot(expiryTick, level);
+                levels[level][slot].emplace_back(expiryTick, std::move(entry));
+                occupied[level] |= uint64_t{1} << slot;
+                return;
+            }
+        }
+        overflow.emplace_back(expiryTick, std::move(entry));
+    }
+
+    void reinsertScratch(std::vector<Entry>& expired)
+    {
+        size -= scratch.size();
+        for (auto& [expiryTick, entry] : scratch)
+        {
+            place(expiryTick, std::move(entry), expired);
+        }
+        scratch.clear();
+    }
+
+    std::array<std::array<std::vector<std::pair<Tick, Entry>>, NumberOfSlots>, NumberOfLevels> levels;
+    /// Bitmap of the non-empty slots of every level
+    std::array<uint64_t, NumberOfLevels> occupied{};
+    std::vector<std::pair<Tick, Entry>> overflow;
+    /// Holds the entries of a slot while they cascade, which reuses its allocation across cascades
+    std::vector<std::pair<Tick, Entry>> scratch;
+    Tick currentTick;
+    size_t size = 0;
+};
+
+}
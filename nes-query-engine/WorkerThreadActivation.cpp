@@ -0,0 +1,113 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <WorkerThreadActivation.hpp>
+
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+WorkerThreadActivation::WorkerThreadActivation(const size_t numberOfWorkerThreads, const Limits initialLimits)
+    : limits(initialLimits), numberOfActiveWorkerThreads(initialLimits.minimum), activations(numberOfWorkerThreads)
+{
+    validate(initialLimits);
+}
+
+std::optional<std::stop_source> WorkerThreadActivation::awaitActivation(const size_t worker, const std::stop_token& stoken)
+{
+    std::unique_lock lock(mutex);
+    const auto isActive
+        = activationChanged.wait(lock, stoken, [&] { return worker < numberOfActiveWorkerThreads.load(std::memory_order::relaxed); });
+    /// An active WorkerThread is not activated anymore once the ThreadPool stops
+    if (!isActive || stoken.stop_requested())
+    {
+        return std::nullopt;
+    }
+    activations[worker] = std::stop_source{};
+    return activations[worker];
+}
+
+bool WorkerThreadActivation::activateOne()
+{
+    {
+        const std::scoped_lock lock(mutex);
+        const auto active = numberOfActiveWorkerThreads.load(std::memory_order::relaxed);
+        if (active >= limits.maximum)
+        {
+            return false;
+        }
+        numberOfActiveWorkerThreads.store(active + 1, std::memory_order::relaxed);
+    }
+    activationChanged.notify_all();
+    return true;
+}
+
+bool WorkerThreadActivation::retireOne()
+{
+    const std::scoped_lock lock(mutex);
+    if (numberOfActiveWorkerThreads.load(std::memory_order::relaxed) <= limits.minimum)
+    {
+        return false;
+    }
+    retireLocked();
+    return true;
+}
+
+void WorkerThreadActivation::retireLocked()
+{
+    const auto active = numberOfActiveWorkerThreads.load(std::memory_order::relaxed) - 1;
+    numberOfActiveWorkerThreads.store(active, std::memory_order::relaxed);
+    /// If the WorkerThread did not wake up since its last retirement, this stops the (already stopped) previous activation
+    activations[active].request_stop();
+}
+
+void WorkerThreadActivation::setLimits(const Limits newLimits)
+{
+    validate(newLimits);
+    {
+        const std::scoped_lock lock(mutex);
+        limits = newLimits;
+        while (numberOfActiveWorkerThreads.load(std::memory_order::relaxed) > limits.maximum)
+        {
+            retireLocked();
+        }
+        if (numberOfActiveWorkerThreads.load(std::memory_order::relaxed) < limits.minimum)
+        {
+            numberOfActiveWorkerThreads.store(limits.minimum, std::memory_order::relaxed);
+        }
+    }
+    activationChanged.notify_all();
+}
+
+WorkerThreadActivation::Limits WorkerThreadActivation::getLimits() const
+{
+    const std::scoped_lock lock(mutex);
+    return limits;
+}
+
+void WorkerThreadActivation::validate(const Limits candidate) const
+{
+    if (candidate.minimum == 0 || candidate.minimum > candidate.maximum || candidate.maximum > activations.size())
+    {
+        throw InvalidConfigParameter(
+            "Invalid worker thread limits [{}, {}] for {} worker threads", candidate.minimum, candidate.maximum, activations.size());
+    }
+}
+
+}
@@ -0,0 +1,75 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <vector>
+
+namespace NES
+{
+
+/// Decides which WorkerThreads of the ThreadPool take tasks. The ThreadPool creates all of its WorkerThreads upfront, because operators
+/// size their per-thread state by the number of WorkerThreads. Only the WorkerThreads with an index below the number of active
+/// WorkerThreads take tasks, while the others park without consuming cpu time.
+/// The number of active WorkerThreads lies within [minimum, maximum]. Activating a WorkerThread wakes the parked WorkerThread with the
+/// lowest index and retiring a WorkerThread stops the active WorkerThread with the highest index.
+class WorkerThreadActivation
+{
+public:
+    struct Limits
+    {
+        size_t minimum;
+        size_t maximum;
+    };
+
+    /// Starts with the minimum number of active WorkerThreads
+    WorkerThreadActivation(size_t numberOfWorkerThreads, Limits initialLimits);
+
+    /// Blocks the WorkerThread until it is active. Returns a stop source that is stopped once the WorkerThread is retired, or nullopt once
+    /// the stop token is stopped.
+    [[nodiscard]] std::optional<std::stop_source> awaitActivation(size_t worker, const std::stop_token& stoken);
+
+    /// Returns false if the maximum number of WorkerThreads is already active
+    bool activateOne();
+    /// Returns false if only the minimum number of WorkerThreads is active
+    bool retireOne();
+
+    /// Throws InvalidConfigParameter unless 1 <= minimum <= maximum <= numberOfWorkerThreads. Activates or retires WorkerThreads until
+    /// the number of active WorkerThreads lies within the new limits.
+    void setLimits(Limits newLimits);
+    [[nodiscard]] Limits getLimits() const;
+
+    [[nodiscard]] size_t getNumberOfActiveWorkerThreads() const { return numberOfActiveWorkerThreads.load(std::memory_order::relaxed); }
+
+private:
+    void validate(Limits candidate) const;
+    void retireLocked();
+
+    mutable std::mutex mutex;
+    /// Waits on the stop token of the WorkerThread as well, thus stopping the ThreadPool wakes parked WorkerThreads immediately
+    std::condition_variable_any activationChanged;
+    Limits limits;
+    /// Written under the mutex, read without it
+    std::atomic<size_t> numberOfActiveWorkerThreads;
+    /// The stop source of the current activation of every WorkerThread
+    std::vector<std::stop_source> activations;
+};
+
+}
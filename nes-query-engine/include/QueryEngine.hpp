@@ -13,7 +13,10 @@
 */
 
 #pragma once
+#include <chrono>
+#include <cstddef>
 #include <memory>
+#include <vector>
 #include <Identifiers/Identifiers.hpp>
 #include <Listeners/AbstractQueryStatusListener.hpp>
 #include <Runtime/BufferManager.hpp>
@@ -27,6 +30,38 @@ namespace NES
 class QueryCatalog;
 class ThreadPool;
 
+/// Snapshot of the state of the task queue and the WorkerThreads. The queue sizes are approximate, as they change concurrently.
+struct QueryEngineStatistics
+{
+    size_t numberOfInternalTasks = 0;
+    size_t numberOfAdmissionTasks = 0;
+    size_t admissionQueueCapacity = 0;
+    size_t numberOfActiveWorkerThreads = 0;
+    /// Cumulative time that each WorkerThread spent executing tasks, indexed by the offset of its WorkerThreadId
+    std::vector<std::chrono::nanoseconds> busyTimePerWorkerThread;
+    /// Input buffers that the sources dropped under overload, and the tuples (or bytes of raw input buffers) that they contained
+    size_t numberOfShedBuffers = 0;
+    size_t numberOfShedTuples = 0;
+    /// The current inflight buffer limit of each running source, and the number of its buffers that are inflight
+    struct SourceInflightBuffers
+    {
+        QueryId queryId = INVALID<QueryId>;
+        OriginId sourceId = INVALID<OriginId>;
+        size_t limit = 0;
+        size_t numberOfInflightBuffers = 0;
+    };
+    std::vector<SourceInflightBuffers> inflightBuffersPerSource;
+    /// The cpu time that the WorkerThreads spent on the tasks of each running query, and the number of quota periods in which the query
+    /// exceeded its cpu share (see QueryEngineConfiguration::queryCpuQuotaInPercent)
+    struct QueryCpuTime
+    {
+        QueryId queryId = INVALID<QueryId>;
+        std::chrono::nanoseconds cpuTime{0};
+        size_t numberOfThrottledPeriods = 0;
+    };
+    std::vector<QueryCpuTime> cpuTimePerQuery;
+};
+
 class QueryEngine
 {
 public:
@@ -38,6 +73,11 @@ public:
         WorkerId workerId);
     void stop(QueryId queryId);
     void start(std::unique_ptr<ExecutableQueryPlan> executableQueryPlan);
+    /// Bounds the number of active WorkerThreads, within which the ThreadPool scales with the load. Throws InvalidConfigParameter unless
+    /// 1 <= minimum <= maximum <= number_of_worker_threads.
+    void setWorkerThreadLimits(size_t minimum, size_t maximum);
+    /// Reading the statistics does not block the WorkerThreads
+    [[nodiscard]] QueryEngineStatistics getStatistics() const;
     ~QueryEngine();
 
     /// Order of Member construction is top to bottom and order of destruction is reversed
@@ -14,16 +14,53 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 #include <Configurations/BaseConfiguration.hpp>
 #include <Configurations/BaseOption.hpp>
+#include <Configurations/Enums/EnumOption.hpp>
 #include <Configurations/ScalarOption.hpp>
 #include <Configurations/Validation/ConfigurationValidation.hpp>
+#include <Configurations/Validation/CpuListValidation.hpp>
+#include <Configurations/Validation/NonZeroValidation.hpp>
+#include <Configurations/Validation/NumberValidation.hpp>
 
 namespace NES
 {
+
+/// Controls how the ThreadPool distributes internally emitted tasks among the WorkerThreads.
+/// GLOBAL_QUEUE: all WorkerThreads share a single internal task queue.
+/// WORK_STEALING: every WorkerThread owns a local task queue for its follow-up tasks and idle WorkerThreads steal from their peers.
+/// PIPELINE_AFFINITY: like WORK_STEALING, but a pipeline with a single successor processes emitted buffers of the successor
+///     immediately on the same WorkerThread, as long as the chain of inlined pipelines stays short.
+enum class TaskSchedulingMode : uint8_t
+{
+    GLOBAL_QUEUE,
+    WORK_STEALING,
+    PIPELINE_AFFINITY
+};
+
+/// Controls how a WorkerThread waits for tasks while the task queue is empty.
+/// PARK: the WorkerThread blocks on the task queue right away and the OS wakes it up once a task arrives.
+/// SPIN_THEN_PARK: the WorkerThread spins and then yields for a short time before it parks. The spin time adapts to the inter-arrival
+///     time of the tasks. This trades cpu time of idle WorkerThreads for a lower latency of sporadically arriving tasks.
+enum class WorkerIdleStrategy : uint8_t
+{
+    PARK,
+    SPIN_THEN_PARK
+};
+
+/// Controls which queries drop input buffers at their sources while the QueryEngine is overloaded (see LoadShedder).
+/// RANDOM: the sources of all queries drop the same fraction of their buffers.
+/// PRIORITY: the sources of queries of low priority drop twice the fraction, those of queries of high priority drop nothing.
+enum class LoadSheddingPolicy : uint8_t
+{
+    RANDOM,
+    PRIORITY
+};
+
 class QueryEngineConfiguration final : public BaseConfiguration
 {
     /// validators to prevent nonsensical values for the number of threads and task queue size
@@ -37,10 +74,82 @@ public:
 
     UIntOption numberOfWorkerThreads
         = {"number_of_worker_threads", "4", "Number of worker threads used within the QueryEngine", {numberOfThreadsValidator()}};
+    /// Worker threads beyond the active ones park without consuming cpu time, thus an elastic pool can be sized for the peak load
+    UIntOption minNumberOfWorkerThreads
+        = {"min_number_of_worker_threads",
+           "0",
+           "Number of worker threads that stay active under low load. The QueryEngine activates up to number_of_worker_threads worker "
+           "threads as the task queue fills up. 0 keeps all worker threads active.",
+           {std::make_shared<NumberValidation>()}};
     UIntOption admissionQueueSize
         = {"admission_queue_size", "1000", "Size of the bounded admission queue used within the QueryEngine", {queueSizeValidator()}};
+    EnumOption<TaskSchedulingMode> taskSchedulingMode
+        = {"task_scheduling_mode",
+           TaskSchedulingMode::GLOBAL_QUEUE,
+           "Distribution of internal tasks among worker threads"
+           "[GLOBAL_QUEUE|WORK_STEALING|PIPELINE_AFFINITY]."};
+    /// Pinning every worker thread to a single cpu keeps its caches warm and, with NUMA-aware buffer pools, its buffers on its node
+    StringOption workerThreadCpus
+        = {"worker_thread_cpus",
+           "",
+           "Cpus (e.g. 0-3,8) that the worker threads are pinned to, one cpu per thread in round-robin. Empty leaves the placement to the "
+           "OS.",
+           {std::make_shared<CpuListValidation>()}};
+    EnumOption<WorkerIdleStrategy> workerIdleStrategy
+        = {"worker_idle_strategy", WorkerIdleStrategy::PARK, "Waiting of idle worker threads for new tasks [PARK|SPIN_THEN_PARK]."};
+    /// Batches amortize the synchronization on the task queue over many small tasks, but delay the emitted tasks until the end of a task
+    UIntOption taskBatchSize
+        = {"task_batch_size",
+           "1",
+           "Maximum number of tasks that a worker thread takes from (and emits to) the shared task queue at once.",
+           {std::make_shared<NonZeroValidation>()}};
+    /// Sources drop input buffers instead of blocking on the full admission queue, which bounds the latency of the remaining buffers
+    UIntOption loadSheddingQueueWaitThresholdInMs
+        = {"load_shedding_queue_wait_threshold_ms",
+           "0",
+           "Time that tasks may wait in the task queue on average, before the sources drop input buffers to shed load. 0 disables the "
+           "load shedding.",
+           {std::make_shared<NumberValidation>()}};
+    EnumOption<LoadSheddingPolicy> loadSheddingPolicy
+        = {"load_shedding_policy",
+           LoadSheddingPolicy::RANDOM,
+           "Queries whose sources drop input buffers under overload [RANDOM|PRIORITY]."};
+    /// Tells whether a pipeline is memory-bound, e.g., a hash probe, or compute-bound, e.g., parsing, at two system calls per task
+    BoolOption hardwareCounters
+        = {"hardware_counters",
+           "false",
+           "Counts the cycles, instructions, last level cache misses and branch misses of every task in user space with perf events of "
+           "its worker thread. The pipeline metrics sum them up per pipeline."};
+    /// The WorkerThreads account the cpu time of every query regardless of the quota, as reading the time stamp counter is cheap
+    UIntOption queryCpuQuotaInPercent
+        = {"query_cpu_quota_percent",
+           "0",
+           "Share of the cpu time of all worker threads that a single query may use per query_cpu_quota_period_ms. A query that exceeds "
+           "its share yields the admission queue to the other queries until the period ends, which backpressures its sources. 0 "
+           "disables the quota.",
+           {std::make_shared<NumberValidation>()}};
+    UIntOption queryCpuQuotaPeriodInMs
+        = {"query_cpu_quota_period_ms",
+           "100",
+           "Length of the periods, in which a query may use its query_cpu_quota_percent of the cpu time.",
+           {std::make_shared<NonZeroValidation>()}};
 
 protected:
-    std::vector<BaseOption*> getOptions() override { return {&numberOfWorkerThreads, &admissionQueueSize}; }
+    std::vector<BaseOption*> getOptions() override
+    {
+        return {
+            &numberOfWorkerThreads,
+            &minNumberOfWorkerThreads,
+            &admissionQueueSize,
+            &taskSchedulingMode,
+            &workerThreadCpus,
+            &workerIdleStrategy,
+            &taskBatchSize,
+            &loadSheddingQueueWaitThresholdInMs,
+            &loadSheddingPolicy,
+            &hardwareCounters,
+            &queryCpuQuotaInPercent,
+            &queryCpuQuotaPeriodInMs};
+    }
 };
 }
@@ -15,6 +15,8 @@
 #pragma once
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <variant>
 #include <Identifiers/Identifiers.hpp>
 #include <Identifiers/NESStrongType.hpp>
@@ -37,8 +39,18 @@ struct EventBase
 
 struct TaskExecutionStart : EventBase
 {
-    TaskExecutionStart(WorkerThreadId threadId, QueryId queryId, PipelineId pipelineId, TaskId taskId, size_t numberOfTuples)
-        : EventBase(threadId, queryId), pipelineId(pipelineId), taskId(taskId), numberOfTuples(numberOfTuples)
+    TaskExecutionStart(
+        WorkerThreadId threadId,
+        QueryId queryId,
+        PipelineId pipelineId,
+        TaskId taskId,
+        size_t numberOfTuples,
+        ChronoClock::time_point submissionTimestamp = {})
+        : EventBase(threadId, queryId)
+        , pipelineId(pipelineId)
+        , taskId(taskId)
+        , numberOfTuples(numberOfTuples)
+        , submissionTimestamp(submissionTimestamp)
     {
     }
 
@@ -47,6 +59,8 @@ struct TaskExecutionStart : EventBase
     PipelineId pipelineId = INVALID<PipelineId>;
     TaskId taskId = INVALID<TaskId>;
     size_t numberOfTuples;
+    /// When the task was submitted to the task queue, i.e., the task waited from then until its start
+    ChronoClock::time_point submissionTimestamp;
 };
 
 struct TaskEmit : EventBase
@@ -64,10 +78,29 @@ struct TaskEmit : EventBase
     size_t numberOfTuples{};
 };
 
+/// Counted by the perf events of a WorkerThread in user space (see QueryEngineConfiguration::hardwareCounters)
+struct HardwareCounterValues
+{
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t lastLevelCacheMisses = 0;
+    uint64_t branchMisses = 0;
+
+    HardwareCounterValues operator-(const HardwareCounterValues& other) const
+    {
+        return {
+            .cycles = cycles - other.cycles,
+            .instructions = instructions - other.instructions,
+            .lastLevelCacheMisses = lastLevelCacheMisses - other.lastLevelCacheMisses,
+            .branchMisses = branchMisses - other.branchMisses};
+    }
+};
+
 struct TaskExecutionComplete : EventBase
 {
-    TaskExecutionComplete(WorkerThreadId threadId, QueryId queryId, PipelineId pipelineId, TaskId taskId)
-        : EventBase(threadId, queryId), pipelineId(pipelineId), taskId(taskId)
+    TaskExecutionComplete(
+        WorkerThreadId threadId, QueryId queryId, PipelineId pipelineId, TaskId taskId, ChronoClock::time_point startTimestamp = {})
+        : EventBase(threadId, queryId), pipelineId(pipelineId), taskId(taskId), startTimestamp(startTimestamp)
     {
     }
 
@@ -76,6 +109,15 @@ struct TaskExecutionComplete : EventBase
 
     PipelineId pipelineId = INVALID<PipelineId>;
     TaskId taskId = INVALID<TaskId>;
+    /// The timestamp of the TaskExecutionStart of the task, which allows listeners to derive the execution time without matching events
+    ChronoClock::time_point startTimestamp;
+    /// Sinks are the pipelines without successors. For them, the completion of the task is the end of the processing of its tuples.
+    bool isSink = false;
+    /// The earliest and latest time at which a source ingested one of the tuples of the input buffer, or the epoch if unknown
+    ChronoClock::time_point minIngestionTimestamp;
+    ChronoClock::time_point maxIngestionTimestamp;
+    /// Only set if the WorkerThread counts hardware events. Like the execution time, they include successors executed right away.
+    std::optional<HardwareCounterValues> hardwareCounters;
 };
 
 struct TaskExpired : EventBase
@@ -138,6 +180,35 @@ struct PipelineStop : EventBase
     PipelineId pipelineId = INVALID<PipelineId>;
 };
 
+/// Cumulative counters of the thread-local buffer cache of a WorkerThread (see BufferManager::enableThreadLocalCaches()).
+struct BufferCacheStatistic : EventBase
+{
+    BufferCacheStatistic(WorkerThreadId threadId, size_t hits, size_t misses)
+        : EventBase(threadId, INVALID<QueryId>), hits(hits), misses(misses)
+    {
+    }
+
+    BufferCacheStatistic() = default;
+
+    size_t hits{};
+    size_t misses{};
+};
+
+/// A source dropped an input buffer instead of emitting it, because the QueryEngine is overloaded (see LoadShedder)
+struct BufferShed : EventBase
+{
+    BufferShed(QueryId queryId, OriginId sourceId, size_t numberOfTuples)
+        : EventBase(INVALID<WorkerThreadId>, queryId), sourceId(sourceId), numberOfTuples(numberOfTuples)
+    {
+    }
+
+    BufferShed() = default;
+
+    OriginId sourceId = INVALID<OriginId>;
+    /// Sources emit their buffers before the input formatter parses them, thus this is the number of bytes for raw input buffers
+    size_t numberOfTuples{};
+};
+
 using Event = std::variant<
     TaskExecutionStart,
     TaskEmit,
@@ -148,7 +219,9 @@ using Event = std::variant<
     QueryStart,
     QueryStopRequest,
     QueryStop,
-    QueryFail>;
+    QueryFail,
+    BufferCacheStatistic,
+    BufferShed>;
 
 struct QueryEngineStatisticListener
 {
@@ -173,6 +173,26 @@ TEST_F(DelayedTaskSubmitterTest, testMultipleTasksOrderedExecution)
     }
 }
 
+/// Tasks with delays beyond the first level of the timing wheel cascade into the lower levels before they are submitted
+TEST_F(DelayedTaskSubmitterTest, testTasksCascadeThroughTimingWheel)
+{
+    auto submitter = DelayedTaskSubmitter([this](Task task) noexcept { submitTask(std::move(task)); });
+
+    auto task1 = WorkTask(QueryId(1), PipelineId(1), std::weak_ptr<RunningQueryPlanNode>(), TupleBuffer(), {});
+    auto task2 = WorkTask(QueryId(2), PipelineId(2), std::weak_ptr<RunningQueryPlanNode>(), TupleBuffer(), {});
+    submitter.submitTaskIn(std::move(task1), std::chrono::milliseconds(100));
+    submitter.submitTaskIn(std::move(task2), std::chrono::milliseconds(130));
+
+    TestClock::advance(std::chrono::milliseconds(99), true);
+    ASSERT_EQ(getSubmittedTaskCount(), 0);
+    TestClock::advance(std::chrono::milliseconds(1), true);
+    ASSERT_EQ(getSubmittedTaskCount(), 1);
+    TestClock::advance(std::chrono::milliseconds(29), true);
+    ASSERT_EQ(getSubmittedTaskCount(), 1);
+    TestClock::advance(std::chrono::milliseconds(1), true);
+    ASSERT_EQ(getSubmittedTaskCount(), 2);
+}
+
 TEST_F(DelayedTaskSubmitterTest, testTaskWithZeroDelay)
 {
     auto submitter = DelayedTaskSubmitter([this](Task task) noexcept { submitTask(std::move(task)); });
@@ -0,0 +1,47 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <HardwareCounters.hpp>
+
+#include <cstdint>
+#include <utility>
+#include <gtest/gtest.h>
+
+namespace NES
+{
+
+/// Machines without permitted perf events, e.g., containers or VMs, skip the test
+TEST(HardwareCountersTest, CountsTheWorkOfTheCallingThread)
+{
+    auto counters = HardwareCounters::openForThisThread();
+    if (not counters)
+    {
+        GTEST_SKIP() << "Hardware counters are not available";
+    }
+    const auto start = counters->read();
+    ASSERT_TRUE(start.has_value());
+    volatile uint64_t sum = 0;
+    for (uint64_t i = 0; i < 1'000'000; ++i)
+    {
+        sum = sum + i;
+    }
+    const auto moved = std::move(*counters);
+    const auto end = moved.read();
+    ASSERT_TRUE(end.has_value());
+    const auto task = *end - *start;
+    EXPECT_GE(task.instructions, 1'000'000);
+    EXPECT_GT(task.cycles, 0);
+}
+
+}
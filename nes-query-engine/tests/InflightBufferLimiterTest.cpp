@@ -0,0 +1,110 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <InflightBufferLimiter.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stop_token>
+#include <thread>
+#include <gtest/gtest.h>
+
+namespace NES
+{
+
+namespace
+{
+/// Emits and releases one window of buffers. If the source waits for the limit, its acquire fails, because the stop was requested.
+void runWindow(InflightBufferLimiter& limiter, const std::chrono::nanoseconds turnaround, const bool sourceWaits)
+{
+    const auto numberOfBuffers = limiter.getLimit();
+    for (size_t buffer = 0; buffer < numberOfBuffers; ++buffer)
+    {
+        ASSERT_TRUE(limiter.tryAcquire());
+    }
+    if (sourceWaits)
+    {
+        std::stop_source stop;
+        stop.request_stop();
+        EXPECT_FALSE(limiter.acquire(stop.get_token()));
+    }
+    for (size_t buffer = 0; buffer < numberOfBuffers; ++buffer)
+    {
+        limiter.release(turnaround);
+    }
+}
+}
+
+TEST(InflightBufferLimiterTest, StaticLimitIgnoresTurnaround)
+{
+    InflightBufferLimiter limiter{4, false};
+    runWindow(limiter, std::chrono::milliseconds(1), true);
+    runWindow(limiter, std::chrono::seconds(1), true);
+    EXPECT_EQ(limiter.getLimit(), 4);
+
+    for (size_t buffer = 0; buffer < 4; ++buffer)
+    {
+        EXPECT_TRUE(limiter.tryAcquire());
+    }
+    EXPECT_FALSE(limiter.tryAcquire());
+    EXPECT_EQ(limiter.getNumberOfInflightBuffers(), 4);
+}
+
+TEST(InflightBufferLimiterTest, AdaptiveLimitHalvesWhileBuffersQueueUp)
+{
+    InflightBufferLimiter limiter{8, true};
+    runWindow(limiter, std::chrono::milliseconds(1), false);
+    EXPECT_EQ(limiter.getLimit(), 8);
+    runWindow(limiter, std::chrono::milliseconds(10), false);
+    EXPECT_EQ(limiter.getLimit(), 4);
+    runWindow(limiter, std::chrono::milliseconds(10), false);
+    EXPECT_EQ(limiter.getLimit(), 2);
+    runWindow(limiter, std::chrono::milliseconds(10), false);
+    runWindow(limiter, std::chrono::milliseconds(10), false);
+    EXPECT_EQ(limiter.getLimit(), 1);
+}
+
+TEST(InflightBufferLimiterTest, AdaptiveLimitGrowsOnlyIfTheSourceWaited)
+{
+    InflightBufferLimiter limiter{8, true};
+    runWindow(limiter, std::chrono::milliseconds(1), false);
+    runWindow(limiter, std::chrono::milliseconds(10), false);
+    EXPECT_EQ(limiter.getLimit(), 4);
+
+    runWindow(limiter, std::chrono::milliseconds(1), true);
+    EXPECT_EQ(limiter.getLimit(), 5);
+    runWindow(limiter, std::chrono::milliseconds(1), true);
+    EXPECT_EQ(limiter.getLimit(), 6);
+    runWindow(limiter, std::chrono::milliseconds(1), false);
+    EXPECT_EQ(limiter.getLimit(), 6);
+}
+
+TEST(InflightBufferLimiterTest, ReleaseWakesUpWaitingSource)
+{
+    InflightBufferLimiter limiter{1, true};
+    ASSERT_TRUE(limiter.tryAcquire());
+
+    std::atomic<bool> acquired{false};
+    std::jthread source([&](const std::stop_token& stopToken) { acquired = limiter.acquire(stopToken); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_FALSE(acquired);
+
+    limiter.release(std::chrono::milliseconds(1));
+    source.join();
+    EXPECT_TRUE(acquired);
+    EXPECT_EQ(limiter.getNumberOfInflightBuffers(), 1);
+}
+
+}
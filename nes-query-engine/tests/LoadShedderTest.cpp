@@ -0,0 +1,94 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <LoadShedder.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <gtest/gtest.h>
+#include <CompiledQueryPlan.hpp>
+#include <QueryEngineConfiguration.hpp>
+
+namespace NES
+{
+
+namespace
+{
+/// Records the queue wait so often that the smoothed queue wait converges to it
+void recordSteadyQueueWait(LoadShedder& shedder, const std::chrono::nanoseconds queueWait)
+{
+    for (size_t task = 0; task < 200; ++task)
+    {
+        shedder.recordQueueWait(queueWait);
+    }
+}
+}
+
+TEST(LoadShedderTest, DisabledWithoutThreshold)
+{
+    LoadShedder shedder{std::chrono::milliseconds(0), LoadSheddingPolicy::RANDOM};
+    recordSteadyQueueWait(shedder, std::chrono::seconds(10));
+    EXPECT_FALSE(shedder.isEnabled());
+    EXPECT_EQ(shedder.getSheddingProbability(QueryPriority::Low), 0);
+    EXPECT_FALSE(shedder.shouldShed(QueryPriority::Low));
+}
+
+TEST(LoadShedderTest, NoSheddingBelowThreshold)
+{
+    LoadShedder shedder{std::chrono::milliseconds(10), LoadSheddingPolicy::RANDOM};
+    recordSteadyQueueWait(shedder, std::chrono::milliseconds(5));
+    EXPECT_EQ(shedder.getSheddingProbability(QueryPriority::Normal), 0);
+    EXPECT_FALSE(shedder.shouldShed(QueryPriority::Normal));
+}
+
+/// Twice the threshold drops half of the buffers, which halves the load
+TEST(LoadShedderTest, RandomShedsAllQueriesAlike)
+{
+    LoadShedder shedder{std::chrono::milliseconds(10), LoadSheddingPolicy::RANDOM};
+    recordSteadyQueueWait(shedder, std::chrono::milliseconds(20));
+    EXPECT_NEAR(shedder.getSheddingProbability(QueryPriority::Low), 0.5, 0.01);
+    EXPECT_NEAR(shedder.getSheddingProbability(QueryPriority::Normal), 0.5, 0.01);
+    EXPECT_NEAR(shedder.getSheddingProbability(QueryPriority::High), 0.5, 0.01);
+
+    size_t shed = 0;
+    constexpr size_t numberOfBuffers = 10000;
+    for (size_t buffer = 0; buffer < numberOfBuffers; ++buffer)
+    {
+        shed += shedder.shouldShed(QueryPriority::Normal) ? 1 : 0;
+    }
+    EXPECT_NEAR(static_cast<double>(shed) / numberOfBuffers, 0.5, 0.05);
+}
+
+TEST(LoadShedderTest, PrioritySparesHighPriority)
+{
+    LoadShedder shedder{std::chrono::milliseconds(10), LoadSheddingPolicy::PRIORITY};
+    recordSteadyQueueWait(shedder, std::chrono::milliseconds(15));
+    EXPECT_NEAR(shedder.getSheddingProbability(QueryPriority::Low), 2.0 / 3, 0.01);
+    EXPECT_NEAR(shedder.getSheddingProbability(QueryPriority::Normal), 1.0 / 3, 0.01);
+    EXPECT_EQ(shedder.getSheddingProbability(QueryPriority::High), 0);
+    EXPECT_FALSE(shedder.shouldShed(QueryPriority::High));
+}
+
+/// Some buffers always pass, as only they update the queue wait once the overload ends
+TEST(LoadShedderTest, SheddingIsBounded)
+{
+    LoadShedder shedder{std::chrono::milliseconds(1), LoadSheddingPolicy::PRIORITY};
+    recordSteadyQueueWait(shedder, std::chrono::seconds(1));
+    EXPECT_EQ(shedder.getSheddingProbability(QueryPriority::Low), LoadShedder::MAX_SHEDDING_PROBABILITY);
+
+    recordSteadyQueueWait(shedder, std::chrono::microseconds(100));
+    EXPECT_EQ(shedder.getSheddingProbability(QueryPriority::Low), 0);
+}
+
+}
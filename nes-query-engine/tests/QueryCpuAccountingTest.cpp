@@ -0,0 +1,94 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <QueryCpuAccounting.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+#include <gtest/gtest.h>
+
+namespace NES
+{
+
+namespace
+{
+constexpr auto PERIOD = std::chrono::milliseconds(10);
+
+/// Records the throttles in the order of the calls
+auto recordThrottles(std::vector<std::pair<QueryId, bool>>& throttles)
+{
+    return [&throttles](const QueryId queryId, const bool throttled) { throttles.emplace_back(queryId, throttled); };
+}
+
+/// Sleeps until the current period elapsed and starts the next one
+void startNextPeriod(QueryCpuAccounting& accounting)
+{
+    std::this_thread::sleep_for(PERIOD);
+    accounting.startNextPeriodIfElapsed();
+}
+}
+
+TEST(QueryCpuAccountingTest, AccountsWithoutQuota)
+{
+    std::vector<std::pair<QueryId, bool>> throttles;
+    QueryCpuAccounting accounting{4, 0, PERIOD, recordThrottles(throttles)};
+    auto account = accounting.registerQuery(QueryId(1));
+    startNextPeriod(accounting);
+    accounting.record(*account, UINT64_MAX / 4);
+    startNextPeriod(accounting);
+    EXPECT_TRUE(throttles.empty());
+
+    const auto cpuTimes = accounting.getCpuTimes();
+    ASSERT_EQ(cpuTimes.size(), 1);
+    EXPECT_EQ(cpuTimes[0].queryId, QueryId(1));
+    EXPECT_GT(cpuTimes[0].cpuTime.count(), 0);
+    EXPECT_EQ(cpuTimes[0].numberOfThrottledPeriods, 0);
+
+    /// Queries are reported as long as their pipelines hold their account
+    account.reset();
+    EXPECT_TRUE(accounting.getCpuTimes().empty());
+}
+
+/// A query that exceeds its share gets throttled once per period, until the period ends
+TEST(QueryCpuAccountingTest, ThrottlesUntilThePeriodEnds)
+{
+    std::vector<std::pair<QueryId, bool>> throttles;
+    QueryCpuAccounting accounting{4, 50, PERIOD, recordThrottles(throttles)};
+    const auto heavy = accounting.registerQuery(QueryId(1));
+    const auto light = accounting.registerQuery(QueryId(2));
+
+    /// The first period calibrates the rate of the cycle counter and does not throttle
+    accounting.record(*heavy, UINT64_MAX / 4);
+    EXPECT_TRUE(throttles.empty());
+    startNextPeriod(accounting);
+
+    accounting.record(*light, 1);
+    accounting.record(*heavy, UINT64_MAX / 4);
+    accounting.record(*heavy, 1);
+    EXPECT_EQ(throttles, (std::vector<std::pair<QueryId, bool>>{{QueryId(1), true}}));
+    EXPECT_TRUE(heavy->throttled);
+    EXPECT_FALSE(light->throttled);
+
+    startNextPeriod(accounting);
+    EXPECT_EQ(throttles, (std::vector<std::pair<QueryId, bool>>{{QueryId(1), true}, {QueryId(1), false}}));
+    EXPECT_FALSE(heavy->throttled);
+    EXPECT_EQ(heavy->cyclesInPeriod, 0);
+    EXPECT_EQ(heavy->numberOfThrottledPeriods, 1);
+}
+
+}
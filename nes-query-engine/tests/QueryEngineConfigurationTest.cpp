@@ -38,15 +38,25 @@ TEST_F(QueryEngineConfigurationTest, testConfigurationsDefault)
     const QueryEngineConfiguration defaultConfig;
     EXPECT_EQ(defaultConfig.admissionQueueSize.getValue(), 1000);
     EXPECT_EQ(defaultConfig.numberOfWorkerThreads.getValue(), 4);
+    EXPECT_EQ(defaultConfig.taskSchedulingMode.getValue(), TaskSchedulingMode::GLOBAL_QUEUE);
+    EXPECT_EQ(defaultConfig.workerThreadCpus.getValue(), "");
+    EXPECT_EQ(defaultConfig.workerIdleStrategy.getValue(), WorkerIdleStrategy::PARK);
+    EXPECT_EQ(defaultConfig.taskBatchSize.getValue(), 1);
 }
 
 TEST_F(QueryEngineConfigurationTest, testConfigurationsValidInput)
 {
     QueryEngineConfiguration defaultConfig;
-    defaultConfig.overwriteConfigWithCommandLineInput({{"number_of_worker_threads", "2"}, {"admission_queue_size", "123"}});
+    defaultConfig.overwriteConfigWithCommandLineInput(
+        {{"number_of_worker_threads", "2"},
+         {"admission_queue_size", "123"},
+         {"task_scheduling_mode", "WORK_STEALING"},
+         {"worker_idle_strategy", "SPIN_THEN_PARK"}});
 
     EXPECT_EQ(defaultConfig.admissionQueueSize.getValue(), 123);
     EXPECT_EQ(defaultConfig.numberOfWorkerThreads.getValue(), 2);
+    EXPECT_EQ(defaultConfig.taskSchedulingMode.getValue(), TaskSchedulingMode::WORK_STEALING);
+    EXPECT_EQ(defaultConfig.workerIdleStrategy.getValue(), WorkerIdleStrategy::SPIN_THEN_PARK);
 }
 
 TEST_F(QueryEngineConfigurationTest, testConfigurationsBadInputNonString)
@@ -79,4 +89,17 @@ TEST_F(QueryEngineConfigurationTest, testConfigurationsBadInputBadNumberOfThread
         defaultConfig.overwriteConfigWithCommandLineInput({{"admission_queue_size", "200"}, {"number_of_worker_threads", "20000"}}));
 }
 
+TEST_F(QueryEngineConfigurationTest, testConfigurationsWorkerThreadCpus)
+{
+    QueryEngineConfiguration defaultConfig;
+    defaultConfig.overwriteConfigWithCommandLineInput({{"worker_thread_cpus", "0-3,8"}});
+    EXPECT_EQ(defaultConfig.workerThreadCpus.getValue(), "0-3,8");
+
+    QueryEngineConfiguration defaultConfig1;
+    EXPECT_ANY_THROW(defaultConfig1.overwriteConfigWithCommandLineInput({{"worker_thread_cpus", "3-1"}}));
+
+    QueryEngineConfiguration defaultConfig2;
+    EXPECT_ANY_THROW(defaultConfig2.overwriteConfigWithCommandLineInput({{"worker_thread_cpus", "cpu0"}}));
+}
+
 }
@@ -16,8 +16,10 @@
 #include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <future>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <ranges>
 #include <thread>
 #include <utility>
@@ -258,6 +260,134 @@ TEST_F(QueryEngineTest, singleQueryWithSystemStop)
     EXPECT_TRUE(verifyIdentifier(buffers[0], 1));
 }
 
+/// System Stop while Starting: The query is stopped while one of its pipelines is still starting. The stop drops the running query plan,
+/// thus the query never reports running and its sources are never opened.
+TEST_F(QueryEngineTest, singleQueryWithSystemStopDuringPipelineStart)
+{
+    TestingHarness test;
+    auto builder = test.buildNewQuery();
+    auto source = builder.addSource();
+    auto pipeline = builder.addPipeline({source});
+    auto sink = builder.addSink({pipeline});
+    auto query = test.addNewQuery(std::move(builder));
+    auto queryId = query->queryId;
+    test.pipelineControls[pipeline]->startDuration = DEFAULT_AWAIT_TIMEOUT;
+
+    std::promise<void> started;
+    auto startedFuture = started.get_future();
+    EXPECT_CALL(*test.status, logQueryStatusChange(queryId, QueryState::Started, ::testing::_))
+        .WillOnce(::testing::Invoke(
+            [&started](auto, auto, auto)
+            {
+                started.set_value();
+                return true;
+            }));
+    EXPECT_CALL(*test.status, logQueryStatusChange(queryId, QueryState::Running, ::testing::_)).Times(0);
+    test.expectQueryStatusEvents(queryId, {QueryState::Stopped});
+
+    test.start();
+    {
+        test.startQuery(std::move(query));
+
+        /// The query is starting as long as the pipeline sleeps in its start
+        ASSERT_TRUE(waitForFuture(startedFuture, DEFAULT_LONG_AWAIT_TIMEOUT));
+        test.stopQuery(queryId);
+        ASSERT_TRUE(test.waitForQepTermination(queryId, DEFAULT_LONG_AWAIT_TIMEOUT));
+    }
+    test.stop();
+
+    ASSERT_TRUE(test.sourceControls[source]->waitUntilDestroyed());
+    EXPECT_FALSE(test.sourceControls[source]->wasOpened());
+    EXPECT_TRUE(test.sinkControls[sink]->takeBuffers().empty());
+}
+
+/// System Stop while Reserved: Every query is stopped right after it was started, which races the stop with the start. A stop that arrives
+/// while the slot of the query is still reserved terminates the query before it is started. A stop that arrives before the start is
+/// ignored, thus each query is stopped again once it reported its start or its stop.
+/// Regardless of the interleaving, every query has to report exactly one stop, no failure, and dispose its query plan.
+TEST_F(QueryEngineTest, ManyQueriesWithSystemStopDuringQueryStart)
+{
+    constexpr size_t numberOfQueries = 50;
+
+    struct QueryReports
+    {
+        std::once_flag once;
+        std::promise<void> reported;
+        std::promise<void> stopped;
+        std::atomic_bool wasStarted = false;
+
+        void report()
+        {
+            std::call_once(once, [this] { reported.set_value(); });
+        }
+    };
+
+    TestingHarness test(LARGE_NUMBER_OF_THREADS, NUMBER_OF_BUFFERS_PER_SOURCE * numberOfQueries);
+
+    std::vector<std::unique_ptr<ExecutableQueryPlan>> queryPlans;
+    std::vector<std::shared_ptr<TestSourceControl>> sourceCtrls;
+    std::vector<std::unique_ptr<QueryReports>> reports;
+    for (size_t i = 0; i < numberOfQueries; i++)
+    {
+        auto builder = test.buildNewQuery();
+        auto source = builder.addSource();
+        builder.addSink({builder.addPipeline({source})});
+        queryPlans.push_back(test.addNewQuery(std::move(builder)));
+        sourceCtrls.push_back(test.sourceControls[source]);
+
+        auto& queryReports = *reports.emplace_back(std::make_unique<QueryReports>());
+        const auto queryId = queryPlans.back()->queryId;
+        EXPECT_CALL(*test.status, logQueryStatusChange(queryId, QueryState::Started, ::testing::_))
+            .Times(::testing::AtMost(1))
+            .WillRepeatedly(::testing::Invoke(
+                [&queryReports](auto, auto, auto)
+                {
+                    queryReports.wasStarted = true;
+                    queryReports.report();
+                    return true;
+                }));
+        EXPECT_CALL(*test.status, logQueryStatusChange(queryId, QueryState::Running, ::testing::_))
+            .Times(::testing::AtMost(1))
+            .WillRepeatedly(::testing::Return(true));
+        EXPECT_CALL(*test.status, logQueryStatusChange(queryId, QueryState::Stopped, ::testing::_))
+            .WillOnce(::testing::Invoke(
+                [&queryReports](auto, auto, auto)
+                {
+                    queryReports.report();
+                    queryReports.stopped.set_value();
+                    return true;
+                }));
+        EXPECT_CALL(*test.status, logQueryFailure(queryId, ::testing::_, ::testing::_)).Times(0);
+    }
+
+    test.start();
+    {
+        std::vector<QueryId> queryIds;
+        for (auto& query : queryPlans)
+        {
+            queryIds.push_back(query->queryId);
+            test.startQuery(std::move(query));
+            test.stopQuery(queryIds.back());
+        }
+
+        size_t stoppedBeforeStart = 0;
+        for (const auto& [queryId, queryReports] : std::views::zip(queryIds, reports))
+        {
+            ASSERT_TRUE(waitForFuture(queryReports->reported.get_future(), DEFAULT_LONG_AWAIT_TIMEOUT));
+            test.stopQuery(queryId);
+            ASSERT_TRUE(waitForFuture(queryReports->stopped.get_future(), DEFAULT_LONG_AWAIT_TIMEOUT));
+            stoppedBeforeStart += queryReports->wasStarted ? 0 : 1;
+        }
+        NES_DEBUG("{} of {} queries were stopped while they were reserved", stoppedBeforeStart, numberOfQueries);
+    }
+    test.stop();
+
+    for (const auto& sourceCtrl : sourceCtrls)
+    {
+        ASSERT_TRUE(sourceCtrl->waitUntilDestroyed());
+    }
+}
+
 TEST_F(QueryEngineTest, singleQueryWithSourceFailure)
 {
     TestingHarness test;
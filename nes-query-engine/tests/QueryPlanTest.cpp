@@ -147,7 +147,7 @@ struct TestPipelineExecutionContext : PipelineExecutionContext
     MOCK_METHOD(PipelineId, getPipelineId, (), (const, override));
     MOCK_METHOD((std::unordered_map<OperatorHandlerId, std::shared_ptr<OperatorHandler>>&), getOperatorHandlers, (), (override));
     MOCK_METHOD(void, setOperatorHandlers, ((std::unordered_map<OperatorHandlerId, std::shared_ptr<OperatorHandler>>&)), (override));
-    MOCK_METHOD(bool, emitBuffer, (const TupleBuffer&, ContinuationPolicy), (override));
+    MOCK_METHOD(bool, emitBuffer, (TupleBuffer, ContinuationPolicy), (override));
 };
 
 struct TerminatePipelineArgs
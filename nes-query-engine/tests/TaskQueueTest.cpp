@@ -244,4 +244,358 @@ TEST_F(TaskQueueTest, StressTest)
     consumedTasks.verifyUnique();
 }
 
+/// The owner of a local queue consumes its own follow-up tasks newest first, while peers steal the oldest task.
+TEST_F(TaskQueueTest, WorkStealingLocalQueueOrder)
+{
+    TaskQueue<Task> stealingQueue{100, 2};
+    ASSERT_TRUE(stealingQueue.hasLocalQueues());
+
+    for (int i = 0; i < 3; ++i)
+    {
+        stealingQueue.addLocalTaskNonBlocking(0, Task{0, i, {}});
+    }
+
+    const std::stop_token noStop;
+    auto ownTask = stealingQueue.getNextTaskBlocking(0, noStop);
+    ASSERT_TRUE(ownTask.has_value());
+    EXPECT_EQ(std::get<1>(*ownTask), 2);
+
+    auto stolenTask = stealingQueue.getNextTaskBlocking(1, noStop);
+    ASSERT_TRUE(stolenTask.has_value());
+    EXPECT_EQ(std::get<1>(*stolenTask), 0);
+
+    /// Terminating WorkerThreads drain the local queues via the non-blocking read
+    auto drainedTask = stealingQueue.getNextTaskNonBlocking();
+    ASSERT_TRUE(drainedTask.has_value());
+    EXPECT_EQ(std::get<1>(*drainedTask), 1);
+    EXPECT_FALSE(stealingQueue.getNextTaskNonBlocking().has_value());
+}
+
+/// Tasks written to an out of range local queue (e.g. work-stealing is disabled) end up in the shared internal queue.
+TEST_F(TaskQueueTest, WorkStealingDisabledFallsBackToInternalQueue)
+{
+    ASSERT_FALSE(queue.hasLocalQueues());
+    queue.addLocalTaskNonBlocking(0, Task{0, 0, {}});
+    auto task = queue.getNextTaskNonBlocking();
+    ASSERT_TRUE(task.has_value());
+    EXPECT_EQ(std::get<1>(*task), 0);
+}
+
+/// The internal task count includes the tasks in the local queues, while the admission queue is counted separately.
+TEST_F(TaskQueueTest, QueueSizes)
+{
+    TaskQueue<Task> stealingQueue{100, 2};
+    EXPECT_EQ(stealingQueue.getAdmissionCapacity(), 100);
+
+    stealingQueue.addAdmissionTaskBlocking({}, Task{0, 0, {}});
+    stealingQueue.addInternalTaskNonBlocking(Task{0, 1, {}});
+    stealingQueue.addLocalTaskNonBlocking(0, Task{0, 2, {}});
+    stealingQueue.addLocalTaskNonBlocking(1, Task{0, 3, {}});
+    EXPECT_EQ(stealingQueue.getNumberOfAdmissionTasks(), 1);
+    EXPECT_EQ(stealingQueue.getNumberOfInternalTasks(), 3);
+
+    while (stealingQueue.getNextTaskNonBlocking())
+    {
+    }
+    EXPECT_EQ(stealingQueue.getNumberOfAdmissionTasks(), 0);
+    EXPECT_EQ(stealingQueue.getNumberOfInternalTasks(), 0);
+}
+
+/// While both admission classes have tasks, the class with three times the weight receives three times as many reads.
+TEST_F(TaskQueueTest, WeightedAdmission)
+{
+    const TaskQueue<Task>::AdmissionClass light{.key = 1, .weight = 1};
+    const TaskQueue<Task>::AdmissionClass heavy{.key = 2, .weight = 3};
+    for (int i = 0; i < 20; ++i)
+    {
+        queue.addAdmissionTaskBlocking({}, light, Task{1, i, {}});
+    }
+    for (int i = 0; i < 15; ++i)
+    {
+        queue.addAdmissionTaskBlocking({}, heavy, Task{2, i, {}});
+    }
+
+    std::array<int, 3> nextSequenceNumber{};
+    for (int round = 0; round < 5; ++round)
+    {
+        std::array<int, 3> reads{};
+        for (int i = 0; i < 4; ++i)
+        {
+            auto task = queue.getNextTaskNonBlocking();
+            ASSERT_TRUE(task.has_value());
+            const auto key = std::get<0>(*task);
+            /// Tasks of the same class keep their order
+            EXPECT_EQ(std::get<1>(*task), nextSequenceNumber[key]++);
+            ++reads[key];
+        }
+        EXPECT_EQ(reads[1], 1);
+        EXPECT_EQ(reads[2], 3);
+    }
+
+    /// Once the heavy class is drained, the light class receives all reads
+    while (auto task = queue.getNextTaskNonBlocking())
+    {
+        EXPECT_EQ(std::get<0>(*task), 1);
+        EXPECT_EQ(std::get<1>(*task), nextSequenceNumber[1]++);
+    }
+    EXPECT_EQ(nextSequenceNumber[1], 20);
+    EXPECT_EQ(queue.getNumberOfAdmissionTasks(), 0);
+}
+
+/// A throttled admission class yields its turns to the other admission classes, but still gets read, once solely it has tasks
+TEST_F(TaskQueueTest, ThrottledAdmission)
+{
+    const TaskQueue<Task>::AdmissionClass throttled{.key = 1};
+    const TaskQueue<Task>::AdmissionClass other{.key = 2};
+    queue.setAdmissionClassThrottled(throttled.key, true);
+    for (int i = 0; i < 5; ++i)
+    {
+        queue.addAdmissionTaskBlocking({}, throttled, Task{1, i, {}});
+        queue.addAdmissionTaskBlocking({}, other, Task{2, i, {}});
+    }
+
+    std::array<int, 3> nextSequenceNumber{};
+    for (int i = 0; i < 5; ++i)
+    {
+        auto task = queue.getNextTaskNonBlocking();
+        ASSERT_TRUE(task.has_value());
+        EXPECT_EQ(std::get<0>(*task), 2);
+        EXPECT_EQ(std::get<1>(*task), nextSequenceNumber[2]++);
+    }
+    auto task = queue.getNextTaskNonBlocking();
+    ASSERT_TRUE(task.has_value());
+    EXPECT_EQ(std::get<0>(*task), 1);
+    EXPECT_EQ(std::get<1>(*task), nextSequenceNumber[1]++);
+
+    /// Once the throttling ends, the admission classes take turns again
+    queue.setAdmissionClassThrottled(throttled.key, false);
+    queue.addAdmissionTaskBlocking({}, other, Task{2, 5, {}});
+    std::array<int, 3> reads{};
+    for (int i = 0; i < 2; ++i)
+    {
+        task = queue.getNextTaskNonBlocking();
+        ASSERT_TRUE(task.has_value());
+        EXPECT_EQ(std::get<1>(*task), nextSequenceNumber[std::get<0>(*task)]++);
+        ++reads[std::get<0>(*task)];
+    }
+    EXPECT_EQ(reads[1], 1);
+    EXPECT_EQ(reads[2], 1);
+}
+
+/// A full admission class blocks only its own writers.
+TEST_F(TaskQueueTest, AdmissionBackpressurePerClass)
+{
+    const TaskQueue<Task>::AdmissionClass flooding{.key = 1};
+    for (size_t i = 0; i < queue.getAdmissionCapacity(); ++i)
+    {
+        queue.addAdmissionTaskBlocking({}, flooding, Task{1, static_cast<int>(i), {}});
+    }
+
+    std::stop_source stopFlooding;
+    std::atomic_bool floodingWriteReturned = false;
+    std::jthread floodingWriter(
+        [&]
+        {
+            EXPECT_FALSE(queue.addAdmissionTaskBlocking(stopFlooding.get_token(), flooding, Task{1, -1, {}}));
+            floodingWriteReturned = true;
+        });
+
+    EXPECT_TRUE(queue.addAdmissionTaskBlocking({}, TaskQueue<Task>::AdmissionClass{.key = 2}, Task{2, 0, {}}));
+    EXPECT_EQ(queue.getNumberOfAdmissionTasks(), queue.getAdmissionCapacity() + 1);
+    EXPECT_FALSE(floodingWriteReturned);
+
+    stopFlooding.request_stop();
+    floodingWriter.join();
+    EXPECT_TRUE(floodingWriteReturned);
+    EXPECT_EQ(queue.getNumberOfAdmissionTasks(), queue.getAdmissionCapacity() + 1);
+}
+
+/// A triggered stop token wakes up blocked reads and writes immediately, instead of after a polling interval
+TEST_F(TaskQueueTest, CancellationWakesUpBlockedCalls)
+{
+    TaskQueue<Task> stealingQueue{1, 2};
+    EXPECT_TRUE(stealingQueue.addAdmissionTaskBlocking({}, Task{0, 0, {}}));
+
+    std::stop_source stopSource;
+    std::vector<std::jthread> blocked;
+    blocked.emplace_back([&] { EXPECT_FALSE(queue.getNextTaskBlocking(stopSource.get_token()).has_value()); });
+    blocked.emplace_back([&] { EXPECT_FALSE(TaskQueue<Task>{1, 2}.getNextTaskBlocking(0, stopSource.get_token()).has_value()); });
+    blocked.emplace_back([&] { EXPECT_FALSE(stealingQueue.addAdmissionTaskBlocking(stopSource.get_token(), Task{0, 1, {}})); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    const auto stopStart = std::chrono::steady_clock::now();
+    stopSource.request_stop();
+    blocked.clear();
+    EXPECT_LT(std::chrono::steady_clock::now() - stopStart, std::chrono::milliseconds(50));
+}
+
+/// Same workload as the StressTest, but follow-up tasks are written into the local queues of the WorkerThreads.
+/// This ensures that no task is lost or duplicated while WorkerThreads concurrently steal from each other.
+TEST_F(TaskQueueTest, WorkStealingStressTest)
+{
+    constexpr int numberOfSources = 4;
+    constexpr int numberOfWorkerThreads = 12;
+    constexpr std::chrono::milliseconds testDuration{1000};
+
+    TaskQueue<Task> stealingQueue{100, numberOfWorkerThreads};
+    std::atomic tasksAdded{0};
+    ConsumedTasks<numberOfWorkerThreads> consumedTasks;
+    std::barrier syncBarrier{numberOfWorkerThreads + numberOfSources};
+
+    std::vector<std::jthread> sources;
+    sources.reserve(numberOfSources);
+    for (int sourceId = 0; sourceId < numberOfSources; ++sourceId)
+    {
+        sources.emplace_back(
+            [&, sourceId](const std::stop_token& stoken)
+            {
+                syncBarrier.arrive_and_wait();
+
+                int count = 0;
+                while (stealingQueue.addAdmissionTaskBlocking(stoken, Task{sourceId, count++, {}}))
+                {
+                }
+                tasksAdded.fetch_add(count - 1, std::memory_order::relaxed);
+            });
+    }
+
+    std::vector<std::jthread> worker;
+    worker.reserve(numberOfWorkerThreads);
+    for (int workerId = 0; workerId < numberOfWorkerThreads; ++workerId)
+    {
+        worker.emplace_back(
+            [&, workerId](const std::stop_token& stoken)
+            {
+                std::mt19937 rng(workerId);
+                std::uniform_int_distribution dist(0, 20);
+
+                syncBarrier.arrive_and_wait();
+
+                int count = 0;
+                while (!stoken.stop_requested())
+                {
+                    if (auto task = stealingQueue.getNextTaskBlocking(static_cast<size_t>(workerId), stoken))
+                    {
+                        /// Occasionally emit a burst of follow-up tasks to give idle peers something to steal
+                        const int followUpTasks = dist(rng) == 0 ? 100 : 0;
+                        for (int i = 0; i < followUpTasks; ++i)
+                        {
+                            stealingQueue.addLocalTaskNonBlocking(
+                                static_cast<size_t>(workerId), Task{workerId + numberOfSources, count++, {}});
+                        }
+                        consumedTasks.localCounters.at(workerId).add(*task);
+                    }
+                }
+                tasksAdded.fetch_add(count, std::memory_order::relaxed);
+            });
+    }
+
+    std::this_thread::sleep_for(testDuration);
+
+    sources.clear();
+    worker.clear();
+
+    while (auto task = stealingQueue.getNextTaskNonBlocking())
+    {
+        consumedTasks.localCounters.back().add(*task);
+    }
+
+    EXPECT_EQ(consumedTasks.size(), tasksAdded.load());
+    consumedTasks.verifyUnique();
+}
+
+/// Idle WorkerThreads of a spinning queue receive sporadically arriving tasks either while they spin or once they parked.
+/// Stopping a WorkerThread that spins or parks ends its wait.
+TEST_F(TaskQueueTest, SpinWhileIdle)
+{
+    constexpr int numberOfTasks = 100;
+    constexpr int numberOfWorkerThreads = 2;
+    TaskQueue<Task> spinningQueue{100, numberOfWorkerThreads, true};
+    std::atomic consumed{0};
+
+    std::vector<std::jthread> worker;
+    for (size_t workerId = 0; workerId < numberOfWorkerThreads; ++workerId)
+    {
+        worker.emplace_back(
+            [&, workerId](const std::stop_token& stoken)
+            {
+                while (spinningQueue.getNextTaskBlocking(workerId, stoken))
+                {
+                    consumed.fetch_add(1);
+                }
+            });
+    }
+
+    std::mt19937 rng(numberOfTasks);
+    std::uniform_int_distribution interArrivalTimeInUs(0, 200);
+    for (int i = 0; i < numberOfTasks; ++i)
+    {
+        ASSERT_TRUE(spinningQueue.addAdmissionTaskBlocking({}, Task{0, i, {}}));
+        std::this_thread::sleep_for(std::chrono::microseconds(interArrivalTimeInUs(rng)));
+    }
+    while (consumed.load() < numberOfTasks)
+    {
+        std::this_thread::yield();
+    }
+
+    worker.clear();
+    EXPECT_EQ(consumed.load(), numberOfTasks);
+    EXPECT_FALSE(spinningQueue.getNextTaskNonBlocking().has_value());
+}
+
+/// A batched read takes at most the requested number of tasks, and a batched write blocks on the bound of its admission class until
+/// all tasks fit, unless it gets canceled.
+TEST_F(TaskQueueTest, BatchedReadsAndWrites)
+{
+    std::vector<Task> tasks;
+    for (int i = 0; i < 5; ++i)
+    {
+        tasks.push_back(Task{0, i, {}});
+    }
+    queue.addInternalTasksNonBlocking(tasks);
+    EXPECT_EQ(queue.getNumberOfInternalTasks(), 5);
+
+    std::vector<Task> readTasks;
+    EXPECT_EQ(queue.getNextTasksBlocking(0, {}, 3, readTasks), 3);
+    EXPECT_EQ(queue.getNextTasksBlocking(0, {}, 3, readTasks), 2);
+    ASSERT_EQ(readTasks.size(), 5);
+    for (int i = 0; i < 5; ++i)
+    {
+        EXPECT_EQ(std::get<1>(readTasks[i]), i);
+    }
+
+    TaskQueue<Task> boundedQueue{2};
+    std::jthread writer(
+        [&]
+        {
+            std::vector<Task> admissionTasks;
+            for (int i = 0; i < 5; ++i)
+            {
+                admissionTasks.push_back(Task{1, i, {}});
+            }
+            EXPECT_EQ(boundedQueue.addAdmissionTasksBlocking({}, {}, admissionTasks), 5);
+        });
+    readTasks.clear();
+    while (readTasks.size() < 5)
+    {
+        boundedQueue.getNextTasksBlocking(0, {}, 5, readTasks);
+    }
+    writer.join();
+    for (int i = 0; i < 5; ++i)
+    {
+        EXPECT_EQ(std::get<1>(readTasks[i]), i);
+    }
+
+    std::stop_source stopSource;
+    std::vector<Task> admissionTasks(3);
+    std::jthread canceler(
+        [&]
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            stopSource.request_stop();
+        });
+    EXPECT_EQ(boundedQueue.addAdmissionTasksBlocking(stopSource.get_token(), {}, admissionTasks), 2);
+    EXPECT_EQ(boundedQueue.getNumberOfAdmissionTasks(), 2);
+}
+
 }
@@ -300,6 +300,9 @@ void TestingHarness::expectQueryStatusEvents(QueryId id, std::initializer_list<Q
             case QueryState::Registered:
                 EXPECT_CALL(*status, logQueryStatusChange(id, QueryState::Registered, ::testing::_)).Times(1);
                 break;
+            case QueryState::Compiling:
+                INVARIANT(false, "The query engine does not compile queries");
+                break;
             case QueryState::Started:
                 EXPECT_CALL(*status, logQueryStatusChange(id, QueryState::Started, ::testing::_))
                     .Times(1)
@@ -119,6 +119,8 @@ struct ExpectStats
     STAT_TYPE(TaskExecutionComplete);
     STAT_TYPE(TaskExpired);
     STAT_TYPE(TaskEmit);
+    STAT_TYPE(BufferCacheStatistic);
+    STAT_TYPE(BufferShed);
 
     explicit ExpectStats(std::shared_ptr<TestQueryStatisticListener> listener) : listener(std::move(listener))
     {
@@ -142,6 +144,10 @@ struct ExpectStats
             .WillRepeatedly(::testing::Invoke([](auto) { }));
         EXPECT_CALL(*this->listener, onEvent(::testing::VariantWith<NES::QueryFail>(::testing::_)))
             .WillRepeatedly(::testing::Invoke([](auto) { }));
+        EXPECT_CALL(*this->listener, onEvent(::testing::VariantWith<NES::BufferCacheStatistic>(::testing::_)))
+            .WillRepeatedly(::testing::Invoke([](auto) { }));
+        EXPECT_CALL(*this->listener, onEvent(::testing::VariantWith<NES::BufferShed>(::testing::_)))
+            .WillRepeatedly(::testing::Invoke([](auto) { }));
     }
 
     template <typename... Args>
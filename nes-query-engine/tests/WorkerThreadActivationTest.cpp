@@ -0,0 +1,117 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <WorkerThreadActivation.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <gtest/gtest.h>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+TEST(WorkerThreadActivationTest, StartsWithMinimum)
+{
+    WorkerThreadActivation activation{4, {.minimum = 2, .maximum = 4}};
+    EXPECT_EQ(activation.getNumberOfActiveWorkerThreads(), 2);
+
+    /// Active WorkerThreads do not block
+    EXPECT_TRUE(activation.awaitActivation(0, {}).has_value());
+    EXPECT_TRUE(activation.awaitActivation(1, {}).has_value());
+}
+
+TEST(WorkerThreadActivationTest, ActivateAndRetireWithinLimits)
+{
+    WorkerThreadActivation activation{3, {.minimum = 1, .maximum = 3}};
+    EXPECT_TRUE(activation.activateOne());
+    EXPECT_TRUE(activation.activateOne());
+    EXPECT_FALSE(activation.activateOne());
+    EXPECT_EQ(activation.getNumberOfActiveWorkerThreads(), 3);
+
+    EXPECT_TRUE(activation.retireOne());
+    EXPECT_TRUE(activation.retireOne());
+    EXPECT_FALSE(activation.retireOne());
+    EXPECT_EQ(activation.getNumberOfActiveWorkerThreads(), 1);
+}
+
+/// Retiring stops the activation of the active WorkerThread with the highest index
+TEST(WorkerThreadActivationTest, RetireStopsHighestWorkerThread)
+{
+    WorkerThreadActivation activation{2, {.minimum = 1, .maximum = 2}};
+    ASSERT_TRUE(activation.activateOne());
+    const auto first = activation.awaitActivation(0, {});
+    const auto second = activation.awaitActivation(1, {});
+    ASSERT_TRUE(first.has_value() && second.has_value());
+
+    ASSERT_TRUE(activation.retireOne());
+    EXPECT_FALSE(first->stop_requested());
+    EXPECT_TRUE(second->stop_requested());
+}
+
+TEST(WorkerThreadActivationTest, ParkedWorkerThreadWakesOnActivation)
+{
+    WorkerThreadActivation activation{2, {.minimum = 1, .maximum = 2}};
+    std::atomic_bool activated = false;
+    std::jthread parked(
+        [&]
+        {
+            EXPECT_TRUE(activation.awaitActivation(1, {}).has_value());
+            activated = true;
+        });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(activated);
+    ASSERT_TRUE(activation.activateOne());
+    parked.join();
+    EXPECT_TRUE(activated);
+}
+
+TEST(WorkerThreadActivationTest, ParkedWorkerThreadStops)
+{
+    WorkerThreadActivation activation{2, {.minimum = 1, .maximum = 2}};
+    std::stop_source stop;
+    std::jthread parked([&] { EXPECT_FALSE(activation.awaitActivation(1, stop.get_token()).has_value()); });
+    stop.request_stop();
+    parked.join();
+
+    /// A stopped WorkerThread is not activated again, even if it is active
+    EXPECT_FALSE(activation.awaitActivation(0, stop.get_token()).has_value());
+}
+
+TEST(WorkerThreadActivationTest, SetLimits)
+{
+    WorkerThreadActivation activation{4, {.minimum = 4, .maximum = 4}};
+    const auto last = activation.awaitActivation(3, {});
+    ASSERT_TRUE(last.has_value());
+
+    activation.setLimits({.minimum = 1, .maximum = 2});
+    EXPECT_EQ(activation.getNumberOfActiveWorkerThreads(), 2);
+    EXPECT_TRUE(last->stop_requested());
+
+    activation.setLimits({.minimum = 3, .maximum = 4});
+    EXPECT_EQ(activation.getNumberOfActiveWorkerThreads(), 3);
+
+    EXPECT_THROW(activation.setLimits({.minimum = 0, .maximum = 2}), Exception);
+    EXPECT_THROW(activation.setLimits({.minimum = 3, .maximum = 2}), Exception);
+    EXPECT_THROW(activation.setLimits({.minimum = 1, .maximum = 5}), Exception);
+    EXPECT_EQ(activation.getLimits().minimum, 3);
+    EXPECT_EQ(activation.getLimits().maximum, 4);
+}
+
+}
@@ -0,0 +1,45 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <DataTypes/Schema.hpp>
+#include <Functions/LogicalFunction.hpp>
+
+namespace NES
+{
+
+/// A band predicate restricts the attribute of the right join side to one side (or both sides) of the attribute of the left join side,
+/// e.g., `left.ts <= right.ts` or `left.a = right.b`. The sort-merge join sorts both sides of a window by these attributes, thus, it only
+/// has to evaluate the join function for the right tuples whose attribute lies within the band of the left attribute.
+/// BETWEEN predicates, e.g., `left.ts BETWEEN right.start AND right.end`, consist of a conjunction of two comparisons. One of them serves
+/// as the band predicate and the other one is evaluated as part of the join function.
+struct BandJoinPredicate
+{
+    std::string leftFieldName;
+    std::string rightFieldName;
+    /// The join function can only be true, if right >= left (lower bound) and / or right <= left (upper bound)
+    bool rightIsLowerBoundedByLeft;
+    bool rightIsUpperBoundedByLeft;
+
+    /// Searches the top-level conjunctions of the join function for comparisons (<, <=, >, >=, =) between a non-nullable numeric field
+    /// of the left and a non-nullable numeric field of the right schema. Comparisons of the same fields are combined, and we prefer
+    /// fields that are bounded on both sides, as the band is narrower. Returns nullopt, if the join function contains no such comparison.
+    static std::optional<BandJoinPredicate>
+    tryCreate(const LogicalFunction& joinFunction, const Schema& leftSchema, const Schema& rightSchema);
+};
+
+}
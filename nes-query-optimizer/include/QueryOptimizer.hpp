@@ -14,11 +14,15 @@
 
 #pragma once
 
+#include <memory>
 #include <utility>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
 #include <Plans/LogicalPlan.hpp>
 #include <OptimizedPlan.hpp>
 
 #include <QueryOptimizerConfiguration.hpp>
+#include <SourceStatistics.hpp>
 
 namespace NES
 {
@@ -26,15 +30,25 @@ namespace NES
 class QueryOptimizer final
 {
 public:
-    explicit QueryOptimizer(QueryOptimizerConfiguration defaultQueryOptimization)
-        : defaultQueryOptimization(std::move(defaultQueryOptimization)) { };
+    /// The source statistics are optional and improve the cost-based decisions, e.g., of the join implementation
+    explicit QueryOptimizer(
+        QueryOptimizerConfiguration defaultQueryOptimization, std::shared_ptr<const SourceStatistics> sourceStatistics = nullptr)
+        : defaultQueryOptimization(std::move(defaultQueryOptimization)), sourceStatistics(std::move(sourceStatistics)) { };
 
     /// Takes the query plan as a logical plan and returns a fully physical plan
     [[nodiscard]] OptimizedPlan optimize(const LogicalPlan& plan) const;
-    [[nodiscard]] static OptimizedPlan optimize(const LogicalPlan& plan, const QueryOptimizerConfiguration& defaultQueryOptimization);
+    [[nodiscard]] static OptimizedPlan optimize(
+        const LogicalPlan& plan,
+        const QueryOptimizerConfiguration& defaultQueryOptimization,
+        std::shared_ptr<const SourceStatistics> sourceStatistics = nullptr);
+
+    /// Optimizes the plans of multiple queries and merges them into a single plan with one sink per query. The queries share their
+    /// equal sources and the equal operators on top of them, thus the merged query ingests a source that multiple queries read once.
+    [[nodiscard]] OptimizedPlan optimizeMerged(QueryId mergedQueryId, const std::vector<LogicalPlan>& plans) const;
 
 private:
     QueryOptimizerConfiguration defaultQueryOptimization;
+    std::shared_ptr<const SourceStatistics> sourceStatistics;
 };
 
 }
@@ -0,0 +1,47 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <Plans/LogicalPlan.hpp>
+#include <SourceStatistics.hpp>
+
+namespace NES
+{
+
+/// Resources that a query is expected to occupy while it runs
+struct QueryResourceEstimate
+{
+    /// Bytes of the slices of the windowed aggregations and joins of the query that are alive at the same time
+    double stateSizeInBytes;
+    /// Number of worker threads that the query keeps busy, e.g., 0.5 for half of the time of a single worker thread
+    double busyWorkerThreads;
+};
+
+/// Estimates the resources of an optimized plan from the observed rates of its sources, so that the worker can decide whether to admit
+/// a query before it competes with the running queries for the buffer pool and the worker threads.
+/// - A join keeps all tuples of a window, i.e., the rate of each input times the window size times the width of the input.
+/// - An aggregation keeps one entry per group and slice, i.e., at most the tuples of a slice, and at most as many entries as the key
+///   domain allows.
+/// - Every operator costs a constant time per tuple of the sources below the operator.
+/// Without an observed rate, we assume JoinCostModel::DEFAULT_TUPLES_PER_WINDOW tuples per window and neglect the cpu time.
+struct QueryResourceEstimator
+{
+    /// Time that an operator takes to process a tuple, which is in the order of the time per tuple of a compiled pipeline
+    static constexpr double NANOSECONDS_PER_TUPLE_AND_OPERATOR = 20;
+
+    [[nodiscard]] static QueryResourceEstimate estimate(const LogicalPlan& plan, const SourceStatistics* sourceStatistics);
+};
+
+}
@@ -0,0 +1,40 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <Sources/ColumnStatistics.hpp>
+
+namespace NES
+{
+
+/// Statistics about the logical sources that are observed while queries are running.
+/// The query optimizer uses them to estimate the sizes of the join inputs, e.g., to choose the join implementation.
+class SourceStatistics
+{
+public:
+    virtual ~SourceStatistics() = default;
+
+    /// Returns the number of tuples per second that the logical source produced in the past, or nullopt, if we did not observe it yet.
+    /// This function is called concurrently by the query registration threads and has to be thread-safe.
+    [[nodiscard]] virtual std::optional<double> getTuplesPerSecond(const std::string& logicalSourceName) const = 0;
+
+    /// Returns the statistics of the values of a (qualified) source field, or nullopt, if the sources did not sample the field yet.
+    /// This function is called concurrently by the query registration threads and has to be thread-safe.
+    [[nodiscard]] virtual std::optional<ColumnStatistics> getColumnStatistics(const std::string&) const { return std::nullopt; }
+};
+
+}
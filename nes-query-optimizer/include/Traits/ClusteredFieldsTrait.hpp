@@ -0,0 +1,76 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <vector>
+#include <Traits/Trait.hpp>
+#include <Util/PlanRenderer.hpp>
+#include <Util/Reflection.hpp>
+
+namespace NES
+{
+
+/// Struct that stores the fields, whose equal values the tuple buffers that an operator emits contain in runs, e.g., the per-device batches
+/// of a source (see PropagateClusteredFields). Consumers that group by these fields find the records of a group next to each other.
+struct ClusteredFieldsTrait final
+{
+    static constexpr std::string_view NAME = "ClusteredFields";
+    std::vector<std::string> fieldNames;
+
+    explicit ClusteredFieldsTrait(std::vector<std::string> fieldNames);
+
+    [[nodiscard]] const std::type_info& getType() const;
+
+    bool operator==(const ClusteredFieldsTrait& other) const;
+
+    [[nodiscard]] size_t hash() const;
+
+    [[nodiscard]] std::string explain(ExplainVerbosity) const;
+
+    [[nodiscard]] std::string_view getName() const;
+
+    /// Returns true, if the runs of equal values of the fields are also runs of equal values of the given fields
+    [[nodiscard]] bool clusters(const std::vector<std::string>& otherFieldNames) const;
+
+    friend Reflector<ClusteredFieldsTrait>;
+};
+
+template <>
+struct Reflector<ClusteredFieldsTrait>
+{
+    Reflected operator()(const ClusteredFieldsTrait& trait) const;
+};
+
+template <>
+struct Unreflector<ClusteredFieldsTrait>
+{
+    ClusteredFieldsTrait operator()(const Reflected& reflected) const;
+};
+
+static_assert(TraitConcept<ClusteredFieldsTrait>);
+
+}
+
+namespace NES::detail
+{
+struct ReflectedClusteredFieldsTrait
+{
+    std::vector<std::string> fieldNames;
+};
+}
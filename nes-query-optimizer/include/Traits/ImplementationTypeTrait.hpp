@@ -29,16 +29,30 @@ enum class JoinImplementation : uint8_t
 {
     NESTED_LOOP_JOIN,
     HASH_JOIN,
+    SORT_MERGE_JOIN,
     CHOICELESS
 };
 
-/// Struct that stores the join implementation type as traits. For now, we simply have a choice/implementation type for the joins (Hash-Join vs. NLJ)
+/// Sides of a hash join that are built into hash maps. If only one side is hashed, the tuples of the other side are buffered in paged
+/// vectors and streamed through the hash maps of the hashed side, once their window triggers.
+enum class HashJoinBuildSide : uint8_t
+{
+    BOTH,
+    LEFT,
+    RIGHT
+};
+
+/// Struct that stores the join implementation type as traits.
+/// For now, we simply have a choice/implementation type for the joins (Hash-Join vs. NLJ vs. Sort-Merge-Join)
+/// For a hash join, the trait additionally stores which sides are hashed.
 struct JoinImplementationTypeTrait final
 {
     static constexpr std::string_view NAME = "JoinImplementationType";
     JoinImplementation implementationType;
+    HashJoinBuildSide hashJoinBuildSide;
 
-    explicit JoinImplementationTypeTrait(JoinImplementation implementationType);
+    explicit JoinImplementationTypeTrait(
+        JoinImplementation implementationType, HashJoinBuildSide hashJoinBuildSide = HashJoinBuildSide::BOTH);
 
     [[nodiscard]] const std::type_info& getType() const;
 
@@ -73,5 +87,6 @@ namespace NES::detail
 struct ReflectedImplementationTypeTrait
 {
     JoinImplementation joinImplementationType;
+    HashJoinBuildSide hashJoinBuildSide;
 };
 }
@@ -0,0 +1,73 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <Traits/Trait.hpp>
+#include <Util/PlanRenderer.hpp>
+#include <Util/Reflection.hpp>
+
+namespace NES
+{
+
+/// The number of bytes that the optimizer expects a join to keep per slice, i.e., the tuples of both join sides that it stores until it
+/// triggers the windows of the slice. The join ordering minimizes the sum of these estimates over all joins of a query.
+struct JoinStateEstimateTrait final
+{
+    static constexpr std::string_view NAME = "JoinStateEstimate";
+    uint64_t bytesPerSlice;
+
+    explicit JoinStateEstimateTrait(uint64_t bytesPerSlice);
+
+    [[nodiscard]] const std::type_info& getType() const;
+
+    bool operator==(const JoinStateEstimateTrait& other) const;
+
+    [[nodiscard]] size_t hash() const;
+
+    [[nodiscard]] std::string explain(ExplainVerbosity) const;
+
+    [[nodiscard]] std::string_view getName() const;
+
+    friend Reflector<JoinStateEstimateTrait>;
+};
+
+template <>
+struct Reflector<JoinStateEstimateTrait>
+{
+    Reflected operator()(const JoinStateEstimateTrait& trait) const;
+};
+
+template <>
+struct Unreflector<JoinStateEstimateTrait>
+{
+    JoinStateEstimateTrait operator()(const Reflected& reflected) const;
+};
+
+static_assert(TraitConcept<JoinStateEstimateTrait>);
+
+}
+
+namespace NES::detail
+{
+struct ReflectedJoinStateEstimateTrait
+{
+    uint64_t bytesPerSlice = 0;
+};
+}
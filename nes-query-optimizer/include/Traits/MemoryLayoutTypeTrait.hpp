@@ -26,7 +26,7 @@
 namespace NES
 {
 
-/// Struct that stores the memory layout type as traits. For now, we simply choose a row layout all the time
+/// Struct that stores the memory layout type of the tuple buffers that an operator emits as traits (see DecideMemoryLayout)
 struct MemoryLayoutTypeTrait final
 {
     static constexpr std::string_view NAME = "MemoryLayoutType";
@@ -0,0 +1,74 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <vector>
+#include <Traits/Trait.hpp>
+#include <Util/PlanRenderer.hpp>
+#include <Util/Reflection.hpp>
+
+namespace NES
+{
+
+/// Marks a windowed aggregation over tumbling windows that computes the windows of all the given sizes (in the unit of its time
+/// characteristic) from the same slices. The aggregation emits the windows of all sizes, thus each consumer has to select its size.
+struct SharedWindowSizesTrait final
+{
+    static constexpr std::string_view NAME = "SharedWindowSizes";
+    std::vector<uint64_t> windowSizes;
+
+    explicit SharedWindowSizesTrait(std::vector<uint64_t> windowSizes);
+
+    [[nodiscard]] const std::type_info& getType() const;
+
+    bool operator==(const SharedWindowSizesTrait& other) const;
+
+    [[nodiscard]] size_t hash() const;
+
+    [[nodiscard]] std::string explain(ExplainVerbosity) const;
+
+    [[nodiscard]] std::string_view getName() const;
+
+    friend Reflector<SharedWindowSizesTrait>;
+};
+
+template <>
+struct Reflector<SharedWindowSizesTrait>
+{
+    Reflected operator()(const SharedWindowSizesTrait& trait) const;
+};
+
+template <>
+struct Unreflector<SharedWindowSizesTrait>
+{
+    SharedWindowSizesTrait operator()(const Reflected& reflected) const;
+};
+
+static_assert(TraitConcept<SharedWindowSizesTrait>);
+
+}
+
+namespace NES::detail
+{
+struct ReflectedSharedWindowSizesTrait
+{
+    std::vector<uint64_t> windowSizes;
+};
+}
@@ -28,6 +28,16 @@ enum class StreamJoinStrategy : uint8_t
 {
     NESTED_LOOP_JOIN,
     HASH_JOIN,
+    SORT_MERGE_JOIN,
+    OPTIMIZER_CHOOSES
+};
+
+/// Sides of a hash join that are built into hash maps. The other side is streamed through the hash maps, once a window triggers.
+enum class HashJoinBuildSideStrategy : uint8_t
+{
+    BOTH,
+    LEFT,
+    RIGHT,
     OPTIMIZER_CHOOSES
 };
 
@@ -41,10 +51,16 @@ public:
         = {"join_strategy",
            StreamJoinStrategy::OPTIMIZER_CHOOSES,
            "Join Strategy"
-           "[NESTED_LOOP_JOIN|HASH_JOIN|OPTIMIZER_CHOOSES]."};
+           "[NESTED_LOOP_JOIN|HASH_JOIN|SORT_MERGE_JOIN|OPTIMIZER_CHOOSES]."};
+    EnumOption<HashJoinBuildSideStrategy> hashJoinBuildSide
+        = {"hash_join_build_side",
+           HashJoinBuildSideStrategy::OPTIMIZER_CHOOSES,
+           "Sides of a hash join that are built into hash maps. The optimizer hashes only the smaller side, if the observed rates of the "
+           "sources show that it is much smaller than the other side "
+           "[BOTH|LEFT|RIGHT|OPTIMIZER_CHOOSES]."};
 
 private:
-    std::vector<BaseOption*> getOptions() override { return {&joinStrategy}; }
+    std::vector<BaseOption*> getOptions() override { return {&joinStrategy, &hashJoinBuildSide}; }
 };
 
 }
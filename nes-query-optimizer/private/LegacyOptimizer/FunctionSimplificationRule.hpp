@@ -0,0 +1,36 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <Plans/LogicalPlan.hpp>
+
+namespace NES
+{
+
+/**
+ * @brief This rule simplifies the functions of selections and projections, so that the pipelines evaluate fewer functions per tuple.
+ * It
+ *  - folds functions of constants into a constant, i.e., boolean logic, comparisons of integers, and integer arithmetic that does not
+ *    overflow its result type,
+ *  - merges adjacent selections into a single selection and removes duplicate conjunctions,
+ *  - replaces the subexpressions of a selection, which the projection below it already computes, by an access to the computed field.
+ * The rule requires an inferred plan and leaves the rewritten operators without inferred schemas.
+ */
+class FunctionSimplificationRule
+{
+public:
+    void apply(LogicalPlan& queryPlan) const; ///NOLINT(readability-convert-member-functions-to-static)
+};
+}
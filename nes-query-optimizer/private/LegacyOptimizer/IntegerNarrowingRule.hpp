@@ -0,0 +1,39 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <Plans/LogicalPlan.hpp>
+
+namespace NES
+{
+
+/**
+ * @brief This rule keeps the integer operands of comparisons narrow, so that the pipelines compare narrow fields with constants of the
+ * same type, e.g., in the vectorized filters, which require the field and the constant to agree on signedness.
+ * A range analysis derives the interval of the values of each integer function from the types of the fields, from constants, and from
+ * additions, subtractions, and multiplications that do not overflow their inferred type. As a comparison only exposes a boolean, the
+ * rule may change the types below it, as long as every value stays the same. Thus, below a comparison, the rule
+ *  - removes the casts that preserve every value of their operand,
+ *  - converts integer constants into the type of the other operand, if the constant fits and the arithmetic does not overflow,
+ *  - replaces comparisons of non-nullable operands, whose ranges decide the result, by a constant.
+ * Any other function keeps its type, as the types of the fields that the projections compute are visible to the downstream operators.
+ * The rule requires an inferred plan and leaves the rewritten operators without inferred schemas.
+ */
+class IntegerNarrowingRule
+{
+public:
+    void apply(LogicalPlan& queryPlan) const; ///NOLINT(readability-convert-member-functions-to-static)
+};
+}
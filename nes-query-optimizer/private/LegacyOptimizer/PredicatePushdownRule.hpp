@@ -0,0 +1,36 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <Plans/LogicalPlan.hpp>
+
+namespace NES
+{
+
+/**
+ * @brief This rule moves selections towards the sources, so that unions, joins, and projections process fewer tuples.
+ * It splits the predicate of a selection into its conjunctions and pushes each conjunction below
+ *  - a union, if every input of the union contains the accessed fields, by duplicating it for every input,
+ *  - a join, if all accessed fields stem from the same side of the join,
+ *  - a projection, if the projection only forwards or renames the accessed fields.
+ * Conjunctions that cannot be pushed further remain in a selection above the operator that blocks them.
+ * The rule requires an inferred plan and leaves the pushed selections without inferred schemas.
+ */
+class PredicatePushdownRule
+{
+public:
+    void apply(LogicalPlan& queryPlan) const; ///NOLINT(readability-convert-member-functions-to-static)
+};
+}
@@ -0,0 +1,39 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <Plans/LogicalPlan.hpp>
+
+namespace NES
+{
+
+/**
+ * @brief This rule narrows the sources to the fields that the query reads, so that the input formatters only parse these fields and
+ * the buffers behind the sources only carry these fields.
+ * It collects the fields that the operators above a source read and inserts a projection on these fields above the source.
+ * Lowering fuses such a projection into the scan of the source, which hands the projected fields to the input formatter.
+ * On its way down, the rule also drops the fields that a projection computes, but that no operator above it reads.
+ * The rule does not narrow a source
+ *  - that is already the child of a projection, since the scan of the projection formats only the accessed fields,
+ *  - if an operator above the source reads all fields, e.g., a sink, or if the query reads all fields of the source,
+ *  - below a union, if narrowing would result in different schemas of the inputs of the union.
+ * The rule requires an inferred plan and infers the operators that it rewrites.
+ */
+class ProjectionPushdownRule
+{
+public:
+    void apply(LogicalPlan& queryPlan) const; ///NOLINT(readability-convert-member-functions-to-static)
+};
+}
@@ -13,23 +13,47 @@
 */
 
 #pragma once
+#include <memory>
+#include <optional>
+#include <utility>
+#include <Operators/LogicalOperator.hpp>
+#include <Operators/Windows/JoinLogicalOperator.hpp>
+#include <Phases/BandJoinPredicate.hpp>
 #include <Plans/LogicalPlan.hpp>
+#include <Traits/ImplementationTypeTrait.hpp>
 
 #include <QueryOptimizerConfiguration.hpp>
+#include <SourceStatistics.hpp>
 
 namespace NES
 {
 
-/// Decides what join implementation should be used. For now, we support HashJoin or a NestedLoopJoin
+/// Decides what join implementation should be used. For now, we support HashJoin, SortMergeJoin or a NestedLoopJoin
+/// If the optimizer chooses the join strategy, we decide for every join independently via the JoinCostModel. The model estimates the number
+/// of tuples per window from the window size and the observed rates of the sources below each join side (see SourceStatistics).
+/// For a hash join, we additionally decide which sides are hashed. If the optimizer chooses, we hash only the smaller side, if the
+/// observed rates show that it is much smaller than the other side.
 class DecideJoinTypes
 {
 public:
-    explicit DecideJoinTypes(const StreamJoinStrategy joinStrategy) : joinStrategy(joinStrategy) { }
+    explicit DecideJoinTypes(
+        const StreamJoinStrategy joinStrategy,
+        std::shared_ptr<const SourceStatistics> sourceStatistics = nullptr,
+        const HashJoinBuildSideStrategy hashJoinBuildSideStrategy = HashJoinBuildSideStrategy::OPTIMIZER_CHOOSES)
+        : joinStrategy(joinStrategy), hashJoinBuildSideStrategy(hashJoinBuildSideStrategy), sourceStatistics(std::move(sourceStatistics))
+    {
+    }
 
     LogicalPlan apply(const LogicalPlan& queryPlan);
 
 private:
     LogicalOperator apply(const LogicalOperator& logicalOperator);
+    [[nodiscard]] JoinImplementation chooseCheapestJoinImplementation(
+        const JoinLogicalOperator& joinOperator, const std::optional<BandJoinPredicate>& bandJoinPredicate) const;
+    [[nodiscard]] JoinImplementationTypeTrait createHashJoinTrait(const JoinLogicalOperator& joinOperator) const;
+
     StreamJoinStrategy joinStrategy;
+    HashJoinBuildSideStrategy hashJoinBuildSideStrategy;
+    std::shared_ptr<const SourceStatistics> sourceStatistics;
 };
 }
@@ -13,20 +13,28 @@
 */
 
 #pragma once
+#include <Nautilus/Interface/BufferRef/LowerSchemaProvider.hpp>
 #include <Operators/LogicalOperator.hpp>
 #include <Plans/LogicalPlan.hpp>
 
 namespace NES
 {
 
-/// Decides what memory layout should be used per operator. For now, we use row-layout across all operators.
+/// Decides the memory layout of the tuple buffers that an operator emits and of the tuples that it keeps in its state.
+/// The layout follows what the consumer of the operator reads: consumers that access only a few fields of their input, e.g., selective
+/// scans and aggregations, prefer a columnar layout, as they only load the columns of the accessed fields. Consumers that read whole
+/// tuples, e.g., joins and sinks, prefer a row layout. The emit of a pipeline writes the layout that the scan of the next pipeline reads,
+/// thus the layout only changes at the boundaries of pipelines and does not require additional conversion operators.
 class DecideMemoryLayout
 {
 public:
+    /// A consumer prefers a columnar layout, if it accesses at most this share of the fields of its input
+    static constexpr double MAX_SHARE_OF_ACCESSED_FIELDS_FOR_COLUMNAR_LAYOUT = 0.5;
+
     LogicalPlan apply(const LogicalPlan& queryPlan);
 
 private:
-    LogicalOperator apply(const LogicalOperator& logicalOperator);
+    LogicalOperator apply(const LogicalOperator& logicalOperator, MemoryLayoutType preferredMemoryLayout);
 };
 
 }
@@ -0,0 +1,100 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <DataTypes/DataType.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Phases/BandJoinPredicate.hpp>
+#include <Traits/ImplementationTypeTrait.hpp>
+#include <SourceStatistics.hpp>
+
+namespace NES
+{
+
+/// What we know about one side of a join within a single window
+struct JoinInputEstimate
+{
+    double tuplesPerWindow;
+    double tupleSizeInBytes;
+    /// Number of distinct values of the join keys within a window, i.e., at most tuplesPerWindow
+    double distinctKeys;
+};
+
+/// Estimated costs of the join implementations that are able to evaluate a join function for a single window.
+/// The costs are relative, i.e., in units of comparing a pair of tuples that fit into a cache line, and only serve to rank the
+/// implementations against each other.
+struct JoinCostEstimate
+{
+    double nestedLoopJoin;
+    std::optional<double> hashJoin;
+    std::optional<double> sortMergeJoin;
+
+    /// Returns the implementation with the lowest estimated costs.
+    /// Ties are resolved in favor of the hash join and then the sort-merge join.
+    [[nodiscard]] JoinImplementation getCheapest() const;
+    [[nodiscard]] std::string explain() const;
+};
+
+/// Cost model that drives the choice of the join implementation, if the optimizer chooses the join strategy.
+/// - The NLJ compares all pairs of tuples and reads both tuples of each pair. Thus, it is cheapest for small windows.
+/// - The hash join pays for hashing every tuple and for setting up the hash maps of a window but only compares the tuples with the same
+///   hash. With few distinct keys, the hash join degenerates to a NLJ.
+/// - The sort-merge join pays for sorting both sides, but only compares the tuples within the band of the BandJoinPredicate. For
+///   one-sided bands, e.g., `left.ts < right.ts`, we expect half of all pairs to lie within the band.
+struct JoinCostModel
+{
+    /// Number of tuples per window that we assume for join inputs without observed rates
+    static constexpr double DEFAULT_TUPLES_PER_WINDOW = 10000;
+
+    static constexpr double COMPARISON_COST = 1;
+    /// Reading a tuple from a paged vector costs this much per cache line of the tuple
+    static constexpr double CACHE_LINE_COST = 0.5;
+    static constexpr double CACHE_LINE_SIZE = 64;
+    static constexpr double HASH_COST = 4;
+    /// Setting up, merging, and cleaning up the hash maps of one window
+    static constexpr double HASH_MAP_COST = 2048;
+    /// Writing the (key, position) entry of a tuple before sorting
+    static constexpr double SORT_ENTRY_COST = 2;
+    /// Share of the pairs of tuples that satisfy a comparison other than an equality, e.g., a one-sided band
+    static constexpr double NON_EQUI_SELECTIVITY = 0.5;
+    /// A hash join only hashes the smaller side, if the other side has more than this factor times its tuples per window
+    static constexpr double ASYMMETRIC_HASH_JOIN_FACTOR = 10;
+
+    /// hashJoinIsApplicable is false, if the join function can not be evaluated by a hash join.
+    /// bandJoinPredicate is nullopt, if the join function can not be evaluated by a sort-merge join.
+    [[nodiscard]] static JoinCostEstimate estimate(
+        const JoinInputEstimate& left,
+        const JoinInputEstimate& right,
+        bool hashJoinIsApplicable,
+        const std::optional<BandJoinPredicate>& bandJoinPredicate);
+
+    /// A join keeps all tuples of both sides of a slice until it triggers the windows of the slice
+    [[nodiscard]] static double estimateStatePerSlice(const JoinInputEstimate& left, const JoinInputEstimate& right);
+
+    /// Buffering the tuples of the larger side in paged vectors costs neither hashing nor hash map entries. Instead, the probe streams them
+    /// through the hash maps of the smaller side. Thus, we hash only the smaller side, if it is much smaller than the larger side.
+    [[nodiscard]] static HashJoinBuildSide chooseHashJoinBuildSide(double leftTuplesPerSecond, double rightTuplesPerSecond);
+
+    /// Sums up the observed rates of all sources below the join input. Returns nullopt, if we lack the rate of any of these sources.
+    [[nodiscard]] static std::optional<double>
+    getTuplesPerSecond(const LogicalOperator& joinInput, const SourceStatistics& sourceStatistics);
+
+    /// Number of distinct values of the data type, or infinity, if a window will rarely contain all of them
+    [[nodiscard]] static double getDomainSize(const DataType& dataType);
+};
+
+}
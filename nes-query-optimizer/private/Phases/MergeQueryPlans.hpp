@@ -0,0 +1,46 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <unordered_set>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Plans/LogicalPlan.hpp>
+
+namespace NES
+{
+
+/// Merges the (optimized) plans of multiple queries into a single plan with one root per query. Equal operators that read from the same
+/// children, starting with equal sources, become a single operator of the merged plan. Thus, the merged plan is a DAG, in which the
+/// queries share their sources and their common operator prefixes. The sinks of the queries are never shared.
+/// Aggregations over tumbling windows that differ only in their window size, and read from the same child, become a single aggregation
+/// that computes the windows of all sizes from the same slices. Above it, a selection per query keeps the windows of the query's size.
+/// The merged plan must not be rewritten, as the lowering of the plan identifies the shared operators by their ids.
+class MergeQueryPlans
+{
+public:
+    LogicalPlan apply(QueryId mergedQueryId, const std::vector<LogicalPlan>& queryPlans);
+
+private:
+    LogicalOperator merge(const LogicalOperator& logicalOperator);
+
+    /// All operators (but the sinks) of the merged plan
+    std::vector<LogicalOperator> mergedOperators;
+    /// A query does not share an operator with itself, e.g., the two equal sources of a self-join remain separate operators
+    std::unordered_set<OperatorId> operatorsOfCurrentQuery;
+};
+
+}
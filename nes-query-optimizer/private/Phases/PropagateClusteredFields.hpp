@@ -0,0 +1,36 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <Operators/LogicalOperator.hpp>
+#include <Plans/LogicalPlan.hpp>
+
+namespace NES
+{
+
+/// Propagates the clustering that a source declares (see SourceDescriptor::CLUSTERED_BY) to the operators above it as ClusteredFieldsTrait.
+/// Operators that forward the order of their input, i.e., selections, samples, and watermark assigners, keep the clustered fields.
+/// Projections keep the clustered fields that they forward unchanged, under their new names. All other operators, e.g., unions that
+/// interleave their children, and windowed operators that emit their own records, end the clustering.
+class PropagateClusteredFields
+{
+public:
+    LogicalPlan apply(const LogicalPlan& queryPlan);
+
+private:
+    LogicalOperator apply(const LogicalOperator& logicalOperator);
+};
+
+}
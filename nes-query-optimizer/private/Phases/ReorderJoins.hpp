@@ -0,0 +1,54 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <Operators/LogicalOperator.hpp>
+#include <Plans/LogicalPlan.hpp>
+
+#include <SourceStatistics.hpp>
+
+namespace NES
+{
+
+/// Reorders the inputs of consecutive inner joins over the same tumbling event-time windows, e.g., `(a JOIN b) JOIN c`, which the parser
+/// nests in the order of the query. Of all left-deep and bushy orders, in which every join has a join predicate, the phase chooses the
+/// order with the smallest sum of the estimated states per slice of its joins, i.e., it avoids large intermediate results.
+/// - The tuples per slice of an input follow from the observed rates of its sources (see SourceStatistics) and the size of the slices.
+/// - An equality predicate selects one out of the distinct keys of a slice, all other predicates select half of the pairs.
+/// Tumbling windows only join the tuples of the same window, thus the order does not change the joined tuples. A projection above the
+/// reordered joins restores the fields of the original order, including the window fields of all joins that the query wrote.
+/// In addition, the phase annotates every join with its estimated state per slice (see JoinStateEstimateTrait).
+class ReorderJoins
+{
+public:
+    /// Enumerating all orders grows exponentially with the number of inputs, thus we reorder larger nests of joins in parts
+    static constexpr size_t MAX_REORDERED_JOIN_INPUTS = 10;
+
+    explicit ReorderJoins(std::shared_ptr<const SourceStatistics> sourceStatistics = nullptr)
+        : sourceStatistics(std::move(sourceStatistics))
+    {
+    }
+
+    [[nodiscard]] LogicalPlan apply(const LogicalPlan& queryPlan) const;
+
+private:
+    [[nodiscard]] LogicalOperator apply(const LogicalOperator& logicalOperator) const;
+
+    std::shared_ptr<const SourceStatistics> sourceStatistics;
+};
+}
@@ -0,0 +1,385 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <LegacyOptimizer/FunctionSimplificationRule.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <Functions/ArithmeticalFunctions/AddLogicalFunction.hpp>
+#include <Functions/ArithmeticalFunctions/DivLogicalFunction.hpp>
+#include <Functions/ArithmeticalFunctions/ModuloLogicalFunction.hpp>
+#include <Functions/ArithmeticalFunctions/MulLogicalFunction.hpp>
+#include <Functions/ArithmeticalFunctions/SubLogicalFunction.hpp>
+#include <Functions/BooleanFunctions/AndLogicalFunction.hpp>
+#include <Functions/BooleanFunctions/EqualsLogicalFunction.hpp>
+#include <Functions/BooleanFunctions/NegateLogicalFunction.hpp>
+#include <Functions/BooleanFunctions/OrLogicalFunction.hpp>
+#include <Functions/ComparisonFunctions/GreaterEqualsLogicalFunction.hpp>
+#include <Functions/ComparisonFunctions/GreaterLogicalFunction.hpp>
+#include <Functions/ComparisonFunctions/LessEqualsLogicalFunction.hpp>
+#include <Functions/ComparisonFunctions/LessLogicalFunction.hpp>
+#include <Functions/ConstantValueLogicalFunction.hpp>
+#include <Functions/FieldAccessLogicalFunction.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Iterators/BFSIterator.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Operators/ProjectionLogicalOperator.hpp>
+#include <Operators/SelectionLogicalOperator.hpp>
+#include <Plans/LogicalPlan.hpp>
+#include <Traits/TraitSet.hpp>
+#include <Util/Strings.hpp>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+namespace
+{
+/// Wide enough to compute the exact result of the arithmetic of two 64-bit integers, except for the product of two large integers,
+/// which the overflow check of the multiplication catches
+using WideInteger = __int128;
+
+struct IntegerConstant
+{
+    WideInteger value;
+    bool isSigned;
+};
+
+std::optional<IntegerConstant> getIntegerConstant(const LogicalFunction& function)
+{
+    const auto constant = function.tryGetAs<ConstantValueLogicalFunction>();
+    const auto dataType = function.getDataType();
+    if (not constant.has_value() or not dataType.isInteger())
+    {
+        return std::nullopt;
+    }
+    const auto constantValue = constant.value()->getConstantValue();
+    if (dataType.isSignedInteger())
+    {
+        return from_chars<int64_t>(constantValue).transform([](const int64_t value)
+                                                            { return IntegerConstant{.value = value, .isSigned = true}; });
+    }
+    return from_chars<uint64_t>(constantValue).transform([](const uint64_t value)
+                                                         { return IntegerConstant{.value = value, .isSigned = false}; });
+}
+
+std::optional<bool> getBooleanConstant(const LogicalFunction& function)
+{
+    const auto constant = function.tryGetAs<ConstantValueLogicalFunction>();
+    if (not constant.has_value() or not function.getDataType().isType(DataType::Type::BOOLEAN))
+    {
+        return std::nullopt;
+    }
+    return from_chars<bool>(constant.value()->getConstantValue());
+}
+
+template <typename T>
+bool isInRangeOf(const WideInteger value)
+{
+    return value >= std::numeric_limits<T>::min() and value <= std::numeric_limits<T>::max();
+}
+
+bool isInRangeOf(const WideInteger value, const DataType& dataType)
+{
+    switch (dataType.type)
+    {
+        case DataType::Type::UINT8:
+            return isInRangeOf<uint8_t>(value);
+        case DataType::Type::UINT16:
+            return isInRangeOf<uint16_t>(value);
+        case DataType::Type::UINT32:
+            return isInRangeOf<uint32_t>(value);
+        case DataType::Type::UINT64:
+            return isInRangeOf<uint64_t>(value);
+        case DataType::Type::INT8:
+            return isInRangeOf<int8_t>(value);
+        case DataType::Type::INT16:
+            return isInRangeOf<int16_t>(value);
+        case DataType::Type::INT32:
+            return isInRangeOf<int32_t>(value);
+        case DataType::Type::INT64:
+            return isInRangeOf<int64_t>(value);
+        default:
+            return false;
+    }
+}
+
+std::optional<WideInteger> evaluateArithmetic(const std::string_view functionType, const WideInteger left, const WideInteger right)
+{
+    constexpr WideInteger LargestExactFactor = std::numeric_limits<int64_t>::max();
+    if (functionType == AddLogicalFunction::NAME)
+    {
+        return left + right;
+    }
+    if (functionType == SubLogicalFunction::NAME)
+    {
+        return left - right;
+    }
+    if (functionType == MulLogicalFunction::NAME
+        and std::max(left, -left) <= LargestExactFactor and std::max(right, -right) <= LargestExactFactor)
+    {
+        return left * right;
+    }
+    /// The division truncates towards zero for both the folded and the compiled function
+    if (functionType == DivLogicalFunction::NAME and right != 0)
+    {
+        return left / right;
+    }
+    if (functionType == ModuloLogicalFunction::NAME and right != 0)
+    {
+        return left % right;
+    }
+    return std::nullopt;
+}
+
+std::optional<bool> evaluateComparison(const std::string_view functionType, const WideInteger left, const WideInteger right)
+{
+    if (functionType == EqualsLogicalFunction::NAME)
+    {
+        return left == right;
+    }
+    if (functionType == LessLogicalFunction::NAME)
+    {
+        return left < right;
+    }
+    if (functionType == LessEqualsLogicalFunction::NAME)
+    {
+        return left <= right;
+    }
+    if (functionType == GreaterLogicalFunction::NAME)
+    {
+        return left > right;
+    }
+    if (functionType == GreaterEqualsLogicalFunction::NAME)
+    {
+        return left >= right;
+    }
+    return std::nullopt;
+}
+
+LogicalFunction createIntegerConstant(const DataType& dataType, const WideInteger value)
+{
+    const auto valueAsString = dataType.isSignedInteger() ? std::to_string(static_cast<int64_t>(value))
+                                                          : std::to_string(static_cast<uint64_t>(value));
+    return LogicalFunction{ConstantValueLogicalFunction(dataType, valueAsString)};
+}
+
+LogicalFunction createBooleanConstant(const DataType& dataType, const bool value)
+{
+    return LogicalFunction{ConstantValueLogicalFunction(dataType, value ? "true" : "false")};
+}
+
+/// Folds the function, whose children are already folded, if it only depends on constants or if a constant decides its result
+std::optional<LogicalFunction> tryFold(const LogicalFunction& function)
+{
+    const auto children = function.getChildren();
+    const auto functionType = function.getType();
+    if (functionType == NegateLogicalFunction::NAME)
+    {
+        return getBooleanConstant(children.at(0))
+            .transform([&](const bool value) { return createBooleanConstant(function.getDataType(), not value); });
+    }
+    if (functionType == AndLogicalFunction::NAME or functionType == OrLogicalFunction::NAME)
+    {
+        /// A constant that equals the neutral element leaves the other side, any other constant decides the result
+        const bool neutralElement = functionType == AndLogicalFunction::NAME;
+        for (size_t constantSide = 0; constantSide < 2; ++constantSide)
+        {
+            if (const auto constant = getBooleanConstant(children.at(constantSide)))
+            {
+                return constant.value() == neutralElement ? children.at(1 - constantSide)
+                                                          : createBooleanConstant(function.getDataType(), constant.value());
+            }
+        }
+        return std::nullopt;
+    }
+
+    if (children.size() != 2)
+    {
+        return std::nullopt;
+    }
+    const auto left = getIntegerConstant(children[0]);
+    const auto right = getIntegerConstant(children[1]);
+    /// The compiled function converts integers of different signedness into a common type, which may change their values
+    if (not left.has_value() or not right.has_value() or left->isSigned != right->isSigned)
+    {
+        return std::nullopt;
+    }
+    if (const auto comparison = evaluateComparison(functionType, left->value, right->value))
+    {
+        return createBooleanConstant(function.getDataType(), comparison.value());
+    }
+    if (const auto result = evaluateArithmetic(functionType, left->value, right->value);
+        result.has_value() and isInRangeOf(result.value(), function.getDataType()))
+    {
+        return createIntegerConstant(function.getDataType(), result.value());
+    }
+    return std::nullopt;
+}
+
+LogicalFunction foldConstants(const LogicalFunction& function)
+{
+    const auto folded = LogicalFunction{
+        function.withChildren(function.getChildren() | std::views::transform(foldConstants) | std::ranges::to<std::vector>())};
+    return tryFold(folded).value_or(folded);
+}
+
+std::vector<LogicalFunction> splitConjunctions(const LogicalFunction& predicate)
+{
+    if (predicate.getType() != AndLogicalFunction::NAME)
+    {
+        return {predicate};
+    }
+    std::vector<LogicalFunction> conjunctions;
+    for (const auto& child : predicate.getChildren())
+    {
+        std::ranges::move(splitConjunctions(child), std::back_inserter(conjunctions));
+    }
+    return conjunctions;
+}
+
+/// Returns true if the projection outputs the input field with the same name and value
+bool forwardsUnchanged(const ProjectionLogicalOperator& projection, const std::string& fieldName)
+{
+    const auto& projections = projection.getProjections();
+    const auto projected = std::ranges::find_if(
+        projections, [&](const auto& candidate) { return candidate.first and candidate.first->getFieldName() == fieldName; });
+    if (projected == projections.end())
+    {
+        return projection.hasAsterisk() and projection.getInputSchemas().front().contains(fieldName);
+    }
+    const auto fieldAccess = projected->second.tryGetAs<FieldAccessLogicalFunction>();
+    return fieldAccess.has_value() and fieldAccess.value()->getFieldName() == fieldName;
+}
+
+using ComputedFields = std::vector<std::pair<LogicalFunction, std::string>>;
+
+/// The functions that the projection computes from forwarded fields, together with the output fields that hold their results
+ComputedFields getComputedFields(const ProjectionLogicalOperator& projection)
+{
+    ComputedFields computedFields;
+    for (const auto& [identifier, function] : projection.getProjections())
+    {
+        const bool isComputed = not function.getChildren().empty();
+        const auto onlyForwardedFields = std::ranges::all_of(
+            BFSRange(function),
+            [&](const LogicalFunction& child)
+            {
+                const auto fieldAccess = child.tryGetAs<FieldAccessLogicalFunction>();
+                return not fieldAccess.has_value() or forwardsUnchanged(projection, fieldAccess.value()->getFieldName());
+            });
+        if (identifier.has_value() and isComputed and onlyForwardedFields)
+        {
+            computedFields.emplace_back(function, identifier->getFieldName());
+        }
+    }
+    return computedFields;
+}
+
+LogicalFunction withComputedFields(const LogicalFunction& function, const ComputedFields& computedFields)
+{
+    if (const auto computed = std::ranges::find(computedFields, function, &std::pair<LogicalFunction, std::string>::first);
+        computed != computedFields.end())
+    {
+        return LogicalFunction{FieldAccessLogicalFunction(function.getDataType(), computed->second)};
+    }
+    return function.withChildren(
+        function.getChildren()
+        | std::views::transform([&](const LogicalFunction& child) { return withComputedFields(child, computedFields); })
+        | std::ranges::to<std::vector>());
+}
+
+LogicalOperator simplifySelection(const LogicalOperator& selection, LogicalOperator child)
+{
+    std::vector<LogicalFunction> conjunctions;
+    /// The child selection already merged all selections below it
+    if (const auto childSelection = child.tryGetAs<SelectionLogicalOperator>())
+    {
+        conjunctions = splitConjunctions(childSelection.value()->getPredicate());
+        child = child.getChildren().front();
+    }
+    for (const auto& conjunction : splitConjunctions(foldConstants(selection.getAs<SelectionLogicalOperator>()->getPredicate())))
+    {
+        const bool isAlwaysTrue = getBooleanConstant(conjunction).value_or(false);
+        if (not isAlwaysTrue and std::ranges::find(conjunctions, conjunction) == conjunctions.end())
+        {
+            conjunctions.push_back(conjunction);
+        }
+    }
+    if (conjunctions.empty())
+    {
+        return child;
+    }
+    if (const auto projection = child.tryGetAs<ProjectionLogicalOperator>())
+    {
+        const auto computedFields = getComputedFields(*projection.value());
+        for (auto& conjunction : conjunctions)
+        {
+            conjunction = withComputedFields(conjunction, computedFields);
+        }
+    }
+    const auto predicate = std::accumulate(
+        std::next(conjunctions.begin()),
+        conjunctions.end(),
+        conjunctions.front(),
+        [](LogicalFunction conjunction, const LogicalFunction& next)
+        { return LogicalFunction{AndLogicalFunction(std::move(conjunction), next)}; });
+    return LogicalOperator{SelectionLogicalOperator(predicate).withTraitSet(selection.getTraitSet()).withChildren({std::move(child)})};
+}
+
+LogicalOperator simplifyProjection(const LogicalOperator& projectionOperator, std::vector<LogicalOperator> children)
+{
+    const auto projection = projectionOperator.getAs<ProjectionLogicalOperator>();
+    auto projections = projection->getProjections()
+        | std::views::transform([](const auto& projected) { return std::make_pair(projected.first, foldConstants(projected.second)); })
+        | std::ranges::to<std::vector>();
+    return LogicalOperator{ProjectionLogicalOperator(std::move(projections), ProjectionLogicalOperator::Asterisk(projection->hasAsterisk()))
+                               .withTraitSet(projectionOperator.getTraitSet())
+                               .withChildren(std::move(children))};
+}
+
+LogicalOperator simplify(const LogicalOperator& op)
+{
+    auto children = op.getChildren() | std::views::transform(simplify) | std::ranges::to<std::vector>();
+    if (op.tryGetAs<SelectionLogicalOperator>().has_value())
+    {
+        INVARIANT(children.size() == 1, "Selection operator must have exactly one child, but has {}", children.size());
+        return simplifySelection(op, std::move(children.front()));
+    }
+    if (op.tryGetAs<ProjectionLogicalOperator>().has_value())
+    {
+        return simplifyProjection(op, std::move(children));
+    }
+    return op.withChildren(std::move(children));
+}
+}
+
+void FunctionSimplificationRule::apply(LogicalPlan& queryPlan) const ///NOLINT(readability-convert-member-functions-to-static)
+{
+    const auto newRoots = queryPlan.getRootOperators() | std::views::transform(simplify) | std::ranges::to<std::vector>();
+    queryPlan = queryPlan.withRootOperators(newRoots);
+}
+
+}
@@ -0,0 +1,345 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <LegacyOptimizer/IntegerNarrowingRule.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/DataTypeProvider.hpp>
+#include <Functions/ArithmeticalFunctions/AddLogicalFunction.hpp>
+#include <Functions/ArithmeticalFunctions/MulLogicalFunction.hpp>
+#include <Functions/ArithmeticalFunctions/SubLogicalFunction.hpp>
+#include <Functions/BooleanFunctions/EqualsLogicalFunction.hpp>
+#include <Functions/CastToTypeLogicalFunction.hpp>
+#include <Functions/ComparisonFunctions/GreaterEqualsLogicalFunction.hpp>
+#include <Functions/ComparisonFunctions/GreaterLogicalFunction.hpp>
+#include <Functions/ComparisonFunctions/LessEqualsLogicalFunction.hpp>
+#include <Functions/ComparisonFunctions/LessLogicalFunction.hpp>
+#include <Functions/ConstantValueLogicalFunction.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Operators/ProjectionLogicalOperator.hpp>
+#include <Operators/SelectionLogicalOperator.hpp>
+#include <Plans/LogicalPlan.hpp>
+#include <Traits/TraitSet.hpp>
+#include <Util/Strings.hpp>
+
+namespace NES
+{
+
+namespace
+{
+/// Wide enough for the exact bounds of the sum or difference of two 64-bit integers and of products of factors up to INT64_MAX
+using WideInteger = __int128;
+
+/// The closed interval of the values that an integer function may evaluate to
+struct IntegerRange
+{
+    WideInteger min;
+    WideInteger max;
+
+    [[nodiscard]] bool isWithin(const IntegerRange& other) const { return min >= other.min and max <= other.max; }
+};
+
+template <typename T>
+IntegerRange getRangeOf()
+{
+    return {.min = std::numeric_limits<T>::min(), .max = std::numeric_limits<T>::max()};
+}
+
+std::optional<IntegerRange> getTypeRange(const DataType& dataType)
+{
+    switch (dataType.type)
+    {
+        case DataType::Type::UINT8:
+            return getRangeOf<uint8_t>();
+        case DataType::Type::UINT16:
+            return getRangeOf<uint16_t>();
+        case DataType::Type::UINT32:
+            return getRangeOf<uint32_t>();
+        case DataType::Type::UINT64:
+            return getRangeOf<uint64_t>();
+        case DataType::Type::INT8:
+            return getRangeOf<int8_t>();
+        case DataType::Type::INT16:
+            return getRangeOf<int16_t>();
+        case DataType::Type::INT32:
+            return getRangeOf<int32_t>();
+        case DataType::Type::INT64:
+            return getRangeOf<int64_t>();
+        default:
+            return std::nullopt;
+    }
+}
+
+std::optional<WideInteger> getIntegerConstant(const LogicalFunction& function)
+{
+    const auto constant = function.tryGetAs<ConstantValueLogicalFunction>();
+    const auto dataType = function.getDataType();
+    if (not constant.has_value() or not dataType.isInteger())
+    {
+        return std::nullopt;
+    }
+    const auto constantValue = constant.value()->getConstantValue();
+    if (dataType.isSignedInteger())
+    {
+        return from_chars<int64_t>(constantValue).transform([](const int64_t value) { return WideInteger{value}; });
+    }
+    return from_chars<uint64_t>(constantValue).transform([](const uint64_t value) { return WideInteger{value}; });
+}
+
+LogicalFunction createIntegerConstant(const DataType::Type type, const WideInteger value)
+{
+    const auto dataType = DataTypeProvider::provideDataType(type);
+    const auto valueAsString = dataType.isSignedInteger() ? std::to_string(static_cast<int64_t>(value))
+                                                          : std::to_string(static_cast<uint64_t>(value));
+    return LogicalFunction{ConstantValueLogicalFunction(dataType, valueAsString)};
+}
+
+bool isComparison(const std::string_view functionType)
+{
+    return functionType == EqualsLogicalFunction::NAME or functionType == LessLogicalFunction::NAME
+        or functionType == LessEqualsLogicalFunction::NAME or functionType == GreaterLogicalFunction::NAME
+        or functionType == GreaterEqualsLogicalFunction::NAME;
+}
+
+bool isArithmetic(const std::string_view functionType)
+{
+    return functionType == AddLogicalFunction::NAME or functionType == SubLogicalFunction::NAME or functionType == MulLogicalFunction::NAME;
+}
+
+/// Returns the interval of the results of the arithmetic on operands of the given intervals
+std::optional<IntegerRange> combineRanges(const std::string_view functionType, const IntegerRange& left, const IntegerRange& right)
+{
+    if (functionType == AddLogicalFunction::NAME)
+    {
+        return IntegerRange{.min = left.min + right.min, .max = left.max + right.max};
+    }
+    if (functionType == SubLogicalFunction::NAME)
+    {
+        return IntegerRange{.min = left.min - right.max, .max = left.max - right.min};
+    }
+    constexpr WideInteger LargestExactFactor = std::numeric_limits<int64_t>::max();
+    const auto isExactFactor
+        = [](const IntegerRange& range) { return range.min >= -LargestExactFactor and range.max <= LargestExactFactor; };
+    if (functionType == MulLogicalFunction::NAME and isExactFactor(left) and isExactFactor(right))
+    {
+        const std::array products{left.min * right.min, left.min * right.max, left.max * right.min, left.max * right.max};
+        return IntegerRange{.min = std::ranges::min(products), .max = std::ranges::max(products)};
+    }
+    return std::nullopt;
+}
+
+std::optional<IntegerRange> inferRange(const LogicalFunction& function);
+
+/// Returns the interval of the results of the arithmetic function, if it does not overflow its inferred type
+std::optional<IntegerRange> inferExactArithmeticRange(const LogicalFunction& function)
+{
+    const auto children = function.getChildren();
+    const auto typeRange = getTypeRange(function.getDataType());
+    const auto left = inferRange(children.at(0));
+    const auto right = inferRange(children.at(1));
+    if (not typeRange.has_value() or not left.has_value() or not right.has_value())
+    {
+        return std::nullopt;
+    }
+    if (const auto result = combineRanges(function.getType(), *left, *right); result.has_value() and result->isWithin(*typeRange))
+    {
+        return result;
+    }
+    return std::nullopt;
+}
+
+/// Returns the interval of the values of an integer function, or nullopt for functions of any other type
+std::optional<IntegerRange> inferRange(const LogicalFunction& function)
+{
+    const auto typeRange = getTypeRange(function.getDataType());
+    if (not typeRange.has_value())
+    {
+        return std::nullopt;
+    }
+    if (const auto constant = getIntegerConstant(function))
+    {
+        return IntegerRange{.min = *constant, .max = *constant};
+    }
+    if (function.getType() == CastToTypeLogicalFunction::NAME)
+    {
+        /// A cast that does not preserve every value wraps around, which may yield any value of the type
+        const auto operandRange = inferRange(function.getChildren().at(0));
+        return operandRange.has_value() and operandRange->isWithin(*typeRange) ? operandRange : typeRange;
+    }
+    if (isArithmetic(function.getType()))
+    {
+        return inferExactArithmeticRange(function).value_or(*typeRange);
+    }
+    return typeRange;
+}
+
+/// Converts an integer constant into the type of the other operand, if the constant fits into the type
+std::vector<LogicalFunction> narrowConstants(std::vector<LogicalFunction> operands)
+{
+    for (size_t constantSide = 0; constantSide < 2; ++constantSide)
+    {
+        const auto constant = getIntegerConstant(operands[constantSide]);
+        const auto& other = operands[1 - constantSide];
+        const auto otherRange = getTypeRange(other.getDataType());
+        if (constant.has_value() and otherRange.has_value() and not getIntegerConstant(other).has_value()
+            and IntegerRange{.min = *constant, .max = *constant}.isWithin(*otherRange))
+        {
+            operands[constantSide] = createIntegerConstant(other.getDataType().type, *constant);
+        }
+    }
+    return operands;
+}
+
+/// Rewrites an integer operand of a comparison into a function of the same values with types as narrow as the range analysis allows
+LogicalFunction narrowOperand(const LogicalFunction& function)
+{
+    if (function.getType() == CastToTypeLogicalFunction::NAME)
+    {
+        const auto operand = function.getChildren().at(0);
+        const auto operandRange = inferRange(operand);
+        const auto typeRange = getTypeRange(function.getDataType());
+        if (operandRange.has_value() and typeRange.has_value() and operandRange->isWithin(*typeRange))
+        {
+            return narrowOperand(operand);
+        }
+        return function;
+    }
+    /// An arithmetic function that overflows wraps around in its type, thus its values depend on the type
+    if (not isArithmetic(function.getType()) or not inferExactArithmeticRange(function).has_value())
+    {
+        return function;
+    }
+    const auto narrowed = LogicalFunction{function.withChildren(
+        narrowConstants(function.getChildren() | std::views::transform(narrowOperand) | std::ranges::to<std::vector>()))};
+    return inferExactArithmeticRange(narrowed).has_value() ? narrowed : function;
+}
+
+/// True, if the comparison compares the values of its operands, i.e., if the common type of the operands holds both of their ranges
+bool isExactComparison(const std::vector<LogicalFunction>& operands)
+{
+    const auto commonType = operands.at(0).getDataType().join(operands.at(1).getDataType());
+    if (not commonType.has_value())
+    {
+        return false;
+    }
+    const auto commonRange = getTypeRange(*commonType);
+    const auto left = inferRange(operands[0]);
+    const auto right = inferRange(operands[1]);
+    return commonRange.has_value() and left.has_value() and right.has_value() and left->isWithin(*commonRange)
+        and right->isWithin(*commonRange);
+}
+
+/// Returns the result of the comparison, if the ranges of its non-nullable operands decide it
+std::optional<bool> decideComparison(const std::string_view functionType, const IntegerRange& left, const IntegerRange& right)
+{
+    const auto decide = [](const bool alwaysTrue, const bool alwaysFalse) -> std::optional<bool>
+    {
+        if (alwaysTrue or alwaysFalse)
+        {
+            return alwaysTrue;
+        }
+        return std::nullopt;
+    };
+    if (functionType == LessLogicalFunction::NAME)
+    {
+        return decide(left.max < right.min, left.min >= right.max);
+    }
+    if (functionType == LessEqualsLogicalFunction::NAME)
+    {
+        return decide(left.max <= right.min, left.min > right.max);
+    }
+    if (functionType == GreaterLogicalFunction::NAME)
+    {
+        return decide(left.min > right.max, left.max <= right.min);
+    }
+    if (functionType == GreaterEqualsLogicalFunction::NAME)
+    {
+        return decide(left.min >= right.max, left.max < right.min);
+    }
+    const bool bothConstant = left.min == left.max and right.min == right.max;
+    return decide(bothConstant and left.min == right.min, left.max < right.min or right.max < left.min);
+}
+
+LogicalFunction narrowComparison(const LogicalFunction& comparison)
+{
+    const auto operands = comparison.getChildren();
+    if (operands.size() != 2 or not isExactComparison(operands))
+    {
+        return comparison;
+    }
+    auto narrowed = narrowConstants(operands | std::views::transform(narrowOperand) | std::ranges::to<std::vector>());
+    if (not isExactComparison(narrowed))
+    {
+        narrowed = operands;
+    }
+    if (std::ranges::none_of(narrowed, [](const LogicalFunction& operand) { return operand.getDataType().nullable; }))
+    {
+        if (const auto decided = decideComparison(comparison.getType(), *inferRange(narrowed[0]), *inferRange(narrowed[1])))
+        {
+            return LogicalFunction{ConstantValueLogicalFunction(comparison.getDataType(), *decided ? "true" : "false")};
+        }
+    }
+    return LogicalFunction{comparison.withChildren(std::move(narrowed))};
+}
+
+LogicalFunction narrowComparisons(const LogicalFunction& function)
+{
+    const auto rewritten = LogicalFunction{
+        function.withChildren(function.getChildren() | std::views::transform(narrowComparisons) | std::ranges::to<std::vector>())};
+    return isComparison(rewritten.getType()) ? narrowComparison(rewritten) : rewritten;
+}
+
+LogicalOperator narrow(const LogicalOperator& op)
+{
+    auto children = op.getChildren() | std::views::transform(narrow) | std::ranges::to<std::vector>();
+    if (const auto selection = op.tryGetAs<SelectionLogicalOperator>())
+    {
+        return LogicalOperator{SelectionLogicalOperator(narrowComparisons(selection.value()->getPredicate()))
+                                   .withTraitSet(op.getTraitSet())
+                                   .withChildren(std::move(children))};
+    }
+    if (const auto projection = op.tryGetAs<ProjectionLogicalOperator>())
+    {
+        auto projections = projection.value()->getProjections()
+            | std::views::transform([](const auto& projected)
+                                    { return std::make_pair(projected.first, narrowComparisons(projected.second)); })
+            | std::ranges::to<std::vector>();
+        return LogicalOperator{
+            ProjectionLogicalOperator(std::move(projections), ProjectionLogicalOperator::Asterisk(projection.value()->hasAsterisk()))
+                .withTraitSet(op.getTraitSet())
+                .withChildren(std::move(children))};
+    }
+    return op.withChildren(std::move(children));
+}
+}
+
+void IntegerNarrowingRule::apply(LogicalPlan& queryPlan) const ///NOLINT(readability-convert-member-functions-to-static)
+{
+    const auto newRoots = queryPlan.getRootOperators() | std::views::transform(narrow) | std::ranges::to<std::vector>();
+    queryPlan = queryPlan.withRootOperators(newRoots);
+}
+
+}
@@ -15,10 +15,14 @@
 
 #include <LegacyOptimizer.hpp>
 
+#include <LegacyOptimizer/FunctionSimplificationRule.hpp>
 #include <LegacyOptimizer/InlineSinkBindingPhase.hpp>
 #include <LegacyOptimizer/InlineSourceBindingPhase.hpp>
+#include <LegacyOptimizer/IntegerNarrowingRule.hpp>
 #include <LegacyOptimizer/LogicalSourceExpansionRule.hpp>
 #include <LegacyOptimizer/OriginIdInferencePhase.hpp>
+#include <LegacyOptimizer/PredicatePushdownRule.hpp>
+#include <LegacyOptimizer/ProjectionPushdownRule.hpp>
 #include <LegacyOptimizer/RedundantProjectionRemovalRule.hpp>
 #include <LegacyOptimizer/RedundantUnionRemovalRule.hpp>
 #include <LegacyOptimizer/SinkBindingRule.hpp>
@@ -39,6 +43,10 @@ LogicalPlan LegacyOptimizer::optimize(const LogicalPlan& plan) const
     constexpr auto originIdInferencePhase = OriginIdInferencePhase{};
     constexpr auto redundantUnionRemovalRule = RedundantUnionRemovalRule{};
     constexpr auto redundantProjectionRemovalRule = RedundantProjectionRemovalRule{};
+    constexpr auto predicatePushdownRule = PredicatePushdownRule{};
+    constexpr auto projectionPushdownRule = ProjectionPushdownRule{};
+    constexpr auto functionSimplificationRule = FunctionSimplificationRule{};
+    constexpr auto integerNarrowingRule = IntegerNarrowingRule{};
 
     inlineSinkBindingPhase.apply(newPlan);
     sinkBindingRule.apply(newPlan);
@@ -50,6 +58,25 @@ LogicalPlan LegacyOptimizer::optimize(const LogicalPlan& plan) const
     NES_INFO("After Redundant Union Removal:\n{}", newPlan);
     typeInference.apply(newPlan);
 
+    /// The pushdown decides on the inferred schemas, which the pushed selections have to infer again
+    predicatePushdownRule.apply(newPlan);
+    NES_INFO("After Predicate Pushdown:\n{}", newPlan);
+    typeInference.apply(newPlan);
+
+    /// Compares narrow fields with constants of their type and decides comparisons by the ranges of their operands
+    integerNarrowingRule.apply(newPlan);
+    NES_INFO("After Integer Narrowing:\n{}", newPlan);
+    typeInference.apply(newPlan);
+
+    /// Merges the selections that the predicate pushdown stacked above the operators that block them
+    functionSimplificationRule.apply(newPlan);
+    NES_INFO("After Function Simplification:\n{}", newPlan);
+    typeInference.apply(newPlan);
+
+    /// Narrows the sources below the selections that the predicate pushdown moved towards them
+    projectionPushdownRule.apply(newPlan);
+    NES_INFO("After Projection Pushdown:\n{}", newPlan);
+
     redundantProjectionRemovalRule.apply(newPlan);
     NES_INFO("After Redundant Projection Removal:\n{}", newPlan);
 
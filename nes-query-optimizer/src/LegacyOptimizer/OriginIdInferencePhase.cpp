@@ -23,6 +23,7 @@
 
 #include <Identifiers/Identifiers.hpp>
 #include <Operators/LogicalOperator.hpp>
+#include <Operators/LookupJoinLogicalOperator.hpp>
 #include <Operators/OriginIdAssigner.hpp>
 #include <Operators/Sources/SourceDescriptorLogicalOperator.hpp>
 #include <Plans/LogicalPlan.hpp>
@@ -57,6 +58,13 @@ LogicalOperator propagateOriginIds(const LogicalOperator& visitingOperator, Orig
         const auto success = tryInsert(traitSet, OutputOriginIdsTrait{{lastOriginId}});
         INVARIANT(success, "Failed to insert origin id trait, did another phase already assign them?");
     }
+    else if (visitingOperator.tryGetAs<LookupJoinLogicalOperator>().has_value())
+    {
+        /// The lookup join emits its output in the buffers of the stream, while its table never reaches the operators above
+        INVARIANT(childOriginIds.size() == 2, "Lookup join must have a stream and a table as children");
+        const auto success = tryInsert(traitSet, childOriginIds.front());
+        INVARIANT(success, "Failed to insert origin id trait, did another phase already assign them?");
+    }
     else
     {
         const auto success = tryInsert(
@@ -0,0 +1,265 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <LegacyOptimizer/PredicatePushdownRule.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <utility>
+#include <vector>
+#include <DataTypes/Schema.hpp>
+#include <Functions/BooleanFunctions/AndLogicalFunction.hpp>
+#include <Functions/FieldAccessLogicalFunction.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Iterators/BFSIterator.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Operators/ProjectionLogicalOperator.hpp>
+#include <Operators/SelectionLogicalOperator.hpp>
+#include <Operators/UnionLogicalOperator.hpp>
+#include <Operators/Windows/JoinLogicalOperator.hpp>
+#include <Plans/LogicalPlan.hpp>
+#include <Traits/TraitSet.hpp>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+namespace
+{
+std::vector<LogicalFunction> splitConjunctions(const LogicalFunction& predicate)
+{
+    if (not predicate.tryGetAs<AndLogicalFunction>().has_value())
+    {
+        return {predicate};
+    }
+    std::vector<LogicalFunction> conjunctions;
+    for (const auto& child : predicate.getChildren())
+    {
+        std::ranges::move(splitConjunctions(child), std::back_inserter(conjunctions));
+    }
+    return conjunctions;
+}
+
+std::vector<std::string> getAccessedFields(const LogicalFunction& function)
+{
+    return BFSRange(function)
+        | std::views::filter([](const LogicalFunction& child) { return child.tryGetAs<FieldAccessLogicalFunction>().has_value(); })
+        | std::views::transform([](const LogicalFunction& child) { return child.getAs<FieldAccessLogicalFunction>()->getFieldName(); })
+        | std::ranges::to<std::vector>();
+}
+
+LogicalOperator withSelection(const std::vector<LogicalFunction>& conjunctions, const TraitSet& traitSet, LogicalOperator child)
+{
+    if (conjunctions.empty())
+    {
+        return child;
+    }
+    const auto predicate = std::accumulate(
+        std::next(conjunctions.begin()),
+        conjunctions.end(),
+        conjunctions.front(),
+        [](LogicalFunction conjunction, const LogicalFunction& next)
+        { return LogicalFunction{AndLogicalFunction(std::move(conjunction), next)}; });
+    return LogicalOperator{SelectionLogicalOperator(predicate).withTraitSet(traitSet).withChildren({std::move(child)})};
+}
+
+/// Returns the name of the input field that the projection forwards as the given output field, unless the projection computes the field
+std::optional<std::string> getForwardedInputField(const ProjectionLogicalOperator& projection, const std::string& fieldName)
+{
+    const auto outputField = projection.getOutputSchema().getFieldByName(fieldName);
+    if (not outputField.has_value())
+    {
+        return std::nullopt;
+    }
+    const auto& projections = projection.getProjections();
+    const auto projected = std::ranges::find_if(
+        projections, [&](const auto& candidate) { return candidate.first and candidate.first->getFieldName() == outputField->name; });
+    if (projected == projections.end())
+    {
+        /// Fields that are not projected explicitly stem from the asterisk
+        return outputField->name;
+    }
+    if (const auto fieldAccess = projected->second.tryGetAs<FieldAccessLogicalFunction>())
+    {
+        return fieldAccess.value()->getFieldName();
+    }
+    return std::nullopt;
+}
+
+LogicalFunction withForwardedInputFields(const ProjectionLogicalOperator& projection, const LogicalFunction& function)
+{
+    if (const auto fieldAccess = function.tryGetAs<FieldAccessLogicalFunction>())
+    {
+        const auto inputField = getForwardedInputField(projection, fieldAccess.value()->getFieldName());
+        INVARIANT(inputField.has_value(), "Projection does not forward field {}", fieldAccess.value()->getFieldName());
+        return LogicalFunction{fieldAccess.value()->withFieldName(inputField.value())};
+    }
+    return function.withChildren(
+        function.getChildren()
+        | std::views::transform([&](const LogicalFunction& child) { return withForwardedInputFields(projection, child); })
+        | std::ranges::to<std::vector>());
+}
+
+std::optional<LogicalOperator>
+tryPushBelow(const std::vector<LogicalFunction>& conjunctions, const TraitSet& traitSet, const LogicalOperator& child);
+
+LogicalOperator pushBelow(const std::vector<LogicalFunction>& conjunctions, const TraitSet& traitSet, const LogicalOperator& child)
+{
+    if (conjunctions.empty())
+    {
+        return child;
+    }
+    if (auto pushed = tryPushBelow(conjunctions, traitSet, child))
+    {
+        return std::move(pushed.value());
+    }
+    return withSelection(conjunctions, traitSet, child);
+}
+
+std::optional<LogicalOperator>
+tryPushBelowUnion(const std::vector<LogicalFunction>& conjunctions, const TraitSet& traitSet, const LogicalOperator& unionOperator)
+{
+    const auto inputSchemas = unionOperator.getInputSchemas();
+    std::vector<LogicalFunction> pushable;
+    std::vector<LogicalFunction> remaining;
+    for (const auto& conjunction : conjunctions)
+    {
+        const auto accessedFields = getAccessedFields(conjunction);
+        const auto resolvableInAllInputs = std::ranges::all_of(
+            inputSchemas,
+            [&](const Schema& schema)
+            { return std::ranges::all_of(accessedFields, [&](const auto& field) { return schema.getFieldByName(field).has_value(); }); });
+        (resolvableInAllInputs ? pushable : remaining).push_back(conjunction);
+    }
+    if (pushable.empty())
+    {
+        return std::nullopt;
+    }
+    /// Every input receives its own copy of the selection
+    auto children = unionOperator.getChildren()
+        | std::views::transform([&](const LogicalOperator& child) { return pushBelow(pushable, traitSet, child); })
+        | std::ranges::to<std::vector>();
+    return withSelection(remaining, traitSet, unionOperator.withChildren(std::move(children)));
+}
+
+std::optional<LogicalOperator>
+tryPushBelowJoin(const std::vector<LogicalFunction>& conjunctions, const TraitSet& traitSet, const LogicalOperator& join)
+{
+    const auto leftSchema = join.getAs<JoinLogicalOperator>()->getLeftSchema();
+    const auto rightSchema = join.getAs<JoinLogicalOperator>()->getRightSchema();
+    std::vector<LogicalFunction> left;
+    std::vector<LogicalFunction> right;
+    std::vector<LogicalFunction> remaining;
+    for (const auto& conjunction : conjunctions)
+    {
+        const auto accessedFields = getAccessedFields(conjunction);
+        if (std::ranges::all_of(accessedFields, [&](const auto& field) { return leftSchema.contains(field); }))
+        {
+            left.push_back(conjunction);
+        }
+        else if (std::ranges::all_of(accessedFields, [&](const auto& field) { return rightSchema.contains(field); }))
+        {
+            right.push_back(conjunction);
+        }
+        else
+        {
+            remaining.push_back(conjunction);
+        }
+    }
+    if (left.empty() and right.empty())
+    {
+        return std::nullopt;
+    }
+    const auto children = join.getChildren();
+    INVARIANT(children.size() == 2, "Join operator must have exactly two children, but has {}", children.size());
+    return withSelection(
+        remaining, traitSet, join.withChildren({pushBelow(left, traitSet, children[0]), pushBelow(right, traitSet, children[1])}));
+}
+
+std::optional<LogicalOperator> tryPushBelowProjection(
+    const std::vector<LogicalFunction>& conjunctions, const TraitSet& traitSet, const LogicalOperator& projectionOperator)
+{
+    const auto projection = projectionOperator.getAs<ProjectionLogicalOperator>();
+    std::vector<LogicalFunction> pushable;
+    std::vector<LogicalFunction> remaining;
+    for (const auto& conjunction : conjunctions)
+    {
+        /// Pushing a predicate on a computed field would compute the field twice, thus we only push predicates on forwarded fields
+        const auto onlyForwardedFields = std::ranges::all_of(
+            getAccessedFields(conjunction), [&](const auto& field) { return getForwardedInputField(*projection, field).has_value(); });
+        if (onlyForwardedFields)
+        {
+            pushable.push_back(withForwardedInputFields(*projection, conjunction));
+        }
+        else
+        {
+            remaining.push_back(conjunction);
+        }
+    }
+    if (pushable.empty())
+    {
+        return std::nullopt;
+    }
+    const auto children = projectionOperator.getChildren();
+    INVARIANT(children.size() == 1, "Projection operator must have exactly one child, but has {}", children.size());
+    return withSelection(remaining, traitSet, projectionOperator.withChildren({pushBelow(pushable, traitSet, children.front())}));
+}
+
+/// Returns nullopt if none of the conjunctions can be pushed below the child
+std::optional<LogicalOperator>
+tryPushBelow(const std::vector<LogicalFunction>& conjunctions, const TraitSet& traitSet, const LogicalOperator& child)
+{
+    if (child.tryGetAs<UnionLogicalOperator>().has_value())
+    {
+        return tryPushBelowUnion(conjunctions, traitSet, child);
+    }
+    if (child.tryGetAs<JoinLogicalOperator>().has_value())
+    {
+        return tryPushBelowJoin(conjunctions, traitSet, child);
+    }
+    if (child.tryGetAs<ProjectionLogicalOperator>().has_value())
+    {
+        return tryPushBelowProjection(conjunctions, traitSet, child);
+    }
+    return std::nullopt;
+}
+
+/// Pushes down the selections of the children first, so that a selection that moves below its child only has to pass the selections
+/// that already moved down
+LogicalOperator pushDownSelections(const LogicalOperator& op)
+{
+    auto children = op.getChildren() | std::views::transform(pushDownSelections) | std::ranges::to<std::vector>();
+    if (const auto selection = op.tryGetAs<SelectionLogicalOperator>())
+    {
+        INVARIANT(children.size() == 1, "Selection operator must have exactly one child, but has {}", children.size());
+        if (auto pushed = tryPushBelow(splitConjunctions(selection.value()->getPredicate()), op.getTraitSet(), children.front()))
+        {
+            return std::move(pushed.value());
+        }
+    }
+    return op.withChildren(std::move(children));
+}
+}
+
+void PredicatePushdownRule::apply(LogicalPlan& queryPlan) const ///NOLINT(readability-convert-member-functions-to-static)
+{
+    const auto newRoots = queryPlan.getRootOperators() | std::views::transform(pushDownSelections) | std::ranges::to<std::vector>();
+    queryPlan = queryPlan.withRootOperators(newRoots);
+}
+
+}
@@ -0,0 +1,291 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <LegacyOptimizer/ProjectionPushdownRule.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include <DataTypes/Schema.hpp>
+#include <Functions/FieldAccessLogicalFunction.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Iterators/BFSIterator.hpp>
+#include <Operators/BernoulliSampleLogicalOperator.hpp>
+#include <Operators/EventTimeWatermarkAssignerLogicalOperator.hpp>
+#include <Operators/IngestionTimeWatermarkAssignerLogicalOperator.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Operators/LookupJoinLogicalOperator.hpp>
+#include <Operators/ProjectionLogicalOperator.hpp>
+#include <Operators/SelectionLogicalOperator.hpp>
+#include <Operators/Sources/SourceDescriptorLogicalOperator.hpp>
+#include <Operators/UnionLogicalOperator.hpp>
+#include <Operators/Windows/DeduplicationLogicalOperator.hpp>
+#include <Operators/Windows/JoinLogicalOperator.hpp>
+#include <Operators/Windows/ReservoirSampleLogicalOperator.hpp>
+#include <Operators/Windows/WindowedAggregationLogicalOperator.hpp>
+#include <Plans/LogicalPlan.hpp>
+#include <WindowTypes/Measures/TimeCharacteristic.hpp>
+#include <WindowTypes/Types/TimeBasedWindowType.hpp>
+#include <WindowTypes/Types/WindowType.hpp>
+
+namespace NES
+{
+
+namespace
+{
+/// The fields that an operator reads from the output of its children, or nullopt if it reads all fields
+using RequiredFields = std::optional<std::unordered_set<std::string>>;
+
+void addAccessedFields(std::unordered_set<std::string>& fields, const LogicalFunction& function)
+{
+    for (const auto& child : BFSRange(function))
+    {
+        if (const auto fieldAccess = child.tryGetAs<FieldAccessLogicalFunction>())
+        {
+            fields.insert(fieldAccess.value()->getFieldName());
+        }
+    }
+}
+
+void addTimeField(std::unordered_set<std::string>& fields, const std::shared_ptr<Windowing::WindowType>& windowType)
+{
+    if (const auto timeBasedWindow = std::dynamic_pointer_cast<Windowing::TimeBasedWindowType>(windowType))
+    {
+        if (const auto timeCharacteristic = timeBasedWindow->getTimeCharacteristic();
+            timeCharacteristic.getType() == Windowing::TimeCharacteristic::Type::EventTime)
+        {
+            fields.insert(timeCharacteristic.field.name);
+        }
+    }
+}
+
+/// Windows derive the qualifier of the window start and end fields from the first field of their inputs, which thus has to remain
+void addFirstInputFields(std::unordered_set<std::string>& fields, const LogicalOperator& window)
+{
+    for (const auto& inputSchema : window.getInputSchemas())
+    {
+        if (inputSchema.getNumberOfFields() > 0)
+        {
+            fields.insert(inputSchema.getFieldAt(0).name);
+        }
+    }
+}
+
+RequiredFields getRequiredFieldsOfChildren(const LogicalOperator& op, const RequiredFields& requiredFields)
+{
+    if (const auto projection = op.tryGetAs<ProjectionLogicalOperator>())
+    {
+        return projection.value()->getAccessedFields() | std::ranges::to<std::unordered_set>();
+    }
+    if (const auto aggregation = op.tryGetAs<WindowedAggregationLogicalOperator>())
+    {
+        std::unordered_set<std::string> fields;
+        for (const auto& key : aggregation.value()->getGroupingKeys())
+        {
+            fields.insert(key.getFieldName());
+        }
+        for (const auto& windowAggregation : aggregation.value()->getWindowAggregation())
+        {
+            fields.insert(windowAggregation->getOnField().getFieldName());
+        }
+        addTimeField(fields, aggregation.value()->getWindowType());
+        addFirstInputFields(fields, op);
+        return fields;
+    }
+
+    /// The remaining known operators forward the fields of their children, thus they require the fields that they read themselves
+    if (not requiredFields.has_value())
+    {
+        return std::nullopt;
+    }
+    auto fields = requiredFields.value();
+    if (const auto selection = op.tryGetAs<SelectionLogicalOperator>())
+    {
+        addAccessedFields(fields, selection.value()->getPredicate());
+        return fields;
+    }
+    if (const auto join = op.tryGetAs<JoinLogicalOperator>())
+    {
+        addAccessedFields(fields, join.value()->getJoinFunction());
+        addTimeField(fields, join.value()->getWindowType());
+        addFirstInputFields(fields, op);
+        return fields;
+    }
+    if (const auto lookupJoin = op.tryGetAs<LookupJoinLogicalOperator>())
+    {
+        addAccessedFields(fields, lookupJoin.value()->getJoinFunction());
+        return fields;
+    }
+    if (const auto deduplication = op.tryGetAs<DeduplicationLogicalOperator>())
+    {
+        /// Without keys, the deduplication compares whole records
+        if (deduplication.value()->getKeys().empty())
+        {
+            return std::nullopt;
+        }
+        for (const auto& key : deduplication.value()->getKeys())
+        {
+            addAccessedFields(fields, key);
+        }
+        addTimeField(fields, deduplication.value()->getWindowType());
+        return fields;
+    }
+    if (const auto reservoirSample = op.tryGetAs<ReservoirSampleLogicalOperator>())
+    {
+        addTimeField(fields, reservoirSample.value()->getWindowType());
+        return fields;
+    }
+    if (const auto watermarkAssigner = op.tryGetAs<EventTimeWatermarkAssignerLogicalOperator>())
+    {
+        addAccessedFields(fields, watermarkAssigner.value()->onField);
+        return fields;
+    }
+    if (op.tryGetAs<IngestionTimeWatermarkAssignerLogicalOperator>().has_value() or op.tryGetAs<UnionLogicalOperator>().has_value()
+        or op.tryGetAs<BernoulliSampleLogicalOperator>().has_value())
+    {
+        return fields;
+    }
+    return std::nullopt;
+}
+
+/// Returns the source or a projection on the fields of the source that resolve the required fields
+LogicalOperator withNarrowingProjection(const LogicalOperator& source, const RequiredFields& requiredFields)
+{
+    if (not requiredFields.has_value())
+    {
+        return source;
+    }
+    const auto schema = source.getOutputSchema();
+    std::unordered_set<std::string> resolvedFields;
+    for (const auto& requiredField : requiredFields.value())
+    {
+        if (const auto field = schema.getFieldByName(requiredField))
+        {
+            resolvedFields.insert(field->name);
+        }
+    }
+    /// A projection without fields would leave the buffers of the source without tuples
+    if (resolvedFields.empty() or resolvedFields.size() == schema.getNumberOfFields())
+    {
+        return source;
+    }
+    auto projections = schema.getFields()
+        | std::views::filter([&](const Schema::Field& field) { return resolvedFields.contains(field.name); })
+        | std::views::transform(
+                           [](const Schema::Field& field)
+                           {
+                               return ProjectionLogicalOperator::Projection{
+                                   FieldIdentifier(field.name), LogicalFunction{FieldAccessLogicalFunction(field.name)}};
+                           })
+        | std::ranges::to<std::vector>();
+    const auto projection = ProjectionLogicalOperator(std::move(projections), ProjectionLogicalOperator::Asterisk(false));
+    return LogicalOperator{projection.withChildren({source})}.withInferredSchema({schema});
+}
+
+/// Drops the fields that the projection computes, but that no operator above reads. A projection without an asterisk keeps at least one
+/// field, as a projection without fields would leave its buffers without tuples.
+LogicalOperator withoutUnreadProjections(const LogicalOperator& projectionOperator, const RequiredFields& requiredFields)
+{
+    if (not requiredFields.has_value())
+    {
+        return projectionOperator;
+    }
+    const auto projection = projectionOperator.getAs<ProjectionLogicalOperator>();
+    const auto outputSchema = projectionOperator.getOutputSchema();
+    std::unordered_set<std::string> readFields;
+    for (const auto& requiredField : requiredFields.value())
+    {
+        if (const auto field = outputSchema.getFieldByName(requiredField))
+        {
+            readFields.insert(field->name);
+        }
+    }
+    auto projections = projection->getProjections()
+        | std::views::filter([&](const ProjectionLogicalOperator::Projection& projected)
+                             { return not projected.first.has_value() or readFields.contains(projected.first->getFieldName()); })
+        | std::ranges::to<std::vector>();
+    if (projections.size() == projection->getProjections().size() or (projections.empty() and not projection->hasAsterisk()))
+    {
+        return projectionOperator;
+    }
+    const auto narrowed = ProjectionLogicalOperator(std::move(projections), ProjectionLogicalOperator::Asterisk(projection->hasAsterisk()))
+                              .withTraitSet(projectionOperator.getTraitSet())
+                              .withChildren(projectionOperator.getChildren());
+    return LogicalOperator{narrowed}.withInferredSchema(projectionOperator.getInputSchemas());
+}
+
+bool haveEqualSchemasWithoutSourceQualifier(const std::vector<LogicalOperator>& operators)
+{
+    auto schemas
+        = operators | std::views::transform([](const LogicalOperator& op) { return withoutSourceQualifier(op.getOutputSchema()); });
+    return std::ranges::adjacent_find(schemas, std::ranges::not_equal_to{}) == schemas.end();
+}
+
+LogicalOperator narrowSources(const LogicalOperator& op, const RequiredFields& requiredFields);
+
+std::vector<LogicalOperator> narrowChildren(const LogicalOperator& op, const RequiredFields& requiredFieldsOfChildren)
+{
+    const bool isProjection = op.tryGetAs<ProjectionLogicalOperator>().has_value();
+    return op.getChildren()
+        | std::views::transform(
+               [&](const LogicalOperator& child)
+               {
+                   /// The scan of a projection on a source already formats only the fields that the projection accesses
+                   if (isProjection and child.tryGetAs<SourceDescriptorLogicalOperator>().has_value())
+                   {
+                       return child;
+                   }
+                   return narrowSources(child, requiredFieldsOfChildren);
+               })
+        | std::ranges::to<std::vector>();
+}
+
+LogicalOperator narrowSources(const LogicalOperator& op, const RequiredFields& requiredFields)
+{
+    if (op.tryGetAs<SourceDescriptorLogicalOperator>().has_value())
+    {
+        return withNarrowingProjection(op, requiredFields);
+    }
+    if (op.getChildren().empty())
+    {
+        return op;
+    }
+
+    const auto narrowedOp = op.tryGetAs<ProjectionLogicalOperator>().has_value() ? withoutUnreadProjections(op, requiredFields) : op;
+    auto children = narrowChildren(narrowedOp, getRequiredFieldsOfChildren(narrowedOp, requiredFields));
+    if (narrowedOp.tryGetAs<UnionLogicalOperator>().has_value() and not haveEqualSchemasWithoutSourceQualifier(children))
+    {
+        /// An input that narrows differently than the others, e.g., a projection, would break the union
+        children = narrowChildren(narrowedOp, std::nullopt);
+    }
+    auto childSchemas = children | std::views::transform([](const LogicalOperator& child) { return child.getOutputSchema(); })
+        | std::ranges::to<std::vector>();
+    return narrowedOp.withChildren(std::move(children)).withInferredSchema(std::move(childSchemas));
+}
+}
+
+void ProjectionPushdownRule::apply(LogicalPlan& queryPlan) const ///NOLINT(readability-convert-member-functions-to-static)
+{
+    const auto newRoots = queryPlan.getRootOperators()
+        | std::views::transform([](const LogicalOperator& root) { return narrowSources(root, std::nullopt); })
+        | std::ranges::to<std::vector>();
+    queryPlan = queryPlan.withRootOperators(newRoots);
+}
+
+}
@@ -0,0 +1,146 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Phases/BandJoinPredicate.hpp>
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <DataTypes/Schema.hpp>
+#include <Functions/BooleanFunctions/AndLogicalFunction.hpp>
+#include <Functions/BooleanFunctions/EqualsLogicalFunction.hpp>
+#include <Functions/ComparisonFunctions/GreaterEqualsLogicalFunction.hpp>
+#include <Functions/ComparisonFunctions/GreaterLogicalFunction.hpp>
+#include <Functions/ComparisonFunctions/LessEqualsLogicalFunction.hpp>
+#include <Functions/ComparisonFunctions/LessLogicalFunction.hpp>
+#include <Functions/FieldAccessLogicalFunction.hpp>
+#include <Functions/LogicalFunction.hpp>
+
+namespace NES
+{
+
+namespace
+{
+void collectConjuncts(const LogicalFunction& function, std::vector<LogicalFunction>& conjuncts)
+{
+    if (function.tryGetAs<AndLogicalFunction>().has_value())
+    {
+        for (const auto& child : function.getChildren())
+        {
+            collectConjuncts(child, conjuncts);
+        }
+    }
+    else
+    {
+        conjuncts.emplace_back(function);
+    }
+}
+
+/// Returns true, if the field exists in the schema and is a non-nullable numeric field, as only their values can be sorted
+bool isSortableField(const Schema& schema, const std::string& fieldName)
+{
+    const auto field = schema.getFieldByName(fieldName);
+    return field.has_value() and field->dataType.isNumeric() and not field->dataType.nullable;
+}
+
+/// Converts a comparison between a left and a right field into a band predicate. Returns nullopt for all other functions.
+std::optional<BandJoinPredicate> toBandJoinPredicate(const LogicalFunction& conjunct, const Schema& leftSchema, const Schema& rightSchema)
+{
+    /// First operand <= second operand and / or first operand >= second operand
+    const bool firstIsLessEquals = conjunct.tryGetAs<LessLogicalFunction>().has_value()
+        or conjunct.tryGetAs<LessEqualsLogicalFunction>().has_value() or conjunct.tryGetAs<EqualsLogicalFunction>().has_value();
+    const bool firstIsGreaterEquals = conjunct.tryGetAs<GreaterLogicalFunction>().has_value()
+        or conjunct.tryGetAs<GreaterEqualsLogicalFunction>().has_value() or conjunct.tryGetAs<EqualsLogicalFunction>().has_value();
+    if (not firstIsLessEquals and not firstIsGreaterEquals)
+    {
+        return std::nullopt;
+    }
+
+    const auto children = conjunct.getChildren();
+    const auto firstField = children[0].tryGetAs<FieldAccessLogicalFunction>();
+    const auto secondField = children[1].tryGetAs<FieldAccessLogicalFunction>();
+    if (not firstField.has_value() or not secondField.has_value())
+    {
+        return std::nullopt;
+    }
+    const auto firstName = firstField->get().getFieldName();
+    const auto secondName = secondField->get().getFieldName();
+
+    /// Fields that are contained in both schemas are ambiguous
+    const auto belongsTo = [](const Schema& schema, const Schema& otherSchema, const std::string& fieldName)
+    { return isSortableField(schema, fieldName) and not otherSchema.getFieldByName(fieldName).has_value(); };
+    if (belongsTo(leftSchema, rightSchema, firstName) and belongsTo(rightSchema, leftSchema, secondName))
+    {
+        return BandJoinPredicate{
+            .leftFieldName = firstName,
+            .rightFieldName = secondName,
+            .rightIsLowerBoundedByLeft = firstIsLessEquals,
+            .rightIsUpperBoundedByLeft = firstIsGreaterEquals};
+    }
+    if (belongsTo(leftSchema, rightSchema, secondName) and belongsTo(rightSchema, leftSchema, firstName))
+    {
+        return BandJoinPredicate{
+            .leftFieldName = secondName,
+            .rightFieldName = firstName,
+            .rightIsLowerBoundedByLeft = firstIsGreaterEquals,
+            .rightIsUpperBoundedByLeft = firstIsLessEquals};
+    }
+    return std::nullopt;
+}
+}
+
+std::optional<BandJoinPredicate>
+BandJoinPredicate::tryCreate(const LogicalFunction& joinFunction, const Schema& leftSchema, const Schema& rightSchema)
+{
+    std::vector<LogicalFunction> conjuncts;
+    collectConjuncts(joinFunction, conjuncts);
+
+    /// Combining the bounds of all comparisons between the same fields, e.g., `left.a <= right.b AND left.a >= right.b`
+    std::vector<BandJoinPredicate> predicates;
+    for (const auto& conjunct : conjuncts)
+    {
+        const auto predicate = toBandJoinPredicate(conjunct, leftSchema, rightSchema);
+        if (not predicate.has_value())
+        {
+            continue;
+        }
+
+        const auto existing = std::ranges::find_if(
+            predicates,
+            [&predicate](const BandJoinPredicate& other)
+            { return other.leftFieldName == predicate->leftFieldName and other.rightFieldName == predicate->rightFieldName; });
+        if (existing == predicates.end())
+        {
+            predicates.emplace_back(predicate.value());
+        }
+        else
+        {
+            existing->rightIsLowerBoundedByLeft = existing->rightIsLowerBoundedByLeft or predicate->rightIsLowerBoundedByLeft;
+            existing->rightIsUpperBoundedByLeft = existing->rightIsUpperBoundedByLeft or predicate->rightIsUpperBoundedByLeft;
+        }
+    }
+
+    if (predicates.empty())
+    {
+        return std::nullopt;
+    }
+    const auto boundedOnBothSides = std::ranges::find_if(
+        predicates,
+        [](const BandJoinPredicate& predicate) { return predicate.rightIsLowerBoundedByLeft and predicate.rightIsUpperBoundedByLeft; });
+    return boundedOnBothSides != predicates.end() ? *boundedOnBothSides : predicates.front();
+}
+
+}
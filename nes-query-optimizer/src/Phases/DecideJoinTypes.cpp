@@ -14,10 +14,16 @@
 #include <Phases/DecideJoinTypes.hpp>
 
 #include <algorithm>
+#include <limits>
+#include <memory>
+#include <optional>
 #include <ranges>
+#include <string>
 #include <unordered_set>
 #include <vector>
 
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
 #include <Functions/BooleanFunctions/AndLogicalFunction.hpp>
 #include <Functions/BooleanFunctions/EqualsLogicalFunction.hpp>
 #include <Functions/BooleanFunctions/OrLogicalFunction.hpp>
@@ -26,12 +32,18 @@
 #include <Iterators/BFSIterator.hpp>
 #include <Operators/LogicalOperator.hpp>
 #include <Operators/Windows/JoinLogicalOperator.hpp>
+#include <Phases/BandJoinPredicate.hpp>
+#include <Phases/JoinCostModel.hpp>
 #include <Plans/LogicalPlan.hpp>
 #include <Traits/ImplementationTypeTrait.hpp>
 #include <Traits/Trait.hpp>
 #include <Traits/TraitSet.hpp>
 #include <Util/Logger/Logger.hpp>
+#include <WindowTypes/Types/IntervalWindow.hpp>
+#include <WindowTypes/Types/TimeBasedWindowType.hpp>
+#include <magic_enum/magic_enum.hpp>
 #include <ErrorHandling.hpp>
+#include <SourceStatistics.hpp>
 
 namespace NES
 {
@@ -76,6 +88,136 @@ bool shallUseHashJoin(const LogicalFunction& joinFunction)
 
     return true;
 }
+
+/// The distinct values sampled at the sources bound the domain of a field more tightly than its data type. As the sample only
+/// contains a fraction of the values, we only trust it if the sampled values repeat, i.e., if the sample likely saw most distinct values.
+double getDomainSize(
+    const std::string& fieldName, const Schema& leftSchema, const Schema& rightSchema, const SourceStatistics* sourceStatistics)
+{
+    const auto field = leftSchema.contains(fieldName) ? leftSchema.getFieldByName(fieldName) : rightSchema.getFieldByName(fieldName);
+    auto domainSize = field.has_value() ? JoinCostModel::getDomainSize(field->dataType) : std::numeric_limits<double>::infinity();
+    if (sourceStatistics == nullptr)
+    {
+        return domainSize;
+    }
+    if (const auto columnStatistics = sourceStatistics->getColumnStatistics(fieldName); columnStatistics.has_value()
+        and columnStatistics->approximateNumberOfDistinctValues > 0
+        and 2 * columnStatistics->approximateNumberOfDistinctValues
+            <= columnStatistics->numberOfSampledValues - columnStatistics->numberOfNullValues)
+    {
+        domainSize = std::min(domainSize, static_cast<double>(columnStatistics->approximateNumberOfDistinctValues));
+    }
+    return domainSize;
+}
+
+/// The join keys are the fields that are compared for equality. Their combined domain bounds the number of distinct keys of a window.
+/// Without equality comparisons, the fields of the band predicate serve as the key.
+double getKeyDomainSize(
+    const LogicalFunction& joinFunction,
+    const Schema& leftSchema,
+    const Schema& rightSchema,
+    const std::optional<BandJoinPredicate>& bandJoinPredicate,
+    const SourceStatistics* sourceStatistics)
+{
+    std::optional<double> keyDomainSize;
+    for (const auto& function : BFSRange<LogicalFunction>(joinFunction))
+    {
+        if (function.tryGetAs<EqualsLogicalFunction>().has_value())
+        {
+            const auto children = function.getChildren();
+            if (const auto field = children[0].tryGetAs<FieldAccessLogicalFunction>();
+                field.has_value() and children[1].tryGetAs<FieldAccessLogicalFunction>().has_value())
+            {
+                keyDomainSize = keyDomainSize.value_or(1)
+                    * getDomainSize(field->get().getFieldName(), leftSchema, rightSchema, sourceStatistics);
+            }
+        }
+    }
+    if (not keyDomainSize.has_value() and bandJoinPredicate.has_value())
+    {
+        keyDomainSize = getDomainSize(bandJoinPredicate->leftFieldName, leftSchema, rightSchema, sourceStatistics);
+    }
+    return keyDomainSize.value_or(std::numeric_limits<double>::infinity());
+}
+}
+
+JoinImplementation DecideJoinTypes::chooseCheapestJoinImplementation(
+    const JoinLogicalOperator& joinOperator, const std::optional<BandJoinPredicate>& bandJoinPredicate) const
+{
+    /// All sources of a join input contribute to the windows of the join, thus, we neglect the selectivity of the operators in between.
+    const auto windowSizeInSeconds = [&]() -> std::optional<double>
+    {
+        if (const auto timeBasedWindow = std::dynamic_pointer_cast<Windowing::TimeBasedWindowType>(joinOperator.getWindowType()))
+        {
+            return static_cast<double>(timeBasedWindow->getSize().getTime()) / 1000;
+        }
+        return std::nullopt;
+    }();
+    const auto children = joinOperator.getChildren();
+    const auto keyDomainSize = getKeyDomainSize(
+        joinOperator.getJoinFunction(),
+        joinOperator.getLeftSchema(),
+        joinOperator.getRightSchema(),
+        bandJoinPredicate,
+        sourceStatistics.get());
+    const auto estimateInput = [&](const LogicalOperator& input, const Schema& schema)
+    {
+        const auto tuplesPerSecond
+            = sourceStatistics == nullptr ? std::nullopt : JoinCostModel::getTuplesPerSecond(input, *sourceStatistics);
+        const auto tuplesPerWindow = tuplesPerSecond.has_value() and windowSizeInSeconds.has_value()
+            ? std::max(*tuplesPerSecond * *windowSizeInSeconds, 1.0)
+            : JoinCostModel::DEFAULT_TUPLES_PER_WINDOW;
+        return JoinInputEstimate{
+            .tuplesPerWindow = tuplesPerWindow,
+            .tupleSizeInBytes = static_cast<double>(schema.getSizeOfSchemaInBytes()),
+            .distinctKeys = std::min(tuplesPerWindow, keyDomainSize)};
+    };
+    const auto left = estimateInput(children.at(0), joinOperator.getLeftSchema());
+    const auto right = estimateInput(children.at(1), joinOperator.getRightSchema());
+    const auto costs = JoinCostModel::estimate(left, right, shallUseHashJoin(joinOperator.getJoinFunction()), bandJoinPredicate);
+    const auto cheapest = costs.getCheapest();
+    NES_DEBUG(
+        "Chose {} for join {} with {} x {} tuples per window. Estimated costs: {}",
+        magic_enum::enum_name(cheapest),
+        joinOperator.getJoinFunction(),
+        left.tuplesPerWindow,
+        right.tuplesPerWindow,
+        costs.explain());
+    return cheapest;
+}
+
+JoinImplementationTypeTrait DecideJoinTypes::createHashJoinTrait(const JoinLogicalOperator& joinOperator) const
+{
+    switch (hashJoinBuildSideStrategy)
+    {
+        case HashJoinBuildSideStrategy::BOTH:
+            return JoinImplementationTypeTrait{JoinImplementation::HASH_JOIN, HashJoinBuildSide::BOTH};
+        case HashJoinBuildSideStrategy::LEFT:
+            return JoinImplementationTypeTrait{JoinImplementation::HASH_JOIN, HashJoinBuildSide::LEFT};
+        case HashJoinBuildSideStrategy::RIGHT:
+            return JoinImplementationTypeTrait{JoinImplementation::HASH_JOIN, HashJoinBuildSide::RIGHT};
+        case HashJoinBuildSideStrategy::OPTIMIZER_CHOOSES:
+            break;
+    }
+
+    /// Without the rates of both sides, we can not tell which side is smaller. Thus, we hash both sides.
+    const auto children = joinOperator.getChildren();
+    const auto leftTuplesPerSecond
+        = sourceStatistics == nullptr ? std::nullopt : JoinCostModel::getTuplesPerSecond(children.at(0), *sourceStatistics);
+    const auto rightTuplesPerSecond
+        = sourceStatistics == nullptr ? std::nullopt : JoinCostModel::getTuplesPerSecond(children.at(1), *sourceStatistics);
+    if (not leftTuplesPerSecond.has_value() or not rightTuplesPerSecond.has_value())
+    {
+        return JoinImplementationTypeTrait{JoinImplementation::HASH_JOIN, HashJoinBuildSide::BOTH};
+    }
+    const auto hashJoinBuildSide = JoinCostModel::chooseHashJoinBuildSide(*leftTuplesPerSecond, *rightTuplesPerSecond);
+    NES_DEBUG(
+        "Hashing {} side(s) of the hash join {} with {} x {} tuples per second",
+        magic_enum::enum_name(hashJoinBuildSide),
+        joinOperator.getJoinFunction(),
+        *leftTuplesPerSecond,
+        *rightTuplesPerSecond);
+    return JoinImplementationTypeTrait{JoinImplementation::HASH_JOIN, hashJoinBuildSide};
 }
 
 LogicalPlan DecideJoinTypes::apply(const LogicalPlan& queryPlan)
@@ -92,25 +234,56 @@ LogicalOperator DecideJoinTypes::apply(const LogicalOperator& logicalOperator)
     auto traitSet = logicalOperator.getTraitSet();
     if (const auto joinOperator = logicalOperator.tryGetAs<JoinLogicalOperator>())
     {
-        if (this->joinStrategy == StreamJoinStrategy::NESTED_LOOP_JOIN)
+        const auto joinFunction = joinOperator.value()->getJoinFunction();
+        const auto bandJoinPredicate
+            = BandJoinPredicate::tryCreate(joinFunction, joinOperator.value()->getLeftSchema(), joinOperator.value()->getRightSchema());
+        /// Only the nested loop join restricts the pairs of records to the interval of their timestamps
+        const auto isIntervalJoin = std::dynamic_pointer_cast<Windowing::IntervalWindow>(joinOperator.value()->getWindowType()) != nullptr;
+        if (this->joinStrategy == StreamJoinStrategy::NESTED_LOOP_JOIN or isIntervalJoin)
         {
             tryInsert(traitSet, JoinImplementationTypeTrait{JoinImplementation::NESTED_LOOP_JOIN});
         }
-        else if (shallUseHashJoin(joinOperator.value()->getJoinFunction()))
+        else if (this->joinStrategy == StreamJoinStrategy::OPTIMIZER_CHOOSES)
         {
-            tryInsert(traitSet, JoinImplementationTypeTrait{JoinImplementation::HASH_JOIN});
+            const auto cheapest = chooseCheapestJoinImplementation(*joinOperator.value(), bandJoinPredicate);
+            tryInsert(
+                traitSet,
+                cheapest == JoinImplementation::HASH_JOIN ? createHashJoinTrait(*joinOperator.value())
+                                                          : JoinImplementationTypeTrait{cheapest});
         }
-        else
+        else if (this->joinStrategy == StreamJoinStrategy::SORT_MERGE_JOIN and bandJoinPredicate.has_value())
         {
-            tryInsert(traitSet, JoinImplementationTypeTrait{JoinImplementation::NESTED_LOOP_JOIN});
+            tryInsert(traitSet, JoinImplementationTypeTrait{JoinImplementation::SORT_MERGE_JOIN});
+        }
+        else if (this->joinStrategy == StreamJoinStrategy::HASH_JOIN and shallUseHashJoin(joinFunction))
+        {
+            tryInsert(traitSet, createHashJoinTrait(*joinOperator.value()));
+        }
+        else if (bandJoinPredicate.has_value())
+        {
+            /// Inequality and range predicates, e.g., `left.ts <= right.ts`, can not be evaluated by a hash join.
+            /// Instead of comparing all pairs of tuples via a NLJ, we sort both sides and only compare the tuples within the band.
+            tryInsert(traitSet, JoinImplementationTypeTrait{JoinImplementation::SORT_MERGE_JOIN});
             if (this->joinStrategy == StreamJoinStrategy::HASH_JOIN)
             {
                 NES_WARNING(
                     "Operator {} has not the HashJoinTrait, as the hash join is not supported for the join condition. Therefore, we "
-                    "fall-back to the NLJ!",
+                    "fall-back to the sort-merge join!",
                     logicalOperator);
             }
         }
+        else
+        {
+            tryInsert(traitSet, JoinImplementationTypeTrait{JoinImplementation::NESTED_LOOP_JOIN});
+            if (this->joinStrategy == StreamJoinStrategy::HASH_JOIN or this->joinStrategy == StreamJoinStrategy::SORT_MERGE_JOIN)
+            {
+                NES_WARNING(
+                    "Operator {} has not the {} trait, as the join is not supported for the join condition. Therefore, we "
+                    "fall-back to the NLJ!",
+                    logicalOperator,
+                    magic_enum::enum_name(this->joinStrategy));
+            }
+        }
     }
     else
     {
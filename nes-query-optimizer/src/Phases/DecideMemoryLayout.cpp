@@ -13,30 +13,148 @@
 */
 #include <Phases/DecideMemoryLayout.hpp>
 
+#include <memory>
+#include <optional>
 #include <ranges>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include <DataTypes/Schema.hpp>
+#include <Functions/FieldAccessLogicalFunction.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Iterators/BFSIterator.hpp>
 #include <Nautilus/Interface/BufferRef/LowerSchemaProvider.hpp>
+#include <Operators/BernoulliSampleLogicalOperator.hpp>
+#include <Operators/EventTimeWatermarkAssignerLogicalOperator.hpp>
+#include <Operators/IngestionTimeWatermarkAssignerLogicalOperator.hpp>
 #include <Operators/LogicalOperator.hpp>
+#include <Operators/LookupJoinLogicalOperator.hpp>
+#include <Operators/ProjectionLogicalOperator.hpp>
+#include <Operators/SelectionLogicalOperator.hpp>
+#include <Operators/Sources/SourceDescriptorLogicalOperator.hpp>
+#include <Operators/Windows/DeduplicationLogicalOperator.hpp>
+#include <Operators/Windows/JoinLogicalOperator.hpp>
+#include <Operators/Windows/ReservoirSampleLogicalOperator.hpp>
+#include <Operators/Windows/WindowedAggregationLogicalOperator.hpp>
 #include <Plans/LogicalPlan.hpp>
 #include <Traits/MemoryLayoutTypeTrait.hpp>
 #include <Traits/TraitSet.hpp>
+#include <WindowTypes/Measures/TimeCharacteristic.hpp>
+#include <WindowTypes/Types/TimeBasedWindowType.hpp>
 #include <ErrorHandling.hpp>
 
 namespace NES
 {
+
+namespace
+{
+void insertAccessedFields(std::unordered_set<std::string>& accessedFields, const LogicalFunction& logicalFunction)
+{
+    for (const auto& function : BFSRange<LogicalFunction>(logicalFunction))
+    {
+        if (const auto fieldAccess = function.tryGetAs<FieldAccessLogicalFunction>())
+        {
+            accessedFields.insert(fieldAccess.value()->getFieldName());
+        }
+    }
+}
+
+/// Returns the distinct fields of its input that the operator accesses, or nullopt if the operator reads whole tuples
+std::optional<std::unordered_set<std::string>> getAccessedFields(const LogicalOperator& logicalOperator)
+{
+    if (const auto selection = logicalOperator.tryGetAs<SelectionLogicalOperator>())
+    {
+        std::unordered_set<std::string> accessedFields;
+        insertAccessedFields(accessedFields, selection.value()->getPredicate());
+        return accessedFields;
+    }
+    if (const auto projection = logicalOperator.tryGetAs<ProjectionLogicalOperator>())
+    {
+        return projection.value()->getAccessedFields() | std::ranges::to<std::unordered_set>();
+    }
+    if (const auto aggregation = logicalOperator.tryGetAs<WindowedAggregationLogicalOperator>())
+    {
+        auto accessedFields = aggregation.value()->getGroupByKeyNames() | std::ranges::to<std::unordered_set>();
+        for (const auto& windowAggregation : aggregation.value()->getWindowAggregation())
+        {
+            accessedFields.insert(windowAggregation->getOnField().getFieldName());
+        }
+        const auto windowType = std::dynamic_pointer_cast<Windowing::TimeBasedWindowType>(aggregation.value()->getWindowType());
+        if (windowType != nullptr and windowType->getTimeCharacteristic().getType() == Windowing::TimeCharacteristic::Type::EventTime)
+        {
+            accessedFields.insert(windowType->getTimeCharacteristic().field.name);
+        }
+        return accessedFields;
+    }
+    if (const auto deduplication = logicalOperator.tryGetAs<DeduplicationLogicalOperator>())
+    {
+        /// Without keys, the deduplication compares whole records
+        if (deduplication.value()->getKeys().empty())
+        {
+            return std::nullopt;
+        }
+        std::unordered_set<std::string> accessedFields;
+        for (const auto& key : deduplication.value()->getKeys())
+        {
+            insertAccessedFields(accessedFields, key);
+        }
+        const auto windowType = std::dynamic_pointer_cast<Windowing::TimeBasedWindowType>(deduplication.value()->getWindowType());
+        if (windowType != nullptr and windowType->getTimeCharacteristic().getType() == Windowing::TimeCharacteristic::Type::EventTime)
+        {
+            accessedFields.insert(windowType->getTimeCharacteristic().field.name);
+        }
+        return accessedFields;
+    }
+    return std::nullopt;
+}
+
+MemoryLayoutType getPreferredInputMemoryLayout(const LogicalOperator& consumer)
+{
+    const auto accessedFields = getAccessedFields(consumer);
+    const auto inputSchemas = consumer.getInputSchemas();
+    if (not accessedFields.has_value() or inputSchemas.size() != 1 or inputSchemas.front().getNumberOfFields() < 2)
+    {
+        return MemoryLayoutType::ROW_LAYOUT;
+    }
+    const auto shareOfAccessedFields
+        = static_cast<double>(accessedFields->size()) / static_cast<double>(inputSchemas.front().getNumberOfFields());
+    if (shareOfAccessedFields <= DecideMemoryLayout::MAX_SHARE_OF_ACCESSED_FIELDS_FOR_COLUMNAR_LAYOUT)
+    {
+        return MemoryLayoutType::COLUMNAR_LAYOUT;
+    }
+    return MemoryLayoutType::ROW_LAYOUT;
+}
+}
+
 LogicalPlan DecideMemoryLayout::apply(const LogicalPlan& queryPlan)
 {
     PRECONDITION(queryPlan.getRootOperators().size() == 1, "Only single root operators are supported for now");
     PRECONDITION(not queryPlan.getRootOperators().empty(), "Query must have a sink root operator");
-    return LogicalPlan{queryPlan.getQueryId(), {apply(queryPlan.getRootOperators()[0])}};
+    /// The sink writes the tuples of its input as rows
+    return LogicalPlan{queryPlan.getQueryId(), {apply(queryPlan.getRootOperators()[0], MemoryLayoutType::ROW_LAYOUT)}};
 }
 
-LogicalOperator DecideMemoryLayout::apply(const LogicalOperator& logicalOperator)
+LogicalOperator DecideMemoryLayout::apply(const LogicalOperator& logicalOperator, const MemoryLayoutType preferredMemoryLayout)
 {
-    /// Iterating over all operators and setting the memory layout trait to row
+    /// Sources emit raw buffers that the input formatters parse regardless of the memory layout. Thus, all sources keep the row layout, so
+    /// that equal sources of merged queries remain shareable. Joins and reservoir samples keep the row layout, as they store and emit whole
+    /// tuples.
+    const auto keepsRowLayout = logicalOperator.tryGetAs<SourceDescriptorLogicalOperator>().has_value()
+        or logicalOperator.tryGetAs<JoinLogicalOperator>().has_value() or logicalOperator.tryGetAs<LookupJoinLogicalOperator>().has_value()
+        or logicalOperator.tryGetAs<ReservoirSampleLogicalOperator>().has_value();
+    const auto memoryLayout = keepsRowLayout ? MemoryLayoutType::ROW_LAYOUT : preferredMemoryLayout;
+
+    /// Watermark assigners and Bernoulli samples forward the tuples to their consumer, thus their input already follows what the consumer
+    /// reads
+    const auto forwardsInput = logicalOperator.tryGetAs<EventTimeWatermarkAssignerLogicalOperator>().has_value()
+        or logicalOperator.tryGetAs<IngestionTimeWatermarkAssignerLogicalOperator>().has_value()
+        or logicalOperator.tryGetAs<BernoulliSampleLogicalOperator>().has_value();
+    const auto inputMemoryLayout = forwardsInput ? memoryLayout : getPreferredInputMemoryLayout(logicalOperator);
     const auto children = logicalOperator.getChildren()
-        | std::views::transform([this](const LogicalOperator& child) { return apply(child); }) | std::ranges::to<std::vector>();
+        | std::views::transform([this, inputMemoryLayout](const LogicalOperator& child) { return apply(child, inputMemoryLayout); })
+        | std::ranges::to<std::vector>();
     auto traitSet = logicalOperator.getTraitSet();
-    tryInsert(traitSet, MemoryLayoutTypeTrait{MemoryLayoutType::ROW_LAYOUT});
+    tryInsert(traitSet, MemoryLayoutTypeTrait{memoryLayout});
     return logicalOperator.withChildren(children).withTraitSet(traitSet);
 }
 }
@@ -0,0 +1,178 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Phases/JoinCostModel.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <string>
+#include <DataTypes/DataType.hpp>
+#include <Iterators/BFSIterator.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Operators/Sources/SourceDescriptorLogicalOperator.hpp>
+#include <Operators/Sources/SourceNameLogicalOperator.hpp>
+#include <Phases/BandJoinPredicate.hpp>
+#include <Traits/ImplementationTypeTrait.hpp>
+#include <fmt/format.h>
+#include <SourceStatistics.hpp>
+
+namespace NES
+{
+
+namespace
+{
+double sortCosts(const JoinInputEstimate& input)
+{
+    return input.tuplesPerWindow
+        * (JoinCostModel::SORT_ENTRY_COST + (std::log2(std::max(input.tuplesPerWindow, 2.0)) * JoinCostModel::COMPARISON_COST));
+}
+
+/// Number of pairs of tuples with the same keys, assuming that the keys are uniformly distributed
+double numberOfPairsWithSameKeys(const JoinInputEstimate& left, const JoinInputEstimate& right)
+{
+    const auto distinctKeys = std::max({left.distinctKeys, right.distinctKeys, 1.0});
+    return left.tuplesPerWindow * right.tuplesPerWindow / distinctKeys;
+}
+
+std::string formatCosts(const std::optional<double>& costs)
+{
+    return costs.has_value() ? fmt::format("{:.0f}", *costs) : "n/a";
+}
+
+std::optional<std::string> getLogicalSourceName(const LogicalOperator& logicalOperator)
+{
+    if (const auto sourceDescriptorOperator = logicalOperator.tryGetAs<SourceDescriptorLogicalOperator>())
+    {
+        return sourceDescriptorOperator.value()->getSourceDescriptor().getLogicalSource().getLogicalSourceName();
+    }
+    if (const auto sourceNameOperator = logicalOperator.tryGetAs<SourceNameLogicalOperator>())
+    {
+        return sourceNameOperator.value()->getLogicalSourceName();
+    }
+    return std::nullopt;
+}
+}
+
+JoinImplementation JoinCostEstimate::getCheapest() const
+{
+    auto cheapest = JoinImplementation::NESTED_LOOP_JOIN;
+    auto cheapestCosts = nestedLoopJoin;
+    if (sortMergeJoin.has_value() and *sortMergeJoin <= cheapestCosts)
+    {
+        cheapest = JoinImplementation::SORT_MERGE_JOIN;
+        cheapestCosts = *sortMergeJoin;
+    }
+    if (hashJoin.has_value() and *hashJoin <= cheapestCosts)
+    {
+        cheapest = JoinImplementation::HASH_JOIN;
+    }
+    return cheapest;
+}
+
+std::string JoinCostEstimate::explain() const
+{
+    return fmt::format(
+        "NESTED_LOOP_JOIN: {}, HASH_JOIN: {}, SORT_MERGE_JOIN: {}",
+        formatCosts(nestedLoopJoin),
+        formatCosts(hashJoin),
+        formatCosts(sortMergeJoin));
+}
+
+JoinCostEstimate JoinCostModel::estimate(
+    const JoinInputEstimate& left,
+    const JoinInputEstimate& right,
+    const bool hashJoinIsApplicable,
+    const std::optional<BandJoinPredicate>& bandJoinPredicate)
+{
+    const auto numberOfPairs = left.tuplesPerWindow * right.tuplesPerWindow;
+    const auto pairCosts = COMPARISON_COST + ((left.tupleSizeInBytes + right.tupleSizeInBytes) / CACHE_LINE_SIZE * CACHE_LINE_COST);
+
+    JoinCostEstimate estimate{.nestedLoopJoin = numberOfPairs * pairCosts, .hashJoin = std::nullopt, .sortMergeJoin = std::nullopt};
+    if (hashJoinIsApplicable)
+    {
+        const auto hashCosts = (left.tuplesPerWindow + right.tuplesPerWindow) * HASH_COST;
+        estimate.hashJoin = hashCosts + (numberOfPairsWithSameKeys(left, right) * pairCosts) + HASH_MAP_COST;
+    }
+    if (bandJoinPredicate.has_value())
+    {
+        /// A band that is bounded on both sides only contains the tuples with the same sort key
+        const auto numberOfCandidates = bandJoinPredicate->rightIsLowerBoundedByLeft and bandJoinPredicate->rightIsUpperBoundedByLeft
+            ? numberOfPairsWithSameKeys(left, right)
+            : numberOfPairs * NON_EQUI_SELECTIVITY;
+        const auto mergeCosts = (left.tuplesPerWindow + right.tuplesPerWindow) * COMPARISON_COST;
+        estimate.sortMergeJoin = sortCosts(left) + sortCosts(right) + mergeCosts + (numberOfCandidates * pairCosts);
+    }
+    return estimate;
+}
+
+double JoinCostModel::estimateStatePerSlice(const JoinInputEstimate& left, const JoinInputEstimate& right)
+{
+    return (left.tuplesPerWindow * left.tupleSizeInBytes) + (right.tuplesPerWindow * right.tupleSizeInBytes);
+}
+
+HashJoinBuildSide JoinCostModel::chooseHashJoinBuildSide(const double leftTuplesPerSecond, const double rightTuplesPerSecond)
+{
+    if (rightTuplesPerSecond > ASYMMETRIC_HASH_JOIN_FACTOR * leftTuplesPerSecond)
+    {
+        return HashJoinBuildSide::LEFT;
+    }
+    if (leftTuplesPerSecond > ASYMMETRIC_HASH_JOIN_FACTOR * rightTuplesPerSecond)
+    {
+        return HashJoinBuildSide::RIGHT;
+    }
+    return HashJoinBuildSide::BOTH;
+}
+
+std::optional<double> JoinCostModel::getTuplesPerSecond(const LogicalOperator& joinInput, const SourceStatistics& sourceStatistics)
+{
+    double tuplesPerSecond = 0;
+    for (const auto& logicalOperator : BFSRange<LogicalOperator>(joinInput))
+    {
+        if (not logicalOperator.getChildren().empty())
+        {
+            continue;
+        }
+        const auto logicalSourceName = getLogicalSourceName(logicalOperator);
+        const auto sourceTuplesPerSecond = logicalSourceName.and_then(
+            [&sourceStatistics](const std::string& name) { return sourceStatistics.getTuplesPerSecond(name); });
+        if (not sourceTuplesPerSecond.has_value())
+        {
+            return std::nullopt;
+        }
+        tuplesPerSecond += *sourceTuplesPerSecond;
+    }
+    return tuplesPerSecond;
+}
+
+double JoinCostModel::getDomainSize(const DataType& dataType)
+{
+    switch (dataType.type)
+    {
+        case DataType::Type::BOOLEAN:
+            return 2;
+        case DataType::Type::UINT8:
+        case DataType::Type::INT8:
+        case DataType::Type::CHAR:
+            return 256;
+        case DataType::Type::UINT16:
+        case DataType::Type::INT16:
+            return 65536;
+        default:
+            return std::numeric_limits<double>::infinity();
+    }
+}
+
+}
@@ -0,0 +1,218 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Phases/MergeQueryPlans.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/DataTypeProvider.hpp>
+#include <Functions/ArithmeticalFunctions/SubLogicalFunction.hpp>
+#include <Functions/BooleanFunctions/EqualsLogicalFunction.hpp>
+#include <Functions/ConstantValueLogicalFunction.hpp>
+#include <Functions/FieldAccessLogicalFunction.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Operators/SelectionLogicalOperator.hpp>
+#include <Operators/Windows/WindowedAggregationLogicalOperator.hpp>
+#include <Plans/LogicalPlan.hpp>
+#include <Traits/SharedWindowSizesTrait.hpp>
+#include <WindowTypes/Types/TumblingWindow.hpp>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+namespace
+{
+const Windowing::TumblingWindow* getTumblingWindow(const LogicalOperator& logicalOperator)
+{
+    const auto aggregation = logicalOperator.tryGetAs<WindowedAggregationLogicalOperator>();
+    return aggregation.has_value() ? dynamic_cast<const Windowing::TumblingWindow*>((*aggregation)->getWindowType().get()) : nullptr;
+}
+
+/// Apart from the window size, the aggregations must be equal and read from the same child
+bool canShareWindowSlicing(const LogicalOperator& lhs, const LogicalOperator& rhs)
+{
+    const auto* lhsWindow = getTumblingWindow(lhs);
+    const auto* rhsWindow = getTumblingWindow(rhs);
+    if (lhsWindow == nullptr or rhsWindow == nullptr or lhsWindow->getTimeCharacteristic() != rhsWindow->getTimeCharacteristic())
+    {
+        return false;
+    }
+    const auto lhsAggregation = lhs.getAs<WindowedAggregationLogicalOperator>();
+    auto rhsWithWindowOfLhs = *rhs.getAs<WindowedAggregationLogicalOperator>();
+    rhsWithWindowOfLhs.setWindowType(lhsAggregation->getWindowType());
+    return rhsWithWindowOfLhs == *lhsAggregation
+        and std::ranges::equal(lhs.getChildren(), rhs.getChildren(), {}, &LogicalOperator::getId, &LogicalOperator::getId);
+}
+
+/// Rewrites the merged plan, such that the aggregations of a group of aggregations that can share their window slicing read from a single
+/// aggregation over all window sizes of the group. Operators without a rewritten descendant keep their ids, thus they remain shared.
+class ShareWindowSlicing
+{
+public:
+    explicit ShareWindowSlicing(const std::vector<LogicalOperator>& mergedOperators)
+    {
+        std::vector<std::vector<LogicalOperator>> groups;
+        for (const auto& mergedOperator : mergedOperators | std::views::filter(getTumblingWindow))
+        {
+            const auto group = std::ranges::find_if(
+                groups,
+                [&mergedOperator](const std::vector<LogicalOperator>& aggregations)
+                { return canShareWindowSlicing(aggregations.front(), mergedOperator); });
+            if (group == groups.end())
+            {
+                groups.push_back({mergedOperator});
+            }
+            else
+            {
+                group->push_back(mergedOperator);
+            }
+        }
+
+        for (const auto& aggregations : groups | std::views::filter([](const auto& aggregations) { return aggregations.size() > 1; }))
+        {
+            auto windowSizes = aggregations
+                | std::views::transform([](const LogicalOperator& aggregation)
+                                        { return getTumblingWindow(aggregation)->getSize().getTime(); })
+                | std::ranges::to<std::vector>();
+            std::ranges::sort(windowSizes);
+            windowSizes.erase(std::ranges::unique(windowSizes).begin(), windowSizes.end());
+            for (const auto& aggregation : aggregations)
+            {
+                groupOfAggregation.emplace(aggregation.getId(), windowSizesOfGroups.size());
+            }
+            windowSizesOfGroups.push_back(std::move(windowSizes));
+        }
+        sharedAggregationOfGroups.resize(windowSizesOfGroups.size());
+    }
+
+    LogicalOperator rewrite(const LogicalOperator& logicalOperator)
+    {
+        if (const auto rewritten = rewrittenOperators.find(logicalOperator.getId()); rewritten != rewrittenOperators.end())
+        {
+            return rewritten->second;
+        }
+        const auto originalChildren = logicalOperator.getChildren();
+        auto children = originalChildren
+            | std::views::transform([this](const LogicalOperator& child) { return rewrite(child); }) | std::ranges::to<std::vector>();
+
+        auto rewritten = logicalOperator;
+        if (const auto group = groupOfAggregation.find(logicalOperator.getId()); group != groupOfAggregation.end())
+        {
+            rewritten = selectWindowSize(logicalOperator, getSharedAggregation(group->second, logicalOperator, std::move(children)));
+        }
+        else if (not std::ranges::equal(children, originalChildren, {}, &LogicalOperator::getId, &LogicalOperator::getId))
+        {
+            rewritten = logicalOperator.withChildren(std::move(children));
+        }
+        return rewrittenOperators.emplace(logicalOperator.getId(), std::move(rewritten)).first->second;
+    }
+
+private:
+    /// The first aggregation of the group becomes the shared aggregation, as all aggregations of the group are equal but for their size
+    LogicalOperator getSharedAggregation(const size_t group, const LogicalOperator& aggregation, std::vector<LogicalOperator> children)
+    {
+        auto& sharedAggregation = sharedAggregationOfGroups[group];
+        if (not sharedAggregation.has_value())
+        {
+            auto traitSet = aggregation.getTraitSet();
+            const bool inserted = traitSet.tryInsert(SharedWindowSizesTrait{windowSizesOfGroups[group]});
+            INVARIANT(inserted, "The aggregation {} already shares its window sizes", aggregation.getId());
+            sharedAggregation = aggregation.withChildren(std::move(children)).withTraitSet(std::move(traitSet));
+        }
+        return sharedAggregation.value();
+    }
+
+    /// Keeps the windows of the aggregation's size from the windows of all sizes of the shared aggregation
+    static LogicalOperator selectWindowSize(const LogicalOperator& aggregation, const LogicalOperator& sharedAggregation)
+    {
+        const auto windowedAggregation = aggregation.getAs<WindowedAggregationLogicalOperator>();
+        const auto windowLength = SubLogicalFunction(
+            LogicalFunction{FieldAccessLogicalFunction(windowedAggregation->getWindowEndFieldName())},
+            LogicalFunction{FieldAccessLogicalFunction(windowedAggregation->getWindowStartFieldName())});
+        const auto windowSize = ConstantValueLogicalFunction(
+            DataTypeProvider::provideDataType(DataType::Type::UINT64), std::to_string(getTumblingWindow(aggregation)->getSize().getTime()));
+        const auto selection = SelectionLogicalOperator(LogicalFunction{EqualsLogicalFunction(windowLength, windowSize)})
+                                   .withInferredSchema({sharedAggregation.getOutputSchema()})
+                                   .withChildren({sharedAggregation})
+                                   .withTraitSet(aggregation.getTraitSet());
+        return LogicalOperator{selection};
+    }
+
+    std::unordered_map<OperatorId, size_t> groupOfAggregation;
+    std::vector<std::vector<uint64_t>> windowSizesOfGroups;
+    std::vector<std::optional<LogicalOperator>> sharedAggregationOfGroups;
+    std::unordered_map<OperatorId, LogicalOperator> rewrittenOperators;
+};
+}
+
+LogicalPlan MergeQueryPlans::apply(const QueryId mergedQueryId, const std::vector<LogicalPlan>& queryPlans)
+{
+    PRECONDITION(not queryPlans.empty(), "Expects at least one query plan to merge");
+    std::vector<LogicalOperator> roots;
+    for (const auto& queryPlan : queryPlans)
+    {
+        operatorsOfCurrentQuery.clear();
+        for (const auto& root : queryPlan.getRootOperators())
+        {
+            const auto children = root.getChildren()
+                | std::views::transform([this](const LogicalOperator& child) { return merge(child); }) | std::ranges::to<std::vector>();
+            roots.push_back(root.withChildren(children));
+        }
+    }
+
+    ShareWindowSlicing shareWindowSlicing{mergedOperators};
+    for (auto& root : roots)
+    {
+        const auto children = root.getChildren()
+            | std::views::transform([&shareWindowSlicing](const LogicalOperator& child) { return shareWindowSlicing.rewrite(child); })
+            | std::ranges::to<std::vector>();
+        root = root.withChildren(children);
+    }
+    return LogicalPlan{mergedQueryId, std::move(roots)};
+}
+
+LogicalOperator MergeQueryPlans::merge(const LogicalOperator& logicalOperator)
+{
+    /// Merging bottom-up, equal operators of different queries have the very same children in the merged plan
+    const auto children = logicalOperator.getChildren()
+        | std::views::transform([this](const LogicalOperator& child) { return merge(child); }) | std::ranges::to<std::vector>();
+    const auto hasMergedChildren = [&children](const LogicalOperator& mergedOperator)
+    { return std::ranges::equal(mergedOperator.getChildren(), children, {}, &LogicalOperator::getId, &LogicalOperator::getId); };
+    const auto isShareable = [&](const LogicalOperator& mergedOperator)
+    {
+        return not operatorsOfCurrentQuery.contains(mergedOperator.getId()) and mergedOperator == logicalOperator
+            and hasMergedChildren(mergedOperator);
+    };
+    if (const auto shared = std::ranges::find_if(mergedOperators, isShareable); shared != mergedOperators.end())
+    {
+        operatorsOfCurrentQuery.insert(shared->getId());
+        return *shared;
+    }
+    /// Replacing the children assigns a new id, thus the ids of the merged plan are unique, even if the same plan is merged twice
+    const auto& mergedOperator = mergedOperators.emplace_back(logicalOperator.withChildren(children));
+    operatorsOfCurrentQuery.insert(mergedOperator.getId());
+    return mergedOperator;
+}
+
+}
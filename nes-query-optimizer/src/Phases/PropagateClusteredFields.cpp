@@ -0,0 +1,139 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Phases/PropagateClusteredFields.hpp>
+
+#include <algorithm>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <vector>
+#include <Functions/FieldAccessLogicalFunction.hpp>
+#include <Operators/BernoulliSampleLogicalOperator.hpp>
+#include <Operators/EventTimeWatermarkAssignerLogicalOperator.hpp>
+#include <Operators/IngestionTimeWatermarkAssignerLogicalOperator.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Operators/ProjectionLogicalOperator.hpp>
+#include <Operators/SelectionLogicalOperator.hpp>
+#include <Operators/Sources/SourceDescriptorLogicalOperator.hpp>
+#include <Plans/LogicalPlan.hpp>
+#include <Sources/SourceDescriptor.hpp>
+#include <Traits/ClusteredFieldsTrait.hpp>
+#include <Traits/TraitSet.hpp>
+#include <Util/Strings.hpp>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+namespace
+{
+std::vector<std::string> getClusteredFields(const LogicalOperator& logicalOperator)
+{
+    const auto clusteredFields = logicalOperator.getTraitSet().tryGet<ClusteredFieldsTrait>();
+    return clusteredFields.has_value() ? clusteredFields.value()->fieldNames : std::vector<std::string>{};
+}
+
+/// Resolves the declared fields in the schema of the source, as the declaration may omit the qualifier of the field names
+std::vector<std::string> getClusteredFieldsOfSource(const SourceDescriptorLogicalOperator& source)
+{
+    const auto declaredFields = source.getSourceDescriptor().tryGetFromConfig(SourceDescriptor::CLUSTERED_BY).value_or("");
+    std::vector<std::string> clusteredFields;
+    for (const auto declaredField : splitOnMultipleDelimiters(declaredFields, {','}))
+    {
+        const auto fieldName = trimWhiteSpaces(declaredField);
+        if (fieldName.empty())
+        {
+            continue;
+        }
+        const auto field = source.getOutputSchema().getFieldByName(std::string(fieldName));
+        if (not field.has_value())
+        {
+            throw InvalidConfigParameter("The source clusters the field {}, which its schema does not contain", fieldName);
+        }
+        clusteredFields.emplace_back(field->name);
+    }
+    return clusteredFields;
+}
+
+/// A projection forwards a clustered field, if it accesses the field without changing its values
+std::vector<std::string> getClusteredFieldsOfProjection(const ProjectionLogicalOperator& projection, const std::vector<std::string>& input)
+{
+    std::vector<std::string> clusteredFields;
+    std::vector<std::string> overwrittenFields;
+    for (const auto& [identifier, function] : projection.getProjections())
+    {
+        const auto fieldAccess = function.tryGetAs<FieldAccessLogicalFunction>();
+        const auto outputName = identifier.has_value() ? std::make_optional(identifier->getFieldName())
+            : fieldAccess.has_value()                  ? std::make_optional(fieldAccess.value()->getFieldName())
+                                                       : std::nullopt;
+        if (fieldAccess.has_value() and std::ranges::contains(input, fieldAccess.value()->getFieldName()))
+        {
+            clusteredFields.emplace_back(outputName.value());
+        }
+        else if (outputName.has_value())
+        {
+            overwrittenFields.emplace_back(outputName.value());
+        }
+    }
+    if (projection.hasAsterisk())
+    {
+        for (const auto& fieldName : input)
+        {
+            if (not std::ranges::contains(overwrittenFields, fieldName) and not std::ranges::contains(clusteredFields, fieldName))
+            {
+                clusteredFields.emplace_back(fieldName);
+            }
+        }
+    }
+    return clusteredFields;
+}
+}
+
+LogicalPlan PropagateClusteredFields::apply(const LogicalPlan& queryPlan)
+{
+    PRECONDITION(queryPlan.getRootOperators().size() == 1, "Only single root operators are supported for now");
+    return queryPlan.withRootOperators({apply(queryPlan.getRootOperators()[0])});
+}
+
+LogicalOperator PropagateClusteredFields::apply(const LogicalOperator& logicalOperator)
+{
+    const auto children = logicalOperator.getChildren()
+        | std::views::transform([this](const LogicalOperator& child) { return apply(child); }) | std::ranges::to<std::vector>();
+
+    std::vector<std::string> clusteredFields;
+    if (const auto source = logicalOperator.tryGetAs<SourceDescriptorLogicalOperator>())
+    {
+        clusteredFields = getClusteredFieldsOfSource(*source.value());
+    }
+    else if (
+        logicalOperator.tryGetAs<SelectionLogicalOperator>().has_value()
+        or logicalOperator.tryGetAs<BernoulliSampleLogicalOperator>().has_value()
+        or logicalOperator.tryGetAs<EventTimeWatermarkAssignerLogicalOperator>().has_value()
+        or logicalOperator.tryGetAs<IngestionTimeWatermarkAssignerLogicalOperator>().has_value())
+    {
+        clusteredFields = getClusteredFields(children.at(0));
+    }
+    else if (const auto projection = logicalOperator.tryGetAs<ProjectionLogicalOperator>())
+    {
+        clusteredFields = getClusteredFieldsOfProjection(*projection.value(), getClusteredFields(children.at(0)));
+    }
+
+    auto traitSet = logicalOperator.getTraitSet();
+    if (not clusteredFields.empty())
+    {
+        tryInsert(traitSet, ClusteredFieldsTrait{std::move(clusteredFields)});
+    }
+    return logicalOperator.withChildren(children).withTraitSet(traitSet);
+}
+}
@@ -0,0 +1,480 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Phases/ReorderJoins.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <DataTypes/Schema.hpp>
+#include <Functions/BooleanFunctions/AndLogicalFunction.hpp>
+#include <Functions/BooleanFunctions/EqualsLogicalFunction.hpp>
+#include <Functions/FieldAccessLogicalFunction.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Iterators/BFSIterator.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Operators/ProjectionLogicalOperator.hpp>
+#include <Operators/Windows/JoinLogicalOperator.hpp>
+#include <Phases/JoinCostModel.hpp>
+#include <Plans/LogicalPlan.hpp>
+#include <Traits/JoinStateEstimateTrait.hpp>
+#include <Traits/OutputOriginIdsTrait.hpp>
+#include <Traits/Trait.hpp>
+#include <Traits/TraitSet.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <WindowTypes/Measures/TimeCharacteristic.hpp>
+#include <WindowTypes/Types/TimeBasedWindowType.hpp>
+#include <WindowTypes/Types/TumblingWindow.hpp>
+#include <ErrorHandling.hpp>
+#include <SourceStatistics.hpp>
+
+namespace NES
+{
+
+namespace
+{
+/// A set of the inputs of a nest of joins, as a bitmask over the indexes of the inputs
+using InputSet = uint32_t;
+/// Maps the inputs of every join of an order to the inputs of its left side
+using JoinOrder = std::map<InputSet, InputSet>;
+
+/// Every join adds the start and the end of its window to the joined tuples
+constexpr double WINDOW_FIELDS_SIZE_IN_BYTES = 2 * sizeof(uint64_t);
+
+/// Consecutive joins, whose inputs the phase may reorder. The joins are in pre-order, i.e., the first join is the topmost one.
+struct JoinNest
+{
+    std::vector<JoinLogicalOperator> joins;
+    std::vector<LogicalOperator> inputs;
+    JoinOrder order;
+    std::vector<LogicalFunction> conjuncts;
+};
+
+void collectConjuncts(const LogicalFunction& function, std::vector<LogicalFunction>& conjuncts)
+{
+    if (function.tryGetAs<AndLogicalFunction>().has_value())
+    {
+        for (const auto& child : function.getChildren())
+        {
+            collectConjuncts(child, conjuncts);
+        }
+    }
+    else
+    {
+        conjuncts.emplace_back(function);
+    }
+}
+
+/// Tumbling windows only join the tuples of the same window. Thus, nested joins over the same tumbling windows produce the same tuples in
+/// every order. We require event time, as the ingestion time of the tuples that a join emits is not the ingestion time of its inputs.
+bool joinsWithinTumblingWindows(const JoinLogicalOperator& join)
+{
+    const auto window = std::dynamic_pointer_cast<Windowing::TumblingWindow>(join.getWindowType());
+    return join.getJoinType() == JoinLogicalOperator::JoinType::INNER_JOIN and window != nullptr
+        and window->getTimeCharacteristic().getType() == Windowing::TimeCharacteristic::Type::EventTime;
+}
+
+/// The type inference qualifies the timestamp field of each join with the source of its input, thus we compare the unqualified fields
+bool haveSameTumblingWindows(const JoinLogicalOperator& join, const JoinLogicalOperator& other)
+{
+    const auto window = std::dynamic_pointer_cast<Windowing::TumblingWindow>(join.getWindowType());
+    const auto otherWindow = std::dynamic_pointer_cast<Windowing::TumblingWindow>(other.getWindowType());
+    return window->getSize() == otherWindow->getSize()
+        and window->getTimeCharacteristic().field.getUnqualifiedName() == otherWindow->getTimeCharacteristic().field.getUnqualifiedName()
+        and window->getTimeCharacteristic().getTimeUnit() == otherWindow->getTimeCharacteristic().getTimeUnit();
+}
+
+/// Adds the join and all joins below it that we can reorder together with the topmost join of the nest
+InputSet collectNest(const LogicalOperator& logicalOperator, JoinNest& nest)
+{
+    const auto join = logicalOperator.tryGetAs<JoinLogicalOperator>();
+    const auto extendsNest = join.has_value()
+        and (nest.joins.empty()
+             or (nest.joins.size() + 1 < ReorderJoins::MAX_REORDERED_JOIN_INPUTS and joinsWithinTumblingWindows(nest.joins.front())
+                 and joinsWithinTumblingWindows(*join.value()) and haveSameTumblingWindows(nest.joins.front(), *join.value())));
+    if (not extendsNest)
+    {
+        nest.inputs.push_back(logicalOperator);
+        return InputSet{1} << (nest.inputs.size() - 1);
+    }
+    nest.joins.push_back(*join.value());
+    collectConjuncts(join.value()->getJoinFunction(), nest.conjuncts);
+    const auto children = logicalOperator.getChildren();
+    const auto left = collectNest(children.at(0), nest);
+    const auto right = collectNest(children.at(1), nest);
+    nest.order.emplace(left | right, left);
+    return left | right;
+}
+
+bool isSubsetOf(const InputSet inputs, const InputSet otherInputs)
+{
+    return (inputs & ~otherInputs) == 0;
+}
+
+/// Estimates the tuples and the state per slice of the joins of a nest, for every order of the joins
+class JoinGraph
+{
+public:
+    JoinGraph(const JoinNest& nest, const std::vector<double>& inputTuplesPerSlice) : conjuncts(nest.conjuncts)
+    {
+        const auto numberOfInputs = nest.inputs.size();
+        reorderable = std::ranges::all_of(nest.joins, joinsWithinTumblingWindows);
+        const auto findInput = [&](const std::string& fieldName) -> std::optional<size_t>
+        {
+            const auto input = std::ranges::find_if(
+                nest.inputs, [&](const LogicalOperator& input) { return input.getOutputSchema().contains(fieldName); });
+            if (input == nest.inputs.end())
+            {
+                return std::nullopt;
+            }
+            return static_cast<size_t>(std::ranges::distance(nest.inputs.begin(), input));
+        };
+
+        std::vector<double> selectivities;
+        for (const auto& conjunct : conjuncts)
+        {
+            InputSet inputsOfConjunct = 0;
+            for (const auto& function : BFSRange<LogicalFunction>(conjunct))
+            {
+                if (const auto fieldAccess = function.tryGetAs<FieldAccessLogicalFunction>())
+                {
+                    const auto input = findInput(fieldAccess.value()->getFieldName());
+                    /// Fields of the windows of the joins within the nest only exist in the order of the query
+                    reorderable = reorderable and input.has_value();
+                    inputsOfConjunct |= input.has_value() ? InputSet{1} << *input : 0;
+                }
+            }
+            reorderable = reorderable and std::popcount(inputsOfConjunct) >= 2;
+            conjunctInputs.push_back(inputsOfConjunct);
+            selectivities.push_back(JoinCostModel::NON_EQUI_SELECTIVITY);
+
+            /// An equality of two fields selects one out of the distinct keys of the larger of both inputs
+            const auto children = conjunct.getChildren();
+            if (conjunct.tryGetAs<EqualsLogicalFunction>().has_value() and children.size() == 2)
+            {
+                const auto distinctKeys = [&](const LogicalFunction& child) -> std::optional<double>
+                {
+                    const auto fieldAccess = child.tryGetAs<FieldAccessLogicalFunction>();
+                    const auto input = fieldAccess.and_then([&](const auto& field) { return findInput(field->getFieldName()); });
+                    if (not input.has_value())
+                    {
+                        return std::nullopt;
+                    }
+                    return std::min(inputTuplesPerSlice.at(*input), JoinCostModel::getDomainSize(child.getDataType()));
+                };
+                const auto leftKeys = distinctKeys(children[0]);
+                const auto rightKeys = distinctKeys(children[1]);
+                if (leftKeys.has_value() and rightKeys.has_value())
+                {
+                    selectivities.back() = 1 / std::max({*leftKeys, *rightKeys, 1.0});
+                }
+            }
+        }
+
+        const auto numberOfInputSets = InputSet{1} << numberOfInputs;
+        tuplesPerSlice.resize(numberOfInputSets, 1);
+        tupleSizes.resize(numberOfInputSets, 0);
+        for (InputSet inputs = 1; inputs < numberOfInputSets; ++inputs)
+        {
+            for (size_t input = 0; input < numberOfInputs; ++input)
+            {
+                if ((inputs & (InputSet{1} << input)) != 0)
+                {
+                    tuplesPerSlice[inputs] *= inputTuplesPerSlice.at(input);
+                    tupleSizes[inputs] += static_cast<double>(nest.inputs.at(input).getOutputSchema().getSizeOfSchemaInBytes());
+                }
+            }
+            tupleSizes[inputs] += (std::popcount(inputs) - 1) * WINDOW_FIELDS_SIZE_IN_BYTES;
+            for (size_t conjunct = 0; conjunct < conjuncts.size(); ++conjunct)
+            {
+                if (isSubsetOf(conjunctInputs[conjunct], inputs))
+                {
+                    tuplesPerSlice[inputs] *= selectivities[conjunct];
+                }
+            }
+        }
+    }
+
+    /// False, if the nest contains a join that we must not reorder, or a conjunct that does not join the inputs of the nest
+    [[nodiscard]] bool isReorderable() const { return reorderable; }
+
+    [[nodiscard]] double estimateState(const InputSet left, const InputSet right) const
+    {
+        return JoinCostModel::estimateStatePerSlice(
+            {.tuplesPerWindow = tuplesPerSlice[left], .tupleSizeInBytes = tupleSizes[left], .distinctKeys = tuplesPerSlice[left]},
+            {.tuplesPerWindow = tuplesPerSlice[right], .tupleSizeInBytes = tupleSizes[right], .distinctKeys = tuplesPerSlice[right]});
+    }
+
+    [[nodiscard]] double getCost(const JoinOrder& order) const
+    {
+        double cost = 0;
+        for (const auto& [inputs, left] : order)
+        {
+            cost += estimateState(left, inputs & ~left);
+        }
+        return cost;
+    }
+
+    /// Enumerates all splits of all sets of inputs from the smallest to the largest set, i.e., every set of inputs is joined in its
+    /// cheapest order before it becomes the side of a larger join. The left side contains the first input, which avoids enumerating both
+    /// sides of a split and keeps the inputs in the order of the query, if their order does not matter.
+    [[nodiscard]] std::optional<JoinOrder> findCheapestOrder(const InputSet allInputs) const
+    {
+        std::vector<std::optional<double>> costs(allInputs + 1);
+        std::vector<InputSet> leftSides(allInputs + 1);
+        for (InputSet input = 1; input <= allInputs; input <<= 1)
+        {
+            costs[input] = 0;
+        }
+        for (InputSet inputs = 1; inputs <= allInputs; ++inputs)
+        {
+            const InputSet firstInput = inputs & (~inputs + 1);
+            for (InputSet left = (inputs - 1) & inputs; left != 0; left = (left - 1) & inputs)
+            {
+                const InputSet right = inputs & ~left;
+                if ((left & firstInput) == 0 or not costs[left].has_value() or not costs[right].has_value() or not connects(left, right))
+                {
+                    continue;
+                }
+                const auto cost = *costs[left] + *costs[right] + estimateState(left, right);
+                if (not costs[inputs].has_value() or cost < *costs[inputs])
+                {
+                    costs[inputs] = cost;
+                    leftSides[inputs] = left;
+                }
+            }
+        }
+        if (not costs[allInputs].has_value())
+        {
+            return std::nullopt;
+        }
+
+        JoinOrder order;
+        std::vector<InputSet> pending{allInputs};
+        while (not pending.empty())
+        {
+            const auto inputs = pending.back();
+            pending.pop_back();
+            if (std::has_single_bit(inputs))
+            {
+                continue;
+            }
+            order.emplace(inputs, leftSides[inputs]);
+            pending.push_back(leftSides[inputs]);
+            pending.push_back(inputs & ~leftSides[inputs]);
+        }
+        return order;
+    }
+
+    /// The join of both sides evaluates all conjuncts that join an input of the left side with an input of the right side
+    [[nodiscard]] LogicalFunction getJoinFunction(const InputSet left, const InputSet right) const
+    {
+        std::optional<LogicalFunction> joinFunction;
+        for (size_t conjunct = 0; conjunct < conjuncts.size(); ++conjunct)
+        {
+            if (joins(conjunctInputs[conjunct], left, right))
+            {
+                joinFunction = joinFunction.has_value() ? LogicalFunction{AndLogicalFunction(*joinFunction, conjuncts[conjunct])}
+                                                        : conjuncts[conjunct];
+            }
+        }
+        INVARIANT(joinFunction.has_value(), "Expected a conjunct that joins both sides");
+        return *joinFunction;
+    }
+
+private:
+    static bool joins(const InputSet inputsOfConjunct, const InputSet left, const InputSet right)
+    {
+        return isSubsetOf(inputsOfConjunct, left | right) and (inputsOfConjunct & left) != 0 and (inputsOfConjunct & right) != 0;
+    }
+
+    [[nodiscard]] bool connects(const InputSet left, const InputSet right) const
+    {
+        return std::ranges::any_of(conjunctInputs, [&](const InputSet inputsOfConjunct) { return joins(inputsOfConjunct, left, right); });
+    }
+
+    std::vector<LogicalFunction> conjuncts;
+    std::vector<InputSet> conjunctInputs;
+    bool reorderable = true;
+    /// Indexed by the set of inputs
+    std::vector<double> tuplesPerSlice;
+    std::vector<double> tupleSizes;
+};
+
+/// The type inference resolves the timestamp field of a window against the inputs of its join. Thus, a join with other inputs needs a
+/// window that refers to the unqualified timestamp field.
+std::shared_ptr<Windowing::WindowType> withUnqualifiedTimestamp(const std::shared_ptr<Windowing::WindowType>& windowType)
+{
+    const auto window = std::dynamic_pointer_cast<Windowing::TumblingWindow>(windowType);
+    INVARIANT(window != nullptr, "Only joins over tumbling windows are reordered");
+    auto timeCharacteristic = window->getTimeCharacteristic();
+    timeCharacteristic.field.name = timeCharacteristic.field.getUnqualifiedName();
+    return std::make_shared<Windowing::TumblingWindow>(timeCharacteristic, window->getSize());
+}
+
+uint64_t toBytes(const double state)
+{
+    return state < 0x1p64 ? static_cast<uint64_t>(state) : std::numeric_limits<uint64_t>::max();
+}
+
+/// Joins the inputs in the given order. The joins take the traits, e.g., the origin ids, of the joins of the query in pre-order.
+LogicalOperator buildJoins(
+    const JoinNest& nest,
+    const JoinGraph& graph,
+    const JoinOrder& order,
+    const InputSet inputs,
+    const bool keepsJoinFunctions,
+    size_t& nextJoin)
+{
+    if (std::has_single_bit(inputs))
+    {
+        return nest.inputs.at(static_cast<size_t>(std::countr_zero(inputs)));
+    }
+    const auto left = order.at(inputs);
+    const auto right = inputs & ~left;
+    const auto& originalJoin = nest.joins.at(nextJoin++);
+    auto leftChild = buildJoins(nest, graph, order, left, keepsJoinFunctions, nextJoin);
+    auto rightChild = buildJoins(nest, graph, order, right, keepsJoinFunctions, nextJoin);
+
+    auto traitSet = originalJoin.getTraitSet();
+    tryInsert(traitSet, JoinStateEstimateTrait{toBytes(graph.estimateState(left, right))});
+    const auto join = keepsJoinFunctions
+        ? originalJoin
+        : JoinLogicalOperator(
+              graph.getJoinFunction(left, right), withUnqualifiedTimestamp(originalJoin.getWindowType()), originalJoin.getJoinType());
+    std::vector inputSchemas{leftChild.getOutputSchema(), rightChild.getOutputSchema()};
+    return LogicalOperator{join.withTraitSet(traitSet).withChildren({std::move(leftChild), std::move(rightChild)})}.withInferredSchema(
+        std::move(inputSchemas));
+}
+
+/// Projects the fields of the joins in the order of the query. All joins of the nest join within the same windows, thus the window
+/// fields of the joins of the query are the window fields of the topmost reordered join.
+LogicalOperator restoreFields(const LogicalOperator& reorderedJoins, const LogicalOperator& originalJoins, const JoinNest& nest)
+{
+    const auto originalSchema = originalJoins.getOutputSchema();
+    if (reorderedJoins.getOutputSchema().getFieldNames() == originalSchema.getFieldNames())
+    {
+        return reorderedJoins;
+    }
+    const auto topmostJoin = reorderedJoins.tryGetAs<JoinLogicalOperator>();
+    INVARIANT(topmostJoin.has_value(), "Expected the reordered nest to end in a join, but got {}", reorderedJoins);
+    std::unordered_map<std::string, std::string> windowFields;
+    for (const auto& join : nest.joins)
+    {
+        windowFields.emplace(join.getWindowStartFieldName(), topmostJoin.value()->getWindowStartFieldName());
+        windowFields.emplace(join.getWindowEndFieldName(), topmostJoin.value()->getWindowEndFieldName());
+    }
+    auto projections = originalSchema.getFields()
+        | std::views::transform(
+                           [&windowFields](const Schema::Field& field)
+                           {
+                               const auto windowField = windowFields.find(field.name);
+                               const auto& fieldName = windowField == windowFields.end() ? field.name : windowField->second;
+                               return ProjectionLogicalOperator::Projection{
+                                   FieldIdentifier(field.name), LogicalFunction{FieldAccessLogicalFunction(fieldName)}};
+                           })
+        | std::ranges::to<std::vector>();
+
+    TraitSet traitSet;
+    if (const auto originIds = getTrait<OutputOriginIdsTrait>(originalJoins.getTraitSet()); originIds.has_value())
+    {
+        tryInsert(traitSet, originIds.value().get());
+    }
+    return LogicalOperator{ProjectionLogicalOperator(std::move(projections), ProjectionLogicalOperator::Asterisk(false))
+                               .withTraitSet(std::move(traitSet))
+                               .withChildren({reorderedJoins})}
+        .withInferredSchema({reorderedJoins.getOutputSchema()});
+}
+
+std::optional<double> getSliceSizeInSeconds(const JoinLogicalOperator& join)
+{
+    if (const auto window = std::dynamic_pointer_cast<Windowing::TimeBasedWindowType>(join.getWindowType()))
+    {
+        return static_cast<double>(std::gcd(window->getSize().getTime(), window->getSlide().getTime())) / 1000;
+    }
+    return std::nullopt;
+}
+}
+
+LogicalPlan ReorderJoins::apply(const LogicalPlan& queryPlan) const
+{
+    return queryPlan.withRootOperators(
+        queryPlan.getRootOperators()
+        | std::views::transform([this](const LogicalOperator& rootOperator) { return apply(rootOperator); })
+        | std::ranges::to<std::vector>());
+}
+
+LogicalOperator ReorderJoins::apply(const LogicalOperator& logicalOperator) const
+{
+    if (not logicalOperator.tryGetAs<JoinLogicalOperator>().has_value())
+    {
+        return logicalOperator.withChildren(
+            logicalOperator.getChildren() | std::views::transform([this](const LogicalOperator& child) { return apply(child); })
+            | std::ranges::to<std::vector>());
+    }
+
+    JoinNest nest;
+    collectNest(logicalOperator, nest);
+    for (auto& input : nest.inputs)
+    {
+        input = apply(input);
+    }
+
+    /// Like the JoinCostModel, we neglect the selectivity of the operators between the sources and the inputs of the nest
+    const auto sliceSizeInSeconds = getSliceSizeInSeconds(nest.joins.front());
+    const auto inputTuplesPerSlice = nest.inputs
+        | std::views::transform(
+                                         [&](const LogicalOperator& input)
+                                         {
+                                             const auto tuplesPerSecond = sourceStatistics == nullptr
+                                                 ? std::nullopt
+                                                 : JoinCostModel::getTuplesPerSecond(input, *sourceStatistics);
+                                             return tuplesPerSecond.has_value() and sliceSizeInSeconds.has_value()
+                                                 ? std::max(*tuplesPerSecond * *sliceSizeInSeconds, 1.0)
+                                                 : JoinCostModel::DEFAULT_TUPLES_PER_WINDOW;
+                                         })
+        | std::ranges::to<std::vector>();
+    const JoinGraph graph(nest, inputTuplesPerSlice);
+
+    const InputSet allInputs = (InputSet{1} << nest.inputs.size()) - 1;
+    auto order = nest.order;
+    if (const auto cheapestOrder = graph.isReorderable() ? graph.findCheapestOrder(allInputs) : std::nullopt;
+        cheapestOrder.has_value() and *cheapestOrder != order and graph.getCost(*cheapestOrder) < graph.getCost(order))
+    {
+        NES_DEBUG(
+            "Reordered {} joins, which reduces the estimated state per slice from {:.0f} to {:.0f} bytes",
+            nest.joins.size(),
+            graph.getCost(order),
+            graph.getCost(*cheapestOrder));
+        order = *cheapestOrder;
+    }
+
+    size_t nextJoin = 0;
+    const auto joins = buildJoins(nest, graph, order, allInputs, order == nest.order, nextJoin);
+    return restoreFields(joins, logicalOperator, nest);
+}
+
+}
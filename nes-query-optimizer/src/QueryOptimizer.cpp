@@ -14,28 +14,52 @@
 
 #include <QueryOptimizer.hpp>
 
+#include <memory>
+#include <ranges>
+#include <utility>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
 #include <Phases/DecideJoinTypes.hpp>
 #include <Phases/DecideMemoryLayout.hpp>
+#include <Phases/MergeQueryPlans.hpp>
+#include <Phases/PropagateClusteredFields.hpp>
+#include <Phases/ReorderJoins.hpp>
 #include <Plans/LogicalPlan.hpp>
 #include <OptimizedPlan.hpp>
 #include <QueryOptimizerConfiguration.hpp>
+#include <SourceStatistics.hpp>
 
 namespace NES
 {
 
 OptimizedPlan QueryOptimizer::optimize(const LogicalPlan& plan) const
 {
-    return optimize(plan, defaultQueryOptimization);
+    return optimize(plan, defaultQueryOptimization, sourceStatistics);
 }
 
-OptimizedPlan QueryOptimizer::optimize(const LogicalPlan& plan, const QueryOptimizerConfiguration& defaultQueryOptimization)
+OptimizedPlan QueryOptimizer::optimize(
+    const LogicalPlan& plan,
+    const QueryOptimizerConfiguration& defaultQueryOptimization,
+    std::shared_ptr<const SourceStatistics> sourceStatistics)
 {
     /// In the future, we will have a real rule matching engine / rule driver for our optimizer.
-    /// For now, we just decide the join type (if one exists in the query), set the memory layout type and lower to physical operators in a pure function.
-    DecideJoinTypes joinTypeDecider(defaultQueryOptimization.joinStrategy);
+    /// For now, we just order the joins and decide their join types (if any exist in the query), set the memory layout type, propagate the
+    /// clustering of the sources and lower to physical operators in a pure function.
+    const ReorderJoins joinReorderer(sourceStatistics);
+    DecideJoinTypes joinTypeDecider(
+        defaultQueryOptimization.joinStrategy, std::move(sourceStatistics), defaultQueryOptimization.hashJoinBuildSide.getValue());
     DecideMemoryLayout memoryLayoutDecider;
-    auto optimizedPlan = joinTypeDecider.apply(plan);
-    return OptimizedPlan{memoryLayoutDecider.apply(optimizedPlan)};
+    PropagateClusteredFields clusteredFieldsPropagator;
+    auto optimizedPlan = joinTypeDecider.apply(joinReorderer.apply(plan));
+    return OptimizedPlan{clusteredFieldsPropagator.apply(memoryLayoutDecider.apply(optimizedPlan))};
+}
+
+OptimizedPlan QueryOptimizer::optimizeMerged(const QueryId mergedQueryId, const std::vector<LogicalPlan>& plans) const
+{
+    /// The plans are merged after the optimization, as merging turns them into a single plan with multiple roots
+    const auto optimizedPlans = plans | std::views::transform([this](const LogicalPlan& plan) { return optimize(plan).getPlan(); })
+        | std::ranges::to<std::vector>();
+    return OptimizedPlan{MergeQueryPlans{}.apply(mergedQueryId, optimizedPlans)};
 }
 
 }
@@ -0,0 +1,131 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <QueryResourceEstimator.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <optional>
+#include <unordered_set>
+#include <utility>
+#include <DataTypes/Schema.hpp>
+#include <Functions/FieldAccessLogicalFunction.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Iterators/BFSIterator.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Operators/Windows/JoinLogicalOperator.hpp>
+#include <Operators/Windows/WindowedAggregationLogicalOperator.hpp>
+#include <Phases/JoinCostModel.hpp>
+#include <Plans/LogicalPlan.hpp>
+#include <WindowTypes/Types/SessionWindow.hpp>
+#include <WindowTypes/Types/TimeBasedWindowType.hpp>
+#include <WindowTypes/Types/WindowType.hpp>
+#include <SourceStatistics.hpp>
+
+namespace NES
+{
+
+namespace
+{
+std::optional<double> getTuplesPerSecond(const LogicalOperator& logicalOperator, const SourceStatistics* sourceStatistics)
+{
+    return sourceStatistics == nullptr ? std::nullopt : JoinCostModel::getTuplesPerSecond(logicalOperator, *sourceStatistics);
+}
+
+/// Size and slide of time-based windows in seconds. Sessions have neither, as their size depends on the gaps in the stream.
+std::optional<std::pair<double, double>> getSizeAndSlideInSeconds(const std::shared_ptr<Windowing::WindowType>& windowType)
+{
+    const auto timeBasedWindow = std::dynamic_pointer_cast<Windowing::TimeBasedWindowType>(windowType);
+    if (timeBasedWindow == nullptr or std::dynamic_pointer_cast<Windowing::SessionWindow>(windowType) != nullptr)
+    {
+        return std::nullopt;
+    }
+    const auto size = static_cast<double>(timeBasedWindow->getSize().getTime()) / 1000;
+    const auto slide = static_cast<double>(timeBasedWindow->getSlide().getTime()) / 1000;
+    return std::pair{size, slide > 0 ? slide : size};
+}
+
+double estimateTuplesPerWindow(const std::optional<double>& tuplesPerSecond, const std::optional<double>& windowSizeInSeconds)
+{
+    return tuplesPerSecond.has_value() and windowSizeInSeconds.has_value() ? std::max(*tuplesPerSecond * *windowSizeInSeconds, 1.0)
+                                                                            : JoinCostModel::DEFAULT_TUPLES_PER_WINDOW;
+}
+
+double estimateJoinState(const JoinLogicalOperator& join, const SourceStatistics* sourceStatistics)
+{
+    const auto sizeAndSlide = getSizeAndSlideInSeconds(join.getWindowType());
+    const auto windowSize = sizeAndSlide.transform([](const auto& window) { return window.first; });
+    const auto children = join.getChildren();
+    const auto estimateInput = [&](const LogicalOperator& input, const Schema& schema)
+    {
+        return JoinInputEstimate{
+            .tuplesPerWindow = estimateTuplesPerWindow(getTuplesPerSecond(input, sourceStatistics), windowSize),
+            .tupleSizeInBytes = static_cast<double>(schema.getSizeOfSchemaInBytes()),
+            .distinctKeys = 0};
+    };
+    return JoinCostModel::estimateStatePerSlice(
+        estimateInput(children.at(0), join.getLeftSchema()), estimateInput(children.at(1), join.getRightSchema()));
+}
+
+double estimateAggregationState(const WindowedAggregationLogicalOperator& aggregation, const SourceStatistics* sourceStatistics)
+{
+    double numberOfGroups = 1;
+    for (const auto& key : aggregation.getGroupingKeys())
+    {
+        numberOfGroups *= JoinCostModel::getDomainSize(key.getDataType());
+    }
+
+    /// Every slice of a sliding window holds the groups of its tuples
+    const auto sizeAndSlide = getSizeAndSlideInSeconds(aggregation.getWindowType());
+    const auto numberOfSlices = sizeAndSlide.transform([](const auto& window) { return std::ceil(window.first / window.second); });
+    const auto sliceDuration = sizeAndSlide.transform([](const auto& window) { return window.second; });
+    const auto tuplesPerSecond = getTuplesPerSecond(aggregation.getChildren().at(0), sourceStatistics);
+    const auto tuplesPerSlice = estimateTuplesPerWindow(tuplesPerSecond, sliceDuration);
+    const auto entrySize = static_cast<double>(aggregation.getOutputSchema().getSizeOfSchemaInBytes());
+    return numberOfSlices.value_or(1) * std::min(tuplesPerSlice, numberOfGroups) * entrySize;
+}
+}
+
+QueryResourceEstimate QueryResourceEstimator::estimate(const LogicalPlan& plan, const SourceStatistics* sourceStatistics)
+{
+    QueryResourceEstimate estimate{.stateSizeInBytes = 0, .busyWorkerThreads = 0};
+    /// Merged plans share operators between their roots, which we only account for once
+    std::unordered_set<OperatorId> visitedOperators;
+    for (const auto& root : plan.getRootOperators())
+    {
+        for (const auto& logicalOperator : BFSRange<LogicalOperator>(root))
+        {
+            if (not visitedOperators.insert(logicalOperator.getId()).second)
+            {
+                continue;
+            }
+            if (const auto join = logicalOperator.tryGetAs<JoinLogicalOperator>())
+            {
+                estimate.stateSizeInBytes += estimateJoinState(*join.value(), sourceStatistics);
+            }
+            else if (const auto aggregation = logicalOperator.tryGetAs<WindowedAggregationLogicalOperator>())
+            {
+                estimate.stateSizeInBytes += estimateAggregationState(*aggregation.value(), sourceStatistics);
+            }
+            if (const auto tuplesPerSecond = getTuplesPerSecond(logicalOperator, sourceStatistics))
+            {
+                estimate.busyWorkerThreads += *tuplesPerSecond * NANOSECONDS_PER_TUPLE_AND_OPERATOR / 1E9;
+            }
+        }
+    }
+    return estimate;
+}
+
+}
@@ -0,0 +1,91 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Traits/ClusteredFieldsTrait.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include <Traits/Trait.hpp>
+#include <Util/PlanRenderer.hpp>
+#include <Util/Reflection.hpp>
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <folly/hash/Hash.h>
+#include <ErrorHandling.hpp>
+#include <SerializableVariantDescriptor.pb.h>
+#include <TraitRegisty.hpp>
+
+namespace NES
+{
+
+ClusteredFieldsTrait::ClusteredFieldsTrait(std::vector<std::string> fieldNames) : fieldNames(std::move(fieldNames))
+{
+    PRECONDITION(not this->fieldNames.empty(), "Expects at least one clustered field");
+}
+
+const std::type_info& ClusteredFieldsTrait::getType() const
+{
+    return typeid(ClusteredFieldsTrait);
+}
+
+bool ClusteredFieldsTrait::operator==(const ClusteredFieldsTrait& other) const
+{
+    return fieldNames == other.fieldNames;
+}
+
+size_t ClusteredFieldsTrait::hash() const
+{
+    return folly::hash::hash_range(fieldNames.begin(), fieldNames.end());
+}
+
+std::string ClusteredFieldsTrait::explain(ExplainVerbosity) const
+{
+    return fmt::format("ClusteredFieldsTrait: {}", fmt::join(fieldNames, ", "));
+}
+
+std::string_view ClusteredFieldsTrait::getName() const
+{
+    return NAME;
+}
+
+bool ClusteredFieldsTrait::clusters(const std::vector<std::string>& otherFieldNames) const
+{
+    /// A run of equal values of all clustered fields has equal values of any subset of them
+    return not otherFieldNames.empty()
+        and std::ranges::all_of(
+               otherFieldNames, [this](const std::string& fieldName) { return std::ranges::contains(fieldNames, fieldName); });
+}
+
+TraitRegistryReturnType TraitGeneratedRegistrar::RegisterClusteredFieldsTrait(TraitRegistryArguments arguments)
+{
+    return unreflect<ClusteredFieldsTrait>(arguments.reflected);
+}
+
+Reflected Reflector<ClusteredFieldsTrait>::operator()(const ClusteredFieldsTrait& trait) const
+{
+    return reflect(detail::ReflectedClusteredFieldsTrait{trait.fieldNames});
+}
+
+ClusteredFieldsTrait Unreflector<ClusteredFieldsTrait>::operator()(const Reflected& reflected) const
+{
+    auto [fieldNames] = unreflect<detail::ReflectedClusteredFieldsTrait>(reflected);
+    return ClusteredFieldsTrait{std::move(fieldNames)};
+}
+}
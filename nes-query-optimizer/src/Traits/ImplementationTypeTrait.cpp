@@ -36,9 +36,14 @@ TraitRegistryReturnType TraitGeneratedRegistrar::RegisterJoinImplementationTypeT
     return unreflect<JoinImplementationTypeTrait>(arguments.reflected);
 }
 
-JoinImplementationTypeTrait::JoinImplementationTypeTrait(const JoinImplementation implementationType)
-    : implementationType(implementationType)
+JoinImplementationTypeTrait::JoinImplementationTypeTrait(
+    const JoinImplementation implementationType, const HashJoinBuildSide hashJoinBuildSide)
+    : implementationType(implementationType), hashJoinBuildSide(hashJoinBuildSide)
 {
+    PRECONDITION(
+        implementationType == JoinImplementation::HASH_JOIN or hashJoinBuildSide == HashJoinBuildSide::BOTH,
+        "Only a hash join can hash a single side, but got {}",
+        magic_enum::enum_name(implementationType));
 }
 
 const std::type_info& JoinImplementationTypeTrait::getType() const
@@ -48,16 +53,24 @@ const std::type_info& JoinImplementationTypeTrait::getType() const
 
 bool JoinImplementationTypeTrait::operator==(const JoinImplementationTypeTrait& other) const
 {
-    return implementationType == other.implementationType;
+    return implementationType == other.implementationType and hashJoinBuildSide == other.hashJoinBuildSide;
 }
 
 size_t JoinImplementationTypeTrait::hash() const
 {
-    return magic_enum::enum_integer(implementationType);
+    return (magic_enum::enum_integer(implementationType) * magic_enum::enum_count<HashJoinBuildSide>())
+        + magic_enum::enum_integer(hashJoinBuildSide);
 }
 
 std::string JoinImplementationTypeTrait::explain(ExplainVerbosity) const
 {
+    if (hashJoinBuildSide != HashJoinBuildSide::BOTH)
+    {
+        return fmt::format(
+            "JoinImplementationTypeTrait: {} (hashed side: {})",
+            magic_enum::enum_name(implementationType),
+            magic_enum::enum_name(hashJoinBuildSide));
+    }
     return fmt::format("JoinImplementationTypeTrait: {}", magic_enum::enum_name(implementationType));
 }
 
@@ -68,13 +81,13 @@ std::string_view JoinImplementationTypeTrait::getName() const
 
 Reflected Reflector<JoinImplementationTypeTrait>::operator()(const JoinImplementationTypeTrait& trait) const
 {
-    return reflect(detail::ReflectedImplementationTypeTrait{trait.implementationType});
+    return reflect(detail::ReflectedImplementationTypeTrait{trait.implementationType, trait.hashJoinBuildSide});
 }
 
 JoinImplementationTypeTrait Unreflector<JoinImplementationTypeTrait>::operator()(const Reflected& reflected) const
 {
-    auto [joinImplementationType] = unreflect<detail::ReflectedImplementationTypeTrait>(reflected);
-    return JoinImplementationTypeTrait{joinImplementationType};
+    auto [joinImplementationType, hashJoinBuildSide] = unreflect<detail::ReflectedImplementationTypeTrait>(reflected);
+    return JoinImplementationTypeTrait{joinImplementationType, hashJoinBuildSide};
 }
 
 }
@@ -0,0 +1,78 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Traits/JoinStateEstimateTrait.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+
+#include <Traits/Trait.hpp>
+#include <Util/PlanRenderer.hpp>
+#include <Util/Reflection.hpp>
+#include <fmt/format.h>
+#include <SerializableVariantDescriptor.pb.h>
+#include <TraitRegisty.hpp>
+
+namespace NES
+{
+
+JoinStateEstimateTrait::JoinStateEstimateTrait(const uint64_t bytesPerSlice) : bytesPerSlice(bytesPerSlice)
+{
+}
+
+const std::type_info& JoinStateEstimateTrait::getType() const
+{
+    return typeid(JoinStateEstimateTrait);
+}
+
+bool JoinStateEstimateTrait::operator==(const JoinStateEstimateTrait& other) const
+{
+    return bytesPerSlice == other.bytesPerSlice;
+}
+
+size_t JoinStateEstimateTrait::hash() const
+{
+    return std::hash<uint64_t>{}(bytesPerSlice);
+}
+
+std::string JoinStateEstimateTrait::explain(ExplainVerbosity) const
+{
+    return fmt::format("JoinStateEstimateTrait: {} bytes per slice", bytesPerSlice);
+}
+
+std::string_view JoinStateEstimateTrait::getName() const
+{
+    return NAME;
+}
+
+TraitRegistryReturnType TraitGeneratedRegistrar::RegisterJoinStateEstimateTrait(TraitRegistryArguments arguments)
+{
+    return unreflect<JoinStateEstimateTrait>(arguments.reflected);
+}
+
+Reflected Reflector<JoinStateEstimateTrait>::operator()(const JoinStateEstimateTrait& trait) const
+{
+    return reflect(detail::ReflectedJoinStateEstimateTrait{trait.bytesPerSlice});
+}
+
+JoinStateEstimateTrait Unreflector<JoinStateEstimateTrait>::operator()(const Reflected& reflected) const
+{
+    auto [bytesPerSlice] = unreflect<detail::ReflectedJoinStateEstimateTrait>(reflected);
+    return JoinStateEstimateTrait{bytesPerSlice};
+}
+}
@@ -0,0 +1,83 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Traits/SharedWindowSizesTrait.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include <Traits/Trait.hpp>
+#include <Util/PlanRenderer.hpp>
+#include <Util/Reflection.hpp>
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <folly/hash/Hash.h>
+#include <ErrorHandling.hpp>
+#include <SerializableVariantDescriptor.pb.h>
+#include <TraitRegisty.hpp>
+
+namespace NES
+{
+
+SharedWindowSizesTrait::SharedWindowSizesTrait(std::vector<uint64_t> windowSizes) : windowSizes(std::move(windowSizes))
+{
+    PRECONDITION(not this->windowSizes.empty(), "Expects at least one shared window size");
+}
+
+const std::type_info& SharedWindowSizesTrait::getType() const
+{
+    return typeid(SharedWindowSizesTrait);
+}
+
+bool SharedWindowSizesTrait::operator==(const SharedWindowSizesTrait& other) const
+{
+    return windowSizes == other.windowSizes;
+}
+
+size_t SharedWindowSizesTrait::hash() const
+{
+    return folly::hash::hash_range(windowSizes.begin(), windowSizes.end());
+}
+
+std::string SharedWindowSizesTrait::explain(ExplainVerbosity) const
+{
+    return fmt::format("SharedWindowSizesTrait: {}", fmt::join(windowSizes, ", "));
+}
+
+std::string_view SharedWindowSizesTrait::getName() const
+{
+    return NAME;
+}
+
+TraitRegistryReturnType TraitGeneratedRegistrar::RegisterSharedWindowSizesTrait(TraitRegistryArguments arguments)
+{
+    return unreflect<SharedWindowSizesTrait>(arguments.reflected);
+}
+
+Reflected Reflector<SharedWindowSizesTrait>::operator()(const SharedWindowSizesTrait& trait) const
+{
+    return reflect(detail::ReflectedSharedWindowSizesTrait{trait.windowSizes});
+}
+
+SharedWindowSizesTrait Unreflector<SharedWindowSizesTrait>::operator()(const Reflected& reflected) const
+{
+    auto [windowSizes] = unreflect<detail::ReflectedSharedWindowSizesTrait>(reflected);
+    return SharedWindowSizesTrait{std::move(windowSizes)};
+}
+}
@@ -14,6 +14,10 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <Util/Logger/LogLevel.hpp>
@@ -21,7 +25,9 @@
 #include <gtest/gtest.h>
 #include <BaseUnitTest.hpp>
 
+#include <Phases/BandJoinPredicate.hpp>
 #include <Phases/DecideJoinTypes.hpp>
+#include <Phases/JoinCostModel.hpp>
 
 #include <DataTypes/DataType.hpp>
 #include <DataTypes/DataTypeProvider.hpp>
@@ -29,6 +35,10 @@
 #include <Functions/ArithmeticalFunctions/AddLogicalFunction.hpp>
 #include <Functions/BooleanFunctions/AndLogicalFunction.hpp>
 #include <Functions/BooleanFunctions/EqualsLogicalFunction.hpp>
+#include <Functions/BooleanFunctions/OrLogicalFunction.hpp>
+#include <Functions/ComparisonFunctions/GreaterEqualsLogicalFunction.hpp>
+#include <Functions/ComparisonFunctions/LessEqualsLogicalFunction.hpp>
+#include <Functions/ComparisonFunctions/LessLogicalFunction.hpp>
 #include <Functions/FieldAccessLogicalFunction.hpp>
 #include <Iterators/BFSIterator.hpp>
 #include <Operators/LogicalOperator.hpp>
@@ -37,16 +47,51 @@
 #include <Plans/LogicalPlanBuilder.hpp>
 #include <Traits/ImplementationTypeTrait.hpp>
 #include <Traits/TraitSet.hpp>
+#include <Util/PlanRenderer.hpp>
 #include <WindowTypes/Measures/TimeCharacteristic.hpp>
 #include <WindowTypes/Measures/TimeMeasure.hpp>
 #include <WindowTypes/Types/TumblingWindow.hpp>
 #include <WindowTypes/Types/WindowType.hpp>
+#include <Sources/ColumnStatistics.hpp>
+#include <SourceStatistics.hpp>
 
 namespace NES
 {
 namespace
 {
 
+class TestSourceStatistics final : public SourceStatistics
+{
+public:
+    explicit TestSourceStatistics(
+        std::unordered_map<std::string, double> tuplesPerSecond, std::unordered_map<std::string, ColumnStatistics> columnStatistics = {})
+        : tuplesPerSecond(std::move(tuplesPerSecond)), columnStatistics(std::move(columnStatistics))
+    {
+    }
+
+    [[nodiscard]] std::optional<double> getTuplesPerSecond(const std::string& logicalSourceName) const override
+    {
+        if (const auto rate = tuplesPerSecond.find(logicalSourceName); rate != tuplesPerSecond.end())
+        {
+            return rate->second;
+        }
+        return std::nullopt;
+    }
+
+    [[nodiscard]] std::optional<ColumnStatistics> getColumnStatistics(const std::string& fieldName) const override
+    {
+        if (const auto statistics = columnStatistics.find(fieldName); statistics != columnStatistics.end())
+        {
+            return statistics->second;
+        }
+        return std::nullopt;
+    }
+
+private:
+    std::unordered_map<std::string, double> tuplesPerSecond;
+    std::unordered_map<std::string, ColumnStatistics> columnStatistics;
+};
+
 class DecideJoinTypesTest : public Testing::BaseUnitTest
 {
 public:
@@ -74,6 +119,75 @@ public:
         return std::make_shared<Windowing::TumblingWindow>(
             Windowing::TimeCharacteristic::createIngestionTime(), Windowing::TimeMeasure(TUMBLING_WINDOW_SIZE_MS));
     }
+
+    static Schema createBandJoinLeftSchema()
+    {
+        Schema schema;
+        schema.addField("left$id", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+        schema.addField("left$ts", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+        schema.addField("left$value", DataTypeProvider::provideDataType(DataType::Type::FLOAT64));
+        return schema;
+    }
+
+    static Schema createBandJoinRightSchema()
+    {
+        Schema schema;
+        schema.addField("right$id", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+        schema.addField("right$start", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+        schema.addField("right$end", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+        schema.addField("right$nullable", DataTypeProvider::provideDataType(DataType::Type::INT64, DataType::NULLABLE::IS_NULLABLE));
+        return schema;
+    }
+
+    static LogicalFunction field(const std::string& fieldName) { return LogicalFunction{FieldAccessLogicalFunction(fieldName)}; }
+
+    /// Band predicates are detected via the data types of the join fields. Thus, we infer the schemas of the join operator,
+    /// which is usually done by the type inference phase.
+    static LogicalPlan createBandJoinPlan(const LogicalFunction& joinFunction)
+    {
+        return createBandJoinPlan(
+            joinFunction, createSourcePlan("TEST", createBandJoinLeftSchema()), createSourcePlan("TEST", createBandJoinRightSchema()));
+    }
+
+    /// Reads the join inputs from the logical sources "left" and "right", whose rates are known to the source statistics
+    static LogicalPlan createBandJoinPlanOfLogicalSources(const LogicalFunction& joinFunction)
+    {
+        return createBandJoinPlan(
+            joinFunction, LogicalPlanBuilder::createLogicalPlan("left"), LogicalPlanBuilder::createLogicalPlan("right"));
+    }
+
+    static LogicalPlan createBandJoinPlan(const LogicalFunction& joinFunction, const LogicalPlan& leftPlan, const LogicalPlan& rightPlan)
+    {
+        const auto leftSchema = createBandJoinLeftSchema();
+        const auto rightSchema = createBandJoinRightSchema();
+        auto plan = LogicalPlanBuilder::addJoin(
+            leftPlan, rightPlan, joinFunction, createTumblingWindow(), JoinLogicalOperator::JoinType::INNER_JOIN);
+        plan = LogicalPlanBuilder::addSink("test_sink", plan);
+        const auto join = getOperatorByType<JoinLogicalOperator>(plan).at(0);
+        return replaceOperator(plan, join.getId(), LogicalOperator{join->withInferredSchema({leftSchema, rightSchema})}).value();
+    }
+
+    /// Decides the join type of a join between the logical sources "left" and "right" that produce the given tuples per second
+    static JoinImplementation decideJoinType(
+        const LogicalFunction& joinFunction,
+        const StreamJoinStrategy joinStrategy,
+        std::unordered_map<std::string, double> tuplesPerSecond)
+    {
+        DecideJoinTypes phase(joinStrategy, std::make_shared<TestSourceStatistics>(std::move(tuplesPerSecond)));
+        auto result = phase.apply(createBandJoinPlanOfLogicalSources(joinFunction));
+        auto joins = getOperatorByType<JoinLogicalOperator>(result);
+        EXPECT_EQ(joins.size(), 1);
+        return joins.at(0)->getTraitSet().get<JoinImplementationTypeTrait>()->implementationType;
+    }
+
+    static JoinImplementation decideJoinType(const LogicalFunction& joinFunction, const StreamJoinStrategy joinStrategy)
+    {
+        DecideJoinTypes phase(joinStrategy);
+        auto result = phase.apply(createBandJoinPlan(joinFunction));
+        auto joins = getOperatorByType<JoinLogicalOperator>(result);
+        EXPECT_EQ(joins.size(), 1);
+        return joins.at(0)->getTraitSet().get<JoinImplementationTypeTrait>()->implementationType;
+    }
 };
 
 /// A simple Selection → InlineSource plan. Verify all operators get CHOICELESS.
@@ -198,5 +312,167 @@ TEST_F(DecideJoinTypesTest, ComplexAndConditionProducesHashJoin)
     EXPECT_TRUE(trait->implementationType == JoinImplementation::HASH_JOIN);
 }
 
+/// Less(left, right) can not be evaluated by a hash join. The optimizer picks the sort-merge join instead of the NLJ.
+TEST_F(DecideJoinTypesTest, InequalityConditionProducesSortMergeJoinTrait)
+{
+    const auto joinFunction = LogicalFunction{LessLogicalFunction(field("left$ts"), field("right$start"))};
+    EXPECT_EQ(decideJoinType(joinFunction, StreamJoinStrategy::OPTIMIZER_CHOOSES), JoinImplementation::SORT_MERGE_JOIN);
+    EXPECT_EQ(decideJoinType(joinFunction, StreamJoinStrategy::HASH_JOIN), JoinImplementation::SORT_MERGE_JOIN);
+    EXPECT_EQ(decideJoinType(joinFunction, StreamJoinStrategy::SORT_MERGE_JOIN), JoinImplementation::SORT_MERGE_JOIN);
+    EXPECT_EQ(decideJoinType(joinFunction, StreamJoinStrategy::NESTED_LOOP_JOIN), JoinImplementation::NESTED_LOOP_JOIN);
+}
+
+/// An equi-join is still a hash join, unless the sort-merge join is forced
+TEST_F(DecideJoinTypesTest, ForcedSortMergeJoinStrategyProducesSortMergeJoinTraitForEquiJoin)
+{
+    const auto joinFunction = LogicalFunction{EqualsLogicalFunction(field("left$id"), field("right$id"))};
+    EXPECT_EQ(decideJoinType(joinFunction, StreamJoinStrategy::OPTIMIZER_CHOOSES), JoinImplementation::HASH_JOIN);
+    EXPECT_EQ(decideJoinType(joinFunction, StreamJoinStrategy::SORT_MERGE_JOIN), JoinImplementation::SORT_MERGE_JOIN);
+}
+
+/// Comparisons that are not a top-level conjunction or that compare nullable fields can not be used for sorting. Thus, we use a NLJ.
+TEST_F(DecideJoinTypesTest, UnsupportedInequalityConditionFallsBackToNLJ)
+{
+    const auto disjunction = LogicalFunction{OrLogicalFunction(
+        LogicalFunction{LessLogicalFunction(field("left$ts"), field("right$start"))},
+        LogicalFunction{LessLogicalFunction(field("left$ts"), field("right$end"))})};
+    EXPECT_EQ(decideJoinType(disjunction, StreamJoinStrategy::OPTIMIZER_CHOOSES), JoinImplementation::NESTED_LOOP_JOIN);
+
+    const auto nullableField = LogicalFunction{LessLogicalFunction(field("left$value"), field("right$nullable"))};
+    EXPECT_EQ(decideJoinType(nullableField, StreamJoinStrategy::SORT_MERGE_JOIN), JoinImplementation::NESTED_LOOP_JOIN);
+}
+
+/// `left.ts BETWEEN right.start AND right.end` consists of two comparisons. We sort by the first one.
+TEST_F(DecideJoinTypesTest, BetweenConditionProducesSortMergeJoinTrait)
+{
+    const auto joinFunction = LogicalFunction{AndLogicalFunction(
+        LogicalFunction{GreaterEqualsLogicalFunction(field("left$ts"), field("right$start"))},
+        LogicalFunction{LessEqualsLogicalFunction(field("left$ts"), field("right$end"))})};
+    EXPECT_EQ(decideJoinType(joinFunction, StreamJoinStrategy::OPTIMIZER_CHOOSES), JoinImplementation::SORT_MERGE_JOIN);
+
+    const auto join = getOperatorByType<JoinLogicalOperator>(createBandJoinPlan(joinFunction)).at(0);
+    const auto band = BandJoinPredicate::tryCreate(join->getJoinFunction(), join->getLeftSchema(), join->getRightSchema());
+    ASSERT_TRUE(band.has_value());
+    EXPECT_EQ(band->leftFieldName, "left$ts");
+    EXPECT_EQ(band->rightFieldName, "right$start");
+    EXPECT_FALSE(band->rightIsLowerBoundedByLeft);
+    EXPECT_TRUE(band->rightIsUpperBoundedByLeft);
+}
+
+/// Comparisons of the same fields are combined and fields that are bounded on both sides are preferred, as their band is narrower
+TEST_F(DecideJoinTypesTest, BandJoinPredicatePrefersFieldsThatAreBoundedOnBothSides)
+{
+    const auto joinFunction = LogicalFunction{AndLogicalFunction(
+        LogicalFunction{LessLogicalFunction(field("left$ts"), field("right$start"))},
+        LogicalFunction{AndLogicalFunction(
+            LogicalFunction{LessEqualsLogicalFunction(field("right$end"), field("left$value"))},
+            LogicalFunction{GreaterEqualsLogicalFunction(field("right$end"), field("left$value"))})})};
+
+    const auto join = getOperatorByType<JoinLogicalOperator>(createBandJoinPlan(joinFunction)).at(0);
+    const auto band = BandJoinPredicate::tryCreate(join->getJoinFunction(), join->getLeftSchema(), join->getRightSchema());
+    ASSERT_TRUE(band.has_value());
+    EXPECT_EQ(band->leftFieldName, "left$value");
+    EXPECT_EQ(band->rightFieldName, "right$end");
+    EXPECT_TRUE(band->rightIsLowerBoundedByLeft);
+    EXPECT_TRUE(band->rightIsUpperBoundedByLeft);
+}
+
+/// With few tuples per window, comparing all pairs is cheaper than hashing or sorting the tuples
+TEST_F(DecideJoinTypesTest, LowSourceRatesProduceNLJTrait)
+{
+    const auto equiJoin = LogicalFunction{EqualsLogicalFunction(field("left$id"), field("right$id"))};
+    const auto inequalityJoin = LogicalFunction{LessLogicalFunction(field("left$ts"), field("right$start"))};
+    const std::unordered_map<std::string, double> lowRates{{"left", 5}, {"right", 5}};
+    EXPECT_EQ(decideJoinType(equiJoin, StreamJoinStrategy::OPTIMIZER_CHOOSES, lowRates), JoinImplementation::NESTED_LOOP_JOIN);
+    EXPECT_EQ(decideJoinType(inequalityJoin, StreamJoinStrategy::OPTIMIZER_CHOOSES, lowRates), JoinImplementation::NESTED_LOOP_JOIN);
+
+    const std::unordered_map<std::string, double> highRates{{"left", 100000}, {"right", 50000}};
+    EXPECT_EQ(decideJoinType(equiJoin, StreamJoinStrategy::OPTIMIZER_CHOOSES, highRates), JoinImplementation::HASH_JOIN);
+    EXPECT_EQ(decideJoinType(inequalityJoin, StreamJoinStrategy::OPTIMIZER_CHOOSES, highRates), JoinImplementation::SORT_MERGE_JOIN);
+}
+
+/// We assume large windows for join inputs without observed rates. Forcing a join strategy ignores the rates.
+TEST_F(DecideJoinTypesTest, UnknownSourceRatesAndForcedStrategiesIgnoreTheCostModel)
+{
+    const auto equiJoin = LogicalFunction{EqualsLogicalFunction(field("left$id"), field("right$id"))};
+    EXPECT_EQ(decideJoinType(equiJoin, StreamJoinStrategy::OPTIMIZER_CHOOSES, {{"left", 5}}), JoinImplementation::HASH_JOIN);
+    EXPECT_EQ(decideJoinType(equiJoin, StreamJoinStrategy::HASH_JOIN, {{"left", 5}, {"right", 5}}), JoinImplementation::HASH_JOIN);
+    EXPECT_EQ(
+        decideJoinType(equiJoin, StreamJoinStrategy::SORT_MERGE_JOIN, {{"left", 5}, {"right", 5}}), JoinImplementation::SORT_MERGE_JOIN);
+}
+
+/// The NLJ reads both tuples of every pair, whereas the sort-merge join only reads the tuples of the pairs within the band
+TEST_F(DecideJoinTypesTest, WideTuplesFavorTheSortMergeJoin)
+{
+    const BandJoinPredicate band{
+        .leftFieldName = "left$ts", .rightFieldName = "right$ts", .rightIsLowerBoundedByLeft = true, .rightIsUpperBoundedByLeft = false};
+    const JoinInputEstimate narrow{.tuplesPerWindow = 20, .tupleSizeInBytes = 8, .distinctKeys = 20};
+    EXPECT_EQ(JoinCostModel::estimate(narrow, narrow, false, band).getCheapest(), JoinImplementation::NESTED_LOOP_JOIN);
+
+    const JoinInputEstimate wide{.tuplesPerWindow = 20, .tupleSizeInBytes = 512, .distinctKeys = 20};
+    const auto costs = JoinCostModel::estimate(wide, wide, false, band);
+    EXPECT_EQ(costs.getCheapest(), JoinImplementation::SORT_MERGE_JOIN);
+    EXPECT_FALSE(costs.hashJoin.has_value());
+}
+
+/// If the sampled join keys repeat, their number of distinct values bounds the distinct keys of a window. Few distinct keys make the
+/// hash join compare almost all pairs, too.
+TEST_F(DecideJoinTypesTest, SampledDistinctKeysBoundTheKeysOfAWindow)
+{
+    const auto equiJoin = LogicalFunction{EqualsLogicalFunction(field("left$id"), field("right$id"))};
+    const auto plan = createBandJoinPlanOfLogicalSources(equiJoin);
+    const std::unordered_map<std::string, double> highRates{{"left", 100000}, {"right", 50000}};
+    const auto decide = [&](const uint64_t numberOfDistinctValues)
+    {
+        const ColumnStatistics keyStatistics{.numberOfSampledValues = 1000, .approximateNumberOfDistinctValues = numberOfDistinctValues};
+        const std::unordered_map<std::string, ColumnStatistics> columnStatistics{{"left$id", keyStatistics}};
+        DecideJoinTypes phase(StreamJoinStrategy::OPTIMIZER_CHOOSES, std::make_shared<TestSourceStatistics>(highRates, columnStatistics));
+        const auto join = getOperatorByType<JoinLogicalOperator>(phase.apply(plan)).at(0);
+        return join->getTraitSet().get<JoinImplementationTypeTrait>()->implementationType;
+    };
+    EXPECT_EQ(decide(1), JoinImplementation::NESTED_LOOP_JOIN);
+    /// Barely repeating values do not bound the domain, as the sample may have missed most distinct values
+    EXPECT_EQ(decide(900), JoinImplementation::HASH_JOIN);
+}
+
+/// A hash join hashes only the side with much fewer tuples, if the rates of both sides are known. Declaring the side overrides the rates.
+TEST_F(DecideJoinTypesTest, MuchSmallerSideIsTheOnlyHashedSide)
+{
+    const auto equiJoin = LogicalFunction{EqualsLogicalFunction(field("left$id"), field("right$id"))};
+    const auto plan = createBandJoinPlanOfLogicalSources(equiJoin);
+    const auto decide = [&](std::unordered_map<std::string, double> tuplesPerSecond, const HashJoinBuildSideStrategy strategy)
+    {
+        DecideJoinTypes phase(StreamJoinStrategy::HASH_JOIN, std::make_shared<TestSourceStatistics>(std::move(tuplesPerSecond)), strategy);
+        const auto join = getOperatorByType<JoinLogicalOperator>(phase.apply(plan)).at(0);
+        EXPECT_EQ(join->getTraitSet().get<JoinImplementationTypeTrait>()->implementationType, JoinImplementation::HASH_JOIN);
+        return join->getTraitSet().get<JoinImplementationTypeTrait>()->hashJoinBuildSide;
+    };
+    constexpr auto optimizerChooses = HashJoinBuildSideStrategy::OPTIMIZER_CHOOSES;
+    EXPECT_EQ(decide({{"left", 100}, {"right", 100000}}, optimizerChooses), HashJoinBuildSide::LEFT);
+    EXPECT_EQ(decide({{"left", 100000}, {"right", 100}}, optimizerChooses), HashJoinBuildSide::RIGHT);
+    EXPECT_EQ(decide({{"left", 100000}, {"right", 50000}}, optimizerChooses), HashJoinBuildSide::BOTH);
+    EXPECT_EQ(decide({{"left", 100}}, optimizerChooses), HashJoinBuildSide::BOTH);
+    EXPECT_EQ(decide({{"left", 100}, {"right", 100000}}, HashJoinBuildSideStrategy::BOTH), HashJoinBuildSide::BOTH);
+    EXPECT_EQ(decide({}, HashJoinBuildSideStrategy::RIGHT), HashJoinBuildSide::RIGHT);
+
+    DecideJoinTypes phase(
+        StreamJoinStrategy::HASH_JOIN, std::make_shared<TestSourceStatistics>(std::unordered_map<std::string, double>{}), optimizerChooses);
+    EXPECT_EQ(explain(phase.apply(plan), ExplainVerbosity::Short).find("hashed side:"), std::string::npos);
+    DecideJoinTypes leftPhase(StreamJoinStrategy::HASH_JOIN, nullptr, HashJoinBuildSideStrategy::LEFT);
+    EXPECT_NE(explain(leftPhase.apply(plan), ExplainVerbosity::Short).find("hashed side: LEFT"), std::string::npos);
+}
+
+/// The chosen implementation of every join is part of the explained plan
+TEST_F(DecideJoinTypesTest, ExplainShowsJoinImplementation)
+{
+    const auto equiJoin = LogicalFunction{EqualsLogicalFunction(field("left$id"), field("right$id"))};
+    const auto plan = createBandJoinPlanOfLogicalSources(equiJoin);
+    EXPECT_EQ(explain(plan, ExplainVerbosity::Short).find("implementation:"), std::string::npos);
+
+    const std::unordered_map<std::string, double> lowRates{{"left", 1}, {"right", 1}};
+    DecideJoinTypes phase(StreamJoinStrategy::OPTIMIZER_CHOOSES, std::make_shared<TestSourceStatistics>(lowRates));
+    EXPECT_NE(explain(phase.apply(plan), ExplainVerbosity::Short).find("implementation: NESTED_LOOP_JOIN"), std::string::npos);
+}
+
 }
 }
@@ -14,6 +14,9 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include <Util/Logger/LogLevel.hpp>
@@ -21,19 +24,26 @@
 #include <gtest/gtest.h>
 #include <BaseUnitTest.hpp>
 
+#include <LegacyOptimizer/TypeInferencePhase.hpp>
 #include <Phases/DecideMemoryLayout.hpp>
 
 #include <DataTypes/DataType.hpp>
 #include <DataTypes/DataTypeProvider.hpp>
 #include <DataTypes/Schema.hpp>
 #include <Functions/BooleanFunctions/EqualsLogicalFunction.hpp>
+#include <Functions/ComparisonFunctions/GreaterLogicalFunction.hpp>
+#include <Functions/ConstantValueLogicalFunction.hpp>
 #include <Functions/FieldAccessLogicalFunction.hpp>
 #include <Iterators/BFSIterator.hpp>
 #include <Nautilus/Interface/BufferRef/LowerSchemaProvider.hpp>
 #include <Operators/LogicalOperator.hpp>
+#include <Operators/ProjectionLogicalOperator.hpp>
+#include <Operators/SelectionLogicalOperator.hpp>
+#include <Operators/Sources/SourceDescriptorLogicalOperator.hpp>
 #include <Operators/Windows/JoinLogicalOperator.hpp>
 #include <Plans/LogicalPlan.hpp>
 #include <Plans/LogicalPlanBuilder.hpp>
+#include <Sources/SourceCatalog.hpp>
 #include <Traits/MemoryLayoutTypeTrait.hpp>
 #include <Traits/TraitSet.hpp>
 #include <WindowTypes/Measures/TimeCharacteristic.hpp>
@@ -72,6 +82,48 @@ public:
         return std::make_shared<Windowing::TumblingWindow>(
             Windowing::TimeCharacteristic::createIngestionTime(), Windowing::TimeMeasure(TUMBLING_WINDOW_SIZE_MS));
     }
+
+    /// Creates a plan that reads a physical source of the logical source 'stream' with the fields id, value, and payload
+    LogicalPlan createStreamSourcePlan()
+    {
+        auto logicalSource = sourceCatalog.getLogicalSource("stream");
+        if (not logicalSource.has_value())
+        {
+            Schema schema;
+            schema.addField("id", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+            schema.addField("value", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+            schema.addField("payload", DataTypeProvider::provideDataType(DataType::Type::VARSIZED));
+            logicalSource = sourceCatalog.addLogicalSource("stream", schema);
+        }
+        auto sourceDescriptor
+            = sourceCatalog.addPhysicalSource(logicalSource.value(), "File", {{"file_path", "/dev/null"}}, {{"type", "CSV"}});
+        EXPECT_TRUE(sourceDescriptor.has_value());
+        return LogicalPlan(SourceDescriptorLogicalOperator(std::move(sourceDescriptor.value())));
+    }
+
+    /// Source -> selection on stream$id -> projection of the given fields -> sink
+    LogicalPlan createSelectionAndProjectionPlan(const std::vector<std::string>& projectedFields)
+    {
+        const auto constant = ConstantValueLogicalFunction(DataTypeProvider::provideDataType(DataType::Type::UINT64), "5");
+        auto plan = LogicalPlanBuilder::addSelection(
+            LogicalFunction{GreaterLogicalFunction(LogicalFunction{FieldAccessLogicalFunction("stream$id")}, LogicalFunction{constant})},
+            createStreamSourcePlan());
+        std::vector<ProjectionLogicalOperator::Projection> projections;
+        for (const auto& fieldName : projectedFields)
+        {
+            projections.emplace_back(std::nullopt, LogicalFunction{FieldAccessLogicalFunction(fieldName)});
+        }
+        plan = LogicalPlanBuilder::addSink("test_sink", LogicalPlanBuilder::addProjection(std::move(projections), false, plan));
+        TypeInferencePhase{}.apply(plan);
+        return plan;
+    }
+
+    static MemoryLayoutType getMemoryLayout(const LogicalOperator& logicalOperator)
+    {
+        return logicalOperator.getTraitSet().get<MemoryLayoutTypeTrait>()->memoryLayout;
+    }
+
+    SourceCatalog sourceCatalog;
 };
 
 /// InlineSource with sink. Verify all get ROW_LAYOUT.
@@ -118,5 +170,37 @@ TEST_F(DecideMemoryLayoutTest, BinaryPlanAllGetRowLayout)
     }
 }
 
+
+/// The projection reads one of the three fields that the selection emits, thus the selection emits columns. The sink reads rows.
+TEST_F(DecideMemoryLayoutTest, ProjectionOfFewFieldsReadsColumnarLayout)
+{
+    DecideMemoryLayout phase;
+    const auto result = phase.apply(createSelectionAndProjectionPlan({"stream$value"}));
+
+    const auto sink = result.getRootOperators()[0];
+    const auto projection = sink.getChildren().at(0);
+    const auto selection = projection.getChildren().at(0);
+    const auto source = selection.getChildren().at(0);
+    ASSERT_TRUE(projection.tryGetAs<ProjectionLogicalOperator>().has_value());
+    ASSERT_TRUE(selection.tryGetAs<SelectionLogicalOperator>().has_value());
+    EXPECT_EQ(getMemoryLayout(sink), MemoryLayoutType::ROW_LAYOUT);
+    EXPECT_EQ(getMemoryLayout(projection), MemoryLayoutType::ROW_LAYOUT);
+    EXPECT_EQ(getMemoryLayout(selection), MemoryLayoutType::COLUMNAR_LAYOUT);
+    /// Sources emit raw buffers, whose layout the input formatter does not depend on
+    EXPECT_EQ(getMemoryLayout(source), MemoryLayoutType::ROW_LAYOUT);
+}
+
+/// The projection reads most fields that the selection emits, thus the selection emits rows
+TEST_F(DecideMemoryLayoutTest, ProjectionOfMostFieldsReadsRowLayout)
+{
+    DecideMemoryLayout phase;
+    const auto result = phase.apply(createSelectionAndProjectionPlan({"stream$id", "stream$value"}));
+
+    for (const auto& op : BFSRange(result.getRootOperators()[0]))
+    {
+        EXPECT_EQ(getMemoryLayout(op), MemoryLayoutType::ROW_LAYOUT) << op;
+    }
+}
+
 }
 }
@@ -0,0 +1,179 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+#include <LegacyOptimizer/FunctionSimplificationRule.hpp>
+#include <LegacyOptimizer/TypeInferencePhase.hpp>
+
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/DataTypeProvider.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/ArithmeticalFunctions/AddLogicalFunction.hpp>
+#include <Functions/ArithmeticalFunctions/MulLogicalFunction.hpp>
+#include <Functions/ArithmeticalFunctions/SubLogicalFunction.hpp>
+#include <Functions/BooleanFunctions/AndLogicalFunction.hpp>
+#include <Functions/ComparisonFunctions/GreaterLogicalFunction.hpp>
+#include <Functions/ComparisonFunctions/LessLogicalFunction.hpp>
+#include <Functions/ConstantValueLogicalFunction.hpp>
+#include <Functions/FieldAccessLogicalFunction.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Operators/ProjectionLogicalOperator.hpp>
+#include <Operators/SelectionLogicalOperator.hpp>
+#include <Operators/Sources/SourceDescriptorLogicalOperator.hpp>
+#include <Plans/LogicalPlan.hpp>
+#include <Plans/LogicalPlanBuilder.hpp>
+
+namespace NES
+{
+namespace
+{
+
+class FunctionSimplificationRuleTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite() { Logger::setupLogging("FunctionSimplificationRuleTest.log", LogLevel::LOG_DEBUG); }
+
+    static LogicalPlan createSourcePlan()
+    {
+        Schema schema;
+        schema.addField("stream$id", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+        schema.addField("stream$value", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+        return LogicalPlanBuilder::createLogicalPlan("TEST", schema, {}, {});
+    }
+
+    static LogicalFunction field(const std::string& fieldName) { return LogicalFunction{FieldAccessLogicalFunction(fieldName)}; }
+
+    static LogicalFunction constant(const std::string& value)
+    {
+        return LogicalFunction{ConstantValueLogicalFunction(DataTypeProvider::provideDataType(DataType::Type::UINT64), value)};
+    }
+
+    static LogicalFunction greaterThan(const LogicalFunction& left, const LogicalFunction& right)
+    {
+        return LogicalFunction{GreaterLogicalFunction(left, right)};
+    }
+
+    /// Infers the plan, simplifies its functions, and infers the plan again to verify that the simplified plan is valid
+    static LogicalPlan simplify(LogicalPlan plan)
+    {
+        constexpr auto typeInference = TypeInferencePhase{};
+        typeInference.apply(plan);
+        FunctionSimplificationRule{}.apply(plan);
+        typeInference.apply(plan);
+        return plan;
+    }
+
+    static LogicalOperator getOnlyChild(const LogicalOperator& op)
+    {
+        const auto children = op.getChildren();
+        EXPECT_EQ(children.size(), 1);
+        return children.at(0);
+    }
+
+    static std::optional<LogicalFunction> getPredicate(const LogicalOperator& op)
+    {
+        return op.tryGetAs<SelectionLogicalOperator>().transform([](const auto& selection) { return selection->getPredicate(); });
+    }
+};
+
+/// The sum of two constants becomes a single constant, so that the selection compares the field with a constant
+TEST_F(FunctionSimplificationRuleTest, FoldsConstantArithmetic)
+{
+    const auto sum = LogicalFunction{AddLogicalFunction(constant("2"), constant("3"))};
+    auto plan = LogicalPlanBuilder::addSink(
+        "test_sink", LogicalPlanBuilder::addSelection(greaterThan(field("stream$value"), sum), createSourcePlan()));
+
+    const auto result = simplify(plan);
+
+    const auto predicate = getPredicate(getOnlyChild(result.getRootOperators().at(0)));
+    ASSERT_TRUE(predicate.has_value());
+    const auto folded = predicate->getChildren().at(1).tryGetAs<ConstantValueLogicalFunction>();
+    ASSERT_TRUE(folded.has_value());
+    EXPECT_EQ(folded.value()->getConstantValue(), "5");
+}
+
+/// The difference of two unsigned constants would wrap around, thus the rule leaves it to the compiled function
+TEST_F(FunctionSimplificationRuleTest, KeepsOverflowingArithmetic)
+{
+    const auto difference = LogicalFunction{SubLogicalFunction(constant("2"), constant("3"))};
+    auto plan = LogicalPlanBuilder::addSink(
+        "test_sink", LogicalPlanBuilder::addSelection(greaterThan(field("stream$value"), difference), createSourcePlan()));
+
+    const auto result = simplify(plan);
+
+    const auto predicate = getPredicate(getOnlyChild(result.getRootOperators().at(0)));
+    ASSERT_TRUE(predicate.has_value());
+    EXPECT_EQ(predicate->getChildren().at(1).getType(), SubLogicalFunction::NAME);
+}
+
+/// A selection that always holds is removed
+TEST_F(FunctionSimplificationRuleTest, RemovesSelectionThatAlwaysHolds)
+{
+    const auto alwaysTrue = LogicalFunction{LessLogicalFunction(constant("1"), constant("2"))};
+    auto plan = LogicalPlanBuilder::addSink("test_sink", LogicalPlanBuilder::addSelection(alwaysTrue, createSourcePlan()));
+
+    const auto result = simplify(plan);
+
+    EXPECT_TRUE(getOnlyChild(result.getRootOperators().at(0)).tryGetAs<SourceDescriptorLogicalOperator>().has_value());
+}
+
+/// Adjacent selections become a single selection, which evaluates the equal predicates of both selections only once
+TEST_F(FunctionSimplificationRuleTest, MergesAdjacentSelections)
+{
+    const auto onValue = greaterThan(field("stream$value"), constant("5"));
+    const auto onId = greaterThan(field("stream$id"), constant("1"));
+    auto plan = LogicalPlanBuilder::addSelection(onValue, createSourcePlan());
+    plan = LogicalPlanBuilder::addSelection(LogicalFunction{AndLogicalFunction(onId, onValue)}, plan);
+    plan = LogicalPlanBuilder::addSink("test_sink", plan);
+
+    const auto result = simplify(plan);
+
+    const auto selection = getOnlyChild(result.getRootOperators().at(0));
+    const auto predicate = getPredicate(selection);
+    ASSERT_TRUE(predicate.has_value());
+    ASSERT_EQ(predicate->getType(), AndLogicalFunction::NAME);
+    EXPECT_EQ(predicate->getChildren().at(0).getType(), GreaterLogicalFunction::NAME);
+    EXPECT_EQ(predicate->getChildren().at(1).getType(), GreaterLogicalFunction::NAME);
+    EXPECT_TRUE(getOnlyChild(selection).tryGetAs<SourceDescriptorLogicalOperator>().has_value());
+}
+
+/// The selection reads the field that the projection below it computes, instead of computing the same product again
+TEST_F(FunctionSimplificationRuleTest, ReusesComputedField)
+{
+    const auto doubled = LogicalFunction{MulLogicalFunction(field("stream$value"), constant("2"))};
+    auto plan = LogicalPlanBuilder::addProjection(
+        {ProjectionLogicalOperator::Projection{FieldIdentifier("stream$doubled"), doubled}}, true, createSourcePlan());
+    plan = LogicalPlanBuilder::addSelection(greaterThan(doubled, constant("10")), plan);
+    plan = LogicalPlanBuilder::addSink("test_sink", plan);
+
+    const auto result = simplify(plan);
+
+    const auto predicate = getPredicate(getOnlyChild(result.getRootOperators().at(0)));
+    ASSERT_TRUE(predicate.has_value());
+    const auto reused = predicate->getChildren().at(0).tryGetAs<FieldAccessLogicalFunction>();
+    ASSERT_TRUE(reused.has_value());
+    EXPECT_EQ(reused.value()->getFieldName(), "stream$doubled");
+}
+
+}
+}
@@ -0,0 +1,142 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <optional>
+#include <string>
+
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+#include <LegacyOptimizer/IntegerNarrowingRule.hpp>
+#include <LegacyOptimizer/TypeInferencePhase.hpp>
+
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/DataTypeProvider.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/ArithmeticalFunctions/AddLogicalFunction.hpp>
+#include <Functions/ArithmeticalFunctions/MulLogicalFunction.hpp>
+#include <Functions/CastToTypeLogicalFunction.hpp>
+#include <Functions/ComparisonFunctions/GreaterLogicalFunction.hpp>
+#include <Functions/ComparisonFunctions/LessLogicalFunction.hpp>
+#include <Functions/ConstantValueLogicalFunction.hpp>
+#include <Functions/FieldAccessLogicalFunction.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Operators/SelectionLogicalOperator.hpp>
+#include <Plans/LogicalPlan.hpp>
+#include <Plans/LogicalPlanBuilder.hpp>
+
+namespace NES
+{
+namespace
+{
+
+class IntegerNarrowingRuleTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite() { Logger::setupLogging("IntegerNarrowingRuleTest.log", LogLevel::LOG_DEBUG); }
+
+    static LogicalPlan createSourcePlan()
+    {
+        Schema schema;
+        schema.addField("stream$small", DataTypeProvider::provideDataType(DataType::Type::UINT8));
+        schema.addField("stream$medium", DataTypeProvider::provideDataType(DataType::Type::INT16));
+        schema.addField("stream$large", DataTypeProvider::provideDataType(DataType::Type::INT32));
+        return LogicalPlanBuilder::createLogicalPlan("TEST", schema, {}, {});
+    }
+
+    static LogicalFunction field(const std::string& fieldName) { return LogicalFunction{FieldAccessLogicalFunction(fieldName)}; }
+
+    static LogicalFunction constant(const DataType::Type type, const std::string& value)
+    {
+        return LogicalFunction{ConstantValueLogicalFunction(DataTypeProvider::provideDataType(type), value)};
+    }
+
+    /// Infers the plan, narrows its comparisons, and infers the plan again to verify that the narrowed plan is valid
+    static LogicalFunction narrowPredicate(const LogicalFunction& predicate)
+    {
+        auto plan = LogicalPlanBuilder::addSink("test_sink", LogicalPlanBuilder::addSelection(predicate, createSourcePlan()));
+        constexpr auto typeInference = TypeInferencePhase{};
+        typeInference.apply(plan);
+        IntegerNarrowingRule{}.apply(plan);
+        typeInference.apply(plan);
+        const auto selection = plan.getRootOperators().at(0).getChildren().at(0).tryGetAs<SelectionLogicalOperator>();
+        EXPECT_TRUE(selection.has_value());
+        return selection.value()->getPredicate();
+    }
+};
+
+/// The constant takes the type of the narrow field, so that field and constant agree on signedness, e.g., for the vectorized filters
+TEST_F(IntegerNarrowingRuleTest, NarrowsConstantToTypeOfField)
+{
+    const auto predicate
+        = narrowPredicate(LogicalFunction{GreaterLogicalFunction(field("stream$small"), constant(DataType::Type::INT64, "5"))});
+
+    ASSERT_EQ(predicate.getType(), GreaterLogicalFunction::NAME);
+    EXPECT_EQ(predicate.getChildren().at(1).getDataType().type, DataType::Type::UINT8);
+    EXPECT_EQ(predicate.getChildren().at(1).getAs<ConstantValueLogicalFunction>()->getConstantValue(), "5");
+}
+
+/// An unsigned field is never less than zero, thus the range analysis decides the comparison
+TEST_F(IntegerNarrowingRuleTest, DecidesComparisonByRanges)
+{
+    const auto predicate
+        = narrowPredicate(LogicalFunction{LessLogicalFunction(field("stream$small"), constant(DataType::Type::INT64, "0"))});
+
+    const auto decided = predicate.tryGetAs<ConstantValueLogicalFunction>();
+    ASSERT_TRUE(decided.has_value());
+    EXPECT_EQ(decided.value()->getConstantValue(), "false");
+}
+
+/// The cast into a wider type preserves every value of the field, thus the comparison reads the field directly
+TEST_F(IntegerNarrowingRuleTest, RemovesValuePreservingCast)
+{
+    const auto widened = LogicalFunction{CastToTypeLogicalFunction(
+        DataTypeProvider::provideDataType(DataType::Type::INT64),
+        LogicalFunction{FieldAccessLogicalFunction(DataTypeProvider::provideDataType(DataType::Type::INT16), "stream$medium")})};
+    const auto predicate = narrowPredicate(LogicalFunction{LessLogicalFunction(widened, constant(DataType::Type::INT64, "7"))});
+
+    ASSERT_EQ(predicate.getType(), LessLogicalFunction::NAME);
+    EXPECT_TRUE(predicate.getChildren().at(0).tryGetAs<FieldAccessLogicalFunction>().has_value());
+    EXPECT_EQ(predicate.getChildren().at(1).getDataType().type, DataType::Type::INT16);
+}
+
+/// The sum of a UINT8 field and a small constant cannot overflow, thus both constants become narrow
+TEST_F(IntegerNarrowingRuleTest, NarrowsConstantsOfArithmetic)
+{
+    const auto sum = LogicalFunction{AddLogicalFunction(field("stream$small"), constant(DataType::Type::INT64, "1"))};
+    const auto predicate = narrowPredicate(LogicalFunction{LessLogicalFunction(sum, constant(DataType::Type::INT64, "100"))});
+
+    ASSERT_EQ(predicate.getType(), LessLogicalFunction::NAME);
+    const auto narrowedSum = predicate.getChildren().at(0);
+    EXPECT_EQ(narrowedSum.getChildren().at(1).getDataType().type, DataType::Type::UINT8);
+    EXPECT_EQ(narrowedSum.getDataType().type, DataType::Type::INT32);
+    EXPECT_EQ(predicate.getChildren().at(1).getDataType().type, DataType::Type::INT32);
+}
+
+/// The product would overflow INT32 with a narrowed constant, thus the arithmetic keeps the wide constant
+TEST_F(IntegerNarrowingRuleTest, KeepsArithmeticThatWouldOverflow)
+{
+    const auto product = LogicalFunction{MulLogicalFunction(field("stream$large"), constant(DataType::Type::INT64, "1000000"))};
+    const auto predicate = narrowPredicate(LogicalFunction{GreaterLogicalFunction(product, constant(DataType::Type::INT64, "10"))});
+
+    ASSERT_EQ(predicate.getType(), GreaterLogicalFunction::NAME);
+    EXPECT_EQ(predicate.getChildren().at(0).getChildren().at(1).getDataType().type, DataType::Type::INT64);
+    EXPECT_EQ(predicate.getChildren().at(0).getDataType().type, DataType::Type::INT64);
+}
+
+}
+}
@@ -0,0 +1,215 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+#include <LegacyOptimizer/TypeInferencePhase.hpp>
+#include <Phases/MergeQueryPlans.hpp>
+
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/DataTypeProvider.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/ComparisonFunctions/GreaterLogicalFunction.hpp>
+#include <Functions/ConstantValueLogicalFunction.hpp>
+#include <Functions/FieldAccessLogicalFunction.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Operators/SelectionLogicalOperator.hpp>
+#include <Operators/Sources/SourceDescriptorLogicalOperator.hpp>
+#include <Operators/UnionLogicalOperator.hpp>
+#include <Operators/Windows/Aggregations/CountAggregationLogicalFunction.hpp>
+#include <Operators/Windows/Aggregations/SumAggregationLogicalFunction.hpp>
+#include <Operators/Windows/Aggregations/WindowAggregationLogicalFunction.hpp>
+#include <Operators/Windows/WindowedAggregationLogicalOperator.hpp>
+#include <Plans/LogicalPlan.hpp>
+#include <Plans/LogicalPlanBuilder.hpp>
+#include <Sources/SourceCatalog.hpp>
+#include <Sources/SourceDescriptor.hpp>
+#include <Traits/SharedWindowSizesTrait.hpp>
+#include <WindowTypes/Measures/TimeCharacteristic.hpp>
+#include <WindowTypes/Measures/TimeMeasure.hpp>
+#include <WindowTypes/Types/TumblingWindow.hpp>
+
+namespace NES
+{
+namespace
+{
+
+class MergeQueryPlansTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite() { Logger::setupLogging("MergeQueryPlansTest.log", LogLevel::LOG_DEBUG); }
+
+    void SetUp() override
+    {
+        BaseUnitTest::SetUp();
+        Schema schema;
+        schema.addField("id", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+        schema.addField("value", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+        const auto logicalSource = sourceCatalog.addLogicalSource("stream", schema);
+        ASSERT_TRUE(logicalSource.has_value());
+        auto physicalSource
+            = sourceCatalog.addPhysicalSource(logicalSource.value(), "File", {{"file_path", "/dev/null"}}, {{"type", "CSV"}});
+        ASSERT_TRUE(physicalSource.has_value());
+        sourceDescriptor = std::move(physicalSource.value());
+    }
+
+    /// Every call creates a new source operator of the same physical source
+    [[nodiscard]] LogicalPlan createSourcePlan() const
+    {
+        return LogicalPlan(SourceDescriptorLogicalOperator(sourceDescriptor.value())); /// NOLINT(bugprone-unchecked-optional-access)
+    }
+
+    static LogicalFunction greaterThan(const std::string& fieldName, const std::string& constant)
+    {
+        const auto constantValue = ConstantValueLogicalFunction(DataTypeProvider::provideDataType(DataType::Type::UINT64), constant);
+        const auto field = LogicalFunction{FieldAccessLogicalFunction(fieldName)};
+        return LogicalFunction{GreaterLogicalFunction(field, LogicalFunction{constantValue})};
+    }
+
+    [[nodiscard]] LogicalPlan createSelectionQuery(const std::string& constant, std::string sinkName) const
+    {
+        return LogicalPlanBuilder::addSink(
+            std::move(sinkName), LogicalPlanBuilder::addSelection(greaterThan("stream$value", constant), createSourcePlan()));
+    }
+
+    /// Infers the plan, as the selections of the window sizes are inferred on the output schema of the shared aggregation
+    [[nodiscard]] LogicalPlan createTumblingWindowQuery(
+        const uint64_t windowSizeMs, std::shared_ptr<WindowAggregationLogicalFunction> aggregation, std::string sinkName) const
+    {
+        const auto window = std::make_shared<Windowing::TumblingWindow>(
+            Windowing::TimeCharacteristic::createIngestionTime(), Windowing::TimeMeasure(windowSizeMs));
+        auto plan = LogicalPlanBuilder::addSink(
+            std::move(sinkName), LogicalPlanBuilder::addWindowAggregation(createSourcePlan(), window, {std::move(aggregation)}, {}));
+        TypeInferencePhase{}.apply(plan);
+        return plan;
+    }
+
+    static std::shared_ptr<WindowAggregationLogicalFunction> sumOfValues()
+    {
+        return std::make_shared<SumAggregationLogicalFunction>(FieldAccessLogicalFunction("stream$value"));
+    }
+
+    static LogicalOperator getOnlyChild(const LogicalOperator& op)
+    {
+        const auto children = op.getChildren();
+        EXPECT_EQ(children.size(), 1);
+        return children.at(0);
+    }
+
+    SourceCatalog sourceCatalog;
+    std::optional<SourceDescriptor> sourceDescriptor;
+};
+
+/// Equal selections on the same source become a single selection that feeds both sinks
+TEST_F(MergeQueryPlansTest, SharesSourceAndEqualSelection)
+{
+    const auto merged = MergeQueryPlans{}.apply(QueryId(1), {createSelectionQuery("5", "sink_a"), createSelectionQuery("5", "sink_b")});
+
+    EXPECT_EQ(merged.getQueryId(), QueryId(1));
+    const auto roots = merged.getRootOperators();
+    ASSERT_EQ(roots.size(), 2);
+    EXPECT_NE(roots.at(0).getId(), roots.at(1).getId());
+    const auto selection = getOnlyChild(roots.at(0));
+    ASSERT_TRUE(selection.tryGetAs<SelectionLogicalOperator>().has_value());
+    EXPECT_EQ(getOnlyChild(roots.at(1)).getId(), selection.getId());
+}
+
+/// Different selections on the same source share the source only
+TEST_F(MergeQueryPlansTest, SharesSourceOfDifferentSelections)
+{
+    const auto merged = MergeQueryPlans{}.apply(QueryId(1), {createSelectionQuery("5", "sink_a"), createSelectionQuery("6", "sink_b")});
+
+    const auto roots = merged.getRootOperators();
+    ASSERT_EQ(roots.size(), 2);
+    const auto firstSelection = getOnlyChild(roots.at(0));
+    const auto secondSelection = getOnlyChild(roots.at(1));
+    EXPECT_NE(firstSelection.getId(), secondSelection.getId());
+    EXPECT_TRUE(getOnlyChild(firstSelection).tryGetAs<SourceDescriptorLogicalOperator>().has_value());
+    EXPECT_EQ(getOnlyChild(firstSelection).getId(), getOnlyChild(secondSelection).getId());
+}
+
+/// The union of a source with itself must keep both of its inputs, while another query shares one of them
+TEST_F(MergeQueryPlansTest, KeepsEqualSourcesOfOneQueryApart)
+{
+    const auto unionQuery = LogicalPlanBuilder::addSink("sink_a", LogicalPlanBuilder::addUnion(createSourcePlan(), createSourcePlan()));
+    const auto scanQuery = LogicalPlanBuilder::addSink("sink_b", createSourcePlan());
+
+    const auto merged = MergeQueryPlans{}.apply(QueryId(1), {unionQuery, scanQuery});
+
+    const auto roots = merged.getRootOperators();
+    ASSERT_EQ(roots.size(), 2);
+    const auto unionOperator = getOnlyChild(roots.at(0));
+    ASSERT_TRUE(unionOperator.tryGetAs<UnionLogicalOperator>().has_value());
+    const auto unionInputs = unionOperator.getChildren();
+    ASSERT_EQ(unionInputs.size(), 2);
+    EXPECT_NE(unionInputs.at(0).getId(), unionInputs.at(1).getId());
+    EXPECT_EQ(getOnlyChild(roots.at(1)).getId(), unionInputs.at(0).getId());
+}
+
+/// Aggregations over tumbling windows of different sizes share a single aggregation over both sizes, above which each query selects
+/// the windows of its size
+TEST_F(MergeQueryPlansTest, SharesWindowSlicingOfDifferentWindowSizes)
+{
+    const auto merged = MergeQueryPlans{}.apply(
+        QueryId(1), {createTumblingWindowQuery(2000, sumOfValues(), "sink_a"), createTumblingWindowQuery(1000, sumOfValues(), "sink_b")});
+
+    const auto roots = merged.getRootOperators();
+    ASSERT_EQ(roots.size(), 2);
+    const auto firstSelection = getOnlyChild(roots.at(0));
+    const auto secondSelection = getOnlyChild(roots.at(1));
+    ASSERT_TRUE(firstSelection.tryGetAs<SelectionLogicalOperator>().has_value());
+    ASSERT_TRUE(secondSelection.tryGetAs<SelectionLogicalOperator>().has_value());
+    EXPECT_NE(firstSelection.getId(), secondSelection.getId());
+
+    const auto sharedAggregation = getOnlyChild(firstSelection);
+    ASSERT_TRUE(sharedAggregation.tryGetAs<WindowedAggregationLogicalOperator>().has_value());
+    EXPECT_EQ(getOnlyChild(secondSelection).getId(), sharedAggregation.getId());
+    const auto sharedWindowSizes = sharedAggregation.getTraitSet().tryGet<SharedWindowSizesTrait>();
+    ASSERT_TRUE(sharedWindowSizes.has_value());
+    EXPECT_EQ(sharedWindowSizes.value()->windowSizes, (std::vector<uint64_t>{1000, 2000}));
+    EXPECT_TRUE(getOnlyChild(sharedAggregation).tryGetAs<SourceDescriptorLogicalOperator>().has_value());
+}
+
+/// Aggregations that compute different aggregation functions keep their own slices
+TEST_F(MergeQueryPlansTest, KeepsWindowSlicingOfDifferentAggregationsApart)
+{
+    const auto count = std::make_shared<CountAggregationLogicalFunction>(FieldAccessLogicalFunction("stream$value"));
+    const auto merged = MergeQueryPlans{}.apply(
+        QueryId(1), {createTumblingWindowQuery(2000, sumOfValues(), "sink_a"), createTumblingWindowQuery(1000, count, "sink_b")});
+
+    const auto roots = merged.getRootOperators();
+    ASSERT_EQ(roots.size(), 2);
+    for (const auto& root : roots)
+    {
+        const auto aggregation = getOnlyChild(root);
+        ASSERT_TRUE(aggregation.tryGetAs<WindowedAggregationLogicalOperator>().has_value());
+        EXPECT_FALSE(aggregation.getTraitSet().contains<SharedWindowSizesTrait>());
+    }
+    EXPECT_EQ(getOnlyChild(getOnlyChild(roots.at(0))).getId(), getOnlyChild(getOnlyChild(roots.at(1))).getId());
+}
+
+}
+}
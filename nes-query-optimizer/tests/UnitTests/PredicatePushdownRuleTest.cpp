@@ -0,0 +1,207 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+#include <LegacyOptimizer/PredicatePushdownRule.hpp>
+#include <LegacyOptimizer/TypeInferencePhase.hpp>
+
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/DataTypeProvider.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/ArithmeticalFunctions/AddLogicalFunction.hpp>
+#include <Functions/BooleanFunctions/AndLogicalFunction.hpp>
+#include <Functions/BooleanFunctions/EqualsLogicalFunction.hpp>
+#include <Functions/ComparisonFunctions/GreaterLogicalFunction.hpp>
+#include <Functions/ConstantValueLogicalFunction.hpp>
+#include <Functions/FieldAccessLogicalFunction.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Iterators/BFSIterator.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Operators/ProjectionLogicalOperator.hpp>
+#include <Operators/SelectionLogicalOperator.hpp>
+#include <Operators/UnionLogicalOperator.hpp>
+#include <Operators/Windows/JoinLogicalOperator.hpp>
+#include <Plans/LogicalPlan.hpp>
+#include <Plans/LogicalPlanBuilder.hpp>
+#include <WindowTypes/Measures/TimeCharacteristic.hpp>
+#include <WindowTypes/Measures/TimeMeasure.hpp>
+#include <WindowTypes/Types/TumblingWindow.hpp>
+
+namespace NES
+{
+namespace
+{
+
+class PredicatePushdownRuleTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite() { Logger::setupLogging("PredicatePushdownRuleTest.log", LogLevel::LOG_DEBUG); }
+
+    static constexpr uint64_t TUMBLING_WINDOW_SIZE_MS = 1000;
+
+    static LogicalPlan createSourcePlan(const std::string& sourceName)
+    {
+        Schema schema;
+        schema.addField(sourceName + "$id", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+        schema.addField(sourceName + "$value", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+        return LogicalPlanBuilder::createLogicalPlan("TEST", schema, {}, {});
+    }
+
+    static LogicalFunction field(const std::string& fieldName) { return LogicalFunction{FieldAccessLogicalFunction(fieldName)}; }
+
+    static LogicalFunction greaterThan(const std::string& fieldName, const std::string& constant)
+    {
+        const auto constantValue = ConstantValueLogicalFunction(DataTypeProvider::provideDataType(DataType::Type::UINT64), constant);
+        return LogicalFunction{GreaterLogicalFunction(field(fieldName), LogicalFunction{constantValue})};
+    }
+
+    static LogicalFunction conjunction(const LogicalFunction& left, const LogicalFunction& right)
+    {
+        return LogicalFunction{AndLogicalFunction(left, right)};
+    }
+
+    /// Infers the plan, pushes down its predicates, and infers the plan again to verify that the pushed selections are valid
+    static LogicalPlan pushDownPredicates(LogicalPlan plan)
+    {
+        constexpr auto typeInference = TypeInferencePhase{};
+        typeInference.apply(plan);
+        PredicatePushdownRule{}.apply(plan);
+        typeInference.apply(plan);
+        return plan;
+    }
+
+    static LogicalOperator getOnlyChild(const LogicalOperator& op)
+    {
+        const auto children = op.getChildren();
+        EXPECT_EQ(children.size(), 1);
+        return children.at(0);
+    }
+
+    static std::vector<std::string> getAccessedFields(const LogicalOperator& selection)
+    {
+        std::vector<std::string> accessedFields;
+        for (const auto& function : BFSRange(selection.getAs<SelectionLogicalOperator>()->getPredicate()))
+        {
+            if (const auto fieldAccess = function.tryGetAs<FieldAccessLogicalFunction>())
+            {
+                accessedFields.push_back(fieldAccess.value()->getFieldName());
+            }
+        }
+        return accessedFields;
+    }
+};
+
+/// The conjunctions on a single side move to their side of the join, while the conjunction on both sides stays above the join
+TEST_F(PredicatePushdownRuleTest, SplitsConjunctionsOntoJoinSides)
+{
+    const auto joinFunction = LogicalFunction{EqualsLogicalFunction(field("left$id"), field("right$id"))};
+    auto plan = LogicalPlanBuilder::addJoin(
+        createSourcePlan("left"),
+        createSourcePlan("right"),
+        joinFunction,
+        std::make_shared<Windowing::TumblingWindow>(
+            Windowing::TimeCharacteristic::createIngestionTime(), Windowing::TimeMeasure(TUMBLING_WINDOW_SIZE_MS)),
+        JoinLogicalOperator::JoinType::INNER_JOIN);
+    const auto predicate = conjunction(
+        conjunction(greaterThan("left$value", "5"), LogicalFunction{EqualsLogicalFunction(field("left$value"), field("right$value"))}),
+        greaterThan("right$value", "10"));
+    plan = LogicalPlanBuilder::addSink("test_sink", LogicalPlanBuilder::addSelection(predicate, plan));
+
+    const auto result = pushDownPredicates(plan);
+
+    const auto remaining = getOnlyChild(result.getRootOperators().at(0));
+    ASSERT_TRUE(remaining.tryGetAs<SelectionLogicalOperator>().has_value());
+    EXPECT_EQ(getAccessedFields(remaining), (std::vector<std::string>{"left$value", "right$value"}));
+
+    const auto join = getOnlyChild(remaining);
+    ASSERT_TRUE(join.tryGetAs<JoinLogicalOperator>().has_value());
+    const auto joinInputs = join.getChildren();
+    ASSERT_EQ(joinInputs.size(), 2);
+    ASSERT_TRUE(joinInputs[0].tryGetAs<SelectionLogicalOperator>().has_value());
+    EXPECT_EQ(getAccessedFields(joinInputs[0]), (std::vector<std::string>{"left$value"}));
+    ASSERT_TRUE(joinInputs[1].tryGetAs<SelectionLogicalOperator>().has_value());
+    EXPECT_EQ(getAccessedFields(joinInputs[1]), (std::vector<std::string>{"right$value"}));
+}
+
+/// Every input of the union receives a copy of the selection
+TEST_F(PredicatePushdownRuleTest, DuplicatesSelectionBelowUnion)
+{
+    auto plan = LogicalPlanBuilder::addUnion(createSourcePlan("first"), createSourcePlan("second"));
+    plan = LogicalPlanBuilder::addSink("test_sink", LogicalPlanBuilder::addSelection(greaterThan("value", "5"), plan));
+
+    const auto result = pushDownPredicates(plan);
+
+    const auto unionOperator = getOnlyChild(result.getRootOperators().at(0));
+    ASSERT_TRUE(unionOperator.tryGetAs<UnionLogicalOperator>().has_value());
+    const auto unionInputs = unionOperator.getChildren();
+    ASSERT_EQ(unionInputs.size(), 2);
+    for (const auto& [input, sourceName] : {std::pair{unionInputs[0], "first"}, std::pair{unionInputs[1], "second"}})
+    {
+        ASSERT_TRUE(input.tryGetAs<SelectionLogicalOperator>().has_value());
+        EXPECT_EQ(getAccessedFields(input), (std::vector<std::string>{std::string(sourceName) + "$value"}));
+    }
+    EXPECT_NE(unionInputs[0].getId(), unionInputs[1].getId());
+}
+
+/// Predicates on renamed fields move below the projection, predicates on computed fields stay above it
+TEST_F(PredicatePushdownRuleTest, PushesPredicatesOnForwardedFieldsBelowProjection)
+{
+    auto plan = LogicalPlanBuilder::addProjection(
+        {ProjectionLogicalOperator::Projection{FieldIdentifier("renamed"), field("stream$value")},
+         ProjectionLogicalOperator::Projection{
+             FieldIdentifier("computed"), LogicalFunction{AddLogicalFunction(field("stream$id"), field("stream$value"))}}},
+        false,
+        createSourcePlan("stream"));
+    plan = LogicalPlanBuilder::addSelection(conjunction(greaterThan("renamed", "5"), greaterThan("computed", "10")), plan);
+    plan = LogicalPlanBuilder::addSink("test_sink", plan);
+
+    const auto result = pushDownPredicates(plan);
+
+    const auto remaining = getOnlyChild(result.getRootOperators().at(0));
+    ASSERT_TRUE(remaining.tryGetAs<SelectionLogicalOperator>().has_value());
+    EXPECT_EQ(getAccessedFields(remaining), (std::vector<std::string>{"computed"}));
+
+    const auto projection = getOnlyChild(remaining);
+    ASSERT_TRUE(projection.tryGetAs<ProjectionLogicalOperator>().has_value());
+    const auto pushed = getOnlyChild(projection);
+    ASSERT_TRUE(pushed.tryGetAs<SelectionLogicalOperator>().has_value());
+    EXPECT_EQ(getAccessedFields(pushed), (std::vector<std::string>{"stream$value"}));
+}
+
+/// Without a union, join, or projection below it, the selection remains unchanged
+TEST_F(PredicatePushdownRuleTest, KeepsSelectionAboveSource)
+{
+    auto plan = LogicalPlanBuilder::addSelection(greaterThan("stream$value", "5"), createSourcePlan("stream"));
+    plan = LogicalPlanBuilder::addSink("test_sink", plan);
+    const auto selectionId = getOperatorByType<SelectionLogicalOperator>(plan).at(0).getId();
+
+    const auto result = pushDownPredicates(plan);
+
+    const auto selection = getOnlyChild(result.getRootOperators().at(0));
+    ASSERT_TRUE(selection.tryGetAs<SelectionLogicalOperator>().has_value());
+    EXPECT_EQ(selection.getId(), selectionId);
+}
+
+}
+}
@@ -0,0 +1,170 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+#include <LegacyOptimizer/ProjectionPushdownRule.hpp>
+#include <LegacyOptimizer/TypeInferencePhase.hpp>
+
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/DataTypeProvider.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/ComparisonFunctions/GreaterLogicalFunction.hpp>
+#include <Functions/ConstantValueLogicalFunction.hpp>
+#include <Functions/FieldAccessLogicalFunction.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Operators/ProjectionLogicalOperator.hpp>
+#include <Operators/SelectionLogicalOperator.hpp>
+#include <Operators/Sources/SourceDescriptorLogicalOperator.hpp>
+#include <Operators/UnionLogicalOperator.hpp>
+#include <Plans/LogicalPlan.hpp>
+#include <Plans/LogicalPlanBuilder.hpp>
+#include <Sources/SourceCatalog.hpp>
+
+namespace NES
+{
+namespace
+{
+
+class ProjectionPushdownRuleTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite() { Logger::setupLogging("ProjectionPushdownRuleTest.log", LogLevel::LOG_DEBUG); }
+
+    /// Creates a plan that reads a new physical source of the logical source 'stream' with the fields id, value, and payload
+    LogicalPlan createSourcePlan()
+    {
+        auto logicalSource = sourceCatalog.getLogicalSource("stream");
+        if (not logicalSource.has_value())
+        {
+            Schema schema;
+            schema.addField("id", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+            schema.addField("value", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+            schema.addField("payload", DataTypeProvider::provideDataType(DataType::Type::VARSIZED));
+            logicalSource = sourceCatalog.addLogicalSource("stream", schema);
+        }
+        auto sourceDescriptor
+            = sourceCatalog.addPhysicalSource(logicalSource.value(), "File", {{"file_path", "/dev/null"}}, {{"type", "CSV"}});
+        EXPECT_TRUE(sourceDescriptor.has_value());
+        return LogicalPlan(SourceDescriptorLogicalOperator(std::move(sourceDescriptor.value())));
+    }
+
+    static LogicalFunction field(const std::string& fieldName) { return LogicalFunction{FieldAccessLogicalFunction(fieldName)}; }
+
+    static LogicalFunction greaterThan(const std::string& fieldName, const std::string& constant)
+    {
+        const auto constantValue = ConstantValueLogicalFunction(DataTypeProvider::provideDataType(DataType::Type::UINT64), constant);
+        return LogicalFunction{GreaterLogicalFunction(field(fieldName), LogicalFunction{constantValue})};
+    }
+
+    static LogicalPlan addProjectionOf(const std::string& fieldName, const LogicalPlan& plan)
+    {
+        return LogicalPlanBuilder::addProjection({ProjectionLogicalOperator::Projection{std::nullopt, field(fieldName)}}, false, plan);
+    }
+
+    /// Infers the plan, pushes down its projections, and infers the plan again to verify that the narrowed plan is valid
+    static LogicalPlan pushDownProjections(LogicalPlan plan)
+    {
+        constexpr auto typeInference = TypeInferencePhase{};
+        typeInference.apply(plan);
+        ProjectionPushdownRule{}.apply(plan);
+        typeInference.apply(plan);
+        return plan;
+    }
+
+    static LogicalOperator getOnlyChild(const LogicalOperator& op)
+    {
+        const auto children = op.getChildren();
+        EXPECT_EQ(children.size(), 1);
+        return children.at(0);
+    }
+
+    /// Expects a projection on the given fields above a source
+    static void expectNarrowedSource(const LogicalOperator& op, const std::vector<std::string>& fieldNames)
+    {
+        ASSERT_TRUE(op.tryGetAs<ProjectionLogicalOperator>().has_value());
+        EXPECT_EQ(op.getOutputSchema().getFieldNames(), fieldNames);
+        EXPECT_TRUE(getOnlyChild(op).tryGetAs<SourceDescriptorLogicalOperator>().has_value());
+    }
+
+    SourceCatalog sourceCatalog;
+};
+
+/// The source below the selection only keeps the fields that the selection and the projection above it read
+TEST_F(ProjectionPushdownRuleTest, NarrowsSourceBelowSelection)
+{
+    auto plan = LogicalPlanBuilder::addSelection(greaterThan("stream$value", "5"), createSourcePlan());
+    plan = LogicalPlanBuilder::addSink("test_sink", addProjectionOf("stream$id", plan));
+
+    const auto result = pushDownProjections(plan);
+
+    const auto selection = getOnlyChild(getOnlyChild(result.getRootOperators().at(0)));
+    ASSERT_TRUE(selection.tryGetAs<SelectionLogicalOperator>().has_value());
+    expectNarrowedSource(getOnlyChild(selection), {"stream$id", "stream$value"});
+}
+
+/// Every input of the union is narrowed to the same fields, so that the schemas of the inputs remain equal
+TEST_F(ProjectionPushdownRuleTest, NarrowsAllInputsOfUnion)
+{
+    auto plan = LogicalPlanBuilder::addUnion(createSourcePlan(), createSourcePlan());
+    plan = LogicalPlanBuilder::addSink("test_sink", addProjectionOf("stream$payload", plan));
+
+    const auto result = pushDownProjections(plan);
+
+    const auto unionOperator = getOnlyChild(getOnlyChild(result.getRootOperators().at(0)));
+    ASSERT_TRUE(unionOperator.tryGetAs<UnionLogicalOperator>().has_value());
+    const auto unionInputs = unionOperator.getChildren();
+    ASSERT_EQ(unionInputs.size(), 2);
+    for (const auto& input : unionInputs)
+    {
+        expectNarrowedSource(input, {"stream$payload"});
+    }
+}
+
+/// The scan of a projection on a source already formats only the accessed fields
+TEST_F(ProjectionPushdownRuleTest, KeepsSourceBelowProjection)
+{
+    const auto plan = LogicalPlanBuilder::addSink("test_sink", addProjectionOf("stream$id", createSourcePlan()));
+
+    const auto result = pushDownProjections(plan);
+
+    const auto projection = getOnlyChild(result.getRootOperators().at(0));
+    ASSERT_TRUE(projection.tryGetAs<ProjectionLogicalOperator>().has_value());
+    EXPECT_TRUE(getOnlyChild(projection).tryGetAs<SourceDescriptorLogicalOperator>().has_value());
+}
+
+/// The sink reads all fields of the source
+TEST_F(ProjectionPushdownRuleTest, KeepsSourceBelowSink)
+{
+    const auto plan
+        = LogicalPlanBuilder::addSink("test_sink", LogicalPlanBuilder::addSelection(greaterThan("stream$value", "5"), createSourcePlan()));
+
+    const auto result = pushDownProjections(plan);
+
+    const auto selection = getOnlyChild(result.getRootOperators().at(0));
+    ASSERT_TRUE(selection.tryGetAs<SelectionLogicalOperator>().has_value());
+    EXPECT_TRUE(getOnlyChild(selection).tryGetAs<SourceDescriptorLogicalOperator>().has_value());
+}
+
+}
+}
@@ -0,0 +1,145 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+#include <LegacyOptimizer/TypeInferencePhase.hpp>
+#include <Phases/PropagateClusteredFields.hpp>
+
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/DataTypeProvider.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/ComparisonFunctions/GreaterLogicalFunction.hpp>
+#include <Functions/ConstantValueLogicalFunction.hpp>
+#include <Functions/FieldAccessLogicalFunction.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Operators/ProjectionLogicalOperator.hpp>
+#include <Operators/Sources/SourceDescriptorLogicalOperator.hpp>
+#include <Plans/LogicalPlan.hpp>
+#include <Plans/LogicalPlanBuilder.hpp>
+#include <Sources/SourceCatalog.hpp>
+#include <Traits/ClusteredFieldsTrait.hpp>
+#include <Traits/TraitSet.hpp>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+namespace
+{
+
+class PropagateClusteredFieldsTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite() { Logger::setupLogging("PropagateClusteredFieldsTest.log", LogLevel::LOG_DEBUG); }
+
+    /// Creates a plan that reads a physical source of the logical source 'stream' with the fields id and value
+    LogicalPlan createStreamSourcePlan(const std::string& clusteredBy)
+    {
+        auto logicalSource = sourceCatalog.getLogicalSource("stream");
+        if (not logicalSource.has_value())
+        {
+            Schema schema;
+            schema.addField("id", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+            schema.addField("value", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+            logicalSource = sourceCatalog.addLogicalSource("stream", schema);
+        }
+        std::unordered_map<std::string, std::string> config{{"file_path", "/dev/null"}};
+        if (not clusteredBy.empty())
+        {
+            config.emplace("clustered_by", clusteredBy);
+        }
+        auto sourceDescriptor = sourceCatalog.addPhysicalSource(logicalSource.value(), "File", std::move(config), {{"type", "CSV"}});
+        EXPECT_TRUE(sourceDescriptor.has_value());
+        return LogicalPlan(SourceDescriptorLogicalOperator(std::move(sourceDescriptor.value())));
+    }
+
+    /// Source -> selection on stream$value -> projection of the given fields -> sink
+    LogicalPlan createSelectionAndProjectionPlan(const std::string& clusteredBy, const std::vector<std::string>& projectedFields)
+    {
+        const auto constant = ConstantValueLogicalFunction(DataTypeProvider::provideDataType(DataType::Type::UINT64), "5");
+        auto plan = LogicalPlanBuilder::addSelection(
+            LogicalFunction{GreaterLogicalFunction(LogicalFunction{FieldAccessLogicalFunction("stream$value")}, LogicalFunction{constant})},
+            createStreamSourcePlan(clusteredBy));
+        std::vector<ProjectionLogicalOperator::Projection> projections;
+        for (const auto& fieldName : projectedFields)
+        {
+            projections.emplace_back(std::nullopt, LogicalFunction{FieldAccessLogicalFunction(fieldName)});
+        }
+        plan = LogicalPlanBuilder::addSink("test_sink", LogicalPlanBuilder::addProjection(std::move(projections), false, plan));
+        TypeInferencePhase{}.apply(plan);
+        return plan;
+    }
+
+    static std::optional<std::vector<std::string>> getClusteredFields(const LogicalOperator& logicalOperator)
+    {
+        const auto clusteredFields = logicalOperator.getTraitSet().tryGet<ClusteredFieldsTrait>();
+        return clusteredFields.has_value() ? std::make_optional(clusteredFields.value()->fieldNames) : std::nullopt;
+    }
+
+    SourceCatalog sourceCatalog;
+};
+
+/// The selection forwards the runs of the source and the projection forwards the clustered field. The sink ends the clustering.
+TEST_F(PropagateClusteredFieldsTest, SelectionAndProjectionKeepClusteredField)
+{
+    const auto result = PropagateClusteredFields{}.apply(createSelectionAndProjectionPlan("id", {"stream$id", "stream$value"}));
+
+    const auto sink = result.getRootOperators()[0];
+    const auto projection = sink.getChildren().at(0);
+    const auto selection = projection.getChildren().at(0);
+    const auto source = selection.getChildren().at(0);
+    const std::vector<std::string> expected{"stream$id"};
+    EXPECT_EQ(getClusteredFields(source), expected);
+    EXPECT_EQ(getClusteredFields(selection), expected);
+    EXPECT_EQ(getClusteredFields(projection), expected);
+    EXPECT_EQ(getClusteredFields(sink), std::nullopt);
+    EXPECT_TRUE(projection.getTraitSet().get<ClusteredFieldsTrait>()->clusters({"stream$id"}));
+    EXPECT_FALSE(projection.getTraitSet().get<ClusteredFieldsTrait>()->clusters({"stream$id", "stream$value"}));
+}
+
+TEST_F(PropagateClusteredFieldsTest, ProjectionWithoutClusteredFieldEndsClustering)
+{
+    const auto result = PropagateClusteredFields{}.apply(createSelectionAndProjectionPlan("id", {"stream$value"}));
+
+    const auto projection = result.getRootOperators()[0].getChildren().at(0);
+    EXPECT_EQ(getClusteredFields(projection), std::nullopt);
+    EXPECT_EQ(getClusteredFields(projection.getChildren().at(0)), std::vector<std::string>{"stream$id"});
+}
+
+TEST_F(PropagateClusteredFieldsTest, SourceWithoutDeclarationIsNotClustered)
+{
+    const auto result = PropagateClusteredFields{}.apply(createSelectionAndProjectionPlan("", {"stream$id", "stream$value"}));
+
+    const auto projection = result.getRootOperators()[0].getChildren().at(0);
+    EXPECT_EQ(getClusteredFields(projection), std::nullopt);
+    EXPECT_EQ(getClusteredFields(projection.getChildren().at(0).getChildren().at(0)), std::nullopt);
+}
+
+TEST_F(PropagateClusteredFieldsTest, UnknownClusteredFieldIsRejected)
+{
+    const auto plan = createSelectionAndProjectionPlan("device", {"stream$id"});
+    EXPECT_THROW(PropagateClusteredFields{}.apply(plan), InvalidConfigParameter);
+}
+
+}
+}
@@ -0,0 +1,156 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+#include <Phases/JoinCostModel.hpp>
+#include <QueryResourceEstimator.hpp>
+
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/DataTypeProvider.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/BooleanFunctions/EqualsLogicalFunction.hpp>
+#include <Functions/FieldAccessLogicalFunction.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Operators/Windows/JoinLogicalOperator.hpp>
+#include <Plans/LogicalPlan.hpp>
+#include <Plans/LogicalPlanBuilder.hpp>
+#include <WindowTypes/Measures/TimeCharacteristic.hpp>
+#include <WindowTypes/Measures/TimeMeasure.hpp>
+#include <WindowTypes/Types/SlidingWindow.hpp>
+#include <WindowTypes/Types/TumblingWindow.hpp>
+#include <WindowTypes/Types/WindowType.hpp>
+#include <Sources/ColumnStatistics.hpp>
+#include <SourceStatistics.hpp>
+
+namespace NES
+{
+namespace
+{
+
+class TestSourceStatistics final : public SourceStatistics
+{
+public:
+    explicit TestSourceStatistics(std::unordered_map<std::string, double> tuplesPerSecond) : tuplesPerSecond(std::move(tuplesPerSecond))
+    {
+    }
+
+    [[nodiscard]] std::optional<double> getTuplesPerSecond(const std::string& logicalSourceName) const override
+    {
+        if (const auto rate = tuplesPerSecond.find(logicalSourceName); rate != tuplesPerSecond.end())
+        {
+            return rate->second;
+        }
+        return std::nullopt;
+    }
+
+    [[nodiscard]] std::optional<ColumnStatistics> getColumnStatistics(const std::string&) const override { return std::nullopt; }
+
+private:
+    std::unordered_map<std::string, double> tuplesPerSecond;
+};
+
+class QueryResourceEstimatorTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite() { Logger::setupLogging("QueryResourceEstimatorTest.log", LogLevel::LOG_DEBUG); }
+
+    static constexpr uint64_t WINDOW_SIZE_MS = 2000;
+    /// Three UINT64 fields
+    static constexpr double TUPLE_SIZE_IN_BYTES = 24;
+
+    static Schema createSchema(const std::string& prefix)
+    {
+        Schema schema;
+        schema.addField(prefix + ".id", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+        schema.addField(prefix + ".value", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+        schema.addField(prefix + ".ts", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+        return schema;
+    }
+
+    /// Joins the logical sources "left" and "right" on their ids and infers the schemas of the join
+    static LogicalPlan createJoinPlan(const std::shared_ptr<Windowing::WindowType>& windowType)
+    {
+        const auto joinFunction = LogicalFunction{EqualsLogicalFunction(
+            LogicalFunction{FieldAccessLogicalFunction("left.id")}, LogicalFunction{FieldAccessLogicalFunction("right.id")})};
+        auto plan = LogicalPlanBuilder::addJoin(
+            LogicalPlanBuilder::createLogicalPlan("left"),
+            LogicalPlanBuilder::createLogicalPlan("right"),
+            joinFunction,
+            windowType,
+            JoinLogicalOperator::JoinType::INNER_JOIN);
+        plan = LogicalPlanBuilder::addSink("test_sink", plan);
+        const auto join = getOperatorByType<JoinLogicalOperator>(plan).at(0);
+        return replaceOperator(plan, join.getId(), LogicalOperator{join->withInferredSchema({createSchema("left"), createSchema("right")})})
+            .value();
+    }
+
+    static std::shared_ptr<Windowing::WindowType> createTumblingWindow()
+    {
+        return std::make_shared<Windowing::TumblingWindow>(
+            Windowing::TimeCharacteristic::createIngestionTime(), Windowing::TimeMeasure(WINDOW_SIZE_MS));
+    }
+};
+
+/// The join keeps the tuples of both inputs for a whole window
+TEST_F(QueryResourceEstimatorTest, JoinStateGrowsWithRatesAndWindowSize)
+{
+    const TestSourceStatistics statistics({{"left", 1000}, {"right", 3000}});
+    const auto estimate = QueryResourceEstimator::estimate(createJoinPlan(createTumblingWindow()), &statistics);
+    EXPECT_DOUBLE_EQ(estimate.stateSizeInBytes, ((1000 * 2) + (3000 * 2)) * TUPLE_SIZE_IN_BYTES);
+}
+
+/// Without rates, we fall back to the same default as the join cost model
+TEST_F(QueryResourceEstimatorTest, UnknownRatesFallBackToDefaultTuplesPerWindow)
+{
+    const auto estimate = QueryResourceEstimator::estimate(createJoinPlan(createTumblingWindow()), nullptr);
+    EXPECT_DOUBLE_EQ(estimate.stateSizeInBytes, 2 * JoinCostModel::DEFAULT_TUPLES_PER_WINDOW * TUPLE_SIZE_IN_BYTES);
+    EXPECT_DOUBLE_EQ(estimate.busyWorkerThreads, 0);
+}
+
+/// Every operator pays for the tuples of the sources below it: two sources, the join, and the sink
+TEST_F(QueryResourceEstimatorTest, BusyWorkerThreadsSumUpTheTuplesOfAllOperators)
+{
+    const TestSourceStatistics statistics({{"left", 1E6}, {"right", 1E6}});
+    const auto estimate = QueryResourceEstimator::estimate(createJoinPlan(createTumblingWindow()), &statistics);
+    constexpr double tuplesOfAllOperators = 1E6 + 1E6 + 2E6 + 2E6;
+    EXPECT_DOUBLE_EQ(estimate.busyWorkerThreads, tuplesOfAllOperators * QueryResourceEstimator::NANOSECONDS_PER_TUPLE_AND_OPERATOR / 1E9);
+}
+
+/// A faster source leads to a higher estimate, so that admission control rejects the heavier of two otherwise identical queries first
+TEST_F(QueryResourceEstimatorTest, HigherRatesLeadToHigherEstimates)
+{
+    const TestSourceStatistics slow({{"left", 10}, {"right", 10}});
+    const TestSourceStatistics fast({{"left", 1E5}, {"right", 1E5}});
+    const auto plan = createJoinPlan(std::make_shared<Windowing::SlidingWindow>(
+        Windowing::TimeCharacteristic::createIngestionTime(), Windowing::TimeMeasure(WINDOW_SIZE_MS), Windowing::TimeMeasure(500)));
+    const auto slowEstimate = QueryResourceEstimator::estimate(plan, &slow);
+    const auto fastEstimate = QueryResourceEstimator::estimate(plan, &fast);
+    EXPECT_LT(slowEstimate.stateSizeInBytes, fastEstimate.stateSizeInBytes);
+    EXPECT_LT(slowEstimate.busyWorkerThreads, fastEstimate.busyWorkerThreads);
+}
+
+}
+}
@@ -0,0 +1,198 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+#include <LegacyOptimizer/TypeInferencePhase.hpp>
+#include <Phases/ReorderJoins.hpp>
+
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/DataTypeProvider.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/BooleanFunctions/EqualsLogicalFunction.hpp>
+#include <Functions/FieldAccessLogicalFunction.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Operators/ProjectionLogicalOperator.hpp>
+#include <Operators/Windows/JoinLogicalOperator.hpp>
+#include <Plans/LogicalPlan.hpp>
+#include <Plans/LogicalPlanBuilder.hpp>
+#include <Traits/JoinStateEstimateTrait.hpp>
+#include <Util/PlanRenderer.hpp>
+#include <WindowTypes/Measures/TimeCharacteristic.hpp>
+#include <WindowTypes/Measures/TimeMeasure.hpp>
+#include <WindowTypes/Types/SlidingWindow.hpp>
+#include <WindowTypes/Types/TumblingWindow.hpp>
+#include <WindowTypes/Types/WindowType.hpp>
+
+namespace NES
+{
+namespace
+{
+
+class ReorderJoinsTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite() { Logger::setupLogging("ReorderJoinsTest.log", LogLevel::LOG_DEBUG); }
+
+    static constexpr uint64_t WINDOW_SIZE_MS = 1000;
+
+    /// The key of a source has only 256 distinct values, while its id is (nearly) unique per window
+    static LogicalPlan createSourcePlan(const std::string& sourceName)
+    {
+        Schema schema;
+        schema.addField(sourceName + "$key", DataTypeProvider::provideDataType(DataType::Type::UINT8));
+        schema.addField(sourceName + "$id", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+        schema.addField(sourceName + "$ts", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+        return LogicalPlanBuilder::createLogicalPlan("TEST", schema, {}, {});
+    }
+
+    static std::shared_ptr<Windowing::WindowType> createTumblingWindow()
+    {
+        return std::make_shared<Windowing::TumblingWindow>(
+            Windowing::TimeCharacteristic::createEventTime(FieldAccessLogicalFunction("ts")), Windowing::TimeMeasure(WINDOW_SIZE_MS));
+    }
+
+    static LogicalFunction equals(const std::string& leftField, const std::string& rightField)
+    {
+        return LogicalFunction{EqualsLogicalFunction(
+            LogicalFunction{FieldAccessLogicalFunction(leftField)}, LogicalFunction{FieldAccessLogicalFunction(rightField)})};
+    }
+
+    static LogicalPlan join(const LogicalPlan& left, const LogicalPlan& right, const LogicalFunction& joinFunction)
+    {
+        return join(left, right, joinFunction, createTumblingWindow());
+    }
+
+    static LogicalPlan join(
+        const LogicalPlan& left,
+        const LogicalPlan& right,
+        const LogicalFunction& joinFunction,
+        const std::shared_ptr<Windowing::WindowType>& windowType)
+    {
+        return LogicalPlanBuilder::addJoin(left, right, joinFunction, windowType, JoinLogicalOperator::JoinType::INNER_JOIN);
+    }
+
+    /// Infers the plan, reorders its joins, and infers the plan again to verify that the reordered plan is valid
+    static LogicalPlan reorder(LogicalPlan plan)
+    {
+        constexpr auto typeInference = TypeInferencePhase{};
+        plan = LogicalPlanBuilder::addSink("test_sink", plan);
+        typeInference.apply(plan);
+        plan = ReorderJoins{}.apply(plan);
+        typeInference.apply(plan);
+        return plan;
+    }
+
+    static LogicalOperator getOnlyChild(const LogicalOperator& op)
+    {
+        const auto children = op.getChildren();
+        EXPECT_EQ(children.size(), 1);
+        return children.at(0);
+    }
+
+    static bool isJoin(const LogicalOperator& op) { return op.tryGetAs<JoinLogicalOperator>().has_value(); }
+};
+
+/// Joining a and b on their keys first yields a large intermediate result, as they share few distinct keys. Joining b and c on their ids
+/// first keeps the intermediate result small, thus the phase joins a with the result of joining b and c.
+TEST_F(ReorderJoinsTest, JoinsSelectiveInputsFirst)
+{
+    const auto writtenOrder = join(
+        join(createSourcePlan("a"), createSourcePlan("b"), equals("a$key", "b$key")), createSourcePlan("c"), equals("b$id", "c$id"));
+    auto originalPlan = LogicalPlanBuilder::addSink("test_sink", writtenOrder);
+    TypeInferencePhase{}.apply(originalPlan);
+    const auto originalSchema = getOnlyChild(originalPlan.getRootOperators().at(0)).getOutputSchema();
+
+    const auto result = reorder(writtenOrder);
+
+    /// The projection restores the fields in the order of the query, including the window fields of the join of a and b
+    const auto projection = getOnlyChild(result.getRootOperators().at(0));
+    ASSERT_TRUE(projection.tryGetAs<ProjectionLogicalOperator>().has_value());
+    EXPECT_EQ(projection.getOutputSchema().getFieldNames(), originalSchema.getFieldNames());
+
+    const auto topmostJoin = getOnlyChild(projection);
+    ASSERT_TRUE(isJoin(topmostJoin));
+    const auto children = topmostJoin.getChildren();
+    ASSERT_EQ(children.size(), 2);
+    EXPECT_TRUE(children[0].getOutputSchema().contains("a$key"));
+    EXPECT_FALSE(isJoin(children[0]));
+    ASSERT_TRUE(isJoin(children[1]));
+    EXPECT_TRUE(children[1].getOutputSchema().contains("b$id"));
+    EXPECT_TRUE(children[1].getOutputSchema().contains("c$id"));
+}
+
+/// The query already joins b and c on their ids first, thus the phase keeps the order and the fields of the query
+TEST_F(ReorderJoinsTest, KeepsCheapestWrittenOrder)
+{
+    const auto writtenOrder = join(
+        join(createSourcePlan("b"), createSourcePlan("c"), equals("b$id", "c$id")), createSourcePlan("a"), equals("a$key", "b$key"));
+
+    const auto result = reorder(writtenOrder);
+
+    const auto topmostJoin = getOnlyChild(result.getRootOperators().at(0));
+    ASSERT_TRUE(isJoin(topmostJoin));
+    const auto children = topmostJoin.getChildren();
+    ASSERT_EQ(children.size(), 2);
+    ASSERT_TRUE(isJoin(children[0]));
+    EXPECT_TRUE(children[0].getOutputSchema().contains("c$id"));
+    EXPECT_FALSE(isJoin(children[1]));
+}
+
+/// Sliding windows join a tuple in multiple windows, thus the order of the joins changes the joined tuples
+TEST_F(ReorderJoinsTest, KeepsJoinsOverSlidingWindowsInOrder)
+{
+    const auto slidingWindow = []() -> std::shared_ptr<Windowing::WindowType>
+    {
+        return Windowing::SlidingWindow::of(
+            Windowing::TimeCharacteristic::createEventTime(FieldAccessLogicalFunction("ts")),
+            Windowing::TimeMeasure(WINDOW_SIZE_MS),
+            Windowing::TimeMeasure(WINDOW_SIZE_MS / 2));
+    };
+    const auto writtenOrder = join(
+        join(createSourcePlan("a"), createSourcePlan("b"), equals("a$key", "b$key"), slidingWindow()),
+        createSourcePlan("c"),
+        equals("b$id", "c$id"),
+        slidingWindow());
+
+    const auto result = reorder(writtenOrder);
+
+    const auto topmostJoin = getOnlyChild(result.getRootOperators().at(0));
+    ASSERT_TRUE(isJoin(topmostJoin));
+    ASSERT_TRUE(isJoin(topmostJoin.getChildren().at(0)));
+    EXPECT_TRUE(topmostJoin.getChildren().at(0).getOutputSchema().contains("a$key"));
+}
+
+/// Every join carries its estimated state per slice, which the explained plan shows
+TEST_F(ReorderJoinsTest, ExplainShowsEstimatedStatePerSlice)
+{
+    const auto result = reorder(join(createSourcePlan("a"), createSourcePlan("b"), equals("a$id", "b$id")));
+
+    const auto joinOperator = getOnlyChild(result.getRootOperators().at(0));
+    const auto stateEstimate = joinOperator.getTraitSet().tryGet<JoinStateEstimateTrait>();
+    ASSERT_TRUE(stateEstimate.has_value());
+    EXPECT_GT(stateEstimate.value()->bytesPerSlice, 0);
+    EXPECT_NE(explain(result, ExplainVerbosity::Short).find("estimated state per slice"), std::string::npos);
+}
+
+}
+}
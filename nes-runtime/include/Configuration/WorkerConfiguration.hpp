@@ -21,7 +21,9 @@
 #include <Configurations/BaseOption.hpp>
 #include <Configurations/Enums/EnumOption.hpp>
 #include <Configurations/ScalarOption.hpp>
+#include <Configurations/Validation/CpuListValidation.hpp>
 #include <Configurations/Validation/NumberValidation.hpp>
+#include <Runtime/Allocator/HugePageMemoryResource.hpp>
 #include <Util/DumpMode.hpp>
 #include <QueryEngineConfiguration.hpp>
 #include <QueryExecutionConfiguration.hpp>
@@ -46,6 +48,49 @@ public:
            "Number buffers in global buffer pool.",
            {std::make_shared<NumberValidation>()}};
 
+    /// Splits the global buffer pool into one pool per NUMA node. Threads get their buffers from the pool of their local NUMA node.
+    BoolOption numaAwareBufferManager
+        = {"numa_aware_buffer_manager", "false", "Keep one buffer pool per NUMA node and prefer buffers of the local NUMA node."};
+
+    /// Backs the global buffer pool and the unpooled buffers with huge pages to reduce TLB misses. Falls back to smaller pages if the
+    /// requested huge pages are not available.
+    EnumOption<HugePageMode> hugePages
+        = {"huge_pages",
+           HugePageMode::NONE,
+           "Kind of pages that back the global buffer pool and unpooled buffers [NONE|TRANSPARENT|EXPLICIT_2MB|EXPLICIT_1GB]."};
+
+    /// Faulting in the global buffer pool upfront would delay the start of the worker, thus a background thread faults it in instead,
+    /// while the worker already serves requests. Locking the pool additionally prevents the OS from swapping it out.
+    BoolOption prefaultBufferPool
+        = {"prefault_buffer_pool", "false", "Fault in the memory of the global buffer pool in the background after the worker started."};
+    BoolOption lockBufferPool
+        = {"lock_buffer_pool",
+           "false",
+           "Lock the memory of the global buffer pool into RAM (mlock) in the background after the worker started. Requires a "
+           "sufficient RLIMIT_MEMLOCK."};
+    /// Shows which queries and pipelines retain the buffers, e.g., to size the pool or to find the state that stalls the sources
+    BoolOption trackBufferOwnership
+        = {"track_buffer_ownership",
+           "false",
+           "Account every buffer to the query and pipeline that acquired it, until the buffer is released. The worker reports the "
+           "buffers held per owner via its metrics and the RequestBufferUsage RPC."};
+
+    /// Number of pooled buffers every thread caches in front of the global buffer pool. Buffers cached by one thread are not available
+    /// to other threads, so this should be small compared to the number of buffers in the global buffer manager.
+    UIntOption threadLocalBufferCacheSize
+        = {"thread_local_buffer_cache_size",
+           "0",
+           "Number of buffers each thread caches in front of the global buffer pool. 0 disables the thread-local caches.",
+           {std::make_shared<NumberValidation>()}};
+
+    /// Hash map pages, variable-sized data, and other unpooled buffers of up to 1MiB are served from preallocated pools of 4KiB, 64KiB,
+    /// and 1MiB buffers instead of being allocated on the spot. The pools take about this number times 1.1MiB of memory.
+    UIntOption numberOfBuffersPerSizeClass
+        = {"number_of_buffers_per_size_class",
+           "0",
+           "Preallocated buffers per size class (4KiB, 64KiB, 1MiB) that serve unpooled buffers. 0 disables the size classes.",
+           {std::make_shared<NumberValidation>()}};
+
     /// Indicates how many buffers a single data source can allocate. This property controls the backpressure mechanism as a data source that can't allocate new records can't ingest more data.
     UIntOption defaultMaxInflightBuffers
         = {"default_max_inflight_buffers",
@@ -54,6 +99,28 @@ public:
            "SourceDescriptor).",
            {std::make_shared<NumberValidation>()}};
 
+    /// Adapts the inflight buffer limit of each source between 1 and its maximum to how fast the query releases the buffers of the source.
+    BoolOption adaptiveInflightBuffers
+        = {"adaptive_inflight_buffers",
+           "false",
+           "Shrink the inflight buffer limit of a source while its buffers queue up downstream and grow it back up to its maximum."};
+
+    /// Number of threads that drive all sources that support non-blocking fills, e.g., the GeneratorSource. Allows hosting many low-rate
+    /// sources without one thread per source. Sources without non-blocking fills keep their own thread.
+    UIntOption numberOfMultiplexedSourceThreads
+        = {"number_of_multiplexed_source_threads",
+           "0",
+           "Number of threads shared by all sources that support non-blocking fills. 0 gives every source its own thread.",
+           {std::make_shared<NumberValidation>()}};
+
+    /// Keeping the threads that ingest data off the cpus of the worker threads prevents them from evicting the caches of the workers
+    StringOption sourceThreadCpus
+        = {"source_thread_cpus",
+           "",
+           "Cpus (e.g. 4-5) that all source threads share. Should not overlap with the worker thread cpus of the query engine. Empty "
+           "leaves the placement to the OS.",
+           {std::make_shared<CpuListValidation>()}};
+
     EnumOption<DumpMode::Options> dumpQueryCompilationIR
         = {"dump_compilation_result",
            DumpMode::Options::NONE,
@@ -69,7 +136,17 @@ private:
             &defaultQueryExecution,
             &defaultQueryOptimization,
             &numberOfBuffersInGlobalBufferManager,
+            &numaAwareBufferManager,
+            &hugePages,
+            &prefaultBufferPool,
+            &lockBufferPool,
+            &trackBufferOwnership,
+            &threadLocalBufferCacheSize,
+            &numberOfBuffersPerSizeClass,
             &defaultMaxInflightBuffers,
+            &adaptiveInflightBuffers,
+            &numberOfMultiplexedSourceThreads,
+            &sourceThreadCpus,
             &dumpQueryCompilationIR,
             &dumpGraph};
     }
@@ -18,9 +18,12 @@
 #include <utility>
 #include <vector>
 #include <Identifiers/Identifiers.hpp>
+#include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/BufferManager.hpp>
 #include <Sources/SourceHandle.hpp>
 #include <Sources/SourceProvider.hpp>
 #include <Util/Logger/Formatter.hpp>
+#include <BackpressureChannel.hpp>
 #include <CompiledQueryPlan.hpp>
 
 namespace NES
@@ -31,14 +34,26 @@ namespace NES
 struct ExecutableQueryPlan
 {
     using SourceWithSuccessor = std::pair<std::unique_ptr<SourceHandle>, std::vector<std::weak_ptr<ExecutablePipeline>>>;
-    static std::unique_ptr<ExecutableQueryPlan> instantiate(CompiledQueryPlan& compiledQueryPlan, const SourceProvider& sourceProvider);
+    /// If the compiled query plan has a memory quota, all buffers of the query are requested via a QueryBufferProvider from the
+    /// bufferManager. The sources of the query are throttled via backpressure, while the query exceeds its quota.
+    static std::unique_ptr<ExecutableQueryPlan> instantiate(
+        CompiledQueryPlan& compiledQueryPlan, const SourceProvider& sourceProvider, const std::shared_ptr<BufferManager>& bufferManager);
 
     ExecutableQueryPlan(
-        QueryId queryId, std::vector<std::shared_ptr<ExecutablePipeline>> pipelines, std::vector<SourceWithSuccessor> instantiatedSources);
+        QueryId queryId,
+        std::vector<std::shared_ptr<ExecutablePipeline>> pipelines,
+        std::vector<SourceWithSuccessor> instantiatedSources,
+        std::shared_ptr<AbstractBufferProvider> bufferProvider = nullptr);
 
     QueryId queryId;
     std::vector<std::shared_ptr<ExecutablePipeline>> pipelines;
     std::vector<SourceWithSuccessor> sources;
+    /// Provides the buffers of all pipelines of the query. If not set, the pipelines use the global BufferManager.
+    std::shared_ptr<AbstractBufferProvider> bufferProvider;
+    QueryPriority priority = QueryPriority::Normal;
+    /// Holds back the sources until all pipelines are started, which allows opening the sources while the pipelines start.
+    /// If not set, the sources are only started once all pipelines are started.
+    std::shared_ptr<BackpressureController> readinessGate;
     friend std::ostream& operator<<(std::ostream& os, const ExecutableQueryPlan& executableQueryPlan);
 };
 }
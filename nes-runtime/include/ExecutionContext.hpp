@@ -113,6 +113,12 @@ struct ExecutionContext final
     nautilus::val<SequenceNumber> sequenceNumber; /// Stores the sequence number id of the incoming tuple buffer. This is set in the scan.
     nautilus::val<ChunkNumber> chunkNumber; /// Stores the chunk number of the incoming tuple buffer. This is set in the scan.
     nautilus::val<bool> lastChunk;
+    /// Stores the range of the ingestion timestamps of the incoming tuple buffer. This is set in the scan.
+    nautilus::val<Timestamp> minIngestionTs;
+    nautilus::val<Timestamp> maxIngestionTs;
+    /// Set while tiered execution interprets the pipeline ahead of its compilation. Operators may record profiles of the data in the
+    /// meantime and specialize the code that is traced for the compilation on them.
+    bool recordProfiles = false;
 
 private:
     std::unordered_map<OperatorId, std::unique_ptr<OperatorState>> localStateMap;
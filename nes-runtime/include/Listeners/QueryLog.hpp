@@ -15,6 +15,10 @@
 #pragma once
 
 #include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <ostream>
 #include <unordered_map>
@@ -61,6 +65,34 @@ struct QueryStateChange
 
 inline std::ostream& operator<<(std::ostream& os, const QueryStateChange& statusChange);
 
+struct QueryStatusEvent
+{
+    QueryId queryId;
+    QueryStateChange change;
+};
+
+/// Receives the status changes of all queries, starting with the changes that the query log contained when it subscribed.
+/// The query log stops delivering to a dropped subscription.
+class QueryLogSubscription
+{
+public:
+    explicit QueryLogSubscription(size_t maxQueuedEvents) : maxQueuedEvents(maxQueuedEvents) { }
+
+    /// Returns the queued events, or an empty vector if no event arrived within the timeout.
+    /// Returns std::nullopt once the subscriber fell more than maxQueuedEvents behind and missed events.
+    std::optional<std::vector<QueryStatusEvent>> pop(std::chrono::milliseconds timeout);
+
+private:
+    friend struct QueryLog;
+    void push(QueryStatusEvent event, bool isSnapshot);
+
+    std::mutex mutex;
+    std::condition_variable eventsAvailable;
+    std::vector<QueryStatusEvent> events;
+    size_t maxQueuedEvents;
+    bool missedEvents = false;
+};
+
 /// The query log keeps track of query status changes. We want to keep it as lightweight as possible to reduce overhead inflicted to
 /// the query manager.
 struct QueryLog : AbstractQueryStatusListener
@@ -79,7 +111,14 @@ struct QueryLog : AbstractQueryStatusListener
 
     [[nodiscard]] std::vector<LocalQueryStatus> getStatus() const;
 
+    /// Pushes the status changes to the subscriber as they happen, so that it does not have to poll the query log
+    [[nodiscard]] std::shared_ptr<QueryLogSubscription> subscribe(size_t maxQueuedEvents);
+
 private:
+    void notifySubscriptions(QueryId queryId, const QueryStateChange& statusChange);
+
     folly::Synchronized<QueryStatusLog> queryStatusLog;
+    /// Only locked while holding the lock of the queryStatusLog, so that a subscription neither misses nor duplicates a change
+    folly::Synchronized<std::vector<std::weak_ptr<QueryLogSubscription>>> subscriptions;
 };
 }
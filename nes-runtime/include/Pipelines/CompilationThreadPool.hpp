@@ -0,0 +1,58 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <stop_token>
+#include <vector>
+#include <Thread.hpp>
+
+namespace NES
+{
+
+/// Dedicated threads that compile pipelines in the background, e.g., while the pipelines are executed by the interpreter.
+/// Compiling on dedicated threads keeps the long running compilations away from the worker threads of the query engine.
+/// Destroying the pool discards all pending compilations and waits for the running compilations.
+class CompilationThreadPool
+{
+public:
+    explicit CompilationThreadPool(size_t numberOfThreads, size_t maxNumberOfPendingCompilations = std::numeric_limits<size_t>::max());
+    ~CompilationThreadPool();
+
+    CompilationThreadPool(const CompilationThreadPool&) = delete;
+    CompilationThreadPool(CompilationThreadPool&&) = delete;
+    CompilationThreadPool& operator=(const CompilationThreadPool&) = delete;
+    CompilationThreadPool& operator=(CompilationThreadPool&&) = delete;
+
+    /// Compilations are started in the order in which they are submitted.
+    /// Returns false and drops the compilation, if maxNumberOfPendingCompilations compilations are already waiting for a thread.
+    [[nodiscard]] bool submit(std::function<void()> compilation);
+
+private:
+    void runCompilations(const std::stop_token& stopToken);
+
+    size_t maxNumberOfPendingCompilations;
+    std::mutex mutex;
+    std::condition_variable_any compilationAvailable;
+    std::deque<std::function<void()>> pendingCompilations;
+    std::vector<Thread> threads;
+};
+
+}
@@ -13,29 +13,87 @@
 */
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 #include <Runtime/Execution/OperatorHandler.hpp>
 #include <Runtime/TupleBuffer.hpp>
 #include <nautilus/Engine.hpp>
+#include <Pipelines/CompilationThreadPool.hpp>
+#include <Pipelines/PerfMapSymbol.hpp>
+#include <Arena.hpp>
 #include <ExecutablePipelineStage.hpp>
 #include <ExecutionContext.hpp>
+#include <PhysicalOperator.hpp>
 #include <Pipeline.hpp>
 
 namespace NES
 {
 class DumpHelper;
 
+/// The compiled code of a traced pipeline. The code accesses operator handlers only via their ids. Thus, it can be shared by the stages
+/// of all pipelines that are identical to the traced pipeline except for the ids of their operator handlers.
+struct CompiledPipelineFunction
+{
+    /// The compiled code embeds pointers to the traced operators and is owned by the engine. Thus, both have to outlive the function.
+    std::shared_ptr<nautilus::engine::NautilusEngine> engine;
+    PhysicalOperator tracedRootOperator;
+    /// Ids of the operator handlers of the traced pipeline in ascending order
+    std::vector<OperatorHandlerId> operatorHandlerIds;
+    /// The compiled code embeds a pointer to its symbol, if it registers itself in the perf map
+    std::shared_ptr<PerfMapSymbol> perfMapSymbol;
+    nautilus::engine::CallableFunction<void, PipelineExecutionContext*, const TupleBuffer*, const Arena*> function;
+};
+
+/// Holds the compiled code that is shared by the stages of identical pipelines, e.g., of queries that are submitted repeatedly.
+/// The first stage that starts compiles its pipeline, all later stages reuse the compiled code and skip tracing and compilation.
+class CompiledPipelineSlot
+{
+public:
+    /// Concurrent callers wait until the first caller compiled the pipeline. If the compilation fails, the next caller compiles again.
+    std::shared_ptr<CompiledPipelineFunction> getOrCompile(const std::function<std::shared_ptr<CompiledPipelineFunction>()>& compile);
+
+    /// Returns the compiled code without waiting. Returns nullptr, if the pipeline was not compiled yet or is currently compiled.
+    std::shared_ptr<CompiledPipelineFunction> tryGet();
+
+private:
+    std::mutex mutex;
+    std::shared_ptr<CompiledPipelineFunction> compiledPipeline;
+};
+
 /// A compiled executable pipeline stage uses nautilus-lib to compile a pipeline to a code snippet.
+/// With tiered execution, the stage starts to execute the pipeline with the interpreter right away and compiles the pipeline on the
+/// compilation thread pool. Once the compiled code is available, the stage swaps it in between two tasks. Both functions work on the same
+/// operator handlers, thus, the swap does not lose any operator state.
 class CompiledExecutablePipelineStage final : public ExecutablePipelineStage
 {
 public:
+    /// If a compiledPipelineSlot is given, the stage shares its compiled code with all other stages of the same slot.
+    /// If a compilationThreadPool is given, the stage uses tiered execution. Then, the stage interprets numberOfProfiledBuffers buffers
+    /// while the operators record profiles, before it compiles the pipeline.
+    /// If a perfMapSymbol is given, the compiled code registers itself under its name in the perf map of the process.
     CompiledExecutablePipelineStage(
         std::shared_ptr<Pipeline> pipeline,
         std::unordered_map<OperatorHandlerId, std::shared_ptr<OperatorHandler>> operatorHandler,
-        nautilus::engine::Options options);
+        nautilus::engine::Options options,
+        std::shared_ptr<CompiledPipelineSlot> compiledPipelineSlot = nullptr,
+        std::shared_ptr<CompilationThreadPool> compilationThreadPool = nullptr,
+        uint64_t numberOfProfiledBuffers = 0,
+        std::shared_ptr<PerfMapSymbol> perfMapSymbol = nullptr);
+
+    /// Compiles the pipeline ahead of start, e.g., to compile the pipelines of a query in parallel while it is registered.
+    /// Tracing does not depend on the setup of the operators. Not supported for tiered execution, which compiles on start.
+    void compile();
+
     void start(PipelineExecutionContext& pipelineExecutionContext) override;
     void execute(const TupleBuffer& inputTupleBuffer, PipelineExecutionContext& pipelineExecutionContext) override;
     void stop(PipelineExecutionContext& pipelineExecutionContext) override;
@@ -44,12 +102,63 @@ protected:
     std::ostream& toString(std::ostream& os) const override;
 
 private:
-    [[nodiscard]] nautilus::engine::CallableFunction<void, PipelineExecutionContext*, const TupleBuffer*, const Arena*>
-    compilePipeline() const;
-    nautilus::engine::NautilusEngine engine;
-    nautilus::engine::CallableFunction<void, PipelineExecutionContext*, const TupleBuffer*, const Arena*> compiledPipelineFunction;
+    /// The code of a pipeline together with our operator handlers under the ids of the traced pipeline, which the code uses to access them
+    struct BoundPipelineFunction
+    {
+        std::shared_ptr<CompiledPipelineFunction> compiledPipeline;
+        std::unordered_map<OperatorHandlerId, std::shared_ptr<OperatorHandler>> tracedOperatorHandlers;
+    };
+
+    /// The background compilation may finish after the stage was destroyed. Thus, the stage shares the functions with the compilation.
+    struct PipelineFunctions
+    {
+        std::shared_ptr<BoundPipelineFunction> interpretedPipeline;
+        std::shared_ptr<BoundPipelineFunction> compiledPipeline;
+        /// Every task loads the active function once. Thus, we swap from the interpreted to the compiled function between two tasks.
+        std::atomic<BoundPipelineFunction*> activePipeline = nullptr;
+        std::atomic<bool> stopped = false;
+        /// Drops below zero once the last profiled buffer was interpreted
+        std::atomic<int64_t> remainingProfiledBuffers = 0;
+    };
+
+    /// The tasks of a worker thread reuse the arena of its slot, which keeps its buffers across tasks. Worker thread ids are consecutive,
+    /// so that the threads of a small pool use different slots. A task that finds the slot of its thread in use gets a fresh arena.
+    static constexpr size_t NUMBER_OF_ARENA_SLOTS = 16;
+    /// The arenas of all slots retain at most this many pooled buffers between tasks. Thus, a pipeline only keeps a few buffers of the
+    /// query, even if many worker threads execute it.
+    static constexpr size_t MAX_NUMBER_OF_RETAINED_BUFFERS = 8;
+
+    struct alignas(std::hardware_destructive_interference_size) ArenaSlot
+    {
+        std::mutex mutex;
+        std::optional<Arena> arena;
+        /// The number of buffers the arena keeps between tasks, which counts towards numberOfRetainedBuffers
+        size_t numberOfRetainedBuffers = 0;
+    };
+
+    /// Returns how many buffers the arena of the slot may keep after its task. Requires the lock of the slot.
+    [[nodiscard]] size_t reserveRetainedBuffers(ArenaSlot& arenaSlot);
+
+    void startTieredExecution();
+    /// Compiles the pipeline in the background and swaps in the compiled code once it is available
+    void submitCompilation();
+    [[nodiscard]] std::shared_ptr<CompiledPipelineFunction> compileOrReuse() const;
+
+    std::shared_ptr<nautilus::engine::NautilusEngine> engine;
+    /// Only set for tiered execution
+    std::shared_ptr<nautilus::engine::NautilusEngine> interpreterEngine;
+    std::shared_ptr<CompiledPipelineSlot> compiledPipelineSlot;
+    std::shared_ptr<CompilationThreadPool> compilationThreadPool;
+    uint64_t numberOfProfiledBuffers;
+    std::shared_ptr<PerfMapSymbol> perfMapSymbol;
+    std::shared_ptr<PipelineFunctions> pipelineFunctions;
+    /// Set by compile() and consumed by start()
+    std::shared_ptr<CompiledPipelineFunction> precompiledPipeline;
     std::unordered_map<OperatorHandlerId, std::shared_ptr<OperatorHandler>> operatorHandlers;
     std::shared_ptr<Pipeline> pipeline;
+    std::array<ArenaSlot, NUMBER_OF_ARENA_SLOTS> arenaSlots;
+    /// Sum of the retained buffers of all arena slots
+    std::atomic<size_t> numberOfRetainedBuffers = 0;
 };
 
 }
@@ -0,0 +1,40 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <string>
+
+namespace NES
+{
+
+/// Names the JIT-compiled code of a pipeline in /tmp/perf-<pid>.map, from which perf resolves the samples in anonymous memory.
+/// Nautilus does not expose the address of the compiled code. Thus, the compiled code registers itself on its first call with the
+/// address from which it calls into the runtime. The symbol covers the executable mapping that contains this address.
+class PerfMapSymbol
+{
+public:
+    explicit PerfMapSymbol(std::string name);
+
+    /// Only the first call registers the symbol. Addresses in file-backed mappings are skipped, as perf resolves them by itself.
+    /// Every task of the compiled code calls it, thus, the registered symbol only costs a load.
+    void registerCode(const void* codeAddress);
+
+private:
+    std::string name;
+    std::atomic_flag registered;
+};
+
+}
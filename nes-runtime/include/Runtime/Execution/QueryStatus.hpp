@@ -27,6 +27,8 @@ enum class QueryState : uint8_t
     Running, /// Deployed->Running when calling start()
     Stopped, /// Running->Stopped when calling stop() and in Running state
     Failed,
+    /// Registered asynchronously, i.e., the query is optimized and compiled in the background. Moves to Registered once compiled.
+    Compiling,
 };
 
 inline std::ostream& operator<<(std::ostream& ostream, const QueryState& status)
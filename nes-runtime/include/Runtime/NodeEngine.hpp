@@ -13,6 +13,7 @@
 */
 
 #pragma once
+#include <cstddef>
 #include <memory>
 #include <Identifiers/Identifiers.hpp>
 #include <Listeners/QueryLog.hpp>
@@ -61,6 +62,10 @@ public:
 
     [[nodiscard]] std::shared_ptr<const QueryLog> getQueryLog() const { return queryLog; }
 
+    [[nodiscard]] QueryEngineStatistics getQueryEngineStatistics() const { return queryEngine->getStatistics(); }
+
+    void setWorkerThreadLimits(const size_t minimum, const size_t maximum) { queryEngine->setWorkerThreadLimits(minimum, maximum); }
+
 private:
     std::shared_ptr<BufferManager> bufferManager;
     std::shared_ptr<QueryLog> queryLog;
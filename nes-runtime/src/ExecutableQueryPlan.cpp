@@ -26,9 +26,12 @@
 #include <vector>
 #include <Identifiers/Identifiers.hpp>
 #include <Runtime/AbstractBufferProvider.hpp>
+#include <Runtime/BufferManager.hpp>
+#include <Runtime/QueryBufferProvider.hpp>
 #include <Sinks/SinkProvider.hpp>
 #include <Sources/SourceHandle.hpp>
 #include <Sources/SourceProvider.hpp>
+#include <Util/Logger/Logger.hpp>
 #include <Util/Overloaded.hpp>
 #include <BackpressureChannel.hpp>
 #include <CompiledQueryPlan.hpp>
@@ -62,8 +65,8 @@ std::ostream& operator<<(std::ostream& os, const ExecutableQueryPlan& instantiat
     return os;
 }
 
-std::unique_ptr<ExecutableQueryPlan>
-ExecutableQueryPlan::instantiate(CompiledQueryPlan& compiledQueryPlan, const SourceProvider& sourceProvider)
+std::unique_ptr<ExecutableQueryPlan> ExecutableQueryPlan::instantiate(
+    CompiledQueryPlan& compiledQueryPlan, const SourceProvider& sourceProvider, const std::shared_ptr<BufferManager>& bufferManager)
 {
     std::vector<SourceWithSuccessor> instantiatedSources;
 
@@ -71,6 +74,36 @@ ExecutableQueryPlan::instantiate(CompiledQueryPlan& compiledQueryPlan, const Sou
 
     auto [backpressureController, backpressureListener] = createBackpressureChannel();
 
+    /// The sources open while the pipelines start, but the readiness gate holds back their data until all pipelines are started
+    auto [readinessController, readinessListener] = createBackpressureChannel();
+    readinessController.applyPressure();
+    backpressureListener = backpressureListener.combine(readinessListener);
+
+    /// The memory quota throttles the sources via a dedicated backpressure channel, thus it does not interfere with the sink
+    std::shared_ptr<QueryBufferProvider> queryBufferProvider;
+    if (compiledQueryPlan.memoryQuotaInBytes > 0)
+    {
+        auto [quotaController, quotaListener] = createBackpressureChannel();
+        backpressureListener = backpressureListener.combine(quotaListener);
+        queryBufferProvider = QueryBufferProvider::create(
+            bufferManager,
+            compiledQueryPlan.memoryQuotaInBytes,
+            [queryId = compiledQueryPlan.queryId,
+             quotaController = std::make_shared<BackpressureController>(std::move(quotaController))](const bool quotaExceeded)
+            {
+                if (quotaExceeded)
+                {
+                    NES_DEBUG("Query {} exceeded its memory quota, throttling its sources", queryId);
+                    quotaController->applyPressure();
+                }
+                else
+                {
+                    NES_DEBUG("Query {} is back within its memory quota", queryId);
+                    quotaController->releasePressure();
+                }
+            });
+    }
+
     if (compiledQueryPlan.sinks.size() != 1)
     {
         throw NotImplemented("Currently our execution model expects exactly one sink per query plan");
@@ -91,19 +124,28 @@ ExecutableQueryPlan::instantiate(CompiledQueryPlan& compiledQueryPlan, const Sou
     }
 
 
-    for (auto [originId, operatorId, descriptor, successors] : compiledQueryPlan.sources)
+    for (auto [originId, operatorId, descriptor, successors, projections] : compiledQueryPlan.sources)
     {
         std::ranges::copy(instantiatedSinksWithSourcePredecessor[operatorId], std::back_inserter(successors));
-        instantiatedSources.emplace_back(sourceProvider.lower(originId, backpressureListener, descriptor), std::move(successors));
+        instantiatedSources.emplace_back(
+            sourceProvider.lower(originId, backpressureListener, descriptor, queryBufferProvider, std::move(projections)),
+            std::move(successors));
     }
 
 
-    return std::make_unique<ExecutableQueryPlan>(compiledQueryPlan.queryId, compiledQueryPlan.pipelines, std::move(instantiatedSources));
+    auto executableQueryPlan = std::make_unique<ExecutableQueryPlan>(
+        compiledQueryPlan.queryId, compiledQueryPlan.pipelines, std::move(instantiatedSources), std::move(queryBufferProvider));
+    executableQueryPlan->priority = compiledQueryPlan.priority;
+    executableQueryPlan->readinessGate = std::make_shared<BackpressureController>(std::move(readinessController));
+    return executableQueryPlan;
 }
 
 ExecutableQueryPlan::ExecutableQueryPlan(
-    QueryId queryId, std::vector<std::shared_ptr<ExecutablePipeline>> pipelines, std::vector<SourceWithSuccessor> instantiatedSources)
-    : queryId(queryId), pipelines(std::move(pipelines)), sources(std::move(instantiatedSources))
+    QueryId queryId,
+    std::vector<std::shared_ptr<ExecutablePipeline>> pipelines,
+    std::vector<SourceWithSuccessor> instantiatedSources,
+    std::shared_ptr<AbstractBufferProvider> bufferProvider)
+    : queryId(queryId), pipelines(std::move(pipelines)), sources(std::move(instantiatedSources)), bufferProvider(std::move(bufferProvider))
 {
 }
 }
@@ -62,6 +62,8 @@ ExecutionContext::ExecutionContext(const nautilus::val<PipelineExecutionContext*
     , sequenceNumber(INVALID<SequenceNumber>)
     , chunkNumber(INVALID<ChunkNumber>)
     , lastChunk(true)
+    , minIngestionTs(0_u64)
+    , maxIngestionTs(0_u64)
 {
 }
 
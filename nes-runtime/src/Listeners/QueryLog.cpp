@@ -15,6 +15,9 @@
 #include <Listeners/QueryLog.hpp>
 
 #include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <ostream>
 #include <ranges>
@@ -47,6 +50,70 @@ inline std::ostream& operator<<(std::ostream& os, const QueryStateChange& status
     return os;
 }
 
+std::optional<std::vector<QueryStatusEvent>> QueryLogSubscription::pop(const std::chrono::milliseconds timeout)
+{
+    std::unique_lock lock(mutex);
+    eventsAvailable.wait_for(lock, timeout, [this] { return not events.empty() or missedEvents; });
+    if (missedEvents)
+    {
+        return std::nullopt;
+    }
+    return std::exchange(events, {});
+}
+
+void QueryLogSubscription::push(QueryStatusEvent event, const bool isSnapshot)
+{
+    {
+        const std::scoped_lock lock(mutex);
+        if (missedEvents)
+        {
+            return;
+        }
+        /// The snapshot of the query log does not count against the limit, as the subscriber cannot have fallen behind yet
+        if (not isSnapshot and events.size() >= maxQueuedEvents)
+        {
+            missedEvents = true;
+            events.clear();
+        }
+        else
+        {
+            events.emplace_back(std::move(event));
+        }
+    }
+    eventsAvailable.notify_one();
+}
+
+void QueryLog::notifySubscriptions(const QueryId queryId, const QueryStateChange& statusChange)
+{
+    const auto lockedSubscriptions = subscriptions.wlock();
+    std::erase_if(
+        *lockedSubscriptions,
+        [&](const auto& weakSubscription)
+        {
+            if (const auto subscription = weakSubscription.lock())
+            {
+                subscription->push({.queryId = queryId, .change = statusChange}, false);
+                return false;
+            }
+            return true;
+        });
+}
+
+std::shared_ptr<QueryLogSubscription> QueryLog::subscribe(const size_t maxQueuedEvents)
+{
+    auto subscription = std::make_shared<QueryLogSubscription>(maxQueuedEvents);
+    const auto log = queryStatusLog.rlock();
+    for (const auto& [queryId, changes] : *log)
+    {
+        for (const auto& change : changes)
+        {
+            subscription->push({.queryId = queryId, .change = change}, true);
+        }
+    }
+    subscriptions.wlock()->emplace_back(subscription);
+    return subscription;
+}
+
 bool QueryLog::logSourceTermination(QueryId, OriginId, QueryTerminationType, std::chrono::system_clock::time_point)
 {
     /// TODO #34: part of redesign of single node worker
@@ -62,6 +129,7 @@ bool QueryLog::logQueryFailure(const QueryId queryId, const Exception exception,
         auto& changes = (*log)[queryId];
         const auto pos = std::ranges::upper_bound(
             changes, statusChange, [](const QueryStateChange& lhs, const QueryStateChange& rhs) { return lhs.timestamp < rhs.timestamp; });
+        notifySubscriptions(queryId, statusChange);
         changes.emplace(pos, std::move(statusChange));
         return true;
     }
@@ -76,6 +144,7 @@ bool QueryLog::logQueryStatusChange(const QueryId queryId, QueryState status, co
     auto& changes = (*log)[queryId];
     const auto pos = std::ranges::upper_bound(
         changes, statusChange, [](const QueryStateChange& lhs, const QueryStateChange& rhs) { return lhs.timestamp < rhs.timestamp; });
+    notifySubscriptions(queryId, statusChange);
     changes.emplace(pos, std::move(statusChange));
     return true;
 }
@@ -98,9 +167,10 @@ std::optional<LocalQueryStatus> getQueryStatusImpl(const auto& log, QueryId quer
     {
         /// Unfortunately the multithreaded nature of the query engine cannot guarantee event ordering.
         /// We handle out-of-order events by keeping the most recent timestamp for each event type.
-        /// Final state is determined by priority: Failed > Stopped > Running > Started > Registered.
+        /// Final state is determined by priority: Failed > Stopped > Running > Started > Registered > Compiling.
         LocalQueryStatus status;
         status.queryId = queryId;
+        bool registered = false;
 
         for (const auto& statusChange : queryLog->second)
         {
@@ -120,12 +190,15 @@ std::optional<LocalQueryStatus> getQueryStatusImpl(const auto& log, QueryId quer
                     status.metrics.running = statusChange.timestamp;
                     break;
                 case QueryState::Registered:
+                    registered = true;
+                    break;
+                case QueryState::Compiling:
                     break;
             }
         }
 
         /// Determine state based on available metrics and timestamps
-        auto state = QueryState::Registered;
+        auto state = registered ? QueryState::Registered : QueryState::Compiling;
         if (status.metrics.error.has_value())
         {
             state = QueryState::Failed;
@@ -0,0 +1,89 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Pipelines/CompilationThreadPool.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <utility>
+#include <fmt/format.h>
+#include <ErrorHandling.hpp>
+#include <Thread.hpp>
+
+namespace NES
+{
+
+CompilationThreadPool::CompilationThreadPool(const size_t numberOfThreads, const size_t maxNumberOfPendingCompilations)
+    : maxNumberOfPendingCompilations(maxNumberOfPendingCompilations)
+{
+    PRECONDITION(numberOfThreads > 0, "The compilation thread pool requires at least one thread");
+    threads.reserve(numberOfThreads);
+    for (size_t threadIndex = 0; threadIndex < numberOfThreads; ++threadIndex)
+    {
+        threads.emplace_back(
+            fmt::format("Compiler-{}", threadIndex), [this](const std::stop_token& stopToken) { runCompilations(stopToken); });
+    }
+}
+
+CompilationThreadPool::~CompilationThreadPool()
+{
+    for (auto& thread : threads)
+    {
+        thread.requestStop();
+    }
+    threads.clear();
+}
+
+bool CompilationThreadPool::submit(std::function<void()> compilation)
+{
+    {
+        const std::scoped_lock lock(mutex);
+        if (pendingCompilations.size() >= maxNumberOfPendingCompilations)
+        {
+            return false;
+        }
+        pendingCompilations.emplace_back(std::move(compilation));
+    }
+    compilationAvailable.notify_one();
+    return true;
+}
+
+void CompilationThreadPool::runCompilations(const std::stop_token& stopToken)
+{
+    while (not stopToken.stop_requested())
+    {
+        std::function<void()> compilation;
+        {
+            std::unique_lock lock(mutex);
+            if (not compilationAvailable.wait(lock, stopToken, [this] { return not pendingCompilations.empty(); }))
+            {
+                return;
+            }
+            compilation = std::move(pendingCompilations.front());
+            pendingCompilations.pop_front();
+        }
+        try
+        {
+            compilation();
+        }
+        catch (...)
+        {
+            tryLogCurrentException();
+        }
+    }
+}
+
+}
@@ -11,72 +11,116 @@
     See the License for the specific language governing permissions and
     limitations under the License.
 */
+
 #include <Pipelines/CompiledExecutablePipelineStage.hpp>
 
+#include <algorithm>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <ostream>
+#include <ranges>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 #include <Nautilus/Interface/RecordBuffer.hpp>
+#include <Pipelines/CompilationThreadPool.hpp>
+#include <Pipelines/PerfMapSymbol.hpp>
 #include <Runtime/Execution/OperatorHandler.hpp>
 #include <Runtime/TupleBuffer.hpp>
+#include <Util/Logger/Logger.hpp>
 #include <cpptrace/from_current.hpp>
 #include <fmt/format.h>
 #include <nautilus/val_ptr.hpp>
+#include <Arena.hpp>
 #include <CompilationContext.hpp>
 #include <Engine.hpp>
+#include <ErrorHandling.hpp>
 #include <ExecutionContext.hpp>
 #include <PhysicalOperator.hpp>
 #include <Pipeline.hpp>
 #include <function.hpp>
 #include <options.hpp>
+#include <scope_guard.hpp>
 
 namespace NES
 {
 
-CompiledExecutablePipelineStage::CompiledExecutablePipelineStage(
-    std::shared_ptr<Pipeline> pipeline,
-    std::unordered_map<OperatorHandlerId, std::shared_ptr<OperatorHandler>> operatorHandlers,
-    nautilus::engine::Options options)
-    : engine(std::move(options))
-    , compiledPipelineFunction(nullptr)
-    , operatorHandlers(std::move(operatorHandlers))
-    , pipeline(std::move(pipeline))
+namespace
 {
+std::vector<OperatorHandlerId>
+getSortedOperatorHandlerIds(const std::unordered_map<OperatorHandlerId, std::shared_ptr<OperatorHandler>>& operatorHandlers)
+{
+    auto operatorHandlerIds = operatorHandlers | std::views::keys | std::ranges::to<std::vector>();
+    std::ranges::sort(operatorHandlerIds);
+    return operatorHandlerIds;
 }
 
-void CompiledExecutablePipelineStage::execute(const TupleBuffer& inputTupleBuffer, PipelineExecutionContext& pipelineExecutionContext)
+/// The compiled code accesses the operator handlers via the ids of the traced pipeline. Identical pipelines create their operator
+/// handlers in the same order and handler ids are ascending. Thus, the i-th smallest id of both pipelines refers to the same handler.
+std::unordered_map<OperatorHandlerId, std::shared_ptr<OperatorHandler>> mapToTracedOperatorHandlerIds(
+    const CompiledPipelineFunction& compiledPipeline,
+    const std::unordered_map<OperatorHandlerId, std::shared_ptr<OperatorHandler>>& operatorHandlers,
+    const Pipeline& pipeline)
 {
-    /// we call the compiled pipeline function with an input buffer and the execution context
-    pipelineExecutionContext.setOperatorHandlers(operatorHandlers);
-    Arena arena(pipelineExecutionContext.getBufferManager());
-    compiledPipelineFunction(std::addressof(pipelineExecutionContext), std::addressof(inputTupleBuffer), std::addressof(arena));
+    const auto operatorHandlerIds = getSortedOperatorHandlerIds(operatorHandlers);
+    INVARIANT(
+        operatorHandlerIds.size() == compiledPipeline.operatorHandlerIds.size(),
+        "The compiled code of pipeline {} expects {} operator handlers, but the pipeline has {}",
+        pipeline.getPipelineId(),
+        compiledPipeline.operatorHandlerIds.size(),
+        operatorHandlerIds.size());
+    std::unordered_map<OperatorHandlerId, std::shared_ptr<OperatorHandler>> tracedOperatorHandlers;
+    for (size_t i = 0; i < operatorHandlerIds.size(); ++i)
+    {
+        tracedOperatorHandlers.emplace(compiledPipeline.operatorHandlerIds[i], operatorHandlers.at(operatorHandlerIds[i]));
+    }
+    return tracedOperatorHandlers;
+}
+
+/// Must not be inlined, as the return address has to point into the compiled code that calls the function
+[[gnu::noinline]] void registerPerfMapSymbol(PerfMapSymbol* perfMapSymbol)
+{
+    perfMapSymbol->registerCode(__builtin_return_address(0));
 }
 
-nautilus::engine::CallableFunction<void, PipelineExecutionContext*, const TupleBuffer*, const Arena*>
-CompiledExecutablePipelineStage::compilePipeline() const
+/// Traces the pipeline and registers the traced function at the engine, which either compiles or interprets the function
+std::shared_ptr<CompiledPipelineFunction> compilePipeline(
+    const std::shared_ptr<nautilus::engine::NautilusEngine>& engine,
+    const Pipeline& pipeline,
+    const std::unordered_map<OperatorHandlerId, std::shared_ptr<OperatorHandler>>& operatorHandlers,
+    const std::shared_ptr<PerfMapSymbol>& perfMapSymbol,
+    const bool recordProfiles = false)
 {
     CPPTRACE_TRY
     {
-        /// We must capture the operatorPipeline by value to ensure it is not destroyed before the function is called
+        const auto compilationStart = std::chrono::steady_clock::now();
+        const auto& rootOperator = pipeline.getRootOperator();
+        /// We must capture the root operator by value to ensure it is not destroyed before the function is called
         /// Additionally, we can NOT use const or const references for the parameters of the lambda function
         /// NOLINTBEGIN(performance-unnecessary-value-param)
         const std::function<void(nautilus::val<PipelineExecutionContext*>, nautilus::val<const TupleBuffer*>, nautilus::val<const Arena*>)>
-            compiledFunction = [this](
+            compiledFunction = [rootOperator, recordProfiles, perfMapSymbol = perfMapSymbol.get()](
                                    nautilus::val<PipelineExecutionContext*> pipelineExecutionContext,
                                    nautilus::val<const TupleBuffer*> recordBufferRef,
                                    nautilus::val<const Arena*> arenaRef)
         {
             auto ctx = ExecutionContext(pipelineExecutionContext, arenaRef);
+            ctx.recordProfiles = recordProfiles;
             RecordBuffer recordBuffer(recordBufferRef);
+            if (perfMapSymbol != nullptr)
+            {
+                nautilus::invoke(registerPerfMapSymbol, nautilus::val<PerfMapSymbol*>(perfMapSymbol));
+            }
 
-            pipeline->getRootOperator().open(ctx, recordBuffer);
+            rootOperator.open(ctx, recordBuffer);
             switch (ctx.getOpenReturnState())
             {
                 case OpenReturnState::CONTINUE: {
-                    pipeline->getRootOperator().close(ctx, recordBuffer);
+                    rootOperator.close(ctx, recordBuffer);
                     break;
                 }
                 case OpenReturnState::REPEAT: {
@@ -90,21 +134,137 @@ CompiledExecutablePipelineStage::compilePipeline() const
             }
         };
         /// NOLINTEND(performance-unnecessary-value-param)
-        return engine.registerFunction(compiledFunction);
+        auto function = engine->registerFunction(compiledFunction);
+        /// Together with the task execution times of the pipeline metrics, this shows whether a pipeline pays off its compilation
+        NES_INFO(
+            "Tracing and compiling pipeline {} took {}ms",
+            pipeline.getPipelineId(),
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - compilationStart).count());
+        return std::make_shared<CompiledPipelineFunction>(
+            engine, rootOperator, getSortedOperatorHandlerIds(operatorHandlers), perfMapSymbol, std::move(function));
     }
     CPPTRACE_CATCH(...)
     {
-        throw wrapExternalException(fmt::format("Could not query compile pipeline: {}", *pipeline));
+        throw wrapExternalException(fmt::format("Could not query compile pipeline: {}", pipeline));
     }
     std::unreachable();
 }
+}
+
+std::shared_ptr<CompiledPipelineFunction>
+CompiledPipelineSlot::getOrCompile(const std::function<std::shared_ptr<CompiledPipelineFunction>()>& compile)
+{
+    const std::scoped_lock lock(mutex);
+    if (not compiledPipeline)
+    {
+        compiledPipeline = compile();
+    }
+    return compiledPipeline;
+}
+
+std::shared_ptr<CompiledPipelineFunction> CompiledPipelineSlot::tryGet()
+{
+    const std::unique_lock lock(mutex, std::try_to_lock);
+    if (not lock.owns_lock())
+    {
+        return nullptr;
+    }
+    return compiledPipeline;
+}
+
+CompiledExecutablePipelineStage::CompiledExecutablePipelineStage(
+    std::shared_ptr<Pipeline> pipeline,
+    std::unordered_map<OperatorHandlerId, std::shared_ptr<OperatorHandler>> operatorHandlers,
+    nautilus::engine::Options options,
+    std::shared_ptr<CompiledPipelineSlot> compiledPipelineSlot,
+    std::shared_ptr<CompilationThreadPool> compilationThreadPool,
+    const uint64_t numberOfProfiledBuffers,
+    std::shared_ptr<PerfMapSymbol> perfMapSymbol)
+    : engine(std::make_shared<nautilus::engine::NautilusEngine>(options))
+    , compiledPipelineSlot(std::move(compiledPipelineSlot))
+    , compilationThreadPool(std::move(compilationThreadPool))
+    , numberOfProfiledBuffers(numberOfProfiledBuffers)
+    , perfMapSymbol(std::move(perfMapSymbol))
+    , operatorHandlers(std::move(operatorHandlers))
+    , pipeline(std::move(pipeline))
+{
+    if (this->compilationThreadPool)
+    {
+        options.setOption("engine.Compilation", false);
+        interpreterEngine = std::make_shared<nautilus::engine::NautilusEngine>(std::move(options));
+    }
+}
+
+void CompiledExecutablePipelineStage::execute(const TupleBuffer& inputTupleBuffer, PipelineExecutionContext& pipelineExecutionContext)
+{
+    /// we call the compiled pipeline function with an input buffer and the execution context
+    auto* const activePipeline = pipelineFunctions->activePipeline.load();
+    /// Only the task that interprets the last profiled buffer submits the compilation
+    if (pipelineFunctions->remainingProfiledBuffers.load(std::memory_order_relaxed) > 0
+        and pipelineFunctions->remainingProfiledBuffers.fetch_sub(1, std::memory_order_relaxed) == 1)
+    {
+        submitCompilation();
+    }
+    pipelineExecutionContext.setOperatorHandlers(activePipeline->tracedOperatorHandlers);
+    auto& arenaSlot = arenaSlots[pipelineExecutionContext.getId().getRawValue() % NUMBER_OF_ARENA_SLOTS];
+    if (const std::unique_lock lock(arenaSlot.mutex, std::try_to_lock); lock.owns_lock())
+    {
+        if (not arenaSlot.arena.has_value())
+        {
+            arenaSlot.arena.emplace(pipelineExecutionContext.getBufferManager());
+        }
+        auto& arena = *arenaSlot.arena;
+        SCOPE_EXIT
+        {
+            arena.reset(reserveRetainedBuffers(arenaSlot));
+        };
+        activePipeline->compiledPipeline->function(
+            std::addressof(pipelineExecutionContext), std::addressof(inputTupleBuffer), std::addressof(arena));
+        return;
+    }
+    Arena arena(pipelineExecutionContext.getBufferManager());
+    activePipeline->compiledPipeline->function(
+        std::addressof(pipelineExecutionContext), std::addressof(inputTupleBuffer), std::addressof(arena));
+}
 
 void CompiledExecutablePipelineStage::stop(PipelineExecutionContext& pipelineExecutionContext)
 {
+    /// A pending background compilation is not required anymore
+    if (pipelineFunctions)
+    {
+        pipelineFunctions->stopped = true;
+    }
     pipelineExecutionContext.setOperatorHandlers(operatorHandlers);
     Arena arena(pipelineExecutionContext.getBufferManager());
     ExecutionContext ctx(std::addressof(pipelineExecutionContext), std::addressof(arena));
     pipeline->getRootOperator().terminate(ctx);
+
+    /// No task runs after the stop, thus the arenas return their buffers to the buffer provider
+    for (auto& arenaSlot : arenaSlots)
+    {
+        const std::scoped_lock lock(arenaSlot.mutex);
+        arenaSlot.arena.reset();
+        arenaSlot.numberOfRetainedBuffers = 0;
+    }
+    numberOfRetainedBuffers = 0;
+}
+
+size_t CompiledExecutablePipelineStage::reserveRetainedBuffers(ArenaSlot& arenaSlot)
+{
+    /// The arena never holds fewer buffers than it retained before the task. Thus, the slot only reserves additional buffers. Once the
+    /// slot retains all buffers it wants or all buffers are reserved, its tasks only read the shared counter.
+    const auto wantedBuffers = std::min(arenaSlot.arena->fixedSizeBuffers.size(), Arena::NUMBER_OF_RETAINED_BUFFERS);
+    auto retainedBuffers = numberOfRetainedBuffers.load(std::memory_order_relaxed);
+    while (arenaSlot.numberOfRetainedBuffers < wantedBuffers and retainedBuffers < MAX_NUMBER_OF_RETAINED_BUFFERS)
+    {
+        const auto additionalBuffers
+            = std::min(wantedBuffers - arenaSlot.numberOfRetainedBuffers, MAX_NUMBER_OF_RETAINED_BUFFERS - retainedBuffers);
+        if (numberOfRetainedBuffers.compare_exchange_weak(retainedBuffers, retainedBuffers + additionalBuffers, std::memory_order_relaxed))
+        {
+            arenaSlot.numberOfRetainedBuffers += additionalBuffers;
+        }
+    }
+    return arenaSlot.numberOfRetainedBuffers;
 }
 
 std::ostream& CompiledExecutablePipelineStage::toString(std::ostream& os) const
@@ -112,14 +272,96 @@ std::ostream& CompiledExecutablePipelineStage::toString(std::ostream& os) const
     return os << "CompiledExecutablePipelineStage()";
 }
 
+std::shared_ptr<CompiledPipelineFunction> CompiledExecutablePipelineStage::compileOrReuse() const
+{
+    if (compiledPipelineSlot)
+    {
+        return compiledPipelineSlot->getOrCompile([this] { return compilePipeline(engine, *pipeline, operatorHandlers, perfMapSymbol); });
+    }
+    return compilePipeline(engine, *pipeline, operatorHandlers, perfMapSymbol);
+}
+
+void CompiledExecutablePipelineStage::compile()
+{
+    PRECONDITION(not compilationThreadPool, "Tiered execution compiles pipeline {} in the background on start", pipeline->getPipelineId());
+    precompiledPipeline = compileOrReuse();
+}
+
 void CompiledExecutablePipelineStage::start(PipelineExecutionContext& pipelineExecutionContext)
 {
     pipelineExecutionContext.setOperatorHandlers(operatorHandlers);
     Arena arena(pipelineExecutionContext.getBufferManager());
     ExecutionContext ctx(std::addressof(pipelineExecutionContext), std::addressof(arena));
-    CompilationContext compilationCtx{engine};
+    CompilationContext compilationCtx{*engine};
     pipeline->getRootOperator().setup(ctx, compilationCtx);
-    compiledPipelineFunction = this->compilePipeline();
+
+    pipelineFunctions = std::make_shared<PipelineFunctions>();
+    if (compilationThreadPool)
+    {
+        startTieredExecution();
+        return;
+    }
+    auto compiledPipeline = precompiledPipeline ? std::move(precompiledPipeline) : compileOrReuse();
+    auto tracedOperatorHandlers = mapToTracedOperatorHandlerIds(*compiledPipeline, operatorHandlers, *pipeline);
+    pipelineFunctions->compiledPipeline
+        = std::make_shared<BoundPipelineFunction>(std::move(compiledPipeline), std::move(tracedOperatorHandlers));
+    pipelineFunctions->activePipeline = pipelineFunctions->compiledPipeline.get();
+}
+
+void CompiledExecutablePipelineStage::startTieredExecution()
+{
+    /// An identical pipeline was compiled before, thus, we skip the interpreter
+    if (auto compiledPipeline = compiledPipelineSlot ? compiledPipelineSlot->tryGet() : nullptr)
+    {
+        auto tracedOperatorHandlers = mapToTracedOperatorHandlerIds(*compiledPipeline, operatorHandlers, *pipeline);
+        pipelineFunctions->compiledPipeline
+            = std::make_shared<BoundPipelineFunction>(std::move(compiledPipeline), std::move(tracedOperatorHandlers));
+        pipelineFunctions->activePipeline = pipelineFunctions->compiledPipeline.get();
+        return;
+    }
+
+    /// Tracing the pipeline for the interpreter is cheap compared to compiling it
+    pipelineFunctions->interpretedPipeline = std::make_shared<BoundPipelineFunction>(
+        compilePipeline(interpreterEngine, *pipeline, operatorHandlers, nullptr, numberOfProfiledBuffers > 0), operatorHandlers);
+    pipelineFunctions->activePipeline = pipelineFunctions->interpretedPipeline.get();
+
+    if (numberOfProfiledBuffers > 0)
+    {
+        pipelineFunctions->remainingProfiledBuffers = static_cast<int64_t>(numberOfProfiledBuffers);
+        return;
+    }
+    submitCompilation();
+}
+
+void CompiledExecutablePipelineStage::submitCompilation()
+{
+    /// The compilation must not access the stage, as the stage may be destroyed before the compilation finished.
+    /// If the compilation fails, the stage keeps on using the interpreter.
+    const auto submitted = compilationThreadPool->submit(
+        [functions = pipelineFunctions,
+         engine = engine,
+         pipeline = pipeline,
+         operatorHandlers = operatorHandlers,
+         slot = compiledPipelineSlot,
+         perfMapSymbol = perfMapSymbol]
+        {
+            if (functions->stopped)
+            {
+                return;
+            }
+            auto compiledPipeline = slot
+                ? slot->getOrCompile([&] { return compilePipeline(engine, *pipeline, operatorHandlers, perfMapSymbol); })
+                : compilePipeline(engine, *pipeline, operatorHandlers, perfMapSymbol);
+            auto tracedOperatorHandlers = mapToTracedOperatorHandlerIds(*compiledPipeline, operatorHandlers, *pipeline);
+            functions->compiledPipeline
+                = std::make_shared<BoundPipelineFunction>(std::move(compiledPipeline), std::move(tracedOperatorHandlers));
+            functions->activePipeline = functions->compiledPipeline.get();
+            NES_DEBUG("Swapped in the compiled code of pipeline {}", pipeline->getPipelineId());
+        });
+    if (not submitted)
+    {
+        NES_WARNING("Too many pending compilations, pipeline {} is interpreted until it is stopped", pipeline->getPipelineId());
+    }
 }
 
 }
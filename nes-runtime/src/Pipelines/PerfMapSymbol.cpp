@@ -0,0 +1,105 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Pipelines/PerfMapSymbol.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <unistd.h>
+#include <Util/Logger/Logger.hpp>
+#include <fmt/format.h>
+
+namespace NES
+{
+
+namespace
+{
+struct Mapping
+{
+    uintptr_t start;
+    uintptr_t end;
+};
+
+/// Finds the anonymous mapping that contains the address in /proc/self/maps, whose lines read "start-end perms offset dev inode path"
+std::optional<Mapping> findAnonymousMapping(const uintptr_t address)
+{
+    std::ifstream maps("/proc/self/maps");
+    std::string line;
+    while (std::getline(maps, line))
+    {
+        std::istringstream fields(line);
+        std::string range;
+        std::string permissions;
+        std::string offset;
+        std::string device;
+        std::string inode;
+        std::string path;
+        fields >> range >> permissions >> offset >> device >> inode >> path;
+        const auto separator = range.find('-');
+        if (separator == std::string::npos)
+        {
+            continue;
+        }
+        const auto start = std::stoull(range.substr(0, separator), nullptr, 16);
+        const auto end = std::stoull(range.substr(separator + 1), nullptr, 16);
+        if (address >= start and address < end)
+        {
+            if (not path.empty())
+            {
+                return std::nullopt;
+            }
+            return Mapping{.start = start, .end = end};
+        }
+    }
+    return std::nullopt;
+}
+
+/// All symbols of the process append to the same map file
+void appendToPerfMap(const Mapping& mapping, const std::string& name)
+{
+    static std::mutex mutex;
+    static std::ofstream perfMap(fmt::format("/tmp/perf-{}.map", getpid()), std::ios::app);
+    const std::scoped_lock lock(mutex);
+    perfMap << fmt::format("{:x} {:x} {}\n", mapping.start, mapping.end - mapping.start, name) << std::flush;
+    if (not perfMap)
+    {
+        NES_WARNING("Could not write the symbol {} to the perf map", name);
+    }
+}
+}
+
+PerfMapSymbol::PerfMapSymbol(std::string name) : name(std::move(name))
+{
+}
+
+void PerfMapSymbol::registerCode(const void* codeAddress)
+{
+    if (registered.test(std::memory_order_relaxed) or registered.test_and_set())
+    {
+        return;
+    }
+    if (const auto mapping = findAnonymousMapping(reinterpret_cast<uintptr_t>(codeAddress)))
+    {
+        appendToPerfMap(*mapping, name);
+        NES_DEBUG("Registered {} bytes of compiled code as {} in the perf map", mapping->end - mapping->start, name);
+    }
+}
+
+}
@@ -108,7 +108,7 @@ void NodeEngine::startQuery(QueryId queryId)
     if (auto qep = queryTracker->moveToExecuting(queryId))
     {
         systemEventListener->onEvent(StartQuerySystemEvent(queryId));
-        queryEngine->start(ExecutableQueryPlan::instantiate(*qep, *sourceProvider));
+        queryEngine->start(ExecutableQueryPlan::instantiate(*qep, *sourceProvider, bufferManager));
     }
     else
     {
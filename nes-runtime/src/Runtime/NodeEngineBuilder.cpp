@@ -14,13 +14,22 @@
 
 #include <Runtime/NodeEngineBuilder.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <memory>
+#include <memory_resource>
 #include <utility>
+#include <vector>
 #include <Configuration/WorkerConfiguration.hpp>
 #include <Listeners/QueryLog.hpp>
+#include <Runtime/Allocator/HugePageMemoryResource.hpp>
+#include <Runtime/Allocator/NesDefaultMemoryAllocator.hpp>
 #include <Runtime/BufferManager.hpp>
+#include <Runtime/BufferOwnership.hpp>
 #include <Runtime/NodeEngine.hpp>
 #include <Sources/SourceProvider.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Strings.hpp>
 #include <QueryEngine.hpp>
 
 namespace NES
@@ -34,15 +43,52 @@ NodeEngineBuilder::NodeEngineBuilder(const WorkerConfiguration& workerConfigurat
 
 std::unique_ptr<NodeEngine> NodeEngineBuilder::build(WorkerId workerId)
 {
-    auto bufferManager = BufferManager::create(
-        workerConfiguration.defaultQueryExecution.operatorBufferSize.getValue(),
-        workerConfiguration.numberOfBuffersInGlobalBufferManager.getValue());
+    if (workerConfiguration.trackBufferOwnership.getValue())
+    {
+        BufferOwnership::enable();
+    }
+    const auto hugePageMode = workerConfiguration.hugePages.getValue();
+    std::shared_ptr<std::pmr::memory_resource> memoryResource = hugePageMode == HugePageMode::NONE
+        ? std::static_pointer_cast<std::pmr::memory_resource>(std::make_shared<NesDefaultMemoryAllocator>())
+        : std::make_shared<HugePageMemoryResource>(hugePageMode);
+    auto bufferManager = workerConfiguration.numaAwareBufferManager.getValue()
+        ? BufferManager::createNumaAware(
+              workerConfiguration.defaultQueryExecution.operatorBufferSize.getValue(),
+              workerConfiguration.numberOfBuffersInGlobalBufferManager.getValue(),
+              hugePageMode)
+        : BufferManager::create(
+              workerConfiguration.defaultQueryExecution.operatorBufferSize.getValue(),
+              workerConfiguration.numberOfBuffersInGlobalBufferManager.getValue(),
+              memoryResource);
+    if (workerConfiguration.prefaultBufferPool.getValue() || workerConfiguration.lockBufferPool.getValue())
+    {
+        bufferManager->prefaultInBackground(workerConfiguration.lockBufferPool.getValue());
+    }
+    if (workerConfiguration.threadLocalBufferCacheSize.getValue() > 0)
+    {
+        bufferManager->enableThreadLocalCaches(workerConfiguration.threadLocalBufferCacheSize.getValue());
+    }
+    if (workerConfiguration.numberOfBuffersPerSizeClass.getValue() > 0)
+    {
+        bufferManager->enableSizeClasses(BufferManager::DEFAULT_SIZE_CLASSES, workerConfiguration.numberOfBuffersPerSizeClass.getValue());
+    }
     auto queryLog = std::make_shared<QueryLog>();
 
     auto queryEngine
         = std::make_unique<QueryEngine>(workerConfiguration.queryEngine, statisticsListener, queryLog, bufferManager, workerId);
 
-    auto sourceProvider = std::make_unique<SourceProvider>(workerConfiguration.defaultMaxInflightBuffers.getValue(), bufferManager);
+    auto sourceThreadCpus = parseIdList(workerConfiguration.sourceThreadCpus.getValue()).value_or(std::vector<size_t>{});
+    const auto workerThreadCpus = parseIdList(workerConfiguration.queryEngine.workerThreadCpus.getValue()).value_or(std::vector<size_t>{});
+    if (std::ranges::any_of(sourceThreadCpus, [&](const size_t cpu) { return std::ranges::contains(workerThreadCpus, cpu); }))
+    {
+        NES_WARNING("The source thread cpus overlap with the worker thread cpus, thus sources and workers compete for the same caches");
+    }
+    auto sourceProvider = std::make_unique<SourceProvider>(
+        workerConfiguration.defaultMaxInflightBuffers.getValue(),
+        bufferManager,
+        workerConfiguration.numberOfMultiplexedSourceThreads.getValue(),
+        std::move(sourceThreadCpus),
+        workerConfiguration.adaptiveInflightBuffers.getValue());
 
     return std::make_unique<NodeEngine>(
         std::move(bufferManager), statisticsListener, std::move(queryLog), std::move(queryEngine), std::move(sourceProvider));
@@ -0,0 +1,88 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <Pipelines/CompilationThreadPool.hpp>
+
+namespace NES
+{
+
+/// NOLINTBEGIN(readability-magic-numbers)
+TEST(CompilationThreadPoolTest, RunsAllSubmittedCompilations)
+{
+    constexpr int numberOfCompilations = 100;
+    std::atomic<int> numberOfFinishedCompilations = 0;
+    std::vector<std::future<void>> finished;
+    {
+        CompilationThreadPool threadPool(3);
+        for (int i = 0; i < numberOfCompilations; ++i)
+        {
+            auto promise = std::make_shared<std::promise<void>>();
+            finished.emplace_back(promise->get_future());
+            EXPECT_TRUE(threadPool.submit(
+                [promise, &numberOfFinishedCompilations]
+                {
+                    ++numberOfFinishedCompilations;
+                    promise->set_value();
+                }));
+        }
+        for (auto& future : finished)
+        {
+            future.wait();
+        }
+    }
+    EXPECT_EQ(numberOfFinishedCompilations, numberOfCompilations);
+}
+
+TEST(CompilationThreadPoolTest, FailedCompilationDoesNotStopThePool)
+{
+    CompilationThreadPool threadPool(1);
+    EXPECT_TRUE(threadPool.submit([] { throw std::runtime_error("compilation failed"); }));
+    std::promise<void> promise;
+    EXPECT_TRUE(threadPool.submit([&promise] { promise.set_value(); }));
+    promise.get_future().wait();
+}
+
+TEST(CompilationThreadPoolTest, RejectsCompilationsIfTooManyArePending)
+{
+    CompilationThreadPool threadPool(1, 1);
+    std::promise<void> blockerStarted;
+    std::promise<void> releaseBlocker;
+    auto release = releaseBlocker.get_future().share();
+    EXPECT_TRUE(threadPool.submit(
+        [&blockerStarted, release]
+        {
+            blockerStarted.set_value();
+            release.wait();
+        }));
+    blockerStarted.get_future().wait();
+
+    /// The only thread is busy, thus the first compilation waits and the second one exceeds the limit
+    std::promise<void> pendingFinished;
+    EXPECT_TRUE(threadPool.submit([&pendingFinished] { pendingFinished.set_value(); }));
+    EXPECT_FALSE(threadPool.submit([] { FAIL() << "Rejected compilations must not run"; }));
+
+    releaseBlocker.set_value();
+    pendingFinished.get_future().wait();
+}
+
+/// NOLINTEND(readability-magic-numbers)
+}
@@ -132,6 +132,27 @@ TEST_F(QueryLogTest, GetQuerySummaryPartialExecution)
     EXPECT_FALSE(status->metrics.error.has_value());
 }
 
+TEST_F(QueryLogTest, GetQuerySummaryWhileCompiling)
+{
+    queryLog->logQueryStatusChange(testQueryId, QueryState::Compiling, testTime);
+    const auto compiling = queryLog->getQueryStatus(testQueryId);
+    ASSERT_TRUE(compiling.has_value());
+    EXPECT_EQ(compiling->state, QueryState::Compiling);
+
+    queryLog->logQueryStatusChange(testQueryId, QueryState::Registered, testTime + 100ms);
+    const auto registered = queryLog->getQueryStatus(testQueryId);
+    ASSERT_TRUE(registered.has_value());
+    EXPECT_EQ(registered->state, QueryState::Registered);
+
+    /// A query that fails to compile never becomes registered
+    constexpr QueryId failedQuery{7};
+    queryLog->logQueryStatusChange(failedQuery, QueryState::Compiling, testTime);
+    queryLog->logQueryFailure(failedQuery, Exception{"Compilation failed", 500}, testTime + 100ms);
+    const auto failed = queryLog->getQueryStatus(failedQuery);
+    ASSERT_TRUE(failed.has_value());
+    EXPECT_EQ(failed->state, QueryState::Failed);
+}
+
 TEST_F(QueryLogTest, GetQuerySummaryForNonExistentQuery)
 {
     const auto status = queryLog->getQueryStatus(QueryId{999});
@@ -162,6 +183,40 @@ TEST_F(QueryLogTest, MultipleQueriesIndependentLogs)
     EXPECT_EQ(status2->metrics.error->code(), 400);
 }
 
+TEST_F(QueryLogTest, SubscriptionReceivesSnapshotAndLaterChanges)
+{
+    constexpr QueryId otherQuery{7};
+    queryLog->logQueryStatusChange(testQueryId, QueryState::Started, testTime);
+    const auto subscription = queryLog->subscribe(16);
+    queryLog->logQueryStatusChange(testQueryId, QueryState::Running, testTime + 100ms);
+    queryLog->logQueryFailure(testQueryId, Exception{"Test error", 500}, testTime + 200ms);
+    /// Failures of unknown queries are not logged, so they are not delivered either
+    queryLog->logQueryFailure(otherQuery, Exception{"Test error", 500}, testTime + 200ms);
+
+    const auto events = subscription->pop(0ms);
+    ASSERT_TRUE(events.has_value());
+    ASSERT_EQ(events->size(), 3);
+    EXPECT_EQ(events->at(0).change.state, QueryState::Started);
+    EXPECT_EQ(events->at(1).change.state, QueryState::Running);
+    EXPECT_EQ(events->at(2).change.state, QueryState::Failed);
+    EXPECT_EQ(events->at(2).change.exception->code(), 500);
+    EXPECT_EQ(events->at(2).queryId, testQueryId);
+
+    const auto noEvents = subscription->pop(0ms);
+    ASSERT_TRUE(noEvents.has_value());
+    EXPECT_TRUE(noEvents->empty());
+}
+
+TEST_F(QueryLogTest, SubscriptionThatFallsBehindMissesEvents)
+{
+    const auto subscription = queryLog->subscribe(2);
+    for (uint64_t i = 0; i < 3; ++i)
+    {
+        queryLog->logQueryStatusChange(QueryId{i + 1}, QueryState::Started, testTime);
+    }
+    EXPECT_FALSE(subscription->pop(0ms).has_value());
+}
+
 TEST_F(QueryLogTest, QueryStateChangeConstructors)
 {
     /// Test state-only constructor
@@ -29,6 +29,8 @@ class GRPCServer final : public WorkerRPCService::Service
 public:
     grpc::Status RegisterQuery(grpc::ServerContext*, const RegisterQueryRequest*, RegisterQueryReply*) override;
 
+    grpc::Status RegisterQueries(grpc::ServerContext*, const RegisterQueriesRequest*, RegisterQueriesReply*) override;
+
     grpc::Status UnregisterQuery(grpc::ServerContext*, const UnregisterQueryRequest*, google::protobuf::Empty*) override;
 
     grpc::Status StartQuery(grpc::ServerContext*, const StartQueryRequest*, google::protobuf::Empty*) override;
@@ -39,8 +41,20 @@ public:
 
     grpc::Status RequestQueryLog(grpc::ServerContext* context, const QueryLogRequest* request, QueryLogReply* response) override;
 
+    grpc::Status RequestQueryMetrics(grpc::ServerContext* context, const QueryMetricsRequest* request, QueryMetricsReply* reply) override;
+
     grpc::Status RequestStatus(grpc::ServerContext* context, const WorkerStatusRequest* request, WorkerStatusResponse* response) override;
 
+    grpc::Status RequestBufferUsage(grpc::ServerContext* context, const google::protobuf::Empty* request, BufferUsageReply* reply) override;
+
+    grpc::Status SubscribeResults(
+        grpc::ServerContext* context, const SubscribeResultsRequest* request, grpc::ServerWriter<ResultBatch>* writer) override;
+
+    grpc::Status
+    WatchQueries(grpc::ServerContext* context, const WatchQueriesRequest* request, grpc::ServerWriter<QueryEvent>* writer) override;
+
+    grpc::Status SetWorkerThreadLimits(grpc::ServerContext*, const WorkerThreadLimitsRequest*, google::protobuf::Empty*) override;
+
     explicit GRPCServer(SingleNodeWorker&& delegate) : delegate(std::move(delegate)) { }
 
 private:
@@ -0,0 +1,79 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stop_token>
+#include <string>
+#include <Thread.hpp>
+
+namespace NES
+{
+
+/// HTTP endpoint that serves the metrics of the worker at GET /metrics, e.g., for Prometheus. A dedicated thread answers one request per
+/// connection and renders the metrics text for every request. Thus, scraping never runs on a WorkerThread and only costs what the
+/// renderer reads.
+class MetricsEndpoint
+{
+public:
+    using Renderer = std::function<std::string()>;
+
+    /// Binds to the port on any address. Port 0 binds to an ephemeral port (see getPort()).
+    /// @throws CannotStartMetricsEndpoint if the port cannot be bound
+    MetricsEndpoint(uint16_t port, Renderer renderer);
+
+    MetricsEndpoint(const MetricsEndpoint&) = delete;
+    MetricsEndpoint& operator=(const MetricsEndpoint&) = delete;
+    MetricsEndpoint(MetricsEndpoint&&) = delete;
+    MetricsEndpoint& operator=(MetricsEndpoint&&) = delete;
+    ~MetricsEndpoint() = default;
+
+    [[nodiscard]] uint16_t getPort() const { return port; }
+
+private:
+    /// Closes the owned file descriptor
+    struct FileDescriptor
+    {
+        explicit FileDescriptor(int descriptor) : descriptor(descriptor) { }
+
+        FileDescriptor(const FileDescriptor&) = delete;
+        FileDescriptor& operator=(const FileDescriptor&) = delete;
+        FileDescriptor(FileDescriptor&&) = delete;
+        FileDescriptor& operator=(FileDescriptor&&) = delete;
+        ~FileDescriptor();
+
+        int descriptor;
+    };
+
+    /// To stop timely, the thread waits for connections for at most this long before it checks the stop token
+    static constexpr std::chrono::milliseconds STOP_TOKEN_CHECK_INTERVAL{100};
+    /// Slow or stuck clients cannot block the endpoint for longer than this per connection
+    static constexpr std::chrono::seconds CONNECTION_TIMEOUT{1};
+    static constexpr size_t MAX_REQUEST_SIZE = 8192;
+
+    void serve(const std::stop_token& stopToken) const;
+    void respond(int connection) const;
+
+    FileDescriptor listeningSocket;
+    uint16_t port;
+    Renderer renderer;
+    /// Declared last, so that the thread is joined before the socket is closed
+    Thread thread;
+};
+
+}
@@ -0,0 +1,134 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+#include <Listeners/StatisticListener.hpp>
+#include <folly/Synchronized.h>
+#include <QueryEngineStatisticListener.hpp>
+
+namespace NES
+{
+
+/// Histogram of durations with exponentially growing buckets: bucket 0 counts durations below 1ns and bucket i counts durations in
+/// [2^(i-1), 2^i) ns. The last bucket also counts all longer durations.
+struct DurationHistogram
+{
+    static constexpr size_t NUMBER_OF_BUCKETS = 40;
+
+    std::array<uint64_t, NUMBER_OF_BUCKETS> bucketCounts{};
+    uint64_t count = 0;
+    std::chrono::nanoseconds sum{0};
+};
+
+/// Cumulative metrics of a pipeline of a running (or terminated) query
+struct PipelineMetrics
+{
+    PipelineId pipelineId = INVALID<PipelineId>;
+    uint64_t tuplesIn = 0;
+    uint64_t buffersIn = 0;
+    /// Counts the buffers (and tuples) once per successor that the pipeline emits them to
+    uint64_t tuplesOut = 0;
+    uint64_t buffersOut = 0;
+    uint64_t expiredTasks = 0;
+    /// Time from the start to the completion of a task, including successors that the worker thread executed right away
+    DurationHistogram taskExecutionTime;
+    /// Time from the submission of a task to its start
+    DurationHistogram queueWaitTime;
+    /// Only sinks record the end-to-end latency, i.e., the time from the ingestion of the tuples of a buffer by a source until the sink
+    /// completed the buffer. Window operators emit the range of the ingestion timestamps of all buffers that filled the window. Thus, for
+    /// windows the earliest tuple includes the time that the window was open, while the latest tuple includes only the trigger delay.
+    bool isSink = false;
+    DurationHistogram endToEndLatencyOfEarliestTuple;
+    DurationHistogram endToEndLatencyOfLatestTuple;
+    /// Sums of the hardware counters over the counted tasks, if the worker threads count hardware events. Cycles per instruction and
+    /// cache misses per tuple tell whether the pipeline is bound by memory accesses or by computation.
+    uint64_t countedTasks = 0;
+    HardwareCounterValues hardwareCounters;
+};
+
+/// Observes the tasks of the pipelines of all running queries. The worker threads update the metrics of a pipeline in one of a few
+/// cache-aligned shards, so that the threads do not contend on the counters. Reading the metrics sums up the shards.
+/// The metrics of a query exist from the start of its first pipeline until the query is unregistered.
+class PipelineMetricsListener final : public StatisticListener
+{
+public:
+    void unregisterQuery(QueryId queryId);
+
+    void onEvent(Event event) override;
+    void onEvent(SystemEvent event) override;
+
+    /// Returns the metrics of all started pipelines of the query, or nullopt if no pipeline of the query started so far
+    [[nodiscard]] std::optional<std::vector<PipelineMetrics>> getMetrics(QueryId queryId) const;
+
+private:
+    static constexpr size_t NUMBER_OF_SHARDS = 16;
+
+    struct AtomicHistogram
+    {
+        void record(std::chrono::nanoseconds duration);
+        void addTo(DurationHistogram& histogram) const;
+
+        std::array<std::atomic<uint64_t>, DurationHistogram::NUMBER_OF_BUCKETS> bucketCounts{};
+        std::atomic<int64_t> sumInNs{0};
+    };
+
+    struct alignas(std::hardware_destructive_interference_size) Shard
+    {
+        std::atomic<uint64_t> tuplesIn{0};
+        std::atomic<uint64_t> buffersIn{0};
+        std::atomic<uint64_t> tuplesOut{0};
+        std::atomic<uint64_t> buffersOut{0};
+        std::atomic<uint64_t> expiredTasks{0};
+        AtomicHistogram taskExecutionTime;
+        AtomicHistogram queueWaitTime;
+        AtomicHistogram endToEndLatencyOfEarliestTuple;
+        AtomicHistogram endToEndLatencyOfLatestTuple;
+        std::atomic<uint64_t> countedTasks{0};
+        std::atomic<uint64_t> cycles{0};
+        std::atomic<uint64_t> instructions{0};
+        std::atomic<uint64_t> lastLevelCacheMisses{0};
+        std::atomic<uint64_t> branchMisses{0};
+    };
+
+    struct ObservedPipeline
+    {
+        /// Worker thread ids are consecutive, so that the threads of a small pool use different shards
+        [[nodiscard]] Shard& getShard(WorkerThreadId threadId);
+
+        std::array<Shard, NUMBER_OF_SHARDS> shards;
+        std::atomic<bool> isSink{false};
+    };
+
+    using ObservedPipelines = std::unordered_map<PipelineId, std::unique_ptr<ObservedPipeline>>;
+
+    /// Applies the update to the metrics of the pipeline, unless the pipeline did not start (or its query was unregistered)
+    template <typename Function>
+    void updatePipeline(QueryId queryId, PipelineId pipelineId, Function&& update);
+
+    folly::Synchronized<std::unordered_map<QueryId, ObservedPipelines>> observedQueries;
+};
+
+}
@@ -0,0 +1,56 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <unordered_map>
+#include <Identifiers/Identifiers.hpp>
+#include <QueryResourceEstimator.hpp>
+
+namespace NES
+{
+
+/// Admits a query only if its estimated state and worker threads fit into the share of the worker that the admitted queries leave over.
+/// Thus, an overloaded worker rejects a new query up front, instead of running out of buffers or slowing down all running queries.
+/// If the query does not fit, its registration waits up to the queue timeout until unregistered queries release their reservations.
+/// A capacity of zero disables the admission control of the respective resource.
+class QueryAdmissionController
+{
+public:
+    QueryAdmissionController(double memoryCapacityInBytes, double workerThreadCapacity, std::chrono::milliseconds queueTimeout);
+
+    /// Reserves the estimated resources for the query or throws QueryRegistrationFailed
+    void admit(QueryId queryId, const QueryResourceEstimate& estimate);
+    /// Releases the reservation of the query, if it has any
+    void release(QueryId queryId);
+
+    [[nodiscard]] bool isEnabled() const;
+
+private:
+    [[nodiscard]] bool fits(const QueryResourceEstimate& estimate) const;
+
+    double memoryCapacityInBytes;
+    double workerThreadCapacity;
+    std::chrono::milliseconds queueTimeout;
+
+    std::mutex mutex;
+    std::condition_variable released;
+    std::unordered_map<QueryId, QueryResourceEstimate> admittedQueries;
+    QueryResourceEstimate reserved{.stateSizeInBytes = 0, .busyWorkerThreads = 0};
+};
+
+}
@@ -0,0 +1,108 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <unordered_map>
+#include <Identifiers/Identifiers.hpp>
+#include <Listeners/StatisticListener.hpp>
+#include <folly/ProducerConsumerQueue.h>
+#include <Thread.hpp>
+
+namespace NES
+{
+
+/// Low-overhead alternative to the GoogleEventTracePrinter, which records only a sample of the tasks and writes the trace in the binary
+/// Perfetto format (https://perfetto.dev), which ui.perfetto.dev opens.
+/// A task is recorded if its TaskId is a multiple of the sampling interval, or if it ran for at least the latency threshold. Query and
+/// pipeline lifecycle events are always recorded. Every thread writes its records into its own single-producer ring buffer, without
+/// locking or formatting. The trace thread periodically drains all ring buffers into the trace file. If a ring buffer is full, the
+/// record is dropped.
+class SampledEventTracePrinter final : public StatisticListener
+{
+public:
+    /// @param samplingInterval records every n-th task, 0 records only the tasks above the latency threshold
+    /// @param latencyThreshold records all tasks that run at least this long, 0 disables the threshold
+    SampledEventTracePrinter(const std::filesystem::path& path, uint64_t samplingInterval, std::chrono::microseconds latencyThreshold);
+
+    void onEvent(Event event) override;
+    void onEvent(SystemEvent event) override;
+
+    /// Start the trace thread. Must be called after construction.
+    void start();
+
+private:
+    static constexpr size_t RING_BUFFER_CAPACITY = 4096;
+    static constexpr std::chrono::milliseconds FLUSH_INTERVAL{100};
+
+    /// Trivially copyable, so that recording does not allocate
+    struct TraceRecord
+    {
+        enum class Kind : uint8_t
+        {
+            Task,
+            TaskExpired,
+            QueryStart,
+            QueryStopRequest,
+            QueryStop,
+            QueryFail,
+            PipelineStart,
+            PipelineStop,
+            SubmitQuery,
+            StartQuery,
+            StopQuery,
+        };
+
+        Kind kind = Kind::Task;
+        WorkerThreadId::Underlying threadId = WorkerThreadId::INVALID;
+        QueryId::Underlying queryId = QueryId::INVALID;
+        PipelineId::Underlying pipelineId = PipelineId::INVALID;
+        TaskId::Underlying taskId = TaskId::INVALID;
+        /// Nanoseconds since the epoch of the system clock. Only tasks have a duration.
+        int64_t startInNs = 0;
+        int64_t endInNs = 0;
+    };
+
+    using RingBuffer = folly::ProducerConsumerQueue<TraceRecord>;
+
+    [[nodiscard]] bool isSampled(TaskId taskId, std::chrono::nanoseconds duration) const;
+    void record(const TraceRecord& record);
+    /// Returns the ring buffer of the calling thread, which is only written by the calling thread
+    RingBuffer& getRingBuffer();
+
+    void threadRoutine(const std::stop_token& token);
+
+    std::filesystem::path outputPath;
+    uint64_t samplingInterval;
+    std::chrono::nanoseconds latencyThreshold;
+    /// Identifies this printer in the thread-local lookup of the ring buffers. Unlike the address, the id is never reused.
+    uint64_t instanceId;
+
+    /// Only locked by threads that record for the first time and by the trace thread while it drains the ring buffers
+    std::mutex ringBuffersMutex;
+    std::unordered_map<std::thread::id, std::unique_ptr<RingBuffer>> ringBuffers;
+
+    /// Must be declared last so it's destroyed first, ensuring the thread stops before the ring buffers are destroyed
+    Thread traceThread;
+};
+
+}
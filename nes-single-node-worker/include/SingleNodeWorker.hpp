@@ -15,21 +15,34 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <expected>
 #include <memory>
 #include <optional>
+#include <string>
+#include <vector>
 #include <Identifiers/Identifiers.hpp>
 #include <Listeners/QueryLog.hpp>
+#include <Pipelines/CompilationThreadPool.hpp>
 #include <Plans/LogicalPlan.hpp>
+#include <Runtime/BufferOwnership.hpp>
 #include <Runtime/Execution/QueryStatus.hpp>
 #include <Runtime/NodeEngine.hpp>
 #include <Runtime/QueryTerminationType.hpp>
+#include <Sinks/ResultStream.hpp>
 #include <Util/Pointers.hpp>
+#include <ColumnStatisticsCollector.hpp>
+#include <CompiledQueryPlan.hpp>
 #include <CompositeStatisticListener.hpp>
 #include <ErrorHandling.hpp>
+#include <MetricsEndpoint.hpp>
+#include <PipelineMetricsListener.hpp>
+#include <QueryAdmissionController.hpp>
 #include <QueryCompiler.hpp>
 #include <QueryOptimizer.hpp>
 #include <SingleNodeWorkerConfiguration.hpp>
+#include <SourceRateListener.hpp>
+#include <WorkerMetrics.hpp>
 #include <WorkerStatus.hpp>
 
 namespace NES
@@ -41,11 +54,24 @@ namespace NES
 /// The Class itself is NonCopyable, but Movable, it owns the QueryCompiler and the NodeEngine.
 class SingleNodeWorker
 {
+    /// Optimizes and compiles asynchronously registered queries. Declared first to replace it first on move assignment, as pending
+    /// registrations use the optimizer and the compiler. For the same reason, the destructor destroys it first.
+    std::unique_ptr<CompilationThreadPool> registrationThreadPool;
     SharedPtr<CompositeStatisticListener> listener;
+    /// The compiled queries sample the values of their source fields into it. Null, if the sampling is disabled.
+    std::shared_ptr<ColumnStatisticsCollector> columnStatistics;
+    /// Provides the observed source rates and column statistics to the cost-based decisions of the optimizer
+    SharedPtr<SourceRateListener> sourceRateListener;
+    SharedPtr<PipelineMetricsListener> pipelineMetricsListener;
+    SharedPtr<CompilationMetrics> compilationMetrics;
     SharedPtr<NodeEngine> nodeEngine;
+    /// Reserves the estimated resources of the registered queries. Shared with the asynchronous registrations.
+    SharedPtr<QueryAdmissionController> admissionController;
     UniquePtr<QueryOptimizer> optimizer;
     UniquePtr<QueryCompilation::QueryCompiler> compiler;
     SingleNodeWorkerConfiguration configuration;
+    /// Only exists if the metrics port is configured. It shares the engine and the metrics, thus it does not depend on the worker.
+    std::unique_ptr<MetricsEndpoint> metricsEndpoint;
 
 public:
     explicit SingleNodeWorker(const SingleNodeWorkerConfiguration&, WorkerId = WorkerId("SingleNodeWorker"));
@@ -61,14 +87,41 @@ public:
     /// Registers a DecomposedQueryPlan which internally triggers the QueryCompiler and registers the executable query plan. Once
     /// returned the query can be started with the QueryId. The registered Query will be in the StoppedState
     /// @param plan Fully Specified LogicalQueryPlan.
+    /// @param memoryQuotaInBytes number of bytes of buffers the query may hold before its sources are throttled, 0 disables the quota
+    /// @param priority determines the share of the admission queue of the QueryEngine that the tasks of the query get
     /// @return QueryId which identifies the registered Query
-    [[nodiscard]] std::expected<QueryId, Exception> registerQuery(LogicalPlan plan) noexcept;
+    [[nodiscard]] std::expected<QueryId, Exception>
+    registerQuery(LogicalPlan plan, size_t memoryQuotaInBytes = 0, QueryPriority priority = QueryPriority::Normal) noexcept;
+
+    /// Registers the plans of multiple queries as a single query, whose plans share equal sources and equal operators on top of them.
+    /// The results fan out to the sinks of the individual plans. The merged query has a single lifecycle, i.e., all plans start, stop,
+    /// and fail together under the returned QueryId.
+    /// @param plans Fully Specified LogicalQueryPlans. Their QueryIds are ignored.
+    /// @return QueryId which identifies the registered merged Query
+    [[nodiscard]] std::expected<QueryId, Exception>
+    registerMergedQueries(
+        const std::vector<LogicalPlan>& plans, size_t memoryQuotaInBytes = 0, QueryPriority priority = QueryPriority::Normal) noexcept;
+
+    /// Registers the plans of multiple queries, which the registration threads optimize and compile concurrently. Either all plans are
+    /// registered or none: if a plan fails, the worker unregisters the other plans of the batch and returns the error of the plan.
+    /// @return QueryIds of the registered queries, in the order of the plans
+    [[nodiscard]] std::expected<std::vector<QueryId>, Exception>
+    registerQueries(std::vector<LogicalPlan> plans, size_t memoryQuotaInBytes = 0, QueryPriority priority = QueryPriority::Normal) noexcept;
+
+    /// Registers the query like registerQuery, but returns the QueryId right away and optimizes and compiles the query in the
+    /// background. The query is in the Compiling state until it is registered. If the compilation fails, the query is Failed.
+    /// @return QueryId which identifies the query, or QueryRegistrationFailed if too many registrations are pending
+    [[nodiscard]] std::expected<QueryId, Exception>
+    registerQueryAsynchronously(LogicalPlan plan, size_t memoryQuotaInBytes = 0, QueryPriority priority = QueryPriority::Normal) noexcept;
 
     /// Starts the Query asynchronously and moves it into the RunningState. Query execution error are only reported during runtime
     /// of the query.
     /// @param queryId identifies the registered query
     std::expected<void, Exception> startQuery(QueryId queryId) noexcept;
 
+    /// Starts all queries or none: if a query fails to start, the queries that were already started are stopped again.
+    std::expected<void, Exception> startQueries(const std::vector<QueryId>& queryIds) noexcept;
+
     /// Stops the Query and moves it into the StoppedState. The exact semantics and guarantees depend on the chosen
     ///  QueryTerminationType
     /// @param queryId identifies the registered query
@@ -79,10 +132,26 @@ public:
     /// @param queryId identifies the registered stopped query
     std::expected<void, Exception> unregisterQuery(QueryId queryId) noexcept;
 
+    /// Bounds the number of active worker threads, e.g., to release the cores of idle worker threads on a shared host.
+    /// @param minimumActiveWorkerThreads stay active under low load
+    /// @param maximumActiveWorkerThreads may become active under high load, at most the configured number of worker threads
+    std::expected<void, Exception> setWorkerThreadLimits(size_t minimumActiveWorkerThreads, size_t maximumActiveWorkerThreads) noexcept;
+
     /// Complete history of query status changes.
     [[nodiscard]] std::optional<QueryLog::Log> getQueryLog(QueryId queryId) const;
+    /// Receives the status changes of all queries as they happen, see QueryLog::subscribe
+    [[nodiscard]] std::shared_ptr<QueryLogSubscription> watchQueries(size_t maxQueuedEvents);
     /// Summary structure for query.
     [[nodiscard]] std::expected<LocalQueryStatus, Exception> getQueryStatus(QueryId queryId) const noexcept;
     [[nodiscard]] WorkerStatus getWorkerStatus(std::chrono::system_clock::time_point after) const;
+    /// Runtime metrics of the started pipelines of the query, until the query is unregistered.
+    [[nodiscard]] std::expected<std::vector<PipelineMetrics>, Exception> getQueryMetrics(QueryId queryId) const noexcept;
+    /// Buffers of the global pool that are currently held by queries, sources, or local buffer pools.
+    [[nodiscard]] size_t getNumberOfBuffersInUse() const;
+    [[nodiscard]] size_t getNumberOfPooledBuffers() const;
+    /// Buffers held per owner, if the worker tracks the buffer ownership
+    [[nodiscard]] std::optional<std::vector<BufferOwnership::Usage>> getBufferUsage() const;
+    /// The frames that the Grpc sinks with the stream name write. A subscriber may subscribe before the query of the sink starts.
+    [[nodiscard]] std::shared_ptr<ResultStream> subscribeResults(const std::string& streamName) const;
 };
 }
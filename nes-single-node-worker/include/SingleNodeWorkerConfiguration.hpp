@@ -19,6 +19,7 @@
 #include <Configurations/BaseConfiguration.hpp>
 #include <Configurations/ScalarOption.hpp>
 #include <Configurations/Validation/EndpointValidation.hpp>
+#include <Configurations/Validation/NumberValidation.hpp>
 
 namespace NES
 {
@@ -43,8 +44,23 @@ connections.  Valid values include dns:///localhost:1234,
            "false",
            "Enable Google Event Trace logging that generates Chrome tracing compatible JSON files for performance analysis."};
 
+    /// Queries that are registered asynchronously are optimized and compiled on these threads, i.e., not on the thread of the request
+    UIntOption queryRegistrationThreads
+        = {"query_registration_threads",
+           "2",
+           "Number of threads that optimize and compile asynchronously registered queries.",
+           {std::make_shared<NumberValidation>()}};
+    UIntOption maxPendingQueryRegistrations
+        = {"max_pending_query_registrations",
+           "64",
+           "Maximal number of asynchronously registered queries that wait for a registration thread. Further registrations are rejected.",
+           {std::make_shared<NumberValidation>()}};
+
 protected:
-    std::vector<BaseOption*> getOptions() override { return {&workerConfiguration, &grpcAddressUri, &enableGoogleEventTrace}; }
+    std::vector<BaseOption*> getOptions() override
+    {
+        return {&workerConfiguration, &grpcAddressUri, &enableGoogleEventTrace, &queryRegistrationThreads, &maxPendingQueryRegistrations};
+    }
 
     template <typename T>
     friend void generateHelp(std::ostream& ostream);
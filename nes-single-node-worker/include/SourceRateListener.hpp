@@ -0,0 +1,83 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <Identifiers/Identifiers.hpp>
+#include <Listeners/StatisticListener.hpp>
+#include <Sources/ColumnStatistics.hpp>
+#include <folly/Synchronized.h>
+#include <ColumnStatisticsCollector.hpp>
+#include <CompiledQueryPlan.hpp>
+#include <SourceStatistics.hpp>
+
+namespace NES
+{
+
+/// Observes the rates of the logical sources of the registered queries, i.e., the number of tuples per second that the sources pass to
+/// their successor pipelines. The query optimizer uses the rates to estimate the sizes of the join inputs of newly registered queries.
+/// If multiple queries read the same logical source, we report the highest rate. Once the last of these queries is unregistered, we keep
+/// reporting its final rate.
+/// The statistics of the values of the source fields come from the input formatters, which sample them into the ColumnStatisticsCollector.
+class SourceRateListener final : public StatisticListener, public SourceStatistics
+{
+public:
+    explicit SourceRateListener(std::shared_ptr<const ColumnStatisticsCollector> columnStatistics = nullptr);
+
+    /// Observing a query requires to know which pipelines consume the tuples of its sources
+    void registerQuery(const CompiledQueryPlan& plan);
+    void unregisterQuery(QueryId queryId);
+
+    void onEvent(Event event) override;
+    void onEvent(SystemEvent event) override;
+
+    [[nodiscard]] std::optional<double> getTuplesPerSecond(const std::string& logicalSourceName) const override;
+    [[nodiscard]] std::optional<ColumnStatistics> getColumnStatistics(const std::string& fieldName) const override;
+
+private:
+    /// We only report rates that we observed for at least this long, as the first buffers of a source are not representative
+    static constexpr int64_t MINIMUM_OBSERVATION_DURATION_IN_NS = 100'000'000;
+
+    /// Tuples that the sources of a single logical source passed to one pipeline. Updated concurrently by the worker threads.
+    struct ObservedRate
+    {
+        explicit ObservedRate(std::string logicalSourceName) : logicalSourceName(std::move(logicalSourceName)) { }
+
+        void observe(uint64_t numberOfTuples, int64_t timestampInNs);
+        [[nodiscard]] std::optional<double> getTuplesPerSecond() const;
+
+        std::string logicalSourceName;
+        std::atomic<uint64_t> numberOfTuples{0};
+        std::atomic<int64_t> firstTimestampInNs{0};
+        std::atomic<int64_t> lastTimestampInNs{0};
+    };
+
+    using ObservedPipelines = std::unordered_map<PipelineId, std::shared_ptr<ObservedRate>>;
+
+    /// Sums up the rates of all pipelines of a query that consume tuples of the logical source
+    [[nodiscard]] static std::optional<double> getTuplesPerSecond(const ObservedPipelines& pipelines, const std::string& logicalSourceName);
+
+    folly::Synchronized<std::unordered_map<QueryId, ObservedPipelines>> observedQueries;
+    folly::Synchronized<std::unordered_map<std::string, double>> ratesOfUnregisteredQueries;
+    std::shared_ptr<const ColumnStatisticsCollector> columnStatistics;
+};
+
+}
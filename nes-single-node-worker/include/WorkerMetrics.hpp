@@ -0,0 +1,48 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <Runtime/NodeEngine.hpp>
+
+namespace NES
+{
+
+/// Cumulative compilation times of the queries that the worker registered. The registration threads record concurrently.
+class CompilationMetrics
+{
+public:
+    void recordCompilation(std::chrono::nanoseconds duration);
+
+    [[nodiscard]] uint64_t getNumberOfCompilations() const { return numberOfCompilations.load(std::memory_order::relaxed); }
+
+    [[nodiscard]] std::chrono::nanoseconds getTotalCompilationTime() const
+    {
+        return std::chrono::nanoseconds(compilationTimeInNs.load(std::memory_order::relaxed));
+    }
+
+private:
+    std::atomic<uint64_t> numberOfCompilations{0};
+    std::atomic<int64_t> compilationTimeInNs{0};
+};
+
+/// Renders the worker-level counters in the OpenMetrics text format (https://openmetrics.io), which Prometheus scrapes.
+/// Rendering only reads counters that the hot path maintains anyway (or atomics that it updates without contention).
+std::string renderOpenMetrics(NodeEngine& nodeEngine, const CompilationMetrics& compilationMetrics);
+
+}
@@ -19,5 +19,17 @@
 
 std::vector<NES::BaseOption*> NES::SingleNodeWorkerConfiguration::getOptions()
 {
-    return {&workerConfiguration, &grpcAddressUri, &enableGoogleEventTrace};
+    return {
+        &workerConfiguration,
+        &grpcAddressUri,
+        &enableGoogleEventTrace,
+        &enableSampledEventTrace,
+        &eventTraceSamplingInterval,
+        &eventTraceLatencyThresholdUs,
+        &queryRegistrationThreads,
+        &maxPendingQueryRegistrations,
+        &metricsPort,
+        &admissionMemoryPercent,
+        &admissionWorkerThreadPercent,
+        &admissionQueueTimeoutMs};
 }
@@ -22,6 +22,7 @@
 #include <Configurations/BaseOption.hpp>
 #include <Configurations/ScalarOption.hpp>
 #include <Configurations/Validation/EndpointValidation.hpp>
+#include <Configurations/Validation/NumberValidation.hpp>
 
 namespace NES
 {
@@ -48,6 +49,63 @@ connections.  Valid values include dns:///localhost:1234,
            "false",
            "Enable Google Event Trace logging that generates Chrome tracing compatible JSON files for performance analysis."};
 
+    /// Sampled trace in the Perfetto format, which records only a fraction of the tasks and thus keeps the overhead low enough for
+    /// long-running queries
+    BoolOption enableSampledEventTrace
+        = {"enable_sampled_event_trace",
+           "false",
+           "Enable a sampled event trace that writes Perfetto protobuf files, which ui.perfetto.dev opens."};
+    UIntOption eventTraceSamplingInterval
+        = {"event_trace_sampling_interval",
+           "1000",
+           "The sampled event trace records every n-th task. If 0, only the tasks above the latency threshold are recorded.",
+           {std::make_shared<NumberValidation>()}};
+    UIntOption eventTraceLatencyThresholdUs
+        = {"event_trace_latency_threshold_us",
+           "0",
+           "The sampled event trace records all tasks that run for at least this many microseconds. If 0, the threshold is disabled.",
+           {std::make_shared<NumberValidation>()}};
+
+    /// Queries that are registered asynchronously are optimized and compiled on these threads, i.e., not on the thread of the request
+    UIntOption queryRegistrationThreads
+        = {"query_registration_threads",
+           "2",
+           "Number of threads that optimize and compile asynchronously registered queries.",
+           {std::make_shared<NumberValidation>()}};
+    UIntOption maxPendingQueryRegistrations
+        = {"max_pending_query_registrations",
+           "64",
+           "Maximal number of asynchronously registered queries that wait for a registration thread. Further registrations are rejected.",
+           {std::make_shared<NumberValidation>()}};
+
+    /// Prometheus scrapes the OpenMetrics text of the worker from http://<host>:<port>/metrics
+    UIntOption metricsPort
+        = {"metrics_port",
+           "0",
+           "Port of the HTTP endpoint that exports the worker metrics at /metrics. The endpoint is disabled if the port is 0.",
+           {std::make_shared<NumberValidation>()}};
+
+    /// Admission control rejects queries whose estimated resources exceed the share of the worker that the running queries leave over
+    UIntOption admissionMemoryPercent
+        = {"admission_memory_percent",
+           "0",
+           "Percentage of the global buffer pool that the estimated window state of all admitted queries may occupy. If 0, the memory "
+           "is not checked on admission.",
+           {std::make_shared<NumberValidation>()}};
+
+    UIntOption admissionWorkerThreadPercent
+        = {"admission_worker_thread_percent",
+           "0",
+           "Percentage of the worker threads that the estimated processing time of all admitted queries may occupy. If 0, the worker "
+           "threads are not checked on admission.",
+           {std::make_shared<NumberValidation>()}};
+
+    UIntOption admissionQueueTimeoutMs
+        = {"admission_queue_timeout_ms",
+           "0",
+           "Milliseconds that a query that does not fit waits for other queries to be unregistered before it is rejected.",
+           {std::make_shared<NumberValidation>()}};
+
 protected:
     std::vector<BaseOption*> getOptions() override;
 
@@ -330,6 +330,33 @@ void GoogleEventTracePrinter::threadRoutine(const std::stop_token& token)
 
                     /// Remove from active tasks if present
                     activeTasks.erase(taskExpired.taskId);
+                },
+                [&](const BufferCacheStatistic& bufferCacheStatistic)
+                {
+                    printComma();
+                    fmt::print(
+                        file,
+                        R"x(    {{"args":{{"hits":{},"misses":{}}},"cat":"memory","name":"Buffer Cache (Thread {})","ph":"C","pid":{},"tid":{},"ts":{}}})x",
+                        bufferCacheStatistic.hits,
+                        bufferCacheStatistic.misses,
+                        bufferCacheStatistic.threadId,
+                        pid,
+                        bufferCacheStatistic.threadId.getRawValue(),
+                        timestampToMicroseconds(bufferCacheStatistic.timestamp));
+                },
+                [&](const BufferShed& bufferShed)
+                {
+                    printComma();
+                    fmt::print(
+                        file,
+                        R"x(    {{"args":{{"source_id":{},"tuples":{}}},"cat":"source","name":"Shed Buffer (Source {}, Query {})","ph":"i","pid":{},"tid":{},"ts":{}}})x",
+                        bufferShed.sourceId.getRawValue(),
+                        bufferShed.numberOfTuples,
+                        bufferShed.sourceId,
+                        bufferShed.queryId,
+                        pid,
+                        bufferShed.threadId.getRawValue(),
+                        timestampToMicroseconds(bufferShed.timestamp));
                 }},
             event);
     }
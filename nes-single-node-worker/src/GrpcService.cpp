@@ -15,10 +15,16 @@
 #include <GrpcService.hpp>
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <string>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 #include <Identifiers/Identifiers.hpp>
+#include <Listeners/QueryLog.hpp>
+#include <Runtime/Execution/QueryStatus.hpp>
 #include <Plans/LogicalPlan.hpp>
 #include <Runtime/QueryTerminationType.hpp>
 #include <Serialization/QueryPlanSerializationUtil.hpp>
@@ -27,8 +33,11 @@
 #include <cpptrace/from_current.hpp>
 #include <google/protobuf/empty.pb.h>
 #include <grpcpp/server_context.h>
+#include <grpcpp/support/sync_stream.h>
 #include <grpcpp/support/status.h>
+#include <CompiledQueryPlan.hpp>
 #include <ErrorHandling.hpp>
+#include <PipelineMetricsListener.hpp>
 #include <SingleNodeWorkerRPCService.pb.h>
 #include <WorkerStatus.hpp>
 
@@ -54,6 +63,19 @@ grpc::Status handleError(const Exception& exception, grpc::ServerContext* contex
     return {grpc::INTERNAL, exception.what()};
 }
 
+QueryPriority deserializeQueryPriority(const RegisterQueryRequest::QueryPriority priority)
+{
+    switch (priority)
+    {
+        case RegisterQueryRequest::Low:
+            return QueryPriority::Low;
+        case RegisterQueryRequest::High:
+            return QueryPriority::High;
+        default:
+            return QueryPriority::Normal;
+    }
+}
+
 template <typename T>
 T getValueOrThrow(std::expected<T, Exception> expected)
 {
@@ -63,6 +85,50 @@ T getValueOrThrow(std::expected<T, Exception> expected)
     }
     throw std::move(expected.error());
 }
+
+void serializeDurationHistogram(const DurationHistogram& histogram, ::DurationHistogram* serialized)
+{
+    serialized->mutable_bucketcounts()->Add(histogram.bucketCounts.begin(), histogram.bucketCounts.end());
+    serialized->set_count(histogram.count);
+    serialized->set_suminns(static_cast<uint64_t>(histogram.sum.count()));
+}
+
+void serializeQueryLogEntry(const QueryStateChange& entry, QueryLogEntry* logEntry)
+{
+    logEntry->set_state(static_cast<::QueryState>(entry.state));
+    logEntry->set_unixtimeinms(std::chrono::duration_cast<std::chrono::milliseconds>(entry.timestamp.time_since_epoch()).count());
+    if (entry.exception.has_value())
+    {
+        Error error;
+        error.set_message(entry.exception.value().what());
+        error.set_stacktrace(entry.exception.value().trace().to_string());
+        error.set_code(entry.exception.value().code());
+        error.set_location(
+            std::string(entry.exception.value().where()->filename) + ":"
+            + std::to_string(entry.exception.value().where()->line.value_or(0)));
+        logEntry->mutable_error()->CopyFrom(error);
+    }
+}
+
+void serializePipelineMetrics(const PipelineMetrics& pipelineMetrics, ::PipelineMetrics* pipeline)
+{
+    pipeline->set_pipelineid(pipelineMetrics.pipelineId.getRawValue());
+    pipeline->set_tuplesin(pipelineMetrics.tuplesIn);
+    pipeline->set_buffersin(pipelineMetrics.buffersIn);
+    pipeline->set_tuplesout(pipelineMetrics.tuplesOut);
+    pipeline->set_buffersout(pipelineMetrics.buffersOut);
+    pipeline->set_expiredtasks(pipelineMetrics.expiredTasks);
+    serializeDurationHistogram(pipelineMetrics.taskExecutionTime, pipeline->mutable_taskexecutiontime());
+    serializeDurationHistogram(pipelineMetrics.queueWaitTime, pipeline->mutable_queuewaittime());
+    pipeline->set_issink(pipelineMetrics.isSink);
+    serializeDurationHistogram(pipelineMetrics.endToEndLatencyOfEarliestTuple, pipeline->mutable_endtoendlatencyofearliesttuple());
+    serializeDurationHistogram(pipelineMetrics.endToEndLatencyOfLatestTuple, pipeline->mutable_endtoendlatencyoflatesttuple());
+    pipeline->set_countedtasks(pipelineMetrics.countedTasks);
+    pipeline->set_cycles(pipelineMetrics.hardwareCounters.cycles);
+    pipeline->set_instructions(pipelineMetrics.hardwareCounters.instructions);
+    pipeline->set_lastlevelcachemisses(pipelineMetrics.hardwareCounters.lastLevelCacheMisses);
+    pipeline->set_branchmisses(pipelineMetrics.hardwareCounters.branchMisses);
+}
 }
 
 grpc::Status GRPCServer::RegisterQuery(grpc::ServerContext* context, const RegisterQueryRequest* request, RegisterQueryReply* response)
@@ -70,7 +136,11 @@ grpc::Status GRPCServer::RegisterQuery(grpc::ServerContext* context, const Regis
     auto fullySpecifiedQueryPlan = QueryPlanSerializationUtil::deserializeQueryPlan(request->queryplan());
     CPPTRACE_TRY
     {
-        auto result = delegate.registerQuery(std::move(fullySpecifiedQueryPlan));
+        const auto memoryQuotaInBytes = request->memoryquotainbytes();
+        const auto priority = deserializeQueryPriority(request->priority());
+        auto result = request->compileasynchronously()
+            ? delegate.registerQueryAsynchronously(std::move(fullySpecifiedQueryPlan), memoryQuotaInBytes, priority)
+            : delegate.registerQuery(std::move(fullySpecifiedQueryPlan), memoryQuotaInBytes, priority);
         if (result.has_value())
         {
             response->set_queryid(result->getRawValue());
@@ -85,6 +155,55 @@ grpc::Status GRPCServer::RegisterQuery(grpc::ServerContext* context, const Regis
     return {grpc::INTERNAL, "unknown exception"};
 }
 
+grpc::Status
+GRPCServer::RegisterQueries(grpc::ServerContext* context, const RegisterQueriesRequest* request, RegisterQueriesReply* response)
+{
+    CPPTRACE_TRY
+    {
+        std::vector<LogicalPlan> plans;
+        plans.reserve(request->queryplans_size());
+        for (const auto& queryPlan : request->queryplans())
+        {
+            plans.push_back(QueryPlanSerializationUtil::deserializeQueryPlan(queryPlan));
+        }
+        const auto memoryQuotaInBytes = request->memoryquotainbytes();
+        const auto priority = deserializeQueryPriority(request->priority());
+
+        std::vector<QueryId> queryIds;
+        if (request->mergesharedsubplans() and not plans.empty())
+        {
+            const auto mergedQueryId = getValueOrThrow(delegate.registerMergedQueries(plans, memoryQuotaInBytes, priority));
+            queryIds = std::vector(plans.size(), mergedQueryId);
+            if (request->start())
+            {
+                getValueOrThrow(delegate.startQueries({mergedQueryId}));
+            }
+        }
+        else
+        {
+            queryIds = getValueOrThrow(delegate.registerQueries(std::move(plans), memoryQuotaInBytes, priority));
+            if (request->start())
+            {
+                getValueOrThrow(delegate.startQueries(queryIds));
+            }
+        }
+        for (const auto queryId : queryIds)
+        {
+            response->add_queryids(queryId.getRawValue());
+        }
+        return grpc::Status::OK;
+    }
+    CPPTRACE_CATCH(const Exception& e)
+    {
+        return handleError(e, context);
+    }
+    CPPTRACE_CATCH_ALT(const std::exception& e)
+    {
+        return handleError(e, context);
+    }
+    return {grpc::INTERNAL, "unknown exception"};
+}
+
 grpc::Status GRPCServer::UnregisterQuery(grpc::ServerContext* context, const UnregisterQueryRequest* request, google::protobuf::Empty*)
 {
     const auto queryId = QueryId(request->queryid());
@@ -205,22 +324,7 @@ grpc::Status GRPCServer::RequestQueryLog(grpc::ServerContext* context, const Que
         {
             for (const auto& entry : *log)
             {
-                QueryLogEntry logEntry;
-                logEntry.set_state(static_cast<::QueryState>(entry.state));
-                logEntry.set_unixtimeinms(
-                    std::chrono::duration_cast<std::chrono::milliseconds>(entry.timestamp.time_since_epoch()).count());
-                if (entry.exception.has_value())
-                {
-                    Error error;
-                    error.set_message(entry.exception.value().what());
-                    error.set_stacktrace(entry.exception.value().trace().to_string());
-                    error.set_code(entry.exception.value().code());
-                    error.set_location(
-                        std::string(entry.exception.value().where()->filename) + ":"
-                        + std::to_string(entry.exception.value().where()->line.value_or(0)));
-                    logEntry.mutable_error()->CopyFrom(error);
-                }
-                reply->add_entries()->CopyFrom(logEntry);
+                serializeQueryLogEntry(entry, reply->add_entries());
             }
             return grpc::Status::OK;
         }
@@ -237,6 +341,195 @@ grpc::Status GRPCServer::RequestQueryLog(grpc::ServerContext* context, const Que
     return {grpc::INTERNAL, "unknown exception"};
 }
 
+grpc::Status GRPCServer::RequestQueryMetrics(grpc::ServerContext* context, const QueryMetricsRequest* request, QueryMetricsReply* reply)
+{
+    CPPTRACE_TRY
+    {
+        const auto queryId = QueryId{request->queryid()};
+        reply->set_queryid(queryId.getRawValue());
+        const auto metrics = delegate.getQueryMetrics(queryId);
+        if (not metrics.has_value())
+        {
+            return {grpc::NOT_FOUND, "Query does not exist or did not start"};
+        }
+        for (const auto& pipelineMetrics : *metrics)
+        {
+            serializePipelineMetrics(pipelineMetrics, reply->add_pipelines());
+        }
+        return grpc::Status::OK;
+    }
+    CPPTRACE_CATCH(const Exception& e)
+    {
+        return handleError(e, context);
+    }
+    CPPTRACE_CATCH_ALT(const std::exception& e)
+    {
+        return handleError(e, context);
+    }
+    return {grpc::INTERNAL, "unknown exception"};
+}
+
+grpc::Status GRPCServer::RequestBufferUsage(grpc::ServerContext* context, const google::protobuf::Empty*, BufferUsageReply* reply)
+{
+    CPPTRACE_TRY
+    {
+        const auto usage = delegate.getBufferUsage();
+        if (not usage.has_value())
+        {
+            return {grpc::FAILED_PRECONDITION, "The worker does not track the buffer ownership, see track_buffer_ownership"};
+        }
+        reply->set_numberofpooledbuffers(delegate.getNumberOfPooledBuffers());
+        reply->set_numberofpooledbuffersinuse(delegate.getNumberOfBuffersInUse());
+        for (const auto& ownerUsage : *usage)
+        {
+            auto* owner = reply->add_owners();
+            owner->set_queryid(ownerUsage.owner.queryId.getRawValue());
+            owner->set_pipelineid(ownerUsage.owner.pipelineId.getRawValue());
+            owner->set_numberofbuffers(ownerUsage.numberOfBuffers);
+            owner->set_numberofbytes(ownerUsage.numberOfBytes);
+        }
+        return grpc::Status::OK;
+    }
+    CPPTRACE_CATCH(const Exception& e)
+    {
+        return handleError(e, context);
+    }
+    CPPTRACE_CATCH_ALT(const std::exception& e)
+    {
+        return handleError(e, context);
+    }
+    return {grpc::INTERNAL, "unknown exception"};
+}
+
+grpc::Status
+GRPCServer::SubscribeResults(grpc::ServerContext* context, const SubscribeResultsRequest* request, grpc::ServerWriter<ResultBatch>* writer)
+{
+    /// Bounds how long a subscription without results notices that its client cancelled it
+    constexpr std::chrono::milliseconds pollInterval{50};
+    constexpr uint32_t defaultMaxFramesPerBatch = 64;
+    CPPTRACE_TRY
+    {
+        if (request->streamname().empty())
+        {
+            return {grpc::INVALID_ARGUMENT, "The stream name must not be empty"};
+        }
+        const auto maxFramesPerBatch = request->maxframesperbatch() == 0 ? defaultMaxFramesPerBatch : request->maxframesperbatch();
+        const auto stream = delegate.subscribeResults(request->streamname());
+        while (not context->IsCancelled())
+        {
+            auto frames = stream->pop(maxFramesPerBatch, pollInterval);
+            if (not frames.has_value())
+            {
+                return grpc::Status::OK;
+            }
+            if (frames->empty())
+            {
+                continue;
+            }
+            ResultBatch batch;
+            for (auto& frame : *frames)
+            {
+                batch.add_frames(std::move(frame));
+            }
+            /// Blocks while the client has no flow control window left, i.e., the worker only sends as fast as the client reads
+            if (not writer->Write(batch))
+            {
+                return {grpc::CANCELLED, "The client closed the result stream"};
+            }
+        }
+        return {grpc::CANCELLED, "The client cancelled the result stream"};
+    }
+    CPPTRACE_CATCH(const Exception& e)
+    {
+        return handleError(e, context);
+    }
+    CPPTRACE_CATCH_ALT(const std::exception& e)
+    {
+        return handleError(e, context);
+    }
+    return {grpc::INTERNAL, "unknown exception"};
+}
+
+grpc::Status
+GRPCServer::WatchQueries(grpc::ServerContext* context, const WatchQueriesRequest* request, grpc::ServerWriter<QueryEvent>* writer)
+{
+    /// Bounds how long a subscription without status changes notices that its client cancelled it
+    constexpr std::chrono::milliseconds pollInterval{50};
+    constexpr size_t maxQueuedEvents = 4096;
+    CPPTRACE_TRY
+    {
+        const auto subscription = delegate.watchQueries(maxQueuedEvents);
+        const std::chrono::milliseconds metricsInterval{request->metricsintervalinms()};
+        auto nextMetrics = std::chrono::steady_clock::now() + metricsInterval;
+        /// Status changes may arrive out of order, e.g., Stopped before Running. Thus, terminated queries are never started again.
+        std::unordered_set<QueryId> startedQueries;
+        std::unordered_set<QueryId> terminatedQueries;
+        while (not context->IsCancelled())
+        {
+            const auto events = subscription->pop(pollInterval);
+            if (not events.has_value())
+            {
+                return {grpc::RESOURCE_EXHAUSTED, "The client fell behind and missed query status changes"};
+            }
+            for (const auto& [queryId, change] : *events)
+            {
+                if (change.state == QueryState::Stopped or change.state == QueryState::Failed)
+                {
+                    startedQueries.erase(queryId);
+                    terminatedQueries.insert(queryId);
+                }
+                else if ((change.state == QueryState::Started or change.state == QueryState::Running)
+                         and not terminatedQueries.contains(queryId))
+                {
+                    startedQueries.insert(queryId);
+                }
+
+                QueryEvent event;
+                event.mutable_statuschange()->set_queryid(queryId.getRawValue());
+                serializeQueryLogEntry(change, event.mutable_statuschange()->mutable_entry());
+                if (not writer->Write(event))
+                {
+                    return {grpc::CANCELLED, "The client closed the query event stream"};
+                }
+            }
+
+            if (metricsInterval.count() == 0 or std::chrono::steady_clock::now() < nextMetrics)
+            {
+                continue;
+            }
+            nextMetrics = std::chrono::steady_clock::now() + metricsInterval;
+            for (const auto queryId : startedQueries)
+            {
+                const auto metrics = delegate.getQueryMetrics(queryId);
+                if (not metrics.has_value())
+                {
+                    continue;
+                }
+                QueryEvent event;
+                event.mutable_metrics()->set_queryid(queryId.getRawValue());
+                for (const auto& pipelineMetrics : *metrics)
+                {
+                    serializePipelineMetrics(pipelineMetrics, event.mutable_metrics()->add_pipelines());
+                }
+                if (not writer->Write(event))
+                {
+                    return {grpc::CANCELLED, "The client closed the query event stream"};
+                }
+            }
+        }
+        return {grpc::CANCELLED, "The client cancelled the query event stream"};
+    }
+    CPPTRACE_CATCH(const Exception& e)
+    {
+        return handleError(e, context);
+    }
+    CPPTRACE_CATCH_ALT(const std::exception& e)
+    {
+        return handleError(e, context);
+    }
+    return {grpc::INTERNAL, "unknown exception"};
+}
+
 grpc::Status GRPCServer::RequestStatus(grpc::ServerContext* context, const WorkerStatusRequest* request, WorkerStatusResponse* response)
 {
     CPPTRACE_TRY
@@ -259,4 +552,23 @@ grpc::Status GRPCServer::RequestStatus(grpc::ServerContext* context, const Worke
     return {grpc::INTERNAL, "unknown exception"};
 }
 
+grpc::Status
+GRPCServer::SetWorkerThreadLimits(grpc::ServerContext* context, const WorkerThreadLimitsRequest* request, google::protobuf::Empty*)
+{
+    CPPTRACE_TRY
+    {
+        getValueOrThrow(delegate.setWorkerThreadLimits(request->minimumactiveworkerthreads(), request->maximumactiveworkerthreads()));
+        return grpc::Status::OK;
+    }
+    CPPTRACE_CATCH(const Exception& e)
+    {
+        return handleError(e, context);
+    }
+    CPPTRACE_CATCH_ALT(const std::exception& e)
+    {
+        return handleError(e, context);
+    }
+    return {grpc::INTERNAL, "unknown exception"};
+}
+
 }
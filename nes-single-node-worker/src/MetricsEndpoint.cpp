@@ -0,0 +1,213 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <MetricsEndpoint.hpp>
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <Util/Logger/Logger.hpp>
+#include <cpptrace/from_current.hpp>
+#include <fmt/format.h>
+#include <ErrorHandling.hpp>
+#include <Thread.hpp>
+
+namespace NES
+{
+
+namespace
+{
+constexpr std::string_view METRICS_PATH = "/metrics";
+constexpr std::string_view METRICS_CONTENT_TYPE = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+
+std::string errorMessage(const int error)
+{
+    std::array<char, 256> buffer{};
+    return strerror_r(error, buffer.data(), buffer.size());
+}
+
+int bindListeningSocket(const uint16_t port)
+{
+    const int descriptor = ::socket(AF_INET6, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (descriptor < 0)
+    {
+        throw CannotStartMetricsEndpoint("Could not create socket: {}", errorMessage(errno));
+    }
+    constexpr int enabled = 1;
+    constexpr int disabled = 0;
+    /// The IPv6 socket also accepts IPv4 connections. Reusing the address allows restarting the worker while old connections linger.
+    ::setsockopt(descriptor, IPPROTO_IPV6, IPV6_V6ONLY, &disabled, sizeof(disabled));
+    ::setsockopt(descriptor, SOL_SOCKET, SO_REUSEADDR, &enabled, sizeof(enabled));
+
+    sockaddr_in6 address{};
+    address.sin6_family = AF_INET6;
+    address.sin6_addr = in6addr_any;
+    address.sin6_port = htons(port);
+    if (::bind(descriptor, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 or ::listen(descriptor, SOMAXCONN) != 0)
+    {
+        const auto error = errno;
+        ::close(descriptor);
+        throw CannotStartMetricsEndpoint("Could not listen on port {}: {}", port, errorMessage(error));
+    }
+    return descriptor;
+}
+
+uint16_t getBoundPort(const int descriptor)
+{
+    sockaddr_in6 address{};
+    socklen_t addressLength = sizeof(address);
+    if (::getsockname(descriptor, reinterpret_cast<sockaddr*>(&address), &addressLength) != 0)
+    {
+        throw CannotStartMetricsEndpoint("Could not determine the bound port: {}", errorMessage(errno));
+    }
+    return ntohs(address.sin6_port);
+}
+
+void sendAll(const int connection, std::string_view data)
+{
+    while (not data.empty())
+    {
+        const auto sent = ::send(connection, data.data(), data.size(), MSG_NOSIGNAL);
+        if (sent < 0 and errno == EINTR)
+        {
+            continue;
+        }
+        if (sent <= 0)
+        {
+            NES_DEBUG("Metrics endpoint could not send the response: {}", errorMessage(errno));
+            return;
+        }
+        data.remove_prefix(static_cast<size_t>(sent));
+    }
+}
+
+void sendResponse(const int connection, const std::string_view status, const std::string_view contentType, const std::string_view body)
+{
+    sendAll(
+        connection,
+        fmt::format(
+            "HTTP/1.1 {}\r\nContent-Type: {}\r\nContent-Length: {}\r\nConnection: close\r\n\r\n{}",
+            status,
+            contentType,
+            body.size(),
+            body));
+}
+
+/// Reads until the end of the request header. The endpoint ignores the body of a request, as it only serves GET requests.
+std::string readRequestHeader(const int connection, const size_t maxRequestSize)
+{
+    std::string request;
+    std::array<char, 1024> buffer{};
+    while (request.size() < maxRequestSize and not request.contains("\r\n\r\n"))
+    {
+        const auto received = ::recv(connection, buffer.data(), buffer.size(), 0);
+        if (received < 0 and errno == EINTR)
+        {
+            continue;
+        }
+        if (received <= 0)
+        {
+            break;
+        }
+        request.append(buffer.data(), static_cast<size_t>(received));
+    }
+    return request;
+}
+}
+
+MetricsEndpoint::FileDescriptor::~FileDescriptor()
+{
+    if (descriptor >= 0)
+    {
+        ::close(descriptor);
+    }
+}
+
+MetricsEndpoint::MetricsEndpoint(const uint16_t port, Renderer renderer)
+    : listeningSocket(bindListeningSocket(port))
+    , port(getBoundPort(listeningSocket.descriptor))
+    , renderer(std::move(renderer))
+    , thread("metrics-http", &MetricsEndpoint::serve, this)
+{
+}
+
+void MetricsEndpoint::serve(const std::stop_token& stopToken) const
+{
+    while (not stopToken.stop_requested())
+    {
+        pollfd listening{.fd = listeningSocket.descriptor, .events = POLLIN, .revents = 0};
+        if (::poll(&listening, 1, static_cast<int>(STOP_TOKEN_CHECK_INTERVAL.count())) <= 0)
+        {
+            continue;
+        }
+        const FileDescriptor connection{::accept4(listeningSocket.descriptor, nullptr, nullptr, SOCK_CLOEXEC)};
+        if (connection.descriptor < 0)
+        {
+            NES_DEBUG("Metrics endpoint could not accept a connection: {}", errorMessage(errno));
+            continue;
+        }
+        respond(connection.descriptor);
+    }
+}
+
+void MetricsEndpoint::respond(const int connection) const
+{
+    const timeval timeout{.tv_sec = CONNECTION_TIMEOUT.count(), .tv_usec = 0};
+    ::setsockopt(connection, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    ::setsockopt(connection, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    const auto request = readRequestHeader(connection, MAX_REQUEST_SIZE);
+    /// The request line is '<method> <target> <version>', the target may carry a query string
+    const std::string_view requestLine = std::string_view{request}.substr(0, request.find("\r\n"));
+    const auto methodEnd = requestLine.find(' ');
+    const auto targetEnd = requestLine.find_first_of(" ?", methodEnd + 1);
+    if (methodEnd == std::string_view::npos or targetEnd == std::string_view::npos)
+    {
+        sendResponse(connection, "400 Bad Request", "text/plain", "Malformed request\n");
+        return;
+    }
+    if (requestLine.substr(0, methodEnd) != "GET")
+    {
+        sendResponse(connection, "405 Method Not Allowed", "text/plain", "Only GET is supported\n");
+        return;
+    }
+    if (requestLine.substr(methodEnd + 1, targetEnd - methodEnd - 1) != METRICS_PATH)
+    {
+        sendResponse(connection, "404 Not Found", "text/plain", fmt::format("Metrics are served at {}\n", METRICS_PATH));
+        return;
+    }
+
+    CPPTRACE_TRY
+    {
+        sendResponse(connection, "200 OK", METRICS_CONTENT_TYPE, renderer());
+    }
+    CPPTRACE_CATCH(...)
+    {
+        tryLogCurrentException();
+        sendResponse(connection, "500 Internal Server Error", "text/plain", "Could not render the metrics\n");
+    }
+}
+
+}
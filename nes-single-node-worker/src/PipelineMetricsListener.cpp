@@ -0,0 +1,209 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <PipelineMetricsListener.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+#include <Identifiers/Identifiers.hpp>
+#include <Listeners/SystemEventListener.hpp>
+#include <QueryEngineStatisticListener.hpp>
+
+namespace NES
+{
+
+void PipelineMetricsListener::AtomicHistogram::record(const std::chrono::nanoseconds duration)
+{
+    const auto durationInNs = static_cast<uint64_t>(std::max<int64_t>(duration.count(), 0));
+    const auto bucket = std::min<size_t>(std::bit_width(durationInNs), DurationHistogram::NUMBER_OF_BUCKETS - 1);
+    bucketCounts[bucket].fetch_add(1, std::memory_order_relaxed);
+    sumInNs.fetch_add(static_cast<int64_t>(durationInNs), std::memory_order_relaxed);
+}
+
+void PipelineMetricsListener::AtomicHistogram::addTo(DurationHistogram& histogram) const
+{
+    for (size_t bucket = 0; bucket < DurationHistogram::NUMBER_OF_BUCKETS; ++bucket)
+    {
+        const auto bucketCount = bucketCounts[bucket].load(std::memory_order_relaxed);
+        histogram.bucketCounts[bucket] += bucketCount;
+        histogram.count += bucketCount;
+    }
+    histogram.sum += std::chrono::nanoseconds(sumInNs.load(std::memory_order_relaxed));
+}
+
+PipelineMetricsListener::Shard& PipelineMetricsListener::ObservedPipeline::getShard(const WorkerThreadId threadId)
+{
+    return shards[threadId.getRawValue() % NUMBER_OF_SHARDS];
+}
+
+template <typename Function>
+void PipelineMetricsListener::updatePipeline(const QueryId queryId, const PipelineId pipelineId, Function&& update)
+{
+    const auto queries = observedQueries.rlock();
+    const auto query = queries->find(queryId);
+    if (query == queries->end())
+    {
+        return;
+    }
+    if (const auto pipeline = query->second.find(pipelineId); pipeline != query->second.end())
+    {
+        std::forward<Function>(update)(*pipeline->second);
+    }
+}
+
+void PipelineMetricsListener::unregisterQuery(const QueryId queryId)
+{
+    observedQueries.wlock()->erase(queryId);
+}
+
+void PipelineMetricsListener::onEvent(Event event)
+{
+    /// The counters only need to be eventually consistent with each other, thus all updates are relaxed
+    std::visit(
+        [this]<typename EventType>(const EventType& concreteEvent)
+        {
+            if constexpr (std::is_same_v<EventType, PipelineStart>)
+            {
+                auto queries = observedQueries.wlock();
+                (*queries)[concreteEvent.queryId].try_emplace(concreteEvent.pipelineId, std::make_unique<ObservedPipeline>());
+            }
+            else if constexpr (std::is_same_v<EventType, TaskExecutionStart>)
+            {
+                updatePipeline(
+                    concreteEvent.queryId,
+                    concreteEvent.pipelineId,
+                    [&](ObservedPipeline& pipeline)
+                    {
+                        auto& shard = pipeline.getShard(concreteEvent.threadId);
+                        shard.tuplesIn.fetch_add(concreteEvent.numberOfTuples, std::memory_order_relaxed);
+                        shard.buffersIn.fetch_add(1, std::memory_order_relaxed);
+                        if (concreteEvent.submissionTimestamp != ChronoClock::time_point{})
+                        {
+                            shard.queueWaitTime.record(concreteEvent.timestamp - concreteEvent.submissionTimestamp);
+                        }
+                    });
+            }
+            else if constexpr (std::is_same_v<EventType, TaskExecutionComplete>)
+            {
+                const bool hasStart = concreteEvent.startTimestamp != ChronoClock::time_point{};
+                const bool hasIngestion = concreteEvent.isSink and concreteEvent.minIngestionTimestamp != ChronoClock::time_point{};
+                if (not hasStart and not hasIngestion and not concreteEvent.hardwareCounters)
+                {
+                    return;
+                }
+                updatePipeline(
+                    concreteEvent.queryId,
+                    concreteEvent.pipelineId,
+                    [&](ObservedPipeline& pipeline)
+                    {
+                        auto& shard = pipeline.getShard(concreteEvent.threadId);
+                        if (hasStart)
+                        {
+                            shard.taskExecutionTime.record(concreteEvent.timestamp - concreteEvent.startTimestamp);
+                        }
+                        if (hasIngestion)
+                        {
+                            /// Every task of a sink sets the flag, thus only the first one writes the shared cache line
+                            if (not pipeline.isSink.load(std::memory_order_relaxed))
+                            {
+                                pipeline.isSink.store(true, std::memory_order_relaxed);
+                            }
+                            shard.endToEndLatencyOfEarliestTuple.record(concreteEvent.timestamp - concreteEvent.minIngestionTimestamp);
+                            shard.endToEndLatencyOfLatestTuple.record(concreteEvent.timestamp - concreteEvent.maxIngestionTimestamp);
+                        }
+                        if (const auto& counters = concreteEvent.hardwareCounters)
+                        {
+                            shard.countedTasks.fetch_add(1, std::memory_order_relaxed);
+                            shard.cycles.fetch_add(counters->cycles, std::memory_order_relaxed);
+                            shard.instructions.fetch_add(counters->instructions, std::memory_order_relaxed);
+                            shard.lastLevelCacheMisses.fetch_add(counters->lastLevelCacheMisses, std::memory_order_relaxed);
+                            shard.branchMisses.fetch_add(counters->branchMisses, std::memory_order_relaxed);
+                        }
+                    });
+            }
+            else if constexpr (std::is_same_v<EventType, TaskEmit>)
+            {
+                updatePipeline(
+                    concreteEvent.queryId,
+                    concreteEvent.fromPipeline,
+                    [&](ObservedPipeline& pipeline)
+                    {
+                        auto& shard = pipeline.getShard(concreteEvent.threadId);
+                        shard.tuplesOut.fetch_add(concreteEvent.numberOfTuples, std::memory_order_relaxed);
+                        shard.buffersOut.fetch_add(1, std::memory_order_relaxed);
+                    });
+            }
+            else if constexpr (std::is_same_v<EventType, TaskExpired>)
+            {
+                updatePipeline(
+                    concreteEvent.queryId,
+                    concreteEvent.pipelineId,
+                    [&](ObservedPipeline& pipeline)
+                    { pipeline.getShard(concreteEvent.threadId).expiredTasks.fetch_add(1, std::memory_order_relaxed); });
+            }
+        },
+        event);
+}
+
+void PipelineMetricsListener::onEvent(SystemEvent)
+{
+}
+
+std::optional<std::vector<PipelineMetrics>> PipelineMetricsListener::getMetrics(const QueryId queryId) const
+{
+    const auto queries = observedQueries.rlock();
+    const auto query = queries->find(queryId);
+    if (query == queries->end())
+    {
+        return std::nullopt;
+    }
+
+    std::vector<PipelineMetrics> metrics;
+    metrics.reserve(query->second.size());
+    for (const auto& [pipelineId, pipeline] : query->second)
+    {
+        PipelineMetrics pipelineMetrics{.pipelineId = pipelineId, .isSink = pipeline->isSink.load(std::memory_order_relaxed)};
+        for (const auto& shard : pipeline->shards)
+        {
+            pipelineMetrics.tuplesIn += shard.tuplesIn.load(std::memory_order_relaxed);
+            pipelineMetrics.buffersIn += shard.buffersIn.load(std::memory_order_relaxed);
+            pipelineMetrics.tuplesOut += shard.tuplesOut.load(std::memory_order_relaxed);
+            pipelineMetrics.buffersOut += shard.buffersOut.load(std::memory_order_relaxed);
+            pipelineMetrics.expiredTasks += shard.expiredTasks.load(std::memory_order_relaxed);
+            shard.taskExecutionTime.addTo(pipelineMetrics.taskExecutionTime);
+            shard.queueWaitTime.addTo(pipelineMetrics.queueWaitTime);
+            shard.endToEndLatencyOfEarliestTuple.addTo(pipelineMetrics.endToEndLatencyOfEarliestTuple);
+            shard.endToEndLatencyOfLatestTuple.addTo(pipelineMetrics.endToEndLatencyOfLatestTuple);
+            pipelineMetrics.countedTasks += shard.countedTasks.load(std::memory_order_relaxed);
+            pipelineMetrics.hardwareCounters.cycles += shard.cycles.load(std::memory_order_relaxed);
+            pipelineMetrics.hardwareCounters.instructions += shard.instructions.load(std::memory_order_relaxed);
+            pipelineMetrics.hardwareCounters.lastLevelCacheMisses += shard.lastLevelCacheMisses.load(std::memory_order_relaxed);
+            pipelineMetrics.hardwareCounters.branchMisses += shard.branchMisses.load(std::memory_order_relaxed);
+        }
+        metrics.push_back(pipelineMetrics);
+    }
+    std::ranges::sort(metrics, {}, &PipelineMetrics::pipelineId);
+    return metrics;
+}
+
+}
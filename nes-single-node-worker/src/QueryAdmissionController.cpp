@@ -0,0 +1,98 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <QueryAdmissionController.hpp>
+
+#include <chrono>
+#include <mutex>
+#include <Identifiers/Identifiers.hpp>
+#include <Identifiers/NESStrongTypeFormat.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <ErrorHandling.hpp>
+#include <QueryResourceEstimator.hpp>
+
+namespace NES
+{
+
+QueryAdmissionController::QueryAdmissionController(
+    const double memoryCapacityInBytes, const double workerThreadCapacity, const std::chrono::milliseconds queueTimeout)
+    : memoryCapacityInBytes(memoryCapacityInBytes), workerThreadCapacity(workerThreadCapacity), queueTimeout(queueTimeout)
+{
+}
+
+bool QueryAdmissionController::isEnabled() const
+{
+    return memoryCapacityInBytes > 0 or workerThreadCapacity > 0;
+}
+
+bool QueryAdmissionController::fits(const QueryResourceEstimate& estimate) const
+{
+    const auto memoryFits = memoryCapacityInBytes == 0 or reserved.stateSizeInBytes + estimate.stateSizeInBytes <= memoryCapacityInBytes;
+    const auto workerThreadsFit
+        = workerThreadCapacity == 0 or reserved.busyWorkerThreads + estimate.busyWorkerThreads <= workerThreadCapacity;
+    return memoryFits and workerThreadsFit;
+}
+
+void QueryAdmissionController::admit(const QueryId queryId, const QueryResourceEstimate& estimate)
+{
+    if (not isEnabled())
+    {
+        return;
+    }
+    std::unique_lock lock(mutex);
+    if (admittedQueries.contains(queryId))
+    {
+        throw QueryRegistrationFailed("Query {} was already admitted", queryId);
+    }
+    /// A query that exceeds the capacity on its own would wait in vain
+    const auto exceedsCapacity = (memoryCapacityInBytes > 0 and estimate.stateSizeInBytes > memoryCapacityInBytes)
+        or (workerThreadCapacity > 0 and estimate.busyWorkerThreads > workerThreadCapacity);
+    if (exceedsCapacity or not released.wait_for(lock, queueTimeout, [&] { return fits(estimate); }))
+    {
+        throw QueryRegistrationFailed(
+            "Query {} was rejected, as it requires an estimated {:.0f} bytes of state and {:.3f} worker threads, but only {:.0f} bytes and "
+            "{:.3f} worker threads are left",
+            queryId,
+            estimate.stateSizeInBytes,
+            estimate.busyWorkerThreads,
+            memoryCapacityInBytes - reserved.stateSizeInBytes,
+            workerThreadCapacity - reserved.busyWorkerThreads);
+    }
+    reserved.stateSizeInBytes += estimate.stateSizeInBytes;
+    reserved.busyWorkerThreads += estimate.busyWorkerThreads;
+    admittedQueries.insert_or_assign(queryId, estimate);
+    NES_DEBUG(
+        "Admitted query {} with an estimated {:.0f} bytes of state and {:.3f} worker threads",
+        queryId,
+        estimate.stateSizeInBytes,
+        estimate.busyWorkerThreads);
+}
+
+void QueryAdmissionController::release(const QueryId queryId)
+{
+    {
+        const std::scoped_lock lock(mutex);
+        const auto admittedQuery = admittedQueries.find(queryId);
+        if (admittedQuery == admittedQueries.end())
+        {
+            return;
+        }
+        reserved.stateSizeInBytes -= admittedQuery->second.stateSizeInBytes;
+        reserved.busyWorkerThreads -= admittedQuery->second.busyWorkerThreads;
+        admittedQueries.erase(admittedQuery);
+    }
+    released.notify_all();
+}
+
+}
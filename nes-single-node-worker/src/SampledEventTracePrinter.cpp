@@ -0,0 +1,358 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <SampledEventTracePrinter.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <unistd.h>
+#include <Identifiers/Identifiers.hpp>
+#include <Listeners/SystemEventListener.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Overloaded.hpp>
+#include <fmt/format.h>
+#include <PerfettoTrace.pb.h>
+#include <QueryEngineStatisticListener.hpp>
+#include <Thread.hpp>
+
+namespace NES
+{
+
+namespace
+{
+/// Log every nth dropped record to avoid clogging the log when the ring buffers are full
+constexpr uint64_t DROP_LOG_INTERVAL = 1000;
+/// All packets belong to the same sequence, as the trace thread is their only writer
+constexpr uint32_t PACKET_SEQUENCE_ID = 1;
+constexpr uint64_t PROCESS_TRACK_UUID = 1;
+constexpr uint64_t SYSTEM_TRACK_UUID = 2;
+constexpr uint64_t THREAD_TRACK_UUID_OFFSET = 1ULL << 32U;
+
+/// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<uint64_t> nextInstanceId{1};
+
+int64_t toNanoseconds(const ChronoClock::time_point timestamp)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count();
+}
+
+uint64_t readClock(const clockid_t clock)
+{
+    timespec time{};
+    ::clock_gettime(clock, &time);
+    return (static_cast<uint64_t>(time.tv_sec) * 1'000'000'000ULL) + static_cast<uint64_t>(time.tv_nsec);
+}
+
+uint64_t getTrackUuid(const WorkerThreadId::Underlying threadId)
+{
+    return threadId == WorkerThreadId::INVALID ? SYSTEM_TRACK_UUID : THREAD_TRACK_UUID_OFFSET + threadId;
+}
+
+void addAnnotation(Perfetto::TrackEvent& event, const std::string& name, const uint64_t value)
+{
+    auto* annotation = event.add_debug_annotations();
+    annotation->set_name(name);
+    annotation->set_uint_value(value);
+}
+
+/// Writes the timestamps of the system clock, which the records use, and tells Perfetto to display the trace in that clock
+void addClockSnapshot(Perfetto::Trace& trace)
+{
+    auto* packet = trace.add_packet();
+    packet->set_trusted_packet_sequence_id(PACKET_SEQUENCE_ID);
+    packet->set_sequence_flags(Perfetto::TracePacket::SEQ_INCREMENTAL_STATE_CLEARED);
+    auto* snapshot = packet->mutable_clock_snapshot();
+    snapshot->set_primary_trace_clock(Perfetto::BUILTIN_CLOCK_REALTIME);
+    auto* realtime = snapshot->add_clocks();
+    realtime->set_clock_id(Perfetto::BUILTIN_CLOCK_REALTIME);
+    realtime->set_timestamp(readClock(CLOCK_REALTIME));
+    auto* boottime = snapshot->add_clocks();
+    boottime->set_clock_id(Perfetto::BUILTIN_CLOCK_BOOTTIME);
+    boottime->set_timestamp(readClock(CLOCK_BOOTTIME));
+}
+
+void addTrackDescriptor(
+    Perfetto::Trace& trace, const uint64_t uuid, const std::string& name, const int32_t pid, const std::optional<int32_t> tid)
+{
+    auto* packet = trace.add_packet();
+    packet->set_trusted_packet_sequence_id(PACKET_SEQUENCE_ID);
+    auto* descriptor = packet->mutable_track_descriptor();
+    descriptor->set_uuid(uuid);
+    if (not tid)
+    {
+        descriptor->set_name(name);
+        descriptor->mutable_process()->set_pid(pid);
+        descriptor->mutable_process()->set_process_name(name);
+        return;
+    }
+    descriptor->set_parent_uuid(PROCESS_TRACK_UUID);
+    descriptor->mutable_thread()->set_pid(pid);
+    descriptor->mutable_thread()->set_tid(*tid);
+    descriptor->mutable_thread()->set_thread_name(name);
+}
+
+Perfetto::TrackEvent&
+addTrackEvent(Perfetto::Trace& trace, const int64_t timestampInNs, const uint64_t trackUuid, const Perfetto::TrackEvent::Type type)
+{
+    auto* packet = trace.add_packet();
+    packet->set_trusted_packet_sequence_id(PACKET_SEQUENCE_ID);
+    packet->set_timestamp(static_cast<uint64_t>(timestampInNs));
+    packet->set_timestamp_clock_id(Perfetto::BUILTIN_CLOCK_REALTIME);
+    auto* event = packet->mutable_track_event();
+    event->set_type(type);
+    event->set_track_uuid(trackUuid);
+    return *event;
+}
+}
+
+SampledEventTracePrinter::SampledEventTracePrinter(
+    const std::filesystem::path& path, const uint64_t samplingInterval, const std::chrono::microseconds latencyThreshold)
+    : outputPath(path), samplingInterval(samplingInterval), latencyThreshold(latencyThreshold), instanceId(nextInstanceId++)
+{
+    NES_INFO(
+        "Will write sampled event trace of every {}th task and tasks above {} to: {}", samplingInterval, latencyThreshold, path);
+}
+
+bool SampledEventTracePrinter::isSampled(const TaskId taskId, const std::chrono::nanoseconds duration) const
+{
+    return (samplingInterval != 0 and taskId.getRawValue() % samplingInterval == 0)
+        or (latencyThreshold != std::chrono::nanoseconds::zero() and duration >= latencyThreshold);
+}
+
+SampledEventTracePrinter::RingBuffer& SampledEventTracePrinter::getRingBuffer()
+{
+    /// Threads usually only record into a single printer, thus we remember the last used ring buffer to avoid the locked lookup
+    struct LastUsedRingBuffer
+    {
+        uint64_t ownerId = 0;
+        RingBuffer* ringBuffer = nullptr;
+    };
+    thread_local LastUsedRingBuffer lastUsed;
+    if (lastUsed.ownerId == instanceId) [[likely]]
+    {
+        return *lastUsed.ringBuffer;
+    }
+
+    const std::scoped_lock lock(ringBuffersMutex);
+    auto& ringBuffer = ringBuffers[std::this_thread::get_id()];
+    if (!ringBuffer)
+    {
+        ringBuffer = std::make_unique<RingBuffer>(RING_BUFFER_CAPACITY);
+    }
+    lastUsed = LastUsedRingBuffer{.ownerId = instanceId, .ringBuffer = ringBuffer.get()};
+    return *ringBuffer;
+}
+
+void SampledEventTracePrinter::record(const TraceRecord& record)
+{
+    if (getRingBuffer().write(record)) [[likely]]
+    {
+        return;
+    }
+    static std::atomic<uint64_t> droppedCount{0};
+    if (const uint64_t dropped = droppedCount.fetch_add(1, std::memory_order_relaxed) + 1; dropped == 1 || dropped % DROP_LOG_INTERVAL == 0)
+    {
+        NES_WARNING("Sampled event trace ring buffer full, {} records dropped so far", dropped);
+    }
+}
+
+void SampledEventTracePrinter::onEvent(Event event)
+{
+    using Kind = TraceRecord::Kind;
+    const auto lifecycle = [this](const Kind kind, const EventBase& event, const PipelineId pipelineId = INVALID<PipelineId>)
+    {
+        record(
+            {.kind = kind,
+             .threadId = event.threadId.getRawValue(),
+             .queryId = event.queryId.getRawValue(),
+             .pipelineId = pipelineId.getRawValue(),
+             .startInNs = toNanoseconds(event.timestamp),
+             .endInNs = toNanoseconds(event.timestamp)});
+    };
+    std::visit(
+        Overloaded{
+            [&](const TaskExecutionComplete& taskComplete)
+            {
+                /// The start timestamp gives the duration without tracking the start of the task
+                if (taskComplete.startTimestamp == ChronoClock::time_point{}
+                    or not isSampled(taskComplete.taskId, taskComplete.timestamp - taskComplete.startTimestamp))
+                {
+                    return;
+                }
+                record(
+                    {.kind = Kind::Task,
+                     .threadId = taskComplete.threadId.getRawValue(),
+                     .queryId = taskComplete.queryId.getRawValue(),
+                     .pipelineId = taskComplete.pipelineId.getRawValue(),
+                     .taskId = taskComplete.taskId.getRawValue(),
+                     .startInNs = toNanoseconds(taskComplete.startTimestamp),
+                     .endInNs = toNanoseconds(taskComplete.timestamp)});
+            },
+            [&](const TaskExpired& taskExpired) { lifecycle(Kind::TaskExpired, taskExpired, taskExpired.pipelineId); },
+            [&](const QueryStart& queryStart) { lifecycle(Kind::QueryStart, queryStart); },
+            [&](const QueryStopRequest& queryStopRequest) { lifecycle(Kind::QueryStopRequest, queryStopRequest); },
+            [&](const QueryStop& queryStop) { lifecycle(Kind::QueryStop, queryStop); },
+            [&](const QueryFail& queryFail) { lifecycle(Kind::QueryFail, queryFail); },
+            [&](const PipelineStart& pipelineStart) { lifecycle(Kind::PipelineStart, pipelineStart, pipelineStart.pipelineId); },
+            [&](const PipelineStop& pipelineStop) { lifecycle(Kind::PipelineStop, pipelineStop, pipelineStop.pipelineId); },
+            /// Task starts and emits are not sampled, and the complete event of a task carries its start
+            [](const TaskExecutionStart&) { },
+            [](const TaskEmit&) { },
+            [](const BufferCacheStatistic&) { },
+            [](const BufferShed&) { }},
+        event);
+}
+
+void SampledEventTracePrinter::onEvent(SystemEvent event)
+{
+    using Kind = TraceRecord::Kind;
+    const auto systemRecord = [](const Kind kind, const QueryId queryId, const ChronoClock::time_point timestamp)
+    {
+        return TraceRecord{
+            .kind = kind, .queryId = queryId.getRawValue(), .startInNs = toNanoseconds(timestamp), .endInNs = toNanoseconds(timestamp)};
+    };
+    record(std::visit(
+        Overloaded{
+            [&](const SubmitQuerySystemEvent& submit) { return systemRecord(Kind::SubmitQuery, submit.queryId, submit.timestamp); },
+            [&](const StartQuerySystemEvent& start) { return systemRecord(Kind::StartQuery, start.queryId, start.timestamp); },
+            [&](const StopQuerySystemEvent& stop) { return systemRecord(Kind::StopQuery, stop.queryId, stop.timestamp); }},
+        event));
+}
+
+void SampledEventTracePrinter::threadRoutine(const std::stop_token& token)
+{
+    const auto pid = static_cast<int32_t>(::getpid());
+    std::ofstream file(outputPath, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!file.is_open())
+    {
+        NES_ERROR("Failed to open trace file: {}", outputPath);
+        return;
+    }
+
+    Perfetto::Trace trace;
+    addClockSnapshot(trace);
+    addTrackDescriptor(trace, PROCESS_TRACK_UUID, "NebulaStream", pid, std::nullopt);
+    addTrackDescriptor(trace, SYSTEM_TRACK_UUID, "System", pid, 0);
+    std::unordered_set<WorkerThreadId::Underlying> describedThreads;
+
+    const auto addRecord = [&](const TraceRecord& record)
+    {
+        using Kind = TraceRecord::Kind;
+        const auto trackUuid = getTrackUuid(record.threadId);
+        if (record.threadId != WorkerThreadId::INVALID and describedThreads.insert(record.threadId).second)
+        {
+            addTrackDescriptor(
+                trace, trackUuid, fmt::format("WorkerThread {}", record.threadId), pid, static_cast<int32_t>(record.threadId) + 1);
+        }
+
+        if (record.kind == Kind::Task)
+        {
+            auto& begin = addTrackEvent(trace, record.startInNs, trackUuid, Perfetto::TrackEvent::TYPE_SLICE_BEGIN);
+            begin.add_categories("task");
+            begin.set_name(fmt::format("Task (Pipeline {}, Query {})", record.pipelineId, record.queryId));
+            addAnnotation(begin, "task_id", record.taskId);
+            addAnnotation(begin, "pipeline_id", record.pipelineId);
+            addTrackEvent(trace, record.endInNs, trackUuid, Perfetto::TrackEvent::TYPE_SLICE_END);
+            return;
+        }
+
+        auto& instant = addTrackEvent(trace, record.startInNs, trackUuid, Perfetto::TrackEvent::TYPE_INSTANT);
+        const auto [category, name] = [&]() -> std::pair<std::string, std::string>
+        {
+            switch (record.kind)
+            {
+                case Kind::Task:
+                case Kind::TaskExpired:
+                    return {"task", fmt::format("Task Expired (Pipeline {}, Query {})", record.pipelineId, record.queryId)};
+                case Kind::QueryStart:
+                    return {"query", fmt::format("Query {} Start", record.queryId)};
+                case Kind::QueryStopRequest:
+                    return {"query", fmt::format("Query {} Stop Request", record.queryId)};
+                case Kind::QueryStop:
+                    return {"query", fmt::format("Query {} Stop", record.queryId)};
+                case Kind::QueryFail:
+                    return {"query", fmt::format("Query {} Fail", record.queryId)};
+                case Kind::PipelineStart:
+                    return {"pipeline", fmt::format("Pipeline {} (Query {}) Start", record.pipelineId, record.queryId)};
+                case Kind::PipelineStop:
+                    return {"pipeline", fmt::format("Pipeline {} (Query {}) Stop", record.pipelineId, record.queryId)};
+                case Kind::SubmitQuery:
+                    return {"system", fmt::format("Submit Query {}", record.queryId)};
+                case Kind::StartQuery:
+                    return {"system", fmt::format("Start Query {}", record.queryId)};
+                case Kind::StopQuery:
+                    return {"system", fmt::format("Stop Query {}", record.queryId)};
+            }
+            std::unreachable();
+        }();
+        instant.add_categories(category);
+        instant.set_name(name);
+    };
+
+    const auto flush = [&]
+    {
+        {
+            const std::scoped_lock lock(ringBuffersMutex);
+            for (const auto& ringBuffer : ringBuffers | std::views::values)
+            {
+                TraceRecord record;
+                while (ringBuffer->read(record))
+                {
+                    addRecord(record);
+                }
+            }
+        }
+        /// Concatenated traces are a valid trace, thus every flush appends its packets
+        if (trace.packet_size() > 0 and not trace.SerializeToOstream(&file))
+        {
+            NES_ERROR("Failed to write to trace file: {}", outputPath);
+        }
+        file.flush();
+        trace.Clear();
+    };
+
+    std::mutex waitMutex;
+    std::condition_variable_any wakeUp;
+    while (!token.stop_requested())
+    {
+        std::unique_lock lock(waitMutex);
+        wakeUp.wait_for(lock, token, FLUSH_INTERVAL, [] { return false; });
+        lock.unlock();
+        flush();
+    }
+    flush();
+}
+
+void SampledEventTracePrinter::start()
+{
+    traceThread = Thread("sampled-trace", [this](const std::stop_token& stopToken) { threadRoutine(stopToken); });
+}
+
+}
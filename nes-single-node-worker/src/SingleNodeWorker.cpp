@@ -14,47 +14,78 @@
 
 #include <SingleNodeWorker.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <future>
 #include <limits>
 #include <memory>
 #include <optional>
 #include <random>
+#include <ranges>
 #include <sstream>
+#include <tuple>
 #include <utility>
+#include <vector>
 #include <unistd.h>
 #include <Configurations/ConfigValuePrinter.hpp>
 #include <Identifiers/Identifiers.hpp>
 #include <Identifiers/NESStrongType.hpp>
 #include <Identifiers/NESStrongTypeFormat.hpp>
 #include <Listeners/QueryLog.hpp>
+#include <Pipelines/CompilationThreadPool.hpp>
 #include <Plans/LogicalPlan.hpp>
+#include <Runtime/BufferManager.hpp>
 #include <Runtime/Execution/QueryStatus.hpp>
+#include <Runtime/NodeEngine.hpp>
 #include <Runtime/NodeEngineBuilder.hpp>
 #include <Runtime/QueryTerminationType.hpp>
+#include <Util/DumpMode.hpp>
 #include <Util/Logger/Logger.hpp>
 #include <Util/PlanRenderer.hpp>
 #include <Util/Pointers.hpp>
 #include <cpptrace/from_current.hpp>
 #include <folly/Synchronized.h>
+#include <ColumnStatisticsCollector.hpp>
 #include <CompositeStatisticListener.hpp>
 #include <ErrorHandling.hpp>
 #include <GoogleEventTracePrinter.hpp>
+#include <MetricsEndpoint.hpp>
+#include <OptimizedPlan.hpp>
+#include <PipelineMetricsListener.hpp>
+#include <QueryAdmissionController.hpp>
 #include <QueryCompiler.hpp>
 #include <QueryOptimizer.hpp>
+#include <QueryResourceEstimator.hpp>
+#include <SampledEventTracePrinter.hpp>
 #include <SingleNodeWorkerConfiguration.hpp>
+#include <SourceRateListener.hpp>
+#include <WorkerMetrics.hpp>
 #include <WorkerStatus.hpp>
 
 namespace NES
 {
 
-SingleNodeWorker::~SingleNodeWorker() = default;
+SingleNodeWorker::~SingleNodeWorker()
+{
+    registrationThreadPool.reset();
+}
+
 SingleNodeWorker::SingleNodeWorker(SingleNodeWorker&& other) noexcept = default;
 SingleNodeWorker& SingleNodeWorker::operator=(SingleNodeWorker&& other) noexcept = default;
 
 SingleNodeWorker::SingleNodeWorker(const SingleNodeWorkerConfiguration& configuration, WorkerId workerId)
-    : listener(std::make_shared<CompositeStatisticListener>()), configuration(configuration)
+    : listener(std::make_shared<CompositeStatisticListener>())
+    , columnStatistics(
+          configuration.workerConfiguration.defaultQueryExecution.columnStatisticsSamplingInterval.getValue() > 0
+              ? std::make_shared<ColumnStatisticsCollector>(
+                    configuration.workerConfiguration.defaultQueryExecution.columnStatisticsSamplingInterval.getValue())
+              : nullptr)
+    , sourceRateListener(std::make_shared<SourceRateListener>(columnStatistics))
+    , pipelineMetricsListener(std::make_shared<PipelineMetricsListener>())
+    , compilationMetrics(std::make_shared<CompilationMetrics>())
+    , configuration(configuration)
 {
     {
         std::stringstream configStr;
@@ -69,11 +100,51 @@ SingleNodeWorker::SingleNodeWorker(const SingleNodeWorkerConfiguration& configur
         googleTracePrinter->start();
         listener->addListener(googleTracePrinter);
     }
+    if (configuration.enableSampledEventTrace.getValue())
+    {
+        auto sampledTracePrinter = std::make_shared<SampledEventTracePrinter>(
+            fmt::format(
+                "trace_{}_{:%Y-%m-%d_%H-%M-%S}_{:d}.perfetto-trace", workerId.getRawValue(), std::chrono::system_clock::now(), ::getpid()),
+            configuration.eventTraceSamplingInterval.getValue(),
+            std::chrono::microseconds(configuration.eventTraceLatencyThresholdUs.getValue()));
+        sampledTracePrinter->start();
+        listener->addListener(sampledTracePrinter);
+    }
+
+    listener->addListener(copyPtr(sourceRateListener));
+    listener->addListener(copyPtr(pipelineMetricsListener));
 
     nodeEngine = NodeEngineBuilder(configuration.workerConfiguration, copyPtr(listener)).build(workerId);
+    const auto bufferManager = nodeEngine->getBufferManager();
+    admissionController = std::make_shared<QueryAdmissionController>(
+        static_cast<double>(bufferManager->getNumOfPooledBuffers() * bufferManager->getBufferSize())
+            * static_cast<double>(configuration.admissionMemoryPercent.getValue()) / 100,
+        static_cast<double>(configuration.workerConfiguration.queryEngine.numberOfWorkerThreads.getValue())
+            * static_cast<double>(configuration.admissionWorkerThreadPercent.getValue()) / 100,
+        std::chrono::milliseconds(configuration.admissionQueueTimeoutMs.getValue()));
 
-    optimizer = std::make_unique<QueryOptimizer>(configuration.workerConfiguration.defaultQueryOptimization);
-    compiler = std::make_unique<QueryCompilation::QueryCompiler>(configuration.workerConfiguration.defaultQueryExecution);
+    optimizer = std::make_unique<QueryOptimizer>(configuration.workerConfiguration.defaultQueryOptimization, copyPtr(sourceRateListener));
+    compiler
+        = std::make_unique<QueryCompilation::QueryCompiler>(configuration.workerConfiguration.defaultQueryExecution, columnStatistics);
+    if (configuration.queryRegistrationThreads.getValue() == 0)
+    {
+        throw InvalidConfigParameter("The SingleNodeWorker requires at least one query registration thread");
+    }
+    registrationThreadPool = std::make_unique<CompilationThreadPool>(
+        configuration.queryRegistrationThreads.getValue(), configuration.maxPendingQueryRegistrations.getValue());
+
+    if (const auto metricsPort = configuration.metricsPort.getValue(); metricsPort != 0)
+    {
+        if (metricsPort > std::numeric_limits<uint16_t>::max())
+        {
+            throw InvalidConfigParameter("The metrics port {} is not a valid port", metricsPort);
+        }
+        metricsEndpoint = std::make_unique<MetricsEndpoint>(
+            static_cast<uint16_t>(metricsPort),
+            [engine = copyPtr(nodeEngine), compilationMetrics = copyPtr(compilationMetrics)]
+            { return renderOpenMetrics(*engine, *compilationMetrics); });
+        NES_INFO("Metrics endpoint listening on port {}", metricsEndpoint->getPort());
+    }
 }
 
 /// This is a workaround to get again unique queryId after our initial worker refactoring.
@@ -81,29 +152,124 @@ SingleNodeWorker::SingleNodeWorker(const SingleNodeWorkerConfiguration& configur
 /// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables, misc-use-anonymous-namespace, cert-err58-cpp) - required for unique query ID generation
 static folly::Synchronized idGenerator{std::mt19937(std::random_device()())};
 
-std::expected<QueryId, Exception> SingleNodeWorker::registerQuery(LogicalPlan plan) noexcept
+namespace
 {
-    CPPTRACE_TRY
+QueryId generateQueryId()
+{
+    std::uniform_int_distribution<size_t> dist(QueryId::INITIAL, std::numeric_limits<int32_t>::max());
+    return QueryId(dist(*idGenerator.wlock()));
+}
+
+void assignQueryId(LogicalPlan& plan)
+{
+    /// Check if the plan already has a query ID
+    if (plan.getQueryId() == INVALID_QUERY_ID)
     {
-        /// Check if the plan already has a query ID
-        if (plan.getQueryId() == INVALID_QUERY_ID)
+        /// Generate a new query ID if the plan doesn't have one
+        plan.setQueryId(generateQueryId());
+    }
+}
+
+void compileAndRegister(
+    const OptimizedPlan& queryPlan,
+    QueryCompilation::QueryCompiler& compiler,
+    SourceRateListener& sourceRateListener,
+    QueryAdmissionController& admissionController,
+    CompilationMetrics& compilationMetrics,
+    NodeEngine& nodeEngine,
+    const DumpMode& dumpMode,
+    const size_t memoryQuotaInBytes,
+    const QueryPriority priority)
+{
+    const auto queryId = queryPlan.getPlan().getQueryId();
+    if (admissionController.isEnabled())
+    {
+        auto estimate = QueryResourceEstimator::estimate(queryPlan.getPlan(), &sourceRateListener);
+        /// The memory quota bounds the buffers that the query may occupy, regardless of our estimate
+        if (memoryQuotaInBytes > 0)
         {
-            std::uniform_int_distribution<size_t> dist(QueryId::INITIAL, std::numeric_limits<int32_t>::max());
-            /// Generate a new query ID if the plan doesn't have one
-            plan.setQueryId(QueryId(dist(*idGenerator.wlock())));
+            estimate.stateSizeInBytes = std::min(estimate.stateSizeInBytes, static_cast<double>(memoryQuotaInBytes));
         }
+        admissionController.admit(queryId, estimate);
+    }
+    try
+    {
+        auto request = std::make_unique<QueryCompilation::QueryCompilationRequest>(queryPlan);
+        request->dumpCompilationResult = dumpMode;
+        const auto compilationStart = std::chrono::steady_clock::now();
+        auto result = compiler.compileQuery(std::move(request));
+        compilationMetrics.recordCompilation(std::chrono::steady_clock::now() - compilationStart);
+        INVARIANT(result, "expected successful query compilation or exception, but got nothing");
+        result->memoryQuotaInBytes = memoryQuotaInBytes;
+        result->priority = priority;
+        sourceRateListener.registerQuery(*result);
+        nodeEngine.registerCompiledQueryPlan(queryId, std::move(result));
+    }
+    catch (...)
+    {
+        admissionController.release(queryId);
+        throw;
+    }
+}
 
-        const LogContext context("queryId", plan.getQueryId());
+void optimizeCompileAndRegister(
+    const LogicalPlan& plan,
+    QueryOptimizer& optimizer,
+    QueryCompilation::QueryCompiler& compiler,
+    CompositeStatisticListener& listener,
+    SourceRateListener& sourceRateListener,
+    QueryAdmissionController& admissionController,
+    CompilationMetrics& compilationMetrics,
+    NodeEngine& nodeEngine,
+    const DumpMode& dumpMode,
+    const size_t memoryQuotaInBytes,
+    const QueryPriority priority)
+{
+    auto queryPlan = optimizer.optimize(plan);
+    listener.onEvent(SubmitQuerySystemEvent{plan.getQueryId(), explain(plan, ExplainVerbosity::Debug)});
+    compileAndRegister(
+        queryPlan,
+        compiler,
+        sourceRateListener,
+        admissionController,
+        compilationMetrics,
+        nodeEngine,
+        dumpMode,
+        memoryQuotaInBytes,
+        priority);
+}
+
+/// Queries that are registered asynchronously are unknown to the NodeEngine until they are compiled
+void throwIfCompiling(const NodeEngine& nodeEngine, const QueryId queryId)
+{
+    if (const auto status = nodeEngine.getQueryLog()->getQueryStatus(queryId); status and status->state == QueryState::Compiling)
+    {
+        throw QueryNotRegistered("Query {} is still compiling", queryId);
+    }
+}
+}
 
-        auto queryPlan = optimizer->optimize(plan);
-        listener->onEvent(SubmitQuerySystemEvent{plan.getQueryId(), explain(plan, ExplainVerbosity::Debug)});
+std::expected<QueryId, Exception>
+SingleNodeWorker::registerQuery(LogicalPlan plan, const size_t memoryQuotaInBytes, const QueryPriority priority) noexcept
+{
+    CPPTRACE_TRY
+    {
+        assignQueryId(plan);
+        const LogContext context("queryId", plan.getQueryId());
         const DumpMode dumpMode(
             configuration.workerConfiguration.dumpQueryCompilationIR.getValue(), configuration.workerConfiguration.dumpGraph.getValue());
-        auto request = std::make_unique<QueryCompilation::QueryCompilationRequest>(queryPlan);
-        request->dumpCompilationResult = dumpMode;
-        auto result = compiler->compileQuery(std::move(request));
-        INVARIANT(result, "expected successful query compilation or exception, but got nothing");
-        nodeEngine->registerCompiledQueryPlan(plan.getQueryId(), std::move(result));
+        optimizeCompileAndRegister(
+            plan,
+            *optimizer,
+            *compiler,
+            *listener,
+            *sourceRateListener,
+            *admissionController,
+            *compilationMetrics,
+            *nodeEngine,
+            dumpMode,
+            memoryQuotaInBytes,
+            priority);
         return plan.getQueryId();
     }
     CPPTRACE_CATCH(...)
@@ -113,11 +279,194 @@ std::expected<QueryId, Exception> SingleNodeWorker::registerQuery(LogicalPlan pl
     std::unreachable();
 }
 
+std::expected<QueryId, Exception>
+SingleNodeWorker::registerMergedQueries(
+    const std::vector<LogicalPlan>& plans, const size_t memoryQuotaInBytes, const QueryPriority priority) noexcept
+{
+    CPPTRACE_TRY
+    {
+        PRECONDITION(not plans.empty(), "Expects at least one query plan to merge");
+        const auto queryId = generateQueryId();
+        const LogContext context("queryId", queryId);
+        const DumpMode dumpMode(
+            configuration.workerConfiguration.dumpQueryCompilationIR.getValue(), configuration.workerConfiguration.dumpGraph.getValue());
+        const auto queryPlan = optimizer->optimizeMerged(queryId, plans);
+        listener->onEvent(SubmitQuerySystemEvent{queryId, explain(queryPlan.getPlan(), ExplainVerbosity::Debug)});
+        compileAndRegister(
+            queryPlan,
+            *compiler,
+            *sourceRateListener,
+            *admissionController,
+            *compilationMetrics,
+            *nodeEngine,
+            dumpMode,
+            memoryQuotaInBytes,
+            priority);
+        return queryId;
+    }
+    CPPTRACE_CATCH(...)
+    {
+        return std::unexpected(wrapExternalException());
+    }
+    std::unreachable();
+}
+
+std::expected<std::vector<QueryId>, Exception>
+SingleNodeWorker::registerQueries(std::vector<LogicalPlan> plans, const size_t memoryQuotaInBytes, const QueryPriority priority) noexcept
+{
+    CPPTRACE_TRY
+    {
+        const DumpMode dumpMode(
+            configuration.workerConfiguration.dumpQueryCompilationIR.getValue(), configuration.workerConfiguration.dumpGraph.getValue());
+        /// The registrations may access the worker, as the worker is not moved before this function waited for all of them.
+        /// Each registration owns its plan, and the function waits for the submitted registrations even if a later submission fails.
+        std::vector<QueryId> queryIds;
+        std::vector<std::future<void>> registrations;
+        queryIds.reserve(plans.size());
+        registrations.reserve(plans.size());
+        std::optional<Exception> error;
+        try
+        {
+            for (auto& plan : plans)
+            {
+                assignQueryId(plan);
+                queryIds.push_back(plan.getQueryId());
+                auto registration = std::make_shared<std::packaged_task<void()>>(
+                    [this, plan = std::move(plan), dumpMode, memoryQuotaInBytes, priority]
+                    {
+                        const LogContext context("queryId", plan.getQueryId());
+                        optimizeCompileAndRegister(
+                            plan,
+                            *optimizer,
+                            *compiler,
+                            *listener,
+                            *sourceRateListener,
+                            *admissionController,
+                            *compilationMetrics,
+                            *nodeEngine,
+                            dumpMode,
+                            memoryQuotaInBytes,
+                            priority);
+                    });
+                registrations.push_back(registration->get_future());
+                /// The calling thread registers the plans that exceed the pending registrations of the registration threads
+                if (not registrationThreadPool->submit([registration] { (*registration)(); }))
+                {
+                    (*registration)();
+                }
+            }
+        }
+        catch (...)
+        {
+            error = wrapExternalException();
+        }
+
+        std::vector<QueryId> registeredQueries;
+        for (auto&& [queryId, registration] : std::views::zip(queryIds, registrations))
+        {
+            try
+            {
+                registration.get();
+                registeredQueries.push_back(queryId);
+            }
+            catch (...)
+            {
+                if (not error.has_value())
+                {
+                    error = wrapExternalException();
+                }
+            }
+        }
+        if (error.has_value())
+        {
+            for (const auto queryId : registeredQueries)
+            {
+                std::ignore = unregisterQuery(queryId);
+            }
+            return std::unexpected(std::move(error.value()));
+        }
+        return registeredQueries;
+    }
+    CPPTRACE_CATCH(...)
+    {
+        return std::unexpected(wrapExternalException());
+    }
+    std::unreachable();
+}
+
+std::expected<QueryId, Exception>
+SingleNodeWorker::registerQueryAsynchronously(LogicalPlan plan, const size_t memoryQuotaInBytes, const QueryPriority priority) noexcept
+{
+    CPPTRACE_TRY
+    {
+        assignQueryId(plan);
+        const auto queryId = plan.getQueryId();
+        const LogContext context("queryId", queryId);
+        const DumpMode dumpMode(
+            configuration.workerConfiguration.dumpQueryCompilationIR.getValue(), configuration.workerConfiguration.dumpGraph.getValue());
+        auto engine = copyPtr(nodeEngine);
+        const auto queryLog = engine->getQueryLog();
+        queryLog->logQueryStatusChange(queryId, QueryState::Compiling, std::chrono::system_clock::now());
+
+        /// The registration must not access the worker, as the worker may be moved before the registration finished
+        const auto submitted = registrationThreadPool->submit(
+            [plan = std::move(plan),
+             optimizer = optimizer.get(),
+             compiler = compiler.get(),
+             listener = copyPtr(listener),
+             sourceRateListener = copyPtr(sourceRateListener),
+             admissionController = copyPtr(admissionController),
+             compilationMetrics = copyPtr(compilationMetrics),
+             engine,
+             dumpMode,
+             memoryQuotaInBytes,
+             priority]
+            {
+                const LogContext registrationContext("queryId", plan.getQueryId());
+                CPPTRACE_TRY
+                {
+                    optimizeCompileAndRegister(
+                        plan,
+                        *optimizer,
+                        *compiler,
+                        *listener,
+                        *sourceRateListener,
+                        *admissionController,
+                        *compilationMetrics,
+                        *engine,
+                        dumpMode,
+                        memoryQuotaInBytes,
+                        priority);
+                }
+                CPPTRACE_CATCH(...)
+                {
+                    auto exception = wrapExternalException();
+                    NES_ERROR("Asynchronous registration of query {} failed: {}", plan.getQueryId(), exception.what());
+                    engine->getQueryLog()->logQueryFailure(plan.getQueryId(), std::move(exception), std::chrono::system_clock::now());
+                }
+            });
+        if (not submitted)
+        {
+            auto exception = QueryRegistrationFailed(
+                "Query {} was rejected, as {} registrations are pending", queryId, configuration.maxPendingQueryRegistrations.getValue());
+            queryLog->logQueryFailure(queryId, exception, std::chrono::system_clock::now());
+            return std::unexpected(std::move(exception));
+        }
+        return queryId;
+    }
+    CPPTRACE_CATCH(...)
+    {
+        return std::unexpected(wrapExternalException());
+    }
+    std::unreachable();
+}
+
 std::expected<void, Exception> SingleNodeWorker::startQuery(QueryId queryId) noexcept
 {
     CPPTRACE_TRY
     {
         PRECONDITION(queryId != INVALID_QUERY_ID, "QueryId must be not invalid!");
+        throwIfCompiling(*nodeEngine, queryId);
         nodeEngine->startQuery(queryId);
         return {};
     }
@@ -128,11 +477,28 @@ std::expected<void, Exception> SingleNodeWorker::startQuery(QueryId queryId) noe
     std::unreachable();
 }
 
+std::expected<void, Exception> SingleNodeWorker::startQueries(const std::vector<QueryId>& queryIds) noexcept
+{
+    for (auto queryId = queryIds.begin(); queryId != queryIds.end(); ++queryId)
+    {
+        if (auto started = startQuery(*queryId); not started.has_value())
+        {
+            for (const auto startedQuery : std::ranges::subrange(queryIds.begin(), queryId))
+            {
+                std::ignore = stopQuery(startedQuery, QueryTerminationType::HardStop);
+            }
+            return started;
+        }
+    }
+    return {};
+}
+
 std::expected<void, Exception> SingleNodeWorker::stopQuery(QueryId queryId, QueryTerminationType type) noexcept
 {
     CPPTRACE_TRY
     {
         PRECONDITION(queryId != INVALID_QUERY_ID, "QueryId must be not invalid!");
+        throwIfCompiling(*nodeEngine, queryId);
         nodeEngine->stopQuery(queryId, type);
         return {};
     }
@@ -143,12 +509,31 @@ std::expected<void, Exception> SingleNodeWorker::stopQuery(QueryId queryId, Quer
     std::unreachable();
 }
 
+std::expected<void, Exception>
+SingleNodeWorker::setWorkerThreadLimits(const size_t minimumActiveWorkerThreads, const size_t maximumActiveWorkerThreads) noexcept
+{
+    CPPTRACE_TRY
+    {
+        nodeEngine->setWorkerThreadLimits(minimumActiveWorkerThreads, maximumActiveWorkerThreads);
+        return {};
+    }
+    CPPTRACE_CATCH(...)
+    {
+        return std::unexpected{wrapExternalException()};
+    }
+    std::unreachable();
+}
+
 std::expected<void, Exception> SingleNodeWorker::unregisterQuery(QueryId queryId) noexcept
 {
     CPPTRACE_TRY
     {
         PRECONDITION(queryId != INVALID_QUERY_ID, "QueryId must be not invalid!");
+        throwIfCompiling(*nodeEngine, queryId);
         nodeEngine->unregisterQuery(queryId);
+        sourceRateListener->unregisterQuery(queryId);
+        pipelineMetricsListener->unregisterQuery(queryId);
+        admissionController->release(queryId);
         return {};
     }
     CPPTRACE_CATCH(...)
@@ -187,6 +572,7 @@ WorkerStatus SingleNodeWorker::getWorkerStatus(std::chrono::system_clock::time_p
     {
         switch (state)
         {
+            case QueryState::Compiling:
             case QueryState::Registered:
                 /// Ignore these for the worker status
                 break;
@@ -227,9 +613,57 @@ WorkerStatus SingleNodeWorker::getWorkerStatus(std::chrono::system_clock::time_p
     return status;
 }
 
+std::expected<std::vector<PipelineMetrics>, Exception> SingleNodeWorker::getQueryMetrics(QueryId queryId) const noexcept
+{
+    CPPTRACE_TRY
+    {
+        auto metrics = pipelineMetricsListener->getMetrics(queryId);
+        if (not metrics.has_value())
+        {
+            return std::unexpected{QueryNotFound("{}", queryId)};
+        }
+        return std::move(metrics).value();
+    }
+    CPPTRACE_CATCH(...)
+    {
+        return std::unexpected(wrapExternalException());
+    }
+    std::unreachable();
+}
+
+size_t SingleNodeWorker::getNumberOfBuffersInUse() const
+{
+    const auto bufferManager = nodeEngine->getBufferManager();
+    return bufferManager->getNumOfPooledBuffers() - bufferManager->getNumberOfAvailableBuffers();
+}
+
+size_t SingleNodeWorker::getNumberOfPooledBuffers() const
+{
+    return nodeEngine->getBufferManager()->getNumOfPooledBuffers();
+}
+
+std::optional<std::vector<BufferOwnership::Usage>> SingleNodeWorker::getBufferUsage() const
+{
+    if (not BufferOwnership::isEnabled())
+    {
+        return std::nullopt;
+    }
+    return BufferOwnership::getUsage();
+}
+
+std::shared_ptr<ResultStream> SingleNodeWorker::subscribeResults(const std::string& streamName) const
+{
+    return ResultStream::get(streamName);
+}
+
 std::optional<QueryLog::Log> SingleNodeWorker::getQueryLog(QueryId queryId) const
 {
     return nodeEngine->getQueryLog()->getLogForQuery(queryId);
 }
 
+std::shared_ptr<QueryLogSubscription> SingleNodeWorker::watchQueries(const size_t maxQueuedEvents)
+{
+    return nodeEngine->getQueryLog()->subscribe(maxQueuedEvents);
+}
+
 }
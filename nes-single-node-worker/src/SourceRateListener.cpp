@@ -0,0 +1,186 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <SourceRateListener.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <Identifiers/Identifiers.hpp>
+#include <Listeners/SystemEventListener.hpp>
+#include <Sources/ColumnStatistics.hpp>
+#include <ColumnStatisticsCollector.hpp>
+#include <CompiledQueryPlan.hpp>
+#include <QueryEngineStatisticListener.hpp>
+
+namespace NES
+{
+
+SourceRateListener::SourceRateListener(std::shared_ptr<const ColumnStatisticsCollector> columnStatistics)
+    : columnStatistics(std::move(columnStatistics))
+{
+}
+
+void SourceRateListener::ObservedRate::observe(const uint64_t numberOfTuples, const int64_t timestampInNs)
+{
+    this->numberOfTuples.fetch_add(numberOfTuples, std::memory_order_relaxed);
+    int64_t expectedFirstTimestamp = 0;
+    firstTimestampInNs.compare_exchange_strong(expectedFirstTimestamp, timestampInNs, std::memory_order_relaxed);
+    auto lastTimestamp = lastTimestampInNs.load(std::memory_order_relaxed);
+    while (lastTimestamp < timestampInNs
+           and not lastTimestampInNs.compare_exchange_weak(lastTimestamp, timestampInNs, std::memory_order_relaxed))
+    {
+    }
+}
+
+std::optional<double> SourceRateListener::ObservedRate::getTuplesPerSecond() const
+{
+    const auto firstTimestamp = firstTimestampInNs.load(std::memory_order_relaxed);
+    const auto duration = lastTimestampInNs.load(std::memory_order_relaxed) - firstTimestamp;
+    if (firstTimestamp == 0 or duration < MINIMUM_OBSERVATION_DURATION_IN_NS)
+    {
+        return std::nullopt;
+    }
+    return static_cast<double>(numberOfTuples.load(std::memory_order_relaxed)) * 1e9 / static_cast<double>(duration);
+}
+
+void SourceRateListener::registerQuery(const CompiledQueryPlan& plan)
+{
+    /// A pipeline that consumes the tuples of different logical sources does not tell us the rate of either of them
+    std::unordered_map<PipelineId, std::unordered_set<std::string>> logicalSourcesOfPipelines;
+    for (const auto& source : plan.sources)
+    {
+        for (const auto& successor : source.successors)
+        {
+            if (const auto pipeline = successor.lock())
+            {
+                logicalSourcesOfPipelines[pipeline->id].insert(source.descriptor.getLogicalSource().getLogicalSourceName());
+            }
+        }
+    }
+
+    ObservedPipelines pipelines;
+    for (const auto& [pipelineId, logicalSources] : logicalSourcesOfPipelines)
+    {
+        if (logicalSources.size() == 1)
+        {
+            pipelines.emplace(pipelineId, std::make_shared<ObservedRate>(*logicalSources.begin()));
+        }
+    }
+    observedQueries.wlock()->insert_or_assign(plan.queryId, std::move(pipelines));
+}
+
+void SourceRateListener::unregisterQuery(const QueryId queryId)
+{
+    ObservedPipelines pipelines;
+    {
+        auto queries = observedQueries.wlock();
+        const auto query = queries->find(queryId);
+        if (query == queries->end())
+        {
+            return;
+        }
+        pipelines = std::move(query->second);
+        queries->erase(query);
+    }
+
+    auto rates = ratesOfUnregisteredQueries.wlock();
+    for (const auto& observedRate : pipelines | std::views::values)
+    {
+        if (const auto tuplesPerSecond = getTuplesPerSecond(pipelines, observedRate->logicalSourceName))
+        {
+            (*rates)[observedRate->logicalSourceName] = *tuplesPerSecond;
+        }
+    }
+}
+
+void SourceRateListener::onEvent(Event event)
+{
+    if (const auto* taskExecutionStart = std::get_if<TaskExecutionStart>(&event))
+    {
+        const auto queries = observedQueries.rlock();
+        const auto query = queries->find(taskExecutionStart->queryId);
+        if (query == queries->end())
+        {
+            return;
+        }
+        if (const auto pipeline = query->second.find(taskExecutionStart->pipelineId); pipeline != query->second.end())
+        {
+            const auto timestampInNs
+                = std::chrono::duration_cast<std::chrono::nanoseconds>(taskExecutionStart->timestamp.time_since_epoch()).count();
+            pipeline->second->observe(taskExecutionStart->numberOfTuples, timestampInNs);
+        }
+    }
+}
+
+void SourceRateListener::onEvent(SystemEvent)
+{
+}
+
+std::optional<double> SourceRateListener::getTuplesPerSecond(const ObservedPipelines& pipelines, const std::string& logicalSourceName)
+{
+    std::optional<double> tuplesPerSecond;
+    for (const auto& observedRate : pipelines | std::views::values)
+    {
+        if (observedRate->logicalSourceName == logicalSourceName)
+        {
+            if (const auto pipelineTuplesPerSecond = observedRate->getTuplesPerSecond())
+            {
+                tuplesPerSecond = tuplesPerSecond.value_or(0) + *pipelineTuplesPerSecond;
+            }
+        }
+    }
+    return tuplesPerSecond;
+}
+
+std::optional<double> SourceRateListener::getTuplesPerSecond(const std::string& logicalSourceName) const
+{
+    std::optional<double> highestTuplesPerSecond;
+    for (const auto& pipelines : *observedQueries.rlock() | std::views::values)
+    {
+        if (const auto tuplesPerSecond = getTuplesPerSecond(pipelines, logicalSourceName))
+        {
+            highestTuplesPerSecond = std::max(highestTuplesPerSecond.value_or(0), *tuplesPerSecond);
+        }
+    }
+    if (highestTuplesPerSecond.has_value())
+    {
+        return highestTuplesPerSecond;
+    }
+    const auto rates = ratesOfUnregisteredQueries.rlock();
+    if (const auto rate = rates->find(logicalSourceName); rate != rates->end())
+    {
+        return rate->second;
+    }
+    return std::nullopt;
+}
+
+std::optional<ColumnStatistics> SourceRateListener::getColumnStatistics(const std::string& fieldName) const
+{
+    if (not columnStatistics)
+    {
+        return std::nullopt;
+    }
+    return columnStatistics->getColumnStatistics(fieldName);
+}
+
+}
@@ -0,0 +1,234 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <WorkerMetrics.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <Runtime/BufferOwnership.hpp>
+#include <Runtime/NodeEngine.hpp>
+#include <fmt/format.h>
+#include <BackpressureChannel.hpp>
+#include <QueryEngine.hpp>
+
+namespace NES
+{
+
+namespace
+{
+double toSeconds(const std::chrono::nanoseconds duration)
+{
+    return std::chrono::duration<double>(duration).count();
+}
+
+/// Appends the metadata of a metric family. Families with a unit have to carry the unit as the suffix of their name.
+void appendFamily(
+    std::string& output, const std::string_view name, const std::string_view type, const std::string_view unit, const std::string_view help)
+{
+    auto out = std::back_inserter(output);
+    fmt::format_to(out, "# TYPE {} {}\n", name, type);
+    if (not unit.empty())
+    {
+        fmt::format_to(out, "# UNIT {} {}\n", name, unit);
+    }
+    fmt::format_to(out, "# HELP {} {}\n", name, help);
+}
+
+template <typename Value>
+void appendGauge(
+    std::string& output, const std::string_view name, const std::string_view unit, const std::string_view help, const Value value)
+{
+    appendFamily(output, name, "gauge", unit, help);
+    fmt::format_to(std::back_inserter(output), "{} {}\n", name, value);
+}
+
+template <typename Value>
+void appendCounter(
+    std::string& output, const std::string_view name, const std::string_view unit, const std::string_view help, const Value value)
+{
+    appendFamily(output, name, "counter", unit, help);
+    fmt::format_to(std::back_inserter(output), "{}_total {}\n", name, value);
+}
+}
+
+void CompilationMetrics::recordCompilation(const std::chrono::nanoseconds duration)
+{
+    compilationTimeInNs.fetch_add(duration.count(), std::memory_order::relaxed);
+    numberOfCompilations.fetch_add(1, std::memory_order::relaxed);
+}
+
+std::string renderOpenMetrics(NodeEngine& nodeEngine, const CompilationMetrics& compilationMetrics)
+{
+    std::string output;
+    const auto engineStatistics = nodeEngine.getQueryEngineStatistics();
+    appendGauge(
+        output,
+        "nes_task_queue_internal_tasks",
+        "",
+        "Tasks that wait in the internal task queue and the local queues of the WorkerThreads.",
+        engineStatistics.numberOfInternalTasks);
+    appendGauge(
+        output,
+        "nes_task_queue_admission_tasks",
+        "",
+        "Tasks that wait in the bounded admission queue, which backpressures the sources once it is full.",
+        engineStatistics.numberOfAdmissionTasks);
+    appendGauge(
+        output,
+        "nes_task_queue_admission_capacity",
+        "",
+        "Capacity of the admission queue.",
+        engineStatistics.admissionQueueCapacity);
+    appendGauge(
+        output,
+        "nes_worker_threads_active",
+        "",
+        "WorkerThreads that take tasks. The others are parked until the load increases.",
+        engineStatistics.numberOfActiveWorkerThreads);
+    appendCounter(
+        output,
+        "nes_shed_buffers",
+        "",
+        "Input buffers that the sources dropped, because the tasks waited too long in the task queue.",
+        engineStatistics.numberOfShedBuffers);
+    appendCounter(
+        output,
+        "nes_shed_tuples",
+        "",
+        "Tuples of the dropped input buffers. For raw input buffers, which the sources emit before parsing, the number of bytes.",
+        engineStatistics.numberOfShedTuples);
+
+    appendFamily(output, "nes_worker_thread_busy_seconds", "counter", "seconds", "Time that a WorkerThread spent executing tasks.");
+    for (size_t thread = 0; thread < engineStatistics.busyTimePerWorkerThread.size(); ++thread)
+    {
+        fmt::format_to(
+            std::back_inserter(output),
+            "nes_worker_thread_busy_seconds_total{{thread=\"{}\"}} {}\n",
+            thread,
+            toSeconds(engineStatistics.busyTimePerWorkerThread[thread]));
+    }
+
+    appendFamily(
+        output, "nes_query_cpu_seconds", "counter", "seconds", "Time that the WorkerThreads spent executing the tasks of a query.");
+    for (const auto& query : engineStatistics.cpuTimePerQuery)
+    {
+        fmt::format_to(
+            std::back_inserter(output), "nes_query_cpu_seconds_total{{query=\"{}\"}} {}\n", query.queryId, toSeconds(query.cpuTime));
+    }
+    appendFamily(
+        output,
+        "nes_query_cpu_throttled_periods",
+        "counter",
+        "",
+        "Periods of the cpu quota, in which a query exceeded its share of the cpu time and yielded the admission queue to other queries.");
+    for (const auto& query : engineStatistics.cpuTimePerQuery)
+    {
+        fmt::format_to(
+            std::back_inserter(output),
+            "nes_query_cpu_throttled_periods_total{{query=\"{}\"}} {}\n",
+            query.queryId,
+            query.numberOfThrottledPeriods);
+    }
+
+    appendFamily(
+        output,
+        "nes_source_inflight_buffer_limit",
+        "gauge",
+        "",
+        "Buffers that a running source may have inflight, which adapts to the query if adaptive_inflight_buffers is set.");
+    for (const auto& source : engineStatistics.inflightBuffersPerSource)
+    {
+        fmt::format_to(
+            std::back_inserter(output),
+            "nes_source_inflight_buffer_limit{{query=\"{}\",source=\"{}\"}} {}\n",
+            source.queryId,
+            source.sourceId,
+            source.limit);
+    }
+    appendFamily(output, "nes_source_inflight_buffers", "gauge", "", "Buffers of a running source that the query did not release yet.");
+    for (const auto& source : engineStatistics.inflightBuffersPerSource)
+    {
+        fmt::format_to(
+            std::back_inserter(output),
+            "nes_source_inflight_buffers{{query=\"{}\",source=\"{}\"}} {}\n",
+            source.queryId,
+            source.sourceId,
+            source.numberOfInflightBuffers);
+    }
+
+    const auto bufferManager = nodeEngine.getBufferManager();
+    appendGauge(output, "nes_pooled_buffers", "", "Pooled buffers of the BufferManager.", bufferManager->getNumOfPooledBuffers());
+    appendGauge(
+        output,
+        "nes_pooled_buffers_available",
+        "",
+        "Pooled buffers that are available, including the buffers in the thread-local caches.",
+        bufferManager->getNumberOfAvailableBuffers());
+    appendGauge(
+        output,
+        "nes_unpooled_bytes",
+        "bytes",
+        "Bytes of the memory chunks that back unpooled buffers.",
+        bufferManager->getNumberOfUnpooledBytes());
+    if (BufferOwnership::isEnabled())
+    {
+        /// Owners without a query are the sources and all other threads outside of the WorkerThreads
+        const auto usage = BufferOwnership::getUsage();
+        appendFamily(
+            output, "nes_held_buffers", "gauge", "", "Pooled and unpooled buffers held by the query and pipeline that acquired them.");
+        for (const auto& ownerUsage : usage)
+        {
+            fmt::format_to(
+                std::back_inserter(output),
+                "nes_held_buffers{{query=\"{}\",pipeline=\"{}\"}} {}\n",
+                ownerUsage.owner.queryId,
+                ownerUsage.owner.pipelineId,
+                ownerUsage.numberOfBuffers);
+        }
+        appendFamily(
+            output, "nes_held_bytes", "gauge", "bytes", "Bytes of the buffers held by the query and pipeline that acquired them.");
+        for (const auto& ownerUsage : usage)
+        {
+            fmt::format_to(
+                std::back_inserter(output),
+                "nes_held_bytes{{query=\"{}\",pipeline=\"{}\"}} {}\n",
+                ownerUsage.owner.queryId,
+                ownerUsage.owner.pipelineId,
+                ownerUsage.numberOfBytes);
+        }
+    }
+
+    appendCounter(
+        output,
+        "nes_source_backpressure_seconds",
+        "seconds",
+        "Time during which backpressure stalled sources, summed up over the backpressure channels of all queries.",
+        toSeconds(getTotalBackpressureTime()));
+
+    appendFamily(
+        output, "nes_query_compilation_seconds", "summary", "seconds", "Time that the worker spent compiling registered queries.");
+    fmt::format_to(
+        std::back_inserter(output),
+        "nes_query_compilation_seconds_count {}\nnes_query_compilation_seconds_sum {}\n",
+        compilationMetrics.getNumberOfCompilations(),
+        toSeconds(compilationMetrics.getTotalCompilationTime()));
+
+    output.append("# EOF\n");
+    return output;
+}
+
+}
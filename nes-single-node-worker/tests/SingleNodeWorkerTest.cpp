@@ -0,0 +1,229 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/DataTypeProvider.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Functions/ComparisonFunctions/GreaterLogicalFunction.hpp>
+#include <Functions/ConstantValueLogicalFunction.hpp>
+#include <Functions/FieldAccessLogicalFunction.hpp>
+#include <Functions/LogicalFunction.hpp>
+#include <Identifiers/Identifiers.hpp>
+#include <Operators/LogicalOperator.hpp>
+#include <Operators/Sinks/InlineSinkLogicalOperator.hpp>
+#include <Operators/Windows/Aggregations/SumAggregationLogicalFunction.hpp>
+#include <Operators/Windows/Aggregations/WindowAggregationLogicalFunction.hpp>
+#include <Plans/LogicalPlan.hpp>
+#include <Plans/LogicalPlanBuilder.hpp>
+#include <Runtime/Execution/QueryStatus.hpp>
+#include <Sinks/SinkCatalog.hpp>
+#include <Sources/SourceCatalog.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <WindowTypes/Measures/TimeCharacteristic.hpp>
+#include <WindowTypes/Measures/TimeMeasure.hpp>
+#include <WindowTypes/Types/TumblingWindow.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+#include <LegacyOptimizer.hpp>
+#include <SingleNodeWorker.hpp>
+#include <SingleNodeWorkerConfiguration.hpp>
+
+namespace NES
+{
+namespace
+{
+
+class SingleNodeWorkerTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("SingleNodeWorkerTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup SingleNodeWorkerTest test class.");
+    }
+
+    void SetUp() override
+    {
+        BaseUnitTest::SetUp();
+        schema.addField("stream$id", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+        schema.addField("stream$value", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+        Schema sourceSchema;
+        sourceSchema.addField("id", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+        sourceSchema.addField("value", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+        const auto logicalSource = sourceCatalog->addLogicalSource("stream", sourceSchema);
+        ASSERT_TRUE(logicalSource.has_value());
+        const auto physicalSource
+            = sourceCatalog->addPhysicalSource(logicalSource.value(), "File", {{"file_path", "/dev/null"}}, {{"type", "CSV"}});
+        ASSERT_TRUE(physicalSource.has_value());
+        ASSERT_TRUE(sinkCatalog->addSinkDescriptor("sink", schema, "Void", {}).has_value());
+
+        /// A single pending registration lets the calling thread register most plans of a batch itself
+        configuration.queryRegistrationThreads.setValue(2);
+        configuration.maxPendingQueryRegistrations.setValue(1);
+    }
+
+    /// Returns a bound and inferred plan, as the frontend submits it
+    [[nodiscard]] LogicalPlan createSelectionPlan(const size_t threshold) const
+    {
+        const auto constant
+            = ConstantValueLogicalFunction(DataTypeProvider::provideDataType(DataType::Type::UINT64), std::to_string(threshold));
+        const auto field = LogicalFunction{FieldAccessLogicalFunction("stream$value")};
+        const auto selection = LogicalFunction{GreaterLogicalFunction(field, LogicalFunction{constant})};
+        const auto source = LogicalPlanBuilder::createLogicalPlan("stream");
+        return LegacyOptimizer{sourceCatalog, sinkCatalog}.optimize(
+            LogicalPlanBuilder::addSink("sink", LogicalPlanBuilder::addSelection(selection, source)));
+    }
+
+    /// Returns a plan whose inline sink the frontend did not bind, which the worker cannot lower
+    [[nodiscard]] LogicalPlan createInvalidPlan() const
+    {
+        const auto plan = createSelectionPlan(0);
+        const auto sink = plan.getRootOperators().at(0);
+        return plan.withRootOperators({LogicalOperator{InlineSinkLogicalOperator("Void", schema, {})}.withChildren(sink.getChildren())});
+    }
+
+    [[nodiscard]] std::vector<LogicalPlan> createSelectionPlans(const size_t numberOfPlans) const
+    {
+        return std::views::iota(0UZ, numberOfPlans) | std::views::transform([this](const size_t plan) { return createSelectionPlan(plan); })
+            | std::ranges::to<std::vector>();
+    }
+
+    Schema schema;
+    std::shared_ptr<SourceCatalog> sourceCatalog = std::make_shared<SourceCatalog>();
+    std::shared_ptr<SinkCatalog> sinkCatalog = std::make_shared<SinkCatalog>();
+    SingleNodeWorkerConfiguration configuration;
+};
+
+TEST_F(SingleNodeWorkerTest, RegistersTheQueriesOfABatchInTheOrderOfThePlans)
+{
+    SingleNodeWorker worker{configuration};
+    auto plans = createSelectionPlans(16);
+    plans.at(3).setQueryId(QueryId(1000));
+
+    const auto queryIds = worker.registerQueries(std::move(plans));
+
+    ASSERT_TRUE(queryIds.has_value());
+    ASSERT_EQ(queryIds->size(), 16);
+    EXPECT_EQ(queryIds->at(3), QueryId(1000));
+    EXPECT_EQ(std::unordered_set(queryIds->begin(), queryIds->end()).size(), queryIds->size());
+    for (const auto queryId : *queryIds)
+    {
+        const auto status = worker.getQueryStatus(queryId);
+        ASSERT_TRUE(status.has_value());
+        EXPECT_EQ(status->state, QueryState::Registered);
+    }
+}
+
+TEST_F(SingleNodeWorkerTest, FailsTheBatchIfOneQueryIsInvalid)
+{
+    for (const size_t invalidPlan : {0UZ, 7UZ, 15UZ})
+    {
+        SingleNodeWorker worker{configuration};
+        auto plans = createSelectionPlans(16);
+        plans.at(invalidPlan) = createInvalidPlan();
+
+        const auto queryIds = worker.registerQueries(std::move(plans));
+
+        EXPECT_FALSE(queryIds.has_value()) << "Expected the batch with the invalid plan " << invalidPlan << " to fail";
+        /// The failed batch leaves the worker usable
+        const auto nextQueryIds = worker.registerQueries(createSelectionPlans(4));
+        ASSERT_TRUE(nextQueryIds.has_value());
+        EXPECT_EQ(nextQueryIds->size(), 4);
+    }
+}
+
+/// The state of a window is only released once the sources make progress. Thus, a query whose window state exceeds its memory quota must
+/// not throttle its sources forever, but run to completion.
+TEST_F(SingleNodeWorkerTest, WindowWithStateLargerThanTheMemoryQuotaTerminates)
+{
+    constexpr size_t numberOfKeys = 10000;
+    constexpr size_t numberOfWindows = 10;
+    constexpr size_t windowSizeInMs = 1000;
+    /// Each window holds more than 100 KiB of state for its keys
+    constexpr size_t memoryQuotaInBytes = 64 * 1024;
+
+    const auto inputFile = std::filesystem::temp_directory_path() / "SingleNodeWorkerTestWindowAtMemoryQuota.csv";
+    {
+        std::ofstream input(inputFile);
+        for (size_t record = 0; record < numberOfKeys * numberOfWindows; ++record)
+        {
+            input << record % numberOfKeys << ',' << (record / numberOfKeys) * windowSizeInMs << '\n';
+        }
+    }
+    Schema sourceSchema;
+    sourceSchema.addField("id", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+    sourceSchema.addField("ts", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+    const auto logicalSource = sourceCatalog->addLogicalSource("windowed", sourceSchema);
+    ASSERT_TRUE(logicalSource.has_value());
+    const auto physicalSource
+        = sourceCatalog->addPhysicalSource(logicalSource.value(), "File", {{"file_path", inputFile.string()}}, {{"type", "CSV"}});
+    ASSERT_TRUE(physicalSource.has_value());
+    Schema windowSchema;
+    windowSchema.addField("windowed$START", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+    windowSchema.addField("windowed$END", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+    windowSchema.addField("windowed$id", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+    windowSchema.addField("windowed$ts", DataTypeProvider::provideDataType(DataType::Type::UINT64));
+    ASSERT_TRUE(sinkCatalog->addSinkDescriptor("windowSink", windowSchema, "Void", {}).has_value());
+
+    const auto window = std::make_shared<Windowing::TumblingWindow>(
+        Windowing::TimeCharacteristic::createEventTime(FieldAccessLogicalFunction("windowed$ts")), Windowing::TimeMeasure(windowSizeInMs));
+    const auto plan = LegacyOptimizer{sourceCatalog, sinkCatalog}.optimize(LogicalPlanBuilder::addSink(
+        "windowSink",
+        LogicalPlanBuilder::addWindowAggregation(
+            LogicalPlanBuilder::createLogicalPlan("windowed"),
+            window,
+            {std::make_shared<SumAggregationLogicalFunction>(FieldAccessLogicalFunction("windowed$ts"))},
+            {FieldAccessLogicalFunction("windowed$id")})));
+
+    SingleNodeWorker worker{configuration};
+    const auto queryId = worker.registerQuery(plan, memoryQuotaInBytes);
+    ASSERT_TRUE(queryId.has_value());
+    ASSERT_TRUE(worker.startQuery(queryId.value()).has_value());
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+    auto status = worker.getQueryStatus(queryId.value());
+    while (status.has_value() and status->state != QueryState::Stopped and status->state != QueryState::Failed
+           and std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        status = worker.getQueryStatus(queryId.value());
+    }
+    std::filesystem::remove(inputFile);
+    ASSERT_TRUE(status.has_value());
+    EXPECT_EQ(status->state, QueryState::Stopped);
+}
+
+TEST_F(SingleNodeWorkerTest, RegistersAnEmptyBatch)
+{
+    SingleNodeWorker worker{configuration};
+    const auto queryIds = worker.registerQueries({});
+    ASSERT_TRUE(queryIds.has_value());
+    EXPECT_TRUE(queryIds->empty());
+}
+
+}
+}
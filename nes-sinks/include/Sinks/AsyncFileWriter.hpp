@@ -0,0 +1,116 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <sys/uio.h>
+
+#include <folly/MPMCQueue.h>
+
+#include <BackpressureChannel.hpp>
+#include <Thread.hpp>
+
+namespace NES
+{
+
+/// Writes the formatted buffers of a sink to a file on a dedicated writer thread.
+/// Worker threads hand their formatted buffers to a bounded lock-free queue and return, instead of serializing on the file and paying
+/// for a syscall per buffer. The writer thread collects the buffers that arrive within the flush interval (or until the batch is full)
+/// and writes them with a single `writev`. If the writer thread falls behind, i.e., more than half of the queue is occupied, the writer
+/// applies backpressure to the sources of the query, until the writer thread drained the queue to a quarter. Worker threads only block on
+/// the full queue, if the buffers that are in flight during the backpressure exceed the rest of the queue.
+/// With direct I/O, the writer thread opens the file with O_DIRECT and copies the buffers into an aligned staging buffer, of which it
+/// only writes full blocks. It writes the remaining tail without O_DIRECT when it closes the file.
+class AsyncFileWriter
+{
+public:
+    /// The backpressure controller of the sink must outlive the writer.
+    AsyncFileWriter(
+        const std::string& filePath,
+        std::chrono::milliseconds flushInterval,
+        bool directIO,
+        BackpressureController& backpressureController);
+    ~AsyncFileWriter();
+
+    AsyncFileWriter(const AsyncFileWriter&) = delete;
+    AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+    AsyncFileWriter(AsyncFileWriter&&) = delete;
+    AsyncFileWriter& operator=(AsyncFileWriter&&) = delete;
+
+    /// Appends the bytes to the file. Throws, if the writer thread failed to write prior bytes.
+    void write(std::string bytes);
+
+    /// Writes all pending bytes and closes the file. Throws, if the writer thread failed to write any of the bytes.
+    void close();
+
+    /// Size of the file when it was opened.
+    [[nodiscard]] size_t getInitialFileSize() const { return initialFileSize; }
+
+private:
+    static constexpr size_t QUEUE_CAPACITY = 1024;
+    static constexpr size_t BACKPRESSURE_THRESHOLD = QUEUE_CAPACITY / 2;
+    static constexpr size_t MAX_BATCH_BUFFERS = 512;
+    static constexpr size_t MAX_BATCH_BYTES = 4 * 1024 * 1024;
+    static constexpr size_t DIRECT_IO_ALIGNMENT = 4096;
+
+    struct FreeAligned
+    {
+        void operator()(char* buffer) const;
+    };
+
+    void run();
+    void writeBatch(std::vector<std::string>& batch);
+    void writeFully(std::vector<iovec>& ranges) const;
+    void writeDirect(const std::vector<std::string>& batch);
+    void writeDirectTail();
+    /// Applies backpressure above the threshold of queued buffers, and releases it once the queued buffers fell to half of the threshold
+    void updateBackpressure();
+
+    std::string filePath;
+    std::chrono::milliseconds flushInterval;
+    bool directIO;
+    int fileDescriptor = -1;
+    size_t initialFileSize = 0;
+
+    /// Only accessed by the writer thread (and by the constructor, before it starts the writer thread)
+    std::unique_ptr<char, FreeAligned> stagingBuffer;
+    size_t stagedBytes = 0;
+    size_t fileOffset = 0;
+
+    /// An empty optional signals the writer thread that no further bytes follow
+    folly::MPMCQueue<std::optional<std::string>> queue{QUEUE_CAPACITY};
+    std::atomic<size_t> queuedBuffers{0};
+    BackpressureController& backpressureController;
+    std::mutex backpressureMutex;
+    /// Only written under the backpressure mutex, but read without it to keep the mutex off the path of every buffer
+    std::atomic<bool> appliesBackpressure{false};
+    /// Set by the writer thread, before it sets 'failed'
+    std::exception_ptr writeError;
+    std::atomic<bool> failed{false};
+    bool isClosed = false;
+    Thread writerThread;
+};
+
+}
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <fstream>
 #include <memory>
 #include <optional>
@@ -26,6 +28,8 @@
 
 #include <Configurations/Descriptor.hpp>
 #include <Runtime/TupleBuffer.hpp>
+#include <Sinks/AsyncFileWriter.hpp>
+#include <Sinks/FrameCompressor.hpp>
 #include <Sinks/Sink.hpp>
 #include <Sinks/SinkDescriptor.hpp>
 #include <SinksParsing/CSVFormat.hpp>
@@ -35,6 +39,9 @@
 namespace NES
 {
 /// A sink that writes formatted TupleBuffers to arbitrary files.
+/// By default, worker threads write (and flush) their buffers to the file themselves. In async mode, they hand their buffers to an
+/// AsyncFileWriter, which batches the writes on a dedicated writer thread.
+/// With compression, every worker thread compresses its formatted buffer into a frame of its own, so the file is a sequence of frames.
 class FileSink final : public Sink
 {
 public:
@@ -58,11 +65,20 @@ protected:
 
 
 private:
+    /// Returns the bytes to write for formatted output, i.e., a compressed frame if the sink compresses its output
+    [[nodiscard]] std::string toFileBytes(std::string formatted) const;
+
     std::string outputFilePath;
     bool isAppend;
+    bool isAsync;
+    std::chrono::milliseconds flushInterval;
+    bool isDirectIO;
+    bool isCompiledFormat;
+    FrameCompressor compressor;
     bool isOpen;
     std::unique_ptr<Format> formatter;
     folly::Synchronized<std::ofstream> outputFileStream;
+    std::unique_ptr<AsyncFileWriter> asyncWriter;
 };
 
 struct ConfigParametersFile
@@ -72,8 +88,47 @@ struct ConfigParametersFile
         false,
         [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(APPEND, config); }};
 
+    /// Writes the buffers on a dedicated writer thread (see AsyncFileWriter)
+    static inline const DescriptorConfig::ConfigParameter<bool> ASYNC{
+        "async",
+        false,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(ASYNC, config); }};
+
+    /// How long the writer thread collects buffers into a batch before it writes them (async mode only)
+    static inline const DescriptorConfig::ConfigParameter<uint32_t> FLUSH_INTERVAL_MS{
+        "flush_interval_ms",
+        10,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(FLUSH_INTERVAL_MS, config); }};
+
+    /// Bypasses the page cache with O_DIRECT, writing aligned blocks (async mode only)
+    static inline const DescriptorConfig::ConfigParameter<bool> DIRECT_IO{
+        "direct_io",
+        false,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(DIRECT_IO, config); }};
+
+    /// Compresses the output into a sequence of zstd or lz4 frames, one per formatted buffer
+    static inline const DescriptorConfig::ConfigParameter<EnumWrapper, SinkCompression> COMPRESSION{
+        "compression",
+        EnumWrapper{SinkCompression::NONE},
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(COMPRESSION, config); }};
+
+    /// The compression level of the codec, where 0 selects its default level
+    static inline const DescriptorConfig::ConfigParameter<int32_t> COMPRESSION_LEVEL{
+        "compression_level",
+        0,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(COMPRESSION_LEVEL, config); }};
+
     static inline std::unordered_map<std::string, DescriptorConfig::ConfigParameterContainer> parameterMap
-        = DescriptorConfig::createConfigParameterContainerMap(SinkDescriptor::parameterMap, SinkDescriptor::FILE_PATH, APPEND);
+        = DescriptorConfig::createConfigParameterContainerMap(
+            SinkDescriptor::parameterMap,
+            SinkDescriptor::FILE_PATH,
+            SinkDescriptor::COMPILED_FORMAT,
+            APPEND,
+            ASYNC,
+            FLUSH_INTERVAL_MS,
+            DIRECT_IO,
+            COMPRESSION,
+            COMPRESSION_LEVEL);
 };
 
 }
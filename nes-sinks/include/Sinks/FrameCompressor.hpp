@@ -0,0 +1,53 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace NES
+{
+
+enum class SinkCompression : uint8_t
+{
+    NONE,
+    ZSTD,
+    LZ4
+};
+
+/// Compresses the formatted output of a sink block by block, turning every block into a self-contained frame.
+/// Thus, worker threads compress their blocks independently and the sink only concatenates the frames, since the concatenation of zstd
+/// (or lz4) frames is a valid zstd (or lz4) stream, e.g., for `zstd -d` and `lz4 -d`.
+class FrameCompressor
+{
+public:
+    /// A compression level of 0 selects the default level of the codec
+    FrameCompressor(SinkCompression compression, int32_t compressionLevel);
+
+    /// Replaces the content of 'frame' with a frame that contains the block
+    void compress(std::string_view block, std::string& frame) const;
+
+    [[nodiscard]] SinkCompression getCompression() const { return compression; }
+
+private:
+    void compressZstd(std::string_view block, std::string& frame) const;
+    void compressLz4(std::string_view block, std::string& frame) const;
+
+    SinkCompression compression;
+    int32_t compressionLevel;
+};
+
+}
@@ -0,0 +1,95 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <Configurations/Descriptor.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sinks/ResultStream.hpp>
+#include <Sinks/Sink.hpp>
+#include <Sinks/SinkDescriptor.hpp>
+#include <SinksParsing/NativeFormat.hpp>
+#include <BackpressureChannel.hpp>
+#include <PipelineExecutionContext.hpp>
+
+namespace NES
+{
+
+/// A sink that delivers its tuple buffers to the clients of the SubscribeResults rpc of the worker, instead of writing them to a file.
+/// The sink writes one frame in the native format per tuple buffer into the ResultStream of its stream_name. The worker sends the
+/// frames to the subscribers of the stream in batches. While the subscribers read less than max_queued_bytes behind, the sink applies
+/// backpressure to the sources of its query.
+class GrpcSink final : public Sink
+{
+public:
+    static constexpr std::string_view NAME = "Grpc";
+
+    explicit GrpcSink(BackpressureController backpressureController, const SinkDescriptor& sinkDescriptor);
+    /// Closes the stream if the sink was not stopped, e.g., because its query failed
+    ~GrpcSink() override;
+
+    GrpcSink(const GrpcSink&) = delete;
+    GrpcSink& operator=(const GrpcSink&) = delete;
+    GrpcSink(GrpcSink&&) = delete;
+    GrpcSink& operator=(GrpcSink&&) = delete;
+
+    void start(PipelineExecutionContext& pipelineExecutionContext) override;
+    void execute(const TupleBuffer& inputTupleBuffer, PipelineExecutionContext& pipelineExecutionContext) override;
+    void stop(PipelineExecutionContext& pipelineExecutionContext) override;
+
+    static DescriptorConfig::Config validateAndFormat(std::unordered_map<std::string, std::string> config);
+
+protected:
+    std::ostream& toString(std::ostream& str) const override;
+
+private:
+    std::string streamName;
+    uint64_t maxQueuedBytes;
+    NativeFormat format;
+    std::shared_ptr<ResultStream> stream;
+};
+
+struct ConfigParametersGrpc
+{
+    /// The name that clients subscribe to
+    static inline const DescriptorConfig::ConfigParameter<std::string> STREAM_NAME{
+        "stream_name",
+        std::nullopt,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(STREAM_NAME, config); }};
+
+    /// The number of bytes that the stream queues for slow subscribers before the sink applies backpressure
+    static inline const DescriptorConfig::ConfigParameter<uint64_t> MAX_QUEUED_BYTES{
+        "max_queued_bytes",
+        16 * 1024 * 1024,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(MAX_QUEUED_BYTES, config); }};
+
+    static inline std::unordered_map<std::string, DescriptorConfig::ConfigParameterContainer> parameterMap
+        = DescriptorConfig::createConfigParameterContainerMap(SinkDescriptor::parameterMap, STREAM_NAME, MAX_QUEUED_BYTES);
+};
+
+}
+
+namespace fmt
+{
+template <>
+struct formatter<NES::GrpcSink> : ostream_formatter
+{
+};
+}
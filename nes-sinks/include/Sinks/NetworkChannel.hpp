@@ -0,0 +1,137 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <folly/Synchronized.h>
+
+#include <Runtime/NativeFrameHeader.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Util/Logger/Formatter.hpp>
+#include <sys/uio.h>
+#include <BackpressureChannel.hpp>
+
+namespace NES
+{
+
+/// A connection to a NetworkSource of another worker, over which a sink sends tuple buffers, including their child buffers, as frames of
+/// the native format (see NativeFrameHeader). The channel passes the memory of the tuple buffers to sendmsg as is. With zero copy, the
+/// kernel reads them without copying them into the socket buffer (MSG_ZEROCOPY) and the channel keeps the tuple buffers alive until the
+/// kernel completed them. All methods are thread-safe.
+class NetworkChannel
+{
+public:
+    NetworkChannel(std::string host, uint32_t port, std::chrono::seconds connectTimeout, bool zeroCopy, size_t sizeOfTuple);
+    ~NetworkChannel();
+
+    NetworkChannel(const NetworkChannel&) = delete;
+    NetworkChannel& operator=(const NetworkChannel&) = delete;
+    NetworkChannel(NetworkChannel&&) = delete;
+    NetworkChannel& operator=(NetworkChannel&&) = delete;
+
+    /// Retries to connect until the connect timeout passed, as the NetworkSource of the receiving worker might start after the sink
+    void open();
+    void send(const TupleBuffer& buffer);
+    /// Releases the tuple buffers of the frames that the kernel completed. Returns the number of sent bytes that the receiver did not
+    /// acknowledge yet, i.e., the credits of the receiver that the channel used up.
+    uint64_t releaseCompletedFrames();
+    /// Waits (at most for the connect timeout) until the kernel completed all frames, and shuts the connection down, which ends the stream
+    /// of the NetworkSource
+    void close();
+
+    friend std::ostream& operator<<(std::ostream& os, const NetworkChannel& channel);
+
+private:
+    static constexpr std::chrono::milliseconds CONNECT_RETRY_INTERVAL{100};
+    static constexpr std::chrono::milliseconds CLOSE_POLL_INTERVAL{1};
+
+    /// A frame that was sent with MSG_ZEROCOPY. The kernel reads the header, the sizes of the child buffers, and the tuple buffers until it
+    /// reports the completion of the last sendmsg call of the frame.
+    struct InFlightFrame
+    {
+        NativeFrameHeader header;
+        std::vector<uint64_t> sizesOfChildBuffers;
+        std::vector<TupleBuffer> buffers;
+        /// Unset, while the frame is being sent
+        std::optional<uint32_t> lastZeroCopyId;
+    };
+
+    struct Connection
+    {
+        int socket = -1;
+        /// In the order of their sendmsg calls. The references of a deque stay valid, when we add or remove frames at its ends.
+        std::deque<InFlightFrame> inFlightFrames;
+        /// The kernel numbers the successful sendmsg calls with MSG_ZEROCOPY consecutively
+        uint32_t nextZeroCopyId = 0;
+        /// Disabled, if the kernel does not support MSG_ZEROCOPY for the socket
+        bool zeroCopy = false;
+    };
+
+    void connect(Connection& connection) const;
+    /// Sends all bytes of the iovecs. Returns the number of sendmsg calls that used MSG_ZEROCOPY.
+    uint32_t sendAll(int socket, bool zeroCopy, std::span<iovec> iovecs) const;
+    static void releaseCompletedFrames(Connection& connection);
+
+    std::string host;
+    uint32_t port;
+    std::chrono::seconds connectTimeout;
+    bool useZeroCopy;
+    size_t sizeOfTuple;
+    /// Serializes the sends. A send does not hold the lock of the connection while sendmsg blocks, so that the flow control can still
+    /// release completed frames and measure the used credits.
+    std::mutex sendMutex;
+    folly::Synchronized<Connection> connection;
+};
+
+/// Applies backpressure to the sources of a query, while the receiver of any channel of its sink did not acknowledge more than
+/// 'maxInFlightBytes', and releases it, once all of them used less than half of their credits. A background thread updates the flow
+/// control periodically, as the sources do not produce the buffers, which would update it, while they are under backpressure.
+class NetworkFlowControl
+{
+public:
+    NetworkFlowControl(BackpressureController& backpressureController, uint64_t maxInFlightBytes);
+
+    /// The channels must outlive the flow control, or at least its stop
+    void start(std::vector<NetworkChannel*> channels);
+    void update();
+    void stop();
+
+private:
+    static constexpr std::chrono::milliseconds UPDATE_INTERVAL{1};
+
+    void run(const std::stop_token& stopToken);
+
+    BackpressureController& backpressureController;
+    uint64_t maxInFlightBytes;
+    std::vector<NetworkChannel*> channels;
+    std::mutex backpressureMutex;
+    bool appliesBackpressure = false;
+    std::jthread updateThread;
+};
+
+}
+
+FMT_OSTREAM(NES::NetworkChannel);
@@ -0,0 +1,109 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <Configurations/Descriptor.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sinks/NetworkChannel.hpp>
+#include <Sinks/Sink.hpp>
+#include <Sinks/SinkDescriptor.hpp>
+#include <BackpressureChannel.hpp>
+#include <PipelineExecutionContext.hpp>
+
+namespace NES
+{
+
+/// A sink that sends its tuple buffers over a NetworkChannel to a NetworkSource of another worker, so that the workers exchange the
+/// buffers without formatting them as text. With zero_copy, the kernel reads the tuple buffers without copying them (MSG_ZEROCOPY).
+/// The receiver grants credits by acknowledging the bytes that it read. While more than max_in_flight_bytes are not acknowledged, the
+/// sink applies backpressure to the sources of its query (see NetworkFlowControl).
+class NetworkSink final : public Sink
+{
+public:
+    static constexpr std::string_view NAME = "Network";
+
+    explicit NetworkSink(BackpressureController backpressureController, const SinkDescriptor& sinkDescriptor);
+    ~NetworkSink() override = default;
+
+    NetworkSink(const NetworkSink&) = delete;
+    NetworkSink& operator=(const NetworkSink&) = delete;
+    NetworkSink(NetworkSink&&) = delete;
+    NetworkSink& operator=(NetworkSink&&) = delete;
+
+    void start(PipelineExecutionContext& pipelineExecutionContext) override;
+    void execute(const TupleBuffer& inputTupleBuffer, PipelineExecutionContext& pipelineExecutionContext) override;
+    void stop(PipelineExecutionContext& pipelineExecutionContext) override;
+
+    static DescriptorConfig::Config validateAndFormat(std::unordered_map<std::string, std::string> config);
+
+protected:
+    std::ostream& toString(std::ostream& str) const override;
+
+private:
+    NetworkChannel channel;
+    NetworkFlowControl flowControl;
+};
+
+struct ConfigParametersNetwork
+{
+    static inline const DescriptorConfig::ConfigParameter<std::string> HOST{
+        "socket_host",
+        std::nullopt,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(HOST, config); }};
+
+    static inline const DescriptorConfig::ConfigParameter<uint32_t> PORT{
+        "socket_port",
+        std::nullopt,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(PORT, config); }};
+
+    /// How long the sink retries to connect, as the NetworkSource of the receiving worker might start after the sink
+    static inline const DescriptorConfig::ConfigParameter<uint32_t> CONNECT_TIMEOUT{
+        "connect_timeout_seconds",
+        10,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(CONNECT_TIMEOUT, config); }};
+
+    /// Sends the tuple buffers with MSG_ZEROCOPY. Falls back to copying sends, if the kernel does not support it.
+    static inline const DescriptorConfig::ConfigParameter<bool> ZERO_COPY{
+        "zero_copy",
+        true,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(ZERO_COPY, config); }};
+
+    /// The credits of the receiver, i.e., the number of bytes that may be sent without being acknowledged before the sink applies
+    /// backpressure
+    static inline const DescriptorConfig::ConfigParameter<uint64_t> MAX_IN_FLIGHT_BYTES{
+        "max_in_flight_bytes",
+        1024 * 1024,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(MAX_IN_FLIGHT_BYTES, config); }};
+
+    static inline std::unordered_map<std::string, DescriptorConfig::ConfigParameterContainer> parameterMap
+        = DescriptorConfig::createConfigParameterContainerMap(
+            SinkDescriptor::parameterMap, HOST, PORT, CONNECT_TIMEOUT, ZERO_COPY, MAX_IN_FLIGHT_BYTES);
+};
+
+}
+
+namespace fmt
+{
+template <>
+struct formatter<NES::NetworkSink> : ostream_formatter
+{
+};
+}
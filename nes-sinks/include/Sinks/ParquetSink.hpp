@@ -0,0 +1,133 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <folly/Synchronized.h>
+
+#include <Configurations/Descriptor.hpp>
+#include <Configurations/Enums/EnumWrapper.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sinks/FrameCompressor.hpp>
+#include <Sinks/ParquetWriter.hpp>
+#include <Sinks/Sink.hpp>
+#include <Sinks/SinkDescriptor.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <BackpressureChannel.hpp>
+#include <PipelineExecutionContext.hpp>
+
+namespace NES
+{
+
+/// A sink that writes its input to a Parquet file.
+/// The sink reads columnar buffers (see SinkDescriptor::COLUMNAR_INPUT), which it appends column by column to the open row group of the
+/// worker thread. Worker threads share a few row groups, each behind a lock of its own. The worker thread that fills a row group encodes
+/// and compresses it without holding a lock, so that multiple row groups are compressed in parallel, and only serializes on appending the
+/// compressed row group to the file. The file is complete once the sink stopped, as Parquet stores the metadata at the end of the file.
+class ParquetSink final : public Sink
+{
+public:
+    static constexpr std::string_view NAME = "Parquet";
+    explicit ParquetSink(BackpressureController backpressureController, const SinkDescriptor& sinkDescriptor);
+    ~ParquetSink() override = default;
+
+    ParquetSink(const ParquetSink&) = delete;
+    ParquetSink& operator=(const ParquetSink&) = delete;
+    ParquetSink(ParquetSink&&) = delete;
+    ParquetSink& operator=(ParquetSink&&) = delete;
+
+    void start(PipelineExecutionContext& pipelineExecutionContext) override;
+    void execute(const TupleBuffer& inputTupleBuffer, PipelineExecutionContext& pipelineExecutionContext) override;
+    void stop(PipelineExecutionContext& pipelineExecutionContext) override;
+
+    static DescriptorConfig::Config validateAndFormat(std::unordered_map<std::string, std::string> config);
+
+protected:
+    std::ostream& toString(std::ostream& str) const override;
+
+private:
+    static constexpr size_t NUMBER_OF_OPEN_ROW_GROUPS = 8;
+
+    void writeRowGroup(const ParquetRowGroup& rowGroup);
+
+    std::string outputFilePath;
+    Schema schema;
+    bool isColumnar;
+    uint32_t rowGroupSize;
+    FrameCompressor compressor;
+    /// The worker threads pick the open row group by their id
+    std::vector<std::unique_ptr<folly::Synchronized<ParquetRowGroup>>> openRowGroups;
+    folly::Synchronized<std::optional<ParquetFileWriter>> fileWriter;
+};
+
+struct ConfigParametersParquet
+{
+    /// The well-known SinkDescriptor::COLUMNAR_INPUT, which the Parquet sink enables by default
+    static inline const DescriptorConfig::ConfigParameter<bool> COLUMNAR_INPUT{
+        "columnar_input",
+        true,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(COLUMNAR_INPUT, config); }};
+
+    /// The number of tuples of a row group. Larger row groups compress better, but every open row group keeps its tuples in memory.
+    static inline const DescriptorConfig::ConfigParameter<uint32_t> ROW_GROUP_SIZE{
+        "row_group_size",
+        128 * 1024,
+        [](const std::unordered_map<std::string, std::string>& config) -> std::optional<uint32_t>
+        {
+            const auto rowGroupSize = DescriptorConfig::tryGet(ROW_GROUP_SIZE, config);
+            if (rowGroupSize.has_value() and *rowGroupSize == 0)
+            {
+                NES_ERROR("ParquetSink: row_group_size must be at least 1");
+                return std::nullopt;
+            }
+            return rowGroupSize;
+        }};
+
+    /// Compresses every column chunk with zstd (lz4 frames are not a Parquet codec)
+    static inline const DescriptorConfig::ConfigParameter<EnumWrapper, SinkCompression> COMPRESSION{
+        "compression",
+        EnumWrapper{SinkCompression::ZSTD},
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(COMPRESSION, config); }};
+
+    /// The compression level of zstd, where 0 selects its default level
+    static inline const DescriptorConfig::ConfigParameter<int32_t> COMPRESSION_LEVEL{
+        "compression_level",
+        0,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(COMPRESSION_LEVEL, config); }};
+
+    static inline std::unordered_map<std::string, DescriptorConfig::ConfigParameterContainer> parameterMap
+        = DescriptorConfig::createConfigParameterContainerMap(
+            SinkDescriptor::FILE_PATH, COLUMNAR_INPUT, ROW_GROUP_SIZE, COMPRESSION, COMPRESSION_LEVEL);
+};
+
+}
+
+namespace fmt
+{
+template <>
+struct formatter<NES::ParquetSink> : ostream_formatter
+{
+};
+}
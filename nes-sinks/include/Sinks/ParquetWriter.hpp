@@ -0,0 +1,130 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Runtime/ColumnarLayout.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sinks/FrameCompressor.hpp>
+
+namespace NES
+{
+
+/// Accumulates the tuples of tuple buffers column by column into a row group of a Parquet file.
+/// Every column keeps its values in the PLAIN encoding of Parquet, so that encoding the row group only adds the definition levels and
+/// compresses the columns. Fields of a data type that Parquet stores in the same representation are appended value by value without
+/// any formatting. The non-nullable columns of a columnar buffer are contiguous, thus the row group copies them with a single memcpy.
+/// Nullable columns of a columnar buffer take their definition levels from the validity bitmaps of the ColumnarLayout.
+class ParquetRowGroup
+{
+public:
+    /// The row group reads the tuple buffers of the schema in the columnar or the row layout
+    ParquetRowGroup(const Schema& schema, bool isColumnar);
+
+    void append(const TupleBuffer& buffer);
+
+    [[nodiscard]] uint64_t getNumberOfRows() const { return numberOfRows; }
+
+    /// Encodes the row group into the column chunks of a Parquet file, compressing every column with the compressor.
+    /// Worker threads encode their row groups independently, as the column chunks only refer to offsets within the encoded row group.
+    struct Encoded
+    {
+        struct ColumnChunk
+        {
+            /// Offset of the (page header of the) column chunk within the bytes
+            uint64_t offset;
+            uint64_t uncompressedSize;
+            uint64_t compressedSize;
+            uint64_t nullCount;
+            /// The PLAIN encoded minimum and maximum value of numeric columns (without NaNs), which allow readers to skip the row group.
+            /// Empty, if the column chunk has no statistics.
+            std::string minValue;
+            std::string maxValue;
+        };
+
+        std::string bytes;
+        std::vector<ColumnChunk> columnChunks;
+        uint64_t numberOfRows;
+    };
+    [[nodiscard]] Encoded encode(const FrameCompressor& compressor) const;
+
+private:
+    struct Column
+    {
+        DataType type;
+        /// Offset of the field in a tuple of the row layout
+        uint64_t offsetInTuple;
+        /// The definition level of every row; 0 for null and 1 for present values (only nullable columns)
+        std::vector<uint8_t> definitionLevels;
+        std::string values;
+    };
+
+    /// Appends the values at `firstValue + (i * stride)` for all tuples i of the buffer. The null flags of a nullable column are either
+    /// in the validity bitmap or, if there is none, in the null byte before every value.
+    static void appendColumn(
+        Column& column,
+        const TupleBuffer& buffer,
+        const std::byte* firstValue,
+        uint64_t stride,
+        const std::byte* validityBitmap,
+        uint64_t numberOfTuples);
+
+    std::vector<Column> columns;
+    Schema schema;
+    uint64_t tupleSize;
+    bool isColumnar;
+    std::optional<ColumnarLayout> columnarLayout;
+    uint64_t columnarLayoutBufferSize = 0;
+    uint64_t numberOfRows = 0;
+};
+
+/// Writes encoded row groups to a Parquet file and the metadata of all row groups as the footer of the file, once it is closed.
+/// The writer is not thread-safe, as the sink appends the row groups in the order in which their worker threads finished them.
+class ParquetFileWriter
+{
+public:
+    ParquetFileWriter(const std::string& filePath, const Schema& schema, SinkCompression compression);
+
+    void write(const ParquetRowGroup::Encoded& rowGroup);
+
+    /// Writes the footer and closes the file
+    void close();
+
+private:
+    struct RowGroupMetadata
+    {
+        std::vector<ParquetRowGroup::Encoded::ColumnChunk> columnChunks;
+        uint64_t numberOfRows;
+    };
+
+    [[nodiscard]] std::string encodeFileMetadata() const;
+
+    std::string filePath;
+    Schema schema;
+    SinkCompression compression;
+    std::ofstream file;
+    uint64_t fileOffset = 0;
+    std::vector<RowGroupMetadata> rowGroups;
+};
+
+}
@@ -14,12 +14,17 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <mutex>
+#include <new>
 #include <ostream>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include <folly/Synchronized.h>
 
@@ -58,8 +63,25 @@ protected:
     std::ostream& toString(std::ostream& str) const override;
 
 private:
+    /// Each worker thread buffers its formatted output and only locks the output stream to write a full buffer, or a buffer that it
+    /// did not write for the flush interval, so that a slow query still prints its results while it runs
+    struct alignas(std::hardware_destructive_interference_size) WorkerOutput
+    {
+        std::mutex mutex;
+        std::string buffer;
+        std::chrono::steady_clock::time_point lastFlush = std::chrono::steady_clock::now();
+    };
+    static constexpr size_t WORKER_OUTPUT_FLUSH_SIZE = 64 * 1024;
+    static constexpr std::chrono::milliseconds WORKER_OUTPUT_FLUSH_INTERVAL{100};
+
+    void flush(WorkerOutput& workerOutput);
+    /// Flushes the outputs of the other worker threads that were not flushed for the flush interval, e.g., of idle worker threads.
+    /// Skips the outputs that their worker threads currently write to.
+    void flushStaleOutputs(std::chrono::steady_clock::time_point now);
+
     folly::Synchronized<std::ostream*> outputStream;
     std::unique_ptr<Format> outputParser;
+    std::vector<WorkerOutput> workerOutputs;
 
     uint32_t ingestion = 0;
 };
@@ -0,0 +1,146 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <Configurations/Descriptor.hpp>
+#include <DataTypes/DataType.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Runtime/VariableSizedAccess.hpp>
+#include <Sinks/NetworkChannel.hpp>
+#include <Sinks/NetworkSink.hpp>
+#include <Sinks/Sink.hpp>
+#include <Sinks/SinkDescriptor.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <BackpressureChannel.hpp>
+#include <PipelineExecutionContext.hpp>
+
+namespace NES
+{
+
+/// An exchange that hash-partitions the tuples of its input by their partition keys into one outgoing stream per destination, so that
+/// the keyed operator of each receiving query (e.g., on another worker, or on the same worker for a local exchange) owns a disjoint
+/// partition of the keys. Each destination is a NetworkSource, to which the sink sends the tuples of its partition over a NetworkChannel.
+/// The tuples of a partition keep referencing the child buffers of their input buffer, thus the sink only sends the child buffers that the
+/// partition references, without copying variable sized data.
+class RepartitionSink final : public Sink
+{
+public:
+    static constexpr std::string_view NAME = "Repartition";
+
+    explicit RepartitionSink(BackpressureController backpressureController, const SinkDescriptor& sinkDescriptor);
+    ~RepartitionSink() override = default;
+
+    RepartitionSink(const RepartitionSink&) = delete;
+    RepartitionSink& operator=(const RepartitionSink&) = delete;
+    RepartitionSink(RepartitionSink&&) = delete;
+    RepartitionSink& operator=(RepartitionSink&&) = delete;
+
+    void start(PipelineExecutionContext& pipelineExecutionContext) override;
+    void execute(const TupleBuffer& inputTupleBuffer, PipelineExecutionContext& pipelineExecutionContext) override;
+    void stop(PipelineExecutionContext& pipelineExecutionContext) override;
+
+    static DescriptorConfig::Config validateAndFormat(std::unordered_map<std::string, std::string> config);
+
+    struct Destination
+    {
+        std::string host;
+        uint16_t port;
+    };
+
+    /// Parses a comma separated list of destinations in the form of host:port. Returns nullopt, if the list contains no destination or an
+    /// invalid one.
+    static std::optional<std::vector<Destination>> parseDestinations(std::string_view destinations);
+
+protected:
+    std::ostream& toString(std::ostream& str) const override;
+
+private:
+    struct Field
+    {
+        DataType type;
+        /// Offset of the field (including its null byte) in the tuples of the row layout
+        size_t offset;
+    };
+
+    /// The tuples that the sink collects for a partition, until their buffer is full or the input buffer was partitioned completely
+    struct PartitionBuffer
+    {
+        TupleBuffer buffer;
+        /// Maps the indexes of the child buffers of the input buffer to the indexes in the partition buffer
+        std::vector<std::optional<VariableSizedAccess::Index>> childIndexes;
+    };
+
+    [[nodiscard]] size_t getPartition(const TupleBuffer& inputBuffer, std::span<const std::byte> tuple) const;
+    void append(PartitionBuffer& partitionBuffer, const TupleBuffer& inputBuffer, std::span<const std::byte> tuple) const;
+
+    size_t sizeOfTuple;
+    std::vector<Field> partitionKeys;
+    std::vector<Field> varSizedFields;
+    std::vector<std::unique_ptr<NetworkChannel>> channels;
+    NetworkFlowControl flowControl;
+};
+
+struct ConfigParametersRepartition
+{
+    /// Comma separated list of the NetworkSources of the partitions, in the form of host:port
+    static inline const DescriptorConfig::ConfigParameter<std::string> DESTINATIONS{
+        "destinations",
+        std::nullopt,
+        [](const std::unordered_map<std::string, std::string>& config) -> std::optional<std::string>
+        {
+            const auto destinations = DescriptorConfig::tryGet(DESTINATIONS, config);
+            if (destinations.has_value() and not RepartitionSink::parseDestinations(*destinations).has_value())
+            {
+                NES_ERROR("RepartitionSink: destinations must be a comma separated list of host:port, but are: {}", *destinations);
+                return std::nullopt;
+            }
+            return destinations;
+        }};
+
+    /// Comma separated list of the fields, whose values determine the partition of a tuple
+    static inline const DescriptorConfig::ConfigParameter<std::string> PARTITION_KEYS{
+        "partition_keys",
+        std::nullopt,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(PARTITION_KEYS, config); }};
+
+    static inline std::unordered_map<std::string, DescriptorConfig::ConfigParameterContainer> parameterMap
+        = DescriptorConfig::createConfigParameterContainerMap(
+            SinkDescriptor::parameterMap,
+            DESTINATIONS,
+            PARTITION_KEYS,
+            ConfigParametersNetwork::CONNECT_TIMEOUT,
+            ConfigParametersNetwork::ZERO_COPY,
+            ConfigParametersNetwork::MAX_IN_FLIGHT_BYTES);
+};
+
+}
+
+namespace fmt
+{
+template <>
+struct formatter<NES::RepartitionSink> : ostream_formatter
+{
+};
+}
@@ -0,0 +1,68 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+#include <BackpressureChannel.hpp>
+
+namespace NES
+{
+
+/// A named stream of native frames (see NativeFormat) from a GrpcSink to the subscribers of the SubscribeResults rpc.
+/// The sink pushes one frame per tuple buffer, and the subscribers pop the frames in batches. A subscriber pops only as fast as its
+/// client reads the batches. Thus, while more than maxQueuedBytes are queued, the stream applies backpressure to the sources of the
+/// query of the sink, until the subscribers drained half of the queued bytes.
+class ResultStream
+{
+public:
+    /// Returns the stream of the name, which is created if neither a sink nor a subscriber uses it yet
+    static std::shared_ptr<ResultStream> get(const std::string& name);
+
+    explicit ResultStream(std::string name);
+
+    /// The sink attaches while it is started. The backpressure controller must outlive the sink detaching from the stream.
+    void attach(BackpressureController& backpressureController, size_t maxQueuedBytes);
+    /// Closes the stream. The subscribers receive the frames that are still queued, and the name can be used by another sink.
+    void detach();
+
+    void push(std::string frame);
+
+    /// Returns up to maxFrames frames, or an empty batch if no frame was pushed within the timeout.
+    /// Returns std::nullopt once the sink detached and all frames were popped.
+    std::optional<std::vector<std::string>> pop(size_t maxFrames, std::chrono::milliseconds timeout);
+
+private:
+    bool isClosed();
+
+    std::string name;
+    std::mutex mutex;
+    std::condition_variable framesAvailable;
+    std::deque<std::string> frames;
+    size_t queuedBytes = 0;
+    size_t maxQueuedBytes = 0;
+    BackpressureController* backpressureController = nullptr;
+    bool appliesBackpressure = false;
+    bool closed = false;
+};
+
+}
@@ -44,7 +44,9 @@ namespace NES
 enum class InputFormat : uint8_t
 {
     CSV,
-    JSON
+    JSON,
+    /// The tuple buffers in their row layout, including their child buffers (see NativeFrameHeader)
+    NATIVE
 };
 
 class SinkDescriptor final : public Descriptor
@@ -101,6 +103,22 @@ public:
         std::nullopt,
         [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(FILE_PATH, config); }};
 
+    /// Well-known property for any sink that can write buffers that the compiled pipeline formatted in its INPUT_FORMAT (CSV or JSON),
+    /// instead of formatting the tuple buffers itself (see FormatPhysicalOperator and CompiledFormat)
+    /// NOLINTNEXTLINE(cert-err58-cpp)
+    static inline const DescriptorConfig::ConfigParameter<bool> COMPILED_FORMAT{
+        "compiled_format",
+        false,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(COMPILED_FORMAT, config); }};
+
+    /// Well-known property for any sink that reads its tuple buffers in the columnar layout (see ColumnTupleBufferRef), instead of rows.
+    /// The pipeline that precedes the sink emits columnar buffers, regardless of the memory layout of its operators.
+    /// NOLINTNEXTLINE(cert-err58-cpp)
+    static inline const DescriptorConfig::ConfigParameter<bool> COLUMNAR_INPUT{
+        "columnar_input",
+        false,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(COLUMNAR_INPUT, config); }};
+
     static std::optional<DescriptorConfig::Config>
     validateAndFormatConfig(std::string_view sinkType, std::unordered_map<std::string, std::string> configPairs);
 
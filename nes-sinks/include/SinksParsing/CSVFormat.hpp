@@ -46,11 +46,8 @@ public:
     explicit CSVFormat(const Schema& schema);
     explicit CSVFormat(const Schema& schema, bool escapeStrings);
 
-    /// Return formatted content of TupleBuffer, contains timestamp if specified in config.
-    [[nodiscard]] std::string getFormattedBuffer(const TupleBuffer& inputBuffer) const override;
-
-    /// Reads a TupleBuffer and uses the supplied 'schema' to format it to CSV. Returns result as a string.
-    [[nodiscard]] std::string tupleBufferToFormattedCSVString(TupleBuffer tbuffer, const FormattingContext& formattingContext) const;
+    /// Appends the tuples of the TupleBuffer as CSV rows to 'output'.
+    void formatBuffer(const TupleBuffer& inputBuffer, std::string& output) const override;
 
     std::ostream& toString(std::ostream& os) const override { return os << *this; }
 
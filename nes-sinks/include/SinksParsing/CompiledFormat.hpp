@@ -0,0 +1,43 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <SinksParsing/Format.hpp>
+
+#include <ostream>
+#include <string>
+#include <DataTypes/Schema.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Util/Logger/Formatter.hpp>
+
+namespace NES
+{
+
+/// Writes tuple buffers that the compiled pipeline already formatted as CSV or JSON rows (see FormatPhysicalOperator).
+/// The number of tuples of such a buffer is the number of its bytes, which the format copies as they are.
+class CompiledFormat : public Format
+{
+public:
+    explicit CompiledFormat(const Schema& schema);
+
+    void formatBuffer(const TupleBuffer& inputBuffer, std::string& output) const override;
+
+    std::ostream& toString(std::ostream& os) const override { return os << *this; }
+
+    friend std::ostream& operator<<(std::ostream& out, const CompiledFormat& format);
+};
+
+}
+
+FMT_OSTREAM(NES::CompiledFormat);
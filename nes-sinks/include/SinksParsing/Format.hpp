@@ -14,12 +14,15 @@
 
 #pragma once
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
 #include <ostream>
 #include <ranges>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <utility>
+#include <DataTypes/DataType.hpp>
 #include <DataTypes/Schema.hpp>
 #include <Nautilus/Interface/BufferRef/TupleBufferRef.hpp>
 #include <Runtime/TupleBuffer.hpp>
@@ -40,18 +43,37 @@ public:
 
     virtual ~Format() noexcept = default;
 
-    /// @brief Reads the variable sized data. Similar as loadAssociatedVarSizedValue, but returns a string
-    /// @return Variable sized data as a string
-    static std::string readVarSizedDataAsString(const TupleBuffer& tupleBuffer, VariableSizedAccess variableSizedAccess)
+    /// @brief Reads the variable sized data. Similar as loadAssociatedVarSizedValue, but returns a view of the characters
+    /// @return Variable sized data as a string view, which is valid as long as the tuple buffer and (for inlined values) the access are
+    static std::string_view readVarSizedData(const TupleBuffer& tupleBuffer, const VariableSizedAccess& variableSizedAccess)
     {
-        /// Getting the pointer to the @class VariableSizedData with the first 32-bit storing the size.
         const auto varSizedSpan = TupleBufferRef::loadAssociatedVarSizedValue(tupleBuffer, variableSizedAccess);
         const auto* const strPtrContent = reinterpret_cast<const char*>(varSizedSpan.data());
-        return std::string{strPtrContent, variableSizedAccess.getSize().getRawSize()};
+        return std::string_view{strPtrContent, variableSizedAccess.getSize().getRawSize()};
+    }
+
+    /// @brief Reads the variable sized data. Similar as loadAssociatedVarSizedValue, but returns a string
+    /// @return Variable sized data as a string
+    static std::string readVarSizedDataAsString(const TupleBuffer& tupleBuffer, const VariableSizedAccess& variableSizedAccess)
+    {
+        return std::string{readVarSizedData(tupleBuffer, variableSizedAccess)};
     }
 
+    /// Reads the VariableSizedAccess that a VARSIZED field (without its null byte) stores in a tuple
+    static VariableSizedAccess readVariableSizedAccess(const std::byte* field);
+
+    /// Appends the value of a fixed-size field to 'output' without allocating (besides growing 'output').
+    /// Produces the same characters as DataType::formattedBytesToString.
+    static void appendFormattedValue(std::string& output, const DataType& physicalType, const std::byte* data);
+
+    /// Appends a value of a fixed-size type, as appendFormattedValue does for a field of that type.
+    /// Instantiated for the C++ types of all fixed-size data types, e.g., for code that knows the type of a field up front.
+    template <typename T>
+    static void appendValue(std::string& output, T value);
+    static void appendDecimal(std::string& output, int64_t unscaledValue, uint8_t scale);
+
     /// Returns the schema of formatted according to the specific SinkFormat represented as string.
-    [[nodiscard]] std::string getFormattedSchema() const
+    [[nodiscard]] virtual std::string getFormattedSchema() const
     {
         PRECONDITION(schema.hasFields(), "Encountered schema without fields.");
         std::stringstream ss;
@@ -66,8 +88,17 @@ public:
         return fmt::format("{}\n", ss.str());
     }
 
+    /// Appends the formatted content of the TupleBuffer to 'output'. Implementations do not allocate per tuple or per field, so that
+    /// callers that reuse 'output' (after clearing it) format buffers without heap allocations once its capacity suffices.
+    virtual void formatBuffer(const TupleBuffer& inputBuffer, std::string& output) const = 0;
+
     /// Return formatted content of TupleBuffer, contains timestamp if specified in config.
-    [[nodiscard]] virtual std::string getFormattedBuffer(const TupleBuffer& inputBuffer) const = 0;
+    [[nodiscard]] std::string getFormattedBuffer(const TupleBuffer& inputBuffer) const
+    {
+        std::string output;
+        formatBuffer(inputBuffer, output);
+        return output;
+    }
 
     virtual std::ostream& toString(std::ostream&) const = 0;
 
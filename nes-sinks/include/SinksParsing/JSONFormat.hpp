@@ -42,11 +42,8 @@ public:
 
     explicit JSONFormat(const Schema& schema);
 
-    /// Return formatted content of TupleBuffer, contains timestamp if specified in config.
-    [[nodiscard]] std::string getFormattedBuffer(const TupleBuffer& inputBuffer) const override;
-
-    /// Reads a TupleBuffer and uses the supplied 'schema' to format it to JSON. Returns result as a string.
-    static std::string tupleBufferToFormattedJSONString(TupleBuffer tbuffer, const FormattingContext& formattingContext);
+    /// Appends the tuples of the TupleBuffer as JSON objects (one per line) to 'output'.
+    void formatBuffer(const TupleBuffer& inputBuffer, std::string& output) const override;
 
     std::ostream& toString(std::ostream& os) const override { return os << *this; }
 
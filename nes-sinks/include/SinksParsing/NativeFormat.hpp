@@ -0,0 +1,50 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+#include <SinksParsing/Format.hpp>
+
+#include <ostream>
+#include <string>
+#include <DataTypes/Schema.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Util/Logger/Formatter.hpp>
+
+namespace NES
+{
+
+/// Writes tuple buffers of the row layout in the native format (see NativeFrameHeader), i.e., copies the bytes of the tuples and of the
+/// child buffers without formatting a single value. The native input formatter re-ingests the output without parsing it.
+class NativeFormat : public Format
+{
+public:
+    explicit NativeFormat(const Schema& schema);
+
+    /// Appends one frame that contains the tuples and the child buffers of the tuple buffer
+    void formatBuffer(const TupleBuffer& inputBuffer, std::string& output) const override;
+
+    /// The frames of the native format are not preceded by a schema, since a text header would break the binary stream of frames
+    [[nodiscard]] std::string getFormattedSchema() const override { return {}; }
+
+    std::ostream& toString(std::ostream& os) const override { return os << *this; }
+
+    friend std::ostream& operator<<(std::ostream& out, const NativeFormat& format);
+
+private:
+    size_t sizeOfTuple;
+};
+
+}
+
+FMT_OSTREAM(NES::NativeFormat);
@@ -0,0 +1,340 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Sinks/AsyncFileWriter.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <Util/Logger/Logger.hpp>
+#include <BackpressureChannel.hpp>
+#include <ErrorHandling.hpp>
+#include <Thread.hpp>
+
+namespace NES
+{
+
+namespace
+{
+void writeFullyAt(const int fileDescriptor, const std::string& filePath, const char* data, size_t size, size_t offset)
+{
+    while (size > 0)
+    {
+        const auto written = ::pwrite(fileDescriptor, data, size, static_cast<off_t>(offset));
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw CannotWriteSink("Could not write to output file {}: {}", filePath, std::strerror(errno));
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+        offset += static_cast<size_t>(written);
+    }
+}
+}
+
+void AsyncFileWriter::FreeAligned::operator()(char* buffer) const
+{
+    std::free(buffer); ///NOLINT(cppcoreguidelines-no-malloc,cppcoreguidelines-owning-memory)
+}
+
+AsyncFileWriter::AsyncFileWriter(
+    const std::string& filePath,
+    const std::chrono::milliseconds flushInterval,
+    const bool directIO,
+    BackpressureController& backpressureController)
+    : filePath(filePath), flushInterval(flushInterval), directIO(directIO), backpressureController(backpressureController)
+{
+    /// O_DIRECT requires aligned file offsets, so we do not append, but write at the offsets we track. Reading back the last block of
+    /// the file requires the file to be opened for reading as well.
+    const int flags = directIO ? (O_RDWR | O_CREAT | O_DIRECT) : (O_WRONLY | O_CREAT | O_APPEND);
+    fileDescriptor = ::open(filePath.c_str(), flags, 0666); ///NOLINT(cppcoreguidelines-pro-type-vararg)
+    if (fileDescriptor < 0)
+    {
+        throw CannotOpenSink("Could not open output file {} (direct I/O: {}): {}", filePath, directIO, std::strerror(errno));
+    }
+    struct stat fileStatus{};
+    if (::fstat(fileDescriptor, &fileStatus) != 0)
+    {
+        ::close(fileDescriptor);
+        throw CannotOpenSink("Could not stat output file {}: {}", filePath, std::strerror(errno));
+    }
+    initialFileSize = static_cast<size_t>(fileStatus.st_size);
+
+    if (directIO)
+    {
+        ///NOLINTNEXTLINE(cppcoreguidelines-no-malloc,cppcoreguidelines-owning-memory)
+        stagingBuffer.reset(static_cast<char*>(std::aligned_alloc(DIRECT_IO_ALIGNMENT, MAX_BATCH_BYTES)));
+        INVARIANT(stagingBuffer != nullptr, "Could not allocate the staging buffer for direct I/O");
+        /// The file may end in a partial block. We stage its bytes, and rewrite the block together with the first bytes we append.
+        fileOffset = initialFileSize - (initialFileSize % DIRECT_IO_ALIGNMENT);
+        stagedBytes = initialFileSize - fileOffset;
+        if (stagedBytes > 0
+            && ::pread(fileDescriptor, stagingBuffer.get(), DIRECT_IO_ALIGNMENT, static_cast<off_t>(fileOffset))
+                != static_cast<ssize_t>(stagedBytes))
+        {
+            ::close(fileDescriptor);
+            throw CannotOpenSink("Could not read the last block of output file {}: {}", filePath, std::strerror(errno));
+        }
+    }
+    writerThread = Thread("file-sink-writer", &AsyncFileWriter::run, this);
+}
+
+AsyncFileWriter::~AsyncFileWriter()
+{
+    if (not isClosed)
+    {
+        try
+        {
+            close();
+        }
+        catch (...)
+        {
+            tryLogCurrentException();
+        }
+    }
+}
+
+void AsyncFileWriter::write(std::string bytes)
+{
+    PRECONDITION(not isClosed, "Cannot write to the closed output file {}", filePath);
+    if (failed.load(std::memory_order_acquire))
+    {
+        std::rethrow_exception(writeError);
+    }
+    if (not bytes.empty())
+    {
+        const auto queued = queuedBuffers.fetch_add(1, std::memory_order_relaxed) + 1;
+        queue.blockingWrite(std::move(bytes));
+        if (queued > BACKPRESSURE_THRESHOLD and not appliesBackpressure.load(std::memory_order_relaxed))
+        {
+            updateBackpressure();
+        }
+    }
+}
+
+void AsyncFileWriter::close()
+{
+    if (isClosed)
+    {
+        return;
+    }
+    isClosed = true;
+    queue.blockingWrite(std::nullopt);
+    /// Joins the writer thread, which writes all pending bytes before it returns
+    writerThread = Thread();
+    if (::close(fileDescriptor) != 0 and not failed.load(std::memory_order_acquire))
+    {
+        throw CannotWriteSink("Could not close output file {}: {}", filePath, std::strerror(errno));
+    }
+    if (failed.load(std::memory_order_acquire))
+    {
+        std::rethrow_exception(writeError);
+    }
+}
+
+void AsyncFileWriter::run()
+{
+    std::vector<std::string> batch;
+    batch.reserve(MAX_BATCH_BUFFERS);
+    bool endOfStream = false;
+    while (not endOfStream)
+    {
+        std::optional<std::string> bytes;
+        queue.blockingRead(bytes);
+        const auto flushDeadline = std::chrono::steady_clock::now() + flushInterval;
+        size_t batchBytes = 0;
+        /// Collects the buffers that arrive until the flush deadline, unless the batch is full before
+        while (true)
+        {
+            if (not bytes.has_value())
+            {
+                endOfStream = true;
+                break;
+            }
+            queuedBuffers.fetch_sub(1, std::memory_order_relaxed);
+            batchBytes += bytes->size();
+            batch.emplace_back(std::move(*bytes));
+            const bool batchIsFull = batch.size() >= MAX_BATCH_BUFFERS or batchBytes >= MAX_BATCH_BYTES;
+            if (batchIsFull or not(queue.read(bytes) or queue.tryReadUntil(flushDeadline, bytes)))
+            {
+                break;
+            }
+        }
+
+        /// After a failure, we keep draining the queue, so that worker threads do not block on a full queue
+        if (not batch.empty() and not failed.load(std::memory_order_relaxed))
+        {
+            try
+            {
+                writeBatch(batch);
+            }
+            catch (...)
+            {
+                writeError = std::current_exception();
+                failed.store(true, std::memory_order_release);
+            }
+        }
+        batch.clear();
+        if (appliesBackpressure.load(std::memory_order_relaxed))
+        {
+            updateBackpressure();
+        }
+    }
+
+    if (directIO and not failed.load(std::memory_order_relaxed))
+    {
+        try
+        {
+            writeDirectTail();
+        }
+        catch (...)
+        {
+            writeError = std::current_exception();
+            failed.store(true, std::memory_order_release);
+        }
+    }
+    /// The queue is empty at the end of the stream, thus this releases the backpressure, if the writer still applies it
+    updateBackpressure();
+}
+
+void AsyncFileWriter::updateBackpressure()
+{
+    const std::scoped_lock lock(backpressureMutex);
+    const auto queued = queuedBuffers.load(std::memory_order_relaxed);
+    if (not appliesBackpressure.load(std::memory_order_relaxed) and queued > BACKPRESSURE_THRESHOLD)
+    {
+        NES_DEBUG("Async file writer of {} applies backpressure, as {} buffers are queued", filePath, queued);
+        backpressureController.applyPressure();
+        appliesBackpressure.store(true, std::memory_order_relaxed);
+    }
+    else if (appliesBackpressure.load(std::memory_order_relaxed) and queued <= BACKPRESSURE_THRESHOLD / 2)
+    {
+        backpressureController.releasePressure();
+        appliesBackpressure.store(false, std::memory_order_relaxed);
+    }
+}
+
+void AsyncFileWriter::writeBatch(std::vector<std::string>& batch)
+{
+    if (directIO)
+    {
+        writeDirect(batch);
+        return;
+    }
+    std::vector<iovec> ranges;
+    ranges.reserve(batch.size());
+    for (auto& bytes : batch)
+    {
+        ranges.emplace_back(iovec{.iov_base = bytes.data(), .iov_len = bytes.size()});
+    }
+    writeFully(ranges);
+}
+
+void AsyncFileWriter::writeFully(std::vector<iovec>& ranges) const
+{
+    size_t nextRange = 0;
+    while (nextRange < ranges.size())
+    {
+        const auto written = ::writev(fileDescriptor, ranges.data() + nextRange, static_cast<int>(ranges.size() - nextRange));
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw CannotWriteSink("Could not write to output file {}: {}", filePath, std::strerror(errno));
+        }
+        /// Skips the ranges that were written completely and resumes a partially written range
+        auto remaining = static_cast<size_t>(written);
+        while (nextRange < ranges.size() and remaining >= ranges[nextRange].iov_len)
+        {
+            remaining -= ranges[nextRange].iov_len;
+            ++nextRange;
+        }
+        if (remaining > 0)
+        {
+            ranges[nextRange].iov_base = static_cast<char*>(ranges[nextRange].iov_base) + remaining;
+            ranges[nextRange].iov_len -= remaining;
+        }
+    }
+}
+
+void AsyncFileWriter::writeDirect(const std::vector<std::string>& batch)
+{
+    const auto writeStagedBlocks = [this]
+    {
+        const auto blockBytes = stagedBytes - (stagedBytes % DIRECT_IO_ALIGNMENT);
+        writeFullyAt(fileDescriptor, filePath, stagingBuffer.get(), blockBytes, fileOffset);
+        fileOffset += blockBytes;
+        std::memmove(stagingBuffer.get(), stagingBuffer.get() + blockBytes, stagedBytes - blockBytes);
+        stagedBytes -= blockBytes;
+    };
+
+    for (const auto& bytes : batch)
+    {
+        size_t copiedBytes = 0;
+        while (copiedBytes < bytes.size())
+        {
+            const auto bytesToCopy = std::min(bytes.size() - copiedBytes, MAX_BATCH_BYTES - stagedBytes);
+            std::memcpy(stagingBuffer.get() + stagedBytes, bytes.data() + copiedBytes, bytesToCopy);
+            stagedBytes += bytesToCopy;
+            copiedBytes += bytesToCopy;
+            if (stagedBytes == MAX_BATCH_BYTES)
+            {
+                writeStagedBlocks();
+            }
+        }
+    }
+    writeStagedBlocks();
+}
+
+void AsyncFileWriter::writeDirectTail()
+{
+    if (stagedBytes == 0)
+    {
+        return;
+    }
+    /// The tail is not a multiple of the alignment, which O_DIRECT does not allow to write
+    const int flags = ::fcntl(fileDescriptor, F_GETFL); ///NOLINT(cppcoreguidelines-pro-type-vararg)
+    if (flags < 0 or ::fcntl(fileDescriptor, F_SETFL, flags & ~O_DIRECT) < 0) ///NOLINT(cppcoreguidelines-pro-type-vararg)
+    {
+        throw CannotWriteSink("Could not disable direct I/O for output file {}: {}", filePath, std::strerror(errno));
+    }
+    writeFullyAt(fileDescriptor, filePath, stagingBuffer.get(), stagedBytes, fileOffset);
+    fileOffset += stagedBytes;
+    stagedBytes = 0;
+}
+
+}
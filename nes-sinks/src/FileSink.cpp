@@ -14,6 +14,8 @@
 
 #include <Sinks/FileSink.hpp>
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
@@ -24,15 +26,20 @@
 #include <unordered_map>
 #include <utility>
 
+#include <fmt/chrono.h>
 #include <fmt/format.h>
 #include <magic_enum/magic_enum.hpp>
 
 #include <Configurations/Descriptor.hpp>
 #include <Runtime/TupleBuffer.hpp>
+#include <Sinks/AsyncFileWriter.hpp>
+#include <Sinks/FrameCompressor.hpp>
 #include <Sinks/Sink.hpp>
 #include <Sinks/SinkDescriptor.hpp>
 #include <SinksParsing/CSVFormat.hpp>
+#include <SinksParsing/CompiledFormat.hpp>
 #include <SinksParsing/JSONFormat.hpp>
+#include <SinksParsing/NativeFormat.hpp>
 #include <Util/Logger/Logger.hpp>
 #include <BackpressureChannel.hpp>
 #include <ErrorHandling.hpp>
@@ -43,13 +50,42 @@
 namespace NES
 {
 
+namespace
+{
+/// Reused by the worker threads to format buffers without allocating
+thread_local std::string tlFormattedBuffer;
+thread_local size_t tlLastFormattedBufferSize = 0;
+thread_local std::string tlCompressedBuffer;
+}
+
 FileSink::FileSink(BackpressureController backpressureController, const SinkDescriptor& sinkDescriptor)
     : Sink(std::move(backpressureController))
     , outputFilePath(sinkDescriptor.getFromConfig(SinkDescriptor::FILE_PATH))
     , isAppend(sinkDescriptor.getFromConfig(ConfigParametersFile::APPEND))
+    , isAsync(sinkDescriptor.getFromConfig(ConfigParametersFile::ASYNC))
+    , flushInterval(sinkDescriptor.getFromConfig(ConfigParametersFile::FLUSH_INTERVAL_MS))
+    , isDirectIO(sinkDescriptor.getFromConfig(ConfigParametersFile::DIRECT_IO))
+    , isCompiledFormat(sinkDescriptor.getFromConfig(SinkDescriptor::COMPILED_FORMAT))
+    , compressor(
+          sinkDescriptor.getFromConfig(ConfigParametersFile::COMPRESSION), sinkDescriptor.getFromConfig(ConfigParametersFile::COMPRESSION_LEVEL))
     , isOpen(false)
 {
-    switch (const auto inputFormat = sinkDescriptor.getFromConfig(SinkDescriptor::INPUT_FORMAT))
+    if (isDirectIO and not isAsync)
+    {
+        throw InvalidConfigParameter("The file sink only supports direct_io in async mode");
+    }
+    const auto inputFormat = sinkDescriptor.getFromConfig(SinkDescriptor::INPUT_FORMAT);
+    if (isCompiledFormat)
+    {
+        /// The pipeline emits the rows of the input format, only their header is up to the sink
+        if (inputFormat == InputFormat::NATIVE)
+        {
+            throw InvalidConfigParameter("The file sink only supports compiled_format for the CSV and JSON formats");
+        }
+        formatter = std::make_unique<CompiledFormat>(*sinkDescriptor.getSchema());
+        return;
+    }
+    switch (inputFormat)
     {
         case InputFormat::CSV:
             formatter = std::make_unique<CSVFormat>(*sinkDescriptor.getSchema());
@@ -57,6 +93,9 @@ FileSink::FileSink(BackpressureController backpressureController, const SinkDesc
         case InputFormat::JSON:
             formatter = std::make_unique<JSONFormat>(*sinkDescriptor.getSchema());
             break;
+        case InputFormat::NATIVE:
+            formatter = std::make_unique<NativeFormat>(*sinkDescriptor.getSchema());
+            break;
         default:
             throw UnknownSinkFormat(fmt::format("Sink format: {} not supported.", magic_enum::enum_name(inputFormat)));
     }
@@ -64,14 +103,21 @@ FileSink::FileSink(BackpressureController backpressureController, const SinkDesc
 
 std::ostream& FileSink::toString(std::ostream& str) const
 {
-    str << fmt::format("FileSink(filePathOutput: {}, isAppend: {})", outputFilePath, isAppend);
+    str << fmt::format(
+        "FileSink(filePathOutput: {}, isAppend: {}, isAsync: {}, flushInterval: {}, isDirectIO: {}, isCompiledFormat: {}, compression: {})",
+        outputFilePath,
+        isAppend,
+        isAsync,
+        flushInterval,
+        isDirectIO,
+        isCompiledFormat,
+        magic_enum::enum_name(compressor.getCompression()));
     return str;
 }
 
 void FileSink::start(PipelineExecutionContext&)
 {
     NES_DEBUG("Setting up file sink: {}", *this);
-    const auto stream = outputFileStream.wlock();
     /// Remove an existing file unless the isAppend mode is isAppend.
     if (!isAppend)
     {
@@ -85,7 +131,20 @@ void FileSink::start(PipelineExecutionContext&)
         }
     }
 
+    if (isAsync)
+    {
+        asyncWriter = std::make_unique<AsyncFileWriter>(outputFilePath, flushInterval, isDirectIO, backpressureController);
+        isOpen = true;
+        /// Write the schema to the file, if it is empty.
+        if (asyncWriter->getInitialFileSize() == 0)
+        {
+            asyncWriter->write(toFileBytes(formatter->getFormattedSchema()));
+        }
+        return;
+    }
+
     /// Open the file stream
+    const auto stream = outputFileStream.wlock();
     if (!stream->is_open())
     {
         stream->open(outputFilePath, std::ofstream::binary | std::ofstream::app);
@@ -100,7 +159,7 @@ void FileSink::start(PipelineExecutionContext&)
     /// Write the schema to the file, if it is empty.
     if (stream->tellp() == 0)
     {
-        const auto schemaStr = formatter->getFormattedSchema();
+        const auto schemaStr = toFileBytes(formatter->getFormattedSchema());
         stream->write(schemaStr.c_str(), static_cast<int64_t>(schemaStr.length()));
     }
 }
@@ -110,20 +169,63 @@ void FileSink::execute(const TupleBuffer& inputTupleBuffer, PipelineExecutionCon
     PRECONDITION(inputTupleBuffer, "Invalid input buffer in FileSink.");
     PRECONDITION(isOpen, "Sink was not opened");
 
+    const bool isCompressed = compressor.getCompression() != SinkCompression::NONE;
+    if (asyncWriter)
     {
-        auto fBuffer = formatter->getFormattedBuffer(inputTupleBuffer);
-        NES_TRACE("Writing tuples to file sink; filePathOutput={}, fBuffer={}", outputFilePath, fBuffer);
+        if (isCompressed)
         {
-            const auto wlocked = outputFileStream.wlock();
-            wlocked->write(fBuffer.c_str(), static_cast<std::streamsize>(fBuffer.size()));
-            wlocked->flush();
+            /// The worker thread compresses its buffer, so that the writer thread only concatenates the frames
+            tlFormattedBuffer.clear();
+            formatter->formatBuffer(inputTupleBuffer, tlFormattedBuffer);
+            std::string frame;
+            compressor.compress(tlFormattedBuffer, frame);
+            asyncWriter->write(std::move(frame));
+            return;
         }
+        /// The writer thread takes the formatted bytes over. Reserving the size of the last buffer avoids regrowing them.
+        std::string fBuffer;
+        fBuffer.reserve(tlLastFormattedBufferSize);
+        formatter->formatBuffer(inputTupleBuffer, fBuffer);
+        tlLastFormattedBufferSize = fBuffer.size();
+        NES_TRACE("Writing tuples to file sink; filePathOutput={}, fBuffer={}", outputFilePath, fBuffer);
+        asyncWriter->write(std::move(fBuffer));
+        return;
+    }
+
+    tlFormattedBuffer.clear();
+    formatter->formatBuffer(inputTupleBuffer, tlFormattedBuffer);
+    NES_TRACE("Writing tuples to file sink; filePathOutput={}, fBuffer={}", outputFilePath, tlFormattedBuffer);
+    if (isCompressed)
+    {
+        compressor.compress(tlFormattedBuffer, tlCompressedBuffer);
+    }
+    const auto& bytes = isCompressed ? tlCompressedBuffer : tlFormattedBuffer;
+    {
+        const auto wlocked = outputFileStream.wlock();
+        wlocked->write(bytes.c_str(), static_cast<std::streamsize>(bytes.size()));
+        wlocked->flush();
     }
 }
 
+std::string FileSink::toFileBytes(std::string formatted) const
+{
+    if (compressor.getCompression() == SinkCompression::NONE)
+    {
+        return formatted;
+    }
+    std::string frame;
+    compressor.compress(formatted, frame);
+    return frame;
+}
+
 void FileSink::stop(PipelineExecutionContext&)
 {
     NES_DEBUG("Closing file sink, filePathOutput={}", outputFilePath);
+    if (asyncWriter)
+    {
+        asyncWriter->close();
+        return;
+    }
     const auto stream = outputFileStream.wlock();
     stream->flush();
     stream->close();
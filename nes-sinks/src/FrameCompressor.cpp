@@ -0,0 +1,130 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Sinks/FrameCompressor.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <lz4frame.h>
+#include <lz4hc.h>
+#include <zstd.h>
+
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+namespace
+{
+struct ZstdContextDeleter
+{
+    void operator()(ZSTD_CCtx* context) const { ZSTD_freeCCtx(context); }
+};
+
+/// Every worker thread compresses with a context of its own, which zstd reuses across frames instead of allocating it per frame
+thread_local std::unique_ptr<ZSTD_CCtx, ZstdContextDeleter> tlZstdContext;
+}
+
+FrameCompressor::FrameCompressor(const SinkCompression compression, const int32_t compressionLevel)
+    : compression(compression), compressionLevel(compressionLevel)
+{
+    switch (compression)
+    {
+        case SinkCompression::NONE:
+            return;
+        case SinkCompression::ZSTD:
+            if (compressionLevel < ZSTD_minCLevel() or compressionLevel > ZSTD_maxCLevel())
+            {
+                throw InvalidConfigParameter(
+                    "zstd supports compression levels from {} to {}, but got {}", ZSTD_minCLevel(), ZSTD_maxCLevel(), compressionLevel);
+            }
+            return;
+        case SinkCompression::LZ4:
+            /// Negative levels select the fast mode with a higher acceleration
+            if (compressionLevel > LZ4HC_CLEVEL_MAX)
+            {
+                throw InvalidConfigParameter("lz4 supports compression levels up to {}, but got {}", LZ4HC_CLEVEL_MAX, compressionLevel);
+            }
+            return;
+    }
+    std::unreachable();
+}
+
+void FrameCompressor::compress(const std::string_view block, std::string& frame) const
+{
+    switch (compression)
+    {
+        case SinkCompression::NONE:
+            frame.assign(block);
+            return;
+        case SinkCompression::ZSTD:
+            compressZstd(block, frame);
+            return;
+        case SinkCompression::LZ4:
+            compressLz4(block, frame);
+            return;
+    }
+    std::unreachable();
+}
+
+void FrameCompressor::compressZstd(const std::string_view block, std::string& frame) const
+{
+    if (not tlZstdContext)
+    {
+        tlZstdContext.reset(ZSTD_createCCtx());
+        if (not tlZstdContext)
+        {
+            throw CannotWriteSink("Could not create a zstd compression context");
+        }
+    }
+    /// The size of a frame is at most the bound, so it does not have to grow while compressing
+    size_t result = 0;
+    frame.resize_and_overwrite(
+        ZSTD_compressBound(block.size()),
+        [&](char* data, const size_t capacity)
+        {
+            result = ZSTD_compressCCtx(tlZstdContext.get(), data, capacity, block.data(), block.size(), compressionLevel);
+            return ZSTD_isError(result) ? 0 : result;
+        });
+    if (ZSTD_isError(result))
+    {
+        throw CannotWriteSink("Could not compress {}B with zstd: {}", block.size(), ZSTD_getErrorName(result));
+    }
+}
+
+void FrameCompressor::compressLz4(const std::string_view block, std::string& frame) const
+{
+    LZ4F_preferences_t preferences{};
+    preferences.compressionLevel = compressionLevel;
+    preferences.frameInfo.contentSize = block.size();
+    size_t result = 0;
+    frame.resize_and_overwrite(
+        LZ4F_compressFrameBound(block.size(), &preferences),
+        [&](char* data, const size_t capacity)
+        {
+            result = LZ4F_compressFrame(data, capacity, block.data(), block.size(), &preferences);
+            return LZ4F_isError(result) ? 0 : result;
+        });
+    if (LZ4F_isError(result))
+    {
+        throw CannotWriteSink("Could not compress {}B with lz4: {}", block.size(), LZ4F_getErrorName(result));
+    }
+}
+
+}
@@ -0,0 +1,108 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Sinks/GrpcSink.hpp>
+
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <Configurations/Descriptor.hpp>
+#include <Configurations/Enums/EnumWrapper.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sinks/ResultStream.hpp>
+#include <Sinks/Sink.hpp>
+#include <Sinks/SinkDescriptor.hpp>
+#include <SinksParsing/NativeFormat.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <fmt/format.h>
+#include <BackpressureChannel.hpp>
+#include <ErrorHandling.hpp>
+#include <PipelineExecutionContext.hpp>
+#include <SinkRegistry.hpp>
+#include <SinkValidationRegistry.hpp>
+
+namespace NES
+{
+
+GrpcSink::GrpcSink(BackpressureController backpressureController, const SinkDescriptor& sinkDescriptor)
+    : Sink(std::move(backpressureController))
+    , streamName(sinkDescriptor.getFromConfig(ConfigParametersGrpc::STREAM_NAME))
+    , maxQueuedBytes(sinkDescriptor.getFromConfig(ConfigParametersGrpc::MAX_QUEUED_BYTES))
+    , format(*sinkDescriptor.getSchema())
+{
+}
+
+GrpcSink::~GrpcSink()
+{
+    if (stream)
+    {
+        stream->detach();
+    }
+}
+
+std::ostream& GrpcSink::toString(std::ostream& str) const
+{
+    str << fmt::format("GrpcSink(stream: {}, maxQueuedBytes: {})", streamName, maxQueuedBytes);
+    return str;
+}
+
+void GrpcSink::start(PipelineExecutionContext&)
+{
+    NES_DEBUG("Setting up grpc sink: {}", *this);
+    /// A sink that fails to attach must not detach the stream of the sink that writes it
+    auto resultStream = ResultStream::get(streamName);
+    resultStream->attach(backpressureController, maxQueuedBytes);
+    stream = std::move(resultStream);
+}
+
+void GrpcSink::execute(const TupleBuffer& inputTupleBuffer, PipelineExecutionContext&)
+{
+    PRECONDITION(inputTupleBuffer, "Invalid input buffer in GrpcSink.");
+    std::string frame;
+    format.formatBuffer(inputTupleBuffer, frame);
+    stream->push(std::move(frame));
+}
+
+void GrpcSink::stop(PipelineExecutionContext&)
+{
+    NES_DEBUG("Closing grpc sink: {}", *this);
+    stream->detach();
+    stream.reset();
+}
+
+DescriptorConfig::Config GrpcSink::validateAndFormat(std::unordered_map<std::string, std::string> config)
+{
+    auto validatedConfig = DescriptorConfig::validateAndFormat<ConfigParametersGrpc>(std::move(config), NAME);
+    /// Clients decode the frames like the native input formatter, without parsing a single value
+    if (std::get<EnumWrapper>(validatedConfig.at(SinkDescriptor::INPUT_FORMAT)).asEnum<InputFormat>() != InputFormat::NATIVE)
+    {
+        throw InvalidConfigParameter("The grpc sink only supports the NATIVE input format");
+    }
+    return validatedConfig;
+}
+
+SinkValidationRegistryReturnType RegisterGrpcSinkValidation(SinkValidationRegistryArguments sinkConfig)
+{
+    return GrpcSink::validateAndFormat(std::move(sinkConfig.config));
+}
+
+SinkRegistryReturnType RegisterGrpcSink(SinkRegistryArguments sinkRegistryArguments)
+{
+    return std::make_unique<GrpcSink>(std::move(sinkRegistryArguments.backpressureController), sinkRegistryArguments.sinkDescriptor);
+}
+
+}
@@ -0,0 +1,386 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Sinks/NetworkChannel.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+
+#include <Runtime/NativeFrameHeader.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Runtime/VariableSizedAccess.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <linux/errqueue.h>
+#include <linux/sockios.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <BackpressureChannel.hpp>
+#include <ErrorHandling.hpp>
+#include <netdb.h>
+#include <unistd.h>
+
+namespace NES
+{
+
+NetworkChannel::NetworkChannel(
+    std::string host, const uint32_t port, const std::chrono::seconds connectTimeout, const bool zeroCopy, const size_t sizeOfTuple)
+    : host(std::move(host)), port(port), connectTimeout(connectTimeout), useZeroCopy(zeroCopy), sizeOfTuple(sizeOfTuple)
+{
+    PRECONDITION(
+        sizeOfTuple <= std::numeric_limits<uint32_t>::max(), "The native format does not support tuples of {} bytes", sizeOfTuple);
+}
+
+NetworkChannel::~NetworkChannel()
+{
+    if (const auto lockedConnection = connection.wlock(); lockedConnection->socket >= 0)
+    {
+        ::close(lockedConnection->socket);
+    }
+}
+
+std::ostream& operator<<(std::ostream& os, const NetworkChannel& channel)
+{
+    return os << fmt::format(
+               "NetworkChannel(host: {}, port: {}, connectTimeout: {}, zeroCopy: {})",
+               channel.host,
+               channel.port,
+               channel.connectTimeout,
+               channel.useZeroCopy);
+}
+
+void NetworkChannel::connect(Connection& connection) const
+{
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* result = nullptr;
+    const auto portString = std::to_string(port);
+    if (const auto errorCode = getaddrinfo(host.c_str(), portString.c_str(), &hints, &result); errorCode != 0)
+    {
+        throw CannotOpenSink("Could not resolve {}:{}: {}", host, port, gai_strerror(errorCode));
+    }
+    const std::unique_ptr<addrinfo, decltype(&freeaddrinfo)> resultGuard(result, freeaddrinfo);
+
+    const auto deadline = std::chrono::steady_clock::now() + connectTimeout;
+    int lastError = 0;
+    while (true)
+    {
+        for (const auto* address = result; address != nullptr; address = address->ai_next)
+        {
+            const int socket = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+            if (socket < 0)
+            {
+                lastError = errno;
+                continue;
+            }
+            if (::connect(socket, address->ai_addr, address->ai_addrlen) == 0)
+            {
+                connection.socket = socket;
+                return;
+            }
+            lastError = errno;
+            ::close(socket);
+        }
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            throw CannotOpenSink("Could not connect to {}:{} within {}: {}", host, port, connectTimeout, std::strerror(lastError));
+        }
+        std::this_thread::sleep_for(CONNECT_RETRY_INTERVAL);
+    }
+}
+
+void NetworkChannel::open()
+{
+    const auto lockedConnection = connection.wlock();
+    connect(*lockedConnection);
+
+    /// Every frame is a single sendmsg call, thus waiting for more bytes would only delay the frame
+    constexpr int enabled = 1;
+    setsockopt(lockedConnection->socket, IPPROTO_TCP, TCP_NODELAY, &enabled, sizeof(enabled));
+    lockedConnection->zeroCopy = useZeroCopy;
+    if (useZeroCopy and setsockopt(lockedConnection->socket, SOL_SOCKET, SO_ZEROCOPY, &enabled, sizeof(enabled)) != 0)
+    {
+        NES_WARNING("Channel to {}:{} falls back to copying sends, as MSG_ZEROCOPY is not supported: {}", host, port, strerror(errno));
+        lockedConnection->zeroCopy = false;
+    }
+}
+
+void NetworkChannel::send(const TupleBuffer& buffer)
+{
+    /// Child buffers that store var-sized data store their number of used bytes in their number of tuples (see TupleBufferRef)
+    const auto numberOfChildBuffers = buffer.getNumberOfChildBuffers();
+    InFlightFrame frame{
+        .header
+        = {.magic = NativeFrameHeader::MAGIC,
+           .sizeOfTuple = static_cast<uint32_t>(sizeOfTuple),
+           .numberOfTuples = buffer.getNumberOfTuples(),
+           .numberOfChildBuffers = numberOfChildBuffers},
+        .sizesOfChildBuffers = {},
+        .buffers = {buffer}};
+    frame.sizesOfChildBuffers.reserve(numberOfChildBuffers);
+    frame.buffers.reserve(numberOfChildBuffers + 1);
+    for (uint32_t childIndex = 0; childIndex < numberOfChildBuffers; ++childIndex)
+    {
+        const auto& childBuffer = frame.buffers.emplace_back(buffer.loadChildBuffer(VariableSizedAccess::Index{childIndex}));
+        frame.sizesOfChildBuffers.emplace_back(std::min(childBuffer.getNumberOfTuples(), childBuffer.getBufferSize()));
+    }
+
+    const std::scoped_lock sendLock(sendMutex);
+    auto lockedConnection = connection.wlock();
+    PRECONDITION(lockedConnection->socket >= 0, "Channel to {}:{} was not opened", host, port);
+    const auto socket = lockedConnection->socket;
+    const auto zeroCopy = lockedConnection->zeroCopy;
+    /// The kernel reads the frame from its final location, thus we point the iovecs into the frame after adding it to the deque
+    auto& sentFrame = lockedConnection->inFlightFrames.emplace_back(std::move(frame));
+    std::vector<iovec> iovecs;
+    iovecs.reserve(2 + (2 * numberOfChildBuffers));
+    const auto toIovec = [](const void* data, const size_t size) { return iovec{.iov_base = const_cast<void*>(data), .iov_len = size}; };
+    iovecs.emplace_back(toIovec(&sentFrame.header, sizeof(NativeFrameHeader)));
+    iovecs.emplace_back(toIovec(buffer.getAvailableMemoryArea().data(), sentFrame.header.numberOfTuples * sizeOfTuple));
+    for (uint32_t childIndex = 0; childIndex < numberOfChildBuffers; ++childIndex)
+    {
+        iovecs.emplace_back(toIovec(&sentFrame.sizesOfChildBuffers[childIndex], sizeof(uint64_t)));
+        iovecs.emplace_back(
+            toIovec(sentFrame.buffers[childIndex + 1].getAvailableMemoryArea().data(), sentFrame.sizesOfChildBuffers[childIndex]));
+    }
+
+    /// Only this send adds frames, thus the frame stays the last one, while releasing completed frames leaves it in the deque
+    lockedConnection.unlock();
+    uint32_t zeroCopySends = 0;
+    try
+    {
+        zeroCopySends = sendAll(socket, zeroCopy, iovecs);
+    }
+    catch (...)
+    {
+        connection.wlock()->inFlightFrames.pop_back();
+        throw;
+    }
+    lockedConnection = connection.wlock();
+    if (zeroCopySends == 0)
+    {
+        /// The kernel copied the whole frame into the socket buffer
+        lockedConnection->inFlightFrames.pop_back();
+    }
+    else
+    {
+        lockedConnection->nextZeroCopyId += zeroCopySends;
+        sentFrame.lastZeroCopyId = lockedConnection->nextZeroCopyId - 1;
+    }
+}
+
+uint32_t NetworkChannel::sendAll(const int socket, const bool zeroCopy, std::span<iovec> iovecs) const
+{
+    uint32_t zeroCopySends = 0;
+    while (not iovecs.empty())
+    {
+        msghdr message{};
+        message.msg_iov = iovecs.data();
+        message.msg_iovlen = std::min<size_t>(iovecs.size(), IOV_MAX);
+        bool zeroCopyMessage = zeroCopy;
+        auto sentBytes = ::sendmsg(socket, &message, zeroCopyMessage ? MSG_ZEROCOPY | MSG_NOSIGNAL : MSG_NOSIGNAL);
+        if (sentBytes < 0 and zeroCopyMessage and errno == ENOBUFS)
+        {
+            /// The kernel could not pin the pages of the buffers, as the socket exceeded its limit of locked memory
+            zeroCopyMessage = false;
+            sentBytes = ::sendmsg(socket, &message, MSG_NOSIGNAL);
+        }
+        if (sentBytes < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw CannotWriteSink("Could not send to {}:{}: {}", host, port, strerror(errno));
+        }
+        zeroCopySends += zeroCopyMessage ? 1 : 0;
+
+        /// Skips the iovecs that the kernel sent completely and continues with the rest of the first one that it sent partially
+        auto remainingBytes = static_cast<size_t>(sentBytes);
+        while (not iovecs.empty() and remainingBytes >= iovecs.front().iov_len)
+        {
+            remainingBytes -= iovecs.front().iov_len;
+            iovecs = iovecs.subspan(1);
+        }
+        if (remainingBytes > 0)
+        {
+            iovecs.front().iov_base = static_cast<std::byte*>(iovecs.front().iov_base) + remainingBytes;
+            iovecs.front().iov_len -= remainingBytes;
+        }
+    }
+    return zeroCopySends;
+}
+
+void NetworkChannel::releaseCompletedFrames(Connection& connection)
+{
+    /// The kernel reports the completed sendmsg calls on the error queue of the socket as ranges of their ids
+    std::array<char, CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))> control{};
+    while (not connection.inFlightFrames.empty())
+    {
+        msghdr message{};
+        message.msg_control = control.data();
+        message.msg_controllen = control.size();
+        if (::recvmsg(connection.socket, &message, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+        {
+            return;
+        }
+        for (auto* header = CMSG_FIRSTHDR(&message); header != nullptr; header = CMSG_NXTHDR(&message, header))
+        {
+            const bool isExtendedError = (header->cmsg_level == SOL_IP and header->cmsg_type == IP_RECVERR)
+                or (header->cmsg_level == SOL_IPV6 and header->cmsg_type == IPV6_RECVERR);
+            if (not isExtendedError)
+            {
+                continue;
+            }
+            sock_extended_err error{};
+            std::memcpy(&error, CMSG_DATA(header), sizeof(error));
+            if (error.ee_errno != 0 or error.ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+            {
+                continue;
+            }
+            /// TCP completes the sendmsg calls in order. ee_data is the last id of the range, and the ids wrap around.
+            while (not connection.inFlightFrames.empty() and connection.inFlightFrames.front().lastZeroCopyId.has_value()
+                   and static_cast<int32_t>(error.ee_data - *connection.inFlightFrames.front().lastZeroCopyId) >= 0)
+            {
+                connection.inFlightFrames.pop_front();
+            }
+        }
+    }
+}
+
+uint64_t NetworkChannel::releaseCompletedFrames()
+{
+    const auto lockedConnection = connection.wlock();
+    if (lockedConnection->socket < 0)
+    {
+        return 0;
+    }
+    releaseCompletedFrames(*lockedConnection);
+    int unacknowledgedBytes = 0;
+    if (::ioctl(lockedConnection->socket, SIOCOUTQ, &unacknowledgedBytes) != 0)
+    {
+        return 0;
+    }
+    return static_cast<uint64_t>(std::max(unacknowledgedBytes, 0));
+}
+
+void NetworkChannel::close()
+{
+    const std::scoped_lock sendLock(sendMutex);
+    const auto lockedConnection = connection.wlock();
+    if (lockedConnection->socket < 0)
+    {
+        return;
+    }
+
+    /// The kernel reads from the frames until the receiver acknowledged them
+    const auto deadline = std::chrono::steady_clock::now() + connectTimeout;
+    releaseCompletedFrames(*lockedConnection);
+    while (not lockedConnection->inFlightFrames.empty() and std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(CLOSE_POLL_INTERVAL);
+        releaseCompletedFrames(*lockedConnection);
+    }
+    if (not lockedConnection->inFlightFrames.empty())
+    {
+        NES_WARNING(
+            "Channel to {}:{} closes its connection with {} frames that were not acknowledged",
+            host,
+            port,
+            lockedConnection->inFlightFrames.size());
+    }
+
+    ::shutdown(lockedConnection->socket, SHUT_WR);
+    ::close(lockedConnection->socket);
+    lockedConnection->socket = -1;
+    lockedConnection->inFlightFrames.clear();
+}
+
+NetworkFlowControl::NetworkFlowControl(BackpressureController& backpressureController, const uint64_t maxInFlightBytes)
+    : backpressureController(backpressureController), maxInFlightBytes(maxInFlightBytes)
+{
+}
+
+void NetworkFlowControl::start(std::vector<NetworkChannel*> channels)
+{
+    this->channels = std::move(channels);
+    updateThread = std::jthread([this](const std::stop_token& stopToken) { run(stopToken); });
+}
+
+void NetworkFlowControl::update()
+{
+    uint64_t maxUsedCredits = 0;
+    for (auto* channel : channels)
+    {
+        maxUsedCredits = std::max(maxUsedCredits, channel->releaseCompletedFrames());
+    }
+
+    const std::scoped_lock lock(backpressureMutex);
+    if (not appliesBackpressure and maxUsedCredits > maxInFlightBytes)
+    {
+        NES_DEBUG("Network flow control applies backpressure, as {} bytes are not acknowledged", maxUsedCredits);
+        backpressureController.applyPressure();
+        appliesBackpressure = true;
+    }
+    else if (appliesBackpressure and maxUsedCredits <= maxInFlightBytes / 2)
+    {
+        backpressureController.releasePressure();
+        appliesBackpressure = false;
+    }
+}
+
+void NetworkFlowControl::run(const std::stop_token& stopToken)
+{
+    while (not stopToken.stop_requested())
+    {
+        update();
+        std::this_thread::sleep_for(UPDATE_INTERVAL);
+    }
+}
+
+void NetworkFlowControl::stop()
+{
+    updateThread = {};
+    const std::scoped_lock lock(backpressureMutex);
+    if (appliesBackpressure)
+    {
+        backpressureController.releasePressure();
+        appliesBackpressure = false;
+    }
+}
+
+}
@@ -0,0 +1,98 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Sinks/NetworkSink.hpp>
+
+#include <chrono>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <Configurations/Descriptor.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sinks/NetworkChannel.hpp>
+#include <Sinks/Sink.hpp>
+#include <Sinks/SinkDescriptor.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <fmt/format.h>
+#include <BackpressureChannel.hpp>
+#include <ErrorHandling.hpp>
+#include <PipelineExecutionContext.hpp>
+#include <SinkRegistry.hpp>
+#include <SinkValidationRegistry.hpp>
+
+namespace NES
+{
+
+NetworkSink::NetworkSink(BackpressureController backpressureController, const SinkDescriptor& sinkDescriptor)
+    : Sink(std::move(backpressureController))
+    , channel(
+          sinkDescriptor.getFromConfig(ConfigParametersNetwork::HOST),
+          sinkDescriptor.getFromConfig(ConfigParametersNetwork::PORT),
+          std::chrono::seconds(sinkDescriptor.getFromConfig(ConfigParametersNetwork::CONNECT_TIMEOUT)),
+          sinkDescriptor.getFromConfig(ConfigParametersNetwork::ZERO_COPY),
+          sinkDescriptor.getSchema()->getSizeOfSchemaInBytes())
+    , flowControl(this->backpressureController, sinkDescriptor.getFromConfig(ConfigParametersNetwork::MAX_IN_FLIGHT_BYTES))
+{
+    /// The NetworkSource decodes the frames via the native input formatter, without parsing a single value
+    if (sinkDescriptor.getFromConfig(SinkDescriptor::INPUT_FORMAT) != InputFormat::NATIVE)
+    {
+        throw InvalidConfigParameter("The network sink only supports the NATIVE input format");
+    }
+}
+
+std::ostream& NetworkSink::toString(std::ostream& str) const
+{
+    str << fmt::format("NetworkSink({})", channel);
+    return str;
+}
+
+void NetworkSink::start(PipelineExecutionContext&)
+{
+    NES_DEBUG("Setting up network sink: {}", *this);
+    channel.open();
+    flowControl.start({&channel});
+}
+
+void NetworkSink::execute(const TupleBuffer& inputTupleBuffer, PipelineExecutionContext&)
+{
+    PRECONDITION(inputTupleBuffer, "Invalid input buffer in NetworkSink.");
+    channel.send(inputTupleBuffer);
+    flowControl.update();
+}
+
+void NetworkSink::stop(PipelineExecutionContext&)
+{
+    NES_DEBUG("Closing network sink: {}", *this);
+    flowControl.stop();
+    channel.close();
+}
+
+DescriptorConfig::Config NetworkSink::validateAndFormat(std::unordered_map<std::string, std::string> config)
+{
+    return DescriptorConfig::validateAndFormat<ConfigParametersNetwork>(std::move(config), NAME);
+}
+
+SinkValidationRegistryReturnType RegisterNetworkSinkValidation(SinkValidationRegistryArguments sinkConfig)
+{
+    return NetworkSink::validateAndFormat(std::move(sinkConfig.config));
+}
+
+SinkRegistryReturnType RegisterNetworkSink(SinkRegistryArguments sinkRegistryArguments)
+{
+    return std::make_unique<NetworkSink>(std::move(sinkRegistryArguments.backpressureController), sinkRegistryArguments.sinkDescriptor);
+}
+
+}
@@ -0,0 +1,140 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Sinks/ParquetSink.hpp>
+
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <fmt/format.h>
+#include <magic_enum/magic_enum.hpp>
+
+#include <Configurations/Descriptor.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sinks/FrameCompressor.hpp>
+#include <Sinks/ParquetWriter.hpp>
+#include <Sinks/Sink.hpp>
+#include <Sinks/SinkDescriptor.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <BackpressureChannel.hpp>
+#include <ErrorHandling.hpp>
+#include <PipelineExecutionContext.hpp>
+#include <SinkRegistry.hpp>
+#include <SinkValidationRegistry.hpp>
+
+namespace NES
+{
+
+ParquetSink::ParquetSink(BackpressureController backpressureController, const SinkDescriptor& sinkDescriptor)
+    : Sink(std::move(backpressureController))
+    , outputFilePath(sinkDescriptor.getFromConfig(SinkDescriptor::FILE_PATH))
+    , schema(*sinkDescriptor.getSchema())
+    , isColumnar(sinkDescriptor.getFromConfig(ConfigParametersParquet::COLUMNAR_INPUT))
+    , rowGroupSize(sinkDescriptor.getFromConfig(ConfigParametersParquet::ROW_GROUP_SIZE))
+    , compressor(
+          sinkDescriptor.getFromConfig(ConfigParametersParquet::COMPRESSION),
+          sinkDescriptor.getFromConfig(ConfigParametersParquet::COMPRESSION_LEVEL))
+{
+    if (compressor.getCompression() == SinkCompression::LZ4)
+    {
+        throw InvalidConfigParameter("The Parquet sink only supports zstd compression");
+    }
+    for (size_t rowGroup = 0; rowGroup < NUMBER_OF_OPEN_ROW_GROUPS; ++rowGroup)
+    {
+        openRowGroups.push_back(std::make_unique<folly::Synchronized<ParquetRowGroup>>(ParquetRowGroup(schema, isColumnar)));
+    }
+}
+
+std::ostream& ParquetSink::toString(std::ostream& str) const
+{
+    str << fmt::format(
+        "ParquetSink(filePathOutput: {}, isColumnar: {}, rowGroupSize: {}, compression: {})",
+        outputFilePath,
+        isColumnar,
+        rowGroupSize,
+        magic_enum::enum_name(compressor.getCompression()));
+    return str;
+}
+
+void ParquetSink::start(PipelineExecutionContext&)
+{
+    NES_DEBUG("Setting up parquet sink: {}", *this);
+    fileWriter.wlock()->emplace(outputFilePath, schema, compressor.getCompression());
+}
+
+void ParquetSink::execute(const TupleBuffer& inputTupleBuffer, PipelineExecutionContext& pipelineExecutionContext)
+{
+    PRECONDITION(inputTupleBuffer, "Invalid input buffer in ParquetSink.");
+
+    auto& openRowGroup = *openRowGroups[pipelineExecutionContext.getId().getRawValue() % openRowGroups.size()];
+    std::optional<ParquetRowGroup> fullRowGroup;
+    {
+        const auto rowGroup = openRowGroup.wlock();
+        rowGroup->append(inputTupleBuffer);
+        if (rowGroup->getNumberOfRows() < rowGroupSize)
+        {
+            return;
+        }
+        fullRowGroup.emplace(std::exchange(*rowGroup, ParquetRowGroup(schema, isColumnar)));
+    }
+    writeRowGroup(*fullRowGroup);
+}
+
+void ParquetSink::writeRowGroup(const ParquetRowGroup& rowGroup)
+{
+    const auto encoded = rowGroup.encode(compressor);
+    const auto writer = fileWriter.wlock();
+    PRECONDITION(writer->has_value(), "Sink was not opened");
+    writer->value().write(encoded);
+}
+
+void ParquetSink::stop(PipelineExecutionContext&)
+{
+    NES_DEBUG("Closing parquet sink, filePathOutput={}", outputFilePath);
+    for (const auto& openRowGroup : openRowGroups)
+    {
+        const auto rowGroup = openRowGroup->wlock();
+        if (rowGroup->getNumberOfRows() > 0)
+        {
+            writeRowGroup(*rowGroup);
+            *rowGroup = ParquetRowGroup(schema, isColumnar);
+        }
+    }
+    const auto writer = fileWriter.wlock();
+    if (writer->has_value())
+    {
+        writer->value().close();
+    }
+}
+
+DescriptorConfig::Config ParquetSink::validateAndFormat(std::unordered_map<std::string, std::string> config)
+{
+    return DescriptorConfig::validateAndFormat<ConfigParametersParquet>(std::move(config), NAME);
+}
+
+SinkValidationRegistryReturnType RegisterParquetSinkValidation(SinkValidationRegistryArguments sinkConfig)
+{
+    return ParquetSink::validateAndFormat(std::move(sinkConfig.config));
+}
+
+SinkRegistryReturnType RegisterParquetSink(SinkRegistryArguments sinkRegistryArguments)
+{
+    return std::make_unique<ParquetSink>(std::move(sinkRegistryArguments.backpressureController), sinkRegistryArguments.sinkDescriptor);
+}
+
+}
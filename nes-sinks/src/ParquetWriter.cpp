@@ -0,0 +1,697 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Sinks/ParquetWriter.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Runtime/ColumnarLayout.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sinks/FrameCompressor.hpp>
+#include <SinksParsing/Format.hpp>
+
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+namespace
+{
+constexpr std::string_view MAGIC = "PAR1";
+constexpr std::string_view CREATED_BY = "NebulaStream";
+
+/// The subset of the enums of the Parquet format (parquet.thrift) that the writer uses
+enum class PhysicalType : int32_t
+{
+    BOOLEAN = 0,
+    INT32 = 1,
+    INT64 = 2,
+    FLOAT = 4,
+    DOUBLE = 5,
+    BYTE_ARRAY = 6
+};
+
+enum class ConvertedType : int32_t
+{
+    UTF8 = 0,
+    DECIMAL = 5,
+    TIMESTAMP_MILLIS = 9,
+    UINT_8 = 11,
+    UINT_16 = 12,
+    UINT_32 = 13,
+    UINT_64 = 14,
+    INT_8 = 15,
+    INT_16 = 16
+};
+
+enum class Encoding : int32_t
+{
+    PLAIN = 0,
+    RLE = 3
+};
+
+enum class CompressionCodec : int32_t
+{
+    UNCOMPRESSED = 0,
+    ZSTD = 6
+};
+
+constexpr int32_t REQUIRED = 0;
+constexpr int32_t OPTIONAL = 1;
+constexpr int32_t DATA_PAGE = 0;
+
+struct ParquetType
+{
+    PhysicalType physicalType;
+    std::optional<ConvertedType> convertedType;
+};
+
+ParquetType toParquetType(const DataType& type)
+{
+    switch (type.type)
+    {
+        case DataType::Type::UINT8:
+            return {.physicalType = PhysicalType::INT32, .convertedType = ConvertedType::UINT_8};
+        case DataType::Type::UINT16:
+            return {.physicalType = PhysicalType::INT32, .convertedType = ConvertedType::UINT_16};
+        case DataType::Type::UINT32:
+            return {.physicalType = PhysicalType::INT32, .convertedType = ConvertedType::UINT_32};
+        case DataType::Type::UINT64:
+            return {.physicalType = PhysicalType::INT64, .convertedType = ConvertedType::UINT_64};
+        case DataType::Type::INT8:
+            return {.physicalType = PhysicalType::INT32, .convertedType = ConvertedType::INT_8};
+        case DataType::Type::INT16:
+            return {.physicalType = PhysicalType::INT32, .convertedType = ConvertedType::INT_16};
+        case DataType::Type::INT32:
+            return {.physicalType = PhysicalType::INT32, .convertedType = std::nullopt};
+        case DataType::Type::INT64:
+        case DataType::Type::INTERVAL:
+            return {.physicalType = PhysicalType::INT64, .convertedType = std::nullopt};
+        case DataType::Type::TIMESTAMP:
+            return {.physicalType = PhysicalType::INT64, .convertedType = ConvertedType::TIMESTAMP_MILLIS};
+        case DataType::Type::DECIMAL:
+            return {.physicalType = PhysicalType::INT64, .convertedType = ConvertedType::DECIMAL};
+        case DataType::Type::FLOAT32:
+            return {.physicalType = PhysicalType::FLOAT, .convertedType = std::nullopt};
+        case DataType::Type::FLOAT64:
+            return {.physicalType = PhysicalType::DOUBLE, .convertedType = std::nullopt};
+        case DataType::Type::BOOLEAN:
+            return {.physicalType = PhysicalType::BOOLEAN, .convertedType = std::nullopt};
+        case DataType::Type::CHAR:
+        case DataType::Type::VARSIZED:
+            return {.physicalType = PhysicalType::BYTE_ARRAY, .convertedType = ConvertedType::UTF8};
+        case DataType::Type::UNDEFINED:
+            break;
+    }
+    throw UnknownDataType("The Parquet sink does not support fields of type {}", type);
+}
+
+/// Parquet stores the values of these types in the representation of NebulaStream, i.e., as little-endian values of the same width
+bool hasSameRepresentation(const DataType::Type type)
+{
+    switch (type)
+    {
+        case DataType::Type::UINT32:
+        case DataType::Type::UINT64:
+        case DataType::Type::INT32:
+        case DataType::Type::INT64:
+        case DataType::Type::FLOAT32:
+        case DataType::Type::FLOAT64:
+        case DataType::Type::TIMESTAMP:
+        case DataType::Type::INTERVAL:
+        case DataType::Type::DECIMAL:
+            return true;
+        default:
+            return false;
+    }
+}
+
+template <typename T>
+void appendLittleEndian(std::string& output, const T value)
+{
+    std::array<char, sizeof(T)> bytes{};
+    std::memcpy(bytes.data(), &value, sizeof(T));
+    output.append(bytes.data(), bytes.size());
+}
+
+/// Parquet stores integers narrower than 32 bit as INT32
+template <typename T>
+void appendAsInt32(std::string& output, const std::byte* field)
+{
+    T value;
+    std::memcpy(&value, field, sizeof(T));
+    appendLittleEndian(output, static_cast<int32_t>(value));
+}
+
+void appendVarint(std::string& output, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        output.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    output.push_back(static_cast<char>(value));
+}
+
+void appendByteArray(std::string& output, const std::string_view value)
+{
+    appendLittleEndian(output, static_cast<uint32_t>(value.size()));
+    output.append(value);
+}
+
+/// Serializes the structs of the Parquet metadata in the Thrift compact protocol
+class CompactProtocolWriter
+{
+public:
+    enum Type : uint8_t
+    {
+        I32 = 5,
+        I64 = 6,
+        BINARY = 8,
+        LIST = 9,
+        STRUCT = 12
+    };
+
+    explicit CompactProtocolWriter(std::string& output) : output(output) { }
+
+    void beginStruct() { lastFieldIds.push_back(0); }
+
+    void endStruct()
+    {
+        output.push_back(0);
+        lastFieldIds.pop_back();
+    }
+
+    void i32Field(const int16_t fieldId, const int32_t value)
+    {
+        fieldHeader(fieldId, I32);
+        i32Element(value);
+    }
+
+    void i64Field(const int16_t fieldId, const int64_t value)
+    {
+        fieldHeader(fieldId, I64);
+        varint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+
+    void binaryField(const int16_t fieldId, const std::string_view value)
+    {
+        fieldHeader(fieldId, BINARY);
+        binaryElement(value);
+    }
+
+    void structField(const int16_t fieldId)
+    {
+        fieldHeader(fieldId, STRUCT);
+        beginStruct();
+    }
+
+    /// The elements follow the header, with beginStruct and endStruct around every element of a list of structs
+    void listField(const int16_t fieldId, const Type elementType, const size_t size)
+    {
+        fieldHeader(fieldId, LIST);
+        if (size < 15)
+        {
+            output.push_back(static_cast<char>((size << 4) | elementType));
+            return;
+        }
+        output.push_back(static_cast<char>(0xF0 | elementType));
+        varint(size);
+    }
+
+    void i32Element(const int32_t value) { varint((static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31)); }
+
+    void binaryElement(const std::string_view value)
+    {
+        varint(value.size());
+        output.append(value);
+    }
+
+private:
+    void fieldHeader(const int16_t fieldId, const Type type)
+    {
+        const auto delta = fieldId - lastFieldIds.back();
+        if (delta > 0 and delta <= 15)
+        {
+            output.push_back(static_cast<char>((delta << 4) | type));
+        }
+        else
+        {
+            output.push_back(static_cast<char>(type));
+            i32Element(fieldId);
+        }
+        lastFieldIds.back() = fieldId;
+    }
+
+    void varint(const uint64_t value) { appendVarint(output, value); }
+
+    std::string& output;
+    std::vector<int16_t> lastFieldIds;
+};
+
+/// Encodes the definition levels (of bit width 1) in runs of the RLE/bit-packing hybrid, prefixed by their length (data page v1)
+void appendDefinitionLevels(std::string& page, const std::vector<uint8_t>& definitionLevels)
+{
+    const auto lengthOffset = page.size();
+    appendLittleEndian(page, uint32_t{0});
+    for (size_t runStart = 0; runStart < definitionLevels.size();)
+    {
+        size_t runEnd = runStart;
+        while (runEnd < definitionLevels.size() and definitionLevels[runEnd] == definitionLevels[runStart])
+        {
+            ++runEnd;
+        }
+        /// The header of an RLE run is its length shifted by one, followed by the repeated level in a single byte
+        appendVarint(page, (runEnd - runStart) << 1);
+        page.push_back(static_cast<char>(definitionLevels[runStart]));
+        runStart = runEnd;
+    }
+    const auto length = static_cast<uint32_t>(page.size() - lengthOffset - sizeof(uint32_t));
+    std::memcpy(page.data() + lengthOffset, &length, sizeof(length));
+}
+
+/// PLAIN encodes booleans as bits, starting with the least significant bit of every byte
+void appendBitPacked(std::string& page, const std::string_view booleans)
+{
+    for (size_t byteStart = 0; byteStart < booleans.size(); byteStart += 8)
+    {
+        uint8_t packed = 0;
+        for (size_t bit = 0; bit < 8 and byteStart + bit < booleans.size(); ++bit)
+        {
+            packed |= static_cast<uint8_t>((booleans[byteStart + bit] != 0 ? 1U : 0U) << bit);
+        }
+        page.push_back(static_cast<char>(packed));
+    }
+}
+
+/// Records the minimum and the maximum of the PLAIN encoded values in the order of their Parquet type, e.g., unsigned for UINT_32
+template <typename T>
+void recordStatistics(const std::string_view values, ParquetRowGroup::Encoded::ColumnChunk& columnChunk)
+{
+    std::optional<T> min;
+    std::optional<T> max;
+    for (size_t offset = 0; offset + sizeof(T) <= values.size(); offset += sizeof(T))
+    {
+        T value;
+        std::memcpy(&value, values.data() + offset, sizeof(T));
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            if (std::isnan(value))
+            {
+                continue;
+            }
+        }
+        min = min.has_value() ? std::min(*min, value) : value;
+        max = max.has_value() ? std::max(*max, value) : value;
+    }
+    if (min.has_value())
+    {
+        appendLittleEndian(columnChunk.minValue, *min);
+        appendLittleEndian(columnChunk.maxValue, *max);
+    }
+}
+
+void recordStatistics(const DataType& type, const std::string_view values, ParquetRowGroup::Encoded::ColumnChunk& columnChunk)
+{
+    switch (type.type)
+    {
+        case DataType::Type::UINT8:
+        case DataType::Type::UINT16:
+        case DataType::Type::INT8:
+        case DataType::Type::INT16:
+        case DataType::Type::INT32:
+            recordStatistics<int32_t>(values, columnChunk);
+            break;
+        case DataType::Type::UINT32:
+            recordStatistics<uint32_t>(values, columnChunk);
+            break;
+        case DataType::Type::UINT64:
+            recordStatistics<uint64_t>(values, columnChunk);
+            break;
+        case DataType::Type::INT64:
+        case DataType::Type::TIMESTAMP:
+        case DataType::Type::INTERVAL:
+        case DataType::Type::DECIMAL:
+            recordStatistics<int64_t>(values, columnChunk);
+            break;
+        case DataType::Type::FLOAT32:
+            recordStatistics<float>(values, columnChunk);
+            break;
+        case DataType::Type::FLOAT64:
+            recordStatistics<double>(values, columnChunk);
+            break;
+        default:
+            break;
+    }
+}
+
+int32_t toPageSize(const size_t size)
+{
+    if (size > std::numeric_limits<int32_t>::max())
+    {
+        throw CannotWriteSink("A column of the Parquet row group exceeds the maximum page size, consider a smaller row_group_size");
+    }
+    return static_cast<int32_t>(size);
+}
+}
+
+ParquetRowGroup::ParquetRowGroup(const Schema& schema, const bool isColumnar)
+    : schema(schema), tupleSize(schema.getSizeOfSchemaInBytes()), isColumnar(isColumnar)
+{
+    PRECONDITION(schema.hasFields(), "The Parquet sink expected a non-empty schema");
+    uint64_t offset = 0;
+    for (const auto& field : schema)
+    {
+        toParquetType(field.dataType);
+        columns.push_back({.type = field.dataType, .offsetInTuple = offset, .definitionLevels = {}, .values = {}});
+        offset += field.dataType.getSizeInBytesWithNull();
+    }
+}
+
+void ParquetRowGroup::append(const TupleBuffer& buffer)
+{
+    const auto numberOfTuples = buffer.getNumberOfTuples();
+    const auto* memory = buffer.getAvailableMemoryArea().data();
+    if (not isColumnar)
+    {
+        for (auto& column : columns)
+        {
+            appendColumn(column, buffer, memory + column.offsetInTuple, tupleSize, nullptr, numberOfTuples);
+        }
+        numberOfRows += numberOfTuples;
+        return;
+    }
+
+    /// All buffers of a sink usually have the same size, thus the row group only places the columns once
+    if (not columnarLayout.has_value() or columnarLayoutBufferSize != buffer.getBufferSize())
+    {
+        columnarLayout = ColumnarLayout::create(schema, buffer.getBufferSize());
+        columnarLayoutBufferSize = buffer.getBufferSize();
+    }
+    for (const auto& [column, layoutColumn] : std::views::zip(columns, columnarLayout->columns))
+    {
+        const auto* validityBitmap = layoutColumn.validityOffset.has_value() ? memory + layoutColumn.validityOffset.value() : nullptr;
+        appendColumn(column, buffer, memory + layoutColumn.valueOffset, layoutColumn.valueSize, validityBitmap, numberOfTuples);
+    }
+    numberOfRows += numberOfTuples;
+}
+
+void ParquetRowGroup::appendColumn(
+    Column& column,
+    const TupleBuffer& buffer,
+    const std::byte* firstValue,
+    const uint64_t stride,
+    const std::byte* validityBitmap,
+    const uint64_t numberOfTuples)
+{
+    const auto valueSize = column.type.getSizeInBytesWithoutNull();
+    if (not column.type.nullable and stride == valueSize and hasSameRepresentation(column.type.type))
+    {
+        column.values.append(reinterpret_cast<const char*>(firstValue), numberOfTuples * valueSize);
+        return;
+    }
+
+    for (uint64_t tuple = 0; tuple < numberOfTuples; ++tuple)
+    {
+        const auto* field = firstValue + (tuple * stride);
+        if (column.type.nullable)
+        {
+            /// Without a validity bitmap, the null byte precedes the value. Parquet only stores the values of present fields.
+            const bool isNull = validityBitmap != nullptr ? not ColumnarLayout::isValid(validityBitmap, tuple)
+                                                          : std::to_integer<uint8_t>(field[0]) != 0;
+            column.definitionLevels.push_back(isNull ? 0 : 1);
+            if (isNull)
+            {
+                continue;
+            }
+            if (validityBitmap == nullptr)
+            {
+                ++field;
+            }
+        }
+        switch (column.type.type)
+        {
+            case DataType::Type::UINT8:
+                appendAsInt32<uint8_t>(column.values, field);
+                break;
+            case DataType::Type::UINT16:
+                appendAsInt32<uint16_t>(column.values, field);
+                break;
+            case DataType::Type::INT8:
+                appendAsInt32<int8_t>(column.values, field);
+                break;
+            case DataType::Type::INT16:
+                appendAsInt32<int16_t>(column.values, field);
+                break;
+            case DataType::Type::BOOLEAN:
+                /// Bit-packed when the row group is encoded
+                column.values.push_back(static_cast<char>(field[0]));
+                break;
+            case DataType::Type::CHAR:
+                appendByteArray(column.values, std::string_view{reinterpret_cast<const char*>(field), 1});
+                break;
+            case DataType::Type::VARSIZED:
+                appendByteArray(column.values, Format::readVarSizedData(buffer, Format::readVariableSizedAccess(field)));
+                break;
+            default:
+                column.values.append(reinterpret_cast<const char*>(field), valueSize);
+                break;
+        }
+    }
+}
+
+ParquetRowGroup::Encoded ParquetRowGroup::encode(const FrameCompressor& compressor) const
+{
+    Encoded encoded{.bytes = {}, .columnChunks = {}, .numberOfRows = numberOfRows};
+    const bool isCompressed = compressor.getCompression() != SinkCompression::NONE;
+    std::string page;
+    std::string compressedPage;
+    std::string pageHeader;
+    for (const auto& column : columns)
+    {
+        /// Every column chunk consists of a single data page
+        page.clear();
+        if (column.type.nullable)
+        {
+            appendDefinitionLevels(page, column.definitionLevels);
+        }
+        if (column.type.type == DataType::Type::BOOLEAN)
+        {
+            appendBitPacked(page, column.values);
+        }
+        else
+        {
+            page.append(column.values);
+        }
+        if (isCompressed)
+        {
+            compressor.compress(page, compressedPage);
+        }
+        const auto& pageBody = isCompressed ? compressedPage : page;
+
+        pageHeader.clear();
+        CompactProtocolWriter header(pageHeader);
+        header.beginStruct();
+        header.i32Field(1, DATA_PAGE);
+        header.i32Field(2, toPageSize(page.size()));
+        header.i32Field(3, toPageSize(pageBody.size()));
+        header.structField(5);
+        header.i32Field(1, toPageSize(numberOfRows));
+        header.i32Field(2, static_cast<int32_t>(Encoding::PLAIN));
+        header.i32Field(3, static_cast<int32_t>(Encoding::RLE));
+        header.i32Field(4, static_cast<int32_t>(Encoding::RLE));
+        header.endStruct();
+        header.endStruct();
+
+        auto& columnChunk = encoded.columnChunks.emplace_back(
+            Encoded::ColumnChunk{
+                .offset = encoded.bytes.size(),
+                .uncompressedSize = pageHeader.size() + page.size(),
+                .compressedSize = pageHeader.size() + pageBody.size(),
+                .nullCount = static_cast<uint64_t>(std::ranges::count(column.definitionLevels, 0)),
+                .minValue = {},
+                .maxValue = {}});
+        recordStatistics(column.type, column.values, columnChunk);
+        encoded.bytes.append(pageHeader);
+        encoded.bytes.append(pageBody);
+    }
+    return encoded;
+}
+
+ParquetFileWriter::ParquetFileWriter(const std::string& filePath, const Schema& schema, const SinkCompression compression)
+    : filePath(filePath), schema(schema), compression(compression), file(filePath, std::ofstream::binary | std::ofstream::trunc)
+{
+    if (not file.is_open() or not file.good())
+    {
+        throw CannotOpenSink("Could not open the Parquet file {}", filePath);
+    }
+    file.write(MAGIC.data(), MAGIC.size());
+    fileOffset = MAGIC.size();
+}
+
+void ParquetFileWriter::write(const ParquetRowGroup::Encoded& rowGroup)
+{
+    file.write(rowGroup.bytes.data(), static_cast<std::streamsize>(rowGroup.bytes.size()));
+    if (not file.good())
+    {
+        throw CannotWriteSink("Could not write a row group of {} rows to the Parquet file {}", rowGroup.numberOfRows, filePath);
+    }
+    RowGroupMetadata metadata{.columnChunks = rowGroup.columnChunks, .numberOfRows = rowGroup.numberOfRows};
+    for (auto& columnChunk : metadata.columnChunks)
+    {
+        columnChunk.offset += fileOffset;
+    }
+    rowGroups.push_back(std::move(metadata));
+    fileOffset += rowGroup.bytes.size();
+}
+
+std::string ParquetFileWriter::encodeFileMetadata() const
+{
+    const auto codec = compression == SinkCompression::NONE ? CompressionCodec::UNCOMPRESSED : CompressionCodec::ZSTD;
+    std::string metadata;
+    CompactProtocolWriter writer(metadata);
+    writer.beginStruct();
+    writer.i32Field(1, 1);
+
+    /// The schema is a flat list of elements, in which the root element is the parent of the fields
+    writer.listField(2, CompactProtocolWriter::STRUCT, schema.getNumberOfFields() + 1);
+    writer.beginStruct();
+    writer.binaryField(4, "schema");
+    writer.i32Field(5, static_cast<int32_t>(schema.getNumberOfFields()));
+    writer.endStruct();
+    for (const auto& field : schema)
+    {
+        const auto [physicalType, convertedType] = toParquetType(field.dataType);
+        writer.beginStruct();
+        writer.i32Field(1, static_cast<int32_t>(physicalType));
+        writer.i32Field(3, field.dataType.nullable ? OPTIONAL : REQUIRED);
+        writer.binaryField(4, field.name);
+        if (convertedType.has_value())
+        {
+            writer.i32Field(6, static_cast<int32_t>(*convertedType));
+        }
+        if (field.dataType.isDecimal())
+        {
+            writer.i32Field(7, field.dataType.scale);
+            writer.i32Field(8, field.dataType.precision);
+        }
+        writer.endStruct();
+    }
+
+    uint64_t numberOfRows = 0;
+    for (const auto& rowGroup : rowGroups)
+    {
+        numberOfRows += rowGroup.numberOfRows;
+    }
+    writer.i64Field(3, static_cast<int64_t>(numberOfRows));
+
+    writer.listField(4, CompactProtocolWriter::STRUCT, rowGroups.size());
+    for (const auto& rowGroup : rowGroups)
+    {
+        writer.beginStruct();
+        writer.listField(1, CompactProtocolWriter::STRUCT, rowGroup.columnChunks.size());
+        uint64_t uncompressedSize = 0;
+        uint64_t compressedSize = 0;
+        for (size_t column = 0; column < rowGroup.columnChunks.size(); ++column)
+        {
+            const auto& field = schema.getFields().at(column);
+            const auto& columnChunk = rowGroup.columnChunks[column];
+            writer.beginStruct();
+            writer.i64Field(2, static_cast<int64_t>(columnChunk.offset));
+            writer.structField(3);
+            writer.i32Field(1, static_cast<int32_t>(toParquetType(field.dataType).physicalType));
+            writer.listField(2, CompactProtocolWriter::I32, field.dataType.nullable ? 2 : 1);
+            writer.i32Element(static_cast<int32_t>(Encoding::PLAIN));
+            if (field.dataType.nullable)
+            {
+                writer.i32Element(static_cast<int32_t>(Encoding::RLE));
+            }
+            writer.listField(3, CompactProtocolWriter::BINARY, 1);
+            writer.binaryElement(field.name);
+            writer.i32Field(4, static_cast<int32_t>(codec));
+            writer.i64Field(5, static_cast<int64_t>(rowGroup.numberOfRows));
+            writer.i64Field(6, static_cast<int64_t>(columnChunk.uncompressedSize));
+            writer.i64Field(7, static_cast<int64_t>(columnChunk.compressedSize));
+            writer.i64Field(9, static_cast<int64_t>(columnChunk.offset));
+            writer.structField(12);
+            writer.i64Field(3, static_cast<int64_t>(columnChunk.nullCount));
+            if (not columnChunk.minValue.empty())
+            {
+                writer.binaryField(5, columnChunk.maxValue);
+                writer.binaryField(6, columnChunk.minValue);
+            }
+            writer.endStruct();
+            writer.endStruct();
+            writer.endStruct();
+            uncompressedSize += columnChunk.uncompressedSize;
+            compressedSize += columnChunk.compressedSize;
+        }
+        writer.i64Field(2, static_cast<int64_t>(uncompressedSize));
+        writer.i64Field(3, static_cast<int64_t>(rowGroup.numberOfRows));
+        writer.i64Field(5, static_cast<int64_t>(rowGroup.columnChunks.front().offset));
+        writer.i64Field(6, static_cast<int64_t>(compressedSize));
+        writer.endStruct();
+    }
+    writer.binaryField(6, CREATED_BY);
+
+    /// Readers only trust the min_value and max_value of the statistics, if the column orders define their order (TypeDefinedOrder)
+    writer.listField(7, CompactProtocolWriter::STRUCT, schema.getNumberOfFields());
+    for (size_t column = 0; column < schema.getNumberOfFields(); ++column)
+    {
+        writer.beginStruct();
+        writer.structField(1);
+        writer.endStruct();
+        writer.endStruct();
+    }
+    writer.endStruct();
+    return metadata;
+}
+
+void ParquetFileWriter::close()
+{
+    if (not file.is_open())
+    {
+        return;
+    }
+    const auto metadata = encodeFileMetadata();
+    file.write(metadata.data(), static_cast<std::streamsize>(metadata.size()));
+    const auto metadataLength = static_cast<uint32_t>(metadata.size());
+    std::array<char, sizeof(metadataLength)> length{};
+    std::memcpy(length.data(), &metadataLength, sizeof(metadataLength));
+    file.write(length.data(), length.size());
+    file.write(MAGIC.data(), MAGIC.size());
+    file.close();
+    if (file.fail())
+    {
+        throw CannotWriteSink("Could not write the footer of the Parquet file {}", filePath);
+    }
+}
+
+}
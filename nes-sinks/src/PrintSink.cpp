@@ -14,13 +14,19 @@
 
 #include <Sinks/PrintSink.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <Configurations/Descriptor.hpp>
 #include <Runtime/TupleBuffer.hpp>
@@ -38,6 +44,12 @@
 namespace NES
 {
 
+namespace
+{
+/// Keeps its capacity across the buffers that a worker thread prints
+thread_local std::string tlFormattedBuffer;
+}
+
 PrintSink::PrintSink(BackpressureController backpressureController, const SinkDescriptor& sinkDescriptor)
     : Sink(std::move(backpressureController))
     , outputStream(&std::cout)
@@ -56,20 +68,68 @@ PrintSink::PrintSink(BackpressureController backpressureController, const SinkDe
     }
 }
 
-void PrintSink::start(PipelineExecutionContext&)
+void PrintSink::start(PipelineExecutionContext& pipelineExecutionContext)
 {
+    workerOutputs = std::vector<WorkerOutput>(std::max<size_t>(pipelineExecutionContext.getNumberOfWorkerThreads(), 1));
 }
 
 void PrintSink::stop(PipelineExecutionContext&)
 {
+    for (auto& workerOutput : workerOutputs)
+    {
+        const std::scoped_lock lock(workerOutput.mutex);
+        flush(workerOutput);
+    }
+    (*outputStream.wlock())->flush();
 }
 
-void PrintSink::execute(const TupleBuffer& inputBuffer, PipelineExecutionContext&)
+void PrintSink::flush(WorkerOutput& workerOutput)
+{
+    if (not workerOutput.buffer.empty())
+    {
+        *(*outputStream.wlock()) << workerOutput.buffer;
+        workerOutput.buffer.clear();
+    }
+    workerOutput.lastFlush = std::chrono::steady_clock::now();
+}
+
+void PrintSink::flushStaleOutputs(const std::chrono::steady_clock::time_point now)
+{
+    for (auto& workerOutput : workerOutputs)
+    {
+        const std::unique_lock lock(workerOutput.mutex, std::try_to_lock);
+        if (lock.owns_lock() and now - workerOutput.lastFlush >= WORKER_OUTPUT_FLUSH_INTERVAL)
+        {
+            flush(workerOutput);
+        }
+    }
+}
+
+void PrintSink::execute(const TupleBuffer& inputBuffer, PipelineExecutionContext& pipelineExecutionContext)
 {
     PRECONDITION(inputBuffer, "Invalid input buffer in PrintSink.");
 
-    const auto bufferAsString = outputParser->getFormattedBuffer(inputBuffer);
-    *(*outputStream.wlock()) << bufferAsString << '\n';
+    tlFormattedBuffer.clear();
+    outputParser->formatBuffer(inputBuffer, tlFormattedBuffer);
+    {
+        /// The output of a worker thread is only contended if there are more worker threads than outputs
+        auto& workerOutput = workerOutputs[pipelineExecutionContext.getId().getRawValue() % workerOutputs.size()];
+        const auto now = std::chrono::steady_clock::now();
+        bool flushedByTime = false;
+        {
+            const std::scoped_lock lock(workerOutput.mutex);
+            workerOutput.buffer.append(tlFormattedBuffer).push_back('\n');
+            flushedByTime = now - workerOutput.lastFlush >= WORKER_OUTPUT_FLUSH_INTERVAL;
+            if (flushedByTime or workerOutput.buffer.size() >= WORKER_OUTPUT_FLUSH_SIZE)
+            {
+                flush(workerOutput);
+            }
+        }
+        if (flushedByTime)
+        {
+            flushStaleOutputs(now);
+        }
+    }
     std::this_thread::sleep_for(std::chrono::milliseconds{ingestion});
 }
 
@@ -0,0 +1,276 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Sinks/RepartitionSink.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <Configurations/Descriptor.hpp>
+#include <DataTypes/DataType.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Runtime/VariableSizedAccess.hpp>
+#include <Sinks/NetworkChannel.hpp>
+#include <Sinks/NetworkSink.hpp>
+#include <Sinks/Sink.hpp>
+#include <Sinks/SinkDescriptor.hpp>
+#include <SinksParsing/Format.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Strings.hpp>
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <BackpressureChannel.hpp>
+#include <ErrorHandling.hpp>
+#include <PipelineExecutionContext.hpp>
+#include <SinkRegistry.hpp>
+#include <SinkValidationRegistry.hpp>
+#include <xxhash.h>
+
+namespace NES
+{
+
+std::optional<std::vector<RepartitionSink::Destination>> RepartitionSink::parseDestinations(const std::string_view destinations)
+{
+    std::vector<Destination> parsed;
+    for (const auto& destination : splitWithStringDelimiter<std::string>(destinations, ","))
+    {
+        const auto trimmed = trimWhiteSpaces(destination);
+        const auto separator = trimmed.rfind(':');
+        if (separator == std::string_view::npos or separator == 0)
+        {
+            return std::nullopt;
+        }
+        const auto port = from_chars<uint16_t>(trimmed.substr(separator + 1));
+        if (not port.has_value())
+        {
+            return std::nullopt;
+        }
+        parsed.push_back({.host = std::string(trimmed.substr(0, separator)), .port = *port});
+    }
+    if (parsed.empty())
+    {
+        return std::nullopt;
+    }
+    return parsed;
+}
+
+RepartitionSink::RepartitionSink(BackpressureController backpressureController, const SinkDescriptor& sinkDescriptor)
+    : Sink(std::move(backpressureController))
+    , sizeOfTuple(sinkDescriptor.getSchema()->getSizeOfSchemaInBytes())
+    , flowControl(this->backpressureController, sinkDescriptor.getFromConfig(ConfigParametersNetwork::MAX_IN_FLIGHT_BYTES))
+{
+    if (sinkDescriptor.getFromConfig(SinkDescriptor::INPUT_FORMAT) != InputFormat::NATIVE)
+    {
+        throw InvalidConfigParameter("The repartition sink only supports the NATIVE input format");
+    }
+
+    const auto& schema = *sinkDescriptor.getSchema();
+    std::unordered_map<std::string, Field> fields;
+    size_t offset = 0;
+    for (const auto& field : schema.getFields())
+    {
+        fields.emplace(field.name, Field{.type = field.dataType, .offset = offset});
+        if (field.dataType.type == DataType::Type::VARSIZED)
+        {
+            varSizedFields.push_back({.type = field.dataType, .offset = offset});
+        }
+        offset += field.dataType.getSizeInBytesWithNull();
+    }
+    const auto partitionKeyNames
+        = splitWithStringDelimiter<std::string>(sinkDescriptor.getFromConfig(ConfigParametersRepartition::PARTITION_KEYS), ",");
+    for (const auto& partitionKeyName : partitionKeyNames)
+    {
+        const auto field = schema.getFieldByName(std::string(trimWhiteSpaces(partitionKeyName)));
+        if (not field.has_value())
+        {
+            throw InvalidConfigParameter("The partition key {} is not a field of the schema {}", partitionKeyName, schema);
+        }
+        partitionKeys.push_back(fields.at(field->name));
+    }
+    if (partitionKeys.empty())
+    {
+        throw InvalidConfigParameter("The repartition sink requires at least one partition key");
+    }
+
+    const auto destinations = parseDestinations(sinkDescriptor.getFromConfig(ConfigParametersRepartition::DESTINATIONS));
+    INVARIANT(destinations.has_value(), "The validation of the repartition sink accepted invalid destinations");
+    for (const auto& [host, port] : *destinations)
+    {
+        channels.emplace_back(std::make_unique<NetworkChannel>(
+            host,
+            port,
+            std::chrono::seconds(sinkDescriptor.getFromConfig(ConfigParametersNetwork::CONNECT_TIMEOUT)),
+            sinkDescriptor.getFromConfig(ConfigParametersNetwork::ZERO_COPY),
+            sizeOfTuple));
+    }
+}
+
+std::ostream& RepartitionSink::toString(std::ostream& str) const
+{
+    str << fmt::format(
+        "RepartitionSink(partitionKeys: {}, channels: [{}])",
+        partitionKeys.size(),
+        fmt::join(channels | std::views::transform([](const auto& channel) { return fmt::format("{}", *channel); }), ", "));
+    return str;
+}
+
+void RepartitionSink::start(PipelineExecutionContext&)
+{
+    NES_DEBUG("Setting up repartition sink: {}", *this);
+    std::vector<NetworkChannel*> flowControlledChannels;
+    for (const auto& channel : channels)
+    {
+        channel->open();
+        flowControlledChannels.push_back(channel.get());
+    }
+    flowControl.start(std::move(flowControlledChannels));
+}
+
+size_t RepartitionSink::getPartition(const TupleBuffer& inputBuffer, const std::span<const std::byte> tuple) const
+{
+    /// Chains the hashes of the keys via the seed, so that the partition of a tuple only depends on the values of its keys. Null keys hash
+    /// their null byte only.
+    uint64_t hash = 0;
+    for (const auto& [type, offset] : partitionKeys)
+    {
+        auto value = tuple.subspan(offset, type.getSizeInBytesWithNull());
+        if (type.nullable)
+        {
+            if (std::to_integer<bool>(value[0]))
+            {
+                hash = XXH3_64bits_withSeed(value.data(), 1, hash);
+                continue;
+            }
+            value = value.subspan(1);
+        }
+        if (type.type == DataType::Type::VARSIZED)
+        {
+            const auto access = Format::readVariableSizedAccess(value.data());
+            const auto varSizedValue = Format::readVarSizedData(inputBuffer, access);
+            hash = XXH3_64bits_withSeed(varSizedValue.data(), varSizedValue.size(), hash);
+            continue;
+        }
+        hash = XXH3_64bits_withSeed(value.data(), value.size(), hash);
+    }
+    return hash % channels.size();
+}
+
+void RepartitionSink::append(PartitionBuffer& partitionBuffer, const TupleBuffer& inputBuffer, const std::span<const std::byte> tuple) const
+{
+    auto& buffer = partitionBuffer.buffer;
+    const auto numberOfTuples = buffer.getNumberOfTuples();
+    auto* const copiedTuple = buffer.getAvailableMemoryArea().data() + (numberOfTuples * sizeOfTuple);
+    std::ranges::copy(tuple, copiedTuple);
+    buffer.setNumberOfTuples(numberOfTuples + 1);
+
+    /// The copied tuple references the child buffers of the input buffer, which the partition buffer attaches on their first reference
+    for (const auto& [type, offset] : varSizedFields)
+    {
+        auto* const field = copiedTuple + offset;
+        if (type.nullable and std::to_integer<bool>(field[0]))
+        {
+            continue;
+        }
+        auto* const accessAddress = field + (type.nullable ? 1 : 0);
+        const auto access = Format::readVariableSizedAccess(accessAddress);
+        if (access.isInlined())
+        {
+            continue;
+        }
+        auto& childIndex = partitionBuffer.childIndexes[access.getIndex().getRawIndex()];
+        if (not childIndex.has_value())
+        {
+            auto childBuffer = inputBuffer.loadChildBuffer(access.getIndex());
+            childIndex = buffer.storeChildBuffer(childBuffer);
+        }
+        const auto relocatedAccess = access.relocate(*childIndex, access.getOffset());
+        std::memcpy(accessAddress, &relocatedAccess, sizeof(VariableSizedAccess));
+    }
+}
+
+void RepartitionSink::execute(const TupleBuffer& inputTupleBuffer, PipelineExecutionContext& pipelineExecutionContext)
+{
+    PRECONDITION(inputTupleBuffer, "Invalid input buffer in RepartitionSink.");
+    const auto numberOfTuples = inputTupleBuffer.getNumberOfTuples();
+    const auto tuples = inputTupleBuffer.getAvailableMemoryArea().first(numberOfTuples * sizeOfTuple);
+
+    std::vector<std::optional<PartitionBuffer>> partitionBuffers(channels.size());
+    for (uint64_t tupleIndex = 0; tupleIndex < numberOfTuples; ++tupleIndex)
+    {
+        const auto tuple = tuples.subspan(tupleIndex * sizeOfTuple, sizeOfTuple);
+        const auto partition = getPartition(inputTupleBuffer, tuple);
+        auto& partitionBuffer = partitionBuffers[partition];
+        if (not partitionBuffer.has_value())
+        {
+            partitionBuffer = PartitionBuffer{
+                .buffer = pipelineExecutionContext.allocateTupleBuffer(),
+                .childIndexes = std::vector<std::optional<VariableSizedAccess::Index>>(inputTupleBuffer.getNumberOfChildBuffers())};
+            partitionBuffer->buffer.setNumberOfTuples(0);
+            PRECONDITION(sizeOfTuple <= partitionBuffer->buffer.getBufferSize(), "A tuple of {} bytes does not fit a buffer", sizeOfTuple);
+        }
+        append(*partitionBuffer, inputTupleBuffer, tuple);
+        if ((partitionBuffer->buffer.getNumberOfTuples() + 1) * sizeOfTuple > partitionBuffer->buffer.getBufferSize())
+        {
+            channels[partition]->send(partitionBuffer->buffer);
+            partitionBuffer.reset();
+        }
+    }
+    for (size_t partition = 0; partition < channels.size(); ++partition)
+    {
+        if (partitionBuffers[partition].has_value())
+        {
+            channels[partition]->send(partitionBuffers[partition]->buffer);
+        }
+    }
+    flowControl.update();
+}
+
+void RepartitionSink::stop(PipelineExecutionContext&)
+{
+    NES_DEBUG("Closing repartition sink: {}", *this);
+    flowControl.stop();
+    for (const auto& channel : channels)
+    {
+        channel->close();
+    }
+}
+
+DescriptorConfig::Config RepartitionSink::validateAndFormat(std::unordered_map<std::string, std::string> config)
+{
+    return DescriptorConfig::validateAndFormat<ConfigParametersRepartition>(std::move(config), NAME);
+}
+
+SinkValidationRegistryReturnType RegisterRepartitionSinkValidation(SinkValidationRegistryArguments sinkConfig)
+{
+    return RepartitionSink::validateAndFormat(std::move(sinkConfig.config));
+}
+
+SinkRegistryReturnType RegisterRepartitionSink(SinkRegistryArguments sinkRegistryArguments)
+{
+    return std::make_unique<RepartitionSink>(std::move(sinkRegistryArguments.backpressureController), sinkRegistryArguments.sinkDescriptor);
+}
+
+}
@@ -0,0 +1,140 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Sinks/ResultStream.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <Util/Logger/Logger.hpp>
+#include <folly/Synchronized.h>
+#include <BackpressureChannel.hpp>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+namespace
+{
+/// The streams only live while a sink or a subscriber holds them
+folly::Synchronized<std::unordered_map<std::string, std::weak_ptr<ResultStream>>>& getStreams()
+{
+    static folly::Synchronized<std::unordered_map<std::string, std::weak_ptr<ResultStream>>> streams;
+    return streams;
+}
+}
+
+std::shared_ptr<ResultStream> ResultStream::get(const std::string& name)
+{
+    const auto streams = getStreams().wlock();
+    if (const auto it = streams->find(name); it != streams->end())
+    {
+        /// A closed stream still delivers its frames to its subscribers, but a new sink and its subscribers use a new stream
+        if (auto existing = it->second.lock(); existing and not existing->isClosed())
+        {
+            return existing;
+        }
+    }
+    std::erase_if(*streams, [](const auto& entry) { return entry.second.expired(); });
+    auto stream = std::make_shared<ResultStream>(name);
+    (*streams)[name] = stream;
+    return stream;
+}
+
+ResultStream::ResultStream(std::string name) : name(std::move(name))
+{
+}
+
+bool ResultStream::isClosed()
+{
+    const std::scoped_lock lock(mutex);
+    return closed;
+}
+
+void ResultStream::attach(BackpressureController& backpressureController, const size_t maxQueuedBytes)
+{
+    const std::scoped_lock lock(mutex);
+    if (this->backpressureController != nullptr)
+    {
+        throw CannotOpenSink("The result stream {} is already written by another sink", name);
+    }
+    this->backpressureController = &backpressureController;
+    this->maxQueuedBytes = maxQueuedBytes;
+}
+
+void ResultStream::detach()
+{
+    {
+        const std::scoped_lock lock(mutex);
+        if (appliesBackpressure)
+        {
+            backpressureController->releasePressure();
+            appliesBackpressure = false;
+        }
+        backpressureController = nullptr;
+        closed = true;
+    }
+    framesAvailable.notify_all();
+}
+
+void ResultStream::push(std::string frame)
+{
+    {
+        const std::scoped_lock lock(mutex);
+        PRECONDITION(backpressureController != nullptr, "Pushed a frame into the result stream {} without attaching to it", name);
+        queuedBytes += frame.size();
+        frames.emplace_back(std::move(frame));
+        if (not appliesBackpressure and queuedBytes > maxQueuedBytes)
+        {
+            NES_DEBUG("Result stream {} applies backpressure with {} queued bytes", name, queuedBytes);
+            backpressureController->applyPressure();
+            appliesBackpressure = true;
+        }
+    }
+    framesAvailable.notify_one();
+}
+
+std::optional<std::vector<std::string>> ResultStream::pop(const size_t maxFrames, const std::chrono::milliseconds timeout)
+{
+    std::unique_lock lock(mutex);
+    framesAvailable.wait_for(lock, timeout, [this] { return not frames.empty() or closed; });
+    if (frames.empty() and closed)
+    {
+        return std::nullopt;
+    }
+
+    std::vector<std::string> batch;
+    batch.reserve(std::min(maxFrames, frames.size()));
+    while (not frames.empty() and batch.size() < maxFrames)
+    {
+        queuedBytes -= frames.front().size();
+        batch.emplace_back(std::move(frames.front()));
+        frames.pop_front();
+    }
+    if (appliesBackpressure and queuedBytes <= maxQueuedBytes / 2)
+    {
+        backpressureController->releasePressure();
+        appliesBackpressure = false;
+    }
+    return batch;
+}
+
+}
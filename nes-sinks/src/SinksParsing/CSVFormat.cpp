@@ -14,21 +14,14 @@
 
 #include <SinksParsing/CSVFormat.hpp>
 
-#include <bit>
 #include <cstddef>
-#include <cstdint>
 #include <ostream>
-#include <ranges>
-#include <span>
-#include <sstream>
 #include <string>
+#include <DataTypes/DataType.hpp>
 #include <DataTypes/Schema.hpp>
 #include <Runtime/TupleBuffer.hpp>
-#include <Runtime/VariableSizedAccess.hpp>
 #include <SinksParsing/Format.hpp>
 #include <fmt/format.h>
-#include <fmt/ranges.h>
-#include <magic_enum/magic_enum.hpp>
 
 #include <ErrorHandling.hpp>
 
@@ -52,61 +45,52 @@ CSVFormat::CSVFormat(const Schema& pSchema, const bool escapeStrings) : Format(p
     formattingContext.schemaSizeInBytes = schema.getSizeOfSchemaInBytes();
 }
 
-std::string CSVFormat::getFormattedBuffer(const TupleBuffer& inputBuffer) const
+void CSVFormat::formatBuffer(const TupleBuffer& inputBuffer, std::string& output) const
 {
-    return tupleBufferToFormattedCSVString(inputBuffer, formattingContext);
-}
-
-std::string CSVFormat::tupleBufferToFormattedCSVString(TupleBuffer tbuffer, const FormattingContext& formattingContext) const
-{
-    std::stringstream ss;
-    const auto numberOfTuples = tbuffer.getNumberOfTuples();
-    const auto buffer = tbuffer.getAvailableMemoryArea().subspan(0, numberOfTuples * formattingContext.schemaSizeInBytes);
+    const auto numberOfTuples = inputBuffer.getNumberOfTuples();
+    const auto buffer = inputBuffer.getAvailableMemoryArea().subspan(0, numberOfTuples * formattingContext.schemaSizeInBytes);
     for (size_t i = 0; i < numberOfTuples; i++)
     {
-        auto tuple = buffer.subspan(i * formattingContext.schemaSizeInBytes, formattingContext.schemaSizeInBytes);
-        auto fields
-            = std::views::iota(static_cast<size_t>(0), formattingContext.offsets.size())
-            | std::views::transform(
-                  [&formattingContext, &tuple, &tbuffer, copyOfEscapeStrings = escapeStrings](const auto& index) -> std::string
-                  {
-                      const auto physicalType = formattingContext.physicalTypes[index];
-                      auto fieldValueStart = tuple.subspan(formattingContext.offsets[index], physicalType.getSizeInBytesWithNull());
-                      if (physicalType.nullable)
-                      {
-                          /// Convert byte to bool: true if byte is non-zero, false otherwise
-                          const bool isNull = static_cast<bool>(std::to_integer<int>(fieldValueStart[0]));
-                          fieldValueStart = fieldValueStart.subspan(1);
-                          if (isNull)
-                          {
-                              /// We need to write null, as otherwise, we can not detect a single null in our output
-                              return "NULL";
-                          }
-                      }
-
-                      if (physicalType.type == DataType::Type::VARSIZED)
-                      {
-                          const auto base = formattingContext.offsets[index] + physicalType.nullable;
-                          const auto* indexPtr = std::bit_cast<const uint32_t*>(&tuple[base + offsetof(VariableSizedAccess, index)]);
-                          const auto* offsetPtr = std::bit_cast<const uint32_t*>(&tuple[base + offsetof(VariableSizedAccess, offset)]);
-                          const auto* sizePtr = std::bit_cast<const uint64_t*>(&tuple[base + offsetof(VariableSizedAccess, size)]);
+        const auto tuple = buffer.subspan(i * formattingContext.schemaSizeInBytes, formattingContext.schemaSizeInBytes);
+        for (size_t index = 0; index < formattingContext.offsets.size(); ++index)
+        {
+            if (index != 0)
+            {
+                output.push_back(',');
+            }
+            const auto& physicalType = formattingContext.physicalTypes[index];
+            auto fieldValueStart = tuple.subspan(formattingContext.offsets[index], physicalType.getSizeInBytesWithNull());
+            if (physicalType.nullable)
+            {
+                /// Convert byte to bool: true if byte is non-zero, false otherwise
+                const bool isNull = static_cast<bool>(std::to_integer<int>(fieldValueStart[0]));
+                fieldValueStart = fieldValueStart.subspan(1);
+                if (isNull)
+                {
+                    /// We need to write null, as otherwise, we can not detect a single null in our output
+                    output.append("NULL");
+                    continue;
+                }
+            }
 
-                          const VariableSizedAccess variableSizedAccess{
-                              VariableSizedAccess::Index(*indexPtr),
-                              VariableSizedAccess::Offset(*offsetPtr),
-                              VariableSizedAccess::Size(*sizePtr)};
-                          auto varSizedData = readVarSizedDataAsString(tbuffer, variableSizedAccess);
-                          if (copyOfEscapeStrings)
-                          {
-                              return "\"" + varSizedData + "\"";
-                          }
-                          return varSizedData;
-                      }
-                      return physicalType.formattedBytesToString(fieldValueStart.data());
-                  });
-        ss << fmt::format("{}\n", fmt::join(fields, ","));
+            if (physicalType.type == DataType::Type::VARSIZED)
+            {
+                const auto varSizedAccess = readVariableSizedAccess(fieldValueStart.data());
+                const auto varSizedData = readVarSizedData(inputBuffer, varSizedAccess);
+                if (escapeStrings)
+                {
+                    output.push_back('"');
+                    output.append(varSizedData);
+                    output.push_back('"');
+                    continue;
+                }
+                output.append(varSizedData);
+                continue;
+            }
+            appendFormattedValue(output, physicalType, fieldValueStart.data());
+        }
+        output.push_back('\n');
     }
-    return ss.str();
 }
 
 std::ostream& operator<<(std::ostream& out, const CSVFormat& format)
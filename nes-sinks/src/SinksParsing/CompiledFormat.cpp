@@ -0,0 +1,49 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <SinksParsing/CompiledFormat.hpp>
+
+#include <ostream>
+#include <string>
+#include <DataTypes/Schema.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <SinksParsing/Format.hpp>
+#include <fmt/format.h>
+
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+CompiledFormat::CompiledFormat(const Schema& schema) : Format(schema)
+{
+}
+
+void CompiledFormat::formatBuffer(const TupleBuffer& inputBuffer, std::string& output) const
+{
+    const auto formattedRows = inputBuffer.getAvailableMemoryArea<char>();
+    INVARIANT(
+        inputBuffer.getNumberOfTuples() <= formattedRows.size(),
+        "Formatted buffer claims {} bytes, but has a capacity of {} bytes",
+        inputBuffer.getNumberOfTuples(),
+        formattedRows.size());
+    output.append(formattedRows.data(), inputBuffer.getNumberOfTuples());
+}
+
+std::ostream& operator<<(std::ostream& out, const CompiledFormat& format)
+{
+    return out << fmt::format("CompiledFormat(Schema: {})", format.schema);
+}
+
+}
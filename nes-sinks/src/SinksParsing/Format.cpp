@@ -0,0 +1,155 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <SinksParsing/Format.hpp>
+
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Decimal.hpp>
+#include <Runtime/VariableSizedAccess.hpp>
+#include <fmt/format.h>
+
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+namespace
+{
+template <typename T>
+T readValue(const std::byte* data)
+{
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+}
+
+template <typename T>
+void Format::appendValue(std::string& output, const T value)
+{
+    if constexpr (std::same_as<T, bool>)
+    {
+        output.push_back(value ? '1' : '0');
+    }
+    else if constexpr (std::same_as<T, char>)
+    {
+        output.push_back(value);
+    }
+    else if constexpr (std::integral<T>)
+    {
+        std::array<char, std::numeric_limits<T>::digits10 + 3> characters{};
+        const auto [end, errorCode] = std::to_chars(characters.data(), characters.data() + characters.size(), value);
+        INVARIANT(errorCode == std::errc{}, "Could not format integer {}", value);
+        output.append(characters.data(), end);
+    }
+    else
+    {
+        static_assert(std::floating_point<T>, "Expected the C++ type of a fixed-size data type");
+        /// Formats like formatFloat, i.e., with six decimals, but without trailing zeros (keeping at least one decimal).
+        /// The inline storage of the memory buffer fits the six decimals of all but the largest doubles
+        fmt::memory_buffer characters;
+        fmt::format_to(std::back_inserter(characters), "{:.6f}", value);
+        const std::string_view formatted{characters.data(), characters.size()};
+        const size_t decimalPos = formatted.find('.');
+        if (decimalPos == std::string_view::npos)
+        {
+            output.append(formatted);
+            return;
+        }
+        const size_t lastNonZero = formatted.find_last_not_of('0');
+        output.append(formatted.substr(0, lastNonZero == decimalPos ? decimalPos + 2 : lastNonZero + 1));
+    }
+}
+
+template void Format::appendValue<int8_t>(std::string&, int8_t);
+template void Format::appendValue<uint8_t>(std::string&, uint8_t);
+template void Format::appendValue<int16_t>(std::string&, int16_t);
+template void Format::appendValue<uint16_t>(std::string&, uint16_t);
+template void Format::appendValue<int32_t>(std::string&, int32_t);
+template void Format::appendValue<uint32_t>(std::string&, uint32_t);
+template void Format::appendValue<int64_t>(std::string&, int64_t);
+template void Format::appendValue<uint64_t>(std::string&, uint64_t);
+template void Format::appendValue<float>(std::string&, float);
+template void Format::appendValue<double>(std::string&, double);
+template void Format::appendValue<bool>(std::string&, bool);
+template void Format::appendValue<char>(std::string&, char);
+
+void Format::appendDecimal(std::string& output, const int64_t unscaledValue, const uint8_t scale)
+{
+    Decimal::appendFormatted(output, unscaledValue, scale);
+}
+
+VariableSizedAccess Format::readVariableSizedAccess(const std::byte* field)
+{
+    VariableSizedAccess access;
+    std::memcpy(&access, field, sizeof(access));
+    return access;
+}
+
+void Format::appendFormattedValue(std::string& output, const DataType& physicalType, const std::byte* data)
+{
+    PRECONDITION(data != nullptr, "Pointer to data is invalid.");
+    switch (physicalType.type)
+    {
+        case DataType::Type::INT8:
+            return appendValue(output, readValue<int8_t>(data));
+        case DataType::Type::UINT8:
+            return appendValue(output, readValue<uint8_t>(data));
+        case DataType::Type::INT16:
+            return appendValue(output, readValue<int16_t>(data));
+        case DataType::Type::UINT16:
+            return appendValue(output, readValue<uint16_t>(data));
+        case DataType::Type::INT32:
+            return appendValue(output, readValue<int32_t>(data));
+        case DataType::Type::UINT32:
+            return appendValue(output, readValue<uint32_t>(data));
+        case DataType::Type::INT64:
+        case DataType::Type::INTERVAL:
+            return appendValue(output, readValue<int64_t>(data));
+        case DataType::Type::UINT64:
+        case DataType::Type::TIMESTAMP:
+            return appendValue(output, readValue<uint64_t>(data));
+        case DataType::Type::DECIMAL:
+            return appendDecimal(output, readValue<int64_t>(data), physicalType.scale);
+        case DataType::Type::FLOAT32:
+            return appendValue(output, readValue<float>(data));
+        case DataType::Type::FLOAT64:
+            return appendValue(output, readValue<double>(data));
+        case DataType::Type::BOOLEAN:
+            return appendValue(output, std::to_integer<uint8_t>(*data) != 0);
+        case DataType::Type::CHAR:
+            return appendValue(output, static_cast<char>(*data));
+        case DataType::Type::VARSIZED:
+            output.append(reinterpret_cast<const char*>(data)); ///NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            return;
+        case DataType::Type::UNDEFINED:
+            output.append("invalid physical type");
+            return;
+    }
+    std::unreachable();
+}
+
+}
@@ -15,18 +15,13 @@
 #include <SinksParsing/JSONFormat.hpp>
 
 #include <cstddef>
-#include <cstdint>
 #include <iostream>
-#include <ranges>
-#include <span>
-#include <sstream>
 #include <string>
+#include <DataTypes/DataType.hpp>
 #include <DataTypes/Schema.hpp>
 #include <Runtime/TupleBuffer.hpp>
-#include <Runtime/VariableSizedAccess.hpp>
 #include <SinksParsing/Format.hpp>
 #include <fmt/format.h>
-#include <fmt/ranges.h>
 
 #include <ErrorHandling.hpp>
 
@@ -48,58 +43,48 @@ JSONFormat::JSONFormat(const Schema& pSchema) : Format(pSchema)
     formattingContext.schemaSizeInBytes = schema.getSizeOfSchemaInBytes();
 }
 
-std::string JSONFormat::getFormattedBuffer(const TupleBuffer& inputBuffer) const
+void JSONFormat::formatBuffer(const TupleBuffer& inputBuffer, std::string& output) const
 {
-    return tupleBufferToFormattedJSONString(inputBuffer, formattingContext);
-}
-
-std::string JSONFormat::tupleBufferToFormattedJSONString(TupleBuffer tbuffer, const FormattingContext& formattingContext)
-{
-    std::stringstream ss;
-    const auto numberOfTuples = tbuffer.getNumberOfTuples();
-    const auto buffer = tbuffer.getAvailableMemoryArea().subspan(0, numberOfTuples * formattingContext.schemaSizeInBytes);
+    const auto numberOfTuples = inputBuffer.getNumberOfTuples();
+    const auto buffer = inputBuffer.getAvailableMemoryArea().subspan(0, numberOfTuples * formattingContext.schemaSizeInBytes);
     for (size_t i = 0; i < numberOfTuples; i++)
     {
-        auto tuple = buffer.subspan(i * formattingContext.schemaSizeInBytes, formattingContext.schemaSizeInBytes);
-        auto fields
-            = std::views::iota(static_cast<size_t>(0), formattingContext.offsets.size())
-            | std::views::transform(
-                  [&formattingContext, &tuple, &tbuffer](const auto& index) -> std::string
-                  {
-                      auto type = formattingContext.physicalTypes[index];
-                      auto fieldValueStart = tuple.subspan(formattingContext.offsets[index]);
-                      if (type.nullable)
-                      {
-                          /// Convert byte to bool: true if byte is non-zero, false otherwise
-                          const bool isNull = static_cast<bool>(std::to_integer<int>(fieldValueStart[0]));
-                          fieldValueStart = fieldValueStart.subspan(1);
-                          if (isNull)
-                          {
-                              /// We need to write null, as otherwise, we can not detect a single null in our output
-                              return "NULL";
-                          }
-                      }
-                      if (type.type == DataType::Type::VARSIZED)
-                      {
-                          const auto base = formattingContext.offsets[index] + type.nullable;
-                          const auto* indexPtr = std::bit_cast<const uint32_t*>(&tuple[base + offsetof(VariableSizedAccess, index)]);
-                          const auto* offsetPtr = std::bit_cast<const uint32_t*>(&tuple[base + offsetof(VariableSizedAccess, offset)]);
-                          const auto* sizePtr = std::bit_cast<const uint64_t*>(&tuple[base + offsetof(VariableSizedAccess, size)]);
-
-                          const VariableSizedAccess variableSizedAccess{
-                              VariableSizedAccess::Index(*indexPtr),
-                              VariableSizedAccess::Offset(*offsetPtr),
-                              VariableSizedAccess::Size(*sizePtr)};
-                          const auto varSizedData = readVarSizedDataAsString(tbuffer, variableSizedAccess);
-                          return fmt::format(R"("{}":"{}")", formattingContext.names.at(index), varSizedData);
-                      }
-                      return fmt::format(
-                          "\"{}\":{}", formattingContext.names.at(index), type.formattedBytesToString(fieldValueStart.data()));
-                  });
-
-        ss << fmt::format("{{{}}}\n", fmt::join(fields, ","));
+        const auto tuple = buffer.subspan(i * formattingContext.schemaSizeInBytes, formattingContext.schemaSizeInBytes);
+        output.push_back('{');
+        for (size_t index = 0; index < formattingContext.offsets.size(); ++index)
+        {
+            if (index != 0)
+            {
+                output.push_back(',');
+            }
+            const auto& type = formattingContext.physicalTypes[index];
+            auto fieldValueStart = tuple.subspan(formattingContext.offsets[index]);
+            if (type.nullable)
+            {
+                /// Convert byte to bool: true if byte is non-zero, false otherwise
+                const bool isNull = static_cast<bool>(std::to_integer<int>(fieldValueStart[0]));
+                fieldValueStart = fieldValueStart.subspan(1);
+                if (isNull)
+                {
+                    /// We need to write null, as otherwise, we can not detect a single null in our output
+                    output.append("NULL");
+                    continue;
+                }
+            }
+            output.push_back('"');
+            output.append(formattingContext.names[index]);
+            output.append("\":");
+            if (type.type == DataType::Type::VARSIZED)
+            {
+                output.push_back('"');
+                output.append(readVarSizedData(inputBuffer, readVariableSizedAccess(fieldValueStart.data())));
+                output.push_back('"');
+                continue;
+            }
+            appendFormattedValue(output, type, fieldValueStart.data());
+        }
+        output.append("}\n");
     }
-    return ss.str();
 }
 
 std::ostream& operator<<(std::ostream& out, const JSONFormat& format)
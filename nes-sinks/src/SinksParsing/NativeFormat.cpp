@@ -0,0 +1,103 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <SinksParsing/NativeFormat.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+#include <DataTypes/Schema.hpp>
+#include <Runtime/NativeFrameHeader.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Runtime/VariableSizedAccess.hpp>
+#include <SinksParsing/Format.hpp>
+#include <fmt/format.h>
+
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+
+namespace
+{
+template <typename T>
+void appendBytes(std::string& frame, const T& value)
+{
+    frame.append(reinterpret_cast<const char*>(&value), sizeof(T)); ///NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+void appendBytes(std::string& frame, const std::span<const std::byte> bytes)
+{
+    frame.append(reinterpret_cast<const char*>(bytes.data()), bytes.size()); ///NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+}
+
+NativeFormat::NativeFormat(const Schema& pSchema) : Format(pSchema), sizeOfTuple(pSchema.getSizeOfSchemaInBytes())
+{
+    PRECONDITION(schema.getNumberOfFields() != 0, "Formatter expected a non-empty schema");
+    PRECONDITION(
+        sizeOfTuple <= std::numeric_limits<uint32_t>::max(), "The native format does not support tuples of {} bytes", sizeOfTuple);
+}
+
+void NativeFormat::formatBuffer(const TupleBuffer& inputBuffer, std::string& output) const
+{
+    const auto numberOfTuples = inputBuffer.getNumberOfTuples();
+    const auto numberOfChildBuffers = inputBuffer.getNumberOfChildBuffers();
+    const auto tuples = inputBuffer.getAvailableMemoryArea().first(numberOfTuples * sizeOfTuple);
+
+    /// Child buffers that store var-sized data store their number of used bytes in their number of tuples (see TupleBufferRef)
+    std::vector<std::span<const std::byte>> childBuffers;
+    std::vector<TupleBuffer> loadedChildBuffers;
+    size_t sizeOfFrame = sizeof(NativeFrameHeader) + tuples.size();
+    for (uint32_t childIndex = 0; childIndex < numberOfChildBuffers; ++childIndex)
+    {
+        const auto& childBuffer = loadedChildBuffers.emplace_back(inputBuffer.loadChildBuffer(VariableSizedAccess::Index{childIndex}));
+        const auto usedBytes = std::min(childBuffer.getNumberOfTuples(), childBuffer.getBufferSize());
+        childBuffers.emplace_back(childBuffer.getAvailableMemoryArea().first(usedBytes));
+        sizeOfFrame += sizeof(uint64_t) + usedBytes;
+    }
+
+    const auto frameStart = output.size();
+    output.reserve(frameStart + sizeOfFrame);
+    appendBytes(
+        output,
+        NativeFrameHeader{
+            .magic = NativeFrameHeader::MAGIC,
+            .sizeOfTuple = static_cast<uint32_t>(sizeOfTuple),
+            .numberOfTuples = numberOfTuples,
+            .numberOfChildBuffers = numberOfChildBuffers});
+    appendBytes(output, tuples);
+    for (const auto& childBuffer : childBuffers)
+    {
+        appendBytes(output, static_cast<uint64_t>(childBuffer.size()));
+        appendBytes(output, childBuffer);
+    }
+    INVARIANT(
+        output.size() - frameStart == sizeOfFrame,
+        "Expected a frame of {} bytes, but wrote {} bytes",
+        sizeOfFrame,
+        output.size() - frameStart);
+}
+
+std::ostream& operator<<(std::ostream& out, const NativeFormat& format)
+{
+    return out << fmt::format("NativeFormat(Schema: {})", format.schema);
+}
+
+}
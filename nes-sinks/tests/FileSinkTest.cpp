@@ -0,0 +1,438 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <lz4frame.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zstd.h>
+
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Runtime/BufferManager.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sinks/AsyncFileWriter.hpp>
+#include <Sinks/FileSink.hpp>
+#include <Sinks/FrameCompressor.hpp>
+#include <Sinks/SinkCatalog.hpp>
+#include <SinksParsing/CSVFormat.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <magic_enum/magic_enum.hpp>
+#include <BackpressureChannel.hpp>
+#include <BaseUnitTest.hpp>
+#include <ErrorHandling.hpp>
+#include <TestTaskQueue.hpp>
+
+namespace NES
+{
+
+class FileSinkTest : public Testing::BaseUnitTest
+{
+public:
+    static constexpr uint64_t BUFFER_SIZE = 4096;
+    static constexpr uint64_t TUPLES_PER_BUFFER = 16;
+    static constexpr size_t DIRECT_IO_ALIGNMENT = 4096;
+    static constexpr std::chrono::milliseconds TIMEOUT{10000};
+
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("FileSinkTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup FileSinkTest class.");
+    }
+
+    void SetUp() override
+    {
+        Testing::BaseUnitTest::SetUp();
+        bufferManager = BufferManager::create(BUFFER_SIZE, 64);
+        schema = Schema{}.addField("stream$id", DataType::Type::UINT64).addField("stream$value", DataType::Type::UINT64);
+        /// The working directory of the tests, as the temporary directory may be a tmpfs, which does not support direct I/O
+        outputPath = std::filesystem::current_path()
+            / fmt::format("FileSinkTest_{}.out", ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove(outputPath);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(outputPath);
+        Testing::BaseUnitTest::TearDown();
+    }
+
+    [[nodiscard]] TupleBuffer createInputBuffer(const uint64_t bufferIndex) const
+    {
+        auto buffer = bufferManager->getBufferBlocking();
+        for (uint64_t tupleIndex = 0; tupleIndex < TUPLES_PER_BUFFER; ++tupleIndex)
+        {
+            const std::array<uint64_t, 2> values{(bufferIndex * TUPLES_PER_BUFFER) + tupleIndex, bufferIndex};
+            std::memcpy(buffer.getAvailableMemoryArea().data() + (tupleIndex * sizeof(values)), values.data(), sizeof(values));
+        }
+        buffer.setNumberOfTuples(TUPLES_PER_BUFFER);
+        return buffer;
+    }
+
+    /// The CSV output of the input buffers [first, last), preceded by the schema, if requested
+    [[nodiscard]] std::string getExpectedOutput(const uint64_t first, const uint64_t last, const bool withSchema = true) const
+    {
+        const CSVFormat format(schema);
+        std::string output = withSchema ? format.getFormattedSchema() : "";
+        for (uint64_t bufferIndex = first; bufferIndex < last; ++bufferIndex)
+        {
+            format.formatBuffer(createInputBuffer(bufferIndex), output);
+        }
+        return output;
+    }
+
+    [[nodiscard]] std::unique_ptr<FileSink>
+    createSink(BackpressureController backpressureController, std::unordered_map<std::string, std::string> config) const
+    {
+        config.emplace("file_path", outputPath.string());
+        config.emplace("input_format", "CSV");
+        const auto sinkDescriptor = SinkCatalog{}.getInlineSink(schema, FileSink::NAME, std::move(config));
+        EXPECT_TRUE(sinkDescriptor.has_value());
+        /// NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+        return std::make_unique<FileSink>(std::move(backpressureController), *sinkDescriptor);
+    }
+
+    [[nodiscard]] TestPipelineExecutionContext createPipelineExecutionContext() const
+    {
+        return TestPipelineExecutionContext(bufferManager, std::make_shared<std::vector<std::vector<TupleBuffer>>>(1));
+    }
+
+    /// Starts a sink, writes the input buffers [first, last), and stops the sink
+    void writeBuffers(const std::unordered_map<std::string, std::string>& config, const uint64_t first, const uint64_t last) const
+    {
+        auto [backpressureController, backpressureListener] = createBackpressureChannel();
+        const auto sink = createSink(std::move(backpressureController), config);
+        auto pec = createPipelineExecutionContext();
+        sink->start(pec);
+        for (uint64_t bufferIndex = first; bufferIndex < last; ++bufferIndex)
+        {
+            sink->execute(createInputBuffer(bufferIndex), pec);
+        }
+        sink->stop(pec);
+    }
+
+    [[nodiscard]] std::string readOutput() const
+    {
+        std::ifstream file(outputPath, std::ios::binary);
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    /// Not every file system supports direct I/O, e.g., tmpfs and overlayfs do not
+    [[nodiscard]] bool supportsDirectIO() const
+    {
+        ///NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+        const int fileDescriptor = ::open(outputPath.c_str(), O_WRONLY | O_CREAT | O_DIRECT, 0666);
+        if (fileDescriptor < 0)
+        {
+            return false;
+        }
+        ::close(fileDescriptor);
+        std::filesystem::remove(outputPath);
+        return true;
+    }
+
+    template <typename Predicate>
+    static bool waitFor(Predicate predicate)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+        while (not predicate() and std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return predicate();
+    }
+
+    std::shared_ptr<BufferManager> bufferManager;
+    Schema schema;
+    std::filesystem::path outputPath;
+};
+
+TEST_F(FileSinkTest, WritesTheSameOutputInSyncAndAsyncMode)
+{
+    writeBuffers({}, 0, 32);
+    const auto syncOutput = readOutput();
+    std::filesystem::remove(outputPath);
+    writeBuffers({{"async", "true"}}, 0, 32);
+
+    EXPECT_EQ(syncOutput, getExpectedOutput(0, 32));
+    EXPECT_EQ(readOutput(), syncOutput);
+}
+
+/// The writer thread collects the buffers until the flush interval passed, thus only stopping the sink writes them before
+TEST_F(FileSinkTest, FlushesThePendingBuffersOnStop)
+{
+    auto [backpressureController, backpressureListener] = createBackpressureChannel();
+    const auto sink = createSink(std::move(backpressureController), {{"async", "true"}, {"flush_interval_ms", "600000"}});
+    auto pec = createPipelineExecutionContext();
+    sink->start(pec);
+    for (uint64_t bufferIndex = 0; bufferIndex < 8; ++bufferIndex)
+    {
+        sink->execute(createInputBuffer(bufferIndex), pec);
+    }
+    EXPECT_TRUE(readOutput().empty());
+
+    const auto stopStart = std::chrono::steady_clock::now();
+    sink->stop(pec);
+
+    EXPECT_LT(std::chrono::steady_clock::now() - stopStart, TIMEOUT);
+    EXPECT_EQ(readOutput(), getExpectedOutput(0, 8));
+}
+
+TEST_F(FileSinkTest, AppendsInAsyncMode)
+{
+    writeBuffers({{"async", "true"}}, 0, 4);
+    writeBuffers({{"async", "true"}, {"append", "true"}}, 4, 8);
+    EXPECT_EQ(readOutput(), getExpectedOutput(0, 8));
+}
+
+/// Direct I/O writes aligned blocks, but the file must not contain the padding of its last, partial block
+TEST_F(FileSinkTest, WritesTheUnalignedTailInDirectIOMode)
+{
+    if (not supportsDirectIO())
+    {
+        GTEST_SKIP() << "The file system of " << outputPath << " does not support direct I/O";
+    }
+    const auto expectedOutput = getExpectedOutput(0, 64);
+    ASSERT_GT(expectedOutput.size(), DIRECT_IO_ALIGNMENT);
+    ASSERT_NE(expectedOutput.size() % DIRECT_IO_ALIGNMENT, 0);
+
+    writeBuffers({{"async", "true"}, {"direct_io", "true"}}, 0, 64);
+
+    EXPECT_EQ(std::filesystem::file_size(outputPath), expectedOutput.size());
+    EXPECT_EQ(readOutput(), expectedOutput);
+}
+
+/// Appending rewrites the partial last block of the file together with the first appended bytes
+TEST_F(FileSinkTest, AppendsToAPartialBlockInDirectIOMode)
+{
+    if (not supportsDirectIO())
+    {
+        GTEST_SKIP() << "The file system of " << outputPath << " does not support direct I/O";
+    }
+    writeBuffers({{"async", "true"}, {"direct_io", "true"}}, 0, 3);
+    ASSERT_NE(std::filesystem::file_size(outputPath) % DIRECT_IO_ALIGNMENT, 0);
+    writeBuffers({{"async", "true"}, {"direct_io", "true"}, {"append", "true"}}, 3, 64);
+    writeBuffers({{"async", "true"}, {"direct_io", "true"}, {"append", "true"}}, 64, 65);
+
+    EXPECT_EQ(readOutput(), getExpectedOutput(0, 65));
+}
+
+TEST_F(FileSinkTest, RejectsDirectIOInSyncMode)
+{
+    auto [backpressureController, backpressureListener] = createBackpressureChannel();
+    ASSERT_EXCEPTION_ERRORCODE(
+        (void)createSink(std::move(backpressureController), {{"direct_io", "true"}}), ErrorCode::InvalidConfigParameter);
+}
+
+/// A pipe without a reader stalls the writer thread, like a file system that cannot keep up with the worker threads
+TEST_F(FileSinkTest, AppliesBackpressureWhileTheWriterThreadFallsBehind)
+{
+    ASSERT_EQ(::mkfifo(outputPath.c_str(), 0666), 0) << std::strerror(errno);
+    const int reader = ::open(outputPath.c_str(), O_RDONLY | O_NONBLOCK); ///NOLINT(cppcoreguidelines-pro-type-vararg)
+    ASSERT_GE(reader, 0) << std::strerror(errno);
+    const auto pipeCapacity = ::fcntl(reader, F_GETPIPE_SZ); ///NOLINT(cppcoreguidelines-pro-type-vararg)
+    ASSERT_GT(pipeCapacity, 0);
+    auto [backpressureController, backpressureListener] = createBackpressureChannel();
+    {
+        AsyncFileWriter writer(outputPath.string(), std::chrono::milliseconds(0), false, backpressureController);
+        const std::string stallingBytes(2 * static_cast<size_t>(pipeCapacity), 'x');
+        writer.write(stallingBytes);
+        ASSERT_TRUE(waitFor(
+            [&]
+            {
+                int pendingBytes = 0;
+                ///NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg)
+                return ::ioctl(reader, FIONREAD, &pendingBytes) == 0 and pendingBytes == pipeCapacity;
+            }));
+
+        /// More than half of the queue of 1024 buffers, while the writer thread is stuck in writing the stalling bytes
+        constexpr size_t numberOfLines = 600;
+        for (size_t line = 0; line < numberOfLines; ++line)
+        {
+            writer.write("line\n");
+        }
+        EXPECT_TRUE(backpressureListener.hasBackpressure());
+
+        /// Draining the pipe lets the writer thread catch up, which releases the backpressure before the writer is closed
+        ASSERT_NE(::fcntl(reader, F_SETFL, 0), -1); ///NOLINT(cppcoreguidelines-pro-type-vararg)
+        size_t readBytes = 0;
+        std::jthread drain(
+            [&]
+            {
+                std::array<char, 4096> chunk{};
+                for (auto bytes = ::read(reader, chunk.data(), chunk.size()); bytes > 0; bytes = ::read(reader, chunk.data(), chunk.size()))
+                {
+                    readBytes += static_cast<size_t>(bytes);
+                }
+            });
+        EXPECT_TRUE(waitFor([&] { return not backpressureListener.hasBackpressure(); }));
+        writer.close();
+        drain.join();
+        EXPECT_EQ(readBytes, stallingBytes.size() + (numberOfLines * std::strlen("line\n")));
+    }
+    ::close(reader);
+}
+
+class FileSinkCompressionTest : public FileSinkTest, public testing::WithParamInterface<SinkCompression>
+{
+public:
+    /// Decompresses the concatenated frames like `zstd -d` and `lz4 -d` do. Returns nothing, if the frames are invalid or incomplete.
+    [[nodiscard]] std::optional<std::string> decompress(const std::string& compressed) const
+    {
+        switch (GetParam())
+        {
+            case SinkCompression::ZSTD:
+                return decompressZstd(compressed);
+            case SinkCompression::LZ4:
+                return decompressLz4(compressed);
+            case SinkCompression::NONE:
+                return compressed;
+        }
+        return std::nullopt;
+    }
+
+    /// The little-endian magic number that starts every frame of the codec
+    [[nodiscard]] std::string getMagicNumber() const
+    {
+        switch (GetParam())
+        {
+            case SinkCompression::ZSTD:
+                return "\x28\xB5\x2F\xFD";
+            case SinkCompression::LZ4:
+                return "\x04\x22\x4D\x18";
+            case SinkCompression::NONE:
+                return "";
+        }
+        return "";
+    }
+
+    [[nodiscard]] std::unordered_map<std::string, std::string> withCompression(std::unordered_map<std::string, std::string> config) const
+    {
+        config.emplace("compression", std::string(magic_enum::enum_name(GetParam())));
+        return config;
+    }
+
+private:
+    static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+    static std::optional<std::string> decompressZstd(const std::string& compressed)
+    {
+        const std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> context(ZSTD_createDCtx(), &ZSTD_freeDCtx);
+        std::string output;
+        std::string chunk(CHUNK_SIZE, '\0');
+        ZSTD_inBuffer input{.src = compressed.data(), .size = compressed.size(), .pos = 0};
+        size_t result = 0;
+        bool isChunkFull = false;
+        while (input.pos < input.size or isChunkFull)
+        {
+            ZSTD_outBuffer chunkBuffer{.dst = chunk.data(), .size = chunk.size(), .pos = 0};
+            result = ZSTD_decompressStream(context.get(), &chunkBuffer, &input);
+            if (ZSTD_isError(result))
+            {
+                return std::nullopt;
+            }
+            output.append(chunk.data(), chunkBuffer.pos);
+            isChunkFull = chunkBuffer.pos == chunkBuffer.size;
+        }
+        /// Zero signals that the last frame is complete
+        return result == 0 ? std::optional(output) : std::nullopt;
+    }
+
+    static std::optional<std::string> decompressLz4(const std::string& compressed)
+    {
+        LZ4F_dctx* rawContext = nullptr;
+        if (LZ4F_isError(LZ4F_createDecompressionContext(&rawContext, LZ4F_VERSION)))
+        {
+            return std::nullopt;
+        }
+        const std::unique_ptr<LZ4F_dctx, decltype(&LZ4F_freeDecompressionContext)> context(rawContext, &LZ4F_freeDecompressionContext);
+        std::string output;
+        std::string chunk(CHUNK_SIZE, '\0');
+        const char* input = compressed.data();
+        size_t remainingInput = compressed.size();
+        size_t result = 0;
+        bool isChunkFull = false;
+        while (remainingInput > 0 or isChunkFull)
+        {
+            size_t chunkSize = chunk.size();
+            size_t consumedInput = remainingInput;
+            result = LZ4F_decompress(context.get(), chunk.data(), &chunkSize, input, &consumedInput, nullptr);
+            if (LZ4F_isError(result))
+            {
+                return std::nullopt;
+            }
+            output.append(chunk.data(), chunkSize);
+            input += consumedInput;
+            remainingInput -= consumedInput;
+            isChunkFull = chunkSize == chunk.size();
+        }
+        /// Zero signals that the last frame is complete, after which the context expects the next frame
+        return result == 0 ? std::optional(output) : std::nullopt;
+    }
+};
+
+TEST_P(FileSinkCompressionTest, DecompressesToTheUncompressedOutput)
+{
+    const std::vector<std::unordered_map<std::string, std::string>> modes{{}, {{"async", "true"}}, {{"compression_level", "1"}}};
+    for (const auto& mode : modes)
+    {
+        std::filesystem::remove(outputPath);
+        writeBuffers(withCompression(mode), 0, 32);
+        const auto output = readOutput();
+        const auto expectedOutput = getExpectedOutput(0, 32);
+
+        EXPECT_TRUE(output.starts_with(getMagicNumber())) << "Expected the output to start with a frame";
+        EXPECT_EQ(decompress(output), expectedOutput);
+    }
+}
+
+/// Every buffer, as well as the schema, is a frame of its own, thus appending frames keeps the file a valid stream
+TEST_P(FileSinkCompressionTest, DecompressesAppendedOutput)
+{
+    writeBuffers(withCompression({}), 0, 4);
+    writeBuffers(withCompression({{"append", "true"}}), 4, 6);
+    writeBuffers(withCompression({{"append", "true"}, {"async", "true"}}), 6, 8);
+
+    EXPECT_EQ(decompress(readOutput()), getExpectedOutput(0, 8));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    FileSinkCompressionTest,
+    FileSinkCompressionTest,
+    testing::Values(SinkCompression::ZSTD, SinkCompression::LZ4),
+    [](const testing::TestParamInfo<SinkCompression>& info) { return std::string(magic_enum::enum_name(info.param)); });
+
+}
@@ -0,0 +1,252 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Runtime/BufferManager.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Sinks/GrpcSink.hpp>
+#include <Sinks/ResultStream.hpp>
+#include <Sinks/SinkCatalog.hpp>
+#include <SinksParsing/NativeFormat.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BackpressureChannel.hpp>
+#include <BaseUnitTest.hpp>
+#include <ErrorHandling.hpp>
+#include <TestTaskQueue.hpp>
+
+namespace NES
+{
+
+/// Subscribes to the result stream of a grpc sink, like the SubscribeResults rpc of the worker does for its clients
+class GrpcSinkTest : public Testing::BaseUnitTest
+{
+public:
+    static constexpr uint64_t BUFFER_SIZE = 4096;
+    static constexpr uint64_t TUPLES_PER_BUFFER = 16;
+    static constexpr uint64_t NUMBER_OF_BUFFERS = 8;
+    static constexpr size_t MAX_FRAMES = 64;
+    static constexpr std::chrono::milliseconds POP_TIMEOUT{10};
+
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("GrpcSinkTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup GrpcSinkTest class.");
+    }
+
+    void SetUp() override
+    {
+        Testing::BaseUnitTest::SetUp();
+        bufferManager = BufferManager::create(BUFFER_SIZE, 64);
+        schema = Schema{}.addField("stream$id", DataType::Type::UINT64).addField("stream$value", DataType::Type::UINT64);
+        /// Every test uses a stream of its own, as the streams are global
+        streamName = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    }
+
+    [[nodiscard]] TupleBuffer createInputBuffer(const uint64_t bufferIndex) const
+    {
+        auto buffer = bufferManager->getBufferBlocking();
+        for (uint64_t tupleIndex = 0; tupleIndex < TUPLES_PER_BUFFER; ++tupleIndex)
+        {
+            const std::array<uint64_t, 2> values{(bufferIndex * TUPLES_PER_BUFFER) + tupleIndex, bufferIndex};
+            std::memcpy(buffer.getAvailableMemoryArea().data() + (tupleIndex * sizeof(values)), values.data(), sizeof(values));
+        }
+        buffer.setNumberOfTuples(TUPLES_PER_BUFFER);
+        return buffer;
+    }
+
+    /// The frames of the input buffers [first, last)
+    [[nodiscard]] std::vector<std::string> getExpectedFrames(const uint64_t first, const uint64_t last) const
+    {
+        const NativeFormat format(schema);
+        std::vector<std::string> frames;
+        for (uint64_t bufferIndex = first; bufferIndex < last; ++bufferIndex)
+        {
+            format.formatBuffer(createInputBuffer(bufferIndex), frames.emplace_back());
+        }
+        return frames;
+    }
+
+    [[nodiscard]] std::unique_ptr<GrpcSink>
+    createSink(BackpressureController backpressureController, const uint64_t maxQueuedBytes = 16 * 1024 * 1024) const
+    {
+        const auto sinkDescriptor = SinkCatalog{}.getInlineSink(
+            schema,
+            GrpcSink::NAME,
+            {{"input_format", "NATIVE"}, {"stream_name", streamName}, {"max_queued_bytes", std::to_string(maxQueuedBytes)}});
+        EXPECT_TRUE(sinkDescriptor.has_value());
+        /// NOLINTNEXTLINE(bugprone-unchecked-optional-access)
+        return std::make_unique<GrpcSink>(std::move(backpressureController), *sinkDescriptor);
+    }
+
+    [[nodiscard]] TestPipelineExecutionContext createPipelineExecutionContext() const
+    {
+        return TestPipelineExecutionContext(bufferManager, std::make_shared<std::vector<std::vector<TupleBuffer>>>(1));
+    }
+
+    /// Pops batches of the subscription until it popped the number of frames, or the stream ended
+    static std::vector<std::string> popFrames(ResultStream& subscription, const size_t numberOfFrames)
+    {
+        std::vector<std::string> frames;
+        while (frames.size() < numberOfFrames)
+        {
+            auto batch = subscription.pop(numberOfFrames - frames.size(), POP_TIMEOUT);
+            if (not batch.has_value())
+            {
+                break;
+            }
+            for (auto& frame : *batch)
+            {
+                frames.push_back(std::move(frame));
+            }
+        }
+        return frames;
+    }
+
+    std::shared_ptr<BufferManager> bufferManager;
+    Schema schema;
+    std::string streamName;
+};
+
+/// Clients decode the frames like the native input formatter, thus the validation of the sink rejects every other format
+TEST_F(GrpcSinkTest, RejectsFormatsOtherThanNative)
+{
+    for (const auto* const inputFormat : {"CSV", "JSON"})
+    {
+        ASSERT_EXCEPTION_ERRORCODE(
+            (void)SinkCatalog{}.getInlineSink(schema, GrpcSink::NAME, {{"input_format", inputFormat}, {"stream_name", streamName}}),
+            ErrorCode::InvalidConfigParameter);
+    }
+}
+
+/// A subscriber that subscribes before the sink starts receives the frames of all buffers in order, and the end of the stream once the
+/// sink stopped
+TEST_F(GrpcSinkTest, DeliversAFramePerBufferToTheSubscriber)
+{
+    const auto subscription = ResultStream::get(streamName);
+    auto [backpressureController, backpressureListener] = createBackpressureChannel();
+    const auto sink = createSink(std::move(backpressureController));
+    auto pipelineExecutionContext = createPipelineExecutionContext();
+    sink->start(pipelineExecutionContext);
+    for (uint64_t bufferIndex = 0; bufferIndex < NUMBER_OF_BUFFERS; ++bufferIndex)
+    {
+        sink->execute(createInputBuffer(bufferIndex), pipelineExecutionContext);
+    }
+    EXPECT_EQ(popFrames(*subscription, NUMBER_OF_BUFFERS / 2), getExpectedFrames(0, NUMBER_OF_BUFFERS / 2));
+    sink->stop(pipelineExecutionContext);
+
+    /// The subscriber receives the frames that were queued when the sink stopped
+    EXPECT_EQ(popFrames(*subscription, MAX_FRAMES), getExpectedFrames(NUMBER_OF_BUFFERS / 2, NUMBER_OF_BUFFERS));
+    EXPECT_EQ(subscription->pop(MAX_FRAMES, POP_TIMEOUT), std::nullopt);
+    EXPECT_FALSE(backpressureListener.hasBackpressure());
+}
+
+/// The stream keeps the frames of a subscriber that disconnected, e.g., because its client cancelled the rpc, and applies backpressure
+/// until a new subscriber resumes the stream without losing a frame
+TEST_F(GrpcSinkTest, ResumesTheStreamAfterTheSubscriberDisconnected)
+{
+    const auto sizeOfFrame = getExpectedFrames(0, 1).front().size();
+    auto [backpressureController, backpressureListener] = createBackpressureChannel();
+    const auto sink = createSink(std::move(backpressureController), 2 * sizeOfFrame);
+    auto pipelineExecutionContext = createPipelineExecutionContext();
+    sink->start(pipelineExecutionContext);
+
+    auto subscription = ResultStream::get(streamName);
+    sink->execute(createInputBuffer(0), pipelineExecutionContext);
+    EXPECT_EQ(popFrames(*subscription, 1), getExpectedFrames(0, 1));
+    subscription.reset();
+
+    for (uint64_t bufferIndex = 1; bufferIndex < NUMBER_OF_BUFFERS; ++bufferIndex)
+    {
+        sink->execute(createInputBuffer(bufferIndex), pipelineExecutionContext);
+    }
+    EXPECT_TRUE(backpressureListener.hasBackpressure());
+
+    const auto resumedSubscription = ResultStream::get(streamName);
+    EXPECT_EQ(popFrames(*resumedSubscription, NUMBER_OF_BUFFERS - 1), getExpectedFrames(1, NUMBER_OF_BUFFERS));
+    EXPECT_FALSE(backpressureListener.hasBackpressure());
+    sink->stop(pipelineExecutionContext);
+    EXPECT_EQ(resumedSubscription->pop(MAX_FRAMES, POP_TIMEOUT), std::nullopt);
+}
+
+/// A sink that stops releases its backpressure, even if its subscriber disconnected and never drains the stream
+TEST_F(GrpcSinkTest, ReleasesBackpressureOnStopWithoutSubscriber)
+{
+    auto [backpressureController, backpressureListener] = createBackpressureChannel();
+    const auto sink = createSink(std::move(backpressureController), 1);
+    auto pipelineExecutionContext = createPipelineExecutionContext();
+    sink->start(pipelineExecutionContext);
+    sink->execute(createInputBuffer(0), pipelineExecutionContext);
+    EXPECT_TRUE(backpressureListener.hasBackpressure());
+    sink->stop(pipelineExecutionContext);
+    EXPECT_FALSE(backpressureListener.hasBackpressure());
+}
+
+/// The subscribers of a stream whose sink stopped drain it, while a later subscriber and the sink of a restarted query share a new stream
+TEST_F(GrpcSinkTest, SubscribersAfterTheSinkStoppedUseANewStream)
+{
+    auto [backpressureController, backpressureListener] = createBackpressureChannel();
+    const auto sink = createSink(std::move(backpressureController));
+    auto pipelineExecutionContext = createPipelineExecutionContext();
+    sink->start(pipelineExecutionContext);
+    const auto subscription = ResultStream::get(streamName);
+    sink->execute(createInputBuffer(0), pipelineExecutionContext);
+    sink->stop(pipelineExecutionContext);
+
+    const auto laterSubscription = ResultStream::get(streamName);
+    EXPECT_NE(laterSubscription, subscription);
+    EXPECT_EQ(popFrames(*subscription, MAX_FRAMES), getExpectedFrames(0, 1));
+    EXPECT_EQ(subscription->pop(MAX_FRAMES, POP_TIMEOUT), std::nullopt);
+
+    auto [restartedBackpressureController, restartedBackpressureListener] = createBackpressureChannel();
+    const auto restartedSink = createSink(std::move(restartedBackpressureController));
+    restartedSink->start(pipelineExecutionContext);
+    restartedSink->execute(createInputBuffer(1), pipelineExecutionContext);
+    EXPECT_EQ(popFrames(*laterSubscription, 1), getExpectedFrames(1, 2));
+    restartedSink->stop(pipelineExecutionContext);
+}
+
+/// A stream has a single writer, thus a second sink with the same stream name fails to start, but leaves the stream of the first one open
+TEST_F(GrpcSinkTest, RejectsASecondSinkOfTheSameStream)
+{
+    auto [backpressureController, backpressureListener] = createBackpressureChannel();
+    const auto sink = createSink(std::move(backpressureController));
+    auto pipelineExecutionContext = createPipelineExecutionContext();
+    sink->start(pipelineExecutionContext);
+    const auto subscription = ResultStream::get(streamName);
+
+    auto [otherBackpressureController, otherBackpressureListener] = createBackpressureChannel();
+    auto otherSink = createSink(std::move(otherBackpressureController));
+    ASSERT_EXCEPTION_ERRORCODE(otherSink->start(pipelineExecutionContext), ErrorCode::CannotOpenSink);
+    otherSink.reset();
+
+    sink->execute(createInputBuffer(0), pipelineExecutionContext);
+    EXPECT_EQ(popFrames(*subscription, 1), getExpectedFrames(0, 1));
+    sink->stop(pipelineExecutionContext);
+    EXPECT_EQ(subscription->pop(MAX_FRAMES, POP_TIMEOUT), std::nullopt);
+}
+
+}
@@ -0,0 +1,324 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <Runtime/BufferManager.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Runtime/VariableSizedAccess.hpp>
+#include <Sinks/NetworkChannel.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BackpressureChannel.hpp>
+#include <BaseUnitTest.hpp>
+#include <ErrorHandling.hpp>
+#include <TestNetworkReceiver.hpp>
+
+namespace NES
+{
+
+using namespace std::literals;
+
+class NetworkChannelTest : public Testing::BaseUnitTest
+{
+public:
+    static constexpr size_t SIZE_OF_TUPLE = 16;
+    static constexpr uint64_t BUFFER_SIZE = 4096;
+    static constexpr std::chrono::seconds CONNECT_TIMEOUT{1};
+    static constexpr std::chrono::seconds WAIT_TIMEOUT{10};
+
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("NetworkChannelTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup NetworkChannelTest class.");
+    }
+
+    void SetUp() override
+    {
+        Testing::BaseUnitTest::SetUp();
+        bufferManager = BufferManager::create(BUFFER_SIZE, 128);
+    }
+
+    /// A buffer of 'numberOfTuples' tuples, whose bytes depend on the seed, with a child buffer for every element of 'sizesOfChildBuffers'
+    TupleBuffer createBuffer(const uint8_t seed, const uint64_t numberOfTuples, const std::vector<uint64_t>& sizesOfChildBuffers = {}) const
+    {
+        auto buffer = bufferManager->getBufferBlocking();
+        const auto memory = buffer.getAvailableMemoryArea<uint8_t>();
+        for (size_t byte = 0; byte < numberOfTuples * SIZE_OF_TUPLE; ++byte)
+        {
+            memory[byte] = static_cast<uint8_t>(seed + byte);
+        }
+        buffer.setNumberOfTuples(numberOfTuples);
+        for (const auto sizeOfChildBuffer : sizesOfChildBuffers)
+        {
+            /// Child buffers store their number of used bytes as their number of tuples
+            auto childBuffer = bufferManager->getBufferBlocking();
+            const auto childMemory = childBuffer.getAvailableMemoryArea<uint8_t>();
+            for (size_t byte = 0; byte < sizeOfChildBuffer; ++byte)
+            {
+                childMemory[byte] = static_cast<uint8_t>(seed * byte);
+            }
+            childBuffer.setNumberOfTuples(sizeOfChildBuffer);
+            [[maybe_unused]] const auto childIndex = buffer.storeChildBuffer(childBuffer);
+        }
+        return buffer;
+    }
+
+    static void expectFrameOf(const TupleBuffer& buffer, const std::optional<TestNetworkReceiver::Frame>& frame)
+    {
+        ASSERT_TRUE(frame.has_value());
+        EXPECT_EQ(frame->header.sizeOfTuple, SIZE_OF_TUPLE);
+        EXPECT_EQ(frame->header.numberOfTuples, buffer.getNumberOfTuples());
+        EXPECT_EQ(frame->tuples, toString(buffer, buffer.getNumberOfTuples() * SIZE_OF_TUPLE));
+        ASSERT_EQ(frame->header.numberOfChildBuffers, buffer.getNumberOfChildBuffers());
+        ASSERT_EQ(frame->childBuffers.size(), buffer.getNumberOfChildBuffers());
+        for (uint32_t childIndex = 0; childIndex < buffer.getNumberOfChildBuffers(); ++childIndex)
+        {
+            const auto childBuffer = buffer.loadChildBuffer(VariableSizedAccess::Index{childIndex});
+            EXPECT_EQ(frame->childBuffers[childIndex], toString(childBuffer, childBuffer.getNumberOfTuples()));
+        }
+    }
+
+    static bool waitUntil(const std::function<bool()>& condition)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + WAIT_TIMEOUT;
+        while (not condition())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(1ms);
+        }
+        return true;
+    }
+
+    std::shared_ptr<BufferManager> bufferManager;
+
+private:
+    static std::string toString(const TupleBuffer& buffer, const size_t size)
+    {
+        const auto memory = buffer.getAvailableMemoryArea<char>();
+        return {memory.data(), size};
+    }
+};
+
+/// Whether the channel sends with MSG_ZEROCOPY
+class NetworkChannelZeroCopyTest : public NetworkChannelTest, public ::testing::WithParamInterface<bool>
+{
+};
+
+TEST_P(NetworkChannelZeroCopyTest, SendsTupleBuffersWithTheirChildBuffersAsNativeFrames)
+{
+    TestNetworkReceiver receiver;
+    receiver.listen();
+    NetworkChannel channel("127.0.0.1", receiver.getPort(), CONNECT_TIMEOUT, GetParam(), SIZE_OF_TUPLE);
+    channel.open();
+    receiver.accept();
+
+    const std::vector buffers{createBuffer(1, 1), createBuffer(2, 0), createBuffer(3, 100, {10, 0, BUFFER_SIZE}), createBuffer(4, 256)};
+    for (const auto& buffer : buffers)
+    {
+        channel.send(buffer);
+    }
+    /// The channel must keep the frames alive until the kernel completed them, even if the sink releases its buffers
+    channel.close();
+
+    for (const auto& buffer : buffers)
+    {
+        expectFrameOf(buffer, receiver.receiveFrame());
+    }
+    /// Closing the channel ends the stream of frames
+    EXPECT_FALSE(receiver.receiveFrame().has_value());
+}
+
+INSTANTIATE_TEST_SUITE_P(ZeroCopy, NetworkChannelZeroCopyTest, ::testing::Bool());
+
+/// The channel reconnects until the receiver listens, as the NetworkSource of the receiving worker might start after the sink
+TEST_F(NetworkChannelTest, OpenRetriesToConnectUntilTheReceiverListens)
+{
+    TestNetworkReceiver receiver;
+    NetworkChannel channel("127.0.0.1", receiver.getPort(), 10s, false, SIZE_OF_TUPLE);
+    std::jthread listener(
+        [&receiver]
+        {
+            std::this_thread::sleep_for(300ms);
+            receiver.listen();
+        });
+    channel.open();
+    listener.join();
+    receiver.accept();
+
+    const auto buffer = createBuffer(1, 10);
+    channel.send(buffer);
+    channel.close();
+    expectFrameOf(buffer, receiver.receiveFrame());
+    EXPECT_FALSE(receiver.receiveFrame().has_value());
+}
+
+TEST_F(NetworkChannelTest, OpenFailsIfTheReceiverDoesNotListenWithinTheConnectTimeout)
+{
+    const TestNetworkReceiver receiver;
+    NetworkChannel channel("127.0.0.1", receiver.getPort(), CONNECT_TIMEOUT, false, SIZE_OF_TUPLE);
+    ASSERT_EXCEPTION_ERRORCODE(channel.open(), ErrorCode::CannotOpenSink);
+    /// Closing a channel that did not connect does nothing
+    channel.close();
+}
+
+TEST_F(NetworkChannelTest, SendFailsAfterTheReceiverClosedTheConnection)
+{
+    TestNetworkReceiver receiver;
+    receiver.listen();
+    NetworkChannel channel("127.0.0.1", receiver.getPort(), CONNECT_TIMEOUT, true, SIZE_OF_TUPLE);
+    channel.open();
+    receiver.accept();
+    receiver.closeConnection();
+
+    /// The kernel only detects the closed connection, once the receiver rejected a send
+    const auto buffer = createBuffer(1, 10);
+    const auto sendUntilFailure = [&]
+    {
+        while (true)
+        {
+            channel.send(buffer);
+            std::this_thread::sleep_for(1ms);
+        }
+    };
+    ASSERT_EXCEPTION_ERRORCODE(sendUntilFailure(), ErrorCode::CannotWriteSink);
+    channel.close();
+}
+
+TEST_F(NetworkChannelTest, CloseIsIdempotent)
+{
+    TestNetworkReceiver receiver;
+    receiver.listen();
+    NetworkChannel channel("127.0.0.1", receiver.getPort(), CONNECT_TIMEOUT, true, SIZE_OF_TUPLE);
+    channel.open();
+    receiver.accept();
+    channel.close();
+    channel.close();
+    EXPECT_FALSE(receiver.receiveFrame().has_value());
+    EXPECT_EQ(channel.releaseCompletedFrames(), 0);
+}
+
+/// Sends buffers over a channel to a receiver that does not read, until the flow control applies backpressure
+class NetworkFlowControlTest : public NetworkChannelTest
+{
+public:
+    static constexpr uint64_t MAX_IN_FLIGHT_BYTES = BUFFER_SIZE / 2;
+
+    void startSendingUntilBackpressure()
+    {
+        receiver.listen();
+        channel.open();
+        receiver.accept();
+        flowControl.start({&channel});
+        sender = std::jthread(
+            [this]
+            {
+                const auto buffer = createBuffer(1, BUFFER_SIZE / SIZE_OF_TUPLE);
+                while (not stopSending)
+                {
+                    /// Blocks, once the socket buffer is full. The background thread of the flow control updates the backpressure.
+                    channel.send(buffer);
+                    ++sentFrames;
+                }
+            });
+    }
+
+    /// Reads all frames on another thread, so that the sender can finish its last send
+    void startReceiving()
+    {
+        stopSending = true;
+        receiving = std::jthread(
+            [this]
+            {
+                while (receiver.receiveFrame().has_value())
+                {
+                    ++receivedFrames;
+                }
+            });
+    }
+
+    void TearDown() override
+    {
+        /// Unblocks the sender, if the test failed before it received the frames
+        if (sender.joinable())
+        {
+            if (not receiving.joinable())
+            {
+                startReceiving();
+            }
+            stopAndExpectAllFrames();
+        }
+        NetworkChannelTest::TearDown();
+    }
+
+    void stopAndExpectAllFrames()
+    {
+        sender.join();
+        flowControl.stop();
+        channel.close();
+        receiving.join();
+        EXPECT_EQ(receivedFrames, sentFrames);
+    }
+
+    /// A small receive buffer (and thus receive window) lets the bytes in flight exceed the credits after a few frames
+    TestNetworkReceiver receiver{static_cast<int>(BUFFER_SIZE)};
+    NetworkChannel channel{"127.0.0.1", receiver.getPort(), CONNECT_TIMEOUT, false, SIZE_OF_TUPLE};
+    std::pair<BackpressureController, BackpressureListener> backpressureChannel = createBackpressureChannel();
+    BackpressureListener& backpressureListener = backpressureChannel.second;
+    NetworkFlowControl flowControl{backpressureChannel.first, MAX_IN_FLIGHT_BYTES};
+    std::atomic_bool stopSending = false;
+    std::atomic<uint64_t> sentFrames = 0;
+    uint64_t receivedFrames = 0;
+    std::jthread sender;
+    std::jthread receiving;
+};
+
+TEST_F(NetworkFlowControlTest, AppliesBackpressureUntilTheReceiverCatchesUp)
+{
+    startSendingUntilBackpressure();
+    ASSERT_TRUE(waitUntil([this] { return backpressureListener.hasBackpressure(); }));
+
+    /// The background thread of the flow control releases the backpressure, although the sources do not send any more buffers
+    startReceiving();
+    EXPECT_TRUE(waitUntil([this] { return not backpressureListener.hasBackpressure(); }));
+    stopAndExpectAllFrames();
+}
+
+TEST_F(NetworkFlowControlTest, ReleasesBackpressureWhenItStops)
+{
+    startSendingUntilBackpressure();
+    ASSERT_TRUE(waitUntil([this] { return backpressureListener.hasBackpressure(); }));
+
+    stopSending = true;
+    flowControl.stop();
+    EXPECT_FALSE(backpressureListener.hasBackpressure());
+    startReceiving();
+    stopAndExpectAllFrames();
+}
+
+}
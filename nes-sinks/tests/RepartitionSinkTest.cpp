@@ -0,0 +1,254 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <set>
+#include <span>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <DataTypes/DataType.hpp>
+#include <DataTypes/Schema.hpp>
+#include <Runtime/BufferManager.hpp>
+#include <Runtime/TupleBuffer.hpp>
+#include <Runtime/VariableSizedAccess.hpp>
+#include <Sinks/RepartitionSink.hpp>
+#include <Sinks/SinkCatalog.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <gtest/gtest.h>
+#include <BackpressureChannel.hpp>
+#include <BaseUnitTest.hpp>
+#include <TestNetworkReceiver.hpp>
+#include <TestTaskQueue.hpp>
+
+namespace NES
+{
+
+/// The partition keys of the sink and the number of its destinations
+class RepartitionSinkTest : public Testing::BaseUnitTest, public ::testing::WithParamInterface<std::tuple<std::string, size_t>>
+{
+public:
+    static constexpr uint64_t BUFFER_SIZE = 4096;
+    static constexpr uint64_t NUMBER_OF_INPUT_BUFFERS = 4;
+    /// The row layout of the schema: the key, the null byte and the VariableSizedAccess of the name, and the value
+    static constexpr size_t KEY_OFFSET = 0;
+    static constexpr size_t NAME_OFFSET = 8;
+    static constexpr size_t VALUE_OFFSET = NAME_OFFSET + 1 + sizeof(VariableSizedAccess);
+    static constexpr size_t SIZE_OF_TUPLE = VALUE_OFFSET + 8;
+    static constexpr uint64_t TUPLES_PER_BUFFER = BUFFER_SIZE / SIZE_OF_TUPLE;
+
+    struct Tuple
+    {
+        uint64_t key;
+        std::optional<std::string> name;
+        uint64_t value;
+
+        bool operator==(const Tuple& other) const = default;
+    };
+
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("RepartitionSinkTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup RepartitionSinkTest class.");
+    }
+
+    void SetUp() override
+    {
+        Testing::BaseUnitTest::SetUp();
+        bufferManager = BufferManager::create(BUFFER_SIZE, 256);
+        schema = Schema{}
+                     .addField("stream$key", DataType::Type::UINT64)
+                     .addField("stream$name", DataType::Type::VARSIZED, DataType::NULLABLE::IS_NULLABLE)
+                     .addField("stream$value", DataType::Type::UINT64);
+        ASSERT_EQ(schema.getSizeOfSchemaInBytes(), SIZE_OF_TUPLE);
+    }
+
+    /// Many tuples share their key or their name, every fifth name is null, and every third name exceeds the inline size
+    static Tuple getTuple(const uint64_t value)
+    {
+        std::optional<std::string> name;
+        if (value % 5 != 0)
+        {
+            name = value % 3 == 0 ? fmt::format("a name that is stored in a child buffer {}", value % 7)
+                                  : fmt::format("name {}", value % 7);
+        }
+        return {.key = value % 13, .name = std::move(name), .value = value};
+    }
+
+    /// Stores the names that are not inlined alternately in two child buffers
+    TupleBuffer createInputBuffer(const uint64_t firstValue) const
+    {
+        auto buffer = bufferManager->getBufferBlocking();
+        std::vector<TupleBuffer> childBuffers{bufferManager->getBufferBlocking(), bufferManager->getBufferBlocking()};
+        std::vector<uint64_t> usedBytes(childBuffers.size(), 0);
+        std::vector<std::tuple<size_t, uint64_t, std::string>> namesInChildBuffers;
+        for (uint64_t tupleIndex = 0; tupleIndex < TUPLES_PER_BUFFER; ++tupleIndex)
+        {
+            const auto [key, name, value] = getTuple(firstValue + tupleIndex);
+            auto* const tuple = buffer.getAvailableMemoryArea().data() + (tupleIndex * SIZE_OF_TUPLE);
+            std::memcpy(tuple + KEY_OFFSET, &key, sizeof(key));
+            std::memcpy(tuple + VALUE_OFFSET, &value, sizeof(value));
+            tuple[NAME_OFFSET] = std::byte{name.has_value() ? uint8_t{0} : uint8_t{1}};
+            VariableSizedAccess access;
+            if (name.has_value() and name->size() <= VariableSizedAccess::INLINE_SIZE)
+            {
+                access = VariableSizedAccess{std::as_bytes(std::span{*name})};
+            }
+            else if (name.has_value())
+            {
+                const auto child = tupleIndex % 2;
+                auto& offset = usedBytes[child];
+                std::memcpy(childBuffers[child].getAvailableMemoryArea().data() + offset, name->data(), name->size());
+                access = VariableSizedAccess{
+                    VariableSizedAccess::Index{child}, VariableSizedAccess::Offset{offset}, std::as_bytes(std::span{*name})};
+                offset += name->size();
+            }
+            std::memcpy(tuple + NAME_OFFSET + 1, &access, sizeof(access));
+        }
+        buffer.setNumberOfTuples(TUPLES_PER_BUFFER);
+        for (size_t child = 0; child < childBuffers.size(); ++child)
+        {
+            /// Child buffers store their number of used bytes as their number of tuples
+            childBuffers[child].setNumberOfTuples(usedBytes[child]);
+            const auto childIndex = buffer.storeChildBuffer(childBuffers[child]);
+            EXPECT_EQ(childIndex, VariableSizedAccess::Index{child});
+        }
+        return buffer;
+    }
+
+    /// Decodes the tuples of a frame, whose names reference the child buffers of the frame
+    static std::vector<Tuple> getTuples(const TestNetworkReceiver::Frame& frame)
+    {
+        EXPECT_EQ(frame.header.sizeOfTuple, SIZE_OF_TUPLE);
+        std::vector<Tuple> tuples;
+        for (uint64_t tupleIndex = 0; tupleIndex < frame.header.numberOfTuples; ++tupleIndex)
+        {
+            const auto* const tuple = frame.tuples.data() + (tupleIndex * SIZE_OF_TUPLE);
+            Tuple decoded{};
+            std::memcpy(&decoded.key, tuple + KEY_OFFSET, sizeof(decoded.key));
+            std::memcpy(&decoded.value, tuple + VALUE_OFFSET, sizeof(decoded.value));
+            if (tuple[NAME_OFFSET] == 0)
+            {
+                VariableSizedAccess access;
+                std::memcpy(&access, tuple + NAME_OFFSET + 1, sizeof(access));
+                if (access.isInlined())
+                {
+                    const auto name = access.getInlinedValue();
+                    decoded.name = std::string(reinterpret_cast<const char*>(name.data()), name.size());
+                }
+                else
+                {
+                    const auto& childBuffer = frame.childBuffers.at(access.getIndex().getRawIndex());
+                    decoded.name = childBuffer.substr(access.getOffset().getRawOffset(), access.getSize().getRawSize());
+                }
+            }
+            tuples.push_back(std::move(decoded));
+        }
+        return tuples;
+    }
+
+    std::shared_ptr<BufferManager> bufferManager;
+    Schema schema;
+};
+
+TEST_P(RepartitionSinkTest, DeliversAllTuplesAndTuplesWithTheSameKeysToTheSameDestination)
+{
+    const auto& [partitionKeys, numberOfDestinations] = GetParam();
+    std::vector<std::unique_ptr<TestNetworkReceiver>> receivers;
+    std::vector<std::string> destinations;
+    for (size_t destination = 0; destination < numberOfDestinations; ++destination)
+    {
+        const auto& receiver = receivers.emplace_back(std::make_unique<TestNetworkReceiver>());
+        receiver->listen();
+        destinations.push_back(fmt::format("127.0.0.1:{}", receiver->getPort()));
+    }
+    const auto sinkDescriptor = SinkCatalog{}.getInlineSink(
+        schema,
+        RepartitionSink::NAME,
+        {{"input_format", "NATIVE"}, {"destinations", fmt::format("{}", fmt::join(destinations, ","))}, {"partition_keys", partitionKeys}});
+    ASSERT_TRUE(sinkDescriptor.has_value());
+
+    auto [backpressureController, backpressureListener] = createBackpressureChannel();
+    RepartitionSink sink(std::move(backpressureController), *sinkDescriptor);
+    TestPipelineExecutionContext pipelineExecutionContext(bufferManager, std::make_shared<std::vector<std::vector<TupleBuffer>>>(1));
+    sink.start(pipelineExecutionContext);
+    for (const auto& receiver : receivers)
+    {
+        receiver->accept();
+    }
+    for (uint64_t inputBuffer = 0; inputBuffer < NUMBER_OF_INPUT_BUFFERS; ++inputBuffer)
+    {
+        sink.execute(createInputBuffer(inputBuffer * TUPLES_PER_BUFFER), pipelineExecutionContext);
+    }
+    sink.stop(pipelineExecutionContext);
+
+    /// Maps the values of the partition keys of a tuple to the destinations that received the tuple
+    using PartitionKeys = std::pair<uint64_t, std::optional<std::string>>;
+    const auto getPartitionKeys = [&](const Tuple& tuple)
+    {
+        return PartitionKeys{
+            partitionKeys.contains("key") ? tuple.key : 0, partitionKeys.contains("name") ? tuple.name : std::nullopt};
+    };
+    std::map<PartitionKeys, std::set<size_t>> destinationsOfKeys;
+    std::vector<Tuple> receivedTuples;
+    size_t destinationsWithTuples = 0;
+    for (size_t destination = 0; destination < numberOfDestinations; ++destination)
+    {
+        uint64_t tuplesOfDestination = 0;
+        while (const auto frame = receivers[destination]->receiveFrame())
+        {
+            for (auto& tuple : getTuples(*frame))
+            {
+                destinationsOfKeys[getPartitionKeys(tuple)].insert(destination);
+                receivedTuples.push_back(std::move(tuple));
+                ++tuplesOfDestination;
+            }
+        }
+        destinationsWithTuples += tuplesOfDestination > 0 ? 1 : 0;
+    }
+    /// Which destinations receive tuples depends on the hashes of the keys, but it is very unlikely that one of three receives all
+    EXPECT_EQ(destinationsWithTuples > 1, numberOfDestinations > 1);
+
+    std::ranges::sort(receivedTuples, {}, &Tuple::value);
+    ASSERT_EQ(receivedTuples.size(), NUMBER_OF_INPUT_BUFFERS * TUPLES_PER_BUFFER);
+    for (uint64_t value = 0; value < receivedTuples.size(); ++value)
+    {
+        EXPECT_EQ(receivedTuples[value], getTuple(value));
+    }
+    for (const auto& [keys, destinationsOfKey] : destinationsOfKeys)
+    {
+        EXPECT_EQ(destinationsOfKey.size(), 1);
+    }
+}
+
+/// With a single destination, the sink sends a partition buffer, once it is full, as every tuple belongs to the same partition
+INSTANTIATE_TEST_SUITE_P(
+    PartitionKeys,
+    RepartitionSinkTest,
+    ::testing::Combine(::testing::Values("key", "name", "key, name"), ::testing::Values<size_t>(1, 3)));
+
+}
@@ -0,0 +1,125 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <TestNetworkReceiver.hpp>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string>
+#include <Runtime/NativeFrameHeader.hpp>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <ErrorHandling.hpp>
+#include <unistd.h>
+
+namespace NES
+{
+
+TestNetworkReceiver::TestNetworkReceiver(const std::optional<int> receiveBufferSize) : listeningSocket(::socket(AF_INET, SOCK_STREAM, 0))
+{
+    INVARIANT(listeningSocket >= 0, "Could not create the socket of the receiver: {}", std::strerror(errno));
+    /// Accepted connections inherit the size of the receive buffer
+    if (receiveBufferSize.has_value())
+    {
+        setsockopt(listeningSocket, SOL_SOCKET, SO_RCVBUF, &*receiveBufferSize, sizeof(int));
+    }
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    socklen_t addressLength = sizeof(address);
+    INVARIANT(
+        ::bind(listeningSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0
+            and ::getsockname(listeningSocket, reinterpret_cast<sockaddr*>(&address), &addressLength) == 0,
+        "Could not bind the socket of the receiver: {}",
+        std::strerror(errno));
+    port = ntohs(address.sin_port);
+}
+
+TestNetworkReceiver::~TestNetworkReceiver()
+{
+    closeConnection();
+    ::close(listeningSocket);
+}
+
+void TestNetworkReceiver::listen() const
+{
+    INVARIANT(::listen(listeningSocket, 1) == 0, "Could not listen on port {}: {}", port, std::strerror(errno));
+}
+
+void TestNetworkReceiver::accept()
+{
+    connectionSocket = ::accept(listeningSocket, nullptr, nullptr);
+    INVARIANT(connectionSocket >= 0, "Could not accept a connection on port {}: {}", port, std::strerror(errno));
+}
+
+bool TestNetworkReceiver::receiveExactly(std::span<std::byte> bytes) const
+{
+    const auto size = bytes.size();
+    while (not bytes.empty())
+    {
+        const auto receivedBytes = ::recv(connectionSocket, bytes.data(), bytes.size(), 0);
+        if (receivedBytes < 0 and errno == EINTR)
+        {
+            continue;
+        }
+        INVARIANT(receivedBytes >= 0, "Could not receive on port {}: {}", port, std::strerror(errno));
+        if (receivedBytes == 0)
+        {
+            INVARIANT(bytes.size() == size, "The sender shut the connection down within a frame");
+            return false;
+        }
+        bytes = bytes.subspan(static_cast<size_t>(receivedBytes));
+    }
+    return true;
+}
+
+std::optional<TestNetworkReceiver::Frame> TestNetworkReceiver::receiveFrame() const
+{
+    Frame frame{};
+    if (not receiveExactly(std::as_writable_bytes(std::span{&frame.header, 1})))
+    {
+        return std::nullopt;
+    }
+    INVARIANT(frame.header.magic == NativeFrameHeader::MAGIC, "Received a frame without the magic number of the native format");
+    frame.tuples.resize(frame.header.numberOfTuples * frame.header.sizeOfTuple);
+    INVARIANT(receiveExactly(std::as_writable_bytes(std::span{frame.tuples})), "The sender shut the connection down within a frame");
+    for (uint64_t childIndex = 0; childIndex < frame.header.numberOfChildBuffers; ++childIndex)
+    {
+        uint64_t sizeOfChildBuffer = 0;
+        auto& childBuffer = frame.childBuffers.emplace_back();
+        INVARIANT(
+            receiveExactly(std::as_writable_bytes(std::span{&sizeOfChildBuffer, 1})),
+            "The sender shut the connection down within a frame");
+        childBuffer.resize(sizeOfChildBuffer);
+        INVARIANT(receiveExactly(std::as_writable_bytes(std::span{childBuffer})), "The sender shut the connection down within a frame");
+    }
+    return frame;
+}
+
+void TestNetworkReceiver::closeConnection()
+{
+    if (connectionSocket >= 0)
+    {
+        ::close(connectionSocket);
+        connectionSocket = -1;
+    }
+}
+
+}
@@ -0,0 +1,67 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+#include <Runtime/NativeFrameHeader.hpp>
+
+namespace NES
+{
+
+/// Receives the native frames that a NetworkChannel sends over a single connection, which allows testing the network sinks without a
+/// NetworkSource. The receiver only reads from the connection, when the test calls receiveFrame.
+class TestNetworkReceiver
+{
+public:
+    struct Frame
+    {
+        NativeFrameHeader header;
+        std::string tuples;
+        std::vector<std::string> childBuffers;
+    };
+
+    /// Binds a socket to an ephemeral port of the loopback interface. Connections to the port are refused until the receiver listens.
+    /// A small receive buffer lets the receiver apply backpressure to the sender while the test does not read.
+    explicit TestNetworkReceiver(std::optional<int> receiveBufferSize = std::nullopt);
+    ~TestNetworkReceiver();
+
+    TestNetworkReceiver(const TestNetworkReceiver&) = delete;
+    TestNetworkReceiver& operator=(const TestNetworkReceiver&) = delete;
+    TestNetworkReceiver(TestNetworkReceiver&&) = delete;
+    TestNetworkReceiver& operator=(TestNetworkReceiver&&) = delete;
+
+    [[nodiscard]] uint16_t getPort() const { return port; }
+
+    void listen() const;
+    void accept();
+    /// Returns nullopt, once the sender shut the connection down after its last frame
+    std::optional<Frame> receiveFrame() const;
+    void closeConnection();
+
+private:
+    /// Returns false, if the sender shut the connection down before the first byte
+    bool receiveExactly(std::span<std::byte> bytes) const;
+
+    int listeningSocket = -1;
+    int connectionSocket = -1;
+    uint16_t port = 0;
+};
+
+}
@@ -0,0 +1,44 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace NES
+{
+
+/// Statistics about the values of a field of a logical source, which the input formatters derive from a sample of the parsed records.
+/// The counts only cover the sampled records, thus, the number of distinct values is a lower bound for the whole stream.
+struct ColumnStatistics
+{
+    uint64_t numberOfSampledValues = 0;
+    uint64_t numberOfNullValues = 0;
+    /// Approximated via a HyperLogLog sketch over the non-null sampled values
+    uint64_t approximateNumberOfDistinctValues = 0;
+    /// Only numeric fields have a minimum, a maximum and a histogram
+    std::optional<double> min;
+    std::optional<double> max;
+    /// Bounds of an equi-depth histogram, i.e., every bucket [bounds[i], bounds[i + 1]] holds about the same number of non-null values.
+    /// Empty, if we did not sample a numeric value so far.
+    std::vector<double> histogramBounds;
+
+    [[nodiscard]] double getNullFraction() const;
+    /// Estimates the fraction of the non-null values that are less than or equal to the value, interpolating linearly within a bucket
+    [[nodiscard]] std::optional<double> estimateFractionAtMost(double value) const;
+};
+
+}
@@ -0,0 +1,86 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <vector>
+
+namespace NES
+{
+
+/// Forward referencing the ring of one I/O thread to hide the io_uring details
+class IoUringRing;
+
+/// Event loop for asynchronous source I/O via io_uring. A small, fixed number of I/O threads drive one io_uring each. Sources submit
+/// reads directly into (pooled) TupleBuffer memory and get notified once the kernel completed the read, thus a source does not need to
+/// block its own thread in a read syscall. All reads of one file descriptor go to the same ring, which preserves their order.
+/// We use the io_uring syscalls directly (see `man 7 io_uring`), to not depend on liburing.
+class IoUringReactor
+{
+public:
+    static constexpr size_t DEFAULT_NUMBER_OF_IO_THREADS = 2;
+    static constexpr uint32_t NUMBER_OF_RING_ENTRIES = 256;
+
+    /// Called by the I/O thread with the number of bytes read, or with a negative errno, e.g., -ECANCELED
+    using CompletionCallback = std::function<void(int64_t result)>;
+
+    /// Identifies a submitted read, e.g., to cancel it
+    struct ReadHandle
+    {
+        size_t ring;
+        uint64_t id;
+    };
+
+    /// Throws a CannotOpenSource, if the kernel does not support io_uring (or forbids it, e.g., via seccomp)
+    explicit IoUringReactor(size_t numberOfIoThreads = DEFAULT_NUMBER_OF_IO_THREADS);
+    ~IoUringReactor();
+
+    IoUringReactor(const IoUringReactor&) = delete;
+    IoUringReactor(IoUringReactor&&) = delete;
+    IoUringReactor& operator=(const IoUringReactor&) = delete;
+    IoUringReactor& operator=(IoUringReactor&&) = delete;
+
+    /// Returns the reactor that all sources of the process share. The reactor (and its I/O threads) lives as long as a source uses it.
+    [[nodiscard]] static std::shared_ptr<IoUringReactor> getShared();
+
+    /// Reads up to buffer.size() bytes from the file descriptor at the given offset into the buffer. Sockets and pipes ignore the offset.
+    /// The buffer must stay valid until the reactor called onCompletion, which happens exactly once, also if the read is cancelled.
+    [[nodiscard]] ReadHandle submitRead(int fileDescriptor, std::span<std::byte> buffer, uint64_t offset, CompletionCallback onCompletion);
+
+    /// Requests the kernel to cancel the read. A read that already transferred data may still complete successfully.
+    void cancel(const ReadHandle& readHandle);
+
+    /// Submits a read and blocks until it completed. Cancels the read, if the timeout passes or if a stop is requested, and then waits
+    /// until the kernel released the buffer.
+    /// Returns the result of the read, or nullopt, if the read was cancelled before it transferred any data.
+    [[nodiscard]] std::optional<int64_t> read(
+        int fileDescriptor,
+        std::span<std::byte> buffer,
+        uint64_t offset,
+        std::chrono::milliseconds timeout,
+        const std::stop_token& stopToken);
+
+private:
+    std::vector<std::unique_ptr<IoUringRing>> rings;
+};
+
+}
@@ -16,6 +16,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <stop_token>
 #include <variant>
@@ -65,6 +66,13 @@ public:
     /// @return the number of bytes read
     virtual FillTupleBufferResult fillTupleBuffer(TupleBuffer& tupleBuffer, const std::stop_token& stopToken) = 0;
 
+    /// Sources that implement 'tryFillTupleBuffer' can share the threads of a SourceRunner with many other sources.
+    [[nodiscard]] virtual bool supportsNonBlockingFill() const { return false; }
+
+    /// Non-blocking variant of 'fillTupleBuffer'. Must return without waiting for data, e.g., for the next interval of a rate limit.
+    /// @return nullopt, if the source has no data available yet. The caller retries later with a new TupleBuffer.
+    virtual std::optional<FillTupleBufferResult> tryFillTupleBuffer(TupleBuffer& tupleBuffer, const std::stop_token& stopToken);
+
     /// If applicable, opens a connection, e.g., a socket connection to get ready for data consumption.
     virtual void open(std::shared_ptr<AbstractBufferProvider> bufferProvider) = 0;
     /// If applicable, closes a connection, e.g., a socket connection.
@@ -47,6 +47,10 @@ struct ParserConfig
     std::string tupleDelimiter;
     std::string fieldDelimiter;
     bool allowCommasInStrings{};
+    /// Interns the values of VARSIZED fields in a per-source dictionary, pays off for low-cardinality strings (see VarSizedDictionary)
+    bool dictionaryEncoding{};
+    /// Emits the formatted buffers of the source in the order of their sequence numbers, for downstream operators that rely on it
+    bool orderedOutput{};
     friend bool operator==(const ParserConfig& lhs, const ParserConfig& rhs) = default;
     friend std::ostream& operator<<(std::ostream& os, const ParserConfig& obj);
     static ParserConfig create(std::unordered_map<std::string, std::string> configMap);
@@ -106,10 +110,34 @@ public:
         INVALID_MAX_INFLIGHT_BUFFERS,
         [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(MAX_INFLIGHT_BUFFERS, config); }};
 
+    /// After the source did not emit a buffer for the timeout, it emits a heartbeat buffer without records in every timeout, so that an
+    /// idle source does not hold back the watermarks of the downstream window operators. Zero disables the heartbeats.
+    /// NOLINTNEXTLINE(cert-err58-cpp)
+    static inline const DescriptorConfig::ConfigParameter<uint64_t> IDLE_TIMEOUT_MS{
+        "idle_timeout_ms",
+        0,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(IDLE_TIMEOUT_MS, config); }};
+
+    /// Comma-separated fields, whose equal values the source delivers in runs, e.g., per-device batches. The aggregations that group by
+    /// these fields reuse the state of the previous record of a run (see ClusteredFieldsTrait). Empty declares no clustering.
+    /// NOLINTNEXTLINE(cert-err58-cpp)
+    static inline const DescriptorConfig::ConfigParameter<std::string> CLUSTERED_BY{
+        "clustered_by",
+        "",
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(CLUSTERED_BY, config); }};
+
+    /// Size of the raw buffers that the source fills, e.g., 1-4 MiB for high-rate file or TCP sources, which then emit fewer buffers,
+    /// or a few KiB for low-latency sources. The buffers come from the size classes of the buffer manager, if one fits, or from
+    /// unpooled memory. Zero takes the buffers of the global buffer size from the pool.
+    /// NOLINTNEXTLINE(cert-err58-cpp)
+    static inline const DescriptorConfig::ConfigParameter<size_t> BUFFER_SIZE_IN_BYTES{
+        "buffer_size_in_bytes",
+        0,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(BUFFER_SIZE_IN_BYTES, config); }};
 
     /// NOLINTNEXTLINE(cert-err58-cpp)
     static inline std::unordered_map<std::string, DescriptorConfig::ConfigParameterContainer> parameterMap
-        = DescriptorConfig::createConfigParameterContainerMap(MAX_INFLIGHT_BUFFERS);
+        = DescriptorConfig::createConfigParameterContainerMap(MAX_INFLIGHT_BUFFERS, IDLE_TIMEOUT_MS, CLUSTERED_BY, BUFFER_SIZE_IN_BYTES);
 };
 
 template <>
@@ -17,9 +17,11 @@
 #include <chrono>
 #include <cstddef>
 #include <memory>
+#include <vector>
 #include <Runtime/AbstractBufferProvider.hpp>
 #include <Sources/Source.hpp>
 #include <Sources/SourceReturnType.hpp>
+#include <Sources/SourceRunner.hpp>
 #include <Util/Logger/Formatter.hpp>
 #include <fmt/format.h>
 #include <fmt/ostream.h>
@@ -34,10 +36,17 @@ class SourceThread;
 struct SourceRuntimeConfiguration
 {
     size_t inflightBufferLimit;
+    /// If set, inflightBufferLimit is the maximum of a limit that adapts to how fast the query releases the buffers of the source
+    bool adaptiveInflightBufferLimit = false;
+    /// Zero, if the source does not emit heartbeats while it is idle
+    std::chrono::milliseconds idleTimeout{0};
+    /// Zero, if the source fills the pooled buffers of the global buffer size
+    size_t bufferSize = 0;
 };
 
 /// Interface class to handle sources.
 /// Created from a source descriptor via the SourceProvider.
+/// If a SourceRunner is given, sources that support non-blocking fills share the threads of the runner instead of owning a thread.
 /// start(): The underlying source starts consuming data. All queries using the source start processing.
 /// stop(): The underlying source stops consuming data, notifying the QueryEngine,
 /// that decides whether to keep queries, which used the particular source, alive.
@@ -49,7 +58,9 @@ public:
         OriginId originId, /// Todo #241: Rethink use of originId for sources, use new identifier for unique identification.
         SourceRuntimeConfiguration configuration,
         std::shared_ptr<AbstractBufferProvider> bufferPool,
-        std::unique_ptr<Source> sourceImplementation);
+        std::unique_ptr<Source> sourceImplementation,
+        std::shared_ptr<SourceRunner> sourceRunner = nullptr,
+        std::vector<size_t> sourceThreadCpus = {});
 
     ~SourceHandle();
 
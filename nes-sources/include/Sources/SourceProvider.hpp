@@ -13,13 +13,16 @@
 */
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <Identifiers/Identifiers.hpp>
 #include <Runtime/AbstractBufferProvider.hpp>
 #include <Sources/SourceDescriptor.hpp>
 #include <Sources/SourceHandle.hpp>
+#include <Sources/SourceRunner.hpp>
 #include <BackpressureChannel.hpp>
 
 namespace NES
@@ -32,14 +35,31 @@ class SourceProvider
 {
     size_t defaultMaxInflightBuffers;
     std::shared_ptr<AbstractBufferProvider> bufferPool;
+    std::vector<size_t> sourceThreadCpus;
+    std::shared_ptr<SourceRunner> sourceRunner;
+    bool adaptiveInflightBuffers;
 
 public:
     /// Constructor that can be configured with various options
-    SourceProvider(size_t defaultMaxInflightBuffers, std::shared_ptr<AbstractBufferProvider> bufferPool);
+    /// If numberOfMultiplexedSourceThreads is not 0, sources that support non-blocking fills share a SourceRunner with that many threads.
+    /// If sourceThreadCpus is not empty, all source threads (including the threads of the SourceRunner) are pinned to these cpus.
+    /// If adaptiveInflightBuffers is set, the inflight buffer limit of each source is the maximum of an adaptive limit.
+    SourceProvider(
+        size_t defaultMaxInflightBuffers,
+        std::shared_ptr<AbstractBufferProvider> bufferPool,
+        size_t numberOfMultiplexedSourceThreads = 0,
+        std::vector<size_t> sourceThreadCpus = {},
+        bool adaptiveInflightBuffers = false);
 
     /// Returning a shared pointer, because sources may be shared by multiple executable query plans (qeps).
-    [[nodiscard]] std::unique_ptr<SourceHandle>
-    lower(OriginId originId, BackpressureListener backpressureListener, const SourceDescriptor& sourceDescriptor) const;
+    /// If bufferProvider is set, the source requests its buffers from it instead of the buffer pool of the SourceProvider.
+    /// If projections is not empty, the source may skip reading all other fields (see SourceRegistryArguments::projections).
+    [[nodiscard]] std::unique_ptr<SourceHandle> lower(
+        OriginId originId,
+        BackpressureListener backpressureListener,
+        const SourceDescriptor& sourceDescriptor,
+        std::shared_ptr<AbstractBufferProvider> bufferProvider = nullptr,
+        std::vector<std::string> projections = {}) const;
 
     [[nodiscard]] bool contains(const std::string& sourceType) const;
 };
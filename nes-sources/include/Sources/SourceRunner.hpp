@@ -0,0 +1,89 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <vector>
+#include <Thread.hpp>
+
+namespace NES
+{
+
+/// A source that a SourceRunner drives in turns. A turn must not block, so that the threads of the runner can serve many sources.
+class RunnableSource
+{
+public:
+    enum class TurnResult : uint8_t
+    {
+        /// The source made progress, e.g., it emitted a buffer
+        Progress,
+        /// The source could not make progress, e.g., because of backpressure or because no data is available yet
+        Idle,
+        /// The source terminated and will not be driven again
+        Terminated
+    };
+
+    virtual ~RunnableSource() = default;
+    virtual TurnResult runTurn() = 0;
+};
+
+/// A fixed number of threads that drive many sources cooperatively, instead of one SourceThread per source.
+/// The runner keeps the sources in a round-robin queue. Every turn ingests at most one buffer, thus all sources progress fairly.
+/// A source that is throttled by its BackpressureListener or its buffer pool simply stays idle for its turn and does not block a thread.
+/// If the threads found no source that could make progress, they wait for IDLE_WAIT_INTERVAL or until a source wakes the runner.
+/// Destroying the runner drops the sources that did not terminate yet.
+class SourceRunner
+{
+public:
+    static constexpr auto IDLE_WAIT_INTERVAL = std::chrono::milliseconds(1);
+
+    /// The threads of the runner are pinned to the given cpus, unless the list is empty
+    explicit SourceRunner(size_t numberOfThreads, std::vector<size_t> threadCpus = {});
+    ~SourceRunner();
+
+    SourceRunner(const SourceRunner&) = delete;
+    SourceRunner(SourceRunner&&) = delete;
+    SourceRunner& operator=(const SourceRunner&) = delete;
+    SourceRunner& operator=(SourceRunner&&) = delete;
+
+    /// Drives the source until its turn returns `Terminated`.
+    void add(std::shared_ptr<RunnableSource> source);
+
+    /// Wakes idle threads, e.g., after a stop of a source was requested.
+    void wake();
+
+    [[nodiscard]] size_t getNumberOfSources() const;
+
+private:
+    void runTurns(const std::stop_token& stopToken);
+
+    mutable std::mutex mutex;
+    std::condition_variable_any sourceAvailable;
+    std::deque<std::shared_ptr<RunnableSource>> sources;
+    /// Sources that are currently driven by a thread
+    size_t numberOfActiveSources = 0;
+    /// Incremented by every add and wake, which ends the idle wait of the threads
+    uint64_t numberOfWakeups = 0;
+    std::vector<Thread> threads;
+};
+
+}
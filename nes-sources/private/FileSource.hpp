@@ -15,7 +15,9 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <fstream>
 #include <memory>
 #include <optional>
@@ -25,8 +27,10 @@
 #include <unordered_map>
 #include <Runtime/AbstractBufferProvider.hpp>
 #include <Runtime/TupleBuffer.hpp>
+#include <Sources/IoUringReactor.hpp>
 #include <Sources/Source.hpp>
 #include <Sources/SourceDescriptor.hpp>
+#include <ErrorHandling.hpp>
 
 namespace NES
 {
@@ -49,6 +53,10 @@ public:
     FillTupleBufferResult fillTupleBuffer(TupleBuffer& tupleBuffer, const std::stop_token& stopToken) override;
 
     /// Open file socket.
+    /// In the io_uring mode, the shared I/O threads read the file directly into the buffers.
+    /// In the memory-mapped mode, maps the whole file read-only, so that filling a buffer copies the bytes straight out of the page cache
+    /// without a read syscall per buffer.
+    /// In the replay mode, additionally preloads the whole mapping, so that reading the file does not delay emitting the buffers on time.
     void open(std::shared_ptr<AbstractBufferProvider> bufferProvider) override;
     /// Close file socket.
     void close() override;
@@ -59,9 +67,44 @@ public:
     [[nodiscard]] std::ostream& toString(std::ostream& str) const override;
 
 private:
+    /// Size of the window of the mapped file that we advise the kernel to read ahead of the current read position
+    static constexpr size_t READ_AHEAD_WINDOW_SIZE = 16 * 1024 * 1024;
+
+    FillTupleBufferResult fillTupleBufferFromMappedFile(TupleBuffer& tupleBuffer);
+    /// Returns nullopt, if the event time of the next tuple has not been reached yet
+    std::optional<FillTupleBufferResult> tryFillTupleBufferFromReplay(TupleBuffer& tupleBuffer);
+    FillTupleBufferResult fillTupleBufferFromReplay(TupleBuffer& tupleBuffer, const std::stop_token& stopToken);
+    /// Returns the time at which the replay emits the tuple, which is a view of the mapped file without the tuple delimiter
+    std::chrono::steady_clock::time_point getReplayTime(std::string_view tuple);
+    FillTupleBufferResult fillTupleBufferViaIoUring(TupleBuffer& tupleBuffer, const std::stop_token& stopToken);
+
     std::ifstream inputFile;
     std::string filePath;
+    bool memoryMapped;
+    bool useIoUring;
+    const char* mappedFile = nullptr;
+    size_t mappedFileSize = 0;
+    size_t mappedFileOffset = 0;
+    /// Offset up to which we advised the kernel to read the mapped file ahead
+    size_t mappedFileReadAheadOffset = 0;
+    /// Offset up to which we released the pages of the mapped file that we already read
+    size_t mappedFileReleaseOffset = 0;
+    /// The io_uring mode reads via the reactor that all sources share
+    std::shared_ptr<IoUringReactor> ioUringReactor;
+    int fileDescriptor = -1;
+    uint64_t fileOffset = 0;
     std::atomic<size_t> totalNumBytesRead;
+
+    /// The replay mode emits the tuples of the mapped file at the pace of the event times in the field 'replayTimestampField'
+    std::optional<size_t> replayTimestampField;
+    float replaySpeedup;
+    std::string tupleDelimiter;
+    std::string fieldDelimiter;
+    std::optional<std::chrono::steady_clock::time_point> replayStartTime;
+    std::optional<uint64_t> firstReplayTimestamp;
+    std::chrono::steady_clock::time_point nextReplayTime;
+    /// Bytes of a tuple that did not fit into the prior buffer, which the replay emits before pacing the next tuple
+    size_t pendingBytesOfReplayedTuple = 0;
 };
 
 struct ConfigParametersCSV
@@ -70,9 +113,43 @@ struct ConfigParametersCSV
         std::string(SYSTEST_FILE_PATH_PARAMETER),
         std::nullopt,
         [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(FILEPATH, config); }};
+    /// Reads the file via a read-only memory mapping instead of a file stream
+    static inline const DescriptorConfig::ConfigParameter<bool> MEMORY_MAPPED{
+        "memory_mapped",
+        false,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(MEMORY_MAPPED, config); }};
+
+    /// Reads the file via the io_uring reactor that all sources share (see IoUringReactor)
+    static inline const DescriptorConfig::ConfigParameter<bool> IO_URING{
+        "io_uring",
+        false,
+        [](const std::unordered_map<std::string, std::string>& config) { return DescriptorConfig::tryGet(IO_URING, config); }};
+
+    /// Replays the tuples at the pace of the event times (in milliseconds) in the field with the given index, e.g., to reproduce the
+    /// arrival pattern of a recorded stream. The replay memory-maps and preloads the file. A negative index reads it as fast as possible.
+    static inline const DescriptorConfig::ConfigParameter<int32_t> REPLAY_TIMESTAMP_FIELD{
+        "replay_timestamp_field",
+        -1,
+        [](const std::unordered_map<std::string, std::string>& config)
+        { return DescriptorConfig::tryGet(REPLAY_TIMESTAMP_FIELD, config); }};
+
+    /// Speeds up the replay by the given factor, e.g., 10 emits the tuples of ten seconds of event time per second
+    static inline const DescriptorConfig::ConfigParameter<float> REPLAY_SPEEDUP{
+        "replay_speedup",
+        1,
+        [](const std::unordered_map<std::string, std::string>& config)
+        {
+            const auto speedup = DescriptorConfig::tryGet(REPLAY_SPEEDUP, config);
+            if (speedup.has_value() and not(speedup.value() > 0))
+            {
+                throw InvalidConfigParameter("The replay speedup must be positive, but was {}", speedup.value());
+            }
+            return speedup;
+        }};
 
     static inline std::unordered_map<std::string, DescriptorConfig::ConfigParameterContainer> parameterMap
-        = DescriptorConfig::createConfigParameterContainerMap(SourceDescriptor::parameterMap, FILEPATH);
+        = DescriptorConfig::createConfigParameterContainerMap(
+            SourceDescriptor::parameterMap, FILEPATH, MEMORY_MAPPED, IO_URING, REPLAY_TIMESTAMP_FIELD, REPLAY_SPEEDUP);
 };
 
 }
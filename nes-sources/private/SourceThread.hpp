@@ -15,6 +15,7 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <future>
@@ -22,11 +23,13 @@
 #include <ostream>
 #include <stop_token>
 #include <thread>
+#include <vector>
 #include <Identifiers/Identifiers.hpp>
 #include <Runtime/AbstractBufferProvider.hpp>
 #include <Runtime/TupleBuffer.hpp>
 #include <Sources/Source.hpp>
 #include <Sources/SourceReturnType.hpp>
+#include <Sources/SourceRunner.hpp>
 #include <Util/Logger/Formatter.hpp>
 #include <magic_enum/magic_enum.hpp>
 #include <BackpressureChannel.hpp>
@@ -58,11 +61,20 @@ class SourceThread
     static constexpr auto STOP_TIMEOUT_RUNNING = std::chrono::seconds(300);
 
 public:
+    /// If a sourceRunner is given and the source supports non-blocking fills, the runner drives the source instead of a dedicated thread.
+    /// A dedicated thread is pinned to the threadCpus, unless the list is empty.
+    /// If the idleTimeout is not zero, the source emits heartbeat buffers without records while it did not emit a buffer for the timeout.
+    /// If the bufferSize is not zero, the source fills buffers of the size instead of the pooled buffers of the bufferManager.
     explicit SourceThread(
         BackpressureListener backpressureListener,
         OriginId originId, /// Todo #241: Rethink use of originId for sources, use new identifier for unique identification.
         std::shared_ptr<AbstractBufferProvider> bufferManager,
-        std::unique_ptr<Source> sourceImplementation);
+        std::unique_ptr<Source> sourceImplementation,
+        std::shared_ptr<SourceRunner> sourceRunner = nullptr,
+        std::vector<size_t> threadCpus = {},
+        std::chrono::milliseconds idleTimeout = std::chrono::milliseconds(0),
+        size_t bufferSize = 0);
+    ~SourceThread();
 
     SourceThread() = delete;
     SourceThread(const SourceThread& other) = delete;
@@ -94,12 +106,22 @@ protected:
     std::unique_ptr<Source> sourceImplementation;
     std::atomic_bool started;
     BackpressureListener backpressureListener;
+    std::vector<size_t> threadCpus;
+    std::chrono::milliseconds idleTimeout;
+    size_t bufferSize;
 
     /// Order is important. Member destruction happens in reverse order. We first destroy the thread (which
     /// uses the terminationFuture), then the terminationFuture.
     std::future<SourceImplementationTermination> terminationFuture;
     Thread thread;
 
+    /// Only used if the source is driven by the sourceRunner
+    std::shared_ptr<SourceRunner> sourceRunner;
+    std::stop_source multiplexedStopSource;
+    bool multiplexedRunning = false;
+
+    [[nodiscard]] bool isMultiplexed() const;
+
     /// Runs in detached thread and kills thread when finishing.
     /// while (running) { ... }: orchestrates data ingestion until end of stream or failure.
     void runningRoutine(const std::stop_token& stopToken, std::promise<SourceImplementationTermination>&);
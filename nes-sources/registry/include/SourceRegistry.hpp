@@ -16,6 +16,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <Sources/Source.hpp>
 #include <Sources/SourceDescriptor.hpp>
@@ -29,6 +30,9 @@ using SourceRegistryReturnType = std::unique_ptr<Source>;
 struct SourceRegistryArguments
 {
     SourceDescriptor sourceDescriptor;
+    /// The fields of the schema that the successors of the source read, or empty, if they read all fields. A source may skip reading
+    /// the other fields, but must keep the layout of the schema in the buffers that it fills.
+    std::vector<std::string> projections;
 };
 
 class SourceRegistry : public BaseRegistry<SourceRegistry, std::string, SourceRegistryReturnType, SourceRegistryArguments>
@@ -0,0 +1,57 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Sources/ColumnStatistics.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+
+namespace NES
+{
+
+double ColumnStatistics::getNullFraction() const
+{
+    if (numberOfSampledValues == 0)
+    {
+        return 0;
+    }
+    return static_cast<double>(numberOfNullValues) / static_cast<double>(numberOfSampledValues);
+}
+
+std::optional<double> ColumnStatistics::estimateFractionAtMost(const double value) const
+{
+    if (histogramBounds.size() < 2)
+    {
+        return std::nullopt;
+    }
+    if (value < histogramBounds.front())
+    {
+        return 0.0;
+    }
+    if (value >= histogramBounds.back())
+    {
+        return 1.0;
+    }
+    /// The bucket i spans [bounds[i], bounds[i + 1]], thus, the first bound that is larger than the value ends its bucket
+    const auto upperBound = std::ranges::upper_bound(histogramBounds, value);
+    const auto bucket = static_cast<size_t>(std::distance(histogramBounds.begin(), upperBound)) - 1;
+    const auto lower = histogramBounds[bucket];
+    const auto upper = histogramBounds[bucket + 1];
+    const auto fractionOfBucket = upper > lower ? (value - lower) / (upper - lower) : 1.0;
+    return (static_cast<double>(bucket) + fractionOfBucket) / static_cast<double>(histogramBounds.size() - 1);
+}
+
+}
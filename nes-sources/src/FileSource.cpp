@@ -14,7 +14,13 @@
 
 #include <FileSource.hpp>
 
+#include <algorithm>
 #include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <format>
@@ -22,14 +28,24 @@
 #include <ios>
 #include <istream>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <ostream>
 #include <stop_token>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <unordered_map>
 #include <utility>
+#include <variant>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <Configurations/Descriptor.hpp>
 #include <Runtime/AbstractBufferProvider.hpp>
 #include <Runtime/TupleBuffer.hpp>
+#include <Sources/IoUringReactor.hpp>
 #include <Sources/Source.hpp>
 #include <Sources/SourceDescriptor.hpp>
 #include <Util/Files.hpp>
@@ -42,27 +58,302 @@
 namespace NES
 {
 
-FileSource::FileSource(const SourceDescriptor& sourceDescriptor) : filePath(sourceDescriptor.getFromConfig(ConfigParametersCSV::FILEPATH))
+FileSource::FileSource(const SourceDescriptor& sourceDescriptor)
+    : filePath(sourceDescriptor.getFromConfig(ConfigParametersCSV::FILEPATH))
+    , memoryMapped(sourceDescriptor.getFromConfig(ConfigParametersCSV::MEMORY_MAPPED))
+    , useIoUring(sourceDescriptor.getFromConfig(ConfigParametersCSV::IO_URING))
+    , replaySpeedup(sourceDescriptor.getFromConfig(ConfigParametersCSV::REPLAY_SPEEDUP))
+    , tupleDelimiter(sourceDescriptor.getParserConfig().tupleDelimiter)
+    , fieldDelimiter(sourceDescriptor.getParserConfig().fieldDelimiter)
 {
+    if (const auto timestampField = sourceDescriptor.getFromConfig(ConfigParametersCSV::REPLAY_TIMESTAMP_FIELD); timestampField >= 0)
+    {
+        this->replayTimestampField = static_cast<size_t>(timestampField);
+        this->memoryMapped = true;
+    }
 }
 
 void FileSource::open(std::shared_ptr<AbstractBufferProvider>)
 {
     const auto realCSVPath = std::unique_ptr<char, decltype(std::free)*>{realpath(this->filePath.c_str(), nullptr), std::free};
-    this->inputFile = std::ifstream(realCSVPath.get(), std::ios::binary);
-    if (not this->inputFile)
+    if (useIoUring)
+    {
+        this->fileDescriptor = realCSVPath ? ::open(realCSVPath.get(), O_RDONLY | O_CLOEXEC) : -1;
+        if (this->fileDescriptor < 0)
+        {
+            throw InvalidConfigParameter("Could not open file: {} - {}", this->filePath.c_str(), getErrorMessageFromERRNO());
+        }
+        this->fileOffset = 0;
+        this->ioUringReactor = IoUringReactor::getShared();
+        return;
+    }
+    if (not memoryMapped)
+    {
+        this->inputFile = std::ifstream(realCSVPath.get(), std::ios::binary);
+        if (not this->inputFile)
+        {
+            throw InvalidConfigParameter(
+                "Could not determine absolute pathname: {} - {}", this->filePath.c_str(), getErrorMessageFromERRNO());
+        }
+        return;
+    }
+
+    const auto fileDescriptor = realCSVPath ? ::open(realCSVPath.get(), O_RDONLY | O_CLOEXEC) : -1;
+    if (fileDescriptor < 0)
     {
-        throw InvalidConfigParameter("Could not determine absolute pathname: {} - {}", this->filePath.c_str(), getErrorMessageFromERRNO());
+        throw InvalidConfigParameter("Could not open file: {} - {}", this->filePath.c_str(), getErrorMessageFromERRNO());
     }
+    /// The mapping stays valid after closing the file descriptor
+    struct stat fileStatus{};
+    if (fstat(fileDescriptor, &fileStatus) != 0)
+    {
+        const auto errorMessage = getErrorMessageFromERRNO();
+        ::close(fileDescriptor);
+        throw InvalidConfigParameter("Could not determine the size of file: {} - {}", this->filePath.c_str(), errorMessage);
+    }
+    this->mappedFileSize = static_cast<size_t>(fileStatus.st_size);
+    this->mappedFileOffset = 0;
+    this->mappedFileReadAheadOffset = 0;
+    this->mappedFileReleaseOffset = 0;
+    if (this->mappedFileSize == 0)
+    {
+        /// Mapping an empty file fails, an empty file simply yields end of stream
+        ::close(fileDescriptor);
+        return;
+    }
+    void* mapping = mmap(nullptr, this->mappedFileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    ::close(fileDescriptor);
+    if (mapping == MAP_FAILED)
+    {
+        throw InvalidConfigParameter("Could not memory-map file: {} - {}", this->filePath.c_str(), getErrorMessageFromERRNO());
+    }
+    this->mappedFile = static_cast<const char*>(mapping);
+    if (this->replayTimestampField.has_value())
+    {
+        /// Preloads the mapping by touching every page, as page faults during the replay would delay the emission of the buffers
+        madvise(mapping, this->mappedFileSize, MADV_WILLNEED);
+        const auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        volatile char touched = 0;
+        for (size_t offset = 0; offset < this->mappedFileSize; offset += pageSize)
+        {
+            touched = touched + this->mappedFile[offset];
+        }
+        this->replayStartTime.reset();
+        this->firstReplayTimestamp.reset();
+        this->pendingBytesOfReplayedTuple = 0;
+        return;
+    }
+    madvise(mapping, this->mappedFileSize, MADV_SEQUENTIAL);
 }
 
 void FileSource::close()
 {
-    this->inputFile.close();
+    if (useIoUring)
+    {
+        if (this->fileDescriptor >= 0)
+        {
+            ::close(this->fileDescriptor);
+            this->fileDescriptor = -1;
+        }
+        this->ioUringReactor.reset();
+        return;
+    }
+    if (not memoryMapped)
+    {
+        this->inputFile.close();
+        return;
+    }
+    if (this->mappedFile != nullptr)
+    {
+        munmap(const_cast<char*>(this->mappedFile), this->mappedFileSize); /// NOLINT(cppcoreguidelines-pro-type-const-cast)
+        this->mappedFile = nullptr;
+    }
+}
+
+Source::FillTupleBufferResult FileSource::fillTupleBufferFromMappedFile(TupleBuffer& tupleBuffer)
+{
+    const auto numBytesRead = std::min<size_t>(tupleBuffer.getBufferSize(), this->mappedFileSize - this->mappedFileOffset);
+    if (numBytesRead == 0)
+    {
+        return FillTupleBufferResult::eos();
+    }
+
+    /// Keep the kernel one window ahead of the read position and release the pages behind it, which bounds the resident memory of the
+    /// mapping for files that are larger than the main memory.
+    /// Advice only affects the performance, thus we ignore failing calls to madvise.
+    const auto endOfRead = this->mappedFileOffset + numBytesRead;
+    if (endOfRead > this->mappedFileReadAheadOffset)
+    {
+        const auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        const auto readAheadBegin = this->mappedFileReadAheadOffset - (this->mappedFileReadAheadOffset % pageSize);
+        const auto readAheadEnd = std::min(this->mappedFileSize, endOfRead + READ_AHEAD_WINDOW_SIZE);
+        madvise(const_cast<char*>(this->mappedFile) + readAheadBegin, readAheadEnd - readAheadBegin, MADV_WILLNEED); /// NOLINT
+        const auto releaseEnd = this->mappedFileOffset - (this->mappedFileOffset % pageSize);
+        if (releaseEnd > this->mappedFileReleaseOffset)
+        {
+            madvise(
+                const_cast<char*>(this->mappedFile) + this->mappedFileReleaseOffset, /// NOLINT
+                releaseEnd - this->mappedFileReleaseOffset,
+                MADV_DONTNEED);
+            this->mappedFileReleaseOffset = releaseEnd;
+        }
+        this->mappedFileReadAheadOffset = readAheadEnd;
+    }
+
+    std::memcpy(tupleBuffer.getAvailableMemoryArea<char>().data(), this->mappedFile + this->mappedFileOffset, numBytesRead);
+    this->mappedFileOffset = endOfRead;
+    this->totalNumBytesRead += numBytesRead;
+    return FillTupleBufferResult::withBytes(numBytesRead);
+}
+
+std::chrono::steady_clock::time_point FileSource::getReplayTime(const std::string_view tuple)
+{
+    /// Skips the fields before the timestamp field and parses the timestamp up to the next field delimiter
+    std::string_view field = tuple;
+    for (size_t fieldIndex = 0; fieldIndex < this->replayTimestampField.value() and not field.empty(); ++fieldIndex)
+    {
+        const auto delimiter = field.find(this->fieldDelimiter);
+        field = delimiter == std::string_view::npos ? std::string_view{} : field.substr(delimiter + this->fieldDelimiter.size());
+    }
+    field = field.substr(0, field.find(this->fieldDelimiter));
+    const auto valueBegin = field.find_first_not_of(' ');
+    uint64_t timestamp = 0;
+    if (valueBegin == std::string_view::npos
+        or std::from_chars(field.data() + valueBegin, field.data() + field.size(), timestamp).ec != std::errc{})
+    {
+        /// Tuples without a valid timestamp, e.g., a header line, do not delay the replay
+        return std::chrono::steady_clock::now();
+    }
+
+    if (not this->firstReplayTimestamp.has_value())
+    {
+        this->firstReplayTimestamp = timestamp;
+    }
+    /// Tuples that are out of order are emitted immediately
+    const auto eventTimeSinceStart = timestamp > this->firstReplayTimestamp.value() ? timestamp - this->firstReplayTimestamp.value() : 0;
+    const auto replayedTimeSinceStart
+        = std::chrono::duration<double, std::milli>(static_cast<double>(eventTimeSinceStart) / static_cast<double>(this->replaySpeedup));
+    return this->replayStartTime.value() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(replayedTimeSinceStart);
+}
+
+std::optional<Source::FillTupleBufferResult> FileSource::tryFillTupleBufferFromReplay(TupleBuffer& tupleBuffer)
+{
+    if (this->mappedFileOffset == this->mappedFileSize)
+    {
+        return FillTupleBufferResult::eos();
+    }
+    const auto now = std::chrono::steady_clock::now();
+    if (not this->replayStartTime.has_value())
+    {
+        this->replayStartTime = now;
+    }
+
+    const auto buffer = tupleBuffer.getAvailableMemoryArea<char>();
+    const std::string_view remainingFile{this->mappedFile + this->mappedFileOffset, this->mappedFileSize - this->mappedFileOffset};
+    size_t numBytesRead = 0;
+    if (this->pendingBytesOfReplayedTuple > 0)
+    {
+        /// The rest of a tuple that is larger than a buffer is due already
+        numBytesRead = std::min(this->pendingBytesOfReplayedTuple, buffer.size());
+        this->pendingBytesOfReplayedTuple -= numBytesRead;
+    }
+    else
+    {
+        /// Adds all complete tuples that are due and fit into the buffer
+        while (numBytesRead < remainingFile.size())
+        {
+            const auto tupleEnd = remainingFile.find(this->tupleDelimiter, numBytesRead);
+            const auto tuple = remainingFile.substr(
+                numBytesRead, tupleEnd == std::string_view::npos ? std::string_view::npos : tupleEnd - numBytesRead);
+            const auto sizeOfTuple = std::min(tuple.size() + this->tupleDelimiter.size(), remainingFile.size() - numBytesRead);
+            if (const auto replayTime = getReplayTime(tuple); replayTime > now)
+            {
+                this->nextReplayTime = replayTime;
+                break;
+            }
+            if (numBytesRead + sizeOfTuple > buffer.size())
+            {
+                if (numBytesRead == 0)
+                {
+                    /// The tuple does not fit into an empty buffer, thus we emit it in several buffers
+                    numBytesRead = buffer.size();
+                    this->pendingBytesOfReplayedTuple = sizeOfTuple - buffer.size();
+                }
+                break;
+            }
+            numBytesRead += sizeOfTuple;
+        }
+    }
+    if (numBytesRead == 0)
+    {
+        return std::nullopt;
+    }
+
+    std::memcpy(buffer.data(), remainingFile.data(), numBytesRead);
+    this->mappedFileOffset += numBytesRead;
+    this->totalNumBytesRead += numBytesRead;
+    return FillTupleBufferResult::withBytes(numBytesRead);
+}
+
+Source::FillTupleBufferResult FileSource::fillTupleBufferFromReplay(TupleBuffer& tupleBuffer, const std::stop_token& stopToken)
+{
+    std::mutex mutex;
+    std::condition_variable_any stopped;
+    std::unique_lock lock(mutex);
+    while (not stopToken.stop_requested())
+    {
+        if (auto result = tryFillTupleBufferFromReplay(tupleBuffer))
+        {
+            return result.value();
+        }
+        stopped.wait_until(lock, stopToken, this->nextReplayTime, [] { return false; });
+    }
+    return FillTupleBufferResult::eos();
+}
+
+Source::FillTupleBufferResult FileSource::fillTupleBufferViaIoUring(TupleBuffer& tupleBuffer, const std::stop_token& stopToken)
+{
+    /// Reads of regular files only return fewer bytes than requested at the end of the file
+    const auto buffer = tupleBuffer.getAvailableMemoryArea();
+    size_t numBytesRead = 0;
+    while (numBytesRead < buffer.size())
+    {
+        const auto result = this->ioUringReactor->read(
+            this->fileDescriptor, buffer.subspan(numBytesRead), this->fileOffset, std::chrono::milliseconds::zero(), stopToken);
+        if (not result.has_value() or result.value() == 0)
+        {
+            /// Stop requested or end of file
+            break;
+        }
+        if (result.value() < 0)
+        {
+            throw RunningRoutineFailure("Could not read file: {} - {}", this->filePath, getErrorMessage(static_cast<int>(-result.value())));
+        }
+        numBytesRead += static_cast<size_t>(result.value());
+        this->fileOffset += static_cast<uint64_t>(result.value());
+    }
+    this->totalNumBytesRead += numBytesRead;
+    if (numBytesRead == 0)
+    {
+        return FillTupleBufferResult::eos();
+    }
+    return FillTupleBufferResult::withBytes(numBytesRead);
 }
 
-Source::FillTupleBufferResult FileSource::fillTupleBuffer(TupleBuffer& tupleBuffer, const std::stop_token&)
+Source::FillTupleBufferResult FileSource::fillTupleBuffer(TupleBuffer& tupleBuffer, const std::stop_token& stopToken)
 {
+    if (useIoUring)
+    {
+        return fillTupleBufferViaIoUring(tupleBuffer, stopToken);
+    }
+    if (replayTimestampField.has_value())
+    {
+        return fillTupleBufferFromReplay(tupleBuffer, stopToken);
+    }
+    if (memoryMapped)
+    {
+        return fillTupleBufferFromMappedFile(tupleBuffer);
+    }
     this->inputFile.read(
         tupleBuffer.getAvailableMemoryArea<std::istream::char_type>().data(), static_cast<std::streamsize>(tupleBuffer.getBufferSize()));
     const auto numBytesRead = this->inputFile.gcount();
@@ -76,12 +367,34 @@ Source::FillTupleBufferResult FileSource::fillTupleBuffer(TupleBuffer& tupleBuff
 
 DescriptorConfig::Config FileSource::validateAndFormat(std::unordered_map<std::string, std::string> config)
 {
-    return DescriptorConfig::validateAndFormat<ConfigParametersCSV>(std::move(config), NAME);
+    auto validatedConfig = DescriptorConfig::validateAndFormat<ConfigParametersCSV>(std::move(config), NAME);
+    const auto isEnabled = [&validatedConfig](const DescriptorConfig::ConfigParameter<bool>& parameter)
+    {
+        const auto value = validatedConfig.find(parameter.name);
+        return value != validatedConfig.end() and std::get<bool>(value->second);
+    };
+    if (isEnabled(ConfigParametersCSV::MEMORY_MAPPED) and isEnabled(ConfigParametersCSV::IO_URING))
+    {
+        throw InvalidConfigParameter("The FileSource can either memory-map the file or read it via io_uring, but not both");
+    }
+    if (const auto timestampField = validatedConfig.find(ConfigParametersCSV::REPLAY_TIMESTAMP_FIELD.name);
+        timestampField != validatedConfig.end() and std::get<int32_t>(timestampField->second) >= 0
+        and isEnabled(ConfigParametersCSV::IO_URING))
+    {
+        throw InvalidConfigParameter("The FileSource replays a memory-mapped file, thus it cannot read it via io_uring");
+    }
+    return validatedConfig;
 }
 
 std::ostream& FileSource::toString(std::ostream& str) const
 {
-    str << std::format("\nFileSource(filepath: {}, totalNumBytesRead: {})", this->filePath, this->totalNumBytesRead.load());
+    str << std::format(
+        "\nFileSource(filepath: {}, memoryMapped: {}, replayTimestampField: {}, replaySpeedup: {}, totalNumBytesRead: {})",
+        this->filePath,
+        this->memoryMapped,
+        this->replayTimestampField.transform([](const size_t field) { return std::to_string(field); }).value_or("none"),
+        this->replaySpeedup,
+        this->totalNumBytesRead.load());
     return str;
 }
 
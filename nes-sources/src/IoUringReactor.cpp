@@ -0,0 +1,447 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Sources/IoUringReactor.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <fmt/format.h>
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <Util/Files.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <ErrorHandling.hpp>
+#include <Thread.hpp>
+
+namespace NES
+{
+
+/// One io_uring that is driven by one I/O thread. Sources enqueue requests, the I/O thread moves them into the submission queue, submits
+/// them to the kernel, and invokes the completion callbacks. Thus, only the I/O thread accesses the ring itself.
+class IoUringRing
+{
+    /// The user data of a completion identifies the request that completed
+    static constexpr uint64_t WAKEUP_ID = 0;
+    static constexpr uint64_t CANCEL_ID = 1;
+    static constexpr uint64_t FIRST_READ_ID = 2;
+
+    struct Request
+    {
+        enum class Kind : uint8_t
+        {
+            READ,
+            CANCEL
+        } kind;
+
+        uint64_t id;
+        int fileDescriptor;
+        std::span<std::byte> buffer;
+        uint64_t offset;
+        IoUringReactor::CompletionCallback onCompletion;
+    };
+
+public:
+    explicit IoUringRing(size_t ringIndex);
+    ~IoUringRing();
+
+    IoUringRing(const IoUringRing&) = delete;
+    IoUringRing(IoUringRing&&) = delete;
+    IoUringRing& operator=(const IoUringRing&) = delete;
+    IoUringRing& operator=(IoUringRing&&) = delete;
+
+    uint64_t submitRead(int fileDescriptor, std::span<std::byte> buffer, uint64_t offset, IoUringReactor::CompletionCallback onCompletion);
+    void cancel(uint64_t readId);
+
+private:
+    void run(const std::stop_token& stopToken);
+    void wakeup() const;
+    /// Returns false, if the submission queue is full
+    bool tryPrepare(const Request& request);
+    void prepareWakeup();
+    void reapCompletions();
+
+    int ringFileDescriptor = -1;
+    int wakeupFileDescriptor = -1;
+    uint64_t wakeupValue = 0;
+
+    void* submissionRing = nullptr;
+    size_t submissionRingSize = 0;
+    void* completionRing = nullptr;
+    size_t completionRingSize = 0;
+    io_uring_sqe* submissionEntries = nullptr;
+    size_t submissionEntriesSize = 0;
+
+    uint32_t* submissionHead = nullptr;
+    uint32_t* submissionTail = nullptr;
+    uint32_t submissionMask = 0;
+    uint32_t numberOfSubmissionEntries = 0;
+    uint32_t* submissionArray = nullptr;
+    uint32_t* completionHead = nullptr;
+    uint32_t* completionTail = nullptr;
+    uint32_t completionMask = 0;
+    io_uring_cqe* completionEntries = nullptr;
+    /// Number of prepared entries that we did not yet submit to the kernel
+    uint32_t numberOfUnsubmittedEntries = 0;
+
+    std::atomic<uint64_t> nextReadId{FIRST_READ_ID};
+    std::mutex mutex;
+    std::deque<Request> pendingRequests;
+    /// Only accessed by the I/O thread
+    std::unordered_map<uint64_t, IoUringReactor::CompletionCallback> inflightReads;
+
+    /// Must be the last member, as the I/O thread accesses all other members
+    Thread thread;
+};
+
+namespace
+{
+template <typename T>
+T* atOffset(void* base, const uint32_t offset)
+{
+    return reinterpret_cast<T*>(static_cast<std::byte*>(base) + offset); /// NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+void* mapRing(const int ringFileDescriptor, const size_t size, const off_t offset)
+{
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFileDescriptor, offset);
+    if (mapping == MAP_FAILED)
+    {
+        throw CannotOpenSource("Could not map the io_uring: {}", getErrorMessageFromERRNO());
+    }
+    return mapping;
+}
+}
+
+IoUringRing::IoUringRing(const size_t ringIndex)
+{
+    io_uring_params parameters{};
+    ringFileDescriptor = static_cast<int>(syscall(__NR_io_uring_setup, IoUringReactor::NUMBER_OF_RING_ENTRIES, &parameters));
+    if (ringFileDescriptor < 0)
+    {
+        throw CannotOpenSource("Could not set up an io_uring: {}", getErrorMessageFromERRNO());
+    }
+
+    submissionRingSize = parameters.sq_off.array + (parameters.sq_entries * sizeof(uint32_t));
+    completionRingSize = parameters.cq_off.cqes + (parameters.cq_entries * sizeof(io_uring_cqe));
+    const bool isSingleMapping = (parameters.features & IORING_FEAT_SINGLE_MMAP) != 0U;
+    if (isSingleMapping)
+    {
+        submissionRingSize = completionRingSize = std::max(submissionRingSize, completionRingSize);
+    }
+    submissionRing = mapRing(ringFileDescriptor, submissionRingSize, IORING_OFF_SQ_RING);
+    completionRing = isSingleMapping ? submissionRing : mapRing(ringFileDescriptor, completionRingSize, IORING_OFF_CQ_RING);
+    submissionEntriesSize = parameters.sq_entries * sizeof(io_uring_sqe);
+    submissionEntries = static_cast<io_uring_sqe*>(mapRing(ringFileDescriptor, submissionEntriesSize, IORING_OFF_SQES));
+
+    submissionHead = atOffset<uint32_t>(submissionRing, parameters.sq_off.head);
+    submissionTail = atOffset<uint32_t>(submissionRing, parameters.sq_off.tail);
+    submissionMask = *atOffset<uint32_t>(submissionRing, parameters.sq_off.ring_mask);
+    numberOfSubmissionEntries = *atOffset<uint32_t>(submissionRing, parameters.sq_off.ring_entries);
+    submissionArray = atOffset<uint32_t>(submissionRing, parameters.sq_off.array);
+    completionHead = atOffset<uint32_t>(completionRing, parameters.cq_off.head);
+    completionTail = atOffset<uint32_t>(completionRing, parameters.cq_off.tail);
+    completionMask = *atOffset<uint32_t>(completionRing, parameters.cq_off.ring_mask);
+    completionEntries = atOffset<io_uring_cqe>(completionRing, parameters.cq_off.cqes);
+
+    wakeupFileDescriptor = eventfd(0, EFD_CLOEXEC);
+    if (wakeupFileDescriptor < 0)
+    {
+        throw CannotOpenSource("Could not create the eventfd of an io_uring: {}", getErrorMessageFromERRNO());
+    }
+    thread = Thread(fmt::format("IoUring-{}", ringIndex), [this](const std::stop_token& stopToken) { run(stopToken); });
+}
+
+IoUringRing::~IoUringRing()
+{
+    thread.requestStop();
+    wakeup();
+    /// Joins the I/O thread
+    thread = Thread{};
+
+    munmap(submissionEntries, submissionEntriesSize);
+    if (completionRing != submissionRing)
+    {
+        munmap(completionRing, completionRingSize);
+    }
+    munmap(submissionRing, submissionRingSize);
+    ::close(wakeupFileDescriptor);
+    ::close(ringFileDescriptor);
+}
+
+uint64_t IoUringRing::submitRead(
+    const int fileDescriptor, const std::span<std::byte> buffer, const uint64_t offset, IoUringReactor::CompletionCallback onCompletion)
+{
+    const auto readId = nextReadId.fetch_add(1, std::memory_order_relaxed);
+    {
+        const std::scoped_lock lock(mutex);
+        pendingRequests.emplace_back(Request{
+            .kind = Request::Kind::READ,
+            .id = readId,
+            .fileDescriptor = fileDescriptor,
+            .buffer = buffer,
+            .offset = offset,
+            .onCompletion = std::move(onCompletion)});
+    }
+    wakeup();
+    return readId;
+}
+
+void IoUringRing::cancel(const uint64_t readId)
+{
+    {
+        const std::scoped_lock lock(mutex);
+        pendingRequests.emplace_back(
+            Request{.kind = Request::Kind::CANCEL, .id = readId, .fileDescriptor = -1, .buffer = {}, .offset = 0, .onCompletion = {}});
+    }
+    wakeup();
+}
+
+void IoUringRing::wakeup() const
+{
+    constexpr uint64_t increment = 1;
+    /// A failing write can only mean that the counter of the eventfd is about to overflow, in which case the I/O thread wakes up anyway
+    std::ignore = ::write(wakeupFileDescriptor, &increment, sizeof(increment));
+}
+
+bool IoUringRing::tryPrepare(const Request& request)
+{
+    const auto tail = *submissionTail;
+    if (tail - std::atomic_ref(*submissionHead).load(std::memory_order_acquire) >= numberOfSubmissionEntries)
+    {
+        return false;
+    }
+    const auto index = tail & submissionMask;
+    auto& entry = submissionEntries[index]; /// NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    std::memset(&entry, 0, sizeof(entry));
+    switch (request.kind)
+    {
+        case Request::Kind::READ:
+            entry.opcode = IORING_OP_READ;
+            entry.fd = request.fileDescriptor;
+            entry.off = request.offset;
+            entry.addr = reinterpret_cast<uint64_t>(request.buffer.data()); /// NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+            entry.len = static_cast<uint32_t>(request.buffer.size());
+            entry.user_data = request.id;
+            break;
+        case Request::Kind::CANCEL:
+            entry.opcode = IORING_OP_ASYNC_CANCEL;
+            entry.fd = -1;
+            entry.addr = request.id;
+            entry.user_data = CANCEL_ID;
+            break;
+    }
+    submissionArray[index] = index; /// NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    std::atomic_ref(*submissionTail).store(tail + 1, std::memory_order_release);
+    ++numberOfUnsubmittedEntries;
+    return true;
+}
+
+void IoUringRing::prepareWakeup()
+{
+    const Request wakeupRead{
+        .kind = Request::Kind::READ,
+        .id = WAKEUP_ID,
+        .fileDescriptor = wakeupFileDescriptor,
+        .buffer = std::as_writable_bytes(std::span{&wakeupValue, 1}),
+        .offset = 0,
+        .onCompletion = {}};
+    const auto prepared = tryPrepare(wakeupRead);
+    INVARIANT(prepared, "The submission queue of the io_uring must have space for the wakeup read");
+}
+
+void IoUringRing::reapCompletions()
+{
+    auto head = *completionHead;
+    const auto tail = std::atomic_ref(*completionTail).load(std::memory_order_acquire);
+    for (; head != tail; ++head)
+    {
+        const auto& completion = completionEntries[head & completionMask]; /// NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        const auto id = completion.user_data;
+        const auto result = completion.res;
+        if (id == WAKEUP_ID)
+        {
+            prepareWakeup();
+        }
+        else if (id != CANCEL_ID)
+        {
+            if (const auto inflightRead = inflightReads.find(id); inflightRead != inflightReads.end())
+            {
+                const auto onCompletion = std::move(inflightRead->second);
+                inflightReads.erase(inflightRead);
+                onCompletion(result);
+            }
+        }
+    }
+    std::atomic_ref(*completionHead).store(head, std::memory_order_release);
+}
+
+void IoUringRing::run(const std::stop_token& stopToken)
+{
+    prepareWakeup();
+    bool cancelledInflightReads = false;
+    while (true)
+    {
+        {
+            /// Moves as many pending requests into the submission queue as fit
+            const std::scoped_lock lock(mutex);
+            while (not pendingRequests.empty() and tryPrepare(pendingRequests.front()))
+            {
+                auto& request = pendingRequests.front();
+                if (request.kind == Request::Kind::READ)
+                {
+                    inflightReads.emplace(request.id, std::move(request.onCompletion));
+                }
+                pendingRequests.pop_front();
+            }
+        }
+
+        /// Sources cancel their reads before they release the reactor. Nevertheless, we never leave the kernel with a buffer to write to.
+        if (stopToken.stop_requested())
+        {
+            if (inflightReads.empty())
+            {
+                return;
+            }
+            if (not cancelledInflightReads)
+            {
+                for (const auto& [readId, onCompletion] : inflightReads)
+                {
+                    cancel(readId);
+                }
+                cancelledInflightReads = true;
+                continue;
+            }
+        }
+
+        /// Submits the prepared entries and blocks until at least one completion is available
+        const auto numberOfSubmittedEntries = syscall(
+            __NR_io_uring_enter, ringFileDescriptor, numberOfUnsubmittedEntries, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+        if (numberOfSubmittedEntries >= 0)
+        {
+            numberOfUnsubmittedEntries -= static_cast<uint32_t>(numberOfSubmittedEntries);
+        }
+        else if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+        {
+            /// EAGAIN and EBUSY signal that the completion queue is full, which reaping the completions resolves
+            INVARIANT(false, "Failed to enter the io_uring: {}", getErrorMessageFromERRNO());
+        }
+        reapCompletions();
+    }
+}
+
+IoUringReactor::IoUringReactor(const size_t numberOfIoThreads)
+{
+    PRECONDITION(numberOfIoThreads > 0, "The io_uring reactor requires at least one I/O thread");
+    rings.reserve(numberOfIoThreads);
+    for (size_t ringIndex = 0; ringIndex < numberOfIoThreads; ++ringIndex)
+    {
+        rings.emplace_back(std::make_unique<IoUringRing>(ringIndex));
+    }
+}
+
+IoUringReactor::~IoUringReactor() = default;
+
+std::shared_ptr<IoUringReactor> IoUringReactor::getShared()
+{
+    static std::mutex mutex;
+    static std::weak_ptr<IoUringReactor> sharedReactor;
+    const std::scoped_lock lock(mutex);
+    if (auto reactor = sharedReactor.lock())
+    {
+        return reactor;
+    }
+    auto reactor = std::make_shared<IoUringReactor>();
+    sharedReactor = reactor;
+    return reactor;
+}
+
+IoUringReactor::ReadHandle IoUringReactor::submitRead(
+    const int fileDescriptor, const std::span<std::byte> buffer, const uint64_t offset, CompletionCallback onCompletion)
+{
+    PRECONDITION(fileDescriptor >= 0, "Cannot read from an invalid file descriptor");
+    const auto ring = static_cast<size_t>(fileDescriptor) % rings.size();
+    return ReadHandle{.ring = ring, .id = rings[ring]->submitRead(fileDescriptor, buffer, offset, std::move(onCompletion))};
+}
+
+void IoUringReactor::cancel(const ReadHandle& readHandle)
+{
+    PRECONDITION(readHandle.ring < rings.size(), "Invalid read handle");
+    rings[readHandle.ring]->cancel(readHandle.id);
+}
+
+std::optional<int64_t> IoUringReactor::read(
+    const int fileDescriptor,
+    const std::span<std::byte> buffer,
+    const uint64_t offset,
+    const std::chrono::milliseconds timeout,
+    const std::stop_token& stopToken)
+{
+    struct Completion
+    {
+        std::mutex mutex;
+        std::condition_variable_any completed;
+        std::optional<int64_t> result;
+    } completion;
+
+    const auto readHandle = submitRead(
+        fileDescriptor,
+        buffer,
+        offset,
+        [&completion](const int64_t result)
+        {
+            /// Notifying while holding the lock, as the waiting thread destroys the completion, as soon as it sees the result
+            const std::scoped_lock lock(completion.mutex);
+            completion.result = result;
+            completion.completed.notify_one();
+        });
+
+    std::unique_lock lock(completion.mutex);
+    const auto hasResult = [&completion] { return completion.result.has_value(); };
+    const auto completedInTime = timeout == std::chrono::milliseconds::zero()
+        ? completion.completed.wait(lock, stopToken, hasResult)
+        : completion.completed.wait_for(lock, stopToken, timeout, hasResult);
+    if (not completedInTime)
+    {
+        lock.unlock();
+        cancel(readHandle);
+        lock.lock();
+        /// The kernel may write into the buffer until the read completes
+        completion.completed.wait(lock, hasResult);
+        if (completion.result.value() == -ECANCELED)
+        {
+            return std::nullopt;
+        }
+    }
+    return completion.result;
+}
+
+}
@@ -13,10 +13,19 @@
 */
 #include <Sources/Source.hpp>
 
+#include <optional>
 #include <ostream>
+#include <stop_token>
+#include <Runtime/TupleBuffer.hpp>
+#include <ErrorHandling.hpp>
 
 namespace NES
 {
+std::optional<Source::FillTupleBufferResult> Source::tryFillTupleBuffer(TupleBuffer&, const std::stop_token&)
+{
+    throw NotImplemented("The source does not support non-blocking fills");
+}
+
 std::ostream& operator<<(std::ostream& out, const Source& source)
 {
     return source.toString(out);
@@ -86,17 +86,49 @@ ParserConfig ParserConfig::create(std::unordered_map<std::string, std::string> c
         NES_DEBUG("Parser configuration did not contain: allow_commas_in_strings, using default: true");
         created.allowCommasInStrings = true;
     }
+    if (const auto dictionaryEncoding = configMap.find("dictionary_encoding"); dictionaryEncoding != configMap.end())
+    {
+        const auto dictionaryEncodingParsed = from_chars<bool>(dictionaryEncoding->second);
+        if (not dictionaryEncodingParsed)
+        {
+            throw InvalidConfigParameter(
+                "dictionary_encoding config argument must be parsable boolean, but was: {}", dictionaryEncoding->second);
+        }
+        created.dictionaryEncoding = dictionaryEncodingParsed.value();
+    }
+    else
+    {
+        NES_DEBUG("Parser configuration did not contain: dictionary_encoding, using default: false");
+        created.dictionaryEncoding = false;
+    }
+    if (const auto orderedOutput = configMap.find("ordered_output"); orderedOutput != configMap.end())
+    {
+        const auto orderedOutputParsed = from_chars<bool>(orderedOutput->second);
+        if (not orderedOutputParsed)
+        {
+            throw InvalidConfigParameter("ordered_output config argument must be parsable boolean, but was: {}", orderedOutput->second);
+        }
+        created.orderedOutput = orderedOutputParsed.value();
+    }
+    else
+    {
+        NES_DEBUG("Parser configuration did not contain: ordered_output, using default: false");
+        created.orderedOutput = false;
+    }
     return created;
 }
 
 std::ostream& operator<<(std::ostream& os, const ParserConfig& obj)
 {
     return os << fmt::format(
-               "ParserConfig(type: {}, tupleDelimiter: '{}', fieldDelimiter: '{}', allowCommasInStrings: {})",
+               "ParserConfig(type: {}, tupleDelimiter: '{}', fieldDelimiter: '{}', allowCommasInStrings: {}, dictionaryEncoding: {}, "
+               "orderedOutput: {})",
                obj.parserType,
                obj.tupleDelimiter,
                obj.fieldDelimiter,
-               obj.allowCommasInStrings);
+               obj.allowCommasInStrings,
+               obj.dictionaryEncoding,
+               obj.orderedOutput);
 }
 
 SourceDescriptor::SourceDescriptor(
@@ -19,10 +19,12 @@
 #include <memory>
 #include <ostream>
 #include <utility>
+#include <vector>
 #include <Identifiers/Identifiers.hpp>
 #include <Runtime/AbstractBufferProvider.hpp>
 #include <Sources/Source.hpp>
 #include <Sources/SourceReturnType.hpp>
+#include <Sources/SourceRunner.hpp>
 #include <BackpressureChannel.hpp>
 #include <SourceThread.hpp>
 
@@ -33,11 +35,20 @@ SourceHandle::SourceHandle(
     OriginId originId,
     SourceRuntimeConfiguration configuration,
     std::shared_ptr<AbstractBufferProvider> bufferPool,
-    std::unique_ptr<Source> sourceImplementation)
+    std::unique_ptr<Source> sourceImplementation,
+    std::shared_ptr<SourceRunner> sourceRunner,
+    std::vector<size_t> sourceThreadCpus)
     : configuration(std::move(configuration))
 {
     this->sourceThread = std::make_unique<SourceThread>(
-        std::move(backpressureListener), std::move(originId), std::move(bufferPool), std::move(sourceImplementation));
+        std::move(backpressureListener),
+        std::move(originId),
+        std::move(bufferPool),
+        std::move(sourceImplementation),
+        std::move(sourceRunner),
+        std::move(sourceThreadCpus),
+        this->configuration.idleTimeout,
+        this->configuration.bufferSize);
 }
 
 SourceHandle::~SourceHandle() = default;
@@ -14,13 +14,17 @@
 
 #include <Sources/SourceProvider.hpp>
 
+#include <chrono>
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 #include <Identifiers/Identifiers.hpp>
 #include <Runtime/AbstractBufferProvider.hpp>
 #include <Sources/SourceDescriptor.hpp>
 #include <Sources/SourceHandle.hpp>
+#include <Sources/SourceRunner.hpp>
 #include <BackpressureChannel.hpp>
 #include <ErrorHandling.hpp>
 #include <SourceRegistry.hpp>
@@ -28,16 +32,31 @@
 namespace NES
 {
 
-SourceProvider::SourceProvider(size_t defaultMaxInflightBuffers, std::shared_ptr<AbstractBufferProvider> bufferPool)
-    : defaultMaxInflightBuffers(defaultMaxInflightBuffers), bufferPool(std::move(bufferPool))
+SourceProvider::SourceProvider(
+    size_t defaultMaxInflightBuffers,
+    std::shared_ptr<AbstractBufferProvider> bufferPool,
+    const size_t numberOfMultiplexedSourceThreads,
+    std::vector<size_t> sourceThreadCpus,
+    const bool adaptiveInflightBuffers)
+    : defaultMaxInflightBuffers(defaultMaxInflightBuffers)
+    , bufferPool(std::move(bufferPool))
+    , sourceThreadCpus(std::move(sourceThreadCpus))
+    , sourceRunner(
+          numberOfMultiplexedSourceThreads > 0 ? std::make_shared<SourceRunner>(numberOfMultiplexedSourceThreads, this->sourceThreadCpus)
+                                               : nullptr)
+    , adaptiveInflightBuffers(adaptiveInflightBuffers)
 {
 }
 
-std::unique_ptr<SourceHandle>
-SourceProvider::lower(OriginId originId, BackpressureListener backpressureListener, const SourceDescriptor& sourceDescriptor) const
+std::unique_ptr<SourceHandle> SourceProvider::lower(
+    OriginId originId,
+    BackpressureListener backpressureListener,
+    const SourceDescriptor& sourceDescriptor,
+    std::shared_ptr<AbstractBufferProvider> bufferProvider,
+    std::vector<std::string> projections) const
 {
     /// Todo #241: Get the new source identfier from the source descriptor and pass it to SourceHandle.
-    auto sourceArguments = SourceRegistryArguments(sourceDescriptor);
+    auto sourceArguments = SourceRegistryArguments(sourceDescriptor, std::move(projections));
     if (auto source = SourceRegistry::instance().create(sourceDescriptor.getSourceType(), sourceArguments))
     {
         /// The source-specific configuration of maxInflightBuffers takes priority.
@@ -45,10 +64,20 @@ SourceProvider::lower(OriginId originId, BackpressureListener backpressureListen
         const auto maxInflightBuffers = (sourceDescriptor.getFromConfig(SourceDescriptor::MAX_INFLIGHT_BUFFERS) > 0)
             ? sourceDescriptor.getFromConfig(SourceDescriptor::MAX_INFLIGHT_BUFFERS)
             : defaultMaxInflightBuffers;
-        SourceRuntimeConfiguration runtimeConfig{maxInflightBuffers};
+        const SourceRuntimeConfiguration runtimeConfig{
+            .inflightBufferLimit = maxInflightBuffers,
+            .adaptiveInflightBufferLimit = adaptiveInflightBuffers,
+            .idleTimeout = std::chrono::milliseconds(sourceDescriptor.getFromConfig(SourceDescriptor::IDLE_TIMEOUT_MS)),
+            .bufferSize = sourceDescriptor.getFromConfig(SourceDescriptor::BUFFER_SIZE_IN_BYTES)};
 
         return std::make_unique<SourceHandle>(
-            std::move(backpressureListener), std::move(originId), std::move(runtimeConfig), bufferPool, std::move(source.value()));
+            std::move(backpressureListener),
+            std::move(originId),
+            runtimeConfig,
+            bufferProvider ? std::move(bufferProvider) : bufferPool,
+            std::move(source.value()),
+            sourceRunner,
+            sourceThreadCpus);
     }
     throw UnknownSourceType("unknown source descriptor type: {}", sourceDescriptor.getSourceType());
 }
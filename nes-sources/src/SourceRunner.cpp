@@ -0,0 +1,131 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <Sources/SourceRunner.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <utility>
+#include <vector>
+#include <Util/Logger/Logger.hpp>
+#include <fmt/format.h>
+#include <ErrorHandling.hpp>
+#include <Thread.hpp>
+
+namespace NES
+{
+
+SourceRunner::SourceRunner(const size_t numberOfThreads, std::vector<size_t> threadCpus)
+{
+    PRECONDITION(numberOfThreads > 0, "The source runner requires at least one thread");
+    threads.reserve(numberOfThreads);
+    for (size_t threadIndex = 0; threadIndex < numberOfThreads; ++threadIndex)
+    {
+        threads.emplace_back(
+            fmt::format("SrcRunner-{}", threadIndex),
+            [this, threadCpus](const std::stop_token& stopToken)
+            {
+                if (!Thread::pinThisThread(threadCpus))
+                {
+                    NES_WARNING("Could not pin {} to the source thread cpus", Thread::getThisThreadName());
+                }
+                runTurns(stopToken);
+            });
+    }
+}
+
+SourceRunner::~SourceRunner()
+{
+    for (auto& thread : threads)
+    {
+        thread.requestStop();
+    }
+    threads.clear();
+}
+
+void SourceRunner::add(std::shared_ptr<RunnableSource> source)
+{
+    PRECONDITION(source != nullptr, "Cannot run an invalid source");
+    {
+        const std::scoped_lock lock(mutex);
+        sources.emplace_back(std::move(source));
+        ++numberOfWakeups;
+    }
+    sourceAvailable.notify_all();
+}
+
+void SourceRunner::wake()
+{
+    {
+        const std::scoped_lock lock(mutex);
+        ++numberOfWakeups;
+    }
+    sourceAvailable.notify_all();
+}
+
+size_t SourceRunner::getNumberOfSources() const
+{
+    const std::scoped_lock lock(mutex);
+    return sources.size() + numberOfActiveSources;
+}
+
+void SourceRunner::runTurns(const std::stop_token& stopToken)
+{
+    /// Counts the turns since this thread last saw a source make progress. Once it exceeds the number of sources, every source was idle.
+    size_t numberOfIdleTurns = 0;
+    while (not stopToken.stop_requested())
+    {
+        std::shared_ptr<RunnableSource> source;
+        {
+            std::unique_lock lock(mutex);
+            if (numberOfIdleTurns > 0 and numberOfIdleTurns >= sources.size() + numberOfActiveSources)
+            {
+                const auto wakeupsBeforeWaiting = numberOfWakeups;
+                sourceAvailable.wait_for(
+                    lock, stopToken, IDLE_WAIT_INTERVAL, [&] { return numberOfWakeups != wakeupsBeforeWaiting; });
+                numberOfIdleTurns = 0;
+            }
+            if (not sourceAvailable.wait(lock, stopToken, [this] { return not sources.empty(); }))
+            {
+                return;
+            }
+            source = std::move(sources.front());
+            sources.pop_front();
+            ++numberOfActiveSources;
+        }
+
+        auto result = RunnableSource::TurnResult::Terminated;
+        try
+        {
+            result = source->runTurn();
+        }
+        catch (...)
+        {
+            /// Sources report their failures via their own emit function, thus an exception escaping a turn is a bug of the source
+            tryLogCurrentException();
+        }
+
+        const std::scoped_lock lock(mutex);
+        --numberOfActiveSources;
+        numberOfIdleTurns = result == RunnableSource::TurnResult::Idle ? numberOfIdleTurns + 1 : 0;
+        if (result != RunnableSource::TurnResult::Terminated)
+        {
+            sources.emplace_back(std::move(source));
+        }
+    }
+}
+
+}
@@ -14,21 +14,27 @@
 
 #include <SourceThread.hpp>
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstddef>
 #include <exception>
 #include <functional>
 #include <future>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <stop_token>
 #include <string>
 #include <utility>
 #include <variant>
+#include <vector>
 #include <Identifiers/Identifiers.hpp>
 #include <Runtime/AbstractBufferProvider.hpp>
 #include <Runtime/TupleBuffer.hpp>
 #include <Sources/Source.hpp>
 #include <Sources/SourceReturnType.hpp>
+#include <Sources/SourceRunner.hpp>
 #include <Time/Timestamp.hpp>
 #include <Util/Logger/Logger.hpp>
 #include <cpptrace/from_current.hpp>
@@ -44,15 +50,39 @@ SourceThread::SourceThread(
     BackpressureListener backpressureListener,
     OriginId originId,
     std::shared_ptr<AbstractBufferProvider> poolProvider,
-    std::unique_ptr<Source> sourceImplementation)
+    std::unique_ptr<Source> sourceImplementation,
+    std::shared_ptr<SourceRunner> sourceRunner,
+    std::vector<size_t> threadCpus,
+    const std::chrono::milliseconds idleTimeout,
+    const size_t bufferSize)
     : originId(originId)
     , localBufferManager(std::move(poolProvider))
     , sourceImplementation(std::move(sourceImplementation))
     , backpressureListener(std::move(backpressureListener))
+    , threadCpus(std::move(threadCpus))
+    , idleTimeout(idleTimeout)
+    , bufferSize(bufferSize)
+    , sourceRunner(std::move(sourceRunner))
 {
     PRECONDITION(this->localBufferManager, "Invalid buffer manager");
 }
 
+SourceThread::~SourceThread()
+{
+    /// The runner must not drive the source after the source was destroyed
+    if (multiplexedRunning)
+    {
+        multiplexedStopSource.request_stop();
+        sourceRunner->wake();
+        terminationFuture.wait();
+    }
+}
+
+bool SourceThread::isMultiplexed() const
+{
+    return sourceRunner != nullptr and sourceImplementation->supportsNonBlockingFill();
+}
+
 namespace
 {
 void addBufferMetaData(OriginId originId, SequenceNumber sequenceNumber, TupleBuffer& buffer)
@@ -62,11 +92,17 @@ void addBufferMetaData(OriginId originId, SequenceNumber sequenceNumber, TupleBu
     /// set the creation timestamp
     buffer.setCreationTimestampInMS(Timestamp(
         std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count()));
+    /// All tuples of a source buffer are ingested at once. Sinks compare the ingestion timestamp with the system clock.
+    const auto ingestionTimestamp = Timestamp(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+    buffer.setIngestionTimestampsInNS(ingestionTimestamp, ingestionTimestamp);
     /// Set the sequence number of this buffer.
     /// A data source generates a monotonic increasing sequence number
     buffer.setSequenceNumber(sequenceNumber);
     buffer.setChunkNumber(INITIAL_CHUNK_NUMBER);
     buffer.setLastChunk(true);
+    /// Pooled buffers keep the watermark of their previous use
+    buffer.setWatermark(Timestamp(Timestamp::INITIAL_VALUE));
     NES_TRACE(
         "Setting the buffer metadata for source {} with originId={} sequenceNumber={} chunkNumber={} lastChunk={}",
         buffer.getOriginId(),
@@ -76,13 +112,80 @@ void addBufferMetaData(OriginId originId, SequenceNumber sequenceNumber, TupleBu
         buffer.isLastChunk());
 }
 
+/// A heartbeat is an empty buffer, which takes the next sequence number of the source, so that the sequence of the formatter has no gaps
+void addHeartbeatMetaData(OriginId originId, SequenceNumber sequenceNumber, TupleBuffer& buffer)
+{
+    addBufferMetaData(originId, sequenceNumber, buffer);
+    buffer.setNumberOfTuples(0);
+    buffer.setWatermark(Timestamp(Timestamp::IDLE_SOURCE_VALUE));
+}
+
+/// A source with its own buffer size takes its buffers from the size classes of the buffer manager, or from unpooled memory, as the
+/// pool only holds buffers of the global buffer size. The inflight buffer limit of the source bounds the memory of these buffers, too.
+bool usesPooledBuffers(const AbstractBufferProvider& bufferProvider, const size_t bufferSize)
+{
+    return bufferSize == 0 or bufferSize == bufferProvider.getBufferSize();
+}
+
 using EmitFn = std::function<void(TupleBuffer&&, bool addBufferMetadata)>;
 
+/// Shared between the thread of a source, which emits its data, and the thread that emits heartbeats while the source is idle
+struct SourceActivity
+{
+    std::atomic<SequenceNumber::Underlying> sequenceNumberGenerator = SequenceNumber::INITIAL;
+    std::atomic<std::chrono::steady_clock::rep> lastEmission = std::chrono::steady_clock::now().time_since_epoch().count();
+
+    void recordEmission() { lastEmission.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed); }
+
+    [[nodiscard]] std::chrono::steady_clock::time_point getLastEmission() const
+    {
+        return std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(lastEmission.load(std::memory_order_relaxed)));
+    }
+};
+
+/// Emits a heartbeat whenever the source did not emit a buffer for the idle timeout. Skips a heartbeat if the pool has no free buffer,
+/// as the source is not idle then, or its buffers are still in flight. Likewise, a source under backpressure does not emit heartbeats,
+/// e.g., while the pipelines of its query are still starting.
+void heartbeatThread(
+    const std::stop_token& stopToken,
+    const BackpressureListener& backpressureListener,
+    SourceActivity& activity,
+    AbstractBufferProvider& bufferProvider,
+    const SourceReturnType::EmitFunction& emit,
+    const OriginId originId,
+    const std::chrono::milliseconds idleTimeout)
+{
+    std::mutex mutex;
+    std::condition_variable_any stopped;
+    std::unique_lock lock(mutex);
+    while (not stopToken.stop_requested())
+    {
+        const auto idleSince = activity.getLastEmission();
+        stopped.wait_until(lock, stopToken, idleSince + idleTimeout, [] { return false; });
+        if (stopToken.stop_requested() or activity.getLastEmission() != idleSince)
+        {
+            continue;
+        }
+        if (backpressureListener.hasBackpressure())
+        {
+            activity.recordEmission();
+            continue;
+        }
+        if (auto heartbeat = bufferProvider.getBufferNoBlocking())
+        {
+            addHeartbeatMetaData(originId, SequenceNumber(activity.sequenceNumberGenerator++), *heartbeat);
+            emit(originId, SourceReturnType::Data{std::move(*heartbeat)}, stopToken);
+        }
+        activity.recordEmission();
+    }
+}
+
 SourceImplementationTermination dataSourceThreadRoutine(
     const std::stop_token& stopToken,
     BackpressureListener backpressureListener,
     Source& source,
     std::shared_ptr<AbstractBufferProvider> bufferProvider,
+    const size_t bufferSize,
     const EmitFn& emit)
 {
     source.open(bufferProvider);
@@ -106,7 +209,9 @@ SourceImplementationTermination dataSourceThreadRoutine(
         std::optional<TupleBuffer> emptyBuffer;
         while (!emptyBuffer && !stopToken.stop_requested())
         {
-            emptyBuffer = bufferProvider->getBufferWithTimeout(std::chrono::milliseconds(25));
+            emptyBuffer = usesPooledBuffers(*bufferProvider, bufferSize)
+                ? bufferProvider->getBufferWithTimeout(std::chrono::milliseconds(25))
+                : bufferProvider->getUnpooledBuffer(bufferSize);
         }
         if (stopToken.stop_requested())
         {
@@ -143,22 +248,43 @@ void dataSourceThread(
     SourceReturnType::EmitFunction emit,
     const OriginId originId,
     ///NOLINTNEXTLINE(performance-unnecessary-value-param) `jthread` does not allow references
-    std::shared_ptr<AbstractBufferProvider> bufferProvider)
+    std::shared_ptr<AbstractBufferProvider> bufferProvider,
+    const std::vector<size_t>& threadCpus,
+    const std::chrono::milliseconds idleTimeout,
+    const size_t bufferSize)
 {
-    size_t sequenceNumberGenerator = SequenceNumber::INITIAL;
+    /// The thread that starts the source may be a pinned worker thread, whose cpu the source thread would inherit otherwise
+    if (!Thread::pinThisThread(threadCpus))
+    {
+        NES_WARNING("Could not pin the thread of source {} to the source thread cpus", originId);
+    }
+    SourceActivity activity;
     const EmitFn dataEmit = [&](TupleBuffer&& buffer, bool shouldAddMetadata)
     {
         if (shouldAddMetadata)
         {
-            addBufferMetaData(originId, SequenceNumber(sequenceNumberGenerator++), buffer);
+            addBufferMetaData(originId, SequenceNumber(activity.sequenceNumberGenerator++), buffer);
         }
         emit(originId, SourceReturnType::Data{std::move(buffer)}, stopToken);
+        activity.recordEmission();
     };
 
+    /// Sources that add their own metadata own the sequence numbers, thus they cannot emit heartbeats. The heartbeats must stop before
+    /// the source emits its end of stream (or error).
+    std::optional<Thread> heartbeats;
+    if (idleTimeout.count() > 0 and not source->addsMetadata())
+    {
+        heartbeats.emplace(
+            fmt::format("Heartbeat-{}", originId),
+            [&](const std::stop_token& heartbeatStopToken)
+            { heartbeatThread(heartbeatStopToken, backpressureListener, activity, *bufferProvider, emit, originId, idleTimeout); });
+    }
+
     try
     {
         result.set_value_at_thread_exit(
-            dataSourceThreadRoutine(stopToken, std::move(backpressureListener), *source, std::move(bufferProvider), dataEmit));
+            dataSourceThreadRoutine(stopToken, backpressureListener, *source, bufferProvider, bufferSize, dataEmit));
+        heartbeats.reset();
         if (!stopToken.stop_requested())
         {
             emit(originId, SourceReturnType::EoS{}, stopToken);
@@ -166,11 +292,142 @@ void dataSourceThread(
     }
     catch (const std::exception& e)
     {
+        heartbeats.reset();
         auto backpressureListenerException = RunningRoutineFailure(e.what());
         result.set_exception_at_thread_exit(std::make_exception_ptr(backpressureListenerException));
         emit(originId, SourceReturnType::Error{std::move(backpressureListenerException)}, stopToken);
     }
 }
+
+/// Drives a source that supports non-blocking fills in the turns of a SourceRunner. Follows the same protocol as the 'dataSourceThread',
+/// but instead of blocking on backpressure, on the buffer pool, or on the source, a turn returns 'Idle' and the runner retries later.
+class MultiplexedSource final : public RunnableSource
+{
+public:
+    MultiplexedSource(
+        std::stop_token stopToken,
+        BackpressureListener backpressureListener,
+        std::promise<SourceImplementationTermination> termination,
+        Source& source,
+        SourceReturnType::EmitFunction emit,
+        const OriginId originId,
+        std::shared_ptr<AbstractBufferProvider> bufferProvider,
+        const std::chrono::milliseconds idleTimeout,
+        const size_t bufferSize)
+        : stopToken(std::move(stopToken))
+        , backpressureListener(std::move(backpressureListener))
+        , termination(std::move(termination))
+        , source(source)
+        , emit(std::move(emit))
+        , originId(originId)
+        , bufferProvider(std::move(bufferProvider))
+        , idleTimeout(idleTimeout)
+        , bufferSize(bufferSize)
+    {
+    }
+
+    TurnResult runTurn() override
+    {
+        try
+        {
+            if (stopToken.stop_requested())
+            {
+                return terminate({SourceImplementationTermination::StopRequested});
+            }
+            if (not opened)
+            {
+                source.open(bufferProvider);
+                opened = true;
+            }
+            if (backpressureListener.hasBackpressure())
+            {
+                return TurnResult::Idle;
+            }
+            auto emptyBuffer = usesPooledBuffers(*bufferProvider, bufferSize) ? bufferProvider->getBufferNoBlocking()
+                                                                              : bufferProvider->getUnpooledBuffer(bufferSize);
+            if (not emptyBuffer)
+            {
+                return TurnResult::Idle;
+            }
+
+            const auto fillTupleResult = source.tryFillTupleBuffer(*emptyBuffer, stopToken);
+            if (not fillTupleResult)
+            {
+                return emitHeartbeatIfIdle(*emptyBuffer);
+            }
+            if (fillTupleResult->isEoS())
+            {
+                return terminate(
+                    {stopToken.stop_requested() ? SourceImplementationTermination::StopRequested
+                                                : SourceImplementationTermination::EndOfStream});
+            }
+            emptyBuffer->setNumberOfTuples(fillTupleResult->getNumberOfBytes());
+            if (not source.addsMetadata())
+            {
+                addBufferMetaData(originId, SequenceNumber(sequenceNumberGenerator++), *emptyBuffer);
+            }
+            emit(originId, SourceReturnType::Data{std::move(*emptyBuffer)}, stopToken);
+            lastEmission = std::chrono::steady_clock::now();
+            return TurnResult::Progress;
+        }
+        catch (const std::exception& e)
+        {
+            auto sourceException = RunningRoutineFailure(e.what());
+            closeSource();
+            emit(originId, SourceReturnType::Error{sourceException}, stopToken);
+            termination.set_exception(std::make_exception_ptr(std::move(sourceException)));
+            return TurnResult::Terminated;
+        }
+    }
+
+private:
+    /// Emits the buffer, which the source did not fill, as a heartbeat if the source did not emit a buffer for the idle timeout
+    TurnResult emitHeartbeatIfIdle(TupleBuffer& emptyBuffer)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (idleTimeout.count() == 0 or source.addsMetadata() or now - lastEmission < idleTimeout)
+        {
+            return TurnResult::Idle;
+        }
+        addHeartbeatMetaData(originId, SequenceNumber(sequenceNumberGenerator++), emptyBuffer);
+        emit(originId, SourceReturnType::Data{std::move(emptyBuffer)}, stopToken);
+        lastEmission = now;
+        return TurnResult::Progress;
+    }
+
+    /// Resolving the termination must be the last access to the source, as the owner of the source may destroy it afterward
+    TurnResult terminate(const SourceImplementationTermination result)
+    {
+        closeSource();
+        if (result.result == SourceImplementationTermination::EndOfStream)
+        {
+            emit(originId, SourceReturnType::EoS{}, stopToken);
+        }
+        termination.set_value(result);
+        return TurnResult::Terminated;
+    }
+
+    void closeSource()
+    {
+        if (std::exchange(opened, false))
+        {
+            source.close();
+        }
+    }
+
+    std::stop_token stopToken;
+    BackpressureListener backpressureListener;
+    std::promise<SourceImplementationTermination> termination;
+    Source& source;
+    SourceReturnType::EmitFunction emit;
+    OriginId originId;
+    std::shared_ptr<AbstractBufferProvider> bufferProvider;
+    std::chrono::milliseconds idleTimeout;
+    size_t bufferSize;
+    size_t sequenceNumberGenerator = SequenceNumber::INITIAL;
+    std::chrono::steady_clock::time_point lastEmission = std::chrono::steady_clock::now();
+    bool opened = false;
+};
 }
 
 bool SourceThread::start(SourceReturnType::EmitFunction&& emitFunction)
@@ -185,6 +442,23 @@ bool SourceThread::start(SourceReturnType::EmitFunction&& emitFunction)
     std::promise<SourceImplementationTermination> terminationPromise;
     this->terminationFuture = terminationPromise.get_future();
 
+    if (isMultiplexed())
+    {
+        multiplexedStopSource = std::stop_source{};
+        sourceRunner->add(std::make_shared<MultiplexedSource>(
+            multiplexedStopSource.get_token(),
+            backpressureListener,
+            std::move(terminationPromise),
+            *sourceImplementation,
+            std::move(emitFunction),
+            originId,
+            localBufferManager,
+            idleTimeout,
+            bufferSize));
+        multiplexedRunning = true;
+        return true;
+    }
+
     Thread sourceThread(
         fmt::format("DataSrc-{}", originId),
         dataSourceThread,
@@ -193,7 +467,10 @@ bool SourceThread::start(SourceReturnType::EmitFunction&& emitFunction)
         sourceImplementation.get(),
         std::move(emitFunction),
         originId,
-        localBufferManager);
+        localBufferManager,
+        threadCpus,
+        idleTimeout,
+        bufferSize);
     thread = std::move(sourceThread);
     return true;
 }
@@ -203,8 +480,18 @@ void SourceThread::stop()
     PRECONDITION(!thread.isCurrentThread(), "DataSrc Thread should never request the source termination");
 
     NES_DEBUG("SourceThread  {} : stop source", originId);
-    thread.requestStop();
+    if (isMultiplexed())
     {
+        if (not std::exchange(multiplexedRunning, false))
+        {
+            return;
+        }
+        multiplexedStopSource.request_stop();
+        sourceRunner->wake();
+    }
+    else
+    {
+        thread.requestStop();
         auto deletedOnScopeExit = std::move(thread);
     }
     NES_DEBUG("SourceThread  {} : stopped", originId);
@@ -221,6 +508,24 @@ void SourceThread::stop()
 
 SourceReturnType::TryStopResult SourceThread::tryStop(std::chrono::milliseconds timeout)
 {
+    if (isMultiplexed())
+    {
+        if (not multiplexedRunning)
+        {
+            NES_DEBUG("SourceThread {}: source is not running", originId);
+            return SourceReturnType::TryStopResult::NOT_RUNNING;
+        }
+        multiplexedStopSource.request_stop();
+        sourceRunner->wake();
+        if (this->terminationFuture.wait_for(timeout) == std::future_status::timeout)
+        {
+            NES_DEBUG("SourceThread {}: source was not stopped during timeout", originId);
+            return SourceReturnType::TryStopResult::TIMEOUT;
+        }
+        multiplexedRunning = false;
+        NES_DEBUG("SourceThread {}: stopped", originId);
+        return SourceReturnType::TryStopResult::SUCCESS;
+    }
     if (!thread.joinable())
     {
         NES_DEBUG("SourceThread {}: thread is not running", originId);
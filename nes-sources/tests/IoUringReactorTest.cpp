@@ -0,0 +1,144 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <string_view>
+#include <thread>
+#include <unistd.h>
+#include <Sources/IoUringReactor.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+
+namespace NES
+{
+
+using namespace std::literals;
+
+class IoUringReactorTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("IoUringReactorTest.log", LogLevel::LOG_DEBUG);
+        NES_INFO("Setup IoUringReactorTest test class.");
+    }
+
+    void SetUp() override
+    {
+        Testing::BaseUnitTest::SetUp();
+        try
+        {
+            reactor = IoUringReactor::getShared();
+        }
+        catch (...)
+        {
+            GTEST_SKIP() << "The kernel does not provide io_uring";
+        }
+        ASSERT_EQ(pipe(pipeFileDescriptors.data()), 0);
+    }
+
+    void TearDown() override
+    {
+        for (const auto fileDescriptor : pipeFileDescriptors)
+        {
+            if (fileDescriptor >= 0)
+            {
+                close(fileDescriptor);
+            }
+        }
+        Testing::BaseUnitTest::TearDown();
+    }
+
+    void writeToPipe(const std::string_view data) const
+    {
+        ASSERT_EQ(write(pipeFileDescriptors[1], data.data(), data.size()), static_cast<ssize_t>(data.size()));
+    }
+
+    std::shared_ptr<IoUringReactor> reactor;
+    std::array<int, 2> pipeFileDescriptors{-1, -1};
+};
+
+TEST_F(IoUringReactorTest, readFromPipe)
+{
+    writeToPipe("hello");
+    std::array<std::byte, 16> buffer{};
+    const auto result = reactor->read(pipeFileDescriptors[0], buffer, 0, 1000ms, std::stop_token{});
+    ASSERT_EQ(result, std::optional<int64_t>{5});
+    EXPECT_EQ(std::string_view(reinterpret_cast<const char*>(buffer.data()), 5), "hello"); /// NOLINT
+}
+
+TEST_F(IoUringReactorTest, readCompletesOnceDataArrives)
+{
+    std::array<std::byte, 16> buffer{};
+    std::jthread writer(
+        [this]
+        {
+            std::this_thread::sleep_for(50ms);
+            writeToPipe("late");
+        });
+    const auto result = reactor->read(pipeFileDescriptors[0], buffer, 0, 5000ms, std::stop_token{});
+    ASSERT_EQ(result, std::optional<int64_t>{4});
+}
+
+TEST_F(IoUringReactorTest, timeoutCancelsTheRead)
+{
+    std::array<std::byte, 16> buffer{};
+    EXPECT_EQ(reactor->read(pipeFileDescriptors[0], buffer, 0, 20ms, std::stop_token{}), std::nullopt);
+
+    /// The cancelled read must not consume data that arrives afterward
+    writeToPipe("next");
+    EXPECT_EQ(reactor->read(pipeFileDescriptors[0], buffer, 0, 1000ms, std::stop_token{}), std::optional<int64_t>{4});
+}
+
+TEST_F(IoUringReactorTest, stopRequestCancelsTheRead)
+{
+    std::array<std::byte, 16> buffer{};
+    std::stop_source stopSource;
+    std::jthread stopper(
+        [&stopSource]
+        {
+            std::this_thread::sleep_for(20ms);
+            stopSource.request_stop();
+        });
+    EXPECT_EQ(reactor->read(pipeFileDescriptors[0], buffer, 0, 0ms, stopSource.get_token()), std::nullopt);
+}
+
+TEST_F(IoUringReactorTest, readFileAtOffset)
+{
+    char path[] = "/tmp/IoUringReactorTestXXXXXX"; /// NOLINT(modernize-avoid-c-arrays)
+    const auto fileDescriptor = mkstemp(path);
+    ASSERT_GE(fileDescriptor, 0);
+    unlink(path);
+    constexpr std::string_view content = "0123456789";
+    ASSERT_EQ(write(fileDescriptor, content.data(), content.size()), static_cast<ssize_t>(content.size()));
+
+    std::array<std::byte, 4> buffer{};
+    ASSERT_EQ(reactor->read(fileDescriptor, buffer, 6, 1000ms, std::stop_token{}), std::optional<int64_t>{4});
+    EXPECT_EQ(std::string_view(reinterpret_cast<const char*>(buffer.data()), buffer.size()), "6789"); /// NOLINT
+    EXPECT_EQ(reactor->read(fileDescriptor, buffer, content.size(), 1000ms, std::stop_token{}), std::optional<int64_t>{0});
+    close(fileDescriptor);
+}
+
+}
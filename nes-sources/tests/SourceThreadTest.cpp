@@ -31,6 +31,7 @@
 #include <Runtime/AbstractBufferProvider.hpp>
 #include <Runtime/BufferManager.hpp>
 #include <Sources/SourceReturnType.hpp>
+#include <Sources/SourceRunner.hpp>
 #include <Util/Logger/LogLevel.hpp>
 #include <Util/Logger/Logger.hpp>
 #include <Util/Logger/impl/NesLogger.hpp>
@@ -331,6 +332,49 @@ TEST_F(SourceThreadTest, EoSFromSourceWithStop)
     EXPECT_TRUE(control->wasDestroyed());
 }
 
+/// A source with its own buffer size fills buffers of the size class instead of the pooled buffers of the global buffer size
+TEST_F(SourceThreadTest, SourceSpecificBufferSize)
+{
+    constexpr size_t sourceBufferSize = 64 * 1024;
+    auto bm = BufferManager::create();
+    bm->enableSizeClasses(BufferManager::DEFAULT_SIZE_CLASSES, 4);
+    auto recordingBm = BufferManager::create(sourceBufferSize, 4);
+    auto [backpressureController, backpressureListener] = createBackpressureChannel();
+    RecordingEmitFunction recorder(*recordingBm);
+    std::vector<size_t> emittedBufferSizes;
+    auto control = std::make_shared<TestSourceControl>();
+    control->injectData(std::vector{sourceBufferSize, std::byte(0)}, DEFAULT_NUMBER_OF_TUPLES_IN_BUFFER);
+    control->injectData(std::vector{DEFAULT_BUFFER_SIZE, std::byte(0)}, DEFAULT_NUMBER_OF_TUPLES_IN_BUFFER);
+    {
+        SourceThread sourceThread(
+            backpressureListener,
+            INITIAL<OriginId>,
+            bm,
+            std::make_unique<TestSource>(INITIAL<OriginId>, control),
+            nullptr,
+            {},
+            std::chrono::milliseconds(0),
+            sourceBufferSize);
+        verify_non_blocking_start(
+            sourceThread,
+            [&](const OriginId originId, SourceReturnType::SourceReturnType ret, const std::stop_token&)
+            {
+                if (const auto* data = std::get_if<SourceReturnType::Data>(&ret))
+                {
+                    emittedBufferSizes.push_back(data->buffer.getBufferSize());
+                }
+                recorder(originId, std::move(ret));
+                return SourceReturnType::EmitResult::SUCCESS;
+            });
+        wait_for_emits(recorder, 2);
+        verify_non_blocking_stop(sourceThread);
+    }
+
+    verify_number_of_emits(recorder, 2);
+    EXPECT_THAT(emittedBufferSizes, ::testing::ElementsAre(sourceBufferSize, sourceBufferSize));
+    EXPECT_EQ(bm->getNumberOfAvailableSizeClassBuffers(sourceBufferSize), 4);
+}
+
 TEST_F(SourceThreadTest, ApplyBackbressure)
 {
     auto bm = BufferManager::create();
@@ -401,4 +445,110 @@ TEST_F(SourceThreadTest, StopDuringBackpressure)
 }
 
 
+TEST_F(SourceThreadTest, MultiplexedSourcesShareTheRunner)
+{
+    constexpr size_t numberOfSources = 16;
+    auto bm = BufferManager::create();
+    auto [backpressureController, backpressureListener] = createBackpressureChannel();
+    const auto sourceRunner = std::make_shared<SourceRunner>(1);
+    std::vector<std::unique_ptr<RecordingEmitFunction>> recorders;
+    std::vector<std::shared_ptr<TestSourceControl>> controls;
+    {
+        std::vector<std::unique_ptr<SourceThread>> sourceThreads;
+        for (size_t sourceIndex = 0; sourceIndex < numberOfSources; ++sourceIndex)
+        {
+            auto& recorder = *recorders.emplace_back(std::make_unique<RecordingEmitFunction>(*bm));
+            auto& control = controls.emplace_back(std::make_shared<TestSourceControl>());
+            control->injectData(std::vector{DEFAULT_BUFFER_SIZE, std::byte(0)}, DEFAULT_NUMBER_OF_TUPLES_IN_BUFFER);
+            control->injectData(std::vector{DEFAULT_BUFFER_SIZE, std::byte(0)}, DEFAULT_NUMBER_OF_TUPLES_IN_BUFFER);
+            control->injectData(std::vector{DEFAULT_BUFFER_SIZE, std::byte(0)}, DEFAULT_NUMBER_OF_TUPLES_IN_BUFFER);
+            control->injectEoS();
+            auto& sourceThread = *sourceThreads.emplace_back(std::make_unique<SourceThread>(
+                backpressureListener,
+                OriginId(INITIAL<OriginId>.getRawValue() + sourceIndex),
+                bm,
+                std::make_unique<TestSource>(INITIAL<OriginId>, control, true),
+                sourceRunner));
+            verify_non_blocking_start(
+                sourceThread,
+                [&recorder](const OriginId originId, SourceReturnType::SourceReturnType ret, const std::stop_token&)
+                {
+                    recorder(originId, std::move(ret));
+                    return SourceReturnType::EmitResult::SUCCESS;
+                });
+        }
+        for (auto& recorder : recorders)
+        {
+            wait_for_emits(*recorder, 4);
+        }
+        for (auto& sourceThread : sourceThreads)
+        {
+            verify_non_blocking_stop(*sourceThread);
+        }
+    }
+
+    EXPECT_EQ(sourceRunner->getNumberOfSources(), 0);
+    for (size_t sourceIndex = 0; sourceIndex < numberOfSources; ++sourceIndex)
+    {
+        verify_number_of_emits(*recorders[sourceIndex], 4);
+        verify_last_event<SourceReturnType::EoS>(*recorders[sourceIndex]);
+        EXPECT_TRUE(controls[sourceIndex]->wasOpened());
+        EXPECT_TRUE(controls[sourceIndex]->wasClosed());
+        EXPECT_TRUE(controls[sourceIndex]->wasDestroyed());
+    }
+}
+
+/// A multiplexed source under backpressure must not block the other sources of the runner
+TEST_F(SourceThreadTest, MultiplexedStopDuringBackpressure)
+{
+    auto bm = BufferManager::create();
+    const auto sourceRunner = std::make_shared<SourceRunner>(1);
+    RecordingEmitFunction throttledRecorder(*bm);
+    RecordingEmitFunction recorder(*bm);
+    auto [throttledController, throttledListener] = createBackpressureChannel();
+    auto [backpressureController, backpressureListener] = createBackpressureChannel();
+    throttledController.applyPressure();
+    auto throttledControl = std::make_shared<TestSourceControl>();
+    auto control = std::make_shared<TestSourceControl>();
+    throttledControl->injectData(std::vector{DEFAULT_BUFFER_SIZE, std::byte(0)}, DEFAULT_NUMBER_OF_TUPLES_IN_BUFFER);
+    control->injectData(std::vector{DEFAULT_BUFFER_SIZE, std::byte(0)}, DEFAULT_NUMBER_OF_TUPLES_IN_BUFFER);
+    control->injectEoS();
+    {
+        SourceThread throttledSourceThread(
+            throttledListener,
+            INITIAL<OriginId>,
+            bm,
+            std::make_unique<TestSource>(INITIAL<OriginId>, throttledControl, true),
+            sourceRunner);
+        SourceThread sourceThread(
+            backpressureListener, INITIAL<OriginId>, bm, std::make_unique<TestSource>(INITIAL<OriginId>, control, true), sourceRunner);
+        verify_non_blocking_start(
+            throttledSourceThread,
+            [&](const OriginId originId, SourceReturnType::SourceReturnType ret, const auto&)
+            {
+                throttledRecorder(originId, std::move(ret));
+                return SourceReturnType::EmitResult::SUCCESS;
+            });
+        verify_non_blocking_start(
+            sourceThread,
+            [&](const OriginId originId, SourceReturnType::SourceReturnType ret, const auto&)
+            {
+                recorder(originId, std::move(ret));
+                return SourceReturnType::EmitResult::SUCCESS;
+            });
+        wait_for_emits(recorder, 2);
+        EXPECT_TRUE(control->waitUntilClosed());
+        EXPECT_FALSE(throttledControl->wasClosed());
+        verify_non_blocking_stop(throttledSourceThread);
+        verify_non_blocking_stop(sourceThread);
+    }
+
+    verify_number_of_emits(throttledRecorder, 0);
+    verify_number_of_emits(recorder, 2);
+    verify_last_event<SourceReturnType::EoS>(recorder);
+    EXPECT_TRUE(throttledControl->wasOpened());
+    EXPECT_TRUE(throttledControl->wasClosed());
+    EXPECT_TRUE(throttledControl->wasDestroyed());
+}
+
 }
@@ -164,7 +164,28 @@ NES::Source::FillTupleBufferResult NES::TestSource::fillTupleBuffer(NES::TupleBu
         NES_DEBUG("Test Source {} was requested to shutdown", this->sourceId);
         return FillTupleBufferResult::eos();
     }
+    return fillTupleBufferWith(tupleBuffer, std::move(controlData));
+}
 
+std::optional<NES::Source::FillTupleBufferResult>
+NES::TestSource::tryFillTupleBuffer(NES::TupleBuffer& tupleBuffer, const std::stop_token& stopToken)
+{
+    if (stopToken.stop_requested())
+    {
+        NES_DEBUG("Test Source {} was requested to shutdown", this->sourceId);
+        return FillTupleBufferResult::eos();
+    }
+    TestSourceControl::ControlData controlData;
+    if (!control->queue.read(controlData))
+    {
+        return std::nullopt;
+    }
+    return fillTupleBufferWith(tupleBuffer, std::move(controlData));
+}
+
+NES::Source::FillTupleBufferResult
+NES::TestSource::fillTupleBufferWith(NES::TupleBuffer& tupleBuffer, TestSourceControl::ControlData controlData)
+{
     auto data = std::visit(
         Overloaded{
             [](const TestSourceControl::Error& error) -> std::optional<TestSourceControl::Data>
@@ -219,7 +240,8 @@ std::ostream& NES::TestSource::toString(std::ostream& str) const
     return str << "Test Source";
 }
 
-NES::TestSource::TestSource(OriginId sourceId, const std::shared_ptr<TestSourceControl>& control) : sourceId(sourceId), control(control)
+NES::TestSource::TestSource(OriginId sourceId, const std::shared_ptr<TestSourceControl>& control, const bool nonBlocking)
+    : sourceId(sourceId), control(control), nonBlocking(nonBlocking)
 {
 }
 
@@ -19,6 +19,7 @@
 #include <functional>
 #include <future>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <stop_token>
 #include <string>
@@ -96,6 +97,8 @@ class TestSource : public Source
 {
 public:
     FillTupleBufferResult fillTupleBuffer(TupleBuffer& tupleBuffer, const std::stop_token& stopToken) override;
+    [[nodiscard]] bool supportsNonBlockingFill() const override { return nonBlocking; }
+    std::optional<FillTupleBufferResult> tryFillTupleBuffer(TupleBuffer& tupleBuffer, const std::stop_token& stopToken) override;
     void open(std::shared_ptr<AbstractBufferProvider>) override;
     void close() override;
 
@@ -103,12 +106,16 @@ protected:
     [[nodiscard]] std::ostream& toString(std::ostream& str) const override;
 
 public:
-    explicit TestSource(OriginId sourceId, const std::shared_ptr<TestSourceControl>& control);
+    /// A non-blocking test source is driven by a SourceRunner, if the SourceThread has one
+    explicit TestSource(OriginId sourceId, const std::shared_ptr<TestSourceControl>& control, bool nonBlocking = false);
     ~TestSource() override;
 
 private:
+    FillTupleBufferResult fillTupleBufferWith(TupleBuffer& tupleBuffer, TestSourceControl::ControlData controlData);
+
     OriginId sourceId;
     std::shared_ptr<TestSourceControl> control;
+    bool nonBlocking;
 };
 
 std::pair<std::unique_ptr<SourceHandle>, std::shared_ptr<TestSourceControl>>
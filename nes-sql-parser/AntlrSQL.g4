@@ -74,8 +74,11 @@ createSinkDefinition: SINK sinkName=identifier schemaDefinition TYPE type=identi
 
 
 schemaDefinition: '(' columnDefinition (',' columnDefinition)* ')';
-columnDefinition: identifierChain typeDefinition nullableDefinition?;
+columnDefinition: identifierChain columnType nullableDefinition?;
 
+/// TIMESTAMP and INTERVAL are not keywords, as they are commonly used as field names
+/// DECIMAL(precision, scale) is the only parameterized type
+columnType: typeDefinition | IDENTIFIER | IDENTIFIER '(' precision=INTEGER_VALUE ',' scale=INTEGER_VALUE ')';
 typeDefinition: DATA_TYPE;
 nullableDefinition: NOT NULLTOKEN;
 
@@ -121,10 +124,17 @@ queryPrimary
     | '(' query ')'                                                         #subquery
     ;
 /// new layout to be closer to traditional SQL
-querySpecification: selectClause fromClause whereClause? windowedAggregationClause? havingClause? sinkClause?;
+querySpecification: selectClause fromClause whereClause? windowedAggregationClause? havingClause? windowTopKClause? sinkClause?;
 
 
-fromClause: FROM relation (',' relation)*;
+fromClause: FROM relation (',' relation)* sampleClause?;
+
+/// Samples the records of the FROM clause before they enter the WHERE clause. BERNOULLI forwards each record with the percentage as
+/// probability, while RESERVOIR emits a uniform sample of at most size records per tumbling or sliding window of the WINDOW clause.
+sampleClause
+    : TABLESAMPLE BERNOULLI '(' percentage=number ')'    #bernoulliSample
+    | TABLESAMPLE RESERVOIR '(' size=INTEGER_VALUE ')'   #reservoirSample
+    ;
 
 relation
     : relationPrimary joinRelation*
@@ -133,6 +143,8 @@ relation
 joinRelation
     : (joinType) JOIN right=relationPrimary joinCriteria? windowClause
     | NATURAL joinType JOIN right=relationPrimary windowClause
+    /// Looks up the records of a static table for each record of the stream, thus it requires no window
+    | LOOKUP JOIN right=relationPrimary joinCriteria
     ;
 
 joinType
@@ -162,12 +174,16 @@ fromStatement: fromClause fromStatementBody+;
 
 fromStatementBody: selectClause whereClause? groupByClause?;
 
-selectClause : SELECT (hints+=hint)* namedExpressionSeq;
+/// SELECT DISTINCT forwards the first occurrence of each projected record per tumbling window
+selectClause : SELECT (hints+=hint)* DISTINCT? namedExpressionSeq;
 
 whereClause: WHERE booleanExpression;
 
 havingClause: HAVING booleanExpression;
 
+/// Emits only the records of the keys with the largest (DESC, default) or smallest (ASC) values per window
+windowTopKClause: ORDER BY orderField=identifier ordering=(ASC | DESC)? LIMIT limit=INTEGER_VALUE;
+
 inlineTable
     : VALUES expression (',' expression)* tableAlias
     ;
@@ -242,8 +258,8 @@ booleanExpression
 
 /// Problem fixed that the querySpecification rule could match an empty string
 windowedAggregationClause:
-    groupByClause? windowClause watermarkClause?
-    | windowClause groupByClause? watermarkClause?;
+    groupByClause? windowClause watermarkClause? allowedLatenessClause? earlyResultClause?
+    | windowClause groupByClause? watermarkClause? allowedLatenessClause? earlyResultClause?;
 
 groupByClause
     : GROUP BY groupingExpressions+=expression (',' groupingExpressions+=expression)* (
@@ -262,9 +278,17 @@ windowClause
     : WINDOW windowSpec
     ;
 
+/// Lets the watermark lag behind the largest timestamp by the bound. An adaptive bound is learned per source from the observed disorder,
+/// up to the bound.
 watermarkClause: WATERMARK '(' watermarkParameters ')';
 
-watermarkParameters: watermarkIdentifier=identifier ',' watermark=INTEGER_VALUE watermarkTimeUnit=timeUnit;
+/// Keeps triggered windows for the interval of event time, so that late records update them and let them emit the keys that changed
+allowedLatenessClause: ALLOWED LATENESS interval=INTEGER_VALUE timeUnit;
+
+/// Emits the results of the keys that changed since the previous early result of a window, every interval of processing time
+earlyResultClause: EMIT EVERY interval=INTEGER_VALUE timeUnit;
+
+watermarkParameters: watermarkIdentifier=identifier ',' adaptive=ADAPTIVE? watermark=INTEGER_VALUE watermarkTimeUnit=timeUnit;
 /// Adding Threshold Windows
 windowSpec:
     timeWindow #timeBasedWindow
@@ -275,10 +299,14 @@ windowSpec:
 timeWindow
     : TUMBLING '(' (timestampParameter ',')?  sizeParameter ')'                       #tumblingWindow
     | SLIDING '(' (timestampParameter ',')? sizeParameter ',' advancebyParameter ')' #slidingWindow
+    | SESSION '(' (timestampParameter ',')? gapParameter ')'                          #sessionWindow
+    /// Joins each left record with the right records whose timestamps lie between the left timestamp plus the lower and the upper bound
+    | BETWEEN '(' timestampParameter ',' lower=intervalBound AND upper=intervalBound ')' #intervalWindow
     ;
 
 countWindow:
-    TUMBLING '(' INTEGER_VALUE ')'    #countBasedTumbling
+    TUMBLING '(' size=INTEGER_VALUE ')'                           #countBasedTumbling
+    | SLIDING '(' size=INTEGER_VALUE ',' slide=INTEGER_VALUE ')'  #countBasedSliding
     ;
 
 conditionWindow
@@ -292,6 +320,10 @@ sizeParameter: SIZE INTEGER_VALUE timeUnit;
 
 advancebyParameter: ADVANCE BY INTEGER_VALUE timeUnit;
 
+gapParameter: GAP INTEGER_VALUE timeUnit;
+
+intervalBound: MINUS? INTEGER_VALUE timeUnit;
+
 timeUnit: MS
         | SEC
         | MINUTE
@@ -301,7 +333,9 @@ timeUnit: MS
 
 timestampParameter: name=identifier;
 
-functionName:  IDENTIFIER | AVG | MAX | MIN | SUM | COUNT | MEDIAN;
+dateTimeUnit: MS | SEC | MINUTE | HOUR | DAY | IDENTIFIER;
+
+functionName:  IDENTIFIER | AVG | MAX | MIN | SUM | COUNT | MEDIAN | TDIGEST_QUANTILE | KLL_QUANTILE | APPROX_COUNT_DISTINCT;
 
 sinkClause: INTO sink (',' sink)*;
 
@@ -368,6 +402,10 @@ primaryExpression
     | '(' query ')'                                                                            #subqueryExpression
     | '(' namedExpression (',' namedExpression)+ ')'                                           #rowConstructor
     | '(' expression ')'                                                                       #parenthesizedExpression
+    | DATE_TRUNC '(' unit=dateTimeUnit ',' value=expression (',' utcOffset=STRING)? ')'        #dateTrunc
+    | EXTRACT '(' unit=dateTimeUnit FROM value=expression (',' utcOffset=STRING)? ')'          #extract
+    | CASE (WHEN conditions+=expression THEN values+=expression)+ (ELSE elseValue=expression)? END #caseExpression
+    | IF '(' condition=expression ',' trueValue=expression ',' falseValue=expression ')'       #ifExpression
     | constant                                                                                 #constantDefault
     | identifier                                                                               #columnReference
     ;
@@ -408,8 +446,10 @@ ASC: 'ASC' | 'asc';
 AT: 'AT';
 BETWEEN: 'BETWEEN' | 'between';
 BY: 'BY' | 'by';
+CASE: 'CASE';
 COMMENT: 'COMMENT';
 CUBE: 'CUBE';
+DATE_TRUNC: 'DATE_TRUNC' | 'date_trunc';
 DELETE: 'DELETE';
 DESC: 'DESC' | 'desc';
 DISTINCT: 'DISTINCT';
@@ -419,6 +459,7 @@ ELSE: 'ELSE';
 END: 'END';
 ESCAPE: 'ESCAPE';
 EXISTS: 'EXISTS';
+EXTRACT: 'EXTRACT' | 'extract';
 FALSE: 'FALSE';
 FIRST: 'FIRST';
 FOR: 'FOR';
@@ -439,6 +480,10 @@ LEFT: 'LEFT';
 LIKE: 'LIKE';
 LIMIT: 'LIMIT' | 'limit';
 LIST: 'LIST';
+LOOKUP: 'LOOKUP' | 'lookup';
+TABLESAMPLE: 'TABLESAMPLE' | 'tablesample';
+BERNOULLI: 'BERNOULLI' | 'bernoulli';
+RESERVOIR: 'RESERVOIR' | 'reservoir';
 MERGE: 'MERGE' | 'merge';
 NATURAL: 'NATURAL';
 NOT: 'NOT' | 'not' | '!';
@@ -459,6 +504,7 @@ SETS: 'SETS';
 SOME: 'SOME';
 START: 'START';
 TABLE: 'TABLE';
+THEN: 'THEN';
 TO: 'TO';
 TRUE: 'TRUE';
 TYPE: 'TYPE';
@@ -474,9 +520,11 @@ WITH: 'WITH';
 SET: 'SET';
 TUMBLING: 'TUMBLING' | 'tumbling';
 SLIDING: 'SLIDING' | 'sliding';
+SESSION: 'SESSION' | 'session';
 THRESHOLD : 'THRESHOLD'|'threshold';
 SIZE: 'SIZE' | 'size';
 ADVANCE: 'ADVANCE' | 'advance';
+GAP: 'GAP' | 'gap';
 MS: 'MS' | 'ms';
 SEC: 'SEC' | 'sec';
 MINUTE: 'MINUTE' | 'minute' | 'MINUTES' | 'minutes';
@@ -488,7 +536,15 @@ AVG: 'AVG' | 'avg';
 SUM: 'SUM' | 'sum';
 COUNT: 'COUNT' | 'count';
 MEDIAN: 'MEDIAN' | 'median';
+TDIGEST_QUANTILE: 'TDIGEST_QUANTILE' | 'tdigest_quantile';
+KLL_QUANTILE: 'KLL_QUANTILE' | 'kll_quantile';
+APPROX_COUNT_DISTINCT: 'APPROX_COUNT_DISTINCT' | 'approx_count_distinct';
 WATERMARK: 'WATERMARK' | 'watermark';
+EMIT: 'EMIT' | 'emit';
+EVERY: 'EVERY' | 'every';
+ALLOWED: 'ALLOWED' | 'allowed';
+LATENESS: 'LATENESS' | 'lateness';
+ADAPTIVE: 'ADAPTIVE' | 'adaptive';
 OFFSET: 'OFFSET' | 'offset';
 LOCALHOST: 'LOCALHOST' | 'localhost';
 CSV_FORMAT : 'CSV_FORMAT';
@@ -18,21 +18,56 @@
 
 
 #include <memory>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
+#include <ANTLRErrorListener.h>
 #include <ANTLRInputStream.h>
 #include <AntlrSQLLexer.h>
 #include <AntlrSQLParser.h>
 #include <CommonTokenStream.h>
+#include <Exceptions.h>
 #include <ParserRuleContext.h>
+#include <atn/ParserATNSimulator.h>
+#include <atn/PredictionMode.h>
 #include <Plans/LogicalPlan.hpp>
 
 namespace NES::AntlrSQLQueryParser
 {
 
+/// Parses the rule with the SLL prediction mode first, which is much faster than the full LL prediction mode.
+/// Only if SLL fails, i.e., for invalid input or the rare input that requires the full parser context, it parses the rule again with LL.
+/// Expects the parser to bail out on errors. The error listener, if any, only reports the errors of the LL attempt.
+template <typename Parser, typename Context>
+Context* parseSllFirst(Parser& parser, Context* (Parser::*rule)(), antlr4::ANTLRErrorListener* errorListener)
+{
+    auto* const tokens = parser.getTokenStream();
+    const auto start = tokens->index();
+    parser.removeErrorListeners();
+    parser.getInterpreter<antlr4::atn::ParserATNSimulator>()->setPredictionMode(antlr4::atn::PredictionMode::SLL);
+    try
+    {
+        return (parser.*rule)();
+    }
+    catch (antlr4::ParseCancellationException&)
+    {
+        parser.reset();
+        tokens->seek(start);
+        if (errorListener != nullptr)
+        {
+            parser.addErrorListener(errorListener);
+        }
+        parser.getInterpreter<antlr4::atn::ParserATNSimulator>()->setPredictionMode(antlr4::atn::PredictionMode::LL);
+        return (parser.*rule)();
+    }
+}
+
 LogicalPlan bindLogicalQueryPlan(AntlrSQLParser::QueryContext* queryAst);
 LogicalPlan createLogicalQueryPlanFromSQLString(std::string_view queryString);
+/// Parses the independent queries in parallel and parses identical queries only once.
+/// Returns the plans in the order of the queries and throws the error of the first query that fails to parse.
+std::vector<LogicalPlan> createLogicalQueryPlansFromSQLStrings(std::span<const std::string> queryStrings);
 
 /// @brief Safe, heap allocated wrapper around an ANTLR chain instance. ASTs lifetime is owned by the chain that created them.
 class ManagedAntlrParser : public std::enable_shared_from_this<ManagedAntlrParser>
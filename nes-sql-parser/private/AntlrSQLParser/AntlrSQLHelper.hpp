@@ -15,6 +15,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -24,6 +25,7 @@
 #include <Functions/LogicalFunction.hpp>
 #include <Operators/Windows/Aggregations/WindowAggregationLogicalFunction.hpp>
 #include <Operators/Windows/JoinLogicalOperator.hpp>
+#include <Operators/Windows/WindowedAggregationLogicalOperator.hpp>
 #include <Plans/LogicalPlan.hpp>
 #include <Sinks/SinkDescriptor.hpp>
 #include <WindowTypes/Types/WindowType.hpp>
@@ -63,6 +65,7 @@ public:
     bool hasMultipleAttributes = false;
     bool hasUnnamedAggregation = false;
     bool asterisk = false;
+    bool distinct = false;
 
     [[nodiscard]] bool isInFunctionCall() const { return not functionBuilder.empty(); }
 
@@ -75,6 +78,14 @@ public:
     std::vector<std::string> constantBuilder;
     std::vector<LogicalFunction> functionBuilder;
     std::vector<FieldAccessLogicalFunction> groupByFields;
+    std::optional<WindowTopK> windowTopK;
+    std::optional<uint64_t> earlyResultIntervalInMs;
+    std::optional<uint64_t> allowedLatenessInMs;
+    /// The sampling of the FROM clause, i.e., TABLESAMPLE BERNOULLI(percentage) or TABLESAMPLE RESERVOIR(size)
+    std::optional<double> bernoulliSampleFraction;
+    std::optional<uint64_t> reservoirSampleSize;
+    uint64_t outOfOrdernessBoundInMs = 0;
+    bool adaptiveOutOfOrderness = false;
     std::vector<std::string> joinSources;
     std::vector<LogicalFunction> joinKeyRelationHelper;
     std::vector<std::string> joinSourceRenames;
@@ -89,6 +100,7 @@ public:
     /// Utility variables used to keep track of the parsing state.
     int size{};
     int advanceBy{};
+    int gap{};
     size_t timeUnit{}; ///anonymous token enum in AntlrSQLLexer.h
     size_t timeUnitAdvanceBy{};
     std::optional<int> minimumCount;
@@ -47,10 +47,21 @@ public:
     void exitWhereClause(AntlrSQLParser::WhereClauseContext* context) override;
     void enterComparisonOperator(AntlrSQLParser::ComparisonOperatorContext* context) override;
     void exitComparison(AntlrSQLParser::ComparisonContext* context) override;
+    void exitPredicate(AntlrSQLParser::PredicateContext* context) override;
+    void exitDateTrunc(AntlrSQLParser::DateTruncContext* context) override;
+    void exitExtract(AntlrSQLParser::ExtractContext* context) override;
+    void exitCaseExpression(AntlrSQLParser::CaseExpressionContext* context) override;
+    void exitIfExpression(AntlrSQLParser::IfExpressionContext* context) override;
     void enterFunctionCall(AntlrSQLParser::FunctionCallContext* context) override;
     void exitFunctionCall(AntlrSQLParser::FunctionCallContext* context) override;
     void enterHavingClause(AntlrSQLParser::HavingClauseContext* context) override;
     void exitHavingClause(AntlrSQLParser::HavingClauseContext* context) override;
+    void exitWindowTopKClause(AntlrSQLParser::WindowTopKClauseContext* context) override;
+    void exitEarlyResultClause(AntlrSQLParser::EarlyResultClauseContext* context) override;
+    void exitAllowedLatenessClause(AntlrSQLParser::AllowedLatenessClauseContext* context) override;
+    void exitBernoulliSample(AntlrSQLParser::BernoulliSampleContext* context) override;
+    void exitReservoirSample(AntlrSQLParser::ReservoirSampleContext* context) override;
+    void exitWatermarkParameters(AntlrSQLParser::WatermarkParametersContext* context) override;
     void enterJoinRelation(AntlrSQLParser::JoinRelationContext* context) override;
     void exitJoinRelation(AntlrSQLParser::JoinRelationContext* context) override;
     void enterWindowClause(AntlrSQLParser::WindowClauseContext* context) override;
@@ -71,9 +82,14 @@ public:
     void enterTimeUnit(AntlrSQLParser::TimeUnitContext* context) override;
     void exitSizeParameter(AntlrSQLParser::SizeParameterContext* context) override;
     void exitAdvancebyParameter(AntlrSQLParser::AdvancebyParameterContext* context) override;
+    void exitGapParameter(AntlrSQLParser::GapParameterContext* context) override;
     void exitTimestampParameter(AntlrSQLParser::TimestampParameterContext* context) override;
     void exitTumblingWindow(AntlrSQLParser::TumblingWindowContext* context) override;
     void exitSlidingWindow(AntlrSQLParser::SlidingWindowContext* context) override;
+    void exitSessionWindow(AntlrSQLParser::SessionWindowContext* context) override;
+    void exitIntervalWindow(AntlrSQLParser::IntervalWindowContext* context) override;
+    void exitCountBasedTumbling(AntlrSQLParser::CountBasedTumblingContext* context) override;
+    void exitCountBasedSliding(AntlrSQLParser::CountBasedSlidingContext* context) override;
     void exitNamedExpression(AntlrSQLParser::NamedExpressionContext* context) override;
     void exitArithmeticUnary(AntlrSQLParser::ArithmeticUnaryContext* context) override;
     void exitArithmeticBinary(AntlrSQLParser::ArithmeticBinaryContext* context) override;
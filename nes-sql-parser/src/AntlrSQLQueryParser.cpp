@@ -14,10 +14,18 @@
 
 #include <SQLQueryParser/AntlrSQLQueryParser.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
 #include <memory>
+#include <optional>
 #include <ranges>
+#include <span>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include <ANTLRInputStream.h>
@@ -96,8 +104,8 @@ LogicalPlan createLogicalQueryPlanFromSQLString(std::string_view queryString)
         AntlrSQLLexer lexer(&input);
         antlr4::CommonTokenStream tokens(&lexer);
         AntlrSQLParser parser(&tokens);
-        [[maybe_unused]] auto listener = installErrorListenerAndHandler(queryString, lexer, parser);
-        AntlrSQLParser::QueryContext* tree = parser.query();
+        const auto listener = installErrorListenerAndHandler(queryString, lexer, parser);
+        AntlrSQLParser::QueryContext* tree = parseSllFirst(parser, &AntlrSQLParser::query, listener.get());
         Parsers::AntlrSQLQueryPlanCreator queryPlanCreator;
         antlr4::tree::ParseTreeWalker::DEFAULT.walk(&queryPlanCreator, tree);
         auto queryPlan = queryPlanCreator.getQueryPlan();
@@ -111,6 +119,58 @@ LogicalPlan createLogicalQueryPlanFromSQLString(std::string_view queryString)
     }
 }
 
+std::vector<LogicalPlan> createLogicalQueryPlansFromSQLStrings(std::span<const std::string> queryStrings)
+{
+    std::unordered_map<std::string_view, size_t> distinctQueryIndices;
+    std::vector<std::string_view> distinctQueries;
+    for (const auto& query : queryStrings)
+    {
+        if (distinctQueryIndices.try_emplace(query, distinctQueries.size()).second)
+        {
+            distinctQueries.emplace_back(query);
+        }
+    }
+
+    std::vector<std::optional<LogicalPlan>> plans(distinctQueries.size());
+    std::vector<std::exception_ptr> errors(distinctQueries.size());
+    std::atomic<size_t> nextQuery{0};
+    {
+        const auto numberOfThreads = std::clamp<size_t>(distinctQueries.size(), 1, std::max(1U, std::thread::hardware_concurrency()));
+        std::vector<std::jthread> threads;
+        for (size_t thread = 0; thread < numberOfThreads; ++thread)
+        {
+            threads.emplace_back(
+                [&]
+                {
+                    for (auto query = nextQuery++; query < distinctQueries.size(); query = nextQuery++)
+                    {
+                        try
+                        {
+                            plans[query] = createLogicalQueryPlanFromSQLString(distinctQueries[query]);
+                        }
+                        catch (...)
+                        {
+                            errors[query] = std::current_exception();
+                        }
+                    }
+                });
+        }
+    }
+
+    std::vector<LogicalPlan> parsedQueries;
+    parsedQueries.reserve(queryStrings.size());
+    for (const auto& query : queryStrings)
+    {
+        const auto index = distinctQueryIndices.at(query);
+        if (errors[index])
+        {
+            std::rethrow_exception(errors[index]);
+        }
+        parsedQueries.emplace_back(plans[index].value());
+    }
+    return parsedQueries;
+}
+
 std::shared_ptr<ManagedAntlrParser> ManagedAntlrParser::create(std::string_view input)
 {
     return std::make_shared<ManagedAntlrParser>(Private{}, input);
@@ -126,7 +186,8 @@ std::expected<ManagedAntlrParser::ManagedContext<AntlrSQLParser::StatementContex
 {
     try
     {
-        AntlrSQLParser::TerminatedStatementContext* tree = parser.terminatedStatement();
+        AntlrSQLParser::TerminatedStatementContext* tree
+            = parseSllFirst(parser, &AntlrSQLParser::terminatedStatement, errorListener.get());
         return ManagedContext{tree->statement(), shared_from_this()};
     }
     catch (antlr4::RuntimeException& antlrException)
@@ -140,7 +201,7 @@ ManagedAntlrParser::parseMultiple()
 {
     try
     {
-        AntlrSQLParser::MultipleStatementsContext* tree = parser.multipleStatements();
+        AntlrSQLParser::MultipleStatementsContext* tree = parseSllFirst(parser, &AntlrSQLParser::multipleStatements, errorListener.get());
         return tree->statement()
             | std::views::transform([this](auto statement) { return ManagedContext{statement, this->shared_from_this()}; })
             | std::ranges::to<std::vector>();
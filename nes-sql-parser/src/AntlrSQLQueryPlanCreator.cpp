@@ -15,14 +15,19 @@
 #include <AntlrSQLParser/AntlrSQLQueryPlanCreator.hpp>
 
 #include <cctype>
+#include <charconv>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <optional>
 #include <ranges>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include <AntlrSQLBaseListener.h>
 #include <AntlrSQLLexer.h>
@@ -31,6 +36,7 @@
 #include <AntlrSQLParser/AntlrSQLHelper.hpp>
 #include <DataTypes/DataType.hpp>
 #include <DataTypes/DataTypeProvider.hpp>
+#include <DataTypes/Decimal.hpp>
 #include <DataTypes/Schema.hpp>
 #include <Functions/ArithmeticalFunctions/AddLogicalFunction.hpp>
 #include <Functions/ArithmeticalFunctions/DivLogicalFunction.hpp>
@@ -38,18 +44,24 @@
 #include <Functions/ArithmeticalFunctions/MulLogicalFunction.hpp>
 #include <Functions/ArithmeticalFunctions/SubLogicalFunction.hpp>
 #include <Functions/BooleanFunctions/AndLogicalFunction.hpp>
+
 #include <Functions/BooleanFunctions/EqualsLogicalFunction.hpp>
 #include <Functions/BooleanFunctions/NegateLogicalFunction.hpp>
 #include <Functions/BooleanFunctions/OrLogicalFunction.hpp>
+#include <Functions/CaseLogicalFunction.hpp>
 #include <Functions/ComparisonFunctions/GreaterEqualsLogicalFunction.hpp>
 #include <Functions/ComparisonFunctions/GreaterLogicalFunction.hpp>
 #include <Functions/ComparisonFunctions/LessEqualsLogicalFunction.hpp>
 #include <Functions/ComparisonFunctions/LessLogicalFunction.hpp>
 #include <Functions/ConcatLogicalFunction.hpp>
 #include <Functions/ConstantValueLogicalFunction.hpp>
+#include <Functions/DateTimeLogicalFunction.hpp>
 #include <Functions/FieldAccessLogicalFunction.hpp>
 #include <Functions/LogicalFunction.hpp>
 #include <Functions/LogicalFunctionProvider.hpp>
+#include <Functions/StringMatchLogicalFunction.hpp>
+#include <Operators/Windows/Aggregations/ApproxCountDistinctAggregationLogicalFunction.hpp>
+#include <Operators/Windows/Aggregations/ApproximateQuantileAggregationLogicalFunction.hpp>
 #include <Operators/Windows/Aggregations/AvgAggregationLogicalFunction.hpp>
 #include <Operators/Windows/Aggregations/CountAggregationLogicalFunction.hpp>
 #include <Operators/Windows/Aggregations/MaxAggregationLogicalFunction.hpp>
@@ -58,12 +70,16 @@
 #include <Operators/Windows/Aggregations/SumAggregationLogicalFunction.hpp>
 #include <Operators/Windows/Aggregations/WindowAggregationLogicalFunction.hpp>
 #include <Operators/Windows/JoinLogicalOperator.hpp>
+#include <Operators/Windows/WindowedAggregationLogicalOperator.hpp>
 #include <Plans/LogicalPlan.hpp>
 #include <Plans/LogicalPlanBuilder.hpp>
 #include <Util/Overloaded.hpp>
 #include <Util/Strings.hpp>
 #include <WindowTypes/Measures/TimeCharacteristic.hpp>
 #include <WindowTypes/Measures/TimeMeasure.hpp>
+#include <WindowTypes/Types/IntervalWindow.hpp>
+#include <WindowTypes/Types/CountBasedWindowType.hpp>
+#include <WindowTypes/Types/SessionWindow.hpp>
 #include <WindowTypes/Types/SlidingWindow.hpp>
 #include <WindowTypes/Types/TumblingWindow.hpp>
 #include <fmt/format.h>
@@ -144,6 +160,138 @@ static LogicalFunction createFunctionFromOpBoolean(LogicalFunction leftFunction,
     }
 }
 
+/// Rewrites a LIKE pattern with a custom escape character to the backslash escapes of the StringMatchLogicalFunction
+static std::string replaceLikeEscapeCharacter(const std::string_view pattern, const char escapeCharacter)
+{
+    std::string rewritten;
+    rewritten.reserve(pattern.size());
+    for (size_t i = 0; i < pattern.size(); ++i)
+    {
+        if (pattern[i] == escapeCharacter and i + 1 < pattern.size())
+        {
+            rewritten.push_back('\\');
+            rewritten.push_back(pattern[++i]);
+        }
+        else
+        {
+            if (pattern[i] == '\\')
+            {
+                rewritten.push_back('\\');
+            }
+            rewritten.push_back(pattern[i]);
+        }
+    }
+    return rewritten;
+}
+
+/// Binds the unit of DATE_TRUNC and EXTRACT, e.g., HOUR or DOW
+static DateTimeUnit bindDateTimeUnit(const std::string_view unitText)
+{
+    static const std::unordered_map<std::string, DateTimeUnit> Units = {
+        {"MS", DateTimeUnit::MILLISECOND},
+        {"MILLISECOND", DateTimeUnit::MILLISECOND},
+        {"MILLISECONDS", DateTimeUnit::MILLISECOND},
+        {"SEC", DateTimeUnit::SECOND},
+        {"SECOND", DateTimeUnit::SECOND},
+        {"SECONDS", DateTimeUnit::SECOND},
+        {"MINUTE", DateTimeUnit::MINUTE},
+        {"MINUTES", DateTimeUnit::MINUTE},
+        {"HOUR", DateTimeUnit::HOUR},
+        {"HOURS", DateTimeUnit::HOUR},
+        {"DAY", DateTimeUnit::DAY},
+        {"DAYS", DateTimeUnit::DAY},
+        {"WEEK", DateTimeUnit::WEEK},
+        {"WEEKS", DateTimeUnit::WEEK},
+        {"MONTH", DateTimeUnit::MONTH},
+        {"MONTHS", DateTimeUnit::MONTH},
+        {"YEAR", DateTimeUnit::YEAR},
+        {"YEARS", DateTimeUnit::YEAR},
+        {"DOW", DateTimeUnit::DAY_OF_WEEK},
+        {"DOY", DateTimeUnit::DAY_OF_YEAR}};
+    if (const auto unit = Units.find(toUpperCase(unitText)); unit != Units.end())
+    {
+        return unit->second;
+    }
+    throw InvalidQuerySyntax("Unknown date-time unit: {}", unitText);
+}
+
+/// Binds a fixed utc offset of the form +HH:MM or -HH:MM (or UTC) to milliseconds
+static int64_t bindUtcOffset(antlr4::Token* utcOffsetToken)
+{
+    if (utcOffsetToken == nullptr)
+    {
+        return 0;
+    }
+    const auto utcOffset = bindStringLiteral(utcOffsetToken);
+    if (utcOffset == "UTC" or utcOffset == "Z")
+    {
+        return 0;
+    }
+    const std::string_view offset = utcOffset;
+    const auto isWellFormed = offset.size() == 6 and (offset[0] == '+' or offset[0] == '-') and offset[3] == ':';
+    const auto hours = isWellFormed ? from_chars<uint8_t>(offset.substr(1, 2)) : std::nullopt;
+    const auto minutes = isWellFormed ? from_chars<uint8_t>(offset.substr(4, 2)) : std::nullopt;
+    constexpr uint8_t maxHours = 14;
+    constexpr uint8_t minutesPerHour = 60;
+    if (not hours or not minutes or *hours > maxHours or *minutes >= minutesPerHour)
+    {
+        throw InvalidQuerySyntax("Expected a utc offset of the form +HH:MM, but got {}", offset);
+    }
+    const auto offsetInMs = ((int64_t{*hours} * minutesPerHour) + *minutes) * 60 * 1000;
+    return offset[0] == '-' ? -offsetInMs : offsetInMs;
+}
+
+static void pushDateTimeFunction(
+    AntlrSQLHelper& helper,
+    const DateTimeFunctionKind kind,
+    AntlrSQLParser::DateTimeUnitContext* unitContext,
+    antlr4::Token* utcOffsetToken,
+    antlr4::ParserRuleContext* context)
+{
+    const auto unit = bindDateTimeUnit(unitContext->getText());
+    if (not DateTimeLogicalFunction::supportsUnit(kind, unit))
+    {
+        throw InvalidQuerySyntax("The unit {} is not supported at {}", unitContext->getText(), context->getText());
+    }
+    if (helper.functionBuilder.empty())
+    {
+        throw InvalidQuerySyntax("Expected a timestamp at {}", context->getText());
+    }
+    const auto value = helper.functionBuilder.back();
+    helper.functionBuilder.pop_back();
+    helper.functionBuilder.emplace_back(DateTimeLogicalFunction(kind, unit, bindUtcOffset(utcOffsetToken), value));
+}
+
+/// Replaces the conditions and values of a CASE (or IF) on the function builder by the CASE
+static void
+pushCaseFunction(AntlrSQLHelper& helper, const size_t numberOfBranches, const bool hasElseValue, antlr4::ParserRuleContext* context)
+{
+    if (helper.isJoinRelation)
+    {
+        throw InvalidQuerySyntax("{} is not supported in join conditions at {}", context->getStart()->getText(), context->getText());
+    }
+    const auto numberOfChildren = (numberOfBranches * 2) + (hasElseValue ? 1 : 0);
+    if (helper.functionBuilder.size() < numberOfChildren)
+    {
+        throw InvalidQuerySyntax(
+            "Expected {} conditions and values, which must not be raw constants, at {}", numberOfChildren, context->getText());
+    }
+    const auto firstChild = helper.functionBuilder.end() - static_cast<std::ptrdiff_t>(numberOfChildren);
+    std::vector<std::pair<LogicalFunction, LogicalFunction>> branches;
+    for (size_t branch = 0; branch < numberOfBranches; ++branch)
+    {
+        const auto condition = firstChild + static_cast<std::ptrdiff_t>(branch * 2);
+        branches.emplace_back(*condition, *(condition + 1));
+    }
+    std::optional<LogicalFunction> elseValue;
+    if (hasElseValue)
+    {
+        elseValue = helper.functionBuilder.back();
+    }
+    helper.functionBuilder.erase(firstChild, helper.functionBuilder.end());
+    helper.functionBuilder.emplace_back(CaseLogicalFunction(branches, std::move(elseValue)));
+}
+
 static LogicalFunction createLogicalBinaryFunction(LogicalFunction leftFunction, LogicalFunction rightFunction, const uint64_t tokenType)
 {
     switch (tokenType)
@@ -242,6 +390,7 @@ void AntlrSQLQueryPlanCreator::exitSelectClause(AntlrSQLParser::SelectClauseCont
 {
     helpers.top().functionBuilder.clear();
     helpers.top().isSelect = false;
+    helpers.top().distinct = context->DISTINCT() != nullptr;
     AntlrSQLBaseListener::exitSelectClause(context);
 }
 
@@ -482,6 +631,29 @@ void AntlrSQLQueryPlanCreator::exitPrimaryQuery(AntlrSQLParser::PrimaryQueryCont
         return LogicalPlanBuilder::createLogicalPlan(helpers.top().getSource());
     }();
 
+    if (const auto fraction = helpers.top().bernoulliSampleFraction)
+    {
+        queryPlan = LogicalPlanBuilder::addBernoulliSample(fraction.value(), queryPlan);
+    }
+    if (const auto sampleSize = helpers.top().reservoirSampleSize)
+    {
+        /// The reservoir sample emits the records of each window instead of aggregates, thus its window must not be aggregated again
+        auto& helper = helpers.top();
+        const auto isTumblingOrSlidingWindow = std::dynamic_pointer_cast<Windowing::TumblingWindow>(helper.windowType) != nullptr
+            or std::dynamic_pointer_cast<Windowing::SlidingWindow>(helper.windowType) != nullptr;
+        if (not isTumblingOrSlidingWindow or helper.distinct or not helper.joinKeyRelationHelper.empty() or not helper.windowAggs.empty()
+            or not helper.groupByFields.empty() or helper.windowTopK.has_value() or not helper.getHavingClauses().empty()
+            or helper.earlyResultIntervalInMs.has_value() or helper.allowedLatenessInMs.has_value())
+        {
+            throw InvalidQuerySyntax(
+                "TABLESAMPLE RESERVOIR requires a tumbling or sliding window and supports neither DISTINCT, joins, aggregations, GROUP BY, "
+                "HAVING, ORDER BY, EMIT nor ALLOWED LATENESS, but got {}",
+                context->getText());
+        }
+        queryPlan = LogicalPlanBuilder::addReservoirSample(
+            queryPlan, helper.windowType, sampleSize.value(), helper.outOfOrdernessBoundInMs, helper.adaptiveOutOfOrderness);
+    }
+
     for (auto whereExpr = helpers.top().getWhereClauses().rbegin(); whereExpr != helpers.top().getWhereClauses().rend(); ++whereExpr)
     {
         queryPlan = LogicalPlanBuilder::addSelection(std::move(*whereExpr), queryPlan);
@@ -493,10 +665,43 @@ void AntlrSQLQueryPlanCreator::exitPrimaryQuery(AntlrSQLParser::PrimaryQueryCont
         queryPlan = LogicalPlanBuilder::addProjection(helpers.top().preAggregationProjections, /*asterisk=*/true, queryPlan);
     }
 
-    if (helpers.top().windowType != nullptr && helpers.top().joinKeyRelationHelper.empty())
+    if (helpers.top().distinct)
+    {
+        /// DISTINCT forwards the first occurrence of each record right away, thus its window only bounds the keys that it remembers
+        auto& helper = helpers.top();
+        const auto isTumblingWindow = std::dynamic_pointer_cast<Windowing::TumblingWindow>(helper.windowType) != nullptr;
+        if (not isTumblingWindow or not helper.joinKeyRelationHelper.empty() or not helper.windowAggs.empty()
+            or not helper.groupByFields.empty() or helper.windowTopK.has_value() or not helper.getHavingClauses().empty()
+            or helper.earlyResultIntervalInMs.has_value() or helper.allowedLatenessInMs.has_value())
+        {
+            throw InvalidQuerySyntax(
+                "SELECT DISTINCT requires a tumbling window and supports neither joins, aggregations, GROUP BY, HAVING, ORDER BY, EMIT nor "
+                "ALLOWED LATENESS, but got {}",
+                context->getText());
+        }
+        auto keys = helper.asterisk ? std::vector<LogicalFunction>{}
+                                    : helper.getProjections() | std::views::values | std::ranges::to<std::vector>();
+        queryPlan = LogicalPlanBuilder::addDeduplication(
+            queryPlan, helper.windowType, std::move(keys), helper.outOfOrdernessBoundInMs, helper.adaptiveOutOfOrderness);
+    }
+    else if (helpers.top().windowType != nullptr && helpers.top().joinKeyRelationHelper.empty()
+             && not helpers.top().reservoirSampleSize.has_value())
     {
+        /// An interval relates the timestamps of the records of two inputs
+        if (std::dynamic_pointer_cast<Windowing::IntervalWindow>(helpers.top().windowType) != nullptr)
+        {
+            throw InvalidQuerySyntax("WINDOW BETWEEN is only supported for joins, but got {}", context->getText());
+        }
         queryPlan = LogicalPlanBuilder::addWindowAggregation(
-            queryPlan, helpers.top().windowType, helpers.top().windowAggs, helpers.top().groupByFields);
+            queryPlan,
+            helpers.top().windowType,
+            helpers.top().windowAggs,
+            helpers.top().groupByFields,
+            helpers.top().windowTopK,
+            helpers.top().earlyResultIntervalInMs,
+            helpers.top().allowedLatenessInMs,
+            helpers.top().outOfOrdernessBoundInMs,
+            helpers.top().adaptiveOutOfOrderness);
     }
 
     queryPlan = LogicalPlanBuilder::addProjection(helpers.top().getProjections(), helpers.top().asterisk, queryPlan);
@@ -575,6 +780,16 @@ void AntlrSQLQueryPlanCreator::exitAdvancebyParameter(AntlrSQLParser::AdvancebyP
     AntlrSQLBaseListener::exitAdvancebyParameter(context);
 }
 
+void AntlrSQLQueryPlanCreator::exitGapParameter(AntlrSQLParser::GapParameterContext* context)
+{
+    if (context->children.size() < 3)
+    {
+        throw InvalidQuerySyntax("GapParameter must have 'GAP', a number, and a time unit.");
+    }
+    helpers.top().gap = std::stoi(context->children.at(1)->getText());
+    AntlrSQLBaseListener::exitGapParameter(context);
+}
+
 void AntlrSQLQueryPlanCreator::exitTimestampParameter(AntlrSQLParser::TimestampParameterContext* context)
 {
     helpers.top().timestamp = bindIdentifier(context->name);
@@ -616,6 +831,68 @@ void AntlrSQLQueryPlanCreator::exitSlidingWindow(AntlrSQLParser::SlidingWindowCo
     AntlrSQLBaseListener::exitSlidingWindow(context);
 }
 
+void AntlrSQLQueryPlanCreator::exitSessionWindow(AntlrSQLParser::SessionWindowContext* context)
+{
+    const auto gap = buildTimeMeasure(helpers.top().gap, helpers.top().timeUnit);
+    if (gap.getTime() == 0)
+    {
+        throw InvalidQuerySyntax("The gap of a session window must be greater than zero");
+    }
+    /// We use the ingestion time if the query does not have a timestamp fieldname specified
+    if (helpers.top().timestamp.empty())
+    {
+        helpers.top().windowType = std::make_shared<Windowing::SessionWindow>(API::IngestionTime(), gap);
+    }
+    else
+    {
+        helpers.top().windowType = std::make_shared<Windowing::SessionWindow>(
+            Windowing::TimeCharacteristic::createEventTime(FieldAccessLogicalFunction(helpers.top().timestamp)), gap);
+    }
+    AntlrSQLBaseListener::exitSessionWindow(context);
+}
+
+void AntlrSQLQueryPlanCreator::exitIntervalWindow(AntlrSQLParser::IntervalWindowContext* context)
+{
+    const auto toMilliseconds = [](AntlrSQLParser::IntervalBoundContext* bound)
+    {
+        const auto milliseconds = static_cast<int64_t>(
+            buildTimeMeasure(std::stoi(bound->INTEGER_VALUE()->getText()), bound->timeUnit()->getStop()->getType()).getTime());
+        return bound->MINUS() != nullptr ? -milliseconds : milliseconds;
+    };
+    const auto lowerBound = toMilliseconds(context->lower);
+    const auto upperBound = toMilliseconds(context->upper);
+    if (lowerBound > upperBound)
+    {
+        throw InvalidQuerySyntax("The lower bound of an interval must not exceed its upper bound, but got {}", context->getText());
+    }
+    helpers.top().windowType = std::make_shared<Windowing::IntervalWindow>(
+        Windowing::TimeCharacteristic::createEventTime(FieldAccessLogicalFunction(helpers.top().timestamp)), lowerBound, upperBound);
+    AntlrSQLBaseListener::exitIntervalWindow(context);
+}
+
+void AntlrSQLQueryPlanCreator::exitCountBasedTumbling(AntlrSQLParser::CountBasedTumblingContext* context)
+{
+    const auto size = std::stoull(context->size->getText());
+    if (size == 0)
+    {
+        throw InvalidQuerySyntax("The size of a count-based window must be greater than zero");
+    }
+    helpers.top().windowType = std::make_shared<Windowing::CountBasedWindowType>(size, size);
+    AntlrSQLBaseListener::exitCountBasedTumbling(context);
+}
+
+void AntlrSQLQueryPlanCreator::exitCountBasedSliding(AntlrSQLParser::CountBasedSlidingContext* context)
+{
+    const auto size = std::stoull(context->size->getText());
+    const auto slide = std::stoull(context->slide->getText());
+    if (size == 0 or slide == 0)
+    {
+        throw InvalidQuerySyntax("The size and the slide of a count-based window must be greater than zero");
+    }
+    helpers.top().windowType = std::make_shared<Windowing::CountBasedWindowType>(size, slide);
+    AntlrSQLBaseListener::exitCountBasedSliding(context);
+}
+
 void AntlrSQLQueryPlanCreator::exitNamedExpression(AntlrSQLParser::NamedExpressionContext* context)
 {
     AntlrSQLHelper& helper = helpers.top();
@@ -666,6 +943,100 @@ void AntlrSQLQueryPlanCreator::exitHavingClause(AntlrSQLParser::HavingClauseCont
     AntlrSQLBaseListener::exitHavingClause(context);
 }
 
+void AntlrSQLQueryPlanCreator::exitWindowTopKClause(AntlrSQLParser::WindowTopKClauseContext* context)
+{
+    if (helpers.top().windowType == nullptr or not helpers.top().joinKeyRelationHelper.empty())
+    {
+        throw InvalidQuerySyntax("ORDER BY ... LIMIT is only supported for windowed aggregations, but got {}", context->getText());
+    }
+    /// The window restricts its records before the selection of the HAVING clause, which would thus emit less records than the limit
+    if (not helpers.top().getHavingClauses().empty())
+    {
+        throw InvalidQuerySyntax("ORDER BY ... LIMIT cannot be combined with a HAVING clause, but got {}", context->getText());
+    }
+    const auto limit = std::stoull(context->limit->getText());
+    if (limit == 0)
+    {
+        throw InvalidQuerySyntax("The LIMIT of a window must be larger than zero, but got {}", context->getText());
+    }
+    const bool ascending = context->ordering != nullptr and context->ordering->getType() == AntlrSQLLexer::ASC;
+    helpers.top().windowTopK = WindowTopK{FieldAccessLogicalFunction(bindIdentifier(context->orderField)), ascending, limit};
+    AntlrSQLBaseListener::exitWindowTopKClause(context);
+}
+
+void AntlrSQLQueryPlanCreator::exitEarlyResultClause(AntlrSQLParser::EarlyResultClauseContext* context)
+{
+    /// Sessions and count-based windows grow with every record, i.e., their bounds are unknown until they get triggered
+    if (std::dynamic_pointer_cast<Windowing::TumblingWindow>(helpers.top().windowType) == nullptr
+        and std::dynamic_pointer_cast<Windowing::SlidingWindow>(helpers.top().windowType) == nullptr)
+    {
+        throw InvalidQuerySyntax("EMIT EVERY is only supported for tumbling and sliding windows, but got {}", context->getText());
+    }
+    const auto interval
+        = buildTimeMeasure(std::stoi(context->interval->getText()), context->timeUnit()->getStop()->getType()).getTime();
+    if (interval == 0)
+    {
+        throw InvalidQuerySyntax("The interval of EMIT EVERY must be larger than zero, but got {}", context->getText());
+    }
+    helpers.top().earlyResultIntervalInMs = interval;
+    AntlrSQLBaseListener::exitEarlyResultClause(context);
+}
+
+void AntlrSQLQueryPlanCreator::exitAllowedLatenessClause(AntlrSQLParser::AllowedLatenessClauseContext* context)
+{
+    /// Late records would extend or merge sessions, and count-based windows have no event time
+    if (std::dynamic_pointer_cast<Windowing::TumblingWindow>(helpers.top().windowType) == nullptr
+        and std::dynamic_pointer_cast<Windowing::SlidingWindow>(helpers.top().windowType) == nullptr)
+    {
+        throw InvalidQuerySyntax("ALLOWED LATENESS is only supported for tumbling and sliding windows, but got {}", context->getText());
+    }
+    helpers.top().allowedLatenessInMs
+        = buildTimeMeasure(std::stoi(context->interval->getText()), context->timeUnit()->getStop()->getType()).getTime();
+    AntlrSQLBaseListener::exitAllowedLatenessClause(context);
+}
+
+void AntlrSQLQueryPlanCreator::exitBernoulliSample(AntlrSQLParser::BernoulliSampleContext* context)
+{
+    const auto percentage = std::stod(context->percentage->getText());
+    if (not(percentage > 0 and percentage <= 100))
+    {
+        throw InvalidQuerySyntax("The percentage of TABLESAMPLE BERNOULLI must be in (0, 100], but got {}", context->getText());
+    }
+    helpers.top().bernoulliSampleFraction = percentage / 100;
+    AntlrSQLBaseListener::exitBernoulliSample(context);
+}
+
+void AntlrSQLQueryPlanCreator::exitReservoirSample(AntlrSQLParser::ReservoirSampleContext* context)
+{
+    const auto size = std::stoull(context->size->getText());
+    if (size == 0)
+    {
+        throw InvalidQuerySyntax("The size of TABLESAMPLE RESERVOIR must be positive, but got {}", context->getText());
+    }
+    helpers.top().reservoirSampleSize = size;
+    AntlrSQLBaseListener::exitReservoirSample(context);
+}
+
+void AntlrSQLQueryPlanCreator::exitWatermarkParameters(AntlrSQLParser::WatermarkParametersContext* context)
+{
+    const auto field = bindIdentifier(context->watermarkIdentifier);
+    if (helpers.top().timestamp.empty() or field != helpers.top().timestamp)
+    {
+        throw InvalidQuerySyntax(
+            "WATERMARK requires an event-time window on the same field, but got {} for the window on '{}'",
+            context->getText(),
+            helpers.top().timestamp);
+    }
+    helpers.top().outOfOrdernessBoundInMs
+        = buildTimeMeasure(std::stoi(context->watermark->getText()), context->watermarkTimeUnit->getStop()->getType()).getTime();
+    helpers.top().adaptiveOutOfOrderness = context->adaptive != nullptr;
+    if (helpers.top().adaptiveOutOfOrderness and helpers.top().outOfOrdernessBoundInMs == 0)
+    {
+        throw InvalidQuerySyntax("An ADAPTIVE watermark requires a bound larger than zero, but got {}", context->getText());
+    }
+    AntlrSQLBaseListener::exitWatermarkParameters(context);
+}
+
 void AntlrSQLQueryPlanCreator::exitComparison(AntlrSQLParser::ComparisonContext* context)
 {
     if (helpers.top().isJoinRelation)
@@ -699,6 +1070,89 @@ void AntlrSQLQueryPlanCreator::exitComparison(AntlrSQLParser::ComparisonContext*
     AntlrSQLBaseListener::exitComparison(context);
 }
 
+void AntlrSQLQueryPlanCreator::exitPredicate(AntlrSQLParser::PredicateContext* context)
+{
+    /// Only `value [NOT] LIKE pattern [ESCAPE 'c']` and `value [NOT] RLIKE pattern` are supported, the other predicates are not (yet)
+    /// translated
+    const auto isLike = context->kind != nullptr and context->kind->getType() == AntlrSQLLexer::LIKE;
+    const auto isRegexpLike = context->kind != nullptr and context->kind->getType() == AntlrSQLLexer::RLIKE;
+    if ((not isLike and not isRegexpLike) or context->pattern == nullptr)
+    {
+        AntlrSQLBaseListener::exitPredicate(context);
+        return;
+    }
+    if (helpers.top().isJoinRelation)
+    {
+        throw InvalidQuerySyntax("{} is not supported in join conditions at {}", context->kind->getText(), context->getText());
+    }
+
+    /// A string literal pattern is a VARSIZED constant
+    auto& functionBuilder = helpers.top().functionBuilder;
+    const auto* patternStart = context->pattern->getStart();
+    if (patternStart->getType() == AntlrSQLLexer::STRING and patternStart == context->pattern->getStop())
+    {
+        if (helpers.top().constantBuilder.empty())
+        {
+            throw InvalidQuerySyntax("Expected a {} pattern at {}", context->kind->getText(), context->getText());
+        }
+        functionBuilder.emplace_back(ConstantValueLogicalFunction(
+            DataTypeProvider::provideDataType(DataType::Type::VARSIZED), std::move(helpers.top().constantBuilder.back())));
+        helpers.top().constantBuilder.pop_back();
+    }
+    if (functionBuilder.size() < 2)
+    {
+        throw InvalidQuerySyntax("{} requires a value and a pattern at {}", context->kind->getText(), context->getText());
+    }
+    auto pattern = functionBuilder.back();
+    functionBuilder.pop_back();
+    auto value = functionBuilder.back();
+    functionBuilder.pop_back();
+
+    if (context->escapeChar != nullptr)
+    {
+        const auto escapeText = context->escapeChar->getText();
+        const auto constantPattern = pattern.tryGetAs<ConstantValueLogicalFunction>();
+        if (escapeText.size() != 3 or not constantPattern.has_value())
+        {
+            throw InvalidQuerySyntax("ESCAPE requires a single character and a constant pattern at {}", context->getText());
+        }
+        pattern = ConstantValueLogicalFunction(
+            constantPattern->get().getDataType(), replaceLikeEscapeCharacter(constantPattern->get().getConstantValue(), escapeText[1]));
+    }
+
+    LogicalFunction match = StringMatchLogicalFunction(isLike ? StringMatchKind::LIKE : StringMatchKind::REGEXP_MATCH, value, pattern);
+    if (context->NOT() != nullptr)
+    {
+        match = NegateLogicalFunction(match);
+    }
+    functionBuilder.push_back(match);
+    AntlrSQLBaseListener::exitPredicate(context);
+}
+
+void AntlrSQLQueryPlanCreator::exitDateTrunc(AntlrSQLParser::DateTruncContext* context)
+{
+    pushDateTimeFunction(helpers.top(), DateTimeFunctionKind::DATE_TRUNC, context->unit, context->utcOffset, context);
+    AntlrSQLBaseListener::exitDateTrunc(context);
+}
+
+void AntlrSQLQueryPlanCreator::exitExtract(AntlrSQLParser::ExtractContext* context)
+{
+    pushDateTimeFunction(helpers.top(), DateTimeFunctionKind::EXTRACT, context->unit, context->utcOffset, context);
+    AntlrSQLBaseListener::exitExtract(context);
+}
+
+void AntlrSQLQueryPlanCreator::exitCaseExpression(AntlrSQLParser::CaseExpressionContext* context)
+{
+    pushCaseFunction(helpers.top(), context->conditions.size(), context->elseValue != nullptr, context);
+    AntlrSQLBaseListener::exitCaseExpression(context);
+}
+
+void AntlrSQLQueryPlanCreator::exitIfExpression(AntlrSQLParser::IfExpressionContext* context)
+{
+    pushCaseFunction(helpers.top(), 1, true, context);
+    AntlrSQLBaseListener::exitIfExpression(context);
+}
+
 void AntlrSQLQueryPlanCreator::enterJoinRelation(AntlrSQLParser::JoinRelationContext* context)
 {
     helpers.top().joinKeyRelationHelper.clear();
@@ -759,12 +1213,15 @@ void AntlrSQLQueryPlanCreator::exitJoinRelation(AntlrSQLParser::JoinRelationCont
     {
         throw InvalidQuerySyntax("joinFunction is required but empty at {}", context->getText());
     }
-    if (!helpers.top().windowType)
+    const auto isLookupJoin = context->LOOKUP() != nullptr;
+    if (not isLookupJoin and !helpers.top().windowType)
     {
         throw InvalidQuerySyntax("windowType is required but empty at {}", context->getText());
     }
-    const auto queryPlan = LogicalPlanBuilder::addJoin(
-        leftQueryPlan, rightQueryPlan, helpers.top().joinKeyRelationHelper.at(0), helpers.top().windowType, helpers.top().joinType);
+    const auto queryPlan = isLookupJoin
+        ? LogicalPlanBuilder::addLookupJoin(leftQueryPlan, rightQueryPlan, helpers.top().joinKeyRelationHelper.at(0))
+        : LogicalPlanBuilder::addJoin(
+              leftQueryPlan, rightQueryPlan, helpers.top().joinKeyRelationHelper.at(0), helpers.top().windowType, helpers.top().joinType);
     if (not helpers.empty())
     {
         /// we are in a subquery
@@ -896,10 +1353,41 @@ void AntlrSQLQueryPlanCreator::exitFunctionCall(AntlrSQLParser::FunctionCallCont
                 MedianAggregationLogicalFunction(helpers.top().functionBuilder.back().getAs<FieldAccessLogicalFunction>().get())));
             isAggregation = true;
             break;
+        case AntlrSQLLexer::APPROX_COUNT_DISTINCT:
+            ensureFieldAccessArgument();
+            helpers.top().windowAggs.push_back(
+                std::make_shared<WindowAggregationLogicalFunction>(ApproxCountDistinctAggregationLogicalFunction(
+                    helpers.top().functionBuilder.back().getAs<FieldAccessLogicalFunction>().get())));
+            isAggregation = true;
+            break;
+        case AntlrSQLLexer::TDIGEST_QUANTILE:
+        case AntlrSQLLexer::KLL_QUANTILE: {
+            /// The quantile is a plain constant, e.g., TDIGEST_QUANTILE(i8, 0.99)
+            if (context->argument.size() != 2 or helpers.top().constantBuilder.empty())
+            {
+                throw InvalidQuerySyntax("{} expects a field and a constant quantile at {}", funcName, context->getText());
+            }
+            const auto quantileText = std::move(helpers.top().constantBuilder.back());
+            helpers.top().constantBuilder.pop_back();
+            double quantile = 0;
+            const auto [end, error] = std::from_chars(quantileText.data(), quantileText.data() + quantileText.size(), quantile);
+            if (error != std::errc{} or end != quantileText.data() + quantileText.size() or quantile < 0 or quantile > 1)
+            {
+                throw InvalidQuerySyntax("The quantile of {} must be a number in [0, 1], but got {}", funcName, quantileText);
+            }
+            ensureFieldAccessArgument();
+            using enum ApproximateQuantileAggregationLogicalFunction::Sketch;
+            const auto sketch = tokenType == AntlrSQLLexer::TDIGEST_QUANTILE ? TDIGEST : KLL;
+            helpers.top().windowAggs.push_back(
+                std::make_shared<WindowAggregationLogicalFunction>(ApproximateQuantileAggregationLogicalFunction(
+                    sketch, helpers.top().functionBuilder.back().getAs<FieldAccessLogicalFunction>().get(), quantile)));
+            isAggregation = true;
+            break;
+        }
         default:
             helpers.top().hasUnnamedAggregation = false;
             /// Check if the function is a constructor for a datatype
-            if (const auto dataType = DataTypeProvider::tryProvideDataType(funcName); dataType.has_value())
+            if (auto dataType = DataTypeProvider::tryProvideDataType(funcName); dataType.has_value())
             {
                 if (helpers.top().constantBuilder.empty())
                 {
@@ -908,9 +1396,29 @@ void AntlrSQLQueryPlanCreator::exitFunctionCall(AntlrSQLParser::FunctionCallCont
                 helpers.top().hasUnnamedAggregation = false;
                 auto value = std::move(helpers.top().constantBuilder.back());
                 helpers.top().constantBuilder.pop_back();
+                if (dataType->isDecimal())
+                {
+                    /// The scale of a decimal constant, e.g., DECIMAL(12.50), is its number of fractional digits
+                    const auto decimalPoint = value.find('.');
+                    const auto scale = decimalPoint == std::string::npos ? 0 : value.size() - decimalPoint - 1;
+                    if (scale > Decimal::MAX_PRECISION)
+                    {
+                        throw InvalidQuerySyntax(
+                            "The decimal constant {} has more than {} fractional digits", value, Decimal::MAX_PRECISION);
+                    }
+                    dataType = DataTypeProvider::provideDecimalDataType(
+                        Decimal::MAX_PRECISION, static_cast<uint8_t>(scale), DataType::NULLABLE::NOT_NULLABLE);
+                }
                 auto constFunctionItem = ConstantValueLogicalFunction(*dataType, std::move(value));
                 helpers.top().functionBuilder.emplace_back(constFunctionItem);
             }
+            else if (context->argument.size() == 1 and LogicalFunctionProvider::isRegisteredAggregation(funcName))
+            {
+                ensureFieldAccessArgument();
+                helpers.top().windowAggs.push_back(LogicalFunctionProvider::provideAggregation(
+                    funcName, helpers.top().functionBuilder.back().getAs<FieldAccessLogicalFunction>().get()));
+                isAggregation = true;
+            }
             else
             {
                 const auto numArgs = context->argument.size();
@@ -924,7 +1432,15 @@ void AntlrSQLQueryPlanCreator::exitFunctionCall(AntlrSQLParser::FunctionCallCont
                 }
                 auto argsBegin = helpers.top().functionBuilder.end() - static_cast<std::ptrdiff_t>(numArgs);
                 std::vector<LogicalFunction> funcArgs(argsBegin, helpers.top().functionBuilder.end());
-                if (auto logicalFunction = LogicalFunctionProvider::tryProvide(funcName, std::move(funcArgs)))
+                /// Functions are registered in camel case, e.g., STARTS_WITH resolves to StartsWith
+                auto logicalFunction = LogicalFunctionProvider::tryProvide(funcName, funcArgs);
+                if (not logicalFunction.has_value() and funcName.find('_') != std::string::npos)
+                {
+                    auto nameWithoutUnderscores = funcName;
+                    std::erase(nameWithoutUnderscores, '_');
+                    logicalFunction = LogicalFunctionProvider::tryProvide(nameWithoutUnderscores, std::move(funcArgs));
+                }
+                if (logicalFunction)
                 {
                     helpers.top().functionBuilder.resize(helpers.top().functionBuilder.size() - numArgs);
                     helpers.top().functionBuilder.push_back(*logicalFunction);
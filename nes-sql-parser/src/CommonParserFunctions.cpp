@@ -251,7 +251,7 @@ Schema bindSchema(AntlrSQLParser::SchemaDefinitionContext* schemaDefAST)
     {
         auto isNullableBool = column->nullableDefinition() == nullptr || !(not column->nullableDefinition()->getText().empty());
         auto isNullable = isNullableBool ? DataType::NULLABLE::IS_NULLABLE : DataType::NULLABLE::NOT_NULLABLE;
-        auto dataType = bindDataType(column->typeDefinition(), isNullable);
+        auto dataType = bindDataType(column->columnType(), isNullable);
         /// TODO #764 Remove qualification of column names in schema declarations, it's only needed as a hack now to make it work with the per-operator-lexical-scopes.
         std::stringstream qualifiedAttributeName;
         for (const auto& unboundIdentifier : column->identifierChain()->strictIdentifier())
@@ -264,9 +264,24 @@ Schema bindSchema(AntlrSQLParser::SchemaDefinitionContext* schemaDefAST)
     return schema;
 }
 
-DataType bindDataType(AntlrSQLParser::TypeDefinitionContext* typeDefAST, const DataType::NULLABLE isNullable)
+DataType bindDataType(AntlrSQLParser::ColumnTypeContext* columnTypeAST, const DataType::NULLABLE isNullable)
 {
-    std::string dataTypeText = typeDefAST->getText();
+    if (columnTypeAST->precision != nullptr)
+    {
+        if (toUpperCase(columnTypeAST->IDENTIFIER()->getText()) != "DECIMAL")
+        {
+            throw UnknownDataType("{} does not take a precision and a scale", columnTypeAST->IDENTIFIER()->getText());
+        }
+        const auto precision = from_chars<uint8_t>(columnTypeAST->precision->getText());
+        const auto scale = from_chars<uint8_t>(columnTypeAST->scale->getText());
+        if (not precision or not scale)
+        {
+            throw UnknownDataType("{}", columnTypeAST->getText());
+        }
+        return DataTypeProvider::provideDecimalDataType(*precision, *scale, isNullable);
+    }
+
+    std::string dataTypeText = columnTypeAST->getText();
 
     bool translated = false;
     bool isUnsigned = false;
@@ -297,9 +312,9 @@ DataType bindDataType(AntlrSQLParser::TypeDefinitionContext* typeDefAST, const D
     {
         if (translated)
         {
-            throw UnknownDataType("{}, translated into {}", typeDefAST->getText(), dataTypeText);
+            throw UnknownDataType("{}, translated into {}", columnTypeAST->getText(), dataTypeText);
         }
-        throw UnknownDataType("{}", typeDefAST->getText());
+        throw UnknownDataType("{}", columnTypeAST->getText());
     }
     return *dataType;
 }
@@ -49,6 +49,7 @@
 #include <DataTypes/DataType.hpp>
 #include <DataTypes/Schema.hpp>
 #include <Plans/LogicalPlan.hpp>
+#include <SQLQueryParser/AntlrSQLQueryParser.hpp>
 #include <Sinks/SinkDescriptor.hpp>
 #include <Sources/LogicalSource.hpp>
 #include <Sources/SourceCatalog.hpp>
@@ -458,7 +459,8 @@ StatementBinder::parseAndBind(const std::string_view statementString) const noex
         AntlrSQLParser parser(&tokens);
         /// Enable that antlr throws exeptions on parsing errors
         parser.setErrorHandler(std::make_shared<antlr4::BailErrorStrategy>());
-        AntlrSQLParser::MultipleStatementsContext* tree = parser.multipleStatements();
+        AntlrSQLParser::MultipleStatementsContext* tree
+            = AntlrSQLQueryParser::parseSllFirst(parser, &AntlrSQLParser::multipleStatements, nullptr);
         if (tree == nullptr)
         {
             return std::unexpected{InvalidQuerySyntax("{}", statementString)};
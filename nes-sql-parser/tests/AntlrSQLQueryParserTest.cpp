@@ -0,0 +1,247 @@
+/*
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        https://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <ANTLRInputStream.h>
+#include <AntlrSQLLexer.h>
+#include <AntlrSQLParser.h>
+#include <BailErrorStrategy.h>
+#include <BaseErrorListener.h>
+#include <CommonTokenStream.h>
+#include <Exceptions.h>
+#include <Recognizer.h>
+#include <Token.h>
+#include <atn/ParserATNSimulator.h>
+#include <atn/PredictionMode.h>
+#include <Plans/LogicalPlan.hpp>
+#include <SQLQueryParser/AntlrSQLQueryParser.hpp>
+#include <Util/Logger/LogLevel.hpp>
+#include <Util/Logger/Logger.hpp>
+#include <Util/Logger/impl/NesLogger.hpp>
+#include <fmt/format.h>
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <BaseUnitTest.hpp>
+#include <ErrorHandling.hpp>
+
+namespace NES
+{
+namespace
+{
+
+/// Records the errors in the format of the query parser. Bails out on the first error, like the listener of the query parser, if requested.
+class RecordingErrorListener final : public antlr4::BaseErrorListener
+{
+public:
+    explicit RecordingErrorListener(bool bail) : bail(bail) { }
+
+    void syntaxError(
+        antlr4::Recognizer*, antlr4::Token*, size_t line, size_t charPositionInLine, const std::string& msg, std::exception_ptr) override
+    {
+        errors.emplace_back(fmt::format("line {}:{} {}", line, charPositionInLine, msg));
+        if (bail)
+        {
+            throw antlr4::ParseCancellationException(msg);
+        }
+    }
+
+    std::vector<std::string> errors;
+
+private:
+    bool bail;
+};
+
+/// Rejects the query in SLL mode after consuming some of its tokens, like the rare input that requires the full LL context.
+/// Reports a probe error in each attempt to show which attempts the error listener observes.
+class SllRejectingParser final : public AntlrSQLParser
+{
+public:
+    using AntlrSQLParser::AntlrSQLParser;
+
+    struct Attempt
+    {
+        antlr4::atn::PredictionMode mode;
+        size_t tokenIndex;
+    };
+
+    QueryContext* sllRejectingQuery()
+    {
+        const auto mode = getInterpreter<antlr4::atn::ParserATNSimulator>()->getPredictionMode();
+        attempts.emplace_back(mode, getTokenStream()->index());
+        notifyErrorListeners(getCurrentToken(), "probe", nullptr);
+        if (mode == antlr4::atn::PredictionMode::SLL)
+        {
+            consume();
+            consume();
+            throw antlr4::ParseCancellationException("rejected by SLL");
+        }
+        return query();
+    }
+
+    std::vector<Attempt> attempts;
+};
+
+/// Parses the query with the LL prediction mode only and returns the message of its error in the format of the query parser, if any.
+std::optional<std::string> errorOfLlParse(std::string_view query)
+{
+    antlr4::ANTLRInputStream input(query.data(), query.length());
+    AntlrSQLLexer lexer(&input);
+    antlr4::CommonTokenStream tokens(&lexer);
+    AntlrSQLParser parser(&tokens);
+    RecordingErrorListener listener{true};
+    lexer.removeErrorListeners();
+    parser.removeErrorListeners();
+    lexer.addErrorListener(&listener);
+    parser.addErrorListener(&listener);
+    parser.setErrorHandler(std::make_shared<antlr4::BailErrorStrategy>());
+    parser.getInterpreter<antlr4::atn::ParserATNSimulator>()->setPredictionMode(antlr4::atn::PredictionMode::LL);
+    try
+    {
+        parser.query();
+    }
+    catch (const antlr4::RuntimeException& exception)
+    {
+        const auto error = listener.errors.empty() ? std::string(exception.what()) : listener.errors.front();
+        return fmt::format("Antlr exception during parsing: {} in {}", error, query);
+    }
+    return std::nullopt;
+}
+
+/// Returns the queries that read from the source and write to the sink with the same index.
+std::vector<std::string> createQueries(size_t numberOfQueries)
+{
+    std::vector<std::string> queries;
+    for (size_t query = 0; query < numberOfQueries; ++query)
+    {
+        queries.emplace_back(fmt::format("SELECT * FROM source{} INTO sink{}", query, query));
+    }
+    return queries;
+}
+
+class AntlrSQLQueryParserTest : public Testing::BaseUnitTest
+{
+public:
+    static void SetUpTestSuite()
+    {
+        Logger::setupLogging("AntlrSQLQueryParserTest.log", LogLevel::LOG_DEBUG);
+        NES_DEBUG("Setup AntlrSQLQueryParserTest test class.");
+    }
+};
+
+TEST_F(AntlrSQLQueryParserTest, FallsBackToLlIfSllRejectsTheInput)
+{
+    constexpr std::string_view query = "SELECT * FROM source INTO sink";
+    antlr4::ANTLRInputStream input(query.data(), query.length());
+    AntlrSQLLexer lexer(&input);
+    antlr4::CommonTokenStream tokens(&lexer);
+    SllRejectingParser parser(&tokens);
+    parser.setErrorHandler(std::make_shared<antlr4::BailErrorStrategy>());
+    RecordingErrorListener listener{false};
+
+    auto* const tree = AntlrSQLQueryParser::parseSllFirst(parser, &SllRejectingParser::sllRejectingQuery, &listener);
+
+    ASSERT_EQ(parser.attempts.size(), 2);
+    EXPECT_EQ(parser.attempts[0].mode, antlr4::atn::PredictionMode::SLL);
+    EXPECT_EQ(parser.attempts[1].mode, antlr4::atn::PredictionMode::LL);
+    /// The LL attempt starts again at the tokens that the SLL attempt consumed.
+    EXPECT_EQ(parser.attempts[1].tokenIndex, parser.attempts[0].tokenIndex);
+    /// Only the LL attempt reports its errors.
+    ASSERT_EQ(listener.errors.size(), 1);
+    EXPECT_THAT(listener.errors.front(), testing::HasSubstr("probe"));
+    const auto plan = AntlrSQLQueryParser::bindLogicalQueryPlan(tree);
+    EXPECT_TRUE(plan == AntlrSQLQueryParser::createLogicalQueryPlanFromSQLString(query));
+}
+
+TEST_F(AntlrSQLQueryParserTest, ReportsTheErrorsOfTheLlParse)
+{
+    for (const std::string_view query :
+         {"SELECT * FROM source INTO",
+          "SELECT * FROM source WHERE INTO sink",
+          "SELECT FROM source INTO sink",
+          "SELECT # FROM source INTO sink"})
+    {
+        const auto expectedError = errorOfLlParse(query);
+        ASSERT_TRUE(expectedError.has_value()) << query;
+        try
+        {
+            (void)AntlrSQLQueryParser::createLogicalQueryPlanFromSQLString(query);
+            FAIL() << "Expected " << query << " to be invalid";
+        }
+        catch (const Exception& exception)
+        {
+            EXPECT_EQ(exception.code(), ErrorCode::InvalidQuerySyntax) << query;
+            EXPECT_THAT(exception.what(), testing::HasSubstr(*expectedError)) << query;
+        }
+    }
+}
+
+TEST_F(AntlrSQLQueryParserTest, ReturnsThePlansInTheOrderOfTheQueries)
+{
+    auto queries = createQueries(100);
+    /// Duplicates are parsed once but returned for each occurrence.
+    queries.emplace_back(queries[42]);
+    queries.insert(queries.begin(), queries[7]);
+
+    const auto plans = AntlrSQLQueryParser::createLogicalQueryPlansFromSQLStrings(queries);
+
+    ASSERT_EQ(plans.size(), queries.size());
+    for (size_t query = 0; query < queries.size(); ++query)
+    {
+        EXPECT_EQ(plans[query].getOriginalSql(), queries[query]);
+    }
+}
+
+TEST_F(AntlrSQLQueryParserTest, ReturnsNoPlansForNoQueries)
+{
+    EXPECT_TRUE(AntlrSQLQueryParser::createLogicalQueryPlansFromSQLStrings({}).empty());
+}
+
+TEST_F(AntlrSQLQueryParserTest, ThrowsTheErrorOfAnInvalidQueryAtAnyPosition)
+{
+    constexpr size_t numberOfQueries = 64;
+    for (const size_t invalidQuery : {size_t{0}, numberOfQueries / 2, numberOfQueries - 1})
+    {
+        auto queries = createQueries(numberOfQueries);
+        queries[invalidQuery] = "SELECT * FROM source INTO";
+        ASSERT_EXCEPTION_ERRORCODE(
+            (void)AntlrSQLQueryParser::createLogicalQueryPlansFromSQLStrings(queries), ErrorCode::InvalidQuerySyntax);
+    }
+}
+
+TEST_F(AntlrSQLQueryParserTest, ThrowsTheErrorOfTheFirstInvalidQuery)
+{
+    auto queries = createQueries(64);
+    queries[10] = "SELECT * FROM first INTO";
+    queries[50] = "SELECT * FROM second INTO";
+    try
+    {
+        (void)AntlrSQLQueryParser::createLogicalQueryPlansFromSQLStrings(queries);
+        FAIL() << "Expected the queries to be invalid";
+    }
+    catch (const Exception& exception)
+    {
+        EXPECT_EQ(exception.code(), ErrorCode::InvalidQuerySyntax);
+        EXPECT_THAT(exception.what(), testing::HasSubstr(queries[10]));
+        EXPECT_THAT(exception.what(), testing::Not(testing::HasSubstr(queries[50])));
+    }
+}
+
+}
+}
@@ -51,6 +51,13 @@ public:
     BoolOption randomQueryOrder = {"random_query_order", "false", "run queries in random order"};
     UIntOption numberConcurrentQueries = {"number_concurrent_queries", "6", "number of maximal concurrently running queries"};
     BoolOption benchmark = {"benchmark_queries", "false", "Records the execution time of each query"};
+    UIntOption benchmarkRepetitions = {"benchmark_repetitions", "1", "number of measured runs of each benchmarked query"};
+    UIntOption benchmarkWarmupRepetitions
+        = {"benchmark_warmup_repetitions", "0", "number of discarded runs before the measured runs of each benchmarked query"};
+    StringOption benchmarkBaseline
+        = {"benchmark_baseline", "", "benchmark results of a previous run (BenchmarkResults.json) to compare the benchmark against"};
+    FloatOption benchmarkRegressionThreshold
+        = {"benchmark_regression_threshold", "10", "slowdown of the median execution time in percent that fails the benchmark"};
     SequenceOption<StringOption> testGroups = {"test_groups", "test groups to run"};
     SequenceOption<StringOption> excludeGroups = {"exclude_groups", "test groups to exclude"};
     StringOption workerConfig = {"worker_config", "", "used worker config file (.yaml)"};
@@ -81,13 +81,24 @@ inline std::string discardPerformanceMessage(RunningQuery&)
     SystestProgressTracker& progressTracker);
 
 /// Run queries sequentially locally and benchmark the run time of each query.
+/// Every query runs 'warmupRepetitions' times without measuring, before it runs 'repetitions' measured times. Besides the run time, each
+/// run records the time to the first result (from the start of the query until the sink completed its first buffer) and the peak number
+/// of buffers in use. The results report the median, minimum, and maximum over the measured runs.
 /// @return vector containing failed queries
 [[nodiscard]] std::vector<RunningQuery> runQueriesAndBenchmark(
     const std::vector<SystestQuery>& queries,
     const SingleNodeWorkerConfiguration& configuration,
+    uint64_t warmupRepetitions,
+    uint64_t repetitions,
     nlohmann::json& resultJson,
     SystestProgressTracker& progressTracker);
 
+/// Compares the median execution time of each benchmarked query with its results in the baseline, i.e., the results of a previous run of
+/// runQueriesAndBenchmark. Queries without results in the baseline are skipped.
+/// @return the queries whose median execution time increased by more than the threshold (in percent)
+[[nodiscard]] std::vector<std::string>
+compareWithBaseline(const nlohmann::json& resultJson, const nlohmann::json& baselineJson, double regressionThresholdInPercent);
+
 /// Prints the error message, if the query has failed/passed and the expected and result tuples, like below
 /// function/arithmetical/FunctionDiv:4..................................Passed
 /// function/arithmetical/FunctionMul:5..................................Failed
@@ -307,6 +307,7 @@ SystestExecutorResult SystestExecutor::executeSystests()
         }
         const auto numberConcurrentQueries = config.numberConcurrentQueries.getValue();
         std::vector<Systest::RunningQuery> failedQueries;
+        std::vector<std::string> benchmarkRegressions;
         if (const auto grpcURI = config.grpcAddressUri.getValue(); config.remoteTestExecution.getValue())
         {
             progressTracker.reset();
@@ -352,7 +353,13 @@ SystestExecutorResult SystestExecutor::executeSystests()
 
                 progressTracker.reset();
                 progressTracker.setTotalQueries(benchmarkQueries.size());
-                auto failed = runQueriesAndBenchmark(benchmarkQueries, singleNodeWorkerConfiguration, benchmarkResults, progressTracker);
+                auto failed = runQueriesAndBenchmark(
+                    benchmarkQueries,
+                    singleNodeWorkerConfiguration,
+                    config.benchmarkWarmupRepetitions.getValue(),
+                    config.benchmarkRepetitions.getValue(),
+                    benchmarkResults,
+                    progressTracker);
 
                 failedQueries.insert(failedQueries.end(), failed.begin(), failed.end());
                 std::cout << benchmarkResults.dump(4);
@@ -360,6 +367,22 @@ SystestExecutorResult SystestExecutor::executeSystests()
                 std::ofstream outputFile(outputPath);
                 outputFile << benchmarkResults.dump(4);
                 outputFile.close();
+
+                if (const auto baselinePath = config.benchmarkBaseline.getValue(); not baselinePath.empty())
+                {
+                    std::ifstream baselineFile(baselinePath);
+                    const auto baseline = nlohmann::json::parse(baselineFile, nullptr, false);
+                    if (baseline.is_discarded())
+                    {
+                        return {
+                            .returnType = SystestExecutorResult::ReturnType::FAILED,
+                            .outputMessage = fmt::format("Could not parse the benchmark baseline {}", baselinePath),
+                            .errorCode = ErrorCode::TestException};
+                    }
+                    std::cout << fmt::format("\nComparison with the baseline {}:\n", baselinePath);
+                    benchmarkRegressions
+                        = compareWithBaseline(benchmarkResults, baseline, config.benchmarkRegressionThreshold.getValue());
+                }
             }
             else
             {
@@ -393,6 +416,13 @@ SystestExecutorResult SystestExecutor::executeSystests()
                 .outputMessage = outputMessage.str(),
                 .errorCode = ErrorCode::QueryStatusFailed};
         }
+        if (not benchmarkRegressions.empty())
+        {
+            return {
+                .returnType = SystestExecutorResult::ReturnType::FAILED,
+                .outputMessage = fmt::format("The following queries regressed:\n- {}", fmt::join(benchmarkRegressions, "\n- ")),
+                .errorCode = ErrorCode::TestException};
+        }
         std::stringstream outputMessage;
         outputMessage << '\n' << "All queries passed.";
         return {.returnType = SystestExecutorResult::ReturnType::SUCCESS, .outputMessage = outputMessage.str()};
@@ -15,10 +15,12 @@
 #include <SystestResultCheck.hpp>
 
 #include <algorithm>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iterator>
 #include <optional>
 #include <ostream>
@@ -26,6 +28,8 @@
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <thread>
 #include <tuple>
 #include <unordered_set>
 #include <utility>
@@ -229,6 +233,9 @@ bool compareStringAsTypeWithError(const NES::DataType::Type type, const Expected
         case NES::DataType::Type::UINT16:
         case NES::DataType::Type::UINT32:
         case NES::DataType::Type::UINT64:
+        case NES::DataType::Type::TIMESTAMP:
+        case NES::DataType::Type::INTERVAL:
+        case NES::DataType::Type::DECIMAL:
         case NES::DataType::Type::BOOLEAN:
         case NES::DataType::Type::CHAR:
         case NES::DataType::Type::VARSIZED:
@@ -679,8 +686,280 @@ private:
     ActualResultTuples actualResults;
 };
 
+/// Results above this size are compared by fingerprints in bounded memory, instead of sorting both results in memory
+constexpr size_t STREAMING_COMPARISON_THRESHOLD_IN_BYTES = 64UL * 1024 * 1024;
+/// Every thread that fingerprints a result file reads at least this many bytes
+constexpr size_t MIN_FINGERPRINT_CHUNK_SIZE_IN_BYTES = 4UL * 1024 * 1024;
+
+/// Order-insensitive fingerprint of a multiset of tuples: two results with the same tuples, in any order, have the same fingerprint.
+/// Summing two differently mixed hashes per tuple keeps the fingerprint mergeable across chunks, while making accidental collisions of
+/// results with the same number of tuples unlikely.
+struct ResultFingerprint
+{
+    void add(const uint64_t tupleHash)
+    {
+        ++numberOfTuples;
+        sumOfHashes += tupleHash;
+        sumOfMixedHashes += mixHash(tupleHash ^ 0x9E3779B97F4A7C15UL);
+    }
+
+    void merge(const ResultFingerprint& other)
+    {
+        numberOfTuples += other.numberOfTuples;
+        sumOfHashes += other.sumOfHashes;
+        sumOfMixedHashes += other.sumOfMixedHashes;
+    }
+
+    /// Finalizer of MurmurHash3
+    static uint64_t mixHash(uint64_t hash)
+    {
+        hash ^= hash >> 33U;
+        hash *= 0xFF51AFD7ED558CCDUL;
+        hash ^= hash >> 33U;
+        hash *= 0xC4CEB9FE1A85EC53UL;
+        hash ^= hash >> 33U;
+        return hash;
+    }
+
+    bool operator==(const ResultFingerprint&) const = default;
+
+    uint64_t numberOfTuples = 0;
+    uint64_t sumOfHashes = 0;
+    uint64_t sumOfMixedHashes = 0;
+};
+
+/// A field of a result line that is part of its fingerprint
+struct FingerprintField
+{
+    size_t index;
+    NES::DataType::Type type;
+};
+
+/// Hashes the fields of a result line in the given order. Like ResultTuples, fields are separated by commas or spaces and empty fields
+/// are NULL. Floating point fields are hashed by their value, so that their formatting does not matter.
+uint64_t
+hashTuple(const std::string_view line, const std::vector<FingerprintField>& fingerprintFields, std::vector<std::string_view>& fields)
+{
+    fields.clear();
+    for (const auto commaSeparated : std::views::split(line, ','))
+    {
+        if (commaSeparated.empty())
+        {
+            fields.emplace_back("NULL");
+            continue;
+        }
+        for (const auto field : std::views::split(std::string_view(commaSeparated.begin(), commaSeparated.end()), ' '))
+        {
+            if (not field.empty())
+            {
+                fields.emplace_back(field.begin(), field.end());
+            }
+        }
+    }
+
+    uint64_t hash = fingerprintFields.size();
+    for (const auto& [index, type] : fingerprintFields)
+    {
+        /// A missing field hashes differently than every present field, thus the tuple mismatches
+        const auto field = index < fields.size() ? fields[index] : std::string_view{};
+        uint64_t fieldHash = std::hash<std::string_view>{}(field);
+        if (type == NES::DataType::Type::FLOAT32 or type == NES::DataType::Type::FLOAT64)
+        {
+            if (const auto value = NES::from_chars<double>(field))
+            {
+                /// Adding zero turns negative zero into positive zero
+                fieldHash = std::bit_cast<uint64_t>(*value + 0.0);
+            }
+        }
+        hash = ResultFingerprint::mixHash(hash + fieldHash);
+    }
+    return hash;
+}
+
+/// A result file that is read in chunks, without loading it into memory
+struct StreamedResultFile
+{
+    std::filesystem::path path;
+    NES::Schema schema;
+    /// Offset of the first tuple, i.e., the end of the schema line
+    size_t dataStart = 0;
+    size_t fileSize = 0;
+};
+
+bool exceedsStreamingComparisonThreshold(const std::filesystem::path& resultFilePath)
+{
+    std::error_code errorCode;
+    const auto fileSize = std::filesystem::file_size(resultFilePath, errorCode);
+    return not errorCode and fileSize > STREAMING_COMPARISON_THRESHOLD_IN_BYTES;
+}
+
+std::optional<StreamedResultFile> openStreamedResultFile(const std::filesystem::path& resultFilePath)
+{
+    NES_DEBUG("Streaming query result from: {}", resultFilePath);
+    std::ifstream resultFile(resultFilePath, std::ios::binary);
+    std::error_code errorCode;
+    const auto fileSize = std::filesystem::file_size(resultFilePath, errorCode);
+    if (not resultFile or errorCode)
+    {
+        NES_ERROR("Failed to open result file: {}", resultFilePath);
+        return std::nullopt;
+    }
+
+    std::string schemaLine;
+    const auto isNotEmpty = std::getline(resultFile, schemaLine) ? true : false;
+    INVARIANT(isNotEmpty, "Result file is empty: {}", resultFilePath);
+    return StreamedResultFile{
+        .path = resultFilePath,
+        .schema = parseFieldNames(schemaLine),
+        .dataStart = std::min(schemaLine.size() + 1, fileSize),
+        .fileSize = fileSize};
+}
+
+/// Fingerprints all lines that start within [chunkStart, chunkEnd). The chunk must start after the schema line.
+ResultFingerprint fingerprintChunk(
+    const std::filesystem::path& resultFilePath,
+    const size_t chunkStart,
+    const size_t chunkEnd,
+    const std::vector<FingerprintField>& fingerprintFields)
+{
+    std::ifstream resultFile(resultFilePath, std::ios::binary);
+    /// Skipping to the end of the line that contains the byte before the chunk, moves to the first line that starts within the chunk
+    resultFile.seekg(static_cast<std::streamoff>(chunkStart - 1));
+    std::string line;
+    std::getline(resultFile, line);
+    size_t lineStart = chunkStart + line.size();
+
+    ResultFingerprint fingerprint;
+    std::vector<std::string_view> fields;
+    while (lineStart < chunkEnd and std::getline(resultFile, line))
+    {
+        lineStart += line.size() + 1;
+        fingerprint.add(hashTuple(line, fingerprintFields, fields));
+    }
+    return fingerprint;
+}
+
+/// Splits the tuples of the file into one chunk per thread and fingerprints the chunks in parallel
+ResultFingerprint fingerprintResultFile(const StreamedResultFile& resultFile, const std::vector<FingerprintField>& fingerprintFields)
+{
+    const auto dataSize = resultFile.fileSize - resultFile.dataStart;
+    const auto numberOfChunks = std::clamp<size_t>(
+        dataSize / MIN_FINGERPRINT_CHUNK_SIZE_IN_BYTES, 1, std::max(1U, std::thread::hardware_concurrency()));
+    std::vector<ResultFingerprint> chunkFingerprints(numberOfChunks);
+    {
+        std::vector<std::jthread> threads;
+        for (size_t chunk = 0; chunk < numberOfChunks; ++chunk)
+        {
+            threads.emplace_back(
+                [&, chunk]
+                {
+                    const auto chunkStart = resultFile.dataStart + (dataSize * chunk / numberOfChunks);
+                    const auto chunkEnd = resultFile.dataStart + (dataSize * (chunk + 1) / numberOfChunks);
+                    chunkFingerprints[chunk] = fingerprintChunk(resultFile.path, chunkStart, chunkEnd, fingerprintFields);
+                });
+        }
+    }
+
+    ResultFingerprint fingerprint;
+    for (const auto& chunkFingerprint : chunkFingerprints)
+    {
+        fingerprint.merge(chunkFingerprint);
+    }
+    return fingerprint;
+}
+
+/// Only the fields that exist in both schemas are part of the fingerprints, in the order of the expected schema
+std::pair<std::vector<FingerprintField>, std::vector<FingerprintField>>
+getFingerprintFields(const ExpectedToActualFieldMap& expectedToActualFieldMap)
+{
+    std::vector<FingerprintField> expectedFields;
+    std::vector<FingerprintField> actualFields;
+    for (const auto& [expectedIdx, typeActualPair] : expectedToActualFieldMap.expectedToActualFieldMap | NES::views::enumerate)
+    {
+        if (typeActualPair.actualIndex.has_value())
+        {
+            expectedFields.push_back({.index = static_cast<size_t>(expectedIdx), .type = typeActualPair.type.type});
+            actualFields.push_back({.index = typeActualPair.actualIndex.value(), .type = typeActualPair.type.type});
+        }
+    }
+    return {std::move(expectedFields), std::move(actualFields)};
+}
+
+/// In contrast to compareResults, fingerprints only tell whether the results differ, but not in which tuples
+ResultErrorStream compareFingerprints(const ResultFingerprint& expected, const ResultFingerprint& actual)
+{
+    ResultErrorStream resultErrorStream{std::stringstream{}};
+    if (expected != actual)
+    {
+        resultErrorStream << fmt::format(
+            "\nThe results exceed {} MiB and were compared by fingerprints of their tuples."
+            "\n{} tuples (fingerprint {:016x}{:016x}) | {} tuples (fingerprint {:016x}{:016x})",
+            STREAMING_COMPARISON_THRESHOLD_IN_BYTES / (1024 * 1024),
+            expected.numberOfTuples,
+            expected.sumOfHashes,
+            expected.sumOfMixedHashes,
+            actual.numberOfTuples,
+            actual.sumOfHashes,
+            actual.sumOfMixedHashes);
+    }
+    return resultErrorStream;
+}
+
+/// Compares the expected tuples of the query with its (large) result file, without loading the result file into memory
+QueryCheckResult checkQueryInBoundedMemory(const NES::Systest::RunningQuery& runningQuery)
+{
+    const auto resultFile = openStreamedResultFile(runningQuery.systestQuery.resultFile());
+    if (not resultFile.has_value())
+    {
+        return QueryCheckResult{fmt::format("Failed to load query result for query: {}", runningQuery.systestQuery.queryDefinition)};
+    }
+    const auto expectedToActualFieldMap = compareSchemas(
+        ExpectedResultSchema(runningQuery.systestQuery.planInfoOrException.value().sinkOutputSchema),
+        ActualResultSchema(resultFile->schema));
+    const auto [expectedFields, actualFields] = getFingerprintFields(expectedToActualFieldMap);
+
+    const auto& expectedQueryResult = runningQuery.systestQuery.expectedResultsOrExpectedError;
+    INVARIANT(std::holds_alternative<std::vector<std::string>>(expectedQueryResult), "Systest was expected to have an expected result");
+    ResultFingerprint expectedFingerprint;
+    std::vector<std::string_view> fields;
+    for (const auto& line : std::get<std::vector<std::string>>(expectedQueryResult))
+    {
+        expectedFingerprint.add(hashTuple(line, expectedFields, fields));
+    }
+    return QueryCheckResult{
+        expectedToActualFieldMap.schemaErrorStream,
+        compareFingerprints(expectedFingerprint, fingerprintResultFile(*resultFile, actualFields))};
+}
+
+/// Compares the result files of both differential queries, without loading them into memory
+QueryCheckResult checkDifferentialQueryInBoundedMemory(const NES::Systest::RunningQuery& runningQuery)
+{
+    const auto result1 = openStreamedResultFile(runningQuery.systestQuery.resultFile());
+    if (not result1 or result1->schema.getNumberOfFields() == 0)
+    {
+        return QueryCheckResult{fmt::format("Failed to load first result file or its schema: {}", runningQuery.systestQuery.resultFile())};
+    }
+    const auto result2 = openStreamedResultFile(runningQuery.systestQuery.resultFileForDifferentialQuery());
+    if (not result2 or result2->schema.getNumberOfFields() == 0)
+    {
+        return QueryCheckResult{fmt::format(
+            "Failed to load second result file or its schema: {}", runningQuery.systestQuery.resultFileForDifferentialQuery())};
+    }
+
+    const auto expectedToActualFieldMap = compareSchemas(ExpectedResultSchema(result1->schema), ActualResultSchema(result2->schema));
+    const auto [fields1, fields2] = getFingerprintFields(expectedToActualFieldMap);
+    return QueryCheckResult{
+        expectedToActualFieldMap.schemaErrorStream,
+        compareFingerprints(fingerprintResultFile(*result1, fields1), fingerprintResultFile(*result2, fields2))};
+}
+
 QueryCheckResult checkQuery(const NES::Systest::RunningQuery& runningQuery)
 {
+    if (exceedsStreamingComparisonThreshold(runningQuery.systestQuery.resultFile()))
+    {
+        return checkQueryInBoundedMemory(runningQuery);
+    }
+
     /// Get result for running query
     const auto queryResult = loadQueryResult(runningQuery.systestQuery);
     if (not queryResult.has_value())
@@ -740,7 +1019,13 @@ std::optional<std::string> checkResult(const RunningQuery& runningQuery)
 
     QueryCheckResult checkQueryResult{""};
 
-    if (runningQuery.systestQuery.differentialQueryPlan.has_value())
+    if (runningQuery.systestQuery.differentialQueryPlan.has_value()
+        and (exceedsStreamingComparisonThreshold(runningQuery.systestQuery.resultFile())
+             or exceedsStreamingComparisonThreshold(runningQuery.systestQuery.resultFileForDifferentialQuery())))
+    {
+        checkQueryResult = checkDifferentialQueryInBoundedMemory(runningQuery);
+    }
+    else if (runningQuery.systestQuery.differentialQueryPlan.has_value())
     {
         const auto result1 = loadQueryResult(runningQuery.systestQuery.resultFile());
         const auto result2 = loadQueryResult(runningQuery.systestQuery.resultFileForDifferentialQuery());
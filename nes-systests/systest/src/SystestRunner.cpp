@@ -18,27 +18,33 @@
 #include <atomic>
 #include <cerrno>
 #include <chrono>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <exception>
 #include <expected> /// NOLINT(misc-include-cleaner)
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <ostream>
 #include <queue>
 #include <ranges>
 #include <regex>
+#include <stop_token>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <variant>
 #include <vector>
 #include <Identifiers/Identifiers.hpp>
 #include <Identifiers/NESStrongType.hpp>
+#include <Listeners/QueryLog.hpp>
 #include <QueryManager/EmbeddedWorkerQuerySubmissionBackend.hpp>
 #include <QueryManager/GRPCQuerySubmissionBackend.hpp>
 #include <QueryManager/QueryManager.hpp>
@@ -49,7 +55,9 @@
 #include <fmt/format.h>
 #include <nlohmann/json.hpp> ///NOLINT(misc-include-cleaner)
 #include <ErrorHandling.hpp>
+#include <PipelineMetricsListener.hpp>
 #include <QuerySubmitter.hpp>
+#include <SingleNodeWorker.hpp>
 #include <SingleNodeWorkerConfiguration.hpp>
 #include <SystestResultCheck.hpp>
 #include <SystestState.hpp>
@@ -113,6 +121,102 @@ void processQueryWithError(
         performanceMessageBuilder);
 }
 
+/// Returns the error message of a query that the worker completed, or an empty string if its result is correct
+std::string checkCompletedQuery(const RunningQuery& runningQuery)
+{
+    if (std::holds_alternative<ExpectedError>(runningQuery.systestQuery.expectedResultsOrExpectedError))
+    {
+        return fmt::format(
+            "expected error {} but query succeeded",
+            std::get<ExpectedError>(runningQuery.systestQuery.expectedResultsOrExpectedError).code);
+    }
+    if (auto err = checkResult(runningQuery))
+    {
+        return *err;
+    }
+    return std::string{};
+}
+
+/// Compares the results of completed queries on a pool of threads, so that the runner keeps the worker busy with the next queries while
+/// it reads and sorts the result files. The runner reports the queries in the order in which their checks complete.
+class ResultCheckPool
+{
+public:
+    struct CheckedQuery
+    {
+        std::shared_ptr<RunningQuery> runningQuery;
+        std::string errorMessage;
+        /// A check that throws is rethrown by the runner, as if it had checked the query itself
+        std::exception_ptr exception;
+    };
+
+    explicit ResultCheckPool(const size_t numberOfThreads)
+    {
+        for (size_t thread = 0; thread < numberOfThreads; ++thread)
+        {
+            threads.emplace_back([this](const std::stop_token& stopToken) { checkQueries(stopToken); });
+        }
+    }
+
+    void submit(std::shared_ptr<RunningQuery> runningQuery)
+    {
+        {
+            const std::scoped_lock lock(mutex);
+            uncheckedQueries.push(std::move(runningQuery));
+            ++numberOfPendingChecks;
+        }
+        checkAvailable.notify_one();
+    }
+
+    /// Returns the queries whose check completed since the last call
+    std::vector<CheckedQuery> takeCheckedQueries()
+    {
+        const std::scoped_lock lock(mutex);
+        return std::exchange(checkedQueries, {});
+    }
+
+    /// Blocks until all submitted queries are checked and returns the queries whose check completed since the last call
+    std::vector<CheckedQuery> waitForCheckedQueries()
+    {
+        std::unique_lock lock(mutex);
+        checkCompleted.wait(lock, [this] { return numberOfPendingChecks == 0; });
+        return std::exchange(checkedQueries, {});
+    }
+
+private:
+    void checkQueries(const std::stop_token& stopToken)
+    {
+        std::unique_lock lock(mutex);
+        while (checkAvailable.wait(lock, stopToken, [this] { return not uncheckedQueries.empty(); }))
+        {
+            CheckedQuery checkedQuery{.runningQuery = std::move(uncheckedQueries.front()), .errorMessage = {}, .exception = nullptr};
+            uncheckedQueries.pop();
+            lock.unlock();
+            try
+            {
+                checkedQuery.errorMessage = checkCompletedQuery(*checkedQuery.runningQuery);
+            }
+            catch (...)
+            {
+                checkedQuery.exception = std::current_exception();
+            }
+            lock.lock();
+            checkedQueries.push_back(std::move(checkedQuery));
+            --numberOfPendingChecks;
+            checkCompleted.notify_all();
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable_any checkAvailable;
+    std::condition_variable checkCompleted;
+    std::queue<std::shared_ptr<RunningQuery>> uncheckedQueries;
+    std::vector<CheckedQuery> checkedQueries;
+    size_t numberOfPendingChecks = 0;
+    /// Declared last, so that the threads stop before the state they access is destroyed
+    std::vector<std::jthread> threads;
+};
+
 }
 
 /// NOLINTBEGIN(readability-function-cognitive-complexity)
@@ -133,6 +237,20 @@ std::vector<RunningQuery> runQueries(
     std::unordered_map<QueryId, LocalQueryStatus> finishedDifferentialQueries;
     std::vector<std::shared_ptr<RunningQuery>> failed;
 
+    /// With a single concurrent query, a single thread checks the queries in the order of the test files
+    ResultCheckPool resultCheckPool(std::clamp<uint64_t>(numConcurrentQueries, 1, std::max(1U, std::thread::hardware_concurrency())));
+    const auto reportCheckedQueries = [&](std::vector<ResultCheckPool::CheckedQuery> checkedQueries)
+    {
+        for (auto& [runningQuery, errorMessage, exception] : checkedQueries)
+        {
+            if (exception)
+            {
+                std::rethrow_exception(exception);
+            }
+            reportResult(runningQuery, progressTracker, failed, [&] { return std::move(errorMessage); }, queryPerformanceMessage);
+        }
+    };
+
     const auto startMoreQueries = [&] -> bool
     {
         bool hasOneMoreQueryToStart = false;
@@ -231,25 +349,7 @@ std::vector<RunningQuery> runQueries(
                         otherRunningQueryIt->second->queryStatus = otherSummaryIt->second;
                     }
 
-                    reportResult(
-                        runningQuery,
-                        progressTracker,
-                        failed,
-                        [&]
-                        {
-                            if (std::holds_alternative<ExpectedError>(runningQuery->systestQuery.expectedResultsOrExpectedError))
-                            {
-                                return fmt::format(
-                                    "expected error {} but query succeeded",
-                                    std::get<ExpectedError>(runningQuery->systestQuery.expectedResultsOrExpectedError).code);
-                            }
-                            if (auto err = checkResult(*runningQuery))
-                            {
-                                return *err;
-                            }
-                            return std::string{};
-                        },
-                        queryPerformanceMessage);
+                    resultCheckPool.submit(runningQuery);
 
                     if (otherRunningQueryIt != active.end())
                     {
@@ -263,29 +363,13 @@ std::vector<RunningQuery> runQueries(
                 continue;
             }
 
-            /// Regular query (not differential), process immediately
-            reportResult(
-                runningQuery,
-                progressTracker,
-                failed,
-                [&]
-                {
-                    if (std::holds_alternative<ExpectedError>(runningQuery->systestQuery.expectedResultsOrExpectedError))
-                    {
-                        return fmt::format(
-                            "expected error {} but query succeeded",
-                            std::get<ExpectedError>(runningQuery->systestQuery.expectedResultsOrExpectedError).code);
-                    }
-                    if (auto err = checkResult(*runningQuery))
-                    {
-                        return *err;
-                    }
-                    return std::string{};
-                },
-                queryPerformanceMessage);
+            /// Regular query (not differential), check immediately
+            resultCheckPool.submit(runningQuery);
             active.erase(it);
         }
+        reportCheckedQueries(resultCheckPool.takeCheckedQueries());
     }
+    reportCheckedQueries(resultCheckPool.waitForCheckedQueries());
 
     auto failedViews = failed | std::views::filter(std::not_fn(passes)) | std::views::transform([](auto& p) { return *p; });
     return {failedViews.begin(), failedViews.end()};
@@ -295,37 +379,192 @@ std::vector<RunningQuery> runQueries(
 
 namespace
 {
-std::vector<RunningQuery> serializeExecutionResults(const std::vector<RunningQuery>& queries, nlohmann::json& resultJson)
+/// The measurements of a single run of a benchmarked query
+struct BenchmarkRun
 {
-    std::vector<RunningQuery> failedQueries;
-    for (const auto& queryRan : queries)
+    RunningQuery query;
+    std::optional<std::chrono::duration<double>> timeToFirstResult;
+    size_t peakBuffersInUse = 0;
+};
+
+/// Neither the buffers in use nor the time of the first result are part of the query status, thus a thread samples them while the query
+/// runs. The resolution of the time to the first result is the sampling interval.
+struct WorkerSamples
+{
+    std::optional<std::chrono::system_clock::time_point> firstResult;
+    size_t peakBuffersInUse = 0;
+};
+
+constexpr std::chrono::milliseconds BENCHMARK_SAMPLING_INTERVAL{1};
+
+void sampleWorker(
+    const std::stop_token& stopToken,
+    const SingleNodeWorker& worker,
+    const QueryId queryId,
+    const size_t buffersInUseBeforeStart,
+    WorkerSamples& samples)
+{
+    while (not stopToken.stop_requested())
+    {
+        const auto buffersInUse = worker.getNumberOfBuffersInUse();
+        samples.peakBuffersInUse = std::max(samples.peakBuffersInUse, buffersInUse - std::min(buffersInUse, buffersInUseBeforeStart));
+        if (not samples.firstResult.has_value())
+        {
+            /// A sink pipeline is only flagged as sink, once it completed its first buffer
+            if (const auto metrics = worker.getQueryMetrics(queryId);
+                metrics.has_value() and std::ranges::any_of(metrics.value(), &PipelineMetrics::isSink))
+            {
+                samples.firstResult = std::chrono::system_clock::now();
+            }
+        }
+        std::this_thread::sleep_for(BENCHMARK_SAMPLING_INTERVAL);
+    }
+}
+
+/// Registers, runs, and unregisters the query, while sampling the worker.
+/// @return nullopt if the query could not be registered
+std::optional<BenchmarkRun> runBenchmarkedQuery(QuerySubmitter& submitter, const SingleNodeWorker& worker, const SystestQuery& queryToRun)
+{
+    const auto registrationResult = submitter.registerQuery(queryToRun.planInfoOrException.value().queryPlan);
+    if (not registrationResult.has_value())
+    {
+        return std::nullopt;
+    }
+    const auto queryId = registrationResult.value();
+
+    WorkerSamples samples;
+    LocalQueryStatus summary;
+    {
+        const auto buffersInUseBeforeStart = worker.getNumberOfBuffersInUse();
+        const std::jthread sampler([&](const std::stop_token& stopToken)
+                                   { sampleWorker(stopToken, worker, queryId, buffersInUseBeforeStart, samples); });
+        submitter.startQuery(queryId);
+        summary = submitter.finishedQueries().at(0);
+    }
+
+    BenchmarkRun run{
+        .query = RunningQuery(queryToRun, queryId), .timeToFirstResult = std::nullopt, .peakBuffersInUse = samples.peakBuffersInUse};
+    run.query.queryStatus = summary;
+    const auto& running = summary.metrics.running;
+    const auto& stop = summary.metrics.stop;
+    if (samples.firstResult.has_value() and running.has_value() and stop.has_value())
+    {
+        /// A short query might stop before the first sample, which sees the result
+        const auto timeToFirstResult = std::clamp(samples.firstResult.value(), running.value(), stop.value()) - running.value();
+        run.timeToFirstResult = std::chrono::duration_cast<std::chrono::duration<double>>(timeToFirstResult);
+    }
+    submitter.unregisterQuery(queryId);
+    return run;
+}
+
+/// Getting the size and no. tuples of all input files to pass this information to RunningQuery::bytesProcessed
+std::pair<size_t, size_t> getSizeOfSources(const SystestQuery& query)
+{
+    size_t bytesProcessed = 0;
+    size_t tuplesProcessed = 0;
+    for (const auto& [sourcePath, sourceOccurrencesInQuery] :
+         query.planInfoOrException.value().sourcesToFilePathsAndCounts | std::views::values)
     {
-        if (!queryRan.passed)
+        if (not(std::filesystem::exists(sourcePath.getRawValue()) and sourcePath.getRawValue().has_filename()))
         {
-            failedQueries.emplace_back(queryRan);
+            NES_ERROR("Source path is empty or does not exist.");
+            return {0, 0};
         }
-        const auto executionTimeInSeconds = queryRan.getElapsedTime().count();
-        resultJson.push_back({
-            {"query name", queryRan.systestQuery.testName},
+
+        bytesProcessed += (std::filesystem::file_size(sourcePath.getRawValue()) * sourceOccurrencesInQuery);
+
+        /// Counting the lines, i.e., \n in the sourcePath
+        std::ifstream inFile(sourcePath.getRawValue());
+        tuplesProcessed += std::count(std::istreambuf_iterator(inFile), std::istreambuf_iterator<char>(), '\n') * sourceOccurrencesInQuery;
+    }
+    return {bytesProcessed, tuplesProcessed};
+}
+
+nlohmann::json summarize(std::vector<double> measurements)
+{
+    if (measurements.empty())
+    {
+        return nullptr;
+    }
+    std::ranges::sort(measurements);
+    const auto middle = measurements.size() / 2;
+    const auto median = measurements.size() % 2 == 0 ? (measurements[middle - 1] + measurements[middle]) / 2 : measurements[middle];
+    return {{"median", median}, {"min", measurements.front()}, {"max", measurements.back()}};
+}
+
+/// Serializes the median of the measured runs under the keys of a single run, followed by the statistics and the runs themselves
+void serializeBenchmarkRuns(const std::vector<BenchmarkRun>& runs, const uint64_t warmupRepetitions, nlohmann::json& resultJson)
+{
+    const auto& query = runs.front().query;
+    const auto bytesProcessed = query.bytesProcessed.has_value() ? static_cast<double>(query.bytesProcessed.value()) : NAN;
+    const auto tuplesProcessed = query.tuplesProcessed.has_value() ? static_cast<double>(query.tuplesProcessed.value()) : NAN;
+
+    std::vector<double> executionTimes;
+    std::vector<double> bytesPerSecond;
+    std::vector<double> tuplesPerSecond;
+    std::vector<double> timesToFirstResult;
+    std::vector<double> peakBuffersInUse;
+    auto runsJson = nlohmann::json::array();
+    for (const auto& run : runs)
+    {
+        const auto executionTimeInSeconds = run.query.getElapsedTime().count();
+        executionTimes.push_back(executionTimeInSeconds);
+        bytesPerSecond.push_back(bytesProcessed / executionTimeInSeconds);
+        tuplesPerSecond.push_back(tuplesProcessed / executionTimeInSeconds);
+        peakBuffersInUse.push_back(static_cast<double>(run.peakBuffersInUse));
+        nlohmann::json runJson{
             {"time", executionTimeInSeconds},
-            {"bytesPerSecond", static_cast<double>(queryRan.bytesProcessed.value_or(NAN)) / executionTimeInSeconds},
-            {"tuplesPerSecond", static_cast<double>(queryRan.tuplesProcessed.value_or(NAN)) / executionTimeInSeconds},
-        });
+            {"bytesPerSecond", bytesPerSecond.back()},
+            {"tuplesPerSecond", tuplesPerSecond.back()},
+            {"timeToFirstResult", nullptr},
+            {"peakBuffersInUse", run.peakBuffersInUse}};
+        if (run.timeToFirstResult.has_value())
+        {
+            timesToFirstResult.push_back(run.timeToFirstResult->count());
+            runJson["timeToFirstResult"] = timesToFirstResult.back();
+        }
+        runsJson.push_back(std::move(runJson));
     }
-    return failedQueries;
+
+    const auto statistics = nlohmann::json{
+        {"time", summarize(executionTimes)},
+        {"bytesPerSecond", summarize(bytesPerSecond)},
+        {"tuplesPerSecond", summarize(tuplesPerSecond)},
+        {"timeToFirstResult", summarize(timesToFirstResult)},
+        {"peakBuffersInUse", summarize(peakBuffersInUse)}};
+    const auto medianOf = [&statistics](const std::string& measurement)
+    { return statistics[measurement].is_null() ? nlohmann::json(nullptr) : statistics[measurement]["median"]; };
+    resultJson.push_back({
+        {"query name", query.systestQuery.testName},
+        {"query number", query.systestQuery.queryIdInFile.getRawValue()},
+        {"time", medianOf("time")},
+        {"bytesPerSecond", medianOf("bytesPerSecond")},
+        {"tuplesPerSecond", medianOf("tuplesPerSecond")},
+        {"timeToFirstResult", medianOf("timeToFirstResult")},
+        {"peakBuffersInUse", std::ranges::max(peakBuffersInUse)},
+        {"warmupRepetitions", warmupRepetitions},
+        {"repetitions", runs.size()},
+        {"statistics", statistics},
+        {"runs", std::move(runsJson)},
+    });
 }
 }
 
 std::vector<RunningQuery> runQueriesAndBenchmark(
     const std::vector<SystestQuery>& queries,
     const SingleNodeWorkerConfiguration& configuration,
+    const uint64_t warmupRepetitions,
+    const uint64_t repetitions,
     nlohmann::json& resultJson,
     SystestProgressTracker& progressTracker)
 {
-    auto worker = std::make_unique<QueryManager>(std::make_unique<EmbeddedWorkerQuerySubmissionBackend>(
-        WorkerConfig{.grpc = GrpcAddr("localhost:8080"), .config = {}}, configuration));
-    QuerySubmitter submitter(std::move(worker));
-    std::vector<std::shared_ptr<RunningQuery>> ranQueries;
+    PRECONDITION(repetitions > 0, "Benchmarking requires at least one measured run of each query");
+    auto backend = std::make_unique<EmbeddedWorkerQuerySubmissionBackend>(
+        WorkerConfig{.grpc = GrpcAddr("localhost:8080"), .config = {}}, configuration);
+    /// The submitter owns the backend, which outlives the runs that sample its worker
+    const auto& worker = backend->getWorker();
+    QuerySubmitter submitter(std::make_unique<QueryManager>(std::move(backend)));
+    std::vector<RunningQuery> failedQueries;
     progressTracker.reset();
     progressTracker.setTotalQueries(queries.size());
     for (const auto& queryToRun : queries)
@@ -335,76 +574,131 @@ std::vector<RunningQuery> runQueriesAndBenchmark(
             NES_ERROR("skip failing query: {}", queryToRun.testName);
             continue;
         }
+        const auto [bytesProcessed, tuplesProcessed] = getSizeOfSources(queryToRun);
 
-        const auto registrationResult = submitter.registerQuery(queryToRun.planInfoOrException.value().queryPlan);
-        if (not registrationResult.has_value())
+        std::vector<BenchmarkRun> measuredRuns;
+        std::optional<BenchmarkRun> failedRun;
+        bool registrationFailed = false;
+        for (uint64_t repetition = 0; repetition < warmupRepetitions + repetitions; ++repetition)
         {
-            NES_ERROR("skip failing query: {}", queryToRun.testName);
-            continue;
-        }
-        auto queryId = registrationResult.value();
-
-        auto runningQueryPtr = std::make_shared<RunningQuery>(queryToRun, queryId);
-        runningQueryPtr->passed = false;
-        ranQueries.emplace_back(runningQueryPtr);
-        submitter.startQuery(queryId);
-        const auto summary = submitter.finishedQueries().at(0);
-
-        if (summary.state == QueryState::Failed)
-        {
-            if (summary.metrics.error.has_value())
+            auto run = runBenchmarkedQuery(submitter, worker, queryToRun);
+            if (not run.has_value())
             {
-                NES_ERROR("Query {} has failed with: {}", queryId, summary.metrics.error->what());
+                registrationFailed = true;
+                break;
             }
-            else
+            if (const auto& summary = run->query.queryStatus; summary.state != QueryState::Stopped)
+            {
+                if (summary.state != QueryState::Failed)
+                {
+                    NES_ERROR("Query {} terminated in unexpected state {}", summary.queryId, summary.state);
+                }
+                else if (summary.metrics.error.has_value())
+                {
+                    NES_ERROR("Query {} has failed with: {}", summary.queryId, summary.metrics.error->what());
+                }
+                else
+                {
+                    NES_ERROR("Query {} has failed without additional error details.", summary.queryId);
+                }
+                failedRun = std::move(run);
+                break;
+            }
+            run->query.bytesProcessed = bytesProcessed;
+            run->query.tuplesProcessed = tuplesProcessed;
+            if (repetition >= warmupRepetitions)
             {
-                NES_ERROR("Query {} has failed without additional error details.", queryId);
+                measuredRuns.push_back(std::move(run).value());
             }
+        }
+        if (registrationFailed)
+        {
+            NES_ERROR("skip failing query: {}", queryToRun.testName);
             continue;
         }
-
-        if (summary.state != QueryState::Stopped)
+        if (failedRun.has_value())
         {
-            NES_ERROR("Query {} terminated in unexpected state {}", queryId, summary.state);
+            failedQueries.push_back(failedRun->query);
             continue;
         }
 
-        runningQueryPtr->queryStatus = summary;
-
-        /// Getting the size and no. tuples of all input files to pass this information to currentRunningQuery.bytesProcessed
-        size_t bytesProcessed = 0;
-        size_t tuplesProcessed = 0;
-        for (const auto& [sourcePath, sourceOccurrencesInQuery] :
-             queryToRun.planInfoOrException.value().sourcesToFilePathsAndCounts | std::views::values)
+        /// Every run overwrites the results of the previous run, thus the check covers the last run
+        auto& lastRun = measuredRuns.back().query;
+        const auto errorMessage = checkResult(lastRun);
+        lastRun.passed = not errorMessage.has_value();
+        serializeBenchmarkRuns(measuredRuns, warmupRepetitions, resultJson);
+        const auto medianTime = std::chrono::duration<double>(resultJson.back()["time"].get<double>());
+        const auto queryPerformanceMessage = fmt::format(
+            " in {} ({}), median of {} runs: {}", lastRun.getElapsedTime(), lastRun.getThroughput(), measuredRuns.size(), medianTime);
+        progressTracker.incrementQueryCounter();
+        printQueryResultToStdOut(lastRun, errorMessage.value_or(""), progressTracker, queryPerformanceMessage);
+        if (not lastRun.passed)
         {
-            if (not(std::filesystem::exists(sourcePath.getRawValue()) and sourcePath.getRawValue().has_filename()))
-            {
-                NES_ERROR("Source path is empty or does not exist.");
-                bytesProcessed = 0;
-                tuplesProcessed = 0;
-                break;
-            }
-
-            bytesProcessed += (std::filesystem::file_size(sourcePath.getRawValue()) * sourceOccurrencesInQuery);
+            failedQueries.push_back(lastRun);
+        }
+    }
+    return failedQueries;
+}
 
-            /// Counting the lines, i.e., \n in the sourcePath
-            std::ifstream inFile(sourcePath.getRawValue());
-            tuplesProcessed
-                += std::count(std::istreambuf_iterator(inFile), std::istreambuf_iterator<char>(), '\n') * sourceOccurrencesInQuery;
+std::vector<std::string>
+compareWithBaseline(const nlohmann::json& resultJson, const nlohmann::json& baselineJson, const double regressionThresholdInPercent)
+{
+    if (not baselineJson.is_array())
+    {
+        throw TestException("The benchmark baseline must be a list of benchmark results");
+    }
+    /// The queries of a test file share the name, thus the number of the query in its file identifies it
+    const auto getQueryAndTime = [](const nlohmann::json& result) -> std::optional<std::pair<std::string, double>>
+    {
+        if (not result.is_object() or not result.contains("query name") or not result.contains("query number")
+            or not result.contains("time") or not result["time"].is_number())
+        {
+            return std::nullopt;
         }
-        ranQueries.back()->bytesProcessed = bytesProcessed;
-        ranQueries.back()->tuplesProcessed = tuplesProcessed;
+        return std::pair{
+            fmt::format("{}:{}", result["query name"].get<std::string>(), result["query number"].get<uint64_t>()),
+            result["time"].get<double>()};
+    };
 
-        auto errorMessage = checkResult(*ranQueries.back());
-        ranQueries.back()->passed = not errorMessage.has_value();
-        const auto queryPerformanceMessage
-            = fmt::format(" in {} ({})", ranQueries.back()->getElapsedTime(), ranQueries.back()->getThroughput());
-        progressTracker.incrementQueryCounter();
-        printQueryResultToStdOut(*ranQueries.back(), errorMessage.value_or(""), progressTracker, queryPerformanceMessage);
+    std::unordered_map<std::string, double> baselineTimes;
+    for (const auto& baselineResult : baselineJson)
+    {
+        if (auto queryAndTime = getQueryAndTime(baselineResult))
+        {
+            baselineTimes.insert(std::move(queryAndTime).value());
+        }
     }
 
-    return serializeExecutionResults(
-        ranQueries | std::views::transform([](const auto& query) { return *query; }) | std::ranges::to<std::vector>(), resultJson);
+    std::vector<std::string> regressions;
+    for (const auto& result : resultJson)
+    {
+        const auto queryAndTime = getQueryAndTime(result);
+        if (not queryAndTime.has_value())
+        {
+            continue;
+        }
+        const auto& [query, time] = queryAndTime.value();
+        const auto baselineTime = baselineTimes.find(query);
+        if (baselineTime == baselineTimes.end() or baselineTime->second <= 0)
+        {
+            std::cout << fmt::format("{}: {:.6f}s (no baseline)\n", query, time);
+            continue;
+        }
+        const auto changeInPercent = ((time / baselineTime->second) - 1) * 100;
+        const auto isRegression = changeInPercent > regressionThresholdInPercent;
+        std::cout << fmt::format(
+            "{}: {:.6f}s (baseline {:.6f}s, {:+.1f}%){}\n",
+            query,
+            time,
+            baselineTime->second,
+            changeInPercent,
+            isRegression ? " REGRESSED" : "");
+        if (isRegression)
+        {
+            regressions.push_back(fmt::format("{} is {:.1f}% slower than the baseline", query, changeInPercent));
+        }
+    }
+    return regressions;
 }
 
 void printQueryResultToStdOut(
@@ -98,6 +98,16 @@ NES::SystestConfiguration parseConfiguration(int argc, const char** argv)
         .help("Benchmark (time) all specified queries and store results into 'BenchmarkResults.json' in the result directory")
         .default_value(false)
         .implicit_value(true);
+    program.add_argument("--repetitions")
+        .help("number of measured runs of each benchmarked query. The results report the median, minimum, and maximum. Default: 1")
+        .scan<'i', int>();
+    program.add_argument("--warmup")
+        .help("number of discarded runs before the measured runs of each benchmarked query. Default: 0")
+        .scan<'i', int>();
+    program.add_argument("--baseline").help("compare the benchmark against the 'BenchmarkResults.json' of a previous run");
+    program.add_argument("--regression-threshold")
+        .help("slowdown of the median execution time of a query in percent, which fails the comparison with the baseline. Default: 10")
+        .scan<'g', float>();
 
     try
     {
@@ -130,6 +140,44 @@ NES::SystestConfiguration parseConfiguration(int argc, const char** argv)
         std::cout << "Running systests in benchmarking mode. Only one query is run at a time!\n";
         std::cout << "Any included differential queries and queries expecting an error will be skipped.\n";
         config.numberConcurrentQueries = 1;
+
+        if (program.is_used("--repetitions"))
+        {
+            if (program.get<int>("--repetitions") < 1)
+            {
+                std::cerr << "The number of repetitions must be at least one.\n";
+                std::exit(1); ///NOLINT(concurrency-mt-unsafe)
+            }
+            config.benchmarkRepetitions = program.get<int>("--repetitions");
+        }
+        if (program.is_used("--warmup"))
+        {
+            if (program.get<int>("--warmup") < 0)
+            {
+                std::cerr << "The number of warmup runs must not be negative.\n";
+                std::exit(1); ///NOLINT(concurrency-mt-unsafe)
+            }
+            config.benchmarkWarmupRepetitions = program.get<int>("--warmup");
+        }
+        if (program.is_used("--baseline"))
+        {
+            config.benchmarkBaseline = program.get<std::string>("--baseline");
+            if (not std::filesystem::is_regular_file(config.benchmarkBaseline.getValue()))
+            {
+                std::cerr << config.benchmarkBaseline.getValue() << " is not a file.\n";
+                std::exit(1); ///NOLINT(concurrency-mt-unsafe)
+            }
+        }
+        if (program.is_used("--regression-threshold"))
+        {
+            config.benchmarkRegressionThreshold = program.get<float>("--regression-threshold");
+        }
+    }
+    else if (program.is_used("--repetitions") or program.is_used("--warmup") or program.is_used("--baseline")
+             or program.is_used("--regression-threshold"))
+    {
+        std::cerr << "The options --repetitions, --warmup, --baseline, and --regression-threshold require the benchmarking mode (-b).\n";
+        std::exit(1); ///NOLINT(concurrency-mt-unsafe)
     }
 
     if (program.is_used("-d"))